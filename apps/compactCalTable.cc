@@ -0,0 +1,98 @@
+/// @file
+///
+/// Utility to rewrite a calibration table in the compacted form (see 
+/// TableCalSolutionSource::compact). Every row of the new table has all calibration
+/// products defined, so solutions can be read without searching back through the table.
+/// Optionally, the differential form with regular keyframes is used to keep the table small.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// Package level header file
+#include <askap_accessors.h>
+
+// ASKAPsoft includes
+#include <askap/askap/Application.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <askap/StatReporter.h>
+#include <askap/calibaccess/TableCalSolutionSource.h>
+#include <askap/calibaccess/TableCalSolutionFiller.h>
+
+#include <Common/ParameterSet.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+ASKAP_LOGGER(logger, "compactCalTable.log");
+
+class CompactCalTableApp : public askap::Application {
+    public:
+        virtual int run(int argc, char* argv[])
+        {
+            try {
+                StatReporter stats;
+
+                LOFAR::ParameterSet parset;
+                parset.adoptCollection(config());
+                const LOFAR::ParameterSet subset(parset.makeSubset("CompactCalTable."));
+
+                const std::string input = subset.getString("input");
+                const std::string output = subset.getString("output");
+                const casacore::uInt keyframeInterval = subset.getUint32("keyframeinterval", 0);
+                const casacore::uInt tileChan = subset.getUint32("tile.nchan",
+                                             TableCalSolutionFiller::theirDefaultTileChannels);
+                const casacore::uInt tileAnt = subset.getUint32("tile.nant",
+                                             TableCalSolutionFiller::theirDefaultTileAntennas);
+                const casacore::uInt tileBeam = subset.getUint32("tile.nbeam",
+                                             TableCalSolutionFiller::theirDefaultTileBeams);
+
+                ASKAPLOG_INFO_STR(logger, "Compacting calibration table " << input << " into " << output <<
+                                  (keyframeInterval > 0 ? ", differential form is used" : ""));
+                const long nSolutions = TableCalSolutionSource::compact(input, output, keyframeInterval,
+                                        tileChan, tileAnt, tileBeam);
+                ASKAPLOG_INFO_STR(logger, "Written " << nSolutions << " solutions");
+
+                stats.logSummary();
+            } catch (const askap::AskapError& x) {
+                ASKAPLOG_FATAL_STR(logger, "Askap error in " << argv[0] << ": " << x.what());
+                std::cerr << "Askap error in " << argv[0] << ": " << x.what() << std::endl;
+                exit(1);
+            } catch (const std::exception& x) {
+                ASKAPLOG_FATAL_STR(logger,
+                                   "Unexpected exception in " << argv[0] << ": " << x.what());
+                std::cerr << "Unexpected exception in " << argv[0] << ": " <<
+                          x.what() << std::endl;
+                exit(1);
+            }
+
+            return 0;
+        }
+};
+
+int main(int argc, char *argv[])
+{
+    CompactCalTableApp app;
+    return app.main(argc, argv);
+}
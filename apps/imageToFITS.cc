@@ -2,7 +2,8 @@
 ///
 /// Utility function to convert a CASA image to a FITS image. Provides
 /// a parset interface to allow more flexibility than the casacore
-/// image2fits function.
+/// image2fits function. Floating point images are converted plane by plane
+/// through the image accessors, so the cube is never held in memory in full.
 ///
 /// @copyright (c) 2014 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -37,14 +38,19 @@
 #include <askap/askap/AskapLogging.h>
 #include <askap/askap/AskapError.h>
 #include <askap/StatReporter.h>
+#include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/FitsImageAccess.h>
+#include <askap/imageaccess/ImagePlaneWriter.h>
 
 #include <Common/ParameterSet.h>
 #include <casacore/images/Images/ImageFITSConverter.h>
 #include <casacore/images/Images/PagedImage.h>
-#include <casacore/tables/Tables/TableRecord.h>
-#include <casacore/casa/Logging/LogIO.h>
+#include <casacore/casa/OS/File.h>
+
+#include <algorithm>
 
 using namespace askap;
+using namespace askap::accessors;
 
 ASKAP_LOGGER(logger, "imageToFITS.log");
 
@@ -85,48 +91,28 @@ class ConvertApp : public askap::Application {
                     ASKAPTHROW(AskapError, "BITPIX can only be -32 or 16.");
                 }
 
-                casacore::String errorMsg;
-                bool returnVal;
-
-                casacore::PagedImage<float> casaim(casaimage);
-                casacore::TableRecord miscinfo = casaim.miscInfo();
-
-                if (subset.isDefined("headers")) {
-                    std::vector<std::string> headersToUpdate = subset.getStringVector("headers", "");
-                    if (headersToUpdate.size() > 0) {
-                        // There are headers we want to update
-                        for (std::vector<std::string>::iterator head = headersToUpdate.begin();
-                                head < headersToUpdate.end(); head++) {
-                            std::string val = subset.getString("headers." + *head, "");
-                            if (val != "") {
-                                miscinfo.define(*head, val);
-                            }
-                        }
-                        casaim.setMiscInfo(miscinfo);
-                    }
-                }
+                CasaImageAccess casa;
+                updateMetadata(subset, casa, casaimage);
 
-                if (subset.isDefined("history")) {
-                    std::vector<std::string> historyMessages = subset.getStringVector("history", "");
-                    if (historyMessages.size() > 0) {
-                        casacore::LogIO log = casaim.logSink();
-                        for (std::vector<std::string>::iterator history = historyMessages.begin();
-                                history < historyMessages.end(); history++) {
-                            log << *history << casacore::LogIO::POST;
-                        }
-                    }
-                }
+                if (bitpix == -32) {
+                    // the streaming path, which doesn't keep more than a few planes in memory
+                    convert(subset, casa, casaimage, fitsimage, allowOverwrite);
+                } else {
+                    // FITSImageRW can only write floating point pixels, scaled integers
+                    // still go through the generic casacore converter
+                    casa.close(casaimage);
+                    casacore::PagedImage<float> casaim(casaimage);
+                    casacore::String errorMsg;
+                    const bool returnVal = casacore::ImageFITSConverter::ImageToFITS(errorMsg, casaim, fitsimage,
+                                memoryInMB, preferVelocity, opticalVelocity,
+                                bitpix, minpix, maxpix, allowOverwrite,
+                                degenerateLast, verbose, stokesLast,
+                                preferWavelength, airWavelength,
+                                origin, copyHistory);
 
-
-                returnVal = casacore::ImageFITSConverter::ImageToFITS(errorMsg, casaim, fitsimage,
-                            memoryInMB, preferVelocity, opticalVelocity,
-                            bitpix, minpix, maxpix, allowOverwrite,
-                            degenerateLast, verbose, stokesLast,
-                            preferWavelength, airWavelength,
-                            origin, copyHistory);
-
-                if (!returnVal) {
-                    ASKAPTHROW(AskapError, errorMsg);
+                    if (!returnVal) {
+                        ASKAPTHROW(AskapError, errorMsg);
+                    }
                 }
 
 
@@ -146,6 +132,126 @@ class ConvertApp : public askap::Application {
 
             return 0;
         }
+
+    private:
+        /// @brief add the requested headers and history to the CASA image
+        /// @param[in] subset parset with the parameters of the application
+        /// @param[in] casa accessor for the CASA image
+        /// @param[in] casaimage name of the CASA image
+        static void updateMetadata(const LOFAR::ParameterSet &subset, CasaImageAccess &casa,
+                                   const std::string &casaimage)
+        {
+            if (subset.isDefined("headers")) {
+                std::vector<std::string> headersToUpdate = subset.getStringVector("headers", "");
+                for (std::vector<std::string>::iterator head = headersToUpdate.begin();
+                        head < headersToUpdate.end(); head++) {
+                    std::string val = subset.getString("headers." + *head, "");
+                    if (val != "") {
+                        casa.setMetadataKeyword(casaimage, *head, val);
+                    }
+                }
+            }
+
+            if (subset.isDefined("history")) {
+                std::vector<std::string> historyMessages = subset.getStringVector("history", "");
+                for (std::vector<std::string>::iterator history = historyMessages.begin();
+                        history < historyMessages.end(); history++) {
+                    casa.addHistory(casaimage, *history);
+                }
+            }
+        }
+
+        /// @brief convert the image plane by plane
+        /// @details The CASA image is read in slabs as deep as its tiles along the third
+        /// axis, so each tile is read once. Planes are written by ImagePlaneWriter in a
+        /// background thread, so reading of the next plane overlaps writing of the current one.
+        /// @param[in] subset parset with the parameters of the application
+        /// @param[in] casa accessor for the CASA image
+        /// @param[in] casaimage name of the CASA image
+        /// @param[in] fitsimage name of the FITS image
+        /// @param[in] allowOverwrite if false, an existing FITS image is an error
+        static void convert(const LOFAR::ParameterSet &subset, CasaImageAccess &casa,
+                            const std::string &casaimage, std::string fitsimage, bool allowOverwrite)
+        {
+            ASKAPCHECK(allowOverwrite || !casacore::File(fitsimage).exists(),
+                       "FITS image " << fitsimage << " already exists and allowOverwrite is false");
+            // FitsImageAccess adds the extension
+            const std::string extension = ".fits";
+            if (fitsimage.size() > extension.size() &&
+                fitsimage.compare(fitsimage.size() - extension.size(), extension.size(), extension) == 0) {
+                fitsimage.erase(fitsimage.size() - extension.size());
+            }
+
+            const casacore::IPosition shape = casa.shape(casaimage);
+            ASKAPCHECK(shape.nelements() >= 2, "Image " << casaimage << " should have at least 2 dimensions, shape = " << shape);
+            FitsImageAccess fits;
+            const std::string compression = subset.getString("compression", "none");
+            if (compression == "rice") {
+                fits.setCompression(FitsImageAccess::RICE, casacore::IPosition(), subset.getFloat("quantizelevel", 4.f));
+            } else if (compression == "gzip") {
+                fits.setCompression(FitsImageAccess::GZIP, casacore::IPosition(), subset.getFloat("quantizelevel", 4.f));
+            } else {
+                ASKAPCHECK(compression == "none", "Unsupported compression " << compression);
+            }
+            fits.create(fitsimage, shape, casa.coordSys(casaimage));
+            fits.setUnits(fitsimage, casa.getUnits(casaimage));
+            const casacore::Vector<casacore::Quantum<double> > beam = casa.beamInfo(casaimage);
+            if (beam.nelements() == 3 && beam[0].getValue() > 0.) {
+                fits.setBeamInfo(fitsimage, beam[0].getValue("rad"), beam[1].getValue("rad"), beam[2].getValue("rad"));
+            }
+            if (subset.isDefined("headers")) {
+                std::vector<std::string> headers = subset.getStringVector("headers", "");
+                for (std::vector<std::string>::iterator head = headers.begin(); head < headers.end(); head++) {
+                    fits.setMetadataKeyword(fitsimage, *head, casa.getMetadataKeyword(casaimage, *head));
+                }
+            }
+            if (subset.isDefined("history")) {
+                std::vector<std::string> historyMessages = subset.getStringVector("history", "");
+                for (std::vector<std::string>::iterator history = historyMessages.begin();
+                        history < historyMessages.end(); history++) {
+                    fits.addHistory(fitsimage, *history);
+                }
+            }
+
+            const casacore::uInt nPlanesAxis = shape.nelements() > 2 ? shape[2] : 1;
+            const casacore::IPosition tile = casa.tileShape(casaimage);
+            const casacore::uInt depth = std::max(casacore::uInt(1),
+                    std::min(nPlanesAxis, casacore::uInt(tile.nelements() > 2 ? tile[2] : 1)));
+            ImagePlaneWriter writer(fits, fitsimage, subset.getBool("async", true));
+            ASKAPLOG_INFO_STR(logger, "Converting " << casaimage << " into " << fitsimage << ".fits, " <<
+                              writer.nPlanes() << " planes read in slabs of " << depth);
+            casacore::Array<float> slab;
+            // planes are appended with the third axis changing fastest
+            while (writer.nAppended() < writer.nPlanes()) {
+                const casacore::uInt plane = writer.nAppended();
+                casacore::IPosition blc(shape.nelements(), 0);
+                casacore::uInt rest = plane;
+                for (casacore::uInt dim = 2; dim < shape.nelements(); ++dim) {
+                     blc[dim] = rest % shape[dim];
+                     rest /= shape[dim];
+                }
+                casacore::IPosition trc(blc);
+                trc[0] = shape[0] - 1;
+                trc[1] = shape[1] - 1;
+                const casacore::uInt thisDepth = shape.nelements() > 2 ?
+                        std::min(depth, casacore::uInt(shape[2] - blc[2])) : 1;
+                if (shape.nelements() > 2) {
+                    trc[2] = blc[2] + thisDepth - 1;
+                }
+                slab.reference(casa.read(casaimage, blc, trc));
+                for (casacore::uInt z = 0; z < thisDepth; ++z) {
+                     casacore::IPosition start(slab.ndim(), 0);
+                     casacore::IPosition end(slab.shape() - 1);
+                     if (slab.ndim() > 2) {
+                         start[2] = end[2] = z;
+                     }
+                     writer.plane() = slab(start, end).reform(writer.planeShape());
+                     writer.appendPlane();
+                }
+            }
+            writer.close();
+            fits.close(fitsimage);
+        }
 };
 
 int main(int argc, char *argv[])
@@ -0,0 +1,110 @@
+/// @file
+///
+/// Utility to convert a measurement set into the columnar visibility format (see
+/// ColumnarFormat), which can be read via ColumnarDataSource. The measurement set is
+/// iterated with the table-based accessors, so each chunk of the converted data set
+/// corresponds to one iteration (i.e. one time step of a data description).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// Package level header file
+#include <askap_accessors.h>
+
+// ASKAPsoft includes
+#include <askap/askap/Application.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <askap/StatReporter.h>
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/TableConstDataIterator.h>
+#include <askap/dataaccess/ColumnarDataWriter.h>
+
+#include <Common/ParameterSet.h>
+#include <casacore/tables/Tables/Table.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+ASKAP_LOGGER(logger, "msToColumnar.log");
+
+class MsToColumnarApp : public askap::Application {
+    public:
+        virtual int run(int argc, char* argv[])
+        {
+            try {
+                StatReporter stats;
+
+                LOFAR::ParameterSet parset;
+                parset.adoptCollection(config());
+                const LOFAR::ParameterSet subset(parset.makeSubset("MsToColumnar."));
+
+                const std::string msName = subset.getString("ms");
+                const std::string output = subset.getString("output");
+                const std::string dataColumn = subset.getString("datacolumn", "DATA");
+                const bool copyMetadata = subset.getBool("metadata", true);
+
+                ASKAPLOG_INFO_STR(logger, "Converting " << msName << " (column " << dataColumn <<
+                                  ") into columnar data set " << output);
+                TableConstDataSource ds(msName, dataColumn);
+                IDataConverterPtr conv = ds.createConverter();
+                ColumnarDataWriter::configureConverter(*conv);
+                const boost::shared_ptr<IConstDataIterator> it = ds.createConstIterator(ds.createSelector(), conv);
+                // the scan number is only known to the table-based iterator
+                const boost::shared_ptr<TableConstDataIterator> tableIt =
+                      boost::dynamic_pointer_cast<TableConstDataIterator>(it);
+                ASKAPDEBUGASSERT(tableIt);
+
+                ColumnarDataWriter writer(output);
+                if (copyMetadata) {
+                    writer.copyMetadata(casacore::Table(msName));
+                }
+                for (it->init(); it->hasMore(); it->next()) {
+                     writer.write(**it, tableIt->currentScanID());
+                }
+                writer.close();
+                ASKAPLOG_INFO_STR(logger, "Written " << writer.nRow() << " rows in " << writer.nChunk() << " chunks");
+
+                stats.logSummary();
+            } catch (const askap::AskapError& x) {
+                ASKAPLOG_FATAL_STR(logger, "Askap error in " << argv[0] << ": " << x.what());
+                std::cerr << "Askap error in " << argv[0] << ": " << x.what() << std::endl;
+                exit(1);
+            } catch (const std::exception& x) {
+                ASKAPLOG_FATAL_STR(logger,
+                                   "Unexpected exception in " << argv[0] << ": " << x.what());
+                std::cerr << "Unexpected exception in " << argv[0] << ": " <<
+                          x.what() << std::endl;
+                exit(1);
+            }
+
+            return 0;
+        }
+};
+
+int main(int argc, char *argv[])
+{
+    MsToColumnarApp app;
+    return app.main(argc, argv);
+}
@@ -0,0 +1,427 @@
+//
+// @file tAccessorsMicroBenchmark.cc : micro-benchmarks of the hot helper classes
+//
+// Each benchmark calls a small primitive used in the inner loops of the accessors
+// (cached accessor fields, uvw machine cache, calibration parameter names, Jones
+// indices and matrices, data converter and the cube transposer) a given number of
+// times and reports the time per call, so regressions can be seen in isolation.
+// Results are printed to stdout as CSV (one line per benchmark) or JSON.
+//
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+
+
+#include <askap/dataaccess/CachedAccessorField.h>
+#include <askap/dataaccess/UVWMachineCache.h>
+#include <askap/dataaccess/BasicDataConverter.h>
+#include <askap/dataaccess/CubeTransposer.h>
+#include <askap/calibaccess/CalParamNameHelper.h>
+#include <askap/calibaccess/CachedCalSolutionAccessor.h>
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/calibaccess/JonesJTerm.h>
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, "");
+
+#include <askap/askap/AskapError.h>
+#include <Common/ParameterSet.h>
+
+// casa
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MFrequency.h>
+#include <casacore/measures/Measures/MPosition.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/Stokes.h>
+
+// std
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using namespace askap;
+using namespace accessors;
+
+/// @brief result of one benchmark
+struct BenchmarkResult {
+   /// @brief name of the benchmark
+   std::string name;
+   /// @brief elapsed (real) time in seconds
+   double seconds;
+   /// @brief number of calls done
+   size_t count;
+};
+
+/// @brief collection of results
+std::vector<BenchmarkResult> theResults;
+
+/// @brief the result of the benchmarked calls
+/// @details Every benchmark adds something computed from the result of the call
+/// here, so the compiler cannot drop the calls. The value is written to the log.
+double theSink = 0.;
+
+/// @brief store the result of one benchmark
+/// @param[in] name name of the benchmark
+/// @param[in] seconds elapsed (real) time
+/// @param[in] count number of calls done
+void reportTiming(const std::string &name, const double seconds, const size_t count)
+{
+   BenchmarkResult result;
+   result.name = name;
+   result.seconds = seconds;
+   result.count = count;
+   theResults.push_back(result);
+   ASKAPLOG_INFO_STR(logger, name<<": "<<seconds<<" s for "<<count<<" call(s), "<<
+                     (count > 0 ? seconds / double(count) * 1e9 : 0.)<<" ns per call");
+}
+
+/// @brief print all results
+/// @param[in] format either "csv" or "json"
+void printResults(const std::string &format)
+{
+   if (format == "json") {
+       cout<<"["<<endl;
+       for (size_t i = 0; i < theResults.size(); ++i) {
+            const BenchmarkResult &res = theResults[i];
+            cout<<"  {\"benchmark\": \""<<res.name<<"\", \"seconds\": "<<res.seconds<<", \"count\": "<<
+                  res.count<<", \"ns_per_call\": "<<(res.count > 0 ? res.seconds / double(res.count) * 1e9 : 0.)<<
+                  "}"<<(i + 1 < theResults.size() ? "," : "")<<endl;
+       }
+       cout<<"]"<<endl;
+   } else {
+       ASKAPCHECK(format == "csv", "Unsupported output format "<<format<<", use csv or json");
+       cout<<"benchmark,seconds,count,ns_per_call"<<endl;
+       for (size_t i = 0; i < theResults.size(); ++i) {
+            const BenchmarkResult &res = theResults[i];
+            cout<<res.name<<","<<res.seconds<<","<<res.count<<","<<
+                  (res.count > 0 ? res.seconds / double(res.count) * 1e9 : 0.)<<endl;
+       }
+   }
+}
+
+/// @brief reader used with the cached accessor field
+struct FieldReader {
+   /// @brief fill the field
+   /// @param[in] vec vector to fill
+   void fill(casacore::Vector<casacore::Double> &vec) const {
+      vec.resize(3);
+      vec = 1.;
+   }
+};
+
+/// @brief CachedAccessorField::value for cached values and with a refill every call
+/// @details If the library is built with OpenMP, value takes a shared lock and the
+/// cached access is also done from all threads of a parallel loop to see the contention.
+/// @param[in] nIter number of calls
+void benchmarkCachedAccessorField(size_t nIter)
+{
+   const FieldReader reader;
+   CachedAccessorField<casacore::Vector<casacore::Double> > field;
+   casacore::Timer timer;
+   double sum = 0.;
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        sum += field.value(reader, &FieldReader::fill)[0];
+   }
+   reportTiming("CachedAccessorField::value_cached", timer.real(), nIter);
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        field.invalidate();
+        sum += field.value(reader, &FieldReader::fill)[0];
+   }
+   reportTiming("CachedAccessorField::value_fill", timer.real(), nIter);
+#ifdef _OPENMP
+   timer.mark();
+   #pragma omp parallel for reduction(+:sum)
+   for (long i = 0; i < long(nIter); ++i) {
+        sum += field.value(reader, &FieldReader::fill)[0];
+   }
+   reportTiming("CachedAccessorField::value_cached_omp", timer.real(), nIter);
+#endif
+   theSink += sum;
+}
+
+/// @brief UVWMachineCache::machine for hits and misses
+/// @details The miss case cycles through more tangent points than the cache can hold.
+/// @param[in] nIter number of calls
+void benchmarkUVWMachineCache(size_t nIter)
+{
+   const casacore::MDirection phaseCentre(casacore::MVDirection(casacore::Quantity(135., "deg"),
+                  casacore::Quantity(-60., "deg")), casacore::MDirection::J2000);
+   std::vector<casacore::MDirection> tangents;
+   for (int i = 0; i < 8; ++i) {
+        tangents.push_back(casacore::MDirection(casacore::MVDirection(casacore::Quantity(135. + 0.5 * i, "deg"),
+                  casacore::Quantity(-60., "deg")), casacore::MDirection::J2000));
+   }
+   const UVWMachineCache cache(4);
+   casacore::Timer timer;
+   double sum = 0.;
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        sum += cache.machine(phaseCentre, tangents[0]).phaseCenter().getValue()(0);
+   }
+   reportTiming("UVWMachineCache::machine_hit", timer.real(), nIter);
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        sum += cache.machine(phaseCentre, tangents[i % tangents.size()]).phaseCenter().getValue()(0);
+   }
+   reportTiming("UVWMachineCache::machine_miss", timer.real(), nIter);
+   theSink += sum;
+}
+
+/// @brief CalParamNameHelper::paramName and parseParam
+/// @param[in] nIter number of calls
+void benchmarkCalParamNameHelper(size_t nIter)
+{
+   casacore::Timer timer;
+   double sum = 0.;
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        sum += CalParamNameHelper::paramName(JonesIndex(casacore::uInt(i % 36),
+                       casacore::uInt(i % 36)), casacore::Stokes::XX, false).size();
+   }
+   reportTiming("CalParamNameHelper::paramName", timer.real(), nIter);
+   const std::string name = CalParamNameHelper::paramName(JonesIndex(casacore::uInt(12),
+                       casacore::uInt(30)), casacore::Stokes::YY, false);
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        sum += CalParamNameHelper::parseParam(name).first.antenna();
+   }
+   reportTiming("CalParamNameHelper::parseParam", timer.real(), nIter);
+   theSink += sum;
+}
+
+/// @brief JonesIndex construction and comparison
+/// @param[in] nIter number of calls
+void benchmarkJonesIndex(size_t nIter)
+{
+   casacore::Timer timer;
+   double sum = 0.;
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        const JonesIndex index(casacore::uInt(i % 36), casacore::uInt(i % 36));
+        sum += index.beam();
+   }
+   reportTiming("JonesIndex::JonesIndex", timer.real(), nIter);
+   const JonesIndex ref(casacore::uInt(17), casacore::uInt(18));
+   std::vector<JonesIndex> indices;
+   for (casacore::uInt ant = 0; ant < 36; ++ant) {
+        indices.push_back(JonesIndex(ant, casacore::uInt(18)));
+   }
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        const JonesIndex &index = indices[i % indices.size()];
+        sum += (index < ref ? 1 : 0) + (index == ref ? 2 : 0);
+   }
+   reportTiming("JonesIndex::compare", timer.real(), nIter);
+   theSink += sum;
+}
+
+/// @brief ICalSolutionConstAccessor::jones for gains and bandpasses of a typical size
+/// @param[in] nIter number of calls
+void benchmarkJones(size_t nIter)
+{
+   const casacore::uInt nAnt = 36;
+   const casacore::uInt nBeam = 36;
+   const casacore::uInt nChan = 16;
+   CachedCalSolutionAccessor acc;
+   for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+        for (casacore::uInt beam = 0; beam < nBeam; ++beam) {
+             const JonesIndex index(ant, beam);
+             acc.setGain(index, JonesJTerm(casacore::Complex(1., 0.1), true,
+                         casacore::Complex(0.9, -0.1), true));
+             for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                  acc.setBandpass(index, JonesJTerm(casacore::Complex(1., 0.), true,
+                                  casacore::Complex(1., 0.), true), chan);
+             }
+        }
+   }
+   const ICalSolutionConstAccessor &roAcc = acc;
+   casacore::Timer timer;
+   double sum = 0.;
+   timer.mark();
+   for (size_t i = 0; i < nIter; ++i) {
+        sum += casacore::real(roAcc.jones(casacore::uInt(i % nAnt), casacore::uInt((i / nAnt) % nBeam),
+                              casacore::uInt(i % nChan))(0, 0));
+   }
+   reportTiming("ICalSolutionConstAccessor::jones", timer.real(), nIter);
+   theSink += sum;
+}
+
+/// @brief BasicDataConverter frequency and epoch conversions
+/// @details Vector conversions are done for 288 channels (frequencies) or
+/// 666 rows (epochs), the count is the number of converted elements.
+/// @param[in] nIter number of elements to convert
+void benchmarkDataConverter(size_t nIter)
+{
+   const casacore::MEpoch when(casacore::MVEpoch(casacore::Quantity(55000.5, "d")), casacore::MEpoch::UTC);
+   const casacore::MPosition where(casacore::MVPosition(-2556743.707, 5097440.315, -2847749.657),
+                                   casacore::MPosition::ITRF);
+   const casacore::MDirection dir(casacore::MVDirection(casacore::Quantity(135., "deg"),
+                                  casacore::Quantity(-60., "deg")), casacore::MDirection::J2000);
+   BasicDataConverter conv;
+   conv.setMeasFrame(casacore::MeasFrame(when, where, dir));
+   conv.setFrequencyFrame(casacore::MFrequency::Ref(casacore::MFrequency::LSRK), "Hz");
+   conv.setEpochFrame(when, "s");
+
+   casacore::Timer timer;
+   double sum = 0.;
+   const casacore::MFrequency freq(casacore::MVFrequency(1.4e9), casacore::MFrequency::TOPO);
+   const size_t nSingle = std::max<size_t>(nIter / 100, 1);
+   timer.mark();
+   for (size_t i = 0; i < nSingle; ++i) {
+        sum += conv.frequency(freq);
+   }
+   reportTiming("BasicDataConverter::frequency", timer.real(), nSingle);
+
+   casacore::Vector<casacore::Double> freqs(288), out;
+   for (casacore::uInt chan = 0; chan < freqs.nelements(); ++chan) {
+        freqs[chan] = 1.4e9 + 1e6 * chan;
+   }
+   const size_t nFreqCalls = std::max<size_t>(nIter / freqs.nelements(), 1);
+   timer.mark();
+   for (size_t i = 0; i < nFreqCalls; ++i) {
+        conv.frequencies(casacore::MFrequency::Ref(casacore::MFrequency::TOPO), "Hz", freqs, out);
+        sum += out[0];
+   }
+   reportTiming("BasicDataConverter::frequencies", timer.real(), nFreqCalls * freqs.nelements());
+
+   const casacore::MEpoch epoch(casacore::MVEpoch(casacore::Quantity(55000.6, "d")), casacore::MEpoch::UTC);
+   timer.mark();
+   for (size_t i = 0; i < nSingle; ++i) {
+        sum += conv.epoch(epoch);
+   }
+   reportTiming("BasicDataConverter::epoch", timer.real(), nSingle);
+
+   casacore::Vector<casacore::Double> times(666);
+   for (casacore::uInt row = 0; row < times.nelements(); ++row) {
+        times[row] = 55000.6 * 86400. + 5. * row;
+   }
+   const size_t nEpochCalls = std::max<size_t>(nIter / times.nelements(), 1);
+   timer.mark();
+   for (size_t i = 0; i < nEpochCalls; ++i) {
+        conv.epochs(casacore::MEpoch::Ref(casacore::MEpoch::UTC), "s", times, out);
+        sum += out[0];
+   }
+   reportTiming("BasicDataConverter::epochs", timer.real(), nEpochCalls * times.nelements());
+   theSink += sum;
+}
+
+/// @brief CubeTransposer::transpose used by fillCube
+/// @details The count is the number of transposed elements.
+/// @param[in] nIter number of elements to transpose
+/// @param[in] nPol number of polarisations
+/// @param[in] nChan number of channels
+/// @param[in] nRow number of rows
+void benchmarkTranspose(size_t nIter, casacore::uInt nPol, casacore::uInt nChan, casacore::uInt nRow)
+{
+   const casacore::Cube<casacore::Complex> in(nPol, nChan, nRow, casacore::Complex(1., -1.));
+   casacore::Cube<casacore::Complex> out;
+   const size_t nCalls = std::max<size_t>(nIter / in.nelements(), 1);
+   casacore::Timer timer;
+   double sum = 0.;
+   timer.mark();
+   for (size_t i = 0; i < nCalls; ++i) {
+        CubeTransposer::transpose(in, out);
+        sum += casacore::real(out(0, 0, 0));
+   }
+   std::ostringstream os;
+   os<<"CubeTransposer::transpose_"<<nPol<<"pol";
+   reportTiming(os.str(), timer.real(), nCalls * in.nelements());
+   theSink += sum;
+}
+
+int main(int argc, char **argv) {
+  try {
+     if (argc > 2) {
+         cerr<<"Usage "<<argv[0]<<" [benchmark.parset]"<<endl;
+         cerr<<"The parset may contain (Benchmark. prefix):"<<endl;
+         cerr<<"   benchmarks = [field, uvwmachine, paramname, jonesindex, jones, converter, transpose]"<<endl;
+         cerr<<"   niter      = 1000000               number of calls (or elements) per benchmark"<<endl;
+         cerr<<"   nchan      = 288, nrow = 666       cube shape for the transpose"<<endl;
+         cerr<<"   format     = csv                   output format (csv or json)"<<endl;
+	 return -2;
+     }
+     const LOFAR::ParameterSet parset = argc == 2 ? LOFAR::ParameterSet(argv[1]).makeSubset("Benchmark.") :
+                                        LOFAR::ParameterSet();
+     std::vector<std::string> defaultBenchmarks(1, "field");
+     defaultBenchmarks.push_back("uvwmachine");
+     defaultBenchmarks.push_back("paramname");
+     defaultBenchmarks.push_back("jonesindex");
+     defaultBenchmarks.push_back("jones");
+     defaultBenchmarks.push_back("converter");
+     defaultBenchmarks.push_back("transpose");
+     const std::vector<std::string> benchmarks = parset.getStringVector("benchmarks", defaultBenchmarks);
+     const size_t nIter = parset.getUint32("niter", 1000000);
+     for (std::vector<std::string>::const_iterator it = benchmarks.begin(); it != benchmarks.end(); ++it) {
+          if (*it == "field") {
+              benchmarkCachedAccessorField(nIter);
+          } else if (*it == "uvwmachine") {
+              // setting up a machine is expensive
+              benchmarkUVWMachineCache(std::max<size_t>(nIter / 100, 1));
+          } else if (*it == "paramname") {
+              benchmarkCalParamNameHelper(nIter);
+          } else if (*it == "jonesindex") {
+              benchmarkJonesIndex(nIter);
+          } else if (*it == "jones") {
+              benchmarkJones(nIter);
+          } else if (*it == "converter") {
+              benchmarkDataConverter(nIter);
+          } else {
+              ASKAPCHECK(*it == "transpose", "Unknown benchmark "<<*it);
+              const casacore::uInt nChan = parset.getUint32("nchan", 288);
+              const casacore::uInt nRow = parset.getUint32("nrow", 666);
+              benchmarkTranspose(nIter * 10, 1, nChan, nRow);
+              benchmarkTranspose(nIter * 10, 2, nChan, nRow);
+              benchmarkTranspose(nIter * 10, 4, nChan, nRow);
+          }
+     }
+     ASKAPLOG_DEBUG_STR(logger, "Checksum of the results: "<<theSink);
+     printResults(parset.getString("format", "csv"));
+  }
+  catch(const AskapError &ce) {
+     cerr<<"AskapError has been caught. "<<ce.what()<<endl;
+     return -1;
+  }
+  catch(const std::exception &ex) {
+     cerr<<"std::exception has been caught. "<<ex.what()<<endl;
+     return -1;
+  }
+  catch(...) {
+     cerr<<"An unexpected exception has been caught"<<endl;
+     return -1;
+  }
+  return 0;
+}
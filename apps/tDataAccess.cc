@@ -2,6 +2,11 @@
 // @file tDataAccess.cc : evolving test/demonstration program of the
 //                        data access layer
 //
+// With -benchmark, a synthetic measurement set of the given scale is generated
+// (or an existing one is used) and the iteration throughput in visibilities per second
+// is measured for the read-only, read-write and buffer scenarios with various chunking,
+// read-ahead, thread and buffer options. Results are printed to stdout as JSON or CSV.
+//
 /// @copyright (c) 2007 CSIRO
 /// Australia Telescope National Facility (ATNF)
 /// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
@@ -37,17 +42,43 @@ ASKAP_LOGGER(logger, "");
 
 #include <askap/dataaccess/TableManager.h>
 #include <askap/dataaccess/IDataConverterImpl.h>
+#include <askap/dataaccess/TableDataIterator.h>
+#include <Common/ParameterSet.h>
 
 // casa
 #include <casacore/measures/Measures/MFrequency.h>
+#include <casacore/measures/Measures/Stokes.h>
 #include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
 #include <casacore/casa/OS/Timer.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Slicer.h>
 
+// boost
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
 
 // std
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <utility>
 
 using std::cout;
 using std::cerr;
@@ -139,10 +170,614 @@ void doReadWriteTest(const IDataSource &ds) {
   }
 }
 
+/// @brief result of one benchmark
+struct BenchmarkResult {
+   /// @brief scenario (generate, readonly, readwrite, buffer_write or buffer_read)
+   std::string scenario;
+   /// @brief options of the run as key/value pairs
+   std::vector<std::pair<std::string, std::string> > options;
+   /// @brief elapsed (real) time in seconds
+   double seconds;
+   /// @brief number of chunks processed
+   size_t nChunks;
+   /// @brief number of visibilities processed (rows x channels x polarisations)
+   double nVis;
+};
+
+/// @brief collection of results
+std::vector<BenchmarkResult> theResults;
+
+/// @brief helper to build the list of options
+/// @param[in] options list to add to
+/// @param[in] key name of the option
+/// @param[in] value value of the option
+template<typename T>
+void addOption(std::vector<std::pair<std::string, std::string> > &options, const std::string &key, const T &value)
+{
+   std::ostringstream os;
+   os<<value;
+   options.push_back(std::make_pair(key, os.str()));
+}
+
+/// @brief store the result of one benchmark
+/// @param[in] scenario name of the scenario
+/// @param[in] options options of the run
+/// @param[in] seconds elapsed (real) time
+/// @param[in] nChunks number of chunks processed
+/// @param[in] nVis number of visibilities processed
+void reportTiming(const std::string &scenario, const std::vector<std::pair<std::string, std::string> > &options,
+                  const double seconds, const size_t nChunks, const double nVis)
+{
+   BenchmarkResult result;
+   result.scenario = scenario;
+   result.options = options;
+   result.seconds = seconds;
+   result.nChunks = nChunks;
+   result.nVis = nVis;
+   theResults.push_back(result);
+   std::ostringstream os;
+   for (size_t i = 0; i < options.size(); ++i) {
+        os<<" "<<options[i].first<<"="<<options[i].second;
+   }
+   ASKAPLOG_INFO_STR(logger, scenario<<os.str()<<": "<<seconds<<" s for "<<nChunks<<" chunk(s), "<<
+                     (seconds > 0. ? nVis / seconds : 0.)<<" visibilities per second");
+}
+
+/// @brief print all results
+/// @param[in] format either "json" or "csv"
+void printResults(const std::string &format)
+{
+   if (format == "json") {
+       cout<<"["<<endl;
+       for (size_t i = 0; i < theResults.size(); ++i) {
+            const BenchmarkResult &res = theResults[i];
+            cout<<"  {\"scenario\": \""<<res.scenario<<"\"";
+            for (size_t opt = 0; opt < res.options.size(); ++opt) {
+                 const std::string &value = res.options[opt].second;
+                 const bool numeric = (value.size() > 0) && (value.find_first_not_of("0123456789") == std::string::npos);
+                 cout<<", \""<<res.options[opt].first<<"\": "<<(numeric ? value : "\"" + value + "\"");
+            }
+            cout<<", \"seconds\": "<<res.seconds<<", \"chunks\": "<<res.nChunks<<
+                  ", \"visibilities\": "<<res.nVis<<", \"vis_per_second\": "<<
+                  (res.seconds > 0. ? res.nVis / res.seconds : 0.)<<"}"<<
+                  (i + 1 < theResults.size() ? "," : "")<<endl;
+       }
+       cout<<"]"<<endl;
+   } else {
+       ASKAPCHECK(format == "csv", "Unsupported output format "<<format<<", use json or csv");
+       cout<<"scenario,options,seconds,chunks,visibilities,vis_per_second"<<endl;
+       for (size_t i = 0; i < theResults.size(); ++i) {
+            const BenchmarkResult &res = theResults[i];
+            cout<<res.scenario<<",";
+            for (size_t opt = 0; opt < res.options.size(); ++opt) {
+                 cout<<(opt > 0 ? " " : "")<<res.options[opt].first<<"="<<res.options[opt].second;
+            }
+            cout<<","<<res.seconds<<","<<res.nChunks<<","<<res.nVis<<","<<
+                  (res.seconds > 0. ? res.nVis / res.seconds : 0.)<<endl;
+       }
+   }
+}
+
+/// @brief generate a synthetic measurement set
+/// @details The measurement set has nant antennas (all baselines including auto-correlations),
+/// nbeam beams on a regular grid, nchan channels, npol polarisations and nint integrations
+/// of inttime seconds. Rows are ordered by time, beam and baseline. DATA and FLAG are
+/// stored with the given storage manager (tiledshape, tiledcolumn or standard) and tile shape
+/// (polarisations, channels, rows), the other columns with the standard and incremental
+/// storage managers. The uvw are made up, only their volume matters for the benchmark.
+/// @param[in] name name of the measurement set (overwritten)
+/// @param[in] parset parameters of the benchmark
+void generateMS(const std::string &name, const LOFAR::ParameterSet &parset)
+{
+   const casacore::uInt nAnt = parset.getUint32("nant", 12);
+   const casacore::uInt nBeam = parset.getUint32("nbeam", 4);
+   const casacore::uInt nChan = parset.getUint32("nchan", 288);
+   const casacore::uInt nPol = parset.getUint32("npol", 4);
+   const casacore::uInt nInt = parset.getUint32("nint", 60);
+   const double intTime = parset.getDouble("inttime", 5.);
+   const std::string storageManager = parset.getString("storagemanager", "tiledshape");
+   std::vector<int> defaultTile(3, int(nPol));
+   defaultTile[1] = std::min<int>(nChan, 32);
+   defaultTile[2] = 128;
+   const std::vector<int> tileVec = parset.getInt32Vector("tileshape", defaultTile);
+   ASKAPCHECK(tileVec.size() == 3, "tileshape should have 3 elements (polarisations, channels, rows)");
+   const casacore::IPosition tileShape(3, tileVec[0], tileVec[1], tileVec[2]);
+   ASKAPCHECK((nPol == 1) || (nPol == 2) || (nPol == 4), "npol should be 1, 2 or 4, you have "<<nPol);
+   ASKAPCHECK((nAnt > 0) && (nBeam > 0) && (nChan > 0) && (nInt > 0), "Empty dataset is requested");
+
+   casacore::Timer timer;
+   timer.mark();
+
+   // main table
+   const casacore::IPosition cellShape(2, nPol, nChan);
+   casacore::TableDesc td = casacore::MS::requiredTableDesc();
+   td.addColumn(casacore::ArrayColumnDesc<casacore::Complex>("DATA", "synthetic visibilities", cellShape,
+                casacore::ColumnDesc::FixedShape));
+   td.rwColumnDesc("FLAG").setShape(cellShape);
+   td.rwColumnDesc("SIGMA").setShape(casacore::IPosition(1, nPol));
+   td.rwColumnDesc("WEIGHT").setShape(casacore::IPosition(1, nPol));
+   casacore::SetupNewTable newMS(name, td, casacore::Table::New);
+   casacore::IncrementalStMan ism("ISMData");
+   casacore::StandardStMan ssm("SSMData", 32768);
+   newMS.bindAll(ism);
+   const char* perRowColumns[] = {"ANTENNA1", "ANTENNA2", "FEED1", "FEED2", "UVW", "SIGMA", "WEIGHT"};
+   for (size_t i = 0; i < sizeof(perRowColumns) / sizeof(perRowColumns[0]); ++i) {
+        newMS.bindColumn(perRowColumns[i], ssm);
+   }
+   if (storageManager == "tiledshape") {
+       casacore::TiledShapeStMan dataMan("TiledData", tileShape);
+       casacore::TiledShapeStMan flagMan("TiledFlag", tileShape);
+       newMS.bindColumn("DATA", dataMan);
+       newMS.bindColumn("FLAG", flagMan);
+   } else if (storageManager == "tiledcolumn") {
+       casacore::TiledColumnStMan dataMan("TiledData", tileShape);
+       casacore::TiledColumnStMan flagMan("TiledFlag", tileShape);
+       newMS.bindColumn("DATA", dataMan);
+       newMS.bindColumn("FLAG", flagMan);
+   } else {
+       ASKAPCHECK(storageManager == "standard", "Unsupported storage manager "<<storageManager<<
+                  ", use tiledshape, tiledcolumn or standard");
+       newMS.bindColumn("DATA", ssm);
+       newMS.bindColumn("FLAG", ssm);
+   }
+   casacore::MeasurementSet ms(newMS, 0);
+   ms.createDefaultSubtables(casacore::Table::New);
+
+   // antennas scattered around the ASKAP site
+   std::srand(parset.getUint32("seed", 1));
+   std::vector<casacore::Vector<casacore::Double> > antPos(nAnt);
+   {
+      casacore::Table antTab(ms.antenna());
+      antTab.addRow(nAnt);
+      casacore::ScalarColumn<casacore::String> nameCol(antTab, "NAME"), stationCol(antTab, "STATION"),
+                typeCol(antTab, "TYPE"), mountCol(antTab, "MOUNT");
+      casacore::ScalarColumn<casacore::Double> diamCol(antTab, "DISH_DIAMETER");
+      casacore::ArrayColumn<casacore::Double> posCol(antTab, "POSITION"), offsetCol(antTab, "OFFSET");
+      for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+           std::ostringstream os;
+           os<<"ak"<<(ant < 9 ? "0" : "")<<ant + 1;
+           nameCol.put(ant, os.str());
+           stationCol.put(ant, "ASKAP");
+           typeCol.put(ant, "GROUND-BASED");
+           mountCol.put(ant, "ALT-AZ");
+           diamCol.put(ant, 12.);
+           antPos[ant].resize(3);
+           antPos[ant][0] = -2556743.707 + 3000. * (double(std::rand()) / RAND_MAX - 0.5);
+           antPos[ant][1] = 5097440.315 + 3000. * (double(std::rand()) / RAND_MAX - 0.5);
+           antPos[ant][2] = -2847749.657 + 3000. * (double(std::rand()) / RAND_MAX - 0.5);
+           posCol.put(ant, antPos[ant]);
+           offsetCol.put(ant, casacore::Vector<casacore::Double>(3, 0.));
+      }
+   }
+
+   // beams on a regular grid with 0.9 deg spacing, valid at all times
+   {
+      casacore::Table feedTab(ms.feed());
+      feedTab.addRow(nAnt * nBeam);
+      casacore::ScalarColumn<casacore::Int> antCol(feedTab, "ANTENNA_ID"), feedCol(feedTab, "FEED_ID"),
+                spwCol(feedTab, "SPECTRAL_WINDOW_ID"), nRecCol(feedTab, "NUM_RECEPTORS"), beamCol(feedTab, "BEAM_ID");
+      casacore::ScalarColumn<casacore::Double> timeCol(feedTab, "TIME"), intervalCol(feedTab, "INTERVAL");
+      casacore::ArrayColumn<casacore::Double> offsetCol(feedTab, "BEAM_OFFSET"), posCol(feedTab, "POSITION"),
+                angleCol(feedTab, "RECEPTOR_ANGLE");
+      casacore::ArrayColumn<casacore::String> polTypeCol(feedTab, "POLARIZATION_TYPE");
+      casacore::ArrayColumn<casacore::Complex> polRespCol(feedTab, "POL_RESPONSE");
+      casacore::Vector<casacore::String> polTypes(2);
+      polTypes[0] = "X";
+      polTypes[1] = "Y";
+      casacore::Matrix<casacore::Complex> polResponse(2, 2, casacore::Complex(0., 0.));
+      polResponse.diagonal() = casacore::Complex(1., 0.);
+      const casacore::uInt gridSize = casacore::uInt(std::ceil(std::sqrt(double(nBeam))));
+      const double spacing = 0.9 * casacore::C::pi / 180.;
+      casacore::uInt row = 0;
+      for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+           for (casacore::uInt beam = 0; beam < nBeam; ++beam, ++row) {
+                antCol.put(row, ant);
+                feedCol.put(row, beam);
+                spwCol.put(row, -1);
+                nRecCol.put(row, 2);
+                beamCol.put(row, -1);
+                timeCol.put(row, 0.);
+                intervalCol.put(row, 0.);
+                casacore::Matrix<casacore::Double> offsets(2, 2);
+                offsets.column(0) = (double(beam % gridSize) - 0.5 * (gridSize - 1)) * spacing;
+                offsets.column(1) = (double(beam / gridSize) - 0.5 * (gridSize - 1)) * spacing;
+                // first index is the axis, second is the receptor
+                offsets.row(0) = offsets(0, 0);
+                offsets.row(1) = offsets(0, 1);
+                offsetCol.put(row, offsets);
+                posCol.put(row, casacore::Vector<casacore::Double>(3, 0.));
+                angleCol.put(row, casacore::Vector<casacore::Double>(2, 0.));
+                polTypeCol.put(row, polTypes);
+                polRespCol.put(row, polResponse);
+           }
+      }
+   }
+
+   // a single field
+   const double t0 = 4.8e9;
+   {
+      casacore::Table fieldTab(ms.field());
+      fieldTab.addRow(1);
+      casacore::Matrix<casacore::Double> dir(2, 1);
+      dir(0, 0) = 135. * casacore::C::pi / 180.;
+      dir(1, 0) = -60. * casacore::C::pi / 180.;
+      casacore::ScalarColumn<casacore::String>(fieldTab, "NAME").put(0, "benchmark");
+      casacore::ScalarColumn<casacore::String>(fieldTab, "CODE").put(0, "");
+      casacore::ScalarColumn<casacore::Double>(fieldTab, "TIME").put(0, t0);
+      casacore::ScalarColumn<casacore::Int>(fieldTab, "NUM_POLY").put(0, 0);
+      casacore::ScalarColumn<casacore::Int>(fieldTab, "SOURCE_ID").put(0, -1);
+      casacore::ArrayColumn<casacore::Double>(fieldTab, "DELAY_DIR").put(0, dir);
+      casacore::ArrayColumn<casacore::Double>(fieldTab, "PHASE_DIR").put(0, dir);
+      casacore::ArrayColumn<casacore::Double>(fieldTab, "REFERENCE_DIR").put(0, dir);
+   }
+
+   // a single spectral window with 18.5 kHz channels
+   {
+      casacore::Table spwTab(ms.spectralWindow());
+      spwTab.addRow(1);
+      const double chanWidth = 18.5e3;
+      casacore::Vector<casacore::Double> freqs(nChan);
+      for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+           freqs[chan] = 1.4e9 + chan * chanWidth;
+      }
+      const casacore::Vector<casacore::Double> widths(nChan, chanWidth);
+      casacore::ScalarColumn<casacore::Int>(spwTab, "NUM_CHAN").put(0, nChan);
+      casacore::ScalarColumn<casacore::String>(spwTab, "NAME").put(0, "benchmark");
+      casacore::ScalarColumn<casacore::Double>(spwTab, "REF_FREQUENCY").put(0, freqs[0]);
+      casacore::ScalarColumn<casacore::Double>(spwTab, "TOTAL_BANDWIDTH").put(0, nChan * chanWidth);
+      casacore::ScalarColumn<casacore::Int>(spwTab, "MEAS_FREQ_REF").put(0, casacore::MFrequency::TOPO);
+      casacore::ScalarColumn<casacore::Int>(spwTab, "NET_SIDEBAND").put(0, 1);
+      casacore::ScalarColumn<casacore::Int>(spwTab, "FREQ_GROUP").put(0, 0);
+      casacore::ScalarColumn<casacore::Int>(spwTab, "IF_CONV_CHAIN").put(0, 0);
+      casacore::ArrayColumn<casacore::Double>(spwTab, "CHAN_FREQ").put(0, freqs);
+      casacore::ArrayColumn<casacore::Double>(spwTab, "CHAN_WIDTH").put(0, widths);
+      casacore::ArrayColumn<casacore::Double>(spwTab, "EFFECTIVE_BW").put(0, widths);
+      casacore::ArrayColumn<casacore::Double>(spwTab, "RESOLUTION").put(0, widths);
+   }
+
+   // linear polarisation products
+   {
+      casacore::Table polTab(ms.polarization());
+      polTab.addRow(1);
+      casacore::Vector<casacore::Int> corrTypes(nPol);
+      casacore::Matrix<casacore::Int> corrProducts(2, nPol);
+      for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+           // XX, XY, YX, YY for 4 products; XX, YY for 2 products
+           const casacore::uInt index = nPol == 2 ? 3 * pol : pol;
+           corrTypes[pol] = casacore::Stokes::XX + index;
+           corrProducts(0, pol) = index / 2;
+           corrProducts(1, pol) = index % 2;
+      }
+      casacore::ScalarColumn<casacore::Int>(polTab, "NUM_CORR").put(0, nPol);
+      casacore::ArrayColumn<casacore::Int>(polTab, "CORR_TYPE").put(0, corrTypes);
+      casacore::ArrayColumn<casacore::Int>(polTab, "CORR_PRODUCT").put(0, corrProducts);
+   }
+
+   {
+      casacore::Table ddTab(ms.dataDescription());
+      ddTab.addRow(1);
+      casacore::ScalarColumn<casacore::Int>(ddTab, "SPECTRAL_WINDOW_ID").put(0, 0);
+      casacore::ScalarColumn<casacore::Int>(ddTab, "POLARIZATION_ID").put(0, 0);
+   }
+
+   // visibilities, one integration at a time
+   const casacore::uInt nBaselines = nAnt * (nAnt + 1) / 2;
+   const casacore::uInt rowsPerInt = nBaselines * nBeam;
+   casacore::Vector<casacore::Int> ant1(rowsPerInt), ant2(rowsPerInt), feed(rowsPerInt);
+   casacore::Matrix<casacore::Double> baselines(3, rowsPerInt);
+   for (casacore::uInt beam = 0, row = 0; beam < nBeam; ++beam) {
+        for (casacore::uInt a1 = 0; a1 < nAnt; ++a1) {
+             for (casacore::uInt a2 = a1; a2 < nAnt; ++a2, ++row) {
+                  ant1[row] = a1;
+                  ant2[row] = a2;
+                  feed[row] = beam;
+                  baselines.column(row) = antPos[a2] - antPos[a1];
+             }
+        }
+   }
+   casacore::ScalarColumn<casacore::Double> timeCol(ms, "TIME"), centroidCol(ms, "TIME_CENTROID"),
+             intervalCol(ms, "INTERVAL"), exposureCol(ms, "EXPOSURE");
+   casacore::ScalarColumn<casacore::Int> ant1Col(ms, "ANTENNA1"), ant2Col(ms, "ANTENNA2"), feed1Col(ms, "FEED1"),
+             feed2Col(ms, "FEED2"), ddCol(ms, "DATA_DESC_ID"), fieldCol(ms, "FIELD_ID"), arrayCol(ms, "ARRAY_ID"),
+             obsCol(ms, "OBSERVATION_ID"), procCol(ms, "PROCESSOR_ID"), scanCol(ms, "SCAN_NUMBER"),
+             stateCol(ms, "STATE_ID");
+   casacore::ScalarColumn<casacore::Bool> flagRowCol(ms, "FLAG_ROW");
+   casacore::ArrayColumn<casacore::Double> uvwCol(ms, "UVW");
+   casacore::ArrayColumn<casacore::Complex> dataCol(ms, "DATA");
+   casacore::ArrayColumn<casacore::Bool> flagCol(ms, "FLAG");
+   casacore::ArrayColumn<casacore::Float> sigmaCol(ms, "SIGMA"), weightCol(ms, "WEIGHT");
+   const casacore::Vector<casacore::Int> zeros(rowsPerInt, 0);
+   casacore::Cube<casacore::Complex> data(nPol, nChan, rowsPerInt);
+   const casacore::Cube<casacore::Bool> flags(nPol, nChan, rowsPerInt, casacore::False);
+   const casacore::Matrix<casacore::Float> ones(nPol, rowsPerInt, 1.f);
+   casacore::Matrix<casacore::Double> uvw(3, rowsPerInt);
+   for (casacore::uInt integration = 0; integration < nInt; ++integration) {
+        const casacore::uInt startRow = ms.nrow();
+        ms.addRow(rowsPerInt);
+        const casacore::Slicer rows(casacore::IPosition(1, startRow), casacore::IPosition(1, rowsPerInt));
+        const double time = t0 + (integration + 0.5) * intTime;
+        timeCol.putColumnRange(rows, casacore::Vector<casacore::Double>(rowsPerInt, time));
+        centroidCol.putColumnRange(rows, casacore::Vector<casacore::Double>(rowsPerInt, time));
+        intervalCol.putColumnRange(rows, casacore::Vector<casacore::Double>(rowsPerInt, intTime));
+        exposureCol.putColumnRange(rows, casacore::Vector<casacore::Double>(rowsPerInt, intTime));
+        ant1Col.putColumnRange(rows, ant1);
+        ant2Col.putColumnRange(rows, ant2);
+        feed1Col.putColumnRange(rows, feed);
+        feed2Col.putColumnRange(rows, feed);
+        ddCol.putColumnRange(rows, zeros);
+        fieldCol.putColumnRange(rows, zeros);
+        arrayCol.putColumnRange(rows, zeros);
+        obsCol.putColumnRange(rows, zeros);
+        procCol.putColumnRange(rows, zeros);
+        scanCol.putColumnRange(rows, zeros);
+        stateCol.putColumnRange(rows, casacore::Vector<casacore::Int>(rowsPerInt, -1));
+        flagRowCol.putColumnRange(rows, casacore::Vector<casacore::Bool>(rowsPerInt, casacore::False));
+        // rotation of the baselines with the hour angle, good enough for the benchmark
+        const double ha = 2. * casacore::C::pi * (integration * intTime) / 86164.;
+        for (casacore::uInt row = 0; row < rowsPerInt; ++row) {
+             uvw(0, row) = baselines(0, row) * std::cos(ha) - baselines(1, row) * std::sin(ha);
+             uvw(1, row) = baselines(0, row) * std::sin(ha) + baselines(1, row) * std::cos(ha);
+             uvw(2, row) = baselines(2, row);
+        }
+        uvwCol.putColumnRange(rows, uvw);
+        data = casacore::Complex(1., 0.001 * integration);
+        dataCol.putColumnRange(rows, data);
+        flagCol.putColumnRange(rows, flags);
+        sigmaCol.putColumnRange(rows, ones);
+        weightCol.putColumnRange(rows, ones);
+   }
+   ms.flush();
+   std::vector<std::pair<std::string, std::string> > options;
+   addOption(options, "nant", nAnt);
+   addOption(options, "nbeam", nBeam);
+   addOption(options, "nchan", nChan);
+   addOption(options, "npol", nPol);
+   addOption(options, "nint", nInt);
+   addOption(options, "storagemanager", storageManager);
+   addOption(options, "tileshape", storageManager == "standard" ? std::string("none") :
+             casacore::String::toString(tileVec[0]) + "x" + casacore::String::toString(tileVec[1]) + "x" +
+             casacore::String::toString(tileVec[2]));
+   reportTiming("generate", options, timer.real(), nInt, double(nInt) * rowsPerInt * nChan * nPol);
+}
+
+/// @brief touch the bulk data of the current chunk
+/// @param[in] acc accessor of the current chunk
+/// @return number of visibilities in the chunk
+double touchChunk(const IConstDataAccessor &acc)
+{
+   acc.visibility();
+   acc.flag();
+   acc.uvw();
+   return double(acc.nRow()) * acc.nChannel() * acc.nPol();
+}
+
+/// @brief iteration over one partition in a separate thread
+struct PartitionWorker {
+   /// @brief set up the worker
+   /// @param[in] iter iterator over the partition
+   explicit PartitionWorker(const boost::shared_ptr<IConstDataIterator> &iter) :
+            itsIter(iter), itsNChunks(0), itsNVis(0.) {}
+
+   /// @brief iterate till the end of the partition
+   void run() {
+      for (; itsIter->hasMore(); itsIter->next(), ++itsNChunks) {
+           itsNVis += touchChunk(**itsIter);
+      }
+   }
+
+   /// @brief iterator over the partition
+   boost::shared_ptr<IConstDataIterator> itsIter;
+   /// @brief number of chunks processed
+   size_t itsNChunks;
+   /// @brief number of visibilities processed
+   double itsNVis;
+};
+
+/// @brief read-only iteration with all combinations of the configured options
+/// @param[in] ms name of the measurement set
+/// @param[in] parset parameters of the benchmark
+void doReadOnlyBenchmark(const std::string &ms, const LOFAR::ParameterSet &parset)
+{
+   const std::vector<bool> prefetchModes = parset.getBoolVector("prefetch", std::vector<bool>(1, false));
+   const std::vector<bool> nativeModes = parset.getBoolVector("nativelayout", std::vector<bool>(1, false));
+   const std::vector<bool> mmapModes = parset.getBoolVector("memorymapped", std::vector<bool>(1, false));
+   const std::vector<casacore::uInt> maxChunks = parset.getUint32Vector("maxchunk", std::vector<casacore::uInt>(1, 0));
+   const std::vector<casacore::uInt> maxChannels = parset.getUint32Vector("maxchannels", std::vector<casacore::uInt>(1, 0));
+   const std::vector<casacore::uInt> nThreads = parset.getUint32Vector("nthreads", std::vector<casacore::uInt>(1, 1));
+   const casacore::uInt nRepeat = parset.getUint32("repeat", 1);
+   for (size_t mm = 0; mm < mmapModes.size(); ++mm)
+   for (size_t pf = 0; pf < prefetchModes.size(); ++pf)
+   for (size_t nl = 0; nl < nativeModes.size(); ++nl)
+   for (size_t mc = 0; mc < maxChunks.size(); ++mc)
+   for (size_t ch = 0; ch < maxChannels.size(); ++ch)
+   for (size_t th = 0; th < nThreads.size(); ++th)
+   for (casacore::uInt run = 0; run < nRepeat; ++run) {
+        ASKAPCHECK(nThreads[th] > 0, "Number of threads should be positive");
+        TableConstDataSource ds(ms, "DATA", mmapModes[mm]);
+        ds.configurePrefetch(prefetchModes[pf]);
+        ds.configureNativeLayout(nativeModes[nl]);
+        if (maxChunks[mc] > 0) {
+            ds.configureMaxChunkSize(maxChunks[mc]);
+        }
+        ds.configureMaxChannels(maxChannels[ch]);
+        // subtables are not part of the iteration cost
+        ds.loadSubtables();
+        std::vector<std::pair<std::string, std::string> > options;
+        addOption(options, "memorymapped", int(mmapModes[mm]));
+        addOption(options, "prefetch", int(prefetchModes[pf]));
+        addOption(options, "nativelayout", int(nativeModes[nl]));
+        addOption(options, "maxchunk", maxChunks[mc]);
+        addOption(options, "maxchannels", maxChannels[ch]);
+        addOption(options, "nthreads", nThreads[th]);
+        addOption(options, "run", run);
+        casacore::Timer timer;
+        timer.mark();
+        size_t nChunks = 0;
+        double nVis = 0.;
+        if (nThreads[th] == 1) {
+            for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++nChunks) {
+                 nVis += touchChunk(*it);
+            }
+        } else {
+            // each thread iterates over its own subset of beams
+            const std::vector<boost::shared_ptr<IConstDataIterator> > iters =
+                  ds.createPartitionedIterators(ds.createSelector(), ds.createConverter(),
+                                                TableConstDataSource::FEED_PARTITION, nThreads[th]);
+            std::vector<PartitionWorker> workers;
+            for (size_t i = 0; i < iters.size(); ++i) {
+                 workers.push_back(PartitionWorker(iters[i]));
+            }
+            boost::thread_group threads;
+            for (size_t i = 0; i < workers.size(); ++i) {
+                 threads.create_thread(boost::bind(&PartitionWorker::run, &workers[i]));
+            }
+            threads.join_all();
+            for (size_t i = 0; i < workers.size(); ++i) {
+                 nChunks += workers[i].itsNChunks;
+                 nVis += workers[i].itsNVis;
+            }
+        }
+        reportTiming("readonly", options, timer.real(), nChunks, nVis);
+   }
+}
+
+/// @brief read-write iteration modifying all visibilities
+/// @param[in] ms name of the measurement set
+/// @param[in] parset parameters of the benchmark
+void doReadWriteBenchmark(const std::string &ms, const LOFAR::ParameterSet &parset)
+{
+   const std::vector<casacore::uInt> maxChunks = parset.getUint32Vector("maxchunk", std::vector<casacore::uInt>(1, 0));
+   const std::vector<casacore::uInt> writeBehind = parset.getUint32Vector("writebehind", std::vector<casacore::uInt>(1, 0));
+   const casacore::uInt nRepeat = parset.getUint32("repeat", 1);
+   for (size_t mc = 0; mc < maxChunks.size(); ++mc)
+   for (size_t wb = 0; wb < writeBehind.size(); ++wb)
+   for (casacore::uInt run = 0; run < nRepeat; ++run) {
+        TableDataSource ds(ms, TableDataSource::WRITE_PERMITTED);
+        if (maxChunks[mc] > 0) {
+            ds.configureMaxChunkSize(maxChunks[mc]);
+        }
+        ds.configureWriteBehind(writeBehind[wb]);
+        ds.loadSubtables();
+        std::vector<std::pair<std::string, std::string> > options;
+        addOption(options, "maxchunk", maxChunks[mc]);
+        addOption(options, "writebehind", writeBehind[wb]);
+        addOption(options, "run", run);
+        casacore::Timer timer;
+        timer.mark();
+        size_t nChunks = 0;
+        double nVis = 0.;
+        IDataSharedIter it = ds.createIterator();
+        for (; it != it.end(); ++it, ++nChunks) {
+             it->rwVisibility() *= casacore::Complex(1., 0.);
+             nVis += double(it->nRow()) * it->nChannel() * it->nPol();
+        }
+        // deferred writes are part of the cost
+        it.dynamicCast<TableDataIterator>()->sync();
+        reportTiming("readwrite", options, timer.real(), nChunks, nVis);
+   }
+}
+
+/// @brief write and read back a buffer with each of the configured buffer types
+/// @param[in] ms name of the measurement set
+/// @param[in] parset parameters of the benchmark
+void doBufferBenchmark(const std::string &ms, const LOFAR::ParameterSet &parset)
+{
+   const std::vector<casacore::uInt> maxChunks = parset.getUint32Vector("maxchunk", std::vector<casacore::uInt>(1, 0));
+   const std::vector<std::string> bufferTypes = parset.getStringVector("buffers", std::vector<std::string>(1, "memory"));
+   const size_t bufferMemory = parset.getUint32("buffermemory", 0);
+   const casacore::uInt nRepeat = parset.getUint32("repeat", 1);
+   for (size_t mc = 0; mc < maxChunks.size(); ++mc)
+   for (size_t bt = 0; bt < bufferTypes.size(); ++bt)
+   for (casacore::uInt run = 0; run < nRepeat; ++run) {
+        int opt = TableDataSource::WRITE_PERMITTED | TableDataSource::REMOVE_BUFFERS;
+        if (bufferTypes[bt] == "memory") {
+            opt |= TableDataSource::MEMORY_BUFFERS;
+        } else if (bufferTypes[bt] == "file") {
+            opt |= TableDataSource::FILE_BUFFERS;
+        } else if (bufferTypes[bt] == "hybrid") {
+            opt |= TableDataSource::HYBRID_BUFFERS;
+        } else {
+            ASKAPCHECK(bufferTypes[bt] == "table", "Unsupported buffer type "<<bufferTypes[bt]<<
+                       ", use memory, table, file or hybrid");
+        }
+        TableDataSource ds(ms, opt, "DATA", bufferMemory);
+        if (maxChunks[mc] > 0) {
+            ds.configureMaxChunkSize(maxChunks[mc]);
+        }
+        ds.loadSubtables();
+        std::vector<std::pair<std::string, std::string> > options;
+        addOption(options, "maxchunk", maxChunks[mc]);
+        addOption(options, "buffers", bufferTypes[bt]);
+        addOption(options, "run", run);
+        IDataSharedIter it = ds.createIterator();
+        casacore::Timer timer;
+        size_t nChunks = 0;
+        double nVis = 0.;
+        timer.mark();
+        for (it.init(); it != it.end(); it.next(), ++nChunks) {
+             it.buffer("BENCHMARK").rwVisibility() = it->visibility();
+             nVis += double(it->nRow()) * it->nChannel() * it->nPol();
+        }
+        reportTiming("buffer_write", options, timer.real(), nChunks, nVis);
+        nChunks = 0;
+        nVis = 0.;
+        timer.mark();
+        for (it.init(); it != it.end(); it.next(), ++nChunks) {
+             const IConstDataAccessor &acc = it.buffer("BENCHMARK");
+             acc.visibility();
+             nVis += double(acc.nRow()) * acc.nChannel() * acc.nPol();
+        }
+        reportTiming("buffer_read", options, timer.real(), nChunks, nVis);
+   }
+}
+
+/// @brief run the benchmark
+/// @param[in] parset parameters of the benchmark (without the Benchmark. prefix)
+void doBenchmark(const LOFAR::ParameterSet &parset)
+{
+   const std::string ms = parset.getString("ms", "benchmark.ms");
+   if (parset.getBool("generate", true)) {
+       generateMS(ms, parset);
+   }
+   std::vector<std::string> defaultScenarios(1, "readonly");
+   defaultScenarios.push_back("readwrite");
+   defaultScenarios.push_back("buffer");
+   const std::vector<std::string> scenarios = parset.getStringVector("scenarios", defaultScenarios);
+   for (std::vector<std::string>::const_iterator ci = scenarios.begin(); ci != scenarios.end(); ++ci) {
+        if (*ci == "readonly") {
+            doReadOnlyBenchmark(ms, parset);
+        } else if (*ci == "readwrite") {
+            doReadWriteBenchmark(ms, parset);
+        } else {
+            ASKAPCHECK(*ci == "buffer", "Unknown scenario "<<*ci<<", use readonly, readwrite or buffer");
+            doBufferBenchmark(ms, parset);
+        }
+   }
+   printResults(parset.getString("format", "json"));
+}
+
 int main(int argc, char **argv) {
   try {
+     if ((argc == 3) && (std::string(argv[1]) == "-benchmark")) {
+         doBenchmark(LOFAR::ParameterSet(argv[2]).makeSubset("Benchmark."));
+         return 0;
+     }
      if (argc!=2) {
          cerr<<"Usage "<<argv[0]<<" measurement_set"<<endl;
+         cerr<<"      "<<argv[0]<<" -benchmark benchmark.parset"<<endl;
+         cerr<<"The benchmark parset may contain (Benchmark. prefix):"<<endl;
+         cerr<<"   ms             = benchmark.ms    measurement set to use"<<endl;
+         cerr<<"   generate       = true            generate a synthetic measurement set (overwritten)"<<endl;
+         cerr<<"   nant = 12, nbeam = 4, nchan = 288, npol = 4, nint = 60, inttime = 5"<<endl;
+         cerr<<"   storagemanager = tiledshape      tiledshape, tiledcolumn or standard"<<endl;
+         cerr<<"   tileshape      = [4,32,128]      tile shape (polarisations, channels, rows)"<<endl;
+         cerr<<"   scenarios      = [readonly, readwrite, buffer]"<<endl;
+         cerr<<"   prefetch = [false], nativelayout = [false], memorymapped = [false]"<<endl;
+         cerr<<"   maxchunk = [0], maxchannels = [0], nthreads = [1]   (0 means no limit)"<<endl;
+         cerr<<"   writebehind    = [0]             chunks collected before writing (readwrite)"<<endl;
+         cerr<<"   buffers        = [memory]        memory, table, file or hybrid (buffer)"<<endl;
+         cerr<<"   repeat         = 1               number of runs of each combination"<<endl;
+         cerr<<"   format         = json            output format (json or csv)"<<endl;
 	 return -2;
      }
 
@@ -0,0 +1,387 @@
+//
+// @file tImageAccessBenchmark.cc : throughput benchmark of the image accessors
+//
+// Images of the given shape are created with each of the configured accessors and
+// the times of typical operations (create, full and sliced write, full, spectral
+// and cutout reads, mask and metadata operations, per-plane reduction) are measured.
+// Results are printed to stdout as CSV (one line per backend and operation) or JSON.
+//
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+
+
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/ImagePlaneReducer.h>
+#include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, "");
+
+#include <askap/askap/AskapError.h>
+#include <Common/ParameterSet.h>
+
+// casa
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+#include <casacore/coordinates/Coordinates/DirectionCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+#include <casacore/coordinates/Coordinates/StokesCoordinate.h>
+#include <casacore/coordinates/Coordinates/Projection.h>
+
+// boost
+#include <boost/shared_ptr.hpp>
+
+// std
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using namespace askap;
+using namespace accessors;
+
+/// @brief result of one benchmark
+struct BenchmarkResult {
+   /// @brief backend (name of the parset subset)
+   std::string backend;
+   /// @brief operation
+   std::string operation;
+   /// @brief elapsed (real) time in seconds
+   double seconds;
+   /// @brief number of operations done
+   size_t count;
+   /// @brief amount of pixel data transferred in bytes (zero for metadata operations)
+   double bytes;
+};
+
+/// @brief collection of results
+std::vector<BenchmarkResult> theResults;
+
+/// @brief store the result of one benchmark
+/// @param[in] backend backend name
+/// @param[in] operation name of the operation
+/// @param[in] seconds elapsed (real) time
+/// @param[in] count number of operations done
+/// @param[in] bytes amount of pixel data transferred
+void reportTiming(const std::string &backend, const std::string &operation, const double seconds,
+                  const size_t count, const double bytes = 0.)
+{
+   BenchmarkResult result;
+   result.backend = backend;
+   result.operation = operation;
+   result.seconds = seconds;
+   result.count = count;
+   result.bytes = bytes;
+   theResults.push_back(result);
+   ASKAPLOG_INFO_STR(logger, backend<<" "<<operation<<": "<<seconds<<" s for "<<count<<" operation(s)");
+}
+
+/// @brief print all results
+/// @param[in] format either "csv" or "json"
+void printResults(const std::string &format)
+{
+   if (format == "json") {
+       cout<<"["<<endl;
+       for (size_t i = 0; i < theResults.size(); ++i) {
+            const BenchmarkResult &res = theResults[i];
+            cout<<"  {\"backend\": \""<<res.backend<<"\", \"operation\": \""<<res.operation<<
+                  "\", \"seconds\": "<<res.seconds<<", \"count\": "<<res.count<<
+                  ", \"rate\": "<<(res.seconds > 0. ? double(res.count) / res.seconds : 0.)<<
+                  ", \"mbytes_per_second\": "<<(res.seconds > 0. ? res.bytes / res.seconds / 1048576. : 0.)<<
+                  "}"<<(i + 1 < theResults.size() ? "," : "")<<endl;
+       }
+       cout<<"]"<<endl;
+   } else {
+       ASKAPCHECK(format == "csv", "Unsupported output format "<<format<<", use csv or json");
+       cout<<"backend,operation,seconds,count,rate,mbytes_per_second"<<endl;
+       for (size_t i = 0; i < theResults.size(); ++i) {
+            const BenchmarkResult &res = theResults[i];
+            cout<<res.backend<<","<<res.operation<<","<<res.seconds<<","<<res.count<<","<<
+                  (res.seconds > 0. ? double(res.count) / res.seconds : 0.)<<","<<
+                  (res.seconds > 0. ? res.bytes / res.seconds / 1048576. : 0.)<<endl;
+       }
+   }
+}
+
+/// @brief coordinate system for the benchmark images
+/// @details The image is assumed to have ra, dec, stokes and frequency axes (trailing axes
+/// may be omitted).
+/// @param[in] shape shape of the image
+/// @return coordinate system
+casacore::CoordinateSystem makeCoords(const casacore::IPosition &shape)
+{
+   ASKAPCHECK(shape.nelements() >= 2 && shape.nelements() <= 4, "Benchmark image should have 2 to 4 axes, shape = "<<
+              shape);
+   casacore::Matrix<double> xform(2,2);
+   xform = 0.0; xform.diagonal() = 1.0;
+   const double cellSize = 2. / 3600. * casacore::C::pi / 180.;
+   casacore::DirectionCoordinate radec(casacore::MDirection::J2000, casacore::Projection(casacore::Projection::SIN),
+          135. * casacore::C::pi / 180., -60. * casacore::C::pi / 180., -cellSize, cellSize,
+          xform, shape[0] / 2., shape[1] / 2.);
+   casacore::CoordinateSystem csys;
+   csys.addCoordinate(radec);
+   if (shape.nelements() > 2) {
+       casacore::Vector<casacore::Int> stokes(shape[2]);
+       for (casacore::uInt pol = 0; pol < stokes.nelements(); ++pol) {
+            stokes[pol] = casacore::Stokes::I + pol;
+       }
+       csys.addCoordinate(casacore::StokesCoordinate(stokes));
+   }
+   if (shape.nelements() > 3) {
+       csys.addCoordinate(casacore::SpectralCoordinate(casacore::MFrequency::TOPO, 1.4e9, 18.5e3, 0., 1420.40575e6));
+   }
+   return csys;
+}
+
+/// @brief plane number of an image as a position
+/// @param[in] shape shape of the image
+/// @param[in] plane plane number
+/// @return bottom left corner of the plane
+casacore::IPosition planePosition(const casacore::IPosition &shape, casacore::uInt plane)
+{
+   casacore::IPosition where(shape.nelements(), 0);
+   for (casacore::uInt dim = 2; dim < shape.nelements(); ++dim) {
+        where[dim] = plane % shape[dim];
+        plane /= shape[dim];
+   }
+   return where;
+}
+
+/// @brief run the benchmark for one backend
+/// @param[in] backend name of the backend (used in the output and as the default image type)
+/// @param[in] parset parameters of the benchmark
+void doBenchmark(const std::string &backend, const LOFAR::ParameterSet &parset)
+{
+   // accessor parameters, e.g. Benchmark.fits.compression, default image type is the backend name
+   LOFAR::ParameterSet accParset = parset.makeSubset(backend + ".");
+   if (!accParset.isDefined("imagetype")) {
+       accParset.add("imagetype", backend);
+   }
+   boost::shared_ptr<IImageAccess> acc = imageAccessFactory(accParset);
+   ASKAPCHECK(acc, "Unable to create accessor for backend "<<backend);
+
+   std::vector<int> defaultShape(4, 1);
+   defaultShape[0] = defaultShape[1] = 1024;
+   defaultShape[3] = 64;
+   const std::vector<int> shapeVec = parset.getInt32Vector("shape", defaultShape);
+   casacore::IPosition shape(shapeVec.size());
+   for (size_t dim = 0; dim < shapeVec.size(); ++dim) {
+        shape[dim] = shapeVec[dim];
+   }
+   const std::string name = parset.getString("name", "benchmark") + "_" + backend;
+   const size_t nCutouts = parset.getUint32("ncutouts", 1000);
+   const int cutoutSize = parset.getInt32("cutoutsize", 32);
+   const size_t nSpectra = parset.getUint32("nspectra", 100);
+   const size_t nKeywords = parset.getUint32("nkeywords", 100);
+   const std::vector<casacore::uInt> nThreads = parset.getUint32Vector("nthreads", std::vector<casacore::uInt>(1, 1));
+   const double pixelBytes = sizeof(float);
+   const double imageBytes = double(shape.product()) * pixelBytes;
+   casacore::uInt nPlanes = 1;
+   for (casacore::uInt dim = 2; dim < shape.nelements(); ++dim) {
+        nPlanes *= shape[dim];
+   }
+   const casacore::IPosition planeShape = shape.getFirst(2);
+   // pseudo-random positions, the same for all backends
+   std::srand(parset.getUint32("seed", 1));
+
+   casacore::Timer timer;
+
+   timer.mark();
+   acc->create(name, shape, makeCoords(shape));
+   reportTiming(backend, "create", timer.real(), 1);
+
+   {
+      casacore::Array<float> pixels(shape);
+      casacore::indgen(pixels);
+      timer.mark();
+      acc->write(name, pixels);
+      acc->flush();
+      reportTiming(backend, "write_full", timer.real(), 1, imageBytes);
+   }
+
+   {
+      casacore::Array<float> plane(planeShape, 1.);
+      timer.mark();
+      for (casacore::uInt p = 0; p < nPlanes; ++p) {
+           acc->write(name, plane, planePosition(shape, p));
+      }
+      acc->flush();
+      reportTiming(backend, "write_planes", timer.real(), nPlanes, imageBytes);
+   }
+
+   // close, so the reads below start from the file
+   acc->close(name);
+   timer.mark();
+   const casacore::Array<float> pixels = acc->read(name);
+   reportTiming(backend, "read_full", timer.real(), 1, imageBytes);
+   ASKAPCHECK(pixels.shape() == shape, "Image "<<name<<" has shape "<<pixels.shape()<<", expected "<<shape);
+
+   {
+      timer.mark();
+      double checksum = 0.;
+      for (size_t i = 0; i < nSpectra; ++i) {
+           casacore::IPosition blc(shape.nelements(), 0);
+           blc[0] = std::rand() % shape[0];
+           blc[1] = std::rand() % shape[1];
+           casacore::IPosition trc(shape - 1);
+           trc[0] = blc[0];
+           trc[1] = blc[1];
+           checksum += casacore::sum(acc->read(name, blc, trc));
+      }
+      reportTiming(backend, "read_spectra", timer.real(), nSpectra, double(nSpectra) * nPlanes * pixelBytes);
+      ASKAPLOG_DEBUG_STR(logger, "Spectra checksum: "<<checksum);
+   }
+
+   {
+      const int sizeX = std::min<int>(cutoutSize, shape[0]);
+      const int sizeY = std::min<int>(cutoutSize, shape[1]);
+      std::vector<casacore::IPosition> blc(nCutouts), trc(nCutouts);
+      for (size_t i = 0; i < nCutouts; ++i) {
+           blc[i] = planePosition(shape, std::rand() % nPlanes);
+           blc[i][0] = std::rand() % (shape[0] - sizeX + 1);
+           blc[i][1] = std::rand() % (shape[1] - sizeY + 1);
+           trc[i] = blc[i];
+           trc[i][0] += sizeX - 1;
+           trc[i][1] += sizeY - 1;
+      }
+      const double cutoutBytes = double(nCutouts) * sizeX * sizeY * pixelBytes;
+      std::vector<casacore::Array<float> > cutouts;
+      timer.mark();
+      acc->readCutouts(name, blc, trc, cutouts);
+      reportTiming(backend, "read_cutouts_batch", timer.real(), nCutouts, cutoutBytes);
+      timer.mark();
+      for (size_t i = 0; i < nCutouts; ++i) {
+           cutouts[i].reference(acc->read(name, blc[i], trc[i]));
+      }
+      reportTiming(backend, "read_cutouts_single", timer.real(), nCutouts, cutoutBytes);
+   }
+
+   {
+      casacore::Array<bool> mask(planeShape, true);
+      timer.mark();
+      for (casacore::uInt p = 0; p < nPlanes; ++p) {
+           acc->writeMask(name, mask, planePosition(shape, p));
+      }
+      acc->flush();
+      reportTiming(backend, "write_mask", timer.real(), nPlanes, double(shape.product()) * sizeof(bool));
+      // only some backends can read the mask
+      const boost::shared_ptr<CasaImageAccess> casa = boost::dynamic_pointer_cast<CasaImageAccess>(acc);
+      const boost::shared_ptr<MemoryImageAccess> memory = boost::dynamic_pointer_cast<MemoryImageAccess>(acc);
+      if (casa || memory) {
+          casacore::Array<float> buf;
+          timer.mark();
+          if (casa) {
+              casa->readWithMask(name, buf, mask);
+          } else {
+              mask.reference(memory->mask(name));
+          }
+          reportTiming(backend, "read_mask", timer.real(), 1, double(shape.product()) * sizeof(bool));
+      }
+   }
+
+   {
+      timer.mark();
+      for (size_t i = 0; i < nKeywords; ++i) {
+           std::ostringstream os;
+           os<<"BENCH"<<i;
+           acc->setMetadataKeyword(name, os.str(), "value", "benchmark keyword");
+      }
+      acc->setUnits(name, "Jy/beam");
+      acc->setBeamInfo(name, 1e-4, 5e-5, 0.3);
+      acc->addHistory(name, "benchmark");
+      acc->flush();
+      reportTiming(backend, "write_metadata", timer.real(), nKeywords + 3);
+
+      timer.mark();
+      size_t found = 0;
+      for (size_t i = 0; i < nKeywords; ++i) {
+           std::ostringstream os;
+           os<<"BENCH"<<i;
+           found += acc->getMetadataKeyword(name, os.str()).size() ? 1 : 0;
+      }
+      found += acc->getUnits(name).size() ? 1 : 0;
+      found += acc->beamInfo(name).nelements() ? 1 : 0;
+      found += acc->coordSys(name).nCoordinates() ? 1 : 0;
+      reportTiming(backend, "read_metadata", timer.real(), nKeywords + 3);
+      ASKAPLOG_DEBUG_STR(logger, found<<" metadata items are found");
+   }
+
+   acc->close(name);
+   for (std::vector<casacore::uInt>::const_iterator it = nThreads.begin(); it != nThreads.end(); ++it) {
+        std::ostringstream os;
+        os<<"reduce_rms_"<<*it<<"_threads";
+        timer.mark();
+        acc->reducePlanes(name, ImagePlaneReducer::rms, shape.nelements() - 1, *it);
+        reportTiming(backend, os.str(), timer.real(), shape[shape.nelements() - 1], imageBytes);
+   }
+   acc->close(name);
+}
+
+int main(int argc, char **argv) {
+  try {
+     if (argc!=2) {
+         cerr<<"Usage "<<argv[0]<<" benchmark.parset"<<endl;
+         cerr<<"The parset may contain (Benchmark. prefix):"<<endl;
+         cerr<<"   backends    = [casa, fits]        list of backends, each creates its own image"<<endl;
+         cerr<<"   <backend>.* = ...                 accessor parameters (imagetype defaults to"<<endl;
+         cerr<<"                                     the backend name), e.g. casa.tileshape"<<endl;
+         cerr<<"   shape       = [1024,1024,1,64]    image shape (ra, dec, stokes, frequency)"<<endl;
+         cerr<<"   name        = benchmark           image name prefix (images are overwritten)"<<endl;
+         cerr<<"   ncutouts    = 1000, cutoutsize = 32, nspectra = 100, nkeywords = 100"<<endl;
+         cerr<<"   nthreads    = [1]                 thread counts for the per-plane reduction"<<endl;
+         cerr<<"   format      = csv                 output format (csv or json)"<<endl;
+	 return -2;
+     }
+     const LOFAR::ParameterSet parset = LOFAR::ParameterSet(argv[1]).makeSubset("Benchmark.");
+     std::vector<std::string> defaultBackends(1, "casa");
+     defaultBackends.push_back("fits");
+     const std::vector<std::string> backends = parset.getStringVector("backends", defaultBackends);
+     for (std::vector<std::string>::const_iterator it = backends.begin(); it != backends.end(); ++it) {
+          doBenchmark(*it, parset);
+     }
+     printResults(parset.getString("format", "csv"));
+  }
+  catch(const AskapError &ce) {
+     cerr<<"AskapError has been caught. "<<ce.what()<<endl;
+     return -1;
+  }
+  catch(const std::exception &ex) {
+     cerr<<"std::exception has been caught. "<<ex.what()<<endl;
+     return -1;
+  }
+  catch(...) {
+     cerr<<"An unexpected exception has been caught"<<endl;
+     return -1;
+  }
+  return 0;
+}
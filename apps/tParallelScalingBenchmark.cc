@@ -0,0 +1,552 @@
+//
+// @file tParallelScalingBenchmark.cc : scaling benchmark of the distributed data access paths
+//
+// All ranks of an MPI job exercise the same operation at the same time: opening the
+// measurement set and loading its subtables, distributed iteration (each rank reading its
+// own share or reader ranks serving workers), calibration solution reads, gathering of the
+// beam log and parallel writes of disjoint planes of one FITS cube. The latency of every
+// operation is measured on each rank and collected on rank 0, which reports per-rank and
+// aggregate throughput with median and tail latencies. Running the benchmark with increasing
+// numbers of ranks shows how the library scales. Results are printed to stdout as CSV
+// (one line per operation and rank, plus the aggregate) or JSON.
+//
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+
+
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/DistributedDataIterator.h>
+#include <askap/calibaccess/CalibAccessFactory.h>
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/BeamLogger.h>
+#include <askap/askapparallel/AskapParallel.h>
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, "");
+
+#include <askap/askap/AskapError.h>
+#include <Common/ParameterSet.h>
+
+// casa
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/casa/Quanta/Quantum.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+#include <casacore/coordinates/Coordinates/DirectionCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+#include <casacore/coordinates/Coordinates/Projection.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MFrequency.h>
+
+// boost
+#include <boost/shared_ptr.hpp>
+
+// std
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using namespace askap;
+using namespace accessors;
+
+/// @brief measurements of one operation on one rank
+struct RankResult {
+   /// @brief rank
+   int rank;
+   /// @brief elapsed (real) time of the whole phase in seconds
+   double seconds;
+   /// @brief amount of data transferred in bytes (zero for metadata operations)
+   double bytes;
+   /// @brief latencies of individual operations in seconds
+   std::vector<double> latencies;
+};
+
+/// @brief measurements of one operation on all ranks (rank 0 only)
+struct BenchmarkResult {
+   /// @brief operation
+   std::string operation;
+   /// @brief results of individual ranks
+   std::vector<RankResult> ranks;
+};
+
+/// @brief collection of results
+std::vector<BenchmarkResult> theResults;
+
+/// @brief tag of the messages used by the benchmark
+const int theTag = 17;
+
+/// @brief wait until all ranks reach this point
+/// @details Implemented with point to point messages through rank 0, so the phases
+/// start at the same time on all ranks.
+/// @param[in] comms communication object
+void barrier(askapparallel::AskapParallel &comms)
+{
+   if (!comms.isParallel()) {
+       return;
+   }
+   int token = 0;
+   if (comms.rank() == 0) {
+       for (int rank = 1; rank < comms.nProcs(); ++rank) {
+            comms.receive(&token, sizeof(token), rank, theTag);
+       }
+       for (int rank = 1; rank < comms.nProcs(); ++rank) {
+            comms.send(&token, sizeof(token), rank, theTag);
+       }
+   } else {
+       comms.send(&token, sizeof(token), 0, theTag);
+       comms.receive(&token, sizeof(token), 0, theTag);
+   }
+}
+
+/// @brief collect the measurements of one operation on rank 0
+/// @details This method is collective, every rank should call it for every operation
+/// (with no latencies if the rank didn't take part).
+/// @param[in] comms communication object
+/// @param[in] operation name of the operation
+/// @param[in] seconds elapsed time of the phase on this rank
+/// @param[in] latencies latencies of individual operations on this rank
+/// @param[in] bytes amount of data transferred by this rank
+void reportTiming(askapparallel::AskapParallel &comms, const std::string &operation, const double seconds,
+                  const std::vector<double> &latencies, const double bytes = 0.)
+{
+   ASKAPLOG_DEBUG_STR(logger, "Rank "<<comms.rank()<<" "<<operation<<": "<<seconds<<" s for "<<
+                      latencies.size()<<" operation(s)");
+   // header: elapsed time, bytes and the number of latencies
+   double header[3] = {seconds, bytes, double(latencies.size())};
+   if (comms.rank() != 0) {
+       comms.send(header, sizeof(header), 0, theTag);
+       if (latencies.size() > 0) {
+           comms.send(&latencies[0], latencies.size() * sizeof(double), 0, theTag);
+       }
+       return;
+   }
+   BenchmarkResult result;
+   result.operation = operation;
+   result.ranks.resize(comms.isParallel() ? comms.nProcs() : 1);
+   for (size_t rank = 0; rank < result.ranks.size(); ++rank) {
+        RankResult &res = result.ranks[rank];
+        res.rank = static_cast<int>(rank);
+        if (rank == 0) {
+            res.latencies = latencies;
+        } else {
+            comms.receive(header, sizeof(header), res.rank, theTag);
+            res.latencies.resize(static_cast<size_t>(header[2]));
+            if (res.latencies.size() > 0) {
+                comms.receive(&res.latencies[0], res.latencies.size() * sizeof(double), res.rank, theTag);
+            }
+        }
+        res.seconds = header[0];
+        res.bytes = header[1];
+   }
+   theResults.push_back(result);
+   ASKAPLOG_INFO_STR(logger, operation<<" has been measured on "<<result.ranks.size()<<" rank(s)");
+}
+
+/// @brief percentile of the sorted sample
+/// @param[in] sorted sorted values
+/// @param[in] fraction fraction of values below the percentile (e.g. 0.99)
+/// @return the value or zero if there are no values
+double percentile(const std::vector<double> &sorted, const double fraction)
+{
+   if (sorted.size() == 0) {
+       return 0.;
+   }
+   const size_t index = static_cast<size_t>(fraction * double(sorted.size() - 1) + 0.5);
+   return sorted[std::min(index, sorted.size() - 1)];
+}
+
+/// @brief summary of a number of measurements
+struct Summary {
+   /// @brief number of operations
+   size_t count;
+   /// @brief elapsed time in seconds (the slowest rank for the aggregate)
+   double seconds;
+   /// @brief amount of data transferred in bytes
+   double bytes;
+   /// @brief median latency
+   double p50;
+   /// @brief 95th percentile of the latency
+   double p95;
+   /// @brief 99th percentile of the latency
+   double p99;
+   /// @brief maximum latency
+   double max;
+};
+
+/// @brief summarise measurements of a number of ranks
+/// @param[in] ranks results of individual ranks
+/// @return summary
+Summary summarise(const std::vector<RankResult> &ranks)
+{
+   Summary summary;
+   summary.seconds = 0.;
+   summary.bytes = 0.;
+   std::vector<double> latencies;
+   for (std::vector<RankResult>::const_iterator ci = ranks.begin(); ci != ranks.end(); ++ci) {
+        latencies.insert(latencies.end(), ci->latencies.begin(), ci->latencies.end());
+        summary.seconds = std::max(summary.seconds, ci->seconds);
+        summary.bytes += ci->bytes;
+   }
+   std::sort(latencies.begin(), latencies.end());
+   summary.count = latencies.size();
+   summary.p50 = percentile(latencies, 0.5);
+   summary.p95 = percentile(latencies, 0.95);
+   summary.p99 = percentile(latencies, 0.99);
+   summary.max = latencies.size() > 0 ? latencies.back() : 0.;
+   return summary;
+}
+
+/// @brief print all results (rank 0 only)
+/// @param[in] format either "csv" or "json"
+/// @param[in] nProcs number of ranks
+void printResults(const std::string &format, const int nProcs)
+{
+   ASKAPCHECK((format == "csv") || (format == "json"), "Unsupported output format "<<format<<", use csv or json");
+   if (format == "json") {
+       cout<<"["<<endl;
+   } else {
+       cout<<"operation,nprocs,rank,count,seconds,rate,mbytes_per_second,p50,p95,p99,max"<<endl;
+   }
+   bool first = true;
+   for (size_t i = 0; i < theResults.size(); ++i) {
+        const BenchmarkResult &res = theResults[i];
+        // individual ranks followed by the aggregate (rank -1)
+        for (size_t rank = 0; rank <= res.ranks.size(); ++rank) {
+             const bool aggregate = (rank == res.ranks.size());
+             const Summary summary = aggregate ? summarise(res.ranks) :
+                   summarise(std::vector<RankResult>(1, res.ranks[rank]));
+             const int rankNumber = aggregate ? -1 : res.ranks[rank].rank;
+             const double rate = summary.seconds > 0. ? double(summary.count) / summary.seconds : 0.;
+             const double mbytes = summary.seconds > 0. ? summary.bytes / summary.seconds / 1048576. : 0.;
+             if (format == "json") {
+                 cout<<(first ? "" : ",\n")<<"  {\"operation\": \""<<res.operation<<"\", \"nprocs\": "<<nProcs<<
+                       ", \"rank\": "<<rankNumber<<", \"count\": "<<summary.count<<", \"seconds\": "<<
+                       summary.seconds<<", \"rate\": "<<rate<<", \"mbytes_per_second\": "<<mbytes<<
+                       ", \"p50\": "<<summary.p50<<", \"p95\": "<<summary.p95<<", \"p99\": "<<summary.p99<<
+                       ", \"max\": "<<summary.max<<"}";
+             } else {
+                 cout<<res.operation<<","<<nProcs<<","<<rankNumber<<","<<summary.count<<","<<summary.seconds<<
+                       ","<<rate<<","<<mbytes<<","<<summary.p50<<","<<summary.p95<<","<<summary.p99<<","<<
+                       summary.max<<endl;
+             }
+             first = false;
+        }
+   }
+   if (format == "json") {
+       cout<<endl<<"]"<<endl;
+   }
+}
+
+/// @brief concurrent opens of the measurement set and subtable loads
+/// @details Every rank opens the dataset the given number of times and obtains the first
+/// chunk, which loads the subtables required by the default converter.
+/// @param[in] comms communication object
+/// @param[in] parset parameters of the benchmark
+void benchmarkOpen(askapparallel::AskapParallel &comms, const LOFAR::ParameterSet &parset)
+{
+   const std::string dataset = parset.getString("dataset");
+   const casacore::uInt nRepeats = parset.getUint32("nopens", 3);
+   std::vector<double> openLatencies, chunkLatencies;
+   casacore::Timer timer, opTimer;
+   barrier(comms);
+   timer.mark();
+   for (casacore::uInt i = 0; i < nRepeats; ++i) {
+        opTimer.mark();
+        TableConstDataSource ds(dataset);
+        openLatencies.push_back(opTimer.real());
+        opTimer.mark();
+        const boost::shared_ptr<IConstDataIterator> it = ds.createConstIterator();
+        if (it->hasMore()) {
+            // frequencies require the spectral window and data description subtables
+            ASKAPCHECK((*it)->frequency().nelements() == (*it)->nChannel(), "Frequency axis of "<<dataset<<
+                       " doesn't match the number of channels");
+        }
+        chunkLatencies.push_back(opTimer.real());
+   }
+   const double seconds = timer.real();
+   reportTiming(comms, "ms_open", seconds, openLatencies);
+   reportTiming(comms, "first_chunk", seconds, chunkLatencies);
+}
+
+/// @brief distributed iteration over the dataset
+/// @details In the local mode every rank reads its own share of time steps. If the number
+/// of reader ranks is given, readers send chunks to the workers. The latency is that of
+/// obtaining one chunk with visibilities and flags.
+/// @param[in] comms communication object
+/// @param[in] parset parameters of the benchmark
+/// @param[in] nReaders number of reader ranks (zero for the local mode)
+/// @param[in] operation name of the operation
+void benchmarkIteration(askapparallel::AskapParallel &comms, const LOFAR::ParameterSet &parset,
+                        const int nReaders, const std::string &operation)
+{
+   const std::string dataset = parset.getString("dataset");
+   const bool reader = (nReaders == 0) || (comms.rank() < nReaders);
+   boost::shared_ptr<TableConstDataSource> ds;
+   boost::shared_ptr<IConstDataIterator> it;
+   if (reader) {
+       ds.reset(new TableConstDataSource(dataset));
+       it = ds->createConstIterator();
+   }
+   std::vector<double> latencies;
+   double bytes = 0.;
+   casacore::Timer timer, opTimer;
+   barrier(comms);
+   timer.mark();
+   opTimer.mark();
+   DistributedDataIterator distIt(comms, it, nReaders);
+   if (nReaders > 0) {
+       distIt.init();
+   }
+   for (; distIt.hasMore(); distIt.next()) {
+        const IConstDataAccessor &acc = *distIt;
+        bytes += double(acc.visibility().nelements()) * sizeof(casacore::Complex) +
+                 double(acc.flag().nelements()) * sizeof(casacore::Bool);
+        latencies.push_back(opTimer.real());
+        opTimer.mark();
+   }
+   if (distIt.isReader()) {
+       // readers only serve the workers, the time to send all chunks is the latency
+       latencies.assign(1, timer.real());
+       ASKAPLOG_DEBUG_STR(logger, "Rank "<<comms.rank()<<" has sent "<<distIt.nChunks()<<" chunk(s)");
+   }
+   reportTiming(comms, operation, timer.real(), latencies, bytes);
+}
+
+/// @brief calibration solution reads by many ranks
+/// @details Every rank creates its own solution source and reads full Jones blocks for
+/// pseudo-random times within the given interval.
+/// @param[in] comms communication object
+/// @param[in] parset parameters of the benchmark
+void benchmarkCalibration(askapparallel::AskapParallel &comms, const LOFAR::ParameterSet &parset)
+{
+   const LOFAR::ParameterSet calParset = parset.makeSubset("calibration.");
+   const casacore::uInt nReads = parset.getUint32("calibration.nreads", 10);
+   const casacore::uInt nAnt = parset.getUint32("calibration.nant", 36);
+   const casacore::uInt nBeam = parset.getUint32("calibration.nbeam", 36);
+   const casacore::uInt nChan = parset.getUint32("calibration.nchan", 288);
+   const double startTime = parset.getDouble("calibration.starttime", 0.);
+   const double interval = parset.getDouble("calibration.interval", 0.);
+   std::srand(parset.getUint32("seed", 1) + comms.rank());
+   std::vector<double> sourceLatencies, readLatencies;
+   double bytes = 0.;
+   casacore::Timer timer, opTimer;
+   barrier(comms);
+   timer.mark();
+   opTimer.mark();
+   const boost::shared_ptr<ICalSolutionConstSource> src = CalibAccessFactory::roCalSolutionSource(calParset);
+   ASKAPCHECK(src, "Unable to create the calibration solution source");
+   sourceLatencies.push_back(opTimer.real());
+   casacore::Array<casacore::Complex> jones;
+   casacore::Cube<casacore::Bool> validity;
+   for (casacore::uInt i = 0; i < nReads; ++i) {
+        opTimer.mark();
+        const double time = startTime + interval * double(std::rand()) / RAND_MAX;
+        const boost::shared_ptr<ICalSolutionConstAccessor> acc = src->roSolution(src->solutionID(time));
+        ASKAPCHECK(acc, "Solution source returned an empty accessor for time "<<time);
+        acc->jonesBlock(nAnt, nBeam, 0, nChan, jones, validity);
+        readLatencies.push_back(opTimer.real());
+        bytes += double(jones.nelements()) * sizeof(casacore::Complex) + 
+                 double(validity.nelements()) * sizeof(casacore::Bool);
+   }
+   const double seconds = timer.real();
+   reportTiming(comms, "cal_source", seconds, sourceLatencies);
+   reportTiming(comms, "cal_read", seconds, readLatencies, bytes);
+}
+
+/// @brief gathering of the beam log
+/// @details Every rank holds beams of every nProcs-th channel which are gathered on rank 0.
+/// The latency of rank 0 includes waiting for the slowest sender.
+/// @param[in] comms communication object
+/// @param[in] parset parameters of the benchmark
+void benchmarkBeamLog(askapparallel::AskapParallel &comms, const LOFAR::ParameterSet &parset)
+{
+   const casacore::uInt nChan = parset.getUint32("beamlog.nchan", 16416);
+   const casacore::uInt nRepeats = parset.getUint32("beamlog.nrepeats", 3);
+   const int nProcs = comms.isParallel() ? comms.nProcs() : 1;
+   std::vector<double> latencies;
+   casacore::Timer timer, opTimer;
+   barrier(comms);
+   timer.mark();
+   for (casacore::uInt i = 0; i < nRepeats; ++i) {
+        BeamLogger beamLog;
+        for (casacore::uInt chan = comms.rank(); chan < nChan; chan += nProcs) {
+             casacore::Vector<casacore::Quantum<double> > beam(3);
+             beam[0] = casacore::Quantum<double>(12. + 1e-4 * chan, "arcsec");
+             beam[1] = casacore::Quantum<double>(10. + 1e-4 * chan, "arcsec");
+             beam[2] = casacore::Quantum<double>(45., "deg");
+             beamLog.beamlist()[chan] = beam;
+        }
+        opTimer.mark();
+        beamLog.gather(comms, 0, true);
+        latencies.push_back(opTimer.real());
+        if (comms.rank() == 0) {
+            ASKAPCHECK(beamLog.beamlist().size() == nChan, "Gathered "<<beamLog.beamlist().size()<<
+                       " beams, expected "<<nChan);
+        }
+        barrier(comms);
+   }
+   reportTiming(comms, "beamlog_gather", timer.real(), latencies, double(nRepeats) * nChan * 4 * sizeof(double) / nProcs);
+}
+
+/// @brief parallel writes of disjoint planes of one cube
+/// @details Rank 0 creates the cube, then every rank writes every nProcs-th spectral plane.
+/// The accessor is set up from the image.* parameters, by default as a FITS image in the
+/// parallel write mode.
+/// @param[in] comms communication object
+/// @param[in] parset parameters of the benchmark
+void benchmarkImageWrite(askapparallel::AskapParallel &comms, const LOFAR::ParameterSet &parset)
+{
+   LOFAR::ParameterSet accParset = parset.makeSubset("image.");
+   if (!accParset.isDefined("imagetype")) {
+       accParset.add("imagetype", "fits");
+       accParset.add("parallelwrite", "true");
+   }
+   const std::string name = accParset.getString("name", "scaling_benchmark");
+   const int size = accParset.getInt32("size", 2048);
+   const int nChan = accParset.getInt32("nchan", 288);
+   const int nProcs = comms.isParallel() ? comms.nProcs() : 1;
+   boost::shared_ptr<IImageAccess> acc = imageAccessFactory(accParset);
+   ASKAPCHECK(acc, "Unable to create the image accessor");
+   const casacore::IPosition shape(3, size, size, nChan);
+   std::vector<double> createLatencies, writeLatencies;
+   casacore::Timer timer, opTimer;
+   barrier(comms);
+   timer.mark();
+   if (comms.rank() == 0) {
+       casacore::Matrix<double> xform(2,2);
+       xform = 0.0; xform.diagonal() = 1.0;
+       const double cellSize = 2. / 3600. * casacore::C::pi / 180.;
+       casacore::CoordinateSystem csys;
+       csys.addCoordinate(casacore::DirectionCoordinate(casacore::MDirection::J2000, 
+              casacore::Projection(casacore::Projection::SIN), 135. * casacore::C::pi / 180., 
+              -60. * casacore::C::pi / 180., -cellSize, cellSize, xform, size / 2., size / 2.));
+       csys.addCoordinate(casacore::SpectralCoordinate(casacore::MFrequency::TOPO, 1.4e9, 18.5e3, 0., 1420.40575e6));
+       opTimer.mark();
+       acc->create(name, shape, csys);
+       acc->flush();
+       createLatencies.push_back(opTimer.real());
+   }
+   // other ranks should only write after the cube has been created
+   barrier(comms);
+   const casacore::Array<float> plane(casacore::IPosition(3, size, size, 1), float(comms.rank()));
+   double bytes = 0.;
+   for (int chan = comms.rank(); chan < nChan; chan += nProcs) {
+        opTimer.mark();
+        acc->write(name, plane, casacore::IPosition(3, 0, 0, chan));
+        writeLatencies.push_back(opTimer.real());
+        bytes += double(plane.nelements()) * sizeof(float);
+   }
+   opTimer.mark();
+   acc->close(name);
+   if (writeLatencies.size() > 0) {
+       // the last write completes when the image is closed
+       writeLatencies.back() += opTimer.real();
+   }
+   const double seconds = timer.real();
+   reportTiming(comms, "image_create", seconds, createLatencies);
+   reportTiming(comms, "image_write_plane", seconds, writeLatencies, bytes);
+}
+
+int main(int argc, const char **argv) {
+  // this object initialises MPI and should outlive all communication
+  askapparallel::AskapParallel comms(argc, argv);
+  try {
+     if (argc!=2) {
+         if (comms.rank() == 0) {
+             cerr<<"Usage "<<argv[0]<<" benchmark.parset (run with mpirun)"<<endl;
+             cerr<<"The parset may contain (Benchmark. prefix):"<<endl;
+             cerr<<"   phases        = [open, iterate, calibration, beamlog, image]"<<endl;
+             cerr<<"                                     phases to run, in this order"<<endl;
+             cerr<<"   dataset       = ...               measurement set (open and iterate)"<<endl;
+             cerr<<"   nopens        = 3                 number of opens per rank"<<endl;
+             cerr<<"   nreaders      = 0                 reader ranks of the reader/worker iteration"<<endl;
+             cerr<<"                                     (zero only runs the local mode)"<<endl;
+             cerr<<"   calibration.* = ...               calibaccess parameters, nreads = 10,"<<endl;
+             cerr<<"                                     nant = 36, nbeam = 36, nchan = 288,"<<endl;
+             cerr<<"                                     starttime and interval of the read times"<<endl;
+             cerr<<"   beamlog.nchan = 16416, beamlog.nrepeats = 3"<<endl;
+             cerr<<"   image.*       = ...               image accessor parameters (FITS in the"<<endl;
+             cerr<<"                                     parallel write mode by default),"<<endl;
+             cerr<<"                                     name, size = 2048, nchan = 288"<<endl;
+             cerr<<"   format        = csv               output format (csv or json)"<<endl;
+         }
+	 return -2;
+     }
+     const LOFAR::ParameterSet parset = LOFAR::ParameterSet(argv[1]).makeSubset("Benchmark.");
+     std::vector<std::string> defaultPhases;
+     defaultPhases.push_back("open");
+     defaultPhases.push_back("iterate");
+     defaultPhases.push_back("calibration");
+     defaultPhases.push_back("beamlog");
+     defaultPhases.push_back("image");
+     const std::vector<std::string> phases = parset.getStringVector("phases", defaultPhases);
+     for (std::vector<std::string>::const_iterator it = phases.begin(); it != phases.end(); ++it) {
+          if (*it == "open") {
+              benchmarkOpen(comms, parset);
+          } else if (*it == "iterate") {
+              benchmarkIteration(comms, parset, 0, "iterate_local");
+              const int nReaders = parset.getInt32("nreaders", 0);
+              if (nReaders > 0) {
+                  ASKAPCHECK(nReaders < comms.nProcs(), "At least one worker rank is required, nreaders = "<<
+                             nReaders);
+                  benchmarkIteration(comms, parset, nReaders, "iterate_readers");
+              }
+          } else if (*it == "calibration") {
+              benchmarkCalibration(comms, parset);
+          } else if (*it == "beamlog") {
+              benchmarkBeamLog(comms, parset);
+          } else if (*it == "image") {
+              benchmarkImageWrite(comms, parset);
+          } else {
+              ASKAPTHROW(AskapError, "Unknown phase "<<*it<<", use open, iterate, calibration, beamlog or image");
+          }
+     }
+     if (comms.rank() == 0) {
+         printResults(parset.getString("format", "csv"), comms.isParallel() ? comms.nProcs() : 1);
+     }
+  }
+  catch(const AskapError &ce) {
+     cerr<<"AskapError has been caught. "<<ce.what()<<endl;
+     return -1;
+  }
+  catch(const std::exception &ex) {
+     cerr<<"std::exception has been caught. "<<ex.what()<<endl;
+     return -1;
+  }
+  catch(...) {
+     cerr<<"An unexpected exception has been caught"<<endl;
+     return -1;
+  }
+  return 0;
+}
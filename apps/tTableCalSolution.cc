@@ -2,6 +2,11 @@
 // @file tTableCalSolution.cc : evolving test/demonstration program of the
 //                        calibration table accessor
 //
+// In the benchmark mode (-benchmark option) a table of ASKAP size is created from
+// scratch and the times of typical operations are printed to stdout, one line per
+// operation with the name, elapsed time in seconds, number of operations and
+// the rate (operations per second).
+//
 /// @copyright (c) 2007 CSIRO
 /// Australia Telescope National Facility (ATNF)
 /// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
@@ -26,12 +31,13 @@
 ///
 
 
-#include <calibaccess/TableCalSolutionConstSource.h>
+#include <askap/calibaccess/TableCalSolutionConstSource.h>
+#include <askap/calibaccess/TableCalSolutionSource.h>
 #include <askap_accessors.h>
-#include <askap/AskapLogging.h>
+#include <askap/askap/AskapLogging.h>
 ASKAP_LOGGER(logger, "");
 
-#include <askap/AskapError.h>
+#include <askap/askap/AskapError.h>
 
 // casa
 #include <casacore/casa/OS/Timer.h>
@@ -40,6 +46,10 @@ ASKAP_LOGGER(logger, "");
 // std
 #include <stdexcept>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
 
 // boost
 #include <boost/shared_ptr.hpp>
@@ -81,10 +91,179 @@ void doReadOnlyTest(const ICalSolutionConstSource &src)
    }
 }
 
+/// @brief print the result of one benchmark
+/// @param[in] name name of the operation
+/// @param[in] seconds elapsed (real) time
+/// @param[in] count number of operations done
+void reportTiming(const std::string &name, const double seconds, const size_t count)
+{
+   std::cout<<name<<" "<<seconds<<" "<<count<<" "<<(seconds > 0. ? double(count) / seconds : 0.)<<std::endl;
+}
+
+/// @brief gain value used by the benchmark
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @param[in] sol solution number
+/// @return gains of both polarisations
+JonesJTerm benchmarkGain(const casa::uInt ant, const casa::uInt beam, const casa::uInt sol)
+{
+   return JonesJTerm(casa::Complex(1. + 0.01 * ant, 0.01 * beam), true, 
+                     casa::Complex(1. - 0.01 * beam, 0.001 * sol), true);
+}
+
+/// @brief benchmark of the table-based solution source of ASKAP size
+/// @details The table is created from scratch. All solutions have gains and leakages defined,
+/// the first nBandpass solutions also have bandpasses with nChan channels.
+/// @param[in] name table name
+/// @param[in] nSolutions number of solutions to write
+/// @param[in] nBandpass number of solutions with bandpasses
+/// @param[in] nChan number of spectral channels
+void doBenchmark(const std::string &name, const casa::uInt nSolutions, const casa::uInt nBandpass, 
+                 const casa::uInt nChan)
+{
+   const casa::uInt nAnt = 36;
+   const casa::uInt nBeam = 36;
+   // times of solutions, about 2010 in seconds since MJD=0, one solution per minute
+   const double startTime = 4.7e9;
+   const double interval = 60.;
+   std::cout<<"# benchmark of "<<name<<": nAnt="<<nAnt<<" nBeam="<<nBeam<<" nChan="<<nChan<<
+              " nSolutions="<<nSolutions<<" nBandpass="<<nBandpass<<std::endl;
+   std::cout<<"# operation seconds count rate"<<std::endl;
+   casa::Timer timer;
+   std::vector<long> ids;
+   ids.reserve(nSolutions);
+   {
+      TableCalSolutionSource::removeOldTable(name);
+      TableCalSolutionSource src(name, nAnt, nBeam, nChan);
+      double gainTime = 0.;
+      double bandpassTime = 0.;
+      for (casa::uInt sol = 0; sol < nSolutions; ++sol) {
+           timer.mark();
+           ids.push_back(src.newSolutionID(startTime + interval * sol));
+           {
+              boost::shared_ptr<ICalSolutionAccessor> acc = src.rwSolution(ids.back());
+              ASKAPASSERT(acc);
+              for (casa::uInt beam = 0; beam < nBeam; ++beam) {
+                   for (casa::uInt ant = 0; ant < nAnt; ++ant) {
+                        const JonesIndex index(ant, beam);
+                        acc->setGain(index, benchmarkGain(ant, beam, sol));
+                        acc->setLeakage(index, JonesDTerm(casa::Complex(0.01 * ant, 0.), true, 
+                                                          casa::Complex(0., 0.01 * beam), true));
+                        if (sol < nBandpass) {
+                            for (casa::uInt chan = 0; chan < nChan; ++chan) {
+                                 acc->setBandpass(index, benchmarkGain(ant, beam, chan), chan);
+                            }
+                        }
+                   }
+              }
+              // the accessor is synchronised with the table when it goes out of scope
+           }
+           if (sol < nBandpass) {
+               bandpassTime += timer.real();
+           } else {
+               gainTime += timer.real();
+           }
+      }
+      reportTiming("write_solution_gains", gainTime, nSolutions - std::min(nSolutions, nBandpass));
+      reportTiming("write_solution_bandpass", bandpassTime, std::min(nSolutions, nBandpass));
+   }
+   ASKAPCHECK(ids.size() > 0, "At least one solution is required for the benchmark");
+
+   timer.mark();
+   TableCalSolutionConstSource cs(name);
+   // cold reads are measured, so caching is switched off
+   cs.setCacheLimit(0);
+   reportTiming("open", timer.real(), 1);
+
+   const size_t nLookups = 10000;
+   timer.mark();
+   long checksum = 0;
+   for (size_t i = 0; i < nLookups; ++i) {
+        checksum += cs.solutionID(startTime + interval * nSolutions * double(i) / nLookups);
+   }
+   reportTiming("solution_id", timer.real(), nLookups);
+
+   timer.mark();
+   for (size_t sol = 0; sol < ids.size(); ++sol) {
+        boost::shared_ptr<ICalSolutionConstAccessor> acc = cs.roSolution(ids[sol]);
+        ASKAPASSERT(acc);
+   }
+   reportTiming("ro_solution", timer.real(), ids.size());
+
+   timer.mark();
+   for (size_t sol = 0; sol < ids.size(); ++sol) {
+        boost::shared_ptr<ICalSolutionConstAccessor> acc = cs.roSolution(ids[sol]);
+        ASKAPASSERT(acc);
+        for (casa::uInt beam = 0; beam < nBeam; ++beam) {
+             for (casa::uInt ant = 0; ant < nAnt; ++ant) {
+                  checksum += acc->gain(JonesIndex(ant, beam)).g1IsValid() ? 1 : 0;
+             }
+        }
+   }
+   reportTiming("read_gains", timer.real(), ids.size() * nAnt * nBeam);
+
+   if ((nBandpass > 0) && (nChan > 0)) {
+       // the first access to bandpass reads the whole cube
+       timer.mark();
+       boost::shared_ptr<ICalSolutionConstAccessor> acc = cs.roSolution(ids[0]);
+       ASKAPASSERT(acc);
+       checksum += acc->bandpass(JonesIndex(0u, 0u), 0).g1IsValid() ? 1 : 0;
+       reportTiming("read_bandpass_full", timer.real(), 1);
+
+       timer.mark();
+       for (casa::uInt beam = 0; beam < nBeam; ++beam) {
+            for (casa::uInt ant = 0; ant < nAnt; ++ant) {
+                 const JonesIndex index(ant, beam);
+                 for (casa::uInt chan = 0; chan < nChan; ++chan) {
+                      checksum += acc->bandpass(index, chan).g2IsValid() ? 1 : 0;
+                 }
+            }
+       }
+       reportTiming("bandpass", timer.real(), size_t(nAnt) * nBeam * nChan);
+
+       // jones() is the slowest path, a single beam is enough to measure the rate
+       timer.mark();
+       casa::Complex sum(0., 0.);
+       for (casa::uInt ant = 0; ant < nAnt; ++ant) {
+            for (casa::uInt chan = 0; chan < nChan; ++chan) {
+                 sum += acc->jones(ant, 0u, chan)(0, 0);
+            }
+       }
+       reportTiming("jones", timer.real(), size_t(nAnt) * nChan);
+
+       timer.mark();
+       casa::Array<casa::Complex> jones;
+       casa::Cube<casa::Bool> validity;
+       acc->jonesBlock(nAnt, nBeam, 0, nChan, jones, validity);
+       reportTiming("jones_block", timer.real(), size_t(nAnt) * nBeam * nChan);
+       acc.reset();
+
+       // a single beam and a quarter of the band
+       const casa::uInt nWindowChan = std::max(nChan / 4, 1u);
+       cs.setBandpassWindow(0u, 1u, 0u, nWindowChan);
+       timer.mark();
+       acc = cs.roSolution(ids[0]);
+       ASKAPASSERT(acc);
+       checksum += acc->bandpass(JonesIndex(0u, 0u), 0).g1IsValid() ? 1 : 0;
+       reportTiming("read_bandpass_partial", timer.real(), 1);
+       std::cout<<"# jones checksum: "<<sum<<std::endl;
+   }
+   std::cout<<"# checksum: "<<checksum<<std::endl;
+}
+
 int main(int argc, char **argv) {
   try {
+     if ((argc > 2) && (std::string(argv[1]) == "-benchmark")) {
+         const casa::uInt nSolutions = argc > 3 ? casa::uInt(atoi(argv[3])) : 200u;
+         const casa::uInt nBandpass = argc > 4 ? casa::uInt(atoi(argv[4])) : 1u;
+         const casa::uInt nChan = argc > 5 ? casa::uInt(atoi(argv[5])) : 16416u;
+         doBenchmark(argv[2], nSolutions, nBandpass, nChan);
+         return 0;
+     }
      if (argc!=2) {
          cerr<<"Usage "<<argv[0]<<" cal_table"<<endl;
+         cerr<<"      "<<argv[0]<<" -benchmark cal_table [nSolutions [nBandpass [nChan]]]"<<endl;
+         cerr<<"(the table is overwritten in the benchmark mode)"<<endl;
 	 return -2;
      }
 
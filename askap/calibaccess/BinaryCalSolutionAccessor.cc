@@ -0,0 +1,284 @@
+/// @file
+/// @brief accessor working with a memory-mapped calibration solution file
+/// @details This accessor reads and writes gains, leakages and bandpasses of one
+/// solution directly in the memory-mapped file managed by BinaryCalSolutionFile.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/calibaccess/BinaryCalSolutionAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] file shared pointer to the file with solutions
+/// @param[in] id solution ID
+/// @param[in] readonly if true, setter methods throw an exception
+BinaryCalSolutionAccessor::BinaryCalSolutionAccessor(const boost::shared_ptr<BinaryCalSolutionFile> &file, 
+       const long id, const bool readonly) : itsFile(file), itsID(id), itsReadOnly(readonly)
+{
+  ASKAPCHECK(itsFile, "Uninitialised calibration solution file has been passed to BinaryCalSolutionAccessor");
+  ASKAPCHECK((id >= 0) && (id < itsFile->nSolutions()), "Solution ID="<<id<<" is not present in the calibration solution file");
+  ASKAPCHECK(readonly || !itsFile->readOnly(), "Calibration solution file is opened read-only, unable to set up a writable accessor");
+  for (size_t product = 0; product < 3; ++product) {
+       itsSources[product] = -2;
+  }
+}
+
+/// @brief obtain gains (J-Jones)
+/// @details This method retrieves parallel-hand gains for both
+/// polarisations (corresponding to XX and YY). If no gains are defined
+/// for a particular index, gains of 1. with invalid flags set are
+/// returned.
+/// @param[in] index ant/beam index
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm BinaryCalSolutionAccessor::gain(const JonesIndex &index) const
+{
+  const size_t pos = offset(index);
+  const long src = source(BinaryCalSolutionFile::GAINS);
+  if (src < 0) {
+      return JonesJTerm(1., false, 1., false);
+  }
+  const casacore::Complex *values = itsFile->values(src, BinaryCalSolutionFile::GAINS);
+  const LOFAR::uint64 *flags = itsFile->validity(src, BinaryCalSolutionFile::GAINS);
+  return JonesJTerm(values[pos], BinaryCalSolutionFile::isValid(flags, pos), 
+                    values[pos + 1], BinaryCalSolutionFile::isValid(flags, pos + 1));
+}
+
+/// @brief obtain leakage (D-Jones)
+/// @details This method retrieves cross-hand elements of the
+/// Jones matrix (polarisation leakages). There are two values
+/// (corresponding to XY and YX) returned (as members of JonesDTerm
+/// class). If no leakages are defined for a particular index,
+/// zero leakages are returned with invalid flags set.
+/// @param[in] index ant/beam index
+/// @return JonesDTerm object with leakages and validity flags
+JonesDTerm BinaryCalSolutionAccessor::leakage(const JonesIndex &index) const
+{
+  const size_t pos = offset(index);
+  const long src = source(BinaryCalSolutionFile::LEAKAGES);
+  if (src < 0) {
+      return JonesDTerm(0., false, 0., false);
+  }
+  const casacore::Complex *values = itsFile->values(src, BinaryCalSolutionFile::LEAKAGES);
+  const LOFAR::uint64 *flags = itsFile->validity(src, BinaryCalSolutionFile::LEAKAGES);
+  return JonesDTerm(values[pos], BinaryCalSolutionFile::isValid(flags, pos), 
+                    values[pos + 1], BinaryCalSolutionFile::isValid(flags, pos + 1));
+}
+
+/// @brief obtain bandpass (frequency dependent J-Jones)
+/// @details This method retrieves parallel-hand spectral
+/// channel-dependent gain (also known as bandpass) for a
+/// given channel and antenna/beam. If no bandpass is defined, 
+/// gains of 1.0 are returned (with invalid flag is set).
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel of interest
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm BinaryCalSolutionAccessor::bandpass(const JonesIndex &index, const casacore::uInt chan) const
+{
+  ASKAPCHECK(chan < itsFile->nChan(), "Requested channel "<<chan<<" is outside the calibration solution file with "<<
+             itsFile->nChan()<<" channels");
+  const size_t pos = offset(index) * itsFile->nChan() + 2 * chan;
+  const long src = source(BinaryCalSolutionFile::BANDPASSES);
+  if (src < 0) {
+      return JonesJTerm(1., false, 1., false);
+  }
+  const casacore::Complex *values = itsFile->values(src, BinaryCalSolutionFile::BANDPASSES);
+  const LOFAR::uint64 *flags = itsFile->validity(src, BinaryCalSolutionFile::BANDPASSES);
+  return JonesJTerm(values[pos], BinaryCalSolutionFile::isValid(flags, pos), 
+                    values[pos + 1], BinaryCalSolutionFile::isValid(flags, pos + 1));
+}
+
+/// @brief set gains (J-Jones)
+/// @details This method writes parallel-hand gains for both
+/// polarisations (corresponding to XX and YY)
+/// @param[in] index ant/beam index
+/// @param[in] gains JonesJTerm object with gains and validity flags
+void BinaryCalSolutionAccessor::setGain(const JonesIndex &index, const JonesJTerm &gains)
+{
+  const size_t pos = offset(index);
+  prepareWrite(BinaryCalSolutionFile::GAINS);
+  casacore::Complex *values = itsFile->rwValues(itsID, BinaryCalSolutionFile::GAINS);
+  LOFAR::uint64 *flags = itsFile->rwValidity(itsID, BinaryCalSolutionFile::GAINS);
+  values[pos] = gains.g1();
+  values[pos + 1] = gains.g2();
+  BinaryCalSolutionFile::setValid(flags, pos, gains.g1IsValid());
+  BinaryCalSolutionFile::setValid(flags, pos + 1, gains.g2IsValid());
+}
+
+/// @brief set leakages (D-Jones)
+/// @details This method writes cross-pol leakages
+/// (corresponding to XY and YX)
+/// @param[in] index ant/beam index
+/// @param[in] leakages JonesDTerm object with leakages and validity flags
+void BinaryCalSolutionAccessor::setLeakage(const JonesIndex &index, const JonesDTerm &leakages)
+{
+  const size_t pos = offset(index);
+  prepareWrite(BinaryCalSolutionFile::LEAKAGES);
+  casacore::Complex *values = itsFile->rwValues(itsID, BinaryCalSolutionFile::LEAKAGES);
+  LOFAR::uint64 *flags = itsFile->rwValidity(itsID, BinaryCalSolutionFile::LEAKAGES);
+  values[pos] = leakages.d12();
+  values[pos + 1] = leakages.d21();
+  BinaryCalSolutionFile::setValid(flags, pos, leakages.d12IsValid());
+  BinaryCalSolutionFile::setValid(flags, pos + 1, leakages.d21IsValid());
+}
+
+/// @brief set gains for a single bandpass channel
+/// @details This method writes parallel-hand gains corresponding to a single
+/// spectral channel (i.e. one bandpass element).
+/// @param[in] index ant/beam index
+/// @param[in] bp JonesJTerm object with gains for the given channel and validity flags
+/// @param[in] chan spectral channel
+void BinaryCalSolutionAccessor::setBandpass(const JonesIndex &index, const JonesJTerm &bp, const casacore::uInt chan)
+{
+  ASKAPCHECK(chan < itsFile->nChan(), "Requested channel "<<chan<<" is outside the calibration solution file with "<<
+             itsFile->nChan()<<" channels");
+  const size_t pos = offset(index) * itsFile->nChan() + 2 * chan;
+  prepareWrite(BinaryCalSolutionFile::BANDPASSES);
+  casacore::Complex *values = itsFile->rwValues(itsID, BinaryCalSolutionFile::BANDPASSES);
+  LOFAR::uint64 *flags = itsFile->rwValidity(itsID, BinaryCalSolutionFile::BANDPASSES);
+  values[pos] = bp.g1();
+  values[pos + 1] = bp.g2();
+  BinaryCalSolutionFile::setValid(flags, pos, bp.g1IsValid());
+  BinaryCalSolutionFile::setValid(flags, pos + 1, bp.g2IsValid());
+}
+
+/// @brief write gains for all antennas of one beam
+/// @details This version writes the block straight into the mapped file.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] gains pointer to 2 * nAnt gains in the order of setGains
+/// @param[in] validity pointer to 2 * nAnt validity flags
+void BinaryCalSolutionAccessor::writeGainBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::Complex *gains, const casacore::Bool *validity)
+{
+  if (nAnt > 0) {
+      // the last antenna is checked against the geometry, values of all antennas are contiguous
+      const size_t pos = offset(JonesIndex(0u, beam));
+      offset(JonesIndex(nAnt - 1, beam));
+      writeBlock(BinaryCalSolutionFile::GAINS, pos, 2 * size_t(nAnt), gains, validity);
+  }
+}
+
+/// @brief write leakages for all antennas of one beam
+/// @details This version writes the block straight into the mapped file.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] leakages pointer to 2 * nAnt leakages in the order of setLeakages
+/// @param[in] validity pointer to 2 * nAnt validity flags
+void BinaryCalSolutionAccessor::writeLeakageBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::Complex *leakages, const casacore::Bool *validity)
+{
+  if (nAnt > 0) {
+      const size_t pos = offset(JonesIndex(0u, beam));
+      offset(JonesIndex(nAnt - 1, beam));
+      writeBlock(BinaryCalSolutionFile::LEAKAGES, pos, 2 * size_t(nAnt), leakages, validity);
+  }
+}
+
+/// @brief write bandpasses for all antennas of one beam in a range of channels
+/// @details This version writes the channel range of each antenna straight into the mapped file.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[in] bp pointer to 2 * nChan * nAnt bandpass gains in the order of setBandpasses
+/// @param[in] validity pointer to 2 * nChan * nAnt validity flags
+void BinaryCalSolutionAccessor::writeBandpassBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::uInt startChan, const casacore::uInt nChan, const casacore::Complex *bp,
+                const casacore::Bool *validity)
+{
+  ASKAPCHECK(startChan + nChan <= itsFile->nChan(), "Requested channels "<<startChan<<" to "<<startChan + nChan - 1<<
+             " are outside the calibration solution file with "<<itsFile->nChan()<<" channels");
+  const size_t blockSize = 2 * size_t(nChan);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant, bp += blockSize, validity += blockSize) {
+       const size_t pos = offset(JonesIndex(ant, beam)) * itsFile->nChan() + 2 * startChan;
+       writeBlock(BinaryCalSolutionFile::BANDPASSES, pos, blockSize, bp, validity);
+  }
+}
+
+/// @brief write a block of values and validity flags of one product
+/// @param[in] product calibration product
+/// @param[in] pos index of the first value in the product arrays
+/// @param[in] size number of values
+/// @param[in] values pointer to the values
+/// @param[in] validity pointer to the validity flags
+void BinaryCalSolutionAccessor::writeBlock(const BinaryCalSolutionFile::Product product, const size_t pos, 
+                const size_t size, const casacore::Complex *values, const casacore::Bool *validity)
+{
+  prepareWrite(product);
+  std::copy(values, values + size, itsFile->rwValues(itsID, product) + pos);
+  LOFAR::uint64 *flags = itsFile->rwValidity(itsID, product);
+  for (size_t i = 0; i < size; ++i) {
+       BinaryCalSolutionFile::setValid(flags, pos + i, validity[i]);
+  }
+}
+
+/// @brief index of the first polarisation of the given antenna and beam
+/// @details An exception is thrown if the index is outside the geometry of the file
+/// @param[in] index ant/beam index
+/// @return index of the value in the gain or leakage arrays
+size_t BinaryCalSolutionAccessor::offset(const JonesIndex &index) const
+{
+  const casacore::Short ant = index.antenna();
+  const casacore::Short beam = index.beam();
+  ASKAPCHECK((ant >= 0) && (casacore::uInt(ant) < itsFile->nAnt()), "Requested antenna index "<<ant<<
+             " is outside the calibration solution file with "<<itsFile->nAnt()<<" antennas");
+  ASKAPCHECK((beam >= 0) && (casacore::uInt(beam) < itsFile->nBeam()), "Requested beam index "<<beam<<
+             " is outside the calibration solution file with "<<itsFile->nBeam()<<" beams");
+  return 2 * (size_t(ant) + size_t(itsFile->nAnt()) * size_t(beam));
+}
+
+/// @brief solution defining the given product
+/// @param[in] product calibration product
+/// @return solution ID (-1 if no solution defines the product)
+long BinaryCalSolutionAccessor::source(const BinaryCalSolutionFile::Product product) const
+{
+  if (itsSources[product] < -1) {
+      itsSources[product] = itsFile->definingSolution(itsID, product);
+  }
+  return itsSources[product];
+}
+
+/// @brief prepare the given product for writing
+/// @param[in] product calibration product
+void BinaryCalSolutionAccessor::prepareWrite(const BinaryCalSolutionFile::Product product)
+{
+  ASKAPCHECK(!itsReadOnly, "Setter methods are not allowed for the read-only accessor");
+  if (itsSources[product] != itsID) {
+      itsFile->define(itsID, product);
+      itsSources[product] = itsID;
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
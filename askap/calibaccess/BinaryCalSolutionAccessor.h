@@ -0,0 +1,185 @@
+/// @file
+/// @brief accessor working with a memory-mapped calibration solution file
+/// @details This accessor reads and writes gains, leakages and bandpasses of one
+/// solution directly in the memory-mapped file managed by BinaryCalSolutionFile.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_ACCESSOR_H
+#define ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_ACCESSOR_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionAccessor.h>
+#include <askap/calibaccess/BinaryCalSolutionFile.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief accessor working with a memory-mapped calibration solution file
+/// @details Each value is obtained via a pointer offset into the record of the solution
+/// (or of the earlier solution the product is inherited from). The solution defining each
+/// product is found on the first access and remembered. Writes go straight into the mapped
+/// file, the first write of a product copies the inherited values into the record of this
+/// solution first (so the remaining values are not changed). If no solution defines a 
+/// product, default values with invalid flags are returned.
+/// @ingroup calibaccess
+class BinaryCalSolutionAccessor : virtual public ICalSolutionAccessor {
+public:
+  /// @brief constructor
+  /// @param[in] file shared pointer to the file with solutions
+  /// @param[in] id solution ID
+  /// @param[in] readonly if true, setter methods throw an exception
+  BinaryCalSolutionAccessor(const boost::shared_ptr<BinaryCalSolutionFile> &file, const long id, 
+                            const bool readonly = true);
+
+  /// @brief obtain gains (J-Jones)
+  /// @details This method retrieves parallel-hand gains for both
+  /// polarisations (corresponding to XX and YY). If no gains are defined
+  /// for a particular index, gains of 1. with invalid flags set are
+  /// returned.
+  /// @param[in] index ant/beam index
+  /// @return JonesJTerm object with gains and validity flags
+  virtual JonesJTerm gain(const JonesIndex &index) const;
+
+  /// @brief obtain leakage (D-Jones)
+  /// @details This method retrieves cross-hand elements of the
+  /// Jones matrix (polarisation leakages). There are two values
+  /// (corresponding to XY and YX) returned (as members of JonesDTerm
+  /// class). If no leakages are defined for a particular index,
+  /// zero leakages are returned with invalid flags set.
+  /// @param[in] index ant/beam index
+  /// @return JonesDTerm object with leakages and validity flags
+  virtual JonesDTerm leakage(const JonesIndex &index) const;
+
+  /// @brief obtain bandpass (frequency dependent J-Jones)
+  /// @details This method retrieves parallel-hand spectral
+  /// channel-dependent gain (also known as bandpass) for a
+  /// given channel and antenna/beam. If no bandpass is defined, 
+  /// gains of 1.0 are returned (with invalid flag is set).
+  /// @param[in] index ant/beam index
+  /// @param[in] chan spectral channel of interest
+  /// @return JonesJTerm object with gains and validity flags
+  virtual JonesJTerm bandpass(const JonesIndex &index, const casacore::uInt chan) const;
+
+  /// @brief set gains (J-Jones)
+  /// @details This method writes parallel-hand gains for both
+  /// polarisations (corresponding to XX and YY)
+  /// @param[in] index ant/beam index
+  /// @param[in] gains JonesJTerm object with gains and validity flags
+  virtual void setGain(const JonesIndex &index, const JonesJTerm &gains);
+
+  /// @brief set leakages (D-Jones)
+  /// @details This method writes cross-pol leakages
+  /// (corresponding to XY and YX)
+  /// @param[in] index ant/beam index
+  /// @param[in] leakages JonesDTerm object with leakages and validity flags
+  virtual void setLeakage(const JonesIndex &index, const JonesDTerm &leakages);
+
+  /// @brief set gains for a single bandpass channel
+  /// @details This method writes parallel-hand gains corresponding to a single
+  /// spectral channel (i.e. one bandpass element).
+  /// @param[in] index ant/beam index
+  /// @param[in] bp JonesJTerm object with gains for the given channel and validity flags
+  /// @param[in] chan spectral channel
+  virtual void setBandpass(const JonesIndex &index, const JonesJTerm &bp, const casacore::uInt chan);
+
+protected:
+  /// @brief write gains for all antennas of one beam
+  /// @details This version writes the block straight into the mapped file.
+  /// @param[in] beam beam index
+  /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+  /// @param[in] gains pointer to 2 * nAnt gains in the order of setGains
+  /// @param[in] validity pointer to 2 * nAnt validity flags
+  virtual void writeGainBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::Complex *gains,
+                              const casacore::Bool *validity);
+
+  /// @brief write leakages for all antennas of one beam
+  /// @details This version writes the block straight into the mapped file.
+  /// @param[in] beam beam index
+  /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+  /// @param[in] leakages pointer to 2 * nAnt leakages in the order of setLeakages
+  /// @param[in] validity pointer to 2 * nAnt validity flags
+  virtual void writeLeakageBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::Complex *leakages,
+                                 const casacore::Bool *validity);
+
+  /// @brief write bandpasses for all antennas of one beam in a range of channels
+  /// @details This version writes the channel range of each antenna straight into the mapped file.
+  /// @param[in] beam beam index
+  /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+  /// @param[in] startChan first spectral channel
+  /// @param[in] nChan number of spectral channels
+  /// @param[in] bp pointer to 2 * nChan * nAnt bandpass gains in the order of setBandpasses
+  /// @param[in] validity pointer to 2 * nChan * nAnt validity flags
+  virtual void writeBandpassBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                                  const casacore::uInt nChan, const casacore::Complex *bp, const casacore::Bool *validity);
+
+  /// @brief write a block of values and validity flags of one product
+  /// @param[in] product calibration product
+  /// @param[in] pos index of the first value in the product arrays
+  /// @param[in] size number of values
+  /// @param[in] values pointer to the values
+  /// @param[in] validity pointer to the validity flags
+  void writeBlock(const BinaryCalSolutionFile::Product product, const size_t pos, const size_t size,
+                  const casacore::Complex *values, const casacore::Bool *validity);
+
+  /// @brief index of the first polarisation of the given antenna and beam
+  /// @details An exception is thrown if the index is outside the geometry of the file
+  /// @param[in] index ant/beam index
+  /// @return index of the value in the gain or leakage arrays
+  size_t offset(const JonesIndex &index) const;
+
+  /// @brief solution defining the given product
+  /// @param[in] product calibration product
+  /// @return solution ID (-1 if no solution defines the product)
+  long source(const BinaryCalSolutionFile::Product product) const;
+
+  /// @brief prepare the given product for writing
+  /// @param[in] product calibration product
+  void prepareWrite(const BinaryCalSolutionFile::Product product);
+
+private:
+  /// @brief file with solutions
+  boost::shared_ptr<BinaryCalSolutionFile> itsFile;
+
+  /// @brief solution ID
+  const long itsID;
+
+  /// @brief true if setters are not allowed
+  const bool itsReadOnly;
+
+  /// @brief solutions defining each product, -2 if not known yet
+  mutable long itsSources[3];
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_ACCESSOR_H
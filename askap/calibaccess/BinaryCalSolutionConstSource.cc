@@ -0,0 +1,112 @@
+/// @file
+/// @brief read-only solution source working with a memory-mapped binary file
+/// @details This implementation reads calibration solutions from a flat binary file
+/// (see BinaryCalSolutionFile for the format), which is mapped into memory. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/calibaccess/BinaryCalSolutionConstSource.h>
+#include <askap/calibaccess/BinaryCalSolutionAccessor.h>
+#include <askap/calibaccess/CalibrationStatistics.h>
+#include <askap/dataaccess/AccessTracer.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] name file name
+BinaryCalSolutionConstSource::BinaryCalSolutionConstSource(const std::string &name) :
+        itsFile(new BinaryCalSolutionFile(name))
+{
+  ASKAPCHECK(itsFile->nSolutions() > 0, "The calibration solution file "<<name<<
+             " passed to BinaryCalSolutionConstSource is empty");
+}
+
+/// @brief constructor used by derived classes
+/// @param[in] file shared pointer to the opened file
+BinaryCalSolutionConstSource::BinaryCalSolutionConstSource(const boost::shared_ptr<BinaryCalSolutionFile> &file) :
+        itsFile(file)
+{
+  ASKAPASSERT(itsFile);
+}
+
+/// @brief obtain ID for the most recent solution
+/// @return ID for the most recent solution
+long BinaryCalSolutionConstSource::mostRecentSolution() const
+{
+  // derived classes may create an empty file for writing
+  return itsFile->nSolutions() - 1;
+}
+
+/// @brief obtain solution ID for a given time
+/// @details This method looks for a solution valid at the given time
+/// and returns its ID. It is equivalent to mostRecentSolution() if
+/// called with a time sufficiently into the future. The time index is
+/// searched from the most recent solution backwards.
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long BinaryCalSolutionConstSource::solutionID(const double time) const
+{
+  const CalibrationStatistics::ScopedTimer timer(CalibrationStatistics::SOLUTION_ID);
+  for (long id = itsFile->nSolutions() - 1; id >= 0; --id) {
+       if (itsFile->time(id) <= time) {
+           CalibrationStatistics::instance().addScan(casacore::uInt64(itsFile->nSolutions() - id));
+           return id;
+       }
+  }
+  CalibrationStatistics::instance().addScan(casacore::uInt64(itsFile->nSolutions()));
+  ASKAPTHROW(AskapError, "Unable to find solution matching the time "<<time<<", the file doesn't go that far in the past");
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @details This method returns a shared pointer to the solution accessor, which
+/// can be used to read the parameters. If a solution with the given ID doesn't 
+/// exist, an exception is thrown. Existing solutions with undefined parameters 
+/// are managed via validity flags of gains, leakages and bandpasses
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> BinaryCalSolutionConstSource::roSolution(const long id) const
+{
+  const AccessTracer::Scope trace("roSolution", "calibaccess");
+  const CalibrationStatistics::ScopedTimer timer(CalibrationStatistics::RO_SOLUTION);
+  CalibrationStatistics::instance().accessorCreated();
+  boost::shared_ptr<BinaryCalSolutionAccessor> result(new BinaryCalSolutionAccessor(itsFile, id, true));
+  return result;
+}
+
+/// @brief check whether the file exists
+/// @param[in] name file name
+/// @return true if the file exists and can be read
+bool BinaryCalSolutionConstSource::fileExists(const std::string &name)
+{
+  return BinaryCalSolutionFile::fileExists(name);
+}
+
+} // namespace accessors
+
+} // namespace askap
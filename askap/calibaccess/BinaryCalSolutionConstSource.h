@@ -0,0 +1,104 @@
+/// @file
+/// @brief read-only solution source working with a memory-mapped binary file
+/// @details This implementation reads calibration solutions from a flat binary file
+/// (see BinaryCalSolutionFile for the format), which is mapped into memory. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_CONST_SOURCE_H
+#define ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_CONST_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/BinaryCalSolutionFile.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief read-only solution source working with a memory-mapped binary file
+/// @details Solution IDs are indices of the records in the file. Opening the file only 
+/// checks its header, the data are paged in by the operating system when they are accessed. 
+/// Solutions added to the file by another process after it has been opened are picked up.
+/// @ingroup calibaccess
+class BinaryCalSolutionConstSource : virtual public ICalSolutionConstSource {
+public:
+  /// @brief constructor
+  /// @param[in] name file name
+  explicit BinaryCalSolutionConstSource(const std::string &name);
+
+  /// @brief obtain ID for the most recent solution
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const;
+  
+  /// @brief obtain solution ID for a given time
+  /// @details This method looks for a solution valid at the given time
+  /// and returns its ID. It is equivalent to mostRecentSolution() if
+  /// called with a time sufficiently into the future. The time index is
+  /// searched from the most recent solution backwards.
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const;
+  
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @details This method returns a shared pointer to the solution accessor, which
+  /// can be used to read the parameters. If a solution with the given ID doesn't 
+  /// exist, an exception is thrown. Existing solutions with undefined parameters 
+  /// are managed via validity flags of gains, leakages and bandpasses
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+  /// @brief check whether the file exists
+  /// @param[in] name file name
+  /// @return true if the file exists and can be read
+  static bool fileExists(const std::string &name);
+
+protected:
+  /// @brief constructor used by derived classes
+  /// @param[in] file shared pointer to the opened file
+  explicit BinaryCalSolutionConstSource(const boost::shared_ptr<BinaryCalSolutionFile> &file);
+
+  /// @brief access to the file
+  /// @return shared pointer to the file with solutions
+  inline const boost::shared_ptr<BinaryCalSolutionFile>& file() const { return itsFile; }
+
+private:
+  /// @brief file with solutions
+  boost::shared_ptr<BinaryCalSolutionFile> itsFile;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_CONST_SOURCE_H
@@ -0,0 +1,447 @@
+/// @file
+/// @brief memory-mapped file with calibration solutions
+/// @details This class manages a flat binary file with calibration solutions which is 
+/// mapped into memory. The file starts with a fixed header describing the geometry 
+/// followed by the time index and fixed-size records, one per solution. Each record holds
+/// aligned arrays with gains, leakages and bandpasses together with bit-packed validity 
+/// flags, so any element can be accessed via a pointer offset without parsing. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/calibaccess/BinaryCalSolutionFile.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// system includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// std includes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief magic number identifying the format ("ASKAPCAL")
+const LOFAR::uint64 theirMagic = 0x4c414350414b5341ull;
+
+/// @brief alignment of arrays in bytes
+const size_t theirAlignment = 64;
+
+/// @brief alignment of the first record in bytes
+const size_t theirPageSize = 4096;
+
+/// @brief round the size up to the multiple of the given alignment 
+/// @param[in] size size in bytes
+/// @param[in] alignment alignment in bytes (should be a power of 2)
+/// @return aligned size
+inline size_t alignSize(size_t size, size_t alignment = theirAlignment) 
+{ return (size + alignment - 1) & ~(alignment - 1); }
+
+/// @brief number of 64-bit words required to store the given number of flags
+/// @param[in] nFlags number of flags
+/// @return number of words
+inline size_t nWords(size_t nFlags) { return (nFlags + 63) / 64; }
+
+} // anonymous namespace
+
+const LOFAR::uint64 BinaryCalSolutionFile::theirVersion;
+
+/// @brief open an existing file read-only
+/// @param[in] name file name
+BinaryCalSolutionFile::BinaryCalSolutionFile(const std::string &name) : itsName(name), itsReadOnly(true),
+    itsFD(-1), itsSize(0), itsData(NULL), itsHeader(NULL), itsDataOffset(0)
+{
+  itsFD = open(name.c_str(), O_RDONLY);
+  if (itsFD < 0) {
+      ASKAPTHROW(DataAccessError, "Unable to open calibration solution file "<<name<<": "<<std::strerror(errno));
+  }
+  try {
+     struct stat info;
+     if ((fstat(itsFD, &info) != 0) || (size_t(info.st_size) < sizeof(Header))) {
+         ASKAPTHROW(DataAccessError, "File "<<name<<" is too short to be a calibration solution file");
+     }
+     map(size_t(info.st_size));
+     checkHeader();
+     setLayout();
+  }
+  catch (...) {
+     if (itsData != NULL) {
+         munmap(itsData, itsSize);
+     }
+     close(itsFD);
+     throw;
+  }
+}
+
+/// @brief open an existing file for writing or create a new one
+/// @details An exception is thrown if an existing file has a different geometry
+/// @param[in] name file name
+/// @param[in] nAnt number of antennas
+/// @param[in] nBeam number of beams
+/// @param[in] nChan number of spectral channels
+/// @param[in] maxSolutions maximum number of solutions the file can hold
+BinaryCalSolutionFile::BinaryCalSolutionFile(const std::string &name, const casacore::uInt nAnt, 
+    const casacore::uInt nBeam, const casacore::uInt nChan, const casacore::uInt maxSolutions) : 
+    itsName(name), itsReadOnly(false), itsFD(-1), itsSize(0), itsData(NULL), itsHeader(NULL), itsDataOffset(0)
+{
+  ASKAPCHECK((nAnt > 0) && (nBeam > 0) && (nChan > 0), "Calibration solution file should have non-zero dimensions, you have nAnt="<<
+             nAnt<<" nBeam="<<nBeam<<" nChan="<<nChan);
+  ASKAPCHECK(maxSolutions > 0, "Calibration solution file should be able to hold at least one solution");
+  const bool exists = fileExists(name);
+  itsFD = open(name.c_str(), exists ? O_RDWR : O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (itsFD < 0) {
+      ASKAPTHROW(DataAccessError, "Unable to "<<(exists ? "open" : "create")<<" calibration solution file "<<name<<": "<<
+                 std::strerror(errno));
+  }
+  try {
+     if (exists) {
+         struct stat info;
+         if ((fstat(itsFD, &info) != 0) || (size_t(info.st_size) < sizeof(Header))) {
+             ASKAPTHROW(DataAccessError, "File "<<name<<" is too short to be a calibration solution file");
+         }
+         map(size_t(info.st_size));
+         checkHeader();
+         if ((itsHeader->itsNAnt != nAnt) || (itsHeader->itsNBeam != nBeam) || (itsHeader->itsNChan != nChan) ||
+             (itsHeader->itsMaxSolutions != maxSolutions)) {
+             ASKAPTHROW(DataAccessError, "Calibration solution file "<<name<<" has nAnt="<<itsHeader->itsNAnt<<
+                        " nBeam="<<itsHeader->itsNBeam<<" nChan="<<itsHeader->itsNChan<<" maxSolutions="<<
+                        itsHeader->itsMaxSolutions<<", you requested nAnt="<<nAnt<<" nBeam="<<nBeam<<" nChan="<<
+                        nChan<<" maxSolutions="<<maxSolutions);
+         }
+         setLayout();
+     } else {
+         const size_t dataOffset = alignSize(alignSize(sizeof(Header)) + 2 * sizeof(LOFAR::uint64) * maxSolutions, theirPageSize);
+         if (ftruncate(itsFD, off_t(dataOffset)) != 0) {
+             ASKAPTHROW(DataAccessError, "Unable to allocate "<<dataOffset<<" bytes for calibration solution file "<<name<<
+                        ": "<<std::strerror(errno));
+         }
+         map(dataOffset);
+         // the new file is filled with zeros, i.e. the time index and flags are empty
+         itsHeader->itsVersion = theirVersion;
+         itsHeader->itsNAnt = nAnt;
+         itsHeader->itsNBeam = nBeam;
+         itsHeader->itsNChan = nChan;
+         itsHeader->itsMaxSolutions = maxSolutions;
+         itsHeader->itsNSolutions = 0;
+         setLayout();
+         // readers check the magic number, so it is set last
+         __sync_synchronize();
+         itsHeader->itsMagic = theirMagic;
+     }
+  }
+  catch (...) {
+     if (itsData != NULL) {
+         munmap(itsData, itsSize);
+     }
+     close(itsFD);
+     if (!exists) {
+         unlink(name.c_str());
+     }
+     throw;
+  }
+}
+
+/// @brief unmap and close the file
+BinaryCalSolutionFile::~BinaryCalSolutionFile()
+{
+  munmap(itsData, itsSize);
+  close(itsFD);
+}
+
+/// @brief number of solutions
+/// @details The file is remapped if it has been extended by another process
+/// @return number of solutions stored in the file
+long BinaryCalSolutionFile::nSolutions() const
+{
+  ASKAPDEBUGASSERT(itsHeader != NULL);
+  const long result = long(itsHeader->itsNSolutions);
+  __sync_synchronize();
+  const size_t required = itsDataOffset + size_t(result) * itsHeader->itsRecordSize;
+  if (required > itsSize) {
+      // the file has been extended by the writer
+      struct stat info;
+      if ((fstat(itsFD, &info) != 0) || (size_t(info.st_size) < required)) {
+          ASKAPTHROW(DataAccessError, "Calibration solution file "<<itsName<<" is shorter than required for "<<
+                     result<<" solutions");
+      }
+      map(size_t(info.st_size));
+  }
+  return result;
+}
+
+/// @brief time stamp of the given solution
+/// @param[in] id solution ID
+/// @return time in seconds since MJD of 0.
+double BinaryCalSolutionFile::time(const long id) const
+{
+  checkID(id);
+  return times()[id];
+}
+
+/// @brief find the solution defining the given product
+/// @param[in] id solution ID
+/// @param[in] product calibration product
+/// @return ID of the most recent solution not later than id which defines the product,
+/// -1 if there is none
+long BinaryCalSolutionFile::definingSolution(const long id, const Product product) const
+{
+  checkID(id);
+  const LOFAR::uint64 mask = LOFAR::uint64(1) << product;
+  const LOFAR::uint64 *solutionFlags = flags();
+  for (long cur = id; cur >= 0; --cur) {
+       if (solutionFlags[cur] & mask) {
+           return cur;
+       }
+  }
+  return -1;
+}
+
+/// @brief number of values of the given product in one solution
+/// @param[in] product calibration product
+/// @return number of complex values
+size_t BinaryCalSolutionFile::nValues(const Product product) const
+{
+  const size_t nPerPol = size_t(itsHeader->itsNAnt) * size_t(itsHeader->itsNBeam) * 
+                         (product == BANDPASSES ? size_t(itsHeader->itsNChan) : 1u);
+  return 2 * nPerPol;
+}
+
+/// @brief values of the given product (read-only)
+/// @param[in] id solution ID
+/// @param[in] product calibration product
+/// @return pointer to the first value
+const casacore::Complex* BinaryCalSolutionFile::values(const long id, const Product product) const
+{
+  checkID(id);
+  return reinterpret_cast<const casacore::Complex*>(record(id) + itsValueOffsets[product]);
+}
+
+/// @brief validity flags of the given product (read-only)
+/// @param[in] id solution ID
+/// @param[in] product calibration product
+/// @return pointer to the first word with packed flags
+const LOFAR::uint64* BinaryCalSolutionFile::validity(const long id, const Product product) const
+{
+  checkID(id);
+  return reinterpret_cast<const LOFAR::uint64*>(record(id) + itsValidityOffsets[product]);
+}
+
+/// @brief prepare the product of the given solution for writing
+/// @details If the solution doesn't define the product yet, the inherited values 
+/// are copied and the product is marked as defined.
+/// @param[in] id solution ID
+/// @param[in] product calibration product
+void BinaryCalSolutionFile::define(const long id, const Product product)
+{
+  ASKAPCHECK(!itsReadOnly, "Calibration solution file "<<itsName<<" is opened read-only");
+  const long src = definingSolution(id, product);
+  if (src == id) {
+      return;
+  }
+  casacore::Complex *dst = rwValues(id, product);
+  const size_t nVal = nValues(product);
+  if (src >= 0) {
+      std::copy(values(src, product), values(src, product) + nVal, dst);
+      std::copy(validity(src, product), validity(src, product) + nWords(nVal), rwValidity(id, product));
+  } else if (product != LEAKAGES) {
+      // values not defined at all are set to defaults with invalid flags (the record is filled with zeros)
+      std::fill(dst, dst + nVal, casacore::Complex(1., 0.));
+  }
+  flags()[id] |= LOFAR::uint64(1) << product;
+}
+
+/// @brief values of the given product (for writing)
+/// @details The product should be defined first
+/// @param[in] id solution ID
+/// @param[in] product calibration product
+/// @return pointer to the first value
+casacore::Complex* BinaryCalSolutionFile::rwValues(const long id, const Product product)
+{
+  ASKAPCHECK(!itsReadOnly, "Calibration solution file "<<itsName<<" is opened read-only");
+  checkID(id);
+  return reinterpret_cast<casacore::Complex*>(record(id) + itsValueOffsets[product]);
+}
+
+/// @brief validity flags of the given product (for writing)
+/// @details The product should be defined first
+/// @param[in] id solution ID
+/// @param[in] product calibration product
+/// @return pointer to the first word with packed flags
+LOFAR::uint64* BinaryCalSolutionFile::rwValidity(const long id, const Product product)
+{
+  ASKAPCHECK(!itsReadOnly, "Calibration solution file "<<itsName<<" is opened read-only");
+  checkID(id);
+  return reinterpret_cast<LOFAR::uint64*>(record(id) + itsValidityOffsets[product]);
+}
+
+/// @brief add a new solution
+/// @details All products of the new solution are inherited from earlier solutions
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return ID of the new solution
+long BinaryCalSolutionFile::addSolution(const double time)
+{
+  ASKAPCHECK(!itsReadOnly, "Calibration solution file "<<itsName<<" is opened read-only");
+  const long id = nSolutions();
+  if (LOFAR::uint64(id) >= itsHeader->itsMaxSolutions) {
+      ASKAPTHROW(DataAccessError, "Calibration solution file "<<itsName<<" is full, it can hold up to "<<
+                 itsHeader->itsMaxSolutions<<" solutions");
+  }
+  const size_t size = itsDataOffset + size_t(id + 1) * itsHeader->itsRecordSize;
+  if (ftruncate(itsFD, off_t(size)) != 0) {
+      ASKAPTHROW(DataAccessError, "Unable to extend calibration solution file "<<itsName<<" to "<<size<<
+                 " bytes: "<<std::strerror(errno));
+  }
+  map(size);
+  times()[id] = time;
+  flags()[id] = 0;
+  // readers rely on the number of solutions, so it is updated last
+  __sync_synchronize();
+  itsHeader->itsNSolutions = LOFAR::uint64(id + 1);
+  return id;
+}
+
+/// @brief check whether the file exists
+/// @param[in] name file name
+/// @return true if the file exists and can be read
+bool BinaryCalSolutionFile::fileExists(const std::string &name)
+{
+  return access(name.c_str(), R_OK) == 0;
+}
+
+/// @brief remove the file
+/// @details Nothing is done if the file doesn't exist
+/// @param[in] name file name
+void BinaryCalSolutionFile::removeOldFile(const std::string &name)
+{
+  if (fileExists(name)) {
+      if (unlink(name.c_str()) != 0) {
+          ASKAPTHROW(DataAccessError, "Unable to remove calibration solution file "<<name<<": "<<std::strerror(errno));
+      }
+  }
+}
+
+/// @brief map the file
+/// @details The previous mapping (if any) is released
+/// @param[in] size size of the file in bytes
+void BinaryCalSolutionFile::map(size_t size) const
+{
+  const int protection = itsReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+  void *ptr = mmap(NULL, size, protection, MAP_SHARED, itsFD, 0);
+  if (ptr == MAP_FAILED) {
+      ASKAPTHROW(DataAccessError, "Unable to map calibration solution file "<<itsName<<": "<<std::strerror(errno));
+  }
+  if (itsData != NULL) {
+      munmap(itsData, itsSize);
+  }
+  itsData = static_cast<char*>(ptr);
+  itsHeader = reinterpret_cast<Header*>(itsData);
+  itsSize = size;
+}
+
+/// @brief check the header of the file
+/// @details An exception is thrown if the file is not a calibration solution file of the
+/// supported version or if its size doesn't match the header
+void BinaryCalSolutionFile::checkHeader() const
+{
+  ASKAPDEBUGASSERT(itsHeader != NULL);
+  if (itsHeader->itsMagic != theirMagic) {
+      ASKAPTHROW(DataAccessError, "File "<<itsName<<" is not a calibration solution file");
+  }
+  __sync_synchronize();
+  if (itsHeader->itsVersion != theirVersion) {
+      ASKAPTHROW(DataAccessError, "Calibration solution file "<<itsName<<" has version "<<itsHeader->itsVersion<<
+                 ", only version "<<theirVersion<<" is supported");
+  }
+  const size_t dataOffset = alignSize(alignSize(sizeof(Header)) + 2 * sizeof(LOFAR::uint64) * 
+                                      itsHeader->itsMaxSolutions, theirPageSize);
+  if (dataOffset + size_t(itsHeader->itsNSolutions) * itsHeader->itsRecordSize > itsSize) {
+      ASKAPTHROW(DataAccessError, "Calibration solution file "<<itsName<<" is truncated, its size "<<itsSize<<
+                 " bytes is too small for "<<itsHeader->itsNSolutions<<" solutions");
+  }
+}
+
+/// @brief compute offsets of the arrays within the record
+/// @details The header should be mapped
+void BinaryCalSolutionFile::setLayout()
+{
+  ASKAPDEBUGASSERT(itsHeader != NULL);
+  itsDataOffset = alignSize(alignSize(sizeof(Header)) + 2 * sizeof(LOFAR::uint64) * itsHeader->itsMaxSolutions, 
+                            theirPageSize);
+  size_t offset = 0;
+  for (int product = GAINS; product <= BANDPASSES; ++product) {
+       itsValueOffsets[product] = offset;
+       offset += alignSize(nValues(Product(product)) * sizeof(casacore::Complex));
+  }
+  for (int product = GAINS; product <= BANDPASSES; ++product) {
+       itsValidityOffsets[product] = offset;
+       offset += alignSize(nWords(nValues(Product(product))) * sizeof(LOFAR::uint64));
+  }
+  if (itsReadOnly || (itsHeader->itsRecordSize != 0)) {
+      ASKAPCHECK(itsHeader->itsRecordSize == offset, "Calibration solution file "<<itsName<<" has record size of "<<
+                 itsHeader->itsRecordSize<<" bytes, "<<offset<<" bytes is expected from its geometry");
+  } else {
+      itsHeader->itsRecordSize = offset;
+  }
+}
+
+/// @brief check the solution ID
+/// @details The file is remapped if the ID is beyond the mapped area
+/// @param[in] id solution ID
+void BinaryCalSolutionFile::checkID(const long id) const
+{
+  if ((id < 0) || (LOFAR::uint64(id) >= itsHeader->itsNSolutions) || 
+      (itsDataOffset + size_t(id + 1) * itsHeader->itsRecordSize > itsSize)) {
+      ASKAPCHECK((id >= 0) && (id < nSolutions()), "Solution ID="<<id<<" is not present in the calibration solution file "<<
+                 itsName);
+  }
+}
+
+/// @brief time index
+/// @return pointer to the first time stamp
+double* BinaryCalSolutionFile::times() const
+{
+  return reinterpret_cast<double*>(itsData + alignSize(sizeof(Header)));
+}
+
+/// @brief flags of the products defined by solutions
+/// @return pointer to flags of the first solution
+LOFAR::uint64* BinaryCalSolutionFile::flags() const
+{
+  return reinterpret_cast<LOFAR::uint64*>(itsData + alignSize(sizeof(Header)) + 
+                                          sizeof(double) * size_t(itsHeader->itsMaxSolutions));
+}
+
+} // namespace accessors
+
+} // namespace askap
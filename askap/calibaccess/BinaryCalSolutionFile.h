@@ -0,0 +1,291 @@
+/// @file
+/// @brief memory-mapped file with calibration solutions
+/// @details This class manages a flat binary file with calibration solutions which is 
+/// mapped into memory. The file starts with a fixed header describing the geometry 
+/// followed by the time index and fixed-size records, one per solution. Each record holds
+/// aligned arrays with gains, leakages and bandpasses together with bit-packed validity 
+/// flags, so any element can be accessed via a pointer offset without parsing. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_FILE_H
+#define ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_FILE_H
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// LOFAR includes
+#include <Common/LofarTypes.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief memory-mapped file with calibration solutions
+/// @details The file layout is (all numbers are in the native byte order):
+///   - header (see the Header structure) padded to 64 bytes;
+///   - time index, maxSolutions time stamps (double) in seconds since MJD of 0;
+///   - flags, maxSolutions 64-bit words with bits set for products defined by the solution;
+///   - solution records (starting at the page boundary), nSolutions of them.
+/// 
+/// Each record has the following arrays, each starting at a 64-byte boundary: gains and 
+/// leakages (2 x nAnt x nBeam complex values each), bandpasses (2*nChan x nAnt x nBeam complex
+/// values, i.e. channel-dependent gains for both polarisations are interleaved), followed by
+/// validity flags of gains, leakages and bandpasses packed into 64-bit words (one bit per
+/// value with the same order). The first axis varies fastest, i.e. the layout is the same as 
+/// that of the cubes stored in calibration tables. A product which is not defined by the 
+/// solution is inherited from the most recent earlier solution which defines it. New records
+/// are appended to the file as it grows. The number of solutions in the header is updated
+/// last, so a reader opened during the write would never see an incomplete header. 
+/// Pointers returned by this class are valid until the next call of a method which may 
+/// remap the file (i.e. nSolutions, addSolution and methods taking solution ID).
+/// @ingroup calibaccess
+class BinaryCalSolutionFile : private boost::noncopyable {
+public:
+  /// @brief calibration products
+  enum Product {
+     GAINS = 0,
+     LEAKAGES,
+     BANDPASSES
+  };
+
+  /// @brief fixed header of the file
+  struct Header {
+     /// @brief magic number identifying the format
+     LOFAR::uint64 itsMagic;
+     /// @brief version of the format
+     LOFAR::uint64 itsVersion;
+     /// @brief number of antennas
+     LOFAR::uint64 itsNAnt;
+     /// @brief number of beams
+     LOFAR::uint64 itsNBeam;
+     /// @brief number of spectral channels
+     LOFAR::uint64 itsNChan;
+     /// @brief capacity of the time index
+     LOFAR::uint64 itsMaxSolutions;
+     /// @brief number of solutions stored in the file
+     LOFAR::uint64 itsNSolutions;
+     /// @brief size of one solution record in bytes
+     LOFAR::uint64 itsRecordSize;
+  };
+
+  /// @brief current version of the format
+  static const LOFAR::uint64 theirVersion = 1;
+
+  /// @brief open an existing file read-only
+  /// @param[in] name file name
+  explicit BinaryCalSolutionFile(const std::string &name);
+
+  /// @brief open an existing file for writing or create a new one
+  /// @details An exception is thrown if an existing file has a different geometry
+  /// @param[in] name file name
+  /// @param[in] nAnt number of antennas
+  /// @param[in] nBeam number of beams
+  /// @param[in] nChan number of spectral channels
+  /// @param[in] maxSolutions maximum number of solutions the file can hold
+  BinaryCalSolutionFile(const std::string &name, const casacore::uInt nAnt, const casacore::uInt nBeam,
+                        const casacore::uInt nChan, const casacore::uInt maxSolutions);
+
+  /// @brief unmap and close the file
+  ~BinaryCalSolutionFile();
+
+  /// @brief number of antennas
+  inline casacore::uInt nAnt() const { return casacore::uInt(itsHeader->itsNAnt); }
+
+  /// @brief number of beams
+  inline casacore::uInt nBeam() const { return casacore::uInt(itsHeader->itsNBeam); }
+
+  /// @brief number of spectral channels
+  inline casacore::uInt nChan() const { return casacore::uInt(itsHeader->itsNChan); }
+
+  /// @brief true if the file has been opened read-only
+  inline bool readOnly() const { return itsReadOnly; }
+
+  /// @brief number of solutions
+  /// @details The file is remapped if it has been extended by another process
+  /// @return number of solutions stored in the file
+  long nSolutions() const;
+
+  /// @brief time stamp of the given solution
+  /// @param[in] id solution ID
+  /// @return time in seconds since MJD of 0.
+  double time(const long id) const;
+
+  /// @brief find the solution defining the given product
+  /// @param[in] id solution ID
+  /// @param[in] product calibration product
+  /// @return ID of the most recent solution not later than id which defines the product,
+  /// -1 if there is none
+  long definingSolution(const long id, const Product product) const;
+
+  /// @brief number of values of the given product in one solution
+  /// @param[in] product calibration product
+  /// @return number of complex values
+  size_t nValues(const Product product) const;
+
+  /// @brief values of the given product (read-only)
+  /// @param[in] id solution ID
+  /// @param[in] product calibration product
+  /// @return pointer to the first value
+  const casacore::Complex* values(const long id, const Product product) const;
+
+  /// @brief validity flags of the given product (read-only)
+  /// @param[in] id solution ID
+  /// @param[in] product calibration product
+  /// @return pointer to the first word with packed flags
+  const LOFAR::uint64* validity(const long id, const Product product) const;
+
+  /// @brief prepare the product of the given solution for writing
+  /// @details If the solution doesn't define the product yet, the inherited values 
+  /// are copied and the product is marked as defined.
+  /// @param[in] id solution ID
+  /// @param[in] product calibration product
+  void define(const long id, const Product product);
+
+  /// @brief values of the given product (for writing)
+  /// @details The product should be defined first
+  /// @param[in] id solution ID
+  /// @param[in] product calibration product
+  /// @return pointer to the first value
+  casacore::Complex* rwValues(const long id, const Product product);
+
+  /// @brief validity flags of the given product (for writing)
+  /// @details The product should be defined first
+  /// @param[in] id solution ID
+  /// @param[in] product calibration product
+  /// @return pointer to the first word with packed flags
+  LOFAR::uint64* rwValidity(const long id, const Product product);
+
+  /// @brief add a new solution
+  /// @details All products of the new solution are inherited from earlier solutions
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return ID of the new solution
+  long addSolution(const double time);
+
+  /// @brief extract a validity flag
+  /// @param[in] flags pointer to packed flags
+  /// @param[in] index index of the value
+  /// @return true if the value is valid
+  static inline bool isValid(const LOFAR::uint64 *flags, size_t index) 
+     { return (flags[index / 64] >> (index % 64)) & 1u; }
+
+  /// @brief set a validity flag
+  /// @param[in] flags pointer to packed flags
+  /// @param[in] index index of the value
+  /// @param[in] flag new value of the flag
+  static inline void setValid(LOFAR::uint64 *flags, size_t index, bool flag) 
+     { const LOFAR::uint64 mask = LOFAR::uint64(1) << (index % 64);
+       flags[index / 64] = flag ? (flags[index / 64] | mask) : (flags[index / 64] & ~mask); }
+
+  /// @brief check whether the file exists
+  /// @param[in] name file name
+  /// @return true if the file exists and can be read
+  static bool fileExists(const std::string &name);
+
+  /// @brief remove the file
+  /// @details Nothing is done if the file doesn't exist
+  /// @param[in] name file name
+  static void removeOldFile(const std::string &name);
+
+  /// @brief shared pointer definition
+  typedef boost::shared_ptr<BinaryCalSolutionFile> ShPtr;
+
+protected:
+  /// @brief map the file
+  /// @details The previous mapping (if any) is released
+  /// @param[in] size size of the file in bytes
+  void map(size_t size) const;
+
+  /// @brief check the header of the file
+  /// @details An exception is thrown if the file is not a calibration solution file of the
+  /// supported version or if its size doesn't match the header
+  void checkHeader() const;
+
+  /// @brief compute offsets of the arrays within the record
+  /// @details The header should be mapped
+  void setLayout();
+
+  /// @brief check the solution ID
+  /// @details The file is remapped if the ID is beyond the mapped area
+  /// @param[in] id solution ID
+  void checkID(const long id) const;
+
+  /// @brief address of the record
+  /// @param[in] id solution ID
+  /// @return pointer to the first byte of the record
+  inline char* record(const long id) const 
+     { return itsData + itsDataOffset + size_t(id) * itsHeader->itsRecordSize; }
+
+  /// @brief time index
+  /// @return pointer to the first time stamp
+  double* times() const;
+
+  /// @brief flags of the products defined by solutions
+  /// @return pointer to flags of the first solution
+  LOFAR::uint64* flags() const;
+
+private:
+  /// @brief file name
+  std::string itsName;
+
+  /// @brief true if the file is opened read-only
+  bool itsReadOnly;
+
+  /// @brief file descriptor
+  int itsFD;
+
+  /// @brief size of the mapped area in bytes
+  mutable size_t itsSize;
+
+  /// @brief start of the mapped area
+  mutable char *itsData;
+
+  /// @brief mapped header (same address as itsData)
+  mutable Header *itsHeader;
+
+  /// @brief offset of the first record in bytes
+  size_t itsDataOffset;
+
+  /// @brief offsets of the value arrays within the record
+  size_t itsValueOffsets[3];
+
+  /// @brief offsets of the validity arrays within the record
+  size_t itsValidityOffsets[3];
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_FILE_H
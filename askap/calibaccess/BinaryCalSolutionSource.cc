@@ -0,0 +1,94 @@
+/// @file
+/// @brief solution source working with a memory-mapped binary file
+/// @details This implementation reads and writes calibration solutions using a flat binary 
+/// file (see BinaryCalSolutionFile for the format), which is mapped into memory. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/calibaccess/BinaryCalSolutionSource.h>
+#include <askap/calibaccess/BinaryCalSolutionAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// logging stuff
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, ".calibaccess");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @details An existing file is reused (its geometry should match the parameters),
+/// a new file is created otherwise.
+/// @param[in] name file name
+/// @param[in] nAnt maximum number of antennas
+/// @param[in] nBeam maximum number of beams
+/// @param[in] nChan maximum number of channels
+/// @param[in] maxSolutions maximum number of solutions
+BinaryCalSolutionSource::BinaryCalSolutionSource(const std::string &name, const casacore::uInt nAnt, 
+       const casacore::uInt nBeam, const casacore::uInt nChan, const casacore::uInt maxSolutions) :
+       BinaryCalSolutionConstSource(boost::shared_ptr<BinaryCalSolutionFile>(
+                 new BinaryCalSolutionFile(name, nAnt, nBeam, nChan, maxSolutions)))
+{
+  ASKAPLOG_DEBUG_STR(logger, "Calibration solution file "<<name<<" has "<<file()->nSolutions()<<" solutions");
+}
+
+/// @brief obtain a solution ID to store new solution
+/// @details This method provides a solution ID for a new solution. It must
+/// be called before any write operation (one needs a writable accessor to
+/// write the actual solution and to get this accessor one needs an ID).
+/// @param[in] time time stamp of the new solution in seconds since MJD of 0.
+/// @return solution ID
+long BinaryCalSolutionSource::newSolutionID(const double time)
+{
+  return file()->addSolution(time);
+}
+
+/// @brief obtain a writeable accessor for a given solution ID
+/// @details This method returns a shared pointer to the solution accessor, which
+/// can be used to both read the parameters and write them back. If a solution with 
+/// the given ID doesn't exist, an exception is thrown. Existing solutions with undefined 
+/// parameters are managed via validity flags of gains, leakages and bandpasses
+/// @param[in] id solution ID to access
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionAccessor> BinaryCalSolutionSource::rwSolution(const long id) const
+{
+  boost::shared_ptr<BinaryCalSolutionAccessor> result(new BinaryCalSolutionAccessor(file(), id, false));
+  return result;
+}
+
+/// @brief remove the file 
+/// @details Nothing is done if the file doesn't exist
+/// @param[in] name file name
+void BinaryCalSolutionSource::removeOldFile(const std::string &name)
+{
+  BinaryCalSolutionFile::removeOldFile(name);
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,91 @@
+/// @file
+/// @brief solution source working with a memory-mapped binary file
+/// @details This implementation reads and writes calibration solutions using a flat binary 
+/// file (see BinaryCalSolutionFile for the format), which is mapped into memory. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_SOURCE_H
+#define ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionSource.h>
+#include <askap/calibaccess/BinaryCalSolutionConstSource.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief solution source working with a memory-mapped binary file
+/// @details The geometry of the file (number of antennas, beams and channels) and the 
+/// maximum number of solutions are fixed when the file is created. Values written via 
+/// accessors go straight into the mapped file.
+/// @ingroup calibaccess
+class BinaryCalSolutionSource : public BinaryCalSolutionConstSource,
+                                virtual public ICalSolutionSource {
+public:
+  /// @brief constructor
+  /// @details An existing file is reused (its geometry should match the parameters),
+  /// a new file is created otherwise.
+  /// @param[in] name file name
+  /// @param[in] nAnt maximum number of antennas
+  /// @param[in] nBeam maximum number of beams
+  /// @param[in] nChan maximum number of channels
+  /// @param[in] maxSolutions maximum number of solutions
+  BinaryCalSolutionSource(const std::string &name, const casacore::uInt nAnt, const casacore::uInt nBeam,
+                          const casacore::uInt nChan, const casacore::uInt maxSolutions);
+
+  /// @brief obtain a solution ID to store new solution
+  /// @details This method provides a solution ID for a new solution. It must
+  /// be called before any write operation (one needs a writable accessor to
+  /// write the actual solution and to get this accessor one needs an ID).
+  /// @param[in] time time stamp of the new solution in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long newSolutionID(const double time);
+  
+  /// @brief obtain a writeable accessor for a given solution ID
+  /// @details This method returns a shared pointer to the solution accessor, which
+  /// can be used to both read the parameters and write them back. If a solution with 
+  /// the given ID doesn't exist, an exception is thrown. Existing solutions with undefined 
+  /// parameters are managed via validity flags of gains, leakages and bandpasses
+  /// @param[in] id solution ID to access
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionAccessor> rwSolution(const long id) const;
+
+  /// @brief remove the file 
+  /// @details Nothing is done if the file doesn't exist
+  /// @param[in] name file name
+  static void removeOldFile(const std::string &name);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_SOURCE_H
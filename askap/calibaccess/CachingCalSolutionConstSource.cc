@@ -0,0 +1,333 @@
+/// @file
+/// @brief client-side cache of calibration solutions
+/// @details This class wraps another calibration solution source (e.g. the one 
+/// working with the calibration service) and keeps accessors obtained from it in a
+/// local cache keyed by solution ID. The cache entries expire after a given time and
+/// the whole cache is dropped once the most recent solution ID reported by the 
+/// wrapped source changes. The next solution interval can be obtained in advance 
+/// by a background job, so the code applying calibration is not blocked by remote calls.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/calibaccess/CachingCalSolutionConstSource.h>
+#include <askap/dataaccess/AccessTracer.h>
+#include <askap/askap/AskapError.h>
+
+// logging stuff
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, ".calibaccess");
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// std includes
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] src solution source to obtain solutions from
+/// @param[in] ttl time-to-live of the cached information in seconds
+/// @param[in] maxEntries maximum number of cached solutions
+/// @param[in] prefetch if true, the next solution is obtained in advance by a background job
+CachingCalSolutionConstSource::CachingCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, 
+                double ttl, size_t maxEntries, bool prefetch) : itsSource(src), itsTTL(ttl), 
+                itsMaxEntries(maxEntries), itsPrefetch(prefetch), itsVersion(-1), itsVersionTime(0.),
+                itsVersionValid(false), itsLastTime(0.), itsLastID(-1), itsLastValid(false), itsPrefetchID(-1)
+{
+   ASKAPASSERT(src);
+   ASKAPCHECK(maxEntries > 0, "The cache of calibration solutions should have at least one entry");
+}
+
+/// @brief destructor, waits for the background job to finish
+CachingCalSolutionConstSource::~CachingCalSolutionConstSource()
+{
+   if (itsPrefetchJob.valid()) {
+       itsPrefetchJob.wait();
+   }
+}
+
+/// @brief obtain ID for the most recent solution
+/// @details The cached value is returned unless it is older than time-to-live.
+/// @return ID for the most recent solution
+long CachingCalSolutionConstSource::mostRecentSolution() const
+{
+   checkVersion();
+   return itsVersion;
+}
+
+/// @brief obtain solution ID for a given time
+/// @details The wrapped source is not called if the most recent solution has 
+/// already been found for an earlier time and the version has not changed since then,
+/// or if the same time is requested again.
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long CachingCalSolutionConstSource::solutionID(const double time) const
+{
+   checkVersion();
+   if (itsLastValid) {
+       if ((time == itsLastTime) || ((time > itsLastTime) && (itsLastID == itsVersion))) {
+           return itsLastID;
+       }
+   }
+   waitForPrefetch();
+   itsLastID = itsSource->solutionID(time);
+   itsLastTime = time;
+   itsLastValid = true;
+   return itsLastID;
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @details This method returns the cached accessor if it exists and has not expired,
+/// and obtains it from the wrapped source otherwise. 
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> CachingCalSolutionConstSource::roSolution(const long id) const
+{
+   const AccessTracer::Scope trace("roSolution", "calibaccess");
+   checkVersion();
+   boost::shared_ptr<ICalSolutionConstAccessor> acc = findCached(id);
+   if (!acc && itsPrefetchJob.valid() && (itsPrefetchID == id)) {
+       // the solution is being obtained right now
+       waitForPrefetch();
+       acc = findCached(id);
+   }
+   if (!acc) {
+       waitForPrefetch();
+       acc = itsSource->roSolution(id);
+       ASKAPDEBUGASSERT(acc);
+       addToCache(id, acc);
+   }
+   if (itsPrefetch && (id < itsVersion) && !itsPrefetchJob.valid() && !isCached(id + 1)) {
+       startPrefetch(id + 1);
+   }
+   return acc;
+}
+
+/// @brief obtain a number of solutions at once
+/// @details This method fills the cache with solutions for all given IDs, so subsequent 
+/// roSolution calls are served locally. Solutions which are already cached are not requested
+/// again. The actual request is done by the fetchSolutions method, which can be 
+/// overridden for sources capable of serving a number of solutions in one call.
+/// @param[in] ids vector with solution IDs
+void CachingCalSolutionConstSource::fetch(const std::vector<long> &ids) const
+{
+   checkVersion();
+   waitForPrefetch();
+   std::vector<long> missing;
+   missing.reserve(ids.size());
+   for (std::vector<long>::const_iterator ci = ids.begin(); ci != ids.end(); ++ci) {
+        if (!findCached(*ci)) {
+            missing.push_back(*ci);
+        }
+   }
+   if (missing.size() > 0) {
+       std::vector<boost::shared_ptr<ICalSolutionConstAccessor> > accessors;
+       fetchSolutions(missing, accessors);
+       ASKAPCHECK(accessors.size() == missing.size(), "Expected "<<missing.size()<<
+                  " calibration solutions, received "<<accessors.size());
+       for (size_t i = 0; i < missing.size(); ++i) {
+            addToCache(missing[i], accessors[i]);
+       }
+   }
+}
+
+/// @brief switch prefetch of the next solution on or off
+/// @param[in] flag true to obtain the next solution in the background
+void CachingCalSolutionConstSource::setPrefetch(bool flag)
+{
+   if (!flag) {
+       waitForPrefetch();
+   }
+   itsPrefetch = flag;
+}
+
+/// @brief number of solutions currently in the cache
+/// @details This method waits for the background job, so the prefetched solution is counted.
+/// It is mainly intended for tests.
+/// @return number of cache entries
+size_t CachingCalSolutionConstSource::nCached() const
+{
+   waitForPrefetch();
+   return itsCache.size();
+}
+
+/// @brief obtain solutions from the wrapped source
+/// @details This method is called for all solutions missing in the cache. The default 
+/// implementation calls roSolution of the wrapped source for each requested ID 
+/// in turn. 
+/// @param[in] ids vector with solution IDs
+/// @param[out] accessors vector with accessors in the same order as IDs (resized as required)
+void CachingCalSolutionConstSource::fetchSolutions(const std::vector<long> &ids, 
+                   std::vector<boost::shared_ptr<ICalSolutionConstAccessor> > &accessors) const
+{
+   accessors.resize(ids.size());
+   for (size_t i = 0; i < ids.size(); ++i) {
+        accessors[i] = itsSource->roSolution(ids[i]);
+   }
+}
+
+/// @brief current time
+/// @details This method is used to expire cached data, it can be overridden for testing.
+/// @return current time in seconds (the origin is not important)
+double CachingCalSolutionConstSource::currentTime() const
+{
+   const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+   const boost::posix_time::ptime origin(boost::gregorian::date(1970, 1, 1));
+   return double((now - origin).total_microseconds()) * 1e-6;
+}
+
+/// @brief recheck the version if it is older than time-to-live
+/// @details The cache is dropped if the most recent solution ID has changed.
+void CachingCalSolutionConstSource::checkVersion() const
+{
+   const double now = currentTime();
+   if (itsVersionValid && (now - itsVersionTime < itsTTL)) {
+       return;
+   }
+   waitForPrefetch();
+   const long version = itsSource->mostRecentSolution();
+   if (itsVersionValid && (version != itsVersion)) {
+       ASKAPLOG_DEBUG_STR(logger, "Most recent calibration solution changed from "<<itsVersion<<
+                          " to "<<version<<", dropping "<<itsCache.size()<<" cached solutions");
+       itsCache.clear();
+       itsLastValid = false;
+   }
+   itsVersion = version;
+   itsVersionTime = now;
+   itsVersionValid = true;
+}
+
+/// @brief find a cache entry which has not expired
+/// @details The entry found is moved to the front of the list, expired entries are removed.
+/// @param[in] id solution ID
+/// @return shared pointer to the accessor (empty if there is no valid entry)
+boost::shared_ptr<ICalSolutionConstAccessor> CachingCalSolutionConstSource::findCached(const long id) const
+{
+   const double now = currentTime();
+   for (std::list<CacheEntry>::iterator it = itsCache.begin(); it != itsCache.end(); ++it) {
+        if (it->itsID == id) {
+            if (now - it->itsTime >= itsTTL) {
+                itsCache.erase(it);
+                break;
+            }
+            itsCache.splice(itsCache.begin(), itsCache, it);
+            return itsCache.front().itsAccessor;
+        }
+   }
+   return boost::shared_ptr<ICalSolutionConstAccessor>();
+}
+
+/// @brief check whether a solution is in the cache
+/// @details Unlike findCached, this method leaves the cache unchanged.
+/// @param[in] id solution ID
+/// @return true if there is an entry which has not expired
+bool CachingCalSolutionConstSource::isCached(const long id) const
+{
+   const double now = currentTime();
+   for (std::list<CacheEntry>::const_iterator ci = itsCache.begin(); ci != itsCache.end(); ++ci) {
+        if (ci->itsID == id) {
+            return now - ci->itsTime < itsTTL;
+        }
+   }
+   return false;
+}
+
+/// @brief add an accessor to the cache
+/// @details The least recently used entries are removed if the cache is full.
+/// @param[in] id solution ID
+/// @param[in] acc accessor
+void CachingCalSolutionConstSource::addToCache(const long id, const boost::shared_ptr<ICalSolutionConstAccessor> &acc) const
+{
+   ASKAPDEBUGASSERT(acc);
+   for (std::list<CacheEntry>::iterator it = itsCache.begin(); it != itsCache.end(); ++it) {
+        if (it->itsID == id) {
+            itsCache.erase(it);
+            break;
+        }
+   }
+   CacheEntry entry;
+   entry.itsID = id;
+   entry.itsTime = currentTime();
+   entry.itsAccessor = acc;
+   itsCache.push_front(entry);
+   while (itsCache.size() > itsMaxEntries) {
+       itsCache.pop_back();
+   }
+}
+
+/// @brief start a background job obtaining the solution with the given ID
+/// @details Nothing is done if a job is already running.
+/// @param[in] id solution ID
+void CachingCalSolutionConstSource::startPrefetch(const long id) const
+{
+   if (itsPrefetchJob.valid()) {
+       return;
+   }
+   itsPrefetchID = id;
+   itsPrefetched.reset();
+   itsPrefetchJob = IOScheduler::instance().submit(IOScheduler::CRITICAL,
+                        boost::bind(&CachingCalSolutionConstSource::runPrefetch, this));
+}
+
+/// @brief wait for the background job to finish
+/// @details The solution obtained by the job (if any) is added to the cache.
+void CachingCalSolutionConstSource::waitForPrefetch() const
+{
+   if (itsPrefetchJob.valid()) {
+       itsPrefetchJob.wait();
+       itsPrefetchJob = IOScheduler::Future();
+       if (itsPrefetched) {
+           addToCache(itsPrefetchID, itsPrefetched);
+           itsPrefetched.reset();
+       }
+   }
+}
+
+/// @brief body of the background job
+void CachingCalSolutionConstSource::runPrefetch() const
+{
+   try {
+      const boost::shared_ptr<ICalSolutionConstAccessor> acc = itsSource->roSolution(itsPrefetchID);
+      ASKAPDEBUGASSERT(acc);
+      // touch the accessor, so lazily read solutions are in memory by the time they're needed
+      acc->jonesAndValidity(JonesIndex(0u, 0u), 0u);
+      itsPrefetched = acc;
+   }
+   catch (const std::exception &ex) {
+      // not fatal, the solution is requested again when it is needed
+      ASKAPLOG_DEBUG_STR(logger, "Unable to prefetch calibration solution "<<itsPrefetchID<<": "<<ex.what());
+      itsPrefetched.reset();
+   }
+}
+
+} // namespace accessors
+
+} // namespace askap
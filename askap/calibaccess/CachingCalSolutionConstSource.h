@@ -0,0 +1,235 @@
+/// @file
+/// @brief client-side cache of calibration solutions
+/// @details This class wraps another calibration solution source (e.g. the one 
+/// working with the calibration service) and keeps accessors obtained from it in a
+/// local cache keyed by solution ID. The cache entries expire after a given time and
+/// the whole cache is dropped once the most recent solution ID reported by the 
+/// wrapped source changes. The next solution interval can be obtained in advance 
+/// by a background job, so the code applying calibration is not blocked by remote calls.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_CACHING_CAL_SOLUTION_CONST_SOURCE_H
+#define ASKAP_ACCESSORS_CACHING_CAL_SOLUTION_CONST_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+#include <askap/dataaccess/IOScheduler.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// std includes
+#include <list>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief client-side cache of calibration solutions
+/// @details This class implements the ICalSolutionConstSource interface by delegating
+/// calls to another solution source and caching the results. Accessors are cached per
+/// solution ID for the given time-to-live (in seconds); the cache is bounded by the number
+/// of entries with the least recently used entries removed first. The most recent solution
+/// ID of the wrapped source serves as a version: it is checked at most once per time-to-live
+/// period and all cached data are dropped if it changes. If prefetch is enabled, reading the
+/// solution with a given ID starts a background job obtaining the next solution (provided it
+/// exists) as a latency-critical job of the I/O scheduler of the process (see IOScheduler).
+/// The wrapped source is never accessed by the background job and the caller at the
+/// same time: the caller waits for the job to finish before accessing the wrapped source.
+/// However, the wrapped source must not be accessed directly by other code while this class
+/// is in use.
+/// @ingroup calibaccess
+class CachingCalSolutionConstSource : virtual public ICalSolutionConstSource,
+                                      private boost::noncopyable {
+public:
+  /// @brief constructor
+  /// @param[in] src solution source to obtain solutions from
+  /// @param[in] ttl time-to-live of the cached information in seconds
+  /// @param[in] maxEntries maximum number of cached solutions
+  /// @param[in] prefetch if true, the next solution is obtained in advance by a background job
+  CachingCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, 
+                                double ttl = 60., size_t maxEntries = 16, bool prefetch = true);
+
+  /// @brief destructor, waits for the background job to finish
+  virtual ~CachingCalSolutionConstSource();
+
+  /// @brief obtain ID for the most recent solution
+  /// @details The cached value is returned unless it is older than time-to-live.
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const;
+  
+  /// @brief obtain solution ID for a given time
+  /// @details The wrapped source is not called if the most recent solution has 
+  /// already been found for an earlier time and the version has not changed since then,
+  /// or if the same time is requested again.
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const;
+  
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @details This method returns the cached accessor if it exists and has not expired,
+  /// and obtains it from the wrapped source otherwise. 
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+  /// @brief obtain a number of solutions at once
+  /// @details This method fills the cache with solutions for all given IDs, so subsequent 
+  /// roSolution calls are served locally. Solutions which are already cached are not requested
+  /// again. The actual request is done by the fetchSolutions method, which can be 
+  /// overridden for sources capable of serving a number of solutions in one call.
+  /// @param[in] ids vector with solution IDs
+  void fetch(const std::vector<long> &ids) const;
+
+  /// @brief switch prefetch of the next solution on or off
+  /// @param[in] flag true to obtain the next solution in the background
+  void setPrefetch(bool flag);
+
+  /// @brief number of solutions currently in the cache
+  /// @details This method waits for the background job, so the prefetched solution is counted.
+  /// It is mainly intended for tests.
+  /// @return number of cache entries
+  size_t nCached() const;
+
+  /// @brief shared pointer definition
+  typedef boost::shared_ptr<CachingCalSolutionConstSource> ShPtr;
+
+protected:
+  /// @brief obtain solutions from the wrapped source
+  /// @details This method is called for all solutions missing in the cache. The default 
+  /// implementation calls roSolution of the wrapped source for each requested ID 
+  /// in turn. 
+  /// @param[in] ids vector with solution IDs
+  /// @param[out] accessors vector with accessors in the same order as IDs (resized as required)
+  virtual void fetchSolutions(const std::vector<long> &ids, 
+                   std::vector<boost::shared_ptr<ICalSolutionConstAccessor> > &accessors) const;
+
+  /// @brief current time
+  /// @details This method is used to expire cached data, it can be overridden for testing.
+  /// @return current time in seconds (the origin is not important)
+  virtual double currentTime() const;
+
+  /// @brief access to the wrapped source
+  /// @return const reference to the shared pointer of the wrapped source
+  inline const boost::shared_ptr<ICalSolutionConstSource>& source() const { return itsSource;}
+
+private:
+  /// @brief cache entry
+  struct CacheEntry {
+     /// @brief solution ID
+     long itsID;
+     /// @brief time when the solution has been obtained
+     double itsTime;
+     /// @brief accessor
+     boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor;
+  };
+
+  /// @brief recheck the version if it is older than time-to-live
+  /// @details The cache is dropped if the most recent solution ID has changed.
+  void checkVersion() const;
+
+  /// @brief find a cache entry which has not expired
+  /// @details The entry found is moved to the front of the list, expired entries are removed.
+  /// @param[in] id solution ID
+  /// @return shared pointer to the accessor (empty if there is no valid entry)
+  boost::shared_ptr<ICalSolutionConstAccessor> findCached(const long id) const;
+
+  /// @brief check whether a solution is in the cache
+  /// @details Unlike findCached, this method leaves the cache unchanged.
+  /// @param[in] id solution ID
+  /// @return true if there is an entry which has not expired
+  bool isCached(const long id) const;
+
+  /// @brief add an accessor to the cache
+  /// @details The least recently used entries are removed if the cache is full.
+  /// @param[in] id solution ID
+  /// @param[in] acc accessor
+  void addToCache(const long id, const boost::shared_ptr<ICalSolutionConstAccessor> &acc) const;
+
+  /// @brief start a background job obtaining the solution with the given ID
+  /// @details Nothing is done if a job is already running.
+  /// @param[in] id solution ID
+  void startPrefetch(const long id) const;
+
+  /// @brief wait for the background job to finish
+  /// @details The solution obtained by the job (if any) is added to the cache.
+  void waitForPrefetch() const;
+
+  /// @brief body of the background job
+  void runPrefetch() const;
+
+  /// @brief wrapped solution source
+  const boost::shared_ptr<ICalSolutionConstSource> itsSource;
+
+  /// @brief time-to-live in seconds
+  const double itsTTL;
+
+  /// @brief maximum number of cached solutions
+  const size_t itsMaxEntries;
+
+  /// @brief true if the next solution is to be obtained in advance
+  bool itsPrefetch;
+
+  /// @brief cached accessors, the most recently used first
+  mutable std::list<CacheEntry> itsCache;
+
+  /// @brief most recent solution ID reported by the wrapped source
+  mutable long itsVersion;
+
+  /// @brief time when the version has been checked
+  mutable double itsVersionTime;
+
+  /// @brief true if the version has been obtained
+  mutable bool itsVersionValid;
+
+  /// @brief time of the last solutionID request
+  mutable double itsLastTime;
+
+  /// @brief result of the last solutionID request
+  mutable long itsLastID;
+
+  /// @brief true if itsLastTime and itsLastID are valid
+  mutable bool itsLastValid;
+
+  /// @brief future of the background job, invalid if no job is running
+  mutable IOScheduler::Future itsPrefetchJob;
+
+  /// @brief ID of the solution obtained by the background job
+  mutable long itsPrefetchID;
+
+  /// @brief accessor obtained by the background job (empty if the job failed)
+  mutable boost::shared_ptr<ICalSolutionConstAccessor> itsPrefetched;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CACHING_CAL_SOLUTION_CONST_SOURCE_H
@@ -37,10 +37,29 @@
 #include <askap/calibaccess/ParsetCalSolutionConstSource.h>
 #include <askap/calibaccess/TableCalSolutionSource.h>
 #include <askap/calibaccess/TableCalSolutionConstSource.h>
+#include <askap/calibaccess/TableCalSolutionFiller.h>
+#include <askap/calibaccess/BinaryCalSolutionSource.h>
+#include <askap/calibaccess/BinaryCalSolutionConstSource.h>
 #include <askap/calibaccess/ServiceCalSolutionSourceStub.h>
+#include <askap/calibaccess/CachingCalSolutionConstSource.h>
+#include <askap/calibaccess/SharedCalSolutionConstSource.h>
+#include <askap/calibaccess/CalibrationStatistics.h>
+#include <askap/dataaccess/AccessTracer.h>
+#include <askap/dataaccess/HardwareCounters.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <askap/dataaccess/TableLocking.h>
 
 #include <askap/askap/AskapError.h>
 
+// boost includes
+#include <boost/weak_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+// std includes
+#include <map>
+#include <string>
+
 // logging stuff
 #include <askap_accessors.h>
 #include <askap/askap/AskapLogging.h>
@@ -50,6 +69,28 @@ namespace askap {
 
 namespace accessors {
 
+namespace {
+
+/// @brief mutex protecting the registry of shared solution sources
+/// @return reference to the mutex
+boost::mutex& sharedSourceMutex()
+{
+  static boost::mutex mutex;
+  return mutex;
+}
+
+/// @brief registry of shared solution sources
+/// @details Only weak references are held, so sources are destroyed when no longer used
+/// (and before static objects like MemoryGovernor they may have registered with).
+/// @return reference to the map from the key to the source
+std::map<std::string, boost::weak_ptr<ICalSolutionConstSource> >& sharedSources()
+{
+  static std::map<std::string, boost::weak_ptr<ICalSolutionConstSource> > sources;
+  return sources;
+}
+
+} // anonymous namespace
+
 
 /// @brief Build an appropriate "calibration source" class
 /// @details This is a factory method generating a shared pointer to the calibration
@@ -64,6 +105,66 @@ boost::shared_ptr<ICalSolutionSource> CalibAccessFactory::rwCalSolutionSource(co
   return css;
 }
 
+/// @brief Build an appropriate "calibration source" class
+/// @details This is a factory method generating a shared pointer to the calibration
+/// solution source according to the parset file which allows read operation only.
+/// If calibaccess.shared is true, the source is shared by all components of the process
+/// which request the same solution source (see sharedCalSolutionSource).
+/// @param[in] parset parameters containing description of the class to be constructed
+/// @return shared pointer to the calibration solution source object
+boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::roCalSolutionSource(const LOFAR::ParameterSet &parset)
+{
+  if (parset.getBool("calibaccess.shared", false)) {
+      return sharedCalSolutionSource(parset);
+  }
+  return calSolutionSource(parset, true);
+}
+
+/// @brief obtain a read-only "calibration source" shared by the process
+/// @details The sources are kept in a process-wide registry keyed by the type and the name
+/// of the table or file. A new source is created (and wrapped into SharedCalSolutionConstSource
+/// to make it thread-safe) if there is no source for this key alive. The registry holds weak
+/// references only, so the source is released when the last component stops using it.
+/// @param[in] parset parameters containing description of the class to be constructed
+/// @return shared pointer to the calibration solution source object
+boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::sharedCalSolutionSource(const LOFAR::ParameterSet &parset)
+{
+  const std::string calAccType = parset.getString("calibaccess","parset");
+  std::string key = calAccType + ":";
+  if (calAccType == "parset") {
+      key += parset.getString("calibaccess.parset", "result.dat");
+  } else if (calAccType == "table") {
+      key += parset.getString("calibaccess.table", "calibdata.tab");
+  } else if (calAccType == "binary") {
+      key += parset.getString("calibaccess.binary", "calibdata.bin");
+  }
+  // the service has no name, there is one per process
+
+  boost::lock_guard<boost::mutex> lock(sharedSourceMutex());
+  std::map<std::string, boost::weak_ptr<ICalSolutionConstSource> > &sources = sharedSources();
+  // forget sources which are no longer in use
+  for (std::map<std::string, boost::weak_ptr<ICalSolutionConstSource> >::iterator it = sources.begin();
+       it != sources.end();) {
+       if (it->second.expired()) {
+           sources.erase(it++);
+       } else {
+           ++it;
+       }
+  }
+  const std::map<std::string, boost::weak_ptr<ICalSolutionConstSource> >::const_iterator ci = sources.find(key);
+  if (ci != sources.end()) {
+      const boost::shared_ptr<ICalSolutionConstSource> result = ci->second.lock();
+      if (result) {
+          ASKAPLOG_DEBUG_STR(logger, "Reusing calibration solution source "<<key<<" shared by the process");
+          return result;
+      }
+  }
+  const boost::shared_ptr<ICalSolutionConstSource> result(new SharedCalSolutionConstSource(calSolutionSource(parset, true)));
+  ASKAPLOG_INFO_STR(logger, "Calibration solution source "<<key<<" will be shared by the process");
+  sources[key] = result;
+  return result;
+}
+
 /// @brief Build an appropriate "calibration source" class
 /// @details This is a factory method generating a shared pointer to the calibration
 /// solution source according to the parset file. The code for read-only and
@@ -74,9 +175,13 @@ boost::shared_ptr<ICalSolutionSource> CalibAccessFactory::rwCalSolutionSource(co
 /// @return shared pointer to the calibration solution source object
 boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::calSolutionSource(const LOFAR::ParameterSet &parset, bool readonly)
 {
+   AccessTracer::instance().configure(parset, "calibaccess.trace");
+   HardwareCounters::instance().configure(parset, "calibaccess.hwcounters");
+   MemoryGovernor::instance().configure(parset, "calibaccess.memorybudget");
+   CalibrationStatistics::instance().configure(parset, "calibaccess.statistics");
    const std::string calAccType = parset.getString("calibaccess","parset");
-   ASKAPCHECK((calAccType == "parset") || (calAccType == "table") || (calAccType == "service"),
-       "Only parset-based, table-based and service-based implementations are supported by the calibration access factory at the moment; you request: "<<calAccType);
+   ASKAPCHECK((calAccType == "parset") || (calAccType == "table") || (calAccType == "binary") || (calAccType == "service"),
+       "Only parset-based, table-based, binary file-based and service-based implementations are supported by the calibration access factory at the moment; you request: "<<calAccType);
    boost::shared_ptr<ICalSolutionConstSource> result;
    if (calAccType == "parset") {
        const std::string fname = parset.getString("calibaccess.parset", "result.dat");
@@ -90,8 +195,14 @@ boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::calSolutionSource
    } else if (calAccType == "table") {
        const std::string fname = parset.getString("calibaccess.table", "calibdata.tab");
        ASKAPLOG_INFO_STR(logger, "Using implementation of the calibration solution accessor working with casa table "<<fname);
+       // e.g. none for read-only jobs, user for a writer keeping the table locked
+       const std::string locking = parset.getString("calibaccess.table.locking", "default");
+       const casacore::TableLock lock = TableLocking::lockOptions(locking);
+       if (locking != "default") {
+           ASKAPLOG_INFO_STR(logger, "Table "<<fname<<" will be opened with "<<locking<<" locking");
+       }
        if (readonly) {
-           result.reset(new TableCalSolutionConstSource(fname));
+           result.reset(new TableCalSolutionConstSource(fname, lock));
        } else {
            const casacore::uInt maxAnt = parset.getUint32("calibaccess.table.maxant",36);
            const casacore::uInt maxBeam = parset.getUint32("calibaccess.table.maxbeam",30);
@@ -108,11 +219,65 @@ boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::calSolutionSource
                ASKAPLOG_INFO_STR(logger, "A new table "<<fname<<" is to be created, any old file with the same name is going to be removed");
                TableCalSolutionSource::removeOldTable(fname);
            }
-           result.reset(new TableCalSolutionSource(fname,maxAnt,maxBeam,maxChan));
+           const boost::shared_ptr<TableCalSolutionSource> tcss(new TableCalSolutionSource(fname,maxAnt,maxBeam,maxChan,lock));
+           // tiling of the bandpass columns in channels x antennas x beams, 0 means the whole axis
+           const casacore::uInt tileChan = parset.getUint32("calibaccess.table.tile.nchan", 
+                                        TableCalSolutionFiller::theirDefaultTileChannels);
+           const casacore::uInt tileAnt = parset.getUint32("calibaccess.table.tile.nant", 
+                                        TableCalSolutionFiller::theirDefaultTileAntennas);
+           const casacore::uInt tileBeam = parset.getUint32("calibaccess.table.tile.nbeam", 
+                                        TableCalSolutionFiller::theirDefaultTileBeams);
+           tcss->setBandpassTiling(tileChan, tileAnt, tileBeam);
+           if (parset.getBool("calibaccess.table.differential", false)) {
+               const casacore::uInt keyframeInterval = parset.getUint32("calibaccess.table.keyframeinterval",
+                                        TableCalSolutionFiller::theirDefaultKeyframeInterval);
+               ASKAPCHECK(keyframeInterval > 0, "calibaccess.table.keyframeinterval should be positive");
+               ASKAPLOG_INFO_STR(logger, "Only changed elements of calibration solutions will be written to "<<fname<<
+                                 ", full solutions are stored every "<<keyframeInterval<<" rows");
+               tcss->setDifferential(keyframeInterval);
+           }
+           if (parset.getBool("calibaccess.table.writebehind", false)) {
+               ASKAPLOG_INFO_STR(logger, "Calibration solutions will be written to "<<fname<<" in a background thread");
+               tcss->setWriteBehind(true);
+           }
+           result = tcss;
+       }
+   } else if (calAccType == "binary") {
+       const std::string fname = parset.getString("calibaccess.binary", "calibdata.bin");
+       ASKAPLOG_INFO_STR(logger, "Using implementation of the calibration solution accessor working with memory-mapped file "<<fname);
+       if (readonly) {
+           result.reset(new BinaryCalSolutionConstSource(fname));
+       } else {
+           const casacore::uInt maxAnt = parset.getUint32("calibaccess.binary.maxant",36);
+           const casacore::uInt maxBeam = parset.getUint32("calibaccess.binary.maxbeam",30);
+           const casacore::uInt maxChan = parset.getUint32("calibaccess.binary.maxchan",16416);
+           const casacore::uInt maxSolutions = parset.getUint32("calibaccess.binary.maxsolutions",1024);
+           const bool reuse = parset.getBool("calibaccess.binary.reuse", false);
+           if (reuse) {
+               if (BinaryCalSolutionConstSource::fileExists(fname)) {
+                   ASKAPLOG_INFO_STR(logger, "New calibration solutions will be appended to file "<<fname);
+               } else {
+                   ASKAPLOG_INFO_STR(logger, "Unable to open file "<<fname<<
+                                     ", a new file will be created to store calibration solutions");
+               }
+           } else {
+               ASKAPLOG_INFO_STR(logger, "A new file "<<fname<<" is to be created, any old file with the same name is going to be removed");
+               BinaryCalSolutionSource::removeOldFile(fname);
+           }
+           result.reset(new BinaryCalSolutionSource(fname, maxAnt, maxBeam, maxChan, maxSolutions));
        }
    } else if (calAccType == "service") {
       ASKAPLOG_INFO_STR(logger, "Using implementation of the calibration solution accessor working with the calibration service" );
       result.reset(new ServiceCalSolutionSourceStub(parset));
+      if (readonly && parset.getBool("calibaccess.service.cache", true)) {
+          // solutions are cached on the client side to avoid a remote call for every access
+          const double ttl = parset.getDouble("calibaccess.service.cache.ttl", 60.);
+          const casacore::uInt maxEntries = parset.getUint32("calibaccess.service.cache.size", 16);
+          const bool prefetch = parset.getBool("calibaccess.service.prefetch", true);
+          ASKAPLOG_INFO_STR(logger, "Calibration solutions will be cached for "<<ttl<<" seconds, up to "<<
+                            maxEntries<<" solutions"<<(prefetch ? ", the next solution is prefetched" : ""));
+          result.reset(new CachingCalSolutionConstSource(result, ttl, maxEntries, prefetch));
+      }
    }
 
    ASKAPDEBUGASSERT(result);
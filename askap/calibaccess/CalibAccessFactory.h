@@ -71,11 +71,10 @@ struct CalibAccessFactory {
    /// @details This is a factory method generating a shared pointer to the calibration
    /// solution source according to the parset file which allows read operation only.
    /// @param[in] parset parameters containing description of the class to be constructed
+   /// If calibaccess.shared is true, the source is shared by all components of the process
+   /// which request the same solution source (see sharedCalSolutionSource).
    /// @return shared pointer to the calibration solution source object
-   /// @note For now we have the same implementation for write and for read and therefore implement
-   /// read-only method via read-write one.
-   inline static boost::shared_ptr<ICalSolutionConstSource> roCalSolutionSource(const LOFAR::ParameterSet &parset)
-      { return calSolutionSource(parset,true); }
+   static boost::shared_ptr<ICalSolutionConstSource> roCalSolutionSource(const LOFAR::ParameterSet &parset);
       
 protected:
    /// @brief Build an appropriate "calibration source" class
@@ -87,6 +86,15 @@ protected:
    /// @param[in] readonly true if a read-only solution source is required
    /// @return shared pointer to the calibration solution source object
    static boost::shared_ptr<ICalSolutionConstSource> calSolutionSource(const LOFAR::ParameterSet &parset, bool readonly);
+
+   /// @brief obtain a read-only "calibration source" shared by the process
+   /// @details The sources are kept in a process-wide registry keyed by the type and the name
+   /// of the table or file. A new source is created (and wrapped into SharedCalSolutionConstSource
+   /// to make it thread-safe) if there is no source for this key alive. The registry holds weak
+   /// references only, so the source is released when the last component stops using it.
+   /// @param[in] parset parameters containing description of the class to be constructed
+   /// @return shared pointer to the calibration solution source object
+   static boost::shared_ptr<ICalSolutionConstSource> sharedCalSolutionSource(const LOFAR::ParameterSet &parset);
    
 };
 
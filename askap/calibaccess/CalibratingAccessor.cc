@@ -0,0 +1,418 @@
+/// @file
+/// @brief accessor adapter applying calibration solutions
+/// @details This adapter applies (or removes) the effect of gains, leakages and bandpasses
+/// given by some calibration solution source to the visibilities and noise of the whole chunk.
+/// Jones matrices are obtained via the bulk ICalSolutionConstAccessor::jonesBlock method once
+/// per solution and reused for all rows, so the per-sample work is just two 2x2 complex matrix
+/// products.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/calibaccess/CalibratingAccessor.h>
+#include <askap/calibaccess/InverseJonesCalSolutionConstAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicMath/Math.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief obtain a pointer to contiguous cube storage
+/// @details The accessor cubes are normally contiguous, the copy is only made otherwise
+/// @param[in] cube cube to access
+/// @param[out] buffer cube holding a contiguous copy, if required
+/// @return pointer to the first element
+template<typename T>
+const T* contiguousData(const casacore::Cube<T> &cube, casacore::Cube<T> &buffer)
+{
+  if (cube.contiguousStorage()) {
+      return cube.data();
+  }
+  buffer = cube.copy();
+  return buffer.data();
+}
+
+/// @brief 2x2 complex kernel computing A V B^H
+/// @details Matrices are given by 4 elements in the order 00, 01, 10, 11 (which is
+/// also the order of polarisation products XX, XY, YX, YY). The code is written as
+/// straight-line arithmetic on small blocks, so the compiler can keep everything in 
+/// registers and vectorise it.
+/// @param[in] a first matrix
+/// @param[in] b second matrix
+/// @param[in] v visibility matrix
+/// @param[out] out result
+inline void applyJones(const casacore::Complex *a, const casacore::Complex *b,
+                       const casacore::Complex *v, casacore::Complex *out)
+{
+  const casacore::Complex t00 = a[0] * v[0] + a[1] * v[2];
+  const casacore::Complex t01 = a[0] * v[1] + a[1] * v[3];
+  const casacore::Complex t10 = a[2] * v[0] + a[3] * v[2];
+  const casacore::Complex t11 = a[2] * v[1] + a[3] * v[3];
+  const casacore::Complex cb0 = conj(b[0]);
+  const casacore::Complex cb1 = conj(b[1]);
+  const casacore::Complex cb2 = conj(b[2]);
+  const casacore::Complex cb3 = conj(b[3]);
+  out[0] = t00 * cb0 + t01 * cb1;
+  out[1] = t00 * cb2 + t01 * cb3;
+  out[2] = t10 * cb0 + t11 * cb1;
+  out[3] = t10 * cb2 + t11 * cb3;
+}
+
+/// @brief propagate noise through A V B^H
+/// @details Real and imaginary parts of all input samples are assumed to be independent.
+/// Matrices are given in the same order as for applyJones.
+/// @param[in] a first matrix
+/// @param[in] b second matrix
+/// @param[in] sigma complex noise of the visibility matrix
+/// @param[out] out complex noise of the result
+inline void propagateNoise(const casacore::Complex *a, const casacore::Complex *b,
+                           const casacore::Complex *sigma, casacore::Complex *out)
+{
+  for (casacore::uInt i = 0; i < 2; ++i) {
+       for (casacore::uInt j = 0; j < 2; ++j) {
+            float varRe = 0., varIm = 0.;
+            for (casacore::uInt k = 0; k < 2; ++k) {
+                 for (casacore::uInt l = 0; l < 2; ++l) {
+                      const casacore::Complex coeff = a[2 * i + k] * conj(b[2 * j + l]);
+                      const float re2 = casacore::square(coeff.real());
+                      const float im2 = casacore::square(coeff.imag());
+                      const float sigmaRe2 = casacore::square(sigma[2 * k + l].real());
+                      const float sigmaIm2 = casacore::square(sigma[2 * k + l].imag());
+                      varRe += re2 * sigmaRe2 + im2 * sigmaIm2;
+                      varIm += re2 * sigmaIm2 + im2 * sigmaRe2;
+                 }
+            }
+            out[2 * i + j] = casacore::Complex(std::sqrt(varRe), std::sqrt(varIm));
+       }
+  }
+}
+
+} // anonymous namespace
+
+/// @brief construct the adapter
+/// @param[in] src calibration solution source
+/// @param[in] correct if true, calibration is applied (J1^{-1} V J2^{-H}), otherwise
+/// visibilities are corrupted (J1 V J2^H)
+CalibratingAccessor::CalibratingAccessor(const boost::shared_ptr<ICalSolutionConstSource> &src, bool correct) :
+      itsSource(src), itsCorrect(correct), itsNThreads(1u), itsSolutionID(-1)
+{
+  ASKAPCHECK(itsSource, "An attempt to create CalibratingAccessor with an empty solution source");
+}
+
+/// @brief set the number of threads used to process a chunk
+/// @details Rows are split evenly between the threads. A single thread (the caller's)
+/// is used by default.
+/// @param[in] nThreads number of threads (should be positive)
+void CalibratingAccessor::setNumberOfThreads(casacore::uInt nThreads)
+{
+  ASKAPCHECK(nThreads > 0, "Number of threads should be positive");
+  itsNThreads = nThreads;
+}
+
+/// @brief check that the polarisation products can be calibrated
+/// @details An exception is thrown if the products are not supported
+/// @param[in] stokes polarisation products of the original accessor
+void CalibratingAccessor::checkPolarisations(const casacore::Vector<casacore::Stokes::StokesTypes> &stokes)
+{
+  const bool linear = (stokes.nelements() == 4) && (stokes[0] == casacore::Stokes::XX) && 
+         (stokes[1] == casacore::Stokes::XY) && (stokes[2] == casacore::Stokes::YX) && 
+         (stokes[3] == casacore::Stokes::YY);
+  const bool circular = (stokes.nelements() == 4) && (stokes[0] == casacore::Stokes::RR) && 
+         (stokes[1] == casacore::Stokes::RL) && (stokes[2] == casacore::Stokes::LR) && 
+         (stokes[3] == casacore::Stokes::LL);
+  if (!linear && !circular) {
+      ASKAPTHROW(DataAccessError, "CalibratingAccessor requires all 4 polarisation products in the feed frame, "
+                 "e.g. XX,XY,YX,YY; you have "<<stokes.nelements()<<" products");
+  }
+}
+
+/// @brief update Jones matrices and drop cached products if the accessor changed
+void CalibratingAccessor::checkAccessor() const
+{
+  if (itsCachedMonitor == changeMonitor()) {
+      return;
+  }
+  itsVisibility.invalidate();
+  itsNoise.invalidate();
+  itsFlag.invalidate();
+  checkPolarisations(getROAccessor().stokes());
+  updateJones();
+  // only remember the accessor if the update was successful
+  itsCachedMonitor = changeMonitor();
+}
+
+/// @brief obtain Jones matrices for the current chunk
+/// @details The matrices are only reread if the solution ID or the chunk shape changes.
+/// The per-row offsets into the Jones array are updated every time.
+void CalibratingAccessor::updateJones() const
+{
+  const IConstDataAccessor &acc = getROAccessor();
+  const casacore::Vector<casacore::uInt> &ant1 = acc.antenna1();
+  const casacore::Vector<casacore::uInt> &ant2 = acc.antenna2();
+  const casacore::Vector<casacore::uInt> &beam1 = acc.feed1();
+  const casacore::Vector<casacore::uInt> &beam2 = acc.feed2();
+  const casacore::uInt nRow = acc.nRow();
+  ASKAPDEBUGASSERT((ant1.nelements() == nRow) && (ant2.nelements() == nRow));
+  ASKAPDEBUGASSERT((beam1.nelements() == nRow) && (beam2.nelements() == nRow));
+  casacore::uInt nAnt = 0, nBeam = 0;
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       nAnt = std::max(nAnt, std::max(ant1[row], ant2[row]) + 1);
+       nBeam = std::max(nBeam, std::max(beam1[row], beam2[row]) + 1);
+  }
+  const casacore::uInt nChan = acc.nChannel();
+  const long id = itsSource->solutionID(acc.time());
+  const casacore::IPosition requiredShape(4, 4, nChan, nAnt, nBeam);
+  if (!itsSolution || (id != itsSolutionID) || (itsJones.shape() != requiredShape)) {
+      itsSolution = itsSource->roSolution(id);
+      ASKAPCHECK(itsSolution, "Solution source returned an empty accessor for solution ID="<<id);
+      itsSolutionID = id;
+      // inverse matrices cached by the solution are shared with other users of the same solution
+      const InverseJonesCalSolutionConstAccessor *inverseSolution = itsCorrect ? 
+            dynamic_cast<const InverseJonesCalSolutionConstAccessor*>(itsSolution.get()) : NULL;
+      if (inverseSolution != NULL) {
+          inverseSolution->inverseJonesBlock(nAnt, nBeam, 0, nChan, itsJones, itsJonesValidity);
+      } else {
+          itsSolution->jonesBlock(nAnt, nBeam, 0, nChan, itsJones, itsJonesValidity);
+      }
+      ASKAPDEBUGASSERT(itsJones.contiguousStorage() && itsJonesValidity.contiguousStorage());
+      if (itsCorrect && (inverseSolution == NULL)) {
+          // invert matrices once per antenna rather than for every baseline
+          InverseJonesCalSolutionConstAccessor::invertJones(itsJones.data(), itsJonesValidity.data(), 
+                                                            itsJonesValidity.nelements());
+      }
+  }
+  itsIndex1.resize(nRow);
+  itsIndex2.resize(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       itsIndex1[row] = ant1[row] + nAnt * beam1[row];
+       itsIndex2[row] = ant2[row] + nAnt * beam2[row];
+  }
+}
+
+/// @brief run a job over all rows of the chunk, in parallel if configured
+/// @param[in] job function processing a range of rows (the first row and one past the last row)
+void CalibratingAccessor::runForRows(const boost::function<void(casacore::uInt, casacore::uInt)> &job) const
+{
+  const casacore::uInt nRow = itsIndex1.nelements();
+  const casacore::uInt nThreads = std::min(itsNThreads, nRow);
+  if (nThreads <= 1) {
+      job(0, nRow);
+      return;
+  }
+  const casacore::uInt step = (nRow + nThreads - 1) / nThreads;
+  boost::thread_group threads;
+  for (casacore::uInt start = step; start < nRow; start += step) {
+       threads.create_thread(boost::bind(job, start, std::min(start + step, nRow)));
+  }
+  // the first portion is done by this thread
+  job(0, step);
+  threads.join_all();
+}
+
+/// @brief calibrated visibilities
+/// @return a reference to nRow x nChannel x nPol cube
+const casacore::Cube<casacore::Complex>& CalibratingAccessor::visibility() const
+{
+  checkAccessor();
+  return itsVisibility.value(*this, &CalibratingAccessor::fillVisibility);
+}
+
+/// @brief read-write access to visibilities is not supported
+/// @return never returns, DataAccessLogicError is thrown
+casacore::Cube<casacore::Complex>& CalibratingAccessor::rwVisibility()
+{
+  ASKAPTHROW(DataAccessLogicError, "CalibratingAccessor doesn't support read-write access to visibilities");
+}
+
+/// @brief calibrated noise
+/// @return a reference to nRow x nChannel x nPol cube with complex noise estimates
+const casacore::Cube<casacore::Complex>& CalibratingAccessor::noise() const
+{
+  checkAccessor();
+  return itsNoise.value(*this, &CalibratingAccessor::fillNoise);
+}
+
+/// @brief flags
+/// @details Samples with undefined calibration are flagged in addition to flags
+/// of the original accessor.
+/// @return a reference to nRow x nChannel x nPol cube with flags
+const casacore::Cube<casacore::Bool>& CalibratingAccessor::flag() const
+{
+  checkAccessor();
+  return itsFlag.value(*this, &CalibratingAccessor::fillFlag);
+}
+
+/// @brief fill the buffer with calibrated visibilities
+/// @param[in] vis cube to fill
+void CalibratingAccessor::fillVisibility(casacore::Cube<casacore::Complex> &vis) const
+{
+  const casacore::Cube<casacore::Complex> &inVis = getROAccessor().visibility();
+  ASKAPDEBUGASSERT(inVis.nrow() == itsIndex1.nelements());
+  vis.resize(inVis.shape());
+  casacore::Cube<casacore::Complex> buffer;
+  runForRows(boost::bind(&CalibratingAccessor::visibilityKernel, this, contiguousData(inVis, buffer),
+                         vis.data(), _1, _2));
+}
+
+/// @brief fill the buffer with calibrated noise
+/// @param[in] noise cube to fill
+void CalibratingAccessor::fillNoise(casacore::Cube<casacore::Complex> &noise) const
+{
+  const casacore::Cube<casacore::Complex> &inNoise = getROAccessor().noise();
+  ASKAPDEBUGASSERT(inNoise.nrow() == itsIndex1.nelements());
+  noise.resize(inNoise.shape());
+  casacore::Cube<casacore::Complex> buffer;
+  runForRows(boost::bind(&CalibratingAccessor::noiseKernel, this, contiguousData(inNoise, buffer),
+                         noise.data(), _1, _2));
+}
+
+/// @brief fill the buffer with flags
+/// @param[in] flag cube to fill
+void CalibratingAccessor::fillFlag(casacore::Cube<casacore::Bool> &flag) const
+{
+  const casacore::Cube<casacore::Bool> &inFlag = getROAccessor().flag();
+  ASKAPDEBUGASSERT(inFlag.nrow() == itsIndex1.nelements());
+  flag.resize(inFlag.shape());
+  casacore::Cube<casacore::Bool> buffer;
+  runForRows(boost::bind(&CalibratingAccessor::flagKernel, this, contiguousData(inFlag, buffer),
+                         flag.data(), _1, _2));
+}
+
+/// @brief apply Jones matrices to visibilities for a range of rows
+/// @param[in] in pointer to the input visibility cube
+/// @param[in] out pointer to the output visibility cube
+/// @param[in] startRow first row to process
+/// @param[in] endRow one past the last row to process
+void CalibratingAccessor::visibilityKernel(const casacore::Complex *in, casacore::Complex *out, 
+                        casacore::uInt startRow, casacore::uInt endRow) const
+{
+  const size_t nRow = itsIndex1.nelements();
+  const size_t nChan = itsJonesValidity.nrow();
+  // distance between polarisation products of the same sample
+  const size_t stride = nRow * nChan;
+  const casacore::Complex *jones = itsJones.data();
+  const casacore::Bool *validity = itsJonesValidity.data();
+  casacore::Complex v[4], result[4];
+  for (casacore::uInt row = startRow; row < endRow; ++row) {
+       const casacore::Complex *j1 = jones + 4 * nChan * itsIndex1[row];
+       const casacore::Complex *j2 = jones + 4 * nChan * itsIndex2[row];
+       const casacore::Bool *valid1 = validity + nChan * itsIndex1[row];
+       const casacore::Bool *valid2 = validity + nChan * itsIndex2[row];
+       for (size_t chan = 0; chan < nChan; ++chan, j1 += 4, j2 += 4) {
+            const size_t offset = row + nRow * chan;
+            for (size_t pol = 0; pol < 4; ++pol) {
+                 v[pol] = in[offset + pol * stride];
+            }
+            if (valid1[chan] && valid2[chan]) {
+                applyJones(j1, j2, v, result);
+            } else {
+                std::copy(v, v + 4, result);
+            }
+            for (size_t pol = 0; pol < 4; ++pol) {
+                 out[offset + pol * stride] = result[pol];
+            }
+       }
+  }
+}
+
+/// @brief propagate noise for a range of rows
+/// @param[in] in pointer to the input noise cube
+/// @param[in] out pointer to the output noise cube
+/// @param[in] startRow first row to process
+/// @param[in] endRow one past the last row to process
+void CalibratingAccessor::noiseKernel(const casacore::Complex *in, casacore::Complex *out, 
+                   casacore::uInt startRow, casacore::uInt endRow) const
+{
+  const size_t nRow = itsIndex1.nelements();
+  const size_t nChan = itsJonesValidity.nrow();
+  const size_t stride = nRow * nChan;
+  const casacore::Complex *jones = itsJones.data();
+  const casacore::Bool *validity = itsJonesValidity.data();
+  casacore::Complex sigma[4], result[4];
+  for (casacore::uInt row = startRow; row < endRow; ++row) {
+       const casacore::Complex *j1 = jones + 4 * nChan * itsIndex1[row];
+       const casacore::Complex *j2 = jones + 4 * nChan * itsIndex2[row];
+       const casacore::Bool *valid1 = validity + nChan * itsIndex1[row];
+       const casacore::Bool *valid2 = validity + nChan * itsIndex2[row];
+       for (size_t chan = 0; chan < nChan; ++chan, j1 += 4, j2 += 4) {
+            const size_t offset = row + nRow * chan;
+            for (size_t pol = 0; pol < 4; ++pol) {
+                 sigma[pol] = in[offset + pol * stride];
+            }
+            if (valid1[chan] && valid2[chan]) {
+                propagateNoise(j1, j2, sigma, result);
+            } else {
+                std::copy(sigma, sigma + 4, result);
+            }
+            for (size_t pol = 0; pol < 4; ++pol) {
+                 out[offset + pol * stride] = result[pol];
+            }
+       }
+  }
+}
+
+/// @brief update flags for a range of rows
+/// @param[in] in pointer to the input flag cube
+/// @param[in] out pointer to the output flag cube
+/// @param[in] startRow first row to process
+/// @param[in] endRow one past the last row to process
+void CalibratingAccessor::flagKernel(const casacore::Bool *in, casacore::Bool *out, 
+                  casacore::uInt startRow, casacore::uInt endRow) const
+{
+  const size_t nRow = itsIndex1.nelements();
+  const size_t nChan = itsJonesValidity.nrow();
+  const size_t stride = nRow * nChan;
+  const casacore::Bool *validity = itsJonesValidity.data();
+  for (casacore::uInt row = startRow; row < endRow; ++row) {
+       const casacore::Bool *valid1 = validity + nChan * itsIndex1[row];
+       const casacore::Bool *valid2 = validity + nChan * itsIndex2[row];
+       for (size_t chan = 0; chan < nChan; ++chan) {
+            const size_t offset = row + nRow * chan;
+            // a sample is flagged if any of the constituents has a flag
+            const bool calibrated = valid1[chan] && valid2[chan];
+            for (size_t pol = 0; pol < 4; ++pol) {
+                 out[offset + pol * stride] = in[offset + pol * stride] || !calibrated;
+            }
+       }
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
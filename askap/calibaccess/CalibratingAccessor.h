@@ -0,0 +1,205 @@
+/// @file
+/// @brief accessor adapter applying calibration solutions
+/// @details This adapter applies (or removes) the effect of gains, leakages and bandpasses
+/// given by some calibration solution source to the visibilities and noise of the whole chunk.
+/// Jones matrices are obtained via the bulk ICalSolutionConstAccessor::jonesBlock method once
+/// per solution and reused for all rows, so the per-sample work is just two 2x2 complex matrix
+/// products.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_CALIBRATING_ACCESSOR_H
+#define ASKAP_ACCESSORS_CALIBRATING_ACCESSOR_H
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/measures/Measures/Stokes.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+
+// own includes
+#include <askap/dataaccess/DataAccessorAdapter.h>
+#include <askap/dataaccess/CachedAccessorField.h>
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+#include <utils/ChangeMonitor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief accessor adapter applying calibration solutions
+/// @details The solution valid at the time of the chunk is obtained from the solution source
+/// given in the constructor; Jones matrices are only reread if the solution ID changes.
+/// In the correction mode (default) the visibility of the baseline between antennas 1 and 2
+/// is replaced by J1^{-1} V J2^{-H} (i.e. the effect of the instrument is removed), otherwise the
+/// visibility is corrupted as J1 V J2^H (e.g. for simulations). Inverse matrices are computed
+/// once per antenna, beam and channel rather than for every baseline. Samples with invalid 
+/// (or singular, in the correction mode) Jones matrices are flagged and left unchanged. 
+/// The beam index for the first and second antenna is taken from feed1 and feed2, respectively,
+/// and the accessor channel number is used as the solution channel number (use 
+/// ChanAdapterCalSolutionConstSource if an offset is required). Noise is propagated assuming
+/// independent real and imaginary parts. All four polarisation products in the 
+/// feed frame (XX,XY,YX,YY or RR,RL,LR,LL) are required.
+/// Rows are optionally processed in parallel (see setNumberOfThreads). The adapter is read-only,
+/// rwVisibility throws an exception.
+/// @ingroup calibaccess
+class CalibratingAccessor : public DataAccessorAdapter {
+public:
+  /// @brief construct the adapter
+  /// @param[in] src calibration solution source
+  /// @param[in] correct if true, calibration is applied (J1^{-1} V J2^{-H}), otherwise
+  /// visibilities are corrupted (J1 V J2^H)
+  explicit CalibratingAccessor(const boost::shared_ptr<ICalSolutionConstSource> &src, bool correct = true);
+
+  /// @brief set the number of threads used to process a chunk
+  /// @details Rows are split evenly between the threads. A single thread (the caller's)
+  /// is used by default.
+  /// @param[in] nThreads number of threads (should be positive)
+  void setNumberOfThreads(casacore::uInt nThreads);
+
+  /// @brief calibrated visibilities
+  /// @return a reference to nRow x nChannel x nPol cube
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// @brief read-write access to visibilities is not supported
+  /// @return never returns, DataAccessLogicError is thrown
+  virtual casacore::Cube<casacore::Complex>& rwVisibility();
+
+  /// @brief calibrated noise
+  /// @return a reference to nRow x nChannel x nPol cube with complex noise estimates
+  virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// @brief flags
+  /// @details Samples with undefined calibration are flagged in addition to flags
+  /// of the original accessor.
+  /// @return a reference to nRow x nChannel x nPol cube with flags
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+protected:
+  /// @brief update Jones matrices and drop cached products if the accessor changed
+  void checkAccessor() const;
+
+  /// @brief check that the polarisation products can be calibrated
+  /// @details An exception is thrown if the products are not supported
+  /// @param[in] stokes polarisation products of the original accessor
+  static void checkPolarisations(const casacore::Vector<casacore::Stokes::StokesTypes> &stokes);
+
+  /// @brief obtain Jones matrices for the current chunk
+  /// @details The matrices are only reread if the solution ID or the chunk shape changes.
+  /// The per-row offsets into the Jones array are updated every time.
+  void updateJones() const;
+
+  /// @brief run a job over all rows of the chunk, in parallel if configured
+  /// @param[in] job function processing a range of rows (the first row and one past the last row)
+  void runForRows(const boost::function<void(casacore::uInt, casacore::uInt)> &job) const;
+
+  /// @brief fill the buffer with calibrated visibilities
+  /// @param[in] vis cube to fill
+  void fillVisibility(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief fill the buffer with calibrated noise
+  /// @param[in] noise cube to fill
+  void fillNoise(casacore::Cube<casacore::Complex> &noise) const;
+
+  /// @brief fill the buffer with flags
+  /// @param[in] flag cube to fill
+  void fillFlag(casacore::Cube<casacore::Bool> &flag) const;
+
+  /// @brief apply Jones matrices to visibilities for a range of rows
+  /// @param[in] in pointer to the input visibility cube
+  /// @param[in] out pointer to the output visibility cube
+  /// @param[in] startRow first row to process
+  /// @param[in] endRow one past the last row to process
+  void visibilityKernel(const casacore::Complex *in, casacore::Complex *out, 
+                        casacore::uInt startRow, casacore::uInt endRow) const;
+
+  /// @brief propagate noise for a range of rows
+  /// @param[in] in pointer to the input noise cube
+  /// @param[in] out pointer to the output noise cube
+  /// @param[in] startRow first row to process
+  /// @param[in] endRow one past the last row to process
+  void noiseKernel(const casacore::Complex *in, casacore::Complex *out, 
+                   casacore::uInt startRow, casacore::uInt endRow) const;
+
+  /// @brief update flags for a range of rows
+  /// @param[in] in pointer to the input flag cube
+  /// @param[in] out pointer to the output flag cube
+  /// @param[in] startRow first row to process
+  /// @param[in] endRow one past the last row to process
+  void flagKernel(const casacore::Bool *in, casacore::Bool *out, 
+                  casacore::uInt startRow, casacore::uInt endRow) const;
+
+private:
+  /// @brief solution source
+  boost::shared_ptr<ICalSolutionConstSource> itsSource;
+
+  /// @brief true, if calibration is applied, false if visibilities are corrupted
+  bool itsCorrect;
+
+  /// @brief number of threads
+  casacore::uInt itsNThreads;
+
+  /// @brief solution accessor the Jones matrices correspond to
+  mutable boost::shared_ptr<ICalSolutionConstAccessor> itsSolution;
+
+  /// @brief ID of the solution the Jones matrices correspond to
+  mutable long itsSolutionID;
+
+  /// @brief Jones matrices (inverted in the correction mode), 4 x nChan x nAnt x nBeam
+  mutable casacore::Array<casacore::Complex> itsJones;
+
+  /// @brief validity of the Jones matrices, nChan x nAnt x nBeam
+  mutable casacore::Cube<casacore::Bool> itsJonesValidity;
+
+  /// @brief index of ant1/beam1 pair in the Jones array for every row 
+  mutable casacore::Vector<casacore::uInt> itsIndex1;
+
+  /// @brief index of ant2/beam2 pair in the Jones array for every row
+  mutable casacore::Vector<casacore::uInt> itsIndex2;
+
+  /// @brief change monitor of the accessor the cached products correspond to
+  mutable scimath::ChangeMonitor itsCachedMonitor;
+
+  /// @brief calibrated visibilities
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsVisibility;
+
+  /// @brief calibrated noise
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsNoise;
+
+  /// @brief flags
+  CachedAccessorField<casacore::Cube<casacore::Bool> > itsFlag;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CALIBRATING_ACCESSOR_H
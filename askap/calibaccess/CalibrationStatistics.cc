@@ -0,0 +1,364 @@
+/// @file
+/// @brief cost statistics of the calibration solution access
+/// @details This class accumulates the number and duration of solution lookups,
+/// construction of accessors, cube fills done by the table-based filler, use of the
+/// accessor caches and the number of Jones matrices requested by the user code. The
+/// statistics are collected for the whole process and switched off by default, they can
+/// be switched on via the parset (see configure) and written into the log next to the
+/// iterator statistics of the data sources (see IteratorStatistics).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/calibaccess/CalibrationStatistics.h>
+
+// boost includes
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+ASKAP_LOGGER(logger, ".calibaccess");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief start the timer
+/// @param[in] stage operation being timed
+CalibrationStatistics::ScopedTimer::ScopedTimer(Stage stage) :
+        itsStage(stage), itsEnabled(CalibrationStatistics::instance().isEnabled())
+{
+  if (itsEnabled) {
+      itsStart = boost::posix_time::microsec_clock::universal_time();
+  }
+}
+
+/// @brief stop the timer and update the statistics
+CalibrationStatistics::ScopedTimer::~ScopedTimer()
+{
+  if (itsEnabled) {
+      const boost::posix_time::time_duration elapsed =
+            boost::posix_time::microsec_clock::universal_time() - itsStart;
+      CalibrationStatistics::instance().addTime(itsStage, 1e-6 * double(elapsed.total_microseconds()));
+  }
+}
+
+/// @brief construct an object with all counters set to zero
+CalibrationStatistics::CalibrationStatistics() : itsEnabled(false), itsUsed(false)
+{
+  reset();
+}
+
+/// @brief the statistics of this process
+/// @return reference to the object
+CalibrationStatistics& CalibrationStatistics::instance()
+{
+  static CalibrationStatistics stats;
+  return stats;
+}
+
+/// @brief switch the collection on or off
+/// @details The counters are not reset, so the collection can be paused.
+/// @param[in] collect true to collect the statistics
+void CalibrationStatistics::enable(bool collect)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsEnabled = collect;
+  if (collect) {
+      itsUsed = true;
+  }
+}
+
+/// @brief switch the collection on if requested in the parset
+/// @details Nothing is done if the key is not defined, so the collection switched
+/// on by one component is not switched off by another.
+/// @param[in] parset parameters
+/// @param[in] key name of the boolean parameter
+void CalibrationStatistics::configure(const LOFAR::ParameterSet &parset, const std::string &key)
+{
+  if (!isEnabled() && parset.isDefined(key) && parset.getBool(key)) {
+      ASKAPLOG_INFO_STR(logger, "Statistics of the calibration solution access will be collected");
+      enable();
+  }
+}
+
+/// @brief reset all counters to zero
+void CalibrationStatistics::reset()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  for (int stage = 0; stage < N_STAGES; ++stage) {
+       itsTimes[stage] = 0.;
+       itsCalls[stage] = 0;
+       itsBytes[stage] = 0;
+  }
+  itsScannedRows = 0;
+  itsAccessorsCreated = 0;
+  itsAccessorsReused = 0;
+  itsCacheFills = 0;
+  itsCacheHits = 0;
+  itsJonesCalls = 0;
+  itsJonesBlockCalls = 0;
+  itsJonesBlockMatrices = 0;
+}
+
+/// @brief account for the time spent in an operation
+/// @param[in] stage operation
+/// @param[in] seconds wall clock time in seconds
+void CalibrationStatistics::addTime(Stage stage, double seconds)
+{
+  ASKAPDEBUGASSERT((stage >= 0) && (stage < N_STAGES));
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      itsTimes[stage] += seconds;
+      ++itsCalls[stage];
+  }
+}
+
+/// @brief account for the data read in an operation
+/// @param[in] stage operation
+/// @param[in] bytes number of bytes
+void CalibrationStatistics::addBytes(Stage stage, casacore::uInt64 bytes)
+{
+  ASKAPDEBUGASSERT((stage >= 0) && (stage < N_STAGES));
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      itsBytes[stage] += bytes;
+  }
+}
+
+/// @brief account for the time stamps examined during the solution search
+/// @param[in] nRows number of rows (or solutions) examined
+void CalibrationStatistics::addScan(casacore::uInt64 nRows)
+{
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      itsScannedRows += nRows;
+  }
+}
+
+/// @brief account for an accessor set up by roSolution
+void CalibrationStatistics::accessorCreated()
+{
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      ++itsAccessorsCreated;
+  }
+}
+
+/// @brief account for an accessor found in the cache of the solution source
+void CalibrationStatistics::accessorReused()
+{
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      ++itsAccessorsReused;
+  }
+}
+
+/// @brief account for a calibration product read into the cache of the accessor
+void CalibrationStatistics::cacheFill()
+{
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      ++itsCacheFills;
+  }
+}
+
+/// @brief account for a calibration product served from the cache of the accessor
+void CalibrationStatistics::cacheHit()
+{
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      ++itsCacheHits;
+  }
+}
+
+/// @brief account for a request of a single Jones matrix (jones, jonesValid, jonesAndValidity)
+void CalibrationStatistics::jonesCall()
+{
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      ++itsJonesCalls;
+  }
+}
+
+/// @brief account for a request of a block of Jones matrices (jonesBlock)
+/// @param[in] nMatrices number of matrices in the block
+void CalibrationStatistics::jonesBlockCall(casacore::uInt64 nMatrices)
+{
+  if (isEnabled()) {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      ++itsJonesBlockCalls;
+      itsJonesBlockMatrices += nMatrices;
+  }
+}
+
+/// @brief time spent in the given operation
+/// @param[in] stage operation
+/// @return wall clock time in seconds
+double CalibrationStatistics::time(Stage stage) const
+{
+  ASKAPCHECK((stage >= 0) && (stage < N_STAGES), "Unknown stage "<<int(stage));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsTimes[stage];
+}
+
+/// @brief number of times the given operation has been done
+/// @param[in] stage operation
+/// @return number of calls
+casacore::uInt64 CalibrationStatistics::nCalls(Stage stage) const
+{
+  ASKAPCHECK((stage >= 0) && (stage < N_STAGES), "Unknown stage "<<int(stage));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsCalls[stage];
+}
+
+/// @brief bytes read in the given operation
+/// @param[in] stage operation
+/// @return number of bytes
+casacore::uInt64 CalibrationStatistics::bytes(Stage stage) const
+{
+  ASKAPCHECK((stage >= 0) && (stage < N_STAGES), "Unknown stage "<<int(stage));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsBytes[stage];
+}
+
+/// @brief number of time stamps examined during the solution search
+casacore::uInt64 CalibrationStatistics::nScannedRows() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsScannedRows;
+}
+
+/// @brief number of accessors set up by roSolution
+casacore::uInt64 CalibrationStatistics::nAccessorsCreated() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsAccessorsCreated;
+}
+
+/// @brief number of accessors found in the cache of the solution source
+casacore::uInt64 CalibrationStatistics::nAccessorsReused() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsAccessorsReused;
+}
+
+/// @brief number of calibration products read into the caches of the accessors
+casacore::uInt64 CalibrationStatistics::nCacheFills() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsCacheFills;
+}
+
+/// @brief number of calibration products served from the caches of the accessors
+casacore::uInt64 CalibrationStatistics::nCacheHits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsCacheHits;
+}
+
+/// @brief number of requests of single Jones matrices
+casacore::uInt64 CalibrationStatistics::nJonesCalls() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsJonesCalls;
+}
+
+/// @brief number of requests of blocks of Jones matrices
+casacore::uInt64 CalibrationStatistics::nJonesBlockCalls() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsJonesBlockCalls;
+}
+
+/// @brief number of Jones matrices obtained in blocks
+casacore::uInt64 CalibrationStatistics::nJonesBlockMatrices() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsJonesBlockMatrices;
+}
+
+/// @brief name of the operation
+/// @param[in] stage operation
+/// @return the name used in the log
+std::string CalibrationStatistics::stageName(Stage stage)
+{
+  switch (stage) {
+     case SOLUTION_ID:
+          return "solutionID";
+     case RO_SOLUTION:
+          return "roSolution";
+     case FILL_GAINS:
+          return "fillGains";
+     case FILL_LEAKAGES:
+          return "fillLeakages";
+     case FILL_BANDPASSES:
+          return "fillBandpasses";
+     case FILL_BANDPASS_MODEL:
+          return "fillBandpassModel";
+     default:
+          ASKAPTHROW(AskapError, "Unknown stage "<<int(stage));
+  }
+  return "";
+}
+
+/// @brief write the statistics into the log
+/// @details This method is intended to be called at the end of the job together with
+/// IteratorStatistics::log, the summary is written at the INFO level. Nothing is written
+/// if the collection has never been switched on.
+void CalibrationStatistics::log() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (!itsUsed) {
+      return;
+  }
+  ASKAPLOG_INFO_STR(logger, "Calibration statistics: "<<itsCalls[SOLUTION_ID]<<" solution lookup(s), "<<
+                    itsScannedRows<<" time stamp(s) examined");
+  for (int stage = 0; stage < N_STAGES; ++stage) {
+       if (itsCalls[stage] > 0) {
+           if (itsBytes[stage] > 0) {
+               ASKAPLOG_INFO_STR(logger, "  "<<stageName(Stage(stage))<<": "<<itsTimes[stage]<<
+                                 " s in "<<itsCalls[stage]<<" call(s), "<<itsBytes[stage]<<" bytes read");
+           } else {
+               ASKAPLOG_INFO_STR(logger, "  "<<stageName(Stage(stage))<<": "<<itsTimes[stage]<<
+                                 " s in "<<itsCalls[stage]<<" call(s)");
+           }
+       }
+  }
+  ASKAPLOG_INFO_STR(logger, "  accessors: "<<itsAccessorsCreated<<" set up, "<<itsAccessorsReused<<
+                    " reused from the cache");
+  ASKAPLOG_INFO_STR(logger, "  calibration products: "<<itsCacheFills<<" read(s) on demand, "<<
+                    itsCacheHits<<" cache hit(s)");
+  ASKAPLOG_INFO_STR(logger, "  Jones matrices: "<<itsJonesCalls<<" single request(s), "<<
+                    itsJonesBlockMatrices<<" in "<<itsJonesBlockCalls<<" block request(s)");
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,262 @@
+/// @file
+/// @brief cost statistics of the calibration solution access
+/// @details This class accumulates the number and duration of solution lookups,
+/// construction of accessors, cube fills done by the table-based filler, use of the
+/// accessor caches and the number of Jones matrices requested by the user code. The
+/// statistics are collected for the whole process and switched off by default, they can
+/// be switched on via the parset (see configure) and written into the log next to the
+/// iterator statistics of the data sources (see IteratorStatistics).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_CALIBRATION_STATISTICS_H
+#define ASKAP_ACCESSORS_CALIBRATION_STATISTICS_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief cost statistics of the calibration solution access
+/// @details There is one object per process (see instance), it is updated by the solution
+/// sources, fillers and accessors of all threads. Nothing is accumulated unless the collection
+/// is switched on, the check is a single flag test, so the calls can stay in the hot paths
+/// (e.g. jones()). All other methods are thread-safe. Times are wall clock times, the time of
+/// roSolution includes the cube fills done while the accessor is set up (if any). Bytes
+/// correspond to the size of the cubes (values and flags) obtained from the table.
+/// @ingroup calibaccess
+class CalibrationStatistics : private boost::noncopyable
+{
+public:
+  /// @brief timed operations
+  enum Stage {
+     /// @brief search for the solution valid at the given time (solutionID)
+     SOLUTION_ID = 0,
+     /// @brief set up of the read-only accessor (roSolution)
+     RO_SOLUTION,
+     /// @brief read of gains from the table (fillGains)
+     FILL_GAINS,
+     /// @brief read of leakages from the table (fillLeakages)
+     FILL_LEAKAGES,
+     /// @brief read of bandpasses from the table (fillBandpasses)
+     FILL_BANDPASSES,
+     /// @brief read of the parametric bandpass from the table (fillBandpassModel)
+     FILL_BANDPASS_MODEL,
+     /// @brief number of stages, should be the last
+     N_STAGES
+  };
+
+  /// @brief helper class timing a block of code
+  /// @details The time between construction and destruction is added to the
+  /// given stage of the process-wide statistics. Nothing is done if the
+  /// collection is switched off when the timer is constructed.
+  class ScopedTimer : private boost::noncopyable {
+  public:
+     /// @brief start the timer
+     /// @param[in] stage operation being timed
+     explicit ScopedTimer(Stage stage);
+
+     /// @brief stop the timer and update the statistics
+     ~ScopedTimer();
+  private:
+     /// @brief operation being timed
+     Stage itsStage;
+     /// @brief true if the statistics are collected
+     bool itsEnabled;
+     /// @brief start time
+     boost::posix_time::ptime itsStart;
+  };
+
+  /// @brief the statistics of this process
+  /// @return reference to the object
+  static CalibrationStatistics& instance();
+
+  /// @brief check whether the statistics are collected
+  /// @return true if the collection is switched on
+  inline bool isEnabled() const { return itsEnabled; }
+
+  /// @brief switch the collection on or off
+  /// @details The counters are not reset, so the collection can be paused.
+  /// @param[in] collect true to collect the statistics
+  void enable(bool collect = true);
+
+  /// @brief switch the collection on if requested in the parset
+  /// @details Nothing is done if the key is not defined, so the collection switched
+  /// on by one component is not switched off by another.
+  /// @param[in] parset parameters
+  /// @param[in] key name of the boolean parameter
+  void configure(const LOFAR::ParameterSet &parset, const std::string &key);
+
+  /// @brief reset all counters to zero
+  void reset();
+
+  /// @brief account for the time spent in an operation
+  /// @param[in] stage operation
+  /// @param[in] seconds wall clock time in seconds
+  void addTime(Stage stage, double seconds);
+
+  /// @brief account for the data read in an operation
+  /// @param[in] stage operation
+  /// @param[in] bytes number of bytes
+  void addBytes(Stage stage, casacore::uInt64 bytes);
+
+  /// @brief account for the time stamps examined during the solution search
+  /// @param[in] nRows number of rows (or solutions) examined
+  void addScan(casacore::uInt64 nRows);
+
+  /// @brief account for an accessor set up by roSolution
+  void accessorCreated();
+
+  /// @brief account for an accessor found in the cache of the solution source
+  void accessorReused();
+
+  /// @brief account for a calibration product read into the cache of the accessor
+  void cacheFill();
+
+  /// @brief account for a calibration product served from the cache of the accessor
+  void cacheHit();
+
+  /// @brief account for a request of a single Jones matrix (jones, jonesValid, jonesAndValidity)
+  void jonesCall();
+
+  /// @brief account for a request of a block of Jones matrices (jonesBlock)
+  /// @param[in] nMatrices number of matrices in the block
+  void jonesBlockCall(casacore::uInt64 nMatrices);
+
+  /// @brief time spent in the given operation
+  /// @param[in] stage operation
+  /// @return wall clock time in seconds
+  double time(Stage stage) const;
+
+  /// @brief number of times the given operation has been done
+  /// @param[in] stage operation
+  /// @return number of calls
+  casacore::uInt64 nCalls(Stage stage) const;
+
+  /// @brief bytes read in the given operation
+  /// @param[in] stage operation
+  /// @return number of bytes
+  casacore::uInt64 bytes(Stage stage) const;
+
+  /// @brief number of time stamps examined during the solution search
+  casacore::uInt64 nScannedRows() const;
+
+  /// @brief number of accessors set up by roSolution
+  casacore::uInt64 nAccessorsCreated() const;
+
+  /// @brief number of accessors found in the cache of the solution source
+  casacore::uInt64 nAccessorsReused() const;
+
+  /// @brief number of calibration products read into the caches of the accessors
+  casacore::uInt64 nCacheFills() const;
+
+  /// @brief number of calibration products served from the caches of the accessors
+  casacore::uInt64 nCacheHits() const;
+
+  /// @brief number of requests of single Jones matrices
+  casacore::uInt64 nJonesCalls() const;
+
+  /// @brief number of requests of blocks of Jones matrices
+  casacore::uInt64 nJonesBlockCalls() const;
+
+  /// @brief number of Jones matrices obtained in blocks
+  casacore::uInt64 nJonesBlockMatrices() const;
+
+  /// @brief name of the operation
+  /// @param[in] stage operation
+  /// @return the name used in the log
+  static std::string stageName(Stage stage);
+
+  /// @brief write the statistics into the log
+  /// @details This method is intended to be called at the end of the job together with
+  /// IteratorStatistics::log, the summary is written at the INFO level. Nothing is written
+  /// if the collection has never been switched on.
+  void log() const;
+
+private:
+  /// @brief construct an object with all counters set to zero
+  CalibrationStatistics();
+
+  /// @brief true if the statistics are collected
+  volatile bool itsEnabled;
+
+  /// @brief true if the collection has been switched on at least once
+  bool itsUsed;
+
+  /// @brief time in seconds per operation
+  double itsTimes[N_STAGES];
+
+  /// @brief number of calls per operation
+  casacore::uInt64 itsCalls[N_STAGES];
+
+  /// @brief bytes read per operation
+  casacore::uInt64 itsBytes[N_STAGES];
+
+  /// @brief number of time stamps examined during the solution search
+  casacore::uInt64 itsScannedRows;
+
+  /// @brief number of accessors set up by roSolution
+  casacore::uInt64 itsAccessorsCreated;
+
+  /// @brief number of accessors found in the cache of the solution source
+  casacore::uInt64 itsAccessorsReused;
+
+  /// @brief number of calibration products read into the caches of the accessors
+  casacore::uInt64 itsCacheFills;
+
+  /// @brief number of calibration products served from the caches of the accessors
+  casacore::uInt64 itsCacheHits;
+
+  /// @brief number of requests of single Jones matrices
+  casacore::uInt64 itsJonesCalls;
+
+  /// @brief number of requests of blocks of Jones matrices
+  casacore::uInt64 itsJonesBlockCalls;
+
+  /// @brief number of Jones matrices obtained in blocks
+  casacore::uInt64 itsJonesBlockMatrices;
+
+  /// @brief mutex protecting the counters
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CALIBRATION_STATISTICS_H
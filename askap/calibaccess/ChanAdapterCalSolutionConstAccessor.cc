@@ -1,10 +1,9 @@
 /// @file
 /// @brief An adapter to adjust channel number                           
-/// @details This adapter is handy if one needs to add a fixed offset to
-/// channel numbers in the requested bandpass solution. It is not clear 
-/// whether we want this class to stay long term (it is largely intended
-/// for situations where the design was not very good and ideally we need
-/// to redesign the code rather than do it quick and dirty way via the adapter).
+/// @details This adapter is handy if one needs to map channel numbers of the
+/// data to channels of the bandpass solution. Linear mappings (an offset and
+/// a stride, e.g. for averaged data) and frequency-based mappings with
+/// interpolation between channels of the solution grid are supported. 
 ///
 /// @copyright (c) 2011 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -32,20 +31,68 @@
 
 // own includes
 #include <askap/calibaccess/ChanAdapterCalSolutionConstAccessor.h>
+#include <askap/calibaccess/InterpolatingCalSolutionConstAccessor.h>
 #include <askap/askap/AskapError.h>
 
+// std includes
+#include <algorithm>
+
 namespace askap {
 namespace accessors {
 
 /// @brief set up the adapter
 /// @details The constructor sets the shared pointer to the accessor which
-/// is wrapped around and the channel offset
+/// is wrapped around and the linear channel mapping
 /// @param[in] acc shared pointer to the original accessor to wrap
 /// @param[in] offset channel offset to add to bandpass request
-ChanAdapterCalSolutionConstAccessor::ChanAdapterCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc, const casacore::uInt offset) :
-        itsAccessor(acc), itsOffset(offset) 
+/// @param[in] stride number of solution channels per data channel
+ChanAdapterCalSolutionConstAccessor::ChanAdapterCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc, 
+        const casacore::uInt offset, const casacore::uInt stride) :
+        itsAccessor(acc), itsOffset(offset), itsStride(stride)
+{
+   ASKAPASSERT(acc);
+   ASKAPCHECK(stride > 0, "Channel stride should be positive");
+}
+
+/// @brief set up the adapter with frequency-based mapping
+/// @details The bandpass for a data channel is interpolated linearly (in amplitude
+/// and phase) between two solution channels bracketing its frequency. Data channels
+/// outside the solution grid get the bandpass of the nearest edge channel. The
+/// mapping is computed once in the constructor.
+/// @param[in] acc shared pointer to the original accessor to wrap
+/// @param[in] solFreqs frequencies of the solution channels (strictly monotonic)
+/// @param[in] dataFreqs frequencies of the data channels (in the same units)
+ChanAdapterCalSolutionConstAccessor::ChanAdapterCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc, 
+        const casacore::Vector<double> &solFreqs, const casacore::Vector<double> &dataFreqs) :
+        itsAccessor(acc), itsOffset(0u), itsStride(1u), itsLowChan(dataFreqs.nelements(), 0u),
+        itsWeight(dataFreqs.nelements(), 0.)
 {
    ASKAPASSERT(acc);
+   ASKAPCHECK(solFreqs.nelements() > 0, "At least one solution channel is required for frequency-based mapping");
+   ASKAPCHECK(dataFreqs.nelements() > 0, "At least one data channel is required for frequency-based mapping");
+   // work with increasing frequencies, descending grid is handled by the change of sign
+   const double sign = (solFreqs.nelements() > 1) && (solFreqs[1] < solFreqs[0]) ? -1. : 1.;
+   std::vector<double> grid(solFreqs.nelements());
+   for (size_t chan = 0; chan < grid.size(); ++chan) {
+        grid[chan] = sign * solFreqs[chan];
+        ASKAPCHECK((chan == 0) || (grid[chan] > grid[chan - 1]), 
+                   "Frequencies of the solution channels are expected to be strictly monotonic, channel "<<chan<<
+                   " breaks the order");
+   }
+   for (size_t chan = 0; chan < itsLowChan.size(); ++chan) {
+        const double freq = sign * dataFreqs[chan];
+        if (freq <= grid.front()) {
+            itsLowChan[chan] = 0u;
+        } else if (freq >= grid.back()) {
+            itsLowChan[chan] = casacore::uInt(grid.size() - 1);
+        } else {
+            // grid.front() < freq < grid.back(), so there is at least one element on each side
+            const size_t high = std::upper_bound(grid.begin(), grid.end(), freq) - grid.begin();
+            ASKAPDEBUGASSERT((high > 0) && (high < grid.size()));
+            itsLowChan[chan] = casacore::uInt(high - 1);
+            itsWeight[chan] = (freq - grid[high - 1]) / (grid[high] - grid[high - 1]);
+        }
+   }
 }
    
 /// @brief obtain gains (J-Jones)
@@ -88,7 +135,92 @@ JonesDTerm ChanAdapterCalSolutionConstAccessor::leakage(const JonesIndex &index)
 /// @return JonesJTerm object with gains and validity flags
 JonesJTerm ChanAdapterCalSolutionConstAccessor::bandpass(const JonesIndex &index, const casacore::uInt chan) const
 {
-   return itsAccessor->bandpass(index, chan + itsOffset);
+   if (itsLowChan.size() == 0) {
+       return itsAccessor->bandpass(index, itsOffset + itsStride * chan);
+   }
+   ASKAPCHECK(chan < itsLowChan.size(), "Channel "<<chan<<" is outside the frequency grid of "<<itsLowChan.size()<<
+              " data channels");
+   const casacore::uInt lowChan = itsLowChan[chan];
+   const double weight = itsWeight[chan];
+   const JonesJTerm bp1 = itsAccessor->bandpass(index, lowChan);
+   return weight > 0. ? interpolate(bp1, itsAccessor->bandpass(index, lowChan + 1), weight) : bp1;
+}
+
+/// @brief fill Jones matrices for all antennas of one beam in a range of channels
+/// @details A plain offset is passed to the bulk method of the original accessor.
+/// For the frequency-based mapping, bandpasses of the solution channels covering
+/// the requested slice are obtained once per antenna and then interpolated to
+/// the data channels.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+/// @param[out] validity pointer to nChan * nAnt validity flags to fill
+void ChanAdapterCalSolutionConstAccessor::fillJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::uInt startChan, const casacore::uInt nChan, casacore::Complex *jones,
+                casacore::Bool *validity) const
+{
+   if (itsLowChan.size() == 0) {
+       if (itsStride != 1) {
+           // no contiguous slice of the solution to ask for
+           ICalSolutionConstAccessor::fillJonesBlock(beam, nAnt, startChan, nChan, jones, validity);
+           return;
+       }
+       casacore::Cube<casacore::Complex> buf;
+       casacore::Matrix<casacore::Bool> bufValidity;
+       itsAccessor->jonesBlock(beam, nAnt, startChan + itsOffset, nChan, buf, bufValidity);
+       std::copy(buf.data(), buf.data() + buf.nelements(), jones);
+       std::copy(bufValidity.data(), bufValidity.data() + bufValidity.nelements(), validity);
+       return;
+   }
+   ASKAPCHECK(startChan + nChan <= itsLowChan.size(), "Channels "<<startChan<<" to "<<startChan + nChan - 1<<
+              " are outside the frequency grid of "<<itsLowChan.size()<<" data channels");
+   if (nChan == 0) {
+       return;
+   }
+   // range of solution channels required for this slice
+   casacore::uInt minChan = itsLowChan[startChan];
+   casacore::uInt maxChan = minChan;
+   for (casacore::uInt chan = startChan; chan < startChan + nChan; ++chan) {
+        minChan = std::min(minChan, itsLowChan[chan]);
+        maxChan = std::max(maxChan, itsWeight[chan] > 0. ? itsLowChan[chan] + 1 : itsLowChan[chan]);
+   }
+   std::vector<JonesJTerm> bpTerms(maxChan - minChan + 1);
+   for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+        const JonesIndex index(ant, beam);
+        const JonesJTerm gTerm = gain(index);
+        const JonesDTerm dTerm = leakage(index);
+        for (casacore::uInt solChan = minChan; solChan <= maxChan; ++solChan) {
+             bpTerms[solChan - minChan] = itsAccessor->bandpass(index, solChan);
+        }
+        for (casacore::uInt chan = startChan; chan < startChan + nChan; ++chan, jones += 4, ++validity) {
+             const JonesJTerm &bp1 = bpTerms[itsLowChan[chan] - minChan];
+             const double weight = itsWeight[chan];
+             *validity = composeJones(gTerm, weight > 0. ? interpolate(bp1, bpTerms[itsLowChan[chan] + 1 - minChan], weight) : bp1,
+                                      dTerm, jones);
+        }
+   }
+}
+
+/// @brief interpolate between bandpasses of two solution channels
+/// @details The same rules as for interpolation in time apply, i.e. if only one 
+/// of the two values is valid, it is returned unchanged.
+/// @param[in] bp1 bandpass of the lower solution channel
+/// @param[in] bp2 bandpass of the upper solution channel
+/// @param[in] weight weight of the upper solution channel (from 0 to 1)
+/// @return interpolated bandpass
+JonesJTerm ChanAdapterCalSolutionConstAccessor::interpolate(const JonesJTerm &bp1, const JonesJTerm &bp2, const double weight)
+{
+   casacore::Complex g1 = bp2.g1IsValid() ? bp2.g1() : bp1.g1();
+   if (bp1.g1IsValid() && bp2.g1IsValid()) {
+       g1 = InterpolatingCalSolutionConstAccessor::interpolate(bp1.g1(), bp2.g1(), weight);
+   }
+   casacore::Complex g2 = bp2.g2IsValid() ? bp2.g2() : bp1.g2();
+   if (bp1.g2IsValid() && bp2.g2IsValid()) {
+       g2 = InterpolatingCalSolutionConstAccessor::interpolate(bp1.g2(), bp2.g2(), weight);
+   }
+   return JonesJTerm(g1, bp1.g1IsValid() || bp2.g1IsValid(), g2, bp1.g2IsValid() || bp2.g2IsValid());
 }
    
 } // namespace accessors
@@ -1,10 +1,9 @@
 /// @file
 /// @brief An adapter to adjust channel number                           
-/// @details This adapter is handy if one needs to add a fixed offset to
-/// channel numbers in the requested bandpass solution. It is not clear 
-/// whether we want this class to stay long term (it is largely intended
-/// for situations where the design was not very good and ideally we need
-/// to redesign the code rather than do it quick and dirty way via the adapter).
+/// @details This adapter is handy if one needs to map channel numbers of the
+/// data to channels of the bandpass solution. Linear mappings (an offset and
+/// a stride, e.g. for averaged data) and frequency-based mappings with
+/// interpolation between channels of the solution grid are supported. 
 ///
 /// @copyright (c) 2011 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -33,30 +32,53 @@
 #ifndef ASKAP_ACCESSORS_CHAN_ADAPTER_CAL_SOLUTION_CONST_ACCESSOR_H
 #define ASKAP_ACCESSORS_CHAN_ADAPTER_CAL_SOLUTION_CONST_ACCESSOR_H
 
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+
 // boost includes
 #include "boost/shared_ptr.hpp"
 
 // own includes
 #include <askap/calibaccess/ICalSolutionConstAccessor.h>
 
+// std includes
+#include <vector>
+
 namespace askap {
 namespace accessors {
 
 /// @brief An adapter to adjust channel number                           
-/// @details This adapter is handy if one needs to add a fixed offset to
-/// channel numbers in the requested bandpass solution. It is not clear 
-/// whether we want this class to stay long term (it is largely intended
-/// for situations where the design was not very good and ideally we need
-/// to redesign the code rather than do it quick and dirty way via the adapter).
+/// @details This adapter is handy if one needs to map channel numbers of the
+/// data to channels of the bandpass solution. Two kinds of mapping are supported:
+/// a linear mapping where data channel chan corresponds to solution channel
+/// offset + stride * chan, and a frequency-based mapping where the bandpass is
+/// interpolated from the frequency grid of the solution to the frequency of the data
+/// channel. It is not clear whether we want this class to stay long term (it is 
+/// largely intended for situations where the design was not very good and ideally 
+/// we need to redesign the code rather than do it quick and dirty way via the adapter).
 /// @ingroup calibaccess
 struct ChanAdapterCalSolutionConstAccessor : public ICalSolutionConstAccessor {
    
    /// @brief set up the adapter
    /// @details The constructor sets the shared pointer to the accessor which
-   /// is wrapped around and the channel offset
+   /// is wrapped around and the linear channel mapping
    /// @param[in] acc shared pointer to the original accessor to wrap
    /// @param[in] offset channel offset to add to bandpass request
-   ChanAdapterCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc, const casacore::uInt offset);
+   /// @param[in] stride number of solution channels per data channel
+   ChanAdapterCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc, const casacore::uInt offset,
+                                       const casacore::uInt stride = 1u);
+
+   /// @brief set up the adapter with frequency-based mapping
+   /// @details The bandpass for a data channel is interpolated linearly (in amplitude
+   /// and phase) between two solution channels bracketing its frequency. Data channels
+   /// outside the solution grid get the bandpass of the nearest edge channel. The
+   /// mapping is computed once in the constructor.
+   /// @param[in] acc shared pointer to the original accessor to wrap
+   /// @param[in] solFreqs frequencies of the solution channels (strictly monotonic)
+   /// @param[in] dataFreqs frequencies of the data channels (in the same units)
+   ChanAdapterCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc, 
+                                       const casacore::Vector<double> &solFreqs,
+                                       const casacore::Vector<double> &dataFreqs);
    
    /// @brief obtain gains (J-Jones)
    /// @details This method retrieves parallel-hand gains for both 
@@ -94,12 +116,46 @@ struct ChanAdapterCalSolutionConstAccessor : public ICalSolutionConstAccessor {
    
    /// @brief shared pointer definition
    typedef boost::shared_ptr<ChanAdapterCalSolutionConstAccessor> ShPtr;
+
+protected:
+   /// @brief fill Jones matrices for all antennas of one beam in a range of channels
+   /// @details A plain offset is passed to the bulk method of the original accessor.
+   /// For the frequency-based mapping, bandpasses of the solution channels covering
+   /// the requested slice are obtained once per antenna and then interpolated to
+   /// the data channels.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+   /// @param[out] validity pointer to nChan * nAnt validity flags to fill
+   virtual void fillJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                   const casacore::uInt nChan, casacore::Complex *jones, casacore::Bool *validity) const;
+
+   /// @brief interpolate between bandpasses of two solution channels
+   /// @details The same rules as for interpolation in time apply, i.e. if only one 
+   /// of the two values is valid, it is returned unchanged.
+   /// @param[in] bp1 bandpass of the lower solution channel
+   /// @param[in] bp2 bandpass of the upper solution channel
+   /// @param[in] weight weight of the upper solution channel (from 0 to 1)
+   /// @return interpolated bandpass
+   static JonesJTerm interpolate(const JonesJTerm &bp1, const JonesJTerm &bp2, const double weight);
+
 private:
    /// @brief original accessor
    const boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor;
 
    /// @brief channel offset to apply
    const casacore::uInt itsOffset;
+
+   /// @brief number of solution channels per data channel
+   const casacore::uInt itsStride;
+
+   /// @brief lower solution channel for every data channel (frequency-based mapping only)
+   std::vector<casacore::uInt> itsLowChan;
+
+   /// @brief weight of the upper solution channel for every data channel (frequency-based mapping only)
+   std::vector<double> itsWeight;
 };
 
 } // namespace accessors
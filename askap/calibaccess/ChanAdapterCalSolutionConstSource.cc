@@ -1,10 +1,11 @@
 /// @file
 /// @brief An adapter to adjust channel number                           
-/// @details This adapter is handy if one needs to add a fixed offset to
-/// channel numbers in the requested bandpass solution. It is not clear 
-/// whether we want this class to stay long term (it is largely intended
-/// for situations where the design was not very good and ideally we need
-/// to redesign the code rather than do it quick and dirty way via the adapter).
+/// @details This adapter is handy if one needs to map channel numbers of the
+/// data to channels of the bandpass solution (see ChanAdapterCalSolutionConstAccessor
+/// for the supported mappings). It is not clear whether we want this class to stay 
+/// long term (it is largely intended for situations where the design was not very 
+/// good and ideally we need to redesign the code rather than do it quick and dirty 
+/// way via the adapter).
 ///
 /// @copyright (c) 2011 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -44,10 +45,27 @@ namespace accessors {
 /// is wrapped around and the channel offset
 /// @param[in] src shared pointer to the original source
 /// @param[in] offset channel offset to add to bandpass value request
-ChanAdapterCalSolutionConstSource::ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, const casacore::uInt offset) :
-    itsSource(src), itsOffset(offset)
+/// @param[in] stride number of solution channels per data channel
+ChanAdapterCalSolutionConstSource::ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, 
+    const casacore::uInt offset, const casacore::uInt stride) : itsSource(src), itsOffset(offset), itsStride(stride)
 {
    ASKAPASSERT(src);
+   ASKAPCHECK(stride > 0, "Channel stride should be positive");
+}
+
+/// @brief set up the adapter with frequency-based mapping
+/// @details Bandpasses are interpolated from the frequency grid of the solution
+/// to the frequencies of the data channels
+/// @param[in] src shared pointer to the original source
+/// @param[in] solFreqs frequencies of the solution channels (strictly monotonic)
+/// @param[in] dataFreqs frequencies of the data channels (in the same units)
+ChanAdapterCalSolutionConstSource::ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, 
+    const casacore::Vector<double> &solFreqs, const casacore::Vector<double> &dataFreqs) : itsSource(src), itsOffset(0u), 
+    itsStride(1u), itsSolFreqs(solFreqs.copy()), itsDataFreqs(dataFreqs.copy())
+{
+   ASKAPASSERT(src);
+   ASKAPCHECK(solFreqs.nelements() > 0, "At least one solution channel is required for frequency-based mapping");
+   ASKAPCHECK(dataFreqs.nelements() > 0, "At least one data channel is required for frequency-based mapping");
 }
   
 /// @brief obtain ID for the most recent solution
@@ -77,8 +95,12 @@ long ChanAdapterCalSolutionConstSource::solutionID(const double time) const
 /// @return shared pointer to an accessor object
 boost::shared_ptr<ICalSolutionConstAccessor> ChanAdapterCalSolutionConstSource::roSolution(const long id) const
 {
+   if (itsDataFreqs.nelements() > 0) {
+       return boost::shared_ptr<ICalSolutionConstAccessor>(new ChanAdapterCalSolutionConstAccessor(itsSource->roSolution(id),
+                  itsSolFreqs, itsDataFreqs));
+   }
    const boost::shared_ptr<ChanAdapterCalSolutionConstAccessor> result(new ChanAdapterCalSolutionConstAccessor(itsSource->roSolution(id),
-          itsOffset));
+          itsOffset, itsStride));
    ASKAPDEBUGASSERT(result);
    return result;
 }
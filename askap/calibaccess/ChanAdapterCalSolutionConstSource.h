@@ -1,10 +1,11 @@
 /// @file
 /// @brief An adapter to adjust channel number                           
-/// @details This adapter is handy if one needs to add a fixed offset to
-/// channel numbers in the requested bandpass solution. It is not clear 
-/// whether we want this class to stay long term (it is largely intended
-/// for situations where the design was not very good and ideally we need
-/// to redesign the code rather than do it quick and dirty way via the adapter).
+/// @details This adapter is handy if one needs to map channel numbers of the
+/// data to channels of the bandpass solution (see ChanAdapterCalSolutionConstAccessor
+/// for the supported mappings). It is not clear whether we want this class to stay 
+/// long term (it is largely intended for situations where the design was not very 
+/// good and ideally we need to redesign the code rather than do it quick and dirty 
+/// way via the adapter).
 ///
 /// @copyright (c) 2011 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -35,16 +36,20 @@
 
 #include <askap/calibaccess/ICalSolutionConstSource.h>
 
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+
 namespace askap {
 
 namespace accessors {
 
 /// @brief An adapter to adjust channel number                           
-/// @details This adapter is handy if one needs to add a fixed offset to
-/// channel numbers in the requested bandpass solution. It is not clear 
-/// whether we want this class to stay long term (it is largely intended
-/// for situations where the design was not very good and ideally we need
-/// to redesign the code rather than do it quick and dirty way via the adapter).
+/// @details This adapter is handy if one needs to map channel numbers of the
+/// data to channels of the bandpass solution (see ChanAdapterCalSolutionConstAccessor
+/// for the supported mappings). It is not clear whether we want this class to stay 
+/// long term (it is largely intended for situations where the design was not very 
+/// good and ideally we need to redesign the code rather than do it quick and dirty 
+/// way via the adapter).
 /// @ingroup calibaccess
 struct ChanAdapterCalSolutionConstSource  : public ICalSolutionConstSource {
 
@@ -53,7 +58,19 @@ struct ChanAdapterCalSolutionConstSource  : public ICalSolutionConstSource {
    /// is wrapped around and the channel offset
    /// @param[in] src shared pointer to the original source
    /// @param[in] offset channel offset to add to bandpass value request
-   ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, const casacore::uInt offset);
+   /// @param[in] stride number of solution channels per data channel
+   ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, const casacore::uInt offset,
+                                     const casacore::uInt stride = 1u);
+
+   /// @brief set up the adapter with frequency-based mapping
+   /// @details Bandpasses are interpolated from the frequency grid of the solution
+   /// to the frequencies of the data channels
+   /// @param[in] src shared pointer to the original source
+   /// @param[in] solFreqs frequencies of the solution channels (strictly monotonic)
+   /// @param[in] dataFreqs frequencies of the data channels (in the same units)
+   ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, 
+                                     const casacore::Vector<double> &solFreqs,
+                                     const casacore::Vector<double> &dataFreqs);
   
    /// @brief obtain ID for the most recent solution
    /// @return ID for the most recent solution
@@ -86,6 +103,15 @@ private:
    /// @brief channel offset
    const casacore::uInt itsOffset;
 
+   /// @brief number of solution channels per data channel
+   const casacore::uInt itsStride;
+
+   /// @brief frequencies of the solution channels (empty for linear mapping)
+   const casacore::Vector<double> itsSolFreqs;
+
+   /// @brief frequencies of the data channels (empty for linear mapping)
+   const casacore::Vector<double> itsDataFreqs;
+
 };
 
 } // namespace accessors
@@ -0,0 +1,211 @@
+/// @file
+/// @brief solution filler deferring writes to TableCalSolutionWriter
+/// @details This is a decorator around another filler (normally TableCalSolutionFiller).
+/// Write operations are queued in the write-behind writer instead of being done straight
+/// away. Read operations return queued data, if available, or wait for the background job
+/// before reading the table via the decorated filler.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/calibaccess/DeferredCalSolutionFiller.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] filler filler to decorate
+/// @param[in] writer write-behind writer
+/// @param[in] id solution ID the filler works with
+DeferredCalSolutionFiller::DeferredCalSolutionFiller(const boost::shared_ptr<ICalSolutionFiller> &filler, 
+                            const TableCalSolutionWriter::ShPtr &writer, const long id) :
+         itsFiller(filler), itsWriter(writer), itsID(id)
+{
+  ASKAPCHECK(itsFiller, "An attempt to initialise DeferredCalSolutionFiller with a void filler");
+  ASKAPCHECK(itsWriter, "An attempt to initialise DeferredCalSolutionFiller with a void writer");
+}
+
+/// @brief fill cubes with queued data or via the decorated filler
+/// @param[in] product calibration product
+/// @param[in] fillMethod method of the decorated filler
+/// @param[out] cubes pair of cubes to fill
+void DeferredCalSolutionFiller::fill(const TableCalSolutionWriter::Product product, 
+            void (ICalSolutionFiller::*fillMethod)(TableCalSolutionWriter::CubePair &) const,
+            TableCalSolutionWriter::CubePair &cubes) const
+{
+  const TableCalSolutionWriter::CubePair *queued = itsWriter->queued(itsID, product);
+  if (queued != NULL) {
+      cubes.first = queued->first.copy();
+      cubes.second = queued->second.copy();
+  } else {
+      itsWriter->wait();
+      ((*itsFiller).*fillMethod)(cubes);
+  }
+}
+
+/// @brief check that solution is absent
+/// @param[in] product calibration product
+/// @param[in] checkMethod method of the decorated filler
+/// @return true, if there is no solution
+bool DeferredCalSolutionFiller::absent(const TableCalSolutionWriter::Product product, 
+                                       bool (ICalSolutionFiller::*checkMethod)() const) const
+{
+  if (itsWriter->queued(itsID, product) != NULL) {
+      return false;
+  }
+  itsWriter->wait();
+  return ((*itsFiller).*checkMethod)();
+}
+
+/// @brief queue an update and start the background job
+/// @param[in] product calibration product
+/// @param[in] cubes values and validity flags to write
+void DeferredCalSolutionFiller::write(const TableCalSolutionWriter::Product product, 
+                                      const TableCalSolutionWriter::CubePair &cubes) const
+{
+  ASKAPCHECK(cubes.first.shape() == cubes.second.shape(), "The cubes with values and validity flags are expected to have the same shape");
+  itsWriter->add(itsFiller, itsID, product, cubes);
+  itsWriter->start();
+}
+
+/// @brief gains filler
+/// @details
+/// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+void DeferredCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
+{
+  fill(TableCalSolutionWriter::GAINS, &ICalSolutionFiller::fillGains, gains);
+}
+
+/// @brief leakage filler
+/// @details
+/// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+void DeferredCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
+{
+  fill(TableCalSolutionWriter::LEAKAGES, &ICalSolutionFiller::fillLeakages, leakages);
+}
+
+/// @brief bandpass filler
+/// @details
+/// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+void DeferredCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
+{
+  fill(TableCalSolutionWriter::BANDPASSES, &ICalSolutionFiller::fillBandpasses, bp);
+}
+
+/// @brief gains writer
+/// @details
+/// @param[in] gains pair of cubes with gains and validity flags (should be 2 x nAnt x nBeam)
+void DeferredCalSolutionFiller::writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
+{
+  write(TableCalSolutionWriter::GAINS, gains);
+}
+
+/// @brief leakage writer
+/// @details
+/// @param[in] leakages pair of cubes with leakages and validity flags (should be 2 x nAnt x nBeam)
+void DeferredCalSolutionFiller::writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
+{
+  write(TableCalSolutionWriter::LEAKAGES, leakages);
+}
+
+/// @brief bandpass writer
+/// @details
+/// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+void DeferredCalSolutionFiller::writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
+{
+  write(TableCalSolutionWriter::BANDPASSES, bp);
+}
+
+/// @brief bandpass model filler
+/// @details The model is reset if bandpass cubes are queued for this solution
+/// @param[in] model shared pointer to the model to set up
+void DeferredCalSolutionFiller::fillBandpassModel(boost::shared_ptr<ParametricBandpass> &model) const
+{
+  // cubes written at the same row take precedence over the model
+  if (itsWriter->queued(itsID, TableCalSolutionWriter::BANDPASSES) != NULL) {
+      model.reset();
+  } else {
+      itsWriter->wait();
+      itsFiller->fillBandpassModel(model);
+  }
+}
+
+/// @brief bandpass model writer
+/// @details The model is small, so it is written straight away after the queued updates
+/// @param[in] model parametric bandpass to write
+void DeferredCalSolutionFiller::writeBandpassModel(const ParametricBandpass &model) const
+{
+  itsWriter->sync();
+  itsFiller->writeBandpassModel(model);
+}
+
+/// @brief check for gain solution
+/// @return true, if there is no gain solution, false otherwise
+bool DeferredCalSolutionFiller::noGain() const
+{
+  return absent(TableCalSolutionWriter::GAINS, &ICalSolutionFiller::noGain);
+}
+
+/// @brief check for leakage solution
+/// @return true, if there is no leakage solution, false otherwise
+bool DeferredCalSolutionFiller::noLeakage() const
+{
+  return absent(TableCalSolutionWriter::LEAKAGES, &ICalSolutionFiller::noLeakage);
+}
+
+/// @brief check for bandpass solution
+/// @return true, if there is no bandpass solution, false otherwise
+bool DeferredCalSolutionFiller::noBandpass() const
+{
+  return absent(TableCalSolutionWriter::BANDPASSES, &ICalSolutionFiller::noBandpass);
+}
+
+/// @brief write all queued updates and flush the underlying data
+bool DeferredCalSolutionFiller::flush()
+{
+  itsWriter->sync();
+  return itsFiller->flush();
+}
+
+/// @brief first spectral channel of the bandpass cube
+/// @return channel corresponding to the rows 0 and 1 of the bandpass cube
+casacore::uInt DeferredCalSolutionFiller::bandpassStartChannel() const
+{
+  return itsFiller->bandpassStartChannel();
+}
+
+/// @brief first beam of the bandpass cube
+/// @return beam corresponding to the plane 0 of the bandpass cube
+casacore::uInt DeferredCalSolutionFiller::bandpassStartBeam() const
+{
+  return itsFiller->bandpassStartBeam();
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,160 @@
+/// @file
+/// @brief solution filler deferring writes to TableCalSolutionWriter
+/// @details This is a decorator around another filler (normally TableCalSolutionFiller).
+/// Write operations are queued in the write-behind writer instead of being done straight
+/// away. Read operations return queued data, if available, or wait for the background job
+/// before reading the table via the decorated filler.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_DEFERRED_CAL_SOLUTION_FILLER_H
+#define ASKAP_ACCESSORS_DEFERRED_CAL_SOLUTION_FILLER_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionFiller.h>
+#include <askap/calibaccess/TableCalSolutionWriter.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief solution filler deferring writes to TableCalSolutionWriter
+/// @details This is a decorator around another filler (normally TableCalSolutionFiller).
+/// Write operations are queued in the write-behind writer instead of being done straight
+/// away. Read operations return queued data, if available, or wait for the background job
+/// before reading the table via the decorated filler. 
+/// @ingroup calibaccess
+class DeferredCalSolutionFiller : virtual public ICalSolutionFiller {
+public:
+  /// @brief constructor
+  /// @param[in] filler filler to decorate
+  /// @param[in] writer write-behind writer
+  /// @param[in] id solution ID the filler works with
+  DeferredCalSolutionFiller(const boost::shared_ptr<ICalSolutionFiller> &filler, 
+                            const TableCalSolutionWriter::ShPtr &writer, const long id);
+
+  /// @brief gains filler
+  /// @details
+  /// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage filler
+  /// @details
+  /// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass filler
+  /// @details
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+  virtual void fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief gains writer
+  /// @details
+  /// @param[in] gains pair of cubes with gains and validity flags (should be 2 x nAnt x nBeam)
+  virtual void writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage writer
+  /// @details
+  /// @param[in] leakages pair of cubes with leakages and validity flags (should be 2 x nAnt x nBeam)
+  virtual void writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass writer
+  /// @details
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+  virtual void writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief bandpass model filler
+  /// @details The model is reset if bandpass cubes are queued for this solution
+  /// @param[in] model shared pointer to the model to set up
+  virtual void fillBandpassModel(boost::shared_ptr<ParametricBandpass> &model) const;
+
+  /// @brief bandpass model writer
+  /// @details The model is small, so it is written straight away after the queued updates
+  /// @param[in] model parametric bandpass to write
+  virtual void writeBandpassModel(const ParametricBandpass &model) const;
+
+  /// @brief check for gain solution
+  /// @return true, if there is no gain solution, false otherwise
+  virtual bool noGain() const;
+
+  /// @brief check for leakage solution
+  /// @return true, if there is no leakage solution, false otherwise
+  virtual bool noLeakage() const;
+
+  /// @brief check for bandpass solution
+  /// @return true, if there is no bandpass solution, false otherwise
+  virtual bool noBandpass() const;
+
+  /// @brief write all queued updates and flush the underlying data
+  virtual bool flush();
+
+  /// @brief first spectral channel of the bandpass cube
+  /// @return channel corresponding to the rows 0 and 1 of the bandpass cube
+  virtual casacore::uInt bandpassStartChannel() const;
+
+  /// @brief first beam of the bandpass cube
+  /// @return beam corresponding to the plane 0 of the bandpass cube
+  virtual casacore::uInt bandpassStartBeam() const;
+
+protected:
+  /// @brief fill cubes with queued data or via the decorated filler
+  /// @param[in] product calibration product
+  /// @param[in] fillMethod method of the decorated filler
+  /// @param[out] cubes pair of cubes to fill
+  void fill(const TableCalSolutionWriter::Product product, 
+            void (ICalSolutionFiller::*fillMethod)(TableCalSolutionWriter::CubePair &) const,
+            TableCalSolutionWriter::CubePair &cubes) const;
+
+  /// @brief check that solution is absent
+  /// @param[in] product calibration product
+  /// @param[in] checkMethod method of the decorated filler
+  /// @return true, if there is no solution
+  bool absent(const TableCalSolutionWriter::Product product, bool (ICalSolutionFiller::*checkMethod)() const) const;
+
+  /// @brief queue an update and start the background job
+  /// @param[in] product calibration product
+  /// @param[in] cubes values and validity flags to write
+  void write(const TableCalSolutionWriter::Product product, const TableCalSolutionWriter::CubePair &cubes) const;
+
+private:
+  /// @brief decorated filler
+  boost::shared_ptr<ICalSolutionFiller> itsFiller;
+
+  /// @brief write-behind writer
+  TableCalSolutionWriter::ShPtr itsWriter;
+
+  /// @brief solution ID
+  long itsID;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DEFERRED_CAL_SOLUTION_FILLER_H
@@ -0,0 +1,225 @@
+/// @file
+/// @brief assembly of a calibration solution from fragments held by many ranks
+/// @details Solvers distributed by channel and beam end up with a fragment of the solution
+/// on each rank. This class collects the fragments (gains, leakages and bandpass slabs with
+/// validity flags) on every rank and, in a collective call, sends them to one writer rank
+/// which stores them via the bulk setters of the calibration solution accessor. Each rank
+/// sends a single message, so the solution is assembled without element-by-element traffic
+/// and the writer only holds one fragment set of another rank at a time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/calibaccess/DistributedCalSolutionAssembler.h>
+#include <askap/askap/AskapError.h>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] comms communication object
+/// @param[in] writerRank rank which writes the solution
+DistributedCalSolutionAssembler::DistributedCalSolutionAssembler(askapparallel::AskapParallel &comms, int writerRank) :
+      itsComms(comms), itsWriterRank(comms.isParallel() ? writerRank : comms.rank())
+{
+  ASKAPCHECK((writerRank >= 0) && (writerRank < itsComms.nProcs()), "Writer rank "<<writerRank<<
+             " is outside the range of ranks, the number of ranks is "<<itsComms.nProcs());
+}
+
+/// @brief add gains for a number of antennas of one beam
+/// @param[in] beam beam index
+/// @param[in] gains 2 x nAnt matrix with gains (XX and YY) for antennas 0 to nAnt-1
+/// @param[in] validity 2 x nAnt matrix with validity flags
+void DistributedCalSolutionAssembler::addGains(const casacore::uInt beam, const casacore::Matrix<casacore::Complex> &gains,
+                const casacore::Matrix<casacore::Bool> &validity)
+{
+  ASKAPCHECK(gains.nrow() == 2, "Expect 2 polarisations for gains, you have shape="<<gains.shape());
+  ASKAPCHECK(gains.shape() == validity.shape(), "Shapes of gains ("<<gains.shape()<<") and validity flags ("<<
+             validity.shape()<<") are different");
+  add(GAINS, beam, 0u, casacore::Cube<casacore::Complex>(gains.addDegenerate(1)),
+      casacore::Cube<casacore::Bool>(validity.addDegenerate(1)));
+}
+
+/// @brief add leakages for a number of antennas of one beam
+/// @param[in] beam beam index
+/// @param[in] leakages 2 x nAnt matrix with leakages (d12 and d21) for antennas 0 to nAnt-1
+/// @param[in] validity 2 x nAnt matrix with validity flags
+void DistributedCalSolutionAssembler::addLeakages(const casacore::uInt beam, const casacore::Matrix<casacore::Complex> &leakages,
+                const casacore::Matrix<casacore::Bool> &validity)
+{
+  ASKAPCHECK(leakages.nrow() == 2, "Expect 2 polarisations for leakages, you have shape="<<leakages.shape());
+  ASKAPCHECK(leakages.shape() == validity.shape(), "Shapes of leakages ("<<leakages.shape()<<") and validity flags ("<<
+             validity.shape()<<") are different");
+  add(LEAKAGES, beam, 0u, casacore::Cube<casacore::Complex>(leakages.addDegenerate(1)),
+      casacore::Cube<casacore::Bool>(validity.addDegenerate(1)));
+}
+
+/// @brief add bandpasses for a number of antennas of one beam in a range of channels
+/// @param[in] beam beam index
+/// @param[in] startChan first spectral channel
+/// @param[in] bp 2 x nChan x nAnt cube with bandpass gains (XX and YY) for antennas 0 to nAnt-1
+/// @param[in] validity 2 x nChan x nAnt cube with validity flags
+void DistributedCalSolutionAssembler::addBandpasses(const casacore::uInt beam, const casacore::uInt startChan,
+                const casacore::Cube<casacore::Complex> &bp, const casacore::Cube<casacore::Bool> &validity)
+{
+  ASKAPCHECK(bp.nrow() == 2, "Expect 2 polarisations for bandpasses, you have shape="<<bp.shape());
+  ASKAPCHECK(bp.shape() == validity.shape(), "Shapes of bandpasses ("<<bp.shape()<<") and validity flags ("<<
+             validity.shape()<<") are different");
+  add(BANDPASSES, beam, startChan, bp, validity);
+}
+
+/// @brief add a fragment
+/// @param[in] product calibration product
+/// @param[in] beam beam index
+/// @param[in] startChan first channel
+/// @param[in] values values
+/// @param[in] validity validity flags
+void DistributedCalSolutionAssembler::add(const Product product, const casacore::uInt beam, const casacore::uInt startChan,
+                const casacore::Cube<casacore::Complex> &values, const casacore::Cube<casacore::Bool> &validity)
+{
+  itsFragments.push_back(Fragment());
+  Fragment &fragment = itsFragments.back();
+  fragment.itsProduct = product;
+  fragment.itsBeam = beam;
+  fragment.itsStartChan = startChan;
+  // take a contiguous copy, so the caller can reuse its buffers
+  fragment.itsValues = values.copy();
+  fragment.itsValidity = validity.copy();
+}
+
+/// @brief check whether this rank writes the solution
+/// @return true if this rank is the writer
+bool DistributedCalSolutionAssembler::isWriter() const
+{
+  return itsComms.rank() == itsWriterRank;
+}
+
+/// @brief write fragments of all ranks into one solution
+/// @details This method is collective. The accessor is only used on the writer rank and may be
+/// empty on other ranks. The solution is written when the accessor is flushed or destroyed (as 
+/// usual). The typical use on the writer is to obtain the accessor with rwSolution of 
+/// the solution source for the solution ID to be assembled.
+/// @param[in] acc accessor to write the solution to (writer rank only)
+void DistributedCalSolutionAssembler::assemble(const boost::shared_ptr<ICalSolutionAccessor> &acc)
+{
+  LOFAR::BlobString bs;
+  if (!isWriter()) {
+      // all fragments of this rank go in one message
+      bs.resize(0);
+      LOFAR::BlobOBufString bob(bs);
+      LOFAR::BlobOStream out(bob);
+      out.putStart("CalSolutionFragments", 1);
+      out << static_cast<LOFAR::uint64>(itsFragments.size());
+      for (std::vector<Fragment>::const_iterator ci = itsFragments.begin(); ci != itsFragments.end(); ++ci) {
+           serialise(out, *ci);
+      }
+      out.putEnd();
+      itsComms.sendBlob(bs, itsWriterRank);
+      itsFragments.clear();
+      return;
+  }
+  ASKAPCHECK(acc, "An accessor is required on the writer rank to assemble the calibration solution");
+  for (std::vector<Fragment>::const_iterator ci = itsFragments.begin(); ci != itsFragments.end(); ++ci) {
+       write(*ci, *acc);
+  }
+  itsFragments.clear();
+  if (!itsComms.isParallel()) {
+      return;
+  }
+  Fragment fragment;
+  for (int rank = 0; rank < itsComms.nProcs(); ++rank) {
+       if (rank == itsWriterRank) {
+           continue;
+       }
+       bs.resize(0);
+       itsComms.receiveBlob(bs, rank);
+       LOFAR::BlobIBufString bib(bs);
+       LOFAR::BlobIStream in(bib);
+       const int version = in.getStart("CalSolutionFragments");
+       ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the calibration solution fragments sent by rank "<<rank);
+       LOFAR::uint64 nFragments = 0;
+       in >> nFragments;
+       for (LOFAR::uint64 index = 0; index < nFragments; ++index) {
+            deserialise(in, fragment);
+            write(fragment, *acc);
+       }
+       in.getEnd();
+  }
+}
+
+/// @brief write a fragment to the accessor
+/// @param[in] fragment fragment to write
+/// @param[in] acc accessor
+void DistributedCalSolutionAssembler::write(const Fragment &fragment, ICalSolutionAccessor &acc)
+{
+  if (fragment.itsProduct == GAINS) {
+      acc.setGains(fragment.itsBeam, fragment.itsValues.xyPlane(0), fragment.itsValidity.xyPlane(0));
+  } else if (fragment.itsProduct == LEAKAGES) {
+      acc.setLeakages(fragment.itsBeam, fragment.itsValues.xyPlane(0), fragment.itsValidity.xyPlane(0));
+  } else {
+      ASKAPDEBUGASSERT(fragment.itsProduct == BANDPASSES);
+      acc.setBandpasses(fragment.itsBeam, fragment.itsStartChan, fragment.itsValues, fragment.itsValidity);
+  }
+}
+
+/// @brief serialise a fragment
+/// @param[in] os output blob stream
+/// @param[in] fragment fragment to write
+void DistributedCalSolutionAssembler::serialise(LOFAR::BlobOStream &os, const Fragment &fragment)
+{
+  ASKAPDEBUGASSERT(fragment.itsValues.contiguousStorage() && fragment.itsValidity.contiguousStorage());
+  os << static_cast<int>(fragment.itsProduct) << fragment.itsBeam << fragment.itsStartChan;
+  os << static_cast<casacore::uInt>(fragment.itsValues.nrow()) << static_cast<casacore::uInt>(fragment.itsValues.ncolumn()) <<
+        static_cast<casacore::uInt>(fragment.itsValues.nplane());
+  // std::complex is guaranteed to be laid out as two adjacent floats
+  os.put(reinterpret_cast<const float*>(fragment.itsValues.data()), 2 * fragment.itsValues.nelements());
+  os.put(fragment.itsValidity.data(), fragment.itsValidity.nelements());
+}
+
+/// @brief read a serialised fragment
+/// @param[in] is input blob stream
+/// @param[out] fragment fragment to fill
+void DistributedCalSolutionAssembler::deserialise(LOFAR::BlobIStream &is, Fragment &fragment)
+{
+  int product = 0;
+  casacore::uInt nRow = 0, nColumn = 0, nPlane = 0;
+  is >> product >> fragment.itsBeam >> fragment.itsStartChan >> nRow >> nColumn >> nPlane;
+  ASKAPCHECK((product >= GAINS) && (product <= BANDPASSES), "Unknown calibration product "<<product<<
+             " in the serialised fragment");
+  fragment.itsProduct = Product(product);
+  fragment.itsValues.resize(nRow, nColumn, nPlane);
+  fragment.itsValidity.resize(nRow, nColumn, nPlane);
+  is.get(reinterpret_cast<float*>(fragment.itsValues.data()), 2 * fragment.itsValues.nelements());
+  is.get(fragment.itsValidity.data(), fragment.itsValidity.nelements());
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,178 @@
+/// @file
+/// @brief assembly of a calibration solution from fragments held by many ranks
+/// @details Solvers distributed by channel and beam end up with a fragment of the solution
+/// on each rank. This class collects the fragments (gains, leakages and bandpass slabs with
+/// validity flags) on every rank and, in a collective call, sends them to one writer rank
+/// which stores them via the bulk setters of the calibration solution accessor. Each rank
+/// sends a single message, so the solution is assembled without element-by-element traffic
+/// and the writer only holds one fragment set of another rank at a time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_DISTRIBUTED_CAL_SOLUTION_ASSEMBLER_H
+#define ASKAP_ACCESSORS_DISTRIBUTED_CAL_SOLUTION_ASSEMBLER_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// own includes
+#include <askap/calibaccess/ICalSolutionAccessor.h>
+#include <askap/askapparallel/AskapParallel.h>
+
+// LOFAR includes
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief assembly of a calibration solution from fragments held by many ranks
+/// @details Fragments are added on any rank with addGains, addLeakages and addBandpasses
+/// (the layouts are those of the bulk setters of ICalSolutionAccessor). The assemble method
+/// is collective for all ranks of the communicator: every rank except the writer sends its 
+/// fragments in one message, the writer applies its own fragments and then those received
+/// from other ranks (in the order of ranks) to the given accessor. Fragments are cleared
+/// afterwards, so the object can be reused for another solution. Fragments are expected to be
+/// disjoint, overlapping values are overwritten in the order fragments are applied. If the 
+/// application is not run in parallel, fragments are just written to the accessor.
+/// @ingroup calibaccess
+class DistributedCalSolutionAssembler : private boost::noncopyable
+{
+public:
+  /// @brief constructor
+  /// @param[in] comms communication object
+  /// @param[in] writerRank rank which writes the solution
+  explicit DistributedCalSolutionAssembler(askapparallel::AskapParallel &comms, int writerRank = 0);
+
+  /// @brief add gains for a number of antennas of one beam
+  /// @param[in] beam beam index
+  /// @param[in] gains 2 x nAnt matrix with gains (XX and YY) for antennas 0 to nAnt-1
+  /// @param[in] validity 2 x nAnt matrix with validity flags
+  void addGains(const casacore::uInt beam, const casacore::Matrix<casacore::Complex> &gains,
+                const casacore::Matrix<casacore::Bool> &validity);
+
+  /// @brief add leakages for a number of antennas of one beam
+  /// @param[in] beam beam index
+  /// @param[in] leakages 2 x nAnt matrix with leakages (d12 and d21) for antennas 0 to nAnt-1
+  /// @param[in] validity 2 x nAnt matrix with validity flags
+  void addLeakages(const casacore::uInt beam, const casacore::Matrix<casacore::Complex> &leakages,
+                   const casacore::Matrix<casacore::Bool> &validity);
+
+  /// @brief add bandpasses for a number of antennas of one beam in a range of channels
+  /// @param[in] beam beam index
+  /// @param[in] startChan first spectral channel
+  /// @param[in] bp 2 x nChan x nAnt cube with bandpass gains (XX and YY) for antennas 0 to nAnt-1
+  /// @param[in] validity 2 x nChan x nAnt cube with validity flags
+  void addBandpasses(const casacore::uInt beam, const casacore::uInt startChan,
+                     const casacore::Cube<casacore::Complex> &bp, const casacore::Cube<casacore::Bool> &validity);
+
+  /// @brief number of fragments held by this rank
+  /// @return number of fragments added since the last assemble call
+  inline size_t nFragments() const { return itsFragments.size(); }
+
+  /// @brief check whether this rank writes the solution
+  /// @return true if this rank is the writer
+  bool isWriter() const;
+
+  /// @brief write fragments of all ranks into one solution
+  /// @details This method is collective. The accessor is only used on the writer rank and may be
+  /// empty on other ranks. The solution is written when the accessor is flushed or destroyed (as 
+  /// usual). The typical use on the writer is to obtain the accessor with rwSolution of 
+  /// the solution source for the solution ID to be assembled.
+  /// @param[in] acc accessor to write the solution to (writer rank only)
+  void assemble(const boost::shared_ptr<ICalSolutionAccessor> &acc);
+
+protected:
+  /// @brief calibration product of a fragment
+  enum Product {
+     GAINS = 0,
+     LEAKAGES,
+     BANDPASSES
+  };
+
+  /// @brief fragment of the solution
+  struct Fragment {
+     /// @brief calibration product
+     Product itsProduct;
+     /// @brief beam index
+     casacore::uInt itsBeam;
+     /// @brief first channel (bandpasses only)
+     casacore::uInt itsStartChan;
+     /// @brief values, 2 x nAnt x 1 for gains and leakages and 2 x nChan x nAnt for bandpasses
+     casacore::Cube<casacore::Complex> itsValues;
+     /// @brief validity flags of the same shape as values
+     casacore::Cube<casacore::Bool> itsValidity;
+  };
+
+  /// @brief add a fragment
+  /// @param[in] product calibration product
+  /// @param[in] beam beam index
+  /// @param[in] startChan first channel
+  /// @param[in] values values
+  /// @param[in] validity validity flags
+  void add(const Product product, const casacore::uInt beam, const casacore::uInt startChan,
+           const casacore::Cube<casacore::Complex> &values, const casacore::Cube<casacore::Bool> &validity);
+
+  /// @brief write a fragment to the accessor
+  /// @param[in] fragment fragment to write
+  /// @param[in] acc accessor
+  static void write(const Fragment &fragment, ICalSolutionAccessor &acc);
+
+  /// @brief serialise a fragment
+  /// @param[in] os output blob stream
+  /// @param[in] fragment fragment to write
+  static void serialise(LOFAR::BlobOStream &os, const Fragment &fragment);
+
+  /// @brief read a serialised fragment
+  /// @param[in] is input blob stream
+  /// @param[out] fragment fragment to fill
+  static void deserialise(LOFAR::BlobIStream &is, Fragment &fragment);
+
+private:
+  /// @brief communication object
+  askapparallel::AskapParallel &itsComms;
+
+  /// @brief rank which writes the solution
+  const int itsWriterRank;
+
+  /// @brief fragments held by this rank
+  std::vector<Fragment> itsFragments;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DISTRIBUTED_CAL_SOLUTION_ASSEMBLER_H
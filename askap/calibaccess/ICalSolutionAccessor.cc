@@ -32,10 +32,40 @@
 #include <askap/calibaccess/ICalSolutionAccessor.h>
 #include <askap/askap/AskapError.h>
 
+// std includes
+#include <string>
+
 namespace askap {
 
 namespace accessors {
 
+namespace {
+
+/// @brief check the shape of the bulk values and validity flags
+/// @param[in] values array with values
+/// @param[in] validity array with validity flags
+/// @param[in] nRow expected length of the first axis
+/// @param[in] what name of the calibration product for error messages
+void checkBlockShape(const casacore::Array<casacore::Complex> &values, const casacore::Array<casacore::Bool> &validity,
+                     const casacore::uInt nRow, const std::string &what)
+{
+  ASKAPCHECK(values.shape() == validity.shape(), "Shapes of "<<what<<" ("<<values.shape()<<
+             ") and validity flags ("<<validity.shape()<<") are different");
+  ASKAPCHECK((values.ndim() > 0) && (casacore::uInt(values.shape()[0]) == nRow), "Expect "<<nRow<<" polarisations (first axis) for "<<what<<
+             ", you have shape="<<values.shape());
+}
+
+/// @brief obtain an array with contiguous storage
+/// @param[in] in input array
+/// @return reference to the input array or its contiguous copy, if necessary
+template<typename T>
+casacore::Array<T> contiguous(const casacore::Array<T> &in)
+{
+  return in.contiguousStorage() ? in : in.copy();
+}
+
+} // anonymous namespace
+
 /// @brief set a single element of the Jones matrix (i.e gains or leakages)
 /// @details This method simplifies writing both gains and leakages solution. It reads the current
 /// gains and leakages and then replaces one element with the given value setting the validity flag.
@@ -115,6 +145,176 @@ void ICalSolutionAccessor::setBandpassElement(casacore::uInt ant, casacore::uInt
   setBandpassElement(JonesIndex(ant, beam), stokes, chan, elem);
 }
 
+/// @brief set gains for all antennas of one beam
+/// @details This method is equivalent to calling setGain for antennas 0 to nAnt-1 of the given
+/// beam, but implementations with direct access to the solutions write the whole block at once.
+/// @param[in] beam beam index
+/// @param[in] gains 2 x nAnt matrix with gains, the first row is XX and the second is YY
+/// @param[in] validity 2 x nAnt matrix with validity flags
+void ICalSolutionAccessor::setGains(const casacore::uInt beam, const casacore::Matrix<casacore::Complex> &gains,
+                                    const casacore::Matrix<casacore::Bool> &validity)
+{
+  checkBlockShape(gains, validity, 2, "gains");
+  const casacore::Matrix<casacore::Complex> values = contiguous(gains);
+  const casacore::Matrix<casacore::Bool> flags = contiguous(validity);
+  writeGainBlock(beam, values.ncolumn(), values.data(), flags.data());
+}
+
+/// @brief set gains for all antennas and beams
+/// @details This is a version of setGains covering a number of beams (indices 0 to nBeam-1),
+/// the layout is the same with the beam axis added at the end.
+/// @param[in] gains 2 x nAnt x nBeam cube with gains
+/// @param[in] validity 2 x nAnt x nBeam cube with validity flags
+void ICalSolutionAccessor::setGains(const casacore::Cube<casacore::Complex> &gains, const casacore::Cube<casacore::Bool> &validity)
+{
+  checkBlockShape(gains, validity, 2, "gains");
+  const casacore::Cube<casacore::Complex> values = contiguous(gains);
+  const casacore::Cube<casacore::Bool> flags = contiguous(validity);
+  const size_t blockSize = 2 * size_t(values.ncolumn());
+  for (casacore::uInt beam = 0; beam < values.nplane(); ++beam) {
+       writeGainBlock(beam, values.ncolumn(), values.data() + blockSize * beam, flags.data() + blockSize * beam);
+  }
+}
+
+/// @brief set leakages for all antennas of one beam
+/// @details This method is equivalent to calling setLeakage for antennas 0 to nAnt-1 of the given beam.
+/// @param[in] beam beam index
+/// @param[in] leakages 2 x nAnt matrix with leakages, the first row is XY (d12) and the second is YX (d21)
+/// @param[in] validity 2 x nAnt matrix with validity flags
+void ICalSolutionAccessor::setLeakages(const casacore::uInt beam, const casacore::Matrix<casacore::Complex> &leakages,
+                                       const casacore::Matrix<casacore::Bool> &validity)
+{
+  checkBlockShape(leakages, validity, 2, "leakages");
+  const casacore::Matrix<casacore::Complex> values = contiguous(leakages);
+  const casacore::Matrix<casacore::Bool> flags = contiguous(validity);
+  writeLeakageBlock(beam, values.ncolumn(), values.data(), flags.data());
+}
+
+/// @brief set leakages for all antennas and beams
+/// @details This is a version of setLeakages covering a number of beams (indices 0 to nBeam-1),
+/// the layout is the same with the beam axis added at the end.
+/// @param[in] leakages 2 x nAnt x nBeam cube with leakages
+/// @param[in] validity 2 x nAnt x nBeam cube with validity flags
+void ICalSolutionAccessor::setLeakages(const casacore::Cube<casacore::Complex> &leakages, const casacore::Cube<casacore::Bool> &validity)
+{
+  checkBlockShape(leakages, validity, 2, "leakages");
+  const casacore::Cube<casacore::Complex> values = contiguous(leakages);
+  const casacore::Cube<casacore::Bool> flags = contiguous(validity);
+  const size_t blockSize = 2 * size_t(values.ncolumn());
+  for (casacore::uInt beam = 0; beam < values.nplane(); ++beam) {
+       writeLeakageBlock(beam, values.ncolumn(), values.data() + blockSize * beam, flags.data() + blockSize * beam);
+  }
+}
+
+/// @brief set bandpasses for all antennas of one beam in a range of channels
+/// @details This method is equivalent to calling setBandpass for antennas 0 to nAnt-1 of the given
+/// beam and channels startChan to startChan+nChan-1.
+/// @param[in] beam beam index
+/// @param[in] startChan first spectral channel
+/// @param[in] bp 2 x nChan x nAnt cube with bandpass gains, the first row is XX and the second is YY
+/// @param[in] validity 2 x nChan x nAnt cube with validity flags
+void ICalSolutionAccessor::setBandpasses(const casacore::uInt beam, const casacore::uInt startChan, 
+                                         const casacore::Cube<casacore::Complex> &bp, const casacore::Cube<casacore::Bool> &validity)
+{
+  checkBlockShape(bp, validity, 2, "bandpasses");
+  ASKAPCHECK(startChan + bp.ncolumn() <= 16416, "Channel number is supposed to be less than 16416");
+  const casacore::Cube<casacore::Complex> values = contiguous(bp);
+  const casacore::Cube<casacore::Bool> flags = contiguous(validity);
+  writeBandpassBlock(beam, values.nplane(), startChan, values.ncolumn(), values.data(), flags.data());
+}
+
+/// @brief set bandpasses for all antennas and beams in a range of channels
+/// @details This is a version of setBandpasses covering a number of beams (indices 0 to nBeam-1),
+/// the layout is the same with the beam axis added at the end.
+/// @param[in] startChan first spectral channel
+/// @param[in] bp 2 x nChan x nAnt x nBeam array with bandpass gains
+/// @param[in] validity 2 x nChan x nAnt x nBeam array with validity flags
+void ICalSolutionAccessor::setBandpasses(const casacore::uInt startChan, const casacore::Array<casacore::Complex> &bp,
+                                         const casacore::Array<casacore::Bool> &validity)
+{
+  ASKAPCHECK(bp.ndim() == 4, "Expect 4-dimensional array of bandpasses, you have shape="<<bp.shape());
+  checkBlockShape(bp, validity, 2, "bandpasses");
+  const casacore::uInt nChan = bp.shape()[1];
+  const casacore::uInt nAnt = bp.shape()[2];
+  ASKAPCHECK(startChan + nChan <= 16416, "Channel number is supposed to be less than 16416");
+  const casacore::Array<casacore::Complex> values = contiguous(bp);
+  const casacore::Array<casacore::Bool> flags = contiguous(validity);
+  const size_t blockSize = 2 * size_t(nChan) * nAnt;
+  for (casacore::uInt beam = 0; beam < casacore::uInt(bp.shape()[3]); ++beam) {
+       writeBandpassBlock(beam, nAnt, startChan, nChan, values.data() + blockSize * beam, flags.data() + blockSize * beam);
+  }
+}
+
+/// @brief set bandpasses given in the parametric form
+/// @details The default implementation evaluates the model for every channel, antenna and
+/// beam and writes the full resolution bandpass. Implementations able to store the model
+/// itself (which is much more compact) should override this method.
+/// @param[in] model parametric bandpass
+void ICalSolutionAccessor::setBandpassModel(const ParametricBandpass &model)
+{
+  // 2 x nChan x nAnt block for one beam, the layout of setBandpasses
+  casacore::Cube<casacore::Complex> values(2, model.nChan(), model.nAnt());
+  casacore::Cube<casacore::Bool> flags(2, model.nChan(), model.nAnt());
+  for (casacore::uInt beam = 0; beam < model.nBeam(); ++beam) {
+       for (casacore::uInt ant = 0; ant < model.nAnt(); ++ant) {
+            model.evaluate(ant, beam, 0, model.nChan(), &values(0, 0, ant), &flags(0, 0, ant));
+       }
+       writeBandpassBlock(beam, model.nAnt(), 0, model.nChan(), values.data(), flags.data());
+  }
+}
+
+/// @brief write gains for all antennas of one beam
+/// @details This method does the actual work for setGains. The default implementation
+/// calls setGain for each antenna. Implementations with direct access to the solutions
+/// should override it.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] gains pointer to 2 * nAnt gains in the order of setGains
+/// @param[in] validity pointer to 2 * nAnt validity flags
+void ICalSolutionAccessor::writeGainBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                                          const casacore::Complex *gains, const casacore::Bool *validity)
+{
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant, gains += 2, validity += 2) {
+       setGain(JonesIndex(ant, beam), JonesJTerm(gains[0], validity[0], gains[1], validity[1]));
+  }
+}
+
+/// @brief write leakages for all antennas of one beam
+/// @details This method does the actual work for setLeakages. The default implementation
+/// calls setLeakage for each antenna.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] leakages pointer to 2 * nAnt leakages in the order of setLeakages
+/// @param[in] validity pointer to 2 * nAnt validity flags
+void ICalSolutionAccessor::writeLeakageBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                                             const casacore::Complex *leakages, const casacore::Bool *validity)
+{
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant, leakages += 2, validity += 2) {
+       setLeakage(JonesIndex(ant, beam), JonesDTerm(leakages[0], validity[0], leakages[1], validity[1]));
+  }
+}
+
+/// @brief write bandpasses for all antennas of one beam in a range of channels
+/// @details This method does the actual work for setBandpasses. The default implementation
+/// calls setBandpass for each antenna and channel.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[in] bp pointer to 2 * nChan * nAnt bandpass gains in the order of setBandpasses
+/// @param[in] validity pointer to 2 * nChan * nAnt validity flags
+void ICalSolutionAccessor::writeBandpassBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::uInt startChan, const casacore::uInt nChan, const casacore::Complex *bp,
+                const casacore::Bool *validity)
+{
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const JonesIndex index(ant, beam);
+       for (casacore::uInt chan = 0; chan < nChan; ++chan, bp += 2, validity += 2) {
+            setBandpass(index, JonesJTerm(bp[0], validity[0], bp[1], validity[1]), startChan + chan);
+       }
+  }
+}
+
 } // namespace accessors
 
 } // namespace askap
@@ -34,6 +34,7 @@
 
 // own includes
 #include <askap/calibaccess/ICalSolutionConstAccessor.h>
+#include <askap/calibaccess/ParametricBandpass.h>
 
 // casa includes
 #include <casacore/measures/Measures/Stokes.h>
@@ -123,6 +124,63 @@ struct ICalSolutionAccessor : virtual public ICalSolutionConstAccessor {
    void setBandpassElement(const casacore::uInt ant, const casacore::uInt beam, const casacore::Stokes::StokesTypes stokes,
                            const casacore::uInt chan, const casacore::Complex &elem);
 
+   /// @brief set gains for all antennas of one beam
+   /// @details This method is equivalent to calling setGain for antennas 0 to nAnt-1 of the given
+   /// beam, but implementations with direct access to the solutions write the whole block at once.
+   /// @param[in] beam beam index
+   /// @param[in] gains 2 x nAnt matrix with gains, the first row is XX and the second is YY
+   /// @param[in] validity 2 x nAnt matrix with validity flags
+   void setGains(const casacore::uInt beam, const casacore::Matrix<casacore::Complex> &gains,
+                 const casacore::Matrix<casacore::Bool> &validity);
+
+   /// @brief set gains for all antennas and beams
+   /// @details This is a version of setGains covering a number of beams (indices 0 to nBeam-1),
+   /// the layout is the same with the beam axis added at the end.
+   /// @param[in] gains 2 x nAnt x nBeam cube with gains
+   /// @param[in] validity 2 x nAnt x nBeam cube with validity flags
+   void setGains(const casacore::Cube<casacore::Complex> &gains, const casacore::Cube<casacore::Bool> &validity);
+
+   /// @brief set leakages for all antennas of one beam
+   /// @details This method is equivalent to calling setLeakage for antennas 0 to nAnt-1 of the given beam.
+   /// @param[in] beam beam index
+   /// @param[in] leakages 2 x nAnt matrix with leakages, the first row is XY (d12) and the second is YX (d21)
+   /// @param[in] validity 2 x nAnt matrix with validity flags
+   void setLeakages(const casacore::uInt beam, const casacore::Matrix<casacore::Complex> &leakages,
+                    const casacore::Matrix<casacore::Bool> &validity);
+
+   /// @brief set leakages for all antennas and beams
+   /// @details This is a version of setLeakages covering a number of beams (indices 0 to nBeam-1),
+   /// the layout is the same with the beam axis added at the end.
+   /// @param[in] leakages 2 x nAnt x nBeam cube with leakages
+   /// @param[in] validity 2 x nAnt x nBeam cube with validity flags
+   void setLeakages(const casacore::Cube<casacore::Complex> &leakages, const casacore::Cube<casacore::Bool> &validity);
+
+   /// @brief set bandpasses for all antennas of one beam in a range of channels
+   /// @details This method is equivalent to calling setBandpass for antennas 0 to nAnt-1 of the given
+   /// beam and channels startChan to startChan+nChan-1.
+   /// @param[in] beam beam index
+   /// @param[in] startChan first spectral channel
+   /// @param[in] bp 2 x nChan x nAnt cube with bandpass gains, the first row is XX and the second is YY
+   /// @param[in] validity 2 x nChan x nAnt cube with validity flags
+   void setBandpasses(const casacore::uInt beam, const casacore::uInt startChan, const casacore::Cube<casacore::Complex> &bp,
+                      const casacore::Cube<casacore::Bool> &validity);
+
+   /// @brief set bandpasses for all antennas and beams in a range of channels
+   /// @details This is a version of setBandpasses covering a number of beams (indices 0 to nBeam-1),
+   /// the layout is the same with the beam axis added at the end.
+   /// @param[in] startChan first spectral channel
+   /// @param[in] bp 2 x nChan x nAnt x nBeam array with bandpass gains
+   /// @param[in] validity 2 x nChan x nAnt x nBeam array with validity flags
+   void setBandpasses(const casacore::uInt startChan, const casacore::Array<casacore::Complex> &bp,
+                      const casacore::Array<casacore::Bool> &validity);
+
+   /// @brief set bandpasses given in the parametric form
+   /// @details The default implementation evaluates the model for every channel, antenna and
+   /// beam and writes the full resolution bandpass. Implementations able to store the model
+   /// itself (which is much more compact) should override this method.
+   /// @param[in] model parametric bandpass
+   virtual void setBandpassModel(const ParametricBandpass &model);
+
    /// @brief optional flush for the Filler associated with this accessor
 
    virtual bool flushFiller() {return false;}
@@ -131,6 +189,39 @@ struct ICalSolutionAccessor : virtual public ICalSolutionConstAccessor {
    // @brief shared pointer definition
    typedef boost::shared_ptr<ICalSolutionAccessor> ShPtr;
 
+protected:
+   /// @brief write gains for all antennas of one beam
+   /// @details This method does the actual work for setGains. The default implementation
+   /// calls setGain for each antenna. Implementations with direct access to the solutions
+   /// should override it.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] gains pointer to 2 * nAnt gains in the order of setGains
+   /// @param[in] validity pointer to 2 * nAnt validity flags
+   virtual void writeGainBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::Complex *gains,
+                               const casacore::Bool *validity);
+
+   /// @brief write leakages for all antennas of one beam
+   /// @details This method does the actual work for setLeakages. The default implementation
+   /// calls setLeakage for each antenna.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] leakages pointer to 2 * nAnt leakages in the order of setLeakages
+   /// @param[in] validity pointer to 2 * nAnt validity flags
+   virtual void writeLeakageBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::Complex *leakages,
+                                  const casacore::Bool *validity);
+
+   /// @brief write bandpasses for all antennas of one beam in a range of channels
+   /// @details This method does the actual work for setBandpasses. The default implementation
+   /// calls setBandpass for each antenna and channel.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[in] bp pointer to 2 * nChan * nAnt bandpass gains in the order of setBandpasses
+   /// @param[in] validity pointer to 2 * nChan * nAnt validity flags
+   virtual void writeBandpassBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                                   const casacore::uInt nChan, const casacore::Complex *bp, const casacore::Bool *validity);
 };
 
 } // namespace accessors
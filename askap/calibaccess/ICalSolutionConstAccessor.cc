@@ -31,6 +31,7 @@
 /// Based on the original version of this interface by Ben Humphreys <ben.humphreys@csiro.au>
 
 #include <askap/calibaccess/ICalSolutionConstAccessor.h>
+#include <askap/calibaccess/CalibrationStatistics.h>
 #include <askap/askap/AskapError.h>
 
 namespace askap {
@@ -127,16 +128,14 @@ bool ICalSolutionConstAccessor::jonesAllValid(const casacore::uInt ant, const ca
 /// valid, false otherwise
 bool ICalSolutionConstAccessor::jonesAllValid(const JonesIndex &index, const casacore::uInt chan) const
 {
-  const JonesJTerm gTerm = gain(index);
-  const JonesJTerm bpTerm = bandpass(index,chan);
-  const JonesDTerm dTerm = leakage(index);
-
-  return gTerm.g1IsValid() && gTerm.g2IsValid() && bpTerm.g1IsValid() && bpTerm.g2IsValid() &&
-         dTerm.d12IsValid() && dTerm.d21IsValid();
+  ASKAPCHECK((index.antenna() >= 0) && (index.beam() >= 0), "Antenna and beam indices are supposed to be non-negative, you have "<<
+             index.antenna()<<" and "<<index.beam());
+  return allValidBlock(casacore::uInt(index.beam()), casacore::uInt(index.antenna()), 1u, chan, 1u);
 }
 
 std::pair<casa::SquareMatrix<casa::Complex, 2>, bool> ICalSolutionConstAccessor::jonesAndValidity(const JonesIndex &index, const casa::uInt chan) const
 {
+  CalibrationStatistics::instance().jonesCall();
   const JonesJTerm gTerm = gain(index);
   const JonesJTerm bpTerm = bandpass(index,chan);
   const JonesDTerm dTerm = leakage(index);
@@ -177,5 +176,168 @@ std::pair<casa::SquareMatrix<casa::Complex, 2>, bool> ICalSolutionConstAccessor:
     return jonesAndValidity(JonesIndex(ant,beam),chan);
 }
 
+/// @brief obtain Jones matrices for all antennas of one beam in a range of channels
+/// @details This method returns the same matrices and validity flags as jonesAndValidity
+/// (invalid matrices are set to identity), but for a block of antennas and channels in
+/// one call. Matrix elements are stored contiguously in the order J00, J01, J10, J11,
+/// followed by the next channel, so the result can be processed by straight loops.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones 4 x nChan x nAnt cube with matrix elements (resized as required)
+/// @param[out] validity nChan x nAnt matrix with validity flags (resized as required)
+void ICalSolutionConstAccessor::jonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::uInt startChan, const casacore::uInt nChan, 
+                casacore::Cube<casacore::Complex> &jones, casacore::Matrix<casacore::Bool> &validity) const
+{
+  ASKAPCHECK(startChan + nChan <= 16416, "Channel number is supposed to be less than 16416");
+  jones.resize(4, nChan, nAnt);
+  validity.resize(nChan, nAnt);
+  ASKAPDEBUGASSERT(jones.contiguousStorage() && validity.contiguousStorage());
+  CalibrationStatistics::instance().jonesBlockCall(casacore::uInt64(nChan) * nAnt);
+  fillJonesBlock(beam, nAnt, startChan, nChan, jones.data(), validity.data());
+}
+
+/// @brief obtain Jones matrices for all antennas and beams in a range of channels
+/// @details This is a version of jonesBlock covering a number of beams, the layout
+/// is the same with the beam axis added at the end.
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] nBeam number of beams (indices 0 to nBeam-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones 4 x nChan x nAnt x nBeam array with matrix elements (resized as required)
+/// @param[out] validity nChan x nAnt x nBeam cube with validity flags (resized as required)
+void ICalSolutionConstAccessor::jonesBlock(const casacore::uInt nAnt, const casacore::uInt nBeam, 
+                const casacore::uInt startChan, const casacore::uInt nChan, 
+                casacore::Array<casacore::Complex> &jones, casacore::Cube<casacore::Bool> &validity) const
+{
+  ASKAPCHECK(startChan + nChan <= 16416, "Channel number is supposed to be less than 16416");
+  jones.resize(casacore::IPosition(4, 4, nChan, nAnt, nBeam));
+  validity.resize(nChan, nAnt, nBeam);
+  ASKAPDEBUGASSERT(jones.contiguousStorage() && validity.contiguousStorage());
+  CalibrationStatistics::instance().jonesBlockCall(casacore::uInt64(nChan) * nAnt * nBeam);
+  const size_t blockSize = size_t(nChan) * nAnt;
+  for (casacore::uInt beam = 0; beam < nBeam; ++beam) {
+       fillJonesBlock(beam, nAnt, startChan, nChan, jones.data() + 4 * blockSize * beam, 
+                      validity.data() + blockSize * beam);
+  }
+}
+
+/// @brief check validity of all Jones matrices for all antennas of one beam in a range of channels
+/// @details This is a bulk version of jonesAllValid, it returns true only if gains, leakages
+/// and bandpasses are valid for both polarisations, all antennas and all channels of the block.
+/// Implementations keeping validity flags in memory can do it much faster than element by element.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @return true, if all matrices returned by jonesBlock called with the same parameters are
+/// composed of valid constituents
+bool ICalSolutionConstAccessor::jonesBlockAllValid(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+  ASKAPCHECK(startChan + nChan <= 16416, "Channel number is supposed to be less than 16416");
+  return allValidBlock(beam, 0u, nAnt, startChan, nChan);
+}
+
+/// @brief check validity of all constituents for a block of antennas and channels
+/// @details This method does the actual work for jonesAllValid and jonesBlockAllValid.
+/// The default implementation calls gain and leakage once per antenna and bandpass for each
+/// channel, stopping at the first invalid element. Implementations with direct access to the
+/// validity flags should override it.
+/// @param[in] beam beam index
+/// @param[in] startAnt first antenna
+/// @param[in] nAnt number of antennas
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @return true, if gains, leakages and bandpasses are valid for the whole block
+bool ICalSolutionConstAccessor::allValidBlock(const casacore::uInt beam, const casacore::uInt startAnt, 
+                const casacore::uInt nAnt, const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+  for (casacore::uInt ant = startAnt; ant < startAnt + nAnt; ++ant) {
+       const JonesIndex index(ant, beam);
+       const JonesJTerm gTerm = gain(index);
+       const JonesDTerm dTerm = leakage(index);
+       if (!gTerm.g1IsValid() || !gTerm.g2IsValid() || !dTerm.d12IsValid() || !dTerm.d21IsValid()) {
+           return false;
+       }
+       for (casacore::uInt chan = startChan; chan < startChan + nChan; ++chan) {
+            const JonesJTerm bpTerm = bandpass(index, chan);
+            if (!bpTerm.g1IsValid() || !bpTerm.g2IsValid()) {
+                return false;
+            }
+       }
+  }
+  return true;
+}
+
+/// @brief fill Jones matrices for all antennas of one beam in a range of channels
+/// @details This method does the actual work for jonesBlock. The default implementation
+/// obtains gains and leakages once per antenna and calls bandpass for each channel. 
+/// Implementations with direct access to the solutions should override it.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+/// @param[out] validity pointer to nChan * nAnt validity flags to fill
+void ICalSolutionConstAccessor::fillJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::uInt startChan, const casacore::uInt nChan, casacore::Complex *jones,
+                casacore::Bool *validity) const
+{
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const JonesIndex index(ant, beam);
+       const JonesJTerm gTerm = gain(index);
+       const JonesDTerm dTerm = leakage(index);
+       for (casacore::uInt chan = 0; chan < nChan; ++chan, jones += 4, ++validity) {
+            *validity = composeJones(gTerm, bandpass(index, startChan + chan), dTerm, jones);
+       }
+  }
+}
+
+/// @brief compose a Jones matrix from its constituents
+/// @details This helper implements the logic of jonesAndValidity for given gain,
+/// bandpass and leakage terms, so the bulk methods give identical results.
+/// @param[in] gTerm gains
+/// @param[in] bpTerm bandpass for the channel of interest
+/// @param[in] dTerm leakages
+/// @param[out] jones pointer to 4 elements to fill in the order J00, J01, J10, J11
+/// @return validity flag (the identity matrix is written if the result is not valid)
+bool ICalSolutionConstAccessor::composeJones(const JonesJTerm &gTerm, const JonesJTerm &bpTerm, 
+                                             const JonesDTerm &dTerm, casacore::Complex *jones)
+{
+  const bool leakageValid = dTerm.d12IsValid() && dTerm.d21IsValid();
+  // see jonesAndValidity for the discussion of the validity logic
+  const bool valid = (gTerm.g1IsValid() && gTerm.g2IsValid()) || leakageValid ||
+                     (bpTerm.g1IsValid() && bpTerm.g2IsValid());
+  if (!valid) {
+      jones[0] = jones[3] = casacore::Complex(1., 0.);
+      jones[1] = jones[2] = casacore::Complex(0., 0.);
+      return false;
+  }
+  casacore::Complex g1 = gTerm.g1IsValid() ? gTerm.g1() : casacore::Complex(1., 0.);
+  casacore::Complex g2 = gTerm.g2IsValid() ? gTerm.g2() : casacore::Complex(1., 0.);
+  casacore::Complex j01(0., 0.);
+  casacore::Complex j10(0., 0.);
+  if (leakageValid) {
+      j01 = dTerm.d12() * g1;
+      j10 = -dTerm.d21() * g2;
+  }
+  if (bpTerm.g1IsValid()) {
+      g1 *= bpTerm.g1();
+      j10 *= bpTerm.g1();
+  }
+  if (bpTerm.g2IsValid()) {
+      j01 *= bpTerm.g2();
+      g2 *= bpTerm.g2();
+  }
+  jones[0] = g1;
+  jones[1] = j01;
+  jones[2] = j10;
+  jones[3] = g2;
+  return true;
+}
+
 } // namespace accessors
 } // namespace askap
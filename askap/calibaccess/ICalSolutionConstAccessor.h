@@ -37,6 +37,8 @@
 #include <casacore/casa/aipstype.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Array.h>
 #include <casacore/scimath/Mathematics/SquareMatrix.h>
 
 // boost includes
@@ -171,8 +173,88 @@ struct ICalSolutionConstAccessor {
        const::casa::uInt beam, const casa::uInt chan) const;
 
 
+   /// @brief obtain Jones matrices for all antennas of one beam in a range of channels
+   /// @details This method returns the same matrices and validity flags as jonesAndValidity
+   /// (invalid matrices are set to identity), but for a block of antennas and channels in
+   /// one call. Matrix elements are stored contiguously in the order J00, J01, J10, J11,
+   /// followed by the next channel, so the result can be processed by straight loops.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones 4 x nChan x nAnt cube with matrix elements (resized as required)
+   /// @param[out] validity nChan x nAnt matrix with validity flags (resized as required)
+   void jonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                   const casacore::uInt nChan, casacore::Cube<casacore::Complex> &jones,
+                   casacore::Matrix<casacore::Bool> &validity) const;
+
+   /// @brief obtain Jones matrices for all antennas and beams in a range of channels
+   /// @details This is a version of jonesBlock covering a number of beams, the layout
+   /// is the same with the beam axis added at the end.
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] nBeam number of beams (indices 0 to nBeam-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones 4 x nChan x nAnt x nBeam array with matrix elements (resized as required)
+   /// @param[out] validity nChan x nAnt x nBeam cube with validity flags (resized as required)
+   void jonesBlock(const casacore::uInt nAnt, const casacore::uInt nBeam, const casacore::uInt startChan,
+                   const casacore::uInt nChan, casacore::Array<casacore::Complex> &jones,
+                   casacore::Cube<casacore::Bool> &validity) const;
+
+   /// @brief check validity of all Jones matrices for all antennas of one beam in a range of channels
+   /// @details This is a bulk version of jonesAllValid, it returns true only if gains, leakages
+   /// and bandpasses are valid for both polarisations, all antennas and all channels of the block.
+   /// Implementations keeping validity flags in memory can do it much faster than element by element.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @return true, if all matrices returned by jonesBlock called with the same parameters are
+   /// composed of valid constituents
+   bool jonesBlockAllValid(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                   const casacore::uInt nChan) const;
+
    /// @brief shared pointer definition
    typedef boost::shared_ptr<ICalSolutionConstAccessor> ShPtr;
+
+protected:
+   /// @brief check validity of all constituents for a block of antennas and channels
+   /// @details This method does the actual work for jonesAllValid and jonesBlockAllValid.
+   /// The default implementation calls gain and leakage once per antenna and bandpass for each
+   /// channel, stopping at the first invalid element. Implementations with direct access to the
+   /// validity flags should override it.
+   /// @param[in] beam beam index
+   /// @param[in] startAnt first antenna
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @return true, if gains, leakages and bandpasses are valid for the whole block
+   virtual bool allValidBlock(const casacore::uInt beam, const casacore::uInt startAnt, const casacore::uInt nAnt,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const;
+
+   /// @brief fill Jones matrices for all antennas of one beam in a range of channels
+   /// @details This method does the actual work for jonesBlock. The default implementation
+   /// obtains gains and leakages once per antenna and calls bandpass for each channel. 
+   /// Implementations with direct access to the solutions should override it.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+   /// @param[out] validity pointer to nChan * nAnt validity flags to fill
+   virtual void fillJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                   const casacore::uInt nChan, casacore::Complex *jones, casacore::Bool *validity) const;
+
+   /// @brief compose a Jones matrix from its constituents
+   /// @details This helper implements the logic of jonesAndValidity for given gain,
+   /// bandpass and leakage terms, so the bulk methods give identical results.
+   /// @param[in] gTerm gains
+   /// @param[in] bpTerm bandpass for the channel of interest
+   /// @param[in] dTerm leakages
+   /// @param[out] jones pointer to 4 elements to fill in the order J00, J01, J10, J11
+   /// @return validity flag (the identity matrix is written if the result is not valid)
+   static bool composeJones(const JonesJTerm &gTerm, const JonesJTerm &bpTerm, 
+                            const JonesDTerm &dTerm, casacore::Complex *jones);
 };
 
 } // namespace accessors
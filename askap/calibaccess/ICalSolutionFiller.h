@@ -37,6 +37,11 @@
 #include <casacore/casa/Arrays/Cube.h>
 #include <casacore/casa/BasicSL/Complex.h>
 
+#include <boost/shared_ptr.hpp>
+
+#include <askap/calibaccess/ParametricBandpass.h>
+#include <askap/askap/AskapError.h>
+
 namespace askap {
 
 namespace accessors {
@@ -99,6 +104,32 @@ struct ICalSolutionFiller {
   /// @return true, if there is no bandpass solution, false otherwise
   virtual bool noBandpass() const { return false; }
 
+  // bandpasses may be read partially (e.g. only the spectral window and beams processed by
+  // a particular rank). The fill method returns the cube for the window and the following
+  // methods give its origin. By default, the whole bandpass is filled.
+
+  /// @brief first spectral channel of the bandpass cube
+  /// @return channel corresponding to the rows 0 and 1 of the bandpass cube
+  virtual casacore::uInt bandpassStartChannel() const { return 0; }
+
+  /// @brief first beam of the bandpass cube
+  /// @return beam corresponding to the plane 0 of the bandpass cube
+  virtual casacore::uInt bandpassStartBeam() const { return 0; }
+
+  // bandpasses may also be stored in the compact parametric form (see ParametricBandpass). 
+  // By default, there is no such model and the bandpass cubes are used.
+
+  /// @brief bandpass model filler
+  /// @details The model is reset if the bandpass is given by the cubes (i.e. fillBandpasses 
+  /// should be used instead)
+  /// @param[in] model shared pointer to the model to set up
+  virtual void fillBandpassModel(boost::shared_ptr<ParametricBandpass> &model) const { model.reset(); }
+
+  /// @brief bandpass model writer
+  /// @param[in] model parametric bandpass to write
+  virtual void writeBandpassModel(const ParametricBandpass &) const
+     { ASKAPTHROW(AskapError, "This solution filler doesn't support parametric bandpasses"); }
+
   /// @brief flush the underlying data
   virtual bool flush() {return false;}
 
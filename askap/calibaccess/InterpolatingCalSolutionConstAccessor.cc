@@ -0,0 +1,152 @@
+/// @file
+/// @brief accessor interpolating between two calibration solutions
+/// @details This accessor blends gains, leakages and bandpasses of two solutions 
+/// with a fixed weight. It is created by InterpolatingCalSolutionConstSource for
+/// times between two solutions.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/calibaccess/InterpolatingCalSolutionConstAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <cmath>
+
+namespace askap {
+namespace accessors {
+
+/// @brief set up the accessor
+/// @param[in] acc1 accessor for the earlier solution
+/// @param[in] acc2 accessor for the later solution
+/// @param[in] weight weight of the later solution (from 0 to 1)
+InterpolatingCalSolutionConstAccessor::InterpolatingCalSolutionConstAccessor(
+           const boost::shared_ptr<ICalSolutionConstAccessor> &acc1, 
+           const boost::shared_ptr<ICalSolutionConstAccessor> &acc2, const double weight) :
+           itsAccessor1(acc1), itsAccessor2(acc2), itsWeight(weight)
+{
+  ASKAPASSERT(itsAccessor1);
+  ASKAPASSERT(itsAccessor2);
+  ASKAPCHECK((itsWeight >= 0.) && (itsWeight <= 1.), "Interpolation weight is supposed to be from 0 to 1, you have "<<itsWeight);
+}
+
+/// @brief interpolate between two complex values
+/// @details Amplitude and phase are interpolated linearly
+/// @param[in] val1 first value
+/// @param[in] val2 second value
+/// @param[in] weight weight of the second value (from 0 to 1)
+/// @return interpolated value
+casacore::Complex InterpolatingCalSolutionConstAccessor::interpolate(const casacore::Complex &val1, 
+                  const casacore::Complex &val2, const double weight)
+{
+  const double amp = (1. - weight) * std::abs(val1) + weight * std::abs(val2);
+  const double phase1 = std::arg(val1);
+  double phaseDiff = std::arg(val2) - phase1;
+  if (phaseDiff > casacore::C::pi) {
+      phaseDiff -= 2. * casacore::C::pi;
+  } else if (phaseDiff < -casacore::C::pi) {
+      phaseDiff += 2. * casacore::C::pi;
+  }
+  const double phase = phase1 + weight * phaseDiff;
+  return casacore::Complex(float(amp * std::cos(phase)), float(amp * std::sin(phase)));
+}
+
+/// @brief interpolate between two complex values taking validity into account
+/// @param[in] val1 first value
+/// @param[in] valid1 validity of the first value
+/// @param[in] val2 second value
+/// @param[in] valid2 validity of the second value
+/// @param[out] valid validity of the result
+/// @return interpolated value (the first value if both are invalid)
+casacore::Complex InterpolatingCalSolutionConstAccessor::interpolate(const casacore::Complex &val1, const bool valid1,
+                  const casacore::Complex &val2, const bool valid2, bool &valid) const
+{
+  valid = valid1 || valid2;
+  if (valid1 && valid2) {
+      return interpolate(val1, val2, itsWeight);
+  }
+  return valid2 ? val2 : val1;
+}
+
+/// @brief obtain gains (J-Jones)
+/// @details This method retrieves parallel-hand gains for both 
+/// polarisations (corresponding to XX and YY). If no gains are defined
+/// for a particular index, gains of 1. with invalid flags set are
+/// returned.
+/// @param[in] index ant/beam index 
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm InterpolatingCalSolutionConstAccessor::gain(const JonesIndex &index) const
+{
+  const JonesJTerm gain1 = itsAccessor1->gain(index);
+  const JonesJTerm gain2 = itsAccessor2->gain(index);
+  bool g1Valid = false, g2Valid = false;
+  const casacore::Complex g1 = interpolate(gain1.g1(), gain1.g1IsValid(), gain2.g1(), gain2.g1IsValid(), g1Valid);
+  const casacore::Complex g2 = interpolate(gain1.g2(), gain1.g2IsValid(), gain2.g2(), gain2.g2IsValid(), g2Valid);
+  return JonesJTerm(g1, g1Valid, g2, g2Valid);
+}
+
+/// @brief obtain leakage (D-Jones)
+/// @details This method retrieves cross-hand elements of the 
+/// Jones matrix (polarisation leakages). There are two values
+/// (corresponding to XY and YX) returned (as members of JonesDTerm 
+/// class). If no leakages are defined for a particular index,
+/// zero leakages are returned with invalid flags set. 
+/// @param[in] index ant/beam index
+/// @return JonesDTerm object with leakages and validity flags
+JonesDTerm InterpolatingCalSolutionConstAccessor::leakage(const JonesIndex &index) const
+{
+  const JonesDTerm leakage1 = itsAccessor1->leakage(index);
+  const JonesDTerm leakage2 = itsAccessor2->leakage(index);
+  bool d12Valid = false, d21Valid = false;
+  const casacore::Complex d12 = interpolate(leakage1.d12(), leakage1.d12IsValid(), leakage2.d12(), 
+                                             leakage2.d12IsValid(), d12Valid);
+  const casacore::Complex d21 = interpolate(leakage1.d21(), leakage1.d21IsValid(), leakage2.d21(), 
+                                            leakage2.d21IsValid(), d21Valid);
+  return JonesDTerm(d12, d12Valid, d21, d21Valid);
+}
+
+/// @brief obtain bandpass (frequency dependent J-Jones)
+/// @details This method retrieves parallel-hand spectral
+/// channel-dependent gain (also known as bandpass) for a
+/// given channel and antenna/beam. If no bandpass is defined 
+/// (at all or for this particular channel), gains of 1.0 are 
+/// returned (with invalid flag is set).
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel of interest
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm InterpolatingCalSolutionConstAccessor::bandpass(const JonesIndex &index, const casacore::uInt chan) const
+{
+  const JonesJTerm bp1 = itsAccessor1->bandpass(index, chan);
+  const JonesJTerm bp2 = itsAccessor2->bandpass(index, chan);
+  bool g1Valid = false, g2Valid = false;
+  const casacore::Complex g1 = interpolate(bp1.g1(), bp1.g1IsValid(), bp2.g1(), bp2.g1IsValid(), g1Valid);
+  const casacore::Complex g2 = interpolate(bp1.g2(), bp1.g2IsValid(), bp2.g2(), bp2.g2IsValid(), g2Valid);
+  return JonesJTerm(g1, g1Valid, g2, g2Valid);
+}
+
+} // namespace accessors
+} // namespace askap
@@ -0,0 +1,130 @@
+/// @file
+/// @brief accessor interpolating between two calibration solutions
+/// @details This accessor blends gains, leakages and bandpasses of two solutions 
+/// with a fixed weight. It is created by InterpolatingCalSolutionConstSource for
+/// times between two solutions.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_ACCESSOR_H
+#define ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_ACCESSOR_H
+
+// boost includes
+#include "boost/shared_ptr.hpp"
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+
+namespace askap {
+namespace accessors {
+
+/// @brief accessor interpolating between two calibration solutions
+/// @details Amplitudes and phases of the complex values are interpolated linearly
+/// and independently, the phase difference is taken in the range from -pi to pi.
+/// If only one of the two values is valid, it is returned unchanged; the result is 
+/// only invalid if both values are invalid.
+/// @ingroup calibaccess
+struct InterpolatingCalSolutionConstAccessor : public ICalSolutionConstAccessor {
+   
+   /// @brief set up the accessor
+   /// @param[in] acc1 accessor for the earlier solution
+   /// @param[in] acc2 accessor for the later solution
+   /// @param[in] weight weight of the later solution (from 0 to 1)
+   InterpolatingCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc1, 
+                                         const boost::shared_ptr<ICalSolutionConstAccessor> &acc2, 
+                                         const double weight);
+   
+   /// @brief obtain gains (J-Jones)
+   /// @details This method retrieves parallel-hand gains for both 
+   /// polarisations (corresponding to XX and YY). If no gains are defined
+   /// for a particular index, gains of 1. with invalid flags set are
+   /// returned.
+   /// @param[in] index ant/beam index 
+   /// @return JonesJTerm object with gains and validity flags
+   virtual JonesJTerm gain(const JonesIndex &index) const;
+   
+   /// @brief obtain leakage (D-Jones)
+   /// @details This method retrieves cross-hand elements of the 
+   /// Jones matrix (polarisation leakages). There are two values
+   /// (corresponding to XY and YX) returned (as members of JonesDTerm 
+   /// class). If no leakages are defined for a particular index,
+   /// zero leakages are returned with invalid flags set. 
+   /// @param[in] index ant/beam index
+   /// @return JonesDTerm object with leakages and validity flags
+   virtual JonesDTerm leakage(const JonesIndex &index) const;
+   
+   /// @brief obtain bandpass (frequency dependent J-Jones)
+   /// @details This method retrieves parallel-hand spectral
+   /// channel-dependent gain (also known as bandpass) for a
+   /// given channel and antenna/beam. If no bandpass is defined 
+   /// (at all or for this particular channel), gains of 1.0 are 
+   /// returned (with invalid flag is set).
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest
+   /// @return JonesJTerm object with gains and validity flags
+   virtual JonesJTerm bandpass(const JonesIndex &index, const casacore::uInt chan) const;
+
+   /// @brief weight of the later solution
+   /// @return weight from 0 to 1
+   inline double weight() const { return itsWeight; }
+
+   /// @brief interpolate between two complex values
+   /// @details Amplitude and phase are interpolated linearly
+   /// @param[in] val1 first value
+   /// @param[in] val2 second value
+   /// @param[in] weight weight of the second value (from 0 to 1)
+   /// @return interpolated value
+   static casacore::Complex interpolate(const casacore::Complex &val1, const casacore::Complex &val2, 
+                                        const double weight);
+   
+   /// @brief shared pointer definition
+   typedef boost::shared_ptr<InterpolatingCalSolutionConstAccessor> ShPtr;
+
+protected:
+   /// @brief interpolate between two complex values taking validity into account
+   /// @param[in] val1 first value
+   /// @param[in] valid1 validity of the first value
+   /// @param[in] val2 second value
+   /// @param[in] valid2 validity of the second value
+   /// @param[out] valid validity of the result
+   /// @return interpolated value (the first value if both are invalid)
+   casacore::Complex interpolate(const casacore::Complex &val1, const bool valid1,
+                                 const casacore::Complex &val2, const bool valid2, bool &valid) const;
+
+private:
+   /// @brief accessor for the earlier solution
+   const boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor1;
+
+   /// @brief accessor for the later solution
+   const boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor2;
+
+   /// @brief weight of the later solution
+   const double itsWeight;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_ACCESSOR_H
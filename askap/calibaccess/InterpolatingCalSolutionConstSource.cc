@@ -0,0 +1,145 @@
+/// @file
+/// @brief calibration solution source interpolating in time
+/// @details This decorator blends the two solutions bracketing the requested time
+/// instead of taking the most recent solution at or before that time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/calibaccess/InterpolatingCalSolutionConstSource.h>
+#include <askap/calibaccess/InterpolatingCalSolutionConstAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up the decorator
+/// @param[in] src shared pointer to the original source
+InterpolatingCalSolutionConstSource::InterpolatingCalSolutionConstSource(const boost::shared_ptr<TableCalSolutionConstSource> &src) :
+    itsSource(src), itsNextID(-2)
+{
+   ASKAPASSERT(src);
+}
+
+/// @brief obtain ID for the most recent solution
+/// @return ID for the most recent solution
+long InterpolatingCalSolutionConstSource::mostRecentSolution() const
+{
+   return itsSource->mostRecentSolution();
+}
+
+/// @brief obtain solution ID for a given time
+/// @details This method returns a synthetic ID if the time is between two solutions.
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long InterpolatingCalSolutionConstSource::solutionID(const double time) const
+{
+   const long id1 = itsSource->solutionID(time);
+   const long id2 = id1 + 1;
+   if (id2 > itsSource->mostRecentSolution()) {
+       return id1;
+   }
+   const double time1 = itsSource->solutionTime(id1);
+   const double time2 = itsSource->solutionTime(id2);
+   if (time2 <= time1) {
+       // rows are not in time order, interpolation doesn't make sense
+       return id1;
+   }
+   const double weight = (time - time1) / (time2 - time1);
+   if ((weight <= 0.) || (weight >= 1.)) {
+       return id1;
+   }
+   for (std::list<InterpolationPoint>::iterator it = itsPoints.begin(); it != itsPoints.end(); ++it) {
+        if ((it->itsID1 == id1) && (it->itsID2 == id2) && (it->itsWeight == weight)) {
+            itsPoints.splice(itsPoints.begin(), itsPoints, it);
+            return itsPoints.front().itsID;
+        }
+   }
+   InterpolationPoint point;
+   point.itsID = itsNextID--;
+   point.itsID1 = id1;
+   point.itsID2 = id2;
+   point.itsWeight = weight;
+   itsPoints.push_front(point);
+   if (itsPoints.size() > theirCacheSize) {
+       itsPoints.pop_back();
+   }
+   return point.itsID;
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @details This method returns a shared pointer to the solution accessor, which
+/// can be used to read the parameters. Synthetic IDs give accessors interpolating between
+/// two solutions.
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> InterpolatingCalSolutionConstSource::roSolution(const long id) const
+{
+   if (id >= 0) {
+       return underlyingSolution(id);
+   }
+   for (std::list<InterpolationPoint>::iterator it = itsPoints.begin(); it != itsPoints.end(); ++it) {
+        if (it->itsID == id) {
+            if (!it->itsAccessor) {
+                it->itsAccessor.reset(new InterpolatingCalSolutionConstAccessor(underlyingSolution(it->itsID1),
+                                      underlyingSolution(it->itsID2), it->itsWeight));
+            }
+            ASKAPDEBUGASSERT(it->itsAccessor);
+            return it->itsAccessor;
+        }
+   }
+   ASKAPTHROW(AskapError, "Requested solution id="<<id<<" is not known to InterpolatingCalSolutionConstSource, "
+              "synthetic IDs are only valid for a limited number of solutionID calls");
+}
+
+/// @brief obtain the accessor of the wrapped source
+/// @details Accessors are cached, only a few most recently used ones are kept
+/// @param[in] id solution ID in the wrapped source
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> InterpolatingCalSolutionConstSource::underlyingSolution(const long id) const
+{
+   const std::list<long>::iterator idIt = std::find(itsAccessorIDs.begin(), itsAccessorIDs.end(), id);
+   if (idIt != itsAccessorIDs.end()) {
+       itsAccessorIDs.splice(itsAccessorIDs.begin(), itsAccessorIDs, idIt);
+       ASKAPDEBUGASSERT(itsAccessors.find(id) != itsAccessors.end());
+       return itsAccessors[id];
+   }
+   const boost::shared_ptr<ICalSolutionConstAccessor> acc = itsSource->roSolution(id);
+   ASKAPDEBUGASSERT(acc);
+   itsAccessors[id] = acc;
+   itsAccessorIDs.push_front(id);
+   if (itsAccessorIDs.size() > theirCacheSize) {
+       itsAccessors.erase(itsAccessorIDs.back());
+       itsAccessorIDs.pop_back();
+   }
+   return acc;
+}
+
+} // namespace accessors
+
+} // namespace askap
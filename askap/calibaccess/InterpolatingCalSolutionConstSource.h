@@ -0,0 +1,132 @@
+/// @file
+/// @brief calibration solution source interpolating in time
+/// @details This decorator blends the two solutions bracketing the requested time
+/// instead of taking the most recent solution at or before that time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_SOURCE_H
+#define ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/TableCalSolutionConstSource.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <list>
+#include <map>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief calibration solution source interpolating in time
+/// @details For a time between two solutions of the wrapped table-based source, solutionID
+/// returns a synthetic ID (negative, less than -1) which refers to the pair of bracketing 
+/// solutions and the interpolation weight. Such IDs are cached, so all chunks with the same
+/// time get the same ID and the same accessor (see InterpolatingCalSolutionConstAccessor)
+/// and the per-visibility cost is just the blending of two values. Accessors of the
+/// bracketing solutions are cached too. If the time coincides with some solution or
+/// is past the last one, the ID of the underlying solution is returned and roSolution 
+/// works exactly as the wrapped source. Synthetic IDs are only valid for a limited number
+/// of subsequent solutionID calls with other times.
+/// @ingroup calibaccess
+class InterpolatingCalSolutionConstSource : virtual public ICalSolutionConstSource {
+public:
+
+  /// @brief set up the decorator
+  /// @param[in] src shared pointer to the original source
+  explicit InterpolatingCalSolutionConstSource(const boost::shared_ptr<TableCalSolutionConstSource> &src);
+
+  /// @brief obtain ID for the most recent solution
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const;
+  
+  /// @brief obtain solution ID for a given time
+  /// @details This method returns a synthetic ID if the time is between two solutions.
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const;
+  
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @details This method returns a shared pointer to the solution accessor, which
+  /// can be used to read the parameters. Synthetic IDs give accessors interpolating between
+  /// two solutions.
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+  /// @brief shared pointer definition
+  typedef boost::shared_ptr<InterpolatingCalSolutionConstSource> ShPtr;
+
+protected:
+  /// @brief obtain the accessor of the wrapped source
+  /// @details Accessors are cached, only a few most recently used ones are kept
+  /// @param[in] id solution ID in the wrapped source
+  /// @return shared pointer to an accessor object
+  boost::shared_ptr<ICalSolutionConstAccessor> underlyingSolution(const long id) const;
+
+  /// @brief number of interpolation points (and underlying accessors) to keep
+  static const size_t theirCacheSize = 16;
+
+private:
+  /// @brief interpolation point
+  struct InterpolationPoint {
+     /// @brief synthetic solution ID
+     long itsID;
+     /// @brief ID of the earlier solution
+     long itsID1;
+     /// @brief ID of the later solution
+     long itsID2;
+     /// @brief weight of the later solution
+     double itsWeight;
+     /// @brief interpolating accessor, created on demand
+     boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor;
+  };
+
+  /// @brief original source
+  boost::shared_ptr<TableCalSolutionConstSource> itsSource;
+
+  /// @brief known interpolation points, the most recently used first
+  mutable std::list<InterpolationPoint> itsPoints;
+
+  /// @brief counter used to generate synthetic IDs
+  mutable long itsNextID;
+
+  /// @brief cached accessors of the wrapped source
+  mutable std::map<long, boost::shared_ptr<ICalSolutionConstAccessor> > itsAccessors;
+
+  /// @brief IDs of the cached accessors, the most recently used first
+  mutable std::list<long> itsAccessorIDs;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_SOURCE_H
@@ -0,0 +1,274 @@
+/// @file
+/// @brief accessor adapter caching inverse Jones matrices
+/// @details Applications correcting visibilities need inverse Jones matrices for every 
+/// antenna, beam and channel. This adapter wraps another solution accessor, computes the
+/// inverse matrices in bulk when a beam is requested for the first time and keeps them
+/// for subsequent requests, so the inversion is done once per solution rather than once
+/// per data chunk (or per visibility).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// own includes
+#include <askap/calibaccess/InverseJonesCalSolutionConstAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+#include <complex>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up the adapter
+/// @param[in] acc shared pointer to the original accessor to wrap
+/// @param[in] nAnt number of antennas to cache (minimum, more are cached on demand)
+/// @param[in] nChan number of channels to cache starting from channel 0 (minimum, more are
+/// cached on demand)
+InverseJonesCalSolutionConstAccessor::InverseJonesCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc,
+        const casacore::uInt nAnt, const casacore::uInt nChan) : itsAccessor(acc), itsNAnt(nAnt), itsNChan(nChan)
+{
+   ASKAPASSERT(acc);
+}
+
+/// @brief obtain gains (J-Jones)
+/// @details This method retrieves parallel-hand gains for both 
+/// polarisations (corresponding to XX and YY). If no gains are defined
+/// for a particular index, gains of 1. with invalid flags set are
+/// returned.
+/// @param[in] index ant/beam index 
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm InverseJonesCalSolutionConstAccessor::gain(const JonesIndex &index) const
+{
+   return itsAccessor->gain(index);
+}
+
+/// @brief obtain leakage (D-Jones)
+/// @details This method retrieves cross-hand elements of the 
+/// Jones matrix (polarisation leakages). There are two values
+/// (corresponding to XY and YX) returned (as members of JonesDTerm 
+/// class). If no leakages are defined for a particular index,
+/// zero leakages are returned with invalid flags set. 
+/// @param[in] index ant/beam index
+/// @return JonesDTerm object with leakages and validity flags
+JonesDTerm InverseJonesCalSolutionConstAccessor::leakage(const JonesIndex &index) const
+{
+   return itsAccessor->leakage(index);
+}
+
+/// @brief obtain bandpass (frequency dependent J-Jones)
+/// @details This method retrieves parallel-hand spectral
+/// channel-dependent gain (also known as bandpass) for a
+/// given channel and antenna/beam. If no bandpass is defined 
+/// (at all or for this particular channel), gains of 1.0 are 
+/// returned (with invalid flag is set).
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel of interest
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm InverseJonesCalSolutionConstAccessor::bandpass(const JonesIndex &index, const casacore::uInt chan) const
+{
+   return itsAccessor->bandpass(index, chan);
+}
+
+/// @brief obtain inverse Jones matrix
+/// @details This is the inverse counterpart of jonesAndValidity. The beam cache is
+/// computed if necessary.
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @param[in] chan spectral channel of interest
+/// @return pair of the inverse matrix (identity if not valid) and validity flag
+std::pair<casacore::SquareMatrix<casacore::Complex, 2>, bool> InverseJonesCalSolutionConstAccessor::inverseJones(
+          const casacore::uInt ant, const casacore::uInt beam, const casacore::uInt chan) const
+{
+   const boost::shared_ptr<const BeamCache> cache = beamCache(beam, ant + 1, chan + 1);
+   ASKAPDEBUGASSERT(cache);
+   const casacore::Complex *jones = cache->itsJones.data() + 4 * (chan + size_t(cache->itsNChan) * ant);
+   casacore::SquareMatrix<casacore::Complex, 2> result(casacore::SquareMatrix<casacore::Complex, 2>::General);
+   result(0, 0) = jones[0];
+   result(0, 1) = jones[1];
+   result(1, 0) = jones[2];
+   result(1, 1) = jones[3];
+   return std::pair<casacore::SquareMatrix<casacore::Complex, 2>, bool>(result, cache->itsValidity(chan, ant));
+}
+
+/// @brief obtain inverse Jones matrices for all antennas of one beam in a range of channels
+/// @details The layout is the same as for jonesBlock.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones 4 x nChan x nAnt cube with matrix elements (resized as required)
+/// @param[out] validity nChan x nAnt matrix with validity flags (resized as required)
+void InverseJonesCalSolutionConstAccessor::inverseJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt,
+                 const casacore::uInt startChan, const casacore::uInt nChan, casacore::Cube<casacore::Complex> &jones,
+                 casacore::Matrix<casacore::Bool> &validity) const
+{
+   jones.resize(4, nChan, nAnt);
+   validity.resize(nChan, nAnt);
+   ASKAPDEBUGASSERT(jones.contiguousStorage() && validity.contiguousStorage());
+   copyInverse(beam, nAnt, startChan, nChan, jones.data(), validity.data());
+}
+
+/// @brief obtain inverse Jones matrices for all antennas and beams in a range of channels
+/// @details The layout is the same as for the multi-beam version of jonesBlock.
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] nBeam number of beams (indices 0 to nBeam-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones 4 x nChan x nAnt x nBeam array with matrix elements (resized as required)
+/// @param[out] validity nChan x nAnt x nBeam cube with validity flags (resized as required)
+void InverseJonesCalSolutionConstAccessor::inverseJonesBlock(const casacore::uInt nAnt, const casacore::uInt nBeam,
+                 const casacore::uInt startChan, const casacore::uInt nChan, casacore::Array<casacore::Complex> &jones,
+                 casacore::Cube<casacore::Bool> &validity) const
+{
+   jones.resize(casacore::IPosition(4, 4, nChan, nAnt, nBeam));
+   validity.resize(nChan, nAnt, nBeam);
+   ASKAPDEBUGASSERT(jones.contiguousStorage() && validity.contiguousStorage());
+   const size_t blockSize = size_t(nChan) * nAnt;
+   for (casacore::uInt beam = 0; beam < nBeam; ++beam) {
+        copyInverse(beam, nAnt, startChan, nChan, jones.data() + 4 * blockSize * beam, 
+                    validity.data() + blockSize * beam);
+   }
+}
+
+/// @brief invert a number of 2x2 matrices in place
+/// @details Matrices are given by 4 consecutive elements in the order J00, J01, J10, J11
+/// (as returned by jonesBlock). Matrices which are flagged invalid on input or have a 
+/// vanishing determinant are replaced by identity and flagged invalid. The loop has no 
+/// dependencies between matrices, so the compiler is free to vectorise it.
+/// @param[in,out] jones pointer to 4 * n elements
+/// @param[in,out] validity pointer to n validity flags
+/// @param[in] n number of matrices
+void InverseJonesCalSolutionConstAccessor::invertJones(casacore::Complex *jones, casacore::Bool *validity, const size_t n)
+{
+   for (size_t i = 0; i < n; ++i, jones += 4, ++validity) {
+        const casacore::Complex det = jones[0] * jones[3] - jones[1] * jones[2];
+        if (!*validity || (std::norm(det) < 1e-20)) {
+            *validity = casacore::False;
+            jones[0] = jones[3] = casacore::Complex(1., 0.);
+            jones[1] = jones[2] = casacore::Complex(0., 0.);
+            continue;
+        }
+        const casacore::Complex reciprocal = casacore::Complex(1., 0.) / det;
+        const casacore::Complex j00 = jones[0];
+        jones[0] = jones[3] * reciprocal;
+        jones[1] = -jones[1] * reciprocal;
+        jones[2] = -jones[2] * reciprocal;
+        jones[3] = j00 * reciprocal;
+   }
+}
+
+/// @brief number of beams with cached inverse matrices
+/// @return number of beams for which the inverse matrices have been computed
+casacore::uInt InverseJonesCalSolutionConstAccessor::nCachedBeams() const
+{
+   boost::lock_guard<boost::mutex> lock(itsMutex);
+   casacore::uInt result = 0;
+   for (size_t beam = 0; beam < itsCache.size(); ++beam) {
+        if (itsCache[beam]) {
+            ++result;
+        }
+   }
+   return result;
+}
+
+/// @brief fill Jones matrices for all antennas of one beam in a range of channels
+/// @details This method forwards the request to the bulk method of the wrapped accessor,
+/// so forward matrices are obtained as efficiently as without the adapter.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+/// @param[out] validity pointer to nChan * nAnt validity flags to fill
+void InverseJonesCalSolutionConstAccessor::fillJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                 const casacore::uInt startChan, const casacore::uInt nChan, casacore::Complex *jones, 
+                 casacore::Bool *validity) const
+{
+   casacore::Cube<casacore::Complex> buf;
+   casacore::Matrix<casacore::Bool> bufValidity;
+   itsAccessor->jonesBlock(beam, nAnt, startChan, nChan, buf, bufValidity);
+   ASKAPDEBUGASSERT(buf.contiguousStorage() && bufValidity.contiguousStorage());
+   std::copy(buf.data(), buf.data() + buf.nelements(), jones);
+   std::copy(bufValidity.data(), bufValidity.data() + bufValidity.nelements(), validity);
+}
+
+/// @brief obtain the cache of a beam
+/// @details The cache is computed if it does not exist or does not cover the requested
+/// number of antennas and channels. The returned object is never changed afterwards.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas required
+/// @param[in] nChan number of channels required (starting from channel 0)
+/// @return shared pointer to the beam cache
+boost::shared_ptr<const InverseJonesCalSolutionConstAccessor::BeamCache> 
+InverseJonesCalSolutionConstAccessor::beamCache(const casacore::uInt beam, const casacore::uInt nAnt,
+                                                const casacore::uInt nChan) const
+{
+   boost::lock_guard<boost::mutex> lock(itsMutex);
+   if (beam >= itsCache.size()) {
+       itsCache.resize(beam + 1);
+   }
+   const boost::shared_ptr<const BeamCache> &current = itsCache[beam];
+   if (current && (current->itsNAnt >= nAnt) && (current->itsNChan >= nChan)) {
+       return current;
+   }
+   // the new cache covers everything cached before, so the extent only grows
+   boost::shared_ptr<BeamCache> cache(new BeamCache);
+   cache->itsNAnt = std::max(std::max(nAnt, itsNAnt), current ? current->itsNAnt : 0u);
+   cache->itsNChan = std::max(std::max(nChan, itsNChan), current ? current->itsNChan : 0u);
+   itsAccessor->jonesBlock(beam, cache->itsNAnt, 0, cache->itsNChan, cache->itsJones, cache->itsValidity);
+   ASKAPDEBUGASSERT(cache->itsJones.contiguousStorage() && cache->itsValidity.contiguousStorage());
+   invertJones(cache->itsJones.data(), cache->itsValidity.data(), cache->itsValidity.nelements());
+   itsCache[beam] = cache;
+   return itsCache[beam];
+}
+
+/// @brief copy cached inverse matrices of one beam
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+/// @param[out] validity pointer to nChan * nAnt validity flags to fill
+void InverseJonesCalSolutionConstAccessor::copyInverse(const casacore::uInt beam, const casacore::uInt nAnt,
+                 const casacore::uInt startChan, const casacore::uInt nChan, casacore::Complex *jones,
+                 casacore::Bool *validity) const
+{
+   // the cache is immutable, so the copy is done without holding the lock
+   const boost::shared_ptr<const BeamCache> cache = beamCache(beam, nAnt, startChan + nChan);
+   ASKAPDEBUGASSERT(cache);
+   for (casacore::uInt ant = 0; ant < nAnt; ++ant, jones += 4 * nChan, validity += nChan) {
+        const size_t offset = startChan + size_t(cache->itsNChan) * ant;
+        const casacore::Complex *srcJones = cache->itsJones.data() + 4 * offset;
+        std::copy(srcJones, srcJones + 4 * nChan, jones);
+        const casacore::Bool *srcValidity = cache->itsValidity.data() + offset;
+        std::copy(srcValidity, srcValidity + nChan, validity);
+   }
+}
+
+} // namespace accessors
+
+} // namespace askap
+
@@ -0,0 +1,230 @@
+/// @file
+/// @brief accessor adapter caching inverse Jones matrices
+/// @details Applications correcting visibilities need inverse Jones matrices for every 
+/// antenna, beam and channel. This adapter wraps another solution accessor, computes the
+/// inverse matrices in bulk when a beam is requested for the first time and keeps them
+/// for subsequent requests, so the inversion is done once per solution rather than once
+/// per data chunk (or per visibility).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_INVERSE_JONES_CAL_SOLUTION_CONST_ACCESSOR_H
+#define ASKAP_ACCESSORS_INVERSE_JONES_CAL_SOLUTION_CONST_ACCESSOR_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+// std includes
+#include <utility>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief accessor adapter caching inverse Jones matrices
+/// @details This class implements ICalSolutionConstAccessor by forwarding all requests 
+/// to the wrapped accessor and, in addition, provides inverse Jones matrices. The inverse
+/// matrices are computed for all antennas and channels of a beam at once (via the bulk 
+/// jonesBlock method of the wrapped accessor) and cached. Matrices which are not valid or 
+/// are singular are returned as identity with the validity flag unset, in the same way 
+/// as for jonesBlock. Cached data are immutable once computed, therefore the same adapter
+/// can be shared by a number of threads: the lock is only held while the cache of a beam 
+/// is looked up or computed, copying the matrices out is done without the lock.
+/// The number of antennas and channels can be given in advance, otherwise the cache of a 
+/// beam is recomputed each time a larger block is requested. The wrapped accessor is 
+/// assumed to remain unchanged while this adapter exists.
+/// @ingroup calibaccess
+class InverseJonesCalSolutionConstAccessor : public ICalSolutionConstAccessor,
+                                             private boost::noncopyable {
+public:
+   /// @brief set up the adapter
+   /// @param[in] acc shared pointer to the original accessor to wrap
+   /// @param[in] nAnt number of antennas to cache (minimum, more are cached on demand)
+   /// @param[in] nChan number of channels to cache starting from channel 0 (minimum, more are
+   /// cached on demand)
+   explicit InverseJonesCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc,
+                                                 const casacore::uInt nAnt = 0u, const casacore::uInt nChan = 0u);
+
+   /// @brief obtain gains (J-Jones)
+   /// @details This method retrieves parallel-hand gains for both 
+   /// polarisations (corresponding to XX and YY). If no gains are defined
+   /// for a particular index, gains of 1. with invalid flags set are
+   /// returned.
+   /// @param[in] index ant/beam index 
+   /// @return JonesJTerm object with gains and validity flags
+   virtual JonesJTerm gain(const JonesIndex &index) const;
+   
+   /// @brief obtain leakage (D-Jones)
+   /// @details This method retrieves cross-hand elements of the 
+   /// Jones matrix (polarisation leakages). There are two values
+   /// (corresponding to XY and YX) returned (as members of JonesDTerm 
+   /// class). If no leakages are defined for a particular index,
+   /// zero leakages are returned with invalid flags set. 
+   /// @param[in] index ant/beam index
+   /// @return JonesDTerm object with leakages and validity flags
+   virtual JonesDTerm leakage(const JonesIndex &index) const;
+   
+   /// @brief obtain bandpass (frequency dependent J-Jones)
+   /// @details This method retrieves parallel-hand spectral
+   /// channel-dependent gain (also known as bandpass) for a
+   /// given channel and antenna/beam. If no bandpass is defined 
+   /// (at all or for this particular channel), gains of 1.0 are 
+   /// returned (with invalid flag is set).
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest
+   /// @return JonesJTerm object with gains and validity flags
+   virtual JonesJTerm bandpass(const JonesIndex &index, const casacore::uInt chan) const;
+
+   /// @brief obtain inverse Jones matrix
+   /// @details This is the inverse counterpart of jonesAndValidity. The beam cache is
+   /// computed if necessary.
+   /// @param[in] ant antenna index
+   /// @param[in] beam beam index
+   /// @param[in] chan spectral channel of interest
+   /// @return pair of the inverse matrix (identity if not valid) and validity flag
+   std::pair<casacore::SquareMatrix<casacore::Complex, 2>, bool> inverseJones(const casacore::uInt ant,
+             const casacore::uInt beam, const casacore::uInt chan) const;
+
+   /// @brief obtain inverse Jones matrices for all antennas of one beam in a range of channels
+   /// @details The layout is the same as for jonesBlock.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones 4 x nChan x nAnt cube with matrix elements (resized as required)
+   /// @param[out] validity nChan x nAnt matrix with validity flags (resized as required)
+   void inverseJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                   const casacore::uInt nChan, casacore::Cube<casacore::Complex> &jones,
+                   casacore::Matrix<casacore::Bool> &validity) const;
+
+   /// @brief obtain inverse Jones matrices for all antennas and beams in a range of channels
+   /// @details The layout is the same as for the multi-beam version of jonesBlock.
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] nBeam number of beams (indices 0 to nBeam-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones 4 x nChan x nAnt x nBeam array with matrix elements (resized as required)
+   /// @param[out] validity nChan x nAnt x nBeam cube with validity flags (resized as required)
+   void inverseJonesBlock(const casacore::uInt nAnt, const casacore::uInt nBeam, const casacore::uInt startChan,
+                   const casacore::uInt nChan, casacore::Array<casacore::Complex> &jones,
+                   casacore::Cube<casacore::Bool> &validity) const;
+
+   /// @brief invert a number of 2x2 matrices in place
+   /// @details Matrices are given by 4 consecutive elements in the order J00, J01, J10, J11
+   /// (as returned by jonesBlock). Matrices which are flagged invalid on input or have a 
+   /// vanishing determinant are replaced by identity and flagged invalid. The loop has no 
+   /// dependencies between matrices, so the compiler is free to vectorise it.
+   /// @param[in,out] jones pointer to 4 * n elements
+   /// @param[in,out] validity pointer to n validity flags
+   /// @param[in] n number of matrices
+   static void invertJones(casacore::Complex *jones, casacore::Bool *validity, const size_t n);
+
+   /// @brief number of beams with cached inverse matrices
+   /// @return number of beams for which the inverse matrices have been computed
+   casacore::uInt nCachedBeams() const;
+
+   /// @brief shared pointer definition
+   typedef boost::shared_ptr<InverseJonesCalSolutionConstAccessor> ShPtr;
+
+protected:
+   /// @brief fill Jones matrices for all antennas of one beam in a range of channels
+   /// @details This method forwards the request to the bulk method of the wrapped accessor,
+   /// so forward matrices are obtained as efficiently as without the adapter.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+   /// @param[out] validity pointer to nChan * nAnt validity flags to fill
+   virtual void fillJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                   const casacore::uInt nChan, casacore::Complex *jones, casacore::Bool *validity) const;
+
+private:
+   /// @brief inverse matrices of one beam
+   struct BeamCache {
+      /// @brief number of cached antennas
+      casacore::uInt itsNAnt;
+      /// @brief number of cached channels (starting from channel 0)
+      casacore::uInt itsNChan;
+      /// @brief inverse matrices, 4 x nChan x nAnt
+      casacore::Cube<casacore::Complex> itsJones;
+      /// @brief validity flags, nChan x nAnt
+      casacore::Matrix<casacore::Bool> itsValidity;
+   };
+
+   /// @brief obtain the cache of a beam
+   /// @details The cache is computed if it does not exist or does not cover the requested
+   /// number of antennas and channels. The returned object is never changed afterwards.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas required
+   /// @param[in] nChan number of channels required (starting from channel 0)
+   /// @return shared pointer to the beam cache
+   boost::shared_ptr<const BeamCache> beamCache(const casacore::uInt beam, const casacore::uInt nAnt,
+                                                const casacore::uInt nChan) const;
+
+   /// @brief copy cached inverse matrices of one beam
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+   /// @param[out] validity pointer to nChan * nAnt validity flags to fill
+   void copyInverse(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                    const casacore::uInt nChan, casacore::Complex *jones, casacore::Bool *validity) const;
+
+   /// @brief original accessor
+   const boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor;
+
+   /// @brief minimum number of antennas to cache
+   const casacore::uInt itsNAnt;
+
+   /// @brief minimum number of channels to cache
+   const casacore::uInt itsNChan;
+
+   /// @brief cached inverse matrices for every beam (empty pointer if not yet computed)
+   mutable std::vector<boost::shared_ptr<const BeamCache> > itsCache;
+
+   /// @brief mutex protecting the cache
+   mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_INVERSE_JONES_CAL_SOLUTION_CONST_ACCESSOR_H
+
@@ -0,0 +1,96 @@
+/// @file
+/// @brief solution source providing cached inverse Jones matrices
+/// @details This class wraps another solution source and returns accessors which
+/// cache inverse Jones matrices (see InverseJonesCalSolutionConstAccessor). The accessor 
+/// of the most recently requested solution is kept, so all data chunks and threads 
+/// using the same solution share the inverse matrices computed once.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/calibaccess/InverseJonesCalSolutionConstSource.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] src solution source to obtain solutions from
+/// @param[in] nAnt number of antennas to cache in every accessor (see InverseJonesCalSolutionConstAccessor)
+/// @param[in] nChan number of channels to cache in every accessor (see InverseJonesCalSolutionConstAccessor)
+InverseJonesCalSolutionConstSource::InverseJonesCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src,
+        const casacore::uInt nAnt, const casacore::uInt nChan) : itsSource(src), itsNAnt(nAnt), itsNChan(nChan), 
+        itsLastID(-1)
+{
+  ASKAPASSERT(src);
+}
+
+/// @brief obtain ID for the most recent solution
+/// @return ID for the most recent solution
+long InverseJonesCalSolutionConstSource::mostRecentSolution() const
+{
+  return itsSource->mostRecentSolution();
+}
+
+/// @brief obtain solution ID for a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long InverseJonesCalSolutionConstSource::solutionID(const double time) const
+{
+  return itsSource->solutionID(time);
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @details The returned object is an InverseJonesCalSolutionConstAccessor.
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> InverseJonesCalSolutionConstSource::roSolution(const long id) const
+{
+  return inverseSolution(id);
+}
+
+/// @brief obtain accessor with inverse Jones matrices for a given solution ID
+/// @details This method is equivalent to roSolution, but gives access to the inverse
+/// matrices without a cast.
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+InverseJonesCalSolutionConstAccessor::ShPtr InverseJonesCalSolutionConstSource::inverseSolution(const long id) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (!itsLastAccessor || (itsLastID != id)) {
+      const boost::shared_ptr<ICalSolutionConstAccessor> acc = itsSource->roSolution(id);
+      ASKAPCHECK(acc, "Solution source returned an empty accessor for solution ID="<<id);
+      itsLastAccessor.reset(new InverseJonesCalSolutionConstAccessor(acc, itsNAnt, itsNChan));
+      itsLastID = id;
+  }
+  return itsLastAccessor;
+}
+
+} // namespace accessors
+
+} // namespace askap
+
@@ -0,0 +1,116 @@
+/// @file
+/// @brief solution source providing cached inverse Jones matrices
+/// @details This class wraps another solution source and returns accessors which
+/// cache inverse Jones matrices (see InverseJonesCalSolutionConstAccessor). The accessor 
+/// of the most recently requested solution is kept, so all data chunks and threads 
+/// using the same solution share the inverse matrices computed once.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_INVERSE_JONES_CAL_SOLUTION_CONST_SOURCE_H
+#define ASKAP_ACCESSORS_INVERSE_JONES_CAL_SOLUTION_CONST_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/InverseJonesCalSolutionConstAccessor.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief solution source providing cached inverse Jones matrices
+/// @details All calls are forwarded to the wrapped source, accessors returned by roSolution
+/// are wrapped into InverseJonesCalSolutionConstAccessor. The accessor for the last 
+/// requested solution ID is kept and returned again if the same ID is requested, so the 
+/// inverse matrices are computed once per solution. This class can be combined with
+/// CachingCalSolutionConstSource (wrapping this class) if more than one solution is to be kept.
+/// @ingroup calibaccess
+class InverseJonesCalSolutionConstSource : virtual public ICalSolutionConstSource, 
+                                           private boost::noncopyable {
+public:
+  /// @brief constructor
+  /// @param[in] src solution source to obtain solutions from
+  /// @param[in] nAnt number of antennas to cache in every accessor (see InverseJonesCalSolutionConstAccessor)
+  /// @param[in] nChan number of channels to cache in every accessor (see InverseJonesCalSolutionConstAccessor)
+  explicit InverseJonesCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src,
+                                              const casacore::uInt nAnt = 0u, const casacore::uInt nChan = 0u);
+
+  /// @brief obtain ID for the most recent solution
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const;
+  
+  /// @brief obtain solution ID for a given time
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const;
+  
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @details The returned object is an InverseJonesCalSolutionConstAccessor.
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+  /// @brief obtain accessor with inverse Jones matrices for a given solution ID
+  /// @details This method is equivalent to roSolution, but gives access to the inverse
+  /// matrices without a cast.
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  InverseJonesCalSolutionConstAccessor::ShPtr inverseSolution(const long id) const;
+
+  /// @brief shared pointer definition
+  typedef boost::shared_ptr<InverseJonesCalSolutionConstSource> ShPtr;
+
+private:
+  /// @brief wrapped solution source
+  const boost::shared_ptr<ICalSolutionConstSource> itsSource;
+
+  /// @brief number of antennas to cache
+  const casacore::uInt itsNAnt;
+
+  /// @brief number of channels to cache
+  const casacore::uInt itsNChan;
+
+  /// @brief solution ID of the kept accessor
+  mutable long itsLastID;
+
+  /// @brief the accessor for the last requested solution (empty pointer if none)
+  mutable InverseJonesCalSolutionConstAccessor::ShPtr itsLastAccessor;
+
+  /// @brief mutex protecting the kept accessor
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_INVERSE_JONES_CAL_SOLUTION_CONST_SOURCE_H
+
@@ -36,12 +36,34 @@
 
 #include <askap/calibaccess/MemCalSolutionAccessor.h>
 #include <askap/calibaccess/JonesDTerm.h>
+#include <askap/calibaccess/CalibrationStatistics.h>
 #include <askap/askap/AskapError.h>
 
+// std includes
+#include <algorithm>
+
 namespace askap {
 
 namespace accessors {
 
+namespace {
+
+/// @brief account for an access to the cached calibration product
+/// @param[in] field cache of the product, which is about to be read on demand if invalid
+template<typename T>
+void countCacheAccess(const CachedAccessorField<T> &field)
+{
+  CalibrationStatistics &stats = CalibrationStatistics::instance();
+  if (stats.isEnabled()) {
+      if (field.isValid()) {
+          stats.cacheHit();
+      } else {
+          stats.cacheFill();
+      }
+  }
+}
+
+} // anonymous namespace
 
 /// @brief constructor
 /// @details
@@ -52,7 +74,9 @@ namespace accessors {
 /// to generate the exception closer to the point where misuse occurs (hopefully aiding the
 /// debugging)
 MemCalSolutionAccessor::MemCalSolutionAccessor(const boost::shared_ptr<ICalSolutionFiller> &filler, bool roCheck) :
-   itsSolutionFiller(filler), itsSettersAllowed(!roCheck)
+   itsSolutionFiller(filler), itsSettersAllowed(!roCheck), itsFrozen(false), itsFrozenGains(NULL),
+   itsFrozenLeakages(NULL), itsFrozenBandpasses(NULL), itsFrozenBandpassModel(NULL), itsFrozenBPStartChan(0u),
+   itsFrozenBPStartBeam(0u)
 {
   ASKAPCHECK(itsSolutionFiller, "Uninitialised solution filler has been passes to MemCalSolutionAccessor");
 }
@@ -66,15 +90,13 @@ MemCalSolutionAccessor::MemCalSolutionAccessor(const boost::shared_ptr<ICalSolut
 /// @return JonesJTerm object with gains and validity flags
 JonesJTerm MemCalSolutionAccessor::gain(const JonesIndex &index) const
 {
-  ASKAPASSERT(itsSolutionFiller);
-  if (itsSolutionFiller->noGain() && !itsGains.flushNeeded()) {
+  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* gains = gainCubes();
+  if (gains == NULL) {
       // return default gains
       return JonesJTerm(1., false, 1., false);
   }
-  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& gains =
-        itsGains.value(*itsSolutionFiller, &ICalSolutionFiller::fillGains);
-  const std::pair<casacore::Complex, casacore::Bool> g1 = extract(gains, 0, index);
-  const std::pair<casacore::Complex, casacore::Bool> g2 = extract(gains, 1, index);
+  const std::pair<casacore::Complex, casacore::Bool> g1 = extract(*gains, 0, index);
+  const std::pair<casacore::Complex, casacore::Bool> g2 = extract(*gains, 1, index);
   return JonesJTerm(g1.first, g1.second, g2.first, g2.second);
 }
 
@@ -88,15 +110,13 @@ JonesJTerm MemCalSolutionAccessor::gain(const JonesIndex &index) const
 /// @return JonesDTerm object with leakages and validity flags
 JonesDTerm MemCalSolutionAccessor::leakage(const JonesIndex &index) const
 {
-  ASKAPASSERT(itsSolutionFiller);
-  if (itsSolutionFiller->noLeakage() && !itsLeakages.flushNeeded()) {
+  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* leakages = leakageCubes();
+  if (leakages == NULL) {
       // return default leakages
       return JonesDTerm(0., false, 0., false);
   }
-  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& leakages =
-        itsLeakages.value(*itsSolutionFiller, &ICalSolutionFiller::fillLeakages);
-  const std::pair<casacore::Complex, casacore::Bool> d12 = extract(leakages, 0, index);
-  const std::pair<casacore::Complex, casacore::Bool> d21 = extract(leakages, 1, index);
+  const std::pair<casacore::Complex, casacore::Bool> d12 = extract(*leakages, 0, index);
+  const std::pair<casacore::Complex, casacore::Bool> d21 = extract(*leakages, 1, index);
   return JonesDTerm(d12.first, d12.second, d21.first, d21.second);
 }
 
@@ -115,15 +135,25 @@ JonesDTerm MemCalSolutionAccessor::leakage(const JonesIndex &index) const
 /// @return JonesJTerm object with gains and validity flags
 JonesJTerm MemCalSolutionAccessor::bandpass(const JonesIndex &index, const casacore::uInt chan) const
 {
-  ASKAPASSERT(itsSolutionFiller);
-  if (itsSolutionFiller->noBandpass() && !itsBandpasses.flushNeeded()) {
+  const ParametricBandpass *model = bandpassModel();
+  if (model != NULL) {
+      return model->bandpass(index, chan);
+  }
+  // the filler may have provided only a window of channels and beams
+  casacore::uInt startChan = 0u;
+  casacore::uInt startBeam = 0u;
+  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* bp = bandpassCubes(startChan, startBeam);
+  if (bp == NULL) {
       // default bandpasses
       return JonesJTerm(1., false, 1., false);
   }
-  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& bp =
-        itsBandpasses.value(*itsSolutionFiller, &ICalSolutionFiller::fillBandpasses);
-  const std::pair<casacore::Complex, casacore::Bool> g1 = extract(bp, 2 * chan, index);
-  const std::pair<casacore::Complex, casacore::Bool> g2 = extract(bp, 2 * chan + 1, index);
+  ASKAPCHECK((chan >= startChan) && (2 * (chan - startChan) + 1 < bp->first.nrow()), "Requested channel "<<chan<<
+             " is outside the bandpass window starting at channel "<<startChan<<", shape of the cache: "<<bp->first.shape());
+  ASKAPCHECK(index.beam() >= casacore::Short(startBeam), "Requested beam "<<index.beam()<<
+             " is outside the bandpass window starting at beam "<<startBeam);
+  const JonesIndex bpIndex(index.antenna(), casacore::Short(index.beam() - startBeam));
+  const std::pair<casacore::Complex, casacore::Bool> g1 = extract(*bp, 2 * (chan - startChan), bpIndex);
+  const std::pair<casacore::Complex, casacore::Bool> g2 = extract(*bp, 2 * (chan - startChan) + 1, bpIndex);
   return JonesJTerm(g1.first, g1.second, g2.first, g2.second);
 }
 
@@ -134,8 +164,7 @@ JonesJTerm MemCalSolutionAccessor::bandpass(const JonesIndex &index, const casac
 /// @param[in] gains JonesJTerm object with gains and validity flags
 void MemCalSolutionAccessor::setGain(const JonesIndex &index, const JonesJTerm &gains)
 {
-  ASKAPCHECK(itsSettersAllowed, "Setters methods are now allowed - roCheck=true in the constructor");
-  ASKAPASSERT(itsSolutionFiller);
+  checkSettersAllowed();
   std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& buf =
        itsGains.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillGains);
   store(buf, gains.g1(),gains.g1IsValid(), 0, index);
@@ -149,8 +178,7 @@ void MemCalSolutionAccessor::setGain(const JonesIndex &index, const JonesJTerm &
 /// @param[in] leakages JonesDTerm object with leakages and validity flags
 void MemCalSolutionAccessor::setLeakage(const JonesIndex &index, const JonesDTerm &leakages)
 {
-  ASKAPCHECK(itsSettersAllowed, "Setters methods are now allowed - roCheck=true in the constructor");
-  ASKAPASSERT(itsSolutionFiller);
+  checkSettersAllowed();
   std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& buf =
        itsLeakages.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillLeakages);
   store(buf, leakages.d12(),leakages.d12IsValid(), 0, index);
@@ -168,14 +196,90 @@ void MemCalSolutionAccessor::setLeakage(const JonesIndex &index, const JonesDTer
 /// gains set explicitly for each channel.
 void MemCalSolutionAccessor::setBandpass(const JonesIndex &index, const JonesJTerm &bp, const casacore::uInt chan)
 {
-  ASKAPCHECK(itsSettersAllowed, "Setters methods are now allowed - roCheck=true in the constructor");
-  ASKAPASSERT(itsSolutionFiller);
+  checkSettersAllowed();
+  ASKAPCHECK((itsSolutionFiller->bandpassStartChannel() == 0) && (itsSolutionFiller->bandpassStartBeam() == 0),
+             "Bandpass can't be updated if only a window has been read");
   std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& bandpasses =
        itsBandpasses.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillBandpasses);
   store(bandpasses, bp.g1(),bp.g1IsValid(), chan * 2, index);
   store(bandpasses, bp.g2(),bp.g2IsValid(), chan * 2 + 1, index);
 }
 
+/// @brief set bandpasses given in the parametric form
+/// @details The model is stored as it is (via the filler) rather than evaluated for each channel.
+/// Per-channel bandpasses set via this accessor take precedence over the model.
+/// @param[in] model parametric bandpass
+void MemCalSolutionAccessor::setBandpassModel(const ParametricBandpass &model)
+{
+  checkSettersAllowed();
+  boost::shared_ptr<ParametricBandpass> &buf =
+       itsBandpassModel.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillBandpassModel);
+  buf.reset(new ParametricBandpass(model));
+}
+
+/// @brief write gains for all antennas of one beam
+/// @details This version copies the block straight into the cached cube.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] gains pointer to 2 * nAnt gains in the order of setGains
+/// @param[in] validity pointer to 2 * nAnt validity flags
+void MemCalSolutionAccessor::writeGainBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::Complex *gains, const casacore::Bool *validity)
+{
+  checkSettersAllowed();
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& buf =
+       itsGains.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillGains);
+  checkBlock(buf, 2, nAnt, beam);
+  ASKAPDEBUGASSERT(buf.first.nrow() == 2);
+  // gains of all antennas of the given beam are contiguous in memory
+  std::copy(gains, gains + 2 * nAnt, &buf.first(0, 0, beam));
+  std::copy(validity, validity + 2 * nAnt, &buf.second(0, 0, beam));
+}
+
+/// @brief write leakages for all antennas of one beam
+/// @details This version copies the block straight into the cached cube.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] leakages pointer to 2 * nAnt leakages in the order of setLeakages
+/// @param[in] validity pointer to 2 * nAnt validity flags
+void MemCalSolutionAccessor::writeLeakageBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::Complex *leakages, const casacore::Bool *validity)
+{
+  checkSettersAllowed();
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& buf =
+       itsLeakages.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillLeakages);
+  checkBlock(buf, 2, nAnt, beam);
+  ASKAPDEBUGASSERT(buf.first.nrow() == 2);
+  std::copy(leakages, leakages + 2 * nAnt, &buf.first(0, 0, beam));
+  std::copy(validity, validity + 2 * nAnt, &buf.second(0, 0, beam));
+}
+
+/// @brief write bandpasses for all antennas of one beam in a range of channels
+/// @details This version copies the channel range of each antenna straight into the cached cube.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[in] bp pointer to 2 * nChan * nAnt bandpass gains in the order of setBandpasses
+/// @param[in] validity pointer to 2 * nChan * nAnt validity flags
+void MemCalSolutionAccessor::writeBandpassBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::uInt startChan, const casacore::uInt nChan, const casacore::Complex *bp,
+                const casacore::Bool *validity)
+{
+  checkSettersAllowed();
+  ASKAPCHECK((itsSolutionFiller->bandpassStartChannel() == 0) && (itsSolutionFiller->bandpassStartBeam() == 0),
+             "Bandpass can't be updated if only a window has been read");
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& bandpasses =
+       itsBandpasses.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillBandpasses);
+  checkBlock(bandpasses, 2 * (startChan + nChan), nAnt, beam);
+  const size_t blockSize = 2 * size_t(nChan);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant, bp += blockSize, validity += blockSize) {
+       // bandpass values for the given antenna and beam are contiguous in memory
+       std::copy(bp, bp + blockSize, &bandpasses.first(2 * startChan, ant, beam));
+       std::copy(validity, validity + blockSize, &bandpasses.second(2 * startChan, ant, beam));
+  }
+}
+
 /// @details helper method to extract value and validity flag for a given ant/beam pair
 /// @param[in] cubes const reference to a cube pair
 /// @param[in] row polarisation/channel index (row of the cube)
@@ -194,6 +298,381 @@ std::pair<casacore::Complex, casacore::Bool> MemCalSolutionAccessor::extract(con
               cubes.second(row,casacore::uInt(ant),casacore::uInt(beam)));
 }
 
+/// @brief memory used by the cached solutions
+/// @details Only the cubes which have been read so far are counted
+/// @return number of bytes held by the gain, leakage and bandpass caches (including the bandpass model
+/// and the packed validity flags)
+size_t MemCalSolutionAccessor::memoryUsage() const
+{
+  size_t result = 0;
+  if (itsGains.isValid()) {
+      result += itsGains.value().first.nelements() * (sizeof(casacore::Complex) + sizeof(casacore::Bool));
+  }
+  if (itsLeakages.isValid()) {
+      result += itsLeakages.value().first.nelements() * (sizeof(casacore::Complex) + sizeof(casacore::Bool));
+  }
+  if (itsBandpasses.isValid()) {
+      result += itsBandpasses.value().first.nelements() * (sizeof(casacore::Complex) + sizeof(casacore::Bool));
+  }
+  if (itsBandpassModel.isValid() && itsBandpassModel.value()) {
+      result += itsBandpassModel.value()->memoryUsage();
+  }
+  result += itsFrozenGainValidity.memoryUsage() + itsFrozenLeakageValidity.memoryUsage() + 
+            itsFrozenBandpassValidity.memoryUsage();
+  return result;
+}
+
+/// @brief fill Jones matrices for all antennas of one beam in a range of channels
+/// @details This version reads the cached cubes directly, without going through
+/// gain, leakage and bandpass methods for each element.
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+/// @param[out] validity pointer to nChan * nAnt validity flags to fill
+void MemCalSolutionAccessor::fillJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, 
+                const casacore::uInt startChan, const casacore::uInt nChan, casacore::Complex *jones,
+                casacore::Bool *validity) const
+{
+  typedef std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > CubePair;
+  // null pointers mean that the corresponding product is not defined (same logic as in the individual getters)
+  const CubePair *gains = gainCubes();
+  if (gains != NULL) {
+      checkBlock(*gains, 2, nAnt, beam);
+  }
+  const CubePair *leakages = leakageCubes();
+  if (leakages != NULL) {
+      checkBlock(*leakages, 2, nAnt, beam);
+  }
+  // the bandpass model is evaluated for each antenna into the buffer, it has the layout of the bandpass cube
+  const ParametricBandpass *model = bandpassModel();
+  casacore::Vector<casacore::Complex> modelValues;
+  casacore::Vector<casacore::Bool> modelValidity;
+  if (model != NULL) {
+      ASKAPCHECK((nAnt <= model->nAnt()) && (beam < model->nBeam()) && (startChan + nChan <= model->nChan()), 
+                 "Requested block (beam "<<beam<<", "<<nAnt<<" antennas, channels "<<startChan<<" to "<<startChan + nChan<<
+                 ") is outside the bandpass model");
+      modelValues.resize(2 * nChan);
+      modelValidity.resize(2 * nChan);
+  }
+  // channel and beam in the bandpass cube, which may only cover a window
+  casacore::uInt bpChan = startChan;
+  casacore::uInt bpBeam = beam;
+  casacore::uInt bpStartChan = 0u;
+  casacore::uInt bpStartBeam = 0u;
+  const CubePair *bandpasses = model == NULL ? bandpassCubes(bpStartChan, bpStartBeam) : NULL;
+  if (bandpasses != NULL) {
+      ASKAPCHECK(startChan >= bpStartChan, "Requested channel "<<startChan<<
+                 " is outside the bandpass window starting at channel "<<bpStartChan);
+      ASKAPCHECK(beam >= bpStartBeam, "Requested beam "<<beam<<
+                 " is outside the bandpass window starting at beam "<<bpStartBeam);
+      bpChan -= bpStartChan;
+      bpBeam -= bpStartBeam;
+      checkBlock(*bandpasses, 2 * (bpChan + nChan), nAnt, bpBeam);
+  }
+  const JonesJTerm defaultBandpass(1., false, 1., false);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       // whole blocks of channels where either everything or nothing is valid are done without
+       // looking at individual flags, the result is the same as given by composeJones
+       const bool gainsValid = rangeValid(gains, itsFrozenGainValidity, 0u, 2u, ant, beam, true);
+       const bool leakagesValid = rangeValid(leakages, itsFrozenLeakageValidity, 0u, 2u, ant, beam, true);
+       if (!gainsValid && !leakagesValid && (model == NULL) &&
+           ((bandpasses == NULL) || rangeValid(bandpasses, itsFrozenBandpassValidity, 2 * bpChan, 2 * nChan, ant, bpBeam, false))) {
+           for (casacore::uInt chan = 0; chan < nChan; ++chan, jones += 4, ++validity) {
+                jones[0] = jones[3] = casacore::Complex(1., 0.);
+                jones[1] = jones[2] = casacore::Complex(0., 0.);
+                *validity = false;
+           }
+           continue;
+       }
+       if (gainsValid && leakagesValid && (bandpasses != NULL) &&
+           rangeValid(bandpasses, itsFrozenBandpassValidity, 2 * bpChan, 2 * nChan, ant, bpBeam, true)) {
+           const casacore::Complex g1 = gains->first(0, ant, beam);
+           const casacore::Complex g2 = gains->first(1, ant, beam);
+           const casacore::Complex j01 = leakages->first(0, ant, beam) * g1;
+           const casacore::Complex j10 = -leakages->first(1, ant, beam) * g2;
+           const casacore::Complex *bpValue = &bandpasses->first(2 * bpChan, ant, bpBeam);
+           for (casacore::uInt chan = 0; chan < nChan; ++chan, jones += 4, ++validity, bpValue += 2) {
+                jones[0] = g1 * bpValue[0];
+                jones[1] = j01 * bpValue[1];
+                jones[2] = j10 * bpValue[0];
+                jones[3] = g2 * bpValue[1];
+                *validity = true;
+           }
+           continue;
+       }
+       const JonesJTerm gTerm = gains == NULL ? JonesJTerm(1., false, 1., false) :
+             JonesJTerm(gains->first(0, ant, beam), gains->second(0, ant, beam),
+                        gains->first(1, ant, beam), gains->second(1, ant, beam));
+       const JonesDTerm dTerm = leakages == NULL ? JonesDTerm(0., false, 0., false) :
+             JonesDTerm(leakages->first(0, ant, beam), leakages->second(0, ant, beam),
+                        leakages->first(1, ant, beam), leakages->second(1, ant, beam));
+       if ((bandpasses == NULL) && (model == NULL)) {
+           for (casacore::uInt chan = 0; chan < nChan; ++chan, jones += 4, ++validity) {
+                *validity = composeJones(gTerm, defaultBandpass, dTerm, jones);
+           }
+       } else {
+           // bandpass values for the given antenna and beam are contiguous in memory
+           const casacore::Complex *bpValue = NULL;
+           const casacore::Bool *bpValid = NULL;
+           if (model != NULL) {
+               model->evaluate(ant, beam, startChan, nChan, modelValues.data(), modelValidity.data());
+               bpValue = modelValues.data();
+               bpValid = modelValidity.data();
+           } else {
+               bpValue = &bandpasses->first(2 * bpChan, ant, bpBeam);
+               bpValid = &bandpasses->second(2 * bpChan, ant, bpBeam);
+           }
+           for (casacore::uInt chan = 0; chan < nChan; ++chan, jones += 4, ++validity, bpValue += 2, bpValid += 2) {
+                *validity = composeJones(gTerm, JonesJTerm(bpValue[0], bpValid[0], bpValue[1], bpValid[1]), dTerm, jones);
+           }
+       }
+  }
+}
+
+/// @brief check validity of all constituents for a block of antennas and channels
+/// @details This version checks ranges of validity flags in the cached cubes (or their 
+/// bit-packed copies in the frozen mode) rather than going through the getters.
+/// @param[in] beam beam index
+/// @param[in] startAnt first antenna
+/// @param[in] nAnt number of antennas
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @return true, if gains, leakages and bandpasses are valid for the whole block
+bool MemCalSolutionAccessor::allValidBlock(const casacore::uInt beam, const casacore::uInt startAnt, 
+                const casacore::uInt nAnt, const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+  typedef std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > CubePair;
+  if (nAnt == 0) {
+      return true;
+  }
+  const CubePair *gains = gainCubes();
+  const CubePair *leakages = leakageCubes();
+  if ((gains == NULL) || (leakages == NULL)) {
+      return false;
+  }
+  checkBlock(*gains, 2, startAnt + nAnt, beam);
+  checkBlock(*leakages, 2, startAnt + nAnt, beam);
+  for (casacore::uInt ant = startAnt; ant < startAnt + nAnt; ++ant) {
+       if (!rangeValid(gains, itsFrozenGainValidity, 0u, 2u, ant, beam, true) || 
+           !rangeValid(leakages, itsFrozenLeakageValidity, 0u, 2u, ant, beam, true)) {
+           return false;
+       }
+  }
+  if (nChan == 0) {
+      return true;
+  }
+  const ParametricBandpass *model = bandpassModel();
+  if (model != NULL) {
+      ASKAPCHECK((startAnt + nAnt <= model->nAnt()) && (beam < model->nBeam()) && (startChan + nChan <= model->nChan()), 
+                 "Requested block (beam "<<beam<<", antennas "<<startAnt<<" to "<<startAnt + nAnt<<", channels "<<startChan<<
+                 " to "<<startChan + nChan<<") is outside the bandpass model");
+      // one flag per polarisation and block of channels
+      const casacore::uInt startRow = 2 * (startChan / model->chansPerBlock());
+      const casacore::uInt endRow = 2 * ((startChan + nChan - 1) / model->chansPerBlock() + 1);
+      for (casacore::uInt ant = startAnt; ant < startAnt + nAnt; ++ant) {
+           for (casacore::uInt row = startRow; row < endRow; ++row) {
+                if (!model->validity()(row, ant, beam)) {
+                    return false;
+                }
+           }
+      }
+      return true;
+  }
+  casacore::uInt bpStartChan = 0u;
+  casacore::uInt bpStartBeam = 0u;
+  const CubePair *bandpasses = bandpassCubes(bpStartChan, bpStartBeam);
+  if (bandpasses == NULL) {
+      return false;
+  }
+  ASKAPCHECK(startChan >= bpStartChan, "Requested channel "<<startChan<<
+             " is outside the bandpass window starting at channel "<<bpStartChan);
+  ASKAPCHECK(beam >= bpStartBeam, "Requested beam "<<beam<<
+             " is outside the bandpass window starting at beam "<<bpStartBeam);
+  const casacore::uInt bpChan = startChan - bpStartChan;
+  const casacore::uInt bpBeam = beam - bpStartBeam;
+  checkBlock(*bandpasses, 2 * (bpChan + nChan), startAnt + nAnt, bpBeam);
+  for (casacore::uInt ant = startAnt; ant < startAnt + nAnt; ++ant) {
+       if (!rangeValid(bandpasses, itsFrozenBandpassValidity, 2 * bpChan, 2 * nChan, ant, bpBeam, true)) {
+           return false;
+       }
+  }
+  return true;
+}
+
+/// @brief check that all validity flags in a range of rows have the given value
+/// @details In the frozen mode the bit-packed flags are used, otherwise the cube is scanned.
+/// The range should be within the cube (see checkBlock).
+/// @param[in] cubes pointer to the cube pair (NULL if the product is not defined)
+/// @param[in] packed bit-packed copy of the flags made by freeze
+/// @param[in] startRow first row
+/// @param[in] nRows number of rows
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @param[in] expected true to check that all flags are set, false to check that none is set
+/// @return true, if all flags in the range have the expected value (all flags of an
+/// undefined product are considered unset)
+bool MemCalSolutionAccessor::rangeValid(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >  *cubes,
+                   const PackedValidity &packed, const casacore::uInt startRow, const casacore::uInt nRows,
+                   const casacore::uInt ant, const casacore::uInt beam, const bool expected) const
+{
+  if (nRows == 0) {
+      return true;
+  }
+  if (cubes == NULL) {
+      return !expected;
+  }
+  if (itsFrozen) {
+      return expected ? packed.allValid(startRow, nRows, ant, beam) : packed.noneValid(startRow, nRows, ant, beam);
+  }
+  ASKAPDEBUGASSERT(startRow + nRows <= cubes->second.nrow());
+  ASKAPDEBUGASSERT(cubes->second.contiguousStorage());
+  const casacore::Bool *flags = &cubes->second(startRow, ant, beam);
+  return std::find(flags, flags + nRows, casacore::Bool(!expected)) == flags + nRows;
+}
+
+/// @brief check that the block of antennas and beam is within the cache
+/// @param[in] cubes const reference to a cube pair
+/// @param[in] nRow number of rows required
+/// @param[in] nAnt number of antennas required
+/// @param[in] beam beam index
+void MemCalSolutionAccessor::checkBlock(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >  &cubes,
+                   const casacore::uInt nRow, const casacore::uInt nAnt, const casacore::uInt beam)
+{
+  ASKAPDEBUGASSERT(cubes.first.shape() == cubes.second.shape());
+  ASKAPDEBUGASSERT(cubes.first.contiguousStorage() && cubes.second.contiguousStorage());
+  ASKAPCHECK(nRow <= cubes.first.nrow(), "Requested channel range is outside the shape of the cache: "<<cubes.first.shape());
+  ASKAPCHECK(nAnt <= cubes.first.ncolumn(), "Requested number of antennas "<<nAnt<<" is outside the shape of the cache: "<<cubes.first.shape());
+  ASKAPCHECK(beam < cubes.first.nplane(), "Requested beam index "<<beam<<" is outside the shape of the cache: "<<cubes.first.shape());
+}
+
+/// @brief obtain cached gains, reading them on demand
+/// @return pointer to the cube pair or NULL if gains are not defined
+const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* MemCalSolutionAccessor::gainCubes() const
+{
+  if (itsFrozen) {
+      CalibrationStatistics::instance().cacheHit();
+      return itsFrozenGains;
+  }
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noGain() && !itsGains.flushNeeded()) {
+      return NULL;
+  }
+  countCacheAccess(itsGains);
+  return &itsGains.value(*itsSolutionFiller, &ICalSolutionFiller::fillGains);
+}
+
+/// @brief obtain cached leakages, reading them on demand
+/// @return pointer to the cube pair or NULL if leakages are not defined
+const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* MemCalSolutionAccessor::leakageCubes() const
+{
+  if (itsFrozen) {
+      CalibrationStatistics::instance().cacheHit();
+      return itsFrozenLeakages;
+  }
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noLeakage() && !itsLeakages.flushNeeded()) {
+      return NULL;
+  }
+  countCacheAccess(itsLeakages);
+  return &itsLeakages.value(*itsSolutionFiller, &ICalSolutionFiller::fillLeakages);
+}
+
+/// @brief obtain cached bandpasses, reading them on demand
+/// @param[out] startChan first channel in the cache
+/// @param[out] startBeam first beam in the cache
+/// @return pointer to the cube pair or NULL if bandpasses are not defined
+const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* MemCalSolutionAccessor::bandpassCubes(casacore::uInt &startChan,
+                   casacore::uInt &startBeam) const
+{
+  if (itsFrozen) {
+      startChan = itsFrozenBPStartChan;
+      startBeam = itsFrozenBPStartBeam;
+      CalibrationStatistics::instance().cacheHit();
+      return itsFrozenBandpasses;
+  }
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noBandpass() && !itsBandpasses.flushNeeded()) {
+      return NULL;
+  }
+  countCacheAccess(itsBandpasses);
+  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* bp = 
+        &itsBandpasses.value(*itsSolutionFiller, &ICalSolutionFiller::fillBandpasses);
+  startChan = itsSolutionFiller->bandpassStartChannel();
+  startBeam = itsSolutionFiller->bandpassStartBeam();
+  return bp;
+}
+
+/// @brief obtain cached bandpass model, reading it on demand
+/// @return pointer to the model or NULL if bandpasses are given by the cubes
+const ParametricBandpass* MemCalSolutionAccessor::bandpassModel() const
+{
+  if (itsFrozen) {
+      CalibrationStatistics::instance().cacheHit();
+      return itsFrozenBandpassModel;
+  }
+  ASKAPASSERT(itsSolutionFiller);
+  // per-channel bandpasses set via this accessor take precedence, as they do in the table
+  if (itsBandpasses.flushNeeded()) {
+      return NULL;
+  }
+  countCacheAccess(itsBandpassModel);
+  return itsBandpassModel.value(*itsSolutionFiller, &ICalSolutionFiller::fillBandpassModel).get();
+}
+
+/// @brief check that setters can be used
+void MemCalSolutionAccessor::checkSettersAllowed() const
+{
+  ASKAPCHECK(itsSettersAllowed, "Setters methods are now allowed - roCheck=true in the constructor");
+  ASKAPCHECK(!itsFrozen, "Setters methods are not allowed after the accessor has been frozen");
+  ASKAPASSERT(itsSolutionFiller);
+}
+
+/// @brief read all calibration products
+/// @details This method fills gain, leakage and bandpass caches (unless the filler
+/// reports that the product is not defined), so subsequent reads don't need to access 
+/// the filler.
+void MemCalSolutionAccessor::preload() const
+{
+  casacore::uInt startChan = 0u;
+  casacore::uInt startBeam = 0u;
+  gainCubes();
+  leakageCubes();
+  if (bandpassModel() == NULL) {
+      bandpassCubes(startChan, startBeam);
+  }
+}
+
+/// @brief make the accessor read-only
+/// @details This method calls preload and switches the accessor to the frozen mode where
+/// getters access the cached cubes directly without any locking. Validity flags are packed
+/// into bits for the fast block checks. It is intended to be called
+/// before the accessor is shared between threads. Setters throw an exception in the frozen
+/// mode. Values written before this call are still flushed at the end.
+void MemCalSolutionAccessor::freeze()
+{
+  if (itsFrozen) {
+      return;
+  }
+  itsFrozenGains = gainCubes();
+  itsFrozenLeakages = leakageCubes();
+  itsFrozenBandpassModel = bandpassModel();
+  if (itsFrozenBandpassModel == NULL) {
+      itsFrozenBandpasses = bandpassCubes(itsFrozenBPStartChan, itsFrozenBPStartBeam);
+  }
+  if (itsFrozenGains != NULL) {
+      itsFrozenGainValidity.assign(itsFrozenGains->second);
+  }
+  if (itsFrozenLeakages != NULL) {
+      itsFrozenLeakageValidity.assign(itsFrozenLeakages->second);
+  }
+  if (itsFrozenBandpasses != NULL) {
+      itsFrozenBandpassValidity.assign(itsFrozenBandpasses->second);
+  }
+  itsFrozen = true;
+}
+
 /// @details helper method to set the value and validity flag for a given ant/beam pair
 /// @param[in] cubes non-const reference to a cube pair
 /// @param[in] val const reference to the value
@@ -232,6 +711,11 @@ void MemCalSolutionAccessor::syncCache() const
           itsSolutionFiller->writeBandpasses(itsBandpasses.value());
           itsBandpasses.flushed();
       }
+      if (itsBandpassModel.flushNeeded()) {
+          ASKAPCHECK(itsBandpassModel.value(), "Empty bandpass model is not expected to be flushed");
+          itsSolutionFiller->writeBandpassModel(*itsBandpassModel.value());
+          itsBandpassModel.flushed();
+      }
   }
 }
 
@@ -41,6 +41,7 @@
 #include <askap/calibaccess/ICalSolutionAccessor.h>
 #include <askap/dataaccess/CachedAccessorField.h>
 #include <askap/calibaccess/ICalSolutionFiller.h>
+#include <askap/calibaccess/PackedValidity.h>
 
 // casa includes
 #include <casacore/casa/Arrays/Cube.h>
@@ -64,6 +65,13 @@ namespace accessors {
 /// resizing of the cache is done in the method which fills the cache (i.e. methods of solution
 /// source), rather than inside this class. This class is intended to be
 /// used in the table-based implementation of the calibration solution interface.
+/// Read access is synchronised by the cache fields when built with OpenMP. If many threads
+/// share one accessor, all products can be read up front with preload() and the accessor can be 
+/// made read-only with freeze(). The frozen accessor bypasses the cache fields, so concurrent 
+/// readers don't pay for the synchronisation. It also keeps bit-packed copies of the validity
+/// flags (see PackedValidity), so whole channel ranges are checked 64 flags at a time. If the 
+/// filler provides a parametric bandpass model (see ParametricBandpass), bandpasses are evaluated
+/// from the model on demand and the full resolution cube is not read.
 /// @ingroup calibaccess
 class MemCalSolutionAccessor : virtual public ICalSolutionAccessor {
 
@@ -144,6 +152,12 @@ public:
    /// gains set explicitly for each channel.
    virtual void setBandpass(const JonesIndex &index, const JonesJTerm &bp, const casacore::uInt chan);
 
+   /// @brief set bandpasses given in the parametric form
+   /// @details The model is stored as it is (via the filler) rather than evaluated for each channel.
+   /// Per-channel bandpasses set via this accessor take precedence over the model.
+   /// @param[in] model parametric bandpass
+   virtual void setBandpassModel(const ParametricBandpass &model);
+
    /// @brief write back cache, if necessary
    /// @details This method checks whether caches need flush and calls appropriate methods of the filler
    void syncCache() const;
@@ -151,9 +165,109 @@ public:
    /// @brief flush the underlying Filler - if necessary
    virtual bool flushFiller();
 
+   /// @brief read all calibration products
+   /// @details This method fills gain, leakage and bandpass caches (unless the filler
+   /// reports that the product is not defined), so subsequent reads don't need to access 
+   /// the filler.
+   void preload() const;
+
+   /// @brief make the accessor read-only
+   /// @details This method calls preload and switches the accessor to the frozen mode where
+   /// getters access the cached cubes directly without any locking. Validity flags are packed
+   /// into bits for the fast block checks. It is intended to be called
+   /// before the accessor is shared between threads. Setters throw an exception in the frozen
+   /// mode. Values written before this call are still flushed at the end.
+   void freeze();
+
+   /// @brief check whether the accessor is frozen
+   /// @return true, if freeze has been called
+   inline bool isFrozen() const { return itsFrozen; }
+
+   /// @brief memory used by the cached solutions
+   /// @details Only the cubes which have been read so far are counted
+   /// @return number of bytes held by the gain, leakage and bandpass caches (including the bandpass model)
+   size_t memoryUsage() const;
+
    /// @brief shared pointer definition
    typedef boost::shared_ptr<MemCalSolutionAccessor> ShPtr;
 protected:
+   /// @brief fill Jones matrices for all antennas of one beam in a range of channels
+   /// @details This version reads the cached cubes directly, without going through
+   /// gain, leakage and bandpass methods for each element.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] jones pointer to 4 * nChan * nAnt elements to fill in the order of jonesBlock
+   /// @param[out] validity pointer to nChan * nAnt validity flags to fill
+   virtual void fillJonesBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                   const casacore::uInt nChan, casacore::Complex *jones, casacore::Bool *validity) const;
+
+   /// @brief check validity of all constituents for a block of antennas and channels
+   /// @details This version checks ranges of validity flags in the cached cubes (or their 
+   /// bit-packed copies in the frozen mode) rather than going through the getters.
+   /// @param[in] beam beam index
+   /// @param[in] startAnt first antenna
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @return true, if gains, leakages and bandpasses are valid for the whole block
+   virtual bool allValidBlock(const casacore::uInt beam, const casacore::uInt startAnt, const casacore::uInt nAnt,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const;
+
+   /// @brief write gains for all antennas of one beam
+   /// @details This version copies the block straight into the cached cube.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] gains pointer to 2 * nAnt gains in the order of setGains
+   /// @param[in] validity pointer to 2 * nAnt validity flags
+   virtual void writeGainBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::Complex *gains,
+                               const casacore::Bool *validity);
+
+   /// @brief write leakages for all antennas of one beam
+   /// @details This version copies the block straight into the cached cube.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] leakages pointer to 2 * nAnt leakages in the order of setLeakages
+   /// @param[in] validity pointer to 2 * nAnt validity flags
+   virtual void writeLeakageBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::Complex *leakages,
+                                  const casacore::Bool *validity);
+
+   /// @brief write bandpasses for all antennas of one beam in a range of channels
+   /// @details This version copies the channel range of each antenna straight into the cached cube.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[in] bp pointer to 2 * nChan * nAnt bandpass gains in the order of setBandpasses
+   /// @param[in] validity pointer to 2 * nChan * nAnt validity flags
+   virtual void writeBandpassBlock(const casacore::uInt beam, const casacore::uInt nAnt, const casacore::uInt startChan,
+                                   const casacore::uInt nChan, const casacore::Complex *bp, const casacore::Bool *validity);
+
+   /// @brief check that the block of antennas and beam is within the cache
+   /// @param[in] cubes const reference to a cube pair
+   /// @param[in] nRow number of rows required
+   /// @param[in] nAnt number of antennas required
+   /// @param[in] beam beam index
+   static void checkBlock(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >  &cubes,
+                   const casacore::uInt nRow, const casacore::uInt nAnt, const casacore::uInt beam);
+
+   /// @brief check that all validity flags in a range of rows have the given value
+   /// @details In the frozen mode the bit-packed flags are used, otherwise the cube is scanned.
+   /// The range should be within the cube (see checkBlock).
+   /// @param[in] cubes pointer to the cube pair (NULL if the product is not defined)
+   /// @param[in] packed bit-packed copy of the flags made by freeze
+   /// @param[in] startRow first row
+   /// @param[in] nRows number of rows
+   /// @param[in] ant antenna index
+   /// @param[in] beam beam index
+   /// @param[in] expected true to check that all flags are set, false to check that none is set
+   /// @return true, if all flags in the range have the expected value (all flags of an
+   /// undefined product are considered unset)
+   bool rangeValid(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >  *cubes,
+                   const PackedValidity &packed, const casacore::uInt startRow, const casacore::uInt nRows,
+                   const casacore::uInt ant, const casacore::uInt beam, const bool expected) const;
+
    /// @details helper method to extract value and validity flag for a given ant/beam pair
    /// @param[in] cubes const reference to a cube pair
    /// @param[in] row polarisation/channel index (row of the cube)
@@ -172,6 +286,28 @@ protected:
                    const casacore::Complex &val, const casacore::Bool isValid,
                    const casacore::uInt row, const JonesIndex &index);
 
+   /// @brief obtain cached gains, reading them on demand
+   /// @return pointer to the cube pair or NULL if gains are not defined
+   const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* gainCubes() const;
+
+   /// @brief obtain cached leakages, reading them on demand
+   /// @return pointer to the cube pair or NULL if leakages are not defined
+   const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* leakageCubes() const;
+
+   /// @brief obtain cached bandpasses, reading them on demand
+   /// @param[out] startChan first channel in the cache
+   /// @param[out] startBeam first beam in the cache
+   /// @return pointer to the cube pair or NULL if bandpasses are not defined
+   const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >* bandpassCubes(casacore::uInt &startChan,
+                   casacore::uInt &startBeam) const;
+
+   /// @brief obtain cached bandpass model, reading it on demand
+   /// @return pointer to the model or NULL if bandpasses are given by the cubes
+   const ParametricBandpass* bandpassModel() const;
+
+   /// @brief check that setters can be used
+   void checkSettersAllowed() const;
+
 private:
    // cache fields
 
@@ -184,12 +320,45 @@ private:
    /// @brief bandpasses and validity flags ((2*nChan) x nAnt x nBeam), rows are XX chan 0, YX
    CachedAccessorField<std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > >  itsBandpasses;
 
+   /// @brief parametric bandpass model (empty shared pointer if bandpasses are given by the cubes)
+   CachedAccessorField<boost::shared_ptr<ParametricBandpass> > itsBandpassModel;
+
    /// @brief shared pointer to the filler which knows how to write and read cubes
    const boost::shared_ptr<ICalSolutionFiller> itsSolutionFiller;
 
    /// @brief flag, if false an exception is thrown in setter methods
    const bool itsSettersAllowed;
 
+   /// @brief true, if the accessor is frozen (see freeze)
+   bool itsFrozen;
+
+   /// @brief gains captured by freeze (NULL if not defined)
+   const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > *itsFrozenGains;
+
+   /// @brief leakages captured by freeze (NULL if not defined)
+   const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > *itsFrozenLeakages;
+
+   /// @brief bandpasses captured by freeze (NULL if not defined)
+   const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > *itsFrozenBandpasses;
+
+   /// @brief bandpass model captured by freeze (NULL if not defined)
+   const ParametricBandpass *itsFrozenBandpassModel;
+
+   /// @brief first bandpass channel in the cache captured by freeze
+   casacore::uInt itsFrozenBPStartChan;
+
+   /// @brief first bandpass beam in the cache captured by freeze
+   casacore::uInt itsFrozenBPStartBeam;
+
+   /// @brief bit-packed gain validity flags made by freeze
+   PackedValidity itsFrozenGainValidity;
+
+   /// @brief bit-packed leakage validity flags made by freeze
+   PackedValidity itsFrozenLeakageValidity;
+
+   /// @brief bit-packed bandpass validity flags made by freeze
+   PackedValidity itsFrozenBandpassValidity;
+
 }; // class MemCalSolutionAccessor
 
 } // namespace accessors
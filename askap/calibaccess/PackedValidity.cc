@@ -0,0 +1,202 @@
+/// @file
+/// @brief bit-packed validity flags of calibration solutions
+/// @details Validity flags of gains, leakages and bandpasses are stored as casacore::Cube<Bool>
+/// with one byte per element. This class holds the same flags with one bit per element, so 
+/// a whole range of rows (e.g. all channels of one antenna and beam) can be checked 64 elements
+/// at a time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/calibaccess/PackedValidity.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief mask with the given range of bits set
+/// @param[in] first first bit
+/// @param[in] n number of bits (first + n should not exceed 64)
+/// @return the mask
+inline casacore::uInt64 bitMask(casacore::uInt first, casacore::uInt n)
+{
+  const casacore::uInt64 bits = n >= 64 ? ~casacore::uInt64(0) : ((casacore::uInt64(1) << n) - 1);
+  return bits << first;
+}
+
+} // anonymous namespace
+
+/// @brief empty flags
+PackedValidity::PackedValidity() : itsNRow(0u), itsNAnt(0u), itsNBeam(0u), itsWordsPerColumn(0u) {}
+
+/// @brief pack the validity cube
+/// @param[in] validity validity flags (nRow x nAnt x nBeam)
+PackedValidity::PackedValidity(const casacore::Cube<casacore::Bool> &validity) : 
+   itsNRow(0u), itsNAnt(0u), itsNBeam(0u), itsWordsPerColumn(0u)
+{
+  assign(validity);
+}
+
+/// @brief pack the validity cube replacing the current content
+/// @param[in] validity validity flags (nRow x nAnt x nBeam)
+void PackedValidity::assign(const casacore::Cube<casacore::Bool> &validity)
+{
+  itsNRow = validity.nrow();
+  itsNAnt = validity.ncolumn();
+  itsNBeam = validity.nplane();
+  itsWordsPerColumn = (size_t(itsNRow) + 63) / 64;
+  itsWords.assign(itsWordsPerColumn * itsNAnt * itsNBeam, 0u);
+  for (casacore::uInt beam = 0; beam < itsNBeam; ++beam) {
+       for (casacore::uInt ant = 0; ant < itsNAnt; ++ant) {
+            casacore::uInt64 *words = &itsWords[wordOffset(ant, beam)];
+            for (casacore::uInt row = 0; row < itsNRow; ++row) {
+                 if (validity(row, ant, beam)) {
+                     words[row / 64] |= casacore::uInt64(1) << (row % 64);
+                 }
+            }
+       }
+  }
+}
+
+/// @brief unpack the flags into a cube
+/// @param[out] validity cube to fill (resized as required)
+void PackedValidity::unpack(casacore::Cube<casacore::Bool> &validity) const
+{
+  validity.resize(itsNRow, itsNAnt, itsNBeam);
+  for (casacore::uInt beam = 0; beam < itsNBeam; ++beam) {
+       for (casacore::uInt ant = 0; ant < itsNAnt; ++ant) {
+            for (casacore::uInt row = 0; row < itsNRow; ++row) {
+                 validity(row, ant, beam) = (*this)(row, ant, beam);
+            }
+       }
+  }
+}
+
+/// @brief set one flag
+/// @param[in] row row (polarisation/channel index)
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @param[in] isValid new value of the flag
+void PackedValidity::set(casacore::uInt row, casacore::uInt ant, casacore::uInt beam, bool isValid)
+{
+  checkRange(row, 1u, ant, beam);
+  casacore::uInt64 &word = itsWords[wordOffset(ant, beam) + row / 64];
+  const casacore::uInt64 mask = casacore::uInt64(1) << (row % 64);
+  if (isValid) {
+      word |= mask;
+  } else {
+      word &= ~mask;
+  }
+}
+
+/// @brief check that all flags in a range of rows are set
+/// @param[in] startRow first row
+/// @param[in] nRows number of rows
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @return true if all flags in the range are set (or the range is empty)
+bool PackedValidity::allValid(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt ant, casacore::uInt beam) const
+{
+  return rangeEquals(startRow, nRows, ant, beam, true);
+}
+
+/// @brief check that no flags in a range of rows are set
+/// @param[in] startRow first row
+/// @param[in] nRows number of rows
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @return true if none of the flags in the range is set
+bool PackedValidity::noneValid(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt ant, casacore::uInt beam) const
+{
+  return rangeEquals(startRow, nRows, ant, beam, false);
+}
+
+/// @brief check that all flags in a range of rows are set for a number of antennas
+/// @param[in] startRow first row
+/// @param[in] nRows number of rows
+/// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+/// @param[in] beam beam index
+/// @return true if all flags in the block are set
+bool PackedValidity::allValidForBeam(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt nAnt, 
+                                     casacore::uInt beam) const
+{
+  ASKAPCHECK(nAnt <= itsNAnt, "Requested number of antennas "<<nAnt<<" exceeds "<<itsNAnt<<" antennas of the validity flags");
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       if (!rangeEquals(startRow, nRows, ant, beam, true)) {
+           return false;
+       }
+  }
+  return true;
+}
+
+/// @brief check that the range of rows and the antenna/beam pair are within the shape
+/// @param[in] startRow first row
+/// @param[in] nRows number of rows
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+void PackedValidity::checkRange(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt ant, casacore::uInt beam) const
+{
+  ASKAPCHECK(size_t(startRow) + nRows <= itsNRow, "Requested rows "<<startRow<<" to "<<size_t(startRow) + nRows<<
+             " are outside "<<itsNRow<<" rows of the validity flags");
+  ASKAPCHECK(ant < itsNAnt, "Requested antenna index "<<ant<<" is outside "<<itsNAnt<<" antennas of the validity flags");
+  ASKAPCHECK(beam < itsNBeam, "Requested beam index "<<beam<<" is outside "<<itsNBeam<<" beams of the validity flags");
+}
+
+/// @brief check that all flags in a range of rows have the given value
+/// @details This is the common code of allValid and noneValid
+/// @param[in] startRow first row
+/// @param[in] nRows number of rows
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @param[in] expected true to check for set flags, false to check for unset flags
+/// @return true if all flags in the range have the expected value
+bool PackedValidity::rangeEquals(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt ant, casacore::uInt beam,
+                                 bool expected) const
+{
+  checkRange(startRow, nRows, ant, beam);
+  const casacore::uInt64 *words = &itsWords[wordOffset(ant, beam)];
+  const casacore::uInt64 pattern = expected ? ~casacore::uInt64(0) : casacore::uInt64(0);
+  casacore::uInt row = startRow;
+  const casacore::uInt endRow = startRow + nRows;
+  while (row < endRow) {
+     const casacore::uInt bit = row % 64;
+     const casacore::uInt n = std::min(64u - bit, endRow - row);
+     const casacore::uInt64 mask = bitMask(bit, n);
+     if ((words[row / 64] & mask) != (pattern & mask)) {
+         return false;
+     }
+     row += n;
+  }
+  return true;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,164 @@
+/// @file
+/// @brief bit-packed validity flags of calibration solutions
+/// @details Validity flags of gains, leakages and bandpasses are stored as casacore::Cube<Bool>
+/// with one byte per element. This class holds the same flags with one bit per element, so 
+/// a whole range of rows (e.g. all channels of one antenna and beam) can be checked 64 elements
+/// at a time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_PACKED_VALIDITY_H
+#define ASKAP_ACCESSORS_PACKED_VALIDITY_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief bit-packed validity flags of calibration solutions
+/// @details The flags have the shape of the validity cube they are built from (nRow x nAnt x nBeam).
+/// Rows of each antenna/beam pair are packed into 64-bit words starting at a word boundary, 
+/// so rows 2*chan and 2*chan+1 of the bandpass cube (both polarisations of one channel) are
+/// adjacent bits and a channel range is a contiguous range of bits. Unused bits of the last word
+/// of each antenna/beam pair are always zero.
+/// @ingroup calibaccess
+class PackedValidity {
+public:
+  /// @brief empty flags
+  PackedValidity();
+
+  /// @brief pack the validity cube
+  /// @param[in] validity validity flags (nRow x nAnt x nBeam)
+  explicit PackedValidity(const casacore::Cube<casacore::Bool> &validity);
+
+  /// @brief pack the validity cube replacing the current content
+  /// @param[in] validity validity flags (nRow x nAnt x nBeam)
+  void assign(const casacore::Cube<casacore::Bool> &validity);
+
+  /// @brief unpack the flags into a cube
+  /// @param[out] validity cube to fill (resized as required)
+  void unpack(casacore::Cube<casacore::Bool> &validity) const;
+
+  /// @brief obtain one flag
+  /// @param[in] row row (polarisation/channel index)
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @return validity flag
+  inline bool operator()(casacore::uInt row, casacore::uInt ant, casacore::uInt beam) const
+     { return (itsWords[wordOffset(ant, beam) + row / 64] >> (row % 64)) & 1u; }
+
+  /// @brief set one flag
+  /// @param[in] row row (polarisation/channel index)
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @param[in] isValid new value of the flag
+  void set(casacore::uInt row, casacore::uInt ant, casacore::uInt beam, bool isValid);
+
+  /// @brief check that all flags in a range of rows are set
+  /// @param[in] startRow first row
+  /// @param[in] nRows number of rows
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @return true if all flags in the range are set (or the range is empty)
+  bool allValid(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt ant, casacore::uInt beam) const;
+
+  /// @brief check that no flags in a range of rows are set
+  /// @param[in] startRow first row
+  /// @param[in] nRows number of rows
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @return true if none of the flags in the range is set
+  bool noneValid(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt ant, casacore::uInt beam) const;
+
+  /// @brief check that all flags in a range of rows are set for a number of antennas
+  /// @param[in] startRow first row
+  /// @param[in] nRows number of rows
+  /// @param[in] nAnt number of antennas (indices 0 to nAnt-1)
+  /// @param[in] beam beam index
+  /// @return true if all flags in the block are set
+  bool allValidForBeam(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt nAnt, casacore::uInt beam) const;
+
+  /// @brief number of rows
+  inline casacore::uInt nrow() const { return itsNRow; }
+
+  /// @brief number of antennas
+  inline casacore::uInt ncolumn() const { return itsNAnt; }
+
+  /// @brief number of beams
+  inline casacore::uInt nplane() const { return itsNBeam; }
+
+  /// @brief memory used by the flags
+  /// @return number of bytes
+  inline size_t memoryUsage() const { return itsWords.size() * sizeof(casacore::uInt64); }
+
+private:
+  /// @brief offset of the first word for the given antenna and beam
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @return index of the word in itsWords
+  inline size_t wordOffset(casacore::uInt ant, casacore::uInt beam) const
+     { return (size_t(beam) * itsNAnt + ant) * itsWordsPerColumn; }
+
+  /// @brief check that the range of rows and the antenna/beam pair are within the shape
+  /// @param[in] startRow first row
+  /// @param[in] nRows number of rows
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  void checkRange(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt ant, casacore::uInt beam) const;
+
+  /// @brief check that all flags in a range of rows have the given value
+  /// @details This is the common code of allValid and noneValid
+  /// @param[in] startRow first row
+  /// @param[in] nRows number of rows
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @param[in] expected true to check for set flags, false to check for unset flags
+  /// @return true if all flags in the range have the expected value
+  bool rangeEquals(casacore::uInt startRow, casacore::uInt nRows, casacore::uInt ant, casacore::uInt beam, 
+                   bool expected) const;
+
+  /// @brief number of rows
+  casacore::uInt itsNRow;
+  /// @brief number of antennas
+  casacore::uInt itsNAnt;
+  /// @brief number of beams
+  casacore::uInt itsNBeam;
+  /// @brief number of words per antenna/beam pair
+  size_t itsWordsPerColumn;
+  /// @brief packed flags
+  std::vector<casacore::uInt64> itsWords;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PACKED_VALIDITY_H
@@ -0,0 +1,341 @@
+/// @file
+/// @brief compact parametric representation of the bandpass
+/// @details Smooth bandpasses can be approximated by low order polynomials over blocks
+/// of adjacent channels (e.g. 1 MHz worth of channels). This class holds the polynomial
+/// coefficients for each antenna, beam, polarisation and block of channels and evaluates
+/// the bandpass on demand. Compared to the full resolution (2*nChan) x nAnt x nBeam cube,
+/// the memory footprint is reduced by the ratio of the block size to the number of coefficients.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/calibaccess/ParametricBandpass.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief solve normal equations in place
+/// @details Gaussian elimination with partial pivoting is used, the system is tiny
+/// (order + 1 unknowns), so nothing fancy is required.
+/// @param[in] matrix n x n matrix of the normal equations (row-major), destroyed on output
+/// @param[in] rhs right hand side, replaced by the solution on output
+/// @param[in] n number of unknowns
+/// @return false, if the matrix is singular
+bool solveNormalEquations(std::vector<double> &matrix, std::vector<casacore::DComplex> &rhs, const size_t n)
+{
+  double maxDiag = 0.;
+  for (size_t i = 0; i < n; ++i) {
+       maxDiag = std::max(maxDiag, std::abs(matrix[i * n + i]));
+  }
+  if (maxDiag <= 0.) {
+      return false;
+  }
+  for (size_t col = 0; col < n; ++col) {
+       size_t pivot = col;
+       for (size_t row = col + 1; row < n; ++row) {
+            if (std::abs(matrix[row * n + col]) > std::abs(matrix[pivot * n + col])) {
+                pivot = row;
+            }
+       }
+       if (std::abs(matrix[pivot * n + col]) < 1e-12 * maxDiag) {
+           return false;
+       }
+       if (pivot != col) {
+           for (size_t k = 0; k < n; ++k) {
+                std::swap(matrix[pivot * n + k], matrix[col * n + k]);
+           }
+           std::swap(rhs[pivot], rhs[col]);
+       }
+       for (size_t row = col + 1; row < n; ++row) {
+            const double factor = matrix[row * n + col] / matrix[col * n + col];
+            for (size_t k = col; k < n; ++k) {
+                 matrix[row * n + k] -= factor * matrix[col * n + k];
+            }
+            rhs[row] -= factor * rhs[col];
+       }
+  }
+  for (size_t col = n; col > 0; --col) {
+       const size_t row = col - 1;
+       for (size_t k = col; k < n; ++k) {
+            rhs[row] -= matrix[row * n + k] * rhs[k];
+       }
+       rhs[row] /= matrix[row * n + row];
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+/// @brief empty model
+ParametricBandpass::ParametricBandpass() : itsNChan(0u), itsChansPerBlock(0u), itsOrder(0u) {}
+
+/// @brief construct the model with all polynomials undefined
+/// @param[in] nChan number of spectral channels
+/// @param[in] chansPerBlock number of channels per block
+/// @param[in] order polynomial order
+/// @param[in] nAnt number of antennas
+/// @param[in] nBeam number of beams
+ParametricBandpass::ParametricBandpass(const casacore::uInt nChan, const casacore::uInt chansPerBlock, 
+                     const casacore::uInt order, const casacore::uInt nAnt, const casacore::uInt nBeam) :
+       itsNChan(nChan), itsChansPerBlock(chansPerBlock), itsOrder(order)
+{
+  ASKAPCHECK(nChan > 0, "Number of channels of the parametric bandpass should be positive");
+  ASKAPCHECK(chansPerBlock > 0, "Number of channels per block of the parametric bandpass should be positive");
+  itsCoeffs.resize((order + 1) * 2 * nBlock(), nAnt, nBeam);
+  itsCoeffs.set(0.);
+  itsValidity.resize(2 * nBlock(), nAnt, nBeam);
+  itsValidity.set(false);
+}
+
+/// @brief construct the model from the stored coefficients
+/// @param[in] nChan number of spectral channels
+/// @param[in] chansPerBlock number of channels per block
+/// @param[in] order polynomial order
+/// @param[in] coeffs coefficients, (nCoeff*2*nBlock) x nAnt x nBeam cube
+/// @param[in] validity validity flags, (2*nBlock) x nAnt x nBeam cube
+ParametricBandpass::ParametricBandpass(const casacore::uInt nChan, const casacore::uInt chansPerBlock, 
+                     const casacore::uInt order, const casacore::Cube<casacore::Complex> &coeffs,
+                     const casacore::Cube<casacore::Bool> &validity) :
+       itsNChan(nChan), itsChansPerBlock(chansPerBlock), itsOrder(order), itsCoeffs(coeffs.copy()),
+       itsValidity(validity.copy())
+{
+  ASKAPCHECK(nChan > 0, "Number of channels of the parametric bandpass should be positive");
+  ASKAPCHECK(chansPerBlock > 0, "Number of channels per block of the parametric bandpass should be positive");
+  ASKAPCHECK((coeffs.nrow() == (order + 1) * 2 * nBlock()) && (validity.nrow() == 2 * nBlock()) && 
+             (coeffs.ncolumn() == validity.ncolumn()) && (coeffs.nplane() == validity.nplane()),
+             "Shapes of the coefficient ("<<coeffs.shape()<<") and validity ("<<validity.shape()<<
+             ") cubes don't match nChan="<<nChan<<", chansPerBlock="<<chansPerBlock<<" and order="<<order);
+}
+
+/// @brief copy constructor
+/// @details Unlike casacore arrays, the copy doesn't share storage with the original
+/// @param[in] other model to copy
+ParametricBandpass::ParametricBandpass(const ParametricBandpass &other) : itsNChan(other.itsNChan),
+       itsChansPerBlock(other.itsChansPerBlock), itsOrder(other.itsOrder), itsCoeffs(other.itsCoeffs.copy()),
+       itsValidity(other.itsValidity.copy()) {}
+
+/// @brief assignment operator
+/// @details Unlike casacore arrays, the copy doesn't share storage with the original
+/// @param[in] other model to copy
+/// @return reference to this object
+ParametricBandpass& ParametricBandpass::operator=(const ParametricBandpass &other)
+{
+  if (this != &other) {
+      itsNChan = other.itsNChan;
+      itsChansPerBlock = other.itsChansPerBlock;
+      itsOrder = other.itsOrder;
+      itsCoeffs.reference(other.itsCoeffs.copy());
+      itsValidity.reference(other.itsValidity.copy());
+  }
+  return *this;
+}
+
+/// @brief fit the model to the full resolution bandpass
+/// @details Polynomials are fitted by least squares to the valid channels of each block.
+/// A polynomial is flagged if the block has fewer valid channels than coefficients.
+/// @param[in] bp pair of cubes with bandpasses and validity flags ((2*nChan) x nAnt x nBeam)
+/// @param[in] chansPerBlock number of channels per block
+/// @param[in] order polynomial order
+/// @return fitted model
+ParametricBandpass ParametricBandpass::fit(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp,
+                                const casacore::uInt chansPerBlock, const casacore::uInt order)
+{
+  ASKAPCHECK(bp.first.shape() == bp.second.shape(), "The cubes with bandpasses and validity flags are expected to have the same shape");
+  ASKAPCHECK(bp.first.nrow() % 2 == 0, "The bandpass cube is expected to have 2*nChan rows, you have "<<bp.first.shape());
+  ParametricBandpass result(bp.first.nrow() / 2, chansPerBlock, order, bp.first.ncolumn(), bp.first.nplane());
+  const size_t nCoeff = order + 1;
+  std::vector<double> normal(nCoeff * nCoeff);
+  std::vector<casacore::DComplex> rhs(nCoeff);
+  std::vector<double> powers(nCoeff);
+  casacore::Vector<casacore::Complex> coeffs(nCoeff);
+  for (casacore::uInt beam = 0; beam < result.nBeam(); ++beam) {
+       for (casacore::uInt ant = 0; ant < result.nAnt(); ++ant) {
+            for (casacore::uInt block = 0; block < result.nBlock(); ++block) {
+                 const casacore::uInt blockStart = block * chansPerBlock;
+                 const casacore::uInt blockEnd = std::min(blockStart + chansPerBlock, result.nChan());
+                 const double scale = blockEnd - blockStart > 1 ? 2. / double(blockEnd - blockStart - 1) : 0.;
+                 for (casacore::uInt pol = 0; pol < 2; ++pol) {
+                      std::fill(normal.begin(), normal.end(), 0.);
+                      std::fill(rhs.begin(), rhs.end(), casacore::DComplex(0.));
+                      size_t nValid = 0;
+                      for (casacore::uInt chan = blockStart; chan < blockEnd; ++chan) {
+                           if (!bp.second(2 * chan + pol, ant, beam)) {
+                               continue;
+                           }
+                           const double x = scale * double(chan - blockStart) - 1.;
+                           powers[0] = 1.;
+                           for (size_t k = 1; k < nCoeff; ++k) {
+                                powers[k] = powers[k - 1] * x;
+                           }
+                           const casacore::DComplex value(bp.first(2 * chan + pol, ant, beam));
+                           for (size_t i = 0; i < nCoeff; ++i) {
+                                for (size_t j = 0; j < nCoeff; ++j) {
+                                     normal[i * nCoeff + j] += powers[i] * powers[j];
+                                }
+                                rhs[i] += powers[i] * value;
+                           }
+                           ++nValid;
+                      }
+                      if ((nValid >= nCoeff) && solveNormalEquations(normal, rhs, nCoeff)) {
+                          for (size_t k = 0; k < nCoeff; ++k) {
+                               coeffs[k] = casacore::Complex(rhs[k]);
+                          }
+                          result.setPolynomial(ant, beam, pol, block, coeffs, true);
+                      }
+                 }
+            }
+       }
+  }
+  return result;
+}
+
+/// @brief set the polynomial for one block of channels
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @param[in] pol polarisation index (0 for XX, 1 for YY)
+/// @param[in] block block index
+/// @param[in] coeffs order+1 coefficients, starting from the constant term
+/// @param[in] isValid validity flag
+void ParametricBandpass::setPolynomial(const casacore::uInt ant, const casacore::uInt beam, const casacore::uInt pol,
+                     const casacore::uInt block, const casacore::Vector<casacore::Complex> &coeffs,
+                     const casacore::Bool isValid)
+{
+  checkIndex(ant, beam);
+  ASKAPCHECK(pol < 2, "Polarisation index "<<pol<<" is outside the range, only XX and YY are supported");
+  ASKAPCHECK(block < nBlock(), "Block "<<block<<" is outside the parametric bandpass with "<<nBlock()<<" blocks");
+  const casacore::uInt nCoeff = itsOrder + 1;
+  ASKAPCHECK(coeffs.nelements() == nCoeff, "Expected "<<nCoeff<<" coefficients for the polynomial of order "<<
+             itsOrder<<", you have "<<coeffs.nelements());
+  for (casacore::uInt k = 0; k < nCoeff; ++k) {
+       itsCoeffs(k + nCoeff * (pol + 2 * block), ant, beam) = coeffs[k];
+  }
+  itsValidity(pol + 2 * block, ant, beam) = isValid;
+}
+
+/// @brief evaluate the bandpass for a single channel
+/// @details Default gains of 1. with invalid flags are returned for flagged blocks
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm ParametricBandpass::bandpass(const JonesIndex &index, const casacore::uInt chan) const
+{
+  ASKAPCHECK((index.antenna() >= 0) && (index.beam() >= 0), "Negative antenna or beam index is not allowed");
+  casacore::Complex values[2];
+  casacore::Bool validity[2];
+  evaluate(casacore::uInt(index.antenna()), casacore::uInt(index.beam()), chan, 1u, values, validity);
+  return JonesJTerm(values[0], validity[0], values[1], validity[1]);
+}
+
+/// @brief evaluate the bandpass for a range of channels
+/// @details The output has the layout of the bandpass cube (XX and YY interleaved for
+/// each channel). Polynomials are evaluated by the Horner scheme for all channels of a
+/// block at once, so the inner loop can be vectorised by the compiler.
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] values pointer to 2 * nChan elements to fill
+/// @param[out] validity pointer to 2 * nChan validity flags to fill
+void ParametricBandpass::evaluate(const casacore::uInt ant, const casacore::uInt beam, const casacore::uInt startChan,
+                const casacore::uInt nChan, casacore::Complex *values, casacore::Bool *validity) const
+{
+  checkIndex(ant, beam);
+  ASKAPCHECK(startChan + nChan <= itsNChan, "Requested channels "<<startChan<<" to "<<startChan + nChan<<
+             " are outside the parametric bandpass with "<<itsNChan<<" channels");
+  const casacore::uInt nCoeff = itsOrder + 1;
+  const casacore::uInt stopChan = startChan + nChan;
+  for (casacore::uInt chan = startChan; chan < stopChan;) {
+       const casacore::uInt block = chan / itsChansPerBlock;
+       const casacore::uInt blockStart = block * itsChansPerBlock;
+       const casacore::uInt blockEnd = std::min(blockStart + itsChansPerBlock, itsNChan);
+       const casacore::uInt nBlockChan = std::min(blockEnd, stopChan) - chan;
+       const casacore::uInt offset = chan - blockStart;
+       const float scale = blockEnd - blockStart > 1 ? 2.f / float(blockEnd - blockStart - 1) : 0.f;
+       // coefficients of XX followed by those of YY, polynomials of a block are contiguous in memory
+       const casacore::Complex *coeffs = &itsCoeffs(nCoeff * 2 * block, ant, beam);
+       const casacore::Bool validXX = itsValidity(2 * block, ant, beam);
+       const casacore::Bool validYY = itsValidity(2 * block + 1, ant, beam);
+       for (casacore::uInt i = 0; i < nBlockChan; ++i) {
+            values[2 * i] = coeffs[itsOrder];
+            values[2 * i + 1] = coeffs[nCoeff + itsOrder];
+       }
+       // Horner scheme, the loop over channels is the inner one
+       for (casacore::uInt k = itsOrder; k > 0; --k) {
+            const casacore::Complex cXX = coeffs[k - 1];
+            const casacore::Complex cYY = coeffs[nCoeff + k - 1];
+            for (casacore::uInt i = 0; i < nBlockChan; ++i) {
+                 const float x = scale * float(offset + i) - 1.f;
+                 values[2 * i] = values[2 * i] * x + cXX;
+                 values[2 * i + 1] = values[2 * i + 1] * x + cYY;
+            }
+       }
+       for (casacore::uInt i = 0; i < nBlockChan; ++i) {
+            validity[2 * i] = validXX;
+            validity[2 * i + 1] = validYY;
+       }
+       // default bandpass for flagged blocks, as returned for undefined solutions
+       if (!validXX) {
+           for (casacore::uInt i = 0; i < nBlockChan; ++i) {
+                values[2 * i] = 1.;
+           }
+       }
+       if (!validYY) {
+           for (casacore::uInt i = 0; i < nBlockChan; ++i) {
+                values[2 * i + 1] = 1.;
+           }
+       }
+       values += 2 * nBlockChan;
+       validity += 2 * nBlockChan;
+       chan += nBlockChan;
+  }
+}
+
+/// @brief memory used by the model
+/// @return number of bytes held by the coefficients and validity flags
+size_t ParametricBandpass::memoryUsage() const
+{
+  return itsCoeffs.nelements() * sizeof(casacore::Complex) + itsValidity.nelements() * sizeof(casacore::Bool);
+}
+
+/// @brief check that the antenna and beam are within the model
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+void ParametricBandpass::checkIndex(const casacore::uInt ant, const casacore::uInt beam) const
+{
+  ASKAPCHECK(ant < nAnt(), "Requested antenna index "<<ant<<" is outside the parametric bandpass with "<<nAnt()<<" antennas");
+  ASKAPCHECK(beam < nBeam(), "Requested beam index "<<beam<<" is outside the parametric bandpass with "<<nBeam()<<" beams");
+}
+
+} // namespace accessors
+
+} // namespace askap
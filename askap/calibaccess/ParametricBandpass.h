@@ -0,0 +1,194 @@
+/// @file
+/// @brief compact parametric representation of the bandpass
+/// @details Smooth bandpasses can be approximated by low order polynomials over blocks
+/// of adjacent channels (e.g. 1 MHz worth of channels). This class holds the polynomial
+/// coefficients for each antenna, beam, polarisation and block of channels and evaluates
+/// the bandpass on demand. Compared to the full resolution (2*nChan) x nAnt x nBeam cube,
+/// the memory footprint is reduced by the ratio of the block size to the number of coefficients.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_PARAMETRIC_BANDPASS_H
+#define ASKAP_ACCESSORS_PARAMETRIC_BANDPASS_H
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// own includes
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/calibaccess/JonesJTerm.h>
+
+// std includes
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief compact parametric representation of the bandpass
+/// @details Channels are split into blocks of chansPerBlock channels (the last block may
+/// be shorter). For each antenna, beam, polarisation (XX and YY) and block the bandpass is
+/// given by a complex polynomial of the given order in the normalised channel offset, which
+/// runs from -1 at the first channel of the block to +1 at the last one. Each polynomial has
+/// one validity flag, so all channels of the block are either valid or not. 
+/// Coefficients are stored in a (nCoeff*2*nBlock) x nAnt x nBeam cube with the row 
+/// k + nCoeff * (pol + 2 * block) holding the coefficient at x^k, validity flags are stored 
+/// in a (2*nBlock) x nAnt x nBeam cube with the row pol + 2 * block. These cubes are used 
+/// for storage in the calibration table.
+/// @ingroup calibaccess
+class ParametricBandpass {
+public:
+  /// @brief empty model
+  ParametricBandpass();
+
+  /// @brief construct the model with all polynomials undefined
+  /// @param[in] nChan number of spectral channels
+  /// @param[in] chansPerBlock number of channels per block
+  /// @param[in] order polynomial order
+  /// @param[in] nAnt number of antennas
+  /// @param[in] nBeam number of beams
+  ParametricBandpass(const casacore::uInt nChan, const casacore::uInt chansPerBlock, const casacore::uInt order,
+                     const casacore::uInt nAnt, const casacore::uInt nBeam);
+
+  /// @brief construct the model from the stored coefficients
+  /// @param[in] nChan number of spectral channels
+  /// @param[in] chansPerBlock number of channels per block
+  /// @param[in] order polynomial order
+  /// @param[in] coeffs coefficients, (nCoeff*2*nBlock) x nAnt x nBeam cube
+  /// @param[in] validity validity flags, (2*nBlock) x nAnt x nBeam cube
+  ParametricBandpass(const casacore::uInt nChan, const casacore::uInt chansPerBlock, const casacore::uInt order,
+                     const casacore::Cube<casacore::Complex> &coeffs, const casacore::Cube<casacore::Bool> &validity);
+
+  /// @brief copy constructor
+  /// @details Unlike casacore arrays, the copy doesn't share storage with the original
+  /// @param[in] other model to copy
+  ParametricBandpass(const ParametricBandpass &other);
+
+  /// @brief assignment operator
+  /// @details Unlike casacore arrays, the copy doesn't share storage with the original
+  /// @param[in] other model to copy
+  /// @return reference to this object
+  ParametricBandpass& operator=(const ParametricBandpass &other);
+
+  /// @brief fit the model to the full resolution bandpass
+  /// @details Polynomials are fitted by least squares to the valid channels of each block.
+  /// A polynomial is flagged if the block has fewer valid channels than coefficients.
+  /// @param[in] bp pair of cubes with bandpasses and validity flags ((2*nChan) x nAnt x nBeam)
+  /// @param[in] chansPerBlock number of channels per block
+  /// @param[in] order polynomial order
+  /// @return fitted model
+  static ParametricBandpass fit(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp,
+                                const casacore::uInt chansPerBlock, const casacore::uInt order);
+
+  /// @brief set the polynomial for one block of channels
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @param[in] pol polarisation index (0 for XX, 1 for YY)
+  /// @param[in] block block index
+  /// @param[in] coeffs order+1 coefficients, starting from the constant term
+  /// @param[in] isValid validity flag
+  void setPolynomial(const casacore::uInt ant, const casacore::uInt beam, const casacore::uInt pol,
+                     const casacore::uInt block, const casacore::Vector<casacore::Complex> &coeffs,
+                     const casacore::Bool isValid = true);
+
+  /// @brief evaluate the bandpass for a single channel
+  /// @details Default gains of 1. with invalid flags are returned for flagged blocks
+  /// @param[in] index ant/beam index
+  /// @param[in] chan spectral channel
+  /// @return JonesJTerm object with gains and validity flags
+  JonesJTerm bandpass(const JonesIndex &index, const casacore::uInt chan) const;
+
+  /// @brief evaluate the bandpass for a range of channels
+  /// @details The output has the layout of the bandpass cube (XX and YY interleaved for
+  /// each channel). Polynomials are evaluated by the Horner scheme for all channels of a
+  /// block at once, so the inner loop can be vectorised by the compiler.
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @param[in] startChan first spectral channel
+  /// @param[in] nChan number of spectral channels
+  /// @param[out] values pointer to 2 * nChan elements to fill
+  /// @param[out] validity pointer to 2 * nChan validity flags to fill
+  void evaluate(const casacore::uInt ant, const casacore::uInt beam, const casacore::uInt startChan,
+                const casacore::uInt nChan, casacore::Complex *values, casacore::Bool *validity) const;
+
+  /// @brief number of spectral channels
+  inline casacore::uInt nChan() const { return itsNChan; }
+
+  /// @brief number of channels per block
+  inline casacore::uInt chansPerBlock() const { return itsChansPerBlock; }
+
+  /// @brief polynomial order
+  inline casacore::uInt order() const { return itsOrder; }
+
+  /// @brief number of blocks
+  inline casacore::uInt nBlock() const { return itsChansPerBlock == 0 ? 0u : (itsNChan + itsChansPerBlock - 1) / itsChansPerBlock; }
+
+  /// @brief number of antennas
+  inline casacore::uInt nAnt() const { return itsCoeffs.ncolumn(); }
+
+  /// @brief number of beams
+  inline casacore::uInt nBeam() const { return itsCoeffs.nplane(); }
+
+  /// @brief coefficients
+  /// @return (nCoeff*2*nBlock) x nAnt x nBeam cube
+  inline const casacore::Cube<casacore::Complex>& coefficients() const { return itsCoeffs; }
+
+  /// @brief validity flags of the polynomials
+  /// @return (2*nBlock) x nAnt x nBeam cube
+  inline const casacore::Cube<casacore::Bool>& validity() const { return itsValidity; }
+
+  /// @brief memory used by the model
+  /// @return number of bytes held by the coefficients and validity flags
+  size_t memoryUsage() const;
+
+private:
+  /// @brief check that the antenna and beam are within the model
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  void checkIndex(const casacore::uInt ant, const casacore::uInt beam) const;
+
+  /// @brief number of spectral channels
+  casacore::uInt itsNChan;
+
+  /// @brief number of channels per block
+  casacore::uInt itsChansPerBlock;
+
+  /// @brief polynomial order
+  casacore::uInt itsOrder;
+
+  /// @brief coefficients, (nCoeff*2*nBlock) x nAnt x nBeam
+  casacore::Cube<casacore::Complex> itsCoeffs;
+
+  /// @brief validity flags, (2*nBlock) x nAnt x nBeam
+  casacore::Cube<casacore::Bool> itsValidity;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PARAMETRIC_BANDPASS_H
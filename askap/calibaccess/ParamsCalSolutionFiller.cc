@@ -0,0 +1,254 @@
+/// @file
+/// @brief solution filler converting between scimath::Params and dense cubes
+/// @details This filler allows MemCalSolutionAccessor to be used with
+/// calibration parameters held in scimath::Params under the names defined by
+/// CalParamNameHelper (as used by CachedCalSolutionAccessor). The names are parsed
+/// once when the cubes are filled and formed again only when the cubes are written back, 
+/// so individual lookups done via the accessor are simple array indexing.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/calibaccess/ParamsCalSolutionFiller.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @details The parameters are scanned to determine which products are present and
+/// the shapes of the cubes.
+/// @param[in] params shared pointer to parameters to work with (reference semantics)
+/// @param[in] nAnt minimum number of antennas (used to set up new solutions)
+/// @param[in] nBeam minimum number of beams (used to set up new solutions)
+/// @param[in] nChan minimum number of spectral channels (used to set up new solutions)
+ParamsCalSolutionFiller::ParamsCalSolutionFiller(const boost::shared_ptr<scimath::Params> &params, 
+         const casacore::uInt nAnt, const casacore::uInt nBeam, const casacore::uInt nChan) :
+         itsParams(params), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan), itsHasGains(false),
+         itsHasLeakages(false), itsHasBandpasses(false)
+{
+  ASKAPCHECK(itsParams, "An attempt to initialise ParamsCalSolutionFiller with a void shared pointer");
+  const std::vector<std::string> names = itsParams->names();
+  for (std::vector<std::string>::const_iterator ci = names.begin(); ci != names.end(); ++ci) {
+       JonesIndex index(0u, 0u);
+       casacore::uInt row = 0;
+       const int product = parseName(*ci, index, row);
+       if (product < 0) {
+           continue;
+       }
+       ASKAPCHECK((index.antenna() >= 0) && (index.beam() >= 0), "Negative antenna or beam index in "<<*ci);
+       itsNAnt = std::max(itsNAnt, casacore::uInt(index.antenna()) + 1);
+       itsNBeam = std::max(itsNBeam, casacore::uInt(index.beam()) + 1);
+       if (product == 0) {
+           itsHasGains = true;
+       } else if (product == 1) {
+           itsHasLeakages = true;
+       } else {
+           itsHasBandpasses = true;
+           itsNChan = std::max(itsNChan, row / 2 + 1);
+       }
+  }
+}
+
+/// @brief classify the parameter name
+/// @details 
+/// @param[in] name parameter name
+/// @param[out] index antenna/beam index
+/// @param[out] row row of the cube (pol for gains and leakages, 2*chan+pol for bandpasses)
+/// @return 0 for gains, 1 for leakages, 2 for bandpasses and -1 for parameters which are
+/// not related to calibration
+int ParamsCalSolutionFiller::parseName(const std::string &name, JonesIndex &index, casacore::uInt &row)
+{
+  const bool isBP = bpParam(name);
+  const std::string baseName = isBP ? name.substr(bpPrefix().size()) : name;
+  if ((baseName.find("gain.") != 0) && (baseName.find("leakage.") != 0)) {
+      return -1;
+  }
+  const size_t nDots = std::count(baseName.begin(), baseName.end(), '.');
+  if (nDots == 4) {
+      // bandpass, the channel is appended to the gain name
+      const std::pair<casacore::uInt, std::string> chanInfo = extractChannelInfo(baseName);
+      const std::pair<JonesIndex, casacore::Stokes::StokesTypes> parsed = parseParam(chanInfo.second);
+      ASKAPCHECK((parsed.second == casacore::Stokes::XX) || (parsed.second == casacore::Stokes::YY), 
+                 "Only parallel-hand bandpass parameters are supported, you have "<<name);
+      index = parsed.first;
+      row = 2 * chanInfo.first + (parsed.second == casacore::Stokes::XX ? 0 : 1);
+      return 2;
+  }
+  ASKAPCHECK(!isBP, "Bandpass parameter "<<name<<" is expected to have the spectral channel in its name");
+  const std::pair<JonesIndex, casacore::Stokes::StokesTypes> parsed = parseParam(baseName);
+  index = parsed.first;
+  if ((parsed.second == casacore::Stokes::XX) || (parsed.second == casacore::Stokes::YY)) {
+      row = (parsed.second == casacore::Stokes::XX ? 0 : 1);
+      return 0;
+  }
+  row = (parsed.second == casacore::Stokes::XY ? 0 : 1);
+  return 1;
+}
+
+/// @brief fill cubes with values of one product
+/// @param[in] product product to fill (0 for gains, 1 for leakages, 2 for bandpasses)
+/// @param[in] nRow number of rows of the cube
+/// @param[in] defaultValue value used for the elements not defined
+/// @param[out] cubes pair of cubes to fill
+void ParamsCalSolutionFiller::fill(const int product, const casacore::uInt nRow, const casacore::Complex &defaultValue,
+            std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes) const
+{
+  cubes.first.resize(nRow, itsNAnt, itsNBeam);
+  cubes.first.set(defaultValue);
+  cubes.second.resize(nRow, itsNAnt, itsNBeam);
+  cubes.second.set(false);
+  const std::vector<std::string> names = params().names();
+  for (std::vector<std::string>::const_iterator ci = names.begin(); ci != names.end(); ++ci) {
+       JonesIndex index(0u, 0u);
+       casacore::uInt row = 0;
+       if (parseName(*ci, index, row) != product) {
+           continue;
+       }
+       const casacore::uInt ant = casacore::uInt(index.antenna());
+       const casacore::uInt beam = casacore::uInt(index.beam());
+       ASKAPCHECK((index.antenna() >= 0) && (index.beam() >= 0) && (row < nRow) && (ant < itsNAnt) && 
+                  (beam < itsNBeam), "Parameter "<<*ci<<" is outside the shape of the cache: "<<cubes.first.shape()<<
+                  "; parameters were probably added after the filler had been set up");
+       cubes.first(row, ant, beam) = params().complexValue(*ci);
+       cubes.second(row, ant, beam) = true;
+  }
+}
+
+/// @brief gains filler
+/// @details
+/// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+void ParamsCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
+{
+  fill(0, 2, casacore::Complex(1., 0.), gains);
+}
+
+/// @brief leakage filler
+/// @details
+/// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+void ParamsCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
+{
+  fill(1, 2, casacore::Complex(0., 0.), leakages);
+}
+
+/// @brief bandpass filler
+/// @details
+/// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+void ParamsCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
+{
+  fill(2, 2 * itsNChan, casacore::Complex(1., 0.), bp);
+}
+
+/// @brief gains writer
+/// @details
+/// @param[in] gains pair of cubes with gains and validity flags (should be 2 x nAnt x nBeam)
+void ParamsCalSolutionFiller::writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
+{
+  ASKAPCHECK(gains.first.shape() == gains.second.shape(), "The cubes with gains and validity flags are expected to have the same shape");
+  ASKAPDEBUGASSERT(gains.first.nrow() == 2);
+  for (casacore::uInt beam = 0; beam < gains.first.nplane(); ++beam) {
+       for (casacore::uInt ant = 0; ant < gains.first.ncolumn(); ++ant) {
+            const JonesIndex index(ant, beam);
+            for (casacore::uInt pol = 0; pol < 2; ++pol) {
+                 if (gains.second(pol, ant, beam)) {
+                     updateParam(paramName(index, pol == 0 ? casacore::Stokes::XX : casacore::Stokes::YY), gains.first(pol, ant, beam));
+                 }
+            }
+       }
+  }
+  itsHasGains = true;
+}
+
+/// @brief leakage writer
+/// @details
+/// @param[in] leakages pair of cubes with leakages and validity flags (should be 2 x nAnt x nBeam)
+void ParamsCalSolutionFiller::writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
+{
+  ASKAPCHECK(leakages.first.shape() == leakages.second.shape(), "The cubes with leakages and validity flags are expected to have the same shape");
+  ASKAPDEBUGASSERT(leakages.first.nrow() == 2);
+  for (casacore::uInt beam = 0; beam < leakages.first.nplane(); ++beam) {
+       for (casacore::uInt ant = 0; ant < leakages.first.ncolumn(); ++ant) {
+            const JonesIndex index(ant, beam);
+            for (casacore::uInt pol = 0; pol < 2; ++pol) {
+                 if (leakages.second(pol, ant, beam)) {
+                     updateParam(paramName(index, pol == 0 ? casacore::Stokes::XY : casacore::Stokes::YX), leakages.first(pol, ant, beam));
+                 }
+            }
+       }
+  }
+  itsHasLeakages = true;
+}
+
+/// @brief bandpass writer
+/// @details
+/// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+void ParamsCalSolutionFiller::writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
+{
+  ASKAPCHECK(bp.first.shape() == bp.second.shape(), "The cubes with bandpasses and validity flags are expected to have the same shape");
+  ASKAPDEBUGASSERT(bp.first.nrow() % 2 == 0);
+  for (casacore::uInt beam = 0; beam < bp.first.nplane(); ++beam) {
+       for (casacore::uInt ant = 0; ant < bp.first.ncolumn(); ++ant) {
+            const JonesIndex index(ant, beam);
+            const std::string nameG1 = paramName(index, casacore::Stokes::XX);
+            const std::string nameG2 = paramName(index, casacore::Stokes::YY);
+            for (casacore::uInt row = 0; row < bp.first.nrow(); ++row) {
+                 if (bp.second(row, ant, beam)) {
+                     updateParam(addChannelInfo(row % 2 == 0 ? nameG1 : nameG2, row / 2), bp.first(row, ant, beam));
+                 }
+            }
+       }
+  }
+  itsHasBandpasses = true;
+}
+
+/// @brief helper method to update given parameter
+/// @param[in] name string name of the parameter
+/// @param[in] val complex value to be set
+void ParamsCalSolutionFiller::updateParam(const std::string &name, const casacore::Complex &val) const
+{
+  if (params().has(name)) {
+      params().update(name, val);
+  } else {
+      params().add(name, val);
+  }
+}
+
+/// @brief direct access to the parameters
+/// @return a reference to the parameters
+scimath::Params& ParamsCalSolutionFiller::params() const
+{
+  ASKAPDEBUGASSERT(itsParams);
+  return *itsParams;
+}
+
+} // namespace accessors
+
+} // namespace askap
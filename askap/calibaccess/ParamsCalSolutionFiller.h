@@ -0,0 +1,175 @@
+/// @file
+/// @brief solution filler converting between scimath::Params and dense cubes
+/// @details This filler allows MemCalSolutionAccessor to be used with
+/// calibration parameters held in scimath::Params under the names defined by
+/// CalParamNameHelper (as used by CachedCalSolutionAccessor). The names are parsed
+/// once when the cubes are filled and formed again only when the cubes are written back, 
+/// so individual lookups done via the accessor are simple array indexing.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_PARAMS_CAL_SOLUTION_FILLER_H
+#define ASKAP_ACCESSORS_PARAMS_CAL_SOLUTION_FILLER_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionFiller.h>
+#include <askap/calibaccess/CalParamNameHelper.h>
+#include <fitting/Params.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief solution filler converting between scimath::Params and dense cubes
+/// @details This is an adapter allowing MemCalSolutionAccessor to work with parameters
+/// stored in scimath::Params (e.g. the cache of CachedCalSolutionAccessor or parameters
+/// used by the solver). Gains, leakages and bandpasses are unpacked into cubes
+/// on the first access, so the accessor doesn't build and search string names for every
+/// lookup. Written cubes are converted back into parameters with the names given by
+/// CalParamNameHelper (invalid values are not written, as in CachedCalSolutionAccessor).
+/// The shape of the cubes is given by the largest indices present in the parameters at
+/// the construction time, or by the numbers passed to the constructor, whichever is greater.
+/// Bandpass parameters are expected to have the channel appended to the gain name 
+/// (e.g. gain.g11.1.3.10); the bandpass prefix is allowed. Parameters not related
+/// to calibration are ignored.
+/// @ingroup calibaccess
+class ParamsCalSolutionFiller : virtual public ICalSolutionFiller,
+                                virtual protected CalParamNameHelper {
+public:
+  /// @brief constructor
+  /// @details The parameters are scanned to determine which products are present and
+  /// the shapes of the cubes.
+  /// @param[in] params shared pointer to parameters to work with (reference semantics)
+  /// @param[in] nAnt minimum number of antennas (used to set up new solutions)
+  /// @param[in] nBeam minimum number of beams (used to set up new solutions)
+  /// @param[in] nChan minimum number of spectral channels (used to set up new solutions)
+  explicit ParamsCalSolutionFiller(const boost::shared_ptr<scimath::Params> &params, 
+         const casacore::uInt nAnt = 0, const casacore::uInt nBeam = 0, const casacore::uInt nChan = 0);
+
+  /// @brief gains filler
+  /// @details
+  /// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage filler
+  /// @details
+  /// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass filler
+  /// @details
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+  virtual void fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief gains writer
+  /// @details
+  /// @param[in] gains pair of cubes with gains and validity flags (should be 2 x nAnt x nBeam)
+  virtual void writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage writer
+  /// @details
+  /// @param[in] leakages pair of cubes with leakages and validity flags (should be 2 x nAnt x nBeam)
+  virtual void writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass writer
+  /// @details
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+  virtual void writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief check for gain solution
+  /// @return true, if there is no gain solution, false otherwise
+  virtual bool noGain() const { return !itsHasGains; }
+
+  /// @brief check for leakage solution
+  /// @return true, if there is no leakage solution, false otherwise
+  virtual bool noLeakage() const { return !itsHasLeakages; }
+
+  /// @brief check for bandpass solution
+  /// @return true, if there is no bandpass solution, false otherwise
+  virtual bool noBandpass() const { return !itsHasBandpasses; }
+
+  /// @brief direct access to the parameters
+  /// @return a reference to the parameters
+  scimath::Params& params() const;
+
+protected:
+
+  /// @brief classify the parameter name
+  /// @details 
+  /// @param[in] name parameter name
+  /// @param[out] index antenna/beam index
+  /// @param[out] row row of the cube (pol for gains and leakages, 2*chan+pol for bandpasses)
+  /// @return 0 for gains, 1 for leakages, 2 for bandpasses and -1 for parameters which are
+  /// not related to calibration
+  static int parseName(const std::string &name, JonesIndex &index, casacore::uInt &row);
+
+  /// @brief fill cubes with values of one product
+  /// @param[in] product product to fill (0 for gains, 1 for leakages, 2 for bandpasses)
+  /// @param[in] nRow number of rows of the cube
+  /// @param[in] defaultValue value used for the elements not defined
+  /// @param[out] cubes pair of cubes to fill
+  void fill(const int product, const casacore::uInt nRow, const casacore::Complex &defaultValue,
+            std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes) const;
+
+  /// @brief helper method to update given parameter
+  /// @param[in] name string name of the parameter
+  /// @param[in] val complex value to be set
+  void updateParam(const std::string &name, const casacore::Complex &val) const;
+  
+private:
+  /// @brief parameters to work with
+  boost::shared_ptr<scimath::Params> itsParams;
+
+  /// @brief number of antennas
+  casacore::uInt itsNAnt;
+
+  /// @brief number of beams
+  casacore::uInt itsNBeam;
+
+  /// @brief number of spectral channels
+  casacore::uInt itsNChan;
+
+  /// @brief true if gains are present
+  mutable bool itsHasGains;
+
+  /// @brief true if leakages are present
+  mutable bool itsHasLeakages;
+
+  /// @brief true if bandpasses are present
+  mutable bool itsHasBandpasses;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PARAMS_CAL_SOLUTION_FILLER_H
@@ -82,12 +82,20 @@ ParsetCalSolutionAccessor::~ParsetCalSolutionAccessor()
   if (itsWriteRequired) {
       ASKAPLOG_INFO_STR(logger, "Writing out calibration results into a parset file "<<itsParsetFileName);
       const std::vector<std::string> parlist = cache().names();
-      std::ofstream os(itsParsetFileName.c_str());
+      // large buffer, so full bandpasses are written in big blocks (the buffer must outlive the stream)
+      std::vector<char> buffer(1048576);
+      std::ofstream os;
+      os.rdbuf()->pubsetbuf(&buffer[0], std::streamsize(buffer.size()));
+      os.open(itsParsetFileName.c_str());
       for (std::vector<std::string>::const_iterator it = parlist.begin(); 
            it != parlist.end(); ++it) {
            const casacore::Complex val = cache().complexValue(*it);
-           os<<*it<<" = ["<<real(val)<<","<<imag(val)<<"]"<<std::endl;
-      }     
+           os<<*it<<" = ["<<real(val)<<","<<imag(val)<<"]\n";
+      }
+      os.flush();
+      if (!os) {
+          ASKAPLOG_ERROR_STR(logger, "Failed to write calibration results into "<<itsParsetFileName);
+      }
   }
 }
 
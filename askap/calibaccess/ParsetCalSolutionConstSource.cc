@@ -31,7 +31,8 @@
 /// @author Max Voronkov <Maxim.Voronkov@csiro.au>
 
 #include <askap/calibaccess/ParsetCalSolutionConstSource.h>
-#include <askap/calibaccess/ParsetCalSolutionAccessor.h>
+#include <askap/calibaccess/ParsetCalSolutionFiller.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
 
 // logging stuff
 #include <askap_accessors.h>
@@ -47,8 +48,25 @@ namespace accessors {
 /// (whether it is for writing or reading depends on the actual methods
 /// used).
 /// @param[in] parset parset file name
-ParsetCalSolutionConstSource::ParsetCalSolutionConstSource(const std::string &parset) :
-   CalSolutionConstSourceStub(boost::shared_ptr<ParsetCalSolutionAccessor>(new ParsetCalSolutionAccessor(parset,true))) {}
+/// @param[in] startBeam first beam of the bandpasses to read
+/// @param[in] nBeam number of beams of the bandpasses to read (0 means all beams)
+ParsetCalSolutionConstSource::ParsetCalSolutionConstSource(const std::string &parset, const casacore::uInt startBeam,
+                                        const casacore::uInt nBeam) :
+   CalSolutionConstSourceStub(makeAccessor(parset, startBeam, nBeam)) {}
+
+/// @brief set up the accessor
+/// @param[in] parset parset file name
+/// @param[in] startBeam first beam of the bandpasses to read
+/// @param[in] nBeam number of beams of the bandpasses to read (0 means all beams)
+/// @return shared pointer to the read-only accessor
+boost::shared_ptr<ICalSolutionConstAccessor> ParsetCalSolutionConstSource::makeAccessor(const std::string &parset,
+                   const casacore::uInt startBeam, const casacore::uInt nBeam)
+{
+  const boost::shared_ptr<ParsetCalSolutionFiller> filler(new ParsetCalSolutionFiller(parset));
+  filler->setBandpassBeams(startBeam, nBeam);
+  const boost::shared_ptr<MemCalSolutionAccessor> acc(new MemCalSolutionAccessor(filler, true));
+  return acc;
+}
   
 } // accessors
 
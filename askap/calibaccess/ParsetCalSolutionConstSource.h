@@ -43,9 +43,9 @@ namespace accessors {
 /// @brief Parset file-based implementation of the calibration solution source
 /// @details This implementation is to be used with pre-existing code writing/reading
 /// the parset directly and with a number of tests. It is just to convert the legacy code.
-/// There is only one implementation of this class which is used for both reading and writing.
-/// Main functionality is implemented in the corresponding ParsetCalSolutionAccessor class.
-/// This class just creates an instance of the accessor and manages it.
+/// The file is read by ParsetCalSolutionFiller straight into dense cubes used by
+/// MemCalSolutionAccessor (the parset is parsed on the first access). Writing is done via 
+/// ParsetCalSolutionSource and the corresponding ParsetCalSolutionAccessor class.
 /// @ingroup calibaccess
 struct ParsetCalSolutionConstSource : public CalSolutionConstSourceStub {
   /// @brief constructor
@@ -53,11 +53,23 @@ struct ParsetCalSolutionConstSource : public CalSolutionConstSourceStub {
   /// (whether it is for writing or reading depends on the actual methods
   /// used).
   /// @param[in] parset parset file name
-  explicit ParsetCalSolutionConstSource(const std::string &parset);
+  /// @param[in] startBeam first beam of the bandpasses to read
+  /// @param[in] nBeam number of beams of the bandpasses to read (0 means all beams)
+  explicit ParsetCalSolutionConstSource(const std::string &parset, const casacore::uInt startBeam = 0,
+                                        const casacore::uInt nBeam = 0);
   
   /// @brief shared pointer definition
   typedef boost::shared_ptr<ParsetCalSolutionConstSource> ShPtr;
 
+protected:
+  /// @brief set up the accessor
+  /// @param[in] parset parset file name
+  /// @param[in] startBeam first beam of the bandpasses to read
+  /// @param[in] nBeam number of beams of the bandpasses to read (0 means all beams)
+  /// @return shared pointer to the read-only accessor
+  static boost::shared_ptr<ICalSolutionConstAccessor> makeAccessor(const std::string &parset,
+                   const casacore::uInt startBeam, const casacore::uInt nBeam);
+
 };
 
 
@@ -0,0 +1,414 @@
+/// @file
+/// @brief solution filler reading a parset file directly into dense cubes
+/// @details This filler is used with MemCalSolutionAccessor to read calibration
+/// solutions stored in the parset format (e.g. result.dat written by ParsetCalSolutionAccessor).
+/// The file is parsed line by line, values go straight into the cubes without building
+/// scimath::Params or LOFAR::ParameterSet with string keys.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/calibaccess/ParsetCalSolutionFiller.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Slicer.h>
+
+// logging stuff
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, ".calibaccess");
+
+// std includes
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief check that the string starts with the given literal
+/// @param[in] ptr pointer to the first character of the string
+/// @param[in] end pointer to the character following the string
+/// @param[in] literal literal to compare with
+/// @return true if the string starts with the literal
+inline bool startsWith(const char *ptr, const char *end, const char *literal)
+{
+  const size_t len = std::strlen(literal);
+  return (size_t(end - ptr) >= len) && (std::strncmp(ptr, literal, len) == 0);
+}
+
+/// @brief parse a non-negative integer index
+/// @param[in] ptr pointer to the first character
+/// @param[in] end pointer to the character following the string
+/// @param[out] result parsed index
+/// @return pointer to the first character following the index, NULL if there are no digits
+inline const char* parseIndex(const char *ptr, const char *end, casacore::uInt &result)
+{
+  if ((ptr == end) || !std::isdigit(*ptr)) {
+      return NULL;
+  }
+  result = 0;
+  for (; (ptr != end) && std::isdigit(*ptr); ++ptr) {
+       result = result * 10 + casacore::uInt(*ptr - '0');
+  }
+  return ptr;
+}
+
+/// @brief skip white spaces
+/// @param[in] ptr pointer to the first character of a null-terminated string
+/// @return pointer to the first character which is not a white space
+inline const char* skipSpaces(const char *ptr)
+{
+  while ((*ptr == ' ') || (*ptr == '\t') || (*ptr == '\r')) {
+     ++ptr;
+  }
+  return ptr;
+}
+
+/// @brief grow the size of the axis if necessary
+/// @param[in] index index which has to fit
+/// @param[in] size current size of the axis
+/// @return new size of the axis (doubled, if the index doesn't fit)
+inline casacore::uInt grow(const casacore::uInt index, const casacore::uInt size)
+{
+  return index < size ? size : std::max(index + 1, 2 * size);
+}
+
+} // anonymous namespace
+
+/// @brief constructor
+/// @details An exception is thrown if the file cannot be opened. Nothing is parsed at this stage.
+/// @param[in] fname parset file name
+ParsetCalSolutionFiller::ParsetCalSolutionFiller(const std::string &fname) : itsFileName(fname),
+      itsBPStartBeam(0), itsBPNBeam(0), itsParsed(false)
+{
+  std::ifstream is(fname.c_str());
+  if (!is) {
+      ASKAPTHROW(AskapError, "Unable to open parset file "<<fname<<" with calibration solutions");
+  }
+  for (int product = 0; product < 3; ++product) {
+       std::fill(itsUsed[product], itsUsed[product] + 3, 0u);
+  }
+}
+
+/// @brief restrict bandpasses to a range of beams
+/// @details This method should be called before the first access to the data.
+/// @param[in] startBeam first beam to read
+/// @param[in] nBeam number of beams to read (0 means all beams starting from startBeam)
+void ParsetCalSolutionFiller::setBandpassBeams(const casacore::uInt startBeam, const casacore::uInt nBeam)
+{
+  ASKAPCHECK(!itsParsed, "The range of beams should be set before the calibration solution is read from "<<itsFileName);
+  itsBPStartBeam = startBeam;
+  itsBPNBeam = nBeam;
+}
+
+/// @brief gains filler
+/// @details
+/// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+void ParsetCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
+{
+  parse();
+  gains.first.reference(itsCubes[0].first);
+  gains.second.reference(itsCubes[0].second);
+}
+
+/// @brief leakage filler
+/// @details
+/// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+void ParsetCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
+{
+  parse();
+  leakages.first.reference(itsCubes[1].first);
+  leakages.second.reference(itsCubes[1].second);
+}
+
+/// @brief bandpass filler
+/// @details
+/// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+void ParsetCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
+{
+  parse();
+  bp.first.reference(itsCubes[2].first);
+  bp.second.reference(itsCubes[2].second);
+}
+
+/// @brief gains writer
+/// @details This filler is read-only, an exception is always thrown
+/// @param[in] gains pair of cubes with gains and validity flags (should be 2 x nAnt x nBeam)
+void ParsetCalSolutionFiller::writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "ParsetCalSolutionFiller is read-only, unable to write gains into "<<itsFileName);
+}
+
+/// @brief leakage writer
+/// @details This filler is read-only, an exception is always thrown
+/// @param[in] leakages pair of cubes with leakages and validity flags (should be 2 x nAnt x nBeam)
+void ParsetCalSolutionFiller::writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "ParsetCalSolutionFiller is read-only, unable to write leakages into "<<itsFileName);
+}
+
+/// @brief bandpass writer
+/// @details This filler is read-only, an exception is always thrown
+/// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+void ParsetCalSolutionFiller::writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "ParsetCalSolutionFiller is read-only, unable to write bandpasses into "<<itsFileName);
+}
+
+/// @brief check for gain solution
+/// @return true, if there is no gain solution, false otherwise
+bool ParsetCalSolutionFiller::noGain() const
+{
+  parse();
+  return itsUsed[0][0] == 0;
+}
+
+/// @brief check for leakage solution
+/// @return true, if there is no leakage solution, false otherwise
+bool ParsetCalSolutionFiller::noLeakage() const
+{
+  parse();
+  return itsUsed[1][0] == 0;
+}
+
+/// @brief check for bandpass solution
+/// @return true, if there is no bandpass solution, false otherwise
+bool ParsetCalSolutionFiller::noBandpass() const
+{
+  parse();
+  return itsUsed[2][0] == 0;
+}
+
+/// @brief parse the key
+/// @details This method understands the names formed by CalParamNameHelper without
+/// creating temporary strings.
+/// @param[in] key pointer to the first character of the key
+/// @param[in] end pointer to the character following the key
+/// @param[out] ant antenna index
+/// @param[out] beam beam index
+/// @param[out] row row of the cube (pol for gains and leakages, 2*chan+pol for bandpasses)
+/// @return 0 for gains, 1 for leakages, 2 for bandpasses and -1 for keys which are
+/// not related to calibration
+/// @note An exception is thrown if a key starting with gain or leakage is malformed
+int ParsetCalSolutionFiller::parseKey(const char *key, const char *end, casacore::uInt &ant, casacore::uInt &beam,
+                      casacore::uInt &row)
+{
+  const char *ptr = key;
+  const bool isBP = startsWith(ptr, end, "bp.");
+  if (isBP) {
+      ptr += 3;
+  }
+  int product = -1;
+  casacore::uInt pol = 0;
+  if (startsWith(ptr, end, "gain.")) {
+      ptr += 5;
+      product = 0;
+      ASKAPCHECK(startsWith(ptr, end, "g11") || startsWith(ptr, end, "g22"), 
+                 "Unrecognised polarisation product in "<<std::string(key, end));
+      pol = (ptr[1] == '1' ? 0 : 1);
+  } else if (startsWith(ptr, end, "leakage.")) {
+      ptr += 8;
+      product = 1;
+      ASKAPCHECK(startsWith(ptr, end, "d12") || startsWith(ptr, end, "d21"), 
+                 "Unrecognised polarisation product in "<<std::string(key, end));
+      pol = (ptr[1] == '1' ? 0 : 1);
+  } else {
+      return -1;
+  }
+  ptr += 3;
+  ASKAPCHECK((ptr != end) && (*ptr == '.'), "Parameter name should be in the form something.something.ant.beam; you have "<<
+             std::string(key, end));
+  ptr = parseIndex(ptr + 1, end, ant);
+  ASKAPCHECK((ptr != NULL) && (ptr != end) && (*ptr == '.'), "Parameter name should be in the form something.something.ant.beam; you have "<<
+             std::string(key, end));
+  ptr = parseIndex(ptr + 1, end, beam);
+  ASKAPCHECK(ptr != NULL, "Parameter name should be in the form something.something.ant.beam; you have "<<std::string(key, end));
+  if (ptr == end) {
+      ASKAPCHECK(!isBP, "Bandpass parameter "<<std::string(key, end)<<" is expected to have the spectral channel in its name");
+      row = pol;
+      return product;
+  }
+  ASKAPCHECK(product == 0, "Only parallel-hand bandpass parameters are supported, you have "<<std::string(key, end));
+  casacore::uInt chan = 0;
+  ASKAPCHECK(*ptr == '.', "Unable to parse the spectral channel in "<<std::string(key, end));
+  ptr = parseIndex(ptr + 1, end, chan);
+  ASKAPCHECK(ptr == end, "Unable to parse the spectral channel in "<<std::string(key, end));
+  row = 2 * chan + pol;
+  return 2;
+}
+
+/// @brief parse the value
+/// @param[in] value pointer to the first character of the value
+/// @param[out] result parsed value
+/// @return true if the value has been parsed successfully
+bool ParsetCalSolutionFiller::parseValue(const char *value, casacore::Complex &result)
+{
+  const char *ptr = skipSpaces(value);
+  char *next = NULL;
+  if (*ptr == '[') {
+      const double re = std::strtod(ptr + 1, &next);
+      if (next == ptr + 1) {
+          return false;
+      }
+      ptr = skipSpaces(next);
+      if (*ptr != ',') {
+          return false;
+      }
+      ++ptr;
+      const double im = std::strtod(ptr, &next);
+      if (next == ptr) {
+          return false;
+      }
+      ptr = skipSpaces(next);
+      if (*ptr != ']') {
+          return false;
+      }
+      ++ptr;
+      result = casacore::Complex(re, im);
+  } else {
+      const double re = std::strtod(ptr, &next);
+      if (next == ptr) {
+          return false;
+      }
+      ptr = next;
+      result = casacore::Complex(re, 0.);
+  }
+  ptr = skipSpaces(ptr);
+  return (*ptr == '\0') || (*ptr == '#');
+}
+
+/// @brief parse the file if it hasn't been done yet
+void ParsetCalSolutionFiller::parse() const
+{
+  if (itsParsed) {
+      return;
+  }
+  std::ifstream is(itsFileName.c_str());
+  if (!is) {
+      ASKAPTHROW(AskapError, "Unable to open parset file "<<itsFileName<<" with calibration solutions");
+  }
+  std::string line;
+  size_t lineNumber = 0;
+  size_t nValues = 0;
+  while (std::getline(is, line)) {
+     ++lineNumber;
+     const char *key = skipSpaces(line.c_str());
+     if ((*key == '\0') || (*key == '#')) {
+         continue;
+     }
+     const char *keyEnd = key;
+     while ((*keyEnd != '\0') && (*keyEnd != '=') && (*keyEnd != ' ') && (*keyEnd != '\t')) {
+        ++keyEnd;
+     }
+     casacore::uInt ant = 0, beam = 0, row = 0;
+     const int product = parseKey(key, keyEnd, ant, beam, row);
+     if (product < 0) {
+         continue;
+     }
+     if (product == 2) {
+         if ((beam < itsBPStartBeam) || ((itsBPNBeam > 0) && (beam >= itsBPStartBeam + itsBPNBeam))) {
+             continue;
+         }
+         beam -= itsBPStartBeam;
+     }
+     const char *value = skipSpaces(keyEnd);
+     ASKAPCHECK(*value == '=', "Expect '=' after "<<std::string(key, keyEnd)<<" in line "<<lineNumber<<" of "<<itsFileName);
+     casacore::Complex val;
+     ASKAPCHECK(parseValue(value + 1, val), "Unable to parse the value of "<<std::string(key, keyEnd)<<" in line "<<
+                lineNumber<<" of "<<itsFileName);
+     store(product, row, ant, beam, val);
+     ++nValues;
+  }
+  // gains and leakages are given for the same antennas and beams, bandpasses may cover a subset of beams
+  const casacore::uInt nAnt = std::max(itsUsed[0][1], std::max(itsUsed[1][1], itsUsed[2][1]));
+  const casacore::uInt nBeam = std::max(itsUsed[0][2], itsUsed[1][2]);
+  reshape(0, 2, nAnt, nBeam);
+  reshape(1, 2, nAnt, nBeam);
+  reshape(2, 2 * ((itsUsed[2][0] + 1) / 2), nAnt, itsUsed[2][2]);
+  itsParsed = true;
+  ASKAPLOG_INFO_STR(logger, "Read "<<nValues<<" calibration parameters from parset file "<<itsFileName);
+}
+
+/// @brief store a value
+/// @details Cubes are extended as required
+/// @param[in] product product (0 for gains, 1 for leakages, 2 for bandpasses)
+/// @param[in] row row of the cube
+/// @param[in] ant antenna index
+/// @param[in] beam beam index (counted from the start of the window for bandpasses)
+/// @param[in] value value to store
+void ParsetCalSolutionFiller::store(const int product, const casacore::uInt row, const casacore::uInt ant, 
+             const casacore::uInt beam, const casacore::Complex &value) const
+{
+  ASKAPDEBUGASSERT((product >= 0) && (product < 3));
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes = itsCubes[product];
+  if ((row >= cubes.first.nrow()) || (ant >= cubes.first.ncolumn()) || (beam >= cubes.first.nplane())) {
+      reshape(product, grow(row, cubes.first.nrow()), grow(ant, cubes.first.ncolumn()), grow(beam, cubes.first.nplane()));
+  }
+  cubes.first(row, ant, beam) = value;
+  cubes.second(row, ant, beam) = true;
+  casacore::uInt *used = itsUsed[product];
+  used[0] = std::max(used[0], row + 1);
+  used[1] = std::max(used[1], ant + 1);
+  used[2] = std::max(used[2], beam + 1);
+}
+
+/// @brief change the shape of the cubes preserving the values
+/// @param[in] product product (0 for gains, 1 for leakages, 2 for bandpasses)
+/// @param[in] nRow new number of rows
+/// @param[in] nAnt new number of antennas
+/// @param[in] nBeam new number of beams
+void ParsetCalSolutionFiller::reshape(const int product, const casacore::uInt nRow, const casacore::uInt nAnt, 
+               const casacore::uInt nBeam) const
+{
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes = itsCubes[product];
+  const casacore::IPosition shape(3, nRow, nAnt, nBeam);
+  if (cubes.first.shape() == shape) {
+      return;
+  }
+  // undefined leakages are zero, undefined gains and bandpasses are one
+  casacore::Cube<casacore::Complex> values(nRow, nAnt, nBeam, casacore::Complex(product == 1 ? 0. : 1., 0.));
+  casacore::Cube<casacore::Bool> flags(nRow, nAnt, nBeam, false);
+  const casacore::IPosition overlap(3, std::min(casacore::uInt(cubes.first.nrow()), nRow), 
+           std::min(casacore::uInt(cubes.first.ncolumn()), nAnt), std::min(casacore::uInt(cubes.first.nplane()), nBeam));
+  if (overlap.product() > 0) {
+      const casacore::Slicer slicer(casacore::IPosition(3, 0, 0, 0), overlap);
+      values(slicer) = cubes.first(slicer);
+      flags(slicer) = cubes.second(slicer);
+  }
+  cubes.first.reference(values);
+  cubes.second.reference(flags);
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,186 @@
+/// @file
+/// @brief solution filler reading a parset file directly into dense cubes
+/// @details This filler is used with MemCalSolutionAccessor to read calibration
+/// solutions stored in the parset format (e.g. result.dat written by ParsetCalSolutionAccessor).
+/// The file is parsed line by line, values go straight into the cubes without building
+/// scimath::Params or LOFAR::ParameterSet with string keys.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_PARSET_CAL_SOLUTION_FILLER_H
+#define ASKAP_ACCESSORS_PARSET_CAL_SOLUTION_FILLER_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionFiller.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// std includes
+#include <string>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief solution filler reading a parset file directly into dense cubes
+/// @details The file is parsed once, on the first request of any product. Keys follow the
+/// naming convention of CalParamNameHelper (e.g. gain.g11.1.3, leakage.d12.1.3 and
+/// gain.g11.1.3.10 for the bandpass of channel 10, the bandpass prefix is allowed) and values
+/// are either [re,im] or a real number. Other keys, comments and blank lines are skipped.
+/// The cubes grow as required while the file is parsed, their final shape is given by the 
+/// largest indices present. The bandpasses can be restricted to a range of beams, bandpass 
+/// values of other beams are skipped without parsing their values. This filler is read-only.
+/// @ingroup calibaccess
+class ParsetCalSolutionFiller : virtual public ICalSolutionFiller {
+public:
+  /// @brief constructor
+  /// @details An exception is thrown if the file cannot be opened. Nothing is parsed at this stage.
+  /// @param[in] fname parset file name
+  explicit ParsetCalSolutionFiller(const std::string &fname);
+
+  /// @brief restrict bandpasses to a range of beams
+  /// @details This method should be called before the first access to the data.
+  /// @param[in] startBeam first beam to read
+  /// @param[in] nBeam number of beams to read (0 means all beams starting from startBeam)
+  void setBandpassBeams(const casacore::uInt startBeam, const casacore::uInt nBeam);
+
+  /// @brief gains filler
+  /// @details
+  /// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage filler
+  /// @details
+  /// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass filler
+  /// @details
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+  virtual void fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief gains writer
+  /// @details This filler is read-only, an exception is always thrown
+  /// @param[in] gains pair of cubes with gains and validity flags (should be 2 x nAnt x nBeam)
+  virtual void writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage writer
+  /// @details This filler is read-only, an exception is always thrown
+  /// @param[in] leakages pair of cubes with leakages and validity flags (should be 2 x nAnt x nBeam)
+  virtual void writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass writer
+  /// @details This filler is read-only, an exception is always thrown
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+  virtual void writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief check for gain solution
+  /// @return true, if there is no gain solution, false otherwise
+  virtual bool noGain() const;
+
+  /// @brief check for leakage solution
+  /// @return true, if there is no leakage solution, false otherwise
+  virtual bool noLeakage() const;
+
+  /// @brief check for bandpass solution
+  /// @return true, if there is no bandpass solution, false otherwise
+  virtual bool noBandpass() const;
+
+  /// @brief first beam of the bandpass cube
+  /// @return beam corresponding to the plane 0 of the bandpass cube
+  virtual casacore::uInt bandpassStartBeam() const { return itsBPStartBeam; }
+
+  /// @brief parse the key
+  /// @details This method understands the names formed by CalParamNameHelper without
+  /// creating temporary strings.
+  /// @param[in] key pointer to the first character of the key
+  /// @param[in] end pointer to the character following the key
+  /// @param[out] ant antenna index
+  /// @param[out] beam beam index
+  /// @param[out] row row of the cube (pol for gains and leakages, 2*chan+pol for bandpasses)
+  /// @return 0 for gains, 1 for leakages, 2 for bandpasses and -1 for keys which are
+  /// not related to calibration
+  /// @note An exception is thrown if a key starting with gain or leakage is malformed
+  static int parseKey(const char *key, const char *end, casacore::uInt &ant, casacore::uInt &beam,
+                      casacore::uInt &row);
+
+  /// @brief parse the value
+  /// @param[in] value pointer to the first character of the value
+  /// @param[out] result parsed value
+  /// @return true if the value has been parsed successfully
+  static bool parseValue(const char *value, casacore::Complex &result);
+
+protected:
+  /// @brief parse the file if it hasn't been done yet
+  void parse() const;
+
+  /// @brief store a value
+  /// @details Cubes are extended as required
+  /// @param[in] product product (0 for gains, 1 for leakages, 2 for bandpasses)
+  /// @param[in] row row of the cube
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index (counted from the start of the window for bandpasses)
+  /// @param[in] value value to store
+  void store(const int product, const casacore::uInt row, const casacore::uInt ant, 
+             const casacore::uInt beam, const casacore::Complex &value) const;
+
+  /// @brief change the shape of the cubes preserving the values
+  /// @param[in] product product (0 for gains, 1 for leakages, 2 for bandpasses)
+  /// @param[in] nRow new number of rows
+  /// @param[in] nAnt new number of antennas
+  /// @param[in] nBeam new number of beams
+  void reshape(const int product, const casacore::uInt nRow, const casacore::uInt nAnt, 
+               const casacore::uInt nBeam) const;
+
+private:
+  /// @brief file name
+  std::string itsFileName;
+
+  /// @brief first beam of the bandpasses to read
+  casacore::uInt itsBPStartBeam;
+
+  /// @brief number of beams of the bandpasses to read (0 means all)
+  casacore::uInt itsBPNBeam;
+
+  /// @brief true if the file has been parsed
+  mutable bool itsParsed;
+
+  /// @brief cubes with values and validity flags for gains, leakages and bandpasses
+  mutable std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > itsCubes[3];
+
+  /// @brief largest rows, antennas and beams (plus one) found for each product
+  mutable casacore::uInt itsUsed[3][3];
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PARSET_CAL_SOLUTION_FILLER_H
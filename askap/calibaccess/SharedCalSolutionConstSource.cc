@@ -0,0 +1,88 @@
+/// @file
+/// @brief thread-safe calibration solution source shared by many components
+/// @details This class wraps another read-only calibration solution source and serialises
+/// all calls to it, so one source (and its cache of accessors) can be used by many threads
+/// of the process. Accessors are fully read before they are returned, so they can be
+/// used concurrently without touching the underlying table or file.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/calibaccess/SharedCalSolutionConstSource.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/thread/locks.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] src solution source to share
+SharedCalSolutionConstSource::SharedCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src) :
+       itsSource(src)
+{
+  ASKAPCHECK(itsSource, "An empty shared pointer is passed to SharedCalSolutionConstSource");
+}
+
+/// @brief obtain ID for the most recent solution
+/// @return ID for the most recent solution
+long SharedCalSolutionConstSource::mostRecentSolution() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsSource->mostRecentSolution();
+}
+
+/// @brief obtain solution ID for a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long SharedCalSolutionConstSource::solutionID(const double time) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsSource->solutionID(time);
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @details The accessor is preloaded before it is returned, if it is implemented 
+/// by MemCalSolutionAccessor.
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> SharedCalSolutionConstSource::roSolution(const long id) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const boost::shared_ptr<ICalSolutionConstAccessor> acc = itsSource->roSolution(id);
+  ASKAPDEBUGASSERT(acc);
+  const boost::shared_ptr<MemCalSolutionAccessor> memAcc = boost::dynamic_pointer_cast<MemCalSolutionAccessor>(acc);
+  if (memAcc) {
+      // other threads may get the same cached accessor, it shouldn't read on demand
+      memAcc->preload();
+  }
+  return acc;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,95 @@
+/// @file
+/// @brief thread-safe calibration solution source shared by many components
+/// @details This class wraps another read-only calibration solution source and serialises
+/// all calls to it, so one source (and its cache of accessors) can be used by many threads
+/// of the process. Accessors are fully read before they are returned, so they can be
+/// used concurrently without touching the underlying table or file.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SHARED_CAL_SOLUTION_CONST_SOURCE_H
+#define ASKAP_ACCESSORS_SHARED_CAL_SOLUTION_CONST_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief thread-safe calibration solution source shared by many components
+/// @details All methods lock the mutex before delegating to the wrapped source. Accessors
+/// implemented by MemCalSolutionAccessor are preloaded (see MemCalSolutionAccessor::preload)
+/// while the mutex is locked, so all calibration products are read once and subsequent reads
+/// don't access the table. Accessors are still cached by the wrapped source (e.g. by
+/// TableCalSolutionConstSource), so components requesting the same solution share it.
+/// The wrapped source must not be used directly while this class is in use.
+/// @ingroup calibaccess
+class SharedCalSolutionConstSource : virtual public ICalSolutionConstSource,
+                                     private boost::noncopyable {
+public:
+  /// @brief constructor
+  /// @param[in] src solution source to share
+  explicit SharedCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src);
+
+  /// @brief obtain ID for the most recent solution
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const;
+
+  /// @brief obtain solution ID for a given time
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const;
+
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @details The accessor is preloaded before it is returned, if it is implemented 
+  /// by MemCalSolutionAccessor.
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+  /// @brief wrapped solution source
+  /// @return shared pointer to the source given in the constructor
+  inline const boost::shared_ptr<ICalSolutionConstSource>& source() const { return itsSource; }
+
+private:
+  /// @brief wrapped source
+  const boost::shared_ptr<ICalSolutionConstSource> itsSource;
+
+  /// @brief mutex serialising access to the wrapped source
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SHARED_CAL_SOLUTION_CONST_SOURCE_H
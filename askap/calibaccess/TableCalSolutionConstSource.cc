@@ -33,12 +33,19 @@
 #include <askap/calibaccess/TableCalSolutionConstSource.h>
 #include <askap/calibaccess/TableCalSolutionFiller.h>
 #include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/calibaccess/CalibrationStatistics.h>
+#include <askap/dataaccess/AccessTracer.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <askap/dataaccess/TableLocking.h>
 #include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
 #include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/measures/Measures/MCEpoch.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableError.h>
 
+// std includes
+#include <algorithm>
+
 
 namespace askap {
 
@@ -47,15 +54,29 @@ namespace accessors {
 /// @brief constructor using a table defined explicitly
 /// @details
 /// @param[in] tab table to read the solutions from
-TableCalSolutionConstSource::TableCalSolutionConstSource(const casacore::Table &tab) : TableHolder(tab) {}
+TableCalSolutionConstSource::TableCalSolutionConstSource(const casacore::Table &tab) : TableHolder(tab), 
+        itsCacheLimit(theirDefaultCacheLimit), itsBPStartBeam(0), itsBPNBeam(0), itsBPStartChan(0),
+        itsBPNChan(0)
+{
+  MemoryGovernor::instance().add(this, "calibration solutions", MemoryGovernor::NORMAL_PRIORITY);
+}
   
 /// @brief constructor using a file name
 /// @details The table is opened for reading and an exception is thrown if the table doesn't exist
 /// @param[in] name table file name 
-TableCalSolutionConstSource::TableCalSolutionConstSource(const std::string &name) : 
-        TableHolder(casacore::Table(name)) 
+/// @param[in] lock table locking options, e.g. NoLocking for read-only jobs (see TableLocking)
+TableCalSolutionConstSource::TableCalSolutionConstSource(const std::string &name,
+        const casacore::TableLock &lock) : TableHolder(TableLocking::open(name, lock)), itsCacheLimit(theirDefaultCacheLimit), itsBPStartBeam(0),
+        itsBPNBeam(0), itsBPStartChan(0), itsBPNChan(0)
 {
   ASKAPCHECK(table().nrow()>0, "The table "<<name<<" passed to TableCalSolutionConstSource is empty");
+  MemoryGovernor::instance().add(this, "calibration solutions", MemoryGovernor::NORMAL_PRIORITY);
+}
+
+/// @brief destructor, removes the cache from the memory governor
+TableCalSolutionConstSource::~TableCalSolutionConstSource()
+{
+  MemoryGovernor::instance().remove(this);
 }
 
 
@@ -71,22 +92,56 @@ long TableCalSolutionConstSource::mostRecentSolution() const
 /// @brief obtain solution ID for a given time
 /// @details This method looks for a solution valid at the given time
 /// and returns its ID. It is equivalent to mostRecentSolution() if
-/// called with a time sufficiently into the future.
+/// called with a time sufficiently into the future. The search is done
+/// in the cache of the TIME column, which is extended if the table grows.
 /// @param[in] time time stamp in seconds since MJD of 0.
 /// @return solution ID
 long TableCalSolutionConstSource::solutionID(const double time) const
 {
+  const CalibrationStatistics::ScopedTimer timer(CalibrationStatistics::SOLUTION_ID);
   ASKAPASSERT(table().nrow()>0);
-  casacore::ROScalarMeasColumn<casacore::MEpoch> bufCol(table(),"TIME");
-  for (casacore::uInt row = table().nrow(); row > 0; --row) {
-       const double cTime = bufCol.convert(row - 1,casacore::MEpoch::UTC).get("s").getValue();
-       if (time >= cTime) {
-           return long(row) - 1;
-       }
+  updateTimeCache();
+  // first row with all time stamps from this row onwards exceeding the given time
+  const std::vector<double>::const_iterator it = std::upper_bound(itsSuffixMin.begin(), itsSuffixMin.end(), time);
+  if (it != itsSuffixMin.begin()) {
+      return long(it - itsSuffixMin.begin()) - 1;
   }
   ASKAPTHROW(AskapError, "Unable to find solution matching the time "<<time<<", the table doesn't go that far in the past");
 }
   
+/// @brief bring the cache of the TIME column in sync with the table
+/// @details Time stamps are converted to UTC seconds once per row. Only new rows
+/// are read if the table has grown since the last call. The cache is rebuilt
+/// from scratch if the table has shrunk.
+void TableCalSolutionConstSource::updateTimeCache() const
+{
+  const size_t nRow = table().nrow();
+  if (nRow < itsTimes.size()) {
+      itsTimes.clear();
+      itsSuffixMin.clear();
+  }
+  const size_t nCached = itsTimes.size();
+  if (nRow == nCached) {
+      return;
+  }
+  CalibrationStatistics::instance().addScan(nRow - nCached);
+  casacore::ROScalarMeasColumn<casacore::MEpoch> bufCol(table(),"TIME");
+  itsTimes.resize(nRow);
+  for (size_t row = nCached; row < nRow; ++row) {
+       itsTimes[row] = bufCol.convert(row,casacore::MEpoch::UTC).get("s").getValue();
+  }
+  // update suffix minima from the end, old rows only change if new time stamps are earlier
+  itsSuffixMin.resize(nRow);
+  itsSuffixMin[nRow - 1] = itsTimes[nRow - 1];
+  for (size_t row = nRow - 1; row > 0; --row) {
+       const double newMin = std::min(itsTimes[row - 1], itsSuffixMin[row]);
+       if ((row - 1 < nCached) && (newMin == itsSuffixMin[row - 1])) {
+           break;
+       }
+       itsSuffixMin[row - 1] = newMin;
+  }
+}
+
 /// @brief obtain read-only accessor for a given solution ID
 /// @details This method returns a shared pointer to the solution accessor, which
 /// can be used to read the parameters. If a solution with the given ID doesn't 
@@ -97,12 +152,178 @@ long TableCalSolutionConstSource::solutionID(const double time) const
 /// @return shared pointer to an accessor object
 boost::shared_ptr<ICalSolutionConstAccessor> TableCalSolutionConstSource::roSolution(const long id) const
 {
+  const AccessTracer::Scope trace("roSolution", "calibaccess");
+  const CalibrationStatistics::ScopedTimer timer(CalibrationStatistics::RO_SOLUTION);
   ASKAPCHECK((id >= 0) && (long(table().nrow()) > id), "Requested solution id="<<id<<" is not in the table");
-  boost::shared_ptr<TableCalSolutionFiller> filler(new TableCalSolutionFiller(table(),id));
+  boost::shared_ptr<TableCalSolutionFiller> filler(new TableCalSolutionFiller(table(),id,rowIndex()));
   ASKAPDEBUGASSERT(filler);
-  boost::shared_ptr<MemCalSolutionAccessor> acc(new MemCalSolutionAccessor(filler,true));
-  ASKAPDEBUGASSERT(acc);
-  return acc;
+  filler->setBandpassWindow(itsBPStartBeam, itsBPNBeam, itsBPStartChan, itsBPNChan);
+  if (itsCacheLimit == 0) {
+      CalibrationStatistics::instance().accessorCreated();
+      boost::shared_ptr<MemCalSolutionAccessor> acc(new MemCalSolutionAccessor(wrapFiller(filler, id),true));
+      ASKAPDEBUGASSERT(acc);
+      return acc;
+  }
+  boost::shared_ptr<MemCalSolutionAccessor> result;
+  {
+    boost::lock_guard<boost::mutex> lock(itsCacheMutex);
+    result = cachedAccessor(id, filler);
+  }
+  // solutions read by the cached accessors may have pushed the total over the budget
+  MemoryGovernor::instance().enforce();
+  return result;
+}
+
+/// @brief find the accessor in the cache or create a new one
+/// @details This method should be called with the cache mutex locked.
+/// @param[in] id solution ID to read
+/// @param[in] filler table-based filler set up for the given solution
+/// @return shared pointer to the accessor (the most recently used entry of the cache)
+boost::shared_ptr<MemCalSolutionAccessor> TableCalSolutionConstSource::cachedAccessor(const long id,
+                  const boost::shared_ptr<TableCalSolutionFiller> &filler) const
+{
+  for (std::list<CacheEntry>::iterator it = itsAccessorCache.begin(); it != itsAccessorCache.end(); ++it) {
+       if (std::find(it->itsIDs.begin(), it->itsIDs.end(), id) != it->itsIDs.end()) {
+           itsAccessorCache.splice(itsAccessorCache.begin(), itsAccessorCache, it);
+           CalibrationStatistics::instance().accessorReused();
+           return itsAccessorCache.front().itsAccessor;
+       }
+  }
+  CacheEntry entry;
+  filler->resolveRows(entry.itsGainsRow, entry.itsLeakagesRow, entry.itsBandpassesRow);
+  for (std::list<CacheEntry>::iterator it = itsAccessorCache.begin(); it != itsAccessorCache.end(); ++it) {
+       if ((it->itsGainsRow == entry.itsGainsRow) && (it->itsLeakagesRow == entry.itsLeakagesRow) &&
+           (it->itsBandpassesRow == entry.itsBandpassesRow)) {
+           it->itsIDs.push_back(id);
+           itsAccessorCache.splice(itsAccessorCache.begin(), itsAccessorCache, it);
+           CalibrationStatistics::instance().accessorReused();
+           return itsAccessorCache.front().itsAccessor;
+       }
+  }
+  entry.itsIDs.push_back(id);
+  CalibrationStatistics::instance().accessorCreated();
+  entry.itsAccessor.reset(new MemCalSolutionAccessor(wrapFiller(filler, id),true));
+  ASKAPDEBUGASSERT(entry.itsAccessor);
+  itsAccessorCache.push_front(entry);
+  trimCache();
+  return entry.itsAccessor;
+}
+
+/// @brief obtain the time stamp of the given solution
+/// @param[in] id solution ID
+/// @return time stamp in seconds since MJD of 0 (UTC)
+double TableCalSolutionConstSource::solutionTime(const long id) const
+{
+  updateTimeCache();
+  ASKAPCHECK((id >= 0) && (long(itsTimes.size()) > id), "Requested solution id="<<id<<" is not in the table");
+  return itsTimes[size_t(id)];
+}
+
+/// @brief set the memory limit for the cache of read-only accessors
+/// @details The least recently used accessors are dropped when the memory held by the cached
+/// solutions exceeds the limit. The most recently used accessor is always kept.
+/// Zero limit disables caching.
+/// @param[in] limit memory limit in bytes
+void TableCalSolutionConstSource::setCacheLimit(const size_t limit)
+{
+  boost::lock_guard<boost::mutex> lock(itsCacheMutex);
+  itsCacheLimit = limit;
+  if (itsCacheLimit == 0) {
+      itsAccessorCache.clear();
+  } else {
+      trimCache();
+  }
+}
+
+/// @brief memory held by the cached accessors
+/// @return number of bytes held by the solutions read so far
+size_t TableCalSolutionConstSource::memoryUsage() const
+{
+  boost::lock_guard<boost::mutex> lock(itsCacheMutex);
+  size_t total = 0;
+  for (std::list<CacheEntry>::const_iterator ci = itsAccessorCache.begin(); ci != itsAccessorCache.end(); ++ci) {
+       ASKAPDEBUGASSERT(ci->itsAccessor);
+       total += ci->itsAccessor->memoryUsage();
+  }
+  return total;
+}
+
+/// @brief drop the least recently used accessors
+/// @details This method is called by MemoryGovernor if the global budget is exceeded.
+/// The most recently used accessor is always kept. Accessors still used elsewhere are
+/// dropped from the cache, but their memory is only freed when they are released.
+/// @param[in] nBytes number of bytes to release
+/// @return number of bytes held by the dropped accessors
+size_t TableCalSolutionConstSource::releaseMemory(size_t nBytes)
+{
+  boost::lock_guard<boost::mutex> lock(itsCacheMutex);
+  size_t released = 0;
+  while ((released < nBytes) && (itsAccessorCache.size() > 1)) {
+     ASKAPDEBUGASSERT(itsAccessorCache.back().itsAccessor);
+     released += itsAccessorCache.back().itsAccessor->memoryUsage();
+     itsAccessorCache.pop_back();
+  }
+  return released;
+}
+
+/// @brief restrict bandpass reading to a window of beams and channels
+/// @details Only the given part of the bandpass is read from the table for all accessors
+/// returned by roSolution (see TableCalSolutionFiller::setBandpassWindow). Bandpasses can then
+/// only be requested for channels and beams inside the window. All zeros (default) mean
+/// that the whole bandpass is read. Cached accessors are dropped.
+/// @param[in] startBeam first beam to read
+/// @param[in] nBeam number of beams to read, 0 means up to the last beam
+/// @param[in] startChan first channel to read
+/// @param[in] nChan number of channels to read, 0 means up to the last channel
+void TableCalSolutionConstSource::setBandpassWindow(const casacore::uInt startBeam, const casacore::uInt nBeam,
+                         const casacore::uInt startChan, const casacore::uInt nChan)
+{
+  itsBPStartBeam = startBeam;
+  itsBPNBeam = nBeam;
+  itsBPStartChan = startChan;
+  itsBPNChan = nChan;
+  boost::lock_guard<boost::mutex> lock(itsCacheMutex);
+  itsAccessorCache.clear();
+}
+
+/// @brief filler to be used by the read-only accessor
+/// @details This method allows derived classes to decorate the table-based filler
+/// before it is given to the accessor. The default implementation returns the
+/// filler unchanged.
+/// @param[in] filler table-based filler set up for the given solution
+/// @param[in] id solution ID
+/// @return filler to be used by the accessor
+boost::shared_ptr<ICalSolutionFiller> TableCalSolutionConstSource::wrapFiller(
+        const boost::shared_ptr<TableCalSolutionFiller> &filler, const long) const
+{
+  return filler;
+}
+
+/// @brief index of rows defining gains, leakages and bandpasses
+/// @details The index is created on the first call and shared by all fillers
+/// created by this source.
+/// @return shared pointer to the index
+const TableCalSolutionRowIndex::ShPtr& TableCalSolutionConstSource::rowIndex() const
+{
+  if (!itsRowIndex) {
+      itsRowIndex.reset(new TableCalSolutionRowIndex(table()));
+  }
+  return itsRowIndex;
+}
+
+/// @brief drop the least recently used accessors if the memory limit is exceeded
+void TableCalSolutionConstSource::trimCache() const
+{
+  size_t total = 0;
+  for (std::list<CacheEntry>::iterator it = itsAccessorCache.begin(); it != itsAccessorCache.end(); ++it) {
+       ASKAPDEBUGASSERT(it->itsAccessor);
+       total += it->itsAccessor->memoryUsage();
+       if ((total > itsCacheLimit) && (it != itsAccessorCache.begin())) {
+           // this and all less recently used entries have to go, the first one is always kept
+           itsAccessorCache.erase(it, itsAccessorCache.end());
+           break;
+       }
+  }
 }
 
 /// @brief check that the table exists and can be opened
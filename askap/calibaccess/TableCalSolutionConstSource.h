@@ -35,29 +35,45 @@
 
 // own includes
 #include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/calibaccess/TableCalSolutionRowIndex.h>
 #include <askap/dataaccess/TableHolder.h>
+#include <askap/dataaccess/IMemoryConsumer.h>
 
 // casa includes
 #include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableLock.h>
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 
 // std includes
 #include <string>
+#include <vector>
+#include <list>
 
 namespace askap {
 
 namespace accessors {
 
+// forward declaration
+class TableCalSolutionFiller;
+
 /// @brief table-based implementation of the calibration solution source
 /// @details This implementation reads calibration solutions from a casa table
 /// Main functionality is implemented in the corresponding TableCalSolutionFiller class.
 /// This class manages the time/row dependence and creates an instance of the 
 /// MemCalSolutionAccessor with above mentioned filler when a read-only accessor is
-/// requested.
+/// requested. Read-only accessors are kept in a least recently used cache, so repeated
+/// requests for the same solution (or for a different solution ID resolving to the same
+/// table rows for gains, leakages and bandpasses) don't cause the table to be reread.
+/// The cache is registered with MemoryGovernor, which can drop the least recently used
+/// accessors if the global memory budget is exceeded.
 /// @ingroup calibaccess
 class TableCalSolutionConstSource : virtual public ICalSolutionConstSource,
+                                    virtual public IMemoryConsumer,
                                     virtual protected TableHolder {
 public:  
 
@@ -69,7 +85,12 @@ public:
   /// @brief constructor using a file name
   /// @details The table is opened for reading and an exception is thrown if the table doesn't exist
   /// @param[in] name table file name 
-  TableCalSolutionConstSource(const std::string &name);
+  /// @param[in] lock table locking options, e.g. NoLocking for read-only jobs (see TableLocking)
+  TableCalSolutionConstSource(const std::string &name,
+                              const casacore::TableLock &lock = casacore::TableLock());
+
+  /// @brief destructor, removes the cache from the memory governor
+  virtual ~TableCalSolutionConstSource();
 
   // virtual methods of the interface
   
@@ -80,7 +101,8 @@ public:
   /// @brief obtain solution ID for a given time
   /// @details This method looks for a solution valid at the given time
   /// and returns its ID. It is equivalent to mostRecentSolution() if
-  /// called with a time sufficiently into the future.
+  /// called with a time sufficiently into the future. The search is done
+  /// in the cache of the TIME column, which is extended if the table grows.
   /// @param[in] time time stamp in seconds since MJD of 0.
   /// @return solution ID
   virtual long solutionID(const double time) const;
@@ -93,7 +115,45 @@ public:
   /// are managed via validity flags of gains, leakages and bandpasses
   /// @param[in] id solution ID to read
   /// @return shared pointer to an accessor object
+  /// @note Accessors are cached, the same object can be returned for different IDs if the 
+  /// solutions are read from the same rows.
   virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+  /// @brief obtain the time stamp of the given solution
+  /// @param[in] id solution ID
+  /// @return time stamp in seconds since MJD of 0 (UTC)
+  double solutionTime(const long id) const;
+
+  /// @brief set the memory limit for the cache of read-only accessors
+  /// @details The least recently used accessors are dropped when the memory held by the cached
+  /// solutions exceeds the limit. The most recently used accessor is always kept.
+  /// Zero limit disables caching.
+  /// @param[in] limit memory limit in bytes
+  void setCacheLimit(const size_t limit);
+
+  /// @brief memory held by the cached accessors
+  /// @return number of bytes held by the solutions read so far
+  virtual size_t memoryUsage() const;
+
+  /// @brief drop the least recently used accessors
+  /// @details This method is called by MemoryGovernor if the global budget is exceeded.
+  /// The most recently used accessor is always kept. Accessors still used elsewhere are
+  /// dropped from the cache, but their memory is only freed when they are released.
+  /// @param[in] nBytes number of bytes to release
+  /// @return number of bytes held by the dropped accessors
+  virtual size_t releaseMemory(size_t nBytes);
+
+  /// @brief restrict bandpass reading to a window of beams and channels
+  /// @details Only the given part of the bandpass is read from the table for all accessors
+  /// returned by roSolution (see TableCalSolutionFiller::setBandpassWindow). Bandpasses can then
+  /// only be requested for channels and beams inside the window. All zeros (default) mean
+  /// that the whole bandpass is read. Cached accessors are dropped.
+  /// @param[in] startBeam first beam to read
+  /// @param[in] nBeam number of beams to read, 0 means up to the last beam
+  /// @param[in] startChan first channel to read
+  /// @param[in] nChan number of channels to read, 0 means up to the last channel
+  void setBandpassWindow(const casacore::uInt startBeam, const casacore::uInt nBeam,
+                         const casacore::uInt startChan, const casacore::uInt nChan);
   
   /// @brief shared pointer definition
   typedef boost::shared_ptr<TableCalSolutionConstSource> ShPtr;
@@ -105,6 +165,95 @@ public:
   /// @param[in] fname file name of the table to test
   /// @return true, if table exists and is useable, false otherwise
   static bool tableExists(const std::string &fname);
+
+protected:
+  /// @brief bring the cache of the TIME column in sync with the table
+  /// @details Time stamps are converted to UTC seconds once per row. Only new rows
+  /// are read if the table has grown since the last call. The cache is rebuilt
+  /// from scratch if the table has shrunk.
+  void updateTimeCache() const;
+
+  /// @brief drop the least recently used accessors if the memory limit is exceeded
+  /// @details This method should be called with the cache mutex locked.
+  void trimCache() const;
+
+  /// @brief find the accessor in the cache or create a new one
+  /// @details This method should be called with the cache mutex locked.
+  /// @param[in] id solution ID to read
+  /// @param[in] filler table-based filler set up for the given solution
+  /// @return shared pointer to the accessor (the most recently used entry of the cache)
+  boost::shared_ptr<MemCalSolutionAccessor> cachedAccessor(const long id,
+                  const boost::shared_ptr<TableCalSolutionFiller> &filler) const;
+
+  /// @brief filler to be used by the read-only accessor
+  /// @details This method allows derived classes to decorate the table-based filler
+  /// before it is given to the accessor. The default implementation returns the
+  /// filler unchanged.
+  /// @param[in] filler table-based filler set up for the given solution
+  /// @param[in] id solution ID
+  /// @return filler to be used by the accessor
+  virtual boost::shared_ptr<ICalSolutionFiller> wrapFiller(const boost::shared_ptr<TableCalSolutionFiller> &filler,
+                                                           const long id) const;
+
+  /// @brief index of rows defining gains, leakages and bandpasses
+  /// @details The index is created on the first call and shared by all fillers
+  /// created by this source.
+  /// @return shared pointer to the index
+  const TableCalSolutionRowIndex::ShPtr& rowIndex() const;
+
+  /// @brief default memory limit for the cache of read-only accessors in bytes
+  static const size_t theirDefaultCacheLimit = 512 * 1024 * 1024;
+
+private:
+  /// @brief cached read-only accessor
+  struct CacheEntry {
+     /// @brief solution IDs known to resolve to this accessor
+     std::vector<long> itsIDs;
+     /// @brief row with gains (-1 if undefined)
+     long itsGainsRow;
+     /// @brief row with leakages (-1 if undefined)
+     long itsLeakagesRow;
+     /// @brief row with bandpasses (-1 if undefined)
+     long itsBandpassesRow;
+     /// @brief accessor
+     boost::shared_ptr<MemCalSolutionAccessor> itsAccessor;
+  };
+
+  /// @brief memory limit for the cache in bytes
+  size_t itsCacheLimit;
+
+  /// @brief first beam of the bandpass window
+  casacore::uInt itsBPStartBeam;
+
+  /// @brief number of beams in the bandpass window (0 means up to the last beam)
+  casacore::uInt itsBPNBeam;
+
+  /// @brief first channel of the bandpass window
+  casacore::uInt itsBPStartChan;
+
+  /// @brief number of channels in the bandpass window (0 means up to the last channel)
+  casacore::uInt itsBPNChan;
+
+  /// @brief index of rows defining the cubes, created on demand
+  mutable TableCalSolutionRowIndex::ShPtr itsRowIndex;
+
+  /// @brief cached accessors, the most recently used first
+  /// @details The number of cached solutions is expected to be small, so the linear search is fine
+  mutable std::list<CacheEntry> itsAccessorCache;
+
+  /// @brief mutex protecting the cache of accessors
+  /// @details The cache can be trimmed by MemoryGovernor from another thread
+  mutable boost::mutex itsCacheMutex;
+
+  /// @brief cached time stamps (UTC seconds) for all rows
+  mutable std::vector<double> itsTimes;
+
+  /// @brief minimum of the time stamps in the given row and all rows after it
+  /// @details This sequence is non-decreasing even if the time stamps are not sorted,
+  /// and the last row with the suffix minimum not exceeding the given time is the 
+  /// last row with the time stamp not exceeding it. Therefore, a binary search
+  /// gives the same result as the backward search through the table.
+  mutable std::vector<double> itsSuffixMin;
 };
 
 
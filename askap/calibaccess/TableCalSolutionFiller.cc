@@ -36,19 +36,40 @@
 /// @author Max Voronkov <Maxim.Voronkov@csiro.au>
 
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <askap/calibaccess/TableCalSolutionFiller.h>
+#include <askap/calibaccess/CalibrationStatistics.h>
+#include <askap/dataaccess/AccessTracer.h>
 
 namespace askap {
 
 namespace accessors {
 
+namespace {
+
+/// @brief size of the cached calibration product
+/// @param[in] cubes pair of cubes with values and validity flags
+/// @return number of bytes
+casacore::uInt64 cubeBytes(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes)
+{
+  return casacore::uInt64(cubes.first.nelements()) * sizeof(casacore::Complex) +
+         casacore::uInt64(cubes.second.nelements()) * sizeof(casacore::Bool);
+}
+
+} // anonymous namespace
+
 /// @brief construct the object and link it to the given table
 /// @details read-only operation is assumed
 /// @param[in] tab  table to use
 /// @param[in] row reference row
-TableCalSolutionFiller::TableCalSolutionFiller(const casa::Table& tab, const long row) : TableHolder(tab),
+/// @param[in] index optional shared index of rows defining the cubes
+TableCalSolutionFiller::TableCalSolutionFiller(const casa::Table& tab, const long row, 
+       const TableCalSolutionRowIndex::ShPtr &index) : TableHolder(tab),
        TableBufferManager(tab), itsNAnt(0), itsNBeam(0), itsNChan(0), itsRefRow(row), itsGainsRow(-1),
-       itsLeakagesRow(-1), itsBandpassesRow(-1)
+       itsLeakagesRow(-1), itsBandpassesRow(-1), itsRowIndex(index), itsBPStartBeam(0),
+       itsBPNBeam(0), itsBPStartChan(0), itsBPNChan(0), itsTileNChan(theirDefaultTileChannels),
+       itsTileNAnt(theirDefaultTileAntennas), itsTileNBeam(theirDefaultTileBeams), itsKeyframeInterval(0)
 {
   ASKAPCHECK((itsRefRow >= 0) && (itsRefRow <= long(table().nrow())), "Requested calibration solution ID = "<<itsRefRow<<" is outside calibration table");
   // this is the reading case, we can use either of itsNAnt, itsNBeam or itsNChan to test this condition (they should be all 0). This is encapsulated in
@@ -65,10 +86,13 @@ TableCalSolutionFiller::TableCalSolutionFiller(const casa::Table& tab, const lon
 /// @param[in] nAnt maximum number of antennas
 /// @param[in] nBeam maximum number of beams
 /// @param[in] nChan maximum number of channels
+/// @param[in] index optional shared index of rows defining the cubes
 TableCalSolutionFiller::TableCalSolutionFiller(const casa::Table& tab, const long row, const casa::uInt nAnt,
-          const casa::uInt nBeam, const casa::uInt nChan) : TableHolder(tab),
+          const casa::uInt nBeam, const casa::uInt nChan, const TableCalSolutionRowIndex::ShPtr &index) : TableHolder(tab),
        TableBufferManager(tab), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan), itsRefRow(row), itsGainsRow(-1),
-       itsLeakagesRow(-1), itsBandpassesRow(-1) 
+       itsLeakagesRow(-1), itsBandpassesRow(-1), itsRowIndex(index), itsBPStartBeam(0),
+       itsBPNBeam(0), itsBPStartChan(0), itsBPNChan(0), itsTileNChan(theirDefaultTileChannels),
+       itsTileNAnt(theirDefaultTileAntennas), itsTileNBeam(theirDefaultTileBeams), itsKeyframeInterval(0)
 {
   ASKAPCHECK((itsRefRow >= 0) && (itsRefRow <= long(table().nrow())), "Requested calibration solution ID = "<<itsRefRow<<" is outside calibration table");
   // this is the writing case, so numbers of antennas, beams and channels should be positive
@@ -130,14 +154,19 @@ bool TableCalSolutionFiller::columnExists(const std::string &name) const
 /// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
 void TableCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
 {
+  const AccessTracer::Scope trace("fillGains", "calibaccess");
+  const CalibrationStatistics::ScopedTimer timer(CalibrationStatistics::FILL_GAINS);
   // cellDefined should not be called if noGain returns true according to C++ evaluation rules.
   const bool needToCreateGains = noGain() || !cellDefined<casa::Complex>("GAIN", casa::uInt(itsRefRow));
   if (!isReadOnly() && needToCreateGains) {
       ASKAPDEBUGASSERT(itsGainsRow < 0);
-      gains.first.resize(2, itsNAnt, itsNBeam);
-      gains.first.set(1.);
-      gains.second.resize(2, itsNAnt, itsNBeam);
-      gains.second.set(false);
+      // in the differential mode new solutions start from the previous one
+      if ((itsKeyframeInterval == 0) || !readState(gains, "GAIN", itsRefRow, NULL)) {
+          gains.first.resize(2, itsNAnt, itsNBeam);
+          gains.first.set(1.);
+          gains.second.resize(2, itsNAnt, itsNBeam);
+          gains.second.set(false);
+      }
       itsGainsRow = itsRefRow;
   } else {
      // this is the case wwhere either the table is read-only or there is a need to read data first
@@ -151,10 +180,10 @@ void TableCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Comple
          ASKAPDEBUGASSERT(isReadOnly());
          ASKAPDEBUGASSERT(needToCreateGains);
      }
-     ASKAPCHECK(cellDefined<casa::Bool>("GAIN_VALID", casa::uInt(itsGainsRow)), 
-         "Wrong format of the calibration table: GAIN element should always be accompanied by GAIN_VALID");
-     readCube(gains.first, "GAIN", casacore::uInt(itsGainsRow));
-     readCube(gains.second, "GAIN_VALID", casacore::uInt(itsGainsRow));
+     if (!readState(gains, "GAIN", itsGainsRow, NULL)) {
+         ASKAPTHROW(AskapError, "Unable to find a full cube in column GAIN at row "<<itsGainsRow<<" or earlier");
+     }
+     CalibrationStatistics::instance().addBytes(CalibrationStatistics::FILL_GAINS, cubeBytes(gains));
   }
   ASKAPCHECK(gains.first.shape() == gains.second.shape(), "GAIN and GAIN_VALID cubes are expected to have the same shape");
 }
@@ -164,14 +193,19 @@ void TableCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Comple
 /// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
 void TableCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
 {
+  const AccessTracer::Scope trace("fillLeakages", "calibaccess");
+  const CalibrationStatistics::ScopedTimer timer(CalibrationStatistics::FILL_LEAKAGES);
   // cellDefined should not be called if noGain returns true according to C++ evaluation rules.
   const bool needToCreateLeakage = noLeakage() || !cellDefined<casa::Complex>("LEAKAGE", casa::uInt(itsRefRow));
   if (!isReadOnly() && needToCreateLeakage) {
       ASKAPDEBUGASSERT(itsLeakagesRow < 0);
-      leakages.first.resize(2, itsNAnt, itsNBeam);
-      leakages.first.set(0.);
-      leakages.second.resize(2, itsNAnt, itsNBeam);
-      leakages.second.set(false);
+      // in the differential mode new solutions start from the previous one
+      if ((itsKeyframeInterval == 0) || !readState(leakages, "LEAKAGE", itsRefRow, NULL)) {
+          leakages.first.resize(2, itsNAnt, itsNBeam);
+          leakages.first.set(0.);
+          leakages.second.resize(2, itsNAnt, itsNBeam);
+          leakages.second.set(false);
+      }
       itsLeakagesRow = itsRefRow;
   } else {
      // this is the case wwhere either the table is read-only or there is a need to read data first
@@ -184,10 +218,10 @@ void TableCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Com
          ASKAPDEBUGASSERT(isReadOnly());
          ASKAPDEBUGASSERT(needToCreateLeakage);
      }
-     ASKAPCHECK(cellDefined<casa::Bool>("LEAKAGE_VALID", casa::uInt(itsLeakagesRow)), 
-         "Wrong format of the calibration table: LEAKAGE element should always be accompanied by LEAKAGE_VALID");
-     readCube(leakages.first, "LEAKAGE", casacore::uInt(itsLeakagesRow));
-     readCube(leakages.second, "LEAKAGE_VALID", casacore::uInt(itsLeakagesRow));
+     if (!readState(leakages, "LEAKAGE", itsLeakagesRow, NULL)) {
+         ASKAPTHROW(AskapError, "Unable to find a full cube in column LEAKAGE at row "<<itsLeakagesRow<<" or earlier");
+     }
+     CalibrationStatistics::instance().addBytes(CalibrationStatistics::FILL_LEAKAGES, cubeBytes(leakages));
   }
   ASKAPCHECK(leakages.first.shape() == leakages.second.shape(), "LEAKAGE and LEAKAGE_VALID cubes are expected to have the same shape");
 }
@@ -197,14 +231,19 @@ void TableCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Com
 /// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
 void TableCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
 {
+  const AccessTracer::Scope trace("fillBandpasses", "calibaccess");
+  const CalibrationStatistics::ScopedTimer timer(CalibrationStatistics::FILL_BANDPASSES);
   // cellDefined should not be called if noGain returns true according to C++ evaluation rules.
   const bool needToCreateBandpass = noBandpass() || !cellDefined<casa::Complex>("BANDPASS", casa::uInt(itsRefRow));
   if (!isReadOnly() && needToCreateBandpass) {
       ASKAPDEBUGASSERT(itsBandpassesRow < 0);
-      bp.first.resize(2 * itsNChan, itsNAnt, itsNBeam);
-      bp.first.set(1.);
-      bp.second.resize(2 * itsNChan, itsNAnt, itsNBeam);
-      bp.second.set(false);
+      // in the differential mode new solutions start from the previous one
+      if ((itsKeyframeInterval == 0) || !readState(bp, "BANDPASS", itsRefRow, NULL)) {
+          bp.first.resize(2 * itsNChan, itsNAnt, itsNBeam);
+          bp.first.set(1.);
+          bp.second.resize(2 * itsNChan, itsNAnt, itsNBeam);
+          bp.second.set(false);
+      }
       itsBandpassesRow = itsRefRow;
   } else {
      // this is the case wwhere either the table is read-only or there is a need to read data first
@@ -217,10 +256,30 @@ void TableCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::C
          ASKAPDEBUGASSERT(isReadOnly());
          ASKAPDEBUGASSERT(needToCreateBandpass);
      }
-     ASKAPCHECK(cellDefined<casa::Bool>("BANDPASS_VALID", casa::uInt(itsBandpassesRow)), 
-         "Wrong format of the calibration table: BANDPASS element should always be accompanied by BANDPASS_VALID");
-     readCube(bp.first, "BANDPASS", casacore::uInt(itsBandpassesRow));
-     readCube(bp.second, "BANDPASS_VALID", casacore::uInt(itsBandpassesRow));
+     // the full cube is stored at the keyframe, the solution row may only have a differential update
+     const long keyframeRow = lastCellRow("BANDPASS", itsBandpassesRow);
+     if (keyframeRow < 0) {
+         ASKAPTHROW(AskapError, "Unable to find a full cube in column BANDPASS at row "<<itsBandpassesRow<<" or earlier");
+     }
+     if ((itsBPStartBeam == 0) && (itsBPNBeam == 0) && (itsBPStartChan == 0) && (itsBPNChan == 0)) {
+         readState(bp, "BANDPASS", itsBandpassesRow, NULL);
+     } else {
+         // read only the requested window, the shape of the cell is (2*nChan) x nAnt x nBeam
+         const casacore::IPosition shape = cellShape<casacore::Complex>("BANDPASS", casacore::uInt(keyframeRow));
+         ASKAPDEBUGASSERT(shape.nelements() == 3);
+         const casacore::uInt nChanTotal = casacore::uInt(shape[0]) / 2;
+         const casacore::uInt nBeamTotal = casacore::uInt(shape[2]);
+         ASKAPCHECK(itsBPStartChan + itsBPNChan <= nChanTotal && itsBPStartChan < nChanTotal, "Requested bandpass window (start channel = "<<
+                    itsBPStartChan<<", nChan = "<<itsBPNChan<<") is outside the bandpass with "<<nChanTotal<<" channels");
+         ASKAPCHECK(itsBPStartBeam + itsBPNBeam <= nBeamTotal && itsBPStartBeam < nBeamTotal, "Requested bandpass window (start beam = "<<
+                    itsBPStartBeam<<", nBeam = "<<itsBPNBeam<<") is outside the bandpass with "<<nBeamTotal<<" beams");
+         const casacore::uInt nChan = itsBPNChan > 0 ? itsBPNChan : nChanTotal - itsBPStartChan;
+         const casacore::uInt nBeam = itsBPNBeam > 0 ? itsBPNBeam : nBeamTotal - itsBPStartBeam;
+         const casacore::Slicer slicer(casacore::IPosition(3, 2 * itsBPStartChan, 0, itsBPStartBeam),
+                                       casacore::IPosition(3, 2 * nChan, shape[1], nBeam));
+         readState(bp, "BANDPASS", itsBandpassesRow, &slicer);
+     }
+     CalibrationStatistics::instance().addBytes(CalibrationStatistics::FILL_BANDPASSES, cubeBytes(bp));
   }
   ASKAPCHECK(bp.first.shape() == bp.second.shape(), "BANDPASS and BANDPASS_VALID cubes are expected to have the same shape");
 }
@@ -230,10 +289,14 @@ void TableCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::C
 /// @param[in] gains pair of cubes with gains and validity flags (should be 2 x nAnt x nBeam)
 void TableCalSolutionFiller::writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
 {
+  const AccessTracer::Scope trace("writeGains", "calibaccess");
+  if ((itsGainsRow < 0) && !isReadOnly()) {
+      // read-write access always writes the reference row, the cube doesn't need to be read first
+      itsGainsRow = itsRefRow;
+  }
   ASKAPASSERT(itsGainsRow>=0);
   ASKAPCHECK(gains.first.shape() == gains.second.shape(), "The cubes with gains and validity flags are expected to have the same shape");
-  writeCube(gains.first, "GAIN", casa::uInt(itsGainsRow));
-  writeCube(gains.second, "GAIN_VALID", casa::uInt(itsGainsRow));
+  writeState(gains, "GAIN", itsGainsRow);
 }
 
 /// @brief leakage writer
@@ -241,10 +304,14 @@ void TableCalSolutionFiller::writeGains(const std::pair<casacore::Cube<casacore:
 /// @param[in] leakages pair of cubes with leakages and validity flags (should be 2 x nAnt x nBeam)
 void TableCalSolutionFiller::writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
 {
+  const AccessTracer::Scope trace("writeLeakages", "calibaccess");
+  if ((itsLeakagesRow < 0) && !isReadOnly()) {
+      // read-write access always writes the reference row, the cube doesn't need to be read first
+      itsLeakagesRow = itsRefRow;
+  }
   ASKAPASSERT(itsLeakagesRow>=0);
   ASKAPCHECK(leakages.first.shape() == leakages.second.shape(), "The cubes with leakages and validity flags are expected to have the same shape");
-  writeCube(leakages.first, "LEAKAGE", casa::uInt(itsLeakagesRow));
-  writeCube(leakages.second, "LEAKAGE_VALID", casa::uInt(itsLeakagesRow));
+  writeState(leakages, "LEAKAGE", itsLeakagesRow);
 }
 
 /// @brief bandpass writer
@@ -252,10 +319,77 @@ void TableCalSolutionFiller::writeLeakages(const std::pair<casacore::Cube<casaco
 /// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
 void TableCalSolutionFiller::writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
 {
+  const AccessTracer::Scope trace("writeBandpasses", "calibaccess");
+  if ((itsBandpassesRow < 0) && !isReadOnly()) {
+      // read-write access always writes the reference row, the cube doesn't need to be read first
+      itsBandpassesRow = itsRefRow;
+  }
   ASKAPASSERT(itsBandpassesRow>=0);
   ASKAPCHECK(bp.first.shape() == bp.second.shape(), "The cubes with bandpasses and validity flags are expected to have the same shape");
-  writeCube(bp.first, "BANDPASS", casa::uInt(itsBandpassesRow));
-  writeCube(bp.second, "BANDPASS_VALID", casa::uInt(itsBandpassesRow));
+  writeState(bp, "BANDPASS", itsBandpassesRow);
+}
+
+/// @brief bandpass model filler
+/// @details The model is reset if the bandpass is given by the cubes
+/// @param[in] model shared pointer to the model to set up
+void TableCalSolutionFiller::fillBandpassModel(boost::shared_ptr<ParametricBandpass> &model) const
+{
+  const AccessTracer::Scope trace("fillBandpassModel", "calibaccess");
+  const CalibrationStatistics::ScopedTimer timer(CalibrationStatistics::FILL_BANDPASS_MODEL);
+  model.reset();
+  const long row = bandpassModelRow();
+  if (row < 0) {
+      return;
+  }
+  ASKAPCHECK(cellDefined<casacore::Bool>("BANDPASS_MODEL_VALID", casacore::uInt(row)) && 
+             cellDefined<casacore::Int>("BANDPASS_MODEL_SHAPE", casacore::uInt(row)), 
+             "Wrong format of the calibration table: BANDPASS_MODEL element should always be accompanied by "
+             "BANDPASS_MODEL_VALID and BANDPASS_MODEL_SHAPE");
+  casacore::Cube<casacore::Complex> coeffs;
+  casacore::Cube<casacore::Bool> validity;
+  casacore::Cube<casacore::Int> params;
+  readCube(coeffs, "BANDPASS_MODEL", casacore::uInt(row));
+  readCube(validity, "BANDPASS_MODEL_VALID", casacore::uInt(row));
+  readCube(params, "BANDPASS_MODEL_SHAPE", casacore::uInt(row));
+  ASKAPCHECK((params.nelements() == 3) && (params(0, 0, 0) > 0) && (params(1, 0, 0) > 0) && (params(2, 0, 0) >= 0), 
+             "Wrong format of the BANDPASS_MODEL_SHAPE cell at row "<<row<<", shape: "<<params.shape());
+  model.reset(new ParametricBandpass(casacore::uInt(params(0, 0, 0)), casacore::uInt(params(1, 0, 0)),
+                                     casacore::uInt(params(2, 0, 0)), coeffs, validity));
+  CalibrationStatistics::instance().addBytes(CalibrationStatistics::FILL_BANDPASS_MODEL,
+             casacore::uInt64(coeffs.nelements()) * sizeof(casacore::Complex) +
+             casacore::uInt64(validity.nelements()) * sizeof(casacore::Bool) +
+             casacore::uInt64(params.nelements()) * sizeof(casacore::Int));
+}
+
+/// @brief bandpass model writer
+/// @details The model is always written as a whole, differential updates are not supported
+/// @param[in] model parametric bandpass to write
+void TableCalSolutionFiller::writeBandpassModel(const ParametricBandpass &model) const
+{
+  const AccessTracer::Scope trace("writeBandpassModel", "calibaccess");
+  ASKAPCHECK(!isReadOnly(), "Bandpass model can't be written via the read-only solution filler");
+  ASKAPCHECK(model.nChan() > 0, "An attempt to write an empty bandpass model");
+  casacore::Cube<casacore::Int> params(3, 1, 1);
+  params(0, 0, 0) = casacore::Int(model.nChan());
+  params(1, 0, 0) = casacore::Int(model.chansPerBlock());
+  params(2, 0, 0) = casacore::Int(model.order());
+  writeCube(model.coefficients(), "BANDPASS_MODEL", casacore::uInt(itsRefRow));
+  writeCube(model.validity(), "BANDPASS_MODEL_VALID", casacore::uInt(itsRefRow));
+  writeCube(params, "BANDPASS_MODEL_SHAPE", casacore::uInt(itsRefRow));
+  cellWritten("BANDPASS_MODEL", itsRefRow);
+}
+
+/// @brief find the row with the bandpass model to use
+/// @details The model is only used if the bandpass cube is not defined at the same or a later row.
+/// For read-write access, only the reference row is considered.
+/// @return row number or -1 if the bandpass cubes should be used
+long TableCalSolutionFiller::bandpassModelRow() const
+{
+  const long row = lastCellRow("BANDPASS_MODEL", itsRefRow);
+  if ((row < 0) || (!isReadOnly() && (row != itsRefRow))) {
+      return -1;
+  }
+  return row > lastDefinedRow("BANDPASS") ? row : -1;
 }
 
 /// @brief find first defined cube searching backwards
@@ -267,12 +401,286 @@ void TableCalSolutionFiller::writeBandpasses(const std::pair<casacore::Cube<casa
 /// @note The code always returns non-negative number.
 long TableCalSolutionFiller::findDefinedCube(const std::string &name) const
 {
-  for (long tempRow = itsRefRow; tempRow >= 0; --tempRow) {
+  const long row = lastDefinedRow(name);
+  if (row < 0) {
+      ASKAPTHROW(AskapError, "Unable to find valid element in column "<<name<<" at row "<<itsRefRow<<" or earlier");
+  }
+  return row;
+}
+
+/// @brief find the last row defining the cube searching backwards
+/// @details This is the non-throwing version of findDefinedCube
+/// @param[in] name column name
+/// @return row number for a defined cube or -1 if the cube is not defined at the reference
+/// row or earlier (or the column doesn't exist)
+long TableCalSolutionFiller::lastDefinedRow(const std::string &name) const
+{
+  // differential updates define the solution as well as full cubes
+  return std::max(lastCellRow(name, itsRefRow), lastCellRow(name + "_DELTA", itsRefRow));
+}
+
+/// @brief find the last row with a defined cell searching backwards
+/// @param[in] name column name
+/// @param[in] row row to start the search from
+/// @return row number for a defined cell or -1 if the cell is not defined at the given 
+/// row or earlier (or the column doesn't exist)
+long TableCalSolutionFiller::lastCellRow(const std::string &name, const long row) const
+{
+  if ((row < 0) || !columnExists(name)) {
+      return -1;
+  }
+  if (itsRowIndex) {
+      return itsRowIndex->lastDefinedRow(name, casacore::uInt(row));
+  }
+  for (long tempRow = row; tempRow >= 0; --tempRow) {
        if (cellDefined<casacore::Complex>(name, casacore::uInt(tempRow))) {
            return tempRow;
        }
   }
-  ASKAPTHROW(AskapError, "Unable to find valid element in column "<<name<<" at row "<<itsRefRow<<" or earlier");
+  return -1;
+}
+
+/// @brief read the solution defined at the given row
+/// @details The full cube is read from the last keyframe at or before the given row and all
+/// differential updates up to the given row are applied.
+/// @param[out] cubes pair of cubes with values and validity flags
+/// @param[in] name column name (e.g. GAIN)
+/// @param[in] row row of interest 
+/// @param[in] slicer optional slice of the cell to read (NULL means the whole cell)
+/// @return false, if there is no keyframe at or before the given row
+bool TableCalSolutionFiller::readState(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                 const std::string &name, const long row, const casacore::Slicer *slicer) const
+{
+  const long keyframeRow = lastCellRow(name, row);
+  if (keyframeRow < 0) {
+      return false;
+  }
+  ASKAPCHECK(cellDefined<casa::Bool>(name + "_VALID", casa::uInt(keyframeRow)), 
+      "Wrong format of the calibration table: "<<name<<" element should always be accompanied by "<<name<<"_VALID");
+  if (slicer == NULL) {
+      readCube(cubes.first, name, casacore::uInt(keyframeRow));
+      readCube(cubes.second, name + "_VALID", casacore::uInt(keyframeRow));
+  } else {
+      readCubeSlice(cubes.first, name, casacore::uInt(keyframeRow), *slicer);
+      readCubeSlice(cubes.second, name + "_VALID", casacore::uInt(keyframeRow), *slicer);
+  }
+  // rows with differential updates after the keyframe, collected backwards
+  const std::string deltaName = name + "_DELTA";
+  std::vector<long> deltaRows;
+  for (long tempRow = lastCellRow(deltaName, row); tempRow > keyframeRow; tempRow = lastCellRow(deltaName, tempRow - 1)) {
+       deltaRows.push_back(tempRow);
+  }
+  // origin of the slice in the full cube, the antenna axis is never sliced
+  const casacore::uInt startRow = slicer == NULL ? 0u : casacore::uInt(slicer->start()[0]);
+  const casacore::Int startBeam = slicer == NULL ? 0 : casacore::Int(slicer->start()[2]);
+  for (std::vector<long>::const_reverse_iterator ci = deltaRows.rbegin(); ci != deltaRows.rend(); ++ci) {
+       casacore::Cube<casacore::Complex> values;
+       casacore::Cube<casacore::Bool> validity;
+       casacore::Cube<casacore::Int> elements;
+       readCube(values, deltaName, casacore::uInt(*ci));
+       readCube(validity, deltaName + "_VALID", casacore::uInt(*ci));
+       readCube(elements, deltaName + "_INDEX", casacore::uInt(*ci));
+       ASKAPCHECK((values.shape() == validity.shape()) && (elements.nrow() == 2) && 
+                  (elements.ncolumn() == values.ncolumn()) && (startRow + cubes.first.nrow() <= values.nrow()),
+                  "Wrong format of the differential update in column "<<deltaName<<" at row "<<*ci);
+       for (casacore::uInt elem = 0; elem < values.ncolumn(); ++elem) {
+            const casacore::Int ant = elements(0, elem, 0);
+            const casacore::Int beam = elements(1, elem, 0) - startBeam;
+            ASKAPCHECK((ant >= 0) && (casacore::uInt(ant) < cubes.first.ncolumn()), "Antenna "<<ant<<
+                       " of the differential update in column "<<deltaName<<" at row "<<*ci<<" is outside the cube");
+            if ((beam < 0) || (casacore::uInt(beam) >= cubes.first.nplane())) {
+                // outside the window which has been read 
+                continue;
+            }
+            for (casacore::uInt cubeRow = 0; cubeRow < cubes.first.nrow(); ++cubeRow) {
+                 cubes.first(cubeRow, ant, beam) = values(startRow + cubeRow, elem, 0);
+                 cubes.second(cubeRow, ant, beam) = validity(startRow + cubeRow, elem, 0);
+            }
+       }
+  }
+  return true;
+}
+
+/// @brief write the solution to the given row
+/// @details Depending on the mode, either the full cube or the differential update is written
+/// (see setDifferential) and the row index is notified.
+/// @param[in] cubes pair of cubes with values and validity flags
+/// @param[in] name column name (e.g. GAIN)
+/// @param[in] row row to write
+void TableCalSolutionFiller::writeState(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                  const std::string &name, const long row) const
+{
+  // a full cube can't be replaced by the differential update
+  if ((itsKeyframeInterval > 0) && (row > 0) && !cellDefined<casacore::Complex>(name, casacore::uInt(row))) {
+      const long keyframeRow = lastCellRow(name, row - 1);
+      std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > previous;
+      if ((keyframeRow >= 0) && (row - keyframeRow < long(itsKeyframeInterval)) && 
+          readState(previous, name, row - 1, NULL) && (previous.first.shape() == cubes.first.shape())) {
+          // (antenna, beam) elements which differ from the previous solution
+          std::vector<std::pair<casacore::uInt, casacore::uInt> > changed;
+          for (casacore::uInt beam = 0; beam < cubes.first.nplane(); ++beam) {
+               for (casacore::uInt ant = 0; ant < cubes.first.ncolumn(); ++ant) {
+                    for (casacore::uInt cubeRow = 0; cubeRow < cubes.first.nrow(); ++cubeRow) {
+                         if ((cubes.first(cubeRow, ant, beam) != previous.first(cubeRow, ant, beam)) ||
+                             (cubes.second(cubeRow, ant, beam) != previous.second(cubeRow, ant, beam))) {
+                             changed.push_back(std::pair<casacore::uInt, casacore::uInt>(ant, beam));
+                             break;
+                         }
+                    }
+               }
+          }
+          const std::string deltaName = name + "_DELTA";
+          const bool deltaDefined = cellDefined<casacore::Complex>(deltaName, casacore::uInt(row));
+          if (changed.size() == 0 && !deltaDefined) {
+              // nothing to write, the row resolves to the previous solution
+              return;
+          }
+          // the differential update is only worth it if it is substantially smaller than the cube
+          if ((changed.size() > 0) && (2 * changed.size() <= cubes.first.ncolumn() * cubes.first.nplane())) {
+              casacore::Cube<casacore::Complex> values(cubes.first.nrow(), changed.size(), 1);
+              casacore::Cube<casacore::Bool> validity(cubes.first.nrow(), changed.size(), 1);
+              casacore::Cube<casacore::Int> elements(2, changed.size(), 1);
+              for (casacore::uInt elem = 0; elem < changed.size(); ++elem) {
+                   const casacore::uInt ant = changed[elem].first;
+                   const casacore::uInt beam = changed[elem].second;
+                   elements(0, elem, 0) = casacore::Int(ant);
+                   elements(1, elem, 0) = casacore::Int(beam);
+                   for (casacore::uInt cubeRow = 0; cubeRow < cubes.first.nrow(); ++cubeRow) {
+                        values(cubeRow, elem, 0) = cubes.first(cubeRow, ant, beam);
+                        validity(cubeRow, elem, 0) = cubes.second(cubeRow, ant, beam);
+                   }
+              }
+              writeCube(values, deltaName, casacore::uInt(row));
+              writeCube(validity, deltaName + "_VALID", casacore::uInt(row));
+              writeCube(elements, deltaName + "_INDEX", casacore::uInt(row));
+              cellWritten(deltaName, row);
+              return;
+          }
+      }
+  }
+  // keyframe, it takes precedence over the differential update at the same row (if any)
+  writeCube(cubes.first, name, casa::uInt(row));
+  writeCube(cubes.second, name + "_VALID", casa::uInt(row));
+  cellWritten(name, row);
+}
+
+/// @brief helper method to notify the index about a write operation
+/// @param[in] name column name
+/// @param[in] row row written
+void TableCalSolutionFiller::cellWritten(const std::string &name, const long row) const
+{
+  // columns could have been created by the write operation
+  itsColumnExistsCache.erase(name);
+  if (itsRowIndex) {
+      ASKAPDEBUGASSERT(row >= 0);
+      itsRowIndex->cellWritten(name, casacore::uInt(row));
+  }
+}
+
+/// @brief determine the rows the solution will be read from
+/// @details This method is intended for the read-only case. It performs the same backward
+/// search as the fill methods, but doesn't throw if nothing is found. The rows found are
+/// remembered, so the search is not repeated when the cubes are read.
+/// @param[out] gainsRow row with gains, -1 if gains are undefined
+/// @param[out] leakagesRow row with leakages, -1 if leakages are undefined
+/// @param[out] bandpassesRow row with bandpasses, -1 if bandpasses are undefined
+void TableCalSolutionFiller::resolveRows(long &gainsRow, long &leakagesRow, long &bandpassesRow) const
+{
+  ASKAPCHECK(isReadOnly(), "TableCalSolutionFiller::resolveRows is only supported for read-only access");
+  if (itsGainsRow < 0) {
+      itsGainsRow = lastDefinedRow("GAIN");
+  }
+  if (itsLeakagesRow < 0) {
+      itsLeakagesRow = lastDefinedRow("LEAKAGE");
+  }
+  if (itsBandpassesRow < 0) {
+      itsBandpassesRow = lastDefinedRow("BANDPASS");
+  }
+  gainsRow = itsGainsRow;
+  leakagesRow = itsLeakagesRow;
+  // the bandpass model, if used, is always at a later row than the bandpass cube
+  bandpassesRow = std::max(itsBandpassesRow, bandpassModelRow());
+}
+
+/// @brief restrict bandpass reading to a window of beams and channels
+/// @details Only the given part of the BANDPASS and BANDPASS_VALID cells is read from
+/// the table, which saves a lot of I/O if the bandpass has many channels and beams,
+/// but just a few of them are processed. The cube filled by fillBandpasses is then
+/// (2*nChan) x nAnt x nBeam with the origin given by bandpassStartChannel and
+/// bandpassStartBeam. This is only supported for read-only access.
+/// @param[in] startBeam first beam to read
+/// @param[in] nBeam number of beams to read, 0 means up to the last beam
+/// @param[in] startChan first channel to read
+/// @param[in] nChan number of channels to read, 0 means up to the last channel
+void TableCalSolutionFiller::setBandpassWindow(const casacore::uInt startBeam, const casacore::uInt nBeam,
+                         const casacore::uInt startChan, const casacore::uInt nChan)
+{
+  ASKAPCHECK(isReadOnly(), "Bandpass window can only be set for read-only access");
+  itsBPStartBeam = startBeam;
+  itsBPNBeam = nBeam;
+  itsBPStartChan = startChan;
+  itsBPNChan = nChan;
+}
+
+/// @brief switch on the differential storage mode
+/// @details In this mode, only the (antenna, beam) elements which differ from the solution
+/// at the previous row are written. They go to the NAME_DELTA, NAME_DELTA_VALID and 
+/// NAME_DELTA_INDEX columns (where NAME is GAIN, LEAKAGE or BANDPASS), the index cube is 
+/// 2 x nChanged x 1 with antenna and beam of each element. A full cube (keyframe) is written 
+/// if there is no previous solution, if the previous keyframe is keyframeInterval rows back
+/// or more, if more than a half of the elements have changed, or if the row already has a full cube.
+/// New solutions start from the values of the previous solution rather than from defaults. 
+/// Differential updates are always applied when solutions are read, so this setting only 
+/// matters for writing.
+/// @param[in] keyframeInterval maximum distance in rows between keyframes, 0 switches the mode off
+void TableCalSolutionFiller::setDifferential(const casacore::uInt keyframeInterval)
+{
+  ASKAPCHECK(!isReadOnly() || (keyframeInterval == 0), "Differential storage mode is only relevant for read-write access");
+  itsKeyframeInterval = keyframeInterval;
+}
+
+/// @brief set the tile shape used if bandpass columns are created
+/// @details The BANDPASS and BANDPASS_VALID columns are bound to the tiled storage
+/// manager with tiles covering a block of channels, antennas and beams, so reading a
+/// beam or a range of channels doesn't require to read the whole cell. Zero means that
+/// the tile covers the whole axis. The shape only matters when a new column is created.
+/// Gains and leakages are small and are always stored one cell per tile.
+/// @param[in] nChan number of channels per tile
+/// @param[in] nAnt number of antennas per tile
+/// @param[in] nBeam number of beams per tile
+void TableCalSolutionFiller::setBandpassTiling(const casacore::uInt nChan, const casacore::uInt nAnt, const casacore::uInt nBeam)
+{
+  itsTileNChan = nChan;
+  itsTileNAnt = nAnt;
+  itsTileNBeam = nBeam;
+}
+
+/// @brief tile shape for a new column
+/// @details Bandpass columns are tiled as set up by setBandpassTiling,
+/// the default tiling is used for other columns.
+/// @param[in] name name of the column
+/// @param[in] cellShape shape of the cube written first
+/// @param[in] elementSize size of one element in bytes
+/// @return shape of the tile (cell shape with the row axis appended)
+casacore::IPosition TableCalSolutionFiller::columnTileShape(const std::string &name, 
+                 const casacore::IPosition &cellShape, size_t elementSize) const
+{
+  if ((name != "BANDPASS") && (name != "BANDPASS_VALID")) {
+      return TableBufferManager::columnTileShape(name, cellShape, elementSize);
+  }
+  ASKAPDEBUGASSERT(cellShape.nelements() == 3);
+  // bandpass cube is (2*nChan) x nAnt x nBeam, the row axis is appended
+  casacore::IPosition shape(4, cellShape[0], cellShape[1], cellShape[2], 1);
+  if ((itsTileNChan > 0) && (2 * ssize_t(itsTileNChan) < shape[0])) {
+      shape[0] = 2 * itsTileNChan;
+  }
+  if ((itsTileNAnt > 0) && (ssize_t(itsTileNAnt) < shape[1])) {
+      shape[1] = itsTileNAnt;
+  }
+  if ((itsTileNBeam > 0) && (ssize_t(itsTileNBeam) < shape[2])) {
+      shape[2] = itsTileNBeam;
+  }
+  return shape;
 }
 
 
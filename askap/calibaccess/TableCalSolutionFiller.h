@@ -44,6 +44,7 @@
 // own includes
 #include <askap/calibaccess/ICalSolutionFiller.h>
 #include <askap/dataaccess/TableBufferManager.h>
+#include <askap/calibaccess/TableCalSolutionRowIndex.h>
 
 // std includes
 #include <string>
@@ -63,6 +64,13 @@ namespace accessors {
 /// a given row, they are read. Otherwise, a backward search is performed to find
 /// the first defined value. An exception is thrown if the top of the table is reached.
 /// If a new entry needs to be created, the given numbers of antennas and beams are used.
+/// If a row index is given, the backward search is replaced by a look up and the index
+/// is notified about all cells written. Optionally, solutions can be stored as differential
+/// updates against the previous solution (see setDifferential). Such updates are always
+/// applied on top of the last full cube (keyframe) when the solution is read. Bandpasses
+/// can also be stored in the parametric form (see ParametricBandpass) in the BANDPASS_MODEL,
+/// BANDPASS_MODEL_VALID and BANDPASS_MODEL_SHAPE columns. The model is used if it is defined
+/// at a later row than the bandpass cube, the cube takes precedence if both are at the same row.
 /// @ingroup calibaccess
 class TableCalSolutionFiller : virtual protected TableBufferManager,
                                virtual public ICalSolutionFiller {
@@ -71,7 +79,9 @@ public:
   /// @details read-only operation is assumed
   /// @param[in] tab  table to use
   /// @param[in] row reference row
-  TableCalSolutionFiller(const casacore::Table& tab, const long row);
+  /// @param[in] index optional shared index of rows defining the cubes
+  TableCalSolutionFiller(const casacore::Table& tab, const long row, 
+         const TableCalSolutionRowIndex::ShPtr &index = TableCalSolutionRowIndex::ShPtr());
 
   /// @brief construct the object and link it to the given table
   /// @details Maximum allowed numbers of antennas, beams and spectral channels are
@@ -82,8 +92,10 @@ public:
   /// @param[in] nAnt maximum number of antennas
   /// @param[in] nBeam maximum number of beams
   /// @param[in] nChan maximum number of channels
+  /// @param[in] index optional shared index of rows defining the cubes
   TableCalSolutionFiller(const casacore::Table& tab, const long row, const casacore::uInt nAnt,
-         const casacore::uInt nBeam, const casacore::uInt nChan);
+         const casacore::uInt nBeam, const casacore::uInt nChan,
+         const TableCalSolutionRowIndex::ShPtr &index = TableCalSolutionRowIndex::ShPtr());
 
   /// @brief gains filler
   /// @details
@@ -115,6 +127,16 @@ public:
   /// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
   virtual void writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
 
+  /// @brief bandpass model filler
+  /// @details The model is reset if the bandpass is given by the cubes
+  /// @param[in] model shared pointer to the model to set up
+  virtual void fillBandpassModel(boost::shared_ptr<ParametricBandpass> &model) const;
+
+  /// @brief bandpass model writer
+  /// @details The model is always written as a whole, differential updates are not supported
+  /// @param[in] model parametric bandpass to write
+  virtual void writeBandpassModel(const ParametricBandpass &model) const;
+
   /// @brief check for gain solution
   /// @return true, if there is no gain solution, false otherwise
   virtual bool noGain() const;
@@ -130,8 +152,127 @@ public:
   /// @brief flush the table to disk
   virtual bool flush() { table().flush(); return true; }
 
+  /// @brief determine the rows the solution will be read from
+  /// @details This method is intended for the read-only case. It performs the same backward
+  /// search as the fill methods, but doesn't throw if nothing is found. The rows found are
+  /// remembered, so the search is not repeated when the cubes are read.
+  /// @param[out] gainsRow row with gains, -1 if gains are undefined
+  /// @param[out] leakagesRow row with leakages, -1 if leakages are undefined
+  /// @param[out] bandpassesRow row with bandpasses or the bandpass model, -1 if bandpasses are undefined
+  void resolveRows(long &gainsRow, long &leakagesRow, long &bandpassesRow) const;
+
+  /// @brief restrict bandpass reading to a window of beams and channels
+  /// @details Only the given part of the BANDPASS and BANDPASS_VALID cells is read from
+  /// the table, which saves a lot of I/O if the bandpass has many channels and beams,
+  /// but just a few of them are processed. The cube filled by fillBandpasses is then
+  /// (2*nChan) x nAnt x nBeam with the origin given by bandpassStartChannel and
+  /// bandpassStartBeam. This is only supported for read-only access.
+  /// @param[in] startBeam first beam to read
+  /// @param[in] nBeam number of beams to read, 0 means up to the last beam
+  /// @param[in] startChan first channel to read
+  /// @param[in] nChan number of channels to read, 0 means up to the last channel
+  void setBandpassWindow(const casacore::uInt startBeam, const casacore::uInt nBeam,
+                         const casacore::uInt startChan, const casacore::uInt nChan);
+
+  /// @brief set the tile shape used if bandpass columns are created
+  /// @details The BANDPASS and BANDPASS_VALID columns are bound to the tiled storage
+  /// manager with tiles covering a block of channels, antennas and beams, so reading a
+  /// beam or a range of channels doesn't require to read the whole cell. Zero means that
+  /// the tile covers the whole axis. The shape only matters when a new column is created.
+  /// Gains and leakages are small and are always stored one cell per tile.
+  /// @param[in] nChan number of channels per tile
+  /// @param[in] nAnt number of antennas per tile
+  /// @param[in] nBeam number of beams per tile
+  void setBandpassTiling(const casacore::uInt nChan, const casacore::uInt nAnt, const casacore::uInt nBeam);
+
+  /// @brief default number of channels per bandpass tile
+  static const casacore::uInt theirDefaultTileChannels = 1024;
+
+  /// @brief default number of antennas per bandpass tile (0 means all)
+  static const casacore::uInt theirDefaultTileAntennas = 0;
+
+  /// @brief default number of beams per bandpass tile (0 means all)
+  static const casacore::uInt theirDefaultTileBeams = 1;
+
+  /// @brief switch on the differential storage mode
+  /// @details In this mode, only the (antenna, beam) elements which differ from the solution
+  /// at the previous row are written. They go to the NAME_DELTA, NAME_DELTA_VALID and 
+  /// NAME_DELTA_INDEX columns (where NAME is GAIN, LEAKAGE or BANDPASS), the index cube is 
+  /// 2 x nChanged x 1 with antenna and beam of each element. A full cube (keyframe) is written 
+  /// if there is no previous solution, if the previous keyframe is keyframeInterval rows back
+  /// or more, if more than a half of the elements have changed, or if the row already has a full cube.
+  /// New solutions start from the values of the previous solution rather than from defaults. 
+  /// Differential updates are always applied when solutions are read, so this setting only 
+  /// matters for writing.
+  /// @param[in] keyframeInterval maximum distance in rows between keyframes, 0 switches the mode off
+  void setDifferential(const casacore::uInt keyframeInterval);
+
+  /// @brief default distance in rows between keyframes for the differential storage mode
+  static const casacore::uInt theirDefaultKeyframeInterval = 16;
+
+  /// @brief first spectral channel of the bandpass cube
+  /// @return channel corresponding to the rows 0 and 1 of the bandpass cube
+  virtual casacore::uInt bandpassStartChannel() const { return itsBPStartChan; }
+
+  /// @brief first beam of the bandpass cube
+  /// @return beam corresponding to the plane 0 of the bandpass cube
+  virtual casacore::uInt bandpassStartBeam() const { return itsBPStartBeam; }
+
+protected:
+
+  /// @brief tile shape for a new column
+  /// @details Bandpass columns are tiled as set up by setBandpassTiling,
+  /// the default tiling is used for other columns.
+  /// @param[in] name name of the column
+  /// @param[in] cellShape shape of the cube written first
+  /// @param[in] elementSize size of one element in bytes
+  /// @return shape of the tile (cell shape with the row axis appended)
+  virtual casacore::IPosition columnTileShape(const std::string &name, 
+                 const casacore::IPosition &cellShape, size_t elementSize) const;
+
 private:
 
+  /// @brief find the last row defining the cube searching backwards
+  /// @details This is the non-throwing version of findDefinedCube. Rows with differential
+  /// updates define the cube as well as rows with the full cube.
+  /// @param[in] name column name
+  /// @return row number for a defined cube or -1 if the cube is not defined at the reference
+  /// row or earlier (or the column doesn't exist)
+  long lastDefinedRow(const std::string &name) const;
+
+  /// @brief find the row with the bandpass model to use
+  /// @details The model is only used if the bandpass cube is not defined at the same or a later row.
+  /// For read-write access, only the reference row is considered.
+  /// @return row number or -1 if the bandpass cubes should be used
+  long bandpassModelRow() const;
+
+  /// @brief find the last row with a defined cell searching backwards
+  /// @param[in] name column name
+  /// @param[in] row row to start the search from
+  /// @return row number for a defined cell or -1 if the cell is not defined at the given 
+  /// row or earlier (or the column doesn't exist)
+  long lastCellRow(const std::string &name, const long row) const;
+
+  /// @brief read the solution defined at the given row
+  /// @details The full cube is read from the last keyframe at or before the given row and all
+  /// differential updates up to the given row are applied.
+  /// @param[out] cubes pair of cubes with values and validity flags
+  /// @param[in] name column name (e.g. GAIN)
+  /// @param[in] row row of interest 
+  /// @param[in] slicer optional slice of the cell to read (NULL means the whole cell)
+  /// @return false, if there is no keyframe at or before the given row
+  bool readState(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                 const std::string &name, const long row, const casacore::Slicer *slicer) const;
+
+  /// @brief write the solution to the given row
+  /// @details Depending on the mode, either the full cube or the differential update is written
+  /// (see setDifferential) and the row index is notified.
+  /// @param[in] cubes pair of cubes with values and validity flags
+  /// @param[in] name column name (e.g. GAIN)
+  /// @param[in] row row to write
+  void writeState(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                  const std::string &name, const long row) const;
+
   /// @brief find first defined cube searching backwards
   /// @details This assumes that the table rows are given in the time order. If the cell at the reference row
   /// doesn't have a cube defined, the search is continued up to the top of the table. An exception is thrown
@@ -152,6 +293,11 @@ private:
   /// @return true if the given column exists
   bool columnExists(const std::string &name) const;
 
+  /// @brief helper method to notify the index about a write operation
+  /// @param[in] name column name
+  /// @param[in] row row written
+  void cellWritten(const std::string &name, const long row) const;
+
   /// @brief number of antennas (used when new solutions are created)
   casacore::uInt itsNAnt;
   /// @brief number of beams (used when new solutions are created)
@@ -176,6 +322,35 @@ private:
   /// for columnExists() is quite expensive
   mutable std::map<std::string, bool> itsColumnExistsCache;
 
+  /// @brief index of rows defining the cubes (may be empty)
+  TableCalSolutionRowIndex::ShPtr itsRowIndex;
+
+  // window of the bandpass to read (all zeros mean the whole cell)
+
+  /// @brief first beam of the bandpass window
+  casacore::uInt itsBPStartBeam;
+
+  /// @brief number of beams in the bandpass window (0 means up to the last beam)
+  casacore::uInt itsBPNBeam;
+
+  /// @brief first channel of the bandpass window
+  casacore::uInt itsBPStartChan;
+
+  /// @brief number of channels in the bandpass window (0 means up to the last channel)
+  casacore::uInt itsBPNChan;
+
+  /// @brief number of channels per bandpass tile (0 means all)
+  casacore::uInt itsTileNChan;
+
+  /// @brief number of antennas per bandpass tile (0 means all)
+  casacore::uInt itsTileNAnt;
+
+  /// @brief number of beams per bandpass tile (0 means all)
+  casacore::uInt itsTileNBeam;
+
+  /// @brief maximum distance in rows between keyframes (0 means differential mode is off)
+  casacore::uInt itsKeyframeInterval;
+
 }; // class TableCalSolutionFiller
 
 } // accessors
@@ -0,0 +1,107 @@
+/// @file
+/// @brief index of rows defining calibration cubes
+/// @details Rows of the calibration table may leave some of the GAIN, LEAKAGE and
+/// BANDPASS cells undefined, which means that the most recent earlier definition
+/// is valid. This class keeps, for each cube type, the last row defining the cube
+/// at or before every row, so the backward search becomes a simple look up.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/calibaccess/TableCalSolutionRowIndex.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the index for the given table
+/// @param[in] tab calibration table
+TableCalSolutionRowIndex::TableCalSolutionRowIndex(const casacore::Table &tab) : itsTable(tab) {}
+
+/// @brief bring the index for the given column in sync with the table
+/// @param[in] name column name
+/// @return false if the column doesn't exist (the index is not created in this case)
+bool TableCalSolutionRowIndex::update(const std::string &name) const
+{
+  if (!itsTable.actualTableDesc().isColumn(name)) {
+      return false;
+  }
+  std::vector<long> &index = itsIndex[name];
+  const size_t nRow = itsTable.nrow();
+  if (nRow < index.size()) {
+      // the table has shrunk, start from scratch
+      index.clear();
+  }
+  if (index.size() < nRow) {
+      // a single column object for all new rows
+      casacore::ROArrayColumn<casacore::Complex> col(itsTable, name);
+      const size_t nIndexed = index.size();
+      index.resize(nRow);
+      for (size_t row = nIndexed; row < nRow; ++row) {
+           index[row] = col.isDefined(row) ? long(row) : (row > 0 ? index[row - 1] : -1);
+      }
+  }
+  return true;
+}
+
+/// @brief obtain the last row defining the cube at or before the given row
+/// @param[in] name column name (e.g. GAIN)
+/// @param[in] row reference row
+/// @return row number or -1 if the cube is not defined at the reference row or earlier
+long TableCalSolutionRowIndex::lastDefinedRow(const std::string &name, const casacore::uInt row) const
+{
+  if (!update(name)) {
+      return -1;
+  }
+  const std::vector<long> &index = itsIndex[name];
+  if (index.size() == 0) {
+      return -1;
+  }
+  // rows past the end of the table are not defined
+  return row < index.size() ? index[row] : index.back();
+}
+
+/// @brief notify the index that a cell has been written
+/// @param[in] name column name (e.g. GAIN)
+/// @param[in] row row which now has the cube defined
+void TableCalSolutionRowIndex::cellWritten(const std::string &name, const casacore::uInt row)
+{
+  const bool exists = update(name);
+  ASKAPCHECK(exists, "Column "<<name<<" is expected to exist after a write operation");
+  std::vector<long> &index = itsIndex[name];
+  ASKAPCHECK(row < index.size(), "Row "<<row<<" reported in TableCalSolutionRowIndex::cellWritten is outside the table");
+  // all following rows resolving to an earlier definition now resolve to this row
+  for (size_t tempRow = row; (tempRow < index.size()) && (index[tempRow] <= long(row)); ++tempRow) {
+       index[tempRow] = long(row);
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
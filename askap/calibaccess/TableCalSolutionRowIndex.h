@@ -0,0 +1,97 @@
+/// @file
+/// @brief index of rows defining calibration cubes
+/// @details Rows of the calibration table may leave some of the GAIN, LEAKAGE and
+/// BANDPASS cells undefined, which means that the most recent earlier definition
+/// is valid. This class keeps, for each cube type, the last row defining the cube
+/// at or before every row, so the backward search becomes a simple look up.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_TABLE_CAL_SOLUTION_ROW_INDEX_H
+#define ASKAP_ACCESSORS_TABLE_CAL_SOLUTION_ROW_INDEX_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// std includes
+#include <map>
+#include <string>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief index of rows defining calibration cubes
+/// @details The index for a given column is built on the first request and extended
+/// when the table grows (only new rows are examined). The cells written via 
+/// TableCalSolutionFiller are reported to the index, so it stays consistent with the
+/// table as long as all writes are done through the same index. The index is shared
+/// between the fillers created by the same solution source.
+/// @ingroup calibaccess
+class TableCalSolutionRowIndex : private boost::noncopyable {
+public:
+  /// @brief construct the index for the given table
+  /// @param[in] tab calibration table
+  explicit TableCalSolutionRowIndex(const casacore::Table &tab);
+
+  /// @brief obtain the last row defining the cube at or before the given row
+  /// @param[in] name column name (e.g. GAIN)
+  /// @param[in] row reference row
+  /// @return row number or -1 if the cube is not defined at the reference row or earlier
+  long lastDefinedRow(const std::string &name, const casacore::uInt row) const;
+
+  /// @brief notify the index that a cell has been written
+  /// @param[in] name column name (e.g. GAIN)
+  /// @param[in] row row which now has the cube defined
+  void cellWritten(const std::string &name, const casacore::uInt row);
+
+  /// @brief shared pointer definition
+  typedef boost::shared_ptr<TableCalSolutionRowIndex> ShPtr;
+
+protected:
+  /// @brief bring the index for the given column in sync with the table
+  /// @param[in] name column name
+  /// @return false if the column doesn't exist (the index is not created in this case)
+  bool update(const std::string &name) const;
+
+private:
+  /// @brief calibration table
+  casacore::Table itsTable;
+
+  /// @brief last defined row at or before every row (-1 if none) for each column
+  mutable std::map<std::string, std::vector<long> > itsIndex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_CAL_SOLUTION_ROW_INDEX_H
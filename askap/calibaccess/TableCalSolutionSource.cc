@@ -34,6 +34,8 @@
 #include <askap/calibaccess/TableCalSolutionSource.h>
 #include <askap/calibaccess/TableCalSolutionFiller.h>
 #include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/calibaccess/DeferredCalSolutionFiller.h>
+#include <askap/dataaccess/TableLocking.h>
 
 // casa includes
 #include <casacore/measures/TableMeasures/TableMeasDesc.h>
@@ -51,7 +53,14 @@
 #include <casacore/casa/OS/Directory.h>
 #include <casacore/casa/OS/File.h>
 
+// logging stuff
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, ".calibaccess");
 
+// std includes
+#include <algorithm>
+#include <exception>
 
 namespace askap {
 
@@ -65,7 +74,14 @@ namespace accessors {
 /// @param[in] nChan maximum number of channels   
 TableCalSolutionSource::TableCalSolutionSource(const casacore::Table &tab, const casacore::uInt nAnt, 
          const casacore::uInt nBeam, const casacore::uInt nChan) : TableHolder(tab), 
-   TableCalSolutionConstSource(tab), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan) {}
+   TableCalSolutionConstSource(tab), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan),
+   itsTileNChan(TableCalSolutionFiller::theirDefaultTileChannels),
+   itsTileNAnt(TableCalSolutionFiller::theirDefaultTileAntennas),
+   itsTileNBeam(TableCalSolutionFiller::theirDefaultTileBeams), itsKeyframeInterval(0)
+{
+  // read-only accessors would not see the updates done via rwSolution
+  setCacheLimit(0);
+}
  
 /// @brief constructor using a file name
 /// @details The table is opened for writing
@@ -73,18 +89,26 @@ TableCalSolutionSource::TableCalSolutionSource(const casacore::Table &tab, const
 /// @param[in] nAnt maximum number of antennas
 /// @param[in] nBeam maximum number of beams   
 /// @param[in] nChan maximum number of channels   
+/// @param[in] lock table locking options, e.g. UserLocking to hold the write lock
+/// for the lifetime of this object (see TableLocking)
 TableCalSolutionSource::TableCalSolutionSource(const std::string &name, const casacore::uInt nAnt, 
-         const casacore::uInt nBeam, const casacore::uInt nChan) : 
-   TableHolder(casacore::Table()), TableCalSolutionConstSource(table()), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan)
+         const casacore::uInt nBeam, const casacore::uInt nChan, const casacore::TableLock &lock) : 
+   TableHolder(casacore::Table()), TableCalSolutionConstSource(table()), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan),
+   itsTileNChan(TableCalSolutionFiller::theirDefaultTileChannels),
+   itsTileNAnt(TableCalSolutionFiller::theirDefaultTileAntennas),
+   itsTileNBeam(TableCalSolutionFiller::theirDefaultTileBeams), itsKeyframeInterval(0)
 {
+  // read-only accessors would not see the updates done via rwSolution
+  setCacheLimit(0);
   try {
-     table() = casacore::Table(name,casacore::Table::Update);
+     table() = TableLocking::open(name, lock, casacore::Table::Update);
   }
   catch (...) {
      // we couldn't just opened an existing table
      try {
         casacore::SetupNewTable maker(name, casacore::TableDesc(), casacore::Table::New);
-        table() = casacore::Table(maker);
+        table() = casacore::Table(maker, lock);
+        TableLocking::lockIfRequired(table(), lock, true);
      }
      catch (const casacore::TableError &te) {
         ASKAPTHROW(DataAccessError,"Unable create a new table for calibration solutions with the name="<<name<<
@@ -95,6 +119,33 @@ TableCalSolutionSource::TableCalSolutionSource(const std::string &name, const ca
 
 
 
+/// @brief set the tile shape used if bandpass columns are created
+/// @details Bandpass columns are tiled in blocks of channels, antennas and beams, so
+/// a beam or a range of channels can be read without reading the whole cell
+/// (see TableCalSolutionFiller::setBandpassTiling). Zero means that the tile covers
+/// the whole axis. This only has effect if the columns haven't been created yet.
+/// @param[in] nChan number of channels per tile
+/// @param[in] nAnt number of antennas per tile
+/// @param[in] nBeam number of beams per tile
+void TableCalSolutionSource::setBandpassTiling(const casacore::uInt nChan, const casacore::uInt nAnt, 
+                                               const casacore::uInt nBeam)
+{
+  itsTileNChan = nChan;
+  itsTileNAnt = nAnt;
+  itsTileNBeam = nBeam;
+}
+
+/// @brief switch the differential storage mode on or off
+/// @details In this mode only the (antenna, beam) elements which changed since the previous
+/// solution are written, with a full cube (keyframe) stored at least every keyframeInterval rows
+/// (see TableCalSolutionFiller::setDifferential). New solutions start from the values of the 
+/// previous solution. Reading doesn't depend on this setting.
+/// @param[in] keyframeInterval maximum distance in rows between keyframes, 0 switches the mode off
+void TableCalSolutionSource::setDifferential(const casacore::uInt keyframeInterval)
+{
+  itsKeyframeInterval = keyframeInterval;
+}
+
 /// @brief obtain a solution ID to store new solution
 /// @details This method provides a solution ID for a new solution. It must
 /// be called before any write operation (one needs a writable accessor to
@@ -102,6 +153,7 @@ TableCalSolutionSource::TableCalSolutionSource(const std::string &name, const ca
 /// @param[in] time time stamp of the new solution in seconds since MJD of 0.
 /// @return solution ID
 long TableCalSolutionSource::newSolutionID(const double time) {
+   waitForWriter();
    if (!table().actualTableDesc().isColumn("TIME")) {
        // this is a new table, we need to create new TIME column
        casacore::ScalarColumnDesc<casacore::Double> timeColDesc("TIME", 
@@ -130,15 +182,121 @@ long TableCalSolutionSource::newSolutionID(const double time) {
 /// @param[in] id solution ID to access
 /// @return shared pointer to an accessor object
 boost::shared_ptr<ICalSolutionAccessor> TableCalSolutionSource::rwSolution(const long id) const {
+   waitForWriter();
    ASKAPCHECK((id >= 0) && (long(table().nrow()) > id), "Requested solution id="<<id<<" is not in the table");
    boost::shared_ptr<TableCalSolutionFiller> filler(new TableCalSolutionFiller(table(),id,itsNAnt, 
-          itsNBeam, itsNChan));
+          itsNBeam, itsNChan, rowIndex()));
    ASKAPDEBUGASSERT(filler);
+   filler->setBandpassTiling(itsTileNChan, itsTileNAnt, itsTileNBeam);
+   filler->setDifferential(itsKeyframeInterval);
+   if (itsWriter) {
+       const boost::shared_ptr<ICalSolutionFiller> deferred(new DeferredCalSolutionFiller(filler, itsWriter, id));
+       return boost::shared_ptr<MemCalSolutionAccessor>(new MemCalSolutionAccessor(deferred,false));
+   }
    boost::shared_ptr<MemCalSolutionAccessor> acc(new MemCalSolutionAccessor(filler,false));
    ASKAPDEBUGASSERT(acc);
    return acc;  
 }
 
+/// @brief obtain ID for the most recent solution
+/// @return ID for the most recent solution
+long TableCalSolutionSource::mostRecentSolution() const
+{
+  waitForWriter();
+  return TableCalSolutionConstSource::mostRecentSolution();
+}
+
+/// @brief obtain solution ID for a given time
+/// @details This method looks for a solution valid at the given time
+/// and returns its ID. It is equivalent to mostRecentSolution() if
+/// called with a time sufficiently into the future.
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long TableCalSolutionSource::solutionID(const double time) const
+{
+  waitForWriter();
+  return TableCalSolutionConstSource::solutionID(time);
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @details All queued solutions are written first, so the accessor sees all updates
+/// done so far.
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> TableCalSolutionSource::roSolution(const long id) const
+{
+  if (itsWriter) {
+      itsWriter->sync();
+  }
+  return TableCalSolutionConstSource::roSolution(id);
+}
+
+/// @brief filler to be used by the read-only accessor
+/// @details In the write-behind mode the filler is decorated to wait for the background writer
+/// @param[in] filler table-based filler set up for the given solution
+/// @param[in] id solution ID
+/// @return filler to be used by the accessor
+boost::shared_ptr<ICalSolutionFiller> TableCalSolutionSource::wrapFiller(
+        const boost::shared_ptr<TableCalSolutionFiller> &filler, const long id) const
+{
+  if (itsWriter) {
+      return boost::shared_ptr<ICalSolutionFiller>(new DeferredCalSolutionFiller(filler, itsWriter, id));
+  }
+  return filler;
+}
+
+/// @brief switch the write-behind mode on or off
+/// @details In the write-behind mode, solutions are written by a background thread when
+/// the caches of writeable accessors are synchronised (i.e. when the accessor is destroyed),
+/// so the caller is not blocked by the table I/O. Repeated updates of the same solution are 
+/// coalesced. Each access to the table waits for the previous job to finish. Queued solutions are
+/// written by flush and in the destructor. Note, solutionTime doesn't wait and should not be
+/// used in this mode.
+/// @param[in] on true to switch the write-behind mode on
+void TableCalSolutionSource::setWriteBehind(const bool on)
+{
+  if (on) {
+      if (!itsWriter) {
+          itsWriter.reset(new TableCalSolutionWriter);
+      }
+  } else if (itsWriter) {
+      itsWriter->sync();
+      // accessors created in the write-behind mode keep the writer
+      itsWriter.reset();
+  }
+}
+
+/// @brief write all queued solutions to disk
+/// @details This is the barrier for the write-behind mode. An exception is thrown if any 
+/// deferred write has failed.
+void TableCalSolutionSource::flush()
+{
+  if (itsWriter) {
+      itsWriter->sync();
+  }
+  table().flush();
+}
+
+/// @brief wait for the background writer, if any
+void TableCalSolutionSource::waitForWriter() const
+{
+  if (itsWriter) {
+      itsWriter->wait();
+  }
+}
+
+/// @brief destructor, writes all queued solutions
+/// @details Errors are logged, rather than thrown
+TableCalSolutionSource::~TableCalSolutionSource()
+{
+  try {
+     flush();
+  }
+  catch (const std::exception &ex) {
+     ASKAPLOG_ERROR_STR(logger, "Unable to write calibration solutions: "<<ex.what());
+  }
+}
+
 /// @brief helper method to remove an old table
 /// @details It just deletes the given table, which allows to create a new one
 /// from scratch (this functionality is used if one needs to overwrite the previous
@@ -171,6 +329,104 @@ void TableCalSolutionSource::removeOldTable(const std::string &fname, const bool
   }
 }
 
+/// @brief rewrite a calibration table in the compacted form
+/// @details Tables written by long jobs often have rows where only some of gains, leakages and
+/// bandpasses are defined, so reading a solution requires a search back through the table and
+/// differential updates may need to be applied. This method copies all solutions of the input 
+/// table into a new table, where every row has all products defined (as soon as they are
+/// defined in the input table). The bandpass tiling is set up by setBandpassTiling. If
+/// keyframeInterval is positive, solutions are stored in the differential form (see setDifferential),
+/// otherwise each row holds full cubes. Bandpasses given in the parametric form are copied as models.
+/// Any existing table with the output name is removed.
+/// @param[in] inName input table
+/// @param[in] outName output table
+/// @param[in] keyframeInterval maximum distance in rows between keyframes, 0 means full cubes in every row
+/// @param[in] tileNChan number of channels per bandpass tile (0 means all)
+/// @param[in] tileNAnt number of antennas per bandpass tile (0 means all)
+/// @param[in] tileNBeam number of beams per bandpass tile (0 means all)
+/// @return number of solutions copied
+long TableCalSolutionSource::compact(const std::string &inName, const std::string &outName, 
+                      const casacore::uInt keyframeInterval, const casacore::uInt tileNChan,
+                      const casacore::uInt tileNAnt, const casacore::uInt tileNBeam)
+{
+  ASKAPCHECK(inName != outName, "Calibration table "<<inName<<" can't be compacted in place");
+  const casacore::Table inTable(inName);
+  const TableCalSolutionConstSource src(inTable);
+  // one index for all rows, so the backward search is only done once per column
+  const TableCalSolutionRowIndex::ShPtr inIndex(new TableCalSolutionRowIndex(inTable));
+  const long nSolutions = long(inTable.nrow());
+  removeOldTable(outName);
+  // dimensions only matter if products are created with default values, which doesn't happen here
+  TableCalSolutionSource dest(outName, 1u, 1u, 1u);
+  dest.setBandpassTiling(tileNChan, tileNAnt, tileNBeam);
+  size_t nCubes = 0;
+  for (long id = 0; id < nSolutions; ++id) {
+       const TableCalSolutionFiller in(inTable, id, inIndex);
+       long gainsRow = -1;
+       long leakagesRow = -1;
+       long bandpassesRow = -1;
+       in.resolveRows(gainsRow, leakagesRow, bandpassesRow);
+       std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > gains;
+       std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > leakages;
+       std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > bandpasses;
+       boost::shared_ptr<ParametricBandpass> model;
+       // numbers of antennas, beams and channels are taken from whatever is defined
+       casacore::uInt nAnt = 0;
+       casacore::uInt nBeam = 0;
+       casacore::uInt nChan = 1;
+       if (gainsRow >= 0) {
+           in.fillGains(gains);
+           nAnt = gains.first.ncolumn();
+           nBeam = gains.first.nplane();
+       }
+       if (leakagesRow >= 0) {
+           in.fillLeakages(leakages);
+           nAnt = std::max(nAnt, casacore::uInt(leakages.first.ncolumn()));
+           nBeam = std::max(nBeam, casacore::uInt(leakages.first.nplane()));
+       }
+       if (bandpassesRow >= 0) {
+           in.fillBandpassModel(model);
+           if (model) {
+               nAnt = std::max(nAnt, model->nAnt());
+               nBeam = std::max(nBeam, model->nBeam());
+               nChan = model->nChan();
+           } else {
+               in.fillBandpasses(bandpasses);
+               nAnt = std::max(nAnt, casacore::uInt(bandpasses.first.ncolumn()));
+               nBeam = std::max(nBeam, casacore::uInt(bandpasses.first.nplane()));
+               nChan = casacore::uInt(bandpasses.first.nrow() / 2);
+           }
+       }
+       const long newID = dest.newSolutionID(src.solutionTime(id));
+       ASKAPDEBUGASSERT(newID == id);
+       if (nAnt == 0) {
+           // nothing is defined yet, the row only has the time stamp
+           continue;
+       }
+       TableCalSolutionFiller out(dest.table(), newID, nAnt, nBeam, nChan, dest.rowIndex());
+       out.setBandpassTiling(tileNChan, tileNAnt, tileNBeam);
+       out.setDifferential(keyframeInterval);
+       if (gainsRow >= 0) {
+           out.writeGains(gains);
+           ++nCubes;
+       }
+       if (leakagesRow >= 0) {
+           out.writeLeakages(leakages);
+           ++nCubes;
+       }
+       if (model) {
+           out.writeBandpassModel(*model);
+           ++nCubes;
+       } else if (bandpassesRow >= 0) {
+           out.writeBandpasses(bandpasses);
+           ++nCubes;
+       }
+  }
+  dest.flush();
+  ASKAPLOG_INFO_STR(logger, "Compacted "<<nSolutions<<" calibration solutions from "<<inName<<" into "<<outName<<
+                    ", "<<nCubes<<" cubes written");
+  return nSolutions;
+}
 
 } // namespace accessors
 
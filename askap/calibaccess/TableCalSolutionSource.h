@@ -36,6 +36,8 @@
 // own includes
 #include <askap/calibaccess/ICalSolutionSource.h>
 #include <askap/calibaccess/TableCalSolutionConstSource.h>
+#include <askap/calibaccess/TableCalSolutionWriter.h>
+#include <askap/calibaccess/TableCalSolutionFiller.h>
 #include <askap/dataaccess/TableHolder.h>
 
 namespace askap {
@@ -47,7 +49,9 @@ namespace accessors {
 /// Main functionality is implemented in the corresponding TableCalSolutionFiller class.
 /// This class creates an instance of the MemCalSolutionAccessor with the above mentioned filler 
 /// when a writeable accessor is requested. Read-only functionality is implemented in the 
-/// base class.
+/// base class. The cache of read-only accessors is switched off by default, as cached
+/// accessors would not see updates done via writeable accessors. Optionally, writes can be 
+/// done in a background thread (see setWriteBehind).
 /// @ingroup calibaccess
 class TableCalSolutionSource : public TableCalSolutionConstSource,
                                virtual public ICalSolutionSource,
@@ -69,9 +73,16 @@ public:
   /// @param[in] nAnt maximum number of antennas
   /// @param[in] nBeam maximum number of beams   
   /// @param[in] nChan maximum number of channels     
+  /// @param[in] lock table locking options, e.g. UserLocking to hold the write lock
+  /// for the lifetime of this object (see TableLocking)
   TableCalSolutionSource(const std::string &name, const casacore::uInt nAnt, 
-         const casacore::uInt nBeam, const casacore::uInt nChan);
+         const casacore::uInt nBeam, const casacore::uInt nChan,
+         const casacore::TableLock &lock = casacore::TableLock());
   
+  /// @brief destructor, writes all queued solutions
+  /// @details Errors are logged, rather than thrown
+  virtual ~TableCalSolutionSource();
+
   // remaining virtual methods of the interface
   
   /// @brief obtain a solution ID to store new solution
@@ -90,7 +101,61 @@ public:
   /// @param[in] id solution ID to access
   /// @return shared pointer to an accessor object
   virtual boost::shared_ptr<ICalSolutionAccessor> rwSolution(const long id) const;
+
+  // read-only methods of the interface need to wait for the background writer
+
+  /// @brief obtain ID for the most recent solution
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const;
+
+  /// @brief obtain solution ID for a given time
+  /// @details This method looks for a solution valid at the given time
+  /// and returns its ID. It is equivalent to mostRecentSolution() if
+  /// called with a time sufficiently into the future.
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const;
+
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @details All queued solutions are written first, so the accessor sees all updates
+  /// done so far.
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+  /// @brief switch the write-behind mode on or off
+  /// @details In the write-behind mode, solutions are written by a background thread when
+  /// the caches of writeable accessors are synchronised (i.e. when the accessor is destroyed),
+  /// so the caller is not blocked by the table I/O. Repeated updates of the same solution are 
+  /// coalesced. Each access to the table waits for the previous job to finish. Queued solutions are
+  /// written by flush and in the destructor. Note, solutionTime doesn't wait and should not be
+  /// used in this mode.
+  /// @param[in] on true to switch the write-behind mode on
+  void setWriteBehind(const bool on);
+
+  /// @brief write all queued solutions to disk
+  /// @details This is the barrier for the write-behind mode. An exception is thrown if any 
+  /// deferred write has failed.
+  void flush();
   
+  /// @brief set the tile shape used if bandpass columns are created
+  /// @details Bandpass columns are tiled in blocks of channels, antennas and beams, so
+  /// a beam or a range of channels can be read without reading the whole cell
+  /// (see TableCalSolutionFiller::setBandpassTiling). Zero means that the tile covers
+  /// the whole axis. This only has effect if the columns haven't been created yet.
+  /// @param[in] nChan number of channels per tile
+  /// @param[in] nAnt number of antennas per tile
+  /// @param[in] nBeam number of beams per tile
+  void setBandpassTiling(const casacore::uInt nChan, const casacore::uInt nAnt, const casacore::uInt nBeam);
+
+  /// @brief switch the differential storage mode on or off
+  /// @details In this mode only the (antenna, beam) elements which changed since the previous
+  /// solution are written, with a full cube (keyframe) stored at least every keyframeInterval rows
+  /// (see TableCalSolutionFiller::setDifferential). New solutions start from the values of the 
+  /// previous solution. Reading doesn't depend on this setting.
+  /// @param[in] keyframeInterval maximum distance in rows between keyframes, 0 switches the mode off
+  void setDifferential(const casacore::uInt keyframeInterval);
+
     /// @brief shared pointer definition
   typedef boost::shared_ptr<TableCalSolutionSource> ShPtr;
   
@@ -102,6 +167,40 @@ public:
   /// @param[in] removeIfNotTable if true, the file is removed even if it is not a table.
   /// An exception is thrown in this case if this parameter is false.
   static void removeOldTable(const std::string &fname, const bool removeIfNotTable = true);
+
+  /// @brief rewrite a calibration table in the compacted form
+  /// @details Tables written by long jobs often have rows where only some of gains, leakages and
+  /// bandpasses are defined, so reading a solution requires a search back through the table and
+  /// differential updates may need to be applied. This method copies all solutions of the input 
+  /// table into a new table, where every row has all products defined (as soon as they are
+  /// defined in the input table). The bandpass tiling is set up by setBandpassTiling. If
+  /// keyframeInterval is positive, solutions are stored in the differential form (see setDifferential),
+  /// otherwise each row holds full cubes. Bandpasses given in the parametric form are copied as models.
+  /// Any existing table with the output name is removed.
+  /// @param[in] inName input table
+  /// @param[in] outName output table
+  /// @param[in] keyframeInterval maximum distance in rows between keyframes, 0 means full cubes in every row
+  /// @param[in] tileNChan number of channels per bandpass tile (0 means all)
+  /// @param[in] tileNAnt number of antennas per bandpass tile (0 means all)
+  /// @param[in] tileNBeam number of beams per bandpass tile (0 means all)
+  /// @return number of solutions copied
+  static long compact(const std::string &inName, const std::string &outName, 
+                      const casacore::uInt keyframeInterval = 0,
+                      const casacore::uInt tileNChan = TableCalSolutionFiller::theirDefaultTileChannels,
+                      const casacore::uInt tileNAnt = TableCalSolutionFiller::theirDefaultTileAntennas,
+                      const casacore::uInt tileNBeam = TableCalSolutionFiller::theirDefaultTileBeams);
+
+protected:
+  /// @brief filler to be used by the read-only accessor
+  /// @details In the write-behind mode the filler is decorated to wait for the background writer
+  /// @param[in] filler table-based filler set up for the given solution
+  /// @param[in] id solution ID
+  /// @return filler to be used by the accessor
+  virtual boost::shared_ptr<ICalSolutionFiller> wrapFiller(const boost::shared_ptr<TableCalSolutionFiller> &filler,
+                                                           const long id) const;
+
+  /// @brief wait for the background writer, if any
+  void waitForWriter() const;
   
 private:
   /// @brief number of antennas (used when new solutions are created)
@@ -110,6 +209,16 @@ private:
   casacore::uInt itsNBeam;
   /// @brief number of spectral channels (used when new solutions are created)
   casacore::uInt itsNChan;     
+  /// @brief number of channels per bandpass tile (0 means all)
+  casacore::uInt itsTileNChan;
+  /// @brief number of antennas per bandpass tile (0 means all)
+  casacore::uInt itsTileNAnt;
+  /// @brief number of beams per bandpass tile (0 means all)
+  casacore::uInt itsTileNBeam;
+  /// @brief maximum distance in rows between keyframes (0 means the differential mode is off)
+  casacore::uInt itsKeyframeInterval;
+  /// @brief background writer, empty unless the write-behind mode is on
+  TableCalSolutionWriter::ShPtr itsWriter;
 }; // class TableCalSolutionSource
 
 } // namespace accessors
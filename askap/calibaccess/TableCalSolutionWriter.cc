@@ -0,0 +1,190 @@
+/// @file
+/// @brief write-behind of calibration solutions
+/// @details This class collects gains, leakages and bandpasses written via the
+/// accessors of TableCalSolutionSource and writes them to the table in the background
+/// (as a job of IOScheduler), so the code producing solutions is not blocked by the table
+/// I/O. It is used if the write-behind mode is switched on (see
+/// TableCalSolutionSource::setWriteBehind).
+/// The table system is not thread-safe, therefore the source and its accessors have to
+/// wait for the background job to finish before they touch the table themselves. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+// own includes
+#include <askap/calibaccess/TableCalSolutionWriter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+// std includes
+#include <exception>
+
+ASKAP_LOGGER(logger, ".calibaccess");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+TableCalSolutionWriter::TableCalSolutionWriter() {}
+
+/// @brief destructor, writes all queued updates
+/// @details Errors are logged, rather than thrown
+TableCalSolutionWriter::~TableCalSolutionWriter()
+{
+  try {
+     sync();
+  }
+  catch (const std::exception &ex) {
+     ASKAPLOG_ERROR_STR(logger, "Deferred write of calibration solutions failed: "<<ex.what());
+  }
+}
+
+/// @brief queue an update
+/// @details A queued update of the same product for the same solution is replaced.
+/// @param[in] filler filler to write the cubes with
+/// @param[in] id solution ID
+/// @param[in] product calibration product
+/// @param[in] cubes values and validity flags to write (copied)
+void TableCalSolutionWriter::add(const boost::shared_ptr<ICalSolutionFiller> &filler, const long id, 
+           const Product product, const CubePair &cubes)
+{
+  ASKAPDEBUGASSERT(filler);
+  Update &update = itsQueued[std::make_pair(id, int(product))];
+  update.itsFiller = filler;
+  update.itsProduct = product;
+  // the accessor keeps its cache, so it can be changed while the update is queued
+  update.itsCubes.first = cubes.first.copy();
+  update.itsCubes.second = cubes.second.copy();
+}
+
+/// @brief obtain a queued update
+/// @details This allows to read the data which have not been written yet.
+/// @param[in] id solution ID
+/// @param[in] product calibration product
+/// @return pointer to the queued cubes or NULL, if there is no queued update
+const TableCalSolutionWriter::CubePair* TableCalSolutionWriter::queued(const long id, const Product product) const
+{
+  const UpdateMap::const_iterator ci = itsQueued.find(std::make_pair(id, int(product)));
+  return ci == itsQueued.end() ? NULL : &(ci->second.itsCubes);
+}
+
+/// @brief number of updates waiting to be written
+/// @details Updates being written by the background job are not counted
+/// @return number of queued updates
+size_t TableCalSolutionWriter::nQueued() const
+{
+  return itsQueued.size();
+}
+
+/// @brief start writing queued updates in the background
+/// @details Nothing is done if there is nothing to write or a job is already running.
+void TableCalSolutionWriter::start()
+{
+  if (itsJob.valid() || (nQueued() == 0)) {
+      return;
+  }
+  // the job owns the updates it writes, new updates can be queued in the meantime
+  itsPending.swap(itsQueued);
+  size_t bytes = 0;
+  for (UpdateMap::const_iterator ci = itsPending.begin(); ci != itsPending.end(); ++ci) {
+       bytes += ci->second.itsCubes.first.nelements() * sizeof(casacore::Complex) +
+                ci->second.itsCubes.second.nelements() * sizeof(casacore::Bool);
+  }
+  itsJob = IOScheduler::instance().submit(IOScheduler::NORMAL, boost::bind(&TableCalSolutionWriter::run, this), bytes);
+}
+
+/// @brief wait for the background job to finish
+/// @details It is necessary to call this method before any access to the table
+/// from the main thread. It does nothing if no job is running. An exception is
+/// thrown if the job failed.
+void TableCalSolutionWriter::wait()
+{
+  if (itsJob.valid()) {
+      itsJob.wait();
+      itsJob = IOScheduler::Future();
+  }
+  if (itsError.size()) {
+      const std::string msg = itsError;
+      itsError.clear();
+      ASKAPTHROW(DataAccessError, "Deferred write of calibration solutions failed: "<<msg);
+  }
+}
+
+/// @brief write all queued updates
+/// @details This is the barrier: the table is up to date when the method returns.
+/// An exception is thrown if any write has failed.
+void TableCalSolutionWriter::sync()
+{
+  wait();
+  start();
+  wait();
+}
+
+/// @brief body of the background job
+/// @details Any exception is caught and the message is kept to be reported
+/// by the main thread
+void TableCalSolutionWriter::run()
+{
+  try {
+     for (UpdateMap::const_iterator ci = itsPending.begin(); ci != itsPending.end(); ++ci) {
+          write(ci->second);
+     }
+  }
+  catch (const std::exception &ex) {
+     itsError = ex.what();
+  }
+  itsPending.clear();
+}
+
+/// @brief write given update
+/// @param[in] update update to write
+void TableCalSolutionWriter::write(const Update &update)
+{
+  ASKAPDEBUGASSERT(update.itsFiller);
+  switch (update.itsProduct) {
+     case GAINS:
+          update.itsFiller->writeGains(update.itsCubes);
+          break;
+     case LEAKAGES:
+          update.itsFiller->writeLeakages(update.itsCubes);
+          break;
+     case BANDPASSES:
+          update.itsFiller->writeBandpasses(update.itsCubes);
+          break;
+     default:
+          ASKAPTHROW(AskapError, "Unknown calibration product "<<int(update.itsProduct));
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,168 @@
+/// @file
+/// @brief write-behind of calibration solutions
+/// @details This class collects gains, leakages and bandpasses written via the
+/// accessors of TableCalSolutionSource and writes them to the table in the background
+/// (as a job of IOScheduler), so the code producing solutions is not blocked by the table
+/// I/O. It is used if the write-behind mode is switched on (see
+/// TableCalSolutionSource::setWriteBehind).
+/// The table system is not thread-safe, therefore the source and its accessors have to
+/// wait for the background job to finish before they touch the table themselves. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TABLE_CAL_SOLUTION_WRITER_H
+#define ASKAP_ACCESSORS_TABLE_CAL_SOLUTION_WRITER_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionFiller.h>
+#include <askap/dataaccess/IOScheduler.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// std includes
+#include <map>
+#include <string>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief write-behind of calibration solutions
+/// @details Cubes given to this class are copied, queued and written later via the
+/// filler they came with, either by an explicit sync or by a background job started 
+/// via the start method. The job runs on the threads of the I/O scheduler of the process
+/// in the normal priority class. Updates of the same product of the same solution are coalesced,
+/// i.e. only the most recent cube is written. Errors encountered by the background job
+/// are reported by the next call to wait or sync. All methods are supposed to be called 
+/// from the thread which owns the calibration solution source.
+/// @ingroup calibaccess
+class TableCalSolutionWriter : private boost::noncopyable {
+public:
+  /// @brief type of the cube pair with values and validity flags
+  typedef std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > CubePair;
+
+  /// @brief calibration products
+  enum Product {
+     GAINS = 0,
+     LEAKAGES,
+     BANDPASSES
+  };
+
+  /// @brief shared pointer definition
+  typedef boost::shared_ptr<TableCalSolutionWriter> ShPtr;
+
+  /// @brief constructor
+  TableCalSolutionWriter();
+
+  /// @brief destructor, writes all queued updates
+  /// @details Errors are logged, rather than thrown
+  ~TableCalSolutionWriter();
+
+  /// @brief queue an update
+  /// @details A queued update of the same product for the same solution is replaced.
+  /// @param[in] filler filler to write the cubes with
+  /// @param[in] id solution ID
+  /// @param[in] product calibration product
+  /// @param[in] cubes values and validity flags to write (copied)
+  void add(const boost::shared_ptr<ICalSolutionFiller> &filler, const long id, const Product product,
+           const CubePair &cubes);
+
+  /// @brief obtain a queued update
+  /// @details This allows to read the data which have not been written yet.
+  /// @param[in] id solution ID
+  /// @param[in] product calibration product
+  /// @return pointer to the queued cubes or NULL, if there is no queued update
+  const CubePair* queued(const long id, const Product product) const;
+
+  /// @brief number of updates waiting to be written
+  /// @details Updates being written by the background job are not counted
+  /// @return number of queued updates
+  size_t nQueued() const;
+
+  /// @brief start writing queued updates in the background
+  /// @details Nothing is done if there is nothing to write or a job is already running.
+  void start();
+
+  /// @brief wait for the background job to finish
+  /// @details It is necessary to call this method before any access to the table
+  /// from the main thread. It does nothing if no job is running. An exception is
+  /// thrown if the job failed.
+  void wait();
+
+  /// @brief write all queued updates
+  /// @details This is the barrier: the table is up to date when the method returns.
+  /// An exception is thrown if any write has failed.
+  void sync();
+
+protected:
+  /// @brief one queued update
+  struct Update {
+     /// @brief filler to write the cubes with
+     boost::shared_ptr<ICalSolutionFiller> itsFiller;
+     /// @brief product to write
+     Product itsProduct;
+     /// @brief values and validity flags
+     CubePair itsCubes;
+  };
+
+  /// @brief type of the queue, the key is solution ID and product
+  typedef std::map<std::pair<long, int>, Update> UpdateMap;
+
+  /// @brief body of the background job
+  /// @details Any exception is caught and the message is kept to be reported
+  /// by the main thread
+  void run();
+
+  /// @brief write given update
+  /// @param[in] update update to write
+  static void write(const Update &update);
+
+private:
+  /// @brief queued updates
+  UpdateMap itsQueued;
+
+  /// @brief updates being written by the background job
+  UpdateMap itsPending;
+
+  /// @brief error message of the last failed job, empty if there was no error
+  std::string itsError;
+
+  /// @brief future of the background job, invalid if no job is running
+  IOScheduler::Future itsJob;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_CAL_SOLUTION_WRITER_H
@@ -0,0 +1,346 @@
+/// @file
+/// @brief timeline of data access operations in the Chrome trace format
+/// @details This class collects the start and end times of the main data access
+/// operations (iterator steps, cube fills, buffer reads and writes, calibration solution
+/// and image access) done by all threads of the process and writes them into a JSON file
+/// which can be loaded into chrome://tracing or Perfetto. This allows one to see whether
+/// background reads and writes overlap with the processing. Tracing is switched off by
+/// default, it can be switched on by the ASKAP_ACCESSORS_TRACE environment variable or
+/// via the parset (see configure).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/dataaccess/AccessTracer.h>
+
+// casa includes
+#include <casacore/casa/OS/EnvVar.h>
+
+// boost includes
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// std includes
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+ASKAP_LOGGER(logger, ".dataaccess");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief start the event
+/// @param[in] name name of the operation
+/// @param[in] category category of the operation (e.g. "dataaccess")
+AccessTracer::Scope::Scope(const char *name, const char *category) : itsCategory(category),
+          itsTracing(AccessTracer::instance().isEnabled()),
+          itsCounting(HardwareCounters::instance().isEnabled())
+{
+  if (itsTracing || itsCounting) {
+      itsName = name;
+      start();
+  }
+}
+
+/// @brief start the event with a qualified name
+/// @details The name of the event is the name of the operation followed by the
+/// qualifier (e.g. the column name). The string is only composed if tracing or the
+/// collection of hardware counters is on.
+/// @param[in] name name of the operation
+/// @param[in] qualifier details of the operation added to the name
+/// @param[in] category category of the operation (e.g. "dataaccess")
+AccessTracer::Scope::Scope(const char *name, const std::string &qualifier, const char *category) :
+          itsCategory(category), itsTracing(AccessTracer::instance().isEnabled()),
+          itsCounting(HardwareCounters::instance().isEnabled())
+{
+  if (itsTracing || itsCounting) {
+      itsName = std::string(name) + " " + qualifier;
+      start();
+  }
+}
+
+/// @brief finish the event and pass it to the tracer
+AccessTracer::Scope::~Scope()
+{
+  if (itsCounting) {
+      casacore::uInt64 counts[HardwareCounters::N_COUNTERS];
+      HardwareCounters &counters = HardwareCounters::instance();
+      if (counters.read(counts)) {
+          counters.add(itsName, itsCounts, counts);
+      }
+  }
+  if (itsTracing) {
+      AccessTracer::instance().record(itsName, itsCategory, itsStart,
+                 boost::posix_time::microsec_clock::universal_time());
+  }
+}
+
+/// @brief take the start time and counters
+/// @details The counters are read last, so the time taking is not counted
+void AccessTracer::Scope::start()
+{
+  if (itsTracing) {
+      itsStart = boost::posix_time::microsec_clock::universal_time();
+  }
+  if (itsCounting) {
+      itsCounting = HardwareCounters::instance().read(itsCounts);
+  }
+}
+
+/// @brief construct the tracer
+/// @details Tracing is switched on if requested by the environment
+AccessTracer::AccessTracer() : itsEnabled(false), itsRank(-1), itsWrittenEvents(false), itsNEvents(0)
+{
+  configureFromEnvironment();
+}
+
+/// @brief destructor, writes out the buffered events and closes the file
+AccessTracer::~AccessTracer()
+{
+  try {
+     disable();
+  }
+  catch (...) {
+     // nothing can be done at this stage
+  }
+}
+
+/// @brief the tracer of this process
+/// @details The tracer is created on the first call and configured from the
+/// ASKAP_ACCESSORS_TRACE environment variable (see configureFromEnvironment).
+/// @return reference to the tracer
+AccessTracer& AccessTracer::instance()
+{
+  static AccessTracer tracer;
+  return tracer;
+}
+
+/// @brief switch tracing on
+/// @details The file is opened when the first events are written, so the rank can be set
+/// after this call. Any previously open file is closed first.
+/// @param[in] fileName name of the trace file, %w is replaced by the rank
+void AccessTracer::enable(const std::string &fileName)
+{
+  ASKAPCHECK(fileName != "", "An empty file name is given for the data access trace");
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  flushLocked();
+  closeLocked();
+  itsFileName = fileName;
+  itsNEvents = 0;
+  itsEnabled = true;
+}
+
+/// @brief switch tracing off
+/// @details Buffered events are written and the file is closed
+void AccessTracer::disable()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsEnabled = false;
+  flushLocked();
+  closeLocked();
+}
+
+/// @brief switch tracing on if requested in the parset
+/// @details Nothing is done if the key is not defined or tracing is already on.
+/// @param[in] parset parameters
+/// @param[in] key name of the parameter with the trace file name (%w is replaced by the rank)
+void AccessTracer::configure(const LOFAR::ParameterSet &parset, const std::string &key)
+{
+  if (!isEnabled() && parset.isDefined(key)) {
+      const std::string fileName = parset.getString(key);
+      ASKAPLOG_INFO_STR(logger, "Data access operations will be traced into "<<fileName);
+      enable(fileName);
+  }
+}
+
+/// @brief switch tracing on if requested by the environment
+/// @details The ASKAP_ACCESSORS_TRACE variable gives the file name pattern, %w is replaced
+/// by the rank. The rank is taken from the variables set by the common MPI launchers
+/// (OMPI_COMM_WORLD_RANK, PMI_RANK, PMIX_RANK or SLURM_PROCID) unless set via setRank.
+void AccessTracer::configureFromEnvironment()
+{
+  if (casacore::EnvironmentVariable::isDefined("ASKAP_ACCESSORS_TRACE")) {
+      const std::string fileName = casacore::EnvironmentVariable::get("ASKAP_ACCESSORS_TRACE");
+      if (fileName != "") {
+          enable(fileName);
+      }
+  }
+}
+
+/// @brief set the rank of this process
+/// @details The rank is used as the process id of the events and to form the file name.
+/// It should be set before the first events are written.
+/// @param[in] rank rank of this process
+void AccessTracer::setRank(int rank)
+{
+  ASKAPCHECK(rank >= 0, "Rank should be non-negative, you have "<<rank);
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsRank = rank;
+}
+
+/// @brief rank of this process
+/// @return the rank used for the trace (zero if unknown)
+int AccessTracer::rank() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (itsRank >= 0) {
+      return itsRank;
+  }
+  const int envRank = rankFromEnvironment();
+  return envRank >= 0 ? envRank : 0;
+}
+
+/// @brief record an event
+/// @details This method is thread-safe. Events are ignored if tracing is off.
+/// @param[in] name name of the operation
+/// @param[in] category category of the operation
+/// @param[in] start start time
+/// @param[in] end end time
+void AccessTracer::record(const std::string &name, const char *category,
+              const boost::posix_time::ptime &start, const boost::posix_time::ptime &end)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (!itsEnabled) {
+      return;
+  }
+  const boost::thread::id id = boost::this_thread::get_id();
+  std::map<boost::thread::id, unsigned int>::const_iterator ci = itsThreads.find(id);
+  if (ci == itsThreads.end()) {
+      ci = itsThreads.insert(std::make_pair(id, static_cast<unsigned int>(itsThreads.size()))).first;
+  }
+  Event event;
+  event.itsName = name;
+  event.itsCategory = category;
+  event.itsStart = microseconds(start);
+  event.itsDuration = microseconds(end) - event.itsStart;
+  event.itsThread = ci->second;
+  itsEvents.push_back(event);
+  ++itsNEvents;
+  if (itsEvents.size() >= theirBufferSize) {
+      flushLocked();
+  }
+}
+
+/// @brief write buffered events to the file
+void AccessTracer::flush()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  flushLocked();
+}
+
+/// @brief number of events recorded since tracing has been switched on
+/// @return number of events
+size_t AccessTracer::nEvents() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsNEvents;
+}
+
+/// @brief write buffered events, the mutex should be locked by the caller
+void AccessTracer::flushLocked()
+{
+  if (itsEvents.size() == 0) {
+      return;
+  }
+  const int pid = itsRank >= 0 ? itsRank : std::max(rankFromEnvironment(), 0);
+  if (!itsStream.is_open()) {
+      std::string fileName = itsFileName;
+      std::ostringstream os;
+      os<<pid;
+      for (size_t pos = fileName.find("%w"); pos != std::string::npos;
+           pos = fileName.find("%w", pos + os.str().size())) {
+           fileName.replace(pos, 2, os.str());
+      }
+      itsStream.open(fileName.c_str(), std::ios::out | std::ios::trunc);
+      ASKAPCHECK(itsStream, "Unable to open trace file "<<fileName);
+      // the array form of the trace format, the closing bracket is optional
+      itsStream<<"[\n";
+      itsWrittenEvents = false;
+  }
+  for (std::vector<Event>::const_iterator ci = itsEvents.begin(); ci != itsEvents.end(); ++ci) {
+       if (itsWrittenEvents) {
+           itsStream<<",\n";
+       }
+       itsStream<<"{\"name\":\"";
+       for (std::string::const_iterator chIt = ci->itsName.begin(); chIt != ci->itsName.end(); ++chIt) {
+            if ((*chIt == '"') || (*chIt == '\\')) {
+                itsStream<<'\\';
+            }
+            itsStream<<(static_cast<unsigned char>(*chIt) < 0x20 ? ' ' : *chIt);
+       }
+       itsStream<<"\",\"cat\":\""<<ci->itsCategory<<"\",\"ph\":\"X\",\"ts\":"<<ci->itsStart<<
+                ",\"dur\":"<<ci->itsDuration<<",\"pid\":"<<pid<<",\"tid\":"<<ci->itsThread<<"}";
+       itsWrittenEvents = true;
+  }
+  itsStream.flush();
+  itsEvents.clear();
+}
+
+/// @brief close the file, the mutex should be locked by the caller
+void AccessTracer::closeLocked()
+{
+  if (itsStream.is_open()) {
+      itsStream<<"\n]\n";
+      itsStream.close();
+  }
+  itsEvents.clear();
+  itsWrittenEvents = false;
+}
+
+/// @brief obtain the rank from the environment, if set by the MPI launcher
+/// @return the rank or -1 if not found
+int AccessTracer::rankFromEnvironment()
+{
+  const char* names[] = {"OMPI_COMM_WORLD_RANK", "PMI_RANK", "PMIX_RANK", "SLURM_PROCID"};
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+       if (casacore::EnvironmentVariable::isDefined(names[i])) {
+           const std::string value = casacore::EnvironmentVariable::get(names[i]);
+           if (value != "") {
+               return std::atoi(value.c_str());
+           }
+       }
+  }
+  return -1;
+}
+
+/// @brief convert time into microseconds since the epoch
+/// @param[in] time time to convert
+/// @return microseconds since 1970-01-01
+long long AccessTracer::microseconds(const boost::posix_time::ptime &time)
+{
+  static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+  return static_cast<long long>((time - epoch).total_microseconds());
+}
+
+} // namespace accessors
+
+} // namespace askap
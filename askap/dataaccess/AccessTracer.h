@@ -0,0 +1,244 @@
+/// @file
+/// @brief timeline of data access operations in the Chrome trace format
+/// @details This class collects the start and end times of the main data access
+/// operations (iterator steps, cube fills, buffer reads and writes, calibration solution
+/// and image access) done by all threads of the process and writes them into a JSON file
+/// which can be loaded into chrome://tracing or Perfetto. This allows one to see whether
+/// background reads and writes overlap with the processing. Tracing is switched off by
+/// default, it can be switched on by the ASKAP_ACCESSORS_TRACE environment variable or
+/// via the parset (see configure).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_ACCESS_TRACER_H
+#define ASKAP_ACCESSORS_ACCESS_TRACER_H
+
+// std includes
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/utility.hpp>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+// own includes
+#include <askap/dataaccess/HardwareCounters.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief timeline of data access operations in the Chrome trace format
+/// @details There is one tracer per process (see instance). The operations are
+/// instrumented with Scope objects which cost a single flag check if tracing is
+/// switched off. Events are buffered in memory and appended to the file when the
+/// buffer is full, when flush is called explicitly and at the end of the job.
+/// Each event is a complete ("X") event with the process id set to the rank and the
+/// thread id set to a small number assigned to every thread on its first event.
+/// Time stamps are microseconds since the UNIX epoch, so files written by different
+/// ranks can be loaded together.
+/// @ingroup dataaccess_hlp
+class AccessTracer : private boost::noncopyable
+{
+public:
+  /// @brief helper class tracing a block of code
+  /// @details An event spanning the time between construction and destruction is
+  /// recorded if tracing was switched on at the time of construction. The same block
+  /// is accounted in HardwareCounters if the collection of hardware counters is on.
+  class Scope : private boost::noncopyable {
+  public:
+     /// @brief start the event
+     /// @param[in] name name of the operation
+     /// @param[in] category category of the operation (e.g. "dataaccess")
+     Scope(const char *name, const char *category);
+
+     /// @brief start the event with a qualified name
+     /// @details The name of the event is the name of the operation followed by the
+     /// qualifier (e.g. the column name). The string is only composed if tracing or the
+     /// collection of hardware counters is on.
+     /// @param[in] name name of the operation
+     /// @param[in] qualifier details of the operation added to the name
+     /// @param[in] category category of the operation (e.g. "dataaccess")
+     Scope(const char *name, const std::string &qualifier, const char *category);
+
+     /// @brief finish the event and pass it to the tracer
+     ~Scope();
+  private:
+     /// @brief take the start time and counters
+     /// @details The counters are read last, so the time taking is not counted
+     void start();
+
+     /// @brief name of the operation, empty if both tracing and counting are off
+     std::string itsName;
+     /// @brief category of the operation
+     const char *itsCategory;
+     /// @brief true if the event is recorded in the trace
+     bool itsTracing;
+     /// @brief true if the hardware counters are accounted
+     bool itsCounting;
+     /// @brief start time
+     boost::posix_time::ptime itsStart;
+     /// @brief hardware counters at the start
+     casacore::uInt64 itsCounts[HardwareCounters::N_COUNTERS];
+  };
+
+  /// @brief the tracer of this process
+  /// @details The tracer is created on the first call and configured from the
+  /// ASKAP_ACCESSORS_TRACE environment variable (see configureFromEnvironment).
+  /// @return reference to the tracer
+  static AccessTracer& instance();
+
+  /// @brief destructor, writes out the buffered events and closes the file
+  ~AccessTracer();
+
+  /// @brief check whether tracing is switched on
+  /// @return true, if the events are recorded
+  inline bool isEnabled() const { return itsEnabled; }
+
+  /// @brief switch tracing on
+  /// @details The file is opened when the first events are written, so the rank can be set
+  /// after this call. Any previously open file is closed first.
+  /// @param[in] fileName name of the trace file, %w is replaced by the rank
+  void enable(const std::string &fileName);
+
+  /// @brief switch tracing off
+  /// @details Buffered events are written and the file is closed
+  void disable();
+
+  /// @brief switch tracing on if requested in the parset
+  /// @details Nothing is done if the key is not defined or tracing is already on.
+  /// @param[in] parset parameters
+  /// @param[in] key name of the parameter with the trace file name (%w is replaced by the rank)
+  void configure(const LOFAR::ParameterSet &parset, const std::string &key = "trace");
+
+  /// @brief switch tracing on if requested by the environment
+  /// @details The ASKAP_ACCESSORS_TRACE variable gives the file name pattern, %w is replaced
+  /// by the rank. The rank is taken from the variables set by the common MPI launchers
+  /// (OMPI_COMM_WORLD_RANK, PMI_RANK, PMIX_RANK or SLURM_PROCID) unless set via setRank.
+  void configureFromEnvironment();
+
+  /// @brief set the rank of this process
+  /// @details The rank is used as the process id of the events and to form the file name.
+  /// It should be set before the first events are written.
+  /// @param[in] rank rank of this process
+  void setRank(int rank);
+
+  /// @brief rank of this process
+  /// @return the rank used for the trace (zero if unknown)
+  int rank() const;
+
+  /// @brief record an event
+  /// @details This method is thread-safe. Events are ignored if tracing is off.
+  /// @param[in] name name of the operation
+  /// @param[in] category category of the operation
+  /// @param[in] start start time
+  /// @param[in] end end time
+  void record(const std::string &name, const char *category,
+              const boost::posix_time::ptime &start, const boost::posix_time::ptime &end);
+
+  /// @brief write buffered events to the file
+  void flush();
+
+  /// @brief number of events recorded since tracing has been switched on
+  /// @return number of events
+  size_t nEvents() const;
+
+  /// @brief maximum number of events buffered in memory before they are written
+  static const size_t theirBufferSize = 65536;
+
+private:
+  /// @brief one complete event
+  struct Event {
+     /// @brief name of the operation
+     std::string itsName;
+     /// @brief category of the operation
+     const char *itsCategory;
+     /// @brief start time in microseconds since the epoch
+     long long itsStart;
+     /// @brief duration in microseconds
+     long long itsDuration;
+     /// @brief thread number
+     unsigned int itsThread;
+  };
+
+  /// @brief construct the tracer
+  /// @details Tracing is switched on if requested by the environment
+  AccessTracer();
+
+  /// @brief write buffered events, the mutex should be locked by the caller
+  void flushLocked();
+
+  /// @brief close the file, the mutex should be locked by the caller
+  void closeLocked();
+
+  /// @brief obtain the rank from the environment, if set by the MPI launcher
+  /// @return the rank or -1 if not found
+  static int rankFromEnvironment();
+
+  /// @brief convert time into microseconds since the epoch
+  /// @param[in] time time to convert
+  /// @return microseconds since 1970-01-01
+  static long long microseconds(const boost::posix_time::ptime &time);
+
+  /// @brief true if tracing is switched on
+  volatile bool itsEnabled;
+
+  /// @brief file name pattern (%w is replaced by the rank)
+  std::string itsFileName;
+
+  /// @brief rank of this process, -1 if not set
+  int itsRank;
+
+  /// @brief output stream, opened with the first flush
+  std::ofstream itsStream;
+
+  /// @brief true if at least one event has been written to the current file
+  bool itsWrittenEvents;
+
+  /// @brief buffered events
+  std::vector<Event> itsEvents;
+
+  /// @brief number of events recorded since tracing has been switched on
+  size_t itsNEvents;
+
+  /// @brief small numbers assigned to threads
+  std::map<boost::thread::id, unsigned int> itsThreads;
+
+  /// @brief mutex protecting the buffer and the stream
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ACCESS_TRACER_H
@@ -0,0 +1,92 @@
+/// @file
+/// @brief plain snapshot of the data accessor for inner loops
+/// @details Accessor classes form a deep hierarchy with virtual inheritance,
+/// so every call to visibility(), uvw() or antenna1() goes through virtual dispatch.
+/// This class takes the main fields of an accessor once per chunk and exposes them as
+/// contiguous read-only spans of a final (non-polymorphic) type, so inner loops of
+/// gridders and solvers can use them with static dispatch.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/AccessorSnapshot.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief empty snapshot
+AccessorSnapshot::AccessorSnapshot() : itsNRow(0), itsNChannel(0), itsNPol(0), itsTime(0.) {}
+
+/// @brief take the snapshot of an accessor
+/// @param[in] acc accessor
+/// @param[in] withNoise if true, the noise cube is taken as well (it may be read on demand)
+AccessorSnapshot::AccessorSnapshot(const IConstDataAccessor &acc, bool withNoise) :
+       itsNRow(acc.nRow()), itsNChannel(acc.nChannel()), itsNPol(acc.nPol()), itsTime(acc.time())
+{
+  take(acc.frequency(), itsFrequency);
+  take(acc.antenna1(), itsAntenna1);
+  take(acc.antenna2(), itsAntenna2);
+  take(acc.feed1(), itsFeed1);
+  take(acc.feed2(), itsFeed2);
+  take(acc.uvw(), itsUVW);
+  take(acc.visibility(), itsVisibility);
+  take(acc.flag(), itsFlag);
+  if (withNoise) {
+      take(acc.noise(), itsNoise);
+  }
+  ASKAPDEBUGASSERT(itsVisibility.nelements() == size_t(itsNRow) * itsNChannel * itsNPol);
+  ASKAPDEBUGASSERT(itsUVW.nelements() == itsNRow);
+}
+
+/// @brief reference an array, copy if it is not contiguous
+/// @param[in] in array returned by the accessor
+/// @param[out] out array to set up
+template<typename T>
+void AccessorSnapshot::take(const casacore::Array<T> &in, casacore::Array<T> &out)
+{
+  if (in.contiguousStorage()) {
+      // the accessor's own storage, no copy
+      out.reference(in);
+  } else {
+      out.resize(in.shape());
+      out = in;
+  }
+}
+
+/// @brief take the snapshot of an accessor
+/// @details This is a convenience function equivalent to the constructor of AccessorSnapshot.
+/// @param[in] acc accessor
+/// @param[in] withNoise if true, the noise cube is taken as well
+/// @return snapshot of the current chunk
+AccessorSnapshot snapshot(const IConstDataAccessor &acc, bool withNoise)
+{
+  return AccessorSnapshot(acc, withNoise);
+}
+
+} // namespace accessors
+
+} // namespace askap
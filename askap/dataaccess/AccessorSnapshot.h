@@ -0,0 +1,213 @@
+/// @file
+/// @brief plain snapshot of the data accessor for inner loops
+/// @details Accessor classes form a deep hierarchy with virtual inheritance,
+/// so every call to visibility(), uvw() or antenna1() goes through virtual dispatch.
+/// This class takes the main fields of an accessor once per chunk and exposes them as
+/// contiguous read-only spans of a final (non-polymorphic) type, so inner loops of
+/// gridders and solvers can use them with static dispatch.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_ACCESSOR_SNAPSHOT_H
+#define ASKAP_ACCESSORS_ACCESSOR_SNAPSHOT_H
+
+// std includes
+#include <cstddef>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief read-only view of a contiguous block of memory
+/// @details The span doesn't own the data, it is valid as long as the snapshot
+/// it has been obtained from exists.
+/// @ingroup dataaccess_hlp
+template<typename T>
+struct ConstSpan {
+  /// @brief empty span
+  ConstSpan() : itsData(0), itsSize(0) {}
+
+  /// @brief span of the given memory block
+  /// @param[in] data pointer to the first element
+  /// @param[in] size number of elements
+  ConstSpan(const T *data, size_t size) : itsData(data), itsSize(size) {}
+
+  /// @brief pointer to the first element
+  inline const T* data() const { return itsData; }
+
+  /// @brief number of elements
+  inline size_t size() const { return itsSize; }
+
+  /// @brief access an element (no bounds checking)
+  /// @param[in] index index of the element
+  inline const T& operator[](size_t index) const { return itsData[index]; }
+
+  /// @brief iterator to the first element
+  inline const T* begin() const { return itsData; }
+
+  /// @brief iterator past the last element
+  inline const T* end() const { return itsData + itsSize; }
+
+private:
+  /// @brief pointer to the first element
+  const T *itsData;
+  /// @brief number of elements
+  size_t itsSize;
+};
+
+/// @brief plain snapshot of the data accessor for inner loops
+/// @details The snapshot is taken once per chunk (e.g. right after the iterator has moved)
+/// and holds the number of rows, channels and polarisations, time, frequencies, antenna
+/// and feed indices, uvw, visibilities and flags (and, on request, noise). Arrays are taken
+/// by reference (casacore reference semantics), so no data are copied unless the array
+/// returned by the accessor is not contiguous. The snapshot keeps the data alive even if the
+/// accessor moves on, but it reflects in-place modifications made via the accessor (e.g.
+/// through rwVisibility). Cubes have the usual accessor layout (nRow x nChannel x nPol, the
+/// row index changes fastest), so element (row, chan, pol) is at
+/// row + nRow * (chan + nChannel * pol) of the span. The class is final and all its methods
+/// are inline and non-virtual.
+/// @ingroup dataaccess_hlp
+class AccessorSnapshot final
+{
+public:
+  /// @brief empty snapshot
+  AccessorSnapshot();
+
+  /// @brief take the snapshot of an accessor
+  /// @param[in] acc accessor
+  /// @param[in] withNoise if true, the noise cube is taken as well (it may be read on demand)
+  explicit AccessorSnapshot(const IConstDataAccessor &acc, bool withNoise = false);
+
+  /// @brief number of rows
+  inline casacore::uInt nRow() const { return itsNRow; }
+
+  /// @brief number of spectral channels
+  inline casacore::uInt nChannel() const { return itsNChannel; }
+
+  /// @brief number of polarisation products
+  inline casacore::uInt nPol() const { return itsNPol; }
+
+  /// @brief time stamp of the chunk
+  inline casacore::Double time() const { return itsTime; }
+
+  /// @brief frequencies for each channel
+  inline ConstSpan<casacore::Double> frequency() const { return span(itsFrequency); }
+
+  /// @brief first antenna index for each row
+  inline ConstSpan<casacore::uInt> antenna1() const { return span(itsAntenna1); }
+
+  /// @brief second antenna index for each row
+  inline ConstSpan<casacore::uInt> antenna2() const { return span(itsAntenna2); }
+
+  /// @brief first feed index for each row
+  inline ConstSpan<casacore::uInt> feed1() const { return span(itsFeed1); }
+
+  /// @brief second feed index for each row
+  inline ConstSpan<casacore::uInt> feed2() const { return span(itsFeed2); }
+
+  /// @brief uvw for each row
+  inline ConstSpan<casacore::RigidVector<casacore::Double, 3> > uvw() const { return span(itsUVW); }
+
+  /// @brief visibilities (nRow x nChannel x nPol)
+  inline ConstSpan<casacore::Complex> visibility() const { return span(itsVisibility); }
+
+  /// @brief flags (nRow x nChannel x nPol)
+  inline ConstSpan<casacore::Bool> flag() const { return span(itsFlag); }
+
+  /// @brief noise (nRow x nChannel x nPol), empty unless requested
+  inline ConstSpan<casacore::Complex> noise() const { return span(itsNoise); }
+
+  /// @brief index of the cube element in the spans
+  /// @param[in] row row
+  /// @param[in] chan channel
+  /// @param[in] pol polarisation
+  /// @return offset of the element
+  inline size_t index(casacore::uInt row, casacore::uInt chan, casacore::uInt pol) const
+         { return row + size_t(itsNRow) * (chan + size_t(itsNChannel) * pol); }
+
+private:
+  /// @brief span of a contiguous array
+  /// @param[in] arr array
+  /// @return span covering all elements
+  template<typename T>
+  static inline ConstSpan<T> span(const casacore::Array<T> &arr)
+         { return ConstSpan<T>(arr.data(), arr.nelements()); }
+
+  /// @brief reference an array, copy if it is not contiguous
+  /// @param[in] in array returned by the accessor
+  /// @param[out] out array to set up
+  template<typename T>
+  static void take(const casacore::Array<T> &in, casacore::Array<T> &out);
+
+  /// @brief number of rows
+  casacore::uInt itsNRow;
+  /// @brief number of channels
+  casacore::uInt itsNChannel;
+  /// @brief number of polarisation products
+  casacore::uInt itsNPol;
+  /// @brief time stamp
+  casacore::Double itsTime;
+  /// @brief frequencies
+  casacore::Vector<casacore::Double> itsFrequency;
+  /// @brief first antenna indices
+  casacore::Vector<casacore::uInt> itsAntenna1;
+  /// @brief second antenna indices
+  casacore::Vector<casacore::uInt> itsAntenna2;
+  /// @brief first feed indices
+  casacore::Vector<casacore::uInt> itsFeed1;
+  /// @brief second feed indices
+  casacore::Vector<casacore::uInt> itsFeed2;
+  /// @brief uvw
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+  /// @brief visibilities
+  casacore::Cube<casacore::Complex> itsVisibility;
+  /// @brief flags
+  casacore::Cube<casacore::Bool> itsFlag;
+  /// @brief noise
+  casacore::Cube<casacore::Complex> itsNoise;
+};
+
+/// @brief take the snapshot of an accessor
+/// @details This is a convenience function equivalent to the constructor of AccessorSnapshot.
+/// @param[in] acc accessor
+/// @param[in] withNoise if true, the noise cube is taken as well
+/// @return snapshot of the current chunk
+AccessorSnapshot snapshot(const IConstDataAccessor &acc, bool withNoise = false);
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ACCESSOR_SNAPSHOT_H
@@ -0,0 +1,152 @@
+/// @file
+/// @brief asynchronous interface to data iterators
+/// @details IConstDataIterator::next blocks until the next chunk is read. This class
+/// wraps any iterator (including adapters like DataIteratorAdapter or 
+/// TimeChunkIteratorAdapter) and performs the steps on an IteratorTaskPool, returning
+/// a future of the next accessor or calling a callback when it is ready. A task-based 
+/// scheduler can then overlap I/O of many iterators on a few threads.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/AsyncDataIterator.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+
+// std includes
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the asynchronous iterator
+/// @param[in] iter iterator to wrap
+/// @param[in] pool thread pool to execute the steps (can be shared by many iterators)
+AsyncDataIterator::AsyncDataIterator(const boost::shared_ptr<IConstDataIterator> &iter,
+                  const boost::shared_ptr<IteratorTaskPool> &pool) : itsIterator(iter), itsPool(pool),
+                  itsStarted(false)
+{
+  ASKAPCHECK(itsIterator, "An attempt to initialise AsyncDataIterator with empty iterator");
+  ASKAPCHECK(itsPool, "An attempt to initialise AsyncDataIterator with empty thread pool");
+}
+
+/// @brief request the next accessor
+/// @return future of the next accessor
+AsyncDataIterator::Future AsyncDataIterator::next()
+{
+  return submit(Callback());
+}
+
+/// @brief request the next accessor with a completion callback
+/// @param[in] callback function to call when the accessor is ready
+void AsyncDataIterator::next(const Callback &callback)
+{
+  ASKAPDEBUGASSERT(callback);
+  submit(callback);
+}
+
+/// @brief restart the iteration
+/// @details The next request delivers the first chunk again. This method blocks until
+/// the outstanding request (if any) is complete.
+void AsyncDataIterator::init()
+{
+  if (itsLastRequest.valid()) {
+      itsLastRequest.wait();
+  }
+  itsIterator->init();
+  itsStarted = false;
+}
+
+/// @brief check whether a request is in progress
+/// @return true, if the last request is not complete yet
+bool AsyncDataIterator::isPending() const
+{
+  return itsLastRequest.valid() && !itsLastRequest.is_ready();
+}
+
+/// @brief submit the step to the pool
+/// @param[in] callback optional callback
+/// @return future of the accessor
+AsyncDataIterator::Future AsyncDataIterator::submit(const Callback &callback)
+{
+  if (isPending()) {
+      ASKAPTHROW(DataAccessLogicError, "AsyncDataIterator: the next chunk is requested before the previous request is complete");
+  }
+  const boost::shared_ptr<boost::promise<AccessorPtr> > promise(new boost::promise<AccessorPtr>);
+  itsLastRequest = Future(promise->get_future());
+  itsPool->submit(boost::bind(&AsyncDataIterator::step, itsIterator, itsStarted, promise, callback));
+  itsStarted = true;
+  return itsLastRequest;
+}
+
+/// @brief perform one step of the iteration
+/// @details This method is executed by the pool thread
+/// @param[in] iter wrapped iterator
+/// @param[in] advance if true, the iterator is advanced before getting the accessor
+/// @param[in] promise promise to fulfil
+/// @param[in] callback optional callback
+void AsyncDataIterator::step(const boost::shared_ptr<IConstDataIterator> &iter, bool advance, 
+                 const boost::shared_ptr<boost::promise<AccessorPtr> > &promise,
+                 const Callback &callback)
+{
+  AccessorPtr result = NULL;
+  std::string error;
+  try {
+     if (advance) {
+         iter->next();
+     }
+     if (iter->hasMore()) {
+         result = &(iter->operator*());
+     }
+  }
+  catch (const std::exception &ex) {
+     error = ex.what();
+  }
+  catch (...) {
+     error = "unknown exception";
+  }
+  if (error.empty()) {
+      promise->set_value(result);
+  } else {
+      promise->set_exception(boost::copy_exception(DataAccessError(error)));
+  }
+  // the request is complete at this point, so the callback can issue the next one
+  if (callback) {
+      try {
+         callback(result, error);
+      }
+      catch (...) {
+         // there is nobody to report the error to
+      }
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
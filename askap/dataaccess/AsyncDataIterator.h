@@ -0,0 +1,133 @@
+/// @file
+/// @brief asynchronous interface to data iterators
+/// @details IConstDataIterator::next blocks until the next chunk is read. This class
+/// wraps any iterator (including adapters like DataIteratorAdapter or 
+/// TimeChunkIteratorAdapter) and performs the steps on an IteratorTaskPool, returning
+/// a future of the next accessor or calling a callback when it is ready. A task-based 
+/// scheduler can then overlap I/O of many iterators on a few threads.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_ASYNC_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_ASYNC_DATA_ITERATOR_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IteratorTaskPool.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief asynchronous interface to data iterators
+/// @details The first request delivers the current chunk of the wrapped iterator, each
+/// subsequent request advances it one step. The result is a pointer to the accessor which
+/// stays valid until the next request is made, the pointer is null at the end of the data.
+/// Only one request can be outstanding at a time, the wrapped iterator should not be used
+/// directly while the request is in progress. Exceptions thrown by the wrapped iterator
+/// are passed to the future as DataAccessError with the same message. The wrapped iterator
+/// is kept alive by the queued tasks, so this object can be destroyed at any time.
+/// @ingroup dataaccess_hlp
+class AsyncDataIterator : private boost::noncopyable {
+public:
+  /// @brief type of the result
+  /// @details Null pointer means the end of the data
+  typedef const IConstDataAccessor* AccessorPtr;
+
+  /// @brief type of the future of the next accessor
+  typedef boost::shared_future<AccessorPtr> Future;
+
+  /// @brief type of the completion callback
+  /// @details The callback is called from the pool thread with the accessor (null at
+  /// the end of the data) and an error message (empty if the step was successful).
+  /// The request is complete by the time the callback is called, so it can issue the
+  /// next request. Exceptions thrown by the callback are ignored.
+  typedef boost::function<void(AccessorPtr, const std::string &)> Callback;
+
+  /// @brief construct the asynchronous iterator
+  /// @param[in] iter iterator to wrap
+  /// @param[in] pool thread pool to execute the steps (can be shared by many iterators)
+  AsyncDataIterator(const boost::shared_ptr<IConstDataIterator> &iter,
+                    const boost::shared_ptr<IteratorTaskPool> &pool);
+
+  /// @brief request the next accessor
+  /// @return future of the next accessor
+  Future next();
+
+  /// @brief request the next accessor with a completion callback
+  /// @param[in] callback function to call when the accessor is ready
+  void next(const Callback &callback);
+
+  /// @brief restart the iteration
+  /// @details The next request delivers the first chunk again. This method blocks until
+  /// the outstanding request (if any) is complete.
+  void init();
+
+  /// @brief check whether a request is in progress
+  /// @return true, if the last request is not complete yet
+  bool isPending() const;
+
+protected:
+  /// @brief perform one step of the iteration
+  /// @details This method is executed by the pool thread
+  /// @param[in] iter wrapped iterator
+  /// @param[in] advance if true, the iterator is advanced before getting the accessor
+  /// @param[in] promise promise to fulfil
+  /// @param[in] callback optional callback
+  static void step(const boost::shared_ptr<IConstDataIterator> &iter, bool advance, 
+                   const boost::shared_ptr<boost::promise<AccessorPtr> > &promise,
+                   const Callback &callback);
+
+  /// @brief submit the step to the pool
+  /// @param[in] callback optional callback
+  /// @return future of the accessor
+  Future submit(const Callback &callback);
+
+private:
+  /// @brief wrapped iterator
+  boost::shared_ptr<IConstDataIterator> itsIterator;
+
+  /// @brief thread pool
+  boost::shared_ptr<IteratorTaskPool> itsPool;
+
+  /// @brief future of the last request
+  Future itsLastRequest;
+
+  /// @brief true, if the next request should advance the iterator
+  bool itsStarted;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ASYNC_DATA_ITERATOR_H
@@ -0,0 +1,465 @@
+/// @file
+/// @brief an accessor holding data averaged in time and/or frequency
+/// @details This class is used by AveragingIteratorAdapter to deliver binned
+/// data. Chunks of the original iterator are accumulated one by one, visibilities
+/// are averaged with the weights derived from the noise and flagged samples are
+/// excluded. Metadata which don't change within the bin (antenna and feed indices,
+/// pointing, polarisation) are copied from the first chunk, so the accessor stays
+/// valid after the original iterator has advanced.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/AveragedDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief copy selected elements of a vector
+/// @param[in] in input vector
+/// @param[in] rows indices of elements to copy
+/// @param[out] out output vector (resized to match rows)
+template<typename T>
+void selectRows(const casacore::Vector<T> &in, const casacore::Vector<casacore::uInt> &rows,
+                casacore::Vector<T> &out)
+{
+  out.resize(rows.nelements());
+  for (casacore::uInt row = 0; row < rows.nelements(); ++row) {
+       ASKAPDEBUGASSERT(rows[row] < in.nelements());
+       out[row] = in[rows[row]];
+  }
+}
+
+} // anonymous namespace
+
+/// @brief construct an empty accessor
+/// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+/// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
+/// to initialisation of a new UVW Machine
+AveragedDataAccessor::AveragedDataAccessor(size_t cacheSize, double tolerance) : itsNChanAvg(1),
+     itsNInputChannels(0), itsNInputRows(0), itsNChunks(0), itsTime(0.), itsRotatedUVW(cacheSize, tolerance) {}
+
+/// @brief start a new bin
+/// @details All accumulated data are discarded, metadata are copied from the given
+/// accessor and its data become the first contribution to the bin.
+/// @param[in] acc first chunk of the bin
+/// @param[in] nChanAvg number of adjacent channels to average (the last output channel
+/// gets fewer input channels if the number of channels is not a multiple of nChanAvg)
+void AveragedDataAccessor::start(const IConstDataAccessor &acc, casacore::uInt nChanAvg)
+{
+  casacore::Vector<casacore::uInt> rows(acc.nRow());
+  for (casacore::uInt row = 0; row < rows.nelements(); ++row) {
+       rows[row] = row;
+  }
+  start(acc, nChanAvg, rows);
+}
+
+/// @brief start a new bin for a subset of rows
+/// @details This version of the method is similar to the one above, but only the 
+/// given rows of the input accessors contribute to the bin, in the given order. 
+/// This is handy for baseline-dependent averaging where different groups of 
+/// baselines are averaged differently.
+/// @param[in] acc first chunk of the bin
+/// @param[in] nChanAvg number of adjacent channels to average (the last output channel
+/// gets fewer input channels if the number of channels is not a multiple of nChanAvg)
+/// @param[in] rows indices of the input rows to average (one per output row)
+void AveragedDataAccessor::start(const IConstDataAccessor &acc, casacore::uInt nChanAvg,
+                                 const casacore::Vector<casacore::uInt> &rows)
+{
+  ASKAPCHECK(nChanAvg > 0, "Number of channels to average should be positive");
+  itsNChanAvg = nChanAvg;
+  itsNInputChannels = acc.nChannel();
+  itsNInputRows = acc.nRow();
+  itsNChunks = 0;
+  itsRows.assign(rows.copy());
+  ASKAPCHECK(casacore::allLT(itsRows, itsNInputRows) || (itsRows.nelements() == 0), 
+             "Row selection passed to AveragedDataAccessor exceeds the number of rows ("<<itsNInputRows<<")");
+
+  selectRows(acc.antenna1(), itsRows, itsAntenna1);
+  selectRows(acc.antenna2(), itsRows, itsAntenna2);
+  selectRows(acc.feed1(), itsRows, itsFeed1);
+  selectRows(acc.feed2(), itsRows, itsFeed2);
+  selectRows(acc.feed1PA(), itsRows, itsFeed1PA);
+  selectRows(acc.feed2PA(), itsRows, itsFeed2PA);
+  selectRows(acc.pointingDir1(), itsRows, itsPointingDir1);
+  selectRows(acc.pointingDir2(), itsRows, itsPointingDir2);
+  selectRows(acc.dishPointing1(), itsRows, itsDishPointing1);
+  selectRows(acc.dishPointing2(), itsRows, itsDishPointing2);
+  itsStokes.assign(acc.stokes().copy());
+
+  const casacore::uInt nOutChan = (itsNInputChannels + itsNChanAvg - 1) / itsNChanAvg;
+  const casacore::IPosition shape(3, itsRows.nelements(), nOutChan, acc.nPol());
+  itsVisibility.resize(shape);
+  itsVisibility.set(casacore::Complex(0., 0.));
+  itsFlag.resize(shape);
+  itsNoise.resize(shape);
+  itsNoise.set(casacore::Complex(0., 0.));
+  itsSumOfWeights.resize(shape);
+  itsSumOfWeights.set(0.);
+  itsSumOfImagVariance.resize(shape);
+  itsSumOfImagVariance.set(0.);
+  itsUVW.resize(itsRows.nelements());
+  itsUVW.set(casacore::RigidVector<casacore::Double, 3>(0., 0., 0.));
+  itsTime = 0.;
+
+  // frequency of each output channel is the mean of its input channels
+  const casacore::Vector<casacore::Double> &freq = acc.frequency();
+  ASKAPDEBUGASSERT(freq.nelements() == itsNInputChannels);
+  itsFrequency.resize(nOutChan);
+  itsFrequency.set(0.);
+  for (casacore::uInt chan = 0; chan < itsNInputChannels; ++chan) {
+       itsFrequency[chan / itsNChanAvg] += freq[chan];
+  }
+  for (casacore::uInt outChan = 0; outChan < nOutChan; ++outChan) {
+       const casacore::uInt nAveraged = std::min(itsNChanAvg, itsNInputChannels - outChan * itsNChanAvg);
+       itsFrequency[outChan] /= nAveraged;
+  }
+  itsRotatedUVW.invalidate();
+  add(acc);
+}
+
+/// @brief check whether the given chunk can be added to the current bin
+/// @details The chunk should have the same shape and the same antennas and feeds in
+/// every selected row as the first chunk of the bin.
+/// @param[in] acc chunk to test
+/// @return true, if the chunk is compatible with the current bin
+bool AveragedDataAccessor::canAdd(const IConstDataAccessor &acc) const
+{
+  if ((acc.nRow() != itsNInputRows) || (acc.nChannel() != itsNInputChannels) || (acc.nPol() != nPol())) {
+      return false;
+  }
+  const casacore::Vector<casacore::uInt> &ant1 = acc.antenna1();
+  const casacore::Vector<casacore::uInt> &ant2 = acc.antenna2();
+  const casacore::Vector<casacore::uInt> &feed1 = acc.feed1();
+  const casacore::Vector<casacore::uInt> &feed2 = acc.feed2();
+  for (casacore::uInt row = 0; row < itsRows.nelements(); ++row) {
+       const casacore::uInt inRow = itsRows[row];
+       if ((ant1[inRow] != itsAntenna1[row]) || (ant2[inRow] != itsAntenna2[row]) ||
+           (feed1[inRow] != itsFeed1[row]) || (feed2[inRow] != itsFeed2[row])) {
+           return false;
+       }
+  }
+  return true;
+}
+
+/// @brief add a chunk to the current bin
+/// @param[in] acc chunk to add (should be compatible, see canAdd)
+void AveragedDataAccessor::add(const IConstDataAccessor &acc)
+{
+  ASKAPDEBUGASSERT(canAdd(acc));
+  ASKAPDEBUGASSERT(itsSumOfWeights.shape() == itsVisibility.shape());
+  // plain pointer loops below assume a contiguous storage, internal buffers are contiguous by construction
+  const casacore::Cube<casacore::Complex> vis = acc.visibility().contiguousStorage() ? 
+          acc.visibility() : casacore::Cube<casacore::Complex>(acc.visibility().copy());
+  const casacore::Cube<casacore::Bool> flag = acc.flag().contiguousStorage() ? 
+          acc.flag() : casacore::Cube<casacore::Bool>(acc.flag().copy());
+  const casacore::Cube<casacore::Complex> noise = acc.noise().contiguousStorage() ? 
+          acc.noise() : casacore::Cube<casacore::Complex>(acc.noise().copy());
+  ASKAPCHECK(vis.shape() == flag.shape() && vis.shape() == noise.shape(), 
+          "Visibility, flag and noise cubes have different shapes - unable to average");
+
+  const casacore::Complex *visPtr = vis.data();
+  const casacore::Bool *flagPtr = flag.data();
+  const casacore::Complex *noisePtr = noise.data();
+  casacore::Complex *sumVis = itsVisibility.data();
+  casacore::Complex *lastNoise = itsNoise.data();
+  casacore::Double *sumWeights = itsSumOfWeights.data();
+  casacore::Double *sumImagVariance = itsSumOfImagVariance.data();
+
+  const casacore::uInt nRows = nRow();
+  const casacore::uInt nOutChan = nChannel();
+  const casacore::uInt *rows = itsRows.data();
+  ASKAPDEBUGASSERT(itsRows.contiguousStorage());
+  for (casacore::uInt pol = 0; pol < nPol(); ++pol) {
+       for (casacore::uInt chan = 0; chan < itsNInputChannels; ++chan) {
+            const size_t offset = size_t(nRows) * (chan / itsNChanAvg + size_t(nOutChan) * pol);
+            const size_t inOffset = size_t(itsNInputRows) * (chan + size_t(itsNInputChannels) * pol);
+            for (casacore::uInt row = 0; row < nRows; ++row) {
+                 const size_t index = offset + row;
+                 const size_t inIndex = inOffset + rows[row];
+                 const casacore::Double sigma = casacore::real(noisePtr[inIndex]);
+                 if (!flagPtr[inIndex] && (sigma > 0.)) {
+                     const casacore::Double weight = 1. / (sigma * sigma);
+                     const casacore::Double imagSigma = casacore::imag(noisePtr[inIndex]);
+                     sumWeights[index] += weight;
+                     sumImagVariance[index] += weight * weight * imagSigma * imagSigma;
+                     sumVis[index] += casacore::Complex(weight) * visPtr[inIndex];
+                 } else if (sumWeights[index] == 0.) {
+                     lastNoise[index] = noisePtr[inIndex];
+                 }
+            }
+       }
+  }
+
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.uvw();
+  ASKAPDEBUGASSERT(uvw.nelements() == itsNInputRows);
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            itsUVW[row](dim) += uvw[rows[row]](dim);
+       }
+  }
+  itsTime += acc.time();
+  ++itsNChunks;
+}
+
+/// @brief compute the averages
+/// @details This method should be called when all chunks of the bin are added. The
+/// accumulation buffers are released.
+void AveragedDataAccessor::finalise()
+{
+  ASKAPCHECK(itsNChunks > 0, "AveragedDataAccessor::finalise is called for an empty bin");
+  ASKAPDEBUGASSERT(itsSumOfWeights.shape() == itsVisibility.shape());
+  casacore::Complex *vis = itsVisibility.data();
+  casacore::Bool *flag = itsFlag.data();
+  casacore::Complex *noise = itsNoise.data();
+  const casacore::Double *sumWeights = itsSumOfWeights.data();
+  const casacore::Double *sumImagVariance = itsSumOfImagVariance.data();
+  for (size_t index = 0; index < itsVisibility.nelements(); ++index) {
+       if (sumWeights[index] > 0.) {
+           vis[index] /= casacore::Float(sumWeights[index]);
+           noise[index] = casacore::Complex(1. / std::sqrt(sumWeights[index]),
+                                            std::sqrt(sumImagVariance[index]) / sumWeights[index]);
+           flag[index] = casacore::False;
+       } else {
+           vis[index] = casacore::Complex(0., 0.);
+           flag[index] = casacore::True;
+       }
+  }
+  itsSumOfWeights.resize(0, 0, 0);
+  itsSumOfImagVariance.resize(0, 0, 0);
+
+  for (casacore::uInt row = 0; row < itsUVW.nelements(); ++row) {
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            itsUVW[row](dim) /= itsNChunks;
+       }
+  }
+  itsTime /= itsNChunks;
+  itsRotatedUVW.invalidate();
+}
+
+/// The number of rows in this chunk
+/// @return the number of rows in this chunk
+casacore::uInt AveragedDataAccessor::nRow() const throw()
+{
+  return itsVisibility.nrow();
+}
+
+/// The number of spectral channels (equal for all rows)
+/// @return the number of spectral channels
+casacore::uInt AveragedDataAccessor::nChannel() const throw()
+{
+  return itsVisibility.ncolumn();
+}
+
+/// The number of polarization products (equal for all rows)
+/// @return the number of polarization products (can be 1,2 or 4)
+casacore::uInt AveragedDataAccessor::nPol() const throw()
+{
+  return itsVisibility.nplane();
+}
+
+/// First antenna IDs for all rows
+/// @return a vector with IDs of the first antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& AveragedDataAccessor::antenna1() const
+{
+  return itsAntenna1;
+}
+
+/// Second antenna IDs for all rows
+/// @return a vector with IDs of the second antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& AveragedDataAccessor::antenna2() const
+{
+  return itsAntenna2;
+}
+
+/// First feed IDs for all rows
+/// @return a vector with IDs of the first feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& AveragedDataAccessor::feed1() const
+{
+  return itsFeed1;
+}
+
+/// Second feed IDs for all rows
+/// @return a vector with IDs of the second feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& AveragedDataAccessor::feed2() const
+{
+  return itsFeed2;
+}
+
+/// Position angles of the first feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// first feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& AveragedDataAccessor::feed1PA() const
+{
+  return itsFeed1PA;
+}
+
+/// Position angles of the second feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// second feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& AveragedDataAccessor::feed2PA() const
+{
+  return itsFeed2PA;
+}
+
+/// Return pointing centre directions of the first antenna/feed
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& AveragedDataAccessor::pointingDir1() const
+{
+  return itsPointingDir1;
+}
+
+/// Pointing centre directions of the second antenna/feed
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& AveragedDataAccessor::pointingDir2() const
+{
+  return itsPointingDir2;
+}
+
+/// pointing direction for the centre of the first antenna 
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& AveragedDataAccessor::dishPointing1() const
+{
+  return itsDishPointing1;
+}
+
+/// pointing direction for the centre of the first antenna 
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& AveragedDataAccessor::dishPointing2() const
+{
+  return itsDishPointing2;
+}
+
+/// Visibilities (a cube is nRow x nChannel x nPol; each element is
+/// a complex visibility)
+/// @return a reference to nRow x nChannel x nPol cube, containing
+/// all visibility data
+const casacore::Cube<casacore::Complex>& AveragedDataAccessor::visibility() const
+{
+  return itsVisibility;
+}
+
+/// Cube of flags corresponding to the output of visibility() 
+/// @return a reference to nRow x nChannel x nPol cube with flag 
+///         information. If True, the corresponding element is flagged.
+const casacore::Cube<casacore::Bool>& AveragedDataAccessor::flag() const
+{
+  return itsFlag;
+}
+
+/// UVW
+/// @return a reference to vector containing uvw-coordinates
+/// packed into a 3-D rigid vector
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& AveragedDataAccessor::uvw() const
+{
+  return itsUVW;
+}
+
+/// @brief uvw after rotation
+/// @details This method calls UVWMachine to rotate baseline coordinates 
+/// for a new tangent point. Delays corresponding to this correction are
+/// returned by a separate method.
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return uvw after rotation to the new coordinate system for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	         AveragedDataAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
+{
+  return itsRotatedUVW.uvw(*this, tangentPoint);
+}
+
+/// @brief delay associated with uvw rotation
+/// @details This is a companion method to rotatedUVW. It returns delays corresponding
+/// to the baseline coordinate rotation. 
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+/// @return delays corresponding to the uvw rotation for each row
+const casacore::Vector<casacore::Double>& AveragedDataAccessor::uvwRotationDelay(
+	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
+{
+  return itsRotatedUVW.delays(*this, tangentPoint, imageCentre);
+}
+
+/// Noise level required for a proper weighting
+/// @return a reference to nRow x nChannel x nPol cube with
+///         complex noise estimates
+const casacore::Cube<casacore::Complex>& AveragedDataAccessor::noise() const
+{
+  return itsNoise;
+}
+
+/// Timestamp for each row
+/// @return a timestamp for this buffer (it is always the same
+///         for all rows. The timestamp is returned as 
+///         Double w.r.t. the origin specified by the 
+///         DataSource object and in that reference frame
+casacore::Double AveragedDataAccessor::time() const
+{
+  return itsTime;
+}
+
+/// Frequency for each channel
+/// @return a reference to vector containing frequencies for each
+///         spectral channel (vector size is nChannel).
+const casacore::Vector<casacore::Double>& AveragedDataAccessor::frequency() const
+{
+  return itsFrequency;
+}
+
+/// Velocity for each channel
+/// @details The velocity axis is not averaged, this method throws an exception
+/// @return a reference to vector containing velocities for each
+///         spectral channel (vector size is nChannel).
+const casacore::Vector<casacore::Double>& AveragedDataAccessor::velocity() const
+{
+  ASKAPTHROW(DataAccessLogicError, "AveragedDataAccessor::velocity is not supported");
+}
+
+/// @brief polarisation type for each product
+/// @return a reference to vector containing polarisation types for
+/// each product in the visibility cube (nPol() elements).
+const casacore::Vector<casacore::Stokes::StokesTypes>& AveragedDataAccessor::stokes() const
+{
+  return itsStokes;
+}
@@ -0,0 +1,302 @@
+/// @file
+/// @brief an accessor holding data averaged in time and/or frequency
+/// @details This class is used by AveragingIteratorAdapter to deliver binned
+/// data. Chunks of the original iterator are accumulated one by one, visibilities
+/// are averaged with the weights derived from the noise and flagged samples are
+/// excluded. Metadata which don't change within the bin (antenna and feed indices,
+/// pointing, polarisation) are copied from the first chunk, so the accessor stays
+/// valid after the original iterator has advanced.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_AVERAGED_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_AVERAGED_DATA_ACCESSOR_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/UVWRotationHandler.h>
+
+// boost includes
+#include <boost/utility.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief an accessor holding data averaged in time and/or frequency
+/// @details The accessor is filled by a sequence of calls: start with the first 
+/// chunk of the bin, add for each subsequent chunk (which has to be compatible, see
+/// canAdd) and finalise when the bin is complete. Each visibility is weighted by
+/// the inverse square of the real part of its noise, samples which are flagged or have
+/// a non-positive noise are excluded. The noise of the average is propagated accordingly.
+/// A sample of the output is flagged if none of the input samples could be used, such a
+/// sample has zero visibility and retains the noise of the last input sample.
+/// The uvw coordinates and the time are averaged over chunks, frequencies are averaged 
+/// over channels of each bin. Rotated uvws and delays are computed on demand from the
+/// averaged uvws.
+/// @ingroup dataaccess_hlp
+class AveragedDataAccessor : virtual public IConstDataAccessor,
+                             private boost::noncopyable
+{
+public:
+  /// @brief construct an empty accessor
+  /// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+  /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
+  /// to initialisation of a new UVW Machine
+  explicit AveragedDataAccessor(size_t cacheSize = 1, double tolerance = 1e-6);
+
+  /// @brief start a new bin
+  /// @details All accumulated data are discarded, metadata are copied from the given
+  /// accessor and its data become the first contribution to the bin.
+  /// @param[in] acc first chunk of the bin
+  /// @param[in] nChanAvg number of adjacent channels to average (the last output channel
+  /// gets fewer input channels if the number of channels is not a multiple of nChanAvg)
+  void start(const IConstDataAccessor &acc, casacore::uInt nChanAvg);
+
+  /// @brief start a new bin for a subset of rows
+  /// @details This version of the method is similar to the one above, but only the 
+  /// given rows of the input accessors contribute to the bin, in the given order. 
+  /// This is handy for baseline-dependent averaging where different groups of 
+  /// baselines are averaged differently.
+  /// @param[in] acc first chunk of the bin
+  /// @param[in] nChanAvg number of adjacent channels to average (the last output channel
+  /// gets fewer input channels if the number of channels is not a multiple of nChanAvg)
+  /// @param[in] rows indices of the input rows to average (one per output row)
+  void start(const IConstDataAccessor &acc, casacore::uInt nChanAvg, 
+             const casacore::Vector<casacore::uInt> &rows);
+
+  /// @brief check whether the given chunk can be added to the current bin
+  /// @details The chunk should have the same shape and the same antennas and feeds in
+  /// every selected row as the first chunk of the bin.
+  /// @param[in] acc chunk to test
+  /// @return true, if the chunk is compatible with the current bin
+  bool canAdd(const IConstDataAccessor &acc) const;
+
+  /// @brief add a chunk to the current bin
+  /// @param[in] acc chunk to add (should be compatible, see canAdd)
+  void add(const IConstDataAccessor &acc);
+
+  /// @brief compute the averages
+  /// @details This method should be called when all chunks of the bin are added. The
+  /// accumulation buffers are released.
+  void finalise();
+
+  /// @brief number of chunks in the current bin
+  /// @return number of accessors added since the last call to start
+  casacore::uInt nChunks() const { return itsNChunks; }
+
+  /// @brief number of input channels averaged into one output channel
+  /// @return number of channels given to the last call to start
+  casacore::uInt nChannelsAveraged() const { return itsNChanAvg; }
+
+  /// The number of rows in this chunk
+  /// @return the number of rows in this chunk
+  virtual casacore::uInt nRow() const throw();
+
+  /// The number of spectral channels (equal for all rows)
+  /// @return the number of spectral channels
+  virtual casacore::uInt nChannel() const throw();
+
+  /// The number of polarization products (equal for all rows)
+  /// @return the number of polarization products (can be 1,2 or 4)
+  virtual casacore::uInt nPol() const throw();
+
+  /// First antenna IDs for all rows
+  /// @return a vector with IDs of the first antenna corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& antenna1() const;
+
+  /// Second antenna IDs for all rows
+  /// @return a vector with IDs of the second antenna corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& antenna2() const;
+
+  /// First feed IDs for all rows
+  /// @return a vector with IDs of the first feed corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& feed1() const;
+
+  /// Second feed IDs for all rows
+  /// @return a vector with IDs of the second feed corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& feed2() const;
+
+  /// Position angles of the first feed for all rows
+  /// @return a vector with position angles (in radians) of the
+  /// first feed corresponding to each visibility
+  virtual const casacore::Vector<casacore::Float>& feed1PA() const;
+
+  /// Position angles of the second feed for all rows
+  /// @return a vector with position angles (in radians) of the
+  /// second feed corresponding to each visibility
+  virtual const casacore::Vector<casacore::Float>& feed2PA() const;
+
+  /// Return pointing centre directions of the first antenna/feed
+  /// @return a vector with direction measures, one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir1() const;
+
+  /// Pointing centre directions of the second antenna/feed
+  /// @return a vector with direction measures, one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir2() const;
+
+  /// pointing direction for the centre of the first antenna 
+  /// @return a vector with direction measures, one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing1() const;
+
+  /// pointing direction for the centre of the first antenna 
+  /// @return a vector with direction measures, one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing2() const;
+
+  /// Visibilities (a cube is nRow x nChannel x nPol; each element is
+  /// a complex visibility)
+  /// @return a reference to nRow x nChannel x nPol cube, containing
+  /// all visibility data
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// Cube of flags corresponding to the output of visibility() 
+  /// @return a reference to nRow x nChannel x nPol cube with flag 
+  ///         information. If True, the corresponding element is flagged.
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+  /// UVW
+  /// @return a reference to vector containing uvw-coordinates
+  /// packed into a 3-D rigid vector
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+        uvw() const;
+
+  /// @brief uvw after rotation
+  /// @details This method calls UVWMachine to rotate baseline coordinates 
+  /// for a new tangent point. Delays corresponding to this correction are
+  /// returned by a separate method.
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @return uvw after rotation to the new coordinate system for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	         rotatedUVW(const casacore::MDirection &tangentPoint) const;
+
+  /// @brief delay associated with uvw rotation
+  /// @details This is a companion method to rotatedUVW. It returns delays corresponding
+  /// to the baseline coordinate rotation. 
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+  /// @return delays corresponding to the uvw rotation for each row
+  virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
+	         const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const;
+
+  /// Noise level required for a proper weighting
+  /// @return a reference to nRow x nChannel x nPol cube with
+  ///         complex noise estimates
+  virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// Timestamp for each row
+  /// @return a timestamp for this buffer (it is always the same
+  ///         for all rows. The timestamp is returned as 
+  ///         Double w.r.t. the origin specified by the 
+  ///         DataSource object and in that reference frame
+  virtual casacore::Double time() const;
+
+  /// Frequency for each channel
+  /// @return a reference to vector containing frequencies for each
+  ///         spectral channel (vector size is nChannel).
+  virtual const casacore::Vector<casacore::Double>& frequency() const;
+
+  /// Velocity for each channel
+  /// @details The velocity axis is not averaged, this method throws an exception
+  /// @return a reference to vector containing velocities for each
+  ///         spectral channel (vector size is nChannel).
+  virtual const casacore::Vector<casacore::Double>& velocity() const;
+
+  /// @brief polarisation type for each product
+  /// @return a reference to vector containing polarisation types for
+  /// each product in the visibility cube (nPol() elements).
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const;
+
+private:
+  /// @brief number of adjacent channels to average
+  casacore::uInt itsNChanAvg;
+  /// @brief number of channels in the input chunks
+  casacore::uInt itsNInputChannels;
+  /// @brief number of rows in the input chunks
+  casacore::uInt itsNInputRows;
+  /// @brief input row used for each output row
+  casacore::Vector<casacore::uInt> itsRows;
+  /// @brief number of chunks added to the current bin
+  casacore::uInt itsNChunks;
+  /// @brief first antenna IDs
+  casacore::Vector<casacore::uInt> itsAntenna1;
+  /// @brief second antenna IDs
+  casacore::Vector<casacore::uInt> itsAntenna2;
+  /// @brief first feed IDs
+  casacore::Vector<casacore::uInt> itsFeed1;
+  /// @brief second feed IDs
+  casacore::Vector<casacore::uInt> itsFeed2;
+  /// @brief position angles of the first feed
+  casacore::Vector<casacore::Float> itsFeed1PA;
+  /// @brief position angles of the second feed
+  casacore::Vector<casacore::Float> itsFeed2PA;
+  /// @brief pointing directions of the first antenna/feed
+  casacore::Vector<casacore::MVDirection> itsPointingDir1;
+  /// @brief pointing directions of the second antenna/feed
+  casacore::Vector<casacore::MVDirection> itsPointingDir2;
+  /// @brief dish pointing directions of the first antenna
+  casacore::Vector<casacore::MVDirection> itsDishPointing1;
+  /// @brief dish pointing directions of the second antenna
+  casacore::Vector<casacore::MVDirection> itsDishPointing2;
+  /// @brief averaged visibilities (weighted sums during accumulation)
+  casacore::Cube<casacore::Complex> itsVisibility;
+  /// @brief flags of the averaged data
+  casacore::Cube<casacore::Bool> itsFlag;
+  /// @brief noise of the averaged data (noise of the last input sample during accumulation)
+  casacore::Cube<casacore::Complex> itsNoise;
+  /// @brief sum of weights for each output sample
+  casacore::Cube<casacore::Double> itsSumOfWeights;
+  /// @brief sum of squared weight times variance of the imaginary part for each output sample
+  casacore::Cube<casacore::Double> itsSumOfImagVariance;
+  /// @brief averaged uvw (sums during accumulation)
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+  /// @brief averaged time stamp (sum during accumulation)
+  casacore::Double itsTime;
+  /// @brief frequencies of the averaged channels
+  casacore::Vector<casacore::Double> itsFrequency;
+  /// @brief polarisation types
+  casacore::Vector<casacore::Stokes::StokesTypes> itsStokes;
+  /// @brief handler of rotated uvws and delays
+  UVWRotationHandler itsRotatedUVW;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_AVERAGED_DATA_ACCESSOR_H
@@ -0,0 +1,155 @@
+/// @file
+/// @brief iterator adapter averaging data in time and/or frequency on the fly
+///
+/// @details This adapter is derived from DataIteratorAdapter. Each step of
+/// the adapter consumes one or more consecutive chunks of the wrapped iterator
+/// which fit into the given time interval and delivers their average. In addition,
+/// the given number of adjacent spectral channels can be averaged together.
+/// Visibilities are weighted by the noise and flagged samples are excluded. This
+/// allows consumers to work with binned data without writing a pre-averaged dataset.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/AveragingIteratorAdapter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief setup with the given iterator
+/// @details
+/// @param[in] iter shared pointer to iterator to be wrapped
+/// @param[in] nChanAvg number of adjacent channels to average together (1 means no
+/// frequency averaging)
+/// @param[in] interval maximum time span of a single bin (in the units of the time 
+/// axis of the iterator, i.e. seconds by default). Non-positive interval means no
+/// time averaging (every chunk of the wrapped iterator makes its own bin)
+AveragingIteratorAdapter::AveragingIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter, 
+           const casacore::uInt nChanAvg, const double interval) : DataIteratorAdapter(iter),
+           itsNChanAvg(nChanAvg), itsInterval(interval), itsHasMore(false), 
+           itsAveragedAccessor(new AveragedDataAccessor)
+{
+  ASKAPCHECK(iter, "An attempt to initialise AveragingIteratorAdapter with empty shared pointer");
+  ASKAPCHECK(nChanAvg > 0, "Number of channels to average should be positive, you have "<<nChanAvg);
+  fillBin();
+}
+
+/// Restart the iteration from the beginning
+void AveragingIteratorAdapter::init()
+{
+  itsOutputAdapter.detach();
+  roIterator().init();
+  fillBin();
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the averaged data of the current bin
+IDataAccessor& AveragingIteratorAdapter::operator*() const
+{
+  ASKAPCHECK(itsHasMore, "No more averaged data available");
+  itsOutputAdapter.associate(*itsAveragedAccessor);
+  return itsOutputAdapter;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool AveragingIteratorAdapter::hasMore() const throw()
+{
+  return itsHasMore;
+}
+
+/// advance the iterator one step further 
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool AveragingIteratorAdapter::next()
+{
+  ASKAPCHECK(itsHasMore, "There are no more averaged data available");
+  itsOutputAdapter.detach();
+  fillBin();
+  return itsHasMore;
+}
+
+/// @brief fill the next bin
+/// @details This method consumes chunks of the wrapped iterator starting from the 
+/// current one and sets itsHasMore flag if a bin has been formed.
+void AveragingIteratorAdapter::fillBin()
+{
+  IConstDataIterator &it = roIterator();
+  itsHasMore = it.hasMore();
+  if (!itsHasMore) {
+      return;
+  }
+  const double startTime = it->time();
+  itsAveragedAccessor->start(*it, itsNChanAvg);
+  for (it.next(); (itsInterval > 0) && it.hasMore(); it.next()) {
+       const double curTime = it->time();
+       ASKAPCHECK(curTime >= startTime, 
+           "Data appear to be not in time order, AveragingIteratorAdapter can't handle this situation. Bin start time = "<<
+           startTime<<", current time = "<<curTime);
+       if ((curTime - startTime >= itsInterval) || !itsAveragedAccessor->canAdd(*it)) {
+           break;
+       }
+       itsAveragedAccessor->add(*it);
+  }
+  itsAveragedAccessor->finalise();
+}
+
+/// @brief number of chunks of the wrapped iterator averaged in the current bin
+/// @return number of chunks
+casacore::uInt AveragingIteratorAdapter::nChunksAveraged() const
+{
+  ASKAPCHECK(itsHasMore, "No more averaged data available");
+  return itsAveragedAccessor->nChunks();
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+void AveragingIteratorAdapter::chooseBuffer(const std::string &)
+{
+  ASKAPTHROW(DataAccessLogicError, "AveragingIteratorAdapter doesn't support buffers");
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+void AveragingIteratorAdapter::chooseOriginal()
+{
+  ASKAPTHROW(DataAccessLogicError, "AveragingIteratorAdapter doesn't support buffers");
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+/// @return a reference to writable data accessor to the buffer requested
+IDataAccessor& AveragingIteratorAdapter::buffer(const std::string &) const
+{
+  ASKAPTHROW(DataAccessLogicError, "AveragingIteratorAdapter doesn't support buffers");
+}
+
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,137 @@
+/// @file
+/// @brief iterator adapter averaging data in time and/or frequency on the fly
+///
+/// @details This adapter is derived from DataIteratorAdapter. Each step of
+/// the adapter consumes one or more consecutive chunks of the wrapped iterator
+/// which fit into the given time interval and delivers their average. In addition,
+/// the given number of adjacent spectral channels can be averaged together.
+/// Visibilities are weighted by the noise and flagged samples are excluded. This
+/// allows consumers to work with binned data without writing a pre-averaged dataset.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_AVERAGING_ITERATOR_ADAPTER_H
+#define ASKAP_ACCESSORS_AVERAGING_ITERATOR_ADAPTER_H
+
+#include <askap/dataaccess/DataIteratorAdapter.h>
+#include <askap/dataaccess/DataAccessorAdapter.h>
+#include <askap/dataaccess/AveragedDataAccessor.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iterator adapter averaging data in time and/or frequency on the fly
+/// @details Each step of this adapter corresponds to a bin which starts at the current
+/// chunk of the wrapped iterator and includes all following chunks with time stamps
+/// less than the given interval apart from the first one (the iterator is assumed to
+/// be time-ordered). A bin is also closed when a chunk with a different shape or a 
+/// different order of baselines is encountered. Within each bin, the given number of
+/// adjacent channels are averaged together. The averaged data are read-only, the
+/// accessor returned by operator* is a DataAccessorAdapter associated with an
+/// AveragedDataAccessor (see that class for the details of weighting and flagging).
+/// Buffers are not supported as they would not conform to the averaged data.
+/// @ingroup dataaccess_hlp
+class AveragingIteratorAdapter : virtual public DataIteratorAdapter
+{
+public:
+  /// @brief setup with the given iterator
+  /// @details
+  /// @param[in] iter shared pointer to iterator to be wrapped
+  /// @param[in] nChanAvg number of adjacent channels to average together (1 means no
+  /// frequency averaging)
+  /// @param[in] interval maximum time span of a single bin (in the units of the time 
+  /// axis of the iterator, i.e. seconds by default). Non-positive interval means no
+  /// time averaging (every chunk of the wrapped iterator makes its own bin)
+  explicit AveragingIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter, 
+           const casacore::uInt nChanAvg = 1, const double interval = -1);
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the averaged data of the current bin
+  virtual IDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  /// @param[in] bufferID  the name of the buffer to choose
+  virtual void chooseBuffer(const std::string &bufferID);
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  virtual void chooseOriginal();
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  /// @param[in] bufferID the name of the buffer requested
+  /// @return a reference to writable data accessor to the buffer requested
+  virtual IDataAccessor& buffer(const std::string &bufferID) const;
+
+  /// @brief number of chunks of the wrapped iterator averaged in the current bin
+  /// @return number of chunks
+  casacore::uInt nChunksAveraged() const;
+
+protected:
+  /// @brief fill the next bin
+  /// @details This method consumes chunks of the wrapped iterator starting from the 
+  /// current one and sets itsHasMore flag if a bin has been formed.
+  void fillBin();
+
+private:
+  /// @brief number of adjacent channels to average
+  casacore::uInt itsNChanAvg;
+
+  /// @brief maximum time span of a single bin, non-positive value means no time averaging
+  double itsInterval;
+
+  /// @brief true, if the current bin contains valid data
+  bool itsHasMore;
+
+  /// @brief averaged data of the current bin
+  boost::shared_ptr<AveragedDataAccessor> itsAveragedAccessor;
+
+  /// @brief adapter giving out the averaged data with the right type
+  mutable DataAccessorAdapter itsOutputAdapter;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_AVERAGING_ITERATOR_ADAPTER_H
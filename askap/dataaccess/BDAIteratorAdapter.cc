@@ -0,0 +1,314 @@
+/// @file
+/// @brief iterator adapter doing baseline-dependent averaging
+///
+/// @details This adapter is derived from DataIteratorAdapter. Short baselines are
+/// oversampled in time and frequency compared to the rate their fringes change at the
+/// edge of the field of view. The adapter estimates, for each baseline, how long and how
+/// many adjacent channels can be averaged without exceeding the given decorrelation budget,
+/// and delivers the averaged data. Different groups of baselines end up in different
+/// accessors, thus the output consists of rows with variable integration times.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/BDAIteratorAdapter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <cmath>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief angular velocity of the Earth rotation in rad/s (sidereal)
+const double earthRotationRate = 7.2921150e-5;
+
+/// @brief largest time class, i.e. the shortest interval is maxInterval / 2^maxTimeClass
+const casacore::uInt maxTimeClass = 16;
+
+} // anonymous namespace
+
+/// @brief setup with the given iterator
+/// @details
+/// @param[in] iter shared pointer to iterator to be wrapped
+/// @param[in] fieldRadius radius of the field of view in radians (the decorrelation
+/// budget applies at this distance from the phase centre)
+/// @param[in] maxLoss acceptable fractional amplitude loss due to averaging (e.g. 0.01);
+/// the budget applies separately to time and frequency averaging
+/// @param[in] maxInterval maximum averaging interval (in the units of the time axis of the
+/// iterator, i.e. seconds by default), short baselines will be averaged to this interval
+/// @param[in] maxChanAvg maximum number of adjacent channels to average together, the actual
+/// number is a power of two not exceeding this value (1 means no frequency averaging)
+BDAIteratorAdapter::BDAIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter, 
+           const double fieldRadius, const double maxLoss, const double maxInterval, 
+           const casacore::uInt maxChanAvg) : DataIteratorAdapter(iter), itsFieldRadius(fieldRadius),
+           itsMaxPhaseChange(0.), itsMaxInterval(maxInterval), itsMaxChanAvg(maxChanAvg),
+           itsWindowActive(false), itsWindowStart(0.), itsWindowNRow(0), itsWindowNChannel(0),
+           itsWindowNPol(0)
+{
+  ASKAPCHECK(iter, "An attempt to initialise BDAIteratorAdapter with empty shared pointer");
+  ASKAPCHECK(fieldRadius >= 0., "Field radius should be non-negative, you have "<<fieldRadius);
+  ASKAPCHECK((maxLoss > 0.) && (maxLoss < 1.), "Acceptable amplitude loss should be between 0 and 1, you have "<<maxLoss);
+  ASKAPCHECK(maxInterval > 0., "Maximum averaging interval should be positive, you have "<<maxInterval);
+  ASKAPCHECK(maxChanAvg > 0, "Maximum number of channels to average should be positive, you have "<<maxChanAvg);
+  // small angle approximation of 1 - sinc(dPhi/2) = maxLoss
+  itsMaxPhaseChange = std::sqrt(24. * maxLoss);
+  fillQueue();
+}
+
+/// Restart the iteration from the beginning
+void BDAIteratorAdapter::init()
+{
+  itsOutputAdapter.detach();
+  itsQueue.clear();
+  itsGroups.clear();
+  itsWindowActive = false;
+  roIterator().init();
+  fillQueue();
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the averaged data of the current group of baselines
+IDataAccessor& BDAIteratorAdapter::operator*() const
+{
+  ASKAPCHECK(!itsQueue.empty(), "No more averaged data available");
+  itsOutputAdapter.associate(*itsQueue.front());
+  return itsOutputAdapter;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool BDAIteratorAdapter::hasMore() const throw()
+{
+  return !itsQueue.empty();
+}
+
+/// advance the iterator one step further 
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool BDAIteratorAdapter::next()
+{
+  ASKAPCHECK(!itsQueue.empty(), "There are no more averaged data available");
+  itsOutputAdapter.detach();
+  itsQueue.pop_front();
+  fillQueue();
+  return hasMore();
+}
+
+/// @brief number of chunks of the wrapped iterator averaged in the current accessor
+/// @return number of chunks
+casacore::uInt BDAIteratorAdapter::nChunksAveraged() const
+{
+  ASKAPCHECK(!itsQueue.empty(), "No more averaged data available");
+  return itsQueue.front()->nChunks();
+}
+
+/// @brief number of input channels averaged into one channel of the current accessor
+/// @return number of channels
+casacore::uInt BDAIteratorAdapter::nChannelsAveraged() const
+{
+  ASKAPCHECK(!itsQueue.empty(), "No more averaged data available");
+  return itsQueue.front()->nChannelsAveraged();
+}
+
+/// @brief determine the averaging for a single baseline
+/// @details This method encapsulates the smearing estimate described in the class
+/// documentation. It is public to simplify testing.
+/// @param[in] baselineLength baseline length in metres
+/// @param[in] maxFrequency highest frequency of the data in Hz
+/// @param[in] chanWidth channel width in Hz
+/// @return a pair with the time class k (the averaging interval is maxInterval / 2^k)
+/// and the number of channels to average
+std::pair<casacore::uInt, casacore::uInt> BDAIteratorAdapter::averagingFor(const double baselineLength,
+               const double maxFrequency, const double chanWidth) const
+{
+  // phase change at the edge of the field per unit of frequency (rad/Hz)
+  const double phasePerHz = 2. * casacore::C::pi * baselineLength * itsFieldRadius / casacore::C::c;
+  casacore::uInt nChanAvg = 1;
+  if (chanWidth > 0.) {
+      while ((2 * nChanAvg <= itsMaxChanAvg) && (phasePerHz * chanWidth * 2 * nChanAvg <= itsMaxPhaseChange)) {
+             nChanAvg *= 2;
+      }
+  }
+  // maximum fringe rate at the edge of the field (rad/s)
+  const double fringeRate = earthRotationRate * phasePerHz * std::abs(maxFrequency);
+  casacore::uInt timeClass = 0;
+  while ((timeClass < maxTimeClass) && (std::ldexp(itsMaxInterval, -int(timeClass)) * fringeRate > itsMaxPhaseChange)) {
+         ++timeClass;
+  }
+  return std::make_pair(timeClass, nChanAvg);
+}
+
+/// @brief fill the queue of averaged accessors
+/// @details This method consumes chunks of the wrapped iterator until at least one
+/// averaged accessor is ready or the wrapped iterator is exhausted.
+void BDAIteratorAdapter::fillQueue()
+{
+  IConstDataIterator &it = roIterator();
+  for (; itsQueue.empty() && it.hasMore(); it.next()) {
+       const IConstDataAccessor &acc = *it;
+       if (itsWindowActive) {
+           const double curTime = acc.time();
+           ASKAPCHECK(curTime >= itsWindowStart, 
+               "Data appear to be not in time order, BDAIteratorAdapter can't handle this situation. Window start time = "<<
+               itsWindowStart<<", current time = "<<curTime);
+           if ((curTime - itsWindowStart >= itsMaxInterval) || !matchesWindow(acc)) {
+               flushWindow();
+           }
+       }
+       if (!itsWindowActive) {
+           startWindow(acc);
+       }
+       process(acc);
+  }
+  if (itsQueue.empty() && itsWindowActive) {
+      flushWindow();
+  }
+}
+
+/// @brief set up groups of baselines for the new window
+/// @param[in] acc the first chunk of the window
+void BDAIteratorAdapter::startWindow(const IConstDataAccessor &acc)
+{
+  ASKAPDEBUGASSERT(itsGroups.empty());
+  itsWindowStart = acc.time();
+  itsWindowNRow = acc.nRow();
+  itsWindowNChannel = acc.nChannel();
+  itsWindowNPol = acc.nPol();
+  itsWindowAntenna1.assign(acc.antenna1().copy());
+  itsWindowAntenna2.assign(acc.antenna2().copy());
+  itsWindowFeed1.assign(acc.feed1().copy());
+  itsWindowFeed2.assign(acc.feed2().copy());
+
+  const casacore::Vector<casacore::Double> &freq = acc.frequency();
+  const double maxFrequency = freq.nelements() > 0 ? casacore::max(casacore::abs(freq)) : 0.;
+  const double chanWidth = freq.nelements() > 1 ? std::abs(freq[1] - freq[0]) : 0.;
+
+  std::map<std::pair<casacore::uInt, casacore::uInt>, std::vector<casacore::uInt> > rowsPerGroup;
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.uvw();
+  ASKAPDEBUGASSERT(uvw.nelements() == itsWindowNRow);
+  for (casacore::uInt row = 0; row < itsWindowNRow; ++row) {
+       const double baselineLength = std::sqrt(uvw[row](0) * uvw[row](0) + uvw[row](1) * uvw[row](1) +
+                                               uvw[row](2) * uvw[row](2));
+       rowsPerGroup[averagingFor(baselineLength, maxFrequency, chanWidth)].push_back(row);
+  }
+  for (std::map<std::pair<casacore::uInt, casacore::uInt>, std::vector<casacore::uInt> >::const_iterator ci = 
+       rowsPerGroup.begin(); ci != rowsPerGroup.end(); ++ci) {
+       BaselineGroup &group = itsGroups[ci->first];
+       group.itsTimeClass = ci->first.first;
+       group.itsNChanAvg = ci->first.second;
+       group.itsRows.assign(casacore::Vector<casacore::uInt>(ci->second));
+       group.itsBin = -1;
+  }
+  itsWindowActive = true;
+}
+
+/// @brief finalise all groups of the current window and queue the results
+void BDAIteratorAdapter::flushWindow()
+{
+  for (std::map<std::pair<casacore::uInt, casacore::uInt>, BaselineGroup>::iterator it = itsGroups.begin();
+       it != itsGroups.end(); ++it) {
+       BaselineGroup &group = it->second;
+       if (group.itsBin >= 0) {
+           group.itsAccessor->finalise();
+           itsQueue.push_back(group.itsAccessor);
+       }
+  }
+  itsGroups.clear();
+  itsWindowActive = false;
+}
+
+/// @brief check that the given chunk has the layout of the current window
+/// @param[in] acc chunk to test
+/// @return true, if the chunk can be processed as part of the current window
+bool BDAIteratorAdapter::matchesWindow(const IConstDataAccessor &acc) const
+{
+  if ((acc.nRow() != itsWindowNRow) || (acc.nChannel() != itsWindowNChannel) || (acc.nPol() != itsWindowNPol)) {
+      return false;
+  }
+  return casacore::allEQ(acc.antenna1(), itsWindowAntenna1) && casacore::allEQ(acc.antenna2(), itsWindowAntenna2) &&
+         casacore::allEQ(acc.feed1(), itsWindowFeed1) && casacore::allEQ(acc.feed2(), itsWindowFeed2);
+}
+
+/// @brief add a chunk to all groups of the current window
+/// @param[in] acc chunk to add
+void BDAIteratorAdapter::process(const IConstDataAccessor &acc)
+{
+  ASKAPDEBUGASSERT(itsWindowActive);
+  const double offset = acc.time() - itsWindowStart;
+  for (std::map<std::pair<casacore::uInt, casacore::uInt>, BaselineGroup>::iterator it = itsGroups.begin();
+       it != itsGroups.end(); ++it) {
+       BaselineGroup &group = it->second;
+       const int bin = int(std::floor(offset / std::ldexp(itsMaxInterval, -int(group.itsTimeClass))));
+       if ((group.itsBin >= 0) && (bin != group.itsBin)) {
+           group.itsAccessor->finalise();
+           itsQueue.push_back(group.itsAccessor);
+           group.itsBin = -1;
+       }
+       if (group.itsBin < 0) {
+           // queued accessors may still be in use, so each interval gets a new one
+           group.itsAccessor.reset(new AveragedDataAccessor);
+           group.itsAccessor->start(acc, group.itsNChanAvg, group.itsRows);
+           group.itsBin = bin;
+       } else {
+           group.itsAccessor->add(acc);
+       }
+  }
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+void BDAIteratorAdapter::chooseBuffer(const std::string &)
+{
+  ASKAPTHROW(DataAccessLogicError, "BDAIteratorAdapter doesn't support buffers");
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+void BDAIteratorAdapter::chooseOriginal()
+{
+  ASKAPTHROW(DataAccessLogicError, "BDAIteratorAdapter doesn't support buffers");
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+/// @return a reference to writable data accessor to the buffer requested
+IDataAccessor& BDAIteratorAdapter::buffer(const std::string &) const
+{
+  ASKAPTHROW(DataAccessLogicError, "BDAIteratorAdapter doesn't support buffers");
+}
+
+} // namespace accessors
+
+} // namespace askap
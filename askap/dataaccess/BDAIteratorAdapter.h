@@ -0,0 +1,237 @@
+/// @file
+/// @brief iterator adapter doing baseline-dependent averaging
+///
+/// @details This adapter is derived from DataIteratorAdapter. Short baselines are
+/// oversampled in time and frequency compared to the rate their fringes change at the
+/// edge of the field of view. The adapter estimates, for each baseline, how long and how
+/// many adjacent channels can be averaged without exceeding the given decorrelation budget,
+/// and delivers the averaged data. Different groups of baselines end up in different
+/// accessors, thus the output consists of rows with variable integration times.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_BDA_ITERATOR_ADAPTER_H
+#define ASKAP_ACCESSORS_BDA_ITERATOR_ADAPTER_H
+
+#include <askap/dataaccess/DataIteratorAdapter.h>
+#include <askap/dataaccess/DataAccessorAdapter.h>
+#include <askap/dataaccess/AveragedDataAccessor.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <deque>
+#include <map>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iterator adapter doing baseline-dependent averaging
+/// @details The data are processed in windows of the given maximum interval which start at
+/// a chunk of the wrapped iterator (which is assumed to be time-ordered). At the start of each
+/// window, every row is assigned to a group according to its baseline length |uvw|. The group
+/// defines the averaging interval (maximum interval divided by a power of two) and the number
+/// of adjacent channels to average (a power of two not exceeding the given maximum). Both are 
+/// chosen as large as possible, provided the phase of a source at the edge of the field 
+/// changes across the averaged sample by less than the amount corresponding to the 
+/// decorrelation budget. For a linear phase change of dPhi radians, the amplitude is reduced by 
+/// 1 - sinc(dPhi/2) ~ dPhi^2/24, the budget is applied separately to time and frequency 
+/// averaging. The time smearing estimate assumes the maximum fringe rate of
+/// omega_E |b| theta / lambda at the highest frequency of the chunk. This is conservative 
+/// because the full baseline length rather than its projection is used.
+///
+/// Each group is averaged separately with AveragedDataAccessor, an accessor is delivered by
+/// this adapter every time the averaging interval of some group is complete. Therefore, 
+/// accessors are not strictly in time order and have different number of rows and channels.
+/// The window is also closed (and a new layout of groups is determined) when a chunk with a
+/// different shape or a different order of baselines is encountered. The data are assumed to
+/// be in the default units for the data source, i.e. time in seconds, frequency in Hz and
+/// uvw in metres. As for AveragingIteratorAdapter, the averaged data are read only and
+/// buffers are not supported.
+/// @ingroup dataaccess_hlp
+class BDAIteratorAdapter : virtual public DataIteratorAdapter
+{
+public:
+  /// @brief setup with the given iterator
+  /// @details
+  /// @param[in] iter shared pointer to iterator to be wrapped
+  /// @param[in] fieldRadius radius of the field of view in radians (the decorrelation
+  /// budget applies at this distance from the phase centre)
+  /// @param[in] maxLoss acceptable fractional amplitude loss due to averaging (e.g. 0.01);
+  /// the budget applies separately to time and frequency averaging
+  /// @param[in] maxInterval maximum averaging interval (in the units of the time axis of the
+  /// iterator, i.e. seconds by default), short baselines will be averaged to this interval
+  /// @param[in] maxChanAvg maximum number of adjacent channels to average together, the actual
+  /// number is a power of two not exceeding this value (1 means no frequency averaging)
+  BDAIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter, const double fieldRadius,
+                     const double maxLoss, const double maxInterval, const casacore::uInt maxChanAvg = 1);
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the averaged data of the current group of baselines
+  virtual IDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  /// @param[in] bufferID  the name of the buffer to choose
+  virtual void chooseBuffer(const std::string &bufferID);
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  virtual void chooseOriginal();
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  /// @param[in] bufferID the name of the buffer requested
+  /// @return a reference to writable data accessor to the buffer requested
+  virtual IDataAccessor& buffer(const std::string &bufferID) const;
+
+  /// @brief number of chunks of the wrapped iterator averaged in the current accessor
+  /// @return number of chunks
+  casacore::uInt nChunksAveraged() const;
+
+  /// @brief number of input channels averaged into one channel of the current accessor
+  /// @return number of channels
+  casacore::uInt nChannelsAveraged() const;
+
+  /// @brief determine the averaging for a single baseline
+  /// @details This method encapsulates the smearing estimate described in the class
+  /// documentation. It is public to simplify testing.
+  /// @param[in] baselineLength baseline length in metres
+  /// @param[in] maxFrequency highest frequency of the data in Hz
+  /// @param[in] chanWidth channel width in Hz
+  /// @return a pair with the time class k (the averaging interval is maxInterval / 2^k)
+  /// and the number of channels to average
+  std::pair<casacore::uInt, casacore::uInt> averagingFor(const double baselineLength, 
+               const double maxFrequency, const double chanWidth) const;
+
+protected:
+  /// @brief fill the queue of averaged accessors
+  /// @details This method consumes chunks of the wrapped iterator until at least one
+  /// averaged accessor is ready or the wrapped iterator is exhausted.
+  void fillQueue();
+
+  /// @brief set up groups of baselines for the new window
+  /// @param[in] acc the first chunk of the window
+  void startWindow(const IConstDataAccessor &acc);
+
+  /// @brief finalise all groups of the current window and queue the results
+  void flushWindow();
+
+  /// @brief check that the given chunk has the layout of the current window
+  /// @param[in] acc chunk to test
+  /// @return true, if the chunk can be processed as part of the current window
+  bool matchesWindow(const IConstDataAccessor &acc) const;
+
+  /// @brief add a chunk to all groups of the current window
+  /// @param[in] acc chunk to add
+  void process(const IConstDataAccessor &acc);
+
+private:
+  /// @brief rows of a window which are averaged the same way
+  struct BaselineGroup {
+    /// @brief time class, the averaging interval is maxInterval / 2^timeClass
+    casacore::uInt itsTimeClass;
+    /// @brief number of adjacent channels to average
+    casacore::uInt itsNChanAvg;
+    /// @brief rows of the input chunks belonging to this group
+    casacore::Vector<casacore::uInt> itsRows;
+    /// @brief index of the averaging interval within the window, negative if nothing is accumulated
+    int itsBin;
+    /// @brief accumulated data, a new accessor is created for every averaging interval
+    boost::shared_ptr<AveragedDataAccessor> itsAccessor;
+  };
+
+  /// @brief radius of the field of view in radians
+  double itsFieldRadius;
+
+  /// @brief maximum phase change across the averaged sample in radians
+  double itsMaxPhaseChange;
+
+  /// @brief maximum averaging interval
+  double itsMaxInterval;
+
+  /// @brief maximum number of adjacent channels to average
+  casacore::uInt itsMaxChanAvg;
+
+  /// @brief true, if a window is being accumulated
+  bool itsWindowActive;
+
+  /// @brief start time of the current window
+  double itsWindowStart;
+
+  /// @brief number of rows of the chunks in the current window
+  casacore::uInt itsWindowNRow;
+
+  /// @brief number of channels of the chunks in the current window
+  casacore::uInt itsWindowNChannel;
+
+  /// @brief number of polarisations of the chunks in the current window
+  casacore::uInt itsWindowNPol;
+
+  /// @brief first antenna IDs for the current window
+  casacore::Vector<casacore::uInt> itsWindowAntenna1;
+
+  /// @brief second antenna IDs for the current window
+  casacore::Vector<casacore::uInt> itsWindowAntenna2;
+
+  /// @brief first feed IDs for the current window
+  casacore::Vector<casacore::uInt> itsWindowFeed1;
+
+  /// @brief second feed IDs for the current window
+  casacore::Vector<casacore::uInt> itsWindowFeed2;
+
+  /// @brief groups of the current window indexed by time class and number of channels to average
+  std::map<std::pair<casacore::uInt, casacore::uInt>, BaselineGroup> itsGroups;
+
+  /// @brief averaged accessors ready to be delivered
+  std::deque<boost::shared_ptr<AveragedDataAccessor> > itsQueue;
+
+  /// @brief adapter giving out the averaged data with the right type
+  mutable DataAccessorAdapter itsOutputAdapter;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BDA_ITERATOR_ADAPTER_H
@@ -0,0 +1,224 @@
+/// @file
+/// @brief iterator adapter delivering the data in baseline-major order
+///
+/// @details This adapter is derived from DataIteratorAdapter. Table-based iterators go
+/// through the data in time order, while calibration solvers and flaggers often need all
+/// time samples of one baseline (or one antenna) together. Instead of a separate pass with
+/// a baseline selection for every baseline, this adapter reads a window of time-major chunks
+/// once, builds an index of rows for each baseline or antenna and gathers these rows into
+/// a single accessor per baseline or antenna.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+
+#include <askap/dataaccess/BaselineMajorIteratorAdapter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <map>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief setup with the given iterator
+/// @details
+/// @param[in] iter shared pointer to iterator to be wrapped
+/// @param[in] timeWindow duration of the window (in the units of the time axis of the iterator,
+/// i.e. seconds by default), non-positive value means the whole dataset
+/// @param[in] ordering how the rows are grouped together
+BaselineMajorIteratorAdapter::BaselineMajorIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter,
+           const double timeWindow, const Ordering ordering) : DataIteratorAdapter(iter), 
+           itsTimeWindow(timeWindow), itsOrdering(ordering), itsCurrent(0)
+{
+  ASKAPCHECK(iter, "An attempt to initialise BaselineMajorIteratorAdapter with empty shared pointer");
+  readWindow();
+}
+
+/// Restart the iteration from the beginning
+void BaselineMajorIteratorAdapter::init()
+{
+  itsOutputAdapter.detach();
+  roIterator().init();
+  readWindow();
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the gathered data of the current baseline or antenna
+IDataAccessor& BaselineMajorIteratorAdapter::operator*() const
+{
+  ASKAPCHECK(hasMore(), "No more gathered data available");
+  itsOutputAdapter.associate(itsOutput);
+  return itsOutputAdapter;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool BaselineMajorIteratorAdapter::hasMore() const throw()
+{
+  return itsCurrent < itsRowIndex.size();
+}
+
+/// advance the iterator one step further 
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool BaselineMajorIteratorAdapter::next()
+{
+  ASKAPCHECK(hasMore(), "There are no more gathered data available");
+  itsOutputAdapter.detach();
+  ++itsCurrent;
+  if (itsCurrent < itsRowIndex.size()) {
+      gatherCurrent();
+  } else {
+      readWindow();
+  }
+  return hasMore();
+}
+
+/// @brief number of chunks of the wrapped iterator in the current window
+/// @return number of chunks
+casacore::uInt BaselineMajorIteratorAdapter::nChunksGathered() const
+{
+  ASKAPCHECK(hasMore(), "No more gathered data available");
+  return casacore::uInt(itsChunks.size());
+}
+
+/// @brief time of each row of the current accessor
+/// @return vector with times (one per row)
+const casacore::Vector<casacore::Double>& BaselineMajorIteratorAdapter::rowTime() const
+{
+  ASKAPCHECK(hasMore(), "No more gathered data available");
+  return itsOutput.rowTime();
+}
+
+/// @brief read the next window of the wrapped iterator and build the row index
+/// @details The iterator is left at the first chunk which doesn't belong to the window.
+/// Windows without rows are skipped.
+void BaselineMajorIteratorAdapter::readWindow()
+{
+  IConstDataIterator &it = roIterator();
+  itsRowIndex.clear();
+  itsCurrent = 0;
+  while (itsRowIndex.empty() && it.hasMore()) {
+         size_t nChunks = 0;
+         double windowStart = 0.;
+         casacore::uInt nChannel = 0;
+         casacore::uInt nPol = 0;
+         for (; it.hasMore(); it.next()) {
+              const IConstDataAccessor &acc = *it;
+              const double curTime = acc.time();
+              if (nChunks == 0) {
+                  windowStart = curTime;
+                  nChannel = acc.nChannel();
+                  nPol = acc.nPol();
+              } else {
+                  ASKAPCHECK(curTime >= windowStart, 
+                      "Data appear to be not in time order, BaselineMajorIteratorAdapter can't handle this situation. Window start time = "<<
+                      windowStart<<", current time = "<<curTime);
+                  if (((itsTimeWindow > 0.) && (curTime - windowStart >= itsTimeWindow)) || 
+                      (acc.nChannel() != nChannel) || (acc.nPol() != nPol)) {
+                      break;
+                  }
+              }
+              // accessors of the previous window are reused to avoid reallocation
+              if (nChunks == itsChunks.size()) {
+                  itsChunks.push_back(boost::shared_ptr<GatheredDataAccessor>(new GatheredDataAccessor));
+              }
+              itsChunks[nChunks++]->assign(acc);
+         }
+         itsChunks.resize(nChunks);
+         buildIndex();
+  }
+  if (hasMore()) {
+      gatherCurrent();
+  }
+}
+
+/// @brief build the row index for the chunks of the current window
+void BaselineMajorIteratorAdapter::buildIndex()
+{
+  // key is the antenna and feed pair, for ordering by antenna only the first element is used
+  typedef std::pair<std::pair<casacore::uInt, casacore::uInt>, std::pair<casacore::uInt, casacore::uInt> > Key;
+  std::map<Key, std::vector<std::pair<casacore::uInt, casacore::uInt> > > rowsPerKey;
+  for (casacore::uInt chunk = 0; chunk < itsChunks.size(); ++chunk) {
+       const GatheredDataAccessor &acc = *itsChunks[chunk];
+       const casacore::Vector<casacore::uInt> &ant1 = acc.antenna1();
+       const casacore::Vector<casacore::uInt> &ant2 = acc.antenna2();
+       const casacore::Vector<casacore::uInt> &feed1 = acc.feed1();
+       const casacore::Vector<casacore::uInt> &feed2 = acc.feed2();
+       for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+            const std::pair<casacore::uInt, casacore::uInt> index(chunk, row);
+            if (itsOrdering == BY_BASELINE) {
+                rowsPerKey[Key(std::make_pair(ant1[row], ant2[row]), 
+                               std::make_pair(feed1[row], feed2[row]))].push_back(index);
+            } else {
+                rowsPerKey[Key(std::make_pair(ant1[row], 0u), std::make_pair(0u, 0u))].push_back(index);
+                if (ant2[row] != ant1[row]) {
+                    rowsPerKey[Key(std::make_pair(ant2[row], 0u), std::make_pair(0u, 0u))].push_back(index);
+                }
+            }
+       }
+  }
+  itsRowIndex.reserve(rowsPerKey.size());
+  for (std::map<Key, std::vector<std::pair<casacore::uInt, casacore::uInt> > >::iterator it = rowsPerKey.begin();
+       it != rowsPerKey.end(); ++it) {
+       itsRowIndex.push_back(std::vector<std::pair<casacore::uInt, casacore::uInt> >());
+       itsRowIndex.back().swap(it->second);
+  }
+}
+
+/// @brief gather the rows of the current baseline or antenna into the output accessor
+void BaselineMajorIteratorAdapter::gatherCurrent()
+{
+  ASKAPDEBUGASSERT(itsCurrent < itsRowIndex.size());
+  itsOutput.gather(itsChunks, itsRowIndex[itsCurrent]);
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+void BaselineMajorIteratorAdapter::chooseBuffer(const std::string &)
+{
+  ASKAPTHROW(DataAccessLogicError, "BaselineMajorIteratorAdapter doesn't support buffers");
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+void BaselineMajorIteratorAdapter::chooseOriginal()
+{
+  ASKAPTHROW(DataAccessLogicError, "BaselineMajorIteratorAdapter doesn't support buffers");
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+/// @return a reference to writable data accessor to the buffer requested
+IDataAccessor& BaselineMajorIteratorAdapter::buffer(const std::string &) const
+{
+  ASKAPTHROW(DataAccessLogicError, "BaselineMajorIteratorAdapter doesn't support buffers");
+}
+
+} // namespace accessors
+
+} // namespace askap
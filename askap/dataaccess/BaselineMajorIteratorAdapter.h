@@ -0,0 +1,169 @@
+/// @file
+/// @brief iterator adapter delivering the data in baseline-major order
+///
+/// @details This adapter is derived from DataIteratorAdapter. Table-based iterators go
+/// through the data in time order, while calibration solvers and flaggers often need all
+/// time samples of one baseline (or one antenna) together. Instead of a separate pass with
+/// a baseline selection for every baseline, this adapter reads a window of time-major chunks
+/// once, builds an index of rows for each baseline or antenna and gathers these rows into
+/// a single accessor per baseline or antenna.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+
+#ifndef ASKAP_ACCESSORS_BASELINE_MAJOR_ITERATOR_ADAPTER_H
+#define ASKAP_ACCESSORS_BASELINE_MAJOR_ITERATOR_ADAPTER_H
+
+#include <askap/dataaccess/DataIteratorAdapter.h>
+#include <askap/dataaccess/DataAccessorAdapter.h>
+#include <askap/dataaccess/GatheredDataAccessor.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <utility>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iterator adapter delivering the data in baseline-major order
+/// @details The wrapped iterator (which is assumed to be time-ordered) is read in windows 
+/// of the given duration. All chunks of the window are copied into memory, then the row index
+/// is built: the list of (chunk, row) pairs for each baseline (antenna and feed pair) or, 
+/// depending on the ordering, for each antenna (such a list contains all rows where the
+/// antenna is either the first or the second one). Every step of this adapter delivers
+/// one of these lists gathered into a single accessor, with rows in time order. The window
+/// is also closed when a chunk with a different number of channels or polarisations is 
+/// encountered. A non-positive window duration means that the whole dataset is read at once.
+///
+/// The delivered accessor has rows with different times, time() returns the time of the
+/// first row and the time of each row is available via rowTime. The data are read only and 
+/// buffers are not supported.
+/// @ingroup dataaccess_hlp
+class BaselineMajorIteratorAdapter : virtual public DataIteratorAdapter
+{
+public:
+  /// @brief how the rows are grouped together
+  enum Ordering {
+     /// one accessor per baseline (antenna and feed pair)
+     BY_BASELINE,
+     /// one accessor per antenna, rows are included if the antenna is either the first or the second
+     BY_ANTENNA
+  };
+
+  /// @brief setup with the given iterator
+  /// @details
+  /// @param[in] iter shared pointer to iterator to be wrapped
+  /// @param[in] timeWindow duration of the window (in the units of the time axis of the iterator,
+  /// i.e. seconds by default), non-positive value means the whole dataset
+  /// @param[in] ordering how the rows are grouped together
+  BaselineMajorIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter, 
+                               const double timeWindow, const Ordering ordering = BY_BASELINE);
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the gathered data of the current baseline or antenna
+  virtual IDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  /// @param[in] bufferID  the name of the buffer to choose
+  virtual void chooseBuffer(const std::string &bufferID);
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  virtual void chooseOriginal();
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  /// @param[in] bufferID the name of the buffer requested
+  /// @return a reference to writable data accessor to the buffer requested
+  virtual IDataAccessor& buffer(const std::string &bufferID) const;
+
+  /// @brief number of chunks of the wrapped iterator in the current window
+  /// @return number of chunks
+  casacore::uInt nChunksGathered() const;
+
+  /// @brief time of each row of the current accessor
+  /// @return vector with times (one per row)
+  const casacore::Vector<casacore::Double>& rowTime() const;
+
+protected:
+  /// @brief read the next window of the wrapped iterator and build the row index
+  /// @details The iterator is left at the first chunk which doesn't belong to the window.
+  /// Windows without rows are skipped.
+  void readWindow();
+
+  /// @brief build the row index for the chunks of the current window
+  void buildIndex();
+
+  /// @brief gather the rows of the current baseline or antenna into the output accessor
+  void gatherCurrent();
+
+private:
+  /// @brief duration of the window, non-positive value means the whole dataset
+  double itsTimeWindow;
+
+  /// @brief how the rows are grouped together
+  Ordering itsOrdering;
+
+  /// @brief chunks of the current window
+  std::vector<boost::shared_ptr<GatheredDataAccessor> > itsChunks;
+
+  /// @brief (chunk, row) pairs for each baseline or antenna of the current window
+  std::vector<std::vector<std::pair<casacore::uInt, casacore::uInt> > > itsRowIndex;
+
+  /// @brief index of the current baseline or antenna in itsRowIndex
+  size_t itsCurrent;
+
+  /// @brief gathered data of the current baseline or antenna
+  GatheredDataAccessor itsOutput;
+
+  /// @brief adapter giving out the gathered data with the right type
+  mutable DataAccessorAdapter itsOutputAdapter;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BASELINE_MAJOR_ITERATOR_ADAPTER_H
@@ -52,6 +52,7 @@ using namespace askap::accessors;
 BasicDataConverter::BasicDataConverter() :
      itsEpochConverter(new EpochConverter),
      itsDirectionConverter(new DirectionConverter),
+     itsDirectionFrame(casacore::MDirection::J2000),
      itsFrequencyConverter(new GenericConverter<casacore::MFrequency>(
                            casacore::MFrequency::Ref(casacore::MFrequency::LSRK),
 			   "GHz")),
@@ -92,6 +93,7 @@ void BasicDataConverter::setDirectionFrame(const casacore::MDirection::Ref &ref,
                const casacore::Unit &)
 {
   itsDirectionConverter.reset(new DirectionConverter(ref));
+  itsDirectionFrame = casacore::MDirection::castType(ref.getType());
 }
 
 /// set the reference frame for any frequency
@@ -155,6 +157,13 @@ bool BasicDataConverter::isVoid(const casacore::MFrequency::Ref &testRef,
   return itsFrequencyConverter->isVoid(testRef,testUnit);
 }
 
+/// @brief units of the output frequencies
+/// @return units set via setFrequencyFrame
+const casacore::Unit& BasicDataConverter::frequencyUnit() const
+{
+  return itsFrequencyConverter->targetUnit();
+}
+
 /// convert epochs
 /// @param in input epoch given as an MEpoch object
 /// @return epoch converted to Double 
@@ -179,6 +188,18 @@ casacore::MEpoch BasicDataConverter::epochMeasure(const casacore::MVEpoch &in) c
   return itsEpochConverter->toMeasure(in);
 }
 
+/// @brief convert a number of epochs given in the same frame
+/// @param[in] ref reference frame of the input values
+/// @param[in] unit units of the input values
+/// @param[in] in epochs to convert given as Doubles (w.r.t. MJD 0)
+/// @param[out] out converted epochs (resized as required)
+void BasicDataConverter::epochs(const casacore::MEpoch::Ref &ref, const casacore::Unit &unit,
+                      const casacore::Vector<casacore::Double> &in,
+                      casacore::Vector<casacore::Double> &out) const
+{
+  itsEpochConverter->convert(in, unit, ref, out);
+}
+
 /// convert directions
 /// @param in input direction given as an MDirection object
 /// @param out direction as an MVDirection object
@@ -188,6 +209,37 @@ void BasicDataConverter::direction(const casacore::MDirection &in,
   out=(*itsDirectionConverter)(in);
 }
 
+/// @brief convert a number of directions given in the same frame
+/// @param[in] ref reference frame of the input directions
+/// @param[in] in input directions
+/// @param[out] out output directions (resized as required)
+void BasicDataConverter::directions(const casacore::MDirection::Ref &ref,
+                      const casacore::Vector<casacore::MVDirection> &in,
+                      casacore::Vector<casacore::MVDirection> &out) const
+{
+  itsDirectionConverter->convert(in, ref, out);
+}
+
+/// @brief test whether the direction conversion depends on the observatory position
+/// @details Conversions to topocentric frames (e.g. AZEL or HADEC) depend on the
+/// position set via setMeasFrame, others depend only on time. 
+/// @return true, if the result of direction depends on the position
+bool BasicDataConverter::directionNeedsPosition() const
+{
+  switch (itsDirectionFrame) {
+     case casacore::MDirection::HADEC:
+     case casacore::MDirection::AZEL:
+     case casacore::MDirection::AZELSW:
+     case casacore::MDirection::AZELGEO:
+     case casacore::MDirection::AZELSWGEO:
+     case casacore::MDirection::ITRF:
+     case casacore::MDirection::TOPO:
+          return true;
+     default:
+          return false;
+  }
+}
+
 /// convert frequencies
 /// @param in input frequency given as an MFrequency object
 /// @return output frequency as a Double
@@ -196,6 +248,37 @@ casacore::Double BasicDataConverter::frequency(const casacore::MFrequency &in) c
   return (*itsFrequencyConverter)(in);
 }
 
+/// @brief convert a number of frequencies given in the same frame
+/// @details The frame conversion of frequencies is a Doppler shift, i.e. all 
+/// frequencies are scaled by the same factor. Therefore, only one frequency is 
+/// converted with the measures machinery and the resulting factor is applied to
+/// the whole vector. Only the unit conversion is done for each element.
+/// @param[in] ref reference frame of the input frequencies
+/// @param[in] unit units of the input frequencies
+/// @param[in] in input frequencies
+/// @param[out] out output frequencies as Doubles (resized to match the input)
+void BasicDataConverter::frequencies(const casacore::MFrequency::Ref &ref, const casacore::Unit &unit,
+                                     const casacore::Vector<casacore::Double> &in,
+                                     casacore::Vector<casacore::Double> &out) const
+{
+  ASKAPDEBUGASSERT(itsFrequencyConverter);
+  out.resize(in.nelements());
+  // the factor can't be obtained from zero frequency, use the first non-zero one
+  casacore::Double factor = 1.;
+  for (casacore::uInt elem = 0; elem < in.nelements(); ++elem) {
+       if (in[elem] != 0.) {
+           const casacore::MFrequency freq(casacore::MVFrequency(casacore::Quantity(in[elem], unit)), ref);
+           factor = itsFrequencyConverter->convertedValue(freq).getValue() / freq.getValue().getValue();
+           break;
+       }
+  }
+  const casacore::Unit &targetUnit = itsFrequencyConverter->targetUnit();
+  for (casacore::uInt elem = 0; elem < in.nelements(); ++elem) {
+       const casacore::MVFrequency freq(casacore::Quantity(in[elem], unit));
+       out[elem] = casacore::MVFrequency(freq.getValue() * factor).get(targetUnit).getValue();
+  }
+}
+
 /// convert velocities
 /// @param in input velocities given as an MRadialVelocity object
 /// @return out output velocity as a Double
@@ -163,23 +163,63 @@ public:
     /// @return epoch converted to Measure
     virtual casacore::MEpoch epochMeasure(const casacore::MVEpoch &in) const;
 
+    /// @brief convert a number of epochs given in the same frame
+    /// @param[in] ref reference frame of the input values
+    /// @param[in] unit units of the input values
+    /// @param[in] in epochs to convert given as Doubles (w.r.t. MJD 0)
+    /// @param[out] out converted epochs (resized as required)
+    virtual void epochs(const casacore::MEpoch::Ref &ref, const casacore::Unit &unit,
+                        const casacore::Vector<casacore::Double> &in,
+                        casacore::Vector<casacore::Double> &out) const;
+
     /// convert directions
     /// @param[in] in input direction given as an MDirection object
     /// @param[out] out output direction as an MVDirection object
     virtual void direction(const casacore::MDirection &in, 
                           casacore::MVDirection &out) const;
 
+    /// @brief convert a number of directions given in the same frame
+    /// @param[in] ref reference frame of the input directions
+    /// @param[in] in input directions
+    /// @param[out] out output directions (resized as required)
+    virtual void directions(const casacore::MDirection::Ref &ref,
+                           const casacore::Vector<casacore::MVDirection> &in,
+                           casacore::Vector<casacore::MVDirection> &out) const;
+
+    /// @brief test whether the direction conversion depends on the observatory position
+    /// @details Conversions to topocentric frames (e.g. AZEL or HADEC) depend on the
+    /// position set via setMeasFrame, others depend only on time. 
+    /// @return true, if the result of direction depends on the position
+    virtual bool directionNeedsPosition() const;
+
     /// test whether the frequency conversion is void
     /// @param[in] testRef reference frame to test
     /// @param[in] testUnit units to test
     virtual bool isVoid(const casacore::MFrequency::Ref &testRef,
                         const casacore::Unit &testUnit) const;
 
+    /// @brief units of the output frequencies
+    /// @return units set via setFrequencyFrame
+    virtual const casacore::Unit& frequencyUnit() const;
+
     /// convert frequencies
     /// @param[in] in input frequency given as an MFrequency object
     /// @return output frequency as a Double
     virtual casacore::Double frequency(const casacore::MFrequency &in) const;
 
+    /// @brief convert a number of frequencies given in the same frame
+    /// @details The frame conversion of frequencies is a Doppler shift, i.e. all 
+    /// frequencies are scaled by the same factor. Therefore, only one frequency is 
+    /// converted with the measures machinery and the resulting factor is applied to
+    /// the whole vector. Only the unit conversion is done for each element.
+    /// @param[in] ref reference frame of the input frequencies
+    /// @param[in] unit units of the input frequencies
+    /// @param[in] in input frequencies
+    /// @param[out] out output frequencies as Doubles (resized to match the input)
+    virtual void frequencies(const casacore::MFrequency::Ref &ref, const casacore::Unit &unit,
+                             const casacore::Vector<casacore::Double> &in,
+                             casacore::Vector<casacore::Double> &out) const;
+
     /// convert velocities
     /// @param[in] in input velocities given as an MRadialVelocity object
     /// @return output velocity as a Double
@@ -224,6 +264,8 @@ public:
 private:
     boost::shared_ptr<IEpochConverter>      itsEpochConverter;
     boost::shared_ptr<IDirectionConverter>  itsDirectionConverter;
+    /// @brief target frame of the direction conversion
+    casacore::MDirection::Types             itsDirectionFrame;
     boost::shared_ptr<GenericConverter<casacore::MFrequency> >
                                             itsFrequencyConverter;
     boost::shared_ptr<GenericConverter<casacore::MRadialVelocity> >
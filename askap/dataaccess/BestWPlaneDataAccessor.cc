@@ -43,6 +43,10 @@
 // just for now adding the logger so I can see what is going on
 #include <askap/askap/AskapLogging.h>
 
+// std includes
+#include <algorithm>
+#include <cmath>
+
 using namespace askap;
 using namespace askap::accessors;
 
@@ -124,9 +128,6 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
    // the current type is in the apparent frame (APP) and in geocentric.
  
    const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& originalUVW = acc.rotatedUVW(tangentPoint);
-   if (itsRotatedUVW.nelements() != originalUVW.nelements()) {
-       itsRotatedUVW.resize(originalUVW.nelements());
-   }
    
    // compute tolerance in metres to match units of originalUVW
    const casacore::Vector<double>& freq = acc.frequency();
@@ -140,10 +141,17 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
    double maxDeviation = 0.;
    
    if (itsPredictWPlane == false) {
-       maxDeviation = updatePlaneIfNecessary(originalUVW, tolInMetres);
+       // the deviation check and the plane subtraction are done in one pass, a new
+       // plane is only fitted (and subtracted) if the current one is not good enough
+       maxDeviation = subtractPlane(originalUVW, itsRotatedUVW);
+       if ((originalUVW.nelements() >= 2) && (maxDeviation >= tolInMetres)) {
+           maxDeviation = refitPlane(originalUVW, itsRotatedUVW, maxDeviation);
+       }
    }
    else {
        maxDeviation = updateAdvancedTimePlaneIfNecessary(tolInMetres, tangentPoint);
+       // the accessor's buffer has been used for other tangent points, get uvw's again
+       subtractPlane(acc.rotatedUVW(tangentPoint), itsRotatedUVW);
    }
    if (itsCheckResidual) {
        ASKAPCHECK(maxDeviation < tolInMetres, "The antenna layout is significantly non-coplanar. "
@@ -151,18 +159,31 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
               itsWTolerance<<" wavelengths equivalent to "<<tolInMetres<<" metres.");
    }
 
-    
-   for (casacore::uInt row=0; row<originalUVW.nelements(); ++row) {
-        const casacore::RigidVector<casacore::Double, 3> currentUVW = originalUVW[row];
-        itsRotatedUVW[row] = currentUVW;
-        // subtract the current plane
-        itsRotatedUVW[row](2) -= coeffA()*currentUVW(0) + coeffB()*currentUVW(1);
-   }
-   
-
    return itsRotatedUVW;
 }	         
 
+namespace {
+
+/// @brief largest deviation of w from the plane w=Au+Bv
+/// @details This is a plain pointer loop without branches, so the compiler
+/// can vectorise it
+/// @param[in] uvw pointer to the first uvw
+/// @param[in] nRow number of rows
+/// @param[in] coeffA coefficient A of the plane
+/// @param[in] coeffB coefficient B of the plane
+/// @return the largest deviation
+double planeDeviation(const casacore::RigidVector<casacore::Double, 3> *uvw, casacore::uInt nRow,
+                      double coeffA, double coeffB)
+{
+   double maxDeviation = 0.;
+   for (casacore::uInt row = 0; row < nRow; ++row, ++uvw) {
+        maxDeviation = std::max(maxDeviation, fabs(coeffA * (*uvw)(0) + coeffB * (*uvw)(1) - (*uvw)(2)));
+   }
+   return maxDeviation;
+}
+
+} // anonymous namespace
+
 /// @brief calculate the largest deviation from the current fitted plane
 /// @details This helper method iterates through the given uvw's and returns
 /// the largest deviation of the w-term from the current best fit plane.
@@ -170,21 +191,110 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
 /// @return the largest w-term deviation from the current plane (same units as uvw's)
 double BestWPlaneDataAccessor::maxWDeviation(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw) const
 {
-   double maxDeviation = 0.;
+   return maxWDeviation(uvw, coeffA(), coeffB());
+}
 
-   // we fit w=Au+Bv, the following lines compute the largest deviation from the current plane.
+/// @brief calculate the largest deviation from the given plane
+/// @details We fit w=Au+Bv, this method returns the largest deviation from the plane
+/// with the given coefficients.
+/// @param[in] uvw a vector with uvw's
+/// @param[in] coeffA coefficient A of the plane
+/// @param[in] coeffB coefficient B of the plane
+/// @return the largest w-term deviation from the given plane (same units as uvw's)
+double BestWPlaneDataAccessor::maxWDeviation(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                 double coeffA, double coeffB)
+{
+   if (uvw.contiguousStorage()) {
+       return planeDeviation(uvw.data(), uvw.nelements(), coeffA, coeffB);
+   }
+   const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > buf = uvw.copy();
+   return planeDeviation(buf.data(), buf.nelements(), coeffA, coeffB);
+}
 
-   for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-        const casacore::RigidVector<casacore::Double, 3> currentUVW = uvw[row];
-        const double deviation = fabs(coeffA()*currentUVW(0) + coeffB()*currentUVW(1) - currentUVW(2));
-        if (deviation > maxDeviation) {
-            maxDeviation = deviation;
-        }
+/// @brief subtract the current plane from w
+/// @details This method fills the output vector with uvw's where w is replaced
+/// by its deviation from the current plane, and finds the largest deviation in the same pass.
+/// @param[in] uvw a vector with uvw's
+/// @param[out] out a vector with uvw's after the plane subtraction (resized if necessary)
+/// @return the largest w-term deviation from the current plane (same units as uvw's)
+double BestWPlaneDataAccessor::subtractPlane(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                 casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& out) const
+{
+   if (out.nelements() != uvw.nelements()) {
+       out.resize(uvw.nelements());
+   }
+   const double a = coeffA();
+   const double b = coeffB();
+   double maxDeviation = 0.;
+   if (uvw.contiguousStorage() && out.contiguousStorage()) {
+       const casacore::RigidVector<casacore::Double, 3> *in = uvw.data();
+       casacore::RigidVector<casacore::Double, 3> *res = out.data();
+       for (casacore::uInt row = 0; row < uvw.nelements(); ++row, ++in, ++res) {
+            const double w = (*in)(2) - a * (*in)(0) - b * (*in)(1);
+            (*res)(0) = (*in)(0);
+            (*res)(1) = (*in)(1);
+            (*res)(2) = w;
+            maxDeviation = std::max(maxDeviation, fabs(w));
+       }
+   } else {
+       for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+            const casacore::RigidVector<casacore::Double, 3> currentUVW = uvw[row];
+            out[row] = currentUVW;
+            out[row](2) -= a * currentUVW(0) + b * currentUVW(1);
+            maxDeviation = std::max(maxDeviation, fabs(out[row](2)));
+       }
    }
-   
    return maxDeviation;
 }
 
+/// @brief least-squares fit of a plane
+/// @details We fit w=Au+Bv. The sums of the normal equations are accumulated in a
+/// single pass. The method is used to get a correction to the current plane
+/// (by passing uvw's with the current plane subtracted), so the previous fit
+/// serves as a starting point and the w values involved are small.
+/// @param[in] uvw a vector with uvw's
+/// @param[out] coeffA fitted coefficient A (unchanged if the fit is not possible)
+/// @param[out] coeffB fitted coefficient B (unchanged if the fit is not possible)
+/// @return true if the fit was successful, false if the problem is degenerate
+bool BestWPlaneDataAccessor::fitPlane(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                 double &coeffA, double &coeffB)
+{
+   // we fit w=Au+Bv, the following lines accumulate the necessary sums of the LSF problem
+   
+   double su2 = 0.; // sum of u-squared
+   double sv2 = 0.; // sum of v-squared
+   double suv = 0.; // sum of uv-products
+   double suw = 0.; // sum of uw-products
+   double svw = 0.; // sum of vw-products
+   
+   const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > buf = 
+          uvw.contiguousStorage() ? uvw : uvw.copy();
+   const casacore::RigidVector<casacore::Double, 3> *in = buf.data();
+   for (casacore::uInt row = 0; row < buf.nelements(); ++row, ++in) {
+        const double u = (*in)(0);
+        const double v = (*in)(1);
+        const double w = (*in)(2);
+        su2 += u * u;
+        sv2 += v * v;
+        suv += u * v;
+        suw += u * w;
+        svw += v * w;
+   }
+   
+   // we need a non-zero determinant for a successful fitting
+   // some tolerance has to be put on the determinant to avoid unconstrained fits
+   // we just accept the current fit results if the new fit is not possible
+   const double D = su2 * sv2 - casacore::square(suv);
+
+   if (fabs(D) < 1e-7) {
+       return false;
+   }
+
+   coeffA = (sv2 * suw - suv * svw) / D;
+   coeffB = (su2 * svw - suv * suw) / D;
+   return true;
+}
+
 /// @brief Fit a new plane assuming this is a continuous track and update coefficients if neccessary.
 /// @details A best fit plane for the current time can be found with UpdatePlaneIfNecessary ... which minimises the maxW now
 /// But this method instead minimises sometime in the future - so that we are currently at tolerance
@@ -202,8 +312,8 @@ double BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary(double toleran
    // we need the accessor becuase I want to spin the uvw's
    const IConstDataAccessor &acc = getROAccessor();
    
-
-   const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw = acc.rotatedUVW(tangentPoint);
+   // take a copy, as the buffer returned by the accessor is reused for other tangent points below
+   const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > uvw = acc.rotatedUVW(tangentPoint).copy();
    // these are local coefficients of planes - need these before we are sure which
    // plane we are going to use.
    double tmpCoeffA = 0.0;
@@ -220,54 +330,19 @@ double BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary(double toleran
        return AdvancedDeviation;
    }
     
-   // we are out of our tolerance range - get a new plane
-   // First thing we should do is use the existing update plane to get a plane that minimises W-deviation
-   // This fragment breaks the rules of code-reuse - but means I dont have to worry about the changemonitor picking this up
-   // we fit w=Au+Bv, the following lines accumulate the necessary sums of the LSF problem
-       
-   double su2 = 0.; // sum of u-squared
-   double sv2 = 0.; // sum of v-squared
-   double suv = 0.; // sum of uv-products
-   double suw = 0.; // sum of uw-products
-   double svw = 0.; // sum of vw-products
-       
-   for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-       const casacore::RigidVector<casacore::Double, 3> currentUVW = uvw[row];
-           
-       su2 += casacore::square(currentUVW(0));
-       sv2 += casacore::square(currentUVW(1));
-       suv += currentUVW(0) * currentUVW(1);
-       suw += currentUVW(0) * currentUVW(2);
-       svw += currentUVW(1) * currentUVW(2);
-   }
-       
-   // we need a non-zero determinant for a successful fitting
-   // some tolerance has to be put on the determinant to avoid unconstrained fits
-   // we just accept the current fit results if the new fit is not possible
-   double D = su2 * sv2 - casacore::square(suv);
-       
-   if (fabs(D) < 1e-7) {
+   // we are out of our tolerance range - get a new plane which minimises the current w-deviation
+   // The fit is done for the residuals w.r.t. the current plane, i.e. we find the correction
+   // to the coefficients. This is done with temporary coefficients, so the change monitor doesn't pick it up.
+   casacore::Vector<casacore::RigidVector<casacore::Double, 3> > residualUVW;
+   subtractPlane(uvw, residualUVW);
+   if (!fitPlane(residualUVW, tmpCoeffA, tmpCoeffB)) {
        ASKAPLOG_INFO_STR(logger, "BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary::Matrix has almost 0 determinant fit not likely to be valid");
        return AdvancedDeviation;
    }
+   tmpCoeffA += coeffA();
+   tmpCoeffB += coeffB();
        
-   // make an update to the coefficients
-   tmpCoeffA = (sv2 * suw - suv * svw) / D;
-   tmpCoeffB = (su2 * svw - suv * suw) / D;
-       
-       
-   // this fragment basically replicates the maxDeviation functionality
-     
-   AdvancedDeviation = 0.;
-       // we fit w=Au+Bv, the following lines compute the largest deviation from the current plane.
-       
-   for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-       const casacore::RigidVector<casacore::Double, 3> currentUVW = uvw[row];
-       const double deviation = fabs(tmpCoeffA*currentUVW(0) + tmpCoeffB*currentUVW(1) - currentUVW(2));
-       if (deviation > AdvancedDeviation) {
-           AdvancedDeviation = deviation;
-       }
-   }
+   AdvancedDeviation = maxWDeviation(uvw, tmpCoeffA, tmpCoeffB);
    if (AdvancedDeviation > tolerance) {
        ASKAPLOG_INFO_STR(logger, "BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary Current deviation (after next plane fit) " << AdvancedDeviation);
        return AdvancedDeviation; // we cannot get below tolerance at all - let alone in the future - the calling function will pick this up
@@ -288,18 +363,7 @@ double BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary(double toleran
        newTangentPoint.shiftLongitude(TimeShift*angle.getValue("rad"),true);
        TotalShift = TotalShift+TimeShift;
     
-       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& test_uvw = acc.rotatedUVW(newTangentPoint);
-           
-       AdvancedDeviation = 0.; //reset
-           // we fit w=Au+Bv, the following lines compute the largest deviation from the current plane.
-           
-       for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-           const casacore::RigidVector<casacore::Double, 3> currentUVW = test_uvw[row];
-           const double deviation = fabs(tmpCoeffA*currentUVW(0) + tmpCoeffB*currentUVW(1) - currentUVW(2));
-           if (deviation > AdvancedDeviation) {
-               AdvancedDeviation = deviation;
-           }
-       }
+       AdvancedDeviation = maxWDeviation(acc.rotatedUVW(newTangentPoint), tmpCoeffA, tmpCoeffB);
        if (verbose) {
           ASKAPLOG_INFO_STR(logger, "BestWPlaneDataAccessor::Current deviation (after  " << TotalShift << " seconds) " << AdvancedDeviation);
        }
@@ -308,42 +372,20 @@ double BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary(double toleran
    // Lets pull back one time step then evaluate the plane for then.
    double on_exit_deviation = 0.;
    do {
-       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& on_exit_uvw = acc.rotatedUVW(tangentPoint);
-       on_exit_deviation = maxWDeviation(on_exit_uvw);
+       on_exit_deviation = maxWDeviation(uvw);
     
        newTangentPoint.shiftLongitude(-1.0*TimeShift*angle.getValue("rad"),true);
-       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&advanced_uvw = acc.rotatedUVW(newTangentPoint);
-       
-     // we fit w=Au+Bv, the following lines accumulate the necessary sums of the LSF problem
-       
-       su2 = 0.; // sum of u-squared
-       sv2 = 0.; // sum of v-squared
-       suv = 0.; // sum of uv-products
-       suw = 0.; // sum of uw-products
-       svw = 0.; // sum of vw-products
-       
-       for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-           const casacore::RigidVector<casacore::Double, 3> currentUVW = advanced_uvw[row];
-           
-           su2 += casacore::square(currentUVW(0));
-           sv2 += casacore::square(currentUVW(1));
-           suv += currentUVW(0) * currentUVW(1);
-           suw += currentUVW(0) * currentUVW(2);
-           svw += currentUVW(1) * currentUVW(2);
-       }
-       
-       // we need a non-zero determinant for a successful fitting
-       // some tolerance has to be put on the determinant to avoid unconstrained fits
-       // we just accept the current fit results if the new fit is not possible
-       D = su2 * sv2 - casacore::square(suv);
-       
-       if (fabs(D) < 1e-7) {
+       // fit the correction to the current plane at the advanced time
+       subtractPlane(acc.rotatedUVW(newTangentPoint), residualUVW);
+       double deltaA = 0.;
+       double deltaB = 0.;
+       if (!fitPlane(residualUVW, deltaA, deltaB)) {
            return on_exit_deviation;
        }
        
        // make an update to the coefficients
-       itsCoeffA = (sv2 * suw - suv * svw) / D;
-       itsCoeffB = (su2 * svw - suv * suw) / D;
+       itsCoeffA += deltaA;
+       itsCoeffB += deltaB;
        itsPlaneChangeMonitor.notifyOfChanges();
    
    } while (on_exit_deviation > tolerance);
@@ -375,47 +417,36 @@ double BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary(double toleran
 double BestWPlaneDataAccessor::updatePlaneIfNecessary(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
                  double tolerance) const
 {
-
-   const double maxDeviation = maxWDeviation(uvw);
-    
-   // we need at least two rows for a successful fitting, don't bother doing anything if the
-   // number of rows is too small or the deviation is below the tolerance
+   casacore::Vector<casacore::RigidVector<casacore::Double, 3> > residualUVW;
+   const double maxDeviation = subtractPlane(uvw, residualUVW);
    if ((uvw.nelements() < 2) || (maxDeviation < tolerance)) {
        return maxDeviation;
    }
-   
-   // we fit w=Au+Bv, the following lines accumulate the necessary sums of the LSF problem
-   
-   double su2 = 0.; // sum of u-squared
-   double sv2 = 0.; // sum of v-squared
-   double suv = 0.; // sum of uv-products
-   double suw = 0.; // sum of uw-products
-   double svw = 0.; // sum of vw-products
-   
-   for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-        const casacore::RigidVector<casacore::Double, 3> currentUVW = uvw[row];
-
-        su2 += casacore::square(currentUVW(0));
-        sv2 += casacore::square(currentUVW(1));
-        suv += currentUVW(0) * currentUVW(1);
-        suw += currentUVW(0) * currentUVW(2);
-        svw += currentUVW(1) * currentUVW(2);                
-   }
-   
-   // we need a non-zero determinant for a successful fitting
-   // some tolerance has to be put on the determinant to avoid unconstrained fits
-   // we just accept the current fit results if the new fit is not possible
-   const double D = su2 * sv2 - casacore::square(suv);
+   return refitPlane(uvw, residualUVW, maxDeviation);
+}
 
-   if (fabs(D) < 1e-7) {
+/// @brief correct the current plane using residual w-terms
+/// @details This is the core of the plane update. The previous fit is the starting
+/// point: the correction to the coefficients is fitted into the residual w-terms
+/// (i.e. after the current plane has been subtracted). The residuals are recomputed 
+/// for the new plane.
+/// @param[in] uvw a vector with uvw's
+/// @param[in,out] residualUVW uvw's with the current plane subtracted, updated for the new plane
+/// @param[in] maxDeviation the largest deviation from the current plane
+/// @return the largest w-term deviation from the fitted plane (same units as uvw's)
+double BestWPlaneDataAccessor::refitPlane(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                 casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& residualUVW, double maxDeviation) const
+{
+   double deltaA = 0.;
+   double deltaB = 0.;
+   if (!fitPlane(residualUVW, deltaA, deltaB)) {
        return maxDeviation;
    }
 
    // make an update to the coefficients
-   itsCoeffA = (sv2 * suw - suv * svw) / D;
-   itsCoeffB = (su2 * svw - suv * suw) / D;
+   itsCoeffA += deltaA;
+   itsCoeffB += deltaB;
    itsPlaneChangeMonitor.notifyOfChanges();
   
-   return maxWDeviation(uvw);
+   return subtractPlane(uvw, residualUVW);
 }
-
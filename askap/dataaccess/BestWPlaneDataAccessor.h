@@ -166,6 +166,50 @@ protected:
    /// @param[in] uvw a vector with uvw's
    /// @return the largest w-term deviation from the current plane (same units as uvw's)
    double maxWDeviation(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw) const;
+
+   /// @brief calculate the largest deviation from the given plane
+   /// @details We fit w=Au+Bv, this method returns the largest deviation from the plane
+   /// with the given coefficients.
+   /// @param[in] uvw a vector with uvw's
+   /// @param[in] coeffA coefficient A of the plane
+   /// @param[in] coeffB coefficient B of the plane
+   /// @return the largest w-term deviation from the given plane (same units as uvw's)
+   static double maxWDeviation(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                               double coeffA, double coeffB);
+
+   /// @brief subtract the current plane from w
+   /// @details This method fills the output vector with uvw's where w is replaced
+   /// by its deviation from the current plane, and finds the largest deviation in the same pass.
+   /// @param[in] uvw a vector with uvw's
+   /// @param[out] out a vector with uvw's after the plane subtraction (resized if necessary)
+   /// @return the largest w-term deviation from the current plane (same units as uvw's)
+   double subtractPlane(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                        casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& out) const;
+
+   /// @brief least-squares fit of a plane
+   /// @details We fit w=Au+Bv. The sums of the normal equations are accumulated in a
+   /// single pass. The method is used to get a correction to the current plane
+   /// (by passing uvw's with the current plane subtracted), so the previous fit
+   /// serves as a starting point and the w values involved are small.
+   /// @param[in] uvw a vector with uvw's
+   /// @param[out] coeffA fitted coefficient A (unchanged if the fit is not possible)
+   /// @param[out] coeffB fitted coefficient B (unchanged if the fit is not possible)
+   /// @return true if the fit was successful, false if the problem is degenerate
+   static bool fitPlane(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                        double &coeffA, double &coeffB);
+
+   /// @brief correct the current plane using residual w-terms
+   /// @details This is the core of the plane update. The previous fit is the starting
+   /// point: the correction to the coefficients is fitted into the residual w-terms
+   /// (i.e. after the current plane has been subtracted). The residuals are recomputed 
+   /// for the new plane.
+   /// @param[in] uvw a vector with uvw's
+   /// @param[in,out] residualUVW uvw's with the current plane subtracted, updated for the new plane
+   /// @param[in] maxDeviation the largest deviation from the current plane
+   /// @return the largest w-term deviation from the fitted plane (same units as uvw's)
+   double refitPlane(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                     casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& residualUVW,
+                     double maxDeviation) const;
    
   
 private:
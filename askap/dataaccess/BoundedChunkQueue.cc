@@ -0,0 +1,123 @@
+/// @file
+/// @brief bounded queue of chunks passed between threads
+/// @details This class connects a producer (e.g. the thread receiving data from the
+/// network) and a consumer (the iterator) of chunks. The number of chunks held is
+/// limited, the producer waits if the queue is full (backpressure) and the consumer
+/// waits if it is empty.
+///
+/// @copyright (c) 2026 CSIRO
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/BoundedChunkQueue.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct an empty queue
+/// @param[in] capacity maximum number of chunks held
+BoundedChunkQueue::BoundedChunkQueue(size_t capacity) : itsCapacity(capacity), itsFinished(false),
+        itsClosed(false)
+{
+  ASKAPCHECK(capacity > 0, "Capacity of the chunk queue should be positive");
+}
+
+/// @brief add a chunk to the queue
+/// @details This method blocks while the queue is full
+/// @param[in] chunk chunk to add
+/// @return true if the chunk has been queued, false if the queue has been closed
+bool BoundedChunkQueue::push(const ChunkPtr &chunk)
+{
+  ASKAPDEBUGASSERT(chunk);
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  ASKAPCHECK(!itsFinished, "An attempt to add a chunk to the finished stream");
+  while (!itsClosed && (itsChunks.size() >= itsCapacity)) {
+         itsNotFull.wait(lock);
+  }
+  if (itsClosed) {
+      return false;
+  }
+  itsChunks.push_back(chunk);
+  itsNotEmpty.notify_one();
+  return true;
+}
+
+/// @brief take the next chunk from the queue
+/// @details This method blocks while the queue is empty and the stream is not finished.
+/// An exception is thrown if the producer finished the stream with an error.
+/// @return the next chunk, an empty pointer at the end of the stream
+BoundedChunkQueue::ChunkPtr BoundedChunkQueue::pop()
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  while (itsChunks.empty() && !itsFinished && !itsClosed) {
+         itsNotEmpty.wait(lock);
+  }
+  if (itsChunks.empty()) {
+      if (!itsError.empty()) {
+          ASKAPTHROW(DataAccessError, "Data stream has been terminated: "<<itsError);
+      }
+      return ChunkPtr();
+  }
+  const ChunkPtr result = itsChunks.front();
+  itsChunks.pop_front();
+  itsNotFull.notify_one();
+  return result;
+}
+
+/// @brief mark the end of the stream
+/// @details Chunks already in the queue are still delivered
+/// @param[in] error error message, empty string means normal end of the stream
+void BoundedChunkQueue::finish(const std::string &error)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsFinished = true;
+  itsError = error;
+  itsNotEmpty.notify_all();
+}
+
+/// @brief close the queue on the consumer side
+/// @details Queued chunks are dropped, subsequent calls to push return false
+void BoundedChunkQueue::close()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsClosed = true;
+  itsChunks.clear();
+  itsNotFull.notify_all();
+  itsNotEmpty.notify_all();
+}
+
+/// @brief number of chunks currently held
+/// @return number of chunks in the queue
+size_t BoundedChunkQueue::size() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsChunks.size();
+}
+
+} // namespace accessors
+
+} // namespace askap
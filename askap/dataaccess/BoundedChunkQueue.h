@@ -0,0 +1,128 @@
+/// @file
+/// @brief bounded queue of chunks passed between threads
+/// @details This class connects a producer (e.g. the thread receiving data from the
+/// network) and a consumer (the iterator) of chunks. The number of chunks held is
+/// limited, the producer waits if the queue is full (backpressure) and the consumer
+/// waits if it is empty.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_BOUNDED_CHUNK_QUEUE_H
+#define ASKAP_ACCESSORS_BOUNDED_CHUNK_QUEUE_H
+
+// std includes
+#include <deque>
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief bounded queue of chunks passed between threads
+/// @details There should be one producer and any number of consumers. The producer
+/// calls push for every chunk and finish at the end of the stream (optionally with an
+/// error message which is then reported to the consumer). The consumer can stop the
+/// stream early with close, the producer is unblocked and the queued chunks are dropped.
+/// All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class BoundedChunkQueue : private boost::noncopyable 
+{
+public:
+  /// @brief shared pointer to a chunk
+  typedef boost::shared_ptr<IConstDataAccessor const> ChunkPtr;
+
+  /// @brief construct an empty queue
+  /// @param[in] capacity maximum number of chunks held
+  explicit BoundedChunkQueue(size_t capacity);
+
+  /// @brief add a chunk to the queue
+  /// @details This method blocks while the queue is full
+  /// @param[in] chunk chunk to add
+  /// @return true if the chunk has been queued, false if the queue has been closed
+  bool push(const ChunkPtr &chunk);
+
+  /// @brief take the next chunk from the queue
+  /// @details This method blocks while the queue is empty and the stream is not finished.
+  /// An exception is thrown if the producer finished the stream with an error.
+  /// @return the next chunk, an empty pointer at the end of the stream
+  ChunkPtr pop();
+
+  /// @brief mark the end of the stream
+  /// @details Chunks already in the queue are still delivered
+  /// @param[in] error error message, empty string means normal end of the stream
+  void finish(const std::string &error = "");
+
+  /// @brief close the queue on the consumer side
+  /// @details Queued chunks are dropped, subsequent calls to push return false
+  void close();
+
+  /// @brief number of chunks currently held
+  /// @return number of chunks in the queue
+  size_t size() const;
+
+  /// @brief maximum number of chunks
+  /// @return capacity of the queue
+  inline size_t capacity() const { return itsCapacity; }
+
+private:
+  /// @brief maximum number of chunks
+  const size_t itsCapacity;
+
+  /// @brief queued chunks
+  std::deque<ChunkPtr> itsChunks;
+
+  /// @brief true if the producer has finished the stream
+  bool itsFinished;
+
+  /// @brief true if the consumer has closed the queue
+  bool itsClosed;
+
+  /// @brief error message given by the producer
+  std::string itsError;
+
+  /// @brief mutex protecting the state
+  mutable boost::mutex itsMutex;
+
+  /// @brief condition signalled when a chunk is added or the stream is finished
+  boost::condition_variable itsNotEmpty;
+
+  /// @brief condition signalled when a chunk is removed or the queue is closed
+  boost::condition_variable itsNotFull;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BOUNDED_CHUNK_QUEUE_H
@@ -0,0 +1,261 @@
+/// @file BufferCodec.h
+/// @brief Compact representations of the buffer cubes
+/// @details Scratch buffers (see IBufferManager) hold full precision 
+/// visibilities, which is often more than necessary (e.g. for model
+/// visibilities). This class converts a visibility cube into a shorter
+/// cube of the same type, which can be stored by any buffer manager,
+/// and back. Half precision floats halve the size and 8-bit quantisation 
+/// with a scale per block of values reduces it about four times.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/BufferCodec.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+// std includes
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief number of complex values sharing the same scale for QUANT8
+const casacore::uInt BufferCodec::theirBlockSize;
+
+/// @brief size of the payload in bytes
+/// @param[in] nElements number of complex values in the original cube
+/// @param[in] codec codec to use
+/// @return size of the encoded data excluding the header
+size_t BufferCodec::payloadSize(size_t nElements, Type codec)
+{
+  if (codec == FLOAT16) {
+      return 2 * nElements * sizeof(casacore::uShort);
+  }
+  ASKAPCHECK(codec == QUANT8, "Unknown buffer codec "<<int(codec));
+  const size_t nBlocks = (nElements + theirBlockSize - 1) / theirBlockSize;
+  return nBlocks * sizeof(float) + 2 * nElements * sizeof(signed char);
+}
+
+/// @brief encode the cube
+/// @details The output cube is resized as necessary. For NONE, the output
+/// is a copy of the input.
+/// @param[in] in cube to encode
+/// @param[in] codec codec to use
+/// @param[out] out encoded cube
+void BufferCodec::encode(const casacore::Cube<casacore::Complex> &in, Type codec,
+                         casacore::Cube<casacore::Complex> &out)
+{
+  if (codec == NONE) {
+      out.resize(in.shape());
+      out = in;
+      return;
+  }
+  // the shape is stored as floats in the header
+  const casacore::uInt maxDim = 1u << 24;
+  ASKAPCHECK((in.nrow() < maxDim) && (in.ncolumn() < maxDim) && (in.nplane() < maxDim),
+             "Buffer cube is too large to be encoded, shape = "<<in.shape());
+  const size_t nElements = in.nelements();
+  const size_t nPayload = (payloadSize(nElements, codec) + sizeof(casacore::Complex) - 1) /
+                          sizeof(casacore::Complex);
+  out.resize(2 + nPayload, 1, 1);
+
+  casacore::Bool deleteIn;
+  const casacore::Complex *inStorage = in.getStorage(deleteIn);
+  casacore::Bool deleteOut;
+  casacore::Complex *outStorage = out.getStorage(deleteOut);
+  outStorage[0] = casacore::Complex(float(in.nrow()), float(in.ncolumn()));
+  outStorage[1] = casacore::Complex(float(in.nplane()), float(codec));
+  char *payload = reinterpret_cast<char*>(outStorage + 2);
+  // padding of the last element shouldn't be left uninitialised
+  std::memset(payload, 0, nPayload * sizeof(casacore::Complex));
+
+  // complex values are treated as pairs of floats
+  const float *values = reinterpret_cast<const float*>(inStorage);
+  const size_t nValues = 2 * nElements;
+  if (codec == FLOAT16) {
+      casacore::uShort *halves = reinterpret_cast<casacore::uShort*>(payload);
+      for (size_t i = 0; i < nValues; ++i) {
+           halves[i] = floatToHalf(values[i]);
+      }
+  } else {
+      const size_t nBlocks = (nElements + theirBlockSize - 1) / theirBlockSize;
+      float *scales = reinterpret_cast<float*>(payload);
+      signed char *quantised = reinterpret_cast<signed char*>(payload + nBlocks * sizeof(float));
+      for (size_t block = 0; block < nBlocks; ++block) {
+           const size_t start = block * 2 * theirBlockSize;
+           const size_t end = std::min(nValues, start + 2 * theirBlockSize);
+           float maxAbs = 0.;
+           for (size_t i = start; i < end; ++i) {
+                maxAbs = std::max(maxAbs, std::abs(values[i]));
+           }
+           const float factor = maxAbs > 0. ? 127. / maxAbs : 0.;
+           for (size_t i = start; i < end; ++i) {
+                quantised[i] = static_cast<signed char>(lrintf(values[i] * factor));
+           }
+           scales[block] = maxAbs / 127.;
+      }
+  }
+  in.freeStorage(inStorage, deleteIn);
+  out.putStorage(outStorage, deleteOut);
+}
+
+/// @brief decode the cube
+/// @details The output cube is resized as necessary. An exception is thrown
+/// if the input is not a valid encoded cube.
+/// @param[in] in encoded cube
+/// @param[in] codec codec used to encode the data
+/// @param[out] out decoded cube
+void BufferCodec::decode(const casacore::Cube<casacore::Complex> &in, Type codec,
+                         casacore::Cube<casacore::Complex> &out)
+{
+  if (codec == NONE) {
+      out.resize(in.shape());
+      out = in;
+      return;
+  }
+  if ((in.nelements() < 2) || (in.ncolumn() != 1) || (in.nplane() != 1)) {
+      ASKAPTHROW(DataAccessError, "Buffer cube of shape "<<in.shape()<<" is not encoded");
+  }
+  casacore::Bool deleteIn;
+  const casacore::Complex *inStorage = in.getStorage(deleteIn);
+  const casacore::uInt nRow = casacore::uInt(inStorage[0].real());
+  const casacore::uInt nChan = casacore::uInt(inStorage[0].imag());
+  const casacore::uInt nPol = casacore::uInt(inStorage[1].real());
+  const int storedCodec = int(inStorage[1].imag());
+  const size_t nElements = size_t(nRow) * nChan * nPol;
+  const size_t nPayload = (payloadSize(nElements, codec) + sizeof(casacore::Complex) - 1) /
+                          sizeof(casacore::Complex);
+  if ((storedCodec != int(codec)) || (in.nelements() != 2 + nPayload)) {
+      in.freeStorage(inStorage, deleteIn);
+      ASKAPTHROW(DataAccessError, "Buffer cube has not been encoded with codec "<<int(codec));
+  }
+  out.resize(nRow, nChan, nPol);
+  casacore::Bool deleteOut;
+  casacore::Complex *outStorage = out.getStorage(deleteOut);
+  const char *payload = reinterpret_cast<const char*>(inStorage + 2);
+
+  float *values = reinterpret_cast<float*>(outStorage);
+  const size_t nValues = 2 * nElements;
+  if (codec == FLOAT16) {
+      const casacore::uShort *halves = reinterpret_cast<const casacore::uShort*>(payload);
+      for (size_t i = 0; i < nValues; ++i) {
+           values[i] = halfToFloat(halves[i]);
+      }
+  } else {
+      const size_t nBlocks = (nElements + theirBlockSize - 1) / theirBlockSize;
+      const float *scales = reinterpret_cast<const float*>(payload);
+      const signed char *quantised = reinterpret_cast<const signed char*>(payload + 
+                                     nBlocks * sizeof(float));
+      for (size_t block = 0; block < nBlocks; ++block) {
+           const size_t start = block * 2 * theirBlockSize;
+           const size_t end = std::min(nValues, start + 2 * theirBlockSize);
+           const float scale = scales[block];
+           for (size_t i = start; i < end; ++i) {
+                values[i] = float(quantised[i]) * scale;
+           }
+      }
+  }
+  in.freeStorage(inStorage, deleteIn);
+  out.putStorage(outStorage, deleteOut);
+}
+
+/// @brief convert a float into half precision
+/// @details Rounding is to the nearest even value
+/// @param[in] value value to convert
+/// @return bit pattern of the half precision value
+casacore::uShort BufferCodec::floatToHalf(float value)
+{
+  casacore::uInt bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const casacore::uInt sign = (bits >> 16) & 0x8000u;
+  const casacore::uInt floatExponent = (bits >> 23) & 0xffu;
+  casacore::uInt mantissa = bits & 0x7fffffu;
+  if (floatExponent == 0xffu) {
+      // infinity or NaN (keep it NaN)
+      return casacore::uShort(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+  }
+  const int exponent = int(floatExponent) - 127 + 15;
+  if (exponent >= 31) {
+      // overflow
+      return casacore::uShort(sign | 0x7c00u);
+  }
+  if (exponent <= 0) {
+      // subnormal half or zero
+      if (exponent < -10) {
+          return casacore::uShort(sign);
+      }
+      mantissa |= 0x800000u;
+      const casacore::uInt shift = casacore::uInt(14 - exponent);
+      casacore::uInt half = mantissa >> shift;
+      const casacore::uInt remainder = mantissa & ((1u << shift) - 1u);
+      const casacore::uInt halfway = 1u << (shift - 1);
+      if ((remainder > halfway) || ((remainder == halfway) && (half & 1u))) {
+          ++half;
+      }
+      return casacore::uShort(sign | half);
+  }
+  casacore::uInt half = sign | (casacore::uInt(exponent) << 10) | (mantissa >> 13);
+  const casacore::uInt remainder = mantissa & 0x1fffu;
+  // carry into the exponent gives the correct result, including the overflow to infinity
+  if ((remainder > 0x1000u) || ((remainder == 0x1000u) && (half & 1u))) {
+      ++half;
+  }
+  return casacore::uShort(half);
+}
+
+/// @brief convert a half precision value into float
+/// @param[in] half bit pattern of the half precision value
+/// @return value as float
+float BufferCodec::halfToFloat(casacore::uShort half)
+{
+  const casacore::uInt sign = casacore::uInt(half & 0x8000u) << 16;
+  const casacore::uInt exponent = (half >> 10) & 0x1fu;
+  casacore::uInt mantissa = half & 0x3ffu;
+  casacore::uInt bits;
+  if (exponent == 0) {
+      if (mantissa == 0) {
+          bits = sign;
+      } else {
+          // subnormal half, normalise
+          int normExponent = 1;
+          while (!(mantissa & 0x400u)) {
+                 mantissa <<= 1;
+                 --normExponent;
+          }
+          mantissa &= 0x3ffu;
+          bits = sign | (casacore::uInt(normExponent + 127 - 15) << 23) | (mantissa << 13);
+      }
+  } else if (exponent == 0x1fu) {
+      bits = sign | 0x7f800000u | (mantissa << 13);
+  } else {
+      bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  }
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
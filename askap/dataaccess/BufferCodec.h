@@ -0,0 +1,114 @@
+/// @file BufferCodec.h
+/// @brief Compact representations of the buffer cubes
+/// @details Scratch buffers (see IBufferManager) hold full precision 
+/// visibilities, which is often more than necessary (e.g. for model
+/// visibilities). This class converts a visibility cube into a shorter
+/// cube of the same type, which can be stored by any buffer manager,
+/// and back. Half precision floats halve the size and 8-bit quantisation 
+/// with a scale per block of values reduces it about four times.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_BUFFER_CODEC_H
+#define ASKAP_ACCESSORS_BUFFER_CODEC_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Compact representations of the buffer cubes
+/// @details The encoded cube has the shape (2 + nPayload) x 1 x 1. The first two
+/// elements hold the shape of the original cube and the codec used, so the data
+/// can be decoded without any other information. The payload is the raw data 
+/// packed into the storage of complex elements. The encoding and decoding loops
+/// work on contiguous arrays of floats and don't have branches in the inner loops,
+/// so they can be vectorised by the compiler.
+/// @ingroup dataaccess_hlp
+class BufferCodec {
+public:
+  /// @brief available codecs
+  enum Type {
+     /// no compression, the cube is stored as is
+     NONE = 0,
+     /// IEEE half precision floats, the relative error is below 2^-11 for 
+     /// values between 6e-5 and 65504 (larger values become infinite)
+     FLOAT16 = 1,
+     /// 8-bit integers with a scale per block of theirBlockSize complex values,
+     /// the error of each real and imaginary part is below max(|x|)/254, where 
+     /// the maximum is taken over the block (values should be finite)
+     QUANT8 = 2
+  };
+
+  /// @brief number of complex values sharing the same scale for QUANT8
+  static const casacore::uInt theirBlockSize = 256;
+
+  /// @brief encode the cube
+  /// @details The output cube is resized as necessary. For NONE, the output
+  /// is a copy of the input.
+  /// @param[in] in cube to encode
+  /// @param[in] codec codec to use
+  /// @param[out] out encoded cube
+  static void encode(const casacore::Cube<casacore::Complex> &in, Type codec,
+                     casacore::Cube<casacore::Complex> &out);
+
+  /// @brief decode the cube
+  /// @details The output cube is resized as necessary. An exception is thrown
+  /// if the input is not a valid encoded cube.
+  /// @param[in] in encoded cube
+  /// @param[in] codec codec used to encode the data
+  /// @param[out] out decoded cube
+  static void decode(const casacore::Cube<casacore::Complex> &in, Type codec,
+                     casacore::Cube<casacore::Complex> &out);
+
+  /// @brief convert a float into half precision
+  /// @details Rounding is to the nearest even value
+  /// @param[in] value value to convert
+  /// @return bit pattern of the half precision value
+  static casacore::uShort floatToHalf(float value);
+
+  /// @brief convert a half precision value into float
+  /// @param[in] half bit pattern of the half precision value
+  /// @return value as float
+  static float halfToFloat(casacore::uShort half);
+
+protected:
+  /// @brief size of the payload in bytes
+  /// @param[in] nElements number of complex values in the original cube
+  /// @param[in] codec codec to use
+  /// @return size of the encoded data excluding the header
+  static size_t payloadSize(size_t nElements, Type codec);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BUFFER_CODEC_H
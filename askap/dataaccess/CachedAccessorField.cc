@@ -0,0 +1,31 @@
+/// @file
+/// @brief a single cached field of the data accessor 
+///
+/// @details TableConstDataAccessor manages a number of cached fields.
+/// This class represents a single such field. This file contains the
+/// non-template code shared by all fields.
+///
+/// @copyright (c) 2026 ASKAP, All Rights Reserved.
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/CachedAccessorField.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief counter of memory held by the cached fields of all accessors
+/// @details The counter is created on the first call and registered with MemoryGovernor.
+/// Fields are too numerous to be registered individually, so they only report their usage.
+/// @return reference to the counter
+MemoryGovernor::Counter& cachedAccessorFieldMemory()
+{
+  // the counter is never destroyed, as fields of static objects may outlive it
+  static MemoryGovernor::Counter *counter = new MemoryGovernor::Counter("accessor buffers");
+  return *counter;
+}
+
+} // namespace accessors
+
+} // namespace askap
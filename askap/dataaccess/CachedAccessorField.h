@@ -12,16 +12,34 @@
 #define ASKAP_ACCESSORS_CACHED_ACCESSOR_FIELD_H
 
 #include <askap/askap/AskapError.h>
+#include <askap/dataaccess/IteratorStatistics.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
 
 // boost includes
 #ifdef _OPENMP
 #include <boost/thread/shared_mutex.hpp>
 #endif
 
+// std includes
+#ifdef _OPENMP
+#include <atomic>
+#endif
+
 namespace askap {
 
 namespace accessors {
 
+/// @brief counter of memory held by the cached fields of all accessors
+/// @details The counter is created on the first call and registered with MemoryGovernor.
+/// Fields are too numerous to be registered individually, so they only report their usage.
+/// @return reference to the counter
+MemoryGovernor::Counter& cachedAccessorFieldMemory();
+
 /// @brief a single cached field of the data accessor 
 ///
 /// @details TableConstDataAccessor manages a number of cached fields.
@@ -32,7 +50,10 @@ namespace accessors {
 template<typename T>
 struct CachedAccessorField  {
   /// @brief initialize the class, set the flag that reading is required
-  CachedAccessorField() : itsChangedFlag(true), itsFlushFlag(false) {}
+  CachedAccessorField() : itsChangedFlag(true), itsFlushFlag(false), itsStatistics(0), itsBytes(0) {}
+
+  /// @brief destructor, updates the memory counter
+  ~CachedAccessorField();
   
   /// @brief copy constructor
   /// @param[in] other an object to copy from
@@ -41,7 +62,8 @@ struct CachedAccessorField  {
   CachedAccessorField(const CachedAccessorField<T> &other);
 #else
   CachedAccessorField(const CachedAccessorField<T> &other) : itsChangedFlag(other.itsChangedFlag),
-        itsFlushFlag(other.itsFlushFlag), itsValue(other.itsValue) {}
+        itsFlushFlag(other.itsFlushFlag), itsValue(other.itsValue), 
+        itsStatistics(other.itsStatistics), itsBytes(0) {}
 #endif
         
   /// @brief assignment operator
@@ -107,7 +129,9 @@ struct CachedAccessorField  {
   inline T& rwValue() const;
      
   /// @brief invalidate the field
-  void inline invalidate() const throw();
+  /// @details This method takes the lock in the parallel build (it waits for a fill in
+  /// progress), therefore it may throw if the lock can't be obtained.
+  void inline invalidate() const;
 
   /// @brief test validity
   /// @details To avoid unnecessary checks/duplicated invalidation of the field
@@ -125,21 +149,49 @@ struct CachedAccessorField  {
   
   /// @brief notify that this field had been synchronised
   void inline flushed() const throw() { itsFlushFlag = false; }
+
+  /// @brief attach statistics
+  /// @details If attached, reads on demand and accesses served from the cache
+  /// are counted by the methods taking a reader.
+  /// @param[in] stats statistics to update (zero to detach)
+  void inline setStatistics(IteratorStatistics *stats) const throw() { itsStatistics = stats; }
 protected:
   /// @brief helper method to check if the cache needs an update
   /// @details This method has been introduced to provide better encapsulation of
   /// the synchronisation code if thread safety is required
   /// @return true, if the cache needs update
   bool isChanged() const;
+
+  /// @brief helper method to update the statistics
+  /// @param[in] filled true, if the field has been read on demand
+  void inline countAccess(bool filled) const;
+
+  /// @brief helper method to update the memory counter after the field has been filled
+  void inline countMemory() const;
 private:
   /// @brief true, if the field needs reading
+  /// @details With OpenMP, the flag is atomic and is cleared (with release semantics) only
+  /// after the value has been filled. Threads which see the flag cleared can use the value
+  /// without locking the mutex, which is only taken for the read on demand.
+#ifdef _OPENMP
+  mutable std::atomic<bool> itsChangedFlag;
+#else
   mutable bool itsChangedFlag;
+#endif
   
   /// @brief true, if there was a write operation
   mutable bool itsFlushFlag;
 
   /// @brief cached buffer
   mutable T itsValue;
+
+  /// @brief statistics to update, zero if not attached
+  /// @details The statistics are not owned by this class
+  mutable IteratorStatistics *itsStatistics;
+
+  /// @brief memory held by the buffer as added to the counter
+  /// @details Arrays copied from another field share the storage, they are not counted
+  mutable size_t itsBytes;
   
 #ifdef _OPENMP
   /// @brief mutex for synchronisation
@@ -18,23 +18,66 @@ namespace askap {
 
 namespace accessors {
 
+/// @brief memory held by a cached value
+/// @details Only the storage of arrays is counted, other types are assumed to be small
+/// @return number of bytes
+template<typename T>
+inline size_t cachedFieldBytes(const T &) { return 0; }
+
+/// @brief memory held by a cached array
+/// @param[in] arr the array
+/// @return number of bytes
+template<typename T>
+inline size_t cachedFieldBytes(const casacore::Array<T> &arr) { return arr.nelements() * sizeof(T); }
+
+/// @brief memory held by a cached vector
+/// @param[in] arr the vector
+/// @return number of bytes
+template<typename T>
+inline size_t cachedFieldBytes(const casacore::Vector<T> &arr) { return arr.nelements() * sizeof(T); }
+
+/// @brief memory held by a cached matrix
+/// @param[in] arr the matrix
+/// @return number of bytes
+template<typename T>
+inline size_t cachedFieldBytes(const casacore::Matrix<T> &arr) { return arr.nelements() * sizeof(T); }
+
+/// @brief memory held by a cached cube
+/// @param[in] arr the cube
+/// @return number of bytes
+template<typename T>
+inline size_t cachedFieldBytes(const casacore::Cube<T> &arr) { return arr.nelements() * sizeof(T); }
+
+/// @brief destructor, updates the memory counter
+template<class T>
+CachedAccessorField<T>::~CachedAccessorField()
+{
+  if (itsBytes > 0) {
+      cachedAccessorFieldMemory().subtract(itsBytes);
+  }
+}
+
 template<class T> template<typename Reader>
 const T& CachedAccessorField<T>::value(const Reader &reader, 
                         void (Reader::*func)(T&) const)  const
 { 
 #ifdef _OPENMP
-  boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
-  if (itsChangedFlag) {
-      boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
+  // the flag is cleared only after the value has been filled, so a hit doesn't need the mutex
+  if (!itsChangedFlag.load(std::memory_order_acquire)) {
+      countAccess(false);
+      return itsValue;
+  }
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
 #endif
-      if (itsChangedFlag) {
-          ASKAPCHECK(!itsFlushFlag, "An attempt to do read on-demand when the cache needs flush, this is most likely a logical error");     
-	      (reader.*func)(itsValue);
-	      itsChangedFlag=false;
-	  }
-#ifdef _OPENMP
+  bool filled = false;
+  if (itsChangedFlag) {
+      ASKAPCHECK(!itsFlushFlag, "An attempt to do read on-demand when the cache needs flush, this is most likely a logical error");     
+      (reader.*func)(itsValue);
+      countMemory();
+      itsChangedFlag=false;
+      filled = true;
   }
-#endif  
+  countAccess(filled);
   return itsValue;
 }
 
@@ -43,18 +86,22 @@ template<class T> template<typename Reader>
 const T& CachedAccessorField<T>::value(Reader reader) const
 { 
 #ifdef _OPENMP
-  boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
-  if (itsChangedFlag) {
-      boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
-#endif
-      if (itsChangedFlag) {
-          ASKAPCHECK(!itsFlushFlag, "An attempt to do read on-demand when the cache needs flush, this is most likely a logical error");     
-  	      reader(itsValue);
-	      itsChangedFlag=false;
-	  }
-#ifdef _OPENMP
+  // the flag is cleared only after the value has been filled, so a hit doesn't need the mutex
+  if (!itsChangedFlag.load(std::memory_order_acquire)) {
+      countAccess(false);
+      return itsValue;
   }
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
 #endif
+  bool filled = false;
+  if (itsChangedFlag) {
+      ASKAPCHECK(!itsFlushFlag, "An attempt to do read on-demand when the cache needs flush, this is most likely a logical error");     
+      reader(itsValue);
+      countMemory();
+      itsChangedFlag=false;
+      filled = true;
+  }
+  countAccess(filled);
   return itsValue;
 }
 
@@ -111,9 +158,37 @@ template<class T>
 inline bool CachedAccessorField<T>::isChanged() const
 {
 #ifdef _OPENMP
-  boost::shared_lock<boost::shared_mutex> lock(itsMutex);
-#endif
+  return itsChangedFlag.load(std::memory_order_acquire);
+#else
   return itsChangedFlag;
+#endif
+}
+
+/// @brief helper method to update the statistics
+/// @param[in] filled true, if the field has been read on demand
+template<class T>
+inline void CachedAccessorField<T>::countAccess(bool filled) const
+{
+  if (itsStatistics != 0) {
+      if (filled) {
+          itsStatistics->cacheFill();
+      } else {
+          itsStatistics->cacheHit();
+      }
+  }
+}
+
+/// @brief helper method to update the memory counter after the field has been filled
+template<class T>
+inline void CachedAccessorField<T>::countMemory() const
+{
+  const size_t bytes = cachedFieldBytes(itsValue);
+  if (bytes != itsBytes) {
+      MemoryGovernor::Counter &counter = cachedAccessorFieldMemory();
+      counter.add(bytes);
+      counter.subtract(itsBytes);
+      itsBytes = bytes;
+  }
 }
 
 #ifdef _OPENMP
@@ -122,10 +197,10 @@ inline bool CachedAccessorField<T>::isChanged() const
 /// @note reference semantics for casa arrays, but we're not copying this class where T is a casa array type. 
 template<class T>
 CachedAccessorField<T>::CachedAccessorField(const CachedAccessorField<T> &other) : itsChangedFlag(true),
-        itsFlushFlag(false) 
+        itsFlushFlag(false), itsStatistics(other.itsStatistics), itsBytes(0) 
 {
   boost::shared_lock<boost::shared_mutex> readLock(other.itsMutex);
-  itsChangedFlag = other.itsChangedFlag;
+  itsChangedFlag = other.itsChangedFlag.load();
   itsFlushFlag = other.itsFlushFlag;
   itsValue = other.itsValue;
 }
@@ -142,19 +217,23 @@ CachedAccessorField<T>& CachedAccessorField<T>::operator=(const CachedAccessorFi
 #ifdef _OPENMP
       boost::shared_lock<boost::shared_mutex> readLock(other.itsMutex);
       boost::unique_lock<boost::shared_mutex> lock(itsMutex);
-#endif
-      
+      itsValue = other.itsValue;
+      itsChangedFlag = other.itsChangedFlag.load();
+#else
+      itsValue = other.itsValue;
       itsChangedFlag = other.itsChangedFlag;
+#endif
       itsFlushFlag = other.itsFlushFlag;
-      itsValue = other.itsValue;
-      // deliberately don't copy mutex as it is object-specific     
+      // the assignment copies the data, so this field holds its own storage
+      countMemory();
+      // deliberately don't copy mutex and statistics as they are object-specific     
   }
   return *this;
 }
 
 /// @brief invalidate the field
 template<class T>
-inline void CachedAccessorField<T>::invalidate() const throw()
+inline void CachedAccessorField<T>::invalidate() const
 { 
 #ifdef _OPENMP
   boost::unique_lock<boost::shared_mutex> lock(itsMutex);
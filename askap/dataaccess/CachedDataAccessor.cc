@@ -0,0 +1,437 @@
+/// @file
+/// @brief an accessor holding a copy of all data of another accessor
+/// @details This class is used by CachingDataIterator to keep chunks of data
+/// in memory between passes over the same dataset. All fields of the
+/// original accessor (except velocity, which is not implemented by the
+/// table-based accessor) are copied on construction. Rotated uvws and delays
+/// are computed on demand from the copied uvws and pointing directions.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/CachedDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// LOFAR includes
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief write a vector of a basic type
+/// @param[in] os output blob stream
+/// @param[in] vec vector to write
+template<typename T>
+void putVector(LOFAR::BlobOStream &os, const casacore::Vector<T> &vec)
+{
+  os << static_cast<LOFAR::uint64>(vec.nelements());
+  const casacore::Vector<T> contVec = vec.contiguousStorage() ? vec : casacore::Vector<T>(vec.copy());
+  os.put(contVec.data(), contVec.nelements());
+}
+
+/// @brief read a vector of a basic type
+/// @param[in] is input blob stream
+/// @param[out] vec vector to fill (resized as necessary)
+template<typename T>
+void getVector(LOFAR::BlobIStream &is, casacore::Vector<T> &vec)
+{
+  LOFAR::uint64 size = 0;
+  is >> size;
+  vec.resize(size);
+  is.get(vec.data(), size);
+}
+
+/// @brief write a vector of directions
+/// @param[in] os output blob stream
+/// @param[in] vec vector to write
+void putDirections(LOFAR::BlobOStream &os, const casacore::Vector<casacore::MVDirection> &vec)
+{
+  os << static_cast<LOFAR::uint64>(vec.nelements());
+  for (casacore::uInt index = 0; index < vec.nelements(); ++index) {
+       const casacore::Vector<casacore::Double> &cosines = vec[index].getValue();
+       ASKAPDEBUGASSERT(cosines.nelements() == 3);
+       os << cosines[0] << cosines[1] << cosines[2];
+  }
+}
+
+/// @brief read a vector of directions
+/// @param[in] is input blob stream
+/// @param[out] vec vector to fill (resized as necessary)
+void getDirections(LOFAR::BlobIStream &is, casacore::Vector<casacore::MVDirection> &vec)
+{
+  LOFAR::uint64 size = 0;
+  is >> size;
+  vec.resize(size);
+  for (casacore::uInt index = 0; index < vec.nelements(); ++index) {
+       casacore::Double x, y, z;
+       is >> x >> y >> z;
+       vec[index] = casacore::MVDirection(x, y, z);
+  }
+}
+
+/// @brief write a complex cube
+/// @param[in] os output blob stream
+/// @param[in] cube cube to write
+void putCube(LOFAR::BlobOStream &os, const casacore::Cube<casacore::Complex> &cube)
+{
+  const casacore::Cube<casacore::Complex> contCube = cube.contiguousStorage() ? cube : 
+                                                     casacore::Cube<casacore::Complex>(cube.copy());
+  // std::complex is guaranteed to be laid out as two adjacent floats
+  os.put(reinterpret_cast<const float*>(contCube.data()), 2 * contCube.nelements());
+}
+
+/// @brief read a complex cube
+/// @param[in] is input blob stream
+/// @param[in] shape shape of the cube
+/// @param[out] cube cube to fill (resized as necessary)
+void getCube(LOFAR::BlobIStream &is, const casacore::IPosition &shape, casacore::Cube<casacore::Complex> &cube)
+{
+  cube.resize(shape);
+  is.get(reinterpret_cast<float*>(cube.data()), 2 * cube.nelements());
+}
+
+} // anonymous namespace
+
+/// @brief construct the accessor by copying all data
+/// @param[in] acc accessor to copy
+/// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+/// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
+/// to initialisation of a new UVW Machine
+CachedDataAccessor::CachedDataAccessor(const IConstDataAccessor &acc, size_t cacheSize,
+                    double tolerance) :
+     itsAntenna1(acc.antenna1().copy()), itsAntenna2(acc.antenna2().copy()),
+     itsFeed1(acc.feed1().copy()), itsFeed2(acc.feed2().copy()),
+     itsFeed1PA(acc.feed1PA().copy()), itsFeed2PA(acc.feed2PA().copy()),
+     itsPointingDir1(acc.pointingDir1().copy()), itsPointingDir2(acc.pointingDir2().copy()),
+     itsDishPointing1(acc.dishPointing1().copy()), itsDishPointing2(acc.dishPointing2().copy()),
+     itsVisibility(acc.visibility().copy()), itsFlag(acc.flag().copy()),
+     itsNoise(acc.noise().copy()), itsUVW(acc.uvw().copy()), itsTime(acc.time()),
+     itsFrequency(acc.frequency().copy()), itsStokes(acc.stokes().copy()),
+     itsRotatedUVW(cacheSize, tolerance)
+{
+  ASKAPDEBUGASSERT(itsVisibility.shape() == itsFlag.shape());
+}
+
+/// @brief construct the accessor from a serialised chunk
+/// @details This constructor reads the data written by serialise, it allows to
+/// pass chunks between processes.
+/// @param[in] is input blob stream
+/// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+/// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
+/// to initialisation of a new UVW Machine
+CachedDataAccessor::CachedDataAccessor(LOFAR::BlobIStream &is, size_t cacheSize, double tolerance) :
+     itsTime(0.), itsRotatedUVW(cacheSize, tolerance)
+{
+  const int version = is.getStart("CachedDataAccessor");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the serialised CachedDataAccessor");
+  casacore::uInt nRow = 0, nChan = 0, nPol = 0;
+  is >> nRow >> nChan >> nPol >> itsTime;
+  getVector(is, itsAntenna1);
+  getVector(is, itsAntenna2);
+  getVector(is, itsFeed1);
+  getVector(is, itsFeed2);
+  getVector(is, itsFeed1PA);
+  getVector(is, itsFeed2PA);
+  getDirections(is, itsPointingDir1);
+  getDirections(is, itsPointingDir2);
+  getDirections(is, itsDishPointing1);
+  getDirections(is, itsDishPointing2);
+  LOFAR::uint64 size = 0;
+  is >> size;
+  ASKAPCHECK(size == nRow, "Number of uvw points ("<<size<<") doesn't match the number of rows ("<<nRow<<")");
+  itsUVW.resize(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       is >> itsUVW[row](0) >> itsUVW[row](1) >> itsUVW[row](2);
+  }
+  getVector(is, itsFrequency);
+  casacore::Vector<casacore::Int> stokes;
+  getVector(is, stokes);
+  itsStokes.resize(stokes.nelements());
+  for (casacore::uInt pol = 0; pol < stokes.nelements(); ++pol) {
+       itsStokes[pol] = casacore::Stokes::StokesTypes(stokes[pol]);
+  }
+  const casacore::IPosition shape(3, nRow, nChan, nPol);
+  getCube(is, shape, itsVisibility);
+  itsFlag.resize(shape);
+  is.get(itsFlag.data(), itsFlag.nelements());
+  getCube(is, shape, itsNoise);
+  is.getEnd();
+  ASKAPCHECK(itsAntenna1.nelements() == nRow && itsFrequency.nelements() == nChan && itsStokes.nelements() == nPol,
+             "Serialised CachedDataAccessor appears to be corrupted");
+}
+
+/// @brief serialise all data of an accessor
+/// @details The same fields as copied by the constructor from an accessor are written.
+/// The result can be read back by the constructor from a blob stream.
+/// @param[in] acc accessor to serialise
+/// @param[in] os output blob stream
+void CachedDataAccessor::serialise(const IConstDataAccessor &acc, LOFAR::BlobOStream &os)
+{
+  os.putStart("CachedDataAccessor", 1);
+  os << acc.nRow() << acc.nChannel() << acc.nPol() << acc.time();
+  putVector(os, acc.antenna1());
+  putVector(os, acc.antenna2());
+  putVector(os, acc.feed1());
+  putVector(os, acc.feed2());
+  putVector(os, acc.feed1PA());
+  putVector(os, acc.feed2PA());
+  putDirections(os, acc.pointingDir1());
+  putDirections(os, acc.pointingDir2());
+  putDirections(os, acc.dishPointing1());
+  putDirections(os, acc.dishPointing2());
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.uvw();
+  os << static_cast<LOFAR::uint64>(uvw.nelements());
+  for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+       os << uvw[row](0) << uvw[row](1) << uvw[row](2);
+  }
+  putVector(os, acc.frequency());
+  const casacore::Vector<casacore::Stokes::StokesTypes> &stokes = acc.stokes();
+  casacore::Vector<casacore::Int> stokesCodes(stokes.nelements());
+  for (casacore::uInt pol = 0; pol < stokes.nelements(); ++pol) {
+       stokesCodes[pol] = casacore::Int(stokes[pol]);
+  }
+  putVector(os, stokesCodes);
+  putCube(os, acc.visibility());
+  const casacore::Cube<casacore::Bool> flag = acc.flag().contiguousStorage() ? acc.flag() : 
+                                              casacore::Cube<casacore::Bool>(acc.flag().copy());
+  os.put(flag.data(), flag.nelements());
+  putCube(os, acc.noise());
+  os.putEnd();
+}
+
+/// @brief number of bytes occupied by the copied data
+/// @return approximate memory footprint of this object
+size_t CachedDataAccessor::memoryUsage() const
+{
+  return sizeof(CachedDataAccessor) + 
+         (itsAntenna1.nelements() + itsAntenna2.nelements() + itsFeed1.nelements() + 
+          itsFeed2.nelements()) * sizeof(casacore::uInt) + 
+         (itsFeed1PA.nelements() + itsFeed2PA.nelements()) * sizeof(casacore::Float) +
+         (itsPointingDir1.nelements() + itsPointingDir2.nelements() + itsDishPointing1.nelements() +
+          itsDishPointing2.nelements()) * sizeof(casacore::MVDirection) +
+         (itsVisibility.nelements() + itsNoise.nelements()) * sizeof(casacore::Complex) +
+         itsFlag.nelements() * sizeof(casacore::Bool) + 
+         itsUVW.nelements() * sizeof(casacore::RigidVector<casacore::Double, 3>) +
+         itsFrequency.nelements() * sizeof(casacore::Double) +
+         itsStokes.nelements() * sizeof(casacore::Stokes::StokesTypes);
+}
+
+/// The number of rows in this chunk
+/// @return the number of rows in this chunk
+casacore::uInt CachedDataAccessor::nRow() const throw()
+{
+  return itsVisibility.nrow();
+}
+
+/// The number of spectral channels (equal for all rows)
+/// @return the number of spectral channels
+casacore::uInt CachedDataAccessor::nChannel() const throw()
+{
+  return itsVisibility.ncolumn();
+}
+
+/// The number of polarization products (equal for all rows)
+/// @return the number of polarization products (can be 1,2 or 4)
+casacore::uInt CachedDataAccessor::nPol() const throw()
+{
+  return itsVisibility.nplane();
+}
+
+/// First antenna IDs for all rows
+/// @return a vector with IDs of the first antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& CachedDataAccessor::antenna1() const
+{
+  return itsAntenna1;
+}
+
+/// Second antenna IDs for all rows
+/// @return a vector with IDs of the second antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& CachedDataAccessor::antenna2() const
+{
+  return itsAntenna2;
+}
+
+/// First feed IDs for all rows
+/// @return a vector with IDs of the first feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& CachedDataAccessor::feed1() const
+{
+  return itsFeed1;
+}
+
+/// Second feed IDs for all rows
+/// @return a vector with IDs of the second feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& CachedDataAccessor::feed2() const
+{
+  return itsFeed2;
+}
+
+/// Position angles of the first feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// first feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& CachedDataAccessor::feed1PA() const
+{
+  return itsFeed1PA;
+}
+
+/// Position angles of the second feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// second feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& CachedDataAccessor::feed2PA() const
+{
+  return itsFeed2PA;
+}
+
+/// Return pointing centre directions of the first antenna/feed
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& CachedDataAccessor::pointingDir1() const
+{
+  return itsPointingDir1;
+}
+
+/// Pointing centre directions of the second antenna/feed
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& CachedDataAccessor::pointingDir2() const
+{
+  return itsPointingDir2;
+}
+
+/// pointing direction for the centre of the first antenna 
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& CachedDataAccessor::dishPointing1() const
+{
+  return itsDishPointing1;
+}
+
+/// pointing direction for the centre of the first antenna 
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& CachedDataAccessor::dishPointing2() const
+{
+  return itsDishPointing2;
+}
+
+/// Visibilities (a cube is nRow x nChannel x nPol; each element is
+/// a complex visibility)
+/// @return a reference to nRow x nChannel x nPol cube, containing
+/// all visibility data
+const casacore::Cube<casacore::Complex>& CachedDataAccessor::visibility() const
+{
+  return itsVisibility;
+}
+
+/// Cube of flags corresponding to the output of visibility() 
+/// @return a reference to nRow x nChannel x nPol cube with flag 
+///         information. If True, the corresponding element is flagged.
+const casacore::Cube<casacore::Bool>& CachedDataAccessor::flag() const
+{
+  return itsFlag;
+}
+
+/// UVW
+/// @return a reference to vector containing uvw-coordinates
+/// packed into a 3-D rigid vector
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& CachedDataAccessor::uvw() const
+{
+  return itsUVW;
+}
+
+/// @brief uvw after rotation
+/// @details This method calls UVWMachine to rotate baseline coordinates 
+/// for a new tangent point. Delays corresponding to this correction are
+/// returned by a separate method.
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return uvw after rotation to the new coordinate system for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	         CachedDataAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
+{
+  return itsRotatedUVW.uvw(*this, tangentPoint);
+}
+
+/// @brief delay associated with uvw rotation
+/// @details This is a companion method to rotatedUVW. It returns delays corresponding
+/// to the baseline coordinate rotation. 
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+/// @return delays corresponding to the uvw rotation for each row
+const casacore::Vector<casacore::Double>& CachedDataAccessor::uvwRotationDelay(
+	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
+{
+  return itsRotatedUVW.delays(*this, tangentPoint, imageCentre);
+}
+
+/// Noise level required for a proper weighting
+/// @return a reference to nRow x nChannel x nPol cube with
+///         complex noise estimates
+const casacore::Cube<casacore::Complex>& CachedDataAccessor::noise() const
+{
+  return itsNoise;
+}
+
+/// Timestamp for each row
+/// @return a timestamp for this buffer (it is always the same
+///         for all rows. The timestamp is returned as 
+///         Double w.r.t. the origin specified by the 
+///         DataSource object and in that reference frame
+casacore::Double CachedDataAccessor::time() const
+{
+  return itsTime;
+}
+
+/// Frequency for each channel
+/// @return a reference to vector containing frequencies for each
+///         spectral channel (vector size is nChannel).
+const casacore::Vector<casacore::Double>& CachedDataAccessor::frequency() const
+{
+  return itsFrequency;
+}
+
+/// Velocity for each channel
+/// @details The velocity axis is not copied, this method throws an exception
+/// @return a reference to vector containing velocities for each
+///         spectral channel (vector size is nChannel).
+const casacore::Vector<casacore::Double>& CachedDataAccessor::velocity() const
+{
+  ASKAPTHROW(DataAccessLogicError, "CachedDataAccessor::velocity is not supported");
+}
+
+/// @brief polarisation type for each product
+/// @return a reference to vector containing polarisation types for
+/// each product in the visibility cube (nPol() elements).
+const casacore::Vector<casacore::Stokes::StokesTypes>& CachedDataAccessor::stokes() const
+{
+  return itsStokes;
+}
@@ -0,0 +1,199 @@
+/// @file
+/// @brief an iterator replaying chunks from memory on subsequent passes
+/// @details Imaging requires many passes over the same selection of data with
+/// the same conversion policies. Each pass through the table-based iterator
+/// repeats the table iteration, selection, conversions and column reads. This
+/// adapter wraps another iterator and keeps a copy of each chunk (see 
+/// CachedDataAccessor) within the given memory limit. When the iteration is 
+/// restarted by init(), cached chunks are served from memory and only the 
+/// chunks which did not fit are read via the wrapped iterator again.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/CachingDataIterator.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <limits>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct the caching iterator
+/// @param[in] iter iterator to wrap (should be at the start of the iteration)
+/// @param[in] maxMemory memory limit in bytes for the cached chunks
+CachingDataIterator::CachingDataIterator(const boost::shared_ptr<IConstDataIterator> &iter, 
+                     size_t maxMemory) : itsIterator(iter), itsMaxMemory(maxMemory), 
+          itsMemoryUsage(0), itsCurrentChunk(0), itsIteratorChunk(0), 
+          itsNumberOfChunks(std::numeric_limits<size_t>::max()), itsClock(0), itsPassStart(0),
+          itsCurrentAccessor(0)
+{
+  ASKAPCHECK(itsIterator, "CachingDataIterator requires an iterator to wrap");
+  setUpChunk();
+}
+
+/// Restart the iteration from the beginning
+/// @details The wrapped iterator is only restarted when a chunk which is not
+/// cached is requested.
+void CachingDataIterator::init()
+{
+  itsCurrentChunk = 0;
+  itsPassStart = itsClock;
+  setUpChunk();
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the current chunk
+const IConstDataAccessor& CachingDataIterator::operator*() const
+{
+  if (itsCurrentAccessor == 0) {
+      ASKAPTHROW(DataAccessLogicError, "CachingDataIterator: an attempt to access data past the end");
+  }
+  return *itsCurrentAccessor;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool CachingDataIterator::hasMore() const throw()
+{
+  return itsCurrentAccessor != 0;
+}
+
+/// advance the iterator one step further 
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool CachingDataIterator::next()
+{
+  if (itsCurrentAccessor != 0) {
+      ++itsCurrentChunk;
+      setUpChunk();
+  }
+  return hasMore();
+}
+
+/// @brief number of chunks in the cache
+/// @return number of chunks currently served from memory
+size_t CachingDataIterator::nCachedChunks() const
+{
+  size_t result = 0;
+  for (std::vector<boost::shared_ptr<CachedDataAccessor const> >::const_iterator ci = itsCache.begin();
+       ci != itsCache.end(); ++ci) {
+       if (*ci) {
+           ++result;
+       }
+  }
+  return result;
+}
+
+/// @brief make the current chunk available
+/// @details The chunk is taken from the cache, if possible. Otherwise, the
+/// wrapped iterator is advanced to it and the data are copied if the chunk 
+/// fits into the memory limit.
+void CachingDataIterator::setUpChunk()
+{
+  itsCurrentAccessor = 0;
+  if (itsCurrentChunk >= itsNumberOfChunks) {
+      return;
+  }
+  if (itsCurrentChunk < itsCache.size() && itsCache[itsCurrentChunk]) {
+      itsLastUse[itsCurrentChunk] = itsClock++;
+      itsCurrentAccessor = itsCache[itsCurrentChunk].get();
+      return;
+  }
+  if (!advanceTo(itsCurrentChunk)) {
+      itsNumberOfChunks = itsCurrentChunk;
+      return;
+  }
+  if (itsCurrentChunk >= itsCache.size()) {
+      itsCache.resize(itsCurrentChunk + 1);
+      itsLastUse.resize(itsCurrentChunk + 1, 0);
+  }
+  itsLastUse[itsCurrentChunk] = itsClock++;
+  const IConstDataAccessor &acc = **itsIterator;
+  // estimate the size of the copy before it is made
+  const size_t bulkSize = size_t(acc.nRow()) * acc.nChannel() * acc.nPol() * 
+                          (2 * sizeof(casacore::Complex) + sizeof(casacore::Bool));
+  if (reserve(bulkSize)) {
+      boost::shared_ptr<CachedDataAccessor const> chunk(new CachedDataAccessor(acc));
+      // correct the value reserved for the bulk data
+      itsMemoryUsage += chunk->memoryUsage();
+      itsMemoryUsage -= bulkSize;
+      itsCache[itsCurrentChunk] = chunk;
+      itsCurrentAccessor = chunk.get();
+  } else {
+      itsCurrentAccessor = &acc;
+  }
+}
+
+/// @brief advance the wrapped iterator to the given chunk
+/// @details The wrapped iterator is restarted if it is already past the given
+/// chunk.
+/// @param[in] chunk chunk number
+/// @return true if the chunk exists
+bool CachingDataIterator::advanceTo(size_t chunk)
+{
+  if (itsIteratorChunk > chunk) {
+      itsIterator->init();
+      itsIteratorChunk = 0;
+  }
+  for (; itsIteratorChunk < chunk && itsIterator->hasMore(); ++itsIteratorChunk) {
+       itsIterator->next();
+  }
+  return (itsIteratorChunk == chunk) && itsIterator->hasMore();
+}
+
+/// @brief reserve memory for a new chunk
+/// @details The least recently used chunks which have not been used in the current
+/// pass are evicted, if necessary.
+/// @param[in] bytes memory required for the new chunk
+/// @return true, if the memory has been reserved, false if the chunk should not be cached
+bool CachingDataIterator::reserve(size_t bytes)
+{
+  if (bytes > itsMaxMemory) {
+      return false;
+  }
+  while (itsMemoryUsage + bytes > itsMaxMemory) {
+      // find the least recently used chunk not touched in this pass
+      size_t victim = itsCache.size();
+      for (size_t chunk = 0; chunk < itsCache.size(); ++chunk) {
+           if (itsCache[chunk] && (itsLastUse[chunk] < itsPassStart)) {
+               if ((victim == itsCache.size()) || (itsLastUse[chunk] < itsLastUse[victim])) {
+                   victim = chunk;
+               }
+           }
+      }
+      if (victim == itsCache.size()) {
+          return false;
+      }
+      ASKAPDEBUGASSERT(itsMemoryUsage >= itsCache[victim]->memoryUsage());
+      itsMemoryUsage -= itsCache[victim]->memoryUsage();
+      itsCache[victim].reset();
+  }
+  itsMemoryUsage += bytes;
+  return true;
+}
@@ -0,0 +1,162 @@
+/// @file
+/// @brief an iterator replaying chunks from memory on subsequent passes
+/// @details Imaging requires many passes over the same selection of data with
+/// the same conversion policies. Each pass through the table-based iterator
+/// repeats the table iteration, selection, conversions and column reads. This
+/// adapter wraps another iterator and keeps a copy of each chunk (see 
+/// CachedDataAccessor) within the given memory limit. When the iteration is 
+/// restarted by init(), cached chunks are served from memory and only the 
+/// chunks which did not fit are read via the wrapped iterator again.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_CACHING_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_CACHING_DATA_ITERATOR_H
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/CachedDataAccessor.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief an iterator replaying chunks from memory on subsequent passes
+/// @details Chunks are numbered in the order they are delivered by the wrapped
+/// iterator, which is assumed to deliver the same sequence of chunks after each init().
+/// A chunk is copied when it is first delivered, if it fits into the memory limit.
+/// Otherwise, memory is reclaimed by evicting the least recently used chunks, but
+/// only those which have not been used in the current pass. This way the subsequent 
+/// sequential passes don't evict the chunks they are about to use and the chunks
+/// which didn't fit are simply read again. The wrapped iterator is only advanced when
+/// a chunk which is not in the cache is requested, so the cost of its next() calls is 
+/// incurred, but no data are read for the cached chunks.
+/// @ingroup dataaccess_hlp
+class CachingDataIterator : virtual public IConstDataIterator,
+                            private boost::noncopyable
+{
+public:
+  /// @brief construct the caching iterator
+  /// @param[in] iter iterator to wrap (should be at the start of the iteration)
+  /// @param[in] maxMemory memory limit in bytes for the cached chunks
+  CachingDataIterator(const boost::shared_ptr<IConstDataIterator> &iter, size_t maxMemory);
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the current chunk
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @brief memory used by the cached chunks
+  /// @return number of bytes occupied by the cached chunks
+  inline size_t memoryUsage() const { return itsMemoryUsage;}
+
+  /// @brief number of chunks in the cache
+  /// @return number of chunks currently served from memory
+  size_t nCachedChunks() const;
+
+protected:
+  /// @brief make the current chunk available
+  /// @details The chunk is taken from the cache, if possible. Otherwise, the
+  /// wrapped iterator is advanced to it and the data are copied if the chunk 
+  /// fits into the memory limit.
+  void setUpChunk();
+
+  /// @brief advance the wrapped iterator to the given chunk
+  /// @details The wrapped iterator is restarted if it is already past the given
+  /// chunk.
+  /// @param[in] chunk chunk number
+  /// @return true if the chunk exists
+  bool advanceTo(size_t chunk);
+
+  /// @brief reserve memory for a new chunk
+  /// @details The least recently used chunks which have not been used in the current
+  /// pass are evicted, if necessary.
+  /// @param[in] bytes memory required for the new chunk
+  /// @return true, if the memory has been reserved, false if the chunk should not be cached
+  bool reserve(size_t bytes);
+
+private:
+  /// @brief wrapped iterator
+  boost::shared_ptr<IConstDataIterator> itsIterator;
+
+  /// @brief memory limit in bytes
+  size_t itsMaxMemory;
+
+  /// @brief memory used by the cached chunks
+  size_t itsMemoryUsage;
+
+  /// @brief current chunk number
+  size_t itsCurrentChunk;
+
+  /// @brief chunk number the wrapped iterator is at
+  size_t itsIteratorChunk;
+
+  /// @brief total number of chunks, if known
+  /// @details This value is set when the end of the iteration is found. Before that,
+  /// it is equal to the maximum value of size_t.
+  size_t itsNumberOfChunks;
+
+  /// @brief cached chunks, empty pointers for chunks which are not cached
+  std::vector<boost::shared_ptr<CachedDataAccessor const> > itsCache;
+
+  /// @brief time of the last use for each chunk
+  /// @details The time is measured by the number of chunk deliveries (itsClock).
+  std::vector<size_t> itsLastUse;
+
+  /// @brief number of chunk deliveries so far
+  size_t itsClock;
+
+  /// @brief value of itsClock at the start of the current pass
+  size_t itsPassStart;
+
+  /// @brief accessor for the current chunk (either cached or the wrapped one),
+  /// zero pointer if there are no more data
+  const IConstDataAccessor *itsCurrentAccessor;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CACHING_DATA_ITERATOR_H
@@ -0,0 +1,85 @@
+/// @file
+/// @brief a data source decorator keeping the data in memory between passes
+/// @details Iterators created by this data source wrap the iterators of another
+/// data source into CachingDataIterator. Chunks delivered on the first pass are
+/// kept in memory (within the given limit) and replayed on the subsequent passes
+/// started by init(). This is intended for multi-pass algorithms like major cycles
+/// of the imager, which iterate over the same selection with the same conversion 
+/// policies a number of times.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/CachingDataSource.h>
+#include <askap/dataaccess/CachingDataIterator.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct the decorator
+/// @param[in] ds data source to wrap
+/// @param[in] maxMemory memory limit in bytes for the cached chunks of each iterator
+CachingDataSource::CachingDataSource(const boost::shared_ptr<IConstDataSource const> &ds, 
+                   size_t maxMemory) : itsDataSource(ds), itsMaxMemory(maxMemory)
+{
+  ASKAPCHECK(itsDataSource, "CachingDataSource requires a data source to wrap");
+}
+
+/// @brief create a converter object corresponding to the wrapped data source
+/// @return a shared pointer to a new DataConverter object
+IDataConverterPtr CachingDataSource::createConverter() const
+{
+  return itsDataSource->createConverter();
+}
+
+/// @brief get a caching iterator over a selected part of the dataset 
+/// @param[in] sel a shared pointer to the selector object defining 
+///            which subset of the data is used
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @return a shared pointer to CachingDataIterator object
+boost::shared_ptr<IConstDataIterator> CachingDataSource::createConstIterator(const
+	           IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv) const
+{
+  return boost::shared_ptr<IConstDataIterator>(new CachingDataIterator(
+                 itsDataSource->createConstIterator(sel, conv), itsMaxMemory));
+}
+
+/// @brief create a selector object corresponding to the wrapped data source
+/// @return a shared pointer to the DataSelector 
+IDataSelectorPtr CachingDataSource::createSelector() const
+{
+  return itsDataSource->createSelector();
+}
+
+/// @brief change the memory limit
+/// @param[in] maxMemory memory limit in bytes for the cached chunks of each iterator
+/// @note The new limit applies to the iterators created in the future 
+void CachingDataSource::configureMaxMemory(size_t maxMemory)
+{
+  itsMaxMemory = maxMemory;
+}
@@ -0,0 +1,105 @@
+/// @file
+/// @brief a data source decorator keeping the data in memory between passes
+/// @details Iterators created by this data source wrap the iterators of another
+/// data source into CachingDataIterator. Chunks delivered on the first pass are
+/// kept in memory (within the given limit) and replayed on the subsequent passes
+/// started by init(). This is intended for multi-pass algorithms like major cycles
+/// of the imager, which iterate over the same selection with the same conversion 
+/// policies a number of times.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_CACHING_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_CACHING_DATA_SOURCE_H
+
+// own includes
+#include <askap/dataaccess/IConstDataSource.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief a data source decorator keeping the data in memory between passes
+/// @details The cache belongs to the iterator, i.e. the same iterator should be 
+/// rewound with init() for each pass to benefit from caching (a new iterator starts 
+/// with an empty cache). Selectors and converters can be changed after the iterator 
+/// is created, so the iterators are not matched by their parameters. The memory limit
+/// applies to each iterator separately.
+/// @ingroup dataaccess_hlp
+class CachingDataSource : virtual public IConstDataSource
+{
+public:
+  /// @brief construct the decorator
+  /// @param[in] ds data source to wrap
+  /// @param[in] maxMemory memory limit in bytes for the cached chunks of each iterator
+  CachingDataSource(const boost::shared_ptr<IConstDataSource const> &ds, size_t maxMemory);
+
+  /// @brief create a converter object corresponding to the wrapped data source
+  /// @return a shared pointer to a new DataConverter object
+  virtual IDataConverterPtr createConverter() const;
+
+  /// @brief get a caching iterator over a selected part of the dataset 
+  /// @param[in] sel a shared pointer to the selector object defining 
+  ///            which subset of the data is used
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @return a shared pointer to CachingDataIterator object
+  virtual boost::shared_ptr<IConstDataIterator> createConstIterator(const
+	           IDataSelectorConstPtr &sel, const
+		   IDataConverterConstPtr &conv) const;
+
+  /// @brief create a selector object corresponding to the wrapped data source
+  /// @return a shared pointer to the DataSelector 
+  virtual IDataSelectorPtr createSelector() const;
+
+  /// @brief current memory limit
+  /// @return memory limit in bytes for the cached chunks of each iterator
+  inline size_t maxMemory() const { return itsMaxMemory;}
+
+  /// @brief change the memory limit
+  /// @param[in] maxMemory memory limit in bytes for the cached chunks of each iterator
+  /// @note The new limit applies to the iterators created in the future 
+  void configureMaxMemory(size_t maxMemory);
+
+  // we need this to get access to the overloaded syntax in the base class
+  using IConstDataSource::createConstIterator;
+
+private:
+  /// @brief wrapped data source
+  boost::shared_ptr<IConstDataSource const> itsDataSource;
+
+  /// @brief memory limit in bytes
+  size_t itsMaxMemory;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CACHING_DATA_SOURCE_H
@@ -0,0 +1,121 @@
+/// @file
+/// @brief channel averaging kernel used by the table reader
+///
+/// @details If averaging of adjacent channels is requested via the selector, 
+/// the table-based iterator reads blocks of rows in the native order and
+/// passes them through this kernel, so the full resolution cubes in the accessor
+/// order are never formed. The averaging follows the same rules as 
+/// AveragedDataAccessor: visibilities are weighted by the inverse noise variance
+/// and flagged samples are excluded.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/ChannelAverager.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <cmath>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief average a block of rows
+/// @details Rows firstRow to firstRow + nRow - 1 of the output cubes are filled, where
+/// nRow is the number of rows in the input cubes. Output cubes should already have 
+/// the right shape. 
+/// @param[in] vis visibilities (nPol x nChannel*nAvg x nRow)
+/// @param[in] flag flags of the same shape
+/// @param[in] sigma noise figures of the same shape
+/// @param[in] nAvg number of adjacent channels to average
+/// @param[in] firstRow first row of the output cubes to fill
+/// @param[in] outVis output visibilities (nRowOut x nChannel x nPol)
+/// @param[in] outFlag output flags of the same shape
+/// @param[in] outNoise output noise of the same shape
+void ChannelAverager::average(const casacore::Cube<casacore::Complex> &vis, 
+                      const casacore::Cube<casacore::Bool> &flag,
+                      const casacore::Cube<casacore::Float> &sigma, casacore::uInt nAvg,
+                      casacore::uInt firstRow, casacore::Cube<casacore::Complex> &outVis,
+                      casacore::Cube<casacore::Bool> &outFlag,
+                      casacore::Cube<casacore::Complex> &outNoise)
+{
+  ASKAPDEBUGASSERT(nAvg > 0);
+  ASKAPDEBUGASSERT(vis.shape() == flag.shape() && vis.shape() == sigma.shape());
+  ASKAPDEBUGASSERT(outVis.shape() == outFlag.shape() && outVis.shape() == outNoise.shape());
+  ASKAPDEBUGASSERT(vis.contiguousStorage() && flag.contiguousStorage() && sigma.contiguousStorage());
+  ASKAPDEBUGASSERT(outVis.contiguousStorage() && outFlag.contiguousStorage() && outNoise.contiguousStorage());
+  const casacore::uInt nPol = vis.nrow();
+  const casacore::uInt nInChan = vis.ncolumn();
+  const casacore::uInt nRow = vis.nplane();
+  const casacore::uInt nOutRow = outVis.nrow();
+  const casacore::uInt nOutChan = outVis.ncolumn();
+  ASKAPCHECK(nInChan == nOutChan * nAvg, "Number of input channels ("<<nInChan<<
+             ") doesn't correspond to "<<nOutChan<<" channels averaged by "<<nAvg);
+  ASKAPDEBUGASSERT(outVis.nplane() == nPol);
+  ASKAPDEBUGASSERT(firstRow + nRow <= nOutRow);
+  const casacore::Complex *visPtr = vis.data();
+  const casacore::Bool *flagPtr = flag.data();
+  const casacore::Float *sigmaPtr = sigma.data();
+  casacore::Complex *outVisPtr = outVis.data();
+  casacore::Bool *outFlagPtr = outFlag.data();
+  casacore::Complex *outNoisePtr = outNoise.data();
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       for (casacore::uInt chan = 0; chan < nOutChan; ++chan) {
+            // offset of the first input channel of this block for pol = 0
+            const size_t inOffset = nPol * (size_t(chan) * nAvg + size_t(nInChan) * row);
+            for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+                 casacore::Double sumWeights = 0.;
+                 casacore::DComplex sumVis(0., 0.);
+                 casacore::Float lastSigma = 0.;
+                 for (casacore::uInt i = 0; i < nAvg; ++i) {
+                      const size_t inIndex = inOffset + size_t(i) * nPol + pol;
+                      const casacore::Float thisSigma = sigmaPtr[inIndex];
+                      if (!flagPtr[inIndex] && (thisSigma > 0.)) {
+                          const casacore::Double weight = 1. / (casacore::Double(thisSigma) * thisSigma);
+                          sumWeights += weight;
+                          sumVis += weight * casacore::DComplex(visPtr[inIndex]);
+                      }
+                      lastSigma = thisSigma;
+                 }
+                 const size_t outIndex = firstRow + row + size_t(nOutRow) * (chan + size_t(nOutChan) * pol);
+                 if (sumWeights > 0.) {
+                     outVisPtr[outIndex] = casacore::Complex(sumVis / sumWeights);
+                     const casacore::Float noise = 1. / std::sqrt(sumWeights);
+                     outNoisePtr[outIndex] = casacore::Complex(noise, noise);
+                     outFlagPtr[outIndex] = casacore::False;
+                 } else {
+                     outVisPtr[outIndex] = casacore::Complex(0., 0.);
+                     outNoisePtr[outIndex] = casacore::Complex(lastSigma, lastSigma);
+                     outFlagPtr[outIndex] = casacore::True;
+                 }
+            }
+       }
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,84 @@
+/// @file
+/// @brief channel averaging kernel used by the table reader
+///
+/// @details If averaging of adjacent channels is requested via the selector, 
+/// the table-based iterator reads blocks of rows in the native order and
+/// passes them through this kernel, so the full resolution cubes in the accessor
+/// order are never formed. The averaging follows the same rules as 
+/// AveragedDataAccessor: visibilities are weighted by the inverse noise variance
+/// and flagged samples are excluded.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_CHANNEL_AVERAGER_H
+#define ASKAP_ACCESSORS_CHANNEL_AVERAGER_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief channel averaging kernel used by the table reader
+/// @details Input cubes are in the table order (nPol x nChannel*nAvg x nRow), 
+/// output cubes are in the accessor order (nRow x nChannel x nPol), so the kernel
+/// does the transpose as well. Each output sample is the average of nAvg adjacent 
+/// input channels weighted by the inverse variance. Flagged samples and samples with
+/// non-positive noise are excluded. The noise of the result is the inverse square
+/// root of the sum of weights. If all contributing samples are excluded, the output
+/// sample is flagged, the visibility is set to zero and the noise is taken from the last 
+/// input sample.
+/// @ingroup dataaccess_hlp
+struct ChannelAverager {
+
+  /// @brief average a block of rows
+  /// @details Rows firstRow to firstRow + nRow - 1 of the output cubes are filled, where
+  /// nRow is the number of rows in the input cubes. Output cubes should already have 
+  /// the right shape. 
+  /// @param[in] vis visibilities (nPol x nChannel*nAvg x nRow)
+  /// @param[in] flag flags of the same shape
+  /// @param[in] sigma noise figures of the same shape
+  /// @param[in] nAvg number of adjacent channels to average
+  /// @param[in] firstRow first row of the output cubes to fill
+  /// @param[in] outVis output visibilities (nRowOut x nChannel x nPol)
+  /// @param[in] outFlag output flags of the same shape
+  /// @param[in] outNoise output noise of the same shape
+  static void average(const casacore::Cube<casacore::Complex> &vis, 
+                      const casacore::Cube<casacore::Bool> &flag,
+                      const casacore::Cube<casacore::Float> &sigma, casacore::uInt nAvg,
+                      casacore::uInt firstRow, casacore::Cube<casacore::Complex> &outVis,
+                      casacore::Cube<casacore::Bool> &outFlag,
+                      casacore::Cube<casacore::Complex> &outNoise);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CHANNEL_AVERAGER_H
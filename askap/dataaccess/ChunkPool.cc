@@ -0,0 +1,132 @@
+/// @file
+/// @brief bounded pool of recycled chunk buffers
+/// @details The accessor returned by an iterator is only valid until the iterator moves,
+/// so passing chunks to other threads (e.g. a reader thread advancing the iterator while
+/// workers process earlier chunks) requires a copy of each chunk. This class holds a fixed
+/// number of preallocated buffers and hands out reference-counted chunks stored in them.
+/// A buffer returns to the pool when the last holder of its chunk releases it, so the
+/// memory used by the pipeline is bounded and no allocation takes place once the buffers
+/// have grown to the chunk size.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/ChunkPool.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the pool
+/// @param[in] nBuffers number of buffers (i.e. the maximum number of chunks held)
+/// @param[in] cacheSize size of the uvw machine cache of each buffer
+/// @param[in] tolerance pointing direction tolerance in radians for the uvw machine cache
+ChunkPool::ChunkPool(size_t nBuffers, size_t cacheSize, double tolerance) : itsSize(nBuffers),
+          itsFreeList(new FreeList)
+{
+  ASKAPCHECK(nBuffers > 0, "Number of buffers in the chunk pool should be positive");
+  itsFreeList->itsBuffers.reserve(nBuffers);
+  for (size_t buffer = 0; buffer < nBuffers; ++buffer) {
+       itsFreeList->itsBuffers.push_back(boost::shared_ptr<GatheredDataAccessor>(
+                 new GatheredDataAccessor(cacheSize, tolerance)));
+  }
+}
+
+/// @brief copy a chunk into a free buffer
+/// @details This method blocks while all buffers are in use
+/// @param[in] acc accessor to copy (e.g. the current accessor of an iterator)
+/// @return shared pointer to the chunk, the buffer returns to the pool when the
+/// last copy of the pointer is destroyed
+ChunkPool::ChunkPtr ChunkPool::acquire(const IConstDataAccessor &acc)
+{
+  boost::shared_ptr<GatheredDataAccessor> buffer;
+  {
+    boost::unique_lock<boost::mutex> lock(itsFreeList->itsMutex);
+    while (itsFreeList->itsBuffers.empty()) {
+           itsFreeList->itsNotEmpty.wait(lock);
+    }
+    buffer = itsFreeList->itsBuffers.back();
+    itsFreeList->itsBuffers.pop_back();
+  }
+  return fill(buffer, acc);
+}
+
+/// @brief copy a chunk into a free buffer if there is one
+/// @param[in] acc accessor to copy
+/// @return shared pointer to the chunk or an empty pointer if all buffers are in use
+ChunkPool::ChunkPtr ChunkPool::tryAcquire(const IConstDataAccessor &acc)
+{
+  boost::shared_ptr<GatheredDataAccessor> buffer;
+  {
+    boost::lock_guard<boost::mutex> lock(itsFreeList->itsMutex);
+    if (itsFreeList->itsBuffers.empty()) {
+        return ChunkPtr();
+    }
+    buffer = itsFreeList->itsBuffers.back();
+    itsFreeList->itsBuffers.pop_back();
+  }
+  return fill(buffer, acc);
+}
+
+/// @brief number of buffers which are not in use
+/// @return number of chunks which can be acquired without waiting
+size_t ChunkPool::nFree() const
+{
+  boost::lock_guard<boost::mutex> lock(itsFreeList->itsMutex);
+  return itsFreeList->itsBuffers.size();
+}
+
+/// @brief copy a chunk into the buffer and hand it out
+/// @details The copy is done without holding the lock, so other threads can acquire
+/// and release chunks in the meantime.
+/// @param[in] buffer free buffer taken from the list
+/// @param[in] acc accessor to copy
+/// @return shared pointer to the chunk
+ChunkPool::ChunkPtr ChunkPool::fill(const boost::shared_ptr<GatheredDataAccessor> &buffer, 
+                                    const IConstDataAccessor &acc)
+{
+  ASKAPDEBUGASSERT(buffer);
+  // the deleter returns the buffer to the list even if the copy fails
+  const ChunkPtr chunk(buffer.get(), Returner(itsFreeList, buffer));
+  buffer->assign(acc);
+  return chunk;
+}
+
+/// @brief return the buffer to the list
+/// @param[in] chunk pointer to the chunk (not used, the buffer is kept by this object)
+void ChunkPool::Returner::operator()(GatheredDataAccessor const *)
+{
+  ASKAPDEBUGASSERT(itsFreeList);
+  ASKAPDEBUGASSERT(itsBuffer);
+  boost::lock_guard<boost::mutex> lock(itsFreeList->itsMutex);
+  itsFreeList->itsBuffers.push_back(itsBuffer);
+  itsBuffer.reset();
+  itsFreeList->itsNotEmpty.notify_one();
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,150 @@
+/// @file
+/// @brief bounded pool of recycled chunk buffers
+/// @details The accessor returned by an iterator is only valid until the iterator moves,
+/// so passing chunks to other threads (e.g. a reader thread advancing the iterator while
+/// workers process earlier chunks) requires a copy of each chunk. This class holds a fixed
+/// number of preallocated buffers and hands out reference-counted chunks stored in them.
+/// A buffer returns to the pool when the last holder of its chunk releases it, so the
+/// memory used by the pipeline is bounded and no allocation takes place once the buffers
+/// have grown to the chunk size.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_CHUNK_POOL_H
+#define ASKAP_ACCESSORS_CHUNK_POOL_H
+
+// std includes
+#include <cstddef>
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/GatheredDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief bounded pool of recycled chunk buffers
+/// @details The producer calls acquire for every chunk of the iterator, the chunk is copied
+/// into a free buffer (the storage of the buffer is reused if the shape is the same) and 
+/// returned as a shared pointer which can be passed to any number of threads (e.g. via
+/// BoundedChunkQueue) without further copying. The chunk stays valid and unchanged as 
+/// long as it is held, the buffer returns to the pool when the last copy of the pointer
+/// is destroyed. acquire blocks while all buffers are in use, so the producer can't run
+/// ahead of the consumers by more than the size of the pool. The time of each row is 
+/// available via GatheredDataAccessor::rowTime. All methods are thread-safe, chunks may 
+/// outlive the pool. Arrays obtained from a chunk reference the storage of the buffer,
+/// they shouldn't be used after the pointer to the chunk is released.
+/// @note The thread calling acquire shouldn't hold all chunks, otherwise it waits forever.
+/// @ingroup dataaccess_hlp
+class ChunkPool : private boost::noncopyable 
+{
+public:
+  /// @brief shared pointer to a chunk held in a buffer of the pool
+  typedef boost::shared_ptr<GatheredDataAccessor const> ChunkPtr;
+
+  /// @brief construct the pool
+  /// @param[in] nBuffers number of buffers (i.e. the maximum number of chunks held)
+  /// @param[in] cacheSize size of the uvw machine cache of each buffer
+  /// @param[in] tolerance pointing direction tolerance in radians for the uvw machine cache
+  explicit ChunkPool(size_t nBuffers, size_t cacheSize = 1, double tolerance = 1e-6);
+
+  /// @brief copy a chunk into a free buffer
+  /// @details This method blocks while all buffers are in use
+  /// @param[in] acc accessor to copy (e.g. the current accessor of an iterator)
+  /// @return shared pointer to the chunk, the buffer returns to the pool when the
+  /// last copy of the pointer is destroyed
+  ChunkPtr acquire(const IConstDataAccessor &acc);
+
+  /// @brief copy a chunk into a free buffer if there is one
+  /// @param[in] acc accessor to copy
+  /// @return shared pointer to the chunk or an empty pointer if all buffers are in use
+  ChunkPtr tryAcquire(const IConstDataAccessor &acc);
+
+  /// @brief number of buffers which are not in use
+  /// @return number of chunks which can be acquired without waiting
+  size_t nFree() const;
+
+  /// @brief number of buffers
+  /// @return size of the pool
+  inline size_t size() const { return itsSize; }
+
+private:
+  /// @brief buffers which are not in use, shared with the chunks handed out
+  struct FreeList {
+    /// @brief buffers which are not in use
+    std::vector<boost::shared_ptr<GatheredDataAccessor> > itsBuffers;
+    /// @brief mutex protecting the list
+    boost::mutex itsMutex;
+    /// @brief condition signalled when a buffer returns to the list
+    boost::condition_variable itsNotEmpty;
+  };
+
+  /// @brief deleter of the chunks returning the buffer to the list
+  struct Returner {
+    /// @brief set up the deleter
+    /// @param[in] freeList list to return the buffer to
+    /// @param[in] buffer buffer holding the chunk
+    Returner(const boost::shared_ptr<FreeList> &freeList, 
+             const boost::shared_ptr<GatheredDataAccessor> &buffer) :
+             itsFreeList(freeList), itsBuffer(buffer) {}
+
+    /// @brief return the buffer to the list
+    /// @param[in] chunk pointer to the chunk (not used, the buffer is kept by this object)
+    void operator()(GatheredDataAccessor const *chunk);
+
+    /// @brief list to return the buffer to
+    boost::shared_ptr<FreeList> itsFreeList;
+    /// @brief buffer holding the chunk
+    boost::shared_ptr<GatheredDataAccessor> itsBuffer;
+  };
+
+  /// @brief copy a chunk into the buffer and hand it out
+  /// @param[in] buffer free buffer taken from the list
+  /// @param[in] acc accessor to copy
+  /// @return shared pointer to the chunk
+  ChunkPtr fill(const boost::shared_ptr<GatheredDataAccessor> &buffer, 
+                const IConstDataAccessor &acc);
+
+  /// @brief number of buffers
+  const size_t itsSize;
+
+  /// @brief buffers which are not in use
+  boost::shared_ptr<FreeList> itsFreeList;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CHUNK_POOL_H
@@ -0,0 +1,138 @@
+/// @file
+/// @brief flat binary file holding one column of the columnar visibility format
+/// @details The columnar format (see ColumnarDataSource) keeps each column in a separate
+/// file as a sequence of fixed-size records, one per row (or one per chunk for chunk-based
+/// columns). This class wraps a POSIX file descriptor and provides positioned reads and
+/// appends of whole blocks of records, so a chunk of consecutive rows is read by a single
+/// pread call without going through any per-row cell machinery.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/ColumnFile.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// system includes
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// std includes
+#include <cerrno>
+#include <cstring>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief open the file
+/// @param[in] name file name
+/// @param[in] recordSize size of a record in bytes
+/// @param[in] create if true, a new file is created (existing file is truncated) for writing,
+///            otherwise an existing file is opened for reading
+ColumnFile::ColumnFile(const std::string &name, size_t recordSize, bool create) :
+        itsName(name), itsRecordSize(recordSize), itsFD(-1)
+{
+  ASKAPCHECK(recordSize > 0, "Record size of the column file "<<name<<" should be positive");
+  if (create) {
+      itsFD = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  } else {
+      itsFD = ::open(name.c_str(), O_RDONLY);
+  }
+  if (itsFD < 0) {
+      ASKAPTHROW(DataAccessError, "Unable to open column file "<<name<<": "<<std::strerror(errno));
+  }
+}
+
+/// @brief close the file
+ColumnFile::~ColumnFile()
+{
+  if (itsFD >= 0) {
+      ::close(itsFD);
+  }
+}
+
+/// @brief read a block of consecutive records
+/// @param[in] first index of the first record
+/// @param[in] nRecords number of records to read
+/// @param[out] buf buffer of at least nRecords * recordSize() bytes
+void ColumnFile::read(size_t first, size_t nRecords, void *buf) const
+{
+  char *ptr = static_cast<char*>(buf);
+  size_t remaining = nRecords * itsRecordSize;
+  off_t offset = static_cast<off_t>(first * itsRecordSize);
+  while (remaining > 0) {
+         const ssize_t done = ::pread(itsFD, ptr, remaining, offset);
+         if (done < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             ASKAPTHROW(DataAccessError, "Error reading column file "<<itsName<<": "<<std::strerror(errno));
+         }
+         if (done == 0) {
+             ASKAPTHROW(DataAccessError, "Column file "<<itsName<<" is too short, unable to read "<<
+                        nRecords<<" records starting from "<<first);
+         }
+         ptr += done;
+         offset += done;
+         remaining -= static_cast<size_t>(done);
+  }
+}
+
+/// @brief append a block of records to the end of the file
+/// @param[in] nRecords number of records to write
+/// @param[in] buf buffer with nRecords * recordSize() bytes
+void ColumnFile::append(size_t nRecords, const void *buf)
+{
+  const char *ptr = static_cast<const char*>(buf);
+  size_t remaining = nRecords * itsRecordSize;
+  while (remaining > 0) {
+         const ssize_t done = ::write(itsFD, ptr, remaining);
+         if (done < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             ASKAPTHROW(DataAccessError, "Error writing column file "<<itsName<<": "<<std::strerror(errno));
+         }
+         ptr += done;
+         remaining -= static_cast<size_t>(done);
+  }
+}
+
+/// @brief number of records in the file
+/// @return number of complete records
+size_t ColumnFile::nRecords() const
+{
+  struct stat info;
+  if (::fstat(itsFD, &info) != 0) {
+      ASKAPTHROW(DataAccessError, "Unable to obtain the size of column file "<<itsName<<": "<<std::strerror(errno));
+  }
+  return static_cast<size_t>(info.st_size) / itsRecordSize;
+}
+
+} // namespace accessors
+
+} // namespace askap
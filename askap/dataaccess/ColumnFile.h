@@ -0,0 +1,104 @@
+/// @file
+/// @brief flat binary file holding one column of the columnar visibility format
+/// @details The columnar format (see ColumnarDataSource) keeps each column in a separate
+/// file as a sequence of fixed-size records, one per row (or one per chunk for chunk-based
+/// columns). This class wraps a POSIX file descriptor and provides positioned reads and
+/// appends of whole blocks of records, so a chunk of consecutive rows is read by a single
+/// pread call without going through any per-row cell machinery.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_COLUMN_FILE_H
+#define ASKAP_ACCESSORS_COLUMN_FILE_H
+
+// std includes
+#include <string>
+#include <cstddef>
+
+// boost includes
+#include <boost/utility.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief flat binary file holding one column of the columnar visibility format
+/// @details Records have a fixed size given at construction, records are addressed by their
+/// index. The file is either opened for reading (read) or created for writing (append).
+/// Data are stored in the native byte order. The class is not copyable, the file is closed
+/// in the destructor.
+/// @ingroup dataaccess_hlp
+class ColumnFile : private boost::noncopyable
+{
+public:
+  /// @brief open the file
+  /// @param[in] name file name
+  /// @param[in] recordSize size of a record in bytes
+  /// @param[in] create if true, a new file is created (existing file is truncated) for writing,
+  ///            otherwise an existing file is opened for reading
+  ColumnFile(const std::string &name, size_t recordSize, bool create = false);
+
+  /// @brief close the file
+  ~ColumnFile();
+
+  /// @brief read a block of consecutive records
+  /// @param[in] first index of the first record
+  /// @param[in] nRecords number of records to read
+  /// @param[out] buf buffer of at least nRecords * recordSize() bytes
+  void read(size_t first, size_t nRecords, void *buf) const;
+
+  /// @brief append a block of records to the end of the file
+  /// @param[in] nRecords number of records to write
+  /// @param[in] buf buffer with nRecords * recordSize() bytes
+  void append(size_t nRecords, const void *buf);
+
+  /// @brief number of records in the file
+  /// @return number of complete records
+  size_t nRecords() const;
+
+  /// @brief size of a record
+  /// @return size of a record in bytes
+  inline size_t recordSize() const { return itsRecordSize; }
+
+  /// @brief file name
+  /// @return name of the file
+  inline const std::string& name() const { return itsName; }
+
+private:
+  /// @brief file name
+  std::string itsName;
+
+  /// @brief size of a record in bytes
+  size_t itsRecordSize;
+
+  /// @brief file descriptor
+  int itsFD;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLUMN_FILE_H
@@ -0,0 +1,247 @@
+/// @file
+/// @brief accessor to a chunk of the columnar visibility format
+/// @details This accessor holds the data of one chunk read by ColumnarDataIterator.
+/// The fields are filled by the iterator directly, rotated uvws and delays are computed
+/// on demand from uvws and pointing directions.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/ColumnarDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct an empty accessor
+/// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+/// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
+/// to initialisation of a new UVW Machine
+ColumnarDataAccessor::ColumnarDataAccessor(size_t cacheSize, double tolerance) :
+      itsTime(0.), itsRotatedUVW(cacheSize, tolerance) {}
+
+/// The number of rows in this chunk
+/// @return the number of rows in this chunk
+casacore::uInt ColumnarDataAccessor::nRow() const throw()
+{
+  return itsVisibility.nrow();
+}
+
+/// The number of spectral channels (equal for all rows)
+/// @return the number of spectral channels
+casacore::uInt ColumnarDataAccessor::nChannel() const throw()
+{
+  return itsVisibility.ncolumn();
+}
+
+/// The number of polarization products (equal for all rows)
+/// @return the number of polarization products (can be 1,2 or 4)
+casacore::uInt ColumnarDataAccessor::nPol() const throw()
+{
+  return itsVisibility.nplane();
+}
+
+/// First antenna IDs for all rows
+/// @return a vector with IDs of the first antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& ColumnarDataAccessor::antenna1() const
+{
+  return itsAntenna1;
+}
+
+/// Second antenna IDs for all rows
+/// @return a vector with IDs of the second antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& ColumnarDataAccessor::antenna2() const
+{
+  return itsAntenna2;
+}
+
+/// First feed IDs for all rows
+/// @return a vector with IDs of the first feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& ColumnarDataAccessor::feed1() const
+{
+  return itsFeed1;
+}
+
+/// Second feed IDs for all rows
+/// @return a vector with IDs of the second feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& ColumnarDataAccessor::feed2() const
+{
+  return itsFeed2;
+}
+
+/// Position angles of the first feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// first feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& ColumnarDataAccessor::feed1PA() const
+{
+  return itsFeed1PA;
+}
+
+/// Position angles of the second feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// second feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& ColumnarDataAccessor::feed2PA() const
+{
+  return itsFeed2PA;
+}
+
+/// Return pointing centre directions of the first antenna/feed
+/// @return a vector with direction measures (coordinate system
+/// is set via IDataConverter), one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& ColumnarDataAccessor::pointingDir1() const
+{
+  return itsPointingDir1;
+}
+
+/// Pointing centre directions of the second antenna/feed
+/// @return a vector with direction measures (coordinate system
+/// is is set via IDataConverter), one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& ColumnarDataAccessor::pointingDir2() const
+{
+  return itsPointingDir2;
+}
+
+/// pointing direction for the centre of the first antenna 
+/// @return a vector with direction measures (coordinate system
+/// is set via IDataConverter), one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& ColumnarDataAccessor::dishPointing1() const
+{
+  return itsDishPointing1;
+}
+
+/// pointing direction for the centre of the first antenna 
+/// @return a vector with direction measures (coordinate system
+/// is set via IDataConverter), one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& ColumnarDataAccessor::dishPointing2() const
+{
+  return itsDishPointing2;
+}
+
+/// Visibilities (a cube is nRow x nChannel x nPol; each element is
+/// a complex visibility)
+/// @return a reference to nRow x nChannel x nPol cube, containing
+/// all visibility data
+const casacore::Cube<casacore::Complex>& ColumnarDataAccessor::visibility() const
+{
+  return itsVisibility;
+}
+
+/// Cube of flags corresponding to the output of visibility() 
+/// @return a reference to nRow x nChannel x nPol cube with flag 
+///         information. If True, the corresponding element is flagged.
+const casacore::Cube<casacore::Bool>& ColumnarDataAccessor::flag() const
+{
+  return itsFlag;
+}
+
+/// UVW
+/// @return a reference to vector containing uvw-coordinates
+/// packed into a 3-D rigid vector
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& ColumnarDataAccessor::uvw() const
+{
+  return itsUVW;
+}
+
+/// @brief uvw after rotation
+/// @details This method calls UVWMachine to rotate baseline coordinates 
+/// for a new tangent point. Delays corresponding to this correction are
+/// returned by a separate method.
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return uvw after rotation to the new coordinate system for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+         ColumnarDataAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
+{
+  return itsRotatedUVW.uvw(*this, tangentPoint);
+}
+
+/// @brief delay associated with uvw rotation
+/// @details This is a companion method to rotatedUVW. It returns delays corresponding
+/// to the baseline coordinate rotation. 
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+/// @return delays corresponding to the uvw rotation for each row
+const casacore::Vector<casacore::Double>& ColumnarDataAccessor::uvwRotationDelay(
+         const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
+{
+  return itsRotatedUVW.delays(*this, tangentPoint, imageCentre);
+}
+
+/// Noise level required for a proper weighting
+/// @return a reference to nRow x nChannel x nPol cube with
+///         complex noise estimates
+const casacore::Cube<casacore::Complex>& ColumnarDataAccessor::noise() const
+{
+  return itsNoise;
+}
+
+/// Timestamp for each row
+/// @return a timestamp for this buffer (it is always the same
+///         for all rows. The timestamp is returned as 
+///         Double w.r.t. the origin specified by the 
+///         DataSource object and in that reference frame
+casacore::Double ColumnarDataAccessor::time() const
+{
+  return itsTime;
+}
+
+/// Frequency for each channel
+/// @return a reference to vector containing frequencies for each
+///         spectral channel (vector size is nChannel). Frequencies
+///         are given as Doubles, the frame/units are specified by
+///         the DataSource object
+const casacore::Vector<casacore::Double>& ColumnarDataAccessor::frequency() const
+{
+  return itsFrequency;
+}
+
+/// Velocity for each channel
+/// @note velocities are not supported by this accessor, an exception is thrown
+/// @return a reference to vector containing velocities for each
+///         spectral channel (vector size is nChannel)
+const casacore::Vector<casacore::Double>& ColumnarDataAccessor::velocity() const
+{
+  ASKAPTHROW(DataAccessLogicError, "ColumnarDataAccessor::velocity is not supported");
+}
+
+/// @brief polarisation type for each product
+/// @return a reference to vector containing polarisation types for
+/// each product in the visibility cube (nPol() elements).
+const casacore::Vector<casacore::Stokes::StokesTypes>& ColumnarDataAccessor::stokes() const
+{
+  return itsStokes;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,248 @@
+/// @file
+/// @brief accessor to a chunk of the columnar visibility format
+/// @details This accessor holds the data of one chunk read by ColumnarDataIterator.
+/// The fields are filled by the iterator directly, rotated uvws and delays are computed
+/// on demand from uvws and pointing directions.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_COLUMNAR_DATA_ACCESSOR_H
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/UVWRotationHandler.h>
+
+// boost includes
+#include <boost/utility.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+class ColumnarDataIterator;
+
+/// @brief accessor to a chunk of the columnar visibility format
+/// @details The accessor is owned by the iterator and is refilled at every step.
+/// @ingroup dataaccess_hlp
+class ColumnarDataAccessor : virtual public IConstDataAccessor,
+                             private boost::noncopyable
+{
+public:
+  /// @brief construct an empty accessor
+  /// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+  /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
+  /// to initialisation of a new UVW Machine
+  explicit ColumnarDataAccessor(size_t cacheSize = 1, double tolerance = 1e-6);
+
+  /// The number of rows in this chunk
+  /// @return the number of rows in this chunk
+  virtual casacore::uInt nRow() const throw();
+
+  /// The number of spectral channels (equal for all rows)
+  /// @return the number of spectral channels
+  virtual casacore::uInt nChannel() const throw();
+
+  /// The number of polarization products (equal for all rows)
+  /// @return the number of polarization products (can be 1,2 or 4)
+  virtual casacore::uInt nPol() const throw();
+
+  /// First antenna IDs for all rows
+  /// @return a vector with IDs of the first antenna corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& antenna1() const;
+
+  /// Second antenna IDs for all rows
+  /// @return a vector with IDs of the second antenna corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& antenna2() const;
+
+  /// First feed IDs for all rows
+  /// @return a vector with IDs of the first feed corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& feed1() const;
+
+  /// Second feed IDs for all rows
+  /// @return a vector with IDs of the second feed corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& feed2() const;
+
+  /// Position angles of the first feed for all rows
+  /// @return a vector with position angles (in radians) of the
+  /// first feed corresponding to each visibility
+  virtual const casacore::Vector<casacore::Float>& feed1PA() const;
+
+  /// Position angles of the second feed for all rows
+  /// @return a vector with position angles (in radians) of the
+  /// second feed corresponding to each visibility
+  virtual const casacore::Vector<casacore::Float>& feed2PA() const;
+
+  /// Return pointing centre directions of the first antenna/feed
+  /// @return a vector with direction measures (coordinate system
+  /// is set via IDataConverter), one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir1() const;
+
+  /// Pointing centre directions of the second antenna/feed
+  /// @return a vector with direction measures (coordinate system
+  /// is is set via IDataConverter), one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir2() const;
+
+  /// pointing direction for the centre of the first antenna 
+  /// @return a vector with direction measures (coordinate system
+  /// is set via IDataConverter), one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing1() const;
+
+  /// pointing direction for the centre of the first antenna 
+  /// @return a vector with direction measures (coordinate system
+  /// is set via IDataConverter), one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing2() const;
+
+  /// Visibilities (a cube is nRow x nChannel x nPol; each element is
+  /// a complex visibility)
+  /// @return a reference to nRow x nChannel x nPol cube, containing
+  /// all visibility data
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// Cube of flags corresponding to the output of visibility() 
+  /// @return a reference to nRow x nChannel x nPol cube with flag 
+  ///         information. If True, the corresponding element is flagged.
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+  /// UVW
+  /// @return a reference to vector containing uvw-coordinates
+  /// packed into a 3-D rigid vector
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+        uvw() const;
+
+  /// @brief uvw after rotation
+  /// @details This method calls UVWMachine to rotate baseline coordinates 
+  /// for a new tangent point. Delays corresponding to this correction are
+  /// returned by a separate method.
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @return uvw after rotation to the new coordinate system for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	         rotatedUVW(const casacore::MDirection &tangentPoint) const;
+
+  /// @brief delay associated with uvw rotation
+  /// @details This is a companion method to rotatedUVW. It returns delays corresponding
+  /// to the baseline coordinate rotation. 
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+  /// @return delays corresponding to the uvw rotation for each row
+  virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
+	         const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const;
+
+  /// Noise level required for a proper weighting
+  /// @return a reference to nRow x nChannel x nPol cube with
+  ///         complex noise estimates
+  virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// Timestamp for each row
+  /// @return a timestamp for this buffer (it is always the same
+  ///         for all rows. The timestamp is returned as 
+  ///         Double w.r.t. the origin specified by the 
+  ///         DataSource object and in that reference frame
+  virtual casacore::Double time() const;
+
+  /// Frequency for each channel
+  /// @return a reference to vector containing frequencies for each
+  ///         spectral channel (vector size is nChannel). Frequencies
+  ///         are given as Doubles, the frame/units are specified by
+  ///         the DataSource object
+  virtual const casacore::Vector<casacore::Double>& frequency() const;
+
+  /// Velocity for each channel
+  /// @note velocities are not supported by this accessor, an exception is thrown
+  /// @return a reference to vector containing velocities for each
+  ///         spectral channel (vector size is nChannel)
+  virtual const casacore::Vector<casacore::Double>& velocity() const;
+
+  /// @brief polarisation type for each product
+  /// @return a reference to vector containing polarisation types for
+  /// each product in the visibility cube (nPol() elements).
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const;
+
+private:
+  /// @brief the iterator fills the fields directly
+  friend class ColumnarDataIterator;
+
+  /// @brief synthetic chunks are generated directly into the fields
+  friend class SyntheticObservation;
+
+  /// @brief invalidate rotated uvws and delays
+  /// @details This method is called by the iterator after the fields have been refilled
+  inline void invalidate() { itsRotatedUVW.invalidate(); }
+
+  /// @brief first antenna indices
+  casacore::Vector<casacore::uInt> itsAntenna1;
+  /// @brief second antenna indices
+  casacore::Vector<casacore::uInt> itsAntenna2;
+  /// @brief first feed indices
+  casacore::Vector<casacore::uInt> itsFeed1;
+  /// @brief second feed indices
+  casacore::Vector<casacore::uInt> itsFeed2;
+  /// @brief parallactic angles of the first feed
+  casacore::Vector<casacore::Float> itsFeed1PA;
+  /// @brief parallactic angles of the second feed
+  casacore::Vector<casacore::Float> itsFeed2PA;
+  /// @brief pointing directions of the first feed
+  casacore::Vector<casacore::MVDirection> itsPointingDir1;
+  /// @brief pointing directions of the second feed
+  casacore::Vector<casacore::MVDirection> itsPointingDir2;
+  /// @brief dish pointing directions of the first antenna
+  casacore::Vector<casacore::MVDirection> itsDishPointing1;
+  /// @brief dish pointing directions of the second antenna
+  casacore::Vector<casacore::MVDirection> itsDishPointing2;
+  /// @brief visibilities
+  casacore::Cube<casacore::Complex> itsVisibility;
+  /// @brief flags
+  casacore::Cube<casacore::Bool> itsFlag;
+  /// @brief noise
+  casacore::Cube<casacore::Complex> itsNoise;
+  /// @brief uvw
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+  /// @brief time stamp
+  casacore::Double itsTime;
+  /// @brief frequencies
+  casacore::Vector<casacore::Double> itsFrequency;
+  /// @brief polarisation products
+  casacore::Vector<casacore::Stokes::StokesTypes> itsStokes;
+  /// @brief handler of rotated uvws and delays
+  UVWRotationHandler itsRotatedUVW;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_ACCESSOR_H
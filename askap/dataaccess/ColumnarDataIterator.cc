@@ -0,0 +1,376 @@
+/// @file
+/// @brief iterator over the columnar visibility format
+/// @details Each step of this iterator corresponds to one chunk of the data set. The rows
+/// of a chunk are consecutive in all column files, so each column is read by a single
+/// positioned read of the whole block. Row and channel selection is applied to the
+/// block in memory and the cubes are transposed into the accessor order.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/ColumnarDataIterator.h>
+#include <askap/dataaccess/CubeTransposer.h>
+#include <askap/dataaccess/IAntennaSubtableHandler.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Quanta/MVEpoch.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MFrequency.h>
+
+// std includes
+#include <cstring>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the iterator
+/// @param[in] dirName name of the data set directory
+/// @param[in] chunks index of all chunks of the data set
+/// @param[in] nChannel number of channels in the data set
+/// @param[in] stokes polarisation products of the data set
+/// @param[in] metadata metadata table manager (can be empty)
+/// @param[in] sel selector
+/// @param[in] conv converter
+ColumnarDataIterator::ColumnarDataIterator(const std::string &dirName, 
+                       const boost::shared_ptr<ChunkIndex const> &chunks,
+                       casacore::uInt nChannel, const casacore::Vector<casacore::Stokes::StokesTypes> &stokes,
+                       const boost::shared_ptr<ITableManager const> &metadata,
+                       const boost::shared_ptr<ColumnarDataSelector const> &sel,
+                       const boost::shared_ptr<IDataConverterImpl const> &conv) :
+       itsDirName(dirName), itsChunks(chunks), itsNChannel(nChannel), itsMetadata(metadata),
+       itsSelector(sel), itsTimeRange(0., 0.), itsStartChannel(0), itsNSelectedChannels(nChannel),
+       itsCurrentChunk(0), itsAllRows(true)
+{
+  ASKAPCHECK(itsChunks, "An attempt to initialise ColumnarDataIterator with empty chunk index");
+  ASKAPCHECK(itsSelector && conv, "An attempt to initialise ColumnarDataIterator with empty selector or converter");
+  itsConverter = conv->clone();
+  if (itsSelector->timeRangeSelected()) {
+      itsTimeRange = itsSelector->timeRange(*itsConverter);
+  }
+  if (itsSelector->channelsSelected()) {
+      itsStartChannel = itsSelector->startChannel();
+      itsNSelectedChannels = itsSelector->nChannel();
+      if (itsStartChannel + itsNSelectedChannels > itsNChannel) {
+          ASKAPTHROW(DataAccessError, "Channel selection (start = "<<itsStartChannel<<", nChan = "<<
+                     itsNSelectedChannels<<") exceeds the number of channels in the data set ("<<itsNChannel<<")");
+      }
+  }
+  itsAccessor.itsStokes.resize(stokes.nelements());
+  itsAccessor.itsStokes = stokes;
+
+  // all column files are opened once and read with positioned reads,
+  // empty data sets have no column files
+  if (itsChunks->size() > 0) {
+      const size_t nElements = size_t(itsNChannel) * stokes.nelements();
+      const std::string prefix = itsDirName + "/";
+      const char* indexNames[] = {"ANTENNA1", "ANTENNA2", "FEED1", "FEED2"};
+      for (size_t i = 0; i < sizeof(indexNames) / sizeof(indexNames[0]); ++i) {
+           itsColumns[indexNames[i]].reset(new ColumnFile(prefix + indexNames[i], sizeof(casacore::uInt)));
+      }
+      itsColumns["FEED1_PA"].reset(new ColumnFile(prefix + "FEED1_PA", sizeof(casacore::Float)));
+      itsColumns["FEED2_PA"].reset(new ColumnFile(prefix + "FEED2_PA", sizeof(casacore::Float)));
+      const char* dirNames[] = {"POINTING_DIR1", "POINTING_DIR2", "DISH_POINTING1", "DISH_POINTING2"};
+      for (size_t i = 0; i < sizeof(dirNames) / sizeof(dirNames[0]); ++i) {
+           itsColumns[dirNames[i]].reset(new ColumnFile(prefix + dirNames[i], 2 * sizeof(casacore::Double)));
+      }
+      itsColumns["UVW"].reset(new ColumnFile(prefix + "UVW", 3 * sizeof(casacore::Double)));
+      itsColumns["DATA"].reset(new ColumnFile(prefix + "DATA", nElements * sizeof(casacore::Complex)));
+      itsColumns["FLAG"].reset(new ColumnFile(prefix + "FLAG", nElements * sizeof(casacore::Bool)));
+      itsColumns["NOISE"].reset(new ColumnFile(prefix + "NOISE", nElements * sizeof(casacore::Complex)));
+      itsColumns["FREQUENCY"].reset(new ColumnFile(prefix + "FREQUENCY", itsNChannel * sizeof(casacore::Double)));
+  }
+  init();
+}
+
+/// @brief restart the iteration from the beginning
+void ColumnarDataIterator::init()
+{
+  itsCurrentChunk = 0;
+  findChunk();
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the current chunk
+const IConstDataAccessor& ColumnarDataIterator::operator*() const
+{
+  ASKAPCHECK(hasMore(), "ColumnarDataIterator: an attempt to access data past the end of the data set");
+  return itsAccessor;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool ColumnarDataIterator::hasMore() const throw()
+{
+  return itsCurrentChunk < itsChunks->size();
+}
+
+/// advance the iterator one step further 
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool ColumnarDataIterator::next()
+{
+  if (hasMore()) {
+      ++itsCurrentChunk;
+      findChunk();
+  }
+  return hasMore();
+}
+
+/// @brief find the next chunk passing the selection and read it
+/// @details The search starts from itsCurrentChunk
+void ColumnarDataIterator::findChunk()
+{
+  for (; hasMore(); ++itsCurrentChunk) {
+       if (chunkSelected(itsCurrentChunk) && readChunk()) {
+           break;
+       }
+  }
+}
+
+/// @brief check whether the chunk passes the chunk-based selection
+/// @param[in] chunk chunk number
+/// @return true, if the chunk is selected
+bool ColumnarDataIterator::chunkSelected(size_t chunk) const
+{
+  const ColumnarFormat::ChunkRecord &record = (*itsChunks)[chunk];
+  if (itsSelector->timeRangeSelected() && ((record.itsTime < itsTimeRange.first) || 
+      (record.itsTime > itsTimeRange.second))) {
+      return false;
+  }
+  return itsSelector->chunkSelected(chunk, record.itsScan);
+}
+
+/// @brief read the current chunk
+/// @return false, if no rows of the chunk are selected
+bool ColumnarDataIterator::readChunk()
+{
+  const ColumnarFormat::ChunkRecord &record = (*itsChunks)[itsCurrentChunk];
+  // row selection is based on the index and uvw columns, read them for all rows first
+  itsAllRows = true;
+  readVector("ANTENNA1", itsAccessor.itsAntenna1);
+  readVector("ANTENNA2", itsAccessor.itsAntenna2);
+  readVector("FEED1", itsAccessor.itsFeed1);
+  readVector("FEED2", itsAccessor.itsFeed2);
+  itsScratch.resize(size_t(record.itsNRow) * 3 * sizeof(casacore::Double));
+  readRows("UVW", 0, 3 * sizeof(casacore::Double), itsScratch.data());
+  const casacore::Double *uvwPtr = reinterpret_cast<const casacore::Double*>(itsScratch.data());
+  if (itsSelector->rowsSelected()) {
+      itsSelectedRows.clear();
+      for (casacore::uInt row = 0; row < record.itsNRow; ++row) {
+           if (itsSelector->rowSelected(itsAccessor.itsAntenna1[row], itsAccessor.itsAntenna2[row], 
+                 itsAccessor.itsFeed1[row], itsAccessor.itsFeed2[row], 
+                 casacore::RigidVector<casacore::Double, 3>(uvwPtr[3 * row], uvwPtr[3 * row + 1], uvwPtr[3 * row + 2]))) {
+               itsSelectedRows.push_back(row);
+           }
+      }
+      if (itsSelectedRows.size() == 0) {
+          return false;
+      }
+      if (itsSelectedRows.size() < record.itsNRow) {
+          itsAllRows = false;
+          // re-read the index columns for the selected rows only, they're small
+          readVector("ANTENNA1", itsAccessor.itsAntenna1);
+          readVector("ANTENNA2", itsAccessor.itsAntenna2);
+          readVector("FEED1", itsAccessor.itsFeed1);
+          readVector("FEED2", itsAccessor.itsFeed2);
+      }
+  } else if (record.itsNRow == 0) {
+      return false;
+  }
+  const casacore::uInt nRow = itsAllRows ? record.itsNRow : itsSelectedRows.size();
+  itsAccessor.itsUVW.resize(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       const casacore::Double *ptr = uvwPtr + 3 * (itsAllRows ? row : itsSelectedRows[row]);
+       itsAccessor.itsUVW[row] = casacore::RigidVector<casacore::Double, 3>(ptr[0], ptr[1], ptr[2]);
+  }
+  readVector("FEED1_PA", itsAccessor.itsFeed1PA);
+  readVector("FEED2_PA", itsAccessor.itsFeed2PA);
+  const casacore::MEpoch epoch(casacore::MVEpoch(record.itsTime / 86400.), 
+                               casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+  itsAccessor.itsTime = itsConverter->epoch(epoch);
+  readDirections("POINTING_DIR1", itsAccessor.itsAntenna1, epoch, itsAccessor.itsPointingDir1);
+  readDirections("POINTING_DIR2", itsAccessor.itsAntenna2, epoch, itsAccessor.itsPointingDir2);
+  readDirections("DISH_POINTING1", itsAccessor.itsAntenna1, epoch, itsAccessor.itsDishPointing1);
+  readDirections("DISH_POINTING2", itsAccessor.itsAntenna2, epoch, itsAccessor.itsDishPointing2);
+  readCube("DATA", itsAccessor.itsVisibility);
+  readCube("FLAG", itsAccessor.itsFlag);
+  readCube("NOISE", itsAccessor.itsNoise);
+  readFrequencies(epoch);
+  itsAccessor.invalidate();
+  return true;
+}
+
+/// @brief read the selected rows of the current chunk
+/// @details The selected part of each record is copied into consecutive memory.
+/// @param[in] name name of the column
+/// @param[in] offset offset of the selected part of the record in bytes
+/// @param[in] size size of the selected part of the record in bytes
+/// @param[out] out buffer of at least size times the number of selected rows bytes
+void ColumnarDataIterator::readRows(const std::string &name, size_t offset, size_t size, void *out)
+{
+  const ColumnarFormat::ChunkRecord &record = (*itsChunks)[itsCurrentChunk];
+  const ColumnFile &file = column(name);
+  const size_t recordSize = file.recordSize();
+  ASKAPDEBUGASSERT(offset + size <= recordSize);
+  if (itsAllRows && (size == recordSize)) {
+      // the most common case, no selection, read straight into the output
+      file.read(record.itsFirstRow, record.itsNRow, out);
+      return;
+  }
+  if (itsAllRows) {
+      itsBuffer.resize(size_t(record.itsNRow) * recordSize);
+      file.read(record.itsFirstRow, record.itsNRow, itsBuffer.data());
+      char *outPtr = static_cast<char*>(out);
+      for (casacore::uInt row = 0; row < record.itsNRow; ++row, outPtr += size) {
+           std::memcpy(outPtr, itsBuffer.data() + row * recordSize + offset, size);
+      }
+      return;
+  }
+  ASKAPDEBUGASSERT(itsSelectedRows.size() > 0);
+  // read the block from the first to the last selected row in one go
+  const casacore::uInt first = itsSelectedRows.front();
+  const size_t nRecords = itsSelectedRows.back() - first + 1;
+  itsBuffer.resize(nRecords * recordSize);
+  file.read(record.itsFirstRow + first, nRecords, itsBuffer.data());
+  char *outPtr = static_cast<char*>(out);
+  for (std::vector<casacore::uInt>::const_iterator ci = itsSelectedRows.begin(); 
+       ci != itsSelectedRows.end(); ++ci, outPtr += size) {
+       std::memcpy(outPtr, itsBuffer.data() + (*ci - first) * recordSize + offset, size);
+  }
+}
+
+/// @brief read a row-based column of scalars
+/// @param[in] name name of the column
+/// @param[out] vec vector to fill (resized to the number of selected rows)
+template<typename T>
+void ColumnarDataIterator::readVector(const std::string &name, casacore::Vector<T> &vec)
+{
+  const casacore::uInt nRow = itsAllRows ? (*itsChunks)[itsCurrentChunk].itsNRow : itsSelectedRows.size();
+  if ((vec.nelements() != nRow) || !vec.contiguousStorage()) {
+      vec.resize(nRow);
+  }
+  ASKAPDEBUGASSERT(column(name).recordSize() == sizeof(T));
+  readRows(name, 0, sizeof(T), vec.data());
+}
+
+/// @brief read a row-based column of cubes
+/// @param[in] name name of the column
+/// @param[out] cube cube to fill in the accessor order
+template<typename T>
+void ColumnarDataIterator::readCube(const std::string &name, casacore::Cube<T> &cube)
+{
+  const casacore::uInt nRow = itsAllRows ? (*itsChunks)[itsCurrentChunk].itsNRow : itsSelectedRows.size();
+  const casacore::uInt nPol = itsAccessor.itsStokes.nelements();
+  // records are nPol x nChannel matrices, a range of channels is contiguous
+  const size_t size = size_t(itsNSelectedChannels) * nPol * sizeof(T);
+  itsScratch.resize(size * nRow);
+  readRows(name, size_t(itsStartChannel) * nPol * sizeof(T), size, itsScratch.data());
+  const casacore::Cube<T> native(casacore::IPosition(3, nPol, itsNSelectedChannels, nRow), 
+                                 reinterpret_cast<T*>(itsScratch.data()), casacore::SHARE);
+  CubeTransposer::transpose(native, cube);
+}
+
+/// @brief read a row-based column of directions and convert them
+/// @param[in] name name of the column
+/// @param[in] antennas antenna indices for each row (used if the conversion needs positions)
+/// @param[in] epoch time of the chunk
+/// @param[out] dirs directions in the frame of the converter
+void ColumnarDataIterator::readDirections(const std::string &name, const casacore::Vector<casacore::uInt> &antennas,
+                      const casacore::MEpoch &epoch, casacore::Vector<casacore::MVDirection> &dirs)
+{
+  const casacore::uInt nRow = antennas.nelements();
+  itsScratch.resize(size_t(nRow) * 2 * sizeof(casacore::Double));
+  readRows(name, 0, 2 * sizeof(casacore::Double), itsScratch.data());
+  const casacore::Double *ptr = reinterpret_cast<const casacore::Double*>(itsScratch.data());
+  casacore::Vector<casacore::MVDirection> j2000(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row, ptr += 2) {
+       j2000[row] = casacore::MVDirection(ptr[0], ptr[1]);
+  }
+  const casacore::MDirection::Ref ref(casacore::MDirection::J2000);
+  if (itsConverter->directionNeedsPosition()) {
+      const IAntennaSubtableHandler &antennaSubtable = metadata().getAntenna();
+      dirs.resize(nRow);
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           itsConverter->setMeasFrame(casacore::MeasFrame(epoch, antennaSubtable.getPosition(antennas[row])));
+           itsConverter->direction(casacore::MDirection(j2000[row], ref), dirs[row]);
+      }
+  } else {
+      itsConverter->setMeasFrame(casacore::MeasFrame(epoch));
+      itsConverter->directions(ref, j2000, dirs);
+  }
+}
+
+/// @brief read the frequencies of the current chunk and convert them
+/// @param[in] epoch time of the chunk
+void ColumnarDataIterator::readFrequencies(const casacore::MEpoch &epoch)
+{
+  casacore::Vector<casacore::Double> freq(itsNChannel);
+  column("FREQUENCY").read(itsCurrentChunk, 1, freq.data());
+  if (itsSelector->channelsSelected()) {
+      freq.reference(freq(casacore::Slice(itsStartChannel, itsNSelectedChannels)).copy());
+  }
+  const casacore::MFrequency::Ref topo(casacore::MFrequency::TOPO);
+  if (itsConverter->isVoid(topo, casacore::Unit("Hz"))) {
+      itsAccessor.itsFrequency.reference(freq);
+  } else {
+      // as for the table-based iterator, the position of the first antenna and the dish pointing
+      // of the first row are used for the whole chunk. The pointing is taken in J2000 as stored.
+      const ColumnarFormat::ChunkRecord &record = (*itsChunks)[itsCurrentChunk];
+      casacore::Double dir[2];
+      column("DISH_POINTING1").read(record.itsFirstRow + (itsAllRows ? 0 : itsSelectedRows.front()), 1, dir);
+      itsConverter->setMeasFrame(casacore::MeasFrame(epoch, metadata().getAntenna().getPosition(0),
+                     casacore::MDirection(casacore::MVDirection(dir[0], dir[1]), casacore::MDirection::J2000)));
+      itsConverter->frequencies(topo, casacore::Unit("Hz"), freq, itsAccessor.itsFrequency);
+  }
+}
+
+/// @brief access a column file
+/// @param[in] name name of the column
+/// @return reference to the column file
+const ColumnFile& ColumnarDataIterator::column(const std::string &name) const
+{
+  const std::map<std::string, boost::shared_ptr<ColumnFile> >::const_iterator ci = itsColumns.find(name);
+  ASKAPDEBUGASSERT(ci != itsColumns.end());
+  ASKAPDEBUGASSERT(ci->second);
+  return *(ci->second);
+}
+
+/// @brief metadata table manager
+/// @return reference to the metadata, an exception is thrown if there is no metadata
+const ITableManager& ColumnarDataIterator::metadata() const
+{
+  if (!itsMetadata) {
+      ASKAPTHROW(DataAccessLogicError, "Requested conversion requires antenna positions, but the columnar data set "<<
+                 itsDirName<<" has no metadata table");
+  }
+  return *itsMetadata;
+}
+
+} // namespace accessors
+
+} // namespace askap
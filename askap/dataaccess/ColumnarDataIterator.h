@@ -0,0 +1,215 @@
+/// @file
+/// @brief iterator over the columnar visibility format
+/// @details Each step of this iterator corresponds to one chunk of the data set. The rows
+/// of a chunk are consecutive in all column files, so each column is read by a single
+/// positioned read of the whole block. Row and channel selection is applied to the
+/// block in memory and the cubes are transposed into the accessor order.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_COLUMNAR_DATA_ITERATOR_H
+
+// std includes
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/measures/Measures/MEpoch.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/IDataConverterImpl.h>
+#include <askap/dataaccess/ITableManager.h>
+#include <askap/dataaccess/ColumnarDataAccessor.h>
+#include <askap/dataaccess/ColumnarDataSelector.h>
+#include <askap/dataaccess/ColumnarFormat.h>
+#include <askap/dataaccess/ColumnFile.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iterator over the columnar visibility format
+/// @details Chunks which don't pass the chunk-based selection (time range, cycles, scan) 
+/// are skipped without reading, chunks without any row passing the row-based selection
+/// are skipped after reading the index columns. Time, frequencies and directions are 
+/// converted with the converter given at construction. Frequency conversion to a frame
+/// other than topocentric and direction conversion to topocentric frames require antenna
+/// positions, i.e. the metadata table.
+/// @ingroup dataaccess_hlp
+class ColumnarDataIterator : virtual public IConstDataIterator
+{
+public:
+  /// @brief index of the chunks
+  typedef std::vector<ColumnarFormat::ChunkRecord> ChunkIndex;
+
+  /// @brief construct the iterator
+  /// @param[in] dirName name of the data set directory
+  /// @param[in] chunks index of all chunks of the data set
+  /// @param[in] nChannel number of channels in the data set
+  /// @param[in] stokes polarisation products of the data set
+  /// @param[in] metadata metadata table manager (can be empty)
+  /// @param[in] sel selector
+  /// @param[in] conv converter
+  ColumnarDataIterator(const std::string &dirName, const boost::shared_ptr<ChunkIndex const> &chunks,
+                       casacore::uInt nChannel, const casacore::Vector<casacore::Stokes::StokesTypes> &stokes,
+                       const boost::shared_ptr<ITableManager const> &metadata,
+                       const boost::shared_ptr<ColumnarDataSelector const> &sel,
+                       const boost::shared_ptr<IDataConverterImpl const> &conv);
+
+  /// @brief restart the iteration from the beginning
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the current chunk
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+protected:
+  /// @brief find the next chunk passing the selection and read it
+  /// @details The search starts from itsCurrentChunk
+  void findChunk();
+
+  /// @brief check whether the chunk passes the chunk-based selection
+  /// @param[in] chunk chunk number
+  /// @return true, if the chunk is selected
+  bool chunkSelected(size_t chunk) const;
+
+  /// @brief read the current chunk
+  /// @return false, if no rows of the chunk are selected
+  bool readChunk();
+
+  /// @brief read the selected rows of the current chunk
+  /// @details The selected part of each record is copied into consecutive memory.
+  /// @param[in] name name of the column
+  /// @param[in] offset offset of the selected part of the record in bytes
+  /// @param[in] size size of the selected part of the record in bytes
+  /// @param[out] out buffer of at least size times the number of selected rows bytes
+  void readRows(const std::string &name, size_t offset, size_t size, void *out);
+
+  /// @brief read a row-based column of scalars
+  /// @param[in] name name of the column
+  /// @param[out] vec vector to fill (resized to the number of selected rows)
+  template<typename T>
+  void readVector(const std::string &name, casacore::Vector<T> &vec);
+
+  /// @brief read a row-based column of cubes
+  /// @param[in] name name of the column
+  /// @param[out] cube cube to fill in the accessor order
+  template<typename T>
+  void readCube(const std::string &name, casacore::Cube<T> &cube);
+
+  /// @brief read a row-based column of directions and convert them
+  /// @param[in] name name of the column
+  /// @param[in] antennas antenna indices for each row (used if the conversion needs positions)
+  /// @param[in] epoch time of the chunk
+  /// @param[out] dirs directions in the frame of the converter
+  void readDirections(const std::string &name, const casacore::Vector<casacore::uInt> &antennas,
+                      const casacore::MEpoch &epoch, casacore::Vector<casacore::MVDirection> &dirs);
+
+  /// @brief read the frequencies of the current chunk and convert them
+  /// @param[in] epoch time of the chunk
+  void readFrequencies(const casacore::MEpoch &epoch);
+
+  /// @brief access a column file
+  /// @param[in] name name of the column
+  /// @return reference to the column file
+  const ColumnFile& column(const std::string &name) const;
+
+  /// @brief metadata table manager
+  /// @return reference to the metadata, an exception is thrown if there is no metadata
+  const ITableManager& metadata() const;
+
+private:
+  /// @brief name of the data set directory
+  std::string itsDirName;
+
+  /// @brief index of all chunks
+  boost::shared_ptr<ChunkIndex const> itsChunks;
+
+  /// @brief number of channels in the data set
+  casacore::uInt itsNChannel;
+
+  /// @brief metadata table manager, may be empty
+  boost::shared_ptr<ITableManager const> itsMetadata;
+
+  /// @brief selector
+  boost::shared_ptr<ColumnarDataSelector const> itsSelector;
+
+  /// @brief converter (a private copy)
+  boost::shared_ptr<IDataConverterImpl> itsConverter;
+
+  /// @brief selected time range (MJD seconds, UTC), only used if a time range is selected
+  std::pair<casacore::Double, casacore::Double> itsTimeRange;
+
+  /// @brief first selected channel
+  casacore::uInt itsStartChannel;
+
+  /// @brief number of selected channels
+  casacore::uInt itsNSelectedChannels;
+
+  /// @brief number of the current chunk
+  size_t itsCurrentChunk;
+
+  /// @brief selected rows of the current chunk (relative to the first row of the chunk)
+  std::vector<casacore::uInt> itsSelectedRows;
+
+  /// @brief true, if all rows of the current chunk are selected
+  bool itsAllRows;
+
+  /// @brief column files
+  std::map<std::string, boost::shared_ptr<ColumnFile> > itsColumns;
+
+  /// @brief buffer for the raw records
+  std::vector<char> itsBuffer;
+
+  /// @brief buffer for the selected part of the records
+  std::vector<char> itsScratch;
+
+  /// @brief accessor filled at each step
+  ColumnarDataAccessor itsAccessor;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_ITERATOR_H
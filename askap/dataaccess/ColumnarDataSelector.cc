@@ -0,0 +1,276 @@
+/// @file
+/// @brief selector for the columnar visibility format
+/// @details Selection criteria are kept in this class and applied by ColumnarDataIterator
+/// while the chunks are read: chunk-based criteria (time range, cycles and scan number) 
+/// allow whole chunks to be skipped without reading them, row-based criteria (feeds,
+/// antennas, baselines and uv-distance) are checked using the index and uvw columns.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/ColumnarDataSelector.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MCEpoch.h>
+
+// std includes
+#include <cmath>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct a selector which selects everything
+ColumnarDataSelector::ColumnarDataSelector() : itsRowsSelected(false), itsFeed(-1), itsAntenna1(-1),
+      itsAntenna2(-1), itsAntenna(-1), itsAutoOnly(false), itsCrossOnly(false), itsMinUVDistance(-1.),
+      itsMaxUVDistance(-1.), itsNChannel(0), itsStartChannel(0), itsTimeSelection(NO_TIME_SELECTION),
+      itsRelativeRange(0., 0.), itsCyclesSelected(false), itsStartCycle(0), itsStopCycle(0), itsScan(-1) {}
+
+/// Choose a single feed, the same for both antennae
+/// @param[in] feedID the sequence number of feed to choose
+void ColumnarDataSelector::chooseFeed(casacore::uInt feedID)
+{
+  itsFeed = static_cast<int>(feedID);
+  itsRowsSelected = true;
+}
+
+/// Choose a baseline
+/// @param[in] ant1 the sequence number of the first antenna
+/// @param[in] ant2 the sequence number of the second antenna
+void ColumnarDataSelector::chooseBaseline(casacore::uInt ant1, casacore::uInt ant2)
+{
+  itsAntenna1 = static_cast<int>(ant1);
+  itsAntenna2 = static_cast<int>(ant2);
+  itsRowsSelected = true;
+}
+
+/// Choose all baselines to given antenna
+/// @param[in] ant the sequence number of antenna
+void ColumnarDataSelector::chooseAntenna(casacore::uInt ant)
+{
+  itsAntenna = static_cast<int>(ant);
+  itsRowsSelected = true;
+}
+
+/// Choose samples corresponding to a uniquely specified user-defined index
+/// @param[in] column name of the column
+/// @param[in] value the value to select
+void ColumnarDataSelector::chooseUserDefinedIndex(const std::string &, const casacore::uInt)
+{
+  notSupported("chooseUserDefinedIndex");
+}
+
+/// Choose autocorrelations only
+void ColumnarDataSelector::chooseAutoCorrelations()
+{
+  itsAutoOnly = true;
+  itsRowsSelected = true;
+}
+
+/// Choose crosscorrelations only
+void ColumnarDataSelector::chooseCrossCorrelations()
+{
+  itsCrossOnly = true;
+  itsRowsSelected = true;
+}
+
+/// Choose samples with the uv-distance larger than the given threshold
+/// @param[in] uvDist threshold in metres
+void ColumnarDataSelector::chooseMinUVDistance(casacore::Double uvDist)
+{
+  itsMinUVDistance = uvDist;
+  itsRowsSelected = true;
+}
+
+/// Choose samples with the uv-distance smaller than the given threshold
+/// @param[in] uvDist threshold in metres
+void ColumnarDataSelector::chooseMaxUVDistance(casacore::Double uvDist)
+{
+  itsMaxUVDistance = uvDist;
+  itsRowsSelected = true;
+}
+
+/// Choose a subset of spectral channels
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the number of the first spectral channel to choose
+/// @param[in] nAvg a number of adjacent spectral channels to average (should be 1)
+void ColumnarDataSelector::chooseChannels(casacore::uInt nChan, casacore::uInt start, casacore::uInt nAvg)
+{
+  ASKAPCHECK(nChan > 0, "At least one channel should be selected");
+  if (nAvg != 1) {
+      ASKAPTHROW(DataAccessLogicError, "Averaging of channels is not supported by ColumnarDataSelector, "
+                 "use ChannelAverager instead");
+  }
+  itsNChannel = nChan;
+  itsStartChannel = start;
+}
+
+/// Choose a subset of frequencies
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the frequency of the first spectral channel to choose
+/// @param[in] freqInc an increment in terms of the frequency
+void ColumnarDataSelector::chooseFrequencies(casacore::uInt, const casacore::MVFrequency &, const casacore::MVFrequency &)
+{
+  notSupported("chooseFrequencies");
+}
+
+/// Choose a subset of radial velocities
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the velocity of the first spectral channel to choose
+/// @param[in] velInc an increment in terms of the radial velocity
+void ColumnarDataSelector::chooseVelocities(casacore::uInt, const casacore::MVRadialVelocity &, const casacore::MVRadialVelocity &)
+{
+  notSupported("chooseVelocities");
+}
+
+/// Choose a single spectral window (also known as IF)
+/// @param[in] spWinID the ID of the spectral window to choose
+void ColumnarDataSelector::chooseSpectralWindow(casacore::uInt)
+{
+  notSupported("chooseSpectralWindow");
+}
+
+/// Choose a time range given as epochs
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop the end of the chosen time interval
+void ColumnarDataSelector::chooseTimeRange(const casacore::MVEpoch &start, const casacore::MVEpoch &stop)
+{
+  itsEpochRange = std::make_pair(start, stop);
+  itsTimeSelection = EPOCH_TIME_SELECTION;
+}
+
+/// Choose a time range with respect to the origin defined by the data source
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop the end of the chosen time interval
+void ColumnarDataSelector::chooseTimeRange(casacore::Double start, casacore::Double stop)
+{
+  itsRelativeRange = std::make_pair(start, stop);
+  itsTimeSelection = RELATIVE_TIME_SELECTION;
+}
+
+/// Choose polarization
+/// @param[in] pols a string describing the wanted polarization in the output
+void ColumnarDataSelector::choosePolarizations(const casacore::String &)
+{
+  notSupported("choosePolarizations");
+}
+
+/// Choose cycles
+/// @param[in] start the number of the first cycle to choose
+/// @param[in] stop the number of the last cycle to choose
+void ColumnarDataSelector::chooseCycles(casacore::uInt start, casacore::uInt stop)
+{
+  ASKAPCHECK(start <= stop, "The first cycle "<<start<<" is after the last one "<<stop<<
+             " in chooseCycles");
+  itsCyclesSelected = true;
+  itsStartCycle = start;
+  itsStopCycle = stop;
+}
+
+/// Choose a single scan number
+/// @param[in] scanNumber the scan number to choose
+void ColumnarDataSelector::chooseScanNumber(casacore::uInt scanNumber)
+{
+  itsScan = scanNumber;
+}
+
+/// @brief check a row against the row-based criteria
+/// @param[in] ant1 first antenna
+/// @param[in] ant2 second antenna
+/// @param[in] feed1 first feed
+/// @param[in] feed2 second feed
+/// @param[in] uvw baseline coordinates in metres
+/// @return true, if the row is selected
+bool ColumnarDataSelector::rowSelected(casacore::uInt ant1, casacore::uInt ant2, casacore::uInt feed1, 
+                   casacore::uInt feed2, const casacore::RigidVector<casacore::Double, 3> &uvw) const
+{
+  if ((itsFeed >= 0) && ((int(feed1) != itsFeed) || (int(feed2) != itsFeed))) {
+      return false;
+  }
+  if ((itsAntenna1 >= 0) && ((int(ant1) != itsAntenna1) || (int(ant2) != itsAntenna2))) {
+      return false;
+  }
+  if ((itsAntenna >= 0) && (int(ant1) != itsAntenna) && (int(ant2) != itsAntenna)) {
+      return false;
+  }
+  if ((itsAutoOnly && (ant1 != ant2)) || (itsCrossOnly && (ant1 == ant2))) {
+      return false;
+  }
+  if ((itsMinUVDistance >= 0.) || (itsMaxUVDistance >= 0.)) {
+      const casacore::Double uvDist = std::sqrt(uvw(0) * uvw(0) + uvw(1) * uvw(1));
+      if ((itsMinUVDistance >= 0.) && (uvDist < itsMinUVDistance)) {
+          return false;
+      }
+      if ((itsMaxUVDistance >= 0.) && (uvDist > itsMaxUVDistance)) {
+          return false;
+      }
+  }
+  return true;
+}
+
+/// @brief check a chunk against the chunk-based criteria except the time range
+/// @param[in] cycle number of the chunk
+/// @param[in] scan scan number of the chunk
+/// @return true, if the chunk is selected
+bool ColumnarDataSelector::chunkSelected(casacore::uInt64 cycle, casacore::uInt scan) const
+{
+  if (itsCyclesSelected && ((cycle < itsStartCycle) || (cycle > itsStopCycle))) {
+      return false;
+  }
+  return (itsScan < 0) || (casacore::Int64(scan) == itsScan);
+}
+
+/// @brief selected time range in the frame of the columnar format
+/// @param[in] conv converter used to interpret the selection
+/// @return start and stop as MJD in seconds (UTC)
+std::pair<casacore::Double, casacore::Double> ColumnarDataSelector::timeRange(const IDataConverterImpl &conv) const
+{
+  ASKAPDEBUGASSERT(itsTimeSelection != NO_TIME_SELECTION);
+  casacore::MEpoch start, stop;
+  if (itsTimeSelection == EPOCH_TIME_SELECTION) {
+      start = conv.epochMeasure(itsEpochRange.first);
+      stop = conv.epochMeasure(itsEpochRange.second);
+  } else {
+      start = conv.epochMeasure(itsRelativeRange.first);
+      stop = conv.epochMeasure(itsRelativeRange.second);
+  }
+  const casacore::MEpoch::Ref utc(casacore::MEpoch::UTC);
+  return std::make_pair(casacore::MEpoch::Convert(start, utc)().getValue().get() * 86400.,
+                        casacore::MEpoch::Convert(stop, utc)().getValue().get() * 86400.);
+}
+
+/// @brief report unsupported selection
+/// @param[in] what name of the selection method
+void ColumnarDataSelector::notSupported(const std::string &what)
+{
+  ASKAPTHROW(DataAccessLogicError, "ColumnarDataSelector::"<<what<<" - selection is not supported by the "
+             "columnar data source");
+}
+
+} // namespace accessors
+
+} // namespace askap
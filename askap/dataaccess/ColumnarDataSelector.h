@@ -0,0 +1,255 @@
+/// @file
+/// @brief selector for the columnar visibility format
+/// @details Selection criteria are kept in this class and applied by ColumnarDataIterator
+/// while the chunks are read: chunk-based criteria (time range, cycles and scan number) 
+/// allow whole chunks to be skipped without reading them, row-based criteria (feeds,
+/// antennas, baselines and uv-distance) are checked using the index and uvw columns.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_SELECTOR_H
+#define ASKAP_ACCESSORS_COLUMNAR_DATA_SELECTOR_H
+
+// std includes
+#include <string>
+#include <utility>
+
+// casa includes
+#include <casacore/casa/Quanta/MVEpoch.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// own includes
+#include <askap/dataaccess/IDataSelector.h>
+#include <askap/dataaccess/IDataConverterImpl.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief selector for the columnar visibility format
+/// @details Selections by feed, antenna, baseline, correlation type, uv-distance, channels
+/// (without averaging), time range, cycles and scan number are supported. Different criteria
+/// are combined with logical "and". Spectral window, frequency, velocity, polarisation and
+/// user-defined index selections are not supported and result in DataAccessLogicError
+/// (polarisation conversion can be done with PolConvertingAccessor). Cycles are counted
+/// in chunks of the data set.
+/// @ingroup dataaccess_hlp
+class ColumnarDataSelector : virtual public IDataSelector
+{
+public:
+  /// @brief construct a selector which selects everything
+  ColumnarDataSelector();
+
+  /// Choose a single feed, the same for both antennae
+  /// @param[in] feedID the sequence number of feed to choose
+  virtual void chooseFeed(casacore::uInt feedID);
+
+  /// Choose a baseline
+  /// @param[in] ant1 the sequence number of the first antenna
+  /// @param[in] ant2 the sequence number of the second antenna
+  virtual void chooseBaseline(casacore::uInt ant1, casacore::uInt ant2);
+
+  /// Choose all baselines to given antenna
+  /// @param[in] ant the sequence number of antenna
+  virtual void chooseAntenna(casacore::uInt ant);
+
+  /// Choose samples corresponding to a uniquely specified user-defined index
+  /// @param[in] column name of the column
+  /// @param[in] value the value to select
+  virtual void chooseUserDefinedIndex(const std::string &column, const casacore::uInt value);
+
+  /// Choose autocorrelations only
+  virtual void chooseAutoCorrelations();
+
+  /// Choose crosscorrelations only
+  virtual void chooseCrossCorrelations();
+
+  /// Choose samples with the uv-distance larger than the given threshold
+  /// @param[in] uvDist threshold in metres
+  virtual void chooseMinUVDistance(casacore::Double uvDist);
+
+  /// Choose samples with the uv-distance smaller than the given threshold
+  /// @param[in] uvDist threshold in metres
+  virtual void chooseMaxUVDistance(casacore::Double uvDist);
+
+  /// Choose a subset of spectral channels
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the number of the first spectral channel to choose
+  /// @param[in] nAvg a number of adjacent spectral channels to average (should be 1)
+  virtual void chooseChannels(casacore::uInt nChan, casacore::uInt start, casacore::uInt nAvg = 1);
+
+  /// Choose a subset of frequencies
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the frequency of the first spectral channel to choose
+  /// @param[in] freqInc an increment in terms of the frequency
+  virtual void chooseFrequencies(casacore::uInt nChan, const casacore::MVFrequency &start, const casacore::MVFrequency &freqInc);
+
+  /// Choose a subset of radial velocities
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the velocity of the first spectral channel to choose
+  /// @param[in] velInc an increment in terms of the radial velocity
+  virtual void chooseVelocities(casacore::uInt nChan, const casacore::MVRadialVelocity &start, const casacore::MVRadialVelocity &velInc);
+
+  /// Choose a single spectral window (also known as IF)
+  /// @param[in] spWinID the ID of the spectral window to choose
+  virtual void chooseSpectralWindow(casacore::uInt spWinID);
+
+  /// Choose a time range given as epochs
+  /// @param[in] start the beginning of the chosen time interval
+  /// @param[in] stop the end of the chosen time interval
+  virtual void chooseTimeRange(const casacore::MVEpoch &start, const casacore::MVEpoch &stop);
+
+  /// Choose a time range with respect to the origin defined by the data source
+  /// @param[in] start the beginning of the chosen time interval
+  /// @param[in] stop the end of the chosen time interval
+  virtual void chooseTimeRange(casacore::Double start, casacore::Double stop);
+
+  /// Choose polarization
+  /// @param[in] pols a string describing the wanted polarization in the output
+  virtual void choosePolarizations(const casacore::String &pols);
+
+  /// Choose cycles
+  /// @param[in] start the number of the first cycle to choose
+  /// @param[in] stop the number of the last cycle to choose
+  virtual void chooseCycles(casacore::uInt start, casacore::uInt stop);
+
+  /// Choose a single scan number
+  /// @param[in] scanNumber the scan number to choose
+  virtual void chooseScanNumber(casacore::uInt scanNumber);
+
+  /// @brief check whether any row-based selection has been done
+  /// @return true, if rowSelected needs to be called for each row
+  inline bool rowsSelected() const { return itsRowsSelected; }
+
+  /// @brief check a row against the row-based criteria
+  /// @param[in] ant1 first antenna
+  /// @param[in] ant2 second antenna
+  /// @param[in] feed1 first feed
+  /// @param[in] feed2 second feed
+  /// @param[in] uvw baseline coordinates in metres
+  /// @return true, if the row is selected
+  bool rowSelected(casacore::uInt ant1, casacore::uInt ant2, casacore::uInt feed1, casacore::uInt feed2,
+                   const casacore::RigidVector<casacore::Double, 3> &uvw) const;
+
+  /// @brief check a chunk against the chunk-based criteria except the time range
+  /// @param[in] cycle number of the chunk
+  /// @param[in] scan scan number of the chunk
+  /// @return true, if the chunk is selected
+  bool chunkSelected(casacore::uInt64 cycle, casacore::uInt scan) const;
+
+  /// @brief check whether a time range has been selected
+  /// @return true, if timeRange should be used
+  inline bool timeRangeSelected() const { return itsTimeSelection != NO_TIME_SELECTION; }
+
+  /// @brief selected time range in the frame of the columnar format
+  /// @param[in] conv converter used to interpret the selection
+  /// @return start and stop as MJD in seconds (UTC)
+  std::pair<casacore::Double, casacore::Double> timeRange(const IDataConverterImpl &conv) const;
+
+  /// @brief check whether a subset of channels has been selected
+  /// @return true, if a subset of channels has been selected
+  inline bool channelsSelected() const { return itsNChannel > 0; }
+
+  /// @brief number of selected channels
+  /// @return number of channels (zero if all channels are selected)
+  inline casacore::uInt nChannel() const { return itsNChannel; }
+
+  /// @brief first selected channel
+  /// @return the first channel of the selection
+  inline casacore::uInt startChannel() const { return itsStartChannel; }
+
+protected:
+  /// @brief report unsupported selection
+  /// @param[in] what name of the selection method
+  static void notSupported(const std::string &what);
+
+private:
+  /// @brief type of the time selection
+  enum TimeSelection {
+     NO_TIME_SELECTION,
+     EPOCH_TIME_SELECTION,
+     RELATIVE_TIME_SELECTION
+  };
+
+  /// @brief true, if any row-based selection has been done
+  bool itsRowsSelected;
+
+  /// @brief selected feed or -1
+  int itsFeed;
+
+  /// @brief selected first antenna of the baseline or -1
+  int itsAntenna1;
+
+  /// @brief selected second antenna of the baseline or -1
+  int itsAntenna2;
+
+  /// @brief antenna all baselines to which are selected or -1
+  int itsAntenna;
+
+  /// @brief true, if only auto-correlations are selected
+  bool itsAutoOnly;
+
+  /// @brief true, if only cross-correlations are selected
+  bool itsCrossOnly;
+
+  /// @brief minimum uv-distance (metres), negative if not selected
+  casacore::Double itsMinUVDistance;
+
+  /// @brief maximum uv-distance (metres), negative if not selected
+  casacore::Double itsMaxUVDistance;
+
+  /// @brief number of selected channels, zero if all channels are selected
+  casacore::uInt itsNChannel;
+
+  /// @brief first selected channel
+  casacore::uInt itsStartChannel;
+
+  /// @brief type of the time selection
+  TimeSelection itsTimeSelection;
+
+  /// @brief selected time range given as epochs
+  std::pair<casacore::MVEpoch, casacore::MVEpoch> itsEpochRange;
+
+  /// @brief selected time range with respect to the origin of the converter
+  std::pair<casacore::Double, casacore::Double> itsRelativeRange;
+
+  /// @brief true, if cycles are selected
+  bool itsCyclesSelected;
+
+  /// @brief first selected cycle
+  casacore::uInt itsStartCycle;
+
+  /// @brief last selected cycle
+  casacore::uInt itsStopCycle;
+
+  /// @brief selected scan number or -1
+  casacore::Int64 itsScan;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_SELECTOR_H
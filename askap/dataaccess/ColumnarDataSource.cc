@@ -0,0 +1,138 @@
+/// @file
+/// @brief data source for the columnar visibility format
+/// @details The columnar format (see ColumnarFormat) is an alternative to the measurement set,
+/// which keeps each column in a flat binary file with fixed-size records. Chunks are read with
+/// a single positioned read per column instead of the per-row cell access of casacore tables.
+/// The data sets are created by ColumnarDataWriter (e.g. via the msToColumnar application).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_SOURCE_H
+
+#include <askap/dataaccess/ColumnarDataSource.h>
+#include <askap/dataaccess/ColumnarDataIterator.h>
+#include <askap/dataaccess/ColumnarDataSelector.h>
+#include <askap/dataaccess/ColumnFile.h>
+#include <askap/dataaccess/BasicDataConverter.h>
+#include <askap/dataaccess/TableManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapUtil.h>
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief open the data set
+/// @param[in] dirName name of the data set directory
+ColumnarDataSource::ColumnarDataSource(const std::string &dirName) : itsDirName(dirName), itsNRow(0), 
+        itsNChannel(0)
+{
+  const LOFAR::ParameterSet header(dirName + "/" + ColumnarFormat::headerName());
+  const int version = header.getInt("version");
+  if (version != ColumnarFormat::theirVersion) {
+      ASKAPTHROW(DataAccessError, "Unsupported version "<<version<<" of the columnar data set "<<dirName);
+  }
+  itsNRow = utility::fromString<casacore::uInt64>(header.getString("nrow"));
+  const casacore::uInt64 nChunk = utility::fromString<casacore::uInt64>(header.getString("nchunk"));
+  itsNChannel = header.getUint("nchan");
+  const std::vector<std::string> stokes = header.getStringVector("stokes", std::vector<std::string>());
+  ASKAPCHECK(stokes.size() == header.getUint("npol"), "Header of the columnar data set "<<dirName<<
+             " is corrupted, the number of polarisation products doesn't match the list of products");
+  itsStokes.resize(stokes.size());
+  for (size_t pol = 0; pol < stokes.size(); ++pol) {
+       itsStokes[pol] = casacore::Stokes::type(stokes[pol]);
+  }
+
+  boost::shared_ptr<std::vector<ColumnarFormat::ChunkRecord> > chunks(new std::vector<ColumnarFormat::ChunkRecord>);
+  if (nChunk > 0) {
+      const ColumnFile index(dirName + "/" + ColumnarFormat::chunkIndexName(), sizeof(ColumnarFormat::ChunkRecord));
+      ASKAPCHECK(index.nRecords() == nChunk, "Chunk index of the columnar data set "<<dirName<<" has "<<
+                 index.nRecords()<<" records, "<<nChunk<<" are expected");
+      chunks->resize(nChunk);
+      index.read(0, nChunk, chunks->data());
+  }
+  itsChunks = chunks;
+
+  const std::string metaName = dirName + "/" + ColumnarFormat::metadataName();
+  if (casacore::Table::isReadable(metaName)) {
+      itsMetadata.reset(new TableManager(casacore::Table(metaName), SubtableInfoHolder::MEMORY_BUFFERS));
+  }
+}
+
+/// @brief create a converter object corresponding to this type of the DataSource
+/// @return a shared pointer to a new DataConverter object
+IDataConverterPtr ColumnarDataSource::createConverter() const
+{
+  return IDataConverterPtr(new BasicDataConverter);
+}
+
+/// @brief get iterator over a selected part of the dataset
+/// @param[in] sel a shared pointer to the selector object (should be created by this data source)
+/// @param[in] conv a shared pointer to the converter object
+/// @return a shared pointer to ColumnarDataIterator object
+boost::shared_ptr<IConstDataIterator> ColumnarDataSource::createConstIterator(const
+	           IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv) const
+{
+  const boost::shared_ptr<ColumnarDataSelector const> implSel =
+           boost::dynamic_pointer_cast<ColumnarDataSelector const>(sel);
+  const boost::shared_ptr<IDataConverterImpl const> implConv =
+           boost::dynamic_pointer_cast<IDataConverterImpl const>(conv);
+  if (!implSel || !implConv) {
+      ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
+                 "converter are received by the createConstIterator method");
+  }
+  return boost::shared_ptr<IConstDataIterator>(new ColumnarDataIterator(itsDirName, itsChunks, itsNChannel,
+                 itsStokes, itsMetadata, implSel, implConv));
+}
+
+/// @brief create a selector object corresponding to this type of the DataSource
+/// @return a shared pointer to ColumnarDataSelector
+IDataSelectorPtr ColumnarDataSource::createSelector() const
+{
+  return IDataSelectorPtr(new ColumnarDataSelector);
+}
+
+/// @brief access to the metadata
+/// @details The table manager gives access to the subtables of the measurement set 
+/// the data set has been converted from (an exception is thrown if there is no metadata)
+/// @return reference to the table manager
+const ITableManager& ColumnarDataSource::metadata() const
+{
+  if (!itsMetadata) {
+      ASKAPTHROW(DataAccessLogicError, "Columnar data set "<<itsDirName<<" has no metadata table");
+  }
+  return *itsMetadata;
+}
+
+} // namespace accessors
+
+} // namespace askap
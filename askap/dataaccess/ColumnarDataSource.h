@@ -0,0 +1,139 @@
+/// @file
+/// @brief data source for the columnar visibility format
+/// @details The columnar format (see ColumnarFormat) is an alternative to the measurement set,
+/// which keeps each column in a flat binary file with fixed-size records. Chunks are read with
+/// a single positioned read per column instead of the per-row cell access of casacore tables.
+/// The data sets are created by ColumnarDataWriter (e.g. via the msToColumnar application).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_COLUMNAR_DATA_SOURCE_H
+
+// std includes
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/measures/Measures/Stokes.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/ITableManager.h>
+#include <askap/dataaccess/ColumnarFormat.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief data source for the columnar visibility format
+/// @details The data source is read-only. Selectors created by this class support a subset
+/// of the selection criteria (see ColumnarDataSelector), converters are the usual 
+/// BasicDataConverter. Each chunk of the data set (i.e. each iteration of the iterator the 
+/// data set has been written from) is delivered as one iteration. If the data set has the
+/// metadata table, the subtables of the original measurement set are available via 
+/// metadata().
+/// @ingroup dataaccess_hlp
+class ColumnarDataSource : virtual public IConstDataSource
+{
+public:
+  /// @brief open the data set
+  /// @param[in] dirName name of the data set directory
+  explicit ColumnarDataSource(const std::string &dirName);
+
+  /// @brief create a converter object corresponding to this type of the DataSource
+  /// @return a shared pointer to a new DataConverter object
+  virtual IDataConverterPtr createConverter() const;
+
+  /// @brief get iterator over a selected part of the dataset
+  /// @param[in] sel a shared pointer to the selector object (should be created by this data source)
+  /// @param[in] conv a shared pointer to the converter object
+  /// @return a shared pointer to ColumnarDataIterator object
+  virtual boost::shared_ptr<IConstDataIterator> createConstIterator(const
+	           IDataSelectorConstPtr &sel, const
+		   IDataConverterConstPtr &conv) const;
+
+  // we need this to get access to the overloaded syntax in the base class
+  using IConstDataSource::createConstIterator;
+
+  /// @brief create a selector object corresponding to this type of the DataSource
+  /// @return a shared pointer to ColumnarDataSelector
+  virtual IDataSelectorPtr createSelector() const;
+
+  /// @brief number of rows in the data set
+  /// @return total number of rows
+  inline casacore::uInt64 nRow() const { return itsNRow; }
+
+  /// @brief number of chunks in the data set
+  /// @return total number of chunks
+  inline size_t nChunk() const { return itsChunks->size(); }
+
+  /// @brief number of channels
+  /// @return number of spectral channels (the same for all chunks)
+  inline casacore::uInt nChannel() const { return itsNChannel; }
+
+  /// @brief polarisation products
+  /// @return polarisation types (the same for all chunks)
+  inline const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const { return itsStokes; }
+
+  /// @brief check whether the metadata table is available
+  /// @return true, if the data set has the metadata table
+  inline bool hasMetadata() const { return itsMetadata.get() != NULL; }
+
+  /// @brief access to the metadata
+  /// @details The table manager gives access to the subtables of the measurement set 
+  /// the data set has been converted from (an exception is thrown if there is no metadata)
+  /// @return reference to the table manager
+  const ITableManager& metadata() const;
+
+private:
+  /// @brief name of the data set directory
+  std::string itsDirName;
+
+  /// @brief number of rows
+  casacore::uInt64 itsNRow;
+
+  /// @brief number of channels
+  casacore::uInt itsNChannel;
+
+  /// @brief polarisation products
+  casacore::Vector<casacore::Stokes::StokesTypes> itsStokes;
+
+  /// @brief index of all chunks
+  boost::shared_ptr<std::vector<ColumnarFormat::ChunkRecord> const> itsChunks;
+
+  /// @brief metadata table manager, empty if there is no metadata
+  boost::shared_ptr<ITableManager const> itsMetadata;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_SOURCE_H
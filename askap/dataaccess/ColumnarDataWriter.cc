@@ -0,0 +1,263 @@
+/// @file
+/// @brief writer of the columnar visibility format
+/// @details This class writes the data delivered by accessors into the columnar format 
+/// (see ColumnarFormat) chunk by chunk, so any data source can be converted. It is used by
+/// the msToColumnar application, which converts measurement sets.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/ColumnarDataWriter.h>
+#include <askap/dataaccess/ColumnarFormat.h>
+#include <askap/dataaccess/CubeTransposer.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapUtil.h>
+
+// casa includes
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MFrequency.h>
+#include <casacore/measures/Measures/Stokes.h>
+#include <casacore/tables/Tables/TableCopy.h>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+// std includes
+#include <cstring>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief create a new data set
+/// @details The directory is created if it doesn't exist, existing column files are
+/// overwritten.
+/// @param[in] dirName name of the directory
+ColumnarDataWriter::ColumnarDataWriter(const std::string &dirName) : itsDirName(dirName),
+         itsNChannel(0), itsNRow(0), itsNChunk(0), itsClosed(false)
+{
+  const casacore::File file(dirName);
+  if (file.exists()) {
+      ASKAPCHECK(file.isDirectory(), "Unable to create columnar data set: "<<dirName<<" exists and is not a directory");
+  } else {
+      casacore::Directory(dirName).create();
+  }
+}
+
+/// @brief close the data set
+/// @details The header is written if close has not been called
+ColumnarDataWriter::~ColumnarDataWriter()
+{
+  try {
+     if (!itsClosed) {
+         close();
+     }
+  }
+  catch (...) {
+     // nothing can be done at this stage
+  }
+}
+
+/// @brief set up a converter to deliver the data in the frames of the columnar format
+/// @param[in] conv converter of the source data source to set up
+void ColumnarDataWriter::configureConverter(IDataConverter &conv)
+{
+  // MJD 0 UTC as the origin, seconds
+  conv.setEpochFrame();
+  conv.setDirectionFrame(casacore::MDirection::Ref(casacore::MDirection::J2000));
+  conv.setFrequencyFrame(casacore::MFrequency::Ref(casacore::MFrequency::TOPO), "Hz");
+}
+
+/// @brief copy the subtables of the measurement set
+/// @details A table without rows having the same subtables as the given measurement set
+/// is created in the data set, so the metadata are available via ITableManager.
+/// @param[in] ms measurement set the data are converted from
+void ColumnarDataWriter::copyMetadata(const casacore::Table &ms)
+{
+  ASKAPCHECK(!itsClosed, "ColumnarDataWriter has already been closed");
+  casacore::Table meta = casacore::TableCopy::makeEmptyTable(itsDirName + "/" + ColumnarFormat::metadataName(),
+            casacore::Record(), ms, casacore::Table::New, casacore::Table::AipsrcEndian, casacore::True, casacore::True);
+  casacore::TableCopy::copySubTables(meta, ms);
+}
+
+/// @brief append a chunk
+/// @param[in] acc accessor with the data of the chunk
+/// @param[in] scan scan number of the chunk
+void ColumnarDataWriter::write(const IConstDataAccessor &acc, casacore::uInt scan)
+{
+  ASKAPCHECK(!itsClosed, "ColumnarDataWriter has already been closed");
+  if (itsColumns.empty()) {
+      createColumns(acc);
+  }
+  if ((acc.nChannel() != itsNChannel) || (acc.nPol() != itsStokes.nelements())) {
+      ASKAPTHROW(DataAccessError, "Columnar format requires the same number of channels and polarisations for "
+                 "all chunks, chunk "<<itsNChunk<<" has "<<acc.nChannel()<<" channels and "<<acc.nPol()<<
+                 " polarisations, the data set has "<<itsNChannel<<" and "<<itsStokes.nelements());
+  }
+  const casacore::uInt nRow = acc.nRow();
+  appendVector("ANTENNA1", acc.antenna1());
+  appendVector("ANTENNA2", acc.antenna2());
+  appendVector("FEED1", acc.feed1());
+  appendVector("FEED2", acc.feed2());
+  appendVector("FEED1_PA", acc.feed1PA());
+  appendVector("FEED2_PA", acc.feed2PA());
+  appendDirections("POINTING_DIR1", acc.pointingDir1());
+  appendDirections("POINTING_DIR2", acc.pointingDir2());
+  appendDirections("DISH_POINTING1", acc.dishPointing1());
+  appendDirections("DISH_POINTING2", acc.dishPointing2());
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.uvw();
+  ASKAPDEBUGASSERT(uvw.nelements() == nRow);
+  itsBuffer.resize(size_t(nRow) * 3 * sizeof(casacore::Double));
+  casacore::Double *uvwPtr = reinterpret_cast<casacore::Double*>(itsBuffer.data());
+  for (casacore::uInt row = 0; row < nRow; ++row, uvwPtr += 3) {
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            uvwPtr[dim] = uvw[row](dim);
+       }
+  }
+  column("UVW").append(nRow, itsBuffer.data());
+  appendCube("DATA", acc.visibility());
+  appendCube("FLAG", acc.flag());
+  appendCube("NOISE", acc.noise());
+  const casacore::Vector<casacore::Double> freq = acc.frequency().copy();
+  column("FREQUENCY").append(1, freq.data());
+  ColumnarFormat::ChunkRecord record;
+  std::memset(&record, 0, sizeof(record));
+  record.itsTime = acc.time();
+  record.itsFirstRow = itsNRow;
+  record.itsNRow = nRow;
+  record.itsScan = scan;
+  column(ColumnarFormat::chunkIndexName()).append(1, &record);
+  itsNRow += nRow;
+  ++itsNChunk;
+}
+
+/// @brief finish writing
+/// @details The header is written and all files are closed, no more chunks can be written.
+void ColumnarDataWriter::close()
+{
+  ASKAPCHECK(!itsClosed, "ColumnarDataWriter has already been closed");
+  itsClosed = true;
+  itsColumns.clear();
+  LOFAR::ParameterSet header;
+  header.add("version", utility::toString<int>(ColumnarFormat::theirVersion));
+  header.add("nrow", utility::toString<casacore::uInt64>(itsNRow));
+  header.add("nchunk", utility::toString<casacore::uInt64>(itsNChunk));
+  header.add("nchan", utility::toString<casacore::uInt>(itsNChannel));
+  header.add("npol", utility::toString<casacore::uInt>(itsStokes.nelements()));
+  std::string stokes;
+  for (casacore::uInt pol = 0; pol < itsStokes.nelements(); ++pol) {
+       stokes += (pol == 0 ? "" : ",") + casacore::Stokes::name(itsStokes[pol]);
+  }
+  header.add("stokes", "[" + stokes + "]");
+  header.writeFile(itsDirName + "/" + ColumnarFormat::headerName());
+}
+
+/// @brief create column files for the given shape
+/// @param[in] acc accessor with the first chunk
+void ColumnarDataWriter::createColumns(const IConstDataAccessor &acc)
+{
+  itsNChannel = acc.nChannel();
+  itsStokes.resize(acc.nPol());
+  itsStokes = acc.stokes();
+  const size_t nElements = size_t(itsNChannel) * itsStokes.nelements();
+  const std::string prefix = itsDirName + "/";
+  const char* indexNames[] = {"ANTENNA1", "ANTENNA2", "FEED1", "FEED2"};
+  for (size_t i = 0; i < sizeof(indexNames) / sizeof(indexNames[0]); ++i) {
+       itsColumns[indexNames[i]].reset(new ColumnFile(prefix + indexNames[i], sizeof(casacore::uInt), true));
+  }
+  itsColumns["FEED1_PA"].reset(new ColumnFile(prefix + "FEED1_PA", sizeof(casacore::Float), true));
+  itsColumns["FEED2_PA"].reset(new ColumnFile(prefix + "FEED2_PA", sizeof(casacore::Float), true));
+  const char* dirNames[] = {"POINTING_DIR1", "POINTING_DIR2", "DISH_POINTING1", "DISH_POINTING2"};
+  for (size_t i = 0; i < sizeof(dirNames) / sizeof(dirNames[0]); ++i) {
+       itsColumns[dirNames[i]].reset(new ColumnFile(prefix + dirNames[i], 2 * sizeof(casacore::Double), true));
+  }
+  itsColumns["UVW"].reset(new ColumnFile(prefix + "UVW", 3 * sizeof(casacore::Double), true));
+  itsColumns["DATA"].reset(new ColumnFile(prefix + "DATA", nElements * sizeof(casacore::Complex), true));
+  itsColumns["FLAG"].reset(new ColumnFile(prefix + "FLAG", nElements * sizeof(casacore::Bool), true));
+  itsColumns["NOISE"].reset(new ColumnFile(prefix + "NOISE", nElements * sizeof(casacore::Complex), true));
+  itsColumns["FREQUENCY"].reset(new ColumnFile(prefix + "FREQUENCY", itsNChannel * sizeof(casacore::Double), true));
+  itsColumns[ColumnarFormat::chunkIndexName()].reset(new ColumnFile(prefix + ColumnarFormat::chunkIndexName(), 
+            sizeof(ColumnarFormat::ChunkRecord), true));
+}
+
+/// @brief access a column file
+/// @param[in] name name of the column
+/// @return reference to the column file
+ColumnFile& ColumnarDataWriter::column(const std::string &name) const
+{
+  const std::map<std::string, boost::shared_ptr<ColumnFile> >::const_iterator ci = itsColumns.find(name);
+  ASKAPDEBUGASSERT(ci != itsColumns.end());
+  ASKAPDEBUGASSERT(ci->second);
+  return *(ci->second);
+}
+
+/// @brief append a vector of values
+/// @param[in] name name of the column
+/// @param[in] vec values to write, one per record
+template<typename T>
+void ColumnarDataWriter::appendVector(const std::string &name, const casacore::Vector<T> &vec)
+{
+  const casacore::Vector<T> contVec = vec.contiguousStorage() ? vec : casacore::Vector<T>(vec.copy());
+  column(name).append(contVec.nelements(), contVec.data());
+}
+
+/// @brief append directions
+/// @param[in] name name of the column
+/// @param[in] dirs directions to write, one per record
+void ColumnarDataWriter::appendDirections(const std::string &name, const casacore::Vector<casacore::MVDirection> &dirs)
+{
+  itsBuffer.resize(dirs.nelements() * 2 * sizeof(casacore::Double));
+  casacore::Double *ptr = reinterpret_cast<casacore::Double*>(itsBuffer.data());
+  for (casacore::uInt row = 0; row < dirs.nelements(); ++row, ptr += 2) {
+       ptr[0] = dirs[row].getLong();
+       ptr[1] = dirs[row].getLat();
+  }
+  column(name).append(dirs.nelements(), itsBuffer.data());
+}
+
+/// @brief append a cube in the measurement set order
+/// @param[in] name name of the column
+/// @param[in] cube cube in the accessor order (nRow x nChannel x nPol)
+template<typename T>
+void ColumnarDataWriter::appendCube(const std::string &name, const casacore::Cube<T> &cube)
+{
+  const casacore::uInt nRow = cube.nrow();
+  const casacore::uInt nChan = cube.ncolumn();
+  const casacore::uInt nPol = cube.nplane();
+  itsBuffer.resize(size_t(nRow) * nChan * nPol * sizeof(T));
+  // the scratch buffer is shared, the cube doesn't own the storage
+  casacore::Cube<T> native(casacore::IPosition(3, nPol, nChan, nRow), reinterpret_cast<T*>(itsBuffer.data()), 
+                           casacore::SHARE);
+  CubeTransposer::transpose(cube, native);
+  column(name).append(nRow, itsBuffer.data());
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,162 @@
+/// @file
+/// @brief writer of the columnar visibility format
+/// @details This class writes the data delivered by accessors into the columnar format 
+/// (see ColumnarFormat) chunk by chunk, so any data source can be converted. It is used by
+/// the msToColumnar application, which converts measurement sets.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_WRITER_H
+#define ASKAP_ACCESSORS_COLUMNAR_DATA_WRITER_H
+
+// std includes
+#include <map>
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/tables/Tables/Table.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IDataConverter.h>
+#include <askap/dataaccess/ColumnFile.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief writer of the columnar visibility format
+/// @details Each call to write appends one chunk. The number of channels and polarisation
+/// products should be the same for all chunks. The accessor is expected to deliver time
+/// as MJD in seconds (UTC), frequencies in Hz (topocentric) and directions in J2000, use
+/// configureConverter to set up the converter of the source data accordingly. The header 
+/// is written by close (or by the destructor), the data set can't be read before that.
+/// @ingroup dataaccess_hlp
+class ColumnarDataWriter : private boost::noncopyable
+{
+public:
+  /// @brief create a new data set
+  /// @details The directory is created if it doesn't exist, existing column files are
+  /// overwritten.
+  /// @param[in] dirName name of the directory
+  explicit ColumnarDataWriter(const std::string &dirName);
+
+  /// @brief close the data set
+  /// @details The header is written if close has not been called
+  ~ColumnarDataWriter();
+
+  /// @brief set up a converter to deliver the data in the frames of the columnar format
+  /// @param[in] conv converter of the source data source to set up
+  static void configureConverter(IDataConverter &conv);
+
+  /// @brief copy the subtables of the measurement set
+  /// @details A table without rows having the same subtables as the given measurement set
+  /// is created in the data set, so the metadata are available via ITableManager.
+  /// @param[in] ms measurement set the data are converted from
+  void copyMetadata(const casacore::Table &ms);
+
+  /// @brief append a chunk
+  /// @param[in] acc accessor with the data of the chunk
+  /// @param[in] scan scan number of the chunk
+  void write(const IConstDataAccessor &acc, casacore::uInt scan = 0);
+
+  /// @brief finish writing
+  /// @details The header is written and all files are closed, no more chunks can be written.
+  void close();
+
+  /// @brief number of rows written so far
+  /// @return total number of rows
+  inline casacore::uInt64 nRow() const { return itsNRow; }
+
+  /// @brief number of chunks written so far
+  /// @return total number of chunks
+  inline casacore::uInt64 nChunk() const { return itsNChunk; }
+
+protected:
+  /// @brief create column files for the given shape
+  /// @param[in] acc accessor with the first chunk
+  void createColumns(const IConstDataAccessor &acc);
+
+  /// @brief access a column file
+  /// @param[in] name name of the column
+  /// @return reference to the column file
+  ColumnFile& column(const std::string &name) const;
+
+  /// @brief append a vector of values
+  /// @param[in] name name of the column
+  /// @param[in] vec values to write, one per record
+  template<typename T>
+  void appendVector(const std::string &name, const casacore::Vector<T> &vec);
+
+  /// @brief append directions
+  /// @param[in] name name of the column
+  /// @param[in] dirs directions to write, one per record
+  void appendDirections(const std::string &name, const casacore::Vector<casacore::MVDirection> &dirs);
+
+  /// @brief append a cube in the measurement set order
+  /// @param[in] name name of the column
+  /// @param[in] cube cube in the accessor order (nRow x nChannel x nPol)
+  template<typename T>
+  void appendCube(const std::string &name, const casacore::Cube<T> &cube);
+
+private:
+  /// @brief name of the directory
+  std::string itsDirName;
+
+  /// @brief column files
+  std::map<std::string, boost::shared_ptr<ColumnFile> > itsColumns;
+
+  /// @brief polarisation products
+  casacore::Vector<casacore::Stokes::StokesTypes> itsStokes;
+
+  /// @brief number of channels
+  casacore::uInt itsNChannel;
+
+  /// @brief total number of rows
+  casacore::uInt64 itsNRow;
+
+  /// @brief total number of chunks
+  casacore::uInt64 itsNChunk;
+
+  /// @brief true, if close has been called
+  bool itsClosed;
+
+  /// @brief scratch buffer for the conversion to the file layout
+  std::vector<char> itsBuffer;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLUMNAR_DATA_WRITER_H
@@ -0,0 +1,92 @@
+/// @file
+/// @brief layout of the columnar visibility format
+/// @details The columnar format is an alternative to the measurement set for fast sequential
+/// reads. A data set is a directory with one flat binary file per column (see ColumnFile),
+/// a chunk index and a header. Row-based columns hold one fixed-size record per row, the
+/// chunk-based columns hold one record per chunk (i.e. per iteration of the original 
+/// iterator). An optional metadata table holds the subtables of the original measurement
+/// set, so the usual ITableManager machinery can be used to access them.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_COLUMNAR_FORMAT_H
+#define ASKAP_ACCESSORS_COLUMNAR_FORMAT_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief layout of the columnar visibility format
+/// @details The directory contains the following files:
+/// - header.parset: format version, number of rows, chunks, channels and polarisation
+///   products (fixed for the whole data set) and the polarisation types;
+/// - CHUNKS: chunk index, one ChunkRecord per chunk in time order;
+/// - FREQUENCY: frequencies (Hz, topocentric) of all channels for each chunk;
+/// - ANTENNA1, ANTENNA2, FEED1, FEED2: indices (uInt) for each row;
+/// - FEED1_PA, FEED2_PA: parallactic angles (Float, radians) for each row;
+/// - POINTING_DIR1, POINTING_DIR2, DISH_POINTING1, DISH_POINTING2: J2000 longitude and
+///   latitude (2 Doubles, radians) for each row;
+/// - UVW: 3 Doubles (metres) for each row;
+/// - DATA, NOISE: Complex visibilities and noise, FLAG: Bool flags for each row, the record 
+///   is an nPol x nChannel matrix with the polarisation index changing fastest (as in the
+///   measurement set);
+/// - METADATA: optional casacore table without rows holding the subtables of the original
+///   measurement set.
+/// Time stamps are MJD in seconds (UTC). All binary data are in the native byte order.
+/// @ingroup dataaccess_hlp
+struct ColumnarFormat {
+  /// @brief version of the format
+  static const int theirVersion = 1;
+
+  /// @brief name of the header file
+  static const char* headerName() { return "header.parset"; }
+
+  /// @brief name of the chunk index file
+  static const char* chunkIndexName() { return "CHUNKS"; }
+
+  /// @brief name of the metadata table
+  static const char* metadataName() { return "METADATA"; }
+
+  /// @brief record of the chunk index
+  struct ChunkRecord {
+    /// @brief time stamp of the chunk (MJD in seconds, UTC)
+    casacore::Double itsTime;
+    /// @brief first row of the chunk
+    casacore::uInt64 itsFirstRow;
+    /// @brief number of rows in the chunk
+    casacore::uInt itsNRow;
+    /// @brief scan number
+    casacore::uInt itsScan;
+  };
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLUMNAR_FORMAT_H
@@ -0,0 +1,301 @@
+/// @file CompactVisibilityCube.cc
+/// @brief Reduced precision representation of the visibility cube
+/// @details The visibility cube returned by IConstDataAccessor::visibility() uses 
+/// two single precision numbers per element. For model prediction and residual gridding
+/// (especially on GPUs) 16-bit numbers are accurate enough and halve the memory and 
+/// transfer volume. This class holds visibilities either as 16-bit integers with a 
+/// scale factor per row or as IEEE 754 half precision numbers.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#include <askap/dataaccess/CompactVisibilityCube.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty cube
+/// @param[in] format format of the words
+CompactVisibilityCube::CompactVisibilityCube(Format format) : itsFormat(format), itsNumberOfRows(0), 
+          itsNumberOfChannels(0), itsNumberOfPols(0) {}
+
+/// @brief construct a cube of the given shape
+/// @details All elements are zero
+/// @param[in] nRow number of rows
+/// @param[in] nChan number of channels
+/// @param[in] nPol number of polarisations
+/// @param[in] format format of the words
+CompactVisibilityCube::CompactVisibilityCube(casacore::uInt nRow, casacore::uInt nChan, casacore::uInt nPol, 
+          Format format) : itsFormat(format), itsNumberOfRows(0), itsNumberOfChannels(0), itsNumberOfPols(0)
+{
+  resize(nRow, nChan, nPol);
+}
+
+/// @brief change the shape
+/// @details All elements are zero after this call
+/// @param[in] nRow number of rows
+/// @param[in] nChan number of channels
+/// @param[in] nPol number of polarisations
+void CompactVisibilityCube::resize(casacore::uInt nRow, casacore::uInt nChan, casacore::uInt nPol)
+{
+  itsNumberOfRows = nRow;
+  itsNumberOfChannels = nChan;
+  itsNumberOfPols = nPol;
+  // zero bit pattern means zero in both formats
+  itsWords.assign(size_t(nRow) * wordsPerRow(), Word(0));
+  if (itsFormat == COMPLEX_INT16) {
+      itsScales.assign(nRow, 0.f);
+  } else {
+      itsScales.clear();
+  }
+}
+
+/// @brief change the format
+/// @details All elements are zero after this call, the shape is preserved
+/// @param[in] format new format of the words
+void CompactVisibilityCube::setFormat(Format format)
+{
+  itsFormat = format;
+  resize(itsNumberOfRows, itsNumberOfChannels, itsNumberOfPols);
+}
+
+/// @brief value of one element
+/// @param[in] row row index
+/// @param[in] chan channel index
+/// @param[in] pol polarisation index
+/// @return visibility converted back to single precision
+casacore::Complex CompactVisibilityCube::operator()(casacore::uInt row, casacore::uInt chan, casacore::uInt pol) const
+{
+  ASKAPDEBUGASSERT((row < itsNumberOfRows) && (chan < itsNumberOfChannels) && (pol < itsNumberOfPols));
+  const Word *words = rowWords(row) + 2 * (size_t(chan) * itsNumberOfPols + pol);
+  if (itsFormat == COMPLEX_INT16) {
+      const casacore::Float rowScale = itsScales[row];
+      return casacore::Complex(static_cast<casacore::Short>(words[0]) * rowScale, 
+                               static_cast<casacore::Short>(words[1]) * rowScale);
+  }
+  return casacore::Complex(halfToFloat(words[0]), halfToFloat(words[1]));
+}
+
+/// @brief pack visibilities given in the accessor order
+/// @param[in] vis nRow x nChannel x nPol cube of visibilities
+void CompactVisibilityCube::pack(const casacore::Cube<casacore::Complex> &vis)
+{
+  resize(vis.nrow(), vis.ncolumn(), vis.nplane());
+  // gather each row into the storage order, so the conversion works on contiguous memory
+  std::vector<casacore::Complex> rowBuffer(size_t(itsNumberOfChannels) * itsNumberOfPols);
+  for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+       std::vector<casacore::Complex>::iterator it = rowBuffer.begin();
+       for (casacore::uInt chan = 0; chan < itsNumberOfChannels; ++chan) {
+            for (casacore::uInt pol = 0; pol < itsNumberOfPols; ++pol, ++it) {
+                 *it = vis(row, chan, pol);
+            }
+       }
+       if (rowBuffer.size() > 0) {
+           packRow(row, &rowBuffer[0]);
+       }
+  }
+}
+
+/// @brief pack visibilities given in the storage order
+/// @param[in] vis nPol x nChannel x nRow cube of visibilities
+void CompactVisibilityCube::packNative(const casacore::Cube<casacore::Complex> &vis)
+{
+  resize(vis.nplane(), vis.ncolumn(), vis.nrow());
+  if (vis.nelements() == 0) {
+      return;
+  }
+  bool deleteIt = false;
+  const casacore::Complex *visPtr = vis.getStorage(deleteIt);
+  const size_t rowStep = size_t(itsNumberOfChannels) * itsNumberOfPols;
+  for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+       packRow(row, visPtr + row * rowStep);
+  }
+  vis.freeStorage(visPtr, deleteIt);
+}
+
+/// @brief pack visibilities of one row given in the storage order
+/// @details This method doesn't change the shape of the cube
+/// @param[in] row row index
+/// @param[in] vis pointer to nPol x nChannel contiguous visibilities of this row
+void CompactVisibilityCube::packRow(casacore::uInt row, const casacore::Complex *vis)
+{
+  ASKAPDEBUGASSERT(row < itsNumberOfRows);
+  const size_t nWords = wordsPerRow();
+  Word *words = &itsWords[size_t(row) * nWords];
+  // std::complex is guaranteed to be laid out as the real part followed by the imaginary part
+  const casacore::Float *values = reinterpret_cast<const casacore::Float*>(vis);
+  if (itsFormat == COMPLEX_FLOAT16) {
+      for (size_t i = 0; i < nWords; ++i) {
+           words[i] = floatToHalf(values[i]);
+      }
+      return;
+  }
+  // the largest finite component defines the scale, comparisons with NaN are false
+  const casacore::Float maxFinite = std::numeric_limits<casacore::Float>::max();
+  casacore::Float maxAbs = 0.f;
+  for (size_t i = 0; i < nWords; ++i) {
+       const casacore::Float absValue = std::abs(values[i]);
+       maxAbs = (absValue <= maxFinite) && (absValue > maxAbs) ? absValue : maxAbs;
+  }
+  const casacore::Float rowScale = maxAbs / casacore::Float(theirMaxInt16);
+  itsScales[row] = rowScale;
+  const casacore::Float invScale = rowScale > 0.f ? 1.f / rowScale : 0.f;
+  // branch-free body, rounding is half away from zero
+  for (size_t i = 0; i < nWords; ++i) {
+       const casacore::Float value = std::abs(values[i]) <= maxFinite ? values[i] * invScale : 0.f;
+       const casacore::Float clamped = std::min(std::max(value, -casacore::Float(theirMaxInt16)), 
+                                                casacore::Float(theirMaxInt16));
+       const casacore::Int rounded = static_cast<casacore::Int>(clamped + (clamped < 0.f ? -0.5f : 0.5f));
+       words[i] = static_cast<Word>(static_cast<casacore::Short>(rounded));
+  }
+}
+
+/// @brief unpack visibilities into a cube in the accessor order
+/// @param[out] vis nRow x nChannel x nPol cube of visibilities (resized as necessary)
+void CompactVisibilityCube::unpack(casacore::Cube<casacore::Complex> &vis) const
+{
+  vis.resize(itsNumberOfRows, itsNumberOfChannels, itsNumberOfPols);
+  std::vector<casacore::Complex> rowBuffer(size_t(itsNumberOfChannels) * itsNumberOfPols);
+  for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+       if (rowBuffer.size() == 0) {
+           break;
+       }
+       unpackRow(row, &rowBuffer[0]);
+       std::vector<casacore::Complex>::const_iterator ci = rowBuffer.begin();
+       for (casacore::uInt chan = 0; chan < itsNumberOfChannels; ++chan) {
+            for (casacore::uInt pol = 0; pol < itsNumberOfPols; ++pol, ++ci) {
+                 vis(row, chan, pol) = *ci;
+            }
+       }
+  }
+}
+
+/// @brief unpack visibilities into a cube in the storage order
+/// @param[out] vis nPol x nChannel x nRow cube of visibilities (resized as necessary)
+void CompactVisibilityCube::unpackNative(casacore::Cube<casacore::Complex> &vis) const
+{
+  vis.resize(itsNumberOfPols, itsNumberOfChannels, itsNumberOfRows);
+  if (vis.nelements() == 0) {
+      return;
+  }
+  bool deleteIt = false;
+  casacore::Complex *visPtr = vis.getStorage(deleteIt);
+  const size_t rowStep = size_t(itsNumberOfChannels) * itsNumberOfPols;
+  for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+       unpackRow(row, visPtr + row * rowStep);
+  }
+  vis.putStorage(visPtr, deleteIt);
+}
+
+/// @brief unpack visibilities of one row into the storage order
+/// @param[in] row row index
+/// @param[out] vis pointer to nPol x nChannel contiguous visibilities to fill
+void CompactVisibilityCube::unpackRow(casacore::uInt row, casacore::Complex *vis) const
+{
+  ASKAPDEBUGASSERT(row < itsNumberOfRows);
+  const size_t nWords = wordsPerRow();
+  const Word *words = rowWords(row);
+  casacore::Float *values = reinterpret_cast<casacore::Float*>(vis);
+  if (itsFormat == COMPLEX_INT16) {
+      const casacore::Float rowScale = itsScales[row];
+      for (size_t i = 0; i < nWords; ++i) {
+           values[i] = static_cast<casacore::Short>(words[i]) * rowScale;
+      }
+  } else {
+      for (size_t i = 0; i < nWords; ++i) {
+           values[i] = halfToFloat(words[i]);
+      }
+  }
+}
+
+/// @brief convert a single precision number to half precision
+/// @details Rounding is to nearest even, values beyond the half precision range 
+/// become infinite and NaNs are preserved.
+/// @param[in] value number to convert
+/// @return half precision bit pattern
+CompactVisibilityCube::Word CompactVisibilityCube::floatToHalf(casacore::Float value)
+{
+  casacore::uInt bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const casacore::uInt sign = (bits >> 16) & 0x8000u;
+  const casacore::uInt absBits = bits & 0x7fffffffu;
+  if (absBits >= 0x7f800000u) {
+      // infinity or NaN (keep the NaN quiet)
+      return static_cast<Word>(sign | 0x7c00u | (absBits > 0x7f800000u ? 0x200u : 0u));
+  }
+  if (absBits >= 0x477ff000u) {
+      // 65520 and above round to infinity
+      return static_cast<Word>(sign | 0x7c00u);
+  }
+  if (absBits < 0x38800000u) {
+      // below 2^-14, the result is subnormal or zero
+      if (absBits < 0x33000000u) {
+          return static_cast<Word>(sign);
+      }
+      const casacore::uInt shift = 126u - (absBits >> 23);
+      const casacore::uInt mantissa = (absBits & 0x7fffffu) | 0x800000u;
+      casacore::uInt half = mantissa >> shift;
+      const casacore::uInt remainder = mantissa & ((1u << shift) - 1u);
+      const casacore::uInt halfway = 1u << (shift - 1u);
+      if ((remainder > halfway) || ((remainder == halfway) && (half & 1u))) {
+          ++half;
+      }
+      return static_cast<Word>(sign | half);
+  }
+  // normal number, rebias the exponent (a carry out of the mantissa increments it)
+  casacore::uInt half = (absBits - 0x38000000u) >> 13;
+  const casacore::uInt remainder = absBits & 0x1fffu;
+  if ((remainder > 0x1000u) || ((remainder == 0x1000u) && (half & 1u))) {
+      ++half;
+  }
+  return static_cast<Word>(sign | half);
+}
+
+/// @brief convert a half precision number to single precision
+/// @details The conversion is exact
+/// @param[in] value half precision bit pattern
+/// @return single precision number
+casacore::Float CompactVisibilityCube::halfToFloat(Word value)
+{
+  const casacore::uInt sign = (casacore::uInt(value) & 0x8000u) << 16;
+  const casacore::uInt exponent = (casacore::uInt(value) >> 10) & 0x1fu;
+  const casacore::uInt mantissa = casacore::uInt(value) & 0x3ffu;
+  if (exponent == 0) {
+      // zero or subnormal, the value is mantissa * 2^-24
+      const casacore::Float result = casacore::Float(mantissa) * 5.9604644775390625e-8f;
+      return sign ? -result : result;
+  }
+  const casacore::uInt bits = sign | (exponent == 0x1fu ? 0x7f800000u | (mantissa << 13) : 
+                                      ((exponent + 112u) << 23) | (mantissa << 13));
+  casacore::Float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
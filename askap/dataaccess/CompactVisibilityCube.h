@@ -0,0 +1,216 @@
+/// @file CompactVisibilityCube.h
+/// @brief Reduced precision representation of the visibility cube
+/// @details The visibility cube returned by IConstDataAccessor::visibility() uses 
+/// two single precision numbers per element. For model prediction and residual gridding
+/// (especially on GPUs) 16-bit numbers are accurate enough and halve the memory and 
+/// transfer volume. This class holds visibilities either as 16-bit integers with a 
+/// scale factor per row or as IEEE 754 half precision numbers.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_COMPACT_VISIBILITY_CUBE_H
+#define ASKAP_ACCESSORS_COMPACT_VISIBILITY_CUBE_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Reduced precision representation of the visibility cube
+/// @details Visibilities of each row are stored as a contiguous sequence of 16-bit words 
+/// ordered the same way as the data in the measurement set, i.e. the real part is followed
+/// by the imaginary part, polarisation is the next most rapidly varying index followed by 
+/// the channel (word number is 2 * (chan * nPol + pol) for the real part). Rows follow each
+/// other without gaps, so the whole cube can be copied to the device in one go. 
+/// Two formats are supported:
+/// @li COMPLEX_INT16: words are two's complement 16-bit integers, the value is the integer
+/// multiplied by the scale of the row (see scale). The scale is chosen so the largest 
+/// finite component of the row maps to theirMaxInt16. Non-finite values are stored as zero
+/// (they are expected to be flagged).
+/// @li COMPLEX_FLOAT16: words are IEEE 754 half precision numbers (rounded to nearest even),
+/// values beyond the half precision range become infinite, NaNs are preserved.
+/// Element (row,chan,pol) corresponds to element (row,chan,pol) of the cube returned by 
+/// IConstDataAccessor::visibility().
+/// @ingroup dataaccess_hlp
+class CompactVisibilityCube {
+public:
+  /// @brief type of the word used for storage
+  typedef casacore::uInt16 Word;
+
+  /// @brief format of the words
+  enum Format {
+     /// @brief 16-bit integers with the scale factor per row
+     COMPLEX_INT16 = 0,
+     /// @brief IEEE 754 half precision numbers
+     COMPLEX_FLOAT16
+  };
+
+  /// @brief largest integer used in the COMPLEX_INT16 format
+  static const casacore::Int theirMaxInt16 = 32767;
+
+  /// @brief construct an empty cube
+  /// @param[in] format format of the words
+  explicit CompactVisibilityCube(Format format = COMPLEX_INT16);
+
+  /// @brief construct a cube of the given shape
+  /// @details All elements are zero
+  /// @param[in] nRow number of rows
+  /// @param[in] nChan number of channels
+  /// @param[in] nPol number of polarisations
+  /// @param[in] format format of the words
+  CompactVisibilityCube(casacore::uInt nRow, casacore::uInt nChan, casacore::uInt nPol, 
+                        Format format = COMPLEX_INT16);
+
+  /// @brief change the shape
+  /// @details All elements are zero after this call
+  /// @param[in] nRow number of rows
+  /// @param[in] nChan number of channels
+  /// @param[in] nPol number of polarisations
+  void resize(casacore::uInt nRow, casacore::uInt nChan, casacore::uInt nPol);
+
+  /// @brief change the format
+  /// @details All elements are zero after this call, the shape is preserved
+  /// @param[in] format new format of the words
+  void setFormat(Format format);
+
+  /// @return format of the words
+  inline Format format() const { return itsFormat;}
+
+  /// @return number of rows
+  inline casacore::uInt nRow() const { return itsNumberOfRows;}
+
+  /// @return number of channels
+  inline casacore::uInt nChannel() const { return itsNumberOfChannels;}
+
+  /// @return number of polarisations
+  inline casacore::uInt nPol() const { return itsNumberOfPols;}
+
+  /// @return number of words used to store one row
+  inline size_t wordsPerRow() const { return 2 * size_t(itsNumberOfChannels) * itsNumberOfPols;}
+
+  /// @return number of bytes occupied by the words and scales
+  inline size_t nBytes() const 
+  { return itsWords.size() * sizeof(Word) + itsScales.size() * sizeof(casacore::Float);}
+
+  /// @brief access the words of the whole cube
+  /// @return pointer to nRow() * wordsPerRow() words (zero for an empty cube)
+  inline const Word* data() const { return itsWords.size() > 0 ? &itsWords[0] : 0;}
+
+  /// @brief access the words of one row
+  /// @param[in] row row index
+  /// @return pointer to wordsPerRow() words 
+  inline const Word* rowWords(casacore::uInt row) const 
+  { return &itsWords[size_t(row) * wordsPerRow()];}
+
+  /// @brief scale factors of all rows
+  /// @details Only defined for the COMPLEX_INT16 format
+  /// @return pointer to nRow() scale factors (zero if there are none)
+  inline const casacore::Float* scales() const { return itsScales.size() > 0 ? &itsScales[0] : 0;}
+
+  /// @brief scale factor of one row
+  /// @details Only defined for the COMPLEX_INT16 format
+  /// @param[in] row row index
+  /// @return value corresponding to the integer 1
+  inline casacore::Float scale(casacore::uInt row) const { return itsScales[row];}
+
+  /// @brief value of one element
+  /// @param[in] row row index
+  /// @param[in] chan channel index
+  /// @param[in] pol polarisation index
+  /// @return visibility converted back to single precision
+  casacore::Complex operator()(casacore::uInt row, casacore::uInt chan, casacore::uInt pol) const;
+
+  /// @brief pack visibilities given in the accessor order
+  /// @param[in] vis nRow x nChannel x nPol cube of visibilities
+  void pack(const casacore::Cube<casacore::Complex> &vis);
+
+  /// @brief pack visibilities given in the storage order
+  /// @param[in] vis nPol x nChannel x nRow cube of visibilities
+  void packNative(const casacore::Cube<casacore::Complex> &vis);
+
+  /// @brief pack visibilities of one row given in the storage order
+  /// @details This method doesn't change the shape of the cube
+  /// @param[in] row row index
+  /// @param[in] vis pointer to nPol x nChannel contiguous visibilities of this row
+  void packRow(casacore::uInt row, const casacore::Complex *vis);
+
+  /// @brief unpack visibilities into a cube in the accessor order
+  /// @param[out] vis nRow x nChannel x nPol cube of visibilities (resized as necessary)
+  void unpack(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief unpack visibilities into a cube in the storage order
+  /// @param[out] vis nPol x nChannel x nRow cube of visibilities (resized as necessary)
+  void unpackNative(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief unpack visibilities of one row into the storage order
+  /// @param[in] row row index
+  /// @param[out] vis pointer to nPol x nChannel contiguous visibilities to fill
+  void unpackRow(casacore::uInt row, casacore::Complex *vis) const;
+
+  /// @brief convert a single precision number to half precision
+  /// @details Rounding is to nearest even, values beyond the half precision range 
+  /// become infinite and NaNs are preserved.
+  /// @param[in] value number to convert
+  /// @return half precision bit pattern
+  static Word floatToHalf(casacore::Float value);
+
+  /// @brief convert a half precision number to single precision
+  /// @details The conversion is exact
+  /// @param[in] value half precision bit pattern
+  /// @return single precision number
+  static casacore::Float halfToFloat(Word value);
+
+private:
+  /// @brief format of the words
+  Format itsFormat;
+
+  /// @brief number of rows
+  casacore::uInt itsNumberOfRows;
+
+  /// @brief number of channels
+  casacore::uInt itsNumberOfChannels;
+
+  /// @brief number of polarisations
+  casacore::uInt itsNumberOfPols;
+
+  /// @brief packed visibilities
+  std::vector<Word> itsWords;
+
+  /// @brief scale factors of rows, COMPLEX_INT16 format only
+  std::vector<casacore::Float> itsScales;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COMPACT_VISIBILITY_CUBE_H
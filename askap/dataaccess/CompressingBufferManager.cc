@@ -0,0 +1,120 @@
+/// @file
+/// @brief A buffer manager storing buffers in a compact form
+/// @details This class is an adapter over another buffer manager (which does
+/// the actual storage). Buffer cubes are encoded with a codec chosen for each
+/// buffer name (see BufferCodec) before they are passed to the underlying
+/// manager and decoded after they are read. This way, the memory and I/O required
+/// for buffers which don't need full precision (e.g. model visibilities) are
+/// reduced for any kind of storage.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/CompressingBufferManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct the object
+/// @param[in] store buffer manager to store the encoded cubes
+CompressingBufferManager::CompressingBufferManager(const boost::shared_ptr<IBufferManager const> 
+                                                   &store) : itsStore(store)
+{
+  ASKAPCHECK(itsStore, "Underlying buffer manager is required for CompressingBufferManager");
+}
+
+/// @brief set the codec for the given buffer
+/// @param[in] name a name of the buffer
+/// @param[in] codec codec to use for this buffer (BufferCodec::NONE to store
+/// the data as they are)
+void CompressingBufferManager::setCodec(const std::string &name, BufferCodec::Type codec) const
+{
+  boost::mutex::scoped_lock lock(itsMutex);
+  if (codec == BufferCodec::NONE) {
+      itsCodecs.erase(name);
+  } else {
+      itsCodecs[name] = codec;
+  }
+}
+
+/// @brief obtain the codec for the given buffer
+/// @param[in] name a name of the buffer
+/// @return codec used for this buffer
+BufferCodec::Type CompressingBufferManager::codec(const std::string &name) const
+{
+  boost::mutex::scoped_lock lock(itsMutex);
+  const std::map<std::string, BufferCodec::Type>::const_iterator it = itsCodecs.find(name);
+  return it != itsCodecs.end() ? it->second : BufferCodec::NONE;
+}
+
+/// @brief populate the cube with the data stored in the given buffer
+/// @details The method throws an exception if the requested buffer
+/// does not exist (prevents a shape mismatch)
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+void CompressingBufferManager::readBuffer(casacore::Cube<casacore::Complex> &vis,
+                                          const std::string &name, casacore::uInt index) const
+{
+  const BufferCodec::Type bufferCodec = codec(name);
+  if (bufferCodec == BufferCodec::NONE) {
+      itsStore->readBuffer(vis, name, index);
+  } else {
+      casacore::Cube<casacore::Complex> encoded;
+      itsStore->readBuffer(encoded, name, index);
+      BufferCodec::decode(encoded, bufferCodec, vis);
+  }
+}
+
+/// @brief write the cube back to the given buffer
+/// @details This buffer is created on the first write operation
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+void CompressingBufferManager::writeBuffer(const casacore::Cube<casacore::Complex> &vis,
+                                           const std::string &name, casacore::uInt index) const
+{
+  const BufferCodec::Type bufferCodec = codec(name);
+  if (bufferCodec == BufferCodec::NONE) {
+      itsStore->writeBuffer(vis, name, index);
+  } else {
+      casacore::Cube<casacore::Complex> encoded;
+      BufferCodec::encode(vis, bufferCodec, encoded);
+      itsStore->writeBuffer(encoded, name, index);
+  }
+}
+
+/// @brief check whether the particular buffer exists
+/// @param[in] name a name of the buffer to query
+/// @param[in] index a sequential index in the buffer
+/// @return true, if the buffer with the given name is present
+bool CompressingBufferManager::bufferExists(const std::string &name, casacore::uInt index) const
+{
+  return itsStore->bufferExists(name, index);
+}
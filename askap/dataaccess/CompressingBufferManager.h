@@ -0,0 +1,135 @@
+/// @file
+/// @brief A buffer manager storing buffers in a compact form
+/// @details This class is an adapter over another buffer manager (which does
+/// the actual storage). Buffer cubes are encoded with a codec chosen for each
+/// buffer name (see BufferCodec) before they are passed to the underlying
+/// manager and decoded after they are read. This way, the memory and I/O required
+/// for buffers which don't need full precision (e.g. model visibilities) are
+/// reduced for any kind of storage.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_COMPRESSING_BUFFER_MANAGER_H
+#define ASKAP_ACCESSORS_COMPRESSING_BUFFER_MANAGER_H
+
+// std includes
+#include <string>
+#include <map>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// own includes
+#include <askap/dataaccess/IBufferManager.h>
+#include <askap/dataaccess/BufferCodec.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief A buffer manager storing buffers in a compact form
+/// @details All buffers are passed through unchanged unless a codec is
+/// set for the given buffer name. The codec is not stored with the buffer, 
+/// it should be set before the buffer is written for the first time and should
+/// stay the same while the buffer is in use (persistent buffers written in 
+/// an earlier session should be read with the same codec). Buffer managers
+/// are shared between iterators as const objects, therefore the codec is set
+/// via a const (but thread-safe) method.
+/// @ingroup dataaccess_tab
+class CompressingBufferManager : virtual public IBufferManager,
+                                 private boost::noncopyable
+{
+public:
+  /// @brief construct the object
+  /// @param[in] store buffer manager to store the encoded cubes
+  explicit CompressingBufferManager(const boost::shared_ptr<IBufferManager const> &store);
+
+  /// @brief populate the cube with the data stored in the given buffer
+  /// @details The method throws an exception if the requested buffer
+  /// does not exist (prevents a shape mismatch)
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  virtual void readBuffer(casacore::Cube<casacore::Complex> &vis,
+                          const std::string &name,
+                          casacore::uInt index) const;
+  
+  /// @brief write the cube back to the given buffer
+  /// @details This buffer is created on the first write operation
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  virtual void writeBuffer(const casacore::Cube<casacore::Complex> &vis,
+                           const std::string &name,
+                           casacore::uInt index) const;
+
+  /// @brief check whether the particular buffer exists
+  /// @param[in] name a name of the buffer to query
+  /// @param[in] index a sequential index in the buffer
+  /// @return true, if the buffer with the given name is present
+  virtual bool bufferExists(const std::string &name,
+                            casacore::uInt index) const;
+
+  /// @brief set the codec for the given buffer
+  /// @param[in] name a name of the buffer
+  /// @param[in] codec codec to use for this buffer (BufferCodec::NONE to store
+  /// the data as they are)
+  void setCodec(const std::string &name, BufferCodec::Type codec) const;
+
+  /// @brief obtain the codec for the given buffer
+  /// @param[in] name a name of the buffer
+  /// @return codec used for this buffer
+  BufferCodec::Type codec(const std::string &name) const;
+
+  /// @brief obtain the underlying buffer manager
+  /// @return a reference to the manager storing the encoded cubes
+  inline const IBufferManager& store() const { return *itsStore;}
+
+private:
+  /// @brief buffer manager storing the encoded cubes
+  boost::shared_ptr<IBufferManager const> itsStore;
+
+  /// @brief codecs for the buffers, buffers not in the map are not encoded
+  mutable std::map<std::string, BufferCodec::Type> itsCodecs;
+
+  /// @brief mutex protecting the map of codecs
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COMPRESSING_BUFFER_MANAGER_H
@@ -0,0 +1,163 @@
+/// @file
+/// @brief transpose kernel shared by all cube fillers
+///
+/// @details Measurement sets store a (pol,chan) matrix per row, while the
+/// accessor interface uses nRow x nChannel x nPol cubes. All readers and
+/// writers of the cubes need to swap the row and polarisation axes. This
+/// class encapsulates this operation, so it is done in one place in a 
+/// cache-friendly way.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_CUBE_TRANSPOSER_H
+#define ASKAP_ACCESSORS_CUBE_TRANSPOSER_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief conversion of a single element done by CubeTransposer
+/// @details By default, the element is just copied (via the constructor of
+/// the output type). Specialisations can do more complex conversions.
+/// @ingroup dataaccess_hlp
+template<typename In, typename Out>
+struct TransposeElementConverter {
+  /// @brief convert one element
+  /// @param[in] in input value
+  /// @return converted value
+  static inline Out convert(const In &in) { return Out(in); }
+};
+
+/// @brief conversion of the noise figures
+/// @details Real-valued noise figures are given per polarisation and channel. 
+/// The same value is used for both real and imaginary parts.
+/// @ingroup dataaccess_hlp
+template<>
+struct TransposeElementConverter<casacore::Float, casacore::Complex> {
+  /// @brief convert one element
+  /// @param[in] in input value
+  /// @return converted value
+  static inline casacore::Complex convert(casacore::Float in) { return casacore::Complex(in,in); }
+};
+
+/// @brief conversion of the noise figures back to the table
+/// @details This is the reverse of the conversion above, the real part is taken.
+/// @ingroup dataaccess_hlp
+template<>
+struct TransposeElementConverter<casacore::Complex, casacore::Float> {
+  /// @brief convert one element
+  /// @param[in] in input value
+  /// @return converted value
+  static inline casacore::Float convert(const casacore::Complex &in) { return in.real(); }
+};
+
+/// @brief transpose kernel shared by all cube fillers
+/// @details The kernel swaps the first and the last axes of the cube, i.e. 
+/// converts a cube in the table order (nPol x nChannel x nRow) into a cube in 
+/// the accessor order (nRow x nChannel x nPol) or vice versa. The work is done 
+/// in tiles of rows and channels, so both the input and the output being touched
+/// stay in the cache. The number of polarisations is a compile time constant for
+/// the most common cases (1, 2 and 4 products), which allows the compiler to unroll
+/// and vectorise the inner loop. 
+/// @ingroup dataaccess_hlp
+struct CubeTransposer {
+
+  /// @brief swap the first and the last axes of the cube
+  /// @details Element (i,j,k) of the input cube becomes element (k,j,i) of the
+  /// output cube. The output cube is resized if necessary. Elements are converted
+  /// with TransposeElementConverter.
+  /// @param[in] in input cube
+  /// @param[in] out output cube
+  template<typename In, typename Out>
+  static void transpose(const casacore::Cube<In> &in, casacore::Cube<Out> &out);
+
+  /// @brief broadcast values along the channel axis
+  /// @details This is a companion method to transpose for the case where the 
+  /// input is given per polarisation and row only (e.g. SIGMA column). Element 
+  /// (pol,row) of the input matrix becomes elements (row,chan,pol) for all
+  /// channels of the output cube. The number of channels is taken from the output 
+  /// cube, which should already have the right shape. Nothing is done for an empty cube.
+  /// @param[in] in input matrix (nPol x nRow)
+  /// @param[in] out output cube (nRow x nChannel x nPol)
+  template<typename In, typename Out>
+  static void broadcast(const casacore::Matrix<In> &in, casacore::Cube<Out> &out);
+
+  /// @brief transpose one row
+  /// @details This is a companion method to transpose for the case where the rows are
+  /// read one by one (e.g. if the cell shape varies). Element (pol,chan) of the input 
+  /// matrix becomes element (row,chan,pol) of the output cube, which should already have 
+  /// the right shape. Elements are converted with TransposeElementConverter.
+  /// @param[in] in input matrix (nPol x nChannel)
+  /// @param[in] out output cube (nRow x nChannel x nPol)
+  /// @param[in] row row of the output cube to fill
+  template<typename In, typename Out>
+  static void transposeRow(const casacore::Matrix<In> &in, casacore::Cube<Out> &out, 
+                           casacore::uInt row);
+
+  /// @brief size of the tile in both rows and channels
+  static const casacore::uInt theirTileSize = 32;
+
+private:
+  /// @brief transpose for a particular number of polarisations
+  /// @details This is the actual kernel. The number of polarisations
+  /// (the first axis of the input cube) is given by the template parameter. Zero means that
+  /// it is not known at compile time and is taken from the first dimension.
+  /// @param[in] in pointer to the contiguous input cube (nPol x nChannel x nRow)
+  /// @param[in] out pointer to the contiguous output cube (nRow x nChannel x nPol)
+  /// @param[in] nPol number of polarisations 
+  /// @param[in] nChan number of channels
+  /// @param[in] nRow number of rows
+  template<casacore::uInt NPol, typename In, typename Out>
+  static void transposeKernel(const In* in, Out* out, casacore::uInt nPol, 
+                              casacore::uInt nChan, casacore::uInt nRow);
+
+  /// @brief transpose of one row for a particular number of polarisations
+  /// @details This is the kernel of transposeRow, the number of polarisations is given by
+  /// the template parameter in the same way as for transposeKernel.
+  /// @param[in] in pointer to the contiguous input matrix (nPol x nChannel)
+  /// @param[in] out pointer to the first element of the row in the contiguous output 
+  /// cube (nRow x nChannel x nPol)
+  /// @param[in] nPol number of polarisations 
+  /// @param[in] nChan number of channels
+  /// @param[in] nRow number of rows in the output cube
+  template<casacore::uInt NPol, typename In, typename Out>
+  static void transposeRowKernel(const In* in, Out* out, casacore::uInt nPol, 
+                                 casacore::uInt nChan, casacore::uInt nRow);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#include <askap/dataaccess/CubeTransposer.tcc>
+
+#endif // #ifndef ASKAP_ACCESSORS_CUBE_TRANSPOSER_H
@@ -0,0 +1,200 @@
+/// @file
+/// @brief transpose kernel shared by all cube fillers
+///
+/// @details Measurement sets store a (pol,chan) matrix per row, while the
+/// accessor interface uses nRow x nChannel x nPol cubes. All readers and
+/// writers of the cubes need to swap the row and polarisation axes. This
+/// class encapsulates this operation, so it is done in one place in a 
+/// cache-friendly way.
+///
+/// @copyright (c) 2026 ASKAP, All Rights Reserved.
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_CUBE_TRANSPOSER_TCC
+#define ASKAP_ACCESSORS_CUBE_TRANSPOSER_TCC
+
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief swap the first and the last axes of the cube
+/// @details Element (i,j,k) of the input cube becomes element (k,j,i) of the
+/// output cube. The output cube is resized if necessary. Elements are converted
+/// with TransposeElementConverter.
+/// @param[in] in input cube
+/// @param[in] out output cube
+template<typename In, typename Out>
+void CubeTransposer::transpose(const casacore::Cube<In> &in, casacore::Cube<Out> &out)
+{
+  const casacore::uInt nPol = in.nrow();
+  const casacore::uInt nChan = in.ncolumn();
+  const casacore::uInt nRow = in.nplane();
+  if ((out.nrow() != nRow) || (out.ncolumn() != nChan) || (out.nplane() != nPol)) {
+      out.resize(nRow, nChan, nPol);
+  }
+  if (!in.contiguousStorage() || !out.contiguousStorage()) {
+      // slow version for references to a part of some other array
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+                     out(row,chan,pol) = TransposeElementConverter<In,Out>::convert(in(pol,chan,row));
+                }
+           }
+      }
+      return;
+  }
+  switch (nPol) {
+    case 1:
+      transposeKernel<1>(in.data(), out.data(), nPol, nChan, nRow);
+      break;
+    case 2:
+      transposeKernel<2>(in.data(), out.data(), nPol, nChan, nRow);
+      break;
+    case 4:
+      transposeKernel<4>(in.data(), out.data(), nPol, nChan, nRow);
+      break;
+    default:
+      transposeKernel<0>(in.data(), out.data(), nPol, nChan, nRow);
+  };
+}
+
+/// @brief transpose for a particular number of polarisations
+/// @details This is the actual kernel. The number of polarisations
+/// (the first axis of the input cube) is given by the template parameter. Zero means that
+/// it is not known at compile time and is taken from the first dimension.
+/// @param[in] in pointer to the contiguous input cube (nPol x nChannel x nRow)
+/// @param[in] out pointer to the contiguous output cube (nRow x nChannel x nPol)
+/// @param[in] nPol number of polarisations 
+/// @param[in] nChan number of channels
+/// @param[in] nRow number of rows
+template<casacore::uInt NPol, typename In, typename Out>
+void CubeTransposer::transposeKernel(const In* in, Out* out, casacore::uInt nPol, 
+                              casacore::uInt nChan, casacore::uInt nRow)
+{
+  ASKAPDEBUGASSERT((NPol == 0) || (NPol == nPol));
+  const casacore::uInt pols = NPol == 0 ? nPol : NPol;
+  const size_t outPolStride = size_t(nRow) * nChan;
+  for (casacore::uInt rowStart = 0; rowStart < nRow; rowStart += theirTileSize) {
+       const casacore::uInt rowEnd = std::min(rowStart + theirTileSize, nRow);
+       for (casacore::uInt chanStart = 0; chanStart < nChan; chanStart += theirTileSize) {
+            const casacore::uInt chanEnd = std::min(chanStart + theirTileSize, nChan);
+            for (casacore::uInt row = rowStart; row < rowEnd; ++row) {
+                 // input is contiguous within the tile for a given row
+                 const In* inPtr = in + (size_t(row) * nChan + chanStart) * pols;
+                 Out* outPtr = out + size_t(chanStart) * nRow + row;
+                 for (casacore::uInt chan = chanStart; chan < chanEnd; ++chan, inPtr += pols, outPtr += nRow) {
+                      for (casacore::uInt pol = 0; pol < pols; ++pol) {
+                           outPtr[pol * outPolStride] = TransposeElementConverter<In,Out>::convert(inPtr[pol]);
+                      }
+                 }
+            }
+       }
+  }
+}
+
+/// @brief broadcast values along the channel axis
+/// @details This is a companion method to transpose for the case where the 
+/// input is given per polarisation and row only (e.g. SIGMA column). Element 
+/// (pol,row) of the input matrix becomes elements (row,chan,pol) for all
+/// channels of the output cube. The number of channels is taken from the output 
+/// cube, which should already have the right shape. Nothing is done for an empty cube.
+/// @param[in] in input matrix (nPol x nRow)
+/// @param[in] out output cube (nRow x nChannel x nPol)
+template<typename In, typename Out>
+void CubeTransposer::broadcast(const casacore::Matrix<In> &in, casacore::Cube<Out> &out)
+{
+  const casacore::uInt nPol = in.nrow();
+  const casacore::uInt nRow = in.ncolumn();
+  ASKAPDEBUGASSERT((out.nrow() == nRow) && (out.nplane() == nPol));
+  const casacore::uInt nChan = out.ncolumn();
+  if (out.nelements() == 0) {
+      // nothing to fill, the first channel doesn't exist if nChan is zero
+      return;
+  }
+  for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+       // the first channel is filled from the input, other channels are copies of it
+       casacore::Matrix<Out> polPlane = out.xyPlane(pol);
+       casacore::Vector<Out> firstChan = polPlane.column(0);
+       for (casacore::uInt row = 0; row < nRow; ++row) {
+            firstChan[row] = TransposeElementConverter<In,Out>::convert(in(pol,row));
+       }
+       for (casacore::uInt chan = 1; chan < nChan; ++chan) {
+            polPlane.column(chan) = firstChan;
+       }
+  }
+}
+
+/// @brief transpose one row
+/// @details This is a companion method to transpose for the case where the rows are
+/// read one by one (e.g. if the cell shape varies). Element (pol,chan) of the input 
+/// matrix becomes element (row,chan,pol) of the output cube, which should already have 
+/// the right shape. Elements are converted with TransposeElementConverter.
+/// @param[in] in input matrix (nPol x nChannel)
+/// @param[in] out output cube (nRow x nChannel x nPol)
+/// @param[in] row row of the output cube to fill
+template<typename In, typename Out>
+void CubeTransposer::transposeRow(const casacore::Matrix<In> &in, casacore::Cube<Out> &out, 
+                                  casacore::uInt row)
+{
+  const casacore::uInt nPol = in.nrow();
+  const casacore::uInt nChan = in.ncolumn();
+  const casacore::uInt nRow = out.nrow();
+  ASKAPDEBUGASSERT((row < nRow) && (out.ncolumn() == nChan) && (out.nplane() == nPol));
+  if (!in.contiguousStorage() || !out.contiguousStorage()) {
+      // slow version for references to a part of some other array
+      for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+           for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+                out(row,chan,pol) = TransposeElementConverter<In,Out>::convert(in(pol,chan));
+           }
+      }
+      return;
+  }
+  switch (nPol) {
+    case 1:
+      transposeRowKernel<1>(in.data(), out.data() + row, nPol, nChan, nRow);
+      break;
+    case 2:
+      transposeRowKernel<2>(in.data(), out.data() + row, nPol, nChan, nRow);
+      break;
+    case 4:
+      transposeRowKernel<4>(in.data(), out.data() + row, nPol, nChan, nRow);
+      break;
+    default:
+      transposeRowKernel<0>(in.data(), out.data() + row, nPol, nChan, nRow);
+  };
+}
+
+/// @brief transpose of one row for a particular number of polarisations
+/// @details This is the kernel of transposeRow, the number of polarisations is given by
+/// the template parameter in the same way as for transposeKernel.
+/// @param[in] in pointer to the contiguous input matrix (nPol x nChannel)
+/// @param[in] out pointer to the first element of the row in the contiguous output 
+/// cube (nRow x nChannel x nPol)
+/// @param[in] nPol number of polarisations 
+/// @param[in] nChan number of channels
+/// @param[in] nRow number of rows in the output cube
+template<casacore::uInt NPol, typename In, typename Out>
+void CubeTransposer::transposeRowKernel(const In* in, Out* out, casacore::uInt nPol, 
+                              casacore::uInt nChan, casacore::uInt nRow)
+{
+  ASKAPDEBUGASSERT((NPol == 0) || (NPol == nPol));
+  const casacore::uInt pols = NPol == 0 ? nPol : NPol;
+  const size_t outPolStride = size_t(nRow) * nChan;
+  for (casacore::uInt chan = 0; chan < nChan; ++chan, in += pols, out += nRow) {
+       for (casacore::uInt pol = 0; pol < pols; ++pol) {
+            out[pol * outPolStride] = TransposeElementConverter<In,Out>::convert(in[pol]);
+       }
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CUBE_TRANSPOSER_TCC
@@ -0,0 +1,252 @@
+/// @file
+/// @brief factory creating configured data sources
+/// @details This factory opens the measurement set given in the parset and applies all
+/// performance settings of the table-based data sources (chunking, read-ahead, caches,
+/// buffers, locking and instrumentation), so they can be tuned for a deployment without
+/// changes to the application code. It is the data access counterpart of CalibAccessFactory
+/// and imageAccessFactory.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/dataaccess/DataAccessFactory.h>
+#include <askap/dataaccess/AccessTracer.h>
+#include <askap/dataaccess/HardwareCounters.h>
+#include <askap/dataaccess/IOScheduler.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <askap/dataaccess/TableLocking.h>
+
+// std includes
+#include <string>
+#include <vector>
+
+ASKAP_LOGGER(logger, ".dataaccess");
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief convert megabytes given in the parset into bytes
+/// @param[in] parset parameters
+/// @param[in] key name of the parameter
+/// @return number of bytes
+size_t megabytes(const LOFAR::ParameterSet &parset, const std::string &key)
+{
+  const double mb = parset.getDouble(key);
+  ASKAPCHECK(mb >= 0., "Parameter "<<key<<" should be non-negative, you have "<<mb);
+  return static_cast<size_t>(mb * 1024. * 1024.);
+}
+
+} // anonymous namespace
+
+/// @brief build a read-only data source
+/// @param[in] parset parameters containing description of the source to be constructed
+/// (without leading Cimager., etc)
+/// @return shared pointer to the configured data source
+boost::shared_ptr<TableConstDataSource> DataAccessFactory::roDataSource(const LOFAR::ParameterSet &parset)
+{
+  configureInstrumentation(parset);
+  const std::string dataset = parset.getString("dataset");
+  const std::string dataColumn = parset.getString("datacolumn", "DATA");
+  ASKAPLOG_INFO_STR(logger, "Opening "<<dataset<<" (column "<<dataColumn<<") for reading");
+  const boost::shared_ptr<TableConstDataSource> ds(new TableConstDataSource(dataset, dataColumn,
+            parset.getBool("dataaccess.memorymapped", false), lockOptions(parset)));
+  configure(*ds, parset);
+  return ds;
+}
+
+/// @brief build a read-write data source
+/// @param[in] parset parameters containing description of the source to be constructed
+/// (without leading Cimager., etc)
+/// @return shared pointer to the configured data source
+boost::shared_ptr<TableDataSource> DataAccessFactory::rwDataSource(const LOFAR::ParameterSet &parset)
+{
+  configureInstrumentation(parset);
+  const std::string dataset = parset.getString("dataset");
+  const std::string dataColumn = parset.getString("datacolumn", "DATA");
+  const size_t bufferMemory = parset.isDefined("dataaccess.buffermemory") ?
+                              megabytes(parset, "dataaccess.buffermemory") : 0;
+  ASKAPLOG_INFO_STR(logger, "Opening "<<dataset<<" (column "<<dataColumn<<") for reading and writing");
+  const boost::shared_ptr<TableDataSource> ds(new TableDataSource(dataset, rwOptions(parset), dataColumn,
+            bufferMemory, lockOptions(parset)));
+  configure(*ds, parset);
+  return ds;
+}
+
+/// @brief apply the settings common to read-only and read-write sources
+/// @details This method can also be used for a data source created by other means.
+/// Settings which are not given in the parset are left unchanged.
+/// @param[in] ds data source to configure
+/// @param[in] parset parameters (without leading Cimager., etc)
+void DataAccessFactory::configure(TableConstDataSource &ds, const LOFAR::ParameterSet &parset)
+{
+  const LOFAR::ParameterSet subset = parset.makeSubset("dataaccess.");
+  // the store of rotated uvws uses the tolerance of the uvw machine cache, so the cache goes first
+  if (subset.isDefined("uvwmachines") || subset.isDefined("uvwtolerance")) {
+      ds.configureUVWMachineCache(subset.getUint32("uvwmachines", 1), subset.getDouble("uvwtolerance", 1e-6));
+  }
+  if (subset.isDefined("rotateduvwstore")) {
+      ds.configureRotatedUVWStore(megabytes(subset, "rotateduvwstore"));
+  }
+  if (subset.isDefined("maxchunkrows")) {
+      ds.configureMaxChunkSize(subset.getUint32("maxchunkrows"));
+  }
+  if (subset.isDefined("chunkbudget")) {
+      if (subset.getString("chunkbudget") == "cache") {
+          const size_t cacheSize = TableConstDataSource::lastLevelCacheSize();
+          ASKAPLOG_INFO_STR(logger, "Chunks will be limited to the last level cache size of "<<cacheSize<<" bytes");
+          ds.configureChunkMemoryBudget(cacheSize);
+      } else {
+          ds.configureChunkMemoryBudget(megabytes(subset, "chunkbudget"));
+      }
+  }
+  if (subset.isDefined("maxchannels")) {
+      ds.configureMaxChannels(subset.getUint32("maxchannels"));
+  }
+  if (subset.isDefined("nativelayout")) {
+      ds.configureNativeLayout(subset.getBool("nativelayout"));
+  }
+  if (subset.isDefined("prefetch")) {
+      ds.configurePrefetch(subset.getBool("prefetch"));
+  }
+  if (subset.isDefined("skipflaggedrows")) {
+      ds.configureSkipFlaggedRows(subset.getBool("skipflaggedrows"));
+  }
+  if (subset.isDefined("rowgrouping")) {
+      ds.configureRowGrouping(subset.getBool("rowgrouping"));
+  }
+  if (subset.isDefined("timeordering")) {
+      ds.configureTimeOrdering(subset.getBool("timeordering"), subset.getString("timeorderfile", ""));
+  }
+  if (subset.isDefined("rowindex")) {
+      ds.configureRowIndex(subset.getBool("rowindex"));
+  }
+  if (subset.isDefined("parangleinterval")) {
+      ds.configureParallacticAngleInterpolation(subset.getDouble("parangleinterval"));
+  }
+  if (subset.isDefined("freqframetolerance")) {
+      ds.configureFrequencyFrameTolerance(subset.getDouble("freqframetolerance"));
+  }
+  if (subset.isDefined("compactvisibility")) {
+      const std::string format = subset.getString("compactvisibility");
+      ASKAPCHECK((format == "int16") || (format == "float16"), "Unknown format of compact visibilities "<<
+                 format<<", use int16 or float16");
+      ds.configureCompactVisibility(format == "int16" ? CompactVisibilityCube::COMPLEX_INT16 :
+                                    CompactVisibilityCube::COMPLEX_FLOAT16);
+  }
+  if (subset.isDefined("statistics")) {
+      ds.configureStatistics(subset.getBool("statistics"));
+  }
+  if (subset.isDefined("qcstatistics")) {
+      ds.configureQCStatistics(subset.getBool("qcstatistics"));
+  }
+}
+
+/// @brief apply the settings specific to read-write sources
+/// @details This method calls configure for the common settings.
+/// @param[in] ds data source to configure
+/// @param[in] parset parameters (without leading Cimager., etc)
+void DataAccessFactory::configure(TableDataSource &ds, const LOFAR::ParameterSet &parset)
+{
+  configure(static_cast<TableConstDataSource&>(ds), parset);
+  const LOFAR::ParameterSet subset = parset.makeSubset("dataaccess.");
+  if (subset.isDefined("writebehind")) {
+      ds.configureWriteBehind(subset.getUint32("writebehind"));
+  }
+  if (subset.isDefined("compressedbuffers")) {
+      const std::string codecName = subset.getString("buffercodec", "float16");
+      BufferCodec::Type codec = BufferCodec::NONE;
+      if (codecName == "float16") {
+          codec = BufferCodec::FLOAT16;
+      } else if (codecName == "quant8") {
+          codec = BufferCodec::QUANT8;
+      } else {
+          ASKAPCHECK(codecName == "none", "Unknown buffer codec "<<codecName<<", use none, float16 or quant8");
+      }
+      const std::vector<std::string> names = subset.getStringVector("compressedbuffers");
+      for (std::vector<std::string>::const_iterator ci = names.begin(); ci != names.end(); ++ci) {
+           ds.configureBufferCompression(*ci, codec);
+      }
+  }
+}
+
+/// @brief switch on the process-wide instrumentation if requested
+/// @param[in] parset parameters
+void DataAccessFactory::configureInstrumentation(const LOFAR::ParameterSet &parset)
+{
+  AccessTracer::instance().configure(parset, "dataaccess.trace");
+  HardwareCounters::instance().configure(parset, "dataaccess.hwcounters");
+  MemoryGovernor::instance().configure(parset, "dataaccess.memorybudget");
+  IOScheduler::instance().configure(parset, "dataaccess.io");
+}
+
+/// @brief lock options requested in the parset
+/// @param[in] parset parameters
+/// @return lock options (casacore default if not given)
+casacore::TableLock DataAccessFactory::lockOptions(const LOFAR::ParameterSet &parset)
+{
+  return TableLocking::lockOptions(parset.getString("dataaccess.locking", "default"));
+}
+
+/// @brief options of the read-write source requested in the parset
+/// @param[in] parset parameters
+/// @return options from TableDataSource::TableDataSourceOptions or'ed together
+int DataAccessFactory::rwOptions(const LOFAR::ParameterSet &parset)
+{
+  int opt = TableDataSource::DEFAULT;
+  if (parset.getBool("dataaccess.writepermitted", false)) {
+      opt |= TableDataSource::WRITE_PERMITTED;
+  }
+  if (parset.getBool("dataaccess.removebuffers", false)) {
+      opt |= TableDataSource::REMOVE_BUFFERS;
+  }
+  if (parset.getBool("dataaccess.memorymapped", false)) {
+      opt |= TableDataSource::MEMORY_MAPPED;
+  }
+  const std::string buffers = parset.getString("dataaccess.buffers", "table");
+  if (buffers == "memory") {
+      opt |= TableDataSource::MEMORY_BUFFERS;
+  } else if (buffers == "file") {
+      opt |= TableDataSource::FILE_BUFFERS;
+  } else if (buffers == "hybrid") {
+      opt |= TableDataSource::HYBRID_BUFFERS;
+  } else {
+      ASKAPCHECK(buffers == "table", "Unknown buffer storage "<<buffers<<", use table, memory, file or hybrid");
+  }
+  return opt;
+}
+
+} // namespace accessors
+
+} // namespace askap
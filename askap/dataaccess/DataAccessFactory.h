@@ -0,0 +1,124 @@
+/// @file
+/// @brief factory creating configured data sources
+/// @details This factory opens the measurement set given in the parset and applies all
+/// performance settings of the table-based data sources (chunking, read-ahead, caches,
+/// buffers, locking and instrumentation), so they can be tuned for a deployment without
+/// changes to the application code. It is the data access counterpart of CalibAccessFactory
+/// and imageAccessFactory.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_DATA_ACCESS_FACTORY_H
+#define ASKAP_ACCESSORS_DATA_ACCESS_FACTORY_H
+
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/TableDataSource.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief factory creating configured data sources
+/// @details The measurement set is given by the dataset keyword and the data column by
+/// datacolumn (DATA by default). All other keywords are optional and have the "dataaccess."
+/// prefix; the defaults of the data source are used if they are not given:
+///
+/// Opening: memorymapped (bool), locking (see TableLocking), and for read-write sources
+/// writepermitted (bool), buffers (table, memory, file or hybrid), buffermemory (MB of 
+/// the hybrid buffers), removebuffers (bool);
+///
+/// Chunks: maxchunkrows, chunkbudget (MB or "cache" for the size of the last level cache,
+/// see TableConstDataSource::configureChunkMemoryBudget), maxchannels, nativelayout, 
+/// prefetch, skipflaggedrows, rowgrouping, timeordering and timeorderfile, rowindex;
+///
+/// Caches: uvwmachines and uvwtolerance (uvw machine cache), rotateduvwstore (MB), 
+/// parangleinterval (s), freqframetolerance (s), compactvisibility (int16 or float16);
+///
+/// Read-write sources: writebehind (chunks), buffercodec (none, float16 or quant8) applied
+/// to the buffers listed in compressedbuffers;
+///
+/// Instrumentation: statistics and qcstatistics (bool), trace (see AccessTracer),
+/// hwcounters (see HardwareCounters) and memorybudget (MB, see MemoryGovernor);
+///
+/// Background I/O: iothreads and iobandwidth.critical, iobandwidth.normal and iobandwidth.bulk
+/// (MB/s), see IOScheduler.
+/// @note Factory methods are static, the same as for CalibAccessFactory
+/// @ingroup dataaccess_tab
+struct DataAccessFactory {
+
+   /// @brief build a read-only data source
+   /// @param[in] parset parameters containing description of the source to be constructed
+   /// (without leading Cimager., etc)
+   /// @return shared pointer to the configured data source
+   static boost::shared_ptr<TableConstDataSource> roDataSource(const LOFAR::ParameterSet &parset);
+
+   /// @brief build a read-write data source
+   /// @param[in] parset parameters containing description of the source to be constructed
+   /// (without leading Cimager., etc)
+   /// @return shared pointer to the configured data source
+   static boost::shared_ptr<TableDataSource> rwDataSource(const LOFAR::ParameterSet &parset);
+
+   /// @brief apply the settings common to read-only and read-write sources
+   /// @details This method can also be used for a data source created by other means.
+   /// Settings which are not given in the parset are left unchanged.
+   /// @param[in] ds data source to configure
+   /// @param[in] parset parameters (without leading Cimager., etc)
+   static void configure(TableConstDataSource &ds, const LOFAR::ParameterSet &parset);
+
+   /// @brief apply the settings specific to read-write sources
+   /// @details This method calls configure for the common settings.
+   /// @param[in] ds data source to configure
+   /// @param[in] parset parameters (without leading Cimager., etc)
+   static void configure(TableDataSource &ds, const LOFAR::ParameterSet &parset);
+
+protected:
+   /// @brief switch on the process-wide instrumentation if requested
+   /// @param[in] parset parameters
+   static void configureInstrumentation(const LOFAR::ParameterSet &parset);
+
+   /// @brief lock options requested in the parset
+   /// @param[in] parset parameters
+   /// @return lock options (casacore default if not given)
+   static casacore::TableLock lockOptions(const LOFAR::ParameterSet &parset);
+
+   /// @brief options of the read-write source requested in the parset
+   /// @param[in] parset parameters
+   /// @return options from TableDataSource::TableDataSourceOptions or'ed together
+   static int rwOptions(const LOFAR::ParameterSet &parset);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DATA_ACCESS_FACTORY_H
@@ -54,12 +54,45 @@ casacore::MVDirection
     DirectionConverter::operator()(const casacore::MDirection &in) const
 {
     /// this class is supposed to be used in the most general case, hence
-    /// we do all conversions. Specializations can be written for the cases
-    /// when either frame or unit conversions are not required
+    /// we do all conversions, unless the input is already in the target frame
+    if (isTargetFrame(in.getRef())) {
+        return in.getValue();
+    }
     return MDirection::Convert(in.getRef(),
                              itsTargetFrame)(in).getValue();    
 }
 
+/// @brief convert a number of directions given in the same frame
+/// @details The conversion engine is set up once for all elements. If the
+/// input frame coincides with the target one, directions are just copied.
+/// @param[in] in directions to convert
+/// @param[in] ref reference frame of the input directions
+/// @param[out] out converted directions (resized as required)
+void DirectionConverter::convert(const casacore::Vector<casacore::MVDirection> &in,
+                         const casacore::MDirection::Ref &ref,
+                         casacore::Vector<casacore::MVDirection> &out) const
+{
+  out.resize(in.nelements());
+  if (isTargetFrame(ref)) {
+      out = in;
+      return;
+  }
+  MDirection::Convert engine(ref, itsTargetFrame);
+  for (casacore::uInt i = 0; i < in.nelements(); ++i) {
+       out[i] = engine(in[i]).getValue();
+  }
+}
+
+/// @brief check whether conversion from the given frame is trivial
+/// @param[in] ref input reference frame
+/// @return true, if the frame type is the same as the target one and no
+/// offsets are involved
+bool DirectionConverter::isTargetFrame(const casacore::MDirection::Ref &ref) const
+{
+  return (ref.getType() == itsTargetFrame.getType()) && (ref.offset() == 0) &&
+         (itsTargetFrame.offset() == 0);
+}
+
 /// set a frame (i.e. time and/or position), where the
 /// conversion is performed
 /// @param frame  MeasFrame object (can be constructed from
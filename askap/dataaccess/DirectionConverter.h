@@ -62,12 +62,29 @@ struct DirectionConverter : public IDirectionConverter {
     /// @param in an epoch to convert. 
     virtual casacore::MVDirection operator()(const casacore::MDirection &in) const;
 
+    /// @brief convert a number of directions given in the same frame
+    /// @details The conversion engine is set up once for all elements. If the
+    /// input frame coincides with the target one, directions are just copied.
+    /// @param[in] in directions to convert
+    /// @param[in] ref reference frame of the input directions
+    /// @param[out] out converted directions (resized as required)
+    virtual void convert(const casacore::Vector<casacore::MVDirection> &in,
+                         const casacore::MDirection::Ref &ref,
+                         casacore::Vector<casacore::MVDirection> &out) const;
+
     /// set a frame (i.e. time and/or position), where the
     /// conversion is performed
     /// @param frame  MeasFrame object (can be constructed from
     ///               MPosition or MEpoch on-the-fly)
     virtual void setMeasFrame(const casacore::MeasFrame &frame);
 
+protected:
+    /// @brief check whether conversion from the given frame is trivial
+    /// @param[in] ref input reference frame
+    /// @return true, if the frame type is the same as the target one and no
+    /// offsets are involved
+    bool isTargetFrame(const casacore::MDirection::Ref &ref) const;
+
 private:
     casacore::MDirection::Ref itsTargetFrame;    
 };
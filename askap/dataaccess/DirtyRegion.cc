@@ -0,0 +1,86 @@
+/// @file
+/// @brief rectangular part of a chunk modified by the user
+///
+/// @details Writable accessors give out a reference to the whole cube. The 
+/// caller can declare which rows and channels have actually been changed, so
+/// only this part is written back (e.g. when flagging a narrow band). This class
+/// represents such a declaration as the bounding box of all modified regions.
+///
+/// @copyright (c) 2026 CSIRO
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/DirtyRegion.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty region
+DirtyRegion::DirtyRegion() : itsEmpty(true), itsStartRow(0), itsEndRow(0), 
+           itsStartChan(0), itsEndChan(0) {}
+
+/// @brief extend the region
+/// @param[in] startRow first modified row
+/// @param[in] nRow number of modified rows
+/// @param[in] startChan first modified channel
+/// @param[in] nChan number of modified channels
+void DirtyRegion::add(casacore::uInt startRow, casacore::uInt nRow, casacore::uInt startChan, 
+           casacore::uInt nChan)
+{
+  ASKAPCHECK((nRow > 0) && (nChan > 0), "Modified region should contain at least one row and one channel");
+  if (itsEmpty) {
+      itsEmpty = false;
+      itsStartRow = startRow;
+      itsEndRow = startRow + nRow;
+      itsStartChan = startChan;
+      itsEndChan = startChan + nChan;
+  } else {
+      itsStartRow = std::min(itsStartRow, startRow);
+      itsEndRow = std::max(itsEndRow, startRow + nRow);
+      itsStartChan = std::min(itsStartChan, startChan);
+      itsEndChan = std::max(itsEndChan, startChan + nChan);
+  }
+}
+
+/// @brief make the region empty
+void DirtyRegion::clear()
+{
+  itsEmpty = true;
+  itsStartRow = itsEndRow = itsStartChan = itsEndChan = 0;
+}
+
+/// @brief check that the region fits into the cube of the given shape
+/// @param[in] nRow number of rows in the cube
+/// @param[in] nChan number of channels in the cube
+/// @return true, if the region is inside the cube
+bool DirtyRegion::fits(casacore::uInt nRow, casacore::uInt nChan) const
+{
+  return (itsEndRow <= nRow) && (itsEndChan <= nChan);
+}
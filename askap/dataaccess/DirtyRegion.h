@@ -0,0 +1,110 @@
+/// @file
+/// @brief rectangular part of a chunk modified by the user
+///
+/// @details Writable accessors give out a reference to the whole cube. The 
+/// caller can declare which rows and channels have actually been changed, so
+/// only this part is written back (e.g. when flagging a narrow band). This class
+/// represents such a declaration as the bounding box of all modified regions.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_DIRTY_REGION_H
+#define ASKAP_ACCESSORS_DIRTY_REGION_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief rectangular part of a chunk modified by the user
+/// @details The region is defined by ranges of rows and channels of the 
+/// accessor (all polarisations are always included). Subsequent declarations 
+/// extend the region to the bounding box of all declared parts. An empty region means
+/// that nothing has been declared, writers treat this case as if the whole cube has 
+/// been modified.
+/// @ingroup dataaccess_hlp
+class DirtyRegion {
+public:
+  /// @brief construct an empty region
+  DirtyRegion();
+
+  /// @brief extend the region
+  /// @param[in] startRow first modified row
+  /// @param[in] nRow number of modified rows
+  /// @param[in] startChan first modified channel
+  /// @param[in] nChan number of modified channels
+  void add(casacore::uInt startRow, casacore::uInt nRow, casacore::uInt startChan, 
+           casacore::uInt nChan);
+
+  /// @brief make the region empty
+  void clear();
+
+  /// @brief check whether anything has been declared
+  /// @return true, if the region is empty
+  inline bool empty() const { return itsEmpty; }
+
+  /// @brief check that the region fits into the cube of the given shape
+  /// @param[in] nRow number of rows in the cube
+  /// @param[in] nChan number of channels in the cube
+  /// @return true, if the region is inside the cube
+  bool fits(casacore::uInt nRow, casacore::uInt nChan) const;
+
+  /// @return first row of the region
+  inline casacore::uInt startRow() const { return itsStartRow; }
+
+  /// @return number of rows in the region
+  inline casacore::uInt nRow() const { return itsEndRow - itsStartRow; }
+
+  /// @return first channel of the region
+  inline casacore::uInt startChannel() const { return itsStartChan; }
+
+  /// @return number of channels in the region
+  inline casacore::uInt nChannel() const { return itsEndChan - itsStartChan; }
+
+private:
+  /// @brief true, if nothing has been declared
+  bool itsEmpty;
+
+  /// @brief first row
+  casacore::uInt itsStartRow;
+
+  /// @brief row following the last one
+  casacore::uInt itsEndRow;
+
+  /// @brief first channel
+  casacore::uInt itsStartChan;
+
+  /// @brief channel following the last one
+  casacore::uInt itsEndChan;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DIRTY_REGION_H
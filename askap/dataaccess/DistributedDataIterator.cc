@@ -0,0 +1,228 @@
+/// @file
+/// @brief iterator distributing chunks of data between MPI ranks
+/// @details This iterator wraps an iterator over the whole dataset and delivers each
+/// rank only its share of the data. The data can either be read by every rank (each
+/// rank skips the chunks assigned to other ranks) or by a few reader ranks which send
+/// chunks to the worker ranks, so the file system is not accessed by all ranks at once.
+///
+/// @copyright (c) 2026 CSIRO
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/DistributedDataIterator.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the iterator
+/// @details In the local mode, the iterator is positioned at the first chunk of the
+/// given rank. In the reader/worker mode, there are no data until init() is called.
+/// @param[in] comms communication object
+/// @param[in] iter iterator over the whole dataset (may be empty on worker ranks in the 
+/// reader/worker mode)
+/// @param[in] nReaders number of reader ranks, zero means the local mode (every rank reads
+/// its own share of the data)
+DistributedDataIterator::DistributedDataIterator(askapparallel::AskapParallel &comms, 
+            const boost::shared_ptr<IConstDataIterator> &iter, int nReaders) : itsComms(comms),
+            itsIterator(iter), itsNReaders(nReaders), itsPart(0), itsNParts(1), itsNSteps(0),
+            itsLastTime(0.), itsNChunks(0)
+{
+  ASKAPCHECK(nReaders >= 0, "Number of reader ranks should be non-negative, you have "<<nReaders);
+  if (!itsComms.isParallel()) {
+      // everything is done by this process
+      itsNReaders = 0;
+  }
+  const int rank = itsComms.rank();
+  const int nProcs = itsComms.nProcs();
+  if (itsNReaders == 0) {
+      ASKAPCHECK(itsIterator, "DistributedDataIterator in the local mode requires an iterator on every rank");
+      itsPart = rank;
+      itsNParts = nProcs;
+      skipForeignChunks();
+  } else {
+      ASKAPCHECK(2 * itsNReaders <= nProcs, "Each of "<<itsNReaders<<" reader ranks needs at least one worker, only "<<
+                 nProcs<<" ranks are available");
+      if (rank < itsNReaders) {
+          ASKAPCHECK(itsIterator, "DistributedDataIterator requires an iterator on the reader rank "<<rank);
+          for (int worker = itsNReaders + rank; worker < nProcs; worker += itsNReaders) {
+               itsPeers.push_back(worker);
+          }
+      } else {
+          itsPeers.push_back((rank - itsNReaders) % itsNReaders);
+      }
+  }
+}
+
+/// Restart the iteration from the beginning
+void DistributedDataIterator::init()
+{
+  itsNChunks = 0;
+  itsNSteps = 0;
+  if (itsNReaders == 0) {
+      itsIterator->init();
+      skipForeignChunks();
+  } else if (isReader()) {
+      serve();
+  } else {
+      ASKAPCHECK(!itsReceived, "DistributedDataIterator::init() is called on a worker before the end of the previous pass");
+      receive();
+  }
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the current chunk
+const IConstDataAccessor& DistributedDataIterator::operator*() const
+{
+  if (itsNReaders == 0) {
+      return *(*itsIterator);
+  }
+  if (isReader()) {
+      ASKAPTHROW(DataAccessLogicError, "No data are delivered by DistributedDataIterator on a reader rank");
+  }
+  ASKAPCHECK(itsReceived, "No more data available in DistributedDataIterator");
+  return *itsReceived;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool DistributedDataIterator::hasMore() const throw()
+{
+  if (itsNReaders == 0) {
+      return itsIterator->hasMore();
+  }
+  return itsReceived ? casacore::True : casacore::False;
+}
+
+/// advance the iterator one step further 
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool DistributedDataIterator::next()
+{
+  ASKAPCHECK(hasMore(), "No more data available in DistributedDataIterator");
+  ++itsNChunks;
+  if (itsNReaders == 0) {
+      itsIterator->next();
+      skipForeignChunks();
+  } else {
+      receive();
+  }
+  return hasMore();
+}
+
+/// @brief check whether this rank reads data for other ranks
+/// @return true if this rank is a reader in the reader/worker mode
+bool DistributedDataIterator::isReader() const
+{
+  return (itsNReaders > 0) && (itsComms.rank() < itsNReaders);
+}
+
+/// @brief obtain the index of the time step of the current chunk
+/// @details This method counts distinct consecutive time stamps of the wrapped iterator.
+/// @param[in] time time stamp of the current chunk
+/// @return zero-based index of the time step
+size_t DistributedDataIterator::timeStep(double time)
+{
+  if ((itsNSteps == 0) || (time != itsLastTime)) {
+      ++itsNSteps;
+      itsLastTime = time;
+  }
+  return itsNSteps - 1;
+}
+
+/// @brief advance the wrapped iterator to the next chunk of this rank (local mode)
+/// @details Nothing is done if the current chunk already belongs to this rank.
+void DistributedDataIterator::skipForeignChunks()
+{
+  ASKAPDEBUGASSERT(itsNParts > 0);
+  IConstDataIterator &it = *itsIterator;
+  for (; it.hasMore(); it.next()) {
+       if (timeStep(it->time()) % size_t(itsNParts) == size_t(itsPart)) {
+           break;
+       }
+  }
+}
+
+/// @brief send all chunks to the workers of this reader (reader/worker mode)
+void DistributedDataIterator::serve()
+{
+  ASKAPDEBUGASSERT(itsPeers.size() > 0);
+  IConstDataIterator &it = *itsIterator;
+  LOFAR::BlobString bs;
+  for (it.init(); it.hasMore(); it.next(), ++itsNChunks) {
+       const int worker = itsPeers[timeStep(it->time()) % itsPeers.size()];
+       bs.resize(0);
+       LOFAR::BlobOBufString bob(bs);
+       LOFAR::BlobOStream out(bob);
+       out.putStart("DistributedChunk", 1);
+       out << true;
+       CachedDataAccessor::serialise(*it, out);
+       out.putEnd();
+       itsComms.sendBlob(bs, worker);
+  }
+  // tell all workers that this pass is complete
+  for (size_t index = 0; index < itsPeers.size(); ++index) {
+       bs.resize(0);
+       LOFAR::BlobOBufString bob(bs);
+       LOFAR::BlobOStream out(bob);
+       out.putStart("DistributedChunk", 1);
+       out << false;
+       out.putEnd();
+       itsComms.sendBlob(bs, itsPeers[index]);
+  }
+}
+
+/// @brief receive the next chunk from the reader (reader/worker mode)
+void DistributedDataIterator::receive()
+{
+  ASKAPDEBUGASSERT(itsPeers.size() == 1);
+  LOFAR::BlobString bs;
+  bs.resize(0);
+  itsComms.receiveBlob(bs, itsPeers[0]);
+  LOFAR::BlobIBufString bib(bs);
+  LOFAR::BlobIStream in(bib);
+  const int version = in.getStart("DistributedChunk");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the chunk sent by the reader");
+  bool hasData = false;
+  in >> hasData;
+  if (hasData) {
+      itsReceived.reset(new CachedDataAccessor(in));
+  } else {
+      itsReceived.reset();
+  }
+  in.getEnd();
+}
+
+} // namespace accessors
+
+} // namespace askap
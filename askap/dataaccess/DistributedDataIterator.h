@@ -0,0 +1,166 @@
+/// @file
+/// @brief iterator distributing chunks of data between MPI ranks
+/// @details This iterator wraps an iterator over the whole dataset and delivers each
+/// rank only its share of the data. The data can either be read by every rank (each
+/// rank skips the chunks assigned to other ranks) or by a few reader ranks which send
+/// chunks to the worker ranks, so the file system is not accessed by all ranks at once.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_DISTRIBUTED_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_DISTRIBUTED_DATA_ITERATOR_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/CachedDataAccessor.h>
+#include <askap/askapparallel/AskapParallel.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iterator distributing chunks of data between MPI ranks
+/// @details Data are distributed by time steps: all chunks with the same time stamp go
+/// to the same rank and the steps are assigned to ranks in the round-robin fashion (i.e.
+/// the scheduling is static). Two modes are supported:
+///
+/// In the local mode (no reader ranks), every rank has its own iterator over the whole 
+/// dataset and this adapter skips the chunks of other ranks. Only the time stamp is
+/// obtained for skipped chunks, so the bulk data are read by their owners only.
+///
+/// In the reader/worker mode, the first nReaders ranks read the data and send chunks to
+/// the remaining (worker) ranks. Each reader serves every nReaders-th worker, so the
+/// readers work in parallel with a disjoint set of workers. Only reader ranks need an 
+/// iterator over the dataset (the pointer is ignored on the workers, so the dataset 
+/// doesn't have to be opened there). A pass over the data is started by init() which is 
+/// collective between a reader and its workers: on a reader rank it sends all chunks 
+/// before returning and the iterator has no data afterwards, on a worker it receives the 
+/// first chunk. Workers should iterate to the end of a pass before calling init() again.
+/// The accessors delivered on workers are CachedDataAccessors received from the reader,
+/// the read-only interface is the same as for the local data.
+///
+/// If the application is not run in parallel, this class just delivers all chunks of 
+/// the wrapped iterator.
+/// @ingroup dataaccess_hlp
+class DistributedDataIterator : virtual public IConstDataIterator,
+                                private boost::noncopyable
+{
+public:
+  /// @brief construct the iterator
+  /// @details In the local mode, the iterator is positioned at the first chunk of the
+  /// given rank. In the reader/worker mode, there are no data until init() is called.
+  /// @param[in] comms communication object
+  /// @param[in] iter iterator over the whole dataset (may be empty on worker ranks in the 
+  /// reader/worker mode)
+  /// @param[in] nReaders number of reader ranks, zero means the local mode (every rank reads
+  /// its own share of the data)
+  DistributedDataIterator(askapparallel::AskapParallel &comms, 
+                          const boost::shared_ptr<IConstDataIterator> &iter, int nReaders = 0);
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the current chunk
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @brief check whether this rank reads data for other ranks
+  /// @return true if this rank is a reader in the reader/worker mode
+  bool isReader() const;
+
+  /// @brief number of chunks delivered or sent by this rank in the current pass
+  /// @return number of chunks
+  inline size_t nChunks() const { return itsNChunks; }
+
+protected:
+  /// @brief advance the wrapped iterator to the next chunk of this rank (local mode)
+  /// @details Nothing is done if the current chunk already belongs to this rank.
+  void skipForeignChunks();
+
+  /// @brief obtain the index of the time step of the current chunk
+  /// @details This method counts distinct consecutive time stamps of the wrapped iterator.
+  /// @param[in] time time stamp of the current chunk
+  /// @return zero-based index of the time step
+  size_t timeStep(double time);
+
+  /// @brief send all chunks to the workers of this reader (reader/worker mode)
+  void serve();
+
+  /// @brief receive the next chunk from the reader (reader/worker mode)
+  void receive();
+
+private:
+  /// @brief communication object
+  askapparallel::AskapParallel &itsComms;
+
+  /// @brief wrapped iterator (may be empty on worker ranks)
+  boost::shared_ptr<IConstDataIterator> itsIterator;
+
+  /// @brief number of reader ranks, zero in the local mode
+  int itsNReaders;
+
+  /// @brief ranks which receive the data from this reader or the rank of the reader for a worker
+  std::vector<int> itsPeers;
+
+  /// @brief index of this rank amongst ranks sharing the data in the local mode
+  int itsPart;
+
+  /// @brief number of ranks sharing the data in the local mode
+  int itsNParts;
+
+  /// @brief number of time steps encountered so far in this pass
+  size_t itsNSteps;
+
+  /// @brief time stamp of the last time step
+  double itsLastTime;
+
+  /// @brief number of chunks delivered or sent in this pass
+  size_t itsNChunks;
+
+  /// @brief chunk received from the reader, empty if there are no more data
+  boost::shared_ptr<CachedDataAccessor> itsReceived;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DISTRIBUTED_DATA_ITERATOR_H
@@ -60,15 +60,52 @@ EpochConverter::EpochConverter(const casacore::MEpoch &targetOrigin,
 casacore::Double EpochConverter::operator()(const casacore::MEpoch &in) const
 {
   /// this class is supposed to be used in the most general case, hence
-  /// we do all conversions. Specializations can be written for the cases
-  /// when either frame or unit conversions are not required
-  MVEpoch converted=MEpoch::Convert(in.getRef(),
-                        itsTargetRef)(in).getValue();
+  /// we do all conversions, unless the input is already in the target frame
+  MVEpoch converted = isTargetFrame(in.getRef()) ? in.getValue() :
+             MEpoch::Convert(in.getRef(), itsTargetRef)(in).getValue();
   // relative to the origin
   converted-=itsTargetOrigin;
   return converted.getTime(itsTargetUnit).getValue();
 }
 
+/// @brief convert a number of epochs given in the same frame
+/// @details The conversion engine is set up once for all elements. If the
+/// input frame coincides with the target one, no measures conversion is done.
+/// @param[in] in epochs to convert given as Doubles (w.r.t. MJD 0)
+/// @param[in] unit units of the input values
+/// @param[in] ref reference frame of the input values
+/// @param[out] out converted epochs in the target units/frame (resized as required)
+void EpochConverter::convert(const casacore::Vector<casacore::Double> &in,
+                const casacore::Unit &unit, const casacore::MEpoch::Ref &ref,
+                casacore::Vector<casacore::Double> &out) const
+{
+  out.resize(in.nelements());
+  if (isTargetFrame(ref)) {
+      for (casacore::uInt i = 0; i < in.nelements(); ++i) {
+           MVEpoch converted(Quantity(in[i], unit));
+           converted -= itsTargetOrigin;
+           out[i] = converted.getTime(itsTargetUnit).getValue();
+      }
+  } else {
+      MEpoch::Convert engine(ref, itsTargetRef);
+      for (casacore::uInt i = 0; i < in.nelements(); ++i) {
+           MVEpoch converted = engine(MVEpoch(Quantity(in[i], unit))).getValue();
+           converted -= itsTargetOrigin;
+           out[i] = converted.getTime(itsTargetUnit).getValue();
+      }
+  }
+}
+
+/// @brief check whether conversion from the given frame is trivial
+/// @param[in] ref input reference frame
+/// @return true, if the frame type is the same as the target one and no
+/// offsets are involved
+bool EpochConverter::isTargetFrame(const casacore::MEpoch::Ref &ref) const
+{
+  return (ref.getType() == itsTargetRef.getType()) && (ref.offset() == 0) &&
+         (itsTargetRef.offset() == 0);
+}
+
 /// set a frame (for epochs it is just a position), where the
 /// conversion is performed
 void EpochConverter::setMeasFrame(const casacore::MeasFrame &frame)
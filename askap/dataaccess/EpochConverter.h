@@ -74,11 +74,28 @@ struct EpochConverter : public IEpochConverter {
     /// @return the same epoch as a fully qualified measure
     casacore::MEpoch toMeasure(const casacore::MVEpoch &in) const throw();
 
+    /// @brief convert a number of epochs given in the same frame
+    /// @details The conversion engine is set up once for all elements. If the
+    /// input frame coincides with the target one, no measures conversion is done.
+    /// @param[in] in epochs to convert given as Doubles (w.r.t. MJD 0)
+    /// @param[in] unit units of the input values
+    /// @param[in] ref reference frame of the input values
+    /// @param[out] out converted epochs in the target units/frame (resized as required)
+    virtual void convert(const casacore::Vector<casacore::Double> &in,
+                         const casacore::Unit &unit, const casacore::MEpoch::Ref &ref,
+                         casacore::Vector<casacore::Double> &out) const;
 
     /// set a frame (for epochs it is just a position), where the
     /// conversion is performed
     virtual void setMeasFrame(const casacore::MeasFrame &frame);
 
+protected:
+    /// @brief check whether conversion from the given frame is trivial
+    /// @param[in] ref input reference frame
+    /// @return true, if the frame type is the same as the target one and no
+    /// offsets are involved
+    bool isTargetFrame(const casacore::MEpoch::Ref &ref) const;
+
 private:
     casacore::MVEpoch itsTargetOrigin;
     casacore::MEpoch::Ref itsTargetRef;
@@ -0,0 +1,129 @@
+/// @file
+/// @brief uvw rotated to a number of tangent points at once
+/// @details Faceted imaging needs the uvw rotated to the tangent point of each facet.
+/// This class holds the rotated uvws and the associated delays for a list of tangent
+/// points (facets) and all rows of a chunk, so the rotation can be done in one pass over
+/// the rows and cached for the whole chunk instead of recomputing the single-tangent
+/// result for every facet.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/FacetRotatedUVW.h>
+#include <askap/dataaccess/IFacetUVWDataAccessor.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief empty object (no facets)
+FacetRotatedUVW::FacetRotatedUVW() {}
+
+/// @brief rotated uvw for the given facet
+/// @param[in] facet facet index
+/// @return vector with rotated uvw for each row (references the internal buffer)
+casacore::Vector<casacore::RigidVector<casacore::Double, 3> > FacetRotatedUVW::uvw(casacore::uInt facet) const
+{
+  ASKAPDEBUGASSERT(facet < nFacets());
+  return itsUVW.column(facet);
+}
+
+/// @brief delays associated with the rotation for the given facet
+/// @param[in] facet facet index
+/// @return vector with delays for each row (references the internal buffer)
+casacore::Vector<casacore::Double> FacetRotatedUVW::delays(casacore::uInt facet) const
+{
+  ASKAPDEBUGASSERT(facet < nFacets());
+  return itsDelays.column(facet);
+}
+
+/// @brief set up the buffers
+/// @details The content of the buffers is undefined after this call, it is expected
+/// to be filled via rwUVW and rwDelays.
+/// @param[in] nRow number of rows
+/// @param[in] tangentPoints tangent points of all facets
+void FacetRotatedUVW::resize(casacore::uInt nRow, const std::vector<casacore::MDirection> &tangentPoints)
+{
+  itsTangentPoints = tangentPoints;
+  itsUVW.resize(nRow, tangentPoints.size());
+  itsDelays.resize(nRow, tangentPoints.size());
+}
+
+/// @brief read-write access to the rotated uvw of the given facet
+/// @param[in] facet facet index
+/// @return vector referencing the internal buffer
+casacore::Vector<casacore::RigidVector<casacore::Double, 3> > FacetRotatedUVW::rwUVW(casacore::uInt facet)
+{
+  ASKAPDEBUGASSERT(facet < nFacets());
+  return itsUVW.column(facet);
+}
+
+/// @brief read-write access to the delays of the given facet
+/// @param[in] facet facet index
+/// @return vector referencing the internal buffer
+casacore::Vector<casacore::Double> FacetRotatedUVW::rwDelays(casacore::uInt facet)
+{
+  ASKAPDEBUGASSERT(facet < nFacets());
+  return itsDelays.column(facet);
+}
+
+/// @brief fill the buffers facet by facet
+/// @details This is the generic implementation used for accessors which can't rotate
+/// uvw for many tangent points at once. It calls rotatedUVW and uvwRotationDelay for
+/// each tangent point.
+/// @param[in] acc accessor
+/// @param[in] tangentPoints tangent points of all facets
+void FacetRotatedUVW::fill(const IConstDataAccessor &acc, const std::vector<casacore::MDirection> &tangentPoints)
+{
+  resize(acc.nRow(), tangentPoints);
+  for (casacore::uInt facet = 0; facet < nFacets(); ++facet) {
+       const casacore::MDirection &tangent = itsTangentPoints[facet];
+       rwUVW(facet) = acc.rotatedUVW(tangent);
+       rwDelays(facet) = acc.uvwRotationDelay(tangent, tangent);
+  }
+}
+
+/// @brief obtain uvw rotated to a number of tangent points
+/// @details The result is taken from the accessor if it implements IFacetUVWDataAccessor
+/// (and is cached there for the whole chunk). Otherwise, the buffer is filled by rotating
+/// uvws for one tangent point at a time.
+/// @param[in] acc accessor
+/// @param[in] tangentPoints tangent points of all facets
+/// @param[in] buffer buffer used if the accessor doesn't support batched rotation
+/// @return a reference to the rotated uvws (either the accessor's cache or the buffer)
+const FacetRotatedUVW& facetRotatedUVW(const IConstDataAccessor &acc,
+              const std::vector<casacore::MDirection> &tangentPoints, FacetRotatedUVW &buffer)
+{
+  const IFacetUVWDataAccessor *facetAcc = dynamic_cast<const IFacetUVWDataAccessor*>(&acc);
+  if (facetAcc != NULL) {
+      return facetAcc->facetRotatedUVW(tangentPoints);
+  }
+  buffer.fill(acc, tangentPoints);
+  return buffer;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,149 @@
+/// @file
+/// @brief uvw rotated to a number of tangent points at once
+/// @details Faceted imaging needs the uvw rotated to the tangent point of each facet.
+/// This class holds the rotated uvws and the associated delays for a list of tangent
+/// points (facets) and all rows of a chunk, so the rotation can be done in one pass over
+/// the rows and cached for the whole chunk instead of recomputing the single-tangent
+/// result for every facet.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_FACET_ROTATED_UVW_H
+#define ASKAP_ACCESSORS_FACET_ROTATED_UVW_H
+
+// std includes
+#include <vector>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+#include <casacore/measures/Measures/MDirection.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief uvw rotated to a number of tangent points at once
+/// @details The rotated uvws and delays are stored for each facet (tangent point) and row.
+/// The rows of each facet are contiguous, i.e. uvw(facet) is a vector which can be used in
+/// place of the result of IConstDataAccessor::rotatedUVW for the tangent point of this facet.
+/// Delays correspond to the rotation only (i.e. the image centre is assumed to be the
+/// tangent point of each facet).
+/// @ingroup dataaccess_hlp
+class FacetRotatedUVW {
+public:
+   /// @brief empty object (no facets)
+   FacetRotatedUVW();
+
+   /// @brief number of facets (tangent points)
+   inline casacore::uInt nFacets() const { return casacore::uInt(itsTangentPoints.size()); }
+
+   /// @brief number of rows
+   inline casacore::uInt nRow() const { return casacore::uInt(itsUVW.nrow()); }
+
+   /// @brief tangent points of all facets
+   inline const std::vector<casacore::MDirection>& tangentPoints() const { return itsTangentPoints; }
+
+   /// @brief rotated uvw for the given facet
+   /// @param[in] facet facet index
+   /// @return vector with rotated uvw for each row (references the internal buffer)
+   casacore::Vector<casacore::RigidVector<casacore::Double, 3> > uvw(casacore::uInt facet) const;
+
+   /// @brief delays associated with the rotation for the given facet
+   /// @param[in] facet facet index
+   /// @return vector with delays for each row (references the internal buffer)
+   casacore::Vector<casacore::Double> delays(casacore::uInt facet) const;
+
+   /// @brief rotated uvw of one row
+   /// @param[in] facet facet index
+   /// @param[in] row row index
+   /// @return rotated uvw
+   inline const casacore::RigidVector<casacore::Double, 3>& uvw(casacore::uInt facet, casacore::uInt row) const
+          { return itsUVW(row, facet); }
+
+   /// @brief delay of one row
+   /// @param[in] facet facet index
+   /// @param[in] row row index
+   /// @return delay
+   inline casacore::Double delay(casacore::uInt facet, casacore::uInt row) const
+          { return itsDelays(row, facet); }
+
+   /// @brief set up the buffers
+   /// @details The content of the buffers is undefined after this call, it is expected
+   /// to be filled via rwUVW and rwDelays.
+   /// @param[in] nRow number of rows
+   /// @param[in] tangentPoints tangent points of all facets
+   void resize(casacore::uInt nRow, const std::vector<casacore::MDirection> &tangentPoints);
+
+   /// @brief read-write access to the rotated uvw of the given facet
+   /// @param[in] facet facet index
+   /// @return vector referencing the internal buffer
+   casacore::Vector<casacore::RigidVector<casacore::Double, 3> > rwUVW(casacore::uInt facet);
+
+   /// @brief read-write access to the delays of the given facet
+   /// @param[in] facet facet index
+   /// @return vector referencing the internal buffer
+   casacore::Vector<casacore::Double> rwDelays(casacore::uInt facet);
+
+   /// @brief fill the buffers facet by facet
+   /// @details This is the generic implementation used for accessors which can't rotate
+   /// uvw for many tangent points at once. It calls rotatedUVW and uvwRotationDelay for
+   /// each tangent point.
+   /// @param[in] acc accessor
+   /// @param[in] tangentPoints tangent points of all facets
+   void fill(const IConstDataAccessor &acc, const std::vector<casacore::MDirection> &tangentPoints);
+
+private:
+   /// @brief tangent points of all facets
+   std::vector<casacore::MDirection> itsTangentPoints;
+
+   /// @brief rotated uvw (nRow x nFacets)
+   casacore::Matrix<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+
+   /// @brief delays (nRow x nFacets)
+   casacore::Matrix<casacore::Double> itsDelays;
+};
+
+/// @brief obtain uvw rotated to a number of tangent points
+/// @details The result is taken from the accessor if it implements IFacetUVWDataAccessor
+/// (and is cached there for the whole chunk). Otherwise, the buffer is filled by rotating
+/// uvws for one tangent point at a time.
+/// @param[in] acc accessor
+/// @param[in] tangentPoints tangent points of all facets
+/// @param[in] buffer buffer used if the accessor doesn't support batched rotation
+/// @return a reference to the rotated uvws (either the accessor's cache or the buffer)
+const FacetRotatedUVW& facetRotatedUVW(const IConstDataAccessor &acc,
+              const std::vector<casacore::MDirection> &tangentPoints, FacetRotatedUVW &buffer);
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_FACET_ROTATED_UVW_H
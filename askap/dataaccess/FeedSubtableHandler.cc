@@ -49,7 +49,6 @@
 
 // casa includes
 #include <casacore/tables/Tables/TableRecord.h>
-#include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/casa/Arrays/Array.h>
@@ -66,13 +65,11 @@ using namespace askap::accessors;
 /// @details
 /// @param[in] ms a table object, which has a feed subtable (main MS table)
 /// @note a flag showing the first access to the data similar to itsNeverAccessedFlag
-/// in FieldSubtableHandler is not required here because itsCachedSpWindow 
-/// initial value of -2 serves as such flag.
+/// in FieldSubtableHandler is not required here because an empty thread-specific 
+/// pointer to the current beam details serves as such flag.
 FeedSubtableHandler::FeedSubtableHandler(const casacore::Table &ms) :
           TableHolder(ms.keywordSet().asTable("FEED")),
-          itsCachedSpWindow(-2),
-          itsCachedStartTime(0.), itsCachedStopTime(0.),
-          itsAllCachedOffsetsZero(false), itsIntervalFactor(1.)
+          itsIntervalFactor(1.), itsCurrent(noCleanup)
 { 
   const casacore::Array<casacore::String> &intervalUnits=table().tableDesc().
           columnDesc("INTERVAL").keywordSet().asArrayString("QuantumUnits");
@@ -86,6 +83,29 @@ FeedSubtableHandler::FeedSubtableHandler(const casacore::Table &ms) :
             getTime(casacore::Unit(intervalUnits(casacore::IPosition(1,0)))).getValue();
   ASKAPDEBUGASSERT(itsIntervalFactor != 0);
   itsIntervalFactor = 1./itsIntervalFactor;
+
+  // the whole table is indexed once, so the rows valid at a given time 
+  // can be found without an expensive selection 
+  const casacore::uInt nRow = table().nrow();
+  if (nRow > 0) {
+      casacore::Vector<casacore::Double> times, intervals;
+      casacore::Vector<casacore::Int> spWindows;
+      casacore::ROScalarColumn<casacore::Double>(table(),"TIME").getColumn(times, casacore::True);
+      casacore::ROScalarColumn<casacore::Double>(table(),"INTERVAL").getColumn(intervals, casacore::True);
+      casacore::ROScalarColumn<casacore::Int>(table(),"SPECTRAL_WINDOW_ID").getColumn(spWindows, casacore::True);
+      itsRowSpWindows.resize(nRow);
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           itsRowSpWindows[row] = spWindows[row];
+           const casacore::Double halfInterval = intervals[row] * itsIntervalFactor / 2.;
+           // (temporary) work around for zero interval (happens for ATCA data), such
+           // rows are valid at all times
+           if (halfInterval == 0.) {
+               itsIntervalIndex.addPermanent(row);
+           } else {
+               itsIntervalIndex.add(times[row] - halfInterval, times[row] + halfInterval, row);
+           }
+      }
+  }
 }
  
 /// obtain the offsets of each beam with respect to dish pointing
@@ -103,10 +123,10 @@ const casacore::RigidVector<casacore::Double, 2>&
                       casacore::uInt spWinID,
                       casacore::uInt antID, casacore::uInt feedID) const
 {
-  fillCacheOnDemand(time,spWinID);
-  const casacore::uInt index=getIndex(antID,feedID);
-  ASKAPDEBUGASSERT(index<=itsBeamOffsets.nelements());
-  return itsBeamOffsets[index];
+  const BeamDetails &details = fillCacheOnDemand(time,spWinID);
+  const casacore::uInt index=getIndex(details,antID,feedID);
+  ASKAPDEBUGASSERT(index<=details.itsBeamOffsets.nelements());
+  return details.itsBeamOffsets[index];
 }    
 
 /// obtain the offsets for all beams with respect to dish pointing
@@ -120,8 +140,7 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 2> > &
         FeedSubtableHandler::getAllBeamOffsets(const casacore::MEpoch &time, 
                                   casacore::uInt spWinID) const
 {
- fillCacheOnDemand(time,spWinID);
- return itsBeamOffsets;
+ return fillCacheOnDemand(time,spWinID).itsBeamOffsets;
 }
 
 /// obtain position angles for all beams in the current cache (w.r.t. some
@@ -136,34 +155,35 @@ const casacore::Vector<casacore::Double>& FeedSubtableHandler::getAllBeamPAs(
                                  const casacore::MEpoch &time, 
                                  casacore::uInt spWinID) const
 {
-  fillCacheOnDemand(time,spWinID);
-  return itsPositionAngles;
+  return fillCacheOnDemand(time,spWinID).itsPositionAngles;
 }
 
 /// obtain an index of the given feed/antenna pair via the look-up table
 /// the method throws exceptions if antenna or feed is out of range or
 /// the appropriate record is not defined in the FEED subtable (i.e. absent
 /// in cache).
+/// @param[in] details beam details to work with
 /// @param[in] antID antenna of interest
 /// @param[in] feedID feed of interest 
-casacore::uInt FeedSubtableHandler::getIndex(casacore::uInt antID, casacore::uInt feedID) const
+casacore::uInt FeedSubtableHandler::getIndex(const BeamDetails &details, casacore::uInt antID,
+                                             casacore::uInt feedID)
 {
- if (antID>=itsIndices.nrow()) {
+ if (antID>=details.itsIndices.nrow()) {
       ASKAPTHROW(DataAccessError, "Antenna ID requested ("<<antID<<
           ") is outside the range of the FEED table (max. antenna number is "<<
-          itsIndices.nrow());
+          details.itsIndices.nrow());
   }
-  if (feedID>=itsIndices.ncolumn()) {
+  if (feedID>=details.itsIndices.ncolumn()) {
       ASKAPTHROW(DataAccessError, "Feed ID requested ("<<feedID<<
           ") is outside the range of the FEED table (max. antenna number is "<<
-          itsIndices.ncolumn());
+          details.itsIndices.ncolumn());
   }
-  const casacore::Int index=itsIndices(antID,feedID);
+  const casacore::Int index=details.itsIndices(antID,feedID);
   if (index<0) {
       ASKAPTHROW(DataAccessError, "Requested Antenna ID="<<antID<<
            " and Feed ID="<<feedID<<" are not found in the FEED subtable for "
-           "the time range from "<<itsCachedStartTime<<" till "<<itsCachedStopTime<<
-           " and spectral window "<<itsCachedSpWindow);             
+           "the time range from "<<details.itsStartTime<<" till "<<details.itsStopTime<<
+           " and spectral window "<<details.itsSpWindow);             
   } 
   return static_cast<casacore::uInt>(index);
 } 
@@ -182,63 +202,80 @@ casacore::uInt FeedSubtableHandler::getIndex(casacore::uInt antID, casacore::uIn
 bool FeedSubtableHandler::newBeamDetails(const casacore::MEpoch &time, 
                                     casacore::uInt spWinID) const
 {
-  const casacore::Double dTime=tableTime(time);
-  if (dTime>=itsCachedStartTime && dTime<=itsCachedStopTime &&
-      (casacore::Int(spWinID)==itsCachedSpWindow || itsCachedSpWindow==-1)) {
+  const BeamDetails *current = itsCurrent.get();
+  if (current && current->contains(tableTime(time), spWinID)) {
       // cache is valid
       return false;
   } 
   return true;
+}
+
+/// @brief check whether these details are valid for the given time and spectral window
+/// @param[in] dTime time in the native frame/units of the FEED table
+/// @param[in] spWinID spectral window ID of interest
+/// @return true if the details are valid
+bool FeedSubtableHandler::BeamDetails::contains(casacore::Double dTime, casacore::uInt spWinID) const
+{
+  return dTime>=itsStartTime && dTime<=itsStopTime &&
+         (casacore::Int(spWinID)==itsSpWindow || itsSpWindow==-1);
 }                                    
 
 
-/// read the data to fill the cache, a call to isCacheValid allows to check
-/// whether reading is necessary
+/// read the data for the given time and spectral window
+/// @details This method accesses the table and should be called with the unique lock held
 /// @param[in] time a full epoch of interest (feed table can be time-
 /// dependent
 /// @param[in] spWinID spectral window ID of interest (feed table can be
 /// spectral window-dependent  
-void FeedSubtableHandler::fillCache(const casacore::MEpoch &time, 
-                       casacore::uInt spWinID) const
+/// @return shared pointer to the new beam details
+boost::shared_ptr<FeedSubtableHandler::BeamDetails const> 
+FeedSubtableHandler::fillCache(const casacore::MEpoch &time, casacore::uInt spWinID) const
 {
   // if we really need to optimize the performance, we can cache dTime
   const casacore::Double dTime=tableTime(time);
-  const casacore::TableExprNode halfInterval = table().col("INTERVAL")*itsIntervalFactor/2.;
-
-  // (temporary) work around for zero interval (happens for ATCA data)
-  // probably an appropriate filler has to be fixed as it doesn't
-  // seem to conform with the measurement set standard
 
-  const casacore::TableExprNode expression = ((table().col("SPECTRAL_WINDOW_ID") ==
-                static_cast<casacore::Int>(spWinID)) || 
-                    (table().col("SPECTRAL_WINDOW_ID") == -1)) &&
-               (((table().col("TIME") - halfInterval <= dTime) &&
-                (table().col("TIME") + halfInterval >= dTime)) ||
-                (halfInterval == 0.));
-  casacore::Table selection=table()(expression);
+  // rows valid for the given time (zero intervals are treated as valid at all times),
+  // only those for the given spectral window (or any spectral window) are selected
+  std::vector<casacore::uInt> rows;
+  itsIntervalIndex.find(dTime, rows);
+  std::vector<casacore::uInt>::iterator endIt = rows.begin();
+  for (std::vector<casacore::uInt>::const_iterator ci = rows.begin(); ci != rows.end(); ++ci) {
+       ASKAPDEBUGASSERT(*ci < itsRowSpWindows.size());
+       const casacore::Int rowSpWindow = itsRowSpWindows[*ci];
+       if ((rowSpWindow == static_cast<casacore::Int>(spWinID)) || (rowSpWindow == -1)) {
+           *(endIt++) = *ci;
+       }
+  }
+  rows.erase(endIt, rows.end());
+  casacore::Vector<casacore::uInt> rowNumbers(rows.size());
+  for (size_t index = 0; index < rows.size(); ++index) {
+       rowNumbers[index] = rows[index];
+  }
+  casacore::Table selection=table()(rowNumbers);
   if (selection.nrow()==0) {
       ASKAPTHROW(DataAccessError,
                  "FEED subtable is empty or feed data missing for "
                   <<time<<" and spectral window: "<<spWinID);
   }
-  itsBeamOffsets.resize(selection.nrow());
-  itsPositionAngles.resize(selection.nrow());
+  boost::shared_ptr<BeamDetails> details(new BeamDetails);
+  details->itsBeamOffsets.resize(selection.nrow());
+  details->itsPositionAngles.resize(selection.nrow());
   casacore::ROScalarColumn<casacore::Int> antIDs(selection,"ANTENNA_ID");
-  antIDs.getColumn(itsAntennaIDs,casacore::True);
+  antIDs.getColumn(details->itsAntennaIDs,casacore::True);
   casacore::Int minAntID=-1,maxAntID=-1;
-  casacore::minMax(minAntID,maxAntID,itsAntennaIDs);
+  casacore::minMax(minAntID,maxAntID,details->itsAntennaIDs);
   casacore::ROScalarColumn<casacore::Int> feedIDs(selection,"FEED_ID");
-  feedIDs.getColumn(itsFeedIDs,casacore::True);
+  feedIDs.getColumn(details->itsFeedIDs,casacore::True);
   casacore::Int minFeedID=-1,maxFeedID=-1;
-  casacore::minMax(minFeedID,maxFeedID,itsFeedIDs);
+  casacore::minMax(minFeedID,maxFeedID,details->itsFeedIDs);
   if (minAntID<0 || maxAntID<0 || minFeedID<0 || maxFeedID<0) {
       ASKAPTHROW(DataAccessError,"Negative indices in FEED_ID and ANTENNA_ID "
          "columns of the FEED subtable are not allowed");
   }
   ++maxAntID; ++maxFeedID; // now we have numbers of feeds and antennae
   ASKAPDEBUGASSERT(maxAntID*maxFeedID == casacore::Int(selection.nrow()));
-  itsIndices.resize(maxAntID,maxFeedID);
-  itsIndices.set(-2); // negative value is a flag, which means an 
+  details->itsIndices.resize(maxAntID,maxFeedID);
+  details->itsIndices.set(-2); // negative value is a flag, which means an 
                       // uninitialized index
   casacore::ROArrayColumn<casacore::Double>  rcptrOffsets(selection,"BEAM_OFFSET");
   casacore::ROArrayColumn<casacore::Double>  rcptrPAs(selection,"RECEPTOR_ANGLE");
@@ -247,18 +284,18 @@ void FeedSubtableHandler::fillCache(const casacore::MEpoch &time,
   casacore::ROScalarColumn<casacore::Double> timeCol(selection,"TIME");
   casacore::ROScalarColumn<casacore::Double> intervalCol(selection,"INTERVAL");
   casacore::ROScalarColumn<casacore::Int> spWinCol(selection,"SPECTRAL_WINDOW_ID");
-  itsCachedSpWindow = spWinCol(0);
+  details->itsSpWindow = spWinCol(0);
   // we will set this flag to false later, if a non-zero offset is found
-  itsAllCachedOffsetsZero = true; 
+  details->itsAllOffsetsZero = true; 
   for (casacore::uInt row=0; row<selection.nrow(); ++row) {
-       casacore::RigidVector<casacore::Double, 2> &cOffset = itsBeamOffsets[row];
+       casacore::RigidVector<casacore::Double, 2> &cOffset = details->itsBeamOffsets[row];
        computeBeamOffset(rcptrOffsets(row),cOffset);
        if ((std::abs(cOffset(0)) > 1e-15) || (std::abs(cOffset(1)) > 1e-15)) {
-           itsAllCachedOffsetsZero = false;
+           details->itsAllOffsetsZero = false;
            //std::cerr<<"non zero offset "<<cOffset(0)<<" "<<cOffset(1)<<std::endl; 
        }
-       itsPositionAngles[row]=computePositionAngle(rcptrPAs(row));
-       itsIndices(antIDs(row),feedIDs(row))=row;
+       details->itsPositionAngles[row]=computePositionAngle(rcptrPAs(row));
+       details->itsIndices(antIDs(row),feedIDs(row))=row;
        
        casacore::Double cStartTime = timeCol(row) -
                           intervalCol(row) * itsIntervalFactor/2.;
@@ -273,19 +310,19 @@ void FeedSubtableHandler::fillCache(const casacore::MEpoch &time,
            cStartTime = timeCol(row) - 1e30;
 	       cStopTime = timeCol(row) + 1e30; 
        }
-       if (!row || itsCachedStartTime<cStartTime) {
-           itsCachedStartTime=cStartTime;	   
+       if (!row || details->itsStartTime<cStartTime) {
+           details->itsStartTime=cStartTime;	   
        }
-       if (!row || itsCachedStopTime>cStopTime) {
-           itsCachedStopTime=cStopTime;
+       if (!row || details->itsStopTime>cStopTime) {
+           details->itsStopTime=cStopTime;
        }
        if (spWinCol(row) != -1) {
-           ASKAPDEBUGASSERT((itsCachedSpWindow == -1) || 
-                             (spWinCol(row) == itsCachedSpWindow));
-           itsCachedSpWindow = spWinCol(row);
+           ASKAPDEBUGASSERT((details->itsSpWindow == -1) || 
+                             (spWinCol(row) == details->itsSpWindow));
+           details->itsSpWindow = spWinCol(row);
        }
   }
-            
+  return details;
 }
                        
 
@@ -348,24 +385,71 @@ casacore::Double FeedSubtableHandler::getBeamPA(const casacore::MEpoch &time,
                                  casacore::uInt spWinID, 
                                  casacore::uInt antID, casacore::uInt feedID) const
 {
-  fillCacheOnDemand(time,spWinID);
-  const casacore::uInt index=getIndex(antID,feedID);
-  ASKAPDEBUGASSERT(index<=itsPositionAngles.nelements());
-  return itsPositionAngles[index];
+  const BeamDetails &details = fillCacheOnDemand(time,spWinID);
+  const casacore::uInt index=getIndex(details,antID,feedID);
+  ASKAPDEBUGASSERT(index<=details.itsPositionAngles.nelements());
+  return details.itsPositionAngles[index];
 }                                 
   
-/// the same as fillCache, but perform it if newBeamDetails returns true
+/// @brief obtain beam details valid for the given time and spectral window
+/// @details The details are read from the table only if they are not found
+/// in the cache. The result becomes the current details for the calling thread.
 /// @param[in] time a full epoch of interest (feed table can be time-
 /// dependent
 /// @param[in] spWinID spectral window ID of interest (feed table can be
 /// spectral window-dependent  
-void FeedSubtableHandler::fillCacheOnDemand(const casacore::MEpoch &time, 
-                                            casacore::uInt spWinID) const
+/// @return a reference to the beam details
+const FeedSubtableHandler::BeamDetails& 
+FeedSubtableHandler::fillCacheOnDemand(const casacore::MEpoch &time, 
+                                       casacore::uInt spWinID) const
 {
-  ASKAPDEBUGASSERT(spWinID>=0);
-  if (newBeamDetails(time,spWinID)) {
-      fillCache(time,spWinID);
+  const casacore::Double dTime=tableTime(time);
+  const BeamDetails *current = itsCurrent.get();
+  if (current && current->contains(dTime, spWinID)) {
+      return *current;
+  }
+  // other threads could have read the required details already
+  boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
+  current = findInCache(dTime, spWinID);
+  if (current == NULL) {
+      boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
+      const boost::shared_ptr<BeamDetails const> details = fillCache(time, spWinID);
+      ASKAPDEBUGASSERT(details);
+      itsCache.push_back(details);
+      itsCacheIndex.insert(std::make_pair(details->itsStopTime, details.get()));
+      current = details.get();
+  }
+  itsCurrent.reset(current);
+  return *current;
+}
+
+/// @brief search the cache for beam details 
+/// @details This method should be called with at least the shared lock held
+/// @param[in] dTime time in the native frame/units of the FEED table
+/// @param[in] spWinID spectral window ID of interest
+/// @return pointer to the details found or NULL, if there are none in the cache
+const FeedSubtableHandler::BeamDetails* 
+FeedSubtableHandler::findInCache(casacore::Double dTime, casacore::uInt spWinID) const
+{
+  // the most recently read details are the most likely to match
+  if (itsCache.size() && itsCache.back()->contains(dTime, spWinID)) {
+      return itsCache.back().get();
   }
+  // details which stop before the given time are skipped
+  for (std::multimap<casacore::Double, BeamDetails const*>::const_iterator ci = 
+       itsCacheIndex.lower_bound(dTime); ci != itsCacheIndex.end(); ++ci) {
+       ASKAPDEBUGASSERT(ci->second);
+       if (ci->second->contains(dTime, spWinID)) {
+           return ci->second;
+       }
+  }
+  return NULL;
+}
+
+/// @brief cleanup function for the thread-specific pointer
+/// @details Beam details are owned by the cache, nothing is done here
+void FeedSubtableHandler::noCleanup(BeamDetails const *)
+{
 }                                            
 
 /// @brief check whether all beam offsets are zero
@@ -382,8 +466,7 @@ void FeedSubtableHandler::fillCacheOnDemand(const casacore::MEpoch &time,
 /// @return true if all beam offsets are zero for the given time/epoch.
 bool FeedSubtableHandler::allBeamOffsetsZero(const casacore::MEpoch &time, casacore::uInt spWinID) const
 {
-  fillCacheOnDemand(time,spWinID);
-  return itsAllCachedOffsetsZero;
+  return fillCacheOnDemand(time,spWinID).itsAllOffsetsZero;
 }
 
 /// obtain feed IDs for the given time and spectral window
@@ -396,8 +479,7 @@ bool FeedSubtableHandler::allBeamOffsetsZero(const casacore::MEpoch &time, casac
 const casacore::Vector<casacore::Int>& FeedSubtableHandler::getFeedIDs(const casacore::MEpoch &time, 
                       casacore::uInt spWinID) const
 {
-  fillCacheOnDemand(time,spWinID);
-  return itsFeedIDs;
+  return fillCacheOnDemand(time,spWinID).itsFeedIDs;
 }                      
   
 /// obtain antenna IDs for the given time and spectral window
@@ -410,8 +492,7 @@ const casacore::Vector<casacore::Int>& FeedSubtableHandler::getFeedIDs(const cas
 const casacore::Vector<casacore::Int>& FeedSubtableHandler::getAntennaIDs(const casacore::MEpoch &time, 
                       casacore::uInt spWinID) const
 {
-  fillCacheOnDemand(time,spWinID);
-  return itsAntennaIDs;  
+  return fillCacheOnDemand(time,spWinID).itsAntennaIDs;
 }  
 
 /// @brief obtain a matrix of indices into beam offset and beam PA arrays
@@ -427,8 +508,10 @@ const casacore::Vector<casacore::Int>& FeedSubtableHandler::getAntennaIDs(const
 /// the cache is already up to date and passing parameters and doing additional
 /// checks will be a waste of resources. It is probably better to live with the
 /// current interface although this approach is less elegant.
+/// The result corresponds to the last access from the calling thread.
 /// @return a reference to matrix with indicies
 const casacore::Matrix<casacore::Int>& FeedSubtableHandler::getIndices() const throw()
 {
-  return itsIndices;
+  const BeamDetails *current = itsCurrent.get();
+  return current ? current->itsIndices : itsEmptyIndices;
 }
@@ -42,6 +42,15 @@
 #ifndef ASKAP_ACCESSORS_FEED_SUBTABLE_HANDLER_H
 #define ASKAP_ACCESSORS_FEED_SUBTABLE_HANDLER_H
 
+// std includes
+#include <vector>
+#include <map>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/tss.hpp>
+
 // casa includes
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Arrays/Vector.h>
@@ -54,6 +63,7 @@
 #include <askap/dataaccess/IFeedSubtableHandler.h>
 #include <askap/dataaccess/TableHolder.h>
 #include <askap/dataaccess/TimeDependentSubtable.h>
+#include <askap/dataaccess/TimeIntervalIndex.h>
 
 namespace askap {
 
@@ -68,7 +78,11 @@ namespace accessors {
 /// from some other subtables which are implemented by Mem... classes reading
 /// all the required data in the constructor. If the table is trivial 
 /// (no time- and spectral window dependence), it will be fully cached on the
-/// first request.
+/// first request. This class is thread-safe: beam details read for a particular
+/// time range and spectral window are never changed afterwards, so they can be
+/// shared by any number of iterators working in different threads. The "current"
+/// time range (which determines, e.g., the result of newBeamDetails) is tracked
+/// separately for each thread.
 /// @note The measurement set format specifies offsets for each receptor,
 /// rather than feed (i.e. for each polarization separately). We handle possible
 /// squints together with other image plane effects and therefore need just
@@ -199,29 +213,89 @@ struct FeedSubtableHandler : virtual public IFeedSubtableHandler,
   virtual bool allBeamOffsetsZero(const casacore::MEpoch &time, casacore::uInt spWinID) const;
   
 protected:
-  /// read the data to fill the cache, a call to isCacheValid allows to check
-  /// whether reading is necessary
+  /// @brief beam details for one time range and spectral window
+  /// @details Objects of this type are filled once and never change afterwards,
+  /// therefore references to their content can be given out to any thread.
+  struct BeamDetails {
+     /// @brief check whether these details are valid for the given time and spectral window
+     /// @param[in] dTime time in the native frame/units of the FEED table
+     /// @param[in] spWinID spectral window ID of interest
+     /// @return true if the details are valid
+     bool contains(casacore::Double dTime, casacore::uInt spWinID) const;
+
+     /// the spectral window for which the details are valid. -1 means for any
+     /// spectral window (if the table is spectral window-independent). 
+     casacore::Int itsSpWindow;
+     
+     /// start time of the time range for which the details are valid. 
+     /// Time-independed table has a very wide time range. The time is stored 
+     /// as Double in the native frame/units of the FEED table. 
+     casacore::Double itsStartTime;
+  
+     /// stop time of the time range for which the details are valid. 
+     casacore::Double itsStopTime;
+  
+     /// beam offsets
+     casacore::Vector<casacore::RigidVector<casacore::Double, 2> > itsBeamOffsets;
+  
+     /// position angles
+     casacore::Vector<casacore::Double> itsPositionAngles;
+  
+     /// @brief true if all beam offsets are zero
+     /// @details This flag is used to speed-up data reduction in the case of
+     /// single-feed interferometers, which are usually on-axis.
+     bool itsAllOffsetsZero;
+  
+     /// a look-up table to convert (ant,feed) into an index for all 
+     /// 1D-vectors. We need this look-up table as, in principle, the fields
+     /// can be out of order in the FEED subtable, missing or repeated. A simple
+     /// sort, as it was done for the VisBuffer in AIPS++ is not sufficient
+     /// in the general case.
+     casacore::Matrix<casacore::Int> itsIndices;
+  
+     /// antenna IDs
+     casacore::Vector<casacore::Int> itsAntennaIDs;
+  
+     /// feed IDs
+     casacore::Vector<casacore::Int> itsFeedIDs;
+  };
+
+  /// read the data for the given time and spectral window
+  /// @details This method accesses the table and should be called with the unique lock held
   /// @param[in] time a full epoch of interest (feed table can be time-
   /// dependent
   /// @param[in] spWinID spectral window ID of interest (feed table can be
   /// spectral window-dependent  
-  void fillCache(const casacore::MEpoch &time, casacore::uInt spWinID) const;
+  /// @return shared pointer to the new beam details
+  boost::shared_ptr<BeamDetails const> fillCache(const casacore::MEpoch &time, 
+                                                 casacore::uInt spWinID) const;
   
-  /// the same as fillCache, but perform it if newBeamDetails returns true
+  /// @brief obtain beam details valid for the given time and spectral window
+  /// @details The details are read from the table only if they are not found
+  /// in the cache. The result becomes the current details for the calling thread.
   /// @param[in] time a full epoch of interest (feed table can be time-
   /// dependent
   /// @param[in] spWinID spectral window ID of interest (feed table can be
   /// spectral window-dependent  
-  void fillCacheOnDemand(const casacore::MEpoch &time, casacore::uInt spWinID) const;
-    
+  /// @return a reference to the beam details
+  const BeamDetails& fillCacheOnDemand(const casacore::MEpoch &time, casacore::uInt spWinID) const;
+
+  /// @brief search the cache for beam details 
+  /// @details This method should be called with at least the shared lock held
+  /// @param[in] dTime time in the native frame/units of the FEED table
+  /// @param[in] spWinID spectral window ID of interest
+  /// @return pointer to the details found or NULL, if there are none in the cache
+  const BeamDetails* findInCache(casacore::Double dTime, casacore::uInt spWinID) const;
   
   /// obtain an index of the given feed/antenna pair via the look-up table
   /// the method throws exceptions if antenna or feed is out of range or
   /// the appropriate record is not defined in the FEED subtable (i.e. absent
   /// in cache).
+  /// @param[in] details beam details to work with
   /// @param[in] antID antenna of interest
   /// @param[in] feedID feed of interest 
-  casacore::uInt getIndex(casacore::uInt antID, casacore::uInt feedID) const; 
+  static casacore::uInt getIndex(const BeamDetails &details, casacore::uInt antID,
+                                 casacore::uInt feedID); 
   
   /// compute beam offset (squint is taken into acccount by
   /// the voltage pattern model). At this stage we just average over all
@@ -241,47 +315,39 @@ protected:
   static casacore::Double computePositionAngle(const casacore::Array<casacore::Double>
                                &rcptAngles);             
 private:
+  /// @brief cleanup function for the thread-specific pointer
+  /// @details Beam details are owned by the cache, nothing is done here
+  static void noCleanup(BeamDetails const *);
  
-  /// the spectral window for which the cache is valid. -1 means for any
-  /// spectral window (if the table is spectral window-independent). 
-  mutable casacore::Int itsCachedSpWindow;
-  
-  /// start time of the time ranges for which the cache is valid. 
-  /// Time-independed table has a very wide time range. The time is stored 
-  /// as Double in the native frame/units of the FEED table. 
-  mutable casacore::Double itsCachedStartTime;
-  
-  /// stop time of the time range for which the cache is valid. 
-  /// See itsCachedStartTimes for more details.
-  mutable casacore::Double itsCachedStopTime;
-  
-  /// a cache of beam offsets
-  mutable casacore::Vector<casacore::RigidVector<casacore::Double, 2> > itsBeamOffsets;
-  
-  /// a cache of position angles
-  mutable casacore::Vector<casacore::Double> itsPositionAngles;
-  
-  /// @brief true if all beam offsets in the cache are zero
-  /// @details This flag is used to speed-up data reduction in the case of
-  /// single-feed interferometers, which are usually on-axis.
-  mutable bool itsAllCachedOffsetsZero;
-  
-  /// a look-up table to convert (ant,feed) into an index for all caches
-  /// (1D-vectors). We need this look-up table as, in principle, the fields
-  /// can be out of order in the FEED subtable, missing or repeated. A simple
-  /// sort, as it was done for the VisBuffer in AIPS++ is not sufficient
-  /// in the general case.
-  mutable casacore::Matrix<casacore::Int> itsIndices;
-  
   /// a factor to multiply the INTERVAL to get the same units as
   /// TIME column
   casacore::Double itsIntervalFactor;
-  
-  /// a cache of antenna IDs
-  mutable casacore::Vector<casacore::Int> itsAntennaIDs;
-  
-  /// a cache of feed IDs
-  mutable casacore::Vector<casacore::Int> itsFeedIDs;
+
+  /// @brief all beam details read so far
+  mutable std::vector<boost::shared_ptr<BeamDetails const> > itsCache;
+
+  /// @brief beam details read so far indexed by the stop time
+  /// @details Details containing a given time can only be found at or after the
+  /// lower bound of this time, so the search doesn't need to go through the whole cache
+  mutable std::multimap<casacore::Double, BeamDetails const*> itsCacheIndex;
+
+  /// @brief validity intervals of all rows of the table
+  /// @details The index is built in the constructor, it is used to select rows
+  /// valid for the given time instead of a table selection. 
+  /// The index is only accessed with the unique lock held.
+  TimeIntervalIndex itsIntervalIndex;
+
+  /// @brief spectral window ID of each row of the table
+  std::vector<casacore::Int> itsRowSpWindows;
+
+  /// @brief mutex protecting the cache (and access to the table)
+  mutable boost::shared_mutex itsMutex;
+
+  /// @brief beam details used last by the calling thread (not owned)
+  mutable boost::thread_specific_ptr<BeamDetails const> itsCurrent;
+
+  /// @brief empty index matrix returned, if this thread hasn't accessed data yet
+  casacore::Matrix<casacore::Int> itsEmptyIndices;
 };
 
 
@@ -3,11 +3,9 @@
 /// @details This class is provides access to
 /// the content of the FIELD subtable (which provides delay, phase and
 /// reference centres for each time). The POINTING table gives the actual 
-/// pointing of the antennae. Although this implementation caches the values
-/// for the last requested time range, it reads the data on-demand. This is 
-/// a difference from subtable handler classes, whose name starts from Mem...
-/// The latter classes read the whole subtable into memory in the constructor and
-/// later just return cached values. 
+/// pointing of the antennae. The whole subtable is read into memory in the
+/// constructor, so the object doesn't change afterwards and can be shared
+/// between threads. 
 ///
 /// @copyright (c) 2007 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -41,33 +39,53 @@
 #include <askap/askap/AskapError.h>
 #include <askap/dataaccess/DataAccessError.h>
 
+// std includes
+#include <algorithm>
+
 // casa includes
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableIter.h>
 #include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/BasicSL/String.h>
 
+// LOFAR includes
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
 // uncomment logger when it is actually used
 //#include <askap/askap/AskapLogging.h>
 //ASKAP_LOGGER(logger, "");
 
-
 using namespace askap;
 using namespace askap::accessors;
 
 /// @brief construct the object
-/// @details 
+/// @details The whole subtable is read here, so the object doesn't change 
+/// afterwards.
 /// @param[in] ms a table object, which has a field subtable defined
 /// (i.e. this method accepts a main ms table).
 FieldSubtableHandler::FieldSubtableHandler(const casacore::Table &ms) :
-       TableHolder(ms.keywordSet().asTable("FIELD")),
-       itsIterator(table(),"TIME",casacore::TableIterator::Ascending,
-                   casacore::TableIterator::NoSort), itsNeverAccessedFlag(true)
+       TableHolder(ms.keywordSet().asTable("FIELD"))
 {
   if (!table().nrow()) {
       ASKAPTHROW(DataAccessError, "The FIELD subtable is empty");
   }  
+  casacore::ROScalarMeasColumn<casacore::MDirection> refDirCol(table(),"REFERENCE_DIR");
+  itsRowReferenceDirs.reserve(table().nrow());
+  for (casacore::uInt row = 0; row < table().nrow(); ++row) {
+       itsRowReferenceDirs.push_back(refDirCol(row));
+  }
+  for (casacore::TableIterator it(table(),"TIME"); !it.pastEnd(); it.next()) {
+       const casacore::Table curIt = it.table();
+       ASKAPDEBUGASSERT(curIt.nrow() > 0);
+       casacore::ROScalarColumn<casacore::Double> timeCol(curIt,"TIME");
+       casacore::ROScalarMeasColumn<casacore::MDirection> curDirCol(curIt,"REFERENCE_DIR");
+       itsStartTimes.push_back(timeCol(0));
+       itsReferenceDirs.push_back(curDirCol(0));
+       itsNumberOfRows.push_back(curIt.nrow());
+  }
 }         
   
 /// @brief obtain the reference direction for a given time.
@@ -80,15 +98,98 @@ FieldSubtableHandler::FieldSubtableHandler(const casacore::Table &ms) :
 /// @param[in] time a full epoch of interest (the subtable can have multiple
 /// pointings.
 /// @return a reference to direction measure
+namespace {
+
+/// @brief read a direction measure from a snapshot
+/// @param[in] is input blob stream
+/// @return the direction with its reference frame
+casacore::MDirection getDirection(LOFAR::BlobIStream &is)
+{
+  casacore::Int refType = 0;
+  double x = 0., y = 0., z = 0.;
+  is >> refType >> x >> y >> z;
+  return casacore::MDirection(casacore::MVDirection(x, y, z),
+             casacore::MDirection::Ref(casacore::MDirection::Types(refType)));
+}
+
+/// @brief write a direction measure into a snapshot
+/// @details The direction cosines and the reference type are written, frame
+/// information (if any) is not preserved (FIELD directions don't have it)
+/// @param[in] os output blob stream
+/// @param[in] dir direction to write
+void putDirection(LOFAR::BlobOStream &os, const casacore::MDirection &dir)
+{
+  const casacore::Vector<casacore::Double> cosines = dir.getValue().getValue();
+  ASKAPDEBUGASSERT(cosines.nelements() == 3);
+  os << static_cast<casacore::Int>(dir.getRef().getType()) << cosines[0] << cosines[1] << cosines[2];
+}
+
+} // anonymous namespace
+
+/// @brief restore the cached data from a snapshot
+/// @details This constructor reads the data written by serialise. The FIELD subtable is
+/// opened (it is needed for the time conversion) but not read (see SubtableInfoHolder::loadSnapshot)
+/// @param[in] ms a table object, which has a field subtable defined
+/// @param[in] is input blob stream
+FieldSubtableHandler::FieldSubtableHandler(const casacore::Table &ms, LOFAR::BlobIStream &is) :
+       TableHolder(ms.keywordSet().asTable("FIELD"))
+{
+  const int version = is.getStart("FieldSubtableHandler");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the serialised FieldSubtableHandler");
+  LOFAR::uint64 size = 0;
+  is >> size;
+  ASKAPCHECK(size > 0, "The serialised FIELD subtable is empty");
+  itsRowReferenceDirs.reserve(size);
+  for (LOFAR::uint64 row = 0; row < size; ++row) {
+       itsRowReferenceDirs.push_back(getDirection(is));
+  }
+  is >> size;
+  itsStartTimes.resize(size);
+  itsNumberOfRows.resize(size);
+  itsReferenceDirs.reserve(size);
+  for (LOFAR::uint64 index = 0; index < size; ++index) {
+       is >> itsStartTimes[index] >> itsNumberOfRows[index];
+       itsReferenceDirs.push_back(getDirection(is));
+  }
+  is.getEnd();
+}
+
+/// @brief write the cached data into a snapshot
+/// @param[in] os output blob stream
+void FieldSubtableHandler::serialise(LOFAR::BlobOStream &os) const
+{
+  os.putStart("FieldSubtableHandler", 1);
+  os << static_cast<LOFAR::uint64>(itsRowReferenceDirs.size());
+  for (std::vector<casacore::MDirection>::const_iterator ci = itsRowReferenceDirs.begin();
+       ci != itsRowReferenceDirs.end(); ++ci) {
+       putDirection(os, *ci);
+  }
+  ASKAPDEBUGASSERT(itsStartTimes.size() == itsNumberOfRows.size());
+  ASKAPDEBUGASSERT(itsStartTimes.size() == itsReferenceDirs.size());
+  os << static_cast<LOFAR::uint64>(itsStartTimes.size());
+  for (size_t index = 0; index < itsStartTimes.size(); ++index) {
+       os << itsStartTimes[index] << itsNumberOfRows[index];
+       putDirection(os, itsReferenceDirs[index]);
+  }
+  os.putEnd();
+}
+
 const casacore::MDirection& FieldSubtableHandler::getReferenceDir(const 
                  casacore::MEpoch &time) const
 {
-  if (itsNeverAccessedFlag) {
-      fillCacheWithCurrentIteration();
+  const casacore::uInt index = findTimeIndex(time);
+  ASKAPDEBUGASSERT(index < itsNumberOfRows.size());
+  if (itsNumberOfRows[index] > 1) {
+      ASKAPTHROW(DataAccessError, "Multiple rows for the same TIME in the FIELD table "
+          "(e.g. polynomial interpolation) are not yet supported");
+  }
+  casacore::uInt *current = itsCurrentIndex.get();
+  if (current == NULL) {
+      itsCurrentIndex.reset(new casacore::uInt(index));
+  } else {
+      *current = index;
   }
-  fillCacheOnDemand(time);
-  itsNeverAccessedFlag=false;
-  return itsReferenceDir;
+  return itsReferenceDirs[index];
 }
 
 /// @brief obtain the reference direction stored in a given row
@@ -107,32 +208,41 @@ const casacore::MDirection& FieldSubtableHandler::getReferenceDir(const
 const casacore::MDirection&
 FieldSubtableHandler::getReferenceDir(casacore::uInt fieldID) const
 {
-  if (fieldID >= table().nrow()) {
+  if (fieldID >= itsRowReferenceDirs.size()) {
       ASKAPTHROW(DataAccessError, "The FIELD subtable does not have row="<<fieldID);
   }
-  casacore::ROScalarMeasColumn<casacore::MDirection> refDirCol(table(),"REFERENCE_DIR");
-  itsRandomlyAccessedReferenceDir = refDirCol(fieldID);
-  return itsRandomlyAccessedReferenceDir;
+  return itsRowReferenceDirs[fieldID];
 }
 
-/// read the current iteration and populate cache. It also advances the
-/// iterator
-void FieldSubtableHandler::fillCacheWithCurrentIteration() const
+/// @brief find the time range containing the given time
+/// @details An exception is thrown if the time is earlier than any time in the table.
+/// The last time range is assumed to be valid until the end of the observation.
+/// The search is amortised constant time if times are requested in the ascending order.
+/// @param[in] time a full epoch of interest
+/// @return index of the time range (into itsStartTimes)
+casacore::uInt FieldSubtableHandler::findTimeIndex(const casacore::MEpoch &time) const
 {
-  casacore::Table curIt=itsIterator.table(); 
-  if (curIt.nrow()>1) {
-      ASKAPTHROW(DataAccessError, "Multiple rows for the same TIME in the FIELD table "
-          "(e.g. polynomial interpolation) are not yet supported");
+  ASKAPDEBUGASSERT(itsStartTimes.size() > 0);
+  const casacore::Double dTime=tableTime(time);
+  if (dTime<itsStartTimes[0]) {
+      ASKAPTHROW(DataAccessError, "An earlier time is requested ("<<time<<") than "
+             "the FIELD table has data for");
+  }
+  // times are normally requested in the ascending order, try the range accessed
+  // last by this thread and the following one before the binary search
+  const casacore::uInt *current = itsCurrentIndex.get();
+  ASKAPDEBUGASSERT((current == NULL) || (*current < itsStartTimes.size()));
+  if ((current != NULL) && (dTime >= itsStartTimes[*current])) {
+      for (casacore::uInt index = *current; (index < *current + 2) && (index < itsStartTimes.size()); ++index) {
+           if ((index + 1 == itsStartTimes.size()) || (dTime < itsStartTimes[index + 1])) {
+               return index;
+           }
+      }
   }
-  casacore::ROScalarColumn<casacore::Double> timeCol(curIt,"TIME");
-  itsCachedStartTime=timeCol(0);
-  casacore::ROScalarMeasColumn<casacore::MDirection> refDirCol(curIt,"REFERENCE_DIR");
-  itsReferenceDir=refDirCol(0);
-  ASKAPDEBUGASSERT(!itsIterator.pastEnd());
-  itsIterator.next();
-  if (!itsIterator.pastEnd()) {
-      itsCachedStopTime=timeCol(0);
-  }    
+  const std::vector<casacore::Double>::const_iterator ci = 
+        std::upper_bound(itsStartTimes.begin(), itsStartTimes.end(), dTime);
+  ASKAPDEBUGASSERT(ci != itsStartTimes.begin());
+  return static_cast<casacore::uInt>(ci - itsStartTimes.begin()) - 1;
 }
 
 /// @brief check whether the field changed for a given time
@@ -142,47 +252,24 @@ void FieldSubtableHandler::fillCacheWithCurrentIteration() const
 /// still valid or not for a new time. Use this method instead of testing
 /// whether directions are close enough as it can make use the information
 /// stored in the subtable. The method always returns true before the 
-/// first access to the data.
+/// first access to the data from the calling thread.
 /// @param[in] time a full epoch of interest (the subtable can have multiple
 /// pointings.
 /// @return true if the field information have been changed
 bool FieldSubtableHandler::newField(const casacore::MEpoch &time) const
 {
-  if (itsNeverAccessedFlag) {
+  const casacore::uInt *current = itsCurrentIndex.get();
+  if (current == NULL) {
       return true;
   }
+  ASKAPDEBUGASSERT(*current < itsStartTimes.size());
   // we may need caching of dTime if it becomes performance critical
   const casacore::Double dTime=tableTime(time);
-  if (dTime<itsCachedStartTime) {
+  if (dTime<itsStartTimes[*current]) {
       return true;
   }
-  if (table().nrow() == 1) {
-      return false;
-  }
-  return (dTime>itsCachedStopTime);
-}
-
-/// read the data if cache is outdated
-/// @param[in] time a full epoch of interest (field table can have many
-/// pointings and therefore can be time-dependent)
-void FieldSubtableHandler::fillCacheOnDemand(const casacore::MEpoch &time) const
-{
-  const casacore::Double dTime=tableTime(time);
-  if (dTime<itsCachedStartTime) {
-      itsIterator.reset();
-      fillCacheWithCurrentIteration();
-  } 
-  if (dTime<itsCachedStartTime) {
-      ASKAPTHROW(DataAccessError, "An earlier time is requested ("<<time<<") than "
-             "the FIELD table has data for");
-  }
-  if ((table().nrow() == 1) || 
-      (dTime>=itsCachedStartTime && dTime<=itsCachedStopTime)) {      
-      return;
-  }
-  while (!itsIterator.pastEnd() && ((dTime<itsCachedStartTime) || 
-         (dTime>itsCachedStopTime))) {
-     fillCacheWithCurrentIteration(); 
+  if (*current + 1 < itsStartTimes.size()) {
+      return dTime >= itsStartTimes[*current + 1];
   }
-  ASKAPDEBUGASSERT(dTime>=itsCachedStartTime);
+  return false;
 }
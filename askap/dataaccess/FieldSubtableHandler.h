@@ -3,11 +3,9 @@
 /// @details This class is provides access to
 /// the content of the FIELD subtable (which provides delay, phase and
 /// reference centres for each time). The POINTING table gives the actual 
-/// pointing of the antennae. Although this implementation caches the values
-/// for the last requested time range, it reads the data on-demand. This is 
-/// a difference from subtable handler classes, whose name starts from Mem...
-/// The latter classes read the whole subtable into memory in the constructor and
-/// later just return cached values. 
+/// pointing of the antennae. The whole subtable is read into memory in the
+/// constructor, so the object doesn't change afterwards and can be shared
+/// between threads. 
 ///
 /// @copyright (c) 2007 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -37,9 +35,14 @@
 #ifndef ASKAP_ACCESSORS_FIELD_SUBTABLE_HANDLER_H
 #define ASKAP_ACCESSORS_FIELD_SUBTABLE_HANDLER_H
 
+// std includes
+#include <vector>
+
+// boost includes
+#include <boost/thread/tss.hpp>
+
 // casa includes
 #include <casacore/tables/Tables/Table.h>
-#include <casacore/tables/Tables/TableIter.h>
 #include <casacore/casa/Quanta/Quantum.h>
 
 // own includes
@@ -47,6 +50,11 @@
 #include <askap/dataaccess/TimeDependentSubtable.h>
 #include <askap/dataaccess/TableHolder.h>
 
+namespace LOFAR {
+class BlobIStream;
+class BlobOStream;
+} // namespace LOFAR
+
 namespace askap {
 
 namespace accessors {
@@ -56,11 +64,11 @@ namespace accessors {
 /// @details This class derived provides access to
 /// the content of the FIELD subtable (which provides delay, phase and
 /// reference centres for each time). The POINTING table gives the actual 
-/// pointing of the antennae. Although this implementation caches the values
-/// for the last requested time range, it reads the data on-demand. This is 
-/// a difference from subtable handler classes, whose name starts from Mem...
-/// The latter classes read all the subtable into memory in the constructor and
-/// later return cached values. 
+/// pointing of the antennae. Similar to subtable handler classes, whose name 
+/// starts from Mem..., this class reads the whole subtable into memory in the 
+/// constructor and later returns cached values. The object is not changed after
+/// construction and can be shared between threads. The last accessed time range,
+/// which determines the result of newField, is tracked separately for each thread.
 /// @note The class has not been properly tested with time-dependent FIELD table
 /// @ingroup dataaccess_tab
 struct FieldSubtableHandler : virtual public IFieldSubtableHandler,
@@ -72,6 +80,17 @@ struct FieldSubtableHandler : virtual public IFieldSubtableHandler,
   /// @param[in] ms a table object, which has a field subtable defined
   /// (i.e. this method accepts a main ms table).
   explicit FieldSubtableHandler(const casacore::Table &ms); 
+
+  /// @brief restore the cached data from a snapshot
+  /// @details This constructor reads the data written by serialise. The FIELD subtable is
+  /// opened (it is needed for the time conversion) but not read (see SubtableInfoHolder::loadSnapshot)
+  /// @param[in] ms a table object, which has a field subtable defined
+  /// @param[in] is input blob stream
+  FieldSubtableHandler(const casacore::Table &ms, LOFAR::BlobIStream &is);
+
+  /// @brief write the cached data into a snapshot
+  /// @param[in] os output blob stream
+  void serialise(LOFAR::BlobOStream &os) const;
   
   /// @brief obtain the reference direction for a given time.
   /// @details It is not clear at the moment whether this subtable is
@@ -116,43 +135,40 @@ struct FieldSubtableHandler : virtual public IFieldSubtableHandler,
                                                   const;
 
 protected:
-  /// read the data if cache is outdated
-  /// @param[in] time a full epoch of interest (field table can have many
-  /// pointing and therefore can be time-dependent)
-  void fillCacheOnDemand(const casacore::MEpoch &time) const;
-  
-  /// read the current iteration and populate cache
-  void fillCacheWithCurrentIteration() const;
-  
+  /// @brief find the time range containing the given time
+  /// @details An exception is thrown if the time is earlier than any time in the table.
+  /// The last time range is assumed to be valid until the end of the observation.
+  /// The search is amortised constant time if times are requested in the ascending order.
+  /// @param[in] time a full epoch of interest
+  /// @return index of the time range (into itsStartTimes)
+  casacore::uInt findTimeIndex(const casacore::MEpoch &time) const;
+
 private:
-  
-  /// iterator over the FIELD subtable
-  mutable casacore::TableIterator itsIterator;
-   
-  /// start time of the time range, for which the cache is valid
-  /// Time independent table has a very wide time range. Values are
-  /// stored as Doubles in the native frame/units of the FIELD table
-  mutable casacore::Double itsCachedStartTime;
-  
-  /// stop time of the time range, for which the cache is valid
-  /// see itsCachedStartTime for more details.
-  mutable casacore::Double itsCachedStopTime;
-  
-  /// cache of the reference direction (time-based selection of rows)
-  mutable casacore::MDirection itsReferenceDir;
+  /// @brief start times of each group of rows with the same TIME (ascending)
+  /// @details Values are stored as Doubles in the native frame/units of the FIELD table
+  std::vector<casacore::Double> itsStartTimes;
 
-  /// cache of the reference direction (direct row-based access)
-  mutable casacore::MDirection itsRandomlyAccessedReferenceDir;
-  
-  /// @brief flag showing that no data has been obtained yet via this class
+  /// @brief reference direction for each group of rows with the same TIME
+  std::vector<casacore::MDirection> itsReferenceDirs;
+
+  /// @brief number of rows in each group of rows with the same TIME
+  /// @details Multiple rows (e.g. polynomial interpolation) are not yet supported 
+  /// by the time-based access.
+  std::vector<casacore::uInt> itsNumberOfRows;
+
+  /// @brief reference direction for each row (direct row-based access)
+  std::vector<casacore::MDirection> itsRowReferenceDirs;
+
+  /// @brief index of the time range accessed last by the calling thread
   /// @details It is necessary that newField always returns true before 
   /// the first getReferenceDir call. Otherwise, caching of the derived
-  /// information can be complicated. With this flag the meaning of newField
+  /// information can be complicated. The pointer is empty until the first 
+  /// access from the given thread. With this approach the meaning of newField
   /// method is to test whether the field is new since the last access to
   /// its parameters.
-  /// @note This flag is used only for time-based selection. It is not
+  /// @note This index is used only for time-based selection. It is not
   /// updated, nor checked for a row-based access
-  mutable bool itsNeverAccessedFlag;
+  mutable boost::thread_specific_ptr<casacore::uInt> itsCurrentIndex;
 };
 
 
@@ -0,0 +1,196 @@
+/// @file
+/// @brief A class to manage buffers stored in flat binary files
+/// @details Read-write iterator (see IDataIterator) uses the concept
+/// of buffers to store scratch data. This class keeps each buffer in a
+/// separate flat binary file with the cubes written one after another
+/// as raw contiguous blocks, so writing and reading back a buffer
+/// chunk by chunk results in sequential large-block I/O. The buffers
+/// are scratch data: the index of the file is only held in memory and 
+/// the files are removed when the manager is destroyed.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+
+// own includes
+#include <askap/dataaccess/FileBufferManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+// std includes
+#include <cstdio>
+
+ASKAP_LOGGER(logger, ".FileBufferManager");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief default constructor, the cell is undefined
+FileBufferManager::CellInfo::CellInfo() : itsOffset(0), itsCapacity(0) {}
+
+/// @brief construct the object
+/// @details The files are created on the first write operation
+/// @param[in] prefix path and the first part of the file names 
+FileBufferManager::FileBufferManager(const std::string &prefix) : itsPrefix(prefix) {}
+
+/// @brief destructor, removes the files
+FileBufferManager::~FileBufferManager()
+{
+  for (std::map<std::string, boost::shared_ptr<BufferFile> >::iterator it = itsFiles.begin();
+       it != itsFiles.end(); ++it) {
+       ASKAPDEBUGASSERT(it->second);
+       it->second->itsStream.close();
+       if (std::remove(it->second->itsFileName.c_str()) != 0) {
+           ASKAPLOG_WARN_STR(logger, "Unable to remove buffer file "<<it->second->itsFileName);
+       }
+  }
+}
+
+/// @brief obtain the file for the given buffer
+/// @details This method should be called with the lock held
+/// @param[in] name a name of the buffer
+/// @param[in] create if true, the file is created if it doesn't exist yet
+/// @return shared pointer to the file structure, empty if the buffer doesn't 
+/// exist and create is false
+boost::shared_ptr<FileBufferManager::BufferFile> 
+FileBufferManager::getFile(const std::string &name, bool create) const
+{
+  std::map<std::string, boost::shared_ptr<BufferFile> >::const_iterator it = itsFiles.find(name);
+  if (it != itsFiles.end()) {
+      return it->second;
+  }
+  if (!create) {
+      return boost::shared_ptr<BufferFile>();
+  }
+  boost::shared_ptr<BufferFile> file(new BufferFile);
+  file->itsFileName = itsPrefix + "_" + name + ".dat";
+  file->itsSize = 0;
+  file->itsStream.open(file->itsFileName.c_str(), std::ios::in | std::ios::out | 
+                       std::ios::binary | std::ios::trunc);
+  if (!file->itsStream) {
+      ASKAPTHROW(DataAccessError, "Unable to create buffer file "<<file->itsFileName);
+  }
+  itsFiles[name] = file;
+  return file;
+}
+
+/// @brief obtain the cell of the buffer
+/// @details This method should be called with the lock held
+/// @param[in] name a name of the buffer
+/// @param[in] index a sequential index in the buffer
+/// @return pointer to the cell information, zero if the cell is undefined
+const FileBufferManager::CellInfo* FileBufferManager::getCell(const std::string &name, 
+                                                              casacore::uInt index) const
+{
+  const boost::shared_ptr<BufferFile> file = getFile(name, false);
+  if (!file || (index >= file->itsCells.size()) || 
+      (file->itsCells[index].itsShape.nelements() == 0)) {
+      return 0;
+  }
+  return &(file->itsCells[index]);
+}
+
+/// @brief populate the cube with the data stored in the given buffer
+/// @details The method throws an exception if the requested buffer
+/// does not exist (prevents a shape mismatch)
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+void FileBufferManager::readBuffer(casacore::Cube<casacore::Complex> &vis,
+                                   const std::string &name, casacore::uInt index) const
+{
+  boost::mutex::scoped_lock lock(itsMutex);
+  const CellInfo* cell = getCell(name, index);
+  if (cell == 0) {
+      ASKAPTHROW(DataAccessError, "Buffer "<<name<<" is not defined for index "<<index);
+  }
+  ASKAPDEBUGASSERT(cell->itsShape.nelements() == 3);
+  vis.resize(cell->itsShape);
+  std::fstream &stream = itsFiles[name]->itsStream;
+  casacore::Bool deleteIt;
+  casacore::Complex *data = vis.getStorage(deleteIt);
+  stream.seekg(cell->itsOffset);
+  stream.read(reinterpret_cast<char*>(data), 
+              std::streamsize(vis.nelements() * sizeof(casacore::Complex)));
+  const bool success = !stream.fail();
+  stream.clear();
+  vis.putStorage(data, deleteIt);
+  if (!success) {
+      ASKAPTHROW(DataAccessError, "Failed to read buffer "<<name<<" for index "<<index<<
+                 " from "<<itsFiles[name]->itsFileName);
+  }
+}
+
+/// @brief write the cube back to the given buffer
+/// @details This buffer is created on the first write operation
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+void FileBufferManager::writeBuffer(const casacore::Cube<casacore::Complex> &vis,
+                                    const std::string &name, casacore::uInt index) const
+{
+  boost::mutex::scoped_lock lock(itsMutex);
+  const boost::shared_ptr<BufferFile> file = getFile(name, true);
+  ASKAPDEBUGASSERT(file);
+  if (index >= file->itsCells.size()) {
+      file->itsCells.resize(index + 1);
+  }
+  CellInfo &cell = file->itsCells[index];
+  if (cell.itsCapacity < vis.nelements()) {
+      // doesn't fit into the old place, append to the end of the file
+      cell.itsOffset = file->itsSize;
+      cell.itsCapacity = vis.nelements();
+      file->itsSize += std::streamoff(vis.nelements() * sizeof(casacore::Complex));
+  }
+  cell.itsShape = vis.shape();
+  casacore::Bool deleteIt;
+  const casacore::Complex *data = vis.getStorage(deleteIt);
+  file->itsStream.seekp(cell.itsOffset);
+  file->itsStream.write(reinterpret_cast<const char*>(data), 
+                        std::streamsize(vis.nelements() * sizeof(casacore::Complex)));
+  vis.freeStorage(data, deleteIt);
+  if (file->itsStream.fail()) {
+      file->itsStream.clear();
+      // the content of the cell is undefined now
+      cell.itsShape.resize(0);
+      ASKAPTHROW(DataAccessError, "Failed to write buffer "<<name<<" for index "<<index<<
+                 " to "<<file->itsFileName);
+  }
+}
+
+/// @brief check whether the particular buffer exists
+/// @param[in] name a name of the buffer to query
+/// @param[in] index a sequential index in the buffer
+/// @return true, if the buffer with the given name is present
+bool FileBufferManager::bufferExists(const std::string &name, casacore::uInt index) const
+{
+  boost::mutex::scoped_lock lock(itsMutex);
+  return getCell(name, index) != 0;
+}
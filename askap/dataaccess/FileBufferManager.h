@@ -0,0 +1,167 @@
+/// @file
+/// @brief A class to manage buffers stored in flat binary files
+/// @details Read-write iterator (see IDataIterator) uses the concept
+/// of buffers to store scratch data. This class keeps each buffer in a
+/// separate flat binary file with the cubes written one after another
+/// as raw contiguous blocks, so writing and reading back a buffer
+/// chunk by chunk results in sequential large-block I/O. The buffers
+/// are scratch data: the index of the file is only held in memory and 
+/// the files are removed when the manager is destroyed.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_FILE_BUFFER_MANAGER_H
+#define ASKAP_ACCESSORS_FILE_BUFFER_MANAGER_H
+
+// std includes
+#include <string>
+#include <map>
+#include <vector>
+#include <fstream>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+// own includes
+#include <askap/dataaccess/IBufferManager.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief A class to manage buffers stored in flat binary files
+/// @details Each buffer is stored in the file named prefix_name.dat. A cell
+/// (the cube for the given index) is rewritten in place if the new cube fits into
+/// the space allocated for it previously, otherwise the cube is appended to the 
+/// end of the file. The buffers don't survive the lifetime of this object, unlike
+/// the subtable-based buffers (see TableBufferManager). All methods can be called
+/// from several threads.
+/// @ingroup dataaccess_tab
+class FileBufferManager : virtual public IBufferManager,
+                          private boost::noncopyable
+{
+public:
+  /// @brief construct the object
+  /// @details The files are created on the first write operation
+  /// @param[in] prefix path and the first part of the file names 
+  explicit FileBufferManager(const std::string &prefix);
+
+  /// @brief destructor, removes the files
+  virtual ~FileBufferManager();
+  
+  /// @brief populate the cube with the data stored in the given buffer
+  /// @details The method throws an exception if the requested buffer
+  /// does not exist (prevents a shape mismatch)
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  virtual void readBuffer(casacore::Cube<casacore::Complex> &vis,
+                          const std::string &name,
+                          casacore::uInt index) const;
+  
+  /// @brief write the cube back to the given buffer
+  /// @details This buffer is created on the first write operation
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  virtual void writeBuffer(const casacore::Cube<casacore::Complex> &vis,
+                           const std::string &name,
+                           casacore::uInt index) const;
+
+  /// @brief check whether the particular buffer exists
+  /// @param[in] name a name of the buffer to query
+  /// @param[in] index a sequential index in the buffer
+  /// @return true, if the buffer with the given name is present
+  virtual bool bufferExists(const std::string &name,
+                            casacore::uInt index) const;
+
+protected:
+  /// @brief location of one cube in the file
+  struct CellInfo {
+     /// @brief default constructor, the cell is undefined
+     CellInfo();
+
+     /// @brief offset of the cube in bytes from the start of the file
+     std::streamoff itsOffset;
+     /// @brief space allocated in the file for this cell (in elements)
+     size_t itsCapacity;
+     /// @brief shape of the cube stored, empty if the cell is undefined
+     casacore::IPosition itsShape;
+  };
+
+  /// @brief file and index for one buffer
+  struct BufferFile {
+     /// @brief name of the file
+     std::string itsFileName;
+     /// @brief file stream opened for reading and writing
+     std::fstream itsStream;
+     /// @brief current size of the file in bytes
+     std::streamoff itsSize;
+     /// @brief locations of the cubes, vector index is the buffer index
+     std::vector<CellInfo> itsCells;
+  };
+
+  /// @brief obtain the file for the given buffer
+  /// @details This method should be called with the lock held
+  /// @param[in] name a name of the buffer
+  /// @param[in] create if true, the file is created if it doesn't exist yet
+  /// @return shared pointer to the file structure, empty if the buffer doesn't 
+  /// exist and create is false
+  boost::shared_ptr<BufferFile> getFile(const std::string &name, bool create) const;
+
+  /// @brief obtain the cell of the buffer
+  /// @details This method should be called with the lock held
+  /// @param[in] name a name of the buffer
+  /// @param[in] index a sequential index in the buffer
+  /// @return pointer to the cell information, zero if the cell is undefined
+  const CellInfo* getCell(const std::string &name, casacore::uInt index) const;
+
+private:
+  /// @brief path and first part of the file names
+  std::string itsPrefix;
+
+  /// @brief files for the buffers which were written to
+  mutable std::map<std::string, boost::shared_ptr<BufferFile> > itsFiles;
+
+  /// @brief mutex protecting the files and index
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_FILE_BUFFER_MANAGER_H
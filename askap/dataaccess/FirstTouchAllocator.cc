@@ -0,0 +1,99 @@
+/// @file
+/// @brief allocator placing the buffers on a given NUMA node
+///
+/// @details Memory pages are placed on the NUMA node of the thread which touches them
+/// first. This allocator touches each page of a new block from a helper thread pinned
+/// to the given set of CPUs.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/FirstTouchAllocator.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <cstdlib>
+
+// system includes
+#include <unistd.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up the allocator
+/// @param[in] affinity CPUs of the node the memory should be placed on
+FirstTouchAllocator::FirstTouchAllocator(const ThreadAffinity &affinity) : itsAffinity(affinity) {}
+
+/// @brief allocate a block of memory
+/// @details Each page is touched by a thread restricted to the given CPUs
+/// @param[in] nBytes size of the block in bytes
+/// @return pointer to the block
+void* FirstTouchAllocator::allocate(size_t nBytes)
+{
+  const long pageSize = sysconf(_SC_PAGESIZE);
+  void *ptr = NULL;
+  const int status = posix_memalign(&ptr, pageSize > 0 ? size_t(pageSize) : 4096, nBytes);
+  ASKAPCHECK(status == 0, "Unable to allocate "<<nBytes<<" bytes for the data buffer, status="<<status);
+  if (itsAffinity.empty()) {
+      touch(itsAffinity, static_cast<char*>(ptr), nBytes);
+  } else {
+      // the calling thread keeps its own affinity
+      boost::thread toucher(boost::bind(&FirstTouchAllocator::touch, boost::cref(itsAffinity),
+                            static_cast<char*>(ptr), nBytes));
+      toucher.join();
+  }
+  return ptr;
+}
+
+/// @brief return the block of memory
+/// @param[in] ptr pointer to the block obtained from allocate
+/// @param[in] nBytes size of the block in bytes
+void FirstTouchAllocator::deallocate(void *ptr, size_t)
+{
+  std::free(ptr);
+}
+
+/// @brief touch each page of the block
+/// @param[in] affinity CPUs to run on (applied to the calling thread)
+/// @param[in] ptr pointer to the block
+/// @param[in] nBytes size of the block in bytes
+void FirstTouchAllocator::touch(const ThreadAffinity &affinity, char *ptr, size_t nBytes)
+{
+  affinity.apply();
+  const long pageSize = sysconf(_SC_PAGESIZE);
+  const size_t step = pageSize > 0 ? size_t(pageSize) : 4096;
+  for (size_t offset = 0; offset < nBytes; offset += step) {
+       ptr[offset] = 0;
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
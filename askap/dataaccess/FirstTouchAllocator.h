@@ -0,0 +1,90 @@
+/// @file
+/// @brief allocator placing the buffers on a given NUMA node
+///
+/// @details Memory pages are placed on the NUMA node of the thread which touches them
+/// first. This allocator touches each page of a new block from a helper thread pinned
+/// to the given set of CPUs, so the block resides on their node regardless of the 
+/// thread which requested it (e.g. the background reader). Blocks are only requested
+/// when a buffer grows (see ReusableBuffer), so the cost of the helper thread is small.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_FIRST_TOUCH_ALLOCATOR_H
+#define ASKAP_ACCESSORS_FIRST_TOUCH_ALLOCATOR_H
+
+// own includes
+#include <askap/dataaccess/IBufferAllocator.h>
+#include <askap/dataaccess/ThreadAffinity.h>
+
+// std includes
+#include <cstddef>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief allocator placing the buffers on a given NUMA node
+/// @details Blocks are aligned to the page boundary. If the set of CPUs is empty,
+/// the pages are touched by the calling thread.
+/// @ingroup dataaccess_hlp
+class FirstTouchAllocator : public IBufferAllocator {
+public:
+  /// @brief set up the allocator
+  /// @param[in] affinity CPUs of the node the memory should be placed on
+  explicit FirstTouchAllocator(const ThreadAffinity &affinity);
+
+  /// @brief allocate a block of memory
+  /// @details Each page is touched by a thread restricted to the given CPUs
+  /// @param[in] nBytes size of the block in bytes
+  /// @return pointer to the block
+  virtual void* allocate(size_t nBytes);
+
+  /// @brief return the block of memory
+  /// @param[in] ptr pointer to the block obtained from allocate
+  /// @param[in] nBytes size of the block in bytes
+  virtual void deallocate(void *ptr, size_t nBytes);
+
+  /// @brief CPUs of the node the memory is placed on
+  /// @return a const reference to the set of CPUs
+  inline const ThreadAffinity& affinity() const { return itsAffinity; }
+
+protected:
+  /// @brief touch each page of the block
+  /// @param[in] affinity CPUs to run on (applied to the calling thread)
+  /// @param[in] ptr pointer to the block
+  /// @param[in] nBytes size of the block in bytes
+  static void touch(const ThreadAffinity &affinity, char *ptr, size_t nBytes);
+
+private:
+  /// @brief CPUs of the node the memory is placed on
+  ThreadAffinity itsAffinity;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_FIRST_TOUCH_ALLOCATOR_H
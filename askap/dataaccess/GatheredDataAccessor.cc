@@ -0,0 +1,366 @@
+/// @file
+/// @brief an accessor holding rows gathered from a number of chunks
+/// @details This class is used by BaselineMajorIteratorAdapter to deliver all
+/// rows of one baseline (or one antenna) within a time window as a single chunk.
+/// It can either hold a copy of a whole chunk of another accessor or rows gathered
+/// from a number of such copies. As rows may come from different time stamps, the
+/// time of each row is available via rowTime.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/GatheredDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief gather elements of per-row vectors
+/// @param[in] chunks accessors to take the rows from
+/// @param[in] rows pairs of the chunk index and the row in that chunk
+/// @param[in] field member function returning the vector
+/// @param[out] out vector with the selected elements
+template<typename T>
+void gatherRows(const std::vector<boost::shared_ptr<GatheredDataAccessor> > &chunks,
+                const std::vector<std::pair<casacore::uInt, casacore::uInt> > &rows,
+                const casacore::Vector<T>& (GatheredDataAccessor::*field)() const, casacore::Vector<T> &out)
+{
+  out.resize(rows.size());
+  for (size_t row = 0; row < rows.size(); ++row) {
+       const casacore::Vector<T> &in = ((*chunks[rows[row].first]).*field)();
+       ASKAPDEBUGASSERT(rows[row].second < in.nelements());
+       out[row] = in[rows[row].second];
+  }
+}
+
+/// @brief gather rows of cubes
+/// @details The output cube is filled one plane (channel and polarisation) at a time
+/// @param[in] chunks accessors to take the rows from
+/// @param[in] rows pairs of the chunk index and the row in that chunk
+/// @param[in] field member function returning the cube
+/// @param[out] out cube with the selected rows (should already have the right shape)
+template<typename T>
+void gatherCube(const std::vector<boost::shared_ptr<GatheredDataAccessor> > &chunks,
+                const std::vector<std::pair<casacore::uInt, casacore::uInt> > &rows,
+                const casacore::Cube<T>& (GatheredDataAccessor::*field)() const, casacore::Cube<T> &out)
+{
+  ASKAPDEBUGASSERT(out.nrow() == rows.size());
+  ASKAPDEBUGASSERT(out.contiguousStorage());
+  // start of each input row in its cube and the plane stride of that cube
+  std::vector<const T*> starts(rows.size());
+  std::vector<size_t> strides(rows.size());
+  for (size_t row = 0; row < rows.size(); ++row) {
+       const casacore::Cube<T> &in = ((*chunks[rows[row].first]).*field)();
+       ASKAPDEBUGASSERT(in.contiguousStorage());
+       ASKAPDEBUGASSERT((in.ncolumn() == out.ncolumn()) && (in.nplane() == out.nplane()));
+       starts[row] = in.data() + rows[row].second;
+       strides[row] = in.nrow();
+  }
+  const size_t nPlanes = out.ncolumn() * out.nplane();
+  T *outPtr = out.data();
+  for (size_t plane = 0; plane < nPlanes; ++plane) {
+       for (size_t row = 0; row < rows.size(); ++row, ++outPtr) {
+            *outPtr = starts[row][plane * strides[row]];
+       }
+  }
+}
+
+} // anonymous namespace
+
+/// @brief construct an empty accessor
+/// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+/// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
+/// to initialisation of a new UVW Machine
+GatheredDataAccessor::GatheredDataAccessor(size_t cacheSize, double tolerance) : 
+     itsRotatedUVW(cacheSize, tolerance) {}
+
+/// @brief copy all rows of another accessor
+/// @details The noise cube of the accessor is copied as well, i.e. it may be read on demand.
+/// The values are copied into the storage of this accessor, which is reused if the shape
+/// is the same (i.e. the arrays obtained from this accessor before are overwritten).
+/// @param[in] acc accessor to copy
+void GatheredDataAccessor::assign(const IConstDataAccessor &acc)
+{
+  itsAntenna1.assign(acc.antenna1());
+  itsAntenna2.assign(acc.antenna2());
+  itsFeed1.assign(acc.feed1());
+  itsFeed2.assign(acc.feed2());
+  itsFeed1PA.assign(acc.feed1PA());
+  itsFeed2PA.assign(acc.feed2PA());
+  itsPointingDir1.assign(acc.pointingDir1());
+  itsPointingDir2.assign(acc.pointingDir2());
+  itsDishPointing1.assign(acc.dishPointing1());
+  itsDishPointing2.assign(acc.dishPointing2());
+  itsVisibility.assign(acc.visibility());
+  itsFlag.assign(acc.flag());
+  itsNoise.assign(acc.noise());
+  itsUVW.assign(acc.uvw());
+  itsRowTime.resize(acc.nRow());
+  itsRowTime.set(acc.time());
+  itsFrequency.assign(acc.frequency());
+  itsStokes.assign(acc.stokes());
+  itsRotatedUVW.invalidate();
+}
+
+/// @brief gather rows of a number of accessors
+/// @param[in] chunks accessors filled by assign
+/// @param[in] rows pairs of the chunk index and the row in that chunk (one per output row)
+void GatheredDataAccessor::gather(const std::vector<boost::shared_ptr<GatheredDataAccessor> > &chunks,
+              const std::vector<std::pair<casacore::uInt, casacore::uInt> > &rows)
+{
+  ASKAPCHECK(chunks.size() > 0, "GatheredDataAccessor::gather requires at least one chunk");
+  for (std::vector<std::pair<casacore::uInt, casacore::uInt> >::const_iterator ci = rows.begin(); 
+       ci != rows.end(); ++ci) {
+       ASKAPCHECK(ci->first < chunks.size(), "Chunk index "<<ci->first<<" exceeds the number of chunks ("<<
+                  chunks.size()<<")");
+       ASKAPCHECK(ci->second < chunks[ci->first]->nRow(), "Row "<<ci->second<<" exceeds the number of rows ("<<
+                  chunks[ci->first]->nRow()<<") of chunk "<<ci->first);
+  }
+  const GatheredDataAccessor &first = *chunks[0];
+  for (size_t chunk = 1; chunk < chunks.size(); ++chunk) {
+       ASKAPCHECK((chunks[chunk]->nChannel() == first.nChannel()) && (chunks[chunk]->nPol() == first.nPol()),
+                  "All chunks gathered by GatheredDataAccessor should have the same number of channels and polarisations");
+  }
+  gatherRows(chunks, rows, &GatheredDataAccessor::antenna1, itsAntenna1);
+  gatherRows(chunks, rows, &GatheredDataAccessor::antenna2, itsAntenna2);
+  gatherRows(chunks, rows, &GatheredDataAccessor::feed1, itsFeed1);
+  gatherRows(chunks, rows, &GatheredDataAccessor::feed2, itsFeed2);
+  gatherRows(chunks, rows, &GatheredDataAccessor::feed1PA, itsFeed1PA);
+  gatherRows(chunks, rows, &GatheredDataAccessor::feed2PA, itsFeed2PA);
+  gatherRows(chunks, rows, &GatheredDataAccessor::pointingDir1, itsPointingDir1);
+  gatherRows(chunks, rows, &GatheredDataAccessor::pointingDir2, itsPointingDir2);
+  gatherRows(chunks, rows, &GatheredDataAccessor::dishPointing1, itsDishPointing1);
+  gatherRows(chunks, rows, &GatheredDataAccessor::dishPointing2, itsDishPointing2);
+  gatherRows(chunks, rows, &GatheredDataAccessor::uvw, itsUVW);
+  gatherRows(chunks, rows, &GatheredDataAccessor::rowTime, itsRowTime);
+  const casacore::IPosition shape(3, rows.size(), first.nChannel(), first.nPol());
+  itsVisibility.resize(shape);
+  itsFlag.resize(shape);
+  itsNoise.resize(shape);
+  gatherCube(chunks, rows, &GatheredDataAccessor::visibility, itsVisibility);
+  gatherCube(chunks, rows, &GatheredDataAccessor::flag, itsFlag);
+  gatherCube(chunks, rows, &GatheredDataAccessor::noise, itsNoise);
+  itsFrequency.assign(first.frequency().copy());
+  itsStokes.assign(first.stokes().copy());
+  itsRotatedUVW.invalidate();
+}
+
+/// The number of rows in this chunk
+/// @return the number of rows in this chunk
+casacore::uInt GatheredDataAccessor::nRow() const throw()
+{
+  return itsVisibility.nrow();
+}
+
+/// The number of spectral channels (equal for all rows)
+/// @return the number of spectral channels
+casacore::uInt GatheredDataAccessor::nChannel() const throw()
+{
+  return itsVisibility.ncolumn();
+}
+
+/// The number of polarization products (equal for all rows)
+/// @return the number of polarization products (can be 1,2 or 4)
+casacore::uInt GatheredDataAccessor::nPol() const throw()
+{
+  return itsVisibility.nplane();
+}
+
+/// First antenna IDs for all rows
+/// @return a vector with IDs of the first antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& GatheredDataAccessor::antenna1() const
+{
+  return itsAntenna1;
+}
+
+/// Second antenna IDs for all rows
+/// @return a vector with IDs of the second antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& GatheredDataAccessor::antenna2() const
+{
+  return itsAntenna2;
+}
+
+/// First feed IDs for all rows
+/// @return a vector with IDs of the first feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& GatheredDataAccessor::feed1() const
+{
+  return itsFeed1;
+}
+
+/// Second feed IDs for all rows
+/// @return a vector with IDs of the second feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& GatheredDataAccessor::feed2() const
+{
+  return itsFeed2;
+}
+
+/// Position angles of the first feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// first feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& GatheredDataAccessor::feed1PA() const
+{
+  return itsFeed1PA;
+}
+
+/// Position angles of the second feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// second feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& GatheredDataAccessor::feed2PA() const
+{
+  return itsFeed2PA;
+}
+
+/// Return pointing centre directions of the first antenna/feed
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& GatheredDataAccessor::pointingDir1() const
+{
+  return itsPointingDir1;
+}
+
+/// Pointing centre directions of the second antenna/feed
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& GatheredDataAccessor::pointingDir2() const
+{
+  return itsPointingDir2;
+}
+
+/// pointing direction for the centre of the first antenna 
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& GatheredDataAccessor::dishPointing1() const
+{
+  return itsDishPointing1;
+}
+
+/// pointing direction for the centre of the first antenna 
+/// @return a vector with direction measures, one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& GatheredDataAccessor::dishPointing2() const
+{
+  return itsDishPointing2;
+}
+
+/// Visibilities (a cube is nRow x nChannel x nPol; each element is
+/// a complex visibility)
+/// @return a reference to nRow x nChannel x nPol cube, containing
+/// all visibility data
+const casacore::Cube<casacore::Complex>& GatheredDataAccessor::visibility() const
+{
+  return itsVisibility;
+}
+
+/// Cube of flags corresponding to the output of visibility() 
+/// @return a reference to nRow x nChannel x nPol cube with flag 
+///         information. If True, the corresponding element is flagged.
+const casacore::Cube<casacore::Bool>& GatheredDataAccessor::flag() const
+{
+  return itsFlag;
+}
+
+/// UVW
+/// @return a reference to vector containing uvw-coordinates
+/// packed into a 3-D rigid vector
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& GatheredDataAccessor::uvw() const
+{
+  return itsUVW;
+}
+
+/// @brief uvw after rotation
+/// @details This method calls UVWMachine to rotate baseline coordinates 
+/// for a new tangent point. Delays corresponding to this correction are
+/// returned by a separate method.
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return uvw after rotation to the new coordinate system for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	         GatheredDataAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
+{
+  return itsRotatedUVW.uvw(*this, tangentPoint);
+}
+
+/// @brief delay associated with uvw rotation
+/// @details This is a companion method to rotatedUVW. It returns delays corresponding
+/// to the baseline coordinate rotation. 
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+/// @return delays corresponding to the uvw rotation for each row
+const casacore::Vector<casacore::Double>& GatheredDataAccessor::uvwRotationDelay(
+	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
+{
+  return itsRotatedUVW.delays(*this, tangentPoint, imageCentre);
+}
+
+/// Noise level required for a proper weighting
+/// @return a reference to nRow x nChannel x nPol cube with
+///         complex noise estimates
+const casacore::Cube<casacore::Complex>& GatheredDataAccessor::noise() const
+{
+  return itsNoise;
+}
+
+/// Timestamp of the chunk
+/// @return the time of the first row, see rowTime for the time of each row
+casacore::Double GatheredDataAccessor::time() const
+{
+  return itsRowTime.nelements() > 0 ? itsRowTime[0] : 0.;
+}
+
+/// Frequency for each channel
+/// @return a reference to vector containing frequencies for each
+///         spectral channel (vector size is nChannel).
+const casacore::Vector<casacore::Double>& GatheredDataAccessor::frequency() const
+{
+  return itsFrequency;
+}
+
+/// Velocity for each channel
+/// @details Velocities are not copied, this method throws an exception
+/// @return a reference to vector containing velocities for each
+///         spectral channel (vector size is nChannel).
+const casacore::Vector<casacore::Double>& GatheredDataAccessor::velocity() const
+{
+  ASKAPTHROW(DataAccessLogicError, "GatheredDataAccessor::velocity is not supported");
+}
+
+/// @brief polarisation type for each product
+/// @return a reference to vector containing polarisation types for
+/// each product in the visibility cube (nPol() elements).
+const casacore::Vector<casacore::Stokes::StokesTypes>& GatheredDataAccessor::stokes() const
+{
+  return itsStokes;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -67,11 +67,22 @@ struct GenericConverter : virtual public IConverterBase {
     /// convert specified measure to the target units/frame
     /// @param[in] in a measure to convert. 
     virtual inline casacore::Double operator()(const M &in) const {       
-       typename M::MVType converted=
-                typename M::Convert(in.getRef(),itsTargetRef)(in).getValue();
-       return converted.get(itsTargetUnit).getValue();
+       return convertedValue(in).get(itsTargetUnit).getValue();
     }
 
+    /// @brief convert specified measure to the target frame
+    /// @details Unlike operator(), the value is returned without the conversion to
+    /// the target units.
+    /// @param[in] in a measure to convert. 
+    /// @return value of the converted measure
+    inline typename M::MVType convertedValue(const M &in) const {
+       return typename M::Convert(in.getRef(),itsTargetRef)(in).getValue();
+    }
+
+    /// @brief units of the output
+    /// @return a const reference to the target units
+    inline const casacore::Unit& targetUnit() const { return itsTargetUnit; }
+
     /// set a frame (i.e. time and/or position), where the
     /// conversion is performed
     /// @param[in] frame  MeasFrame object (can be constructed from
@@ -0,0 +1,371 @@
+/// @file
+/// @brief hardware performance counters of instrumented sections
+/// @details This class reads the processor's hardware counters (cycles, instructions and
+/// last level cache misses) at the start and the end of every section instrumented with
+/// AccessTracer::Scope (iterator steps, cube fills, calibration solution access, etc) and
+/// accumulates the differences per thread and section. This allows one to see whether the
+/// fill and transpose kernels are limited by memory bandwidth. The counters are read via
+/// the Linux perf_event interface, the collection is switched off by default and can be
+/// switched on by the ASKAP_ACCESSORS_HWCOUNTERS environment variable or via the parset
+/// (see configure).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/dataaccess/HardwareCounters.h>
+
+// casa includes
+#include <casacore/casa/OS/EnvVar.h>
+
+// boost includes
+#include <boost/thread/tss.hpp>
+
+// std includes
+#include <cstring>
+#include <set>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+ASKAP_LOGGER(logger, ".dataaccess");
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief counters of one thread
+/// @details The counters are opened as a group with the cycle counter as the leader,
+/// so all of them are read with one system call and cover the same time interval.
+struct CounterGroup : private boost::noncopyable {
+  /// @brief open the counters for the calling thread
+  CounterGroup();
+
+  /// @brief close the counters
+  ~CounterGroup();
+
+  /// @brief read the counters
+  /// @param[out] values array of HardwareCounters::N_COUNTERS values to fill
+  /// @return true on success
+  bool read(casacore::uInt64 *values) const;
+
+  /// @brief file descriptors of the counters, -1 if not open
+  int itsFDs[HardwareCounters::N_COUNTERS];
+
+  /// @brief true if all counters have been opened
+  bool itsValid;
+};
+
+/// @brief open the counters for the calling thread
+CounterGroup::CounterGroup() : itsValid(false)
+{
+  for (int counter = 0; counter < HardwareCounters::N_COUNTERS; ++counter) {
+       itsFDs[counter] = -1;
+  }
+#ifdef __linux__
+  const casacore::uInt64 events[HardwareCounters::N_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES,
+         PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+  for (int counter = 0; counter < HardwareCounters::N_COUNTERS; ++counter) {
+       struct perf_event_attr attr;
+       std::memset(&attr, 0, sizeof(attr));
+       attr.size = sizeof(attr);
+       attr.type = PERF_TYPE_HARDWARE;
+       attr.config = events[counter];
+       attr.read_format = PERF_FORMAT_GROUP;
+       attr.exclude_kernel = 1;
+       attr.exclude_hv = 1;
+       // this thread on any CPU, the first counter is the group leader
+       itsFDs[counter] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, 
+                                   counter == 0 ? -1 : itsFDs[0], 0));
+       if (itsFDs[counter] < 0) {
+           return;
+       }
+  }
+  itsValid = true;
+#endif
+}
+
+/// @brief close the counters
+CounterGroup::~CounterGroup()
+{
+#ifdef __linux__
+  for (int counter = HardwareCounters::N_COUNTERS - 1; counter >= 0; --counter) {
+       if (itsFDs[counter] >= 0) {
+           close(itsFDs[counter]);
+       }
+  }
+#endif
+}
+
+/// @brief read the counters
+/// @param[out] values array of HardwareCounters::N_COUNTERS values to fill
+/// @return true on success
+bool CounterGroup::read(casacore::uInt64 *values) const
+{
+#ifdef __linux__
+  if (itsValid) {
+      // group read format: the number of counters followed by the values
+      casacore::uInt64 buf[HardwareCounters::N_COUNTERS + 1];
+      if (::read(itsFDs[0], buf, sizeof(buf)) == static_cast<ssize_t>(sizeof(buf)) &&
+          (buf[0] == HardwareCounters::N_COUNTERS)) {
+          std::memcpy(values, buf + 1, HardwareCounters::N_COUNTERS * sizeof(casacore::uInt64));
+          return true;
+      }
+  }
+#endif
+  return false;
+}
+
+/// @brief counters of the calling thread
+/// @return reference to the thread's counter group, opened on the first call
+const CounterGroup& threadGroup()
+{
+  static boost::thread_specific_ptr<CounterGroup> groups;
+  if (groups.get() == NULL) {
+      groups.reset(new CounterGroup);
+  }
+  return *groups;
+}
+
+} // anonymous namespace
+
+/// @brief all counts are zero
+HardwareCounters::Totals::Totals() : itsCalls(0)
+{
+  for (int counter = 0; counter < N_COUNTERS; ++counter) {
+       itsCounts[counter] = 0;
+  }
+}
+
+/// @brief construct the object
+/// @details The collection is switched on if requested by the environment
+HardwareCounters::HardwareCounters() : itsEnabled(false), itsUsed(false), itsWarned(false)
+{
+  configureFromEnvironment();
+}
+
+/// @brief the counters of this process
+/// @details The object is created on the first call and configured from the
+/// ASKAP_ACCESSORS_HWCOUNTERS environment variable (see configureFromEnvironment).
+/// @return reference to the object
+HardwareCounters& HardwareCounters::instance()
+{
+  static HardwareCounters counters;
+  return counters;
+}
+
+/// @brief switch the collection on or off
+/// @details The accumulated counts are not reset, so the collection can be paused.
+/// @param[in] collect true to collect the counters
+void HardwareCounters::enable(bool collect)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsEnabled = collect;
+  if (collect) {
+      itsUsed = true;
+  }
+}
+
+/// @brief switch the collection on if requested in the parset
+/// @details Nothing is done if the key is not defined, so the collection switched
+/// on by one component is not switched off by another.
+/// @param[in] parset parameters
+/// @param[in] key name of the boolean parameter
+void HardwareCounters::configure(const LOFAR::ParameterSet &parset, const std::string &key)
+{
+  if (!isEnabled() && parset.isDefined(key) && parset.getBool(key)) {
+      ASKAPLOG_INFO_STR(logger, "Hardware performance counters will be collected for the data access operations");
+      enable();
+  }
+}
+
+/// @brief switch the collection on if requested by the environment
+/// @details The collection is switched on if the ASKAP_ACCESSORS_HWCOUNTERS variable
+/// is set to "true", "yes" or "1".
+void HardwareCounters::configureFromEnvironment()
+{
+  if (casacore::EnvironmentVariable::isDefined("ASKAP_ACCESSORS_HWCOUNTERS")) {
+      const std::string value = casacore::EnvironmentVariable::get("ASKAP_ACCESSORS_HWCOUNTERS");
+      if ((value == "true") || (value == "yes") || (value == "1")) {
+          enable();
+      }
+  }
+}
+
+/// @brief reset all accumulated counts
+void HardwareCounters::reset()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsTotals.clear();
+}
+
+/// @brief read the counters of the calling thread
+/// @details The counters are opened on the first call from the given thread. 
+/// @param[out] values array of N_COUNTERS values to fill
+/// @return true on success, false if the counters are not available
+bool HardwareCounters::read(casacore::uInt64 *values)
+{
+  ASKAPDEBUGASSERT(values != NULL);
+  if (threadGroup().read(values)) {
+      return true;
+  }
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (!itsWarned) {
+      ASKAPLOG_WARN_STR(logger, "Hardware performance counters are not available (check "
+                        "/proc/sys/kernel/perf_event_paranoid), they will not be collected");
+      itsWarned = true;
+  }
+  return false;
+}
+
+/// @brief account for a section executed by the calling thread
+/// @details This method is thread-safe. Sections are ignored if the collection is off.
+/// @param[in] section name of the section
+/// @param[in] start counters read at the start of the section (N_COUNTERS values)
+/// @param[in] end counters read at the end of the section (N_COUNTERS values)
+void HardwareCounters::add(const std::string &section, const casacore::uInt64 *start, 
+                           const casacore::uInt64 *end)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (!itsEnabled) {
+      return;
+  }
+  const boost::thread::id id = boost::this_thread::get_id();
+  std::map<boost::thread::id, casacore::uInt>::const_iterator ci = itsThreads.find(id);
+  if (ci == itsThreads.end()) {
+      ci = itsThreads.insert(std::make_pair(id, static_cast<casacore::uInt>(itsThreads.size()))).first;
+  }
+  Totals &totals = itsTotals[std::make_pair(ci->second, section)];
+  ++totals.itsCalls;
+  for (int counter = 0; counter < N_COUNTERS; ++counter) {
+       // counters are monotonic, guard against a wrong order of arguments
+       if (end[counter] > start[counter]) {
+           totals.itsCounts[counter] += end[counter] - start[counter];
+       }
+  }
+}
+
+/// @brief number of times the section has been accounted
+/// @param[in] section name of the section
+/// @return number of calls summed over all threads
+casacore::uInt64 HardwareCounters::nCalls(const std::string &section) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  casacore::uInt64 result = 0;
+  for (std::map<std::pair<casacore::uInt, std::string>, Totals>::const_iterator ci = itsTotals.begin();
+       ci != itsTotals.end(); ++ci) {
+       if (ci->first.second == section) {
+           result += ci->second.itsCalls;
+       }
+  }
+  return result;
+}
+
+/// @brief accumulated count for the section
+/// @param[in] section name of the section
+/// @param[in] counter event
+/// @return count summed over all threads
+casacore::uInt64 HardwareCounters::count(const std::string &section, Counter counter) const
+{
+  ASKAPCHECK((counter >= 0) && (counter < N_COUNTERS), "Unknown counter "<<int(counter));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  casacore::uInt64 result = 0;
+  for (std::map<std::pair<casacore::uInt, std::string>, Totals>::const_iterator ci = itsTotals.begin();
+       ci != itsTotals.end(); ++ci) {
+       if (ci->first.second == section) {
+           result += ci->second.itsCounts[counter];
+       }
+  }
+  return result;
+}
+
+/// @brief number of threads which have reported sections
+casacore::uInt HardwareCounters::nThreads() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  std::set<casacore::uInt> threads;
+  for (std::map<std::pair<casacore::uInt, std::string>, Totals>::const_iterator ci = itsTotals.begin();
+       ci != itsTotals.end(); ++ci) {
+       threads.insert(ci->first.first);
+  }
+  return static_cast<casacore::uInt>(threads.size());
+}
+
+/// @brief name of the event
+/// @param[in] counter event
+/// @return the name used in the log
+std::string HardwareCounters::counterName(Counter counter)
+{
+  switch (counter) {
+     case CYCLES:
+          return "cycles";
+     case INSTRUCTIONS:
+          return "instructions";
+     case LLC_MISSES:
+          return "LLC misses";
+     default:
+          ASKAPTHROW(AskapError, "Unknown counter "<<int(counter));
+  }
+  return "";
+}
+
+/// @brief write the counts into the log
+/// @details This method is intended to be called at the end of the job together with 
+/// IteratorStatistics::log and CalibrationStatistics::log. The counts are reported per thread
+/// and section at the INFO level. Nothing is written if the collection has never been on.
+void HardwareCounters::log() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (!itsUsed) {
+      return;
+  }
+  ASKAPLOG_INFO_STR(logger, "Hardware counters: "<<itsTotals.size()<<" section(s)");
+  for (std::map<std::pair<casacore::uInt, std::string>, Totals>::const_iterator ci = itsTotals.begin();
+       ci != itsTotals.end(); ++ci) {
+       const Totals &totals = ci->second;
+       const double ipc = totals.itsCounts[CYCLES] > 0 ? 
+             double(totals.itsCounts[INSTRUCTIONS]) / double(totals.itsCounts[CYCLES]) : 0.;
+       ASKAPLOG_INFO_STR(logger, "  thread "<<ci->first.first<<", "<<ci->first.second<<": "<<
+                         totals.itsCalls<<" call(s), "<<totals.itsCounts[CYCLES]<<" cycles, "<<
+                         totals.itsCounts[INSTRUCTIONS]<<" instructions ("<<ipc<<" per cycle), "<<
+                         totals.itsCounts[LLC_MISSES]<<" LLC misses (~"<<
+                         totals.itsCounts[LLC_MISSES] * theirCacheLineSize<<" bytes from DRAM)");
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
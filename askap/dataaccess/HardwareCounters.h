@@ -0,0 +1,195 @@
+/// @file
+/// @brief hardware performance counters of instrumented sections
+/// @details This class reads the processor's hardware counters (cycles, instructions and
+/// last level cache misses) at the start and the end of every section instrumented with
+/// AccessTracer::Scope (iterator steps, cube fills, calibration solution access, etc) and
+/// accumulates the differences per thread and section. This allows one to see whether the
+/// fill and transpose kernels are limited by memory bandwidth. The counters are read via
+/// the Linux perf_event interface, the collection is switched off by default and can be
+/// switched on by the ASKAP_ACCESSORS_HWCOUNTERS environment variable or via the parset
+/// (see configure).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_HARDWARE_COUNTERS_H
+#define ASKAP_ACCESSORS_HARDWARE_COUNTERS_H
+
+// std includes
+#include <map>
+#include <string>
+#include <utility>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief hardware performance counters of instrumented sections
+/// @details There is one object per process (see instance). The counters of each thread
+/// are opened when the thread enters its first instrumented section with the collection
+/// switched on and are only readable by this thread. Nothing is done unless the collection
+/// is switched on, the check is a single flag test done by AccessTracer::Scope, so there is
+/// no overhead otherwise. If the counters can't be opened (e.g. the kernel doesn't support
+/// perf_event or perf_event_paranoid forbids it), a warning is logged once and the sections
+/// are not accounted. Counts are inclusive, i.e. a nested section is counted in both. Only
+/// user-space events are counted. There is no portable event for the DRAM traffic, it is
+/// estimated as the number of last level cache misses times the cache line size.
+/// @ingroup dataaccess_hlp
+class HardwareCounters : private boost::noncopyable
+{
+public:
+  /// @brief counted events
+  enum Counter {
+     /// @brief processor cycles
+     CYCLES = 0,
+     /// @brief retired instructions
+     INSTRUCTIONS,
+     /// @brief last level cache misses
+     LLC_MISSES,
+     /// @brief number of counters, should be the last
+     N_COUNTERS
+  };
+
+  /// @brief cache line size used to estimate the DRAM traffic
+  static const casacore::uInt theirCacheLineSize = 64;
+
+  /// @brief the counters of this process
+  /// @details The object is created on the first call and configured from the
+  /// ASKAP_ACCESSORS_HWCOUNTERS environment variable (see configureFromEnvironment).
+  /// @return reference to the object
+  static HardwareCounters& instance();
+
+  /// @brief check whether the counters are collected
+  /// @return true if the collection is switched on
+  inline bool isEnabled() const { return itsEnabled; }
+
+  /// @brief switch the collection on or off
+  /// @details The accumulated counts are not reset, so the collection can be paused.
+  /// @param[in] collect true to collect the counters
+  void enable(bool collect = true);
+
+  /// @brief switch the collection on if requested in the parset
+  /// @details Nothing is done if the key is not defined, so the collection switched
+  /// on by one component is not switched off by another.
+  /// @param[in] parset parameters
+  /// @param[in] key name of the boolean parameter
+  void configure(const LOFAR::ParameterSet &parset, const std::string &key = "hwcounters");
+
+  /// @brief switch the collection on if requested by the environment
+  /// @details The collection is switched on if the ASKAP_ACCESSORS_HWCOUNTERS variable
+  /// is set to "true", "yes" or "1".
+  void configureFromEnvironment();
+
+  /// @brief reset all accumulated counts
+  void reset();
+
+  /// @brief read the counters of the calling thread
+  /// @details The counters are opened on the first call from the given thread. 
+  /// @param[out] values array of N_COUNTERS values to fill
+  /// @return true on success, false if the counters are not available
+  bool read(casacore::uInt64 *values);
+
+  /// @brief account for a section executed by the calling thread
+  /// @details This method is thread-safe. Sections are ignored if the collection is off.
+  /// @param[in] section name of the section
+  /// @param[in] start counters read at the start of the section (N_COUNTERS values)
+  /// @param[in] end counters read at the end of the section (N_COUNTERS values)
+  void add(const std::string &section, const casacore::uInt64 *start, const casacore::uInt64 *end);
+
+  /// @brief number of times the section has been accounted
+  /// @param[in] section name of the section
+  /// @return number of calls summed over all threads
+  casacore::uInt64 nCalls(const std::string &section) const;
+
+  /// @brief accumulated count for the section
+  /// @param[in] section name of the section
+  /// @param[in] counter event
+  /// @return count summed over all threads
+  casacore::uInt64 count(const std::string &section, Counter counter) const;
+
+  /// @brief number of threads which have reported sections
+  casacore::uInt nThreads() const;
+
+  /// @brief name of the event
+  /// @param[in] counter event
+  /// @return the name used in the log
+  static std::string counterName(Counter counter);
+
+  /// @brief write the counts into the log
+  /// @details This method is intended to be called at the end of the job together with 
+  /// IteratorStatistics::log and CalibrationStatistics::log. The counts are reported per thread
+  /// and section at the INFO level. Nothing is written if the collection has never been on.
+  void log() const;
+
+private:
+  /// @brief accumulated counts of one section
+  struct Totals {
+     /// @brief all counts are zero
+     Totals();
+     /// @brief number of calls
+     casacore::uInt64 itsCalls;
+     /// @brief counts per event
+     casacore::uInt64 itsCounts[N_COUNTERS];
+  };
+
+  /// @brief construct the object
+  /// @details The collection is switched on if requested by the environment
+  HardwareCounters();
+
+  /// @brief true if the counters are collected
+  volatile bool itsEnabled;
+
+  /// @brief true if the collection has been switched on at least once
+  bool itsUsed;
+
+  /// @brief true if the warning about unavailable counters has been given
+  bool itsWarned;
+
+  /// @brief small numbers assigned to threads
+  std::map<boost::thread::id, casacore::uInt> itsThreads;
+
+  /// @brief counts per thread number and section
+  std::map<std::pair<casacore::uInt, std::string>, Totals> itsTotals;
+
+  /// @brief mutex protecting the counts
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_HARDWARE_COUNTERS_H
@@ -0,0 +1,357 @@
+/// @file
+/// @brief A buffer manager keeping buffers in memory up to a given size
+/// @details Read-write iterator (see IDataIterator) uses the concept
+/// of buffers to store scratch data. Memory-based buffers are fast, but
+/// are unbounded and may exhaust the memory for large measurement sets, 
+/// while disk-based buffers are slow. This class keeps the recently
+/// used buffer cubes in memory up to the given number of bytes. The least
+/// recently used cubes are moved to another buffer manager (the spill store,
+/// normally FileBufferManager) by a background thread.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+
+// own includes
+#include <askap/dataaccess/HybridBufferManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+
+// std includes
+#include <algorithm>
+#include <exception>
+
+ASKAP_LOGGER(logger, ".HybridBufferManager");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief default memory limit in bytes
+const size_t HybridBufferManager::DEFAULT_MEMORY_LIMIT;
+
+/// @brief construct the object
+/// @param[in] spill buffer manager to store cubes which don't fit into memory
+/// @param[in] maxBytes maximum number of bytes to hold in memory (0 means
+/// DEFAULT_MEMORY_LIMIT)
+HybridBufferManager::HybridBufferManager(const boost::shared_ptr<IBufferManager const> &spill,
+                                         size_t maxBytes) : itsSpill(spill), 
+        itsMaxBytes(maxBytes > 0 ? maxBytes : size_t(DEFAULT_MEMORY_LIMIT)), itsCacheSize(0), 
+        itsQueueSize(0), itsHits(0), itsMisses(0), itsStop(false)
+{
+  ASKAPCHECK(itsSpill, "Spill store is required for HybridBufferManager");
+  itsThread.reset(new boost::thread(&HybridBufferManager::run, this));
+  MemoryGovernor::instance().add(this, "buffer cubes", MemoryGovernor::LOW_PRIORITY);
+}
+
+/// @brief destructor, stops the background thread
+/// @details Queued cubes are written to the spill store first, errors are logged
+HybridBufferManager::~HybridBufferManager()
+{
+  MemoryGovernor::instance().remove(this);
+  {
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    itsStop = true;
+  }
+  itsCondition.notify_all();
+  itsThread->join();
+  if (itsError.size()) {
+      ASKAPLOG_ERROR_STR(logger, "Spilling of the buffers to disk failed: "<<itsError);
+  }
+  ASKAPLOG_DEBUG_STR(logger, "Buffer reads served from memory: "<<itsHits<<
+                     ", from the spill store: "<<itsMisses);
+}
+
+/// @brief size of the cube in bytes
+/// @param[in] cube the cube
+/// @return size of the data
+size_t HybridBufferManager::cubeSize(const casacore::Cube<casacore::Complex> &cube)
+{
+  return cube.nelements() * sizeof(casacore::Complex);
+}
+
+/// @brief throw an exception if the background thread has failed
+/// @details This method should be called with the lock held.
+void HybridBufferManager::checkError() const
+{
+  if (itsError.size()) {
+      const std::string msg = itsError;
+      itsError.clear();
+      ASKAPTHROW(DataAccessError, "Spilling of the buffers to disk failed: "<<msg);
+  }
+}
+
+/// @brief find the cube in memory
+/// @details Both the cache and the spill queue are searched, the found cube is 
+/// made the most recently used one. This method should be called with the lock held.
+/// @param[in] key buffer name and index
+/// @param[out] cube cube to reference the data
+/// @return true if the cube has been found
+bool HybridBufferManager::findInMemory(const BufferKey &key, 
+                                       casacore::Cube<casacore::Complex> &cube) const
+{
+  const std::map<BufferKey, CachedCube>::iterator it = itsCache.find(key);
+  if (it != itsCache.end()) {
+      itsLRU.splice(itsLRU.begin(), itsLRU, it->second.itsLRUPosition);
+      cube.reference(it->second.itsData);
+      return true;
+  }
+  // the latest version of the cube is at the end of the queue
+  for (std::deque<std::pair<BufferKey, casacore::Cube<casacore::Complex> > >::reverse_iterator
+       qIt = itsSpillQueue.rbegin(); qIt != itsSpillQueue.rend(); ++qIt) {
+       if (qIt->first == key) {
+           cube.reference(qIt->second);
+           insert(key, cube);
+           return true;
+       }
+  }
+  return false;
+}
+
+/// @brief add a cube to the cache
+/// @details The cube is referenced, the previous version (if any) is
+/// replaced. This method should be called with the lock held.
+/// @param[in] key buffer name and index
+/// @param[in] cube cube to store
+void HybridBufferManager::insert(const BufferKey &key, 
+                                 const casacore::Cube<casacore::Complex> &cube) const
+{
+  const std::map<BufferKey, CachedCube>::iterator it = itsCache.find(key);
+  if (it != itsCache.end()) {
+      ASKAPDEBUGASSERT(itsCacheSize >= cubeSize(it->second.itsData));
+      itsCacheSize -= cubeSize(it->second.itsData);
+      itsLRU.erase(it->second.itsLRUPosition);
+      itsCache.erase(it);
+  }
+  CachedCube &cached = itsCache[key];
+  cached.itsData.reference(cube);
+  itsLRU.push_front(key);
+  cached.itsLRUPosition = itsLRU.begin();
+  itsCacheSize += cubeSize(cube);
+}
+
+/// @brief queue least recently used cubes for spilling until the cache fits the limit
+/// @details This method should be called with the lock held.
+/// @param[in] lock the lock held by the caller, used to wait for the background thread
+void HybridBufferManager::evict(boost::unique_lock<boost::mutex> &lock) const
+{
+  if (itsCacheSize > itsMaxBytes) {
+      queueForSpilling(itsCacheSize - itsMaxBytes);
+  }
+  // limit the memory taken by the queue, if the background thread lags behind
+  while ((itsQueueSize > itsMaxBytes) && (itsError.size() == 0)) {
+     itsCondition.wait(lock);
+  }
+}
+
+/// @brief move least recently used cubes from the cache to the spill queue
+/// @details This method should be called with the lock held.
+/// @param[in] nBytes number of bytes to move (at least)
+/// @return number of bytes moved
+size_t HybridBufferManager::queueForSpilling(size_t nBytes) const
+{
+  size_t queued = 0;
+  while ((queued < nBytes) && (itsLRU.size() > 0)) {
+     const std::map<BufferKey, CachedCube>::iterator it = itsCache.find(itsLRU.back());
+     ASKAPDEBUGASSERT(it != itsCache.end());
+     const size_t size = cubeSize(it->second.itsData);
+     itsSpillQueue.push_back(std::make_pair(it->first, it->second.itsData));
+     itsQueueSize += size;
+     itsCacheSize -= size;
+     itsLRU.pop_back();
+     itsCache.erase(it);
+     queued += size;
+  }
+  if (queued > 0) {
+      itsCondition.notify_all();
+  }
+  return queued;
+}
+
+/// @brief body of the background thread
+void HybridBufferManager::run()
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  while (true) {
+     while (!itsStop && itsSpillQueue.empty()) {
+        itsCondition.wait(lock);
+     }
+     if (itsSpillQueue.empty()) {
+         // stop was requested and all cubes are written
+         break;
+     }
+     // the cube stays in the queue (and is served from there) until it is written
+     const BufferKey key = itsSpillQueue.front().first;
+     casacore::Cube<casacore::Complex> cube;
+     cube.reference(itsSpillQueue.front().second);
+     lock.unlock();
+     std::string error;
+     try {
+        itsSpill->writeBuffer(cube, key.first, key.second);
+     }
+     catch (const std::exception &ex) {
+        error = ex.what();
+     }
+     lock.lock();
+     if (error.size() && (itsError.size() == 0)) {
+         itsError = error;
+     }
+     ASKAPDEBUGASSERT(itsQueueSize >= cubeSize(cube));
+     itsQueueSize -= cubeSize(cube);
+     itsSpillQueue.pop_front();
+     itsCondition.notify_all();
+  }
+}
+
+/// @brief populate the cube with the data stored in the given buffer
+/// @details The method throws an exception if the requested buffer
+/// does not exist (prevents a shape mismatch)
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+void HybridBufferManager::readBuffer(casacore::Cube<casacore::Complex> &vis,
+                                     const std::string &name, casacore::uInt index) const
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  checkError();
+  const BufferKey key(name, index);
+  casacore::Cube<casacore::Complex> cube;
+  if (findInMemory(key, cube)) {
+      ++itsHits;
+  } else {
+      ++itsMisses;
+      // the key is neither cached nor queued, so the spill store has the latest version
+      itsSpill->readBuffer(cube, name, index);
+      if (cubeSize(cube) <= itsMaxBytes) {
+          insert(key, cube);
+      }
+  }
+  // the cached cube is shared, give out a copy
+  vis.resize(cube.shape());
+  vis = cube;
+  evict(lock);
+  lock.unlock();
+  MemoryGovernor::instance().enforce();
+}
+
+/// @brief write the cube back to the given buffer
+/// @details This buffer is created on the first write operation
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+void HybridBufferManager::writeBuffer(const casacore::Cube<casacore::Complex> &vis,
+                                      const std::string &name, casacore::uInt index) const
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  checkError();
+  const BufferKey key(name, index);
+  // the cube given may be changed by the caller, store a copy
+  insert(key, vis.copy());
+  evict(lock);
+  lock.unlock();
+  MemoryGovernor::instance().enforce();
+}
+
+/// @brief check whether the particular buffer exists
+/// @param[in] name a name of the buffer to query
+/// @param[in] index a sequential index in the buffer
+/// @return true, if the buffer with the given name is present
+bool HybridBufferManager::bufferExists(const std::string &name, casacore::uInt index) const
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  checkError();
+  const BufferKey key(name, index);
+  if (itsCache.find(key) != itsCache.end()) {
+      return true;
+  }
+  for (std::deque<std::pair<BufferKey, casacore::Cube<casacore::Complex> > >::const_iterator
+       qIt = itsSpillQueue.begin(); qIt != itsSpillQueue.end(); ++qIt) {
+       if (qIt->first == key) {
+           return true;
+       }
+  }
+  return itsSpill->bufferExists(name, index);
+}
+
+/// @brief number of reads served from memory
+/// @return number of readBuffer calls which didn't need the spill store
+size_t HybridBufferManager::nHits() const
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  return itsHits;
+}
+
+/// @brief number of reads served from the spill store
+/// @return number of readBuffer calls which had to read the spill store
+size_t HybridBufferManager::nMisses() const
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  return itsMisses;
+}
+
+/// @brief memory currently used by the buffers
+/// @return number of bytes held in memory, including the cubes queued for spilling
+size_t HybridBufferManager::memoryUsed() const
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  return itsCacheSize + itsQueueSize;
+}
+
+/// @brief memory currently held
+/// @details This is the same as memoryUsed, it is reported to MemoryGovernor
+/// @return number of bytes held in memory, including the cubes queued for spilling
+size_t HybridBufferManager::memoryUsage() const
+{
+  return memoryUsed();
+}
+
+/// @brief spill least recently used cubes
+/// @details This method is called by MemoryGovernor if the global budget is exceeded.
+/// The cubes are queued for spilling and the memory is freed when the background thread
+/// has written them. Cubes queued already are counted as being released.
+/// @param[in] nBytes number of bytes to release
+/// @return number of bytes queued for spilling
+size_t HybridBufferManager::releaseMemory(size_t nBytes)
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  // the queue is being written, don't spill more cubes than necessary
+  const size_t pending = std::min(itsQueueSize, nBytes);
+  return pending + queueForSpilling(nBytes - pending);
+}
+
+/// @brief wait until all queued cubes are written to the spill store
+void HybridBufferManager::flush() const
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  while (!itsSpillQueue.empty()) {
+     itsCondition.wait(lock);
+  }
+  checkError();
+}
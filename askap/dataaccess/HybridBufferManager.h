@@ -0,0 +1,251 @@
+/// @file
+/// @brief A buffer manager keeping buffers in memory up to a given size
+/// @details Read-write iterator (see IDataIterator) uses the concept
+/// of buffers to store scratch data. Memory-based buffers are fast, but
+/// are unbounded and may exhaust the memory for large measurement sets, 
+/// while disk-based buffers are slow. This class keeps the recently
+/// used buffer cubes in memory up to the given number of bytes. The least
+/// recently used cubes are moved to another buffer manager (the spill store,
+/// normally FileBufferManager) by a background thread.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_HYBRID_BUFFER_MANAGER_H
+#define ASKAP_ACCESSORS_HYBRID_BUFFER_MANAGER_H
+
+// std includes
+#include <string>
+#include <map>
+#include <list>
+#include <deque>
+#include <utility>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// own includes
+#include <askap/dataaccess/IBufferManager.h>
+#include <askap/dataaccess/IMemoryConsumer.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief A buffer manager keeping buffers in memory up to a given size
+/// @details Cubes are held in memory as long as the total size doesn't exceed
+/// the limit. When it does, the least recently used cubes are queued for writing
+/// to the spill store and are written there by a background thread. The queued 
+/// cubes are still served from memory. If the queue itself grows beyond the limit,
+/// writing blocks until the background thread catches up, so the memory used never
+/// exceeds twice the limit. A cube read from the spill store is brought back
+/// into memory. Errors encountered by the background thread are reported by the
+/// next call to any method of this class. All methods can be called from several
+/// threads, the spill store should be thread-safe. The manager is registered with 
+/// MemoryGovernor and spills cubes early if the global memory budget is exceeded.
+/// @ingroup dataaccess_tab
+class HybridBufferManager : virtual public IBufferManager,
+                            virtual public IMemoryConsumer,
+                            private boost::noncopyable
+{
+public:
+  /// @brief default memory limit in bytes
+  static const size_t DEFAULT_MEMORY_LIMIT = 1024u * 1024u * 1024u;
+
+  /// @brief construct the object
+  /// @param[in] spill buffer manager to store cubes which don't fit into memory
+  /// @param[in] maxBytes maximum number of bytes to hold in memory (0 means
+  /// DEFAULT_MEMORY_LIMIT)
+  explicit HybridBufferManager(const boost::shared_ptr<IBufferManager const> &spill,
+                               size_t maxBytes = DEFAULT_MEMORY_LIMIT);
+
+  /// @brief destructor, stops the background thread
+  /// @details Queued cubes are written to the spill store first, errors are logged
+  virtual ~HybridBufferManager();
+  
+  /// @brief populate the cube with the data stored in the given buffer
+  /// @details The method throws an exception if the requested buffer
+  /// does not exist (prevents a shape mismatch)
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  virtual void readBuffer(casacore::Cube<casacore::Complex> &vis,
+                          const std::string &name,
+                          casacore::uInt index) const;
+  
+  /// @brief write the cube back to the given buffer
+  /// @details This buffer is created on the first write operation
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  virtual void writeBuffer(const casacore::Cube<casacore::Complex> &vis,
+                           const std::string &name,
+                           casacore::uInt index) const;
+
+  /// @brief check whether the particular buffer exists
+  /// @param[in] name a name of the buffer to query
+  /// @param[in] index a sequential index in the buffer
+  /// @return true, if the buffer with the given name is present
+  virtual bool bufferExists(const std::string &name,
+                            casacore::uInt index) const;
+
+  /// @brief number of reads served from memory
+  /// @return number of readBuffer calls which didn't need the spill store
+  size_t nHits() const;
+
+  /// @brief number of reads served from the spill store
+  /// @return number of readBuffer calls which had to read the spill store
+  size_t nMisses() const;
+
+  /// @brief memory currently used by the buffers
+  /// @return number of bytes held in memory, including the cubes queued for spilling
+  size_t memoryUsed() const;
+
+  /// @brief memory currently held
+  /// @details This is the same as memoryUsed, it is reported to MemoryGovernor
+  /// @return number of bytes held in memory, including the cubes queued for spilling
+  virtual size_t memoryUsage() const;
+
+  /// @brief spill least recently used cubes
+  /// @details This method is called by MemoryGovernor if the global budget is exceeded.
+  /// The cubes are queued for spilling and the memory is freed when the background thread
+  /// has written them. Cubes queued already are counted as being released.
+  /// @param[in] nBytes number of bytes to release
+  /// @return number of bytes queued for spilling
+  virtual size_t releaseMemory(size_t nBytes);
+
+  /// @brief wait until all queued cubes are written to the spill store
+  void flush() const;
+
+protected:
+  /// @brief buffer name and index
+  typedef std::pair<std::string, casacore::uInt> BufferKey;
+
+  /// @brief cube held in memory
+  struct CachedCube {
+     /// @brief the data (not modified after insertion, writes replace the cube)
+     casacore::Cube<casacore::Complex> itsData;
+     /// @brief position in the LRU list
+     std::list<BufferKey>::iterator itsLRUPosition;
+  };
+
+  /// @brief size of the cube in bytes
+  /// @param[in] cube the cube
+  /// @return size of the data
+  static size_t cubeSize(const casacore::Cube<casacore::Complex> &cube);
+
+  /// @brief find the cube in memory
+  /// @details Both the cache and the spill queue are searched, the found cube is 
+  /// made the most recently used one. This method should be called with the lock held.
+  /// @param[in] key buffer name and index
+  /// @param[out] cube cube to reference the data
+  /// @return true if the cube has been found
+  bool findInMemory(const BufferKey &key, casacore::Cube<casacore::Complex> &cube) const;
+
+  /// @brief add a cube to the cache
+  /// @details The cube is referenced, the previous version (if any) is
+  /// replaced. This method should be called with the lock held.
+  /// @param[in] key buffer name and index
+  /// @param[in] cube cube to store
+  void insert(const BufferKey &key, const casacore::Cube<casacore::Complex> &cube) const;
+
+  /// @brief queue least recently used cubes for spilling until the cache fits the limit
+  /// @details This method should be called with the lock held.
+  /// @param[in] lock the lock held by the caller, used to wait for the background thread
+  void evict(boost::unique_lock<boost::mutex> &lock) const;
+
+  /// @brief move least recently used cubes from the cache to the spill queue
+  /// @details This method should be called with the lock held.
+  /// @param[in] nBytes number of bytes to move (at least)
+  /// @return number of bytes moved
+  size_t queueForSpilling(size_t nBytes) const;
+
+  /// @brief throw an exception if the background thread has failed
+  /// @details This method should be called with the lock held.
+  void checkError() const;
+
+  /// @brief body of the background thread
+  void run();
+
+private:
+  /// @brief spill store
+  boost::shared_ptr<IBufferManager const> itsSpill;
+
+  /// @brief maximum number of bytes held in the cache
+  size_t itsMaxBytes;
+
+  /// @brief cubes held in memory
+  mutable std::map<BufferKey, CachedCube> itsCache;
+
+  /// @brief keys of the cached cubes, the most recently used first
+  mutable std::list<BufferKey> itsLRU;
+
+  /// @brief number of bytes in the cache
+  mutable size_t itsCacheSize;
+
+  /// @brief cubes waiting to be written to the spill store, the oldest first
+  mutable std::deque<std::pair<BufferKey, casacore::Cube<casacore::Complex> > > itsSpillQueue;
+
+  /// @brief number of bytes in the spill queue
+  mutable size_t itsQueueSize;
+
+  /// @brief number of reads served from memory
+  mutable size_t itsHits;
+
+  /// @brief number of reads served from the spill store
+  mutable size_t itsMisses;
+
+  /// @brief error message of the background thread, empty if there was no error
+  mutable std::string itsError;
+
+  /// @brief true if the background thread should finish
+  bool itsStop;
+
+  /// @brief mutex protecting all the data above
+  mutable boost::mutex itsMutex;
+
+  /// @brief condition signalling changes of the spill queue
+  mutable boost::condition_variable itsCondition;
+
+  /// @brief background thread writing cubes to the spill store
+  boost::shared_ptr<boost::thread> itsThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_HYBRID_BUFFER_MANAGER_H
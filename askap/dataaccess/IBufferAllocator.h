@@ -0,0 +1,75 @@
+/// @file
+/// @brief An interface to a custom allocator of the accessor buffers
+/// @details Visibility, flag and noise cubes are filled by the table-based
+/// iterator into reusable storage blocks (see ReusableBuffer). By default,
+/// these blocks are ordinary casacore arrays. An allocator implementing this
+/// interface can be given to the data source to take the blocks from special
+/// memory instead, e.g. page-locked host memory which can be copied to a GPU
+/// by DMA, or memory local to a particular NUMA node. The data are then filled
+/// straight into this memory and no extra copy is needed by the consumer.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_I_BUFFER_ALLOCATOR_H
+#define ASKAP_ACCESSORS_I_BUFFER_ALLOCATOR_H
+
+// std includes
+#include <cstddef>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to a custom allocator of the accessor buffers
+/// @details The allocator deals with raw memory, elements are constructed and
+/// destroyed by the buffer. The returned memory should be suitably aligned for
+/// any element type (i.e. as for malloc). Blocks are only requested when a buffer
+/// grows, which is rare as the storage is reused between chunks, so the allocation
+/// itself can be expensive (e.g. cudaHostAlloc). Methods can be called from different
+/// threads, if iterators sharing the allocator are used in parallel.
+/// @ingroup dataaccess_hlp
+struct IBufferAllocator {
+
+  /// void virtual destructor to keep the compiler happy
+  virtual ~IBufferAllocator();
+
+  /// @brief allocate a block of memory
+  /// @details An exception should be thrown if the memory can't be allocated.
+  /// @param[in] nBytes size of the block in bytes (always positive)
+  /// @return pointer to the block
+  virtual void* allocate(size_t nBytes) = 0;
+
+  /// @brief return the block of memory
+  /// @param[in] ptr pointer to the block obtained from allocate
+  /// @param[in] nBytes size of the block in bytes (as passed to allocate)
+  virtual void deallocate(void *ptr, size_t nBytes) = 0;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_BUFFER_ALLOCATOR_H
@@ -0,0 +1,67 @@
+/// @file
+/// @brief interface to a transport delivering serialised chunks of data
+/// @details Streaming data sources receive chunks of visibility data which were
+/// serialised with CachedDataAccessor::serialise. This interface hides the actual
+/// transport (socket, shared memory, etc).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_I_CHUNK_RECEIVER_H
+#define ASKAP_ACCESSORS_I_CHUNK_RECEIVER_H
+
+// own includes
+#include <askap/dataaccess/IHolder.h>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief interface to a transport delivering serialised chunks of data
+/// @details Each message is one chunk serialised with CachedDataAccessor::serialise.
+/// The receive method is called from the background thread of the streaming data
+/// source, interrupt may be called from another thread to unblock it.
+/// @ingroup dataaccess_i
+struct IChunkReceiver : virtual public IHolder {
+
+  /// @brief receive the next message
+  /// @details This method blocks until a message is available or the stream ends.
+  /// @param[out] buf buffer to fill with the message
+  /// @return true if a message has been received, false at the end of the stream
+  virtual bool receive(LOFAR::BlobString &buf) = 0;
+
+  /// @brief unblock the receiving thread
+  /// @details After this call, receive should return false (or throw) as soon as possible.
+  /// This method is called from a thread different from the one calling receive.
+  virtual void interrupt() = 0;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_CHUNK_RECEIVER_H
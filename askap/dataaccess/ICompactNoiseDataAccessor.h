@@ -0,0 +1,88 @@
+/// @file ICompactNoiseDataAccessor.h
+/// @brief An interface to the compact representation of noise figures
+/// @details ICompactNoiseDataAccessor is an additional interface class
+///        to access noise figures without creating the full
+///        nRow x nChannel x nPol cube in the typical cases where the noise is
+///        the same for all spectral channels. The user should dynamic 
+///        cast to this interface from the reference or pointer returned by
+///        IConstDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_COMPACT_NOISE_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_COMPACT_NOISE_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <casacore/casa/Arrays/Matrix.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to the compact representation of noise figures
+/// @details The noise cube returned by IConstDataAccessor::noise() is
+/// nRow x nChannel x nPol. Often the noise doesn't depend on the spectral channel
+/// (i.e. it is given by the SIGMA column of the measurement set) or is not defined
+/// at all (and the default value is used for all elements). This interface allows
+/// to find out which representation is appropriate for the current chunk and to
+/// access the noise figures without creating the full cube. The full cube is only 
+/// created if the noise() method is called.
+/// @ingroup dataaccess_i
+class ICompactNoiseDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief type of the noise representation
+        enum NoiseRepresentation {
+            /// @brief the same noise for all rows, channels and polarisations, see constantNoise
+            CONSTANT_NOISE = 0,
+            /// @brief noise depends on row and polarisation only, see rowPolNoise
+            ROW_POL_NOISE,
+            /// @brief noise depends on the spectral channel, use noise()
+            SPECTRAL_NOISE
+        };
+
+        /// @brief obtain the type of the noise representation
+        /// @return representation appropriate for the current chunk
+        virtual NoiseRepresentation noiseRepresentation() const = 0;
+
+        /// @brief noise value for the constant noise case
+        /// @details This method is only valid if noiseRepresentation returns 
+        /// CONSTANT_NOISE. An exception is thrown otherwise.
+        /// @return complex noise estimate used for all elements
+        virtual casacore::Complex constantNoise() const = 0;
+
+        /// @brief noise figures for each row and polarisation
+        /// @details This method is valid if noiseRepresentation returns either 
+        /// CONSTANT_NOISE or ROW_POL_NOISE. An exception is thrown otherwise.
+        /// @return a reference to nRow x nPol matrix with complex noise estimates, valid
+        /// for all spectral channels
+        virtual const casacore::Matrix<casacore::Complex>& rowPolNoise() const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_COMPACT_NOISE_DATA_ACCESSOR_H
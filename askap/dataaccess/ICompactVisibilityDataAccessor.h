@@ -0,0 +1,65 @@
+/// @file ICompactVisibilityDataAccessor.h
+/// @brief An interface to the reduced precision visibilities
+/// @details ICompactVisibilityDataAccessor is an additional interface class
+///        to access visibilities with 16-bit real and imaginary parts (see 
+///        CompactVisibilityCube), alongside the Cube<Complex> returned by 
+///        IConstDataAccessor::visibility(). The user should dynamic 
+///        cast to this interface from the reference or pointer returned by
+///        IConstDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_COMPACT_VISIBILITY_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_COMPACT_VISIBILITY_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/CompactVisibilityCube.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to the reduced precision visibilities
+/// @details The visibility cube returned by IConstDataAccessor::visibility() uses 
+/// eight bytes per element. This interface provides the same information with four 
+/// bytes per element in the storage order, which halves the memory and transfer volume
+/// for consumers which don't need the full precision (e.g. model prediction and residual
+/// gridding on GPUs). The format is chosen by the data source.
+/// @note The compact visibilities reflect the data as read from the table. Modifications
+/// done via the read-write interface are not propagated to this representation.
+/// @ingroup dataaccess_i
+class ICompactVisibilityDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief reduced precision visibilities
+        /// @return a reference to the compact form of the nRow x nChannel x nPol cube
+        virtual const CompactVisibilityCube& compactVisibility() const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_COMPACT_VISIBILITY_DATA_ACCESSOR_H
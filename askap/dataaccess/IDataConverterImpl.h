@@ -41,6 +41,7 @@
 #include <casacore/measures/Measures/MDirection.h>
 #include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/measures/Measures/MRadialVelocity.h>
+#include <casacore/casa/Arrays/Vector.h>
 
 // own includes
 #include <askap/dataaccess/IDataConverter.h>
@@ -73,23 +74,64 @@ public:
     /// @return epoch converted to Measure
     virtual casacore::MEpoch epochMeasure(const casacore::MVEpoch &in) const = 0;
 
+    /// @brief convert a number of epochs given in the same frame
+    /// @param[in] ref reference frame of the input values
+    /// @param[in] unit units of the input values
+    /// @param[in] in epochs to convert given as Doubles (w.r.t. MJD 0)
+    /// @param[out] out converted epochs (resized as required)
+    virtual void epochs(const casacore::MEpoch::Ref &ref, const casacore::Unit &unit,
+                        const casacore::Vector<casacore::Double> &in,
+                        casacore::Vector<casacore::Double> &out) const = 0;
+
     /// convert directions
     /// @param[in] in input direction given as an MDirection object
     /// @param out output direction as an MVDirection object
     virtual void direction(const casacore::MDirection &in,
                            casacore::MVDirection &out) const = 0;
 
+    /// @brief convert a number of directions given in the same frame
+    /// @details The conversion machinery is set up once for all directions,
+    /// so this method is preferable to a loop over direction calls.
+    /// @param[in] ref reference frame of the input directions
+    /// @param[in] in input directions
+    /// @param[out] out output directions (resized as required)
+    virtual void directions(const casacore::MDirection::Ref &ref,
+                           const casacore::Vector<casacore::MVDirection> &in,
+                           casacore::Vector<casacore::MVDirection> &out) const = 0;
+
+    /// @brief test whether the direction conversion depends on the observatory position
+    /// @details Conversions to topocentric frames (e.g. AZEL or HADEC) depend on the
+    /// position set via setMeasFrame, others depend only on time. This allows the
+    /// caller to skip setting up the frame for each antenna if it is not required.
+    /// @return true, if the result of direction depends on the position
+    virtual bool directionNeedsPosition() const = 0;
+
     /// test whether the frequency conversion is void
     /// @param[in] testRef reference frame to test
     /// @param[in] testUnit units to test
     virtual bool isVoid(const casacore::MFrequency::Ref &testRef,
                         const casacore::Unit &testUnit) const = 0;
 
+    /// @brief units of the output frequencies
+    /// @return units set via setFrequencyFrame
+    virtual const casacore::Unit& frequencyUnit() const = 0;
+
     /// convert frequencies
     /// @param[in] in input frequency given as an MFrequency object
     /// @return output frequency as a Double
     virtual casacore::Double frequency(const casacore::MFrequency &in) const = 0;
 
+    /// @brief convert a number of frequencies given in the same frame
+    /// @details This method is equivalent to calling frequency for each element,
+    /// but is expected to be much faster for long vectors (e.g. the whole spectral axis).
+    /// @param[in] ref reference frame of the input frequencies
+    /// @param[in] unit units of the input frequencies
+    /// @param[in] in input frequencies
+    /// @param[out] out output frequencies as Doubles (resized to match the input)
+    virtual void frequencies(const casacore::MFrequency::Ref &ref, const casacore::Unit &unit,
+                             const casacore::Vector<casacore::Double> &in,
+                             casacore::Vector<casacore::Double> &out) const = 0;
+
     /// convert velocities
     /// @param[in] in input velocities given as an MRadialVelocity object
     /// @return output velocity as a Double
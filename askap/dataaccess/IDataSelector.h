@@ -152,7 +152,9 @@ public:
 
     /// Choose polarization. 
     /// @param pols a string describing the wanted polarization 
-    /// in the output. Allowed values are: I, "IQUV","XXYY","RRLL"
+    /// in the output. Products are given either as a comma-separated list
+    /// (e.g. "I,Q,U,V" or "XX,YY") or in the compact form without separators,
+    /// e.g. "I", "IQUV","XXYY","RRLL"
     virtual void choosePolarizations(const casacore::String &pols) = 0;
 
     /// Choose cycles. This is an equivalent of choosing the time range,
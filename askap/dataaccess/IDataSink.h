@@ -0,0 +1,64 @@
+/// @file
+/// @brief interface to a destination of visibility data
+/// @details Data sinks take chunks of visibility data, e.g. delivered by an iterator
+/// after averaging or received from a stream, and store them. Unlike read-write
+/// iterators, which modify existing rows, a sink creates new data.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_I_DATA_SINK_H
+#define ASKAP_ACCESSORS_I_DATA_SINK_H
+
+// own includes
+#include <askap/dataaccess/IHolder.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief interface to a destination of visibility data
+/// @details Chunks are appended in the order of write calls. Implementations may
+/// copy the data and store them later, the accessor can be changed (e.g. the
+/// iterator can be advanced) as soon as write returns.
+/// @ingroup dataaccess_i
+struct IDataSink : virtual public IHolder {
+
+  /// @brief append a chunk
+  /// @param[in] acc accessor with the data of the chunk
+  virtual void write(const IConstDataAccessor &acc) = 0;
+
+  /// @brief store all chunks written so far
+  /// @details This is the barrier: the data are stored when the method returns.
+  /// An exception is thrown if any write has failed.
+  virtual void flush() = 0;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_DATA_SINK_H
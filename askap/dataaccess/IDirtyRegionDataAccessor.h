@@ -0,0 +1,70 @@
+/// @file IDirtyRegionDataAccessor.h
+/// @brief An interface to declare the modified part of the visibility cube
+/// @details IDirtyRegionDataAccessor is an additional interface class
+///        for writable accessors. The caller of rwVisibility can declare which
+///        rows and channels have actually been changed, so only this part is 
+///        written back. The user should dynamic cast to this interface from the
+///        reference or pointer returned by IDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_I_DIRTY_REGION_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_DIRTY_REGION_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IDataAccessor.h>
+#include <askap/dataaccess/DirtyRegion.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to declare the modified part of the visibility cube
+/// @details The declaration is optional. If no region is declared, the whole cube 
+/// returned by rwVisibility is assumed to be modified. Declared regions accumulate
+/// until the changes are written back or the accessor moves to the next chunk.
+/// The region can be declared either before or after the call to rwVisibility.
+/// @ingroup dataaccess_i
+class IDirtyRegionDataAccessor : virtual public IDataAccessor
+{
+public:
+        /// @brief declare a part of the visibility cube as modified
+        /// @param[in] startRow first modified row
+        /// @param[in] nRow number of modified rows
+        /// @param[in] startChan first modified channel
+        /// @param[in] nChan number of modified channels
+        virtual void markVisibilityDirty(casacore::uInt startRow, casacore::uInt nRow,
+                         casacore::uInt startChan, casacore::uInt nChan) = 0;
+
+        /// @brief part of the visibility cube declared as modified
+        /// @return a reference to the region (empty if nothing has been declared)
+        virtual const DirtyRegion& visibilityDirtyRegion() const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_DIRTY_REGION_DATA_ACCESSOR_H
@@ -36,6 +36,8 @@
 // CASA includes
 #include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Quanta/Unit.h>
 
 // own includes
 #include <askap/dataaccess/IConverterBase.h>
@@ -68,6 +70,17 @@ struct IEpochConverter : virtual public IConverterBase {
     /// @return the same epoch as a fully qualified measure
     virtual casacore::MEpoch toMeasure(const casacore::MVEpoch &in) const throw() = 0;
 
+    /// @brief convert a number of epochs given in the same frame
+    /// @details This is a batch version of operator(). The conversion machinery
+    /// is set up once for all elements of the input vector.
+    /// @param[in] in epochs to convert given as Doubles (w.r.t. MJD 0)
+    /// @param[in] unit units of the input values
+    /// @param[in] ref reference frame of the input values
+    /// @param[out] out converted epochs in the target units/frame (resized as required)
+    virtual void convert(const casacore::Vector<casacore::Double> &in,
+                         const casacore::Unit &unit, const casacore::MEpoch::Ref &ref,
+                         casacore::Vector<casacore::Double> &out) const = 0;
+
     /// using statement to make this method public in all derived classes
     using IConverterBase::setMeasFrame;
 };
@@ -0,0 +1,67 @@
+/// @file IFacetUVWDataAccessor.h
+/// @brief An interface to uvw rotated to many tangent points at once
+/// @details IFacetUVWDataAccessor is an additional interface class
+///        which rotates uvw for a list of tangent points (facets) in one pass
+///        over the rows and caches the result for the whole chunk. The user 
+///        should dynamic cast to this interface from the reference or pointer 
+///        returned by IConstDataIterator interface or use facetRotatedUVW helper.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_FACET_UVW_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_FACET_UVW_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/FacetRotatedUVW.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to uvw rotated to many tangent points at once
+/// @details Faceted imaging needs rotatedUVW and uvwRotationDelay for each facet. Calling
+/// these methods for one tangent point after another invalidates the single-result cache
+/// of the accessor every time. This interface returns the rotated uvws and delays for all
+/// tangent points at once. The result is computed in one pass over the rows and is kept
+/// until the iterator moves to the next chunk or a different list of tangent points is given.
+/// @ingroup dataaccess_i
+class IFacetUVWDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief uvw rotated to a number of tangent points
+        /// @param[in] tangentPoints tangent points of all facets (J2000)
+        /// @return a reference to the rotated uvws and delays for each facet and row
+        virtual const FacetRotatedUVW& facetRotatedUVW(
+                 const std::vector<casacore::MDirection> &tangentPoints) const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_FACET_UVW_DATA_ACCESSOR_H
@@ -0,0 +1,63 @@
+/// @file IFlaggedRowDataAccessor.h
+/// @brief An interface to the map of rows which are not flagged as a whole
+/// @details IFlaggedRowDataAccessor is an additional interface class
+///        which gives the indices of rows containing unflagged data, so the 
+///        rows flagged via FLAG_ROW can be skipped by the consumer without 
+///        examining the flag cube. The user should dynamic cast to this interface 
+///        from the reference or pointer returned by IConstDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_FLAGGED_ROW_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_FLAGGED_ROW_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to the map of rows which are not flagged as a whole
+/// @details Rows with FLAG_ROW set carry no useful data. The row index map 
+/// lists the remaining rows of the chunk in the ascending order, i.e. the i-th
+/// element is the accessor row corresponding to the i-th row with data. All other
+/// quantities returned by the accessor are still indexed by the accessor row.
+/// If the data source is configured to skip flagged rows (see
+/// TableConstDataSource::configureSkipFlaggedRows), visibilities of the rows
+/// missing in this map are not read from disk and are set to zero.
+/// @ingroup dataaccess_i
+class IFlaggedRowDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief rows which are not flagged as a whole
+        /// @return a reference to the vector with accessor rows which contain data
+        virtual const casacore::Vector<casacore::uInt>& unflaggedRows() const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_FLAGGED_ROW_DATA_ACCESSOR_H
@@ -0,0 +1,55 @@
+/// @file
+/// @brief An interface to a cache registered with the memory governor
+/// @details Caches of the accessors package (buffers, uvw machines, calibration
+/// solutions) grow independently of each other. Those implementing this interface
+/// can be registered with MemoryGovernor, which reports their usage and asks them
+/// to release memory when the total exceeds the global budget.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/IMemoryConsumer.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// void virtual destructor to keep the compiler happy
+IMemoryConsumer::~IMemoryConsumer()
+{
+}
+
+/// @brief release some memory
+/// @details Entries can be dropped (if they can be obtained again) or spilled to
+/// disk. The method may release less or more than requested.
+/// @return number of bytes released (zero by default)
+size_t IMemoryConsumer::releaseMemory(size_t)
+{
+  return 0;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,71 @@
+/// @file
+/// @brief An interface to a cache registered with the memory governor
+/// @details Caches of the accessors package (buffers, uvw machines, calibration
+/// solutions) grow independently of each other. Those implementing this interface
+/// can be registered with MemoryGovernor, which reports their usage and asks them
+/// to release memory when the total exceeds the global budget.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_I_MEMORY_CONSUMER_H
+#define ASKAP_ACCESSORS_I_MEMORY_CONSUMER_H
+
+// std includes
+#include <cstddef>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to a cache registered with the memory governor
+/// @details The governor calls these methods from whatever thread checks the budget,
+/// so implementations should be thread-safe. They must not call the governor while
+/// holding their own locks, otherwise the threads may deadlock. The default
+/// implementation of releaseMemory does nothing, i.e. the usage is only reported.
+/// @ingroup dataaccess_hlp
+struct IMemoryConsumer {
+
+  /// void virtual destructor to keep the compiler happy
+  virtual ~IMemoryConsumer();
+
+  /// @brief memory currently held
+  /// @details An estimate is sufficient, it is used to compare against the budget.
+  /// @return number of bytes
+  virtual size_t memoryUsage() const = 0;
+
+  /// @brief release some memory
+  /// @details Entries can be dropped (if they can be obtained again) or spilled to
+  /// disk. The method may release less or more than requested.
+  /// @param[in] nBytes number of bytes the governor would like to be released
+  /// @return number of bytes released (zero by default)
+  virtual size_t releaseMemory(size_t nBytes);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_MEMORY_CONSUMER_H
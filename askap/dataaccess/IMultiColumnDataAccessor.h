@@ -0,0 +1,69 @@
+/// @file IMultiColumnDataAccessor.h
+/// @brief An interface to visibilities of several data columns of the same chunk
+/// @details IMultiColumnDataAccessor is an additional interface class
+///        which gives the visibilities stored in additional data columns 
+///        (e.g. MODEL_DATA along with DATA) for the same rows and channels
+///        as the main visibility cube, without a second iterator or a buffer.
+///        The user should dynamic cast to this interface from the reference or
+///        pointer returned by IConstDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_MULTI_COLUMN_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_MULTI_COLUMN_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to visibilities of several data columns of the same chunk
+/// @details Additional data columns are chosen via the selector (see 
+/// ITableDataSelectorImpl::chooseExtraDataColumns). All of them are read together
+/// for the rows and channels of the current chunk when the first of them is requested,
+/// so the selection is not repeated. The cubes have the same shape and layout as 
+/// the one returned by visibility().
+/// @ingroup dataaccess_i
+class IMultiColumnDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief visibilities of the given data column
+        /// @details The name of the main data column is also accepted, the cube
+        /// returned by visibility() is given in this case. An exception is thrown
+        /// if the column has not been chosen.
+        /// @param[in] column name of the data column
+        /// @return a reference to nRow x nChannel x nPol cube with visibilities
+        virtual const casacore::Cube<casacore::Complex>& columnVisibility(const std::string &column) const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_MULTI_COLUMN_DATA_ACCESSOR_H
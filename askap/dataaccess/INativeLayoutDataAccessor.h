@@ -0,0 +1,76 @@
+/// @file INativeLayoutDataAccessor.h
+/// @brief An interface to the data cubes in the storage order
+/// @details INativeLayoutDataAccessor is an additional interface class
+///        to access buffered visibility data in the order they are stored
+///        in the measurement set, i.e. nPol x nChannel x nRow. Using this
+///        layout avoids a transpose of every cube. The user should dynamic 
+///        cast to this interface from the reference or pointer returned by
+///        IConstDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_NATIVE_LAYOUT_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_NATIVE_LAYOUT_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to the data cubes in the storage order
+/// @details IConstDataAccessor returns cubes which are nRow x nChannel x nPol,
+/// while the measurement set stores a (pol,chan) matrix for each row. This 
+/// interface gives access to the same data in the storage order (nPol x nChannel x nRow),
+/// so element (pol,chan,row) of the native cube equals element (row,chan,pol) of
+/// the corresponding cube returned by IConstDataAccessor. 
+/// @note The native cubes reflect the data as read from the table. Modifications
+/// done via the read-write interface to the cubes in the accessor order are not 
+/// propagated to these cubes.
+/// @ingroup dataaccess_i
+class INativeLayoutDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief visibilities in the storage order
+        /// @return a reference to nPol x nChannel x nRow cube, containing
+        /// all visibility data
+        virtual const casacore::Cube<casacore::Complex>& nativeVisibility() const = 0;
+
+        /// @brief flags in the storage order
+        /// @return a reference to nPol x nChannel x nRow cube with flag 
+        ///         information. If True, the corresponding element is flagged.
+        virtual const casacore::Cube<casacore::Bool>& nativeFlag() const = 0;
+
+        /// @brief noise figures in the storage order
+        /// @return a reference to nPol x nChannel x nRow cube with
+        ///         complex noise estimates
+        virtual const casacore::Cube<casacore::Complex>& nativeNoise() const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef I_NATIVE_LAYOUT_DATA_ACCESSOR_H
@@ -0,0 +1,485 @@
+/// @file
+/// @brief pool of I/O threads shared by all background reads and writes
+/// @details Read-ahead of visibility chunks, write-behind of the measurement set,
+/// prefetch and writing of calibration solutions and asynchronous image writes all
+/// need background threads. If each of them runs its own threads, they compete for the
+/// same filesystem without knowing about each other, so a bulk image write can delay
+/// the read the processing is waiting for. This class runs all such jobs on one pool of
+/// threads with priority classes, optional bandwidth caps per class and queue statistics.
+/// There is one scheduler per process by default, its number of threads and the caps can
+/// be set via the ASKAP_ACCESSORS_IO_THREADS environment variable or via the parset
+/// (see configure).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/dataaccess/IOScheduler.h>
+
+// casa includes
+#include <casacore/casa/OS/EnvVar.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// std includes
+#include <cstdlib>
+
+ASKAP_LOGGER(logger, ".dataaccess");
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief number of threads requested by the environment
+/// @param[in] defaultValue value returned if ASKAP_ACCESSORS_IO_THREADS is not set
+/// @return number of I/O threads
+size_t nThreadsFromEnvironment(size_t defaultValue)
+{
+  if (casacore::EnvironmentVariable::isDefined("ASKAP_ACCESSORS_IO_THREADS")) {
+      const std::string value = casacore::EnvironmentVariable::get("ASKAP_ACCESSORS_IO_THREADS");
+      if (value != "") {
+          const long nThreads = std::atol(value.c_str());
+          ASKAPCHECK(nThreads > 0, "Number of I/O threads should be positive, you have "<<value);
+          return size_t(nThreads);
+      }
+  }
+  return defaultValue;
+}
+
+} // anonymous namespace
+
+/// @brief sequence of jobs executed in order
+class IOScheduler::ChannelState {
+public:
+  /// @brief constructor
+  /// @param[in] priority priority class of all jobs of the channel
+  explicit ChannelState(Priority priority) : itsPriority(priority), itsBusy(false) {}
+
+  /// @brief priority class of all jobs of the channel
+  const Priority itsPriority;
+
+  /// @brief true, if a job of the channel is being executed (protected by the mutex of the scheduler)
+  bool itsBusy;
+};
+
+/// @brief constructor, zeroes all counters
+IOScheduler::Statistics::Statistics() : itsQueued(0), itsRunning(0), itsMaxQueued(0), itsNDone(0),
+          itsBytes(0), itsWaitTime(0.), itsBusyTime(0.) {}
+
+/// @brief start the threads
+/// @details Most code should use the scheduler of the process (see instance), separate
+/// schedulers are only useful for tests or completely independent storage.
+/// @param[in] nThreads number of I/O threads
+IOScheduler::IOScheduler(size_t nThreads) : itsNThreads(0), itsNWorkers(0), itsStopping(false)
+{
+  for (int priority = 0; priority < N_PRIORITIES; ++priority) {
+       itsBandwidth[priority] = 0.;
+  }
+  setNThreads(nThreads);
+}
+
+/// @brief complete all queued jobs and stop the threads
+IOScheduler::~IOScheduler()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsStopping = true;
+  }
+  itsChanged.notify_all();
+  itsThreads.join_all();
+}
+
+/// @brief the scheduler of this process
+/// @details The scheduler is created on the first call and configured from the
+/// ASKAP_ACCESSORS_IO_THREADS environment variable (see configureFromEnvironment).
+/// @return reference to the scheduler
+IOScheduler& IOScheduler::instance()
+{
+  static IOScheduler scheduler(nThreadsFromEnvironment(theirDefaultNThreads));
+  return scheduler;
+}
+
+/// @brief create a channel
+/// @details Jobs submitted to the same channel are done one at a time in the order
+/// they were submitted. The channel can be dropped at any time, queued jobs are still done.
+/// @param[in] priority priority class of all jobs of the channel
+/// @return handle of the new channel
+IOScheduler::Channel IOScheduler::channel(Priority priority)
+{
+  ASKAPCHECK((priority >= 0) && (priority < N_PRIORITIES), "Unknown I/O priority class "<<int(priority));
+  return Channel(new ChannelState(priority));
+}
+
+/// @brief queue a job
+/// @details The job may run in parallel with any other job.
+/// @param[in] priority priority class of the job
+/// @param[in] job job to execute
+/// @param[in] bytes approximate amount of data read or written by the job (for the bandwidth cap)
+/// @return future of the job
+IOScheduler::Future IOScheduler::submit(Priority priority, const Job &job, size_t bytes)
+{
+  ASKAPCHECK((priority >= 0) && (priority < N_PRIORITIES), "Unknown I/O priority class "<<int(priority));
+  Ticket ticket;
+  ticket.itsJob = job;
+  ticket.itsBytes = bytes;
+  return enqueue(priority, ticket);
+}
+
+/// @brief queue a job in a channel
+/// @details The job is done after all jobs submitted to the same channel before.
+/// @param[in] chan channel obtained via channel()
+/// @param[in] job job to execute
+/// @param[in] bytes approximate amount of data read or written by the job (for the bandwidth cap)
+/// @return future of the job
+IOScheduler::Future IOScheduler::submit(const Channel &chan, const Job &job, size_t bytes)
+{
+  ASKAPCHECK(chan, "An attempt to submit an I/O job to an empty channel");
+  Ticket ticket;
+  ticket.itsJob = job;
+  ticket.itsBytes = bytes;
+  ticket.itsChannel = chan;
+  return enqueue(chan->itsPriority, ticket);
+}
+
+/// @brief queue a ticket
+/// @param[in] priority priority class
+/// @param[in] ticket job with its promise and channel
+/// @return future of the job
+IOScheduler::Future IOScheduler::enqueue(Priority priority, Ticket &ticket)
+{
+  ASKAPCHECK(ticket.itsJob, "An attempt to submit an empty I/O job");
+  ticket.itsPromise.reset(new boost::promise<void>);
+  const Future result(ticket.itsPromise->get_future());
+  ticket.itsQueued = boost::posix_time::microsec_clock::universal_time();
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    ASKAPCHECK(!itsStopping, "An attempt to submit an I/O job while the scheduler is being destroyed");
+    itsQueues[priority].push_back(ticket);
+    Statistics &stats = itsStatistics[priority];
+    stats.itsQueued = itsQueues[priority].size();
+    if (stats.itsQueued > stats.itsMaxQueued) {
+        stats.itsMaxQueued = stats.itsQueued;
+    }
+  }
+  itsChanged.notify_all();
+  return result;
+}
+
+/// @brief change the number of threads
+/// @details Extra threads are started straight away, surplus threads stop after their
+/// current job.
+/// @param[in] nThreads number of I/O threads (at least one)
+void IOScheduler::setNThreads(size_t nThreads)
+{
+  ASKAPCHECK(nThreads > 0, "The I/O scheduler needs at least one thread");
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsNThreads = nThreads;
+    for (; itsNWorkers < itsNThreads; ++itsNWorkers) {
+         itsThreads.create_thread(boost::bind(&IOScheduler::run, this));
+    }
+  }
+  itsChanged.notify_all();
+}
+
+/// @brief number of threads
+/// @return number of I/O threads
+size_t IOScheduler::nThreads() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsNThreads;
+}
+
+/// @brief set the bandwidth cap of a priority class
+/// @param[in] priority priority class
+/// @param[in] bytesPerSecond maximum average rate, zero means no limit
+void IOScheduler::setBandwidth(Priority priority, double bytesPerSecond)
+{
+  ASKAPCHECK((priority >= 0) && (priority < N_PRIORITIES), "Unknown I/O priority class "<<int(priority));
+  ASKAPCHECK(bytesPerSecond >= 0., "Bandwidth cap should be non-negative, you have "<<bytesPerSecond);
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsBandwidth[priority] = bytesPerSecond;
+    itsNextStart[priority] = boost::posix_time::ptime();
+  }
+  itsChanged.notify_all();
+}
+
+/// @brief obtain the bandwidth cap of a priority class
+/// @param[in] priority priority class
+/// @return maximum average rate in bytes per second, zero means no limit
+double IOScheduler::bandwidth(Priority priority) const
+{
+  ASKAPCHECK((priority >= 0) && (priority < N_PRIORITIES), "Unknown I/O priority class "<<int(priority));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsBandwidth[priority];
+}
+
+/// @brief set the number of threads and the caps if requested in the parset
+/// @details The parameters are <prefix>threads (number of threads) and
+/// <prefix>bandwidth.critical, <prefix>bandwidth.normal and <prefix>bandwidth.bulk
+/// (caps in MB/s). Settings which are not given are left unchanged.
+/// @param[in] parset parameters
+/// @param[in] prefix prefix of the parameter names
+void IOScheduler::configure(const LOFAR::ParameterSet &parset, const std::string &prefix)
+{
+  if (parset.isDefined(prefix + "threads")) {
+      const casacore::uInt nThreads = parset.getUint32(prefix + "threads");
+      ASKAPLOG_INFO_STR(logger, "Background reads and writes will use "<<nThreads<<" I/O threads");
+      setNThreads(nThreads);
+  }
+  for (int priority = 0; priority < N_PRIORITIES; ++priority) {
+       const std::string key = prefix + "bandwidth." + priorityName(Priority(priority));
+       if (parset.isDefined(key)) {
+           const double rateMB = parset.getDouble(key);
+           ASKAPLOG_INFO_STR(logger, "I/O of the "<<priorityName(Priority(priority))<<
+                             " class will be limited to "<<rateMB<<" MB/s");
+           setBandwidth(Priority(priority), rateMB * 1024. * 1024.);
+       }
+  }
+}
+
+/// @brief set the number of threads if requested by the environment
+/// @details The ASKAP_ACCESSORS_IO_THREADS variable gives the number of threads.
+void IOScheduler::configureFromEnvironment()
+{
+  setNThreads(nThreadsFromEnvironment(nThreads()));
+}
+
+/// @brief statistics of a priority class
+/// @param[in] priority priority class
+/// @return statistics accumulated since the scheduler was created or reset
+IOScheduler::Statistics IOScheduler::statistics(Priority priority) const
+{
+  ASKAPCHECK((priority >= 0) && (priority < N_PRIORITIES), "Unknown I/O priority class "<<int(priority));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsStatistics[priority];
+}
+
+/// @brief reset the accumulated statistics
+/// @details The current queue depths are kept.
+void IOScheduler::resetStatistics()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  for (int priority = 0; priority < N_PRIORITIES; ++priority) {
+       Statistics &stats = itsStatistics[priority];
+       const size_t running = stats.itsRunning;
+       stats = Statistics();
+       stats.itsQueued = itsQueues[priority].size();
+       stats.itsMaxQueued = stats.itsQueued;
+       stats.itsRunning = running;
+  }
+}
+
+/// @brief write the statistics of all classes into the log
+void IOScheduler::logStatistics() const
+{
+  for (int priority = 0; priority < N_PRIORITIES; ++priority) {
+       const Statistics stats = statistics(Priority(priority));
+       ASKAPLOG_INFO_STR(logger, "I/O class "<<priorityName(Priority(priority))<<": "<<stats.itsNDone<<
+                         " jobs, "<<double(stats.itsBytes) / 1024. / 1024.<<" MB, busy for "<<stats.itsBusyTime<<
+                         " s, mean wait "<<(stats.itsNDone > 0 ? stats.itsWaitTime / stats.itsNDone : 0.)<<
+                         " s, max queue depth "<<stats.itsMaxQueued<<", queued now "<<stats.itsQueued<<
+                         ", running "<<stats.itsRunning);
+  }
+}
+
+/// @brief wait until there are no queued or running jobs
+/// @details Jobs submitted by other threads in the meantime are waited for as well.
+void IOScheduler::wait() const
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  for (;;) {
+       bool idle = true;
+       for (int priority = 0; priority < N_PRIORITIES; ++priority) {
+            if ((itsQueues[priority].size() > 0) || (itsStatistics[priority].itsRunning > 0)) {
+                idle = false;
+            }
+       }
+       if (idle) {
+           return;
+       }
+       itsChanged.wait(lock);
+  }
+}
+
+/// @brief name of a priority class
+/// @param[in] priority priority class
+/// @return name used in the log and the parset
+std::string IOScheduler::priorityName(Priority priority)
+{
+  switch (priority) {
+     case CRITICAL: return "critical";
+     case NORMAL: return "normal";
+     case BULK: return "bulk";
+     default: ASKAPTHROW(AskapError, "Unknown I/O priority class "<<int(priority));
+  }
+}
+
+/// @brief take the next job allowed to run
+/// @details This method should be called with the mutex locked. If no job can run
+/// because of the bandwidth caps, the time when the first one can is returned.
+/// @param[out] ticket the job taken
+/// @param[out] priority class of the job taken
+/// @param[out] wakeUp time when a job becomes allowed to run (not_a_date_time if unknown)
+/// @return true if a job has been taken
+bool IOScheduler::takeNext(Ticket &ticket, Priority &priority, boost::posix_time::ptime &wakeUp)
+{
+  wakeUp = boost::posix_time::ptime();
+  const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+  // one thread is always left for latency-critical jobs
+  size_t nonCritical = 0;
+  for (int cls = CRITICAL + 1; cls < N_PRIORITIES; ++cls) {
+       nonCritical += itsStatistics[cls].itsRunning;
+  }
+  for (int cls = 0; cls < N_PRIORITIES; ++cls) {
+       std::deque<Ticket> &queue = itsQueues[cls];
+       if (queue.empty()) {
+           continue;
+       }
+       if ((cls != CRITICAL) && (itsNThreads > 1) && (nonCritical + 1 >= itsNThreads)) {
+           continue;
+       }
+       if (!itsNextStart[cls].is_not_a_date_time() && (now < itsNextStart[cls])) {
+           if (wakeUp.is_not_a_date_time() || (itsNextStart[cls] < wakeUp)) {
+               wakeUp = itsNextStart[cls];
+           }
+           continue;
+       }
+       // the oldest job which is not held back by an earlier job of the same channel
+       for (std::deque<Ticket>::iterator it = queue.begin(); it != queue.end(); ++it) {
+            if (!it->itsChannel || !it->itsChannel->itsBusy) {
+                ticket = *it;
+                queue.erase(it);
+                priority = Priority(cls);
+                if (ticket.itsChannel) {
+                    ticket.itsChannel->itsBusy = true;
+                }
+                if (itsBandwidth[cls] > 0.) {
+                    const boost::posix_time::ptime start = itsNextStart[cls].is_not_a_date_time() ||
+                                    (itsNextStart[cls] < now) ? now : itsNextStart[cls];
+                    itsNextStart[cls] = start + boost::posix_time::microseconds(
+                                    static_cast<long>(1e6 * double(ticket.itsBytes) / itsBandwidth[cls]));
+                }
+                Statistics &stats = itsStatistics[cls];
+                stats.itsQueued = queue.size();
+                ++stats.itsRunning;
+                stats.itsWaitTime += 1e-6 * double((now - ticket.itsQueued).total_microseconds());
+                return true;
+            }
+       }
+  }
+  return false;
+}
+
+/// @brief body of the I/O threads
+void IOScheduler::run()
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  for (;;) {
+       if (itsNWorkers > itsNThreads) {
+           --itsNWorkers;
+           return;
+       }
+       Ticket ticket;
+       Priority priority = CRITICAL;
+       boost::posix_time::ptime wakeUp;
+       if (takeNext(ticket, priority, wakeUp)) {
+           lock.unlock();
+           const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+           execute(ticket);
+           const boost::posix_time::ptime end = boost::posix_time::microsec_clock::universal_time();
+           lock.lock();
+           if (ticket.itsChannel) {
+               ticket.itsChannel->itsBusy = false;
+           }
+           Statistics &stats = itsStatistics[priority];
+           --stats.itsRunning;
+           ++stats.itsNDone;
+           stats.itsBytes += ticket.itsBytes;
+           stats.itsBusyTime += 1e-6 * double((end - start).total_microseconds());
+           // a job of the same channel or of a lower class may be allowed to run now
+           itsChanged.notify_all();
+           continue;
+       }
+       if (itsStopping) {
+           bool empty = true;
+           for (int cls = 0; cls < N_PRIORITIES; ++cls) {
+                if (itsQueues[cls].size() > 0) {
+                    empty = false;
+                }
+           }
+           if (empty) {
+               --itsNWorkers;
+               return;
+           }
+       }
+       if (wakeUp.is_not_a_date_time()) {
+           itsChanged.wait(lock);
+       } else {
+           itsChanged.timed_wait(lock, wakeUp);
+       }
+  }
+}
+
+/// @brief execute a job and fulfil its promise
+/// @param[in] ticket job to execute
+void IOScheduler::execute(const Ticket &ticket)
+{
+  ASKAPDEBUGASSERT(ticket.itsPromise);
+  std::string error;
+  try {
+     ticket.itsJob();
+  }
+  catch (const std::exception &ex) {
+     error = ex.what();
+     if (error.empty()) {
+         error = "unknown error";
+     }
+  }
+  catch (...) {
+     error = "unknown error";
+  }
+  if (error.empty()) {
+      ticket.itsPromise->set_value();
+  } else {
+      ASKAPLOG_DEBUG_STR(logger, "Background I/O job failed: "<<error);
+      ticket.itsPromise->set_exception(boost::copy_exception(AskapError(error)));
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
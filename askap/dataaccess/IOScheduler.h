@@ -0,0 +1,295 @@
+/// @file
+/// @brief pool of I/O threads shared by all background reads and writes
+/// @details Read-ahead of visibility chunks, write-behind of the measurement set,
+/// prefetch and writing of calibration solutions and asynchronous image writes all
+/// need background threads. If each of them runs its own threads, they compete for the
+/// same filesystem without knowing about each other, so a bulk image write can delay
+/// the read the processing is waiting for. This class runs all such jobs on one pool of
+/// threads with priority classes, optional bandwidth caps per class and queue statistics.
+/// There is one scheduler per process by default, its number of threads and the caps can
+/// be set via the ASKAP_ACCESSORS_IO_THREADS environment variable or via the parset
+/// (see configure).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_IO_SCHEDULER_H
+#define ASKAP_ACCESSORS_IO_SCHEDULER_H
+
+// std includes
+#include <cstddef>
+#include <deque>
+#include <string>
+
+// boost includes
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief pool of I/O threads shared by all background reads and writes
+/// @details Jobs are submitted with a priority class. A free thread takes the oldest job
+/// of the most important class which is allowed to run. Jobs which are not latency-critical
+/// are never run on all threads at once (unless there is only one thread), so a critical
+/// read doesn't wait for a number of long bulk writes to finish. Each class can be given a
+/// bandwidth cap: the job size given on submission delays the start of the next job of
+/// the same class, so the class doesn't exceed the given rate on average. Jobs which need
+/// to be done in order (e.g. all writes to the same image) are submitted to the same
+/// channel, jobs of a channel are done one at a time in the order they were submitted.
+/// The result of each job is passed to its future, an exception thrown by the job is
+/// passed as AskapError. Jobs should not wait for other jobs of the scheduler, as all
+/// threads may be taken by the waiting jobs. The destructor completes all queued jobs.
+/// All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class IOScheduler : private boost::noncopyable
+{
+public:
+  /// @brief priority classes, in the order of decreasing importance
+  enum Priority {
+     /// @brief reads the processing is waiting for (next visibility chunk, calibration solution)
+     CRITICAL = 0,
+     /// @brief writes which block the processing when they fall behind (write-behind, solutions)
+     NORMAL,
+     /// @brief bulk writes nothing waits for (images, spilled buffers)
+     BULK,
+     /// @brief number of classes
+     N_PRIORITIES
+  };
+
+  /// @brief type of the job
+  typedef boost::function<void()> Job;
+
+  /// @brief type of the future of a job
+  typedef boost::shared_future<void> Future;
+
+  /// @brief sequence of jobs executed in order
+  /// @details The channel is an opaque handle obtained via channel().
+  class ChannelState;
+
+  /// @brief handle of a channel
+  typedef boost::shared_ptr<ChannelState> Channel;
+
+  /// @brief statistics of one priority class
+  struct Statistics {
+     /// @brief constructor, zeroes all counters
+     Statistics();
+     /// @brief number of jobs waiting in the queue
+     size_t itsQueued;
+     /// @brief number of jobs being executed
+     size_t itsRunning;
+     /// @brief maximum number of jobs waiting in the queue at the same time
+     size_t itsMaxQueued;
+     /// @brief number of jobs done
+     casacore::uInt64 itsNDone;
+     /// @brief total size of the jobs done in bytes (as given on submission)
+     casacore::uInt64 itsBytes;
+     /// @brief total time the jobs done have spent in the queue (in seconds)
+     double itsWaitTime;
+     /// @brief total execution time of the jobs done (in seconds)
+     double itsBusyTime;
+  };
+
+  /// @brief start the threads
+  /// @details Most code should use the scheduler of the process (see instance), separate
+  /// schedulers are only useful for tests or completely independent storage.
+  /// @param[in] nThreads number of I/O threads
+  explicit IOScheduler(size_t nThreads = theirDefaultNThreads);
+
+  /// @brief complete all queued jobs and stop the threads
+  ~IOScheduler();
+
+  /// @brief the scheduler of this process
+  /// @details The scheduler is created on the first call and configured from the
+  /// ASKAP_ACCESSORS_IO_THREADS environment variable (see configureFromEnvironment).
+  /// @return reference to the scheduler
+  static IOScheduler& instance();
+
+  /// @brief create a channel
+  /// @details Jobs submitted to the same channel are done one at a time in the order
+  /// they were submitted. The channel can be dropped at any time, queued jobs are still done.
+  /// @param[in] priority priority class of all jobs of the channel
+  /// @return handle of the new channel
+  Channel channel(Priority priority);
+
+  /// @brief queue a job
+  /// @details The job may run in parallel with any other job.
+  /// @param[in] priority priority class of the job
+  /// @param[in] job job to execute
+  /// @param[in] bytes approximate amount of data read or written by the job (for the bandwidth cap)
+  /// @return future of the job
+  Future submit(Priority priority, const Job &job, size_t bytes = 0);
+
+  /// @brief queue a job in a channel
+  /// @details The job is done after all jobs submitted to the same channel before.
+  /// @param[in] chan channel obtained via channel()
+  /// @param[in] job job to execute
+  /// @param[in] bytes approximate amount of data read or written by the job (for the bandwidth cap)
+  /// @return future of the job
+  Future submit(const Channel &chan, const Job &job, size_t bytes = 0);
+
+  /// @brief change the number of threads
+  /// @details Extra threads are started straight away, surplus threads stop after their
+  /// current job.
+  /// @param[in] nThreads number of I/O threads (at least one)
+  void setNThreads(size_t nThreads);
+
+  /// @brief number of threads
+  /// @return number of I/O threads
+  size_t nThreads() const;
+
+  /// @brief set the bandwidth cap of a priority class
+  /// @param[in] priority priority class
+  /// @param[in] bytesPerSecond maximum average rate, zero means no limit
+  void setBandwidth(Priority priority, double bytesPerSecond);
+
+  /// @brief obtain the bandwidth cap of a priority class
+  /// @param[in] priority priority class
+  /// @return maximum average rate in bytes per second, zero means no limit
+  double bandwidth(Priority priority) const;
+
+  /// @brief set the number of threads and the caps if requested in the parset
+  /// @details The parameters are <prefix>threads (number of threads) and
+  /// <prefix>bandwidth.critical, <prefix>bandwidth.normal and <prefix>bandwidth.bulk
+  /// (caps in MB/s). Settings which are not given are left unchanged.
+  /// @param[in] parset parameters
+  /// @param[in] prefix prefix of the parameter names
+  void configure(const LOFAR::ParameterSet &parset, const std::string &prefix = "io");
+
+  /// @brief set the number of threads if requested by the environment
+  /// @details The ASKAP_ACCESSORS_IO_THREADS variable gives the number of threads.
+  void configureFromEnvironment();
+
+  /// @brief statistics of a priority class
+  /// @param[in] priority priority class
+  /// @return statistics accumulated since the scheduler was created or reset
+  Statistics statistics(Priority priority) const;
+
+  /// @brief reset the accumulated statistics
+  /// @details The current queue depths are kept.
+  void resetStatistics();
+
+  /// @brief write the statistics of all classes into the log
+  void logStatistics() const;
+
+  /// @brief wait until there are no queued or running jobs
+  /// @details Jobs submitted by other threads in the meantime are waited for as well.
+  void wait() const;
+
+  /// @brief name of a priority class
+  /// @param[in] priority priority class
+  /// @return name used in the log and the parset
+  static std::string priorityName(Priority priority);
+
+  /// @brief default number of threads
+  static const size_t theirDefaultNThreads = 4;
+
+protected:
+  /// @brief queued job
+  struct Ticket {
+     /// @brief job to execute
+     Job itsJob;
+     /// @brief promise passing the result to the future
+     boost::shared_ptr<boost::promise<void> > itsPromise;
+     /// @brief channel of the job, empty if the job is independent
+     Channel itsChannel;
+     /// @brief approximate amount of data in bytes
+     size_t itsBytes;
+     /// @brief time the job was queued
+     boost::posix_time::ptime itsQueued;
+  };
+
+  /// @brief queue a ticket
+  /// @param[in] priority priority class
+  /// @param[in] ticket job with its promise and channel
+  /// @return future of the job
+  Future enqueue(Priority priority, Ticket &ticket);
+
+  /// @brief take the next job allowed to run
+  /// @details This method should be called with the mutex locked. If no job can run
+  /// because of the bandwidth caps, the time when the first one can is returned.
+  /// @param[out] ticket the job taken
+  /// @param[out] priority class of the job taken
+  /// @param[out] wakeUp time when a job becomes allowed to run (not_a_date_time if unknown)
+  /// @return true if a job has been taken
+  bool takeNext(Ticket &ticket, Priority &priority, boost::posix_time::ptime &wakeUp);
+
+  /// @brief body of the I/O threads
+  void run();
+
+  /// @brief execute a job and fulfil its promise
+  /// @param[in] ticket job to execute
+  static void execute(const Ticket &ticket);
+
+private:
+  /// @brief queued jobs for each class
+  std::deque<Ticket> itsQueues[N_PRIORITIES];
+
+  /// @brief statistics of each class
+  Statistics itsStatistics[N_PRIORITIES];
+
+  /// @brief bandwidth caps in bytes per second, zero means no limit
+  double itsBandwidth[N_PRIORITIES];
+
+  /// @brief earliest start of the next job of each class allowed by the caps
+  boost::posix_time::ptime itsNextStart[N_PRIORITIES];
+
+  /// @brief requested number of threads
+  size_t itsNThreads;
+
+  /// @brief number of threads running (may exceed the requested number for a while)
+  size_t itsNWorkers;
+
+  /// @brief true, if the scheduler is being destroyed
+  bool itsStopping;
+
+  /// @brief mutex protecting all the above
+  mutable boost::mutex itsMutex;
+
+  /// @brief condition signalled when a job is queued or done, or the settings change
+  mutable boost::condition_variable itsChanged;
+
+  /// @brief I/O threads
+  boost::thread_group itsThreads;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IO_SCHEDULER_H
@@ -0,0 +1,63 @@
+/// @file IPackedFlagDataAccessor.h
+/// @brief An interface to the bit-packed flags
+/// @details IPackedFlagDataAccessor is an additional interface class
+///        to access flagging information in the bit-packed form (see PackedFlagCube),
+///        alongside the Cube<Bool> returned by IConstDataAccessor::flag() and
+///        the read-write access provided by IFlagDataAccessor. The user should dynamic 
+///        cast to this interface from the reference or pointer returned by
+///        IConstDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_PACKED_FLAG_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_PACKED_FLAG_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/PackedFlagCube.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to the bit-packed flags
+/// @details The flag cube returned by IConstDataAccessor::flag() uses one byte
+/// per element. This interface provides the same information packed into bits,
+/// which reduces the memory traffic for consumers which only test or combine flags.
+/// @note The packed flags reflect the data as read from the table. Modifications
+/// done via the read-write interface are not propagated to this representation.
+/// @ingroup dataaccess_i
+class IPackedFlagDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief bit-packed flags
+        /// @return a reference to the packed flags for the nRow x nChannel x nPol cube
+        virtual const PackedFlagCube& packedFlag() const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_PACKED_FLAG_DATA_ACCESSOR_H
@@ -0,0 +1,78 @@
+/// @file ISinglePrecisionDataAccessor.h
+/// @brief An interface to single precision uvw and spectral axis
+/// @details ISinglePrecisionDataAccessor is an additional interface class
+///        which gives uvw-coordinates and the spectral axis converted to
+///        single precision, for consumers which work with floats anyway (e.g.
+///        GPU gridders). The conversion is done once per chunk and cached
+///        alongside the double precision fields.
+///        The user should dynamic cast to this interface from the reference or
+///        pointer returned by IConstDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_SINGLE_PRECISION_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_SINGLE_PRECISION_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to single precision uvw and spectral axis
+/// @details The double precision fields of IConstDataAccessor are converted on the first
+/// request and cached for the current chunk, so repeated calls don't redo the conversion.
+/// The inverse wavelength allows one to get uvw in wavelengths without any double 
+/// precision arithmetic in the inner loop: uvw[row](dim) * inverseWavelength()[chan].
+/// @ingroup dataaccess_i
+class ISinglePrecisionDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief uvw in single precision
+        /// @return a reference to vector containing uvw-coordinates (in metres)
+        /// packed into a 3-D rigid vector, one element for each row
+        virtual const casacore::Vector<casacore::RigidVector<casacore::Float, 3> >& floatUVW() const = 0;
+
+        /// @brief frequency in single precision
+        /// @return a reference to vector containing frequencies for each spectral 
+        /// channel, the frame/units are the same as for frequency()
+        virtual const casacore::Vector<casacore::Float>& floatFrequency() const = 0;
+
+        /// @brief inverse wavelength for each channel
+        /// @details This is frequency divided by the speed of light, regardless of the units
+        /// in which frequency() is given.
+        /// @return a reference to vector containing 1/lambda (in 1/metres) for each spectral channel
+        virtual const casacore::Vector<casacore::Float>& inverseWavelength() const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_SINGLE_PRECISION_DATA_ACCESSOR_H
@@ -9,6 +9,7 @@
 ///     2. data description indices,
 ///     3. spectral window ids.
 ///     4. Polarisation information
+///     5. index of the main table rows by time, feed, baseline and data description
 /// Such design allows to avoid parsing of all possible subtables and
 /// building all possible derived information (which can be time consuming)
 /// when the measurement set is opened.
@@ -41,6 +42,8 @@
 #ifndef ASKAP_ACCESSORS_I_SUBTABLE_INFO_HOLDER_H
 #define ASKAP_ACCESSORS_I_SUBTABLE_INFO_HOLDER_H
 
+#include <string>
+
 #include <askap/dataaccess/IHolder.h>
 #include <askap/dataaccess/ITableDataDescHolder.h>
 #include <askap/dataaccess/ITableSpWindowHolder.h>
@@ -49,6 +52,8 @@
 #include <askap/dataaccess/IFieldSubtableHandler.h>
 #include <askap/dataaccess/IAntennaSubtableHandler.h>
 #include <askap/dataaccess/ITablePolarisationHolder.h>
+#include <askap/dataaccess/MainTableRowIndex.h>
+#include <askap/dataaccess/TimeColumnIndex.h>
 
 namespace askap {
 
@@ -64,6 +69,7 @@ namespace accessors {
 ///     2. data description indices,
 ///     3. spectral window ids.
 ///     4. Polarisation information
+///     5. index of the main table rows by time, feed, baseline and data description
 /// Such design allows to avoid parsing of all possible subtables and
 /// building all possible derived information (which can be time consuming)
 /// when the measurement set is opened.
@@ -90,6 +96,21 @@ struct ISubtableInfoHolder : virtual public IHolder {
 
    /// @return a reference to the handler of the ANTENNA subtable
    virtual const IAntennaSubtableHandler& getAntenna() const = 0;
+
+   /// @return a reference to the index of the main table rows
+   virtual const MainTableRowIndex& getRowIndex() const = 0;
+
+   /// @return a reference to the index of the TIME column of the main table
+   virtual const TimeColumnIndex& getTimeIndex() const = 0;
+
+   /// @brief restore subtable handlers from a snapshot file
+   /// @param[in] fileName name of the snapshot file
+   /// @return true if the snapshot is valid for this measurement set and has been loaded
+   virtual bool loadSnapshot(const std::string &fileName) const = 0;
+
+   /// @brief write subtable handlers into a snapshot file
+   /// @param[in] fileName name of the snapshot file
+   virtual void saveSnapshot(const std::string &fileName) const = 0;
 };
 
 
@@ -41,14 +41,18 @@
 
 // casa includes
 #include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/measures/Measures/Stokes.h>
 
 // own includes
 #include <askap/dataaccess/IDataConverterImpl.h>
 #include <askap/dataaccess/IDataSelector.h>
+#include <askap/dataaccess/MainTableRowIndex.h>
 
 // std includes
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace askap {
 
@@ -67,6 +71,25 @@ namespace accessors {
 class ITableDataSelectorImpl : virtual public IDataSelector
 {
 public:
+  /// @brief fields of the accessor which can be declared as required
+  /// @details Values can be or'ed. See chooseRequiredFields.
+  enum AccessorField {
+     /// visibility cube
+     VISIBILITY_FIELD = 1,
+     /// flag cube
+     FLAG_FIELD = 2,
+     /// noise cube
+     NOISE_FIELD = 4,
+     /// uvw coordinates
+     UVW_FIELD = 8,
+     /// pointing and dish pointing directions, rotated uvw and delays
+     DIRECTION_FIELD = 16,
+     /// feed position angles
+     FEED_PA_FIELD = 32,
+     /// all of the above (default)
+     ALL_FIELDS = 63
+  };
+  
   /// @brief Obtain a table expression node for selection. 
   /// @details This method is
   /// used in the implementation of the iterator to form a subtable
@@ -78,6 +101,31 @@ public:
   /// @return a const reference to table expression node object
   virtual const casacore::TableExprNode& getTableSelector(const
                boost::shared_ptr<IDataConverterImpl const> &conv) const = 0;
+
+  /// @brief Obtain row selection criteria
+  /// @details This method is an alternative to getTableSelector used if the
+  /// selection is resolved via the index of the main table rows. The criteria 
+  /// are unusable if some of the selections can't be done with this index.
+  ///
+  /// @param conv  a shared pointer to the converter, which is used to sort
+  ///              out epochs and other measures used in the selection
+  /// @return criteria equivalent to the table expression
+  virtual MainTableRowIndex::Criteria getRowCriteria(const
+               boost::shared_ptr<IDataConverterImpl const> &conv) const = 0;
+
+  /// @brief choose a set of baselines
+  /// @details Rows are selected if (ANTENNA1, ANTENNA2) is one of the given pairs. This
+  /// is equivalent to chaining or'ed chooseBaseline selections, but is done in one go
+  /// (via a set membership test in the table expression or via the row index).
+  /// Like chooseDataColumn, this is a table-specific operation.
+  /// @param[in] baselines pairs of the first and second antenna (empty vector selects nothing)
+  virtual void chooseBaselines(const std::vector<std::pair<casacore::uInt, casacore::uInt> > &baselines) = 0;
+
+  /// @brief choose all baselines to any of the given antennae
+  /// @details This is equivalent to chaining or'ed chooseAntenna selections, but is done
+  /// in one go (see chooseBaselines).
+  /// @param[in] antennas antenna IDs (empty vector selects nothing)
+  virtual void chooseAntennas(const std::vector<casacore::uInt> &antennas) = 0;
   
   /// @brief choose data column
   /// @details This method allows to choose any table column as the visibility
@@ -87,6 +135,32 @@ public:
   /// a dynamic_pointer_cast is likely required).
   /// @param[in] dataColumn column name, which contains visibility data 
   virtual void chooseDataColumn(const std::string &dataColumn) = 0;  
+
+  /// @brief choose additional data columns
+  /// @details Visibilities of these columns (e.g. MODEL_DATA) are read for the same 
+  /// rows and channels as the main data column and are available via 
+  /// IMultiColumnDataAccessor. Like chooseDataColumn, this is a table-specific operation.
+  /// @param[in] columns names of the additional columns (an empty vector means none)
+  virtual void chooseExtraDataColumns(const std::vector<std::string> &columns) = 0;
+
+  /// @brief obtain the names of additional data columns
+  /// @return names set by chooseExtraDataColumns (empty by default)
+  virtual const std::vector<std::string>& getExtraDataColumnNames() const throw() = 0;
+
+  /// @brief declare fields which will be used
+  /// @details By default, any field of the accessor may be used. If a subset of
+  /// fields is declared by this method, the iterator can avoid the work related to
+  /// other fields (e.g. the read-ahead is restricted to the declared bulk data and 
+  /// the checks of the feed and field subtables are not done if directions and 
+  /// position angles are not required). Undeclared fields are still available, but
+  /// may be obtained in a less efficient way. Like chooseDataColumn, this is a 
+  /// table-specific operation.
+  /// @param[in] fields fields from AccessorField, can be or'ed
+  virtual void chooseRequiredFields(int fields) = 0;
+
+  /// @brief obtain fields declared as required
+  /// @return fields from AccessorField or'ed together (ALL_FIELDS by default)
+  virtual int requiredFields() const throw() = 0;
   
   /// @brief clone a selector
   /// @details The same selector can be used to create a number of iterators.
@@ -121,6 +195,21 @@ public:
   /// @return a pair, the first element gives the number of channels selected and
   /// the second element gives the start channel (0-based)
   virtual std::pair<int,int> getChannelSelection() const throw() = 0;
+
+  /// @brief obtain the number of channels averaged together
+  /// @details Blocks of adjacent channels are averaged at read time if more 
+  /// than one channel is given to chooseChannels as nAvg. In this case, the number 
+  /// of selected channels refers to the averaged channels and the start channel
+  /// refers to the channels stored in the dataset.
+  /// @return number of adjacent channels averaged together (1 means no averaging)
+  virtual casacore::uInt getChannelAveraging() const throw() = 0;
+
+  /// @brief obtain polarisation selection
+  /// @details By default, all stored polarisation products are returned as they are.
+  /// If choosePolarizations has been called, this method returns the requested products
+  /// in the order they should appear in the accessor.
+  /// @return requested polarisation products (an empty vector means no selection)
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& getPolarizationSelection() const throw() = 0;
   
 };
   
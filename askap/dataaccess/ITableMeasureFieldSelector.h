@@ -39,6 +39,7 @@
 
 // own includes
 #include <askap/dataaccess/IDataConverterImpl.h>
+#include <askap/dataaccess/MainTableRowIndex.h>
 
 // boost includes
 #include <boost/shared_ptr.hpp>
@@ -72,6 +73,12 @@ public:
    ///
    /// @param[in] tex a reference to table expression to use
    virtual void updateTableExpression(casacore::TableExprNode &tex) const = 0;
+
+   /// @brief update row selection criteria to narrow down the selection
+   /// @details This is an alternative to updateTableExpression used if the 
+   /// selection is resolved via the index of the main table rows.
+   /// @param[in] criteria a reference to the criteria to update
+   virtual void updateRowCriteria(MainTableRowIndex::Criteria &criteria) const = 0;
 };
 
 } // namespace askap
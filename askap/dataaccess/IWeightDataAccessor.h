@@ -0,0 +1,66 @@
+/// @file IWeightDataAccessor.h
+/// @brief An interface to the weight cube derived from flags and noise
+/// @details IWeightDataAccessor is an additional interface class which gives
+///        the weight of each visibility, combining flagging information and
+///        noise figures. Gridders and solvers need this product for every element
+///        in each pass, the accessor computes it once per chunk in a single pass
+///        and caches it. The user should dynamic cast to this interface from the 
+///        reference or pointer returned by IConstDataIterator interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_I_WEIGHT_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_I_WEIGHT_DATA_ACCESSOR_H
+
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to the weight cube derived from flags and noise
+/// @details The weight is zero for flagged elements (including rows flagged as a whole)
+/// and elements without a positive noise figure. Otherwise, it is the inverse variance
+/// 1/sigma^2, where sigma is the noise of the real (and imaginary) part, i.e. the real part
+/// of the element of the noise cube. This is the same weighting as used for averaging.
+/// If the dataset has the WEIGHT_SPECTRUM column, the weights are taken from it instead.
+/// @ingroup dataaccess_i
+class IWeightDataAccessor : virtual public IConstDataAccessor
+{
+public:
+        /// @brief weight of each visibility
+        /// @return a reference to nRow x nChannel x nPol cube with weights, 
+        /// elements correspond to the visibilities in the data cube
+        virtual const casacore::Cube<casacore::Float>& weight() const = 0;
+};
+
+} // end of namespace accessors
+
+} // end of namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_WEIGHT_DATA_ACCESSOR_H
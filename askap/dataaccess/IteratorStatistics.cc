@@ -0,0 +1,334 @@
+/// @file
+/// @brief I/O and cache statistics of table-based iterators
+/// @details This class accumulates the number of bytes read and written per
+/// column, the time spent in the main fill methods of the iterator, the number
+/// of chunks and rows as well as the cache efficiency counters. It is attached
+/// to iterators on request (see TableConstDataSource::configureStatistics), so
+/// the counters cost nothing otherwise.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/dataaccess/IteratorStatistics.h>
+
+// boost includes
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+ASKAP_LOGGER(logger, ".dataaccess");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief start the timer
+/// @param[in] stats statistics to update (may be zero)
+/// @param[in] stage operation being timed
+IteratorStatistics::ScopedTimer::ScopedTimer(IteratorStatistics *stats, Stage stage) :
+        itsStatistics(stats), itsStage(stage)
+{
+  if (itsStatistics != 0) {
+      itsStart = boost::posix_time::microsec_clock::universal_time();
+  }
+}
+
+/// @brief stop the timer and update the statistics
+IteratorStatistics::ScopedTimer::~ScopedTimer()
+{
+  if (itsStatistics != 0) {
+      const boost::posix_time::time_duration elapsed =
+            boost::posix_time::microsec_clock::universal_time() - itsStart;
+      itsStatistics->addTime(itsStage, 1e-6 * double(elapsed.total_microseconds()));
+  }
+}
+
+/// @brief construct an object with all counters set to zero
+IteratorStatistics::IteratorStatistics()
+{
+  reset();
+}
+
+/// @brief reset all counters to zero
+void IteratorStatistics::reset()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsBytesRead.clear();
+  itsBytesWritten.clear();
+  for (int stage = 0; stage < N_STAGES; ++stage) {
+       itsTimes[stage] = 0.;
+       itsCalls[stage] = 0;
+  }
+  itsChunks = 0;
+  itsRows = 0;
+  itsCacheFills.store(0, std::memory_order_relaxed);
+  itsCacheHits.store(0, std::memory_order_relaxed);
+  itsMachineHits = 0;
+  itsMachineMisses = 0;
+  itsMachineEvictions = 0;
+}
+
+/// @brief account for the data read from a column
+/// @param[in] column column name
+/// @param[in] bytes number of bytes
+void IteratorStatistics::addRead(const std::string &column, casacore::uInt64 bytes)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsBytesRead[column] += bytes;
+}
+
+/// @brief account for the data written to a column
+/// @param[in] column column name
+/// @param[in] bytes number of bytes
+void IteratorStatistics::addWrite(const std::string &column, casacore::uInt64 bytes)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsBytesWritten[column] += bytes;
+}
+
+/// @brief account for the time spent in an operation
+/// @param[in] stage operation
+/// @param[in] seconds wall clock time in seconds
+void IteratorStatistics::addTime(Stage stage, double seconds)
+{
+  ASKAPDEBUGASSERT((stage >= 0) && (stage < N_STAGES));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsTimes[stage] += seconds;
+  ++itsCalls[stage];
+}
+
+/// @brief account for a new chunk delivered by the iterator
+/// @param[in] nRow number of rows in the chunk
+void IteratorStatistics::addChunk(casacore::uInt nRow)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  ++itsChunks;
+  itsRows += nRow;
+}
+
+/// @brief account for a read on demand of an accessor field
+void IteratorStatistics::cacheFill()
+{
+  itsCacheFills.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// @brief account for an accessor field served from the cache
+void IteratorStatistics::cacheHit()
+{
+  itsCacheHits.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// @brief account for a uvw machine found in the cache
+void IteratorStatistics::machineHit()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  ++itsMachineHits;
+}
+
+/// @brief account for a uvw machine which had to be set up
+void IteratorStatistics::machineMiss()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  ++itsMachineMisses;
+}
+
+/// @brief account for a uvw machine removed from the cache to make room for another
+void IteratorStatistics::machineEviction()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  ++itsMachineEvictions;
+}
+
+/// @brief bytes read from the given column
+/// @param[in] column column name
+/// @return number of bytes
+casacore::uInt64 IteratorStatistics::bytesRead(const std::string &column) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const std::map<std::string, casacore::uInt64>::const_iterator ci = itsBytesRead.find(column);
+  return ci != itsBytesRead.end() ? ci->second : 0;
+}
+
+/// @brief bytes written to the given column
+/// @param[in] column column name
+/// @return number of bytes
+casacore::uInt64 IteratorStatistics::bytesWritten(const std::string &column) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const std::map<std::string, casacore::uInt64>::const_iterator ci = itsBytesWritten.find(column);
+  return ci != itsBytesWritten.end() ? ci->second : 0;
+}
+
+/// @brief bytes read from all columns
+/// @return number of bytes
+casacore::uInt64 IteratorStatistics::totalBytesRead() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  casacore::uInt64 result = 0;
+  for (std::map<std::string, casacore::uInt64>::const_iterator ci = itsBytesRead.begin();
+       ci != itsBytesRead.end(); ++ci) {
+       result += ci->second;
+  }
+  return result;
+}
+
+/// @brief bytes written to all columns
+/// @return number of bytes
+casacore::uInt64 IteratorStatistics::totalBytesWritten() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  casacore::uInt64 result = 0;
+  for (std::map<std::string, casacore::uInt64>::const_iterator ci = itsBytesWritten.begin();
+       ci != itsBytesWritten.end(); ++ci) {
+       result += ci->second;
+  }
+  return result;
+}
+
+/// @brief time spent in the given operation
+/// @param[in] stage operation
+/// @return wall clock time in seconds
+double IteratorStatistics::time(Stage stage) const
+{
+  ASKAPCHECK((stage >= 0) && (stage < N_STAGES), "Unknown stage "<<int(stage));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsTimes[stage];
+}
+
+/// @brief number of times the given operation has been done
+/// @param[in] stage operation
+/// @return number of calls
+casacore::uInt64 IteratorStatistics::nCalls(Stage stage) const
+{
+  ASKAPCHECK((stage >= 0) && (stage < N_STAGES), "Unknown stage "<<int(stage));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsCalls[stage];
+}
+
+/// @brief number of chunks delivered
+casacore::uInt64 IteratorStatistics::nChunks() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsChunks;
+}
+
+/// @brief number of rows delivered (summed over all chunks)
+casacore::uInt64 IteratorStatistics::nRows() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsRows;
+}
+
+/// @brief number of reads on demand of the accessor fields
+casacore::uInt64 IteratorStatistics::nCacheFills() const
+{
+  return itsCacheFills.load(std::memory_order_relaxed);
+}
+
+/// @brief number of accessor fields served from the cache
+casacore::uInt64 IteratorStatistics::nCacheHits() const
+{
+  return itsCacheHits.load(std::memory_order_relaxed);
+}
+
+/// @brief number of uvw machines found in the cache
+casacore::uInt64 IteratorStatistics::nMachineHits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsMachineHits;
+}
+
+/// @brief number of uvw machines set up
+casacore::uInt64 IteratorStatistics::nMachineMisses() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsMachineMisses;
+}
+
+/// @brief number of uvw machines removed from the cache
+casacore::uInt64 IteratorStatistics::nMachineEvictions() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsMachineEvictions;
+}
+
+/// @brief name of the operation
+/// @param[in] stage operation
+/// @return the name used in the log
+std::string IteratorStatistics::stageName(Stage stage)
+{
+  switch (stage) {
+     case FILL_CUBE:
+          return "fillCube";
+     case FILL_NOISE:
+          return "fillNoise";
+     case FILL_UVW:
+          return "fillUVW";
+     case SET_UP_ITERATION:
+          return "setUpIteration";
+     case FILL_DIRECTION:
+          return "fillDirection";
+     case FILL_PARALLACTIC_ANGLE:
+          return "fillParallacticAngle";
+     default:
+          ASKAPTHROW(AskapError, "Unknown stage "<<int(stage));
+  }
+  return "";
+}
+
+/// @brief write the statistics into the log
+/// @details This method is intended to be called at the end of the job, the
+/// summary is written at the INFO level.
+void IteratorStatistics::log() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  ASKAPLOG_INFO_STR(logger, "Iterator statistics: "<<itsChunks<<" chunk(s), "<<itsRows<<" row(s)");
+  for (std::map<std::string, casacore::uInt64>::const_iterator ci = itsBytesRead.begin();
+       ci != itsBytesRead.end(); ++ci) {
+       ASKAPLOG_INFO_STR(logger, "  read "<<ci->second<<" bytes from "<<ci->first);
+  }
+  for (std::map<std::string, casacore::uInt64>::const_iterator ci = itsBytesWritten.begin();
+       ci != itsBytesWritten.end(); ++ci) {
+       ASKAPLOG_INFO_STR(logger, "  written "<<ci->second<<" bytes to "<<ci->first);
+  }
+  for (int stage = 0; stage < N_STAGES; ++stage) {
+       if (itsCalls[stage] > 0) {
+           ASKAPLOG_INFO_STR(logger, "  "<<stageName(Stage(stage))<<": "<<itsTimes[stage]<<
+                             " s in "<<itsCalls[stage]<<" call(s)");
+       }
+  }
+  ASKAPLOG_INFO_STR(logger, "  accessor fields: "<<nCacheFills()<<" read(s) on demand, "<<
+                    nCacheHits()<<" cache hit(s)");
+  ASKAPLOG_INFO_STR(logger, "  uvw machines: "<<itsMachineHits<<" hit(s), "<<itsMachineMisses<<
+                    " miss(es), "<<itsMachineEvictions<<" eviction(s)");
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,253 @@
+/// @file
+/// @brief I/O and cache statistics of table-based iterators
+/// @details This class accumulates the number of bytes read and written per
+/// column, the time spent in the main fill methods of the iterator, the number
+/// of chunks and rows as well as the cache efficiency counters. It is attached
+/// to iterators on request (see TableConstDataSource::configureStatistics), so
+/// the counters cost nothing otherwise.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_ITERATOR_STATISTICS_H
+#define ASKAP_ACCESSORS_ITERATOR_STATISTICS_H
+
+// std includes
+#include <atomic>
+#include <map>
+#include <string>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief I/O and cache statistics of table-based iterators
+/// @details One object can be shared by a number of iterators (e.g. all iterators
+/// created by the same data source), then it accumulates the totals. All methods are
+/// thread-safe as the bulk data can be read in the background (see TableChunkPrefetcher).
+/// Byte counts correspond to the size of the data obtained from or passed to the column,
+/// rows skipped due to row-based flagging are included. Buffers of the read-write
+/// iterator are accounted under their names. Times are wall clock times and
+/// are inclusive, i.e. the time of parallactic angle fills done for a direction fill is
+/// included in both. Methods which update the statistics are called by the iterator
+/// and the caches, the user code normally needs the getters and log only.
+/// @ingroup dataaccess_hlp
+class IteratorStatistics : private boost::noncopyable
+{
+public:
+  /// @brief timed operations
+  enum Stage {
+     /// @brief read of a visibility or flag cube (fillCube)
+     FILL_CUBE = 0,
+     /// @brief read of noise figures (fillNoise)
+     FILL_NOISE,
+     /// @brief read of uvw (fillUVW)
+     FILL_UVW,
+     /// @brief set up of a new iteration of the table iterator (setUpIteration)
+     SET_UP_ITERATION,
+     /// @brief computation of the pointing directions
+     FILL_DIRECTION,
+     /// @brief computation of the parallactic angles
+     FILL_PARALLACTIC_ANGLE,
+     /// @brief number of stages, should be the last
+     N_STAGES
+  };
+
+  /// @brief helper class timing a block of code
+  /// @details The time between construction and destruction is added to the
+  /// given stage. Nothing is done if the statistics pointer is zero, so the
+  /// timer can be used unconditionally.
+  class ScopedTimer : private boost::noncopyable {
+  public:
+     /// @brief start the timer
+     /// @param[in] stats statistics to update (may be zero)
+     /// @param[in] stage operation being timed
+     ScopedTimer(IteratorStatistics *stats, Stage stage);
+
+     /// @brief stop the timer and update the statistics
+     ~ScopedTimer();
+  private:
+     /// @brief statistics to update, zero if disabled
+     IteratorStatistics *itsStatistics;
+     /// @brief operation being timed
+     Stage itsStage;
+     /// @brief start time
+     boost::posix_time::ptime itsStart;
+  };
+
+  /// @brief construct an object with all counters set to zero
+  IteratorStatistics();
+
+  /// @brief reset all counters to zero
+  void reset();
+
+  /// @brief account for the data read from a column
+  /// @param[in] column column name
+  /// @param[in] bytes number of bytes
+  void addRead(const std::string &column, casacore::uInt64 bytes);
+
+  /// @brief account for the data written to a column
+  /// @param[in] column column name
+  /// @param[in] bytes number of bytes
+  void addWrite(const std::string &column, casacore::uInt64 bytes);
+
+  /// @brief account for the time spent in an operation
+  /// @param[in] stage operation
+  /// @param[in] seconds wall clock time in seconds
+  void addTime(Stage stage, double seconds);
+
+  /// @brief account for a new chunk delivered by the iterator
+  /// @param[in] nRow number of rows in the chunk
+  void addChunk(casacore::uInt nRow);
+
+  /// @brief account for a read on demand of an accessor field
+  /// @details This method doesn't lock the mutex, the counter is atomic.
+  void cacheFill();
+
+  /// @brief account for an accessor field served from the cache
+  /// @details This method doesn't lock the mutex as it is called on the lock-free
+  /// path of CachedAccessorField::value, the counter is atomic.
+  void cacheHit();
+
+  /// @brief account for a uvw machine found in the cache
+  void machineHit();
+
+  /// @brief account for a uvw machine which had to be set up
+  void machineMiss();
+
+  /// @brief account for a uvw machine removed from the cache to make room for another
+  void machineEviction();
+
+  /// @brief bytes read from the given column
+  /// @param[in] column column name
+  /// @return number of bytes
+  casacore::uInt64 bytesRead(const std::string &column) const;
+
+  /// @brief bytes written to the given column
+  /// @param[in] column column name
+  /// @return number of bytes
+  casacore::uInt64 bytesWritten(const std::string &column) const;
+
+  /// @brief bytes read from all columns
+  /// @return number of bytes
+  casacore::uInt64 totalBytesRead() const;
+
+  /// @brief bytes written to all columns
+  /// @return number of bytes
+  casacore::uInt64 totalBytesWritten() const;
+
+  /// @brief time spent in the given operation
+  /// @param[in] stage operation
+  /// @return wall clock time in seconds
+  double time(Stage stage) const;
+
+  /// @brief number of times the given operation has been done
+  /// @param[in] stage operation
+  /// @return number of calls
+  casacore::uInt64 nCalls(Stage stage) const;
+
+  /// @brief number of chunks delivered
+  casacore::uInt64 nChunks() const;
+
+  /// @brief number of rows delivered (summed over all chunks)
+  casacore::uInt64 nRows() const;
+
+  /// @brief number of reads on demand of the accessor fields
+  casacore::uInt64 nCacheFills() const;
+
+  /// @brief number of accessor fields served from the cache
+  casacore::uInt64 nCacheHits() const;
+
+  /// @brief number of uvw machines found in the cache
+  casacore::uInt64 nMachineHits() const;
+
+  /// @brief number of uvw machines set up
+  casacore::uInt64 nMachineMisses() const;
+
+  /// @brief number of uvw machines removed from the cache
+  casacore::uInt64 nMachineEvictions() const;
+
+  /// @brief name of the operation
+  /// @param[in] stage operation
+  /// @return the name used in the log
+  static std::string stageName(Stage stage);
+
+  /// @brief write the statistics into the log
+  /// @details This method is intended to be called at the end of the job, the
+  /// summary is written at the INFO level.
+  void log() const;
+
+private:
+  /// @brief bytes read per column
+  std::map<std::string, casacore::uInt64> itsBytesRead;
+
+  /// @brief bytes written per column
+  std::map<std::string, casacore::uInt64> itsBytesWritten;
+
+  /// @brief time in seconds per operation
+  double itsTimes[N_STAGES];
+
+  /// @brief number of calls per operation
+  casacore::uInt64 itsCalls[N_STAGES];
+
+  /// @brief number of chunks
+  casacore::uInt64 itsChunks;
+
+  /// @brief number of rows
+  casacore::uInt64 itsRows;
+
+  /// @brief number of reads on demand of accessor fields
+  /// @details Updated without the mutex, relaxed ordering is enough for a counter
+  std::atomic<casacore::uInt64> itsCacheFills;
+
+  /// @brief number of accessor fields served from the cache
+  /// @details Updated without the mutex, relaxed ordering is enough for a counter
+  std::atomic<casacore::uInt64> itsCacheHits;
+
+  /// @brief number of uvw machines found in the cache
+  casacore::uInt64 itsMachineHits;
+
+  /// @brief number of uvw machines set up
+  casacore::uInt64 itsMachineMisses;
+
+  /// @brief number of uvw machines removed from the cache
+  casacore::uInt64 itsMachineEvictions;
+
+  /// @brief mutex protecting the counters (except the atomic ones)
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ITERATOR_STATISTICS_H
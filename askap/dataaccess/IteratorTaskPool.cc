@@ -0,0 +1,102 @@
+/// @file
+/// @brief small pool of threads executing iterator steps
+/// @details This class runs queued tasks on a fixed number of threads. It is used by
+/// AsyncDataIterator, so I/O of many iterators can overlap without a dedicated thread 
+/// per iterator.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/IteratorTaskPool.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief start the worker threads
+/// @param[in] nThreads number of threads
+IteratorTaskPool::IteratorTaskPool(size_t nThreads) : itsStopping(false)
+{
+  ASKAPCHECK(nThreads > 0, "IteratorTaskPool requires at least one thread");
+  for (size_t thread = 0; thread < nThreads; ++thread) {
+       itsThreads.create_thread(boost::bind(&IteratorTaskPool::run, this));
+  }
+}
+
+/// @brief complete all queued tasks and stop the worker threads
+IteratorTaskPool::~IteratorTaskPool()
+{
+  {
+    boost::mutex::scoped_lock lock(itsMutex);
+    itsStopping = true;
+  }
+  itsChanged.notify_all();
+  itsThreads.join_all();
+}
+
+/// @brief queue a task
+/// @param[in] task task to execute
+void IteratorTaskPool::submit(const Task &task)
+{
+  ASKAPDEBUGASSERT(task);
+  {
+    boost::mutex::scoped_lock lock(itsMutex);
+    ASKAPCHECK(!itsStopping, "IteratorTaskPool::submit is called while the pool is being destroyed");
+    itsTasks.push_back(task);
+  }
+  itsChanged.notify_one();
+}
+
+/// @brief body of the worker threads
+void IteratorTaskPool::run()
+{
+  for (;;) {
+       Task task;
+       {
+         boost::mutex::scoped_lock lock(itsMutex);
+         while (itsTasks.empty() && !itsStopping) {
+                itsChanged.wait(lock);
+         }
+         if (itsTasks.empty()) {
+             return;
+         }
+         task = itsTasks.front();
+         itsTasks.pop_front();
+       }
+       try {
+          task();
+       }
+       catch (...) {
+          // tasks are responsible for reporting their errors
+       }
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,99 @@
+/// @file
+/// @brief small pool of threads executing iterator steps
+/// @details This class runs queued tasks on a fixed number of threads. It is used by
+/// AsyncDataIterator, so I/O of many iterators can overlap without a dedicated thread 
+/// per iterator.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_ITERATOR_TASK_POOL_H
+#define ASKAP_ACCESSORS_ITERATOR_TASK_POOL_H
+
+// std includes
+#include <deque>
+
+// boost includes
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/utility.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief small pool of threads executing iterator steps
+/// @details Tasks are executed in the order they were submitted, but tasks may run in 
+/// parallel on different threads. Tasks should not throw, exceptions are caught and ignored
+/// to keep the worker threads alive (AsyncDataIterator passes them to the future instead). 
+/// The destructor waits until all queued tasks are complete.
+/// @ingroup dataaccess_hlp
+class IteratorTaskPool : private boost::noncopyable {
+public:
+  /// @brief type of the task
+  typedef boost::function<void()> Task;
+
+  /// @brief start the worker threads
+  /// @param[in] nThreads number of threads
+  explicit IteratorTaskPool(size_t nThreads = 1);
+
+  /// @brief complete all queued tasks and stop the worker threads
+  ~IteratorTaskPool();
+
+  /// @brief queue a task
+  /// @param[in] task task to execute
+  void submit(const Task &task);
+
+  /// @brief number of worker threads
+  /// @return number of threads in the pool
+  inline size_t nThreads() const { return itsThreads.size(); }
+
+protected:
+  /// @brief body of the worker threads
+  void run();
+
+private:
+  /// @brief queued tasks
+  std::deque<Task> itsTasks;
+
+  /// @brief true, if the pool is being destroyed
+  bool itsStopping;
+
+  /// @brief mutex protecting the queue
+  boost::mutex itsMutex;
+
+  /// @brief condition signalled when a task is queued or the pool is stopping
+  boost::condition_variable itsChanged;
+
+  /// @brief worker threads
+  boost::thread_group itsThreads;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ITERATOR_TASK_POOL_H
@@ -0,0 +1,484 @@
+/// @file
+/// @brief index of the main table rows by the commonly selected columns
+/// @details Selection by feed, baseline, spectral window or time range is done via
+/// table expressions, which casacore evaluates for every row of the measurement set
+/// each time an iterator is created. This becomes expensive when the same large
+/// measurement set is iterated over many times with different selections (e.g. in
+/// a loop over beams). This class reads TIME, FEED1, FEED2, ANTENNA1, ANTENNA2 and
+/// DATA_DESC_ID columns once and keeps row lists for each feed, baseline, antenna and
+/// data description, so such selections are resolved into row numbers directly.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/MainTableRowIndex.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/Matrix.h>
+
+// std includes
+#include <algorithm>
+#include <limits>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief comparison of rows by time used for the binary search
+struct TimeOrder {
+  /// @brief construct the object
+  /// @param[in] time TIME column
+  explicit TimeOrder(const casacore::Vector<casacore::Double> &time) : itsTime(time) {}
+
+  /// @brief compare row time with a value
+  bool operator()(casacore::uInt row, casacore::Double time) const { return itsTime[row] < time; } 
+
+  /// @brief compare a value with row time
+  bool operator()(casacore::Double time, casacore::uInt row) const { return time < itsTime[row]; } 
+
+  /// @brief compare two rows
+  bool operator()(casacore::uInt row1, casacore::uInt row2) const { return itsTime[row1] < itsTime[row2]; } 
+
+  /// @brief TIME column
+  const casacore::Vector<casacore::Double> &itsTime;
+};
+
+} // anonymous namespace
+
+/// @brief construct criteria selecting all rows
+MainTableRowIndex::Criteria::Criteria() : itsUsable(true) {}
+
+/// @brief add a criterion
+/// @param[in] kind type of the criterion
+/// @param[in] par1 first parameter
+/// @param[in] par2 second parameter
+/// @param[in] par3 third parameter
+/// @return a reference to the criterion added
+MainTableRowIndex::Criteria::Criterion& MainTableRowIndex::Criteria::add(Kind kind, 
+                     casacore::Int par1, casacore::Int par2, casacore::Int par3)
+{
+  itsCriteria.push_back(Criterion());
+  Criterion &criterion = itsCriteria.back();
+  criterion.itsKind = kind;
+  criterion.itsParameters[0] = par1;
+  criterion.itsParameters[1] = par2;
+  criterion.itsParameters[2] = par3;
+  criterion.itsTimeRange = std::make_pair(0., 0.);
+  criterion.itsUVRange = std::make_pair(0., 0.);
+  return criterion;
+}
+
+/// @brief choose a single feed, the same for both antennae
+/// @param[in] feed feed ID
+void MainTableRowIndex::Criteria::chooseFeed(casacore::Int feed)
+{
+  add(FEED, feed);
+}
+
+/// @brief choose a single baseline
+/// @param[in] ant1 first antenna
+/// @param[in] ant2 second antenna
+void MainTableRowIndex::Criteria::chooseBaseline(casacore::Int ant1, casacore::Int ant2)
+{
+  add(BASELINE, ant1, ant2);
+}
+
+/// @brief choose all baselines to the given antenna
+/// @param[in] ant antenna ID
+void MainTableRowIndex::Criteria::chooseAntenna(casacore::Int ant)
+{
+  add(ANTENNA, ant);
+}
+
+/// @brief choose a set of baselines
+/// @param[in] baselines pairs of the first and second antenna (empty vector selects nothing)
+void MainTableRowIndex::Criteria::chooseBaselines(const std::vector<std::pair<casacore::Int, 
+                                                  casacore::Int> > &baselines)
+{
+  std::vector<std::pair<casacore::Int, casacore::Int> > &sorted = add(BASELINE_SET).itsBaselines;
+  sorted = baselines;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+}
+
+/// @brief choose all baselines to any of the given antennae
+/// @param[in] antennas antenna IDs (empty vector selects nothing)
+void MainTableRowIndex::Criteria::chooseAntennas(const std::vector<casacore::Int> &antennas)
+{
+  std::vector<casacore::Int> &sorted = add(ANTENNA_SET).itsIDs;
+  sorted = antennas;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+}
+
+/// @brief choose rows with the uv-distance not less than the threshold
+/// @param[in] uvDist threshold (in metres)
+void MainTableRowIndex::Criteria::chooseMinUVDistance(casacore::Double uvDist)
+{
+  // squared distances are compared, a negative threshold accepts everything
+  add(UV_DISTANCE).itsUVRange = std::make_pair(uvDist > 0. ? uvDist * uvDist : -1., 
+                                 std::numeric_limits<casacore::Double>::max());
+}
+
+/// @brief choose rows with the uv-distance not greater than the threshold
+/// @param[in] uvDist threshold (in metres)
+void MainTableRowIndex::Criteria::chooseMaxUVDistance(casacore::Double uvDist)
+{
+  // squared distances are compared, a negative threshold rejects everything
+  add(UV_DISTANCE).itsUVRange = std::make_pair(-1., uvDist >= 0. ? uvDist * uvDist : -1.);
+}
+
+/// @brief choose autocorrelations only
+void MainTableRowIndex::Criteria::chooseAutoCorrelations()
+{
+  add(AUTO_CORRELATIONS);
+}
+
+/// @brief choose cross-correlations only
+void MainTableRowIndex::Criteria::chooseCrossCorrelations()
+{
+  add(CROSS_CORRELATIONS);
+}
+
+/// @brief choose a set of data description IDs
+/// @param[in] ids data description IDs to choose (empty vector selects nothing)
+void MainTableRowIndex::Criteria::chooseDataDescIDs(const std::vector<casacore::Int> &ids)
+{
+  add(DATA_DESC_IDS).itsIDs = ids;
+}
+
+/// @brief choose a subset of feeds (FEED1 modulo nParts equals part)
+/// @param[in] part partition number
+/// @param[in] nParts number of partitions
+void MainTableRowIndex::Criteria::chooseFeedPartition(casacore::Int part, casacore::Int nParts)
+{
+  ASKAPDEBUGASSERT(nParts > 0);
+  add(FEED_PARTITION, part, nParts);
+}
+
+/// @brief choose a subset of baselines
+/// @details (ANTENNA1 * nAnt + ANTENNA2) modulo nParts should be equal to part
+/// @param[in] part partition number
+/// @param[in] nParts number of partitions
+/// @param[in] nAnt number of antennae
+void MainTableRowIndex::Criteria::chooseBaselinePartition(casacore::Int part, casacore::Int nParts, 
+                                                          casacore::Int nAnt)
+{
+  ASKAPDEBUGASSERT(nParts > 0);
+  add(BASELINE_PARTITION, part, nParts, nAnt);
+}
+
+/// @brief choose a time range
+/// @details Both ends are excluded, like in the table expression formed by
+/// TableTimeStampSelector.
+/// @param[in] start start time (in the units and frame of the TIME column)
+/// @param[in] stop stop time (in the units and frame of the TIME column)
+void MainTableRowIndex::Criteria::chooseTimeRange(casacore::Double start, casacore::Double stop)
+{
+  add(TIME_RANGE).itsTimeRange = std::make_pair(start, stop);
+}
+
+/// @brief mark criteria as not resolvable via the index
+/// @details This method is called if the selection involves columns which 
+/// are not indexed.
+void MainTableRowIndex::Criteria::disable()
+{
+  itsUsable = false;
+  itsCriteria.clear();
+}
+
+/// @brief check whether only a time range is selected
+/// @details Such selection can be resolved via TimeColumnIndex if the rows
+/// are in the time order.
+/// @param[out] range start and stop times (unchanged, if false is returned)
+/// @return true, if the criteria are usable and consist of a single time range
+bool MainTableRowIndex::Criteria::timeRangeOnly(std::pair<casacore::Double, casacore::Double> &range) const
+{
+  if (!itsUsable || (itsCriteria.size() != 1) || (itsCriteria[0].itsKind != TIME_RANGE)) {
+      return false;
+  }
+  range = itsCriteria[0].itsTimeRange;
+  return true;
+}
+
+/// @brief build the index
+/// @param[in] ms measurement set (main table)
+MainTableRowIndex::MainTableRowIndex(const casacore::Table &ms)
+{
+  casacore::ROScalarColumn<casacore::Double>(ms, "TIME").getColumn(itsTime, casacore::True);
+  casacore::ROScalarColumn<casacore::Int>(ms, "FEED1").getColumn(itsFeed1, casacore::True);
+  casacore::ROScalarColumn<casacore::Int>(ms, "FEED2").getColumn(itsFeed2, casacore::True);
+  casacore::ROScalarColumn<casacore::Int>(ms, "ANTENNA1").getColumn(itsAntenna1, casacore::True);
+  casacore::ROScalarColumn<casacore::Int>(ms, "ANTENNA2").getColumn(itsAntenna2, casacore::True);
+  casacore::ROScalarColumn<casacore::Int>(ms, "DATA_DESC_ID").getColumn(itsDataDescID, casacore::True);
+  const casacore::uInt nRow = itsTime.nelements();
+  // only u^2 + v^2 is kept, so the uv-distance selection needs no square roots
+  const casacore::Matrix<casacore::Double> uvw = casacore::ROArrayColumn<casacore::Double>(ms, "UVW").getColumn();
+  ASKAPCHECK((uvw.nrow() >= 2) && (uvw.ncolumn() == nRow), "Unexpected shape of the UVW column: "<<uvw.shape());
+  itsUVDistSquared.resize(nRow);
+  itsTimeOrder.resize(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       if (itsFeed1[row] == itsFeed2[row]) {
+           itsFeedRows[itsFeed1[row]].push_back(row);
+       }
+       itsBaselineRows[std::make_pair(itsAntenna1[row], itsAntenna2[row])].push_back(row);
+       itsAntennaRows[itsAntenna1[row]].push_back(row);
+       if (itsAntenna2[row] != itsAntenna1[row]) {
+           itsAntennaRows[itsAntenna2[row]].push_back(row);
+       }
+       itsDataDescRows[itsDataDescID[row]].push_back(row);
+       itsUVDistSquared[row] = uvw(0, row) * uvw(0, row) + uvw(1, row) * uvw(1, row);
+       itsTimeOrder[row] = row;
+  }
+  // normally rows are already in time order, stable sort is cheap in this case 
+  std::stable_sort(itsTimeOrder.begin(), itsTimeOrder.end(), TimeOrder(itsTime));
+}
+
+/// @brief obtain the row list for a key
+/// @param[in] lists map of row lists
+/// @param[in] key key of interest
+/// @return row list (empty list if the key is not present)
+template<typename Key>
+const MainTableRowIndex::RowList& MainTableRowIndex::rowList(const std::map<Key, RowList> &lists, 
+                                                              const Key &key)
+{
+  static const RowList emptyList;
+  const typename std::map<Key, RowList>::const_iterator ci = lists.find(key);
+  return ci != lists.end() ? ci->second : emptyList;
+}
+
+/// @brief check whether the row satisfies a criterion
+/// @param[in] criterion criterion to check
+/// @param[in] row row number
+/// @return true if the criterion is satisfied
+bool MainTableRowIndex::matches(const Criteria::Criterion &criterion, casacore::uInt row) const
+{
+  const casacore::Int *par = criterion.itsParameters;
+  switch (criterion.itsKind) {
+     case Criteria::FEED: 
+          return (itsFeed1[row] == par[0]) && (itsFeed2[row] == par[0]);
+     case Criteria::BASELINE:
+          return (itsAntenna1[row] == par[0]) && (itsAntenna2[row] == par[1]);
+     case Criteria::ANTENNA:
+          return (itsAntenna1[row] == par[0]) || (itsAntenna2[row] == par[0]);
+     case Criteria::AUTO_CORRELATIONS:
+          return (itsAntenna1[row] == itsAntenna2[row]) && (itsFeed1[row] == itsFeed2[row]);
+     case Criteria::CROSS_CORRELATIONS:
+          return (itsAntenna1[row] != itsAntenna2[row]) || (itsFeed1[row] != itsFeed2[row]);
+     case Criteria::DATA_DESC_IDS:
+          return std::find(criterion.itsIDs.begin(), criterion.itsIDs.end(), itsDataDescID[row]) != 
+                 criterion.itsIDs.end();
+     case Criteria::FEED_PARTITION:
+          return itsFeed1[row] % par[1] == par[0];
+     case Criteria::BASELINE_PARTITION:
+          return (itsAntenna1[row] * par[2] + itsAntenna2[row]) % par[1] == par[0];
+     case Criteria::TIME_RANGE:
+          return (itsTime[row] > criterion.itsTimeRange.first) && 
+                 (itsTime[row] < criterion.itsTimeRange.second);
+     case Criteria::BASELINE_SET:
+          return std::binary_search(criterion.itsBaselines.begin(), criterion.itsBaselines.end(),
+                                    std::make_pair(itsAntenna1[row], itsAntenna2[row]));
+     case Criteria::ANTENNA_SET:
+          return std::binary_search(criterion.itsIDs.begin(), criterion.itsIDs.end(), itsAntenna1[row]) ||
+                 std::binary_search(criterion.itsIDs.begin(), criterion.itsIDs.end(), itsAntenna2[row]);
+     case Criteria::UV_DISTANCE:
+          return (itsUVDistSquared[row] >= criterion.itsUVRange.first) &&
+                 (itsUVDistSquared[row] <= criterion.itsUVRange.second);
+  };
+  ASKAPTHROW(AskapError, "Unknown selection criterion type "<<criterion.itsKind);
+}
+
+/// @brief obtain candidate rows for a criterion
+/// @details Rows which can match the given criterion are returned, if they
+/// can be found without checking all rows
+/// @param[in] criterion criterion to process
+/// @param[out] rows candidate rows in the ascending order
+/// @return false if all rows have to be checked for this criterion
+bool MainTableRowIndex::candidates(const Criteria::Criterion &criterion, RowList &rows) const
+{
+  const casacore::Int *par = criterion.itsParameters;
+  switch (criterion.itsKind) {
+     case Criteria::FEED:
+          rows = rowList(itsFeedRows, par[0]);
+          return true;
+     case Criteria::BASELINE:
+          rows = rowList(itsBaselineRows, std::make_pair(par[0], par[1]));
+          return true;
+     case Criteria::ANTENNA:
+          rows = rowList(itsAntennaRows, par[0]);
+          return true;
+     case Criteria::DATA_DESC_IDS:
+          rows.clear();
+          for (std::vector<casacore::Int>::const_iterator ci = criterion.itsIDs.begin(); 
+               ci != criterion.itsIDs.end(); ++ci) {
+               const RowList &current = rowList(itsDataDescRows, *ci);
+               rows.insert(rows.end(), current.begin(), current.end());
+          }
+          std::sort(rows.begin(), rows.end());
+          // the same ID could be given twice
+          rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+          return true;
+     case Criteria::TIME_RANGE:
+          {
+            const TimeOrder order(itsTime);
+            const RowList::const_iterator first = std::upper_bound(itsTimeOrder.begin(), 
+                         itsTimeOrder.end(), criterion.itsTimeRange.first, order);
+            const RowList::const_iterator last = std::lower_bound(first, itsTimeOrder.end(), 
+                         criterion.itsTimeRange.second, order);
+            rows.assign(first, last);
+            std::sort(rows.begin(), rows.end());
+          }
+          return true;
+     case Criteria::BASELINE_SET:
+          rows.clear();
+          for (std::vector<std::pair<casacore::Int, casacore::Int> >::const_iterator ci = 
+               criterion.itsBaselines.begin(); ci != criterion.itsBaselines.end(); ++ci) {
+               const RowList &current = rowList(itsBaselineRows, *ci);
+               rows.insert(rows.end(), current.begin(), current.end());
+          }
+          // lists of different baselines don't overlap
+          std::sort(rows.begin(), rows.end());
+          return true;
+     case Criteria::ANTENNA_SET:
+          rows.clear();
+          for (std::vector<casacore::Int>::const_iterator ci = criterion.itsIDs.begin(); 
+               ci != criterion.itsIDs.end(); ++ci) {
+               const RowList &current = rowList(itsAntennaRows, *ci);
+               rows.insert(rows.end(), current.begin(), current.end());
+          }
+          // the baseline between two chosen antennae is in both lists
+          std::sort(rows.begin(), rows.end());
+          rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+          return true;
+     default:
+          return false;
+  };
+}
+
+/// @brief apply a criterion to all rows
+/// @details This is the bulk version of matches used if none of the criteria 
+/// gives a list of candidate rows. The loops over the columns have no branches
+/// for the common criteria, so the compiler can vectorise them.
+/// @param[in] criterion criterion to apply
+/// @param[in,out] mask one element per row, set to zero for rows not satisfying the criterion
+void MainTableRowIndex::filter(const Criteria::Criterion &criterion, std::vector<casacore::uChar> &mask) const
+{
+  const casacore::uInt nRow = nrow();
+  ASKAPDEBUGASSERT(mask.size() == nRow);
+  if (nRow == 0) {
+      return;
+  }
+  casacore::uChar *maskPtr = &mask[0];
+  const casacore::Int *ant1 = itsAntenna1.data();
+  const casacore::Int *ant2 = itsAntenna2.data();
+  const casacore::Int *feed1 = itsFeed1.data();
+  const casacore::Int *feed2 = itsFeed2.data();
+  switch (criterion.itsKind) {
+     case Criteria::UV_DISTANCE:
+          {
+            const casacore::Double *uvDistSq = itsUVDistSquared.data();
+            const casacore::Double minSq = criterion.itsUVRange.first;
+            const casacore::Double maxSq = criterion.itsUVRange.second;
+            for (casacore::uInt row = 0; row < nRow; ++row) {
+                 maskPtr[row] &= static_cast<casacore::uChar>((uvDistSq[row] >= minSq) & 
+                                                              (uvDistSq[row] <= maxSq));
+            }
+          }
+          return;
+     case Criteria::AUTO_CORRELATIONS:
+          for (casacore::uInt row = 0; row < nRow; ++row) {
+               maskPtr[row] &= static_cast<casacore::uChar>((ant1[row] == ant2[row]) & 
+                                                            (feed1[row] == feed2[row]));
+          }
+          return;
+     case Criteria::CROSS_CORRELATIONS:
+          for (casacore::uInt row = 0; row < nRow; ++row) {
+               maskPtr[row] &= static_cast<casacore::uChar>((ant1[row] != ant2[row]) | 
+                                                            (feed1[row] != feed2[row]));
+          }
+          return;
+     default:
+          for (casacore::uInt row = 0; row < nRow; ++row) {
+               if (maskPtr[row] && !matches(criterion, row)) {
+                   maskPtr[row] = 0;
+               }
+          }
+  };
+}
+
+/// @brief select rows
+/// @param[in] criteria selection criteria (should be usable)
+/// @param[out] rows selected row numbers in the ascending order (resized)
+void MainTableRowIndex::select(const Criteria &criteria, casacore::Vector<casacore::uInt> &rows) const
+{
+  ASKAPCHECK(criteria.usable(), "Attempt to use a selection which can't be resolved via the row index");
+  // start from the shortest list of candidates
+  bool haveCandidates = false;
+  RowList best;
+  RowList current;
+  for (std::vector<Criteria::Criterion>::const_iterator ci = criteria.itsCriteria.begin();
+       ci != criteria.itsCriteria.end(); ++ci) {
+       if (candidates(*ci, current) && (!haveCandidates || (current.size() < best.size()))) {
+           best.swap(current);
+           haveCandidates = true;
+       }
+  }
+  RowList selected;
+  if (haveCandidates) {
+      selected.reserve(best.size());
+      for (RowList::const_iterator rowIt = best.begin(); rowIt != best.end(); ++rowIt) {
+           bool accept = true;
+           for (std::vector<Criteria::Criterion>::const_iterator ci = criteria.itsCriteria.begin();
+                accept && (ci != criteria.itsCriteria.end()); ++ci) {
+                accept = matches(*ci, *rowIt);
+           }
+           if (accept) {
+               selected.push_back(*rowIt);
+           }
+      }
+  } else {
+      // all rows have to be checked, apply the criteria to the whole columns at once
+      std::vector<casacore::uChar> mask(nrow(), 1);
+      for (std::vector<Criteria::Criterion>::const_iterator ci = criteria.itsCriteria.begin();
+           ci != criteria.itsCriteria.end(); ++ci) {
+           filter(*ci, mask);
+      }
+      selected.reserve(nrow());
+      for (casacore::uInt row = 0; row < nrow(); ++row) {
+           if (mask[row]) {
+               selected.push_back(row);
+           }
+      }
+  }
+  rows.resize(selected.size());
+  for (size_t index = 0; index < selected.size(); ++index) {
+       rows[index] = selected[index];
+  }
+}
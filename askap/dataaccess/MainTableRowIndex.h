@@ -0,0 +1,293 @@
+/// @file
+/// @brief index of the main table rows by the commonly selected columns
+/// @details Selection by feed, baseline, spectral window or time range is done via
+/// table expressions, which casacore evaluates for every row of the measurement set
+/// each time an iterator is created. This becomes expensive when the same large
+/// measurement set is iterated over many times with different selections (e.g. in
+/// a loop over beams). This class reads TIME, FEED1, FEED2, ANTENNA1, ANTENNA2 and
+/// DATA_DESC_ID columns once and keeps row lists for each feed, baseline, antenna and
+/// data description, so such selections are resolved into row numbers directly.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_MAIN_TABLE_ROW_INDEX_H
+#define ASKAP_ACCESSORS_MAIN_TABLE_ROW_INDEX_H
+
+// std includes
+#include <map>
+#include <utility>
+#include <vector>
+
+// boost includes
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/tables/Tables/Table.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief index of the main table rows by the commonly selected columns
+/// @details The index is built once per measurement set (see 
+/// ISubtableInfoHolder::getRowIndex) and doesn't change afterwards, so it can be
+/// shared between iterators and threads. Only the selections which can be expressed
+/// via the indexed columns are supported, they are described by the Criteria class.
+/// The rows are selected starting from the shortest of the row lists matching the 
+/// individual criteria, the remaining criteria are checked for these rows only.
+/// If none of the criteria has such a list (e.g. for the uv-distance selection), 
+/// the criteria are applied to the whole columns held in memory to form a row mask.
+/// @ingroup dataaccess_tab
+class MainTableRowIndex : private boost::noncopyable {
+public:
+
+  /// @brief selection criteria which can be resolved by the index
+  /// @details All criteria added to this object should be satisfied simultaneously
+  /// (i.e. they are and'ed, like the table expressions built by the selector).
+  /// A selection which can't be done with the indexed columns makes the 
+  /// whole object unusable (see disable), and the selection has to be done via
+  /// table expression.
+  class Criteria {
+  public:
+     /// @brief construct criteria selecting all rows
+     Criteria();
+
+     /// @brief choose a single feed, the same for both antennae
+     /// @param[in] feed feed ID
+     void chooseFeed(casacore::Int feed);
+
+     /// @brief choose a single baseline
+     /// @param[in] ant1 first antenna
+     /// @param[in] ant2 second antenna
+     void chooseBaseline(casacore::Int ant1, casacore::Int ant2);
+
+     /// @brief choose all baselines to the given antenna
+     /// @param[in] ant antenna ID
+     void chooseAntenna(casacore::Int ant);
+
+     /// @brief choose a set of baselines
+     /// @param[in] baselines pairs of the first and second antenna (empty vector selects nothing)
+     void chooseBaselines(const std::vector<std::pair<casacore::Int, casacore::Int> > &baselines);
+
+     /// @brief choose all baselines to any of the given antennae
+     /// @param[in] antennas antenna IDs (empty vector selects nothing)
+     void chooseAntennas(const std::vector<casacore::Int> &antennas);
+
+     /// @brief choose rows with the uv-distance not less than the threshold
+     /// @param[in] uvDist threshold (in metres)
+     void chooseMinUVDistance(casacore::Double uvDist);
+
+     /// @brief choose rows with the uv-distance not greater than the threshold
+     /// @param[in] uvDist threshold (in metres)
+     void chooseMaxUVDistance(casacore::Double uvDist);
+
+     /// @brief choose autocorrelations only
+     void chooseAutoCorrelations();
+
+     /// @brief choose cross-correlations only
+     void chooseCrossCorrelations();
+
+     /// @brief choose a set of data description IDs
+     /// @param[in] ids data description IDs to choose (empty vector selects nothing)
+     void chooseDataDescIDs(const std::vector<casacore::Int> &ids);
+
+     /// @brief choose a subset of feeds (FEED1 modulo nParts equals part)
+     /// @param[in] part partition number
+     /// @param[in] nParts number of partitions
+     void chooseFeedPartition(casacore::Int part, casacore::Int nParts);
+
+     /// @brief choose a subset of baselines
+     /// @details (ANTENNA1 * nAnt + ANTENNA2) modulo nParts should be equal to part
+     /// @param[in] part partition number
+     /// @param[in] nParts number of partitions
+     /// @param[in] nAnt number of antennae
+     void chooseBaselinePartition(casacore::Int part, casacore::Int nParts, casacore::Int nAnt);
+
+     /// @brief choose a time range
+     /// @details Both ends are excluded, like in the table expression formed by
+     /// TableTimeStampSelector.
+     /// @param[in] start start time (in the units and frame of the TIME column)
+     /// @param[in] stop stop time (in the units and frame of the TIME column)
+     void chooseTimeRange(casacore::Double start, casacore::Double stop);
+
+     /// @brief mark criteria as not resolvable via the index
+     /// @details This method is called if the selection involves columns which 
+     /// are not indexed.
+     void disable();
+
+     /// @brief check whether the index can be used
+     /// @return true, if all criteria can be resolved via the index
+     inline bool usable() const { return itsUsable; }
+
+     /// @brief check whether only a time range is selected
+     /// @details Such selection can be resolved via TimeColumnIndex if the rows
+     /// are in the time order.
+     /// @param[out] range start and stop times (unchanged, if false is returned)
+     /// @return true, if the criteria are usable and consist of a single time range
+     bool timeRangeOnly(std::pair<casacore::Double, casacore::Double> &range) const;
+
+  protected:
+     friend class MainTableRowIndex;
+
+     /// @brief types of the individual criteria
+     enum Kind {
+        FEED,
+        BASELINE,
+        ANTENNA,
+        AUTO_CORRELATIONS,
+        CROSS_CORRELATIONS,
+        DATA_DESC_IDS,
+        FEED_PARTITION,
+        BASELINE_PARTITION,
+        TIME_RANGE,
+        BASELINE_SET,
+        ANTENNA_SET,
+        UV_DISTANCE
+     };
+
+     /// @brief single criterion
+     struct Criterion {
+        /// @brief type of the criterion
+        Kind itsKind;
+        /// @brief parameters (meaning depends on the type)
+        casacore::Int itsParameters[3];
+        /// @brief start and stop times for TIME_RANGE
+        std::pair<casacore::Double, casacore::Double> itsTimeRange;
+        /// @brief data description IDs for DATA_DESC_IDS or antenna IDs for ANTENNA_SET (sorted)
+        std::vector<casacore::Int> itsIDs;
+        /// @brief baselines for BASELINE_SET (sorted)
+        std::vector<std::pair<casacore::Int, casacore::Int> > itsBaselines;
+        /// @brief range of the squared uv-distance for UV_DISTANCE (both ends included)
+        std::pair<casacore::Double, casacore::Double> itsUVRange;
+     };
+
+     /// @brief add a criterion
+     /// @param[in] kind type of the criterion
+     /// @param[in] par1 first parameter
+     /// @param[in] par2 second parameter
+     /// @param[in] par3 third parameter
+     /// @return a reference to the criterion added
+     Criterion& add(Kind kind, casacore::Int par1 = 0, casacore::Int par2 = 0, casacore::Int par3 = 0);
+
+  private:
+     /// @brief all criteria
+     std::vector<Criterion> itsCriteria;
+
+     /// @brief true, if the selection can be resolved via the index
+     bool itsUsable;
+  };
+
+  /// @brief build the index
+  /// @param[in] ms measurement set (main table)
+  explicit MainTableRowIndex(const casacore::Table &ms);
+
+  /// @brief select rows
+  /// @param[in] criteria selection criteria (should be usable)
+  /// @param[out] rows selected row numbers in the ascending order (resized)
+  void select(const Criteria &criteria, casacore::Vector<casacore::uInt> &rows) const;
+
+  /// @brief number of rows in the index
+  /// @return number of rows in the main table at the time of construction
+  inline casacore::uInt nrow() const { return itsTime.nelements(); }
+
+protected:
+  /// @brief row list type
+  typedef std::vector<casacore::uInt> RowList;
+
+  /// @brief check whether the row satisfies a criterion
+  /// @param[in] criterion criterion to check
+  /// @param[in] row row number
+  /// @return true if the criterion is satisfied
+  bool matches(const Criteria::Criterion &criterion, casacore::uInt row) const;
+
+  /// @brief obtain candidate rows for a criterion
+  /// @details Rows which can match the given criterion are returned, if they
+  /// can be found without checking all rows
+  /// @param[in] criterion criterion to process
+  /// @param[out] rows candidate rows in the ascending order
+  /// @return false if all rows have to be checked for this criterion
+  bool candidates(const Criteria::Criterion &criterion, RowList &rows) const;
+
+  /// @brief apply a criterion to all rows
+  /// @details This is the bulk version of matches used if none of the criteria 
+  /// gives a list of candidate rows. The loops over the columns have no branches
+  /// for the common criteria, so the compiler can vectorise them.
+  /// @param[in] criterion criterion to apply
+  /// @param[in,out] mask one element per row, set to zero for rows not satisfying the criterion
+  void filter(const Criteria::Criterion &criterion, std::vector<casacore::uChar> &mask) const;
+
+  /// @brief obtain the row list for a key
+  /// @param[in] lists map of row lists
+  /// @param[in] key key of interest
+  /// @return row list (empty list if the key is not present)
+  template<typename Key>
+  static const RowList& rowList(const std::map<Key, RowList> &lists, const Key &key);
+
+private:
+  /// @brief TIME column
+  casacore::Vector<casacore::Double> itsTime;
+
+  /// @brief FEED1 column
+  casacore::Vector<casacore::Int> itsFeed1;
+
+  /// @brief FEED2 column
+  casacore::Vector<casacore::Int> itsFeed2;
+
+  /// @brief ANTENNA1 column
+  casacore::Vector<casacore::Int> itsAntenna1;
+
+  /// @brief ANTENNA2 column
+  casacore::Vector<casacore::Int> itsAntenna2;
+
+  /// @brief DATA_DESC_ID column
+  casacore::Vector<casacore::Int> itsDataDescID;
+
+  /// @brief squared uv-distance (u^2 + v^2 from the UVW column)
+  casacore::Vector<casacore::Double> itsUVDistSquared;
+
+  /// @brief rows with FEED1 == FEED2 for each feed
+  std::map<casacore::Int, RowList> itsFeedRows;
+
+  /// @brief rows for each baseline
+  std::map<std::pair<casacore::Int, casacore::Int>, RowList> itsBaselineRows;
+
+  /// @brief rows for each antenna (either in ANTENNA1 or ANTENNA2)
+  std::map<casacore::Int, RowList> itsAntennaRows;
+
+  /// @brief rows for each data description ID
+  std::map<casacore::Int, RowList> itsDataDescRows;
+
+  /// @brief row numbers sorted by time
+  RowList itsTimeOrder;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MAIN_TABLE_ROW_INDEX_H
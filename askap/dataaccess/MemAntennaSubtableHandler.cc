@@ -45,6 +45,11 @@
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
 #include <casacore/casa/Arrays/Array.h>
+#include <casacore/measures/Measures/MPosition.h>
+
+// LOFAR includes
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -81,6 +86,50 @@ MemAntennaSubtableHandler::MemAntennaSubtableHandler(const casacore::Table &ms)
 /// assumptions about ANTENNA subtable, this number is assumed to be
 /// fixed.
 /// @return total number of antennae 
+/// @brief restore the cached data from a snapshot
+/// @details This constructor reads the data written by serialise, so the
+/// ANTENNA subtable is not read (see SubtableInfoHolder::loadSnapshot)
+/// @param[in] is input blob stream
+MemAntennaSubtableHandler::MemAntennaSubtableHandler(LOFAR::BlobIStream &is) :
+       itsAllEquatorial(true)
+{
+  const int version = is.getStart("MemAntennaSubtableHandler");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the serialised MemAntennaSubtableHandler");
+  LOFAR::uint64 size = 0;
+  is >> size;
+  ASKAPCHECK(size > 0, "The serialised ANTENNA subtable is empty");
+  itsMounts.resize(size);
+  itsPositions.resize(size);
+  for (casacore::uInt ant = 0; ant < itsMounts.nelements(); ++ant) {
+       std::string mount;
+       casacore::Int refType = 0;
+       double x = 0., y = 0., z = 0.;
+       is >> mount >> refType >> x >> y >> z;
+       itsMounts[ant] = mount;
+       itsPositions[ant] = casacore::MPosition(casacore::MVPosition(x, y, z),
+                 casacore::MPosition::Ref(casacore::MPosition::Types(refType)));
+       if (mount != "EQUATORIAL" && mount != "equatorial") {
+           itsAllEquatorial = false;
+       }
+  }
+  is.getEnd();
+}
+
+/// @brief write the cached data into a snapshot
+/// @param[in] os output blob stream
+void MemAntennaSubtableHandler::serialise(LOFAR::BlobOStream &os) const
+{
+  os.putStart("MemAntennaSubtableHandler", 1);
+  os << static_cast<LOFAR::uint64>(itsMounts.nelements());
+  for (casacore::uInt ant = 0; ant < itsMounts.nelements(); ++ant) {
+       const casacore::Vector<casacore::Double> xyz = itsPositions[ant].getValue().getValue();
+       ASKAPDEBUGASSERT(xyz.nelements() == 3);
+       os << std::string(itsMounts[ant]) << static_cast<casacore::Int>(itsPositions[ant].getRef().getType()) <<
+             xyz[0] << xyz[1] << xyz[2];
+  }
+  os.putEnd();
+}
+
 casacore::uInt MemAntennaSubtableHandler::getNumberOfAntennae() const
 {
   return itsMounts.nelements();
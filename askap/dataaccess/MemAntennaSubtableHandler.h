@@ -39,6 +39,11 @@
 // own includes
 #include <askap/dataaccess/IAntennaSubtableHandler.h>
 
+namespace LOFAR {
+class BlobIStream;
+class BlobOStream;
+} // namespace LOFAR
+
 namespace askap {
 
 namespace accessors {
@@ -54,6 +59,16 @@ struct MemAntennaSubtableHandler : virtual public IAntennaSubtableHandler {
   /// @param[in] ms an input measurement set (a table which has an
   /// ANTENNA subtable)
   explicit MemAntennaSubtableHandler(const casacore::Table &ms);
+
+  /// @brief restore the cached data from a snapshot
+  /// @details This constructor reads the data written by serialise, so the
+  /// ANTENNA subtable is not read (see SubtableInfoHolder::loadSnapshot)
+  /// @param[in] is input blob stream
+  explicit MemAntennaSubtableHandler(LOFAR::BlobIStream &is);
+
+  /// @brief write the cached data into a snapshot
+  /// @param[in] os output blob stream
+  void serialise(LOFAR::BlobOStream &os) const;
   
   /// @brief obtain the position of the given antenna
   /// @details
@@ -39,6 +39,7 @@
 
 // own includes
 #include <askap/dataaccess/MemBufferDataAccessor.h>
+#include <askap/askap/AskapError.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -84,7 +85,36 @@ void MemBufferDataAccessor::resizeBufferIfNeeded() const
   if (itsBuffer.nrow() != acc.nRow() || itsBuffer.ncolumn() != acc.nChannel() ||
                                         itsBuffer.nplane() != acc.nPol()) {
       itsBuffer.resize(acc.nRow(), acc.nChannel(), acc.nPol());
+      itsDirtyRegion.clear();
   }
 }
 
+/// @brief declare a part of the visibility cube as modified
+/// @details The declaration is only kept by this class, the region is reset when the 
+/// buffer is resized for a new chunk. Consumers copying the buffer elsewhere can use it 
+/// to restrict the copy.
+/// @param[in] startRow first modified row
+/// @param[in] nRow number of modified rows
+/// @param[in] startChan first modified channel
+/// @param[in] nChan number of modified channels
+void MemBufferDataAccessor::markVisibilityDirty(casacore::uInt startRow, casacore::uInt nRow,
+                                                casacore::uInt startChan, casacore::uInt nChan)
+{
+  resizeBufferIfNeeded();
+  ASKAPCHECK((startRow + nRow <= itsBuffer.nrow()) && (startChan + nChan <= itsBuffer.ncolumn()),
+             "Modified region of the visibility cube exceeds the chunk boundaries");
+  #ifdef _OPENMP
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  #endif
+  itsDirtyRegion.add(startRow, nRow, startChan, nChan);
+}
+
+/// @brief part of the visibility cube declared as modified
+/// @return a reference to the region (empty if nothing has been declared)
+const DirtyRegion& MemBufferDataAccessor::visibilityDirtyRegion() const
+{
+  resizeBufferIfNeeded();
+  return itsDirtyRegion;
+}
+
 
@@ -43,6 +43,8 @@
 // own includes
 #include <askap/dataaccess/MetaDataAccessor.h>
 #include <askap/dataaccess/IFlagAndNoiseDataAccessor.h>
+#include <askap/dataaccess/IDirtyRegionDataAccessor.h>
+#include <askap/dataaccess/DirtyRegion.h>
 
 #ifdef _OPENMP
 //boost include
@@ -71,7 +73,8 @@ namespace accessors {
 /// resized automatically to match the cube provided by the accessor). 
 /// @ingroup dataaccess_hlp
 class MemBufferDataAccessor : virtual public MetaDataAccessor,
-                              virtual public IDataAccessor
+                              virtual public IDataAccessor,
+                              virtual public IDirtyRegionDataAccessor
 {
 public:
   /// construct an object linked with the given const accessor
@@ -94,7 +97,21 @@ public:
   /// all visibility data
   ///
   virtual casacore::Cube<casacore::Complex>& rwVisibility();
-    
+
+  /// @brief declare a part of the visibility cube as modified
+  /// @details The declaration is only kept by this class, the region is reset when the buffer is resized
+  /// for a new chunk. Consumers copying
+  /// the buffer elsewhere can use it to restrict the copy.
+  /// @param[in] startRow first modified row
+  /// @param[in] nRow number of modified rows
+  /// @param[in] startChan first modified channel
+  /// @param[in] nChan number of modified channels
+  virtual void markVisibilityDirty(casacore::uInt startRow, casacore::uInt nRow,
+                                   casacore::uInt startChan, casacore::uInt nChan);
+
+  /// @brief part of the visibility cube declared as modified
+  /// @return a reference to the region (empty if nothing has been declared)
+  virtual const DirtyRegion& visibilityDirtyRegion() const;
   
 private:
   /// @brief a helper method to ensure the buffer has appropriate shape
@@ -102,6 +119,9 @@ private:
   
   /// @brief actual buffer
   mutable casacore::Cube<casacore::Complex> itsBuffer;
+
+  /// @brief part of the buffer declared as modified
+  mutable DirtyRegion itsDirtyRegion;
   
   #ifdef _OPENMP
   /// @brief synchronisation lock for resizing of the buffer
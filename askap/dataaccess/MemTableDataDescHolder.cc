@@ -40,6 +40,10 @@
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/TableRecord.h>
 
+// LOFAR includes
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
 using namespace askap;
 using namespace askap::accessors;
 using namespace std;
@@ -66,6 +70,35 @@ MemTableDataDescHolder::MemTableDataDescHolder(const casacore::Table &ms)
 /// @return spectral window id for a given dataDescriptionID
 /// @note return type has sign. User is responsible for interpreting
 /// the negative values
+/// @brief restore the cached data from a snapshot
+/// @details This constructor reads the data written by serialise, so the
+/// DATA_DESCRIPTION subtable is not read (see SubtableInfoHolder::loadSnapshot)
+/// @param[in] is input blob stream
+MemTableDataDescHolder::MemTableDataDescHolder(LOFAR::BlobIStream &is)
+{
+  const int version = is.getStart("MemTableDataDescHolder");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the serialised MemTableDataDescHolder");
+  LOFAR::uint64 size = 0;
+  is >> size;
+  itsDataDescription.resize(size);
+  for (vector<pair<int,int> >::iterator it = itsDataDescription.begin(); it != itsDataDescription.end(); ++it) {
+       is >> it->first >> it->second;
+  }
+  is.getEnd();
+}
+
+/// @brief write the cached data into a snapshot
+/// @param[in] os output blob stream
+void MemTableDataDescHolder::serialise(LOFAR::BlobOStream &os) const
+{
+  os.putStart("MemTableDataDescHolder", 1);
+  os << static_cast<LOFAR::uint64>(itsDataDescription.size());
+  for (vector<pair<int,int> >::const_iterator ci = itsDataDescription.begin(); ci != itsDataDescription.end(); ++ci) {
+       os << ci->first << ci->second;
+  }
+  os.putEnd();
+}
+
 int MemTableDataDescHolder::getSpectralWindowID(size_t dataDescriptionID)
                   const
 { 
@@ -41,6 +41,11 @@
 // own includes
 #include <askap/dataaccess/ITableDataDescHolder.h>
 
+namespace LOFAR {
+class BlobIStream;
+class BlobOStream;
+} // namespace LOFAR
+
 namespace askap {
 
 namespace accessors {
@@ -55,6 +60,16 @@ struct MemTableDataDescHolder : public ITableDataDescHolder {
   /// @param ms an input measurement set (a table which has a
   /// DATA_DESCRIPTION subtable defined)
   explicit MemTableDataDescHolder(const casacore::Table &ms);
+
+  /// @brief restore the cached data from a snapshot
+  /// @details This constructor reads the data written by serialise, so the
+  /// DATA_DESCRIPTION subtable is not read (see SubtableInfoHolder::loadSnapshot)
+  /// @param[in] is input blob stream
+  explicit MemTableDataDescHolder(LOFAR::BlobIStream &is);
+
+  /// @brief write the cached data into a snapshot
+  /// @param[in] os output blob stream
+  void serialise(LOFAR::BlobOStream &os) const;
   
   /// obtain spectral window ID via data description ID
   /// @param dataDescriptionID an index into data description table for
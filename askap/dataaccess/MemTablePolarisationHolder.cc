@@ -34,6 +34,10 @@
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/TableRecord.h>
 
+// LOFAR includes
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
 // own includes
 #include <askap/dataaccess/MemTablePolarisationHolder.h>
 #include <askap/askap/AskapError.h>
@@ -76,6 +80,46 @@ MemTablePolarisationHolder::MemTablePolarisationHolder(const casacore::Table &ms
 /// @brief number of polarisation products for the given ID
 /// @param[in] polID polarisation ID of interest
 /// @return number of products for the given ID
+/// @brief restore the cached data from a snapshot
+/// @details This constructor reads the data written by serialise, so the
+/// POLARIZATION subtable is not read (see SubtableInfoHolder::loadSnapshot)
+/// @param[in] is input blob stream
+MemTablePolarisationHolder::MemTablePolarisationHolder(LOFAR::BlobIStream &is)
+{
+  const int version = is.getStart("MemTablePolarisationHolder");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the serialised MemTablePolarisationHolder");
+  LOFAR::uint64 size = 0;
+  is >> size;
+  itsPolTypes.resize(size);
+  for (casacore::uInt row=0; row<itsPolTypes.nelements(); ++row) {
+       is >> size;
+       casacore::Vector<casacore::Stokes::StokesTypes> &corrType = itsPolTypes[row];
+       corrType.resize(size);
+       for (casacore::uInt pol=0; pol<corrType.nelements(); ++pol) {
+            casacore::Int buf = 0;
+            is >> buf;
+            corrType[pol] = casacore::Stokes::StokesTypes(buf);
+       }
+  }
+  is.getEnd();
+}
+
+/// @brief write the cached data into a snapshot
+/// @param[in] os output blob stream
+void MemTablePolarisationHolder::serialise(LOFAR::BlobOStream &os) const
+{
+  os.putStart("MemTablePolarisationHolder", 1);
+  os << static_cast<LOFAR::uint64>(itsPolTypes.nelements());
+  for (casacore::uInt row=0; row<itsPolTypes.nelements(); ++row) {
+       const casacore::Vector<casacore::Stokes::StokesTypes> &corrType = itsPolTypes[row];
+       os << static_cast<LOFAR::uint64>(corrType.nelements());
+       for (casacore::uInt pol=0; pol<corrType.nelements(); ++pol) {
+            os << static_cast<casacore::Int>(corrType[pol]);
+       }
+  }
+  os.putEnd();
+}
+
 size_t MemTablePolarisationHolder::nPol(casacore::uInt polID) const
 {
   ASKAPDEBUGASSERT(polID<itsPolTypes.nelements());
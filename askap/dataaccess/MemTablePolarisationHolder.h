@@ -41,6 +41,11 @@
 #include <askap/dataaccess/ITablePolarisationHolder.h>
 
 
+namespace LOFAR {
+class BlobIStream;
+class BlobOStream;
+} // namespace LOFAR
+
 namespace askap {
 
 namespace accessors {
@@ -56,6 +61,16 @@ struct MemTablePolarisationHolder : virtual public ITablePolarisationHolder {
    /// @param[in] ms an input measurement set (in fact any table which has a
    /// POLARIZATION subtable defined)
    explicit MemTablePolarisationHolder(const casacore::Table &ms);   
+
+   /// @brief restore the cached data from a snapshot
+   /// @details This constructor reads the data written by serialise, so the
+   /// POLARIZATION subtable is not read (see SubtableInfoHolder::loadSnapshot)
+   /// @param[in] is input blob stream
+   explicit MemTablePolarisationHolder(LOFAR::BlobIStream &is);
+
+   /// @brief write the cached data into a snapshot
+   /// @param[in] os output blob stream
+   void serialise(LOFAR::BlobOStream &os) const;
    
    /// @brief number of polarisation products for the given ID
    /// @param[in] polID polarisation ID of interest
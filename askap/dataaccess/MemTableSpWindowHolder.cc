@@ -48,6 +48,10 @@
 #include <casacore/casa/Quanta/Quantum.h>
 #include <casacore/casa/Quanta/MVFrequency.h>
 
+// LOFAR includes
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
 
 using namespace askap;
 using namespace askap::accessors;
@@ -89,6 +93,49 @@ MemTableSpWindowHolder::MemTableSpWindowHolder(const casacore::Table &ms)
 /// obtain the reference frame used in the spectral window table
 /// @param[in] spWindowID an index into spectral window table
 /// @return the reference frame of the given row
+/// @brief restore the cached data from a snapshot
+/// @details This constructor reads the data written by serialise, so the
+/// SPECTRAL_WINDOW subtable is not read (see SubtableInfoHolder::loadSnapshot)
+/// @param[in] is input blob stream
+MemTableSpWindowHolder::MemTableSpWindowHolder(LOFAR::BlobIStream &is)
+{
+  const int version = is.getStart("MemTableSpWindowHolder");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the serialised MemTableSpWindowHolder");
+  std::string units;
+  is >> units;
+  itsFreqUnits = casacore::Unit(units);
+  LOFAR::uint64 size = 0;
+  is >> size;
+  itsMeasRefIDs.resize(size);
+  itsChanFreqs.resize(size);
+  for (uInt row=0;row<itsMeasRefIDs.nelements();++row) {
+       is >> itsMeasRefIDs[row] >> size;
+       itsChanFreqs[row].resize(size);
+       is.get(itsChanFreqs[row].data(), itsChanFreqs[row].nelements());
+  }
+  is.getEnd();
+}
+
+/// @brief write the cached data into a snapshot
+/// @param[in] os output blob stream
+void MemTableSpWindowHolder::serialise(LOFAR::BlobOStream &os) const
+{
+  os.putStart("MemTableSpWindowHolder", 1);
+  os << std::string(itsFreqUnits.getName());
+  os << static_cast<LOFAR::uint64>(itsMeasRefIDs.nelements());
+  for (uInt row=0;row<itsMeasRefIDs.nelements();++row) {
+       const Vector<Double> &freqs = itsChanFreqs[row];
+       os << itsMeasRefIDs[row] << static_cast<LOFAR::uint64>(freqs.nelements());
+       if (freqs.contiguousStorage()) {
+           os.put(freqs.data(), freqs.nelements());
+       } else {
+           const Vector<Double> buf = freqs.copy();
+           os.put(buf.data(), buf.nelements());
+       }
+  }
+  os.putEnd();
+}
+
 casacore::MFrequency::Ref
     MemTableSpWindowHolder::getReferenceFrame(casacore::uInt spWindowID) const
 {
@@ -43,6 +43,11 @@
 // own includes
 #include <askap/dataaccess/ITableSpWindowHolder.h>
 
+namespace LOFAR {
+class BlobIStream;
+class BlobOStream;
+} // namespace LOFAR
+
 namespace askap {
 
 namespace accessors {
@@ -60,6 +65,16 @@ struct MemTableSpWindowHolder : virtual public ITableSpWindowHolder {
   /// SPECTRAL_WINDOW subtable defined)
   explicit MemTableSpWindowHolder(const casacore::Table &ms);
 
+  /// @brief restore the cached data from a snapshot
+  /// @details This constructor reads the data written by serialise, so the
+  /// SPECTRAL_WINDOW subtable is not read (see SubtableInfoHolder::loadSnapshot)
+  /// @param[in] is input blob stream
+  explicit MemTableSpWindowHolder(LOFAR::BlobIStream &is);
+
+  /// @brief write the cached data into a snapshot
+  /// @param[in] os output blob stream
+  void serialise(LOFAR::BlobOStream &os) const;
+
   /// obtain the reference frame used in the spectral window table
   /// @param[in] spWindowID an index into spectral window table
   /// @return the reference frame of the given row
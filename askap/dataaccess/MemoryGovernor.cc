@@ -0,0 +1,324 @@
+/// @file
+/// @brief global memory budget shared by the caches of the accessors package
+/// @details Caches of uvw machines, accessor buffers, buffer cubes and calibration
+/// solutions grow independently of each other, so the total memory used by a job
+/// is hard to predict. This class keeps track of the caches registered with it,
+/// reports their usage and asks them to drop or spill entries when the total exceeds
+/// the global budget. There is no budget by default, it can be set via the
+/// ASKAP_ACCESSORS_MEMORY_BUDGET environment variable or via the parset (see configure).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/dataaccess/MemoryGovernor.h>
+
+// casa includes
+#include <casacore/casa/OS/EnvVar.h>
+
+// std includes
+#include <algorithm>
+#include <cstdlib>
+
+ASKAP_LOGGER(logger, ".dataaccess");
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief ordering of the caches in which they are asked to release memory
+struct ReleaseOrder {
+  /// @brief construct the functor
+  /// @param[in] usage usage of each cache
+  explicit ReleaseOrder(const std::vector<MemoryGovernor::Usage> &usage) : itsUsage(usage) {}
+
+  /// @brief comparison operator
+  /// @param[in] first index of the first cache
+  /// @param[in] second index of the second cache
+  /// @return true, if the first cache should be asked before the second
+  bool operator()(size_t first, size_t second) const {
+     if (itsUsage[first].itsPriority != itsUsage[second].itsPriority) {
+         return itsUsage[first].itsPriority < itsUsage[second].itsPriority;
+     }
+     return itsUsage[first].itsBytes > itsUsage[second].itsBytes;
+  }
+private:
+  /// @brief usage of each cache
+  const std::vector<MemoryGovernor::Usage> &itsUsage;
+};
+
+} // anonymous namespace
+
+/// @brief create the counter and register it with the governor
+/// @param[in] name name of the cache used in the report
+MemoryGovernor::Counter::Counter(const std::string &name) : itsBytes(0)
+{
+  MemoryGovernor::instance().add(this, name, MemoryGovernor::HIGH_PRIORITY);
+}
+
+/// @brief remove the counter from the governor
+MemoryGovernor::Counter::~Counter()
+{
+  MemoryGovernor::instance().remove(this);
+}
+
+/// @brief memory currently held
+/// @return number of bytes
+size_t MemoryGovernor::Counter::memoryUsage() const
+{
+  return itsBytes;
+}
+
+/// @brief construct the governor
+/// @details The budget is set if requested by the environment
+MemoryGovernor::MemoryGovernor() : itsBudget(0), itsWarned(false)
+{
+  configureFromEnvironment();
+}
+
+/// @brief the governor of this process
+/// @details The governor is created on the first call and configured from the
+/// ASKAP_ACCESSORS_MEMORY_BUDGET environment variable (see configureFromEnvironment).
+/// @return reference to the governor
+MemoryGovernor& MemoryGovernor::instance()
+{
+  static MemoryGovernor governor;
+  return governor;
+}
+
+/// @brief set the budget
+/// @details The budget is enforced straight away.
+/// @param[in] nBytes total number of bytes the registered caches may hold, zero means no limit
+void MemoryGovernor::setBudget(size_t nBytes)
+{
+  {
+    boost::lock_guard<boost::recursive_mutex> lock(itsMutex);
+    itsBudget = nBytes;
+    itsWarned = false;
+  }
+  enforce();
+}
+
+/// @brief obtain the budget
+/// @return total number of bytes the registered caches may hold, zero means no limit
+size_t MemoryGovernor::budget() const
+{
+  boost::lock_guard<boost::recursive_mutex> lock(itsMutex);
+  return itsBudget;
+}
+
+/// @brief set the budget if requested in the parset
+/// @details Nothing is done if the key is not defined.
+/// @param[in] parset parameters
+/// @param[in] key name of the parameter with the budget in megabytes
+void MemoryGovernor::configure(const LOFAR::ParameterSet &parset, const std::string &key)
+{
+  if (parset.isDefined(key)) {
+      const casacore::uInt budgetMB = parset.getUint32(key);
+      ASKAPLOG_INFO_STR(logger, "Caches of the accessors will be limited to "<<budgetMB<<" MB");
+      setBudget(size_t(budgetMB) * 1024 * 1024);
+  }
+}
+
+/// @brief set the budget if requested by the environment
+/// @details The ASKAP_ACCESSORS_MEMORY_BUDGET variable gives the budget in megabytes.
+void MemoryGovernor::configureFromEnvironment()
+{
+  if (casacore::EnvironmentVariable::isDefined("ASKAP_ACCESSORS_MEMORY_BUDGET")) {
+      const std::string value = casacore::EnvironmentVariable::get("ASKAP_ACCESSORS_MEMORY_BUDGET");
+      if (value != "") {
+          const long budgetMB = std::atol(value.c_str());
+          ASKAPCHECK(budgetMB >= 0, "Memory budget should be non-negative, you have "<<value);
+          setBudget(size_t(budgetMB) * 1024 * 1024);
+      }
+  }
+}
+
+/// @brief register a cache
+/// @details The cache should be removed before it is destroyed. Registering the same
+/// cache again changes its name and priority.
+/// @param[in] consumer the cache (not owned by the governor)
+/// @param[in] name name of the cache used in the report
+/// @param[in] priority caches with a lower priority are asked to release memory first
+void MemoryGovernor::add(IMemoryConsumer *consumer, const std::string &name, int priority)
+{
+  ASKAPCHECK(consumer != 0, "An attempt to register a null cache with the memory governor");
+  boost::lock_guard<boost::recursive_mutex> lock(itsMutex);
+  Entry &entry = itsConsumers[consumer];
+  entry.itsName = name;
+  entry.itsPriority = priority;
+}
+
+/// @brief remove a cache
+/// @details Nothing is done if the cache is not registered.
+/// @param[in] consumer the cache
+void MemoryGovernor::remove(IMemoryConsumer *consumer)
+{
+  boost::lock_guard<boost::recursive_mutex> lock(itsMutex);
+  itsConsumers.erase(consumer);
+}
+
+/// @brief number of registered caches
+/// @return number of caches
+size_t MemoryGovernor::nConsumers() const
+{
+  boost::lock_guard<boost::recursive_mutex> lock(itsMutex);
+  return itsConsumers.size();
+}
+
+/// @brief memory used by each registered cache, the mutex should be locked by the caller
+/// @param[out] consumers caches in the same order as the result
+/// @return usage of each cache in the order of increasing priority and decreasing usage
+std::vector<MemoryGovernor::Usage> MemoryGovernor::reportLocked(std::vector<IMemoryConsumer*> &consumers) const
+{
+  std::vector<Usage> usage;
+  usage.reserve(itsConsumers.size());
+  std::vector<IMemoryConsumer*> unsorted;
+  unsorted.reserve(itsConsumers.size());
+  for (std::map<IMemoryConsumer*, Entry>::const_iterator ci = itsConsumers.begin();
+       ci != itsConsumers.end(); ++ci) {
+       Usage entry;
+       entry.itsName = ci->second.itsName;
+       entry.itsPriority = ci->second.itsPriority;
+       entry.itsBytes = ci->first->memoryUsage();
+       usage.push_back(entry);
+       unsorted.push_back(ci->first);
+  }
+  std::vector<size_t> order(usage.size());
+  for (size_t index = 0; index < order.size(); ++index) {
+       order[index] = index;
+  }
+  std::sort(order.begin(), order.end(), ReleaseOrder(usage));
+  std::vector<Usage> result;
+  result.reserve(usage.size());
+  consumers.resize(0);
+  consumers.reserve(usage.size());
+  for (std::vector<size_t>::const_iterator ci = order.begin(); ci != order.end(); ++ci) {
+       result.push_back(usage[*ci]);
+       consumers.push_back(unsorted[*ci]);
+  }
+  return result;
+}
+
+/// @brief memory used by each registered cache
+/// @details Caches with the same name (e.g. several instances of the same class) are
+/// reported separately, in the order of priority.
+/// @return usage of each cache
+std::vector<MemoryGovernor::Usage> MemoryGovernor::report() const
+{
+  boost::lock_guard<boost::recursive_mutex> lock(itsMutex);
+  std::vector<IMemoryConsumer*> consumers;
+  return reportLocked(consumers);
+}
+
+/// @brief total memory used by the registered caches
+/// @return number of bytes
+size_t MemoryGovernor::totalUsage() const
+{
+  boost::lock_guard<boost::recursive_mutex> lock(itsMutex);
+  size_t total = 0;
+  for (std::map<IMemoryConsumer*, Entry>::const_iterator ci = itsConsumers.begin();
+       ci != itsConsumers.end(); ++ci) {
+       total += ci->first->memoryUsage();
+  }
+  return total;
+}
+
+/// @brief write the usage of all caches into the log
+void MemoryGovernor::logReport() const
+{
+  const std::vector<Usage> usage = report();
+  // caches with the same name are summed up to keep the log short
+  std::map<std::string, std::pair<size_t, size_t> > totals;
+  size_t total = 0;
+  for (std::vector<Usage>::const_iterator ci = usage.begin(); ci != usage.end(); ++ci) {
+       std::pair<size_t, size_t> &entry = totals[ci->itsName];
+       ++entry.first;
+       entry.second += ci->itsBytes;
+       total += ci->itsBytes;
+  }
+  ASKAPLOG_INFO_STR(logger, "Caches of the accessors hold "<<total / 1024<<" kB, budget is "<<
+                    (budget() > 0 ? budget() / 1024 : 0)<<" kB (0 means no limit)");
+  for (std::map<std::string, std::pair<size_t, size_t> >::const_iterator ci = totals.begin();
+       ci != totals.end(); ++ci) {
+       ASKAPLOG_INFO_STR(logger, "    "<<ci->first<<": "<<ci->second.second / 1024<<" kB in "<<
+                         ci->second.first<<" instance(s)");
+  }
+}
+
+/// @brief ask the caches to release memory if the budget is exceeded
+/// @details Caches are asked in the order of increasing priority until the total
+/// usage fits into the budget. Nothing is done if there is no budget or another
+/// thread is enforcing it already. This method should not be called while holding
+/// a lock which the registered caches take.
+/// @return number of bytes released
+size_t MemoryGovernor::enforce()
+{
+  boost::unique_lock<boost::mutex> enforcing(itsEnforceMutex, boost::try_to_lock);
+  if (!enforcing.owns_lock()) {
+      // this or another thread is enforcing the budget already
+      return 0;
+  }
+  boost::lock_guard<boost::recursive_mutex> lock(itsMutex);
+  if (itsBudget == 0) {
+      return 0;
+  }
+  std::vector<IMemoryConsumer*> consumers;
+  const std::vector<Usage> usage = reportLocked(consumers);
+  size_t total = 0;
+  for (std::vector<Usage>::const_iterator ci = usage.begin(); ci != usage.end(); ++ci) {
+       total += ci->itsBytes;
+  }
+  size_t released = 0;
+  for (size_t index = 0; (index < consumers.size()) && (total > itsBudget); ++index) {
+       // the cache may have been removed while another one was releasing memory
+       if ((usage[index].itsBytes > 0) && (itsConsumers.find(consumers[index]) != itsConsumers.end())) {
+           const size_t bytes = std::min(consumers[index]->releaseMemory(total - itsBudget), total);
+           total -= bytes;
+           released += bytes;
+       }
+  }
+  if (total > itsBudget) {
+      if (!itsWarned) {
+          ASKAPLOG_WARN_STR(logger, "Caches of the accessors hold "<<total / 1024<<
+               " kB which can't be released, the budget is "<<itsBudget / 1024<<" kB");
+          itsWarned = true;
+      }
+  } else {
+      itsWarned = false;
+  }
+  return released;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,229 @@
+/// @file
+/// @brief global memory budget shared by the caches of the accessors package
+/// @details Caches of uvw machines, accessor buffers, buffer cubes and calibration
+/// solutions grow independently of each other, so the total memory used by a job
+/// is hard to predict. This class keeps track of the caches registered with it,
+/// reports their usage and asks them to drop or spill entries when the total exceeds
+/// the global budget. There is no budget by default, it can be set via the
+/// ASKAP_ACCESSORS_MEMORY_BUDGET environment variable or via the parset (see configure).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_MEMORY_GOVERNOR_H
+#define ASKAP_ACCESSORS_MEMORY_GOVERNOR_H
+
+// std includes
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/utility.hpp>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+// own includes
+#include <askap/dataaccess/IMemoryConsumer.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief global memory budget shared by the caches of the accessors package
+/// @details There is one governor per process (see instance). Caches register
+/// themselves on construction and are removed on destruction. Each cache has a name
+/// (used in the report) and a priority. When the budget is exceeded, caches with the
+/// lowest priority are asked to release memory first, caches of the same priority
+/// are asked in the order of decreasing usage. The budget is checked by enforce,
+/// which the caches call after they have grown (without holding their own locks).
+/// Only one thread enforces the budget at a time, other threads return straight away.
+/// All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class MemoryGovernor : private boost::noncopyable
+{
+public:
+  /// @brief typical priorities of the caches
+  /// @details Caches with a lower priority are asked to release memory first. Caches
+  /// which can't release anything (i.e. only report their usage) use HIGH_PRIORITY.
+  enum Priority {
+     /// @brief the entries can be spilled to disk and read back later
+     LOW_PRIORITY = 0,
+     /// @brief the entries can be dropped and obtained again
+     NORMAL_PRIORITY = 50,
+     /// @brief the entries are in use and can't be released
+     HIGH_PRIORITY = 100
+  };
+
+  /// @brief memory used by one cache
+  struct Usage {
+     /// @brief name of the cache
+     std::string itsName;
+     /// @brief priority of the cache
+     int itsPriority;
+     /// @brief number of bytes held
+     size_t itsBytes;
+  };
+
+  /// @brief counter of memory held by many small objects
+  /// @details Some caches are spread across many objects (e.g. the fields of every data
+  /// accessor), which are too numerous to be registered individually. Such objects can
+  /// add their sizes to a shared counter instead. The counter is registered with the
+  /// governor for its lifetime and only reports the usage.
+  class Counter : virtual public IMemoryConsumer,
+                  private boost::noncopyable {
+  public:
+     /// @brief create the counter and register it with the governor
+     /// @param[in] name name of the cache used in the report
+     explicit Counter(const std::string &name);
+
+     /// @brief remove the counter from the governor
+     virtual ~Counter();
+
+     /// @brief account for the memory allocated
+     /// @param[in] nBytes number of bytes
+     inline void add(size_t nBytes) { itsBytes += nBytes; }
+
+     /// @brief account for the memory freed
+     /// @param[in] nBytes number of bytes (previously added)
+     inline void subtract(size_t nBytes) { itsBytes -= nBytes; }
+
+     /// @brief memory currently held
+     /// @return number of bytes
+     virtual size_t memoryUsage() const;
+  private:
+     /// @brief number of bytes held
+     std::atomic<size_t> itsBytes;
+  };
+
+  /// @brief the governor of this process
+  /// @details The governor is created on the first call and configured from the
+  /// ASKAP_ACCESSORS_MEMORY_BUDGET environment variable (see configureFromEnvironment).
+  /// @return reference to the governor
+  static MemoryGovernor& instance();
+
+  /// @brief set the budget
+  /// @details The budget is enforced straight away.
+  /// @param[in] nBytes total number of bytes the registered caches may hold, zero means no limit
+  void setBudget(size_t nBytes);
+
+  /// @brief obtain the budget
+  /// @return total number of bytes the registered caches may hold, zero means no limit
+  size_t budget() const;
+
+  /// @brief set the budget if requested in the parset
+  /// @details Nothing is done if the key is not defined.
+  /// @param[in] parset parameters
+  /// @param[in] key name of the parameter with the budget in megabytes
+  void configure(const LOFAR::ParameterSet &parset, const std::string &key = "memorybudget");
+
+  /// @brief set the budget if requested by the environment
+  /// @details The ASKAP_ACCESSORS_MEMORY_BUDGET variable gives the budget in megabytes.
+  void configureFromEnvironment();
+
+  /// @brief register a cache
+  /// @details The cache should be removed before it is destroyed. Registering the same
+  /// cache again changes its name and priority.
+  /// @param[in] consumer the cache (not owned by the governor)
+  /// @param[in] name name of the cache used in the report
+  /// @param[in] priority caches with a lower priority are asked to release memory first
+  void add(IMemoryConsumer *consumer, const std::string &name, int priority);
+
+  /// @brief remove a cache
+  /// @details Nothing is done if the cache is not registered.
+  /// @param[in] consumer the cache
+  void remove(IMemoryConsumer *consumer);
+
+  /// @brief number of registered caches
+  /// @return number of caches
+  size_t nConsumers() const;
+
+  /// @brief memory used by each registered cache
+  /// @details Caches with the same name (e.g. several instances of the same class) are
+  /// reported separately, in the order of priority.
+  /// @return usage of each cache
+  std::vector<Usage> report() const;
+
+  /// @brief total memory used by the registered caches
+  /// @return number of bytes
+  size_t totalUsage() const;
+
+  /// @brief write the usage of all caches into the log
+  void logReport() const;
+
+  /// @brief ask the caches to release memory if the budget is exceeded
+  /// @details Caches are asked in the order of increasing priority until the total
+  /// usage fits into the budget. Nothing is done if there is no budget or another
+  /// thread is enforcing it already. This method should not be called while holding
+  /// a lock which the registered caches take.
+  /// @return number of bytes released
+  size_t enforce();
+
+private:
+  /// @brief registered cache
+  struct Entry {
+     /// @brief name of the cache
+     std::string itsName;
+     /// @brief priority of the cache
+     int itsPriority;
+  };
+
+  /// @brief construct the governor
+  /// @details The budget is set if requested by the environment
+  MemoryGovernor();
+
+  /// @brief memory used by each registered cache, the mutex should be locked by the caller
+  /// @param[out] consumers caches in the same order as the result
+  /// @return usage of each cache in the order of increasing priority and decreasing usage
+  std::vector<Usage> reportLocked(std::vector<IMemoryConsumer*> &consumers) const;
+
+  /// @brief registered caches
+  std::map<IMemoryConsumer*, Entry> itsConsumers;
+
+  /// @brief budget in bytes, zero means no limit
+  size_t itsBudget;
+
+  /// @brief true, if the warning about an unmet budget has been given
+  bool itsWarned;
+
+  /// @brief mutex protecting the data above
+  /// @details It is recursive, so caches can be removed while they release memory
+  mutable boost::recursive_mutex itsMutex;
+
+  /// @brief mutex held by the thread enforcing the budget
+  boost::mutex itsEnforceMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MEMORY_GOVERNOR_H
@@ -0,0 +1,121 @@
+/// @file
+/// @brief iterator merging a number of iterators in time order
+/// @details This iterator runs over a number of other iterators at the same time
+/// and delivers their chunks ordered by time. It is used by MultiTableDataSource to
+/// present several measurement sets as one data stream.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/MergedDataIterator.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the iterator
+/// @param[in] iters iterators to merge
+MergedDataIterator::MergedDataIterator(const std::vector<boost::shared_ptr<IConstDataIterator> > &iters) :
+        itsIterators(iters), itsTimes(iters.size(), 0.), itsCurrent(iters.size())
+{
+  ASKAPCHECK(itsIterators.size() > 0, "MergedDataIterator requires at least one iterator");
+  for (size_t index = 0; index < itsIterators.size(); ++index) {
+       ASKAPCHECK(itsIterators[index], "An attempt to initialise MergedDataIterator with empty shared pointer");
+       if (itsIterators[index]->hasMore()) {
+           itsTimes[index] = (*itsIterators[index])->time();
+       }
+  }
+  selectCurrent();
+}
+
+/// Restart the iteration from the beginning
+void MergedDataIterator::init()
+{
+  for (size_t index = 0; index < itsIterators.size(); ++index) {
+       itsIterators[index]->init();
+       if (itsIterators[index]->hasMore()) {
+           itsTimes[index] = (*itsIterators[index])->time();
+       }
+  }
+  selectCurrent();
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the current chunk
+const IConstDataAccessor& MergedDataIterator::operator*() const
+{
+  ASKAPCHECK(itsCurrent < itsIterators.size(), "No more data available in MergedDataIterator");
+  return *(*itsIterators[itsCurrent]);
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool MergedDataIterator::hasMore() const throw()
+{
+  return itsCurrent < itsIterators.size();
+}
+
+/// advance the iterator one step further 
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool MergedDataIterator::next()
+{
+  ASKAPCHECK(itsCurrent < itsIterators.size(), "No more data available in MergedDataIterator");
+  IConstDataIterator &it = *itsIterators[itsCurrent];
+  if (it.next()) {
+      itsTimes[itsCurrent] = it->time();
+  }
+  selectCurrent();
+  return hasMore();
+}
+
+/// @brief index of the iterator the current chunk comes from
+/// @return index of the wrapped iterator (in the order given to the constructor)
+size_t MergedDataIterator::currentIndex() const
+{
+  ASKAPCHECK(itsCurrent < itsIterators.size(), "No more data available in MergedDataIterator");
+  return itsCurrent;
+}
+
+/// @brief find the iterator with the earliest time stamp
+/// @details This method sets itsCurrent to the index of the wrapped iterator to be used
+/// for the next step or to the number of iterators if there are no more data.
+void MergedDataIterator::selectCurrent()
+{
+  itsCurrent = itsIterators.size();
+  for (size_t index = 0; index < itsIterators.size(); ++index) {
+       // the strict comparison keeps chunks with the same time in the order of iterators
+       if (itsIterators[index]->hasMore() && ((itsCurrent == itsIterators.size()) || 
+           (itsTimes[index] < itsTimes[itsCurrent]))) {
+           itsCurrent = index;
+       }
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,104 @@
+/// @file
+/// @brief iterator merging a number of iterators in time order
+/// @details This iterator runs over a number of other iterators at the same time
+/// and delivers their chunks ordered by time. It is used by MultiTableDataSource to
+/// present several measurement sets as one data stream.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_MERGED_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_MERGED_DATA_ITERATOR_H
+
+// std includes
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iterator merging a number of iterators in time order
+/// @details Every step delivers the current chunk of one of the wrapped iterators: 
+/// the one with the earliest time stamp. Chunks with the same time stamp are delivered 
+/// in the order of the iterators, i.e. for measurement sets split by frequency (or by
+/// beam) all parts of the same time step come one after another. Each wrapped iterator
+/// is assumed to be time-ordered. Accessors are those of the wrapped iterators, therefore
+/// different steps can have different shapes. All wrapped iterators should use the 
+/// same conversion policies, so the time stamps are comparable.
+/// @ingroup dataaccess_hlp
+class MergedDataIterator : virtual public IConstDataIterator
+{
+public:
+  /// @brief construct the iterator
+  /// @param[in] iters iterators to merge
+  explicit MergedDataIterator(const std::vector<boost::shared_ptr<IConstDataIterator> > &iters);
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the current chunk
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @brief index of the iterator the current chunk comes from
+  /// @return index of the wrapped iterator (in the order given to the constructor)
+  size_t currentIndex() const;
+
+protected:
+  /// @brief find the iterator with the earliest time stamp
+  /// @details This method sets itsCurrent to the index of the wrapped iterator to be used
+  /// for the next step or to the number of iterators if there are no more data.
+  void selectCurrent();
+
+private:
+  /// @brief wrapped iterators
+  std::vector<boost::shared_ptr<IConstDataIterator> > itsIterators;
+
+  /// @brief time stamps of the current chunks of the wrapped iterators
+  std::vector<double> itsTimes;
+
+  /// @brief index of the current iterator, equal to the number of iterators if there are no more data
+  size_t itsCurrent;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MERGED_DATA_ITERATOR_H
@@ -0,0 +1,222 @@
+/// @file
+/// @brief selector applying the same selection to a number of data sources
+/// @details This class is used together with MultiTableDataSource. It holds a
+/// selector for each of the underlying data sources and passes every selection
+/// request to all of them.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/MultiDataSelector.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the selector
+/// @param[in] selectors selectors of the underlying data sources (one per source)
+MultiDataSelector::MultiDataSelector(const std::vector<boost::shared_ptr<IDataSelector> > &selectors) :
+           itsSelectors(selectors)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       ASKAPCHECK(itsSelectors[index], "An attempt to initialise MultiDataSelector with empty shared pointer");
+  }
+}
+
+/// @brief obtain the selector for the given data source
+/// @param[in] index index of the data source
+/// @return shared pointer to the selector
+boost::shared_ptr<IDataSelector const> MultiDataSelector::selector(size_t index) const
+{
+  ASKAPCHECK(index < itsSelectors.size(), "Selector index "<<index<<" exceeds the number of data sources ("<<
+             itsSelectors.size()<<")");
+  return itsSelectors[index];
+}
+
+/// Choose a single feed, the same for both antennae
+/// @param[in] feedID the sequence number of feed to choose
+void MultiDataSelector::chooseFeed(casacore::uInt feedID)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseFeed(feedID);
+  }
+}
+
+/// Choose a baseline
+/// @param[in] ant1 the sequence number of the first antenna
+/// @param[in] ant2 the sequence number of the second antenna
+void MultiDataSelector::chooseBaseline(casacore::uInt ant1, casacore::uInt ant2)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseBaseline(ant1, ant2);
+  }
+}
+
+/// Choose all baselines to given antenna
+/// @param[in] ant the sequence number of antenna
+void MultiDataSelector::chooseAntenna(casacore::uInt ant)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseAntenna(ant);
+  }
+}
+
+/// Choose samples corresponding to a uniquely specified user-defined index
+/// @param[in] column name of the column
+/// @param[in] value the value to select
+void MultiDataSelector::chooseUserDefinedIndex(const std::string &column, const casacore::uInt value)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseUserDefinedIndex(column, value);
+  }
+}
+
+/// Choose autocorrelations only
+void MultiDataSelector::chooseAutoCorrelations()
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseAutoCorrelations();
+  }
+}
+
+/// Choose crosscorrelations only
+void MultiDataSelector::chooseCrossCorrelations()
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseCrossCorrelations();
+  }
+}
+
+/// Choose samples with the uv-distance larger than the given threshold
+/// @param[in] uvDist threshold in metres
+void MultiDataSelector::chooseMinUVDistance(casacore::Double uvDist)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseMinUVDistance(uvDist);
+  }
+}
+
+/// Choose samples with the uv-distance smaller than the given threshold
+/// @param[in] uvDist threshold in metres
+void MultiDataSelector::chooseMaxUVDistance(casacore::Double uvDist)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseMaxUVDistance(uvDist);
+  }
+}
+
+/// Choose a subset of spectral channels
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the number of the first spectral channel to choose
+/// @param[in] nAvg a number of adjacent spectral channels to average
+void MultiDataSelector::chooseChannels(casacore::uInt nChan, casacore::uInt start, casacore::uInt nAvg)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseChannels(nChan, start, nAvg);
+  }
+}
+
+/// Choose a subset of frequencies
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the frequency of the first spectral channel to choose
+/// @param[in] freqInc an increment in terms of the frequency
+void MultiDataSelector::chooseFrequencies(casacore::uInt nChan, const casacore::MVFrequency &start, const casacore::MVFrequency &freqInc)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseFrequencies(nChan, start, freqInc);
+  }
+}
+
+/// Choose a subset of radial velocities
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the velocity of the first spectral channel to choose
+/// @param[in] velInc an increment in terms of the radial velocity
+void MultiDataSelector::chooseVelocities(casacore::uInt nChan, const casacore::MVRadialVelocity &start, const casacore::MVRadialVelocity &velInc)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseVelocities(nChan, start, velInc);
+  }
+}
+
+/// Choose a single spectral window (also known as IF)
+/// @param[in] spWinID the ID of the spectral window to choose
+void MultiDataSelector::chooseSpectralWindow(casacore::uInt spWinID)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseSpectralWindow(spWinID);
+  }
+}
+
+/// Choose a time range given as epochs
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop the end of the chosen time interval
+void MultiDataSelector::chooseTimeRange(const casacore::MVEpoch &start, const casacore::MVEpoch &stop)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseTimeRange(start, stop);
+  }
+}
+
+/// Choose a time range with respect to the origin defined by the data source
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop the end of the chosen time interval
+void MultiDataSelector::chooseTimeRange(casacore::Double start, casacore::Double stop)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseTimeRange(start, stop);
+  }
+}
+
+/// Choose polarization
+/// @param[in] pols a string describing the wanted polarization in the output
+void MultiDataSelector::choosePolarizations(const casacore::String &pols)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->choosePolarizations(pols);
+  }
+}
+
+/// Choose cycles
+/// @param[in] start the number of the first cycle to choose
+/// @param[in] stop the number of the last cycle to choose
+void MultiDataSelector::chooseCycles(casacore::uInt start, casacore::uInt stop)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseCycles(start, stop);
+  }
+}
+
+/// Choose a single scan number
+/// @param[in] scanNumber the scan number to choose
+void MultiDataSelector::chooseScanNumber(casacore::uInt scanNumber)
+{
+  for (size_t index = 0; index < itsSelectors.size(); ++index) {
+       itsSelectors[index]->chooseScanNumber(scanNumber);
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,154 @@
+/// @file
+/// @brief selector applying the same selection to a number of data sources
+/// @details This class is used together with MultiTableDataSource. It holds a
+/// selector for each of the underlying data sources and passes every selection
+/// request to all of them.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_MULTI_DATA_SELECTOR_H
+#define ASKAP_ACCESSORS_MULTI_DATA_SELECTOR_H
+
+// std includes
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// own includes
+#include <askap/dataaccess/IDataSelector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief selector applying the same selection to a number of data sources
+/// @details Selectors are specific to the type of the data source (and, for table-based
+/// sources, to the particular table). This class holds one selector per underlying data 
+/// source and passes all calls through, so the same selection is applied to each of them.
+/// @ingroup dataaccess_hlp
+class MultiDataSelector : virtual public IDataSelector
+{
+public:
+  /// @brief construct the selector
+  /// @param[in] selectors selectors of the underlying data sources (one per source)
+  explicit MultiDataSelector(const std::vector<boost::shared_ptr<IDataSelector> > &selectors);
+
+  /// @brief number of underlying selectors
+  /// @return number of data sources this selector corresponds to
+  inline size_t nSelectors() const { return itsSelectors.size(); }
+
+  /// @brief obtain the selector for the given data source
+  /// @param[in] index index of the data source
+  /// @return shared pointer to the selector
+  boost::shared_ptr<IDataSelector const> selector(size_t index) const;
+
+  /// Choose a single feed, the same for both antennae
+  /// @param[in] feedID the sequence number of feed to choose
+  virtual void chooseFeed(casacore::uInt feedID);
+
+  /// Choose a baseline
+  /// @param[in] ant1 the sequence number of the first antenna
+  /// @param[in] ant2 the sequence number of the second antenna
+  virtual void chooseBaseline(casacore::uInt ant1, casacore::uInt ant2);
+
+  /// Choose all baselines to given antenna
+  /// @param[in] ant the sequence number of antenna
+  virtual void chooseAntenna(casacore::uInt ant);
+
+  /// Choose samples corresponding to a uniquely specified user-defined index
+  /// @param[in] column name of the column
+  /// @param[in] value the value to select
+  virtual void chooseUserDefinedIndex(const std::string &column, const casacore::uInt value);
+
+  /// Choose autocorrelations only
+  virtual void chooseAutoCorrelations();
+
+  /// Choose crosscorrelations only
+  virtual void chooseCrossCorrelations();
+
+  /// Choose samples with the uv-distance larger than the given threshold
+  /// @param[in] uvDist threshold in metres
+  virtual void chooseMinUVDistance(casacore::Double uvDist);
+
+  /// Choose samples with the uv-distance smaller than the given threshold
+  /// @param[in] uvDist threshold in metres
+  virtual void chooseMaxUVDistance(casacore::Double uvDist);
+
+  /// Choose a subset of spectral channels
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the number of the first spectral channel to choose
+  /// @param[in] nAvg a number of adjacent spectral channels to average
+  virtual void chooseChannels(casacore::uInt nChan, casacore::uInt start, casacore::uInt nAvg = 1);
+
+  /// Choose a subset of frequencies
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the frequency of the first spectral channel to choose
+  /// @param[in] freqInc an increment in terms of the frequency
+  virtual void chooseFrequencies(casacore::uInt nChan, const casacore::MVFrequency &start, const casacore::MVFrequency &freqInc);
+
+  /// Choose a subset of radial velocities
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the velocity of the first spectral channel to choose
+  /// @param[in] velInc an increment in terms of the radial velocity
+  virtual void chooseVelocities(casacore::uInt nChan, const casacore::MVRadialVelocity &start, const casacore::MVRadialVelocity &velInc);
+
+  /// Choose a single spectral window (also known as IF)
+  /// @param[in] spWinID the ID of the spectral window to choose
+  virtual void chooseSpectralWindow(casacore::uInt spWinID);
+
+  /// Choose a time range given as epochs
+  /// @param[in] start the beginning of the chosen time interval
+  /// @param[in] stop the end of the chosen time interval
+  virtual void chooseTimeRange(const casacore::MVEpoch &start, const casacore::MVEpoch &stop);
+
+  /// Choose a time range with respect to the origin defined by the data source
+  /// @param[in] start the beginning of the chosen time interval
+  /// @param[in] stop the end of the chosen time interval
+  virtual void chooseTimeRange(casacore::Double start, casacore::Double stop);
+
+  /// Choose polarization
+  /// @param[in] pols a string describing the wanted polarization in the output
+  virtual void choosePolarizations(const casacore::String &pols);
+
+  /// Choose cycles
+  /// @param[in] start the number of the first cycle to choose
+  /// @param[in] stop the number of the last cycle to choose
+  virtual void chooseCycles(casacore::uInt start, casacore::uInt stop);
+
+  /// Choose a single scan number
+  /// @param[in] scanNumber the scan number to choose
+  virtual void chooseScanNumber(casacore::uInt scanNumber);
+private:
+  /// @brief selectors of the underlying data sources
+  std::vector<boost::shared_ptr<IDataSelector> > itsSelectors;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MULTI_DATA_SELECTOR_H
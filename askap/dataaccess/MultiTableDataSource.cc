@@ -0,0 +1,208 @@
+/// @file
+/// @brief data source presenting a number of measurement sets as one
+/// @details Spectral line and mosaicing jobs often work with a number of measurement
+/// sets (e.g. one per beam or per frequency block). This data source opens all of them
+/// (in parallel, as opening a measurement set and reading its subtables may take a while
+/// on a parallel file system) and delivers their data in one iteration loop ordered by time.
+///
+/// @copyright (c) 2026 CSIRO
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/MultiTableDataSource.h>
+#include <askap/dataaccess/MultiDataSelector.h>
+#include <askap/dataaccess/MergedDataIterator.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+// std includes
+#include <algorithm>
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief body of the worker threads opening the measurement sets
+/// @details Each worker takes the next measurement set which is not yet taken by
+/// another worker, until all of them are opened. Errors are recorded for each 
+/// measurement set and reported by the main thread.
+struct SourceOpener {
+  /// @brief type of the function opening one measurement set
+  typedef boost::shared_ptr<TableConstDataSource> (*OpenFunction)(const std::string &, const std::string &, bool);
+
+  /// @brief set up the worker
+  SourceOpener(OpenFunction open, const std::vector<std::string> &fnames, const std::string &dataColumn, 
+               bool memoryMapped, std::vector<boost::shared_ptr<TableConstDataSource> > &sources,
+               std::vector<std::string> &errors, size_t &nextIndex, boost::mutex &mutex) : itsOpen(open),
+         itsNames(fnames), itsDataColumn(dataColumn), itsMemoryMapped(memoryMapped), itsSources(sources),
+         itsErrors(errors), itsNextIndex(nextIndex), itsMutex(mutex) {}
+
+  /// @brief open measurement sets until none is left
+  void operator()() const {
+     for (;;) {
+          size_t index = 0;
+          {
+            boost::mutex::scoped_lock lock(itsMutex);
+            if (itsNextIndex >= itsNames.size()) {
+                return;
+            }
+            index = itsNextIndex++;
+          }
+          try {
+             itsSources[index] = itsOpen(itsNames[index], itsDataColumn, itsMemoryMapped);
+          }
+          catch (const std::exception &ex) {
+             itsErrors[index] = ex.what();
+          }
+          catch (...) {
+             itsErrors[index] = "unknown exception";
+          }
+     }
+  }
+
+  OpenFunction itsOpen;
+  const std::vector<std::string> &itsNames;
+  const std::string &itsDataColumn;
+  const bool itsMemoryMapped;
+  std::vector<boost::shared_ptr<TableConstDataSource> > &itsSources;
+  std::vector<std::string> &itsErrors;
+  size_t &itsNextIndex;
+  boost::mutex &itsMutex;
+};
+
+} // anonymous namespace
+
+/// @brief open the measurement sets
+/// @param[in] fnames file names of the measurement sets
+/// @param[in] dataColumn a name of the data column used by default (default is DATA)
+/// @param[in] nThreads maximum number of threads used to open the measurement sets, 
+/// zero means one thread per measurement set
+/// @param[in] memoryMapped if true, columns stored with tiled storage managers
+///            are accessed via memory-mapped files (see TableConstDataSource)
+MultiTableDataSource::MultiTableDataSource(const std::vector<std::string> &fnames, 
+                 const std::string &dataColumn, size_t nThreads, bool memoryMapped) :
+        itsSources(fnames.size())
+{
+  ASKAPCHECK(fnames.size() > 0, "MultiTableDataSource requires at least one measurement set");
+  std::vector<std::string> errors(fnames.size());
+  size_t nextIndex = 0;
+  boost::mutex mutex;
+  const SourceOpener opener(&MultiTableDataSource::openSource, fnames, dataColumn, memoryMapped, itsSources, errors, nextIndex, mutex);
+  const size_t nWorkers = nThreads == 0 ? fnames.size() : std::min(nThreads, fnames.size());
+  if (nWorkers == 1) {
+      opener();
+  } else {
+      boost::thread_group workers;
+      for (size_t worker = 0; worker < nWorkers; ++worker) {
+           workers.create_thread(opener);
+      }
+      workers.join_all();
+  }
+  for (size_t index = 0; index < fnames.size(); ++index) {
+       if (!errors[index].empty()) {
+           ASKAPTHROW(DataAccessError, "Unable to open measurement set "<<fnames[index]<<": "<<errors[index]);
+       }
+       ASKAPDEBUGASSERT(itsSources[index]);
+  }
+}
+
+/// @brief open one measurement set
+/// @details This method opens the measurement set and reads its subtables. It is 
+/// executed by the worker threads at construction.
+/// @param[in] fname file name of the measurement set
+/// @param[in] dataColumn a name of the data column used by default
+/// @param[in] memoryMapped if true, use memory-mapped access where possible
+/// @return shared pointer to the new data source
+boost::shared_ptr<TableConstDataSource> MultiTableDataSource::openSource(const std::string &fname, 
+                 const std::string &dataColumn, bool memoryMapped)
+{
+  boost::shared_ptr<TableConstDataSource> ds(new TableConstDataSource(fname, dataColumn, memoryMapped));
+  ds->loadSubtables();
+  return ds;
+}
+
+/// @brief create a converter object corresponding to this type of the DataSource
+/// @return a shared pointer to a new DataConverter object
+IDataConverterPtr MultiTableDataSource::createConverter() const
+{
+  ASKAPDEBUGASSERT(itsSources.size() > 0);
+  return itsSources[0]->createConverter();
+}
+
+/// @brief get a merged iterator over a selected part of the dataset 
+/// @param[in] sel a shared pointer to the selector object defining 
+///            which subset of the data is used (should be created by this data source)
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @return a shared pointer to MergedDataIterator object
+boost::shared_ptr<IConstDataIterator> MultiTableDataSource::createConstIterator(const
+	           IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv) const
+{
+  const boost::shared_ptr<MultiDataSelector const> multiSel = 
+            boost::dynamic_pointer_cast<MultiDataSelector const>(sel);
+  if (!multiSel) {
+      ASKAPTHROW(DataAccessLogicError, "Selector passed to MultiTableDataSource should be created by the same class");
+  }
+  ASKAPCHECK(multiSel->nSelectors() == itsSources.size(), "Selector passed to MultiTableDataSource has "<<
+             multiSel->nSelectors()<<" underlying selectors, "<<itsSources.size()<<" are expected");
+  std::vector<boost::shared_ptr<IConstDataIterator> > iters(itsSources.size());
+  for (size_t index = 0; index < itsSources.size(); ++index) {
+       iters[index] = itsSources[index]->createConstIterator(multiSel->selector(index), conv);
+  }
+  return boost::shared_ptr<IConstDataIterator>(new MergedDataIterator(iters));
+}
+
+/// @brief create a selector object applying the selection to all measurement sets
+/// @return a shared pointer to MultiDataSelector 
+IDataSelectorPtr MultiTableDataSource::createSelector() const
+{
+  std::vector<IDataSelectorPtr> selectors(itsSources.size());
+  for (size_t index = 0; index < itsSources.size(); ++index) {
+       selectors[index] = itsSources[index]->createSelector();
+  }
+  return IDataSelectorPtr(new MultiDataSelector(selectors));
+}
+
+/// @brief access to the data source of the given measurement set
+/// @details This allows to configure individual data sources, settings apply
+/// to the iterators created afterwards
+/// @param[in] index index of the measurement set (in the order given to the constructor)
+/// @return reference to the data source
+TableConstDataSource& MultiTableDataSource::source(size_t index) const
+{
+  ASKAPCHECK(index < itsSources.size(), "Data source index "<<index<<" exceeds the number of measurement sets ("<<
+             itsSources.size()<<")");
+  return *itsSources[index];
+}
+
+} // namespace accessors
+
+} // namespace askap
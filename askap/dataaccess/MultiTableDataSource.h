@@ -0,0 +1,130 @@
+/// @file
+/// @brief data source presenting a number of measurement sets as one
+/// @details Spectral line and mosaicing jobs often work with a number of measurement
+/// sets (e.g. one per beam or per frequency block). This data source opens all of them
+/// (in parallel, as opening a measurement set and reading its subtables may take a while
+/// on a parallel file system) and delivers their data in one iteration loop ordered by time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_MULTI_TABLE_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_MULTI_TABLE_DATA_SOURCE_H
+
+// std includes
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// own includes
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/TableConstDataSource.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief data source presenting a number of measurement sets as one
+/// @details Each measurement set is handled by its own TableConstDataSource, which can
+/// be accessed via the source method to configure implementation-specific features. 
+/// The measurement sets are opened and their subtables are read by a number of threads
+/// at construction. This relies on the table system being safe to use for distinct tables
+/// from different threads, set the number of threads to 1 to open them sequentially. 
+/// Iterators created by this class are MergedDataIterators which interleave chunks of the 
+/// individual measurement sets ordered by time (chunks with the same time are delivered in
+/// the order of the measurement sets). For measurement sets split by frequency this gives 
+/// band-merged data for every time step, for measurement sets split by beam - the beams 
+/// follow each other. Selectors created by this class are MultiDataSelectors, which apply
+/// the same selection to all measurement sets. The converter is shared by all iterators, 
+/// so all data are delivered in the same frames and units.
+/// @ingroup dataaccess_tab
+class MultiTableDataSource : virtual public IConstDataSource
+{
+public:
+  /// @brief open the measurement sets
+  /// @param[in] fnames file names of the measurement sets
+  /// @param[in] dataColumn a name of the data column used by default (default is DATA)
+  /// @param[in] nThreads maximum number of threads used to open the measurement sets, 
+  /// zero means one thread per measurement set
+  /// @param[in] memoryMapped if true, columns stored with tiled storage managers
+  ///            are accessed via memory-mapped files (see TableConstDataSource)
+  explicit MultiTableDataSource(const std::vector<std::string> &fnames, 
+                                const std::string &dataColumn = "DATA", size_t nThreads = 0,
+                                bool memoryMapped = false);
+
+  /// @brief create a converter object corresponding to this type of the DataSource
+  /// @return a shared pointer to a new DataConverter object
+  virtual IDataConverterPtr createConverter() const;
+
+  /// @brief get a merged iterator over a selected part of the dataset 
+  /// @param[in] sel a shared pointer to the selector object defining 
+  ///            which subset of the data is used (should be created by this data source)
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @return a shared pointer to MergedDataIterator object
+  virtual boost::shared_ptr<IConstDataIterator> createConstIterator(const
+	           IDataSelectorConstPtr &sel, const
+		   IDataConverterConstPtr &conv) const;
+
+  // we need this to get access to the overloaded syntax in the base class
+  using IConstDataSource::createConstIterator;
+
+  /// @brief create a selector object applying the selection to all measurement sets
+  /// @return a shared pointer to MultiDataSelector 
+  virtual IDataSelectorPtr createSelector() const;
+
+  /// @brief number of measurement sets
+  /// @return number of underlying data sources
+  inline size_t nSources() const { return itsSources.size(); }
+
+  /// @brief access to the data source of the given measurement set
+  /// @details This allows to configure individual data sources, settings apply
+  /// to the iterators created afterwards
+  /// @param[in] index index of the measurement set (in the order given to the constructor)
+  /// @return reference to the data source
+  TableConstDataSource& source(size_t index) const;
+
+protected:
+  /// @brief open one measurement set
+  /// @details This method opens the measurement set and reads its subtables. It is 
+  /// executed by the worker threads at construction.
+  /// @param[in] fname file name of the measurement set
+  /// @param[in] dataColumn a name of the data column used by default
+  /// @param[in] memoryMapped if true, use memory-mapped access where possible
+  /// @return shared pointer to the new data source
+  static boost::shared_ptr<TableConstDataSource> openSource(const std::string &fname, 
+                   const std::string &dataColumn, bool memoryMapped);
+
+private:
+  /// @brief data sources of the individual measurement sets
+  std::vector<boost::shared_ptr<TableConstDataSource> > itsSources;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MULTI_TABLE_DATA_SOURCE_H
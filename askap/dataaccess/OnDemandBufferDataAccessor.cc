@@ -36,6 +36,7 @@
 
 // own includes
 #include <askap/dataaccess/OnDemandBufferDataAccessor.h>
+#include <askap/askap/AskapError.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -95,7 +96,8 @@ casacore::Cube<casacore::Complex>& OnDemandBufferDataAccessor::rwVisibility()
       #ifdef _OPENMP
       boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
       #endif
-      itsBuffer = getROAccessor().visibility().copy();
+      // assign resizes the buffer and copies the values, an explicit copy would double the work
+      itsBuffer.assign(getROAccessor().visibility());
       itsUseBuffer = true;
   }
   return itsBuffer;  
@@ -135,5 +137,51 @@ void OnDemandBufferDataAccessor::discardCache()
   #endif
   itsUseBuffer = false;
   itsBuffer.resize(0,0,0);
+  itsDirtyRegion.clear();
+}
+
+/// @brief force the accessor to use the buffer without copying
+/// @details This method is intended for the case where the caller overwrites all
+/// elements of the visibility cube. It decouples this class from the original accessor
+/// and resizes the buffer, but doesn't copy the data (i.e. values are undefined until
+/// written). The state is the same as after rwVisibility otherwise.
+void OnDemandBufferDataAccessor::useVisibilityBuffer()
+{
+  #ifdef _OPENMP
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+  #endif
+  const IConstDataAccessor &acc = getROAccessor();
+  itsBuffer.resize(acc.nRow(), acc.nChannel(), acc.nPol());
+  itsUseBuffer = true;
+}
+
+/// @brief declare a part of the visibility cube as modified
+/// @details The declaration is only kept by this class, the region is reset together with
+/// the cache (see discardCache). Consumers copying the buffer elsewhere can use it 
+/// to restrict the copy.
+/// @param[in] startRow first modified row
+/// @param[in] nRow number of modified rows
+/// @param[in] startChan first modified channel
+/// @param[in] nChan number of modified channels
+void OnDemandBufferDataAccessor::markVisibilityDirty(casacore::uInt startRow, casacore::uInt nRow,
+                                                     casacore::uInt startChan, casacore::uInt nChan)
+{
+  ASKAPCHECK((startRow + nRow <= this->nRow()) && (startChan + nChan <= nChannel()),
+             "Modified region of the visibility cube exceeds the chunk boundaries");
+  #ifdef _OPENMP
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+  #endif
+  itsDirtyRegion.add(startRow, nRow, startChan, nChan);
+}
+
+/// @brief part of the visibility cube declared as modified
+/// @return a reference to the region (empty if nothing has been declared)
+const DirtyRegion& OnDemandBufferDataAccessor::visibilityDirtyRegion() const
+{
+  if (itsUseBuffer) {
+      // the iterator could have advanced to the next chunk
+      checkBufferSize();
+  }
+  return itsDirtyRegion;
 }
 
@@ -40,6 +40,8 @@
 // own includes
 #include <askap/dataaccess/MetaDataAccessor.h>
 #include <askap/dataaccess/IDataAccessor.h>
+#include <askap/dataaccess/IDirtyRegionDataAccessor.h>
+#include <askap/dataaccess/DirtyRegion.h>
 
 // boost includes
 #include <boost/noncopyable.hpp>
@@ -63,6 +65,7 @@ namespace accessors {
 /// @ingroup dataaccess_hlp
 class OnDemandBufferDataAccessor : virtual public MetaDataAccessor,
                               virtual public IDataAccessor,
+                              virtual public IDirtyRegionDataAccessor,
                               public boost::noncopyable
 {
 public:
@@ -86,12 +89,34 @@ public:
   /// all visibility data
   ///
   virtual casacore::Cube<casacore::Complex>& rwVisibility();
+
+  /// @brief declare a part of the visibility cube as modified
+  /// @details The declaration is only kept by this class, the region is reset together with
+  /// the cache (see discardCache). Consumers copying
+  /// the buffer elsewhere can use it to restrict the copy.
+  /// @param[in] startRow first modified row
+  /// @param[in] nRow number of modified rows
+  /// @param[in] startChan first modified channel
+  /// @param[in] nChan number of modified channels
+  virtual void markVisibilityDirty(casacore::uInt startRow, casacore::uInt nRow,
+                                   casacore::uInt startChan, casacore::uInt nChan);
+
+  /// @brief part of the visibility cube declared as modified
+  /// @return a reference to the region (empty if nothing has been declared)
+  virtual const DirtyRegion& visibilityDirtyRegion() const;
   
   /// @brief discard the content of the cache
   /// @details A call to this method would switch the accessor to the pristine state
   /// it had straight after construction. A new call to rwVisibility would be required 
   /// to decouple from the read-only accessor 
   void discardCache();
+
+  /// @brief force the accessor to use the buffer without copying
+  /// @details This method is intended for the case where the caller overwrites all
+  /// elements of the visibility cube. It decouples this class from the original accessor
+  /// and resizes the buffer, but doesn't copy the data (i.e. values are undefined until
+  /// written). The state is the same as after rwVisibility otherwise.
+  void useVisibilityBuffer();
   
   /// @brief check whether this class is decoupled from the original accessor
   /// @details The first write request triggers creation of a buffer, which is used 
@@ -118,6 +143,9 @@ private:
   /// this buffer.
   mutable casacore::Cube<casacore::Complex> itsBuffer;
 
+  /// @brief part of the buffer declared as modified
+  DirtyRegion itsDirtyRegion;
+
   #ifdef _OPENMP
   /// @brief synchronisation object
   mutable boost::shared_mutex itsMutex;
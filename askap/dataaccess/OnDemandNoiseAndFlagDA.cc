@@ -34,6 +34,7 @@
 
 // own includes
 #include <askap/dataaccess/OnDemandNoiseAndFlagDA.h>
+#include <askap/dataaccess/WeightCalculator.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -68,6 +69,8 @@ casacore::Cube<casacore::Complex>& OnDemandNoiseAndFlagDA::rwNoise()
       itsNoiseSubstituted = true;
       itsNoiseBuffer.assign(getROAccessor().noise());
   }
+  // the caller may change the noise
+  itsWeight.invalidate();
   return itsNoiseBuffer;
 }
 
@@ -91,5 +94,58 @@ casacore::Cube<casacore::Bool>& OnDemandNoiseAndFlagDA::rwFlag()
       itsFlagSubstituted = true;
       itsFlagBuffer.assign(getROAccessor().flag());
   }
+  // the caller may change the flags
+  itsWeight.invalidate();
   return itsFlagBuffer;
 }
+
+/// @brief force the adapter to use the noise buffer without copying
+/// @details This method is intended for the case where the caller overwrites all
+/// elements of the noise cube. It detaches the adapter from the original noise and 
+/// resizes the buffer, but doesn't copy the data (i.e. values are undefined until written).
+/// All subsequent calls to noise and rwNoise work with the buffer.
+void OnDemandNoiseAndFlagDA::useNoiseBuffer()
+{
+  itsNoiseSubstituted = true;
+  const IConstDataAccessor &acc = getROAccessor();
+  itsNoiseBuffer.resize(acc.nRow(), acc.nChannel(), acc.nPol());
+  itsWeight.invalidate();
+}
+
+/// @brief force the adapter to use the flag buffer without copying
+/// @details This method is intended for the case where the caller overwrites all
+/// elements of the flag cube. It detaches the adapter from the original flags and 
+/// resizes the buffer, but doesn't copy the data (i.e. values are undefined until written).
+/// All subsequent calls to flag and rwFlag work with the buffer.
+void OnDemandNoiseAndFlagDA::useFlagBuffer()
+{
+  itsFlagSubstituted = true;
+  const IConstDataAccessor &acc = getROAccessor();
+  itsFlagBuffer.resize(acc.nRow(), acc.nChannel(), acc.nPol());
+  itsWeight.invalidate();
+}
+
+/// @brief weight of each visibility
+/// @details The weights are cached until the next call to one of the methods
+/// giving write access to noise or flags, so they should be obtained after all 
+/// modifications are done.
+/// @return a reference to nRow x nChannel x nPol cube with weights
+const casacore::Cube<casacore::Float>& OnDemandNoiseAndFlagDA::weight() const
+{
+  if (!itsFlagSubstituted && !itsNoiseSubstituted) {
+      const IWeightDataAccessor *weightAcc = dynamic_cast<const IWeightDataAccessor*>(&getROAccessor());
+      if (weightAcc != NULL) {
+          return weightAcc->weight();
+      }
+  }
+  return itsWeight.value(*this, &OnDemandNoiseAndFlagDA::fillWeight);
+}
+
+/// @brief compute weights from the current flag and noise cubes
+/// @param[in] weight a reference to the cube to fill
+void OnDemandNoiseAndFlagDA::fillWeight(casacore::Cube<casacore::Float> &weight) const
+{
+  const casacore::Cube<casacore::Bool> &flagCube = flag();
+  weight.resize(flagCube.shape());
+  WeightCalculator::fromNoise(flagCube, noise(), weight);
+}
@@ -38,6 +38,8 @@
 // own includes
 #include <askap/dataaccess/MemBufferDataAccessor.h>
 #include <askap/dataaccess/IFlagAndNoiseDataAccessor.h>
+#include <askap/dataaccess/IWeightDataAccessor.h>
+#include <askap/dataaccess/CachedAccessorField.h>
 
 
 namespace askap {
@@ -50,10 +52,13 @@ namespace accessors {
 /// By default the original metadata are returned by the noise() and flag() methods.
 /// However, at the first call to rwNoise or rwFlag, a copy has been created
 /// for the appropriate cube and returned for an optional modification. Then, this
-/// copied cube is returned by the read-only methods.
+/// copied cube is returned by the read-only methods. Weights (see IWeightDataAccessor)
+/// are taken from the original accessor if it provides them and neither cube has been 
+/// substituted, otherwise they are derived from the current flag and noise cubes.
 /// @ingroup dataaccess_hlp
 class OnDemandNoiseAndFlagDA : virtual public MemBufferDataAccessor,
-                               virtual public IFlagAndNoiseDataAccessor
+                               virtual public IFlagAndNoiseDataAccessor,
+                               virtual public IWeightDataAccessor
 {
 public:
   /// construct an object linked with the given const accessor
@@ -81,8 +86,33 @@ public:
   /// @return a reference to nRow x nChannel x nPol cube with the flag
   ///         information. If True, the corresponding element is flagged.
   virtual casacore::Cube<casacore::Bool>& rwFlag();
+
+  /// @brief weight of each visibility
+  /// @details The weights are cached until the next call to one of the methods
+  /// giving write access to noise or flags, so they should be obtained after all 
+  /// modifications are done.
+  /// @return a reference to nRow x nChannel x nPol cube with weights
+  virtual const casacore::Cube<casacore::Float>& weight() const;
+
+  /// @brief force the adapter to use the noise buffer without copying
+  /// @details This method is intended for the case where the caller overwrites all
+  /// elements of the noise cube. It detaches the adapter from the original noise and 
+  /// resizes the buffer, but doesn't copy the data (i.e. values are undefined until written).
+  /// All subsequent calls to noise and rwNoise work with the buffer.
+  void useNoiseBuffer();
+
+  /// @brief force the adapter to use the flag buffer without copying
+  /// @details This method is intended for the case where the caller overwrites all
+  /// elements of the flag cube. It detaches the adapter from the original flags and 
+  /// resizes the buffer, but doesn't copy the data (i.e. values are undefined until written).
+  /// All subsequent calls to flag and rwFlag work with the buffer.
+  void useFlagBuffer();
   
 private:  
+  /// @brief compute weights from the current flag and noise cubes
+  /// @param[in] weight a reference to the cube to fill
+  void fillWeight(casacore::Cube<casacore::Float> &weight) const;
+
   /// @brief if true, the flag buffer is to be used instead of metadata
   bool itsFlagSubstituted;
   
@@ -94,6 +124,9 @@ private:
   
   /// @brief buffer for noise (used if itsNoiseSubstituted is true)
   casacore::Cube<casacore::Complex> itsNoiseBuffer;   
+
+  /// @brief weights derived from the current flag and noise cubes
+  CachedAccessorField<casacore::Cube<casacore::Float> > itsWeight;
 };
 
 } // namespace accessors
@@ -0,0 +1,276 @@
+/// @file PackedFlagCube.cc
+/// @brief Bit-packed representation of the flag cube
+/// @details The flag cube returned by IConstDataAccessor::flag() uses one byte
+/// per element. Most consumers only need to test flags or to combine them, 
+/// which can be done 64 elements at a time using the bit-packed form implemented
+/// by this class. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#include <askap/dataaccess/PackedFlagCube.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty cube
+PackedFlagCube::PackedFlagCube() : itsNumberOfRows(0), itsNumberOfChannels(0),
+          itsNumberOfPols(0), itsWordsPerRow(0) {}
+
+/// @brief construct a cube of the given shape
+/// @details All elements are unflagged
+/// @param[in] nRow number of rows
+/// @param[in] nChan number of channels
+/// @param[in] nPol number of polarisations
+PackedFlagCube::PackedFlagCube(casacore::uInt nRow, casacore::uInt nChan, casacore::uInt nPol) :
+          itsNumberOfRows(0), itsNumberOfChannels(0), itsNumberOfPols(0), itsWordsPerRow(0)
+{
+  resize(nRow, nChan, nPol);
+}
+
+/// @brief change the shape
+/// @details All elements are unflagged after this call
+/// @param[in] nRow number of rows
+/// @param[in] nChan number of channels
+/// @param[in] nPol number of polarisations
+void PackedFlagCube::resize(casacore::uInt nRow, casacore::uInt nChan, casacore::uInt nPol)
+{
+  itsNumberOfRows = nRow;
+  itsNumberOfChannels = nChan;
+  itsNumberOfPols = nPol;
+  const size_t bitsPerRow = size_t(nChan) * nPol;
+  itsWordsPerRow = casacore::uInt((bitsPerRow + theirBitsPerWord - 1) / theirBitsPerWord);
+  itsWords.assign(size_t(nRow) * itsWordsPerRow, Word(0));
+}
+
+/// @brief mask of used bits in the last word of each row
+/// @return word with all used bits set
+PackedFlagCube::Word PackedFlagCube::lastWordMask() const
+{
+  const casacore::uInt usedBits = casacore::uInt((size_t(itsNumberOfChannels) * itsNumberOfPols) % theirBitsPerWord);
+  return usedBits == 0 ? ~Word(0) : ((Word(1) << usedBits) - Word(1));
+}
+
+/// @brief set the flag of one element
+/// @param[in] row row index
+/// @param[in] chan channel index
+/// @param[in] pol polarisation index
+/// @param[in] flag new value of the flag
+void PackedFlagCube::set(casacore::uInt row, casacore::uInt chan, casacore::uInt pol, bool flag)
+{
+  ASKAPDEBUGASSERT((row < itsNumberOfRows) && (chan < itsNumberOfChannels) && (pol < itsNumberOfPols));
+  const size_t bit = bitIndex(chan, pol);
+  Word &word = itsWords[size_t(row) * itsWordsPerRow + bit / theirBitsPerWord];
+  const Word mask = Word(1) << (bit % theirBitsPerWord);
+  if (flag) {
+      word |= mask;
+  } else {
+      word &= ~mask;
+  }
+}
+
+/// @brief flag all elements of one row
+/// @param[in] row row index
+void PackedFlagCube::flagRow(casacore::uInt row)
+{
+  ASKAPDEBUGASSERT(row < itsNumberOfRows);
+  if (itsWordsPerRow == 0) {
+      return;
+  }
+  Word *words = &itsWords[size_t(row) * itsWordsPerRow];
+  std::fill(words, words + itsWordsPerRow - 1, ~Word(0));
+  words[itsWordsPerRow - 1] = lastWordMask();
+}
+
+/// @brief unflag all elements
+void PackedFlagCube::clear()
+{
+  std::fill(itsWords.begin(), itsWords.end(), Word(0));
+}
+
+/// @brief check whether all elements of the row are flagged
+/// @param[in] row row index
+/// @return true, if the whole row is flagged
+bool PackedFlagCube::rowFlagged(casacore::uInt row) const
+{
+  ASKAPDEBUGASSERT(row < itsNumberOfRows);
+  if (itsWordsPerRow == 0) {
+      return true;
+  }
+  const Word *words = rowWords(row);
+  for (casacore::uInt i = 0; i + 1 < itsWordsPerRow; ++i) {
+       if (words[i] != ~Word(0)) {
+           return false;
+       }
+  }
+  return words[itsWordsPerRow - 1] == lastWordMask();
+}
+
+/// @brief check whether any element of the row is flagged
+/// @param[in] row row index
+/// @return true, if at least one element of the row is flagged
+bool PackedFlagCube::anyFlagged(casacore::uInt row) const
+{
+  ASKAPDEBUGASSERT(row < itsNumberOfRows);
+  const Word *words = rowWords(row);
+  for (casacore::uInt i = 0; i < itsWordsPerRow; ++i) {
+       if (words[i] != Word(0)) {
+           return true;
+       }
+  }
+  return false;
+}
+
+/// @brief number of flagged elements in the row
+/// @param[in] row row index
+/// @return number of flagged elements
+casacore::uInt PackedFlagCube::nFlagged(casacore::uInt row) const
+{
+  ASKAPDEBUGASSERT(row < itsNumberOfRows);
+  const Word *words = rowWords(row);
+  casacore::uInt result = 0;
+  for (casacore::uInt i = 0; i < itsWordsPerRow; ++i) {
+       result += popCount(words[i]);
+  }
+  return result;
+}
+
+/// @brief number of flagged elements in the whole cube
+/// @return number of flagged elements
+size_t PackedFlagCube::nFlagged() const
+{
+  size_t result = 0;
+  for (std::vector<Word>::const_iterator ci = itsWords.begin(); ci != itsWords.end(); ++ci) {
+       result += popCount(*ci);
+  }
+  return result;
+}
+
+/// @brief combine flags with another cube (logical OR)
+/// @details Element is flagged if it is flagged in either cube. Shapes should match.
+/// @param[in] other other cube
+void PackedFlagCube::orWith(const PackedFlagCube &other)
+{
+  ASKAPCHECK((other.nRow() == nRow()) && (other.nChannel() == nChannel()) && (other.nPol() == nPol()),
+             "Shapes of the packed flag cubes don't match");
+  std::vector<Word>::const_iterator ci = other.itsWords.begin();
+  for (std::vector<Word>::iterator it = itsWords.begin(); it != itsWords.end(); ++it,++ci) {
+       *it |= *ci;
+  }
+}
+
+/// @brief combine flags with another cube (logical AND)
+/// @details Element is flagged if it is flagged in both cubes. Shapes should match.
+/// @param[in] other other cube
+void PackedFlagCube::andWith(const PackedFlagCube &other)
+{
+  ASKAPCHECK((other.nRow() == nRow()) && (other.nChannel() == nChannel()) && (other.nPol() == nPol()),
+             "Shapes of the packed flag cubes don't match");
+  std::vector<Word>::const_iterator ci = other.itsWords.begin();
+  for (std::vector<Word>::iterator it = itsWords.begin(); it != itsWords.end(); ++it,++ci) {
+       *it &= *ci;
+  }
+}
+
+/// @brief pack flags given in the accessor order
+/// @param[in] flags nRow x nChannel x nPol cube of flags
+void PackedFlagCube::pack(const casacore::Cube<casacore::Bool> &flags)
+{
+  resize(flags.nrow(), flags.ncolumn(), flags.nplane());
+  for (casacore::uInt pol = 0; pol < itsNumberOfPols; ++pol) {
+       for (casacore::uInt chan = 0; chan < itsNumberOfChannels; ++chan) {
+            const size_t bit = bitIndex(chan, pol);
+            const size_t wordOffset = bit / theirBitsPerWord;
+            const Word mask = Word(1) << (bit % theirBitsPerWord);
+            for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+                 if (flags(row, chan, pol)) {
+                     itsWords[size_t(row) * itsWordsPerRow + wordOffset] |= mask;
+                 }
+            }
+       }
+  }
+}
+
+/// @brief pack flags given in the storage order
+/// @param[in] flags nPol x nChannel x nRow cube of flags
+void PackedFlagCube::packNative(const casacore::Cube<casacore::Bool> &flags)
+{
+  resize(flags.nplane(), flags.ncolumn(), flags.nrow());
+  if (flags.contiguousStorage()) {
+      const casacore::Bool *flagPtr = flags.data();
+      const size_t rowStep = size_t(itsNumberOfChannels) * itsNumberOfPols;
+      for (casacore::uInt row = 0; row < itsNumberOfRows; ++row, flagPtr += rowStep) {
+           packRow(row, flagPtr);
+      }
+  } else {
+      for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+           for (casacore::uInt chan = 0; chan < itsNumberOfChannels; ++chan) {
+                for (casacore::uInt pol = 0; pol < itsNumberOfPols; ++pol) {
+                     if (flags(pol, chan, row)) {
+                         set(row, chan, pol, true);
+                     }
+                }
+           }
+      }
+  }
+}
+
+/// @brief pack flags of one row given in the storage order
+/// @details This method doesn't change the shape of the cube
+/// @param[in] row row index
+/// @param[in] flags pointer to nPol x nChannel contiguous flags of this row
+void PackedFlagCube::packRow(casacore::uInt row, const casacore::Bool *flags)
+{
+  ASKAPDEBUGASSERT(row < itsNumberOfRows);
+  Word *words = &itsWords[size_t(row) * itsWordsPerRow];
+  const size_t bitsPerRow = size_t(itsNumberOfChannels) * itsNumberOfPols;
+  // the bit order matches the storage order, so whole words can be assembled at once
+  for (casacore::uInt word = 0; word < itsWordsPerRow; ++word) {
+       const size_t start = size_t(word) * theirBitsPerWord;
+       const size_t end = std::min(start + theirBitsPerWord, bitsPerRow);
+       Word result = 0;
+       for (size_t bit = start; bit < end; ++bit) {
+            result |= Word(flags[bit] ? 1 : 0) << (bit - start);
+       }
+       words[word] = result;
+  }
+}
+
+/// @brief unpack flags into a cube in the accessor order
+/// @param[out] flags nRow x nChannel x nPol cube of flags (resized as necessary)
+void PackedFlagCube::unpack(casacore::Cube<casacore::Bool> &flags) const
+{
+  flags.resize(itsNumberOfRows, itsNumberOfChannels, itsNumberOfPols);
+  for (casacore::uInt pol = 0; pol < itsNumberOfPols; ++pol) {
+       for (casacore::uInt chan = 0; chan < itsNumberOfChannels; ++chan) {
+            for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+                 flags(row, chan, pol) = (*this)(row, chan, pol);
+            }
+       }
+  }
+}
@@ -0,0 +1,210 @@
+/// @file PackedFlagCube.h
+/// @brief Bit-packed representation of the flag cube
+/// @details The flag cube returned by IConstDataAccessor::flag() uses one byte
+/// per element. Most consumers only need to test flags or to combine them, 
+/// which can be done 64 elements at a time using the bit-packed form implemented
+/// by this class. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+#ifndef ASKAP_ACCESSORS_PACKED_FLAG_CUBE_H
+#define ASKAP_ACCESSORS_PACKED_FLAG_CUBE_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Bit-packed representation of the flag cube
+/// @details Flags of each row are stored as a sequence of bits ordered the same
+/// way as the data in the measurement set, i.e. polarisation is the most rapidly 
+/// varying index followed by the channel (bit number is chan * nPol + pol). Each row 
+/// starts at the word boundary and unused bits of the last word of the row are always 
+/// zero. Therefore, row-wise operations (e.g. check for a fully flagged row) work on the
+/// whole 64-bit words. Element (row,chan,pol) corresponds to element (row,chan,pol)
+/// of the cube returned by IConstDataAccessor::flag().
+/// @ingroup dataaccess_hlp
+class PackedFlagCube {
+public:
+  /// @brief type of the word used for packing
+  typedef casacore::uInt64 Word;
+
+  /// @brief number of bits in one word
+  static const casacore::uInt theirBitsPerWord = 64;
+
+  /// @brief construct an empty cube
+  PackedFlagCube();
+
+  /// @brief construct a cube of the given shape
+  /// @details All elements are unflagged
+  /// @param[in] nRow number of rows
+  /// @param[in] nChan number of channels
+  /// @param[in] nPol number of polarisations
+  PackedFlagCube(casacore::uInt nRow, casacore::uInt nChan, casacore::uInt nPol);
+
+  /// @brief change the shape
+  /// @details All elements are unflagged after this call
+  /// @param[in] nRow number of rows
+  /// @param[in] nChan number of channels
+  /// @param[in] nPol number of polarisations
+  void resize(casacore::uInt nRow, casacore::uInt nChan, casacore::uInt nPol);
+
+  /// @return number of rows
+  inline casacore::uInt nRow() const { return itsNumberOfRows;}
+
+  /// @return number of channels
+  inline casacore::uInt nChannel() const { return itsNumberOfChannels;}
+
+  /// @return number of polarisations
+  inline casacore::uInt nPol() const { return itsNumberOfPols;}
+
+  /// @return number of words used to store one row
+  inline casacore::uInt wordsPerRow() const { return itsWordsPerRow;}
+
+  /// @brief test the flag of one element
+  /// @param[in] row row index
+  /// @param[in] chan channel index
+  /// @param[in] pol polarisation index
+  /// @return true, if the element is flagged
+  inline bool operator()(casacore::uInt row, casacore::uInt chan, casacore::uInt pol) const
+  { const size_t bit = bitIndex(chan, pol); 
+    return (rowWords(row)[bit / theirBitsPerWord] >> (bit % theirBitsPerWord)) & Word(1); }
+
+  /// @brief set the flag of one element
+  /// @param[in] row row index
+  /// @param[in] chan channel index
+  /// @param[in] pol polarisation index
+  /// @param[in] flag new value of the flag
+  void set(casacore::uInt row, casacore::uInt chan, casacore::uInt pol, bool flag);
+
+  /// @brief flag all elements of one row
+  /// @param[in] row row index
+  void flagRow(casacore::uInt row);
+
+  /// @brief unflag all elements
+  void clear();
+
+  /// @brief check whether all elements of the row are flagged
+  /// @param[in] row row index
+  /// @return true, if the whole row is flagged
+  bool rowFlagged(casacore::uInt row) const;
+
+  /// @brief check whether any element of the row is flagged
+  /// @param[in] row row index
+  /// @return true, if at least one element of the row is flagged
+  bool anyFlagged(casacore::uInt row) const;
+
+  /// @brief number of flagged elements in the row
+  /// @param[in] row row index
+  /// @return number of flagged elements
+  casacore::uInt nFlagged(casacore::uInt row) const;
+
+  /// @brief number of flagged elements in the whole cube
+  /// @return number of flagged elements
+  size_t nFlagged() const;
+
+  /// @brief combine flags with another cube (logical OR)
+  /// @details Element is flagged if it is flagged in either cube. Shapes should match.
+  /// @param[in] other other cube
+  void orWith(const PackedFlagCube &other);
+
+  /// @brief combine flags with another cube (logical AND)
+  /// @details Element is flagged if it is flagged in both cubes. Shapes should match.
+  /// @param[in] other other cube
+  void andWith(const PackedFlagCube &other);
+
+  /// @brief pack flags given in the accessor order
+  /// @param[in] flags nRow x nChannel x nPol cube of flags
+  void pack(const casacore::Cube<casacore::Bool> &flags);
+
+  /// @brief pack flags given in the storage order
+  /// @param[in] flags nPol x nChannel x nRow cube of flags
+  void packNative(const casacore::Cube<casacore::Bool> &flags);
+
+  /// @brief pack flags of one row given in the storage order
+  /// @details This method doesn't change the shape of the cube
+  /// @param[in] row row index
+  /// @param[in] flags pointer to nPol x nChannel contiguous flags of this row
+  void packRow(casacore::uInt row, const casacore::Bool *flags);
+
+  /// @brief unpack flags into a cube in the accessor order
+  /// @param[out] flags nRow x nChannel x nPol cube of flags (resized as necessary)
+  void unpack(casacore::Cube<casacore::Bool> &flags) const;
+
+  /// @brief access the words of one row
+  /// @param[in] row row index
+  /// @return pointer to wordsPerRow() words 
+  inline const Word* rowWords(casacore::uInt row) const 
+  { return &itsWords[size_t(row) * itsWordsPerRow];}
+
+  /// @brief count set bits in a word
+  /// @param[in] word word to process
+  /// @return number of bits set
+  static inline casacore::uInt popCount(Word word) 
+  { word = word - ((word >> 1) & Word(0x5555555555555555ULL));
+    word = (word & Word(0x3333333333333333ULL)) + ((word >> 2) & Word(0x3333333333333333ULL));
+    word = (word + (word >> 4)) & Word(0x0F0F0F0F0F0F0F0FULL);
+    return casacore::uInt((word * Word(0x0101010101010101ULL)) >> 56); }
+
+protected:
+  /// @brief bit index within the row
+  /// @param[in] chan channel index
+  /// @param[in] pol polarisation index
+  /// @return index of the bit corresponding to this element
+  inline size_t bitIndex(casacore::uInt chan, casacore::uInt pol) const
+  { return size_t(chan) * itsNumberOfPols + pol;}
+
+  /// @brief mask of used bits in the last word of each row
+  /// @return word with all used bits set
+  Word lastWordMask() const;
+
+private:
+  /// @brief number of rows
+  casacore::uInt itsNumberOfRows;
+
+  /// @brief number of channels
+  casacore::uInt itsNumberOfChannels;
+
+  /// @brief number of polarisations
+  casacore::uInt itsNumberOfPols;
+
+  /// @brief number of words per row
+  casacore::uInt itsWordsPerRow;
+
+  /// @brief packed flags
+  std::vector<Word> itsWords;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PACKED_FLAG_CUBE_H
@@ -0,0 +1,160 @@
+/// @file
+/// @brief parallactic angles for all antennas at once
+/// @details The straightforward computation of the parallactic angle sets up
+/// a new measures frame and converts two directions into the AZEL frame for each
+/// antenna at every time step. This class converts the reference direction once
+/// per time step and derives the angles for all antennas from the hour angle and 
+/// declination analytically. The antenna-dependent quantities are computed when
+/// the object is created.
+///
+/// @copyright (c) 2026 CSIRO
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/ParallacticAngleEngine.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MCDirection.h>
+#include <casacore/measures/Measures/MCPosition.h>
+#include <casacore/measures/Measures/MeasConvert.h>
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <cmath>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the engine for the given antennas
+/// @details The mount types and positions are analysed, an exception is thrown
+/// for an unknown mount type.
+/// @param[in] antennas antenna subtable handler
+/// @param[in] interval maximum time difference in seconds for which the last conversion
+/// to HADEC is reused (zero means that the conversion is done for every new time)
+ParallacticAngleEngine::ParallacticAngleEngine(const IAntennaSubtableHandler &antennas, double interval) :
+      itsInterval(interval), itsHasAltAz(false), itsValid(false), itsTime(0.), itsHA(0.), 
+      itsDec(0.), itsNConversions(0)
+{
+  ASKAPCHECK(interval >= 0., "Interpolation interval for parallactic angles should be non-negative, you have "<<
+             interval);
+  const casacore::uInt nAnt = antennas.getNumberOfAntennae();
+  itsAltAz.resize(nAnt, false);
+  itsSinLat.resize(nAnt);
+  itsCosLat.resize(nAnt);
+  itsDeltaLong.resize(nAnt);
+  itsSinLat.set(0.);
+  itsCosLat.set(1.);
+  itsDeltaLong.set(0.);
+  casacore::Double refLong = 0.;
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const casacore::String &antMount = antennas.getMount(ant);
+       if (antMount == "ALT-AZ" || antMount == "alt-az")  {
+           itsAltAz[ant] = true;
+           // geocentric latitude and longitude, as used by the AZEL frame
+           const casacore::MVPosition pos = casacore::MPosition::Convert(antennas.getPosition(ant),
+                       casacore::MPosition::ITRF)().getValue();
+           itsSinLat[ant] = sin(pos.getLat());
+           itsCosLat[ant] = cos(pos.getLat());
+           if (!itsHasAltAz) {
+               itsRefPosition = antennas.getPosition(ant);
+               refLong = pos.getLong();
+               itsHasAltAz = true;
+           }
+           itsDeltaLong[ant] = pos.getLong() - refLong;
+       } else if (antMount != "EQUATORIAL" && antMount != "equatorial" &&
+                  antMount != "FIXED" && antMount != "fixed" &&
+                  antMount != "X-Y" && antMount != "x-y") {
+           // LOFAR has a fixed antenna mount, X-Y mounts have no parallactic angle rotation
+           ASKAPTHROW(DataAccessError,"Unknown mount type "<<antMount<<
+              " for antenna "<<ant);
+       }
+  }
+}
+
+/// @brief update the hour angle and declination for the given time and direction
+/// @details The conversion is done if the time differs from that of the last 
+/// conversion by more than the interval or the direction has changed.
+/// @param[in] epoch time of the observation
+/// @param[in] dir reference direction
+/// @return hour angle for the reference antenna at the given time
+casacore::Double ParallacticAngleEngine::updateHADec(const casacore::MEpoch &epoch, 
+                                                     const casacore::MDirection &dir)
+{
+  const casacore::Double time = epoch.getValue().get();
+  if (itsValid && (itsDirection.getRef().getType() == dir.getRef().getType()) && 
+      !(itsDirection.getValue() != dir.getValue())) {
+      const casacore::Double dt = (time - itsTime) * 86400.;
+      if (std::abs(dt) <= itsInterval) {
+          // advance the hour angle at the sidereal rate, the time of the
+          // conversion is kept, so the errors don't accumulate
+          const casacore::Double siderealRate = 2. * casacore::C::pi * 1.002737909350795 / 86400.;
+          return itsHA + siderealRate * dt;
+      }
+  }
+  ASKAPDEBUGASSERT(itsHasAltAz);
+  const casacore::MeasFrame frame(epoch, itsRefPosition);
+  const casacore::MVDirection haDec = casacore::MDirection::Convert(dir,
+             casacore::MDirection::Ref(casacore::MDirection::HADEC, frame))().getValue();
+  itsHA = haDec.getLong();
+  itsDec = haDec.getLat();
+  itsTime = time;
+  itsDirection = dir;
+  itsValid = true;
+  ++itsNConversions;
+  return itsHA;
+}
+
+/// @brief compute parallactic angles
+/// @param[in] epoch time of the observation
+/// @param[in] dir reference direction (e.g. the field centre)
+/// @param[out] angles parallactic angles in radians for all antennas (resized as required)
+void ParallacticAngleEngine::compute(const casacore::MEpoch &epoch, const casacore::MDirection &dir,
+                                     casacore::Vector<casacore::Double> &angles)
+{
+  const casacore::uInt nAnt = itsSinLat.nelements();
+  angles.resize(nAnt);
+  angles.set(0.);
+  if (!itsHasAltAz) {
+      return;
+  }
+  const casacore::Double refHA = updateHADec(epoch, dir);
+  const casacore::Double sinDec = sin(itsDec);
+  const casacore::Double cosDec = cos(itsDec);
+  const casacore::Double *sinLat = itsSinLat.data();
+  const casacore::Double *cosLat = itsCosLat.data();
+  const casacore::Double *deltaLong = itsDeltaLong.data();
+  casacore::Double *out = angles.data();
+  ASKAPDEBUGASSERT(angles.contiguousStorage());
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       if (itsAltAz[ant]) {
+           const casacore::Double ha = refHA + deltaLong[ant];
+           out[ant] = atan2(cosLat[ant] * sin(ha), sinLat[ant] * cosDec - cosLat[ant] * sinDec * cos(ha));
+       }
+  }
+}
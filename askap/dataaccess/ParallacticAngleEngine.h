@@ -0,0 +1,148 @@
+/// @file
+/// @brief parallactic angles for all antennas at once
+/// @details The straightforward computation of the parallactic angle sets up
+/// a new measures frame and converts two directions into the AZEL frame for each
+/// antenna at every time step. This class converts the reference direction once
+/// per time step and derives the angles for all antennas from the hour angle and 
+/// declination analytically. The antenna-dependent quantities are computed when
+/// the object is created.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_PARALLACTIC_ANGLE_ENGINE_H
+#define ASKAP_ACCESSORS_PARALLACTIC_ANGLE_ENGINE_H
+
+// std includes
+#include <vector>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MPosition.h>
+
+// own includes
+#include <askap/dataaccess/IAntennaSubtableHandler.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief parallactic angles for all antennas at once
+/// @details For alt-az antennas the parallactic angle q is given by
+/// tan q = cos(lat) sin(H) / (sin(lat) cos(dec) - cos(lat) sin(dec) cos(H)), where H and
+/// dec are the apparent hour angle and declination and lat is the geocentric latitude
+/// (as used by the AZEL frame). The reference direction is converted to HADEC once
+/// per time step for the first alt-az antenna, the hour angles for other antennas 
+/// differ by the difference in longitude. Diurnal aberration is therefore only taken 
+/// into account for one antenna, the error is well below a micro-radian. Angles are zero
+/// for equatorial, X-Y and fixed mounts. Optionally, the conversion can be reused for 
+/// nearby time steps: if the reference direction is the same and the time differs by no 
+/// more than the given interval, the hour angle is advanced at the sidereal rate and the 
+/// declination is kept.
+/// @ingroup dataaccess_tab
+class ParallacticAngleEngine {
+public:
+  /// @brief set up the engine for the given antennas
+  /// @details The mount types and positions are analysed, an exception is thrown
+  /// for an unknown mount type.
+  /// @param[in] antennas antenna subtable handler
+  /// @param[in] interval maximum time difference in seconds for which the last conversion
+  /// to HADEC is reused (zero means that the conversion is done for every new time)
+  explicit ParallacticAngleEngine(const IAntennaSubtableHandler &antennas, double interval = 0.);
+
+  /// @brief compute parallactic angles
+  /// @param[in] epoch time of the observation
+  /// @param[in] dir reference direction (e.g. the field centre)
+  /// @param[out] angles parallactic angles in radians for all antennas (resized as required)
+  void compute(const casacore::MEpoch &epoch, const casacore::MDirection &dir,
+               casacore::Vector<casacore::Double> &angles);
+
+  /// @brief interval in seconds for which the conversion is reused
+  /// @return interval given in the constructor
+  inline double interval() const { return itsInterval; }
+
+  /// @brief number of conversions of the reference direction done so far
+  /// @return number of HADEC conversions (the remaining time steps were interpolated)
+  inline size_t nConversions() const { return itsNConversions; }
+
+protected:
+  /// @brief update the hour angle and declination for the given time and direction
+  /// @details The conversion is done if the time differs from that of the last 
+  /// conversion by more than the interval or the direction has changed.
+  /// @param[in] epoch time of the observation
+  /// @param[in] dir reference direction
+  /// @return hour angle for the reference antenna at the given time
+  casacore::Double updateHADec(const casacore::MEpoch &epoch, const casacore::MDirection &dir);
+
+private:
+  /// @brief maximum time difference (in seconds) to reuse the conversion
+  double itsInterval;
+
+  /// @brief true, for antennas with alt-az mount
+  std::vector<bool> itsAltAz;
+
+  /// @brief sine of the geocentric latitude for each antenna
+  casacore::Vector<casacore::Double> itsSinLat;
+
+  /// @brief cosine of the geocentric latitude for each antenna
+  casacore::Vector<casacore::Double> itsCosLat;
+
+  /// @brief longitude difference from the reference antenna (radians) for each antenna
+  casacore::Vector<casacore::Double> itsDeltaLong;
+
+  /// @brief position of the reference antenna (the first alt-az antenna)
+  casacore::MPosition itsRefPosition;
+
+  /// @brief true, if there is at least one alt-az antenna
+  bool itsHasAltAz;
+
+  /// @brief true, if the hour angle and declination below are valid
+  bool itsValid;
+
+  /// @brief time (in days) the conversion has been done for
+  casacore::Double itsTime;
+
+  /// @brief direction the conversion has been done for
+  casacore::MDirection itsDirection;
+
+  /// @brief hour angle of the reference direction for the reference antenna at itsTime
+  /// (i.e. at the time of the last conversion)
+  casacore::Double itsHA;
+
+  /// @brief apparent declination of the reference direction
+  casacore::Double itsDec;
+
+  /// @brief number of conversions done
+  size_t itsNConversions;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PARALLACTIC_ANGLE_ENGINE_H
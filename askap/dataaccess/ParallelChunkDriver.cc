@@ -0,0 +1,304 @@
+/// @file
+/// @brief parallel processing of the chunks of a measurement set
+/// @details Tools consuming IConstDataSharedIter run their own loop over chunks. This
+/// class provides one place to process the chunks in parallel: the selected data are split
+/// into partitions (see TableConstDataSource::createPartitionedIterators), each partition is
+/// driven by its own iterator and the partitions are scheduled on a pool of threads with
+/// work stealing, so a thread which has finished its partitions takes over the remaining
+/// ones of a busier thread.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/dataaccess/ParallelChunkDriver.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/TableConstDataIterator.h>
+#include <askap/dataaccess/TableDataIterator.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/locks.hpp>
+
+// std includes
+#include <exception>
+
+ASKAP_LOGGER(logger, ".dataaccess");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up the driver
+/// @param[in] nThreads number of threads
+/// @param[in] type type of partitioning
+/// @param[in] partitionsPerThread number of partitions per thread (more partitions give
+/// a finer granularity for load balancing at the expense of more iterators)
+ParallelChunkDriver::ParallelChunkDriver(size_t nThreads, TableConstDataSource::PartitionType type,
+           size_t partitionsPerThread) : itsNThreads(nThreads), itsType(type),
+           itsPartitionsPerThread(partitionsPerThread), itsOrdered(false), itsNumaAware(false),
+           itsNSteals(0)
+{
+  ASKAPCHECK(nThreads > 0, "ParallelChunkDriver requires at least one thread");
+  ASKAPCHECK(partitionsPerThread > 0, "ParallelChunkDriver requires at least one partition per thread");
+  itsQueues.reserve(nThreads);
+  for (size_t thread = 0; thread < nThreads; ++thread) {
+       itsQueues.push_back(boost::shared_ptr<PartitionQueue>(new PartitionQueue));
+  }
+}
+
+/// @brief process all selected chunks of a data source
+/// @param[in] ds data source
+/// @param[in] sel selector
+/// @param[in] conv converter
+/// @param[in] functor functor called for every chunk (pass stateful functors via boost::ref)
+/// @return number of processed chunks
+size_t ParallelChunkDriver::run(const TableConstDataSource &ds, const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, const ConstFunctor &functor)
+{
+  ASKAPCHECK(functor, "An empty functor is passed to ParallelChunkDriver::run");
+  const std::vector<boost::shared_ptr<IConstDataIterator> > iters =
+        ds.createPartitionedIterators(sel, conv, itsType, casacore::uInt(nPartitions()), itsNumaAware);
+  return process(iters, functor);
+}
+
+/// @brief process and modify all selected chunks of a data source
+/// @details Partitions are driven by read-write iterators (see
+/// TableDataSource::createPartitionedRWIterators). All modifications are in the table
+/// when this method returns.
+/// @param[in] ds data source
+/// @param[in] sel selector
+/// @param[in] conv converter
+/// @param[in] functor functor called for every chunk (pass stateful functors via boost::ref)
+/// @return number of processed chunks
+size_t ParallelChunkDriver::runRW(const TableDataSource &ds, const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, const Functor &functor)
+{
+  ASKAPCHECK(functor, "An empty functor is passed to ParallelChunkDriver::runRW");
+  const std::vector<boost::shared_ptr<IDataIterator> > iters =
+        ds.createPartitionedRWIterators(sel, conv, itsType, casacore::uInt(nPartitions()), itsNumaAware);
+  const size_t nChunks = process(iters, functor);
+  // the last chunks of all partitions may still be waiting for the shared writer
+  for (size_t part = 0; part < iters.size(); ++part) {
+       const boost::shared_ptr<TableDataIterator> tabIt =
+             boost::dynamic_pointer_cast<TableDataIterator>(iters[part]);
+       if (tabIt) {
+           tabIt->sync();
+       }
+  }
+  return nChunks;
+}
+
+/// @brief number of partitions stolen by other threads during the last run
+size_t ParallelChunkDriver::nSteals() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsNSteals;
+}
+
+/// @brief distribute partitions between the thread queues
+void ParallelChunkDriver::resetQueues()
+{
+  for (size_t thread = 0; thread < itsNThreads; ++thread) {
+       boost::lock_guard<boost::mutex> lock(itsQueues[thread]->itsMutex);
+       itsQueues[thread]->itsPartitions.clear();
+  }
+  for (size_t part = 0; part < nPartitions(); ++part) {
+       PartitionQueue &queue = *itsQueues[part % itsNThreads];
+       boost::lock_guard<boost::mutex> lock(queue.itsMutex);
+       queue.itsPartitions.push_back(part);
+  }
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsError.clear();
+  itsNSteals = 0;
+}
+
+/// @brief take the next partition for the given thread
+/// @param[in] thread thread index
+/// @param[out] part partition index
+/// @return false if there is no work left (or processing has failed)
+bool ParallelChunkDriver::takePartition(size_t thread, size_t &part)
+{
+  ASKAPDEBUGASSERT(thread < itsNThreads);
+  if (hasFailed()) {
+      return false;
+  }
+  {
+    PartitionQueue &own = *itsQueues[thread];
+    boost::lock_guard<boost::mutex> lock(own.itsMutex);
+    if (!own.itsPartitions.empty()) {
+        part = own.itsPartitions.front();
+        own.itsPartitions.pop_front();
+        return true;
+    }
+  }
+  if (itsOrdered) {
+      return false;
+  }
+  // steal from the back of other queues, i.e. the partitions their owners would process last
+  for (size_t offset = 1; offset < itsNThreads; ++offset) {
+       PartitionQueue &other = *itsQueues[(thread + offset) % itsNThreads];
+       boost::lock_guard<boost::mutex> lock(other.itsMutex);
+       if (!other.itsPartitions.empty()) {
+           part = other.itsPartitions.back();
+           other.itsPartitions.pop_back();
+           boost::lock_guard<boost::mutex> statsLock(itsMutex);
+           ++itsNSteals;
+           return true;
+       }
+  }
+  return false;
+}
+
+/// @brief record the failure of a thread
+/// @param[in] error error message
+void ParallelChunkDriver::fail(const std::string &error)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (itsError.empty()) {
+      itsError = error.empty() ? std::string("unknown error") : error;
+  }
+}
+
+/// @brief check whether processing has failed
+bool ParallelChunkDriver::hasFailed() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return !itsError.empty();
+}
+
+/// @brief body of a worker thread
+/// @param[in] iters iterators, one per partition
+/// @param[in] functor functor to call
+/// @param[in] thread thread index
+/// @param[out] nChunks number of chunks processed by this thread
+template<typename Iter, typename F>
+void ParallelChunkDriver::work(const std::vector<boost::shared_ptr<Iter> > &iters, const F &functor,
+            size_t thread, size_t &nChunks)
+{
+  try {
+     size_t part = 0;
+     while (takePartition(thread, part)) {
+            ASKAPDEBUGASSERT(part < iters.size());
+            Iter &it = *iters[part];
+            if (itsNumaAware) {
+                const TableConstDataIterator *tabIt = dynamic_cast<const TableConstDataIterator*>(&it);
+                if (tabIt != NULL) {
+                    tabIt->affinity().apply();
+                }
+            }
+            for (; it.hasMore() && !hasFailed(); it.next()) {
+                 functor(*it, thread);
+                 ++nChunks;
+            }
+     }
+  }
+  catch (const std::exception &ex) {
+     fail(ex.what());
+  }
+  catch (...) {
+     fail("unknown exception");
+  }
+}
+
+/// @brief run worker threads and wait for them
+/// @param[in] iters iterators, one per partition
+/// @param[in] functor functor to call
+/// @return number of processed chunks
+template<typename Iter, typename F>
+size_t ParallelChunkDriver::process(const std::vector<boost::shared_ptr<Iter> > &iters, const F &functor)
+{
+  ASKAPDEBUGASSERT(iters.size() == nPartitions());
+  resetQueues();
+  std::vector<size_t> nChunks(itsNThreads, 0);
+  if (itsNThreads == 1) {
+      work(iters, functor, 0, nChunks[0]);
+  } else {
+      boost::thread_group threads;
+      for (size_t thread = 0; thread < itsNThreads; ++thread) {
+           threads.create_thread(boost::bind(&ParallelChunkDriver::work<Iter, F>, this,
+                    boost::cref(iters), boost::cref(functor), thread, boost::ref(nChunks[thread])));
+      }
+      threads.join_all();
+  }
+  size_t total = 0;
+  for (size_t thread = 0; thread < itsNThreads; ++thread) {
+       total += nChunks[thread];
+  }
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    if (!itsError.empty()) {
+        ASKAPTHROW(DataAccessError, "Parallel processing of chunks has failed: "<<itsError);
+    }
+    ASKAPLOG_DEBUG_STR(logger, "Processed "<<total<<" chunks in "<<nPartitions()<<" partitions with "<<
+                       itsNThreads<<" threads, "<<itsNSteals<<" partitions have been stolen");
+  }
+  return total;
+}
+
+/// @brief process all selected chunks of a data source in parallel
+/// @details This is a convenience function, see ParallelChunkDriver for details
+/// @param[in] ds data source
+/// @param[in] sel selector
+/// @param[in] conv converter
+/// @param[in] functor functor called for every chunk with the accessor and the thread index
+/// @param[in] nThreads number of threads
+/// @return number of processed chunks
+size_t parallelForEachChunk(const TableConstDataSource &ds, const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, const ParallelChunkDriver::ConstFunctor &functor,
+             size_t nThreads)
+{
+  ParallelChunkDriver driver(nThreads);
+  return driver.run(ds, sel, conv, functor);
+}
+
+/// @brief process and modify all selected chunks of a data source in parallel
+/// @details This is a convenience function, see ParallelChunkDriver for details
+/// @param[in] ds data source
+/// @param[in] sel selector
+/// @param[in] conv converter
+/// @param[in] functor functor called for every chunk with the accessor and the thread index
+/// @param[in] nThreads number of threads
+/// @param[in] ordered if true, the ordered mode is used (see ParallelChunkDriver)
+/// @return number of processed chunks
+size_t parallelForEachChunkRW(const TableDataSource &ds, const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, const ParallelChunkDriver::Functor &functor,
+             size_t nThreads, bool ordered)
+{
+  ParallelChunkDriver driver(nThreads);
+  driver.setOrdered(ordered);
+  return driver.runRW(ds, sel, conv, functor);
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,241 @@
+/// @file
+/// @brief parallel processing of the chunks of a measurement set
+/// @details Tools consuming IConstDataSharedIter run their own loop over chunks. This
+/// class provides one place to process the chunks in parallel: the selected data are split
+/// into partitions (see TableConstDataSource::createPartitionedIterators), each partition is
+/// driven by its own iterator and the partitions are scheduled on a pool of threads with
+/// work stealing, so a thread which has finished its partitions takes over the remaining
+/// ones of a busier thread.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_PARALLEL_CHUNK_DRIVER_H
+#define ASKAP_ACCESSORS_PARALLEL_CHUNK_DRIVER_H
+
+// std includes
+#include <deque>
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IDataAccessor.h>
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/IDataIterator.h>
+#include <askap/dataaccess/IDataSelector.h>
+#include <askap/dataaccess/IDataConverter.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief parallel processing of the chunks of a measurement set
+/// @details The selected data are split into nThreads * partitionsPerThread partitions.
+/// Partitions are initially distributed between the threads in a round-robin fashion.
+/// Each thread processes the partitions from its own queue, taking chunks of each
+/// partition in order, and steals partitions from the back of the queues of other threads
+/// when its own queue is empty. Every partition has its own iterator, therefore accessor
+/// buffers are never shared between threads and the background read-ahead of the iterators
+/// (see TableConstDataSource::configurePrefetch) works for all partitions independently.
+/// The functor receives the accessor and the index of the thread (from 0 to nThreads-1),
+/// which can be used to address per-thread accumulators without locking.
+///
+/// In the ordered mode, stealing is switched off: thread t processes partitions t,
+/// t + nThreads, t + 2*nThreads, ... in this order. The outcome is then reproducible
+/// from run to run (e.g. the order of accumulation in each thread and the order in which
+/// modified chunks are handed to the writer), at the cost of load balancing.
+///
+/// If the functor throws, the other threads stop after their current chunk and the error
+/// is rethrown as DataAccessError by run or runRW.
+/// @ingroup dataaccess_hlp
+class ParallelChunkDriver : private boost::noncopyable {
+public:
+  /// @brief type of the functor for the read-only processing
+  typedef boost::function<void(const IConstDataAccessor&, size_t)> ConstFunctor;
+
+  /// @brief type of the functor for the read-write processing
+  typedef boost::function<void(IDataAccessor&, size_t)> Functor;
+
+  /// @brief set up the driver
+  /// @param[in] nThreads number of threads
+  /// @param[in] type type of partitioning
+  /// @param[in] partitionsPerThread number of partitions per thread (more partitions give
+  /// a finer granularity for load balancing at the expense of more iterators)
+  explicit ParallelChunkDriver(size_t nThreads,
+           TableConstDataSource::PartitionType type = TableConstDataSource::BASELINE_PARTITION,
+           size_t partitionsPerThread = 4);
+
+  /// @brief switch the ordered mode on or off
+  /// @param[in] ordered if true, partitions are not stolen and each thread processes
+  /// its partitions in a fixed order
+  inline void setOrdered(bool ordered = true) { itsOrdered = ordered; }
+
+  /// @brief bind partitions to NUMA nodes
+  /// @details See TableConstDataSource::createPartitionedIterators. The thread which takes
+  /// a partition pins itself to the node of this partition.
+  /// @param[in] numaAware if true, partitions are bound to NUMA nodes
+  inline void setNumaAware(bool numaAware = true) { itsNumaAware = numaAware; }
+
+  /// @brief number of threads
+  inline size_t nThreads() const { return itsNThreads; }
+
+  /// @brief number of partitions
+  inline size_t nPartitions() const { return itsNThreads * itsPartitionsPerThread; }
+
+  /// @brief check whether the ordered mode is on
+  inline bool isOrdered() const { return itsOrdered; }
+
+  /// @brief process all selected chunks of a data source
+  /// @param[in] ds data source
+  /// @param[in] sel selector
+  /// @param[in] conv converter
+  /// @param[in] functor functor called for every chunk (pass stateful functors via boost::ref)
+  /// @return number of processed chunks
+  size_t run(const TableConstDataSource &ds, const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, const ConstFunctor &functor);
+
+  /// @brief process and modify all selected chunks of a data source
+  /// @details Partitions are driven by read-write iterators (see
+  /// TableDataSource::createPartitionedRWIterators). All modifications are in the table
+  /// when this method returns.
+  /// @param[in] ds data source
+  /// @param[in] sel selector
+  /// @param[in] conv converter
+  /// @param[in] functor functor called for every chunk (pass stateful functors via boost::ref)
+  /// @return number of processed chunks
+  size_t runRW(const TableDataSource &ds, const IDataSelectorConstPtr &sel,
+               const IDataConverterConstPtr &conv, const Functor &functor);
+
+  /// @brief number of partitions stolen by other threads during the last run
+  size_t nSteals() const;
+
+private:
+  /// @brief distribute partitions between the thread queues
+  void resetQueues();
+
+  /// @brief take the next partition for the given thread
+  /// @param[in] thread thread index
+  /// @param[out] part partition index
+  /// @return false if there is no work left (or processing has failed)
+  bool takePartition(size_t thread, size_t &part);
+
+  /// @brief record the failure of a thread
+  /// @param[in] error error message
+  void fail(const std::string &error);
+
+  /// @brief check whether processing has failed
+  bool hasFailed() const;
+
+  /// @brief body of a worker thread
+  /// @param[in] iters iterators, one per partition
+  /// @param[in] functor functor to call
+  /// @param[in] thread thread index
+  /// @param[out] nChunks number of chunks processed by this thread
+  template<typename Iter, typename F>
+  void work(const std::vector<boost::shared_ptr<Iter> > &iters, const F &functor,
+            size_t thread, size_t &nChunks);
+
+  /// @brief run worker threads and wait for them
+  /// @param[in] iters iterators, one per partition
+  /// @param[in] functor functor to call
+  /// @return number of processed chunks
+  template<typename Iter, typename F>
+  size_t process(const std::vector<boost::shared_ptr<Iter> > &iters, const F &functor);
+
+  /// @brief queue of partitions for one thread
+  struct PartitionQueue {
+    /// @brief mutex protecting the queue
+    boost::mutex itsMutex;
+    /// @brief partition indices
+    std::deque<size_t> itsPartitions;
+  };
+
+  /// @brief number of threads
+  size_t itsNThreads;
+
+  /// @brief type of partitioning
+  TableConstDataSource::PartitionType itsType;
+
+  /// @brief number of partitions per thread
+  size_t itsPartitionsPerThread;
+
+  /// @brief true, if partitions are not stolen
+  bool itsOrdered;
+
+  /// @brief true, if partitions are bound to NUMA nodes
+  bool itsNumaAware;
+
+  /// @brief queues of partitions, one per thread
+  std::vector<boost::shared_ptr<PartitionQueue> > itsQueues;
+
+  /// @brief mutex protecting the error and the statistics
+  mutable boost::mutex itsMutex;
+
+  /// @brief error message of the first failure, empty if there was none
+  std::string itsError;
+
+  /// @brief number of stolen partitions
+  size_t itsNSteals;
+};
+
+/// @brief process all selected chunks of a data source in parallel
+/// @details This is a convenience function, see ParallelChunkDriver for details
+/// @param[in] ds data source
+/// @param[in] sel selector
+/// @param[in] conv converter
+/// @param[in] functor functor called for every chunk with the accessor and the thread index
+/// @param[in] nThreads number of threads
+/// @return number of processed chunks
+size_t parallelForEachChunk(const TableConstDataSource &ds, const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, const ParallelChunkDriver::ConstFunctor &functor,
+             size_t nThreads);
+
+/// @brief process and modify all selected chunks of a data source in parallel
+/// @details This is a convenience function, see ParallelChunkDriver for details
+/// @param[in] ds data source
+/// @param[in] sel selector
+/// @param[in] conv converter
+/// @param[in] functor functor called for every chunk with the accessor and the thread index
+/// @param[in] nThreads number of threads
+/// @param[in] ordered if true, the ordered mode is used (see ParallelChunkDriver)
+/// @return number of processed chunks
+size_t parallelForEachChunkRW(const TableDataSource &ds, const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, const ParallelChunkDriver::Functor &functor,
+             size_t nThreads, bool ordered = false);
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PARALLEL_CHUNK_DRIVER_H
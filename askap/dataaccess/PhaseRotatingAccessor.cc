@@ -0,0 +1,281 @@
+/// @file
+/// @brief adapter rotating the phase of visibilities to a new tangent point
+/// @details This accessor adapter delivers visibilities multiplied by the phase factor
+/// exp(2 pi i delay freq / c), where delays are given by uvwRotationDelay for the chosen
+/// tangent point (and image centre), and uvw rotated to the same tangent point. The
+/// rotation is done once per chunk and the results are cached until the adapter is
+/// associated with another accessor.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/PhaseRotatingAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/casa/Quanta/Quantum.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief number of channels after which the phasor recurrence is restarted
+/// @details The phasor is evaluated exactly for every channel which is a multiple of
+/// this number, this bounds the accumulation of rounding errors
+const casacore::uInt theirResyncInterval = 32;
+
+/// @brief minimum number of rows per thread
+/// @details Smaller chunks are not worth the overhead of starting threads
+const casacore::uInt theirMinRowsPerThread = 64;
+
+/// @brief check whether the channels are equally spaced
+/// @param[in] freq frequencies
+/// @param[in] nChan number of channels
+/// @return true, if all channels are equally spaced
+bool equallySpaced(const casacore::Double *freq, casacore::uInt nChan)
+{
+  if (nChan < 3) {
+      return true;
+  }
+  const casacore::Double step = (freq[nChan - 1] - freq[0]) / (nChan - 1);
+  const casacore::Double tolerance = 1e-6 * std::abs(step);
+  for (casacore::uInt chan = 1; chan + 1 < nChan; ++chan) {
+       if (std::abs(freq[chan] - freq[0] - step * chan) > tolerance) {
+           return false;
+       }
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+/// @brief construct the adapter
+/// @param[in] tangentPoint tangent point to rotate to
+/// @param[in] frequencyUnit units of the frequency axis of the accessor (as set up in the 
+///            converter)
+PhaseRotatingAccessor::PhaseRotatingAccessor(const casacore::MDirection &tangentPoint, 
+             const std::string &frequencyUnit) : itsTangentPoint(tangentPoint), 
+             itsImageCentre(tangentPoint), 
+             itsFrequencyScale(casacore::Quantity(1., frequencyUnit).getValue("Hz")), itsNThreads(1) {}
+
+/// @brief construct the adapter with an additional shift
+/// @param[in] tangentPoint tangent point to rotate to
+/// @param[in] imageCentre image centre (an additional translation is done if it differs
+///            from the tangent point, see IConstDataAccessor::uvwRotationDelay)
+/// @param[in] frequencyUnit units of the frequency axis of the accessor (as set up in the 
+///            converter)
+PhaseRotatingAccessor::PhaseRotatingAccessor(const casacore::MDirection &tangentPoint, 
+             const casacore::MDirection &imageCentre, const std::string &frequencyUnit) :
+             itsTangentPoint(tangentPoint), itsImageCentre(imageCentre), 
+             itsFrequencyScale(casacore::Quantity(1., frequencyUnit).getValue("Hz")), itsNThreads(1) {}
+
+/// @brief set the number of threads
+/// @details Rows are split into blocks processed in parallel. One thread (i.e. no
+/// parallelism) is used by default. Small chunks are always processed by one thread.
+/// @param[in] nThreads number of threads (should be positive)
+void PhaseRotatingAccessor::setNumberOfThreads(casacore::uInt nThreads)
+{
+  ASKAPCHECK(nThreads > 0, "Number of threads should be positive");
+  itsNThreads = nThreads;
+}
+
+/// @brief drop cached visibilities if the accessor changed
+void PhaseRotatingAccessor::checkAccessor() const
+{
+  if (itsCachedMonitor == changeMonitor()) {
+      return;
+  }
+  itsCachedMonitor = changeMonitor();
+  itsVisibility.invalidate();
+}
+
+/// @brief phase-rotated visibilities
+/// @return a reference to nRow x nChannel x nPol cube
+const casacore::Cube<casacore::Complex>& PhaseRotatingAccessor::visibility() const
+{
+  checkAccessor();
+  return itsVisibility.value(*this, &PhaseRotatingAccessor::fillVisibility);
+}
+
+/// @brief read-write access to visibilities is not supported
+/// @return never returns, DataAccessLogicError is thrown
+casacore::Cube<casacore::Complex>& PhaseRotatingAccessor::rwVisibility()
+{
+  ASKAPTHROW(DataAccessLogicError, "PhaseRotatingAccessor doesn't support read-write access to visibilities");
+}
+
+/// @brief uvw rotated to the tangent point
+/// @return a reference to vector containing uvw-coordinates (in metres) for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& PhaseRotatingAccessor::uvw() const
+{
+  return getROAccessor().rotatedUVW(itsTangentPoint);
+}
+
+/// @brief fill the buffer with rotated visibilities
+/// @param[in] vis cube to fill
+void PhaseRotatingAccessor::fillVisibility(casacore::Cube<casacore::Complex> &vis) const
+{
+  const IConstDataAccessor &acc = getROAccessor();
+  casacore::Vector<casacore::Double> freq(acc.frequency().copy());
+  freq *= itsFrequencyScale;
+  rotate(acc.visibility(), acc.uvwRotationDelay(itsTangentPoint, itsImageCentre), freq, vis, itsNThreads);
+}
+
+/// @brief rotate the phase of visibilities
+/// @details Each element is multiplied by exp(2 pi i delay[row] freq[chan] / c).
+/// @param[in] in nRow x nChannel x nPol cube with input visibilities
+/// @param[in] delays delay for each row (in metres)
+/// @param[in] frequencies frequency for each channel (in Hz)
+/// @param[out] out cube of the same shape, resized if necessary
+/// @param[in] nThreads number of threads to use
+void PhaseRotatingAccessor::rotate(const casacore::Cube<casacore::Complex> &in,
+                     const casacore::Vector<casacore::Double> &delays,
+                     const casacore::Vector<casacore::Double> &frequencies,
+                     casacore::Cube<casacore::Complex> &out, casacore::uInt nThreads)
+{
+  const casacore::uInt nRow = in.nrow();
+  const casacore::uInt nChan = in.ncolumn();
+  const casacore::uInt nPol = in.nplane();
+  ASKAPCHECK(delays.nelements() == nRow, "Number of delays ("<<delays.nelements()<<
+             ") doesn't match the number of rows ("<<nRow<<")");
+  ASKAPCHECK(frequencies.nelements() == nChan, "Number of frequencies ("<<frequencies.nelements()<<
+             ") doesn't match the number of channels ("<<nChan<<")");
+  ASKAPDEBUGASSERT(nThreads > 0);
+  if (!out.shape().isEqual(in.shape()) || !out.contiguousStorage()) {
+      out.resize(in.shape());
+  }
+  // plain pointer loops below assume a contiguous storage, copy the input otherwise
+  const casacore::Cube<casacore::Complex> contIn = in.contiguousStorage() ? 
+          in : casacore::Cube<casacore::Complex>(in.copy());
+  const casacore::Vector<casacore::Double> contDelays = delays.contiguousStorage() ?
+          delays : casacore::Vector<casacore::Double>(delays.copy());
+  const casacore::Vector<casacore::Double> contFreq = frequencies.contiguousStorage() ?
+          frequencies : casacore::Vector<casacore::Double>(frequencies.copy());
+  const bool uniform = equallySpaced(contFreq.data(), nChan);
+  const casacore::uInt nBlocks = std::max(1u, std::min(nThreads, nRow / theirMinRowsPerThread));
+  if (nBlocks == 1) {
+      rotateRows(contIn.data(), contDelays.data(), contFreq.data(), uniform, in.shape(),
+                 0, nRow, out.data());
+      return;
+  }
+  // the calling thread processes the last block
+  const casacore::uInt blockSize = (nRow + nBlocks - 1) / nBlocks;
+  boost::thread_group threads;
+  casacore::uInt startRow = 0;
+  for (; startRow + blockSize < nRow; startRow += blockSize) {
+       threads.create_thread(boost::bind(&PhaseRotatingAccessor::rotateRows, contIn.data(), 
+                 contDelays.data(), contFreq.data(), uniform, in.shape(), startRow, 
+                 startRow + blockSize, out.data()));
+  }
+  rotateRows(contIn.data(), contDelays.data(), contFreq.data(), uniform, in.shape(),
+             startRow, nRow, out.data());
+  threads.join_all();
+}
+
+/// @brief rotate the phase for a block of rows
+/// @details This is the kernel of rotate working with contiguous storage.
+/// @param[in] in input visibilities (nRow x nChannel x nPol)
+/// @param[in] delays delays for all rows
+/// @param[in] frequencies frequencies for all channels (in Hz)
+/// @param[in] uniform true if the channels are equally spaced
+/// @param[in] shape shape of the whole cube (nRow x nChannel x nPol)
+/// @param[in] startRow first row of the block
+/// @param[in] endRow row following the last row of the block
+/// @param[out] out output visibilities (same shape as the input)
+void PhaseRotatingAccessor::rotateRows(const casacore::Complex *in, const casacore::Double *delays,
+                         const casacore::Double *frequencies, bool uniform, 
+                         const casacore::IPosition &shape, casacore::uInt startRow, casacore::uInt endRow,
+                         casacore::Complex *out)
+{
+  if (startRow >= endRow) {
+      return;
+  }
+  ASKAPDEBUGASSERT(shape.nelements() == 3);
+  const casacore::uInt nRow = shape[0];
+  const casacore::uInt nChan = shape[1];
+  const casacore::uInt nPol = shape[2];
+  const casacore::uInt nBlockRows = endRow - startRow;
+  // phasor for the current channel and its increment per channel, split into real and
+  // imaginary parts to keep the loops over rows simple
+  std::vector<casacore::Double> phaseRe(nBlockRows), phaseIm(nBlockRows);
+  std::vector<casacore::Double> stepRe(nBlockRows), stepIm(nBlockRows);
+  const casacore::Double *blockDelays = delays + startRow;
+  const casacore::Double scale = 2. * casacore::C::pi / casacore::C::c;
+  if (uniform && (nChan > 1)) {
+      const casacore::Double freqStep = (frequencies[nChan - 1] - frequencies[0]) / (nChan - 1);
+      for (casacore::uInt row = 0; row < nBlockRows; ++row) {
+           const casacore::Double phase = scale * blockDelays[row] * freqStep;
+           stepRe[row] = std::cos(phase);
+           stepIm[row] = std::sin(phase);
+      }
+  }
+  for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+       if (!uniform || (chan % theirResyncInterval == 0)) {
+           // exact evaluation
+           const casacore::Double factor = scale * frequencies[chan];
+           for (casacore::uInt row = 0; row < nBlockRows; ++row) {
+                const casacore::Double phase = factor * blockDelays[row];
+                phaseRe[row] = std::cos(phase);
+                phaseIm[row] = std::sin(phase);
+           }
+       } else {
+           // advance the phasor by one channel
+           for (casacore::uInt row = 0; row < nBlockRows; ++row) {
+                const casacore::Double re = phaseRe[row] * stepRe[row] - phaseIm[row] * stepIm[row];
+                const casacore::Double im = phaseRe[row] * stepIm[row] + phaseIm[row] * stepRe[row];
+                phaseRe[row] = re;
+                phaseIm[row] = im;
+           }
+       }
+       for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+            const size_t offset = size_t(nRow) * (chan + size_t(nChan) * pol) + startRow;
+            const casacore::Complex *inPtr = in + offset;
+            casacore::Complex *outPtr = out + offset;
+            for (casacore::uInt row = 0; row < nBlockRows; ++row) {
+                 const casacore::Float re = casacore::Float(phaseRe[row]);
+                 const casacore::Float im = casacore::Float(phaseIm[row]);
+                 const casacore::Float visRe = casacore::real(inPtr[row]);
+                 const casacore::Float visIm = casacore::imag(inPtr[row]);
+                 outPtr[row] = casacore::Complex(visRe * re - visIm * im, visRe * im + visIm * re);
+            }
+       }
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,165 @@
+/// @file
+/// @brief adapter rotating the phase of visibilities to a new tangent point
+/// @details This accessor adapter delivers visibilities multiplied by the phase factor
+/// exp(2 pi i delay freq / c), where delays are given by uvwRotationDelay for the chosen
+/// tangent point (and image centre), and uvw rotated to the same tangent point. The
+/// rotation is done once per chunk and the results are cached until the adapter is
+/// associated with another accessor.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_PHASE_ROTATING_ACCESSOR_H
+#define ASKAP_ACCESSORS_PHASE_ROTATING_ACCESSOR_H
+
+// std includes
+#include <string>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/measures/Measures/MDirection.h>
+
+// own includes
+#include <askap/dataaccess/DataAccessorAdapter.h>
+#include <askap/dataaccess/CachedAccessorField.h>
+#include <utils/ChangeMonitor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief adapter rotating the phase of visibilities to a new tangent point
+/// @details Phase factors are not evaluated for each element. If the spectral channels
+/// are equally spaced (the usual case), the phasor of each row is advanced from channel to
+/// channel by multiplication with a constant per-row increment and is re-evaluated exactly
+/// every few channels to stop the rounding errors from accumulating. Otherwise, one sine and
+/// cosine is evaluated per row and channel. In both cases the phasor is shared between all
+/// polarisations and the loops run over rows (contiguous in the accessor order), so the
+/// compiler can vectorise them. Blocks of rows can be processed in parallel by a number of 
+/// threads (see setNumberOfThreads). Noise and flags are passed through unchanged. The adapter 
+/// is read-only, rwVisibility throws an exception.
+/// @ingroup dataaccess_hlp
+class PhaseRotatingAccessor : public DataAccessorAdapter {
+public:
+  /// @brief construct the adapter
+  /// @param[in] tangentPoint tangent point to rotate to
+  /// @param[in] frequencyUnit units of the frequency axis of the accessor (as set up in the 
+  ///            converter)
+  explicit PhaseRotatingAccessor(const casacore::MDirection &tangentPoint, 
+                                 const std::string &frequencyUnit = "Hz");
+
+  /// @brief construct the adapter with an additional shift
+  /// @param[in] tangentPoint tangent point to rotate to
+  /// @param[in] imageCentre image centre (an additional translation is done if it differs
+  ///            from the tangent point, see IConstDataAccessor::uvwRotationDelay)
+  /// @param[in] frequencyUnit units of the frequency axis of the accessor (as set up in the 
+  ///            converter)
+  PhaseRotatingAccessor(const casacore::MDirection &tangentPoint, 
+                        const casacore::MDirection &imageCentre, 
+                        const std::string &frequencyUnit = "Hz");
+
+  /// @brief set the number of threads
+  /// @details Rows are split into blocks processed in parallel. One thread (i.e. no
+  /// parallelism) is used by default. Small chunks are always processed by one thread.
+  /// @param[in] nThreads number of threads (should be positive)
+  void setNumberOfThreads(casacore::uInt nThreads);
+
+  /// @brief number of threads
+  /// @return number of threads used to rotate a chunk
+  inline casacore::uInt numberOfThreads() const { return itsNThreads; }
+
+  /// @brief phase-rotated visibilities
+  /// @return a reference to nRow x nChannel x nPol cube
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// @brief read-write access to visibilities is not supported
+  /// @return never returns, DataAccessLogicError is thrown
+  virtual casacore::Cube<casacore::Complex>& rwVisibility();
+
+  /// @brief uvw rotated to the tangent point
+  /// @return a reference to vector containing uvw-coordinates (in metres) for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw() const;
+
+  /// @brief rotate the phase of visibilities
+  /// @details Each element is multiplied by exp(2 pi i delay[row] freq[chan] / c).
+  /// @param[in] in nRow x nChannel x nPol cube with input visibilities
+  /// @param[in] delays delay for each row (in metres)
+  /// @param[in] frequencies frequency for each channel (in Hz)
+  /// @param[out] out cube of the same shape, resized if necessary
+  /// @param[in] nThreads number of threads to use
+  static void rotate(const casacore::Cube<casacore::Complex> &in,
+                     const casacore::Vector<casacore::Double> &delays,
+                     const casacore::Vector<casacore::Double> &frequencies,
+                     casacore::Cube<casacore::Complex> &out, casacore::uInt nThreads = 1);
+
+protected:
+  /// @brief drop cached visibilities if the accessor changed
+  void checkAccessor() const;
+
+  /// @brief fill the buffer with rotated visibilities
+  /// @param[in] vis cube to fill
+  void fillVisibility(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief rotate the phase for a block of rows
+  /// @details This is the kernel of rotate working with contiguous storage.
+  /// @param[in] in input visibilities (nRow x nChannel x nPol)
+  /// @param[in] delays delays for all rows
+  /// @param[in] frequencies frequencies for all channels (in Hz)
+  /// @param[in] uniform true if the channels are equally spaced
+  /// @param[in] shape shape of the whole cube (nRow x nChannel x nPol)
+  /// @param[in] startRow first row of the block
+  /// @param[in] endRow row following the last row of the block
+  /// @param[out] out output visibilities (same shape as the input)
+  static void rotateRows(const casacore::Complex *in, const casacore::Double *delays,
+                         const casacore::Double *frequencies, bool uniform, 
+                         const casacore::IPosition &shape, casacore::uInt startRow, casacore::uInt endRow,
+                         casacore::Complex *out);
+
+private:
+  /// @brief tangent point to rotate to
+  casacore::MDirection itsTangentPoint;
+
+  /// @brief image centre
+  casacore::MDirection itsImageCentre;
+
+  /// @brief factor converting the frequencies of the accessor into Hz
+  casacore::Double itsFrequencyScale;
+
+  /// @brief number of threads
+  casacore::uInt itsNThreads;
+
+  /// @brief change monitor of the accessor the cached products correspond to
+  mutable scimath::ChangeMonitor itsCachedMonitor;
+
+  /// @brief rotated visibilities
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsVisibility;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PHASE_ROTATING_ACCESSOR_H
@@ -0,0 +1,479 @@
+/// @file
+/// @brief adapter converting polarisation products
+/// @details This accessor adapter delivers visibilities, noise and flags converted from
+/// the stored correlation products (e.g. XX,XY,YX,YY) to the requested ones (e.g. I,Q,U,V). 
+/// The conversion is done once per chunk and the results are cached until the adapter is
+/// associated with another accessor.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/PolConvertingAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicMath/Math.h>
+
+// std includes
+#include <algorithm>
+#include <complex>
+#include <cmath>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief complex type used to build the conversion matrix
+typedef std::complex<double> DComplex;
+
+/// @brief decompose a polarisation product into Stokes parameters
+/// @details The conventions are XX = I + Q, YY = I - Q, XY = U + iV, YX = U - iV for
+/// linear feeds and RR = I + V, LL = I - V, RL = Q + iU, LR = Q - iU for circular feeds
+/// @param[in] pol polarisation product
+/// @param[out] comp coefficients of I, Q, U and V (vector of size 4)
+void stokesComponents(casacore::Stokes::StokesTypes pol, std::vector<DComplex> &comp)
+{
+  const DComplex j(0., 1.);
+  comp.assign(4, DComplex(0.));
+  switch (pol) {
+     case casacore::Stokes::I: comp[0] = 1.; break;
+     case casacore::Stokes::Q: comp[1] = 1.; break;
+     case casacore::Stokes::U: comp[2] = 1.; break;
+     case casacore::Stokes::V: comp[3] = 1.; break;
+     case casacore::Stokes::XX: comp[0] = 1.; comp[1] = 1.; break;
+     case casacore::Stokes::YY: comp[0] = 1.; comp[1] = -1.; break;
+     case casacore::Stokes::XY: comp[2] = 1.; comp[3] = j; break;
+     case casacore::Stokes::YX: comp[2] = 1.; comp[3] = -j; break;
+     case casacore::Stokes::RR: comp[0] = 1.; comp[3] = 1.; break;
+     case casacore::Stokes::LL: comp[0] = 1.; comp[3] = -1.; break;
+     case casacore::Stokes::RL: comp[1] = 1.; comp[2] = j; break;
+     case casacore::Stokes::LR: comp[1] = 1.; comp[2] = -j; break;
+     default:
+        ASKAPTHROW(DataAccessError, "Polarisation product "<<casacore::Stokes::name(pol)<<
+                   " is not supported by PolConvertingAccessor");
+  }
+}
+
+/// @brief invert a square matrix in place using Gauss-Jordan elimination
+/// @param[in] mat matrix stored row by row
+/// @param[in] size number of rows
+/// @return false if the matrix is singular
+bool invert(std::vector<DComplex> &mat, size_t size)
+{
+  std::vector<DComplex> result(size * size, DComplex(0.));
+  for (size_t i = 0; i < size; ++i) {
+       result[i * size + i] = 1.;
+  }
+  for (size_t col = 0; col < size; ++col) {
+       size_t pivot = col;
+       for (size_t row = col + 1; row < size; ++row) {
+            if (std::abs(mat[row * size + col]) > std::abs(mat[pivot * size + col])) {
+                pivot = row;
+            }
+       }
+       if (std::abs(mat[pivot * size + col]) < 1e-9) {
+           return false;
+       }
+       for (size_t k = 0; k < size; ++k) {
+            std::swap(mat[col * size + k], mat[pivot * size + k]);
+            std::swap(result[col * size + k], result[pivot * size + k]);
+       }
+       const DComplex norm = 1. / mat[col * size + col];
+       for (size_t k = 0; k < size; ++k) {
+            mat[col * size + k] *= norm;
+            result[col * size + k] *= norm;
+       }
+       for (size_t row = 0; row < size; ++row) {
+            if (row != col) {
+                const DComplex factor = mat[row * size + col];
+                for (size_t k = 0; k < size; ++k) {
+                     mat[row * size + k] -= factor * mat[col * size + k];
+                     result[row * size + k] -= factor * result[col * size + k];
+                }
+            }
+       }
+  }
+  mat.swap(result);
+  return true;
+}
+
+/// @brief obtain a pointer to contiguous cube storage
+/// @details The accessor cubes are normally contiguous, the copy is only made otherwise
+/// @param[in] cube cube to access
+/// @param[out] buffer cube holding a contiguous copy, if required
+/// @return pointer to the first element
+template<typename T>
+const T* contiguousData(const casacore::Cube<T> &cube, casacore::Cube<T> &buffer)
+{
+  if (cube.contiguousStorage()) {
+      return cube.data();
+  }
+  buffer = cube.copy();
+  return buffer.data();
+}
+
+/// @brief shape the output cube of the conversion
+/// @details The cube is only resized if it doesn't have the required shape, so
+/// the caller can pass a cube referencing a reusable buffer.
+/// @param[in] in input cube
+/// @param[in] nOut number of output polarisation products
+/// @param[in] out output cube
+template<typename T>
+void conformOutput(const casacore::Cube<T> &in, casacore::uInt nOut, casacore::Cube<T> &out)
+{
+  const casacore::IPosition shape(3, in.nrow(), in.ncolumn(), nOut);
+  if (!out.shape().isEqual(shape) || !out.contiguousStorage()) {
+      out.resize(shape);
+  }
+}
+
+/// @brief interpret one item of the list of polarisation products
+/// @details An item is either a name of a single product (e.g. "XX" or "I") or a
+/// concatenation of product names without separators (e.g. "IQUV", "XXYY" or "RRLL").
+/// The latter is split into single letter Stokes parameters if it consists of I, Q, U
+/// and V only and into two letter correlation products otherwise.
+/// @param[in] name item to interpret (without leading and trailing spaces)
+/// @param[in] pols full list of products (for the error message)
+/// @param[in] result vector to append the polarisation types to
+void appendProducts(const std::string &name, const std::string &pols,
+                    std::vector<casacore::Stokes::StokesTypes> &result)
+{
+  const casacore::Stokes::StokesTypes pol = casacore::Stokes::type(name);
+  if (pol != casacore::Stokes::Undefined) {
+      result.push_back(pol);
+      return;
+  }
+  const size_t step = name.find_first_not_of("IQUV") == std::string::npos ? 1 : 2;
+  if ((name.size() > step) && (name.size() % step == 0)) {
+      std::vector<casacore::Stokes::StokesTypes> products;
+      for (size_t pos = 0; pos < name.size(); pos += step) {
+           const casacore::Stokes::StokesTypes product = casacore::Stokes::type(name.substr(pos, step));
+           if (product == casacore::Stokes::Undefined) {
+               break;
+           }
+           products.push_back(product);
+      }
+      if (products.size() * step == name.size()) {
+          result.insert(result.end(), products.begin(), products.end());
+          return;
+      }
+  }
+  ASKAPTHROW(DataAccessError, "Unable to interpret polarisation product '"<<name<<"' in '"<<pols<<"'");
+}
+
+} // anonymous namespace
+
+/// @brief construct the adapter
+/// @param[in] pols requested polarisation products, comma-separated (e.g. "I,Q,U,V")
+PolConvertingAccessor::PolConvertingAccessor(const std::string &pols) : itsStokes(parse(pols)) {}
+
+/// @brief parse the list of polarisation products
+/// @details Products are separated by commas (e.g. "XX,XY,YX,YY"). The compact form
+/// without separators (e.g. "IQUV", "XXYY" or "RRLL") is also accepted.
+/// @param[in] pols list of products
+/// @return vector with the polarisation types
+casacore::Vector<casacore::Stokes::StokesTypes> PolConvertingAccessor::parse(const std::string &pols)
+{
+  std::vector<casacore::Stokes::StokesTypes> result;
+  for (size_t pos = 0; pos <= pols.size();) {
+       size_t end = pols.find(',', pos);
+       if (end == std::string::npos) {
+           end = pols.size();
+       }
+       std::string name = pols.substr(pos, end - pos);
+       const size_t first = name.find_first_not_of(" \t");
+       const size_t last = name.find_last_not_of(" \t");
+       name = first == std::string::npos ? std::string() : name.substr(first, last - first + 1);
+       appendProducts(name, pols, result);
+       pos = end + 1;
+  }
+  ASKAPCHECK(result.size() > 0, "At least one polarisation product should be requested");
+  return casacore::Vector<casacore::Stokes::StokesTypes>(result);
+}
+
+/// @brief build the conversion matrix
+/// @details The result is an nOut x nIn matrix, so that each output product is a sum
+/// of input products multiplied by the elements of the corresponding row. An exception
+/// is thrown if some output product can't be derived from the input products.
+/// @param[in] in input polarisation products
+/// @param[in] out output polarisation products
+/// @return conversion matrix
+casacore::Matrix<casacore::Complex> PolConvertingAccessor::conversionMatrix(
+                      const casacore::Vector<casacore::Stokes::StokesTypes> &in,
+                      const casacore::Vector<casacore::Stokes::StokesTypes> &out)
+{
+  const size_t nIn = in.nelements();
+  ASKAPCHECK(nIn > 0, "No input polarisation products are given");
+  // in = A * S, where S are Stokes I,Q,U,V and A is nIn x 4
+  std::vector<DComplex> a(nIn * 4);
+  std::vector<DComplex> comp;
+  for (size_t row = 0; row < nIn; ++row) {
+       stokesComponents(in[row], comp);
+       std::copy(comp.begin(), comp.end(), a.begin() + row * 4);
+  }
+  // right inverse pinv = A^H (A A^H)^-1 (4 x nIn), rows of A are assumed independent
+  std::vector<DComplex> gram(nIn * nIn, DComplex(0.));
+  for (size_t i = 0; i < nIn; ++i) {
+       for (size_t j = 0; j < nIn; ++j) {
+            for (size_t k = 0; k < 4; ++k) {
+                 gram[i * nIn + j] += a[i * 4 + k] * std::conj(a[j * 4 + k]);
+            }
+       }
+  }
+  if (!invert(gram, nIn)) {
+      ASKAPTHROW(DataAccessError, "Input polarisation products are not independent, unable to convert them");
+  }
+  std::vector<DComplex> pinv(4 * nIn, DComplex(0.));
+  for (size_t k = 0; k < 4; ++k) {
+       for (size_t j = 0; j < nIn; ++j) {
+            for (size_t i = 0; i < nIn; ++i) {
+                 pinv[k * nIn + j] += std::conj(a[i * 4 + k]) * gram[i * nIn + j];
+            }
+       }
+  }
+  // out = B * S = B * pinv * in, which is exact if the rows of B are in the row space of A
+  casacore::Matrix<casacore::Complex> result(out.nelements(), nIn, casacore::Complex(0.));
+  for (size_t row = 0; row < out.nelements(); ++row) {
+       stokesComponents(out[row], comp);
+       std::vector<DComplex> coeffs(nIn, DComplex(0.));
+       for (size_t j = 0; j < nIn; ++j) {
+            for (size_t k = 0; k < 4; ++k) {
+                 coeffs[j] += comp[k] * pinv[k * nIn + j];
+            }
+       }
+       for (size_t k = 0; k < 4; ++k) {
+            DComplex residual = comp[k];
+            for (size_t j = 0; j < nIn; ++j) {
+                 residual -= coeffs[j] * a[j * 4 + k];
+            }
+            if (std::abs(residual) > 1e-6) {
+                ASKAPTHROW(DataAccessError, "Polarisation product "<<casacore::Stokes::name(out[row])<<
+                           " can't be derived from the available products");
+            }
+       }
+       for (size_t j = 0; j < nIn; ++j) {
+            // exact zeros allow the kernels to skip unused inputs
+            if (std::abs(coeffs[j]) > 1e-9) {
+                result(row, j) = casacore::Complex(float(coeffs[j].real()), float(coeffs[j].imag()));
+            }
+       }
+  }
+  return result;
+}
+
+/// @brief update the conversion matrix and drop cached products if the accessor changed
+void PolConvertingAccessor::checkAccessor() const
+{
+  if (itsCachedMonitor == changeMonitor()) {
+      return;
+  }
+  itsCachedMonitor = changeMonitor();
+  itsVisibility.invalidate();
+  itsNoise.invalidate();
+  itsFlag.invalidate();
+  const casacore::Vector<casacore::Stokes::StokesTypes> &inPols = getROAccessor().stokes();
+  bool same = inPols.nelements() == itsInputStokes.nelements();
+  for (casacore::uInt pol = 0; same && (pol < inPols.nelements()); ++pol) {
+       same = inPols[pol] == itsInputStokes[pol];
+  }
+  if (!same) {
+      itsMatrix.reference(conversionMatrix(inPols, itsStokes));
+      itsInputStokes.assign(inPols.copy());
+  }
+}
+
+/// @brief number of requested polarisation products
+/// @return number of products delivered by the adapter
+casacore::uInt PolConvertingAccessor::nPol() const throw()
+{
+  return itsStokes.nelements();
+}
+
+/// @brief requested polarisation products
+/// @return vector with the polarisation types
+const casacore::Vector<casacore::Stokes::StokesTypes>& PolConvertingAccessor::stokes() const
+{
+  return itsStokes;
+}
+
+/// @brief converted visibilities
+/// @return a reference to nRow x nChannel x nPol cube
+const casacore::Cube<casacore::Complex>& PolConvertingAccessor::visibility() const
+{
+  checkAccessor();
+  return itsVisibility.value(*this, &PolConvertingAccessor::fillVisibility);
+}
+
+/// @brief read-write access to visibilities is not supported
+/// @return never returns, DataAccessLogicError is thrown
+casacore::Cube<casacore::Complex>& PolConvertingAccessor::rwVisibility()
+{
+  ASKAPTHROW(DataAccessLogicError, "PolConvertingAccessor doesn't support read-write access to visibilities");
+}
+
+/// @brief converted noise
+/// @return a reference to nRow x nChannel x nPol cube with complex noise estimates
+const casacore::Cube<casacore::Complex>& PolConvertingAccessor::noise() const
+{
+  checkAccessor();
+  return itsNoise.value(*this, &PolConvertingAccessor::fillNoise);
+}
+
+/// @brief converted flags
+/// @return a reference to nRow x nChannel x nPol cube with flags
+const casacore::Cube<casacore::Bool>& PolConvertingAccessor::flag() const
+{
+  checkAccessor();
+  return itsFlag.value(*this, &PolConvertingAccessor::fillFlag);
+}
+
+/// @brief fill the buffer with converted visibilities
+/// @param[in] vis cube to fill
+void PolConvertingAccessor::fillVisibility(casacore::Cube<casacore::Complex> &vis) const
+{
+  convertVisibility(getROAccessor().visibility(), itsMatrix, vis);
+}
+
+/// @brief fill the buffer with converted noise
+/// @param[in] noise cube to fill
+void PolConvertingAccessor::fillNoise(casacore::Cube<casacore::Complex> &noise) const
+{
+  convertNoise(getROAccessor().noise(), itsMatrix, noise);
+}
+
+/// @brief fill the buffer with converted flags
+/// @param[in] flag cube to fill
+void PolConvertingAccessor::fillFlag(casacore::Cube<casacore::Bool> &flag) const
+{
+  convertFlag(getROAccessor().flag(), itsMatrix, flag);
+}
+
+/// @brief convert visibilities
+/// @details Each output plane is a weighted sum of input planes with the weights
+/// given by the corresponding row of the conversion matrix.
+/// @param[in] in nRow x nChannel x nIn cube with input visibilities
+/// @param[in] matrix conversion matrix (nOut x nIn, see conversionMatrix)
+/// @param[out] out nRow x nChannel x nOut cube, resized if necessary
+void PolConvertingAccessor::convertVisibility(const casacore::Cube<casacore::Complex> &inVis,
+                      const casacore::Matrix<casacore::Complex> &matrix,
+                      casacore::Cube<casacore::Complex> &vis)
+{
+  ASKAPDEBUGASSERT(inVis.nplane() == matrix.ncolumn());
+  const size_t planeSize = inVis.nrow() * inVis.ncolumn();
+  conformOutput(inVis, matrix.nrow(), vis);
+  casacore::Cube<casacore::Complex> buffer;
+  const casacore::Complex *in = contiguousData(inVis, buffer);
+  casacore::Complex *out = vis.data();
+  for (casacore::uInt outPol = 0; outPol < matrix.nrow(); ++outPol) {
+       casacore::Complex *outPlane = out + outPol * planeSize;
+       std::fill(outPlane, outPlane + planeSize, casacore::Complex(0.));
+       for (casacore::uInt inPol = 0; inPol < matrix.ncolumn(); ++inPol) {
+            const casacore::Complex coeff = matrix(outPol, inPol);
+            if (coeff == casacore::Complex(0.)) {
+                continue;
+            }
+            const casacore::Complex *inPlane = in + inPol * planeSize;
+            // simple loop over contiguous planes, suitable for auto-vectorisation
+            for (size_t i = 0; i < planeSize; ++i) {
+                 outPlane[i] += coeff * inPlane[i];
+            }
+       }
+  }
+}
+
+/// @brief convert noise
+/// @details Real and imaginary parts are assumed to be independent.
+/// @param[in] in nRow x nChannel x nIn cube with input noise
+/// @param[in] matrix conversion matrix (nOut x nIn, see conversionMatrix)
+/// @param[out] out nRow x nChannel x nOut cube, resized if necessary
+void PolConvertingAccessor::convertNoise(const casacore::Cube<casacore::Complex> &inNoise,
+                      const casacore::Matrix<casacore::Complex> &matrix,
+                      casacore::Cube<casacore::Complex> &noise)
+{
+  ASKAPDEBUGASSERT(inNoise.nplane() == matrix.ncolumn());
+  const size_t planeSize = inNoise.nrow() * inNoise.ncolumn();
+  conformOutput(inNoise, matrix.nrow(), noise);
+  casacore::Cube<casacore::Complex> buffer;
+  const casacore::Complex *in = contiguousData(inNoise, buffer);
+  casacore::Complex *out = noise.data();
+  for (casacore::uInt outPol = 0; outPol < matrix.nrow(); ++outPol) {
+       // accumulate variances of the real and imaginary parts first
+       casacore::Complex *outPlane = out + outPol * planeSize;
+       std::fill(outPlane, outPlane + planeSize, casacore::Complex(0.));
+       for (casacore::uInt inPol = 0; inPol < matrix.ncolumn(); ++inPol) {
+            const float re2 = casacore::square(matrix(outPol, inPol).real());
+            const float im2 = casacore::square(matrix(outPol, inPol).imag());
+            if ((re2 == 0.) && (im2 == 0.)) {
+                continue;
+            }
+            const casacore::Complex *inPlane = in + inPol * planeSize;
+            for (size_t i = 0; i < planeSize; ++i) {
+                 const float sigmaRe2 = casacore::square(inPlane[i].real());
+                 const float sigmaIm2 = casacore::square(inPlane[i].imag());
+                 outPlane[i] += casacore::Complex(re2 * sigmaRe2 + im2 * sigmaIm2, im2 * sigmaRe2 + re2 * sigmaIm2);
+            }
+       }
+       for (size_t i = 0; i < planeSize; ++i) {
+            outPlane[i] = casacore::Complex(std::sqrt(outPlane[i].real()), std::sqrt(outPlane[i].imag()));
+       }
+  }
+}
+
+/// @brief convert flags
+/// @details An output sample is flagged if any contributing input sample is.
+/// @param[in] in nRow x nChannel x nIn cube with input flags
+/// @param[in] matrix conversion matrix (nOut x nIn, see conversionMatrix)
+/// @param[out] out nRow x nChannel x nOut cube, resized if necessary
+void PolConvertingAccessor::convertFlag(const casacore::Cube<casacore::Bool> &inFlag,
+                      const casacore::Matrix<casacore::Complex> &matrix,
+                      casacore::Cube<casacore::Bool> &flag)
+{
+  ASKAPDEBUGASSERT(inFlag.nplane() == matrix.ncolumn());
+  const size_t planeSize = inFlag.nrow() * inFlag.ncolumn();
+  conformOutput(inFlag, matrix.nrow(), flag);
+  casacore::Cube<casacore::Bool> buffer;
+  const casacore::Bool *in = contiguousData(inFlag, buffer);
+  casacore::Bool *out = flag.data();
+  for (casacore::uInt outPol = 0; outPol < matrix.nrow(); ++outPol) {
+       casacore::Bool *outPlane = out + outPol * planeSize;
+       std::fill(outPlane, outPlane + planeSize, casacore::False);
+       for (casacore::uInt inPol = 0; inPol < matrix.ncolumn(); ++inPol) {
+            if (matrix(outPol, inPol) == casacore::Complex(0.)) {
+                continue;
+            }
+            const casacore::Bool *inPlane = in + inPol * planeSize;
+            for (size_t i = 0; i < planeSize; ++i) {
+                 outPlane[i] = outPlane[i] || inPlane[i];
+            }
+       }
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,184 @@
+/// @file
+/// @brief adapter converting polarisation products
+/// @details This accessor adapter delivers visibilities, noise and flags converted from
+/// the stored correlation products (e.g. XX,XY,YX,YY) to the requested ones (e.g. I,Q,U,V). 
+/// The conversion is done once per chunk and the results are cached until the adapter is
+/// associated with another accessor.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_POL_CONVERTING_ACCESSOR_H
+#define ASKAP_ACCESSORS_POL_CONVERTING_ACCESSOR_H
+
+// std includes
+#include <string>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/measures/Measures/Stokes.h>
+
+// own includes
+#include <askap/dataaccess/DataAccessorAdapter.h>
+#include <askap/dataaccess/CachedAccessorField.h>
+#include <utils/ChangeMonitor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief adapter converting polarisation products
+/// @details The requested products are given in the same form as for 
+/// IDataSelector::choosePolarizations, e.g. "I,Q,U,V" or "XX,YY". Any linear combination
+/// of the stored products is supported, including partial sets (e.g. Stokes I from XX and
+/// YY only). An exception is thrown if a requested product can't be derived from the 
+/// stored ones. The conversion matrix is built when the input products change (usually
+/// once per iteration); each output plane is then formed as a weighted sum of contiguous
+/// input planes, which the compiler can vectorise. Noise is propagated assuming independent
+/// real and imaginary parts, an output sample is flagged if any contributing input sample is.
+/// The adapter is read-only, rwVisibility throws an exception.
+/// @ingroup dataaccess_hlp
+class PolConvertingAccessor : public DataAccessorAdapter {
+public:
+  /// @brief construct the adapter
+  /// @param[in] pols requested polarisation products, comma-separated (e.g. "I,Q,U,V")
+  explicit PolConvertingAccessor(const std::string &pols);
+
+  /// @brief number of requested polarisation products
+  /// @return number of products delivered by the adapter
+  virtual casacore::uInt nPol() const throw();
+
+  /// @brief requested polarisation products
+  /// @return vector with the polarisation types
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const;
+
+  /// @brief converted visibilities
+  /// @return a reference to nRow x nChannel x nPol cube
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// @brief read-write access to visibilities is not supported
+  /// @return never returns, DataAccessLogicError is thrown
+  virtual casacore::Cube<casacore::Complex>& rwVisibility();
+
+  /// @brief converted noise
+  /// @return a reference to nRow x nChannel x nPol cube with complex noise estimates
+  virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// @brief converted flags
+  /// @return a reference to nRow x nChannel x nPol cube with flags
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+  /// @brief build the conversion matrix
+  /// @details The result is an nOut x nIn matrix, so that each output product is a sum
+  /// of input products multiplied by the elements of the corresponding row. An exception
+  /// is thrown if some output product can't be derived from the input products.
+  /// @param[in] in input polarisation products
+  /// @param[in] out output polarisation products
+  /// @return conversion matrix
+  static casacore::Matrix<casacore::Complex> conversionMatrix(
+                      const casacore::Vector<casacore::Stokes::StokesTypes> &in,
+                      const casacore::Vector<casacore::Stokes::StokesTypes> &out);
+
+  /// @brief parse the list of polarisation products
+  /// @details Products are separated by commas (e.g. "XX,XY,YX,YY"). The compact form
+  /// without separators (e.g. "IQUV", "XXYY" or "RRLL") is also accepted.
+  /// @param[in] pols list of products
+  /// @return vector with the polarisation types
+  static casacore::Vector<casacore::Stokes::StokesTypes> parse(const std::string &pols);
+
+  /// @brief convert visibilities
+  /// @details Each output plane is a weighted sum of input planes with the weights
+  /// given by the corresponding row of the conversion matrix.
+  /// @param[in] in nRow x nChannel x nIn cube with input visibilities
+  /// @param[in] matrix conversion matrix (nOut x nIn, see conversionMatrix)
+  /// @param[out] out nRow x nChannel x nOut cube, resized if necessary
+  static void convertVisibility(const casacore::Cube<casacore::Complex> &in,
+                      const casacore::Matrix<casacore::Complex> &matrix,
+                      casacore::Cube<casacore::Complex> &out);
+
+  /// @brief convert noise
+  /// @details Real and imaginary parts are assumed to be independent.
+  /// @param[in] in nRow x nChannel x nIn cube with input noise
+  /// @param[in] matrix conversion matrix (nOut x nIn, see conversionMatrix)
+  /// @param[out] out nRow x nChannel x nOut cube, resized if necessary
+  static void convertNoise(const casacore::Cube<casacore::Complex> &in,
+                      const casacore::Matrix<casacore::Complex> &matrix,
+                      casacore::Cube<casacore::Complex> &out);
+
+  /// @brief convert flags
+  /// @details An output sample is flagged if any contributing input sample is.
+  /// @param[in] in nRow x nChannel x nIn cube with input flags
+  /// @param[in] matrix conversion matrix (nOut x nIn, see conversionMatrix)
+  /// @param[out] out nRow x nChannel x nOut cube, resized if necessary
+  static void convertFlag(const casacore::Cube<casacore::Bool> &in,
+                      const casacore::Matrix<casacore::Complex> &matrix,
+                      casacore::Cube<casacore::Bool> &out);
+
+protected:
+  /// @brief update the conversion matrix and drop cached products if the accessor changed
+  void checkAccessor() const;
+
+  /// @brief fill the buffer with converted visibilities
+  /// @param[in] vis cube to fill
+  void fillVisibility(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief fill the buffer with converted noise
+  /// @param[in] noise cube to fill
+  void fillNoise(casacore::Cube<casacore::Complex> &noise) const;
+
+  /// @brief fill the buffer with converted flags
+  /// @param[in] flag cube to fill
+  void fillFlag(casacore::Cube<casacore::Bool> &flag) const;
+
+private:
+  /// @brief requested polarisation products
+  casacore::Vector<casacore::Stokes::StokesTypes> itsStokes;
+
+  /// @brief input products the conversion matrix corresponds to
+  mutable casacore::Vector<casacore::Stokes::StokesTypes> itsInputStokes;
+
+  /// @brief conversion matrix (nOut x nIn)
+  mutable casacore::Matrix<casacore::Complex> itsMatrix;
+
+  /// @brief change monitor of the accessor the cached products correspond to
+  mutable scimath::ChangeMonitor itsCachedMonitor;
+
+  /// @brief converted visibilities
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsVisibility;
+
+  /// @brief converted noise
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsNoise;
+
+  /// @brief converted flags
+  CachedAccessorField<casacore::Cube<casacore::Bool> > itsFlag;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_POL_CONVERTING_ACCESSOR_H
@@ -0,0 +1,425 @@
+/// @file
+/// @brief quality control statistics accumulated while the data are read
+/// @details This class accumulates the flagged fraction, the mean and rms amplitude and
+/// the number of NaN visibilities per baseline, beam and channel. Iterators update it
+/// when the visibility cube of a chunk is filled (see TableConstDataSource::configureQCStatistics),
+/// so QC doesn't require a separate pass over the data after the science processing.
+/// Statistics of different threads share one object, statistics of different ranks can
+/// be serialised and merged.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+/// Local package
+#include <askap/dataaccess/QCStatistics.h>
+
+// LOFAR includes
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+// std includes
+#include <cmath>
+
+ASKAP_LOGGER(logger, ".dataaccess");
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief version of the serialised statistics
+const int blobVersion = 1;
+
+/// @brief write an accumulator into a blob stream
+/// @param[in] os output stream
+/// @param[in] acc accumulator
+void putAccumulator(LOFAR::BlobOStream &os, const QCStatistics::Accumulator &acc)
+{
+  os<<static_cast<LOFAR::uint64>(acc.itsNSamples)<<static_cast<LOFAR::uint64>(acc.itsNFlagged)<<
+      static_cast<LOFAR::uint64>(acc.itsNNaN)<<static_cast<LOFAR::uint64>(acc.itsNGood)<<
+      acc.itsSumAmp<<acc.itsSumAmp2;
+}
+
+/// @brief read an accumulator from a blob stream
+/// @param[in] is input stream
+/// @param[out] acc accumulator
+void getAccumulator(LOFAR::BlobIStream &is, QCStatistics::Accumulator &acc)
+{
+  LOFAR::uint64 nSamples = 0, nFlagged = 0, nNaN = 0, nGood = 0;
+  is>>nSamples>>nFlagged>>nNaN>>nGood>>acc.itsSumAmp>>acc.itsSumAmp2;
+  acc.itsNSamples = nSamples;
+  acc.itsNFlagged = nFlagged;
+  acc.itsNNaN = nNaN;
+  acc.itsNGood = nGood;
+}
+
+/// @brief write a map of accumulators into a blob stream
+/// @param[in] os output stream
+/// @param[in] accs map of accumulators
+void putAccumulators(LOFAR::BlobOStream &os, const std::map<casacore::uInt, QCStatistics::Accumulator> &accs)
+{
+  os<<static_cast<LOFAR::uint64>(accs.size());
+  for (std::map<casacore::uInt, QCStatistics::Accumulator>::const_iterator ci = accs.begin(); ci != accs.end(); ++ci) {
+       os<<ci->first;
+       putAccumulator(os, ci->second);
+  }
+}
+
+/// @brief merge a map of accumulators read from a blob stream
+/// @param[in] is input stream
+/// @param[in] accs map of accumulators to update
+void mergeAccumulators(LOFAR::BlobIStream &is, std::map<casacore::uInt, QCStatistics::Accumulator> &accs)
+{
+  LOFAR::uint64 size = 0;
+  is>>size;
+  for (LOFAR::uint64 item = 0; item < size; ++item) {
+       casacore::uInt key = 0;
+       is>>key;
+       QCStatistics::Accumulator acc;
+       getAccumulator(is, acc);
+       accs[key].merge(acc);
+  }
+}
+
+/// @brief merge one map of accumulators into another
+/// @param[in] from accumulators to add
+/// @param[in] to accumulators to update
+template<typename Key>
+void mergeAccumulators(const std::map<Key, QCStatistics::Accumulator> &from,
+                       std::map<Key, QCStatistics::Accumulator> &to)
+{
+  for (typename std::map<Key, QCStatistics::Accumulator>::const_iterator ci = from.begin(); ci != from.end(); ++ci) {
+       to[ci->first].merge(ci->second);
+  }
+}
+
+} // anonymous namespace
+
+/// @brief empty accumulator
+QCStatistics::Accumulator::Accumulator() : itsNSamples(0), itsNFlagged(0), itsNNaN(0), itsNGood(0),
+           itsSumAmp(0.), itsSumAmp2(0.) {}
+
+/// @brief add another accumulator to this one
+/// @param[in] other accumulator to add
+void QCStatistics::Accumulator::merge(const Accumulator &other)
+{
+  itsNSamples += other.itsNSamples;
+  itsNFlagged += other.itsNFlagged;
+  itsNNaN += other.itsNNaN;
+  itsNGood += other.itsNGood;
+  itsSumAmp += other.itsSumAmp;
+  itsSumAmp2 += other.itsSumAmp2;
+}
+
+/// @brief fraction of flagged samples
+/// @return flagged fraction (zero if there are no samples)
+double QCStatistics::Accumulator::flagFraction() const
+{
+  return itsNSamples > 0 ? double(itsNFlagged) / double(itsNSamples) : 0.;
+}
+
+/// @brief mean amplitude of unflagged finite samples
+/// @return mean amplitude (zero if there are no such samples)
+double QCStatistics::Accumulator::mean() const
+{
+  return itsNGood > 0 ? itsSumAmp / double(itsNGood) : 0.;
+}
+
+/// @brief rms of the amplitude of unflagged finite samples about the mean
+/// @return rms (zero if there are no such samples)
+double QCStatistics::Accumulator::rms() const
+{
+  if (itsNGood == 0) {
+      return 0.;
+  }
+  const double avg = mean();
+  const double variance = itsSumAmp2 / double(itsNGood) - avg * avg;
+  // round-off can make the variance slightly negative for constant amplitudes
+  return variance > 0. ? std::sqrt(variance) : 0.;
+}
+
+/// @brief construct an object with empty statistics
+QCStatistics::QCStatistics() {}
+
+/// @brief reset all statistics
+void QCStatistics::reset()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsBaselines.clear();
+  itsBeams.clear();
+  itsChannels.clear();
+}
+
+/// @brief account for the data of a chunk
+/// @details This method is thread-safe.
+/// @param[in] vis visibilities (nRow x nChannel x nPol)
+/// @param[in] flag flags (nRow x nChannel x nPol)
+/// @param[in] antenna1 first antenna of each row
+/// @param[in] antenna2 second antenna of each row
+/// @param[in] beam beam (FEED1) of each row
+/// @param[in] startChannel channel number of the first accessor channel
+/// @param[in] channelStep increment of the channel number per accessor channel
+void QCStatistics::add(const casacore::Cube<casacore::Complex> &vis, const casacore::Cube<casacore::Bool> &flag,
+           const casacore::Vector<casacore::uInt> &antenna1, const casacore::Vector<casacore::uInt> &antenna2,
+           const casacore::Vector<casacore::uInt> &beam, casacore::uInt startChannel,
+           casacore::uInt channelStep)
+{
+  ASKAPCHECK(vis.shape() == flag.shape(), "Visibility and flag cubes passed to QCStatistics::add have "
+             "different shapes: "<<vis.shape()<<" and "<<flag.shape());
+  const casacore::uInt nRow = vis.nrow();
+  const casacore::uInt nChan = vis.ncolumn();
+  const casacore::uInt nPol = vis.nplane();
+  ASKAPCHECK((antenna1.nelements() == nRow) && (antenna2.nelements() == nRow) && (beam.nelements() == nRow),
+             "Antenna and beam indices passed to QCStatistics::add don't match the number of rows");
+  // per-row sums of this chunk, each (chan, pol) plane of the cubes is a contiguous
+  // run over the rows, so the inner loops go along the rows
+  std::vector<Accumulator> rows(nRow);
+  std::vector<Accumulator> chans(nChan);
+  casacore::Bool deleteVis, deleteFlag;
+  const casacore::Complex *visData = vis.getStorage(deleteVis);
+  const casacore::Bool *flagData = flag.getStorage(deleteFlag);
+  for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            const size_t offset = size_t(nRow) * (chan + size_t(nChan) * pol);
+            const casacore::Complex *visRun = visData + offset;
+            const casacore::Bool *flagRun = flagData + offset;
+            Accumulator &chanAcc = chans[chan];
+            for (casacore::uInt row = 0; row < nRow; ++row) {
+                 const double re = visRun[row].real();
+                 const double im = visRun[row].imag();
+                 const double amp2 = re * re + im * im;
+                 const bool isNaN = (amp2 != amp2);
+                 const bool good = !flagRun[row] && !isNaN && (amp2 < HUGE_VAL);
+                 const double amp = good ? std::sqrt(amp2) : 0.;
+                 Accumulator &rowAcc = rows[row];
+                 rowAcc.itsNFlagged += flagRun[row] ? 1 : 0;
+                 rowAcc.itsNNaN += isNaN ? 1 : 0;
+                 rowAcc.itsNGood += good ? 1 : 0;
+                 rowAcc.itsSumAmp += amp;
+                 rowAcc.itsSumAmp2 += amp * amp;
+                 chanAcc.itsNFlagged += flagRun[row] ? 1 : 0;
+                 chanAcc.itsNNaN += isNaN ? 1 : 0;
+                 chanAcc.itsNGood += good ? 1 : 0;
+                 chanAcc.itsSumAmp += amp;
+                 chanAcc.itsSumAmp2 += amp * amp;
+            }
+       }
+  }
+  vis.freeStorage(visData, deleteVis);
+  flag.freeStorage(flagData, deleteFlag);
+  // group rows by baseline and beam before taking the lock
+  std::map<Baseline, Accumulator> baselines;
+  std::map<casacore::uInt, Accumulator> beams;
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       rows[row].itsNSamples = casacore::uInt64(nChan) * nPol;
+       baselines[Baseline(antenna1[row], antenna2[row])].merge(rows[row]);
+       beams[beam[row]].merge(rows[row]);
+  }
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  mergeAccumulators(baselines, itsBaselines);
+  mergeAccumulators(beams, itsBeams);
+  for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+       chans[chan].itsNSamples = casacore::uInt64(nRow) * nPol;
+       itsChannels[startChannel + chan * channelStep].merge(chans[chan]);
+  }
+}
+
+/// @brief add statistics accumulated by another object
+/// @details This method is used to combine statistics of different threads or ranks
+/// @param[in] other statistics to add
+void QCStatistics::merge(const QCStatistics &other)
+{
+  if (&other == this) {
+      return;
+  }
+  // take a copy first, so the two locks are never held at the same time
+  std::map<Baseline, Accumulator> baselines;
+  std::map<casacore::uInt, Accumulator> beams;
+  std::map<casacore::uInt, Accumulator> chans;
+  {
+    boost::lock_guard<boost::mutex> lock(other.itsMutex);
+    baselines = other.itsBaselines;
+    beams = other.itsBeams;
+    chans = other.itsChannels;
+  }
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  mergeAccumulators(baselines, itsBaselines);
+  mergeAccumulators(beams, itsBeams);
+  mergeAccumulators(chans, itsChannels);
+}
+
+/// @brief add statistics received from another rank
+/// @param[in] is input stream with the statistics written by serialise
+void QCStatistics::merge(LOFAR::BlobIStream &is)
+{
+  const int version = is.getStart("QCStatistics");
+  ASKAPCHECK(version == blobVersion, "Attempting to read QC statistics of version "<<version<<
+             ", only version "<<blobVersion<<" is supported");
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  LOFAR::uint64 size = 0;
+  is>>size;
+  for (LOFAR::uint64 item = 0; item < size; ++item) {
+       casacore::uInt ant1 = 0, ant2 = 0;
+       is>>ant1>>ant2;
+       Accumulator acc;
+       getAccumulator(is, acc);
+       itsBaselines[Baseline(ant1, ant2)].merge(acc);
+  }
+  mergeAccumulators(is, itsBeams);
+  mergeAccumulators(is, itsChannels);
+  is.getEnd();
+}
+
+/// @brief write the statistics into a blob stream
+/// @details The result can be merged into an object on another rank.
+/// @param[in] os output stream
+void QCStatistics::serialise(LOFAR::BlobOStream &os) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  os.putStart("QCStatistics", blobVersion);
+  os<<static_cast<LOFAR::uint64>(itsBaselines.size());
+  for (std::map<Baseline, Accumulator>::const_iterator ci = itsBaselines.begin(); ci != itsBaselines.end(); ++ci) {
+       os<<ci->first.first<<ci->first.second;
+       putAccumulator(os, ci->second);
+  }
+  putAccumulators(os, itsBeams);
+  putAccumulators(os, itsChannels);
+  os.putEnd();
+}
+
+/// @brief statistics of all samples
+QCStatistics::Accumulator QCStatistics::total() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  Accumulator result;
+  for (std::map<casacore::uInt, Accumulator>::const_iterator ci = itsBeams.begin(); ci != itsBeams.end(); ++ci) {
+       result.merge(ci->second);
+  }
+  return result;
+}
+
+/// @brief statistics of one baseline
+/// @param[in] ant1 first antenna
+/// @param[in] ant2 second antenna
+/// @return statistics (empty if the baseline hasn't been seen)
+QCStatistics::Accumulator QCStatistics::baseline(casacore::uInt ant1, casacore::uInt ant2) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const std::map<Baseline, Accumulator>::const_iterator ci = itsBaselines.find(Baseline(ant1, ant2));
+  return ci != itsBaselines.end() ? ci->second : Accumulator();
+}
+
+/// @brief statistics of one beam
+/// @param[in] beam beam (FEED1)
+/// @return statistics (empty if the beam hasn't been seen)
+QCStatistics::Accumulator QCStatistics::beam(casacore::uInt beam) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const std::map<casacore::uInt, Accumulator>::const_iterator ci = itsBeams.find(beam);
+  return ci != itsBeams.end() ? ci->second : Accumulator();
+}
+
+/// @brief statistics of one channel
+/// @param[in] chan channel number in the spectral window
+/// @return statistics (empty if the channel hasn't been seen)
+QCStatistics::Accumulator QCStatistics::channel(casacore::uInt chan) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const std::map<casacore::uInt, Accumulator>::const_iterator ci = itsChannels.find(chan);
+  return ci != itsChannels.end() ? ci->second : Accumulator();
+}
+
+/// @brief baselines seen so far
+std::vector<QCStatistics::Baseline> QCStatistics::baselines() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  std::vector<Baseline> result;
+  result.reserve(itsBaselines.size());
+  for (std::map<Baseline, Accumulator>::const_iterator ci = itsBaselines.begin(); ci != itsBaselines.end(); ++ci) {
+       result.push_back(ci->first);
+  }
+  return result;
+}
+
+/// @brief beams seen so far
+std::vector<casacore::uInt> QCStatistics::beams() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  std::vector<casacore::uInt> result;
+  result.reserve(itsBeams.size());
+  for (std::map<casacore::uInt, Accumulator>::const_iterator ci = itsBeams.begin(); ci != itsBeams.end(); ++ci) {
+       result.push_back(ci->first);
+  }
+  return result;
+}
+
+/// @brief channels seen so far
+std::vector<casacore::uInt> QCStatistics::channels() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  std::vector<casacore::uInt> result;
+  result.reserve(itsChannels.size());
+  for (std::map<casacore::uInt, Accumulator>::const_iterator ci = itsChannels.begin(); ci != itsChannels.end(); ++ci) {
+       result.push_back(ci->first);
+  }
+  return result;
+}
+
+/// @brief write the summary into the log
+/// @details Totals and statistics per beam are written at the INFO level, statistics
+/// per baseline and channel at the DEBUG level.
+void QCStatistics::log() const
+{
+  const Accumulator all = total();
+  ASKAPLOG_INFO_STR(logger, "QC statistics: "<<all.itsNSamples<<" samples, flagged fraction "<<
+                    all.flagFraction()<<", "<<all.itsNNaN<<" NaNs, amplitude mean "<<all.mean()<<
+                    " rms "<<all.rms());
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  for (std::map<casacore::uInt, Accumulator>::const_iterator ci = itsBeams.begin(); ci != itsBeams.end(); ++ci) {
+       ASKAPLOG_INFO_STR(logger, "  beam "<<ci->first<<": flagged fraction "<<ci->second.flagFraction()<<
+                         ", "<<ci->second.itsNNaN<<" NaNs, amplitude mean "<<ci->second.mean()<<
+                         " rms "<<ci->second.rms());
+  }
+  for (std::map<Baseline, Accumulator>::const_iterator ci = itsBaselines.begin(); ci != itsBaselines.end(); ++ci) {
+       ASKAPLOG_DEBUG_STR(logger, "  baseline "<<ci->first.first<<"-"<<ci->first.second<<": flagged fraction "<<
+                          ci->second.flagFraction()<<", "<<ci->second.itsNNaN<<" NaNs, amplitude mean "<<
+                          ci->second.mean()<<" rms "<<ci->second.rms());
+  }
+  for (std::map<casacore::uInt, Accumulator>::const_iterator ci = itsChannels.begin(); ci != itsChannels.end(); ++ci) {
+       ASKAPLOG_DEBUG_STR(logger, "  channel "<<ci->first<<": flagged fraction "<<ci->second.flagFraction()<<
+                          ", "<<ci->second.itsNNaN<<" NaNs, amplitude mean "<<ci->second.mean()<<
+                          " rms "<<ci->second.rms());
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,199 @@
+/// @file
+/// @brief quality control statistics accumulated while the data are read
+/// @details This class accumulates the flagged fraction, the mean and rms amplitude and
+/// the number of NaN visibilities per baseline, beam and channel. Iterators update it
+/// once per chunk as the data are read (see TableConstDataSource::configureQCStatistics),
+/// so QC doesn't require a separate pass over the data after the science processing.
+/// Statistics of different threads share one object, statistics of different ranks can
+/// be serialised and merged.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_QC_STATISTICS_H
+#define ASKAP_ACCESSORS_QC_STATISTICS_H
+
+// std includes
+#include <map>
+#include <utility>
+#include <vector>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+namespace LOFAR {
+
+class BlobIStream;
+class BlobOStream;
+
+} // namespace LOFAR
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief quality control statistics accumulated while the data are read
+/// @details Amplitude statistics are accumulated for unflagged finite visibilities,
+/// NaNs are counted regardless of the flags (and are not included into the amplitude
+/// statistics). All polarisation products contribute to the same accumulators. Channels
+/// are identified by the channel number in the full spectral window (the first channel
+/// contributing to the accessor channel if channels are averaged at read time), beams by
+/// FEED1. One object can be shared by a number of iterators (possibly in different threads):
+/// each chunk is accumulated into temporary per-row and per-channel sums which are merged
+/// into the totals under a lock.
+/// @ingroup dataaccess_hlp
+class QCStatistics : private boost::noncopyable
+{
+public:
+  /// @brief statistics of a group of samples
+  struct Accumulator {
+     /// @brief empty accumulator
+     Accumulator();
+
+     /// @brief add another accumulator to this one
+     /// @param[in] other accumulator to add
+     void merge(const Accumulator &other);
+
+     /// @brief fraction of flagged samples
+     /// @return flagged fraction (zero if there are no samples)
+     double flagFraction() const;
+
+     /// @brief mean amplitude of unflagged finite samples
+     /// @return mean amplitude (zero if there are no such samples)
+     double mean() const;
+
+     /// @brief rms of the amplitude of unflagged finite samples about the mean
+     /// @return rms (zero if there are no such samples)
+     double rms() const;
+
+     /// @brief total number of samples
+     casacore::uInt64 itsNSamples;
+     /// @brief number of flagged samples
+     casacore::uInt64 itsNFlagged;
+     /// @brief number of NaN samples
+     casacore::uInt64 itsNNaN;
+     /// @brief number of samples contributing to the amplitude statistics
+     casacore::uInt64 itsNGood;
+     /// @brief sum of amplitudes
+     double itsSumAmp;
+     /// @brief sum of squared amplitudes
+     double itsSumAmp2;
+  };
+
+  /// @brief baseline given by a pair of antenna indices
+  typedef std::pair<casacore::uInt, casacore::uInt> Baseline;
+
+  /// @brief construct an object with empty statistics
+  QCStatistics();
+
+  /// @brief reset all statistics
+  void reset();
+
+  /// @brief account for the data of a chunk
+  /// @details This method is thread-safe.
+  /// @param[in] vis visibilities (nRow x nChannel x nPol)
+  /// @param[in] flag flags (nRow x nChannel x nPol)
+  /// @param[in] antenna1 first antenna of each row
+  /// @param[in] antenna2 second antenna of each row
+  /// @param[in] beam beam (FEED1) of each row
+  /// @param[in] startChannel channel number of the first accessor channel
+  /// @param[in] channelStep increment of the channel number per accessor channel
+  void add(const casacore::Cube<casacore::Complex> &vis, const casacore::Cube<casacore::Bool> &flag,
+           const casacore::Vector<casacore::uInt> &antenna1, const casacore::Vector<casacore::uInt> &antenna2,
+           const casacore::Vector<casacore::uInt> &beam, casacore::uInt startChannel,
+           casacore::uInt channelStep = 1);
+
+  /// @brief add statistics accumulated by another object
+  /// @details This method is used to combine statistics of different threads or ranks
+  /// @param[in] other statistics to add
+  void merge(const QCStatistics &other);
+
+  /// @brief add statistics received from another rank
+  /// @param[in] is input stream with the statistics written by serialise
+  void merge(LOFAR::BlobIStream &is);
+
+  /// @brief write the statistics into a blob stream
+  /// @details The result can be merged into an object on another rank.
+  /// @param[in] os output stream
+  void serialise(LOFAR::BlobOStream &os) const;
+
+  /// @brief statistics of all samples
+  Accumulator total() const;
+
+  /// @brief statistics of one baseline
+  /// @param[in] ant1 first antenna
+  /// @param[in] ant2 second antenna
+  /// @return statistics (empty if the baseline hasn't been seen)
+  Accumulator baseline(casacore::uInt ant1, casacore::uInt ant2) const;
+
+  /// @brief statistics of one beam
+  /// @param[in] beam beam (FEED1)
+  /// @return statistics (empty if the beam hasn't been seen)
+  Accumulator beam(casacore::uInt beam) const;
+
+  /// @brief statistics of one channel
+  /// @param[in] chan channel number in the spectral window
+  /// @return statistics (empty if the channel hasn't been seen)
+  Accumulator channel(casacore::uInt chan) const;
+
+  /// @brief baselines seen so far
+  std::vector<Baseline> baselines() const;
+
+  /// @brief beams seen so far
+  std::vector<casacore::uInt> beams() const;
+
+  /// @brief channels seen so far
+  std::vector<casacore::uInt> channels() const;
+
+  /// @brief write the summary into the log
+  /// @details Totals and statistics per beam are written at the INFO level, statistics
+  /// per baseline and channel at the DEBUG level.
+  void log() const;
+
+private:
+  /// @brief statistics per baseline
+  std::map<Baseline, Accumulator> itsBaselines;
+
+  /// @brief statistics per beam
+  std::map<casacore::uInt, Accumulator> itsBeams;
+
+  /// @brief statistics per channel
+  std::map<casacore::uInt, Accumulator> itsChannels;
+
+  /// @brief mutex protecting the statistics
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_QC_STATISTICS_H
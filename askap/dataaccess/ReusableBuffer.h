@@ -0,0 +1,174 @@
+/// @file
+/// @brief storage reused by the accessor fields between chunks
+///
+/// @details The table iterator fills the visibility, flag and noise cubes
+/// of the accessor for every chunk. Resizing a casacore array releases the old storage
+/// and allocates a new block whenever the shape changes, which happens often if the
+/// number of rows varies from chunk to chunk. This class keeps the largest block
+/// seen so far and hands out views of the required shape into its front part.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_REUSABLE_BUFFER_H
+#define ASKAP_ACCESSORS_REUSABLE_BUFFER_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <cstddef>
+#include <vector>
+
+// own includes
+#include <askap/dataaccess/IBufferAllocator.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief storage reused by the accessor fields between chunks
+/// @details The buffer owns a contiguous block of elements which only grows. 
+/// The reshape methods make the given array reference the first elements of this
+/// block with the requested shape, so no allocation takes place unless the new shape
+/// has more elements than any shape requested before. The block is reference counted
+/// (it is a casacore array), therefore arrays referencing an old block stay valid
+/// when the buffer grows or is released. However, the content of the arrays referencing
+/// the current block is overwritten when the buffer is reshaped and filled again. This
+/// is the same behaviour as that of the casacore resize if the shape doesn't change.
+/// The values of the elements are undefined after reshape.
+/// 
+/// If a custom allocator is set (see IBufferAllocator), the blocks are taken from it 
+/// instead. Arrays only share such blocks (casacore doesn't track their lifetime), 
+/// therefore the old blocks are kept when the buffer grows and all blocks are returned
+/// to the allocator when the buffer is released or destroyed. Arrays referencing the
+/// buffer must not be used after that.
+/// @ingroup dataaccess_hlp
+template<typename T>
+class ReusableBuffer {
+public:
+  /// @brief make the cube reference the buffer with the given shape
+  /// @param[in] cube cube to set up
+  /// @param[in] n1 first dimension
+  /// @param[in] n2 second dimension
+  /// @param[in] n3 third dimension
+  void reshape(casacore::Cube<T> &cube, casacore::uInt n1, casacore::uInt n2, 
+               casacore::uInt n3);
+
+  /// @brief make the matrix reference the buffer with the given shape
+  /// @param[in] matrix matrix to set up
+  /// @param[in] n1 first dimension
+  /// @param[in] n2 second dimension
+  void reshape(casacore::Matrix<T> &matrix, casacore::uInt n1, casacore::uInt n2);
+
+  /// @brief make the vector reference the buffer with the given length
+  /// @param[in] vec vector to set up
+  /// @param[in] n length
+  void reshape(casacore::Vector<T> &vec, casacore::uInt n);
+  
+  /// @brief number of elements which can be handed out without allocation
+  /// @return current size of the block
+  inline size_t capacity() const { return itsStorage.nelements(); }
+  
+  /// @brief release the storage
+  /// @details The block is freed as soon as no array references it. The next
+  /// reshape call allocates a new block of the required size. Blocks obtained from
+  /// a custom allocator are returned to it straight away.
+  void release();
+
+  /// @brief set the allocator of the storage blocks
+  /// @details The current storage is released (see release). 
+  /// @param[in] allocator shared pointer to the allocator, an empty pointer means 
+  /// the default casacore allocation
+  void setAllocator(const boost::shared_ptr<IBufferAllocator> &allocator);
+
+  /// @brief allocator of the storage blocks
+  /// @return shared pointer to the allocator (empty for the default allocation)
+  inline const boost::shared_ptr<IBufferAllocator>& allocator() const { return itsAllocator; }
+  
+protected:
+  /// @brief obtain a view of the block with the given shape
+  /// @details The block is reallocated if it is too small, the old content is not copied.
+  /// @param[in] shape required shape
+  /// @return array referencing the front part of the block
+  casacore::Array<T> view(const casacore::IPosition &shape);
+  
+  /// @brief check whether the array already references the block with the given shape
+  /// @param[in] arr array to check
+  /// @param[in] shape required shape
+  /// @return true, if no action is required
+  bool isView(const casacore::Array<T> &arr, const casacore::IPosition &shape) const;
+
+private:
+  /// @brief deleter of the blocks taken from a custom allocator
+  struct BlockDeleter {
+    /// @brief set up the deleter
+    /// @param[in] allocator allocator the block has been taken from
+    /// @param[in] nElements number of elements in the block
+    BlockDeleter(const boost::shared_ptr<IBufferAllocator> &allocator, size_t nElements) :
+                 itsAllocator(allocator), itsNElements(nElements) {}
+
+    /// @brief destroy the elements and return the block
+    /// @param[in] ptr pointer to the block
+    void operator()(T *ptr) const;
+
+    /// @brief allocator the block has been taken from
+    boost::shared_ptr<IBufferAllocator> itsAllocator;
+    /// @brief number of elements in the block
+    size_t itsNElements;
+  };
+
+  /// @brief obtain a new block from the custom allocator
+  /// @details The current block (if any) is retired, i.e. kept until release.
+  /// @param[in] nElements number of elements required
+  void allocateBlock(size_t nElements);
+
+  /// @brief the block of elements
+  casacore::Vector<T> itsStorage;
+
+  /// @brief custom allocator (empty pointer for the default allocation)
+  boost::shared_ptr<IBufferAllocator> itsAllocator;
+
+  /// @brief current block taken from the custom allocator
+  boost::shared_ptr<T> itsBlock;
+
+  /// @brief blocks of the custom allocator which may still be referenced
+  std::vector<boost::shared_ptr<T> > itsRetiredBlocks;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#include <askap/dataaccess/ReusableBuffer.tcc>
+
+#endif // #ifndef ASKAP_ACCESSORS_REUSABLE_BUFFER_H
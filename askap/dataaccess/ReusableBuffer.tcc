@@ -0,0 +1,187 @@
+/// @file
+/// @brief storage reused by the accessor fields between chunks
+///
+/// @details The table iterator fills the visibility, flag and noise cubes
+/// of the accessor for every chunk. Resizing a casacore array releases the old storage
+/// and allocates a new block whenever the shape changes, which happens often if the
+/// number of rows varies from chunk to chunk. This class keeps the largest block
+/// seen so far and hands out views of the required shape into its front part.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_REUSABLE_BUFFER_TCC
+#define ASKAP_ACCESSORS_REUSABLE_BUFFER_TCC
+
+// own includes
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Slice.h>
+
+// std includes
+#include <new>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief make the cube reference the buffer with the given shape
+/// @param[in] cube cube to set up
+/// @param[in] n1 first dimension
+/// @param[in] n2 second dimension
+/// @param[in] n3 third dimension
+template<typename T>
+void ReusableBuffer<T>::reshape(casacore::Cube<T> &cube, casacore::uInt n1, casacore::uInt n2, 
+                                casacore::uInt n3)
+{
+  const casacore::IPosition shape(3, n1, n2, n3);
+  if (!isView(cube, shape)) {
+      cube.reference(view(shape));
+  }
+}
+
+/// @brief make the matrix reference the buffer with the given shape
+/// @param[in] matrix matrix to set up
+/// @param[in] n1 first dimension
+/// @param[in] n2 second dimension
+template<typename T>
+void ReusableBuffer<T>::reshape(casacore::Matrix<T> &matrix, casacore::uInt n1, casacore::uInt n2)
+{
+  const casacore::IPosition shape(2, n1, n2);
+  if (!isView(matrix, shape)) {
+      matrix.reference(view(shape));
+  }
+}
+
+/// @brief make the vector reference the buffer with the given length
+/// @param[in] vec vector to set up
+/// @param[in] n length
+template<typename T>
+void ReusableBuffer<T>::reshape(casacore::Vector<T> &vec, casacore::uInt n)
+{
+  const casacore::IPosition shape(1, n);
+  if (!isView(vec, shape)) {
+      vec.reference(view(shape));
+  }
+}
+
+/// @brief release the storage
+/// @details The block is freed as soon as no array references it. The next
+/// reshape call allocates a new block of the required size.
+template<typename T>
+void ReusableBuffer<T>::release()
+{
+  itsStorage.reference(casacore::Vector<T>());
+  itsBlock.reset();
+  itsRetiredBlocks.clear();
+}
+
+/// @brief set the allocator of the storage blocks
+/// @details The current storage is released (see release). 
+/// @param[in] allocator shared pointer to the allocator, an empty pointer means 
+/// the default casacore allocation
+template<typename T>
+void ReusableBuffer<T>::setAllocator(const boost::shared_ptr<IBufferAllocator> &allocator)
+{
+  release();
+  itsAllocator = allocator;
+}
+
+/// @brief destroy the elements and return the block
+/// @param[in] ptr pointer to the block
+template<typename T>
+void ReusableBuffer<T>::BlockDeleter::operator()(T *ptr) const
+{
+  for (size_t i = 0; i < itsNElements; ++i) {
+       ptr[i].~T();
+  }
+  itsAllocator->deallocate(ptr, itsNElements * sizeof(T));
+}
+
+/// @brief obtain a new block from the custom allocator
+/// @details The current block (if any) is retired, i.e. kept until release.
+/// @param[in] nElements number of elements required
+template<typename T>
+void ReusableBuffer<T>::allocateBlock(size_t nElements)
+{
+  ASKAPDEBUGASSERT(itsAllocator);
+  ASKAPDEBUGASSERT(nElements > 0);
+  T *ptr = static_cast<T*>(itsAllocator->allocate(nElements * sizeof(T)));
+  ASKAPCHECK(ptr != NULL, "Custom allocator failed to provide "<<nElements * sizeof(T)<<" bytes");
+  for (size_t i = 0; i < nElements; ++i) {
+       new (ptr + i) T();
+  }
+  if (itsBlock) {
+      itsRetiredBlocks.push_back(itsBlock);
+  }
+  itsBlock.reset(ptr, BlockDeleter(itsAllocator, nElements));
+  // the block is shared, its lifetime is controlled by itsBlock
+  itsStorage.reference(casacore::Vector<T>(casacore::IPosition(1, nElements), ptr, casacore::SHARE));
+}
+
+/// @brief obtain a view of the block with the given shape
+/// @details The block is reallocated if it is too small, the old content is not copied.
+/// @param[in] shape required shape
+/// @return array referencing the front part of the block
+template<typename T>
+casacore::Array<T> ReusableBuffer<T>::view(const casacore::IPosition &shape)
+{
+  const size_t nElements = size_t(shape.product());
+  if (nElements == 0) {
+      // nothing to share, empty arrays don't hold any storage
+      return casacore::Array<T>(shape);
+  }
+  if (nElements > capacity()) {
+      if (itsAllocator) {
+          allocateBlock(nElements);
+      } else {
+          // reference a new block rather than resize, arrays handed out before keep the old one
+          itsStorage.reference(casacore::Vector<T>(nElements));
+      }
+  }
+  casacore::Vector<T> front = itsStorage(casacore::Slice(0, nElements));
+  return front.reform(shape);
+}
+
+/// @brief check whether the array already references the block with the given shape
+/// @param[in] arr array to check
+/// @param[in] shape required shape
+/// @return true, if no action is required
+template<typename T>
+bool ReusableBuffer<T>::isView(const casacore::Array<T> &arr, const casacore::IPosition &shape) const
+{
+  if (!arr.shape().isEqual(shape)) {
+      return false;
+  }
+  // empty arrays are always fine, otherwise the array must start at the front of the block
+  return (arr.nelements() == 0) || ((capacity() > 0) && (arr.data() == itsStorage.data()));
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_REUSABLE_BUFFER_TCC
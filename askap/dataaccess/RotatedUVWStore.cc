@@ -0,0 +1,209 @@
+/// @file
+/// @brief memory-bounded store of rotated uvws shared between iterations
+/// @details Rotated uvw coordinates and associated delays depend only on the
+/// uvw, pointing direction and time of the given rows and on the tangent point.
+/// Imaging repeats the same iteration over the data many times (major cycles),
+/// so the rotation results can be reused instead of being recalculated for each
+/// pass. This class holds rotation results in memory keyed by the chunk of the
+/// measurement set they correspond to. See 
+/// TableConstDataSource::configureRotatedUVWStore.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/RotatedUVWStore.h>
+#include <askap/dataaccess/UVWMachineCache.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/functional/hash.hpp>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief default memory limit in bytes
+const size_t RotatedUVWStore::DEFAULT_MEMORY_LIMIT;
+
+/// @brief empty key, doesn't match any chunk
+RotatedUVWStore::ChunkKey::ChunkKey() : itsTime(0.), itsHash(0) {}
+
+/// @brief construct the key
+/// @param[in] time time of the chunk
+/// @param[in] rows row numbers in the measurement set
+RotatedUVWStore::ChunkKey::ChunkKey(casacore::Double time, const std::vector<casacore::uInt> &rows) :
+        itsTime(time), itsRows(rows), itsHash(0)
+{
+  boost::hash_combine(itsHash, time);
+  boost::hash_range(itsHash, rows.begin(), rows.end());
+}
+
+/// @brief comparison operator
+/// @param[in] other key to compare with
+/// @return true if both keys correspond to the same chunk
+bool RotatedUVWStore::ChunkKey::operator==(const ChunkKey &other) const
+{
+  return (itsHash == other.itsHash) && (itsTime == other.itsTime) && (itsRows == other.itsRows);
+}
+
+/// @brief construct the store
+/// @param[in] maxBytes maximum number of bytes to hold (0 means DEFAULT_MEMORY_LIMIT)
+/// @param[in] tolerance tangent point tolerance in radians
+RotatedUVWStore::RotatedUVWStore(size_t maxBytes, double tolerance) :
+        itsMaxBytes(maxBytes > 0 ? maxBytes : size_t(DEFAULT_MEMORY_LIMIT)),
+        itsTolerance(tolerance), itsBytes(0), itsHits(0), itsMisses(0) {}
+
+/// @brief find an entry
+/// @details This method should be called with the mutex locked.
+/// @param[in] key chunk of the measurement set
+/// @param[in] tangent direction to the tangent point
+/// @return iterator in the index, end() if not found
+RotatedUVWStore::EntryIndex::iterator RotatedUVWStore::find(const ChunkKey &key,
+                                                            const casacore::MDirection &tangent)
+{
+  const std::pair<EntryIndex::iterator, EntryIndex::iterator> range = itsIndex.equal_range(key.itsHash);
+  for (EntryIndex::iterator it = range.first; it != range.second; ++it) {
+       const Entry &entry = *(it->second);
+       if ((entry.itsKey == key) && UVWMachineCache::compare(entry.itsTangent, tangent, itsTolerance)) {
+           return it;
+       }
+  }
+  return itsIndex.end();
+}
+
+/// @brief obtain stored rotation results
+/// @details The data are copied, so the caller is free to modify them.
+/// @param[in] key chunk of the measurement set
+/// @param[in] tangent direction to the tangent point
+/// @param[out] uvw rotated uvws (resized as required)
+/// @param[out] delays delays associated with the rotation (resized as required)
+/// @return true if the results were found, false otherwise (parameters are not changed)
+bool RotatedUVWStore::get(const ChunkKey &key, const casacore::MDirection &tangent,
+                          casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                          casacore::Vector<casacore::Double> &delays)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const EntryIndex::iterator it = find(key, tangent);
+  if (it == itsIndex.end()) {
+      ++itsMisses;
+      return false;
+  }
+  ++itsHits;
+  // move the entry to the front of the list, iterators stay valid
+  itsEntries.splice(itsEntries.begin(), itsEntries, it->second);
+  const Entry &entry = *(it->second);
+  uvw.resize(entry.itsUVW.nelements());
+  uvw = entry.itsUVW;
+  delays.resize(entry.itsDelays.nelements());
+  delays = entry.itsDelays;
+  return true;
+}
+
+/// @brief store rotation results
+/// @details The data are copied. An existing entry for the same chunk and tangent
+/// point is replaced. Nothing is stored if a single entry exceeds the limit.
+/// @param[in] key chunk of the measurement set
+/// @param[in] tangent direction to the tangent point
+/// @param[in] uvw rotated uvws
+/// @param[in] delays delays associated with the rotation (for the image centre
+/// equal to the tangent point)
+void RotatedUVWStore::put(const ChunkKey &key, const casacore::MDirection &tangent,
+                          const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                          const casacore::Vector<casacore::Double> &delays)
+{
+  ASKAPDEBUGASSERT(uvw.nelements() == delays.nelements());
+  const size_t bytes = sizeof(Entry) + key.itsRows.size() * sizeof(casacore::uInt) + 
+        uvw.nelements() * sizeof(casacore::RigidVector<casacore::Double, 3>) +
+        delays.nelements() * sizeof(casacore::Double);
+  if (bytes > itsMaxBytes) {
+      return;
+  }
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const EntryIndex::iterator it = find(key, tangent);
+  if (it != itsIndex.end()) {
+      itsBytes -= it->second->itsBytes;
+      itsEntries.erase(it->second);
+      itsIndex.erase(it);
+  }
+  // drop the least recently used entries
+  while (itsBytes + bytes > itsMaxBytes) {
+     ASKAPDEBUGASSERT(itsEntries.size() > 0);
+     EntryList::iterator last = itsEntries.end();
+     --last;
+     const std::pair<EntryIndex::iterator, EntryIndex::iterator> range = 
+           itsIndex.equal_range(last->itsKey.itsHash);
+     for (EntryIndex::iterator ci = range.first; ci != range.second; ++ci) {
+          if (ci->second == last) {
+              itsIndex.erase(ci);
+              break;
+          }
+     }
+     itsBytes -= last->itsBytes;
+     itsEntries.erase(last);
+  }
+  itsEntries.push_front(Entry());
+  Entry &entry = itsEntries.front();
+  entry.itsKey = key;
+  entry.itsTangent = tangent;
+  // assignment to an empty vector copies the values
+  entry.itsUVW = uvw;
+  entry.itsDelays = delays;
+  entry.itsBytes = bytes;
+  itsBytes += bytes;
+  itsIndex.insert(std::make_pair(key.itsHash, itsEntries.begin()));
+}
+
+/// @brief remove all entries
+void RotatedUVWStore::clear()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsIndex.clear();
+  itsEntries.clear();
+  itsBytes = 0;
+}
+
+/// @brief number of successful lookups
+/// @return number of get calls which found the results
+size_t RotatedUVWStore::nHits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsHits;
+}
+
+/// @brief number of unsuccessful lookups
+/// @return number of get calls which didn't find the results
+size_t RotatedUVWStore::nMisses() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsMisses;
+}
+
+/// @brief memory currently used by the entries
+/// @return approximate number of bytes held
+size_t RotatedUVWStore::memoryUsed() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsBytes;
+}
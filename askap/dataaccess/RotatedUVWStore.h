@@ -0,0 +1,196 @@
+/// @file
+/// @brief memory-bounded store of rotated uvws shared between iterations
+/// @details Rotated uvw coordinates and associated delays depend only on the
+/// uvw, pointing direction and time of the given rows and on the tangent point.
+/// Imaging repeats the same iteration over the data many times (major cycles),
+/// so the rotation results can be reused instead of being recalculated for each
+/// pass. This class holds rotation results in memory keyed by the chunk of the
+/// measurement set they correspond to. See 
+/// TableConstDataSource::configureRotatedUVWStore.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_ROTATED_UVW_STORE_H
+#define ASKAP_ACCESSORS_ROTATED_UVW_STORE_H
+
+// std includes
+#include <list>
+#include <vector>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief memory-bounded store of rotated uvws shared between iterations
+/// @details Each entry corresponds to a chunk of rows (identified by time and 
+/// the row numbers in the measurement set) and a tangent point. Entries are
+/// kept until the total size exceeds the limit given in the constructor, the least
+/// recently used entries are dropped then. The store doesn't monitor the data, it
+/// assumes that uvw and pointing directions of a given row are the same for all iterators
+/// using the store (i.e. the same data converter and the same measurement set). All 
+/// methods can be called from several threads.
+/// @ingroup dataaccess_tab
+class RotatedUVWStore : private boost::noncopyable {
+public:
+  /// @brief default memory limit in bytes
+  static const size_t DEFAULT_MEMORY_LIMIT = 256u * 1024u * 1024u;
+
+  /// @brief chunk of the measurement set
+  struct ChunkKey {
+     /// @brief empty key, doesn't match any chunk
+     ChunkKey();
+
+     /// @brief construct the key
+     /// @param[in] time time of the chunk
+     /// @param[in] rows row numbers in the measurement set
+     ChunkKey(casacore::Double time, const std::vector<casacore::uInt> &rows);
+
+     /// @brief comparison operator
+     /// @param[in] other key to compare with
+     /// @return true if both keys correspond to the same chunk
+     bool operator==(const ChunkKey &other) const;
+
+     /// @brief time of the chunk
+     casacore::Double itsTime;
+     /// @brief row numbers in the measurement set
+     std::vector<casacore::uInt> itsRows;
+     /// @brief hash of the time and row numbers
+     size_t itsHash;
+  };
+
+  /// @brief construct the store
+  /// @param[in] maxBytes maximum number of bytes to hold (0 means DEFAULT_MEMORY_LIMIT)
+  /// @param[in] tolerance tangent point tolerance in radians
+  explicit RotatedUVWStore(size_t maxBytes = DEFAULT_MEMORY_LIMIT, double tolerance = 1e-6);
+
+  /// @brief obtain stored rotation results
+  /// @details The data are copied, so the caller is free to modify them.
+  /// @param[in] key chunk of the measurement set
+  /// @param[in] tangent direction to the tangent point
+  /// @param[out] uvw rotated uvws (resized as required)
+  /// @param[out] delays delays associated with the rotation (resized as required)
+  /// @return true if the results were found, false otherwise (parameters are not changed)
+  bool get(const ChunkKey &key, const casacore::MDirection &tangent,
+           casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+           casacore::Vector<casacore::Double> &delays);
+
+  /// @brief store rotation results
+  /// @details The data are copied. An existing entry for the same chunk and tangent
+  /// point is replaced. Nothing is stored if a single entry exceeds the limit.
+  /// @param[in] key chunk of the measurement set
+  /// @param[in] tangent direction to the tangent point
+  /// @param[in] uvw rotated uvws
+  /// @param[in] delays delays associated with the rotation (for the image centre
+  /// equal to the tangent point)
+  void put(const ChunkKey &key, const casacore::MDirection &tangent,
+           const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+           const casacore::Vector<casacore::Double> &delays);
+
+  /// @brief remove all entries
+  void clear();
+
+  /// @brief number of successful lookups
+  /// @return number of get calls which found the results
+  size_t nHits() const;
+
+  /// @brief number of unsuccessful lookups
+  /// @return number of get calls which didn't find the results
+  size_t nMisses() const;
+
+  /// @brief memory currently used by the entries
+  /// @return approximate number of bytes held
+  size_t memoryUsed() const;
+
+protected:
+  /// @brief rotation results for one chunk and tangent point
+  struct Entry {
+     /// @brief chunk of the measurement set
+     ChunkKey itsKey;
+     /// @brief tangent point
+     casacore::MDirection itsTangent;
+     /// @brief rotated uvws
+     casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+     /// @brief delays
+     casacore::Vector<casacore::Double> itsDelays;
+     /// @brief approximate size in bytes
+     size_t itsBytes;
+  };
+
+  /// @brief type of the list of entries, the most recently used are at the front
+  typedef std::list<Entry> EntryList;
+
+  /// @brief type of the index of entries by the key hash
+  typedef boost::unordered_multimap<size_t, EntryList::iterator> EntryIndex;
+
+  /// @brief find an entry
+  /// @details This method should be called with the mutex locked.
+  /// @param[in] key chunk of the measurement set
+  /// @param[in] tangent direction to the tangent point
+  /// @return iterator in the index, end() if not found
+  EntryIndex::iterator find(const ChunkKey &key, const casacore::MDirection &tangent);
+
+private:
+  /// @brief maximum number of bytes to hold
+  size_t itsMaxBytes;
+
+  /// @brief tangent point tolerance in radians
+  double itsTolerance;
+
+  /// @brief number of bytes held
+  size_t itsBytes;
+
+  /// @brief entries in the order of use
+  EntryList itsEntries;
+
+  /// @brief index of entries
+  EntryIndex itsIndex;
+
+  /// @brief number of successful lookups
+  size_t itsHits;
+
+  /// @brief number of unsuccessful lookups
+  size_t itsMisses;
+
+  /// @brief mutex protecting all data members
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ROTATED_UVW_STORE_H
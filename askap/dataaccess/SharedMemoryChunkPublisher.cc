@@ -0,0 +1,132 @@
+/// @file
+/// @brief publisher of chunks via shared memory
+/// @details This class allows one process to read the data (e.g. from a measurement set)
+/// and share the chunks with a number of processes on the same node, which receive them
+/// via SharedMemoryChunkReceiver and StreamDataSource. This way the disk is read once per
+/// node rather than once per process.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/SharedMemoryChunkPublisher.h>
+#include <askap/dataaccess/CachedDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// LOFAR includes
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobOStream.h>
+
+// std includes
+#include <cstring>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief create the shared memory segment
+/// @param[in] name name of the shared memory segment (should start with '/')
+/// @param[in] slotSize maximum size of a serialised chunk in bytes
+/// @param[in] nSlots number of chunks buffered in the segment
+/// @param[in] maxConsumers maximum number of consumers attached at the same time
+SharedMemoryChunkPublisher::SharedMemoryChunkPublisher(const std::string &name, size_t slotSize, 
+                 size_t nSlots, size_t maxConsumers) : itsRing(name, nSlots, slotSize, maxConsumers) {}
+
+/// @brief finish the stream and remove the segment
+/// @details Consumers which are still attached receive all chunks published so far
+SharedMemoryChunkPublisher::~SharedMemoryChunkPublisher()
+{
+  finish();
+}
+
+/// @brief wait until the given number of consumers attach
+/// @param[in] nConsumers number of consumers to wait for
+void SharedMemoryChunkPublisher::waitForConsumers(size_t nConsumers)
+{
+  ASKAPCHECK(nConsumers <= itsRing.header().itsMaxConsumers, "Unable to wait for "<<nConsumers<<
+             " consumers, the segment supports only "<<itsRing.header().itsMaxConsumers);
+  SharedMemoryRing::ScopedLock lock(itsRing);
+  while (itsRing.nConsumers() < nConsumers) {
+         lock.wait();
+  }
+}
+
+/// @brief number of attached consumers
+/// @return number of consumers currently attached to the segment
+size_t SharedMemoryChunkPublisher::nConsumers()
+{
+  SharedMemoryRing::ScopedLock lock(itsRing);
+  return itsRing.nConsumers();
+}
+
+/// @brief publish one chunk
+/// @details This method blocks while the slowest consumer is too far behind
+/// @param[in] acc accessor to serialise and publish
+void SharedMemoryChunkPublisher::publish(const IConstDataAccessor &acc)
+{
+  itsBuffer.resize(0);
+  LOFAR::BlobOBufString bob(itsBuffer);
+  LOFAR::BlobOStream out(bob);
+  CachedDataAccessor::serialise(acc, out);
+  publish(itsBuffer);
+}
+
+/// @brief publish one message
+/// @param[in] buf serialised chunk
+void SharedMemoryChunkPublisher::publish(const LOFAR::BlobString &buf)
+{
+  SharedMemoryRing::Header &header = itsRing.header();
+  if (buf.size() > header.itsSlotSize) {
+      ASKAPTHROW(DataAccessError, "Serialised chunk of "<<buf.size()<<" bytes doesn't fit into the shared memory slot of "<<
+                 header.itsSlotSize<<" bytes");
+  }
+  size_t slot = 0;
+  {
+    SharedMemoryRing::ScopedLock lock(itsRing);
+    ASKAPCHECK(!header.itsFinished, "SharedMemoryChunkPublisher::publish is called after finish");
+    while (itsRing.nFreeSlots() == 0) {
+           lock.wait();
+    }
+    slot = size_t(header.itsWritten % header.itsNSlots);
+  }
+  // nobody reads this slot until the message counter is incremented
+  itsRing.messageSize(slot) = buf.size();
+  std::memcpy(itsRing.messageData(slot), buf.data(), buf.size());
+  SharedMemoryRing::ScopedLock lock(itsRing);
+  ++header.itsWritten;
+  lock.notifyAll();
+}
+
+/// @brief mark the end of the stream
+/// @details Consumers get the end of the stream after reading all published chunks
+void SharedMemoryChunkPublisher::finish()
+{
+  SharedMemoryRing::ScopedLock lock(itsRing);
+  itsRing.header().itsFinished = 1;
+  lock.notifyAll();
+}
+
+} // namespace accessors
+
+} // namespace askap
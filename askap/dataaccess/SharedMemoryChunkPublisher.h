@@ -0,0 +1,107 @@
+/// @file
+/// @brief publisher of chunks via shared memory
+/// @details This class allows one process to read the data (e.g. from a measurement set)
+/// and share the chunks with a number of processes on the same node, which receive them
+/// via SharedMemoryChunkReceiver and StreamDataSource. This way the disk is read once per
+/// node rather than once per process.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SHARED_MEMORY_CHUNK_PUBLISHER_H
+#define ASKAP_ACCESSORS_SHARED_MEMORY_CHUNK_PUBLISHER_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/utility.hpp>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/SharedMemoryRing.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief publisher of chunks via shared memory
+/// @details The shared memory segment is created by the constructor and removed by the
+/// destructor. Chunks are serialised with CachedDataAccessor::serialise, each chunk should
+/// fit into a slot. The publisher waits if the slowest consumer is nSlots messages behind,
+/// so consumers don't miss any chunks published after they attached. Chunks published while
+/// no consumer is attached are lost, use waitForConsumers to synchronise the start.
+/// @note A consumer process which dies without detaching blocks the publisher.
+/// @ingroup dataaccess_hlp
+class SharedMemoryChunkPublisher : private boost::noncopyable {
+public:
+  /// @brief create the shared memory segment
+  /// @param[in] name name of the shared memory segment (should start with '/')
+  /// @param[in] slotSize maximum size of a serialised chunk in bytes
+  /// @param[in] nSlots number of chunks buffered in the segment
+  /// @param[in] maxConsumers maximum number of consumers attached at the same time
+  SharedMemoryChunkPublisher(const std::string &name, size_t slotSize, size_t nSlots = 8,
+                             size_t maxConsumers = 16);
+
+  /// @brief finish the stream and remove the segment
+  /// @details Consumers which are still attached receive all chunks published so far
+  ~SharedMemoryChunkPublisher();
+
+  /// @brief wait until the given number of consumers attach
+  /// @param[in] nConsumers number of consumers to wait for
+  void waitForConsumers(size_t nConsumers);
+
+  /// @brief number of attached consumers
+  /// @return number of consumers currently attached to the segment
+  size_t nConsumers();
+
+  /// @brief publish one chunk
+  /// @details This method blocks while the slowest consumer is too far behind
+  /// @param[in] acc accessor to serialise and publish
+  void publish(const IConstDataAccessor &acc);
+
+  /// @brief publish one message
+  /// @param[in] buf serialised chunk
+  void publish(const LOFAR::BlobString &buf);
+
+  /// @brief mark the end of the stream
+  /// @details Consumers get the end of the stream after reading all published chunks
+  void finish();
+
+private:
+  /// @brief shared memory segment
+  SharedMemoryRing itsRing;
+
+  /// @brief buffer for serialisation
+  LOFAR::BlobString itsBuffer;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SHARED_MEMORY_CHUNK_PUBLISHER_H
@@ -0,0 +1,109 @@
+/// @file
+/// @brief receiver of chunks published via shared memory
+/// @details This class implements IChunkReceiver for the shared memory ring buffer filled
+/// by SharedMemoryChunkPublisher. Used with StreamDataSource, it gives a data source 
+/// delivering chunks read by another process on the same node.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/SharedMemoryChunkReceiver.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <cstring>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief attach to the segment
+/// @param[in] name name of the shared memory segment created by the publisher
+SharedMemoryChunkReceiver::SharedMemoryChunkReceiver(const std::string &name) : itsRing(name),
+        itsIndex(0), itsInterrupted(false)
+{
+  SharedMemoryRing::ScopedLock lock(itsRing);
+  SharedMemoryRing::Header &header = itsRing.header();
+  for (; itsIndex < header.itsMaxConsumers; ++itsIndex) {
+       SharedMemoryRing::Consumer &entry = itsRing.consumer(itsIndex);
+       if (!entry.itsActive) {
+           entry.itsActive = 1;
+           entry.itsRead = header.itsWritten;
+           lock.notifyAll();
+           return;
+       }
+  }
+  ASKAPTHROW(DataAccessError, "Shared memory segment "<<name<<" already has the maximum number of consumers ("<<
+             header.itsMaxConsumers<<") attached");
+}
+
+/// @brief detach from the segment
+SharedMemoryChunkReceiver::~SharedMemoryChunkReceiver()
+{
+  SharedMemoryRing::ScopedLock lock(itsRing);
+  itsRing.consumer(itsIndex).itsActive = 0;
+  lock.notifyAll();
+}
+
+/// @brief receive the next message
+/// @details This method blocks until a message is published or the stream ends.
+/// @param[out] buf buffer to fill with the message
+/// @return true if a message has been received, false at the end of the stream
+bool SharedMemoryChunkReceiver::receive(LOFAR::BlobString &buf)
+{
+  SharedMemoryRing::Header &header = itsRing.header();
+  SharedMemoryRing::Consumer &entry = itsRing.consumer(itsIndex);
+  size_t slot = 0;
+  {
+    SharedMemoryRing::ScopedLock lock(itsRing);
+    while ((entry.itsRead == header.itsWritten) && !header.itsFinished && !itsInterrupted) {
+           lock.wait();
+    }
+    if (itsInterrupted || (entry.itsRead == header.itsWritten)) {
+        return false;
+    }
+    slot = size_t(entry.itsRead % header.itsNSlots);
+  }
+  // the publisher doesn't touch this slot until the read counter is incremented
+  const size_t size = size_t(itsRing.messageSize(slot));
+  buf.resize(size);
+  std::memcpy(buf.data(), itsRing.messageData(slot), size);
+  SharedMemoryRing::ScopedLock lock(itsRing);
+  ++entry.itsRead;
+  lock.notifyAll();
+  return true;
+}
+
+/// @brief unblock the receiving thread
+void SharedMemoryChunkReceiver::interrupt()
+{
+  itsInterrupted = true;
+  SharedMemoryRing::ScopedLock lock(itsRing);
+  lock.notifyAll();
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,89 @@
+/// @file
+/// @brief receiver of chunks published via shared memory
+/// @details This class implements IChunkReceiver for the shared memory ring buffer filled
+/// by SharedMemoryChunkPublisher. Used with StreamDataSource, it gives a data source 
+/// delivering chunks read by another process on the same node.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SHARED_MEMORY_CHUNK_RECEIVER_H
+#define ASKAP_ACCESSORS_SHARED_MEMORY_CHUNK_RECEIVER_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/IChunkReceiver.h>
+#include <askap/dataaccess/SharedMemoryRing.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief receiver of chunks published via shared memory
+/// @details The receiver registers itself as a consumer at construction and gets all
+/// chunks published afterwards. The data are copied out of the segment, so the publisher
+/// can reuse the slot as soon as all consumers have read it. The segment is mapped writable
+/// because the consumer table is shared, the published data are never modified.
+/// @ingroup dataaccess_hlp
+class SharedMemoryChunkReceiver : virtual public IChunkReceiver,
+                                  private boost::noncopyable
+{
+public:
+  /// @brief attach to the segment
+  /// @param[in] name name of the shared memory segment created by the publisher
+  explicit SharedMemoryChunkReceiver(const std::string &name);
+
+  /// @brief detach from the segment
+  virtual ~SharedMemoryChunkReceiver();
+
+  /// @brief receive the next message
+  /// @details This method blocks until a message is published or the stream ends.
+  /// @param[out] buf buffer to fill with the message
+  /// @return true if a message has been received, false at the end of the stream
+  virtual bool receive(LOFAR::BlobString &buf);
+
+  /// @brief unblock the receiving thread
+  virtual void interrupt();
+
+private:
+  /// @brief shared memory segment
+  SharedMemoryRing itsRing;
+
+  /// @brief index of this consumer in the consumer table
+  size_t itsIndex;
+
+  /// @brief true, if interrupt has been called
+  volatile bool itsInterrupted;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SHARED_MEMORY_CHUNK_RECEIVER_H
@@ -0,0 +1,274 @@
+/// @file
+/// @brief ring buffer of serialised chunks in POSIX shared memory
+/// @details This class manages the shared memory segment used to pass chunks from
+/// a single publisher process to a number of consumer processes on the same node. It
+/// is a low-level helper for SharedMemoryChunkPublisher and SharedMemoryChunkReceiver.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/SharedMemoryRing.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// system includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// std includes
+#include <cerrno>
+#include <cstring>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief magic number identifying the layout of the segment
+const LOFAR::uint64 theirMagic = 0x41534b4150524e47ull;
+
+/// @brief round the size up to the multiple of 8 bytes
+/// @param[in] size size in bytes
+/// @return aligned size
+inline size_t align8(size_t size) { return (size + 7) & ~size_t(7); }
+
+} // anonymous namespace
+
+/// @brief lock the mutex
+/// @param[in] ring ring buffer to lock
+SharedMemoryRing::ScopedLock::ScopedLock(SharedMemoryRing &ring) : itsHeader(ring.header())
+{
+  const int status = pthread_mutex_lock(&itsHeader.itsMutex);
+  ASKAPCHECK(status == 0, "Unable to lock the shared memory ring: "<<std::strerror(status));
+}
+
+/// @brief unlock the mutex
+SharedMemoryRing::ScopedLock::~ScopedLock()
+{
+  pthread_mutex_unlock(&itsHeader.itsMutex);
+}
+
+/// @brief wait for a change of the state
+/// @details The mutex is released while waiting
+void SharedMemoryRing::ScopedLock::wait()
+{
+  pthread_cond_wait(&itsHeader.itsChanged, &itsHeader.itsMutex);
+}
+
+/// @brief notify all processes waiting for a change of the state
+void SharedMemoryRing::ScopedLock::notifyAll()
+{
+  pthread_cond_broadcast(&itsHeader.itsChanged);
+}
+
+/// @brief create a new segment
+/// @details An exception is thrown if the segment with this name already exists. The
+/// segment is removed from the system when this object is destroyed.
+/// @param[in] name name of the shared memory segment (should start with '/')
+/// @param[in] nSlots number of slots
+/// @param[in] slotSize maximum size of a message in bytes
+/// @param[in] maxConsumers maximum number of consumers attached at the same time
+SharedMemoryRing::SharedMemoryRing(const std::string &name, size_t nSlots, size_t slotSize, 
+                                   size_t maxConsumers) : itsName(name), itsOwner(true),
+                                   itsFD(-1), itsSize(0), itsHeader(NULL)
+{
+  ASKAPCHECK(nSlots > 0, "Shared memory ring should have at least one slot");
+  ASKAPCHECK(maxConsumers > 0, "Shared memory ring should allow at least one consumer");
+  itsFD = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (itsFD < 0) {
+      ASKAPTHROW(DataAccessError, "Unable to create shared memory segment "<<name<<": "<<std::strerror(errno));
+  }
+  const size_t size = segmentSize(nSlots, slotSize, maxConsumers);
+  if (ftruncate(itsFD, off_t(size)) != 0) {
+      const int error = errno;
+      close(itsFD);
+      shm_unlink(name.c_str());
+      ASKAPTHROW(DataAccessError, "Unable to allocate "<<size<<" bytes of shared memory for "<<name<<": "<<
+                 std::strerror(error));
+  }
+  try {
+     map(size);
+  }
+  catch (...) {
+     close(itsFD);
+     shm_unlink(name.c_str());
+     throw;
+  }
+  // the new segment is filled with zeros, so the consumer table is empty
+  itsHeader->itsNSlots = nSlots;
+  itsHeader->itsSlotSize = slotSize;
+  itsHeader->itsMaxConsumers = maxConsumers;
+  itsHeader->itsWritten = 0;
+  itsHeader->itsFinished = 0;
+  pthread_mutexattr_t mutexAttr;
+  pthread_mutexattr_init(&mutexAttr);
+  pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+  pthread_mutex_init(&itsHeader->itsMutex, &mutexAttr);
+  pthread_mutexattr_destroy(&mutexAttr);
+  pthread_condattr_t condAttr;
+  pthread_condattr_init(&condAttr);
+  pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+  pthread_cond_init(&itsHeader->itsChanged, &condAttr);
+  pthread_condattr_destroy(&condAttr);
+  // consumers check the magic number, so it is set last
+  __sync_synchronize();
+  itsHeader->itsMagic = theirMagic;
+}
+
+/// @brief attach to an existing segment
+/// @param[in] name name of the shared memory segment
+SharedMemoryRing::SharedMemoryRing(const std::string &name) : itsName(name), itsOwner(false),
+                                   itsFD(-1), itsSize(0), itsHeader(NULL)
+{
+  itsFD = shm_open(name.c_str(), O_RDWR, 0);
+  if (itsFD < 0) {
+      ASKAPTHROW(DataAccessError, "Unable to open shared memory segment "<<name<<": "<<std::strerror(errno));
+  }
+  struct stat info;
+  if ((fstat(itsFD, &info) != 0) || (size_t(info.st_size) < sizeof(Header))) {
+      close(itsFD);
+      ASKAPTHROW(DataAccessError, "Shared memory segment "<<name<<" is not initialised");
+  }
+  try {
+     map(size_t(info.st_size));
+     __sync_synchronize();
+     if (itsHeader->itsMagic != theirMagic) {
+         ASKAPTHROW(DataAccessError, "Shared memory segment "<<name<<" is not a chunk ring buffer or is not initialised yet");
+     }
+     const size_t expected = segmentSize(itsHeader->itsNSlots, itsHeader->itsSlotSize, itsHeader->itsMaxConsumers);
+     if (expected != itsSize) {
+         ASKAPTHROW(DataAccessError, "Shared memory segment "<<name<<" has size "<<itsSize<<", "<<expected<<
+                    " is expected from its header");
+     }
+  }
+  catch (...) {
+     if (itsHeader != NULL) {
+         munmap(itsHeader, itsSize);
+     }
+     close(itsFD);
+     throw;
+  }
+}
+
+/// @brief unmap the segment (and remove it, if it has been created by this object)
+SharedMemoryRing::~SharedMemoryRing()
+{
+  munmap(itsHeader, itsSize);
+  close(itsFD);
+  if (itsOwner) {
+      // processes still attached keep their mapping
+      shm_unlink(itsName.c_str());
+  }
+}
+
+/// @brief map the segment into memory
+/// @param[in] size size of the segment in bytes
+void SharedMemoryRing::map(size_t size)
+{
+  void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, itsFD, 0);
+  if (ptr == MAP_FAILED) {
+      ASKAPTHROW(DataAccessError, "Unable to map shared memory segment "<<itsName<<": "<<std::strerror(errno));
+  }
+  itsHeader = static_cast<Header*>(ptr);
+  itsSize = size;
+}
+
+/// @brief total size of the segment for the given geometry
+/// @param[in] nSlots number of slots
+/// @param[in] slotSize maximum size of a message in bytes
+/// @param[in] maxConsumers maximum number of consumers
+/// @return size in bytes
+size_t SharedMemoryRing::segmentSize(size_t nSlots, size_t slotSize, size_t maxConsumers)
+{
+  return align8(sizeof(Header)) + align8(maxConsumers * sizeof(Consumer)) + 
+         nSlots * (sizeof(LOFAR::uint64) + align8(slotSize));
+}
+
+/// @brief access to the consumer table
+/// @param[in] index index of the consumer
+/// @return reference to the consumer entry
+SharedMemoryRing::Consumer& SharedMemoryRing::consumer(size_t index)
+{
+  ASKAPDEBUGASSERT(index < itsHeader->itsMaxConsumers);
+  char *start = reinterpret_cast<char*>(itsHeader) + align8(sizeof(Header));
+  return reinterpret_cast<Consumer*>(start)[index];
+}
+
+/// @brief size of the message held by the given slot
+/// @param[in] slot slot index
+/// @return reference to the size
+LOFAR::uint64& SharedMemoryRing::messageSize(size_t slot)
+{
+  ASKAPDEBUGASSERT(slot < itsHeader->itsNSlots);
+  char *start = reinterpret_cast<char*>(itsHeader) + align8(sizeof(Header)) + 
+                align8(itsHeader->itsMaxConsumers * sizeof(Consumer)) + 
+                slot * (sizeof(LOFAR::uint64) + align8(itsHeader->itsSlotSize));
+  return *reinterpret_cast<LOFAR::uint64*>(start);
+}
+
+/// @brief data of the message held by the given slot
+/// @param[in] slot slot index
+/// @return pointer to the message data
+char* SharedMemoryRing::messageData(size_t slot)
+{
+  return reinterpret_cast<char*>(&messageSize(slot)) + sizeof(LOFAR::uint64);
+}
+
+/// @brief number of messages the publisher can write without waiting
+/// @details This is the number of slots which have been read by all active consumers.
+/// The mutex should be locked by the caller.
+/// @return number of free slots
+size_t SharedMemoryRing::nFreeSlots()
+{
+  LOFAR::uint64 oldest = itsHeader->itsWritten;
+  for (size_t index = 0; index < itsHeader->itsMaxConsumers; ++index) {
+       const Consumer &entry = consumer(index);
+       if (entry.itsActive && (entry.itsRead < oldest)) {
+           oldest = entry.itsRead;
+       }
+  }
+  ASKAPDEBUGASSERT(itsHeader->itsWritten - oldest <= itsHeader->itsNSlots);
+  return size_t(itsHeader->itsNSlots - (itsHeader->itsWritten - oldest));
+}
+
+/// @brief number of active consumers
+/// @details The mutex should be locked by the caller.
+/// @return number of active entries in the consumer table
+size_t SharedMemoryRing::nConsumers()
+{
+  size_t result = 0;
+  for (size_t index = 0; index < itsHeader->itsMaxConsumers; ++index) {
+       if (consumer(index).itsActive) {
+           ++result;
+       }
+  }
+  return result;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,190 @@
+/// @file
+/// @brief ring buffer of serialised chunks in POSIX shared memory
+/// @details This class manages the shared memory segment used to pass chunks from
+/// a single publisher process to a number of consumer processes on the same node. It
+/// is a low-level helper for SharedMemoryChunkPublisher and SharedMemoryChunkReceiver.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SHARED_MEMORY_RING_H
+#define ASKAP_ACCESSORS_SHARED_MEMORY_RING_H
+
+// std includes
+#include <string>
+
+// system includes
+#include <pthread.h>
+
+// boost includes
+#include <boost/utility.hpp>
+
+// LOFAR includes
+#include <Common/LofarTypes.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief ring buffer of serialised chunks in POSIX shared memory
+/// @details The segment starts with a header holding the geometry of the ring, the number
+/// of messages published so far and a process-shared mutex and condition variable. The 
+/// header is followed by the table of consumers (each with the number of messages it has
+/// read) and the slots. Each slot holds one message preceded by its size. The publisher
+/// writes message n into slot n % nSlots and waits until all active consumers have read
+/// the message previously held by this slot. All changes of the state are done with the
+/// mutex locked and are followed by a broadcast of the condition variable, the bulk data 
+/// are copied to or from the slots without holding the lock.
+/// @ingroup dataaccess_hlp
+class SharedMemoryRing : private boost::noncopyable {
+public:
+  /// @brief header of the shared memory segment
+  struct Header {
+     /// @brief magic number to verify the segment layout
+     LOFAR::uint64 itsMagic;
+     /// @brief number of slots
+     LOFAR::uint64 itsNSlots;
+     /// @brief maximum size of a message in bytes
+     LOFAR::uint64 itsSlotSize;
+     /// @brief maximum number of consumers
+     LOFAR::uint64 itsMaxConsumers;
+     /// @brief number of messages published so far
+     LOFAR::uint64 itsWritten;
+     /// @brief non-zero if the publisher has finished the stream
+     LOFAR::int32 itsFinished;
+     /// @brief mutex protecting the state
+     pthread_mutex_t itsMutex;
+     /// @brief condition signalled after any change of the state
+     pthread_cond_t itsChanged;
+  };
+
+  /// @brief entry of the consumer table
+  struct Consumer {
+     /// @brief number of messages read by this consumer
+     LOFAR::uint64 itsRead;
+     /// @brief non-zero if this entry is in use
+     LOFAR::int32 itsActive;
+  };
+
+  /// @brief lock the mutex of the ring for the lifetime of the object
+  class ScopedLock : private boost::noncopyable {
+  public:
+    /// @brief lock the mutex
+    /// @param[in] ring ring buffer to lock
+    explicit ScopedLock(SharedMemoryRing &ring);
+
+    /// @brief unlock the mutex
+    ~ScopedLock();
+
+    /// @brief wait for a change of the state
+    /// @details The mutex is released while waiting
+    void wait();
+
+    /// @brief notify all processes waiting for a change of the state
+    void notifyAll();
+  private:
+    /// @brief header of the locked ring
+    Header &itsHeader;
+  };
+
+  /// @brief create a new segment
+  /// @details An exception is thrown if the segment with this name already exists. The
+  /// segment is removed from the system when this object is destroyed.
+  /// @param[in] name name of the shared memory segment (should start with '/')
+  /// @param[in] nSlots number of slots
+  /// @param[in] slotSize maximum size of a message in bytes
+  /// @param[in] maxConsumers maximum number of consumers attached at the same time
+  SharedMemoryRing(const std::string &name, size_t nSlots, size_t slotSize, size_t maxConsumers);
+
+  /// @brief attach to an existing segment
+  /// @param[in] name name of the shared memory segment
+  explicit SharedMemoryRing(const std::string &name);
+
+  /// @brief unmap the segment (and remove it, if it has been created by this object)
+  ~SharedMemoryRing();
+
+  /// @brief access to the header
+  /// @return reference to the header
+  inline Header& header() { return *itsHeader; }
+
+  /// @brief access to the consumer table
+  /// @param[in] index index of the consumer
+  /// @return reference to the consumer entry
+  Consumer& consumer(size_t index);
+
+  /// @brief size of the message held by the given slot
+  /// @param[in] slot slot index
+  /// @return reference to the size
+  LOFAR::uint64& messageSize(size_t slot);
+
+  /// @brief data of the message held by the given slot
+  /// @param[in] slot slot index
+  /// @return pointer to the message data
+  char* messageData(size_t slot);
+
+  /// @brief number of messages the publisher can write without waiting
+  /// @details This is the number of slots which have been read by all active consumers.
+  /// The mutex should be locked by the caller.
+  /// @return number of free slots
+  size_t nFreeSlots();
+
+  /// @brief number of active consumers
+  /// @details The mutex should be locked by the caller.
+  /// @return number of active entries in the consumer table
+  size_t nConsumers();
+
+protected:
+  /// @brief map the segment into memory
+  /// @param[in] size size of the segment in bytes
+  void map(size_t size);
+
+  /// @brief total size of the segment for the given geometry
+  /// @param[in] nSlots number of slots
+  /// @param[in] slotSize maximum size of a message in bytes
+  /// @param[in] maxConsumers maximum number of consumers
+  /// @return size in bytes
+  static size_t segmentSize(size_t nSlots, size_t slotSize, size_t maxConsumers);
+
+private:
+  /// @brief name of the segment
+  std::string itsName;
+
+  /// @brief true, if the segment has been created by this object
+  bool itsOwner;
+
+  /// @brief file descriptor of the segment
+  int itsFD;
+
+  /// @brief size of the mapped memory in bytes
+  size_t itsSize;
+
+  /// @brief mapped header (start of the segment)
+  Header *itsHeader;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SHARED_MEMORY_RING_H
@@ -0,0 +1,240 @@
+/// @file
+/// @brief single background writer shared by several read-write iterators
+/// @details The table system is not thread-safe, so read-write iterators over
+/// disjoint parts of the same table (see TableDataSource::createPartitionedRWIterators)
+/// can't write to it from their own threads. This class accepts visibility and flag
+/// cubes from any number of threads and writes them to the table in a single
+/// background thread, in the order they have been queued. The cubes are kept in
+/// the storage order (nPol x nChannel x nRow), as for TableChunkWriter.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+
+/// Local package
+#include <askap/dataaccess/SharedTableWriter.h>
+#include <askap/dataaccess/TableChunkWriter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/AccessTracer.h>
+
+// std includes
+#include <exception>
+
+ASKAP_LOGGER(logger, ".SharedTableWriter");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor
+/// @param[in] capacity maximum number of chunks waiting to be written
+SharedTableWriter::SharedTableWriter(size_t capacity) : itsCapacity(capacity), itsBusy(false),
+          itsStop(false)
+{
+  ASKAPCHECK(capacity > 0, "Capacity of the shared writer queue should be positive");
+}
+
+/// @brief destructor, writes all queued chunks
+/// @details Errors are logged, rather than thrown
+SharedTableWriter::~SharedTableWriter()
+{
+  try {
+     sync();
+  }
+  catch (const std::exception &ex) {
+     ASKAPLOG_ERROR_STR(logger, "Deferred write of visibilities or flags failed: "<<ex.what());
+  }
+  if (itsThread) {
+      {
+        boost::lock_guard<boost::mutex> lock(itsMutex);
+        itsStop = true;
+      }
+      itsQueuedCondition.notify_all();
+      itsThread->join();
+  }
+}
+
+/// @brief queue a visibility cube
+/// @param[in] iteration table to write to (current iteration of the table iterator)
+/// @param[in] column name of the column
+/// @param[in] topRow first row of the chunk within the iteration
+/// @param[in] startChan first channel to write
+/// @param[in] cube nPol x nChannel x nRow cube to write, it is referenced, so
+/// the caller should not change it afterwards
+/// @param[in] uniform true, if all cells of the chunk have the same shape 
+void SharedTableWriter::add(const casacore::Table &iteration, const std::string &column,
+           casacore::uInt topRow, casacore::uInt startChan, 
+           const casacore::Cube<casacore::Complex> &cube, bool uniform)
+{
+  Chunk chunk;
+  chunk.itsIteration = iteration;
+  chunk.itsColumn = column;
+  chunk.itsTopRow = topRow;
+  chunk.itsStartChannel = startChan;
+  chunk.itsVis.reference(cube);
+  chunk.itsIsFlag = false;
+  chunk.itsUniform = uniform;
+  push(chunk);
+}
+
+/// @brief queue a flag cube
+/// @param[in] iteration table to write to (current iteration of the table iterator)
+/// @param[in] column name of the column
+/// @param[in] topRow first row of the chunk within the iteration
+/// @param[in] startChan first channel to write
+/// @param[in] cube nPol x nChannel x nRow cube to write, it is referenced, so
+/// the caller should not change it afterwards
+/// @param[in] uniform true, if all cells of the chunk have the same shape 
+void SharedTableWriter::add(const casacore::Table &iteration, const std::string &column,
+           casacore::uInt topRow, casacore::uInt startChan, 
+           const casacore::Cube<casacore::Bool> &cube, bool uniform)
+{
+  Chunk chunk;
+  chunk.itsIteration = iteration;
+  chunk.itsColumn = column;
+  chunk.itsTopRow = topRow;
+  chunk.itsStartChannel = startChan;
+  chunk.itsFlag.reference(cube);
+  chunk.itsIsFlag = true;
+  chunk.itsUniform = uniform;
+  push(chunk);
+}
+
+/// @brief queue a chunk
+/// @details The method waits while the queue is full and starts the background
+/// thread if it is not running yet.
+/// @param[in] chunk chunk to queue
+void SharedTableWriter::push(const Chunk &chunk)
+{
+  {
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    checkError();
+    if (itsQueue.size() >= itsCapacity) {
+        // time the producer is stalled waiting for the disk
+        const AccessTracer::Scope trace("sharedWriterWait", "dataaccess");
+        while (itsQueue.size() >= itsCapacity && itsError.empty()) {
+               itsWrittenCondition.wait(lock);
+        }
+        checkError();
+    }
+    itsQueue.push_back(chunk);
+    if (!itsThread) {
+        itsThread.reset(new boost::thread(&SharedTableWriter::run, this));
+    }
+  }
+  itsQueuedCondition.notify_one();
+}
+
+/// @brief number of chunks waiting to be written
+/// @details The chunk being written by the background thread is not counted
+/// @return number of queued cubes
+size_t SharedTableWriter::nQueued() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsQueue.size();
+}
+
+/// @brief write all queued chunks
+/// @details This is the barrier: all chunks queued by any thread before this call
+/// are in the table when the method returns. An exception is thrown if any write 
+/// has failed.
+void SharedTableWriter::sync()
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  if (!itsQueue.empty() || itsBusy) {
+      const AccessTracer::Scope trace("sharedWriterSync", "dataaccess");
+      while ((!itsQueue.empty() || itsBusy) && itsError.empty()) {
+             itsWrittenCondition.wait(lock);
+      }
+  }
+  checkError();
+}
+
+/// @brief throw an exception if the background thread failed
+/// @details This method should be called with the mutex locked. The error is
+/// not cleared, so every thread sharing the writer gets it.
+void SharedTableWriter::checkError()
+{
+  if (itsError.size()) {
+      ASKAPTHROW(DataAccessError, "Deferred write to the table failed: "<<itsError);
+  }
+}
+
+/// @brief body of the background thread
+/// @details Any exception is caught and the message is kept to be reported
+/// by the threads adding chunks
+void SharedTableWriter::run()
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  while (true) {
+     while (itsQueue.empty() && !itsStop) {
+            itsQueuedCondition.wait(lock);
+     }
+     if (itsQueue.empty()) {
+         // stop is requested and everything has been written
+         break;
+     }
+     // the mutex is released while writing, so other threads can queue new chunks
+     const Chunk chunk = itsQueue.front();
+     itsQueue.pop_front();
+     itsBusy = true;
+     lock.unlock();
+     std::string error;
+     try {
+        const AccessTracer::Scope trace("sharedWrite", chunk.itsColumn, "dataaccess");
+        write(chunk);
+     }
+     catch (const std::exception &ex) {
+        error = ex.what();
+     }
+     lock.lock();
+     itsBusy = false;
+     if (error.size()) {
+         itsError = error;
+         itsQueue.clear();
+     }
+     itsWrittenCondition.notify_all();
+  }
+}
+
+/// @brief write a chunk to the table
+/// @param[in] chunk chunk to write
+void SharedTableWriter::write(const Chunk &chunk)
+{
+  if (chunk.itsIsFlag) {
+      casacore::ArrayColumn<casacore::Bool> col(chunk.itsIteration, chunk.itsColumn);
+      TableChunkWriter::write(col, chunk.itsTopRow, chunk.itsStartChannel, chunk.itsFlag,
+                              chunk.itsUniform);
+  } else {
+      casacore::ArrayColumn<casacore::Complex> col(chunk.itsIteration, chunk.itsColumn);
+      TableChunkWriter::write(col, chunk.itsTopRow, chunk.itsStartChannel, chunk.itsVis,
+                              chunk.itsUniform);
+  }
+}
@@ -0,0 +1,188 @@
+/// @file
+/// @brief single background writer shared by several read-write iterators
+/// @details The table system is not thread-safe, so read-write iterators over
+/// disjoint parts of the same table (see TableDataSource::createPartitionedRWIterators)
+/// can't write to it from their own threads. This class accepts visibility and flag
+/// cubes from any number of threads and writes them to the table in a single
+/// background thread, in the order they have been queued. The cubes are kept in
+/// the storage order (nPol x nChannel x nRow), as for TableChunkWriter.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_SHARED_TABLE_WRITER_H
+#define ASKAP_ACCESSORS_SHARED_TABLE_WRITER_H
+
+// std includes
+#include <deque>
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/tables/Tables/Table.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief single background writer shared by several read-write iterators
+/// @details All methods are thread-safe. The queue is bounded: a thread adding
+/// a chunk waits while the given number of chunks is waiting to be written, so
+/// the producers can't run away from the disk. The background thread is started
+/// with the first chunk and stays idle while the queue is empty. Errors encountered
+/// by the background thread are reported to all threads calling add or sync afterwards
+/// (the first failure stops writing, the rest of the queue is dropped).
+/// @ingroup dataaccess_tab
+class SharedTableWriter : private boost::noncopyable {
+public:
+
+  /// @brief constructor
+  /// @param[in] capacity maximum number of chunks waiting to be written
+  explicit SharedTableWriter(size_t capacity = 16);
+
+  /// @brief destructor, writes all queued chunks
+  /// @details Errors are logged, rather than thrown
+  ~SharedTableWriter();
+
+  /// @brief queue a visibility cube
+  /// @param[in] iteration table to write to (current iteration of the table iterator)
+  /// @param[in] column name of the column
+  /// @param[in] topRow first row of the chunk within the iteration
+  /// @param[in] startChan first channel to write
+  /// @param[in] cube nPol x nChannel x nRow cube to write, it is referenced, so
+  /// the caller should not change it afterwards
+  /// @param[in] uniform true, if all cells of the chunk have the same shape 
+  void add(const casacore::Table &iteration, const std::string &column, casacore::uInt topRow,
+           casacore::uInt startChan, const casacore::Cube<casacore::Complex> &cube, bool uniform);
+
+  /// @brief queue a flag cube
+  /// @param[in] iteration table to write to (current iteration of the table iterator)
+  /// @param[in] column name of the column
+  /// @param[in] topRow first row of the chunk within the iteration
+  /// @param[in] startChan first channel to write
+  /// @param[in] cube nPol x nChannel x nRow cube to write, it is referenced, so
+  /// the caller should not change it afterwards
+  /// @param[in] uniform true, if all cells of the chunk have the same shape 
+  void add(const casacore::Table &iteration, const std::string &column, casacore::uInt topRow,
+           casacore::uInt startChan, const casacore::Cube<casacore::Bool> &cube, bool uniform);
+
+  /// @brief number of chunks waiting to be written
+  /// @details The chunk being written by the background thread is not counted
+  /// @return number of queued cubes
+  size_t nQueued() const;
+
+  /// @brief maximum number of chunks waiting to be written
+  inline size_t capacity() const { return itsCapacity; }
+
+  /// @brief write all queued chunks
+  /// @details This is the barrier: all chunks queued by any thread before this call
+  /// are in the table when the method returns. An exception is thrown if any write 
+  /// has failed.
+  void sync();
+
+protected:
+  /// @brief one queued chunk
+  struct Chunk {
+     /// @brief table to write to
+     casacore::Table itsIteration;
+     /// @brief name of the column
+     std::string itsColumn;
+     /// @brief first row of the chunk
+     casacore::uInt itsTopRow;
+     /// @brief first channel
+     casacore::uInt itsStartChannel;
+     /// @brief visibility cube to write (empty for flags)
+     casacore::Cube<casacore::Complex> itsVis;
+     /// @brief flag cube to write (empty for visibilities)
+     casacore::Cube<casacore::Bool> itsFlag;
+     /// @brief true, if the chunk holds flags
+     bool itsIsFlag;
+     /// @brief true, if all cells have the same shape
+     bool itsUniform;
+  };
+
+  /// @brief queue a chunk
+  /// @details The method waits while the queue is full and starts the background
+  /// thread if it is not running yet.
+  /// @param[in] chunk chunk to queue
+  void push(const Chunk &chunk);
+
+  /// @brief body of the background thread
+  /// @details Any exception is caught and the message is kept to be reported
+  /// by the threads adding chunks
+  void run();
+
+  /// @brief write a chunk to the table
+  /// @param[in] chunk chunk to write
+  static void write(const Chunk &chunk);
+
+  /// @brief throw an exception if the background thread failed
+  /// @details This method should be called with the mutex locked. The error is
+  /// not cleared, so every thread sharing the writer gets it.
+  void checkError();
+
+private:
+  /// @brief maximum number of chunks waiting to be written
+  const size_t itsCapacity;
+
+  /// @brief chunks waiting to be written
+  std::deque<Chunk> itsQueue;
+
+  /// @brief true, while the background thread is writing a chunk
+  bool itsBusy;
+
+  /// @brief true, if the background thread has to finish
+  bool itsStop;
+
+  /// @brief error message of the last failed write, empty if there was no error
+  std::string itsError;
+
+  /// @brief mutex protecting all data members above
+  mutable boost::mutex itsMutex;
+
+  /// @brief condition signalled when a chunk is queued or the thread has to finish
+  boost::condition_variable itsQueuedCondition;
+
+  /// @brief condition signalled when a chunk has been written
+  boost::condition_variable itsWrittenCondition;
+
+  /// @brief background thread, empty if it has not been started yet
+  boost::shared_ptr<boost::thread> itsThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SHARED_TABLE_WRITER_H
@@ -5,7 +5,8 @@
 /// By default the original metadata are returned by the frequency() method.
 /// However, at the first call to rwFrequency, a copy has been created
 /// for the appropriate vector and returned for an optional modification. Then, this
-/// copied cube is returned by the read-only methods.
+/// copied cube is returned by the read-only methods. The adapter also computes
+/// decorrelation factors due to time and bandwidth smearing for a given direction.
 ///
 /// @copyright (c) 2007 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -35,15 +36,49 @@
 #include <askap/dataaccess/SmearingAccessorAdapter.h>
 #include <askap/askap/AskapError.h>
 
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <cmath>
+#include <vector>
+
 namespace askap {
 
 namespace accessors {
 
+namespace {
+
+/// @brief sin(x)/x without a branch
+/// @details The form allows the compiler to vectorise the loops calling it
+/// @param[in] x argument
+/// @return sin(x)/x, or 1 for zero argument
+inline double sinc(double x)
+{
+  const double zero = (x == 0.);
+  return (std::sin(x) + zero) / (x + zero);
+}
+
+/// @brief check that two uvw vectors are exactly the same
+/// @param[in] uvw1 first vector
+/// @param[in] uvw2 second vector
+/// @return true if all components are equal
+inline bool sameUVW(const casacore::RigidVector<casacore::Double, 3> &uvw1,
+                    const casacore::RigidVector<casacore::Double, 3> &uvw2)
+{
+  return (uvw1(0) == uvw2(0)) && (uvw1(1) == uvw2(1)) && (uvw1(2) == uvw2(2));
+}
+
+} // anonymous namespace
+
+/// @brief maximum time difference between chunks used to derive the uvw rate (in seconds)
+const casacore::Double SmearingAccessorAdapter::theirMaxRateInterval = 300.;
+
 /// construct an object linked with the given const accessor
 /// @param[in] acc a reference to the associated accessor
 SmearingAccessorAdapter::SmearingAccessorAdapter(const IConstDataAccessor &acc) :
    MetaDataAccessor(acc), MemBufferDataAccessor(acc), OnDemandNoiseAndFlagDA(acc), 
-   itsFrequencySubstituted(false) {}
+   itsFrequencySubstituted(false), itsChunkValid(false), itsChunkTime(0.) {}
 
 /// Frequency for each channel
 /// @return a reference to vector containing frequencies for each
@@ -67,8 +102,11 @@ casacore::Vector<casacore::Double>& SmearingAccessorAdapter::rwFrequency()
 {
   if (!itsFrequencySubstituted) {
       itsFrequencySubstituted = true;
-      itsFrequencyBuffer.assign(getROAccessor().frequency().copy());
+      // assign resizes the buffer and copies the values, an explicit copy would double the work
+      itsFrequencyBuffer.assign(getROAccessor().frequency());
   }
+  // the caller may change the frequencies, the factors have to be recomputed
+  itsDecorrelationCache.clear();
   return itsFrequencyBuffer;  
 }
   
@@ -78,10 +116,167 @@ casacore::Vector<casacore::Double>& SmearingAccessorAdapter::rwFrequency()
 /// (but doesn't copy the data)
 void SmearingAccessorAdapter::useFrequencyBuffer()
 {
-  // this method is supposed to be used with a detached adapter only
-  ASKAPDEBUGASSERT(!itsFrequencySubstituted);
   itsFrequencySubstituted = true;
   itsFrequencyBuffer.resize(getROAccessor().nChannel()); 
+  itsDecorrelationCache.clear();
+}
+
+/// @brief rate of change of uvw
+/// @details The rate is derived from the previous chunk if it has the same rows,
+/// or from the Earth rotation otherwise.
+/// @return a reference to vector with the rate in metres per second for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& SmearingAccessorAdapter::uvwRate() const
+{
+  updateChunk();
+  return itsUVWRate;
+}
+
+/// @brief reset the caches if the chunk has changed
+/// @details The uvw rate is recalculated at the same time
+void SmearingAccessorAdapter::updateChunk() const
+{
+  const IConstDataAccessor &acc = getROAccessor();
+  const casacore::uInt nRow = acc.nRow();
+  const casacore::Double time = acc.time();
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.uvw();
+  // chunks with the same time (e.g. different beams) are told apart by uvw of the end rows
+  if (itsChunkValid && (time == itsChunkTime) && (nRow == itsChunkUVW.nelements()) &&
+      ((nRow == 0) || (sameUVW(uvw[0], itsChunkUVW[0]) && sameUVW(uvw[nRow - 1], itsChunkUVW[nRow - 1])))) {
+      return;
+  }
+  itsDecorrelationCache.clear();
+  const casacore::Vector<casacore::uInt> &antenna1 = acc.antenna1();
+  const casacore::Vector<casacore::uInt> &antenna2 = acc.antenna2();
+  const casacore::Vector<casacore::uInt> &feed1 = acc.feed1();
+  // finite differences are only used if the previous chunk has the same rows
+  const casacore::Double dt = time - itsChunkTime;
+  bool sameRows = itsChunkValid && (nRow == itsChunkUVW.nelements()) && (dt != 0.) &&
+                  (std::abs(dt) <= theirMaxRateInterval);
+  for (casacore::uInt row = 0; sameRows && (row < nRow); ++row) {
+       sameRows = (antenna1[row] == itsChunkAntenna1[row]) && (antenna2[row] == itsChunkAntenna2[row]) &&
+                  (feed1[row] == itsChunkFeed1[row]);
+  }
+  if (sameRows) {
+      itsUVWRate.resize(nRow);
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                itsUVWRate[row](dim) = (uvw[row](dim) - itsChunkUVW[row](dim)) / dt;
+           }
+      }
+  }
+  // keep a copy of this chunk for the next one
+  itsChunkAntenna1.assign(antenna1);
+  itsChunkAntenna2.assign(antenna2);
+  itsChunkFeed1.assign(feed1);
+  itsChunkUVW.assign(uvw);
+  itsChunkTime = time;
+  itsChunkValid = true;
+  if (!sameRows) {
+      earthRotationRate();
+  }
+}
+
+/// @brief derive the uvw rate from the Earth rotation
+/// @details du/dH = w cos(dec) - v sin(dec), dv/dH = u sin(dec) and dw/dH = -u cos(dec),
+/// where H is the hour angle and dec is the declination of the phase centre.
+void SmearingAccessorAdapter::earthRotationRate() const
+{
+  // sidereal rotation rate in radians per second
+  const casacore::Double omega = 7.2921150e-5;
+  const casacore::Vector<casacore::MVDirection> &centres = getROAccessor().pointingDir1();
+  const casacore::uInt nRow = itsChunkUVW.nelements();
+  ASKAPDEBUGASSERT(centres.nelements() == nRow);
+  itsUVWRate.resize(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       const casacore::Double dec = centres[row].getLat();
+       const casacore::Double sinDec = std::sin(dec);
+       const casacore::Double cosDec = std::cos(dec);
+       const casacore::RigidVector<casacore::Double, 3> &uvw = itsChunkUVW[row];
+       itsUVWRate[row](0) = omega * (uvw(2) * cosDec - uvw(1) * sinDec);
+       itsUVWRate[row](1) = omega * uvw(0) * sinDec;
+       itsUVWRate[row](2) = -omega * uvw(0) * cosDec;
+  }
+}
+
+/// @brief decorrelation factors due to time and bandwidth smearing
+/// @details The factor for each row and channel is the product of 
+/// sinc(pi * D * chanWidth / c) (bandwidth smearing) and sinc(pi * dD/dt * freq * intTime / c)
+/// (time smearing), where D = u*l + v*m + w*(n-1) is the delay (in metres) of the source
+/// relative to the phase centre. The returned matrix stays valid until the cache is reset
+/// (i.e. the chunk changes or the frequencies are accessed via rwFrequency or useFrequencyBuffer).
+/// @param[in] dir direction of the source (in the frame of pointingDir1)
+/// @param[in] intTime integration time in seconds
+/// @param[in] chanWidth channel width in Hz, zero means the spacing of the channels
+/// (this requires more than one channel)
+/// @return a reference to nRow x nChannel matrix with the factors
+const casacore::Matrix<casacore::Float>& SmearingAccessorAdapter::decorrelation(const casacore::MVDirection &dir,
+                   casacore::Double intTime, casacore::Double chanWidth) const
+{
+  ASKAPCHECK(intTime >= 0., "Integration time should be non-negative, you have "<<intTime);
+  ASKAPCHECK(chanWidth >= 0., "Channel width should be non-negative, you have "<<chanWidth);
+  ASKAPCHECK((chanWidth > 0.) || (frequency().nelements() != 1),
+             "Channel width can't be derived from the channel spacing for a single channel, give it explicitly");
+  updateChunk();
+  for (std::list<DecorrelationFactors>::const_iterator ci = itsDecorrelationCache.begin();
+       ci != itsDecorrelationCache.end(); ++ci) {
+       if ((ci->itsIntTime == intTime) && (ci->itsChanWidth == chanWidth) && 
+           (ci->itsDirection.separation(dir) < 1e-12)) {
+           return ci->itsFactors;
+       }
+  }
+  if (itsDecorrelationCache.size() >= theirMaxCachedDirections) {
+      itsDecorrelationCache.pop_front();
+  }
+  itsDecorrelationCache.push_back(DecorrelationFactors());
+  DecorrelationFactors &result = itsDecorrelationCache.back();
+  result.itsDirection = dir;
+  result.itsIntTime = intTime;
+  result.itsChanWidth = chanWidth;
+
+  const casacore::uInt nRow = itsChunkUVW.nelements();
+  const casacore::Vector<casacore::Double> &freq = frequency();
+  const casacore::uInt nChan = freq.nelements();
+  // channel widths, either given or taken from the spacing of adjacent channels
+  std::vector<double> widths(nChan, chanWidth);
+  if ((chanWidth == 0.) && (nChan > 1)) {
+      for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+           const casacore::uInt next = chan + 1 < nChan ? chan + 1 : chan;
+           widths[chan] = std::abs(freq[next] - freq[next - 1]);
+      }
+  }
+  // delay and its rate for each row, scaled so only the frequency terms remain for the channel loop
+  const casacore::Vector<casacore::MVDirection> &centres = getROAccessor().pointingDir1();
+  ASKAPDEBUGASSERT(centres.nelements() == nRow);
+  const double srcLong = dir.getLong();
+  const double sinSrcLat = std::sin(dir.getLat());
+  const double cosSrcLat = std::cos(dir.getLat());
+  std::vector<double> bandwidthScale(nRow), timeScale(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       const double dLong = srcLong - centres[row].getLong();
+       const double sinLat = std::sin(centres[row].getLat());
+       const double cosLat = std::cos(centres[row].getLat());
+       const double l = cosSrcLat * std::sin(dLong);
+       const double m = sinSrcLat * cosLat - cosSrcLat * sinLat * std::cos(dLong);
+       const double nMinusOne = sinSrcLat * sinLat + cosSrcLat * cosLat * std::cos(dLong) - 1.;
+       const casacore::RigidVector<casacore::Double, 3> &uvw = itsChunkUVW[row];
+       const casacore::RigidVector<casacore::Double, 3> &rate = itsUVWRate[row];
+       const double delay = uvw(0) * l + uvw(1) * m + uvw(2) * nMinusOne;
+       const double delayRate = rate(0) * l + rate(1) * m + rate(2) * nMinusOne;
+       bandwidthScale[row] = casacore::C::pi * delay / casacore::C::c;
+       timeScale[row] = casacore::C::pi * delayRate * intTime / casacore::C::c;
+  }
+  // plain loop over contiguous rows of each channel, suitable for auto-vectorisation
+  result.itsFactors.resize(nRow, nChan);
+  for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+       casacore::Float *out = result.itsFactors.data() + size_t(chan) * nRow;
+       const double width = widths[chan];
+       const double frequency = freq[chan];
+       for (casacore::uInt row = 0; row < nRow; ++row) {
+            out[row] = static_cast<casacore::Float>(sinc(bandwidthScale[row] * width) *
+                                                    sinc(timeScale[row] * frequency));
+       }
+  }
+  return result.itsFactors;
 }
 
 
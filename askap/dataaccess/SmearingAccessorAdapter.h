@@ -5,7 +5,8 @@
 /// By default the original metadata are returned by the frequency() method.
 /// However, at the first call to rwFrequency, a copy has been created
 /// for the appropriate vector and returned for an optional modification. Then, this
-/// copied cube is returned by the read-only methods.
+/// copied cube is returned by the read-only methods. The adapter also computes
+/// decorrelation factors due to time and bandwidth smearing for a given direction.
 ///
 /// @copyright (c) 2007 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -41,6 +42,12 @@
 
 // casa includes
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// std includes
+#include <list>
 
 namespace askap {
 	
@@ -53,6 +60,13 @@ namespace accessors {
 /// However, at the first call to rwFrequency, a copy has been created
 /// for the appropriate vector and returned for an optional modification. Then, this
 /// copied cube is returned by the read-only methods.
+///
+/// Decorrelation factors are computed for all rows and channels of the chunk at once.
+/// The rate of change of uvw is derived from the previous chunk seen by this adapter if it
+/// has the same rows (the usual case when the adapter is kept across iterations), otherwise
+/// it is calculated from the Earth rotation. The factors are cached per chunk and per
+/// direction, the cache is reset when the time or the number of rows of the chunk changes.
+/// uvw are assumed to refer to pointingDir1 and frequencies are assumed to be in Hz.
 /// @ingroup dataaccess_hlp
 class SmearingAccessorAdapter : virtual public OnDemandNoiseAndFlagDA
 {
@@ -81,15 +95,87 @@ public:
   /// @brief force the adapter to use the buffer
   /// @details This method matches well the intended use case of this adapter. It
   /// just detaches the adapter from the original metadata and resizes the buffer
-  /// (but doesn't copy the data)
+  /// (but doesn't copy the data). The buffer is reused if it has been substituted already.
   void useFrequencyBuffer();
 
+  /// @brief rate of change of uvw
+  /// @details The rate is derived from the previous chunk if it has the same rows,
+  /// or from the Earth rotation otherwise.
+  /// @return a reference to vector with the rate in metres per second for each row
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvwRate() const;
+
+  /// @brief decorrelation factors due to time and bandwidth smearing
+  /// @details The factor for each row and channel is the product of 
+  /// sinc(pi * D * chanWidth / c) (bandwidth smearing) and sinc(pi * dD/dt * freq * intTime / c)
+  /// (time smearing), where D = u*l + v*m + w*(n-1) is the delay (in metres) of the source
+  /// relative to the phase centre. The returned matrix stays valid until the cache is reset
+  /// (i.e. the chunk changes or the frequencies are accessed via rwFrequency or useFrequencyBuffer).
+  /// @param[in] dir direction of the source (in the frame of pointingDir1)
+  /// @param[in] intTime integration time in seconds
+  /// @param[in] chanWidth channel width in Hz, zero means the spacing of the channels
+  /// (this requires more than one channel)
+  /// @return a reference to nRow x nChannel matrix with the factors
+  const casacore::Matrix<casacore::Float>& decorrelation(const casacore::MVDirection &dir, 
+                                  casacore::Double intTime, casacore::Double chanWidth = 0.) const;
+
+  /// @brief maximum number of directions cached per chunk
+  static const size_t theirMaxCachedDirections = 16;
+
+  /// @brief maximum time difference between chunks used to derive the uvw rate (in seconds)
+  static const casacore::Double theirMaxRateInterval;
+
+protected:
+  /// @brief reset the caches if the chunk has changed
+  /// @details The uvw rate is recalculated at the same time
+  void updateChunk() const;
+
+  /// @brief derive the uvw rate from the Earth rotation
+  /// @details du/dH = w cos(dec) - v sin(dec), dv/dH = u sin(dec) and dw/dH = -u cos(dec),
+  /// where H is the hour angle and dec is the declination of the phase centre.
+  void earthRotationRate() const;
+
 private:  
+  /// @brief cached decorrelation factors for one direction
+  struct DecorrelationFactors {
+     /// @brief direction of the source
+     casacore::MVDirection itsDirection;
+     /// @brief integration time
+     casacore::Double itsIntTime;
+     /// @brief channel width
+     casacore::Double itsChanWidth;
+     /// @brief factors (nRow x nChannel)
+     casacore::Matrix<casacore::Float> itsFactors;
+  };
+
   /// @brief if true, the frequency buffer is to be used instead of the original metadata
   bool itsFrequencySubstituted;
   
   /// @brief buffer for noise (used if itsNoiseSubstituted is true)
   casacore::Vector<casacore::Double> itsFrequencyBuffer;  
+
+  /// @brief true, if the chunk cache has been initialised
+  mutable bool itsChunkValid;
+
+  /// @brief time of the cached chunk
+  mutable casacore::Double itsChunkTime;
+
+  /// @brief first antenna indices of the cached chunk
+  mutable casacore::Vector<casacore::uInt> itsChunkAntenna1;
+
+  /// @brief second antenna indices of the cached chunk
+  mutable casacore::Vector<casacore::uInt> itsChunkAntenna2;
+
+  /// @brief first feed indices of the cached chunk
+  mutable casacore::Vector<casacore::uInt> itsChunkFeed1;
+
+  /// @brief uvw of the cached chunk
+  mutable casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsChunkUVW;
+
+  /// @brief uvw rate for the cached chunk
+  mutable casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVWRate;
+
+  /// @brief decorrelation factors cached for the current chunk
+  mutable std::list<DecorrelationFactors> itsDecorrelationCache;
 };
 
 } // namespace accessors
@@ -0,0 +1,159 @@
+/// @file
+/// @brief receiver of serialised chunks over a socket
+/// @details This class implements IChunkReceiver for a stream socket (or a pipe).
+/// Each message is preceded by its size in bytes (64-bit unsigned integer in the native
+/// byte order). SocketChunkSender implements the sending side.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/SocketChunkReceiver.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// system includes
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <unistd.h>
+
+// std includes
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the receiver for an open file descriptor
+/// @param[in] fd file descriptor of a connected stream socket or a pipe
+SocketChunkReceiver::SocketChunkReceiver(int fd) : itsFD(fd), itsInterrupted(false)
+{
+  ASKAPCHECK(fd >= 0, "SocketChunkReceiver requires a valid file descriptor, you have "<<fd);
+}
+
+/// @brief close the file descriptor
+SocketChunkReceiver::~SocketChunkReceiver()
+{
+  ::close(itsFD);
+}
+
+/// @brief connect to the given host and port
+/// @param[in] host host name or address
+/// @param[in] port TCP port
+/// @return shared pointer to the receiver
+boost::shared_ptr<SocketChunkReceiver> SocketChunkReceiver::connect(const std::string &host, int port)
+{
+  return boost::shared_ptr<SocketChunkReceiver>(new SocketChunkReceiver(openConnection(host, port)));
+}
+
+/// @brief open a TCP connection
+/// @details This helper is shared with SocketChunkSender
+/// @param[in] host host name or address
+/// @param[in] port TCP port
+/// @return file descriptor of the connected socket
+int SocketChunkReceiver::openConnection(const std::string &host, int port)
+{
+  struct addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  std::ostringstream os;
+  os << port;
+  struct addrinfo *addresses = NULL;
+  const int status = ::getaddrinfo(host.c_str(), os.str().c_str(), &hints, &addresses);
+  ASKAPCHECK(status == 0, "Unable to resolve "<<host<<": "<<::gai_strerror(status));
+  int fd = -1;
+  for (struct addrinfo *addr = addresses; addr != NULL; addr = addr->ai_next) {
+       fd = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+       if (fd < 0) {
+           continue;
+       }
+       if (::connect(fd, addr->ai_addr, addr->ai_addrlen) == 0) {
+           break;
+       }
+       ::close(fd);
+       fd = -1;
+  }
+  ::freeaddrinfo(addresses);
+  if (fd < 0) {
+      ASKAPTHROW(DataAccessError, "Unable to connect to "<<host<<":"<<port);
+  }
+  return fd;
+}
+
+/// @brief receive the next message
+/// @details This method blocks until a message is available or the stream ends.
+/// @param[out] buf buffer to fill with the message
+/// @return true if a message has been received, false at the end of the stream
+bool SocketChunkReceiver::receive(LOFAR::BlobString &buf)
+{
+  LOFAR::uint64 size = 0;
+  if (!readFully(reinterpret_cast<char*>(&size), sizeof(size), true)) {
+      return false;
+  }
+  buf.resize(size);
+  // false can only be returned here if the receiver has been interrupted
+  return readFully(static_cast<char*>(static_cast<void*>(buf.data())), size, false);
+}
+
+/// @brief unblock the receiving thread
+/// @details The socket is shut down, so the pending read returns.
+void SocketChunkReceiver::interrupt()
+{
+  itsInterrupted = true;
+  // this fails harmlessly for pipes, the writing side has to be closed then
+  ::shutdown(itsFD, SHUT_RDWR);
+}
+
+/// @brief read exactly the given number of bytes
+/// @param[in] ptr buffer to fill
+/// @param[in] size number of bytes to read
+/// @param[in] eofAllowed if true, the end of the stream before the first byte is not an error
+/// @return true if all bytes have been read, false at the end of the stream
+bool SocketChunkReceiver::readFully(char *ptr, size_t size, bool eofAllowed)
+{
+  for (size_t done = 0; done < size;) {
+       const ssize_t result = ::read(itsFD, ptr + done, size - done);
+       if (result < 0) {
+           if ((errno == EINTR) && !itsInterrupted) {
+               continue;
+           }
+           ASKAPTHROW(DataAccessError, "Error reading data stream: "<<std::strerror(errno));
+       }
+       if (result == 0) {
+           if (itsInterrupted || (eofAllowed && (done == 0))) {
+               return false;
+           }
+           ASKAPTHROW(DataAccessError, "Data stream has been closed in the middle of a message");
+       }
+       done += size_t(result);
+  }
+  return true;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,107 @@
+/// @file
+/// @brief receiver of serialised chunks over a socket
+/// @details This class implements IChunkReceiver for a stream socket (or a pipe).
+/// Each message is preceded by its size in bytes (64-bit unsigned integer in the native
+/// byte order). SocketChunkSender implements the sending side.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SOCKET_CHUNK_RECEIVER_H
+#define ASKAP_ACCESSORS_SOCKET_CHUNK_RECEIVER_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/IChunkReceiver.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief receiver of serialised chunks over a socket
+/// @details The file descriptor is owned by this object and closed in the destructor.
+/// The end of the stream is signalled by the sender closing the connection between
+/// messages, a connection closed in the middle of a message is reported as an error.
+/// @ingroup dataaccess_hlp
+class SocketChunkReceiver : virtual public IChunkReceiver,
+                            private boost::noncopyable
+{
+public:
+  /// @brief construct the receiver for an open file descriptor
+  /// @param[in] fd file descriptor of a connected stream socket or a pipe
+  explicit SocketChunkReceiver(int fd);
+
+  /// @brief close the file descriptor
+  virtual ~SocketChunkReceiver();
+
+  /// @brief connect to the given host and port
+  /// @param[in] host host name or address
+  /// @param[in] port TCP port
+  /// @return shared pointer to the receiver
+  static boost::shared_ptr<SocketChunkReceiver> connect(const std::string &host, int port);
+
+  /// @brief open a TCP connection
+  /// @details This helper is shared with SocketChunkSender
+  /// @param[in] host host name or address
+  /// @param[in] port TCP port
+  /// @return file descriptor of the connected socket
+  static int openConnection(const std::string &host, int port);
+
+  /// @brief receive the next message
+  /// @details This method blocks until a message is available or the stream ends.
+  /// @param[out] buf buffer to fill with the message
+  /// @return true if a message has been received, false at the end of the stream
+  virtual bool receive(LOFAR::BlobString &buf);
+
+  /// @brief unblock the receiving thread
+  /// @details The socket is shut down, so the pending read returns.
+  virtual void interrupt();
+
+protected:
+  /// @brief read exactly the given number of bytes
+  /// @param[in] ptr buffer to fill
+  /// @param[in] size number of bytes to read
+  /// @param[in] eofAllowed if true, the end of the stream before the first byte is not an error
+  /// @return true if all bytes have been read, false at the end of the stream
+  bool readFully(char *ptr, size_t size, bool eofAllowed);
+
+private:
+  /// @brief file descriptor
+  int itsFD;
+
+  /// @brief true, if interrupt has been called
+  volatile bool itsInterrupted;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SOCKET_CHUNK_RECEIVER_H
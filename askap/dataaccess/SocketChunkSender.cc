@@ -0,0 +1,137 @@
+/// @file
+/// @brief sender of serialised chunks over a socket
+/// @details This class is the counterpart of SocketChunkReceiver. It serialises
+/// accessors with CachedDataAccessor::serialise and writes them to a stream socket
+/// (or a pipe) preceded by the message size. It can be used to feed a streaming data
+/// source from another process or, in tests, from a measurement set.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/SocketChunkSender.h>
+#include <askap/dataaccess/SocketChunkReceiver.h>
+#include <askap/dataaccess/CachedDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// LOFAR includes
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobOStream.h>
+
+// system includes
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// std includes
+#include <cerrno>
+#include <cstring>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the sender for an open file descriptor
+/// @param[in] fd file descriptor of a connected stream socket or a pipe
+SocketChunkSender::SocketChunkSender(int fd) : itsFD(fd)
+{
+  ASKAPCHECK(fd >= 0, "SocketChunkSender requires a valid file descriptor, you have "<<fd);
+}
+
+/// @brief close the file descriptor
+SocketChunkSender::~SocketChunkSender()
+{
+  close();
+}
+
+/// @brief connect to the given host and port
+/// @param[in] host host name or address
+/// @param[in] port TCP port
+/// @return shared pointer to the sender
+boost::shared_ptr<SocketChunkSender> SocketChunkSender::connect(const std::string &host, int port)
+{
+  return boost::shared_ptr<SocketChunkSender>(new SocketChunkSender(
+                SocketChunkReceiver::openConnection(host, port)));
+}
+
+/// @brief send one chunk
+/// @param[in] acc accessor to serialise and send
+void SocketChunkSender::send(const IConstDataAccessor &acc)
+{
+  itsBuffer.resize(0);
+  LOFAR::BlobOBufString bob(itsBuffer);
+  LOFAR::BlobOStream out(bob);
+  CachedDataAccessor::serialise(acc, out);
+  send(itsBuffer);
+}
+
+/// @brief send one message
+/// @param[in] buf serialised chunk
+void SocketChunkSender::send(const LOFAR::BlobString &buf)
+{
+  ASKAPCHECK(itsFD >= 0, "SocketChunkSender::send is called after close");
+  const LOFAR::uint64 size = buf.size();
+  writeFully(reinterpret_cast<const char*>(&size), sizeof(size));
+  writeFully(static_cast<const char*>(static_cast<const void*>(buf.data())), size);
+}
+
+/// @brief close the connection
+/// @details This signals the end of the stream to the receiving side.
+/// Nothing is done if the connection has already been closed.
+void SocketChunkSender::close()
+{
+  if (itsFD >= 0) {
+      ::close(itsFD);
+      itsFD = -1;
+  }
+}
+
+/// @brief write the given number of bytes
+/// @param[in] ptr data to write
+/// @param[in] size number of bytes
+void SocketChunkSender::writeFully(const char *ptr, size_t size)
+{
+  for (size_t done = 0; done < size;) {
+       #ifdef MSG_NOSIGNAL
+       // don't get SIGPIPE if the receiver has gone
+       ssize_t result = ::send(itsFD, ptr + done, size - done, MSG_NOSIGNAL);
+       if ((result < 0) && (errno == ENOTSOCK)) {
+           result = ::write(itsFD, ptr + done, size - done);
+       }
+       #else
+       const ssize_t result = ::write(itsFD, ptr + done, size - done);
+       #endif
+       if (result < 0) {
+           if (errno == EINTR) {
+               continue;
+           }
+           ASKAPTHROW(DataAccessError, "Error writing data stream: "<<std::strerror(errno));
+       }
+       done += size_t(result);
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,102 @@
+/// @file
+/// @brief sender of serialised chunks over a socket
+/// @details This class is the counterpart of SocketChunkReceiver. It serialises
+/// accessors with CachedDataAccessor::serialise and writes them to a stream socket
+/// (or a pipe) preceded by the message size. It can be used to feed a streaming data
+/// source from another process or, in tests, from a measurement set.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SOCKET_CHUNK_SENDER_H
+#define ASKAP_ACCESSORS_SOCKET_CHUNK_SENDER_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief sender of serialised chunks over a socket
+/// @details The file descriptor is owned by this object and closed in the destructor
+/// (or by an explicit call to close), which signals the end of the stream to the receiver.
+/// @ingroup dataaccess_hlp
+class SocketChunkSender : private boost::noncopyable {
+public:
+  /// @brief construct the sender for an open file descriptor
+  /// @param[in] fd file descriptor of a connected stream socket or a pipe
+  explicit SocketChunkSender(int fd);
+
+  /// @brief close the file descriptor
+  ~SocketChunkSender();
+
+  /// @brief connect to the given host and port
+  /// @param[in] host host name or address
+  /// @param[in] port TCP port
+  /// @return shared pointer to the sender
+  static boost::shared_ptr<SocketChunkSender> connect(const std::string &host, int port);
+
+  /// @brief send one chunk
+  /// @param[in] acc accessor to serialise and send
+  void send(const IConstDataAccessor &acc);
+
+  /// @brief send one message
+  /// @param[in] buf serialised chunk
+  void send(const LOFAR::BlobString &buf);
+
+  /// @brief close the connection
+  /// @details This signals the end of the stream to the receiving side.
+  /// Nothing is done if the connection has already been closed.
+  void close();
+
+protected:
+  /// @brief write the given number of bytes
+  /// @param[in] ptr data to write
+  /// @param[in] size number of bytes
+  void writeFully(const char *ptr, size_t size);
+
+private:
+  /// @brief file descriptor, negative after close
+  int itsFD;
+
+  /// @brief buffer for serialisation
+  LOFAR::BlobString itsBuffer;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SOCKET_CHUNK_SENDER_H
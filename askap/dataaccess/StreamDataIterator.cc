@@ -0,0 +1,88 @@
+/// @file
+/// @brief iterator over chunks received from a stream
+/// @details This iterator takes chunks from a BoundedChunkQueue filled by the background 
+/// thread of StreamDataSource. The stream can be passed only once, therefore the iteration
+/// can't be restarted after the first step.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/StreamDataIterator.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the iterator
+/// @param[in] queue queue filled by the receiving thread
+StreamDataIterator::StreamDataIterator(const boost::shared_ptr<BoundedChunkQueue> &queue) :
+        itsQueue(queue), itsNChunks(0)
+{
+  ASKAPCHECK(itsQueue, "An attempt to initialise StreamDataIterator with empty shared pointer");
+  next();
+}
+
+/// @brief restart the iteration from the beginning
+/// @details Streams can't be rewound, this method only succeeds before the first step
+void StreamDataIterator::init()
+{
+  if (itsNChunks > 1) {
+      ASKAPTHROW(DataAccessLogicError, "Streaming data can't be iterated over more than once, "<<
+                 itsNChunks<<" chunks have already been delivered");
+  }
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the current chunk
+const IConstDataAccessor& StreamDataIterator::operator*() const
+{
+  ASKAPCHECK(itsCurrent, "StreamDataIterator: an attempt to access data past the end of the stream");
+  return *itsCurrent;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool StreamDataIterator::hasMore() const throw()
+{
+  return itsCurrent.get() != NULL;
+}
+
+/// advance the iterator one step further 
+/// @details This method blocks until the next chunk is received or the stream ends
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool StreamDataIterator::next()
+{
+  itsCurrent = itsQueue->pop();
+  if (itsCurrent) {
+      ++itsNChunks;
+  }
+  return hasMore();
+}
+
+} // namespace accessors
+
+} // namespace askap
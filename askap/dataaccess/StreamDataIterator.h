@@ -0,0 +1,95 @@
+/// @file
+/// @brief iterator over chunks received from a stream
+/// @details This iterator takes chunks from a BoundedChunkQueue filled by the background 
+/// thread of StreamDataSource. The stream can be passed only once, therefore the iteration
+/// can't be restarted after the first step.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_STREAM_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_STREAM_DATA_ITERATOR_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/BoundedChunkQueue.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iterator over chunks received from a stream
+/// @details Each step delivers the next chunk from the queue, waiting for it if necessary.
+/// The first chunk is awaited in the constructor. Errors of the receiving side are reported
+/// by next (or by the constructor) as DataAccessError. Shapes of the chunks can differ
+/// between steps.
+/// @ingroup dataaccess_hlp
+class StreamDataIterator : virtual public IConstDataIterator
+{
+public:
+  /// @brief construct the iterator
+  /// @param[in] queue queue filled by the receiving thread
+  explicit StreamDataIterator(const boost::shared_ptr<BoundedChunkQueue> &queue);
+
+  /// @brief restart the iteration from the beginning
+  /// @details Streams can't be rewound, this method only succeeds before the first step
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the current chunk
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @details This method blocks until the next chunk is received or the stream ends
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @brief number of chunks delivered so far
+  /// @return number of steps made, including the current one
+  inline size_t nChunks() const { return itsNChunks; }
+
+private:
+  /// @brief queue filled by the receiving thread
+  boost::shared_ptr<BoundedChunkQueue> itsQueue;
+
+  /// @brief current chunk, empty at the end of the stream
+  BoundedChunkQueue::ChunkPtr itsCurrent;
+
+  /// @brief number of chunks delivered so far
+  size_t itsNChunks;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_STREAM_DATA_ITERATOR_H
@@ -0,0 +1,176 @@
+/// @file
+/// @brief selector for streaming data sources
+/// @details Data received from a stream are delivered as they come, selection has to be
+/// done by the sender. This class is returned by StreamDataSource::createSelector to
+/// satisfy the interface. All selection methods throw an exception.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/StreamDataSelector.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// Choose a single feed, the same for both antennae
+/// @param[in] feedID the sequence number of feed to choose
+void StreamDataSelector::chooseFeed(casacore::uInt)
+{
+  notSupported("chooseFeed");
+}
+
+/// Choose a baseline
+/// @param[in] ant1 the sequence number of the first antenna
+/// @param[in] ant2 the sequence number of the second antenna
+void StreamDataSelector::chooseBaseline(casacore::uInt, casacore::uInt)
+{
+  notSupported("chooseBaseline");
+}
+
+/// Choose all baselines to given antenna
+/// @param[in] ant the sequence number of antenna
+void StreamDataSelector::chooseAntenna(casacore::uInt)
+{
+  notSupported("chooseAntenna");
+}
+
+/// Choose samples corresponding to a uniquely specified user-defined index
+/// @param[in] column name of the column
+/// @param[in] value the value to select
+void StreamDataSelector::chooseUserDefinedIndex(const std::string &, const casacore::uInt)
+{
+  notSupported("chooseUserDefinedIndex");
+}
+
+/// Choose autocorrelations only
+void StreamDataSelector::chooseAutoCorrelations()
+{
+  notSupported("chooseAutoCorrelations");
+}
+
+/// Choose crosscorrelations only
+void StreamDataSelector::chooseCrossCorrelations()
+{
+  notSupported("chooseCrossCorrelations");
+}
+
+/// Choose samples with the uv-distance larger than the given threshold
+/// @param[in] uvDist threshold in metres
+void StreamDataSelector::chooseMinUVDistance(casacore::Double)
+{
+  notSupported("chooseMinUVDistance");
+}
+
+/// Choose samples with the uv-distance smaller than the given threshold
+/// @param[in] uvDist threshold in metres
+void StreamDataSelector::chooseMaxUVDistance(casacore::Double)
+{
+  notSupported("chooseMaxUVDistance");
+}
+
+/// Choose a subset of spectral channels
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the number of the first spectral channel to choose
+/// @param[in] nAvg a number of adjacent spectral channels to average
+void StreamDataSelector::chooseChannels(casacore::uInt, casacore::uInt, casacore::uInt)
+{
+  notSupported("chooseChannels");
+}
+
+/// Choose a subset of frequencies
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the frequency of the first spectral channel to choose
+/// @param[in] freqInc an increment in terms of the frequency
+void StreamDataSelector::chooseFrequencies(casacore::uInt, const casacore::MVFrequency &, const casacore::MVFrequency &)
+{
+  notSupported("chooseFrequencies");
+}
+
+/// Choose a subset of radial velocities
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the velocity of the first spectral channel to choose
+/// @param[in] velInc an increment in terms of the radial velocity
+void StreamDataSelector::chooseVelocities(casacore::uInt, const casacore::MVRadialVelocity &, const casacore::MVRadialVelocity &)
+{
+  notSupported("chooseVelocities");
+}
+
+/// Choose a single spectral window (also known as IF)
+/// @param[in] spWinID the ID of the spectral window to choose
+void StreamDataSelector::chooseSpectralWindow(casacore::uInt)
+{
+  notSupported("chooseSpectralWindow");
+}
+
+/// Choose a time range given as epochs
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop the end of the chosen time interval
+void StreamDataSelector::chooseTimeRange(const casacore::MVEpoch &, const casacore::MVEpoch &)
+{
+  notSupported("chooseTimeRange");
+}
+
+/// Choose a time range with respect to the origin defined by the data source
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop the end of the chosen time interval
+void StreamDataSelector::chooseTimeRange(casacore::Double, casacore::Double)
+{
+  notSupported("chooseTimeRange");
+}
+
+/// Choose polarization
+/// @param[in] pols a string describing the wanted polarization in the output
+void StreamDataSelector::choosePolarizations(const casacore::String &)
+{
+  notSupported("choosePolarizations");
+}
+
+/// Choose cycles
+/// @param[in] start the number of the first cycle to choose
+/// @param[in] stop the number of the last cycle to choose
+void StreamDataSelector::chooseCycles(casacore::uInt, casacore::uInt)
+{
+  notSupported("chooseCycles");
+}
+
+/// Choose a single scan number
+/// @param[in] scanNumber the scan number to choose
+void StreamDataSelector::chooseScanNumber(casacore::uInt)
+{
+  notSupported("chooseScanNumber");
+}
+
+/// @brief report unsupported selection
+/// @param[in] what name of the selection method
+void StreamDataSelector::notSupported(const std::string &what)
+{
+  ASKAPTHROW(DataAccessLogicError, "StreamDataSelector::"<<what<<" - selection is not supported for streaming data sources, "
+             "it has to be done on the sending side");
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,132 @@
+/// @file
+/// @brief data source for visibilities received from a stream
+/// @details This data source allows the usual iterator-based processing to be applied
+/// to data arriving in real time, e.g. from the correlator or from another process. Chunks
+/// are received by a background thread via an IChunkReceiver, decoded into 
+/// CachedDataAccessors and put into a bounded queue. If the consumer is slower than the 
+/// stream, the queue fills up and the receiving thread stops reading, so the backpressure 
+/// is propagated to the sender (e.g. via the socket buffers).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/StreamDataSource.h>
+#include <askap/dataaccess/StreamDataIterator.h>
+#include <askap/dataaccess/StreamDataSelector.h>
+#include <askap/dataaccess/CachedDataAccessor.h>
+#include <askap/dataaccess/BasicDataConverter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobIStream.h>
+
+// std includes
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the data source and start receiving
+/// @param[in] receiver transport delivering serialised chunks
+/// @param[in] capacity maximum number of decoded chunks waiting for the consumer
+StreamDataSource::StreamDataSource(const boost::shared_ptr<IChunkReceiver> &receiver, size_t capacity) :
+        itsReceiver(receiver), itsQueue(new BoundedChunkQueue(capacity)), itsIteratorCreated(false)
+{
+  ASKAPCHECK(itsReceiver, "An attempt to initialise StreamDataSource with empty shared pointer");
+  itsThread.reset(new boost::thread(&StreamDataSource::receive, this));
+}
+
+/// @brief stop the receiving thread
+StreamDataSource::~StreamDataSource()
+{
+  // the order matters: close unblocks the thread waiting for space in the queue,
+  // interrupt unblocks the thread waiting for data
+  itsQueue->close();
+  itsReceiver->interrupt();
+  itsThread->join();
+}
+
+/// @brief body of the receiving thread
+/// @details Errors are passed to the consumer via the queue
+void StreamDataSource::receive()
+{
+  try {
+     LOFAR::BlobString buf;
+     while (itsReceiver->receive(buf)) {
+            LOFAR::BlobIBufString bib(buf);
+            LOFAR::BlobIStream in(bib);
+            const BoundedChunkQueue::ChunkPtr chunk(new CachedDataAccessor(in));
+            if (!itsQueue->push(chunk)) {
+                break;
+            }
+     }
+     itsQueue->finish();
+  }
+  catch (const std::exception &ex) {
+     itsQueue->finish(ex.what());
+  }
+  catch (...) {
+     itsQueue->finish("unknown exception in the receiving thread");
+  }
+}
+
+/// @brief create a converter object corresponding to this type of the DataSource
+/// @return a shared pointer to a new DataConverter object
+IDataConverterPtr StreamDataSource::createConverter() const
+{
+  return IDataConverterPtr(new BasicDataConverter);
+}
+
+/// @brief get an iterator over the stream
+/// @param[in] sel a shared pointer to the selector object (should be created by this 
+///            data source and left unchanged)
+/// @param[in] conv a shared pointer to the converter object (ignored)
+/// @return a shared pointer to StreamDataIterator object
+boost::shared_ptr<IConstDataIterator> StreamDataSource::createConstIterator(const
+	           IDataSelectorConstPtr &sel, const IDataConverterConstPtr &) const
+{
+  if (!boost::dynamic_pointer_cast<StreamDataSelector const>(sel)) {
+      ASKAPTHROW(DataAccessLogicError, "Selector passed to StreamDataSource should be created by the same class");
+  }
+  if (itsIteratorCreated) {
+      ASKAPTHROW(DataAccessLogicError, "Streaming data can be iterated over only once, StreamDataSource can't create another iterator");
+  }
+  itsIteratorCreated = true;
+  return boost::shared_ptr<IConstDataIterator>(new StreamDataIterator(itsQueue));
+}
+
+/// @brief create a selector object corresponding to this type of the DataSource
+/// @return a shared pointer to StreamDataSelector 
+IDataSelectorPtr StreamDataSource::createSelector() const
+{
+  return IDataSelectorPtr(new StreamDataSelector);
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,118 @@
+/// @file
+/// @brief data source for visibilities received from a stream
+/// @details This data source allows the usual iterator-based processing to be applied
+/// to data arriving in real time, e.g. from the correlator or from another process. Chunks
+/// are received by a background thread via an IChunkReceiver, decoded into 
+/// CachedDataAccessors and put into a bounded queue. If the consumer is slower than the 
+/// stream, the queue fills up and the receiving thread stops reading, so the backpressure 
+/// is propagated to the sender (e.g. via the socket buffers).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_STREAM_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_STREAM_DATA_SOURCE_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/IChunkReceiver.h>
+#include <askap/dataaccess/BoundedChunkQueue.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief data source for visibilities received from a stream
+/// @details The receiving thread is started at construction and stopped in the destructor.
+/// The stream can be passed only once, therefore only one iterator can be created. 
+/// Data are delivered in the frames and units they were serialised by the sender, the 
+/// converter passed to createConstIterator is ignored. Selection is not supported either, 
+/// the selector returned by createSelector throws on any attempt to use it.
+/// @ingroup dataaccess_hlp
+class StreamDataSource : virtual public IConstDataSource,
+                         private boost::noncopyable
+{
+public:
+  /// @brief construct the data source and start receiving
+  /// @param[in] receiver transport delivering serialised chunks
+  /// @param[in] capacity maximum number of decoded chunks waiting for the consumer
+  explicit StreamDataSource(const boost::shared_ptr<IChunkReceiver> &receiver, size_t capacity = 16);
+
+  /// @brief stop the receiving thread
+  virtual ~StreamDataSource();
+
+  /// @brief create a converter object corresponding to this type of the DataSource
+  /// @return a shared pointer to a new DataConverter object
+  virtual IDataConverterPtr createConverter() const;
+
+  /// @brief get an iterator over the stream
+  /// @param[in] sel a shared pointer to the selector object (should be created by this 
+  ///            data source and left unchanged)
+  /// @param[in] conv a shared pointer to the converter object (ignored)
+  /// @return a shared pointer to StreamDataIterator object
+  virtual boost::shared_ptr<IConstDataIterator> createConstIterator(const
+	           IDataSelectorConstPtr &sel, const
+		   IDataConverterConstPtr &conv) const;
+
+  // we need this to get access to the overloaded syntax in the base class
+  using IConstDataSource::createConstIterator;
+
+  /// @brief create a selector object corresponding to this type of the DataSource
+  /// @return a shared pointer to StreamDataSelector 
+  virtual IDataSelectorPtr createSelector() const;
+
+  /// @brief access to the queue of decoded chunks
+  /// @details This is intended for monitoring of the stream (e.g. the queue length)
+  /// @return const reference to the queue
+  inline const BoundedChunkQueue& queue() const { return *itsQueue; }
+
+protected:
+  /// @brief body of the receiving thread
+  /// @details Errors are passed to the consumer via the queue
+  void receive();
+
+private:
+  /// @brief transport delivering serialised chunks
+  boost::shared_ptr<IChunkReceiver> itsReceiver;
+
+  /// @brief queue of decoded chunks
+  boost::shared_ptr<BoundedChunkQueue> itsQueue;
+
+  /// @brief true, if the iterator has been created
+  mutable bool itsIteratorCreated;
+
+  /// @brief receiving thread
+  boost::shared_ptr<boost::thread> itsThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_STREAM_DATA_SOURCE_H
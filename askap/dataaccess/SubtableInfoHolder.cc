@@ -43,12 +43,32 @@
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/Tables/MemoryTable.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+// std includes
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
 
 // own includes
 #include <askap/dataaccess/SubtableInfoHolder.h>
 #include <askap/dataaccess/MemTableDataDescHolder.h>
 #include <askap/dataaccess/MemTableSpWindowHolder.h>
 #include <askap/dataaccess/TableBufferManager.h>
+#include <askap/dataaccess/FileBufferManager.h>
+#include <askap/dataaccess/HybridBufferManager.h>
+#include <askap/dataaccess/CompressingBufferManager.h>
 #include <askap/dataaccess/DataAccessError.h>
 #include <askap/dataaccess/FeedSubtableHandler.h>
 #include <askap/dataaccess/FieldSubtableHandler.h>
@@ -58,14 +78,65 @@
 using namespace askap;
 using namespace askap::accessors;
 
+namespace {
+
+/// @brief subtables stored in the snapshot
+/// @details FEED is not included, its handler reads the beam details on demand
+const char* snapshotSubtables[] = {"ANTENNA", "DATA_DESCRIPTION", "FIELD", "POLARIZATION", "SPECTRAL_WINDOW"};
+
+/// @brief number of subtables stored in the snapshot
+const size_t nSnapshotSubtables = sizeof(snapshotSubtables) / sizeof(snapshotSubtables[0]);
+
+/// @brief obtain the concrete type of a handler to serialise it
+/// @param[in] handler handler returned by one of the get methods
+/// @return reference to the implementation
+template<typename Impl, typename Interface>
+const Impl& snapshotHandler(const Interface &handler)
+{
+  const Impl *impl = dynamic_cast<const Impl*>(&handler);
+  ASKAPCHECK(impl != NULL, "Unexpected type of the subtable handler, unable to write the snapshot");
+  return *impl;
+}
+
+} // anonymous namespace
+
 /// @brief construct SubtableInfoHolder
 /// @details The idea is that this constructor is the point where one can choose
 /// how the lower level management is done (i.e. disk or memory based buffers). 
 /// In the future, more arguments can be received by this constructor. It is probably
 /// practical to provide reasonable defaults here
-/// @param memBuffers true if the buffers should be held in memory, false if they should be
-/// written back to the disk (table needs to be writable for this)
-SubtableInfoHolder::SubtableInfoHolder(bool memBuffers) : itsUseMemBuffers(memBuffers) {}
+/// @param bufferStorage where the buffers should be kept, one of the BufferStorage values
+/// (true and false are understood as memory and subtable-based buffers)
+/// @param bufferMemory memory limit in bytes for HYBRID_BUFFERS (0 means the
+/// default limit of HybridBufferManager)
+SubtableInfoHolder::SubtableInfoHolder(int bufferStorage, size_t bufferMemory) : 
+         itsBufferStorage(bufferStorage), itsBufferMemory(bufferMemory)
+{
+  ASKAPCHECK((bufferStorage >= TABLE_BUFFERS) && (bufferStorage <= HYBRID_BUFFERS),
+             "Unknown buffer storage type "<<bufferStorage);
+}
+
+/// @brief obtain a handler, creating it on the first call
+/// @details The handler is constructed from the main table if it doesn't 
+/// exist yet. This method can be called from several threads.
+/// @param[in] handler a reference to the shared pointer holding the handler
+/// @return a reference to the handler
+template<typename Impl, typename Interface>
+const Interface& SubtableInfoHolder::getHandler(boost::shared_ptr<Interface const> &handler) const
+{
+  {
+    boost::shared_lock<boost::shared_mutex> lock(itsMutex);
+    if (handler) {
+        return *handler;
+    }
+  }
+  // handler is created once, other threads could have done it in the meantime
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+  if (!handler) {
+      handler.reset(new Impl(table()));
+  }
+  return *handler;
+}
 
 
 /// @brief obtain data description holder
@@ -74,10 +145,7 @@ SubtableInfoHolder::SubtableInfoHolder(bool memBuffers) : itsUseMemBuffers(memBu
 /// @return a reference to the handler of the DATA_DESCRIPTION subtable
 const ITableDataDescHolder& SubtableInfoHolder::getDataDescription() const
 {
-  if (!itsDataDescHandler) {
-      itsDataDescHandler.reset(new MemTableDataDescHolder(table()));
-  }
-  return *itsDataDescHandler;
+  return getHandler<MemTableDataDescHolder>(itsDataDescHandler);
 }
 
 /// @brief obtain spectral window holder
@@ -86,10 +154,7 @@ const ITableDataDescHolder& SubtableInfoHolder::getDataDescription() const
 /// @return a reference to the handler of the SPECTRAL_WINDOW subtable
 const ITableSpWindowHolder& SubtableInfoHolder::getSpWindow() const
 {
-  if (!itsSpWindowHandler) {
-      itsSpWindowHandler.reset(new MemTableSpWindowHolder(table()));
-  }
-  return *itsSpWindowHandler;
+  return getHandler<MemTableSpWindowHolder>(itsSpWindowHandler);
 }
 
 /// @brief obtain polarisation information holder
@@ -98,10 +163,7 @@ const ITableSpWindowHolder& SubtableInfoHolder::getSpWindow() const
 /// @return a reference to the handler of the POLARIZATION subtable
 const ITablePolarisationHolder& SubtableInfoHolder::getPolarisation() const
 {
-  if (!itsPolarisationHandler) {
-      itsPolarisationHandler.reset(new MemTablePolarisationHolder(table()));
-  }
-  return *itsPolarisationHandler;
+  return getHandler<MemTablePolarisationHolder>(itsPolarisationHandler);
 }
 
 
@@ -112,22 +174,43 @@ const ITablePolarisationHolder& SubtableInfoHolder::getPolarisation() const
 /// @return a reference to the manager of buffers (BUFFERS subtable)
 const IBufferManager& SubtableInfoHolder::getBufferManager() const
 {
+  {
+    boost::shared_lock<boost::shared_mutex> lock(itsMutex);
+    if (itsBufferManager) {
+        return *itsBufferManager;
+    }
+  }
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
   if (!itsBufferManager) {
       initBufferManager();
   }
   return *itsBufferManager;
 }
 
-/// initialize itsBufferManager with an instance of TableBufferManager
+/// initialize itsBufferManager with an instance of the buffer manager
+/// @details TableBufferManager, FileBufferManager or HybridBufferManager is created depending on
+/// the chosen storage and wrapped into CompressingBufferManager, so buffers can be
+/// stored in a compact form. This method should be called with the unique lock held
 void SubtableInfoHolder::initBufferManager() const
 {  
-  if (itsUseMemBuffers) {
+  boost::shared_ptr<IBufferManager const> store;
+  if (itsBufferStorage == FILE_BUFFERS) {
+      // buffers are spilled into flat binary files next to the measurement set,
+      // the table itself is not modified
+      store.reset(new FileBufferManager(table().tableName()+"/BUFFERS"));
+  } else if (itsBufferStorage == HYBRID_BUFFERS) {
+      // buffers are kept in memory, the least recently used ones are moved to
+      // the flat binary files when the memory limit is reached
+      const boost::shared_ptr<IBufferManager const> spill(
+                 new FileBufferManager(table().tableName()+"/BUFFERS"));
+      store.reset(new HybridBufferManager(spill, itsBufferMemory));
+  } else if (itsBufferStorage == MEMORY_BUFFERS) {
       // After calling this method, the buffers will be held in
       // memory (via casacore::MemoryTable), rather than be a subtable of
       // the measurement set.
       casacore::SetupNewTable maker("BUFFERS",
 								casacore::TableDesc(),casacore::Table::New);
-      itsBufferManager.reset(new TableBufferManager(casacore::Table(maker,
+      store.reset(new TableBufferManager(casacore::Table(maker,
                                 casacore::Table::Memory)));      
   } else {
       // first, test that we have a compatible BUFFERS subtable if the
@@ -155,9 +238,10 @@ void SubtableInfoHolder::initBufferManager() const
                                   casacore::TableDesc(),casacore::Table::New);
           table().rwKeywordSet().defineTable("BUFFERS",casacore::Table(maker));
       }
-      itsBufferManager.reset(new
-               TableBufferManager(table().keywordSet().asTable("BUFFERS")));
+      store.reset(new TableBufferManager(table().keywordSet().asTable("BUFFERS")));
   }
+  // codecs for individual buffers can be set later via the adapter
+  itsBufferManager.reset(new CompressingBufferManager(store));
 }
 
 /// @brief obtain a feed subtable handler
@@ -166,10 +250,7 @@ void SubtableInfoHolder::initBufferManager() const
 /// @return a reference to the handler of the FEED subtable
 const IFeedSubtableHandler& SubtableInfoHolder::getFeed() const
 {
-  if (!itsFeedHandler) {
-      itsFeedHandler.reset(new FeedSubtableHandler(table()));  
-  }
-  return *itsFeedHandler;
+  return getHandler<FeedSubtableHandler>(itsFeedHandler);
 }
 
 
@@ -179,10 +260,7 @@ const IFeedSubtableHandler& SubtableInfoHolder::getFeed() const
 /// @return a reference to the handler of the FIELD subtable
 const IFieldSubtableHandler& SubtableInfoHolder::getField() const
 {
-  if (!itsFieldHandler) {
-      itsFieldHandler.reset(new FieldSubtableHandler(table()));
-  }
-  return *itsFieldHandler;
+  return getHandler<FieldSubtableHandler>(itsFieldHandler);
 }
 
 
@@ -192,8 +270,161 @@ const IFieldSubtableHandler& SubtableInfoHolder::getField() const
 /// @return a reference to the handler of the ANTENNA subtable
 const IAntennaSubtableHandler& SubtableInfoHolder::getAntenna() const
 {
-  if (!itsAntennaHandler) {
-      itsAntennaHandler.reset(new MemAntennaSubtableHandler(table()));
+  return getHandler<MemAntennaSubtableHandler>(itsAntennaHandler);
+}
+
+/// @brief obtain an index of the main table rows
+/// @details A MainTableRowIndex is constructed on the first call to this 
+/// method and a reference to it is returned thereafter. The index is only 
+/// built if row-based selection is used (see TableConstDataSource::configureRowIndex).
+/// @return a reference to the index of the main table rows
+const MainTableRowIndex& SubtableInfoHolder::getRowIndex() const
+{
+  return getHandler<MainTableRowIndex>(itsRowIndex);
+}
+
+/// @brief obtain an index of the TIME column of the main table
+/// @details A TimeColumnIndex is constructed on the first call to this method
+/// and a reference to it is returned thereafter.
+/// @return a reference to the index of the TIME column
+const TimeColumnIndex& SubtableInfoHolder::getTimeIndex() const
+{
+  return getHandler<TimeColumnIndex>(itsTimeIndex);
+}
+
+/// @brief restore subtable handlers from a snapshot file
+/// @details The snapshot (see saveSnapshot) holds the processed content of the
+/// ANTENNA, DATA_DESCRIPTION, FIELD, POLARIZATION and SPECTRAL_WINDOW subtables.
+/// It is only accepted if it has been written for the measurement set with the same
+/// name and none of these subtables has been modified since (the latest modification
+/// time of the files of each subtable is compared). Handlers which already exist are
+/// left intact. Any problem with the file is treated as an invalid snapshot.
+/// @param[in] fileName name of the snapshot file
+/// @return true if the snapshot is valid for this measurement set and has been loaded
+bool SubtableInfoHolder::loadSnapshot(const std::string &fileName) const
+{
+  try {
+     std::ifstream fs(fileName.c_str(), std::ios::in | std::ios::binary);
+     if (!fs) {
+         return false;
+     }
+     fs.seekg(0, std::ios::end);
+     const std::streamoff size = fs.tellg();
+     if (size <= 0) {
+         return false;
+     }
+     fs.seekg(0, std::ios::beg);
+     LOFAR::BlobString bs;
+     bs.resize(size);
+     fs.read(reinterpret_cast<char*>(bs.data()), size);
+     if (!fs) {
+         return false;
+     }
+     LOFAR::BlobIBufString bib(bs);
+     LOFAR::BlobIStream in(bib);
+     if (in.getStart("SubtableSnapshot") != 1) {
+         return false;
+     }
+     std::string msName;
+     in >> msName;
+     if (msName != table().tableName()) {
+         return false;
+     }
+     for (size_t index = 0; index < nSnapshotSubtables; ++index) {
+          std::string name;
+          casacore::uInt modifyTime = 0;
+          in >> name >> modifyTime;
+          if ((name != snapshotSubtables[index]) || (modifyTime != subtableModifyTime(name))) {
+              return false;
+          }
+     }
+     // the order matches snapshotSubtables
+     const boost::shared_ptr<IAntennaSubtableHandler const> antenna(new MemAntennaSubtableHandler(in));
+     const boost::shared_ptr<ITableDataDescHolder const> dataDesc(new MemTableDataDescHolder(in));
+     const boost::shared_ptr<IFieldSubtableHandler const> field(new FieldSubtableHandler(table(), in));
+     const boost::shared_ptr<ITablePolarisationHolder const> polarisation(new MemTablePolarisationHolder(in));
+     const boost::shared_ptr<ITableSpWindowHolder const> spWindow(new MemTableSpWindowHolder(in));
+     in.getEnd();
+
+     boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+     if (!itsAntennaHandler) {
+         itsAntennaHandler = antenna;
+     }
+     if (!itsDataDescHandler) {
+         itsDataDescHandler = dataDesc;
+     }
+     if (!itsFieldHandler) {
+         itsFieldHandler = field;
+     }
+     if (!itsPolarisationHandler) {
+         itsPolarisationHandler = polarisation;
+     }
+     if (!itsSpWindowHandler) {
+         itsSpWindowHandler = spWindow;
+     }
+  }
+  catch (const std::exception &) {
+     // corrupted or incompatible snapshot, subtables will be read as usual
+     return false;
+  }
+  return true;
+}
+
+/// @brief write subtable handlers into a snapshot file
+/// @details The handlers of the subtables stored in the snapshot are created if 
+/// necessary. The file is written under a temporary name and renamed at the end,
+/// so concurrent readers never see a partial snapshot. The FEED subtable is not
+/// included because its handler reads the beam details on demand.
+/// @param[in] fileName name of the snapshot file
+void SubtableInfoHolder::saveSnapshot(const std::string &fileName) const
+{
+  ASKAPCHECK(fileName != "", "An empty file name is given for the subtable snapshot");
+  LOFAR::BlobString bs;
+  LOFAR::BlobOBufString bob(bs);
+  LOFAR::BlobOStream out(bob);
+  out.putStart("SubtableSnapshot", 1);
+  out << std::string(table().tableName());
+  for (size_t index = 0; index < nSnapshotSubtables; ++index) {
+       out << std::string(snapshotSubtables[index]) << subtableModifyTime(snapshotSubtables[index]);
+  }
+  snapshotHandler<MemAntennaSubtableHandler>(getAntenna()).serialise(out);
+  snapshotHandler<MemTableDataDescHolder>(getDataDescription()).serialise(out);
+  snapshotHandler<FieldSubtableHandler>(getField()).serialise(out);
+  snapshotHandler<MemTablePolarisationHolder>(getPolarisation()).serialise(out);
+  snapshotHandler<MemTableSpWindowHolder>(getSpWindow()).serialise(out);
+  out.putEnd();
+
+  std::ostringstream os;
+  os<<fileName<<".tmp"<<getpid();
+  const std::string tmpName = os.str();
+  {
+    std::ofstream fs(tmpName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    ASKAPCHECK(fs, "Unable to create the subtable snapshot "<<tmpName);
+    fs.write(reinterpret_cast<const char*>(bs.data()), bs.size());
+    fs.close();
+    if (!fs) {
+        std::remove(tmpName.c_str());
+        ASKAPTHROW(DataAccessError, "Unable to write the subtable snapshot "<<tmpName);
+    }
+  }
+  if (std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+      std::remove(tmpName.c_str());
+      ASKAPTHROW(DataAccessError, "Unable to rename "<<tmpName<<" into "<<fileName);
+  }
+}
+
+/// @brief latest modification time of a subtable
+/// @details The time is the latest one among the subtable directory and the files it contains
+/// @param[in] name name of the subtable
+/// @return modification time in seconds since the epoch
+casacore::uInt SubtableInfoHolder::subtableModifyTime(const std::string &name) const
+{
+  const std::string path = table().tableName() + "/" + name;
+  const casacore::Directory dir(path);
+  ASKAPCHECK(dir.exists(), "Subtable "<<name<<" is not found at "<<path);
+  casacore::uInt result = dir.modifyTime();
+  for (casacore::DirectoryIterator it(dir); !it.pastEnd(); ++it) {
+       result = std::max(result, casacore::File(path + "/" + it.name()).modifyTime());
   }
-  return *itsAntennaHandler;
+  return result;
 }
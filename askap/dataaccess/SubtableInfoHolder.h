@@ -8,6 +8,7 @@
 ///     2. data description indices,
 ///     3. spectral window ids.
 ///     4. Polarisation information
+///     5. index of the main table rows by time, feed, baseline and data description
 /// Such design allows to avoid parsing of all possible subtables and
 /// building all possible derived information (which can be time consuming)
 /// when the measurement set is opened.
@@ -42,6 +43,10 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
 
 // own includes
 #include <askap/dataaccess/ISubtableInfoHolder.h>
@@ -61,21 +66,44 @@ namespace accessors {
 ///     2. data description indices,
 ///     3. spectral window ids.
 ///     4. Polarisation information
+///     5. index of the main table rows by time, feed, baseline and data description
 /// Such design allows to avoid parsing of all possible subtables and
 /// building all possible derived information (which can be time consuming)
-/// when the measurement set is opened.
+/// when the measurement set is opened. Handlers are created once and shared
+/// by all iterators using the same table manager. Creation is protected by a
+/// reader-writer lock and the handlers don't change after the subtable is
+/// loaded (or are thread-safe themselves), so they can be accessed from 
+/// several threads.
 /// @ingroup dataaccess_tm
 struct SubtableInfoHolder : virtual public ISubtableInfoHolder,
                             virtual public ITableHolder
 {
+   /// @brief storage used for the buffers
+   /// @details Values are chosen such that true/false passed for the storage
+   /// kind correspond to the memory and subtable-based buffers, respectively.
+   enum BufferStorage {
+      /// buffers are stored in the BUFFERS subtable (table needs to be writable)
+      TABLE_BUFFERS = 0,
+      /// buffers are held in memory (via casacore::MemoryTable)
+      MEMORY_BUFFERS = 1,
+      /// buffers are stored in flat binary files alongside the measurement set
+      /// (see FileBufferManager)
+      FILE_BUFFERS = 2,
+      /// buffers are held in memory up to the given size, the least recently
+      /// used ones are spilled into flat binary files (see HybridBufferManager)
+      HYBRID_BUFFERS = 3
+   };
+
    /// @brief construct SubtableInfoHolder
    /// @details The idea is that this constructor is the point where one can choose
    /// how the lower level management is done (i.e. disk or memory based buffers). 
    /// In the future, more arguments can be received by this constructor. It is probably
    /// practical to provide reasonable defaults here
-   /// @param memBuffers true if the buffers should be held in memory, false if they should be
-   /// written back to the disk (table needs to be writable for this)
-   explicit SubtableInfoHolder(bool memBuffers = false);
+   /// @param bufferStorage where the buffers should be kept, one of the BufferStorage values
+   /// (true and false are understood as memory and subtable-based buffers)
+   /// @param bufferMemory memory limit in bytes for HYBRID_BUFFERS (0 means the
+   /// default limit of HybridBufferManager)
+   explicit SubtableInfoHolder(int bufferStorage = TABLE_BUFFERS, size_t bufferMemory = 0);
 
    /// @brief obtain data description holder
    /// @details A MemTableDataDescHolder is constructed on the first call
@@ -120,12 +148,61 @@ struct SubtableInfoHolder : virtual public ISubtableInfoHolder,
    /// to this method and a reference to it is returned thereafter
    /// @return a reference to the handler of the ANTENNA subtable
    virtual const IAntennaSubtableHandler& getAntenna() const;
+
+   /// @brief obtain an index of the main table rows
+   /// @details A MainTableRowIndex is constructed on the first call to this 
+   /// method and a reference to it is returned thereafter. The index is only 
+   /// built if row-based selection is used (see TableConstDataSource::configureRowIndex).
+   /// @return a reference to the index of the main table rows
+   virtual const MainTableRowIndex& getRowIndex() const;
+
+   /// @brief obtain an index of the TIME column of the main table
+   /// @details A TimeColumnIndex is constructed on the first call to this method
+   /// and a reference to it is returned thereafter.
+   /// @return a reference to the index of the TIME column
+   virtual const TimeColumnIndex& getTimeIndex() const;
+
+   /// @brief restore subtable handlers from a snapshot file
+   /// @details The snapshot (see saveSnapshot) holds the processed content of the
+   /// ANTENNA, DATA_DESCRIPTION, FIELD, POLARIZATION and SPECTRAL_WINDOW subtables.
+   /// It is only accepted if it has been written for the measurement set with the same
+   /// name and none of these subtables has been modified since (the latest modification
+   /// time of the files of each subtable is compared). Handlers which already exist are
+   /// left intact. Any problem with the file is treated as an invalid snapshot.
+   /// @param[in] fileName name of the snapshot file
+   /// @return true if the snapshot is valid for this measurement set and has been loaded
+   virtual bool loadSnapshot(const std::string &fileName) const;
+
+   /// @brief write subtable handlers into a snapshot file
+   /// @details The handlers of the subtables stored in the snapshot are created if 
+   /// necessary. The file is written under a temporary name and renamed at the end,
+   /// so concurrent readers never see a partial snapshot. The FEED subtable is not
+   /// included because its handler reads the beam details on demand.
+   /// @param[in] fileName name of the snapshot file
+   virtual void saveSnapshot(const std::string &fileName) const;
    
    
 protected:   
 
-   /// initialize itsBufferManager with an instance of TableBufferManager
+   /// initialize itsBufferManager with an instance of the buffer manager
+   /// @details TableBufferManager, FileBufferManager or HybridBufferManager is created depending on
+   /// the chosen storage and wrapped into CompressingBufferManager, so buffers can be
+   /// stored in a compact form. This method should be called with the unique lock held
    void initBufferManager() const;
+
+   /// @brief obtain a handler, creating it on the first call
+   /// @details The handler is constructed from the main table if it doesn't 
+   /// exist yet. This method can be called from several threads.
+   /// @param[in] handler a reference to the shared pointer holding the handler
+   /// @return a reference to the handler
+   template<typename Impl, typename Interface>
+   const Interface& getHandler(boost::shared_ptr<Interface const> &handler) const;
+
+   /// @brief latest modification time of a subtable
+   /// @details The time is the latest one among the subtable directory and the files it contains
+   /// @param[in] name name of the subtable
+   /// @return modification time in seconds since the epoch
+   casacore::uInt subtableModifyTime(const std::string &name) const;
    
 private:
    /// smart pointer to the handler of the data description subtable
@@ -140,8 +217,11 @@ private:
    /// smart pointer to the buffer manager
    mutable boost::shared_ptr<IBufferManager const> itsBufferManager;
    
-   /// true if visibility buffers are kept in memory
-   bool itsUseMemBuffers;
+   /// storage used for visibility buffers, one of the BufferStorage values
+   int itsBufferStorage;
+
+   /// memory limit in bytes for hybrid buffers
+   size_t itsBufferMemory;
 
    /// smart pointer to the feed subtable handler
    mutable boost::shared_ptr<IFeedSubtableHandler const> itsFeedHandler;
@@ -151,6 +231,15 @@ private:
    
    /// smart pointer to the antenna subtable handler
    mutable boost::shared_ptr<IAntennaSubtableHandler const> itsAntennaHandler;
+
+   /// smart pointer to the index of the main table rows
+   mutable boost::shared_ptr<MainTableRowIndex const> itsRowIndex;
+
+   /// smart pointer to the index of the TIME column
+   mutable boost::shared_ptr<TimeColumnIndex const> itsTimeIndex;
+
+   /// @brief mutex protecting creation of the handlers
+   mutable boost::shared_mutex itsMutex;
 };
 
 
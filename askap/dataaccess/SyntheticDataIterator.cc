@@ -0,0 +1,139 @@
+/// @file
+/// @brief iterator over chunks of a synthetic observation
+/// @details Chunks are generated by a number of background threads (see SyntheticObservation)
+/// and delivered in time order via a bounded queue, so the consumer gets the data at the rate
+/// they can be generated, without any disk access.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/SyntheticDataIterator.h>
+#include <askap/dataaccess/ColumnarDataAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+// std includes
+#include <algorithm>
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief start the threads
+/// @param[in] obs observation to generate
+/// @param[in] nThreads number of generating threads
+/// @param[in] capacity maximum number of chunks waiting for the consumer
+SyntheticChunkProducer::SyntheticChunkProducer(const SyntheticObservation &obs, size_t nThreads, size_t capacity) :
+        itsObservation(obs), itsNThreads(std::min(nThreads, size_t(obs.nIntegrations()))), 
+        itsQueue(new BoundedChunkQueue(capacity)), itsNextChunk(0), itsStopped(false)
+{
+  ASKAPCHECK(nThreads > 0, "At least one thread is required to generate synthetic data");
+  if (itsNThreads == 0) {
+      // empty observation
+      itsQueue->finish();
+      return;
+  }
+  for (size_t thread = 0; thread < itsNThreads; ++thread) {
+       itsThreads.create_thread(boost::bind(&SyntheticChunkProducer::produce, this, thread));
+  }
+}
+
+/// @brief stop the threads
+SyntheticChunkProducer::~SyntheticChunkProducer()
+{
+  // close unblocks the thread waiting for space in the queue, the others wait for their turn
+  itsQueue->close();
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsStopped = true;
+  }
+  itsTurn.notify_all();
+  itsThreads.join_all();
+}
+
+/// @brief body of a generating thread
+/// @param[in] thread index of the thread
+void SyntheticChunkProducer::produce(size_t thread)
+{
+  try {
+     for (casacore::uInt integration = casacore::uInt(thread); integration < itsObservation.nIntegrations(); 
+          integration += casacore::uInt(itsNThreads)) {
+          boost::shared_ptr<ColumnarDataAccessor> chunk(new ColumnarDataAccessor);
+          itsObservation.fill(integration, *chunk);
+          boost::unique_lock<boost::mutex> lock(itsMutex);
+          while (!itsStopped && (itsNextChunk != integration)) {
+                 itsTurn.wait(lock);
+          }
+          if (itsStopped) {
+              return;
+          }
+          // other threads don't push until the counter is advanced
+          lock.unlock();
+          const bool accepted = itsQueue->push(chunk);
+          lock.lock();
+          if (!accepted) {
+              // the consumer has gone
+              stopLocked("");
+              return;
+          }
+          if (++itsNextChunk == itsObservation.nIntegrations()) {
+              itsQueue->finish();
+          }
+          itsTurn.notify_all();
+     }
+  }
+  catch (const std::exception &ex) {
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     stopLocked(ex.what());
+  }
+  catch (...) {
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     stopLocked("unknown exception in the thread generating synthetic data");
+  }
+}
+
+/// @brief stop generation, the mutex should be locked by the caller
+/// @param[in] error error message passed to the consumer (empty for the normal end)
+void SyntheticChunkProducer::stopLocked(const std::string &error)
+{
+  if (!itsStopped) {
+      itsStopped = true;
+      itsQueue->finish(error);
+  }
+  itsTurn.notify_all();
+}
+
+/// @brief start generation and wait for the first chunk
+/// @param[in] obs observation to generate
+/// @param[in] nThreads number of generating threads
+/// @param[in] capacity maximum number of chunks waiting for the consumer
+SyntheticDataIterator::SyntheticDataIterator(const SyntheticObservation &obs, size_t nThreads, size_t capacity) :
+        SyntheticChunkProducer(obs, nThreads, capacity), StreamDataIterator(chunkQueue()) {}
+
+} // namespace accessors
+
+} // namespace askap
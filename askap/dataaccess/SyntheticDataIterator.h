@@ -0,0 +1,130 @@
+/// @file
+/// @brief iterator over chunks of a synthetic observation
+/// @details Chunks are generated by a number of background threads (see SyntheticObservation)
+/// and delivered in time order via a bounded queue, so the consumer gets the data at the rate
+/// they can be generated, without any disk access.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_SYNTHETIC_DATA_ITERATOR_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+
+// own includes
+#include <askap/dataaccess/StreamDataIterator.h>
+#include <askap/dataaccess/BoundedChunkQueue.h>
+#include <askap/dataaccess/SyntheticObservation.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief threads generating chunks of a synthetic observation into a queue
+/// @details Each thread generates every nThreads-th integration, the chunks are pushed
+/// in time order (a thread which has generated its chunk early waits for its turn). 
+/// Threads are started in the constructor and stopped in the destructor. Errors are 
+/// passed to the consumer via the queue.
+/// @ingroup dataaccess_hlp
+class SyntheticChunkProducer : private boost::noncopyable
+{
+public:
+  /// @brief start the threads
+  /// @param[in] obs observation to generate
+  /// @param[in] nThreads number of generating threads
+  /// @param[in] capacity maximum number of chunks waiting for the consumer
+  SyntheticChunkProducer(const SyntheticObservation &obs, size_t nThreads, size_t capacity);
+
+  /// @brief stop the threads
+  ~SyntheticChunkProducer();
+
+  /// @brief queue of generated chunks
+  /// @return shared pointer to the queue
+  inline const boost::shared_ptr<BoundedChunkQueue>& chunkQueue() const { return itsQueue; }
+
+protected:
+  /// @brief body of a generating thread
+  /// @param[in] thread index of the thread
+  void produce(size_t thread);
+
+  /// @brief stop generation, the mutex should be locked by the caller
+  /// @param[in] error error message passed to the consumer (empty for the normal end)
+  void stopLocked(const std::string &error);
+
+private:
+  /// @brief observation to generate
+  const SyntheticObservation itsObservation;
+
+  /// @brief number of generating threads
+  size_t itsNThreads;
+
+  /// @brief queue of generated chunks
+  boost::shared_ptr<BoundedChunkQueue> itsQueue;
+
+  /// @brief mutex protecting the state
+  boost::mutex itsMutex;
+
+  /// @brief condition signalled when the next chunk can be pushed
+  boost::condition_variable itsTurn;
+
+  /// @brief integration to be pushed next
+  casacore::uInt itsNextChunk;
+
+  /// @brief true, if generation has been stopped
+  bool itsStopped;
+
+  /// @brief generating threads
+  boost::thread_group itsThreads;
+};
+
+/// @brief iterator over chunks of a synthetic observation
+/// @details Chunks are ColumnarDataAccessors, so rotated uvws and delays are available
+/// in addition to the generated fields. As for the streams, the iteration can't be 
+/// restarted, another iterator should be created by the data source instead.
+/// @ingroup dataaccess_hlp
+class SyntheticDataIterator : private SyntheticChunkProducer,
+                              public StreamDataIterator
+{
+public:
+  /// @brief start generation and wait for the first chunk
+  /// @param[in] obs observation to generate
+  /// @param[in] nThreads number of generating threads
+  /// @param[in] capacity maximum number of chunks waiting for the consumer
+  SyntheticDataIterator(const SyntheticObservation &obs, size_t nThreads = 1, size_t capacity = 16);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_DATA_ITERATOR_H
@@ -0,0 +1,85 @@
+/// @file
+/// @brief data source generating a synthetic observation on the fly
+/// @details This data source allows gridders, solvers and other consumers to be 
+/// benchmarked without disk effects. Chunks with realistic uvw, pointing and frequency
+/// metadata and visibilities of a point source sky model are generated in memory by a 
+/// number of background threads (see SyntheticObservation) and delivered through the
+/// usual accessor interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/SyntheticDataSource.h>
+#include <askap/dataaccess/SyntheticDataIterator.h>
+#include <askap/dataaccess/StreamDataSelector.h>
+#include <askap/dataaccess/BasicDataConverter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct the data source
+/// @param[in] obs observation to generate (copied)
+/// @param[in] nThreads number of threads generating the chunks of each iterator
+/// @param[in] capacity maximum number of generated chunks waiting for the consumer
+SyntheticDataSource::SyntheticDataSource(const SyntheticObservation &obs, size_t nThreads, size_t capacity) :
+        itsObservation(obs), itsNThreads(nThreads), itsCapacity(capacity)
+{
+  ASKAPCHECK(nThreads > 0, "At least one thread is required to generate synthetic data");
+  ASKAPCHECK(capacity > 0, "Capacity of the queue of synthetic chunks should be positive");
+}
+
+/// @brief create a converter object corresponding to this type of the DataSource
+/// @return a shared pointer to a new DataConverter object
+IDataConverterPtr SyntheticDataSource::createConverter() const
+{
+  return IDataConverterPtr(new BasicDataConverter);
+}
+
+/// @brief get an iterator over the synthetic observation
+/// @param[in] sel a shared pointer to the selector object (should be created by this 
+///            data source and left unchanged)
+/// @param[in] conv a shared pointer to the converter object (ignored)
+/// @return a shared pointer to SyntheticDataIterator object
+boost::shared_ptr<IConstDataIterator> SyntheticDataSource::createConstIterator(const
+	           IDataSelectorConstPtr &sel, const IDataConverterConstPtr &) const
+{
+  if (!boost::dynamic_pointer_cast<StreamDataSelector const>(sel)) {
+      ASKAPTHROW(DataAccessLogicError, "Selector passed to SyntheticDataSource should be created by the same class");
+  }
+  return boost::shared_ptr<IConstDataIterator>(new SyntheticDataIterator(itsObservation, itsNThreads, itsCapacity));
+}
+
+/// @brief create a selector object corresponding to this type of the DataSource
+/// @return a shared pointer to StreamDataSelector 
+IDataSelectorPtr SyntheticDataSource::createSelector() const
+{
+  return IDataSelectorPtr(new StreamDataSelector);
+}
+
+} // namespace accessors
+
+} // namespace askap
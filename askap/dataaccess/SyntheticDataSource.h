@@ -0,0 +1,100 @@
+/// @file
+/// @brief data source generating a synthetic observation on the fly
+/// @details This data source allows gridders, solvers and other consumers to be 
+/// benchmarked without disk effects. Chunks with realistic uvw, pointing and frequency
+/// metadata and visibilities of a point source sky model are generated in memory by a 
+/// number of background threads (see SyntheticObservation) and delivered through the
+/// usual accessor interface.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_SYNTHETIC_DATA_SOURCE_H
+
+// own includes
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/SyntheticObservation.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief data source generating a synthetic observation on the fly
+/// @details Every iterator generates the whole observation from the beginning with its
+/// own threads, so any number of iterators can be created. Data are delivered in the frames
+/// and units described in SyntheticObservation, the converter passed to createConstIterator
+/// is ignored. Selection is not supported either, the selector returned by createSelector 
+/// throws on any attempt to use it.
+/// @ingroup dataaccess_hlp
+class SyntheticDataSource : virtual public IConstDataSource
+{
+public:
+  /// @brief construct the data source
+  /// @param[in] obs observation to generate (copied)
+  /// @param[in] nThreads number of threads generating the chunks of each iterator
+  /// @param[in] capacity maximum number of generated chunks waiting for the consumer
+  explicit SyntheticDataSource(const SyntheticObservation &obs = SyntheticObservation(), 
+                               size_t nThreads = 1, size_t capacity = 16);
+
+  /// @brief create a converter object corresponding to this type of the DataSource
+  /// @return a shared pointer to a new DataConverter object
+  virtual IDataConverterPtr createConverter() const;
+
+  /// @brief get an iterator over the synthetic observation
+  /// @param[in] sel a shared pointer to the selector object (should be created by this 
+  ///            data source and left unchanged)
+  /// @param[in] conv a shared pointer to the converter object (ignored)
+  /// @return a shared pointer to SyntheticDataIterator object
+  virtual boost::shared_ptr<IConstDataIterator> createConstIterator(const
+	           IDataSelectorConstPtr &sel, const
+		   IDataConverterConstPtr &conv) const;
+
+  // we need this to get access to the overloaded syntax in the base class
+  using IConstDataSource::createConstIterator;
+
+  /// @brief create a selector object corresponding to this type of the DataSource
+  /// @return a shared pointer to StreamDataSelector 
+  virtual IDataSelectorPtr createSelector() const;
+
+  /// @brief observation generated by this data source
+  /// @return a reference to the description of the observation
+  inline const SyntheticObservation& observation() const { return itsObservation; }
+
+private:
+  /// @brief observation to generate
+  SyntheticObservation itsObservation;
+
+  /// @brief number of threads generating the chunks of each iterator
+  size_t itsNThreads;
+
+  /// @brief maximum number of generated chunks waiting for the consumer
+  size_t itsCapacity;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_DATA_SOURCE_H
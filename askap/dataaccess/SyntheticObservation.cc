@@ -0,0 +1,341 @@
+/// @file
+/// @brief description of a synthetic observation
+/// @details This class holds the parameters of a simulated observation (array layout,
+/// spectral axis, beams, integrations and a sky model of point sources) and generates
+/// chunks of data for it on demand. It is used by SyntheticDataSource to benchmark
+/// gridders and solvers without any disk access.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/dataaccess/SyntheticObservation.h>
+#include <askap/dataaccess/ColumnarDataAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <cmath>
+#include <complex>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief rotation rate of the Earth w.r.t. the stars in radians per second
+const casacore::Double siderealRate = 7.2921158553e-5;
+
+/// @brief check whether the polarisation product gets the Stokes I flux
+/// @param[in] stokes polarisation product
+/// @return true for the parallel-hand products and Stokes I
+bool isParallelHand(casacore::Stokes::StokesTypes stokes)
+{
+  return (stokes == casacore::Stokes::XX) || (stokes == casacore::Stokes::YY) || 
+         (stokes == casacore::Stokes::RR) || (stokes == casacore::Stokes::LL) || 
+         (stokes == casacore::Stokes::I);
+}
+
+} // anonymous namespace
+
+/// @brief set up the default observation
+/// @details The default is 36 antennas within 3 km, one beam, 16 channels of 1 MHz
+/// starting at 1.4 GHz, 4 linear polarisation products, 10 integrations of 10 seconds
+/// and a 1 Jy source at the phase centre (RA=0, Dec=-45 deg) observed at latitude -26.7 deg.
+SyntheticObservation::SyntheticObservation() : itsStartFreq(1.4e9), itsChannelWidth(1e6), 
+      itsNChannel(16), itsBeamOffsets(1, std::make_pair(0., 0.)), itsStokes(4), 
+      itsStartTime(60000. * 86400.), itsInterval(10.), itsNIntegrations(10),
+      itsPhaseCentre(0., -casacore::C::pi / 4.), itsLatitude(-26.7 * casacore::C::pi / 180.),
+      itsNoise(1.)
+{
+  setSpiralArray(36, 3000.);
+  itsStokes[0] = casacore::Stokes::XX;
+  itsStokes[1] = casacore::Stokes::XY;
+  itsStokes[2] = casacore::Stokes::YX;
+  itsStokes[3] = casacore::Stokes::YY;
+  addPointSource(0., 0., 1.);
+}
+
+/// @brief set the antenna positions
+/// @param[in] positions positions in metres w.r.t. the array centre (east, north, up)
+void SyntheticObservation::setAntennas(const std::vector<casacore::RigidVector<casacore::Double, 3> > &positions)
+{
+  ASKAPCHECK(positions.size() > 1, "At least two antennas are required, you have "<<positions.size());
+  itsAntennas = positions;
+}
+
+/// @brief place antennas on a spiral
+/// @details The layout gives a reasonably uniform uv-coverage for any number of antennas
+/// @param[in] nAntennas number of antennas
+/// @param[in] radius radius of the array in metres
+void SyntheticObservation::setSpiralArray(casacore::uInt nAntennas, casacore::Double radius)
+{
+  ASKAPCHECK(radius > 0., "Array radius should be positive, you have "<<radius);
+  std::vector<casacore::RigidVector<casacore::Double, 3> > positions(nAntennas);
+  // Fermat spiral with the golden angle between successive antennas
+  const casacore::Double goldenAngle = casacore::C::pi * (3. - std::sqrt(5.));
+  for (casacore::uInt ant = 0; ant < nAntennas; ++ant) {
+       const casacore::Double r = radius * std::sqrt((ant + 0.5) / nAntennas);
+       const casacore::Double angle = ant * goldenAngle;
+       positions[ant](0) = r * std::cos(angle);
+       positions[ant](1) = r * std::sin(angle);
+       positions[ant](2) = 0.;
+  }
+  setAntennas(positions);
+}
+
+/// @brief set the spectral axis
+/// @param[in] startFreq frequency of the first channel in Hz
+/// @param[in] width channel width in Hz
+/// @param[in] nChannel number of channels
+void SyntheticObservation::setSpectralAxis(casacore::Double startFreq, casacore::Double width, casacore::uInt nChannel)
+{
+  ASKAPCHECK(startFreq > 0., "Frequency should be positive, you have "<<startFreq);
+  ASKAPCHECK(nChannel > 0, "At least one spectral channel is required");
+  ASKAPCHECK(startFreq + width * (nChannel - 1) > 0., "Frequency of the last channel should be positive");
+  itsStartFreq = startFreq;
+  itsChannelWidth = width;
+  itsNChannel = nChannel;
+}
+
+/// @brief set the beam offsets
+/// @param[in] offsets offsets of the beam pointing from the phase centre in radians 
+/// (along the right ascension and declination), one element per beam
+void SyntheticObservation::setBeamOffsets(const std::vector<std::pair<casacore::Double, casacore::Double> > &offsets)
+{
+  ASKAPCHECK(offsets.size() > 0, "At least one beam is required");
+  itsBeamOffsets = offsets;
+}
+
+/// @brief set the polarisation products
+/// @param[in] stokes polarisation products of the visibility cube
+void SyntheticObservation::setPolarisations(const casacore::Vector<casacore::Stokes::StokesTypes> &stokes)
+{
+  ASKAPCHECK(stokes.nelements() > 0, "At least one polarisation product is required");
+  itsStokes.resize(stokes.nelements());
+  itsStokes = stokes;
+}
+
+/// @brief set the time axis
+/// @param[in] startTime time of the start of the observation in seconds since MJD 0
+/// @param[in] interval integration time in seconds
+/// @param[in] nIntegrations number of integrations
+void SyntheticObservation::setTimeAxis(casacore::Double startTime, casacore::Double interval, casacore::uInt nIntegrations)
+{
+  ASKAPCHECK(interval > 0., "Integration time should be positive, you have "<<interval);
+  itsStartTime = startTime;
+  itsInterval = interval;
+  itsNIntegrations = nIntegrations;
+}
+
+/// @brief set the phase centre
+/// @param[in] dir phase centre (J2000)
+void SyntheticObservation::setPhaseCentre(const casacore::MVDirection &dir)
+{
+  itsPhaseCentre = dir;
+}
+
+/// @brief set the latitude of the array
+/// @param[in] latitude latitude in radians
+void SyntheticObservation::setLatitude(casacore::Double latitude)
+{
+  itsLatitude = latitude;
+}
+
+/// @brief set the noise figure
+/// @param[in] sigma noise figure returned for all elements
+void SyntheticObservation::setNoise(casacore::Float sigma)
+{
+  itsNoise = sigma;
+}
+
+/// @brief remove all sources from the sky model
+void SyntheticObservation::clearSky()
+{
+  itsSky.clear();
+}
+
+/// @brief add a point source to the sky model
+/// @param[in] l direction cosine along the right ascension w.r.t. the phase centre
+/// @param[in] m direction cosine along the declination w.r.t. the phase centre
+/// @param[in] flux flux density in Jy at the centre of the band
+/// @param[in] spectralIndex spectral index
+void SyntheticObservation::addPointSource(casacore::Double l, casacore::Double m, casacore::Double flux, 
+                                          casacore::Double spectralIndex)
+{
+  ASKAPCHECK(l * l + m * m < 1., "Source at l="<<l<<" m="<<m<<" is beyond the horizon of the phase centre");
+  PointSource src;
+  src.itsL = l;
+  src.itsM = m;
+  src.itsFlux = flux;
+  src.itsSpectralIndex = spectralIndex;
+  itsSky.push_back(src);
+}
+
+/// @brief time stamp of an integration
+/// @param[in] integration integration index
+/// @return the middle of the integration in seconds since MJD 0
+casacore::Double SyntheticObservation::time(casacore::uInt integration) const
+{
+  return itsStartTime + (integration + 0.5) * itsInterval;
+}
+
+/// @brief hour angle of the phase centre
+/// @param[in] integration integration index
+/// @return hour angle in radians at the middle of the integration
+casacore::Double SyntheticObservation::hourAngle(casacore::uInt integration) const
+{
+  const casacore::Double transit = itsStartTime + 0.5 * itsNIntegrations * itsInterval;
+  return siderealRate * (time(integration) - transit);
+}
+
+/// @brief generate one chunk
+/// @details This method is thread-safe, chunks can be generated in any order
+/// @param[in] integration integration index
+/// @param[in] acc accessor to fill (all fields are replaced)
+void SyntheticObservation::fill(casacore::uInt integration, ColumnarDataAccessor &acc) const
+{
+  ASKAPCHECK(integration < itsNIntegrations, "Integration "<<integration<<" is beyond the end of the observation ("<<
+             itsNIntegrations<<" integrations)");
+  const casacore::uInt nAnt = nAntennas();
+  const casacore::uInt nRows = nRow();
+  const casacore::uInt nChan = nChannel();
+  const casacore::uInt nPols = nPol();
+
+  acc.itsTime = time(integration);
+  acc.itsFrequency.resize(nChan);
+  for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+       acc.itsFrequency[chan] = itsStartFreq + chan * itsChannelWidth;
+  }
+  acc.itsStokes.resize(nPols);
+  acc.itsStokes = itsStokes;
+
+  // uvw of each antenna w.r.t. the array centre, baselines are differences
+  const casacore::Double ha = hourAngle(integration);
+  const casacore::Double dec = itsPhaseCentre.getLat();
+  const casacore::Double sinH = std::sin(ha), cosH = std::cos(ha);
+  const casacore::Double sinD = std::sin(dec), cosD = std::cos(dec);
+  const casacore::Double sinLat = std::sin(itsLatitude), cosLat = std::cos(itsLatitude);
+  std::vector<casacore::RigidVector<casacore::Double, 3> > antUVW(nAnt);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const casacore::RigidVector<casacore::Double, 3> &enu = itsAntennas[ant];
+       // local east-north-up to the equatorial frame (X towards the meridian, Z towards the pole)
+       const casacore::Double x = -sinLat * enu(1) + cosLat * enu(2);
+       const casacore::Double y = enu(0);
+       const casacore::Double z = cosLat * enu(1) + sinLat * enu(2);
+       antUVW[ant](0) = sinH * x + cosH * y;
+       antUVW[ant](1) = -sinD * cosH * x + sinD * sinH * y + cosD * z;
+       antUVW[ant](2) = cosD * cosH * x - cosD * sinH * y + sinD * z;
+  }
+  const casacore::Float pa = static_cast<casacore::Float>(std::atan2(sinH * cosLat, 
+                             sinLat * cosD - cosLat * sinD * cosH));
+
+  acc.itsAntenna1.resize(nRows);
+  acc.itsAntenna2.resize(nRows);
+  acc.itsFeed1.resize(nRows);
+  acc.itsFeed2.resize(nRows);
+  acc.itsFeed1PA.resize(nRows);
+  acc.itsFeed2PA.resize(nRows);
+  acc.itsPointingDir1.resize(nRows);
+  acc.itsPointingDir2.resize(nRows);
+  acc.itsDishPointing1.resize(nRows);
+  acc.itsDishPointing2.resize(nRows);
+  acc.itsUVW.resize(nRows);
+  acc.itsFeed1PA.set(pa);
+  acc.itsFeed2PA.set(pa);
+  acc.itsDishPointing1.set(itsPhaseCentre);
+  acc.itsDishPointing2.set(itsPhaseCentre);
+  casacore::uInt row = 0;
+  for (casacore::uInt beam = 0; beam < nBeams(); ++beam) {
+       casacore::MVDirection pointing(itsPhaseCentre);
+       pointing.shift(itsBeamOffsets[beam].first, itsBeamOffsets[beam].second, casacore::True);
+       for (casacore::uInt ant1 = 0; ant1 < nAnt; ++ant1) {
+            for (casacore::uInt ant2 = ant1 + 1; ant2 < nAnt; ++ant2, ++row) {
+                 acc.itsAntenna1[row] = ant1;
+                 acc.itsAntenna2[row] = ant2;
+                 acc.itsFeed1[row] = beam;
+                 acc.itsFeed2[row] = beam;
+                 acc.itsPointingDir1[row] = pointing;
+                 acc.itsPointingDir2[row] = pointing;
+                 acc.itsUVW[row] = antUVW[ant2] - antUVW[ant1];
+            }
+       }
+  }
+  ASKAPDEBUGASSERT(row == nRows);
+
+  acc.itsVisibility.resize(nRows, nChan, nPols);
+  acc.itsVisibility.set(casacore::Complex(0., 0.));
+  acc.itsFlag.resize(nRows, nChan, nPols);
+  acc.itsFlag.set(casacore::False);
+  acc.itsNoise.resize(nRows, nChan, nPols);
+  acc.itsNoise.set(casacore::Complex(itsNoise, itsNoise));
+  std::vector<casacore::uInt> parallelHands;
+  for (casacore::uInt pol = 0; pol < nPols; ++pol) {
+       if (isParallelHand(itsStokes[pol])) {
+           parallelHands.push_back(pol);
+       }
+  }
+  if ((parallelHands.size() > 0) && (nRows > 0)) {
+      // channels are equidistant, so the phasor of each row is advanced by a constant 
+      // factor from one channel to the next; the innermost loop runs over rows,
+      // which are contiguous in the cube
+      const casacore::Double centreFreq = itsStartFreq + 0.5 * (nChan - 1) * itsChannelWidth;
+      std::vector<std::complex<casacore::Double> > phasor(nRows);
+      std::vector<std::complex<casacore::Double> > step(nRows);
+      std::vector<casacore::Double> spectrum(nChan);
+      casacore::Complex *visPtr = acc.itsVisibility.data();
+      for (std::vector<PointSource>::const_iterator ci = itsSky.begin(); ci != itsSky.end(); ++ci) {
+           const casacore::Double nMinusOne = std::sqrt(1. - ci->itsL * ci->itsL - ci->itsM * ci->itsM) - 1.;
+           for (row = 0; row < nRows; ++row) {
+                const casacore::RigidVector<casacore::Double, 3> &uvw = acc.itsUVW[row];
+                const casacore::Double phasePerHz = -2. * casacore::C::pi * (uvw(0) * ci->itsL + 
+                             uvw(1) * ci->itsM + uvw(2) * nMinusOne) / casacore::C::c;
+                phasor[row] = std::polar(1., phasePerHz * itsStartFreq);
+                step[row] = std::polar(1., phasePerHz * itsChannelWidth);
+           }
+           for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                spectrum[chan] = ci->itsFlux * std::pow(acc.itsFrequency[chan] / centreFreq, ci->itsSpectralIndex);
+           }
+           for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                for (row = 0; row < nRows; ++row) {
+                     const std::complex<casacore::Double> value = spectrum[chan] * phasor[row];
+                     const casacore::Complex fValue(static_cast<casacore::Float>(value.real()), 
+                                                    static_cast<casacore::Float>(value.imag()));
+                     for (std::vector<casacore::uInt>::const_iterator pol = parallelHands.begin(); 
+                          pol != parallelHands.end(); ++pol) {
+                          visPtr[row + size_t(nRows) * (chan + size_t(nChan) * (*pol))] += fValue;
+                     }
+                     phasor[row] *= step[row];
+                }
+           }
+      }
+  }
+  acc.invalidate();
+}
+
+} // namespace accessors
+
+} // namespace askap
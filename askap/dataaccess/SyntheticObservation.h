@@ -0,0 +1,230 @@
+/// @file
+/// @brief description of a synthetic observation
+/// @details This class holds the parameters of a simulated observation (array layout,
+/// spectral axis, beams, integrations and a sky model of point sources) and generates
+/// chunks of data for it on demand. It is used by SyntheticDataSource to benchmark
+/// gridders and solvers without any disk access.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_OBSERVATION_H
+#define ASKAP_ACCESSORS_SYNTHETIC_OBSERVATION_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/measures/Measures/Stokes.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// std includes
+#include <utility>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+class ColumnarDataAccessor;
+
+/// @brief description of a synthetic observation
+/// @details The observation consists of a number of integrations, each of them delivered
+/// as one chunk with all beams and cross-correlations (beam is the slowest varying index, 
+/// baselines follow in the order 0-1, 0-2, ..., 1-2, ...). Antenna positions are given in 
+/// the local east-north-up frame; uvw are computed for the common phase centre from the hour
+/// angle, which changes with the sidereal rate. The observation is centred on the transit of
+/// the phase centre. Beams have a common phase centre and differ by the pointing direction
+/// (the dish pointing is the phase centre). Visibilities are the sum of point sources (no 
+/// primary beam attenuation, Stokes I only, so the cross-hand products are zero) with the
+/// phase -2 pi (ul + vm + w(n-1)) / lambda, where uvw = pos(antenna2) - pos(antenna1).
+/// Nothing is flagged and the noise figure is the same for all elements. 
+/// Times are in seconds since MJD 0 (UTC), frequencies in Hz and directions in J2000. 
+/// The generation of one chunk is independent of the others, so chunks can be produced 
+/// in parallel.
+/// @ingroup dataaccess_hlp
+class SyntheticObservation
+{
+public:
+  /// @brief point source of the sky model
+  struct PointSource {
+    /// @brief direction cosine along the right ascension w.r.t. the phase centre
+    casacore::Double itsL;
+    /// @brief direction cosine along the declination w.r.t. the phase centre
+    casacore::Double itsM;
+    /// @brief flux density in Jy at the centre of the band
+    casacore::Double itsFlux;
+    /// @brief spectral index
+    casacore::Double itsSpectralIndex;
+  };
+
+  /// @brief set up the default observation
+  /// @details The default is 36 antennas within 3 km, one beam, 16 channels of 1 MHz
+  /// starting at 1.4 GHz, 4 linear polarisation products, 10 integrations of 10 seconds
+  /// and a 1 Jy source at the phase centre (RA=0, Dec=-45 deg) observed at latitude -26.7 deg.
+  SyntheticObservation();
+
+  /// @brief set the antenna positions
+  /// @param[in] positions positions in metres w.r.t. the array centre (east, north, up)
+  void setAntennas(const std::vector<casacore::RigidVector<casacore::Double, 3> > &positions);
+
+  /// @brief place antennas on a spiral
+  /// @details The layout gives a reasonably uniform uv-coverage for any number of antennas
+  /// @param[in] nAntennas number of antennas
+  /// @param[in] radius radius of the array in metres
+  void setSpiralArray(casacore::uInt nAntennas, casacore::Double radius);
+
+  /// @brief set the spectral axis
+  /// @param[in] startFreq frequency of the first channel in Hz
+  /// @param[in] width channel width in Hz
+  /// @param[in] nChannel number of channels
+  void setSpectralAxis(casacore::Double startFreq, casacore::Double width, casacore::uInt nChannel);
+
+  /// @brief set the beam offsets
+  /// @param[in] offsets offsets of the beam pointing from the phase centre in radians 
+  /// (along the right ascension and declination), one element per beam
+  void setBeamOffsets(const std::vector<std::pair<casacore::Double, casacore::Double> > &offsets);
+
+  /// @brief set the polarisation products
+  /// @param[in] stokes polarisation products of the visibility cube
+  void setPolarisations(const casacore::Vector<casacore::Stokes::StokesTypes> &stokes);
+
+  /// @brief set the time axis
+  /// @param[in] startTime time of the start of the observation in seconds since MJD 0
+  /// @param[in] interval integration time in seconds
+  /// @param[in] nIntegrations number of integrations
+  void setTimeAxis(casacore::Double startTime, casacore::Double interval, casacore::uInt nIntegrations);
+
+  /// @brief set the phase centre
+  /// @param[in] dir phase centre (J2000)
+  void setPhaseCentre(const casacore::MVDirection &dir);
+
+  /// @brief set the latitude of the array
+  /// @param[in] latitude latitude in radians
+  void setLatitude(casacore::Double latitude);
+
+  /// @brief set the noise figure
+  /// @param[in] sigma noise figure returned for all elements
+  void setNoise(casacore::Float sigma);
+
+  /// @brief remove all sources from the sky model
+  void clearSky();
+
+  /// @brief add a point source to the sky model
+  /// @param[in] l direction cosine along the right ascension w.r.t. the phase centre
+  /// @param[in] m direction cosine along the declination w.r.t. the phase centre
+  /// @param[in] flux flux density in Jy at the centre of the band
+  /// @param[in] spectralIndex spectral index
+  void addPointSource(casacore::Double l, casacore::Double m, casacore::Double flux, 
+                      casacore::Double spectralIndex = 0.);
+
+  /// @return number of antennas
+  inline casacore::uInt nAntennas() const { return casacore::uInt(itsAntennas.size()); }
+
+  /// @return number of cross-correlations per beam
+  inline casacore::uInt nBaselines() const { return nAntennas() * (nAntennas() - 1) / 2; }
+
+  /// @return number of beams
+  inline casacore::uInt nBeams() const { return casacore::uInt(itsBeamOffsets.size()); }
+
+  /// @return number of rows in each chunk
+  inline casacore::uInt nRow() const { return nBeams() * nBaselines(); }
+
+  /// @return number of spectral channels
+  inline casacore::uInt nChannel() const { return itsNChannel; }
+
+  /// @return number of polarisation products
+  inline casacore::uInt nPol() const { return casacore::uInt(itsStokes.nelements()); }
+
+  /// @return number of integrations (i.e. chunks)
+  inline casacore::uInt nIntegrations() const { return itsNIntegrations; }
+
+  /// @return phase centre (J2000)
+  inline const casacore::MVDirection& phaseCentre() const { return itsPhaseCentre; }
+
+  /// @return point sources of the sky model
+  inline const std::vector<PointSource>& sky() const { return itsSky; }
+
+  /// @brief time stamp of an integration
+  /// @param[in] integration integration index
+  /// @return the middle of the integration in seconds since MJD 0
+  casacore::Double time(casacore::uInt integration) const;
+
+  /// @brief hour angle of the phase centre
+  /// @param[in] integration integration index
+  /// @return hour angle in radians at the middle of the integration
+  casacore::Double hourAngle(casacore::uInt integration) const;
+
+  /// @brief generate one chunk
+  /// @details This method is thread-safe, chunks can be generated in any order
+  /// @param[in] integration integration index
+  /// @param[in] acc accessor to fill (all fields are replaced)
+  void fill(casacore::uInt integration, ColumnarDataAccessor &acc) const;
+
+private:
+  /// @brief antenna positions (east, north, up) in metres
+  std::vector<casacore::RigidVector<casacore::Double, 3> > itsAntennas;
+
+  /// @brief frequency of the first channel in Hz
+  casacore::Double itsStartFreq;
+
+  /// @brief channel width in Hz
+  casacore::Double itsChannelWidth;
+
+  /// @brief number of channels
+  casacore::uInt itsNChannel;
+
+  /// @brief beam offsets in radians
+  std::vector<std::pair<casacore::Double, casacore::Double> > itsBeamOffsets;
+
+  /// @brief polarisation products
+  casacore::Vector<casacore::Stokes::StokesTypes> itsStokes;
+
+  /// @brief start time in seconds since MJD 0
+  casacore::Double itsStartTime;
+
+  /// @brief integration time in seconds
+  casacore::Double itsInterval;
+
+  /// @brief number of integrations
+  casacore::uInt itsNIntegrations;
+
+  /// @brief phase centre
+  casacore::MVDirection itsPhaseCentre;
+
+  /// @brief latitude in radians
+  casacore::Double itsLatitude;
+
+  /// @brief noise figure
+  casacore::Float itsNoise;
+
+  /// @brief sky model
+  std::vector<PointSource> itsSky;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_OBSERVATION_H
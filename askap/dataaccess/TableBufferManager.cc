@@ -78,3 +78,39 @@ bool TableBufferManager::bufferExists(const std::string &name,
 {
   return cellDefined<casacore::Complex>(name,index);
 }
+
+/// @brief tile shape for a buffer column
+/// @details The tile covers the whole cell (one row) unless it exceeds 
+/// the size limit, in which case the slowest varying axes are halved. 
+/// @param[in] cellShape shape of the cube stored in the buffer
+/// @param[in] elementSize size of one element in bytes
+/// @return shape of the tile (cell shape with the row axis appended)
+casacore::IPosition TableBufferManager::tileShape(const casacore::IPosition &cellShape, 
+                                                size_t elementSize)
+{
+  ASKAPDEBUGASSERT(cellShape.nelements() == 3);
+  // 4 MB per tile keeps the tile cache small, but is large enough to give
+  // sequential I/O for typical chunks
+  const size_t maxTileSize = 4u * 1024u * 1024u;
+  casacore::IPosition shape(4, cellShape[0], cellShape[1], cellShape[2], 1);
+  for (int axis = 2; axis >= 0; --axis) {
+       while ((shape[axis] > 1) && (size_t(shape.product()) * elementSize > maxTileSize)) {
+              shape[axis] = (shape[axis] + 1) / 2;
+       }
+  }
+  return shape;
+}
+
+/// @brief tile shape for a new column
+/// @details This method is called when a new column is created by writeCube
+/// for a disk-based table. It can be overridden if the access pattern for
+/// some columns is known. The default implementation calls tileShape.
+/// @param[in] name name of the column
+/// @param[in] cellShape shape of the cube written first
+/// @param[in] elementSize size of one element in bytes
+/// @return shape of the tile (cell shape with the row axis appended)
+casacore::IPosition TableBufferManager::columnTileShape(const std::string &, 
+                 const casacore::IPosition &cellShape, size_t elementSize) const
+{
+  return tileShape(cellShape, elementSize);
+}
@@ -36,6 +36,8 @@
 #include <askap/dataaccess/TableHolder.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Slicer.h>
 
 
 namespace askap {
@@ -93,6 +95,27 @@ protected:
   template<typename T>
   void readCube(casacore::Cube<T> &cube, const std::string &name,
 			    casacore::uInt index) const;
+
+  /// @brief populate the cube with a part of the given table cell
+  /// @details Only the requested slice is read from the table, which
+  /// is much cheaper than reading the whole cell if just a small part is needed.
+  /// The method throws an exception if the requested table cell does not exist
+  /// @param[in] cube a reference to a cube of some type
+  /// @param[in] name a name of the column to work with
+  /// @param[in] index row number
+  /// @param[in] slicer slice of the cell to read
+  template<typename T>
+  void readCubeSlice(casacore::Cube<T> &cube, const std::string &name,
+			    casacore::uInt index, const casacore::Slicer &slicer) const;
+
+  /// @brief obtain the shape of the given table cell
+  /// @details The method throws an exception if the requested table cell
+  /// does not exist
+  /// @param[in] name a name of the column to work with
+  /// @param[in] index row number
+  /// @return shape of the cube stored in the cell
+  template<typename T>
+  casacore::IPosition cellShape(const std::string &name, casacore::uInt index) const;
   
   /// @brief write the cube back to the table
   /// @details The table cell is populated with values on the first write 
@@ -112,6 +135,25 @@ protected:
   template<typename T>
   bool cellDefined(const std::string &name,
 			      casacore::uInt index) const;  			   
+
+  /// @brief tile shape for a buffer column
+  /// @details The tile covers the whole cell (one row) unless it exceeds 
+  /// the size limit, in which case the slowest varying axes are halved. 
+  /// @param[in] cellShape shape of the cube stored in the buffer
+  /// @param[in] elementSize size of one element in bytes
+  /// @return shape of the tile (cell shape with the row axis appended)
+  static casacore::IPosition tileShape(const casacore::IPosition &cellShape, size_t elementSize);
+
+  /// @brief tile shape for a new column
+  /// @details This method is called when a new column is created by writeCube
+  /// for a disk-based table. It can be overridden if the access pattern for
+  /// some columns is known. The default implementation calls tileShape.
+  /// @param[in] name name of the column
+  /// @param[in] cellShape shape of the cube written first
+  /// @param[in] elementSize size of one element in bytes
+  /// @return shape of the tile (cell shape with the row axis appended)
+  virtual casacore::IPosition columnTileShape(const std::string &name, 
+                 const casacore::IPosition &cellShape, size_t elementSize) const;
 };
 
 } // namespace accessors
@@ -32,6 +32,8 @@
 // CASA includes
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
 
 // own includes
 #include <askap/dataaccess/DataAccessError.h>
@@ -60,9 +62,47 @@ void TableBufferManager::readCube(casa::Cube<T> &cube, const std::string &name,
  bufCol.get(index,cube,casa::True);
 }
 
+/// @brief populate the cube with a part of the given table cell
+/// @details Only the requested slice is read from the table, which
+/// is much cheaper than reading the whole cell if just a small part is needed.
+/// The method throws an exception if the requested table cell does not exist
+/// @param[in] cube a reference to a cube of some type
+/// @param[in] name a name of the column to work with
+/// @param[in] index row number
+/// @param[in] slicer slice of the cell to read
+template<typename T>
+void TableBufferManager::readCubeSlice(casa::Cube<T> &cube, const std::string &name,
+			    casa::uInt index, const casa::Slicer &slicer) const
+{ 
+ ASKAPDEBUGASSERT(table().actualTableDesc().isColumn(name));
+ ASKAPDEBUGASSERT(index<table().nrow());
+ typename casa::ROArrayColumn<T> bufCol(table(),name);
+ ASKAPASSERT(bufCol.ndim(index) == 3); // only cubes should be in buffers
+ bufCol.getSlice(index,slicer,cube,casa::True);
+}
+
+/// @brief obtain the shape of the given table cell
+/// @details The method throws an exception if the requested table cell
+/// does not exist
+/// @param[in] name a name of the column to work with
+/// @param[in] index row number
+/// @return shape of the cube stored in the cell
+template<typename T>
+casa::IPosition TableBufferManager::cellShape(const std::string &name, casa::uInt index) const
+{
+ ASKAPDEBUGASSERT(table().actualTableDesc().isColumn(name));
+ ASKAPDEBUGASSERT(index<table().nrow());
+ typename casa::ROArrayColumn<T> bufCol(table(),name);
+ ASKAPASSERT(bufCol.ndim(index) == 3); // only cubes should be in buffers
+ return bufCol.shape(index);
+}
+
 /// @brief write the cube back to the table
 /// @details The table cell is populated with values on the first write 
-/// operation
+/// operation. For disk-based tables, a new column is bound to its own 
+/// TiledShapeStMan with tiles given by columnTileShape, by default matching
+/// the shape of the first cube written (i.e. the chunk shape of the iterator),
+/// so each buffer cell is read and written as a few large contiguous blocks.
 /// @param[in] cube to take the data from 
 /// @param[in] name a name of the column to work with
 /// @param[in] index row number
@@ -75,7 +115,16 @@ void TableBufferManager::writeCube(const casa::Cube<T> &cube, const std::string
       typename casa::ArrayColumnDesc<T> newColDesc(name,
            "Writable buffer managed by the dataaccess layer",3);
       newColDesc.rwKeywordSet().define("UNIT","Jy");
-      table().addColumn(newColDesc);
+      if (table().tableType() == casa::Table::Memory) {
+          table().addColumn(newColDesc);
+      } else {
+          const std::string hypercolumn = "TiledBuffer_"+name;
+          casa::TableDesc td;
+          td.addColumn(newColDesc);
+          td.defineHypercolumn(hypercolumn, 4, casa::Vector<casa::String>(1, name));
+          casa::TiledShapeStMan stMan(hypercolumn, columnTileShape(name, cube.shape(), sizeof(T)));
+          table().addColumn(td, stMan);
+      }
   }
   if (table().nrow()<=index) {
       table().addRow(index-table().nrow()+1);
@@ -0,0 +1,155 @@
+/// @file
+/// @brief index of chunks delivered by the table-based iterator
+/// @details The table-based iterator goes through the data with a table iterator
+/// over TIME and splits each time step into chunks with uniform DATA_DESC_ID and FIELD_ID
+/// not exceeding the maximum chunk size. This class repeats the split once for the whole
+/// selection, reading only the TIME, DATA_DESC_ID and FIELD_ID columns, and records
+/// each chunk. It allows the iterator to jump to a given chunk or time stamp, e.g. to
+/// resume an interrupted job or to split the chunks between ranks.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/TableChunkIndex.h>
+#include <askap/dataaccess/TimeStepIterator.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief build the index
+/// @param[in] tab selected table the iterator works with
+/// @param[in] maxChunkSize maximum number of rows per chunk
+/// @param[in] useFieldID if true, chunks are broken when FIELD_ID changes
+/// @param[in] conv converter used to obtain the time stamps
+/// @param[in] maxRows maximum number of rows per chunk for individual data description IDs,
+/// maxChunkSize is used for data description IDs which are not present
+TableChunkIndex::TableChunkIndex(const casacore::Table &tab, casacore::uInt maxChunkSize, 
+                                 bool useFieldID, const IDataConverterImpl &conv,
+                                 const std::map<casacore::Int, casacore::uInt> &maxRows)
+{
+  ASKAPCHECK(maxChunkSize > 0, "Maximum chunk size should be positive");
+  // the same iteration as in TableConstDataIterator, columns are read once for the whole table
+  TimeStepIterator tabIt(tab);
+  if (tabIt.pastEnd()) {
+      return;
+  }
+  const casacore::Vector<casacore::Int> dataDescIDs = 
+        casacore::ROScalarColumn<casacore::Int>(tab, "DATA_DESC_ID").getColumn();
+  casacore::Vector<casacore::Int> fieldIDs;
+  if (useFieldID) {
+      fieldIDs.assign(casacore::ROScalarColumn<casacore::Int>(tab, "FIELD_ID").getColumn());
+  }
+  const casacore::ROScalarMeasColumn<casacore::MEpoch> timeCol(tab, "TIME");
+  for (casacore::uInt step = 0; !tabIt.pastEnd(); tabIt.next(), ++step) {
+       const casacore::uInt firstRow = tabIt.startRow();
+       const casacore::uInt nRow = tabIt.nrow();
+       // all rows of the step have the same time
+       const casacore::Double time = conv.epoch(timeCol(firstRow));
+       for (casacore::uInt topRow = 0; topRow < nRow; ) {
+            Chunk chunk;
+            chunk.itsStep = step;
+            chunk.itsTopRow = topRow;
+            chunk.itsFirstRow = firstRow + topRow;
+            chunk.itsTime = time;
+            chunk.itsDataDescID = dataDescIDs[firstRow + topRow];
+            chunk.itsFieldID = useFieldID ? fieldIDs[firstRow + topRow] : -1;
+            const std::map<casacore::Int, casacore::uInt>::const_iterator ci = maxRows.find(chunk.itsDataDescID);
+            const casacore::uInt maxNRow = ci != maxRows.end() ? ci->second : maxChunkSize;
+            ASKAPDEBUGASSERT(maxNRow > 0);
+            const casacore::uInt remainder = nRow - topRow;
+            chunk.itsNRow = remainder <= maxNRow ? remainder : maxNRow;
+            // break the chunk where DATA_DESC_ID or FIELD_ID change (see makeUniformDataDescID
+            // and makeUniformFieldID in TableConstDataIterator)
+            for (casacore::uInt row = 1; row < chunk.itsNRow; ++row) {
+                 if ((dataDescIDs[chunk.itsFirstRow + row] != chunk.itsDataDescID) || 
+                     (useFieldID && (fieldIDs[chunk.itsFirstRow + row] != chunk.itsFieldID))) {
+                     chunk.itsNRow = row;
+                     break;
+                 }
+            }
+            itsChunks.push_back(chunk);
+            topRow += chunk.itsNRow;
+       }
+  }
+}
+
+/// @brief obtain the description of a chunk
+/// @param[in] chunk chunk index (zero-based)
+/// @return description of the chunk
+const TableChunkIndex::Chunk& TableChunkIndex::chunk(casacore::uInt chunk) const
+{
+  ASKAPCHECK(chunk < itsChunks.size(), "Chunk "<<chunk<<" is outside the index of "<<itsChunks.size()<<" chunks");
+  return itsChunks[chunk];
+}
+
+/// @brief find the chunk starting at the given position
+/// @param[in] step iteration step of the table iterator
+/// @param[in] topRow first row of the chunk within the iteration
+/// @return chunk index or nChunks() if there is no such chunk
+casacore::uInt TableChunkIndex::find(casacore::uInt step, casacore::uInt topRow) const
+{
+  // chunks are sorted by step and top row, do the binary search
+  size_t low = 0;
+  size_t high = itsChunks.size();
+  while (low < high) {
+         const size_t mid = (low + high) / 2;
+         const Chunk &chunk = itsChunks[mid];
+         if ((chunk.itsStep < step) || ((chunk.itsStep == step) && (chunk.itsTopRow < topRow))) {
+             low = mid + 1;
+         } else {
+             high = mid;
+         }
+  }
+  if ((low < itsChunks.size()) && (itsChunks[low].itsStep == step) && (itsChunks[low].itsTopRow == topRow)) {
+      return casacore::uInt(low);
+  }
+  return nChunks();
+}
+
+/// @brief find the first chunk with the time stamp not earlier than the given time
+/// @details Chunks are searched in the iteration order, so the result is also well defined
+/// if the data are not time-ordered.
+/// @param[in] time time in the frame and units of the converter
+/// @return chunk index or nChunks() if all chunks are earlier than the given time
+casacore::uInt TableChunkIndex::findTime(casacore::Double time) const
+{
+  for (size_t chunk = 0; chunk < itsChunks.size(); ++chunk) {
+       if (itsChunks[chunk].itsTime >= time) {
+           return casacore::uInt(chunk);
+       }
+  }
+  return nChunks();
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,121 @@
+/// @file
+/// @brief index of chunks delivered by the table-based iterator
+/// @details The table-based iterator goes through the data with a table iterator
+/// over TIME and splits each time step into chunks with uniform DATA_DESC_ID and FIELD_ID
+/// not exceeding the maximum chunk size. This class repeats the split once for the whole
+/// selection, reading only the TIME, DATA_DESC_ID and FIELD_ID columns, and records
+/// each chunk. It allows the iterator to jump to a given chunk or time stamp, e.g. to
+/// resume an interrupted job or to split the chunks between ranks.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TABLE_CHUNK_INDEX_H
+#define ASKAP_ACCESSORS_TABLE_CHUNK_INDEX_H
+
+// std includes
+#include <map>
+#include <vector>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+
+// own includes
+#include <askap/dataaccess/IDataConverterImpl.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief index of chunks delivered by the table-based iterator
+/// @details Chunks are numbered in the iteration order. The index doesn't depend on the
+/// channel selection, so if channels are split into several ranges (tiles) by the iterator,
+/// each chunk corresponds to a number of iteration steps.
+/// @ingroup dataaccess_tab
+class TableChunkIndex {
+public:
+  /// @brief description of one chunk
+  struct Chunk {
+    /// @brief iteration step of the table iterator over TIME (zero-based)
+    casacore::uInt itsStep;
+    /// @brief first row of the chunk within the iteration of the table iterator
+    casacore::uInt itsTopRow;
+    /// @brief first row of the chunk in the selected table
+    casacore::uInt itsFirstRow;
+    /// @brief number of rows
+    casacore::uInt itsNRow;
+    /// @brief time stamp in the frame and units of the converter
+    casacore::Double itsTime;
+    /// @brief data description ID
+    casacore::Int itsDataDescID;
+    /// @brief field ID, -1 if FIELD_ID column is not used
+    casacore::Int itsFieldID;
+  };
+
+  /// @brief build the index
+  /// @param[in] tab selected table the iterator works with
+  /// @param[in] maxChunkSize maximum number of rows per chunk
+  /// @param[in] useFieldID if true, chunks are broken when FIELD_ID changes
+  /// @param[in] conv converter used to obtain the time stamps
+  /// @param[in] maxRows maximum number of rows per chunk for individual data description IDs,
+  /// maxChunkSize is used for data description IDs which are not present
+  TableChunkIndex(const casacore::Table &tab, casacore::uInt maxChunkSize, bool useFieldID,
+                  const IDataConverterImpl &conv, 
+                  const std::map<casacore::Int, casacore::uInt> &maxRows = 
+                        std::map<casacore::Int, casacore::uInt>());
+
+  /// @brief number of chunks
+  /// @return number of chunks in the index
+  inline casacore::uInt nChunks() const { return casacore::uInt(itsChunks.size()); }
+
+  /// @brief obtain the description of a chunk
+  /// @param[in] chunk chunk index (zero-based)
+  /// @return description of the chunk
+  const Chunk& chunk(casacore::uInt chunk) const;
+
+  /// @brief find the chunk starting at the given position
+  /// @param[in] step iteration step of the table iterator
+  /// @param[in] topRow first row of the chunk within the iteration
+  /// @return chunk index or nChunks() if there is no such chunk
+  casacore::uInt find(casacore::uInt step, casacore::uInt topRow) const;
+
+  /// @brief find the first chunk with the time stamp not earlier than the given time
+  /// @details Chunks are searched in the iteration order, so the result is also well defined
+  /// if the data are not time-ordered.
+  /// @param[in] time time in the frame and units of the converter
+  /// @return chunk index or nChunks() if all chunks are earlier than the given time
+  casacore::uInt findTime(casacore::Double time) const;
+
+private:
+  /// @brief chunks in the iteration order
+  std::vector<Chunk> itsChunks;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_CHUNK_INDEX_H
@@ -0,0 +1,513 @@
+/// @file
+/// @brief read-ahead of the bulk data for table-based iterators
+/// @details This class reads visibility, flag, noise and uvw data for
+/// the chunk following the current one in the background (as a latency-critical
+/// job of IOScheduler). It is used by TableConstDataIterator if the prefetch
+/// mode is switched on (see TableConstDataSource::configurePrefetch). The prefetcher has its own
+/// table iterator running over the same table as the main iterator, so the
+/// following chunk can be accessed without disturbing the state of the main
+/// iterator. The table system is not thread-safe, therefore the main iterator
+/// has to wait for the background job to finish before it touches the table
+/// itself. The buffers are double: the data for the current chunk are
+/// given out from one set while the other set is being filled.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+/// Local package
+#include <askap/dataaccess/TableChunkPrefetcher.h>
+#include <askap/dataaccess/CubeTransposer.h>
+#include <askap/dataaccess/ITableDataSelectorImpl.h>
+#include <askap/dataaccess/AccessTracer.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+// std includes
+#include <exception>
+
+ASKAP_LOGGER(logger, ".TableChunkPrefetcher");
+
+using namespace casa;
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief default constructor, buffers are empty
+TableChunkPrefetcher::ChunkBuffers::ChunkBuffers() : itsStep(0), itsTopRow(0),
+      itsNumberOfRows(0), itsNumberOfPols(0), itsNumberOfChannels(0), itsValid(false),
+      itsHasVisibility(false), itsHasFlag(false), itsHasNoise(false), itsHasUVW(false) {}
+
+/// @brief release all buffers
+void TableChunkPrefetcher::ChunkBuffers::clear()
+{
+  itsValid = false;
+  itsHasVisibility = false;
+  itsHasFlag = false;
+  itsHasNoise = false;
+  itsHasUVW = false;
+  // reference new empty arrays, so the storage given out earlier is not touched
+  itsVisibility.reference(casacore::Cube<casacore::Complex>());
+  itsFlag.reference(casacore::Cube<casacore::Bool>());
+  itsNoise.reference(casacore::Cube<casacore::Complex>());
+  itsUVW.reference(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >());
+}
+
+/// @brief take over the buffers of another object
+/// @details Arrays are referenced, the other object is cleared afterwards
+/// @param[in] other object to take the buffers from
+void TableChunkPrefetcher::ChunkBuffers::moveFrom(ChunkBuffers &other)
+{
+  itsStep = other.itsStep;
+  itsTopRow = other.itsTopRow;
+  itsNumberOfRows = other.itsNumberOfRows;
+  itsNumberOfPols = other.itsNumberOfPols;
+  itsNumberOfChannels = other.itsNumberOfChannels;
+  itsValid = other.itsValid;
+  itsHasVisibility = other.itsHasVisibility;
+  itsHasFlag = other.itsHasFlag;
+  itsHasNoise = other.itsHasNoise;
+  itsHasUVW = other.itsHasUVW;
+  itsVisibility.reference(other.itsVisibility);
+  itsFlag.reference(other.itsFlag);
+  itsNoise.reference(other.itsNoise);
+  itsUVW.reference(other.itsUVW);
+  other.clear();
+}
+
+/// @brief constructor
+/// @param[in] steps time steps to iterate over (should be the same steps of the same
+/// table the main iterator works with, i.e. with the selection applied)
+/// @param[in] dataColumn name of the data column to read
+/// @param[in] nativeLayout if true, cubes are prepared in the storage order
+/// (nPol x nChannel x nRow), otherwise in the accessor order (nRow x nChannel x nPol)
+/// @param[in] fields bulk data to read (ITableDataSelectorImpl::AccessorField values 
+/// or'ed together), other fields are skipped
+TableChunkPrefetcher::TableChunkPrefetcher(const TimeStepIterator &steps,
+           const std::string &dataColumn, bool nativeLayout, int fields) : itsIterator(steps),
+           itsIteratorStep(0), itsDataColumn(dataColumn), itsNativeLayout(nativeLayout),
+           itsFields(fields), itsHasRequest(false), itsRequestedStep(0), itsRequestedTopRow(0),
+           itsFirstRow(0), itsRequestedMaxRows(0), itsRequestedNPol(0), itsRequestedNChanTotal(0),
+           itsRequestedStartChan(0), itsRequestedNChan(0), itsStatistics(0)
+{
+  // the steps are counted from the start regardless of the position of the given iterator
+  itsIterator.reset();
+}
+
+/// @brief destructor, waits for the background job to finish
+TableChunkPrefetcher::~TableChunkPrefetcher()
+{
+  wait();
+}
+
+/// @brief start reading a chunk in the background
+/// @details Nothing is done if the same chunk has already been requested.
+/// The number of rows is only known when the table iteration is set up, therefore
+/// the chunk is defined by its first row and the maximum number of rows.
+/// @param[in] step iteration step of the table iterator (zero-based)
+/// @param[in] topRow first row of the chunk within the iteration
+/// @param[in] maxRows maximum number of rows per chunk
+/// @param[in] nPol number of polarisations
+/// @param[in] nChanTotal number of channels stored in the table
+/// @param[in] startChan first selected channel
+/// @param[in] nChan number of selected channels
+void TableChunkPrefetcher::start(casacore::uInt step, casacore::uInt topRow,
+             casacore::uInt maxRows, casacore::uInt nPol, casacore::uInt nChanTotal,
+             casacore::uInt startChan, casacore::uInt nChan)
+{
+  if (itsHasRequest && (itsRequestedStep == step) && (itsRequestedTopRow == topRow)) {
+      return;
+  }
+  wait();
+  itsHasRequest = true;
+  itsRequestedStep = step;
+  itsRequestedTopRow = topRow;
+  itsRequestedMaxRows = maxRows;
+  itsRequestedNPol = nPol;
+  itsRequestedNChanTotal = nChanTotal;
+  itsRequestedStartChan = startChan;
+  itsRequestedNChan = nChan;
+  itsPending.clear();
+  // the size of the visibility cube, other fields are small in comparison
+  const size_t bytes = size_t(maxRows) * nPol * nChan * sizeof(casacore::Complex);
+  itsJob = IOScheduler::instance().submit(IOScheduler::CRITICAL,
+                         boost::bind(&TableChunkPrefetcher::run, this), bytes);
+}
+
+/// @brief attach statistics
+/// @details If attached, the bytes read in the background are counted. This method
+/// waits for the background job, if any.
+/// @param[in] stats statistics to update (zero to detach), the object is not owned
+void TableChunkPrefetcher::setStatistics(IteratorStatistics *stats)
+{
+  wait();
+  itsStatistics = stats;
+}
+
+/// @brief restrict background reads to the given CPUs
+/// @details The affinity is applied to the I/O thread for the duration of each background
+/// read, so the data are read (and the pages first touched) on the given NUMA node. An empty
+/// set leaves the threads unrestricted. This method waits for the background job, if any.
+/// @param[in] affinity set of CPUs
+void TableChunkPrefetcher::setAffinity(const ThreadAffinity &affinity)
+{
+  wait();
+  itsAffinity = affinity;
+}
+
+/// @brief wait for the background job to finish
+/// @details It is necessary to call this method before any access to the table
+/// from the main thread. It does nothing if no job is running.
+void TableChunkPrefetcher::wait()
+{
+  if (itsJob.valid()) {
+      // time the consumer is stalled waiting for the read ahead
+      const AccessTracer::Scope trace("prefetchWait", "dataaccess");
+      itsJob.wait();
+      itsJob = IOScheduler::Future();
+  }
+}
+
+/// @brief make prefetched data available for the current chunk
+/// @details This method waits for the background job and checks that the data read
+/// correspond to the given chunk. If so, they become available via the get methods,
+/// otherwise all data are discarded.
+/// @param[in] step iteration step of the table iterator (zero-based)
+/// @param[in] topRow first row of the chunk within the iteration
+/// @param[in] nRow number of rows in the chunk
+/// @param[in] nPol number of polarisations
+/// @param[in] nChan number of selected channels
+void TableChunkPrefetcher::acceptChunk(casacore::uInt step, casacore::uInt topRow,
+             casacore::uInt nRow, casacore::uInt nPol, casacore::uInt nChan)
+{
+  wait();
+  itsHasRequest = false;
+  itsReady.clear();
+  if (itsPending.itsValid && (itsPending.itsStep == step) && (itsPending.itsTopRow == topRow) &&
+      (itsPending.itsNumberOfRows == nRow) && (itsPending.itsNumberOfPols == nPol) &&
+      (itsPending.itsNumberOfChannels == nChan)) {
+      itsReady.moveFrom(itsPending);
+  }
+  itsPending.clear();
+}
+
+/// @brief obtain prefetched visibilities
+/// @details The data are given out only once, the buffer is referenced
+/// @param[out] vis cube to reference the prefetched data
+/// @return true, if the data were available, false otherwise (the parameter is not changed)
+bool TableChunkPrefetcher::getVisibility(casacore::Cube<casacore::Complex> &vis)
+{
+  if (!itsReady.itsHasVisibility) {
+      return false;
+  }
+  vis.reference(itsReady.itsVisibility);
+  itsReady.itsVisibility.reference(casacore::Cube<casacore::Complex>());
+  itsReady.itsHasVisibility = false;
+  return true;
+}
+
+/// @brief obtain prefetched flags
+/// @details The data are given out only once, the buffer is referenced
+/// @param[out] flag cube to reference the prefetched data
+/// @return true, if the data were available, false otherwise (the parameter is not changed)
+bool TableChunkPrefetcher::getFlag(casacore::Cube<casacore::Bool> &flag)
+{
+  if (!itsReady.itsHasFlag) {
+      return false;
+  }
+  flag.reference(itsReady.itsFlag);
+  itsReady.itsFlag.reference(casacore::Cube<casacore::Bool>());
+  itsReady.itsHasFlag = false;
+  return true;
+}
+
+/// @brief obtain prefetched noise
+/// @details The data are given out only once, the buffer is referenced
+/// @param[out] noise cube to reference the prefetched data
+/// @return true, if the data were available, false otherwise (the parameter is not changed)
+bool TableChunkPrefetcher::getNoise(casacore::Cube<casacore::Complex> &noise)
+{
+  if (!itsReady.itsHasNoise) {
+      return false;
+  }
+  noise.reference(itsReady.itsNoise);
+  itsReady.itsNoise.reference(casacore::Cube<casacore::Complex>());
+  itsReady.itsHasNoise = false;
+  return true;
+}
+
+/// @brief obtain prefetched uvw
+/// @details The data are given out only once, the buffer is referenced
+/// @param[out] uvw vector to reference the prefetched data
+/// @return true, if the data were available, false otherwise (the parameter is not changed)
+bool TableChunkPrefetcher::getUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw)
+{
+  if (!itsReady.itsHasUVW) {
+      return false;
+  }
+  uvw.reference(itsReady.itsUVW);
+  itsReady.itsUVW.reference(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >());
+  itsReady.itsHasUVW = false;
+  return true;
+}
+
+/// @brief body of the background job
+/// @details Any exception is caught and results in empty buffers, so the main
+/// iterator would read the data itself (and report the problem, if it is persistent).
+/// The I/O thread is shared with other jobs, so its affinity is restored at the end.
+void TableChunkPrefetcher::run()
+{
+  const AccessTracer::Scope trace("prefetch", "dataaccess");
+  const ThreadAffinity previous = itsAffinity.empty() ? ThreadAffinity() : ThreadAffinity::ofCurrentThread();
+  try {
+     if (!itsAffinity.empty() && !itsAffinity.apply()) {
+         ASKAPLOG_DEBUG_STR(logger, "Unable to restrict the prefetch thread to "<<
+                            itsAffinity.cpus().size()<<" CPUs");
+     }
+     read();
+  }
+  catch (const std::exception &ex) {
+     ASKAPLOG_DEBUG_STR(logger, "Prefetch of step "<<itsRequestedStep<<", row "<<
+                        itsRequestedTopRow<<" failed: "<<ex.what());
+     itsPending.clear();
+  }
+  if (!previous.empty()) {
+      previous.apply();
+  }
+}
+
+/// @brief read the requested chunk into the pending buffers
+void TableChunkPrefetcher::read()
+{
+  if (itsIteratorStep > itsRequestedStep) {
+      // the main iterator has been restarted, start from scratch
+      itsIterator.reset();
+      itsIteratorStep = 0;
+  }
+  for (; (itsIteratorStep < itsRequestedStep) && !itsIterator.pastEnd(); ++itsIteratorStep) {
+       itsIterator.next();
+  }
+  if (itsIterator.pastEnd()) {
+      return;
+  }
+  // the whole table, the current step is a range of its rows
+  const casacore::Table iteration = itsIterator.table();
+  if (itsRequestedTopRow >= itsIterator.nrow()) {
+      return;
+  }
+  itsFirstRow = itsIterator.startRow() + itsRequestedTopRow;
+  const casacore::uInt remainder = itsIterator.nrow() - itsRequestedTopRow;
+  const casacore::uInt nRow = remainder <= itsRequestedMaxRows ? remainder : itsRequestedMaxRows;
+
+  if (itsFields & ITableDataSelectorImpl::VISIBILITY_FIELD) {
+      itsPending.itsHasVisibility = readNativeCube(iteration, itsDataColumn, nRow, itsPending.itsVisibility);
+  }
+
+  casacore::Cube<casacore::Bool> flag;
+  if ((itsFields & ITableDataSelectorImpl::FLAG_FIELD) && readNativeCube(iteration, "FLAG", nRow, flag)) {
+      if (iteration.tableDesc().isColumn("FLAG_ROW")) {
+          casacore::ROScalarColumn<casacore::Bool> flagRowCol(iteration, "FLAG_ROW");
+          const casacore::Vector<casacore::Bool> flagRow = flagRowCol.getColumnRange(
+                   Slicer(IPosition(1, itsFirstRow), IPosition(1, nRow)));
+          for (casacore::uInt row = 0; row < nRow; ++row) {
+               if (flagRow[row]) {
+                   flag.xyPlane(row) = true;
+               }
+          }
+      }
+      itsPending.itsFlag.reference(flag);
+      itsPending.itsHasFlag = true;
+  }
+
+  if (itsFields & ITableDataSelectorImpl::NOISE_FIELD) {
+      itsPending.itsHasNoise = readNoise(iteration, nRow, itsPending.itsNoise);
+  }
+  if (itsFields & ITableDataSelectorImpl::UVW_FIELD) {
+      itsPending.itsHasUVW = readUVW(iteration, nRow, itsPending.itsUVW);
+  }
+
+  if (!itsNativeLayout) {
+      // transposes are done here as well to offload the main thread
+      if (itsPending.itsHasVisibility) {
+          casacore::Cube<casacore::Complex> buf;
+          CubeTransposer::transpose(itsPending.itsVisibility, buf);
+          itsPending.itsVisibility.reference(buf);
+      }
+      if (itsPending.itsHasFlag) {
+          casacore::Cube<casacore::Bool> buf;
+          CubeTransposer::transpose(itsPending.itsFlag, buf);
+          itsPending.itsFlag.reference(buf);
+      }
+  }
+
+  itsPending.itsStep = itsRequestedStep;
+  itsPending.itsTopRow = itsRequestedTopRow;
+  itsPending.itsNumberOfRows = nRow;
+  itsPending.itsNumberOfPols = itsRequestedNPol;
+  itsPending.itsNumberOfChannels = itsRequestedNChan;
+  itsPending.itsValid = true;
+}
+
+/// @brief read an array column into a cube in the storage order
+/// @details Only the case where all cells have the shape nPol x nChanTotal is
+/// handled.
+/// @param[in] iteration table to read
+/// @param[in] columnName name of the column
+/// @param[in] nRow number of rows to read starting from the requested top row
+/// @param[out] cube nPol x nChan x nRow cube to fill
+/// @return true if successful, false if the cell shapes are not uniform
+template<typename T>
+bool TableChunkPrefetcher::readNativeCube(const casacore::Table &iteration,
+           const std::string &columnName, casacore::uInt nRow, casacore::Cube<T> &cube) const
+{
+  if (!iteration.tableDesc().isColumn(columnName)) {
+      return false;
+  }
+  casacore::ROArrayColumn<T> tableCol(iteration, columnName);
+  const casacore::IPosition expectedShape(2, itsRequestedNPol, itsRequestedNChanTotal);
+  const casacore::ColumnDesc &desc = tableCol.columnDesc();
+  if (desc.isFixedShape()) {
+      if (!desc.shape().isEqual(expectedShape)) {
+          return false;
+      }
+  } else {
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           if (!tableCol.isDefined(row + itsFirstRow) ||
+               !tableCol.shape(row + itsFirstRow).isEqual(expectedShape)) {
+               return false;
+           }
+      }
+  }
+  const Slicer chanSlicer(Slice(), Slice(itsRequestedStartChan, itsRequestedNChan));
+  const Slicer rowSlicer(IPosition(1, itsFirstRow), IPosition(1, nRow));
+  casacore::Cube<T> buf(itsRequestedNPol, itsRequestedNChan, nRow);
+  tableCol.getColumnRange(rowSlicer, chanSlicer, buf, False);
+  if (itsStatistics != 0) {
+      itsStatistics->addRead(columnName, buf.nelements() * sizeof(T));
+  }
+  cube.reference(buf);
+  return true;
+}
+
+/// @brief read noise figures
+/// @param[in] iteration table to read
+/// @param[in] nRow number of rows to read starting from the requested top row
+/// @param[out] noise noise cube in the required order
+/// @return true if successful, false if the noise is given in an unsupported form
+bool TableChunkPrefetcher::readNoise(const casacore::Table &iteration, casacore::uInt nRow,
+           casacore::Cube<casacore::Complex> &noise) const
+{
+  const casacore::uInt nPol = itsRequestedNPol;
+  const casacore::uInt nChan = itsRequestedNChan;
+  casacore::Cube<casacore::Complex> buf;
+  if (iteration.tableDesc().isColumn("SIGMA_SPECTRUM")) {
+      casacore::Cube<casacore::Float> sigma;
+      if (!readNativeCube(iteration, "SIGMA_SPECTRUM", nRow, sigma)) {
+          return false;
+      }
+      if (itsNativeLayout) {
+          buf.resize(sigma.shape());
+          casacore::Cube<casacore::Float>::const_iterator ci = sigma.begin();
+          for (casacore::Cube<casacore::Complex>::iterator it = buf.begin(); it != buf.end(); ++it,++ci) {
+               // same noise for both real and imaginary parts
+               *it = casacore::Complex(*ci,*ci);
+          }
+      } else {
+          CubeTransposer::transpose(sigma, buf);
+      }
+  } else if (iteration.tableDesc().isColumn("SIGMA")) {
+      casacore::ROArrayColumn<casacore::Float> sigmaCol(iteration, "SIGMA");
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           const casacore::IPosition shape = sigmaCol.shape(row + itsFirstRow);
+           if ((shape.size() != 1) || (shape[0] != casacore::Int(nPol))) {
+               return false;
+           }
+      }
+      const Slicer rowSlicer(IPosition(1, itsFirstRow), IPosition(1, nRow));
+      casacore::Matrix<casacore::Float> sigma(nPol, nRow);
+      sigmaCol.getColumnRange(rowSlicer, sigma, False);
+      if (itsStatistics != 0) {
+          itsStatistics->addRead("SIGMA", sigma.nelements() * sizeof(casacore::Float));
+      }
+      casacore::Cube<casacore::Complex> accessorOrder(nRow, nChan, nPol);
+      CubeTransposer::broadcast(sigma, accessorOrder);
+      if (itsNativeLayout) {
+          CubeTransposer::transpose(accessorOrder, buf);
+      } else {
+          buf.reference(accessorOrder);
+      }
+  } else {
+      // default action - assign 1.
+      if (itsNativeLayout) {
+          buf.resize(nPol, nChan, nRow);
+      } else {
+          buf.resize(nRow, nChan, nPol);
+      }
+      buf.set(casacore::Complex(1.,1.));
+  }
+  noise.reference(buf);
+  return true;
+}
+
+/// @brief read uvw
+/// @param[in] iteration table to read
+/// @param[in] nRow number of rows to read starting from the requested top row
+/// @param[out] uvw vector to fill
+/// @return true if successful, false if the cell shapes are not uniform
+bool TableChunkPrefetcher::readUVW(const casacore::Table &iteration, casacore::uInt nRow,
+           casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw) const
+{
+  casacore::ROArrayColumn<casacore::Double> uvwCol(iteration, "UVW");
+  const casacore::ColumnDesc &uvwDesc = uvwCol.columnDesc();
+  if (!uvwDesc.isFixedShape() || !uvwDesc.shape().isEqual(casacore::IPosition(1,3))) {
+      return false;
+  }
+  const Slicer rowSlicer(IPosition(1, itsFirstRow), IPosition(1, nRow));
+  casacore::Matrix<casacore::Double> buf(3, nRow);
+  uvwCol.getColumnRange(rowSlicer, buf, False);
+  if (itsStatistics != 0) {
+      itsStatistics->addRead("UVW", buf.nelements() * sizeof(casacore::Double));
+  }
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > result(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       casacore::RigidVector<casacore::Double, 3> &rowUVW = result[row];
+       rowUVW(0) = buf(0,row);
+       rowUVW(1) = buf(1,row);
+       rowUVW(2) = buf(2,row);
+  }
+  uvw.reference(result);
+  return true;
+}
@@ -0,0 +1,309 @@
+/// @file
+/// @brief read-ahead of the bulk data for table-based iterators
+/// @details This class reads visibility, flag, noise and uvw data for
+/// the chunk following the current one in the background (as a latency-critical
+/// job of IOScheduler). It is used by TableConstDataIterator if the prefetch
+/// mode is switched on (see TableConstDataSource::configurePrefetch). The prefetcher has its own
+/// table iterator running over the same table as the main iterator, so the
+/// following chunk can be accessed without disturbing the state of the main
+/// iterator. The table system is not thread-safe, therefore the main iterator
+/// has to wait for the background job to finish before it touches the table
+/// itself. The buffers are double: the data for the current chunk are
+/// given out from one set while the other set is being filled.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TABLE_CHUNK_PREFETCHER_H
+#define ASKAP_ACCESSORS_TABLE_CHUNK_PREFETCHER_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+#include <casacore/tables/Tables/Table.h>
+
+// own includes
+#include <askap/dataaccess/IOScheduler.h>
+#include <askap/dataaccess/IteratorStatistics.h>
+#include <askap/dataaccess/ThreadAffinity.h>
+#include <askap/dataaccess/TimeStepIterator.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief read-ahead of the bulk data for table-based iterators
+/// @details This class reads visibility, flag, noise and uvw data for
+/// the chunk following the current one as a job of the I/O scheduler of the
+/// process (see IOScheduler), which runs it ahead of bulk writes. Only the
+/// simple (and most common) cases are handled: all cells of the chunk should
+/// have the same shape and noise should be given either by SIGMA_SPECTRUM or
+/// by SIGMA per polarisation (or should be absent). If some quantity can't be
+/// prefetched, the iterator reads it from the table in the usual way.
+/// All methods are supposed to be called from the thread which owns the iterator.
+/// @ingroup dataaccess_tab
+class TableChunkPrefetcher : private boost::noncopyable {
+public:
+
+  /// @brief constructor
+  /// @param[in] steps time steps to iterate over (should be the same steps of the same
+  /// table the main iterator works with, i.e. with the selection applied)
+  /// @param[in] dataColumn name of the data column to read
+  /// @param[in] nativeLayout if true, cubes are prepared in the storage order
+  /// (nPol x nChannel x nRow), otherwise in the accessor order (nRow x nChannel x nPol)
+  /// @param[in] fields bulk data to read (ITableDataSelectorImpl::AccessorField values 
+  /// or'ed together), other fields are skipped
+  TableChunkPrefetcher(const TimeStepIterator &steps, const std::string &dataColumn,
+                       bool nativeLayout, int fields);
+
+  /// @brief destructor, waits for the background job to finish
+  ~TableChunkPrefetcher();
+
+  /// @brief start reading a chunk in the background
+  /// @details Nothing is done if the same chunk has already been requested.
+  /// The number of rows is only known when the table iteration is set up, therefore
+  /// the chunk is defined by its first row and the maximum number of rows.
+  /// @param[in] step iteration step of the table iterator (zero-based)
+  /// @param[in] topRow first row of the chunk within the iteration
+  /// @param[in] maxRows maximum number of rows per chunk
+  /// @param[in] nPol number of polarisations
+  /// @param[in] nChanTotal number of channels stored in the table
+  /// @param[in] startChan first selected channel
+  /// @param[in] nChan number of selected channels
+  void start(casacore::uInt step, casacore::uInt topRow, casacore::uInt maxRows,
+             casacore::uInt nPol, casacore::uInt nChanTotal, casacore::uInt startChan,
+             casacore::uInt nChan);
+
+  /// @brief attach statistics
+  /// @details If attached, the bytes read in the background are counted. This method
+  /// waits for the background job, if any.
+  /// @param[in] stats statistics to update (zero to detach), the object is not owned
+  void setStatistics(IteratorStatistics *stats);
+
+  /// @brief restrict background reads to the given CPUs
+  /// @details The affinity is applied to the I/O thread for the duration of each background
+  /// read, so the data are read (and the pages first touched) on the given NUMA node. An empty
+  /// set leaves the threads unrestricted. This method waits for the background job, if any.
+  /// @param[in] affinity set of CPUs
+  void setAffinity(const ThreadAffinity &affinity);
+
+  /// @brief wait for the background job to finish
+  /// @details It is necessary to call this method before any access to the table
+  /// from the main thread. It does nothing if no job is running.
+  void wait();
+
+  /// @brief make prefetched data available for the current chunk
+  /// @details This method waits for the background job and checks that the data read
+  /// correspond to the given chunk. If so, they become available via the get methods,
+  /// otherwise all data are discarded.
+  /// @param[in] step iteration step of the table iterator (zero-based)
+  /// @param[in] topRow first row of the chunk within the iteration
+  /// @param[in] nRow number of rows in the chunk
+  /// @param[in] nPol number of polarisations
+  /// @param[in] nChan number of selected channels
+  void acceptChunk(casacore::uInt step, casacore::uInt topRow, casacore::uInt nRow,
+                   casacore::uInt nPol, casacore::uInt nChan);
+
+  /// @brief obtain prefetched visibilities
+  /// @details The data are given out only once, the buffer is referenced
+  /// @param[out] vis cube to reference the prefetched data
+  /// @return true, if the data were available, false otherwise (the parameter is not changed)
+  bool getVisibility(casacore::Cube<casacore::Complex> &vis);
+
+  /// @brief obtain prefetched flags
+  /// @details The data are given out only once, the buffer is referenced
+  /// @param[out] flag cube to reference the prefetched data
+  /// @return true, if the data were available, false otherwise (the parameter is not changed)
+  bool getFlag(casacore::Cube<casacore::Bool> &flag);
+
+  /// @brief obtain prefetched noise
+  /// @details The data are given out only once, the buffer is referenced
+  /// @param[out] noise cube to reference the prefetched data
+  /// @return true, if the data were available, false otherwise (the parameter is not changed)
+  bool getNoise(casacore::Cube<casacore::Complex> &noise);
+
+  /// @brief obtain prefetched uvw
+  /// @details The data are given out only once, the buffer is referenced
+  /// @param[out] uvw vector to reference the prefetched data
+  /// @return true, if the data were available, false otherwise (the parameter is not changed)
+  bool getUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw);
+
+protected:
+  /// @brief set of buffers for one chunk
+  struct ChunkBuffers {
+     /// @brief default constructor, buffers are empty
+     ChunkBuffers();
+
+     /// @brief release all buffers
+     void clear();
+
+     /// @brief take over the buffers of another object
+     /// @details Arrays are referenced, the other object is cleared afterwards
+     /// @param[in] other object to take the buffers from
+     void moveFrom(ChunkBuffers &other);
+
+     /// @brief iteration step the data correspond to
+     casacore::uInt itsStep;
+     /// @brief first row of the chunk
+     casacore::uInt itsTopRow;
+     /// @brief number of rows in the chunk
+     casacore::uInt itsNumberOfRows;
+     /// @brief number of polarisations
+     casacore::uInt itsNumberOfPols;
+     /// @brief number of selected channels
+     casacore::uInt itsNumberOfChannels;
+     /// @brief true, if the buffers correspond to some chunk
+     bool itsValid;
+
+     /// @brief visibility cube
+     casacore::Cube<casacore::Complex> itsVisibility;
+     /// @brief flag cube
+     casacore::Cube<casacore::Bool> itsFlag;
+     /// @brief noise cube
+     casacore::Cube<casacore::Complex> itsNoise;
+     /// @brief uvw
+     casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+
+     /// @brief true if visibilities are available
+     bool itsHasVisibility;
+     /// @brief true if flags are available
+     bool itsHasFlag;
+     /// @brief true if noise is available
+     bool itsHasNoise;
+     /// @brief true if uvw are available
+     bool itsHasUVW;
+  };
+
+  /// @brief body of the background job
+  /// @details Any exception is caught and results in empty buffers, so the main
+  /// iterator would read the data itself (and report the problem, if it is persistent)
+  void run();
+
+  /// @brief read the requested chunk into the pending buffers
+  void read();
+
+  /// @brief read an array column into a cube in the storage order
+  /// @details Only the case where all cells have the shape nPol x nChanTotal is
+  /// handled.
+  /// @param[in] iteration table to read
+  /// @param[in] columnName name of the column
+  /// @param[in] nRow number of rows to read starting from the requested top row
+  /// @param[out] cube nPol x nChan x nRow cube to fill
+  /// @return true if successful, false if the cell shapes are not uniform
+  template<typename T>
+  bool readNativeCube(const casacore::Table &iteration, const std::string &columnName,
+                      casacore::uInt nRow, casacore::Cube<T> &cube) const;
+
+  /// @brief read noise figures
+  /// @param[in] iteration table to read
+  /// @param[in] nRow number of rows to read starting from the requested top row
+  /// @param[out] noise noise cube in the required order
+  /// @return true if successful, false if the noise is given in an unsupported form
+  bool readNoise(const casacore::Table &iteration, casacore::uInt nRow,
+                 casacore::Cube<casacore::Complex> &noise) const;
+
+  /// @brief read uvw
+  /// @param[in] iteration table to read
+  /// @param[in] nRow number of rows to read starting from the requested top row
+  /// @param[out] uvw vector to fill
+  /// @return true if successful, false if the cell shapes are not uniform
+  bool readUVW(const casacore::Table &iteration, casacore::uInt nRow,
+               casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw) const;
+
+private:
+  /// @brief look-ahead iterator
+  TimeStepIterator itsIterator;
+
+  /// @brief iteration step the look-ahead iterator is at
+  casacore::uInt itsIteratorStep;
+
+  /// @brief name of the data column
+  std::string itsDataColumn;
+
+  /// @brief true, if cubes are prepared in the storage order
+  bool itsNativeLayout;
+
+  /// @brief bulk data to read, ITableDataSelectorImpl::AccessorField values or'ed together
+  int itsFields;
+
+  /// @brief true, if there is an outstanding request
+  bool itsHasRequest;
+
+  /// @brief requested iteration step
+  casacore::uInt itsRequestedStep;
+
+  /// @brief requested first row
+  casacore::uInt itsRequestedTopRow;
+
+  /// @brief first row of the chunk being read in the table
+  /// @details itsRequestedTopRow is counted from the start of the time step
+  casacore::uInt itsFirstRow;
+
+  /// @brief maximum number of rows for the request
+  casacore::uInt itsRequestedMaxRows;
+
+  /// @brief number of polarisations for the request
+  casacore::uInt itsRequestedNPol;
+
+  /// @brief total number of channels for the request
+  casacore::uInt itsRequestedNChanTotal;
+
+  /// @brief first selected channel for the request
+  casacore::uInt itsRequestedStartChan;
+
+  /// @brief number of selected channels for the request
+  casacore::uInt itsRequestedNChan;
+
+  /// @brief buffers being filled by the background job
+  ChunkBuffers itsPending;
+
+  /// @brief buffers for the current chunk
+  ChunkBuffers itsReady;
+
+  /// @brief statistics to update, zero if not attached
+  IteratorStatistics *itsStatistics;
+
+  /// @brief CPUs background threads are restricted to, empty for no restriction
+  ThreadAffinity itsAffinity;
+
+  /// @brief future of the background job, invalid if no job is running
+  IOScheduler::Future itsJob;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_CHUNK_PREFETCHER_H
@@ -0,0 +1,265 @@
+/// @file
+/// @brief write-behind of the bulk data for table-based iterators
+/// @details This class collects visibility and flag cubes of the chunks
+/// modified via the read-write iterator and writes them to the table in the
+/// background (as a job of IOScheduler). It is used by TableDataIterator if
+/// the write-behind mode is switched on (see TableDataSource::configureWriteBehind). The table system
+/// is not thread-safe, therefore the iterator has to wait for the background job
+/// to finish before it touches the table itself. The cubes are kept in the storage
+/// order (nPol x nChannel x nRow), so each chunk is written with a single bulk
+/// operation if all its cells have the same shape.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+/// Local package
+#include <askap/dataaccess/TableChunkWriter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/AccessTracer.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+// std includes
+#include <exception>
+
+ASKAP_LOGGER(logger, ".TableChunkWriter");
+
+using namespace casa;
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor
+TableChunkWriter::TableChunkWriter() {}
+
+/// @brief destructor, writes all queued chunks
+/// @details Errors are logged, rather than thrown
+TableChunkWriter::~TableChunkWriter()
+{
+  try {
+     sync();
+  }
+  catch (const std::exception &ex) {
+     ASKAPLOG_ERROR_STR(logger, "Deferred write of visibilities or flags failed: "<<ex.what());
+  }
+}
+
+/// @brief queue a visibility cube
+/// @param[in] iteration table to write to (current iteration of the table iterator)
+/// @param[in] column name of the column
+/// @param[in] topRow first row of the chunk within the iteration
+/// @param[in] startChan first channel to write
+/// @param[in] cube nPol x nChannel x nRow cube to write, it is referenced, so
+/// the caller should not change it afterwards
+/// @param[in] uniform true, if all cells of the chunk have the same shape 
+void TableChunkWriter::add(const casacore::Table &iteration, const std::string &column,
+           casacore::uInt topRow, casacore::uInt startChan, 
+           const casacore::Cube<casacore::Complex> &cube, bool uniform)
+{
+  addChunk(itsQueuedVis, iteration, column, topRow, startChan, cube, uniform);
+}
+
+/// @brief queue a flag cube
+/// @param[in] iteration table to write to (current iteration of the table iterator)
+/// @param[in] column name of the column
+/// @param[in] topRow first row of the chunk within the iteration
+/// @param[in] startChan first channel to write
+/// @param[in] cube nPol x nChannel x nRow cube to write, it is referenced, so
+/// the caller should not change it afterwards
+/// @param[in] uniform true, if all cells of the chunk have the same shape 
+void TableChunkWriter::add(const casacore::Table &iteration, const std::string &column,
+           casacore::uInt topRow, casacore::uInt startChan, 
+           const casacore::Cube<casacore::Bool> &cube, bool uniform)
+{
+  addChunk(itsQueuedFlags, iteration, column, topRow, startChan, cube, uniform);
+}
+
+/// @brief helper method to queue a chunk
+/// @param[in] queue queue to add the chunk to
+/// @param[in] iteration table to write to
+/// @param[in] column name of the column
+/// @param[in] topRow first row of the chunk within the iteration
+/// @param[in] startChan first channel to write
+/// @param[in] cube cube to write
+/// @param[in] uniform true, if all cells of the chunk have the same shape 
+template<typename T>
+void TableChunkWriter::addChunk(std::vector<Chunk<T> > &queue, const casacore::Table &iteration,
+           const std::string &column, casacore::uInt topRow, casacore::uInt startChan,
+           const casacore::Cube<T> &cube, bool uniform)
+{
+  queue.push_back(Chunk<T>());
+  Chunk<T> &chunk = queue.back();
+  chunk.itsIteration = iteration;
+  chunk.itsColumn = column;
+  chunk.itsTopRow = topRow;
+  chunk.itsStartChannel = startChan;
+  chunk.itsCube.reference(cube);
+  chunk.itsUniform = uniform;
+}
+
+/// @brief number of chunks waiting to be written
+/// @details Chunks being written by the background job are not counted
+/// @return number of queued cubes
+size_t TableChunkWriter::nQueued() const
+{
+  return itsQueuedVis.size() + itsQueuedFlags.size();
+}
+
+/// @brief start writing queued chunks in the background
+/// @details Nothing is done if there is nothing to write or a job is already running.
+void TableChunkWriter::start()
+{
+  if (itsJob.valid() || (nQueued() == 0)) {
+      return;
+  }
+  // the job owns the chunks it writes, new chunks can be queued in the meantime
+  itsPendingVis.swap(itsQueuedVis);
+  itsPendingFlags.swap(itsQueuedFlags);
+  size_t bytes = 0;
+  for (size_t i = 0; i < itsPendingVis.size(); ++i) {
+       bytes += itsPendingVis[i].itsCube.nelements() * sizeof(casacore::Complex);
+  }
+  for (size_t i = 0; i < itsPendingFlags.size(); ++i) {
+       bytes += itsPendingFlags[i].itsCube.nelements() * sizeof(casacore::Bool);
+  }
+  itsJob = IOScheduler::instance().submit(IOScheduler::NORMAL, boost::bind(&TableChunkWriter::run, this), bytes);
+}
+
+/// @brief wait for the background job to finish
+/// @details It is necessary to call this method before any access to the table
+/// from the main thread. It does nothing if no job is running. An exception is
+/// thrown if the job failed.
+void TableChunkWriter::wait()
+{
+  if (itsJob.valid()) {
+      // time the main thread is stalled waiting for the deferred write
+      const AccessTracer::Scope trace("writeBehindWait", "dataaccess");
+      itsJob.wait();
+      itsJob = IOScheduler::Future();
+  }
+  if (itsError.size()) {
+      const std::string msg = itsError;
+      itsError.clear();
+      ASKAPTHROW(DataAccessError, "Deferred write to the table failed: "<<msg);
+  }
+}
+
+/// @brief write all queued chunks
+/// @details This is the barrier: the table is up to date when the method returns.
+/// An exception is thrown if any write has failed.
+void TableChunkWriter::sync()
+{
+  wait();
+  start();
+  wait();
+}
+
+/// @brief body of the background job
+/// @details Any exception is caught and the message is kept to be reported
+/// by the main thread
+void TableChunkWriter::run()
+{
+  const AccessTracer::Scope trace("writeBehind", "dataaccess");
+  try {
+     writeChunks(itsPendingVis);
+     writeChunks(itsPendingFlags);
+  }
+  catch (const std::exception &ex) {
+     itsError = ex.what();
+  }
+  itsPendingVis.clear();
+  itsPendingFlags.clear();
+}
+
+/// @brief write given chunks
+/// @param[in] chunks chunks to write
+template<typename T>
+void TableChunkWriter::writeChunks(const std::vector<Chunk<T> > &chunks)
+{
+  for (typename std::vector<Chunk<T> >::const_iterator ci = chunks.begin(); ci != chunks.end(); ++ci) {
+       casacore::ArrayColumn<T> col(ci->itsIteration, ci->itsColumn);
+       write(col, ci->itsTopRow, ci->itsStartChannel, ci->itsCube, ci->itsUniform);
+  }
+}
+
+/// @brief write a cube in the storage order to an array column
+/// @details This is the actual writer used by both the background job and the
+/// synchronous write of the iterator.
+/// @param[in] col column to write
+/// @param[in] topRow first row of the chunk within the table the column belongs to
+/// @param[in] startChan first channel to write
+/// @param[in] cube nPol x nChannel x nRow cube to write
+/// @param[in] uniform true, if all cells of the chunk have the same shape 
+template<typename T>
+void TableChunkWriter::write(casacore::ArrayColumn<T> &col, casacore::uInt topRow,
+           casacore::uInt startChan, const casacore::Cube<T> &cube, bool uniform)
+{
+  const casacore::uInt nChan = cube.ncolumn();
+  // Setup a slicer to write the specified channel range only
+  const casacore::Slicer chanSlicer(casacore::Slice(),casacore::Slice(startChan,nChan));
+  if (uniform) {
+      // all rows have the same shape, write them in one go
+      const casacore::Slicer rowSlicer(casacore::IPosition(1, topRow),
+                                       casacore::IPosition(1, cube.nplane()));
+      col.putColumnRange(rowSlicer, chanSlicer, cube);
+      return;
+  }
+  casacore::uInt tableRow = topRow;
+  for (casacore::uInt row=0; row<cube.nplane(); ++row,++tableRow) {
+       const casacore::IPosition shape = col.shape(tableRow);
+       const casacore::uInt thisRowNumberOfChannels = shape.size()>1 ? shape[1] : 1;
+       const bool useSlicer = (startChan!=0) || (startChan+nChan!=thisRowNumberOfChannels);
+       // xy-plane of the contiguous cube references its storage
+       const casacore::Matrix<T> rowBuf = cube.xyPlane(row);
+       if (useSlicer) {
+           col.putSlice(tableRow,chanSlicer,rowBuf);
+       } else {
+           col.put(tableRow, rowBuf);
+       }
+  }
+}
+
+namespace askap {
+
+namespace accessors {
+
+// instantiate the writer for the types of the columns the iterator writes to
+template void TableChunkWriter::write(casacore::ArrayColumn<casacore::Complex> &col, casacore::uInt topRow,
+           casacore::uInt startChan, const casacore::Cube<casacore::Complex> &cube, bool uniform);
+template void TableChunkWriter::write(casacore::ArrayColumn<casacore::Bool> &col, casacore::uInt topRow,
+           casacore::uInt startChan, const casacore::Cube<casacore::Bool> &cube, bool uniform);
+
+} // namespace accessors
+
+} // namespace askap
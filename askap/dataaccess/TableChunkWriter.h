@@ -0,0 +1,200 @@
+/// @file
+/// @brief write-behind of the bulk data for table-based iterators
+/// @details This class collects visibility and flag cubes of the chunks
+/// modified via the read-write iterator and writes them to the table in the
+/// background (as a job of IOScheduler). It is used by TableDataIterator if
+/// the write-behind mode is switched on (see TableDataSource::configureWriteBehind). The table system
+/// is not thread-safe, therefore the iterator has to wait for the background job
+/// to finish before it touches the table itself. The cubes are kept in the storage
+/// order (nPol x nChannel x nRow), so each chunk is written with a single bulk
+/// operation if all its cells have the same shape.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TABLE_CHUNK_WRITER_H
+#define ASKAP_ACCESSORS_TABLE_CHUNK_WRITER_H
+
+// std includes
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+
+// own includes
+#include <askap/dataaccess/IOScheduler.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief write-behind of the bulk data for table-based iterators
+/// @details Cubes given to this class are queued and written to the table later,
+/// either by an explicit sync or by a background job started via the start method.
+/// The iterator starts the job when it doesn't need the table for a while, i.e. when
+/// the bulk data of the current chunk have been read. The job runs on the threads of
+/// the I/O scheduler of the process in the normal priority class. Errors encountered by the 
+/// background job are reported by the next call to wait or sync.
+/// All methods are supposed to be called from the thread which owns the iterator.
+/// @ingroup dataaccess_tab
+class TableChunkWriter : private boost::noncopyable {
+public:
+
+  /// @brief constructor
+  TableChunkWriter();
+
+  /// @brief destructor, writes all queued chunks
+  /// @details Errors are logged, rather than thrown
+  ~TableChunkWriter();
+
+  /// @brief queue a visibility cube
+  /// @param[in] iteration table to write to (current iteration of the table iterator)
+  /// @param[in] column name of the column
+  /// @param[in] topRow first row of the chunk within the iteration
+  /// @param[in] startChan first channel to write
+  /// @param[in] cube nPol x nChannel x nRow cube to write, it is referenced, so
+  /// the caller should not change it afterwards
+  /// @param[in] uniform true, if all cells of the chunk have the same shape 
+  void add(const casacore::Table &iteration, const std::string &column, casacore::uInt topRow,
+           casacore::uInt startChan, const casacore::Cube<casacore::Complex> &cube, bool uniform);
+
+  /// @brief queue a flag cube
+  /// @param[in] iteration table to write to (current iteration of the table iterator)
+  /// @param[in] column name of the column
+  /// @param[in] topRow first row of the chunk within the iteration
+  /// @param[in] startChan first channel to write
+  /// @param[in] cube nPol x nChannel x nRow cube to write, it is referenced, so
+  /// the caller should not change it afterwards
+  /// @param[in] uniform true, if all cells of the chunk have the same shape 
+  void add(const casacore::Table &iteration, const std::string &column, casacore::uInt topRow,
+           casacore::uInt startChan, const casacore::Cube<casacore::Bool> &cube, bool uniform);
+
+  /// @brief number of chunks waiting to be written
+  /// @details Chunks being written by the background job are not counted
+  /// @return number of queued cubes
+  size_t nQueued() const;
+
+  /// @brief start writing queued chunks in the background
+  /// @details Nothing is done if there is nothing to write or a job is already running.
+  void start();
+
+  /// @brief wait for the background job to finish
+  /// @details It is necessary to call this method before any access to the table
+  /// from the main thread. It does nothing if no job is running. An exception is
+  /// thrown if the job failed.
+  void wait();
+
+  /// @brief write all queued chunks
+  /// @details This is the barrier: the table is up to date when the method returns.
+  /// An exception is thrown if any write has failed.
+  void sync();
+
+  /// @brief write a cube in the storage order to an array column
+  /// @details This is the actual writer used by both the background job and the
+  /// synchronous write of the iterator.
+  /// @param[in] col column to write
+  /// @param[in] topRow first row of the chunk within the table the column belongs to
+  /// @param[in] startChan first channel to write
+  /// @param[in] cube nPol x nChannel x nRow cube to write
+  /// @param[in] uniform true, if all cells of the chunk have the same shape 
+  template<typename T>
+  static void write(casacore::ArrayColumn<T> &col, casacore::uInt topRow, casacore::uInt startChan,
+                    const casacore::Cube<T> &cube, bool uniform);
+
+protected:
+  /// @brief one queued chunk
+  template<typename T>
+  struct Chunk {
+     /// @brief table to write to
+     casacore::Table itsIteration;
+     /// @brief name of the column
+     std::string itsColumn;
+     /// @brief first row of the chunk
+     casacore::uInt itsTopRow;
+     /// @brief first channel
+     casacore::uInt itsStartChannel;
+     /// @brief cube to write
+     casacore::Cube<T> itsCube;
+     /// @brief true, if all cells have the same shape
+     bool itsUniform;
+  };
+
+  /// @brief body of the background job
+  /// @details Any exception is caught and the message is kept to be reported
+  /// by the main thread
+  void run();
+
+  /// @brief write given chunks
+  /// @param[in] chunks chunks to write
+  template<typename T>
+  static void writeChunks(const std::vector<Chunk<T> > &chunks);
+
+  /// @brief helper method to queue a chunk
+  /// @param[in] queue queue to add the chunk to
+  /// @param[in] iteration table to write to
+  /// @param[in] column name of the column
+  /// @param[in] topRow first row of the chunk within the iteration
+  /// @param[in] startChan first channel to write
+  /// @param[in] cube cube to write
+  /// @param[in] uniform true, if all cells of the chunk have the same shape 
+  template<typename T>
+  static void addChunk(std::vector<Chunk<T> > &queue, const casacore::Table &iteration,
+                       const std::string &column, casacore::uInt topRow, casacore::uInt startChan,
+                       const casacore::Cube<T> &cube, bool uniform);
+
+private:
+  /// @brief queued visibility cubes
+  std::vector<Chunk<casacore::Complex> > itsQueuedVis;
+
+  /// @brief queued flag cubes
+  std::vector<Chunk<casacore::Bool> > itsQueuedFlags;
+
+  /// @brief visibility cubes being written by the background job
+  std::vector<Chunk<casacore::Complex> > itsPendingVis;
+
+  /// @brief flag cubes being written by the background job
+  std::vector<Chunk<casacore::Bool> > itsPendingFlags;
+
+  /// @brief error message of the last failed job, empty if there was no error
+  std::string itsError;
+
+  /// @brief future of the background job, invalid if no job is running
+  IOScheduler::Future itsJob;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_CHUNK_WRITER_H
@@ -87,6 +87,100 @@ const casacore::Cube<casacore::Bool>& TableConstDataAccessor::flag() const
   return itsFlag.value(itsIterator, &TableConstDataIterator::fillFlag);
 }
 
+/// @brief visibilities in the storage order
+/// @return a reference to nPol x nChannel x nRow cube, containing
+/// all visibility data
+const casacore::Cube<casacore::Complex>& TableConstDataAccessor::nativeVisibility() const
+{
+  return itsNativeVisibility.value(itsIterator,
+                        &TableConstDataIterator::fillNativeVisibility);
+}
+
+/// @brief flags in the storage order
+/// @return a reference to nPol x nChannel x nRow cube with flag 
+///         information. If True, the corresponding element is flagged.
+const casacore::Cube<casacore::Bool>& TableConstDataAccessor::nativeFlag() const
+{
+  return itsNativeFlag.value(itsIterator, &TableConstDataIterator::fillNativeFlag);
+}
+
+/// @brief noise figures in the storage order
+/// @return a reference to nPol x nChannel x nRow cube with
+///         complex noise estimates
+const casacore::Cube<casacore::Complex>& TableConstDataAccessor::nativeNoise() const
+{
+  return itsNativeNoise.value(itsIterator, &TableConstDataIterator::fillNativeNoise);
+}
+
+/// @brief obtain the type of the noise representation
+/// @return representation appropriate for the current chunk
+ICompactNoiseDataAccessor::NoiseRepresentation TableConstDataAccessor::noiseRepresentation() const
+{
+  return itsNoiseRepresentation.value(itsIterator, &TableConstDataIterator::fillNoiseRepresentation);
+}
+
+/// @brief noise value for the constant noise case
+/// @details This method is only valid if noiseRepresentation returns 
+/// CONSTANT_NOISE. An exception is thrown otherwise.
+/// @return complex noise estimate used for all elements
+casacore::Complex TableConstDataAccessor::constantNoise() const
+{
+  return itsIterator.constantNoise();
+}
+
+/// @brief noise figures for each row and polarisation
+/// @details This method is valid if noiseRepresentation returns either 
+/// CONSTANT_NOISE or ROW_POL_NOISE. An exception is thrown otherwise.
+/// @return a reference to nRow x nPol matrix with complex noise estimates, valid
+/// for all spectral channels
+const casacore::Matrix<casacore::Complex>& TableConstDataAccessor::rowPolNoise() const
+{
+  return itsRowPolNoise.value(itsIterator, &TableConstDataIterator::fillRowPolNoise);
+}
+
+/// @brief bit-packed flags
+/// @return a reference to the packed flags for the nRow x nChannel x nPol cube
+const PackedFlagCube& TableConstDataAccessor::packedFlag() const
+{
+  return itsPackedFlag.value(itsIterator, &TableConstDataIterator::fillPackedFlag);
+}
+
+/// @brief reduced precision visibilities
+/// @details The format is set by the data source (see 
+/// TableConstDataSource::configureCompactVisibility)
+/// @return a reference to the compact form of the nRow x nChannel x nPol cube
+const CompactVisibilityCube& TableConstDataAccessor::compactVisibility() const
+{
+  return itsCompactVisibility.value(itsIterator, &TableConstDataIterator::fillCompactVisibility);
+}
+
+/// @brief rows which are not flagged as a whole
+/// @return a reference to the vector with accessor rows which contain data
+const casacore::Vector<casacore::uInt>& TableConstDataAccessor::unflaggedRows() const
+{
+  return itsUnflaggedRows.value(itsIterator, &TableConstDataIterator::fillUnflaggedRows);
+}
+
+/// @brief visibilities of the given data column
+/// @details The name of the main data column is also accepted, the cube
+/// returned by visibility() is given in this case. An exception is thrown
+/// if the column has not been chosen.
+/// @param[in] column name of the data column
+/// @return a reference to nRow x nChannel x nPol cube with visibilities
+const casacore::Cube<casacore::Complex>& TableConstDataAccessor::columnVisibility(const std::string &column) const
+{
+  if (itsIterator.isDataColumn(column)) {
+      return visibility();
+  }
+  const ColumnVisibilities &cubes = itsColumnVisibility.value(itsIterator, 
+                                    &TableConstDataIterator::fillColumnVisibility);
+  const ColumnVisibilities::const_iterator ci = cubes.find(column);
+  if (ci == cubes.end()) {
+      ASKAPTHROW(DataAccessError, "Column "<<column<<" has not been chosen via chooseExtraDataColumns");
+  }
+  return ci->second;
+}
+
 /// UVW
 /// @return a reference to vector containing uvw-coordinates
 /// packed into a 3-D rigid vector
@@ -105,6 +199,11 @@ TableConstDataAccessor::uvw() const
 const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
 	           TableConstDataAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
 {
+  RotatedUVWStore *store = itsIterator.rotatedUVWStore();
+  if (store != NULL) {
+      return itsRotatedUVW.uvw(*this, tangentPoint, store, 
+                 &itsChunkKey.value(itsIterator, &TableConstDataIterator::fillChunkKey));
+  }
   return itsRotatedUVW.uvw(*this, tangentPoint);
 }	           
 	         
@@ -119,9 +218,25 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
 const casacore::Vector<casacore::Double>& TableConstDataAccessor::uvwRotationDelay(
 	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
 {
+  RotatedUVWStore *store = itsIterator.rotatedUVWStore();
+  if (store != NULL) {
+      return itsRotatedUVW.delays(*this, tangentPoint, imageCentre, store,
+                 &itsChunkKey.value(itsIterator, &TableConstDataIterator::fillChunkKey));
+  }
   return itsRotatedUVW.delays(*this,tangentPoint,imageCentre);
 }
 
+/// @brief uvw rotated to a number of tangent points
+/// @details All facets are rotated in one pass over the rows, the result is cached
+/// until the iterator moves to the next chunk.
+/// @param[in] tangentPoints tangent points of all facets (J2000)
+/// @return a reference to the rotated uvws and delays for each facet and row
+const FacetRotatedUVW& TableConstDataAccessor::facetRotatedUVW(
+         const std::vector<casacore::MDirection> &tangentPoints) const
+{
+  return itsRotatedUVW.facetUVW(*this, tangentPoints);
+}
+
 /// Frequency for each channel
 /// @return a reference to vector containing frequencies for each
 ///         spectral channel (vector size is nChannel). Frequencies
@@ -132,6 +247,31 @@ const casacore::Vector<casacore::Double>& TableConstDataAccessor::frequency() co
   return itsFrequency.value(itsIterator,&TableConstDataIterator::fillFrequency);
 }
 
+/// @brief uvw in single precision
+/// @return a reference to vector containing uvw-coordinates (in metres)
+/// packed into a 3-D rigid vector, one element for each row
+const casacore::Vector<casacore::RigidVector<casacore::Float, 3> >& TableConstDataAccessor::floatUVW() const
+{
+  return itsFloatUVW.value(itsIterator, &TableConstDataIterator::fillFloatUVW);
+}
+
+/// @brief frequency in single precision
+/// @return a reference to vector containing frequencies for each spectral 
+/// channel, the frame/units are the same as for frequency()
+const casacore::Vector<casacore::Float>& TableConstDataAccessor::floatFrequency() const
+{
+  return itsFloatFrequency.value(itsIterator, &TableConstDataIterator::fillFloatFrequency);
+}
+
+/// @brief inverse wavelength for each channel
+/// @details This is frequency divided by the speed of light, regardless of the units
+/// in which frequency() is given.
+/// @return a reference to vector containing 1/lambda (in 1/metres) for each spectral channel
+const casacore::Vector<casacore::Float>& TableConstDataAccessor::inverseWavelength() const
+{
+  return itsInverseWavelength.value(itsIterator, &TableConstDataIterator::fillInverseWavelength);
+}
+
 /// a helper adapter method to set the time via non-const reference
 /// @param[in] time a reference to buffer to fill with the current time 
 void TableConstDataAccessor::readTime(casacore::Double &time) const
@@ -249,6 +389,16 @@ const casacore::Cube<casacore::Complex>& TableConstDataAccessor::noise() const
 {
   return itsNoise.value(itsIterator, &TableConstDataIterator::fillNoise);
 }
+
+/// @brief weight of each visibility
+/// @details The weights are computed from flags and noise figures (or taken from
+/// WEIGHT_SPECTRUM) in a single pass and cached for the current chunk, see 
+/// IWeightDataAccessor for details.
+/// @return a reference to nRow x nChannel x nPol cube with weights
+const casacore::Cube<casacore::Float>& TableConstDataAccessor::weight() const
+{
+  return itsWeight.value(itsIterator, &TableConstDataIterator::fillWeight);
+}
   
 /// Velocity for each channel
 /// @return a reference to vector containing velocities for each
@@ -271,13 +421,20 @@ const casacore::Vector<casacore::Stokes::StokesTypes>& TableConstDataAccessor::s
 }                                    
 
 /// invalidate fields  updated on each iteration
-void TableConstDataAccessor::invalidateIterationCaches() const throw()
+void TableConstDataAccessor::invalidateIterationCaches() const
 {
   itsVisibility.invalidate();
   itsFlag.invalidate();
   itsUVW.invalidate();
+  itsFloatUVW.invalidate();
   itsRotatedUVW.invalidate();
+  itsChunkKey.invalidate();
   itsTime.invalidate();
+  // the frame of the frequency axis depends on time, the iterator reuses 
+  // the converted axis if possible
+  itsFrequency.invalidate();
+  itsFloatFrequency.invalidate();
+  itsInverseWavelength.invalidate();
   itsAntenna1.invalidate();
   itsAntenna2.invalidate();
   itsFeed1.invalidate();
@@ -289,24 +446,100 @@ void TableConstDataAccessor::invalidateIterationCaches() const throw()
   itsDishPointing1.invalidate();
   itsDishPointing2.invalidate();
   itsNoise.invalidate();
+  itsWeight.invalidate();
+  itsNativeVisibility.invalidate();
+  itsNativeFlag.invalidate();
+  itsNativeNoise.invalidate();
+  itsNoiseRepresentation.invalidate();
+  itsRowPolNoise.invalidate();
+  itsPackedFlag.invalidate();
+  itsCompactVisibility.invalidate();
+  itsUnflaggedRows.invalidate();
+  itsColumnVisibility.invalidate();
 }
 
 /// @brief invalidate all fields  corresponding to the spectral axis
 /// @details See invalidateIterationCaches for more details
-void TableConstDataAccessor::invalidateSpectralCaches() const throw()
+void TableConstDataAccessor::invalidateSpectralCaches() const
 {
   itsFrequency.invalidate();
+  itsFloatFrequency.invalidate();
+  itsInverseWavelength.invalidate();
   // polarisation info is attached to a spectral info (i.e. both are controlled by 
   // data descriptor ID, which is a sort of correlator setup ID)
   itsStokes.invalidate();
 }
 
+/// @brief invalidate fields depending on the selected channels
+/// @details This method is used when the iterator moves to the next range of
+/// channels for the same rows. Caches of bulk data (visibility, flag and noise) and the
+/// frequency axis are invalidated, while the row-based metadata are retained. 
+void TableConstDataAccessor::invalidateChannelCaches() const
+{
+  itsVisibility.invalidate();
+  itsFlag.invalidate();
+  itsNoise.invalidate();
+  itsWeight.invalidate();
+  itsNativeVisibility.invalidate();
+  itsNativeFlag.invalidate();
+  itsNativeNoise.invalidate();
+  itsNoiseRepresentation.invalidate();
+  itsRowPolNoise.invalidate();
+  itsPackedFlag.invalidate();
+  itsCompactVisibility.invalidate();
+  itsColumnVisibility.invalidate();
+  itsFrequency.invalidate();
+  itsFloatFrequency.invalidate();
+  itsInverseWavelength.invalidate();
+}
+
 /// @brief invalidate cache of rotated uvw and delays
 /// @details Cache of rotated uvw and delays is kept per accessor, need this
 /// method to access private field
-void TableConstDataAccessor::invalidateRotatedUVW() const throw()
+void TableConstDataAccessor::invalidateRotatedUVW() const
 {
   itsRotatedUVW.invalidate();
+  itsChunkKey.invalidate();
+}
+
+/// @brief attach statistics to the cached fields
+/// @details Reads on demand and cache hits of all fields as well as the use of
+/// the uvw machine cache are counted in the given object.
+/// @param[in] stats statistics to update (zero to detach)
+void TableConstDataAccessor::setStatistics(IteratorStatistics *stats) const
+{
+  itsVisibility.setStatistics(stats);
+  itsFlag.setStatistics(stats);
+  itsUVW.setStatistics(stats);
+  itsRotatedUVW.setStatistics(stats);
+  itsChunkKey.setStatistics(stats);
+  itsFrequency.setStatistics(stats);
+  itsFloatUVW.setStatistics(stats);
+  itsFloatFrequency.setStatistics(stats);
+  itsInverseWavelength.setStatistics(stats);
+  itsTime.setStatistics(stats);
+  itsAntenna1.setStatistics(stats);
+  itsAntenna2.setStatistics(stats);
+  itsFeed1.setStatistics(stats);
+  itsFeed2.setStatistics(stats);
+  itsFeed1PA.setStatistics(stats);
+  itsFeed2PA.setStatistics(stats);
+  itsPointingDir1.setStatistics(stats);
+  itsPointingDir2.setStatistics(stats);
+  itsDishPointing1.setStatistics(stats);
+  itsDishPointing2.setStatistics(stats);
+  itsNoise.setStatistics(stats);
+  itsWeight.setStatistics(stats);
+  itsStokes.setStatistics(stats);
+  itsNativeVisibility.setStatistics(stats);
+  itsNativeFlag.setStatistics(stats);
+  itsNativeNoise.setStatistics(stats);
+  itsNoiseRepresentation.setStatistics(stats);
+  itsRowPolNoise.setStatistics(stats);
+  itsPackedFlag.setStatistics(stats);
+  itsCompactVisibility.setStatistics(stats);
+  itsUnflaggedRows.setStatistics(stats);
+  itsColumnVisibility.setStatistics(stats);
 }
 
 
@@ -35,8 +35,21 @@
 #ifndef ASKAP_ACCESSORS_TABLE_CONST_DATA_ACCESSOR_H
 #define ASKAP_ACCESSORS_TABLE_CONST_DATA_ACCESSOR_H
 
+// std includes
+#include <map>
+#include <string>
+
 // own includes
 #include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/INativeLayoutDataAccessor.h>
+#include <askap/dataaccess/ICompactNoiseDataAccessor.h>
+#include <askap/dataaccess/IPackedFlagDataAccessor.h>
+#include <askap/dataaccess/ICompactVisibilityDataAccessor.h>
+#include <askap/dataaccess/IFlaggedRowDataAccessor.h>
+#include <askap/dataaccess/IMultiColumnDataAccessor.h>
+#include <askap/dataaccess/ISinglePrecisionDataAccessor.h>
+#include <askap/dataaccess/IWeightDataAccessor.h>
+#include <askap/dataaccess/IFacetUVWDataAccessor.h>
 #include <askap/dataaccess/DataAccessError.h>
 #include <askap/dataaccess/CachedAccessorField.h>
 #include <askap/dataaccess/UVWRotationHandler.h>
@@ -60,9 +73,21 @@ class TableConstDataIterator;
 /// it should become a separate class derived
 /// directly from its interface
 /// @ingroup dataaccess_tab
-class TableConstDataAccessor : virtual public IConstDataAccessor
+class TableConstDataAccessor : virtual public IConstDataAccessor,
+                               virtual public INativeLayoutDataAccessor,
+                               virtual public ICompactNoiseDataAccessor,
+                               virtual public IPackedFlagDataAccessor,
+                               virtual public ICompactVisibilityDataAccessor,
+                               virtual public IFlaggedRowDataAccessor,
+                               virtual public IMultiColumnDataAccessor,
+                               virtual public ISinglePrecisionDataAccessor,
+                               virtual public IWeightDataAccessor,
+                               virtual public IFacetUVWDataAccessor
 {
 public:
+  /// @brief visibility cubes of the additional data columns, the key is the column name
+  typedef std::map<std::string, casacore::Cube<casacore::Complex> > ColumnVisibilities;
+
   /// construct an object linked with the given iterator
   /// @param iter a reference to associated iterator
   explicit TableConstDataAccessor(const TableConstDataIterator &iter);
@@ -117,6 +142,60 @@ public:
   ///         information. If True, the corresponding element is flagged.
   virtual const casacore::Cube<casacore::Bool>& flag() const;
 
+  /// @brief visibilities in the storage order
+  /// @return a reference to nPol x nChannel x nRow cube, containing
+  /// all visibility data
+  virtual const casacore::Cube<casacore::Complex>& nativeVisibility() const;
+
+  /// @brief flags in the storage order
+  /// @return a reference to nPol x nChannel x nRow cube with flag 
+  ///         information. If True, the corresponding element is flagged.
+  virtual const casacore::Cube<casacore::Bool>& nativeFlag() const;
+
+  /// @brief noise figures in the storage order
+  /// @return a reference to nPol x nChannel x nRow cube with
+  ///         complex noise estimates
+  virtual const casacore::Cube<casacore::Complex>& nativeNoise() const;
+
+  /// @brief obtain the type of the noise representation
+  /// @return representation appropriate for the current chunk
+  virtual NoiseRepresentation noiseRepresentation() const;
+
+  /// @brief noise value for the constant noise case
+  /// @details This method is only valid if noiseRepresentation returns 
+  /// CONSTANT_NOISE. An exception is thrown otherwise.
+  /// @return complex noise estimate used for all elements
+  virtual casacore::Complex constantNoise() const;
+
+  /// @brief noise figures for each row and polarisation
+  /// @details This method is valid if noiseRepresentation returns either 
+  /// CONSTANT_NOISE or ROW_POL_NOISE. An exception is thrown otherwise.
+  /// @return a reference to nRow x nPol matrix with complex noise estimates, valid
+  /// for all spectral channels
+  virtual const casacore::Matrix<casacore::Complex>& rowPolNoise() const;
+
+  /// @brief bit-packed flags
+  /// @return a reference to the packed flags for the nRow x nChannel x nPol cube
+  virtual const PackedFlagCube& packedFlag() const;
+
+  /// @brief reduced precision visibilities
+  /// @details The format is set by the data source (see 
+  /// TableConstDataSource::configureCompactVisibility)
+  /// @return a reference to the compact form of the nRow x nChannel x nPol cube
+  virtual const CompactVisibilityCube& compactVisibility() const;
+
+  /// @brief rows which are not flagged as a whole
+  /// @return a reference to the vector with accessor rows which contain data
+  virtual const casacore::Vector<casacore::uInt>& unflaggedRows() const;
+
+  /// @brief visibilities of the given data column
+  /// @details The name of the main data column is also accepted, the cube
+  /// returned by visibility() is given in this case. An exception is thrown
+  /// if the column has not been chosen.
+  /// @param[in] column name of the data column
+  /// @return a reference to nRow x nChannel x nPol cube with visibilities
+  virtual const casacore::Cube<casacore::Complex>& columnVisibility(const std::string &column) const;
+
   /// UVW
   /// @return a reference to vector containing uvw-coordinates
   /// packed into a 3-D rigid vector
@@ -141,6 +220,14 @@ public:
   /// @return delays corresponding to the uvw rotation for each row
   virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
 	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const;
+
+  /// @brief uvw rotated to a number of tangent points
+  /// @details All facets are rotated in one pass over the rows, the result is cached
+  /// until the iterator moves to the next chunk.
+  /// @param[in] tangentPoints tangent points of all facets (J2000)
+  /// @return a reference to the rotated uvws and delays for each facet and row
+  virtual const FacetRotatedUVW& facetRotatedUVW(
+           const std::vector<casacore::MDirection> &tangentPoints) const;
   
   /// Frequency for each channel
   /// @return a reference to vector containing frequencies for each
@@ -149,6 +236,22 @@ public:
   ///         the DataSource object
   virtual const casacore::Vector<casacore::Double>& frequency() const;
 
+  /// @brief uvw in single precision
+  /// @return a reference to vector containing uvw-coordinates (in metres)
+  /// packed into a 3-D rigid vector, one element for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Float, 3> >& floatUVW() const;
+
+  /// @brief frequency in single precision
+  /// @return a reference to vector containing frequencies for each spectral 
+  /// channel, the frame/units are the same as for frequency()
+  virtual const casacore::Vector<casacore::Float>& floatFrequency() const;
+
+  /// @brief inverse wavelength for each channel
+  /// @details This is frequency divided by the speed of light, regardless of the units
+  /// in which frequency() is given.
+  /// @return a reference to vector containing 1/lambda (in 1/metres) for each spectral channel
+  virtual const casacore::Vector<casacore::Float>& inverseWavelength() const;
+
   /// Timestamp for each row
   /// @return a timestamp for this buffer (it is always the same
   ///         for all rows. The timestamp is returned as 
@@ -190,6 +293,13 @@ public:
   /// @return a reference to nRow x nChannel x nPol cube with
   ///         complex noise estimates
   virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// @brief weight of each visibility
+  /// @details The weights are computed from flags and noise figures (or taken from
+  /// WEIGHT_SPECTRUM) in a single pass and cached for the current chunk, see 
+  /// IWeightDataAccessor for details.
+  /// @return a reference to nRow x nChannel x nPol cube with weights
+  virtual const casacore::Cube<casacore::Float>& weight() const;
   
   /// Velocity for each channel
   /// @return a reference to vector containing velocities for each
@@ -213,16 +323,28 @@ public:
   /// only once if the is just one spectral window in the measurement set).
   /// These are invalidated by a call to notifyNewSpectralWindow(), if
   /// the new window is not the same as the cached one
-  virtual void invalidateIterationCaches() const throw();
+  virtual void invalidateIterationCaches() const;
   
   /// @brief invalidate fields corresponding to the spectral axis
   /// @details See invalidateIterationCaches for more details
-  void invalidateSpectralCaches() const throw();
+  void invalidateSpectralCaches() const;
+
+  /// @brief invalidate fields depending on the selected channels
+  /// @details This method is used when the iterator moves to the next range of
+  /// channels for the same rows. Caches of bulk data (visibility, flag and noise) and the
+  /// frequency axis are invalidated, while the row-based metadata are retained. 
+  void invalidateChannelCaches() const;
   
   /// @brief invalidate cache of rotated uvw and delays
   /// @details Cache of rotated uvw and delays is kept per accessor, need this
   /// method to access private field
-  void invalidateRotatedUVW() const throw();
+  void invalidateRotatedUVW() const;
+
+  /// @brief attach statistics to the cached fields
+  /// @details Reads on demand and cache hits of all fields as well as the use of
+  /// the uvw machine cache are counted in the given object.
+  /// @param[in] stats statistics to update (zero to detach)
+  void setStatistics(IteratorStatistics *stats) const;
 
   /// @brief Obtain a const reference to associated iterator.
   /// @details This method is mainly intended to be used in the derived
@@ -249,10 +371,23 @@ private:
   
   /// internal buffer for rotated uvw and associated delay
   UVWRotationHandler itsRotatedUVW; 
+
+  /// @brief internal buffer for the key of the chunk in the store of rotated uvws
+  /// @details Only used if the store is configured for the iterator
+  CachedAccessorField<RotatedUVWStore::ChunkKey> itsChunkKey;
  
   /// internal buffer for frequency
   CachedAccessorField<casacore::Vector<casacore::Double> > itsFrequency;
 
+  /// internal buffer for uvw in single precision
+  CachedAccessorField<casacore::Vector<casacore::RigidVector<casacore::Float, 3> > > itsFloatUVW;
+
+  /// internal buffer for frequency in single precision
+  CachedAccessorField<casacore::Vector<casacore::Float> > itsFloatFrequency;
+
+  /// internal buffer for the inverse wavelength
+  CachedAccessorField<casacore::Vector<casacore::Float> > itsInverseWavelength;
+
   /// internal buffer for time
   CachedAccessorField<casacore::Double> itsTime;
   
@@ -288,9 +423,39 @@ private:
   
   /// internal buffer for the noise figures
   CachedAccessorField<casacore::Cube<casacore::Complex> > itsNoise;
+
+  /// internal buffer for the weights
+  CachedAccessorField<casacore::Cube<casacore::Float> > itsWeight;
   
   /// internal buffer for the polarisation types
   CachedAccessorField<casacore::Vector<casacore::Stokes::StokesTypes> > itsStokes;
+
+  /// internal buffer for visibility in the storage order
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsNativeVisibility;
+
+  /// internal buffer for flag in the storage order
+  CachedAccessorField<casacore::Cube<casacore::Bool> > itsNativeFlag;
+
+  /// internal buffer for the noise figures in the storage order
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsNativeNoise;
+
+  /// internal buffer for the type of the noise representation
+  CachedAccessorField<NoiseRepresentation> itsNoiseRepresentation;
+
+  /// internal buffer for the noise figures per row and polarisation
+  CachedAccessorField<casacore::Matrix<casacore::Complex> > itsRowPolNoise;
+
+  /// internal buffer for the bit-packed flags
+  CachedAccessorField<PackedFlagCube> itsPackedFlag;
+
+  /// internal buffer for the reduced precision visibilities
+  CachedAccessorField<CompactVisibilityCube> itsCompactVisibility;
+
+  /// internal buffer for the map of rows which are not flagged as a whole
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsUnflaggedRows;
+
+  /// internal buffer for the visibilities of the additional data columns
+  CachedAccessorField<ColumnVisibilities> itsColumnVisibility;
 };
 
 
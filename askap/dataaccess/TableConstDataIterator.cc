@@ -38,16 +38,31 @@
 #include <askap/askap/AskapError.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
 #include <casacore/scimath/Mathematics/SquareMatrix.h>
 #include <casacore/measures/Measures/MeasFrame.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/casa/Quanta/Quantum.h>
 
 /// Local package
 #include <askap/dataaccess/TableConstDataIterator.h>
 #include <askap/dataaccess/DataAccessError.h>
-#include <askap/dataaccess/DirectionConverter.h>
+#include <askap/dataaccess/CubeTransposer.h>
+#include <askap/dataaccess/AccessTracer.h>
+#include <askap/dataaccess/PolConvertingAccessor.h>
+#include <askap/dataaccess/ChannelAverager.h>
+#include <askap/dataaccess/FirstTouchAllocator.h>
+#include <askap/dataaccess/WeightCalculator.h>
+
+// std includes
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 ASKAP_LOGGER(logger, "");
 
@@ -80,7 +95,20 @@ struct WholeRowFlagger
   /// for a particular type and fills the cube with appropriate data.
   /// If it can't do this, it returns true, which forces an element by element
   /// processing. By default parameters are not used
-  inline bool copyRequired(casacore::uInt, casacore::Cube<T> &) { return true;}
+  inline bool copyRequired(casacore::uInt, casacore::uInt, casacore::Cube<T> &) { return true;}
+
+  /// @brief flag the whole row of a cube in the native order
+  /// @details The same as copyRequired, but the cube is nPol x nChannel x nRow
+  /// (i.e. each row is an xy-plane). By default parameters are not used.
+  inline void flagNativeRow(casacore::uInt, casacore::uInt, casacore::Cube<T> &) {}
+
+  /// @brief check whether the whole row is flagged
+  /// @details By default parameters are not used and no rows are flagged
+  inline bool rowFlagged(casacore::uInt) { return false;}
+
+  /// @brief value assigned to rows which are skipped because of FLAG_ROW
+  /// @return default value of the type (i.e. zero visibility)
+  static inline T flaggedValue() { return T();}
 };
 
 
@@ -102,8 +130,28 @@ struct WholeRowFlagger<casacore::Bool>
   /// If it can't do this, it returns true, which forces an element by element
   /// processing. By default parameters are not used
   /// @param[in] row a row to work with
+  /// @param[in] chunkRow the corresponding row of the cube
   /// @param[in] cube cube to work with
-  inline bool copyRequired(casacore::uInt row, casacore::Cube<casacore::Bool> &cube);
+  inline bool copyRequired(casacore::uInt row, casacore::uInt chunkRow,
+                           casacore::Cube<casacore::Bool> &cube);
+
+  /// @brief flag the whole row of a cube in the native order
+  /// @details The same as copyRequired, but the cube is nPol x nChannel x nRow
+  /// (i.e. each row is an xy-plane).
+  /// @param[in] row a row to work with
+  /// @param[in] chunkRow the corresponding row of the cube
+  /// @param[in] cube cube to work with
+  inline void flagNativeRow(casacore::uInt row, casacore::uInt chunkRow,
+                            casacore::Cube<casacore::Bool> &cube);
+
+  /// @brief check whether the whole row is flagged
+  /// @param[in] row a row to work with
+  /// @return true, if FLAG_ROW is set for the given row
+  inline bool rowFlagged(casacore::uInt row);
+
+  /// @brief value assigned to rows which are skipped because of FLAG_ROW
+  /// @return true, i.e. all elements of such rows are flagged
+  static inline casacore::Bool flaggedValue() { return true;}
 private:
   /// @brief accessor to the FLAG_ROW column
   ROScalarColumn<casacore::Bool> itsFlagRowCol;
@@ -120,18 +168,32 @@ WholeRowFlagger<casacore::Bool>::WholeRowFlagger(const casacore::Table &iteratio
 }
 
 bool WholeRowFlagger<casacore::Bool>::copyRequired(casacore::uInt row,
-                 casacore::Cube<casacore::Bool> &cube)
+                 casacore::uInt chunkRow, casacore::Cube<casacore::Bool> &cube)
 {
   ASKAPDEBUGASSERT(!itsFlagRowCol.isNull());
   if (itsHasFlagRow) {
       if (itsFlagRowCol.asBool(row)) {
-          cube.yzPlane(row) = true;
+          cube.yzPlane(chunkRow) = true;
           return false;
       }
   }
   return true;
 }
 
+bool WholeRowFlagger<casacore::Bool>::rowFlagged(casacore::uInt row)
+{
+  return itsHasFlagRow ? itsFlagRowCol.asBool(row) : false;
+}
+
+void WholeRowFlagger<casacore::Bool>::flagNativeRow(casacore::uInt row,
+                 casacore::uInt chunkRow, casacore::Cube<casacore::Bool> &cube)
+{
+  if (itsHasFlagRow) {
+      if (itsFlagRowCol.asBool(row)) {
+          cube.xyPlane(chunkRow) = true;
+      }
+  }
+}
 
 } // namespace accessors
 
@@ -144,21 +206,56 @@ bool WholeRowFlagger<casacore::Bool>::copyRequired(casacore::uInt row,
 /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
 /// to initialisation of a new UVW Machine
 /// @param[in] maxChunkSize maximum number of rows per accessor
+/// @param[in] nativeLayout if true, cubes in the table order are the primary buffers
+/// @param[in] prefetch if true, bulk data for the next chunk are read in a background thread
+/// @param[in] skipFlaggedRows if true, rows flagged via FLAG_ROW are not read from the
+/// data column (visibilities are set to zero)
+/// @param[in] maxChannels maximum number of channels per accessor, zero means no restriction
+/// @param[in] rotatedUVWStore optional store of rotated uvws shared between iterations
+/// (empty shared pointer means that rotated uvws are computed for every pass)
+/// @param[in] paInterval maximum time difference in seconds for which the conversion of the
+/// reference direction is reused for parallactic angles (see ParallacticAngleEngine)
+/// @param[in] useRowIndex if true, the selection is resolved via the index of the main
+/// table rows (if possible) instead of evaluating the table expression
+/// @param[in] freqTolerance maximum time difference in seconds for which the frequency
+/// axis converted to the target frame is reused
+/// @param[in] groupRows if true, rows of each time step are grouped by DATA_DESC_ID and
+/// FIELD_ID, so chunks are not broken by interleaved spectral windows or fields
+/// @param[in] chunkMemoryBudget maximum number of bytes of the bulk data per chunk, the 
+/// number of rows is derived from it for each spectral setup (zero means no restriction
+/// except maxChunkSize)
+/// @param[in] timeOrder permutation of rows of the main table putting them in the time
+/// order, the selected rows are visited in this order (empty pointer means the order
+/// the rows are stored, the permutation is also ignored if it has been built for a 
+/// different number of rows)
 TableConstDataIterator::TableConstDataIterator(
             const boost::shared_ptr<ITableManager const> &msManager,
             const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
             const boost::shared_ptr<IDataConverterImpl const> &conv,
             size_t cacheSize, double tolerance,
-            casacore::uInt maxChunkSize) :
+            casacore::uInt maxChunkSize, bool nativeLayout, bool prefetch,
+            bool skipFlaggedRows, casacore::uInt maxChannels,
+            const boost::shared_ptr<RotatedUVWStore> &rotatedUVWStore, double paInterval,
+            bool useRowIndex, double freqTolerance, bool groupRows, size_t chunkMemoryBudget,
+            const boost::shared_ptr<TimeOrderPermutation const> &timeOrder) :
         TableInfoAccessor(msManager),
         // it is essential that accessor is initialised after cache parameters!
 	    itsUVWCacheSize(cacheSize), itsUVWCacheTolerance(tolerance),
+	    itsRotatedUVWStore(rotatedUVWStore),
 	    itsAccessor(*this),
 #ifndef ASKAP_DEBUG
         itsSelector(sel->clone()),
 	    itsConverter(conv->clone()),
 #endif
-	    itsMaxChunkSize(maxChunkSize)
+	    itsMaxChunkSize(maxChunkSize), itsNativeLayout(nativeLayout),
+	    itsPrefetch(prefetch), itsSkipFlaggedRows(skipFlaggedRows),
+	    itsMaxChannels(maxChannels), itsCurrentChannelTile(0), itsNChannelTiles(0), itsFieldsObtained(0),
+	    itsQCChunkAdded(false), itsQCChunkPending(false),
+	    itsIterationStep(0), itsParallacticAngleInterval(paInterval),
+	    itsUseRowIndex(useRowIndex), itsFrequencyFrameTolerance(freqTolerance),
+	    itsGroupRows(groupRows), itsChunkMemoryBudget(chunkMemoryBudget),
+	    itsCompactVisibilityFormat(CompactVisibilityCube::COMPLEX_INT16),
+	    itsTimeOrder(timeOrder)
 
 {
   ASKAPDEBUGASSERT(conv);
@@ -173,7 +270,14 @@ TableConstDataIterator::TableConstDataIterator(
 /// Restart the iteration from the beginning
 void TableConstDataIterator::init()
 {
+  finishQCStatistics();
+  // the old background reader (if any) waits for its job to finish
+  itsPrefetcher.reset();
+  itsIterationStep=0;
   itsCurrentTopRow=0;
+  itsCurrentChannelTile=0;
+  itsFieldsObtained=0;
+  itsAveragedChunkValid=false;
   itsCurrentDataDescID=-100; // this value can't be in the table,
                              // therefore it is a flag of a new data descriptor
   itsCurrentFieldID = -100; // this value can't be in the table,
@@ -184,15 +288,60 @@ void TableConstDataIterator::init()
 
   const casacore::TableExprNode &exprNode =
               itsSelector->getTableSelector(itsConverter);
-  if (exprNode.isNull()) {
-      itsTabIterator=casacore::TableIterator(table(),"TIME",
-	     casacore::TableIterator::Ascending,casacore::TableIterator::NoSort);
-  } else {
-      itsTabIterator=casacore::TableIterator(table()(itsSelector->
-                               getTableSelector(itsConverter)),"TIME",
-	     casacore::TableIterator::Ascending,casacore::TableIterator::NoSort);
+  casacore::Table selectedTable = table();
+  if (!exprNode.isNull()) {
+      const MainTableRowIndex::Criteria criteria = itsSelector->getRowCriteria(itsConverter);
+      // indices are only valid if no rows were added since they were built
+      std::pair<casacore::Double, casacore::Double> timeRange;
+      if (criteria.timeRangeOnly(timeRange) && subtableInfo().getTimeIndex().timeOrdered() && 
+          (subtableInfo().getTimeIndex().nrow() == table().nrow())) {
+          // contiguous range of rows, the binary search is sufficient
+          const std::pair<casacore::uInt, casacore::uInt> rowRange = 
+                subtableInfo().getTimeIndex().rowRange(timeRange.first, timeRange.second);
+          casacore::Vector<casacore::uInt> rows(rowRange.second);
+          indgen(rows, rowRange.first);
+          selectedTable = table()(rows);
+      } else if (itsUseRowIndex && criteria.usable() && 
+          (subtableInfo().getRowIndex().nrow() == table().nrow())) {
+          casacore::Vector<casacore::uInt> rows;
+          subtableInfo().getRowIndex().select(criteria, rows);
+          selectedTable = table()(rows);
+      } else {
+          selectedTable = table()(exprNode);
+      }
+  }
+  if (itsTimeOrder && (itsTimeOrder->nrow() == table().nrow())) {
+      // visit the selected rows in the time order, so the time never goes backwards
+      casacore::Vector<casacore::uInt> rows;
+      itsTimeOrder->order(selectedTable.rowNumbers(table()), rows);
+      selectedTable = table()(rows);
+  }
+  // the same steps as casacore::TableIterator over TIME without sorting, but
+  // described by the ranges of rows of the selected table
+  itsTabIterator = TimeStepIterator(selectedTable, itsGroupRows);
+  // the iterator may permute rows within each step to make chunks uniform
+  itsSelectedTable = itsTabIterator.table();
+  // columns are attached to the selected table once for the whole pass
+  itsColumnCache.clear();
+  itsBudgetChunkSizes.clear();
+  itsRowNumbers.resize(0);
+  // the background reader works with whole chunks of rows and doesn't support
+  // the split into channel tiles, the selection of polarisations or channel averaging
+  const int bulkFields = itsSelector->requiredFields() & (ITableDataSelectorImpl::VISIBILITY_FIELD |
+           ITableDataSelectorImpl::FLAG_FIELD | ITableDataSelectorImpl::NOISE_FIELD | 
+           ITableDataSelectorImpl::UVW_FIELD);
+  if (itsPrefetch && (itsMaxChannels == 0) && (bulkFields != 0) && !polarizationsSelected() &&
+      (channelAveraging() == 1)) {
+      // the background reader steps through the same row ranges on its own
+      itsPrefetcher.reset(new TableChunkPrefetcher(itsTabIterator, getDataColumnName(),
+                          itsNativeLayout, bulkFields));
+      itsPrefetcher->setStatistics(itsStatistics.get());
+      itsPrefetcher->setAffinity(itsAffinity);
   }
   setUpIteration();
+  if (itsStatistics && hasMore()) {
+      itsStatistics->addChunk(itsNumberOfRows);
+  }
 }
 
 /// operator* delivers a reference to data accessor (current chunk)
@@ -209,7 +358,10 @@ casacore::Bool TableConstDataIterator::hasMore() const throw()
   if (!itsTabIterator.pastEnd()) {
       return true;
   }
-  if (itsCurrentTopRow+itsNumberOfRows<itsCurrentIteration.nrow()) {
+  if (itsCurrentChannelTile + 1 < nChannelTiles()) {
+      return true;
+  }
+  if (itsCurrentTopRow+itsNumberOfRows<itsIterationEnd) {
       return true;
   }
   return false;
@@ -220,46 +372,379 @@ casacore::Bool TableConstDataIterator::hasMore() const throw()
 ///         while(it.next()) {} are possible)
 casacore::Bool TableConstDataIterator::next()
 {
+  const AccessTracer::Scope trace("next", "dataaccess");
+  finishQCStatistics();
+  waitForBackgroundJobs();
+  itsFieldsObtained = 0;
+  itsAveragedChunkValid = false;
+  if (itsCurrentChannelTile + 1 < nChannelTiles()) {
+      // next range of channels for the same rows, row-based metadata are still valid
+      ++itsCurrentChannelTile;
+      itsAccessor.invalidateChannelCaches();
+      if (itsStatistics) {
+          itsStatistics->addChunk(itsNumberOfRows);
+      }
+      return hasMore();
+  }
+  itsCurrentChannelTile = 0;
   itsCurrentTopRow+=itsNumberOfRows;
-  if (itsCurrentTopRow>=itsCurrentIteration.nrow()) {
+  if (itsCurrentTopRow>=itsIterationEnd) {
       ASKAPDEBUGASSERT(!itsTabIterator.pastEnd());
-      itsCurrentTopRow=0;
       // need to advance table iterator further
       itsTabIterator.next();
+      ++itsIterationStep;
       if (!itsTabIterator.pastEnd()) {
           setUpIteration();
       }
   } else {
-      uInt remainder=itsCurrentIteration.nrow()-itsCurrentTopRow;
-      itsNumberOfRows=remainder<=itsMaxChunkSize ?
-                      remainder : itsMaxChunkSize;
-      itsAccessor.invalidateIterationCaches();
-      // itsDirectionCache don't need invalidation because the time is the same
-      // as for the previous iteration
+      setUpChunk();
+  }
+  acceptPrefetchedChunk();
+  const casacore::Bool result = hasMore();
+  if (itsStatistics && result) {
+      itsStatistics->addChunk(itsNumberOfRows);
+  }
+  return result;
+}
 
-      // determine whether DATA_DESC_ID is uniform in the whole chunk
-      // and reduce itsNumberOfRows if necessary
-      makeUniformDataDescID();
+/// @brief release the storage kept between chunks
+/// @details Visibility, flag and noise cubes reuse the largest storage block
+/// required so far (see ReusableBuffer). The blocks are kept until the iterator
+/// is destroyed, this method frees them earlier (e.g. after a large chunk when
+/// memory is tight). The storage is allocated again when the next cube is read.
+/// Cubes of the current accessor are not affected, unless a custom allocator is
+/// used (see setBufferAllocator). In this case, they are read again on demand.
+void TableConstDataIterator::releaseBuffers()
+{
+  if (itsBufferAllocator) {
+      // the blocks are returned to the allocator straight away, cached cubes can't be kept
+      waitForBackgroundJobs();
+      itsAccessor.invalidateChannelCaches();
+      itsAveragedChunkValid = false;
+  }
+  itsVisBuffer.release();
+  itsNativeVisBuffer.release();
+  itsFlagBuffer.release();
+  itsNativeFlagBuffer.release();
+  itsNoiseBuffer.release();
+  itsNativeNoiseBuffer.release();
+  itsWeightBuffer.release();
+  itsComplexScratch.release();
+  itsBoolScratch.release();
+  itsColumnVisBuffers.clear();
+  itsFloatScratch.release();
+  itsDoubleScratch.release();
+  itsRowsToRead = std::vector<casacore::uInt>();
+}
 
-      // determine whether FIELD_ID is uniform in the whole chunk
-      // and reduce itsNumberOfRows if necessary
-      // invalidate direction cache if necessary.
-      // do nothing if itsUseFieldID is false
-      makeUniformFieldID();
+/// @brief set a custom allocator of the data buffers
+/// @details Visibility, flag and noise cubes (in both layouts, also the visibilities
+/// of the additional data columns, weights and the channel-averaged cubes) are filled into 
+/// storage blocks taken from the given allocator, e.g. page-locked memory suitable 
+/// for DMA transfers to a GPU. Cubes obtained via the read-ahead (see 
+/// TableChunkPrefetcher) are allocated in the usual way. The storage blocks are 
+/// returned to the allocator when the iterator is destroyed or the buffers are released,
+/// cubes obtained from the accessor must not be used after that.
+/// @param[in] allocator shared pointer to the allocator (empty pointer for the 
+/// default allocation)
+void TableConstDataIterator::setBufferAllocator(const boost::shared_ptr<IBufferAllocator> &allocator)
+{
+  // release the blocks of the old allocator before switching
+  releaseBuffers();
+  itsBufferAllocator = allocator;
+  itsVisBuffer.setAllocator(allocator);
+  itsNativeVisBuffer.setAllocator(allocator);
+  itsFlagBuffer.setAllocator(allocator);
+  itsNativeFlagBuffer.setAllocator(allocator);
+  itsNoiseBuffer.setAllocator(allocator);
+  itsNativeNoiseBuffer.setAllocator(allocator);
+  itsWeightBuffer.setAllocator(allocator);
+  // cubes of the current accessor may reference the default storage, fill them again
+  itsAccessor.invalidateChannelCaches();
+  itsAveragedChunkValid = false;
+}
+
+/// @brief bind the iterator to a set of CPUs
+/// @details This is intended for NUMA nodes, where the consumer of the data runs on the
+/// given CPUs (e.g. it pins itself via affinity().apply()). The background reader is
+/// restricted to the same CPUs and the data buffers are allocated and first touched there
+/// (see FirstTouchAllocator), so the cubes given out reside in the local memory of the 
+/// consumer. Any custom allocator set before is replaced. An empty set removes the 
+/// restriction, but keeps the allocator.
+/// @param[in] affinity set of CPUs
+void TableConstDataIterator::setAffinity(const ThreadAffinity &affinity)
+{
+  itsAffinity = affinity;
+  if (itsPrefetcher) {
+      itsPrefetcher->setAffinity(affinity);
+  }
+  if (!affinity.empty()) {
+      setBufferAllocator(boost::shared_ptr<IBufferAllocator>(new FirstTouchAllocator(affinity)));
+  }
+}
+
+/// @brief attach I/O and cache statistics
+/// @details If attached, the bytes read from each column, the time spent in the
+/// main fill methods, the number of chunks and rows as well as the efficiency of
+/// the accessor field and uvw machine caches are accumulated in the given object
+/// (see IteratorStatistics). The same object can be shared between iterators. 
+/// Nothing is counted by default. The current chunk (if any) is counted when
+/// the statistics are attached.
+/// @param[in] stats shared pointer to statistics (empty pointer to detach)
+void TableConstDataIterator::setStatistics(const boost::shared_ptr<IteratorStatistics> &stats)
+{
+  itsStatistics = stats;
+  if (itsPrefetcher) {
+      itsPrefetcher->setStatistics(stats.get());
+  }
+  itsAccessor.setStatistics(stats.get());
+  itsDirectionCache.setStatistics(stats.get());
+  itsParallacticAngleCache.setStatistics(stats.get());
+  itsDishPointingCache.setStatistics(stats.get());
+  if (itsStatistics && hasMore()) {
+      itsStatistics->addChunk(itsNumberOfRows);
+  }
+}
+
+/// @brief obtain the index of chunks
+/// @details The index is built on the first call by a pass over the TIME, DATA_DESC_ID
+/// and FIELD_ID columns of the selected rows and is kept for the lifetime of the iterator.
+/// @return a reference to the index of chunks
+const TableChunkIndex& TableConstDataIterator::chunkIndex() const
+{
+  if (!itsChunkIndex) {
+      waitForBackgroundJobs();
+      ASKAPDEBUGASSERT(itsConverter);
+      std::map<casacore::Int, casacore::uInt> maxRows;
+      if (itsChunkMemoryBudget > 0) {
+          // the same limits as used by makeUniformDataDescID for each spectral setup
+          const casacore::Vector<casacore::Int> dataDescIDs = scalarColumn<Int>("DATA_DESC_ID").getColumn();
+          for (casacore::uInt row = 0; row < dataDescIDs.nelements(); ++row) {
+               if (maxRows.find(dataDescIDs[row]) == maxRows.end()) {
+                   maxRows[dataDescIDs[row]] = maxChunkSize(dataDescIDs[row]);
+               }
+          }
+      }
+      itsChunkIndex.reset(new TableChunkIndex(itsSelectedTable, itsMaxChunkSize, itsUseFieldID, 
+                                              *itsConverter, maxRows));
+  }
+  return *itsChunkIndex;
+}
+
+/// @brief total number of chunks
+/// @details If channels are split into several ranges (see maxChannels parameter of the 
+/// constructor), each chunk is delivered as a number of iteration steps. The chunk
+/// index is built if necessary.
+/// @return number of chunks for the whole selection
+casacore::uInt TableConstDataIterator::nChunks() const
+{
+  return chunkIndex().nChunks();
+}
+
+/// @brief index of the current chunk
+/// @details This number can be stored (e.g. in a checkpoint) and passed to seek later.
+/// @return zero-based index of the current chunk or nChunks() if the iteration is complete
+casacore::uInt TableConstDataIterator::currentChunk() const
+{
+  const TableChunkIndex &index = chunkIndex();
+  if (!hasMore()) {
+      return index.nChunks();
+  }
+  // the index counts rows from the start of the time step
+  const casacore::uInt topRow = itsCurrentTopRow - itsIterationStart;
+  const casacore::uInt chunk = index.find(itsIterationStep, topRow);
+  ASKAPCHECK(chunk < index.nChunks(), "Current chunk (iteration step "<<itsIterationStep<<
+             ", top row "<<topRow<<") is not found in the index");
+  return chunk;
+}
+
+/// @brief jump to the given chunk
+/// @details The iteration continues from the first range of channels of the given chunk.
+/// The table iterator is stepped through the preceding time steps without reading any data,
+/// it is restarted only if the chunk precedes the current one.
+/// @param[in] chunk zero-based index of the chunk (should be less than nChunks())
+void TableConstDataIterator::seek(casacore::uInt chunk)
+{
+  const AccessTracer::Scope trace("seek", "dataaccess");
+  const TableChunkIndex::Chunk &target = chunkIndex().chunk(chunk);
+  finishQCStatistics();
+  waitForBackgroundJobs();
+  itsFieldsObtained = 0;
+  itsAveragedChunkValid = false;
+  const bool sameChannels = (itsCurrentChannelTile == 0);
+  itsCurrentChannelTile = 0;
+  if ((target.itsStep != itsIterationStep) || itsTabIterator.pastEnd()) {
+      if (target.itsStep < itsIterationStep) {
+          // the boundaries of the steps are known, no need to read the table again
+          itsTabIterator.reset();
+          itsIterationStep = 0;
+      }
+      for (; itsIterationStep < target.itsStep; ++itsIterationStep) {
+           ASKAPCHECK(!itsTabIterator.pastEnd(), "The table has changed since the chunk index was built");
+           itsTabIterator.next();
+      }
+      ASKAPCHECK(!itsTabIterator.pastEnd(), "The table has changed since the chunk index was built");
+      setUpIteration();
+  }
+  // top rows in the index are relative to the start of the time step
+  if ((itsCurrentTopRow != itsIterationStart + target.itsTopRow) || !sameChannels) {
+      itsCurrentTopRow = itsIterationStart + target.itsTopRow;
+      setUpChunk();
+  }
+  ASKAPCHECK(itsNumberOfRows == target.itsNRow, "The table has changed since the chunk index was built");
+  acceptPrefetchedChunk();
+  if (itsStatistics) {
+      itsStatistics->addChunk(itsNumberOfRows);
+  }
+}
+
+/// @brief jump to the first chunk not earlier than the given time
+/// @details If all chunks are earlier than the given time, the iteration is completed
+/// (i.e. hasMore() returns false).
+/// @param[in] time time in the frame and units of the converter (i.e. the same as 
+/// returned by the time() method of the accessor)
+/// @return true if there are more data
+casacore::Bool TableConstDataIterator::seekTime(casacore::Double time)
+{
+  const TableChunkIndex &index = chunkIndex();
+  const casacore::uInt chunk = index.findTime(time);
+  if (chunk < index.nChunks()) {
+      seek(chunk);
+  } else if (index.nChunks() > 0) {
+      // move to the last chunk and step past it, so the derived classes can finish the iteration
+      seek(index.nChunks() - 1);
+      while (next()) {}
   }
   return hasMore();
 }
 
+/// @brief account for the data read from a column
+/// @details Does nothing if the statistics are not collected
+/// @param[in] column column name
+/// @param[in] bytes number of bytes
+void TableConstDataIterator::countRead(const std::string &column, size_t bytes) const
+{
+  if (itsStatistics) {
+      itsStatistics->addRead(column, bytes);
+  }
+}
+
+/// @brief account for the data written to a column
+/// @details Does nothing if the statistics are not collected
+/// @param[in] column column name
+/// @param[in] bytes number of bytes
+void TableConstDataIterator::countWrite(const std::string &column, size_t bytes) const
+{
+  if (itsStatistics) {
+      itsStatistics->addWrite(column, bytes);
+  }
+}
+
+/// @brief wait for the background jobs to finish
+/// @details The table system is not thread-safe. This method should be called
+/// before any access to the main table. It waits for the read-ahead and does nothing
+/// if prefetch is not used. Derived classes running their own background jobs
+/// should override it.
+void TableConstDataIterator::waitForBackgroundJobs() const
+{
+  if (itsPrefetcher) {
+      itsPrefetcher->wait();
+  }
+}
+
+/// @brief start reading the next chunk in the background
+/// @details This method is called when the bulk data of the current chunk
+/// have been obtained by the accessor, so the background read would overlap with
+/// the processing of the current chunk. It does nothing if prefetch is not used or
+/// there is no next chunk.
+void TableConstDataIterator::startPrefetch() const
+{
+  if (!itsPrefetcher || !itsNumberOfRows) {
+      return;
+  }
+  const casacore::uInt nextTopRow = itsCurrentTopRow + itsNumberOfRows;
+  if (nextTopRow < itsIterationEnd) {
+      // next chunk is within the same iteration of the table iterator,
+      // the prefetcher counts rows from the start of the time step
+      itsPrefetcher->start(itsIterationStep, nextTopRow - itsIterationStart, 
+                           maxChunkSize(itsCurrentDataDescID), itsNumberOfPols,
+                           itsNumberOfChannels, startChannel(), nChannel());
+  } else if (!itsTabIterator.pastEnd()) {
+      // next chunk starts the next iteration, the prefetcher finds out whether there is one
+      itsPrefetcher->start(itsIterationStep + 1, 0, maxChunkSize(itsCurrentDataDescID), itsNumberOfPols,
+                           itsNumberOfChannels, startChannel(), nChannel());
+  }
+}
+
+/// @brief notify that a bulk field of the current chunk has been obtained
+/// @details If the required fields have been declared via the selector, the 
+/// background jobs are started when all declared bulk fields (visibility, flag, noise and 
+/// uvw) of the current chunk have been obtained. Otherwise, they are started when the
+/// visibilities are obtained (see chunkObtained).
+/// @param[in] field field which has been filled (ITableDataSelectorImpl::AccessorField)
+void TableConstDataIterator::fieldObtained(int field) const
+{
+  const int required = itsSelector->requiredFields();
+  if (required == ITableDataSelectorImpl::ALL_FIELDS) {
+      // nothing has been declared, visibilities are the best guess
+      if (field == ITableDataSelectorImpl::VISIBILITY_FIELD) {
+          chunkObtained();
+      }
+      return;
+  }
+  itsFieldsObtained |= field;
+  const int bulkFields = required & (ITableDataSelectorImpl::VISIBILITY_FIELD | 
+           ITableDataSelectorImpl::FLAG_FIELD | ITableDataSelectorImpl::NOISE_FIELD | 
+           ITableDataSelectorImpl::UVW_FIELD);
+  if ((itsFieldsObtained & bulkFields) == bulkFields) {
+      chunkObtained();
+  }
+}
+
+/// @brief notify that the bulk data of the current chunk have been obtained
+/// @details This method is called by fieldObtained at the point where the table
+/// is not expected to be needed for a while. The default action is to start the
+/// read-ahead. Derived classes can use it to start their own background jobs.
+void TableConstDataIterator::chunkObtained() const
+{
+  startPrefetch();
+}
+
+/// @brief make prefetched data available for the current chunk
+/// @details This method is called after the iteration is advanced. The data read
+/// in the background are checked against the current chunk and discarded if they don't
+/// match (e.g. if the chunk has been broken due to non-uniform DATA_DESC_ID).
+void TableConstDataIterator::acceptPrefetchedChunk()
+{
+  if (itsPrefetcher) {
+      itsPrefetcher->acceptChunk(itsIterationStep, itsCurrentTopRow - itsIterationStart, itsNumberOfRows,
+                                 itsNumberOfPols, itsNumberOfRows ? nChannel() : 0);
+  }
+}
+
 /// setup accessor for a new iteration of the table iterator
 void TableConstDataIterator::setUpIteration()
 {
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::SET_UP_ITERATION);
+  // all steps refer to the selected table, only the range of rows changes
   itsCurrentIteration=itsTabIterator.table();
+  itsIterationStart = itsTabIterator.startRow();
+  itsIterationEnd = itsIterationStart + itsTabIterator.nrow();
+  itsCurrentTopRow = itsIterationStart;
   itsAccessor.invalidateIterationCaches();
 
-  itsNumberOfRows=itsCurrentIteration.nrow()<=itsMaxChunkSize ?
-                  itsCurrentIteration.nrow() : itsMaxChunkSize;
+  itsNumberOfRows=itsTabIterator.nrow()<=itsMaxChunkSize ?
+                  itsTabIterator.nrow() : itsMaxChunkSize;
 
-  if ((itsDirectionCache.isValid() || itsParallacticAngleCache.isValid())
+  if ((itsSelector->requiredFields() & (ITableDataSelectorImpl::DIRECTION_FIELD |
+                                         ITableDataSelectorImpl::FEED_PA_FIELD)) == 0) {
+      // directions and position angles have been declared unused, don't analyse
+      // the subtables. The caches are just dropped in case these fields are read anyway.
+      itsDirectionCache.invalidate();
+      itsAccessor.invalidateRotatedUVW();
+      itsDishPointingCache.invalidate();
+      itsParallacticAngleCache.invalidate();
+  } else if ((itsDirectionCache.isValid() || itsParallacticAngleCache.isValid())
        && itsCurrentDataDescID>=0) {
       // extra checks make sense if the cache is valid (and this means it
       // has been used before)
@@ -297,7 +782,9 @@ void TableConstDataIterator::setUpIteration()
       makeUniformFieldID();
   } else {
       itsNumberOfChannels = 0;
+      itsNumberOfStoredPols = 0;
       itsNumberOfPols = 0;
+      itsPolConversion.resize(0,0);
       itsCurrentDataDescID = -100;
       itsCurrentFieldID = -100;
       itsDirectionCache.invalidate();
@@ -306,6 +793,32 @@ void TableConstDataIterator::setUpIteration()
       itsParallacticAngleCache.invalidate();
       itsDishPointingCache.invalidate();
   }
+  itsNChannelTiles = countChannelTiles();
+}
+
+/// @brief setup the next chunk within the current iteration of the table iterator
+/// @details The chunk starts at itsCurrentTopRow, the number of rows is limited by the
+/// maximum chunk size and by changes of DATA_DESC_ID and FIELD_ID
+void TableConstDataIterator::setUpChunk()
+{
+  ASKAPDEBUGASSERT(itsCurrentTopRow < itsIterationEnd);
+  uInt remainder=itsIterationEnd-itsCurrentTopRow;
+  itsNumberOfRows=remainder<=itsMaxChunkSize ?
+                  remainder : itsMaxChunkSize;
+  itsAccessor.invalidateIterationCaches();
+  // itsDirectionCache don't need invalidation because the time is the same
+  // as for the previous iteration
+
+  // determine whether DATA_DESC_ID is uniform in the whole chunk
+  // and reduce itsNumberOfRows if necessary
+  makeUniformDataDescID();
+
+  // determine whether FIELD_ID is uniform in the whole chunk
+  // and reduce itsNumberOfRows if necessary
+  // invalidate direction cache if necessary.
+  // do nothing if itsUseFieldID is false
+  makeUniformFieldID();
+  itsNChannelTiles = countChannelTiles();
 }
 
 /// @brief method ensures that the chunk has uniform DATA_DESC_ID
@@ -314,15 +827,15 @@ void TableConstDataIterator::setUpIteration()
 /// The resulting itsNumberOfRows will be 1 or more.
 /// theirAccessor's spectral axis cache is reset if new DATA_DESC_ID is
 /// different from itsCurrentDataDescID
-/// This method also sets up itsNumberOfPols and itsNumberOfChannels
-/// when DATA_DESC_ID changes (and therefore at the first run as well)
+/// This method also sets up the number of polarisations (and their selection)
+/// and itsNumberOfChannels when DATA_DESC_ID changes (and therefore at the
+/// first run as well)
 void TableConstDataIterator::makeUniformDataDescID()
 {
   ASKAPDEBUGASSERT(itsNumberOfRows);
-  ASKAPDEBUGASSERT(itsCurrentTopRow+itsNumberOfRows<=
-                    itsCurrentIteration.nrow());
+  ASKAPDEBUGASSERT(itsCurrentTopRow+itsNumberOfRows<=itsIterationEnd);
 
-  ROScalarColumn<Int> dataDescCol(itsCurrentIteration,"DATA_DESC_ID");
+  const ROScalarColumn<Int> &dataDescCol = scalarColumn<Int>("DATA_DESC_ID");
   const Int newDataDescID=dataDescCol(itsCurrentTopRow);
   ASKAPDEBUGASSERT(newDataDescID>=0);
   if (itsCurrentDataDescID!=newDataDescID) {
@@ -347,21 +860,28 @@ void TableConstDataIterator::makeUniformDataDescID()
       }
 
       // determine the shape of the visibility cube
-      ROArrayColumn<Complex> visCol(itsCurrentIteration,getDataColumnName());
+      const ROArrayColumn<Complex> &visCol = arrayColumn<Complex>(getDataColumnName());
       const casacore::IPosition shape=visCol.shape(itsCurrentTopRow);
       ASKAPASSERT(shape.size() && (shape.size()<3));
-      itsNumberOfPols=shape[0];
+      itsNumberOfStoredPols=shape[0];
       itsNumberOfChannels=shape.size()>1?shape[1]:1;
+      setUpPolSelection();
       ASKAPDEBUGASSERT(itsSelector);
       if (itsSelector->channelsSelected()) {
           // validity checks that selection doesn't extend beyond the channels available
           const std::pair<int,int> chanSelection = itsSelector->getChannelSelection();
-          ASKAPCHECK(itsNumberOfChannels >= casacore::uInt(chanSelection.first + chanSelection.second),
-               "Channel selection from "<<chanSelection.second+1<<" to "<<chanSelection.first+
+          const casacore::uInt nUsed = casacore::uInt(chanSelection.first) * channelAveraging();
+          ASKAPCHECK(itsNumberOfChannels >= nUsed + casacore::uInt(chanSelection.second),
+               "Channel selection from "<<chanSelection.second+1<<" to "<<nUsed+
                chanSelection.second<<" (1-based) extends beyond "<<itsNumberOfChannels<<
                " channel(s) available in  the dataset");
       }
   }
+  // the memory budget (if any) depends on the spectral setup
+  const casacore::uInt maxRows = maxChunkSize(itsCurrentDataDescID);
+  if (itsNumberOfRows > maxRows) {
+      itsNumberOfRows = maxRows;
+  }
   for (uInt row=1;row<itsNumberOfRows;++row) {
        if (dataDescCol(row+itsCurrentTopRow)!=itsCurrentDataDescID) {
            itsNumberOfRows=row;
@@ -370,6 +890,68 @@ void TableConstDataIterator::makeUniformDataDescID()
   }
 }
 
+/// @brief maximum number of rows per chunk for the given spectral setup
+/// @details If the memory budget is set, the number of rows is derived from the 
+/// number of channels and polarisations of the given data description and the
+/// bulk fields required. It doesn't exceed the maximum chunk size given in the 
+/// constructor and is at least one row.
+/// @param[in] dataDescID data description ID
+/// @return maximum number of rows
+casacore::uInt TableConstDataIterator::maxChunkSize(casacore::Int dataDescID) const
+{
+  if (itsChunkMemoryBudget == 0) {
+      return itsMaxChunkSize;
+  }
+  const std::map<casacore::Int, casacore::uInt>::const_iterator ci = itsBudgetChunkSizes.find(dataDescID);
+  if (ci != itsBudgetChunkSizes.end()) {
+      return ci->second;
+  }
+  const size_t rowBytes = chunkRowBytes(dataDescID);
+  ASKAPDEBUGASSERT(rowBytes > 0);
+  const size_t nRows = std::max(itsChunkMemoryBudget / rowBytes, size_t(1));
+  const casacore::uInt result = nRows < itsMaxChunkSize ? casacore::uInt(nRows) : itsMaxChunkSize;
+  itsBudgetChunkSizes[dataDescID] = result;
+  return result;
+}
+
+/// @brief estimate of the memory used by one row of a chunk
+/// @details The estimate covers the cubes and per-row fields required from the accessor
+/// (visibility, flag, noise and uvw), assuming the whole cell is read.
+/// @param[in] dataDescID data description ID
+/// @return number of bytes per row
+size_t TableConstDataIterator::chunkRowBytes(casacore::Int dataDescID) const
+{
+  ASKAPCHECK(dataDescID >= 0, "Data description ID should be non-negative, you have "<<dataDescID);
+  const ITableDataDescHolder &dataDescription = subtableInfo().getDataDescription();
+  const int spWindowID = dataDescription.getSpectralWindowID(size_t(dataDescID));
+  const int polID = dataDescription.getPolarizationID(size_t(dataDescID));
+  ASKAPCHECK((spWindowID >= 0) && (polID >= 0), "Data description ID "<<dataDescID<<
+             " refers to an invalid spectral window or polarisation");
+  size_t nChan = subtableInfo().getSpWindow().getFrequencies(casacore::uInt(spWindowID)).nelements();
+  if (itsMaxChannels > 0) {
+      // only one tile of channels is read at a time
+      nChan = std::min(nChan, size_t(itsMaxChannels) * channelAveraging());
+  }
+  const size_t nPol = subtableInfo().getPolarisation().nPol(casacore::uInt(polID));
+  const int required = itsSelector->requiredFields();
+  size_t cellBytes = 0;
+  if (required & ITableDataSelectorImpl::VISIBILITY_FIELD) {
+      cellBytes += sizeof(casacore::Complex);
+  }
+  if (required & ITableDataSelectorImpl::FLAG_FIELD) {
+      cellBytes += sizeof(casacore::Bool);
+  }
+  if (required & ITableDataSelectorImpl::NOISE_FIELD) {
+      cellBytes += sizeof(casacore::Complex);
+  }
+  // antenna and feed indices are always there
+  size_t rowBytes = 4 * sizeof(casacore::uInt);
+  if (required & ITableDataSelectorImpl::UVW_FIELD) {
+      rowBytes += 3 * sizeof(casacore::Double);
+  }
+  return nChan * nPol * cellBytes + rowBytes;
+}
+
 /// @brief method ensures that the chunk has a uniform FIELD_ID
 /// @details This method reduces itsNumberOfRows until FIELD_ID is
 /// the same for all rows in the current chunk. The resulting
@@ -381,10 +963,9 @@ void TableConstDataIterator::makeUniformFieldID()
 {
   if (itsUseFieldID) {
       ASKAPDEBUGASSERT(itsNumberOfRows);
-      ASKAPDEBUGASSERT(itsCurrentTopRow+itsNumberOfRows<=
-                       itsCurrentIteration.nrow());
+      ASKAPDEBUGASSERT(itsCurrentTopRow+itsNumberOfRows<=itsIterationEnd);
 
-      ROScalarColumn<Int> fieldIDCol(itsCurrentIteration,"FIELD_ID");
+      const ROScalarColumn<Int> &fieldIDCol = scalarColumn<Int>("FIELD_ID");
       const Int newFieldID=fieldIDCol(itsCurrentTopRow);
       ASKAPDEBUGASSERT(newFieldID>=0);
       if (newFieldID != itsCurrentFieldID) {
@@ -412,55 +993,344 @@ void TableConstDataIterator::makeUniformFieldID()
 /// @param[in] cube a reference to the nRow x nChannel x nPol buffer
 ///            cube to fill with the information from table
 /// @param[in] columnName a name of the column to read
+/// @param[in] buffer storage reused for the cube between chunks
+/// @param[in] scratch storage reused for the intermediate cube in the native order
 template<typename T>
 void TableConstDataIterator::fillCube(casacore::Cube<T> &cube,
-               const std::string &columnName) const
+               const std::string &columnName, ReusableBuffer<T> &buffer,
+               ReusableBuffer<T> &scratch) const
 {
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_CUBE);
+  const AccessTracer::Scope trace("fillCube", columnName, "dataaccess");
+  waitForBackgroundJobs();
   const casacore::uInt nChan = nChannel();
-  const casacore::uInt startChan = startChannel();
 
-  // Setup a slicer to extract the specified channel range only
-  const Slicer chanSlicer(Slice(),Slice(startChan,nChan));
+  // Setup a slicer to extract the specified channels and polarisations only
+  const Slicer chanSlicer = cellSlicer();
 
-  cube.resize(itsNumberOfRows, nChan, itsNumberOfPols);
-  ROArrayColumn<T> tableCol(itsCurrentIteration,columnName);
+  buffer.reshape(cube, itsNumberOfRows, nChan, itsNumberOfPols);
+  countRead(columnName, cube.nelements() * sizeof(T));
+  const ROArrayColumn<T> &tableCol = arrayColumn<T>(columnName);
 
   // helper class, which does nothing for visibility cube, but checks
   // FLAG_ROW for flagging
   WholeRowFlagger<T> wrFlagger(itsCurrentIteration);
 
-  // temporary buffer declared outside the loop
-  casacore::Matrix<T> buf(itsNumberOfPols, nChan);
+  if (itsSkipFlaggedRows) {
+      // only rows with data are read, the rest get the flagged value
+      casacore::Cube<T> buf;
+      scratch.reshape(buf, itsNumberOfPols, nChan, itsNumberOfRows);
+      readUnflaggedRows(buf, columnName, WholeRowFlagger<T>::flaggedValue());
+      CubeTransposer::transpose(buf, cube);
+      return;
+  }
+
+  if (uniformCellShape(tableCol)) {
+      // all rows of the chunk have the same 2D shape, read them in one go
+      // and transpose the whole chunk at once
+      const Slicer rowSlicer(IPosition(1, itsCurrentTopRow), IPosition(1, itsNumberOfRows));
+      casacore::Cube<T> buf;
+      scratch.reshape(buf, itsNumberOfPols, nChan, itsNumberOfRows);
+      tableCol.getColumnRange(rowSlicer, chanSlicer, buf, False);
+      CubeTransposer::transpose(buf, cube);
+      // overwrite rows flagged via FLAG_ROW (does nothing for visibilities)
+      for (uInt row=0; row<itsNumberOfRows; ++row) {
+           wrFlagger.copyRequired(row + itsCurrentTopRow, row, cube);
+      }
+      return;
+  }
+
+  // per-row fallback, rows have different shapes or the shape is not 2D
+  // temporary buffer declared outside the loop, the scratch is not used otherwise
+  casacore::Matrix<T> buf;
+  scratch.reshape(buf, itsNumberOfPols, nChan);
   for (uInt row=0; row<itsNumberOfRows; ++row) {
-       const casacore::IPosition shape = tableCol.shape(row);
-       ASKAPASSERT(shape.size() && (shape.size()<3));
-       const casacore::uInt thisRowNumberOfPols=shape[0];
-       const casacore::uInt thisRowNumberOfChannels = shape.size() > 1 ? shape[1] : 1;
-       if (thisRowNumberOfPols!=itsNumberOfPols) {
-           ASKAPTHROW(DataAccessError,"Number of polarizations is not "
-	               "conformant for row "<<row<<" of the "<<columnName<<
-	               "column");
-       }
-       if (thisRowNumberOfChannels!=itsNumberOfChannels) {
-           ASKAPTHROW(DataAccessError,"Number of channels is not "
-	               "conformant for row "<<row<<" of the "<<columnName<<
-	               "column");
-       }
+       checkCellShape(tableCol, row, columnName);
        // for now just copy. In the future we will pass this array through
        // the transformation which will do averaging, selection,
        // polarization conversion
 
-       if (wrFlagger.copyRequired(row + itsCurrentTopRow, cube)) {
+       if (wrFlagger.copyRequired(row + itsCurrentTopRow, row, cube)) {
            // Extract slice for this row
            tableCol.getSlice(row + itsCurrentTopRow, chanSlicer, buf, False);
 
            // Copy the slice into the cube
-           for (uInt chan = 0; chan < nChan; ++chan) {
-               for (uInt pol = 0; pol < itsNumberOfPols; ++pol) {
-                   cube(row,chan,pol) = buf(pol,chan);
-               }
+           CubeTransposer::transposeRow(buf, cube, row);
+       }
+  }
+}
+
+/// @brief array column of the selected table
+/// @details Column objects are created on the first request and reused for
+/// the whole pass, so they're not attached again for every chunk.
+/// @param[in] name name of the column
+/// @return a reference to the column object
+template<typename T>
+const casacore::ROArrayColumn<T>& TableConstDataIterator::arrayColumn(const std::string &name) const
+{
+  boost::shared_ptr<casacore::ROTableColumn> &col = itsColumnCache[name];
+  if (!col) {
+      col.reset(new casacore::ROArrayColumn<T>(itsSelectedTable, name));
+  }
+  const casacore::ROArrayColumn<T> *result = dynamic_cast<const casacore::ROArrayColumn<T>*>(col.get());
+  ASKAPCHECK(result != NULL, "Column "<<name<<" has been requested with different types");
+  return *result;
+}
+
+/// @brief scalar column of the selected table
+/// @details See arrayColumn for details
+/// @param[in] name name of the column
+/// @return a reference to the column object
+template<typename T>
+const casacore::ROScalarColumn<T>& TableConstDataIterator::scalarColumn(const std::string &name) const
+{
+  boost::shared_ptr<casacore::ROTableColumn> &col = itsColumnCache[name];
+  if (!col) {
+      col.reset(new casacore::ROScalarColumn<T>(itsSelectedTable, name));
+  }
+  const casacore::ROScalarColumn<T> *result = dynamic_cast<const casacore::ROScalarColumn<T>*>(col.get());
+  ASKAPCHECK(result != NULL, "Column "<<name<<" has been requested with different types");
+  return *result;
+}
+
+/// @brief check that all rows of the current chunk have the same cell shape
+/// @details Bulk read of a number of rows is only possible if the cells of
+/// the array column are 2D and have the same shape as the first row of the chunk
+/// (the shape which defines itsNumberOfStoredPols and itsNumberOfChannels).
+/// @param[in] col array column to check
+/// @return true, if all cells are 2D and conform to the current shape
+bool TableConstDataIterator::uniformCellShape(const casacore::ROTableColumn &col) const
+{
+  const casacore::IPosition expectedShape(2, itsNumberOfStoredPols, itsNumberOfChannels);
+  const casacore::ColumnDesc &desc = col.columnDesc();
+  if (desc.isFixedShape()) {
+      // all cells of a fixed shape column are defined, no need to check them one by one
+      return desc.shape().isEqual(expectedShape);
+  }
+  for (uInt row=0; row<itsNumberOfRows; ++row) {
+       if (!col.isDefined(row + itsCurrentTopRow)) {
+           return false;
+       }
+       const casacore::IPosition shape = col.shape(row + itsCurrentTopRow);
+       if (!shape.isEqual(expectedShape)) {
+           return false;
+       }
+  }
+  return true;
+}
+
+/// @brief check the shape of one cell of an array column
+/// @details An exception is thrown if the given row of the current chunk
+/// doesn't conform to the number of polarisations and channels set up for the chunk.
+/// @param[in] col array column to check
+/// @param[in] row row of the current chunk (i.e. w.r.t. itsCurrentTopRow)
+/// @param[in] columnName name of the column (for the error message)
+void TableConstDataIterator::checkCellShape(const casacore::ROTableColumn &col,
+               casacore::uInt row, const std::string &columnName) const
+{
+  const casacore::IPosition shape = col.shape(row + itsCurrentTopRow);
+  ASKAPASSERT(shape.size() && (shape.size()<3));
+  const casacore::uInt thisRowNumberOfPols=shape[0];
+  const casacore::uInt thisRowNumberOfChannels = shape.size() > 1 ? shape[1] : 1;
+  if (thisRowNumberOfPols!=itsNumberOfStoredPols) {
+      ASKAPTHROW(DataAccessError,"Number of polarizations is not "
+                 "conformant for row "<<row<<" of the "<<columnName<<
+                 "column");
+  }
+  if (thisRowNumberOfChannels!=itsNumberOfChannels) {
+      ASKAPTHROW(DataAccessError,"Number of channels is not "
+                 "conformant for row "<<row<<" of the "<<columnName<<
+                 "column");
+  }
+}
+
+/// @brief slicer of a table cell for the current chunk
+/// @details The slicer covers the selected polarisations and channels. If the
+/// requested polarisation products are a subset of the stored ones, only this subset
+/// is read. If channels are averaged at read time, the slicer covers all channels 
+/// contributing to the current range of averaged channels.
+/// @return slicer to be used with getSlice or getColumnRange
+casacore::Slicer TableConstDataIterator::cellSlicer() const
+{
+  return Slicer(itsPolSlice, Slice(startChannel(), nChannel() * channelAveraging()));
+}
+
+/// @brief set up polarisation selection for the current data description
+/// @details This method sets itsNumberOfPols, itsPolSlice and itsPolConversion
+/// from the products requested via the selector and the products stored in the
+/// table. It is called when DATA_DESC_ID changes.
+void TableConstDataIterator::setUpPolSelection()
+{
+  itsNumberOfPols = itsNumberOfStoredPols;
+  itsPolSlice = Slice();
+  itsPolConversion.resize(0,0);
+  ASKAPDEBUGASSERT(itsSelector);
+  const casacore::Vector<casacore::Stokes::StokesTypes> &requested = itsSelector->getPolarizationSelection();
+  if (requested.nelements() == 0) {
+      return;
+  }
+  const casacore::Vector<casacore::Stokes::StokesTypes> stored = 
+        subtableInfo().getPolarisation().getTypes(currentPolID());
+  ASKAPCHECK(stored.nelements() == itsNumberOfStoredPols, "The number of polarisation products in the "
+             "POLARIZATION subtable ("<<stored.nelements()<<") doesn't match the shape of the data column ("<<
+             itsNumberOfStoredPols<<")");
+  std::vector<casacore::uInt> positions;
+  for (casacore::uInt pol = 0; pol < requested.nelements(); ++pol) {
+       const casacore::uInt pos = std::find(stored.begin(), stored.end(), requested[pol]) - stored.begin();
+       if (pos == stored.nelements()) {
+           break;
+       }
+       positions.push_back(pos);
+  }
+  // the slicer can only take products in the stored order at a constant stride
+  bool strided = (positions.size() == requested.nelements());
+  const casacore::uInt stride = positions.size() > 1 ? positions[1] - positions[0] : 1;
+  for (size_t i = 1; strided && (i < positions.size()); ++i) {
+       strided = (positions[i] > positions[i - 1]) && (positions[i] - positions[i - 1] == stride);
+  }
+  if (!strided) {
+      // read all stored products and convert them
+      itsPolConversion.reference(PolConvertingAccessor::conversionMatrix(stored, requested));
+      return;
+  }
+  itsPolSlice = Slice(positions[0], positions.size(), stride);
+  itsNumberOfPols = positions.size();
+}
+
+/// @brief check that the data are delivered as stored
+/// @details An exception is thrown if the requested polarisation products are not 
+/// a subset of the stored ones or if channels are averaged at read time, because the
+/// given operation can't be done in this case.
+/// @param[in] what description of the operation (for the error message)
+void TableConstDataIterator::checkNoConversion(const char *what) const
+{
+  if (itsPolConversion.nelements()) {
+      ASKAPTHROW(DataAccessLogicError, what<<" are not available if the requested polarisation "
+                 "products are converted from the stored ones");
+  }
+  if (channelAveraging() > 1) {
+      ASKAPTHROW(DataAccessLogicError, what<<" are not available if channels are averaged "
+                 "at read time");
+  }
+}
+
+/// @brief read an array column of the table into a cube in the native order
+/// @details This method is similar to fillCube, but the cube is filled in the
+/// order the data are stored in the table, i.e. nPol x nChannel x nRow. No
+/// transpose is required, so the whole chunk is read directly into the buffer
+/// if all rows have the same shape.
+/// @param[in] cube a reference to the nPol x nChannel x nRow buffer
+///            cube to fill with the information from table
+/// @param[in] columnName a name of the column to read
+/// @param[in] buffer storage reused for the cube between chunks
+template<typename T>
+void TableConstDataIterator::fillNativeCube(casacore::Cube<T> &cube,
+               const std::string &columnName, ReusableBuffer<T> &buffer) const
+{
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_CUBE);
+  const AccessTracer::Scope trace("fillNativeCube", columnName, "dataaccess");
+  waitForBackgroundJobs();
+  const casacore::uInt nChan = nChannel();
+
+  // Setup a slicer to extract the specified channels and polarisations only
+  const Slicer chanSlicer = cellSlicer();
+
+  buffer.reshape(cube, itsNumberOfPols, nChan, itsNumberOfRows);
+  countRead(columnName, cube.nelements() * sizeof(T));
+  if (itsSkipFlaggedRows) {
+      readUnflaggedRows(cube, columnName, WholeRowFlagger<T>::flaggedValue());
+      return;
+  }
+  const ROArrayColumn<T> &tableCol = arrayColumn<T>(columnName);
+  WholeRowFlagger<T> wrFlagger(itsCurrentIteration);
+
+  if (uniformCellShape(tableCol)) {
+      const Slicer rowSlicer(IPosition(1, itsCurrentTopRow), IPosition(1, itsNumberOfRows));
+      tableCol.getColumnRange(rowSlicer, chanSlicer, cube, False);
+  } else {
+      for (uInt row=0; row<itsNumberOfRows; ++row) {
+           checkCellShape(tableCol, row, columnName);
+           // xy-plane of the contiguous cube references its storage
+           casacore::Matrix<T> rowBuf = cube.xyPlane(row);
+           tableCol.getSlice(row + itsCurrentTopRow, chanSlicer, rowBuf, False);
+      }
+  }
+  // overwrite rows flagged via FLAG_ROW (does nothing for visibilities)
+  for (uInt row=0; row<itsNumberOfRows; ++row) {
+       wrFlagger.flagNativeRow(row + itsCurrentTopRow, row, cube);
+  }
+}
+
+/// @brief read rows which are not flagged as a whole into a cube in the native order
+/// @details This is the reader used if flagged rows are skipped. Only rows present
+/// in the map returned by unflaggedRows are read, contiguous runs of such rows are
+/// read in one go if all cells have the same shape. Other rows are filled with the
+/// given value.
+/// @param[in] cube a reference to the nPol x nChannel x nRow buffer
+///            cube to fill with the information from table
+/// @param[in] columnName a name of the column to read
+/// @param[in] flaggedValue value assigned to the rows which are not read
+template<typename T>
+void TableConstDataIterator::readUnflaggedRows(casacore::Cube<T> &cube,
+               const std::string &columnName, const T &flaggedValue) const
+{
+  ASKAPDEBUGASSERT(cube.nrow() == itsNumberOfPols);
+  ASKAPDEBUGASSERT(cube.nplane() == itsNumberOfRows);
+  waitForBackgroundJobs();
+  const casacore::Vector<casacore::uInt> &rows = itsAccessor.unflaggedRows();
+  if (rows.nelements() < itsNumberOfRows) {
+      cube = flaggedValue;
+  }
+  if (rows.nelements() == 0) {
+      return;
+  }
+  const casacore::uInt nChan = cube.ncolumn();
+  const Slicer chanSlicer = cellSlicer();
+  const ROArrayColumn<T> &tableCol = arrayColumn<T>(columnName);
+  // cells of the flagged rows may be undefined, the per-row reader handles this case
+  const bool uniform = uniformCellShape(tableCol);
+  for (casacore::uInt index = 0; index < rows.nelements(); ) {
+       // find contiguous run of rows with data
+       const casacore::uInt first = rows[index];
+       casacore::uInt count = 1;
+       while ((index + count < rows.nelements()) && (rows[index + count] == first + count)) {
+              ++count;
+       }
+       if (uniform) {
+           const Slicer rowSlicer(IPosition(1, first + itsCurrentTopRow), IPosition(1, count));
+           casacore::Cube<T> section = cube(IPosition(3, 0, 0, first),
+                         IPosition(3, itsNumberOfPols - 1, nChan - 1, first + count - 1));
+           tableCol.getColumnRange(rowSlicer, chanSlicer, section, False);
+       } else {
+           for (casacore::uInt row = first; row < first + count; ++row) {
+                checkCellShape(tableCol, row, columnName);
+                casacore::Matrix<T> rowBuf = cube.xyPlane(row);
+                tableCol.getSlice(row + itsCurrentTopRow, chanSlicer, rowBuf, False);
            }
        }
+       index += count;
+  }
+}
+
+/// @brief set visibilities of the rows flagged as a whole to zero
+/// @details This is used for visibilities obtained from the background reader,
+/// which always reads the whole chunk.
+/// @param[in] vis visibility cube to update
+/// @param[in] native true, if the cube is in the storage order (nPol x nChannel x nRow),
+/// false for the accessor order (nRow x nChannel x nPol)
+void TableConstDataIterator::blankFlaggedRows(casacore::Cube<casacore::Complex> &vis,
+               bool native) const
+{
+  const casacore::Vector<casacore::uInt> &rows = itsAccessor.unflaggedRows();
+  casacore::uInt index = 0;
+  for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+       if ((index < rows.nelements()) && (rows[index] == row)) {
+           ++index;
+       } else if (native) {
+           vis.xyPlane(row) = casacore::Complex(0.);
+       } else {
+           vis.yzPlane(row) = casacore::Complex(0.);
+       }
   }
 }
 
@@ -470,7 +1340,171 @@ void TableConstDataIterator::fillCube(casacore::Cube<T> &cube,
 ///            cube to fill with the complex visibility data
 void TableConstDataIterator::fillVisibility(casacore::Cube<casacore::Complex> &vis) const
 {
-  fillCube(vis, getDataColumnName());
+  if (itsPolConversion.nelements()) {
+      // all stored products are read and then converted to the requested ones
+      casacore::Cube<casacore::Complex> stored;
+      if (channelAveraging() > 1) {
+          fillAveragedCubes();
+          stored.reference(itsAveragedVis);
+      } else {
+          fillCube(stored, getDataColumnName(), itsStoredComplexBuffer, itsComplexScratch);
+      }
+      itsVisBuffer.reshape(vis, itsNumberOfRows, stored.ncolumn(), nPol());
+      PolConvertingAccessor::convertVisibility(stored, itsPolConversion, vis);
+      fieldObtained(ITableDataSelectorImpl::VISIBILITY_FIELD);
+  } else if (channelAveraging() > 1) {
+      // visibilities are averaged together with flags and noise
+      fillAveragedCubes();
+      vis.reference(itsAveragedVis);
+      fieldObtained(ITableDataSelectorImpl::VISIBILITY_FIELD);
+  } else if (itsNativeLayout) {
+      // the native cube is the primary buffer, derive this one from it
+      const casacore::Cube<casacore::Complex> &nativeVis = itsAccessor.nativeVisibility();
+      itsVisBuffer.reshape(vis, nativeVis.nplane(), nativeVis.ncolumn(), nativeVis.nrow());
+      CubeTransposer::transpose(nativeVis, vis);
+  } else {
+      if (itsPrefetcher && itsPrefetcher->getVisibility(vis)) {
+          if (itsSkipFlaggedRows) {
+              blankFlaggedRows(vis, false);
+          }
+      } else {
+          fillCube(vis, getDataColumnName(), itsVisBuffer, itsComplexScratch);
+      }
+      // the bulk of the current chunk is in memory, read the next one in the meantime
+      fieldObtained(ITableDataSelectorImpl::VISIBILITY_FIELD);
+  }
+  if (itsQCStatistics) {
+      accumulateQCStatistics(vis);
+  }
+}
+
+/// @brief update the quality control statistics with the current chunk
+/// @details This method is called when the visibilities are filled if the statistics
+/// are attached. It does nothing if the current chunk has already been accumulated
+/// (e.g. the cube is read again after releaseBuffers). The flags of the current chunk
+/// are obtained via the accessor.
+/// @param[in] vis visibilities of the current chunk (nRow x nChannel x nPol)
+void TableConstDataIterator::accumulateQCStatistics(const casacore::Cube<casacore::Complex> &vis) const
+{
+  ASKAPDEBUGASSERT(itsQCStatistics);
+  if (itsQCChunkAdded) {
+      return;
+  }
+  // set before the flags are read, so fillFlag doesn't mark the chunk as pending
+  itsQCChunkAdded = true;
+  // the cube is still in cache, so this is cheaper than a separate pass over the data
+  itsQCStatistics->add(vis, itsAccessor.flag(), itsAccessor.antenna1(), itsAccessor.antenna2(),
+                       itsAccessor.feed1(), startChannel(), channelAveraging());
+  itsQCChunkPending = false;
+}
+
+/// @brief mark the current chunk for the quality control statistics
+/// @details This method is called when the flags are filled. If the visibilities of
+/// the chunk haven't been accumulated yet, they are read by finishQCStatistics.
+void TableConstDataIterator::flagsObtainedForQC() const
+{
+  if (itsQCStatistics && !itsQCChunkAdded) {
+      itsQCChunkPending = true;
+  }
+}
+
+/// @brief complete the quality control statistics for the current chunk
+/// @details This method is called before the iterator leaves the current chunk. The
+/// visibilities are read if only the flags of the chunk have been used, so every
+/// chunk is accumulated exactly once regardless of the fields accessed.
+void TableConstDataIterator::finishQCStatistics()
+{
+  if (itsQCStatistics && itsQCChunkPending && !itsQCChunkAdded) {
+      // accumulated by fillVisibility, the flags are served from the cache
+      itsAccessor.visibility();
+  }
+  itsQCChunkAdded = false;
+  itsQCChunkPending = false;
+}
+
+/// @brief populate the buffer of visibilities in the native order
+/// @param[in] vis a reference to the nPol x nChannel x nRow buffer
+///            cube to fill with the complex visibility data
+void TableConstDataIterator::fillNativeVisibility(casacore::Cube<casacore::Complex> &vis) const
+{
+  checkNoConversion("Visibilities in the native order");
+  if (itsNativeLayout && itsPrefetcher && itsPrefetcher->getVisibility(vis)) {
+      if (itsSkipFlaggedRows) {
+          blankFlaggedRows(vis, true);
+      }
+  } else {
+      fillNativeCube(vis, getDataColumnName(), itsNativeVisBuffer);
+  }
+  if (itsNativeLayout) {
+      // the bulk of the current chunk is in memory, read the next one in the meantime
+      fieldObtained(ITableDataSelectorImpl::VISIBILITY_FIELD);
+  }
+  if (itsQCStatistics && !itsQCChunkAdded) {
+      // the statistics are accumulated in the accessor order
+      casacore::Cube<casacore::Complex> transposed;
+      CubeTransposer::transpose(vis, transposed);
+      accumulateQCStatistics(transposed);
+  }
+}
+
+/// @brief populate the buffer of flags in the native order
+/// @param[in] flag a reference to the nPol x nChannel x nRow buffer
+///            cube to fill with the flag information
+void TableConstDataIterator::fillNativeFlag(casacore::Cube<casacore::Bool> &flag) const
+{
+  checkNoConversion("Flags in the native order");
+  if (!itsNativeLayout || !itsPrefetcher || !itsPrefetcher->getFlag(flag)) {
+      fillNativeCube(flag, "FLAG", itsNativeFlagBuffer);
+  }
+  if (itsNativeLayout) {
+      fieldObtained(ITableDataSelectorImpl::FLAG_FIELD);
+  }
+  flagsObtainedForQC();
+}
+
+/// @brief populate the buffer of noise figures in the native order
+/// @details The bulk read is only done for SIGMA_SPECTRUM, other cases are
+/// handled by the general noise reader followed by a transpose.
+/// @param[in] noise a reference to the nPol x nChannel x nRow buffer
+///            cube to be filled with the noise figures
+void TableConstDataIterator::fillNativeNoise(casacore::Cube<casacore::Complex> &noise) const
+{
+  checkNoConversion("Noise in the native order");
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_NOISE);
+  if (itsNativeLayout && itsPrefetcher && itsPrefetcher->getNoise(noise)) {
+      fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+      return;
+  }
+  waitForBackgroundJobs();
+  if (table().actualTableDesc().isColumn("SIGMA_SPECTRUM")) {
+      const ROArrayColumn<Float> &sigmaCol = arrayColumn<Float>("SIGMA_SPECTRUM");
+      if (uniformCellShape(sigmaCol)) {
+          const casacore::uInt nChan = nChannel();
+          const Slicer chanSlicer = cellSlicer();
+          const Slicer rowSlicer(IPosition(1, itsCurrentTopRow), IPosition(1, itsNumberOfRows));
+          casacore::Cube<casacore::Float> buf;
+          itsFloatScratch.reshape(buf, itsNumberOfPols, nChan, itsNumberOfRows);
+          sigmaCol.getColumnRange(rowSlicer, chanSlicer, buf, False);
+          countRead("SIGMA_SPECTRUM", buf.nelements() * sizeof(casacore::Float));
+          itsNativeNoiseBuffer.reshape(noise, itsNumberOfPols, nChan, itsNumberOfRows);
+          casacore::Cube<casacore::Float>::const_iterator ci = buf.begin();
+          for (casacore::Cube<casacore::Complex>::iterator it = noise.begin(); it != noise.end(); ++it,++ci) {
+               // same noise for both real and imaginary parts
+               *it = casacore::Complex(*ci,*ci);
+          }
+          if (itsNativeLayout) {
+              fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+          }
+          return;
+      }
+  }
+  casacore::Cube<casacore::Complex> buf;
+  readNoise(buf, itsComplexScratch);
+  itsNativeNoiseBuffer.reshape(noise, buf.nplane(), buf.ncolumn(), buf.nrow());
+  CubeTransposer::transpose(buf, noise);
+  if (itsNativeLayout) {
+      fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+  }
 }
 
 /// @brief read flagging information
@@ -481,7 +1515,180 @@ void TableConstDataIterator::fillVisibility(casacore::Cube<casacore::Complex> &v
 ///            bool type)
 void TableConstDataIterator::fillFlag(casacore::Cube<casacore::Bool> &flag) const
 {
-  fillCube(flag,"FLAG");
+  if (itsPolConversion.nelements()) {
+      // all stored products are read and then converted to the requested ones
+      casacore::Cube<casacore::Bool> stored;
+      if (channelAveraging() > 1) {
+          fillAveragedCubes();
+          stored.reference(itsAveragedFlag);
+      } else {
+          fillCube(stored, "FLAG", itsStoredBoolBuffer, itsBoolScratch);
+      }
+      itsFlagBuffer.reshape(flag, itsNumberOfRows, stored.ncolumn(), nPol());
+      PolConvertingAccessor::convertFlag(stored, itsPolConversion, flag);
+      fieldObtained(ITableDataSelectorImpl::FLAG_FIELD);
+  } else if (channelAveraging() > 1) {
+      fillAveragedCubes();
+      flag.reference(itsAveragedFlag);
+      fieldObtained(ITableDataSelectorImpl::FLAG_FIELD);
+  } else if (itsNativeLayout) {
+      const casacore::Cube<casacore::Bool> &nativeFlag = itsAccessor.nativeFlag();
+      itsFlagBuffer.reshape(flag, nativeFlag.nplane(), nativeFlag.ncolumn(), nativeFlag.nrow());
+      CubeTransposer::transpose(nativeFlag, flag);
+  } else {
+      if (!itsPrefetcher || !itsPrefetcher->getFlag(flag)) {
+          fillCube(flag, "FLAG", itsFlagBuffer, itsBoolScratch);
+      }
+      fieldObtained(ITableDataSelectorImpl::FLAG_FIELD);
+  }
+  flagsObtainedForQC();
+}
+
+/// @brief populate the buffer of bit-packed flags
+/// @details Rows flagged via FLAG_ROW are not read from the FLAG column.
+/// @param[in] flag a reference to the packed flag buffer to fill
+void TableConstDataIterator::fillPackedFlag(PackedFlagCube &flag) const
+{
+  checkNoConversion("Packed flags");
+  flagsObtainedForQC();
+  if (itsNativeLayout) {
+      // the native cube is the primary buffer, pack it
+      flag.packNative(itsAccessor.nativeFlag());
+      return;
+  }
+  waitForBackgroundJobs();
+  const casacore::uInt nChan = nChannel();
+  flag.resize(itsNumberOfRows, nChan, itsNumberOfPols);
+  WholeRowFlagger<casacore::Bool> wrFlagger(itsCurrentIteration);
+  // the list of rows is kept between chunks
+  std::vector<uInt> &rowsToRead = itsRowsToRead;
+  rowsToRead.clear();
+  rowsToRead.reserve(itsNumberOfRows);
+  for (uInt row=0; row<itsNumberOfRows; ++row) {
+       if (wrFlagger.rowFlagged(row + itsCurrentTopRow)) {
+           flag.flagRow(row);
+       } else {
+           rowsToRead.push_back(row);
+       }
+  }
+  if (rowsToRead.size() == 0) {
+      return;
+  }
+  const ROArrayColumn<casacore::Bool> &flagCol = arrayColumn<casacore::Bool>("FLAG");
+  countRead("FLAG", rowsToRead.size() * nChan * itsNumberOfPols * sizeof(casacore::Bool));
+  const Slicer chanSlicer = cellSlicer();
+  if ((rowsToRead.size() == itsNumberOfRows) && uniformCellShape(flagCol)) {
+      // nothing is flagged via FLAG_ROW, read the whole chunk in one go
+      const Slicer rowSlicer(IPosition(1, itsCurrentTopRow), IPosition(1, itsNumberOfRows));
+      casacore::Cube<casacore::Bool> buf;
+      itsBoolScratch.reshape(buf, itsNumberOfPols, nChan, itsNumberOfRows);
+      flagCol.getColumnRange(rowSlicer, chanSlicer, buf, False);
+      flag.packNative(buf);
+      return;
+  }
+  casacore::Matrix<casacore::Bool> buf;
+  itsBoolScratch.reshape(buf, itsNumberOfPols, nChan);
+  for (std::vector<uInt>::const_iterator ci = rowsToRead.begin(); ci != rowsToRead.end(); ++ci) {
+       checkCellShape(flagCol, *ci, "FLAG");
+       flagCol.getSlice(*ci + itsCurrentTopRow, chanSlicer, buf, False);
+       flag.packRow(*ci, buf.data());
+  }
+}
+
+/// @brief populate the buffer of reduced precision visibilities
+/// @details Without conversions the cube is packed from the visibilities in the storage
+/// order, so the accessor-order cube is not formed.
+/// @param[in] vis a reference to the compact visibility buffer to fill
+void TableConstDataIterator::fillCompactVisibility(CompactVisibilityCube &vis) const
+{
+  if (vis.format() != itsCompactVisibilityFormat) {
+      vis.setFormat(itsCompactVisibilityFormat);
+  }
+  if (itsPolConversion.nelements() || (channelAveraging() > 1) || (!itsNativeLayout && itsPrefetcher)) {
+      // conversions are done (and prefetched chunks are kept) in the accessor order, 
+      // pack the result
+      vis.pack(itsAccessor.visibility());
+  } else if (itsNativeLayout) {
+      // the native cube is the primary buffer, pack it
+      vis.packNative(itsAccessor.nativeVisibility());
+  } else {
+      // read in the storage order into the scratch buffer, no transpose is required
+      casacore::Cube<casacore::Complex> nativeVis;
+      fillNativeCube(nativeVis, getDataColumnName(), itsComplexScratch);
+      vis.packNative(nativeVis);
+  }
+}
+
+/// @brief storage for the visibilities of an additional data column
+/// @details The buffer is created on the first request with the current allocator.
+/// @param[in] column name of the data column
+/// @return a reference to the buffer
+ReusableBuffer<casacore::Complex>& TableConstDataIterator::columnVisBuffer(const std::string &column) const
+{
+  std::map<std::string, ReusableBuffer<casacore::Complex> >::iterator it = itsColumnVisBuffers.find(column);
+  if (it == itsColumnVisBuffers.end()) {
+      it = itsColumnVisBuffers.insert(std::make_pair(column, ReusableBuffer<casacore::Complex>())).first;
+      it->second.setAllocator(itsBufferAllocator);
+  }
+  return it->second;
+}
+
+/// @brief populate the buffers of visibilities of the additional data columns
+/// @details All columns chosen via ITableDataSelectorImpl::chooseExtraDataColumns
+/// are read in one go for the rows and channels of the current chunk. Averaging of 
+/// channels at read time is not supported for these columns.
+/// @param[in] cubes a reference to the map of nRow x nChannel x nPol cubes
+///            to fill, the key is the column name
+void TableConstDataIterator::fillColumnVisibility(TableConstDataAccessor::ColumnVisibilities &cubes) const
+{
+  const std::vector<std::string> &columns = itsSelector->getExtraDataColumnNames();
+  if ((channelAveraging() > 1) && (columns.size() > 0)) {
+      ASKAPTHROW(DataAccessLogicError, "Additional data columns are not available if channels "
+                 "are averaged at read time");
+  }
+  for (TableConstDataAccessor::ColumnVisibilities::iterator it = cubes.begin(); it != cubes.end();) {
+       // drop cubes of the columns which are no longer chosen
+       if (std::find(columns.begin(), columns.end(), it->first) == columns.end()) {
+           cubes.erase(it++);
+       } else {
+           ++it;
+       }
+  }
+  for (std::vector<std::string>::const_iterator ci = columns.begin(); ci != columns.end(); ++ci) {
+       if (itsPolConversion.nelements()) {
+           casacore::Cube<casacore::Complex> stored;
+           fillCube(stored, *ci, itsStoredComplexBuffer, itsComplexScratch);
+           columnVisBuffer(*ci).reshape(cubes[*ci], itsNumberOfRows, stored.ncolumn(), nPol());
+           PolConvertingAccessor::convertVisibility(stored, itsPolConversion, cubes[*ci]);
+       } else {
+           fillCube(cubes[*ci], *ci, columnVisBuffer(*ci), itsComplexScratch);
+       }
+  }
+}
+
+/// @brief populate the map of rows which are not flagged as a whole
+/// @details All rows are listed if the table has no FLAG_ROW column
+/// @param[in] rows a reference to the vector to fill with accessor rows containing data
+void TableConstDataIterator::fillUnflaggedRows(casacore::Vector<casacore::uInt> &rows) const
+{
+  waitForBackgroundJobs();
+  if (!itsCurrentIteration.tableDesc().isColumn("FLAG_ROW")) {
+      rows.resize(itsNumberOfRows);
+      indgen(rows);
+      return;
+  }
+  const ROScalarColumn<casacore::Bool> &flagRowCol = scalarColumn<casacore::Bool>("FLAG_ROW");
+  const Slicer rowSlicer(IPosition(1, itsCurrentTopRow), IPosition(1, itsNumberOfRows));
+  const casacore::Vector<casacore::Bool> flagRow = flagRowCol.getColumnRange(rowSlicer);
+  ASKAPDEBUGASSERT(flagRow.nelements() == itsNumberOfRows);
+  rows.resize(itsNumberOfRows - ntrue(flagRow));
+  casacore::uInt index = 0;
+  for (casacore::uInt row = 0; row < itsNumberOfRows; ++row) {
+       if (!flagRow[row]) {
+           rows[index++] = row;
+       }
+  }
+  ASKAPDEBUGASSERT(index == rows.nelements());
 }
 
 /// populate the buffer of noise figures with the values of current
@@ -489,61 +1696,154 @@ void TableConstDataIterator::fillFlag(casacore::Cube<casacore::Bool> &flag) cons
 /// @param[in] noise a reference to the nRow x nChannel x nPol buffer
 ///            cube to be filled with the noise figures
 void TableConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise) const
+{
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_NOISE);
+  if (itsPolConversion.nelements()) {
+      // all stored products are read and then converted to the requested ones
+      casacore::Cube<casacore::Complex> stored;
+      readNoise(stored, itsStoredComplexBuffer);
+      itsNoiseBuffer.reshape(noise, itsNumberOfRows, stored.ncolumn(), nPol());
+      PolConvertingAccessor::convertNoise(stored, itsPolConversion, noise);
+      fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+  } else if (channelAveraging() > 1) {
+      readNoise(noise, itsNoiseBuffer);
+      fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+  } else if (itsNativeLayout) {
+      const casacore::Cube<casacore::Complex> &nativeNoise = itsAccessor.nativeNoise();
+      itsNoiseBuffer.reshape(noise, nativeNoise.nplane(), nativeNoise.ncolumn(), nativeNoise.nrow());
+      CubeTransposer::transpose(nativeNoise, noise);
+  } else {
+      if (!itsPrefetcher || !itsPrefetcher->getNoise(noise)) {
+          readNoise(noise, itsNoiseBuffer);
+      }
+      fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+  }
+}
+
+/// @brief populate the buffer of weights
+/// @details Weights are zero for flagged elements, otherwise they are taken from
+/// WEIGHT_SPECTRUM, if present, or derived from the noise figures as 1/sigma^2
+/// (see IWeightDataAccessor). Where possible, SIGMA_SPECTRUM or WEIGHT_SPECTRUM is read 
+/// straight into the weight buffer and converted in place, so the complex noise cube is 
+/// not formed. 
+/// @param[in] weight a reference to the nRow x nChannel x nPol buffer
+///            cube to be filled with the weights
+void TableConstDataIterator::fillWeight(casacore::Cube<casacore::Float> &weight) const
+{
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_NOISE);
+  // flags include rows flagged as a whole
+  const casacore::Cube<casacore::Bool> &flag = itsAccessor.flag();
+  if ((itsPolConversion.nelements() == 0) && (channelAveraging() == 1)) {
+      const casacore::TableDesc &tableDesc = table().actualTableDesc();
+      if (tableDesc.isColumn("WEIGHT_SPECTRUM")) {
+          fillCube(weight, "WEIGHT_SPECTRUM", itsWeightBuffer, itsFloatScratch);
+          WeightCalculator::applyFlags(flag, weight);
+          fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+          return;
+      }
+      if (tableDesc.isColumn("SIGMA_SPECTRUM")) {
+          fillCube(weight, "SIGMA_SPECTRUM", itsWeightBuffer, itsFloatScratch);
+          WeightCalculator::fromSigma(flag, weight);
+          fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+          return;
+      }
+      if (itsAccessor.noiseRepresentation() != ICompactNoiseDataAccessor::SPECTRAL_NOISE) {
+          // noise doesn't depend on the channel, broadcast it while computing weights
+          itsWeightBuffer.reshape(weight, flag.nrow(), flag.ncolumn(), flag.nplane());
+          WeightCalculator::fromRowPolNoise(flag, itsAccessor.rowPolNoise(), weight);
+          fieldObtained(ITableDataSelectorImpl::NOISE_FIELD);
+          return;
+      }
+  }
+  // general case (polarisation conversion, channel averaging or noise per channel in SIGMA)
+  const casacore::Cube<casacore::Complex> &noise = itsAccessor.noise();
+  itsWeightBuffer.reshape(weight, noise.nrow(), noise.ncolumn(), noise.nplane());
+  WeightCalculator::fromNoise(flag, noise, weight);
+}
+
+/// @brief read noise figures from the table
+/// @details This is the actual reader of noise figures in the accessor order used
+/// by both fillNoise and fillNativeNoise
+/// @param[in] noise a reference to the nRow x nChannel x nPol buffer
+///            cube to be filled with the noise figures
+/// @param[in] buffer storage reused for the noise cube between chunks
+void TableConstDataIterator::readNoise(casacore::Cube<casacore::Complex> &noise,
+               ReusableBuffer<casacore::Complex> &buffer) const
 {
   ASKAPDEBUGASSERT(itsSelector);
+  if (channelAveraging() > 1) {
+      // noise of the averaged channels is obtained together with visibilities and flags
+      fillAveragedCubes();
+      noise.reference(itsAveragedNoise);
+      return;
+  }
+  waitForBackgroundJobs();
   const casacore::uInt nChan = nChannel();
   const casacore::uInt startChan = startChannel();
 
-  // default action first - just resize the cube and assign 1.
-  noise.resize(itsNumberOfRows, nChan, itsNumberOfPols);
-  noise.set(casacore::Complex(1.,1.));
+  buffer.reshape(noise, itsNumberOfRows, nChan, itsNumberOfPols);
   // if the sigma spectrum exists, use those sigmas to fill the noise cube
   if (table().actualTableDesc().isColumn("SIGMA_SPECTRUM")) {
       // noise is given per channel and polarisation
-      // Setup a slicer to extract the specified channel range only
-      const Slicer chanSlicer(Slice(),Slice(startChan,nChan));
-      casa::Matrix<Float> buf(itsNumberOfPols,nChan);
-      ROArrayColumn<Float> sigmaCol(itsCurrentIteration,"SIGMA_SPECTRUM");
-      for (uInt row = 0; row<itsNumberOfRows; ++row) {
-#ifdef ASKAP_DEBUG
-           const casa::IPosition shape = sigmaCol.shape(row);
-           ASKAPDEBUGASSERT(shape.size()==2);
-           ASKAPDEBUGASSERT((shape[0] == casa::Int(itsNumberOfPols)) &&
-                            (shape[1] == casa::Int(itsNumberOfChannels)));
-#endif
-           sigmaCol.getSlice(row+itsCurrentTopRow,chanSlicer,buf,False);
-
-           // SIGMA_SPECTRUM is ordered (pol,chan), so need to transpose
-           for (casa::uInt chan=0; chan<nChan; chan++) {
-                for (casa::uInt pol=0; pol<itsNumberOfPols; pol++) {
-                     // same noise for both real and imaginary parts
-                     const casa::Float val = buf(pol,chan);
-                     noise(row,chan,pol) = casa::Complex(val,val);
-                }
-           }
-      } // loop over rows
+      // Setup a slicer to extract the specified channels and polarisations only
+      const Slicer chanSlicer = cellSlicer();
+      casacore::Cube<Float> buf;
+      itsFloatScratch.reshape(buf, itsNumberOfPols, nChan, itsNumberOfRows);
+      const ROArrayColumn<Float> &sigmaCol = arrayColumn<Float>("SIGMA_SPECTRUM");
+      countRead("SIGMA_SPECTRUM", buf.nelements() * sizeof(casacore::Float));
+      if (uniformCellShape(sigmaCol)) {
+          const Slicer rowSlicer(IPosition(1, itsCurrentTopRow), IPosition(1, itsNumberOfRows));
+          sigmaCol.getColumnRange(rowSlicer, chanSlicer, buf, False);
+      } else {
+          for (uInt row = 0; row<itsNumberOfRows; ++row) {
+               checkCellShape(sigmaCol, row, "SIGMA_SPECTRUM");
+               // xy-plane of the contiguous cube references its storage
+               casacore::Matrix<Float> rowBuf = buf.xyPlane(row);
+               sigmaCol.getSlice(row+itsCurrentTopRow,chanSlicer,rowBuf,False);
+          }
+      }
+      // SIGMA_SPECTRUM is ordered (pol,chan), so need to transpose
+      // same noise is used for both real and imaginary parts
+      CubeTransposer::transpose(buf, noise);
   } // if-statement checking that SIGMA_SPECTRUM column is present
+  else if (itsAccessor.noiseRepresentation() == ICompactNoiseDataAccessor::ROW_POL_NOISE) {
+      // noise is given per polarisation for all rows of the chunk,
+      // broadcast the values for all spectral channels
+      const casacore::Matrix<casacore::Complex> &rowPolNoise = itsAccessor.rowPolNoise();
+      ASKAPDEBUGASSERT(rowPolNoise.nrow() == itsNumberOfRows);
+      ASKAPDEBUGASSERT(rowPolNoise.ncolumn() == itsNumberOfPols);
+      for (uInt pol = 0; pol < itsNumberOfPols; ++pol) {
+           casacore::Matrix<casacore::Complex> polPlane = noise.xyPlane(pol);
+           const casacore::Vector<casacore::Complex> polNoise = rowPolNoise.column(pol);
+           for (uInt chan = 0; chan < nChan; ++chan) {
+                polPlane.column(chan) = polNoise;
+           }
+      }
+  }
   else if (table().actualTableDesc().isColumn("SIGMA")) {
-      ROArrayColumn<Float> sigmaCol(itsCurrentIteration,"SIGMA");
-      casacore::Vector<Float> buf(itsNumberOfPols);
+      // SIGMA is given per channel for at least some rows, process row by row
+      const ROArrayColumn<Float> &sigmaCol = arrayColumn<Float>("SIGMA");
+      casacore::Vector<Float> buf;
+      itsFloatScratch.reshape(buf, itsNumberOfStoredPols);
       for (uInt row = 0; row<itsNumberOfRows; ++row) {
-           const casacore::IPosition shape = sigmaCol.shape(row);
+           const casacore::IPosition shape = sigmaCol.shape(row + itsCurrentTopRow);
            ASKAPDEBUGASSERT((shape.size()<=2) && (shape.size()!=0));
            if (shape.size() == 1) {
                // noise is given per polarisation, same for all spectral channels
                // IS SIGMA EVER NOT GOING TO BE THIS SIZE? (SEE SIGMA_SPECTRUM)
-               ASKAPDEBUGASSERT(shape[0] == casacore::Int(itsNumberOfPols));
+               ASKAPDEBUGASSERT(shape[0] == casacore::Int(itsNumberOfStoredPols));
                //casacore::Array<Float> buf(casacore::IPosition(1,itsNumberOfPols));
                sigmaCol.get(row+itsCurrentTopRow,buf,False);
-               //casacore::Matrix<casacore::Complex> slice = noise.yzPlane(row);
-               for (uInt chan = 0; chan< nChan; ++chan) {
-                    //ASKAPDEBUGASSERT(chan< slice.nrow());
-                    //casacore::Vector<casacore::Complex> polNoise = slice.row(chan);
-                    for (casacore::uInt pol=0; pol<itsNumberOfPols; ++pol) {
-                         //ASKAPDEBUGASSERT(pol<buf.nelements());
-                         // same polarisation for both real and imaginary parts
-                         const casacore::Float val = buf(pol);
-                         noise(row,chan,pol) = casacore::Complex(val,val);
+               // the cube references the reusable buffer, so it is contiguous
+               ASKAPDEBUGASSERT(noise.contiguousStorage());
+               const size_t planeSize = size_t(itsNumberOfRows) * nChan;
+               for (casacore::uInt pol=0; pol<itsNumberOfPols; ++pol) {
+                    // same polarisation for both real and imaginary parts
+                    const casacore::Float val = buf(storedPol(pol));
+                    const casacore::Complex value(val,val);
+                    casacore::Complex *rowNoise = noise.data() + pol * planeSize + row;
+                    for (uInt chan = 0; chan< nChan; ++chan, rowNoise += itsNumberOfRows) {
+                         *rowNoise = value;
                     }
                }
            } else {
@@ -551,30 +1851,238 @@ void TableConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise)
                // IS THIS EVER THE CASE, OR IS SIGMA_SPECTRUM (above) ALWAYS USED?
                // Should always use SIGMA_SPECTRUM for this case (MHW)
                ASKAPASSERT((shape[0] == casacore::Int(itsNumberOfChannels)) &&
-                           (shape[1] == casacore::Int(itsNumberOfPols)));
+                           (shape[1] == casacore::Int(itsNumberOfStoredPols)));
 
-               casacore::Array<Float> buf(casacore::IPosition(2,itsNumberOfChannels,itsNumberOfPols));
+               casacore::Array<Float> buf(casacore::IPosition(2,itsNumberOfChannels,itsNumberOfStoredPols));
                sigmaCol.get(row+itsCurrentTopRow,buf,False);
 
                // not clear whether we need a transpose of the matrix. This
                // case is not present in any available measurement set
                const IPosition blc(2,startChan,0);
-               const IPosition trc(2,startChan+nChan-1,itsNumberOfPols-1);
+               const IPosition trc(2,startChan+nChan-1,itsNumberOfStoredPols-1);
                casacore::Matrix<casacore::Complex> rowNoise = noise.yzPlane(row);
                const casacore::Matrix<casacore::Float> inVals = buf(blc,trc);
                //convertArray(rowNoise, buf(blc,trc));
                for (casacore::uInt x=0; x<rowNoise.nrow(); ++x) {
                     for (casacore::uInt y=0; y<rowNoise.ncolumn(); ++y) {
                          ASKAPDEBUGASSERT(x<inVals.nrow());
-                         ASKAPDEBUGASSERT(y<inVals.ncolumn());
+                         ASKAPDEBUGASSERT(storedPol(y)<inVals.ncolumn());
                          // same polarisation for both real and imaginary parts
-                         const casacore::Float val = inVals(x,y);
+                         const casacore::Float val = inVals(x,storedPol(y));
                          rowNoise(x,y) = casacore::Complex(val,val);
                     }
                }
            }
       } // loop over rows
   } // if-statement checking that SIGMA column is present
+  else {
+      // default action - assign 1.
+      noise.set(constantNoise());
+  }
+}
+
+/// @brief read and average visibilities, flags and noise of the current chunk
+/// @details If channels are averaged at read time, the three cubes are produced 
+/// together in one pass over the chunk. Blocks of rows are read in the native order
+/// and averaged straight away (see ChannelAverager), so the cubes at the full spectral
+/// resolution are never held for the whole chunk. The result is kept until the 
+/// iterator moves to the next chunk.
+void TableConstDataIterator::fillAveragedCubes() const
+{
+  if (itsAveragedChunkValid) {
+      return;
+  }
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_CUBE);
+  const AccessTracer::Scope trace("fillAveragedCubes", getDataColumnName(), "dataaccess");
+  waitForBackgroundJobs();
+  const casacore::uInt nAvg = channelAveraging();
+  const casacore::uInt nChan = nChannel();
+  // the averaged cubes take the place of the cubes at the full resolution, so their
+  // storage is reused (the accessor may still reference cubes of the previous chunk)
+  itsVisBuffer.reshape(itsAveragedVis, itsNumberOfRows, nChan, itsNumberOfPols);
+  itsFlagBuffer.reshape(itsAveragedFlag, itsNumberOfRows, nChan, itsNumberOfPols);
+  itsNoiseBuffer.reshape(itsAveragedNoise, itsNumberOfRows, nChan, itsNumberOfPols);
+
+  const ROArrayColumn<casacore::Complex> &visCol = arrayColumn<casacore::Complex>(getDataColumnName());
+  const ROArrayColumn<casacore::Bool> &flagCol = arrayColumn<casacore::Bool>("FLAG");
+  WholeRowFlagger<casacore::Bool> wrFlagger(itsCurrentIteration);
+  const bool uniform = uniformCellShape(visCol) && uniformCellShape(flagCol);
+  const Slicer chanSlicer = cellSlicer();
+  casacore::Cube<casacore::Complex> visBuf;
+  casacore::Cube<casacore::Bool> flagBuf;
+  casacore::Cube<casacore::Float> sigmaBuf;
+  for (casacore::uInt first = 0; first < itsNumberOfRows; first += theirAveragingBlockSize) {
+       const casacore::uInt count = itsNumberOfRows - first < theirAveragingBlockSize ?
+                                    itsNumberOfRows - first : theirAveragingBlockSize;
+       itsComplexScratch.reshape(visBuf, itsNumberOfPols, nChan * nAvg, count);
+       itsBoolScratch.reshape(flagBuf, itsNumberOfPols, nChan * nAvg, count);
+       itsFloatScratch.reshape(sigmaBuf, itsNumberOfPols, nChan * nAvg, count);
+       if (uniform) {
+           const Slicer rowSlicer(IPosition(1, first + itsCurrentTopRow), IPosition(1, count));
+           visCol.getColumnRange(rowSlicer, chanSlicer, visBuf, False);
+           flagCol.getColumnRange(rowSlicer, chanSlicer, flagBuf, False);
+       } else {
+           for (casacore::uInt row = 0; row < count; ++row) {
+                checkCellShape(visCol, first + row, getDataColumnName());
+                checkCellShape(flagCol, first + row, "FLAG");
+                // xy-planes of the contiguous cubes reference their storage
+                casacore::Matrix<casacore::Complex> visRow = visBuf.xyPlane(row);
+                visCol.getSlice(first + row + itsCurrentTopRow, chanSlicer, visRow, False);
+                casacore::Matrix<casacore::Bool> flagRow = flagBuf.xyPlane(row);
+                flagCol.getSlice(first + row + itsCurrentTopRow, chanSlicer, flagRow, False);
+           }
+       }
+       for (casacore::uInt row = 0; row < count; ++row) {
+            wrFlagger.flagNativeRow(first + row + itsCurrentTopRow, row, flagBuf);
+       }
+       readSigmaBlock(sigmaBuf, first);
+       ChannelAverager::average(visBuf, flagBuf, sigmaBuf, nAvg, first, itsAveragedVis,
+                                itsAveragedFlag, itsAveragedNoise);
+  }
+  const size_t nRead = size_t(itsNumberOfRows) * nChan * nAvg * itsNumberOfPols;
+  countRead(getDataColumnName(), nRead * sizeof(casacore::Complex));
+  countRead("FLAG", nRead * sizeof(casacore::Bool));
+  itsAveragedChunkValid = true;
+}
+
+/// @brief read noise figures for a block of rows in the native order
+/// @details This is a helper for fillAveragedCubes. Noise is taken from SIGMA_SPECTRUM,
+/// from SIGMA (the same for all channels) or set to 1 if neither column exists.
+/// @param[in] sigma nPol x nChannel x nRow cube to fill (shape defines the block size)
+/// @param[in] firstRow first row of the block w.r.t. the current chunk
+void TableConstDataIterator::readSigmaBlock(casacore::Cube<casacore::Float> &sigma, 
+                 casacore::uInt firstRow) const
+{
+  const casacore::uInt count = sigma.nplane();
+  const casacore::TableDesc &tableDesc = table().actualTableDesc();
+  if (tableDesc.isColumn("SIGMA_SPECTRUM")) {
+      const ROArrayColumn<Float> &sigmaCol = arrayColumn<Float>("SIGMA_SPECTRUM");
+      const Slicer chanSlicer = cellSlicer();
+      countRead("SIGMA_SPECTRUM", sigma.nelements() * sizeof(casacore::Float));
+      if (uniformCellShape(sigmaCol)) {
+          const Slicer rowSlicer(IPosition(1, firstRow + itsCurrentTopRow), IPosition(1, count));
+          sigmaCol.getColumnRange(rowSlicer, chanSlicer, sigma, False);
+      } else {
+          for (uInt row = 0; row < count; ++row) {
+               checkCellShape(sigmaCol, firstRow + row, "SIGMA_SPECTRUM");
+               casacore::Matrix<Float> rowBuf = sigma.xyPlane(row);
+               sigmaCol.getSlice(firstRow + row + itsCurrentTopRow, chanSlicer, rowBuf, False);
+          }
+      }
+  } else if (tableDesc.isColumn("SIGMA")) {
+      const ROArrayColumn<Float> &sigmaCol = arrayColumn<Float>("SIGMA");
+      const casacore::uInt startChan = startChannel();
+      for (uInt row = 0; row < count; ++row) {
+           const casacore::Array<Float> cell = sigmaCol(firstRow + row + itsCurrentTopRow);
+           casacore::Matrix<Float> rowSigma = sigma.xyPlane(row);
+           if (cell.ndim() == 1) {
+               // noise is given per polarisation, same for all spectral channels
+               ASKAPDEBUGASSERT(cell.nelements() == itsNumberOfStoredPols);
+               const casacore::Vector<Float> perPol(cell);
+               for (uInt chan = 0; chan < rowSigma.ncolumn(); ++chan) {
+                    for (uInt pol = 0; pol < rowSigma.nrow(); ++pol) {
+                         rowSigma(pol, chan) = perPol[storedPol(pol)];
+                    }
+               }
+           } else {
+               // noise is given per channel and polarisation (see readNoise)
+               ASKAPASSERT((cell.shape()[0] == casacore::Int(itsNumberOfChannels)) &&
+                           (cell.shape()[1] == casacore::Int(itsNumberOfStoredPols)));
+               const casacore::Matrix<Float> perChan(cell);
+               for (uInt chan = 0; chan < rowSigma.ncolumn(); ++chan) {
+                    for (uInt pol = 0; pol < rowSigma.nrow(); ++pol) {
+                         rowSigma(pol, chan) = perChan(startChan + chan, storedPol(pol));
+                    }
+               }
+           }
+      }
+  } else {
+      // default noise if there is no information in the table (see constantNoise)
+      sigma.set(1.);
+  }
+}
+
+/// @brief determine the type of the noise representation
+/// @details The noise is constant if neither SIGMA_SPECTRUM nor SIGMA columns
+/// are present, it depends on row and polarisation only if SIGMA is given per
+/// polarisation for all rows of the chunk, and is spectral otherwise. Noise of
+/// the channels averaged at read time is always spectral (it depends on flags).
+/// @param[out] repr reference to the buffer to fill
+void TableConstDataIterator::fillNoiseRepresentation(ICompactNoiseDataAccessor::NoiseRepresentation &repr) const
+{
+  const casacore::TableDesc &tableDesc = table().actualTableDesc();
+  if (tableDesc.isColumn("SIGMA_SPECTRUM") || (channelAveraging() > 1)) {
+      repr = ICompactNoiseDataAccessor::SPECTRAL_NOISE;
+  } else if (tableDesc.isColumn("SIGMA") && itsPolConversion.nelements()) {
+      // converted noise is only available as a spectral cube
+      repr = ICompactNoiseDataAccessor::SPECTRAL_NOISE;
+  } else if (tableDesc.isColumn("SIGMA")) {
+      waitForBackgroundJobs();
+      const ROArrayColumn<Float> &sigmaCol = arrayColumn<Float>("SIGMA");
+      const casacore::IPosition perPolShape(1, itsNumberOfStoredPols);
+      repr = ICompactNoiseDataAccessor::ROW_POL_NOISE;
+      const casacore::ColumnDesc &sigmaDesc = sigmaCol.columnDesc();
+      if (sigmaDesc.isFixedShape()) {
+          if (!sigmaDesc.shape().isEqual(perPolShape)) {
+              repr = ICompactNoiseDataAccessor::SPECTRAL_NOISE;
+          }
+      } else {
+          for (uInt row = 0; row<itsNumberOfRows; ++row) {
+               if (!sigmaCol.shape(row + itsCurrentTopRow).isEqual(perPolShape)) {
+                   repr = ICompactNoiseDataAccessor::SPECTRAL_NOISE;
+                   break;
+               }
+          }
+      }
+  } else {
+      repr = ICompactNoiseDataAccessor::CONSTANT_NOISE;
+  }
+}
+
+/// @brief populate the buffer of noise figures per row and polarisation
+/// @details This method is only valid if the noise doesn't depend on the spectral
+/// channel (see fillNoiseRepresentation). An exception is thrown otherwise.
+/// @param[in] noise a reference to the nRow x nPol buffer to be filled
+void TableConstDataIterator::fillRowPolNoise(casacore::Matrix<casacore::Complex> &noise) const
+{
+  const ICompactNoiseDataAccessor::NoiseRepresentation repr = itsAccessor.noiseRepresentation();
+  if (repr == ICompactNoiseDataAccessor::SPECTRAL_NOISE) {
+      ASKAPTHROW(DataAccessLogicError, "Noise depends on the spectral channel for the current chunk, "
+                 "the noise figures per row and polarisation are not available");
+  }
+  if (repr == ICompactNoiseDataAccessor::CONSTANT_NOISE) {
+      noise.resize(itsNumberOfRows, nPol());
+      noise.set(constantNoise());
+      return;
+  }
+  noise.resize(itsNumberOfRows, itsNumberOfPols);
+  waitForBackgroundJobs();
+  // read all rows at once, cells are known to have nPol elements
+  const ROArrayColumn<Float> &sigmaCol = arrayColumn<Float>("SIGMA");
+  const Slicer rowSlicer(IPosition(1, itsCurrentTopRow), IPosition(1, itsNumberOfRows));
+  casacore::Matrix<Float> buf;
+  itsFloatScratch.reshape(buf, itsNumberOfStoredPols, itsNumberOfRows);
+  sigmaCol.getColumnRange(rowSlicer, buf, False);
+  countRead("SIGMA", buf.nelements() * sizeof(casacore::Float));
+  for (uInt row = 0; row < itsNumberOfRows; ++row) {
+       for (uInt pol = 0; pol < itsNumberOfPols; ++pol) {
+            // same noise for both real and imaginary parts
+            const casacore::Float val = buf(storedPol(pol),row);
+            noise(row,pol) = casacore::Complex(val,val);
+       }
+  }
+}
+
+/// @brief noise value for the constant noise case
+/// @details An exception is thrown if the noise is not constant for the current chunk
+/// @return complex noise estimate used for all elements
+casacore::Complex TableConstDataIterator::constantNoise() const
+{
+  if (itsAccessor.noiseRepresentation() != ICompactNoiseDataAccessor::CONSTANT_NOISE) {
+      ASKAPTHROW(DataAccessLogicError, "Noise is not constant for the current chunk");
+  }
+  // default noise if there is no information in the table
+  return casacore::Complex(1.,1.);
 }
 
 /// populate the buffer with uvw
@@ -582,14 +2090,40 @@ void TableConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise)
 ///            u,v and w for each row) to fill
 void TableConstDataIterator::fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&uvw) const
 {
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_UVW);
+  if (itsPrefetcher && itsPrefetcher->getUVW(uvw)) {
+      fieldObtained(ITableDataSelectorImpl::UVW_FIELD);
+      return;
+  }
+  waitForBackgroundJobs();
   uvw.resize(itsNumberOfRows);
-
-  ROArrayColumn<Double> uvwCol(itsCurrentIteration,"UVW");
+  countRead("UVW", 3 * itsNumberOfRows * sizeof(casacore::Double));
+
+  const ROArrayColumn<Double> &uvwCol = arrayColumn<Double>("UVW");
+  const casacore::ColumnDesc &uvwDesc = uvwCol.columnDesc();
+  if (uvwDesc.isFixedShape() && uvwDesc.shape().isEqual(casacore::IPosition(1,3))) {
+      // standard case, read the whole chunk as a 3 x nRow matrix and unpack it in one pass
+      const Slicer rowSlicer(IPosition(1, itsCurrentTopRow), IPosition(1, itsNumberOfRows));
+      casacore::Matrix<Double> buf;
+      itsDoubleScratch.reshape(buf, 3, itsNumberOfRows);
+      uvwCol.getColumnRange(rowSlicer, buf, False);
+      const Double *bufPtr = buf.data();
+      for (uInt row=0; row<itsNumberOfRows; ++row, bufPtr += 3) {
+           casacore::RigidVector<casacore::Double, 3> &rowUVW = uvw(row);
+           rowUVW(0) = bufPtr[0];
+           rowUVW(1) = bufPtr[1];
+           rowUVW(2) = bufPtr[2];
+      }
+      fieldObtained(ITableDataSelectorImpl::UVW_FIELD);
+      return;
+  }
+  // per-row fallback for variable shape columns
   // temporary buffer
-  Vector<Double> buf(3);
+  Vector<Double> buf;
+  itsDoubleScratch.reshape(buf, 3);
   for (uInt row=0;row<itsNumberOfRows;++row) {
 #ifdef ASKAP_DEBUG
-       const casacore::IPosition shape=uvwCol.shape(row);
+       const casacore::IPosition shape=uvwCol.shape(row+itsCurrentTopRow);
        ASKAPDEBUGASSERT(shape.size()==1);
        ASKAPDEBUGASSERT(shape[0]==3);
 #endif // ASKAP_DEBUG
@@ -597,6 +2131,26 @@ void TableConstDataIterator::fillUVW(casacore::Vector<casacore::RigidVector<casa
        uvwCol.get(row+itsCurrentTopRow,buf,False);
        uvw(row) = buf;
   }
+  fieldObtained(ITableDataSelectorImpl::UVW_FIELD);
+}
+
+/// @brief populate the key of the current chunk for the store of rotated uvws
+/// @details The chunk is identified by the time and the row numbers in the 
+/// measurement set, so the key doesn't depend on the selection or chunk size used.
+/// @param[in] key a reference to the key to fill
+void TableConstDataIterator::fillChunkKey(RotatedUVWStore::ChunkKey &key) const
+{
+  waitForBackgroundJobs();
+  // row numbers of the selected table in the measurement set, obtained once per pass
+  if (itsRowNumbers.nelements() != itsSelectedTable.nrow()) {
+      itsRowNumbers.reference(itsSelectedTable.rowNumbers());
+  }
+  ASKAPDEBUGASSERT(itsRowNumbers.nelements() >= itsCurrentTopRow + itsNumberOfRows);
+  std::vector<casacore::uInt> rows(itsNumberOfRows);
+  for (uInt row = 0; row < itsNumberOfRows; ++row) {
+       rows[row] = itsRowNumbers[row + itsCurrentTopRow];
+  }
+  key = RotatedUVWStore::ChunkKey(getTime(), rows);
 }
 
 /// @brief obtain a current spectral window ID
@@ -658,6 +2212,51 @@ const casacore::MDirection& TableConstDataIterator::getCurrentReferenceDir() con
 /// @return a pair, first element is the number of channels, second is the first channel
 /// in the full cube
 std::pair<casacore::uInt, casacore::uInt> TableConstDataIterator::getChannelRange() const
+{
+  std::pair<casacore::uInt, casacore::uInt> range = getSelectedChannelRange();
+  if ((itsMaxChannels > 0) && (range.first > itsMaxChannels)) {
+      const casacore::uInt offset = itsCurrentChannelTile * itsMaxChannels;
+      ASKAPDEBUGASSERT(offset < range.first);
+      // the start channel refers to the channels stored in the table
+      range.second += offset * channelAveraging();
+      range.first = std::min(itsMaxChannels, range.first - offset);
+  }
+  return range;
+}
+
+/// @brief number of channel tiles for the current rows
+/// @details The number is computed when the chunk is set up (see countChannelTiles),
+/// so this method is cheap and doesn't throw.
+/// @return number of accessors the selected channels are split into (1 if no
+/// restriction on the number of channels is set, 0 if there are no data)
+casacore::uInt TableConstDataIterator::nChannelTiles() const throw()
+{
+  return itsNChannelTiles;
+}
+
+/// @brief compute the number of channel tiles for the current rows
+/// @details This method is called when a new chunk of rows is set up, the result
+/// is cached and returned by nChannelTiles.
+/// @return number of accessors the selected channels are split into (1 if no
+/// restriction on the number of channels is set, 0 if there are no data)
+casacore::uInt TableConstDataIterator::countChannelTiles() const
+{
+  if (itsNumberOfRows == 0) {
+      return 0;
+  }
+  if (itsMaxChannels == 0) {
+      return 1;
+  }
+  const casacore::uInt nChan = getSelectedChannelRange().first;
+  return nChan > itsMaxChannels ? (nChan + itsMaxChannels - 1) / itsMaxChannels : 1;
+}
+
+/// @brief obtain the whole selected range of channels
+/// @details Unlike getChannelRange, this method ignores the split into channel tiles
+/// (see maxChannels) and returns the full range defined by the selector.
+/// @return a pair, first element is the number of channels, second is the first channel
+/// in the full cube
+std::pair<casacore::uInt, casacore::uInt> TableConstDataIterator::getSelectedChannelRange() const
 {
   ASKAPDEBUGASSERT(itsSelector);
   const std::pair<int, int> chanSelection = itsSelector->getChannelSelection();
@@ -665,7 +2264,7 @@ std::pair<casacore::uInt, casacore::uInt> TableConstDataIterator::getChannelRang
                            casacore::uInt(chanSelection.first) : itsNumberOfChannels;
   const casacore::uInt startChan = itsSelector->channelsSelected() ?
                            casacore::uInt(chanSelection.second) : 0;
-  ASKAPDEBUGASSERT(startChan + nChan <= itsNumberOfChannels);
+  ASKAPDEBUGASSERT(startChan + nChan * channelAveraging() <= itsNumberOfChannels);
   return std::pair<casacore::uInt, casacore::uInt>(nChan, startChan);
 }
 
@@ -677,8 +2276,14 @@ void TableConstDataIterator::fillStokes(casacore::Vector<casacore::Stokes::Stoke
 
   ASKAPDEBUGASSERT(itsCurrentDataDescID>=0);
   const casacore::uInt polID = currentPolID();
-  ASKAPASSERT(polSubtable.nPol(polID) == nPol());
-  stokes = polSubtable.getTypes(polID).copy();
+  ASKAPASSERT(polSubtable.nPol(polID) == itsNumberOfStoredPols);
+  const casacore::Vector<casacore::Stokes::StokesTypes> &requested = itsSelector->getPolarizationSelection();
+  if (requested.nelements() > 0) {
+      ASKAPDEBUGASSERT(requested.nelements() == nPol());
+      stokes = requested.copy();
+  } else {
+      stokes = polSubtable.getTypes(polID).copy();
+  }
 }
 
 /// populate the buffer with frequencies
@@ -698,7 +2303,8 @@ void TableConstDataIterator::fillFrequency(casacore::Vector<casacore::Double> &f
   // we need to take care of constness as taking a slice is not a const
   // operation.
   if (itsConverter->isVoid(spWindowSubtable.getReferenceFrame(spWindowID),
-	                   spWindowSubtable.getFrequencyUnit()) && !itsSelector->channelsSelected()) {
+	                   spWindowSubtable.getFrequencyUnit()) && !itsSelector->channelsSelected() &&
+                           (nChannelTiles() == 1)) {
       // the conversion is void, i.e. table units/frame are exactly what
       // we need for output. This simplifies things a lot.
       freq.reference(spWindowSubtable.getFrequencies(spWindowID));
@@ -721,24 +2327,118 @@ void TableConstDataIterator::fillFrequency(casacore::Vector<casacore::Double> &f
       // currently use the position of the first antenna for convertion.
       // we may need some average position + a check that they are close
       // enough to throw an exception if someone gives a VLBI measurement set.
-      itsConverter->setMeasFrame(casacore::MeasFrame(epoch, subtableInfo().
-                     getAntenna().getPosition(0), antReferenceDir));
+      const casacore::Double time = epoch.getValue().get() * 86400.;
+      if (!itsConvertedFrequencies.matches(spWindowID, startChan, nChan, time, 
+                  antReferenceDir.getValue(), itsFrequencyFrameTolerance)) {
+          itsConverter->setMeasFrame(casacore::MeasFrame(epoch, subtableInfo().
+                         getAntenna().getPosition(0), antReferenceDir));
+          const casacore::Vector<casacore::Double> &tableFreqs = 
+                         spWindowSubtable.getFrequencies(spWindowID);
+          // channels averaged at read time are represented by their mean frequency
+          const casacore::uInt nAvg = channelAveraging();
+          const casacore::uInt nUsed = nChan * nAvg;
+          ASKAPCHECK(startChan + nUsed <= tableFreqs.nelements(), "The measurement set has bad or corrupted "
+                 "SPECTRAL_WINDOW subtable. Channels "<<startChan<<" to "<<startChan + nUsed - 1<<
+                 " are requested, but the frequency axis has only "<<tableFreqs.nelements()<<" channels");
+          // new vector, the old one may be referenced by the accessor
+          casacore::Vector<casacore::Double> converted;
+          itsConverter->frequencies(spWindowSubtable.getReferenceFrame(spWindowID),
+                         spWindowSubtable.getFrequencyUnit(), 
+                         tableFreqs(casacore::Slice(startChan, nUsed)), converted);
+          if (nAvg > 1) {
+              ASKAPDEBUGASSERT(converted.nelements() == nUsed);
+              casacore::Vector<casacore::Double> averaged(nChan, 0.);
+              for (casacore::uInt chan = 0; chan < nUsed; ++chan) {
+                   averaged[chan / nAvg] += converted[chan];
+              }
+              averaged /= casacore::Double(nAvg);
+              converted.reference(averaged);
+          }
+          itsConvertedFrequencies.itsFrequencies.reference(converted);
+          itsConvertedFrequencies.itsSpWindow = casacore::Int(spWindowID);
+          itsConvertedFrequencies.itsStartChan = startChan;
+          itsConvertedFrequencies.itsTime = time;
+          itsConvertedFrequencies.itsDirection = antReferenceDir.getValue();
+      }
+      freq.reference(itsConvertedFrequencies.itsFrequencies);
+  }
+}
 
-      freq.resize(nChan);
-      for (uInt ch=0;ch<nChan;++ch) {
-           freq[ch]=itsConverter->frequency(spWindowSubtable.getFrequency(
-	                                    spWindowID,ch+startChan));
+/// @brief populate the buffer with uvw in single precision
+/// @details The conversion is done from the accessor's uvw, which are read if necessary.
+/// @param[in] uvw a reference to vector of rigid vectors to fill
+void TableConstDataIterator::fillFloatUVW(casacore::Vector<casacore::RigidVector<casacore::Float, 3> > &uvw) const
+{
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &doubleUVW = itsAccessor.uvw();
+  uvw.resize(doubleUVW.nelements());
+  for (casacore::uInt row = 0; row < doubleUVW.nelements(); ++row) {
+       const casacore::RigidVector<casacore::Double, 3> &rowUVW = doubleUVW[row];
+       casacore::RigidVector<casacore::Float, 3> &result = uvw[row];
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            result(dim) = static_cast<casacore::Float>(rowUVW(dim));
+       }
+  }
+}
 
-      }
+/// @brief populate the buffer with frequencies in single precision
+/// @param[in] freq a reference to a vector to fill
+void TableConstDataIterator::fillFloatFrequency(casacore::Vector<casacore::Float> &freq) const
+{
+  const casacore::Vector<casacore::Double> &doubleFreq = itsAccessor.frequency();
+  freq.resize(doubleFreq.nelements());
+  casacore::convertArray(freq, doubleFreq);
+}
+
+/// @brief populate the buffer with inverse wavelengths
+/// @details Frequencies given by the accessor are scaled from the units set in 
+/// the converter to Hz and divided by the speed of light.
+/// @param[in] invLambda a reference to a vector to fill with 1/lambda in 1/metres
+void TableConstDataIterator::fillInverseWavelength(casacore::Vector<casacore::Float> &invLambda) const
+{
+  ASKAPDEBUGASSERT(itsConverter);
+  const casacore::Vector<casacore::Double> &doubleFreq = itsAccessor.frequency();
+  const casacore::Double factor = casacore::Quantity(1., itsConverter->frequencyUnit()).getValue("Hz") / 
+                                  casacore::C::c;
+  invLambda.resize(doubleFreq.nelements());
+  for (casacore::uInt chan = 0; chan < doubleFreq.nelements(); ++chan) {
+       invLambda[chan] = static_cast<casacore::Float>(doubleFreq[chan] * factor);
+  }
+}
+
+/// @brief construct an empty object, which doesn't match anything
+TableConstDataIterator::ConvertedFrequencyAxis::ConvertedFrequencyAxis() : itsSpWindow(-1),
+         itsStartChan(0), itsTime(0.) {}
+
+/// @brief check whether the converted axis can be reused
+/// @param[in] spWindow spectral window ID
+/// @param[in] startChan first channel
+/// @param[in] nChan number of channels
+/// @param[in] time time in seconds
+/// @param[in] dir reference direction used for the conversion
+/// @param[in] tolerance maximum time difference in seconds
+/// @return true, if the axis converted last time can be used 
+bool TableConstDataIterator::ConvertedFrequencyAxis::matches(casacore::uInt spWindow, 
+         casacore::uInt startChan, casacore::uInt nChan, casacore::Double time, 
+         const casacore::MVDirection &dir, casacore::Double tolerance) const
+{
+  if ((itsSpWindow != casacore::Int(spWindow)) || (itsStartChan != startChan) || 
+      (itsFrequencies.nelements() != nChan)) {
+      return false;
+  }
+  if (fabs(time - itsTime) > tolerance) {
+      return false;
   }
+  // the direction is normally exactly the same (taken from the FIELD table)
+  return itsDirection.separation(dir) < 1e-9;
 }
 
 /// @return the time stamp
 casacore::Double TableConstDataIterator::getTime() const
 {
+  waitForBackgroundJobs();
   // add additional checks in debug mode
   #ifdef ASKAP_DEBUG
-   ROScalarColumn<Double> timeCol(itsCurrentIteration,"TIME");
+   const ROScalarColumn<Double> &timeCol = scalarColumn<Double>("TIME");
    Double time=timeCol(itsCurrentTopRow);
     Vector<Double> allTimes=timeCol.getColumnRange(Slicer(IPosition(1,
                        itsCurrentTopRow),IPosition(1,itsNumberOfRows)));
@@ -793,18 +2493,20 @@ void TableConstDataIterator::fillFeed2(casacore::Vector<casacore::uInt> &ids) co
 void TableConstDataIterator::fillVectorOfIDs(casacore::Vector<casacore::uInt> &ids,
                      const casacore::String &name) const
 {
-  ROScalarColumn<Int> col(itsCurrentIteration,name);
+  waitForBackgroundJobs();
+  const ROScalarColumn<Int> &col = scalarColumn<Int>(name);
   ids.resize(itsNumberOfRows);
-  Vector<Int> buf=col.getColumnRange(Slicer(IPosition(1,
-                      itsCurrentTopRow),IPosition(1,itsNumberOfRows)));
-  ASKAPDEBUGASSERT(buf.nelements()==ids.nelements());
+  // read the whole chunk in one go into the buffer of the right size
+  Vector<Int> buf(itsNumberOfRows);
+  col.getColumnRange(Slicer(IPosition(1, itsCurrentTopRow),
+                     IPosition(1,itsNumberOfRows)), buf, False);
   // need a copy because the type is different. There are no
   // appropriate cast operators for casacore::Vectors
-  Vector<Int>::const_iterator ci=buf.begin();
-  Vector<uInt>::iterator it=ids.begin();
-  for (; ci!=buf.end() && it!=ids.end() ; ++ci,++it) {
-       ASKAPDEBUGASSERT(*ci>=0);
-	   *it=static_cast<uInt>(*ci);
+  const Int *inPtr = buf.data();
+  uInt *outPtr = ids.data();
+  for (uInt row = 0; row < itsNumberOfRows; ++row) {
+       ASKAPDEBUGASSERT(inPtr[row]>=0);
+       outPtr[row] = static_cast<uInt>(inPtr[row]);
   }
 }
 
@@ -824,45 +2526,21 @@ casacore::MEpoch TableConstDataIterator::currentEpoch() const
 /// @param[in] angles a reference to a vector to be filled
 void TableConstDataIterator::fillParallacticAngleCache(casacore::Vector<casacore::Double> &angles) const
 {
-  angles.resize(subtableInfo().getAntenna().getNumberOfAntennae());
-  ASKAPDEBUGASSERT(angles.size());
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_PARALLACTIC_ANGLE);
   if (subtableInfo().getAntenna().allEquatorial()) {
+      angles.resize(subtableInfo().getAntenna().getNumberOfAntennae());
+      ASKAPDEBUGASSERT(angles.size());
       angles.set(0.);
   } else {
-
-  const casacore::MEpoch epoch=currentEpoch();
-
-  // we need a separate converter for parallactic angle calculations
-  DirectionConverter dirConv((casacore::MDirection::Ref(casacore::MDirection::AZEL)));
-  dirConv.setMeasFrame(epoch);
-
-  // we currently use FIELD table to get the pointing direction. This table
-  // does not depend on the antenna.
-  const casacore::MDirection& antReferenceDir = getCurrentReferenceDir();
-
-
-  for (casacore::uInt ant = 0; ant<angles.size(); ++ant) {
-       const casacore::String &antMount=subtableInfo().getAntenna().
-                                          getMount(ant);
-
-       if (antMount == "ALT-AZ" || antMount == "alt-az")  {
-           casacore::MDirection celestialPole;
-           celestialPole.set(MDirection::Ref(MDirection::HADEC));
-           dirConv.setMeasFrame(casacore::MeasFrame(subtableInfo().getAntenna().
-                              getPosition(ant),epoch));
-           const casacore::Double pAngle=dirConv(antReferenceDir).
-                               positionAngle(dirConv(celestialPole).getValue());
-           angles[ant] = pAngle;
-       } else if (antMount == "FIXED"  ||  antMount == "fixed") {
-           // LOFAR has a fixed antenna mount.
-           angles[ant] = 0.;
-       } else if (antMount == "X-Y"  ||  antMount == "x-y") {
-           angles[ant] = 0.;
-       } else if (antMount != "EQUATORIAL" && antMount != "equatorial") {
-           ASKAPTHROW(DataAccessError,"Unknown mount type "<<antMount<<
-              " for antenna "<<ant);
-       }
-    }
+      if (!itsParallacticAngleEngine) {
+          // mounts and positions are analysed once, all antennas are then done in one pass
+          itsParallacticAngleEngine.reset(new ParallacticAngleEngine(subtableInfo().getAntenna(),
+                                          itsParallacticAngleInterval));
+      }
+      // we currently use FIELD table to get the pointing direction. This table
+      // does not depend on the antenna.
+      itsParallacticAngleEngine->compute(currentEpoch(), getCurrentReferenceDir(), angles);
+      ASKAPDEBUGASSERT(angles.size());
   } // if all equatorial
 }
 
@@ -878,6 +2556,7 @@ void TableConstDataIterator::fillParallacticAngleCache(casacore::Vector<casacore
 /// @param[in] dirs a reference to a vector to fill
 void TableConstDataIterator::fillDirectionCache(casacore::Vector<casacore::MVDirection> &dirs) const
 {
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_DIRECTION);
   // the code fills both pointing directions and position angles. For ASKAP, it would
   // probably be a bit faster if we split these two operations between two methods, as
   // position angle will be fixed and will not need as much updating as the pointing.
@@ -907,17 +2586,14 @@ void TableConstDataIterator::fillDirectionCache(casacore::Vector<casacore::MVDir
   const casacore::Vector<casacore::RigidVector<casacore::Double, 2> > &offsets =
                feedSubtable.getAllBeamOffsets(epoch,spWindowID);
 
+  // feed pointing centres in the frame of the reference direction. They are
+  // converted to the target frame in one go, unless the conversion depends
+  // on the position and the frame has to be set up for each antenna
+  casacore::Vector<casacore::MVDirection> feedPointingCentres(antIDs.nelements());
+
   for (casacore::uInt element=0;element<antIDs.nelements();++element) {
        const casacore::uInt ant=antIDs[element];
 
-       // if we decide to be paranoid about performance, we can add a method
-       // to the converter to test whether antenna position and/or epoch are
-       // really required to the requested convertion. Because the antenna
-       // position are cached, the overhead of the present straightforward
-       // approach should be relatively minor.
-       itsConverter->setMeasFrame(casacore::MeasFrame(epoch,subtableInfo().
-                     getAntenna().getPosition(ant)));
-
        casacore::RigidVector<casacore::Double, 2> offset = offsets[element];
        ASKAPDEBUGASSERT(ant<parallacticAngles.nelements());
        const casacore::Double posAngle = parallacticAngles[ant];
@@ -938,7 +2614,19 @@ void TableConstDataIterator::fillDirectionCache(casacore::Vector<casacore::MVDir
        // x direction is fliped to convert az-el type frame to ra-dec
        feedPointingCentre.shift(casacore::MVDirection(-offset(0),
                              offset(1)),casacore::True);
-       itsConverter->direction(feedPointingCentre,dirs[element]);
+       feedPointingCentres[element] = feedPointingCentre.getValue();
+  }
+
+  if (itsConverter->directionNeedsPosition()) {
+      for (casacore::uInt element=0;element<antIDs.nelements();++element) {
+           itsConverter->setMeasFrame(casacore::MeasFrame(epoch,subtableInfo().
+                         getAntenna().getPosition(antIDs[element])));
+           itsConverter->direction(casacore::MDirection(feedPointingCentres[element],
+                         antReferenceDir.getRef()), dirs[element]);
+      }
+  } else {
+      itsConverter->setMeasFrame(casacore::MeasFrame(epoch));
+      itsConverter->directions(antReferenceDir.getRef(), feedPointingCentres, dirs);
   }
 }
 
@@ -1035,6 +2723,7 @@ void TableConstDataIterator::fillDishPointing2(casacore::Vector<casacore::MVDire
 /// @param[in] dirs a reference to a vector to fill
 void TableConstDataIterator::fillDishPointingCache(casacore::Vector<casacore::MVDirection> &dirs) const
 {
+  IteratorStatistics::ScopedTimer timer(itsStatistics.get(), IteratorStatistics::FILL_DIRECTION);
   ASKAPDEBUGASSERT(itsConverter);
   const casacore::MEpoch epoch = currentEpoch();
 
@@ -1045,12 +2734,17 @@ void TableConstDataIterator::fillDishPointingCache(casacore::Vector<casacore::MV
   // a dependence (i.e. a large array and AZEL frame requested)
   const casacore::MDirection& antReferenceDir = getCurrentReferenceDir();
 
+  if (!itsConverter->directionNeedsPosition()) {
+      // the result is the same for all antennae, convert once
+      ASKAPDEBUGASSERT(dirs.nelements());
+      itsConverter->setMeasFrame(casacore::MeasFrame(epoch));
+      casacore::MVDirection dir;
+      itsConverter->direction(antReferenceDir,dir);
+      dirs.set(dir);
+      return;
+  }
+
   for (casacore::uInt ant = 0; ant<dirs.nelements(); ++ant) {
-       // if we decide to be paranoid about performance, we can add a method
-       // to the converter to test whether antenna position and/or epoch are
-       // really required to the requested convertion. Because the antenna
-       // position are cached, the overhead of the present straightforward
-       // approach should be relatively minor.
        itsConverter->setMeasFrame(casacore::MeasFrame(epoch,subtableInfo().
                   getAntenna().getPosition(ant)));
        itsConverter->direction(antReferenceDir,dirs[ant]);
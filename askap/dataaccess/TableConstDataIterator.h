@@ -35,8 +35,10 @@
 #define ASKAP_ACCESSORS_TABLE_CONST_DATA_ITERATOR_H
 
 // std includes
+#include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 // boost includes
 #include <boost/shared_ptr.hpp>
@@ -44,7 +46,12 @@
 // casa includes
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableIter.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/measures/Measures/Stokes.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/Slice.h>
 
 
 // own includes
@@ -54,7 +61,18 @@
 #include <askap/dataaccess/TableConstDataAccessor.h>
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/ITableManager.h>
+#include <askap/dataaccess/TableChunkPrefetcher.h>
+#include <askap/dataaccess/RotatedUVWStore.h>
+#include <askap/dataaccess/ParallacticAngleEngine.h>
 #include <askap/dataaccess/CachedAccessorField.tcc>
+#include <askap/dataaccess/ReusableBuffer.h>
+#include <askap/dataaccess/IBufferAllocator.h>
+#include <askap/dataaccess/ThreadAffinity.h>
+#include <askap/dataaccess/IteratorStatistics.h>
+#include <askap/dataaccess/QCStatistics.h>
+#include <askap/dataaccess/TableChunkIndex.h>
+#include <askap/dataaccess/TimeStepIterator.h>
+#include <askap/dataaccess/TimeOrderPermutation.h>
 
 namespace askap {
 
@@ -78,12 +96,44 @@ public:
   /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
   /// to initialisation of a new UVW Machine
   /// @param[in] maxChunkSize maximum number of rows per accessor
+  /// @param[in] nativeLayout if true, cubes in the table order (nPol x nChannel x nRow)
+  /// are the primary buffers and the cubes in the accessor order are derived from them
+  /// @param[in] prefetch if true, bulk data for the next chunk are read in a background thread
+  /// @param[in] skipFlaggedRows if true, rows flagged via FLAG_ROW are not read from the
+  /// data column (visibilities are set to zero)
+  /// @param[in] maxChannels maximum number of channels per accessor, zero means no restriction
+  /// @param[in] rotatedUVWStore optional store of rotated uvws shared between iterations
+  /// (empty shared pointer means that rotated uvws are computed for every pass)
+  /// @param[in] paInterval maximum time difference in seconds for which the conversion of the
+  /// reference direction is reused for parallactic angles (see ParallacticAngleEngine)
+  /// @param[in] useRowIndex if true, the selection is resolved via the index of the main
+  /// table rows (if possible) instead of evaluating the table expression
+  /// @param[in] freqTolerance maximum time difference in seconds for which the frequency
+  /// axis converted to the target frame is reused
+  /// @param[in] groupRows if true, rows of each time step are grouped by DATA_DESC_ID and
+  /// FIELD_ID, so chunks are not broken by interleaved spectral windows or fields
+  /// @param[in] chunkMemoryBudget maximum number of bytes of the bulk data per chunk, the 
+  /// number of rows is derived from it for each spectral setup (zero means no restriction
+  /// except maxChunkSize)
+  /// @param[in] timeOrder permutation of rows of the main table putting them in the time
+  /// order, the selected rows are visited in this order (empty pointer means the order
+  /// the rows are stored, the permutation is also ignored if it has been built for a 
+  /// different number of rows)
   TableConstDataIterator(const boost::shared_ptr<ITableManager const>
               &msManager,
               const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
 	      const boost::shared_ptr<IDataConverterImpl const> &conv,
 	      size_t cacheSize = 1, double tolerance = 1e-6,
-	      casacore::uInt maxChunkSize = INT_MAX);
+	      casacore::uInt maxChunkSize = INT_MAX, bool nativeLayout = false,
+	      bool prefetch = false, bool skipFlaggedRows = false,
+	      casacore::uInt maxChannels = 0,
+	      const boost::shared_ptr<RotatedUVWStore> &rotatedUVWStore = 
+	                 boost::shared_ptr<RotatedUVWStore>(),
+	      double paInterval = 0., bool useRowIndex = false,
+	      double freqTolerance = 0., bool groupRows = false,
+	      size_t chunkMemoryBudget = 0,
+	      const boost::shared_ptr<TimeOrderPermutation const> &timeOrder =
+	                 boost::shared_ptr<TimeOrderPermutation const>());
 
   /// Restart the iteration from the beginning
   virtual void init();
@@ -101,6 +151,116 @@ public:
   ///         while(it.next()) {} are possible)
   virtual casacore::Bool next();
 
+  /// @brief release the storage kept between chunks
+  /// @details Visibility, flag and noise cubes reuse the largest storage block
+  /// required so far (see ReusableBuffer). The blocks are kept until the iterator
+  /// is destroyed, this method frees them earlier (e.g. after a large chunk when
+  /// memory is tight). The storage is allocated again when the next cube is read.
+  /// Cubes of the current accessor are not affected, unless a custom allocator is
+  /// used (see setBufferAllocator). In this case, they are read again on demand.
+  void releaseBuffers();
+
+  /// @brief set a custom allocator of the data buffers
+  /// @details Visibility, flag and noise cubes (in both layouts, also the visibilities
+  /// of the additional data columns, weights and the channel-averaged cubes) are filled into 
+  /// storage blocks taken from the given allocator, e.g. page-locked memory suitable 
+  /// for DMA transfers to a GPU. Cubes obtained via the read-ahead (see 
+  /// TableChunkPrefetcher) are allocated in the usual way. The storage blocks are 
+  /// returned to the allocator when the iterator is destroyed or the buffers are released,
+  /// cubes obtained from the accessor must not be used after that.
+  /// @param[in] allocator shared pointer to the allocator (empty pointer for the 
+  /// default allocation)
+  void setBufferAllocator(const boost::shared_ptr<IBufferAllocator> &allocator);
+
+  /// @brief bind the iterator to a set of CPUs
+  /// @details This is intended for NUMA nodes, where the consumer of the data runs on the
+  /// given CPUs (e.g. it pins itself via affinity().apply()). The background reader is
+  /// restricted to the same CPUs and the data buffers are allocated and first touched there
+  /// (see FirstTouchAllocator), so the cubes given out reside in the local memory of the 
+  /// consumer. Any custom allocator set before is replaced. An empty set removes the 
+  /// restriction, but keeps the allocator.
+  /// @param[in] affinity set of CPUs
+  void setAffinity(const ThreadAffinity &affinity);
+
+  /// @brief set of CPUs the iterator is bound to
+  /// @return a const reference to the set (empty if not bound)
+  inline const ThreadAffinity& affinity() const { return itsAffinity; }
+
+  /// @brief attach I/O and cache statistics
+  /// @details If attached, the bytes read from each column, the time spent in the
+  /// main fill methods, the number of chunks and rows as well as the efficiency of
+  /// the accessor field and uvw machine caches are accumulated in the given object
+  /// (see IteratorStatistics). The same object can be shared between iterators. 
+  /// Nothing is counted by default. The current chunk (if any) is counted when
+  /// the statistics are attached.
+  /// @param[in] stats shared pointer to statistics (empty pointer to detach)
+  void setStatistics(const boost::shared_ptr<IteratorStatistics> &stats);
+
+  /// @brief obtain I/O and cache statistics
+  /// @return shared pointer to the statistics attached to this iterator (empty
+  /// pointer if the statistics are not collected)
+  inline const boost::shared_ptr<IteratorStatistics>& statistics() const { return itsStatistics; }
+
+  /// @brief attach quality control statistics
+  /// @details If attached, the flagged fraction, amplitude statistics and the number
+  /// of NaNs per baseline, beam and channel are accumulated in the given object once
+  /// per chunk (see QCStatistics). The flags of the chunk are read together with the
+  /// visibilities in this case. If only the flags of a chunk have been read, the
+  /// visibilities are read when the iterator moves to another chunk. The same object can
+  /// be shared between iterators. Nothing is accumulated by default.
+  /// @param[in] stats shared pointer to statistics (empty pointer to detach)
+  inline void setQCStatistics(const boost::shared_ptr<QCStatistics> &stats) { itsQCStatistics = stats; }
+
+  /// @brief obtain quality control statistics
+  /// @return shared pointer to the statistics attached to this iterator (empty
+  /// pointer if the statistics are not collected)
+  inline const boost::shared_ptr<QCStatistics>& qcStatistics() const { return itsQCStatistics; }
+
+  /// @brief set the format of the reduced precision visibilities
+  /// @details The format is used for the cubes filled after this call, i.e. it takes
+  /// effect with the next chunk unless the compact visibilities haven't been read yet.
+  /// @param[in] format format of the cube returned by compactVisibility
+  inline void setCompactVisibilityFormat(CompactVisibilityCube::Format format) 
+         { itsCompactVisibilityFormat = format; }
+
+  /// @brief obtain the format of the reduced precision visibilities
+  /// @return format of the cube returned by compactVisibility
+  inline CompactVisibilityCube::Format compactVisibilityFormat() const 
+         { return itsCompactVisibilityFormat; }
+
+  /// @brief obtain the index of chunks
+  /// @details The index is built on the first call by a pass over the TIME, DATA_DESC_ID
+  /// and FIELD_ID columns of the selected rows and is kept for the lifetime of the iterator.
+  /// @return a reference to the index of chunks
+  const TableChunkIndex& chunkIndex() const;
+
+  /// @brief total number of chunks
+  /// @details If channels are split into several ranges (see maxChannels parameter of the 
+  /// constructor), each chunk is delivered as a number of iteration steps. The chunk
+  /// index is built if necessary.
+  /// @return number of chunks for the whole selection
+  casacore::uInt nChunks() const;
+
+  /// @brief index of the current chunk
+  /// @details This number can be stored (e.g. in a checkpoint) and passed to seek later.
+  /// @return zero-based index of the current chunk or nChunks() if the iteration is complete
+  casacore::uInt currentChunk() const;
+
+  /// @brief jump to the given chunk
+  /// @details The iteration continues from the first range of channels of the given chunk.
+  /// The table iterator is stepped through the preceding time steps without reading any data,
+  /// it is restarted only if the chunk precedes the current one.
+  /// @param[in] chunk zero-based index of the chunk (should be less than nChunks())
+  virtual void seek(casacore::uInt chunk);
+
+  /// @brief jump to the first chunk not earlier than the given time
+  /// @details If all chunks are earlier than the given time, the iteration is completed
+  /// (i.e. hasMore() returns false).
+  /// @param[in] time time in the frame and units of the converter (i.e. the same as 
+  /// returned by the time() method of the accessor)
+  /// @return true if there are more data
+  casacore::Bool seekTime(casacore::Double time);
+
   /// methods used in the accessor.
 
   /// @return number of rows in the current accessor
@@ -113,8 +273,9 @@ public:
   /// @return number of channels in the current accessor
   casacore::uInt inline nChannel() const throw() { return getChannelRange().first;}
 
-  /// @return number of channels in the current accessor
-  casacore::uInt inline nPol() const throw() { return itsNumberOfPols;}
+  /// @return number of polarisations in the current accessor
+  casacore::uInt inline nPol() const throw() 
+         { return itsPolConversion.nelements() ? itsPolConversion.nrow() : itsNumberOfPols;}
 
   /// populate the buffer of visibilities with the values of current
   /// iteration
@@ -127,6 +288,34 @@ public:
   /// @param[in] noise a reference to the nRow x nChannel x nPol buffer
   ///            cube to be filled with the noise figures
   void fillNoise(casacore::Cube<casacore::Complex> &noise) const;
+
+  /// @brief populate the buffer of weights
+  /// @details Weights are zero for flagged elements, otherwise they are taken from
+  /// WEIGHT_SPECTRUM, if present, or derived from the noise figures as 1/sigma^2
+  /// (see IWeightDataAccessor). Where possible, SIGMA_SPECTRUM or WEIGHT_SPECTRUM is read 
+  /// straight into the weight buffer and converted in place, so the complex noise cube is 
+  /// not formed. 
+  /// @param[in] weight a reference to the nRow x nChannel x nPol buffer
+  ///            cube to be filled with the weights
+  void fillWeight(casacore::Cube<casacore::Float> &weight) const;
+
+  /// @brief determine the type of the noise representation
+  /// @details The noise is constant if neither SIGMA_SPECTRUM nor SIGMA columns
+  /// are present, it depends on row and polarisation only if SIGMA is given per
+  /// polarisation for all rows of the chunk, and is spectral otherwise.
+  /// @param[out] repr reference to the buffer to fill
+  void fillNoiseRepresentation(ICompactNoiseDataAccessor::NoiseRepresentation &repr) const;
+
+  /// @brief populate the buffer of noise figures per row and polarisation
+  /// @details This method is only valid if the noise doesn't depend on the spectral
+  /// channel (see fillNoiseRepresentation). An exception is thrown otherwise.
+  /// @param[in] noise a reference to the nRow x nPol buffer to be filled
+  void fillRowPolNoise(casacore::Matrix<casacore::Complex> &noise) const;
+
+  /// @brief noise value for the constant noise case
+  /// @details An exception is thrown if the noise is not constant for the current chunk
+  /// @return complex noise estimate used for all elements
+  casacore::Complex constantNoise() const;
   
   /// @brief read flagging information
   /// @details populate the buffer of flags with the information
@@ -136,15 +325,100 @@ public:
   ///            bool type)
   void fillFlag(casacore::Cube<casacore::Bool> &flag) const;
 
+  /// @brief populate the buffer of bit-packed flags
+  /// @details Rows flagged via FLAG_ROW are not read from the FLAG column.
+  /// @param[in] flag a reference to the packed flag buffer to fill
+  void fillPackedFlag(PackedFlagCube &flag) const;
+
+  /// @brief populate the buffer of reduced precision visibilities
+  /// @details Without conversions the cube is packed from the visibilities in the storage
+  /// order, so the accessor-order cube is not formed.
+  /// @param[in] vis a reference to the compact visibility buffer to fill
+  void fillCompactVisibility(CompactVisibilityCube &vis) const;
+
+  /// @brief populate the map of rows which are not flagged as a whole
+  /// @details All rows are listed if the table has no FLAG_ROW column
+  /// @param[in] rows a reference to the vector to fill with accessor rows containing data
+  void fillUnflaggedRows(casacore::Vector<casacore::uInt> &rows) const;
+
+  /// @brief populate the buffers of visibilities of the additional data columns
+  /// @details All columns chosen via ITableDataSelectorImpl::chooseExtraDataColumns
+  /// are read in one go for the rows and channels of the current chunk.
+  /// @param[in] cubes a reference to the map of nRow x nChannel x nPol cubes
+  ///            to fill, the key is the column name
+  void fillColumnVisibility(TableConstDataAccessor::ColumnVisibilities &cubes) const;
+
+  /// @brief check whether the given column is the main data column
+  /// @param[in] column name of the column
+  /// @return true, if visibilities of this column are returned by the accessor's visibility()
+  inline bool isDataColumn(const std::string &column) const { return column == getDataColumnName(); }
+
+  /// @brief populate the buffer of visibilities in the native order
+  /// @param[in] vis a reference to the nPol x nChannel x nRow buffer
+  ///            cube to fill with the complex visibility data
+  void fillNativeVisibility(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief populate the buffer of flags in the native order
+  /// @param[in] flag a reference to the nPol x nChannel x nRow buffer
+  ///            cube to fill with the flag information
+  void fillNativeFlag(casacore::Cube<casacore::Bool> &flag) const;
+
+  /// @brief populate the buffer of noise figures in the native order
+  /// @details The bulk read is only done for SIGMA_SPECTRUM, other cases are
+  /// handled by the general noise reader followed by a transpose.
+  /// @param[in] noise a reference to the nPol x nChannel x nRow buffer
+  ///            cube to be filled with the noise figures
+  void fillNativeNoise(casacore::Cube<casacore::Complex> &noise) const;
+
+  /// @brief check whether the native order is the primary one
+  /// @return true, if cubes in the table order are read first and the
+  /// accessor-order cubes are derived from them
+  inline bool nativeLayout() const { return itsNativeLayout;}
+
+  /// @brief check whether the read-ahead is done in the background
+  /// @return true, if bulk data for the next chunk are prefetched
+  inline bool prefetch() const { return itsPrefetch;}
+
+  /// @brief check whether rows flagged as a whole are skipped
+  /// @return true, if visibilities and flags of the rows with FLAG_ROW set
+  /// are not read from the table
+  inline bool skipFlaggedRows() const { return itsSkipFlaggedRows;}
+
+  /// @brief maximum number of channels per accessor
+  /// @return maximum number of channels delivered in one iteration, zero means that 
+  /// all selected channels are delivered together
+  inline casacore::uInt maxChannels() const { return itsMaxChannels;}
+
   /// populate the buffer with uvw
   /// @param[in] uvw a reference to vector of rigid vectors (3 elemets,
   ///            u,v and w for each row) to fill
   void fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&uvw) const;
 
+  /// @brief populate the key of the current chunk for the store of rotated uvws
+  /// @details The chunk is identified by the time and the row numbers in the 
+  /// measurement set, so the key doesn't depend on the selection or chunk size used.
+  /// @param[in] key a reference to the key to fill
+  void fillChunkKey(RotatedUVWStore::ChunkKey &key) const;
+
   /// populate the buffer with frequencies
   /// @param[in] freq a reference to a vector to fill
   void fillFrequency(casacore::Vector<casacore::Double> &freq) const;
 
+  /// @brief populate the buffer with uvw in single precision
+  /// @details The conversion is done from the accessor's uvw, which are read if necessary.
+  /// @param[in] uvw a reference to vector of rigid vectors to fill
+  void fillFloatUVW(casacore::Vector<casacore::RigidVector<casacore::Float, 3> > &uvw) const;
+
+  /// @brief populate the buffer with frequencies in single precision
+  /// @param[in] freq a reference to a vector to fill
+  void fillFloatFrequency(casacore::Vector<casacore::Float> &freq) const;
+
+  /// @brief populate the buffer with inverse wavelengths
+  /// @details Frequencies given by the accessor are scaled from the units set in 
+  /// the converter to Hz and divided by the speed of light.
+  /// @param[in] invLambda a reference to a vector to fill with 1/lambda in 1/metres
+  void fillInverseWavelength(casacore::Vector<casacore::Float> &invLambda) const;
+
   /// @return the time stamp in the table's native frame/units
   /// @note this method doesn't do any caching. It reads the table each
   /// time it is called. It is intended for use from the accessor only, where
@@ -210,6 +484,10 @@ public:
   /// @return direction tolerance used for UVW machine cache (in radians)
   inline double uvwMachineCacheTolerance() const {return itsUVWCacheTolerance;}   
 
+  /// @brief store of rotated uvws shared between iterations
+  /// @return pointer to the store or NULL, if rotated uvws are not stored
+  inline RotatedUVWStore* rotatedUVWStore() const {return itsRotatedUVWStore.get();}
+
   /// @brief obtain a current field ID
   /// @details This method obtains a field ID corresponding to the
   /// current iteration, if field ID column is present (and used). Otherwise
@@ -236,6 +514,20 @@ protected:
   /// @return a pair, first element is the number of channels, second is the first channel
   /// in the full cube
   std::pair<casacore::uInt, casacore::uInt> getChannelRange() const;
+
+  /// @brief obtain the whole selected range of channels
+  /// @details Unlike getChannelRange, this method ignores the split into channel tiles
+  /// (see maxChannels) and returns the full range defined by the selector.
+  /// @return a pair, first element is the number of channels, second is the first channel
+  /// in the full cube
+  std::pair<casacore::uInt, casacore::uInt> getSelectedChannelRange() const;
+
+  /// @brief number of channel tiles for the current rows
+  /// @details The number is computed when the chunk is set up (see countChannelTiles),
+  /// so this method is cheap and doesn't throw.
+  /// @return number of accessors the selected channels are split into (1 if no
+  /// restriction on the number of channels is set, 0 if there are no data)
+  casacore::uInt nChannelTiles() const throw();
   
   /// @brief a short cut to get the first channel in the full cube
   /// @return the number of the first channel in the full cube
@@ -248,8 +540,173 @@ protected:
   /// @param[in] cube a reference to the nRow x nChannel x nPol buffer
   ///            cube to fill with the information from table
   /// @param[in] columnName a name of the column to read
+  /// @param[in] buffer storage reused for the cube between chunks
+  /// @param[in] scratch storage reused for the intermediate cube in the native order
+  template<typename T>
+  void fillCube(casacore::Cube<T> &cube, const std::string &columnName,
+                ReusableBuffer<T> &buffer, ReusableBuffer<T> &scratch) const;
+
+  /// @brief update the quality control statistics with the current chunk
+  /// @details This method is called when the visibilities are filled if the statistics
+  /// are attached. It does nothing if the current chunk has already been accumulated
+  /// (e.g. the cube is read again after releaseBuffers). The flags of the current chunk
+  /// are obtained via the accessor.
+  /// @param[in] vis visibilities of the current chunk (nRow x nChannel x nPol)
+  void accumulateQCStatistics(const casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief mark the current chunk for the quality control statistics
+  /// @details This method is called when the flags are filled. If the visibilities of
+  /// the chunk haven't been accumulated yet, they are read by finishQCStatistics.
+  void flagsObtainedForQC() const;
+
+  /// @brief complete the quality control statistics for the current chunk
+  /// @details This method is called before the iterator leaves the current chunk. The
+  /// visibilities are read if only the flags of the chunk have been used, so every
+  /// chunk is accumulated exactly once regardless of the fields accessed.
+  void finishQCStatistics();
+
+  /// @brief slicer of a table cell for the current chunk
+  /// @details The slicer covers the selected polarisations and channels. If the
+  /// requested polarisation products are a subset of the stored ones, only this subset
+  /// is read.
+  /// @return slicer to be used with getSlice or getColumnRange
+  casacore::Slicer cellSlicer() const;
+
+  /// @brief index of the stored polarisation product
+  /// @param[in] pol index of the polarisation product read from the table
+  /// @return index of the same product in the table cell
+  inline casacore::uInt storedPol(casacore::uInt pol) const 
+         { return itsPolSlice.all() ? pol : itsPolSlice.start() + pol * itsPolSlice.inc(); }
+
+  /// @brief set up polarisation selection for the current data description
+  /// @details This method sets itsNumberOfPols, itsPolSlice and itsPolConversion
+  /// from the products requested via the selector and the products stored in the
+  /// table. It is called when DATA_DESC_ID changes.
+  void setUpPolSelection();
+
+  /// @brief check that the data are delivered as stored
+  /// @details An exception is thrown if the requested polarisation products are not 
+  /// a subset of the stored ones or if channels are averaged at read time, because the
+  /// given operation can't be done in this case.
+  /// @param[in] what description of the operation (for the error message)
+  void checkNoConversion(const char *what) const;
+
+  /// @brief number of adjacent channels averaged at read time
+  /// @return number of channels per output channel (1 means no averaging)
+  inline casacore::uInt channelAveraging() const 
+         { return itsSelector->getChannelAveraging(); }
+
+  /// @brief read and average visibilities, flags and noise of the current chunk
+  /// @details If channels are averaged at read time, the three cubes are produced 
+  /// together in one pass over the chunk. Blocks of rows are read in the native order
+  /// and averaged straight away (see ChannelAverager), so the cubes at the full spectral
+  /// resolution are never held for the whole chunk. The result is kept until the 
+  /// iterator moves to the next chunk.
+  void fillAveragedCubes() const;
+
+  /// @brief read noise figures for a block of rows in the native order
+  /// @details This is a helper for fillAveragedCubes. Noise is taken from SIGMA_SPECTRUM,
+  /// from SIGMA (the same for all channels) or set to 1 if neither column exists.
+  /// @param[in] sigma nPol x nChannel x nRow cube to fill (shape defines the block size)
+  /// @param[in] firstRow first row of the block w.r.t. the current chunk
+  void readSigmaBlock(casacore::Cube<casacore::Float> &sigma, casacore::uInt firstRow) const;
+
+  /// @brief storage for the visibilities of an additional data column
+  /// @details The buffer is created on the first request with the current allocator.
+  /// @param[in] column name of the data column
+  /// @return a reference to the buffer
+  ReusableBuffer<casacore::Complex>& columnVisBuffer(const std::string &column) const;
+
+  /// @brief maximum number of rows per chunk for the given spectral setup
+  /// @details If the memory budget is set, the number of rows is derived from the 
+  /// number of channels and polarisations of the given data description and the
+  /// bulk fields required. It doesn't exceed the maximum chunk size given in the 
+  /// constructor and is at least one row.
+  /// @param[in] dataDescID data description ID
+  /// @return maximum number of rows
+  casacore::uInt maxChunkSize(casacore::Int dataDescID) const;
+
+  /// @brief estimate of the memory used by one row of a chunk
+  /// @details The estimate covers the cubes and per-row fields required from the accessor
+  /// (visibility, flag, noise and uvw), assuming the whole cell is read.
+  /// @param[in] dataDescID data description ID
+  /// @return number of bytes per row
+  size_t chunkRowBytes(casacore::Int dataDescID) const;
+
+  /// @brief array column of the selected table
+  /// @details Column objects are created on the first request and reused for
+  /// the whole pass, so they're not attached again for every chunk.
+  /// @param[in] name name of the column
+  /// @return a reference to the column object
+  template<typename T>
+  const casacore::ROArrayColumn<T>& arrayColumn(const std::string &name) const;
+
+  /// @brief scalar column of the selected table
+  /// @details See arrayColumn for details
+  /// @param[in] name name of the column
+  /// @return a reference to the column object
+  template<typename T>
+  const casacore::ROScalarColumn<T>& scalarColumn(const std::string &name) const;
+
+  /// @brief check that all rows of the current chunk have the same cell shape
+  /// @details Bulk read of a number of rows is only possible if the cells of
+  /// the array column are 2D and have the same shape as the first row of the chunk
+  /// (the shape which defines itsNumberOfStoredPols and itsNumberOfChannels).
+  /// @param[in] col array column to check
+  /// @return true, if all cells are 2D and conform to the current shape
+  bool uniformCellShape(const casacore::ROTableColumn &col) const;
+
+  /// @brief check the shape of one cell of an array column
+  /// @details An exception is thrown if the given row of the current chunk
+  /// doesn't conform to the number of polarisations and channels set up for the chunk.
+  /// @param[in] col array column to check
+  /// @param[in] row row of the current chunk (i.e. w.r.t. itsCurrentTopRow)
+  /// @param[in] columnName name of the column (for the error message)
+  void checkCellShape(const casacore::ROTableColumn &col, casacore::uInt row,
+                      const std::string &columnName) const;
+
+  /// @brief read an array column of the table into a cube in the native order
+  /// @details This method is similar to fillCube, but the cube is filled in the
+  /// order the data are stored in the table, i.e. nPol x nChannel x nRow. No
+  /// transpose is required, so the whole chunk is read directly into the buffer
+  /// if all rows have the same shape.
+  /// @param[in] cube a reference to the nPol x nChannel x nRow buffer
+  ///            cube to fill with the information from table
+  /// @param[in] columnName a name of the column to read
+  /// @param[in] buffer storage reused for the cube between chunks
   template<typename T>
-  void fillCube(casacore::Cube<T> &cube, const std::string &columnName) const;
+  void fillNativeCube(casacore::Cube<T> &cube, const std::string &columnName,
+                      ReusableBuffer<T> &buffer) const;
+
+  /// @brief read rows which are not flagged as a whole into a cube in the native order
+  /// @details This is the reader used if flagged rows are skipped. Only rows present
+  /// in the map returned by unflaggedRows are read, contiguous runs of such rows are
+  /// read in one go if all cells have the same shape. Other rows are filled with the
+  /// given value.
+  /// @param[in] cube a reference to the nPol x nChannel x nRow buffer
+  ///            cube to fill with the information from table
+  /// @param[in] columnName a name of the column to read
+  /// @param[in] flaggedValue value assigned to the rows which are not read
+  template<typename T>
+  void readUnflaggedRows(casacore::Cube<T> &cube, const std::string &columnName,
+                         const T &flaggedValue) const;
+
+  /// @brief set visibilities of the rows flagged as a whole to zero
+  /// @details This is used for visibilities obtained from the background reader,
+  /// which always reads the whole chunk.
+  /// @param[in] vis visibility cube to update
+  /// @param[in] native true, if the cube is in the storage order (nPol x nChannel x nRow),
+  /// false for the accessor order (nRow x nChannel x nPol)
+  void blankFlaggedRows(casacore::Cube<casacore::Complex> &vis, bool native) const;
+
+  /// @brief read noise figures from the table
+  /// @details This is the actual reader of noise figures in the accessor order used
+  /// by both fillNoise and fillNativeNoise
+  /// @param[in] noise a reference to the nRow x nChannel x nPol buffer
+  ///            cube to be filled with the noise figures
+  /// @param[in] buffer storage reused for the noise cube between chunks
+  void readNoise(casacore::Cube<casacore::Complex> &noise,
+                 ReusableBuffer<casacore::Complex> &buffer) const;
 
   /// @brief A helper method to fill a given vector with pointing directions.
   /// @details fillPointingDir1 and fillPointingDir2 methods do very similar
@@ -311,6 +768,18 @@ protected:
   /// when DATA_DESC_ID changes (and therefore at the first run as well)
   void makeUniformDataDescID();
 
+  /// @brief setup the next chunk within the current iteration of the table iterator
+  /// @details The chunk starts at itsCurrentTopRow, the number of rows is limited by the
+  /// maximum chunk size and by changes of DATA_DESC_ID and FIELD_ID
+  void setUpChunk();
+
+  /// @brief compute the number of channel tiles for the current rows
+  /// @details This method is called when a new chunk of rows is set up, the result
+  /// is cached and returned by nChannelTiles.
+  /// @return number of accessors the selected channels are split into (1 if no
+  /// restriction on the number of channels is set, 0 if there are no data)
+  casacore::uInt countChannelTiles() const;
+
   /// @brief method ensures that the chunk has a uniform FIELD_ID
   /// @details This method reduces itsNumberOfRows until FIELD_ID is
   /// the same for all rows in the current chunk. The resulting 
@@ -366,21 +835,27 @@ protected:
   /// data description ID and tests its validity
   /// @return current polarisation ID
   casacore::uInt currentPolID() const;
+
+  /// @brief check whether polarisation products have been selected
+  /// @details Writing is not supported in this case
+  /// @return true, if the accessor delivers products other than those stored
+  inline bool polarizationsSelected() const
+         { return itsSelector->getPolarizationSelection().nelements() > 0; }
   
-  /// @brief obtain the current iteration of the table iterator
-  /// @details This class uses TableIterator behind the scene. This method
-  /// returns the current iteration, which can be used in derived classes
-  /// (e.g. for read-write access)
+  /// @brief obtain the table the current iteration refers to
+  /// @details This class iterates over time steps as ranges of rows of the table
+  /// with the selected rows (see TimeStepIterator). This method returns this table,
+  /// which can be used in derived classes (e.g. for read-write access) together with
+  /// getCurrentTopRow.
   /// @return a const reference to table object representing the current iteration
   inline const casacore::Table& getCurrentIteration() const throw() 
        {return itsCurrentIteration;}
   
   /// @brief obtain the current top row
-  /// @details This class uses TableIterator behind the scence. One iteration
-  /// of the table iterator may cover more than one iteration of the iterator
-  /// represented by this class. The result of this method is a row number, 
-  /// where current data accessor starts.
-  /// @return row number in itsCurrentItrertion corresponding to row 0 of the
+  /// @details One time step may cover more than one iteration of the iterator
+  /// represented by this class. The result of this method is a row number
+  /// of the table returned by getCurrentIteration, where current data accessor starts.
+  /// @return row number in itsCurrentIteration corresponding to row 0 of the
   /// accessor at this iteration
   inline casacore::uInt getCurrentTopRow() const throw() {return itsCurrentTopRow;}
   
@@ -400,6 +875,84 @@ protected:
   /// the former is not supported by the main table.
   /// @return a reference to direction measure
   const casacore::MDirection& getCurrentReferenceDir() const;
+
+  /// @brief wait for the background jobs to finish
+  /// @details The table system is not thread-safe. This method should be called
+  /// before any access to the main table. It waits for the read-ahead and does nothing
+  /// if prefetch is not used. Derived classes running their own background jobs
+  /// should override it.
+  virtual void waitForBackgroundJobs() const;
+
+  /// @brief start reading the next chunk in the background
+  /// @details This method is called when the bulk data of the current chunk
+  /// have been obtained by the accessor, so the background read would overlap with
+  /// the processing of the current chunk. It does nothing if prefetch is not used or
+  /// there is no next chunk.
+  void startPrefetch() const;
+
+  /// @brief notify that a bulk field of the current chunk has been obtained
+  /// @details If the required fields have been declared via the selector, the 
+  /// background jobs are started when all declared bulk fields (visibility, flag, noise and 
+  /// uvw) of the current chunk have been obtained. Otherwise, they are started when the
+  /// visibilities are obtained (see chunkObtained).
+  /// @param[in] field field which has been filled (ITableDataSelectorImpl::AccessorField)
+  void fieldObtained(int field) const;
+
+  /// @brief notify that the bulk data of the current chunk have been obtained
+  /// @details This method is called by fieldObtained at the point where the table
+  /// is not expected to be needed for a while. The default action is to start the
+  /// read-ahead. Derived classes can use it to start their own background jobs.
+  virtual void chunkObtained() const;
+
+  /// @brief account for the data read from a column
+  /// @details Does nothing if the statistics are not collected
+  /// @param[in] column column name
+  /// @param[in] bytes number of bytes
+  void countRead(const std::string &column, size_t bytes) const;
+
+  /// @brief account for the data written to a column
+  /// @details Does nothing if the statistics are not collected
+  /// @param[in] column column name
+  /// @param[in] bytes number of bytes
+  void countWrite(const std::string &column, size_t bytes) const;
+
+  /// @brief make prefetched data available for the current chunk
+  /// @details This method is called after the iteration is advanced. The data read
+  /// in the background are checked against the current chunk and discarded if they don't
+  /// match (e.g. if the chunk has been broken due to non-uniform DATA_DESC_ID).
+  void acceptPrefetchedChunk();
+
+  /// @brief frequency axis converted last time
+  /// @details The converted axis is reused while the spectral window, the channel 
+  /// range and the reference direction are the same and the time changes by no more 
+  /// than the tolerance (see TableConstDataSource::configureFrequencyFrameTolerance)
+  struct ConvertedFrequencyAxis {
+     /// @brief construct an empty object, which doesn't match anything
+     ConvertedFrequencyAxis();
+
+     /// @brief check whether the converted axis can be reused
+     /// @param[in] spWindow spectral window ID
+     /// @param[in] startChan first channel
+     /// @param[in] nChan number of channels
+     /// @param[in] time time in seconds
+     /// @param[in] dir reference direction used for the conversion
+     /// @param[in] tolerance maximum time difference in seconds
+     /// @return true, if the axis converted last time can be used 
+     bool matches(casacore::uInt spWindow, casacore::uInt startChan, casacore::uInt nChan,
+                  casacore::Double time, const casacore::MVDirection &dir, 
+                  casacore::Double tolerance) const;
+
+     /// @brief spectral window ID, negative if the axis is undefined
+     casacore::Int itsSpWindow;
+     /// @brief first channel
+     casacore::uInt itsStartChan;
+     /// @brief time of the conversion (in seconds)
+     casacore::Double itsTime;
+     /// @brief reference direction used for the conversion
+     casacore::MVDirection itsDirection;
+     /// @brief converted frequencies
+     casacore::Vector<casacore::Double> itsFrequencies;
+  };
     
 private:
   // note, it is essential that itsUVWCacheSize and itsUVWCacheTolerance are initialised
@@ -415,6 +968,9 @@ private:
   /// @details Exceeding this tolerance leads to initialisation of a new UVW Machine in the cache
   double itsUVWCacheTolerance; 
 
+  /// @brief store of rotated uvws shared between iterations (may be empty)
+  boost::shared_ptr<RotatedUVWStore> itsRotatedUVWStore;
+
   /// accessor (a chunk of data) 
   /// although the accessor type can be different
   TableConstDataAccessor itsAccessor;  
@@ -423,12 +979,131 @@ private:
   boost::shared_ptr<IDataConverterImpl>  itsConverter;
   /// the maximum allowed number of rows in the accessor.
   casacore::uInt itsMaxChunkSize;
-  casacore::TableIterator itsTabIterator;
-  /// current group of data returned by itsTabIterator
+
+  /// @brief true, if cubes in the table order are the primary buffers
+  /// @details In this mode, visibility, flag and noise cubes in the accessor order
+  /// are obtained by transposing cubes in the native order, rather than read from disk.
+  bool itsNativeLayout;
+
+  /// @brief true, if the next chunk is read in the background
+  bool itsPrefetch;
+
+  /// @brief true, if rows flagged via FLAG_ROW are not read from the table
+  bool itsSkipFlaggedRows;
+
+  /// @brief maximum number of channels per accessor, zero means no restriction
+  /// @details If the number of selected channels exceeds this value, each chunk of
+  /// rows is delivered as a number of accessors with consecutive ranges of channels.
+  casacore::uInt itsMaxChannels;
+
+  /// @brief zero-based index of the current range of channels (tile)
+  casacore::uInt itsCurrentChannelTile;
+
+  /// @brief number of channel tiles for the current rows (see nChannelTiles)
+  casacore::uInt itsNChannelTiles;
+
+  /// @brief bulk fields of the current chunk obtained so far
+  /// @details ITableDataSelectorImpl::AccessorField values or'ed together, used
+  /// to decide when to start the read-ahead (see fieldObtained)
+  mutable int itsFieldsObtained;
+
+  /// @brief true if the current chunk has been added to the quality control statistics
+  mutable bool itsQCChunkAdded;
+
+  /// @brief true if the flags of the current chunk have been read, but the chunk
+  /// hasn't been added to the quality control statistics yet
+  mutable bool itsQCChunkPending;
+
+  /// @brief background reader, empty pointer if prefetch is not used
+  boost::shared_ptr<TableChunkPrefetcher> itsPrefetcher;
+
+  /// @brief storage for the visibility cube in the accessor order
+  /// @details This and the following buffers keep their capacity between chunks,
+  /// so cubes are not reallocated if the number of rows changes (see releaseBuffers)
+  mutable ReusableBuffer<casacore::Complex> itsVisBuffer;
+
+  /// @brief storage for the visibility cube in the native order
+  mutable ReusableBuffer<casacore::Complex> itsNativeVisBuffer;
+
+  /// @brief storage for the flag cube in the accessor order
+  mutable ReusableBuffer<casacore::Bool> itsFlagBuffer;
+
+  /// @brief storage for the flag cube in the native order
+  mutable ReusableBuffer<casacore::Bool> itsNativeFlagBuffer;
+
+  /// @brief storage for the noise cube in the accessor order
+  mutable ReusableBuffer<casacore::Complex> itsNoiseBuffer;
+
+  /// @brief storage for the noise cube in the native order
+  mutable ReusableBuffer<casacore::Complex> itsNativeNoiseBuffer;
+
+  /// @brief storage for the weight cube in the accessor order
+  mutable ReusableBuffer<casacore::Float> itsWeightBuffer;
+
+  /// @brief storage for the visibility cubes of the additional data columns
+  mutable std::map<std::string, ReusableBuffer<casacore::Complex> > itsColumnVisBuffers;
+
+  /// @brief storage for intermediate complex-valued cubes used within one fill
+  mutable ReusableBuffer<casacore::Complex> itsComplexScratch;
+
+  /// @brief storage for intermediate flag cubes used within one fill
+  mutable ReusableBuffer<casacore::Bool> itsBoolScratch;
+
+  /// @brief storage for complex cubes of all stored products before polarisation conversion
+  mutable ReusableBuffer<casacore::Complex> itsStoredComplexBuffer;
+
+  /// @brief storage for flag cubes of all stored products before polarisation conversion
+  mutable ReusableBuffer<casacore::Bool> itsStoredBoolBuffer;
+
+  /// @brief storage for intermediate cubes of noise figures read from the table
+  mutable ReusableBuffer<casacore::Float> itsFloatScratch;
+
+  /// @brief storage for intermediate uvw matrices read from the table
+  mutable ReusableBuffer<casacore::Double> itsDoubleScratch;
+
+  /// @brief rows of the current chunk to be read, kept to avoid allocation for every chunk
+  mutable std::vector<casacore::uInt> itsRowsToRead;
+
+  /// @brief visibilities of the current chunk averaged in frequency (accessor order)
+  mutable casacore::Cube<casacore::Complex> itsAveragedVis;
+
+  /// @brief flags of the current chunk averaged in frequency (accessor order)
+  mutable casacore::Cube<casacore::Bool> itsAveragedFlag;
+
+  /// @brief noise of the current chunk averaged in frequency (accessor order)
+  mutable casacore::Cube<casacore::Complex> itsAveragedNoise;
+
+  /// @brief true, if the averaged cubes correspond to the current chunk
+  mutable bool itsAveragedChunkValid;
+
+  /// @brief number of rows read in one go when channels are averaged
+  static const casacore::uInt theirAveragingBlockSize = 64;
+
+  /// @brief current time step of itsTabIterator (zero-based)
+  casacore::uInt itsIterationStep;
+
+  /// @brief table with the selected rows the table iterator works with
+  casacore::Table itsSelectedTable;
+
+  /// @brief index of chunks, built on demand
+  mutable boost::shared_ptr<TableChunkIndex> itsChunkIndex;
+
+  /// @brief iterator over time steps of itsSelectedTable
+  TimeStepIterator itsTabIterator;
+  /// table the current group of data returned by itsTabIterator refers to
+  /// (the same as itsSelectedTable)
   casacore::Table itsCurrentIteration;
+  /// @brief first row of the current time step in itsCurrentIteration
+  casacore::uInt itsIterationStart;
+  /// @brief row following the last row of the current time step in itsCurrentIteration
+  casacore::uInt itsIterationEnd;
   /// current row in the itsCurrentIteration projected to the row 0
   /// of the data accessor
   casacore::uInt itsCurrentTopRow;
+  /// @brief columns of itsSelectedTable attached on the first use
+  mutable std::map<std::string, boost::shared_ptr<casacore::ROTableColumn> > itsColumnCache;
+  /// @brief row numbers of itsSelectedTable in the measurement set, obtained on demand
+  mutable casacore::Vector<casacore::uInt> itsRowNumbers;
   /// number of rows in the current chunk
   casacore::uInt itsNumberOfRows;
   /// next two data members show the number of channels and
@@ -436,7 +1111,18 @@ private:
   /// is sent out
   casacore::uInt itsNumberOfChannels;
   /// see above
+  casacore::uInt itsNumberOfStoredPols;
+  /// @brief number of polarisations read from the table
+  /// @details This is the number of selected products if they are read directly,
+  /// or the number of stored products otherwise
   casacore::uInt itsNumberOfPols;
+  /// @brief polarisations read from the table
+  /// @details The slice covers all stored products unless a subset has been selected
+  casacore::Slice itsPolSlice;
+  /// @brief polarisation conversion matrix (nOut x nStored)
+  /// @details The matrix is empty unless the requested products are not a subset
+  /// of the stored ones. In this case, all products are read and converted.
+  casacore::Matrix<casacore::Complex> itsPolConversion;
 
   /// current DATA_DESC_ID, the iteration is broken if this
   /// ID changes
@@ -469,6 +1155,53 @@ private:
   
   /// internal buffer for dish pointings for all antennae
   CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsDishPointingCache;    
+
+  /// @brief maximum time difference in seconds to reuse the conversion for parallactic angles
+  double itsParallacticAngleInterval;
+
+  /// @brief engine computing parallactic angles for all antennas
+  /// @details It is set up on the first use as it requires the antenna subtable
+  mutable boost::shared_ptr<ParallacticAngleEngine> itsParallacticAngleEngine;
+
+  /// @brief true, if the selection is resolved via the index of the main table rows
+  /// @details The index is used only if all selections can be expressed via the
+  /// indexed columns (see MainTableRowIndex), the table expression is used otherwise.
+  bool itsUseRowIndex;
+
+  /// @brief frequency axis converted last time
+  mutable ConvertedFrequencyAxis itsConvertedFrequencies;
+
+  /// @brief maximum time difference in seconds to reuse the converted frequency axis
+  double itsFrequencyFrameTolerance;
+
+  /// @brief true, if rows of each time step are grouped by DATA_DESC_ID and FIELD_ID
+  /// @details See TimeStepIterator for details.
+  bool itsGroupRows;
+
+  /// @brief maximum number of bytes of the bulk data per chunk, zero means no restriction
+  size_t itsChunkMemoryBudget;
+
+  /// @brief maximum number of rows per chunk for each DATA_DESC_ID, derived from the budget
+  mutable std::map<casacore::Int, casacore::uInt> itsBudgetChunkSizes;
+
+  /// @brief format of the reduced precision visibilities
+  CompactVisibilityCube::Format itsCompactVisibilityFormat;
+
+  /// @brief permutation of rows putting them in the time order, empty pointer to
+  /// visit rows in the order they are stored
+  boost::shared_ptr<TimeOrderPermutation const> itsTimeOrder;
+
+  /// @brief I/O and cache statistics, empty pointer if they are not collected
+  boost::shared_ptr<IteratorStatistics> itsStatistics;
+
+  /// @brief quality control statistics, empty pointer if they are not collected
+  boost::shared_ptr<QCStatistics> itsQCStatistics;
+
+  /// @brief custom allocator of the data buffers, empty pointer for the default allocation
+  boost::shared_ptr<IBufferAllocator> itsBufferAllocator;
+
+  /// @brief set of CPUs the iterator is bound to, empty if not bound
+  ThreadAffinity itsAffinity;
 };
 
 
@@ -29,15 +29,29 @@
 /// @author Max Voronkov <maxim.voronkov@csiro.au>
 ///
 
+/// ASKAPsoft includes
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+
 /// boost includes
 #include <boost/shared_ptr.hpp>
 
+/// casa includes
+#include <casacore/tables/DataMan/TSMOption.h>
+
+/// system includes
+#include <unistd.h>
+
 /// own includes
 #include <askap/dataaccess/TableConstDataSource.h>
 #include <askap/dataaccess/TableConstDataIterator.h>
 #include <askap/dataaccess/TableDataSelector.h>
 #include <askap/dataaccess/BasicDataConverter.h>
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/TableLocking.h>
+#include <askap/dataaccess/ThreadAffinity.h>
+
+ASKAP_LOGGER(logger, ".dataaccess");
 
 using namespace askap;
 using namespace askap::accessors;
@@ -49,11 +63,18 @@ using namespace casa;
 /// @param[in] fname file name of the measurement set to use
 /// @param[in] dataColumn a name of the data column used by default
 ///                       (default is DATA)
+/// @param[in] memoryMapped if true, columns stored with tiled storage managers
+///            are accessed via memory-mapped files (see openTable)
+/// @param[in] lock table locking options, e.g. NoLocking avoids the lock-file
+///            traffic for read-only jobs (see TableLocking)
 TableConstDataSource::TableConstDataSource(const std::string &fname,
-               const std::string &dataColumn) :
-         TableInfoAccessor(casacore::Table(fname), false, dataColumn),
+               const std::string &dataColumn, bool memoryMapped, const casacore::TableLock &lock) :
+         TableInfoAccessor(openTable(fname, casacore::Table::Old, memoryMapped, lock), false, dataColumn),
          itsUVWCacheSize(1), itsUVWCacheTolerance(1e-6),
-         itsMaxChunkSize(INT_MAX) {}
+         itsMaxChunkSize(INT_MAX), itsNativeLayout(false), itsPrefetch(false),
+         itsSkipFlaggedRows(false), itsMaxChannels(0), itsParallacticAngleInterval(0.),
+         itsUseRowIndex(false), itsFrequencyFrameTolerance(0.), itsGroupRows(false),
+         itsChunkMemoryBudget(0), itsCompactVisibilityFormat(CompactVisibilityCube::COMPLEX_INT16) {}
 
 /// @brief configure restriction on the chunk size
 /// @param[in] maxNumRows maximum number of rows wanted
@@ -65,6 +86,177 @@ void TableConstDataSource::configureMaxChunkSize(casacore::uInt maxNumRows)
    itsMaxChunkSize = maxNumRows;
 }
 
+/// @brief configure the memory budget of a chunk
+/// @details The right number of rows per chunk depends on the number of channels and
+/// polarisations and on the fields used. If a positive budget is set, the maximum number
+/// of rows is derived for each DATA_DESC_ID from the number of channels and polarisations
+/// of the spectral setup and the bulk fields required via the selector (visibility, flag,
+/// noise and uvw; all of them if nothing has been declared), so the data of a chunk take
+/// no more than the given number of bytes (but the chunk has at least one row). The limit
+/// set by configureMaxChunkSize still applies. The number of rows follows changes of the 
+/// spectral setup during the iteration. For example, lastLevelCacheSize can be given to
+/// keep chunks in the cache.
+/// @param[in] maxBytes maximum number of bytes per chunk, zero means no restriction
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureChunkMemoryBudget(size_t maxBytes)
+{
+  itsChunkMemoryBudget = maxBytes;
+}
+
+/// @brief size of the last level cache of the processor
+/// @details This is a helper for configureChunkMemoryBudget. The size of the level 3 
+/// cache is returned if it is known, otherwise the size of the level 2 cache.
+/// @return number of bytes, zero if the cache size can't be obtained
+size_t TableConstDataSource::lastLevelCacheSize()
+{
+  long cacheSize = -1;
+  #ifdef _SC_LEVEL3_CACHE_SIZE
+  cacheSize = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  #endif
+  #ifdef _SC_LEVEL2_CACHE_SIZE
+  if (cacheSize <= 0) {
+      cacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  }
+  #endif
+  return cacheSize > 0 ? size_t(cacheSize) : 0;
+}
+
+/// @brief configure the primary layout of the data cubes
+/// @details By default, visibility, flag and noise cubes are read from the table
+/// directly into the accessor order (nRow x nChannel x nPol). If the native layout
+/// is switched on, the cubes are read in the storage order (nPol x nChannel x nRow)
+/// and made available via INativeLayoutDataAccessor without any transpose. The cubes
+/// in the accessor order are then derived from the native ones on demand.
+/// @param[in] nativeLayout true to make the storage order primary
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureNativeLayout(bool nativeLayout)
+{
+  itsNativeLayout = nativeLayout;
+}
+
+/// @brief configure the background read-ahead
+/// @details If switched on, visibility, flag, noise and uvw data for the next chunk
+/// are read in a separate thread while the current chunk is being processed. The
+/// read-ahead is started when the visibilities of the current chunk are obtained
+/// from the accessor. Only read-only iterators support this mode.
+/// @param[in] prefetch true to read the next chunk in the background
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configurePrefetch(bool prefetch)
+{
+  itsPrefetch = prefetch;
+}
+
+/// @brief get a number of iterators over disjoint parts of the dataset
+/// @details This method splits the selected data into the given number of
+/// partitions and creates a separate iterator for each of them. Items (feeds,
+/// baselines or spectral windows) are distributed between partitions in a 
+/// round-robin fashion. Each iterator has its own table iterator and caches,
+/// while the table manager (and therefore subtable handlers) is shared. The
+/// iterators are independent and can be driven from different threads, provided
+/// each iterator is used by one thread only. On NUMA machines partitions can be 
+/// bound to nodes in a round-robin fashion (see TableConstDataIterator::setAffinity):
+/// the background reader of each iterator runs on the CPUs of its node and the data
+/// buffers are allocated and first touched there. The thread consuming the partition
+/// should pin itself to the same node by calling affinity().apply() for its iterator.
+/// @param[in] sel a shared pointer to the selector object defining 
+///            which subset of the data is used (it is not changed)
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @param[in] type type of partitioning
+/// @param[in] nPartitions number of partitions (and iterators)
+/// @param[in] numaAware if true, partitions are bound to NUMA nodes (it has no effect
+///            if the node layout is not available, e.g. on non-Linux systems)
+/// @return a vector of shared pointers to iterators, one per partition (some
+/// of them can be empty, i.e. be at the end from the start)
+std::vector<boost::shared_ptr<IConstDataIterator> >
+TableConstDataSource::createPartitionedIterators(const IDataSelectorConstPtr &sel,
+              const IDataConverterConstPtr &conv, PartitionType type,
+              casacore::uInt nPartitions, bool numaAware) const
+{
+   ASKAPCHECK(nPartitions > 0, "Number of partitions should be a positive number");
+   std::vector<boost::shared_ptr<IConstDataIterator> > result;
+   result.reserve(nPartitions);
+   const casacore::uInt nNodes = numaAware ? ThreadAffinity::numberOfNumaNodes() : 1;
+   for (casacore::uInt part = 0; part < nPartitions; ++part) {
+        result.push_back(createConstIterator(partitionSelector(sel, type, part, nPartitions), conv));
+        if (nNodes > 1) {
+            const boost::shared_ptr<TableConstDataIterator> tabIt =
+                  boost::dynamic_pointer_cast<TableConstDataIterator>(result.back());
+            ASKAPDEBUGASSERT(tabIt);
+            tabIt->setAffinity(ThreadAffinity::ofNumaNode(part % nNodes));
+        }
+   }
+   return result;
+}
+
+/// @brief selector for one partition of the data
+/// @details This is a helper method for the partitioned iteration, see
+/// createPartitionedIterators.
+/// @param[in] sel a shared pointer to the user's selector (it is not changed)
+/// @param[in] type type of partitioning
+/// @param[in] part partition number
+/// @param[in] nPartitions number of partitions
+/// @return a copy of the user's selector with the partition constraint added
+IDataSelectorConstPtr TableConstDataSource::partitionSelector(const IDataSelectorConstPtr &sel,
+              PartitionType type, casacore::uInt part, casacore::uInt nPartitions)
+{
+   boost::shared_ptr<TableDataSelector const> tabSel =
+           boost::dynamic_pointer_cast<TableDataSelector const>(sel);
+   if (!tabSel) {
+       ASKAPTHROW(DataAccessLogicError, "Incompatible selector is received by "
+                  "the createPartitionedIterators method");
+   }
+   boost::shared_ptr<TableDataSelector> partSel(new TableDataSelector(*tabSel));
+   switch (type) {
+      case FEED_PARTITION:
+           partSel->chooseFeedPartition(part, nPartitions);
+           break;
+      case BASELINE_PARTITION:
+           partSel->chooseBaselinePartition(part, nPartitions);
+           break;
+      case SPECTRAL_WINDOW_PARTITION:
+           partSel->chooseSpectralWindowPartition(part, nPartitions);
+           break;
+      default:
+           ASKAPTHROW(DataAccessLogicError, "Unknown partition type "<<type);
+   }
+   return partSel;
+}
+
+/// @brief configure skipping of the rows flagged as a whole
+/// @details If switched on, rows with FLAG_ROW set are not read from the data
+/// and flag columns. Visibilities of such rows are set to zero and all their flags
+/// are set. The rows which contain data are available via IFlaggedRowDataAccessor,
+/// so the consumer doesn't need to iterate over the flagged ones. Only read-only 
+/// iterators support this mode.
+/// @param[in] skip true to skip reading rows flagged as a whole
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureSkipFlaggedRows(bool skip)
+{
+  itsSkipFlaggedRows = skip;
+}
+
+/// @brief configure the split of the spectral axis
+/// @details By default, all selected channels are delivered in one accessor and the
+/// chunks are only split along rows (see configureMaxChunkSize). For wide-band data
+/// the chunk may be too large even for a single row per time step. If a positive number
+/// of channels is set by this method, each chunk of rows is delivered by a number of
+/// consecutive iterations, each with at most the given number of channels. All channel 
+/// tiles of the chunk are walked through before the iterator moves to the next rows. Only 
+/// channels of the current tile are read from the table. Only read-only iterators support
+/// this mode, the background read-ahead is not done if the spectral axis is split.
+/// @param[in] maxChannels maximum number of channels per accessor, zero means no restriction
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureMaxChannels(casacore::uInt maxChannels)
+{
+  itsMaxChannels = maxChannels;
+}
+
 /// @brief configure caching of the uvw-machines
 /// @details A number of uvw machines can be cached at the same time. This can
 /// result in a significant performance improvement in the mosaicing case. By default
@@ -82,6 +274,254 @@ void TableConstDataSource::configureUVWMachineCache(size_t cacheSize, double tol
   itsUVWCacheTolerance = tolerance;
 }
 
+/// @brief configure the store of rotated uvws
+/// @details Imaging makes a number of passes over the same data (major cycles). By 
+/// default, rotated uvws and associated delays are recalculated for each pass as the 
+/// accessor only caches them while the iterator stays at the same chunk. If the store
+/// is switched on, the rotation results are kept in memory (up to the given number of
+/// bytes) and all iterators created afterwards take them from there, if the same chunk
+/// of the measurement set is accessed again for the same tangent point. Chunks are
+/// identified by the row numbers, i.e. all iterators are assumed to use the same data 
+/// converter (uvw and pointing directions shouldn't depend on the iterator). The current 
+/// tolerance of the uvw machine cache is used to compare tangent points.
+/// @param[in] maxBytes maximum number of bytes to hold, zero switches the store off
+/// @note A new store is created by each call, the results held by the old one are not
+/// available to the iterators created afterwards
+void TableConstDataSource::configureRotatedUVWStore(size_t maxBytes)
+{
+  if (maxBytes > 0) {
+      itsRotatedUVWStore.reset(new RotatedUVWStore(maxBytes, itsUVWCacheTolerance));
+  } else {
+      itsRotatedUVWStore.reset();
+  }
+}
+
+/// @brief configure the interpolation of parallactic angles
+/// @details Parallactic angles of alt-az antennas are recomputed for every new time.
+/// The reference direction is converted to the hour angle and declination once per time 
+/// step for the whole array. If a positive interval is set by this method, the conversion is
+/// reused for the following time steps (while the reference direction is the same) and the 
+/// hour angle is advanced at the sidereal rate. The error grows with the interval
+/// mainly due to the change of aberration, it is small for intervals up to a few minutes.
+/// @param[in] interval maximum time difference in seconds, zero means exact computation
+/// for every time step
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureParallacticAngleInterpolation(double interval)
+{
+  ASKAPCHECK(interval >= 0., "Interpolation interval for parallactic angles should be non-negative, you have "<<
+             interval);
+  itsParallacticAngleInterval = interval;
+}
+
+/// @brief configure the row index based selection
+/// @details By default, the selection is done via table expressions, which are evaluated
+/// for every row of the measurement set each time an iterator is created. If the row index
+/// is switched on, selection by feed, baseline, antenna, spectral window and time range
+/// is resolved via the index of TIME, FEED, ANTENNA and DATA_DESC_ID columns. The index is
+/// built once per measurement set when the first iterator using it is created and is
+/// shared afterwards. Selections involving other columns are still done via table expressions.
+/// @param[in] useRowIndex if true, the row index is used where possible
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureRowIndex(bool useRowIndex)
+{
+  itsUseRowIndex = useRowIndex;
+}
+
+/// @brief configure the reuse of the converted frequency axis
+/// @details If the frequency frame requested via the converter differs from the 
+/// frame of the SPECTRAL_WINDOW subtable, the frequency axis is converted for every
+/// new time (with one measures conversion per spectral window). If a positive
+/// tolerance is set, the converted axis is reused while the time changes by no more
+/// than the given interval (and the spectral window and reference direction stay the same).
+/// @param[in] tolerance maximum time difference in seconds, zero means conversion 
+/// for every time step
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureFrequencyFrameTolerance(double tolerance)
+{
+  ASKAPCHECK(tolerance >= 0., "Tolerance for the frequency frame should be non-negative, you have "<<
+             tolerance);
+  itsFrequencyFrameTolerance = tolerance;
+}
+
+/// @brief configure the row grouping within time steps
+/// @details Chunks of rows delivered by the iterator have the same DATA_DESC_ID and
+/// FIELD_ID, a chunk is broken wherever these columns change within a time step. If
+/// spectral windows or fields are interleaved row by row, chunks collapse to a few rows.
+/// If the grouping is switched on, rows of each time step are permuted (via a reference 
+/// table) so the rows with the same DATA_DESC_ID and FIELD_ID follow each other and chunks
+/// are only limited by the maximum chunk size. The order of rows within each group is 
+/// preserved. Only read-only iterators support this mode.
+/// @param[in] group true to group rows of each time step
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureRowGrouping(bool group)
+{
+  itsGroupRows = group;
+}
+
+/// @brief configure the time ordering of rows
+/// @details Iterators go through time steps in the order of rows, which is only the
+/// time order if the measurement set has been written this way. If the time ordering
+/// is switched on and the TIME column is not monotonic, the permutation of rows 
+/// putting the main table in the time order is built by this method (see 
+/// TimeOrderPermutation), and iterators created afterwards visit the selected rows
+/// in the time order via a reference table. This avoids re-sorting (i.e. copying) 
+/// the dataset, but the rows are not read sequentially. If a file name is given, the 
+/// permutation is taken from this file if it is valid for the measurement set, 
+/// otherwise the permutation is built and stored in the file for future use 
+/// (e.g. next to the measurement set). Nothing is done if the measurement set is
+/// already in the time order. Only read-only iterators support this mode.
+/// @param[in] order true to visit rows in the time order
+/// @param[in] fileName name of the file to keep the permutation (empty string means
+/// the permutation is not stored)
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureTimeOrdering(bool order, const std::string &fileName)
+{
+  itsTimeOrder.reset();
+  if (!order) {
+      return;
+  }
+  if (fileName != "") {
+      itsTimeOrder = TimeOrderPermutation::load(fileName, table());
+      if (itsTimeOrder) {
+          ASKAPLOG_INFO_STR(logger, "Rows of "<<table().tableName()<<
+                            " will be visited in the time order given by "<<fileName);
+          return;
+      }
+  }
+  // the TIME column is read once and shared with the time index
+  const TimeColumnIndex &timeIndex = subtableInfo().getTimeIndex();
+  if (timeIndex.timeOrdered()) {
+      ASKAPLOG_INFO_STR(logger, "Rows of "<<table().tableName()<<" are already in the time order");
+      return;
+  }
+  ASKAPLOG_INFO_STR(logger, "Sorting "<<timeIndex.nrow()<<" rows of "<<table().tableName()<<
+                    " by time");
+  const boost::shared_ptr<TimeOrderPermutation> permutation(new TimeOrderPermutation(timeIndex.time()));
+  if (fileName != "") {
+      try {
+         permutation->save(fileName, table());
+         ASKAPLOG_INFO_STR(logger, "Time order permutation has been stored in "<<fileName);
+      }
+      catch (const AskapError &ae) {
+         // the permutation can still be used, it will be rebuilt next time
+         ASKAPLOG_WARN_STR(logger, "Unable to store the time order permutation: "<<ae.what());
+      }
+  }
+  itsTimeOrder = permutation;
+}
+
+/// @brief configure collection of the I/O and cache statistics
+/// @details If switched on, all iterators created afterwards update the same
+/// statistics object (see IteratorStatistics), which is available via the statistics
+/// method (e.g. to write it into the log at the end of the job). Switching the collection
+/// on again starts a new object, switching it off doesn't affect the iterators already
+/// created.
+/// @param[in] collect true to collect the statistics
+void TableConstDataSource::configureStatistics(bool collect)
+{
+  if (collect) {
+      itsStatistics.reset(new IteratorStatistics);
+  } else {
+      itsStatistics.reset();
+  }
+}
+
+/// @brief configure collection of the quality control statistics
+/// @details If switched on, all iterators created afterwards accumulate the flagged
+/// fraction, amplitude statistics and the number of NaNs per baseline, beam and channel
+/// in the same object (see QCStatistics) while the visibilities are read, so QC needs no
+/// separate pass over the data. The object is available via the qcStatistics method.
+/// Switching the collection on again starts a new object, switching it off doesn't affect
+/// the iterators already created.
+/// @param[in] collect true to collect the statistics
+void TableConstDataSource::configureQCStatistics(bool collect)
+{
+  if (collect) {
+      itsQCStatistics.reset(new QCStatistics);
+  } else {
+      itsQCStatistics.reset();
+  }
+}
+
+/// @brief configure the format of the reduced precision visibilities
+/// @details Table-based accessors implement ICompactVisibilityDataAccessor, which gives 
+/// visibilities with 16-bit real and imaginary parts. They are only formed if requested,
+/// this method chooses their format (COMPLEX_INT16 with a scale per row by default).
+/// @param[in] format format of the compact visibilities
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureCompactVisibility(CompactVisibilityCube::Format format)
+{
+  itsCompactVisibilityFormat = format;
+}
+
+/// @brief configure a custom allocator of the data buffers
+/// @details By default, visibility, flag and noise cubes are filled into ordinary
+/// casacore arrays. If an allocator is set, read-only iterators created afterwards 
+/// take the storage for these cubes from it (see TableConstDataIterator::setBufferAllocator),
+/// e.g. page-locked host memory, so the data can be copied to a GPU by DMA without an
+/// intermediate copy. Cubes obtained from the accessor are only valid while the
+/// iterator exists (and until the buffers are released), the storage is returned
+/// to the allocator afterwards.
+/// @param[in] allocator shared pointer to the allocator, an empty pointer restores the
+/// default allocation
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureBufferAllocator(const boost::shared_ptr<IBufferAllocator> &allocator)
+{
+  itsBufferAllocator = allocator;
+}
+
+/// @brief load the subtables 
+/// @details Subtables (data description, spectral window, polarisation, feed, field and 
+/// antenna) are normally read on demand when the first iterator needs them. This method 
+/// reads them immediately. It is handy if a number of data sources are opened in parallel 
+/// (see MultiTableDataSource), so the latency of reading subtables is not paid sequentially
+/// later on.
+void TableConstDataSource::loadSubtables() const
+{
+  const ISubtableInfoHolder &info = subtableInfo();
+  info.getDataDescription();
+  info.getSpWindow();
+  info.getPolarisation();
+  info.getFeed();
+  info.getField();
+  info.getAntenna();
+}
+
+/// @brief load the subtables using a snapshot file
+/// @details Processing of the subtables can take a noticeable time for large measurement
+/// sets. This method restores the processed subtables (except FEED, see 
+/// SubtableInfoHolder::saveSnapshot) from a snapshot file if it exists and is still valid
+/// for this measurement set. Otherwise, the subtables are loaded as in loadSubtables and 
+/// a new snapshot is written, so the next job using the same measurement set starts faster.
+/// Failure to write the snapshot (e.g. a read-only directory) is not an error.
+/// @param[in] fileName name of the snapshot file, an empty string means the measurement
+/// set name with the ".subtables" suffix (i.e. the file is next to the measurement set)
+/// @return true if the subtables have been restored from the snapshot
+bool TableConstDataSource::loadSubtableSnapshot(const std::string &fileName) const
+{
+  const std::string snapshotName = fileName != "" ? fileName : std::string(table().tableName()) + ".subtables";
+  const ISubtableInfoHolder &info = subtableInfo();
+  if (info.loadSnapshot(snapshotName)) {
+      ASKAPLOG_DEBUG_STR(logger, "Subtables of "<<table().tableName()<<" have been restored from "<<snapshotName);
+      return true;
+  }
+  loadSubtables();
+  try {
+     info.saveSnapshot(snapshotName);
+  }
+  catch (const std::exception &ex) {
+     ASKAPLOG_WARN_STR(logger, "Unable to write the subtable snapshot: "<<ex.what());
+  }
+  return false;
+}
+
 /// construct a part of the read only object for use in the
 /// derived classes
 /// @note Due to virtual inheritance, TableInfoAccessor will be initialized
@@ -90,7 +530,35 @@ void TableConstDataSource::configureUVWMachineCache(size_t cacheSize, double tol
 TableConstDataSource::TableConstDataSource() :
          TableInfoAccessor(boost::shared_ptr<ITableManager const>()),
          itsUVWCacheSize(1), itsUVWCacheTolerance(1e-6),
-         itsMaxChunkSize(INT_MAX) {} 
+         itsMaxChunkSize(INT_MAX), itsNativeLayout(false), itsPrefetch(false),
+         itsSkipFlaggedRows(false), itsMaxChannels(0), itsParallacticAngleInterval(0.),
+         itsUseRowIndex(false), itsFrequencyFrameTolerance(0.), itsGroupRows(false),
+         itsChunkMemoryBudget(0), itsCompactVisibilityFormat(CompactVisibilityCube::COMPLEX_INT16) {} 
+
+/// @brief open the measurement set
+/// @details By default, the storage managers read the data through their own 
+/// bucket cache, i.e. the data are copied from the file into the cache and then 
+/// into the buffer of the accessor. If the memory mapping is requested, columns 
+/// stored with tiled storage managers (e.g. TiledShapeStMan, which is normally used 
+/// for the visibility data) are accessed via memory-mapped files instead. This 
+/// avoids the intermediate copy and leaves caching to the operating system, which 
+/// helps when the same measurement set is read many times (e.g. in major cycles). 
+/// Columns handled by other storage managers are read in the usual way.
+/// @param[in] fname file name of the measurement set to use
+/// @param[in] option table option (e.g. casacore::Table::Old or casacore::Table::Update)
+/// @param[in] memoryMapped true to use memory-mapped access where possible
+/// @param[in] lock table locking options (see TableLocking)
+/// @return table object
+casacore::Table TableConstDataSource::openTable(const std::string &fname, 
+                casacore::Table::TableOption option, bool memoryMapped,
+                const casacore::TableLock &lock)
+{
+  if (memoryMapped) {
+      // this option is ignored by storage managers other than the tiled ones
+      return TableLocking::open(fname, lock, option, casacore::TSMOption(casacore::TSMOption::MMap));
+  }
+  return TableLocking::open(fname, lock, option);
+}
 
 /// create a converter object corresponding to this type of the
 /// DataSource. The user can change converting policies (units,
@@ -143,9 +611,23 @@ TableConstDataSource::createConstIterator(const IDataSelectorConstPtr &sel,
        ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
                  "converter are received by the createConstIterator method");
    }
-   return boost::shared_ptr<IConstDataIterator>(new TableConstDataIterator(
+   boost::shared_ptr<TableConstDataIterator> it(new TableConstDataIterator(
                 getTableManager(),implSel,implConv,uvwMachineCacheSize(), uvwMachineCacheTolerance(),
-                maxChunkSize()));
+                maxChunkSize(), nativeLayout(), prefetch(),
+                skipFlaggedRows(), maxChannels(), rotatedUVWStore(),
+                parallacticAngleInterval(), useRowIndex(), frequencyFrameTolerance(),
+                groupRows(), chunkMemoryBudget(), timeOrder()));
+   if (statistics()) {
+       it->setStatistics(statistics());
+   }
+   if (qcStatistics()) {
+       it->setQCStatistics(qcStatistics());
+   }
+   it->setCompactVisibilityFormat(compactVisibilityFormat());
+   if (bufferAllocator()) {
+       it->setBufferAllocator(bufferAllocator());
+   }
+   return it;
 }
 
 /// create a selector object corresponding to this type of the
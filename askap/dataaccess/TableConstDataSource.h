@@ -37,13 +37,21 @@
 
 // casa includes
 #include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableLock.h>
 
 // own includes
 #include <askap/dataaccess/IConstDataSource.h>
 #include <askap/dataaccess/TableInfoAccessor.h>
+#include <askap/dataaccess/RotatedUVWStore.h>
+#include <askap/dataaccess/IteratorStatistics.h>
+#include <askap/dataaccess/QCStatistics.h>
+#include <askap/dataaccess/CompactVisibilityCube.h>
+#include <askap/dataaccess/IBufferAllocator.h>
+#include <askap/dataaccess/TimeOrderPermutation.h>
 
 // std includes
 #include <string>
+#include <vector>
 
 namespace askap {
 
@@ -58,14 +66,31 @@ class TableConstDataSource : virtual public IConstDataSource,
                              virtual protected TableInfoAccessor
 {
 public:
+  /// @brief type of partitioning for the parallel iteration
+  /// @details See createPartitionedIterators
+  enum PartitionType {
+     /// partition by feed (beam), FEED1 column is used
+     FEED_PARTITION = 0,
+     /// partition by baseline
+     BASELINE_PARTITION,
+     /// partition by spectral window
+     SPECTRAL_WINDOW_PARTITION
+  };
+
   /// @brief construct a read-only data source object
   /// @details All iterators obtained from this object will be read-only
   /// iterators.
   /// @param[in] fname file name of the measurement set to use
   /// @param[in] dataColumn a name of the data column used by default
   ///                       (default is DATA)
+  /// @param[in] memoryMapped if true, columns stored with tiled storage managers
+  ///            are accessed via memory-mapped files (see openTable)
+  /// @param[in] lock table locking options, e.g. NoLocking avoids the lock-file
+  ///            traffic for read-only jobs (see TableLocking)
   explicit TableConstDataSource(const std::string &fname, 
-                                const std::string &dataColumn = "DATA");
+                                const std::string &dataColumn = "DATA",
+                                bool memoryMapped = false,
+                                const casacore::TableLock &lock = casacore::TableLock());
   
   /// create a converter object corresponding to this type of the
   /// DataSource. The user can change converting policies (units,
@@ -107,6 +132,32 @@ public:
   
   // we need this to get access to the overloaded syntax in the base class 
   using IConstDataSource::createConstIterator;
+
+  /// @brief get a number of iterators over disjoint parts of the dataset
+  /// @details This method splits the selected data into the given number of
+  /// partitions and creates a separate iterator for each of them. Items (feeds,
+  /// baselines or spectral windows) are distributed between partitions in a 
+  /// round-robin fashion. Each iterator has its own table iterator and caches,
+  /// while the table manager (and therefore subtable handlers) is shared. The
+  /// iterators are independent and can be driven from different threads, provided
+  /// each iterator is used by one thread only. On NUMA machines partitions can be 
+  /// bound to nodes in a round-robin fashion (see TableConstDataIterator::setAffinity):
+  /// the background reader of each iterator runs on the CPUs of its node and the data
+  /// buffers are allocated and first touched there. The thread consuming the partition
+  /// should pin itself to the same node by calling affinity().apply() for its iterator.
+  /// @param[in] sel a shared pointer to the selector object defining 
+  ///            which subset of the data is used (it is not changed)
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @param[in] type type of partitioning
+  /// @param[in] nPartitions number of partitions (and iterators)
+  /// @param[in] numaAware if true, partitions are bound to NUMA nodes (it has no effect
+  ///            if the node layout is not available, e.g. on non-Linux systems)
+  /// @return a vector of shared pointers to iterators, one per partition (some
+  /// of them can be empty, i.e. be at the end from the start)
+  std::vector<boost::shared_ptr<IConstDataIterator> > createPartitionedIterators(
+             const IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv,
+             PartitionType type, casacore::uInt nPartitions, bool numaAware = false) const;
  
   /// create a selector object corresponding to this type of the
   /// DataSource
@@ -143,12 +194,269 @@ public:
   /// @note The new restriction will apply to any iterator created in the future, but will not
   /// affect iterators already created
   void configureMaxChunkSize(casacore::uInt maxNumRows);
+
+  /// @brief configure the memory budget of a chunk
+  /// @details The right number of rows per chunk depends on the number of channels and
+  /// polarisations and on the fields used. If a positive budget is set, the maximum number
+  /// of rows is derived for each DATA_DESC_ID from the number of channels and polarisations
+  /// of the spectral setup and the bulk fields required via the selector (visibility, flag,
+  /// noise and uvw; all of them if nothing has been declared), so the data of a chunk take
+  /// no more than the given number of bytes (but the chunk has at least one row). The limit
+  /// set by configureMaxChunkSize still applies. The number of rows follows changes of the 
+  /// spectral setup during the iteration. For example, lastLevelCacheSize can be given to
+  /// keep chunks in the cache.
+  /// @param[in] maxBytes maximum number of bytes per chunk, zero means no restriction
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureChunkMemoryBudget(size_t maxBytes = 0);
+
+  /// @brief size of the last level cache of the processor
+  /// @details This is a helper for configureChunkMemoryBudget. The size of the level 3 
+  /// cache is returned if it is known, otherwise the size of the level 2 cache.
+  /// @return number of bytes, zero if the cache size can't be obtained
+  static size_t lastLevelCacheSize();
+
+  /// @brief configure the primary layout of the data cubes
+  /// @details By default, visibility, flag and noise cubes are read from the table
+  /// directly into the accessor order (nRow x nChannel x nPol). If the native layout
+  /// is switched on, the cubes are read in the storage order (nPol x nChannel x nRow)
+  /// and made available via INativeLayoutDataAccessor without any transpose. The cubes
+  /// in the accessor order are then derived from the native ones on demand.
+  /// @param[in] nativeLayout true to make the storage order primary
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureNativeLayout(bool nativeLayout = true);
+
+  /// @brief configure the background read-ahead
+  /// @details If switched on, visibility, flag, noise and uvw data for the next chunk
+  /// are read in a separate thread while the current chunk is being processed. The
+  /// read-ahead is started when the visibilities of the current chunk are obtained
+  /// from the accessor. Only read-only iterators support this mode.
+  /// @param[in] prefetch true to read the next chunk in the background
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configurePrefetch(bool prefetch = true);
+
+  /// @brief configure skipping of the rows flagged as a whole
+  /// @details If switched on, rows with FLAG_ROW set are not read from the data
+  /// and flag columns. Visibilities of such rows are set to zero and all their flags
+  /// are set. The rows which contain data are available via IFlaggedRowDataAccessor,
+  /// so the consumer doesn't need to iterate over the flagged ones. Only read-only 
+  /// iterators support this mode.
+  /// @param[in] skip true to skip reading rows flagged as a whole
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureSkipFlaggedRows(bool skip = true);
+
+  /// @brief configure the split of the spectral axis
+  /// @details By default, all selected channels are delivered in one accessor and the
+  /// chunks are only split along rows (see configureMaxChunkSize). For wide-band data
+  /// the chunk may be too large even for a single row per time step. If a positive number
+  /// of channels is set by this method, each chunk of rows is delivered by a number of
+  /// consecutive iterations, each with at most the given number of channels. All channel 
+  /// tiles of the chunk are walked through before the iterator moves to the next rows. Only 
+  /// channels of the current tile are read from the table. Only read-only iterators support
+  /// this mode, the background read-ahead is not done if the spectral axis is split.
+  /// @param[in] maxChannels maximum number of channels per accessor, zero means no restriction
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureMaxChannels(casacore::uInt maxChannels = 0);
+
+  /// @brief configure the store of rotated uvws
+  /// @details Imaging makes a number of passes over the same data (major cycles). By 
+  /// default, rotated uvws and associated delays are recalculated for each pass as the 
+  /// accessor only caches them while the iterator stays at the same chunk. If the store
+  /// is switched on, the rotation results are kept in memory (up to the given number of
+  /// bytes) and all iterators created afterwards take them from there, if the same chunk
+  /// of the measurement set is accessed again for the same tangent point. Chunks are
+  /// identified by the row numbers, i.e. all iterators are assumed to use the same data 
+  /// converter (uvw and pointing directions shouldn't depend on the iterator). The current 
+  /// tolerance of the uvw machine cache is used to compare tangent points.
+  /// @param[in] maxBytes maximum number of bytes to hold, zero switches the store off
+  /// @note A new store is created by each call, the results held by the old one are not
+  /// available to the iterators created afterwards
+  void configureRotatedUVWStore(size_t maxBytes = RotatedUVWStore::DEFAULT_MEMORY_LIMIT);
+
+  /// @brief configure the interpolation of parallactic angles
+  /// @details Parallactic angles of alt-az antennas are recomputed for every new time.
+  /// The reference direction is converted to the hour angle and declination once per time 
+  /// step for the whole array. If a positive interval is set by this method, the conversion is
+  /// reused for the following time steps (while the reference direction is the same) and the 
+  /// hour angle is advanced at the sidereal rate. The error grows with the interval
+  /// mainly due to the change of aberration, it is small for intervals up to a few minutes.
+  /// @param[in] interval maximum time difference in seconds, zero means exact computation
+  /// for every time step
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureParallacticAngleInterpolation(double interval = 0.);
+
+  /// @brief configure the row index based selection
+  /// @details By default, the selection is done via table expressions, which are evaluated
+  /// for every row of the measurement set each time an iterator is created. If the row index
+  /// is switched on, selection by feed, baseline, antenna, spectral window and time range
+  /// is resolved via the index of TIME, FEED, ANTENNA and DATA_DESC_ID columns. The index is
+  /// built once per measurement set when the first iterator using it is created and is
+  /// shared afterwards. This pays off if many iterators with different selections are created
+  /// for a large measurement set. Selections involving other columns are still done via
+  /// table expressions.
+  /// @param[in] useRowIndex if true, the row index is used where possible
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureRowIndex(bool useRowIndex = true);
+
+  /// @brief configure the reuse of the converted frequency axis
+  /// @details If the frequency frame requested via the converter differs from the 
+  /// frame of the SPECTRAL_WINDOW subtable, the frequency axis is converted for every
+  /// new time (all channels are scaled by the same Doppler factor, so this is done with
+  /// one measures conversion per spectral window). If a positive tolerance is set, 
+  /// the converted axis is reused while the time changes by no more than the given 
+  /// interval (and the spectral window and reference direction stay the same). The 
+  /// Doppler factor changes slowly (mainly due to the Earth rotation), so intervals
+  /// of a few minutes are normally acceptable.
+  /// @param[in] tolerance maximum time difference in seconds, zero means conversion 
+  /// for every time step
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureFrequencyFrameTolerance(double tolerance = 0.);
+
+  /// @brief configure the row grouping within time steps
+  /// @details Chunks of rows delivered by the iterator have the same DATA_DESC_ID and
+  /// FIELD_ID, a chunk is broken wherever these columns change within a time step. If
+  /// spectral windows or fields are interleaved row by row, chunks collapse to a few rows.
+  /// If the grouping is switched on, rows of each time step are permuted (via a reference 
+  /// table) so the rows with the same DATA_DESC_ID and FIELD_ID follow each other and chunks
+  /// are only limited by the maximum chunk size. The order of rows within each group is 
+  /// preserved. Only read-only iterators support this mode.
+  /// @param[in] group true to group rows of each time step
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureRowGrouping(bool group = true);
+
+  /// @brief configure the time ordering of rows
+  /// @details Iterators go through time steps in the order of rows, which is only the
+  /// time order if the measurement set has been written this way. If the time ordering
+  /// is switched on and the TIME column is not monotonic, the permutation of rows 
+  /// putting the main table in the time order is built by this method (see 
+  /// TimeOrderPermutation), and iterators created afterwards visit the selected rows
+  /// in the time order via a reference table. This avoids re-sorting (i.e. copying) 
+  /// the dataset, but the rows are not read sequentially. If a file name is given, the 
+  /// permutation is taken from this file if it is valid for the measurement set, 
+  /// otherwise the permutation is built and stored in the file for future use 
+  /// (e.g. next to the measurement set). Nothing is done if the measurement set is
+  /// already in the time order. Only read-only iterators support this mode.
+  /// @param[in] order true to visit rows in the time order
+  /// @param[in] fileName name of the file to keep the permutation (empty string means
+  /// the permutation is not stored)
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureTimeOrdering(bool order = true, const std::string &fileName = "");
+
+  /// @brief configure collection of the I/O and cache statistics
+  /// @details If switched on, all iterators created afterwards update the same
+  /// statistics object (see IteratorStatistics), which is available via the statistics
+  /// method (e.g. to write it into the log at the end of the job). Switching the collection
+  /// on again starts a new object, switching it off doesn't affect the iterators already
+  /// created.
+  /// @param[in] collect true to collect the statistics
+  void configureStatistics(bool collect = true);
+
+  /// @brief configure collection of the quality control statistics
+  /// @details If switched on, all iterators created afterwards accumulate the flagged
+  /// fraction, amplitude statistics and the number of NaNs per baseline, beam and channel
+  /// in the same object (see QCStatistics) while the visibilities are read, so QC needs no
+  /// separate pass over the data. The object is available via the qcStatistics method.
+  /// Switching the collection on again starts a new object, switching it off doesn't affect
+  /// the iterators already created.
+  /// @param[in] collect true to collect the statistics
+  void configureQCStatistics(bool collect = true);
+
+  /// @brief configure the format of the reduced precision visibilities
+  /// @details Table-based accessors implement ICompactVisibilityDataAccessor, which gives 
+  /// visibilities with 16-bit real and imaginary parts. They are only formed if requested,
+  /// this method chooses their format (COMPLEX_INT16 with a scale per row by default).
+  /// @param[in] format format of the compact visibilities
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureCompactVisibility(CompactVisibilityCube::Format format);
+
+  /// @brief configure a custom allocator of the data buffers
+  /// @details By default, visibility, flag and noise cubes are filled into ordinary
+  /// casacore arrays. If an allocator is set, read-only iterators created afterwards 
+  /// take the storage for these cubes from it (see TableConstDataIterator::setBufferAllocator),
+  /// e.g. page-locked host memory, so the data can be copied to a GPU by DMA without an
+  /// intermediate copy. Cubes obtained from the accessor are only valid while the
+  /// iterator exists (and until the buffers are released), the storage is returned
+  /// to the allocator afterwards.
+  /// @param[in] allocator shared pointer to the allocator, an empty pointer restores the
+  /// default allocation
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureBufferAllocator(const boost::shared_ptr<IBufferAllocator> &allocator);
+
+  /// @brief obtain the I/O and cache statistics
+  /// @return shared pointer to the statistics accumulated by the iterators of this data 
+  /// source (empty pointer if the collection is not switched on, see configureStatistics)
+  inline const boost::shared_ptr<IteratorStatistics>& statistics() const {return itsStatistics;}
+
+  /// @brief obtain the quality control statistics
+  /// @return shared pointer to the statistics accumulated by the iterators of this data 
+  /// source (empty pointer if the collection is not switched on, see configureQCStatistics)
+  inline const boost::shared_ptr<QCStatistics>& qcStatistics() const {return itsQCStatistics;}
+
+  /// @brief load the subtables 
+  /// @details Subtables (data description, spectral window, polarisation, feed, field and 
+  /// antenna) are normally read on demand when the first iterator needs them. This method 
+  /// reads them immediately. It is handy if a number of data sources are opened in parallel 
+  /// (see MultiTableDataSource), so the latency of reading subtables is not paid sequentially
+  /// later on.
+  void loadSubtables() const;
+
+  /// @brief load the subtables using a snapshot file
+  /// @details Processing of the subtables can take a noticeable time for large measurement
+  /// sets. This method restores the processed subtables (except FEED, see 
+  /// SubtableInfoHolder::saveSnapshot) from a snapshot file if it exists and is still valid
+  /// for this measurement set. Otherwise, the subtables are loaded as in loadSubtables and 
+  /// a new snapshot is written, so the next job using the same measurement set starts faster.
+  /// Failure to write the snapshot (e.g. a read-only directory) is not an error.
+  /// @param[in] fileName name of the snapshot file, an empty string means the measurement
+  /// set name with the ".subtables" suffix (i.e. the file is next to the measurement set)
+  /// @return true if the subtables have been restored from the snapshot
+  bool loadSubtableSnapshot(const std::string &fileName = "") const;
   
 protected:
   /// construct a part of the read only object for use in the
   /// derived classes
   TableConstDataSource();
+
+  /// @brief open the measurement set
+  /// @details By default, the storage managers read the data through their own 
+  /// bucket cache, i.e. the data are copied from the file into the cache and then 
+  /// into the buffer of the accessor. If the memory mapping is requested, columns 
+  /// stored with tiled storage managers (e.g. TiledShapeStMan, which is normally used 
+  /// for the visibility data) are accessed via memory-mapped files instead. This 
+  /// avoids the intermediate copy and leaves caching to the operating system, which 
+  /// helps when the same measurement set is read many times (e.g. in major cycles). 
+  /// Columns handled by other storage managers are read in the usual way.
+  /// @param[in] fname file name of the measurement set to use
+  /// @param[in] option table option (e.g. casacore::Table::Old or casacore::Table::Update)
+  /// @param[in] memoryMapped true to use memory-mapped access where possible
+  /// @param[in] lock table locking options (see TableLocking)
+  /// @return table object
+  static casacore::Table openTable(const std::string &fname, 
+                casacore::Table::TableOption option, bool memoryMapped,
+                const casacore::TableLock &lock = casacore::TableLock());
   
+  /// @brief selector for one partition of the data
+  /// @details This is a helper method for the partitioned iteration, see
+  /// createPartitionedIterators.
+  /// @param[in] sel a shared pointer to the user's selector (it is not changed)
+  /// @param[in] type type of partitioning
+  /// @param[in] part partition number
+  /// @param[in] nPartitions number of partitions
+  /// @return a copy of the user's selector with the partition constraint added
+  static IDataSelectorConstPtr partitionSelector(const IDataSelectorConstPtr &sel,
+                PartitionType type, casacore::uInt part, casacore::uInt nPartitions);
+
   /// @brief UVW machine cache size
   /// @return size of the uvw machine cache
   inline size_t uvwMachineCacheSize() const {return itsUVWCacheSize;}
@@ -160,6 +468,63 @@ protected:
   /// @brief current restriction on the chunk size
   /// @return maximum number of rows in the accessor (the current setting, affects future iterators)
   inline casacore::uInt maxChunkSize() const {return itsMaxChunkSize;}
+
+  /// @brief current setting of the primary layout
+  /// @return true, if the storage order is primary (the current setting, affects future iterators)
+  inline bool nativeLayout() const {return itsNativeLayout;}
+
+  /// @brief current setting of the background read-ahead
+  /// @return true, if the next chunk is read in the background (the current setting, affects future iterators)
+  inline bool prefetch() const {return itsPrefetch;}
+
+  /// @brief current setting of the flagged row skipping
+  /// @return true, if rows with FLAG_ROW set are not read (the current setting, affects future iterators)
+  inline bool skipFlaggedRows() const {return itsSkipFlaggedRows;}
+
+  /// @brief current restriction on the number of channels
+  /// @return maximum number of channels in the accessor, zero means no restriction 
+  /// (the current setting, affects future iterators)
+  inline casacore::uInt maxChannels() const {return itsMaxChannels;}
+
+  /// @brief store of rotated uvws
+  /// @return shared pointer to the store, empty if rotated uvws are not stored
+  inline const boost::shared_ptr<RotatedUVWStore>& rotatedUVWStore() const {return itsRotatedUVWStore;}
+
+  /// @brief current setting of the parallactic angle interpolation
+  /// @return maximum time difference in seconds for which the conversion is reused
+  /// (the current setting, affects future iterators)
+  inline double parallacticAngleInterval() const {return itsParallacticAngleInterval;}
+
+  /// @brief check whether the row index is used for selection
+  /// @return true, if the row index is used (the current setting, affects future iterators)
+  inline bool useRowIndex() const {return itsUseRowIndex;}
+
+  /// @brief current tolerance for the reuse of the converted frequency axis
+  /// @return maximum time difference in seconds (the current setting, affects future iterators)
+  inline double frequencyFrameTolerance() const {return itsFrequencyFrameTolerance;}
+
+  /// @brief current setting of the row grouping
+  /// @return true, if rows of each time step are grouped by DATA_DESC_ID and FIELD_ID
+  /// (the current setting, affects future iterators)
+  inline bool groupRows() const {return itsGroupRows;}
+
+  /// @brief current permutation of rows putting them in the time order
+  /// @return shared pointer to the permutation, empty pointer if rows are visited
+  /// in the order they are stored (the current setting, affects future iterators)
+  inline const boost::shared_ptr<TimeOrderPermutation const>& timeOrder() const {return itsTimeOrder;}
+
+  /// @brief current memory budget of a chunk
+  /// @return maximum number of bytes per chunk, zero means no restriction
+  /// (the current setting, affects future iterators)
+  inline size_t chunkMemoryBudget() const {return itsChunkMemoryBudget;}
+
+  /// @brief current format of the reduced precision visibilities
+  /// @return format of the compact visibilities (the current setting, affects future iterators)
+  inline CompactVisibilityCube::Format compactVisibilityFormat() const {return itsCompactVisibilityFormat;}
+
+  /// @brief custom allocator of the data buffers
+  /// @return shared pointer to the allocator (empty pointer for the default allocation)
+  inline const boost::shared_ptr<IBufferAllocator>& bufferAllocator() const {return itsBufferAllocator;}
   
 private:
   /// @brief a number of uvw machines in the cache (default is 1)
@@ -180,6 +545,72 @@ private:
   /// processing chain which do data copy (usually in the temporary code/hacks which technically shouldn't
   /// stay long term in the ideal case).
   casacore::uInt itsMaxChunkSize;
+
+  /// @brief true, if the data cubes are read in the storage order first
+  /// @details See configureNativeLayout for details.
+  bool itsNativeLayout;
+
+  /// @brief true, if the next chunk is read in the background
+  /// @details See configurePrefetch for details.
+  bool itsPrefetch;
+
+  /// @brief true, if rows flagged as a whole are not read
+  /// @details See configureSkipFlaggedRows for details.
+  bool itsSkipFlaggedRows;
+
+  /// @brief maximum number of channels per accessor
+  /// @details See configureMaxChannels for details. Zero means that all selected
+  /// channels are delivered together.
+  casacore::uInt itsMaxChannels;
+
+  /// @brief store of rotated uvws shared by iterators
+  /// @details See configureRotatedUVWStore for details. Empty shared pointer means 
+  /// that rotated uvws are not stored.
+  boost::shared_ptr<RotatedUVWStore> itsRotatedUVWStore;
+
+  /// @brief maximum time difference in seconds to reuse the conversion for parallactic angles
+  /// @details See configureParallacticAngleInterpolation for details.
+  double itsParallacticAngleInterval;
+
+  /// @brief true, if the selection is resolved via the index of the main table rows
+  /// @details See configureRowIndex for details.
+  bool itsUseRowIndex;
+
+  /// @brief maximum time difference in seconds to reuse the converted frequency axis
+  /// @details See configureFrequencyFrameTolerance for details.
+  double itsFrequencyFrameTolerance;
+
+  /// @brief true, if rows of each time step are grouped by DATA_DESC_ID and FIELD_ID
+  /// @details See configureRowGrouping for details.
+  bool itsGroupRows;
+
+  /// @brief permutation of rows putting them in the time order
+  /// @details See configureTimeOrdering for details. Empty shared pointer means that
+  /// rows are visited in the order they are stored.
+  boost::shared_ptr<TimeOrderPermutation const> itsTimeOrder;
+
+  /// @brief maximum number of bytes per chunk
+  /// @details See configureChunkMemoryBudget for details. Zero means no restriction.
+  size_t itsChunkMemoryBudget;
+
+  /// @brief format of the reduced precision visibilities
+  /// @details See configureCompactVisibility for details.
+  CompactVisibilityCube::Format itsCompactVisibilityFormat;
+
+  /// @brief statistics shared by iterators
+  /// @details See configureStatistics for details. Empty shared pointer means that
+  /// the statistics are not collected.
+  boost::shared_ptr<IteratorStatistics> itsStatistics;
+
+  /// @brief quality control statistics shared by iterators
+  /// @details See configureQCStatistics for details. Empty shared pointer means that
+  /// the statistics are not collected.
+  boost::shared_ptr<QCStatistics> itsQCStatistics;
+
+  /// @brief custom allocator of the data buffers
+  /// @details See configureBufferAllocator for details. Empty shared pointer means
+  /// the default allocation.
+  boost::shared_ptr<IBufferAllocator> itsBufferAllocator;
 };
  
 } // namespace accessors
@@ -34,6 +34,7 @@
 /// own includes
 #include <askap/dataaccess/TableDataAccessor.h>
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -114,11 +115,60 @@ void TableDataAccessor::sync() const
 {
   if (itsVisNeedsFlush) {
       itsVisNeedsFlush = false;
-      itsIterator.writeOriginalVis();
+      itsIterator.writeOriginalVis(itsVisDirtyRegion);
   }
 
   if (itsFlagNeedsFlush) {
       itsFlagNeedsFlush = false;
-      itsIterator.writeOriginalFlag();
+      itsIterator.writeOriginalFlag(itsFlagDirtyRegion);
   }
+  // declarations apply to the current chunk only
+  itsVisDirtyRegion.clear();
+  itsFlagDirtyRegion.clear();
+}
+
+/// @brief declare a part of the visibility cube as modified
+/// @details Only the declared part is written back to the table. If nothing
+/// is declared, the whole cube is written.
+/// @param[in] startRow first modified row
+/// @param[in] nRow number of modified rows
+/// @param[in] startChan first modified channel
+/// @param[in] nChan number of modified channels
+void TableDataAccessor::markVisibilityDirty(casacore::uInt startRow, casacore::uInt nRow,
+                                            casacore::uInt startChan, casacore::uInt nChan)
+{
+  ASKAPCHECK((startRow + nRow <= this->nRow()) && (startChan + nChan <= nChannel()),
+             "Modified region of the visibility cube exceeds the chunk boundaries");
+  itsVisDirtyRegion.add(startRow, nRow, startChan, nChan);
+}
+
+/// @brief part of the visibility cube declared as modified
+/// @return a reference to the region (empty if nothing has been declared)
+const DirtyRegion& TableDataAccessor::visibilityDirtyRegion() const
+{
+  return itsVisDirtyRegion;
+}
+
+/// @brief declare a part of the flag cube as modified
+/// @details Only the declared part is written back to the table. If nothing
+/// is declared, the whole cube is written.
+/// @param[in] startRow first modified row
+/// @param[in] nRow number of modified rows
+/// @param[in] startChan first modified channel
+/// @param[in] nChan number of modified channels
+/// @note This operation is specific to table (i.e MS) based implementaton
+/// of the interface
+void TableDataAccessor::markFlagDirty(casacore::uInt startRow, casacore::uInt nRow,
+                                      casacore::uInt startChan, casacore::uInt nChan)
+{
+  ASKAPCHECK((startRow + nRow <= this->nRow()) && (startChan + nChan <= nChannel()),
+             "Modified region of the flag cube exceeds the chunk boundaries");
+  itsFlagDirtyRegion.add(startRow, nRow, startChan, nChan);
+}
+
+/// @brief part of the flag cube declared as modified
+/// @return a reference to the region (empty if nothing has been declared)
+const DirtyRegion& TableDataAccessor::flagDirtyRegion() const
+{
+  return itsFlagDirtyRegion;
 }
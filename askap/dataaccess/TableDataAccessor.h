@@ -40,6 +40,8 @@
 #include <askap/dataaccess/TableDataIterator.h>
 #include <askap/dataaccess/MetaDataAccessor.h>
 #include <askap/dataaccess/IFlagDataAccessor.h>
+#include <askap/dataaccess/IDirtyRegionDataAccessor.h>
+#include <askap/dataaccess/DirtyRegion.h>
 
 namespace askap {
 	
@@ -67,7 +69,8 @@ class TableDataIterator;
 ///
 /// @ingroup dataaccess_tab
 class TableDataAccessor : virtual public MetaDataAccessor,
-                          virtual public IFlagDataAccessor
+                          virtual public IFlagDataAccessor,
+                          virtual public IDirtyRegionDataAccessor
 {
 public:
   /// construct an object linked with the given read-write iterator
@@ -101,6 +104,36 @@ public:
   ///         information. If True, the corresponding element is flagged.
   virtual casacore::Cube<casacore::Bool>& rwFlag();
 
+  /// @brief declare a part of the visibility cube as modified
+  /// @details Only the declared part is written back to the table. If nothing
+  /// is declared, the whole cube is written.
+  /// @param[in] startRow first modified row
+  /// @param[in] nRow number of modified rows
+  /// @param[in] startChan first modified channel
+  /// @param[in] nChan number of modified channels
+  virtual void markVisibilityDirty(casacore::uInt startRow, casacore::uInt nRow,
+                                   casacore::uInt startChan, casacore::uInt nChan);
+
+  /// @brief part of the visibility cube declared as modified
+  /// @return a reference to the region (empty if nothing has been declared)
+  virtual const DirtyRegion& visibilityDirtyRegion() const;
+
+  /// @brief declare a part of the flag cube as modified
+  /// @details Only the declared part is written back to the table. If nothing
+  /// is declared, the whole cube is written.
+  /// @param[in] startRow first modified row
+  /// @param[in] nRow number of modified rows
+  /// @param[in] startChan first modified channel
+  /// @param[in] nChan number of modified channels
+  /// @note This operation is specific to table (i.e MS) based implementaton
+  /// of the interface
+  void markFlagDirty(casacore::uInt startRow, casacore::uInt nRow,
+                     casacore::uInt startChan, casacore::uInt nChan);
+
+  /// @brief part of the flag cube declared as modified
+  /// @return a reference to the region (empty if nothing has been declared)
+  const DirtyRegion& flagDirtyRegion() const;
+
   
   /// this method flush back the data to disk if there are any changes
   void sync() const;
@@ -112,6 +145,12 @@ private:
   /// a flag showing that the visibility has been changed and needs flushing
   /// back to the table
   mutable bool itsFlagNeedsFlush;  
+
+  /// @brief part of the visibility cube declared as modified
+  mutable DirtyRegion itsVisDirtyRegion;
+
+  /// @brief part of the flag cube declared as modified
+  mutable DirtyRegion itsFlagDirtyRegion;
   
   /// @brief A reference to associated read-write iterator
   /// @details 
@@ -45,6 +45,8 @@
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/IBufferManager.h>
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/CubeTransposer.h>
+#include <askap/dataaccess/AccessTracer.h>
 
 // casa includes
 #include <casacore/tables/Tables/ArrayColumn.h>
@@ -99,18 +101,33 @@ using namespace askap::accessors;
 /// @param[in] sel shared pointer to selector
 /// @param[in] conv shared pointer to converter
 /// @param[in] maxChunkSize maximum number of rows per accessor
+/// @param[in] nativeLayout if true, cubes in the table order are the primary buffers
+/// @param[in] writeBehind number of modified chunks collected before they are written
+/// in the background, zero means that the data are written synchronously
+/// @param[in] rotatedUVWStore optional store of rotated uvws shared between iterations
+/// @param[in] sharedWriter optional writer shared with other iterators over the same
+/// table (e.g. other partitions), which takes all writes of this iterator (writeBehind
+/// is ignored in this case)
+/// @param[in] chunkMemoryBudget maximum number of bytes of the bulk data per chunk, zero
+/// means no restriction except maxChunkSize
 TableDataIterator::TableDataIterator(
             const boost::shared_ptr<ITableManager const> &msManager,
             const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
             const boost::shared_ptr<IDataConverterImpl const> &conv,
             size_t cacheSize, double tolerance,
-            casacore::uInt maxChunkSize) :
+            casacore::uInt maxChunkSize, bool nativeLayout, casacore::uInt writeBehind,
+            const boost::shared_ptr<RotatedUVWStore> &rotatedUVWStore,
+            const boost::shared_ptr<SharedTableWriter> &sharedWriter, size_t chunkMemoryBudget) :
          TableInfoAccessor(msManager),
-           TableConstDataIterator(msManager,sel,conv,cacheSize, tolerance, maxChunkSize),
+           TableConstDataIterator(msManager,sel,conv,cacheSize, tolerance, maxChunkSize, nativeLayout,
+                 false, false, 0, rotatedUVWStore, 0., false, 0., false, chunkMemoryBudget),
 	      itsOriginalVisAccessor(new TableDataAccessor(*this)),
-	      itsIterationCounter(0)
+	      itsIterationCounter(0), itsWriteBehind(writeBehind), itsSharedWriter(sharedWriter)
 {
   itsActiveBufferPtr=itsOriginalVisAccessor;
+  if (itsWriteBehind > 0 && !itsSharedWriter) {
+      itsWriter.reset(new TableChunkWriter);
+  }
 }
 
 /// @brief operator* delivers a reference to data accessor (current chunk)
@@ -194,6 +211,13 @@ void TableDataIterator::init()
            mapMemFun(&TableBufferDataAccessor::sync));
   ASKAPDEBUGASSERT(itsOriginalVisAccessor);
   itsOriginalVisAccessor->sync();
+  // the data could be read again, all deferred writes have to be done first
+  if (itsWriter) {
+      itsWriter->sync();
+  }
+  if (itsSharedWriter) {
+      itsSharedWriter->sync();
+  }
 
   TableConstDataIterator::init();
   itsIterationCounter=0;
@@ -217,6 +241,10 @@ casacore::Bool TableDataIterator::next()
            mapMemFun(&TableBufferDataAccessor::sync));
   ASKAPDEBUGASSERT(itsOriginalVisAccessor);
   itsOriginalVisAccessor->sync();
+  if (itsWriter && (itsWriter->nQueued() >= 2 * itsWriteBehind)) {
+      // the bulk data are not being read, don't let the queue grow without limit
+      itsWriter->sync();
+  }
 
   ++itsIterationCounter;
 
@@ -230,6 +258,80 @@ casacore::Bool TableDataIterator::next()
   return TableConstDataIterator::next();
 }
 
+/// @brief jump to the given chunk
+/// @details Modified data are written before the jump. Buffers are indexed by
+/// the iteration step, so they can only be used with seek if the channels are not split
+/// into several ranges (each chunk is a single iteration step).
+/// @param[in] chunk zero-based index of the chunk (should be less than nChunks())
+void TableDataIterator::seek(casacore::uInt chunk)
+{
+  ASKAPCHECK(itsBuffers.empty() || (nChannelTiles() == 1), 
+       "Buffers can't be used together with seek if the channels are split into several ranges");
+  // call sync() member function for all accessors in itsBuffers
+  std::for_each(itsBuffers.begin(),itsBuffers.end(),
+           mapMemFun(&TableBufferDataAccessor::sync));
+  ASKAPDEBUGASSERT(itsOriginalVisAccessor);
+  itsOriginalVisAccessor->sync();
+  // the data could be read again, all deferred writes have to be done first
+  if (itsWriter) {
+      itsWriter->sync();
+  }
+  if (itsSharedWriter) {
+      itsSharedWriter->sync();
+  }
+
+  TableConstDataIterator::seek(chunk);
+  itsIterationCounter = chunk;
+
+  // call notifyNewIteration() member function for all accessors
+  // in itsBuffers
+  std::for_each(itsBuffers.begin(),itsBuffers.end(),
+           mapMemFun(&TableBufferDataAccessor::notifyNewIteration));
+}
+
+/// @brief write all modified data to the table
+/// @details Changes to the current chunk and all chunks waiting to be written
+/// in the background are written to the table when this method returns. Without
+/// the write-behind mode the chunks are written synchronously at each iteration
+/// step, and only the current chunk is affected. If the writer is shared with other
+/// iterators, their queued chunks are written as well. An exception is thrown if any of 
+/// the deferred writes has failed.
+void TableDataIterator::sync()
+{
+  std::for_each(itsBuffers.begin(),itsBuffers.end(),
+           mapMemFun(&TableBufferDataAccessor::sync));
+  ASKAPDEBUGASSERT(itsOriginalVisAccessor);
+  itsOriginalVisAccessor->sync();
+  if (itsWriter) {
+      itsWriter->sync();
+  }
+  if (itsSharedWriter) {
+      itsSharedWriter->sync();
+  }
+}
+
+/// @brief wait for the background jobs to finish
+/// @details In addition to the read-ahead handled by the base class, this
+/// method waits for the write-behind.
+void TableDataIterator::waitForBackgroundJobs() const
+{
+  TableConstDataIterator::waitForBackgroundJobs();
+  if (itsWriter) {
+      itsWriter->wait();
+  }
+}
+
+/// @brief notify that the bulk data of the current chunk have been obtained
+/// @details The queued chunks are written in the background from this point,
+/// if their number has reached the limit set up in the constructor.
+void TableDataIterator::chunkObtained() const
+{
+  TableConstDataIterator::chunkObtained();
+  if (itsWriter && (itsWriter->nQueued() >= itsWriteBehind)) {
+      itsWriter->start();
+  }
+}
+
 /// populate the cube with the data stored in the given buffer
 /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
 ///            cube to fill with the complex visibility data
@@ -237,12 +339,15 @@ casacore::Bool TableDataIterator::next()
 void TableDataIterator::readBuffer(casacore::Cube<casacore::Complex> &vis,
                         const std::string &name) const
 {
+  const AccessTracer::Scope trace("readBuffer", name, "dataaccess");
+  waitForBackgroundJobs();
   const IBufferManager &bufManager=subtableInfo().getBufferManager();
   const TableConstDataAccessor &accessor=getAccessor();
   const casacore::IPosition requiredShape(3, accessor.nRow(),
           accessor.nChannel(), accessor.nPol());
   if (bufManager.bufferExists(name,itsIterationCounter)) {
       bufManager.readBuffer(vis,name,itsIterationCounter);
+      countRead(name, vis.nelements() * sizeof(casacore::Complex));
       if (vis.shape()!=requiredShape) {
 	  // this is an old buffer with a different shape. Can't be used
 	  vis.resize(requiredShape);
@@ -259,7 +364,10 @@ void TableDataIterator::readBuffer(casacore::Cube<casacore::Complex> &vis,
 void TableDataIterator::writeBuffer(const casacore::Cube<casacore::Complex> &vis,
                          const std::string &name) const
 {
+  const AccessTracer::Scope trace("writeBuffer", name, "dataaccess");
+  waitForBackgroundJobs();
   subtableInfo().getBufferManager().writeBuffer(vis,name,itsIterationCounter);
+  countWrite(name, vis.nelements() * sizeof(casacore::Complex));
 }
 
 /// destructor required to sync buffers on the last iteration
@@ -273,6 +381,8 @@ TableDataIterator::~TableDataIterator()
       // doesn't point to a valid instance for some reason (it shouldn't happend)
       itsOriginalVisAccessor->sync();
   }
+  // the writer (if any) completes deferred writes in its destructor, the shared
+  // writer does it when the last iterator using it is destroyed
 }
 
 /// @brief helper templated method to write back a cube to main table column
@@ -283,49 +393,75 @@ TableDataIterator::~TableDataIterator()
 /// @param[in] cube Cube to work with, type should match the column type. Should be
 ///                 of the appropriate shape
 /// @param[in] colName Name of the column
+/// @param[in] region rows and channels to write, the whole cube is written if
+/// the region is empty
 template<typename T>
 void TableDataIterator::writeCube(const casacore::Cube<T> &cube,
-                                  const std::string &colName) const
+                                  const std::string &colName, const DirtyRegion &region) const
 {
+  const AccessTracer::Scope trace("writeCube", colName, "dataaccess");
+  ASKAPCHECK(!polarizationsSelected(), "Writing to "<<colName<<" is not supported if polarisation "
+             "products are selected");
+  ASKAPCHECK(channelAveraging() == 1, "Writing to "<<colName<<" is not supported if channels "
+             "are averaged at read time");
+  waitForBackgroundJobs();
   const casacore::uInt nChan = nChannel();
   const casacore::uInt startChan = startChannel();
-  // Setup a slicer to extract the specified channel range only
-  const casacore::Slicer chanSlicer(casacore::Slice(),casacore::Slice(startChan,nChan));
 
   // no change of shape is permitted
   ASKAPASSERT(cube.nrow() == nRow() &&
               cube.ncolumn() == nChan &&
               cube.nplane() == nPol());
+  ASKAPCHECK(region.fits(cube.nrow(), nChan), "Modified region exceeds the chunk boundaries");
   casacore::ArrayColumn<T> visCol(getCurrentIteration(), colName);
   ASKAPDEBUGASSERT(getCurrentIteration().nrow() >= getCurrentTopRow()+
                     nRow());
-  casacore::uInt tableRow = getCurrentTopRow();
-  casacore::Matrix<T> buf(nPol(),nChan);
-  for (casacore::uInt row=0;row<cube.nrow();++row,++tableRow) {
-       const casacore::IPosition shape = visCol.shape(row);
-       ASKAPDEBUGASSERT(shape.size() && (shape.size()<3));
-       const casacore::uInt thisRowNumberOfPols = shape[0];
-       const casacore::uInt thisRowNumberOfChannels = shape.size()>1 ? shape[1] : 1;
-       if (thisRowNumberOfPols != cube.nplane()) {
-           ASKAPTHROW(DataAccessError, "Current implementation of the writing to original "
-                "visibilities does not support partial selection of the data");
-       }
-       if (thisRowNumberOfChannels < nChan + startChan) {
-           ASKAPTHROW(DataAccessError, "Channel selection doesn't fit into exisiting visibility array");
-       }
-       // for now just copy
-       bool useSlicer = (startChan!=0) || (startChan+nChan!=thisRowNumberOfChannels);
-
-       for (casacore::uInt chan=0; chan<nChan; ++chan) {
-            for (casacore::uInt pol=0; pol<thisRowNumberOfPols; ++pol) {
-                 buf(pol,chan) = cube(row,chan,pol);
-            }
-       }
-       if (useSlicer) {
-           visCol.putSlice(tableRow,chanSlicer,buf);
-       } else {
-           visCol.put(tableRow, buf);
-       }
+  // rows and channels to write
+  const casacore::uInt firstRow = region.empty() ? 0 : region.startRow();
+  const casacore::uInt nRowToWrite = region.empty() ? cube.nrow() : region.nRow();
+  const casacore::uInt firstChan = region.empty() ? 0 : region.startChannel();
+  const casacore::uInt nChanToWrite = region.empty() ? nChan : region.nChannel();
+  // transpose the whole region back into the table order at once, the new cube
+  // doesn't share the storage with the accessor, so it can be written later
+  casacore::Cube<T> buf;
+  if (region.empty()) {
+      CubeTransposer::transpose(cube, buf);
+  } else {
+      const casacore::Cube<T> section = cube(casacore::IPosition(3, firstRow, firstChan, 0),
+              casacore::IPosition(3, firstRow + nRowToWrite - 1, firstChan + nChanToWrite - 1,
+                                  cube.nplane() - 1));
+      CubeTransposer::transpose(section, buf);
+  }
+  const bool uniform = uniformCellShape(visCol);
+  if (!uniform) {
+      // check all rows here, so the problem is reported straight away in the write-behind mode
+      casacore::uInt tableRow = getCurrentTopRow() + firstRow;
+      for (casacore::uInt row=0;row<nRowToWrite;++row,++tableRow) {
+           const casacore::IPosition shape = visCol.shape(tableRow);
+           ASKAPDEBUGASSERT(shape.size() && (shape.size()<3));
+           const casacore::uInt thisRowNumberOfPols = shape[0];
+           const casacore::uInt thisRowNumberOfChannels = shape.size()>1 ? shape[1] : 1;
+           if (thisRowNumberOfPols != cube.nplane()) {
+               ASKAPTHROW(DataAccessError, "Current implementation of the writing to original "
+                    "visibilities does not support partial selection of the data");
+           }
+           if (thisRowNumberOfChannels < nChan + startChan) {
+               ASKAPTHROW(DataAccessError, "Channel selection doesn't fit into exisiting visibility array");
+           }
+      }
+  }
+  countWrite(colName, buf.nelements() * sizeof(T));
+  if (itsSharedWriter) {
+      // other partitions don't touch these rows, so there is no need to wait for the
+      // shared writer before the table is accessed by this iterator
+      itsSharedWriter->add(getCurrentIteration(), colName, getCurrentTopRow() + firstRow, 
+                     startChan + firstChan, buf, uniform);
+  } else if (itsWriter) {
+      itsWriter->add(getCurrentIteration(), colName, getCurrentTopRow() + firstRow, 
+                     startChan + firstChan, buf, uniform);
+  } else {
+      TableChunkWriter::write(visCol, getCurrentTopRow() + firstRow, startChan + firstChan, 
+                              buf, uniform);
   }
 }
 
@@ -333,31 +469,38 @@ void TableDataIterator::writeCube(const casacore::Cube<T> &cube,
 /// @details The write operation is possible if the shape of the
 /// visibility cube stays the same as the shape of the data in the
 /// table. The method uses DataAccessor to obtain a reference to the
-/// visibility cube (hence no parameters).
-void TableDataIterator::writeOriginalVis() const
+/// visibility cube.
+/// @param[in] region part of the cube to write, the whole cube is written if
+/// the region is empty
+void TableDataIterator::writeOriginalVis(const DirtyRegion &region) const
 {
-   writeCube(getAccessor().visibility(), getDataColumnName());
+   writeCube(getAccessor().visibility(), getDataColumnName(), region);
 }
 
 /// @brief write back flags
 /// @details The write operation is possible if the shape of the
 /// flag cube stays the same as the shape of the data in the
 /// table. The method uses DataAccessor to obtain a reference to the
-/// visibility cube (hence no parameters).
+/// flag cube.
+/// @param[in] region part of the cube to write, the whole cube is written if
+/// the region is empty
 /// @note This operation is specific to table (i.e MS) based implementaton
 /// of the interface
-void TableDataIterator::writeOriginalFlag() const
+void TableDataIterator::writeOriginalFlag(const DirtyRegion &region) const
 {
+   waitForBackgroundJobs();
    const bool rowBasedFlagUsed = getCurrentIteration().tableDesc().isColumn("FLAG_ROW");
    const casacore::Cube<casacore::Bool>& flags = getAccessor().flag();
    if (rowBasedFlagUsed) {
        // check that updated flag doesn't contradict row-based flag
        casacore::ROScalarColumn<casacore::Bool> rowFlagCol(getCurrentIteration(), "FLAG_ROW");
-       const casacore::Vector<casacore::Bool> rowBasedFlag = rowFlagCol.getColumn();
+       // only the rows of the current chunk are read
        const casacore::uInt topRow = getCurrentTopRow();
-       ASKAPDEBUGASSERT(rowBasedFlag.nelements() >= topRow+flags.nrow());
+       ASKAPDEBUGASSERT(getCurrentIteration().nrow() >= topRow+flags.nrow());
+       const casacore::Vector<casacore::Bool> rowBasedFlag = rowFlagCol.getColumnRange(
+             casacore::Slicer(casacore::IPosition(1, topRow), casacore::IPosition(1, flags.nrow())));
        for (casacore::uInt row = 0; row < flags.nrow(); ++row) {
-            if (rowBasedFlag[row + topRow]) {
+            if (rowBasedFlag[row]) {
                 bool oneUnflagged = false;
                 casacore::Matrix<casacore::Bool> thisRow = flags.yzPlane(row);
                 for (casacore::Matrix<casacore::Bool>::const_iterator ci = thisRow.begin();
@@ -367,14 +510,14 @@ void TableDataIterator::writeOriginalFlag() const
                          break;
                      }
                 }
-                //std::cout<<row<<" "<<rowBasedFlag[row + topRow]<<" "<<oneUnflagged<<std::endl;
+                //std::cout<<row<<" "<<rowBasedFlag[row]<<" "<<oneUnflagged<<std::endl;
                 ASKAPCHECK(!oneUnflagged, "Flag modification attempted to unflag data for the row ("<<
                       row<<") which is flagged via row-based flagging mechanism. This is not supported");
             }
        }
 
    }
-   writeCube(flags, "FLAG");
+   writeCube(flags, "FLAG", region);
 }
 
 
@@ -49,6 +49,9 @@
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/IDataAccessor.h>
 #include <askap/dataaccess/TableBufferDataAccessor.h>
+#include <askap/dataaccess/TableChunkWriter.h>
+#include <askap/dataaccess/SharedTableWriter.h>
+#include <askap/dataaccess/DirtyRegion.h>
 
 
 namespace askap {
@@ -78,12 +81,27 @@ public:
   /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
   /// to initialisation of a new UVW Machine
   /// @param[in] maxChunkSize maximum number of rows per accessor
+  /// @param[in] nativeLayout if true, cubes in the table order are the primary buffers
+  /// @param[in] writeBehind number of modified chunks collected before they are written
+  /// in the background, zero means that the data are written synchronously
+  /// @param[in] rotatedUVWStore optional store of rotated uvws shared between iterations
+  /// @param[in] sharedWriter optional writer shared with other iterators over the same
+  /// table (e.g. other partitions), which takes all writes of this iterator (writeBehind
+  /// is ignored in this case)
+  /// @param[in] chunkMemoryBudget maximum number of bytes of the bulk data per chunk, zero
+  /// means no restriction except maxChunkSize
   TableDataIterator(const boost::shared_ptr<ITableManager const>
               &msManager,
               const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
 	      const boost::shared_ptr<IDataConverterImpl const> &conv,
 	      size_t cacheSize = 1, double tolerance = 1e-6,
-	      casacore::uInt maxChunkSize = INT_MAX);
+	      casacore::uInt maxChunkSize = INT_MAX, bool nativeLayout = false,
+	      casacore::uInt writeBehind = 0,
+	      const boost::shared_ptr<RotatedUVWStore> &rotatedUVWStore = 
+	                 boost::shared_ptr<RotatedUVWStore>(),
+	      const boost::shared_ptr<SharedTableWriter> &sharedWriter =
+	                 boost::shared_ptr<SharedTableWriter>(),
+	      size_t chunkMemoryBudget = 0);
 
   /// destructor required to sync buffers on the last iteration
   virtual ~TableDataIterator();
@@ -136,6 +154,22 @@ public:
   ///         while(it.next()) {} are possible)
   virtual casacore::Bool next();
 
+  /// @brief jump to the given chunk
+  /// @details Modified data are written before the jump. Buffers are indexed by
+  /// the iteration step, so they can only be used with seek if the channels are not split
+  /// into several ranges (each chunk is a single iteration step).
+  /// @param[in] chunk zero-based index of the chunk (should be less than nChunks())
+  virtual void seek(casacore::uInt chunk);
+
+  /// @brief write all modified data to the table
+  /// @details Changes to the current chunk and all chunks waiting to be written
+  /// in the background are written to the table when this method returns. Without
+  /// the write-behind mode the chunks are written synchronously at each iteration
+  /// step, and only the current chunk is affected. If the writer is shared with other
+  /// iterators, their queued chunks are written as well. An exception is thrown if any of 
+  /// the deferred writes has failed.
+  void sync();
+
   // to make it public instead of protected
   using TableConstDataIterator::getAccessor;
 
@@ -157,17 +191,21 @@ public:
   /// @details The write operation is possible if the shape of the 
   /// visibility cube stays the same as the shape of the data in the
   /// table. The method uses DataAccessor to obtain a reference to the
-  /// visibility cube (hence no parameters). 
-  void writeOriginalVis() const;
+  /// visibility cube. 
+  /// @param[in] region part of the cube to write, the whole cube is written if
+  /// the region is empty
+  void writeOriginalVis(const DirtyRegion &region = DirtyRegion()) const;
 
   /// @brief write back flags
   /// @details The write operation is possible if the shape of the
   /// flag cube stays the same as the shape of the data in the
   /// table. The method uses DataAccessor to obtain a reference to the
-  /// visibility cube (hence no parameters). 
+  /// flag cube. 
+  /// @param[in] region part of the cube to write, the whole cube is written if
+  /// the region is empty
   /// @note This operation is specific to table (i.e MS) based implementaton
   /// of the interface
-  void writeOriginalFlag() const;
+  void writeOriginalFlag(const DirtyRegion &region = DirtyRegion()) const;
 
   
   /// @brief check whether one can write to the main table
@@ -175,6 +213,17 @@ public:
   /// @return true if write operation is allowed
   bool mainTableWritable() const throw();		  
 
+protected:
+  /// @brief wait for the background jobs to finish
+  /// @details In addition to the read-ahead handled by the base class, this
+  /// method waits for the write-behind.
+  virtual void waitForBackgroundJobs() const;
+
+  /// @brief notify that the bulk data of the current chunk have been obtained
+  /// @details The queued chunks are written in the background from this point,
+  /// if their number has reached the limit set up in the constructor.
+  virtual void chunkObtained() const;
+
 private:
 
   /// @brief helper templated method to write back a cube to main table column
@@ -185,8 +234,11 @@ private:
   /// @param[in] cube Cube to work with, type should match the column type. Should be
   ///                 of the appropriate shape
   /// @param[in] colName Name of the column 
+  /// @param[in] region rows and channels to write, the whole cube is written if
+  /// the region is empty
   template<typename T>
-  void writeCube(const casacore::Cube<T> &cube, const std::string &colName) const;
+  void writeCube(const casacore::Cube<T> &cube, const std::string &colName,
+                 const DirtyRegion &region) const;
 
 
 
@@ -206,6 +258,15 @@ private:
   /// counter of the iteration steps. It is used to store the buffers
   /// to the appropriate cell of the disk table
   casacore::uInt itsIterationCounter;
+
+  /// @brief number of modified chunks collected before they are written in the background
+  casacore::uInt itsWriteBehind;
+
+  /// @brief deferred writer, empty pointer if the data are written synchronously
+  boost::shared_ptr<TableChunkWriter> itsWriter;
+
+  /// @brief writer shared with other iterators, empty pointer if it is not used
+  boost::shared_ptr<SharedTableWriter> itsSharedWriter;
 };
 
 } // end of namespace accessors
@@ -36,6 +36,13 @@
 #include <askap/dataaccess/TableDataSelector.h>
 #include <askap/dataaccess/DataAccessError.h>
 #include <askap/dataaccess/TableTimeStampSelectorImpl.h>
+#include <askap/dataaccess/PolConvertingAccessor.h>
+
+/// casa includes
+#include <casacore/tables/Tables/TableDesc.h>
+
+/// std includes
+#include <algorithm>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -52,7 +59,7 @@ TableDataSelector::TableDataSelector(const
 #ifndef ASKAP_DEBUG
        itsDataColumnName(msManager->defaultDataColumnName()),
 #endif       
-       itsChannelSelection(-1,0)
+       itsChannelSelection(-1,0), itsChannelAveraging(1), itsRequiredFields(ALL_FIELDS)
 {
   ASKAPDEBUGASSERT(msManager);
 #ifdef ASKAP_DEBUG
@@ -87,12 +94,27 @@ void TableDataSelector::chooseTimeRange(casacore::Double start,casacore::Double
  
 /// Choose cycles. This is an equivalent of choosing the time range,
 /// but the selection is done in integer cycle numbers
+/// @details Cycles are unique time stamps of the measurement set counted 
+/// from zero. The selection is converted to the time range half way between 
+/// the adjacent cycles.
 /// @param[in] start the number of the first cycle to choose
 /// @param[in] stop the number of the last cycle to choose
 void TableDataSelector::chooseCycles(casacore::uInt start, casacore::uInt stop)
 {
-   ASKAPTHROW(DataAccessLogicError, "chooseCycles has not yet been implemented, requested start="<<start
-              <<"stop="<<stop);
+   ASKAPCHECK(start <= stop, "The first cycle "<<start<<" is after the last one "<<stop<<
+              " in chooseCycles");
+   // cycle times are in the frame and units of the TIME column, no conversion is required
+   const std::pair<casacore::Double, casacore::Double> range = 
+         subtableInfo().getTimeIndex().cycleTimeRange(start, stop);
+   const casacore::TableExprNode tempNode = (table().col("TIME") > range.first) &&
+         (table().col("TIME") < range.second);
+   casacore::TableExprNode &tex = rwTableSelector();
+   if (tex.isNull()) {
+       tex = tempNode;
+   } else {
+       tex = tex && tempNode;
+   }
+   rwRowCriteria().chooseTimeRange(range.first, range.second);
 }
 
 /// Obtain a table expression node for selection. This method is
@@ -114,7 +136,27 @@ const casacore::TableExprNode& TableDataSelector::getTableSelector(const
    return rwTableSelector();
 }
 
+/// @brief Obtain row selection criteria
+/// @details This method is an alternative to getTableSelector used if the
+/// selection is resolved via the index of the main table rows.
+///
+/// @param[in] conv  a reference to the converter, which is used to sort
+///              out epochs used in the selection
+/// @return criteria equivalent to the table expression
+MainTableRowIndex::Criteria TableDataSelector::getRowCriteria(const
+                    boost::shared_ptr<IDataConverterImpl const> &conv) const
+{
+   MainTableRowIndex::Criteria criteria = TableScalarFieldSelector::getRowCriteria(conv);
+   if (itsEpochSelector && criteria.usable()) { 
+       itsEpochSelector->setConverter(conv);
+       itsEpochSelector->updateRowCriteria(criteria);
+   }
+   return criteria;
+}
+
 /// Choose a subset of spectral channels
+/// @details If nAvg is more than 1, blocks of nAvg adjacent channels starting from
+/// start are averaged while the data are read, so nChan * nAvg channels are used.
 /// @param[in] nChan a number of spectral channels wanted in the output
 /// @param[in] start the number of the first spectral channel to choose
 /// @param[in] nAvg a number of adjacent spectral channels to average
@@ -122,12 +164,11 @@ const casacore::TableExprNode& TableDataSelector::getTableSelector(const
 void TableDataSelector::chooseChannels(casacore::uInt nChan, casacore::uInt start,
                              casacore::uInt nAvg)
 {
-   if (nAvg != 1) {
-       throw DataAccessLogicError("not yet implemented");
-   }
+   ASKAPCHECK(nAvg > 0, "Number of channels to average should be positive");
    ASKAPDEBUGASSERT((nChan>0) && (start>=0)); 
    itsChannelSelection.first = int(nChan);
    itsChannelSelection.second = int(start);
+   itsChannelAveraging = nAvg;
 }
 
 /// Choose a subset of frequencies. The reference frame is
@@ -164,11 +205,15 @@ void TableDataSelector::chooseVelocities(casacore::uInt nChan,
 }
 
 /// Choose polarization. 
+/// @details Products are given as a comma-separated list (e.g. "XX,YY" or "I,Q,U,V").
+/// If they are a subset of the stored products, only the requested products are
+/// read from the table. Otherwise, all stored products are read and converted.
 /// @param[in] pols a string describing the wanted polarization 
-/// in the output. Allowed values are: I, "IQUV","XXYY","RRLL"
+/// in the output.
 void TableDataSelector::choosePolarizations(const casacore::String &pols)
 {
-   ASKAPTHROW(DataAccessLogicError, "choosePolarizations has not yet been implemented, requested pols="<<pols);
+   // fresh storage, so clones made earlier are not affected (reference semantics)
+   itsPolSelection.reference(PolConvertingAccessor::parse(pols));
 }
 
 /// @brief choose data column
@@ -183,6 +228,47 @@ void TableDataSelector::chooseDataColumn(const std::string &dataColumn)
    itsDataColumnName = dataColumn;
 }  
 
+/// @brief choose additional data columns
+/// @details Visibilities of these columns (e.g. MODEL_DATA) are read for the same 
+/// rows and channels as the main data column and are available via 
+/// IMultiColumnDataAccessor.
+/// @param[in] columns names of the additional columns (an empty vector means none)
+void TableDataSelector::chooseExtraDataColumns(const std::vector<std::string> &columns)
+{
+   for (std::vector<std::string>::const_iterator ci = columns.begin(); ci != columns.end(); ++ci) {
+        ASKAPCHECK(table().tableDesc().isColumn(*ci), "Column "<<*ci<<" is not present in the measurement set");
+        ASKAPCHECK(std::count(columns.begin(), ci, *ci) == 0, "Column "<<*ci<<" is given twice in chooseExtraDataColumns");
+   }
+   itsExtraDataColumnNames = columns;
+}
+
+/// @brief obtain the names of additional data columns
+/// @return names set by chooseExtraDataColumns (empty by default)
+const std::vector<std::string>& TableDataSelector::getExtraDataColumnNames() const throw()
+{
+   return itsExtraDataColumnNames;
+}
+
+/// @brief declare fields which will be used
+/// @details By default, any field of the accessor may be used. If a subset of
+/// fields is declared by this method, the iterator can avoid the work related to
+/// other fields. Undeclared fields are still available, but may be obtained in a
+/// less efficient way.
+/// @param[in] fields fields from ITableDataSelectorImpl::AccessorField, can be or'ed
+void TableDataSelector::chooseRequiredFields(int fields)
+{
+   ASKAPCHECK((fields & ~ALL_FIELDS) == 0, "Unknown accessor fields are given in chooseRequiredFields: "<<fields);
+   itsRequiredFields = fields;
+}
+
+/// @brief obtain fields declared as required
+/// @return fields from ITableDataSelectorImpl::AccessorField or'ed together 
+/// (ALL_FIELDS by default)
+int TableDataSelector::requiredFields() const throw()
+{
+   return itsRequiredFields;
+}
+
 /// @brief clone a selector
 /// @details The same selector can be used to create a number of iterators.
 /// Selector stores a name of the data column to use and, therefore, it can
@@ -229,3 +315,24 @@ std::pair<int,int> TableDataSelector::getChannelSelection() const throw()
   return itsChannelSelection;
 }
 
+/// @brief obtain the number of channels averaged together
+/// @details Blocks of adjacent channels are averaged at read time if more 
+/// than one channel is given to chooseChannels as nAvg. In this case, the number 
+/// of selected channels refers to the averaged channels and the start channel
+/// refers to the channels stored in the dataset.
+/// @return number of adjacent channels averaged together (1 means no averaging)
+casacore::uInt TableDataSelector::getChannelAveraging() const throw()
+{
+  return itsChannelAveraging;
+}
+
+/// @brief obtain polarisation selection
+/// @details By default, all stored polarisation products are returned as they are.
+/// If choosePolarizations has been called, this method returns the requested products
+/// in the order they should appear in the accessor.
+/// @return requested polarisation products (an empty vector means no selection)
+const casacore::Vector<casacore::Stokes::StokesTypes>& TableDataSelector::getPolarizationSelection() const throw()
+{
+  return itsPolSelection;
+}
+
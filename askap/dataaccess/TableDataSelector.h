@@ -36,6 +36,7 @@
 // std includes
 #include <string>
 #include <utility>
+#include <vector>
 
 // boost includes
 #include <boost/shared_ptr.hpp>
@@ -89,11 +90,16 @@ public:
    
   /// Choose cycles. This is an equivalent of choosing the time range,
   /// but the selection is done in integer cycle numbers
+  /// @details Cycles are unique time stamps of the measurement set counted 
+  /// from zero. The selection is converted to the time range half way between 
+  /// the adjacent cycles.
   /// @param[in] start the number of the first cycle to choose
   /// @param[in] stop the number of the last cycle to choose
   virtual void chooseCycles(casacore::uInt start, casacore::uInt stop);
 
   /// Choose a subset of spectral channels
+  /// @details If nAvg is more than 1, blocks of nAvg adjacent channels starting from
+  /// start are averaged while the data are read, so nChan * nAvg channels are used.
   /// @param[in] nChan a number of spectral channels wanted in the output
   /// @param[in] start the number of the first spectral channel to choose
   /// @param[in] nAvg a number of adjacent spectral channels to average
@@ -127,8 +133,12 @@ public:
   	 const casacore::MVRadialVelocity &velInc);
 
   /// Choose polarization. 
+  /// @details Products are given as a comma-separated list (e.g. "XX,YY" or "I,Q,U,V")
+  /// or in the compact form (e.g. "XXYY" or "IQUV").
+  /// If they are a subset of the stored products, only the requested products are
+  /// read from the table. Otherwise, all stored products are read and converted.
   /// @param[in] pols a string describing the wanted polarization 
-  /// in the output. Allowed values are: I, "IQUV","XXYY","RRLL"
+  /// in the output.
   virtual void choosePolarizations(const casacore::String &pols);
 
   /// Obtain a table expression node for selection. This method is
@@ -141,6 +151,16 @@ public:
   virtual const casacore::TableExprNode& getTableSelector(const
                   boost::shared_ptr<IDataConverterImpl const> &conv) const;
 
+  /// @brief Obtain row selection criteria
+  /// @details This method is an alternative to getTableSelector used if the
+  /// selection is resolved via the index of the main table rows.
+  ///
+  /// @param[in] conv  a shared pointer to the converter, which is used to sort
+  ///              out epochs and other measures used in the selection
+  /// @return criteria equivalent to the table expression
+  virtual MainTableRowIndex::Criteria getRowCriteria(const
+                  boost::shared_ptr<IDataConverterImpl const> &conv) const;
+
   /// @brief choose data column
   /// @details This method allows to choose any table column as the visibility
   /// data column (e.g. DATA, CORRECTED_DATA, etc). Because this is a
@@ -150,6 +170,30 @@ public:
   /// @param[in] dataColumn column name, which contains visibility data 
   virtual void chooseDataColumn(const std::string &dataColumn);  
 
+  /// @brief choose additional data columns
+  /// @details Visibilities of these columns (e.g. MODEL_DATA) are read for the same 
+  /// rows and channels as the main data column and are available via 
+  /// IMultiColumnDataAccessor.
+  /// @param[in] columns names of the additional columns (an empty vector means none)
+  virtual void chooseExtraDataColumns(const std::vector<std::string> &columns);
+
+  /// @brief obtain the names of additional data columns
+  /// @return names set by chooseExtraDataColumns (empty by default)
+  virtual const std::vector<std::string>& getExtraDataColumnNames() const throw();
+
+  /// @brief declare fields which will be used
+  /// @details By default, any field of the accessor may be used. If a subset of
+  /// fields is declared by this method, the iterator can avoid the work related to
+  /// other fields. Undeclared fields are still available, but may be obtained in a
+  /// less efficient way.
+  /// @param[in] fields fields from ITableDataSelectorImpl::AccessorField, can be or'ed
+  virtual void chooseRequiredFields(int fields);
+
+  /// @brief obtain fields declared as required
+  /// @return fields from ITableDataSelectorImpl::AccessorField or'ed together 
+  /// (ALL_FIELDS by default)
+  virtual int requiredFields() const throw();
+
   /// @brief obtain the name of data column
   /// @details This method returns the current name of the data column, 
   /// set either in the constructor or by the chooseDataColumn method
@@ -183,6 +227,21 @@ public:
   /// @return a pair, the first element gives the number of channels selected and
   /// the second element gives the start channel (0-based)
   virtual std::pair<int,int> getChannelSelection() const throw();
+
+  /// @brief obtain the number of channels averaged together
+  /// @details Blocks of adjacent channels are averaged at read time if more 
+  /// than one channel is given to chooseChannels as nAvg. In this case, the number 
+  /// of selected channels refers to the averaged channels and the start channel
+  /// refers to the channels stored in the dataset.
+  /// @return number of adjacent channels averaged together (1 means no averaging)
+  virtual casacore::uInt getChannelAveraging() const throw();
+
+  /// @brief obtain polarisation selection
+  /// @details By default, all stored polarisation products are returned as they are.
+  /// If choosePolarizations has been called, this method returns the requested products
+  /// in the order they should appear in the accessor.
+  /// @return requested polarisation products (an empty vector means no selection)
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& getPolarizationSelection() const throw();
   
 
 private:
@@ -192,12 +251,21 @@ private:
   boost::shared_ptr<ITableMeasureFieldSelector> itsEpochSelector;
   /// a name of the column containing visibility data
   std::string itsDataColumnName;   
+  /// names of the additional data columns
+  std::vector<std::string> itsExtraDataColumnNames;
   /// @brief channel selection
   /// @details The first field has the number of channels required, the second field is the
   /// start channel. If the first field is negative, no channel-based selection has been defined.
   /// This class actually doesn't care about the meaning of these two numbers and just passes them across.
   /// However, in the TableConstDataIterator we assume the meaning given above.
   std::pair<int, int> itsChannelSelection;
+  /// @brief number of adjacent channels averaged together
+  casacore::uInt itsChannelAveraging;
+  /// @brief requested polarisation products, empty if no selection has been done
+  casacore::Vector<casacore::Stokes::StokesTypes> itsPolSelection;
+
+  /// @brief fields declared as required, see chooseRequiredFields
+  int itsRequiredFields;
 };
   
 } // namespace accessors
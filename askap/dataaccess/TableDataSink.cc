@@ -0,0 +1,507 @@
+/// @file
+/// @brief data sink appending chunks to a new measurement set
+/// @details This class creates a measurement set from chunks of visibility data,
+/// e.g. after averaging or BDA, or for data received from a stream. Rows are
+/// preallocated in large blocks, columns are written with bulk puts and the bulk data
+/// are stored with tiled storage managers shaped to the chunk. The table is written
+/// by a background thread, so the producer can carry on with the next chunk.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+/// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Quanta/Stokes.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MFrequency.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableCopy.h>
+
+/// Local package
+#include <askap/dataaccess/TableDataSink.h>
+#include <askap/dataaccess/CubeTransposer.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/AccessTracer.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+ASKAP_LOGGER(logger, ".TableDataSink");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief convert indices to the type of the measurement set columns
+/// @param[in] in indices given by the accessor
+/// @param[out] out indices to write (resized as necessary)
+void toInt(const casacore::Vector<casacore::uInt> &in, casacore::Vector<casacore::Int> &out)
+{
+  out.resize(in.nelements());
+  for (casacore::uInt i = 0; i < in.nelements(); ++i) {
+       out[i] = static_cast<casacore::Int>(in[i]);
+  }
+}
+
+/// @brief receptors forming a polarisation product
+/// @details Circular (RR, RL, LR, LL) and linear (XX, XY, YX, YY) products are 
+/// formed by receptors 00, 01, 10 and 11, respectively. Stokes parameters are
+/// mapped to 00.
+/// @param[in] type polarisation product
+/// @param[out] first receptor of the first antenna
+/// @param[out] second receptor of the second antenna
+void receptors(casacore::Stokes::StokesTypes type, casacore::Int &first, casacore::Int &second)
+{
+  int index = 0;
+  if ((type >= casacore::Stokes::RR) && (type <= casacore::Stokes::LL)) {
+      index = type - casacore::Stokes::RR;
+  } else if ((type >= casacore::Stokes::XX) && (type <= casacore::Stokes::YY)) {
+      index = type - casacore::Stokes::XX;
+  }
+  first = index / 2;
+  second = index % 2;
+}
+
+} // anonymous namespace
+
+/// @brief create a new measurement set
+/// @details The table is created when the first chunk is written.
+/// @param[in] name name of the measurement set to create
+/// @param[in] templateMS measurement set the subtables are copied from (none if null)
+/// @param[in] capacity maximum number of chunks waiting to be written
+/// @param[in] blockRows number of rows added to the table at a time
+TableDataSink::TableDataSink(const std::string &name, const casacore::Table &templateMS,
+          size_t capacity, casacore::uInt blockRows) : itsName(name), itsTemplate(templateMS),
+          itsCapacity(capacity), itsBlockRows(blockRows), itsInterval(0.), itsNChannel(0), itsNPol(0),
+          itsNRow(0), itsNChunk(0), itsClosed(false), itsBusy(false), itsStop(false)
+{
+  ASKAPCHECK(capacity > 0, "Capacity of the data sink queue should be positive");
+  ASKAPCHECK(blockRows > 0, "Number of rows added at a time should be positive");
+}
+
+/// @brief close the measurement set
+/// @details Errors are logged, rather than thrown
+TableDataSink::~TableDataSink()
+{
+  try {
+     close();
+  }
+  catch (const std::exception &ex) {
+     ASKAPLOG_ERROR_STR(logger, "Writing of "<<itsName<<" failed: "<<ex.what());
+  }
+}
+
+/// @brief set up a converter to deliver the data in the frames used by this sink
+/// @param[in] conv converter of the source data source to set up
+void TableDataSink::configureConverter(IDataConverter &conv)
+{
+  // MJD 0 UTC as the origin, seconds
+  conv.setEpochFrame();
+  conv.setDirectionFrame(casacore::MDirection::Ref(casacore::MDirection::J2000));
+  conv.setFrequencyFrame(casacore::MFrequency::Ref(casacore::MFrequency::TOPO), "Hz");
+}
+
+/// @brief set the integration time
+/// @details The value is stored in INTERVAL and EXPOSURE of the following rows
+/// (zero by default).
+/// @param[in] interval integration time in seconds
+void TableDataSink::configureInterval(casacore::Double interval)
+{
+  ASKAPCHECK(interval >= 0., "Integration time should be non-negative, you have "<<interval);
+  itsInterval = interval;
+}
+
+/// @brief tile shape for the bulk data
+/// @details Tiles hold all polarisations and as many rows of the chunk as fit
+/// into theirMaxTileBytes of visibilities. If a single row exceeds this limit,
+/// channels are split between tiles.
+/// @param[in] nPol number of polarisation products
+/// @param[in] nChan number of channels
+/// @param[in] nRow number of rows in the chunk
+/// @return tile shape (nPol x nChannel x nRow)
+casacore::IPosition TableDataSink::tileShape(casacore::uInt nPol, casacore::uInt nChan, casacore::uInt nRow)
+{
+  const size_t cellBytes = size_t(nPol) * sizeof(casacore::Complex);
+  ASKAPDEBUGASSERT(cellBytes > 0);
+  const casacore::uInt tileChan = static_cast<casacore::uInt>(std::max<size_t>(1,
+                     std::min<size_t>(nChan, theirMaxTileBytes / cellBytes)));
+  const casacore::uInt tileRow = static_cast<casacore::uInt>(std::max<size_t>(1,
+                     std::min<size_t>(nRow, theirMaxTileBytes / (cellBytes * tileChan))));
+  return casacore::IPosition(3, nPol, tileChan, tileRow);
+}
+
+/// @brief append a chunk
+/// @details The data are copied, the accessor can be changed as soon as the method
+/// returns. The method waits while the queue is full.
+/// @param[in] acc accessor with the data of the chunk
+void TableDataSink::write(const IConstDataAccessor &acc)
+{
+  ASKAPCHECK(!itsClosed, "TableDataSink has already been closed");
+  if (acc.nRow() == 0) {
+      return;
+  }
+  if (itsMS.isNull()) {
+      create(acc);
+  }
+  if ((acc.nChannel() != itsNChannel) || (acc.nPol() != itsNPol)) {
+      ASKAPTHROW(DataAccessError, "Data sink requires the same number of channels and polarisations for "
+                 "all chunks, chunk "<<itsNChunk<<" has "<<acc.nChannel()<<" channels and "<<acc.nPol()<<
+                 " polarisations, the measurement set has "<<itsNChannel<<" and "<<itsNPol);
+  }
+  // the copy is done by the producer, the table is only touched by the background thread
+  Chunk chunk;
+  take(acc, chunk);
+  chunk.itsStartRow = itsNRow;
+  {
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    checkError();
+    if (itsQueue.size() >= itsCapacity) {
+        // time the producer is stalled waiting for the disk
+        const AccessTracer::Scope trace("sinkWait", "dataaccess");
+        while (itsQueue.size() >= itsCapacity && itsError.empty()) {
+               itsWrittenCondition.wait(lock);
+        }
+        checkError();
+    }
+    itsQueue.push_back(chunk);
+    if (!itsThread) {
+        itsThread.reset(new boost::thread(&TableDataSink::run, this));
+    }
+  }
+  itsQueuedCondition.notify_one();
+  itsNRow += acc.nRow();
+  ++itsNChunk;
+}
+
+/// @brief store all chunks written so far
+/// @details This is the barrier: the chunks are in the table when the method returns.
+/// An exception is thrown if any write has failed.
+void TableDataSink::flush()
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  if (!itsQueue.empty() || itsBusy) {
+      const AccessTracer::Scope trace("sinkFlush", "dataaccess");
+      while ((!itsQueue.empty() || itsBusy) && itsError.empty()) {
+             itsWrittenCondition.wait(lock);
+      }
+  }
+  checkError();
+}
+
+/// @brief finish writing
+/// @details All chunks are written, surplus rows are removed and the table is closed.
+/// No more chunks can be written.
+void TableDataSink::close()
+{
+  if (itsClosed) {
+      return;
+  }
+  itsClosed = true;
+  if (itsThread) {
+      {
+        boost::lock_guard<boost::mutex> lock(itsMutex);
+        itsStop = true;
+      }
+      itsQueuedCondition.notify_all();
+      itsThread->join();
+      itsThread.reset();
+  }
+  if (!itsMS.isNull()) {
+      // remove the rows preallocated after the last chunk, starting from the end
+      for (casacore::uInt64 row = itsMS.nrow(); row > itsNRow; --row) {
+           itsMS.removeRow(row - 1);
+      }
+      itsMS.flush();
+      ASKAPLOG_INFO_STR(logger, "Written "<<itsNRow<<" rows in "<<itsNChunk<<" chunks to "<<itsName);
+      itsMS = casacore::Table();
+  }
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  checkError();
+}
+
+/// @brief create the measurement set
+/// @param[in] acc accessor with the first chunk
+void TableDataSink::create(const IConstDataAccessor &acc)
+{
+  itsNChannel = acc.nChannel();
+  itsNPol = acc.nPol();
+  const casacore::IPosition cellShape(2, itsNPol, itsNChannel);
+  casacore::TableDesc td = casacore::MS::requiredTableDesc();
+  td.addColumn(casacore::ArrayColumnDesc<casacore::Complex>("DATA", "visibilities", cellShape,
+               casacore::ColumnDesc::FixedShape));
+  td.addColumn(casacore::ArrayColumnDesc<casacore::Float>("SIGMA_SPECTRUM", "noise per channel", cellShape,
+               casacore::ColumnDesc::FixedShape));
+  td.rwColumnDesc("FLAG").setShape(cellShape);
+  td.rwColumnDesc("SIGMA").setShape(casacore::IPosition(1, itsNPol));
+  td.rwColumnDesc("WEIGHT").setShape(casacore::IPosition(1, itsNPol));
+  casacore::SetupNewTable newMS(itsName, td, casacore::Table::New);
+  // metadata which rarely change from row to row
+  casacore::IncrementalStMan ism("ISMData");
+  casacore::StandardStMan ssm("SSMData", 32768);
+  newMS.bindAll(ism);
+  const char* perRowColumns[] = {"ANTENNA1", "ANTENNA2", "FEED1", "FEED2", "UVW", "SIGMA", "WEIGHT",
+                                 "FLAG_ROW"};
+  for (size_t i = 0; i < sizeof(perRowColumns) / sizeof(perRowColumns[0]); ++i) {
+       newMS.bindColumn(perRowColumns[i], ssm);
+  }
+  // bulk data are tiled, so each chunk is written into whole tiles
+  const casacore::IPosition tile = tileShape(itsNPol, itsNChannel, acc.nRow());
+  casacore::TiledShapeStMan dataMan("TiledData", tile);
+  casacore::TiledShapeStMan flagMan("TiledFlag", tile);
+  casacore::TiledShapeStMan sigmaMan("TiledSigma", tile);
+  newMS.bindColumn("DATA", dataMan);
+  newMS.bindColumn("FLAG", flagMan);
+  newMS.bindColumn("SIGMA_SPECTRUM", sigmaMan);
+  casacore::MeasurementSet ms(newMS, 0);
+  ms.createDefaultSubtables(casacore::Table::New);
+  itsMS = ms;
+  ASKAPLOG_INFO_STR(logger, "Created "<<itsName<<" with "<<itsNChannel<<" channels, "<<itsNPol<<
+                    " polarisations and tile shape "<<tile);
+  if (!itsTemplate.isNull()) {
+      copyMetadata();
+  }
+  writeSetup(acc);
+}
+
+/// @brief copy the subtables of the template measurement set
+/// @details Spectral window, polarisation and data description subtables are
+/// not copied, they are defined by the data written to this sink.
+void TableDataSink::copyMetadata()
+{
+  const casacore::TableRecord &keywords = itsMS.keywordSet();
+  const casacore::TableRecord &templateKeywords = itsTemplate.keywordSet();
+  for (casacore::uInt field = 0; field < keywords.nfields(); ++field) {
+       const casacore::String name = keywords.name(field);
+       if ((keywords.type(field) != casacore::TpTable) || (name == "SPECTRAL_WINDOW") ||
+           (name == "POLARIZATION") || (name == "DATA_DESCRIPTION") || !templateKeywords.isDefined(name)) {
+           continue;
+       }
+       // only the columns present in both subtables are copied
+       casacore::Table subtable = keywords.asTable(name);
+       casacore::TableCopy::copyRows(subtable, templateKeywords.asTable(name));
+  }
+}
+
+/// @brief define the spectral and polarisation setup
+/// @param[in] acc accessor with the first chunk
+void TableDataSink::writeSetup(const IConstDataAccessor &acc)
+{
+  casacore::MeasurementSet ms(itsMS);
+  {
+    casacore::Table spwTab(ms.spectralWindow());
+    spwTab.addRow(1);
+    const casacore::Vector<casacore::Double> &freqs = acc.frequency();
+    ASKAPDEBUGASSERT(freqs.nelements() == itsNChannel);
+    // the same width for all channels, taken from the spacing
+    const casacore::Double chanWidth = itsNChannel > 1 ? (freqs[itsNChannel - 1] - freqs[0]) / 
+                                       (itsNChannel - 1) : 0.;
+    const casacore::Vector<casacore::Double> widths(itsNChannel, chanWidth);
+    casacore::ScalarColumn<casacore::Int>(spwTab, "NUM_CHAN").put(0, itsNChannel);
+    casacore::ScalarColumn<casacore::String>(spwTab, "NAME").put(0, "");
+    casacore::ScalarColumn<casacore::Double>(spwTab, "REF_FREQUENCY").put(0, freqs[0]);
+    casacore::ScalarColumn<casacore::Double>(spwTab, "TOTAL_BANDWIDTH").put(0, itsNChannel * std::abs(chanWidth));
+    casacore::ScalarColumn<casacore::Int>(spwTab, "MEAS_FREQ_REF").put(0, casacore::MFrequency::TOPO);
+    casacore::ScalarColumn<casacore::Int>(spwTab, "NET_SIDEBAND").put(0, 1);
+    casacore::ScalarColumn<casacore::Int>(spwTab, "FREQ_GROUP").put(0, 0);
+    casacore::ScalarColumn<casacore::Int>(spwTab, "IF_CONV_CHAIN").put(0, 0);
+    casacore::ArrayColumn<casacore::Double>(spwTab, "CHAN_FREQ").put(0, freqs);
+    casacore::ArrayColumn<casacore::Double>(spwTab, "CHAN_WIDTH").put(0, widths);
+    casacore::ArrayColumn<casacore::Double>(spwTab, "EFFECTIVE_BW").put(0, widths);
+    casacore::ArrayColumn<casacore::Double>(spwTab, "RESOLUTION").put(0, widths);
+  }
+  {
+    casacore::Table polTab(ms.polarization());
+    polTab.addRow(1);
+    const casacore::Vector<casacore::Stokes::StokesTypes> &stokes = acc.stokes();
+    ASKAPDEBUGASSERT(stokes.nelements() == itsNPol);
+    casacore::Vector<casacore::Int> corrTypes(itsNPol);
+    casacore::Matrix<casacore::Int> corrProducts(2, itsNPol);
+    for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+         corrTypes[pol] = stokes[pol];
+         receptors(stokes[pol], corrProducts(0, pol), corrProducts(1, pol));
+    }
+    casacore::ScalarColumn<casacore::Int>(polTab, "NUM_CORR").put(0, itsNPol);
+    casacore::ArrayColumn<casacore::Int>(polTab, "CORR_TYPE").put(0, corrTypes);
+    casacore::ArrayColumn<casacore::Int>(polTab, "CORR_PRODUCT").put(0, corrProducts);
+  }
+  {
+    casacore::Table ddTab(ms.dataDescription());
+    ddTab.addRow(1);
+    casacore::ScalarColumn<casacore::Int>(ddTab, "SPECTRAL_WINDOW_ID").put(0, 0);
+    casacore::ScalarColumn<casacore::Int>(ddTab, "POLARIZATION_ID").put(0, 0);
+  }
+}
+
+/// @brief copy a chunk into the table order
+/// @param[in] acc accessor with the data of the chunk
+/// @param[out] chunk chunk to fill
+void TableDataSink::take(const IConstDataAccessor &acc, Chunk &chunk) const
+{
+  const casacore::uInt nRow = acc.nRow();
+  chunk.itsTime = acc.time();
+  chunk.itsInterval = itsInterval;
+  toInt(acc.antenna1(), chunk.itsAntenna1);
+  toInt(acc.antenna2(), chunk.itsAntenna2);
+  toInt(acc.feed1(), chunk.itsFeed1);
+  toInt(acc.feed2(), chunk.itsFeed2);
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.uvw();
+  ASKAPDEBUGASSERT(uvw.nelements() == nRow);
+  chunk.itsUVW.resize(3, nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            chunk.itsUVW(dim, row) = uvw[row](dim);
+       }
+  }
+  CubeTransposer::transpose(acc.visibility(), chunk.itsVis);
+  CubeTransposer::transpose(acc.flag(), chunk.itsFlag);
+  CubeTransposer::transpose(acc.noise(), chunk.itsSigma);
+  // per-row figures: weights are averaged over channels with non-zero noise
+  chunk.itsRowSigma.resize(itsNPol, nRow);
+  chunk.itsWeight.resize(itsNPol, nRow);
+  chunk.itsFlagRow.resize(nRow);
+  const casacore::Float *sigmaPtr = chunk.itsSigma.data();
+  const casacore::Bool *flagPtr = chunk.itsFlag.data();
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       casacore::Bool allFlagged = casacore::True;
+       for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+            double sumWeight = 0.;
+            casacore::uInt nValid = 0;
+            const size_t offset = pol + size_t(itsNPol) * itsNChannel * row;
+            for (casacore::uInt chan = 0; chan < itsNChannel; ++chan) {
+                 const size_t index = offset + size_t(itsNPol) * chan;
+                 allFlagged = allFlagged && flagPtr[index];
+                 if (sigmaPtr[index] > 0.) {
+                     sumWeight += 1. / (double(sigmaPtr[index]) * sigmaPtr[index]);
+                     ++nValid;
+                 }
+            }
+            const double weight = nValid > 0 ? sumWeight / nValid : 0.;
+            chunk.itsWeight(pol, row) = static_cast<casacore::Float>(weight);
+            chunk.itsRowSigma(pol, row) = weight > 0. ? static_cast<casacore::Float>(1. / std::sqrt(weight)) : 0.f;
+       }
+       chunk.itsFlagRow[row] = allFlagged;
+  }
+}
+
+/// @brief throw an exception if the background thread failed
+/// @details This method should be called with the mutex locked
+void TableDataSink::checkError()
+{
+  if (itsError.size()) {
+      ASKAPTHROW(DataAccessError, "Writing to "<<itsName<<" failed: "<<itsError);
+  }
+}
+
+/// @brief body of the background thread
+/// @details Any exception is caught and the message is kept to be reported
+/// by write or flush
+void TableDataSink::run()
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  while (true) {
+     while (itsQueue.empty() && !itsStop) {
+            itsQueuedCondition.wait(lock);
+     }
+     if (itsQueue.empty()) {
+         // stop is requested and everything has been written
+         break;
+     }
+     // the mutex is released while writing, so the producer can queue new chunks
+     const Chunk chunk = itsQueue.front();
+     itsQueue.pop_front();
+     itsBusy = true;
+     lock.unlock();
+     std::string error;
+     try {
+        const AccessTracer::Scope trace("sinkWrite", "dataaccess");
+        writeChunk(chunk);
+     }
+     catch (const std::exception &ex) {
+        error = ex.what();
+     }
+     lock.lock();
+     itsBusy = false;
+     if (error.size()) {
+         itsError = error;
+         itsQueue.clear();
+     }
+     itsWrittenCondition.notify_all();
+  }
+}
+
+/// @brief write a chunk to the table
+/// @param[in] chunk chunk to write
+void TableDataSink::writeChunk(const Chunk &chunk)
+{
+  const casacore::uInt nRow = chunk.itsVis.nplane();
+  const casacore::uInt64 endRow = chunk.itsStartRow + nRow;
+  if (itsMS.nrow() < endRow) {
+      // preallocate a whole block, surplus rows are removed by close
+      const casacore::uInt64 nNew = endRow - itsMS.nrow();
+      itsMS.addRow(std::max<casacore::uInt64>(nNew, itsBlockRows));
+  }
+  const casacore::Slicer rows(casacore::IPosition(1, chunk.itsStartRow), casacore::IPosition(1, nRow));
+  const casacore::Vector<casacore::Double> times(nRow, chunk.itsTime);
+  const casacore::Vector<casacore::Double> intervals(nRow, chunk.itsInterval);
+  const casacore::Vector<casacore::Int> zeros(nRow, 0);
+  casacore::ScalarColumn<casacore::Double>(itsMS, "TIME").putColumnRange(rows, times);
+  casacore::ScalarColumn<casacore::Double>(itsMS, "TIME_CENTROID").putColumnRange(rows, times);
+  casacore::ScalarColumn<casacore::Double>(itsMS, "INTERVAL").putColumnRange(rows, intervals);
+  casacore::ScalarColumn<casacore::Double>(itsMS, "EXPOSURE").putColumnRange(rows, intervals);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "ANTENNA1").putColumnRange(rows, chunk.itsAntenna1);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "ANTENNA2").putColumnRange(rows, chunk.itsAntenna2);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "FEED1").putColumnRange(rows, chunk.itsFeed1);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "FEED2").putColumnRange(rows, chunk.itsFeed2);
+  const char* zeroColumns[] = {"DATA_DESC_ID", "FIELD_ID", "ARRAY_ID", "OBSERVATION_ID",
+                               "PROCESSOR_ID", "SCAN_NUMBER"};
+  for (size_t i = 0; i < sizeof(zeroColumns) / sizeof(zeroColumns[0]); ++i) {
+       casacore::ScalarColumn<casacore::Int>(itsMS, zeroColumns[i]).putColumnRange(rows, zeros);
+  }
+  casacore::ScalarColumn<casacore::Int>(itsMS, "STATE_ID").putColumnRange(rows,
+                     casacore::Vector<casacore::Int>(nRow, -1));
+  casacore::ScalarColumn<casacore::Bool>(itsMS, "FLAG_ROW").putColumnRange(rows, chunk.itsFlagRow);
+  casacore::ArrayColumn<casacore::Double>(itsMS, "UVW").putColumnRange(rows, chunk.itsUVW);
+  casacore::ArrayColumn<casacore::Float>(itsMS, "SIGMA").putColumnRange(rows, chunk.itsRowSigma);
+  casacore::ArrayColumn<casacore::Float>(itsMS, "WEIGHT").putColumnRange(rows, chunk.itsWeight);
+  casacore::ArrayColumn<casacore::Complex>(itsMS, "DATA").putColumnRange(rows, chunk.itsVis);
+  casacore::ArrayColumn<casacore::Bool>(itsMS, "FLAG").putColumnRange(rows, chunk.itsFlag);
+  casacore::ArrayColumn<casacore::Float>(itsMS, "SIGMA_SPECTRUM").putColumnRange(rows, chunk.itsSigma);
+}
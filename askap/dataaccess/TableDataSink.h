@@ -0,0 +1,273 @@
+/// @file
+/// @brief data sink appending chunks to a new measurement set
+/// @details This class creates a measurement set from chunks of visibility data,
+/// e.g. after averaging or BDA, or for data received from a stream. Rows are
+/// preallocated in large blocks, columns are written with bulk puts and the bulk data
+/// are stored with tiled storage managers shaped to the chunk. The table is written
+/// by a background thread, so the producer can carry on with the next chunk.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TABLE_DATA_SINK_H
+#define ASKAP_ACCESSORS_TABLE_DATA_SINK_H
+
+// std includes
+#include <deque>
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/tables/Tables/Table.h>
+
+// own includes
+#include <askap/dataaccess/IDataSink.h>
+#include <askap/dataaccess/IDataConverter.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief data sink appending chunks to a new measurement set
+/// @details The measurement set is created with the first chunk, which defines the
+/// number of channels and polarisations (they should be the same for all chunks), the
+/// spectral window and the polarisation setup. Other subtables (antennas, feeds, fields,
+/// etc) are copied from the template measurement set, if given, or left empty otherwise.
+/// The accessor is expected to deliver time as MJD in seconds (UTC) and frequencies in Hz
+/// (topocentric), use configureConverter to set up the converter of the source accordingly.
+/// Noise is stored in SIGMA_SPECTRUM, SIGMA and WEIGHT are derived from it.
+///
+/// Chunks are copied into the table order by write and queued, the background thread
+/// adds rows in blocks of the given size and writes each chunk with one bulk put per
+/// column. The queue is bounded: write waits while the given number of chunks is waiting
+/// to be written. Errors encountered by the background thread are reported by the next
+/// call to write or flush. Surplus preallocated rows are removed by close. All methods are
+/// supposed to be called from the same thread.
+/// @ingroup dataaccess_tab
+class TableDataSink : virtual public IDataSink,
+                      private boost::noncopyable
+{
+public:
+  /// @brief create a new measurement set
+  /// @details The table is created when the first chunk is written.
+  /// @param[in] name name of the measurement set to create
+  /// @param[in] templateMS measurement set the subtables are copied from (none if null)
+  /// @param[in] capacity maximum number of chunks waiting to be written
+  /// @param[in] blockRows number of rows added to the table at a time
+  explicit TableDataSink(const std::string &name, const casacore::Table &templateMS = casacore::Table(),
+                         size_t capacity = 4, casacore::uInt blockRows = 65536);
+
+  /// @brief close the measurement set
+  /// @details Errors are logged, rather than thrown
+  ~TableDataSink();
+
+  /// @brief set up a converter to deliver the data in the frames used by this sink
+  /// @param[in] conv converter of the source data source to set up
+  static void configureConverter(IDataConverter &conv);
+
+  /// @brief set the integration time
+  /// @details The value is stored in INTERVAL and EXPOSURE of the following rows
+  /// (zero by default).
+  /// @param[in] interval integration time in seconds
+  void configureInterval(casacore::Double interval);
+
+  /// @brief append a chunk
+  /// @details The data are copied, the accessor can be changed as soon as the method
+  /// returns. The method waits while the queue is full.
+  /// @param[in] acc accessor with the data of the chunk
+  virtual void write(const IConstDataAccessor &acc);
+
+  /// @brief store all chunks written so far
+  /// @details This is the barrier: the chunks are in the table when the method returns.
+  /// An exception is thrown if any write has failed.
+  virtual void flush();
+
+  /// @brief finish writing
+  /// @details All chunks are written, surplus rows are removed and the table is closed.
+  /// No more chunks can be written.
+  void close();
+
+  /// @brief number of rows written so far
+  /// @details Rows of the chunks waiting to be written are counted
+  /// @return total number of rows
+  inline casacore::uInt64 nRow() const { return itsNRow; }
+
+  /// @brief number of chunks written so far
+  /// @return total number of chunks
+  inline casacore::uInt64 nChunk() const { return itsNChunk; }
+
+  /// @brief tile shape for the bulk data
+  /// @details Tiles hold all polarisations and as many rows of the chunk as fit
+  /// into theirMaxTileBytes of visibilities. If a single row exceeds this limit,
+  /// channels are split between tiles.
+  /// @param[in] nPol number of polarisation products
+  /// @param[in] nChan number of channels
+  /// @param[in] nRow number of rows in the chunk
+  /// @return tile shape (nPol x nChannel x nRow)
+  static casacore::IPosition tileShape(casacore::uInt nPol, casacore::uInt nChan, casacore::uInt nRow);
+
+  /// @brief maximum size of a tile of visibilities in bytes
+  static const size_t theirMaxTileBytes = 4 * 1024 * 1024;
+
+protected:
+  /// @brief one queued chunk in the table order
+  struct Chunk {
+     /// @brief first row of the chunk in the table
+     casacore::uInt64 itsStartRow;
+     /// @brief time stamp
+     casacore::Double itsTime;
+     /// @brief integration time
+     casacore::Double itsInterval;
+     /// @brief first antenna indices
+     casacore::Vector<casacore::Int> itsAntenna1;
+     /// @brief second antenna indices
+     casacore::Vector<casacore::Int> itsAntenna2;
+     /// @brief first feed indices
+     casacore::Vector<casacore::Int> itsFeed1;
+     /// @brief second feed indices
+     casacore::Vector<casacore::Int> itsFeed2;
+     /// @brief uvw (3 x nRow)
+     casacore::Matrix<casacore::Double> itsUVW;
+     /// @brief visibilities (nPol x nChannel x nRow)
+     casacore::Cube<casacore::Complex> itsVis;
+     /// @brief flags (nPol x nChannel x nRow)
+     casacore::Cube<casacore::Bool> itsFlag;
+     /// @brief noise (nPol x nChannel x nRow)
+     casacore::Cube<casacore::Float> itsSigma;
+     /// @brief noise per row (nPol x nRow)
+     casacore::Matrix<casacore::Float> itsRowSigma;
+     /// @brief weight per row (nPol x nRow)
+     casacore::Matrix<casacore::Float> itsWeight;
+     /// @brief true for rows with all data flagged
+     casacore::Vector<casacore::Bool> itsFlagRow;
+  };
+
+  /// @brief create the measurement set
+  /// @param[in] acc accessor with the first chunk
+  void create(const IConstDataAccessor &acc);
+
+  /// @brief copy the subtables of the template measurement set
+  /// @details Spectral window, polarisation and data description subtables are
+  /// not copied, they are defined by the data written to this sink.
+  void copyMetadata();
+
+  /// @brief define the spectral and polarisation setup
+  /// @param[in] acc accessor with the first chunk
+  void writeSetup(const IConstDataAccessor &acc);
+
+  /// @brief copy a chunk into the table order
+  /// @param[in] acc accessor with the data of the chunk
+  /// @param[out] chunk chunk to fill
+  void take(const IConstDataAccessor &acc, Chunk &chunk) const;
+
+  /// @brief body of the background thread
+  /// @details Any exception is caught and the message is kept to be reported
+  /// by write or flush
+  void run();
+
+  /// @brief write a chunk to the table
+  /// @param[in] chunk chunk to write
+  void writeChunk(const Chunk &chunk);
+
+  /// @brief throw an exception if the background thread failed
+  /// @details This method should be called with the mutex locked
+  void checkError();
+
+private:
+  /// @brief name of the measurement set
+  std::string itsName;
+
+  /// @brief template measurement set (null if not given)
+  casacore::Table itsTemplate;
+
+  /// @brief maximum number of chunks waiting to be written
+  const size_t itsCapacity;
+
+  /// @brief number of rows added at a time
+  const casacore::uInt itsBlockRows;
+
+  /// @brief integration time
+  casacore::Double itsInterval;
+
+  /// @brief measurement set (null until the first chunk is written)
+  casacore::Table itsMS;
+
+  /// @brief number of channels
+  casacore::uInt itsNChannel;
+
+  /// @brief number of polarisation products
+  casacore::uInt itsNPol;
+
+  /// @brief total number of rows
+  casacore::uInt64 itsNRow;
+
+  /// @brief total number of chunks
+  casacore::uInt64 itsNChunk;
+
+  /// @brief true, if close has been called
+  bool itsClosed;
+
+  /// @brief chunks waiting to be written
+  std::deque<Chunk> itsQueue;
+
+  /// @brief true, while the background thread is writing a chunk
+  bool itsBusy;
+
+  /// @brief true, if the background thread has to finish
+  bool itsStop;
+
+  /// @brief error message of the failed write, empty if there was no error
+  std::string itsError;
+
+  /// @brief mutex protecting the queue and the flags above
+  mutable boost::mutex itsMutex;
+
+  /// @brief condition signalled when a chunk is queued or the thread has to finish
+  boost::condition_variable itsQueuedCondition;
+
+  /// @brief condition signalled when a chunk has been written
+  boost::condition_variable itsWrittenCondition;
+
+  /// @brief background thread, empty if it has not been started yet
+  boost::shared_ptr<boost::thread> itsThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_DATA_SINK_H
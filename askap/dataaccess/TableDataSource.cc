@@ -32,6 +32,9 @@
 // casa includes
 #include <casacore/tables/Tables/TableRecord.h>
 
+// std includes
+#include <algorithm>
+
 // own includes
 #include <askap/dataaccess/TableDataSource.h>
 #include <askap/dataaccess/TableDataIterator.h>
@@ -39,6 +42,9 @@
 #include <askap/dataaccess/IDataConverterImpl.h>
 #include <askap/dataaccess/ITableDataSelectorImpl.h>
 #include <askap/dataaccess/SubtableInfoHolder.h>
+#include <askap/dataaccess/CompressingBufferManager.h>
+#include <askap/dataaccess/SharedTableWriter.h>
+#include <askap/dataaccess/ThreadAffinity.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -49,12 +55,18 @@ using namespace askap::accessors;
 /// removed, if it already exists.   
 /// @param[in] dataColumn a name of the data column used by default
 ///                       (default is DATA)
+/// @param[in] bufferMemory memory limit in bytes for HYBRID_BUFFERS 
+///                       (0 means the default of HybridBufferManager)
+/// @param[in] lock table locking options, e.g. UserLocking for a writer holding
+///                       the lock for its lifetime (see TableLocking)
 TableDataSource::TableDataSource(const std::string &fname,
-                int opt, const std::string &dataColumn) :
-         TableInfoAccessor(casacore::Table(fname, (opt & MEMORY_BUFFERS) && 
+                int opt, const std::string &dataColumn, size_t bufferMemory,
+                const casacore::TableLock &lock) :
+         TableInfoAccessor(openTable(fname, 
+                  (bufferStorage(opt) != SubtableInfoHolder::TABLE_BUFFERS) && 
 				  !(opt & REMOVE_BUFFERS) && !(opt & WRITE_PERMITTED) ? 
-				      casacore::Table::Old : casacore::Table::Update),
-						opt & MEMORY_BUFFERS, dataColumn)
+				      casacore::Table::Old : casacore::Table::Update, opt & MEMORY_MAPPED, lock),
+				  bufferStorage(opt), dataColumn, bufferMemory), itsWriteBehind(0)
 {
   if (opt & REMOVE_BUFFERS) {
       if (table().keywordSet().isDefined("BUFFERS")) {
@@ -67,6 +79,23 @@ TableDataSource::TableDataSource(const std::string &fname,
   }
 }
 
+/// @brief storage of the buffers for the given options
+/// @param[in] opt options from TableDataSourceOptions, can be or'ed
+/// @return one of the SubtableInfoHolder::BufferStorage values
+int TableDataSource::bufferStorage(int opt)
+{
+  if (opt & MEMORY_BUFFERS) {
+      return SubtableInfoHolder::MEMORY_BUFFERS;
+  }
+  if (opt & FILE_BUFFERS) {
+      return SubtableInfoHolder::FILE_BUFFERS;
+  }
+  if (opt & HYBRID_BUFFERS) {
+      return SubtableInfoHolder::HYBRID_BUFFERS;
+  }
+  return SubtableInfoHolder::TABLE_BUFFERS;
+}
+
 /// @brief obtain a read/write iterator
 /// @details 
 /// get a read/write iterator over a selected part of the dataset 
@@ -101,7 +130,109 @@ boost::shared_ptr<IDataIterator> TableDataSource::createIterator(const
        ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
                  "converter are received by the createIterator method");
    }
-   return boost::shared_ptr<IDataIterator>(new TableDataIterator(
+   boost::shared_ptr<TableDataIterator> it(new TableDataIterator(
                 getTableManager(),implSel,implConv,uvwMachineCacheSize(),
-                uvwMachineCacheTolerance(), maxChunkSize())); 
+                uvwMachineCacheTolerance(), maxChunkSize(), nativeLayout(), writeBehind(),
+                rotatedUVWStore(), boost::shared_ptr<SharedTableWriter>(), chunkMemoryBudget()));
+   if (statistics()) {
+       it->setStatistics(statistics());
+   }
+   if (qcStatistics()) {
+       it->setQCStatistics(qcStatistics());
+   }
+   it->setCompactVisibilityFormat(compactVisibilityFormat());
+   return it;
+}
+
+/// @brief get a number of read/write iterators over disjoint parts of the dataset
+/// @details This is the read/write counterpart of createPartitionedIterators. The
+/// iterators can be driven from different threads (one thread per iterator) and
+/// modify the data concurrently. As the table system is not thread-safe, all
+/// iterators hand the modified visibilities and flags over to a single writer
+/// thread shared between them (see SharedTableWriter), which writes them while
+/// the iterators proceed to the next chunks. Up to writeBehind chunks (at least one)
+/// per partition can wait to be written, a thread modifying data faster than they
+/// can be written waits. TableDataIterator::sync of any iterator makes sure the
+/// changes made by all of them are in the table.
+/// @param[in] sel a shared pointer to the selector object defining 
+///            which subset of the data is used (it is not changed)
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @param[in] type type of partitioning
+/// @param[in] nPartitions number of partitions (and iterators)
+/// @param[in] numaAware if true, partitions are bound to NUMA nodes (see 
+///            createPartitionedIterators)
+/// @return a vector of shared pointers to iterators, one per partition
+std::vector<boost::shared_ptr<IDataIterator> > TableDataSource::createPartitionedRWIterators(
+           const IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv,
+           PartitionType type, casacore::uInt nPartitions, bool numaAware) const
+{
+   ASKAPCHECK(nPartitions > 0, "Number of partitions should be a positive number");
+   boost::shared_ptr<IDataConverterImpl const> implConv=
+           boost::dynamic_pointer_cast<IDataConverterImpl const>(conv);
+   if (!implConv) {
+       ASKAPTHROW(DataAccessLogicError, "Incompatible converter is received by "
+                  "the createPartitionedRWIterators method");
+   }
+   const boost::shared_ptr<SharedTableWriter> writer(new SharedTableWriter(
+                std::max(writeBehind(), casacore::uInt(1)) * nPartitions));
+   std::vector<boost::shared_ptr<IDataIterator> > result;
+   result.reserve(nPartitions);
+   const casacore::uInt nNodes = numaAware ? ThreadAffinity::numberOfNumaNodes() : 1;
+   for (casacore::uInt part = 0; part < nPartitions; ++part) {
+        const boost::shared_ptr<ITableDataSelectorImpl const> implSel =
+                boost::dynamic_pointer_cast<ITableDataSelectorImpl const>(
+                          partitionSelector(sel, type, part, nPartitions));
+        ASKAPDEBUGASSERT(implSel);
+        boost::shared_ptr<TableDataIterator> it(new TableDataIterator(
+                getTableManager(),implSel,implConv,uvwMachineCacheSize(),
+                uvwMachineCacheTolerance(), maxChunkSize(), nativeLayout(), writeBehind(),
+                rotatedUVWStore(), writer, chunkMemoryBudget()));
+        if (statistics()) {
+            it->setStatistics(statistics());
+        }
+        if (qcStatistics()) {
+            it->setQCStatistics(qcStatistics());
+        }
+        it->setCompactVisibilityFormat(compactVisibilityFormat());
+        if (nNodes > 1) {
+            it->setAffinity(ThreadAffinity::ofNumaNode(part % nNodes));
+        }
+        result.push_back(it);
+   }
+   return result;
+}
+
+/// @brief configure deferred writing of the modified data
+/// @details By default, visibilities and flags modified via the read-write iterator
+/// are written to the table at each iteration step. If the write-behind mode is
+/// switched on, modified chunks are collected and written in a separate thread, 
+/// while the following chunk is being processed. The write is started as soon as the 
+/// given number of chunks is collected and the bulk data of the current chunk have been
+/// read. TableDataIterator::sync can be used to make sure the table is up to date.
+/// @param[in] nChunks number of chunks to collect before writing, zero means that
+/// the data are written synchronously
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableDataSource::configureWriteBehind(casacore::uInt nChunks)
+{
+  itsWriteBehind = nChunks;
+}
+
+/// @brief configure compact storage of the given buffer
+/// @details Buffers hold full precision visibilities by default. Some of them 
+/// (e.g. model visibilities) can be stored with less precision to reduce the memory
+/// and I/O, see BufferCodec for the available codecs. The codec is not stored
+/// with the buffer, so it should be set before the buffer is written and the same
+/// codec should be used to read it back (including persistent disk-based buffers).
+/// @param[in] name name of the buffer
+/// @param[in] codec codec to use (BufferCodec::NONE to store the full precision)
+/// @note The setting applies to all iterators of this data source immediately.
+void TableDataSource::configureBufferCompression(const std::string &name, 
+                                                 BufferCodec::Type codec)
+{
+  const CompressingBufferManager *bufferManager = dynamic_cast<const CompressingBufferManager*>(
+              &(subtableInfo().getBufferManager()));
+  ASKAPCHECK(bufferManager != 0, "Buffer manager doesn't support compression");
+  bufferManager->setCodec(name, codec);
 }
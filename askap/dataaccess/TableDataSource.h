@@ -33,6 +33,7 @@
 #define ASKAP_ACCESSORS_TABLE_DATA_SOURCE_H
 
 #include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/BufferCodec.h>
 #include <askap/dataaccess/IDataSource.h>
 
 namespace askap {
@@ -59,7 +60,17 @@ public:
      /// create buffers in memory (via MemoryTable)
      MEMORY_BUFFERS = 2,
      /// allow to write to the measurement set
-     WRITE_PERMITTED = 4
+     WRITE_PERMITTED = 4,
+     /// access columns stored with tiled storage managers via memory-mapped files
+     /// (see TableConstDataSource::openTable)
+     MEMORY_MAPPED = 8,
+     /// keep buffers in flat binary files next to the measurement set instead
+     /// of the BUFFERS subtable (see FileBufferManager), MEMORY_BUFFERS takes precedence
+     FILE_BUFFERS = 16,
+     /// keep buffers in memory up to the given size and spill the least recently used
+     /// ones into flat binary files (see HybridBufferManager), MEMORY_BUFFERS and
+     /// FILE_BUFFERS take precedence
+     HYBRID_BUFFERS = 32
   };
   
   /// construct a read-write data source object
@@ -67,8 +78,13 @@ public:
   /// @param[in] opt options from TableDataSourceOptions, can be or'ed
   /// @param[in] dataColumn a name of the data column used by default
   ///                       (default is DATA)
+  /// @param[in] bufferMemory memory limit in bytes for HYBRID_BUFFERS 
+  ///                       (0 means the default of HybridBufferManager)
+  /// @param[in] lock table locking options, e.g. UserLocking for a writer holding
+  ///                       the lock for its lifetime (see TableLocking)
   explicit TableDataSource(const std::string &fname, int opt =
-              TableDataSource::DEFAULT, const std::string &dataColumn = "DATA");
+              TableDataSource::DEFAULT, const std::string &dataColumn = "DATA",
+              size_t bufferMemory = 0, const casacore::TableLock &lock = casacore::TableLock());
 
   /// @brief obtain a read/write iterator
   /// @details 
@@ -96,6 +112,69 @@ public:
   	   
   // we need this to get access to the overloaded syntax in the base class 
   using IDataSource::createIterator;	   
+
+  /// @brief get a number of read/write iterators over disjoint parts of the dataset
+  /// @details This is the read/write counterpart of createPartitionedIterators. The
+  /// iterators can be driven from different threads (one thread per iterator) and
+  /// modify the data concurrently. As the table system is not thread-safe, all
+  /// iterators hand the modified visibilities and flags over to a single writer
+  /// thread shared between them (see SharedTableWriter), which writes them while
+  /// the iterators proceed to the next chunks. Up to writeBehind chunks (at least one)
+  /// per partition can wait to be written, a thread modifying data faster than they
+  /// can be written waits. TableDataIterator::sync of any iterator makes sure the
+  /// changes made by all of them are in the table.
+  /// @param[in] sel a shared pointer to the selector object defining 
+  ///            which subset of the data is used (it is not changed)
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @param[in] type type of partitioning
+  /// @param[in] nPartitions number of partitions (and iterators)
+  /// @param[in] numaAware if true, partitions are bound to NUMA nodes (see 
+  ///            createPartitionedIterators)
+  /// @return a vector of shared pointers to iterators, one per partition
+  std::vector<boost::shared_ptr<IDataIterator> > createPartitionedRWIterators(
+             const IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv,
+             PartitionType type, casacore::uInt nPartitions, bool numaAware = false) const;
+
+  /// @brief configure deferred writing of the modified data
+  /// @details By default, visibilities and flags modified via the read-write iterator
+  /// are written to the table at each iteration step. If the write-behind mode is
+  /// switched on, modified chunks are collected and written in a separate thread, 
+  /// while the following chunk is being processed. The write is started as soon as the 
+  /// given number of chunks is collected and the bulk data of the current chunk have been
+  /// read. TableDataIterator::sync can be used to make sure the table is up to date.
+  /// @param[in] nChunks number of chunks to collect before writing, zero means that
+  /// the data are written synchronously
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureWriteBehind(casacore::uInt nChunks = 1);
+
+  /// @brief configure compact storage of the given buffer
+  /// @details Buffers hold full precision visibilities by default. Some of them 
+  /// (e.g. model visibilities) can be stored with less precision to reduce the memory
+  /// and I/O, see BufferCodec for the available codecs. The codec is not stored
+  /// with the buffer, so it should be set before the buffer is written and the same
+  /// codec should be used to read it back (including persistent disk-based buffers).
+  /// @param[in] name name of the buffer
+  /// @param[in] codec codec to use (BufferCodec::NONE to store the full precision)
+  /// @note The setting applies to all iterators of this data source immediately.
+  void configureBufferCompression(const std::string &name, BufferCodec::Type codec);
+
+protected:
+  /// @brief current setting of the write-behind mode
+  /// @return number of chunks collected before writing, zero means that the data are written
+  /// synchronously (the current setting, affects future iterators)
+  inline casacore::uInt writeBehind() const {return itsWriteBehind;}
+
+  /// @brief storage of the buffers for the given options
+  /// @param[in] opt options from TableDataSourceOptions, can be or'ed
+  /// @return one of the SubtableInfoHolder::BufferStorage values
+  static int bufferStorage(int opt);
+
+private:
+  /// @brief number of modified chunks collected before writing
+  /// @details See configureWriteBehind for details.
+  casacore::uInt itsWriteBehind;
 };
  
 } // namespace accessors
@@ -58,13 +58,16 @@ TableInfoAccessor::TableInfoAccessor(const
 /// @details This version of the constructor creates a TableManager
 /// object for a given table and stores it as ISubtableInfoHolder 
 /// @param tab a measurement set table to work with
-/// @param useMemBuffer if true, buffers in memory will be created
-/// instead of the disk-based buffers
+/// @param bufferStorage storage for the buffers, one of the
+/// SubtableInfoHolder::BufferStorage values (true means buffers in memory
+/// instead of the disk-based buffers)
 /// @param[in] dataColumn a name of the data column used by default
 ///                       (default is DATA)
+/// @param[in] bufferMemory memory limit in bytes for the hybrid buffers 
+/// (0 means the default limit)
 TableInfoAccessor::TableInfoAccessor(const casacore::Table &tab, 
-                  bool useMemBuffer, const std::string &dataColumn) :
-        itsTableManager(new TableManager(tab,useMemBuffer,dataColumn)) {}
+                  int bufferStorage, const std::string &dataColumn, size_t bufferMemory) :
+        itsTableManager(new TableManager(tab,bufferStorage,dataColumn,bufferMemory)) {}
 
 
 /// @return a non-const reference to Table held by this object
@@ -71,11 +71,14 @@ struct TableInfoAccessor : virtual public ITableInfoAccessor {
   /// @details This version of the constructor creates a TableManager
   /// object for a given table and stores it as ISubtableInfoHolder 
   /// @param tab a measurement set table to work with
-  /// @param useMemBuffer if true, buffers in memory will be created
-  /// instead of the disk-based buffers
+  /// @param bufferStorage storage for the buffers, one of the
+  /// SubtableInfoHolder::BufferStorage values (true means buffers in memory
+  /// instead of the disk-based buffers)
   /// @param[in] dataColumn a name of the data column used by default
-  TableInfoAccessor(const casacore::Table &tab, bool useMemBuffer=false,
-                    const std::string &dataColumn = "DATA"); 
+  /// @param[in] bufferMemory memory limit in bytes for the hybrid buffers 
+  /// (0 means the default limit)
+  TableInfoAccessor(const casacore::Table &tab, int bufferStorage = 0,
+                    const std::string &dataColumn = "DATA", size_t bufferMemory = 0); 
   
   /// @return a non-const reference to Table held by this object
   virtual casacore::Table& table() const throw();
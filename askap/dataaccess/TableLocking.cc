@@ -0,0 +1,114 @@
+/// @file
+/// @brief locking policy used to open tables
+/// @details By default casacore tables are opened with auto-locking: a lock is acquired and
+/// released around every access and the lock file is synchronised each time. On a shared
+/// file system with many concurrent readers this adds latency to every access and serialises
+/// the processes. This helper converts the name of a locking policy (e.g. from a parset) into
+/// casacore::TableLock and opens tables with it, acquiring a long-held lock if the policy
+/// requires explicit locking.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// own includes
+#include <askap/dataaccess/TableLocking.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/IO/FileLocker.h>
+
+// boost includes
+#include <boost/algorithm/string/case_conv.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief convert the name of the policy into the lock options
+/// @param[in] name name of the policy (see above)
+/// @return lock options
+/// @throw AskapError if the name is not recognised
+casacore::TableLock TableLocking::lockOptions(const std::string &name)
+{
+  const std::string policy = boost::algorithm::to_lower_copy(name);
+  if (policy == "default") {
+      return casacore::TableLock(casacore::TableLock::DefaultLocking);
+  } else if (policy == "auto") {
+      return casacore::TableLock(casacore::TableLock::AutoLocking);
+  } else if (policy == "autonoread") {
+      return casacore::TableLock(casacore::TableLock::AutoNoReadLocking);
+  } else if (policy == "user") {
+      return casacore::TableLock(casacore::TableLock::UserLocking);
+  } else if (policy == "usernoread") {
+      return casacore::TableLock(casacore::TableLock::UserNoReadLocking);
+  } else if (policy == "permanent") {
+      return casacore::TableLock(casacore::TableLock::PermanentLocking);
+  } else if (policy == "none") {
+      return casacore::TableLock(casacore::TableLock::NoLocking);
+  }
+  ASKAPTHROW(AskapError, "Unknown table locking policy "<<name<<
+             ", use default, auto, autonoread, user, usernoread, permanent or none");
+}
+
+/// @brief open a table with the given lock options
+/// @details For user locking, a read lock (for Table::Old) or a write lock (for other
+/// options) is acquired straight away and held until the table is closed, so the accesses
+/// don't need to lock the table one by one. A read lock is not taken for UserNoReadLocking.
+/// @param[in] fname file name of the table
+/// @param[in] lock lock options
+/// @param[in] option table option (e.g. casacore::Table::Old or casacore::Table::Update)
+/// @param[in] tsmOption options of the tiled storage managers (e.g. memory mapping)
+/// @return table object
+casacore::Table TableLocking::open(const std::string &fname, const casacore::TableLock &lock,
+                casacore::Table::TableOption option, const casacore::TSMOption &tsmOption)
+{
+  casacore::Table tab(fname, lock, option, tsmOption);
+  lockIfRequired(tab, lock, option != casacore::Table::Old);
+  return tab;
+}
+
+/// @brief acquire a long-held lock if required by the lock options
+/// @details This method is used by open and for newly created tables.
+/// @param[in] tab table (already open with the given lock options)
+/// @param[in] lock lock options
+/// @param[in] write true if the table is to be written
+void TableLocking::lockIfRequired(casacore::Table &tab, const casacore::TableLock &lock, bool write)
+{
+  const casacore::TableLock::LockOption option = lock.option();
+  if ((option != casacore::TableLock::UserLocking) && (option != casacore::TableLock::UserNoReadLocking)) {
+      return;
+  }
+  if (write) {
+      // wait for other writers to finish, the lock is released when the table is closed
+      ASKAPCHECK(tab.lock(casacore::FileLocker::Write, 0), "Unable to acquire a write lock for table "<<
+                 tab.tableName());
+  } else if (option == casacore::TableLock::UserLocking) {
+      ASKAPCHECK(tab.lock(casacore::FileLocker::Read, 0), "Unable to acquire a read lock for table "<<
+                 tab.tableName());
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
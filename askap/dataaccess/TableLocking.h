@@ -0,0 +1,94 @@
+/// @file
+/// @brief locking policy used to open tables
+/// @details By default casacore tables are opened with auto-locking: a lock is acquired and
+/// released around every access and the lock file is synchronised each time. On a shared
+/// file system with many concurrent readers this adds latency to every access and serialises
+/// the processes. This helper converts the name of a locking policy (e.g. from a parset) into
+/// casacore::TableLock and opens tables with it, acquiring a long-held lock if the policy
+/// requires explicit locking.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_TABLE_LOCKING_H
+#define ASKAP_ACCESSORS_TABLE_LOCKING_H
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableLock.h>
+#include <casacore/tables/DataMan/TSMOption.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief locking policy used to open tables
+/// @details The following policies are recognised (case-insensitive):
+/// "default" - the casacore default (auto-locking unless the table is already open),
+/// "auto" - auto-locking with read locks,
+/// "autonoread" - auto-locking without read locks,
+/// "user" - locks are acquired explicitly (a long-held lock is taken when the table is opened),
+/// "usernoread" - as "user", but read-only tables are accessed without any lock,
+/// "permanent" - the lock is acquired when the table is opened and held until it is closed,
+/// "none" - no locking at all, only safe for read-only access or a single writer.
+/// NoLocking is the cheapest option for read-only jobs, user locking is appropriate for a
+/// writer which keeps the table to itself for a long time.
+/// @ingroup dataaccess_tab
+struct TableLocking {
+
+  /// @brief convert the name of the policy into the lock options
+  /// @param[in] name name of the policy (see above)
+  /// @return lock options
+  /// @throw AskapError if the name is not recognised
+  static casacore::TableLock lockOptions(const std::string &name);
+
+  /// @brief open a table with the given lock options
+  /// @details For user locking, a read lock (for Table::Old) or a write lock (for other
+  /// options) is acquired straight away and held until the table is closed, so the accesses
+  /// don't need to lock the table one by one. A read lock is not taken for UserNoReadLocking.
+  /// @param[in] fname file name of the table
+  /// @param[in] lock lock options
+  /// @param[in] option table option (e.g. casacore::Table::Old or casacore::Table::Update)
+  /// @param[in] tsmOption options of the tiled storage managers (e.g. memory mapping)
+  /// @return table object
+  static casacore::Table open(const std::string &fname, const casacore::TableLock &lock,
+                casacore::Table::TableOption option = casacore::Table::Old,
+                const casacore::TSMOption &tsmOption = casacore::TSMOption());
+
+  /// @brief acquire a long-held lock if required by the lock options
+  /// @details This method is used by open and for newly created tables.
+  /// @param[in] tab table (already open with the given lock options)
+  /// @param[in] lock lock options
+  /// @param[in] write true if the table is to be written
+  static void lockIfRequired(casacore::Table &tab, const casacore::TableLock &lock, bool write);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_LOCKING_H
@@ -106,12 +106,15 @@ struct TableManager : virtual public ITableManager,
 {
   /// construct a table/derived info manager from the table object
   /// @param[in] tab MS table to work with
-  /// @param[in] useMemBuffers if true, buffers in memory will be created
-  /// instead of the disk-based buffers
+  /// @param[in] bufferStorage storage for the buffers, one of the
+  /// SubtableInfoHolder::BufferStorage values (true means buffers in memory
+  /// instead of the disk-based buffers)
   /// @param[in] dataColumn name of the data column used by default
-  explicit TableManager(const casacore::Table &tab, bool useMemBuffers,
-                        const std::string &dataColumn = "DATA") :
-           TableHolder(tab), SubtableInfoHolder(useMemBuffers),
+  /// @param[in] bufferMemory memory limit in bytes for the hybrid buffers 
+  /// (0 means the default limit)
+  explicit TableManager(const casacore::Table &tab, int bufferStorage,
+                        const std::string &dataColumn = "DATA", size_t bufferMemory = 0) :
+           TableHolder(tab), SubtableInfoHolder(bufferStorage, bufferMemory),
            MiscTableInfoHolder(dataColumn) {}
 };
 
@@ -39,6 +39,7 @@
 #include <askap/dataaccess/TableScalarFieldSelector.h>
 #include <askap/dataaccess/DataAccessError.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
+#include <casacore/tables/Tables/TableRecord.h>
 
 
 using namespace askap;
@@ -50,6 +51,7 @@ using namespace casa;
 /// @param feedID the sequence number of feed to choose
 void TableScalarFieldSelector::chooseFeed(casacore::uInt feedID)
 {
+   itsRowCriteria.chooseFeed(static_cast<casacore::Int>(feedID));
    if (itsTableSelector.isNull()) {
        itsTableSelector= (table().col("FEED1") ==
                   static_cast<casacore::Int>(feedID)) && (table().col("FEED2") ==
@@ -66,6 +68,8 @@ void TableScalarFieldSelector::chooseFeed(casacore::uInt feedID)
 /// @param[in] value index value
 void TableScalarFieldSelector::chooseUserDefinedIndex(const std::string &column, const casacore::uInt value)
 {
+   // user-defined columns are not indexed
+   itsRowCriteria.disable();
    if (itsTableSelector.isNull()) {
        itsTableSelector = (table().col(column) == value);
    } else {
@@ -80,6 +84,7 @@ void TableScalarFieldSelector::chooseUserDefinedIndex(const std::string &column,
 void TableScalarFieldSelector::chooseBaseline(casacore::uInt ant1,
                                               casacore::uInt ant2)
 {
+   itsRowCriteria.chooseBaseline(static_cast<casacore::Int>(ant1), static_cast<casacore::Int>(ant2));
    if (itsTableSelector.isNull()) {
        itsTableSelector= (table().col("ANTENNA1") ==
            static_cast<casacore::Int>(ant1)) && (table().col("ANTENNA2") ==
@@ -95,6 +100,7 @@ void TableScalarFieldSelector::chooseBaseline(casacore::uInt ant1,
 /// @param[in] ant the sequence number of antenna
 void TableScalarFieldSelector::chooseAntenna(casacore::uInt ant)
 {
+   itsRowCriteria.chooseAntenna(static_cast<casacore::Int>(ant));
    if (itsTableSelector.isNull()) {
        itsTableSelector=(table().col("ANTENNA1") ==
            static_cast<casacore::Int>(ant)) || (table().col("ANTENNA2") ==
@@ -106,12 +112,78 @@ void TableScalarFieldSelector::chooseAntenna(casacore::uInt ant)
    }
 }
 
+/// @brief choose a set of baselines
+/// @details Rows are selected if (ANTENNA1, ANTENNA2) is one of the given pairs. This
+/// is equivalent to chaining or'ed chooseBaseline selections, but is done in one go
+/// (via a set membership test in the table expression or via the row index).
+/// Like chooseDataColumn, this is a table-specific operation.
+/// @param[in] baselines pairs of the first and second antenna (empty vector selects nothing)
+void TableScalarFieldSelector::chooseBaselines(const std::vector<std::pair<casacore::uInt, 
+                                               casacore::uInt> > &baselines)
+{
+   std::vector<std::pair<casacore::Int, casacore::Int> > pairs;
+   pairs.reserve(baselines.size());
+   // the table expression matches baselines via ANTENNA1 * nAntennae + ANTENNA2,
+   // antennae which are not in the ANTENNA table can't be present in the main table
+   const casacore::uInt nAnt = subtableInfo().getAntenna().getNumberOfAntennae();
+   std::vector<casacore::Int> keys;
+   keys.reserve(baselines.size());
+   for (std::vector<std::pair<casacore::uInt, casacore::uInt> >::const_iterator ci = baselines.begin();
+        ci != baselines.end(); ++ci) {
+        pairs.push_back(std::make_pair(static_cast<casacore::Int>(ci->first), 
+                                       static_cast<casacore::Int>(ci->second)));
+        if ((ci->first < nAnt) && (ci->second < nAnt)) {
+            keys.push_back(static_cast<casacore::Int>(ci->first * nAnt + ci->second));
+        }
+   }
+   itsRowCriteria.chooseBaselines(pairs);
+   TableExprNode tempNode;
+   if (keys.size()) {
+       tempNode = (table().col("ANTENNA1") * static_cast<casacore::Int>(nAnt) + 
+                   table().col("ANTENNA2")).in(TableExprNode(casacore::Vector<casacore::Int>(keys)));
+   } else {
+       // nothing can match, see chooseSpectralWindow
+       tempNode = (table().col("ANTENNA1") == -1) && False;
+   }
+   if (itsTableSelector.isNull()) {
+       itsTableSelector = tempNode;
+   } else {
+       itsTableSelector = itsTableSelector && tempNode;
+   }
+}
+
+/// @brief choose all baselines to any of the given antennae
+/// @details This is equivalent to chaining or'ed chooseAntenna selections, but is done
+/// in one go (see chooseBaselines).
+/// @param[in] antennas antenna IDs (empty vector selects nothing)
+void TableScalarFieldSelector::chooseAntennas(const std::vector<casacore::uInt> &antennas)
+{
+   const std::vector<casacore::Int> ids(antennas.begin(), antennas.end());
+   itsRowCriteria.chooseAntennas(ids);
+   TableExprNode tempNode;
+   if (ids.size()) {
+       const casacore::Vector<casacore::Int> idSet(ids);
+       tempNode = table().col("ANTENNA1").in(TableExprNode(idSet)) || 
+                  table().col("ANTENNA2").in(TableExprNode(idSet));
+   } else {
+       // nothing can match, see chooseSpectralWindow
+       tempNode = (table().col("ANTENNA1") == -1) && False;
+   }
+   if (itsTableSelector.isNull()) {
+       itsTableSelector = tempNode;
+   } else {
+       itsTableSelector = itsTableSelector && tempNode;
+   }
+}
+
 /// @brief Choose samples corresponding to a uv-distance larger than threshold
 /// @details This effectively rejects the baselines giving a smaller
 /// uv-distance than the specified threshold
 /// @param[in] uvDist threshold
 void TableScalarFieldSelector::chooseMinUVDistance(casacore::Double uvDist)
 {
+  // the row index holds the uv-distances of all rows
+  itsRowCriteria.chooseMinUVDistance(uvDist);
   TableExprNode uvwExprNode = table().col("UVW");
   const TableExprNode uExprNode = uvwExprNode(IPosition(1,0));
   const TableExprNode vExprNode = uvwExprNode(IPosition(1,1));
@@ -132,6 +204,7 @@ void TableScalarFieldSelector::chooseMinUVDistance(casacore::Double uvDist)
 /// @param[in] uvDist threshold
 void TableScalarFieldSelector::chooseMaxUVDistance(casacore::Double uvDist)
 {
+  itsRowCriteria.chooseMaxUVDistance(uvDist);
   TableExprNode uvwExprNode = table().col("UVW");
   const TableExprNode uExprNode = uvwExprNode(IPosition(1,0));
   const TableExprNode vExprNode = uvwExprNode(IPosition(1,1));
@@ -151,6 +224,7 @@ void TableScalarFieldSelector::chooseMaxUVDistance(casacore::Double uvDist)
 /// @param[in] scanNumber the scan number to choose
 void TableScalarFieldSelector::chooseScanNumber(casacore::uInt scanNumber)
 {
+    itsRowCriteria.disable();
     if (itsTableSelector.isNull()) {
         itsTableSelector = (table().col("SCAN_NUMBER") ==
                 static_cast<casacore::Int>(scanNumber));
@@ -163,6 +237,7 @@ void TableScalarFieldSelector::chooseScanNumber(casacore::uInt scanNumber)
 /// @brief Choose autocorrelations only
 void TableScalarFieldSelector::chooseAutoCorrelations()
 {
+   itsRowCriteria.chooseAutoCorrelations();
    if (itsTableSelector.isNull()) {
        itsTableSelector = (table().col("ANTENNA1") ==
                            table().col("ANTENNA2")) &&
@@ -178,6 +253,7 @@ void TableScalarFieldSelector::chooseAutoCorrelations()
 /// @brief Choose crosscorrelations only
 void TableScalarFieldSelector::chooseCrossCorrelations()
 {
+   itsRowCriteria.chooseCrossCorrelations();
    if (itsTableSelector.isNull()) {
        itsTableSelector = (table().col("ANTENNA1") !=
                            table().col("ANTENNA2")) || 
@@ -197,6 +273,7 @@ void TableScalarFieldSelector::chooseSpectralWindow(casacore::uInt spWinID)
    // We need to obtain this information from the DATA_DESCRIPTION table
    std::vector<size_t> dataDescIDs = subtableInfo().
         getDataDescription().getDescIDsForSpWinID(static_cast<int>(spWinID));
+   itsRowCriteria.chooseDataDescIDs(std::vector<casacore::Int>(dataDescIDs.begin(), dataDescIDs.end()));
    if (dataDescIDs.size()) {
        std::vector<size_t>::const_iterator ci=dataDescIDs.begin();
        TableExprNode tempNode=(table().col("DATA_DESC_ID") ==
@@ -218,6 +295,83 @@ void TableScalarFieldSelector::chooseSpectralWindow(casacore::uInt spWinID)
    }   
 }
  
+/// @brief choose a subset of feeds
+/// @details Feeds are distributed between partitions in a round-robin fashion, i.e.
+/// a row belongs to the given partition if FEED1 modulo the number of partitions
+/// is equal to the partition number. This method is used to split the dataset into
+/// disjoint parts which can be processed in parallel.
+/// @param[in] part partition number (zero-based)
+/// @param[in] nParts total number of partitions
+void TableScalarFieldSelector::chooseFeedPartition(casacore::uInt part, casacore::uInt nParts)
+{
+   ASKAPCHECK(part < nParts, "Partition number "<<part<<" exceeds the number of partitions "<<nParts);
+   itsRowCriteria.chooseFeedPartition(static_cast<casacore::Int>(part), static_cast<casacore::Int>(nParts));
+   const TableExprNode tempNode = ((table().col("FEED1") % static_cast<casacore::Int>(nParts)) ==
+                  static_cast<casacore::Int>(part));
+   if (itsTableSelector.isNull()) {
+       itsTableSelector = tempNode;
+   } else {
+       itsTableSelector = itsTableSelector && tempNode;
+   }
+}
+
+/// @brief choose a subset of baselines
+/// @details Baselines are distributed between partitions in a round-robin fashion
+/// according to the baseline index ANTENNA1 * nAntennae + ANTENNA2.
+/// @param[in] part partition number (zero-based)
+/// @param[in] nParts total number of partitions
+void TableScalarFieldSelector::chooseBaselinePartition(casacore::uInt part, casacore::uInt nParts)
+{
+   ASKAPCHECK(part < nParts, "Partition number "<<part<<" exceeds the number of partitions "<<nParts);
+   const casacore::Int nAnt = static_cast<casacore::Int>(subtableInfo().getAntenna().getNumberOfAntennae());
+   itsRowCriteria.chooseBaselinePartition(static_cast<casacore::Int>(part), static_cast<casacore::Int>(nParts), nAnt);
+   const TableExprNode tempNode = (((table().col("ANTENNA1") * nAnt + table().col("ANTENNA2")) %
+                  static_cast<casacore::Int>(nParts)) == static_cast<casacore::Int>(part));
+   if (itsTableSelector.isNull()) {
+       itsTableSelector = tempNode;
+   } else {
+       itsTableSelector = itsTableSelector && tempNode;
+   }
+}
+
+/// @brief choose a subset of spectral windows
+/// @details Spectral windows are distributed between partitions in a round-robin
+/// fashion according to the spectral window ID.
+/// @param[in] part partition number (zero-based)
+/// @param[in] nParts total number of partitions
+void TableScalarFieldSelector::chooseSpectralWindowPartition(casacore::uInt part, casacore::uInt nParts)
+{
+   ASKAPCHECK(part < nParts, "Partition number "<<part<<" exceeds the number of partitions "<<nParts);
+   // selection is done on data description IDs, which map to spectral windows
+   const casacore::uInt nDataDesc = table().keywordSet().asTable("DATA_DESCRIPTION").nrow();
+   const ITableDataDescHolder &dataDesc = subtableInfo().getDataDescription();
+   TableExprNode tempNode;
+   std::vector<casacore::Int> descIDs;
+   for (casacore::uInt descID = 0; descID < nDataDesc; ++descID) {
+        const int spWinID = dataDesc.getSpectralWindowID(descID);
+        if ((spWinID < 0) || (static_cast<casacore::uInt>(spWinID) % nParts != part)) {
+            continue;
+        }
+        descIDs.push_back(static_cast<casacore::Int>(descID));
+        const TableExprNode descNode = (table().col("DATA_DESC_ID") ==
+                  static_cast<casacore::Int>(descID));
+        if (tempNode.isNull()) {
+            tempNode = descNode;
+        } else {
+            tempNode = tempNode || descNode;
+        }
+   }
+   itsRowCriteria.chooseDataDescIDs(descIDs);
+   if (tempNode.isNull()) {
+       // no spectral windows in this partition, see chooseSpectralWindow
+       itsTableSelector=(table().col("DATA_DESC_ID") == -1) && False;
+   } else if (itsTableSelector.isNull()) {
+       itsTableSelector = tempNode;
+   } else {
+       itsTableSelector = itsTableSelector && tempNode;
+   }
+}
+
 /// @brief Obtain a table expression node for selection. 
 /// @details This method is
 /// used in the implementation of the iterator to form a subtable
@@ -230,6 +384,16 @@ const casacore::TableExprNode& TableScalarFieldSelector::getTableSelector(const
   return itsTableSelector;
 }
 
+/// @brief Obtain row selection criteria
+/// @details This method is an alternative to getTableSelector used if the
+/// selection is resolved via the index of the main table rows. 
+/// @return criteria equivalent to the table expression
+MainTableRowIndex::Criteria TableScalarFieldSelector::getRowCriteria(const
+            boost::shared_ptr<IDataConverterImpl const> &) const
+{
+  return itsRowCriteria;
+}
+
 /// @brief get read-write access to expression node
 /// @return a reference to the cached table expression node
 ///
@@ -238,3 +402,10 @@ casacore::TableExprNode& TableScalarFieldSelector::rwTableSelector() const
   return itsTableSelector;
 }
 
+/// @brief get read-write access to row selection criteria
+/// @return a reference to the criteria equivalent to the table expression
+MainTableRowIndex::Criteria& TableScalarFieldSelector::rwRowCriteria()
+{
+  return itsRowCriteria;
+}
+
@@ -49,6 +49,8 @@
 
 // std includes
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace askap {
 
@@ -88,6 +90,20 @@ public:
   /// @param[in] ant the sequence number of antenna
   virtual void chooseAntenna(casacore::uInt ant);
 
+  /// @brief choose a set of baselines
+  /// @details Rows are selected if (ANTENNA1, ANTENNA2) is one of the given pairs. This
+  /// is equivalent to chaining or'ed chooseBaseline selections, but is done in one go
+  /// (via a set membership test in the table expression or via the row index).
+  /// Like chooseDataColumn, this is a table-specific operation.
+  /// @param[in] baselines pairs of the first and second antenna (empty vector selects nothing)
+  virtual void chooseBaselines(const std::vector<std::pair<casacore::uInt, casacore::uInt> > &baselines);
+
+  /// @brief choose all baselines to any of the given antennae
+  /// @details This is equivalent to chaining or'ed chooseAntenna selections, but is done
+  /// in one go (see chooseBaselines).
+  /// @param[in] antennas antenna IDs (empty vector selects nothing)
+  virtual void chooseAntennas(const std::vector<casacore::uInt> &antennas);
+
   /// Choose a single spectral window (also known as IF).
   /// @param[in] spWinID the ID of the spectral window to choose
   virtual void chooseSpectralWindow(casacore::uInt spWinID);
@@ -119,6 +135,29 @@ public:
   /// @param[in] scanNumber the scan number to choose
   virtual void chooseScanNumber(casacore::uInt scanNumber);
 
+  /// @brief choose a subset of feeds
+  /// @details Feeds are distributed between partitions in a round-robin fashion, i.e.
+  /// a row belongs to the given partition if FEED1 modulo the number of partitions
+  /// is equal to the partition number. This method is used to split the dataset into
+  /// disjoint parts which can be processed in parallel.
+  /// @param[in] part partition number (zero-based)
+  /// @param[in] nParts total number of partitions
+  void chooseFeedPartition(casacore::uInt part, casacore::uInt nParts);
+
+  /// @brief choose a subset of baselines
+  /// @details Baselines are distributed between partitions in a round-robin fashion
+  /// according to the baseline index ANTENNA1 * nAntennae + ANTENNA2.
+  /// @param[in] part partition number (zero-based)
+  /// @param[in] nParts total number of partitions
+  void chooseBaselinePartition(casacore::uInt part, casacore::uInt nParts);
+
+  /// @brief choose a subset of spectral windows
+  /// @details Spectral windows are distributed between partitions in a round-robin
+  /// fashion according to the spectral window ID.
+  /// @param[in] part partition number (zero-based)
+  /// @param[in] nParts total number of partitions
+  void chooseSpectralWindowPartition(casacore::uInt part, casacore::uInt nParts);
+
   /// @brief Obtain a table expression node for selection. 
   /// @details This method is
   /// used in the implementation of the iterator to form a subtable
@@ -130,6 +169,16 @@ public:
   /// @return a const reference to table expression node object
   virtual const casacore::TableExprNode& getTableSelector(const
                boost::shared_ptr<IDataConverterImpl const> &conv) const;
+
+  /// @brief Obtain row selection criteria
+  /// @details This method is an alternative to getTableSelector used if the
+  /// selection is resolved via the index of the main table rows. 
+  ///
+  /// @param conv  a shared pointer to the converter, which is used to sort
+  ///              out epochs and other measures used in the selection
+  /// @return criteria equivalent to the table expression
+  virtual MainTableRowIndex::Criteria getRowCriteria(const
+               boost::shared_ptr<IDataConverterImpl const> &conv) const;
       
 protected:
   /// @brief get read-write access to expression node
@@ -137,9 +186,16 @@ protected:
   ///
   casacore::TableExprNode& rwTableSelector() const;
 
+  /// @brief get read-write access to row selection criteria
+  /// @return a reference to the criteria equivalent to the table expression
+  MainTableRowIndex::Criteria& rwRowCriteria();
+
 private:
   /// a current table selection expression (cache)
   mutable casacore::TableExprNode  itsTableSelector;  
+
+  /// the same selection expressed via the index of the main table rows
+  MainTableRowIndex::Criteria itsRowCriteria;
 };
   
 } // namespace accessors
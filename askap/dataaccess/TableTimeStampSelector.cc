@@ -54,12 +54,10 @@ using namespace askap::accessors;
 void TableTimeStampSelector::updateTableExpression(casacore::TableExprNode &tex)
 	                                           const
 {
+  const std::pair<casacore::Double, casacore::Double> startAndStop = tableTimeRange();
+  const casacore::Double start = startAndStop.first;
+  const casacore::Double stop = startAndStop.second;
   try {    
-    const std::pair<casacore::MEpoch, casacore::MEpoch> startAndStop = getStartAndStop();
-    
-    const casacore::Double start = tableTime(startAndStop.first);
-    const casacore::Double stop = tableTime(startAndStop.second);
-            
     if (tex.isNull()) {
         tex=(table().col("TIME") > start) &&
             (table().col("TIME") < stop);
@@ -73,3 +71,27 @@ void TableTimeStampSelector::updateTableExpression(casacore::TableExprNode &tex)
          "TableTimeStampSelector::updateTableExpression: "<<ae.what());
   }
 }
+
+/// @brief update row selection criteria to narrow down the selection
+/// @details This is an alternative to updateTableExpression used if the 
+/// selection is resolved via the index of the main table rows.
+/// @param[in] criteria a reference to the criteria to update
+void TableTimeStampSelector::updateRowCriteria(MainTableRowIndex::Criteria &criteria) const
+{
+  const std::pair<casacore::Double, casacore::Double> startAndStop = tableTimeRange();
+  criteria.chooseTimeRange(startAndStop.first, startAndStop.second);
+}
+
+/// @brief obtain start and stop times in the frame/units of the table
+/// @return start and stop times (as an std::pair, start is first, stop is second)
+std::pair<casacore::Double, casacore::Double> TableTimeStampSelector::tableTimeRange() const
+{
+  try {    
+    const std::pair<casacore::MEpoch, casacore::MEpoch> startAndStop = getStartAndStop();
+    return std::make_pair(tableTime(startAndStop.first), tableTime(startAndStop.second));
+  }
+  catch(const casacore::AipsError &ae) {
+    ASKAPTHROW(DataAccessError, "casacore::AipsError is caught inside "
+         "TableTimeStampSelector::tableTimeRange: "<<ae.what());
+  }
+}
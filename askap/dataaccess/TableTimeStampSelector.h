@@ -72,6 +72,12 @@ public:
    /// @param tex a reference to table expression to use
    virtual void updateTableExpression(casacore::TableExprNode &tex) const;
 
+   /// @brief update row selection criteria to narrow down the selection
+   /// @details This is an alternative to updateTableExpression used if the 
+   /// selection is resolved via the index of the main table rows.
+   /// @param[in] criteria a reference to the criteria to update
+   virtual void updateRowCriteria(MainTableRowIndex::Criteria &criteria) const;
+
 protected:
   
    /// @brief This method has to be overriden in derived classes.
@@ -84,7 +90,11 @@ protected:
    /// @return start and stop times of the interval to be selected (as
    ///         an std::pair, start is first, stop is second)
    virtual std::pair<casacore::MEpoch, casacore::MEpoch>
-           getStartAndStop() const = 0;       
+           getStartAndStop() const = 0;
+
+   /// @brief obtain start and stop times in the frame/units of the table
+   /// @return start and stop times (as an std::pair, start is first, stop is second)
+   std::pair<casacore::Double, casacore::Double> tableTimeRange() const;       
 };
 
 } // namespace askap
@@ -0,0 +1,168 @@
+/// @file
+/// @brief set of CPUs a thread is allowed to run on
+///
+/// @details On multi-socket nodes memory is attached to NUMA nodes, and the memory
+/// pages are placed on the node of the thread which touches them first. This class
+/// describes a set of CPUs (e.g. all CPUs of one NUMA node), which can be applied to
+/// the calling thread.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/ThreadAffinity.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief empty set, i.e. no restriction
+ThreadAffinity::ThreadAffinity() {}
+
+/// @brief set of the given CPUs
+/// @param[in] cpus CPU numbers
+ThreadAffinity::ThreadAffinity(const std::vector<casacore::uInt> &cpus) : itsCPUs(cpus)
+{
+  std::sort(itsCPUs.begin(), itsCPUs.end());
+  itsCPUs.erase(std::unique(itsCPUs.begin(), itsCPUs.end()), itsCPUs.end());
+}
+
+/// @brief CPUs the calling thread is allowed to run on
+/// @return the set (empty if not supported)
+ThreadAffinity ThreadAffinity::ofCurrentThread()
+{
+  std::vector<casacore::uInt> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+      for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+           if (CPU_ISSET(cpu, &set)) {
+               cpus.push_back(static_cast<casacore::uInt>(cpu));
+           }
+      }
+  }
+#endif
+  return ThreadAffinity(cpus);
+}
+
+/// @brief CPUs of the given NUMA node
+/// @details The list of CPUs is taken from sysfs.
+/// @param[in] node NUMA node number
+/// @return the set (empty if the node is unknown or affinity is not supported)
+ThreadAffinity ThreadAffinity::ofNumaNode(casacore::uInt node)
+{
+#ifdef __linux__
+  std::ostringstream os;
+  os<<"/sys/devices/system/node/node"<<node<<"/cpulist";
+  std::ifstream is(os.str().c_str());
+  std::string list;
+  if (is && std::getline(is, list)) {
+      return parse(list);
+  }
+#endif
+  return ThreadAffinity();
+}
+
+/// @brief number of NUMA nodes of this machine
+/// @return number of nodes, 1 if the information is not available
+casacore::uInt ThreadAffinity::numberOfNumaNodes()
+{
+  casacore::uInt nNodes = 0;
+  while (!ofNumaNode(nNodes).empty()) {
+         ++nNodes;
+  }
+  return nNodes > 0 ? nNodes : 1;
+}
+
+/// @brief restrict the calling thread to this set
+/// @details Nothing is done for an empty set. Failure to set the affinity (e.g. if
+/// the CPUs are not available to this process) is not an error, as it only affects
+/// the performance.
+/// @return true, if the affinity has been set
+bool ThreadAffinity::apply() const
+{
+  if (empty()) {
+      return false;
+  }
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (std::vector<casacore::uInt>::const_iterator ci = itsCPUs.begin(); ci != itsCPUs.end(); ++ci) {
+       if (*ci < static_cast<casacore::uInt>(CPU_SETSIZE)) {
+           CPU_SET(*ci, &set);
+       }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+/// @brief parse the list of CPUs in the sysfs format
+/// @details The list is given by comma-separated numbers or ranges, e.g. "0-3,8,10-11".
+/// @param[in] list string to parse
+/// @return the set of CPUs
+ThreadAffinity ThreadAffinity::parse(const std::string &list)
+{
+  std::vector<casacore::uInt> cpus;
+  std::istringstream is(list);
+  std::string item;
+  while (std::getline(is, item, ',')) {
+         const size_t first = item.find_first_not_of(" \t\n");
+         if (first == std::string::npos) {
+             continue;
+         }
+         const size_t dash = item.find('-', first);
+         char *end = NULL;
+         const unsigned long start = std::strtoul(item.c_str() + first, &end, 10);
+         ASKAPCHECK(end != item.c_str() + first, "Unable to parse CPU list "<<list);
+         unsigned long stop = start;
+         if (dash != std::string::npos) {
+             stop = std::strtoul(item.c_str() + dash + 1, &end, 10);
+             ASKAPCHECK((end != item.c_str() + dash + 1) && (stop >= start), 
+                        "Unable to parse CPU list "<<list);
+         }
+         for (unsigned long cpu = start; cpu <= stop; ++cpu) {
+              cpus.push_back(static_cast<casacore::uInt>(cpu));
+         }
+  }
+  return ThreadAffinity(cpus);
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,107 @@
+/// @file
+/// @brief set of CPUs a thread is allowed to run on
+///
+/// @details On multi-socket nodes memory is attached to NUMA nodes, and the memory
+/// pages are placed on the node of the thread which touches them first. This class
+/// describes a set of CPUs (e.g. all CPUs of one NUMA node), which can be applied to
+/// the calling thread. It is used to keep the background reader of the table-based
+/// iterator and the first touch of its buffers on the same node as the consumer of
+/// the data (see TableConstDataSource::createPartitionedIterators). Affinity is only
+/// supported on Linux, elsewhere all sets are empty and nothing is pinned.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_THREAD_AFFINITY_H
+#define ASKAP_ACCESSORS_THREAD_AFFINITY_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+// std includes
+#include <string>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set of CPUs a thread is allowed to run on
+/// @details An empty set means no restriction, applying it does nothing.
+/// @ingroup dataaccess_hlp
+class ThreadAffinity {
+public:
+  /// @brief empty set, i.e. no restriction
+  ThreadAffinity();
+
+  /// @brief set of the given CPUs
+  /// @param[in] cpus CPU numbers
+  explicit ThreadAffinity(const std::vector<casacore::uInt> &cpus);
+
+  /// @brief CPUs the calling thread is allowed to run on
+  /// @return the set (empty if not supported)
+  static ThreadAffinity ofCurrentThread();
+
+  /// @brief CPUs of the given NUMA node
+  /// @details The list of CPUs is taken from sysfs.
+  /// @param[in] node NUMA node number
+  /// @return the set (empty if the node is unknown or affinity is not supported)
+  static ThreadAffinity ofNumaNode(casacore::uInt node);
+
+  /// @brief number of NUMA nodes of this machine
+  /// @return number of nodes, 1 if the information is not available
+  static casacore::uInt numberOfNumaNodes();
+
+  /// @brief check whether the set is empty
+  /// @return true, if there is no restriction
+  inline bool empty() const { return itsCPUs.empty(); }
+
+  /// @brief CPUs of this set
+  /// @return a const reference to the vector of CPU numbers (in increasing order)
+  inline const std::vector<casacore::uInt>& cpus() const { return itsCPUs; }
+
+  /// @brief restrict the calling thread to this set
+  /// @details Nothing is done for an empty set. Failure to set the affinity (e.g. if
+  /// the CPUs are not available to this process) is not an error, as it only affects
+  /// the performance.
+  /// @return true, if the affinity has been set
+  bool apply() const;
+
+  /// @brief parse the list of CPUs in the sysfs format
+  /// @details The list is given by comma-separated numbers or ranges, e.g. "0-3,8,10-11".
+  /// @param[in] list string to parse
+  /// @return the set of CPUs
+  static ThreadAffinity parse(const std::string &list);
+
+private:
+  /// @brief CPU numbers in increasing order
+  std::vector<casacore::uInt> itsCPUs;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_THREAD_AFFINITY_H
@@ -0,0 +1,180 @@
+/// @file
+/// @brief iterator adapter packing consecutive time steps into one accessor
+///
+/// @details This adapter is derived from DataIteratorAdapter. Table-based iterators deliver
+/// one integration per step, which for a single beam is only a few hundred rows. This is too
+/// little work per call for batched processing (e.g. on a GPU). The adapter gathers a number
+/// of consecutive steps of the wrapped iterator into a single accessor, subject to a limit
+/// on the number of steps, rows and bytes.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+
+#include <askap/dataaccess/TimeAggregatingIteratorAdapter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief setup with the given iterator
+/// @details
+/// @param[in] iter shared pointer to iterator to be wrapped
+/// @param[in] maxSteps maximum number of steps of the wrapped iterator per batch
+/// @param[in] maxRows maximum number of rows per batch, zero means no limit
+/// @param[in] maxBytes maximum size of the visibility, noise and flag cubes of a batch
+/// in bytes, zero means no limit
+TimeAggregatingIteratorAdapter::TimeAggregatingIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter,
+           const casacore::uInt maxSteps, const casacore::uInt maxRows, const size_t maxBytes) :
+           DataIteratorAdapter(iter), itsMaxSteps(maxSteps), itsMaxRows(maxRows), itsMaxBytes(maxBytes)
+{
+  ASKAPCHECK(iter, "An attempt to initialise TimeAggregatingIteratorAdapter with empty shared pointer");
+  ASKAPCHECK(maxSteps > 0, "Number of steps per batch should be positive");
+  readBatch();
+}
+
+/// Restart the iteration from the beginning
+void TimeAggregatingIteratorAdapter::init()
+{
+  itsOutputAdapter.detach();
+  roIterator().init();
+  readBatch();
+}
+
+/// operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the gathered data of the current batch
+IDataAccessor& TimeAggregatingIteratorAdapter::operator*() const
+{
+  ASKAPCHECK(hasMore(), "No more gathered data available");
+  itsOutputAdapter.associate(itsOutput);
+  return itsOutputAdapter;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool TimeAggregatingIteratorAdapter::hasMore() const throw()
+{
+  return itsRows.size() > 0;
+}
+
+/// advance the iterator one step further 
+/// @return True if there are more data (so constructions like 
+///         while(it.next()) {} are possible)
+casacore::Bool TimeAggregatingIteratorAdapter::next()
+{
+  ASKAPCHECK(hasMore(), "There are no more gathered data available");
+  itsOutputAdapter.detach();
+  readBatch();
+  return hasMore();
+}
+
+/// @brief number of steps of the wrapped iterator in the current batch
+/// @return number of steps
+casacore::uInt TimeAggregatingIteratorAdapter::nStepsGathered() const
+{
+  ASKAPCHECK(hasMore(), "No more gathered data available");
+  return casacore::uInt(itsChunks.size());
+}
+
+/// @brief time of each row of the current accessor
+/// @return vector with times (one per row)
+const casacore::Vector<casacore::Double>& TimeAggregatingIteratorAdapter::rowTime() const
+{
+  ASKAPCHECK(hasMore(), "No more gathered data available");
+  return itsOutput.rowTime();
+}
+
+/// @brief read the next batch of the wrapped iterator and gather its rows
+/// @details The iterator is left at the first step which doesn't belong to the batch.
+/// Steps without rows are skipped.
+void TimeAggregatingIteratorAdapter::readBatch()
+{
+  IConstDataIterator &it = roIterator();
+  itsRows.clear();
+  size_t nChunks = 0;
+  casacore::uInt nRow = 0;
+  casacore::uInt nChannel = 0;
+  casacore::uInt nPol = 0;
+  // visibility and noise cubes plus flags
+  const size_t bytesPerElement = 2 * sizeof(casacore::Complex) + sizeof(casacore::Bool);
+  for (; it.hasMore() && (nChunks < itsMaxSteps); it.next()) {
+       const IConstDataAccessor &acc = *it;
+       if (acc.nRow() == 0) {
+           continue;
+       }
+       if (nChunks == 0) {
+           nChannel = acc.nChannel();
+           nPol = acc.nPol();
+       } else {
+           const size_t nBytes = size_t(nRow + acc.nRow()) * nChannel * nPol * bytesPerElement;
+           if ((acc.nChannel() != nChannel) || (acc.nPol() != nPol) ||
+               ((itsMaxRows > 0) && (nRow + acc.nRow() > itsMaxRows)) ||
+               ((itsMaxBytes > 0) && (nBytes > itsMaxBytes))) {
+               break;
+           }
+       }
+       // accessors of the previous batch are reused to avoid reallocation
+       if (nChunks == itsChunks.size()) {
+           itsChunks.push_back(boost::shared_ptr<GatheredDataAccessor>(new GatheredDataAccessor));
+       }
+       itsChunks[nChunks]->assign(acc);
+       for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+            itsRows.push_back(std::make_pair(casacore::uInt(nChunks), row));
+       }
+       nRow += acc.nRow();
+       ++nChunks;
+  }
+  itsChunks.resize(nChunks);
+  if (hasMore()) {
+      itsOutput.gather(itsChunks, itsRows);
+  }
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+void TimeAggregatingIteratorAdapter::chooseBuffer(const std::string &)
+{
+  ASKAPTHROW(DataAccessLogicError, "TimeAggregatingIteratorAdapter doesn't support buffers");
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+void TimeAggregatingIteratorAdapter::chooseOriginal()
+{
+  ASKAPTHROW(DataAccessLogicError, "TimeAggregatingIteratorAdapter doesn't support buffers");
+}
+
+/// @brief buffers are not supported by this adapter
+/// @details This method throws an exception
+/// @return a reference to writable data accessor to the buffer requested
+IDataAccessor& TimeAggregatingIteratorAdapter::buffer(const std::string &) const
+{
+  ASKAPTHROW(DataAccessLogicError, "TimeAggregatingIteratorAdapter doesn't support buffers");
+}
+
+} // namespace accessors
+
+} // namespace askap
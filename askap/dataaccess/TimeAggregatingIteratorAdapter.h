@@ -0,0 +1,155 @@
+/// @file
+/// @brief iterator adapter packing consecutive time steps into one accessor
+///
+/// @details This adapter is derived from DataIteratorAdapter. Table-based iterators deliver
+/// one integration per step, which for a single beam is only a few hundred rows. This is too
+/// little work per call for batched processing (e.g. on a GPU). The adapter gathers a number
+/// of consecutive steps of the wrapped iterator into a single accessor, subject to a limit
+/// on the number of steps, rows and bytes.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+
+#ifndef ASKAP_ACCESSORS_TIME_AGGREGATING_ITERATOR_ADAPTER_H
+#define ASKAP_ACCESSORS_TIME_AGGREGATING_ITERATOR_ADAPTER_H
+
+#include <askap/dataaccess/DataIteratorAdapter.h>
+#include <askap/dataaccess/DataAccessorAdapter.h>
+#include <askap/dataaccess/GatheredDataAccessor.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <utility>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iterator adapter packing consecutive time steps into one accessor
+/// @details Every step of this adapter delivers the rows of up to the given number of
+/// consecutive steps of the wrapped iterator (usually one integration each) gathered into
+/// a single accessor, in the original order. A batch is also closed before a step which would
+/// take it over the row or byte limit (a single step is always delivered, even if it exceeds
+/// the limits) and before a step with a different number of channels or polarisations.
+/// The byte limit applies to the visibility, noise and flag cubes of the batch.
+///
+/// The delivered accessor has rows with different times, time() returns the time of the
+/// first row and the time of each row is available via rowTime. Pointing directions and feed
+/// position angles are per row anyway, so they are kept for each time step. The data are read
+/// only and buffers are not supported.
+/// @ingroup dataaccess_hlp
+class TimeAggregatingIteratorAdapter : virtual public DataIteratorAdapter
+{
+public:
+  /// @brief setup with the given iterator
+  /// @details
+  /// @param[in] iter shared pointer to iterator to be wrapped
+  /// @param[in] maxSteps maximum number of steps of the wrapped iterator per batch
+  /// @param[in] maxRows maximum number of rows per batch, zero means no limit
+  /// @param[in] maxBytes maximum size of the visibility, noise and flag cubes of a batch
+  /// in bytes, zero means no limit
+  TimeAggregatingIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter,
+                                 const casacore::uInt maxSteps, const casacore::uInt maxRows = 0,
+                                 const size_t maxBytes = 0);
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the gathered data of the current batch
+  virtual IDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further 
+  /// @return True if there are more data (so constructions like 
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  /// @param[in] bufferID  the name of the buffer to choose
+  virtual void chooseBuffer(const std::string &bufferID);
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  virtual void chooseOriginal();
+
+  /// @brief buffers are not supported by this adapter
+  /// @details This method throws an exception
+  /// @param[in] bufferID the name of the buffer requested
+  /// @return a reference to writable data accessor to the buffer requested
+  virtual IDataAccessor& buffer(const std::string &bufferID) const;
+
+  /// @brief number of steps of the wrapped iterator in the current batch
+  /// @return number of steps
+  casacore::uInt nStepsGathered() const;
+
+  /// @brief time of each row of the current accessor
+  /// @return vector with times (one per row)
+  const casacore::Vector<casacore::Double>& rowTime() const;
+
+protected:
+  /// @brief read the next batch of the wrapped iterator and gather its rows
+  /// @details The iterator is left at the first step which doesn't belong to the batch.
+  /// Steps without rows are skipped.
+  void readBatch();
+
+private:
+  /// @brief maximum number of steps per batch
+  casacore::uInt itsMaxSteps;
+
+  /// @brief maximum number of rows per batch, zero means no limit
+  casacore::uInt itsMaxRows;
+
+  /// @brief maximum size of the cubes of a batch in bytes, zero means no limit
+  size_t itsMaxBytes;
+
+  /// @brief steps of the current batch
+  std::vector<boost::shared_ptr<GatheredDataAccessor> > itsChunks;
+
+  /// @brief (chunk, row) pairs of all rows of the current batch
+  std::vector<std::pair<casacore::uInt, casacore::uInt> > itsRows;
+
+  /// @brief gathered data of the current batch
+  GatheredDataAccessor itsOutput;
+
+  /// @brief adapter giving out the gathered data with the right type
+  mutable DataAccessorAdapter itsOutputAdapter;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TIME_AGGREGATING_ITERATOR_ADAPTER_H
@@ -35,13 +35,17 @@
 
 #include <askap/dataaccess/TimeChunkIteratorAdapter.h>
 
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
+
 namespace askap {
 
 namespace accessors {
 
 /// @brief default constructor to get an uninitialised adapter
 TimeChunkIteratorAdapter::TimeChunkIteratorAdapter() : itsCurrentChunkTime(0.), itsPrevTime(0.),
-            itsInterval(-1.), itsChangeMonitor(changeMonitor()) {} 
+            itsInterval(-1.), itsChangeMonitor(changeMonitor()), itsTargetVolume(0), itsVolumeMeasure(ROWS),
+            itsChunkVolume(0), itsCurrentVolume(0), itsCurrentVolumeValid(false) {} 
   
 /// @brief setup with the given iterator
 /// @details
@@ -53,7 +57,8 @@ TimeChunkIteratorAdapter::TimeChunkIteratorAdapter() : itsCurrentChunkTime(0.),
 /// DataIteratorAdapter)
 TimeChunkIteratorAdapter::TimeChunkIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter, 
            const double interval) : DataIteratorAdapter(iter), itsCurrentChunkTime(0.), itsPrevTime(0.),
-           itsInterval(interval), itsChangeMonitor(changeMonitor()) 
+           itsInterval(interval), itsChangeMonitor(changeMonitor()), itsTargetVolume(0), itsVolumeMeasure(ROWS),
+           itsChunkVolume(0), itsCurrentVolume(0), itsCurrentVolumeValid(false)
 {
   ASKAPCHECK(iter, "An attempt to initialise TimeChunkIteratorAdapter with empty shared pointer");
   itsCurrentChunkTime = (*iter)->time();
@@ -72,6 +77,35 @@ void TimeChunkIteratorAdapter::setInterval(const double interval)
   itsInterval = interval;
 }
 
+/// @brief set the target data volume of a chunk
+/// @details 
+/// @param[in] volume target volume of a single chunk, zero means no balancing
+/// (chunks are defined by the time interval only)
+/// @param[in] measure how the volume is measured (rows or unflagged samples)
+/// @note Like setInterval, this method is supposed to be used either before 
+/// the actual use of the adapter or when iteration is broken after hasMore returned false.
+void TimeChunkIteratorAdapter::setTargetVolume(const size_t volume, const VolumeMeasure measure)
+{
+  itsTargetVolume = volume;
+  if (itsVolumeMeasure != measure) {
+      itsVolumeMeasure = measure;
+      itsCurrentVolumeValid = false;
+  }
+}
+
+/// @brief volume of the accessor at the current iterator position
+/// @details The result is cached until the iterator advances
+/// @return volume in the units set by setTargetVolume
+size_t TimeChunkIteratorAdapter::currentVolume() const
+{
+  if (!itsCurrentVolumeValid) {
+      const IConstDataAccessor &acc = *roIterator();
+      itsCurrentVolume = itsVolumeMeasure == ROWS ? acc.nRow() : casacore::nfalse(acc.flag());
+      itsCurrentVolumeValid = true;
+  }
+  return itsCurrentVolume;
+}
+
   
 /// @brief Checks whether there are more data available in this chunk
 /// @return True if there are more data available in this chunk
@@ -79,12 +113,32 @@ void TimeChunkIteratorAdapter::setInterval(const double interval)
 /// current chunk rather than to all dataset
 casacore::Bool TimeChunkIteratorAdapter::hasMore() const throw()
 {
-  if (itsChangeMonitor != changeMonitor() || (itsInterval < 0)) {
+  if (itsChangeMonitor != changeMonitor() || ((itsInterval < 0) && (itsTargetVolume == 0))) {
       return DataIteratorAdapter::hasMore();
   }
-  const double curTime = roIterator()->time();
-  ASKAPDEBUGASSERT((curTime >= itsCurrentChunkTime));
-  return DataIteratorAdapter::hasMore() && (curTime - itsCurrentChunkTime < itsInterval);
+  if (!DataIteratorAdapter::hasMore()) {
+      return false;
+  }
+  if (itsInterval >= 0) {
+      const double curTime = roIterator()->time();
+      ASKAPDEBUGASSERT((curTime >= itsCurrentChunkTime));
+      if (curTime - itsCurrentChunkTime >= itsInterval) {
+          return false;
+      }
+  }
+  if ((itsTargetVolume > 0) && (itsChunkVolume > 0)) {
+      // the first accessor always goes into the chunk, the others only if they bring 
+      // the chunk closer to the target volume
+      if (itsChunkVolume >= itsTargetVolume) {
+          return false;
+      }
+      const size_t undershoot = itsTargetVolume - itsChunkVolume;
+      const size_t newVolume = itsChunkVolume + currentVolume();
+      if ((newVolume > itsTargetVolume) && (newVolume - itsTargetVolume > undershoot)) {
+          return false;
+      }
+  }
+  return true;
 }
   
 /// advance the iterator one step further 
@@ -99,13 +153,31 @@ casacore::Bool TimeChunkIteratorAdapter::next()
       itsChangeMonitor = changeMonitor();
       itsCurrentChunkTime = curTime;
       itsPrevTime = curTime;
+      itsChunkVolume = 0;
   }
   ASKAPCHECK(curTime >= itsPrevTime, 
       "Data appear to be not in time order, TimeChunkIteratorAdapter can't handle this situation. Last time = "<<
       itsPrevTime<<" s, current time = "<<curTime);
   itsPrevTime = curTime;  
+  if (itsTargetVolume > 0) {
+      itsChunkVolume += currentVolume();
+  }
+  itsCurrentVolumeValid = false;
   return DataIteratorAdapter::next();
 }
+
+/// Restart the iteration from the beginning
+/// @details The first chunk starts at the beginning of the data
+void TimeChunkIteratorAdapter::init()
+{
+  DataIteratorAdapter::init();
+  itsCurrentVolumeValid = false;
+  itsChunkVolume = 0;
+  if (DataIteratorAdapter::hasMore()) {
+      itsCurrentChunkTime = roIterator()->time();
+      itsPrevTime = itsCurrentChunkTime;
+  }
+}
   
 /// @brief checks whether there are more data available
 /// @details This method disregards the split into time chunks.
@@ -123,6 +195,7 @@ void TimeChunkIteratorAdapter::resume() const
    ASKAPCHECK(moreDataAvailable(), "Unable to resume iteration as no more data are available");
    itsCurrentChunkTime = roIterator()->time();
    itsPrevTime = itsCurrentChunkTime;  
+   itsChunkVolume = 0;
    ASKAPDEBUGASSERT(hasMore());
 }
 
@@ -7,6 +7,8 @@
 /// reached. The iteration can be resumed afterwards, provided there are
 /// more data still available. The assumption is that the data are 
 /// time-ordered. An exception is thrown if it is not the case.
+/// Optionally, chunks can be balanced by the data volume (number of rows
+/// or unflagged samples), so parallel work units get similar amounts of data.
 ///
 /// @copyright (c) 2007 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -50,10 +52,23 @@ namespace accessors {
 /// reached. The iteration can be resumed afterwards, provided there are
 /// more data still available. The assumption is that the data are 
 /// time-ordered. An exception is thrown if it is not the case.
+/// If the target data volume is set, a chunk is also closed when adding the
+/// current accessor would overshoot the target by more than the chunk would
+/// undershoot it without this accessor. The accessor at the iterator position
+/// is examined before it is consumed, so the boundary is decided in advance.
+/// The time interval acts as the upper limit in this case.
 /// @ingroup dataaccess_hlp
 class TimeChunkIteratorAdapter : virtual public DataIteratorAdapter
 {
 public:
+  /// @brief measure of the data volume used to balance chunks
+  enum VolumeMeasure {
+     /// @brief number of rows
+     ROWS = 0,
+     /// @brief number of unflagged visibility samples
+     UNFLAGGED_SAMPLES
+  };
+
   // constructors
 
   /// @brief default constructor to get an uninitialised adapter
@@ -80,6 +95,10 @@ public:
   /// @return True if there are more data (so constructions like 
   ///         while(it.next()) {} are possible)
   virtual casacore::Bool next();  
+
+  /// Restart the iteration from the beginning
+  /// @details The first chunk starts at the beginning of the data
+  virtual void init();
   
   /// @brief checks whether there are more data available
   /// @details This method disregards the split into time chunks.
@@ -99,6 +118,26 @@ public:
   /// used either before the actual use of the adapter or when iteration is broken after
   /// hasMore returned true.
   void setInterval(const double interval);
+
+  /// @brief set the target data volume of a chunk
+  /// @details 
+  /// @param[in] volume target volume of a single chunk, zero means no balancing
+  /// (chunks are defined by the time interval only)
+  /// @param[in] measure how the volume is measured (rows or unflagged samples)
+  /// @note Like setInterval, this method is supposed to be used either before 
+  /// the actual use of the adapter or when iteration is broken after hasMore returned false.
+  void setTargetVolume(const size_t volume, const VolumeMeasure measure = ROWS);
+
+  /// @brief data volume consumed so far in the current chunk
+  /// @return volume of accessors iterated over since the start of the chunk, in 
+  /// the units set by setTargetVolume
+  size_t chunkVolume() const { return itsChunkVolume; }
+
+protected:
+  /// @brief volume of the accessor at the current iterator position
+  /// @details The result is cached until the iterator advances
+  /// @return volume in the units set by setTargetVolume
+  size_t currentVolume() const;
     
 private:
   /// @brief time (seconds since 0 MJD) corresponding to the first accessor of the chunk
@@ -116,6 +155,21 @@ private:
   /// @details It allows us to find when iterator is updated and, therefore, when
   /// a new chunk has to be started.
   scimath::ChangeMonitor itsChangeMonitor;  
+
+  /// @brief target data volume of a chunk, zero means no balancing
+  size_t itsTargetVolume;
+
+  /// @brief how the data volume is measured
+  VolumeMeasure itsVolumeMeasure;
+
+  /// @brief data volume consumed so far in the current chunk
+  mutable size_t itsChunkVolume;
+
+  /// @brief cached volume of the accessor at the current iterator position
+  mutable size_t itsCurrentVolume;
+
+  /// @brief true, if itsCurrentVolume corresponds to the current iterator position
+  mutable bool itsCurrentVolumeValid;
 };
 
 } // namespace accessors
@@ -0,0 +1,110 @@
+/// @file
+/// @brief index of the TIME column of the main table
+/// @details Time range selection is normally done via a table expression, which 
+/// casacore evaluates for every row of the measurement set. However, the rows are 
+/// normally written in the time order, so the selected rows form a contiguous range
+/// which can be found by the binary search. This class reads the TIME column once,
+/// checks whether it is monotonic and finds row ranges for the given time interval. 
+/// It also keeps the sorted list of unique time stamps, which allows to select the 
+/// data by the cycle number.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/TimeColumnIndex.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/tables/Tables/ScalarColumn.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief build the index
+/// @param[in] ms measurement set (main table)
+TimeColumnIndex::TimeColumnIndex(const casacore::Table &ms) : itsTimeOrdered(true)
+{
+  casacore::ROScalarColumn<casacore::Double>(ms, "TIME").getColumn(itsTime, casacore::True);
+  const casacore::uInt nRow = itsTime.nelements();
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       if ((row > 0) && (itsTime[row] < itsTime[row - 1])) {
+           itsTimeOrdered = false;
+       }
+       if (itsCycleTimes.empty() || (itsCycleTimes.back() != itsTime[row])) {
+           itsCycleTimes.push_back(itsTime[row]);
+       }
+  }
+  if (!itsTimeOrdered) {
+      std::sort(itsCycleTimes.begin(), itsCycleTimes.end());
+      itsCycleTimes.erase(std::unique(itsCycleTimes.begin(), itsCycleTimes.end()), itsCycleTimes.end());
+  }
+}
+
+/// @brief find the range of rows for a time interval
+/// @details Both ends of the interval are excluded, like in the table expression 
+/// formed by TableTimeStampSelector. This method can only be used if the rows are 
+/// in the time order.
+/// @param[in] start start time (in the units and frame of the TIME column)
+/// @param[in] stop stop time (in the units and frame of the TIME column)
+/// @return the first row and the number of rows in the range
+std::pair<casacore::uInt, casacore::uInt> TimeColumnIndex::rowRange(casacore::Double start, 
+                                                                    casacore::Double stop) const
+{
+  ASKAPCHECK(itsTimeOrdered, "Row range for the time interval can only be found if the rows are in the time order");
+  const casacore::Double *first = itsTime.data();
+  const casacore::Double *last = first + itsTime.nelements();
+  const casacore::Double *rangeStart = std::upper_bound(first, last, start);
+  const casacore::Double *rangeStop = std::lower_bound(rangeStart, last, stop);
+  return std::make_pair(casacore::uInt(rangeStart - first), casacore::uInt(rangeStop - rangeStart));
+}
+
+/// @brief time interval corresponding to a range of cycles
+/// @details The interval returned excludes both ends (to be used with rowRange or
+/// TableTimeStampSelector), its ends are half way between the adjacent cycles.
+/// @param[in] start the number of the first cycle (zero-based)
+/// @param[in] stop the number of the last cycle (included)
+/// @return start and stop times (in the units and frame of the TIME column)
+std::pair<casacore::Double, casacore::Double> TimeColumnIndex::cycleTimeRange(casacore::uInt start, 
+                                                                              casacore::uInt stop) const
+{
+  ASKAPCHECK(start <= stop, "The first cycle "<<start<<" is after the last one "<<stop);
+  const casacore::uInt nCycles = this->nCycles();
+  if (start >= nCycles) {
+      // nothing is selected, return an interval after the last cycle
+      const casacore::Double after = nCycles > 0 ? itsCycleTimes.back() + 1. : 0.;
+      return std::make_pair(after, after);
+  }
+  // the interval between cycles is used as a margin for the first and the last cycle
+  const casacore::Double margin = nCycles > 1 ? (itsCycleTimes[1] - itsCycleTimes[0]) / 2. : 1.;
+  const casacore::Double startTime = start > 0 ? (itsCycleTimes[start - 1] + itsCycleTimes[start]) / 2. : 
+                                     itsCycleTimes[0] - margin;
+  const casacore::Double stopTime = stop + 1 < nCycles ? (itsCycleTimes[stop] + itsCycleTimes[stop + 1]) / 2. :
+                                    itsCycleTimes.back() + margin;
+  return std::make_pair(startTime, stopTime);
+}
@@ -0,0 +1,116 @@
+/// @file
+/// @brief index of the TIME column of the main table
+/// @details Time range selection is normally done via a table expression, which 
+/// casacore evaluates for every row of the measurement set. However, the rows are 
+/// normally written in the time order, so the selected rows form a contiguous range
+/// which can be found by the binary search. This class reads the TIME column once,
+/// checks whether it is monotonic and finds row ranges for the given time interval. 
+/// It also keeps the sorted list of unique time stamps, which allows to select the 
+/// data by the cycle number.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TIME_COLUMN_INDEX_H
+#define ASKAP_ACCESSORS_TIME_COLUMN_INDEX_H
+
+// std includes
+#include <utility>
+#include <vector>
+
+// boost includes
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/tables/Tables/Table.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief index of the TIME column of the main table
+/// @details The index is built once per measurement set (see 
+/// ISubtableInfoHolder::getTimeIndex) and doesn't change afterwards, so it can be shared
+/// between iterators and threads. 
+/// @ingroup dataaccess_tab
+class TimeColumnIndex : private boost::noncopyable {
+public:
+  /// @brief build the index
+  /// @param[in] ms measurement set (main table)
+  explicit TimeColumnIndex(const casacore::Table &ms);
+
+  /// @brief check whether the rows are in the time order
+  /// @return true, if TIME column is non-decreasing
+  inline bool timeOrdered() const { return itsTimeOrdered; }
+
+  /// @brief find the range of rows for a time interval
+  /// @details Both ends of the interval are excluded, like in the table expression 
+  /// formed by TableTimeStampSelector. This method can only be used if the rows are 
+  /// in the time order.
+  /// @param[in] start start time (in the units and frame of the TIME column)
+  /// @param[in] stop stop time (in the units and frame of the TIME column)
+  /// @return the first row and the number of rows in the range
+  std::pair<casacore::uInt, casacore::uInt> rowRange(casacore::Double start, 
+                                                     casacore::Double stop) const;
+
+  /// @brief number of cycles
+  /// @return number of unique time stamps
+  inline casacore::uInt nCycles() const { return casacore::uInt(itsCycleTimes.size()); }
+
+  /// @brief time interval corresponding to a range of cycles
+  /// @details The interval returned excludes both ends (to be used with rowRange or
+  /// TableTimeStampSelector), its ends are half way between the adjacent cycles.
+  /// @param[in] start the number of the first cycle (zero-based)
+  /// @param[in] stop the number of the last cycle (included)
+  /// @return start and stop times (in the units and frame of the TIME column)
+  std::pair<casacore::Double, casacore::Double> cycleTimeRange(casacore::uInt start, 
+                                                               casacore::uInt stop) const;
+
+  /// @brief number of rows in the index
+  /// @return number of rows in the main table at the time of construction
+  inline casacore::uInt nrow() const { return itsTime.nelements(); }
+
+  /// @brief TIME column
+  /// @return time for each row of the main table (in the order of rows)
+  inline const casacore::Vector<casacore::Double>& time() const { return itsTime; }
+
+private:
+  /// @brief TIME column
+  casacore::Vector<casacore::Double> itsTime;
+
+  /// @brief true, if the TIME column is non-decreasing
+  bool itsTimeOrdered;
+
+  /// @brief sorted unique time stamps
+  std::vector<casacore::Double> itsCycleTimes;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TIME_COLUMN_INDEX_H
@@ -61,13 +61,7 @@ using namespace askap::accessors;
 /// @return an epoch in table's native frame/units
 casacore::Double TimeDependentSubtable::tableTime(const casacore::MEpoch &time) const
 {
-  if (!itsConverter) {
-      // first use, we need to read frame/unit information and set up the 
-      // converter
-      initConverter();
-   }
-  ASKAPDEBUGASSERT(itsConverter);
-  return (*itsConverter)(time);
+  return converter()(time);
 }
 
 /// @brief obtain a full epoch object for a given time (reverse conversion)
@@ -78,13 +72,29 @@ casacore::Double TimeDependentSubtable::tableTime(const casacore::MEpoch &time)
 /// the other columns. 
 casacore::MEpoch TimeDependentSubtable::tableTime(casacore::Double time) const
 {
+  return converter().toMeasure(time);  
+}
+
+/// @brief obtain the epoch converter
+/// @details The converter is set up on the first use. This method can be
+/// called from several threads.
+/// @return a reference to the converter
+const IEpochConverter& TimeDependentSubtable::converter() const
+{
+  {
+    boost::shared_lock<boost::shared_mutex> lock(itsMutex);
+    if (itsConverter) {
+        return *itsConverter;
+    }
+  }
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
   if (!itsConverter) {
       // first use, we need to read frame/unit information and set up the 
       // converter
       initConverter();
-   }
+  }
   ASKAPDEBUGASSERT(itsConverter);
-  return itsConverter->toMeasure(time);  
+  return *itsConverter;
 }
 
 /// @brief initialize itsConverter
@@ -39,6 +39,7 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/shared_mutex.hpp>
 
 // casa includes
 #include <casacore/measures/Measures/MEpoch.h>
@@ -82,8 +83,15 @@ struct TimeDependentSubtable : virtual public ITimeDependentSubtable {
 
 protected:
   /// @brief initialize itsConverter
+  /// @details This method should be called with the unique lock held
   void initConverter() const;
 
+  /// @brief obtain the epoch converter
+  /// @details The converter is set up on the first use. This method can be
+  /// called from several threads.
+  /// @return a reference to the converter
+  const IEpochConverter& converter() const;
+
   /// @brief translate a name of the epoch reference frame to the type enum
   /// @details Table store the reference frame as a string and one needs a
   /// way to convert it to a enum used in the constructor of the epoch
@@ -93,6 +101,9 @@ protected:
   static casacore::MEpoch::Types frameType(const casacore::String &name);
 private:
   mutable boost::shared_ptr<IEpochConverter const> itsConverter;
+
+  /// @brief mutex protecting the lazy initialisation of itsConverter
+  mutable boost::shared_mutex itsMutex;
 };
 
 
@@ -0,0 +1,142 @@
+/// @file
+/// @brief time-sorted index of validity intervals
+/// @details Rows of time-dependent subtables (e.g. FEED) are valid for a
+/// time interval. Finding the rows valid for a given time with a table selection
+/// requires a pass over the whole subtable, which is slow for long observations
+/// with frequent entries. This class holds the intervals sorted by their start time 
+/// and finds the rows valid at the given time with a binary search. 
+///
+/// @copyright (c) 2026 CSIRO
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/TimeIntervalIndex.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty index
+TimeIntervalIndex::TimeIntervalIndex() : itsMaxLength(0.), itsSorted(true), itsHint(0) {}
+
+/// @brief add a row
+/// @param[in] start start time of the validity interval
+/// @param[in] stop stop time of the validity interval
+/// @param[in] row row number in the subtable
+void TimeIntervalIndex::add(casacore::Double start, casacore::Double stop, casacore::uInt row)
+{
+  ASKAPCHECK(stop >= start, "Validity interval of row "<<row<<" ends ("<<stop<<") before it starts ("<<
+             start<<")");
+  Interval interval;
+  interval.itsStart = start;
+  interval.itsStop = stop;
+  interval.itsRow = row;
+  if (itsIntervals.size() && (start < itsIntervals.back().itsStart)) {
+      itsSorted = false;
+  }
+  itsIntervals.push_back(interval);
+  itsMaxLength = std::max(itsMaxLength, stop - start);
+  itsHint = 0;
+}
+
+/// @brief add a row valid at all times
+/// @param[in] row row number in the subtable
+void TimeIntervalIndex::addPermanent(casacore::uInt row)
+{
+  itsPermanentRows.push_back(row);
+}
+
+/// @brief number of rows in the index
+/// @return number of rows added, including the permanent ones
+size_t TimeIntervalIndex::size() const
+{
+  return itsIntervals.size() + itsPermanentRows.size();
+}
+
+/// @brief sort the intervals if necessary
+void TimeIntervalIndex::sort() const
+{
+  if (!itsSorted) {
+      // stable sort keeps the row order for the same start time
+      std::stable_sort(itsIntervals.begin(), itsIntervals.end());
+      itsSorted = true;
+      itsHint = 0;
+  }
+}
+
+/// @brief position of the first interval starting after the given time
+/// @details The search starts from the position found last time.
+/// @param[in] time time of interest
+/// @return index into itsIntervals
+size_t TimeIntervalIndex::upperBound(casacore::Double time) const
+{
+  const size_t nIntervals = itsIntervals.size();
+  ASKAPDEBUGASSERT(itsHint <= nIntervals);
+  if ((itsHint == 0) || (itsIntervals[itsHint - 1].itsStart <= time)) {
+      // monotonic access, a few steps forward are normally sufficient
+      const size_t maxSteps = 4;
+      size_t pos = itsHint;
+      for (size_t step = 0; (step < maxSteps) && (pos < nIntervals); ++step, ++pos) {
+           if (itsIntervals[pos].itsStart > time) {
+               itsHint = pos;
+               return pos;
+           }
+      }
+      if (pos == nIntervals) {
+          itsHint = pos;
+          return pos;
+      }
+  }
+  Interval key;
+  key.itsStart = time;
+  itsHint = static_cast<size_t>(std::upper_bound(itsIntervals.begin(), itsIntervals.end(), key) - 
+                                itsIntervals.begin());
+  return itsHint;
+}
+
+/// @brief find rows valid at the given time
+/// @param[in] time time of interest (in the same frame/units as the intervals)
+/// @param[out] rows row numbers in the ascending order (the vector is resized)
+void TimeIntervalIndex::find(casacore::Double time, std::vector<casacore::uInt> &rows) const
+{
+  sort();
+  rows = itsPermanentRows;
+  // intervals starting after the time don't contain it, and neither do those
+  // starting more than the maximum length before it
+  for (size_t pos = upperBound(time); pos > 0; --pos) {
+       const Interval &interval = itsIntervals[pos - 1];
+       if (interval.itsStart < time - itsMaxLength) {
+           break;
+       }
+       if (interval.itsStop >= time) {
+           rows.push_back(interval.itsRow);
+       }
+  }
+  std::sort(rows.begin(), rows.end());
+}
@@ -0,0 +1,128 @@
+/// @file
+/// @brief time-sorted index of validity intervals
+/// @details Rows of time-dependent subtables (e.g. FEED) are valid for a
+/// time interval. Finding the rows valid for a given time with a table selection
+/// requires a pass over the whole subtable, which is slow for long observations
+/// with frequent entries. This class holds the intervals sorted by their start time 
+/// and finds the rows valid at the given time with a binary search. 
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TIME_INTERVAL_INDEX_H
+#define ASKAP_ACCESSORS_TIME_INTERVAL_INDEX_H
+
+// std includes
+#include <vector>
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief time-sorted index of validity intervals
+/// @details Each row of the subtable is added with its validity interval (start and
+/// stop times are inclusive). Rows valid at all times (e.g. with a zero interval) can be 
+/// added separately. The index is sorted on the first search. The search starts from the 
+/// position found by the previous one, so the cost is amortised constant if times are
+/// requested in the ascending order (the typical access pattern). Otherwise, the binary 
+/// search is done. The search updates this position, so the calls should be synchronised
+/// by the caller if the object is shared between threads.
+/// @ingroup dataaccess_tab
+class TimeIntervalIndex {
+public:
+  /// @brief construct an empty index
+  TimeIntervalIndex();
+
+  /// @brief add a row
+  /// @param[in] start start time of the validity interval
+  /// @param[in] stop stop time of the validity interval
+  /// @param[in] row row number in the subtable
+  void add(casacore::Double start, casacore::Double stop, casacore::uInt row);
+
+  /// @brief add a row valid at all times
+  /// @param[in] row row number in the subtable
+  void addPermanent(casacore::uInt row);
+
+  /// @brief find rows valid at the given time
+  /// @param[in] time time of interest (in the same frame/units as the intervals)
+  /// @param[out] rows row numbers in the ascending order (the vector is resized)
+  void find(casacore::Double time, std::vector<casacore::uInt> &rows) const;
+
+  /// @brief number of rows in the index
+  /// @return number of rows added, including the permanent ones
+  size_t size() const;
+
+protected:
+  /// @brief validity interval of a single row
+  struct Interval {
+     /// @brief start time
+     casacore::Double itsStart;
+     /// @brief stop time
+     casacore::Double itsStop;
+     /// @brief row number
+     casacore::uInt itsRow;
+
+     /// @brief comparison by the start time used for sorting
+     /// @param[in] other interval to compare with
+     /// @return true if this interval starts before the other one
+     inline bool operator<(const Interval &other) const { return itsStart < other.itsStart; }
+  };
+
+  /// @brief sort the intervals if necessary
+  void sort() const;
+
+  /// @brief position of the first interval starting after the given time
+  /// @details The search starts from the position found last time.
+  /// @param[in] time time of interest
+  /// @return index into itsIntervals
+  size_t upperBound(casacore::Double time) const;
+
+private:
+  /// @brief intervals sorted by the start time (after sort is called)
+  mutable std::vector<Interval> itsIntervals;
+
+  /// @brief rows valid at all times
+  std::vector<casacore::uInt> itsPermanentRows;
+
+  /// @brief maximum length of the intervals
+  /// @details Intervals which start more than this before the time of interest 
+  /// can't contain it
+  casacore::Double itsMaxLength;
+
+  /// @brief true if itsIntervals is sorted
+  mutable bool itsSorted;
+
+  /// @brief position found by the last search
+  mutable size_t itsHint;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TIME_INTERVAL_INDEX_H
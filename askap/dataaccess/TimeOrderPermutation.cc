@@ -0,0 +1,306 @@
+/// @file
+/// @brief permutation of rows putting the main table in the time order
+/// @details Measurement sets produced by merging or splitting tools are not always
+/// written in the time order. Iterators go through time steps in the order of rows, so
+/// such data have to be re-sorted (i.e. copied) before the processing. This class
+/// holds the permutation of rows which puts the TIME column in the non-decreasing order.
+/// It is built once per measurement set from the TIME column (sorted in parallel) and 
+/// can be stored in a file next to the measurement set to be reused by other jobs.
+/// Iterators then visit the selected rows in the time order via a reference table.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/TimeOrderPermutation.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
+
+// LOFAR includes
+#include <Blob/BlobIBufStream.h>
+#include <Blob/BlobOBufStream.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief minimum number of rows per thread
+/// @details Smaller blocks are not worth the overhead of starting threads
+const casacore::uInt theirMinRowsPerThread = 65536;
+
+/// @brief comparison of row numbers by time
+struct TimeLess {
+  /// @brief set up the comparison
+  /// @param[in] time pointer to the time of the first row
+  explicit TimeLess(const casacore::Double *time) : itsTime(time) {}
+
+  /// @brief compare two rows
+  /// @param[in] row1 first row
+  /// @param[in] row2 second row
+  /// @return true if the first row is earlier than the second one
+  bool operator()(casacore::uInt row1, casacore::uInt row2) const 
+       { return itsTime[row1] < itsTime[row2]; }
+private:
+  /// @brief pointer to the time of the first row
+  const casacore::Double *itsTime;
+};
+
+/// @brief sort a block of row numbers by time
+/// @param[in] first pointer to the first row number of the block
+/// @param[in] last pointer past the last row number of the block
+/// @param[in] time pointer to the time of the first row
+void sortBlock(casacore::uInt *first, casacore::uInt *last, const casacore::Double *time)
+{
+  std::stable_sort(first, last, TimeLess(time));
+}
+
+/// @brief merge two adjacent sorted blocks of row numbers
+/// @param[in] first pointer to the first row number of the first block
+/// @param[in] middle pointer to the first row number of the second block
+/// @param[in] last pointer past the last row number of the second block
+/// @param[in] time pointer to the time of the first row
+void mergeBlocks(casacore::uInt *first, casacore::uInt *middle, casacore::uInt *last,
+                 const casacore::Double *time)
+{
+  std::inplace_merge(first, middle, last, TimeLess(time));
+}
+
+} // anonymous namespace
+
+/// @brief build the permutation
+/// @details The rows are split into blocks sorted by separate threads, the 
+/// sorted blocks are then merged pairwise (also in parallel).
+/// @param[in] time TIME column of the main table (see TimeColumnIndex::time)
+/// @param[in] nThreads number of threads, zero means the number of cores
+TimeOrderPermutation::TimeOrderPermutation(const casacore::Vector<casacore::Double> &time, 
+                                           casacore::uInt nThreads)
+{
+  sort(time, itsRows, nThreads);
+}
+
+/// @brief empty permutation to be filled by load
+TimeOrderPermutation::TimeOrderPermutation() {}
+
+/// @brief read the permutation from a file
+/// @details The file is only accepted if it has been written for the measurement set 
+/// with the same name and number of rows, and the main table hasn't been modified 
+/// since (the latest modification time of the files of the table is compared).
+/// @param[in] fileName name of the file written by save
+/// @param[in] ms measurement set (main table)
+/// @return shared pointer to the permutation or an empty pointer if the file doesn't
+/// exist or is not valid for this measurement set
+boost::shared_ptr<TimeOrderPermutation> TimeOrderPermutation::load(const std::string &fileName, 
+                                                                   const casacore::Table &ms)
+{
+  boost::shared_ptr<TimeOrderPermutation> result;
+  try {
+     std::ifstream fs(fileName.c_str(), std::ios::in | std::ios::binary);
+     if (!fs) {
+         return result;
+     }
+     LOFAR::BlobIBufStream bib(fs);
+     LOFAR::BlobIStream in(bib);
+     if (in.getStart("TimeOrderPermutation") != 1) {
+         return result;
+     }
+     std::string msName;
+     casacore::uInt nRow = 0;
+     casacore::uInt modifyTime = 0;
+     in >> msName >> nRow >> modifyTime;
+     if ((msName != ms.tableName()) || (nRow != casacore::uInt(ms.nrow())) || 
+         (modifyTime != tableModifyTime(ms))) {
+         return result;
+     }
+     boost::shared_ptr<TimeOrderPermutation> permutation(new TimeOrderPermutation);
+     permutation->itsRows.resize(nRow);
+     if (nRow > 0) {
+         in.get(permutation->itsRows.data(), nRow);
+     }
+     in.getEnd();
+     result = permutation;
+  }
+  catch (const std::exception &) {
+     // corrupted or incompatible file, the permutation will be rebuilt
+     return boost::shared_ptr<TimeOrderPermutation>();
+  }
+  return result;
+}
+
+/// @brief write the permutation into a file
+/// @details The file is written under a temporary name and renamed at the end,
+/// so concurrent readers never see a partial file.
+/// @param[in] fileName name of the file
+/// @param[in] ms measurement set (main table) the permutation has been built for
+void TimeOrderPermutation::save(const std::string &fileName, const casacore::Table &ms) const
+{
+  ASKAPCHECK(fileName != "", "An empty file name is given for the time order permutation");
+  ASKAPCHECK(nrow() == casacore::uInt(ms.nrow()), "The permutation has "<<nrow()<<
+             " rows, while the table "<<ms.tableName()<<" has "<<ms.nrow()<<" rows");
+  std::ostringstream os;
+  os<<fileName<<".tmp"<<getpid();
+  const std::string tmpName = os.str();
+  {
+    std::ofstream fs(tmpName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    ASKAPCHECK(fs, "Unable to create the time order permutation file "<<tmpName);
+    {
+      LOFAR::BlobOBufStream bob(fs);
+      LOFAR::BlobOStream out(bob);
+      out.putStart("TimeOrderPermutation", 1);
+      out << std::string(ms.tableName()) << nrow() << tableModifyTime(ms);
+      if (nrow() > 0) {
+          ASKAPDEBUGASSERT(itsRows.contiguousStorage());
+          out.put(itsRows.data(), nrow());
+      }
+      out.putEnd();
+    }
+    fs.close();
+    if (!fs) {
+        std::remove(tmpName.c_str());
+        ASKAPTHROW(DataAccessError, "Unable to write the time order permutation file "<<tmpName);
+    }
+  }
+  if (std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+      std::remove(tmpName.c_str());
+      ASKAPTHROW(DataAccessError, "Unable to rename "<<tmpName<<" into "<<fileName);
+  }
+}
+
+/// @brief put a subset of rows in the time order
+/// @details The selected rows are given in an arbitrary order, the result contains
+/// the same rows in the order they appear in the permutation. 
+/// @param[in] selected row numbers of the main table
+/// @param[out] sorted the same rows in the time order
+void TimeOrderPermutation::order(const casacore::Vector<casacore::uInt> &selected, 
+                                 casacore::Vector<casacore::uInt> &sorted) const
+{
+  const casacore::uInt nRow = nrow();
+  std::vector<bool> isSelected(nRow, false);
+  for (casacore::uInt index = 0; index < selected.nelements(); ++index) {
+       ASKAPCHECK(selected[index] < nRow, "Row "<<selected[index]<<
+                  " is outside the time order permutation of "<<nRow<<" rows");
+       isSelected[selected[index]] = true;
+  }
+  sorted.resize(selected.nelements());
+  casacore::uInt count = 0;
+  for (casacore::uInt index = 0; index < nRow; ++index) {
+       const casacore::uInt row = itsRows[index];
+       if (isSelected[row]) {
+           ASKAPDEBUGASSERT(count < sorted.nelements());
+           sorted[count++] = row;
+       }
+  }
+  ASKAPCHECK(count == selected.nelements(), "Selected rows are expected to be unique");
+}
+
+/// @brief stable parallel sort of row numbers by time
+/// @param[in] time time for each row
+/// @param[out] rows row numbers sorted by time (resized as necessary)
+/// @param[in] nThreads number of threads, zero means the number of cores
+void TimeOrderPermutation::sort(const casacore::Vector<casacore::Double> &time, 
+                                casacore::Vector<casacore::uInt> &rows, casacore::uInt nThreads)
+{
+  // plain pointers used below assume a contiguous storage, copy the input otherwise
+  const casacore::Vector<casacore::Double> contTime = time.contiguousStorage() ?
+          time : casacore::Vector<casacore::Double>(time.copy());
+  const casacore::uInt nRow = contTime.nelements();
+  rows.resize(nRow);
+  ASKAPDEBUGASSERT(rows.contiguousStorage());
+  casacore::indgen(rows);
+  if (nRow < 2) {
+      return;
+  }
+  if (nThreads == 0) {
+      nThreads = std::max(1u, boost::thread::hardware_concurrency());
+  }
+  const casacore::uInt nBlocks = std::max(1u, std::min(nThreads, nRow / theirMinRowsPerThread));
+  casacore::uInt *data = rows.data();
+  const casacore::Double *timeData = contTime.data();
+  std::vector<casacore::uInt> bounds(nBlocks + 1);
+  for (casacore::uInt block = 0; block <= nBlocks; ++block) {
+       bounds[block] = casacore::uInt(size_t(nRow) * block / nBlocks);
+  }
+  // the calling thread sorts the last block, the initial order of rows is 
+  // increasing, so sorting blocks separately retains the stability
+  {
+    boost::thread_group threads;
+    for (casacore::uInt block = 0; block + 1 < nBlocks; ++block) {
+         threads.create_thread(boost::bind(sortBlock, data + bounds[block], 
+                               data + bounds[block + 1], timeData));
+    }
+    sortBlock(data + bounds[nBlocks - 1], data + nRow, timeData);
+    threads.join_all();
+  }
+  // merge adjacent blocks pairwise until there is only one left
+  for (casacore::uInt step = 1; step < nBlocks; step *= 2) {
+       boost::thread_group threads;
+       for (casacore::uInt block = 0; block + step < nBlocks; block += 2 * step) {
+            const casacore::uInt end = std::min(block + 2 * step, nBlocks);
+            threads.create_thread(boost::bind(mergeBlocks, data + bounds[block],
+                      data + bounds[block + step], data + bounds[end], timeData));
+       }
+       threads.join_all();
+  }
+}
+
+/// @brief latest modification time of a table
+/// @details The time is the latest one among the files of the table directory except
+/// the lock file. The permutation file should be stored outside the table.
+/// @param[in] ms table
+/// @return modification time in seconds since the epoch
+casacore::uInt TimeOrderPermutation::tableModifyTime(const casacore::Table &ms)
+{
+  const std::string path = ms.tableName();
+  const casacore::Directory dir(path);
+  ASKAPCHECK(dir.exists(), "Table "<<path<<" is not found");
+  casacore::uInt result = 0;
+  for (casacore::DirectoryIterator it(dir); !it.pastEnd(); ++it) {
+       // the lock file is updated by readers as well
+       if (it.name() != "table.lock") {
+           result = std::max(result, casacore::File(path + "/" + it.name()).modifyTime());
+       }
+  }
+  return result;
+}
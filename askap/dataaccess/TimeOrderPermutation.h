@@ -0,0 +1,130 @@
+/// @file
+/// @brief permutation of rows putting the main table in the time order
+/// @details Measurement sets produced by merging or splitting tools are not always
+/// written in the time order. Iterators go through time steps in the order of rows, so
+/// such data have to be re-sorted (i.e. copied) before the processing. This class
+/// holds the permutation of rows which puts the TIME column in the non-decreasing order.
+/// It is built once per measurement set from the TIME column (sorted in parallel) and 
+/// can be stored in a file next to the measurement set to be reused by other jobs.
+/// Iterators then visit the selected rows in the time order via a reference table.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TIME_ORDER_PERMUTATION_H
+#define ASKAP_ACCESSORS_TIME_ORDER_PERMUTATION_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/tables/Tables/Table.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief permutation of rows putting the main table in the time order
+/// @details The sort is stable, i.e. rows with the same time stamp retain their 
+/// original order. The permutation doesn't change after it is built, so it can be 
+/// shared between iterators and threads. 
+/// @ingroup dataaccess_tab
+class TimeOrderPermutation : private boost::noncopyable {
+public:
+  /// @brief build the permutation
+  /// @details The rows are split into blocks sorted by separate threads, the 
+  /// sorted blocks are then merged pairwise (also in parallel).
+  /// @param[in] time TIME column of the main table (see TimeColumnIndex::time)
+  /// @param[in] nThreads number of threads, zero means the number of cores
+  explicit TimeOrderPermutation(const casacore::Vector<casacore::Double> &time, 
+                                casacore::uInt nThreads = 0);
+
+  /// @brief read the permutation from a file
+  /// @details The file is only accepted if it has been written for the measurement set 
+  /// with the same name and number of rows, and the main table hasn't been modified 
+  /// since (the latest modification time of the files of the table is compared).
+  /// @param[in] fileName name of the file written by save
+  /// @param[in] ms measurement set (main table)
+  /// @return shared pointer to the permutation or an empty pointer if the file doesn't
+  /// exist or is not valid for this measurement set
+  static boost::shared_ptr<TimeOrderPermutation> load(const std::string &fileName, 
+                                                      const casacore::Table &ms);
+
+  /// @brief write the permutation into a file
+  /// @details The file is written under a temporary name and renamed at the end,
+  /// so concurrent readers never see a partial file.
+  /// @param[in] fileName name of the file
+  /// @param[in] ms measurement set (main table) the permutation has been built for
+  void save(const std::string &fileName, const casacore::Table &ms) const;
+
+  /// @brief rows in the time order
+  /// @return row numbers of the main table sorted by time
+  inline const casacore::Vector<casacore::uInt>& rows() const { return itsRows; }
+
+  /// @brief number of rows in the permutation
+  /// @return number of rows in the main table at the time of construction
+  inline casacore::uInt nrow() const { return itsRows.nelements(); }
+
+  /// @brief put a subset of rows in the time order
+  /// @details The selected rows are given in an arbitrary order, the result contains
+  /// the same rows in the order they appear in the permutation. 
+  /// @param[in] selected row numbers of the main table
+  /// @param[out] sorted the same rows in the time order
+  void order(const casacore::Vector<casacore::uInt> &selected, 
+             casacore::Vector<casacore::uInt> &sorted) const;
+
+  /// @brief stable parallel sort of row numbers by time
+  /// @param[in] time time for each row
+  /// @param[out] rows row numbers sorted by time (resized as necessary)
+  /// @param[in] nThreads number of threads, zero means the number of cores
+  static void sort(const casacore::Vector<casacore::Double> &time, 
+                   casacore::Vector<casacore::uInt> &rows, casacore::uInt nThreads = 0);
+
+private:
+  /// @brief empty permutation to be filled by load
+  TimeOrderPermutation();
+
+  /// @brief latest modification time of a table
+  /// @details The time is the latest one among the files of the table directory except
+  /// the lock file. The permutation file should be stored outside the table.
+  /// @param[in] ms table
+  /// @return modification time in seconds since the epoch
+  static casacore::uInt tableModifyTime(const casacore::Table &ms);
+
+  /// @brief row numbers sorted by time
+  casacore::Vector<casacore::uInt> itsRows;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TIME_ORDER_PERMUTATION_H
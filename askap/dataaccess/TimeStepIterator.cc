@@ -0,0 +1,177 @@
+/// @file
+/// @brief iteration over time steps as row ranges of a table
+/// @details The table-based iterator used to step through the selected table with
+/// casacore::TableIterator over TIME (without sorting). Each step of such an iterator
+/// creates a new reference table and all columns have to be attached to it again,
+/// which dominates for datasets with many short integrations and few rows each.
+/// This class reads the TIME column once and finds the ranges of consecutive rows
+/// with the same time. Each step is then described by a range of rows of the
+/// original table, so columns can be attached once for the whole pass.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/TimeStepIterator.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// std includes
+#include <algorithm>
+
+namespace {
+
+/// @brief comparison of rows by data description and field
+struct DescriptionOrder {
+  /// @brief construct the object
+  /// @param[in] dataDescIDs DATA_DESC_ID column
+  /// @param[in] fieldIDs FIELD_ID column, empty vector if there is no such column
+  DescriptionOrder(const casacore::Vector<casacore::Int> &dataDescIDs, 
+                   const casacore::Vector<casacore::Int> &fieldIDs) :
+                   itsDataDescIDs(dataDescIDs), itsFieldIDs(fieldIDs) {}
+
+  /// @brief compare two rows
+  bool operator()(casacore::uInt row1, casacore::uInt row2) const 
+     { 
+       if (itsDataDescIDs[row1] != itsDataDescIDs[row2]) {
+           return itsDataDescIDs[row1] < itsDataDescIDs[row2];
+       }
+       return (itsFieldIDs.nelements() > 0) && (itsFieldIDs[row1] < itsFieldIDs[row2]);
+     }
+
+  /// @brief DATA_DESC_ID column
+  const casacore::Vector<casacore::Int> &itsDataDescIDs;
+
+  /// @brief FIELD_ID column
+  const casacore::Vector<casacore::Int> &itsFieldIDs;
+};
+
+} // anonymous namespace
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct an iterator which is past the end
+TimeStepIterator::TimeStepIterator() : itsStep(0), itsGrouped(false) {}
+
+/// @brief construct an iterator over the given table
+/// @details The iterator is positioned at the first step
+/// @param[in] tab table to iterate over
+/// @param[in] group if true, rows of each step are grouped by DATA_DESC_ID and
+/// FIELD_ID (if the latter is present)
+TimeStepIterator::TimeStepIterator(const casacore::Table &tab, bool group) : itsTable(tab), 
+          itsStep(0), itsGrouped(false)
+{
+  const casacore::uInt nRow = tab.nrow();
+  if (nRow == 0) {
+      return;
+  }
+  // one bulk read instead of a reference table per time step
+  const casacore::Vector<casacore::Double> times = 
+        casacore::ROScalarColumn<casacore::Double>(tab, "TIME").getColumn();
+  ASKAPDEBUGASSERT(times.nelements() == nRow);
+  itsBoundaries.push_back(0);
+  for (casacore::uInt row = 1; row < nRow; ++row) {
+       // exact comparison, as done by casacore::TableIterator
+       if (times[row] != times[row - 1]) {
+           itsBoundaries.push_back(row);
+       }
+  }
+  itsBoundaries.push_back(nRow);
+  if (group) {
+      groupRows();
+  }
+}
+
+/// @brief group rows of each step by data description and field
+/// @details itsBoundaries should be filled. If the order of rows changes,
+/// itsTable is replaced by the reference table with the permuted rows.
+void TimeStepIterator::groupRows()
+{
+  const casacore::Vector<casacore::Int> dataDescIDs = 
+        casacore::ROScalarColumn<casacore::Int>(itsTable, "DATA_DESC_ID").getColumn();
+  casacore::Vector<casacore::Int> fieldIDs;
+  if (itsTable.actualTableDesc().isColumn("FIELD_ID")) {
+      fieldIDs.assign(casacore::ROScalarColumn<casacore::Int>(itsTable, "FIELD_ID").getColumn());
+  }
+  std::vector<casacore::uInt> rows(itsTable.nrow());
+  for (size_t row = 0; row < rows.size(); ++row) {
+       rows[row] = casacore::uInt(row);
+  }
+  const DescriptionOrder order(dataDescIDs, fieldIDs);
+  bool permuted = false;
+  for (size_t step = 0; step + 1 < itsBoundaries.size(); ++step) {
+       const std::vector<casacore::uInt>::iterator first = rows.begin() + itsBoundaries[step];
+       const std::vector<casacore::uInt>::iterator last = rows.begin() + itsBoundaries[step + 1];
+       if (!std::is_sorted(first, last, order)) {
+           // stable sort preserves the original order of rows within each group
+           std::stable_sort(first, last, order);
+           permuted = true;
+       }
+  }
+  if (permuted) {
+      // row numbers are w.r.t. the given table, the reference table maps them
+      itsTable = itsTable(casacore::Vector<casacore::uInt>(rows));
+      itsGrouped = true;
+  }
+}
+
+/// @brief move to the first step
+void TimeStepIterator::reset()
+{
+  itsStep = 0;
+}
+
+/// @brief move to the next step
+void TimeStepIterator::next()
+{
+  ASKAPDEBUGASSERT(!pastEnd());
+  ++itsStep;
+}
+
+/// @brief first row of the current step
+/// @return row number in table(), the number of rows of the table if past the end
+casacore::uInt TimeStepIterator::startRow() const
+{
+  if (pastEnd()) {
+      return itsBoundaries.size() > 0 ? itsBoundaries.back() : 0;
+  }
+  return itsBoundaries[itsStep];
+}
+
+/// @brief number of rows in the current step
+/// @return number of rows, zero if past the end
+casacore::uInt TimeStepIterator::nrow() const
+{
+  return pastEnd() ? 0 : itsBoundaries[itsStep + 1] - itsBoundaries[itsStep];
+}
+
+} // namespace accessors
+
+} // namespace askap
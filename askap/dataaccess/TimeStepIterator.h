@@ -0,0 +1,127 @@
+/// @file
+/// @brief iteration over time steps as row ranges of a table
+/// @details The table-based iterator used to step through the selected table with
+/// casacore::TableIterator over TIME (without sorting). Each step of such an iterator
+/// creates a new reference table and all columns have to be attached to it again,
+/// which dominates for datasets with many short integrations and few rows each.
+/// This class reads the TIME column once and finds the ranges of consecutive rows
+/// with the same time. Each step is then described by a range of rows of the
+/// original table, so columns can be attached once for the whole pass.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_TIME_STEP_ITERATOR_H
+#define ASKAP_ACCESSORS_TIME_STEP_ITERATOR_H
+
+// std includes
+#include <vector>
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief iteration over time steps as row ranges of a table
+/// @details The steps are exactly the same as for casacore::TableIterator over TIME
+/// with the NoSort option, i.e. each step is a maximal range of consecutive rows with
+/// the same time stamp. If the table is time-ordered, there is one step per time stamp.
+/// The boundaries of the steps are found with a single read of the TIME column when
+/// the iterator is constructed. Optionally, rows of each step can be grouped by
+/// DATA_DESC_ID and FIELD_ID. In this case, the iterator works with a reference table
+/// where rows are permuted within each step, so the rows with the same spectral window and
+/// field follow each other and chunks of rows aren't broken more often than necessary.
+/// @ingroup dataaccess_tab
+class TimeStepIterator {
+public:
+  /// @brief construct an iterator which is past the end
+  TimeStepIterator();
+
+  /// @brief construct an iterator over the given table
+  /// @details The iterator is positioned at the first step
+  /// @param[in] tab table to iterate over
+  /// @param[in] group if true, rows of each step are grouped by DATA_DESC_ID and
+  /// FIELD_ID (if the latter is present)
+  explicit TimeStepIterator(const casacore::Table &tab, bool group = false);
+
+  /// @brief move to the first step
+  void reset();
+
+  /// @brief move to the next step
+  void next();
+
+  /// @brief check whether the iteration is complete
+  /// @return true if there are no more steps
+  inline bool pastEnd() const { return itsStep >= nSteps(); }
+
+  /// @brief table the iterator works with
+  /// @details Row ranges of all steps refer to this table
+  /// @return table given in the constructor or the reference table with
+  /// the grouped rows, if grouping was requested and changed the order
+  inline const casacore::Table& table() const { return itsTable; }
+
+  /// @brief first row of the current step
+  /// @return row number in table(), the number of rows of the table if past the end
+  casacore::uInt startRow() const;
+
+  /// @brief number of rows in the current step
+  /// @return number of rows, zero if past the end
+  casacore::uInt nrow() const;
+
+  /// @brief number of steps
+  inline casacore::uInt nSteps() const 
+         { return itsBoundaries.size() > 0 ? casacore::uInt(itsBoundaries.size() - 1) : 0; }
+
+  /// @brief check whether the rows have been permuted
+  /// @return true if table() differs from the table given in the constructor
+  inline bool grouped() const { return itsGrouped; }
+
+private:
+  /// @brief group rows of each step by data description and field
+  /// @details itsBoundaries should be filled. If the order of rows changes,
+  /// itsTable is replaced by the reference table with the permuted rows.
+  void groupRows();
+
+  /// @brief table to iterate over
+  casacore::Table itsTable;
+
+  /// @brief first row of each step followed by the number of rows in the table
+  std::vector<casacore::uInt> itsBoundaries;
+
+  /// @brief current step
+  casacore::uInt itsStep;
+
+  /// @brief true if the rows of itsTable have been permuted
+  bool itsGrouped;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TIME_STEP_ITERATOR_H
@@ -30,6 +30,7 @@
 ///
 
 #include <askap/dataaccess/UVWMachineCache.h>
+#include <askap/dataaccess/MemoryGovernor.h>
 #include <askap/askap/AskapError.h>
 
 // for logging
@@ -37,6 +38,13 @@
 #include <askap/askap/AskapLogging.h>
 ASKAP_LOGGER(logger, ".dataaccess");
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// std includes
+#include <cmath>
+
 
 using namespace askap;
 using namespace askap::accessors;
@@ -45,21 +53,27 @@ using namespace askap::accessors;
 /// @details Set up basic parameters of the cache.
 /// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
 /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
-/// to initialisation of a new UVW Machine
+/// to initialisation of a new UVW Machine (should be positive)
 UVWMachineCache::UVWMachineCache(size_t cacheSize, double tolerance) : itsCache(cacheSize),
-      itsTangentPoints(cacheSize), itsPhaseCentres(cacheSize), 
-      itsOldestElement(0), itsTolerance(tolerance)
+      itsTangentPoints(cacheSize), itsPhaseCentres(cacheSize), itsKeys(cacheSize), 
+      itsUsed(cacheSize, false), itsOldestElement(0), itsTolerance(tolerance), itsStatistics(0)
 {
   ASKAPASSERT(cacheSize>=1);
-  ASKAPDEBUGASSERT(tolerance>0);
+  // the tolerance is also the cell size of the hash keys, see makeKey
+  ASKAPCHECK(tolerance > 0, "Direction tolerance of the uvw machine cache should be positive, you have "<<tolerance);
   ASKAPDEBUGASSERT(itsCache.size() == itsTangentPoints.size());
   ASKAPDEBUGASSERT(itsCache.size() == itsPhaseCentres.size());
+#ifdef _OPENMP
+  itsThreadCaches.resize(size_t(omp_get_max_threads()));
+#endif
+  MemoryGovernor::instance().add(this, "uvw machines", MemoryGovernor::HIGH_PRIORITY);
 }
 
 /// @brief destructor to print some stats
 /// @details This method writes in the log cache utilisation statistics
 UVWMachineCache::~UVWMachineCache()
 {
+   MemoryGovernor::instance().remove(this);
 #ifdef _OPENMP
    boost::shared_lock<boost::shared_mutex> lock(itsMutex);
 #endif
@@ -75,6 +89,63 @@ UVWMachineCache::~UVWMachineCache()
    }
 }
 
+/// @brief memory held by the machines
+/// @details The size of the machine object is counted for each machine which has been set up
+/// @return number of bytes
+size_t UVWMachineCache::memoryUsage() const
+{
+#ifdef _OPENMP
+   boost::shared_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+   size_t cntUsed = 0;
+   for (size_t elem = 0; elem < itsCache.size(); ++elem) {
+        if (itsCache[elem]) {
+            ++cntUsed;
+        }
+   }
+   return cntUsed * sizeof(machineType);
+}
+
+/// @brief comparison operator
+/// @param[in] other another key
+/// @return true, if both keys are the same
+bool UVWMachineCache::CacheKey::operator==(const CacheKey &other) const
+{
+  if ((itsTangentFrame != other.itsTangentFrame) || 
+      (itsPhaseCentreFrame != other.itsPhaseCentreFrame)) {
+      return false;
+  }
+  for (int i = 0; i < 3; ++i) {
+       if ((itsTangent[i] != other.itsTangent[i]) || 
+           (itsPhaseCentre[i] != other.itsPhaseCentre[i])) {
+           return false;
+       }
+  }
+  return true;
+}
+
+/// @brief make the hash key for a pair of directions
+/// @param[in] phaseCentre direction to the input phase centre
+/// @param[in] tangent direction to tangent point
+/// @return the key
+UVWMachineCache::CacheKey UVWMachineCache::makeKey(const casacore::MDirection &phaseCentre, 
+                                                   const casacore::MDirection &tangent) const
+{
+  CacheKey key;
+  key.itsTangentFrame = int(tangent.getRef().getType());
+  key.itsPhaseCentreFrame = int(phaseCentre.getRef().getType());
+  // for small angles, the difference of direction cosines is approximately equal to the
+  // angular separation, so the tolerance is a natural cell size
+  const casacore::Vector<casacore::Double> &tangentCosines = tangent.getValue().getValue();
+  const casacore::Vector<casacore::Double> &phaseCentreCosines = phaseCentre.getValue().getValue();
+  ASKAPDEBUGASSERT(tangentCosines.nelements() == 3);
+  ASKAPDEBUGASSERT(phaseCentreCosines.nelements() == 3);
+  for (int i = 0; i < 3; ++i) {
+       key.itsTangent[i] = casacore::Int64(std::floor(tangentCosines[i] / itsTolerance));
+       key.itsPhaseCentre[i] = casacore::Int64(std::floor(phaseCentreCosines[i] / itsTolerance));
+  }
+  return key;
+}
 
 /// @brief obtain machine for a particular tangent point and phase centre
 /// @details This is the main method of the class.
@@ -84,11 +155,51 @@ UVWMachineCache::~UVWMachineCache()
 const UVWMachineCache::machineType& UVWMachineCache::machine(const casacore::MDirection &phaseCentre,
                                                  const casacore::MDirection &tangent) const
 {  
+   const CacheKey key = makeKey(phaseCentre, tangent);
+#ifdef _OPENMP
+   const int thread = omp_get_thread_num();
+   // thread numbers are only unique within a team, nested parallel regions (active or not)
+   // would share the per-thread index between threads, so they use the shared cache
+   if (omp_in_parallel() && (omp_get_level() == 1) && (thread < int(itsThreadCaches.size()))) {
+       // only this thread works with its index, no lock is required
+       ThreadCache &threadCache = itsThreadCaches[thread];
+       const ThreadCache::const_iterator ci = threadCache.find(key);
+       if ((ci != threadCache.end()) && compare(tangent, ci->second.itsTangent) && 
+           compare(phaseCentre, ci->second.itsPhaseCentre)) {
+           if (itsStatistics != 0) {
+               itsStatistics->machineHit();
+           }
+           return *(ci->second.itsMachine);
+       }
+       if (threadCache.size() >= itsCache.size()) {
+           // keep the number of machines held by each thread the same as for the shared cache
+           threadCache.clear();
+       }
+       ThreadCacheEntry &entry = threadCache[key];
+       entry.itsMachine = sharedMachine(key, phaseCentre, tangent);
+       entry.itsTangent = tangent;
+       entry.itsPhaseCentre = phaseCentre;
+       // the thread index holds the machine, even if it is replaced in the shared cache
+       return *(entry.itsMachine);
+   }
+#endif
+   return *sharedMachine(key, phaseCentre, tangent);
+}
+
+/// @brief obtain machine from the shared cache
+/// @details This method takes the lock and sets up a new machine, if necessary
+/// @param[in] key hash key for the pair of directions
+/// @param[in] phaseCentre direction to the input phase centre
+/// @param[in] tangent direction to tangent point
+/// @return shared pointer to uvw machine 
+boost::shared_ptr<UVWMachineCache::machineType> UVWMachineCache::sharedMachine(const CacheKey &key,
+                const casacore::MDirection &phaseCentre, const casacore::MDirection &tangent) const
+{
 #ifdef _OPENMP
    boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
 #endif
     
-   const size_t index = getIndex(phaseCentre,tangent);
+   const size_t index = getIndex(key, phaseCentre, tangent);
    boost::shared_ptr<machineType> &machinePtr = itsCache[index];
    if (!machinePtr) {
 #ifdef _OPENMP
@@ -101,8 +212,13 @@ const UVWMachineCache::machineType& UVWMachineCache::machine(const casacore::MDi
        // although the casacore manual clearly says that the first argument is "out" and the second is "in".
        // also set the fourth parameter, project, to false, as we do not want to reproject to the input frame.
        // machinePtr.reset(new machineType(phaseCentre, tangent, false, true));
+       if (itsStatistics != 0) {
+           itsStatistics->machineMiss();
+       }
+   } else if (itsStatistics != 0) {
+       itsStatistics->machineHit();
    }
-   return *machinePtr;
+   return machinePtr;
 }
 
 /// @brief a helper method to check whether two directions are matching
@@ -142,15 +258,29 @@ bool UVWMachineCache::compare(const casacore::MDirection &dir1, const casacore::
 /// @brief obtain the index corresponding to a particular tangent point
 /// @details If the cache entry needs updating, the appropriate shared pointer will
 /// be reset. This method updates itsTangentPoints, if necessary.
+/// @param[in] key hash key for the pair of directions
 /// @param[in] phaseCentre direction to the input phase centre
 /// @param[in] tangent direction to tangent point
 /// @return cache index
-size_t UVWMachineCache::getIndex(const casacore::MDirection &phaseCentre, 
+size_t UVWMachineCache::getIndex(const CacheKey &key, const casacore::MDirection &phaseCentre, 
                                  const casacore::MDirection &tangent) const
 {
    // this method is protected and is only called after the upgrade_lock has been acquired.
    // Therefore, we don't need any more locks here.
    
+   // most likely, the directions fall into the same cell as the cached ones
+   const boost::unordered_map<CacheKey, size_t, boost::hash<CacheKey> >::const_iterator ci = 
+                 itsIndex.find(key);
+   if (ci != itsIndex.end()) {
+       const size_t index = ci->second;
+       ASKAPDEBUGASSERT(index < itsCache.size());
+       if (itsUsed[index] && compare(tangent, itsTangentPoints[index]) && 
+           compare(phaseCentre, itsPhaseCentres[index])) {
+           return index;
+       }
+   }
+   
+   // directions close to the cell boundary may match an element with a different key,
    // search from the newest element backwards (i.e. most likely the match is the most
    // recently used tangent point)
    for (int pos=0; pos<int(itsTangentPoints.size()); ++pos) {
@@ -160,7 +290,19 @@ size_t UVWMachineCache::getIndex(const casacore::MDirection &phaseCentre,
             index += int(itsCache.size());
         }
         ASKAPDEBUGASSERT((index>=0) && (index<int(itsTangentPoints.size())));
-        if (compare(tangent, itsTangentPoints[index]) && compare(phaseCentre, itsPhaseCentres[index])) {
+        if (itsUsed[index] && compare(tangent, itsTangentPoints[index]) && 
+            compare(phaseCentre, itsPhaseCentres[index])) {
+            if (itsIndex.size() >= 4 * itsCache.size()) {
+                // too many aliases, rebuild the index from the keys of the elements
+                itsIndex.clear();
+                for (size_t elem = 0; elem < itsCache.size(); ++elem) {
+                     if (itsUsed[elem]) {
+                         itsIndex[itsKeys[elem]] = elem;
+                     }
+                }
+            }
+            // the next lookup with the same key doesn't need to scan the cache
+            itsIndex[key] = size_t(index);
             return size_t(index);
         }
    }
@@ -173,8 +315,21 @@ size_t UVWMachineCache::getIndex(const casacore::MDirection &phaseCentre,
        // wrap around the end of the vector
        itsOldestElement = 0;
    }
+   if (itsUsed[result]) {
+       if (itsStatistics != 0) {
+           itsStatistics->machineEviction();
+       }
+       // remove the old key of this element
+       const boost::unordered_map<CacheKey, size_t, boost::hash<CacheKey> >::iterator it = 
+                 itsIndex.find(itsKeys[result]);
+       if ((it != itsIndex.end()) && (it->second == result)) {
+           itsIndex.erase(it);
+       }
+   }
    itsTangentPoints[result] = tangent;
    itsPhaseCentres[result] = phaseCentre;
+   itsKeys[result] = key;
+   itsUsed[result] = true;
+   itsIndex[key] = result;
    return result;
 }
-
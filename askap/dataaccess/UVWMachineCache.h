@@ -38,6 +38,8 @@
 // boost includes
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
 
 #ifdef _OPENMP
 #include <boost/thread/shared_mutex.hpp>
@@ -48,6 +50,8 @@
 #include <casacore/measures/Measures/UVWMachine.h>
 
 #include <askap/dataaccess/TempUVWMachine.h>
+#include <askap/dataaccess/IteratorStatistics.h>
+#include <askap/dataaccess/IMemoryConsumer.h>
 
 namespace askap {
 
@@ -57,8 +61,18 @@ namespace accessors {
 /// @details
 /// This class maintains the cache of UVW Machines (a pair of tangent point and phase centre directions 
 /// is  the key). The number of machines cached and the direction tolerance are specified as parameters.
+/// Cached machines are found via a hash of the direction cosines quantised with the tolerance, so the
+/// lookup doesn't depend on the cache size. Only directions which fall into a different quantisation
+/// cell than the cached ones (i.e. are close to the cell boundary) require a scan of the whole cache.
+/// If built with OpenMP, each thread of a parallel region has its own small index of the machines it
+/// has used, which is searched without any lock. The shared cache (protected by the mutex) is only 
+/// accessed, if the thread hasn't seen the given pair of directions before. Parallel regions started
+/// by different (non-OpenMP) threads shouldn't use the same cache at the same time as the thread 
+/// numbers are not unique then. The cache reports its usage to MemoryGovernor, but doesn't
+/// release machines on request as references to them are given out.
 /// @ingroup dataaccess
-struct UVWMachineCache : public boost::noncopyable {
+struct UVWMachineCache : virtual public IMemoryConsumer,
+                         public boost::noncopyable {
    
    /// @brief UVWMachine class type
    /// @details For debugging, it is handy to substitute UVWMachine class by another type
@@ -71,7 +85,7 @@ struct UVWMachineCache : public boost::noncopyable {
    /// @details Set up basic parameters of the cache.
    /// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
    /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
-   /// to initialisation of a new UVW Machine
+   /// to initialisation of a new UVW Machine (should be positive)
    explicit UVWMachineCache(size_t cacheSize = 1, double tolerance = 1e-6);
    
    /// @brief destructor to print some stats
@@ -110,14 +124,86 @@ struct UVWMachineCache : public boost::noncopyable {
    /// @return true, if they are matching
    static bool compare(const casacore::MDirection &dir1, const casacore::MDirection &dir2, const double tolerance);
 
+   /// @brief attach statistics
+   /// @details If attached, machines found in the cache (hits), machines set up (misses) and
+   /// machines removed from the cache to make room for a new one (evictions) are counted.
+   /// @param[in] stats statistics to update (zero to detach), the object is not owned by the cache
+   inline void setStatistics(IteratorStatistics *stats) const { itsStatistics = stats; }
+
+   /// @brief memory held by the machines
+   /// @details The size of the machine object is counted for each machine which has been set up
+   /// @return number of bytes
+   virtual size_t memoryUsage() const;
+
 protected:
+   /// @brief quantised pair of directions used as the hash key
+   struct CacheKey {
+      /// @brief reference frame of the tangent point
+      int itsTangentFrame;
+      /// @brief reference frame of the phase centre
+      int itsPhaseCentreFrame;
+      /// @brief quantised direction cosines of the tangent point
+      casacore::Int64 itsTangent[3];
+      /// @brief quantised direction cosines of the phase centre
+      casacore::Int64 itsPhaseCentre[3];
+
+      /// @brief comparison operator
+      /// @param[in] other another key
+      /// @return true, if both keys are the same
+      bool operator==(const CacheKey &other) const;
+
+      /// @brief hash function used by boost::unordered_map
+      /// @param[in] key the key
+      /// @return hash value
+      friend std::size_t hash_value(const CacheKey &key) {
+         std::size_t seed = 0;
+         boost::hash_combine(seed, key.itsTangentFrame);
+         boost::hash_combine(seed, key.itsPhaseCentreFrame);
+         for (int i = 0; i < 3; ++i) {
+              boost::hash_combine(seed, key.itsTangent[i]);
+              boost::hash_combine(seed, key.itsPhaseCentre[i]);
+         }
+         return seed;
+      }
+   };
+
+   /// @brief machine with the directions it has been set up for
+   struct ThreadCacheEntry {
+      /// @brief tangent point
+      casacore::MDirection itsTangent;
+      /// @brief phase centre
+      casacore::MDirection itsPhaseCentre;
+      /// @brief the machine (shared with the main cache)
+      boost::shared_ptr<machineType> itsMachine;
+   };
+
+   /// @brief index of machines used by one thread
+   typedef boost::unordered_map<CacheKey, ThreadCacheEntry, boost::hash<CacheKey> > ThreadCache;
+
+   /// @brief make the hash key for a pair of directions
+   /// @param[in] phaseCentre direction to the input phase centre
+   /// @param[in] tangent direction to tangent point
+   /// @return the key
+   CacheKey makeKey(const casacore::MDirection &phaseCentre, const casacore::MDirection &tangent) const;
+
+   /// @brief obtain machine from the shared cache
+   /// @details This method takes the lock and sets up a new machine, if necessary
+   /// @param[in] key hash key for the pair of directions
+   /// @param[in] phaseCentre direction to the input phase centre
+   /// @param[in] tangent direction to tangent point
+   /// @return shared pointer to uvw machine 
+   boost::shared_ptr<machineType> sharedMachine(const CacheKey &key, 
+                const casacore::MDirection &phaseCentre, const casacore::MDirection &tangent) const;
+
    /// @brief obtain the index corresponding to a particular tangent point
    /// @details If the cache entry needs updating, the appropriate shared pointer will
    /// be reset. This method updates itsTangentPoints, if necessary.
+   /// @param[in] key hash key for the pair of directions
    /// @param[in] phaseCentre direction to the input phase centre
    /// @param[in] tangent direction to tangent point
    /// @return cache index
-   size_t getIndex(const casacore::MDirection &phaseCentre, const casacore::MDirection &tangent) const;
+   size_t getIndex(const CacheKey &key, const casacore::MDirection &phaseCentre, 
+                   const casacore::MDirection &tangent) const;
    
 private:
 
@@ -133,12 +219,31 @@ private:
    /// @brief cached phase centre directions
    mutable std::vector<casacore::MDirection> itsPhaseCentres;
    
+   /// @brief hash keys of the cached machines
+   mutable std::vector<CacheKey> itsKeys;
+
+   /// @brief true for the cache elements which have been set up
+   mutable std::vector<bool> itsUsed;
+
+   /// @brief hash index of the cache (key to the position in itsCache)
+   mutable boost::unordered_map<CacheKey, size_t, boost::hash<CacheKey> > itsIndex;
+
    /// @brief index of the oldest element in the cache
    mutable size_t itsOldestElement;
+
+   /// @brief per-thread indices of the machines, vector index is the thread number
+   /// @details Each element is only accessed by the thread with the corresponding number,
+   /// therefore no lock is required. This only holds for the outermost parallel region,
+   /// threads of nested regions (where thread numbers are not unique) and threads with
+   /// larger numbers use the shared cache directly.
+   mutable std::vector<ThreadCache> itsThreadCaches;
       
    /// @brief direction tolerance
    /// @details It determines whether we a new machine has to be created
    double itsTolerance; 
+
+   /// @brief statistics to update, zero if not attached
+   mutable IteratorStatistics *itsStatistics;
  
 #ifdef _OPENMP  
    /// @brief mutex to synchronise cache access
@@ -32,12 +32,17 @@
 ///
 
 #include <askap/dataaccess/UVWRotationHandler.h>
+#include <askap/dataaccess/UVWRotationKernel.h>
 #include <askap/askap/AskapError.h>
 
 #include <casacore/measures/Measures/MeasFrame.h>
 #include <casacore/measures/Measures/MEpoch.h>
 #include <askap/askap/AskapUtil.h>
 
+// std includes
+#include <vector>
+#include <utility>
+
 
 using namespace askap;
 using namespace askap::accessors;
@@ -48,7 +53,7 @@ using namespace askap::accessors;
 /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
 /// to initialisation of a new UVW Machine and recompute of the rotated uvws/delays
 UVWRotationHandler::UVWRotationHandler(size_t cacheSize, double tolerance) :
-         UVWMachineCache(cacheSize, tolerance), itsValid(false) {}
+         UVWMachineCache(cacheSize, tolerance), itsValid(false), itsFacetValid(false) {}
 
 
 /// @brief invalidate the cache
@@ -61,6 +66,7 @@ void UVWRotationHandler::invalidate() const
 #endif
 
    itsValid = false;
+   itsFacetValid = false;
 }
 
 
@@ -69,11 +75,15 @@ void UVWRotationHandler::invalidate() const
 /// Use parameters in the given accessor to compute rotated uvws
 /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
 /// @param[in] tangent direction to the tangent point
+/// @param[in] store optional store of rotated uvws shared between iterations, the results
+/// are taken from it if available and are put there after calculation otherwise
+/// @param[in] key chunk of the measurement set the accessor corresponds to (used with the store)
 /// @return const reference to rotated uvws
 /// @note the method doesn't monitor a change to the accessor. It expects that invalidate
 /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
 const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotationHandler::uvw(const IConstDataAccessor &acc,
-               const casacore::MDirection &tangent) const
+               const casacore::MDirection &tangent, RotatedUVWStore *store,
+               const RotatedUVWStore::ChunkKey *key) const
 {
   ASKAPCHECK(tangent.getRef().getType() == casacore::MDirection::J2000,
       "This is a cautionary assertion because a number of places in the code implicitly assume J2000 for "
@@ -96,6 +106,11 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotation
      itsTangentPoint = tangent;
      itsImageCentre = tangent;
      itsValid = true;
+     if ((store != NULL) && (key != NULL) && store->get(*key, tangent, itsRotatedUVWs, itsDelays)) {
+         // results of an earlier pass over the same chunk
+         ASKAPDEBUGASSERT(itsRotatedUVWs.nelements() == nSamples);
+         return itsRotatedUVWs;
+     }
      // just copy rotation code from TableVisGridder for a moment
      const casacore::Vector<casacore::RigidVector<double, 3> >& uvwVector = acc.uvw();
      //casacore::Vector<casacore::MVDirection> pointingDir1Vector =
@@ -117,35 +132,35 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotation
      casacore::Quantity::read(tmpdec,"-63.54.30");
      pointingDir1Vector.set(casacore::MVDirection(tmpra,tmpdec));
      */
-     //
-     casacore::Vector<double> uvwBuffer(3);
-     const UVWMachineCache::machineType * uvwm;
-     for (casacore::uInt row=0; row<nSamples; ++row) {
-          const casacore::RigidVector<double, 3> &uvwRow = uvwVector(row);
+     // rows are processed in runs with the same pointing direction, the rotation is extracted
+     // from the uvw machine once per pointing direction (there are few of them, e.g. beams)
+     std::vector<std::pair<casacore::MVDirection, UVWRotationKernel> > kernels;
+     size_t current = 0;
+     for (casacore::uInt row=0; row<nSamples;) {
           /// @todo Decide what to do about pointingDir1!=pointingDir2
-          for (int i=0; i<3; ++i) {
-               uvwBuffer(i) = (i<2 ? -1. : 1.) * uvwRow(i);
-          }
-
-          /// @note we actually pass MVDirection as MDirection. The code had just been
-          /// copied, so this bug had been here for a while. It means that J2000 is
-          /// hard coded in the next line (quite implicitly).
-          //const UVWMachineCache::machineType& uvwm = machine(pointingDir1Vector(row),itsTangentPoint);
+          const casacore::MVDirection &dir = pointingDir1Vector(row);
+          casacore::uInt end = row + 1;
           // Optimise the common case where all pointingdirs are the same
-          if (row==0 || pointingDir1Vector(row)!=pointingDir1Vector(row-1)) {
-              uvwm = &machine(pointingDir1Vector(row),itsTangentPoint);
-          }
-          uvwm->convertUVW(itsDelays(row), uvwBuffer);
-
-          // the following line is to be commented out if we swap arguments in the uvw machine call
-          // (swapping the sign of uvw's above is another way to achieve a similar outcome
-          //itsDelays(row) *= -1;
-          //
-
-          for (int i=0; i<3; ++i) {
-               itsRotatedUVWs(row)(i) = (i<2 ? -1. : 1.) * uvwBuffer(i);
+          for (; (end < nSamples) && !(pointingDir1Vector(end) != dir); ++end) {}
+          if ((current >= kernels.size()) || (kernels[current].first != dir)) {
+              for (current = 0; current < kernels.size(); ++current) {
+                   if (!(kernels[current].first != dir)) {
+                       break;
+                   }
+              }
+              if (current == kernels.size()) {
+                  /// @note we actually pass MVDirection as MDirection. The code had just been
+                  /// copied, so this bug had been here for a while. It means that J2000 is
+                  /// hard coded in the next line (quite implicitly).
+                  kernels.push_back(std::make_pair(dir, UVWRotationKernel(machine(dir,itsTangentPoint))));
+              }
           }
-
+          ASKAPDEBUGASSERT(current < kernels.size());
+          kernels[current].second.apply(uvwVector, row, end, itsRotatedUVWs, itsDelays);
+          row = end;
+     }
+     if ((store != NULL) && (key != NULL)) {
+         store->put(*key, tangent, itsRotatedUVWs, itsDelays);
      }
   }
   return itsRotatedUVWs;
@@ -158,13 +173,16 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotation
 /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
 /// @param[in] tangent direction to the tangent point
 /// @param[in] imageCentre direction to the image centre
+/// @param[in] store optional store of rotated uvws shared between iterations (see uvw)
+/// @param[in] key chunk of the measurement set the accessor corresponds to (used with the store)
 /// @return const reference to delay vector
 /// @note the method doesn't monitor a change to the accessor. It expects that invalidate
 /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
 const casacore::Vector<casacore::Double>& UVWRotationHandler::delays(const IConstDataAccessor &acc,
-               const casacore::MDirection &tangent, const casacore::MDirection &imageCentre) const
+               const casacore::MDirection &tangent, const casacore::MDirection &imageCentre,
+               RotatedUVWStore *store, const RotatedUVWStore::ChunkKey *key) const
 {
-  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvwBuffer = uvw(acc, tangent);
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvwBuffer = uvw(acc, tangent, store, key);
 
 #ifdef _OPENMP
   boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
@@ -220,3 +238,92 @@ const casacore::Vector<casacore::Double>& UVWRotationHandler::delays(const ICons
   }
   return itsDelays;
 }
+
+/// @brief check that the cached facet result corresponds to the given tangent points
+/// @param[in] tangents directions to the tangent points of all facets
+/// @return true if the cache can be used
+bool UVWRotationHandler::facetCacheMatches(const std::vector<casacore::MDirection> &tangents) const
+{
+  if (!itsFacetValid || (tangents.size() != itsFacetUVW.nFacets())) {
+      return false;
+  }
+  for (size_t facet = 0; facet < tangents.size(); ++facet) {
+       if (!compare(tangents[facet], itsFacetUVW.tangentPoints()[facet])) {
+           return false;
+       }
+  }
+  return true;
+}
+
+/// @brief obtain uvws rotated to a number of tangent points
+/// @details
+/// All facets are processed in one pass over the rows: the rotation for each pair of
+/// the pointing direction and the tangent point is extracted from the uvw machine once
+/// and applied to the run of rows with this pointing direction. The result is cached
+/// independently of the single tangent point result (returned by uvw and delays), so
+/// both can be used for the same chunk without invalidating each other.
+/// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
+/// @param[in] tangents directions to the tangent points of all facets
+/// @return const reference to rotated uvws and delays for each facet
+/// @note the method doesn't monitor a change to the accessor. It expects that invalidate
+/// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
+const FacetRotatedUVW& UVWRotationHandler::facetUVW(const IConstDataAccessor &acc,
+               const std::vector<casacore::MDirection> &tangents) const
+{
+  for (std::vector<casacore::MDirection>::const_iterator ci = tangents.begin(); ci != tangents.end(); ++ci) {
+       ASKAPCHECK(ci->getRef().getType() == casacore::MDirection::J2000,
+           "Tangent points are expected in J2000, see the note in UVWRotationHandler::uvw");
+  }
+
+#ifdef _OPENMP
+  boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+
+  if (!facetCacheMatches(tangents)) {
+#ifdef _OPENMP
+     boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
+#endif
+     const casacore::uInt nSamples = acc.nRow();
+     const size_t nFacets = tangents.size();
+     itsFacetUVW.resize(nSamples, tangents);
+     itsFacetValid = true;
+     // vectors referencing the columns of the result for each facet
+     std::vector<casacore::Vector<casacore::RigidVector<casacore::Double, 3> > > rotated(nFacets);
+     std::vector<casacore::Vector<casacore::Double> > delays(nFacets);
+     for (size_t facet = 0; facet < nFacets; ++facet) {
+          rotated[facet].reference(itsFacetUVW.rwUVW(facet));
+          delays[facet].reference(itsFacetUVW.rwDelays(facet));
+     }
+     const casacore::Vector<casacore::RigidVector<double, 3> >& uvwVector = acc.uvw();
+     const casacore::Vector<casacore::MVDirection>& pointingDir1Vector = acc.pointingDir1();
+     // kernels for each pointing direction, one per facet
+     std::vector<std::pair<casacore::MVDirection, std::vector<UVWRotationKernel> > > kernels;
+     size_t current = 0;
+     for (casacore::uInt row=0; row<nSamples;) {
+          const casacore::MVDirection &dir = pointingDir1Vector(row);
+          casacore::uInt end = row + 1;
+          for (; (end < nSamples) && !(pointingDir1Vector(end) != dir); ++end) {}
+          if ((current >= kernels.size()) || (kernels[current].first != dir)) {
+              for (current = 0; current < kernels.size(); ++current) {
+                   if (!(kernels[current].first != dir)) {
+                       break;
+                   }
+              }
+              if (current == kernels.size()) {
+                  kernels.push_back(std::make_pair(dir, std::vector<UVWRotationKernel>()));
+                  kernels.back().second.reserve(nFacets);
+                  for (size_t facet = 0; facet < nFacets; ++facet) {
+                       kernels.back().second.push_back(UVWRotationKernel(machine(dir, tangents[facet])));
+                  }
+              }
+          }
+          ASKAPDEBUGASSERT(current < kernels.size());
+          // the run of rows stays in cache while it is rotated for all facets
+          for (size_t facet = 0; facet < nFacets; ++facet) {
+               kernels[current].second[facet].apply(uvwVector, row, end, rotated[facet], delays[facet]);
+          }
+          row = end;
+     }
+  }
+  return itsFacetUVW;
+}
@@ -36,8 +36,13 @@
 
 #include <askap/dataaccess/UVWMachineCache.h>
 #include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/RotatedUVWStore.h>
+#include <askap/dataaccess/FacetRotatedUVW.h>
 #include <casacore/measures/Measures/MDirection.h>
 
+// std includes
+#include <vector>
+
 #ifdef _OPENMP
 // boost includes
 #include <boost/thread/shared_mutex.hpp>
@@ -68,17 +73,24 @@ struct UVWRotationHandler : protected UVWMachineCache {
    /// uvws and delays. Nothing is done for uvw machines as UVWMachineCache takes care of this.
    /// This method is const as effectively non-const operations are only for caching purposes.
    void invalidate() const;
+
+   /// @brief attach statistics to the underlying machine cache
+   using UVWMachineCache::setStatistics;
    
    /// @brief obtain rotated uvws
    /// @details
    /// Use parameters in the given accessor to compute rotated uvws
    /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
    /// @param[in] tangent direction to the tangent point
+   /// @param[in] store optional store of rotated uvws shared between iterations, the results
+   /// are taken from it if available and are put there after calculation otherwise
+   /// @param[in] key chunk of the measurement set the accessor corresponds to (used with the store)
    /// @return const reference to rotated uvws
    /// @note the method doesn't monitor a change to the accessor. It expects that invalidate 
    /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
    const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw(const IConstDataAccessor &acc, 
-               const casacore::MDirection &tangent) const;
+               const casacore::MDirection &tangent, RotatedUVWStore *store = NULL,
+               const RotatedUVWStore::ChunkKey *key = NULL) const;
 
    /// @brief obtain delays corresponding to rotation
    /// @details
@@ -87,13 +99,36 @@ struct UVWRotationHandler : protected UVWMachineCache {
    /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
    /// @param[in] tangent direction to the tangent point
    /// @param[in] imageCentre direction to the image centre
+   /// @param[in] store optional store of rotated uvws shared between iterations (see uvw)
+   /// @param[in] key chunk of the measurement set the accessor corresponds to (used with the store)
    /// @return const reference to delay vector
    /// @note the method doesn't monitor a change to the accessor. It expects that invalidate 
    /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
    const casacore::Vector<casacore::Double>& delays(const IConstDataAccessor &acc, 
-               const casacore::MDirection &tangent, const casacore::MDirection &imageCentre) const;
+               const casacore::MDirection &tangent, const casacore::MDirection &imageCentre,
+               RotatedUVWStore *store = NULL, const RotatedUVWStore::ChunkKey *key = NULL) const;
+
+   /// @brief obtain uvws rotated to a number of tangent points
+   /// @details
+   /// All facets are processed in one pass over the rows: the rotation for each pair of
+   /// the pointing direction and the tangent point is extracted from the uvw machine once
+   /// and applied to the run of rows with this pointing direction. The result is cached
+   /// independently of the single tangent point result (returned by uvw and delays), so
+   /// both can be used for the same chunk without invalidating each other.
+   /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
+   /// @param[in] tangents directions to the tangent points of all facets
+   /// @return const reference to rotated uvws and delays for each facet
+   /// @note the method doesn't monitor a change to the accessor. It expects that invalidate 
+   /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
+   const FacetRotatedUVW& facetUVW(const IConstDataAccessor &acc,
+               const std::vector<casacore::MDirection> &tangents) const;
                   
 private:
+   /// @brief check that the cached facet result corresponds to the given tangent points
+   /// @param[in] tangents directions to the tangent points of all facets
+   /// @return true if the cache can be used
+   bool facetCacheMatches(const std::vector<casacore::MDirection> &tangents) const;
+
    /// @brief rotated uvw coordinates
    mutable casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsRotatedUVWs;
    
@@ -119,6 +154,12 @@ private:
    /// is too large some round-off errors may accumulate as we just add some extra delay to the
    /// cache following every change to this field.
    mutable casacore::MDirection itsImageCentre;
+
+   /// @brief uvws and delays rotated to the tangent points of all facets
+   mutable FacetRotatedUVW itsFacetUVW;
+
+   /// @brief flag that itsFacetUVW is up to date
+   mutable bool itsFacetValid;
    
 #ifdef _OPENMP
    /// @brief mutex to synchronise cache access for all threads 
@@ -0,0 +1,98 @@
+/// @file
+/// @brief batched uvw rotation
+/// @details casacore::UVWMachine is general purpose and converts one uvw at a time
+/// via temporary MVPositions. The conversion is linear for the given pair of the phase
+/// centre and the tangent point, therefore it can be represented by a 3x3 matrix
+/// (rotated uvw) and a 3-element vector (delay). This class extracts them from 
+/// a machine once and applies them to all rows with the same phase centre.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/UVWRotationKernel.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an identity transformation (zero delay)
+UVWRotationKernel::UVWRotationKernel()
+{
+  for (int i = 0; i < 3; ++i) {
+       for (int j = 0; j < 3; ++j) {
+            itsMatrix[i][j] = (i == j) ? 1. : 0.;
+       }
+       itsDelay[i] = 0.;
+  }
+}
+
+/// @brief set up the kernel for the given machine
+/// @param[in] machine uvw machine for the required phase centre and tangent point
+UVWRotationKernel::UVWRotationKernel(const UVWMachineCache::machineType &machine)
+{
+  // the conversion is linear, so the image of each unit vector gives a column of the matrix
+  casacore::Vector<double> uvwBuffer(3);
+  for (int col = 0; col < 3; ++col) {
+       // the signs of u and v are swapped on the way in and out (see UVWRotationHandler::uvw)
+       for (int i = 0; i < 3; ++i) {
+            uvwBuffer(i) = (i == col) ? (i < 2 ? -1. : 1.) : 0.;
+       }
+       machine.convertUVW(itsDelay[col], uvwBuffer);
+       for (int i = 0; i < 3; ++i) {
+            itsMatrix[i][col] = (i < 2 ? -1. : 1.) * uvwBuffer(i);
+       }
+  }
+}
+
+/// @brief rotate uvws and compute delays for a range of rows
+/// @param[in] uvw input uvws
+/// @param[in] start first row to process
+/// @param[in] end row after the last row to process
+/// @param[out] rotated rotated uvws (should have at least end elements)
+/// @param[out] delays delays (should have at least end elements)
+void UVWRotationKernel::apply(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+              casacore::uInt start, casacore::uInt end,
+              casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &rotated,
+              casacore::Vector<casacore::Double> &delays) const
+{
+  ASKAPDEBUGASSERT(start <= end);
+  ASKAPDEBUGASSERT(end <= uvw.nelements());
+  ASKAPDEBUGASSERT(end <= rotated.nelements());
+  ASKAPDEBUGASSERT(end <= delays.nelements());
+  if (uvw.contiguousStorage() && rotated.contiguousStorage() && delays.contiguousStorage()) {
+      // plain pointer loop without any indexing overheads
+      const casacore::RigidVector<casacore::Double, 3> *in = uvw.data() + start;
+      casacore::RigidVector<casacore::Double, 3> *out = rotated.data() + start;
+      casacore::Double *delay = delays.data() + start;
+      for (casacore::uInt row = start; row < end; ++row, ++in, ++out, ++delay) {
+           rotate(*in, *out, *delay);
+      }
+  } else {
+      for (casacore::uInt row = start; row < end; ++row) {
+           rotate(uvw(row), rotated(row), delays(row));
+      }
+  }
+}
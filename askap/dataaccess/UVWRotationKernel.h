@@ -0,0 +1,103 @@
+/// @file
+/// @brief batched uvw rotation
+/// @details casacore::UVWMachine is general purpose and converts one uvw at a time
+/// via temporary MVPositions. The conversion is linear for the given pair of the phase
+/// centre and the tangent point, therefore it can be represented by a 3x3 matrix
+/// (rotated uvw) and a 3-element vector (delay). This class extracts them from 
+/// a machine once and applies them to all rows with the same phase centre.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_UVW_ROTATION_KERNEL_H
+#define ASKAP_ACCESSORS_UVW_ROTATION_KERNEL_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// own includes
+#include <askap/dataaccess/UVWMachineCache.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief batched uvw rotation
+/// @details The kernel reproduces the convention used by UVWRotationHandler: the signs of u
+/// and v are swapped before they are passed to the machine and swapped back afterwards. 
+/// The matrix and the delay vector are set up by converting three unit vectors with
+/// the machine, so no assumption is made about the internals of the machine.
+/// @ingroup dataaccess
+class UVWRotationKernel {
+public:
+   /// @brief construct an identity transformation (zero delay)
+   UVWRotationKernel();
+
+   /// @brief set up the kernel for the given machine
+   /// @param[in] machine uvw machine for the required phase centre and tangent point
+   explicit UVWRotationKernel(const UVWMachineCache::machineType &machine);
+
+   /// @brief rotate uvws and compute delays for a range of rows
+   /// @param[in] uvw input uvws
+   /// @param[in] start first row to process
+   /// @param[in] end row after the last row to process
+   /// @param[out] rotated rotated uvws (should have at least end elements)
+   /// @param[out] delays delays (should have at least end elements)
+   void apply(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+              casacore::uInt start, casacore::uInt end,
+              casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &rotated,
+              casacore::Vector<casacore::Double> &delays) const;
+
+   /// @brief rotate one uvw
+   /// @param[in] in input uvw
+   /// @param[out] out rotated uvw
+   /// @param[out] delay delay
+   inline void rotate(const casacore::RigidVector<casacore::Double, 3> &in,
+                      casacore::RigidVector<casacore::Double, 3> &out, casacore::Double &delay) const
+   {
+      const double u = in(0);
+      const double v = in(1);
+      const double w = in(2);
+      out(0) = itsMatrix[0][0] * u + itsMatrix[0][1] * v + itsMatrix[0][2] * w;
+      out(1) = itsMatrix[1][0] * u + itsMatrix[1][1] * v + itsMatrix[1][2] * w;
+      out(2) = itsMatrix[2][0] * u + itsMatrix[2][1] * v + itsMatrix[2][2] * w;
+      delay = itsDelay[0] * u + itsDelay[1] * v + itsDelay[2] * w;
+   }
+
+private:
+   /// @brief rotation matrix, the first index is the output coordinate
+   double itsMatrix[3][3];
+
+   /// @brief delay per unit of u, v and w
+   double itsDelay[3];
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_UVW_ROTATION_KERNEL_H
@@ -0,0 +1,172 @@
+/// @file
+/// @brief ordering of the chunk rows by w-plane
+/// @details W-stacking gridders process visibilities one w-plane at a time, so the
+/// rows of each chunk have to be binned by w before gridding and the results scattered
+/// back afterwards. This class finds the w-plane of each row (using either the original
+/// uvw or the uvw rotated to a tangent point), orders the rows by plane with a counting
+/// sort and, if requested, makes copies of visibilities, flags and uvw in that order.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/dataaccess/WPlaneBinner.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up uniform w-planes
+/// @param[in] nPlanes number of planes
+/// @param[in] wMax the largest absolute value of w covered by the planes
+WPlaneBinner::WPlaneBinner(casacore::uInt nPlanes, double wMax) : itsWMin(-wMax), 
+       itsInvWidth(0.), itsPlaneStart(nPlanes + 1, 0), itsNOutside(0)
+{
+  ASKAPCHECK(nPlanes > 0, "At least one w-plane is required");
+  ASKAPCHECK(wMax > 0, "The largest w-term should be positive, you have "<<wMax);
+  itsInvWidth = double(nPlanes) / (2. * wMax);
+}
+
+/// @brief set up w-planes with the given boundaries
+/// @param[in] boundaries nPlanes + 1 boundaries of the planes in ascending order,
+/// plane i covers w from boundaries[i] (inclusive) to boundaries[i + 1]
+WPlaneBinner::WPlaneBinner(const std::vector<double> &boundaries) : itsBoundaries(boundaries),
+       itsWMin(0.), itsInvWidth(0.), itsPlaneStart(std::max(boundaries.size(), size_t(2)), 0), 
+       itsNOutside(0)
+{
+  ASKAPCHECK(boundaries.size() > 1, "At least two w-plane boundaries are required, you have "<<
+             boundaries.size());
+  for (size_t index = 1; index < boundaries.size(); ++index) {
+       ASKAPCHECK(boundaries[index - 1] < boundaries[index], "The w-plane boundaries should be in ascending order");
+  }
+}
+
+/// @brief w-plane for the given w-term
+/// @param[in] w w-term (values outside the boundaries are put into the edge planes)
+/// @return plane index
+casacore::uInt WPlaneBinner::plane(double w) const
+{
+  const casacore::uInt lastPlane = nPlanes() - 1;
+  if (itsBoundaries.size() > 0) {
+      // the first boundary above w
+      const std::vector<double>::const_iterator ci = std::upper_bound(itsBoundaries.begin(),
+                 itsBoundaries.end(), w);
+      if (ci == itsBoundaries.begin()) {
+          return 0;
+      }
+      return std::min(casacore::uInt(ci - itsBoundaries.begin()) - 1, lastPlane);
+  }
+  const double pos = std::floor((w - itsWMin) * itsInvWidth);
+  if (pos <= 0.) {
+      return 0;
+  }
+  return pos >= double(lastPlane) ? lastPlane : casacore::uInt(pos);
+}
+
+/// @brief bin the rows using the original uvw
+/// @param[in] acc accessor with the chunk
+/// @param[in] copyData if true, visibilities, flags and uvw are copied in the binned order
+void WPlaneBinner::bin(const IConstDataAccessor &acc, bool copyData)
+{
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.uvw();
+  bin(uvw);
+  if (copyData) {
+      takeData(acc, uvw);
+  }
+}
+
+/// @brief bin the rows using the uvw rotated to a tangent point
+/// @param[in] acc accessor with the chunk
+/// @param[in] tangentPoint tangent point to rotate the uvw to
+/// @param[in] copyData if true, visibilities, flags and uvw are copied in the binned order
+void WPlaneBinner::bin(const IConstDataAccessor &acc, const casacore::MDirection &tangentPoint,
+                       bool copyData)
+{
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.rotatedUVW(tangentPoint);
+  bin(uvw);
+  if (copyData) {
+      takeData(acc, uvw);
+  }
+}
+
+/// @brief bin the rows with the given uvw
+/// @details Copies of the data made by previous calls are released.
+/// @param[in] uvw uvw of each row
+void WPlaneBinner::bin(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw)
+{
+  const casacore::uInt nRows = uvw.nelements();
+  itsVisibility.resize(0, 0, 0);
+  itsFlag.resize(0, 0, 0);
+  itsUVW.resize(0);
+  // the first pass finds the plane of each row and counts the rows in each plane,
+  // itsPlaneStart[plane + 1] accumulates the number of rows in the given plane
+  std::fill(itsPlaneStart.begin(), itsPlaneStart.end(), 0u);
+  itsRowPlane.resize(nRows);
+  itsNOutside = 0;
+  const double wLow = itsBoundaries.size() > 0 ? itsBoundaries.front() : itsWMin;
+  const double wHigh = itsBoundaries.size() > 0 ? itsBoundaries.back() : -itsWMin;
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       const double w = uvw[row](2);
+       if ((w < wLow) || (w > wHigh)) {
+           ++itsNOutside;
+       }
+       const casacore::uInt rowPlane = plane(w);
+       itsRowPlane[row] = rowPlane;
+       ++itsPlaneStart[rowPlane + 1];
+  }
+  for (size_t index = 1; index < itsPlaneStart.size(); ++index) {
+       itsPlaneStart[index] += itsPlaneStart[index - 1];
+  }
+  // the second pass places the rows, the order within each plane is kept
+  itsPermutation.resize(nRows);
+  std::vector<casacore::uInt> next(itsPlaneStart.begin(), itsPlaneStart.end() - 1);
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       itsPermutation[next[itsRowPlane[row]]++] = row;
+  }
+  ASKAPDEBUGASSERT(itsPlaneStart.back() == nRows);
+}
+
+/// @brief copy visibilities, flags and uvw in the binned order
+/// @param[in] acc accessor with the chunk
+/// @param[in] uvw uvw used for binning
+void WPlaneBinner::takeData(const IConstDataAccessor &acc,
+                            const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw)
+{
+  gather(acc.visibility(), itsVisibility);
+  gather(acc.flag(), itsFlag);
+  itsUVW.resize(uvw.nelements());
+  for (casacore::uInt row = 0; row < nRow(); ++row) {
+       itsUVW[row] = uvw[itsPermutation[row]];
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
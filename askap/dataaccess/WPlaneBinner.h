@@ -0,0 +1,194 @@
+/// @file
+/// @brief ordering of the chunk rows by w-plane
+/// @details W-stacking gridders process visibilities one w-plane at a time, so the
+/// rows of each chunk have to be binned by w before gridding and the results scattered
+/// back afterwards. This class finds the w-plane of each row (using either the original
+/// uvw or the uvw rotated to a tangent point), orders the rows by plane with a counting
+/// sort and, if requested, makes copies of visibilities, flags and uvw in that order.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_W_PLANE_BINNER_H
+#define ASKAP_ACCESSORS_W_PLANE_BINNER_H
+
+// std includes
+#include <vector>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief ordering of the chunk rows by w-plane
+/// @details The w-planes are either uniform between -wMax and wMax or given by an
+/// explicit list of boundaries. The w-term is in the same units as uvw (i.e. metres), a
+/// gridder working in wavelengths should scale the boundaries by the highest frequency.
+/// Rows outside the boundaries are put into the first or the last plane and counted.
+/// Binning is done in two passes over the rows: the first finds the plane of each row
+/// and counts the rows in each plane, the second places the rows at their positions,
+/// so the cost is linear in the number of rows and the original order is kept within each
+/// plane. The binned order is given by the permutation, where element i is the row of the
+/// accessor which is placed at position i. If the rotated uvw are used and the accessor is
+/// BestWPlaneDataAccessor, the w-term is the distance from the fitted plane. The binner
+/// holds its own buffers, so each thread can bin its chunks with its own binner.
+/// @ingroup dataaccess_hlp
+class WPlaneBinner final
+{
+public:
+  /// @brief set up uniform w-planes
+  /// @param[in] nPlanes number of planes
+  /// @param[in] wMax the largest absolute value of w covered by the planes
+  WPlaneBinner(casacore::uInt nPlanes, double wMax);
+
+  /// @brief set up w-planes with the given boundaries
+  /// @param[in] boundaries nPlanes + 1 boundaries of the planes in ascending order,
+  /// plane i covers w from boundaries[i] (inclusive) to boundaries[i + 1]
+  explicit WPlaneBinner(const std::vector<double> &boundaries);
+
+  /// @brief bin the rows using the original uvw
+  /// @param[in] acc accessor with the chunk
+  /// @param[in] copyData if true, visibilities, flags and uvw are copied in the binned order
+  void bin(const IConstDataAccessor &acc, bool copyData = false);
+
+  /// @brief bin the rows using the uvw rotated to a tangent point
+  /// @param[in] acc accessor with the chunk
+  /// @param[in] tangentPoint tangent point to rotate the uvw to
+  /// @param[in] copyData if true, visibilities, flags and uvw are copied in the binned order
+  void bin(const IConstDataAccessor &acc, const casacore::MDirection &tangentPoint,
+           bool copyData = false);
+
+  /// @brief bin the rows with the given uvw
+  /// @details Copies of the data made by previous calls are released.
+  /// @param[in] uvw uvw of each row
+  void bin(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw);
+
+  /// @brief number of w-planes
+  inline casacore::uInt nPlanes() const { return casacore::uInt(itsPlaneStart.size() - 1); }
+
+  /// @brief w-plane for the given w-term
+  /// @param[in] w w-term (values outside the boundaries are put into the edge planes)
+  /// @return plane index
+  casacore::uInt plane(double w) const;
+
+  /// @brief number of binned rows
+  inline casacore::uInt nRow() const { return casacore::uInt(itsPermutation.size()); }
+
+  /// @brief rows of the accessor in the binned order
+  /// @return vector where element i is the accessor row placed at position i
+  inline const std::vector<casacore::uInt>& permutation() const { return itsPermutation; }
+
+  /// @brief first position of the given plane in the binned order
+  /// @param[in] plane plane index
+  inline casacore::uInt planeStart(casacore::uInt plane) const { return itsPlaneStart[plane]; }
+
+  /// @brief number of rows in the given plane
+  /// @param[in] plane plane index
+  inline casacore::uInt planeSize(casacore::uInt plane) const
+         { return itsPlaneStart[plane + 1] - itsPlaneStart[plane]; }
+
+  /// @brief number of rows outside the boundaries
+  /// @return number of rows put into the edge planes although their w is outside
+  inline casacore::uInt nOutside() const { return itsNOutside; }
+
+  /// @brief visibilities in the binned order
+  /// @details Only available if the data have been copied by bin
+  inline const casacore::Cube<casacore::Complex>& visibility() const { return itsVisibility; }
+
+  /// @brief flags in the binned order
+  /// @details Only available if the data have been copied by bin
+  inline const casacore::Cube<casacore::Bool>& flag() const { return itsFlag; }
+
+  /// @brief uvw in the binned order
+  /// @details Only available if the data have been copied by bin
+  inline const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw() const { return itsUVW; }
+
+  /// @brief copy a cube into the binned order
+  /// @param[in] in nRow x nChannel x nPol cube in the order of the accessor
+  /// @param[out] out cube in the binned order (resized if necessary)
+  template<typename T>
+  void gather(const casacore::Cube<T> &in, casacore::Cube<T> &out) const;
+
+  /// @brief copy a cube back into the order of the accessor
+  /// @details This is the inverse of gather, e.g. to return degridded visibilities.
+  /// @param[in] in nRow x nChannel x nPol cube in the binned order
+  /// @param[out] out cube in the order of the accessor (resized if necessary)
+  template<typename T>
+  void scatter(const casacore::Cube<T> &in, casacore::Cube<T> &out) const;
+
+private:
+  /// @brief copy visibilities, flags and uvw in the binned order
+  /// @param[in] acc accessor with the chunk
+  /// @param[in] uvw uvw used for binning
+  void takeData(const IConstDataAccessor &acc,
+                const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw);
+
+  /// @brief boundaries of the planes (empty for uniform planes)
+  std::vector<double> itsBoundaries;
+
+  /// @brief lower boundary of the first plane for uniform planes
+  double itsWMin;
+
+  /// @brief reciprocal of the plane width for uniform planes
+  double itsInvWidth;
+
+  /// @brief first position of each plane in the binned order, one extra element at the end
+  std::vector<casacore::uInt> itsPlaneStart;
+
+  /// @brief accessor rows in the binned order
+  std::vector<casacore::uInt> itsPermutation;
+
+  /// @brief plane of each accessor row (buffer reused between chunks)
+  std::vector<casacore::uInt> itsRowPlane;
+
+  /// @brief number of rows outside the boundaries
+  casacore::uInt itsNOutside;
+
+  /// @brief visibilities in the binned order
+  casacore::Cube<casacore::Complex> itsVisibility;
+
+  /// @brief flags in the binned order
+  casacore::Cube<casacore::Bool> itsFlag;
+
+  /// @brief uvw in the binned order
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#include <askap/dataaccess/WPlaneBinner.tcc>
+
+#endif // #ifndef ASKAP_ACCESSORS_W_PLANE_BINNER_H
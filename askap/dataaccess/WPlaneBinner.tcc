@@ -0,0 +1,107 @@
+/// @file
+/// @brief ordering of the chunk rows by w-plane
+/// @details W-stacking gridders process visibilities one w-plane at a time, so the
+/// rows of each chunk have to be binned by w before gridding and the results scattered
+/// back afterwards. This class finds the w-plane of each row (using either the original
+/// uvw or the uvw rotated to a tangent point), orders the rows by plane with a counting
+/// sort and, if requested, makes copies of visibilities, flags and uvw in that order.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_W_PLANE_BINNER_TCC
+#define ASKAP_ACCESSORS_W_PLANE_BINNER_TCC
+
+// own includes
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief copy a cube into the binned order
+/// @details Rows are the fastest changing index of the cube, so each channel and
+/// polarisation is a contiguous block and the writes are sequential.
+/// @param[in] in nRow x nChannel x nPol cube in the order of the accessor
+/// @param[out] out cube in the binned order (resized if necessary)
+template<typename T>
+void WPlaneBinner::gather(const casacore::Cube<T> &in, casacore::Cube<T> &out) const
+{
+  const size_t nRow = itsPermutation.size();
+  ASKAPCHECK(in.nrow() == nRow, "The cube has "<<in.nrow()<<" rows, "<<nRow<<" rows have been binned");
+  ASKAPCHECK(&in != &out, "The cube can't be reordered in place");
+  if (out.shape() != in.shape()) {
+      out.resize(in.shape());
+  }
+  bool deleteIn = false;
+  const T* src = in.getStorage(deleteIn);
+  bool deleteOut = false;
+  T* dst = out.getStorage(deleteOut);
+  const size_t nChanPol = nRow > 0 ? in.nelements() / nRow : 0;
+  for (size_t chanPol = 0; chanPol < nChanPol; ++chanPol) {
+       const T* srcRows = src + chanPol * nRow;
+       T* dstRows = dst + chanPol * nRow;
+       for (size_t row = 0; row < nRow; ++row) {
+            dstRows[row] = srcRows[itsPermutation[row]];
+       }
+  }
+  in.freeStorage(src, deleteIn);
+  out.putStorage(dst, deleteOut);
+}
+
+/// @brief copy a cube back into the order of the accessor
+/// @details This is the inverse of gather, e.g. to return degridded visibilities.
+/// @param[in] in nRow x nChannel x nPol cube in the binned order
+/// @param[out] out cube in the order of the accessor (resized if necessary)
+template<typename T>
+void WPlaneBinner::scatter(const casacore::Cube<T> &in, casacore::Cube<T> &out) const
+{
+  const size_t nRow = itsPermutation.size();
+  ASKAPCHECK(in.nrow() == nRow, "The cube has "<<in.nrow()<<" rows, "<<nRow<<" rows have been binned");
+  ASKAPCHECK(&in != &out, "The cube can't be reordered in place");
+  if (out.shape() != in.shape()) {
+      out.resize(in.shape());
+  }
+  bool deleteIn = false;
+  const T* src = in.getStorage(deleteIn);
+  bool deleteOut = false;
+  T* dst = out.getStorage(deleteOut);
+  const size_t nChanPol = nRow > 0 ? in.nelements() / nRow : 0;
+  for (size_t chanPol = 0; chanPol < nChanPol; ++chanPol) {
+       const T* srcRows = src + chanPol * nRow;
+       T* dstRows = dst + chanPol * nRow;
+       for (size_t row = 0; row < nRow; ++row) {
+            dstRows[itsPermutation[row]] = srcRows[row];
+       }
+  }
+  in.freeStorage(src, deleteIn);
+  out.putStorage(dst, deleteOut);
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_W_PLANE_BINNER_TCC
@@ -0,0 +1,150 @@
+/// @file
+/// @brief kernels deriving the weight cube from flags and noise
+///
+/// @details Weights are needed for every element in each pass of gridders and 
+/// solvers. These kernels compute them in a single pass over contiguous storage
+/// (plain loops without branches, suitable for vectorisation), either from the 
+/// noise cube or in-place from noise figures or weights read into the weight buffer.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/dataaccess/WeightCalculator.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief compute weights from the noise cube
+/// @param[in] flag flags
+/// @param[in] noise noise figures of the same shape
+/// @param[out] weight weight cube to fill
+void WeightCalculator::fromNoise(const casacore::Cube<casacore::Bool> &flag, 
+                        const casacore::Cube<casacore::Complex> &noise,
+                        casacore::Cube<casacore::Float> &weight)
+{
+  ASKAPCHECK(flag.shape() == noise.shape(), "Flag and noise cubes have different shapes - unable to compute weights");
+  ASKAPDEBUGASSERT(weight.shape() == flag.shape());
+  ASKAPDEBUGASSERT(weight.contiguousStorage());
+  // plain pointer loops below assume a contiguous storage, copy the input otherwise
+  const casacore::Cube<casacore::Bool> contFlag = flag.contiguousStorage() ? 
+          flag : casacore::Cube<casacore::Bool>(flag.copy());
+  const casacore::Cube<casacore::Complex> contNoise = noise.contiguousStorage() ? 
+          noise : casacore::Cube<casacore::Complex>(noise.copy());
+  const casacore::Bool *flagPtr = contFlag.data();
+  const casacore::Complex *noisePtr = contNoise.data();
+  casacore::Float *weightPtr = weight.data();
+  const size_t nElements = weight.nelements();
+  for (size_t index = 0; index < nElements; ++index) {
+       const casacore::Float sigma = casacore::real(noisePtr[index]);
+       const bool valid = !flagPtr[index] && (sigma > 0.f);
+       weightPtr[index] = valid ? 1.f / (sigma * sigma) : 0.f;
+  }
+}
+
+/// @brief compute weights from noise given per row and polarisation
+/// @param[in] flag flags
+/// @param[in] rowPolNoise nRow x nPol matrix with noise valid for all channels
+/// @param[out] weight weight cube to fill
+void WeightCalculator::fromRowPolNoise(const casacore::Cube<casacore::Bool> &flag, 
+                              const casacore::Matrix<casacore::Complex> &rowPolNoise,
+                              casacore::Cube<casacore::Float> &weight)
+{
+  ASKAPCHECK((rowPolNoise.nrow() == flag.nrow()) && (rowPolNoise.ncolumn() == flag.nplane()), 
+             "Noise matrix doesn't match the shape of the flag cube - unable to compute weights");
+  ASKAPDEBUGASSERT(weight.shape() == flag.shape());
+  ASKAPDEBUGASSERT(weight.contiguousStorage());
+  const casacore::Cube<casacore::Bool> contFlag = flag.contiguousStorage() ? 
+          flag : casacore::Cube<casacore::Bool>(flag.copy());
+  const casacore::uInt nRow = weight.nrow();
+  const casacore::uInt nChan = weight.ncolumn();
+  const casacore::uInt nPol = weight.nplane();
+  // weights for one channel, the same for all channels of the given polarisation
+  casacore::Vector<casacore::Float> rowWeight(nRow);
+  casacore::Float *rowWeightPtr = rowWeight.data();
+  for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+       for (casacore::uInt row = 0; row < nRow; ++row) {
+            const casacore::Float sigma = casacore::real(rowPolNoise(row, pol));
+            rowWeightPtr[row] = sigma > 0.f ? 1.f / (sigma * sigma) : 0.f;
+       }
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            const size_t offset = size_t(nRow) * (chan + size_t(nChan) * pol);
+            const casacore::Bool *flagPtr = contFlag.data() + offset;
+            casacore::Float *weightPtr = weight.data() + offset;
+            for (casacore::uInt row = 0; row < nRow; ++row) {
+                 weightPtr[row] = flagPtr[row] ? 0.f : rowWeightPtr[row];
+            }
+       }
+  }
+}
+
+/// @brief convert noise figures into weights in place
+/// @param[in] flag flags
+/// @param[in,out] weight cube with noise figures (sigma) on input and weights on output
+void WeightCalculator::fromSigma(const casacore::Cube<casacore::Bool> &flag, 
+                        casacore::Cube<casacore::Float> &weight)
+{
+  ASKAPCHECK(flag.shape() == weight.shape(), "Flag and noise cubes have different shapes - unable to compute weights");
+  ASKAPDEBUGASSERT(weight.contiguousStorage());
+  const casacore::Cube<casacore::Bool> contFlag = flag.contiguousStorage() ? 
+          flag : casacore::Cube<casacore::Bool>(flag.copy());
+  const casacore::Bool *flagPtr = contFlag.data();
+  casacore::Float *weightPtr = weight.data();
+  const size_t nElements = weight.nelements();
+  for (size_t index = 0; index < nElements; ++index) {
+       const casacore::Float sigma = weightPtr[index];
+       const bool valid = !flagPtr[index] && (sigma > 0.f);
+       weightPtr[index] = valid ? 1.f / (sigma * sigma) : 0.f;
+  }
+}
+
+/// @brief apply flags to weights in place
+/// @details This is used for weights given explicitly (i.e. read from WEIGHT_SPECTRUM).
+/// Negative weights are set to zero as well.
+/// @param[in] flag flags
+/// @param[in,out] weight weights to update
+void WeightCalculator::applyFlags(const casacore::Cube<casacore::Bool> &flag, 
+                         casacore::Cube<casacore::Float> &weight)
+{
+  ASKAPCHECK(flag.shape() == weight.shape(), "Flag and weight cubes have different shapes - unable to apply flags");
+  ASKAPDEBUGASSERT(weight.contiguousStorage());
+  const casacore::Cube<casacore::Bool> contFlag = flag.contiguousStorage() ? 
+          flag : casacore::Cube<casacore::Bool>(flag.copy());
+  const casacore::Bool *flagPtr = contFlag.data();
+  casacore::Float *weightPtr = weight.data();
+  const size_t nElements = weight.nelements();
+  for (size_t index = 0; index < nElements; ++index) {
+       const casacore::Float value = weightPtr[index];
+       weightPtr[index] = !flagPtr[index] && (value > 0.f) ? value : 0.f;
+  }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,90 @@
+/// @file
+/// @brief kernels deriving the weight cube from flags and noise
+///
+/// @details Weights are needed for every element in each pass of gridders and 
+/// solvers. These kernels compute them in a single pass over contiguous storage
+/// (plain loops without branches, suitable for vectorisation), either from the 
+/// noise cube or in-place from noise figures or weights read into the weight buffer.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_WEIGHT_CALCULATOR_H
+#define ASKAP_ACCESSORS_WEIGHT_CALCULATOR_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief kernels deriving the weight cube from flags and noise
+/// @details All cubes are in the accessor order (nRow x nChannel x nPol). The weight
+/// of an element is zero if it is flagged or has no positive noise figure, otherwise 
+/// it is 1/sigma^2, where sigma is the noise of the real part (see IWeightDataAccessor).
+/// The weight cube should already have the right shape.
+/// @ingroup dataaccess_hlp
+struct WeightCalculator {
+
+  /// @brief compute weights from the noise cube
+  /// @param[in] flag flags
+  /// @param[in] noise noise figures of the same shape
+  /// @param[out] weight weight cube to fill
+  static void fromNoise(const casacore::Cube<casacore::Bool> &flag, 
+                        const casacore::Cube<casacore::Complex> &noise,
+                        casacore::Cube<casacore::Float> &weight);
+
+  /// @brief compute weights from noise given per row and polarisation
+  /// @param[in] flag flags
+  /// @param[in] rowPolNoise nRow x nPol matrix with noise valid for all channels
+  /// @param[out] weight weight cube to fill
+  static void fromRowPolNoise(const casacore::Cube<casacore::Bool> &flag, 
+                              const casacore::Matrix<casacore::Complex> &rowPolNoise,
+                              casacore::Cube<casacore::Float> &weight);
+
+  /// @brief convert noise figures into weights in place
+  /// @param[in] flag flags
+  /// @param[in,out] weight cube with noise figures (sigma) on input and weights on output
+  static void fromSigma(const casacore::Cube<casacore::Bool> &flag, 
+                        casacore::Cube<casacore::Float> &weight);
+
+  /// @brief apply flags to weights in place
+  /// @details This is used for weights given explicitly (i.e. read from WEIGHT_SPECTRUM).
+  /// Negative weights are set to zero as well.
+  /// @param[in] flag flags
+  /// @param[in,out] weight weights to update
+  static void applyFlags(const casacore::Cube<casacore::Bool> &flag, 
+                         casacore::Cube<casacore::Float> &weight);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_WEIGHT_CALCULATOR_H
@@ -0,0 +1,569 @@
+/// @file AsyncImageAccess.cc
+/// @brief image accessor doing writes in a background thread
+/// @details This class wraps any IImageAccess implementation and queues all write
+/// operations as bulk jobs of the I/O scheduler of the process, so the caller (e.g. the
+/// imager writing a number of images after each major cycle) can carry on while the images
+/// are written.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/imageaccess/AsyncImageAccess.h>
+
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+#include <boost/bind.hpp>
+
+ASKAP_LOGGER(logger, ".asyncImageAccessor");
+
+namespace askap {
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] acc accessor to do the actual reads and writes
+/// @param[in] maxQueued maximum number of queued operations
+AsyncImageAccess::AsyncImageAccess(const boost::shared_ptr<IImageAccess> &acc, const size_t maxQueued) :
+    itsAccessor(acc), itsMaxQueued(maxQueued), itsNPending(0)
+{
+    ASKAPCHECK(itsAccessor, "AsyncImageAccess requires an accessor to wrap");
+    ASKAPCHECK(itsMaxQueued > 0, "AsyncImageAccess requires space for at least one queued operation");
+    boost::promise<void> ready;
+    ready.set_value();
+    itsLastRequest = Future(ready.get_future());
+    // operations are done one at a time in order, after the latency-critical reads
+    itsChannel = IOScheduler::instance().channel(IOScheduler::BULK);
+}
+
+/// @brief destructor, waits for all queued operations
+AsyncImageAccess::~AsyncImageAccess()
+{
+    try {
+        submitAllMetadata();
+    }
+    catch (const std::exception &ex) {
+        ASKAPLOG_ERROR_STR(logger, "Unable to queue metadata updates: " << ex.what());
+    }
+    boost::mutex::scoped_lock lock(itsMutex);
+    while (itsNPending > 0) {
+        itsCondition.wait(lock);
+    }
+    if (itsError.size()) {
+        ASKAPLOG_ERROR_STR(logger, "Asynchronous image write failed: " << itsError);
+    }
+}
+
+/// @brief wait for all queued operations to finish
+/// @details Pending metadata updates are queued first. An error encountered by the
+/// background thread is reported here.
+void AsyncImageAccess::wait()
+{
+    submitAllMetadata();
+    boost::mutex::scoped_lock lock(itsMutex);
+    while (itsNPending > 0) {
+        itsCondition.wait(lock);
+    }
+    checkError();
+}
+
+/// @brief future of the last queued operation
+/// @return future of the last operation (ready if nothing has been queued)
+AsyncImageAccess::Future AsyncImageAccess::lastRequest() const
+{
+    return itsLastRequest;
+}
+
+/// @brief number of operations queued, but not yet done
+/// @return number of operations
+size_t AsyncImageAccess::nQueued() const
+{
+    boost::mutex::scoped_lock lock(itsMutex);
+    return itsNPending;
+}
+
+/// @brief wait for all operations, as needed before reads
+void AsyncImageAccess::sync() const
+{
+    const_cast<AsyncImageAccess*>(this)->wait();
+}
+
+/// @brief report the error of the background thread, if any
+/// @details This method should be called with the mutex locked.
+void AsyncImageAccess::checkError()
+{
+    if (itsError.size()) {
+        const std::string msg = itsError;
+        itsError.clear();
+        ASKAPTHROW(AskapError, "Asynchronous image write failed: " << msg);
+    }
+}
+
+/// @brief queue an operation
+/// @details Pending metadata of the given image are queued first. This method blocks
+/// while the queue is full.
+/// @param[in] name image name (empty string if the operation is not specific to an image)
+/// @param[in] job operation to do
+/// @param[in] bytes approximate amount of data written by the operation (for the bandwidth cap)
+void AsyncImageAccess::submit(const std::string &name, const Job &job, const size_t bytes)
+{
+    if (name.size()) {
+        submitMetadata(name);
+    } else {
+        submitAllMetadata();
+    }
+    enqueue(job, bytes);
+}
+
+/// @brief queue an operation without flushing pending metadata
+/// @details If the scheduler refuses the operation, its slot in the queue is released
+/// and the exception is passed to both the caller and the promise of the operation.
+/// @param[in] job operation to do
+/// @param[in] bytes approximate amount of data written by the operation (for the bandwidth cap)
+void AsyncImageAccess::enqueue(const Job &job, const size_t bytes)
+{
+    ASKAPDEBUGASSERT(job);
+    const boost::shared_ptr<boost::promise<void> > promise(new boost::promise<void>);
+    {
+        boost::mutex::scoped_lock lock(itsMutex);
+        while (itsNPending >= itsMaxQueued) {
+            itsCondition.wait(lock);
+        }
+        ++itsNPending;
+    }
+    itsLastRequest = Future(promise->get_future());
+    try {
+       // errors are passed to our own promise, the future of the scheduler is not needed
+       IOScheduler::instance().submit(itsChannel, boost::bind(&AsyncImageAccess::execute, this, job, promise), bytes);
+    }
+    catch (const std::exception &ex) {
+       // the job will never run, release its slot or the destructor would wait forever
+       promise->set_exception(boost::copy_exception(AskapError(
+                 std::string("Unable to queue an asynchronous image write: ") + ex.what())));
+       boost::mutex::scoped_lock lock(itsMutex);
+       --itsNPending;
+       itsCondition.notify_all();
+       throw;
+    }
+}
+
+/// @brief queue pending metadata of the given image
+/// @param[in] name image name
+void AsyncImageAccess::submitMetadata(const std::string &name)
+{
+    const std::map<std::string, boost::shared_ptr<PendingMetadata> >::iterator it = itsMetadata.find(name);
+    if (it != itsMetadata.end()) {
+        const boost::shared_ptr<PendingMetadata> metadata = it->second;
+        itsMetadata.erase(it);
+        enqueue(boost::bind(&AsyncImageAccess::writeMetadata, this, name, metadata));
+    }
+}
+
+/// @brief queue pending metadata of all images
+void AsyncImageAccess::submitAllMetadata()
+{
+    while (itsMetadata.size() > 0) {
+        submitMetadata(itsMetadata.begin()->first);
+    }
+}
+
+/// @brief pass accumulated metadata to the wrapped accessor
+/// @details This method is executed in the background thread.
+/// @param[in] name image name
+/// @param[in] metadata metadata to write
+void AsyncImageAccess::writeMetadata(const std::string &name, const boost::shared_ptr<PendingMetadata> &metadata)
+{
+    ASKAPDEBUGASSERT(metadata);
+    if (metadata->hasUnits) {
+        itsAccessor->setUnits(name, metadata->units);
+    }
+    if (metadata->hasBeam) {
+        itsAccessor->setBeamInfo(name, metadata->beam[0], metadata->beam[1], metadata->beam[2]);
+    }
+    if (metadata->hasBeamList) {
+        itsAccessor->setBeamList(name, metadata->beams);
+    }
+    for (size_t i = 0; i < metadata->keywords.size(); ++i) {
+         itsAccessor->setMetadataKeyword(name, metadata->keywords[i].first, metadata->keywords[i].second.first,
+                                         metadata->keywords[i].second.second);
+    }
+    for (size_t i = 0; i < metadata->history.size(); ++i) {
+         itsAccessor->addHistory(name, metadata->history[i]);
+    }
+}
+
+/// @brief do one operation and fulfil its promise
+/// @details This method is executed by the I/O scheduler. Exceptions can't propagate across
+/// threads, therefore the error is passed to the promise and the error message is stored to be
+/// reported by the next wait.
+/// @param[in] job operation to do
+/// @param[in] promise promise to fulfil
+void AsyncImageAccess::execute(const Job &job, const boost::shared_ptr<boost::promise<void> > &promise)
+{
+    std::string error;
+    try {
+       job();
+    }
+    catch (const std::exception &ex) {
+       error = ex.what();
+       if (error.empty()) {
+           error = "unknown error";
+       }
+    }
+    if (error.empty()) {
+        promise->set_value();
+    } else {
+        ASKAPLOG_WARN_STR(logger, "Asynchronous image write failed: " << error);
+        promise->set_exception(boost::copy_exception(AskapError(error)));
+    }
+    boost::mutex::scoped_lock lock(itsMutex);
+    // the first error is reported
+    if (!error.empty() && itsError.empty()) {
+        itsError = error;
+    }
+    --itsNPending;
+    // notified with the mutex held, as the waiting destructor may destroy the condition straight away
+    itsCondition.notify_all();
+}
+
+// reading methods
+
+/// @brief obtain the shape
+/// @param[in] name image name
+/// @return full shape of the given image
+casacore::IPosition AsyncImageAccess::shape(const std::string &name) const
+{
+    sync();
+    return itsAccessor->shape(name);
+}
+
+/// @brief read full image
+/// @param[in] name image name
+/// @return array with pixels
+casacore::Array<float> AsyncImageAccess::read(const std::string &name) const
+{
+    sync();
+    return itsAccessor->read(name);
+}
+
+/// @brief read part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return array with pixels for the selection only
+casacore::Array<float> AsyncImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    sync();
+    return itsAccessor->read(name, blc, trc);
+}
+
+/// @brief read part of the image into the given buffer
+/// @details Queued operations are done first, the wrapped accessor then fills the buffer.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill
+void AsyncImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                            const casacore::IPosition &trc, casacore::Array<float> &buffer) const
+{
+    sync();
+    itsAccessor->read(name, blc, trc, buffer);
+}
+
+/// @brief read part of the image into preallocated memory
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] data pointer to the memory for (trc-blc+1).product() pixels in the Fortran order
+void AsyncImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                            const casacore::IPosition &trc, float *data) const
+{
+    sync();
+    itsAccessor->read(name, blc, trc, data);
+}
+
+/// @brief read a number of cutouts
+/// @param[in] name image name
+/// @param[in] blc bottom left corners of the cutouts
+/// @param[in] trc top right corners of the cutouts, same size as blc
+/// @param[out] cutouts arrays with pixels, one per cutout
+void AsyncImageAccess::readCutouts(const std::string &name, const std::vector<casacore::IPosition> &blc,
+                                   const std::vector<casacore::IPosition> &trc,
+                                   std::vector<casacore::Array<float> > &cutouts) const
+{
+    sync();
+    itsAccessor->readCutouts(name, blc, trc, cutouts);
+}
+
+/// @brief extract spectra at a number of positions
+/// @details Queued operations are done first, the wrapped accessor then groups the
+/// reads by its own storage chunks.
+/// @param[in] name image name
+/// @param[in] positions pixel positions (the element for the spectral axis is ignored)
+/// @param[in] firstChannel first channel to extract
+/// @param[in] nChan number of channels to extract
+/// @param[out] spectra extracted spectra, resized to positions.size() x nChan
+/// @param[in] nThreads number of threads to use
+void AsyncImageAccess::readSpectra(const std::string &name, const std::vector<casacore::IPosition> &positions,
+                                   casacore::uInt firstChannel, casacore::uInt nChan,
+                                   casacore::Matrix<float> &spectra, casacore::uInt nThreads) const
+{
+    sync();
+    itsAccessor->readSpectra(name, positions, firstChannel, nChan, spectra, nThreads);
+}
+
+/// @brief obtain coordinate system info
+/// @param[in] name image name
+/// @return coordinate system object
+casacore::CoordinateSystem AsyncImageAccess::coordSys(const std::string &name) const
+{
+    sync();
+    return itsAccessor->coordSys(name);
+}
+
+/// @brief obtain coordinate system info for part of an image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return coordinate system object
+casacore::CoordinateSystem AsyncImageAccess::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    sync();
+    return itsAccessor->coordSysSlice(name, blc, trc);
+}
+
+/// @brief obtain beam info
+/// @param[in] name image name
+/// @return beam info vector
+casacore::Vector<casacore::Quantum<double> > AsyncImageAccess::beamInfo(const std::string &name) const
+{
+    sync();
+    return itsAccessor->beamInfo(name);
+}
+
+/// @brief obtain per-channel beam info
+/// @param[in] name image name
+/// @return one beam per channel, empty if the image has no per-channel beams
+IImageAccess::BeamList AsyncImageAccess::beamList(const std::string &name) const
+{
+    sync();
+    return itsAccessor->beamList(name);
+}
+
+/// @brief obtain pixel units
+/// @param[in] name image name
+/// @return units string
+std::string AsyncImageAccess::getUnits(const std::string &name) const
+{
+    sync();
+    return itsAccessor->getUnits(name);
+}
+
+/// @brief Get a particular keyword from the image metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+std::string AsyncImageAccess::getMetadataKeyword(const std::string &name, const std::string &keyword) const
+{
+    sync();
+    return itsAccessor->getMetadataKeyword(name, keyword);
+}
+
+// writing methods
+
+/// @brief create a new image
+/// @details Metadata updates still pending for the image are written before it is recreated.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+void AsyncImageAccess::create(const std::string &name, const casacore::IPosition &shape,
+                              const casacore::CoordinateSystem &csys)
+{
+    submit(name, boost::bind(&IImageAccess::create, itsAccessor, name, shape, csys));
+}
+
+/// @brief write full image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+void AsyncImageAccess::write(const std::string &name, const casacore::Array<float> &arr)
+{
+    void (IImageAccess::*method)(const std::string &, const casacore::Array<float> &) = &IImageAccess::write;
+    submit(name, boost::bind(method, itsAccessor, name, arr.copy()), arr.nelements() * sizeof(float));
+}
+
+/// @brief write a slice of an image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void AsyncImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
+                             const casacore::IPosition &where)
+{
+    void (IImageAccess::*method)(const std::string &, const casacore::Array<float> &,
+                                 const casacore::IPosition &) = &IImageAccess::write;
+    submit(name, boost::bind(method, itsAccessor, name, arr.copy(), where), arr.nelements() * sizeof(float));
+}
+
+/// @brief write a slice of an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void AsyncImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                                 const casacore::IPosition &where)
+{
+    void (IImageAccess::*method)(const std::string &, const casacore::Array<bool> &,
+                                 const casacore::IPosition &) = &IImageAccess::writeMask;
+    submit(name, boost::bind(method, itsAccessor, name, mask.copy(), where), mask.nelements() * sizeof(bool));
+}
+
+/// @brief write an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+void AsyncImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+{
+    void (IImageAccess::*method)(const std::string &, const casacore::Array<bool> &) = &IImageAccess::writeMask;
+    submit(name, boost::bind(method, itsAccessor, name, mask.copy()), mask.nelements() * sizeof(bool));
+}
+
+/// @brief write a slice of an image together with its pixel mask
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] mask mask of the same shape as arr (true for good pixels)
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void AsyncImageAccess::writeMasked(const std::string &name, const casacore::Array<float> &arr,
+                                   const casacore::Array<bool> &mask, const casacore::IPosition &where)
+{
+    ASKAPCHECK(mask.shape().isEqual(arr.shape()), "Mask shape "<<mask.shape()<<
+               " doesn't match the shape of the pixel array "<<arr.shape());
+    submit(name, boost::bind(&IImageAccess::writeMasked, itsAccessor, name, arr.copy(), mask.copy(), where),
+           arr.nelements() * (sizeof(float) + sizeof(bool)));
+}
+
+/// @brief set brightness units of the image
+/// @param[in] name image name
+/// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+void AsyncImageAccess::setUnits(const std::string &name, const std::string &units)
+{
+    boost::shared_ptr<PendingMetadata> &metadata = itsMetadata[name];
+    if (!metadata) {
+        metadata.reset(new PendingMetadata);
+    }
+    metadata->hasUnits = true;
+    metadata->units = units;
+}
+
+/// @brief set restoring beam info
+/// @param[in] name image name
+/// @param[in] maj major axis in radians
+/// @param[in] min minor axis in radians
+/// @param[in] pa position angle in radians
+void AsyncImageAccess::setBeamInfo(const std::string &name, double maj, double min, double pa)
+{
+    boost::shared_ptr<PendingMetadata> &metadata = itsMetadata[name];
+    if (!metadata) {
+        metadata.reset(new PendingMetadata);
+    }
+    metadata->hasBeam = true;
+    metadata->beam[0] = maj;
+    metadata->beam[1] = min;
+    metadata->beam[2] = pa;
+}
+
+/// @brief set per-channel beam info
+/// @param[in] name image name
+/// @param[in] beams one beam per channel
+void AsyncImageAccess::setBeamList(const std::string &name, const BeamList &beams)
+{
+    boost::shared_ptr<PendingMetadata> &metadata = itsMetadata[name];
+    if (!metadata) {
+        metadata.reset(new PendingMetadata);
+    }
+    metadata->hasBeamList = true;
+    metadata->beams.resize(beams.size());
+    for (size_t chan = 0; chan < beams.size(); ++chan) {
+         metadata->beams[chan].reference(beams[chan].copy());
+    }
+}
+
+/// @brief apply mask to image
+/// @param[in] name image name
+void AsyncImageAccess::makeDefaultMask(const std::string &name)
+{
+    submit(name, boost::bind(&IImageAccess::makeDefaultMask, itsAccessor, name));
+}
+
+/// @brief Set a particular keyword for the metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @param[in] value The value for the keyword, in string format
+/// @param[in] desc A description of the keyword
+void AsyncImageAccess::setMetadataKeyword(const std::string &name, const std::string &keyword,
+        const std::string value, const std::string &desc)
+{
+    boost::shared_ptr<PendingMetadata> &metadata = itsMetadata[name];
+    if (!metadata) {
+        metadata.reset(new PendingMetadata);
+    }
+    for (size_t i = 0; i < metadata->keywords.size(); ++i) {
+         if (metadata->keywords[i].first == keyword) {
+             metadata->keywords[i].second = std::make_pair(value, desc);
+             return;
+         }
+    }
+    metadata->keywords.push_back(std::make_pair(keyword, std::make_pair(value, desc)));
+}
+
+/// @brief Add a HISTORY message to the image metadata
+/// @param[in] name Image name
+/// @param[in] history History comment to add
+void AsyncImageAccess::addHistory(const std::string &name, const std::string &history)
+{
+    boost::shared_ptr<PendingMetadata> &metadata = itsMetadata[name];
+    if (!metadata) {
+        metadata.reset(new PendingMetadata);
+    }
+    metadata->history.push_back(history);
+}
+
+// handle management
+
+/// @brief close the given image
+/// @details The close is queued after pending operations on this image.
+/// @param[in] name image name
+void AsyncImageAccess::close(const std::string &name)
+{
+    submit(name, boost::bind(&IImageAccess::close, itsAccessor, name));
+}
+
+/// @brief write all changes to disk
+/// @details The flush is queued after all pending operations.
+void AsyncImageAccess::flush()
+{
+    submit("", boost::bind(&IImageAccess::flush, itsAccessor));
+}
+
+} // namespace accessors
+} // namespace askap
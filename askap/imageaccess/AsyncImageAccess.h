@@ -0,0 +1,400 @@
+/// @file AsyncImageAccess.h
+/// @brief image accessor doing writes in a background thread
+/// @details This class wraps any IImageAccess implementation and queues all write
+/// operations as bulk jobs of the I/O scheduler of the process, so the caller (e.g. the
+/// imager writing a number of images after each major cycle) can carry on while the images
+/// are written.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_ASYNC_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_ASYNC_IMAGE_ACCESS_H
+
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/dataaccess/IOScheduler.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/utility.hpp>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief image accessor doing writes in a background thread
+/// @details All writing methods (including create, close and flush) are queued and executed
+/// in order using the wrapped accessor. The operations are jobs of one channel of the I/O scheduler
+/// of the process (see IOScheduler) in the bulk class, so they don't delay latency-critical reads
+/// and are subject to the bandwidth cap of the class. Pixel arrays are copied
+/// when queued, so the caller can reuse its buffers straight away. Metadata updates (units,
+/// beams, keywords and history) are accumulated per image and passed to the wrapped accessor
+/// together, just before the next pixel operation on the same image or when the queue is
+/// waited for, so a number of updates results in a single header rewrite. Repeated updates of
+/// the same item are coalesced (the last value wins), history messages are kept in order.
+/// Reading methods wait for all queued operations to finish, so reads always see the data
+/// written before. The number of queued operations is limited, write calls block when the
+/// queue is full, which bounds the memory used by the copies of pixel arrays.
+/// The future of the last queued operation is available via lastRequest, so the caller can wait
+/// for a particular write without waiting for operations queued afterwards. wait() waits for
+/// everything. An exception thrown by the wrapped accessor in the background thread is passed to
+/// the future of the failed operation as AskapError and is also reported by the next wait (or read)
+/// call. The wrapped accessor should not be used directly while this object exists. This class
+/// itself should be used by one thread at a time.
+/// @ingroup imageaccess
+class AsyncImageAccess : public IImageAccess, private boost::noncopyable {
+
+    public:
+
+        /// @brief type of the future of a queued operation
+        typedef boost::shared_future<void> Future;
+
+        /// @brief constructor
+        /// @param[in] acc accessor to do the actual reads and writes
+        /// @param[in] maxQueued maximum number of queued operations
+        explicit AsyncImageAccess(const boost::shared_ptr<IImageAccess> &acc, const size_t maxQueued = 16);
+
+        /// @brief destructor, waits for all queued operations
+        virtual ~AsyncImageAccess();
+
+        /// @brief wait for all queued operations to finish
+        /// @details Pending metadata updates are queued first. An error encountered by the
+        /// background thread is reported here.
+        void wait();
+
+        /// @brief future of the last queued operation
+        /// @details Operations are done in order, so the future is ready when all operations
+        /// queued so far are done. Metadata updates are not queued until the next pixel operation
+        /// on the same image (or wait()), so they are not covered by this future.
+        /// @return future of the last operation (ready if nothing has been queued)
+        Future lastRequest() const;
+
+        /// @brief number of operations queued, but not yet done
+        /// @return number of operations
+        size_t nQueued() const;
+
+        //////////////////
+        // Reading methods
+        //////////////////
+
+        /// @brief obtain the shape
+        /// @param[in] name image name
+        /// @return full shape of the given image
+        virtual casacore::IPosition shape(const std::string &name) const;
+
+        /// @brief read full image
+        /// @param[in] name image name
+        /// @return array with pixels
+        virtual casacore::Array<float> read(const std::string &name) const;
+
+        /// @brief read part of the image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @return array with pixels for the selection only
+        virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
+                                        const casacore::IPosition &trc) const;
+
+        /// @brief read part of the image into the given buffer
+        /// @details Queued operations are done first, the wrapped accessor then fills the buffer.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[out] buffer array to fill
+        virtual void read(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<float> &buffer) const;
+
+        /// @brief read part of the image into preallocated memory
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[out] data pointer to the memory for (trc-blc+1).product() pixels in the Fortran order
+        virtual void read(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, float *data) const;
+
+        /// @brief read a number of cutouts
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corners of the cutouts
+        /// @param[in] trc top right corners of the cutouts, same size as blc
+        /// @param[out] cutouts arrays with pixels, one per cutout
+        virtual void readCutouts(const std::string &name, const std::vector<casacore::IPosition> &blc,
+                                 const std::vector<casacore::IPosition> &trc,
+                                 std::vector<casacore::Array<float> > &cutouts) const;
+
+        /// @brief extract spectra at a number of positions
+        /// @details Queued operations are done first, the wrapped accessor then groups the
+        /// reads by its own storage chunks.
+        /// @param[in] name image name
+        /// @param[in] positions pixel positions (the element for the spectral axis is ignored)
+        /// @param[in] firstChannel first channel to extract
+        /// @param[in] nChan number of channels to extract
+        /// @param[out] spectra extracted spectra, resized to positions.size() x nChan
+        /// @param[in] nThreads number of threads to use
+        virtual void readSpectra(const std::string &name, const std::vector<casacore::IPosition> &positions,
+                                 casacore::uInt firstChannel, casacore::uInt nChan,
+                                 casacore::Matrix<float> &spectra, casacore::uInt nThreads = 1) const;
+
+        /// @brief obtain coordinate system info
+        /// @param[in] name image name
+        /// @return coordinate system object
+        virtual casacore::CoordinateSystem coordSys(const std::string &name) const;
+
+        /// @brief obtain coordinate system info for part of an image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @return coordinate system object
+        virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+                const casacore::IPosition &trc) const;
+
+        /// @brief obtain beam info
+        /// @param[in] name image name
+        /// @return beam info vector
+        virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const;
+
+        /// @brief obtain per-channel beam info
+        /// @param[in] name image name
+        /// @return one beam per channel, empty if the image has no per-channel beams
+        virtual BeamList beamList(const std::string &name) const;
+
+        /// @brief obtain pixel units
+        /// @param[in] name image name
+        /// @return units string
+        virtual std::string getUnits(const std::string &name) const;
+
+        /// @brief Get a particular keyword from the image metadata (A.K.A header)
+        /// @param[in] name Image name
+        /// @param[in] keyword The name of the metadata keyword
+        virtual std::string getMetadataKeyword(const std::string &name, const std::string &keyword) const;
+
+        //////////////////
+        // Writing methods
+        //////////////////
+
+        /// @brief create a new image
+        /// @param[in] name image name
+        /// @param[in] shape full shape of the image
+        /// @param[in] csys coordinate system of the full image
+        virtual void create(const std::string &name, const casacore::IPosition &shape,
+                            const casacore::CoordinateSystem &csys);
+
+        /// @brief write full image
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        virtual void write(const std::string &name, const casacore::Array<float> &arr);
+
+        /// @brief write a slice of an image
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void write(const std::string &name, const casacore::Array<float> &arr,
+                           const casacore::IPosition &where);
+
+        /// @brief write a slice of an image mask
+        /// @param[in] name image name
+        /// @param[in] mask array with mask
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                               const casacore::IPosition &where);
+
+        /// @brief write an image mask
+        /// @param[in] name image name
+        /// @param[in] mask array with mask
+        virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask);
+
+        /// @brief write a slice of an image together with its pixel mask
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        /// @param[in] mask mask of the same shape as arr (true for good pixels)
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void writeMasked(const std::string &name, const casacore::Array<float> &arr,
+                                 const casacore::Array<bool> &mask, const casacore::IPosition &where);
+
+        /// @brief set brightness units of the image
+        /// @param[in] name image name
+        /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+        virtual void setUnits(const std::string &name, const std::string &units);
+
+        /// @brief set restoring beam info
+        /// @param[in] name image name
+        /// @param[in] maj major axis in radians
+        /// @param[in] min minor axis in radians
+        /// @param[in] pa position angle in radians
+        virtual void setBeamInfo(const std::string &name, double maj, double min, double pa);
+
+        /// @brief set per-channel beam info
+        /// @param[in] name image name
+        /// @param[in] beams one beam per channel
+        virtual void setBeamList(const std::string &name, const BeamList &beams);
+
+        /// @brief apply mask to image
+        /// @param[in] name image name
+        virtual void makeDefaultMask(const std::string &name);
+
+        /// @brief Set a particular keyword for the metadata (A.K.A header)
+        /// @param[in] name Image name
+        /// @param[in] keyword The name of the metadata keyword
+        /// @param[in] value The value for the keyword, in string format
+        /// @param[in] desc A description of the keyword
+        virtual void setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                        const std::string value, const std::string &desc = "");
+
+        /// @brief Add a HISTORY message to the image metadata
+        /// @param[in] name Image name
+        /// @param[in] history History comment to add
+        virtual void addHistory(const std::string &name, const std::string &history);
+
+        //////////////////
+        // Handle management
+        //////////////////
+
+        /// @brief close the given image
+        /// @details The close is queued after pending operations on this image.
+        /// @param[in] name image name
+        virtual void close(const std::string &name);
+
+        /// @brief write all changes to disk
+        /// @details The flush is queued after all pending operations.
+        virtual void flush();
+
+    private:
+
+        /// @brief type of a queued operation
+        typedef boost::function<void()> Job;
+
+        /// @brief metadata updates accumulated for an image
+        struct PendingMetadata {
+            /// @brief constructor
+            PendingMetadata() : hasUnits(false), hasBeam(false), hasBeamList(false) {}
+
+            /// @brief true if units have been set
+            bool hasUnits;
+
+            /// @brief brightness units
+            std::string units;
+
+            /// @brief true if the restoring beam has been set
+            bool hasBeam;
+
+            /// @brief restoring beam (major, minor, position angle in radians)
+            double beam[3];
+
+            /// @brief true if per-channel beams have been set
+            bool hasBeamList;
+
+            /// @brief per-channel beams
+            BeamList beams;
+
+            /// @brief keywords in the order of the first update, value and description for each
+            std::vector<std::pair<std::string, std::pair<std::string, std::string> > > keywords;
+
+            /// @brief history messages
+            std::vector<std::string> history;
+        };
+
+        /// @brief queue an operation
+        /// @details Pending metadata of the given image are queued first. This method blocks
+        /// while the queue is full.
+        /// @param[in] name image name (empty string if the operation is not specific to an image)
+        /// @param[in] job operation to do
+        /// @param[in] bytes approximate amount of data written by the operation (for the bandwidth cap)
+        void submit(const std::string &name, const Job &job, const size_t bytes = 0);
+
+        /// @brief queue an operation without flushing pending metadata
+        /// @details If the scheduler refuses the operation, its slot in the queue is released
+        /// and the exception is passed to both the caller and the promise of the operation.
+        /// @param[in] job operation to do
+        /// @param[in] bytes approximate amount of data written by the operation (for the bandwidth cap)
+        void enqueue(const Job &job, const size_t bytes = 0);
+
+        /// @brief queue pending metadata of the given image
+        /// @param[in] name image name
+        void submitMetadata(const std::string &name);
+
+        /// @brief queue pending metadata of all images
+        void submitAllMetadata();
+
+        /// @brief wait for all operations, as needed before reads
+        /// @details Pending metadata are queued first. This is logically const, as it doesn't
+        /// change what the reads return.
+        void sync() const;
+
+        /// @brief pass accumulated metadata to the wrapped accessor
+        /// @details This method is executed in the background thread.
+        /// @param[in] name image name
+        /// @param[in] metadata metadata to write
+        void writeMetadata(const std::string &name, const boost::shared_ptr<PendingMetadata> &metadata);
+
+        /// @brief do one operation and fulfil its promise
+        /// @details This method is executed by the I/O scheduler. Exceptions can't propagate across
+        /// threads, therefore the error is passed to the promise and the error message is stored to be
+        /// reported by the next wait.
+        /// @param[in] job operation to do
+        /// @param[in] promise promise to fulfil
+        void execute(const Job &job, const boost::shared_ptr<boost::promise<void> > &promise);
+
+        /// @brief report the error of the background thread, if any
+        /// @details This method should be called with the mutex locked.
+        void checkError();
+
+        /// @brief accessor doing the actual work
+        boost::shared_ptr<IImageAccess> itsAccessor;
+
+        /// @brief maximum number of queued operations
+        const size_t itsMaxQueued;
+
+        /// @brief channel of the I/O scheduler executing the operations in order
+        IOScheduler::Channel itsChannel;
+
+        /// @brief metadata not queued yet, by image name
+        std::map<std::string, boost::shared_ptr<PendingMetadata> > itsMetadata;
+
+        /// @brief future of the last queued operation
+        Future itsLastRequest;
+
+        /// @brief number of operations queued or in progress
+        size_t itsNPending;
+
+        /// @brief error message of the background thread (empty if successful)
+        std::string itsError;
+
+        /// @brief mutex protecting the counter and the error message
+        mutable boost::mutex itsMutex;
+
+        /// @brief condition signalled when an operation is done
+        boost::condition_variable itsCondition;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
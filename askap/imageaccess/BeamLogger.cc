@@ -30,20 +30,23 @@
 #include <askap/imageaccess/BeamLogger.h>
 
 // System includes
+#include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 
 // ASKAPsoft includes
 #include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
 #include <askapparallel/AskapParallel.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Quanta/Quantum.h>
 #include <Common/ParameterSet.h>
-#include <Blob/BlobString.h>
-#include <Blob/BlobIBufString.h>
-#include <Blob/BlobOBufString.h>
-#include <Blob/BlobIStream.h>
-#include <Blob/BlobOStream.h>
+#include <casacore/images/Images/ImageInfo.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 
 // Local package includeas
 #include <askap/imageaccess/CasaImageAccess.h>
@@ -71,16 +74,98 @@ BeamLogger::BeamLogger(const std::string &filename):
 }
 
 void BeamLogger::extractBeams(const std::vector<std::string>& imageList)
+{
+    extractBeams(imageList, 1);
+}
+
+/// @brief read the restoring beam of a CASA image
+/// @details Only the imageinfo keyword of the image table is read, so the coordinates,
+/// units and the pixel lattice are not set up as they would be by PagedImage.
+/// @param[in] name image name
+/// @return beam as a 3-element vector (zero size beam if the image has no beam)
+static casacore::Vector<casacore::Quantum<double> > readBeam(const std::string &name)
+{
+    const casacore::Table table(name, casacore::TableLock(casacore::TableLock::AutoNoReadLocking));
+    casacore::ImageInfo info;
+    if (table.keywordSet().isDefined("imageinfo")) {
+        casacore::String error;
+        ASKAPCHECK(info.fromRecord(error, table.keywordSet().asRecord("imageinfo")),
+                   "Unable to read image info of " << name << ": " << error);
+    }
+    return info.restoringBeam().toVector();
+}
+
+/// @brief read beams for a subset of images
+/// @param[in] imageList list of image names
+/// @param[in] indices indices into the image list to process
+/// @param[in] first first element of indices to process
+/// @param[in] last one past the last element of indices to process
+/// @param[out] beams beams, one per element of indices
+static void readBeamRange(const std::vector<std::string> &imageList, const std::vector<unsigned int> &indices,
+                          size_t first, size_t last,
+                          std::vector<casacore::Vector<casacore::Quantum<double> > > &beams)
+{
+    for (size_t i = first; i < last; ++i) {
+         beams[i] = readBeam(imageList[indices[i]]);
+    }
+}
+
+/// @brief read beams for the given images into the beam list
+/// @param[in] imageList list of image names
+/// @param[in] indices indices into the image list to process (used as channel numbers)
+/// @param[in] nThreads number of threads to use
+/// @param[inout] beamList beam list to fill
+static void readBeams(const std::vector<std::string> &imageList, const std::vector<unsigned int> &indices,
+                      unsigned int nThreads,
+                      std::map<unsigned int, casacore::Vector<casacore::Quantum<double> > > &beamList)
+{
+    const size_t nImages = indices.size();
+    std::vector<casacore::Vector<casacore::Quantum<double> > > beams(nImages);
+    nThreads = std::min(std::max(nThreads, 1u), static_cast<unsigned int>(std::max(nImages, size_t(1))));
+    const size_t step = (nImages + nThreads - 1) / nThreads;
+    boost::thread_group threads;
+    for (size_t start = step; start < nImages; start += step) {
+         threads.create_thread(boost::bind(readBeamRange, boost::cref(imageList), boost::cref(indices), start,
+                                           std::min(start + step, nImages), boost::ref(beams)));
+    }
+    // the first portion is done by this thread
+    readBeamRange(imageList, indices, 0, std::min(step, nImages), beams);
+    threads.join_all();
+    for (size_t i = 0; i < nImages; ++i) {
+         beamList[indices[i]] = beams[i];
+    }
+}
+
+void BeamLogger::extractBeams(const std::vector<std::string>& imageList, unsigned int nThreads)
 {
     itsBeamList.clear();
-    std::vector<std::string>::const_iterator image = imageList.begin();
+    std::vector<unsigned int> indices(imageList.size());
+    for (unsigned int chan = 0; chan < indices.size(); ++chan) {
+        indices[chan] = chan;
+    }
+    readBeams(imageList, indices, nThreads, itsBeamList);
+}
 
-    unsigned int chan = 0;
-    for (; image != imageList.end(); image++) {
-        CasaImageAccess ia;
-        itsBeamList[chan] = ia.beamInfo(*image);
-        chan++;
+void BeamLogger::extractBeams(askapparallel::AskapParallel &comms, const std::vector<std::string>& imageList,
+                              int rankToGather, bool includeMaster, unsigned int nThreads)
+{
+    if (!comms.isParallel()) {
+        extractBeams(imageList, nThreads);
+        return;
     }
+    itsBeamList.clear();
+    const int minrank = includeMaster ? 0 : 1;
+    const int nWorkers = comms.nProcs() - minrank;
+    ASKAPCHECK(nWorkers > 0, "No ranks available to extract the beams");
+    if (comms.rank() >= minrank) {
+        std::vector<unsigned int> indices;
+        for (unsigned int chan = comms.rank() - minrank; chan < imageList.size(); chan += nWorkers) {
+            indices.push_back(chan);
+        }
+        ASKAPLOG_DEBUG_STR(logger, "Rank " << comms.rank() << " extracts beams of " << indices.size() << " images");
+        readBeams(imageList, indices, nThreads, itsBeamList);
+    }
+    gather(comms, rankToGather, includeMaster);
 }
 
 casacore::Vector<casacore::Quantum<double> > BeamLogger::beam(const unsigned int channel)
@@ -167,69 +252,65 @@ void BeamLogger::gather(askapparallel::AskapParallel &comms, int rankToGather, b
             minrank=1;
         }
 
+        // beams travel as a flat array of (chan, bmaj[arcsec], bmin[arcsec], bpa[deg]) quadruplets
+        // preceded by a separate message with the number of beams
+        const int tag = 1;
+
         if (comms.rank() != rankToGather) {
             // If we are here, the current rank does not do the gathering.
             // Instead, send the data to the rank that is.
+            if (comms.rank() < minrank) {
+                return;
+            }
 
             ASKAPLOG_DEBUG_STR(logger, "Sending from rank " << comms.rank() <<" to rank " << rankToGather);
-            // send to desired rank
-            LOFAR::BlobString bs;
-            bs.resize(0);
-            LOFAR::BlobOBufString bob(bs);
-            LOFAR::BlobOStream out(bob);
-            out.putStart("gatherBeam", 1);
-            unsigned int size = itsBeamList.size();
-            out << size;
-            if (itsBeamList.size() > 0) {
+            const unsigned long size = itsBeamList.size();
+            comms.send(&size, sizeof(size), rankToGather, tag);
+            if (size > 0) {
                 ASKAPLOG_DEBUG_STR(logger, "This has data, so sending beam list of size " << size);
+                std::vector<double> buf;
+                buf.reserve(4 * size);
                 std::map<unsigned int, casacore::Vector<casacore::Quantum<double> > >::iterator beam = itsBeamList.begin();
                 for (; beam != itsBeamList.end(); beam++) {
-                    out << beam->first
-                        << beam->second[0].getValue("arcsec")
-                        << beam->second[1].getValue("arcsec")
-                        << beam->second[2].getValue("deg");
+                    buf.push_back(beam->first);
+                    buf.push_back(beam->second[0].getValue("arcsec"));
+                    buf.push_back(beam->second[1].getValue("arcsec"));
+                    buf.push_back(beam->second[2].getValue("deg"));
                 }
+                comms.send(&buf[0], buf.size() * sizeof(double), rankToGather, tag);
             }
-            out.putEnd();
-            comms.sendBlob(bs, rankToGather);
         } else {
 
-            // The rank on which we are gathering the data
-            // Loop over all the others and read their beam.
-            for (int rank = minrank; rank < comms.nProcs(); rank++) {
-                
-                if (rank != comms.rank()) {
-                    ASKAPLOG_DEBUG_STR(logger, "Preparing to receive beamlist from rank " << rank);
-                    LOFAR::BlobString bs;
-                    bs.resize(0);
-                    comms.receiveBlob(bs, rank);
-                    LOFAR::BlobIBufString bib(bs);
-                    LOFAR::BlobIStream in(bib);
-                    int version = in.getStart("gatherBeam");
-                    ASKAPASSERT(version == 1);
-                    unsigned int size, chan;
-                    double bmaj, bmin, bpa;
-                    in >> size;
-                    if (size > 0) {
-                        ASKAPLOG_DEBUG_STR(logger, "Has data - about to receive " << size << " channels");
-                        for(unsigned int i=0;i<size;i++){
-                            in >> chan >> bmaj >> bmin >> bpa;
-                            if (bmaj > 0.) {
-                                casacore::Vector<casacore::Quantum<double> > currentbeam(3);
-                                currentbeam[0] = casacore::Quantum<double>(bmaj, "arcsec");
-                                currentbeam[1] = casacore::Quantum<double>(bmin, "arcsec");
-                                currentbeam[2] = casacore::Quantum<double>(bpa, "deg");
-                                itsBeamList[chan] = currentbeam;
-                            }
+            // The rank on which we are gathering the data.
+            // Take the messages in the order the other ranks get to send them, so a slow
+            // rank doesn't hold up unpacking of the data from the others.
+            int nSenders = comms.nProcs() - minrank;
+            if (comms.rank() >= minrank) {
+                --nSenders;
+            }
+            std::vector<double> buf;
+            for (int msg = 0; msg < nSenders; msg++) {
+                unsigned long size;
+                int rank;
+                comms.receiveAnySrc(&size, sizeof(size), rank, tag);
+                if (size > 0) {
+                    ASKAPLOG_DEBUG_STR(logger, "Rank " << rank << " has data - about to receive " << size << " channels");
+                    buf.resize(4 * size);
+                    comms.receive(&buf[0], buf.size() * sizeof(double), rank, tag);
+                    for (unsigned long i = 0; i < size; i++) {
+                        const double *beam = &buf[4 * i];
+                        if (beam[1] > 0.) {
+                            casacore::Vector<casacore::Quantum<double> > currentbeam(3);
+                            currentbeam[0] = casacore::Quantum<double>(beam[1], "arcsec");
+                            currentbeam[1] = casacore::Quantum<double>(beam[2], "arcsec");
+                            currentbeam[2] = casacore::Quantum<double>(beam[3], "deg");
+                            itsBeamList[static_cast<unsigned int>(beam[0])] = currentbeam;
                         }
                     }
-                    else {
-                        ASKAPLOG_DEBUG_STR(logger, "No data from rank " << rank);
-                    }
-                    in.getEnd();
-                    
                 }
-                
+                else {
+                    ASKAPLOG_DEBUG_STR(logger, "No data from rank " << rank);
+                }
             }
             
         }
@@ -71,6 +71,30 @@ class BeamLogger {
         /// @param imageList A vector list of image names
         void extractBeams(const std::vector<std::string>& imageList);
 
+        /// @brief Extract the beam information for each channel image
+        /// using a number of threads
+        /// @details Only the image info record of each image is read,
+        /// the images are not opened as lattices and no pixel data is
+        /// accessed. The images are distributed between threads in
+        /// contiguous blocks.
+        /// @param imageList A vector list of image names
+        /// @param nThreads Number of threads to use (1 means serial)
+        void extractBeams(const std::vector<std::string>& imageList, unsigned int nThreads);
+
+        /// @brief Extract the beam information with the work
+        /// distributed over ranks
+        /// @details Each rank taking part reads every n-th image
+        /// (round-robin, with n being the number of ranks involved)
+        /// using the given number of threads, then the beams are
+        /// collected on the nominated rank with gather.
+        /// @param comms Communication object
+        /// @param imageList A vector list of image names (the same on all ranks)
+        /// @param rankToGather Rank receiving the full beam list
+        /// @param includeMaster If false, rank 0 doesn't read any images
+        /// @param nThreads Number of threads to use on each rank
+        void extractBeams(askapparallel::AskapParallel &comms, const std::vector<std::string>& imageList,
+                          int rankToGather, bool includeMaster, unsigned int nThreads = 1);
+
         /// @brief Write the beam information to the beam log
         /// @details The beam information for each channel is written
         /// to the beam log. The log is in ASCII format, with each
@@ -95,6 +119,9 @@ class BeamLogger {
         /// the channel and beam information to the nominated
         /// rank. The beamlists are aggregated on that rank ready for
         /// writing, ignoring any channels that have zero-sized beams.
+        /// Beams are sent as a flat array of doubles and the
+        /// nominated rank takes the messages from any source in the
+        /// order they arrive.
     void gather(askapparallel::AskapParallel &comms, int rankToGather, bool includeMaster);
 
 
@@ -30,18 +30,292 @@
 #include <askap_accessors.h>
 
 #include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/ImageView.h>
+#include <askap/dataaccess/AccessTracer.h>
 
 #include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <casacore/images/Images/ImageConcat.h>
+#include <casacore/images/Images/ImageOpener.h>
 #include <casacore/images/Images/PagedImage.h>
-#include <casacore/images/Images/SubImage.h>
 #include <casacore/images/Regions/ImageRegion.h>
 #include <casacore/images/Regions/RegionHandler.h>
+#include <casacore/lattices/Lattices/LatticeIterator.h>
+#include <casacore/lattices/Lattices/TileStepper.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
+
+#include <algorithm>
+#include <sstream>
 
 ASKAP_LOGGER(logger, ".casaImageAccessor");
 
 using namespace askap;
 using namespace askap::accessors;
 
+/// @brief zero masked pixels in place
+/// @details This is a simple loop without branches, so it can be vectorised by the compiler.
+/// @param[in] pixels pointer to pixels
+/// @param[in] mask pointer to the mask (true for good pixels)
+/// @param[in] n number of pixels
+static void applyMask(float *pixels, const casacore::Bool *mask, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+         pixels[i] = mask[i] ? pixels[i] : 0.f;
+    }
+}
+
+/// @brief target number of pixels in a tile for the SPECTRAL and SPATIAL schemes (1 MB of floats)
+static const ssize_t theirTargetTilePixels = 262144;
+
+/// @brief constructor
+/// @param[in] cacheSize maximum number of images kept open, zero means
+/// that images are opened for each call
+CasaImageAccess::CasaImageAccess(const size_t cacheSize) : itsImages(cacheSize), itsTiling(BALANCED) {}
+
+/// @brief set the tiling scheme for images created afterwards
+/// @param[in] tiling tiling scheme
+void CasaImageAccess::setTiling(const Tiling tiling)
+{
+    itsTiling = tiling;
+}
+
+/// @brief set an explicit tile shape for images created afterwards
+/// @details An empty shape means that the tiling scheme is used (this is the default).
+/// The tile shape should have the same dimensions as the images created.
+/// @param[in] tileShape tile shape
+void CasaImageAccess::setTileShape(const casacore::IPosition &tileShape)
+{
+    itsTileShape = tileShape;
+}
+
+/// @brief obtain the tile shape of an existing image
+/// @param[in] name image name
+/// @return tile shape used by the storage manager
+casacore::IPosition CasaImageAccess::tileShape(const std::string &name) const
+{
+    return image(name)->niceCursorShape();
+}
+
+/// @brief shape of the chunks the image is stored in
+/// @details Chunks match the tiles of the image, so every tile touched by an accumulated
+/// slice or by extracted spectra is read (and written) once.
+/// @param[in] name image name
+/// @param[in] imageShape shape of the image
+/// @return tile shape of the image
+casacore::IPosition CasaImageAccess::storageChunk(const std::string &name, const casacore::IPosition &imageShape) const
+{
+    const casacore::IPosition tile = tileShape(name);
+    ASKAPCHECK(tile.nelements() == imageShape.nelements(), "Tile shape "<<tile<<" of image "<<name<<
+               " doesn't match the image shape "<<imageShape);
+    return tile;
+}
+
+/// @brief read the image tile by tile
+/// @details The given function is called for each tile in turn (in the storage order),
+/// so every tile is read from disk only once and at most one tile is kept in memory.
+/// The pixel mask is not applied.
+/// @param[in] name image name
+/// @param[in] func function to call for each tile
+void CasaImageAccess::readTiles(const std::string &name, const TileFunction &func) const
+{
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    const casacore::IPosition tile = img->niceCursorShape();
+    ASKAPLOG_DEBUG_STR(logger, "Reading CASA image " << name << " tile by tile, tile shape " << tile);
+    const casacore::TileStepper stepper(img->shape(), tile);
+    casacore::RO_LatticeIterator<float> it(*img, stepper);
+    for (it.reset(); !it.atEnd(); it++) {
+         func(it.cursor(), it.position());
+    }
+}
+
+/// @brief compute the tile shape for the given tiling scheme
+/// @details The spectral and direction axes are found from the coordinate system. If
+/// they are absent, the first two axes are assumed to be spatial and the last one 
+/// (if there are more than two) to be spectral. Other axes (e.g. polarisation) always 
+/// have the tile length of 1 in the SPECTRAL and SPATIAL schemes.
+/// @param[in] shape shape of the image
+/// @param[in] csys coordinate system of the image
+/// @param[in] tiling tiling scheme
+/// @return tile shape
+casacore::IPosition CasaImageAccess::makeTileShape(const casacore::IPosition &shape,
+               const casacore::CoordinateSystem &csys, const Tiling tiling)
+{
+    if ((tiling == BALANCED) || (shape.nelements() < 2)) {
+        return casacore::TiledShape(shape).tileShape();
+    }
+    std::vector<casacore::Int> dirAxes;
+    const casacore::Int dirCoord = csys.findCoordinate(casacore::Coordinate::DIRECTION);
+    if (dirCoord >= 0) {
+        const casacore::Vector<casacore::Int> axes = csys.pixelAxes(dirCoord);
+        dirAxes.assign(axes.begin(), axes.end());
+    } else {
+        dirAxes.push_back(0);
+        dirAxes.push_back(1);
+    }
+    casacore::Int specAxis = shape.nelements() > 2 ? casacore::Int(shape.nelements()) - 1 : -1;
+    const casacore::Int specCoord = csys.findCoordinate(casacore::Coordinate::SPECTRAL);
+    if (specCoord >= 0) {
+        specAxis = csys.pixelAxes(specCoord)(0);
+    }
+    if ((tiling == SPECTRAL) && (specAxis < 0)) {
+        // nothing to optimise for
+        return casacore::TiledShape(shape).tileShape();
+    }
+    casacore::IPosition tile(shape.nelements(), 1);
+    // spatial tile side, the spectral axis gets the rest of the target size
+    const ssize_t side = tiling == SPECTRAL ? 4 : 512;
+    ssize_t spatialPixels = 1;
+    for (size_t i = 0; i < dirAxes.size(); ++i) {
+         if ((dirAxes[i] >= 0) && (dirAxes[i] < casacore::Int(shape.nelements()))) {
+             tile(dirAxes[i]) = std::min(shape(dirAxes[i]), side);
+             spatialPixels *= tile(dirAxes[i]);
+         }
+    }
+    if ((tiling == SPECTRAL) && (specAxis >= 0)) {
+        tile(specAxis) = std::max(ssize_t(1), std::min(shape(specAxis), theirTargetTilePixels / spatialPixels));
+    }
+    return tile;
+}
+
+/// @brief name of the image holding the given slab of a cube
+/// @param[in] name name of the full cube
+/// @param[in] slab slab number
+/// @return name of the slab image
+std::string CasaImageAccess::slabName(const std::string &name, const casacore::uInt slab)
+{
+    std::ostringstream os;
+    os << name << ".slab" << slab;
+    return os.str();
+}
+
+/// @brief axis along which cubes are split into slabs
+/// @details This is the spectral axis if the coordinate system has one and the last axis otherwise
+/// (see IImageAccess::spectralAxis).
+/// @param[in] shape shape of the full cube
+/// @param[in] csys coordinate system of the full cube
+/// @return axis number
+casacore::uInt CasaImageAccess::slabAxis(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys)
+{
+    return spectralAxis(shape, csys);
+}
+
+/// @brief position of the given slab in the full cube
+/// @details Planes are distributed between the slabs as evenly as possible, the first slabs
+/// get one extra plane if the number of planes is not divisible by the number of slabs.
+/// @param[in] shape shape of the full cube
+/// @param[in] csys coordinate system of the full cube
+/// @param[in] slab slab number
+/// @param[in] nSlabs total number of slabs
+/// @param[out] blc bottom left corner of the slab in the full cube
+/// @param[out] slabShape shape of the slab
+void CasaImageAccess::slabExtent(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys,
+                                 const casacore::uInt slab, const casacore::uInt nSlabs,
+                                 casacore::IPosition &blc, casacore::IPosition &slabShape)
+{
+    const casacore::uInt axis = slabAxis(shape, csys);
+    ASKAPCHECK(slab < nSlabs, "Slab number " << slab << " exceeds the number of slabs " << nSlabs);
+    ASKAPCHECK(ssize_t(nSlabs) <= shape(axis), "Unable to split " << shape(axis) << " planes into " <<
+               nSlabs << " slabs");
+    const ssize_t nPlanes = shape(axis) / nSlabs;
+    const ssize_t nExtra = shape(axis) % nSlabs;
+    blc = casacore::IPosition(shape.nelements(), 0);
+    blc(axis) = nPlanes * slab + std::min(ssize_t(slab), nExtra);
+    slabShape = shape;
+    slabShape(axis) = nPlanes + (ssize_t(slab) < nExtra ? 1 : 0);
+}
+
+/// @brief create a new image for a slab of a cube
+/// @details This method is intended to be called by each rank writing a part of the cube.
+/// The slab image has the coordinate system of its part of the cube and is written with
+/// the usual methods using its name (see slabName) and the coordinates relative to the slab
+/// (see slabExtent). Different ranks write different images, so no synchronisation is required.
+/// @param[in] name name of the full cube
+/// @param[in] shape shape of the full cube
+/// @param[in] csys coordinate system of the full cube
+/// @param[in] slab slab number
+/// @param[in] nSlabs total number of slabs
+/// @return name of the slab image
+std::string CasaImageAccess::createSlab(const std::string &name, const casacore::IPosition &shape,
+                                        const casacore::CoordinateSystem &csys, const casacore::uInt slab,
+                                        const casacore::uInt nSlabs)
+{
+    casacore::IPosition blc;
+    casacore::IPosition slabShape;
+    slabExtent(shape, csys, slab, nSlabs, blc, slabShape);
+    const std::string slabImage = slabName(name, slab);
+    ASKAPLOG_INFO_STR(logger, "Slab " << slab << " of " << nSlabs << " of the CASA image " << name <<
+                      " starts at " << blc << " and will be written into " << slabImage);
+    casacore::Vector<casacore::Float> originShift(blc.nelements());
+    for (size_t dim = 0; dim < blc.nelements(); ++dim) {
+         originShift[dim] = float(blc(dim));
+    }
+    const casacore::CoordinateSystem slabCsys = csys.subImage(originShift,
+              casacore::Vector<casacore::Float>(blc.nelements(), 1.f), slabShape.asVector());
+    create(slabImage, slabShape, slabCsys);
+    return slabImage;
+}
+
+/// @brief join slab images into a virtual cube
+/// @details This method is called by one rank after all slabs have been created
+/// (and all slab images have been closed by their writers). Pixels are not copied,
+/// the cube just refers to the slab images, which therefore have to be kept. Reading
+/// and writing of the cube is then done with the usual methods.
+/// @param[in] name name of the full cube
+/// @param[in] nSlabs total number of slabs
+void CasaImageAccess::concatenateSlabs(const std::string &name, const casacore::uInt nSlabs)
+{
+    ASKAPCHECK(nSlabs > 0, "At least one slab is required to form the image " << name);
+    ASKAPLOG_INFO_STR(logger, "Concatenating " << nSlabs << " slabs into a virtual CASA image " << name);
+    // the cube and the slabs may be kept open, their handles would be stale after this call
+    itsImages.remove(name);
+    for (casacore::uInt slab = 0; slab < nSlabs; ++slab) {
+         itsImages.remove(slabName(name, slab));
+    }
+    casacore::PagedImage<float> first(slabName(name, 0));
+    const casacore::uInt axis = slabAxis(first.shape(), first.coordinates());
+    // slabs are closed temporarily, so any number of them can be joined
+    casacore::ImageConcat<float> concat(axis, casacore::True);
+    concat.setImage(first, casacore::False);
+    for (casacore::uInt slab = 1; slab < nSlabs; ++slab) {
+         casacore::PagedImage<float> img(slabName(name, slab));
+         concat.setImage(img, casacore::False);
+    }
+    concat.save(name);
+}
+
+/// @brief copy an image into a monolithic one
+/// @details The copy is done tile by tile and includes units, image info, miscellaneous
+/// info and the pixel mask. This is intended to convert a virtual cube (see concatenateSlabs)
+/// into a normal image after the job. The handle cache is not used, so the method
+/// can be called from a background thread while this class is used to access other images.
+/// @param[in] name name of the image to copy (e.g. the virtual cube)
+/// @param[in] mergedName name of the new image
+void CasaImageAccess::merge(const std::string &name, const std::string &mergedName)
+{
+    ASKAPCHECK(name != mergedName, "Unable to merge the image " << name << " into itself");
+    const AccessTracer::Scope trace("merge", name, "imageaccess");
+    ASKAPLOG_INFO_STR(logger, "Merging CASA image " << name << " into " << mergedName);
+    const boost::shared_ptr<casacore::ImageInterface<float> > in = openImage(name);
+    casacore::PagedImage<float> out(casacore::TiledShape(in->shape()), in->coordinates(), mergedName);
+    out.setUnits(in->units());
+    out.setImageInfo(in->imageInfo());
+    out.setMiscInfo(in->miscInfo());
+    const bool hasMask = in->hasPixelMask();
+    if (hasMask) {
+        out.makeMask("mask", casacore::True, casacore::True);
+    }
+    // the input is read in the order of tiles of the new image, so each of them is written once
+    const casacore::TileStepper stepper(in->shape(), out.niceCursorShape());
+    casacore::RO_LatticeIterator<float> it(*in, stepper);
+    for (it.reset(); !it.atEnd(); it++) {
+         out.putSlice(it.cursor(), it.position());
+         if (hasMask) {
+             const casacore::Slicer slicer(it.position(), it.endPosition(), casacore::Slicer::endIsLast);
+             out.pixelMask().putSlice(in->getMaskSlice(slicer), it.position());
+         }
+    }
+}
+
 // reading methods
 
 /// @brief obtain the shape
@@ -49,8 +323,8 @@ using namespace askap::accessors;
 /// @return full shape of the given image
 casacore::IPosition CasaImageAccess::shape(const std::string &name) const
 {
-    casacore::PagedImage<float> img(name);
-    return img.shape();
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    return img->shape();
 }
 
 /// @brief read full image
@@ -58,30 +332,12 @@ casacore::IPosition CasaImageAccess::shape(const std::string &name) const
 /// @return array with pixels
 casacore::Array<float> CasaImageAccess::read(const std::string &name) const
 {
+    const AccessTracer::Scope trace("read", name, "imageaccess");
     ASKAPLOG_INFO_STR(logger, "Reading CASA image " << name);
-    casacore::PagedImage<float> img(name);
-    if (img.hasPixelMask()) {
-        ASKAPLOG_INFO_STR(logger, " - setting unmasked pixels to zero");
-        // generate an Array of zeros and copy the elements for which the mask is true
-        casacore::Array<float> tempArray(img.get().shape(), 0.0);
-        tempArray = casacore::MaskedArray<float>(img.get(), img.getMask(), casacore::True);
-        return tempArray;
-        // The following seems to avoid a copy but takes longer:
-        //// Iterate over image array and set any unmasked pixels to zero
-        //casacore::Array<float> tempArray = img.get();
-        //const casacore::LogicalArray tempMask = img.getMask();
-        //casacore::Array<float>::iterator iterArray = tempArray.begin();
-        //casacore::LogicalArray::const_iterator iterMask = tempMask.begin();
-        //for( ; iterArray != tempArray.end() ; iterArray++ ) {
-        //    if (*iterMask == casacore::False) {
-        //        *iterArray = 0.0;
-        //    }
-        //    iterMask++;
-        //}
-        //return tempArray;
-    } else {
-        return img.get();
-    }
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    casacore::Array<float> pixels;
+    readSlice(*img, casacore::Slicer(casacore::IPosition(img->ndim(), 0), img->shape()), pixels, NULL);
+    return pixels;
 }
 
 /// @brief read part of the image
@@ -92,32 +348,64 @@ casacore::Array<float> CasaImageAccess::read(const std::string &name) const
 casacore::Array<float> CasaImageAccess::read(const std::string &name, const casacore::IPosition &blc,
         const casacore::IPosition &trc) const
 {
+    const AccessTracer::Scope trace("read", name, "imageaccess");
     ASKAPLOG_INFO_STR(logger, "Reading a slice of the CASA image " << name << " from " << blc << " to " << trc);
-    casacore::PagedImage<float> img(name);
-    if (img.hasPixelMask()) {
-        ASKAPLOG_INFO_STR(logger, " - setting unmasked pixels to zero");
-        // generate an Array of zeros and copy the elements for which the mask is true
-        const casacore::Slicer slicer(blc, trc, casacore::Slicer::endIsLast);
-        casacore::Array<float> tempSlice(img.getSlice(slicer).shape(), 0.0);
-        tempSlice = casacore::MaskedArray<float>(img.getSlice(slicer), img.getMaskSlice(slicer), casacore::True);
-        return tempSlice;
-        // The following seems to avoid a copy but takes longer:
-        //// Iterate over image array and set any unmasked pixels to zero
-        //const casacore::Slicer slicer(blc,trc,casacore::Slicer::endIsLast);
-        //casacore::Array<float> tempSlice = img.getSlice(slicer);
-        //const casacore::LogicalArray tempMask = img.getMaskSlice(slicer);
-        //casacore::Array<float>::iterator iterSlice = tempSlice.begin();
-        //casacore::LogicalArray::const_iterator iterMask = tempMask.begin();
-        //for( ; iterSlice != tempSlice.end() ; iterSlice++ ) {
-        //    if (*iterMask == casacore::False) {
-        //        *iterSlice = 0.0;
-        //    }
-        //    iterMask++;
-        //}
-        //return tempSlice;
-    } else {
-        return img.getSlice(casacore::Slicer(blc, trc, casacore::Slicer::endIsLast));
-    }
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    casacore::Array<float> pixels;
+    readSlice(*img, casacore::Slicer(blc, trc, casacore::Slicer::endIsLast), pixels, NULL);
+    return pixels;
+}
+
+/// @brief read part of the image into the given buffer
+/// @details The pixels are read directly into the buffer, which is only resized
+/// if its shape differs from that of the selection.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill
+void CasaImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                           const casacore::IPosition &trc, casacore::Array<float> &buffer) const
+{
+    const AccessTracer::Scope trace("read", name, "imageaccess");
+    ASKAPLOG_DEBUG_STR(logger, "Reading a slice of the CASA image " << name << " from " << blc << " to " << trc);
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    readSlice(*img, casacore::Slicer(blc, trc, casacore::Slicer::endIsLast), buffer, NULL);
+}
+
+/// @brief read full image together with its pixel mask
+/// @details Pixels are returned in the same way as by read (i.e. masked pixels are
+/// set to zero), the mask is returned as well so it doesn't have to be read again.
+/// If the image has no pixel mask, all mask elements are set to true.
+/// @param[in] name image name
+/// @param[out] pixels array with pixels
+/// @param[out] mask array with mask (true for good pixels)
+void CasaImageAccess::readWithMask(const std::string &name, casacore::Array<float> &pixels,
+                                   casacore::Array<bool> &mask) const
+{
+    const AccessTracer::Scope trace("readWithMask", name, "imageaccess");
+    ASKAPLOG_INFO_STR(logger, "Reading CASA image " << name << " with its mask");
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    readSlice(*img, casacore::Slicer(casacore::IPosition(img->ndim(), 0), img->shape()), pixels, &mask);
+}
+
+/// @brief read part of the image together with its pixel mask
+/// @details Pixels are returned in the same way as by read (i.e. masked pixels are
+/// set to zero), the mask is returned as well so it doesn't have to be read again.
+/// If the image has no pixel mask, all mask elements are set to true.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] pixels array with pixels for the selection
+/// @param[out] mask array with mask for the selection (true for good pixels)
+void CasaImageAccess::readWithMask(const std::string &name, const casacore::IPosition &blc,
+                                   const casacore::IPosition &trc, casacore::Array<float> &pixels,
+                                   casacore::Array<bool> &mask) const
+{
+    const AccessTracer::Scope trace("readWithMask", name, "imageaccess");
+    ASKAPLOG_INFO_STR(logger, "Reading a slice of the CASA image " << name << " from " << blc << " to " << trc <<
+                      " with its mask");
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    readSlice(*img, casacore::Slicer(blc, trc, casacore::Slicer::endIsLast), pixels, &mask);
 }
 
 /// @brief obtain coordinate system info
@@ -125,35 +413,47 @@ casacore::Array<float> CasaImageAccess::read(const std::string &name, const casa
 /// @return coordinate system object
 casacore::CoordinateSystem CasaImageAccess::coordSys(const std::string &name) const
 {
-    casacore::PagedImage<float> img(name);
-    return img.coordinates();
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    return img->coordinates();
 }
 casacore::CoordinateSystem CasaImageAccess::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
         const casacore::IPosition &trc) const
 {
-    casacore::Slicer slc(blc, trc, casacore::Slicer::endIsLast);
-    ASKAPLOG_INFO_STR(logger, " CasaImageAccess - Slicer " << slc);
-    casacore::PagedImage<float> img(name);
-    casacore::SubImage<casacore::Float> si = casacore::SubImage<casacore::Float>(img, slc, casacore::AxesSpecifier(casacore::True));
-    return si.coordinates();
-
-
+    return ImageView::sliceCoordSys(image(name)->coordinates(), blc, trc);
 }
+
 /// @brief obtain beam info
 /// @param[in] name image name
 /// @return beam info vector
 casacore::Vector<casacore::Quantum<double> > CasaImageAccess::beamInfo(const std::string &name) const
 {
-    casacore::PagedImage<float> img(name);
-    casacore::ImageInfo ii = img.imageInfo();
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    casacore::ImageInfo ii = img->imageInfo();
     return ii.restoringBeam().toVector();
 }
 
+/// @brief obtain per-channel beam info
+/// @details The beams are taken from the beam set of the image (for the first polarisation).
+/// @param[in] name image name
+/// @return one beam per channel, empty if the image has no per-channel beams
+IImageAccess::BeamList CasaImageAccess::beamList(const std::string &name) const
+{
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    const casacore::ImageInfo ii = img->imageInfo();
+    BeamList result;
+    if (ii.hasMultipleBeams()) {
+        const casacore::ImageBeamSet &beams = ii.getBeamSet();
+        result.resize(beams.nchan());
+        for (casacore::uInt chan = 0; chan < beams.nchan(); ++chan) {
+             result[chan] = beams.getBeam(chan, 0).toVector();
+        }
+    }
+    return result;
+}
+
 std::string CasaImageAccess::getUnits(const std::string &name) const
 {
-    casacore::Table tmpTable(name);
-    std::string units = tmpTable.keywordSet().asString("units");
-    return units;
+    return image(name)->units().getName();
 }
 
 /// @brief Get a particular keyword from the image metadata (A.K.A header)
@@ -164,8 +464,8 @@ std::string CasaImageAccess::getMetadataKeyword(const std::string &name,
         const std::string &keyword) const
 {
 
-    casacore::PagedImage<float> img(name);
-    casacore::TableRecord miscinfo = img.miscInfo();
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    casacore::TableRecord miscinfo = img->miscInfo();
     std::string value = "";
     if (miscinfo.isDefined(keyword)) {
         value = miscinfo.asString(keyword);
@@ -190,7 +490,16 @@ void CasaImageAccess::create(const std::string &name, const casacore::IPosition
                              const casacore::CoordinateSystem &csys)
 {
     ASKAPLOG_INFO_STR(logger, "Creating a new CASA image " << name << " with the shape " << shape);
-    casacore::PagedImage<float> img(casacore::TiledShape(shape), csys, name);
+    // an image with the same name kept open would be stale after this call
+    itsImages.remove(name);
+    casacore::IPosition tile = itsTileShape;
+    if (tile.nelements() == 0) {
+        tile = makeTileShape(shape, csys, itsTiling);
+    }
+    ASKAPCHECK(tile.nelements() == shape.nelements(), "Tile shape "<<tile<<" doesn't match the shape of the image "<<shape);
+    ASKAPLOG_DEBUG_STR(logger, " - tile shape " << tile);
+    boost::shared_ptr<casacore::ImageInterface<float> > img(new casacore::PagedImage<float>(casacore::TiledShape(shape, tile), csys, name));
+    itsImages.add(name, img);
 }
 
 /// @brief write full image
@@ -198,9 +507,10 @@ void CasaImageAccess::create(const std::string &name, const casacore::IPosition
 /// @param[in] arr array with pixels
 void CasaImageAccess::write(const std::string &name, const casacore::Array<float> &arr)
 {
+    const AccessTracer::Scope trace("write", name, "imageaccess");
     ASKAPLOG_INFO_STR(logger, "Writing an array with the shape " << arr.shape() << " into a CASA image " << name);
-    casacore::PagedImage<float> img(name);
-    img.put(arr);
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    img->put(arr);
 }
 
 /// @brief write a slice of an image
@@ -210,10 +520,11 @@ void CasaImageAccess::write(const std::string &name, const casacore::Array<float
 void CasaImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
                             const casacore::IPosition &where)
 {
+    const AccessTracer::Scope trace("write", name, "imageaccess");
     ASKAPLOG_INFO_STR(logger, "Writing a slice with the shape " << arr.shape() << " into a CASA image " <<
                       name << " at " << where);
-    casacore::PagedImage<float> img(name);
-    img.putSlice(arr, where);
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    img->putSlice(arr, where);
 }
 /// @brief write a slice of an image mask
 /// @param[in] name image name
@@ -224,8 +535,8 @@ void CasaImageAccess::writeMask(const std::string &name, const casacore::Array<b
 {
     ASKAPLOG_INFO_STR(logger, "Writing a slice with the shape " << mask.shape() << " into a CASA image " <<
                       name << " at " << where);
-    casacore::PagedImage<float> img(name);
-    img.pixelMask().putSlice(mask, where);
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    img->pixelMask().putSlice(mask, where);
 }
 
 /// @brief write a slice of an image mask
@@ -236,8 +547,8 @@ void CasaImageAccess::writeMask(const std::string &name, const casacore::Array<b
 {
     ASKAPLOG_INFO_STR(logger, "Writing a full mask with the shape " << mask.shape() << " into a CASA image " <<
                       name);
-    casacore::PagedImage<float> img(name);
-    img.pixelMask().put(mask);
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    img->pixelMask().put(mask);
 }
 /// @brief set brightness units of the image
 /// @details
@@ -245,8 +556,8 @@ void CasaImageAccess::writeMask(const std::string &name, const casacore::Array<b
 /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
 void CasaImageAccess::setUnits(const std::string &name, const std::string &units)
 {
-    casacore::PagedImage<float> img(name);
-    img.setUnits(casacore::Unit(units));
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    img->setUnits(casacore::Unit(units));
 }
 
 /// @brief set restoring beam info
@@ -258,10 +569,30 @@ void CasaImageAccess::setUnits(const std::string &name, const std::string &units
 /// @param[in] pa position angle in radians
 void CasaImageAccess::setBeamInfo(const std::string &name, double maj, double min, double pa)
 {
-    casacore::PagedImage<float> img(name);
-    casacore::ImageInfo ii = img.imageInfo();
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    casacore::ImageInfo ii = img->imageInfo();
     ii.setRestoringBeam(casacore::Quantity(maj, "rad"), casacore::Quantity(min, "rad"), casacore::Quantity(pa, "rad"));
-    img.setImageInfo(ii);
+    img->setImageInfo(ii);
+}
+
+/// @brief set per-channel beam info
+/// @details The beams are stored in the beam set of the image, the same beam is used for
+/// all polarisations.
+/// @param[in] name image name
+/// @param[in] beams one beam per channel
+void CasaImageAccess::setBeamList(const std::string &name, const BeamList &beams)
+{
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    const casacore::uInt nChan = nChannels(img->shape(), img->coordinates());
+    ASKAPCHECK(beams.size() == nChan, "Number of beams (" << beams.size() << ") should match the number of channels (" <<
+               nChan << ") of " << name);
+    casacore::ImageInfo ii = img->imageInfo();
+    ii.setAllBeams(nChan, 1, casacore::GaussianBeam());
+    for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+         ASKAPCHECK(beams[chan].nelements() == 3, "Beam for channel " << chan << " should have 3 elements");
+         ii.setBeam(chan, 0, casacore::GaussianBeam(beams[chan][0], beams[chan][1], beams[chan][2]));
+    }
+    img->setImageInfo(ii);
 }
 
 /// @brief apply mask to image
@@ -272,14 +603,14 @@ void CasaImageAccess::setBeamInfo(const std::string &name, double maj, double mi
 
 void CasaImageAccess::makeDefaultMask(const std::string &name)
 {
-    casacore::PagedImage<float> img(name);
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
 
     // Create a mask and make it default region.
     // need to assert sizes etc ...
-    img.makeMask("mask", casacore::True, casacore::True);
-    casacore::Array<casacore::Bool> mask(img.shape());
+    img->makeMask("mask", casacore::True, casacore::True);
+    casacore::Array<casacore::Bool> mask(img->shape());
     mask = casacore::True;
-    img.pixelMask().put(mask);
+    img->pixelMask().put(mask);
 
 }
 
@@ -294,11 +625,11 @@ void CasaImageAccess::setMetadataKeyword(const std::string &name, const std::str
         const std::string value, const std::string &desc)
 {
 
-    casacore::PagedImage<float> img(name);
-    casacore::TableRecord miscinfo = img.miscInfo();
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    casacore::TableRecord miscinfo = img->miscInfo();
     miscinfo.define(keyword, value);
     miscinfo.setComment(keyword, desc);
-    img.setMiscInfo(miscinfo);
+    img->setMiscInfo(miscinfo);
 
 }
 
@@ -309,9 +640,126 @@ void CasaImageAccess::setMetadataKeyword(const std::string &name, const std::str
 void CasaImageAccess::addHistory(const std::string &name, const std::string &history)
 {
 
-    casacore::PagedImage<float> img(name);
-    casacore::LogIO log = img.logSink();
+    const boost::shared_ptr<casacore::ImageInterface<float> > img = image(name);
+    casacore::LogIO log = img->logSink();
     log << history << casacore::LogIO::POST;
 
 }
 
+// handle management
+
+/// @brief close the given image
+/// @details The image is removed from the cache, which writes all changes to disk.
+/// @param[in] name image name
+void CasaImageAccess::close(const std::string &name)
+{
+    itsImages.remove(name);
+}
+
+/// @brief write all changes to disk
+/// @details All images in the cache are flushed, but kept open.
+void CasaImageAccess::flush()
+{
+    const std::vector<boost::shared_ptr<casacore::ImageInterface<float> > > images = itsImages.handles();
+    for (size_t i = 0; i < images.size(); ++i) {
+         images[i]->flush();
+    }
+}
+
+/// @brief read a slice with the pixel mask applied
+/// @details Pixels are read once into the output array and masked pixels are zeroed
+/// in place. Unless the mask is requested, it is read in chunks of whole tiles along
+/// the last axis, so only a small part of it is kept in memory.
+/// @param[in] img image to read
+/// @param[in] slicer selection
+/// @param[out] pixels array with pixels
+/// @param[out] mask if not NULL, the full mask of the selection is returned here
+void CasaImageAccess::readSlice(casacore::ImageInterface<float> &img, const casacore::Slicer &slicer,
+                                casacore::Array<float> &pixels, casacore::Array<bool> *mask)
+{
+    // a buffer of the right shape is filled in place
+    if (!pixels.shape().isEqual(slicer.length())) {
+        pixels.resize();
+    }
+    img.getSlice(pixels, slicer);
+    if (!img.hasPixelMask()) {
+        if (mask != NULL) {
+            mask->resize(pixels.shape());
+            mask->set(true);
+        }
+        return;
+    }
+    ASKAPLOG_INFO_STR(logger, " - setting unmasked pixels to zero");
+    if (!pixels.contiguousStorage()) {
+        pixels.reference(pixels.copy());
+    }
+    const casacore::IPosition &start = slicer.start();
+    const casacore::IPosition &length = slicer.length();
+    const size_t nPixels = pixels.nelements();
+    if (mask != NULL) {
+        mask->resize();
+        img.getMaskSlice(*mask, slicer);
+        ASKAPDEBUGASSERT(mask->nelements() == nPixels);
+        bool deleteIt;
+        const casacore::Bool *maskData = mask->getStorage(deleteIt);
+        applyMask(pixels.data(), maskData, nPixels);
+        mask->freeStorage(maskData, deleteIt);
+        return;
+    }
+    if (nPixels == 0) {
+        return;
+    }
+    // the last axis changes slowest, so a range along it is a contiguous block of pixels
+    const size_t lastAxis = length.nelements() - 1;
+    const ssize_t chunk = std::max(ssize_t(1), img.niceCursorShape()(lastAxis));
+    const size_t blockSize = nPixels / length(lastAxis);
+    casacore::Array<bool> chunkMask;
+    float *pixelData = pixels.data();
+    for (ssize_t offset = 0; offset < length(lastAxis); offset += chunk) {
+         casacore::IPosition chunkStart(start);
+         casacore::IPosition chunkLength(length);
+         chunkStart(lastAxis) += offset;
+         chunkLength(lastAxis) = std::min(chunk, length(lastAxis) - offset);
+         if (chunkMask.shape() != chunkLength) {
+             chunkMask.resize();
+         }
+         img.getMaskSlice(chunkMask, casacore::Slicer(chunkStart, chunkLength));
+         bool deleteIt;
+         const casacore::Bool *maskData = chunkMask.getStorage(deleteIt);
+         applyMask(pixelData + offset * blockSize, maskData, chunkMask.nelements());
+         chunkMask.freeStorage(maskData, deleteIt);
+    }
+}
+
+/// @brief obtain an open image
+/// @details The image is opened and added to the cache if necessary.
+/// @param[in] name image name
+/// @return shared pointer to the image
+boost::shared_ptr<casacore::ImageInterface<float> > CasaImageAccess::image(const std::string &name) const
+{
+    boost::shared_ptr<casacore::ImageInterface<float> > img = itsImages.find(name);
+    if (!img) {
+        img = openImage(name);
+        itsImages.add(name, img);
+    }
+    return img;
+}
+
+/// @brief open an image
+/// @details Paged images and virtual concatenated images (see concatenateSlabs) are supported.
+/// @param[in] name image name
+/// @return shared pointer to the image
+boost::shared_ptr<casacore::ImageInterface<float> > CasaImageAccess::openImage(const std::string &name)
+{
+    if (casacore::ImageOpener::imageType(name) != casacore::ImageOpener::IMAGECONCAT) {
+        return boost::shared_ptr<casacore::ImageInterface<float> >(new casacore::PagedImage<float>(name));
+    }
+    casacore::LatticeBase *lattice = casacore::ImageOpener::openImage(name);
+    ASKAPCHECK(lattice != NULL, "Unable to open concatenated image " << name);
+    casacore::ImageInterface<float> *img = dynamic_cast<casacore::ImageInterface<float>*>(lattice);
+    if (img == NULL) {
+        delete lattice;
+        ASKAPTHROW(AskapError, "Concatenated image " << name << " is expected to have single precision pixels");
+    }
+    return boost::shared_ptr<casacore::ImageInterface<float> >(img);
+}
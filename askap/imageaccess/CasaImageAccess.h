@@ -1,6 +1,7 @@
 /// @file CasaImageAccess.h
 /// @brief Access casa image
-/// @details This class implements IImageAccess interface for CASA image
+/// @details This class implements IImageAccess interface for CASA image.
+/// A limited number of images is kept open between calls.
 ///
 ///
 /// @copyright (c) 2007 CSIRO
@@ -32,15 +33,153 @@
 #define ASKAP_ACCESSORS_CASA_IMAGE_ACCESS_H
 
 #include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/ImageHandleCache.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+
+namespace casacore {
+template<class T> class ImageInterface;
+template<class T> class PagedImage;
+class Slicer;
+}
 
 namespace askap {
 namespace accessors {
 
 /// @brief Access casa image
-/// @details This class implements IImageAccess interface for CASA image
+/// @details This class implements IImageAccess interface for CASA image.
+/// Images are kept open in an LRU cache between calls, so a sequence of
+/// operations on the same image (e.g. writing a cube plane by plane) opens
+/// the image only once. Images are closed when they are pushed out of the
+/// cache, by close or when this object is destroyed.
+/// The tile shape of new images can be tuned for the expected access pattern
+/// (see setTiling and setTileShape), existing images can be read tile by tile
+/// with readTiles, which is the most efficient way to process the whole image.
+/// A cube can also be written by a number of ranks at once: each rank creates and writes
+/// its own slab of channels as a separate image (see createSlab), the slabs are then joined
+/// into a virtual concatenated image (see concatenateSlabs) which is read and written
+/// through this class like any other image. The virtual image can be converted into
+/// a monolithic one afterwards with merge.
 /// @ingroup imageaccess
 struct CasaImageAccess : public IImageAccess {
 
+    /// @brief constructor
+    /// @param[in] cacheSize maximum number of images kept open, zero means
+    /// that images are opened for each call
+    explicit CasaImageAccess(const size_t cacheSize = 8);
+
+    /// @brief tiling schemes of new images
+    /// @details BALANCED is the casacore default with cube-like tiles, SPECTRAL gives
+    /// tiles which are long along the spectral axis and small in the spatial domain
+    /// (fast extraction of spectra), SPATIAL gives tiles covering large parts of
+    /// a single plane (fast access to planes).
+    enum Tiling {
+        BALANCED,
+        SPECTRAL,
+        SPATIAL
+    };
+
+    /// @brief type of the function called for each tile by readTiles
+    /// @details The parameters are the pixels of the tile and the position of its
+    /// bottom left corner in the image.
+    typedef boost::function<void (const casacore::Array<float> &, const casacore::IPosition &)> TileFunction;
+
+    /// @brief set the tiling scheme for images created afterwards
+    /// @param[in] tiling tiling scheme
+    void setTiling(const Tiling tiling);
+
+    /// @brief set an explicit tile shape for images created afterwards
+    /// @details An empty shape means that the tiling scheme is used (this is the default).
+    /// The tile shape should have the same dimensions as the images created.
+    /// @param[in] tileShape tile shape
+    void setTileShape(const casacore::IPosition &tileShape);
+
+    /// @brief obtain the tile shape of an existing image
+    /// @param[in] name image name
+    /// @return tile shape used by the storage manager
+    casacore::IPosition tileShape(const std::string &name) const;
+
+    /// @brief read the image tile by tile
+    /// @details The given function is called for each tile in turn (in the storage order),
+    /// so every tile is read from disk only once and at most one tile is kept in memory.
+    /// The pixel mask is not applied.
+    /// @param[in] name image name
+    /// @param[in] func function to call for each tile
+    void readTiles(const std::string &name, const TileFunction &func) const;
+
+    /// @brief compute the tile shape for the given tiling scheme
+    /// @details The spectral and direction axes are found from the coordinate system. If
+    /// they are absent, the first two axes are assumed to be spatial and the last one 
+    /// (if there are more than two) to be spectral. Other axes (e.g. polarisation) always 
+    /// have the tile length of 1 in the SPECTRAL and SPATIAL schemes.
+    /// @param[in] shape shape of the image
+    /// @param[in] csys coordinate system of the image
+    /// @param[in] tiling tiling scheme
+    /// @return tile shape
+    static casacore::IPosition makeTileShape(const casacore::IPosition &shape,
+                   const casacore::CoordinateSystem &csys, const Tiling tiling);
+
+    /// @brief name of the image holding the given slab of a cube
+    /// @param[in] name name of the full cube
+    /// @param[in] slab slab number
+    /// @return name of the slab image
+    static std::string slabName(const std::string &name, const casacore::uInt slab);
+
+    /// @brief axis along which cubes are split into slabs
+    /// @details This is the spectral axis if the coordinate system has one and the last axis otherwise
+    /// (see IImageAccess::spectralAxis).
+    /// @param[in] shape shape of the full cube
+    /// @param[in] csys coordinate system of the full cube
+    /// @return axis number
+    static casacore::uInt slabAxis(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys);
+
+    /// @brief position of the given slab in the full cube
+    /// @details Planes are distributed between the slabs as evenly as possible, the first slabs
+    /// get one extra plane if the number of planes is not divisible by the number of slabs.
+    /// @param[in] shape shape of the full cube
+    /// @param[in] csys coordinate system of the full cube
+    /// @param[in] slab slab number
+    /// @param[in] nSlabs total number of slabs
+    /// @param[out] blc bottom left corner of the slab in the full cube
+    /// @param[out] slabShape shape of the slab
+    static void slabExtent(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys,
+                           const casacore::uInt slab, const casacore::uInt nSlabs,
+                           casacore::IPosition &blc, casacore::IPosition &slabShape);
+
+    /// @brief create a new image for a slab of a cube
+    /// @details This method is intended to be called by each rank writing a part of the cube.
+    /// The slab image has the coordinate system of its part of the cube and is written with
+    /// the usual methods using its name (see slabName) and the coordinates relative to the slab
+    /// (see slabExtent). Different ranks write different images, so no synchronisation is required.
+    /// @param[in] name name of the full cube
+    /// @param[in] shape shape of the full cube
+    /// @param[in] csys coordinate system of the full cube
+    /// @param[in] slab slab number
+    /// @param[in] nSlabs total number of slabs
+    /// @return name of the slab image
+    std::string createSlab(const std::string &name, const casacore::IPosition &shape,
+                           const casacore::CoordinateSystem &csys, const casacore::uInt slab,
+                           const casacore::uInt nSlabs);
+
+    /// @brief join slab images into a virtual cube
+    /// @details This method is called by one rank after all slabs have been created
+    /// (and all slab images have been closed by their writers). Pixels are not copied,
+    /// the cube just refers to the slab images, which therefore have to be kept. Reading
+    /// and writing of the cube is then done with the usual methods.
+    /// @param[in] name name of the full cube
+    /// @param[in] nSlabs total number of slabs
+    void concatenateSlabs(const std::string &name, const casacore::uInt nSlabs);
+
+    /// @brief copy an image into a monolithic one
+    /// @details The copy is done tile by tile and includes units, image info, miscellaneous
+    /// info and the pixel mask. This is intended to convert a virtual cube (see concatenateSlabs)
+    /// into a normal image after the job. The handle cache is not used, so the method
+    /// can be called from a background thread while this class is used to access other images.
+    /// @param[in] name name of the image to copy (e.g. the virtual cube)
+    /// @param[in] mergedName name of the new image
+    static void merge(const std::string &name, const std::string &mergedName);
+
     //////////////////
     // Reading methods
     //////////////////
@@ -63,6 +202,42 @@ struct CasaImageAccess : public IImageAccess {
     virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
                                     const casacore::IPosition &trc) const;
 
+    /// @brief read part of the image into the given buffer
+    /// @details The pixels are read directly into the buffer, which is only resized
+    /// if its shape differs from that of the selection.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill
+    virtual void read(const std::string &name, const casacore::IPosition &blc,
+                      const casacore::IPosition &trc, casacore::Array<float> &buffer) const;
+
+    /// @brief other versions of read are inherited
+    using IImageAccess::read;
+
+    /// @brief read full image together with its pixel mask
+    /// @details Pixels are returned in the same way as by read (i.e. masked pixels are
+    /// set to zero), the mask is returned as well so it doesn't have to be read again.
+    /// If the image has no pixel mask, all mask elements are set to true.
+    /// @param[in] name image name
+    /// @param[out] pixels array with pixels
+    /// @param[out] mask array with mask (true for good pixels)
+    void readWithMask(const std::string &name, casacore::Array<float> &pixels,
+                      casacore::Array<bool> &mask) const;
+
+    /// @brief read part of the image together with its pixel mask
+    /// @details Pixels are returned in the same way as by read (i.e. masked pixels are
+    /// set to zero), the mask is returned as well so it doesn't have to be read again.
+    /// If the image has no pixel mask, all mask elements are set to true.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] pixels array with pixels for the selection
+    /// @param[out] mask array with mask for the selection (true for good pixels)
+    void readWithMask(const std::string &name, const casacore::IPosition &blc,
+                      const casacore::IPosition &trc, casacore::Array<float> &pixels,
+                      casacore::Array<bool> &mask) const;
+
     /// @brief obtain coordinate system info
     /// @param[in] name image name
     /// @return coordinate system object
@@ -78,6 +253,11 @@ struct CasaImageAccess : public IImageAccess {
     /// @return beam info vector
     virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const;
 
+    /// @brief obtain per-channel beam info
+    /// @param[in] name image name
+    /// @return one beam per channel, empty if the image has no per-channel beams
+    virtual BeamList beamList(const std::string &name) const;
+
     /// @brief obtain pixel units
     /// @param[in] name image name
     /// @return units string
@@ -143,6 +323,11 @@ struct CasaImageAccess : public IImageAccess {
     /// @param[in] pa position angle in radians
     virtual void setBeamInfo(const std::string &name, double maj, double min, double pa);
 
+    /// @brief set per-channel beam info
+    /// @param[in] name image name
+    /// @param[in] beams one beam per channel
+    virtual void setBeamList(const std::string &name, const BeamList &beams);
+
     /// @brief apply mask to image
     /// @details Deteails depend upon the implemenation - CASA images will have the pixel mask assigned
     /// but FITS images will have it applied to the pixels ... which is an irreversible process
@@ -166,6 +351,60 @@ struct CasaImageAccess : public IImageAccess {
     /// @param[in] history History comment to add
     virtual void addHistory(const std::string &name, const std::string &history);
 
+    //////////////////
+    // Handle management
+    //////////////////
+
+    /// @brief close the given image
+    /// @details The image is removed from the cache, which writes all changes to disk.
+    /// @param[in] name image name
+    virtual void close(const std::string &name);
+
+    /// @brief write all changes to disk
+    /// @details All images in the cache are flushed, but kept open.
+    virtual void flush();
+
+protected:
+    /// @brief shape of the chunks the image is stored in
+    /// @details Chunks match the tiles of the image, so every tile touched by an accumulated
+    /// slice or by extracted spectra is read (and written) once.
+    /// @param[in] name image name
+    /// @param[in] imageShape shape of the image
+    /// @return tile shape of the image
+    virtual casacore::IPosition storageChunk(const std::string &name, const casacore::IPosition &imageShape) const;
+
+private:
+    /// @brief obtain an open image
+    /// @details The image is opened and added to the cache if necessary.
+    /// @param[in] name image name
+    /// @return shared pointer to the image
+    boost::shared_ptr<casacore::ImageInterface<float> > image(const std::string &name) const;
+
+    /// @brief open an image
+    /// @details Paged images and virtual concatenated images (see concatenateSlabs) are supported.
+    /// @param[in] name image name
+    /// @return shared pointer to the image
+    static boost::shared_ptr<casacore::ImageInterface<float> > openImage(const std::string &name);
+
+    /// @brief read a slice with the pixel mask applied
+    /// @details Pixels are read once into the output array and masked pixels are zeroed
+    /// in place. Unless the mask is requested, it is read in chunks of whole tiles along
+    /// the last axis, so only a small part of it is kept in memory.
+    /// @param[in] img image to read
+    /// @param[in] slicer selection
+    /// @param[out] pixels array with pixels
+    /// @param[out] mask if not NULL, the full mask of the selection is returned here
+    static void readSlice(casacore::ImageInterface<float> &img, const casacore::Slicer &slicer,
+                          casacore::Array<float> &pixels, casacore::Array<bool> *mask);
+
+    /// @brief images kept open
+    mutable ImageHandleCache<casacore::ImageInterface<float> > itsImages;
+
+    /// @brief tiling scheme of new images
+    Tiling itsTiling;
+
+    /// @brief explicit tile shape of new images (empty to use the tiling scheme)
+    casacore::IPosition itsTileShape;
 };
 
 
@@ -0,0 +1,161 @@
+/// @file
+/// @brief grouping of image cutouts for batch reads
+/// @details When many small cutouts of the same image are requested (e.g. postage stamps
+/// around sources), it is more efficient to read them in the order of their position in
+/// the file and to read overlapping or adjacent cutouts as a single bounding box. This
+/// class works out such a read plan, the actual reads are done by the caller.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/imageaccess/CutoutGrouper.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief comparison of cutouts by the position of their blc in the Fortran order
+struct FileOrder {
+   /// @brief constructor
+   /// @param[in] blc bottom left corners of the cutouts
+   explicit FileOrder(const std::vector<casacore::IPosition> &blc) : itsBlc(blc) {}
+
+   /// @brief compare two cutouts
+   /// @param[in] first index of the first cutout
+   /// @param[in] second index of the second cutout
+   /// @return true if the first cutout starts earlier in the file
+   bool operator()(size_t first, size_t second) const {
+      const casacore::IPosition &pos1 = itsBlc[first];
+      const casacore::IPosition &pos2 = itsBlc[second];
+      if (pos1.nelements() != pos2.nelements()) {
+          return pos1.nelements() < pos2.nelements();
+      }
+      for (size_t dim = pos1.nelements(); dim > 0; --dim) {
+           if (pos1[dim - 1] != pos2[dim - 1]) {
+               return pos1[dim - 1] < pos2[dim - 1];
+           }
+      }
+      return first < second;
+   }
+private:
+   /// @brief bottom left corners of the cutouts
+   const std::vector<casacore::IPosition> &itsBlc;
+};
+
+} // anonymous namespace
+
+/// @brief constructor, works out the groups
+/// @param[in] blc bottom left corners of the cutouts
+/// @param[in] trc top right corners of the cutouts (inclusive), same size as blc
+/// @param[in] maxWaste maximum ratio of the number of pixels in the bounding box of a group
+/// to the total number of pixels of its members (1 means that only cutouts exactly adjacent
+/// to each other are grouped)
+CutoutGrouper::CutoutGrouper(const std::vector<casacore::IPosition> &blc, const std::vector<casacore::IPosition> &trc,
+                             double maxWaste)
+{
+   ASKAPCHECK(blc.size() == trc.size(), "Number of blcs ("<<blc.size()<<") should match the number of trcs ("<<
+              trc.size()<<")");
+   ASKAPCHECK(maxWaste >= 1., "Maximum waste ratio should be at least 1, you have "<<maxWaste);
+   std::vector<size_t> order(blc.size());
+   for (size_t i = 0; i < order.size(); ++i) {
+        ASKAPCHECK(blc[i].nelements() == trc[i].nelements(), "Cutout "<<i<<" has blc="<<blc[i]<<
+                   " and trc="<<trc[i]<<" of different dimensions");
+        order[i] = i;
+   }
+   std::sort(order.begin(), order.end(), FileOrder(blc));
+
+   // total number of pixels in the members of the current group
+   double memberPixels = 0.;
+   for (std::vector<size_t>::const_iterator it = order.begin(); it != order.end(); ++it) {
+        const casacore::IPosition &cBlc = blc[*it];
+        const casacore::IPosition &cTrc = trc[*it];
+        const double cPixels = (cTrc - cBlc + 1).product();
+        if (itsGroups.size() && (itsGroups.back().blc.nelements() == cBlc.nelements())) {
+            Group &group = itsGroups.back();
+            // cutouts touching or overlapping the bounding box are candidates for merging
+            bool touches = true;
+            for (size_t dim = 0; dim < cBlc.nelements() && touches; ++dim) {
+                 touches = (cBlc[dim] <= group.trc[dim] + 1) && (cTrc[dim] + 1 >= group.blc[dim]);
+            }
+            if (touches) {
+                casacore::IPosition newBlc(group.blc), newTrc(group.trc);
+                for (size_t dim = 0; dim < cBlc.nelements(); ++dim) {
+                     newBlc[dim] = std::min(newBlc[dim], cBlc[dim]);
+                     newTrc[dim] = std::max(newTrc[dim], cTrc[dim]);
+                }
+                if (double((newTrc - newBlc + 1).product()) <= maxWaste * (memberPixels + cPixels)) {
+                    group.blc = newBlc;
+                    group.trc = newTrc;
+                    group.members.push_back(*it);
+                    memberPixels += cPixels;
+                    continue;
+                }
+            }
+        }
+        itsGroups.push_back(Group());
+        itsGroups.back().blc = cBlc;
+        itsGroups.back().trc = cTrc;
+        itsGroups.back().members.push_back(*it);
+        memberPixels = cPixels;
+   }
+}
+
+/// @brief extract cutouts of a group from its bounding box
+/// @details Arrays already present in the output vector are reused if their shape matches
+/// and their storage is not shared with other arrays.
+/// @param[in] group group of cutouts
+/// @param[in] box pixels of the bounding box of the group
+/// @param[in] blc bottom left corners of all cutouts
+/// @param[in] trc top right corners of all cutouts
+/// @param[out] cutouts arrays with pixels of all cutouts (only members of the group are set)
+void CutoutGrouper::extract(const Group &group, const casacore::Array<float> &box,
+                            const std::vector<casacore::IPosition> &blc, const std::vector<casacore::IPosition> &trc,
+                            std::vector<casacore::Array<float> > &cutouts)
+{
+   ASKAPDEBUGASSERT(box.shape().isEqual(group.trc - group.blc + 1));
+   for (std::vector<size_t>::const_iterator it = group.members.begin(); it != group.members.end(); ++it) {
+        ASKAPDEBUGASSERT(*it < cutouts.size());
+        // copy, so the bounding box doesn't stay in memory with the cutouts
+        const casacore::Array<float> section = box(blc[*it] - group.blc, trc[*it] - group.blc);
+        casacore::Array<float> &cutout = cutouts[*it];
+        // the array can only be reused if nothing else refers to its storage
+        if (cutout.shape().isEqual(section.shape()) && (cutout.nrefs() == 1)) {
+            cutout = section;
+        } else {
+            cutout.reference(section.copy());
+        }
+   }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,103 @@
+/// @file
+/// @brief grouping of image cutouts for batch reads
+/// @details When many small cutouts of the same image are requested (e.g. postage stamps
+/// around sources), it is more efficient to read them in the order of their position in
+/// the file and to read overlapping or adjacent cutouts as a single bounding box. This
+/// class works out such a read plan, the actual reads are done by the caller.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_CUTOUT_GROUPER_H
+#define ASKAP_ACCESSORS_CUTOUT_GROUPER_H
+
+// std includes
+#include <vector>
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief grouping of image cutouts for batch reads
+/// @details Cutouts are sorted by the position of their blc in the Fortran order (the last axis
+/// is the most significant), which is the order of pixels in FITS files and roughly the order of
+/// tiles in CASA images. Going through the sorted list, a cutout joins the current group if it
+/// overlaps with or touches the bounding box of the group and the bounding box doesn't grow beyond
+/// maxWaste times the total number of pixels of its members. Each group is then read once as its
+/// bounding box and the cutouts are extracted from it in memory.
+/// @ingroup imageaccess
+class CutoutGrouper {
+public:
+
+   /// @brief group of cutouts read together
+   struct Group {
+      /// @brief bottom left corner of the bounding box
+      casacore::IPosition blc;
+      /// @brief top right corner of the bounding box (inclusive)
+      casacore::IPosition trc;
+      /// @brief indices of the cutouts in this group
+      std::vector<size_t> members;
+   };
+
+   /// @brief constructor, works out the groups
+   /// @param[in] blc bottom left corners of the cutouts
+   /// @param[in] trc top right corners of the cutouts (inclusive), same size as blc
+   /// @param[in] maxWaste maximum ratio of the number of pixels in the bounding box of a group
+   /// to the total number of pixels of its members (1 means that only cutouts exactly adjacent
+   /// to each other are grouped)
+   CutoutGrouper(const std::vector<casacore::IPosition> &blc, const std::vector<casacore::IPosition> &trc,
+                 double maxWaste = 2.);
+
+   /// @brief groups in the order of their position in the file
+   /// @return vector of groups
+   inline const std::vector<Group>& groups() const { return itsGroups; }
+
+   /// @brief extract cutouts of a group from its bounding box
+   /// @details Arrays already present in the output vector are reused if their shape matches
+   /// and their storage is not shared with other arrays.
+   /// @param[in] group group of cutouts
+   /// @param[in] box pixels of the bounding box of the group
+   /// @param[in] blc bottom left corners of all cutouts
+   /// @param[in] trc top right corners of all cutouts
+   /// @param[out] cutouts arrays with pixels of all cutouts (only members of the group are set)
+   static void extract(const Group &group, const casacore::Array<float> &box,
+                       const std::vector<casacore::IPosition> &blc, const std::vector<casacore::IPosition> &trc,
+                       std::vector<casacore::Array<float> > &cutouts);
+
+private:
+
+   /// @brief groups of cutouts
+   std::vector<Group> itsGroups;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CUTOUT_GROUPER_H
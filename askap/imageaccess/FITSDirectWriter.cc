@@ -0,0 +1,235 @@
+/// @file FITSDirectWriter.cc
+/// @brief writer of FITS image slabs bypassing cfitsio
+/// @details This class writes pixels of an existing FITS image directly into the 
+/// data unit with positioned writes (pwrite). The file layout is obtained once via
+/// cfitsio. As each write only touches the bytes of its own slab, many processes can
+/// write disjoint parts of the same image concurrently (e.g. channel ranges of a
+/// spectral cube produced by different MPI ranks).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+#include <askap/imageaccess/FITSDirectWriter.h>
+
+#include <casacore/casa/OS/CanonicalConversion.h>
+
+#include <fitsio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".FITSDirectWriter");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief maximum number of pixels converted and written at once
+static const size_t theirMaxPixelsPerWrite = 1048576;
+
+/// @brief open the image
+/// @details The layout of the primary HDU is read with cfitsio and the file is then 
+/// opened for writing.
+/// @param[in] fullname file name (including extension)
+FITSDirectWriter::FITSDirectWriter(const std::string &fullname) : itsName(fullname), itsFD(-1), itsDataStart(0)
+{
+    fitsfile *fptr;
+    int status = 0;
+    if (fits_open_file(&fptr, fullname.c_str(), READONLY, &status)) {
+        ASKAPTHROW(AskapError, "FITSDirectWriter: Cannot open FITS file " << fullname << ", status=" << status);
+    }
+    int bitpix = 0;
+    int naxis = 0;
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    double bscale = 1., bzero = 0.;
+    fits_get_img_type(fptr, &bitpix, &status);
+    fits_get_img_dim(fptr, &naxis, &status);
+    std::vector<LONGLONG> naxes(std::max(naxis, 1), 0);
+    fits_get_img_sizell(fptr, naxis, &naxes[0], &status);
+    fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status);
+    int keyStatus = 0;
+    if (fits_read_key(fptr, TDOUBLE, "BSCALE", &bscale, NULL, &keyStatus)) {
+        bscale = 1.;
+    }
+    keyStatus = 0;
+    if (fits_read_key(fptr, TDOUBLE, "BZERO", &bzero, NULL, &keyStatus)) {
+        bzero = 0.;
+    }
+    const int layoutStatus = status;
+    status = 0;
+    fits_close_file(fptr, &status);
+    ASKAPCHECK(layoutStatus == 0, "FITSDirectWriter: Unable to read the layout of " << fullname << 
+               ", status=" << layoutStatus);
+    ASKAPCHECK(bitpix == FLOAT_IMG, "FITSDirectWriter: only 32-bit floating point images are supported, " << 
+               fullname << " has BITPIX=" << bitpix);
+    ASKAPCHECK((bscale == 1.) && (bzero == 0.), "FITSDirectWriter: scaled images are not supported");
+    itsShape.resize(naxis);
+    for (int axis = 0; axis < naxis; ++axis) {
+         itsShape(axis) = naxes[axis];
+    }
+    itsDataStart = dataStart;
+    ASKAPCHECK(dataEnd - dataStart >= LONGLONG(sizeof(float)) * LONGLONG(itsShape.product()),
+               "FITSDirectWriter: the data unit of " << fullname << " is not allocated");
+    openForWriting();
+}
+
+/// @brief open a data unit with the known layout
+/// @details This version is intended for data units of big-endian 32-bit floats
+/// stored contiguously in other containers (e.g. an HDF5 dataset allocated in full),
+/// the layout is not checked.
+/// @param[in] fullname file name (including extension)
+/// @param[in] dataStart offset of the first pixel in bytes
+/// @param[in] shape full shape of the image
+FITSDirectWriter::FITSDirectWriter(const std::string &fullname, long long dataStart,
+                                   const casacore::IPosition &shape) : itsName(fullname), itsFD(-1),
+                                   itsDataStart(dataStart), itsShape(shape)
+{
+    ASKAPCHECK(dataStart >= 0, "FITSDirectWriter: the data unit of " << fullname << " is not allocated");
+    openForWriting();
+}
+
+/// @brief open the file for writing
+void FITSDirectWriter::openForWriting()
+{
+    itsFD = open(itsName.c_str(), O_WRONLY);
+    ASKAPCHECK(itsFD >= 0, "FITSDirectWriter: Cannot open " << itsName << " for writing: " << strerror(errno));
+    ASKAPLOG_DEBUG_STR(logger, "Opened " << itsName << " for direct writing, shape " << itsShape <<
+                       ", data start at " << itsDataStart);
+}
+
+/// @brief destructor, closes the file
+FITSDirectWriter::~FITSDirectWriter()
+{
+    if (itsFD >= 0) {
+        if (::close(itsFD) != 0) {
+            ASKAPLOG_ERROR_STR(logger, "Error closing " << itsName << ": " << strerror(errno));
+        }
+    }
+}
+
+/// @brief write a slab of the image
+/// @details The array can have fewer dimensions than the image, missing trailing axes
+/// are assumed to be degenerate.
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slab to (trc is deduced from the array shape)
+void FITSDirectWriter::write(const casacore::Array<float> &arr, const casacore::IPosition &where)
+{
+    const size_t nDim = itsShape.nelements();
+    ASKAPCHECK(where.nelements() == nDim, "Mismatch in dimensions - FITS file has " << nDim <<
+               " axes, while requested location has " << where.nelements());
+    ASKAPCHECK(arr.ndim() <= nDim, "Array with " << arr.ndim() << " dimensions can't be written into " << 
+               nDim << "-dimensional image");
+    casacore::IPosition arrShape(nDim, 1);
+    for (size_t axis = 0; axis < arr.ndim(); ++axis) {
+         arrShape(axis) = arr.shape()(axis);
+    }
+    for (size_t axis = 0; axis < nDim; ++axis) {
+         ASKAPCHECK((where(axis) >= 0) && (where(axis) + arrShape(axis) <= itsShape(axis)),
+                    "Slab with the shape " << arrShape << " at " << where << " doesn't fit into the image " << itsShape);
+    }
+    if (arr.nelements() == 0) {
+        return;
+    }
+    // the leading axes which are covered in full give a contiguous run of pixels in the file
+    size_t runAxis = 0;
+    while ((runAxis + 1 < nDim) && (arrShape(runAxis) == itsShape(runAxis))) {
+        ++runAxis;
+    }
+    size_t runLength = 1;
+    for (size_t axis = 0; axis <= runAxis; ++axis) {
+         runLength *= arrShape(axis);
+    }
+    const size_t nRuns = arr.nelements() / runLength;
+    ASKAPDEBUGASSERT(nRuns * runLength == arr.nelements());
+
+    bool deleteIt = false;
+    const float *data = arr.getStorage(deleteIt);
+    std::vector<char> buffer(sizeof(float) * std::min(runLength, theirMaxPixelsPerWrite));
+    casacore::IPosition pos(nDim, 0);
+    try {
+       for (size_t run = 0; run < nRuns; ++run) {
+            long long offset = 0;
+            long long stride = 1;
+            for (size_t axis = 0; axis < nDim; ++axis) {
+                 offset += (where(axis) + pos(axis)) * stride;
+                 stride *= itsShape(axis);
+            }
+            const float *runData = data + run * runLength;
+            for (size_t done = 0; done < runLength; done += theirMaxPixelsPerWrite) {
+                 const size_t nPixels = std::min(runLength - done, theirMaxPixelsPerWrite);
+                 casacore::CanonicalConversion::fromLocal(&buffer[0], runData + done, nPixels);
+                 writeBytes(&buffer[0], sizeof(float) * nPixels, 
+                            itsDataStart + static_cast<long long>(sizeof(float)) * (offset + done));
+            }
+            // advance to the next run
+            for (size_t axis = runAxis + 1; axis < nDim; ++axis) {
+                 if (++pos(axis) < arrShape(axis)) {
+                     break;
+                 }
+                 pos(axis) = 0;
+            }
+       }
+    }
+    catch (...) {
+       arr.freeStorage(data, deleteIt);
+       throw;
+    }
+    arr.freeStorage(data, deleteIt);
+}
+
+/// @brief flush written data to disk
+/// @details Writes are not buffered by this class, this method forces them to be stored
+/// on disk (fsync).
+void FITSDirectWriter::flush()
+{
+    ASKAPCHECK(fsync(itsFD) == 0, "FITSDirectWriter: fsync failed for " << itsName << ": " << strerror(errno));
+}
+
+/// @brief write a buffer at the given position
+/// @details Partial and interrupted writes are continued, an exception is thrown on error.
+/// @param[in] buf pointer to the data
+/// @param[in] size number of bytes to write
+/// @param[in] offset position in the file in bytes
+void FITSDirectWriter::writeBytes(const char *buf, size_t size, long long offset) const
+{
+    while (size > 0) {
+        const ssize_t written = pwrite(itsFD, buf, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            ASKAPCHECK(errno == EINTR, "FITSDirectWriter: write to " << itsName << " failed: " << strerror(errno));
+            continue;
+        }
+        buf += written;
+        size -= static_cast<size_t>(written);
+        offset += written;
+    }
+}
@@ -0,0 +1,124 @@
+/// @file FITSDirectWriter.h
+/// @brief writer of FITS image slabs bypassing cfitsio
+/// @details This class writes pixels of an existing FITS image directly into the 
+/// data unit with positioned writes (pwrite). The file layout is obtained once via
+/// cfitsio. As each write only touches the bytes of its own slab, many processes can
+/// write disjoint parts of the same image concurrently (e.g. channel ranges of a
+/// spectral cube produced by different MPI ranks).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_FITS_DIRECT_WRITER_H
+#define ASKAP_ACCESSORS_FITS_DIRECT_WRITER_H
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <boost/utility.hpp>
+
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief writer of FITS image slabs bypassing cfitsio
+/// @details The image must exist and its data unit must be allocated in full (see
+/// FITSImageRW::preallocate), only 32-bit floating point images without scaling are supported.
+/// Pixels are converted to the big-endian representation and written with pwrite, one call for 
+/// each contiguous run of pixels in the file (a whole slab of planes is a single run if the 
+/// array covers the full extent of the leading axes). There is no state shared between 
+/// writers other than the file itself, so disjoint slabs can be written by different processes
+/// at the same time. Header keywords must not be changed while writers are active as this 
+/// may move the data unit.
+/// @ingroup imageaccess
+class FITSDirectWriter : private boost::noncopyable {
+public:
+    /// @brief open the image
+    /// @details The layout of the primary HDU is read with cfitsio and the file is then 
+    /// opened for writing.
+    /// @param[in] fullname file name (including extension)
+    explicit FITSDirectWriter(const std::string &fullname);
+
+    /// @brief open a data unit with the known layout
+    /// @details This version is intended for data units of big-endian 32-bit floats
+    /// stored contiguously in other containers (e.g. an HDF5 dataset allocated in full),
+    /// the layout is not checked.
+    /// @param[in] fullname file name (including extension)
+    /// @param[in] dataStart offset of the first pixel in bytes
+    /// @param[in] shape full shape of the image
+    FITSDirectWriter(const std::string &fullname, long long dataStart, const casacore::IPosition &shape);
+
+    /// @brief destructor, closes the file
+    ~FITSDirectWriter();
+
+    /// @brief write a slab of the image
+    /// @details The array can have fewer dimensions than the image, missing trailing axes
+    /// are assumed to be degenerate.
+    /// @param[in] arr array with pixels
+    /// @param[in] where bottom left corner where to put the slab to (trc is deduced from the array shape)
+    void write(const casacore::Array<float> &arr, const casacore::IPosition &where);
+
+    /// @brief flush written data to disk
+    /// @details Writes are not buffered by this class, this method forces them to be stored
+    /// on disk (fsync).
+    void flush();
+
+    /// @brief shape of the image
+    /// @return full shape
+    const casacore::IPosition& shape() const { return itsShape; }
+
+    /// @brief offset of the data unit
+    /// @return offset of the first pixel in bytes from the start of the file
+    long long dataStart() const { return itsDataStart; }
+
+private:
+    /// @brief open the file for writing
+    void openForWriting();
+
+    /// @brief write a buffer at the given position
+    /// @details Partial and interrupted writes are continued, an exception is thrown on error.
+    /// @param[in] buf pointer to the data
+    /// @param[in] size number of bytes to write
+    /// @param[in] offset position in the file in bytes
+    void writeBytes(const char *buf, size_t size, long long offset) const;
+
+    /// @brief file name
+    std::string itsName;
+
+    /// @brief file descriptor
+    int itsFD;
+
+    /// @brief offset of the data unit in bytes
+    long long itsDataStart;
+
+    /// @brief shape of the image
+    casacore::IPosition itsShape;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
@@ -0,0 +1,194 @@
+/// @file FITSHeaderReader.cc
+/// @brief parsed header of a FITS image
+/// @details This class reads the header of a FITS image once with cfitsio and keeps
+/// the keywords, so metadata queries don't need to open the file again. The coordinate
+/// system is only built when it is requested, which is the expensive part of the header
+/// processing done by casacore::FITSImage.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+#include <askap/imageaccess/FITSHeaderReader.h>
+
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Logging/LogIO.h>
+#include <casacore/images/Images/ImageFITSConverter.h>
+
+#include <fitsio.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <vector>
+
+ASKAP_LOGGER(logger, ".FITSHeaderReader");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief convert a keyword name to upper case
+/// @param[in] keyword keyword name
+/// @return upper case name
+static std::string upperCase(const std::string &keyword)
+{
+    std::string result(keyword);
+    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+    return result;
+}
+
+/// @brief obtain the value of a string keyword
+/// @details Enclosing quotes and trailing blanks are removed, doubled quotes are replaced
+/// by single ones (as cfitsio does it). Other values are returned as they are.
+/// @param[in] value value as given in the header card
+/// @return unquoted value
+static std::string unquote(const std::string &value)
+{
+    if ((value.size() < 2) || (value[0] != '\'') || (value[value.size() - 1] != '\'')) {
+        return value;
+    }
+    std::string result;
+    for (size_t i = 1; i + 1 < value.size(); ++i) {
+         result += value[i];
+         if ((value[i] == '\'') && (value[i + 1] == '\'')) {
+             ++i;
+         }
+    }
+    const size_t last = result.find_last_not_of(' ');
+    result.erase(last == std::string::npos ? 0 : last + 1);
+    return result;
+}
+
+/// @brief read the header
+/// @param[in] fullname file name (including extension)
+FITSHeaderReader::FITSHeaderReader(const std::string &fullname) : itsName(fullname)
+{
+    fitsfile *fptr = NULL;
+    int status = 0;
+    // this opens the first HDU with an image, so tile-compressed images are supported
+    if (fits_open_image(&fptr, fullname.c_str(), READONLY, &status)) {
+        ASKAPTHROW(AskapError, "FITSHeaderReader: Cannot open FITS file " << fullname << ", status=" << status);
+    }
+    int naxis = 0;
+    fits_get_img_dim(fptr, &naxis, &status);
+    std::vector<LONGLONG> naxes(naxis > 0 ? naxis : 1, 0);
+    fits_get_img_sizell(fptr, naxis, &naxes[0], &status);
+    char *header = NULL;
+    int nCards = 0;
+    // for compressed images this gives the header of the equivalent uncompressed image
+    fits_convert_hdr2str(fptr, 0, NULL, 0, &header, &nCards, &status);
+    const int readStatus = status;
+    status = 0;
+    fits_close_file(fptr, &status);
+    if (readStatus != 0) {
+        if (header != NULL) {
+            fits_free_memory(header, &status);
+        }
+        ASKAPTHROW(AskapError, "FITSHeaderReader: Unable to read the header of " << fullname <<
+                   ", status=" << readStatus);
+    }
+    itsShape.resize(naxis);
+    for (int axis = 0; axis < naxis; ++axis) {
+         itsShape(axis) = naxes[axis];
+    }
+
+    std::vector<casacore::String> cards;
+    cards.reserve(nCards);
+    for (int card = 0; card < nCards; ++card) {
+         const std::string text(header + 80 * card, 80);
+         const std::string name = text.substr(0, text.find_first_of(" =")).substr(0, 8);
+         if (name == "END") {
+             break;
+         }
+         cards.push_back(text);
+         if (name.empty() || (name == "COMMENT") || (name == "HISTORY") || (text.compare(8, 2, "= ") != 0)) {
+             continue;
+         }
+         char value[FLEN_VALUE];
+         char comment[FLEN_COMMENT];
+         status = 0;
+         if (fits_parse_value(const_cast<char*>(text.c_str()), value, comment, &status) == 0) {
+             itsKeywords[upperCase(name)] = unquote(value);
+         }
+    }
+    status = 0;
+    fits_free_memory(header, &status);
+    itsCards.resize(cards.size());
+    for (size_t card = 0; card < cards.size(); ++card) {
+         itsCards[card] = cards[card];
+    }
+    ASKAPLOG_DEBUG_STR(logger, "Read " << cards.size() << " header cards of " << fullname << ", shape " << itsShape);
+}
+
+/// @brief check whether the keyword is present
+/// @param[in] keyword keyword name (case insensitive)
+/// @return true if the header has this keyword
+bool FITSHeaderReader::hasKeyword(const std::string &keyword) const
+{
+    return itsKeywords.find(upperCase(keyword)) != itsKeywords.end();
+}
+
+/// @brief obtain the value of a keyword
+/// @param[in] keyword keyword name (case insensitive)
+/// @return value of the keyword as a string (empty string if the keyword is absent)
+std::string FITSHeaderReader::keyword(const std::string &keyword) const
+{
+    const std::map<std::string, std::string>::const_iterator it = itsKeywords.find(upperCase(keyword));
+    return it == itsKeywords.end() ? std::string() : it->second;
+}
+
+/// @brief obtain the coordinate system
+/// @details The coordinate system is built on the first call.
+/// @return coordinate system of the image
+const casacore::CoordinateSystem& FITSHeaderReader::coordSys() const
+{
+    if (!itsCoordSys) {
+        casacore::Int stokesFITSValue = -1;
+        casacore::Record unused;
+        casacore::LogIO os;
+        // the shape may be extended with degenerate axes, as done by casacore::FITSImage
+        casacore::IPosition shape(itsShape);
+        itsCoordSys.reset(new casacore::CoordinateSystem(casacore::ImageFITSConverter::getCoordinateSystem(
+                          stokesFITSValue, unused, itsCards, os, 0, shape, false)));
+    }
+    return *itsCoordSys;
+}
+
+/// @brief obtain the restoring beam
+/// @return major axis, minor axis and position angle (from BMAJ, BMIN and BPA), all
+/// zero if the header has no beam
+casacore::Vector<casacore::Quantum<double> > FITSHeaderReader::beam() const
+{
+    casacore::Vector<casacore::Quantum<double> > result(3, casacore::Quantum<double>(0., "deg"));
+    if (hasKeyword("BMAJ") && hasKeyword("BMIN")) {
+        result[0] = casacore::Quantum<double>(std::atof(keyword("BMAJ").c_str()), "deg");
+        result[1] = casacore::Quantum<double>(std::atof(keyword("BMIN").c_str()), "deg");
+        result[2] = casacore::Quantum<double>(std::atof(keyword("BPA").c_str()), "deg");
+    }
+    return result;
+}
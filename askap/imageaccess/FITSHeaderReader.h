@@ -0,0 +1,112 @@
+/// @file FITSHeaderReader.h
+/// @brief parsed header of a FITS image
+/// @details This class reads the header of a FITS image once with cfitsio and keeps
+/// the keywords, so metadata queries don't need to open the file again. The coordinate
+/// system is only built when it is requested, which is the expensive part of the header
+/// processing done by casacore::FITSImage.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_FITS_HEADER_READER_H
+#define ASKAP_ACCESSORS_FITS_HEADER_READER_H
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Quanta/Quantum.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include <map>
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief parsed header of a FITS image
+/// @details The header of the first HDU with an image (the primary one unless the image is
+/// tile-compressed, in which case the header of the equivalent uncompressed image is used) is
+/// read by the constructor and the file is closed straight away, so many headers can be kept
+/// without holding file descriptors. Keyword values are stored as strings (quotes and trailing
+/// blanks are removed from string values), COMMENT and HISTORY cards are not kept as keywords.
+/// The coordinate system is built from the header cards on the first call to coordSys, in the
+/// same way as casacore::FITSImage does it, and is cached afterwards.
+/// @note The object reflects the file at the time of construction, it should be discarded
+/// when the file changes.
+/// @ingroup imageaccess
+class FITSHeaderReader : private boost::noncopyable {
+public:
+    /// @brief read the header
+    /// @param[in] fullname file name (including extension)
+    explicit FITSHeaderReader(const std::string &fullname);
+
+    /// @brief shape of the image
+    /// @return full shape
+    const casacore::IPosition& shape() const { return itsShape; }
+
+    /// @brief check whether the keyword is present
+    /// @param[in] keyword keyword name (case insensitive)
+    /// @return true if the header has this keyword
+    bool hasKeyword(const std::string &keyword) const;
+
+    /// @brief obtain the value of a keyword
+    /// @param[in] keyword keyword name (case insensitive)
+    /// @return value of the keyword as a string (empty string if the keyword is absent)
+    std::string keyword(const std::string &keyword) const;
+
+    /// @brief obtain the coordinate system
+    /// @details The coordinate system is built on the first call.
+    /// @return coordinate system of the image
+    const casacore::CoordinateSystem& coordSys() const;
+
+    /// @brief obtain the restoring beam
+    /// @return major axis, minor axis and position angle (from BMAJ, BMIN and BPA), all
+    /// zero if the header has no beam
+    casacore::Vector<casacore::Quantum<double> > beam() const;
+
+private:
+    /// @brief file name
+    std::string itsName;
+
+    /// @brief shape of the image
+    casacore::IPosition itsShape;
+
+    /// @brief header cards (80 characters each), needed to build the coordinate system
+    casacore::Vector<casacore::String> itsCards;
+
+    /// @brief keyword values by upper case keyword name
+    std::map<std::string, std::string> itsKeywords;
+
+    /// @brief coordinate system (built on demand)
+    mutable boost::scoped_ptr<casacore::CoordinateSystem> itsCoordSys;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
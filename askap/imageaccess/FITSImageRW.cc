@@ -42,9 +42,14 @@
 #include <casacore/casa/Quanta/MVTime.h>
 #include <askap/imageaccess/FITSImageRW.h>
 
+#include <boost/bind.hpp>
+
 #include <fitsio.h>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 ASKAP_LOGGER(FITSlogger, ".FITSImageRW");
 
@@ -68,12 +73,44 @@ void printerror(int status)
 using namespace askap;
 using namespace askap::accessors;
 
-FITSImageRW::FITSImageRW(const std::string &name)
+/// @brief add free card slots to the header
+/// @details cfitsio treats blank cards preceding END as free space for new keywords.
+/// @param[in] cards header cards (80 characters each) including END and the padding
+/// @param[in] nReserve number of blank cards to add before END
+/// @return header padded to a whole number of 2880-byte blocks
+static std::string reserveHeaderSpace(const std::string &cards, int nReserve)
+{
+    const std::string blank(80, ' ');
+    std::string result;
+    for (size_t pos = 0; pos + 80 <= cards.size(); pos += 80) {
+         const std::string card = cards.substr(pos, 80);
+         if (card.compare(0, 8, "END     ") == 0) {
+             break;
+         }
+         result += card;
+    }
+    // trailing blank cards already there are free space as well
+    while ((result.size() >= 80) && (result.compare(result.size() - 80, 80, blank) == 0)) {
+           result.erase(result.size() - 80);
+    }
+    for (int card = 0; card < nReserve; ++card) {
+         result += blank;
+    }
+    result += "END" + std::string(77, ' ');
+    while (result.size() % 2880 != 0) {
+           result += blank;
+    }
+    return result;
+}
+
+FITSImageRW::FITSImageRW(const std::string &name) : itsFptr(NULL), itsCompression(0),
+        itsQuantizeLevel(4.f), itsHeaderReserve(100), itsBatchUpdate(false)
 {
     std::string fullname = name + ".fits";
     this->name = std::string(name.c_str());
 }
-FITSImageRW::FITSImageRW()
+FITSImageRW::FITSImageRW() : itsFptr(NULL), itsCompression(0), itsQuantizeLevel(4.f),
+        itsHeaderReserve(100), itsBatchUpdate(false)
 {
 
 }
@@ -88,6 +125,8 @@ bool FITSImageRW::create(const std::string &name, const casacore::IPosition &sha
 
     std::string fullname = name + ".fits";
 
+    // the file is about to be replaced
+    close();
     this->name = std::string(fullname.c_str());
     this->shape = shape;
     this->csys = csys;
@@ -265,20 +304,25 @@ bool FITSImageRW::create(const std::string &name, const casacore::IPosition &sha
     const size_t cards_size = 2880 * 4;
     char cards[cards_size];
     memset(cards, 0, sizeof(cards));
+    // the compressed image is set up by cfitsio, only the cards are needed in this case
+    std::ostringstream cardBuffer;
     while (1) {
         if (m_kc.build(cards, theKeywordList)) {
 
-            outfile << cards;
+            cardBuffer << cards;
             memset(cards, 0, sizeof(cards));
         } else {
             if (cards[0] != 0) {
-                outfile << cards;
+                cardBuffer << cards;
             }
             break;
         }
 
     }
-    // outfile << cards;
+    if (itsCompression == 0) {
+        // free slots for keywords added later, so the data unit never has to be shifted
+        outfile << reserveHeaderSpace(cardBuffer.str(), itsHeaderReserve);
+    }
     ASKAPLOG_INFO_STR(FITSlogger, "All keywords added to file");
     try {
       outfile.close();
@@ -288,6 +332,13 @@ bool FITSImageRW::create(const std::string &name, const casacore::IPosition &sha
       ASKAPLOG_WARN_STR(FITSlogger, "Failed to properly close outfile");
       return false;
     }
+    if (itsCompression != 0) {
+        std::vector<long> naxes(naxis.nelements());
+        for (casacore::uInt j = 0; j < naxis.nelements(); j++) {
+            naxes[j] = naxis(j);
+        }
+        createCompressed(naxes, cardBuffer.str());
+    }
 
 
 
@@ -336,7 +387,7 @@ void FITSImageRW::print_hdr()
 bool FITSImageRW::write(const casacore::Array<float> &arr)
 {
     ASKAPLOG_INFO_STR(FITSlogger, "Writing array to FITS image");
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    fitsfile *fptr = openFile();
 
 
     int status;
@@ -344,9 +395,6 @@ bool FITSImageRW::write(const casacore::Array<float> &arr)
 
     status = 0;
 
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
-
     long fpixel = 1;                               /* first pixel to write      */
     size_t nelements = arr.nelements();          /* number of pixels to write */
     bool deleteIt;
@@ -357,9 +405,6 @@ bool FITSImageRW::write(const casacore::Array<float> &arr)
     if (fits_write_img(fptr, TFLOAT, fpixel, nelements, dataptr, &status))
         printerror(status);
 
-    if (fits_close_file(fptr, &status))
-        printerror(status);
-
     return true;
 }
 
@@ -367,19 +412,13 @@ bool FITSImageRW::write(const casacore::Array<float> &arr)
 bool FITSImageRW::write(const casacore::Array<float> &arr, const casacore::IPosition &where)
 {
     ASKAPLOG_INFO_STR(FITSlogger, "Writing array to FITS image at (Cindex)" << where);
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    fitsfile *fptr = openFile();
 
-    int status, hdutype;
+    int status;
 
 
     status = 0;
 
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
-
-    if (fits_movabs_hdu(fptr, 1, &hdutype, &status))
-        printerror(status);
-
     // get the dimensionality & size of the fits file.
     int naxes;
     if (fits_get_img_dim(fptr, &naxes, &status)) {
@@ -394,51 +433,16 @@ bool FITSImageRW::write(const casacore::Array<float> &arr, const casacore::IPosi
                "Mismatch in dimensions - FITS file has " << naxes
                << " axes, while requested location has " << where.nelements());
 
-    long fpixel[4], lpixel[4];
-    int array_dim = arr.shape().nelements();
-    int location_dim = where.nelements();
-    ASKAPLOG_INFO_STR(FITSlogger, "There are " << array_dim << " dimensions in the slice");
-    ASKAPLOG_INFO_STR(FITSlogger," There are " << location_dim << " dimensions in the place");
-
-    fpixel[0] = where[0] + 1;
-    lpixel[0] = where[0] + arr.shape()[0];
-    ASKAPLOG_INFO_STR(FITSlogger, "fpixel[0] = " << fpixel[0] << ", lpixel[0] = " << lpixel[0]);
-    fpixel[1] = where[1] + 1;
-    lpixel[1] = where[1] + arr.shape()[1];
-    ASKAPLOG_INFO_STR(FITSlogger, "fpixel[1] = " << fpixel[1] << ", lpixel[1] = " << lpixel[1]);
-
-    if (array_dim == 2 && location_dim == 3) {
-        ASKAPLOG_INFO_STR(FITSlogger,"Writing a single slice into an array");
-        fpixel[2] = where[2] + 1;
-        lpixel[2] = where[2] + 1;
-//        lpixel[2] = where[2] + arr.shape()[2];
-        ASKAPLOG_INFO_STR(FITSlogger, "fpixel[2] = " << fpixel[2] << ", lpixel[2] = " << lpixel[2]);
-    }
-    else if (array_dim == 3 && location_dim == 3) {
-        ASKAPLOG_INFO_STR(FITSlogger,"Writing more than 1 slice into the array");
-        fpixel[2] = where[2] + 1;
-        lpixel[2] = where[2] + arr.shape()[2];
-        ASKAPLOG_INFO_STR(FITSlogger, "fpixel[2] = " << fpixel[2] << ", lpixel[2] = " << lpixel[2]);
-    }
-    else if (array_dim == 3 && location_dim == 4) {
-        fpixel[2] = where[2] + 1;
-        lpixel[2] = where[2] + arr.shape()[2];
-        fpixel[3] = where[3] + 1;
-        // lpixel[3] = where[3] + arr.shape()[3];
-        lpixel[3] = where[3] + 1;
-        ASKAPLOG_INFO_STR(FITSlogger, "fpixel[2] = " << fpixel[2] << ", lpixel[2] = " << lpixel[2]);
-        ASKAPLOG_INFO_STR(FITSlogger, "fpixel[3] = " << fpixel[3] << ", lpixel[3] = " << lpixel[3]);
-    }
-    else if (array_dim == 4 && location_dim == 4) {
-
-        fpixel[2] = where[2] + 1;
-        lpixel[2] = where[2] + arr.shape()[2];
-        fpixel[3] = where[3] + 1;
-        lpixel[3] = where[3] + arr.shape()[3];
-
-        ASKAPLOG_INFO_STR(FITSlogger, "fpixel[2] = " << fpixel[2] << ", lpixel[2] = " << lpixel[2]);
-        ASKAPLOG_INFO_STR(FITSlogger, "fpixel[3] = " << fpixel[3] << ", lpixel[3] = " << lpixel[3]);
+    // axes missing in the array are degenerate
+    const int array_dim = arr.shape().nelements();
+    ASKAPCHECK(array_dim <= naxes, "Array with " << array_dim << " dimensions can't be written into " <<
+               naxes << "-dimensional image");
+    std::vector<long> fpixel(naxes), lpixel(naxes);
+    for (int dim = 0; dim < naxes; ++dim) {
+         fpixel[dim] = where[dim] + 1;
+         lpixel[dim] = where[dim] + (dim < array_dim ? arr.shape()[dim] : 1);
     }
+    ASKAPLOG_DEBUG_STR(FITSlogger, "There are " << array_dim << " dimensions in the slice");
 
 
     int64_t nelements = arr.nelements();          /* number of pixels to write */
@@ -456,107 +460,301 @@ bool FITSImageRW::write(const casacore::Array<float> &arr, const casacore::IPosi
     status = 0;
     long group = 0;
 
-    if (fits_write_subset_flt(fptr, group, naxes, axes, fpixel, lpixel, dataptr, &status))
+    if (fits_write_subset_flt(fptr, group, naxes, axes, &fpixel[0], &lpixel[0], dataptr, &status))
         printerror(status);
 
     ASKAPLOG_INFO_STR(FITSlogger, "Written " << nelements << " elements");
-    status = 0;
-
-    if (fits_close_file(fptr, &status))
-        printerror(status);
 
     delete [] axes;
 
     return true;
 
 }
+/// @brief member function pointers for binding the overloaded writeKeyword
+typedef void (FITSImageRW::*StringKeywordWriter)(const std::string &, const std::string &, const std::string &);
+typedef void (FITSImageRW::*DoubleKeywordWriter)(const std::string &, double, const std::string &);
+
 void FITSImageRW::setUnits(const std::string &units)
 {
     ASKAPLOG_INFO_STR(FITSlogger, "Updating brightness units");
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    updateHeader(boost::bind(static_cast<StringKeywordWriter>(&FITSImageRW::writeKeyword), this,
+                             std::string("BUNIT"), units, std::string("Brightness (pixel) unit")));
+}
+
+void FITSImageRW::setHeader(const std::string &keyword, const std::string &value, const std::string &desc)
+{
+    ASKAPLOG_INFO_STR(FITSlogger, "Setting header value for " << keyword);
+    updateHeader(boost::bind(static_cast<StringKeywordWriter>(&FITSImageRW::writeKeyword), this,
+                             keyword, value, desc));
+}
+
+void FITSImageRW::setRestoringBeam(double maj, double min, double pa)
+{
+    ASKAPLOG_INFO_STR(FITSlogger, "Setting Beam info");
+    double radtodeg = 360. / (2 * M_PI);
+    const DoubleKeywordWriter writer = &FITSImageRW::writeKeyword;
+    updateHeader(boost::bind(writer, this, std::string("BMAJ"), radtodeg * maj,
+                             std::string("Restoring beam major axis")));
+    updateHeader(boost::bind(writer, this, std::string("BMIN"), radtodeg * min,
+                             std::string("Restoring beam minor axis")));
+    updateHeader(boost::bind(writer, this, std::string("BPA"), radtodeg * pa,
+                             std::string("Restoring beam position angle")));
+    updateHeader(boost::bind(static_cast<StringKeywordWriter>(&FITSImageRW::writeKeyword), this,
+                             std::string("BTYPE"), std::string("Intensity"), std::string(" ")));
+}
+
+void FITSImageRW::setBeams(const std::vector<casacore::Vector<casacore::Quantum<double> > > &beams)
+{
+    ASKAPLOG_INFO_STR(FITSlogger, "Writing " << beams.size() << " beams into the BEAMS table");
+    fitsfile *fptr = openFile();
     int status = 0;
+    int imageHDU = 1;
+    fits_get_hdu_num(fptr, &imageHDU);
 
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
+    // replace the existing table
+    if (fits_movnam_hdu(fptr, BINARY_TBL, const_cast<char*>("BEAMS"), 0, &status) == 0) {
+        if (fits_delete_hdu(fptr, NULL, &status))
+            printerror(status);
+    } else {
+        status = 0;
+    }
+    int nHDU = 0;
+    if (fits_get_num_hdus(fptr, &nHDU, &status))
         printerror(status);
-
-    if (fits_update_key(fptr, TSTRING, "BUNIT", (void *)(units.c_str()),
-                        "Brightness (pixel) unit", &status))
+    if (fits_movabs_hdu(fptr, nHDU, NULL, &status))
         printerror(status);
 
-    if (fits_close_file(fptr, &status))
+    const char *ttype[] = {"BMAJ", "BMIN", "BPA", "CHAN", "POL"};
+    const char *tform[] = {"1E", "1E", "1E", "1J", "1J"};
+    const char *tunit[] = {"arcsec", "arcsec", "deg", "", ""};
+    const LONGLONG nRows = beams.size();
+    if (fits_create_tbl(fptr, BINARY_TBL, nRows, 5, const_cast<char**>(ttype), const_cast<char**>(tform),
+                        const_cast<char**>(tunit), "BEAMS", &status))
+        printerror(status);
+    int nChan = beams.size();
+    int nPol = 1;
+    if (fits_update_key(fptr, TINT, "NCHAN", &nChan, "Number of channels", &status))
         printerror(status);
+    if (fits_update_key(fptr, TINT, "NPOL", &nPol, "Number of polarisations", &status))
+        printerror(status);
+    if (nRows > 0) {
+        std::vector<float> bmaj(nRows), bmin(nRows), bpa(nRows);
+        std::vector<int> chan(nRows), pol(nRows, 0);
+        for (LONGLONG row = 0; row < nRows; ++row) {
+             ASKAPCHECK(beams[row].nelements() == 3, "Beam for channel " << row << " should have 3 elements");
+             bmaj[row] = beams[row][0].getValue("arcsec");
+             bmin[row] = beams[row][1].getValue("arcsec");
+             bpa[row] = beams[row][2].getValue("deg");
+             chan[row] = row;
+        }
+        if (fits_write_col(fptr, TFLOAT, 1, 1, 1, nRows, &bmaj[0], &status) ||
+            fits_write_col(fptr, TFLOAT, 2, 1, 1, nRows, &bmin[0], &status) ||
+            fits_write_col(fptr, TFLOAT, 3, 1, 1, nRows, &bpa[0], &status) ||
+            fits_write_col(fptr, TINT, 4, 1, 1, nRows, &chan[0], &status) ||
+            fits_write_col(fptr, TINT, 5, 1, 1, nRows, &pol[0], &status))
+            printerror(status);
+    }
 
+    // back to the image
+    if (fits_movabs_hdu(fptr, imageHDU, NULL, &status))
+        printerror(status);
+    int multipleBeams = 1;
+    if (fits_update_key(fptr, TLOGICAL, "CASAMBM", &multipleBeams, "Multiple beams in BEAMS table", &status))
+        printerror(status);
 }
 
-void FITSImageRW::setHeader(const std::string &keyword, const std::string &value, const std::string &desc)
+void FITSImageRW::addHistory(const std::string &history)
 {
-    ASKAPLOG_INFO_STR(FITSlogger, "Setting header value for " << keyword);
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    int status = 0;
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
 
+    ASKAPLOG_INFO_STR(FITSlogger,"Adding HISTORY string: " << history);
+    updateHeader(boost::bind(&FITSImageRW::writeHistory, this, history));
 
-    if (fits_update_key(fptr, TSTRING, keyword.c_str(), (char *)value.c_str(),
-                        desc.c_str(), &status))
-        printerror(status);
+}
 
-    if (fits_close_file(fptr, &status))
-        printerror(status);
+void FITSImageRW::beginHeaderUpdate()
+{
+    itsBatchUpdate = true;
+}
 
+void FITSImageRW::commitHeaderUpdate()
+{
+    if (itsBatchUpdate) {
+        itsBatchUpdate = false;
+        ASKAPLOG_INFO_STR(FITSlogger, "Applying " << itsPendingUpdates.size() << " header updates to " << this->name);
+        flush();
+    }
+}
 
+void FITSImageRW::updateHeader(const boost::function<void()> &update)
+{
+    if (itsBatchUpdate) {
+        itsPendingUpdates.push_back(update);
+    } else {
+        update();
+    }
 }
 
-void FITSImageRW::setRestoringBeam(double maj, double min, double pa)
+void FITSImageRW::applyPendingUpdates()
 {
-    ASKAPLOG_INFO_STR(FITSlogger, "Setting Beam info");
-    ASKAPLOG_INFO_STR(FITSlogger, "Updating brightness units");
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    // the updates are removed first, so an error doesn't make them being applied again
+    std::vector<boost::function<void()> > updates;
+    updates.swap(itsPendingUpdates);
+    for (size_t i = 0; i < updates.size(); ++i) {
+         updates[i]();
+    }
+}
+
+void FITSImageRW::writeKeyword(const std::string &keyword, const std::string &value, const std::string &comment)
+{
+    fitsfile *fptr = openFile();
     int status = 0;
-    double radtodeg = 360. / (2 * M_PI);
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
 
-    double value = radtodeg * maj;
-    if (fits_update_key(fptr, TDOUBLE, "BMAJ", &value,
-                        "Restoring beam major axis", &status))
-        printerror(status);
-    value = radtodeg * min;
-    if (fits_update_key(fptr, TDOUBLE, "BMIN", &value,
-                        "Restoring beam minor axis", &status))
-        printerror(status);
-    value = radtodeg * pa;
-    if (fits_update_key(fptr, TDOUBLE, "BPA", &value,
-                        "Restoring beam position angle", &status))
-        printerror(status);
-    if (fits_update_key(fptr, TSTRING, "BTYPE", (void *) "Intensity",
-                        " ", &status))
+    if (fits_update_key(fptr, TSTRING, keyword.c_str(), const_cast<char*>(value.c_str()),
+                        comment.c_str(), &status))
         printerror(status);
+}
 
-    if (fits_close_file(fptr, &status))
-        printerror(status);
+void FITSImageRW::writeKeyword(const std::string &keyword, double value, const std::string &comment)
+{
+    fitsfile *fptr = openFile();
+    int status = 0;
 
+    if (fits_update_key(fptr, TDOUBLE, keyword.c_str(), &value, comment.c_str(), &status))
+        printerror(status);
 }
 
-void FITSImageRW::addHistory(const std::string &history)
+void FITSImageRW::writeHistory(const std::string &history)
 {
-
-    ASKAPLOG_INFO_STR(FITSlogger,"Adding HISTORY string: " << history);
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    fitsfile *fptr = openFile();
     int status = 0;
-    if ( fits_open_file(&fptr, this->name.c_str(), READWRITE, &status) )
-        printerror( status );
 
     if ( fits_write_history(fptr, history.c_str(), &status) )
         printerror( status );
+}
 
-    if ( fits_close_file(fptr, &status) )
-        printerror( status );
+void FITSImageRW::flush()
+{
+    applyPendingUpdates();
+    if (itsFptr != NULL) {
+        int status = 0;
+        if (fits_flush_file(itsFptr, &status))
+            printerror(status);
+    }
+}
+
+void FITSImageRW::close()
+{
+    applyPendingUpdates();
+    if (itsFptr != NULL) {
+        int status = 0;
+        fitsfile *fptr = itsFptr;
+        itsFptr = NULL;
+        if (fits_close_file(fptr, &status))
+            printerror(status);
+    }
+}
 
+void FITSImageRW::preallocate()
+{
+    ASKAPLOG_INFO_STR(FITSlogger, "Allocating the data unit of " << this->name);
+    fitsfile *fptr = openFile();
+    int status = 0;
+    int naxes = 0;
+    if (fits_get_img_dim(fptr, &naxes, &status))
+        printerror(status);
+    std::vector<LONGLONG> axes(std::max(naxes, 1), 1);
+    if (fits_get_img_sizell(fptr, naxes, &axes[0], &status))
+        printerror(status);
+    LONGLONG nelements = 1;
+    for (int axis = 0; axis < naxes; ++axis) {
+         nelements *= axes[axis];
+    }
+    if (nelements > 0) {
+        float zero = 0.;
+        if (fits_write_img(fptr, TFLOAT, nelements, 1, &zero, &status))
+            printerror(status);
+    }
+    close();
+}
+
+void FITSImageRW::setCompression(int type, const casacore::IPosition &tileShape, float quantizeLevel)
+{
+    ASKAPCHECK(type == 0 || type == RICE_1 || type == GZIP_1 || type == GZIP_2,
+               "Unsupported FITS compression type " << type);
+    itsCompression = type;
+    itsTileShape = tileShape;
+    itsQuantizeLevel = quantizeLevel;
 }
 
+void FITSImageRW::createCompressed(const std::vector<long> &naxes, const std::string &cards)
+{
+    ASKAPLOG_INFO_STR(FITSlogger, "Creating tile-compressed FITS image " << this->name);
+    const int ndim = naxes.size();
+    // by default one tile per plane, as cubes are written plane by plane
+    std::vector<long> tile(naxes);
+    for (int dim = 0; dim < ndim; ++dim) {
+         if (dim < int(itsTileShape.nelements())) {
+             tile[dim] = std::min(long(itsTileShape(dim)), naxes[dim]);
+         } else if (dim >= 2) {
+             tile[dim] = 1;
+         }
+    }
+    int status = 0;
+    fitsfile *fptr = NULL;
+    const std::string clobberName = "!" + this->name;
+    if (fits_create_file(&fptr, clobberName.c_str(), &status))
+        printerror(status);
+    if (fits_set_compression_type(fptr, itsCompression, &status))
+        printerror(status);
+    if (fits_set_tile_dim(fptr, ndim, &tile[0], &status))
+        printerror(status);
+    // zero quantize level means lossless compression of floats
+    if (fits_set_quantize_level(fptr, itsQuantizeLevel, &status))
+        printerror(status);
+    if (itsQuantizeLevel != 0.) {
+        if (fits_set_quantize_method(fptr, SUBTRACTIVE_DITHER_1, &status))
+            printerror(status);
+    }
+    std::vector<long> axes(naxes);
+    if (fits_create_img(fptr, FLOAT_IMG, ndim, axes.empty() ? NULL : &axes[0], &status))
+        printerror(status);
+    // free slots for keywords added later
+    if (fits_set_hdrsize(fptr, itsHeaderReserve, &status))
+        printerror(status);
+    // copy the cards, except those describing the structure which are written by cfitsio
+    for (size_t pos = 0; pos + 80 <= cards.size(); pos += 80) {
+         const std::string card = cards.substr(pos, 80);
+         std::string key = card.substr(0, 8);
+         key.erase(key.find_last_not_of(' ') + 1);
+         if (key.empty() && card.find_first_not_of(' ') == std::string::npos) {
+             continue;
+         }
+         if (key == "SIMPLE" || key == "BITPIX" || key.compare(0, 5, "NAXIS") == 0 || key == "EXTEND" ||
+             key == "PCOUNT" || key == "GCOUNT" || key == "BSCALE" || key == "BZERO" || key == "END") {
+             continue;
+         }
+         if (fits_write_record(fptr, card.c_str(), &status))
+             printerror(status);
+    }
+    if (fits_close_file(fptr, &status))
+        printerror(status);
+}
 
+fitsfile *FITSImageRW::openFile()
+{
+    if (itsFptr == NULL) {
+        int status = 0;
+        ASKAPLOG_INFO_STR(FITSlogger, "Opening FITS image " << this->name << " for writing");
+        // compressed images are stored in the first extension, this opens the first HDU with an image
+        if (fits_open_image(&itsFptr, this->name.c_str(), READWRITE, &status)) {
+            itsFptr = NULL;
+            printerror(status);
+        }
+    }
+    return itsFptr;
+}
 
 FITSImageRW::~FITSImageRW()
 {
+    close();
 }
@@ -36,7 +36,14 @@
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/fits/FITS/fitsio.h>
 
+#include "boost/function.hpp"
 #include "boost/scoped_ptr.hpp"
+#include "boost/utility.hpp"
+
+#include <fitsio.h>
+
+#include <string>
+#include <vector>
 
 namespace askap {
 namespace accessors {
@@ -50,7 +57,7 @@ namespace accessors {
 
 extern bool created;
 
-class FITSImageRW {
+class FITSImageRW : private boost::noncopyable {
 
     public:
 
@@ -81,7 +88,7 @@ class FITSImageRW {
                     bool allowAppend = false, \
                     bool history = true);
 
-        // Destructor does nothing
+        // Destructor closes the file if it is open
         virtual ~FITSImageRW();
 
         bool create();
@@ -91,13 +98,104 @@ class FITSImageRW {
 
         void setHeader(const std::string &keyword, const std::string &value, const std::string &desc);
         void setRestoringBeam(double, double, double);
+
+        /// @brief write per-channel beams
+        /// @details The beams are written into the BEAMS binary table extension (the CASA
+        /// convention: BMAJ and BMIN in arcsec, BPA in deg, CHAN and POL columns) replacing the
+        /// existing one, CASAMBM keyword is set in the image header.
+        /// @param[in] beams one beam (major, minor, position angle) per channel
+        void setBeams(const std::vector<casacore::Vector<casacore::Quantum<double> > > &beams);
     void addHistory(const std::string &history);
 
+        /// @brief start a batch of header updates
+        /// @details setUnits, setHeader, setRestoringBeam and addHistory calls made after this
+        /// are kept in memory and applied together by commitHeaderUpdate, so a full set of
+        /// product keywords results in a single header rewrite. Pending updates are also applied
+        /// by flush and close (the batch stays open in the former case).
+        void beginHeaderUpdate();
+
+        /// @brief apply the batch of header updates
+        /// @details All pending updates are written with the file open once and flushed.
+        /// It does nothing if no batch has been started.
+        void commitHeaderUpdate();
+
+        /// @brief set the number of free header card slots reserved by create
+        /// @details Keywords added later fill these slots, so the data unit never has to be
+        /// shifted to make room in the header (which is very slow for large files).
+        /// @param[in] nCards number of 80-character cards to reserve
+        void setHeaderReserve(int nCards) { itsHeaderReserve = nCards; }
+
         // write into a FITS image
         bool write(const casacore::Array<float>&);
         bool write(const casacore::Array<float> &arr, const casacore::IPosition &where);
+
+        /// @brief write buffered changes to disk
+        /// @details The file is kept open between calls, this method makes the changes
+        /// visible to other readers of the file. It does nothing if the file is not open.
+        void flush();
+
+        /// @brief close the file
+        /// @details The file is reopened by the next operation. It does nothing if the 
+        /// file is not open.
+        void close();
+
+        /// @brief allocate the whole data unit
+        /// @details The last pixel is written (which makes cfitsio extend the file with
+        /// zero pixels and pad the header properly) and the file is closed. After that the 
+        /// data unit can be written directly (see FITSDirectWriter).
+        void preallocate();
+
+        /// @brief set up tile compression of the images created afterwards
+        /// @details The compressed image is written by cfitsio into the first extension
+        /// (the primary HDU is empty). Writes are most efficient if they cover whole tiles.
+        /// @param[in] type cfitsio compression type (RICE_1, GZIP_1, GZIP_2 or 0 for none)
+        /// @param[in] tileShape tile shape, missing axes default to the full length for the
+        /// first two axes and to 1 otherwise (i.e. one tile per plane by default)
+        /// @param[in] quantizeLevel cfitsio quantization level for floats, 0 for lossless
+        void setCompression(int type, const casacore::IPosition &tileShape = casacore::IPosition(),
+                            float quantizeLevel = 4.f);
+
+        /// @brief check whether new images are compressed
+        /// @return true if tile compression is set up
+        bool compressed() const { return itsCompression != 0; }
     private:
 
+        /// @brief create the tile-compressed image with cfitsio
+        /// @param[in] naxes shape of the image
+        /// @param[in] cards header cards (80 characters each) to copy into the image HDU
+        void createCompressed(const std::vector<long> &naxes, const std::string &cards);
+
+        /// @brief obtain the open file
+        /// @details The file is opened for writing on the first call
+        /// @return pointer to the FITS file
+        fitsfile *openFile();
+
+        /// @brief do a header update or keep it for the batch
+        /// @param[in] update the update to do
+        void updateHeader(const boost::function<void()> &update);
+
+        /// @brief apply header updates kept for the batch
+        void applyPendingUpdates();
+
+        /// @brief write a string keyword
+        /// @param[in] keyword keyword name
+        /// @param[in] value value of the keyword
+        /// @param[in] comment comment for the keyword
+        void writeKeyword(const std::string &keyword, const std::string &value, const std::string &comment);
+
+        /// @brief write a floating point keyword
+        /// @param[in] keyword keyword name
+        /// @param[in] value value of the keyword
+        /// @param[in] comment comment for the keyword
+        void writeKeyword(const std::string &keyword, double value, const std::string &comment);
+
+        /// @brief write a HISTORY card
+        /// @param[in] history history text
+        void writeHistory(const std::string &history);
+
+        /// @brief the open FITS file (NULL if not open)
+        fitsfile *itsFptr;
+
 
 
         std::string name;
@@ -120,6 +218,24 @@ class FITSImageRW {
 
         casacore::FitsKeywordList theKeywordList;
 
+        /// @brief cfitsio compression type (0 if the image is not compressed)
+        int itsCompression;
+
+        /// @brief tile shape for compression (empty for one tile per plane)
+        casacore::IPosition itsTileShape;
+
+        /// @brief cfitsio quantization level for compression of floats
+        float itsQuantizeLevel;
+
+        /// @brief number of free header card slots reserved by create
+        int itsHeaderReserve;
+
+        /// @brief true if header updates are kept for the batch
+        bool itsBatchUpdate;
+
+        /// @brief header updates kept for the batch
+        std::vector<boost::function<void()> > itsPendingUpdates;
+
 };
 }
 }
@@ -0,0 +1,183 @@
+/// @file FITSSliceReader.cc
+/// @brief reader of FITS image slices kept open between calls
+/// @details This class reads rectangular subsets of a FITS image with cfitsio
+/// (fits_read_subset) directly into the caller's buffer. The file is opened once,
+/// and no header parsing or coordinate system construction is done for each read.
+/// This is much faster than going via casacore::FITSImage when many small cutouts
+/// are read (e.g. in source finding).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+#include <askap/imageaccess/FITSSliceReader.h>
+#include <askap/imageaccess/CutoutGrouper.h>
+
+#include <limits>
+
+ASKAP_LOGGER(logger, ".FITSSliceReader");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief open the image
+/// @param[in] fullname file name (including extension)
+FITSSliceReader::FITSSliceReader(const std::string &fullname) : itsName(fullname), itsFptr(NULL)
+{
+    int status = 0;
+    // this opens the first HDU with an image, so tile-compressed images are supported
+    if (fits_open_image(&itsFptr, fullname.c_str(), READONLY, &status)) {
+        itsFptr = NULL;
+        ASKAPTHROW(AskapError, "FITSSliceReader: Cannot open FITS file " << fullname << ", status=" << status);
+    }
+    int naxis = 0;
+    fits_get_img_dim(itsFptr, &naxis, &status);
+    std::vector<LONGLONG> naxes(naxis > 0 ? naxis : 1, 0);
+    fits_get_img_sizell(itsFptr, naxis, &naxes[0], &status);
+    if (status != 0) {
+        const int layoutStatus = status;
+        status = 0;
+        fits_close_file(itsFptr, &status);
+        itsFptr = NULL;
+        ASKAPTHROW(AskapError, "FITSSliceReader: Unable to read the shape of " << fullname << 
+                   ", status=" << layoutStatus);
+    }
+    itsShape.resize(naxis);
+    for (int axis = 0; axis < naxis; ++axis) {
+         itsShape(axis) = naxes[axis];
+    }
+    itsFirstPixel.resize(naxis);
+    itsLastPixel.resize(naxis);
+    itsIncrement.assign(naxis, 1);
+    ASKAPLOG_DEBUG_STR(logger, "Opened " << fullname << " for reading, shape " << itsShape);
+}
+
+/// @brief destructor, closes the file
+FITSSliceReader::~FITSSliceReader()
+{
+    if (itsFptr != NULL) {
+        int status = 0;
+        if (fits_close_file(itsFptr, &status)) {
+            ASKAPLOG_WARN_STR(logger, "FITSSliceReader: Error on closing " << itsName << ", status=" << status);
+        }
+    }
+}
+
+/// @brief check the selection and obtain its shape
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return shape of the selection
+casacore::IPosition FITSSliceReader::sliceShape(const casacore::IPosition &blc, const casacore::IPosition &trc) const
+{
+    ASKAPCHECK(blc.nelements() == trc.nelements(), "FITSSliceReader: blc="<<blc<<" and trc="<<trc<<
+               " have different dimensions");
+    ASKAPCHECK(blc.nelements() <= itsShape.nelements(), "FITSSliceReader: selection blc="<<blc<<
+               " has more dimensions than the image "<<itsName<<" of shape "<<itsShape);
+    casacore::IPosition result(blc.nelements());
+    for (size_t axis = 0; axis < itsShape.nelements(); ++axis) {
+         const ssize_t first = axis < blc.nelements() ? blc(axis) : 0;
+         const ssize_t last = axis < trc.nelements() ? trc(axis) : 0;
+         ASKAPCHECK((first >= 0) && (first <= last) && (last < itsShape(axis)), "FITSSliceReader: selection from "<<
+                    blc<<" to "<<trc<<" is outside the image "<<itsName<<" of shape "<<itsShape);
+         if (axis < blc.nelements()) {
+             result(axis) = last - first + 1;
+         }
+    }
+    return result;
+}
+
+/// @brief read a slice into preallocated memory
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @param[out] data pointer to the memory for (trc-blc+1).product() pixels in the
+/// Fortran order
+void FITSSliceReader::read(const casacore::IPosition &blc, const casacore::IPosition &trc, float *data) const
+{
+    ASKAPDEBUGASSERT(data != NULL);
+    // this checks the selection
+    sliceShape(blc, trc);
+    if (itsShape.nelements() == 0) {
+        return;
+    }
+    for (size_t axis = 0; axis < itsShape.nelements(); ++axis) {
+         itsFirstPixel[axis] = 1 + (axis < blc.nelements() ? blc(axis) : 0);
+         itsLastPixel[axis] = 1 + (axis < trc.nelements() ? trc(axis) : 0);
+    }
+    float nulval = std::numeric_limits<float>::quiet_NaN();
+    int anynul = 0;
+    int status = 0;
+    if (fits_read_subset(itsFptr, TFLOAT, &itsFirstPixel[0], &itsLastPixel[0], 
+                         const_cast<long*>(&itsIncrement[0]), &nulval, data, &anynul, &status)) {
+        ASKAPTHROW(AskapError, "FITSSliceReader: Failed to read a slice from "<<blc<<" to "<<trc<<
+                   " of "<<itsName<<", status=" << status);
+    }
+}
+
+/// @brief read a slice into the given buffer
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @param[out] buffer array to fill (resized if its shape differs from the selection)
+void FITSSliceReader::read(const casacore::IPosition &blc, const casacore::IPosition &trc,
+                           casacore::Array<float> &buffer) const
+{
+    const casacore::IPosition shape = sliceShape(blc, trc);
+    if (!buffer.shape().isEqual(shape) || !buffer.contiguousStorage()) {
+        // resize keeps a non-contiguous reference if the shape is the same
+        buffer.reference(casacore::Array<float>(shape));
+    }
+    // the buffer is contiguous, so the data are read in place
+    read(blc, trc, buffer.data());
+}
+
+/// @brief read a number of cutouts
+/// @details Cutouts are read in the order of their position in the file, overlapping or
+/// adjacent cutouts are read together as their bounding box (see CutoutGrouper).
+/// The result vector is resized to the number of cutouts, arrays already there
+/// are reused if their shape matches.
+/// @param[in] blc bottom left corners of the cutouts
+/// @param[in] trc top right corners of the cutouts (inclusive), same size as blc
+/// @param[out] cutouts arrays with pixels, one per cutout
+void FITSSliceReader::read(const std::vector<casacore::IPosition> &blc, const std::vector<casacore::IPosition> &trc,
+                           std::vector<casacore::Array<float> > &cutouts) const
+{
+    ASKAPCHECK(blc.size() == trc.size(), "FITSSliceReader: number of blcs ("<<blc.size()<<
+               ") should match the number of trcs ("<<trc.size()<<")");
+    const CutoutGrouper grouper(blc, trc);
+    cutouts.resize(blc.size());
+    // bounding boxes of groups, reused if consecutive groups have the same shape
+    casacore::Array<float> box;
+    for (std::vector<CutoutGrouper::Group>::const_iterator it = grouper.groups().begin();
+         it != grouper.groups().end(); ++it) {
+         if (it->members.size() == 1) {
+             read(blc[it->members[0]], trc[it->members[0]], cutouts[it->members[0]]);
+         } else {
+             read(it->blc, it->trc, box);
+             CutoutGrouper::extract(*it, box, blc, trc, cutouts);
+         }
+    }
+}
@@ -0,0 +1,124 @@
+/// @file FITSSliceReader.h
+/// @brief reader of FITS image slices kept open between calls
+/// @details This class reads rectangular subsets of a FITS image with cfitsio
+/// (fits_read_subset) directly into the caller's buffer. The file is opened once,
+/// and no header parsing or coordinate system construction is done for each read.
+/// This is much faster than going via casacore::FITSImage when many small cutouts
+/// are read (e.g. in source finding).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_FITS_SLICE_READER_H
+#define ASKAP_ACCESSORS_FITS_SLICE_READER_H
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <boost/utility.hpp>
+
+#include <fitsio.h>
+
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief reader of FITS image slices kept open between calls
+/// @details The first HDU with an image (the primary one unless the image is tile-compressed)
+/// is kept open by cfitsio for the lifetime of this object.
+/// Any pixel type is supported (cfitsio does the conversion and applies scaling), 
+/// undefined pixels are returned as NaN. The selection is given by the inclusive
+/// blc and trc (as for casacore::Slicer::endIsLast); trailing axes may be omitted,
+/// in which case they are assumed to be degenerate and are not present in the result.
+/// Buffers passed by the caller are only resized if their shape differs from that of
+/// the selection, so the same buffer can be reused for many reads without reallocation.
+/// @note cfitsio handles are not thread-safe, this object should be used by one thread at a time.
+/// @ingroup imageaccess
+class FITSSliceReader : private boost::noncopyable {
+public:
+    /// @brief open the image
+    /// @param[in] fullname file name (including extension)
+    explicit FITSSliceReader(const std::string &fullname);
+
+    /// @brief destructor, closes the file
+    ~FITSSliceReader();
+
+    /// @brief read a slice into the given buffer
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @param[out] buffer array to fill (resized if its shape differs from the selection)
+    void read(const casacore::IPosition &blc, const casacore::IPosition &trc,
+              casacore::Array<float> &buffer) const;
+
+    /// @brief read a slice into preallocated memory
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @param[out] data pointer to the memory for (trc-blc+1).product() pixels in the
+    /// Fortran order
+    void read(const casacore::IPosition &blc, const casacore::IPosition &trc, float *data) const;
+
+    /// @brief read a number of cutouts
+    /// @details Cutouts are read in the order of their position in the file, overlapping or
+    /// adjacent cutouts are read together as their bounding box (see CutoutGrouper).
+    /// The result vector is resized to the number of cutouts, arrays already there
+    /// are reused if their shape matches.
+    /// @param[in] blc bottom left corners of the cutouts
+    /// @param[in] trc top right corners of the cutouts (inclusive), same size as blc
+    /// @param[out] cutouts arrays with pixels, one per cutout
+    void read(const std::vector<casacore::IPosition> &blc, const std::vector<casacore::IPosition> &trc,
+              std::vector<casacore::Array<float> > &cutouts) const;
+
+    /// @brief shape of the image
+    /// @return full shape
+    const casacore::IPosition& shape() const { return itsShape; }
+
+private:
+    /// @brief check the selection and obtain its shape
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @return shape of the selection
+    casacore::IPosition sliceShape(const casacore::IPosition &blc, const casacore::IPosition &trc) const;
+
+    /// @brief file name
+    std::string itsName;
+
+    /// @brief cfitsio handle
+    fitsfile *itsFptr;
+
+    /// @brief shape of the image
+    casacore::IPosition itsShape;
+
+    /// @brief work arrays for cfitsio (1-based pixel numbers)
+    mutable std::vector<long> itsFirstPixel;
+    mutable std::vector<long> itsLastPixel;
+    std::vector<long> itsIncrement;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
@@ -34,24 +34,100 @@
 
 
 #include <askap/askap/AskapLogging.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/System/ProgressMeter.h>
-#include <casacore/images/Images/FITSImage.h>
 #include <casacore/images/Images/TempImage.h>
-#include <casacore/images/Images/SubImage.h>
 #include <casacore/images/Images/ImageFITSConverter.h>
 #include <casacore/images/Images/PagedImage.h>
 #include <casacore/lattices/Lattices/ArrayLattice.h>
 
 #include <askap/imageaccess/FITSImageRW.h>
 #include <askap/imageaccess/FitsImageAccess.h>
+#include <askap/imageaccess/ImageView.h>
+#include <askap/dataaccess/AccessTracer.h>
 
 #include <fitsio.h>
 
+#include <limits>
+
 ASKAP_LOGGER(logger, ".fitsImageAccessor");
 
 using namespace askap;
 using namespace askap::accessors;
 
+/// @brief copy pixels blanking those which are masked
+/// @details This is a simple loop without branches, so it can be vectorised by the compiler.
+/// Blanking is done in the same pass as the copy, the output may be the same as the input.
+/// @param[in] pixels pointer to pixels
+/// @param[in] mask pointer to the mask (true for good pixels)
+/// @param[out] out pointer to the output pixels
+/// @param[in] n number of pixels
+static void blankMasked(const float *pixels, const casacore::Bool *mask, float *out, const size_t n)
+{
+    const float blank = std::numeric_limits<float>::quiet_NaN();
+    for (size_t i = 0; i < n; ++i) {
+         out[i] = mask[i] ? pixels[i] : blank;
+    }
+}
+
+/// @brief constructor
+/// @param[in] cacheSize maximum number of images kept open for reading and
+/// (separately) for writing, zero means that images are opened for each call
+FitsImageAccess::FitsImageAccess(const size_t cacheSize) : itsHeaders(cacheSize),
+        itsSliceReaders(cacheSize), itsWriters(cacheSize),
+        itsDirectWriters(cacheSize), itsParallelWrite(false), itsCompression(NONE),
+        itsQuantizeLevel(4.f), itsHeaderReserve(100) {}
+
+/// @brief switch the parallel write mode on or off
+/// @details In this mode pixels are written with FITSDirectWriter bypassing cfitsio
+/// and create allocates the data unit in full.
+/// @param[in] on true to switch the parallel mode on
+void FitsImageAccess::setParallelWrite(const bool on)
+{
+    ASKAPCHECK(!on || itsCompression == NONE, "Parallel write mode is not supported for compressed FITS images");
+    itsParallelWrite = on;
+}
+
+/// @brief set up tile compression of images created afterwards
+/// @param[in] compression compression scheme
+/// @param[in] tileShape tile shape (empty for one tile per plane)
+/// @param[in] quantizeLevel cfitsio quantization level for floats, 0 for lossless
+void FitsImageAccess::setCompression(const Compression compression, const casacore::IPosition &tileShape,
+                                     const float quantizeLevel)
+{
+    ASKAPCHECK(compression == NONE || !itsParallelWrite,
+               "Parallel write mode is not supported for compressed FITS images");
+    itsCompression = compression;
+    itsCompressionTile = tileShape;
+    itsQuantizeLevel = quantizeLevel;
+}
+
+/// @brief set the number of free header card slots reserved in images created afterwards
+/// @param[in] nCards number of 80-character cards to reserve
+void FitsImageAccess::setHeaderReserve(const int nCards)
+{
+    ASKAPCHECK(nCards >= 0, "Number of reserved header cards should not be negative, you have " << nCards);
+    itsHeaderReserve = nCards;
+}
+
+/// @brief start a batch of metadata updates
+/// @param[in] name image name
+void FitsImageAccess::beginHeaderUpdate(const std::string &name)
+{
+    connect(name);
+    itsFITSImage->beginHeaderUpdate();
+}
+
+/// @brief write the batch of metadata updates
+/// @param[in] name image name
+void FitsImageAccess::commitHeaderUpdate(const std::string &name)
+{
+    const boost::shared_ptr<FITSImageRW> writer = itsWriters.find(name);
+    if (writer) {
+        writer->commitHeaderUpdate();
+    }
+}
+
 // reading methods
 
 /// @brief obtain the shape
@@ -59,9 +135,7 @@ using namespace askap::accessors;
 /// @return full shape of the given image
 casacore::IPosition FitsImageAccess::shape(const std::string &name) const
 {
-    std::string fullname = name + ".fits";
-    casacore::FITSImage img(fullname);
-    return img.shape();
+    return header(name)->shape();
 }
 
 /// @brief read full image
@@ -69,25 +143,17 @@ casacore::IPosition FitsImageAccess::shape(const std::string &name) const
 /// @return array with pixels
 casacore::Array<float> FitsImageAccess::read(const std::string &name) const
 {
+    const AccessTracer::Scope trace("read", name, "imageaccess");
     std::string fullname = name + ".fits";
     ASKAPLOG_INFO_STR(logger, "Reading FITS image " << fullname);
 
-    casacore::FITSImage img(fullname);
-
-    const casacore::IPosition shape = img.shape();
+    const casacore::IPosition shape = this->shape(name);
     ASKAPLOG_INFO_STR(logger, " - Shape " << shape);
 
-    casacore::IPosition blc(shape.nelements(), 0);
-    casacore::IPosition trc(shape);
-
-    trc[0] = trc[0] - 1;
-    trc[1] = trc[1] - 1;
-    trc[2] = trc[2] - 1;
-    trc[3] = trc[3] - 1;
+    const casacore::IPosition blc(shape.nelements(), 0);
+    const casacore::IPosition trc = shape - 1;
 
     return this->read(name, blc, trc);
-
-
 }
 
 /// @brief read part of the image
@@ -98,16 +164,54 @@ casacore::Array<float> FitsImageAccess::read(const std::string &name) const
 casacore::Array<float> FitsImageAccess::read(const std::string &name, const casacore::IPosition &blc,
         const casacore::IPosition &trc) const
 {
-    std::string fullname = name + ".fits";
-    ASKAPLOG_INFO_STR(logger, "Reading a slice of the FITS image " << name << " from " << blc << " to " << trc);
-
-    casacore::FITSImage img(fullname);
     casacore::Array<float> buffer;
-    casacore::Slicer slc(blc, trc, casacore::Slicer::endIsLast);
-    std::cout << "Reading a slice of the FITS image " << name << " slice " << slc << std::endl;
-    ASKAPCHECK(img.doGetSlice(buffer, slc) == casacore::False, "Cannot read image");
+    read(name, blc, trc, buffer);
     return buffer;
+}
 
+/// @brief read part of the image into the given buffer
+/// @details The buffer is only resized if its shape differs from that of the
+/// selection, so it can be reused for a sequence of reads of the same size.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill
+void FitsImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                           const casacore::IPosition &trc, casacore::Array<float> &buffer) const
+{
+    const AccessTracer::Scope trace("read", name, "imageaccess");
+    ASKAPLOG_DEBUG_STR(logger, "Reading a slice of the FITS image " << name << " from " << blc << " to " << trc);
+    sliceReader(name)->read(blc, trc, buffer);
+}
+
+/// @brief read part of the image into preallocated memory
+/// @details cfitsio reads directly into the given memory.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] data pointer to the memory for (trc-blc+1).product() pixels in the Fortran order
+void FitsImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                           const casacore::IPosition &trc, float *data) const
+{
+    const AccessTracer::Scope trace("read", name, "imageaccess");
+    ASKAPLOG_DEBUG_STR(logger, "Reading a slice of the FITS image " << name << " from " << blc << " to " << trc);
+    sliceReader(name)->read(blc, trc, data);
+}
+
+/// @brief read a number of cutouts
+/// @details All cutouts are read with the same open handle, arrays already
+/// present in the output vector are reused if their shape matches.
+/// @param[in] name image name
+/// @param[in] blc bottom left corners of the cutouts
+/// @param[in] trc top right corners of the cutouts, same size as blc
+/// @param[out] cutouts arrays with pixels, one per cutout
+void FitsImageAccess::readCutouts(const std::string &name, const std::vector<casacore::IPosition> &blc,
+                                  const std::vector<casacore::IPosition> &trc,
+                                  std::vector<casacore::Array<float> > &cutouts) const
+{
+    const AccessTracer::Scope trace("readCutouts", name, "imageaccess");
+    ASKAPLOG_DEBUG_STR(logger, "Reading " << blc.size() << " cutouts of the FITS image " << name);
+    sliceReader(name)->read(blc, trc, cutouts);
 }
 
 /// @brief obtain coordinate system info
@@ -115,53 +219,95 @@ casacore::Array<float> FitsImageAccess::read(const std::string &name, const casa
 /// @return coordinate system object
 casacore::CoordinateSystem FitsImageAccess::coordSys(const std::string &name) const
 {
-    std::string fullname = name + ".fits";
-    casacore::FITSImage img(fullname);
-    return img.coordinates();
+    return header(name)->coordSys();
 }
 
+/// @brief obtain coordinate system info for part of an image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return coordinate system object
 casacore::CoordinateSystem FitsImageAccess::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
         const casacore::IPosition &trc) const
 {
-    std::string fullname = name + ".fits";
-    casacore::Slicer slc(blc, trc, casacore::Slicer::endIsLast);
-    ASKAPLOG_INFO_STR(logger, " FITSImageAccess - Slicer " << slc);
-    casacore::FITSImage img(fullname);
-    casacore::SubImage<casacore::Float> si = casacore::SubImage<casacore::Float>(img, slc, casacore::AxesSpecifier(casacore::True));
-    return si.coordinates();
-
+    return ImageView::sliceCoordSys(header(name)->coordSys(), blc, trc);
 }
+
 /// @brief obtain beam info
 /// @param[in] name image name
 /// @return beam info vector
 casacore::Vector<casacore::Quantum<double> > FitsImageAccess::beamInfo(const std::string &name) const
 {
-    std::string fullname = name + ".fits";
-    casacore::FITSImage img(fullname);
-    casacore::ImageInfo ii = img.imageInfo();
-    return ii.restoringBeam().toVector();
+    return header(name)->beam();
 }
-std::string FitsImageAccess::getUnits(const std::string &name) const
+/// @brief obtain per-channel beam info
+/// @details The beams are read from the BEAMS binary table (only rows for the first
+/// polarisation are used).
+/// @param[in] name image name
+/// @return one beam per channel, empty if the image has no BEAMS table
+IImageAccess::BeamList FitsImageAccess::beamList(const std::string &name) const
 {
-
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    std::string fullname = name + ".fits";
+    const std::string fullname = name + ".fits";
+    flushWriter(name);
+    fitsfile *fptr = NULL;
     int status = 0;
-    std::string units("");
-    const std::string key("Brightness (pixel) unit");
-    char comment[1024];
-    if (fits_open_file(&fptr, fullname.c_str(), READONLY, &status))
-        ASKAPCHECK(status == 0, "FITSImageAccess:: Cannot open FITS file");
-
-    if (fits_read_key(fptr, TSTRING, "BUNIT", (void *)(units.c_str()), comment,  &status))
-        ASKAPLOG_WARN_STR(logger, "FITSImageAccess:: Cannot find BUNIT keyword - fits_read_key returned status " << status);
-
-    status=0;
-    if (fits_close_file(fptr, &status))
-        ASKAPCHECK(status == 0, "FITSImageAccess:: Error on closing file");
-
-    return units;
+    if (fits_open_file(&fptr, fullname.c_str(), READONLY, &status)) {
+        ASKAPTHROW(AskapError, "FITSImageAccess:: Cannot open FITS file " << fullname << ", status=" << status);
+    }
+    BeamList result;
+    if (fits_movnam_hdu(fptr, BINARY_TBL, const_cast<char*>("BEAMS"), 0, &status) == 0) {
+        long nRows = 0;
+        int colBmaj = 0, colBmin = 0, colBpa = 0, colChan = 0, colPol = 0;
+        fits_get_num_rows(fptr, &nRows, &status);
+        fits_get_colnum(fptr, CASEINSEN, const_cast<char*>("BMAJ"), &colBmaj, &status);
+        fits_get_colnum(fptr, CASEINSEN, const_cast<char*>("BMIN"), &colBmin, &status);
+        fits_get_colnum(fptr, CASEINSEN, const_cast<char*>("BPA"), &colBpa, &status);
+        fits_get_colnum(fptr, CASEINSEN, const_cast<char*>("CHAN"), &colChan, &status);
+        fits_get_colnum(fptr, CASEINSEN, const_cast<char*>("POL"), &colPol, &status);
+        std::vector<double> bmaj(nRows), bmin(nRows), bpa(nRows);
+        std::vector<int> chan(nRows), pol(nRows);
+        if (nRows > 0) {
+            fits_read_col(fptr, TDOUBLE, colBmaj, 1, 1, nRows, NULL, &bmaj[0], NULL, &status);
+            fits_read_col(fptr, TDOUBLE, colBmin, 1, 1, nRows, NULL, &bmin[0], NULL, &status);
+            fits_read_col(fptr, TDOUBLE, colBpa, 1, 1, nRows, NULL, &bpa[0], NULL, &status);
+            fits_read_col(fptr, TINT, colChan, 1, 1, nRows, NULL, &chan[0], NULL, &status);
+            fits_read_col(fptr, TINT, colPol, 1, 1, nRows, NULL, &pol[0], NULL, &status);
+        }
+        const int readStatus = status;
+        status = 0;
+        fits_close_file(fptr, &status);
+        ASKAPCHECK(readStatus == 0, "FITSImageAccess:: Unable to read the BEAMS table of " << fullname <<
+                   ", status=" << readStatus);
+        for (long row = 0; row < nRows; ++row) {
+             if ((pol[row] != 0) || (chan[row] < 0)) {
+                 continue;
+             }
+             if (chan[row] >= int(result.size())) {
+                 result.resize(chan[row] + 1, casacore::Vector<casacore::Quantum<double> >());
+             }
+             casacore::Vector<casacore::Quantum<double> > beam(3);
+             beam[0] = casacore::Quantum<double>(bmaj[row], "arcsec");
+             beam[1] = casacore::Quantum<double>(bmin[row], "arcsec");
+             beam[2] = casacore::Quantum<double>(bpa[row], "deg");
+             result[chan[row]].reference(beam);
+        }
+    } else {
+        status = 0;
+        fits_close_file(fptr, &status);
+    }
+    return result;
+}
 
+/// @brief obtain pixel units
+/// @param[in] name image name
+/// @return units string
+std::string FitsImageAccess::getUnits(const std::string &name) const
+{
+    const boost::shared_ptr<FITSHeaderReader> hdr = header(name);
+    if (!hdr->hasKeyword("BUNIT")) {
+        ASKAPLOG_WARN_STR(logger, "FITSImageAccess:: Cannot find BUNIT keyword in " << name);
+    }
+    return hdr->keyword("BUNIT");
 }
 
 /// @brief Get a particular keyword from the image metadata (A.K.A header)
@@ -170,32 +316,24 @@ std::string FitsImageAccess::getUnits(const std::string &name) const
 /// @param[in] keyword The name of the metadata keyword
 std::string FitsImageAccess::getMetadataKeyword(const std::string &name, const std::string &keyword) const
 {
-
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    std::string fullname = name + ".fits";
-    int status = 0;
-    char value[1024];
-    char comment[1024];
-    if (fits_open_file(&fptr, fullname.c_str(), READONLY, &status))
-        ASKAPCHECK(status == 0, "FITSImageAccess:: Cannot open FITS file");
-    status=0;
-    
-    if (fits_read_key(fptr, TSTRING, keyword.c_str(), value, comment,  &status))
-        ASKAPLOG_WARN_STR(logger, "FITSImageAccess:: Cannot find keyword " << keyword << " - fits_read_key returned status " << status);
-    status=0;
-    if (fits_close_file(fptr, &status))
-        ASKAPCHECK(status == 0, "FITSImageAccess:: Error on closing file, status="<<status);
-
-    std::string valueStr(value);
-    return valueStr;
-
+    const boost::shared_ptr<FITSHeaderReader> hdr = header(name);
+    if (!hdr->hasKeyword(keyword)) {
+        ASKAPLOG_WARN_STR(logger, "FITSImageAccess:: Cannot find keyword " << keyword << " in " << name);
+    }
+    return hdr->keyword(keyword);
 }
 
 
 void FitsImageAccess::connect(const std::string &name)
 {
-    std::string fullname = name + ".fits";
-    itsFITSImage.reset(new FITSImageRW(fullname));
+    // the image is about to change, so the cached readers would be stale
+    dropReaders(name);
+    itsFITSImage = itsWriters.find(name);
+    if (!itsFITSImage) {
+        std::string fullname = name + ".fits";
+        itsFITSImage.reset(new FITSImageRW(fullname));
+        itsWriters.add(name, itsFITSImage);
+    }
 }
 // writing methods
 
@@ -214,12 +352,24 @@ void FitsImageAccess::create(const std::string &name, const casacore::IPosition
     ASKAPLOG_INFO_STR(logger, "Creating a new FITS image " << name << " with the shape " << shape);
     casacore::String error;
 
+    // images with the same name kept open would be stale after this call
+    close(name);
     itsFITSImage.reset(new FITSImageRW());
+    itsFITSImage->setHeaderReserve(itsHeaderReserve);
+    if (itsCompression != NONE) {
+        const int types[] = {0, RICE_1, GZIP_1, GZIP_2};
+        itsFITSImage->setCompression(types[itsCompression], itsCompressionTile, itsQuantizeLevel);
+    }
     if (!itsFITSImage->create(name, shape, csys)) {
         casacore::String error;
         error = casacore::String("Failed to create FITSFile");
         ASKAPTHROW(AskapError, error);
     }
+    itsWriters.add(name, itsFITSImage);
+    if (itsParallelWrite) {
+        // other processes write directly into the data unit, so it has to exist in full
+        itsFITSImage->preallocate();
+    }
     itsFITSImage->print_hdr();
     // make an array
     // this requires that the whole array fits in memory
@@ -238,7 +388,13 @@ void FitsImageAccess::create(const std::string &name, const casacore::IPosition
 /// @param[in] arr array with pixels
 void FitsImageAccess::write(const std::string &name, const casacore::Array<float> &arr)
 {
+    const AccessTracer::Scope trace("write", name, "imageaccess");
     ASKAPLOG_INFO_STR(logger, "Writing an array with the shape " << arr.shape() << " into a FITS image " << name);
+    if (itsParallelWrite) {
+        const boost::shared_ptr<FITSDirectWriter> writer = directWriter(name);
+        writer->write(arr, casacore::IPosition(writer->shape().nelements(), 0));
+        return;
+    }
     connect(name);
     itsFITSImage->write(arr);
 
@@ -252,9 +408,14 @@ void FitsImageAccess::write(const std::string &name, const casacore::Array<float
 void FitsImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
                             const casacore::IPosition &where)
 {
+    const AccessTracer::Scope trace("write", name, "imageaccess");
     ASKAPLOG_INFO_STR(logger, "Writing a slice with the shape " << arr.shape() << " into a FITS image " <<
                       name << " at " << where);
     casacore::String error;
+    if (itsParallelWrite) {
+        directWriter(name)->write(arr, where);
+        return;
+    }
     connect(name);
     if (!itsFITSImage->write(arr, where)) {
         error = casacore::String("Failed to write slice");
@@ -263,22 +424,67 @@ void FitsImageAccess::write(const std::string &name, const casacore::Array<float
 
 }
 /// @brief write a slice of an image mask
+/// @details FITS images have no separate pixel mask, masked pixels are blanked (set to NaN)
+/// instead, which is irreversible. Only the given slice is read back, blanked and written
+/// again (nothing is done if all pixels are good). Use writeMasked to blank the pixels
+/// while they are written.
 /// @param[in] name image name
-/// @param[in] arr array with pixels
+/// @param[in] mask array with mask (true for good pixels)
 /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
 void FitsImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask,
                                 const casacore::IPosition &where)
 {
-    casacore::String error = casacore::String("FITS pixel mask not yet implemented");
-    ASKAPLOG_INFO_STR(logger, error);
+    const AccessTracer::Scope trace("writeMask", name, "imageaccess");
+    if (casacore::allTrue(mask)) {
+        return;
+    }
+    ASKAPLOG_INFO_STR(logger, "Blanking masked pixels of a slice with the shape " << mask.shape() <<
+                      " in a FITS image " << name << " at " << where);
+    ASKAPCHECK(mask.ndim() <= where.nelements(), "Mask shape " << mask.shape() <<
+               " has more dimensions than the position of the slice " << where);
+    casacore::IPosition trc(where);
+    for (size_t dim = 0; dim < mask.ndim(); ++dim) {
+         trc(dim) += mask.shape()(dim) - 1;
+    }
+    casacore::Array<float> pixels;
+    read(name, where, trc, pixels);
+    ASKAPDEBUGASSERT(pixels.nelements() == mask.nelements());
+    bool deleteIt;
+    const casacore::Bool *maskData = mask.getStorage(deleteIt);
+    blankMasked(pixels.data(), maskData, pixels.data(), pixels.nelements());
+    mask.freeStorage(maskData, deleteIt);
+    write(name, pixels, where);
+}
+
+/// @brief write an image mask
+/// @details Masked pixels are blanked, see the slice version.
+/// @param[in] name image name
+/// @param[in] mask array with mask (true for good pixels)
+void FitsImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+{
+    writeMask(name, mask, casacore::IPosition(shape(name).nelements(), 0));
 }
-/// @brief write a slice of an image mask
+
+/// @brief write a slice of an image together with its pixel mask
+/// @details Masked pixels are blanked (set to NaN) in the same pass which prepares the
+/// pixels for writing, so masking doesn't need to read the slice back.
 /// @param[in] name image name
 /// @param[in] arr array with pixels
-void FitsImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+/// @param[in] mask mask of the same shape as arr (true for good pixels)
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void FitsImageAccess::writeMasked(const std::string &name, const casacore::Array<float> &arr,
+                                  const casacore::Array<bool> &mask, const casacore::IPosition &where)
 {
-    casacore::String error = casacore::String("FITS pixel mask not yet implemented");
-    ASKAPLOG_INFO_STR(logger, error);
+    ASKAPCHECK(mask.shape().isEqual(arr.shape()), "Mask shape " << mask.shape() <<
+               " doesn't match the shape of the pixel array " << arr.shape());
+    casacore::Array<float> blanked(arr.shape());
+    bool deletePixels, deleteMask;
+    const float *pixelData = arr.getStorage(deletePixels);
+    const casacore::Bool *maskData = mask.getStorage(deleteMask);
+    blankMasked(pixelData, maskData, blanked.data(), arr.nelements());
+    mask.freeStorage(maskData, deleteMask);
+    arr.freeStorage(pixelData, deletePixels);
+    write(name, blanked, where);
 }
 /// @brief set brightness units of the image
 /// @details
@@ -306,16 +512,28 @@ void FitsImageAccess::setBeamInfo(const std::string &name, double maj, double mi
     itsFITSImage->setRestoringBeam(maj, min, pa);
 
 }
+/// @brief set per-channel beam info
+/// @details The beams are written into the BEAMS binary table extension.
+/// @param[in] name image name
+/// @param[in] beams one beam per channel
+void FitsImageAccess::setBeamList(const std::string &name, const BeamList &beams)
+{
+    const casacore::uInt nChan = nChannels(shape(name), coordSys(name));
+    ASKAPCHECK(beams.size() == nChan, "Number of beams (" << beams.size() << ") should match the number of channels (" <<
+               nChan << ") of " << name);
+    connect(name);
+    itsFITSImage->setBeams(beams);
+}
+
 /// @brief apply mask to image
 /// @details Details depend upon the implemenation - CASA images will have the pixel mask assigned
 /// but FITS images will have it applied to the pixels ... which is an irreversible process
-/// In this mode we would either have to apply it to the array - or readback the array - mask
-/// then write ...
+/// The default mask has all pixels good, so there is nothing to blank in FITS.
 void FitsImageAccess::makeDefaultMask(const std::string &name)
 {
 
-    casacore::String error = casacore::String("A default mask in FITS makes no sense");
-    ASKAPLOG_INFO_STR(logger, error);
+    // all pixels of the default mask are good, so no pixels have to be blanked
+    ASKAPLOG_DEBUG_STR(logger, "A default mask of the FITS image " << name << " requires no blanking");
 
 }
 
@@ -343,3 +561,105 @@ void FitsImageAccess::addHistory(const std::string &name, const std::string &his
     itsFITSImage->addHistory(history);
     
 }
+
+// handle management
+
+/// @brief close the given image
+/// @details The image is removed from the caches, which writes all changes to disk.
+/// @param[in] name image name
+void FitsImageAccess::close(const std::string &name)
+{
+    dropReaders(name);
+    itsDirectWriters.remove(name);
+    const boost::shared_ptr<FITSImageRW> writer = itsWriters.find(name);
+    if (writer) {
+        if (writer == itsFITSImage) {
+            itsFITSImage.reset();
+        }
+        itsWriters.remove(name);
+        // the file is closed even if the handle is still referenced elsewhere
+        writer->close();
+    }
+}
+
+/// @brief write all changes to disk
+/// @details All images open for writing are flushed, but kept open.
+void FitsImageAccess::flush()
+{
+    const std::vector<boost::shared_ptr<FITSImageRW> > writers = itsWriters.handles();
+    for (size_t i = 0; i < writers.size(); ++i) {
+         writers[i]->flush();
+    }
+    const std::vector<boost::shared_ptr<FITSDirectWriter> > directWriters = itsDirectWriters.handles();
+    for (size_t i = 0; i < directWriters.size(); ++i) {
+         directWriters[i]->flush();
+    }
+}
+
+/// @brief obtain the parsed header of the given image
+/// @details Changes buffered by the writer of the same image are flushed first.
+/// @param[in] name image name
+/// @return shared pointer to the header
+boost::shared_ptr<FITSHeaderReader> FitsImageAccess::header(const std::string &name) const
+{
+    flushWriter(name);
+    boost::shared_ptr<FITSHeaderReader> hdr = itsHeaders.find(name);
+    if (!hdr) {
+        std::string fullname = name + ".fits";
+        hdr.reset(new FITSHeaderReader(fullname));
+        itsHeaders.add(name, hdr);
+    }
+    return hdr;
+}
+
+/// @brief obtain a pixel reader for the given image
+/// @details Changes buffered by the writer of the same image are flushed first.
+/// @param[in] name image name
+/// @return shared pointer to the reader
+boost::shared_ptr<FITSSliceReader> FitsImageAccess::sliceReader(const std::string &name) const
+{
+    flushWriter(name);
+    boost::shared_ptr<FITSSliceReader> rdr = itsSliceReaders.find(name);
+    if (!rdr) {
+        std::string fullname = name + ".fits";
+        rdr.reset(new FITSSliceReader(fullname));
+        itsSliceReaders.add(name, rdr);
+    }
+    return rdr;
+}
+
+/// @brief drop cached readers of the given image
+/// @param[in] name image name
+void FitsImageAccess::dropReaders(const std::string &name)
+{
+    itsHeaders.remove(name);
+    itsSliceReaders.remove(name);
+}
+
+/// @brief flush changes buffered by the writer of the given image
+/// @param[in] name image name
+void FitsImageAccess::flushWriter(const std::string &name) const
+{
+    const boost::shared_ptr<FITSImageRW> writer = itsWriters.find(name);
+    if (writer) {
+        writer->flush();
+    }
+}
+
+/// @brief obtain the direct writer for the given image (parallel mode)
+/// @details Cached readers of the image are dropped, as the pixels are about to change.
+/// @param[in] name image name
+/// @return shared pointer to the writer
+boost::shared_ptr<FITSDirectWriter> FitsImageAccess::directWriter(const std::string &name)
+{
+    dropReaders(name);
+    // header changes buffered by cfitsio have to be on disk before the layout is read
+    flushWriter(name);
+    boost::shared_ptr<FITSDirectWriter> writer = itsDirectWriters.find(name);
+    if (!writer) {
+        std::string fullname = name + ".fits";
+        writer.reset(new FITSDirectWriter(fullname));
+        itsDirectWriters.add(name, writer);
+    }
+    return writer;
+}
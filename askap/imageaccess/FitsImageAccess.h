@@ -36,6 +36,10 @@
 
 #include <askap/imageaccess/IImageAccess.h>
 #include <askap/imageaccess/FITSImageRW.h>
+#include <askap/imageaccess/FITSDirectWriter.h>
+#include <askap/imageaccess/FITSHeaderReader.h>
+#include <askap/imageaccess/FITSSliceReader.h>
+#include <askap/imageaccess/ImageHandleCache.h>
 
 namespace askap {
 namespace accessors {
@@ -46,13 +50,77 @@ namespace accessors {
 /// for efficient output.
 /// It therefore makes sense to heavily inherit from the CASA conversion
 /// classes.
+/// Open images are kept in LRU caches between calls (FITSSliceReader and FITSHeaderReader
+/// objects for reading and FITSImageRW objects for writing), so writing a cube plane by
+/// plane opens the file only once. Buffered changes are flushed before the image
+/// is read and cached readers are dropped when the image is written to.
+/// Pixels are read with FITSSliceReader (cfitsio directly). Metadata queries are served
+/// from the header parsed once by FITSHeaderReader, the coordinate system is only built
+/// when it is requested.
+/// In the parallel write mode, create also allocates the data unit and pixels are
+/// written directly into the file by FITSDirectWriter, so a number of processes can
+/// write disjoint slabs of the same image. The image should be created by one process
+/// before others start writing (e.g. followed by a barrier) and header keywords should
+/// only be changed while no other process is writing.
 /// @ingroup imageaccess
 struct FitsImageAccess : public IImageAccess {
 
     public:
 
+        /// @brief constructor
+        /// @param[in] cacheSize maximum number of images kept open for reading and
+        /// (separately) for writing, zero means that images are opened for each call
+        explicit FitsImageAccess(const size_t cacheSize = 8);
+
+        /// @brief switch the parallel write mode on or off
+        /// @details In this mode pixels are written with FITSDirectWriter bypassing cfitsio
+        /// and create allocates the data unit in full.
+        /// @param[in] on true to switch the parallel mode on
+        void setParallelWrite(const bool on);
+
+        /// @brief check whether the parallel write mode is on
+        /// @return true if pixels are written directly into the file
+        bool parallelWrite() const { return itsParallelWrite; }
+
+        /// @brief tile compression schemes of new images (see cfitsio)
+        enum Compression {
+            NONE,
+            RICE,
+            GZIP,
+            GZIP2
+        };
+
+        /// @brief set up tile compression of images created afterwards
+        /// @details Compressed images are written by cfitsio into the first extension.
+        /// The default tile is one plane, which matches writing the cube plane by plane.
+        /// Compression can't be combined with the parallel write mode.
+        /// @param[in] compression compression scheme
+        /// @param[in] tileShape tile shape (empty for one tile per plane)
+        /// @param[in] quantizeLevel cfitsio quantization level for floats, 0 for lossless
+        void setCompression(const Compression compression,
+                            const casacore::IPosition &tileShape = casacore::IPosition(),
+                            const float quantizeLevel = 4.f);
+
+        /// @brief set the number of free header card slots reserved in images created afterwards
+        /// @details Keywords added after create fill these slots, so the data unit doesn't have to
+        /// be shifted to make room in the header.
+        /// @param[in] nCards number of 80-character cards to reserve
+        void setHeaderReserve(const int nCards);
+
+        /// @brief start a batch of metadata updates
+        /// @details setUnits, setBeamInfo, setMetadataKeyword and addHistory calls for this image
+        /// are kept in memory until commitHeaderUpdate (or until the image is read, flushed or closed)
+        /// and then written to the header together.
+        /// @param[in] name image name
+        void beginHeaderUpdate(const std::string &name);
+
+        /// @brief write the batch of metadata updates
+        /// @param[in] name image name
+        void commitHeaderUpdate(const std::string &name);
+
         /// @brief connect accessor to an existing image
-        /// @details Instantiates the private FITSImageRW shared pointer.
+        /// @details Sets the private FITSImageRW shared pointer, reusing the open
+        /// image from the cache if possible.
         /// @param[in] name image name
         void connect(const std::string &name);
 
@@ -78,6 +146,36 @@ struct FitsImageAccess : public IImageAccess {
         virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
                                         const casacore::IPosition &trc) const;
 
+        /// @brief read part of the image into the given buffer
+        /// @details The buffer is only resized if its shape differs from that of the
+        /// selection, so it can be reused for a sequence of reads of the same size.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[out] buffer array to fill
+        virtual void read(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<float> &buffer) const;
+
+        /// @brief read part of the image into preallocated memory
+        /// @details cfitsio reads directly into the given memory.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[out] data pointer to the memory for (trc-blc+1).product() pixels in the Fortran order
+        virtual void read(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, float *data) const;
+
+        /// @brief read a number of cutouts
+        /// @details All cutouts are read with the same open handle, arrays already
+        /// present in the output vector are reused if their shape matches.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corners of the cutouts
+        /// @param[in] trc top right corners of the cutouts, same size as blc
+        /// @param[out] cutouts arrays with pixels, one per cutout
+        virtual void readCutouts(const std::string &name, const std::vector<casacore::IPosition> &blc,
+                                 const std::vector<casacore::IPosition> &trc,
+                                 std::vector<casacore::Array<float> > &cutouts) const;
+
         /// @brief obtain coordinate system info
         /// @param[in] name image name
         /// @return coordinate system object
@@ -94,6 +192,11 @@ struct FitsImageAccess : public IImageAccess {
         /// @return beam info vector
         virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const;
 
+        /// @brief obtain per-channel beam info
+        /// @param[in] name image name
+        /// @return one beam per channel, empty if the image has no per-channel beams
+        virtual BeamList beamList(const std::string &name) const;
+
         /// @brief obtain pixel units
         /// @param[in] name image name
         /// @return units string
@@ -132,17 +235,31 @@ struct FitsImageAccess : public IImageAccess {
                            const casacore::IPosition &where);
 
         /// @brief write a slice of an image mask
+        /// @details FITS images have no separate pixel mask, masked pixels are blanked (set to NaN)
+        /// instead, which is irreversible. Only the given slice is read back, blanked and written
+        /// again (nothing is done if all pixels are good). Use writeMasked to blank the pixels
+        /// while they are written.
         /// @param[in] name image name
-        /// @param[in] arr array with pixels
+        /// @param[in] mask array with mask (true for good pixels)
         /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
         virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
                                const casacore::IPosition &where);
 
-        /// @brief write a slice of an image mask
+        /// @brief write an image mask
+        /// @details Masked pixels are blanked, see the slice version.
         /// @param[in] name image name
-        /// @param[in] arr array with pixels
-
+        /// @param[in] mask array with mask (true for good pixels)
         virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask);
+
+        /// @brief write a slice of an image together with its pixel mask
+        /// @details Masked pixels are blanked (set to NaN) in the same pass which prepares the
+        /// pixels for writing, so masking doesn't need to read the slice back.
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        /// @param[in] mask mask of the same shape as arr (true for good pixels)
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void writeMasked(const std::string &name, const casacore::Array<float> &arr,
+                                 const casacore::Array<bool> &mask, const casacore::IPosition &where);
         /// @brief set brightness units of the image
         /// @details
         /// @param[in] name image name
@@ -158,9 +275,15 @@ struct FitsImageAccess : public IImageAccess {
         /// @param[in] pa position angle in radians
         virtual void setBeamInfo(const std::string &name, double maj, double min, double pa);
 
+        /// @brief set per-channel beam info
+        /// @param[in] name image name
+        /// @param[in] beams one beam per channel
+        virtual void setBeamList(const std::string &name, const BeamList &beams);
+
         /// @brief apply mask to image
         /// @details Deteails depend upon the implemenation - CASA images will have the pixel mask assigned
-        /// but FITS images will have it applied to the pixels ... which is an irreversible process
+        /// but FITS images will have it applied to the pixels ... which is an irreversible process.
+        /// The default mask has all pixels good, so there is nothing to blank in FITS.
         /// @param[in] name image name
         virtual void makeDefaultMask(const std::string &name);
 
@@ -179,12 +302,76 @@ struct FitsImageAccess : public IImageAccess {
     /// @param[in] history History comment to add
     virtual void addHistory(const std::string &name, const std::string &history);
 
+        //////////////////
+        // Handle management
+        //////////////////
+
+        /// @brief close the given image
+        /// @details The image is removed from the caches, which writes all changes to disk.
+        /// @param[in] name image name
+        virtual void close(const std::string &name);
+
+        /// @brief write all changes to disk
+        /// @details All images open for writing are flushed, but kept open.
+        virtual void flush();
 
     private:
 
+        /// @brief obtain the parsed header of the given image
+        /// @details Changes buffered by the writer of the same image are flushed first.
+        /// @param[in] name image name
+        /// @return shared pointer to the header
+        boost::shared_ptr<FITSHeaderReader> header(const std::string &name) const;
+
+        /// @brief obtain a pixel reader for the given image
+        /// @details Changes buffered by the writer of the same image are flushed first.
+        /// @param[in] name image name
+        /// @return shared pointer to the reader
+        boost::shared_ptr<FITSSliceReader> sliceReader(const std::string &name) const;
+
+        /// @brief drop cached readers of the given image
+        /// @param[in] name image name
+        void dropReaders(const std::string &name);
+
+        /// @brief flush changes buffered by the writer of the given image
+        /// @param[in] name image name
+        void flushWriter(const std::string &name) const;
+
+        /// @brief obtain the direct writer for the given image (parallel mode)
+        /// @details Cached readers of the image are dropped, as the pixels are about to change.
+        /// @param[in] name image name
+        /// @return shared pointer to the writer
+        boost::shared_ptr<FITSDirectWriter> directWriter(const std::string &name);
 
         boost::shared_ptr<FITSImageRW> itsFITSImage;
 
+        /// @brief parsed headers of images
+        mutable ImageHandleCache<FITSHeaderReader> itsHeaders;
+
+        /// @brief images open for reading pixels
+        mutable ImageHandleCache<FITSSliceReader> itsSliceReaders;
+
+        /// @brief images open for writing
+        mutable ImageHandleCache<FITSImageRW> itsWriters;
+
+        /// @brief images open for direct writing (parallel mode)
+        ImageHandleCache<FITSDirectWriter> itsDirectWriters;
+
+        /// @brief true if the parallel write mode is on
+        bool itsParallelWrite;
+
+        /// @brief compression scheme of new images
+        Compression itsCompression;
+
+        /// @brief tile shape for compression (empty for one tile per plane)
+        casacore::IPosition itsCompressionTile;
+
+        /// @brief quantization level for compression
+        float itsQuantizeLevel;
+
+        /// @brief number of free header card slots reserved in new images
+        int itsHeaderReserve;
+
 };
 
 
@@ -0,0 +1,726 @@
+/// @file HDF5ImageAccess.cc
+/// @brief Access HDF5 image
+/// @details This class implements IImageAccess interface for images stored as
+/// HDF5 datasets. Pixels are kept in a chunked dataset with the chunk shape chosen
+/// for the expected access pattern and optional compression. In the parallel write
+/// mode the dataset is allocated contiguously in full when the image is created, so
+/// a number of processes can write disjoint slabs of the same image concurrently.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+#ifdef HAVE_HDF5
+
+#include <askap/imageaccess/HDF5ImageAccess.h>
+#include <askap/imageaccess/ImageView.h>
+#include <askap/dataaccess/AccessTracer.h>
+
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/IO/MemoryIO.h>
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include <hdf5.h>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+ASKAP_LOGGER(logger, ".hdf5ImageAccessor");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace askap {
+namespace accessors {
+
+/// @brief HDF5 identifier closed on destruction
+class HDF5Id : private boost::noncopyable {
+public:
+    /// @brief take ownership of the identifier
+    /// @param[in] id identifier (negative values indicate an error and throw the exception)
+    /// @param[in] closer function to release the identifier
+    /// @param[in] what description of the operation for the error message
+    HDF5Id(hid_t id, herr_t (*closer)(hid_t), const std::string &what) : itsId(id), itsCloser(closer)
+    {
+        ASKAPCHECK(id >= 0, "HDF5 error: unable to " << what);
+    }
+
+    /// @brief destructor, releases the identifier
+    ~HDF5Id() { itsCloser(itsId); }
+
+    /// @brief the identifier
+    operator hid_t() const { return itsId; }
+
+private:
+    /// @brief identifier
+    hid_t itsId;
+
+    /// @brief function to release the identifier
+    herr_t (*itsCloser)(hid_t);
+};
+
+/// @brief open HDF5 image
+/// @details The file and the image dataset are kept open for the lifetime of this object.
+class HDF5ImageHandle : private boost::noncopyable {
+public:
+    /// @brief open the image
+    /// @param[in] fullname file name (including extension)
+    /// @param[in] writable true to open the file for writing
+    HDF5ImageHandle(const std::string &fullname, bool writable) :
+        itsFile(H5Fopen(fullname.c_str(), writable ? H5F_ACC_RDWR : H5F_ACC_RDONLY, H5P_DEFAULT),
+                H5Fclose, "open " + fullname),
+        itsDataset(H5Dopen2(itsFile, "image", H5P_DEFAULT), H5Dclose, "open the image dataset in " + fullname),
+        itsWritable(writable)
+    {
+        const HDF5Id space(H5Dget_space(itsDataset), H5Sclose, "get the dataspace");
+        const int nDim = H5Sget_simple_extent_ndims(space);
+        ASKAPCHECK(nDim >= 0, "HDF5 error: unable to get the number of dimensions of " << fullname);
+        std::vector<hsize_t> dims(std::max(nDim, 1));
+        H5Sget_simple_extent_dims(space, &dims[0], NULL);
+        itsShape.resize(nDim);
+        for (int dim = 0; dim < nDim; ++dim) {
+             itsShape(dim) = dims[nDim - 1 - dim];
+        }
+    }
+
+    /// @brief file identifier
+    hid_t file() const { return itsFile; }
+
+    /// @brief image dataset identifier
+    hid_t dataset() const { return itsDataset; }
+
+    /// @brief true if the file is open for writing
+    bool writable() const { return itsWritable; }
+
+    /// @brief shape of the image
+    const casacore::IPosition& shape() const { return itsShape; }
+
+private:
+    /// @brief file
+    HDF5Id itsFile;
+
+    /// @brief image dataset
+    HDF5Id itsDataset;
+
+    /// @brief true if the file is open for writing
+    bool itsWritable;
+
+    /// @brief shape of the image
+    casacore::IPosition itsShape;
+};
+
+} // namespace accessors
+} // namespace askap
+
+/// @brief file name for the given image
+/// @param[in] name image name
+/// @return file name with extension
+static std::string fileName(const std::string &name)
+{
+    return name + ".h5";
+}
+
+/// @brief select a hyperslab of the image
+/// @details Axes missing in the shape of the selection are assumed to be degenerate.
+/// The order of axes is reversed, as HDF5 uses the C order.
+/// @param[in] space dataspace of the image
+/// @param[in] imageShape shape of the image
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] shape shape of the selection
+/// @param[out] count shape of the selection in the HDF5 order
+static void selectSlab(hid_t space, const casacore::IPosition &imageShape, const casacore::IPosition &blc,
+                       const casacore::IPosition &shape, std::vector<hsize_t> &count)
+{
+    const size_t nDim = imageShape.nelements();
+    ASKAPCHECK(blc.nelements() == nDim, "Mismatch in dimensions - HDF5 image has " << nDim <<
+               " axes, while requested location has " << blc.nelements());
+    ASKAPCHECK(shape.nelements() <= nDim, "Selection with " << shape.nelements() <<
+               " dimensions doesn't fit into " << nDim << "-dimensional image");
+    std::vector<hsize_t> start(nDim);
+    count.assign(nDim, 1);
+    for (size_t dim = 0; dim < nDim; ++dim) {
+         const casacore::Int64 length = dim < shape.nelements() ? shape(dim) : 1;
+         ASKAPCHECK((blc(dim) >= 0) && (blc(dim) + length <= imageShape(dim)), "Selection of shape " << shape <<
+                    " at " << blc << " doesn't fit into the image " << imageShape);
+         start[nDim - 1 - dim] = blc(dim);
+         count[nDim - 1 - dim] = length;
+    }
+    ASKAPCHECK(H5Sselect_hyperslab(space, H5S_SELECT_SET, &start[0], NULL, &count[0], NULL) >= 0,
+               "HDF5 error: unable to select a hyperslab");
+}
+
+/// @brief write an attribute replacing the existing one
+/// @param[in] obj object to attach the attribute to
+/// @param[in] attrName attribute name
+/// @param[in] type datatype of the attribute
+/// @param[in] nElements number of elements
+/// @param[in] data pointer to the data
+static void writeAttribute(hid_t obj, const std::string &attrName, hid_t type, hsize_t nElements,
+                           const void *data)
+{
+    if (H5Aexists(obj, attrName.c_str()) > 0) {
+        ASKAPCHECK(H5Adelete(obj, attrName.c_str()) >= 0, "HDF5 error: unable to replace attribute " << attrName);
+    }
+    const HDF5Id space(H5Screate_simple(1, &nElements, NULL), H5Sclose, "create a dataspace");
+    const HDF5Id attr(H5Acreate2(obj, attrName.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT), H5Aclose,
+                      "create attribute " + attrName);
+    ASKAPCHECK(H5Awrite(attr, type, data) >= 0, "HDF5 error: unable to write attribute " << attrName);
+}
+
+/// @brief write a string attribute replacing the existing one
+/// @param[in] obj object to attach the attribute to
+/// @param[in] attrName attribute name
+/// @param[in] value value of the attribute
+static void writeStringAttribute(hid_t obj, const std::string &attrName, const std::string &value)
+{
+    const HDF5Id type(H5Tcopy(H5T_C_S1), H5Tclose, "create a string type");
+    H5Tset_size(type, std::max(value.size(), size_t(1)));
+    const std::string padded = value.empty() ? std::string(1, '\0') : value;
+    writeAttribute(obj, attrName, type, 1, padded.c_str());
+}
+
+/// @brief read an attribute of the native type
+/// @param[in] obj object the attribute is attached to
+/// @param[in] attrName attribute name
+/// @param[in] type memory datatype
+/// @param[out] data vector of values (empty if the attribute doesn't exist)
+template<typename T>
+static void readAttribute(hid_t obj, const std::string &attrName, hid_t type, std::vector<T> &data)
+{
+    data.clear();
+    if (H5Aexists(obj, attrName.c_str()) <= 0) {
+        return;
+    }
+    const HDF5Id attr(H5Aopen(obj, attrName.c_str(), H5P_DEFAULT), H5Aclose, "open attribute " + attrName);
+    const HDF5Id space(H5Aget_space(attr), H5Sclose, "get the dataspace of attribute " + attrName);
+    const hssize_t nElements = H5Sget_simple_extent_npoints(space);
+    ASKAPCHECK(nElements >= 0, "HDF5 error: unable to get the size of attribute " << attrName);
+    data.resize(nElements);
+    if (nElements > 0) {
+        ASKAPCHECK(H5Aread(attr, type, &data[0]) >= 0, "HDF5 error: unable to read attribute " << attrName);
+    }
+}
+
+/// @brief read a string attribute
+/// @param[in] obj object the attribute is attached to
+/// @param[in] attrName attribute name
+/// @param[out] value value of the attribute
+/// @return false if the attribute doesn't exist
+static bool readStringAttribute(hid_t obj, const std::string &attrName, std::string &value)
+{
+    value.clear();
+    if (H5Aexists(obj, attrName.c_str()) <= 0) {
+        return false;
+    }
+    const HDF5Id attr(H5Aopen(obj, attrName.c_str(), H5P_DEFAULT), H5Aclose, "open attribute " + attrName);
+    const HDF5Id type(H5Aget_type(attr), H5Tclose, "get the type of attribute " + attrName);
+    std::vector<char> buf(H5Tget_size(type) + 1, '\0');
+    ASKAPCHECK(H5Aread(attr, type, &buf[0]) >= 0, "HDF5 error: unable to read attribute " << attrName);
+    value = std::string(&buf[0]);
+    return true;
+}
+
+/// @brief constructor
+/// @param[in] cacheSize maximum number of images kept open, zero means
+/// that images are opened for each call
+HDF5ImageAccess::HDF5ImageAccess(const size_t cacheSize) : itsImages(cacheSize), itsDirectWriters(cacheSize),
+        itsTiling(CasaImageAccess::BALANCED), itsCompression(0), itsParallelWrite(false) {}
+
+/// @brief set the tiling scheme defining the chunk shape of images created afterwards
+/// @param[in] tiling tiling scheme (see CasaImageAccess::makeTileShape)
+void HDF5ImageAccess::setTiling(const CasaImageAccess::Tiling tiling)
+{
+    itsTiling = tiling;
+}
+
+/// @brief set an explicit chunk shape for images created afterwards
+/// @details An empty shape means that the tiling scheme is used (this is the default).
+/// @param[in] chunkShape chunk shape
+void HDF5ImageAccess::setChunkShape(const casacore::IPosition &chunkShape)
+{
+    itsChunkShape = chunkShape;
+}
+
+/// @brief set the compression of images created afterwards
+/// @param[in] level deflate level (1 to 9), zero switches compression off
+void HDF5ImageAccess::setCompression(const int level)
+{
+    ASKAPCHECK((level >= 0) && (level <= 9), "Deflate level should be from 0 to 9, you have " << level);
+    ASKAPCHECK((level == 0) || !itsParallelWrite, "Parallel write mode is not supported for compressed HDF5 images");
+    itsCompression = level;
+}
+
+/// @brief switch the parallel write mode on or off
+/// @param[in] on true to switch the parallel mode on
+void HDF5ImageAccess::setParallelWrite(const bool on)
+{
+    ASKAPCHECK(!on || (itsCompression == 0), "Parallel write mode is not supported for compressed HDF5 images");
+    itsParallelWrite = on;
+}
+
+/// @brief obtain the chunk shape of an existing image
+/// @param[in] name image name
+/// @return chunk shape (empty if the dataset is not chunked)
+casacore::IPosition HDF5ImageAccess::chunkShape(const std::string &name) const
+{
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name);
+    const HDF5Id dcpl(H5Dget_create_plist(img->dataset()), H5Pclose, "get the dataset properties");
+    if (H5Pget_layout(dcpl) != H5D_CHUNKED) {
+        return casacore::IPosition();
+    }
+    const int nDim = img->shape().nelements();
+    std::vector<hsize_t> dims(std::max(nDim, 1));
+    ASKAPCHECK(H5Pget_chunk(dcpl, nDim, &dims[0]) == nDim, "HDF5 error: unable to get the chunk shape of " << name);
+    casacore::IPosition result(nDim);
+    for (int dim = 0; dim < nDim; ++dim) {
+         result(dim) = dims[nDim - 1 - dim];
+    }
+    return result;
+}
+
+// reading methods
+
+/// @brief obtain the shape
+/// @param[in] name image name
+/// @return full shape of the given image
+casacore::IPosition HDF5ImageAccess::shape(const std::string &name) const
+{
+    return image(name)->shape();
+}
+
+/// @brief read full image
+/// @param[in] name image name
+/// @return array with pixels
+casacore::Array<float> HDF5ImageAccess::read(const std::string &name) const
+{
+    ASKAPLOG_INFO_STR(logger, "Reading HDF5 image " << name);
+    const casacore::IPosition imageShape = shape(name);
+    return read(name, casacore::IPosition(imageShape.nelements(), 0), imageShape - 1);
+}
+
+/// @brief read part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return array with pixels for the selection only
+casacore::Array<float> HDF5ImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                                             const casacore::IPosition &trc) const
+{
+    const AccessTracer::Scope trace("read", name, "imageaccess");
+    ASKAPLOG_INFO_STR(logger, "Reading a slice of the HDF5 image " << name << " from " << blc << " to " << trc);
+    ASKAPCHECK(blc.nelements() == trc.nelements(), "blc and trc should have the same dimensions");
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name);
+    casacore::Array<float> result(trc - blc + 1);
+    const HDF5Id space(H5Dget_space(img->dataset()), H5Sclose, "get the dataspace");
+    std::vector<hsize_t> count;
+    selectSlab(space, img->shape(), blc, result.shape(), count);
+    const HDF5Id memSpace(H5Screate_simple(count.size(), &count[0], NULL), H5Sclose, "create a dataspace");
+    ASKAPCHECK(H5Dread(img->dataset(), H5T_NATIVE_FLOAT, memSpace, space, H5P_DEFAULT, result.data()) >= 0,
+               "HDF5 error: unable to read pixels of " << name);
+    return result;
+}
+
+/// @brief obtain coordinate system info
+/// @param[in] name image name
+/// @return coordinate system object
+casacore::CoordinateSystem HDF5ImageAccess::coordSys(const std::string &name) const
+{
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name);
+    std::vector<unsigned char> buf;
+    readAttribute(img->dataset(), "coordsys", H5T_NATIVE_UCHAR, buf);
+    ASKAPCHECK(buf.size() > 0, "HDF5 image " << name << " has no coordinate system");
+    casacore::Record rec;
+    casacore::MemoryIO mio(&buf[0], buf.size());
+    casacore::AipsIO aio(&mio);
+    aio >> rec;
+    const boost::scoped_ptr<casacore::CoordinateSystem> csys(casacore::CoordinateSystem::restore(rec, "coordsys"));
+    ASKAPCHECK(csys, "Unable to restore the coordinate system of HDF5 image " << name);
+    return *csys;
+}
+
+/// @brief obtain coordinate system info for part of an image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return coordinate system object
+casacore::CoordinateSystem HDF5ImageAccess::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    return ImageView::sliceCoordSys(coordSys(name), blc, trc);
+}
+
+/// @brief obtain beam info
+/// @param[in] name image name
+/// @return beam info vector
+casacore::Vector<casacore::Quantum<double> > HDF5ImageAccess::beamInfo(const std::string &name) const
+{
+    std::vector<double> beam;
+    readAttribute(image(name)->dataset(), "beam", H5T_NATIVE_DOUBLE, beam);
+    casacore::Vector<casacore::Quantum<double> > result(3, casacore::Quantum<double>(0., "rad"));
+    if (beam.size() == 3) {
+        for (size_t i = 0; i < 3; ++i) {
+             result[i] = casacore::Quantum<double>(beam[i], "rad");
+        }
+    }
+    return result;
+}
+
+/// @brief obtain per-channel beam info
+/// @details The beams are kept in the "beams" dataset (one row of major, minor and position
+/// angle in radians per channel) rather than in an attribute, as the latter is limited in size.
+/// @param[in] name image name
+/// @return one beam per channel, empty if the image has no per-channel beams
+IImageAccess::BeamList HDF5ImageAccess::beamList(const std::string &name) const
+{
+    BeamList result;
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name);
+    if (H5Lexists(img->file(), "beams", H5P_DEFAULT) <= 0) {
+        return result;
+    }
+    const HDF5Id dataset(H5Dopen2(img->file(), "beams", H5P_DEFAULT), H5Dclose, "open the beams dataset");
+    const HDF5Id space(H5Dget_space(dataset), H5Sclose, "get the dataspace of the beams");
+    const hssize_t nElements = H5Sget_simple_extent_npoints(space);
+    ASKAPCHECK((nElements >= 0) && (nElements % 3 == 0), "HDF5 error: malformed beams dataset in " << name);
+    std::vector<double> beams(nElements);
+    if (nElements > 0) {
+        ASKAPCHECK(H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &beams[0]) >= 0,
+                   "HDF5 error: unable to read the beams of " << name);
+    }
+    result.resize(nElements / 3);
+    for (size_t chan = 0; chan < result.size(); ++chan) {
+         result[chan].resize(3);
+         for (size_t i = 0; i < 3; ++i) {
+              result[chan][i] = casacore::Quantum<double>(beams[3 * chan + i], "rad");
+         }
+    }
+    return result;
+}
+
+/// @brief obtain pixel units
+/// @param[in] name image name
+/// @return units string
+std::string HDF5ImageAccess::getUnits(const std::string &name) const
+{
+    std::string units;
+    readStringAttribute(image(name)->dataset(), "units", units);
+    return units;
+}
+
+/// @brief Get a particular keyword from the image metadata (A.K.A header)
+/// @details This reads a given keyword to the image metadata.
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+std::string HDF5ImageAccess::getMetadataKeyword(const std::string &name, const std::string &keyword) const
+{
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name);
+    const HDF5Id group(H5Gopen2(img->file(), "keywords", H5P_DEFAULT), H5Gclose, "open the keywords group");
+    std::string value;
+    if (!readStringAttribute(group, keyword, value)) {
+        ASKAPLOG_WARN_STR(logger, "Keyword " << keyword << " is not defined in metadata for image " << name);
+    }
+    return value;
+}
+
+// writing methods
+
+/// @brief create a new image
+/// @details A call to this method should preceed any write calls.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+void HDF5ImageAccess::create(const std::string &name, const casacore::IPosition &shape,
+                             const casacore::CoordinateSystem &csys)
+{
+    ASKAPLOG_INFO_STR(logger, "Creating a new HDF5 image " << name << " with the shape " << shape);
+    // images with the same name kept open would be stale after this call
+    close(name);
+    const size_t nDim = shape.nelements();
+    std::vector<hsize_t> dims(nDim);
+    for (size_t dim = 0; dim < nDim; ++dim) {
+         dims[nDim - 1 - dim] = shape(dim);
+    }
+    const std::string fullname = fileName(name);
+    const HDF5Id file(H5Fcreate(fullname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT), H5Fclose,
+                      "create " + fullname);
+    const HDF5Id space(H5Screate_simple(nDim, &dims[0], NULL), H5Sclose, "create a dataspace");
+    const HDF5Id dcpl(H5Pcreate(H5P_DATASET_CREATE), H5Pclose, "create dataset properties");
+    // the object header is not touched by writes then
+    H5Pset_obj_track_times(dcpl, false);
+    hid_t type = H5T_NATIVE_FLOAT;
+    if (itsParallelWrite) {
+        // other processes write directly into the data, so it has to be allocated in full
+        H5Pset_layout(dcpl, H5D_CONTIGUOUS);
+        H5Pset_alloc_time(dcpl, H5D_ALLOC_TIME_EARLY);
+        type = H5T_IEEE_F32BE;
+    } else {
+        const casacore::IPosition chunk = itsChunkShape.nelements() > 0 ? itsChunkShape :
+                CasaImageAccess::makeTileShape(shape, csys, itsTiling);
+        ASKAPCHECK(chunk.nelements() == nDim, "Chunk shape " << chunk << " doesn't match the image shape " << shape);
+        std::vector<hsize_t> chunkDims(nDim);
+        for (size_t dim = 0; dim < nDim; ++dim) {
+             chunkDims[nDim - 1 - dim] = std::max(casacore::Int64(1), std::min(chunk(dim), shape(dim)));
+        }
+        ASKAPLOG_DEBUG_STR(logger, "Chunk shape: " << chunk);
+        ASKAPCHECK(H5Pset_chunk(dcpl, nDim, &chunkDims[0]) >= 0, "HDF5 error: unable to set the chunk shape");
+        if (itsCompression > 0) {
+            H5Pset_shuffle(dcpl);
+            ASKAPCHECK(H5Pset_deflate(dcpl, itsCompression) >= 0, "HDF5 error: unable to set up compression");
+        }
+    }
+    const HDF5Id dataset(H5Dcreate2(file, "image", type, space, H5P_DEFAULT, dcpl, H5P_DEFAULT), H5Dclose,
+                         "create the image dataset in " + fullname);
+    // the coordinate system is stored as a serialised record
+    casacore::Record rec;
+    ASKAPCHECK(csys.save(rec, "coordsys"), "Unable to store the coordinate system");
+    casacore::MemoryIO mio;
+    {
+        casacore::AipsIO aio(&mio);
+        aio << rec;
+    }
+    writeAttribute(dataset, "coordsys", H5T_NATIVE_UCHAR, mio.length(), mio.getBuffer());
+    const HDF5Id keywords(H5Gcreate2(file, "keywords", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose,
+                          "create the keywords group");
+    const HDF5Id history(H5Gcreate2(file, "history", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose,
+                         "create the history group");
+}
+
+/// @brief write full image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+void HDF5ImageAccess::write(const std::string &name, const casacore::Array<float> &arr)
+{
+    write(name, arr, casacore::IPosition(arr.ndim(), 0));
+}
+
+/// @brief write a slice of an image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void HDF5ImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
+                            const casacore::IPosition &where)
+{
+    const AccessTracer::Scope trace("write", name, "imageaccess");
+    ASKAPLOG_INFO_STR(logger, "Writing a slice with the shape " << arr.shape() << " into the HDF5 image " <<
+                      name << " at " << where);
+    if (itsParallelWrite) {
+        directWriter(name)->write(arr, where);
+        return;
+    }
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name, true);
+    const HDF5Id space(H5Dget_space(img->dataset()), H5Sclose, "get the dataspace");
+    std::vector<hsize_t> count;
+    selectSlab(space, img->shape(), where, arr.shape(), count);
+    const HDF5Id memSpace(H5Screate_simple(count.size(), &count[0], NULL), H5Sclose, "create a dataspace");
+    bool deleteIt = false;
+    const float *data = arr.getStorage(deleteIt);
+    const herr_t status = H5Dwrite(img->dataset(), H5T_NATIVE_FLOAT, memSpace, space, H5P_DEFAULT, data);
+    arr.freeStorage(data, deleteIt);
+    ASKAPCHECK(status >= 0, "HDF5 error: unable to write pixels of " << name);
+}
+
+/// @brief write a slice of an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void HDF5ImageAccess::writeMask(const std::string &, const casacore::Array<bool> &, const casacore::IPosition &)
+{
+    ASKAPLOG_INFO_STR(logger, "HDF5 pixel mask not yet implemented");
+}
+
+/// @brief write an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+void HDF5ImageAccess::writeMask(const std::string &, const casacore::Array<bool> &)
+{
+    ASKAPLOG_INFO_STR(logger, "HDF5 pixel mask not yet implemented");
+}
+
+/// @brief set brightness units of the image
+/// @param[in] name image name
+/// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+void HDF5ImageAccess::setUnits(const std::string &name, const std::string &units)
+{
+    writeStringAttribute(image(name, true)->dataset(), "units", units);
+}
+
+/// @brief set restoring beam info
+/// @param[in] name image name
+/// @param[in] maj major axis in radians
+/// @param[in] min minor axis in radians
+/// @param[in] pa position angle in radians
+void HDF5ImageAccess::setBeamInfo(const std::string &name, double maj, double min, double pa)
+{
+    const double beam[3] = {maj, min, pa};
+    writeAttribute(image(name, true)->dataset(), "beam", H5T_NATIVE_DOUBLE, 3, beam);
+}
+
+/// @brief set per-channel beam info
+/// @param[in] name image name
+/// @param[in] beams one beam per channel
+void HDF5ImageAccess::setBeamList(const std::string &name, const BeamList &beams)
+{
+    const casacore::uInt nChan = nChannels(shape(name), coordSys(name));
+    ASKAPCHECK(beams.size() == nChan, "Number of beams (" << beams.size() << ") should match the number of channels (" <<
+               nChan << ") of " << name);
+    std::vector<double> buf(3 * beams.size());
+    for (size_t chan = 0; chan < beams.size(); ++chan) {
+         ASKAPCHECK(beams[chan].nelements() == 3, "Beam for channel " << chan << " should have 3 elements");
+         for (size_t i = 0; i < 3; ++i) {
+              buf[3 * chan + i] = beams[chan][i].getValue("rad");
+         }
+    }
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name, true);
+    if (H5Lexists(img->file(), "beams", H5P_DEFAULT) > 0) {
+        ASKAPCHECK(H5Ldelete(img->file(), "beams", H5P_DEFAULT) >= 0, "HDF5 error: unable to replace the beams of " << name);
+    }
+    const hsize_t dims[2] = {beams.size(), 3};
+    const HDF5Id space(H5Screate_simple(2, dims, NULL), H5Sclose, "create a dataspace");
+    const HDF5Id dataset(H5Dcreate2(img->file(), "beams", H5T_IEEE_F64LE, space, H5P_DEFAULT, H5P_DEFAULT,
+                         H5P_DEFAULT), H5Dclose, "create the beams dataset");
+    if (buf.size() > 0) {
+        ASKAPCHECK(H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &buf[0]) >= 0,
+                   "HDF5 error: unable to write the beams of " << name);
+    }
+}
+
+/// @brief apply mask to image
+/// @param[in] name image name
+void HDF5ImageAccess::makeDefaultMask(const std::string &)
+{
+    ASKAPLOG_INFO_STR(logger, "HDF5 pixel mask not yet implemented");
+}
+
+/// @brief Set a particular keyword for the metadata (A.K.A header)
+/// @details This adds a given keyword to the image metadata.
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @param[in] value The value for the keyword, in string format
+/// @param[in] desc A description of the keyword (not stored)
+void HDF5ImageAccess::setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                         const std::string value, const std::string &)
+{
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name, true);
+    const HDF5Id group(H5Gopen2(img->file(), "keywords", H5P_DEFAULT), H5Gclose, "open the keywords group");
+    writeStringAttribute(group, keyword, value);
+}
+
+/// @brief Add a HISTORY message to the image metadata
+/// @details Messages are numbered in the order they are added.
+/// @param[in] name Image name
+/// @param[in] history History comment to add
+void HDF5ImageAccess::addHistory(const std::string &name, const std::string &history)
+{
+    const boost::shared_ptr<HDF5ImageHandle> img = image(name, true);
+    const HDF5Id group(H5Gopen2(img->file(), "history", H5P_DEFAULT), H5Gclose, "open the history group");
+    for (size_t index = 0; ; ++index) {
+         std::ostringstream os;
+         os << index;
+         if (H5Aexists(group, os.str().c_str()) <= 0) {
+             writeStringAttribute(group, os.str(), history);
+             break;
+         }
+    }
+}
+
+/// @brief close the given image
+/// @details The image is removed from the caches, which writes all changes to disk.
+/// @param[in] name image name
+void HDF5ImageAccess::close(const std::string &name)
+{
+    itsImages.remove(name);
+    itsDirectWriters.remove(name);
+}
+
+/// @brief write all changes to disk
+/// @details All images open for writing are flushed, but kept open.
+void HDF5ImageAccess::flush()
+{
+    const std::vector<boost::shared_ptr<HDF5ImageHandle> > images = itsImages.handles();
+    for (size_t i = 0; i < images.size(); ++i) {
+         if (images[i]->writable()) {
+             ASKAPCHECK(H5Fflush(images[i]->file(), H5F_SCOPE_LOCAL) >= 0, "HDF5 error: unable to flush");
+         }
+    }
+    const std::vector<boost::shared_ptr<FITSDirectWriter> > directWriters = itsDirectWriters.handles();
+    for (size_t i = 0; i < directWriters.size(); ++i) {
+         directWriters[i]->flush();
+    }
+}
+
+/// @brief obtain an open image
+/// @details The image is opened and added to the cache if necessary. An image open
+/// read-only is reopened if write access is requested.
+/// @param[in] name image name
+/// @param[in] forWriting true if the image is about to be modified
+/// @return shared pointer to the image
+boost::shared_ptr<HDF5ImageHandle> HDF5ImageAccess::image(const std::string &name, bool forWriting) const
+{
+    boost::shared_ptr<HDF5ImageHandle> img = itsImages.find(name);
+    if (img && forWriting && !img->writable()) {
+        // HDF5 doesn't allow the same file to be open with different access flags
+        itsImages.remove(name);
+        img.reset();
+    }
+    if (!img) {
+        img.reset(new HDF5ImageHandle(fileName(name), forWriting));
+        itsImages.add(name, img);
+    }
+    return img;
+}
+
+/// @brief obtain the direct writer for the given image (parallel mode)
+/// @details The cached handle of the image is dropped, as the pixels are about to change.
+/// @param[in] name image name
+/// @return shared pointer to the writer
+boost::shared_ptr<FITSDirectWriter> HDF5ImageAccess::directWriter(const std::string &name)
+{
+    boost::shared_ptr<FITSDirectWriter> writer = itsDirectWriters.find(name);
+    if (!writer) {
+        const boost::shared_ptr<HDF5ImageHandle> img = image(name);
+        const HDF5Id type(H5Dget_type(img->dataset()), H5Tclose, "get the datatype");
+        ASKAPCHECK(H5Tequal(type, H5T_IEEE_F32BE) > 0, "HDF5 image " << name <<
+                   " is not set up for parallel writing (big-endian floats expected)");
+        const haddr_t offset = H5Dget_offset(img->dataset());
+        ASKAPCHECK(offset != HADDR_UNDEF, "HDF5 image " << name <<
+                   " is not allocated contiguously, it should be created in the parallel write mode");
+        const casacore::IPosition imageShape = img->shape();
+        itsImages.remove(name);
+        writer.reset(new FITSDirectWriter(fileName(name), static_cast<long long>(offset), imageShape));
+        itsDirectWriters.add(name, writer);
+    } else {
+        itsImages.remove(name);
+    }
+    return writer;
+}
+
+#endif // HAVE_HDF5
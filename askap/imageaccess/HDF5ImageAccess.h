@@ -0,0 +1,289 @@
+/// @file HDF5ImageAccess.h
+/// @brief Access HDF5 image
+/// @details This class implements IImageAccess interface for images stored as
+/// HDF5 datasets. Pixels are kept in a chunked dataset with the chunk shape chosen
+/// for the expected access pattern and optional compression. In the parallel write
+/// mode the dataset is allocated contiguously in full when the image is created, so
+/// a number of processes can write disjoint slabs of the same image concurrently.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_HDF5_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_HDF5_IMAGE_ACCESS_H
+
+#ifdef HAVE_HDF5
+
+#include <boost/shared_ptr.hpp>
+
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/FITSDirectWriter.h>
+#include <askap/imageaccess/ImageHandleCache.h>
+
+namespace askap {
+namespace accessors {
+
+/// @brief open HDF5 image (defined in the .cc file)
+class HDF5ImageHandle;
+
+/// @brief Access HDF5 image
+/// @details This class implements IImageAccess interface for HDF5 images. The image
+/// is stored in the dataset "image" of the file <name>.h5, the axes are in the reverse
+/// order (as HDF5 uses the C order), so the layout in the file is the same as that of
+/// casacore arrays. The coordinate system (as a serialised casacore record), brightness
+/// units and the restoring beam are attributes of this dataset, other keywords and history
+/// are attributes of the "keywords" and "history" groups.
+/// The chunk shape follows the tiling scheme or is given explicitly (as for CasaImageAccess)
+/// and the deflate compression can be switched on.
+/// In the parallel write mode the dataset is stored contiguously as big-endian floats
+/// and is allocated in full by create. Pixels are then written directly into the file by
+/// FITSDirectWriter, so a number of processes can write disjoint slabs of the same image.
+/// As for FITS, the image should be created by one process before others start writing and
+/// attributes should only be changed while no other process is writing. Compression is not
+/// available in this mode. Pixel masks are not supported.
+/// @ingroup imageaccess
+struct HDF5ImageAccess : public IImageAccess {
+
+    public:
+
+        /// @brief constructor
+        /// @param[in] cacheSize maximum number of images kept open, zero means
+        /// that images are opened for each call
+        explicit HDF5ImageAccess(const size_t cacheSize = 8);
+
+        /// @brief set the tiling scheme defining the chunk shape of images created afterwards
+        /// @param[in] tiling tiling scheme (see CasaImageAccess::makeTileShape)
+        void setTiling(const CasaImageAccess::Tiling tiling);
+
+        /// @brief set an explicit chunk shape for images created afterwards
+        /// @details An empty shape means that the tiling scheme is used (this is the default).
+        /// @param[in] chunkShape chunk shape
+        void setChunkShape(const casacore::IPosition &chunkShape);
+
+        /// @brief set the compression of images created afterwards
+        /// @param[in] level deflate level (1 to 9), zero switches compression off
+        void setCompression(const int level);
+
+        /// @brief switch the parallel write mode on or off
+        /// @param[in] on true to switch the parallel mode on
+        void setParallelWrite(const bool on);
+
+        /// @brief check whether the parallel write mode is on
+        /// @return true if pixels are written directly into the file
+        bool parallelWrite() const { return itsParallelWrite; }
+
+        /// @brief obtain the chunk shape of an existing image
+        /// @param[in] name image name
+        /// @return chunk shape (empty if the dataset is not chunked)
+        casacore::IPosition chunkShape(const std::string &name) const;
+
+        //////////////////
+        // Reading methods
+        //////////////////
+
+        /// @brief obtain the shape
+        /// @param[in] name image name
+        /// @return full shape of the given image
+        virtual casacore::IPosition shape(const std::string &name) const;
+
+        /// @brief read full image
+        /// @param[in] name image name
+        /// @return array with pixels
+        virtual casacore::Array<float> read(const std::string &name) const;
+
+        /// @brief read part of the image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @return array with pixels for the selection only
+        virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
+                                        const casacore::IPosition &trc) const;
+
+        /// @brief other versions of read are inherited
+        using IImageAccess::read;
+
+        /// @brief obtain coordinate system info
+        /// @param[in] name image name
+        /// @return coordinate system object
+        virtual casacore::CoordinateSystem coordSys(const std::string &name) const;
+
+        /// @brief obtain coordinate system info for part of an image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @return coordinate system object
+        virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+                const casacore::IPosition &trc) const;
+
+        /// @brief obtain beam info
+        /// @param[in] name image name
+        /// @return beam info vector
+        virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const;
+
+        /// @brief obtain per-channel beam info
+        /// @param[in] name image name
+        /// @return one beam per channel, empty if the image has no per-channel beams
+        virtual BeamList beamList(const std::string &name) const;
+
+        /// @brief obtain pixel units
+        /// @param[in] name image name
+        /// @return units string
+        virtual std::string getUnits(const std::string &name) const;
+
+        /// @brief Get a particular keyword from the image metadata (A.K.A header)
+        /// @details This reads a given keyword to the image metadata.
+        /// @param[in] name Image name
+        /// @param[in] keyword The name of the metadata keyword
+        virtual std::string getMetadataKeyword(const std::string &name, const std::string &keyword) const;
+
+        //////////////////
+        // Writing methods
+        //////////////////
+
+        /// @brief create a new image
+        /// @details A call to this method should preceed any write calls.
+        /// @param[in] name image name
+        /// @param[in] shape full shape of the image
+        /// @param[in] csys coordinate system of the full image
+        virtual void create(const std::string &name, const casacore::IPosition &shape,
+                            const casacore::CoordinateSystem &csys);
+
+        /// @brief write full image
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        virtual void write(const std::string &name, const casacore::Array<float> &arr);
+
+        /// @brief write a slice of an image
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void write(const std::string &name, const casacore::Array<float> &arr,
+                           const casacore::IPosition &where);
+
+        /// @brief write a slice of an image mask
+        /// @details Masks are not supported, this method does nothing.
+        /// @param[in] name image name
+        /// @param[in] mask array with mask
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                               const casacore::IPosition &where);
+
+        /// @brief write an image mask
+        /// @details Masks are not supported, this method does nothing.
+        /// @param[in] name image name
+        /// @param[in] mask array with mask
+        virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask);
+
+        /// @brief set brightness units of the image
+        /// @param[in] name image name
+        /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+        virtual void setUnits(const std::string &name, const std::string &units);
+
+        /// @brief set restoring beam info
+        /// @param[in] name image name
+        /// @param[in] maj major axis in radians
+        /// @param[in] min minor axis in radians
+        /// @param[in] pa position angle in radians
+        virtual void setBeamInfo(const std::string &name, double maj, double min, double pa);
+
+        /// @brief set per-channel beam info
+        /// @param[in] name image name
+        /// @param[in] beams one beam per channel
+        virtual void setBeamList(const std::string &name, const BeamList &beams);
+
+        /// @brief apply mask to image
+        /// @details Masks are not supported, this method does nothing.
+        /// @param[in] name image name
+        virtual void makeDefaultMask(const std::string &name);
+
+        /// @brief Set a particular keyword for the metadata (A.K.A header)
+        /// @details This adds a given keyword to the image metadata.
+        /// @param[in] name Image name
+        /// @param[in] keyword The name of the metadata keyword
+        /// @param[in] value The value for the keyword, in string format
+        /// @param[in] desc A description of the keyword (not stored)
+        virtual void setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                        const std::string value, const std::string &desc = "");
+
+        /// @brief Add a HISTORY message to the image metadata
+        /// @param[in] name Image name
+        /// @param[in] history History comment to add
+        virtual void addHistory(const std::string &name, const std::string &history);
+
+        //////////////////
+        // Handle management
+        //////////////////
+
+        /// @brief close the given image
+        /// @details The image is removed from the caches, which writes all changes to disk.
+        /// @param[in] name image name
+        virtual void close(const std::string &name);
+
+        /// @brief write all changes to disk
+        /// @details All images open for writing are flushed, but kept open.
+        virtual void flush();
+
+    private:
+
+        /// @brief obtain an open image
+        /// @details The image is opened and added to the cache if necessary. An image open
+        /// read-only is reopened if write access is requested.
+        /// @param[in] name image name
+        /// @param[in] forWriting true if the image is about to be modified
+        /// @return shared pointer to the image
+        boost::shared_ptr<HDF5ImageHandle> image(const std::string &name, bool forWriting = false) const;
+
+        /// @brief obtain the direct writer for the given image (parallel mode)
+        /// @details The cached handle of the image is dropped, as the pixels are about to change.
+        /// @param[in] name image name
+        /// @return shared pointer to the writer
+        boost::shared_ptr<FITSDirectWriter> directWriter(const std::string &name);
+
+        /// @brief images kept open
+        mutable ImageHandleCache<HDF5ImageHandle> itsImages;
+
+        /// @brief images open for direct writing (parallel mode)
+        ImageHandleCache<FITSDirectWriter> itsDirectWriters;
+
+        /// @brief tiling scheme defining the chunk shape of new images
+        CasaImageAccess::Tiling itsTiling;
+
+        /// @brief explicit chunk shape of new images (empty to use the tiling scheme)
+        casacore::IPosition itsChunkShape;
+
+        /// @brief deflate level of new images (0 for no compression)
+        int itsCompression;
+
+        /// @brief true if the parallel write mode is on
+        bool itsParallelWrite;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // HAVE_HDF5
+
+#endif
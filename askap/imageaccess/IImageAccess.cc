@@ -32,14 +32,421 @@
 ///
 
 #include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/CutoutGrouper.h>
+#include <askap/imageaccess/ImagePlaneIterator.h>
+#include <askap/imageaccess/ImagePlaneWriter.h>
+#include <askap/imageaccess/ImageRegionLock.h>
+#include <askap/imageaccess/ImageView.h>
+#include <askap/imageaccess/SpectrumExtractor.h>
+#include <askap/askap/AskapError.h>
+
+#include <casacore/casa/Arrays/ArrayMath.h>
+
+#include <boost/thread/locks.hpp>
+
+#include <algorithm>
 
 namespace askap {
 
 namespace accessors {
 
+namespace {
+
+/// @brief give the array the shape of the accumulated slice
+/// @details Axes missing in the shape of the array are degenerate, the array is copied
+/// only if it has to be reformed and its storage is not contiguous.
+/// @param[in] arr array passed to accumulate
+/// @param[in] shape shape of the slice
+/// @return array of the given shape referencing the same pixels where possible
+casacore::Array<float> sliceArray(const casacore::Array<float> &arr, const casacore::IPosition &shape)
+{
+    if (arr.shape().isEqual(shape)) {
+        return arr;
+    }
+    const casacore::Array<float> contiguous = arr.contiguousStorage() ? arr : arr.copy();
+    return contiguous.reform(shape);
+}
+
+} // anonymous namespace
+
 /// @brief void virtual desctructor, to keep the compiler happy
 IImageAccess::~IImageAccess() {}
 
+/// @brief read part of the image into the given buffer
+/// @details The buffer is only resized if its shape differs from that of the
+/// selection, so it can be reused for a sequence of reads of the same size (e.g. planes
+/// of a cube). The buffer always holds a copy of the pixels. The default implementation
+/// copies the result of the by-value read, implementations which can read directly into
+/// the buffer should override it.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill
+void IImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                        const casacore::IPosition &trc, casacore::Array<float> &buffer) const
+{
+    const casacore::Array<float> pixels = read(name, blc, trc);
+    if (!buffer.shape().isEqual(pixels.shape())) {
+        buffer.resize(pixels.shape());
+    }
+    buffer = pixels;
+}
+
+/// @brief read part of the image into preallocated memory
+/// @details The default implementation wraps the memory into an array and calls the
+/// buffer version of read, so implementations only need to override that one.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] data pointer to the memory for (trc-blc+1).product() pixels in the Fortran order
+void IImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                        const casacore::IPosition &trc, float *data) const
+{
+    ASKAPCHECK(data != NULL, "Null pointer is passed to read a slice of "<<name);
+    ASKAPCHECK(blc.nelements() == trc.nelements(), "Corners of the selection have different dimensions: "<<
+               blc<<" and "<<trc);
+    casacore::Array<float> buffer(trc - blc + 1, data, casacore::SHARE);
+    read(name, blc, trc, buffer);
+    // a buffer of the matching shape is filled in place
+    ASKAPDEBUGASSERT(buffer.data() == data);
+}
+
+/// @brief read a number of cutouts
+/// @details This method is intended for reading many small parts of the same image
+/// (e.g. in source finding). The default implementation reads cutouts in the order of
+/// their position in the image, overlapping or adjacent cutouts are read together as
+/// their bounding box (see CutoutGrouper). Implementations with a more efficient way of
+/// reading should override it.
+/// @param[in] name image name
+/// @param[in] blc bottom left corners of the cutouts
+/// @param[in] trc top right corners of the cutouts, same size as blc
+/// @param[out] cutouts arrays with pixels, one per cutout
+void IImageAccess::readCutouts(const std::string &name, const std::vector<casacore::IPosition> &blc,
+                               const std::vector<casacore::IPosition> &trc,
+                               std::vector<casacore::Array<float> > &cutouts) const
+{
+    const CutoutGrouper grouper(blc, trc);
+    cutouts.resize(blc.size());
+    for (std::vector<CutoutGrouper::Group>::const_iterator it = grouper.groups().begin();
+         it != grouper.groups().end(); ++it) {
+         if (it->members.size() == 1) {
+             cutouts[it->members[0]].reference(read(name, it->blc, it->trc));
+         } else {
+             CutoutGrouper::extract(*it, read(name, it->blc, it->trc), blc, trc, cutouts);
+         }
+    }
+}
+
+/// @brief extract spectra at a number of positions
+/// @details This method is intended for extracting many spectra from the same cube (e.g. in
+/// source characterisation). Positions are grouped by the storage chunk they belong to (e.g. tiles
+/// of CASA images or planes of FITS images, see storageChunk), every chunk is read once for all its
+/// positions and the values are scattered into the output (see SpectrumExtractor). The spectral axis
+/// is that of the spectral coordinate or the last axis if the image has no spectral coordinate.
+/// @param[in] name image name
+/// @param[in] positions pixel positions (the element for the spectral axis is ignored)
+/// @param[in] firstChannel first channel to extract
+/// @param[in] nChan number of channels to extract
+/// @param[out] spectra extracted spectra, resized to positions.size() x nChan
+/// @param[in] nThreads number of threads to use
+void IImageAccess::readSpectra(const std::string &name, const std::vector<casacore::IPosition> &positions,
+                               casacore::uInt firstChannel, casacore::uInt nChan,
+                               casacore::Matrix<float> &spectra, casacore::uInt nThreads) const
+{
+    const casacore::IPosition imageShape = shape(name);
+    SpectrumExtractor extractor(*this, name, spectralAxis(imageShape, coordSys(name)),
+                                storageChunk(name, imageShape));
+    extractor.extract(positions, firstChannel, nChan, spectra, nThreads);
+}
+
+/// @brief obtain an iterator to read the image plane by plane
+/// @details The iterator keeps two planes in memory and (optionally) reads the next plane
+/// in a background thread while the current one is processed. This accessor should not be
+/// used by other code until the iteration is finished. The default implementation uses the
+/// buffer version of read.
+/// @param[in] name image name
+/// @param[in] async if true, the next plane is read in a background thread
+/// @return shared pointer to the iterator positioned at the first plane
+boost::shared_ptr<ImagePlaneIterator> IImageAccess::planeIterator(const std::string &name, bool async) const
+{
+    return boost::shared_ptr<ImagePlaneIterator>(new ImagePlaneIterator(*this, name, async));
+}
+
+/// @brief compute a value for each plane of an image
+/// @details Planes are read one at a time and reduced by a number of threads (see
+/// ImagePlaneReducer), so the whole image is never kept in memory. This is intended for
+/// statistics like per-channel rms or median (see ImagePlaneReducer::rms and others).
+/// @param[in] name image name
+/// @param[in] reduction functor computing a value from the pixels of one plane
+/// @param[in] axis axis to keep, one value is computed per pixel along this axis
+/// @param[in] nThreads number of threads to use
+/// @return one value per plane
+casacore::Vector<double> IImageAccess::reducePlanes(const std::string &name,
+        const ImagePlaneReducer::Reduction &reduction, casacore::uInt axis, casacore::uInt nThreads) const
+{
+    ImagePlaneReducer reducer(*this, name, axis);
+    return reducer.reduce(reduction, nThreads);
+}
+
+/// @brief obtain coordinate system info for part of an image
+/// @details The default implementation shifts the reference pixel of the coordinate system
+/// of the full image (see ImageView::sliceCoordSys), no subimage is constructed.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return coordinate system object
+casacore::CoordinateSystem IImageAccess::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    return ImageView::sliceCoordSys(coordSys(name), blc, trc);
+}
+
+/// @brief obtain a view of part of an image
+/// @details The view reads nothing on construction, its coordinate system is computed
+/// arithmetically and pixels are read via this accessor when requested. Views of
+/// the view (see ImageView::subView) share the coordinate system of the full image.
+/// This accessor should outlive the view.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the region
+/// @param[in] trc top right corner of the region (inclusive)
+/// @return shared pointer to the view
+boost::shared_ptr<ImageView> IImageAccess::view(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    return boost::shared_ptr<ImageView>(new ImageView(*this, name, blc, trc));
+}
+
+/// @brief obtain per-channel beam info
+/// @details The beams travel with the image (e.g. a beam set for CASA images or the
+/// BEAMS binary table for FITS images). The default implementation returns an empty list.
+/// @param[in] name image name
+/// @return one beam per channel, empty if the image has no per-channel beams
+IImageAccess::BeamList IImageAccess::beamList(const std::string &) const
+{
+    return BeamList();
+}
+
+/// @brief set per-channel beam info
+/// @details The number of beams should match the length of the spectral axis (or the
+/// number of planes if there is no spectral axis). The default implementation throws
+/// an exception.
+/// @param[in] name image name
+/// @param[in] beams one beam per channel
+void IImageAccess::setBeamList(const std::string &name, const BeamList &)
+{
+    ASKAPTHROW(AskapError, "Per-channel beams are not supported for image "<<name);
+}
+
+/// @brief obtain a writer to stream the image plane by plane
+/// @details The writer keeps at most two planes in memory and (optionally) does the
+/// actual writes in a background thread. The image should be created first. This 
+/// accessor should not be used by other code until the writer is closed.
+/// The default implementation uses the slice version of write.
+/// @param[in] name image name
+/// @param[in] async if true, planes are written in a background thread
+/// @return shared pointer to the writer
+boost::shared_ptr<ImagePlaneWriter> IImageAccess::planeWriter(const std::string &name, bool async)
+{
+    return boost::shared_ptr<ImagePlaneWriter>(new ImagePlaneWriter(*this, name, async));
+}
+
+/// @brief add weighted pixels to a slice of an image
+/// @details This is a read-modify-write operation intended for linear mosaicking:
+/// image(where + i) += arr(i) * weights(i) for all elements i of the array. The slice
+/// is locked (see ImageRegionLock), so concurrent accumulators working on disjoint
+/// regions proceed in parallel and those working on overlapping regions are serialised.
+/// Only accumulate calls are synchronised in this way, other reads and writes of the
+/// same image should not be done at the same time. The default implementation processes
+/// the slice chunk by chunk (see storageChunk) via the slice versions of read and
+/// write, so only one chunk has to be kept in memory.
+/// @param[in] name image name
+/// @param[in] arr array with pixels to add (axes missing in the shape are assumed to be degenerate)
+/// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+/// @param[in] weights weights of the same shape as arr, an empty array means unit weights
+void IImageAccess::accumulate(const std::string &name, const casacore::Array<float> &arr,
+                              const casacore::IPosition &where, const casacore::Array<float> &weights)
+{
+    if (arr.nelements() == 0) {
+        return;
+    }
+    casacore::IPosition imageShape;
+    casacore::IPosition chunk;
+    {
+        const boost::lock_guard<boost::mutex> lock(ImageRegionLock::storageMutex());
+        imageShape = shape(name);
+        chunk = storageChunk(name, imageShape);
+    }
+    const casacore::IPosition trc = accumulationEnd(imageShape, arr, where, weights);
+    const casacore::IPosition sliceShape = trc - where + 1;
+    const casacore::Array<float> input = sliceArray(arr, sliceShape);
+    const casacore::Array<float> inputWeights = weights.nelements() > 0 ? sliceArray(weights, sliceShape) : weights;
+    ASKAPCHECK(chunk.nelements() == imageShape.nelements(), "Chunk shape "<<chunk<<" doesn't match the image shape "<<imageShape);
+
+    const ImageRegionLock regionLock(name, where, trc);
+    casacore::IPosition blc(where);
+    for (bool done = false; !done;) {
+         // chunks end at multiples of the chunk shape
+         casacore::IPosition chunkTrc(blc);
+         for (size_t dim = 0; dim < chunkTrc.nelements(); ++dim) {
+              ASKAPDEBUGASSERT(chunk[dim] > 0);
+              chunkTrc[dim] = std::min(trc[dim], (blc[dim] / chunk[dim] + 1) * chunk[dim] - 1);
+         }
+         casacore::Array<float> section;
+         {
+             const boost::lock_guard<boost::mutex> lock(ImageRegionLock::storageMutex());
+             section.reference(read(name, blc, chunkTrc));
+         }
+         const casacore::IPosition chunkShape = chunkTrc - blc + 1;
+         if (!section.shape().isEqual(chunkShape)) {
+             section.reference(sliceArray(section, chunkShape));
+         }
+         const casacore::IPosition offsetBlc = blc - where;
+         const casacore::IPosition offsetTrc = chunkTrc - where;
+         addWeighted(section, input(offsetBlc, offsetTrc),
+                     inputWeights.nelements() > 0 ? inputWeights(offsetBlc, offsetTrc) : inputWeights);
+         {
+             const boost::lock_guard<boost::mutex> lock(ImageRegionLock::storageMutex());
+             write(name, section, blc);
+         }
+         // next chunk, the first axis changes fastest
+         done = true;
+         for (size_t dim = 0; dim < blc.nelements(); ++dim) {
+              if (chunkTrc[dim] < trc[dim]) {
+                  blc[dim] = chunkTrc[dim] + 1;
+                  done = false;
+                  break;
+              }
+              blc[dim] = where[dim];
+         }
+    }
+}
+
+/// @brief write a slice of an image together with its pixel mask
+/// @details This is equivalent to write followed by writeMask for the same slice, but
+/// allows implementations to apply the mask while the pixels are written (e.g. FITS images
+/// have masked pixels blanked on the way to the disk, without reading the slice back).
+/// The default implementation calls write and writeMask.
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] mask mask of the same shape as arr (true for good pixels)
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void IImageAccess::writeMasked(const std::string &name, const casacore::Array<float> &arr,
+                               const casacore::Array<bool> &mask, const casacore::IPosition &where)
+{
+    ASKAPCHECK(mask.shape().isEqual(arr.shape()), "Mask shape "<<mask.shape()<<
+               " doesn't match the shape of the pixel array "<<arr.shape());
+    write(name, arr, where);
+    writeMask(name, mask, where);
+}
+
+/// @brief close the given image
+/// @details Implementations may keep images open between calls. This method
+/// closes the image (writing all changes to disk), so it can be used by other
+/// processes. The image is reopened if it is accessed again. The default 
+/// implementation does nothing.
+/// @param[in] name image name
+void IImageAccess::close(const std::string &) {}
+
+/// @brief write all changes to disk
+/// @details Images kept open are flushed, but not closed. The default implementation
+/// does nothing.
+void IImageAccess::flush() {}
+
+/// @brief shape of the chunks the image is stored in
+/// @details This shape is used by accumulate and readSpectra to split the work, slices are
+/// split at multiples of the chunk shape, so chunks are aligned with the storage tiles if the
+/// chunk shape matches the tile shape. The default implementation returns a single plane
+/// (the first two axes in full).
+/// @param[in] imageShape shape of the image
+/// @return shape of the chunk
+casacore::IPosition IImageAccess::storageChunk(const std::string &, const casacore::IPosition &imageShape) const
+{
+    casacore::IPosition chunk(imageShape.nelements(), 1);
+    for (size_t dim = 0; (dim < 2) && (dim < chunk.nelements()); ++dim) {
+         chunk[dim] = imageShape[dim];
+    }
+    return chunk;
+}
+
+/// @brief bottom left and top right corners of the accumulated slice
+/// @details The array is checked to fit into the image and to match the weights.
+/// @param[in] imageShape shape of the image
+/// @param[in] arr array with pixels to add
+/// @param[in] where bottom left corner of the slice
+/// @param[in] weights weights of the same shape as arr or an empty array
+/// @return top right corner of the slice
+casacore::IPosition IImageAccess::accumulationEnd(const casacore::IPosition &imageShape, const casacore::Array<float> &arr,
+                        const casacore::IPosition &where, const casacore::Array<float> &weights)
+{
+    ASKAPCHECK((weights.nelements() == 0) || weights.shape().isEqual(arr.shape()), "Weights of the shape "<<
+               weights.shape()<<" don't match the array of the shape "<<arr.shape());
+    ASKAPCHECK((where.nelements() == imageShape.nelements()) && (arr.ndim() <= imageShape.nelements()),
+               "Array of the shape "<<arr.shape()<<" at "<<where<<" doesn't match the image of the shape "<<imageShape);
+    casacore::IPosition trc(where);
+    for (size_t dim = 0; dim < arr.ndim(); ++dim) {
+         trc[dim] += arr.shape()[dim] - 1;
+    }
+    for (size_t dim = 0; dim < imageShape.nelements(); ++dim) {
+         ASKAPCHECK((where[dim] >= 0) && (trc[dim] < imageShape[dim]), "Slice from "<<where<<" to "<<trc<<
+                    " doesn't fit into the image of the shape "<<imageShape);
+    }
+    return trc;
+}
+
+/// @brief add weighted pixels to the given section
+/// @param[in] section section of the image to update (e.g. a reference to the pixels held in memory)
+/// @param[in] arr array with pixels to add, same shape as the section (degenerate axes may be missing)
+/// @param[in] weights weights of the same shape as arr or an empty array for unit weights
+void IImageAccess::addWeighted(casacore::Array<float> &section, const casacore::Array<float> &arr,
+                               const casacore::Array<float> &weights)
+{
+    ASKAPCHECK(section.nelements() == arr.nelements(), "Shape of the section "<<section.shape()<<
+               " doesn't match the shape of the array "<<arr.shape());
+    const casacore::Array<float> input = sliceArray(arr, section.shape());
+    if (weights.nelements() == 0) {
+        section += input;
+    } else {
+        section += input * sliceArray(weights, section.shape());
+    }
+}
+
+/// @brief number of channels for per-channel beams
+/// @param[in] shape shape of the image
+/// @param[in] csys coordinate system of the image
+/// @return length of the spectral axis, or the number of planes if there is no spectral axis
+casacore::uInt IImageAccess::nChannels(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys)
+{
+    const casacore::Int specCoord = csys.findCoordinate(casacore::Coordinate::SPECTRAL);
+    if (specCoord >= 0) {
+        const casacore::Vector<casacore::Int> axes = csys.pixelAxes(specCoord);
+        if ((axes.nelements() == 1) && (axes[0] >= 0) && (axes[0] < casacore::Int(shape.nelements()))) {
+            return shape[axes[0]];
+        }
+    }
+    casacore::uInt nPlanes = 1;
+    for (casacore::uInt dim = 2; dim < shape.nelements(); ++dim) {
+         nPlanes *= shape[dim];
+    }
+    return nPlanes;
+}
+
+/// @brief spectral axis of an image
+/// @param[in] shape shape of the image
+/// @param[in] csys coordinate system of the image
+/// @return pixel axis of the spectral coordinate, or the last axis if there is no spectral coordinate
+casacore::uInt IImageAccess::spectralAxis(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys)
+{
+    ASKAPCHECK(shape.nelements() > 0, "An image without axes has no spectral axis");
+    const casacore::Int specCoord = csys.findCoordinate(casacore::Coordinate::SPECTRAL);
+    if (specCoord >= 0) {
+        const casacore::Int specAxis = csys.pixelAxes(specCoord)(0);
+        if ((specAxis >= 0) && (specAxis < casacore::Int(shape.nelements()))) {
+            return casacore::uInt(specAxis);
+        }
+    }
+    return shape.nelements() - 1;
+}
+
 } // namespace accessors
 
 } // namespace askap
@@ -35,15 +35,26 @@
 #define ASKAP_ACCESSORS_I_IMAGE_ACCESS_H
 
 #include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
 
 #include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/coordinates/Coordinates/CoordinateSystem.h>
 #include <casacore/casa/Quanta/Quantum.h>
 
+#include <askap/imageaccess/ImagePlaneReducer.h>
+
 
 namespace askap {
 namespace accessors {
 
+// forward declarations
+class ImagePlaneIterator;
+class ImagePlaneWriter;
+class ImageView;
+
 /// @brief Basic interface to access an image
 /// @details This interface class is somewhat analogous to casacore::ImageInterface. But it has
 /// only methods we need for accessors and allow more functionality to access a part of the image.
@@ -76,21 +87,123 @@ struct IImageAccess {
     virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
                                     const casacore::IPosition &trc) const = 0;
 
+    /// @brief read part of the image into the given buffer
+    /// @details The buffer is only resized if its shape differs from that of the
+    /// selection, so it can be reused for a sequence of reads of the same size (e.g. planes
+    /// of a cube). The buffer always holds a copy of the pixels. The default implementation
+    /// copies the result of the by-value read, implementations which can read directly into
+    /// the buffer should override it.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill
+    virtual void read(const std::string &name, const casacore::IPosition &blc,
+                      const casacore::IPosition &trc, casacore::Array<float> &buffer) const;
+
+    /// @brief read part of the image into preallocated memory
+    /// @details The default implementation wraps the memory into an array and calls the
+    /// buffer version of read, so implementations only need to override that one.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] data pointer to the memory for (trc-blc+1).product() pixels in the Fortran order
+    virtual void read(const std::string &name, const casacore::IPosition &blc,
+                      const casacore::IPosition &trc, float *data) const;
+
+    /// @brief read a number of cutouts
+    /// @details This method is intended for reading many small parts of the same image
+    /// (e.g. in source finding). The default implementation reads cutouts in the order of
+    /// their position in the image, overlapping or adjacent cutouts are read together as
+    /// their bounding box (see CutoutGrouper). Implementations with a more efficient way of
+    /// reading should override it.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corners of the cutouts
+    /// @param[in] trc top right corners of the cutouts, same size as blc
+    /// @param[out] cutouts arrays with pixels, one per cutout
+    virtual void readCutouts(const std::string &name, const std::vector<casacore::IPosition> &blc,
+                             const std::vector<casacore::IPosition> &trc,
+                             std::vector<casacore::Array<float> > &cutouts) const;
+
+    /// @brief extract spectra at a number of positions
+    /// @details This method is intended for extracting many spectra from the same cube (e.g. in
+    /// source characterisation). Positions are grouped by the storage chunk they belong to (e.g. tiles
+    /// of CASA images or planes of FITS images, see storageChunk), every chunk is read once for all its
+    /// positions and the values are scattered into the output (see SpectrumExtractor). The spectral axis
+    /// is that of the spectral coordinate or the last axis if the image has no spectral coordinate.
+    /// @param[in] name image name
+    /// @param[in] positions pixel positions (the element for the spectral axis is ignored)
+    /// @param[in] firstChannel first channel to extract
+    /// @param[in] nChan number of channels to extract
+    /// @param[out] spectra extracted spectra, resized to positions.size() x nChan
+    /// @param[in] nThreads number of threads to use
+    virtual void readSpectra(const std::string &name, const std::vector<casacore::IPosition> &positions,
+                             casacore::uInt firstChannel, casacore::uInt nChan,
+                             casacore::Matrix<float> &spectra, casacore::uInt nThreads = 1) const;
+
+    /// @brief obtain an iterator to read the image plane by plane
+    /// @details The iterator keeps two planes in memory and (optionally) reads the next plane
+    /// in a background thread while the current one is processed. This accessor should not be
+    /// used by other code until the iteration is finished. The default implementation uses the
+    /// buffer version of read.
+    /// @param[in] name image name
+    /// @param[in] async if true, the next plane is read in a background thread
+    /// @return shared pointer to the iterator positioned at the first plane
+    virtual boost::shared_ptr<ImagePlaneIterator> planeIterator(const std::string &name, bool async = true) const;
+
+    /// @brief compute a value for each plane of an image
+    /// @details Planes are read one at a time and reduced by a number of threads (see
+    /// ImagePlaneReducer), so the whole image is never kept in memory. This is intended for
+    /// statistics like per-channel rms or median (see ImagePlaneReducer::rms and others).
+    /// @param[in] name image name
+    /// @param[in] reduction functor computing a value from the pixels of one plane
+    /// @param[in] axis axis to keep, one value is computed per pixel along this axis
+    /// @param[in] nThreads number of threads to use
+    /// @return one value per plane
+    casacore::Vector<double> reducePlanes(const std::string &name, const ImagePlaneReducer::Reduction &reduction,
+                                          casacore::uInt axis, casacore::uInt nThreads = 1) const;
+
     /// @brief obtain coordinate system info
     /// @param[in] name image name
     /// @return coordinate system object
     virtual casacore::CoordinateSystem coordSys(const std::string &name) const = 0;
 
     /// @brief obtain coordinate system info for part of an image
+    /// @details The default implementation shifts the reference pixel of the coordinate system
+    /// of the full image (see ImageView::sliceCoordSys), no subimage is constructed.
     /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
     /// @return coordinate system object
     virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
-            const casacore::IPosition &trc) const = 0 ;
+            const casacore::IPosition &trc) const;
+
+    /// @brief obtain a view of part of an image
+    /// @details The view reads nothing on construction, its coordinate system is computed
+    /// arithmetically and pixels are read via this accessor when requested. Views of
+    /// the view (see ImageView::subView) share the coordinate system of the full image.
+    /// This accessor should outlive the view.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the region
+    /// @param[in] trc top right corner of the region (inclusive)
+    /// @return shared pointer to the view
+    virtual boost::shared_ptr<ImageView> view(const std::string &name, const casacore::IPosition &blc,
+            const casacore::IPosition &trc) const;
+
     /// @brief obtain beam info
     /// @param[in] name image name
     /// @return beam info vector
     virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const = 0;
 
+    /// @brief per-plane beams, one 3-element vector (major, minor, position angle) per channel
+    typedef std::vector<casacore::Vector<casacore::Quantum<double> > > BeamList;
+
+    /// @brief obtain per-channel beam info
+    /// @details The beams travel with the image (e.g. a beam set for CASA images or the
+    /// BEAMS binary table for FITS images). The default implementation returns an empty list.
+    /// @param[in] name image name
+    /// @return one beam per channel, empty if the image has no per-channel beams
+    virtual BeamList beamList(const std::string &name) const;
+
     /// @brief obtain pixel units
     /// @param[in] name image name
     /// @return units string
@@ -128,6 +241,34 @@ struct IImageAccess {
     virtual void write(const std::string &name, const casacore::Array<float> &arr,
                        const casacore::IPosition &where) = 0;
 
+    /// @brief add weighted pixels to a slice of an image
+    /// @details This is a read-modify-write operation intended for linear mosaicking:
+    /// image(where + i) += arr(i) * weights(i) for all elements i of the array. The slice
+    /// is locked (see ImageRegionLock), so concurrent accumulators working on disjoint
+    /// regions proceed in parallel and those working on overlapping regions are serialised.
+    /// Only accumulate calls are synchronised in this way, other reads and writes of the
+    /// same image should not be done at the same time. The default implementation processes
+    /// the slice chunk by chunk (see storageChunk) via the slice versions of read and
+    /// write, so only one chunk has to be kept in memory.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels to add (axes missing in the shape are assumed to be degenerate)
+    /// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+    /// @param[in] weights weights of the same shape as arr, an empty array means unit weights
+    virtual void accumulate(const std::string &name, const casacore::Array<float> &arr,
+                            const casacore::IPosition &where, const casacore::Array<float> &weights);
+
+    /// @brief write a slice of an image together with its pixel mask
+    /// @details This is equivalent to write followed by writeMask for the same slice, but
+    /// allows implementations to apply the mask while the pixels are written (e.g. FITS images
+    /// have masked pixels blanked on the way to the disk, without reading the slice back).
+    /// The default implementation calls write and writeMask.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] mask mask of the same shape as arr (true for good pixels)
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void writeMasked(const std::string &name, const casacore::Array<float> &arr,
+                             const casacore::Array<bool> &mask, const casacore::IPosition &where);
+
     /// @brief write a slice of an image pixel mask
     /// @param[in] name image name
     /// @param[in] arr array with pixels
@@ -155,6 +296,14 @@ struct IImageAccess {
     /// @param[in] pa position angle in radians
     virtual void setBeamInfo(const std::string &name, double maj, double min, double pa) = 0;
 
+    /// @brief set per-channel beam info
+    /// @details The number of beams should match the length of the spectral axis (or the
+    /// number of planes if there is no spectral axis). The default implementation throws
+    /// an exception.
+    /// @param[in] name image name
+    /// @param[in] beams one beam per channel
+    virtual void setBeamList(const std::string &name, const BeamList &beams);
+
     /// @brief apply mask to image
     /// @details Deteails depend upon the implemenation - CASA images will have the pixel mask assigned
     /// but FITS images will have it applied to the pixels ... which is an irreversible process
@@ -179,6 +328,72 @@ struct IImageAccess {
     /// @param[in] history History comment to add
     virtual void addHistory(const std::string &name, const std::string &history) = 0;
 
+    /// @brief obtain a writer to stream the image plane by plane
+    /// @details The writer keeps at most two planes in memory and (optionally) does the
+    /// actual writes in a background thread. The image should be created first. This 
+    /// accessor should not be used by other code until the writer is closed.
+    /// The default implementation uses the slice version of write.
+    /// @param[in] name image name
+    /// @param[in] async if true, planes are written in a background thread
+    /// @return shared pointer to the writer
+    virtual boost::shared_ptr<ImagePlaneWriter> planeWriter(const std::string &name, bool async = true);
+
+    //////////////////
+    // Handle management
+    //////////////////
+
+    /// @brief close the given image
+    /// @details Implementations may keep images open between calls. This method
+    /// closes the image (writing all changes to disk), so it can be used by other
+    /// processes. The image is reopened if it is accessed again. The default 
+    /// implementation does nothing.
+    /// @param[in] name image name
+    virtual void close(const std::string &name);
+
+    /// @brief write all changes to disk
+    /// @details Images kept open are flushed, but not closed. The default implementation
+    /// does nothing.
+    virtual void flush();
+
+protected:
+    /// @brief shape of the chunks the image is stored in
+    /// @details This shape is used by accumulate and readSpectra to split the work, slices are
+    /// split at multiples of the chunk shape, so chunks are aligned with the storage tiles if the
+    /// chunk shape matches the tile shape. The default implementation returns a single plane
+    /// (the first two axes in full).
+    /// @param[in] name image name
+    /// @param[in] imageShape shape of the image
+    /// @return shape of the chunk
+    virtual casacore::IPosition storageChunk(const std::string &name, const casacore::IPosition &imageShape) const;
+
+    /// @brief bottom left and top right corners of the accumulated slice
+    /// @details The array is checked to fit into the image and to match the weights.
+    /// @param[in] imageShape shape of the image
+    /// @param[in] arr array with pixels to add
+    /// @param[in] where bottom left corner of the slice
+    /// @param[in] weights weights of the same shape as arr or an empty array
+    /// @return top right corner of the slice
+    static casacore::IPosition accumulationEnd(const casacore::IPosition &imageShape, const casacore::Array<float> &arr,
+                            const casacore::IPosition &where, const casacore::Array<float> &weights);
+
+    /// @brief add weighted pixels to the given section
+    /// @param[in] section section of the image to update (e.g. a reference to the pixels held in memory)
+    /// @param[in] arr array with pixels to add, same shape as the section (degenerate axes may be missing)
+    /// @param[in] weights weights of the same shape as arr or an empty array for unit weights
+    static void addWeighted(casacore::Array<float> &section, const casacore::Array<float> &arr,
+                            const casacore::Array<float> &weights);
+
+    /// @brief number of channels for per-channel beams
+    /// @param[in] shape shape of the image
+    /// @param[in] csys coordinate system of the image
+    /// @return length of the spectral axis, or the number of planes if there is no spectral axis
+    static casacore::uInt nChannels(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys);
+
+    /// @brief spectral axis of an image
+    /// @param[in] shape shape of the image
+    /// @param[in] csys coordinate system of the image
+    /// @return pixel axis of the spectral coordinate, or the last axis if there is no spectral coordinate
+    static casacore::uInt spectralAxis(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys);
 
 };
 
@@ -30,12 +30,20 @@
 ///
 
 #include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/AsyncImageAccess.h>
 #include <askap/imageaccess/CasaImageAccess.h>
 #include <askap/imageaccess/FitsImageAccess.h>
+#include <askap/imageaccess/HDF5ImageAccess.h>
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap/imageaccess/OverviewImageAccess.h>
+#include <askap/dataaccess/AccessTracer.h>
+#include <askap/dataaccess/HardwareCounters.h>
+#include <askap/dataaccess/IOScheduler.h>
 
 #include <askap/askap/AskapError.h>
 
 #include <string>
+#include <vector>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -45,21 +53,138 @@ using namespace askap::accessors;
 /// accessor from the parset file
 /// @param[in] parset parameters containing description of image accessor to be constructed
 /// @return shared pointer to the image access object
-/// @note CASA images are used by default
+/// @note CASA images are used by default. For CASA images, tiling (balanced, spectral or spatial)
+/// or tileshape define the tile shape of new images (see CasaImageAccess::setTiling). For FITS images,
+/// parallelwrite=true switches on the parallel write mode (see FitsImageAccess::setParallelWrite),
+/// compression (none, rice, gzip or gzip2), compressiontile and quantizelevel set up tile compression
+/// (see FitsImageAccess::setCompression), headerreserve gives the number of free header cards
+/// in new images. HDF5 images (only if built with HDF5) take tiling or
+/// chunkshape to define the chunk shape, compression (deflate level) and parallelwrite.
+/// Memory images are kept in this process only, persist (none, casa, fits or hdf5) gives the image
+/// type used to write them to disk when closed (other parameters are passed to this accessor).
+/// For any image type, overviews gives the binning factors of the downsampled overview images
+/// maintained while the images are written (see OverviewImageAccess) and asyncwrite=true wraps
+/// the accessor into AsyncImageAccess, so writes are done in a background thread (asyncqueue gives
+/// the maximum number of queued operations). Background writes are done by the I/O scheduler
+/// of the process, iothreads and iobandwidth.bulk (MB/s) set its number of threads and the cap
+/// of the class used for the images (see IOScheduler::configure).
+/// If trace is given, reads and writes (and other data access operations) are traced into
+/// the given Chrome trace file (see AccessTracer). If hwcounters=true, hardware performance
+/// counters are collected for the same operations (see HardwareCounters).
 boost::shared_ptr<IImageAccess> askap::accessors::imageAccessFactory(const LOFAR::ParameterSet &parset)
 {
+   AccessTracer::instance().configure(parset);
+   HardwareCounters::instance().configure(parset);
+   IOScheduler::instance().configure(parset, "io");
    const std::string imageType = parset.getString("imagetype","casa");
    boost::shared_ptr<IImageAccess> result;
    if (imageType == "casa") {
        boost::shared_ptr<CasaImageAccess> iaCASA(new CasaImageAccess());
        // optional parameter setting may come here
+       const std::string tiling = parset.getString("tiling", "balanced");
+       if (tiling == "balanced") {
+           iaCASA->setTiling(CasaImageAccess::BALANCED);
+       } else if (tiling == "spectral") {
+           iaCASA->setTiling(CasaImageAccess::SPECTRAL);
+       } else if (tiling == "spatial") {
+           iaCASA->setTiling(CasaImageAccess::SPATIAL);
+       } else {
+           throw AskapError(std::string("Unsupported tiling ")+tiling+" has been requested");
+       }
+       if (parset.isDefined("tileshape")) {
+           const std::vector<int> tileShape = parset.getInt32Vector("tileshape");
+           casacore::IPosition tile(tileShape.size());
+           for (size_t dim = 0; dim < tileShape.size(); ++dim) {
+                tile(dim) = tileShape[dim];
+           }
+           iaCASA->setTileShape(tile);
+       }
        result = iaCASA;
    } else if (imageType == "fits"){
        boost::shared_ptr<FitsImageAccess> iaFITS(new FitsImageAccess());
+       // pixels are written directly into the file, so many ranks can write one image
+       iaFITS->setParallelWrite(parset.getBool("parallelwrite", false));
+       const std::string compression = parset.getString("compression", "none");
+       if (compression != "none") {
+           FitsImageAccess::Compression type = FitsImageAccess::NONE;
+           if (compression == "rice") {
+               type = FitsImageAccess::RICE;
+           } else if (compression == "gzip") {
+               type = FitsImageAccess::GZIP;
+           } else if (compression == "gzip2") {
+               type = FitsImageAccess::GZIP2;
+           } else {
+               throw AskapError(std::string("Unsupported compression ")+compression+" has been requested");
+           }
+           casacore::IPosition tile;
+           if (parset.isDefined("compressiontile")) {
+               const std::vector<int> tileShape = parset.getInt32Vector("compressiontile");
+               tile.resize(tileShape.size());
+               for (size_t dim = 0; dim < tileShape.size(); ++dim) {
+                    tile(dim) = tileShape[dim];
+               }
+           }
+           iaFITS->setCompression(type, tile, parset.getFloat("quantizelevel", 4.f));
+       }
+       iaFITS->setHeaderReserve(parset.getInt32("headerreserve", 100));
        result = iaFITS;
+   } else if (imageType == "memory") {
+       const std::string persist = parset.getString("persist", "none");
+       boost::shared_ptr<IImageAccess> persistence;
+       if (persist != "none") {
+           ASKAPCHECK(persist != "memory", "Memory images can't be persisted to memory");
+           // makeSubset gives an independent copy (copies of ParameterSet share the contents)
+           LOFAR::ParameterSet persistParset = parset.makeSubset("");
+           persistParset.replace("imagetype", persist);
+           persistParset.replace("asyncwrite", "false");
+           // overviews are images on their own, they are persisted as they are
+           persistParset.replace("overviews", "[]");
+           persistence = imageAccessFactory(persistParset);
+       }
+       result.reset(new MemoryImageAccess(persistence));
    }
+#ifdef HAVE_HDF5
+   else if (imageType == "hdf5") {
+       boost::shared_ptr<HDF5ImageAccess> iaHDF5(new HDF5ImageAccess());
+       const std::string tiling = parset.getString("tiling", "balanced");
+       if (tiling == "balanced") {
+           iaHDF5->setTiling(CasaImageAccess::BALANCED);
+       } else if (tiling == "spectral") {
+           iaHDF5->setTiling(CasaImageAccess::SPECTRAL);
+       } else if (tiling == "spatial") {
+           iaHDF5->setTiling(CasaImageAccess::SPATIAL);
+       } else {
+           throw AskapError(std::string("Unsupported tiling ")+tiling+" has been requested");
+       }
+       if (parset.isDefined("chunkshape")) {
+           const std::vector<int> chunkShape = parset.getInt32Vector("chunkshape");
+           casacore::IPosition chunk(chunkShape.size());
+           for (size_t dim = 0; dim < chunkShape.size(); ++dim) {
+                chunk(dim) = chunkShape[dim];
+           }
+           iaHDF5->setChunkShape(chunk);
+       }
+       iaHDF5->setCompression(parset.getInt32("compression", 0));
+       iaHDF5->setParallelWrite(parset.getBool("parallelwrite", false));
+       result = iaHDF5;
+   }
+#endif
    else {
       throw AskapError(std::string("Unsupported image type ")+imageType+" has been requested");
    }
+   if (parset.isDefined("overviews")) {
+       const std::vector<int> factors = parset.getInt32Vector("overviews");
+       std::vector<casacore::uInt> ovFactors(factors.size());
+       for (size_t i = 0; i < factors.size(); ++i) {
+            ASKAPCHECK(factors[i] > 1, "Binning factors of the overviews should be greater than 1, you have "<<factors[i]);
+            ovFactors[i] = factors[i];
+       }
+       if (ovFactors.size() > 0) {
+           result.reset(new OverviewImageAccess(result, ovFactors));
+       }
+   }
+   if (parset.getBool("asyncwrite", false)) {
+       result.reset(new AsyncImageAccess(result, parset.getUint32("asyncqueue", 16)));
+   }
    return result;
 }
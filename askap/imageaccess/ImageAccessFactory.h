@@ -45,7 +45,9 @@ namespace accessors {
 /// accessor from the parset file
 /// @param[in] parset parameters containing description of image accessor to be constructed
 /// @return shared pointer to the image access object
-/// @note CASA images are used by default
+/// @note CASA images are used by default. For CASA images, tiling (balanced, spectral or spatial)
+/// or tileshape define the tile shape of new images (see CasaImageAccess::setTiling). For FITS images,
+/// parallelwrite=true switches on the parallel write mode (see FitsImageAccess::setParallelWrite)
 boost::shared_ptr<IImageAccess> imageAccessFactory(const LOFAR::ParameterSet &parset);
 
 } // namespace accessors
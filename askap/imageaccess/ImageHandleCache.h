@@ -0,0 +1,149 @@
+/// @file ImageHandleCache.h
+/// @brief LRU cache of open image handles
+/// @details Image access classes are called with an image name for every operation.
+/// This helper keeps a limited number of open image objects keyed by name, so repeated
+/// operations on the same image (e.g. writing a cube channel by channel) don't open and
+/// close the image each time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_HANDLE_CACHE_H
+#define ASKAP_ACCESSORS_IMAGE_HANDLE_CACHE_H
+
+#include <boost/shared_ptr.hpp>
+
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief LRU cache of open image handles
+/// @details Handles are held by shared pointers, so removing a handle from the cache closes 
+/// the image (and flushes it) unless the handle is still used elsewhere. The least recently used
+/// handle is removed when the number of entries exceeds the limit. Zero limit disables caching.
+/// The number of entries is expected to be small, so the look up is a linear search.
+/// The class is not thread safe.
+/// @ingroup imageaccess
+template<typename T>
+class ImageHandleCache {
+public:
+    /// @brief constructor
+    /// @param[in] maxEntries maximum number of open handles
+    explicit ImageHandleCache(const size_t maxEntries) : itsMaxEntries(maxEntries) {}
+
+    /// @brief find the handle for the given image
+    /// @details The entry found becomes the most recently used one.
+    /// @param[in] name image name
+    /// @return shared pointer to the handle (empty pointer if the image is not in the cache)
+    boost::shared_ptr<T> find(const std::string &name) {
+        for (typename ListType::iterator it = itsEntries.begin(); it != itsEntries.end(); ++it) {
+             if (it->first == name) {
+                 if (it != itsEntries.begin()) {
+                     itsEntries.splice(itsEntries.begin(), itsEntries, it);
+                 }
+                 return itsEntries.front().second;
+             }
+        }
+        return boost::shared_ptr<T>();
+    }
+
+    /// @brief add the handle for the given image
+    /// @details An existing entry for the same image is replaced. The least recently used entries
+    /// are removed if the cache is full.
+    /// @param[in] name image name
+    /// @param[in] handle shared pointer to the handle
+    void add(const std::string &name, const boost::shared_ptr<T> &handle) {
+        remove(name);
+        if (itsMaxEntries > 0) {
+            itsEntries.push_front(std::make_pair(name, handle));
+            trim();
+        }
+    }
+
+    /// @brief remove the handle for the given image
+    /// @param[in] name image name
+    /// @return true if the image was in the cache
+    bool remove(const std::string &name) {
+        for (typename ListType::iterator it = itsEntries.begin(); it != itsEntries.end(); ++it) {
+             if (it->first == name) {
+                 itsEntries.erase(it);
+                 return true;
+             }
+        }
+        return false;
+    }
+
+    /// @brief remove all handles
+    void clear() { itsEntries.clear(); }
+
+    /// @brief obtain all cached handles
+    /// @return vector with shared pointers to the handles, the most recently used first
+    std::vector<boost::shared_ptr<T> > handles() const {
+        std::vector<boost::shared_ptr<T> > result;
+        result.reserve(itsEntries.size());
+        for (typename ListType::const_iterator it = itsEntries.begin(); it != itsEntries.end(); ++it) {
+             result.push_back(it->second);
+        }
+        return result;
+    }
+
+    /// @brief number of cached handles
+    /// @return number of entries in the cache
+    size_t size() const { return itsEntries.size(); }
+
+    /// @brief change the maximum number of handles
+    /// @details The least recently used entries are removed if the cache has more entries.
+    /// @param[in] maxEntries maximum number of open handles, zero disables caching
+    void setMaxEntries(const size_t maxEntries) {
+        itsMaxEntries = maxEntries;
+        trim();
+    }
+
+private:
+    /// @brief remove the least recently used entries above the limit
+    void trim() {
+        while (itsEntries.size() > itsMaxEntries) {
+            itsEntries.pop_back();
+        }
+    }
+
+    /// @brief type of the list of entries
+    typedef std::list<std::pair<std::string, boost::shared_ptr<T> > > ListType;
+
+    /// @brief cached handles, the most recently used first
+    ListType itsEntries;
+
+    /// @brief maximum number of entries
+    size_t itsMaxEntries;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
@@ -0,0 +1,179 @@
+/// @file
+/// @brief sequential plane-by-plane reader of an image with read-ahead
+/// @details This class reads an image one plane at a time via the generic
+/// IImageAccess interface, so only two planes have to be kept in memory regardless
+/// of the cube size. The next plane is read in a background thread while the caller
+/// processes the current one (double buffering).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/imageaccess/ImagePlaneIterator.h>
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap_accessors.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+ASKAP_LOGGER(logger, ".imagePlaneIterator");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor, reads the first plane
+/// @param[in] acc image accessor to read with
+/// @param[in] name image name
+/// @param[in] async if true, the next plane is read in a background thread
+ImagePlaneIterator::ImagePlaneIterator(const IImageAccess &acc, const std::string &name, bool async) :
+     itsAccessor(acc), itsName(name), itsAsync(async), itsShape(acc.shape(name)),
+     itsNPlanes(1), itsCurrentPlane(0), itsCurrentBuffer(0), itsReadPlane(0)
+{
+   ASKAPCHECK(itsShape.nelements() >= 2, "Image "<<name<<" should have at least 2 dimensions to be read plane by plane, shape = "<<itsShape);
+   itsPlaneShape = itsShape.getFirst(2);
+   for (casacore::uInt dim = 2; dim < itsShape.nelements(); ++dim) {
+        itsNPlanes *= static_cast<casacore::uInt>(itsShape[dim]);
+   }
+   ASKAPLOG_DEBUG_STR(logger, "Reading "<<itsNPlanes<<" planes of "<<itsPlaneShape<<" from "<<name<<
+                      (async ? " with read-ahead" : ""));
+   if (itsNPlanes > 0) {
+       run(itsCurrentBuffer);
+       wait();
+       itsPlane.reference(itsBuffers[itsCurrentBuffer].reform(itsPlaneShape));
+       prefetch();
+   }
+}
+
+/// @brief destructor, waits for the read in progress to finish
+ImagePlaneIterator::~ImagePlaneIterator()
+{
+   if (itsThread) {
+       itsThread->join();
+       itsThread.reset();
+   }
+   if (itsError.size()) {
+       ASKAPLOG_ERROR_STR(logger, "Read of plane "<<itsReadPlane<<" of "<<itsName<<" failed: "<<itsError);
+   }
+}
+
+/// @brief move to the next plane
+/// @details This method waits for the next plane to be read (or reads it in the synchronous
+/// mode) and starts reading the following one in the background. The array returned by plane()
+/// for the previous plane is overwritten by the read-ahead, so it shouldn't be used after this
+/// call. Any error encountered by the background read is reported here.
+void ImagePlaneIterator::next()
+{
+   ASKAPCHECK(!atEnd(), "All "<<itsNPlanes<<" planes of "<<itsName<<" have already been read");
+   ++itsCurrentPlane;
+   if (atEnd()) {
+       itsPlane.resize();
+       return;
+   }
+   if (!itsAsync) {
+       itsReadPlane = itsCurrentPlane;
+       run(1 - itsCurrentBuffer);
+   }
+   // the plane is in the other buffer once the read has finished
+   wait();
+   itsCurrentBuffer = 1 - itsCurrentBuffer;
+   itsPlane.reference(itsBuffers[itsCurrentBuffer].reform(itsPlaneShape));
+   prefetch();
+}
+
+/// @brief pixels of the current plane
+/// @details The array references one of the two buffers, it is valid until the next call to next().
+/// @return reference to the array of planeShape() shape
+const casacore::Array<float>& ImagePlaneIterator::plane() const
+{
+   ASKAPCHECK(!atEnd(), "All "<<itsNPlanes<<" planes of "<<itsName<<" have already been read");
+   return itsPlane;
+}
+
+/// @brief start reading the plane after the current one in the background
+/// @details Nothing is done in the synchronous mode or at the last plane.
+void ImagePlaneIterator::prefetch()
+{
+   if (itsAsync && (itsCurrentPlane + 1 < itsNPlanes)) {
+       ASKAPDEBUGASSERT(!itsThread);
+       itsReadPlane = itsCurrentPlane + 1;
+       itsThread.reset(new boost::thread(boost::bind(&ImagePlaneIterator::run, this, 1 - itsCurrentBuffer)));
+   }
+}
+
+/// @brief wait for the background job and report its error, if any
+void ImagePlaneIterator::wait()
+{
+   if (itsThread) {
+       itsThread->join();
+       itsThread.reset();
+   }
+   if (itsError.size()) {
+       const std::string msg = itsError;
+       itsError.clear();
+       ASKAPTHROW(AskapError, "Read of plane "<<itsReadPlane<<" of "<<itsName<<" failed: "<<msg);
+   }
+}
+
+/// @brief body of the background job
+/// @details Exceptions can't propagate across threads, therefore the error message is
+/// stored and reported by the next call to wait.
+/// @param[in] buffer index of the buffer to read into
+void ImagePlaneIterator::run(casacore::uInt buffer)
+{
+   try {
+      const casacore::IPosition blc = planePosition(itsReadPlane);
+      casacore::IPosition trc(blc);
+      trc[0] = itsShape[0] - 1;
+      trc[1] = itsShape[1] - 1;
+      // the buffer keeps its storage if the shape matches
+      itsAccessor.read(itsName, blc, trc, itsBuffers[buffer]);
+   }
+   catch (const std::exception &ex) {
+      itsError = ex.what();
+      if (itsError.empty()) {
+          itsError = "unknown error";
+      }
+   }
+}
+
+/// @brief position of the given plane in the image
+/// @param[in] plane plane number
+/// @return bottom left corner of the plane
+casacore::IPosition ImagePlaneIterator::planePosition(casacore::uInt plane) const
+{
+   casacore::IPosition where(itsShape.nelements(), 0);
+   for (casacore::uInt dim = 2; dim < itsShape.nelements(); ++dim) {
+        where[dim] = plane % itsShape[dim];
+        plane /= itsShape[dim];
+   }
+   return where;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,183 @@
+/// @file
+/// @brief sequential plane-by-plane reader of an image with read-ahead
+/// @details This class reads an image one plane at a time via the generic
+/// IImageAccess interface, so only two planes have to be kept in memory regardless
+/// of the cube size. The next plane is read in a background thread while the caller
+/// processes the current one (double buffering).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_PLANE_ITERATOR_H
+#define ASKAP_ACCESSORS_IMAGE_PLANE_ITERATOR_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+namespace askap {
+
+namespace accessors {
+
+// forward declaration
+struct IImageAccess;
+
+/// @brief sequential plane-by-plane reader of an image with read-ahead
+/// @details This is the reading counterpart of ImagePlaneWriter. A plane covers the first two
+/// axes of the image, planes are visited in the order of the remaining axes (the third axis
+/// changes fastest). The first plane is read on construction. In the asynchronous mode the
+/// read of the next plane starts in a background thread as soon as the iterator moves to a
+/// plane, so I/O for plane N+1 overlaps the processing of plane N. Two buffers are allocated
+/// once and reused for all planes, reads go directly into them (see the buffer version of
+/// IImageAccess::read). The image stays open in the handle cache of the accessor between reads.
+/// The typical usage is
+/// @code
+///    boost::shared_ptr<ImagePlaneIterator> it = imgAccess.planeIterator(name);
+///    for (; !it->atEnd(); it->next()) {
+///         process(it->plane(), it->position());
+///    }
+/// @endcode
+/// @note The accessor is referenced, rather than copied. It should outlive this object
+/// and should not be used by other code until the iteration is finished (or this object
+/// is destroyed), because reads may happen in another thread.
+/// @ingroup imageaccess
+class ImagePlaneIterator : private boost::noncopyable {
+public:
+
+   /// @brief constructor, reads the first plane
+   /// @param[in] acc image accessor to read with
+   /// @param[in] name image name
+   /// @param[in] async if true, the next plane is read in a background thread
+   ImagePlaneIterator(const IImageAccess &acc, const std::string &name, bool async = true);
+
+   /// @brief destructor, waits for the read in progress to finish
+   ~ImagePlaneIterator();
+
+   /// @brief check whether all planes have been visited
+   /// @return true, if there is no current plane
+   inline bool atEnd() const { return itsCurrentPlane >= itsNPlanes; }
+
+   /// @brief move to the next plane
+   /// @details This method waits for the next plane to be read (or reads it in the synchronous
+   /// mode) and starts reading the following one in the background. The array returned by plane()
+   /// for the previous plane is overwritten by the read-ahead, so it shouldn't be used after this
+   /// call. Any error encountered by the background read is reported here.
+   void next();
+
+   /// @brief pixels of the current plane
+   /// @details The array references one of the two buffers, it is valid until the next call to next().
+   /// @return reference to the array of planeShape() shape
+   const casacore::Array<float>& plane() const;
+
+   /// @brief number of the current plane
+   /// @return plane number (equal to nPlanes() at the end)
+   inline casacore::uInt planeNumber() const { return itsCurrentPlane; }
+
+   /// @brief position of the current plane in the image
+   /// @return bottom left corner of the plane
+   inline casacore::IPosition position() const { return planePosition(itsCurrentPlane); }
+
+   /// @brief shape of a single plane
+   /// @return 2-element shape of the plane
+   inline const casacore::IPosition& planeShape() const { return itsPlaneShape; }
+
+   /// @brief total number of planes in the image
+   /// @return number of planes
+   inline casacore::uInt nPlanes() const { return itsNPlanes; }
+
+protected:
+
+   /// @brief start reading the plane after the current one in the background
+   /// @details Nothing is done in the synchronous mode or at the last plane.
+   void prefetch();
+
+   /// @brief wait for the background job and report its error, if any
+   void wait();
+
+   /// @brief body of the background job
+   /// @details Exceptions can't propagate across threads, therefore the error message is
+   /// stored and reported by the next call to wait.
+   /// @param[in] buffer index of the buffer to read into
+   void run(casacore::uInt buffer);
+
+   /// @brief position of the given plane in the image
+   /// @param[in] plane plane number
+   /// @return bottom left corner of the plane
+   casacore::IPosition planePosition(casacore::uInt plane) const;
+
+private:
+   /// @brief accessor to read with
+   const IImageAccess &itsAccessor;
+
+   /// @brief image name
+   const std::string itsName;
+
+   /// @brief true, if reads are done in a background thread
+   const bool itsAsync;
+
+   /// @brief full shape of the image
+   const casacore::IPosition itsShape;
+
+   /// @brief shape of a single plane
+   casacore::IPosition itsPlaneShape;
+
+   /// @brief total number of planes
+   casacore::uInt itsNPlanes;
+
+   /// @brief current plane
+   casacore::uInt itsCurrentPlane;
+
+   /// @brief double buffer (each buffer has the dimensions of the image)
+   casacore::Array<float> itsBuffers[2];
+
+   /// @brief current plane, references one of the buffers
+   casacore::Array<float> itsPlane;
+
+   /// @brief index of the buffer holding the current plane
+   casacore::uInt itsCurrentBuffer;
+
+   /// @brief plane read by the background job
+   casacore::uInt itsReadPlane;
+
+   /// @brief error message of the background job (empty if successful)
+   std::string itsError;
+
+   /// @brief background thread
+   boost::shared_ptr<boost::thread> itsThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IMAGE_PLANE_ITERATOR_H
@@ -0,0 +1,208 @@
+/// @file
+/// @brief per-plane reduction of an image
+/// @details This class computes a statistic (e.g. rms, minimum or median) for each
+/// plane along the given axis of an image, reading one plane at a time via the generic
+/// IImageAccess interface, so the whole cube never has to be kept in memory. Planes
+/// are processed by a number of threads in parallel.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/imageaccess/ImagePlaneReducer.h>
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap_accessors.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayMath.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+ASKAP_LOGGER(logger, ".imagePlaneReducer");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] acc image accessor to read with
+/// @param[in] name image name
+/// @param[in] axis axis to keep, one value is computed per pixel along this axis
+ImagePlaneReducer::ImagePlaneReducer(const IImageAccess &acc, const std::string &name, casacore::uInt axis) :
+     itsAccessor(acc), itsName(name), itsShape(acc.shape(name)), itsAxis(axis), itsNextPlane(0)
+{
+   ASKAPCHECK(axis < itsShape.nelements(), "Axis "<<axis<<" to keep doesn't exist in image "<<name<<
+              " of shape "<<itsShape);
+}
+
+/// @brief reduce all planes
+/// @details Any error encountered by a thread is reported here after all threads have finished.
+/// @param[in] reduction functor to apply to each plane, it should be thread-safe
+/// @param[in] nThreads number of threads to use (1 means that planes are processed by the calling thread)
+/// @return one value per plane
+casacore::Vector<double> ImagePlaneReducer::reduce(const Reduction &reduction, casacore::uInt nThreads)
+{
+   ASKAPCHECK(nThreads > 0, "At least one thread is required to reduce planes of "<<itsName);
+   casacore::Vector<double> result(nPlanes(), 0.);
+   itsNextPlane = 0;
+   itsError.clear();
+   nThreads = std::min(nThreads, nPlanes());
+   ASKAPLOG_DEBUG_STR(logger, "Reducing "<<nPlanes()<<" planes of "<<itsName<<" along axis "<<itsAxis<<
+                      " with "<<nThreads<<" thread(s)");
+   if (nThreads <= 1) {
+       run(reduction, result);
+   } else {
+       boost::thread_group threads;
+       for (casacore::uInt thread = 0; thread < nThreads; ++thread) {
+            threads.create_thread(boost::bind(&ImagePlaneReducer::run, this, boost::cref(reduction),
+                                  boost::ref(result)));
+       }
+       threads.join_all();
+   }
+   if (itsError.size()) {
+       const std::string msg = itsError;
+       itsError.clear();
+       ASKAPTHROW(AskapError, "Reduction of planes of "<<itsName<<" failed: "<<msg);
+   }
+   return result;
+}
+
+/// @brief body of a worker thread
+/// @details Planes are taken in turn until all of them are processed. Exceptions can't
+/// propagate across threads, therefore the first error message is stored and reported by reduce.
+/// @param[in] reduction functor to apply to each plane
+/// @param[in] result vector to store the values (one element per plane)
+void ImagePlaneReducer::run(const Reduction &reduction, casacore::Vector<double> &result)
+{
+   casacore::IPosition blc(itsShape.nelements(), 0);
+   casacore::IPosition trc(itsShape - 1);
+   while (true) {
+      casacore::uInt plane = 0;
+      casacore::Array<float> pixels;
+      try {
+         {
+            boost::mutex::scoped_lock lock(itsMutex);
+            if ((itsNextPlane >= nPlanes()) || itsError.size()) {
+                return;
+            }
+            plane = itsNextPlane++;
+            blc[itsAxis] = trc[itsAxis] = plane;
+            // accessors can't be used from a number of threads at the same time
+            pixels = itsAccessor.read(itsName, blc, trc);
+         }
+         result[plane] = reduction(pixels);
+      }
+      catch (const std::exception &ex) {
+         boost::mutex::scoped_lock lock(itsMutex);
+         if (itsError.empty()) {
+             std::ostringstream os;
+             os<<"plane "<<plane<<": "<<ex.what();
+             itsError = os.str();
+         }
+         return;
+      }
+   }
+}
+
+/// @brief root mean square of the pixels
+/// @param[in] plane pixels
+/// @return rms (zero for an empty plane)
+double ImagePlaneReducer::rms(const casacore::Array<float> &plane)
+{
+   if (plane.nelements() == 0) {
+       return 0.;
+   }
+   double sumSq = 0.;
+   for (casacore::Array<float>::const_iterator it = plane.begin(); it != plane.end(); ++it) {
+        sumSq += double(*it) * double(*it);
+   }
+   return std::sqrt(sumSq / plane.nelements());
+}
+
+/// @brief mean of the pixels
+/// @param[in] plane pixels
+/// @return mean (zero for an empty plane)
+double ImagePlaneReducer::mean(const casacore::Array<float> &plane)
+{
+   if (plane.nelements() == 0) {
+       return 0.;
+   }
+   double sum = 0.;
+   for (casacore::Array<float>::const_iterator it = plane.begin(); it != plane.end(); ++it) {
+        sum += *it;
+   }
+   return sum / plane.nelements();
+}
+
+/// @brief minimum of the pixels
+/// @param[in] plane pixels
+/// @return minimum
+double ImagePlaneReducer::minimum(const casacore::Array<float> &plane)
+{
+   ASKAPCHECK(plane.nelements() > 0, "Minimum is undefined for an empty plane");
+   return casacore::min(plane);
+}
+
+/// @brief maximum of the pixels
+/// @param[in] plane pixels
+/// @return maximum
+double ImagePlaneReducer::maximum(const casacore::Array<float> &plane)
+{
+   ASKAPCHECK(plane.nelements() > 0, "Maximum is undefined for an empty plane");
+   return casacore::max(plane);
+}
+
+/// @brief median of the pixels
+/// @details The plane is not modified (partial sort is done on a copy).
+/// @param[in] plane pixels
+/// @return median
+double ImagePlaneReducer::median(const casacore::Array<float> &plane)
+{
+   ASKAPCHECK(plane.nelements() > 0, "Median is undefined for an empty plane");
+   std::vector<float> buf(plane.begin(), plane.end());
+   const size_t half = buf.size() / 2;
+   std::nth_element(buf.begin(), buf.begin() + half, buf.end());
+   if (buf.size() % 2) {
+       return buf[half];
+   }
+   // average of the two middle elements, the lower one is the largest of the first half
+   const float lower = *std::max_element(buf.begin(), buf.begin() + half);
+   return 0.5 * (double(lower) + double(buf[half]));
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,155 @@
+/// @file
+/// @brief per-plane reduction of an image
+/// @details This class computes a statistic (e.g. rms, minimum or median) for each
+/// plane along the given axis of an image, reading one plane at a time via the generic
+/// IImageAccess interface, so the whole cube never has to be kept in memory. Planes
+/// are processed by a number of threads in parallel.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_PLANE_REDUCER_H
+#define ASKAP_ACCESSORS_IMAGE_PLANE_REDUCER_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+namespace askap {
+
+namespace accessors {
+
+// forward declaration
+struct IImageAccess;
+
+/// @brief per-plane reduction of an image
+/// @details The reduction is a functor computing a single number from the array of pixels
+/// of one plane. A plane is the hyperplane of the image where the given axis (the axis to keep)
+/// is fixed, e.g. for axis=3 of a (ra,dec,pol,freq) cube a plane covers all pixels of one channel.
+/// Each thread reads a plane and reduces it, reads are serialised (accessors are not thread-safe),
+/// so I/O for one plane overlaps with the reduction of the others. At most one plane per thread
+/// is kept in memory. The typical usage is
+/// @code
+///    ImagePlaneReducer reducer(imgAccess, name, 3);
+///    casacore::Vector<double> noise = reducer.reduce(ImagePlaneReducer::rms, 4);
+/// @endcode
+/// @note The accessor is referenced, rather than copied. It should outlive this object and
+/// should not be used by other code while reduce is running.
+/// @ingroup imageaccess
+class ImagePlaneReducer : private boost::noncopyable {
+public:
+
+   /// @brief reduction of a plane to a single number
+   typedef boost::function<double (const casacore::Array<float> &)> Reduction;
+
+   /// @brief constructor
+   /// @param[in] acc image accessor to read with
+   /// @param[in] name image name
+   /// @param[in] axis axis to keep, one value is computed per pixel along this axis
+   ImagePlaneReducer(const IImageAccess &acc, const std::string &name, casacore::uInt axis);
+
+   /// @brief reduce all planes
+   /// @details Any error encountered by a thread is reported here after all threads have finished.
+   /// @param[in] reduction functor to apply to each plane, it should be thread-safe
+   /// @param[in] nThreads number of threads to use (1 means that planes are processed by the calling thread)
+   /// @return one value per plane
+   casacore::Vector<double> reduce(const Reduction &reduction, casacore::uInt nThreads = 1);
+
+   /// @brief number of planes
+   /// @return length of the kept axis
+   inline casacore::uInt nPlanes() const { return static_cast<casacore::uInt>(itsShape[itsAxis]); }
+
+   /// @brief root mean square of the pixels
+   /// @param[in] plane pixels
+   /// @return rms (zero for an empty plane)
+   static double rms(const casacore::Array<float> &plane);
+
+   /// @brief mean of the pixels
+   /// @param[in] plane pixels
+   /// @return mean (zero for an empty plane)
+   static double mean(const casacore::Array<float> &plane);
+
+   /// @brief minimum of the pixels
+   /// @param[in] plane pixels
+   /// @return minimum
+   static double minimum(const casacore::Array<float> &plane);
+
+   /// @brief maximum of the pixels
+   /// @param[in] plane pixels
+   /// @return maximum
+   static double maximum(const casacore::Array<float> &plane);
+
+   /// @brief median of the pixels
+   /// @details The plane is not modified (partial sort is done on a copy).
+   /// @param[in] plane pixels
+   /// @return median
+   static double median(const casacore::Array<float> &plane);
+
+protected:
+
+   /// @brief body of a worker thread
+   /// @details Planes are taken in turn until all of them are processed. Exceptions can't
+   /// propagate across threads, therefore the first error message is stored and reported by reduce.
+   /// @param[in] reduction functor to apply to each plane
+   /// @param[in] result vector to store the values (one element per plane)
+   void run(const Reduction &reduction, casacore::Vector<double> &result);
+
+private:
+   /// @brief accessor to read with
+   const IImageAccess &itsAccessor;
+
+   /// @brief image name
+   const std::string itsName;
+
+   /// @brief full shape of the image
+   const casacore::IPosition itsShape;
+
+   /// @brief axis to keep
+   const casacore::uInt itsAxis;
+
+   /// @brief next plane to process
+   casacore::uInt itsNextPlane;
+
+   /// @brief error message of a worker thread (empty if successful)
+   std::string itsError;
+
+   /// @brief mutex protecting the plane counter, the error message and the accessor
+   boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IMAGE_PLANE_REDUCER_H
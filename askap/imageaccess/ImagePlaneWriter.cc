@@ -0,0 +1,189 @@
+/// @file
+/// @brief sequential plane-by-plane writer of an image
+/// @details This class writes an image one plane at a time via the generic
+/// IImageAccess interface, so only two planes have to be kept in memory regardless
+/// of the cube size. Writes are done in a background thread (double buffering), so
+/// the caller can compute the next plane while the previous one is being written.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/imageaccess/ImagePlaneWriter.h>
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap_accessors.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+ASKAP_LOGGER(logger, ".imagePlaneWriter");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] acc image accessor to use for writing
+/// @param[in] name image name
+/// @param[in] async if true, planes are written in a background thread
+ImagePlaneWriter::ImagePlaneWriter(IImageAccess &acc, const std::string &name, bool async) :
+     itsAccessor(acc), itsName(name), itsAsync(async), itsShape(acc.shape(name)),
+     itsNPlanes(1), itsNAppended(0), itsCurrentBuffer(0), itsWritePlane(0), itsClosed(false)
+{
+   ASKAPCHECK(itsShape.nelements() >= 2, "Image "<<name<<" should have at least 2 dimensions to be written plane by plane, shape = "<<itsShape);
+   itsPlaneShape = itsShape.getFirst(2);
+   for (casacore::uInt dim = 2; dim < itsShape.nelements(); ++dim) {
+        itsNPlanes *= static_cast<casacore::uInt>(itsShape[dim]);
+   }
+   ASKAPLOG_DEBUG_STR(logger, "Writing "<<itsNPlanes<<" planes of "<<itsPlaneShape<<" into "<<name<<
+                      (async ? " asynchronously" : ""));
+}
+
+/// @brief destructor, waits for the write in progress to finish
+ImagePlaneWriter::~ImagePlaneWriter()
+{
+   if (itsThread) {
+       itsThread->join();
+       itsThread.reset();
+   }
+   if (itsError.size()) {
+       ASKAPLOG_ERROR_STR(logger, "Write of plane "<<itsWritePlane<<" into "<<itsName<<" failed: "<<itsError);
+   }
+}
+
+/// @brief obtain the buffer for the next plane
+/// @details The buffer is not changed by appendPlane (which switches to the other
+/// buffer), so planes can be filled in place without extra copying. The content is
+/// undefined until the buffer is filled by the caller.
+/// @return reference to the array of planeShape() shape
+casacore::Array<float>& ImagePlaneWriter::plane()
+{
+   casacore::Array<float> &buf = itsBuffers[itsCurrentBuffer];
+   if (buf.shape() != itsPlaneShape) {
+       buf.resize(itsPlaneShape);
+   }
+   return buf;
+}
+
+/// @brief write the plane given by plane()
+/// @details In the asynchronous mode this method waits for the previous write
+/// to finish and starts writing the current buffer in the background.
+/// Any error encountered by the previous write is reported here.
+void ImagePlaneWriter::appendPlane()
+{
+   ASKAPCHECK(!itsClosed, "Plane writer for "<<itsName<<" has already been closed");
+   ASKAPCHECK(itsNAppended < itsNPlanes, "All "<<itsNPlanes<<" planes of "<<itsName<<" have already been written");
+   ASKAPCHECK(itsBuffers[itsCurrentBuffer].shape() == itsPlaneShape, 
+              "The buffer for plane "<<itsNAppended<<" has not been filled");
+   // only one write at a time, the other buffer is free after that
+   wait();
+   itsWritePlane = itsNAppended++;
+   if (itsAsync) {
+       const casacore::uInt buffer = itsCurrentBuffer;
+       itsCurrentBuffer = 1 - itsCurrentBuffer;
+       itsThread.reset(new boost::thread(boost::bind(&ImagePlaneWriter::run, this, buffer)));
+   } else {
+       run(itsCurrentBuffer);
+       wait();
+   }
+}
+
+/// @brief write the given plane
+/// @details This version copies the array into the buffer first.
+/// @param[in] arr array with pixels (should be of planeShape() shape)
+void ImagePlaneWriter::appendPlane(const casacore::Array<float> &arr)
+{
+   ASKAPCHECK(arr.shape().nonDegenerate() == itsPlaneShape.nonDegenerate(), "Plane of shape "<<arr.shape()<<
+              " is appended to "<<itsName<<", expected shape is "<<itsPlaneShape);
+   plane() = arr.reform(itsPlaneShape);
+   appendPlane();
+}
+
+/// @brief wait for all writes to finish
+/// @details Any error encountered by the background write is reported here.
+/// No further planes can be appended after this method is called.
+void ImagePlaneWriter::close()
+{
+   if (!itsClosed) {
+       itsClosed = true;
+       wait();
+       if (itsNAppended < itsNPlanes) {
+           ASKAPLOG_WARN_STR(logger, "Only "<<itsNAppended<<" planes out of "<<itsNPlanes<<" have been written into "<<itsName);
+       }
+       // no need to keep the memory
+       itsBuffers[0].resize();
+       itsBuffers[1].resize();
+   }
+}
+
+/// @brief wait for the background job and report its error, if any
+void ImagePlaneWriter::wait()
+{
+   if (itsThread) {
+       itsThread->join();
+       itsThread.reset();
+   }
+   if (itsError.size()) {
+       const std::string msg = itsError;
+       itsError.clear();
+       ASKAPTHROW(AskapError, "Write of plane "<<itsWritePlane<<" into "<<itsName<<" failed: "<<msg);
+   }
+}
+
+/// @brief body of the background job
+/// @details Exceptions can't propagate across threads, therefore the error message is
+/// stored and reported by the next call to wait.
+/// @param[in] buffer index of the buffer to write
+void ImagePlaneWriter::run(casacore::uInt buffer)
+{
+   try {
+      itsAccessor.write(itsName, itsBuffers[buffer], planePosition(itsWritePlane));
+   }
+   catch (const std::exception &ex) {
+      itsError = ex.what();
+      if (itsError.empty()) {
+          itsError = "unknown error";
+      }
+   }
+}
+
+/// @brief position of the given plane in the image
+/// @param[in] plane plane number
+/// @return bottom left corner of the plane
+casacore::IPosition ImagePlaneWriter::planePosition(casacore::uInt plane) const
+{
+   casacore::IPosition where(itsShape.nelements(), 0);
+   for (casacore::uInt dim = 2; dim < itsShape.nelements(); ++dim) {
+        where[dim] = plane % itsShape[dim];
+        plane /= itsShape[dim];
+   }
+   return where;
+}
+
+} // namespace accessors
+
+} // namespace askap
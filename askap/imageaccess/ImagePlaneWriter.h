@@ -0,0 +1,184 @@
+/// @file
+/// @brief sequential plane-by-plane writer of an image
+/// @details This class writes an image one plane at a time via the generic
+/// IImageAccess interface, so only two planes have to be kept in memory regardless
+/// of the cube size. Writes are done in a background thread (double buffering), so
+/// the caller can compute the next plane while the previous one is being written.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_PLANE_WRITER_H
+#define ASKAP_ACCESSORS_IMAGE_PLANE_WRITER_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+namespace askap {
+
+namespace accessors {
+
+// forward declaration
+struct IImageAccess;
+
+/// @brief sequential plane-by-plane writer of an image
+/// @details This class writes an image one plane at a time via the generic
+/// IImageAccess interface, so only two planes have to be kept in memory regardless
+/// of the cube size. A plane covers the first two axes of the image, planes are
+/// appended in the order of the remaining axes (the third axis changes fastest).
+/// The image should be created (i.e. IImageAccess::create is called) before this
+/// object is constructed. In the asynchronous mode the plane is written in a
+/// background thread while the caller fills the other buffer, so image synthesis
+/// for the next plane overlaps the I/O for the current one. The typical usage is
+/// @code
+///    boost::shared_ptr<ImagePlaneWriter> writer = imgAccess.planeWriter(name);
+///    for (casacore::uInt plane = 0; plane < writer->nPlanes(); ++plane) {
+///         makePlane(writer->plane());
+///         writer->appendPlane();
+///    }
+///    writer->close();
+/// @endcode
+/// @note The accessor is referenced, rather than copied. It should outlive this object
+/// and should not be used by other code until close is called, because the actual writes
+/// may happen in another thread.
+/// @ingroup imageaccess
+class ImagePlaneWriter : private boost::noncopyable {
+public:
+
+   /// @brief constructor
+   /// @param[in] acc image accessor to use for writing
+   /// @param[in] name image name
+   /// @param[in] async if true, planes are written in a background thread
+   ImagePlaneWriter(IImageAccess &acc, const std::string &name, bool async = true);
+
+   /// @brief destructor, waits for the write in progress to finish
+   ~ImagePlaneWriter();
+
+   /// @brief obtain the buffer for the next plane
+   /// @details The buffer is not changed by appendPlane (which switches to the other
+   /// buffer), so planes can be filled in place without extra copying. The content is
+   /// undefined until the buffer is filled by the caller.
+   /// @return reference to the array of planeShape() shape
+   casacore::Array<float>& plane();
+
+   /// @brief write the plane given by plane()
+   /// @details In the asynchronous mode this method waits for the previous write
+   /// to finish and starts writing the current buffer in the background.
+   /// Any error encountered by the previous write is reported here.
+   void appendPlane();
+
+   /// @brief write the given plane
+   /// @details This version copies the array into the buffer first.
+   /// @param[in] arr array with pixels (should be of planeShape() shape)
+   void appendPlane(const casacore::Array<float> &arr);
+
+   /// @brief wait for all writes to finish
+   /// @details Any error encountered by the background write is reported here.
+   /// No further planes can be appended after this method is called.
+   void close();
+
+   /// @brief shape of a single plane
+   /// @return 2-element shape of the plane
+   inline const casacore::IPosition& planeShape() const { return itsPlaneShape; }
+
+   /// @brief total number of planes in the image
+   /// @return number of planes
+   inline casacore::uInt nPlanes() const { return itsNPlanes; }
+
+   /// @brief number of planes appended so far
+   /// @return number of planes
+   inline casacore::uInt nAppended() const { return itsNAppended; }
+
+protected:
+
+   /// @brief wait for the background job and report its error, if any
+   void wait();
+
+   /// @brief body of the background job
+   /// @details Exceptions can't propagate across threads, therefore the error message is
+   /// stored and reported by the next call to wait.
+   /// @param[in] buffer index of the buffer to write
+   void run(casacore::uInt buffer);
+
+   /// @brief position of the given plane in the image
+   /// @param[in] plane plane number
+   /// @return bottom left corner of the plane
+   casacore::IPosition planePosition(casacore::uInt plane) const;
+
+private:
+   /// @brief accessor to write with
+   IImageAccess &itsAccessor;
+
+   /// @brief image name
+   const std::string itsName;
+
+   /// @brief true, if writes are done in a background thread
+   const bool itsAsync;
+
+   /// @brief full shape of the image
+   const casacore::IPosition itsShape;
+
+   /// @brief shape of a single plane
+   casacore::IPosition itsPlaneShape;
+
+   /// @brief total number of planes
+   casacore::uInt itsNPlanes;
+
+   /// @brief number of planes appended so far
+   casacore::uInt itsNAppended;
+
+   /// @brief double buffer
+   casacore::Array<float> itsBuffers[2];
+
+   /// @brief index of the buffer being filled by the caller
+   casacore::uInt itsCurrentBuffer;
+
+   /// @brief plane written by the background job
+   casacore::uInt itsWritePlane;
+
+   /// @brief error message of the background job (empty if successful)
+   std::string itsError;
+
+   /// @brief true, if close has been called
+   bool itsClosed;
+
+   /// @brief background thread
+   boost::shared_ptr<boost::thread> itsThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IMAGE_PLANE_WRITER_H
@@ -0,0 +1,176 @@
+/// @file
+/// @brief lock of a rectangular region of an image
+/// @details Read-modify-write operations like IImageAccess::accumulate done by a
+/// number of threads have to be serialised if they touch the same pixels. This class
+/// locks a rectangular region of the named image for the lifetime of the object. Threads
+/// locking disjoint regions proceed concurrently, a thread locking a region overlapping
+/// with a region held by another thread waits until that region is released.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// own includes
+#include <askap/imageaccess/ImageRegionLock.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+
+// std includes
+#include <list>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief region held by one of the locks
+struct LockedRegion {
+   /// @brief image name
+   std::string itsName;
+   /// @brief bottom left corner
+   casacore::IPosition itsBlc;
+   /// @brief top right corner
+   casacore::IPosition itsTrc;
+};
+
+/// @brief table of regions locked in this process
+struct LockTable {
+   /// @brief mutex protecting the table
+   boost::mutex itsMutex;
+   /// @brief condition signalled when a region is released
+   boost::condition_variable itsReleased;
+   /// @brief regions currently held
+   std::list<LockedRegion> itsRegions;
+};
+
+/// @brief the table shared by all locks
+/// @return reference to the table
+LockTable& lockTable()
+{
+   static LockTable table;
+   return table;
+}
+
+/// @brief check whether the region overlaps with any held region of the same image
+/// @details This function should be called with the table mutex locked.
+/// @param[in] table lock table
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the region
+/// @param[in] trc top right corner of the region
+/// @return true if the region can't be locked yet
+bool isBusy(const LockTable &table, const std::string &name, const casacore::IPosition &blc,
+            const casacore::IPosition &trc)
+{
+   for (std::list<LockedRegion>::const_iterator ci = table.itsRegions.begin(); ci != table.itsRegions.end(); ++ci) {
+        if ((ci->itsName == name) && ImageRegionLock::overlap(blc, trc, ci->itsBlc, ci->itsTrc)) {
+            return true;
+        }
+   }
+   return false;
+}
+
+} // anonymous namespace
+
+/// @brief lock the region
+/// @details This method waits until no overlapping region of the same image is locked.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the region (inclusive)
+/// @param[in] trc top right corner of the region (inclusive)
+ImageRegionLock::ImageRegionLock(const std::string &name, const casacore::IPosition &blc,
+                                 const casacore::IPosition &trc) : itsName(name), itsBlc(blc), itsTrc(trc)
+{
+   ASKAPCHECK(blc.nelements() == trc.nelements(), "Corners of the locked region should have the same dimensions, you have "<<
+              blc<<" and "<<trc);
+   LockTable &table = lockTable();
+   boost::unique_lock<boost::mutex> lock(table.itsMutex);
+   while (isBusy(table, name, blc, trc)) {
+          table.itsReleased.wait(lock);
+   }
+   LockedRegion region;
+   region.itsName = name;
+   region.itsBlc = blc;
+   region.itsTrc = trc;
+   table.itsRegions.push_back(region);
+}
+
+/// @brief release the region
+ImageRegionLock::~ImageRegionLock()
+{
+   LockTable &table = lockTable();
+   {
+     boost::lock_guard<boost::mutex> lock(table.itsMutex);
+     for (std::list<LockedRegion>::iterator it = table.itsRegions.begin(); it != table.itsRegions.end(); ++it) {
+          if ((it->itsName == itsName) && (it->itsBlc == itsBlc) && (it->itsTrc == itsTrc)) {
+              table.itsRegions.erase(it);
+              break;
+          }
+     }
+   }
+   table.itsReleased.notify_all();
+}
+
+/// @brief check whether two regions overlap
+/// @param[in] blc1 bottom left corner of the first region
+/// @param[in] trc1 top right corner of the first region
+/// @param[in] blc2 bottom left corner of the second region
+/// @param[in] trc2 top right corner of the second region
+/// @return true if at least one pixel belongs to both regions
+bool ImageRegionLock::overlap(const casacore::IPosition &blc1, const casacore::IPosition &trc1,
+                              const casacore::IPosition &blc2, const casacore::IPosition &trc2)
+{
+   // regions of different dimensions are conservatively treated as overlapping
+   if ((blc1.nelements() != blc2.nelements()) || (trc1.nelements() != trc2.nelements())) {
+       return true;
+   }
+   for (size_t dim = 0; dim < blc1.nelements(); ++dim) {
+        if ((trc1[dim] < blc2[dim]) || (trc2[dim] < blc1[dim])) {
+            return false;
+        }
+   }
+   return true;
+}
+
+/// @brief number of regions locked in this process
+/// @return number of locks held
+size_t ImageRegionLock::nLocked()
+{
+   LockTable &table = lockTable();
+   boost::lock_guard<boost::mutex> lock(table.itsMutex);
+   return table.itsRegions.size();
+}
+
+/// @brief mutex serialising storage access of the operations on locked regions
+/// @return reference to the mutex shared by the whole process
+boost::mutex& ImageRegionLock::storageMutex()
+{
+   static boost::mutex mutex;
+   return mutex;
+}
+
+} // namespace accessors
+
+} // namespace askap
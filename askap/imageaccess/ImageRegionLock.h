@@ -0,0 +1,110 @@
+/// @file
+/// @brief lock of a rectangular region of an image
+/// @details Read-modify-write operations like IImageAccess::accumulate done by a
+/// number of threads have to be serialised if they touch the same pixels. This class
+/// locks a rectangular region of the named image for the lifetime of the object. Threads
+/// locking disjoint regions proceed concurrently, a thread locking a region overlapping
+/// with a region held by another thread waits until that region is released.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_IMAGE_REGION_LOCK_H
+#define ASKAP_ACCESSORS_IMAGE_REGION_LOCK_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/IPosition.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief lock of a rectangular region of an image
+/// @details The region is locked by the constructor (which waits if necessary) and
+/// released by the destructor. Locks are held in a table shared by the whole process,
+/// images are identified by name, so accessors of different types opened on the same
+/// image share the locks. Locks are not recursive: a thread attempting to lock a region
+/// overlapping with the region it already holds would wait forever. Image storage (e.g.
+/// casacore tables) is generally not thread-safe, therefore the class also provides a
+/// process-wide mutex to serialise the actual reads and writes done while the region is
+/// locked (see storageMutex), so the arithmetic of concurrent operations can still overlap.
+/// The typical usage is
+/// @code
+///    const ImageRegionLock lock(name, blc, trc);
+///    // read, modify and write pixels between blc and trc
+/// @endcode
+/// @ingroup imageaccess
+class ImageRegionLock : private boost::noncopyable {
+public:
+
+   /// @brief lock the region
+   /// @details This method waits until no overlapping region of the same image is locked.
+   /// @param[in] name image name
+   /// @param[in] blc bottom left corner of the region (inclusive)
+   /// @param[in] trc top right corner of the region (inclusive)
+   ImageRegionLock(const std::string &name, const casacore::IPosition &blc, const casacore::IPosition &trc);
+
+   /// @brief release the region
+   ~ImageRegionLock();
+
+   /// @brief check whether two regions overlap
+   /// @param[in] blc1 bottom left corner of the first region
+   /// @param[in] trc1 top right corner of the first region
+   /// @param[in] blc2 bottom left corner of the second region
+   /// @param[in] trc2 top right corner of the second region
+   /// @return true if at least one pixel belongs to both regions
+   static bool overlap(const casacore::IPosition &blc1, const casacore::IPosition &trc1,
+                       const casacore::IPosition &blc2, const casacore::IPosition &trc2);
+
+   /// @brief number of regions locked in this process
+   /// @return number of locks held
+   static size_t nLocked();
+
+   /// @brief mutex serialising storage access of the operations on locked regions
+   /// @return reference to the mutex shared by the whole process
+   static boost::mutex& storageMutex();
+
+private:
+   /// @brief image name
+   const std::string itsName;
+
+   /// @brief bottom left corner of the region
+   const casacore::IPosition itsBlc;
+
+   /// @brief top right corner of the region
+   const casacore::IPosition itsTrc;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IMAGE_REGION_LOCK_H
@@ -0,0 +1,144 @@
+/// @file
+/// @brief lightweight view of a part of an image
+/// @details A view represents a rectangular region of an image accessed via the
+/// IImageAccess interface. It doesn't read anything on construction, the coordinate
+/// system of the region is derived from that of the full image by shifting the reference
+/// pixel and pixels are read only when requested.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/imageaccess/ImageView.h>
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] acc image accessor to read with
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the region
+/// @param[in] trc top right corner of the region (inclusive)
+ImageView::ImageView(const IImageAccess &acc, const std::string &name, const casacore::IPosition &blc,
+                     const casacore::IPosition &trc) :
+     itsAccessor(acc), itsName(name), itsBlc(blc), itsTrc(trc)
+{
+   ASKAPCHECK(blc.nelements() == trc.nelements(), "Dimensions of blc ("<<blc<<") and trc ("<<trc<<
+              ") of the view of image "<<name<<" should match");
+   ASKAPCHECK(blc >= 0 && trc >= blc, "Invalid region blc="<<blc<<" trc="<<trc<<" for the view of image "<<name);
+}
+
+/// @brief constructor of a sub-view
+/// @param[in] parent view containing the new one
+/// @param[in] blc bottom left corner of the region in pixels of the full image
+/// @param[in] trc top right corner of the region in pixels of the full image
+ImageView::ImageView(const ImageView &parent, const casacore::IPosition &blc, const casacore::IPosition &trc) :
+     itsAccessor(parent.itsAccessor), itsName(parent.itsName), itsBlc(blc), itsTrc(trc)
+{
+   // make sure the full coordinate system is obtained only once for all views
+   if (!parent.itsImageCoordSys) {
+       parent.itsImageCoordSys.reset(new casacore::CoordinateSystem(itsAccessor.coordSys(itsName)));
+   }
+   itsImageCoordSys = parent.itsImageCoordSys;
+}
+
+/// @brief obtain a view of a part of this view
+/// @details The new view shares the coordinate system of the full image with this one.
+/// @param[in] blc bottom left corner of the region relative to this view
+/// @param[in] trc top right corner of the region relative to this view (inclusive)
+/// @return shared pointer to the new view
+boost::shared_ptr<ImageView> ImageView::subView(const casacore::IPosition &blc, const casacore::IPosition &trc) const
+{
+   checkSelection(blc, trc);
+   return boost::shared_ptr<ImageView>(new ImageView(*this, itsBlc + blc, itsBlc + trc));
+}
+
+/// @brief obtain coordinate system of the region
+/// @return coordinate system with the reference pixel shifted to the blc of the view
+const casacore::CoordinateSystem& ImageView::coordSys() const
+{
+   if (!itsCoordSys) {
+       if (!itsImageCoordSys) {
+           itsImageCoordSys.reset(new casacore::CoordinateSystem(itsAccessor.coordSys(itsName)));
+       }
+       itsCoordSys.reset(new casacore::CoordinateSystem(sliceCoordSys(*itsImageCoordSys, itsBlc, itsTrc)));
+   }
+   return *itsCoordSys;
+}
+
+/// @brief read pixels of the region
+/// @return array with pixels
+casacore::Array<float> ImageView::read() const
+{
+   return itsAccessor.read(itsName, itsBlc, itsTrc);
+}
+
+/// @brief read a part of the region
+/// @param[in] blc bottom left corner of the selection relative to this view
+/// @param[in] trc top right corner of the selection relative to this view (inclusive)
+/// @return array with pixels for the selection only
+casacore::Array<float> ImageView::read(const casacore::IPosition &blc, const casacore::IPosition &trc) const
+{
+   checkSelection(blc, trc);
+   return itsAccessor.read(itsName, itsBlc + blc, itsBlc + trc);
+}
+
+/// @brief check that the selection is within this view
+/// @param[in] blc bottom left corner of the selection relative to this view
+/// @param[in] trc top right corner of the selection relative to this view
+void ImageView::checkSelection(const casacore::IPosition &blc, const casacore::IPosition &trc) const
+{
+   ASKAPCHECK(blc.nelements() == itsBlc.nelements() && trc.nelements() == itsBlc.nelements(),
+              "Selection blc="<<blc<<" trc="<<trc<<" should have "<<itsBlc.nelements()<<" dimensions");
+   ASKAPCHECK(blc >= 0 && trc >= blc && trc < shape(), "Selection blc="<<blc<<" trc="<<trc<<
+              " is outside the view of shape "<<shape());
+}
+
+/// @brief coordinate system of a part of an image
+/// @details The reference pixel is shifted by blc (and the Stokes axis is trimmed), which
+/// gives the same result as casacore::SubImage without the need to construct one.
+/// @param[in] csys coordinate system of the full image
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return coordinate system of the selection
+casacore::CoordinateSystem ImageView::sliceCoordSys(const casacore::CoordinateSystem &csys,
+                  const casacore::IPosition &blc, const casacore::IPosition &trc)
+{
+   ASKAPCHECK(blc.nelements() == csys.nPixelAxes() && trc.nelements() == blc.nelements(),
+              "Selection blc="<<blc<<" trc="<<trc<<" doesn't match "<<csys.nPixelAxes()<<
+              " pixel axes of the coordinate system");
+   casacore::Vector<casacore::Float> shift(blc.nelements()), incr(blc.nelements(), 1.);
+   for (size_t dim = 0; dim < blc.nelements(); ++dim) {
+        shift(dim) = blc(dim);
+   }
+   return csys.subImage(shift, incr, (trc - blc + 1).asVector());
+}
+
+} // namespace accessors
+
+} // namespace askap
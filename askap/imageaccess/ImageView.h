@@ -0,0 +1,166 @@
+/// @file
+/// @brief lightweight view of a part of an image
+/// @details A view represents a rectangular region of an image accessed via the
+/// IImageAccess interface. It doesn't read anything on construction, the coordinate
+/// system of the region is derived from that of the full image by shifting the reference
+/// pixel and pixels are read only when requested.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_VIEW_H
+#define ASKAP_ACCESSORS_IMAGE_VIEW_H
+
+// std includes
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+
+namespace askap {
+
+namespace accessors {
+
+// forward declaration
+struct IImageAccess;
+
+/// @brief lightweight view of a part of an image
+/// @details This class represents the region between blc and trc (inclusive) of an image.
+/// Unlike casacore::SubImage, constructing the view doesn't touch the image. The coordinate
+/// system of the full image is obtained from the accessor when it is first needed and is
+/// shared with all views created from this one with subView, so a large number of small views
+/// of the same image (e.g. in mosaicking) requires only one coordinate system query. The
+/// coordinate system of the view is computed arithmetically (see sliceCoordSys) and cached.
+/// Pixels are not cached, each call to read gets them from the accessor (which typically
+/// keeps the image open). The typical usage is
+/// @code
+///    boost::shared_ptr<ImageView> field = imgAccess.view(name, blc, trc);
+///    for (size_t i = 0; i < patches.size(); ++i) {
+///         boost::shared_ptr<ImageView> patch = field->subView(patches[i].blc, patches[i].trc);
+///         process(patch->coordSys(), patch->read());
+///    }
+/// @endcode
+/// @note The accessor is referenced, rather than copied. It should outlive this object.
+/// @ingroup imageaccess
+class ImageView {
+public:
+
+   /// @brief constructor
+   /// @param[in] acc image accessor to read with
+   /// @param[in] name image name
+   /// @param[in] blc bottom left corner of the region
+   /// @param[in] trc top right corner of the region (inclusive)
+   ImageView(const IImageAccess &acc, const std::string &name, const casacore::IPosition &blc,
+             const casacore::IPosition &trc);
+
+   /// @brief obtain a view of a part of this view
+   /// @details The new view shares the coordinate system of the full image with this one.
+   /// @param[in] blc bottom left corner of the region relative to this view
+   /// @param[in] trc top right corner of the region relative to this view (inclusive)
+   /// @return shared pointer to the new view
+   boost::shared_ptr<ImageView> subView(const casacore::IPosition &blc, const casacore::IPosition &trc) const;
+
+   /// @brief image name
+   /// @return name of the image this view belongs to
+   inline const std::string& name() const { return itsName; }
+
+   /// @brief bottom left corner of the region
+   /// @return blc in pixels of the full image
+   inline const casacore::IPosition& blc() const { return itsBlc; }
+
+   /// @brief top right corner of the region
+   /// @return trc (inclusive) in pixels of the full image
+   inline const casacore::IPosition& trc() const { return itsTrc; }
+
+   /// @brief shape of the region
+   /// @return shape of the view
+   inline casacore::IPosition shape() const { return itsTrc - itsBlc + 1; }
+
+   /// @brief obtain coordinate system of the region
+   /// @return coordinate system with the reference pixel shifted to the blc of the view
+   const casacore::CoordinateSystem& coordSys() const;
+
+   /// @brief read pixels of the region
+   /// @return array with pixels
+   casacore::Array<float> read() const;
+
+   /// @brief read a part of the region
+   /// @param[in] blc bottom left corner of the selection relative to this view
+   /// @param[in] trc top right corner of the selection relative to this view (inclusive)
+   /// @return array with pixels for the selection only
+   casacore::Array<float> read(const casacore::IPosition &blc, const casacore::IPosition &trc) const;
+
+   /// @brief coordinate system of a part of an image
+   /// @details The reference pixel is shifted by blc (and the Stokes axis is trimmed), which
+   /// gives the same result as casacore::SubImage without the need to construct one.
+   /// @param[in] csys coordinate system of the full image
+   /// @param[in] blc bottom left corner of the selection
+   /// @param[in] trc top right corner of the selection (inclusive)
+   /// @return coordinate system of the selection
+   static casacore::CoordinateSystem sliceCoordSys(const casacore::CoordinateSystem &csys,
+                  const casacore::IPosition &blc, const casacore::IPosition &trc);
+
+private:
+
+   /// @brief constructor of a sub-view
+   /// @param[in] parent view containing the new one
+   /// @param[in] blc bottom left corner of the region in pixels of the full image
+   /// @param[in] trc top right corner of the region in pixels of the full image
+   ImageView(const ImageView &parent, const casacore::IPosition &blc, const casacore::IPosition &trc);
+
+   /// @brief check that the selection is within this view
+   /// @param[in] blc bottom left corner of the selection relative to this view
+   /// @param[in] trc top right corner of the selection relative to this view
+   void checkSelection(const casacore::IPosition &blc, const casacore::IPosition &trc) const;
+
+   /// @brief accessor to read with
+   const IImageAccess &itsAccessor;
+
+   /// @brief image name
+   std::string itsName;
+
+   /// @brief bottom left corner of the region
+   casacore::IPosition itsBlc;
+
+   /// @brief top right corner of the region (inclusive)
+   casacore::IPosition itsTrc;
+
+   /// @brief coordinate system of the full image (shared between sub-views, empty until needed)
+   mutable boost::shared_ptr<casacore::CoordinateSystem> itsImageCoordSys;
+
+   /// @brief coordinate system of the region (empty until needed)
+   mutable boost::shared_ptr<casacore::CoordinateSystem> itsCoordSys;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IMAGE_VIEW_H
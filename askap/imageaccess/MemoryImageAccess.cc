@@ -0,0 +1,488 @@
+/// @file MemoryImageAccess.cc
+/// @brief Access images held in memory
+/// @details This class implements IImageAccess interface for images which are never
+/// written to disk unless requested. It is intended for intermediate products consumed
+/// in the same process (e.g. a residual image passed to the source finder) and for tests.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap/imageaccess/ImageRegionLock.h>
+#include <askap/imageaccess/ImageView.h>
+
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+#include <utility>
+#include <vector>
+
+ASKAP_LOGGER(logger, ".memoryImageAccessor");
+
+namespace askap {
+namespace accessors {
+
+/// @brief image held in memory
+struct MemoryImage {
+    /// @brief pixels
+    casacore::Array<float> pixels;
+
+    /// @brief pixel mask (empty if the image has no mask)
+    casacore::Array<bool> mask;
+
+    /// @brief coordinate system
+    casacore::CoordinateSystem csys;
+
+    /// @brief brightness units
+    std::string units;
+
+    /// @brief true if the restoring beam has been set
+    bool hasBeam;
+
+    /// @brief restoring beam (major, minor, position angle)
+    casacore::Vector<casacore::Quantum<double> > beam;
+
+    /// @brief per-channel beams
+    IImageAccess::BeamList beams;
+
+    /// @brief metadata keywords, value and description for each keyword
+    std::map<std::string, std::pair<std::string, std::string> > keywords;
+
+    /// @brief history messages
+    std::vector<std::string> history;
+};
+
+} // namespace accessors
+} // namespace askap
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief check that the slice fits into the image
+/// @param[in] imageShape shape of the image
+/// @param[in] blc bottom left corner of the slice
+/// @param[in] trc top right corner of the slice
+static void checkSlice(const casacore::IPosition &imageShape, const casacore::IPosition &blc,
+                       const casacore::IPosition &trc)
+{
+    ASKAPCHECK((blc.nelements() == imageShape.nelements()) && (trc.nelements() == imageShape.nelements()),
+               "Mismatch in dimensions - image has " << imageShape.nelements() << " axes, while the selection is from " <<
+               blc << " to " << trc);
+    for (size_t dim = 0; dim < imageShape.nelements(); ++dim) {
+         ASKAPCHECK((blc(dim) >= 0) && (blc(dim) <= trc(dim)) && (trc(dim) < imageShape(dim)), "Selection from " <<
+                    blc << " to " << trc << " doesn't fit into the image " << imageShape);
+    }
+}
+
+/// @brief bottom left and top right corners of the slice being written
+/// @details Axes missing in the shape of the array are assumed to be degenerate.
+/// @param[in] imageShape shape of the image
+/// @param[in] arrShape shape of the array to write
+/// @param[in] where bottom left corner where to put the array
+/// @return top right corner of the slice
+static casacore::IPosition sliceEnd(const casacore::IPosition &imageShape, const casacore::IPosition &arrShape,
+                                    const casacore::IPosition &where)
+{
+    ASKAPCHECK(arrShape.nelements() <= imageShape.nelements(), "Array with " << arrShape.nelements() <<
+               " dimensions doesn't fit into " << imageShape.nelements() << "-dimensional image");
+    casacore::IPosition trc(where);
+    for (size_t dim = 0; dim < arrShape.nelements(); ++dim) {
+         trc(dim) += arrShape(dim) - 1;
+    }
+    checkSlice(imageShape, where, trc);
+    return trc;
+}
+
+/// @brief constructor
+/// @param[in] persistence accessor used to write images to disk on close
+/// (empty pointer means that images are only kept in memory)
+MemoryImageAccess::MemoryImageAccess(const boost::shared_ptr<IImageAccess> &persistence) :
+    itsPersistence(persistence) {}
+
+/// @brief check whether the image exists in memory
+/// @param[in] name image name
+/// @return true if the image has been created and not removed
+bool MemoryImageAccess::exists(const std::string &name) const
+{
+    return itsImages.find(name) != itsImages.end();
+}
+
+/// @brief release the memory used by the image
+/// @param[in] name image name
+void MemoryImageAccess::remove(const std::string &name)
+{
+    itsImages.erase(name);
+}
+
+/// @brief obtain the image
+/// @param[in] name image name
+/// @return shared pointer to the image (an exception is thrown if it doesn't exist)
+boost::shared_ptr<MemoryImage> MemoryImageAccess::image(const std::string &name) const
+{
+    const std::map<std::string, boost::shared_ptr<MemoryImage> >::const_iterator it = itsImages.find(name);
+    ASKAPCHECK(it != itsImages.end(), "Image " << name << " doesn't exist in memory");
+    return it->second;
+}
+
+/// @brief obtain the pixel mask
+/// @param[in] name image name
+/// @return array referencing the mask (empty if the image has no mask)
+casacore::Array<bool> MemoryImageAccess::mask(const std::string &name) const
+{
+    return image(name)->mask;
+}
+
+// reading methods
+
+/// @brief obtain the shape
+/// @param[in] name image name
+/// @return full shape of the given image
+casacore::IPosition MemoryImageAccess::shape(const std::string &name) const
+{
+    return image(name)->pixels.shape();
+}
+
+/// @brief read full image
+/// @param[in] name image name
+/// @return array referencing the pixels
+casacore::Array<float> MemoryImageAccess::read(const std::string &name) const
+{
+    return image(name)->pixels;
+}
+
+/// @brief read part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return array referencing the pixels for the selection only
+casacore::Array<float> MemoryImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    checkSlice(img->pixels.shape(), blc, trc);
+    // section references the same storage
+    return img->pixels(blc, trc);
+}
+
+/// @brief read part of the image into the given buffer
+/// @details Unlike the by-value read, the pixels are copied into the buffer, which is
+/// only resized if its shape differs from that of the selection.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill
+void MemoryImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                             const casacore::IPosition &trc, casacore::Array<float> &buffer) const
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    checkSlice(img->pixels.shape(), blc, trc);
+    const casacore::IPosition sliceShape = trc - blc + 1;
+    if (!buffer.shape().isEqual(sliceShape)) {
+        buffer.resize(sliceShape);
+    }
+    buffer = img->pixels(blc, trc);
+}
+
+/// @brief obtain coordinate system info
+/// @param[in] name image name
+/// @return coordinate system object
+casacore::CoordinateSystem MemoryImageAccess::coordSys(const std::string &name) const
+{
+    return image(name)->csys;
+}
+
+/// @brief obtain coordinate system info for part of an image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return coordinate system object
+casacore::CoordinateSystem MemoryImageAccess::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    return ImageView::sliceCoordSys(image(name)->csys, blc, trc);
+}
+
+/// @brief obtain beam info
+/// @param[in] name image name
+/// @return beam info vector
+casacore::Vector<casacore::Quantum<double> > MemoryImageAccess::beamInfo(const std::string &name) const
+{
+    return image(name)->beam.copy();
+}
+
+/// @brief obtain per-channel beam info
+/// @param[in] name image name
+/// @return one beam per channel, empty if the image has no per-channel beams
+IImageAccess::BeamList MemoryImageAccess::beamList(const std::string &name) const
+{
+    return image(name)->beams;
+}
+
+/// @brief obtain pixel units
+/// @param[in] name image name
+/// @return units string
+std::string MemoryImageAccess::getUnits(const std::string &name) const
+{
+    return image(name)->units;
+}
+
+/// @brief Get a particular keyword from the image metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @return value of the keyword (empty string if it is not defined)
+std::string MemoryImageAccess::getMetadataKeyword(const std::string &name, const std::string &keyword) const
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    const std::map<std::string, std::pair<std::string, std::string> >::const_iterator it = img->keywords.find(keyword);
+    if (it == img->keywords.end()) {
+        ASKAPLOG_WARN_STR(logger, "Keyword " << keyword << " is not defined in metadata for image " << name);
+        return "";
+    }
+    return it->second.first;
+}
+
+// writing methods
+
+/// @brief create a new image
+/// @details The pixels are allocated and set to zero, an existing image with the
+/// same name is replaced.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+void MemoryImageAccess::create(const std::string &name, const casacore::IPosition &shape,
+                               const casacore::CoordinateSystem &csys)
+{
+    ASKAPLOG_INFO_STR(logger, "Creating a new in-memory image " << name << " with the shape " << shape);
+    const boost::shared_ptr<MemoryImage> img(new MemoryImage);
+    img->pixels.resize(shape);
+    img->pixels.set(0.f);
+    img->csys = csys;
+    img->hasBeam = false;
+    img->beam.resize(3);
+    img->beam = casacore::Quantum<double>(0., "rad");
+    // replacing the entry keeps arrays returned for the old image valid
+    itsImages[name] = img;
+}
+
+/// @brief write full image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+void MemoryImageAccess::write(const std::string &name, const casacore::Array<float> &arr)
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    ASKAPCHECK(arr.shape() == img->pixels.shape(), "Shape of the array " << arr.shape() <<
+               " doesn't match the shape of image " << name << ": " << img->pixels.shape());
+    img->pixels = arr;
+}
+
+/// @brief write a slice of an image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void MemoryImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
+                              const casacore::IPosition &where)
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    const casacore::IPosition trc = sliceEnd(img->pixels.shape(), arr.shape(), where);
+    casacore::Array<float> section = img->pixels(where, trc);
+    section = arr.reform(section.shape());
+}
+
+/// @brief add weighted pixels to a slice of an image
+/// @details The pixels held in memory are updated in place, no copy of the slice
+/// is made. The slice is locked (see ImageRegionLock) while it is updated.
+/// @param[in] name image name
+/// @param[in] arr array with pixels to add (axes missing in the shape are assumed to be degenerate)
+/// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+/// @param[in] weights weights of the same shape as arr, an empty array means unit weights
+void MemoryImageAccess::accumulate(const std::string &name, const casacore::Array<float> &arr,
+                                   const casacore::IPosition &where, const casacore::Array<float> &weights)
+{
+    if (arr.nelements() == 0) {
+        return;
+    }
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    const casacore::IPosition trc = accumulationEnd(img->pixels.shape(), arr, where, weights);
+    const ImageRegionLock lock(name, where, trc);
+    casacore::Array<float> section = img->pixels(where, trc);
+    addWeighted(section, arr, weights);
+}
+
+/// @brief write a slice of an image mask
+/// @details The mask is created (with all pixels good) if necessary.
+/// @param[in] name image name
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void MemoryImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                                  const casacore::IPosition &where)
+{
+    makeDefaultMask(name);
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    const casacore::IPosition trc = sliceEnd(img->mask.shape(), mask.shape(), where);
+    casacore::Array<bool> section = img->mask(where, trc);
+    section = mask.reform(section.shape());
+}
+
+/// @brief write an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+void MemoryImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    ASKAPCHECK(mask.shape() == img->pixels.shape(), "Shape of the mask " << mask.shape() <<
+               " doesn't match the shape of image " << name << ": " << img->pixels.shape());
+    img->mask.resize(mask.shape());
+    img->mask = mask;
+}
+
+/// @brief set brightness units of the image
+/// @param[in] name image name
+/// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+void MemoryImageAccess::setUnits(const std::string &name, const std::string &units)
+{
+    image(name)->units = units;
+}
+
+/// @brief set restoring beam info
+/// @param[in] name image name
+/// @param[in] maj major axis in radians
+/// @param[in] min minor axis in radians
+/// @param[in] pa position angle in radians
+void MemoryImageAccess::setBeamInfo(const std::string &name, double maj, double min, double pa)
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    img->beam[0] = casacore::Quantum<double>(maj, "rad");
+    img->beam[1] = casacore::Quantum<double>(min, "rad");
+    img->beam[2] = casacore::Quantum<double>(pa, "rad");
+    img->hasBeam = true;
+}
+
+/// @brief set per-channel beam info
+/// @param[in] name image name
+/// @param[in] beams one beam per channel
+void MemoryImageAccess::setBeamList(const std::string &name, const BeamList &beams)
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    const casacore::uInt nChan = nChannels(img->pixels.shape(), img->csys);
+    ASKAPCHECK(beams.size() == nChan, "Number of beams (" << beams.size() << ") should match the number of channels (" <<
+               nChan << ") of " << name);
+    img->beams.resize(beams.size());
+    for (size_t chan = 0; chan < beams.size(); ++chan) {
+         ASKAPCHECK(beams[chan].nelements() == 3, "Beam for channel " << chan << " should have 3 elements");
+         img->beams[chan].reference(beams[chan].copy());
+    }
+}
+
+/// @brief apply mask to image
+/// @details The mask with all pixels good is created if the image has no mask.
+/// @param[in] name image name
+void MemoryImageAccess::makeDefaultMask(const std::string &name)
+{
+    const boost::shared_ptr<MemoryImage> img = image(name);
+    if (img->mask.shape() != img->pixels.shape()) {
+        img->mask.resize(img->pixels.shape());
+        img->mask.set(true);
+    }
+}
+
+/// @brief Set a particular keyword for the metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @param[in] value The value for the keyword, in string format
+/// @param[in] desc A description of the keyword
+void MemoryImageAccess::setMetadataKeyword(const std::string &name, const std::string &keyword,
+        const std::string value, const std::string &desc)
+{
+    image(name)->keywords[keyword] = std::make_pair(value, desc);
+}
+
+/// @brief Add a HISTORY message to the image metadata
+/// @param[in] name Image name
+/// @param[in] history History comment to add
+void MemoryImageAccess::addHistory(const std::string &name, const std::string &history)
+{
+    image(name)->history.push_back(history);
+}
+
+// handle management
+
+/// @brief write the image with the persistence accessor
+/// @param[in] name image name
+/// @param[in] img image to write
+void MemoryImageAccess::persist(const std::string &name, const MemoryImage &img)
+{
+    ASKAPDEBUGASSERT(itsPersistence);
+    ASKAPLOG_INFO_STR(logger, "Writing in-memory image " << name << " to disk");
+    itsPersistence->create(name, img.pixels.shape(), img.csys);
+    itsPersistence->write(name, img.pixels);
+    if (img.mask.nelements() > 0) {
+        itsPersistence->writeMask(name, img.mask);
+    }
+    if (img.units.size() > 0) {
+        itsPersistence->setUnits(name, img.units);
+    }
+    if (img.hasBeam) {
+        itsPersistence->setBeamInfo(name, img.beam[0].getValue("rad"), img.beam[1].getValue("rad"),
+                                    img.beam[2].getValue("rad"));
+    }
+    if (img.beams.size() > 0) {
+        itsPersistence->setBeamList(name, img.beams);
+    }
+    for (std::map<std::string, std::pair<std::string, std::string> >::const_iterator it = img.keywords.begin();
+         it != img.keywords.end(); ++it) {
+         itsPersistence->setMetadataKeyword(name, it->first, it->second.first, it->second.second);
+    }
+    for (std::vector<std::string>::const_iterator it = img.history.begin(); it != img.history.end(); ++it) {
+         itsPersistence->addHistory(name, *it);
+    }
+    itsPersistence->close(name);
+}
+
+/// @brief close the given image
+/// @details If the persistence target is set, the image is written to disk and
+/// removed from memory. Otherwise, this method does nothing.
+/// @param[in] name image name
+void MemoryImageAccess::close(const std::string &name)
+{
+    if (itsPersistence && exists(name)) {
+        persist(name, *image(name));
+        remove(name);
+    }
+}
+
+/// @brief write all images to disk
+/// @details If the persistence target is set, all images are written to disk, but
+/// kept in memory. Otherwise, this method does nothing.
+void MemoryImageAccess::flush()
+{
+    if (itsPersistence) {
+        for (std::map<std::string, boost::shared_ptr<MemoryImage> >::const_iterator it = itsImages.begin();
+             it != itsImages.end(); ++it) {
+             persist(it->first, *(it->second));
+        }
+    }
+}
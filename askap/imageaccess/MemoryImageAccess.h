@@ -0,0 +1,274 @@
+/// @file MemoryImageAccess.h
+/// @brief Access images held in memory
+/// @details This class implements IImageAccess interface for images which are never
+/// written to disk unless requested. It is intended for intermediate products consumed
+/// in the same process (e.g. a residual image passed to the source finder) and for tests.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_MEMORY_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_MEMORY_IMAGE_ACCESS_H
+
+#include <askap/imageaccess/IImageAccess.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief image held in memory (defined in the .cc file)
+struct MemoryImage;
+
+/// @brief Access images held in memory
+/// @details Images are kept by name as casacore arrays together with their metadata.
+/// Reads do not copy the pixels: the full image or a section of it is returned as an
+/// array referencing the stored pixels (casacore reference semantics). The caller must
+/// therefore not modify the returned arrays (use copy() if necessary) and should be
+/// aware that subsequent writes into the image are seen through the arrays already returned.
+/// Writes copy the pixels into the image, as for the disk-based accessors.
+/// Optionally, another accessor can be given as the persistence target. In this case an image
+/// is written to disk with this accessor (pixels, mask and metadata) when it is closed or when
+/// flush is called, close also releases the memory. Without the target close does nothing,
+/// use remove to release the memory.
+/// @ingroup imageaccess
+struct MemoryImageAccess : public IImageAccess {
+
+    public:
+
+        /// @brief constructor
+        /// @param[in] persistence accessor used to write images to disk on close
+        /// (empty pointer means that images are only kept in memory)
+        explicit MemoryImageAccess(const boost::shared_ptr<IImageAccess> &persistence =
+                                   boost::shared_ptr<IImageAccess>());
+
+        /// @brief check whether the image exists in memory
+        /// @param[in] name image name
+        /// @return true if the image has been created and not removed
+        bool exists(const std::string &name) const;
+
+        /// @brief release the memory used by the image
+        /// @details The image is not written to disk.
+        /// @param[in] name image name
+        void remove(const std::string &name);
+
+        /// @brief obtain the pixel mask
+        /// @param[in] name image name
+        /// @return array referencing the mask (empty if the image has no mask)
+        casacore::Array<bool> mask(const std::string &name) const;
+
+        //////////////////
+        // Reading methods
+        //////////////////
+
+        /// @brief obtain the shape
+        /// @param[in] name image name
+        /// @return full shape of the given image
+        virtual casacore::IPosition shape(const std::string &name) const;
+
+        /// @brief read full image
+        /// @param[in] name image name
+        /// @return array referencing the pixels
+        virtual casacore::Array<float> read(const std::string &name) const;
+
+        /// @brief read part of the image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @return array referencing the pixels for the selection only
+        virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
+                                        const casacore::IPosition &trc) const;
+
+        /// @brief read part of the image into the given buffer
+        /// @details Unlike the by-value read, the pixels are copied into the buffer, which is
+        /// only resized if its shape differs from that of the selection.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[out] buffer array to fill
+        virtual void read(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<float> &buffer) const;
+
+        /// @brief other versions of read are inherited
+        using IImageAccess::read;
+
+        /// @brief obtain coordinate system info
+        /// @param[in] name image name
+        /// @return coordinate system object
+        virtual casacore::CoordinateSystem coordSys(const std::string &name) const;
+
+        /// @brief obtain coordinate system info for part of an image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @return coordinate system object
+        virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+                const casacore::IPosition &trc) const;
+
+        /// @brief obtain beam info
+        /// @param[in] name image name
+        /// @return beam info vector
+        virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const;
+
+        /// @brief obtain per-channel beam info
+        /// @param[in] name image name
+        /// @return one beam per channel, empty if the image has no per-channel beams
+        virtual BeamList beamList(const std::string &name) const;
+
+        /// @brief obtain pixel units
+        /// @param[in] name image name
+        /// @return units string
+        virtual std::string getUnits(const std::string &name) const;
+
+        /// @brief Get a particular keyword from the image metadata (A.K.A header)
+        /// @param[in] name Image name
+        /// @param[in] keyword The name of the metadata keyword
+        /// @return value of the keyword (empty string if it is not defined)
+        virtual std::string getMetadataKeyword(const std::string &name, const std::string &keyword) const;
+
+        //////////////////
+        // Writing methods
+        //////////////////
+
+        /// @brief create a new image
+        /// @details The pixels are allocated and set to zero, an existing image with the
+        /// same name is replaced.
+        /// @param[in] name image name
+        /// @param[in] shape full shape of the image
+        /// @param[in] csys coordinate system of the full image
+        virtual void create(const std::string &name, const casacore::IPosition &shape,
+                            const casacore::CoordinateSystem &csys);
+
+        /// @brief write full image
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        virtual void write(const std::string &name, const casacore::Array<float> &arr);
+
+        /// @brief write a slice of an image
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void write(const std::string &name, const casacore::Array<float> &arr,
+                           const casacore::IPosition &where);
+
+        /// @brief add weighted pixels to a slice of an image
+        /// @details The pixels held in memory are updated in place, no copy of the slice
+        /// is made. The slice is locked (see ImageRegionLock) while it is updated.
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels to add (axes missing in the shape are assumed to be degenerate)
+        /// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+        /// @param[in] weights weights of the same shape as arr, an empty array means unit weights
+        virtual void accumulate(const std::string &name, const casacore::Array<float> &arr,
+                                const casacore::IPosition &where, const casacore::Array<float> &weights);
+
+        /// @brief write a slice of an image mask
+        /// @details The mask is created (with all pixels good) if necessary.
+        /// @param[in] name image name
+        /// @param[in] mask array with mask
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                               const casacore::IPosition &where);
+
+        /// @brief write an image mask
+        /// @param[in] name image name
+        /// @param[in] mask array with mask
+        virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask);
+
+        /// @brief set brightness units of the image
+        /// @param[in] name image name
+        /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+        virtual void setUnits(const std::string &name, const std::string &units);
+
+        /// @brief set restoring beam info
+        /// @param[in] name image name
+        /// @param[in] maj major axis in radians
+        /// @param[in] min minor axis in radians
+        /// @param[in] pa position angle in radians
+        virtual void setBeamInfo(const std::string &name, double maj, double min, double pa);
+
+        /// @brief set per-channel beam info
+        /// @param[in] name image name
+        /// @param[in] beams one beam per channel
+        virtual void setBeamList(const std::string &name, const BeamList &beams);
+
+        /// @brief apply mask to image
+        /// @details The mask with all pixels good is created if the image has no mask.
+        /// @param[in] name image name
+        virtual void makeDefaultMask(const std::string &name);
+
+        /// @brief Set a particular keyword for the metadata (A.K.A header)
+        /// @param[in] name Image name
+        /// @param[in] keyword The name of the metadata keyword
+        /// @param[in] value The value for the keyword, in string format
+        /// @param[in] desc A description of the keyword
+        virtual void setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                        const std::string value, const std::string &desc = "");
+
+        /// @brief Add a HISTORY message to the image metadata
+        /// @param[in] name Image name
+        /// @param[in] history History comment to add
+        virtual void addHistory(const std::string &name, const std::string &history);
+
+        //////////////////
+        // Handle management
+        //////////////////
+
+        /// @brief close the given image
+        /// @details If the persistence target is set, the image is written to disk and
+        /// removed from memory. Otherwise, this method does nothing.
+        /// @param[in] name image name
+        virtual void close(const std::string &name);
+
+        /// @brief write all images to disk
+        /// @details If the persistence target is set, all images are written to disk, but
+        /// kept in memory. Otherwise, this method does nothing.
+        virtual void flush();
+
+    private:
+
+        /// @brief obtain the image
+        /// @param[in] name image name
+        /// @return shared pointer to the image (an exception is thrown if it doesn't exist)
+        boost::shared_ptr<MemoryImage> image(const std::string &name) const;
+
+        /// @brief write the image with the persistence accessor
+        /// @param[in] name image name
+        /// @param[in] img image to write
+        void persist(const std::string &name, const MemoryImage &img);
+
+        /// @brief images by name
+        std::map<std::string, boost::shared_ptr<MemoryImage> > itsImages;
+
+        /// @brief accessor to write images to disk (may be empty)
+        boost::shared_ptr<IImageAccess> itsPersistence;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
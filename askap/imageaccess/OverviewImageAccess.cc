@@ -0,0 +1,470 @@
+/// @file OverviewImageAccess.cc
+/// @brief image accessor maintaining downsampled overviews of the written images
+/// @details This class wraps any IImageAccess implementation and keeps a number of
+/// mean-binned copies of each image it creates (e.g. binned by 2, 4 and 8 pixels in both
+/// directions of the sky plane). The overviews are updated as slices are written, so quick-look
+/// tools and validation can read a small image instead of the full cube.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/imageaccess/OverviewImageAccess.h>
+
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+ASKAP_LOGGER(logger, ".overviewImageAccessor");
+
+namespace askap {
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] acc accessor to do the actual reads and writes
+/// @param[in] factors binning factors of the overviews (each should be greater than 1)
+OverviewImageAccess::OverviewImageAccess(const boost::shared_ptr<IImageAccess> &acc,
+                                         const std::vector<casacore::uInt> &factors) :
+    itsAccessor(acc), itsFactors(factors)
+{
+    ASKAPCHECK(itsAccessor, "OverviewImageAccess requires an accessor to wrap");
+    for (std::vector<casacore::uInt>::const_iterator ci = itsFactors.begin(); ci != itsFactors.end(); ++ci) {
+         ASKAPCHECK(*ci > 1, "Binning factors of the overviews should be greater than 1, you have "<<*ci);
+         ASKAPCHECK(std::count(itsFactors.begin(), itsFactors.end(), *ci) == 1,
+                    "Binning factor "<<*ci<<" is given more than once");
+    }
+}
+
+/// @brief name of the overview image
+/// @details This is the name to be used by readers to access the given resolution level.
+/// @param[in] name name of the main image
+/// @param[in] factor binning factor of the overview
+/// @return name of the overview image
+std::string OverviewImageAccess::overviewName(const std::string &name, const casacore::uInt factor)
+{
+    std::ostringstream os;
+    os << name << ".overview" << factor;
+    return os.str();
+}
+
+/// @brief shape of the overview image
+/// @param[in] shape shape of the main image
+/// @param[in] factor binning factor of the overview
+/// @return shape of the overview image
+casacore::IPosition OverviewImageAccess::overviewShape(const casacore::IPosition &shape, const casacore::uInt factor)
+{
+    ASKAPCHECK(shape.nelements() >= 2, "Overviews require at least two image axes, the shape is "<<shape);
+    ASKAPDEBUGASSERT(factor > 0);
+    casacore::IPosition result(shape);
+    for (size_t dim = 0; dim < 2; ++dim) {
+         result(dim) = (shape(dim) + factor - 1) / factor;
+    }
+    return result;
+}
+
+//////////////////
+// Reading methods
+//////////////////
+
+/// @brief obtain the shape
+/// @param[in] name image name
+/// @return full shape of the given image
+casacore::IPosition OverviewImageAccess::shape(const std::string &name) const
+{
+    return itsAccessor->shape(name);
+}
+
+/// @brief read full image
+/// @param[in] name image name
+/// @return array with pixels
+casacore::Array<float> OverviewImageAccess::read(const std::string &name) const
+{
+    return itsAccessor->read(name);
+}
+
+/// @brief read part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return array with pixels for the selection only
+casacore::Array<float> OverviewImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    return itsAccessor->read(name, blc, trc);
+}
+
+/// @brief read part of the image into the given buffer
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill
+void OverviewImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+                               const casacore::IPosition &trc, casacore::Array<float> &buffer) const
+{
+    itsAccessor->read(name, blc, trc, buffer);
+}
+
+/// @brief obtain coordinate system info
+/// @param[in] name image name
+/// @return coordinate system object
+casacore::CoordinateSystem OverviewImageAccess::coordSys(const std::string &name) const
+{
+    return itsAccessor->coordSys(name);
+}
+
+/// @brief obtain coordinate system info for part of an image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return coordinate system object
+casacore::CoordinateSystem OverviewImageAccess::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    return itsAccessor->coordSysSlice(name, blc, trc);
+}
+
+/// @brief obtain beam info
+/// @param[in] name image name
+/// @return beam info vector
+casacore::Vector<casacore::Quantum<double> > OverviewImageAccess::beamInfo(const std::string &name) const
+{
+    return itsAccessor->beamInfo(name);
+}
+
+/// @brief obtain per-channel beam info
+/// @param[in] name image name
+/// @return one beam per channel, empty if the image has no per-channel beams
+IImageAccess::BeamList OverviewImageAccess::beamList(const std::string &name) const
+{
+    return itsAccessor->beamList(name);
+}
+
+/// @brief obtain pixel units
+/// @param[in] name image name
+/// @return units string
+std::string OverviewImageAccess::getUnits(const std::string &name) const
+{
+    return itsAccessor->getUnits(name);
+}
+
+/// @brief Get a particular keyword from the image metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+std::string OverviewImageAccess::getMetadataKeyword(const std::string &name, const std::string &keyword) const
+{
+    return itsAccessor->getMetadataKeyword(name, keyword);
+}
+
+//////////////////
+// Writing methods
+//////////////////
+
+/// @brief create a new image
+/// @details The overview images are created as well.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+void OverviewImageAccess::create(const std::string &name, const casacore::IPosition &shape,
+                                 const casacore::CoordinateSystem &csys)
+{
+    ASKAPCHECK(itsFactors.empty() || shape.nelements() >= 2, "Overviews require at least two image axes, image "<<
+               name<<" has the shape "<<shape);
+    itsAccessor->create(name, shape, csys);
+    for (std::vector<casacore::uInt>::const_iterator ci = itsFactors.begin(); ci != itsFactors.end(); ++ci) {
+         const casacore::IPosition ovShape = overviewShape(shape, *ci);
+         // overview pixel i covers pixels i*f to i*f+f-1 of the main image, its centre is the reference
+         casacore::Vector<casacore::Float> originShift(shape.nelements(), 0.f);
+         casacore::Vector<casacore::Float> incrFac(shape.nelements(), 1.f);
+         for (size_t dim = 0; dim < 2; ++dim) {
+              originShift[dim] = 0.5f * float(*ci - 1);
+              incrFac[dim] = float(*ci);
+         }
+         const std::string ovName = overviewName(name, *ci);
+         ASKAPLOG_DEBUG_STR(logger, "Creating overview " << ovName << " with the shape " << ovShape);
+         itsAccessor->create(ovName, ovShape, csys.subImage(originShift, incrFac, ovShape.asVector()));
+    }
+    itsShapes[name] = shape;
+}
+
+/// @brief write full image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+void OverviewImageAccess::write(const std::string &name, const casacore::Array<float> &arr)
+{
+    itsAccessor->write(name, arr);
+    updateOverviews(name, arr, casacore::IPosition(arr.ndim(), 0));
+}
+
+/// @brief write a slice of an image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void OverviewImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
+                                const casacore::IPosition &where)
+{
+    itsAccessor->write(name, arr, where);
+    updateOverviews(name, arr, where);
+}
+
+/// @brief write a slice of an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void OverviewImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                                    const casacore::IPosition &where)
+{
+    itsAccessor->writeMask(name, mask, where);
+}
+
+/// @brief write an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+void OverviewImageAccess::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+{
+    itsAccessor->writeMask(name, mask);
+}
+
+/// @brief write a slice of an image together with its pixel mask
+/// @details Masked pixels are excluded from the overviews.
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] mask mask of the same shape as arr (true for good pixels)
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void OverviewImageAccess::writeMasked(const std::string &name, const casacore::Array<float> &arr,
+                                      const casacore::Array<bool> &mask, const casacore::IPosition &where)
+{
+    itsAccessor->writeMasked(name, arr, mask, where);
+    if (itsShapes.find(name) == itsShapes.end()) {
+        return;
+    }
+    ASKAPCHECK(mask.shape() == arr.shape(), "Mask shape "<<mask.shape()<<" doesn't match the pixel array shape "<<
+               arr.shape());
+    casacore::Array<float> masked(arr.shape());
+    bool deleteIn, deleteMask, deleteOut;
+    const float *inData = arr.getStorage(deleteIn);
+    const bool *maskData = mask.getStorage(deleteMask);
+    float *outData = masked.getStorage(deleteOut);
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const size_t nElements = arr.nelements();
+    for (size_t i = 0; i < nElements; ++i) {
+         outData[i] = maskData[i] ? inData[i] : nan;
+    }
+    arr.freeStorage(inData, deleteIn);
+    mask.freeStorage(maskData, deleteMask);
+    masked.putStorage(outData, deleteOut);
+    updateOverviews(name, masked, where);
+}
+
+/// @brief set brightness units of the image
+/// @param[in] name image name
+/// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+void OverviewImageAccess::setUnits(const std::string &name, const std::string &units)
+{
+    itsAccessor->setUnits(name, units);
+    if (itsShapes.find(name) != itsShapes.end()) {
+        for (std::vector<casacore::uInt>::const_iterator ci = itsFactors.begin(); ci != itsFactors.end(); ++ci) {
+             itsAccessor->setUnits(overviewName(name, *ci), units);
+        }
+    }
+}
+
+/// @brief set restoring beam info
+/// @param[in] name image name
+/// @param[in] maj major axis in radians
+/// @param[in] min minor axis in radians
+/// @param[in] pa position angle in radians
+void OverviewImageAccess::setBeamInfo(const std::string &name, double maj, double min, double pa)
+{
+    itsAccessor->setBeamInfo(name, maj, min, pa);
+    if (itsShapes.find(name) != itsShapes.end()) {
+        for (std::vector<casacore::uInt>::const_iterator ci = itsFactors.begin(); ci != itsFactors.end(); ++ci) {
+             itsAccessor->setBeamInfo(overviewName(name, *ci), maj, min, pa);
+        }
+    }
+}
+
+/// @brief set per-channel beam info
+/// @param[in] name image name
+/// @param[in] beams one beam per channel
+void OverviewImageAccess::setBeamList(const std::string &name, const BeamList &beams)
+{
+    itsAccessor->setBeamList(name, beams);
+    if (itsShapes.find(name) != itsShapes.end()) {
+        for (std::vector<casacore::uInt>::const_iterator ci = itsFactors.begin(); ci != itsFactors.end(); ++ci) {
+             itsAccessor->setBeamList(overviewName(name, *ci), beams);
+        }
+    }
+}
+
+/// @brief apply mask to image
+/// @param[in] name image name
+void OverviewImageAccess::makeDefaultMask(const std::string &name)
+{
+    itsAccessor->makeDefaultMask(name);
+}
+
+/// @brief Set a particular keyword for the metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @param[in] value The value for the keyword, in string format
+/// @param[in] desc A description of the keyword
+void OverviewImageAccess::setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                             const std::string value, const std::string &desc)
+{
+    itsAccessor->setMetadataKeyword(name, keyword, value, desc);
+    if (itsShapes.find(name) != itsShapes.end()) {
+        for (std::vector<casacore::uInt>::const_iterator ci = itsFactors.begin(); ci != itsFactors.end(); ++ci) {
+             itsAccessor->setMetadataKeyword(overviewName(name, *ci), keyword, value, desc);
+        }
+    }
+}
+
+/// @brief Add a HISTORY message to the image metadata
+/// @param[in] name Image name
+/// @param[in] history History comment to add
+void OverviewImageAccess::addHistory(const std::string &name, const std::string &history)
+{
+    itsAccessor->addHistory(name, history);
+}
+
+//////////////////
+// Handle management
+//////////////////
+
+/// @brief close the given image
+/// @details The overviews of the image are closed as well.
+/// @param[in] name image name
+void OverviewImageAccess::close(const std::string &name)
+{
+    itsAccessor->close(name);
+    if (itsShapes.find(name) != itsShapes.end()) {
+        for (std::vector<casacore::uInt>::const_iterator ci = itsFactors.begin(); ci != itsFactors.end(); ++ci) {
+             itsAccessor->close(overviewName(name, *ci));
+        }
+    }
+}
+
+/// @brief write all changes to disk
+void OverviewImageAccess::flush()
+{
+    itsAccessor->flush();
+}
+
+/// @brief update the overviews after a slice has been written
+/// @details Nothing is done if the image has not been created via this object.
+/// @param[in] name image name
+/// @param[in] arr pixels written to the image (masked pixels set to NaN)
+/// @param[in] where bottom left corner of the slice
+void OverviewImageAccess::updateOverviews(const std::string &name, const casacore::Array<float> &arr,
+                                          const casacore::IPosition &where)
+{
+    const std::map<std::string, casacore::IPosition>::const_iterator shapeIt = itsShapes.find(name);
+    if (shapeIt == itsShapes.end() || arr.nelements() == 0) {
+        return;
+    }
+    const casacore::IPosition &imageShape = shapeIt->second;
+    ASKAPCHECK(where.nelements() == imageShape.nelements() && arr.ndim() == imageShape.nelements(),
+               "Slice of the shape "<<arr.shape()<<" at "<<where<<" doesn't match the image shape "<<imageShape);
+    const casacore::IPosition trc = where + arr.shape() - 1;
+    for (std::vector<casacore::uInt>::const_iterator ci = itsFactors.begin(); ci != itsFactors.end(); ++ci) {
+         const ssize_t factor = *ci;
+         // extend the slice to whole bins (or to the image edge)
+         casacore::IPosition binBlc(where);
+         casacore::IPosition binTrc(trc);
+         for (size_t dim = 0; dim < 2; ++dim) {
+              binBlc(dim) = where(dim) / factor * factor;
+              binTrc(dim) = std::min((trc(dim) / factor + 1) * factor - 1, imageShape(dim) - 1);
+         }
+         casacore::Array<float> binned;
+         if (binBlc == where && binTrc == trc) {
+             binned.reference(bin(arr, *ci));
+         } else {
+             // neighbouring pixels are read back, the pixels just written are taken from the
+             // array to keep pixels excluded by the mask out of the mean
+             casacore::Array<float> region = itsAccessor->read(name, binBlc, binTrc);
+             region(where - binBlc, trc - binBlc) = arr;
+             binned.reference(bin(region, *ci));
+         }
+         casacore::IPosition ovWhere(where);
+         ovWhere(0) = binBlc(0) / factor;
+         ovWhere(1) = binBlc(1) / factor;
+         itsAccessor->write(overviewName(name, *ci), binned, ovWhere);
+    }
+}
+
+/// @brief mean-bin the first two axes of an array
+/// @details The first two axes are binned by the given factor (partial bins at the
+/// end are kept), only finite values contribute to the mean. Bins without finite
+/// values are set to NaN.
+/// @param[in] in array to bin
+/// @param[in] factor binning factor
+/// @return binned array
+casacore::Array<float> OverviewImageAccess::bin(const casacore::Array<float> &in, const casacore::uInt factor)
+{
+    const casacore::IPosition outShape = overviewShape(in.shape(), factor);
+    casacore::Array<float> result(outShape);
+    if (in.nelements() == 0) {
+        return result;
+    }
+    const size_t nx = in.shape()(0);
+    const size_t ny = in.shape()(1);
+    const size_t nPlanes = in.nelements() / (nx * ny);
+    const size_t nBinsX = outShape(0);
+    const size_t nBinsY = outShape(1);
+    std::vector<double> sums(result.nelements(), 0.);
+    std::vector<casacore::uInt> counts(result.nelements(), 0u);
+    bool deleteIn;
+    const float *inData = in.getStorage(deleteIn);
+    for (size_t plane = 0; plane < nPlanes; ++plane) {
+         for (size_t y = 0; y < ny; ++y) {
+              const float *row = inData + nx * (y + ny * plane);
+              const size_t offset = nBinsX * (y / factor + nBinsY * plane);
+              double *rowSums = &sums[offset];
+              casacore::uInt *rowCounts = &counts[offset];
+              for (size_t x = 0; x < nx; ++x) {
+                   const bool good = std::isfinite(row[x]);
+                   rowSums[x / factor] += good ? row[x] : 0.;
+                   rowCounts[x / factor] += good ? 1u : 0u;
+              }
+         }
+    }
+    in.freeStorage(inData, deleteIn);
+    bool deleteOut;
+    float *outData = result.getStorage(deleteOut);
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (size_t i = 0; i < result.nelements(); ++i) {
+         outData[i] = counts[i] > 0 ? float(sums[i] / counts[i]) : nan;
+    }
+    result.putStorage(outData, deleteOut);
+    return result;
+}
+
+} // namespace accessors
+} // namespace askap
@@ -0,0 +1,278 @@
+/// @file OverviewImageAccess.h
+/// @brief image accessor maintaining downsampled overviews of the written images
+/// @details This class wraps any IImageAccess implementation and keeps a number of
+/// mean-binned copies of each image it creates (e.g. binned by 2, 4 and 8 pixels in both
+/// directions of the sky plane). The overviews are updated as slices are written, so quick-look
+/// tools and validation can read a small image instead of the full cube.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_OVERVIEW_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_OVERVIEW_IMAGE_ACCESS_H
+
+#include <askap/imageaccess/IImageAccess.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief image accessor maintaining downsampled overviews of the written images
+/// @details For every image created via this object, an overview image is created for each of
+/// the binning factors given in the constructor. The overview for factor f is a separate image
+/// named by overviewName (i.e. the image name with ".overview<f>" appended), so it is stored in the
+/// same format as the main image and can be read by any accessor of that type. Its first two axes
+/// are binned by f (partial bins at the image edge are kept), other axes are left as they are.
+/// Every overview pixel is the mean of the finite pixels in its bin (NaN if there are none).
+/// Overviews are updated by each write of pixels: if the slice being written covers whole bins,
+/// they are computed from the written array, otherwise the enclosing bins are read back from the
+/// wrapped accessor after the write. Therefore, writing whole planes or tiles aligned to the
+/// largest factor doesn't cost any extra reads. Pixels masked by writeMasked are excluded from
+/// the mean, masks written separately (or pixels masked before being read back) are not taken
+/// into account. Units, beams and keywords are copied to the overviews, history is only added
+/// to the main image. Images not created via this object are passed through without overviews.
+/// The wrapped accessor should not be used directly to write the images while this object exists.
+/// @ingroup imageaccess
+class OverviewImageAccess : public IImageAccess, private boost::noncopyable {
+
+    public:
+
+        /// @brief constructor
+        /// @param[in] acc accessor to do the actual reads and writes
+        /// @param[in] factors binning factors of the overviews (each should be greater than 1)
+        OverviewImageAccess(const boost::shared_ptr<IImageAccess> &acc, const std::vector<casacore::uInt> &factors);
+
+        /// @brief name of the overview image
+        /// @details This is the name to be used by readers to access the given resolution level.
+        /// @param[in] name name of the main image
+        /// @param[in] factor binning factor of the overview
+        /// @return name of the overview image
+        static std::string overviewName(const std::string &name, const casacore::uInt factor);
+
+        /// @brief shape of the overview image
+        /// @param[in] shape shape of the main image
+        /// @param[in] factor binning factor of the overview
+        /// @return shape of the overview image
+        static casacore::IPosition overviewShape(const casacore::IPosition &shape, const casacore::uInt factor);
+
+        /// @brief binning factors of the overviews
+        /// @return factors given in the constructor
+        const std::vector<casacore::uInt>& factors() const { return itsFactors; }
+
+        //////////////////
+        // Reading methods
+        //////////////////
+
+        /// @brief obtain the shape
+        /// @param[in] name image name
+        /// @return full shape of the given image
+        virtual casacore::IPosition shape(const std::string &name) const;
+
+        /// @brief read full image
+        /// @param[in] name image name
+        /// @return array with pixels
+        virtual casacore::Array<float> read(const std::string &name) const;
+
+        /// @brief read part of the image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @return array with pixels for the selection only
+        virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
+                                        const casacore::IPosition &trc) const;
+
+        /// @brief read part of the image into the given buffer
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[out] buffer array to fill
+        virtual void read(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<float> &buffer) const;
+
+        /// @brief obtain coordinate system info
+        /// @param[in] name image name
+        /// @return coordinate system object
+        virtual casacore::CoordinateSystem coordSys(const std::string &name) const;
+
+        /// @brief obtain coordinate system info for part of an image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @return coordinate system object
+        virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+                const casacore::IPosition &trc) const;
+
+        /// @brief obtain beam info
+        /// @param[in] name image name
+        /// @return beam info vector
+        virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const;
+
+        /// @brief obtain per-channel beam info
+        /// @param[in] name image name
+        /// @return one beam per channel, empty if the image has no per-channel beams
+        virtual BeamList beamList(const std::string &name) const;
+
+        /// @brief obtain pixel units
+        /// @param[in] name image name
+        /// @return units string
+        virtual std::string getUnits(const std::string &name) const;
+
+        /// @brief Get a particular keyword from the image metadata (A.K.A header)
+        /// @param[in] name Image name
+        /// @param[in] keyword The name of the metadata keyword
+        virtual std::string getMetadataKeyword(const std::string &name, const std::string &keyword) const;
+
+        //////////////////
+        // Writing methods
+        //////////////////
+
+        /// @brief create a new image
+        /// @details The overview images are created as well.
+        /// @param[in] name image name
+        /// @param[in] shape full shape of the image
+        /// @param[in] csys coordinate system of the full image
+        virtual void create(const std::string &name, const casacore::IPosition &shape,
+                            const casacore::CoordinateSystem &csys);
+
+        /// @brief write full image
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        virtual void write(const std::string &name, const casacore::Array<float> &arr);
+
+        /// @brief write a slice of an image
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void write(const std::string &name, const casacore::Array<float> &arr,
+                           const casacore::IPosition &where);
+
+        /// @brief write a slice of an image mask
+        /// @param[in] name image name
+        /// @param[in] mask array with mask
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                               const casacore::IPosition &where);
+
+        /// @brief write an image mask
+        /// @param[in] name image name
+        /// @param[in] mask array with mask
+        virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask);
+
+        /// @brief write a slice of an image together with its pixel mask
+        /// @details Masked pixels are excluded from the overviews.
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        /// @param[in] mask mask of the same shape as arr (true for good pixels)
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        virtual void writeMasked(const std::string &name, const casacore::Array<float> &arr,
+                                 const casacore::Array<bool> &mask, const casacore::IPosition &where);
+
+        /// @brief set brightness units of the image
+        /// @param[in] name image name
+        /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+        virtual void setUnits(const std::string &name, const std::string &units);
+
+        /// @brief set restoring beam info
+        /// @param[in] name image name
+        /// @param[in] maj major axis in radians
+        /// @param[in] min minor axis in radians
+        /// @param[in] pa position angle in radians
+        virtual void setBeamInfo(const std::string &name, double maj, double min, double pa);
+
+        /// @brief set per-channel beam info
+        /// @param[in] name image name
+        /// @param[in] beams one beam per channel
+        virtual void setBeamList(const std::string &name, const BeamList &beams);
+
+        /// @brief apply mask to image
+        /// @param[in] name image name
+        virtual void makeDefaultMask(const std::string &name);
+
+        /// @brief Set a particular keyword for the metadata (A.K.A header)
+        /// @param[in] name Image name
+        /// @param[in] keyword The name of the metadata keyword
+        /// @param[in] value The value for the keyword, in string format
+        /// @param[in] desc A description of the keyword
+        virtual void setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                        const std::string value, const std::string &desc = "");
+
+        /// @brief Add a HISTORY message to the image metadata
+        /// @param[in] name Image name
+        /// @param[in] history History comment to add
+        virtual void addHistory(const std::string &name, const std::string &history);
+
+        //////////////////
+        // Handle management
+        //////////////////
+
+        /// @brief close the given image
+        /// @details The overviews of the image are closed as well.
+        /// @param[in] name image name
+        virtual void close(const std::string &name);
+
+        /// @brief write all changes to disk
+        virtual void flush();
+
+    protected:
+
+        /// @brief update the overviews after a slice has been written
+        /// @details Nothing is done if the image has not been created via this object.
+        /// @param[in] name image name
+        /// @param[in] arr pixels written to the image (masked pixels set to NaN)
+        /// @param[in] where bottom left corner of the slice
+        void updateOverviews(const std::string &name, const casacore::Array<float> &arr,
+                             const casacore::IPosition &where);
+
+        /// @brief mean-bin the first two axes of an array
+        /// @details The first two axes are binned by the given factor (partial bins at the
+        /// end are kept), only finite values contribute to the mean. Bins without finite
+        /// values are set to NaN.
+        /// @param[in] in array to bin
+        /// @param[in] factor binning factor
+        /// @return binned array
+        static casacore::Array<float> bin(const casacore::Array<float> &in, const casacore::uInt factor);
+
+    private:
+
+        /// @brief accessor doing the actual work
+        boost::shared_ptr<IImageAccess> itsAccessor;
+
+        /// @brief binning factors of the overviews
+        std::vector<casacore::uInt> itsFactors;
+
+        /// @brief shapes of the images created via this object, by image name
+        std::map<std::string, casacore::IPosition> itsShapes;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
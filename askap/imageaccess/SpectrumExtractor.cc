@@ -0,0 +1,236 @@
+/// @file
+/// @brief extraction of spectra at many positions of an image cube
+/// @details This class extracts spectra at a number of pixel positions, reading each
+/// storage chunk (e.g. a tile of a CASA image or a plane of a FITS image) once for all
+/// positions it contains via the generic IImageAccess interface, rather than doing a
+/// separate strided read for every spectrum. Chunks are processed by a number of threads.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+// own includes
+#include <askap/imageaccess/SpectrumExtractor.h>
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap_accessors.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+ASKAP_LOGGER(logger, ".spectrumExtractor");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief constructor
+/// @param[in] acc image accessor to read with
+/// @param[in] name image name
+/// @param[in] axis spectral axis
+/// @param[in] chunk shape of the storage chunks (same dimensions as the image)
+SpectrumExtractor::SpectrumExtractor(const IImageAccess &acc, const std::string &name, casacore::uInt axis,
+                                     const casacore::IPosition &chunk) :
+     itsAccessor(acc), itsName(name), itsShape(acc.shape(name)), itsAxis(axis), itsChunk(chunk),
+     itsNextRead(0), itsNReads(0)
+{
+   ASKAPCHECK(axis < itsShape.nelements(), "Spectral axis "<<axis<<" doesn't exist in image "<<name<<
+              " of shape "<<itsShape);
+   ASKAPCHECK(chunk.nelements() == itsShape.nelements(), "Chunk shape "<<chunk<<" doesn't match the shape "<<
+              itsShape<<" of image "<<name);
+   for (size_t dim = 0; dim < itsChunk.nelements(); ++dim) {
+        itsChunk[dim] = std::max(ssize_t(1), std::min(itsChunk[dim], itsShape[dim]));
+   }
+}
+
+/// @brief extract spectra
+/// @details Any error encountered by a thread is reported here after all threads have finished.
+/// @param[in] positions pixel positions (the element for the spectral axis is ignored)
+/// @param[in] firstChannel first channel to extract
+/// @param[in] nChan number of channels to extract
+/// @param[out] spectra extracted spectra, resized to positions.size() x nChan
+/// @param[in] nThreads number of threads to use (1 means that chunks are processed by the calling thread)
+void SpectrumExtractor::extract(const std::vector<casacore::IPosition> &positions, casacore::uInt firstChannel,
+                                casacore::uInt nChan, casacore::Matrix<float> &spectra, casacore::uInt nThreads)
+{
+   ASKAPCHECK(nThreads > 0, "At least one thread is required to extract spectra from "<<itsName);
+   ASKAPCHECK(ssize_t(firstChannel) + ssize_t(nChan) <= itsShape[itsAxis], "Channels "<<firstChannel<<
+              " to "<<firstChannel + nChan<<" (exclusive) are outside image "<<itsName<<" of shape "<<itsShape);
+   spectra.resize(positions.size(), nChan);
+   plan(positions, firstChannel, nChan);
+   itsNextRead = 0;
+   itsNReads = 0;
+   itsError.clear();
+   nThreads = std::max(casacore::uInt(1), std::min(nThreads, casacore::uInt(itsReads.size())));
+   ASKAPLOG_DEBUG_STR(logger, "Extracting "<<positions.size()<<" spectra of "<<nChan<<" channels from "<<
+                      itsName<<" in "<<itsGroups.size()<<" group(s) and "<<itsReads.size()<<" read(s) with "<<
+                      nThreads<<" thread(s)");
+   if (nThreads <= 1) {
+       run(positions, firstChannel, spectra);
+   } else {
+       boost::thread_group threads;
+       for (casacore::uInt thread = 0; thread < nThreads; ++thread) {
+            threads.create_thread(boost::bind(&SpectrumExtractor::run, this, boost::cref(positions),
+                                  firstChannel, boost::ref(spectra)));
+       }
+       threads.join_all();
+   }
+   if (itsError.size()) {
+       const std::string msg = itsError;
+       itsError.clear();
+       ASKAPTHROW(AskapError, "Extraction of spectra from "<<itsName<<" failed: "<<msg);
+   }
+}
+
+/// @brief group positions and form the list of reads
+/// @param[in] positions pixel positions
+/// @param[in] firstChannel first channel to extract
+/// @param[in] nChan number of channels to extract
+void SpectrumExtractor::plan(const std::vector<casacore::IPosition> &positions, casacore::uInt firstChannel,
+                             casacore::uInt nChan)
+{
+   itsGroups.clear();
+   itsReads.clear();
+   // index of the group for each chunk along the non-spectral axes
+   std::map<std::vector<ssize_t>, size_t> groupIndices;
+   std::vector<ssize_t> key(itsShape.nelements(), 0);
+   for (size_t index = 0; index < positions.size(); ++index) {
+        const casacore::IPosition &pos = positions[index];
+        ASKAPCHECK(pos.nelements() == itsShape.nelements(), "Position "<<pos<<" doesn't match the shape "<<
+                   itsShape<<" of image "<<itsName);
+        for (size_t dim = 0; dim < key.size(); ++dim) {
+             if (dim != itsAxis) {
+                 ASKAPCHECK((pos[dim] >= 0) && (pos[dim] < itsShape[dim]), "Position "<<pos<<
+                            " is outside image "<<itsName<<" of shape "<<itsShape);
+                 key[dim] = pos[dim] / itsChunk[dim];
+             }
+        }
+        const std::map<std::vector<ssize_t>, size_t>::const_iterator ci =
+               groupIndices.insert(std::make_pair(key, itsGroups.size())).first;
+        if (ci->second == itsGroups.size()) {
+            itsGroups.push_back(Group());
+            itsGroups.back().itsBlc = pos;
+            itsGroups.back().itsTrc = pos;
+        }
+        Group &group = itsGroups[ci->second];
+        for (size_t dim = 0; dim < key.size(); ++dim) {
+             group.itsBlc[dim] = std::min(group.itsBlc[dim], pos[dim]);
+             group.itsTrc[dim] = std::max(group.itsTrc[dim], pos[dim]);
+        }
+        group.itsMembers.push_back(index);
+   }
+   // channel blocks don't cross chunk boundaries, all groups are read for a block before moving to the next
+   const casacore::uInt chunkLength = casacore::uInt(itsChunk[itsAxis]);
+   const casacore::uInt endChannel = firstChannel + nChan;
+   for (casacore::uInt chan = firstChannel; chan < endChannel; ) {
+        const casacore::uInt next = std::min(endChannel, (chan / chunkLength + 1) * chunkLength);
+        for (size_t group = 0; group < itsGroups.size(); ++group) {
+             Read read;
+             read.itsGroup = group;
+             read.itsFirst = chan;
+             read.itsLast = next - 1;
+             itsReads.push_back(read);
+        }
+        chan = next;
+   }
+}
+
+/// @brief body of a worker thread
+/// @details Reads are taken in turn until all of them are done. Exceptions can't
+/// propagate across threads, therefore the first error message is stored and reported by extract.
+/// @param[in] positions pixel positions
+/// @param[in] firstChannel first channel to extract
+/// @param[in] spectra matrix to store the values
+void SpectrumExtractor::run(const std::vector<casacore::IPosition> &positions, casacore::uInt firstChannel,
+                            casacore::Matrix<float> &spectra)
+{
+   // the buffer is reused between reads of the same shape
+   casacore::Array<float> buffer;
+   std::vector<ssize_t> steps(itsShape.nelements(), 1);
+   while (true) {
+      size_t readIndex = 0;
+      try {
+         casacore::IPosition blc;
+         {
+            boost::mutex::scoped_lock lock(itsMutex);
+            if ((itsNextRead >= itsReads.size()) || itsError.size()) {
+                return;
+            }
+            readIndex = itsNextRead++;
+            const Read &read = itsReads[readIndex];
+            const Group &group = itsGroups[read.itsGroup];
+            blc = group.itsBlc;
+            casacore::IPosition trc(group.itsTrc);
+            blc[itsAxis] = read.itsFirst;
+            trc[itsAxis] = read.itsLast;
+            // accessors can't be used from a number of threads at the same time
+            itsAccessor.read(itsName, blc, trc, buffer);
+            ++itsNReads;
+         }
+         const Read &read = itsReads[readIndex];
+         const Group &group = itsGroups[read.itsGroup];
+         ASKAPDEBUGASSERT(buffer.contiguousStorage());
+         const casacore::IPosition &bufferShape = buffer.shape();
+         for (size_t dim = 1; dim < steps.size(); ++dim) {
+              steps[dim] = steps[dim - 1] * bufferShape[dim - 1];
+         }
+         const float *data = buffer.data();
+         const casacore::uInt blockLength = read.itsLast - read.itsFirst + 1;
+         const casacore::uInt column = read.itsFirst - firstChannel;
+         for (std::vector<size_t>::const_iterator ci = group.itsMembers.begin(); ci != group.itsMembers.end(); ++ci) {
+              const casacore::IPosition &pos = positions[*ci];
+              ssize_t offset = 0;
+              for (size_t dim = 0; dim < steps.size(); ++dim) {
+                   if (dim != itsAxis) {
+                       offset += (pos[dim] - blc[dim]) * steps[dim];
+                   }
+              }
+              for (casacore::uInt chan = 0; chan < blockLength; ++chan) {
+                   spectra(*ci, column + chan) = data[offset + chan * steps[itsAxis]];
+              }
+         }
+      }
+      catch (const std::exception &ex) {
+         boost::mutex::scoped_lock lock(itsMutex);
+         if (itsError.empty()) {
+             std::ostringstream os;
+             os<<"read "<<readIndex<<": "<<ex.what();
+             itsError = os.str();
+         }
+         return;
+      }
+   }
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,172 @@
+/// @file
+/// @brief extraction of spectra at many positions of an image cube
+/// @details This class extracts spectra at a number of pixel positions, reading each
+/// storage chunk (e.g. a tile of a CASA image or a plane of a FITS image) once for all
+/// positions it contains via the generic IImageAccess interface, rather than doing a
+/// separate strided read for every spectrum. Chunks are processed by a number of threads.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_SPECTRUM_EXTRACTOR_H
+#define ASKAP_ACCESSORS_SPECTRUM_EXTRACTOR_H
+
+// std includes
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Matrix.h>
+
+namespace askap {
+
+namespace accessors {
+
+// forward declaration
+struct IImageAccess;
+
+/// @brief extraction of spectra at many positions of an image cube
+/// @details Positions are grouped by the storage chunk they fall into along all axes other than
+/// the spectral one. For each group the bounding box of its positions is read for a block of
+/// channels which doesn't cross the chunk boundary along the spectral axis, and the values are
+/// scattered into a dense (position x channel) matrix. With the chunk shape equal to the tile shape
+/// each tile is read once, with a single plane (the default for images without tiles) each
+/// plane is read once for all positions. Reads are serialised (accessors are not thread-safe),
+/// so I/O for one chunk overlaps with the scatter of the others. The typical usage is
+/// @code
+///    SpectrumExtractor extractor(imgAccess, name, 3, imgAccess.tileShape(name));
+///    casacore::Matrix<float> spectra;
+///    extractor.extract(positions, 0, nChan, spectra, 4);
+/// @endcode
+/// @note The accessor is referenced, rather than copied. It should outlive this object and
+/// should not be used by other code while extract is running.
+/// @ingroup imageaccess
+class SpectrumExtractor : private boost::noncopyable {
+public:
+
+   /// @brief constructor
+   /// @param[in] acc image accessor to read with
+   /// @param[in] name image name
+   /// @param[in] axis spectral axis
+   /// @param[in] chunk shape of the storage chunks (same dimensions as the image)
+   SpectrumExtractor(const IImageAccess &acc, const std::string &name, casacore::uInt axis,
+                     const casacore::IPosition &chunk);
+
+   /// @brief extract spectra
+   /// @details Any error encountered by a thread is reported here after all threads have finished.
+   /// @param[in] positions pixel positions (the element for the spectral axis is ignored)
+   /// @param[in] firstChannel first channel to extract
+   /// @param[in] nChan number of channels to extract
+   /// @param[out] spectra extracted spectra, resized to positions.size() x nChan
+   /// @param[in] nThreads number of threads to use (1 means that chunks are processed by the calling thread)
+   void extract(const std::vector<casacore::IPosition> &positions, casacore::uInt firstChannel,
+                casacore::uInt nChan, casacore::Matrix<float> &spectra, casacore::uInt nThreads = 1);
+
+   /// @brief number of reads done by the last extract call
+   /// @return number of slices read from the image
+   inline size_t nReads() const { return itsNReads; }
+
+protected:
+
+   /// @brief body of a worker thread
+   /// @details Reads are taken in turn until all of them are done. Exceptions can't
+   /// propagate across threads, therefore the first error message is stored and reported by extract.
+   /// @param[in] positions pixel positions
+   /// @param[in] firstChannel first channel to extract
+   /// @param[in] spectra matrix to store the values
+   void run(const std::vector<casacore::IPosition> &positions, casacore::uInt firstChannel,
+            casacore::Matrix<float> &spectra);
+
+private:
+   /// @brief positions falling into the same chunk
+   struct Group {
+      /// @brief bottom left corner of the bounding box (the spectral axis is set for each read)
+      casacore::IPosition itsBlc;
+      /// @brief top right corner of the bounding box
+      casacore::IPosition itsTrc;
+      /// @brief indices of the positions
+      std::vector<size_t> itsMembers;
+   };
+
+   /// @brief single read of a block of channels for a group of positions
+   struct Read {
+      /// @brief index of the group
+      size_t itsGroup;
+      /// @brief first channel of the block
+      casacore::uInt itsFirst;
+      /// @brief last channel of the block (inclusive)
+      casacore::uInt itsLast;
+   };
+
+   /// @brief group positions and form the list of reads
+   /// @param[in] positions pixel positions
+   /// @param[in] firstChannel first channel to extract
+   /// @param[in] nChan number of channels to extract
+   void plan(const std::vector<casacore::IPosition> &positions, casacore::uInt firstChannel, casacore::uInt nChan);
+
+   /// @brief accessor to read with
+   const IImageAccess &itsAccessor;
+
+   /// @brief image name
+   const std::string itsName;
+
+   /// @brief full shape of the image
+   const casacore::IPosition itsShape;
+
+   /// @brief spectral axis
+   const casacore::uInt itsAxis;
+
+   /// @brief shape of the storage chunks
+   casacore::IPosition itsChunk;
+
+   /// @brief groups of positions
+   std::vector<Group> itsGroups;
+
+   /// @brief reads to do
+   std::vector<Read> itsReads;
+
+   /// @brief next read to do
+   size_t itsNextRead;
+
+   /// @brief number of reads done
+   size_t itsNReads;
+
+   /// @brief error message of a worker thread (empty if successful)
+   std::string itsError;
+
+   /// @brief mutex protecting the read counter, the error message and the accessor
+   boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SPECTRUM_EXTRACTOR_H
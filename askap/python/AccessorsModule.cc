@@ -0,0 +1,359 @@
+/// @file
+/// @brief Python module with zero-copy access to the accessors
+/// @details The _accessors module gives Python code direct access to the arrays held by
+/// the data accessors, calibration solution accessors and image accessors. The arrays are
+/// returned as ArrayView objects exposing the casacore storage via the buffer protocol,
+/// so NumPy arrays can be made from them without copying:
+/// @code
+///    import numpy, _accessors
+///    for chunk in _accessors.DataIterator("data.ms"):
+///        vis = numpy.asarray(chunk["visibility"])   # nRow x nChannel x nPol
+/// @endcode
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+///
+
+// Python.h should be included before any standard header
+#include <askap/python/ArrayView.h>
+
+// std includes
+#include <exception>
+#include <string>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapError.h>
+#include <Common/ParameterSet.h>
+
+// own includes
+#include <askap/calibaccess/CalibAccessFactory.h>
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/ImageAccessFactory.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief Python object of the DataIterator type
+struct DataIteratorObject {
+  PyObject_HEAD
+  /// @brief data source, the iterator refers to it
+  boost::shared_ptr<IConstDataSource> *itsSource;
+  /// @brief iterator over the data source
+  boost::shared_ptr<IConstDataIterator> *itsIterator;
+  /// @brief true after the first chunk has been returned
+  bool itsStarted;
+};
+
+/// @brief convert the current C++ exception into a Python error
+/// @details This method should be called from a catch block.
+void setPythonError()
+{
+  try {
+     throw;
+  }
+  catch (const AskapError &ae) {
+     PyErr_SetString(PyExc_RuntimeError, ae.what());
+  }
+  catch (const std::exception &ex) {
+     PyErr_SetString(PyExc_RuntimeError, ex.what());
+  }
+  catch (...) {
+     PyErr_SetString(PyExc_RuntimeError, "Unknown C++ exception");
+  }
+}
+
+/// @brief add an item to a dictionary, taking over the reference to the value
+/// @param[in] dict dictionary
+/// @param[in] key key
+/// @param[in] value value (may be NULL with the Python error set)
+/// @return true if successful
+bool setItem(PyObject *dict, const char *key, PyObject *value)
+{
+  if (value == NULL) {
+      return false;
+  }
+  const int status = PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+  return status == 0;
+}
+
+/// @brief build a parset from a dictionary
+/// @details Values which are not strings are converted with str().
+/// @param[in] dict dictionary of parameters
+/// @param[out] parset parset to fill
+/// @return true if successful, false with the Python error set otherwise
+bool toParset(PyObject *dict, LOFAR::ParameterSet &parset)
+{
+  PyObject *key = NULL;
+  PyObject *value = NULL;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(dict, &pos, &key, &value)) {
+         PyObject *keyStr = PyObject_Str(key);
+         PyObject *valueStr = PyObject_Str(value);
+         const char *keyText = keyStr != NULL ? PyUnicode_AsUTF8(keyStr) : NULL;
+         const char *valueText = valueStr != NULL ? PyUnicode_AsUTF8(valueStr) : NULL;
+         if ((keyText != NULL) && (valueText != NULL)) {
+             parset.add(keyText, valueText);
+         }
+         Py_XDECREF(keyStr);
+         Py_XDECREF(valueStr);
+         if ((keyText == NULL) || (valueText == NULL)) {
+             return false;
+         }
+  }
+  return true;
+}
+
+/// @brief create views of the fields of a data accessor
+/// @details The views reference the buffers of the accessor. They are valid for the
+/// current chunk, the accessor may reuse its buffers when the iterator moves on.
+/// @param[in] acc data accessor
+/// @return new reference to the dictionary or NULL with the Python error set
+PyObject* accessorFields(const IConstDataAccessor &acc)
+{
+  PyObject *dict = PyDict_New();
+  if (dict == NULL) {
+      return NULL;
+  }
+  if (setItem(dict, "time", PyFloat_FromDouble(acc.time())) &&
+      setItem(dict, "frequency", makeArrayView(acc.frequency())) &&
+      setItem(dict, "antenna1", makeArrayView(acc.antenna1())) &&
+      setItem(dict, "antenna2", makeArrayView(acc.antenna2())) &&
+      setItem(dict, "feed1", makeArrayView(acc.feed1())) &&
+      setItem(dict, "feed2", makeArrayView(acc.feed2())) &&
+      setItem(dict, "uvw", makeArrayView(acc.uvw())) &&
+      setItem(dict, "visibility", makeArrayView(acc.visibility())) &&
+      setItem(dict, "flag", makeArrayView(acc.flag()))) {
+      return dict;
+  }
+  Py_DECREF(dict);
+  return NULL;
+}
+
+/// @brief create a DataIterator object
+/// @param[in] type the DataIterator type
+/// @param[in] args positional arguments: measurement set, data column (optional)
+/// @param[in] kwds keyword arguments
+/// @return new reference to the iterator or NULL with the Python error set
+PyObject* dataIteratorNew(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  static const char *keywords[] = {"ms", "datacolumn", NULL};
+  const char *ms = NULL;
+  const char *dataColumn = "DATA";
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|s", const_cast<char**>(keywords), &ms, &dataColumn)) {
+      return NULL;
+  }
+  DataIteratorObject *self = reinterpret_cast<DataIteratorObject*>(type->tp_alloc(type, 0));
+  if (self == NULL) {
+      return NULL;
+  }
+  try {
+     self->itsSource = new boost::shared_ptr<IConstDataSource>(new TableConstDataSource(ms, dataColumn));
+     self->itsIterator = new boost::shared_ptr<IConstDataIterator>((*self->itsSource)->createConstIterator());
+     self->itsStarted = false;
+  }
+  catch (...) {
+     setPythonError();
+     Py_DECREF(self);
+     return NULL;
+  }
+  return reinterpret_cast<PyObject*>(self);
+}
+
+/// @brief release the iterator and the data source
+/// @param[in] obj DataIterator object
+void dataIteratorDealloc(PyObject *obj)
+{
+  DataIteratorObject *self = reinterpret_cast<DataIteratorObject*>(obj);
+  // the iterator refers to the data source and should go first
+  delete self->itsIterator;
+  delete self->itsSource;
+  Py_TYPE(obj)->tp_free(obj);
+}
+
+/// @brief move to the next chunk
+/// @param[in] obj DataIterator object
+/// @return new reference to the dictionary of views or NULL at the end or on error
+PyObject* dataIteratorNext(PyObject *obj)
+{
+  DataIteratorObject *self = reinterpret_cast<DataIteratorObject*>(obj);
+  try {
+     IConstDataIterator &it = **self->itsIterator;
+     if (self->itsStarted) {
+         it.next();
+     }
+     self->itsStarted = true;
+     if (!it.hasMore()) {
+         // StopIteration
+         return NULL;
+     }
+     return accessorFields(*it);
+  }
+  catch (...) {
+     setPythonError();
+  }
+  return NULL;
+}
+
+/// @brief the DataIterator type, filled at module initialisation
+PyTypeObject dataIteratorType = { PyVarObject_HEAD_INIT(NULL, 0) };
+
+/// @brief read an image
+/// @param[in] args positional arguments: image name, image type (optional)
+/// @param[in] kwds keyword arguments
+/// @return new reference to the view or NULL with the Python error set
+PyObject* readImage(PyObject *, PyObject *args, PyObject *kwds)
+{
+  static const char *keywords[] = {"name", "imagetype", NULL};
+  const char *name = NULL;
+  const char *imageType = "casa";
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|s", const_cast<char**>(keywords), &name, &imageType)) {
+      return NULL;
+  }
+  try {
+     LOFAR::ParameterSet parset;
+     parset.add("imagetype", imageType);
+     const casacore::Array<float> pixels = imageAccessFactory(parset)->read(name);
+     // the array is owned by the view only, so it may be written
+     return makeArrayView(pixels, false);
+  }
+  catch (...) {
+     setPythonError();
+  }
+  return NULL;
+}
+
+/// @brief obtain Jones matrices for a range of antennas, beams and channels
+/// @details This is a wrapper of ICalSolutionConstAccessor::jonesBlock for the solution
+/// valid at the given time.
+/// @param[in] args positional arguments: parset (dictionary), time, nAnt, nBeam,
+/// startChan, nChan
+/// @return new reference to the tuple of views (jones, validity) or NULL with the Python error set
+PyObject* calibrationJones(PyObject *, PyObject *args)
+{
+  PyObject *params = NULL;
+  double time = 0.;
+  unsigned int nAnt = 0;
+  unsigned int nBeam = 0;
+  unsigned int startChan = 0;
+  unsigned int nChan = 0;
+  if (!PyArg_ParseTuple(args, "O!dIIII", &PyDict_Type, &params, &time, &nAnt, &nBeam,
+                        &startChan, &nChan)) {
+      return NULL;
+  }
+  LOFAR::ParameterSet parset;
+  if (!toParset(params, parset)) {
+      return NULL;
+  }
+  try {
+     const boost::shared_ptr<ICalSolutionConstSource> src = CalibAccessFactory::roCalSolutionSource(parset);
+     ASKAPCHECK(src, "Unable to create calibration solution source");
+     const boost::shared_ptr<ICalSolutionConstAccessor> acc = src->roSolution(src->solutionID(time));
+     ASKAPCHECK(acc, "Unable to obtain calibration solution for time "<<time);
+     casacore::Array<casacore::Complex> jones;
+     casacore::Cube<casacore::Bool> validity;
+     acc->jonesBlock(nAnt, nBeam, startChan, nChan, jones, validity);
+     PyObject *jonesView = makeArrayView(jones, false);
+     PyObject *validityView = jonesView != NULL ? makeArrayView(validity, false) : NULL;
+     if (validityView == NULL) {
+         Py_XDECREF(jonesView);
+         return NULL;
+     }
+     return Py_BuildValue("(NN)", jonesView, validityView);
+  }
+  catch (...) {
+     setPythonError();
+  }
+  return NULL;
+}
+
+/// @brief functions of the module
+PyMethodDef moduleMethods[] = {
+  {"read_image", reinterpret_cast<PyCFunction>(readImage), METH_VARARGS | METH_KEYWORDS,
+   "read_image(name, imagetype='casa')\n\nRead the whole image, returns an ArrayView of the pixels"},
+  {"calibration_jones", calibrationJones, METH_VARARGS,
+   "calibration_jones(parset, time, nant, nbeam, startchan, nchan)\n\n"
+   "Jones matrices of the solution valid at the given time, returns ArrayViews\n"
+   "(jones 4 x nchan x nant x nbeam, validity nchan x nant x nbeam)"},
+  {NULL, NULL, 0, NULL}
+};
+
+/// @brief definition of the module
+PyModuleDef moduleDef = {
+  PyModuleDef_HEAD_INIT,
+  "_accessors",
+  "Zero-copy views of the arrays of data, calibration and image accessors",
+  -1,
+  moduleMethods,
+  NULL, NULL, NULL, NULL
+};
+
+} // anonymous namespace
+
+/// @brief initialise the module
+/// @return new reference to the module or NULL with the Python error set
+PyMODINIT_FUNC PyInit__accessors()
+{
+  dataIteratorType.tp_name = "_accessors.DataIterator";
+  dataIteratorType.tp_basicsize = sizeof(DataIteratorObject);
+  dataIteratorType.tp_dealloc = dataIteratorDealloc;
+  dataIteratorType.tp_flags = Py_TPFLAGS_DEFAULT;
+  dataIteratorType.tp_doc = "DataIterator(ms, datacolumn='DATA')\n\n"
+       "Iterator over the chunks of a measurement set, each chunk is a dictionary of\n"
+       "ArrayViews (and time) referencing the buffers of the accessor. The views are\n"
+       "valid until the iterator moves on, copy them to keep the data.";
+  dataIteratorType.tp_iter = PyObject_SelfIter;
+  dataIteratorType.tp_iternext = dataIteratorNext;
+  dataIteratorType.tp_new = dataIteratorNew;
+  if (PyType_Ready(&dataIteratorType) < 0) {
+      return NULL;
+  }
+
+  PyObject *module = PyModule_Create(&moduleDef);
+  if (module == NULL) {
+      return NULL;
+  }
+  if (!addArrayViewType(module)) {
+      Py_DECREF(module);
+      return NULL;
+  }
+  Py_INCREF(&dataIteratorType);
+  if (PyModule_AddObject(module, "DataIterator", reinterpret_cast<PyObject*>(&dataIteratorType)) < 0) {
+      Py_DECREF(&dataIteratorType);
+      Py_DECREF(module);
+      return NULL;
+  }
+  return module;
+}
@@ -0,0 +1,207 @@
+/// @file
+/// @brief Python view of a casacore array
+/// @details The ArrayView Python type exposes the storage of a casacore array via the
+/// buffer protocol, so numpy.asarray(view) gives a NumPy array sharing the memory of the
+/// accessor field, calibration block or image without copying. The view holds a reference
+/// to the casacore storage, so the memory stays valid as long as the view (or any NumPy
+/// array made from it) exists.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+///
+
+#include <askap/python/ArrayView.h>
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief Python object of the ArrayView type
+struct ArrayViewObject {
+  PyObject_HEAD
+  /// @brief owner of the storage
+  boost::shared_ptr<ArrayOwner> *itsOwner;
+  /// @brief memory layout
+  ArrayLayout *itsLayout;
+};
+
+/// @brief release the storage
+/// @param[in] obj ArrayView object
+void arrayViewDealloc(PyObject *obj)
+{
+  ArrayViewObject *self = reinterpret_cast<ArrayViewObject*>(obj);
+  delete self->itsLayout;
+  delete self->itsOwner;
+  Py_TYPE(obj)->tp_free(obj);
+}
+
+/// @brief fill the buffer structure
+/// @details All buffer requests except contiguous ones without strides are served,
+/// the consumer gets the strides of the casacore array.
+/// @param[in] obj ArrayView object
+/// @param[out] view buffer structure
+/// @param[in] flags request flags
+/// @return 0 on success, -1 with the Python error set otherwise
+int arrayViewGetBuffer(PyObject *obj, Py_buffer *view, int flags)
+{
+  const ArrayViewObject *self = reinterpret_cast<const ArrayViewObject*>(obj);
+  const ArrayLayout &layout = *self->itsLayout;
+  if (((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) && layout.itsReadOnly) {
+      PyErr_SetString(PyExc_BufferError, "The array view is read-only");
+      view->obj = NULL;
+      return -1;
+  }
+  if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+      PyErr_SetString(PyExc_BufferError, "The array view can only be accessed with strides");
+      view->obj = NULL;
+      return -1;
+  }
+  Py_ssize_t nElements = 1;
+  for (size_t dim = 0; dim < layout.itsShape.size(); ++dim) {
+       nElements *= layout.itsShape[dim];
+  }
+  view->buf = layout.itsData;
+  view->obj = obj;
+  Py_INCREF(obj);
+  view->len = nElements * layout.itsItemSize;
+  view->readonly = layout.itsReadOnly ? 1 : 0;
+  view->itemsize = layout.itsItemSize;
+  view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>(layout.itsFormat.c_str()) : NULL;
+  view->ndim = static_cast<int>(layout.itsShape.size());
+  view->shape = view->ndim > 0 ? const_cast<Py_ssize_t*>(&layout.itsShape[0]) : NULL;
+  view->strides = view->ndim > 0 ? const_cast<Py_ssize_t*>(&layout.itsStrides[0]) : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+  return 0;
+}
+
+/// @brief shape of the view as a tuple
+/// @param[in] obj ArrayView object
+/// @return new reference to the tuple
+PyObject* arrayViewShape(PyObject *obj, void *)
+{
+  const ArrayLayout &layout = *reinterpret_cast<const ArrayViewObject*>(obj)->itsLayout;
+  PyObject *shape = PyTuple_New(static_cast<Py_ssize_t>(layout.itsShape.size()));
+  if (shape != NULL) {
+      for (size_t dim = 0; dim < layout.itsShape.size(); ++dim) {
+           PyTuple_SET_ITEM(shape, dim, PyLong_FromSsize_t(layout.itsShape[dim]));
+      }
+  }
+  return shape;
+}
+
+/// @brief buffer protocol of the ArrayView type
+PyBufferProcs arrayViewBufferProcs = { arrayViewGetBuffer, NULL };
+
+/// @brief attributes of the ArrayView type
+PyGetSetDef arrayViewGetSet[] = {
+  {const_cast<char*>("shape"), arrayViewShape, NULL, const_cast<char*>("shape of the array"), NULL},
+  {NULL, NULL, NULL, NULL, NULL}
+};
+
+/// @brief the ArrayView type, filled by addArrayViewType
+PyTypeObject arrayViewType = { PyVarObject_HEAD_INIT(NULL, 0) };
+
+} // anonymous namespace
+
+/// @brief create a view of the given memory
+/// @details This is the type-independent part of makeArrayView.
+/// @param[in] owner object keeping the memory alive
+/// @param[in] layout memory layout
+/// @return new reference to the ArrayView object or NULL with the Python error set
+PyObject* makeArrayView(const boost::shared_ptr<ArrayOwner> &owner, const ArrayLayout &layout)
+{
+  if (arrayViewType.tp_flags == 0) {
+      PyErr_SetString(PyExc_RuntimeError, "The ArrayView type is not initialised");
+      return NULL;
+  }
+  ArrayViewObject *self = PyObject_New(ArrayViewObject, &arrayViewType);
+  if (self == NULL) {
+      return NULL;
+  }
+  self->itsOwner = new boost::shared_ptr<ArrayOwner>(owner);
+  self->itsLayout = new ArrayLayout(layout);
+  // an empty array may have no storage, the buffer pointer should still be valid
+  static char empty = 0;
+  if (self->itsLayout->itsData == NULL) {
+      self->itsLayout->itsData = &empty;
+  }
+  return reinterpret_cast<PyObject*>(self);
+}
+
+/// @brief create a view of uvw vectors
+/// @details The view is a nRow x 3 array of doubles.
+/// @param[in] uvw vector of uvw
+/// @param[in] readOnly if true, the buffer can't be written through
+/// @return new reference to the ArrayView object or NULL with the Python error set
+PyObject* makeArrayView(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                        bool readOnly)
+{
+  typedef casacore::RigidVector<casacore::Double, 3> UVW;
+  boost::shared_ptr<TypedArrayOwner<UVW> > owner(new TypedArrayOwner<UVW>(uvw));
+  const casacore::Array<UVW> &ref = owner->itsArray;
+  ArrayLayout layout;
+  layout.itsData = ref.nelements() > 0 ? const_cast<casacore::Double*>(&(*ref.data())(0)) : NULL;
+  layout.itsFormat = BufferFormat<casacore::Double>::format();
+  layout.itsItemSize = sizeof(casacore::Double);
+  layout.itsShape.push_back(ref.nelements());
+  layout.itsShape.push_back(3);
+  layout.itsStrides.push_back(ref.steps()(0) * static_cast<Py_ssize_t>(sizeof(UVW)));
+  layout.itsStrides.push_back(sizeof(casacore::Double));
+  layout.itsReadOnly = readOnly;
+  return makeArrayView(owner, layout);
+}
+
+/// @brief add the ArrayView type to a module
+/// @param[in] module module object
+/// @return true if successful, false with the Python error set otherwise
+bool addArrayViewType(PyObject *module)
+{
+  if (arrayViewType.tp_flags == 0) {
+      arrayViewType.tp_name = "_accessors.ArrayView";
+      arrayViewType.tp_basicsize = sizeof(ArrayViewObject);
+      arrayViewType.tp_dealloc = arrayViewDealloc;
+      arrayViewType.tp_as_buffer = &arrayViewBufferProcs;
+      arrayViewType.tp_getset = arrayViewGetSet;
+      arrayViewType.tp_flags = Py_TPFLAGS_DEFAULT;
+      arrayViewType.tp_doc = "View of a casacore array, use numpy.asarray to access the data";
+      if (PyType_Ready(&arrayViewType) < 0) {
+          arrayViewType.tp_flags = 0;
+          return false;
+      }
+  }
+  Py_INCREF(&arrayViewType);
+  if (PyModule_AddObject(module, "ArrayView", reinterpret_cast<PyObject*>(&arrayViewType)) < 0) {
+      Py_DECREF(&arrayViewType);
+      return false;
+  }
+  return true;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,160 @@
+/// @file
+/// @brief Python view of a casacore array
+/// @details The ArrayView Python type exposes the storage of a casacore array via the
+/// buffer protocol, so numpy.asarray(view) gives a NumPy array sharing the memory of the
+/// accessor field, calibration block or image without copying. The view holds a reference
+/// to the casacore storage, so the memory stays valid as long as the view (or any NumPy
+/// array made from it) exists.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ASKAP_ACCESSORS_PYTHON_ARRAY_VIEW_H
+#define ASKAP_ACCESSORS_PYTHON_ARRAY_VIEW_H
+
+// Python.h should be included before any standard header
+#include <Python.h>
+
+// std includes
+#include <string>
+#include <vector>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief format of the array elements in the buffer protocol (struct module syntax)
+/// @ingroup python
+template<typename T>
+struct BufferFormat;
+
+template<> struct BufferFormat<casacore::Bool> { static const char* format() { return "?"; } };
+template<> struct BufferFormat<casacore::uChar> { static const char* format() { return "B"; } };
+template<> struct BufferFormat<casacore::Short> { static const char* format() { return "h"; } };
+template<> struct BufferFormat<casacore::Int> { static const char* format() { return "i"; } };
+template<> struct BufferFormat<casacore::uInt> { static const char* format() { return "I"; } };
+template<> struct BufferFormat<casacore::Float> { static const char* format() { return "f"; } };
+template<> struct BufferFormat<casacore::Double> { static const char* format() { return "d"; } };
+template<> struct BufferFormat<casacore::Complex> { static const char* format() { return "Zf"; } };
+template<> struct BufferFormat<casacore::DComplex> { static const char* format() { return "Zd"; } };
+
+/// @brief memory layout of an array exposed to Python
+/// @details Shape and strides follow the casacore axis order (the first axis changes
+/// fastest), so element (i, j, k) of the NumPy array is element (i, j, k) of the casacore
+/// array and no transposition is needed. Strides are given in bytes.
+/// @ingroup python
+struct ArrayLayout {
+  /// @brief first element
+  void *itsData;
+  /// @brief element format (see BufferFormat)
+  std::string itsFormat;
+  /// @brief size of one element in bytes
+  Py_ssize_t itsItemSize;
+  /// @brief length of each axis
+  std::vector<Py_ssize_t> itsShape;
+  /// @brief distance in bytes between consecutive elements along each axis
+  std::vector<Py_ssize_t> itsStrides;
+  /// @brief true if the buffer can't be written through
+  bool itsReadOnly;
+};
+
+/// @brief owner of the storage of a view
+/// @details The storage of a casacore array is reference counted, a copy of the array
+/// keeps it alive. This class erases the element type of the array.
+/// @ingroup python
+struct ArrayOwner {
+  /// @brief virtual destructor to release the storage via the base class
+  virtual ~ArrayOwner() {}
+};
+
+/// @brief owner of the storage of a view of a particular type
+/// @ingroup python
+template<typename T>
+struct TypedArrayOwner : public ArrayOwner {
+  /// @brief reference the array
+  /// @param[in] arr array
+  explicit TypedArrayOwner(const casacore::Array<T> &arr) : itsArray(arr) {}
+
+  /// @brief array referencing the storage
+  casacore::Array<T> itsArray;
+};
+
+/// @brief create a view of the given memory
+/// @details This is the type-independent part of makeArrayView.
+/// @param[in] owner object keeping the memory alive
+/// @param[in] layout memory layout
+/// @return new reference to the ArrayView object or NULL with the Python error set
+PyObject* makeArrayView(const boost::shared_ptr<ArrayOwner> &owner, const ArrayLayout &layout);
+
+/// @brief create a view of a casacore array
+/// @details The view references the storage of the array, no data are copied. Arrays
+/// which are slices of a larger array are handled via strides.
+/// @param[in] arr array
+/// @param[in] readOnly if true, the buffer can't be written through
+/// @return new reference to the ArrayView object or NULL with the Python error set
+template<typename T>
+PyObject* makeArrayView(const casacore::Array<T> &arr, bool readOnly = true)
+{
+  boost::shared_ptr<TypedArrayOwner<T> > owner(new TypedArrayOwner<T>(arr));
+  const casacore::Array<T> &ref = owner->itsArray;
+  ArrayLayout layout;
+  layout.itsData = const_cast<T*>(ref.data());
+  layout.itsFormat = BufferFormat<T>::format();
+  layout.itsItemSize = sizeof(T);
+  for (size_t dim = 0; dim < ref.ndim(); ++dim) {
+       layout.itsShape.push_back(ref.shape()(dim));
+       layout.itsStrides.push_back(ref.steps()(dim) * static_cast<Py_ssize_t>(sizeof(T)));
+  }
+  layout.itsReadOnly = readOnly;
+  return makeArrayView(owner, layout);
+}
+
+/// @brief create a view of uvw vectors
+/// @details The view is a nRow x 3 array of doubles.
+/// @param[in] uvw vector of uvw
+/// @param[in] readOnly if true, the buffer can't be written through
+/// @return new reference to the ArrayView object or NULL with the Python error set
+PyObject* makeArrayView(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                        bool readOnly = true);
+
+/// @brief add the ArrayView type to a module
+/// @param[in] module module object
+/// @return true if successful, false with the Python error set otherwise
+bool addArrayViewType(PyObject *module);
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PYTHON_ARRAY_VIEW_H
@@ -0,0 +1,274 @@
+/// @file CompressedFileInputSource.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// Include own header file first
+#include "CompressedFileInputSource.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+// ASKAPsoft includes
+#include "askap/AskapError.h"
+#include "xercesc/util/BinInputStream.hpp"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// Local package includes
+#include "askap/votable/XercescString.h"
+
+using namespace askap;
+using namespace askap::accessors;
+using namespace xercesc;
+
+namespace {
+
+/// Size of the blocks of compressed data read from the file
+const size_t compressedBlockSize = 256 * 1024;
+
+/// Input stream decompressing a file as it goes
+///
+/// This class reads the compressed file a block at a time, derived classes
+/// decompress the blocks.
+class DecompressingBinInputStream : public BinInputStream, private boost::noncopyable {
+    public:
+        explicit DecompressingBinInputStream(const std::string& filename)
+            : itsFilename(filename), itsFile(std::fopen(filename.c_str(), "rb")),
+              itsBuffer(compressedBlockSize), itsPos(0) {
+            if (!itsFile) {
+                ASKAPTHROW(AskapError, "File " << filename << " could not be opened: "
+                           << std::strerror(errno));
+            }
+        }
+
+        virtual ~DecompressingBinInputStream() {
+            std::fclose(itsFile);
+        }
+
+        virtual XMLFilePos curPos() const {
+            return itsPos;
+        }
+
+        virtual XMLSize_t readBytes(XMLByte* const toFill, const XMLSize_t maxToRead) {
+            const XMLSize_t nRead = maxToRead > 0 ? decompress(toFill, maxToRead) : 0;
+            itsPos += nRead;
+            return nRead;
+        }
+
+        virtual const XMLCh* getContentType() const {
+            return 0;
+        }
+
+    protected:
+        /// Decompress data into the given memory
+        /// @return the number of bytes stored (zero at the end of the data only)
+        virtual XMLSize_t decompress(XMLByte* out, XMLSize_t size) = 0;
+
+        /// Read the next block of the file into the buffer
+        /// @return the number of bytes read (zero at the end of the file)
+        size_t refill() {
+            const size_t nRead = std::fread(&itsBuffer[0], 1, itsBuffer.size(), itsFile);
+            if (nRead < itsBuffer.size() && std::ferror(itsFile)) {
+                ASKAPTHROW(AskapError, "Error reading " << itsFilename);
+            }
+            return nRead;
+        }
+
+        /// The block of compressed data read by refill
+        unsigned char* buffer() {
+            return &itsBuffer[0];
+        }
+
+        /// Name of the file
+        const std::string& filename() const {
+            return itsFilename;
+        }
+
+    private:
+        std::string itsFilename;
+        std::FILE* itsFile;
+        std::vector<unsigned char> itsBuffer;
+        XMLFilePos itsPos;
+};
+
+#ifdef HAVE_ZLIB
+/// Input stream decompressing a gzip file, members following each other are joined
+class GzipBinInputStream : public DecompressingBinInputStream {
+    public:
+        explicit GzipBinInputStream(const std::string& filename)
+            : DecompressingBinInputStream(filename), itsInMember(false), itsFinished(false) {
+            std::memset(&itsZ, 0, sizeof(itsZ));
+            // 32 enables the detection of the gzip header
+            ASKAPCHECK(inflateInit2(&itsZ, 15 + 32) == Z_OK, "Unable to set up the decompression of "
+                       << filename);
+        }
+
+        virtual ~GzipBinInputStream() {
+            inflateEnd(&itsZ);
+        }
+
+    protected:
+        virtual XMLSize_t decompress(XMLByte* out, XMLSize_t size) {
+            const uInt outSize = static_cast<uInt>(std::min<XMLSize_t>(size,
+                                 std::numeric_limits<uInt>::max()));
+            itsZ.next_out = out;
+            itsZ.avail_out = outSize;
+            XMLSize_t nDone = 0;
+            while (nDone == 0 && !itsFinished) {
+                if (itsZ.avail_in > 0 || itsInMember) {
+                    const int status = inflate(&itsZ, Z_NO_FLUSH);
+                    if (status == Z_STREAM_END) {
+                        // another member may follow
+                        inflateReset(&itsZ);
+                        itsInMember = false;
+                    } else if (status == Z_OK) {
+                        itsInMember = true;
+                    } else if (status != Z_BUF_ERROR) {
+                        ASKAPTHROW(AskapError, "Error decompressing " << filename() << ": "
+                                   << (itsZ.msg ? itsZ.msg : "corrupt data"));
+                    }
+                    nDone = outSize - itsZ.avail_out;
+                    if (nDone > 0 || itsZ.avail_in > 0) {
+                        continue;
+                    }
+                }
+                const size_t nRead = refill();
+                if (nRead == 0) {
+                    ASKAPCHECK(!itsInMember, "Compressed file " << filename() << " is truncated");
+                    itsFinished = true;
+                } else {
+                    itsZ.next_in = buffer();
+                    itsZ.avail_in = static_cast<uInt>(nRead);
+                }
+            }
+            return nDone;
+        }
+
+    private:
+        z_stream itsZ;
+        bool itsInMember;
+        bool itsFinished;
+};
+#endif
+
+#ifdef HAVE_ZSTD
+/// Input stream decompressing a zstd file, frames following each other are joined
+class ZstdBinInputStream : public DecompressingBinInputStream {
+    public:
+        explicit ZstdBinInputStream(const std::string& filename)
+            : DecompressingBinInputStream(filename), itsStream(ZSTD_createDStream()),
+              itsFrameEnd(true), itsFinished(false) {
+            ASKAPCHECK(itsStream, "Unable to set up the decompression of " << filename);
+            ZSTD_initDStream(itsStream);
+            itsIn.src = 0;
+            itsIn.size = 0;
+            itsIn.pos = 0;
+        }
+
+        virtual ~ZstdBinInputStream() {
+            ZSTD_freeDStream(itsStream);
+        }
+
+    protected:
+        virtual XMLSize_t decompress(XMLByte* out, XMLSize_t size) {
+            ZSTD_outBuffer output = {out, size, 0};
+            while (output.pos == 0 && !itsFinished) {
+                if (itsIn.pos < itsIn.size || !itsFrameEnd) {
+                    const size_t inBefore = itsIn.pos;
+                    const size_t status = ZSTD_decompressStream(itsStream, &output, &itsIn);
+                    if (ZSTD_isError(status)) {
+                        ASKAPTHROW(AskapError, "Error decompressing " << filename() << ": "
+                                   << ZSTD_getErrorName(status));
+                    }
+                    if (itsIn.pos != inBefore || output.pos > 0) {
+                        itsFrameEnd = (status == 0);
+                    }
+                    if (output.pos > 0 || itsIn.pos < itsIn.size) {
+                        continue;
+                    }
+                }
+                const size_t nRead = refill();
+                if (nRead == 0) {
+                    ASKAPCHECK(itsFrameEnd, "Compressed file " << filename() << " is truncated");
+                    itsFinished = true;
+                } else {
+                    itsIn.src = buffer();
+                    itsIn.size = nRead;
+                    itsIn.pos = 0;
+                }
+            }
+            return output.pos;
+        }
+
+    private:
+        ZSTD_DStream* itsStream;
+        ZSTD_inBuffer itsIn;
+        bool itsFrameEnd;
+        bool itsFinished;
+};
+#endif
+
+}
+
+CompressedFileInputSource::CompressedFileInputSource(const std::string& filename,
+        VOTableCompression::Type type)
+    : itsFilename(filename), itsType(type)
+{
+    ASKAPCHECK(type != VOTableCompression::NONE, "File " << filename << " is not compressed");
+    ASKAPCHECK(VOTableCompression::isAvailable(type), "Unable to read " << filename << ", "
+               << VOTableCompression::name(type) << " compression is not supported by this build");
+    setSystemId(XercescString(filename));
+}
+
+BinInputStream* CompressedFileInputSource::makeStream() const
+{
+#ifdef HAVE_ZLIB
+    if (itsType == VOTableCompression::GZIP) {
+        return new GzipBinInputStream(itsFilename);
+    }
+#endif
+#ifdef HAVE_ZSTD
+    if (itsType == VOTableCompression::ZSTD) {
+        return new ZstdBinInputStream(itsFilename);
+    }
+#endif
+    ASKAPTHROW(AskapError, "Unable to read " << itsFilename << ", "
+               << VOTableCompression::name(itsType) << " compression is not supported by this build");
+}
@@ -0,0 +1,76 @@
+/// @file CompressedFileInputSource.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_COMPRESSEDFILEINPUTSOURCE_H
+#define ASKAP_ACCESSORS_VOTABLE_COMPRESSEDFILEINPUTSOURCE_H
+
+// System includes
+#include <string>
+
+// ASKAPsoft includes
+#include "boost/noncopyable.hpp"
+#include "xercesc/sax/InputSource.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableCompression.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Xerces input source decompressing a file while it is parsed
+        ///
+        /// The file is read a block at a time and decompressed into the buffer of
+        /// the parser, so neither the whole document nor a decompressed copy of the
+        /// file is ever kept. Concatenated gzip members and zstd frames (as written
+        /// by CompressedOutputStream with several threads) are read as one document.
+        ///
+        /// @ingroup votableaccess
+        class CompressedFileInputSource : public xercesc::InputSource,
+                                          private boost::noncopyable {
+            public:
+                /// Set up the source
+                ///
+                /// @param[in] filename name of the file to read
+                /// @param[in] type     compression of the file (not NONE)
+                /// @throw AskapError if the format is not supported by this build.
+                CompressedFileInputSource(const std::string& filename, VOTableCompression::Type type);
+
+                /// Returns a stream decompressing the file (owned by the caller)
+                /// @throw AskapError if the file cannot be opened.
+                virtual xercesc::BinInputStream* makeStream() const;
+
+            private:
+                /// Name of the file
+                std::string itsFilename;
+
+                /// Compression of the file
+                VOTableCompression::Type itsType;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,327 @@
+/// @file CompressedOutputStream.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// Include own header file first
+#include "CompressedOutputStream.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// ASKAPsoft includes
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+#include "boost/bind.hpp"
+#include "boost/ref.hpp"
+#include "boost/thread/thread.hpp"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+ASKAP_LOGGER(logger, ".CompressedOutputStream");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// Size of the blocks of data compressed together (gzip member or zstd input chunk)
+const size_t blockSize = 1024 * 1024;
+
+#ifdef HAVE_ZLIB
+/// Compress a block of data as a complete gzip member
+///
+/// @param[in] data     the data
+/// @param[in] size     number of bytes
+/// @param[out] out     the member
+/// @param[out] error   error message (empty on success)
+void gzipBlock(const char* data, size_t size, std::vector<char>& out, std::string& error)
+{
+    z_stream z;
+    std::memset(&z, 0, sizeof(z));
+    // 16 selects the gzip header and trailer
+    if (deflateInit2(&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        error = "unable to set up gzip compression";
+        return;
+    }
+    out.resize(deflateBound(&z, static_cast<uLong>(size)));
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    z.avail_in = static_cast<uInt>(size);
+    z.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    z.avail_out = static_cast<uInt>(out.size());
+    if (deflate(&z, Z_FINISH) == Z_STREAM_END) {
+        out.resize(z.total_out);
+    } else {
+        error = z.msg ? z.msg : "gzip compression failed";
+    }
+    deflateEnd(&z);
+}
+#endif
+
+}
+
+/// Stream buffer compressing the data put into it
+class CompressedOutputStream::Buffer : public std::streambuf {
+    public:
+        Buffer(const std::string& filename, VOTableCompression::Type type, size_t nThreads)
+            : itsFilename(filename), itsType(type), itsFile(0),
+              itsNThreads(nThreads > 0 ? nThreads : std::max(1u, boost::thread::hardware_concurrency())),
+              itsNMembers(0)
+#ifdef HAVE_ZSTD
+              , itsContext(0)
+#endif
+        {
+            ASKAPCHECK(type != VOTableCompression::NONE, "No compression is given for " << filename);
+            ASKAPCHECK(VOTableCompression::isAvailable(type), "Unable to write " << filename << ", "
+                       << VOTableCompression::name(type) << " compression is not supported by this build");
+            // gzip members of a batch are compressed in parallel, libzstd splits its input itself
+            itsInput.resize(type == VOTableCompression::GZIP ? itsNThreads * blockSize : blockSize);
+#ifdef HAVE_ZSTD
+            if (type == VOTableCompression::ZSTD) {
+                itsContext = ZSTD_createCCtx();
+                ASKAPCHECK(itsContext, "Unable to set up zstd compression for " << filename);
+                if (itsNThreads > 1 && ZSTD_isError(ZSTD_CCtx_setParameter(itsContext, ZSTD_c_nbWorkers,
+                                                    static_cast<int>(itsNThreads)))) {
+                    ASKAPLOG_WARN_STR(logger, "libzstd doesn't support multithreading, " << filename
+                                      << " is compressed by one thread");
+                    itsNThreads = 1;
+                }
+                itsOutput.resize(ZSTD_CStreamOutSize());
+            }
+#endif
+            itsFile = std::fopen(filename.c_str(), "wb");
+            if (!itsFile) {
+                release();
+                ASKAPTHROW(AskapError, "File " << filename << " could not be created: "
+                           << std::strerror(errno));
+            }
+            setp(&itsInput[0], &itsInput[0] + itsInput.size());
+        }
+
+        virtual ~Buffer() {
+            if (itsFile) {
+                std::fclose(itsFile);
+            }
+            release();
+        }
+
+        /// Compress the remaining data, end the stream and close the file
+        void finish() {
+            if (!itsFile) {
+                return;
+            }
+            compress(true);
+            std::FILE* file = itsFile;
+            itsFile = 0;
+            ASKAPCHECK(std::fclose(file) == 0, "Error closing " << itsFilename << ": "
+                       << std::strerror(errno));
+        }
+
+        /// Number of compression threads
+        size_t nThreads() const {
+            return itsNThreads;
+        }
+
+    protected:
+        virtual int_type overflow(int_type c) {
+            try {
+                compress(false);
+            } catch (const AskapError& ex) {
+                ASKAPLOG_ERROR_STR(logger, ex.what());
+                return traits_type::eof();
+            }
+            if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(c);
+                pbump(1);
+                return c;
+            }
+            return traits_type::not_eof(c);
+        }
+
+        virtual int sync() {
+            try {
+                compress(false);
+            } catch (const AskapError& ex) {
+                ASKAPLOG_ERROR_STR(logger, ex.what());
+                return -1;
+            }
+            return 0;
+        }
+
+    private:
+        /// Compress the data put into the buffer and write the result
+        /// @param[in] end  true to end the compressed stream
+        void compress(bool end) {
+            ASKAPCHECK(itsFile, "File " << itsFilename << " has been closed");
+            const size_t size = pptr() - pbase();
+#ifdef HAVE_ZLIB
+            if (itsType == VOTableCompression::GZIP) {
+                // an empty file is still a valid gzip file with one empty member
+                if (size > 0 || (end && itsNMembers == 0)) {
+                    compressGzip(size);
+                }
+            }
+#endif
+#ifdef HAVE_ZSTD
+            if (itsType == VOTableCompression::ZSTD) {
+                compressZstd(size, end);
+            }
+#endif
+            setp(&itsInput[0], &itsInput[0] + itsInput.size());
+        }
+
+#ifdef HAVE_ZLIB
+        /// Compress the buffered data into gzip members, one per block
+        /// @param[in] size number of bytes
+        void compressGzip(size_t size) {
+            const size_t nBlocks = std::max<size_t>(1, (size + blockSize - 1) / blockSize);
+            itsMembers.resize(nBlocks);
+            std::vector<std::string> errors(nBlocks);
+            if (nBlocks == 1) {
+                gzipBlock(&itsInput[0], size, itsMembers[0], errors[0]);
+            } else {
+                boost::thread_group threads;
+                for (size_t block = 0; block < nBlocks; ++block) {
+                    const size_t offset = block * blockSize;
+                    threads.create_thread(boost::bind(&gzipBlock, &itsInput[offset],
+                                          std::min(blockSize, size - offset),
+                                          boost::ref(itsMembers[block]), boost::ref(errors[block])));
+                }
+                threads.join_all();
+            }
+            for (size_t block = 0; block < nBlocks; ++block) {
+                ASKAPCHECK(errors[block].empty(), "Error compressing " << itsFilename << ": " << errors[block]);
+                write(&itsMembers[block][0], itsMembers[block].size());
+            }
+            itsNMembers += nBlocks;
+        }
+#endif
+
+#ifdef HAVE_ZSTD
+        /// Pass the buffered data to the zstd stream
+        /// @param[in] size number of bytes
+        /// @param[in] end  true to end the frame
+        void compressZstd(size_t size, bool end) {
+            ZSTD_inBuffer input = {&itsInput[0], size, 0};
+            const ZSTD_EndDirective mode = end ? ZSTD_e_end : ZSTD_e_continue;
+            for (bool done = false; !done;) {
+                ZSTD_outBuffer output = {&itsOutput[0], itsOutput.size(), 0};
+                const size_t remaining = ZSTD_compressStream2(itsContext, &output, &input, mode);
+                ASKAPCHECK(!ZSTD_isError(remaining), "Error compressing " << itsFilename << ": "
+                           << ZSTD_getErrorName(remaining));
+                write(&itsOutput[0], output.pos);
+                done = end ? (remaining == 0) : (input.pos == input.size);
+            }
+        }
+#endif
+
+        /// Write compressed data to the file
+        void write(const char* data, size_t size) {
+            if (size > 0) {
+                ASKAPCHECK(std::fwrite(data, 1, size, itsFile) == size, "Error writing " << itsFilename
+                           << ": " << std::strerror(errno));
+            }
+        }
+
+        /// Release the compression context
+        void release() {
+#ifdef HAVE_ZSTD
+            if (itsContext) {
+                ZSTD_freeCCtx(itsContext);
+                itsContext = 0;
+            }
+#endif
+        }
+
+        /// Name of the file
+        std::string itsFilename;
+
+        /// Compression format
+        VOTableCompression::Type itsType;
+
+        /// The file (null once closed)
+        std::FILE* itsFile;
+
+        /// Number of compression threads
+        size_t itsNThreads;
+
+        /// Number of gzip members written
+        size_t itsNMembers;
+
+        /// Data not compressed yet (the put area of the buffer)
+        std::vector<char> itsInput;
+
+        /// Compressed gzip members of the current batch
+        std::vector<std::vector<char> > itsMembers;
+
+        /// Compressed zstd data
+        std::vector<char> itsOutput;
+
+#ifdef HAVE_ZSTD
+        /// zstd compression context
+        ZSTD_CCtx* itsContext;
+#endif
+};
+
+CompressedOutputStream::CompressedOutputStream(const std::string& filename,
+        VOTableCompression::Type type, size_t nThreads)
+    : std::ostream(0), itsBuffer(new Buffer(filename, type, nThreads))
+{
+    rdbuf(itsBuffer.get());
+}
+
+CompressedOutputStream::~CompressedOutputStream()
+{
+    try {
+        close();
+    } catch (const AskapError& ex) {
+        ASKAPLOG_WARN_STR(logger, "Failed to close the compressed stream: " << ex.what());
+    }
+}
+
+void CompressedOutputStream::close()
+{
+    itsBuffer->finish();
+    ASKAPCHECK(!fail(), "Error writing the compressed stream");
+}
+
+size_t CompressedOutputStream::nThreads() const
+{
+    return itsBuffer->nThreads();
+}
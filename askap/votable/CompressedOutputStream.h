@@ -0,0 +1,94 @@
+/// @file CompressedOutputStream.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_COMPRESSEDOUTPUTSTREAM_H
+#define ASKAP_ACCESSORS_VOTABLE_COMPRESSEDOUTPUTSTREAM_H
+
+// System includes
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+// ASKAPsoft includes
+#include "boost/scoped_ptr.hpp"
+#include "boost/utility.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableCompression.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Output stream writing a compressed file
+        ///
+        /// The data written to the stream are compressed with several threads.
+        /// gzip files are written as a sequence of independent members of 1 MB of
+        /// data each (as pigz does), the members of a batch being compressed in
+        /// parallel; any gzip reader decompresses them as one stream. zstd files use
+        /// the worker threads of libzstd (if it has been built with multithreading
+        /// support). The file is complete only after close has been called.
+        /// @code
+        ///    CompressedOutputStream os("catalogue.xml.gz", VOTableCompression::GZIP);
+        ///    vot.toXML(os);
+        ///    os.close();
+        /// @endcode
+        ///
+        /// @ingroup votableaccess
+        class CompressedOutputStream : public std::ostream, private boost::noncopyable {
+            public:
+                /// Create the file
+                ///
+                /// @param[in] filename name of the file to write
+                /// @param[in] type     compression format (not NONE)
+                /// @param[in] nThreads number of compression threads, 0 for one per core
+                /// @throw AskapError if the file cannot be created or the format
+                ///                   is not supported by this build.
+                CompressedOutputStream(const std::string& filename, VOTableCompression::Type type,
+                                       size_t nThreads = 0);
+
+                /// Close the file if close hasn't been called (errors are logged)
+                virtual ~CompressedOutputStream();
+
+                /// Compress the remaining data, end the compressed stream and close the file
+                ///
+                /// @throw AskapError if the data cannot be written.
+                void close();
+
+                /// Number of compression threads
+                size_t nThreads() const;
+
+            private:
+                /// The stream buffer doing the compression
+                class Buffer;
+
+                /// The stream buffer
+                boost::scoped_ptr<Buffer> itsBuffer;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,107 @@
+/// @file MappedFileInputSource.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+// Include own header file first
+#include "MappedFileInputSource.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ASKAPsoft includes
+#include "askap/AskapError.h"
+#include "xercesc/util/BinMemInputStream.hpp"
+
+// Local package includes
+#include "askap/votable/XercescString.h"
+
+using namespace askap;
+using namespace askap::accessors;
+using namespace xercesc;
+
+MappedFileInputSource::MappedFileInputSource(const std::string& filename)
+    : itsData(0), itsSize(0)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        ASKAPTHROW(AskapError, "File " << filename << " could not be opened: "
+                   << std::strerror(errno));
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        const int err = errno;
+        ::close(fd);
+        ASKAPTHROW(AskapError, "Unable to stat file " << filename << ": " << std::strerror(err));
+    }
+    itsSize = static_cast<std::size_t>(st.st_size);
+
+    // A zero length mapping is not allowed, an empty file is simply an empty stream
+    if (itsSize > 0) {
+        void* data = ::mmap(0, itsSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            const int err = errno;
+            ::close(fd);
+            ASKAPTHROW(AskapError, "Unable to map file " << filename << ": " << std::strerror(err));
+        }
+        itsData = data;
+        // The document is parsed front to back
+        ::madvise(itsData, itsSize, MADV_SEQUENTIAL);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+
+    setSystemId(XercescString(filename));
+}
+
+MappedFileInputSource::~MappedFileInputSource()
+{
+    if (itsData) {
+        ::munmap(itsData, itsSize);
+    }
+}
+
+BinInputStream* MappedFileInputSource::makeStream() const
+{
+    static const XMLByte empty = 0;
+    const XMLByte* data = itsData ? static_cast<const XMLByte*>(itsData) : &empty;
+    return new BinMemInputStream(data, itsSize, BinMemInputStream::BufOpt_Reference);
+}
+
+std::size_t MappedFileInputSource::size() const
+{
+    return itsSize;
+}
@@ -0,0 +1,79 @@
+/// @file MappedFileInputSource.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_MAPPEDFILEINPUTSOURCE_H
+#define ASKAP_ACCESSORS_VOTABLE_MAPPEDFILEINPUTSOURCE_H
+
+// System includes
+#include <string>
+#include <cstddef>
+
+// ASKAPsoft includes
+#include "boost/noncopyable.hpp"
+#include "xercesc/sax/InputSource.hpp"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Xerces input source reading a file through a memory mapping
+        ///
+        /// The whole file is mapped read-only when the object is constructed and
+        /// the parser reads directly from the mapping, so no copy of the document
+        /// is made in user space. The mapping is released by the destructor, hence
+        /// the object must outlive any parse of it.
+        ///
+        /// @ingroup votableaccess
+        class MappedFileInputSource : public xercesc::InputSource,
+                                      private boost::noncopyable {
+            public:
+                /// Map the file
+                ///
+                /// @param[in] filename name of the file to read
+                /// @throw AskapError if the file cannot be opened or mapped.
+                explicit MappedFileInputSource(const std::string& filename);
+
+                /// Unmap the file
+                virtual ~MappedFileInputSource();
+
+                /// Returns a stream reading from the mapping (owned by the caller)
+                virtual xercesc::BinInputStream* makeStream() const;
+
+                /// Returns the size of the file in bytes
+                std::size_t size() const;
+
+            private:
+                /// Start of the mapping (null for an empty file)
+                void* itsData;
+
+                /// Size of the mapping in bytes
+                std::size_t itsSize;
+        };
+
+    }
+}
+
+#endif
@@ -35,7 +35,9 @@
 #include <sstream>
 #include <istream>
 #include <ostream>
+#include <utility>
 #include <iostream>
+#include <algorithm>
 
 // ASKAPsoft includes
 #include "askap/AskapLogging.h"
@@ -44,19 +46,25 @@
 #include "boost/algorithm/string/trim.hpp"
 
 // For XML
+#include "askap/votable/XercescPlatform.h"
 #include "askap/votable/XercescString.h"
 #include "askap/votable/XercescUtils.h"
 #include "xercesc/dom/DOM.hpp" // Includes all DOM
 #include "xercesc/framework/XMLFormatter.hpp"
 #include "xercesc/sax/InputSource.hpp"
 #include "xercesc/framework/LocalFileFormatTarget.hpp"
-#include "xercesc/framework/LocalFileInputSource.hpp"
 #include "xercesc/framework/MemBufFormatTarget.hpp"
 #include "xercesc/framework/MemBufInputSource.hpp"
+#include "xercesc/framework/Wrapper4InputSource.hpp"
 #include "xercesc/parsers/XercesDOMParser.hpp"
+#include "xercesc/util/XMLException.hpp"
 
 // Local package includes
+#include "askap/votable/CompressedOutputStream.h"
+#include "askap/votable/VOTableBinary2.h"
+#include "askap/votable/VOTableCompression.h"
 #include "askap/votable/VOTableInfo.h"
+#include "askap/votable/VOTableNames.h"
 #include "askap/votable/VOTableResource.h"
 
 ASKAP_LOGGER(logger, ".VOTable");
@@ -66,21 +74,292 @@ using namespace askap;
 using namespace askap::accessors;
 using namespace xercesc;
 
+namespace {
+
+/// Xerces format target writing to a std::ostream as the document is serialised
+class OStreamFormatTarget : public XMLFormatTarget {
+    public:
+        explicit OStreamFormatTarget(std::ostream& os) : itsStream(os) {}
+
+        virtual void writeChars(const XMLByte* const toWrite, const XMLSize_t count,
+                                XMLFormatter* const) {
+            itsStream.write(reinterpret_cast<const char*>(toWrite), count);
+        }
+
+        virtual void flush() {
+            itsStream.flush();
+        }
+
+    private:
+        std::ostream& itsStream;
+};
+
+/// DOM parser filter applying a VOTableFilter as the document is built
+///
+/// TD elements of the columns which are not selected are rejected as soon as
+/// they start, so their content is never added to the document. Rows are tested
+/// when their TR element is complete and removed if rejected, the remaining cells
+/// are put in the order of the selection. A BINARY2 stream is decoded, filtered
+/// and encoded again once its STREAM element is complete, and the FIELD elements
+/// are projected at the end of the TABLE. Errors cannot be thrown through the
+/// parser, they are kept and parsing is interrupted instead.
+class VOTableParserFilter : public DOMLSParserFilter {
+    public:
+        explicit VOTableParserFilter(const VOTableFilter& filter)
+            : itsFilter(filter), itsMapped(false), itsProjected(false), itsReorder(false),
+              itsColumn(0), itsSlot(-1)
+        {
+        }
+
+        virtual FilterAction startElement(DOMElement* e)
+        {
+            const XMLCh* name = e->getNodeName();
+            if (XMLString::equals(name, VOTableNames::tagCell)) {
+                itsSlot = itsColumn < itsSlots.size() ? itsSlots[itsColumn] : -1;
+                ++itsColumn;
+                return itsSlot < 0 ? DOMNodeFilter::FILTER_REJECT : DOMNodeFilter::FILTER_ACCEPT;
+            } else if (XMLString::equals(name, VOTableNames::tagRow)) {
+                if (!map()) {
+                    return DOMNodeFilter::FILTER_INTERRUPT;
+                }
+                itsColumn = 0;
+                std::fill(itsCellElements.begin(), itsCellElements.end(),
+                          static_cast<DOMElement*>(0));
+                for (std::vector<std::string>::iterator it = itsCells.begin();
+                        it != itsCells.end(); ++it) {
+                    it->clear();
+                }
+            } else if (XMLString::equals(name, VOTableNames::tagField)) {
+                // the attributes are enough to select the column and decode BINARY2
+                VOTableField f;
+                f.setName(XercescUtils::getAttribute(*e, VOTableNames::attrName));
+                f.setID(XercescUtils::getAttribute(*e, VOTableNames::attrID));
+                f.setDatatype(XercescUtils::getAttribute(*e, VOTableNames::attrDatatype));
+                f.setArraysize(XercescUtils::getAttribute(*e, VOTableNames::attrArraysize));
+                itsFields.push_back(f);
+            } else if (XMLString::equals(name, VOTableNames::tagTable)) {
+                itsFields.clear();
+                itsFieldElements.clear();
+                itsMapped = false;
+            }
+            return DOMNodeFilter::FILTER_ACCEPT;
+        }
+
+        virtual FilterAction acceptNode(DOMNode* node)
+        {
+            DOMElement* e = static_cast<DOMElement*>(node);
+            const XMLCh* name = e->getNodeName();
+            try {
+                if (XMLString::equals(name, VOTableNames::tagCell)) {
+                    // only the cells of selected columns get here
+                    std::string& cell = itsCells[itsSlot];
+                    const DOMNode* child = e->getFirstChild();
+                    if (child && child->getNodeType() == DOMNode::TEXT_NODE) {
+                        const XMLCh* data = static_cast<const DOMText*>(child)->getData();
+                        XercescUtils::transcode(data, XMLString::stringLen(data), cell);
+                        boost::trim(cell);
+                    }
+                    itsCellElements[itsSlot] = e;
+                } else if (XMLString::equals(name, VOTableNames::tagRow)) {
+                    if (!itsFilter.accept(itsCells)) {
+                        return DOMNodeFilter::FILTER_REJECT;
+                    }
+                    if (itsReorder) {
+                        for (std::vector<DOMElement*>::const_iterator it = itsCellElements.begin();
+                                it != itsCellElements.end(); ++it) {
+                            if (*it) {
+                                e->appendChild(*it);
+                            }
+                        }
+                    }
+                } else if (XMLString::equals(name, VOTableNames::tagField)) {
+                    itsFieldElements.push_back(e);
+                } else if (XMLString::equals(name, VOTableNames::tagStream)) {
+                    if (!map()) {
+                        return DOMNodeFilter::FILTER_INTERRUPT;
+                    }
+                    if (itsProjected || itsFilter.hasPredicate()) {
+                        filterStream(*e);
+                    }
+                } else if (XMLString::equals(name, VOTableNames::tagTable)) {
+                    if (!map()) {
+                        return DOMNodeFilter::FILTER_INTERRUPT;
+                    }
+                    if (itsProjected) {
+                        projectFields(*e);
+                    }
+                }
+            } catch (const std::exception& ex) {
+                itsError = ex.what();
+                return DOMNodeFilter::FILTER_INTERRUPT;
+            }
+            return DOMNodeFilter::FILTER_ACCEPT;
+        }
+
+        virtual DOMNodeFilter::ShowType getWhatToShow() const
+        {
+            return DOMNodeFilter::SHOW_ELEMENT;
+        }
+
+        /// Returns the error which interrupted parsing (empty if none)
+        const std::string& getError() const
+        {
+            return itsError;
+        }
+
+    private:
+        /// Work out the selection for the fields of the current table
+        ///
+        /// @return false if the selection is not possible (see getError)
+        bool map()
+        {
+            if (itsMapped) {
+                return true;
+            }
+            try {
+                itsSelection = itsFilter.selection(itsFields);
+            } catch (const AskapError& ex) {
+                itsError = ex.what();
+                return false;
+            }
+            itsSlots.assign(itsFields.size(), -1);
+            itsReorder = false;
+            for (size_t k = 0; k < itsSelection.size(); ++k) {
+                itsSlots[itsSelection[k]] = static_cast<int>(k);
+                if (k > 0 && itsSelection[k] < itsSelection[k - 1]) {
+                    itsReorder = true;
+                }
+            }
+            itsProjected = itsReorder || itsSelection.size() != itsFields.size();
+            itsCells.resize(itsSelection.size());
+            itsCellElements.resize(itsSelection.size());
+            itsMapped = true;
+            return true;
+        }
+
+        /// Replace the content of a STREAM element by the selected rows and columns
+        void filterStream(DOMElement& stream)
+        {
+            const std::string encoding = XercescUtils::getAttribute(stream, VOTableNames::attrEncoding);
+            ASKAPCHECK(encoding == "base64", "Unsupported encoding '" << encoding <<
+                       "' of the BINARY2 stream");
+            const std::string text = XercescString(stream.getTextContent());
+            std::vector<unsigned char> buf;
+            std::string pending;
+            ASKAPCHECK(VOTableBinary2::decodeBase64(text.data(), text.size(), pending, buf) &&
+                       pending.empty(), "Invalid base64 data in the BINARY2 stream");
+
+            std::vector<VOTableField> selected;
+            selected.reserve(itsSelection.size());
+            for (size_t k = 0; k < itsSelection.size(); ++k) {
+                selected.push_back(itsFields[itsSelection[k]]);
+            }
+            const VOTableBinary2 input(itsFields);
+            const VOTableBinary2 output(selected);
+
+            std::vector<unsigned char> result;
+            std::vector<std::string> cells;
+            std::vector<std::string> projected(itsSelection.size());
+            size_t pos = 0;
+            while (pos < buf.size()) {
+                ASKAPCHECK(input.decodeRow(&buf[0], buf.size(), pos, cells),
+                           "Truncated row in the BINARY2 stream");
+                for (size_t k = 0; k < itsSelection.size(); ++k) {
+                    projected[k].swap(cells[itsSelection[k]]);
+                }
+                if (itsFilter.accept(projected)) {
+                    output.encodeRow(projected, result);
+                }
+            }
+
+            std::string encoded;
+            VOTableBinary2::encodeBase64(result.empty() ? 0 : &result[0], result.size(), true, encoded);
+            while (DOMNode* child = stream.getFirstChild()) {
+                stream.removeChild(child)->release();
+            }
+            stream.appendChild(stream.getOwnerDocument()->createTextNode(XercescString(encoded)));
+        }
+
+        /// Keep the selected FIELD elements of a table, in the order of the selection
+        void projectFields(DOMElement& table)
+        {
+            if (itsFieldElements.empty()) {
+                return;
+            }
+            ASKAPCHECK(itsFieldElements.size() == itsFields.size(), "FIELD elements outside TABLE");
+            DOMNode* next = itsFieldElements.back()->getNextSibling();
+            for (std::vector<DOMElement*>::const_iterator it = itsFieldElements.begin();
+                    it != itsFieldElements.end(); ++it) {
+                (*it)->getParentNode()->removeChild(*it);
+            }
+            for (size_t k = 0; k < itsSelection.size(); ++k) {
+                table.insertBefore(itsFieldElements[itsSelection[k]], next);
+            }
+            for (size_t i = 0; i < itsSlots.size(); ++i) {
+                if (itsSlots[i] < 0) {
+                    itsFieldElements[i]->release();
+                }
+            }
+            itsFieldElements.clear();
+        }
+
+        /// The columns and rows to keep
+        const VOTableFilter& itsFilter;
+
+        /// Fields of the current table
+        std::vector<VOTableField> itsFields;
+
+        /// FIELD elements of the current table
+        std::vector<DOMElement*> itsFieldElements;
+
+        /// Index of the field of each selected column
+        std::vector<size_t> itsSelection;
+
+        /// Position in the selection of each field (-1 if not selected)
+        std::vector<int> itsSlots;
+
+        /// True if the selection is known for the current table
+        bool itsMapped;
+
+        /// True if the selection differs from the fields of the table
+        bool itsProjected;
+
+        /// True if the selected columns are not in the order of the table
+        bool itsReorder;
+
+        /// Index of the next TD element of the current row
+        size_t itsColumn;
+
+        /// Position in the selection of the current TD element
+        int itsSlot;
+
+        /// Selected cells of the current row
+        std::vector<std::string> itsCells;
+
+        /// Selected TD elements of the current row
+        std::vector<DOMElement*> itsCellElements;
+
+        /// Error which interrupted parsing
+        std::string itsError;
+};
+
+}
+
 VOTable::VOTable(void)
 {
 }
 
-std::string VOTable::getDescription() const
+const std::string& VOTable::getDescription() const
 {
     return itsDescription;
 }
 
-std::vector<askap::accessors::VOTableInfo> VOTable::getInfo() const
+const std::vector<askap::accessors::VOTableInfo>& VOTable::getInfo() const
 {
     return itsInfo;
 }
 
-std::vector<askap::accessors::VOTableResource> VOTable::getResource() const
+const std::vector<askap::accessors::VOTableResource>& VOTable::getResource() const
 {
     return itsResource;
 }
@@ -95,6 +374,13 @@ void VOTable::addResource(const askap::accessors::VOTableResource& resource)
     itsResource.push_back(resource);
 }
 
+#if __cplusplus >= 201103L
+void VOTable::addResource(askap::accessors::VOTableResource&& resource)
+{
+    itsResource.push_back(std::move(resource));
+}
+#endif
+
 void VOTable::addInfo(const askap::accessors::VOTableInfo& info)
 {
     itsInfo.push_back(info);
@@ -108,8 +394,8 @@ void VOTable::toXMLImpl(xercesc::XMLFormatTarget& target) const
     doc->setXmlVersion(XercescString("1.0"));
 
     // Create the root element and add it to the document
-    DOMElement* root = doc->createElement(XercescString("VOTABLE"));
-    root->setAttribute(XercescString("version"), XercescString("1.2"));
+    DOMElement* root = doc->createElement(VOTableNames::tagVOTable);
+    root->setAttribute(VOTableNames::attrVersion, XercescString("1.2"));
     root->setAttribute(XercescString("xmlns:xsi"),
                        XercescString("http://www.w3.org/2001/XMLSchema-instance"));
     root->setAttribute(XercescString("xmlns"),
@@ -121,7 +407,7 @@ void VOTable::toXMLImpl(xercesc::XMLFormatTarget& target) const
 
     // Create DESCRIPTION element
     if (itsDescription != "") {
-        DOMElement* descElement = doc->createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc->createElement(VOTableNames::tagDescription);
         DOMText* text = doc->createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         root->appendChild(descElement);
@@ -139,31 +425,21 @@ void VOTable::toXMLImpl(xercesc::XMLFormatTarget& target) const
         root->appendChild(it->toXmlElement(*doc));
     }
 
-    // Write
-    DOMLSSerializer* writer = ((DOMImplementationLS*)impl)->createLSSerializer();
-
-    if (writer->getDomConfig()->canSetParameter(XMLUni::fgDOMWRTFormatPrettyPrint, true)) {
-        writer->getDomConfig()->setParameter(XMLUni::fgDOMWRTFormatPrettyPrint, true);
-    }
-
+    // Write with a pooled serializer
+    const XercescPlatform::SerializerLease writer;
     DOMLSOutput* output = ((DOMImplementationLS*)impl)->createLSOutput();
     output->setByteStream(&target);
     writer->write(doc, output);
 
     // Cleanup
     output->release();
-    writer->release();
     doc->release();
 }
 
 VOTable VOTable::fromXMLImpl(const xercesc::InputSource& source)
 {
-    // Setup a parser
-    boost::scoped_ptr<xercesc::XercesDOMParser> parser(new XercesDOMParser);
-    parser->setValidationScheme(XercesDOMParser::Val_Never);
-    parser->setDoNamespaces(false);
-    parser->setDoSchema(false);
-    parser->setLoadExternalDTD(false);
+    // Take a parser from the pool, the document is released when the lease ends
+    const XercescPlatform::ParserLease parser;
 
     // Parse file
     parser->parse(source);
@@ -172,21 +448,74 @@ VOTable VOTable::fromXMLImpl(const xercesc::InputSource& source)
     DOMDocument* doc = parser->getDocument();
     DOMElement* root = doc->getDocumentElement();
     if (!root) {
-        parser.reset(0);;
-        xercesc::XMLPlatformUtils::Terminate();
         ASKAPTHROW(AskapError, "empty XML document");
     }
 
     // Build the VOTable
+    return fromXmlElement(*root);
+}
+
+VOTable VOTable::fromXMLImpl(xercesc::InputSource& source, const VOTableFilter& filter)
+{
+    if (filter.isTrivial()) {
+        return fromXMLImpl(source);
+    }
+
+    // Setup a parser with the filter, which requires the DOM Level 3 interface
+    DOMImplementation *impl = DOMImplementationRegistry::getDOMImplementation(XercescString("LS"));
+    DOMLSParser* parser = ((DOMImplementationLS*)impl)->createLSParser(
+                              DOMImplementationLS::MODE_SYNCHRONOUS, 0);
+    DOMConfiguration* config = parser->getDomConfig();
+    config->setParameter(XMLUni::fgDOMValidate, false);
+    config->setParameter(XMLUni::fgDOMNamespaces, false);
+    config->setParameter(XMLUni::fgXercesSchema, false);
+    config->setParameter(XMLUni::fgXercesLoadExternalDTD, false);
+    VOTableParserFilter parserFilter(filter);
+    parser->setFilter(&parserFilter);
+
+    // Parse file
+    std::string error;
+    DOMDocument* doc = 0;
+    try {
+        Wrapper4InputSource input(&source, false);
+        doc = parser->parse(&input);
+    } catch (const DOMLSException& ex) {
+        error = XercescString(ex.getMessage());
+    } catch (const XMLException& ex) {
+        error = XercescString(ex.getMessage());
+    }
+    if (!parserFilter.getError().empty()) {
+        error = parserFilter.getError();
+    }
+
+    // no need to free the doc pointer - owned by the parser object
+    DOMElement* root = doc ? doc->getDocumentElement() : 0;
+    if (!root || !error.empty()) {
+        parser->release();
+        ASKAPCHECK(error.empty(), "Error parsing VOTable: " << error);
+        ASKAPTHROW(AskapError, "empty XML document");
+    }
+
+    // Build the VOTable
+    VOTable vot = fromXmlElement(*root);
+
+    // Cleanup
+    parser->release();
+
+    return vot;
+}
+
+VOTable VOTable::fromXmlElement(const xercesc::DOMElement& e)
+{
     VOTable vot;
 
     // Process DESCRIPTION
-    std::string desc = XercescUtils::getDescription(*root);
+    std::string desc = XercescUtils::getDescription(e);
     boost::trim(desc);
     vot.setDescription(desc);
 
     // Process INFO
-    DOMNodeList* children = root->getElementsByTagName(XercescString("INFO"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableNames::tagInfo);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableInfo info = VOTableInfo::fromXmlElement(*node);
@@ -194,20 +523,21 @@ VOTable VOTable::fromXMLImpl(const xercesc::InputSource& source)
     }
 
     // Process RESOURCE
-    children = root->getElementsByTagName(XercescString("RESOURCE"));
+    children = e.getElementsByTagName(VOTableNames::tagResource);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
-        const VOTableResource res = VOTableResource::fromXmlElement(*node);
-        vot.addResource(res);
+        vot.addResource(VOTableResource::fromXmlElement(*node));
     }
 
-    // Cleanup
-    parser.reset(0);
-
     return vot;
 }
 
 VOTable VOTable::fromXML(const std::string& filename)
+{
+    return fromXML(filename, VOTableFilter());
+}
+
+VOTable VOTable::fromXML(const std::string& filename, const VOTableFilter& filter)
 {
     // Check if the file exists
     std::ifstream fs(filename.c_str());
@@ -216,31 +546,40 @@ VOTable VOTable::fromXML(const std::string& filename)
     }
 
     // Parse and build VOTable
-    xercesc::XMLPlatformUtils::Initialize();
+    const XercescPlatform platform;
 
-    boost::scoped_ptr<LocalFileInputSource> source(new LocalFileInputSource(XercescString(filename)));
+    // Plain files are read in place through a memory mapping, compressed
+    // files are decompressed as they are parsed
+    boost::scoped_ptr<xercesc::InputSource> source(VOTableCompression::makeInputSource(filename));
     VOTable vot;
-    vot = fromXMLImpl(*source);
+    vot = fromXMLImpl(*source, filter);
 
     source.reset(0);
-    xercesc::XMLPlatformUtils::Terminate();
     return vot;
 }
 
 void VOTable::toXML(const std::string& filename) const
 {
-    xercesc::XMLPlatformUtils::Initialize();
+    const XercescPlatform platform;
+
+    const VOTableCompression::Type compression = VOTableCompression::fromFilename(filename);
+    if (compression != VOTableCompression::NONE) {
+        CompressedOutputStream os(filename, compression);
+        OStreamFormatTarget target(os);
+        toXMLImpl(target);
+        os.close();
+        return;
+    }
 
     boost::scoped_ptr<LocalFileFormatTarget> target(new LocalFileFormatTarget(XercescString(filename)));
     toXMLImpl(*target);
 
     target.reset(0);
-    xercesc::XMLPlatformUtils::Terminate();
 }
 
 void VOTable::toXML(std::ostream& os) const
 {
-    xercesc::XMLPlatformUtils::Initialize();
+    const XercescPlatform platform;
     boost::scoped_ptr<MemBufFormatTarget> target(new MemBufFormatTarget());
 
     toXMLImpl(*target);
@@ -248,30 +587,33 @@ void VOTable::toXML(std::ostream& os) const
     std::string str(reinterpret_cast<const char*>(target->getRawBuffer()));
     target.reset(0);
     os << str;
-    xercesc::XMLPlatformUtils::Terminate();
 }
 
 VOTable VOTable::fromXML(std::istream& is)
 {
-    xercesc::XMLPlatformUtils::Initialize();
+    return fromXML(is, VOTableFilter());
+}
+
+VOTable VOTable::fromXML(std::istream& is, const VOTableFilter& filter)
+{
+    const XercescPlatform platform;
 
-    // Read the stream into a memory buffer
+    // Read the stream into a memory buffer, a block at a time
     std::vector<char> buf;
-    while (is.good()) {
-        const char c = is.get();
-        if (is.good())
-            buf.push_back(c);
+    char block[65536];
+    while (is.read(block, sizeof(block)) || is.gcount() > 0) {
+        buf.insert(buf.end(), block, block + is.gcount());
     }
+    const XMLByte empty = 0;
 
     boost::scoped_ptr<MemBufInputSource> source(new MemBufInputSource(
-                reinterpret_cast<const XMLByte*>(&buf[0]),
+                buf.empty() ? &empty : reinterpret_cast<const XMLByte*>(&buf[0]),
                 buf.size(),
                 XercescString("")));
 
     VOTable vot;
-    vot = fromXMLImpl(*source);
+    vot = fromXMLImpl(*source, filter);
     source.reset(0);
 
-    xercesc::XMLPlatformUtils::Terminate();
     return vot;
 }
@@ -45,6 +45,7 @@
 #include "askap/votable/VOTableRow.h"
 #include "askap/votable/VOTableTable.h"
 #include "askap/votable/VOTableGroup.h"
+#include "askap/votable/VOTableFilter.h"
 // NOTE: Some are unnecessarily included so the user can just include VOTable.h
 
 namespace askap {
@@ -61,19 +62,22 @@ namespace askap {
                 VOTable(void);
 
                 /// Get the text of the DESCRIPTION element.
-                std::string getDescription() const;
+                const std::string& getDescription() const;
 
                 /// Get a vector containing all the INFO elements in the VOTable
-                std::vector<askap::accessors::VOTableInfo> getInfo() const;
+                const std::vector<askap::accessors::VOTableInfo>& getInfo() const;
 
                 /// Get a vector containing all the RESOURCE elements in the VOTable
-                std::vector<askap::accessors::VOTableResource> getResource() const;
+                const std::vector<askap::accessors::VOTableResource>& getResource() const;
 
                 /// Set the text of the DESCRIPTION element.
                 void setDescription(const std::string& desc);
 
                 /// Add a RESOURCE element to the VOTable
                 void addResource(const askap::accessors::VOTableResource& resource);
+#if __cplusplus >= 201103L
+                void addResource(askap::accessors::VOTableResource&& resource);
+#endif
 
                 /// Add an INFO element to the VOTable
                 void addInfo(const askap::accessors::VOTableInfo& info);
@@ -92,19 +96,48 @@ namespace askap {
                 /// @throw AskapError   if the XML document is empty (i.e. no root).
                 static VOTable fromXML(std::istream& is);
 
+                /// Transform an XML VOTable to a VOTable object instance, keeping
+                /// only the columns and rows selected by the filter
+                ///
+                /// The filter is applied while the document is parsed, so the cells
+                /// of other columns and rejected rows are never stored.
+                ///
+                /// @param[in] is       an istream from which the XML input string
+                ///                     will be read from.
+                /// @param[in] filter   the columns and rows to keep.
+                /// @return a VOTable.
+                /// @throw AskapError   if the XML document is empty (i.e. no root)
+                ///                     or a selected column is not present in a table.
+                static VOTable fromXML(std::istream& is, const VOTableFilter& filter);
+
                 /// Transform the VOTable object into an XML VOTable
                 ///
+                /// Files named "*.gz" or "*.zst" are compressed with all cores
+                /// (see CompressedOutputStream).
                 /// @param[in] filename the file/path to write the XML output to.
                 void toXML(const std::string& filename) const;
 
                 /// Transform an XML VOTable to a VOTable object instance
                 ///
+                /// gzip and zstd files are decompressed while they are parsed
+                /// (see VOTableCompression).
                 /// @param[in] filename the file/path to read the XML input from.
                 /// @return a VOTable.
                 /// @throw AskapError   if the XML document is empty (i.e. no root)
                 ///                     or if the specified file cannot be opened.
                 static VOTable fromXML(const std::string& filename);
 
+                /// Transform an XML VOTable to a VOTable object instance, keeping
+                /// only the columns and rows selected by the filter
+                ///
+                /// @param[in] filename the file/path to read the XML input from.
+                /// @param[in] filter   the columns and rows to keep.
+                /// @return a VOTable.
+                /// @throw AskapError   if the XML document is empty (i.e. no root),
+                ///                     if the specified file cannot be opened or
+                ///                     a selected column is not present in a table.
+                static VOTable fromXML(const std::string& filename, const VOTableFilter& filter);
+
             private:
 
                 /// Transform the VOTable object into an XML VOTable
@@ -115,6 +148,16 @@ namespace askap {
                 /// @throw AskapError   if the XML document is empty (i.e. no root).
                 static VOTable fromXMLImpl(const xercesc::InputSource& source);
 
+                /// Transform an XML VOTable to a VOTable object instance, applying
+                /// the filter while the document is parsed
+                ///
+                /// @throw AskapError   if the XML document is empty (i.e. no root)
+                ///                     or the filter cannot be applied.
+                static VOTable fromXMLImpl(xercesc::InputSource& source, const VOTableFilter& filter);
+
+                /// Build the VOTable from the root element of the document
+                static VOTable fromXmlElement(const xercesc::DOMElement& root);
+
                 /// The text for the DESCRIPTION element
                 std::string itsDescription;
 
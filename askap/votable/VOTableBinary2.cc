@@ -0,0 +1,552 @@
+/// @file VOTableBinary2.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#include "VOTableBinary2.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <stdint.h>
+
+// ASKAPsoft includes
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+#include "boost/algorithm/string/trim.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableColumn.h"
+
+ASKAP_LOGGER(logger, ".VOTableBinary2");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+bool hostIsLittleEndian()
+{
+    const uint16_t one = 1;
+    return *reinterpret_cast<const unsigned char*>(&one) == 1;
+}
+
+const bool littleEndian = hostIsLittleEndian();
+
+/// Append a value in big-endian byte order
+template <typename T>
+void putValue(std::vector<unsigned char>& buf, T value)
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (littleEndian) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+/// Get a value stored in big-endian byte order
+template <typename T>
+T getValue(const unsigned char* data)
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, data, sizeof(T));
+    if (littleEndian) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/// Split a cell into whitespace separated tokens
+void tokenise(const std::string& cell, std::vector<std::string>& tokens)
+{
+    tokens.clear();
+    std::string::size_type start = cell.find_first_not_of(" \t\n\r");
+    while (start != std::string::npos) {
+        const std::string::size_type end = cell.find_first_of(" \t\n\r", start);
+        tokens.push_back(cell.substr(start, end == std::string::npos ? end : end - start));
+        start = cell.find_first_not_of(" \t\n\r", end);
+    }
+}
+
+/// Convert UTF-8 text to UCS-2 (characters outside the BMP are replaced by '?')
+void utf8ToUcs2(const std::string& text, std::vector<uint16_t>& units)
+{
+    units.clear();
+    for (size_t i = 0; i < text.size(); ) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        size_t len = 1;
+        uint32_t code = c;
+        if (c >= 0xF0) {
+            len = 4;
+            code = '?';
+        } else if (c >= 0xE0) {
+            len = 3;
+            code = c & 0x0F;
+        } else if (c >= 0xC0) {
+            len = 2;
+            code = c & 0x1F;
+        }
+        if (len > 1 && len < 4) {
+            for (size_t j = 1; j < len && i + j < text.size(); ++j) {
+                code = (code << 6) | (static_cast<unsigned char>(text[i + j]) & 0x3F);
+            }
+        }
+        units.push_back(static_cast<uint16_t>(code));
+        i += len;
+    }
+}
+
+void appendUtf8(uint16_t unit, std::string& text)
+{
+    if (unit < 0x80) {
+        text += static_cast<char>(unit);
+    } else if (unit < 0x800) {
+        text += static_cast<char>(0xC0 | (unit >> 6));
+        text += static_cast<char>(0x80 | (unit & 0x3F));
+    } else {
+        text += static_cast<char>(0xE0 | (unit >> 12));
+        text += static_cast<char>(0x80 | ((unit >> 6) & 0x3F));
+        text += static_cast<char>(0x80 | (unit & 0x3F));
+    }
+}
+
+int base64Value(char c)
+{
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9') {
+        return c - '0' + 52;
+    }
+    if (c == '+') {
+        return 62;
+    }
+    if (c == '/') {
+        return 63;
+    }
+    return -1;
+}
+
+}
+
+VOTableBinary2::VOTableBinary2(const std::vector<VOTableField>& fields)
+{
+    for (std::vector<VOTableField>::const_iterator it = fields.begin();
+            it != fields.end(); ++it) {
+        Column col;
+        const std::string datatype = it->getDatatype();
+        if (datatype == "boolean") {
+            col.type = BOOLEAN;
+        } else if (datatype == "bit") {
+            col.type = BIT;
+        } else if (datatype == "unsignedByte") {
+            col.type = UNSIGNED_BYTE;
+        } else if (datatype == "short") {
+            col.type = SHORT;
+        } else if (datatype == "int") {
+            col.type = INT;
+        } else if (datatype == "long") {
+            col.type = LONG;
+        } else if (datatype == "char") {
+            col.type = CHAR;
+        } else if (datatype == "unicodeChar") {
+            col.type = UNICODE_CHAR;
+        } else if (datatype == "float") {
+            col.type = FLOAT;
+        } else if (datatype == "double") {
+            col.type = DOUBLE;
+        } else if (datatype == "floatComplex") {
+            col.type = FLOAT_COMPLEX;
+        } else if (datatype == "doubleComplex") {
+            col.type = DOUBLE_COMPLEX;
+        } else {
+            ASKAPTHROW(AskapError, "Datatype '" << datatype << "' of field " << it->getName() <<
+                       " is not supported by the BINARY2 serialisation");
+        }
+
+        // The arraysize is a list of dimensions separated by 'x', the last of which
+        // can be variable ("*" or "n*")
+        std::string arraysize = it->getArraysize();
+        boost::trim(arraysize);
+        col.scalar = arraysize.empty();
+        col.variable = !col.scalar && arraysize[arraysize.size() - 1] == '*';
+        col.count = 1;
+        std::string::size_type start = 0;
+        while (!col.scalar && start < arraysize.size()) {
+            std::string::size_type end = arraysize.find('x', start);
+            if (end == std::string::npos) {
+                end = arraysize.size();
+            }
+            const std::string dim = arraysize.substr(start, end - start);
+            if (!(col.variable && end == arraysize.size())) {
+                char* endPtr = 0;
+                const long n = std::strtol(dim.c_str(), &endPtr, 10);
+                ASKAPCHECK(n > 0 && *endPtr == '\0', "Invalid arraysize '" << arraysize <<
+                           "' of field " << it->getName());
+                col.count *= static_cast<size_t>(n);
+            }
+            start = end + 1;
+        }
+        itsColumns.push_back(col);
+    }
+}
+
+size_t VOTableBinary2::nFields() const
+{
+    return itsColumns.size();
+}
+
+void VOTableBinary2::encodeRow(const std::vector<std::string>& cells,
+                               std::vector<unsigned char>& buf) const
+{
+    ASKAPCHECK(cells.size() == itsColumns.size(), "Row with " << cells.size() <<
+               " cells for a table with " << itsColumns.size() << " fields");
+
+    // Null bitmap, the most significant bit of the first byte is the first field
+    const size_t start = buf.size();
+    buf.resize(start + (itsColumns.size() + 7) / 8, 0);
+    for (size_t i = 0; i < itsColumns.size(); ++i) {
+        if (cells[i].empty()) {
+            buf[start + i / 8] |= static_cast<unsigned char>(0x80 >> (i % 8));
+        }
+        encodeCell(itsColumns[i], cells[i], buf);
+    }
+}
+
+bool VOTableBinary2::decodeRow(const unsigned char* data, size_t size, size_t& pos,
+                               std::vector<std::string>& cells) const
+{
+    const size_t nullBytes = (itsColumns.size() + 7) / 8;
+    if (pos + nullBytes > size) {
+        return false;
+    }
+    size_t p = pos + nullBytes;
+    cells.resize(itsColumns.size());
+    for (size_t i = 0; i < itsColumns.size(); ++i) {
+        const bool isNull = (data[pos + i / 8] & (0x80 >> (i % 8))) != 0;
+        if (!decodeCell(itsColumns[i], data, size, p, isNull, cells[i])) {
+            return false;
+        }
+    }
+    pos = p;
+    return true;
+}
+
+void VOTableBinary2::encodeCell(const Column& col, const std::string& cell,
+                                std::vector<unsigned char>& buf)
+{
+    if (col.type == CHAR) {
+        const size_t n = col.variable ? cell.size() : col.count;
+        if (col.variable) {
+            putValue<int32_t>(buf, static_cast<int32_t>(n));
+        }
+        const size_t nCopy = std::min(n, cell.size());
+        buf.insert(buf.end(), cell.begin(), cell.begin() + nCopy);
+        buf.resize(buf.size() + n - nCopy, 0);
+        return;
+    }
+    if (col.type == UNICODE_CHAR) {
+        std::vector<uint16_t> units;
+        utf8ToUcs2(cell, units);
+        const size_t n = col.variable ? units.size() : col.count;
+        if (col.variable) {
+            putValue<int32_t>(buf, static_cast<int32_t>(n));
+        }
+        for (size_t i = 0; i < n; ++i) {
+            putValue<uint16_t>(buf, i < units.size() ? units[i] : 0);
+        }
+        return;
+    }
+    if (col.type == BIT) {
+        std::vector<bool> bits;
+        for (std::string::const_iterator it = cell.begin(); it != cell.end(); ++it) {
+            if (*it == '0' || *it == '1') {
+                bits.push_back(*it == '1');
+            } else {
+                ASKAPCHECK(std::isspace(static_cast<unsigned char>(*it)), "Invalid bit value " << cell);
+            }
+        }
+        const size_t n = col.variable ? bits.size() : col.count;
+        ASKAPCHECK(bits.size() <= n, "Too many bits in " << cell);
+        if (col.variable) {
+            putValue<int32_t>(buf, static_cast<int32_t>(n));
+        }
+        const size_t start = buf.size();
+        buf.resize(start + (n + 7) / 8, 0);
+        for (size_t i = 0; i < bits.size(); ++i) {
+            if (bits[i]) {
+                buf[start + i / 8] |= static_cast<unsigned char>(0x80 >> (i % 8));
+            }
+        }
+        return;
+    }
+
+    // Numbers and booleans, complex numbers are given as pairs of real numbers
+    std::vector<std::string> tokens;
+    tokenise(cell, tokens);
+    const size_t perElement = (col.type == FLOAT_COMPLEX || col.type == DOUBLE_COMPLEX) ? 2 : 1;
+    ASKAPCHECK(tokens.size() % perElement == 0, "Incomplete complex value " << cell);
+    const size_t nElements = tokens.size() / perElement;
+    const size_t n = col.variable ? nElements : col.count;
+    ASKAPCHECK(nElements <= n, "Too many values in " << cell);
+    if (col.variable) {
+        putValue<int32_t>(buf, static_cast<int32_t>(n));
+    }
+    for (size_t i = 0; i < n * perElement; ++i) {
+        const bool pad = i >= tokens.size();
+        switch (col.type) {
+            case BOOLEAN:
+                buf.push_back(static_cast<unsigned char>(pad ? '?' :
+                              VOTableColumn::parseBoolean(tokens[i])));
+                break;
+            case UNSIGNED_BYTE:
+                buf.push_back(static_cast<unsigned char>(pad ? 0 :
+                              VOTableColumn::parseInteger(tokens[i], 0, 255)));
+                break;
+            case SHORT:
+                putValue<int16_t>(buf, static_cast<int16_t>(pad ? 0 :
+                                  VOTableColumn::parseInteger(tokens[i], std::numeric_limits<int16_t>::min(),
+                                               std::numeric_limits<int16_t>::max())));
+                break;
+            case INT:
+                putValue<int32_t>(buf, static_cast<int32_t>(pad ? 0 :
+                                  VOTableColumn::parseInteger(tokens[i], std::numeric_limits<int32_t>::min(),
+                                               std::numeric_limits<int32_t>::max())));
+                break;
+            case LONG:
+                putValue<int64_t>(buf, pad ? 0 :
+                                  VOTableColumn::parseInteger(tokens[i], std::numeric_limits<int64_t>::min(),
+                                               std::numeric_limits<int64_t>::max()));
+                break;
+            case FLOAT:
+            case FLOAT_COMPLEX:
+                putValue<float>(buf, pad ? std::numeric_limits<float>::quiet_NaN() :
+                                static_cast<float>(VOTableColumn::parseReal(tokens[i])));
+                break;
+            default:
+                putValue<double>(buf, pad ? std::numeric_limits<double>::quiet_NaN() :
+                                 VOTableColumn::parseReal(tokens[i]));
+                break;
+        }
+    }
+}
+
+bool VOTableBinary2::decodeCell(const Column& col, const unsigned char* data, size_t size,
+                                size_t& pos, bool isNull, std::string& cell)
+{
+    size_t p = pos;
+    size_t n = col.count;
+    if (col.variable) {
+        if (p + 4 > size) {
+            return false;
+        }
+        const int32_t count = getValue<int32_t>(data + p);
+        ASKAPCHECK(count >= 0, "Negative array length in BINARY2 stream");
+        n = static_cast<size_t>(count);
+        p += 4;
+    }
+
+    size_t elementSize = 1;
+    switch (col.type) {
+        case SHORT:
+        case UNICODE_CHAR:
+            elementSize = 2;
+            break;
+        case INT:
+        case FLOAT:
+            elementSize = 4;
+            break;
+        case LONG:
+        case DOUBLE:
+        case FLOAT_COMPLEX:
+            elementSize = 8;
+            break;
+        case DOUBLE_COMPLEX:
+            elementSize = 16;
+            break;
+        default:
+            break;
+    }
+    const size_t nBytes = col.type == BIT ? (n + 7) / 8 : n * elementSize;
+    if (p + nBytes > size) {
+        return false;
+    }
+    pos = p + nBytes;
+    cell.clear();
+    if (isNull) {
+        return true;
+    }
+
+    const unsigned char* values = data + p;
+    if (col.type == CHAR) {
+        const unsigned char* end = std::find(values, values + n, 0);
+        cell.assign(reinterpret_cast<const char*>(values), end - values);
+        return true;
+    }
+    if (col.type == UNICODE_CHAR) {
+        for (size_t i = 0; i < n; ++i) {
+            const uint16_t unit = getValue<uint16_t>(values + 2 * i);
+            if (unit == 0) {
+                break;
+            }
+            appendUtf8(unit, cell);
+        }
+        return true;
+    }
+    if (col.type == BIT) {
+        for (size_t i = 0; i < n; ++i) {
+            if (i > 0) {
+                cell += ' ';
+            }
+            cell += (values[i / 8] & (0x80 >> (i % 8))) ? '1' : '0';
+        }
+        return true;
+    }
+    if (col.type == BOOLEAN) {
+        for (size_t i = 0; i < n; ++i) {
+            const char c = static_cast<char>(values[i]);
+            const bool known = c == 'T' || c == 't' || c == '1' || c == 'F' || c == 'f' || c == '0';
+            if (!known && col.scalar) {
+                // a scalar with an unknown value is null
+                break;
+            }
+            if (i > 0) {
+                cell += ' ';
+            }
+            cell += known ? ((c == 'T' || c == 't' || c == '1') ? 'T' : 'F') : '?';
+        }
+        return true;
+    }
+
+    std::ostringstream os;
+    const size_t nValues = (col.type == FLOAT_COMPLEX || col.type == DOUBLE_COMPLEX) ? 2 * n : n;
+    for (size_t i = 0; i < nValues; ++i) {
+        if (i > 0) {
+            os << ' ';
+        }
+        switch (col.type) {
+            case UNSIGNED_BYTE:
+                os << static_cast<unsigned int>(values[i]);
+                break;
+            case SHORT:
+                os << getValue<int16_t>(values + 2 * i);
+                break;
+            case INT:
+                os << getValue<int32_t>(values + 4 * i);
+                break;
+            case LONG:
+                os << getValue<int64_t>(values + 8 * i);
+                break;
+            case FLOAT:
+            case FLOAT_COMPLEX:
+                os << VOTableColumn::formatReal(getValue<float>(values + 4 * i));
+                break;
+            default:
+                os << VOTableColumn::formatReal(getValue<double>(values + 8 * i));
+                break;
+        }
+    }
+    cell = os.str();
+    return true;
+}
+
+size_t VOTableBinary2::encodeBase64(const unsigned char* data, size_t size, bool final,
+                                    std::string& text)
+{
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        const uint32_t triple = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        text += base64Chars[(triple >> 18) & 0x3F];
+        text += base64Chars[(triple >> 12) & 0x3F];
+        text += base64Chars[(triple >> 6) & 0x3F];
+        text += base64Chars[triple & 0x3F];
+    }
+    if (final && i < size) {
+        const bool two = i + 2 == size;
+        const uint32_t triple = (uint32_t(data[i]) << 16) | (two ? (uint32_t(data[i + 1]) << 8) : 0);
+        text += base64Chars[(triple >> 18) & 0x3F];
+        text += base64Chars[(triple >> 12) & 0x3F];
+        text += two ? base64Chars[(triple >> 6) & 0x3F] : '=';
+        text += '=';
+        i = size;
+    }
+    return i;
+}
+
+bool VOTableBinary2::decodeBase64(const char* text, size_t length, std::string& pending,
+                                  std::vector<unsigned char>& data)
+{
+    for (size_t i = 0; i < length; ++i) {
+        const char c = text[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            continue;
+        }
+        if (c != '=' && base64Value(c) < 0) {
+            return false;
+        }
+        pending += c;
+        if (pending.size() == 4) {
+            uint32_t quad = 0;
+            size_t nPad = 0;
+            for (size_t j = 0; j < 4; ++j) {
+                if (pending[j] == '=') {
+                    ++nPad;
+                    quad <<= 6;
+                } else {
+                    quad = (quad << 6) | static_cast<uint32_t>(base64Value(pending[j]));
+                }
+            }
+            if (nPad > 2) {
+                return false;
+            }
+            data.push_back(static_cast<unsigned char>(quad >> 16));
+            if (nPad < 2) {
+                data.push_back(static_cast<unsigned char>((quad >> 8) & 0xFF));
+            }
+            if (nPad < 1) {
+                data.push_back(static_cast<unsigned char>(quad & 0xFF));
+            }
+            pending.clear();
+        }
+    }
+    return true;
+}
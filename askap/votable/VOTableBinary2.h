@@ -0,0 +1,149 @@
+/// @file VOTableBinary2.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEBINARY2_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEBINARY2_H
+
+// System includes
+#include <string>
+#include <vector>
+
+// Local package includes
+#include "askap/votable/VOTableField.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Encoding and decoding of rows in the BINARY2 serialisation
+        ///
+        /// In the BINARY2 serialisation (VOTable 1.3) each row starts with a null
+        /// bitmap, one bit per field with the most significant bit of the first
+        /// byte for the first field, followed by the values of all fields in
+        /// big-endian byte order as described by the datatype and arraysize
+        /// attributes of the FIELD elements. Variable length arrays are preceded
+        /// by their number of elements as a 4-byte integer. The rows are then
+        /// base64-encoded in the STREAM element.
+        ///
+        /// As elsewhere in this package, the cells are exchanged as strings in
+        /// the TABLEDATA representation: array elements are separated by spaces,
+        /// booleans are T or F and an empty cell is a null value.
+        ///
+        /// @ingroup votableaccess
+        class VOTableBinary2 {
+            public:
+
+                /// @brief Constructor
+                ///
+                /// @param[in] fields   the fields of the table
+                /// @throw AskapError   if a datatype or arraysize is not supported.
+                explicit VOTableBinary2(const std::vector<VOTableField>& fields);
+
+                /// Get the number of fields of a row
+                size_t nFields() const;
+
+                /// Append the binary representation of a row to a buffer
+                ///
+                /// @param[in] cells    the cells of the row, one per field
+                /// @param[in,out] buf  the buffer the bytes are appended to
+                /// @throw AskapError   if the number of cells doesn't match the
+                ///                     number of fields or a value can't be converted.
+                void encodeRow(const std::vector<std::string>& cells,
+                               std::vector<unsigned char>& buf) const;
+
+                /// Decode a row from a buffer
+                ///
+                /// @param[in] data     the buffer
+                /// @param[in] size     the number of bytes in the buffer
+                /// @param[in,out] pos  position of the row in the buffer, moved to
+                ///                     the next row if the row is complete
+                /// @param[out] cells   the cells of the row (the vector and the
+                ///                     strings in it are reused)
+                /// @return false if the buffer doesn't hold the complete row, in
+                ///         which case pos is unchanged.
+                bool decodeRow(const unsigned char* data, size_t size, size_t& pos,
+                               std::vector<std::string>& cells) const;
+
+                /// Base64-encode bytes
+                ///
+                /// Only complete groups of three bytes are encoded unless final is
+                /// true, in which case the remaining bytes are encoded with padding.
+                /// @param[in] data     the bytes
+                /// @param[in] size     the number of bytes
+                /// @param[in] final    true if there are no more bytes to encode
+                /// @param[out] text    the encoded characters are appended to it
+                /// @return the number of bytes encoded
+                static size_t encodeBase64(const unsigned char* data, size_t size, bool final,
+                                           std::string& text);
+
+                /// Base64-decode text
+                ///
+                /// The text can be given in pieces of any length, whitespace is
+                /// ignored.
+                /// @param[in] text     the characters
+                /// @param[in] length   the number of characters
+                /// @param[in,out] pending  characters of an incomplete group of four
+                ///                     kept for the next call (initially empty)
+                /// @param[out] data    the decoded bytes are appended to it
+                /// @return false if the text contains invalid characters
+                static bool decodeBase64(const char* text, size_t length, std::string& pending,
+                                         std::vector<unsigned char>& data);
+
+            private:
+
+                /// Primitive types of the BINARY2 serialisation
+                enum Type {
+                    BOOLEAN, BIT, UNSIGNED_BYTE, SHORT, INT, LONG, CHAR, UNICODE_CHAR,
+                    FLOAT, DOUBLE, FLOAT_COMPLEX, DOUBLE_COMPLEX
+                };
+
+                /// Layout of a field in a row
+                struct Column {
+                    Type type;
+                    /// Number of elements of a fixed size field
+                    size_t count;
+                    /// True for variable length arrays
+                    bool variable;
+                    /// True for scalars (no arraysize attribute)
+                    bool scalar;
+                };
+
+                /// Append the binary representation of a cell to a buffer
+                static void encodeCell(const Column& col, const std::string& cell,
+                                       std::vector<unsigned char>& buf);
+
+                /// Decode a cell, returns false if the buffer doesn't hold it completely
+                static bool decodeCell(const Column& col, const unsigned char* data, size_t size,
+                                       size_t& pos, bool isNull, std::string& cell);
+
+                /// Layout of all fields
+                std::vector<Column> itsColumns;
+        };
+
+    }
+}
+
+#endif
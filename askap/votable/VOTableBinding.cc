@@ -0,0 +1,206 @@
+/// @file VOTableBinding.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include "VOTableBinding.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <stdint.h>
+
+// ASKAPsoft includes
+#include "askap/AskapError.h"
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// Check whether only white space is left in a string
+bool isBlank(const char* str)
+{
+    while (*str == ' ' || *str == '\t' || *str == '\n' || *str == '\r') {
+        ++str;
+    }
+    return *str == '\0';
+}
+
+/// Convert the text of a decimal or hexadecimal (0x prefix) integer
+///
+/// @param[in] text     the text
+/// @param[in] minValue the smallest valid value
+/// @param[in] maxValue the largest valid value
+/// @return the value, zero for an empty cell
+int64_t parseInteger(const std::string& text, int64_t minValue, int64_t maxValue)
+{
+    const char* str = text.c_str();
+    while (*str == ' ' || *str == '\t' || *str == '\n' || *str == '\r') {
+        ++str;
+    }
+    if (*str == '\0') {
+        return 0;
+    }
+    const bool hex = str[0] == '0' && (str[1] == 'x' || str[1] == 'X');
+    char* end = 0;
+    const long long value = std::strtoll(hex ? str + 2 : str, &end, hex ? 16 : 10);
+    ASKAPCHECK(end != str && isBlank(end), "Invalid integer value " << text);
+    ASKAPCHECK(value >= minValue && value <= maxValue, "Integer value " << text << " out of range");
+    return value;
+}
+
+/// Format a floating point number with the shortest text preserving its value
+///
+/// @param[in] value    the value
+/// @param[in] digits   the number of digits which is usually enough
+/// @param[out] text    the text
+template <typename T>
+void formatReal(T value, int digits, std::string& text)
+{
+    if (std::isnan(value)) {
+        text = "NaN";
+        return;
+    }
+    if (std::isinf(value)) {
+        text = value > 0 ? "+Inf" : "-Inf";
+        return;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.*g", digits, static_cast<double>(value));
+    if (static_cast<T>(std::strtod(buffer, 0)) != value) {
+        // enough digits to round-trip (max_digits10 of C++11)
+        std::snprintf(buffer, sizeof(buffer), "%.*g", digits + 3, static_cast<double>(value));
+    }
+    text = buffer;
+}
+
+}
+
+void VOTableCell::parse(const std::string& text, bool& value)
+{
+    const char* str = text.c_str();
+    while (*str == ' ' || *str == '\t' || *str == '\n' || *str == '\r') {
+        ++str;
+    }
+    switch (*str) {
+        case 'T':
+        case 't':
+        case '1':
+            value = true;
+            break;
+        case 'F':
+        case 'f':
+        case '0':
+        case '?':
+        case '\0':
+            value = false;
+            break;
+        default:
+            ASKAPTHROW(AskapError, "Invalid boolean value " << text);
+    }
+}
+
+void VOTableCell::parse(const std::string& text, int32_t& value)
+{
+    value = static_cast<int32_t>(parseInteger(text, std::numeric_limits<int32_t>::min(),
+                                 std::numeric_limits<int32_t>::max()));
+}
+
+void VOTableCell::parse(const std::string& text, int64_t& value)
+{
+    value = parseInteger(text, std::numeric_limits<int64_t>::min(),
+                         std::numeric_limits<int64_t>::max());
+}
+
+void VOTableCell::parse(const std::string& text, float& value)
+{
+    const char* str = text.c_str();
+    char* end = 0;
+    value = std::strtof(str, &end);
+    if (end == str) {
+        ASKAPCHECK(isBlank(str), "Invalid floating point value " << text);
+        value = std::numeric_limits<float>::quiet_NaN();
+        return;
+    }
+    ASKAPCHECK(isBlank(end), "Invalid floating point value " << text);
+}
+
+void VOTableCell::parse(const std::string& text, double& value)
+{
+    const char* str = text.c_str();
+    char* end = 0;
+    value = std::strtod(str, &end);
+    if (end == str) {
+        ASKAPCHECK(isBlank(str), "Invalid floating point value " << text);
+        value = std::numeric_limits<double>::quiet_NaN();
+        return;
+    }
+    ASKAPCHECK(isBlank(end), "Invalid floating point value " << text);
+}
+
+void VOTableCell::parse(const std::string& text, std::string& value)
+{
+    value = text;
+}
+
+void VOTableCell::format(bool value, std::string& text)
+{
+    text = value ? "T" : "F";
+}
+
+void VOTableCell::format(int32_t value, std::string& text)
+{
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%d", value);
+    text = buffer;
+}
+
+void VOTableCell::format(int64_t value, std::string& text)
+{
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+    text = buffer;
+}
+
+void VOTableCell::format(float value, std::string& text)
+{
+    formatReal(value, std::numeric_limits<float>::digits10, text);
+}
+
+void VOTableCell::format(double value, std::string& text)
+{
+    formatReal(value, std::numeric_limits<double>::digits10, text);
+}
+
+void VOTableCell::format(const std::string& value, std::string& text)
+{
+    text = value;
+}
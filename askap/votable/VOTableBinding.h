@@ -0,0 +1,252 @@
+/// @file VOTableBinding.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEBINDING_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEBINDING_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// ASKAPsoft includes
+#include "boost/shared_ptr.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableField.h"
+#include "askap/votable/VOTableReader.h"
+#include "askap/votable/VOTableTable.h"
+#include "askap/votable/VOTableWriter.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Conversion of single cells between TABLEDATA text and values
+        ///
+        /// Numbers are converted in place with strtod/strtoll and snprintf, the
+        /// output strings are reused, so no temporary strings are made. Empty
+        /// cells (nulls) give NaN for floating point values, zero for integers
+        /// and false for booleans. Floating point values are written with the
+        /// shortest text preserving their value (as VOTableColumn::formatReal).
+        ///
+        /// @ingroup votableaccess
+        class VOTableCell {
+            public:
+                /// Convert the text of a cell
+                /// @throw AskapError   if the text is not a valid value of the type.
+                /// @{
+                static void parse(const std::string& text, bool& value);
+                static void parse(const std::string& text, int32_t& value);
+                static void parse(const std::string& text, int64_t& value);
+                static void parse(const std::string& text, float& value);
+                static void parse(const std::string& text, double& value);
+                static void parse(const std::string& text, std::string& value);
+                /// @}
+
+                /// Format a value as the text of a cell (the string is reused)
+                /// @{
+                static void format(bool value, std::string& text);
+                static void format(int32_t value, std::string& text);
+                static void format(int64_t value, std::string& text);
+                static void format(float value, std::string& text);
+                static void format(double value, std::string& text);
+                static void format(const std::string& value, std::string& text);
+                /// @}
+        };
+
+        /// @brief VOTable datatype of a C++ type
+        ///
+        /// Specialisations exist for bool, int32_t, int64_t, float, double and
+        /// std::string (the types of VOTableColumn).
+        /// @ingroup votableaccess
+        template <typename T>
+        struct VOTableDatatype;
+
+        template <>
+        struct VOTableDatatype<bool> {
+            static const char* datatype() { return "boolean"; }
+            static const char* arraysize() { return ""; }
+        };
+
+        template <>
+        struct VOTableDatatype<int32_t> {
+            static const char* datatype() { return "int"; }
+            static const char* arraysize() { return ""; }
+        };
+
+        template <>
+        struct VOTableDatatype<int64_t> {
+            static const char* datatype() { return "long"; }
+            static const char* arraysize() { return ""; }
+        };
+
+        template <>
+        struct VOTableDatatype<float> {
+            static const char* datatype() { return "float"; }
+            static const char* arraysize() { return ""; }
+        };
+
+        template <>
+        struct VOTableDatatype<double> {
+            static const char* datatype() { return "double"; }
+            static const char* arraysize() { return ""; }
+        };
+
+        template <>
+        struct VOTableDatatype<std::string> {
+            static const char* datatype() { return "char"; }
+            static const char* arraysize() { return "*"; }
+        };
+
+        /// @brief Binding of the columns of a table to the members of a struct
+        ///
+        /// The members of the struct and the FIELD elements they correspond to are
+        /// declared once, the datatype of each field follows from the type of its
+        /// member (see VOTableDatatype). The binding then converts rows read by
+        /// VOTableReader into structs and writes structs with VOTableWriter, the
+        /// cells of each member being converted by code specific to its type
+        /// (see VOTableCell) instead of going through a stream or lexical_cast.
+        /// The cell buffers of the reader and writer are reused for all rows.
+        /// @code
+        ///    struct Source { std::string name; double ra; double dec; float flux; };
+        ///
+        ///    VOTableBinding<Source> binding;
+        ///    binding.bind("Name", &Source::name)
+        ///           .bind("RA", &Source::ra, "deg", "pos.eq.ra;meta.main")
+        ///           .bind("Dec", &Source::dec, "deg", "pos.eq.dec;meta.main")
+        ///           .bind("Flux", &Source::flux, "mJy");
+        ///
+        ///    VOTableReader reader("catalogue.xml");
+        ///    std::vector<Source> sources;
+        ///    binding.read(reader, sources);
+        ///
+        ///    VOTableWriter writer("selection.xml");
+        ///    writer.beginTable(binding.table("selection"));
+        ///    binding.write(writer, sources);
+        /// @endcode
+        /// For a struct of arrays, read into VOTableColumns instead.
+        ///
+        /// @ingroup votableaccess
+        template <typename S>
+        class VOTableBinding {
+            public:
+                /// Bind a member to a column
+                ///
+                /// @param[in] name     name of the FIELD
+                /// @param[in] member   pointer to the member
+                /// @param[in] unit     unit of the FIELD (written only)
+                /// @param[in] ucd      UCD of the FIELD (written only)
+                /// @return this binding, so calls can be chained
+                template <typename T>
+                VOTableBinding& bind(const std::string& name, T S::*member,
+                                     const std::string& unit = "", const std::string& ucd = "");
+
+                /// Number of bound members
+                size_t size() const;
+
+                /// Names of the bound columns in the order of binding
+                const std::vector<std::string>& names() const;
+
+                /// FIELD elements of the bound columns in the order of binding
+                const std::vector<VOTableField>& fields() const;
+
+                /// Header of a table with the bound columns
+                ///
+                /// @param[in] name             name of the table
+                /// @param[in] serialisation    serialisation of the data
+                VOTableTable table(const std::string& name,
+                                   VOTableTable::Serialisation serialisation = VOTableTable::TABLEDATA) const;
+
+                /// Convert the cells of a row
+                ///
+                /// @param[in] cells    the cells in the order of binding
+                /// @param[out] value   the struct to fill
+                /// @throw AskapError   if the number of cells is wrong or a cell can't
+                ///                     be converted.
+                void fromCells(const std::vector<std::string>& cells, S& value) const;
+
+                /// Format a struct as the cells of a row
+                ///
+                /// @param[in] value    the struct
+                /// @param[out] cells   the cells in the order of binding (the vector
+                ///                     and the strings in it are reused)
+                void toCells(const S& value, std::vector<std::string>& cells) const;
+
+                /// Read all remaining rows
+                ///
+                /// The bound columns are selected in the reader (see
+                /// VOTableReader::selectColumns), other columns are skipped.
+                /// @param[in] reader   the reader
+                /// @param[out] values  the rows are appended to this vector
+                /// @return the number of rows read
+                /// @throw AskapError   if a bound column doesn't exist or a cell can't
+                ///                     be converted.
+                size_t read(VOTableReader& reader, std::vector<S>& values) const;
+
+                /// Write rows to the current table of a writer
+                ///
+                /// @param[in] writer   the writer, its table should have the bound fields
+                ///                     (see table)
+                /// @param[in] values   the rows
+                void write(VOTableWriter& writer, const std::vector<S>& values) const;
+
+            private:
+                /// Conversion of one member, defined for each member type
+                struct Member {
+                    virtual ~Member() {}
+                    virtual void parse(const std::string& text, S& value) const = 0;
+                    virtual void format(const S& value, std::string& text) const = 0;
+                };
+
+                /// Conversion of a member of the given type
+                template <typename T>
+                struct TypedMember : public Member {
+                    explicit TypedMember(T S::*member) : itsMember(member) {}
+                    virtual void parse(const std::string& text, S& value) const {
+                        VOTableCell::parse(text, value.*itsMember);
+                    }
+                    virtual void format(const S& value, std::string& text) const {
+                        VOTableCell::format(value.*itsMember, text);
+                    }
+                    T S::*itsMember;
+                };
+
+                /// Conversions of the bound members
+                std::vector<boost::shared_ptr<Member> > itsMembers;
+
+                /// Names of the bound columns
+                std::vector<std::string> itsNames;
+
+                /// FIELD elements of the bound columns
+                std::vector<VOTableField> itsFields;
+        };
+
+    }
+}
+
+#include "askap/votable/VOTableBinding.tcc"
+
+#endif
@@ -0,0 +1,136 @@
+/// @file VOTableBinding.tcc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEBINDING_TCC
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEBINDING_TCC
+
+// ASKAPsoft includes
+#include "askap/AskapError.h"
+
+namespace askap {
+    namespace accessors {
+
+        template <typename S>
+        template <typename T>
+        VOTableBinding<S>& VOTableBinding<S>::bind(const std::string& name, T S::*member,
+                const std::string& unit, const std::string& ucd)
+        {
+            ASKAPCHECK(member, "A null member is bound to the column " << name);
+            for (std::vector<std::string>::const_iterator it = itsNames.begin();
+                    it != itsNames.end(); ++it) {
+                ASKAPCHECK(*it != name, "Column " << name << " is bound twice");
+            }
+            VOTableField field;
+            field.setName(name);
+            field.setDatatype(VOTableDatatype<T>::datatype());
+            field.setArraysize(VOTableDatatype<T>::arraysize());
+            field.setUnit(unit);
+            field.setUCD(ucd);
+            itsMembers.push_back(boost::shared_ptr<Member>(new TypedMember<T>(member)));
+            itsNames.push_back(name);
+            itsFields.push_back(field);
+            return *this;
+        }
+
+        template <typename S>
+        size_t VOTableBinding<S>::size() const
+        {
+            return itsMembers.size();
+        }
+
+        template <typename S>
+        const std::vector<std::string>& VOTableBinding<S>::names() const
+        {
+            return itsNames;
+        }
+
+        template <typename S>
+        const std::vector<VOTableField>& VOTableBinding<S>::fields() const
+        {
+            return itsFields;
+        }
+
+        template <typename S>
+        VOTableTable VOTableBinding<S>::table(const std::string& name,
+                VOTableTable::Serialisation serialisation) const
+        {
+            VOTableTable table;
+            table.setName(name);
+            table.setSerialisation(serialisation);
+            for (std::vector<VOTableField>::const_iterator it = itsFields.begin();
+                    it != itsFields.end(); ++it) {
+                table.addField(*it);
+            }
+            return table;
+        }
+
+        template <typename S>
+        void VOTableBinding<S>::fromCells(const std::vector<std::string>& cells, S& value) const
+        {
+            ASKAPCHECK(cells.size() == itsMembers.size(), "Row has " << cells.size() <<
+                       " cells, " << itsMembers.size() << " columns are bound");
+            for (size_t i = 0; i < itsMembers.size(); ++i) {
+                itsMembers[i]->parse(cells[i], value);
+            }
+        }
+
+        template <typename S>
+        void VOTableBinding<S>::toCells(const S& value, std::vector<std::string>& cells) const
+        {
+            cells.resize(itsMembers.size());
+            for (size_t i = 0; i < itsMembers.size(); ++i) {
+                itsMembers[i]->format(value, cells[i]);
+            }
+        }
+
+        template <typename S>
+        size_t VOTableBinding<S>::read(VOTableReader& reader, std::vector<S>& values) const
+        {
+            reader.selectColumns(itsNames);
+            std::vector<std::string> cells;
+            size_t nRows = 0;
+            while (reader.next(cells)) {
+                values.push_back(S());
+                fromCells(cells, values.back());
+                ++nRows;
+            }
+            return nRows;
+        }
+
+        template <typename S>
+        void VOTableBinding<S>::write(VOTableWriter& writer, const std::vector<S>& values) const
+        {
+            std::vector<std::string> cells;
+            for (typename std::vector<S>::const_iterator it = values.begin(); it != values.end(); ++it) {
+                toCells(*it, cells);
+                writer.addRow(cells);
+            }
+        }
+
+    }
+}
+
+#endif
@@ -0,0 +1,382 @@
+/// @file VOTableColumn.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#include "VOTableColumn.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <sstream>
+#include <limits>
+#include <cstdlib>
+#include <cmath>
+
+// ASKAPsoft includes
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+#include "boost/algorithm/string/trim.hpp"
+
+ASKAP_LOGGER(logger, ".VOTableColumn");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+template <typename T>
+std::string formatRealImpl(T value)
+{
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    std::ostringstream os;
+    os.precision(std::numeric_limits<T>::digits10);
+    os << value;
+    if (static_cast<T>(std::strtod(os.str().c_str(), 0)) != value) {
+        os.str("");
+        // enough digits to round-trip (max_digits10 of C++11)
+        os.precision(std::numeric_limits<T>::digits10 + 3);
+        os << value;
+    }
+    return os.str();
+}
+
+}
+
+VOTableColumn::VOTableColumn(const VOTableField& field)
+    : itsField(field), itsType(STRING)
+{
+    std::string arraysize = field.getArraysize();
+    boost::trim(arraysize);
+    if (arraysize.empty()) {
+        const std::string& datatype = field.getDatatype();
+        if (datatype == "double") {
+            itsType = DOUBLE;
+        } else if (datatype == "float") {
+            itsType = FLOAT;
+        } else if (datatype == "int" || datatype == "short" || datatype == "unsignedByte") {
+            itsType = INT;
+        } else if (datatype == "long") {
+            itsType = LONG;
+        } else if (datatype == "boolean") {
+            itsType = BOOLEAN;
+        }
+    }
+}
+
+const VOTableField& VOTableColumn::getField() const
+{
+    return itsField;
+}
+
+VOTableColumn::Type VOTableColumn::getType() const
+{
+    return itsType;
+}
+
+size_t VOTableColumn::size() const
+{
+    return itsNull.size();
+}
+
+void VOTableColumn::reserve(size_t n)
+{
+    itsNull.reserve(n);
+    switch (itsType) {
+        case BOOLEAN: itsBools.reserve(n); break;
+        case INT: itsInts.reserve(n); break;
+        case LONG: itsLongs.reserve(n); break;
+        case FLOAT: itsFloats.reserve(n); break;
+        case DOUBLE: itsDoubles.reserve(n); break;
+        default: itsStrings.reserve(n); break;
+    }
+}
+
+void VOTableColumn::append(const VOTableColumn& other)
+{
+    checkType(other.itsType);
+    itsNull.insert(itsNull.end(), other.itsNull.begin(), other.itsNull.end());
+    switch (itsType) {
+        case BOOLEAN:
+            itsBools.insert(itsBools.end(), other.itsBools.begin(), other.itsBools.end());
+            break;
+        case INT:
+            itsInts.insert(itsInts.end(), other.itsInts.begin(), other.itsInts.end());
+            break;
+        case LONG:
+            itsLongs.insert(itsLongs.end(), other.itsLongs.begin(), other.itsLongs.end());
+            break;
+        case FLOAT:
+            itsFloats.insert(itsFloats.end(), other.itsFloats.begin(), other.itsFloats.end());
+            break;
+        case DOUBLE:
+            itsDoubles.insert(itsDoubles.end(), other.itsDoubles.begin(), other.itsDoubles.end());
+            break;
+        default:
+            itsStrings.insert(itsStrings.end(), other.itsStrings.begin(), other.itsStrings.end());
+            break;
+    }
+}
+
+void VOTableColumn::truncate(size_t n)
+{
+    if (n >= size()) {
+        return;
+    }
+    itsNull.resize(n);
+    switch (itsType) {
+        case BOOLEAN: itsBools.resize(n); break;
+        case INT: itsInts.resize(n); break;
+        case LONG: itsLongs.resize(n); break;
+        case FLOAT: itsFloats.resize(n); break;
+        case DOUBLE: itsDoubles.resize(n); break;
+        default: itsStrings.resize(n); break;
+    }
+}
+
+void VOTableColumn::addCell(const std::string& cell)
+{
+    if (itsType == STRING) {
+        addString(cell);
+        return;
+    }
+    std::string text = cell;
+    boost::trim(text);
+    if (text.empty()) {
+        addNull();
+        return;
+    }
+    switch (itsType) {
+        case BOOLEAN: {
+            const char value = parseBoolean(text);
+            if (value == '?') {
+                addNull();
+            } else {
+                addBool(value == 'T');
+            }
+            break;
+        }
+        case INT:
+            addInt(static_cast<int32_t>(parseInteger(text, std::numeric_limits<int32_t>::min(),
+                                        std::numeric_limits<int32_t>::max())));
+            break;
+        case LONG:
+            addLong(parseInteger(text, std::numeric_limits<int64_t>::min(),
+                                 std::numeric_limits<int64_t>::max()));
+            break;
+        case FLOAT:
+            addFloat(static_cast<float>(parseReal(text)));
+            break;
+        default:
+            addDouble(parseReal(text));
+            break;
+    }
+}
+
+void VOTableColumn::addNull()
+{
+    switch (itsType) {
+        case BOOLEAN: itsBools.push_back(false); break;
+        case INT: itsInts.push_back(0); break;
+        case LONG: itsLongs.push_back(0); break;
+        case FLOAT: itsFloats.push_back(std::numeric_limits<float>::quiet_NaN()); break;
+        case DOUBLE: itsDoubles.push_back(std::numeric_limits<double>::quiet_NaN()); break;
+        default: itsStrings.push_back(std::string()); break;
+    }
+    itsNull.push_back(true);
+}
+
+void VOTableColumn::addBool(bool value)
+{
+    checkType(BOOLEAN);
+    itsBools.push_back(value);
+    itsNull.push_back(false);
+}
+
+void VOTableColumn::addInt(int32_t value)
+{
+    checkType(INT);
+    itsInts.push_back(value);
+    itsNull.push_back(false);
+}
+
+void VOTableColumn::addLong(int64_t value)
+{
+    checkType(LONG);
+    itsLongs.push_back(value);
+    itsNull.push_back(false);
+}
+
+void VOTableColumn::addFloat(float value)
+{
+    checkType(FLOAT);
+    itsFloats.push_back(value);
+    itsNull.push_back(std::isnan(value));
+}
+
+void VOTableColumn::addDouble(double value)
+{
+    checkType(DOUBLE);
+    itsDoubles.push_back(value);
+    itsNull.push_back(std::isnan(value));
+}
+
+void VOTableColumn::addString(const std::string& value)
+{
+    checkType(STRING);
+    itsStrings.push_back(value);
+    itsNull.push_back(value.empty());
+}
+
+std::string VOTableColumn::getCell(size_t row) const
+{
+    ASKAPCHECK(row < size(), "Row " << row << " is out of range for column " <<
+               itsField.getName() << " of " << size() << " rows");
+    if (itsNull[row]) {
+        return std::string();
+    }
+    switch (itsType) {
+        case BOOLEAN:
+            return itsBools[row] ? "T" : "F";
+        case INT: {
+            std::ostringstream os;
+            os << itsInts[row];
+            return os.str();
+        }
+        case LONG: {
+            std::ostringstream os;
+            os << itsLongs[row];
+            return os.str();
+        }
+        case FLOAT:
+            return formatReal(itsFloats[row]);
+        case DOUBLE:
+            return formatReal(itsDoubles[row]);
+        default:
+            return itsStrings[row];
+    }
+}
+
+bool VOTableColumn::isNull(size_t row) const
+{
+    return itsNull[row];
+}
+
+const std::vector<bool>& VOTableColumn::getBoolValues() const
+{
+    checkType(BOOLEAN);
+    return itsBools;
+}
+
+const std::vector<int32_t>& VOTableColumn::getIntValues() const
+{
+    checkType(INT);
+    return itsInts;
+}
+
+const std::vector<int64_t>& VOTableColumn::getLongValues() const
+{
+    checkType(LONG);
+    return itsLongs;
+}
+
+const std::vector<float>& VOTableColumn::getFloatValues() const
+{
+    checkType(FLOAT);
+    return itsFloats;
+}
+
+const std::vector<double>& VOTableColumn::getDoubleValues() const
+{
+    checkType(DOUBLE);
+    return itsDoubles;
+}
+
+const std::vector<std::string>& VOTableColumn::getStringValues() const
+{
+    checkType(STRING);
+    return itsStrings;
+}
+
+const std::vector<bool>& VOTableColumn::getNullMask() const
+{
+    return itsNull;
+}
+
+void VOTableColumn::checkType(Type type) const
+{
+    ASKAPCHECK(itsType == type, "Column " << itsField.getName() << " with datatype '" <<
+               itsField.getDatatype() << "' and arraysize '" << itsField.getArraysize() <<
+               "' doesn't hold values of the requested type");
+}
+
+double VOTableColumn::parseReal(const std::string& text)
+{
+    const char* str = text.c_str();
+    char* end = 0;
+    const double value = std::strtod(str, &end);
+    ASKAPCHECK(end != str && *end == '\0', "Invalid floating point value " << text);
+    return value;
+}
+
+int64_t VOTableColumn::parseInteger(const std::string& text, int64_t minValue, int64_t maxValue)
+{
+    const bool hex = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+    const char* str = hex ? text.c_str() + 2 : text.c_str();
+    char* end = 0;
+    const long long value = std::strtoll(str, &end, hex ? 16 : 10);
+    ASKAPCHECK(end != str && *end == '\0', "Invalid integer value " << text);
+    ASKAPCHECK(value >= minValue && value <= maxValue, "Integer value " << text << " out of range");
+    return value;
+}
+
+char VOTableColumn::parseBoolean(const std::string& text)
+{
+    if (text == "T" || text == "t" || text == "true" || text == "1") {
+        return 'T';
+    }
+    if (text == "F" || text == "f" || text == "false" || text == "0") {
+        return 'F';
+    }
+    return '?';
+}
+
+std::string VOTableColumn::formatReal(double value)
+{
+    return formatRealImpl(value);
+}
+
+std::string VOTableColumn::formatReal(float value)
+{
+    return formatRealImpl(value);
+}
@@ -0,0 +1,158 @@
+/// @file VOTableColumn.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLECOLUMN_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLECOLUMN_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// Local package includes
+#include "askap/votable/VOTableField.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Values of one column of a table stored with their native type
+        ///
+        /// The type of the values is derived from the datatype of the FIELD element:
+        /// double, float, int (also short and unsignedByte), long and boolean scalars
+        /// are stored in a vector of the corresponding C++ type, everything else
+        /// (text, arrays, complex numbers) is stored as the TABLEDATA text. Null values
+        /// are recorded in a separate mask, the value stored for them is NaN for
+        /// floating point columns and zero, false or an empty string otherwise.
+        ///
+        /// The values are accessed by const reference to the underlying vector, so
+        /// filtering or matching on a column walks contiguous memory without copies.
+        ///
+        /// @ingroup votableaccess
+        class VOTableColumn {
+            public:
+
+                /// Type of the stored values
+                enum Type { BOOLEAN, INT, LONG, FLOAT, DOUBLE, STRING };
+
+                /// @brief Constructor
+                ///
+                /// @param[in] field    the FIELD element describing the column
+                explicit VOTableColumn(const VOTableField& field);
+
+                const VOTableField& getField() const;
+
+                Type getType() const;
+
+                /// Get the number of values
+                size_t size() const;
+
+                /// Reserve memory for a number of values
+                void reserve(size_t n);
+
+                /// Append all values of another column of the same type
+                /// @throw AskapError   if the column has a different type.
+                void append(const VOTableColumn& other);
+
+                /// Remove the values after the first n ones
+                void truncate(size_t n);
+
+                /// Append a value given as TABLEDATA text (empty for null)
+                ///
+                /// @throw AskapError   if the text can't be converted to the column type.
+                void addCell(const std::string& cell);
+
+                /// Append a null value
+                void addNull();
+
+                /// Append a value of the column type
+                /// @throw AskapError   if the column has a different type.
+                /// @{
+                void addBool(bool value);
+                void addInt(int32_t value);
+                void addLong(int64_t value);
+                void addFloat(float value);
+                void addDouble(double value);
+                void addString(const std::string& value);
+                /// @}
+
+                /// Get a value as TABLEDATA text (empty for null)
+                std::string getCell(size_t row) const;
+
+                bool isNull(size_t row) const;
+
+                /// Get all values, one per row
+                /// @throw AskapError   if the column has a different type.
+                /// @{
+                const std::vector<bool>& getBoolValues() const;
+                const std::vector<int32_t>& getIntValues() const;
+                const std::vector<int64_t>& getLongValues() const;
+                const std::vector<float>& getFloatValues() const;
+                const std::vector<double>& getDoubleValues() const;
+                const std::vector<std::string>& getStringValues() const;
+                /// @}
+
+                /// Get the null mask, true for null values
+                const std::vector<bool>& getNullMask() const;
+
+                /// Convert the text of a floating point number
+                /// @throw AskapError   if the text is not a number.
+                static double parseReal(const std::string& text);
+
+                /// Convert the text of a decimal or hexadecimal (0x prefix) integer
+                /// @throw AskapError   if the text is not an integer in the given range.
+                static int64_t parseInteger(const std::string& text, int64_t minValue, int64_t maxValue);
+
+                /// Convert the text of a boolean
+                /// @return 'T', 'F' or '?' if the text is not a known boolean value
+                static char parseBoolean(const std::string& text);
+
+                /// Format a floating point number with the shortest text preserving its value
+                /// @{
+                static std::string formatReal(double value);
+                static std::string formatReal(float value);
+                /// @}
+
+            private:
+
+                /// Check the column type before accessing the values
+                void checkType(Type type) const;
+
+                VOTableField itsField;
+                Type itsType;
+                std::vector<bool> itsNull;
+                std::vector<bool> itsBools;
+                std::vector<int32_t> itsInts;
+                std::vector<int64_t> itsLongs;
+                std::vector<float> itsFloats;
+                std::vector<double> itsDoubles;
+                std::vector<std::string> itsStrings;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,179 @@
+/// @file VOTableColumns.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#include "VOTableColumns.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+
+// ASKAPsoft includes
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+
+ASKAP_LOGGER(logger, ".VOTableColumns");
+
+using namespace askap;
+using namespace askap::accessors;
+
+VOTableColumns::VOTableColumns(const std::vector<VOTableField>& fields)
+{
+    itsColumns.reserve(fields.size());
+    for (std::vector<VOTableField>::const_iterator it = fields.begin();
+            it != fields.end(); ++it) {
+        itsColumns.push_back(VOTableColumn(*it));
+    }
+}
+
+VOTableColumns::VOTableColumns(const VOTableTable& table)
+{
+    const std::vector<VOTableField>& fields = table.getFields();
+    itsColumns.reserve(fields.size());
+    for (std::vector<VOTableField>::const_iterator it = fields.begin();
+            it != fields.end(); ++it) {
+        itsColumns.push_back(VOTableColumn(*it));
+    }
+
+    const std::vector<VOTableRow>& rows = table.getRows();
+    reserve(rows.size());
+    for (std::vector<VOTableRow>::const_iterator it = rows.begin();
+            it != rows.end(); ++it) {
+        addRow(*it);
+    }
+}
+
+size_t VOTableColumns::nColumns() const
+{
+    return itsColumns.size();
+}
+
+size_t VOTableColumns::nRows() const
+{
+    return itsColumns.empty() ? 0 : itsColumns[0].size();
+}
+
+void VOTableColumns::reserve(size_t nRows)
+{
+    for (std::vector<VOTableColumn>::iterator it = itsColumns.begin();
+            it != itsColumns.end(); ++it) {
+        it->reserve(nRows);
+    }
+}
+
+const VOTableColumn& VOTableColumns::getColumn(size_t column) const
+{
+    ASKAPCHECK(column < itsColumns.size(), "Column " << column << " is out of range");
+    return itsColumns[column];
+}
+
+VOTableColumn& VOTableColumns::getColumn(size_t column)
+{
+    ASKAPCHECK(column < itsColumns.size(), "Column " << column << " is out of range");
+    return itsColumns[column];
+}
+
+const VOTableColumn& VOTableColumns::getColumn(const std::string& name) const
+{
+    return itsColumns[columnIndex(name)];
+}
+
+size_t VOTableColumns::columnIndex(const std::string& name) const
+{
+    for (size_t i = 0; i < itsColumns.size(); ++i) {
+        const VOTableField& field = itsColumns[i].getField();
+        const std::string& fieldName = field.getName().size() ? field.getName() : field.getID();
+        if (fieldName == name) {
+            return i;
+        }
+    }
+    ASKAPTHROW(AskapError, "Column " << name << " is not present in the table");
+}
+
+void VOTableColumns::addRow(const std::vector<std::string>& cells)
+{
+    ASKAPCHECK(cells.size() == itsColumns.size(), "Row with " << cells.size() <<
+               " cells added to a table with " << itsColumns.size() << " columns");
+    const size_t n = nRows();
+    try {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            itsColumns[i].addCell(cells[i]);
+        }
+    } catch (const AskapError&) {
+        // keep all columns the same length
+        for (std::vector<VOTableColumn>::iterator it = itsColumns.begin();
+                it != itsColumns.end(); ++it) {
+            it->truncate(n);
+        }
+        throw;
+    }
+}
+
+void VOTableColumns::addRow(const VOTableRow& row)
+{
+    addRow(row.getCells());
+}
+
+void VOTableColumns::getRow(size_t row, std::vector<std::string>& cells) const
+{
+    cells.resize(itsColumns.size());
+    for (size_t i = 0; i < itsColumns.size(); ++i) {
+        cells[i] = itsColumns[i].getCell(row);
+    }
+}
+
+VOTableRow VOTableColumns::getRow(size_t row) const
+{
+    VOTableRow r;
+    for (std::vector<VOTableColumn>::const_iterator it = itsColumns.begin();
+            it != itsColumns.end(); ++it) {
+        r.addCell(it->getCell(row));
+    }
+    return r;
+}
+
+void VOTableColumns::append(const VOTableColumns& other)
+{
+    ASKAPCHECK(other.itsColumns.size() == itsColumns.size(), "Table with " <<
+               other.itsColumns.size() << " columns appended to a table with " <<
+               itsColumns.size() << " columns");
+    for (size_t i = 0; i < itsColumns.size(); ++i) {
+        itsColumns[i].append(other.itsColumns[i]);
+    }
+}
+
+void VOTableColumns::addRowsTo(VOTableTable& table) const
+{
+    ASKAPCHECK(table.getFields().size() == itsColumns.size(), "Table with " <<
+               table.getFields().size() << " fields for " << itsColumns.size() << " columns");
+    const size_t n = nRows();
+    for (size_t row = 0; row < n; ++row) {
+        table.addRow(getRow(row));
+    }
+}
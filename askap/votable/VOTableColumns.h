@@ -0,0 +1,119 @@
+/// @file VOTableColumns.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLECOLUMNS_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLECOLUMNS_H
+
+// System includes
+#include <string>
+#include <vector>
+
+// Local package includes
+#include "askap/votable/VOTableColumn.h"
+#include "askap/votable/VOTableField.h"
+#include "askap/votable/VOTableRow.h"
+#include "askap/votable/VOTableTable.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Columnar representation of the data of a table
+        ///
+        /// Each column stores its values with the type given by the datatype of
+        /// its field (see VOTableColumn), instead of one string per cell as in
+        /// VOTableTable. The row API with strings is kept as a view: rows are
+        /// converted when they are added or requested.
+        /// @code
+        ///    VOTableColumns cols(table);
+        ///    const std::vector<double>& ra = cols.getColumn("RA").getDoubleValues();
+        /// @endcode
+        ///
+        /// @ingroup votableaccess
+        class VOTableColumns {
+            public:
+
+                /// @brief Constructor of an empty table
+                ///
+                /// @param[in] fields   the fields of the table, one per column
+                explicit VOTableColumns(const std::vector<VOTableField>& fields);
+
+                /// @brief Constructor converting the rows of a table
+                ///
+                /// @param[in] table    the table
+                /// @throw AskapError   if a cell can't be converted to its column type.
+                explicit VOTableColumns(const VOTableTable& table);
+
+                size_t nColumns() const;
+
+                size_t nRows() const;
+
+                /// Reserve memory for a number of rows in all columns
+                void reserve(size_t nRows);
+
+                /// Get a column by number
+                const VOTableColumn& getColumn(size_t column) const;
+                VOTableColumn& getColumn(size_t column);
+
+                /// Get a column by the name of its field (or its ID if there is no name)
+                /// @throw AskapError   if there is no such column.
+                const VOTableColumn& getColumn(const std::string& name) const;
+
+                /// Get the number of a column
+                /// @param[in] name     the name (or ID if there is no name) of its field
+                /// @throw AskapError   if there is no such column.
+                size_t columnIndex(const std::string& name) const;
+
+                /// Append a row given as TABLEDATA text
+                ///
+                /// @throw AskapError   if the number of cells doesn't match the number
+                ///                     of columns or a cell can't be converted.
+                void addRow(const std::vector<std::string>& cells);
+                void addRow(const VOTableRow& row);
+
+                /// Get a row as TABLEDATA text
+                ///
+                /// @param[in] row      the row number
+                /// @param[out] cells   the cells (the vector and the strings in it are reused)
+                void getRow(size_t row, std::vector<std::string>& cells) const;
+                VOTableRow getRow(size_t row) const;
+
+                /// Append all rows of another columnar table with the same fields
+                /// @throw AskapError   if the columns don't match.
+                void append(const VOTableColumns& other);
+
+                /// Append all rows to a table with the same fields
+                void addRowsTo(VOTableTable& table) const;
+
+            private:
+
+                std::vector<VOTableColumn> itsColumns;
+        };
+
+    }
+}
+
+#endif
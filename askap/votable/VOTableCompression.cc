@@ -0,0 +1,124 @@
+/// @file VOTableCompression.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// Include own header file first
+#include "VOTableCompression.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <fstream>
+
+// ASKAPsoft includes
+#include "askap/AskapError.h"
+
+// Local package includes
+#include "askap/votable/CompressedFileInputSource.h"
+#include "askap/votable/MappedFileInputSource.h"
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// Check whether a string ends with the given suffix
+bool endsWith(const std::string& str, const std::string& suffix)
+{
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}
+
+VOTableCompression::Type VOTableCompression::fromFilename(const std::string& filename)
+{
+    if (endsWith(filename, ".gz")) {
+        return GZIP;
+    }
+    if (endsWith(filename, ".zst")) {
+        return ZSTD;
+    }
+    return NONE;
+}
+
+VOTableCompression::Type VOTableCompression::detect(const std::string& filename)
+{
+    std::ifstream fs(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!fs) {
+        ASKAPTHROW(AskapError, "File " << filename << " could not be opened");
+    }
+    unsigned char magic[4] = {0, 0, 0, 0};
+    fs.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    const std::streamsize nRead = fs.gcount();
+    if (nRead >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        return GZIP;
+    }
+    if (nRead == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return ZSTD;
+    }
+    return NONE;
+}
+
+bool VOTableCompression::isAvailable(Type type)
+{
+    switch (type) {
+        case NONE:
+            return true;
+#ifdef HAVE_ZLIB
+        case GZIP:
+            return true;
+#endif
+#ifdef HAVE_ZSTD
+        case ZSTD:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+std::string VOTableCompression::name(Type type)
+{
+    switch (type) {
+        case GZIP:
+            return "gzip";
+        case ZSTD:
+            return "zstd";
+        default:
+            return "none";
+    }
+}
+
+xercesc::InputSource* VOTableCompression::makeInputSource(const std::string& filename)
+{
+    const Type type = detect(filename);
+    if (type == NONE) {
+        return new MappedFileInputSource(filename);
+    }
+    return new CompressedFileInputSource(filename, type);
+}
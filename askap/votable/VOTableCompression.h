@@ -0,0 +1,100 @@
+/// @file VOTableCompression.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLECOMPRESSION_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLECOMPRESSION_H
+
+// System includes
+#include <string>
+
+// ASKAPsoft includes
+#include "xercesc/sax/InputSource.hpp"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Compression of VOTable files
+        ///
+        /// VOTable files may be compressed with gzip or zstd. Files being read are
+        /// recognised by the magic bytes at their start, whatever their name is.
+        /// The compression of files being written is chosen by the extension of
+        /// their name (".gz" or ".zst"). The support of each format depends on the
+        /// libraries available at build time (zlib and libzstd), see isAvailable.
+        ///
+        /// @ingroup votableaccess
+        class VOTableCompression {
+            public:
+                /// Compression formats
+                enum Type {
+                    /// Plain XML
+                    NONE,
+                    /// gzip (RFC 1952), possibly with several members
+                    GZIP,
+                    /// Zstandard, possibly with several frames
+                    ZSTD
+                };
+
+                /// Compression implied by the extension of a file name
+                ///
+                /// @param[in] filename name of the file
+                /// @return GZIP for ".gz", ZSTD for ".zst", NONE otherwise
+                static Type fromFilename(const std::string& filename);
+
+                /// Compression of an existing file, recognised by its magic bytes
+                ///
+                /// @param[in] filename name of the file
+                /// @return the compression format (NONE for plain or short files)
+                /// @throw AskapError if the file cannot be opened.
+                static Type detect(const std::string& filename);
+
+                /// Check whether a format is supported by this build
+                ///
+                /// @param[in] type the compression format
+                /// @return true if files of this format can be read and written
+                static bool isAvailable(Type type);
+
+                /// Name of a format for messages
+                ///
+                /// @param[in] type the compression format
+                /// @return "none", "gzip" or "zstd"
+                static std::string name(Type type);
+
+                /// Make a Xerces input source reading a VOTable file
+                ///
+                /// Plain files are memory mapped (see MappedFileInputSource), compressed
+                /// files are decompressed while they are parsed (see
+                /// CompressedFileInputSource), so no temporary file is made.
+                /// @param[in] filename name of the file
+                /// @return the input source (owned by the caller)
+                /// @throw AskapError if the file cannot be opened or its compression
+                ///                   is not supported by this build.
+                static xercesc::InputSource* makeInputSource(const std::string& filename);
+        };
+
+    }
+}
+
+#endif
@@ -42,6 +42,7 @@
 // Local package includes
 #include "askap/votable/XercescString.h"
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableNames.h"
 
 ASKAP_LOGGER(logger, ".VOTableField");
 
@@ -58,7 +59,7 @@ void VOTableField::setDescription(const std::string& description)
     itsDescription = description;
 }
 
-std::string VOTableField::getDescription() const
+const std::string& VOTableField::getDescription() const
 {
     return itsDescription;
 }
@@ -68,7 +69,7 @@ void VOTableField::setName(const std::string& name)
     itsName = name;
 }
 
-std::string VOTableField::getName() const
+const std::string& VOTableField::getName() const
 {
     return itsName;
 }
@@ -78,7 +79,7 @@ void VOTableField::setID(const std::string& id)
     itsID = id;
 }
 
-std::string VOTableField::getID() const
+const std::string& VOTableField::getID() const
 {
     return itsID;
 }
@@ -88,7 +89,7 @@ void VOTableField::setDatatype(const std::string& datatype)
     itsDatatype = datatype;
 }
 
-std::string VOTableField::getDatatype() const
+const std::string& VOTableField::getDatatype() const
 {
     return itsDatatype;
 }
@@ -98,7 +99,7 @@ void VOTableField::setArraysize(const std::string& arraysize)
     itsArraysize = arraysize;
 }
 
-std::string VOTableField::getArraysize() const
+const std::string& VOTableField::getArraysize() const
 {
     return itsArraysize;
 }
@@ -108,7 +109,7 @@ void VOTableField::setUnit(const std::string& unit)
     itsUnit = unit;
 }
 
-std::string VOTableField::getUnit() const
+const std::string& VOTableField::getUnit() const
 {
     return itsUnit;
 }
@@ -118,7 +119,7 @@ void VOTableField::setUCD(const std::string& ucd)
     itsUCD = ucd;
 }
 
-std::string VOTableField::getUCD() const
+const std::string& VOTableField::getUCD() const
 {
     return itsUCD;
 }
@@ -128,7 +129,7 @@ void VOTableField::setUType(const std::string& utype)
     itsUType = utype;
 }
 
-std::string VOTableField::getUType() const
+const std::string& VOTableField::getUType() const
 {
     return itsUType;
 }
@@ -138,44 +139,44 @@ void VOTableField::setRef(const std::string& ref)
     itsRef = ref;
 }
 
-std::string VOTableField::getRef() const
+const std::string& VOTableField::getRef() const
 {
     return itsRef;
 }
 
 xercesc::DOMElement* VOTableField::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("FIELD"));
+    DOMElement* e = doc.createElement(VOTableNames::tagField);
 
     // Add attributes
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableNames::attrName, XercescString(itsName));
     }
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableNames::attrID, XercescString(itsID));
     }
     if (itsDatatype.length() > 0) {
-        e->setAttribute(XercescString("datatype"), XercescString(itsDatatype));
+        e->setAttribute(VOTableNames::attrDatatype, XercescString(itsDatatype));
     }
     if (itsArraysize.length() > 0) {
-        e->setAttribute(XercescString("arraysize"), XercescString(itsArraysize));
+        e->setAttribute(VOTableNames::attrArraysize, XercescString(itsArraysize));
     }
     if (itsUnit.length() > 0) {
-        e->setAttribute(XercescString("unit"), XercescString(itsUnit));
+        e->setAttribute(VOTableNames::attrUnit, XercescString(itsUnit));
     }
     if (itsUCD.length() > 0) {
-        e->setAttribute(XercescString("ucd"), XercescString(itsUCD));
+        e->setAttribute(VOTableNames::attrUCD, XercescString(itsUCD));
     }
     if (itsUType.length() > 0) {
-        e->setAttribute(XercescString("utype"), XercescString(itsUType));
+        e->setAttribute(VOTableNames::attrUType, XercescString(itsUType));
     }
     if (itsRef.length() > 0) {
-        e->setAttribute(XercescString("ref"), XercescString(itsRef));
+        e->setAttribute(VOTableNames::attrRef, XercescString(itsRef));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableNames::tagDescription);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -188,14 +189,14 @@ VOTableField VOTableField::fromXmlElement(const xercesc::DOMElement& e)
     VOTableField f;
 
     // Get attributes
-    f.setName(XercescUtils::getAttribute(e, "name"));
-    f.setID(XercescUtils::getAttribute(e, "ID"));
-    f.setDatatype(XercescUtils::getAttribute(e, "datatype"));
-    f.setArraysize(XercescUtils::getAttribute(e, "arraysize"));
-    f.setUnit(XercescUtils::getAttribute(e, "unit"));
-    f.setUCD(XercescUtils::getAttribute(e, "ucd"));
-    f.setUType(XercescUtils::getAttribute(e, "utype"));
-    f.setRef(XercescUtils::getAttribute(e, "ref"));
+    f.setName(XercescUtils::getAttribute(e, VOTableNames::attrName));
+    f.setID(XercescUtils::getAttribute(e, VOTableNames::attrID));
+    f.setDatatype(XercescUtils::getAttribute(e, VOTableNames::attrDatatype));
+    f.setArraysize(XercescUtils::getAttribute(e, VOTableNames::attrArraysize));
+    f.setUnit(XercescUtils::getAttribute(e, VOTableNames::attrUnit));
+    f.setUCD(XercescUtils::getAttribute(e, VOTableNames::attrUCD));
+    f.setUType(XercescUtils::getAttribute(e, VOTableNames::attrUType));
+    f.setRef(XercescUtils::getAttribute(e, VOTableNames::attrRef));
 
     // Get description
     f.setDescription(XercescUtils::getDescription(e));
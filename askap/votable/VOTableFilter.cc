@@ -0,0 +1,112 @@
+/// @file VOTableFilter.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+// Include own header file first
+#include "VOTableFilter.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+
+// ASKAPsoft includes
+#include "askap/AskapError.h"
+
+using namespace askap;
+using namespace askap::accessors;
+
+VOTableFilter::VOTableFilter()
+{
+}
+
+VOTableFilter::VOTableFilter(const std::vector<std::string>& columns,
+                             const RowPredicate& predicate)
+    : itsColumns(columns), itsPredicate(predicate)
+{
+}
+
+void VOTableFilter::setColumns(const std::vector<std::string>& columns)
+{
+    itsColumns = columns;
+}
+
+const std::vector<std::string>& VOTableFilter::getColumns() const
+{
+    return itsColumns;
+}
+
+void VOTableFilter::setPredicate(const RowPredicate& predicate)
+{
+    itsPredicate = predicate;
+}
+
+bool VOTableFilter::hasPredicate() const
+{
+    return !itsPredicate.empty();
+}
+
+bool VOTableFilter::isTrivial() const
+{
+    return itsColumns.empty() && !itsPredicate;
+}
+
+std::vector<size_t> VOTableFilter::selection(const std::vector<VOTableField>& fields) const
+{
+    std::vector<size_t> result;
+    if (itsColumns.empty()) {
+        result.reserve(fields.size());
+        for (size_t i = 0; i < fields.size(); ++i) {
+            result.push_back(i);
+        }
+        return result;
+    }
+
+    result.reserve(itsColumns.size());
+    for (size_t sel = 0; sel < itsColumns.size(); ++sel) {
+        size_t i = 0;
+        for (; i < fields.size(); ++i) {
+            const std::string& name = fields[i].getName().size() ?
+                                      fields[i].getName() : fields[i].getID();
+            if (name == itsColumns[sel]) {
+                break;
+            }
+        }
+        ASKAPCHECK(i < fields.size(), "Column " << itsColumns[sel] << " is not present in the table");
+        for (size_t prev = 0; prev < result.size(); ++prev) {
+            ASKAPCHECK(result[prev] != i, "Column " << itsColumns[sel] << " is selected twice");
+        }
+        result.push_back(i);
+    }
+    return result;
+}
+
+bool VOTableFilter::accept(const std::vector<std::string>& cells) const
+{
+    return !itsPredicate || itsPredicate(cells);
+}
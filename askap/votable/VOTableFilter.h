@@ -0,0 +1,125 @@
+/// @file VOTableFilter.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEFILTER_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEFILTER_H
+
+// System includes
+#include <string>
+#include <vector>
+
+// ASKAPsoft includes
+#include "boost/function.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableField.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Column projection and row selection applied while a VOTable is parsed
+        ///
+        /// Passed to VOTable::fromXML to read only part of the tables of a document.
+        /// Only the listed columns are kept, in the order they are listed, and only
+        /// the rows accepted by the predicate. Both are applied by the parser as the
+        /// document is built, so the cells of other columns and rejected rows are
+        /// never stored. For example, to read the bright sources of a catalogue
+        /// @code
+        ///    bool bright(const std::vector<std::string>& cells)
+        ///    {
+        ///        return boost::lexical_cast<double>(cells[2]) > 0.01;
+        ///    }
+        ///
+        ///    std::vector<std::string> columns;
+        ///    columns.push_back("ra");
+        ///    columns.push_back("dec");
+        ///    columns.push_back("flux");
+        ///    VOTable vot = VOTable::fromXML("catalogue.xml", VOTableFilter(columns, bright));
+        /// @endcode
+        ///
+        /// @ingroup votableaccess
+        class VOTableFilter {
+            public:
+
+                /// Predicate deciding whether a row is kept. It receives the cells of
+                /// the selected columns (trimmed, in the order of the selection).
+                typedef boost::function<bool (const std::vector<std::string>&)> RowPredicate;
+
+                /// Keep all columns and all rows
+                VOTableFilter();
+
+                /// @brief Constructor
+                ///
+                /// @param[in] columns      names of the columns to keep (all
+                ///                         columns if empty). A column without
+                ///                         name is matched by its ID.
+                /// @param[in] predicate    rows for which it returns false are
+                ///                         dropped (empty function keeps all rows).
+                explicit VOTableFilter(const std::vector<std::string>& columns,
+                                       const RowPredicate& predicate = RowPredicate());
+
+                /// Set the names of the columns to keep (all columns if empty)
+                void setColumns(const std::vector<std::string>& columns);
+
+                /// Returns the names of the columns to keep
+                const std::vector<std::string>& getColumns() const;
+
+                /// Set the predicate selecting rows (empty function keeps all rows)
+                void setPredicate(const RowPredicate& predicate);
+
+                /// Returns true if a row predicate is set
+                bool hasPredicate() const;
+
+                /// Returns true if the filter keeps the whole table
+                bool isTrivial() const;
+
+                /// @brief Work out which fields of a table are kept
+                ///
+                /// @param[in] fields   the fields of the table
+                /// @return the index of the field of each selected column
+                /// @throw AskapError   if a column is not present in the table or is
+                ///                     selected twice.
+                std::vector<size_t> selection(const std::vector<VOTableField>& fields) const;
+
+                /// @brief Test a row against the predicate
+                ///
+                /// @param[in] cells    the cells of the selected columns
+                /// @return true if the row is kept.
+                bool accept(const std::vector<std::string>& cells) const;
+
+            private:
+                /// Names of the columns to keep
+                std::vector<std::string> itsColumns;
+
+                /// Row predicate
+                RowPredicate itsPredicate;
+        };
+
+    }
+}
+
+#endif
@@ -42,6 +42,7 @@
 // Local package includes
 #include "askap/votable/XercescString.h"
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableNames.h"
 #include "askap/votable/VOTableParam.h"
 
 ASKAP_LOGGER(logger, ".VOTableGroup");
@@ -59,7 +60,7 @@ void VOTableGroup::setDescription(const std::string& description)
     itsDescription = description;
 }
 
-std::string VOTableGroup::getDescription() const
+const std::string& VOTableGroup::getDescription() const
 {
     return itsDescription;
 }
@@ -69,7 +70,7 @@ void VOTableGroup::setName(const std::string& name)
     itsName = name;
 }
 
-std::string VOTableGroup::getName() const
+const std::string& VOTableGroup::getName() const
 {
     return itsName;
 }
@@ -79,7 +80,7 @@ void VOTableGroup::setID(const std::string& id)
     itsID = id;
 }
 
-std::string VOTableGroup::getID() const
+const std::string& VOTableGroup::getID() const
 {
     return itsID;
 }
@@ -89,7 +90,7 @@ void VOTableGroup::setUCD(const std::string& ucd)
     itsUCD = ucd;
 }
 
-std::string VOTableGroup::getUCD() const
+const std::string& VOTableGroup::getUCD() const
 {
     return itsUCD;
 }
@@ -99,7 +100,7 @@ void VOTableGroup::setUType(const std::string& utype)
     itsUType = utype;
 }
 
-std::string VOTableGroup::getUType() const
+const std::string& VOTableGroup::getUType() const
 {
     return itsUType;
 }
@@ -109,7 +110,7 @@ void VOTableGroup::setRef(const std::string& ref)
     itsRef = ref;
 }
 
-std::string VOTableGroup::getRef() const
+const std::string& VOTableGroup::getRef() const
 {
     return itsRef;
 }
@@ -119,7 +120,7 @@ void VOTableGroup::addParam(const VOTableParam& param)
     itsParams.push_back(param);
 }
 
-std::vector<VOTableParam> VOTableGroup::getParams() const
+const std::vector<VOTableParam>& VOTableGroup::getParams() const
 {
     return itsParams;
 }
@@ -129,7 +130,7 @@ void VOTableGroup::addFieldRef(const std::string& fieldRef)
     itsFieldRefs.push_back(fieldRef);
 }
 
-std::vector<std::string> VOTableGroup::getFieldRefs() const
+const std::vector<std::string>& VOTableGroup::getFieldRefs() const
 {
     return itsFieldRefs;
 }
@@ -139,35 +140,35 @@ void VOTableGroup::addParamRef(const std::string& paramRef)
     itsParamRefs.push_back(paramRef);
 }
 
-std::vector<std::string> VOTableGroup::getParamRefs() const
+const std::vector<std::string>& VOTableGroup::getParamRefs() const
 {
     return itsParamRefs;
 }
 
 xercesc::DOMElement* VOTableGroup::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("GROUP"));
+    DOMElement* e = doc.createElement(VOTableNames::tagGroup);
 
     // Add attributes
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableNames::attrName, XercescString(itsName));
     }
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableNames::attrID, XercescString(itsID));
     }
     if (itsUCD.length() > 0) {
-        e->setAttribute(XercescString("ucd"), XercescString(itsUCD));
+        e->setAttribute(VOTableNames::attrUCD, XercescString(itsUCD));
     }
     if (itsUType.length() > 0) {
-        e->setAttribute(XercescString("utype"), XercescString(itsUType));
+        e->setAttribute(VOTableNames::attrUType, XercescString(itsUType));
     }
     if (itsRef.length() > 0) {
-        e->setAttribute(XercescString("ref"), XercescString(itsRef));
+        e->setAttribute(VOTableNames::attrRef, XercescString(itsRef));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableNames::tagDescription);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -182,16 +183,16 @@ xercesc::DOMElement* VOTableGroup::toXmlElement(xercesc::DOMDocument& doc) const
     // Create FIELDref elements
     for (std::vector<std::string>::const_iterator it = itsFieldRefs.begin();
             it != itsFieldRefs.end(); ++it) {
-        DOMElement* fr = doc.createElement(XercescString("FIELDref"));
-        fr->setAttribute(XercescString("ref"), XercescString(*it));
+        DOMElement* fr = doc.createElement(VOTableNames::tagFieldRef);
+        fr->setAttribute(VOTableNames::attrRef, XercescString(*it));
         e->appendChild(fr);
     }
 
     // Create PARAMref elements
     for (std::vector<std::string>::const_iterator it = itsParamRefs.begin();
             it != itsParamRefs.end(); ++it) {
-        DOMElement* fr = doc.createElement(XercescString("PARAMref"));
-        fr->setAttribute(XercescString("ref"), XercescString(*it));
+        DOMElement* fr = doc.createElement(VOTableNames::tagParamRef);
+        fr->setAttribute(VOTableNames::attrRef, XercescString(*it));
         e->appendChild(fr);
     }
     return e;
@@ -202,17 +203,17 @@ VOTableGroup VOTableGroup::fromXmlElement(const xercesc::DOMElement& e)
     VOTableGroup g;
 
     // Get attributes
-    g.setName(XercescUtils::getAttribute(e, "name"));
-    g.setID(XercescUtils::getAttribute(e, "ID"));
-    g.setUCD(XercescUtils::getAttribute(e, "ucd"));
-    g.setUType(XercescUtils::getAttribute(e, "utype"));
-    g.setRef(XercescUtils::getAttribute(e, "ref"));
+    g.setName(XercescUtils::getAttribute(e, VOTableNames::attrName));
+    g.setID(XercescUtils::getAttribute(e, VOTableNames::attrID));
+    g.setUCD(XercescUtils::getAttribute(e, VOTableNames::attrUCD));
+    g.setUType(XercescUtils::getAttribute(e, VOTableNames::attrUType));
+    g.setRef(XercescUtils::getAttribute(e, VOTableNames::attrRef));
 
     // Get description
     g.setDescription(XercescUtils::getDescription(e));
 
     // Process PARAM
-    DOMNodeList* children = e.getElementsByTagName(XercescString("PARAM"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableNames::tagParam);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableParam param = VOTableParam::fromXmlElement(*node);
@@ -220,17 +221,17 @@ VOTableGroup VOTableGroup::fromXmlElement(const xercesc::DOMElement& e)
     }
 
     // Process FIELDref elements
-    children = e.getElementsByTagName(XercescString("FIELDref"));
+    children = e.getElementsByTagName(VOTableNames::tagFieldRef);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
-        g.addFieldRef(XercescUtils::getAttribute(*node, "ref"));
+        g.addFieldRef(XercescUtils::getAttribute(*node, VOTableNames::attrRef));
     }
 
     // Process PARAMref elements
-    children = e.getElementsByTagName(XercescString("PARAMref"));
+    children = e.getElementsByTagName(VOTableNames::tagParamRef);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
-        g.addParamRef(XercescUtils::getAttribute(*node, "ref"));
+        g.addParamRef(XercescUtils::getAttribute(*node, VOTableNames::attrRef));
     }
 
     return g;
@@ -51,39 +51,39 @@ namespace askap {
 
                 void setDescription(const std::string& description);
 
-                std::string getDescription() const;
+                const std::string& getDescription() const;
 
                 void setName(const std::string& name);
 
-                std::string getName() const;
+                const std::string& getName() const;
 
                 void setID(const std::string& id);
 
-                std::string getID() const;
+                const std::string& getID() const;
 
                 void setUCD(const std::string& ucd);
 
-                std::string getUCD() const;
+                const std::string& getUCD() const;
 
                 void setUType(const std::string& utype);
 
-                std::string getUType() const;
+                const std::string& getUType() const;
 
                 void setRef(const std::string& ref);
 
-                std::string getRef() const;
+                const std::string& getRef() const;
 
                 void addParam(const VOTableParam& param);
 
-                std::vector<VOTableParam> getParams() const;
+                const std::vector<VOTableParam>& getParams() const;
 
                 void addFieldRef(const std::string& fieldRef);
 
-                std::vector<std::string> getFieldRefs() const;
+                const std::vector<std::string>& getFieldRefs() const;
 
                 void addParamRef(const std::string& paramRef);
 
-                std::vector<std::string> getParamRefs() const;
+                const std::vector<std::string>& getParamRefs() const;
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
@@ -39,6 +39,7 @@
 #include "boost/algorithm/string/trim.hpp"
 #include "askap/votable/XercescString.h"
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableNames.h"
 #include "xercesc/dom/DOM.hpp" // Includes all DOM
 
 // Local package includes
@@ -59,7 +60,7 @@ void VOTableInfo::setID(const std::string& id)
     itsID = id;
 }
 
-std::string VOTableInfo::getID() const
+const std::string& VOTableInfo::getID() const
 {
     return itsID;
 }
@@ -69,7 +70,7 @@ void VOTableInfo::setName(const std::string& name)
     itsName = name;
 }
 
-std::string VOTableInfo::getName() const
+const std::string& VOTableInfo::getName() const
 {
     return itsName;
 }
@@ -79,7 +80,7 @@ void VOTableInfo::setValue(const std::string& value)
     itsValue = value;
 }
 
-std::string VOTableInfo::getValue() const
+const std::string& VOTableInfo::getValue() const
 {
     return itsValue;
 }
@@ -89,24 +90,24 @@ void VOTableInfo::setText(const std::string& text)
     itsText = text;
 }
 
-std::string VOTableInfo::getText() const
+const std::string& VOTableInfo::getText() const
 {
     return itsText;
 }
 
 DOMElement* VOTableInfo::toXmlElement(DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("INFO"));
+    DOMElement* e = doc.createElement(VOTableNames::tagInfo);
 
     // Add attributes
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableNames::attrID, XercescString(itsID));
     }
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableNames::attrName, XercescString(itsName));
     }
     if (itsValue.length()) {
-        e->setAttribute(XercescString("value"), XercescString(itsValue));
+        e->setAttribute(VOTableNames::attrValue, XercescString(itsValue));
     }
 
     // Add text
@@ -122,9 +123,9 @@ VOTableInfo VOTableInfo::fromXmlElement(const xercesc::DOMElement& e)
 {
     VOTableInfo info;
 
-    info.setID(XercescUtils::getAttribute(e, "ID"));
-    info.setName(XercescUtils::getAttribute(e, "name"));
-    info.setValue(XercescUtils::getAttribute(e, "value"));
+    info.setID(XercescUtils::getAttribute(e, VOTableNames::attrID));
+    info.setName(XercescUtils::getAttribute(e, VOTableNames::attrName));
+    info.setValue(XercescUtils::getAttribute(e, VOTableNames::attrValue));
 
     const DOMText* text = dynamic_cast<xercesc::DOMText*>(e.getChildNodes()->item(0));
     std::string str = XercescUtils::getStringFromDOMText(*text);
@@ -46,16 +46,16 @@ namespace askap {
                 VOTableInfo();
 
                 void setID(const std::string& id);
-                std::string getID() const;
+                const std::string& getID() const;
 
                 void setName(const std::string& name);
-                std::string getName() const;
+                const std::string& getName() const;
 
                 void setValue(const std::string& value);
-                std::string getValue() const;
+                const std::string& getValue() const;
 
                 void setText(const std::string& text);
-                std::string getText() const;
+                const std::string& getText() const;
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
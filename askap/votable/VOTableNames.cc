@@ -0,0 +1,63 @@
+/// @file VOTableNames.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#include "VOTableNames.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+using namespace askap::accessors;
+
+const XMLCh VOTableNames::tagVOTable[] = { 'V', 'O', 'T', 'A', 'B', 'L', 'E', 0 };
+const XMLCh VOTableNames::tagDescription[] = { 'D', 'E', 'S', 'C', 'R', 'I', 'P', 'T', 'I', 'O', 'N', 0 };
+const XMLCh VOTableNames::tagInfo[] = { 'I', 'N', 'F', 'O', 0 };
+const XMLCh VOTableNames::tagResource[] = { 'R', 'E', 'S', 'O', 'U', 'R', 'C', 'E', 0 };
+const XMLCh VOTableNames::tagTable[] = { 'T', 'A', 'B', 'L', 'E', 0 };
+const XMLCh VOTableNames::tagField[] = { 'F', 'I', 'E', 'L', 'D', 0 };
+const XMLCh VOTableNames::tagParam[] = { 'P', 'A', 'R', 'A', 'M', 0 };
+const XMLCh VOTableNames::tagGroup[] = { 'G', 'R', 'O', 'U', 'P', 0 };
+const XMLCh VOTableNames::tagFieldRef[] = { 'F', 'I', 'E', 'L', 'D', 'r', 'e', 'f', 0 };
+const XMLCh VOTableNames::tagParamRef[] = { 'P', 'A', 'R', 'A', 'M', 'r', 'e', 'f', 0 };
+const XMLCh VOTableNames::tagData[] = { 'D', 'A', 'T', 'A', 0 };
+const XMLCh VOTableNames::tagTableData[] = { 'T', 'A', 'B', 'L', 'E', 'D', 'A', 'T', 'A', 0 };
+const XMLCh VOTableNames::tagRow[] = { 'T', 'R', 0 };
+const XMLCh VOTableNames::tagCell[] = { 'T', 'D', 0 };
+const XMLCh VOTableNames::tagBinary2[] = { 'B', 'I', 'N', 'A', 'R', 'Y', '2', 0 };
+const XMLCh VOTableNames::tagStream[] = { 'S', 'T', 'R', 'E', 'A', 'M', 0 };
+
+const XMLCh VOTableNames::attrID[] = { 'I', 'D', 0 };
+const XMLCh VOTableNames::attrName[] = { 'n', 'a', 'm', 'e', 0 };
+const XMLCh VOTableNames::attrValue[] = { 'v', 'a', 'l', 'u', 'e', 0 };
+const XMLCh VOTableNames::attrType[] = { 't', 'y', 'p', 'e', 0 };
+const XMLCh VOTableNames::attrDatatype[] = { 'd', 'a', 't', 'a', 't', 'y', 'p', 'e', 0 };
+const XMLCh VOTableNames::attrArraysize[] = { 'a', 'r', 'r', 'a', 'y', 's', 'i', 'z', 'e', 0 };
+const XMLCh VOTableNames::attrUnit[] = { 'u', 'n', 'i', 't', 0 };
+const XMLCh VOTableNames::attrUCD[] = { 'u', 'c', 'd', 0 };
+const XMLCh VOTableNames::attrUType[] = { 'u', 't', 'y', 'p', 'e', 0 };
+const XMLCh VOTableNames::attrRef[] = { 'r', 'e', 'f', 0 };
+const XMLCh VOTableNames::attrEncoding[] = { 'e', 'n', 'c', 'o', 'd', 'i', 'n', 'g', 0 };
+const XMLCh VOTableNames::attrVersion[] = { 'v', 'e', 'r', 's', 'i', 'o', 'n', 0 };
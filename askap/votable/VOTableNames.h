@@ -0,0 +1,79 @@
+/// @file VOTableNames.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLENAMES_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLENAMES_H
+
+// ASKAPsoft includes
+#include "xercesc/util/XercesDefs.hpp"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Element and attribute names of the VOTable format
+        ///
+        /// The names are null terminated XMLCh arrays initialised at compile time, so
+        /// they can be passed to the DOM and SAX interfaces without transcoding and
+        /// are usable before XMLPlatformUtils::Initialize.
+        ///
+        /// @ingroup votableaccess
+        struct VOTableNames {
+            static const XMLCh tagVOTable[];
+            static const XMLCh tagDescription[];
+            static const XMLCh tagInfo[];
+            static const XMLCh tagResource[];
+            static const XMLCh tagTable[];
+            static const XMLCh tagField[];
+            static const XMLCh tagParam[];
+            static const XMLCh tagGroup[];
+            static const XMLCh tagFieldRef[];
+            static const XMLCh tagParamRef[];
+            static const XMLCh tagData[];
+            static const XMLCh tagTableData[];
+            static const XMLCh tagRow[];
+            static const XMLCh tagCell[];
+            static const XMLCh tagBinary2[];
+            static const XMLCh tagStream[];
+
+            static const XMLCh attrID[];
+            static const XMLCh attrName[];
+            static const XMLCh attrValue[];
+            static const XMLCh attrType[];
+            static const XMLCh attrDatatype[];
+            static const XMLCh attrArraysize[];
+            static const XMLCh attrUnit[];
+            static const XMLCh attrUCD[];
+            static const XMLCh attrUType[];
+            static const XMLCh attrRef[];
+            static const XMLCh attrEncoding[];
+            static const XMLCh attrVersion[];
+        };
+
+    }
+}
+
+#endif
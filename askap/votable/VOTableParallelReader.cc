@@ -0,0 +1,240 @@
+/// @file VOTableParallelReader.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#include "VOTableParallelReader.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <sstream>
+
+// ASKAPsoft includes
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+#include "boost/bind.hpp"
+#include "boost/thread/thread.hpp"
+
+ASKAP_LOGGER(logger, ".VOTableParallelReader");
+
+using namespace askap;
+using namespace askap::accessors;
+
+VOTableParallelReader::VOTableParallelReader(const std::string& filename, size_t nThreads,
+        size_t blockSize)
+    : itsReader(filename), itsNThreads(nThreads), itsBlockSize(blockSize), itsDone(false)
+{
+    ASKAPCHECK(nThreads > 0, "At least one thread is required to read " << filename);
+    ASKAPCHECK(blockSize > 0, "The block size should be positive");
+}
+
+VOTableParallelReader::VOTableParallelReader(std::istream& is, size_t nThreads, size_t blockSize)
+    : itsReader(is), itsNThreads(nThreads), itsBlockSize(blockSize), itsDone(false)
+{
+    ASKAPCHECK(nThreads > 0, "At least one thread is required to read a VOTable");
+    ASKAPCHECK(blockSize > 0, "The block size should be positive");
+}
+
+void VOTableParallelReader::selectColumns(const std::vector<std::string>& names)
+{
+    itsSelection = names;
+    itsReader.selectColumns(names);
+}
+
+std::vector<boost::shared_ptr<VOTableColumns> > VOTableParallelReader::read()
+{
+    // all blocks in the document order, the queue only holds those waiting for conversion
+    std::vector<boost::shared_ptr<Block> > blocks;
+    itsDone = false;
+    itsError.clear();
+    boost::thread_group threads;
+    if (itsNThreads > 1) {
+        for (size_t thread = 0; thread < itsNThreads; ++thread) {
+            threads.create_thread(boost::bind(&VOTableParallelReader::run, this));
+        }
+    }
+
+    try {
+        boost::shared_ptr<Block> current;
+        std::vector<std::string> cells;
+        while (itsReader.next(cells)) {
+            const size_t table = itsReader.tableIndex();
+            if (!current || current->table != table || current->rows.size() >= itsBlockSize) {
+                if (current) {
+                    submit(current);
+                }
+                current.reset(new Block);
+                current->table = table;
+                current->fields = selectedFields();
+                current->rows.reserve(itsBlockSize);
+                blocks.push_back(current);
+            }
+            current->rows.push_back(std::vector<std::string>());
+            current->rows.back().swap(cells);
+        }
+        if (current) {
+            submit(current);
+        }
+    } catch (...) {
+        {
+            boost::mutex::scoped_lock lock(itsMutex);
+            itsDone = true;
+            itsQueue.clear();
+        }
+        itsCondition.notify_all();
+        threads.join_all();
+        throw;
+    }
+
+    {
+        boost::mutex::scoped_lock lock(itsMutex);
+        itsDone = true;
+    }
+    itsCondition.notify_all();
+    threads.join_all();
+    if (itsError.size()) {
+        ASKAPTHROW(AskapError, "Conversion of the VOTable rows failed: " << itsError);
+    }
+
+    // Join the blocks of each table, reserving the memory for all rows first
+    std::vector<size_t> nRows;
+    for (std::vector<boost::shared_ptr<Block> >::const_iterator it = blocks.begin();
+            it != blocks.end(); ++it) {
+        if ((*it)->table >= nRows.size()) {
+            nRows.resize((*it)->table + 1, 0);
+        }
+        nRows[(*it)->table] += (*it)->columns->nRows();
+    }
+    std::vector<boost::shared_ptr<VOTableColumns> > result(nRows.size());
+    for (std::vector<boost::shared_ptr<Block> >::iterator it = blocks.begin();
+            it != blocks.end(); ++it) {
+        boost::shared_ptr<VOTableColumns>& table = result[(*it)->table];
+        if (!table) {
+            table = (*it)->columns;
+            table->reserve(nRows[(*it)->table]);
+        } else {
+            table->append(*(*it)->columns);
+        }
+        it->reset();
+    }
+    for (std::vector<boost::shared_ptr<VOTableColumns> >::iterator it = result.begin();
+            it != result.end(); ++it) {
+        if (!*it) {
+            it->reset(new VOTableColumns(std::vector<VOTableField>()));
+        }
+    }
+    ASKAPLOG_DEBUG_STR(logger, "Read " << result.size() << " table(s) in " << blocks.size() <<
+                       " block(s) with " << itsNThreads << " thread(s)");
+    return result;
+}
+
+std::vector<VOTableField> VOTableParallelReader::selectedFields()
+{
+    const std::vector<VOTableField>& fields = itsReader.getFields();
+    if (itsSelection.empty()) {
+        return fields;
+    }
+    std::vector<VOTableField> selected;
+    for (std::vector<std::string>::const_iterator name = itsSelection.begin();
+            name != itsSelection.end(); ++name) {
+        for (std::vector<VOTableField>::const_iterator it = fields.begin();
+                it != fields.end(); ++it) {
+            if ((it->getName().size() ? it->getName() : it->getID()) == *name) {
+                selected.push_back(*it);
+                break;
+            }
+        }
+    }
+    return selected;
+}
+
+void VOTableParallelReader::submit(const boost::shared_ptr<Block>& block)
+{
+    if (itsNThreads <= 1) {
+        convert(*block);
+        return;
+    }
+    {
+        boost::mutex::scoped_lock lock(itsMutex);
+        // bound the number of blocks held as text
+        while (itsQueue.size() >= 2 * itsNThreads && itsError.empty()) {
+            itsCondition.wait(lock);
+        }
+        if (itsError.size()) {
+            // stop reading, the error is reported once the threads have finished
+            ASKAPTHROW(AskapError, "Conversion of the VOTable rows failed: " << itsError);
+        }
+        itsQueue.push_back(block);
+    }
+    itsCondition.notify_all();
+}
+
+void VOTableParallelReader::convert(Block& block)
+{
+    block.columns.reset(new VOTableColumns(block.fields));
+    block.columns->reserve(block.rows.size());
+    for (size_t row = 0; row < block.rows.size(); ++row) {
+        block.columns->addRow(block.rows[row]);
+    }
+    // release the text of the cells
+    std::vector<std::vector<std::string> >().swap(block.rows);
+}
+
+void VOTableParallelReader::run()
+{
+    while (true) {
+        boost::shared_ptr<Block> block;
+        {
+            boost::mutex::scoped_lock lock(itsMutex);
+            while (itsQueue.empty() && !itsDone) {
+                itsCondition.wait(lock);
+            }
+            if (itsQueue.empty() || itsError.size()) {
+                return;
+            }
+            block = itsQueue.front();
+            itsQueue.pop_front();
+        }
+        itsCondition.notify_all();
+        try {
+            convert(*block);
+        } catch (const std::exception& ex) {
+            {
+                boost::mutex::scoped_lock lock(itsMutex);
+                if (itsError.empty()) {
+                    std::ostringstream os;
+                    os << "table " << block->table << ": " << ex.what();
+                    itsError = os.str();
+                }
+            }
+            itsCondition.notify_all();
+            return;
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/// @file VOTableParallelReader.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEPARALLELREADER_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEPARALLELREADER_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <deque>
+#include <istream>
+
+// ASKAPsoft includes
+#include "boost/shared_ptr.hpp"
+#include "boost/utility.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/condition_variable.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableColumns.h"
+#include "askap/votable/VOTableField.h"
+#include "askap/votable/VOTableReader.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Reader of VOTable data into typed columns using a number of threads
+        ///
+        /// The XML is parsed by a VOTableReader in the calling thread, which groups
+        /// the rows into blocks. The conversion of the cells of each block to typed
+        /// columns (see VOTableColumns) is done by a pool of worker threads, blocks of
+        /// all TABLE elements being processed concurrently. The converted blocks are
+        /// then joined in the document order. The number of blocks waiting for
+        /// conversion is bounded, so the memory used for the text of the cells
+        /// doesn't depend on the size of the catalogue.
+        /// @code
+        ///    VOTableParallelReader reader("catalogue.xml", 8);
+        ///    reader.selectColumns(names);
+        ///    const std::vector<boost::shared_ptr<VOTableColumns> > tables = reader.read();
+        /// @endcode
+        ///
+        /// @ingroup votableaccess
+        class VOTableParallelReader : private boost::noncopyable {
+            public:
+
+                /// @brief Constructor
+                ///
+                /// @param[in] filename the file/path to read the XML input from.
+                /// @param[in] nThreads the number of conversion threads (1 means
+                ///                     that the calling thread converts the rows)
+                /// @param[in] blockSize the number of rows in a block
+                /// @throw AskapError   if the specified file cannot be opened.
+                VOTableParallelReader(const std::string& filename, size_t nThreads,
+                                      size_t blockSize = 10000);
+
+                /// @brief Constructor
+                ///
+                /// @param[in] is       an istream from which the XML input will be read,
+                ///                     it should outlive the reader.
+                /// @param[in] nThreads the number of conversion threads
+                /// @param[in] blockSize the number of rows in a block
+                VOTableParallelReader(std::istream& is, size_t nThreads, size_t blockSize = 10000);
+
+                /// Select the columns to read
+                ///
+                /// @param[in] names    names of the columns (empty for all), see
+                ///                     VOTableReader::selectColumns
+                void selectColumns(const std::vector<std::string>& names);
+
+                /// Read the data of all tables
+                ///
+                /// @return one columnar table per TABLE element in the document order
+                ///         (a table without rows has no columns)
+                /// @throw AskapError   if the document is not a valid VOTable or a
+                ///                     cell can't be converted to its column type.
+                std::vector<boost::shared_ptr<VOTableColumns> > read();
+
+            private:
+
+                /// Rows of one table to be converted together
+                struct Block {
+                    /// Number of the TABLE element
+                    size_t table;
+                    /// Fields of the selected columns
+                    std::vector<VOTableField> fields;
+                    /// Text of the cells
+                    std::vector<std::vector<std::string> > rows;
+                    /// Converted rows
+                    boost::shared_ptr<VOTableColumns> columns;
+                };
+
+                /// Get the fields of the selected columns of the current table
+                std::vector<VOTableField> selectedFields();
+
+                /// Queue a block for conversion, waits if too many blocks are queued
+                void submit(const boost::shared_ptr<Block>& block);
+
+                /// Convert the rows of a block
+                static void convert(Block& block);
+
+                /// Body of a worker thread
+                void run();
+
+                VOTableReader itsReader;
+                size_t itsNThreads;
+                size_t itsBlockSize;
+                std::vector<std::string> itsSelection;
+
+                /// Blocks waiting for conversion
+                std::deque<boost::shared_ptr<Block> > itsQueue;
+                /// True when no more blocks will be queued
+                bool itsDone;
+                /// First error of the worker threads (empty if none)
+                std::string itsError;
+                boost::mutex itsMutex;
+                boost::condition_variable itsCondition;
+        };
+
+    }
+}
+
+#endif
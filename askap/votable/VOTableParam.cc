@@ -41,6 +41,7 @@
 
 // Local package includes
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableNames.h"
 #include "askap/votable/XercescString.h"
 
 ASKAP_LOGGER(logger, ".VOTableParam");
@@ -58,7 +59,7 @@ void VOTableParam::setDescription(const std::string& description)
     itsDescription = description;
 }
 
-std::string VOTableParam::getDescription() const
+const std::string& VOTableParam::getDescription() const
 {
     return itsDescription;
 }
@@ -68,7 +69,7 @@ void VOTableParam::setName(const std::string& name)
     itsName = name;
 }
 
-std::string VOTableParam::getName() const
+const std::string& VOTableParam::getName() const
 {
     return itsName;
 }
@@ -78,7 +79,7 @@ void VOTableParam::setID(const std::string& id)
     itsID = id;
 }
 
-std::string VOTableParam::getID() const
+const std::string& VOTableParam::getID() const
 {
     return itsID;
 }
@@ -88,7 +89,7 @@ void VOTableParam::setDatatype(const std::string& datatype)
     itsDatatype = datatype;
 }
 
-std::string VOTableParam::getDatatype() const
+const std::string& VOTableParam::getDatatype() const
 {
     return itsDatatype;
 }
@@ -98,7 +99,7 @@ void VOTableParam::setArraysize(const std::string& arraysize)
     itsArraysize = arraysize;
 }
 
-std::string VOTableParam::getArraysize() const
+const std::string& VOTableParam::getArraysize() const
 {
     return itsArraysize;
 }
@@ -108,7 +109,7 @@ void VOTableParam::setUnit(const std::string& unit)
     itsUnit = unit;
 }
 
-std::string VOTableParam::getUnit() const
+const std::string& VOTableParam::getUnit() const
 {
     return itsUnit;
 }
@@ -118,7 +119,7 @@ void VOTableParam::setUCD(const std::string& ucd)
     itsUCD = ucd;
 }
 
-std::string VOTableParam::getUCD() const
+const std::string& VOTableParam::getUCD() const
 {
     return itsUCD;
 }
@@ -128,7 +129,7 @@ void VOTableParam::setUType(const std::string& utype)
     itsUType = utype;
 }
 
-std::string VOTableParam::getUType() const
+const std::string& VOTableParam::getUType() const
 {
     return itsUType;
 }
@@ -138,7 +139,7 @@ void VOTableParam::setRef(const std::string& ref)
     itsRef = ref;
 }
 
-std::string VOTableParam::getRef() const
+const std::string& VOTableParam::getRef() const
 {
     return itsRef;
 }
@@ -148,47 +149,47 @@ void VOTableParam::setValue(const std::string& value)
     itsValue = value;
 }
 
-std::string VOTableParam::getValue() const
+const std::string& VOTableParam::getValue() const
 {
     return itsValue;
 }
 
 xercesc::DOMElement* VOTableParam::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("PARAM"));
+    DOMElement* e = doc.createElement(VOTableNames::tagParam);
 
     // Add attributes
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableNames::attrName, XercescString(itsName));
     }
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableNames::attrID, XercescString(itsID));
     }
     if (itsDatatype.length() > 0) {
-        e->setAttribute(XercescString("datatype"), XercescString(itsDatatype));
+        e->setAttribute(VOTableNames::attrDatatype, XercescString(itsDatatype));
     }
     if (itsArraysize.length() > 0) {
-        e->setAttribute(XercescString("arraysize"), XercescString(itsArraysize));
+        e->setAttribute(VOTableNames::attrArraysize, XercescString(itsArraysize));
     }
     if (itsUnit.length() > 0) {
-        e->setAttribute(XercescString("unit"), XercescString(itsUnit));
+        e->setAttribute(VOTableNames::attrUnit, XercescString(itsUnit));
     }
     if (itsUCD.length() > 0) {
-        e->setAttribute(XercescString("ucd"), XercescString(itsUCD));
+        e->setAttribute(VOTableNames::attrUCD, XercescString(itsUCD));
     }
     if (itsUType.length() > 0) {
-        e->setAttribute(XercescString("utype"), XercescString(itsUType));
+        e->setAttribute(VOTableNames::attrUType, XercescString(itsUType));
     }
     if (itsRef.length() > 0) {
-        e->setAttribute(XercescString("ref"), XercescString(itsRef));
+        e->setAttribute(VOTableNames::attrRef, XercescString(itsRef));
     }
     if (itsValue.length() > 0) {
-        e->setAttribute(XercescString("value"), XercescString(itsValue));
+        e->setAttribute(VOTableNames::attrValue, XercescString(itsValue));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableNames::tagDescription);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -201,15 +202,15 @@ VOTableParam VOTableParam::fromXmlElement(const xercesc::DOMElement& e)
     VOTableParam p;
 
     // Get attributes
-    p.setName(XercescUtils::getAttribute(e, "name"));
-    p.setID(XercescUtils::getAttribute(e, "ID"));
-    p.setDatatype(XercescUtils::getAttribute(e, "datatype"));
-    p.setArraysize(XercescUtils::getAttribute(e, "arraysize"));
-    p.setUnit(XercescUtils::getAttribute(e, "unit"));
-    p.setUCD(XercescUtils::getAttribute(e, "ucd"));
-    p.setUType(XercescUtils::getAttribute(e, "utype"));
-    p.setRef(XercescUtils::getAttribute(e, "ref"));
-    p.setValue(XercescUtils::getAttribute(e, "value"));
+    p.setName(XercescUtils::getAttribute(e, VOTableNames::attrName));
+    p.setID(XercescUtils::getAttribute(e, VOTableNames::attrID));
+    p.setDatatype(XercescUtils::getAttribute(e, VOTableNames::attrDatatype));
+    p.setArraysize(XercescUtils::getAttribute(e, VOTableNames::attrArraysize));
+    p.setUnit(XercescUtils::getAttribute(e, VOTableNames::attrUnit));
+    p.setUCD(XercescUtils::getAttribute(e, VOTableNames::attrUCD));
+    p.setUType(XercescUtils::getAttribute(e, VOTableNames::attrUType));
+    p.setRef(XercescUtils::getAttribute(e, VOTableNames::attrRef));
+    p.setValue(XercescUtils::getAttribute(e, VOTableNames::attrValue));
 
     // Get description
     p.setDescription(XercescUtils::getDescription(e));
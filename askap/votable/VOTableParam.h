@@ -49,43 +49,43 @@ namespace askap {
 
                 void setDescription(const std::string& description);
 
-                std::string getDescription() const;
+                const std::string& getDescription() const;
 
                 void setName(const std::string& name);
 
-                std::string getName() const;
+                const std::string& getName() const;
 
                 void setID(const std::string& id);
 
-                std::string getID() const;
+                const std::string& getID() const;
 
                 void setDatatype(const std::string& datatype);
 
-                std::string getDatatype() const;
+                const std::string& getDatatype() const;
 
                 void setArraysize(const std::string& arraysize);
 
-                std::string getArraysize() const;
+                const std::string& getArraysize() const;
 
                 void setUnit(const std::string& unit);
 
-                std::string getUnit() const;
+                const std::string& getUnit() const;
 
                 void setUCD(const std::string& ucd);
 
-                std::string getUCD() const;
+                const std::string& getUCD() const;
 
                 void setUType(const std::string& utype);
 
-                std::string getUType() const;
+                const std::string& getUType() const;
 
                 void setRef(const std::string& ref);
 
-                std::string getRef() const;
+                const std::string& getRef() const;
 
                 void setValue(const std::string& value);
 
-                std::string getValue() const;
+                const std::string& getValue() const;
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
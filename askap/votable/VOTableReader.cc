@@ -0,0 +1,576 @@
+/// @file VOTableReader.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#include "VOTableReader.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <istream>
+#include <fstream>
+
+// ASKAPsoft includes
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+#include "boost/algorithm/string/trim.hpp"
+#include "boost/scoped_ptr.hpp"
+#include "xercesc/sax/SAXParseException.hpp"
+#include "xercesc/sax2/Attributes.hpp"
+#include "xercesc/sax2/DefaultHandler.hpp"
+#include "xercesc/sax2/XMLReaderFactory.hpp"
+#include "xercesc/util/BinInputStream.hpp"
+#include "xercesc/util/PlatformUtils.hpp"
+#include "xercesc/util/TransService.hpp"
+#include "xercesc/util/XMLException.hpp"
+#include "xercesc/util/XMLString.hpp"
+#include "xercesc/util/XMLUni.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableCompression.h"
+#include "askap/votable/XercescString.h"
+#include "askap/votable/VOTableBinary2.h"
+#include "askap/votable/VOTableNames.h"
+
+ASKAP_LOGGER(logger, ".VOTableReader");
+
+using namespace askap;
+using namespace askap::accessors;
+using namespace xercesc;
+
+namespace {
+
+/// Input stream reading from a std::istream as it goes
+class IStreamBinInputStream : public BinInputStream {
+    public:
+        explicit IStreamBinInputStream(std::istream& is) : itsStream(is), itsPos(0) {}
+
+        virtual XMLFilePos curPos() const {
+            return itsPos;
+        }
+
+        virtual XMLSize_t readBytes(XMLByte* const toFill, const XMLSize_t maxToRead) {
+            itsStream.read(reinterpret_cast<char*>(toFill), maxToRead);
+            const XMLSize_t nRead = static_cast<XMLSize_t>(itsStream.gcount());
+            itsPos += nRead;
+            return nRead;
+        }
+
+        virtual const XMLCh* getContentType() const {
+            return 0;
+        }
+
+    private:
+        std::istream& itsStream;
+        XMLFilePos itsPos;
+};
+
+/// Input source for a std::istream (the stream is not buffered in memory as a whole)
+class IStreamInputSource : public InputSource {
+    public:
+        explicit IStreamInputSource(std::istream& is) : itsStream(is) {}
+
+        virtual BinInputStream* makeStream() const {
+            return new IStreamBinInputStream(itsStream);
+        }
+
+    private:
+        std::istream& itsStream;
+};
+
+/// Append characters to a string as UTF-8
+///
+/// ASCII text is appended directly, so that no temporary is allocated for the
+/// common case. Anything else goes through the transcoding service.
+void appendUTF8(const XMLCh* chars, XMLSize_t length, std::string& out)
+{
+    const std::string::size_type start = out.size();
+    out.resize(start + length);
+    for (XMLSize_t i = 0; i < length; ++i) {
+        if (chars[i] > 0x7F) {
+            out.resize(start);
+            TranscodeToStr utf8(chars, length, "UTF-8");
+            out.append(reinterpret_cast<const char*>(utf8.str()), utf8.length());
+            return;
+        }
+        out[start + i] = static_cast<char>(chars[i]);
+    }
+}
+
+/// Get an attribute as a string (empty if it is not present)
+std::string getAttribute(const Attributes& attrs, const XMLCh* name)
+{
+    const XMLCh* val = attrs.getValue(name);
+    std::string str;
+    if (val) {
+        appendUTF8(val, XMLString::stringLen(val), str);
+    }
+    return str;
+}
+
+}
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief SAX handler collecting fields and rows
+        ///
+        /// Only the state needed for the current row is kept. The text of cells which
+        /// are not selected is ignored. The BINARY2 stream is base64-decoded as it
+        /// arrives and its rows are decoded one at a time when they are requested.
+        class VOTableReaderHandler : public DefaultHandler {
+            public:
+                VOTableReaderHandler() : itsNTables(0), itsTableIndex(0), itsRowCounter(0),
+                    itsRowIndex(0), itsDataStarted(false), itsInField(false),
+                    itsInDescription(false), itsInRow(false), itsCell(0), itsColumn(0),
+                    itsRowReady(false), itsMappingValid(false), itsNSelected(0),
+                    itsInBinary2(false), itsInStream(false), itsStreamEnded(false), itsBinaryPos(0)
+                {
+                }
+
+                virtual void startElement(const XMLCh* const, const XMLCh* const,
+                                          const XMLCh* const qname, const Attributes& attrs)
+                {
+                    if (XMLString::equals(qname, VOTableNames::tagCell)) {
+                        if (itsInRow && (itsColumn < itsMapping.size()) && (itsMapping[itsColumn] >= 0)) {
+                            itsCell = &itsCells[itsMapping[itsColumn]];
+                        }
+                    } else if (XMLString::equals(qname, VOTableNames::tagRow)) {
+                        startRow();
+                    } else if (XMLString::equals(qname, VOTableNames::tagField)) {
+                        VOTableField f;
+                        f.setName(getAttribute(attrs, VOTableNames::attrName));
+                        f.setID(getAttribute(attrs, VOTableNames::attrID));
+                        f.setDatatype(getAttribute(attrs, VOTableNames::attrDatatype));
+                        f.setArraysize(getAttribute(attrs, VOTableNames::attrArraysize));
+                        f.setUnit(getAttribute(attrs, VOTableNames::attrUnit));
+                        f.setUCD(getAttribute(attrs, VOTableNames::attrUCD));
+                        f.setUType(getAttribute(attrs, VOTableNames::attrUType));
+                        f.setRef(getAttribute(attrs, VOTableNames::attrRef));
+                        itsFields.push_back(f);
+                        itsInField = true;
+                    } else if (itsInField && XMLString::equals(qname, VOTableNames::tagDescription)) {
+                        itsInDescription = true;
+                        itsText.clear();
+                    } else if (XMLString::equals(qname, VOTableNames::tagData)) {
+                        itsDataStarted = true;
+                    } else if (XMLString::equals(qname, VOTableNames::tagBinary2)) {
+                        itsInBinary2 = true;
+                    } else if (itsInBinary2 && XMLString::equals(qname, VOTableNames::tagStream)) {
+                        startStream(getAttribute(attrs, VOTableNames::attrEncoding));
+                    } else if (XMLString::equals(qname, VOTableNames::tagTable)) {
+                        ++itsNTables;
+                        itsCodec.reset();
+                        itsFields.clear();
+                        itsDataStarted = false;
+                        itsMappingValid = false;
+                        itsRowCounter = 0;
+                    }
+                }
+
+                virtual void endElement(const XMLCh* const, const XMLCh* const, const XMLCh* const qname)
+                {
+                    if (XMLString::equals(qname, VOTableNames::tagCell)) {
+                        if (itsCell) {
+                            boost::trim(*itsCell);
+                            itsCell = 0;
+                        }
+                        ++itsColumn;
+                    } else if (XMLString::equals(qname, VOTableNames::tagRow)) {
+                        if (itsInRow) {
+                            itsInRow = false;
+                            itsRowReady = true;
+                            itsTableIndex = itsNTables > 0 ? itsNTables - 1 : 0;
+                            itsRowIndex = itsRowCounter++;
+                        }
+                    } else if (itsInDescription && XMLString::equals(qname, VOTableNames::tagDescription)) {
+                        boost::trim(itsText);
+                        itsFields.back().setDescription(itsText);
+                        itsInDescription = false;
+                    } else if (XMLString::equals(qname, VOTableNames::tagField)) {
+                        itsInField = false;
+                    } else if (itsInStream && XMLString::equals(qname, VOTableNames::tagStream)) {
+                        itsInStream = false;
+                        itsStreamEnded = true;
+                    } else if (XMLString::equals(qname, VOTableNames::tagBinary2)) {
+                        itsInBinary2 = false;
+                    } else if (XMLString::equals(qname, VOTableNames::tagTable)) {
+                        // header is complete even if there is no DATA element
+                        itsDataStarted = true;
+                    }
+                }
+
+                virtual void characters(const XMLCh* const chars, const XMLSize_t length)
+                {
+                    if (itsInStream) {
+                        itsChars.clear();
+                        appendUTF8(chars, length, itsChars);
+                        if (!VOTableBinary2::decodeBase64(itsChars.data(), itsChars.size(),
+                                                          itsBase64, itsBinary) &&
+                                itsError.empty()) {
+                            itsError = "Invalid base64 data in the BINARY2 stream";
+                        }
+                        return;
+                    }
+                    std::string* target = itsCell ? itsCell : (itsInDescription ? &itsText : 0);
+                    if (target) {
+                        appendUTF8(chars, length, *target);
+                    }
+                }
+
+                void setSelection(const std::vector<std::string>& names)
+                {
+                    itsSelection = names;
+                    itsMappingValid = false;
+                }
+
+                /// Move the completed row to the caller
+                void takeRow(std::vector<std::string>& cells)
+                {
+                    ASKAPDEBUGASSERT(itsRowReady);
+                    cells.swap(itsCells);
+                    itsRowReady = false;
+                }
+
+                /// Check whether a row is complete, decoding the next binary row if possible
+                bool rowReady()
+                {
+                    if (!itsRowReady && itsCodec) {
+                        decodeBinaryRow();
+                    }
+                    return itsRowReady;
+                }
+
+                bool headerComplete() const { return itsDataStarted; }
+                const std::string& error() const { return itsError; }
+                const std::vector<VOTableField>& fields() const { return itsFields; }
+                size_t tableIndex() const { return itsTableIndex; }
+                size_t rowIndex() const { return itsRowIndex; }
+
+            private:
+
+                /// Prepare the decoding of a BINARY2 stream
+                void startStream(const std::string& encoding)
+                {
+                    if (encoding != "base64") {
+                        if (itsError.empty()) {
+                            itsError = "Unsupported encoding '" + encoding + "' of the BINARY2 stream";
+                        }
+                        return;
+                    }
+                    try {
+                        itsCodec.reset(new VOTableBinary2(itsFields));
+                    } catch (const AskapError& ex) {
+                        if (itsError.empty()) {
+                            itsError = ex.what();
+                        }
+                        return;
+                    }
+                    itsBinary.clear();
+                    itsBinaryPos = 0;
+                    itsBase64.clear();
+                    itsInStream = true;
+                    itsStreamEnded = false;
+                }
+
+                /// Decode the next row of the BINARY2 stream if it has been received
+                void decodeBinaryRow()
+                {
+                    if (!itsMappingValid) {
+                        buildMapping();
+                    }
+                    if (itsError.size()) {
+                        ASKAPTHROW(AskapError, itsError);
+                    }
+                    const unsigned char* data = itsBinary.empty() ? 0 : &itsBinary[0];
+                    if (itsCodec->decodeRow(data, itsBinary.size(), itsBinaryPos, itsBinaryCells)) {
+                        itsCells.resize(itsNSelected);
+                        for (size_t i = 0; i < itsMapping.size(); ++i) {
+                            if (itsMapping[i] >= 0) {
+                                itsCells[itsMapping[i]].swap(itsBinaryCells[i]);
+                            }
+                        }
+                        itsRowReady = true;
+                        itsTableIndex = itsNTables > 0 ? itsNTables - 1 : 0;
+                        itsRowIndex = itsRowCounter++;
+                    } else {
+                        // keep only the incomplete row
+                        itsBinary.erase(itsBinary.begin(), itsBinary.begin() + itsBinaryPos);
+                        itsBinaryPos = 0;
+                        if (itsStreamEnded) {
+                            itsCodec.reset();
+                            ASKAPCHECK(itsBinary.empty() && itsBase64.empty(),
+                                       "Truncated row in the BINARY2 stream");
+                        }
+                    }
+                }
+
+                /// Prepare the buffers for a new row
+                void startRow()
+                {
+                    if (!itsMappingValid) {
+                        buildMapping();
+                    }
+                    itsCells.resize(itsNSelected);
+                    for (std::vector<std::string>::iterator it = itsCells.begin(); it != itsCells.end(); ++it) {
+                        it->clear();
+                    }
+                    itsColumn = 0;
+                    itsInRow = true;
+                }
+
+                /// Work out the position of each column of the table in the returned row
+                void buildMapping()
+                {
+                    itsMapping.assign(itsFields.size(), -1);
+                    if (itsSelection.empty()) {
+                        for (size_t i = 0; i < itsFields.size(); ++i) {
+                            itsMapping[i] = static_cast<int>(i);
+                        }
+                        itsNSelected = itsFields.size();
+                    } else {
+                        for (size_t sel = 0; sel < itsSelection.size(); ++sel) {
+                            size_t i = 0;
+                            for (; i < itsFields.size(); ++i) {
+                                const std::string name = itsFields[i].getName().size() ?
+                                                         itsFields[i].getName() : itsFields[i].getID();
+                                if (name == itsSelection[sel]) {
+                                    break;
+                                }
+                            }
+                            if (i == itsFields.size()) {
+                                if (itsError.empty()) {
+                                    itsError = "Column " + itsSelection[sel] + " is not present in the table";
+                                }
+                            } else {
+                                itsMapping[i] = static_cast<int>(sel);
+                            }
+                        }
+                        itsNSelected = itsSelection.size();
+                    }
+                    itsMappingValid = true;
+                }
+
+                /// Number of TABLE elements started so far
+                size_t itsNTables;
+                /// Table of the last completed row
+                size_t itsTableIndex;
+                /// Number of rows completed in the current table
+                size_t itsRowCounter;
+                /// Number of the last completed row in its table
+                size_t itsRowIndex;
+                /// True if all FIELD elements of the current table are known
+                bool itsDataStarted;
+                bool itsInField;
+                bool itsInDescription;
+                bool itsInRow;
+                /// Cell being filled (null if the current cell is not selected)
+                std::string* itsCell;
+                /// Column of the current cell
+                size_t itsColumn;
+                bool itsRowReady;
+                bool itsMappingValid;
+                /// Fields of the current table
+                std::vector<VOTableField> itsFields;
+                /// Names of the selected columns (empty for all)
+                std::vector<std::string> itsSelection;
+                /// Position in the returned row for each column (-1 if not selected)
+                std::vector<int> itsMapping;
+                /// Number of cells in the returned row
+                size_t itsNSelected;
+                /// Cells of the current row
+                std::vector<std::string> itsCells;
+                /// Text of the current DESCRIPTION element
+                std::string itsText;
+                /// Error found while parsing (empty if none)
+                std::string itsError;
+                bool itsInBinary2;
+                bool itsInStream;
+                /// True once the end of the STREAM element has been parsed
+                bool itsStreamEnded;
+                /// Decoder of the rows of the BINARY2 stream (null if there is none)
+                boost::scoped_ptr<VOTableBinary2> itsCodec;
+                /// Decoded bytes of the BINARY2 stream not returned yet
+                std::vector<unsigned char> itsBinary;
+                /// Position of the next row in itsBinary
+                size_t itsBinaryPos;
+                /// Characters of an incomplete base64 group
+                std::string itsBase64;
+                /// All cells of the last binary row
+                std::vector<std::string> itsBinaryCells;
+                /// Buffer for the characters of the BINARY2 stream (reused)
+                std::string itsChars;
+        };
+
+    }
+}
+
+VOTableReader::VOTableReader(const std::string& filename)
+    : itsSource(0), itsHandler(0), itsParser(0), itsFinished(false)
+{
+    // Check if the file exists
+    std::ifstream fs(filename.c_str());
+    if (!fs) {
+        ASKAPTHROW(AskapError, "File " << filename << " could not be opened");
+    }
+    fs.close();
+
+    try {
+        // Plain files are read in place through a memory mapping
+        itsSource = VOTableCompression::makeInputSource(filename);
+        init();
+    } catch (...) {
+        cleanup();
+        throw;
+    }
+}
+
+VOTableReader::VOTableReader(std::istream& is)
+    : itsSource(0), itsHandler(0), itsParser(0), itsFinished(false)
+{
+    try {
+        itsSource = new IStreamInputSource(is);
+        init();
+    } catch (...) {
+        cleanup();
+        throw;
+    }
+}
+
+VOTableReader::~VOTableReader()
+{
+    cleanup();
+}
+
+void VOTableReader::cleanup()
+{
+    if (itsParser && !itsFinished) {
+        // Stop the progressive parse, so the input is released
+        itsParser->parseReset(itsToken);
+    }
+    delete itsParser;
+    delete itsHandler;
+    delete itsSource;
+}
+
+void VOTableReader::init()
+{
+    itsHandler = new VOTableReaderHandler;
+    itsParser = XMLReaderFactory::createXMLReader();
+    itsParser->setFeature(XMLUni::fgSAX2CoreValidation, false);
+    itsParser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
+    itsParser->setFeature(XMLUni::fgXercesSchema, false);
+    itsParser->setFeature(XMLUni::fgXercesLoadExternalDTD, false);
+    itsParser->setContentHandler(itsHandler);
+    itsParser->setErrorHandler(itsHandler);
+    try {
+        itsFinished = !itsParser->parseFirst(*itsSource, itsToken);
+    } catch (const SAXParseException& ex) {
+        itsFinished = true;
+        ASKAPTHROW(AskapError, "Error parsing VOTable at line " << ex.getLineNumber() << ": " <<
+                   std::string(XercescString(ex.getMessage())));
+    } catch (const XMLException& ex) {
+        itsFinished = true;
+        ASKAPTHROW(AskapError, "Error parsing VOTable: " << std::string(XercescString(ex.getMessage())));
+    }
+}
+
+bool VOTableReader::parseNext()
+{
+    if (itsFinished) {
+        return false;
+    }
+    try {
+        itsFinished = !itsParser->parseNext(itsToken);
+    } catch (const SAXParseException& ex) {
+        itsFinished = true;
+        ASKAPTHROW(AskapError, "Error parsing VOTable at line " << ex.getLineNumber() << ": " <<
+                   std::string(XercescString(ex.getMessage())));
+    } catch (const XMLException& ex) {
+        itsFinished = true;
+        ASKAPTHROW(AskapError, "Error parsing VOTable: " << std::string(XercescString(ex.getMessage())));
+    }
+    if (itsHandler->error().size()) {
+        ASKAPTHROW(AskapError, itsHandler->error());
+    }
+    return !itsFinished;
+}
+
+void VOTableReader::selectColumns(const std::vector<std::string>& names)
+{
+    itsHandler->setSelection(names);
+}
+
+const std::vector<VOTableField>& VOTableReader::getFields()
+{
+    while (!itsHandler->headerComplete() && parseNext()) {
+    }
+    return itsHandler->fields();
+}
+
+bool VOTableReader::next(std::vector<std::string>& cells)
+{
+    while (!itsHandler->rowReady()) {
+        if (!parseNext()) {
+            // the last row may complete with the last piece of the document
+            if (!itsHandler->rowReady()) {
+                return false;
+            }
+        }
+    }
+    itsHandler->takeRow(cells);
+    return true;
+}
+
+size_t VOTableReader::tableIndex() const
+{
+    return itsHandler->tableIndex();
+}
+
+size_t VOTableReader::rowIndex() const
+{
+    return itsHandler->rowIndex();
+}
+
+size_t VOTableReader::forEachRow(const std::string& filename, const RowCallback& callback,
+                                 const std::vector<std::string>& names)
+{
+    VOTableReader reader(filename);
+    reader.selectColumns(names);
+    std::vector<std::string> cells;
+    size_t nRows = 0;
+    while (reader.next(cells)) {
+        ++nRows;
+        if (!callback(cells)) {
+            break;
+        }
+    }
+    ASKAPLOG_DEBUG_STR(logger, nRows << " rows have been read from " << filename);
+    return nRows;
+}
@@ -0,0 +1,179 @@
+/// @file VOTableReader.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEREADER_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEREADER_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <istream>
+
+// ASKAPsoft includes
+#include "boost/function.hpp"
+#include "boost/utility.hpp"
+#include "xercesc/framework/XMLPScanToken.hpp"
+#include "xercesc/sax/InputSource.hpp"
+#include "xercesc/sax2/SAX2XMLReader.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableField.h"
+#include "askap/votable/XercescPlatform.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief SAX handler collecting fields and rows (defined in the .cc file)
+        class VOTableReaderHandler;
+
+        /// @brief Streaming reader of the rows of a VOTable
+        ///
+        /// Unlike VOTable::fromXML, which builds the DOM of the whole document, this
+        /// class parses the XML progressively with the SAX2 interface of Xerces and
+        /// keeps only the current row in memory, so catalogues of any size can be
+        /// read with constant memory. Rows of all TABLE elements (TABLEDATA or
+        /// BINARY2 serialisation) are returned in the document order. Only the
+        /// selected columns are kept, the text of other TD cells is not even
+        /// copied. Binary cells are converted to their TABLEDATA text. Reading
+        /// can be stopped at any time by simply destroying the reader. A typical
+        /// usage is
+        /// @code
+        ///    VOTableReader reader("catalogue.xml");
+        ///    reader.selectColumns(names);
+        ///    std::vector<std::string> cells;
+        ///    while (reader.next(cells)) {
+        ///        process(cells);
+        ///    }
+        /// @endcode
+        ///
+        /// @ingroup votableaccess
+        class VOTableReader : private boost::noncopyable {
+            public:
+
+                /// Callback receiving the cells of a row, returns false to stop reading
+                typedef boost::function<bool (const std::vector<std::string>&)> RowCallback;
+
+                /// @brief Constructor
+                ///
+                /// gzip and zstd files are decompressed while they are parsed
+                /// (see VOTableCompression).
+                /// @param[in] filename the file/path to read the XML input from.
+                /// @throw AskapError   if the specified file cannot be opened.
+                explicit VOTableReader(const std::string& filename);
+
+                /// @brief Constructor
+                ///
+                /// The stream is read progressively, it should outlive the reader.
+                /// @param[in] is   an istream from which the XML input will be read.
+                explicit VOTableReader(std::istream& is);
+
+                /// @brief Destructor, stops parsing
+                ~VOTableReader();
+
+                /// Select the columns to read
+                ///
+                /// The cells of the rows returned by next are the selected columns in the
+                /// given order. Columns are matched by the name attribute of the FIELD
+                /// element (or its ID if there is no such name). An empty vector (the
+                /// default) selects all columns in the table order. The selection applies
+                /// to the rows read after this call.
+                /// @param[in] names    names of the columns
+                void selectColumns(const std::vector<std::string>& names);
+
+                /// Get the FIELD elements of the current table
+                ///
+                /// The document is parsed up to the data of the first table if necessary.
+                /// After next has returned a row, the fields of the table this row
+                /// belongs to are returned.
+                /// @return all fields of the table (regardless of the column selection)
+                const std::vector<VOTableField>& getFields();
+
+                /// Read the next row
+                ///
+                /// @param[out] cells   the selected cells of the row (the vector and the
+                ///                     strings in it are reused)
+                /// @return false if there are no more rows
+                /// @throw AskapError   if the document is not a valid VOTable or a
+                ///                     selected column doesn't exist.
+                bool next(std::vector<std::string>& cells);
+
+                /// Get the number of the table the last row belongs to
+                ///
+                /// @return zero-based number of the TABLE element in the document
+                size_t tableIndex() const;
+
+                /// Get the number of the last row in its table
+                ///
+                /// @return zero-based number of the row
+                size_t rowIndex() const;
+
+                /// Read all rows of a VOTable file with a callback
+                ///
+                /// @param[in] filename the file/path to read the XML input from.
+                /// @param[in] callback function called for each row, reading stops if
+                ///                     it returns false.
+                /// @param[in] names    names of the columns to read (empty for all).
+                /// @return the number of rows passed to the callback.
+                static size_t forEachRow(const std::string& filename, const RowCallback& callback,
+                                         const std::vector<std::string>& names = std::vector<std::string>());
+
+            private:
+
+                /// Set up the parser and start parsing
+                void init();
+
+                /// Stop parsing and release the parser
+                void cleanup();
+
+                /// Parse the next piece of the document
+                ///
+                /// @return false if the end of the document is reached.
+                bool parseNext();
+
+                /// Keeps Xerces initialised, declared first so it outlives the parser
+                XercescPlatform itsPlatform;
+
+                /// The input
+                xercesc::InputSource* itsSource;
+
+                /// The SAX handler
+                VOTableReaderHandler* itsHandler;
+
+                /// The parser
+                xercesc::SAX2XMLReader* itsParser;
+
+                /// Token keeping the state of the progressive parse
+                xercesc::XMLPScanToken itsToken;
+
+                /// True if the end of the document is reached
+                bool itsFinished;
+        };
+
+    }
+}
+
+#endif
@@ -33,6 +33,7 @@
 // System includes
 #include <string>
 #include <vector>
+#include <utility>
 
 // ASKAPsoft includes
 #include "askap/AskapLogging.h"
@@ -42,6 +43,7 @@
 // Local package includes
 #include "askap/votable/XercescString.h"
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableNames.h"
 #include "askap/votable/VOTableInfo.h"
 #include "askap/votable/VOTableTable.h"
 
@@ -60,7 +62,7 @@ void VOTableResource::setDescription(const std::string& description)
     itsDescription = description;
 }
 
-std::string VOTableResource::getDescription() const
+const std::string& VOTableResource::getDescription() const
 {
     return itsDescription;
 }
@@ -70,7 +72,7 @@ void VOTableResource::setName(const std::string& name)
     itsName = name;
 }
 
-std::string VOTableResource::getName() const
+const std::string& VOTableResource::getName() const
 {
     return itsName;
 }
@@ -80,7 +82,7 @@ void VOTableResource::setID(const std::string& ID)
     itsID = ID;
 }
 
-std::string VOTableResource::getID() const
+const std::string& VOTableResource::getID() const
 {
     return itsID;
 }
@@ -90,7 +92,7 @@ void VOTableResource::setType(const std::string& type)
     itsType = type;
 }
 
-std::string VOTableResource::getType() const
+const std::string& VOTableResource::getType() const
 {
     return itsType;
 }
@@ -100,7 +102,7 @@ void VOTableResource::addInfo(const VOTableInfo& info)
     itsInfo.push_back(info);
 }
 
-std::vector<VOTableInfo> VOTableResource::getInfo() const
+const std::vector<VOTableInfo>& VOTableResource::getInfo() const
 {
     return itsInfo;
 }
@@ -110,29 +112,36 @@ void VOTableResource::addTable(const VOTableTable& table)
     itsTables.push_back(table);
 }
 
-std::vector<VOTableTable> VOTableResource::getTables() const
+#if __cplusplus >= 201103L
+void VOTableResource::addTable(VOTableTable&& table)
+{
+    itsTables.push_back(std::move(table));
+}
+#endif
+
+const std::vector<VOTableTable>& VOTableResource::getTables() const
 {
     return itsTables;
 }
 
 xercesc::DOMElement* VOTableResource::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("RESOURCE"));
+    DOMElement* e = doc.createElement(VOTableNames::tagResource);
 
     // Add attributes
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableNames::attrID, XercescString(itsID));
     }
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableNames::attrName, XercescString(itsName));
     }
     if (itsType.length() > 0) {
-        e->setAttribute(XercescString("type"), XercescString(itsType));
+        e->setAttribute(VOTableNames::attrType, XercescString(itsType));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableNames::tagDescription);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -158,15 +167,15 @@ VOTableResource VOTableResource::fromXmlElement(const xercesc::DOMElement& e)
     VOTableResource res;
 
     // Get attributes
-    res.setID(XercescUtils::getAttribute(e, "ID"));
-    res.setName(XercescUtils::getAttribute(e, "name"));
-    res.setType(XercescUtils::getAttribute(e, "type"));
+    res.setID(XercescUtils::getAttribute(e, VOTableNames::attrID));
+    res.setName(XercescUtils::getAttribute(e, VOTableNames::attrName));
+    res.setType(XercescUtils::getAttribute(e, VOTableNames::attrType));
 
     // Get description
     res.setDescription(XercescUtils::getDescription(e));
 
     // Process INFO
-    DOMNodeList* children = e.getElementsByTagName(XercescString("INFO"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableNames::tagInfo);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableInfo info = VOTableInfo::fromXmlElement(*node);
@@ -174,11 +183,10 @@ VOTableResource VOTableResource::fromXmlElement(const xercesc::DOMElement& e)
     }
 
     // Process TABLE
-    children = e.getElementsByTagName(XercescString("TABLE"));
+    children = e.getElementsByTagName(VOTableNames::tagTable);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
-        const VOTableTable tab = VOTableTable::fromXmlElement(*node);
-        res.addTable(tab);
+        res.addTable(VOTableTable::fromXmlElement(*node));
     }
 
     return res;
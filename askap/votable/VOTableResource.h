@@ -51,22 +51,25 @@ namespace askap {
                 VOTableResource();
 
                 void setDescription(const std::string& description);
-                std::string getDescription() const;
+                const std::string& getDescription() const;
 
                 void setName(const std::string& name);
-                std::string getName() const;
+                const std::string& getName() const;
 
                 void setID(const std::string& ID);
-                std::string getID() const;
+                const std::string& getID() const;
 
                 void setType(const std::string& type);
-                std::string getType() const;
+                const std::string& getType() const;
 
                 void addInfo(const VOTableInfo& info);
-                std::vector<VOTableInfo> getInfo() const;
+                const std::vector<VOTableInfo>& getInfo() const;
 
                 void addTable(const VOTableTable& table);
-                std::vector<VOTableTable> getTables() const;
+#if __cplusplus >= 201103L
+                void addTable(VOTableTable&& table);
+#endif
+                const std::vector<VOTableTable>& getTables() const;
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
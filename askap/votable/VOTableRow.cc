@@ -33,6 +33,7 @@
 // System includes
 # include <vector>
 # include <string>
+# include <utility>
 
 // ASKAPsoft includes
 #include "askap/AskapLogging.h"
@@ -42,6 +43,7 @@
 
 // Local package includes
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableNames.h"
 #include "askap/votable/XercescString.h"
 
 ASKAP_LOGGER(logger, ".VOTableRow");
@@ -59,18 +61,25 @@ void VOTableRow::addCell(const std::string& cell)
     itsCells.push_back(cell);
 }
 
-std::vector<std::string> VOTableRow::getCells() const
+#if __cplusplus >= 201103L
+void VOTableRow::addCell(std::string&& cell)
+{
+    itsCells.push_back(std::move(cell));
+}
+#endif
+
+const std::vector<std::string>& VOTableRow::getCells() const
 {
     return itsCells;
 }
 
 xercesc::DOMElement* VOTableRow::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* tr = doc.createElement(XercescString("TR"));
+    DOMElement* tr = doc.createElement(VOTableNames::tagRow);
 
     for (std::vector<std::string>::const_iterator it = itsCells.begin();
             it != itsCells.end(); ++it) {
-        DOMElement* td = doc.createElement(XercescString("TD"));
+        DOMElement* td = doc.createElement(VOTableNames::tagCell);
         DOMText* text = doc.createTextNode(XercescString(*it));
         td->appendChild(text);
         tr->appendChild(td);
@@ -84,14 +93,14 @@ VOTableRow VOTableRow::fromXmlElement(const xercesc::DOMElement& e)
     VOTableRow r;
 
     // Process TD
-    DOMNodeList* children = e.getElementsByTagName(XercescString("TD"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableNames::tagCell);
     const XMLSize_t nCells = children->getLength();
+    r.itsCells.reserve(nCells);
     for (XMLSize_t i = 0; i < nCells; ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const DOMText* text = dynamic_cast<xercesc::DOMText*>(node->getChildNodes()->item(0));
-        std::string str = XercescUtils::getStringFromDOMText(*text);
-        boost::trim(str);
-        r.addCell(str);
+        r.itsCells.push_back(XercescUtils::getStringFromDOMText(*text));
+        boost::trim(r.itsCells.back());
     }
 
     return r;
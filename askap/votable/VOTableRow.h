@@ -47,7 +47,10 @@ namespace askap {
                 VOTableRow();
 
                 void addCell(const std::string& cell);
-                std::vector<std::string> getCells() const;
+#if __cplusplus >= 201103L
+                void addCell(std::string&& cell);
+#endif
+                const std::vector<std::string>& getCells() const;
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
@@ -0,0 +1,363 @@
+/// @file VOTableSkyIndex.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+// Include own header file first
+#include "VOTableSkyIndex.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// ASKAPsoft includes
+#include "askap/AskapError.h"
+#include "askap/AskapLogging.h"
+#include "boost/algorithm/string/predicate.hpp"
+#include "boost/algorithm/string/split.hpp"
+#include "boost/algorithm/string/trim.hpp"
+#include "boost/bind.hpp"
+#include "boost/thread/thread.hpp"
+
+ASKAP_LOGGER(logger, ".VOTableSkyIndex");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+const double pi = 4.0 * std::atan(1.0);
+
+/// Ranges smaller than this are not worth a thread
+const size_t minParallelSize = 10000;
+
+/// Orders points along one axis
+template <class Point>
+class AxisLess {
+    public:
+        explicit AxisLess(unsigned axis) : itsAxis(axis) {}
+
+        bool operator()(const Point& a, const Point& b) const {
+            return a.xyz[itsAxis] < b.xyz[itsAxis];
+        }
+
+    private:
+        unsigned itsAxis;
+};
+
+/// Squared distance of two unit vectors
+inline double distance2(const double* a, const double* b)
+{
+    const double dx = a[0] - b[0];
+    const double dy = a[1] - b[1];
+    const double dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/// Returns true if a UCD contains the given word
+bool hasWord(const std::string& ucd, const std::string& word)
+{
+    std::vector<std::string> words;
+    boost::split(words, ucd, boost::is_any_of(";"));
+    for (std::vector<std::string>::iterator it = words.begin(); it != words.end(); ++it) {
+        boost::trim(*it);
+        if (boost::iequals(*it, word)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Find the field with a UCD word, preferring the main one
+size_t findField(const std::vector<VOTableField>& fields, const std::string& word)
+{
+    size_t found = fields.size();
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (hasWord(fields[i].getUCD(), word)) {
+            if (hasWord(fields[i].getUCD(), "meta.main")) {
+                return i;
+            }
+            if (found == fields.size()) {
+                found = i;
+            }
+        }
+    }
+    ASKAPCHECK(found < fields.size(), "No column with UCD " << word << " in the table");
+    return found;
+}
+
+}
+
+VOTableSkyIndex::VOTableSkyIndex(const VOTableTable& table, size_t nThreads)
+    : itsRAColumn(0), itsDecColumn(0), itsRAScale(1.0), itsDecScale(1.0)
+{
+    findColumns(table.getFields());
+
+    const std::vector<VOTableRow>& rows = table.getRows();
+    itsPoints.reserve(rows.size());
+    for (size_t row = 0; row < rows.size(); ++row) {
+        const std::vector<std::string>& cells = rows[row].getCells();
+        if (itsRAColumn < cells.size() && itsDecColumn < cells.size() &&
+                !cells[itsRAColumn].empty() && !cells[itsDecColumn].empty()) {
+            addPoint(VOTableColumn::parseReal(cells[itsRAColumn]),
+                     VOTableColumn::parseReal(cells[itsDecColumn]), row);
+        }
+    }
+
+    unsigned threadDepth = 0;
+    while ((size_t(1) << threadDepth) < nThreads) {
+        ++threadDepth;
+    }
+    build(0, itsPoints.size(), 0, threadDepth);
+    ASKAPLOG_DEBUG_STR(logger, "Indexed " << itsPoints.size() << " of " << rows.size() << " rows");
+}
+
+VOTableSkyIndex::VOTableSkyIndex(const VOTableColumns& columns, size_t nThreads)
+    : itsRAColumn(0), itsDecColumn(0), itsRAScale(1.0), itsDecScale(1.0)
+{
+    std::vector<VOTableField> fields;
+    fields.reserve(columns.nColumns());
+    for (size_t i = 0; i < columns.nColumns(); ++i) {
+        fields.push_back(columns.getColumn(i).getField());
+    }
+    findColumns(fields);
+
+    // typed columns are read directly, others are converted from their text
+    const VOTableColumn& ra = columns.getColumn(itsRAColumn);
+    const VOTableColumn& dec = columns.getColumn(itsDecColumn);
+    std::vector<double> raValues;
+    std::vector<double> decValues;
+    const VOTableColumn* const cols[2] = {&ra, &dec};
+    std::vector<double>* const values[2] = {&raValues, &decValues};
+    for (size_t c = 0; c < 2; ++c) {
+        const VOTableColumn& col = *cols[c];
+        if (col.getType() == VOTableColumn::DOUBLE) {
+            *values[c] = col.getDoubleValues();
+        } else if (col.getType() == VOTableColumn::FLOAT) {
+            values[c]->assign(col.getFloatValues().begin(), col.getFloatValues().end());
+        } else {
+            values[c]->resize(col.size());
+            for (size_t row = 0; row < col.size(); ++row) {
+                if (!col.isNull(row)) {
+                    (*values[c])[row] = VOTableColumn::parseReal(col.getCell(row));
+                }
+            }
+        }
+    }
+
+    itsPoints.reserve(columns.nRows());
+    for (size_t row = 0; row < columns.nRows(); ++row) {
+        if (!ra.isNull(row) && !dec.isNull(row)) {
+            addPoint(raValues[row], decValues[row], row);
+        }
+    }
+
+    unsigned threadDepth = 0;
+    while ((size_t(1) << threadDepth) < nThreads) {
+        ++threadDepth;
+    }
+    build(0, itsPoints.size(), 0, threadDepth);
+    ASKAPLOG_DEBUG_STR(logger, "Indexed " << itsPoints.size() << " of " << columns.nRows() << " rows");
+}
+
+size_t VOTableSkyIndex::size() const
+{
+    return itsPoints.size();
+}
+
+size_t VOTableSkyIndex::raColumn() const
+{
+    return itsRAColumn;
+}
+
+size_t VOTableSkyIndex::decColumn() const
+{
+    return itsDecColumn;
+}
+
+std::vector<size_t> VOTableSkyIndex::cone(double ra, double dec, double radius) const
+{
+    double centre[3];
+    toVector(ra, dec, centre);
+    // compare chords rather than angles, a radius of 180 deg or more is the whole sky
+    const double chord = radius < 180.0 ? 2.0 * std::sin(radius * pi / 360.0) : 2.0;
+    std::vector<size_t> rows;
+    if (radius >= 0.0) {
+        searchCone(0, itsPoints.size(), 0, centre, chord * chord, rows);
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+std::vector<size_t> VOTableSkyIndex::nearest(double ra, double dec, size_t k) const
+{
+    double position[3];
+    toVector(ra, dec, position);
+    std::vector<Candidate> heap;
+    if (k > 0) {
+        heap.reserve(std::min(k, itsPoints.size()) + 1);
+        searchNearest(0, itsPoints.size(), 0, position, k, heap);
+    }
+    std::sort_heap(heap.begin(), heap.end());
+    std::vector<size_t> rows;
+    rows.reserve(heap.size());
+    for (std::vector<Candidate>::const_iterator it = heap.begin(); it != heap.end(); ++it) {
+        rows.push_back(it->second);
+    }
+    return rows;
+}
+
+double VOTableSkyIndex::separation(double ra1, double dec1, double ra2, double dec2)
+{
+    double a[3];
+    double b[3];
+    toVector(ra1, dec1, a);
+    toVector(ra2, dec2, b);
+    // the chord gives an accurate angle at all separations
+    const double chord = std::min(std::sqrt(distance2(a, b)), 2.0);
+    return 2.0 * std::asin(chord / 2.0) * 180.0 / pi;
+}
+
+void VOTableSkyIndex::findColumns(const std::vector<VOTableField>& fields)
+{
+    itsRAColumn = findField(fields, "pos.eq.ra");
+    itsDecColumn = findField(fields, "pos.eq.dec");
+    itsRAScale = toRadians(fields[itsRAColumn].getUnit()) * 180.0 / pi;
+    itsDecScale = toRadians(fields[itsDecColumn].getUnit()) * 180.0 / pi;
+}
+
+void VOTableSkyIndex::addPoint(double ra, double dec, size_t row)
+{
+    if (std::isfinite(ra) && std::isfinite(dec)) {
+        Point p;
+        toVector(ra * itsRAScale, dec * itsDecScale, p.xyz);
+        p.row = row;
+        itsPoints.push_back(p);
+    }
+}
+
+void VOTableSkyIndex::build(size_t lo, size_t hi, unsigned depth, unsigned threadDepth)
+{
+    if (hi - lo < 2) {
+        return;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(itsPoints.begin() + lo, itsPoints.begin() + mid, itsPoints.begin() + hi,
+                     AxisLess<Point>(depth % 3));
+
+    if (threadDepth > 0 && hi - lo >= minParallelSize) {
+        // the two halves are disjoint, one of them is built by another thread
+        boost::thread left(boost::bind(&VOTableSkyIndex::build, this, lo, mid,
+                                       depth + 1, threadDepth - 1));
+        build(mid + 1, hi, depth + 1, threadDepth - 1);
+        left.join();
+    } else {
+        build(lo, mid, depth + 1, 0);
+        build(mid + 1, hi, depth + 1, 0);
+    }
+}
+
+void VOTableSkyIndex::searchCone(size_t lo, size_t hi, unsigned depth, const double* xyz,
+                                 double chord2, std::vector<size_t>& rows) const
+{
+    if (lo >= hi) {
+        return;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    const Point& p = itsPoints[mid];
+    if (distance2(p.xyz, xyz) <= chord2) {
+        rows.push_back(p.row);
+    }
+    const double diff = xyz[depth % 3] - p.xyz[depth % 3];
+    if (diff <= 0.0 || diff * diff <= chord2) {
+        searchCone(lo, mid, depth + 1, xyz, chord2, rows);
+    }
+    if (diff >= 0.0 || diff * diff <= chord2) {
+        searchCone(mid + 1, hi, depth + 1, xyz, chord2, rows);
+    }
+}
+
+void VOTableSkyIndex::searchNearest(size_t lo, size_t hi, unsigned depth, const double* xyz,
+                                    size_t k, std::vector<Candidate>& heap) const
+{
+    if (lo >= hi) {
+        return;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    const Point& p = itsPoints[mid];
+
+    // keep the k best candidates in a max-heap on the distance
+    const double d2 = distance2(p.xyz, xyz);
+    if (heap.size() < k) {
+        heap.push_back(Candidate(d2, p.row));
+        std::push_heap(heap.begin(), heap.end());
+    } else if (d2 < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = Candidate(d2, p.row);
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    // search the side of the position first, the other one only if it can be closer
+    const double diff = xyz[depth % 3] - p.xyz[depth % 3];
+    if (diff <= 0.0) {
+        searchNearest(lo, mid, depth + 1, xyz, k, heap);
+        if (heap.size() < k || diff * diff < heap.front().first) {
+            searchNearest(mid + 1, hi, depth + 1, xyz, k, heap);
+        }
+    } else {
+        searchNearest(mid + 1, hi, depth + 1, xyz, k, heap);
+        if (heap.size() < k || diff * diff < heap.front().first) {
+            searchNearest(lo, mid, depth + 1, xyz, k, heap);
+        }
+    }
+}
+
+void VOTableSkyIndex::toVector(double ra, double dec, double* xyz)
+{
+    const double alpha = ra * pi / 180.0;
+    const double delta = dec * pi / 180.0;
+    xyz[0] = std::cos(delta) * std::cos(alpha);
+    xyz[1] = std::cos(delta) * std::sin(alpha);
+    xyz[2] = std::sin(delta);
+}
+
+double VOTableSkyIndex::toRadians(const std::string& unit)
+{
+    if (unit.empty() || unit == "deg") {
+        return pi / 180.0;
+    } else if (unit == "rad") {
+        return 1.0;
+    } else if (unit == "arcmin") {
+        return pi / 180.0 / 60.0;
+    } else if (unit == "arcsec") {
+        return pi / 180.0 / 3600.0;
+    }
+    ASKAPTHROW(AskapError, "Unsupported unit '" << unit << "' of a sky position");
+}
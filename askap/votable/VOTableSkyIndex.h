@@ -0,0 +1,170 @@
+/// @file VOTableSkyIndex.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLESKYINDEX_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLESKYINDEX_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <utility>
+
+// Local package includes
+#include "askap/votable/VOTableColumns.h"
+#include "askap/votable/VOTableField.h"
+#include "askap/votable/VOTableTable.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Spatial index of the sky positions of the rows of a table
+        ///
+        /// The position columns are identified by their UCD (pos.eq.ra and
+        /// pos.eq.dec, a column with meta.main is preferred) and converted with
+        /// the unit of their field (deg if not given, rad, arcmin or arcsec).
+        /// Positions are stored as unit vectors in a balanced k-d tree, so cone
+        /// and nearest neighbour searches take logarithmic time instead of a scan
+        /// of the whole table, with no special case at the poles or at RA 0. Rows
+        /// with a null position are not indexed. The index refers to rows by
+        /// their index in the table, it is not updated if the table changes.
+        /// @code
+        ///    const VOTableSkyIndex index(table, 4);
+        ///    const std::vector<size_t> rows = index.cone(187.5, 2.05, 0.1);
+        /// @endcode
+        ///
+        /// @ingroup votableaccess
+        class VOTableSkyIndex {
+            public:
+
+                /// @brief Build the index of a table
+                ///
+                /// @param[in] table    the table with the position columns
+                /// @param[in] nThreads number of threads used to build the tree
+                /// @throw AskapError   if the position columns cannot be found
+                ///                     or a position cannot be converted.
+                explicit VOTableSkyIndex(const VOTableTable& table, size_t nThreads = 1);
+
+                /// @brief Build the index of a columnar table
+                ///
+                /// @param[in] columns  the table with the position columns
+                /// @param[in] nThreads number of threads used to build the tree
+                /// @throw AskapError   if the position columns cannot be found
+                ///                     or a position cannot be converted.
+                explicit VOTableSkyIndex(const VOTableColumns& columns, size_t nThreads = 1);
+
+                /// Returns the number of indexed rows
+                size_t size() const;
+
+                /// Returns the index of the RA column in the table
+                size_t raColumn() const;
+
+                /// Returns the index of the Dec column in the table
+                size_t decColumn() const;
+
+                /// @brief Search the rows within a cone
+                ///
+                /// @param[in] ra       right ascension of the centre (deg)
+                /// @param[in] dec      declination of the centre (deg)
+                /// @param[in] radius   radius of the cone (deg)
+                /// @return the rows within the cone, in increasing order.
+                std::vector<size_t> cone(double ra, double dec, double radius) const;
+
+                /// @brief Search the nearest rows of a position
+                ///
+                /// @param[in] ra       right ascension (deg)
+                /// @param[in] dec      declination (deg)
+                /// @param[in] k        number of rows to return
+                /// @return the k nearest rows (fewer if the index is smaller),
+                ///         the nearest first.
+                std::vector<size_t> nearest(double ra, double dec, size_t k = 1) const;
+
+                /// @brief Angular separation of two positions
+                ///
+                /// @param[in] ra1      right ascension of the first position (deg)
+                /// @param[in] dec1     declination of the first position (deg)
+                /// @param[in] ra2      right ascension of the second position (deg)
+                /// @param[in] dec2     declination of the second position (deg)
+                /// @return the separation (deg).
+                static double separation(double ra1, double dec1, double ra2, double dec2);
+
+            private:
+                /// A position on the unit sphere and its row
+                struct Point {
+                    double xyz[3];
+                    size_t row;
+                };
+
+                /// Candidate of a nearest neighbour search
+                typedef std::pair<double, size_t> Candidate;
+
+                /// Find the fields of the positions
+                void findColumns(const std::vector<VOTableField>& fields);
+
+                /// Add a position, in the units of the fields
+                void addPoint(double ra, double dec, size_t row);
+
+                /// Build the tree of the points in [lo, hi)
+                ///
+                /// Each node is the median of its range along the axis depth % 3,
+                /// the two halves of the range are the subtrees. The subtrees
+                /// of the first threadDepth levels are built in parallel.
+                void build(size_t lo, size_t hi, unsigned depth, unsigned threadDepth);
+
+                /// Search the tree of the points in [lo, hi) for a cone
+                void searchCone(size_t lo, size_t hi, unsigned depth, const double* xyz,
+                                double chord2, std::vector<size_t>& rows) const;
+
+                /// Search the tree of the points in [lo, hi) for nearest neighbours
+                void searchNearest(size_t lo, size_t hi, unsigned depth, const double* xyz,
+                                   size_t k, std::vector<Candidate>& heap) const;
+
+                /// Convert a position (deg) to a unit vector
+                static void toVector(double ra, double dec, double* xyz);
+
+                /// Returns the conversion factor to radians of an angle unit
+                static double toRadians(const std::string& unit);
+
+                /// Index of the RA column
+                size_t itsRAColumn;
+
+                /// Index of the Dec column
+                size_t itsDecColumn;
+
+                /// Conversion factor of RA to degrees
+                double itsRAScale;
+
+                /// Conversion factor of Dec to degrees
+                double itsDecScale;
+
+                /// The points, ordered as an implicit k-d tree
+                std::vector<Point> itsPoints;
+        };
+
+    }
+}
+
+#endif
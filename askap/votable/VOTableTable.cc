@@ -33,6 +33,7 @@
 // System includes
 #include <string>
 #include <vector>
+#include <utility>
 
 // ASKAPsoft includes
 #include "askap/AskapLogging.h"
@@ -42,8 +43,10 @@
 // Local package includes
 #include "askap/votable/XercescString.h"
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableNames.h"
 #include "askap/votable/VOTableField.h"
 #include "askap/votable/VOTableRow.h"
+#include "askap/votable/VOTableBinary2.h"
 
 ASKAP_LOGGER(logger, ".VOTableTable");
 
@@ -51,7 +54,7 @@ using namespace askap;
 using namespace askap::accessors;
 using namespace xercesc;
 
-VOTableTable::VOTableTable()
+VOTableTable::VOTableTable() : itsSerialisation(TABLEDATA)
 {
 }
 
@@ -60,7 +63,7 @@ void VOTableTable::setID(const std::string& id)
     itsID = id;
 }
 
-std::string VOTableTable::getID() const
+const std::string& VOTableTable::getID() const
 {
     return itsID;
 }
@@ -70,7 +73,7 @@ void VOTableTable::setName(const std::string& name)
     itsName = name;
 }
 
-std::string VOTableTable::getName() const
+const std::string& VOTableTable::getName() const
 {
     return itsName;
 }
@@ -80,11 +83,21 @@ void VOTableTable::setDescription(const std::string& description)
     itsDescription = description;
 }
 
-std::string VOTableTable::getDescription() const
+const std::string& VOTableTable::getDescription() const
 {
     return itsDescription;
 }
 
+void VOTableTable::setSerialisation(Serialisation serialisation)
+{
+    itsSerialisation = serialisation;
+}
+
+VOTableTable::Serialisation VOTableTable::getSerialisation() const
+{
+    return itsSerialisation;
+}
+
 void VOTableTable::addGroup(const VOTableGroup& group)
 {
     itsGroups.push_back(group);
@@ -100,36 +113,48 @@ void VOTableTable::addRow(const VOTableRow& row)
     itsRows.push_back(row);
 }
 
-std::vector<VOTableGroup> VOTableTable::getGroups() const
+#if __cplusplus >= 201103L
+void VOTableTable::addRow(VOTableRow&& row)
+{
+    itsRows.push_back(std::move(row));
+}
+#endif
+
+void VOTableTable::reserveRows(size_t nRows)
+{
+    itsRows.reserve(nRows);
+}
+
+const std::vector<VOTableGroup>& VOTableTable::getGroups() const
 {
     return itsGroups;
 }
 
-std::vector<VOTableField> VOTableTable::getFields() const
+const std::vector<VOTableField>& VOTableTable::getFields() const
 {
     return itsFields;
 }
 
-std::vector<VOTableRow> VOTableTable::getRows() const
+const std::vector<VOTableRow>& VOTableTable::getRows() const
 {
     return itsRows;
 }
 
 xercesc::DOMElement* VOTableTable::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("TABLE"));
+    DOMElement* e = doc.createElement(VOTableNames::tagTable);
 
     // Add attributes
     if (itsID.length()) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableNames::attrID, XercescString(itsID));
     }
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableNames::attrName, XercescString(itsName));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableNames::tagDescription);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -148,11 +173,31 @@ xercesc::DOMElement* VOTableTable::toXmlElement(xercesc::DOMDocument& doc) const
     }
 
     // Create DATA element
-    DOMElement* dataElement = doc.createElement(XercescString("DATA"));
+    DOMElement* dataElement = doc.createElement(VOTableNames::tagData);
     e->appendChild(dataElement);
 
+    if (itsSerialisation == BINARY2) {
+        // Create BINARY2 and STREAM elements, the rows are base64-encoded
+        DOMElement* binaryElement = doc.createElement(VOTableNames::tagBinary2);
+        dataElement->appendChild(binaryElement);
+        DOMElement* streamElement = doc.createElement(VOTableNames::tagStream);
+        streamElement->setAttribute(VOTableNames::attrEncoding, XercescString("base64"));
+        binaryElement->appendChild(streamElement);
+
+        const VOTableBinary2 codec(itsFields);
+        std::vector<unsigned char> buf;
+        for (std::vector<VOTableRow>::const_iterator it = itsRows.begin();
+                it != itsRows.end(); ++it) {
+            codec.encodeRow(it->getCells(), buf);
+        }
+        std::string text;
+        VOTableBinary2::encodeBase64(buf.empty() ? 0 : &buf[0], buf.size(), true, text);
+        streamElement->appendChild(doc.createTextNode(XercescString(text)));
+        return e;
+    }
+
     // Create TABLEDATA element
-    DOMElement* tableDataElement = doc.createElement(XercescString("TABLEDATA"));
+    DOMElement* tableDataElement = doc.createElement(VOTableNames::tagTableData);
     dataElement->appendChild(tableDataElement);
 
     // Add rows
@@ -169,14 +214,14 @@ VOTableTable VOTableTable::fromXmlElement(const xercesc::DOMElement& e)
     VOTableTable tab;
 
     // Get attributes
-    tab.setID(XercescUtils::getAttribute(e, "ID"));
-    tab.setName(XercescUtils::getAttribute(e, "name"));
+    tab.setID(XercescUtils::getAttribute(e, VOTableNames::attrID));
+    tab.setName(XercescUtils::getAttribute(e, VOTableNames::attrName));
 
     // Get description
     tab.setDescription(XercescUtils::getDescription(e));
 
     // Process GROUP
-    DOMNodeList* children = e.getElementsByTagName(XercescString("GROUP"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableNames::tagGroup);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableGroup group = VOTableGroup::fromXmlElement(*node);
@@ -184,7 +229,7 @@ VOTableTable VOTableTable::fromXmlElement(const xercesc::DOMElement& e)
     }
 
     // Process FIELD
-    children = e.getElementsByTagName(XercescString("FIELD"));
+    children = e.getElementsByTagName(VOTableNames::tagField);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableField field = VOTableField::fromXmlElement(*node);
@@ -192,25 +237,56 @@ VOTableTable VOTableTable::fromXmlElement(const xercesc::DOMElement& e)
     }
 
     // Process DATA
-    const DOMNodeList* dataNodes = e.getElementsByTagName(XercescString("DATA"));
+    const DOMNodeList* dataNodes = e.getElementsByTagName(VOTableNames::tagData);
     for (XMLSize_t i = 0; i < dataNodes->getLength(); ++i) {
         const DOMElement* dataNode = dynamic_cast<xercesc::DOMElement*>(dataNodes->item(i));
         
         // Process TABLEDATA
-        const DOMNodeList* tableDataNodes = dataNode->getElementsByTagName(XercescString("TABLEDATA"));
+        const DOMNodeList* tableDataNodes = dataNode->getElementsByTagName(VOTableNames::tagTableData);
         for (XMLSize_t j = 0; j < tableDataNodes->getLength(); ++j) {
             const DOMElement* tableDataNode = dynamic_cast<xercesc::DOMElement*>(tableDataNodes->item(j));
 
             // Process TR
-            const DOMNodeList* rowNodes = tableDataNode->getElementsByTagName(XercescString("TR"));
+            const DOMNodeList* rowNodes = tableDataNode->getElementsByTagName(VOTableNames::tagRow);
             const XMLSize_t nRows = rowNodes->getLength();
+            tab.reserveRows(tab.itsRows.size() + nRows);
             for (XMLSize_t k = 0; k < nRows; ++k) {
                 const DOMElement* rowNode = dynamic_cast<xercesc::DOMElement*>(rowNodes->item(k));
-                const VOTableRow row = VOTableRow::fromXmlElement(*rowNode);
-                tab.addRow(row);
+                tab.addRow(VOTableRow::fromXmlElement(*rowNode));
             }
 
         }
+
+        // Process BINARY2
+        const DOMNodeList* streamNodes = dataNode->getElementsByTagName(VOTableNames::tagStream);
+        const DOMElement* binaryNode = XercescUtils::getFirstElementByTagName(*dataNode, VOTableNames::tagBinary2);
+        if (binaryNode && streamNodes->getLength() > 0) {
+            tab.setSerialisation(BINARY2);
+            const DOMElement* streamNode = dynamic_cast<xercesc::DOMElement*>(streamNodes->item(0));
+            const std::string encoding = XercescUtils::getAttribute(*streamNode, VOTableNames::attrEncoding);
+            ASKAPCHECK(encoding == "base64", "Unsupported encoding '" << encoding <<
+                       "' of the BINARY2 stream");
+            const std::string text = XercescString(streamNode->getTextContent());
+            std::vector<unsigned char> buf;
+            std::string pending;
+            ASKAPCHECK(VOTableBinary2::decodeBase64(text.data(), text.size(), pending, buf) &&
+                       pending.empty(), "Invalid base64 data in the BINARY2 stream");
+
+            const VOTableBinary2 codec(tab.itsFields);
+            size_t pos = 0;
+            std::vector<std::string> cells;
+            while (pos < buf.size()) {
+                ASKAPCHECK(codec.decodeRow(&buf[0], buf.size(), pos, cells),
+                           "Truncated row in the BINARY2 stream");
+                // fill the row in place rather than copying it
+                tab.itsRows.push_back(VOTableRow());
+                VOTableRow& row = tab.itsRows.back();
+                for (std::vector<std::string>::const_iterator it = cells.begin();
+                        it != cells.end(); ++it) {
+                    row.addCell(*it);
+                }
+            }
+        }
     }
 
     return tab;
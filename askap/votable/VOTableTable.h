@@ -48,25 +48,43 @@ namespace askap {
         class VOTableTable {
             public:
 
+                /// Serialisation of the table data
+                enum Serialisation {
+                    /// XML elements with one TD element per cell
+                    TABLEDATA,
+                    /// Base64-encoded binary representation (see VOTableBinary2)
+                    BINARY2
+                };
+
                 /// @brief Constructor
                 VOTableTable();
 
                 void setID(const std::string& id);
-                std::string getID() const;
+                const std::string& getID() const;
 
                 void setName(const std::string& name);
-                std::string getName() const;
+                const std::string& getName() const;
 
                 void setDescription(const std::string& description);
-                std::string getDescription() const;
+                const std::string& getDescription() const;
+
+                /// Set the serialisation used by toXmlElement (TABLEDATA by default)
+                void setSerialisation(Serialisation serialisation);
+                Serialisation getSerialisation() const;
 
                 void addGroup(const VOTableGroup& group);
                 void addField(const VOTableField& field);
                 void addRow(const VOTableRow& row);
+#if __cplusplus >= 201103L
+                void addRow(VOTableRow&& row);
+#endif
+
+                /// Reserve memory for a number of rows
+                void reserveRows(size_t nRows);
 
-                std::vector<VOTableGroup> getGroups() const;
-                std::vector<VOTableField> getFields() const;
-                std::vector<VOTableRow> getRows() const;
+                const std::vector<VOTableGroup>& getGroups() const;
+                const std::vector<VOTableField>& getFields() const;
+                const std::vector<VOTableRow>& getRows() const;
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
@@ -80,6 +98,7 @@ namespace askap {
                 std::vector<VOTableGroup> itsGroups;
                 std::vector<VOTableField> itsFields;
                 std::vector<VOTableRow> itsRows;
+                Serialisation itsSerialisation;
         };
 
     }
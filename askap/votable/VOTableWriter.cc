@@ -0,0 +1,503 @@
+/// @file VOTableWriter.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#include "VOTableWriter.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <ostream>
+#include <fstream>
+#include <algorithm>
+
+// ASKAPsoft includes
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+
+ASKAP_LOGGER(logger, ".VOTableWriter");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// Size of the buffer of the file stream
+const size_t fileBufferSize = 1024 * 1024;
+
+/// Length of the lines of base64 text
+const size_t base64LineLength = 76;
+
+/// Write a string, replacing the XML special characters by entities
+void writeEscaped(std::ostream& os, const std::string& str)
+{
+    static const char* const special = "&<>\"'";
+    std::string::size_type start = 0;
+    std::string::size_type pos = str.find_first_of(special);
+    while (pos != std::string::npos) {
+        os.write(str.data() + start, pos - start);
+        switch (str[pos]) {
+            case '&': os << "&amp;"; break;
+            case '<': os << "&lt;"; break;
+            case '>': os << "&gt;"; break;
+            case '"': os << "&quot;"; break;
+            default: os << "&apos;"; break;
+        }
+        start = pos + 1;
+        pos = str.find_first_of(special, start);
+    }
+    os.write(str.data() + start, str.length() - start);
+}
+
+/// Write an attribute (preceded by a space) if its value is not empty
+void writeAttribute(std::ostream& os, const char* name, const std::string& value)
+{
+    if (value.length() > 0) {
+        os << ' ' << name << "=\"";
+        writeEscaped(os, value);
+        os << '"';
+    }
+}
+
+/// Write an element with text content on its own line if the text is not empty
+void writeTextElement(std::ostream& os, const char* indent, const char* tag,
+                      const std::string& text)
+{
+    if (text.length() > 0) {
+        os << indent << '<' << tag << '>';
+        writeEscaped(os, text);
+        os << "</" << tag << ">\n";
+    }
+}
+
+void writeInfo(std::ostream& os, const char* indent, const VOTableInfo& info)
+{
+    os << indent << "<INFO";
+    writeAttribute(os, "ID", info.getID());
+    writeAttribute(os, "name", info.getName());
+    writeAttribute(os, "value", info.getValue());
+    const std::string& text = info.getText();
+    if (text.length() > 0) {
+        os << '>';
+        writeEscaped(os, text);
+        os << "</INFO>\n";
+    } else {
+        os << "/>\n";
+    }
+}
+
+void writeParam(std::ostream& os, const char* indent, const VOTableParam& param)
+{
+    os << indent << "<PARAM";
+    writeAttribute(os, "name", param.getName());
+    writeAttribute(os, "ID", param.getID());
+    writeAttribute(os, "datatype", param.getDatatype());
+    writeAttribute(os, "arraysize", param.getArraysize());
+    writeAttribute(os, "unit", param.getUnit());
+    writeAttribute(os, "ucd", param.getUCD());
+    writeAttribute(os, "utype", param.getUType());
+    writeAttribute(os, "ref", param.getRef());
+    writeAttribute(os, "value", param.getValue());
+    const std::string& desc = param.getDescription();
+    if (desc.length() > 0) {
+        os << ">\n";
+        writeTextElement(os, "          ", "DESCRIPTION", desc);
+        os << indent << "</PARAM>\n";
+    } else {
+        os << "/>\n";
+    }
+}
+
+void writeGroup(std::ostream& os, const VOTableGroup& group)
+{
+    os << "      <GROUP";
+    writeAttribute(os, "name", group.getName());
+    writeAttribute(os, "ID", group.getID());
+    writeAttribute(os, "ucd", group.getUCD());
+    writeAttribute(os, "utype", group.getUType());
+    writeAttribute(os, "ref", group.getRef());
+    os << ">\n";
+    writeTextElement(os, "        ", "DESCRIPTION", group.getDescription());
+
+    const std::vector<VOTableParam>& params = group.getParams();
+    for (std::vector<VOTableParam>::const_iterator it = params.begin();
+            it != params.end(); ++it) {
+        writeParam(os, "        ", *it);
+    }
+    const std::vector<std::string>& fieldRefs = group.getFieldRefs();
+    for (std::vector<std::string>::const_iterator it = fieldRefs.begin();
+            it != fieldRefs.end(); ++it) {
+        os << "        <FIELDref";
+        writeAttribute(os, "ref", *it);
+        os << "/>\n";
+    }
+    const std::vector<std::string>& paramRefs = group.getParamRefs();
+    for (std::vector<std::string>::const_iterator it = paramRefs.begin();
+            it != paramRefs.end(); ++it) {
+        os << "        <PARAMref";
+        writeAttribute(os, "ref", *it);
+        os << "/>\n";
+    }
+    os << "      </GROUP>\n";
+}
+
+void writeField(std::ostream& os, const VOTableField& field)
+{
+    os << "      <FIELD";
+    writeAttribute(os, "name", field.getName());
+    writeAttribute(os, "ID", field.getID());
+    writeAttribute(os, "datatype", field.getDatatype());
+    writeAttribute(os, "arraysize", field.getArraysize());
+    writeAttribute(os, "unit", field.getUnit());
+    writeAttribute(os, "ucd", field.getUCD());
+    writeAttribute(os, "utype", field.getUType());
+    writeAttribute(os, "ref", field.getRef());
+    const std::string& desc = field.getDescription();
+    if (desc.length() > 0) {
+        os << ">\n";
+        writeTextElement(os, "        ", "DESCRIPTION", desc);
+        os << "      </FIELD>\n";
+    } else {
+        os << "/>\n";
+    }
+}
+
+}
+
+VOTableWriter::VOTableWriter(const std::string& filename, size_t nThreads)
+    : itsBuffer(fileBufferSize),
+      itsFile(VOTableCompression::fromFilename(filename) == VOTableCompression::NONE ?
+              new std::ofstream : 0),
+      itsCompressedFile(itsFile ? 0 : new CompressedOutputStream(filename,
+                        VOTableCompression::fromFilename(filename), nThreads)),
+      itsStream(itsFile ? static_cast<std::ostream&>(*itsFile) : *itsCompressedFile),
+      itsStarted(false), itsInResource(false), itsHasResource(false), itsInTable(false),
+      itsClosed(false), itsFragment(false), itsNFields(0), itsNRows(0), itsColumn(0)
+{
+    if (!itsFile) {
+        return;
+    }
+    // The buffer must be set before the file is opened to be taken into account
+    itsFile->rdbuf()->pubsetbuf(&itsBuffer[0], itsBuffer.size());
+    itsFile->open(filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!itsFile->is_open()) {
+        ASKAPTHROW(AskapError, "File " << filename << " could not be opened");
+    }
+}
+
+VOTableWriter::VOTableWriter(std::ostream& os)
+    : itsStream(os), itsStarted(false), itsInResource(false), itsHasResource(false),
+      itsInTable(false), itsClosed(false), itsFragment(false), itsNFields(0), itsNRows(0),
+      itsColumn(0)
+{
+}
+
+VOTableWriter::~VOTableWriter()
+{
+    if (!itsClosed) {
+        try {
+            close();
+        } catch (const AskapError& ex) {
+            ASKAPLOG_WARN_STR(logger, "Failed to close the VOTable: " << ex.what());
+        }
+    }
+}
+
+void VOTableWriter::setDescription(const std::string& desc)
+{
+    ASKAPCHECK(!itsStarted, "The description of the VOTable must be set before the first resource");
+    itsDescription = desc;
+}
+
+void VOTableWriter::addInfo(const VOTableInfo& info)
+{
+    ASKAPCHECK(!itsStarted, "The INFO elements of the VOTable must be added before the first resource");
+    itsInfo.push_back(info);
+}
+
+void VOTableWriter::beginResource(const VOTableResource& resource)
+{
+    ASKAPCHECK(!itsClosed, "The VOTable has been closed");
+    ASKAPCHECK(!itsFragment, "Only rows can be written to a fragment");
+    endResource();
+    beginDocument();
+
+    itsStream << "  <RESOURCE";
+    writeAttribute(itsStream, "ID", resource.getID());
+    writeAttribute(itsStream, "name", resource.getName());
+    writeAttribute(itsStream, "type", resource.getType());
+    itsStream << ">\n";
+    writeTextElement(itsStream, "    ", "DESCRIPTION", resource.getDescription());
+
+    const std::vector<VOTableInfo>& info = resource.getInfo();
+    for (std::vector<VOTableInfo>::const_iterator it = info.begin();
+            it != info.end(); ++it) {
+        writeInfo(itsStream, "    ", *it);
+    }
+    itsInResource = true;
+    itsHasResource = true;
+    checkStream();
+}
+
+void VOTableWriter::endResource()
+{
+    endTable();
+    if (itsInResource) {
+        itsStream << "  </RESOURCE>\n";
+        itsInResource = false;
+        checkStream();
+    }
+}
+
+void VOTableWriter::beginTable(const VOTableTable& table)
+{
+    ASKAPCHECK(!itsClosed, "The VOTable has been closed");
+    ASKAPCHECK(!itsFragment, "Only rows can be written to a fragment");
+    endTable();
+    if (!itsInResource) {
+        beginResource(VOTableResource());
+    }
+
+    itsStream << "    <TABLE";
+    writeAttribute(itsStream, "ID", table.getID());
+    writeAttribute(itsStream, "name", table.getName());
+    itsStream << ">\n";
+    writeTextElement(itsStream, "      ", "DESCRIPTION", table.getDescription());
+
+    const std::vector<VOTableGroup>& groups = table.getGroups();
+    for (std::vector<VOTableGroup>::const_iterator it = groups.begin();
+            it != groups.end(); ++it) {
+        writeGroup(itsStream, *it);
+    }
+    const std::vector<VOTableField>& fields = table.getFields();
+    for (std::vector<VOTableField>::const_iterator it = fields.begin();
+            it != fields.end(); ++it) {
+        writeField(itsStream, *it);
+    }
+    if (table.getSerialisation() == VOTableTable::BINARY2) {
+        itsCodec.reset(new VOTableBinary2(fields));
+        itsBinary.clear();
+        itsText.clear();
+        itsColumn = 0;
+        itsStream << "      <DATA>\n        <BINARY2>\n          <STREAM encoding=\"base64\">\n";
+    } else {
+        itsCodec.reset();
+        itsStream << "      <DATA>\n        <TABLEDATA>\n";
+    }
+    itsInTable = true;
+    itsNFields = fields.size();
+    itsNRows = 0;
+
+    const std::vector<VOTableRow>& rows = table.getRows();
+    for (std::vector<VOTableRow>::const_iterator it = rows.begin();
+            it != rows.end(); ++it) {
+        addRow(*it);
+    }
+    checkStream();
+}
+
+void VOTableWriter::addRow(const std::vector<std::string>& cells)
+{
+    ASKAPCHECK(itsInTable, "A table must be started before adding rows");
+    ASKAPCHECK(cells.size() == itsNFields, "Row with " << cells.size() <<
+               " cells added to a table with " << itsNFields << " fields");
+
+    if (itsCodec) {
+        itsCodec->encodeRow(cells, itsBinary);
+        if (itsFragment) {
+            itsStream.write(reinterpret_cast<const char*>(&itsBinary[0]), itsBinary.size());
+            itsBinary.clear();
+        } else {
+            writeBase64(false);
+        }
+        ++itsNRows;
+        return;
+    }
+
+    itsStream << "          <TR>\n";
+    for (std::vector<std::string>::const_iterator it = cells.begin();
+            it != cells.end(); ++it) {
+        itsStream << "            <TD>";
+        writeEscaped(itsStream, *it);
+        itsStream << "</TD>\n";
+    }
+    itsStream << "          </TR>\n";
+    ++itsNRows;
+}
+
+void VOTableWriter::addRow(const VOTableRow& row)
+{
+    addRow(row.getCells());
+}
+
+void VOTableWriter::endTable()
+{
+    if (itsInTable && itsFragment) {
+        itsCodec.reset();
+        itsInTable = false;
+        checkStream();
+    } else if (itsInTable) {
+        if (itsCodec) {
+            writeBase64(true);
+            if (itsColumn > 0) {
+                itsStream << '\n';
+            }
+            itsStream << "          </STREAM>\n        </BINARY2>\n      </DATA>\n    </TABLE>\n";
+            itsCodec.reset();
+        } else {
+            itsStream << "        </TABLEDATA>\n      </DATA>\n    </TABLE>\n";
+        }
+        itsInTable = false;
+        checkStream();
+    }
+}
+
+void VOTableWriter::beginFragment(const VOTableTable& table)
+{
+    ASKAPCHECK(!itsClosed, "The VOTable has been closed");
+    ASKAPCHECK(!itsStarted && !itsFragment, "A fragment must be the only content of the stream");
+    ASKAPCHECK(!itsCompressedFile, "Fragments of a VOTable can't be compressed");
+
+    const std::vector<VOTableField>& fields = table.getFields();
+    if (table.getSerialisation() == VOTableTable::BINARY2) {
+        itsCodec.reset(new VOTableBinary2(fields));
+        itsBinary.clear();
+    } else {
+        itsCodec.reset();
+    }
+    itsFragment = true;
+    itsInTable = true;
+    itsNFields = fields.size();
+    itsNRows = 0;
+
+    const std::vector<VOTableRow>& rows = table.getRows();
+    for (std::vector<VOTableRow>::const_iterator it = rows.begin();
+            it != rows.end(); ++it) {
+        addRow(*it);
+    }
+    checkStream();
+}
+
+void VOTableWriter::appendFragment(const std::string& filename)
+{
+    ASKAPCHECK(itsInTable && !itsFragment, "A table must be started before appending a fragment");
+
+    std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+    ASKAPCHECK(is.is_open(), "Fragment " << filename << " could not be opened");
+    std::vector<char> chunk(fileBufferSize);
+    while (is) {
+        is.read(&chunk[0], chunk.size());
+        const size_t n = is.gcount();
+        if (n == 0) {
+            break;
+        }
+        if (itsCodec) {
+            itsBinary.insert(itsBinary.end(), chunk.begin(), chunk.begin() + n);
+            writeBase64(false);
+        } else {
+            itsStream.write(&chunk[0], n);
+        }
+    }
+    ASKAPCHECK(is.eof(), "Error reading fragment " << filename);
+    checkStream();
+}
+
+size_t VOTableWriter::rowCount() const
+{
+    return itsNRows;
+}
+
+void VOTableWriter::close()
+{
+    if (itsClosed) {
+        return;
+    }
+    if (itsFragment) {
+        endTable();
+    } else {
+        if (!itsHasResource) {
+            beginResource(VOTableResource());
+        }
+        endResource();
+        itsStream << "</VOTABLE>\n";
+    }
+    itsStream.flush();
+    itsClosed = true;
+    if (itsFile) {
+        itsFile->close();
+    }
+    if (itsCompressedFile) {
+        itsCompressedFile->close();
+    }
+    checkStream();
+}
+
+void VOTableWriter::beginDocument()
+{
+    if (itsStarted) {
+        return;
+    }
+    itsStream << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\" ?>\n"
+              << "<VOTABLE version=\"1.2\""
+              << " xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\""
+              << " xmlns=\"http://www.ivoa.net/xml/VOTable/v1.2\""
+              << " xmlns:stc=\"http://www.ivoa.net/xml/STC/v1.30\">\n";
+    writeTextElement(itsStream, "  ", "DESCRIPTION", itsDescription);
+    for (std::vector<VOTableInfo>::const_iterator it = itsInfo.begin();
+            it != itsInfo.end(); ++it) {
+        writeInfo(itsStream, "  ", *it);
+    }
+    itsStarted = true;
+}
+
+void VOTableWriter::checkStream() const
+{
+    ASKAPCHECK(!itsStream.fail(), "Error writing the VOTable");
+}
+
+void VOTableWriter::writeBase64(bool final)
+{
+    const size_t nEncoded = VOTableBinary2::encodeBase64(itsBinary.empty() ? 0 : &itsBinary[0],
+                            itsBinary.size(), final, itsText);
+    // at most two bytes are left for the next row
+    itsBinary.erase(itsBinary.begin(), itsBinary.begin() + nEncoded);
+
+    size_t pos = 0;
+    while (pos < itsText.size()) {
+        const size_t n = std::min(itsText.size() - pos, base64LineLength - itsColumn);
+        itsStream.write(itsText.data() + pos, n);
+        pos += n;
+        itsColumn += n;
+        if (itsColumn == base64LineLength) {
+            itsStream << '\n';
+            itsColumn = 0;
+        }
+    }
+    itsText.clear();
+}
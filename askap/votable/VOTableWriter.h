@@ -0,0 +1,268 @@
+/// @file VOTableWriter.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEWRITER_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEWRITER_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <ostream>
+#include <fstream>
+
+// ASKAPsoft includes
+#include "boost/scoped_ptr.hpp"
+#include "boost/utility.hpp"
+
+// Local package includes
+#include "askap/votable/CompressedOutputStream.h"
+#include "askap/votable/VOTableBinary2.h"
+#include "askap/votable/VOTableInfo.h"
+#include "askap/votable/VOTableResource.h"
+#include "askap/votable/VOTableRow.h"
+#include "askap/votable/VOTableTable.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Streaming writer of a VOTable
+        ///
+        /// Unlike VOTable::toXML, which builds the DOM of the whole document before
+        /// serialising it, this class writes the XML directly to an output stream as
+        /// the rows are added, so catalogues of any size can be written with constant
+        /// memory. The document produced is the same as the one written by
+        /// VOTable::toXML for the equivalent VOTable, the data of each table is
+        /// written in the serialisation set in its header (TABLEDATA or BINARY2). The
+        /// elements are written in the document order, so the description and INFO
+        /// elements of the VOTABLE must be given before the first resource or table.
+        /// A typical usage is
+        /// @code
+        ///    VOTableWriter writer("catalogue.xml");
+        ///    writer.beginTable(header);   // name, description, groups and fields
+        ///    for (...) {
+        ///        writer.addRow(cells);
+        ///    }
+        ///    writer.close();
+        /// @endcode
+        ///
+        /// The rows of a table can also be written in fragments by independent
+        /// writers (e.g. one per rank of a distributed job) and concatenated under a
+        /// single header, without collecting the rows in one process:
+        /// @code
+        ///    // on each rank
+        ///    VOTableWriter part("catalogue.part" + rank);
+        ///    part.beginFragment(header);
+        ///    for (...) {
+        ///        part.addRow(cells);
+        ///    }
+        ///    part.close();
+        ///
+        ///    // on one rank, once all fragments are written
+        ///    VOTableWriter writer("catalogue.xml");
+        ///    writer.beginTable(header);
+        ///    for (...) {
+        ///        writer.appendFragment("catalogue.part" + rank);
+        ///    }
+        ///    writer.close();
+        /// @endcode
+        ///
+        /// @ingroup votableaccess
+        class VOTableWriter : private boost::noncopyable {
+            public:
+
+                /// @brief Constructor
+                ///
+                /// Files named "*.gz" or "*.zst" are compressed as they are written
+                /// (see CompressedOutputStream).
+                /// @param[in] filename the file/path to write the XML output to.
+                /// @param[in] nThreads number of compression threads, 0 for one per core
+                ///                     (ignored for plain files)
+                /// @throw AskapError   if the specified file cannot be created.
+                explicit VOTableWriter(const std::string& filename, size_t nThreads = 0);
+
+                /// @brief Constructor
+                ///
+                /// The stream is written progressively, it should outlive the writer.
+                /// @param[in] os   an ostream to which the XML output will be written.
+                explicit VOTableWriter(std::ostream& os);
+
+                /// @brief Destructor, closes the document if close hasn't been called
+                ~VOTableWriter();
+
+                /// Set the description of the VOTABLE
+                ///
+                /// @throw AskapError   if a resource has already been started.
+                void setDescription(const std::string& desc);
+
+                /// Add an INFO element to the VOTABLE
+                ///
+                /// @throw AskapError   if a resource has already been started.
+                void addInfo(const VOTableInfo& info);
+
+                /// Start a RESOURCE element
+                ///
+                /// The attributes, description and INFO elements of the resource are
+                /// written, its tables (if any) are ignored. Tables are then added
+                /// with beginTable. The previous resource is ended if necessary.
+                /// @param[in] resource the resource header
+                void beginResource(const VOTableResource& resource);
+
+                /// End the current RESOURCE element (if any)
+                void endResource();
+
+                /// Start a TABLE element
+                ///
+                /// The attributes, description, GROUP and FIELD elements of the
+                /// table are written, followed by the rows it already contains (if
+                /// any). The rows are written in the serialisation of the table. A resource without attributes is started if necessary, the
+                /// previous table is ended.
+                /// @param[in] table    the table header
+                void beginTable(const VOTableTable& table);
+
+                /// Append a row to the current table
+                ///
+                /// @param[in] cells    the cells of the row, one per field
+                /// @throw AskapError   if no table has been started or the number
+                ///                     of cells doesn't match the number of fields.
+                void addRow(const std::vector<std::string>& cells);
+
+                /// Append a row to the current table
+                ///
+                /// @param[in] row      the row, one cell per field
+                /// @throw AskapError   if no table has been started or the number
+                ///                     of cells doesn't match the number of fields.
+                void addRow(const VOTableRow& row);
+
+                /// End the current TABLE element (if any)
+                void endTable();
+
+                /// Start a fragment of the rows of a table
+                ///
+                /// Only the rows are written, without any header, in the serialisation
+                /// of the table: TR elements for TABLEDATA and the binary rows (not
+                /// base64-encoded) for BINARY2. The rows already contained in the table
+                /// are written first. Fragments are then concatenated with
+                /// appendFragment. Nothing else can be written to the stream.
+                /// @param[in] table    the table header
+                /// @throw AskapError   if anything has already been written or the
+                ///                     output is compressed.
+                void beginFragment(const VOTableTable& table);
+
+                /// Append the rows of a fragment to the current table
+                ///
+                /// The bytes of the fragment are copied (TABLEDATA) or base64-encoded
+                /// (BINARY2) to the stream, the rows are neither parsed nor checked.
+                /// The fragment must have been written by beginFragment with a table
+                /// of the same fields and serialisation. Its rows are not included in
+                /// rowCount.
+                /// @param[in] filename the file of the fragment
+                /// @throw AskapError   if no table has been started or the file
+                ///                     cannot be read.
+                void appendFragment(const std::string& filename);
+
+                /// Get the number of rows written to the current table
+                size_t rowCount() const;
+
+                /// End the document and flush the stream
+                ///
+                /// Nothing is written after this call. An empty RESOURCE is written
+                /// if no resource has been started, as for VOTable::toXML.
+                /// @throw AskapError   if writing to the stream failed.
+                void close();
+
+            private:
+                /// Write the XML declaration, the VOTABLE start tag, its description
+                /// and INFO elements if not yet done
+                void beginDocument();
+
+                /// Check the stream state after writing
+                void checkStream() const;
+
+                /// Write the base64 encoding of the binary rows encoded so far
+                /// @param[in] final    true at the end of the table
+                void writeBase64(bool final);
+
+                /// Buffer of the file stream (declared first to outlive the stream)
+                std::vector<char> itsBuffer;
+
+                /// File stream owned by the writer (if constructed from a filename)
+                boost::scoped_ptr<std::ofstream> itsFile;
+
+                /// Compressed file stream owned by the writer (if the file name has
+                /// the extension of a compression format)
+                boost::scoped_ptr<CompressedOutputStream> itsCompressedFile;
+
+                /// Output stream
+                std::ostream& itsStream;
+
+                /// The VOTABLE element has been started
+                bool itsStarted;
+
+                /// A RESOURCE element is open
+                bool itsInResource;
+
+                /// At least one RESOURCE element has been written
+                bool itsHasResource;
+
+                /// A TABLE element is open
+                bool itsInTable;
+
+                /// The document has been closed
+                bool itsClosed;
+
+                /// Only the rows of a table are written (see beginFragment)
+                bool itsFragment;
+
+                /// Description of the VOTABLE
+                std::string itsDescription;
+
+                /// INFO elements of the VOTABLE
+                std::vector<VOTableInfo> itsInfo;
+
+                /// Number of fields of the current table
+                size_t itsNFields;
+
+                /// Number of rows written to the current table
+                size_t itsNRows;
+
+                /// Encoder of the rows of a BINARY2 table (null for TABLEDATA)
+                boost::scoped_ptr<VOTableBinary2> itsCodec;
+
+                /// Binary rows not base64-encoded yet
+                std::vector<unsigned char> itsBinary;
+
+                /// Base64 text not written yet
+                std::string itsText;
+
+                /// Number of characters on the current line of the STREAM element
+                size_t itsColumn;
+        };
+
+    }
+}
+
+#endif
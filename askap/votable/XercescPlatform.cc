@@ -0,0 +1,183 @@
+/// @file XercescPlatform.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+// Include own header file first
+#include "XercescPlatform.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <vector>
+
+// ASKAPsoft includes
+#include "askap/AskapError.h"
+#include "boost/thread/mutex.hpp"
+#include "xercesc/dom/DOM.hpp"
+#include "xercesc/util/PlatformUtils.hpp"
+
+// Local package includes
+#include "askap/votable/XercescString.h"
+
+using namespace askap::accessors;
+using namespace xercesc;
+
+namespace {
+
+/// Process-wide state of the Xerces platform
+///
+/// The state is created with the first guard and destroyed at the end of the
+/// process, when the pooled objects are released and Xerces is terminated.
+struct PlatformState : private boost::noncopyable {
+    PlatformState() : itsNGuards(0), itsInitialised(false) {}
+
+    ~PlatformState() {
+        // guards which are still alive (e.g. static ones) may use Xerces, leave it as it is
+        if (!itsInitialised || itsNGuards > 0) {
+            return;
+        }
+        for (std::vector<XercesDOMParser*>::iterator it = itsParsers.begin();
+                it != itsParsers.end(); ++it) {
+            delete *it;
+        }
+        for (std::vector<DOMLSSerializer*>::iterator it = itsSerializers.begin();
+                it != itsSerializers.end(); ++it) {
+            (*it)->release();
+        }
+        XMLPlatformUtils::Terminate();
+    }
+
+    /// Protects all other members
+    boost::mutex itsMutex;
+
+    /// Number of guards in existence
+    size_t itsNGuards;
+
+    /// True if Xerces has been initialised
+    bool itsInitialised;
+
+    /// Parsers which are not in use
+    std::vector<XercesDOMParser*> itsParsers;
+
+    /// Serializers which are not in use
+    std::vector<DOMLSSerializer*> itsSerializers;
+};
+
+/// The state of this process
+PlatformState& state()
+{
+    static PlatformState theState;
+    return theState;
+}
+
+}
+
+XercescPlatform::XercescPlatform()
+{
+    PlatformState& s = state();
+    boost::lock_guard<boost::mutex> lock(s.itsMutex);
+    if (!s.itsInitialised) {
+        XMLPlatformUtils::Initialize();
+        s.itsInitialised = true;
+    }
+    ++s.itsNGuards;
+}
+
+XercescPlatform::~XercescPlatform()
+{
+    PlatformState& s = state();
+    boost::lock_guard<boost::mutex> lock(s.itsMutex);
+    ASKAPDEBUGASSERT(s.itsNGuards > 0);
+    --s.itsNGuards;
+}
+
+size_t XercescPlatform::nGuards()
+{
+    PlatformState& s = state();
+    boost::lock_guard<boost::mutex> lock(s.itsMutex);
+    return s.itsNGuards;
+}
+
+bool XercescPlatform::isInitialised()
+{
+    PlatformState& s = state();
+    boost::lock_guard<boost::mutex> lock(s.itsMutex);
+    return s.itsInitialised;
+}
+
+XercescPlatform::ParserLease::ParserLease() : itsParser(0)
+{
+    PlatformState& s = state();
+    {
+        boost::lock_guard<boost::mutex> lock(s.itsMutex);
+        ASKAPCHECK(s.itsNGuards > 0, "A Xerces platform guard should exist to use a parser");
+        if (!s.itsParsers.empty()) {
+            itsParser = s.itsParsers.back();
+            s.itsParsers.pop_back();
+            return;
+        }
+    }
+    itsParser = new XercesDOMParser;
+    itsParser->setValidationScheme(XercesDOMParser::Val_Never);
+    itsParser->setDoNamespaces(false);
+    itsParser->setDoSchema(false);
+    itsParser->setLoadExternalDTD(false);
+}
+
+XercescPlatform::ParserLease::~ParserLease()
+{
+    // release the documents, the VOTable has been built from them already
+    itsParser->resetDocumentPool();
+    PlatformState& s = state();
+    boost::lock_guard<boost::mutex> lock(s.itsMutex);
+    s.itsParsers.push_back(itsParser);
+}
+
+XercescPlatform::SerializerLease::SerializerLease() : itsSerializer(0)
+{
+    PlatformState& s = state();
+    {
+        boost::lock_guard<boost::mutex> lock(s.itsMutex);
+        ASKAPCHECK(s.itsNGuards > 0, "A Xerces platform guard should exist to use a serializer");
+        if (!s.itsSerializers.empty()) {
+            itsSerializer = s.itsSerializers.back();
+            s.itsSerializers.pop_back();
+            return;
+        }
+    }
+    DOMImplementation* impl = DOMImplementationRegistry::getDOMImplementation(XercescString("LS"));
+    itsSerializer = ((DOMImplementationLS*)impl)->createLSSerializer();
+    if (itsSerializer->getDomConfig()->canSetParameter(XMLUni::fgDOMWRTFormatPrettyPrint, true)) {
+        itsSerializer->getDomConfig()->setParameter(XMLUni::fgDOMWRTFormatPrettyPrint, true);
+    }
+}
+
+XercescPlatform::SerializerLease::~SerializerLease()
+{
+    PlatformState& s = state();
+    boost::lock_guard<boost::mutex> lock(s.itsMutex);
+    s.itsSerializers.push_back(itsSerializer);
+}
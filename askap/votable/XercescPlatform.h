@@ -0,0 +1,120 @@
+/// @file XercescPlatform.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_XERCESCPLATFORM_H
+#define ASKAP_ACCESSORS_VOTABLE_XERCESCPLATFORM_H
+
+// System includes
+#include <cstddef>
+
+// ASKAPsoft includes
+#include "boost/utility.hpp"
+#include "xercesc/dom/DOMLSSerializer.hpp"
+#include "xercesc/parsers/XercesDOMParser.hpp"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Reference counted guard of the Xerces-C platform
+        ///
+        /// Xerces has to be initialised before use and XMLPlatformUtils::Initialize
+        /// and Terminate are neither cheap nor thread-safe. Code using Xerces holds an
+        /// instance of this class instead. The platform is initialised when the first
+        /// guard is created and stays initialised while guards exist and until the end
+        /// of the process, so a sequence of small VOTables doesn't pay for the global
+        /// setup and teardown each time. Guards may be created concurrently from
+        /// several threads.
+        ///
+        /// The class also keeps pools of DOM parsers and serializers, which are
+        /// borrowed with ParserLease and SerializerLease. Each borrowed object is used
+        /// by one thread at a time, so reading and writing VOTables in parallel is safe.
+        /// @ingroup votableaccess
+        class XercescPlatform : private boost::noncopyable {
+            public:
+                /// @brief DOM parser borrowed from the pool
+                /// @details The parser doesn't validate and doesn't process namespaces,
+                /// schemas or external DTDs. The document it owns is released when
+                /// the lease ends. A platform guard should exist while the lease is held.
+                class ParserLease : private boost::noncopyable {
+                    public:
+                        /// Take a parser from the pool (a new one is made if the pool is empty)
+                        ParserLease();
+
+                        /// Reset the parser and return it to the pool
+                        ~ParserLease();
+
+                        /// Access the parser
+                        xercesc::XercesDOMParser* operator->() const { return itsParser; }
+
+                        /// Access the parser
+                        xercesc::XercesDOMParser& operator*() const { return *itsParser; }
+
+                    private:
+                        /// The borrowed parser
+                        xercesc::XercesDOMParser* itsParser;
+                };
+
+                /// @brief DOM serializer borrowed from the pool
+                /// @details The serializer pretty-prints the output if supported.
+                /// A platform guard should exist while the lease is held.
+                class SerializerLease : private boost::noncopyable {
+                    public:
+                        /// Take a serializer from the pool (a new one is made if the pool is empty)
+                        SerializerLease();
+
+                        /// Return the serializer to the pool
+                        ~SerializerLease();
+
+                        /// Access the serializer
+                        xercesc::DOMLSSerializer* operator->() const { return itsSerializer; }
+
+                        /// Access the serializer
+                        xercesc::DOMLSSerializer& operator*() const { return *itsSerializer; }
+
+                    private:
+                        /// The borrowed serializer
+                        xercesc::DOMLSSerializer* itsSerializer;
+                };
+
+                /// Acquire the platform, initialising Xerces if this hasn't been done yet
+                XercescPlatform();
+
+                /// Release the platform
+                /// @details Xerces is terminated at the end of the process, once
+                /// all guards are gone.
+                ~XercescPlatform();
+
+                /// Number of guards in existence
+                static size_t nGuards();
+
+                /// True if Xerces has been initialised by this class
+                static bool isInitialised();
+        };
+
+    }
+}
+
+#endif
@@ -30,6 +30,9 @@
 // Include package level header file
 #include "askap_accessors.h"
 
+// System includes
+#include <vector>
+
 // ASKAPsoft includes
 #include "askap/AskapLogging.h"
 #include "askap/AskapError.h"
@@ -40,18 +43,32 @@
 
 // Local package includes
 #include "askap/votable/XercescString.h"
+#include "askap/votable/VOTableNames.h"
 
 using namespace xercesc;
 using namespace askap::accessors;
 
 std::string XercescUtils::getAttribute(const xercesc::DOMElement& element, const std::string& key)
 {
-    const XMLCh* val = element.getAttribute(XercescString(key));
-    return XercescString(val);
+    return getAttribute(element, XercescString(key));
+}
+
+std::string XercescUtils::getAttribute(const xercesc::DOMElement& element, const XMLCh* key)
+{
+    const XMLCh* val = element.getAttribute(key);
+    std::string str;
+    transcode(val, XMLString::stringLen(val), str);
+    return str;
 }
 
 xercesc::DOMElement* XercescUtils::getFirstElementByTagName(const xercesc::DOMElement& element,
         const std::string& name)
+{
+    return getFirstElementByTagName(element, XercescString(name));
+}
+
+xercesc::DOMElement* XercescUtils::getFirstElementByTagName(const xercesc::DOMElement& element,
+        const XMLCh* name)
 {
     const DOMNodeList* children = element.getChildNodes();
     ASKAPDEBUGASSERT(children != 0);
@@ -66,8 +83,7 @@ xercesc::DOMElement* XercescUtils::getFirstElementByTagName(const xercesc::DOMEl
         DOMElement* e1 = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         ASKAPDEBUGASSERT(e1 != 0);
 
-        const string nodeName = XercescString(e1->getNodeName());
-        if (nodeName.compare(name) == 0) {
+        if (XMLString::equals(e1->getNodeName(), name)) {
             return e1;
         }
     }
@@ -77,15 +93,39 @@ xercesc::DOMElement* XercescUtils::getFirstElementByTagName(const xercesc::DOMEl
 
 std::string XercescUtils::getStringFromDOMText(const xercesc::DOMText& text)
 {
-	const XMLCh* wholeText(text.getWholeText());
-        std::string str = XercescString(wholeText);
-        return str;
+    // The parser merges adjacent character data, so the node's own data is
+    // usually the whole text and the copy made by getWholeText() can be avoided
+    const DOMNode* prev = text.getPreviousSibling();
+    const DOMNode* next = text.getNextSibling();
+    const bool single = (!prev || prev->getNodeType() != DOMNode::TEXT_NODE)
+        && (!next || next->getNodeType() != DOMNode::TEXT_NODE);
+    const XMLCh* data = single ? text.getData() : text.getWholeText();
+    std::string str;
+    transcode(data, XMLString::stringLen(data), str);
+    return str;
+}
+
+void XercescUtils::transcode(const XMLCh* str, XMLSize_t length, std::string& out)
+{
+    out.resize(length);
+    for (XMLSize_t i = 0; i < length; ++i) {
+        if (str[i] > 0x7F) {
+            // Not ASCII, fall back to the transcoding service
+            std::vector<XMLCh> terminated(str, str + length);
+            terminated.push_back(0);
+            char* c = XMLString::transcode(&terminated[0]);
+            out = c;
+            XMLString::release(&c);
+            return;
+        }
+        out[i] = static_cast<char>(str[i]);
+    }
 }
 
 std::string XercescUtils::getDescription(const xercesc::DOMElement& element)
 {
     // Find the DESCRIPTION node
-    DOMElement* descNode = getFirstElementByTagName(element, "DESCRIPTION");
+    DOMElement* descNode = getFirstElementByTagName(element, VOTableNames::tagDescription);
 
     if (!descNode || descNode->getChildNodes()->getLength() < 1) {
         return "";
@@ -45,17 +45,39 @@ namespace askap {
                 /// @brief Returns the string from a DOM Text element.
                 static std::string getStringFromDOMText(const xercesc::DOMText& text);
 
+                /// @brief Converts an XMLCh string of the given length to a std::string.
+                /// Pure ASCII text (the common case for table cells) is copied directly
+                /// into "out", reusing its capacity, other text is transcoded to the
+                /// local code page.
+                /// @param[in] str      the string to convert
+                /// @param[in] length   number of characters in str
+                /// @param[out] out     string replaced with the result
+                static void transcode(const XMLCh* str, XMLSize_t length, std::string& out);
+
                 /// @brief Returns the value of an attibute associated with a
                 /// given DOM element.
                 static std::string getAttribute(const xercesc::DOMElement& element,
                         const std::string& key);
 
+                /// @brief Returns the value of an attibute associated with a
+                /// given DOM element. This overload avoids transcoding the key,
+                /// see VOTableNames.
+                static std::string getAttribute(const xercesc::DOMElement& element,
+                        const XMLCh* key);
+
                 /// @brief Returns a pointer to the first element contained by
                 /// the "element" parameter, that has the tag matching name.
                 static xercesc::DOMElement* getFirstElementByTagName(
                         const xercesc::DOMElement& element,
                         const std::string& name);
 
+                /// @brief Returns a pointer to the first element contained by
+                /// the "element" parameter, that has the tag matching name.
+                /// This overload compares the names without transcoding.
+                static xercesc::DOMElement* getFirstElementByTagName(
+                        const xercesc::DOMElement& element,
+                        const XMLCh* name);
+
                 /// @brief Returns the string from an element with the
                 ///  tag DESCRIPTION.
                 static std::string getDescription(const xercesc::DOMElement& element);
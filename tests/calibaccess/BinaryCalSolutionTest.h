@@ -0,0 +1,231 @@
+/// @file
+///
+/// Unit test for the implementation of the interface to access
+/// calibration solutions working with memory-mapped binary files
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <casacore/casa/aipstype.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <askap/calibaccess/BinaryCalSolutionSource.h>
+#include <askap/calibaccess/BinaryCalSolutionConstSource.h>
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+#include <boost/shared_ptr.hpp>
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+class BinaryCalSolutionTest : public CppUnit::TestFixture 
+{
+   CPPUNIT_TEST_SUITE(BinaryCalSolutionTest);
+   CPPUNIT_TEST(testCreate);
+   CPPUNIT_TEST(testRead);
+   CPPUNIT_TEST(testInheritance);
+   CPPUNIT_TEST(testGrowingFile);
+   CPPUNIT_TEST_EXCEPTION(testUndefinedBandpasses, AskapError);
+   CPPUNIT_TEST_EXCEPTION(testTooFarIntoThePast, AskapError);
+   CPPUNIT_TEST_EXCEPTION(testWrongGeometry, DataAccessError);
+   CPPUNIT_TEST_EXCEPTION(testFullFile, DataAccessError);
+   CPPUNIT_TEST_SUITE_END();
+protected:
+
+   static boost::shared_ptr<ICalSolutionSource> rwSource(bool doRemove) {
+       const std::string fname("calibdata.bin");
+       if (doRemove) {
+           BinaryCalSolutionSource::removeOldFile(fname);
+       }
+       boost::shared_ptr<BinaryCalSolutionSource> css(new BinaryCalSolutionSource(fname,6,3,8,4));
+       CPPUNIT_ASSERT(css);
+       return css;
+   }
+   
+   static boost::shared_ptr<ICalSolutionConstSource> roSource() {
+       boost::shared_ptr<BinaryCalSolutionConstSource> css(new BinaryCalSolutionConstSource("calibdata.bin"));
+       CPPUNIT_ASSERT(css);
+       return css;
+   }
+   
+   static void testComplex(const casacore::Complex &expected, const casacore::Complex &obtained, const float tol = 1e-5) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(real(expected),real(obtained),tol);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(imag(expected),imag(obtained),tol);      
+   }
+   
+public:
+
+   void testCreate() {
+       // same solutions as in the table-based test
+       boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
+       long newID = css->newSolutionID(0.);
+       CPPUNIT_ASSERT_EQUAL(0l, newID);
+       boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(newID);
+       acc->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.0,-1.0),true,casacore::Complex(-1.0,1.0),true));
+       // reuse existing file
+       acc.reset();
+       css.reset();
+       css = rwSource(false);
+       newID = css->newSolutionID(60.);
+       CPPUNIT_ASSERT_EQUAL(1l, newID);
+       acc = css->rwSolution(newID);
+       acc->setLeakage(JonesIndex(2u,1u),JonesDTerm(casacore::Complex(0.1,-0.1),true,casacore::Complex(-0.1,0.4),false));
+       acc.reset();
+       css.reset();
+       css = rwSource(false);
+       newID = css->newSolutionID(120.);
+       CPPUNIT_ASSERT_EQUAL(2l, newID);
+       acc = css->rwSolution(newID);
+       acc->setBandpass(JonesIndex(1u,1u),JonesJTerm(casacore::Complex(1.0,-0.2),true,casacore::Complex(0.9,-0.1),true),1u);       
+   }
+
+   void testRead() {
+       testCreate();
+       const boost::shared_ptr<ICalSolutionConstSource> css = roSource();
+       CPPUNIT_ASSERT_EQUAL(2l, css->mostRecentSolution());
+       for (long id = 0; id<3; ++id) {
+            CPPUNIT_ASSERT_EQUAL(id, css->solutionID(0.5+60.*id));
+       }
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(2);
+       CPPUNIT_ASSERT(acc);
+       for (casacore::uInt ant = 0; ant<6; ++ant) {
+            for (casacore::uInt beam = 0; beam<3; ++beam) {
+                 const JonesIndex index(ant,beam);
+                 const JonesJTerm gain = acc->gain(index);
+                 const JonesDTerm leakage = acc->leakage(index);
+                 if ((ant == 0) && (beam == 0)) {
+                     testComplex(casacore::Complex(1.,-1.), gain.g1());
+                     testComplex(casacore::Complex(-1.,1.), gain.g2());
+                     CPPUNIT_ASSERT(gain.g1IsValid() && gain.g2IsValid());
+                 } else {
+                     // default gain is 1.0
+                     testComplex(casacore::Complex(1.,0.), gain.g1());
+                     testComplex(casacore::Complex(1.,0.), gain.g2());
+                     CPPUNIT_ASSERT(!gain.g1IsValid() && !gain.g2IsValid());
+                 }
+                 if ((ant == 2) && (beam == 1)) {
+                     testComplex(casacore::Complex(0.1,-0.1), leakage.d12());
+                     testComplex(casacore::Complex(-0.1,0.4), leakage.d21());
+                     CPPUNIT_ASSERT(leakage.d12IsValid());
+                     CPPUNIT_ASSERT(!leakage.d21IsValid());
+                 } else {
+                     // default leakage is 0.0
+                     testComplex(casacore::Complex(0.), leakage.d12());
+                     testComplex(casacore::Complex(0.), leakage.d21());
+                     CPPUNIT_ASSERT(!leakage.d12IsValid() && !leakage.d21IsValid());
+                 }
+                 for (casacore::uInt chan = 0; chan < 8; ++chan) {
+                      const JonesJTerm bp = acc->bandpass(index,chan);
+                      if ((ant == 1) && (beam == 1) && (chan == 1)) {
+                          testComplex(casacore::Complex(1.0,-0.2), bp.g1());
+                          testComplex(casacore::Complex(0.9,-0.1), bp.g2());
+                          CPPUNIT_ASSERT(bp.g1IsValid() && bp.g2IsValid());
+                      } else {
+                          testComplex(casacore::Complex(1.,0.), bp.g1());
+                          testComplex(casacore::Complex(1.,0.), bp.g2());
+                          CPPUNIT_ASSERT(!bp.g1IsValid() && !bp.g2IsValid());
+                      }
+                 }
+            }
+       }
+       // the first solution has no leakages and bandpasses
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc0 = css->roSolution(0);
+       CPPUNIT_ASSERT(acc0);
+       CPPUNIT_ASSERT(!acc0->leakage(JonesIndex(2u,1u)).d12IsValid());
+       CPPUNIT_ASSERT(!acc0->bandpass(JonesIndex(1u,1u),1u).g1IsValid());
+       CPPUNIT_ASSERT(acc0->gain(JonesIndex(0u,0u)).g1IsValid());
+   }
+
+   void testInheritance() {
+       testCreate();
+       const boost::shared_ptr<ICalSolutionSource> css = rwSource(false);
+       const long id = css->newSolutionID(180.);
+       CPPUNIT_ASSERT_EQUAL(3l, id);
+       const boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(id);
+       // update one gain, others are inherited from the first solution
+       acc->setGain(JonesIndex(1u,0u),JonesJTerm(casacore::Complex(0.,1.),true,casacore::Complex(0.,-1.),false));
+       const JonesJTerm gain0 = acc->gain(JonesIndex(0u,0u));
+       testComplex(casacore::Complex(1.,-1.), gain0.g1());
+       CPPUNIT_ASSERT(gain0.g1IsValid() && gain0.g2IsValid());
+       const JonesJTerm gain1 = acc->gain(JonesIndex(1u,0u));
+       testComplex(casacore::Complex(0.,1.), gain1.g1());
+       CPPUNIT_ASSERT(gain1.g1IsValid() && !gain1.g2IsValid());
+       // earlier solutions are not changed
+       CPPUNIT_ASSERT(!css->roSolution(2)->gain(JonesIndex(1u,0u)).g1IsValid());
+       // bandpass is inherited from the previous solution
+       const JonesJTerm bp = acc->bandpass(JonesIndex(1u,1u),1u);
+       testComplex(casacore::Complex(1.0,-0.2), bp.g1());
+       CPPUNIT_ASSERT(bp.g1IsValid());
+   }
+
+   void testGrowingFile() {
+       testCreate();
+       const boost::shared_ptr<ICalSolutionConstSource> ro = roSource();
+       CPPUNIT_ASSERT_EQUAL(2l, ro->mostRecentSolution());
+       const boost::shared_ptr<ICalSolutionSource> css = rwSource(false);
+       const long id = css->newSolutionID(180.);
+       css->rwSolution(id)->setLeakage(JonesIndex(0u,2u),JonesDTerm(casacore::Complex(0.2,0.),true,
+                                       casacore::Complex(0.,0.2),true));
+       // the new solution is seen by the reader opened before it has been added
+       CPPUNIT_ASSERT_EQUAL(3l, ro->mostRecentSolution());
+       CPPUNIT_ASSERT_EQUAL(3l, ro->solutionID(200.));
+       const JonesDTerm leakage = ro->roSolution(id)->leakage(JonesIndex(0u,2u));
+       testComplex(casacore::Complex(0.2,0.), leakage.d12());
+       testComplex(casacore::Complex(0.,0.2), leakage.d21());
+       CPPUNIT_ASSERT(leakage.d12IsValid() && leakage.d21IsValid());
+   }
+
+   void testUndefinedBandpasses() {
+       testCreate();
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = roSource()->roSolution(2);
+       CPPUNIT_ASSERT(acc);
+       // only 6 antennas, 3 beams and 8 channels are defined
+       acc->bandpass(JonesIndex(0u,0u),8);
+   }
+
+   void testTooFarIntoThePast() {
+       testCreate();
+       roSource()->solutionID(-1.);
+   }
+
+   void testWrongGeometry() {
+       testCreate();
+       BinaryCalSolutionSource css("calibdata.bin",6,3,16,4);
+   }
+
+   void testFullFile() {
+       const boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
+       for (int i = 0; i < 5; ++i) {
+            css->newSolutionID(60. * i);
+       }
+   }
+};
+
+} // namespace accessors
+
+} // namespace askap
@@ -32,6 +32,8 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <askap/calibaccess/CachedCalSolutionAccessor.h>
 #include <askap/calibaccess/JonesIndex.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/calibaccess/ParamsCalSolutionFiller.h>
 
 #include <boost/shared_ptr.hpp>
 
@@ -46,6 +48,8 @@ class CachedCalSolutionTest : public CppUnit::TestFixture
    CPPUNIT_TEST(testReadWrite);
    CPPUNIT_TEST(testPartiallyUndefined);
    CPPUNIT_TEST(testConsistent);
+   CPPUNIT_TEST(testDenseRead);
+   CPPUNIT_TEST(testDenseWrite);
    CPPUNIT_TEST_SUITE_END();
 protected:
    static void createDummyParams(ICalSolutionAccessor &acc) {
@@ -133,6 +137,40 @@ public:
         }
    }
 
+   void testDenseRead() {
+        boost::shared_ptr<scimath::Params> params(new scimath::Params);
+        CachedCalSolutionAccessor acc(params);
+        createDummyParams(acc);
+        // parameters not related to calibration are ignored
+        params->add("flux.i.src", 1.);
+        const boost::shared_ptr<ParamsCalSolutionFiller> filler(new ParamsCalSolutionFiller(params));
+        CPPUNIT_ASSERT(!filler->noGain());
+        CPPUNIT_ASSERT(!filler->noLeakage());
+        CPPUNIT_ASSERT(!filler->noBandpass());
+        const MemCalSolutionAccessor dense(filler, true);
+        testDummyParams(dense);
+        CPPUNIT_ASSERT_EQUAL(881u, params->size());
+   }
+
+   void testDenseWrite() {
+        boost::shared_ptr<scimath::Params> params(new scimath::Params);
+        {
+           const boost::shared_ptr<ParamsCalSolutionFiller> filler(new ParamsCalSolutionFiller(params, 5, 4, 20));
+           CPPUNIT_ASSERT(filler->noGain());
+           CPPUNIT_ASSERT(filler->noLeakage());
+           CPPUNIT_ASSERT(filler->noBandpass());
+           MemCalSolutionAccessor dense(filler, false);
+           createDummyParams(dense);
+           // parameters are written back when the accessor is destroyed
+           CPPUNIT_ASSERT_EQUAL(0u, params->size());
+        }
+        CPPUNIT_ASSERT_EQUAL(880u, params->size());
+        // the same names are produced as by the cached accessor
+        const CachedCalSolutionAccessor acc(params);
+        testDummyParams(acc);
+        CPPUNIT_ASSERT(params->has(CalParamNameHelper::addChannelInfo(CalParamNameHelper::paramName(4u, 3u, casacore::Stokes::YY), 19u)));
+   }
+
    void testPartiallyUndefined() {
         const JonesIndex index(0u,0u);
         CachedCalSolutionAccessor acc;
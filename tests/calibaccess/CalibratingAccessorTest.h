@@ -0,0 +1,201 @@
+/// @file
+///
+/// Unit test for the accessor adapter applying calibration solutions
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <casacore/casa/aipstype.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <askap/calibaccess/CalibratingAccessor.h>
+#include <askap/calibaccess/CachedCalSolutionAccessor.h>
+#include <askap/calibaccess/CalSolutionConstSourceStub.h>
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+#include <boost/shared_ptr.hpp>
+
+
+namespace askap {
+
+namespace accessors {
+
+class CalibratingAccessorTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(CalibratingAccessorTest);
+   CPPUNIT_TEST(testCorrupt);
+   CPPUNIT_TEST(testRoundTrip);
+   CPPUNIT_TEST(testThreads);
+   CPPUNIT_TEST_EXCEPTION(testWrongPols, DataAccessError);
+   CPPUNIT_TEST_SUITE_END();
+protected:
+   /// @brief set up the stubbed accessor to have 4 linear polarisation products
+   static void setLinearPols(DataAccessorStub &acc) {
+       const casacore::uInt nRow = acc.nRow();
+       const casacore::uInt nChan = acc.nChannel();
+       acc.itsVisibility.resize(nRow, nChan, 4);
+       acc.itsNoise.resize(nRow, nChan, 4);
+       acc.itsNoise.set(casacore::Complex(1., 1.));
+       acc.itsFlag.resize(nRow, nChan, 4);
+       acc.itsFlag.set(casacore::False);
+       for (casacore::uInt row = 0; row < nRow; ++row) {
+            for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                 acc.itsVisibility(row, chan, 0) = casacore::Complex(1. + 0.01 * row, 0.1 * chan);
+                 acc.itsVisibility(row, chan, 1) = casacore::Complex(0.1, -0.01 * row);
+                 acc.itsVisibility(row, chan, 2) = casacore::Complex(-0.1, 0.02 * chan);
+                 acc.itsVisibility(row, chan, 3) = casacore::Complex(0.9, -0.1 * chan);
+            }
+       }
+       acc.itsStokes.resize(4);
+       acc.itsStokes[0] = casacore::Stokes::XX;
+       acc.itsStokes[1] = casacore::Stokes::XY;
+       acc.itsStokes[2] = casacore::Stokes::YX;
+       acc.itsStokes[3] = casacore::Stokes::YY;
+   }
+
+   /// @brief make a solution source with gains, leakages and bandpasses for all but the last antenna
+   /// @param[in] nAnt total number of antennas
+   /// @param[in] nChan number of channels
+   static boost::shared_ptr<ICalSolutionConstSource> makeSource(casacore::uInt nAnt, casacore::uInt nChan) {
+       boost::shared_ptr<CachedCalSolutionAccessor> acc(new CachedCalSolutionAccessor);
+       for (casacore::uInt ant = 0; ant + 1 < nAnt; ++ant) {
+            const float tag = float(ant) / 100.;
+            acc->setJonesElement(ant, 0, casacore::Stokes::XX, casacore::Complex(1.1 + tag, 0.1));
+            acc->setJonesElement(ant, 0, casacore::Stokes::YY, casacore::Complex(0.9, -0.1 - tag));
+            acc->setJonesElement(ant, 0, casacore::Stokes::XY, casacore::Complex(0.05 + tag, -0.01));
+            acc->setJonesElement(ant, 0, casacore::Stokes::YX, casacore::Complex(-0.02, 0.03 + tag));
+            for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                 acc->setBandpassElement(ant, 0, casacore::Stokes::XX, chan, casacore::Complex(1., 0.01 * chan));
+                 acc->setBandpassElement(ant, 0, casacore::Stokes::YY, chan, casacore::Complex(1. - 0.01 * chan, 0.));
+            }
+       }
+       boost::shared_ptr<ICalSolutionConstSource> src(new CalSolutionConstSourceStub(acc));
+       return src;
+   }
+
+   static void compareCubes(const casacore::Cube<casacore::Complex> &expected, 
+                            const casacore::Cube<casacore::Complex> &actual) {
+       CPPUNIT_ASSERT(expected.shape() == actual.shape());
+       for (casacore::uInt row = 0; row < expected.nrow(); ++row) {
+            for (casacore::uInt chan = 0; chan < expected.ncolumn(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < expected.nplane(); ++pol) {
+                      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(expected(row, chan, pol) - actual(row, chan, pol)), 1e-5);
+                 }
+            }
+       }
+   }
+
+public:
+   void testCorrupt() {
+       DataAccessorStub acc(true);
+       setLinearPols(acc);
+       const casacore::uInt nAnt = 30;
+       boost::shared_ptr<ICalSolutionConstSource> src = makeSource(nAnt, acc.nChannel());
+       const boost::shared_ptr<ICalSolutionConstAccessor> sol = src->roSolution(src->mostRecentSolution());
+       CalibratingAccessor acc2(src, false);
+       acc2.associate(acc);
+       const casacore::Cube<casacore::Complex> &vis = acc2.visibility();
+       const casacore::Cube<casacore::Complex> &noise = acc2.noise();
+       const casacore::Cube<casacore::Bool> &flag = acc2.flag();
+       CPPUNIT_ASSERT(vis.shape() == acc.itsVisibility.shape());
+       for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+            const casacore::uInt ant1 = acc.antenna1()[row];
+            const casacore::uInt ant2 = acc.antenna2()[row];
+            for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+                 const casacore::SquareMatrix<casacore::Complex, 2> j1 = sol->jones(ant1, 0, chan);
+                 const casacore::SquareMatrix<casacore::Complex, 2> j2 = sol->jones(ant2, 0, chan);
+                 const bool valid = (ant1 + 1 < nAnt) && (ant2 + 1 < nAnt);
+                 for (casacore::uInt pol = 0; pol < 4; ++pol) {
+                      CPPUNIT_ASSERT_EQUAL(!valid, bool(flag(row, chan, pol)));
+                      const casacore::uInt i = pol / 2;
+                      const casacore::uInt j = pol % 2;
+                      casacore::Complex expected = acc.itsVisibility(row, chan, pol);
+                      if (valid) {
+                          expected = 0.;
+                          for (casacore::uInt k = 0; k < 2; ++k) {
+                               for (casacore::uInt l = 0; l < 2; ++l) {
+                                    expected += j1(i, k) * acc.itsVisibility(row, chan, 2 * k + l) * conj(j2(j, l));
+                               }
+                          }
+                      } else {
+                          CPPUNIT_ASSERT_DOUBLES_EQUAL(1., real(noise(row, chan, pol)), 1e-6);
+                          CPPUNIT_ASSERT_DOUBLES_EQUAL(1., imag(noise(row, chan, pol)), 1e-6);
+                      }
+                      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(expected - vis(row, chan, pol)), 1e-5);
+                 }
+            }
+       }
+   }
+
+   void testRoundTrip() {
+       DataAccessorStub acc(true);
+       setLinearPols(acc);
+       boost::shared_ptr<ICalSolutionConstSource> src = makeSource(30, acc.nChannel());
+       CalibratingAccessor corrupted(src, false);
+       corrupted.associate(acc);
+       CalibratingAccessor corrected(src);
+       corrected.associate(corrupted);
+       compareCubes(acc.itsVisibility, corrected.visibility());
+       // noise grows after the round trip with non-unitary matrices, but flags stay the same
+       const casacore::Cube<casacore::Bool> &flag = corrected.flag();
+       const casacore::Cube<casacore::Bool> &flag1 = corrupted.flag();
+       CPPUNIT_ASSERT(flag.shape() == flag1.shape());
+       for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+            for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < 4; ++pol) {
+                      CPPUNIT_ASSERT_EQUAL(bool(flag1(row, chan, pol)), bool(flag(row, chan, pol)));
+                 }
+            }
+       }
+       CPPUNIT_ASSERT_THROW(corrected.rwVisibility(), DataAccessLogicError);
+   }
+
+   void testThreads() {
+       DataAccessorStub acc(true);
+       setLinearPols(acc);
+       boost::shared_ptr<ICalSolutionConstSource> src = makeSource(30, acc.nChannel());
+       CalibratingAccessor acc1(src);
+       acc1.associate(acc);
+       CalibratingAccessor acc2(src);
+       acc2.setNumberOfThreads(3);
+       acc2.associate(acc);
+       compareCubes(acc1.visibility(), acc2.visibility());
+       compareCubes(acc1.noise(), acc2.noise());
+   }
+
+   void testWrongPols() {
+       DataAccessorStub acc(true);
+       CalibratingAccessor acc2(makeSource(30, acc.nChannel()));
+       acc2.associate(acc);
+       // the stub has only Stokes I
+       acc2.visibility();
+   }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
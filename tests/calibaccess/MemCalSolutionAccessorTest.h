@@ -35,6 +35,9 @@
 #include <askap/calibaccess/JonesIndex.h>
 #include <askap/calibaccess/MemCalSolutionAccessor.h>
 #include <askap/calibaccess/ICalSolutionFiller.h>
+#include <askap/calibaccess/ChanAdapterCalSolutionConstAccessor.h>
+#include <askap/calibaccess/InterpolatingCalSolutionConstAccessor.h>
+#include <askap/calibaccess/InverseJonesCalSolutionConstAccessor.h>
 #include <askap/askap/AskapUtil.h>
 
 
@@ -55,12 +58,21 @@ class MemCalSolutionAccessorTest : public CppUnit::TestFixture,
    CPPUNIT_TEST(testWriteGains);
    CPPUNIT_TEST(testWriteLeakages);
    CPPUNIT_TEST(testWriteBandpasses);   
+   CPPUNIT_TEST(testJonesBlock);
+   CPPUNIT_TEST(testBulkWrite);
+   CPPUNIT_TEST(testChanAdapterStride);
+   CPPUNIT_TEST(testChanAdapterFrequency);
+   CPPUNIT_TEST(testInverseJones);
+   CPPUNIT_TEST(testFreeze);
+   CPPUNIT_TEST(testBlockValidity);
+   CPPUNIT_TEST_EXCEPTION(testOverwriteFrozen,AskapError);
    CPPUNIT_TEST_EXCEPTION(testOverwriteROGains,AskapError);
    CPPUNIT_TEST_EXCEPTION(testOverwriteROLeakages,AskapError);
    CPPUNIT_TEST_EXCEPTION(testOverwriteROBandpasses,AskapError);
    CPPUNIT_TEST_EXCEPTION(testOverwriteXX,AskapError);
    CPPUNIT_TEST_EXCEPTION(testOverwriteXY,AskapError);
    CPPUNIT_TEST_EXCEPTION(testOverwriteBPElement,AskapError);   
+   CPPUNIT_TEST_EXCEPTION(testBulkWriteShape,AskapError);
    CPPUNIT_TEST_SUITE_END();
 protected:
    static void fillCube(casacore::Cube<casacore::Complex> &cube) {
@@ -87,6 +99,25 @@ protected:
       CPPUNIT_ASSERT_DOUBLES_EQUAL(imag(expected), imag(val), 1e-6);      
    }
    
+   static void testBulkJones(const ICalSolutionConstAccessor &acc, const casacore::uInt nAnt, const casacore::uInt beam,
+                             const casacore::uInt startChan, const casacore::uInt nChan) {
+      casacore::Cube<casacore::Complex> jones;
+      casacore::Matrix<casacore::Bool> validity;
+      acc.jonesBlock(beam, nAnt, startChan, nChan, jones, validity);
+      CPPUNIT_ASSERT(jones.shape() == casacore::IPosition(3, 4, nChan, nAnt));
+      CPPUNIT_ASSERT(validity.shape() == casacore::IPosition(2, nChan, nAnt));
+      for (casacore::uInt ant = 0; ant<nAnt; ++ant) {
+           for (casacore::uInt chan = 0; chan<nChan; ++chan) {
+                const std::pair<casacore::SquareMatrix<casacore::Complex, 2>, bool> expected = 
+                      acc.jonesAndValidity(ant, beam, chan + startChan);
+                CPPUNIT_ASSERT_EQUAL(expected.second, bool(validity(chan, ant)));
+                for (casacore::uInt elem = 0; elem < 4; ++elem) {
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(expected.first(elem / 2, elem % 2) - jones(elem, chan, ant)), 1e-6);
+                }
+           }
+      }
+   }
+
    boost::shared_ptr<ICalSolutionAccessor> initAccessor(const bool roFlag) {
       boost::shared_ptr<ICalSolutionFiller> csf(this, utility::NullDeleter());
       boost::shared_ptr<MemCalSolutionAccessor> acc(new MemCalSolutionAccessor(csf,roFlag));
@@ -390,6 +421,322 @@ public:
      CPPUNIT_ASSERT(itsBandpassesWritten);     
   }
   
+  void testJonesBlock() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
+     // make some bandpass entries partially invalid
+     for (casacore::uInt ant = 0; ant<itsNAnt; ant += 3) {
+          const JonesJTerm bp(casacore::Complex(1.,-1.), false, casacore::Complex(-1.,1.), true);
+          acc->setBandpass(JonesIndex(ant, 1u), bp, 5);
+     }
+     const casacore::uInt startChan = 2;
+     const casacore::uInt nChan = itsNChan - startChan;
+     casacore::Array<casacore::Complex> jones;
+     casacore::Cube<casacore::Bool> validity;
+     acc->jonesBlock(itsNAnt, itsNBeam, startChan, nChan, jones, validity);
+     CPPUNIT_ASSERT(jones.shape() == casacore::IPosition(4, 4, nChan, itsNAnt, itsNBeam));
+     CPPUNIT_ASSERT(validity.shape() == casacore::IPosition(3, nChan, itsNAnt, itsNBeam));
+     for (casacore::uInt beam = 0; beam<itsNBeam; ++beam) {
+          casacore::Cube<casacore::Complex> beamJones;
+          casacore::Matrix<casacore::Bool> beamValidity;
+          acc->jonesBlock(beam, itsNAnt, startChan, nChan, beamJones, beamValidity);
+          CPPUNIT_ASSERT(beamJones.shape() == casacore::IPosition(3, 4, nChan, itsNAnt));
+          CPPUNIT_ASSERT(beamValidity.shape() == casacore::IPosition(2, nChan, itsNAnt));
+          for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+               for (casacore::uInt chan = 0; chan<nChan; ++chan) {
+                    const std::pair<casacore::SquareMatrix<casacore::Complex, 2>, bool> expected = 
+                          acc->jonesAndValidity(ant, beam, chan + startChan);
+                    CPPUNIT_ASSERT_EQUAL(expected.second, bool(validity(chan, ant, beam)));
+                    CPPUNIT_ASSERT_EQUAL(expected.second, bool(beamValidity(chan, ant)));
+                    for (casacore::uInt elem = 0; elem < 4; ++elem) {
+                         const casacore::Complex val = expected.first(elem / 2, elem % 2);
+                         const casacore::Complex bulkVal = jones(casacore::IPosition(4, elem, chan, ant, beam));
+                         CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(val - bulkVal), 1e-6);
+                         CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(val - beamJones(elem, chan, ant)), 1e-6);
+                    }
+               }
+          }
+     }
+  }
+  
+  void testBulkWrite() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
+     // gains of the first 10 antennas of beam 3
+     const casacore::uInt nAnt = 10;
+     casacore::Matrix<casacore::Complex> gains(2, nAnt);
+     casacore::Matrix<casacore::Bool> gainValidity(2, nAnt, true);
+     for (casacore::uInt ant = 0; ant<nAnt; ++ant) {
+          gains(0, ant) = casacore::Complex(float(ant), 1.);
+          gains(1, ant) = casacore::Complex(-1., float(ant));
+          gainValidity(1, ant) = (ant % 2 == 0);
+     }
+     acc->setGains(3u, gains, gainValidity);
+     // leakages of the first 5 antennas of all beams
+     casacore::Cube<casacore::Complex> leakages(2, 5, itsNBeam, casacore::Complex(0.1, -0.1));
+     casacore::Cube<casacore::Bool> leakageValidity(2, 5, itsNBeam, false);
+     acc->setLeakages(leakages, leakageValidity);
+     // bandpasses of all antennas of beam 1, channels 4 to 9, given by a non-contiguous slice
+     const casacore::uInt startChan = 4;
+     const casacore::uInt nChan = 6;
+     casacore::Cube<casacore::Complex> bpBuffer(2, 2 * nChan, itsNAnt);
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          for (casacore::uInt chan = 0; chan<2 * nChan; ++chan) {
+               bpBuffer(0, chan, ant) = casacore::Complex(float(chan), float(ant));
+               bpBuffer(1, chan, ant) = casacore::Complex(-float(ant), float(chan));
+          }
+     }
+     const casacore::Cube<casacore::Complex> bp = bpBuffer(casacore::IPosition(3, 0, 0, 0),
+                casacore::IPosition(3, 1, 2 * nChan - 1, itsNAnt - 1), casacore::IPosition(3, 1, 2, 1));
+     CPPUNIT_ASSERT(!bp.contiguousStorage());
+     casacore::Cube<casacore::Bool> bpValidity(bp.shape(), true);
+     bpValidity(0, 0, 2) = false;
+     acc->setBandpasses(1u, startChan, bp, bpValidity);
+     CPPUNIT_ASSERT(!itsGainsWritten);
+     CPPUNIT_ASSERT(!itsLeakagesWritten);
+     CPPUNIT_ASSERT(!itsBandpassesWritten);
+     // check values
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          for (casacore::uInt beam = 0; beam<itsNBeam; ++beam) {
+               const JonesIndex index(ant,beam);
+               const JonesJTerm gain = acc->gain(index);
+               if ((beam == 3) && (ant < nAnt)) {
+                   CPPUNIT_ASSERT(gain.g1IsValid());
+                   CPPUNIT_ASSERT_EQUAL(ant % 2 == 0, gain.g2IsValid());
+                   CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(gains(0, ant) - gain.g1()), 1e-6);
+                   CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(gains(1, ant) - gain.g2()), 1e-6);
+               } else {
+                   CPPUNIT_ASSERT(gain.g1IsValid());
+                   CPPUNIT_ASSERT(gain.g2IsValid());
+                   testValue(gain.g1(), index, 0);
+                   testValue(gain.g2(), index, 1);
+               }
+               const JonesDTerm leakage = acc->leakage(index);
+               if (ant < 5) {
+                   CPPUNIT_ASSERT(!leakage.d12IsValid());
+                   CPPUNIT_ASSERT(!leakage.d21IsValid());
+                   CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(casacore::Complex(0.1, -0.1) - leakage.d12()), 1e-6);
+                   CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(casacore::Complex(0.1, -0.1) - leakage.d21()), 1e-6);
+               } else {
+                   testValue(leakage.d12(), index, 0);
+                   testValue(leakage.d21(), index, 1);
+               }
+               for (casacore::uInt chan = 0; chan<itsNChan; ++chan) {
+                    const JonesJTerm bpTerm = acc->bandpass(index, chan);
+                    if ((beam == 1) && (chan >= startChan) && (chan < startChan + nChan)) {
+                        CPPUNIT_ASSERT_EQUAL((ant != 2) || (chan != startChan), bpTerm.g1IsValid());
+                        CPPUNIT_ASSERT(bpTerm.g2IsValid());
+                        CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(bpBuffer(0, 2 * (chan - startChan), ant) - bpTerm.g1()), 1e-6);
+                        CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(bpBuffer(1, 2 * (chan - startChan), ant) - bpTerm.g2()), 1e-6);
+                    } else {
+                        CPPUNIT_ASSERT(bpTerm.g1IsValid());
+                        CPPUNIT_ASSERT(bpTerm.g2IsValid());
+                        testValue(bpTerm.g1(), index, 2 * chan);
+                        testValue(bpTerm.g2(), index, 2 * chan + 1);
+                    }
+               }
+          }
+     }
+     // bulk setter covering all beams gives the same result as the individual setters
+     casacore::Array<casacore::Complex> allBP(casacore::IPosition(4, 2, 1, itsNAnt, itsNBeam), casacore::Complex(2., 0.));
+     casacore::Array<casacore::Bool> allValidity(allBP.shape(), true);
+     acc->setBandpasses(itsNChan - 1, allBP, allValidity);
+     for (casacore::uInt beam = 0; beam<itsNBeam; ++beam) {
+          const JonesJTerm bpTerm = acc->bandpass(JonesIndex(itsNAnt - 1, beam), itsNChan - 1);
+          CPPUNIT_ASSERT(bpTerm.g1IsValid() && bpTerm.g2IsValid());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(casacore::Complex(2., 0.) - bpTerm.g2()), 1e-6);
+     }
+     acc.reset();
+     CPPUNIT_ASSERT(itsGainsWritten);
+     CPPUNIT_ASSERT(itsLeakagesWritten);
+     CPPUNIT_ASSERT(itsBandpassesWritten);
+  }
+
+  void testBulkWriteShape() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
+     casacore::Matrix<casacore::Complex> gains(2, itsNAnt, casacore::Complex(1., 0.));
+     casacore::Matrix<casacore::Bool> validity(2, itsNAnt - 1, true);
+     // this should throw an exception as the shapes don't match
+     acc->setGains(0u, gains, validity);
+  }
+
+  void testChanAdapterStride() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
+     acc->setBandpass(JonesIndex(2u, 1u), JonesJTerm(casacore::Complex(1.,-1.), false, casacore::Complex(-1.,1.), true), 5);
+     // plain offset uses the bulk method of the original accessor
+     const ChanAdapterCalSolutionConstAccessor offsetAcc(acc, 3u);
+     testBulkJones(offsetAcc, itsNAnt, 1u, 0u, itsNChan - 3);
+     // every third channel starting from channel 1
+     const ChanAdapterCalSolutionConstAccessor strideAcc(acc, 1u, 3u);
+     for (casacore::uInt chan = 0; chan<5; ++chan) {
+          const JonesJTerm bp = strideAcc.bandpass(JonesIndex(2u, 1u), chan);
+          const JonesJTerm expected = acc->bandpass(JonesIndex(2u, 1u), 1 + 3 * chan);
+          CPPUNIT_ASSERT_EQUAL(expected.g1IsValid(), bp.g1IsValid());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(expected.g1() - bp.g1()), 1e-6);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(expected.g2() - bp.g2()), 1e-6);
+     }
+     testBulkJones(strideAcc, itsNAnt, 1u, 0u, 5u);
+  }
+
+  void testChanAdapterFrequency() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
+     acc->setBandpass(JonesIndex(2u, 1u), JonesJTerm(casacore::Complex(1.,-1.), false, casacore::Complex(-1.,1.), true), 5);
+     // 1 MHz solution channels and data channels four times narrower, starting below the solution grid
+     casacore::Vector<double> solFreqs(itsNChan);
+     for (casacore::uInt chan = 0; chan<itsNChan; ++chan) {
+          solFreqs[chan] = 1e9 + 1e6 * chan;
+     }
+     const casacore::uInt nDataChan = 4 * itsNChan;
+     casacore::Vector<double> dataFreqs(nDataChan);
+     for (casacore::uInt chan = 0; chan<nDataChan; ++chan) {
+          dataFreqs[chan] = 1e9 - 0.5e6 + 0.25e6 * chan;
+     }
+     const ChanAdapterCalSolutionConstAccessor freqAcc(acc, solFreqs, dataFreqs);
+     const JonesIndex index(1u, 1u);
+     // outside the grid the edge channel is used
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(acc->bandpass(index, 0).g1() - freqAcc.bandpass(index, 0).g1()), 1e-6);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(acc->bandpass(index, itsNChan - 1).g2() - 
+                                  freqAcc.bandpass(index, nDataChan - 1).g2()), 1e-6);
+     // exact match
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(acc->bandpass(index, 3).g1() - freqAcc.bandpass(index, 14).g1()), 1e-6);
+     // a quarter of the way between channels 3 and 4
+     const casacore::Complex expected = InterpolatingCalSolutionConstAccessor::interpolate(acc->bandpass(index, 3).g2(),
+                                                                                           acc->bandpass(index, 4).g2(), 0.25);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(expected - freqAcc.bandpass(index, 15).g2()), 1e-6);
+     // invalid g1 at solution channel 5 is replaced by the valid neighbour
+     const JonesJTerm bp = freqAcc.bandpass(JonesIndex(2u, 1u), 21);
+     CPPUNIT_ASSERT(bp.g1IsValid());
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(acc->bandpass(JonesIndex(2u, 1u), 4).g1() - bp.g1()), 1e-6);
+     testBulkJones(freqAcc, itsNAnt, 1u, 0u, nDataChan);
+     testBulkJones(freqAcc, itsNAnt, 1u, 13u, 7u);
+  }
+
+  void testInverseJones() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
+     acc->setBandpass(JonesIndex(2u, 1u), JonesJTerm(casacore::Complex(1.,-1.), false, casacore::Complex(-1.,1.), true), 5);
+     // valid, but singular matrix
+     acc->setGain(JonesIndex(4u, 1u), JonesJTerm(casacore::Complex(0.,0.), true, casacore::Complex(1.,0.), true));
+     const InverseJonesCalSolutionConstAccessor invAcc(acc, itsNAnt, itsNChan);
+     CPPUNIT_ASSERT_EQUAL(0u, invAcc.nCachedBeams());
+     // forward matrices are passed through
+     testBulkJones(invAcc, itsNAnt, 1u, 2u, itsNChan - 2);
+     const casacore::uInt startChan = 2;
+     const casacore::uInt nChan = itsNChan - startChan;
+     casacore::Cube<casacore::Complex> inverse;
+     casacore::Matrix<casacore::Bool> validity;
+     invAcc.inverseJonesBlock(1u, itsNAnt, startChan, nChan, inverse, validity);
+     CPPUNIT_ASSERT_EQUAL(1u, invAcc.nCachedBeams());
+     CPPUNIT_ASSERT(inverse.shape() == casacore::IPosition(3, 4, nChan, itsNAnt));
+     CPPUNIT_ASSERT(validity.shape() == casacore::IPosition(2, nChan, itsNAnt));
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          for (casacore::uInt chan = 0; chan<nChan; ++chan) {
+               const std::pair<casacore::SquareMatrix<casacore::Complex, 2>, bool> forward = 
+                     acc->jonesAndValidity(ant, 1u, chan + startChan);
+               const std::pair<casacore::SquareMatrix<casacore::Complex, 2>, bool> single = 
+                     invAcc.inverseJones(ant, 1u, chan + startChan);
+               const bool expectedValid = forward.second && (ant != 4);
+               CPPUNIT_ASSERT_EQUAL(expectedValid, bool(validity(chan, ant)));
+               CPPUNIT_ASSERT_EQUAL(expectedValid, single.second);
+               for (casacore::uInt elem = 0; elem < 4; ++elem) {
+                    const casacore::uInt row = elem / 2;
+                    const casacore::uInt col = elem % 2;
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(single.first(row, col) - inverse(elem, chan, ant)), 1e-6);
+                    // product with the forward matrix is identity, invalid matrices are identity themselves
+                    const casacore::Complex product = expectedValid ? 
+                          forward.first(row, 0) * inverse(col, chan, ant) + forward.first(row, 1) * inverse(2 + col, chan, ant) :
+                          inverse(elem, chan, ant);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(product - casacore::Complex(row == col ? 1. : 0., 0.)), 1e-5);
+               }
+          }
+     }
+     // multi-beam version is consistent with the single beam one
+     casacore::Array<casacore::Complex> allInverse;
+     casacore::Cube<casacore::Bool> allValidity;
+     invAcc.inverseJonesBlock(itsNAnt, 2u, startChan, nChan, allInverse, allValidity);
+     CPPUNIT_ASSERT_EQUAL(2u, invAcc.nCachedBeams());
+     CPPUNIT_ASSERT(allInverse.shape() == casacore::IPosition(4, 4, nChan, itsNAnt, 2));
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          for (casacore::uInt chan = 0; chan<nChan; ++chan) {
+               CPPUNIT_ASSERT_EQUAL(bool(validity(chan, ant)), bool(allValidity(chan, ant, 1)));
+               for (casacore::uInt elem = 0; elem < 4; ++elem) {
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(inverse(elem, chan, ant) - 
+                                                 allInverse(casacore::IPosition(4, elem, chan, ant, 1))), 1e-6);
+               }
+          }
+     }
+  }
+
+  void testFreeze() {
+     boost::shared_ptr<ICalSolutionFiller> csf(this, utility::NullDeleter());
+     MemCalSolutionAccessor acc(csf, false);
+     acc.setGain(JonesIndex(1u, 2u), JonesJTerm(casacore::Complex(2.,0.), true, casacore::Complex(0.,2.), false));
+     CPPUNIT_ASSERT(itsGainsRead);
+     CPPUNIT_ASSERT(!itsLeakagesRead);
+     CPPUNIT_ASSERT(!acc.isFrozen());
+     acc.freeze();
+     CPPUNIT_ASSERT(acc.isFrozen());
+     CPPUNIT_ASSERT(itsLeakagesRead);
+     CPPUNIT_ASSERT(itsBandpassesRead);
+     const JonesJTerm gain = acc.gain(JonesIndex(1u, 2u));
+     CPPUNIT_ASSERT(gain.g1IsValid());
+     CPPUNIT_ASSERT(!gain.g2IsValid());
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(2., real(gain.g1()), 1e-6);
+     const JonesIndex index(3u, 4u);
+     testValue(acc.gain(index).g2(), index, 1);
+     testValue(acc.leakage(index).d12(), index, 0);
+     testValue(acc.bandpass(index, 5).g1(), index, 10);
+     testBulkJones(acc, itsNAnt, 4u, 0u, itsNChan);
+     // the gains written before freezing are still flushed
+     CPPUNIT_ASSERT(!itsGainsWritten);
+     acc.syncCache();
+     CPPUNIT_ASSERT(itsGainsWritten);
+     CPPUNIT_ASSERT(!itsLeakagesWritten);
+  }
+
+  void testBlockValidity() {
+     boost::shared_ptr<ICalSolutionFiller> csf(this, utility::NullDeleter());
+     MemCalSolutionAccessor acc(csf, false);
+     CPPUNIT_ASSERT(acc.jonesBlockAllValid(3u, itsNAnt, 0u, itsNChan));
+     CPPUNIT_ASSERT(acc.jonesAllValid(2u, 3u, 5u));
+     acc.setBandpass(JonesIndex(2u, 3u), JonesJTerm(1., true, 1., false), 5u);
+     // antenna 4 of beam 3 has no valid constituents
+     const JonesIndex index(4u, 3u);
+     acc.setGain(index, JonesJTerm(1., false, 1., false));
+     acc.setLeakage(index, JonesDTerm(0., false, 0., false));
+     for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+          acc.setBandpass(index, JonesJTerm(1., false, 1., false), chan);
+     }
+     for (int pass = 0; pass < 2; ++pass) {
+          if (pass == 1) {
+              // packed flags are used in the frozen mode
+              acc.freeze();
+          }
+          CPPUNIT_ASSERT(!acc.jonesBlockAllValid(3u, itsNAnt, 0u, itsNChan));
+          CPPUNIT_ASSERT(acc.jonesBlockAllValid(3u, 2u, 0u, itsNChan));
+          CPPUNIT_ASSERT(!acc.jonesBlockAllValid(3u, 3u, 0u, itsNChan));
+          CPPUNIT_ASSERT(acc.jonesBlockAllValid(3u, 3u, 6u, itsNChan - 6));
+          CPPUNIT_ASSERT(!acc.jonesBlockAllValid(3u, 5u, 6u, itsNChan - 6));
+          CPPUNIT_ASSERT(acc.jonesBlockAllValid(2u, itsNAnt, 0u, itsNChan));
+          CPPUNIT_ASSERT(!acc.jonesAllValid(2u, 3u, 5u));
+          CPPUNIT_ASSERT(acc.jonesAllValid(2u, 3u, 4u));
+          CPPUNIT_ASSERT(!acc.jonesAllValid(4u, 3u, 0u));
+          testBulkJones(acc, itsNAnt, 3u, 0u, itsNChan);
+          testBulkJones(acc, itsNAnt, 3u, 4u, 3u);
+          casacore::Cube<casacore::Complex> jones;
+          casacore::Matrix<casacore::Bool> validity;
+          acc.jonesBlock(3u, 5u, 0u, itsNChan, jones, validity);
+          for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+               CPPUNIT_ASSERT(validity(chan, 2));
+               CPPUNIT_ASSERT(!validity(chan, 4));
+          }
+     }
+  }
+
+  void testOverwriteFrozen() {
+     boost::shared_ptr<ICalSolutionFiller> csf(this, utility::NullDeleter());
+     MemCalSolutionAccessor acc(csf, false);
+     acc.freeze();
+     acc.setLeakage(JonesIndex(0u,0u), JonesDTerm());
+  }
+
   void testOverwriteROGains() {
      boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(true);
      const JonesJTerm gain;
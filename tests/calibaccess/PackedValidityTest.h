@@ -0,0 +1,150 @@
+/// @file
+///
+/// Unit test for the bit-packed validity flags of calibration solutions
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/calibaccess/PackedValidity.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+class PackedValidityTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(PackedValidityTest);
+   CPPUNIT_TEST(testPacking);
+   CPPUNIT_TEST(testRanges);
+   CPPUNIT_TEST(testSet);
+   CPPUNIT_TEST_EXCEPTION(testOutsideRange, AskapError);
+   CPPUNIT_TEST_SUITE_END();
+protected:
+   /// @brief validity cube with a few flags unset
+   /// @details Rows span more than two words, so ranges crossing the word boundary are tested
+   static casacore::Cube<casacore::Bool> testCube() {
+      casacore::Cube<casacore::Bool> validity(150, 3, 2, true);
+      validity(5, 1, 0) = false;
+      validity(64, 2, 1) = false;
+      validity(149, 0, 1) = false;
+      // antenna 2, beam 0 has no valid flags
+      validity.xyPlane(0).column(2) = false;
+      return validity;
+   }
+
+   /// @brief check that all flags in a range are equal to the expected value, element by element
+   static bool rangeEquals(const casacore::Cube<casacore::Bool> &validity, casacore::uInt startRow, casacore::uInt nRows,
+                           casacore::uInt ant, casacore::uInt beam, bool expected) {
+      for (casacore::uInt row = startRow; row < startRow + nRows; ++row) {
+           if (validity(row, ant, beam) != expected) {
+               return false;
+           }
+      }
+      return true;
+   }
+public:
+   void testPacking() {
+      const casacore::Cube<casacore::Bool> validity = testCube();
+      const PackedValidity packed(validity);
+      CPPUNIT_ASSERT_EQUAL(150u, packed.nrow());
+      CPPUNIT_ASSERT_EQUAL(3u, packed.ncolumn());
+      CPPUNIT_ASSERT_EQUAL(2u, packed.nplane());
+      // three words per antenna/beam pair
+      CPPUNIT_ASSERT_EQUAL(size_t(3 * 3 * 2 * 8), packed.memoryUsage());
+      for (casacore::uInt beam = 0; beam < 2; ++beam) {
+           for (casacore::uInt ant = 0; ant < 3; ++ant) {
+                for (casacore::uInt row = 0; row < 150; ++row) {
+                     CPPUNIT_ASSERT_EQUAL(bool(validity(row, ant, beam)), packed(row, ant, beam));
+                }
+           }
+      }
+      casacore::Cube<casacore::Bool> unpacked;
+      packed.unpack(unpacked);
+      CPPUNIT_ASSERT(unpacked.shape() == validity.shape());
+      CPPUNIT_ASSERT(allEQ(unpacked, validity));
+   }
+
+   void testRanges() {
+      const casacore::Cube<casacore::Bool> validity = testCube();
+      const PackedValidity packed(validity);
+      const casacore::uInt starts[] = {0, 1, 5, 6, 60, 63, 64, 65, 127, 128, 149};
+      const casacore::uInt lengths[] = {0, 1, 2, 4, 59, 64, 65, 70, 128};
+      for (casacore::uInt beam = 0; beam < 2; ++beam) {
+           for (casacore::uInt ant = 0; ant < 3; ++ant) {
+                for (size_t i = 0; i < sizeof(starts) / sizeof(starts[0]); ++i) {
+                     for (size_t j = 0; j < sizeof(lengths) / sizeof(lengths[0]); ++j) {
+                          if (starts[i] + lengths[j] > 150) {
+                              continue;
+                          }
+                          CPPUNIT_ASSERT_EQUAL(rangeEquals(validity, starts[i], lengths[j], ant, beam, true), 
+                                               packed.allValid(starts[i], lengths[j], ant, beam));
+                          CPPUNIT_ASSERT_EQUAL(rangeEquals(validity, starts[i], lengths[j], ant, beam, false), 
+                                               packed.noneValid(starts[i], lengths[j], ant, beam));
+                     }
+                }
+           }
+      }
+      CPPUNIT_ASSERT(packed.allValidForBeam(0, 150, 1, 0));
+      CPPUNIT_ASSERT(!packed.allValidForBeam(0, 150, 2, 0));
+      CPPUNIT_ASSERT(packed.allValidForBeam(6, 144, 2, 0));
+      CPPUNIT_ASSERT(!packed.allValidForBeam(6, 144, 3, 0));
+      CPPUNIT_ASSERT(packed.allValidForBeam(0, 64, 3, 1));
+      CPPUNIT_ASSERT(!packed.allValidForBeam(0, 65, 3, 1));
+   }
+
+   void testSet() {
+      PackedValidity packed(casacore::Cube<casacore::Bool>(130, 2, 1, false));
+      CPPUNIT_ASSERT(packed.noneValid(0, 130, 1, 0));
+      packed.set(129, 1, 0, true);
+      CPPUNIT_ASSERT(packed(129, 1, 0));
+      CPPUNIT_ASSERT(!packed.noneValid(0, 130, 1, 0));
+      CPPUNIT_ASSERT(packed.noneValid(0, 129, 1, 0));
+      CPPUNIT_ASSERT(packed.noneValid(0, 130, 0, 0));
+      packed.set(129, 1, 0, false);
+      CPPUNIT_ASSERT(packed.noneValid(0, 130, 1, 0));
+      for (casacore::uInt row = 0; row < 130; ++row) {
+           packed.set(row, 0, 0, true);
+      }
+      CPPUNIT_ASSERT(packed.allValid(0, 130, 0, 0));
+      CPPUNIT_ASSERT(!packed.allValid(0, 130, 1, 0));
+   }
+
+   void testOutsideRange() {
+      const PackedValidity packed(testCube());
+      // rows 100 to 160 don't fit into 150 rows
+      packed.allValid(100, 60, 0, 0);
+   }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
@@ -0,0 +1,277 @@
+/// @file
+///
+/// Unit test for the parametric (piecewise polynomial) representation of the bandpass
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <casacore/casa/aipstype.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/calibaccess/ParametricBandpass.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/calibaccess/ICalSolutionFiller.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapUtil.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+class ParametricBandpassTest : public CppUnit::TestFixture,
+                               virtual public ICalSolutionFiller
+{
+   CPPUNIT_TEST_SUITE(ParametricBandpassTest);
+   CPPUNIT_TEST(testFit);
+   CPPUNIT_TEST(testFlaggedBlock);
+   CPPUNIT_TEST(testStorage);
+   CPPUNIT_TEST(testAccessor);
+   CPPUNIT_TEST(testWriteModel);
+   CPPUNIT_TEST_EXCEPTION(testOutsideChannels, AskapError);
+   CPPUNIT_TEST_EXCEPTION(testWrongStorageShape, AskapError);
+   CPPUNIT_TEST_SUITE_END();
+protected:
+   /// @brief smooth test bandpass, a parabola in each polarisation
+   static casacore::Complex expectedValue(const casacore::uInt chan, const casacore::uInt pol,
+                                          const casacore::uInt ant, const casacore::uInt beam) {
+      const float x = float(chan) / 10.;
+      const float offset = float(ant) / 100. + float(beam) / 10. + (pol == 0 ? 0. : 0.5);
+      return casacore::Complex(1. + offset - 0.2 * x + 0.03 * x * x, offset * x - 0.01 * x * x);
+   }
+
+   /// @brief full resolution bandpass with the test values
+   std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > testBandpass() const {
+      std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > bp;
+      bp.first.resize(2 * itsNChan, itsNAnt, itsNBeam);
+      bp.second.resize(2 * itsNChan, itsNAnt, itsNBeam);
+      bp.second.set(true);
+      for (casacore::uInt beam = 0; beam < itsNBeam; ++beam) {
+           for (casacore::uInt ant = 0; ant < itsNAnt; ++ant) {
+                for (casacore::uInt row = 0; row < 2 * itsNChan; ++row) {
+                     bp.first(row, ant, beam) = expectedValue(row / 2, row % 2, ant, beam);
+                }
+           }
+      }
+      return bp;
+   }
+
+   static void testComplex(const casacore::Complex &expected, const casacore::Complex &obtained, const float tol = 1e-4) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(real(expected), real(obtained), tol);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(imag(expected), imag(obtained), tol);
+   }
+
+public:
+   void setUp() {
+      itsNAnt = 6;
+      itsNBeam = 3;
+      // the last block is shorter than others
+      itsNChan = 70;
+      itsModelWritten = false;
+      itsModel = ParametricBandpass::fit(testBandpass(), 16, 2);
+   }
+
+   void testFit() {
+      CPPUNIT_ASSERT_EQUAL(70u, itsModel.nChan());
+      CPPUNIT_ASSERT_EQUAL(16u, itsModel.chansPerBlock());
+      CPPUNIT_ASSERT_EQUAL(2u, itsModel.order());
+      CPPUNIT_ASSERT_EQUAL(5u, itsModel.nBlock());
+      CPPUNIT_ASSERT_EQUAL(itsNAnt, itsModel.nAnt());
+      CPPUNIT_ASSERT_EQUAL(itsNBeam, itsModel.nBeam());
+      // a parabola is represented exactly
+      for (casacore::uInt beam = 0; beam < itsNBeam; ++beam) {
+           for (casacore::uInt ant = 0; ant < itsNAnt; ++ant) {
+                for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+                     const JonesJTerm bp = itsModel.bandpass(JonesIndex(ant, beam), chan);
+                     CPPUNIT_ASSERT(bp.g1IsValid());
+                     CPPUNIT_ASSERT(bp.g2IsValid());
+                     testComplex(expectedValue(chan, 0, ant, beam), bp.g1());
+                     testComplex(expectedValue(chan, 1, ant, beam), bp.g2());
+                }
+           }
+      }
+      // evaluation of a range crossing block boundaries
+      casacore::Vector<casacore::Complex> values(2 * 40);
+      casacore::Vector<casacore::Bool> validity(2 * 40);
+      itsModel.evaluate(3, 1, 10, 40, values.data(), validity.data());
+      for (casacore::uInt chan = 0; chan < 40; ++chan) {
+           for (casacore::uInt pol = 0; pol < 2; ++pol) {
+                CPPUNIT_ASSERT(validity[2 * chan + pol]);
+                testComplex(expectedValue(chan + 10, pol, 3, 1), values[2 * chan + pol]);
+           }
+      }
+      // the model is much smaller than the cube
+      CPPUNIT_ASSERT(2 * itsModel.memoryUsage() < 2 * itsNChan * itsNAnt * itsNBeam * (sizeof(casacore::Complex) + sizeof(casacore::Bool)));
+   }
+
+   void testFlaggedBlock() {
+      std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > bp = testBandpass();
+      // only two valid XX channels left in the second block of antenna 2, beam 0
+      for (casacore::uInt chan = 16; chan < 30; ++chan) {
+           bp.second(2 * chan, 2, 0) = false;
+      }
+      // a single flagged channel doesn't affect the fit
+      bp.second(2 * 40 + 1, 2, 0) = false;
+      bp.first(2 * 40 + 1, 2, 0) = casacore::Complex(100., 100.);
+      const ParametricBandpass model = ParametricBandpass::fit(bp, 16, 2);
+      for (casacore::uInt chan = 16; chan < 32; ++chan) {
+           const JonesJTerm bpTerm = model.bandpass(JonesIndex(2u, 0u), chan);
+           CPPUNIT_ASSERT(!bpTerm.g1IsValid());
+           testComplex(casacore::Complex(1., 0.), bpTerm.g1());
+           CPPUNIT_ASSERT(bpTerm.g2IsValid());
+           testComplex(expectedValue(chan, 1, 2, 0), bpTerm.g2());
+      }
+      const JonesJTerm bpTerm = model.bandpass(JonesIndex(2u, 0u), 40);
+      CPPUNIT_ASSERT(bpTerm.g2IsValid());
+      testComplex(expectedValue(40, 1, 2, 0), bpTerm.g2());
+      // explicitly set polynomial
+      ParametricBandpass model2(10, 10, 1, 1, 1);
+      CPPUNIT_ASSERT(!model2.bandpass(JonesIndex(0u, 0u), 3).g1IsValid());
+      casacore::Vector<casacore::Complex> coeffs(2);
+      coeffs[0] = casacore::Complex(1., 0.);
+      coeffs[1] = casacore::Complex(0., 1.);
+      model2.setPolynomial(0, 0, 0, 0, coeffs);
+      const JonesJTerm last = model2.bandpass(JonesIndex(0u, 0u), 9);
+      CPPUNIT_ASSERT(last.g1IsValid());
+      CPPUNIT_ASSERT(!last.g2IsValid());
+      testComplex(casacore::Complex(1., 1.), last.g1());
+      testComplex(casacore::Complex(1., -1.), model2.bandpass(JonesIndex(0u, 0u), 0).g1());
+   }
+
+   void testStorage() {
+      const ParametricBandpass model(itsModel.nChan(), itsModel.chansPerBlock(), itsModel.order(),
+                                     itsModel.coefficients(), itsModel.validity());
+      CPPUNIT_ASSERT(model.coefficients().shape() == casacore::IPosition(3, 3 * 2 * 5, itsNAnt, itsNBeam));
+      CPPUNIT_ASSERT(model.validity().shape() == casacore::IPosition(3, 2 * 5, itsNAnt, itsNBeam));
+      for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+           testComplex(itsModel.bandpass(JonesIndex(5u, 2u), chan).g2(), model.bandpass(JonesIndex(5u, 2u), chan).g2(), 1e-6);
+      }
+   }
+
+   void testAccessor() {
+      boost::shared_ptr<ICalSolutionFiller> csf(this, utility::NullDeleter());
+      MemCalSolutionAccessor acc(csf, true);
+      for (casacore::uInt chan = 0; chan < itsNChan; chan += 7) {
+           const JonesJTerm bp = acc.bandpass(JonesIndex(4u, 2u), chan);
+           testComplex(expectedValue(chan, 0, 4, 2), bp.g1());
+           testComplex(expectedValue(chan, 1, 4, 2), bp.g2());
+      }
+      casacore::Cube<casacore::Complex> jones;
+      casacore::Matrix<casacore::Bool> validity;
+      acc.jonesBlock(1u, itsNAnt, 5u, 50u, jones, validity);
+      for (casacore::uInt ant = 0; ant < itsNAnt; ++ant) {
+           for (casacore::uInt chan = 0; chan < 50; ++chan) {
+                const std::pair<casacore::SquareMatrix<casacore::Complex, 2>, bool> expected = 
+                      acc.jonesAndValidity(ant, 1u, chan + 5);
+                CPPUNIT_ASSERT_EQUAL(expected.second, bool(validity(chan, ant)));
+                for (casacore::uInt elem = 0; elem < 4; ++elem) {
+                     testComplex(expected.first(elem / 2, elem % 2), jones(elem, chan, ant), 1e-6);
+                }
+           }
+      }
+      CPPUNIT_ASSERT_EQUAL(itsModel.memoryUsage(), acc.memoryUsage());
+      acc.freeze();
+      testComplex(expectedValue(33, 1, 0, 0), acc.bandpass(JonesIndex(0u, 0u), 33).g2());
+   }
+
+   void testWriteModel() {
+      boost::shared_ptr<ICalSolutionFiller> csf(this, utility::NullDeleter());
+      {
+         MemCalSolutionAccessor acc(csf, false);
+         ParametricBandpass model(itsNChan, 35, 0, itsNAnt, itsNBeam);
+         model.setPolynomial(1, 1, 0, 1, casacore::Vector<casacore::Complex>(1, casacore::Complex(0.5, 0.)));
+         acc.setBandpassModel(model);
+         testComplex(casacore::Complex(0.5, 0.), acc.bandpass(JonesIndex(1u, 1u), 50).g1());
+         CPPUNIT_ASSERT(!acc.bandpass(JonesIndex(1u, 1u), 10).g1IsValid());
+         CPPUNIT_ASSERT(!itsModelWritten);
+      }
+      CPPUNIT_ASSERT(itsModelWritten);
+      CPPUNIT_ASSERT_EQUAL(35u, itsModel.chansPerBlock());
+   }
+
+   void testOutsideChannels() {
+      itsModel.bandpass(JonesIndex(0u, 0u), itsNChan);
+   }
+
+   void testWrongStorageShape() {
+      ParametricBandpass(itsNChan, itsModel.chansPerBlock(), itsModel.order() + 1, itsModel.coefficients(), itsModel.validity());
+   }
+
+   // methods of the solution filler, only the bandpass model is defined
+
+   virtual void fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const {
+      CPPUNIT_FAIL("Gains are not expected to be read");
+   }
+
+   virtual void fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const {
+      CPPUNIT_FAIL("Leakages are not expected to be read");
+   }
+
+   virtual void fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const {
+      CPPUNIT_FAIL("Bandpass cubes are not expected to be read if the model is defined");
+   }
+
+   virtual void writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const {
+      CPPUNIT_FAIL("Gains are not expected to be written");
+   }
+
+   virtual void writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const {
+      CPPUNIT_FAIL("Leakages are not expected to be written");
+   }
+
+   virtual void writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const {
+      CPPUNIT_FAIL("Bandpass cubes are not expected to be written");
+   }
+
+   virtual bool noGain() const { return true; }
+
+   virtual bool noLeakage() const { return true; }
+
+   virtual void fillBandpassModel(boost::shared_ptr<ParametricBandpass> &model) const {
+      model.reset(new ParametricBandpass(itsModel));
+   }
+
+   virtual void writeBandpassModel(const ParametricBandpass &model) const {
+      itsModel = model;
+      itsModelWritten = true;
+   }
+
+private:
+   casacore::uInt itsNAnt;
+   casacore::uInt itsNBeam;
+   casacore::uInt itsNChan;
+   mutable ParametricBandpass itsModel;
+   mutable bool itsModelWritten;
+};
+
+} // namespace accessors
+
+} // namespace askap
@@ -32,7 +32,10 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <askap/calibaccess/ParsetCalSolutionSource.h>
 #include <askap/calibaccess/ParsetCalSolutionAccessor.h>
+#include <askap/calibaccess/ParsetCalSolutionConstSource.h>
+#include <askap/calibaccess/ParsetCalSolutionFiller.h>
 #include <askap/calibaccess/JonesIndex.h>
+#include <askap/askap/AskapError.h>
 
 #include <boost/shared_ptr.hpp>
 
@@ -48,6 +51,10 @@ class ParsetCalSolutionTest : public CppUnit::TestFixture
    CPPUNIT_TEST(testOverwrite);
    CPPUNIT_TEST(testPartiallyUndefined);
    CPPUNIT_TEST(testSolutionSource);
+   CPPUNIT_TEST(testConstSource);
+   CPPUNIT_TEST(testBandpassBeams);
+   CPPUNIT_TEST(testParseKey);
+   CPPUNIT_TEST_EXCEPTION(testMalformedKey, AskapError);
    CPPUNIT_TEST_SUITE_END();
 protected:
    static void createDummyParset(ICalSolutionAccessor &acc) {
@@ -207,6 +214,64 @@ public:
         CPPUNIT_ASSERT(roAcc);
         testDummyParset(*roAcc);
    }
+
+   void testConstSource() {
+        const std::string fname = "tmp.testparset";
+        createDummyParset(fname);
+        const ParsetCalSolutionConstSource ss(fname);
+        const boost::shared_ptr<ICalSolutionConstAccessor> acc = ss.roSolution(ss.mostRecentSolution());
+        CPPUNIT_ASSERT(acc);
+        testDummyParset(*acc);
+   }
+
+   void testBandpassBeams() {
+        const std::string fname = "tmp.testparset";
+        createDummyParset(fname);
+        // only beams 1 and 2 out of 4 are read
+        const ParsetCalSolutionConstSource ss(fname, 1u, 2u);
+        const boost::shared_ptr<ICalSolutionConstAccessor> acc = ss.roSolution(ss.mostRecentSolution());
+        CPPUNIT_ASSERT(acc);
+        for (casacore::uInt ant=0; ant<5; ++ant) {
+             for (casacore::uInt beam=1; beam<3; ++beam) {
+                  const JonesJTerm bpTerm = acc->bandpass(JonesIndex(ant,beam), 19u);
+                  CPPUNIT_ASSERT(bpTerm.g1IsValid() && bpTerm.g2IsValid());
+                  testComplex(casacore::Complex(1.,0.), bpTerm.g1());
+             }
+             // gains are available for all beams
+             CPPUNIT_ASSERT(acc->gain(JonesIndex(ant,3u)).g2IsValid());
+        }
+   }
+
+   void testParseKey() {
+        casacore::uInt ant = 0, beam = 0, row = 0;
+        const std::string gain("gain.g22.3.12");
+        CPPUNIT_ASSERT_EQUAL(0, ParsetCalSolutionFiller::parseKey(gain.c_str(), gain.c_str() + gain.size(), ant, beam, row));
+        CPPUNIT_ASSERT_EQUAL(3u, ant);
+        CPPUNIT_ASSERT_EQUAL(12u, beam);
+        CPPUNIT_ASSERT_EQUAL(1u, row);
+        const std::string leakage("leakage.d21.0.1");
+        CPPUNIT_ASSERT_EQUAL(1, ParsetCalSolutionFiller::parseKey(leakage.c_str(), leakage.c_str() + leakage.size(), ant, beam, row));
+        CPPUNIT_ASSERT_EQUAL(1u, row);
+        const std::string bp("bp.gain.g11.5.2.100");
+        CPPUNIT_ASSERT_EQUAL(2, ParsetCalSolutionFiller::parseKey(bp.c_str(), bp.c_str() + bp.size(), ant, beam, row));
+        CPPUNIT_ASSERT_EQUAL(5u, ant);
+        CPPUNIT_ASSERT_EQUAL(2u, beam);
+        CPPUNIT_ASSERT_EQUAL(200u, row);
+        const std::string other("Cimager.gain.g11.0.0");
+        CPPUNIT_ASSERT_EQUAL(-1, ParsetCalSolutionFiller::parseKey(other.c_str(), other.c_str() + other.size(), ant, beam, row));
+        casacore::Complex val;
+        CPPUNIT_ASSERT(ParsetCalSolutionFiller::parseValue(" [ 1.5, -0.25 ] ", val));
+        testComplex(casacore::Complex(1.5,-0.25), val);
+        CPPUNIT_ASSERT(ParsetCalSolutionFiller::parseValue("0.5", val));
+        testComplex(casacore::Complex(0.5,0.), val);
+        CPPUNIT_ASSERT(!ParsetCalSolutionFiller::parseValue("[0.5]", val));
+   }
+
+   void testMalformedKey() {
+        casacore::uInt ant = 0, beam = 0, row = 0;
+        const std::string key("gain.g12.0.0");
+        ParsetCalSolutionFiller::parseKey(key.c_str(), key.c_str() + key.size(), ant, beam, row);
+   }
 };
 
 } // namespace accessors
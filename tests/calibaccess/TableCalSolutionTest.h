@@ -34,12 +34,19 @@
 #include <askap/calibaccess/ParsetCalSolutionAccessor.h>
 #include <askap/calibaccess/JonesIndex.h>
 #include <askap/calibaccess/ChanAdapterCalSolutionConstSource.h>
+#include <askap/calibaccess/InterpolatingCalSolutionConstSource.h>
+#include <askap/calibaccess/CachingCalSolutionConstSource.h>
+#include <askap/calibaccess/CalibrationStatistics.h>
+#include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
 
 
 
 #include <boost/shared_ptr.hpp>
 #include <string>
+#include <vector>
 
 namespace askap {
 
@@ -52,7 +59,19 @@ class TableCalSolutionTest : public CppUnit::TestFixture
    CPPUNIT_TEST(testRead);
    CPPUNIT_TEST(testBlankEntries);
    CPPUNIT_TEST(testTrailingBlankEntry);
+   CPPUNIT_TEST(testAccessorCache);
+   CPPUNIT_TEST(testInterpolation);
+   CPPUNIT_TEST(testRowIndexUpdate);
    CPPUNIT_TEST(testChanAdapterRead);
+   CPPUNIT_TEST(testBandpassWindow);
+   CPPUNIT_TEST(testBandpassTiling);
+   CPPUNIT_TEST(testWriteBehind);
+   CPPUNIT_TEST(testClientCache);
+   CPPUNIT_TEST(testDifferential);
+   CPPUNIT_TEST(testBandpassModel);
+   CPPUNIT_TEST(testCompact);
+   CPPUNIT_TEST(testStatistics);
+   CPPUNIT_TEST_EXCEPTION(testOutsideBandpassWindow, AskapError);
    CPPUNIT_TEST(testDelayedWrite);
    CPPUNIT_TEST_EXCEPTION(testChanAdapterUndefinedBandpass, AskapError);
    CPPUNIT_TEST_EXCEPTION(testUndefinedGains, AskapError);
@@ -60,6 +79,7 @@ class TableCalSolutionTest : public CppUnit::TestFixture
    CPPUNIT_TEST_EXCEPTION(testUndefinedBandpasses, AskapError);
    CPPUNIT_TEST_EXCEPTION(testUndefinedSolution, AskapError);
    CPPUNIT_TEST_EXCEPTION(testTooFarIntoThePast, AskapError);
+   CPPUNIT_TEST(testUnsortedTime);
    CPPUNIT_TEST(testCreateManyRows);
    CPPUNIT_TEST(testCreateManyRows1);
    CPPUNIT_TEST_SUITE_END();
@@ -260,6 +280,101 @@ public:
        }
    }
    
+   void testAccessorCache() {
+       // this creates a table with blank rows 3 to 9 referring to the solution at row 2
+       testBlankEntries();
+       const boost::shared_ptr<TableCalSolutionConstSource> css(new TableCalSolutionConstSource("calibdata.tab"));
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc3 = css->roSolution(3);
+       CPPUNIT_ASSERT(acc3);
+       CPPUNIT_ASSERT(acc3 == css->roSolution(3));
+       // rows actually read are the same for all blank entries
+       CPPUNIT_ASSERT(acc3 == css->roSolution(9));
+       CPPUNIT_ASSERT(acc3 == css->roSolution(2));
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc10 = css->roSolution(10);
+       CPPUNIT_ASSERT(acc10);
+       CPPUNIT_ASSERT(acc3 != acc10);
+       doGainAndLeakageTest(acc10);
+       doBandpassTest(acc3);
+       // a small limit keeps the most recently used accessor only
+       css->setCacheLimit(1);
+       CPPUNIT_ASSERT(acc3 != css->roSolution(5));
+       CPPUNIT_ASSERT(acc10 != css->roSolution(10));
+       // caching is switched off completely with zero limit
+       css->setCacheLimit(0);
+       CPPUNIT_ASSERT(css->roSolution(3) != css->roSolution(3));
+   }
+
+   void testRowIndexUpdate() {
+       // 3 entries with all products
+       testCreate();
+       const boost::shared_ptr<ICalSolutionSource> css = rwSource(false);
+       for (long id = 3; id < 6; ++id) {
+            CPPUNIT_ASSERT_EQUAL(id, css->newSolutionID(60. * id));
+       }
+       // blank rows resolve to the last complete entry
+       doBandpassTest(css->roSolution(5));
+       {
+          // now define bandpass in the middle of the blank rows
+          boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(4);
+          acc->setBandpass(JonesIndex(0u,0u),JonesJTerm(casa::Complex(1.1,0.),true,casa::Complex(0.9,0.),true),2u);
+       }
+       for (long id = 3; id < 6; ++id) {
+            const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(id);
+            // gains and leakages are still taken from the complete entry
+            doGainAndLeakageTest(acc);
+            const JonesJTerm bp = acc->bandpass(JonesIndex(0u,0u),2u);
+            CPPUNIT_ASSERT_EQUAL(id > 3, bp.g1IsValid());
+            if (id == 3) {
+                doBandpassTest(acc);
+            } else {
+                testComplex(casa::Complex(1.1,0.), bp.g1());
+                // the bandpass of the complete entry is overridden
+                CPPUNIT_ASSERT(!acc->bandpass(JonesIndex(1u,1u),1u).g1IsValid());
+            }
+       }
+   }
+
+   void testInterpolation() {
+       {
+          const boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
+          long id = css->newSolutionID(1000.);
+          boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(id);
+          acc->setGain(JonesIndex(0u,0u),JonesJTerm(casa::Complex(1.,0.),true,casa::Complex(0.,1.),true));
+          acc->setBandpass(JonesIndex(0u,0u),JonesJTerm(casa::Complex(0.5,0.),true,casa::Complex(1.,0.),false),1u);
+          id = css->newSolutionID(1100.);
+          acc = css->rwSolution(id);
+          // phase of g2 goes from pi/2 to -3pi/4 (i.e. 5pi/4), bandpass is inherited from the first solution
+          acc->setGain(JonesIndex(0u,0u),JonesJTerm(casa::Complex(0.,2.),true,
+                       std::polar(float(3.), float(-0.75 * casacore::C::pi)),true));
+       }
+       const boost::shared_ptr<TableCalSolutionConstSource> src(new TableCalSolutionConstSource("calibdata.tab"));
+       const InterpolatingCalSolutionConstSource css(src);
+       CPPUNIT_ASSERT_EQUAL(1l, css.mostRecentSolution());
+       // exact match and extrapolation use the original solutions
+       CPPUNIT_ASSERT_EQUAL(0l, css.solutionID(1000.));
+       CPPUNIT_ASSERT_EQUAL(1l, css.solutionID(1150.));
+       const long id = css.solutionID(1025.);
+       CPPUNIT_ASSERT(id < -1);
+       // the same time gives the same ID and the same accessor
+       CPPUNIT_ASSERT_EQUAL(id, css.solutionID(1025.));
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = css.roSolution(id);
+       CPPUNIT_ASSERT(acc);
+       CPPUNIT_ASSERT(acc == css.roSolution(id));
+       const JonesJTerm gain = acc->gain(JonesIndex(0u,0u));
+       CPPUNIT_ASSERT(gain.g1IsValid() && gain.g2IsValid());
+       testComplex(std::polar(float(1.25), float(casacore::C::pi / 8)), gain.g1());
+       // the phase difference is taken from -pi to pi
+       testComplex(std::polar(float(1.5), float(11. * casacore::C::pi / 16)), gain.g2());
+       const JonesJTerm bp = acc->bandpass(JonesIndex(0u,0u),1u);
+       CPPUNIT_ASSERT(bp.g1IsValid());
+       CPPUNIT_ASSERT(!bp.g2IsValid());
+       testComplex(casa::Complex(0.5,0.), bp.g1());
+       // undefined values remain undefined
+       CPPUNIT_ASSERT(!acc->gain(JonesIndex(1u,0u)).g1IsValid());
+       const JonesJTerm gain0 = css.roSolution(css.solutionID(1000.))->gain(JonesIndex(0u,0u));
+       testComplex(casa::Complex(1.,0.), gain0.g1());
+   }
+
    void testRead() {
        // rerun the code creating a table, although we could've just relied on the fact that testCreate() is executed
        // just before this test
@@ -352,6 +467,25 @@ public:
        css->solutionID(990.);
    }
 
+   void testUnsortedTime() {
+       boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
+       CPPUNIT_ASSERT(css);
+       CPPUNIT_ASSERT_EQUAL(0l, css->newSolutionID(1000.));
+       CPPUNIT_ASSERT_EQUAL(1l, css->newSolutionID(1200.));
+       CPPUNIT_ASSERT_EQUAL(2l, css->newSolutionID(1100.));
+       // the last row with the time stamp not exceeding the given time is returned
+       CPPUNIT_ASSERT_EQUAL(0l, css->solutionID(1050.));
+       CPPUNIT_ASSERT_EQUAL(2l, css->solutionID(1150.));
+       CPPUNIT_ASSERT_EQUAL(2l, css->solutionID(1250.));
+       // the cache should pick up new rows
+       CPPUNIT_ASSERT_EQUAL(3l, css->newSolutionID(900.));
+       CPPUNIT_ASSERT_EQUAL(3l, css->solutionID(950.));
+       CPPUNIT_ASSERT_EQUAL(3l, css->solutionID(1250.));
+       CPPUNIT_ASSERT_EQUAL(4l, css->newSolutionID(1300.));
+       CPPUNIT_ASSERT_EQUAL(3l, css->solutionID(1250.));
+       CPPUNIT_ASSERT_EQUAL(4l, css->solutionID(1300.));
+   }
+
    void testChanAdapterRead() {
        // rerun the code creating a table, although we could've just relied on the fact that testCreate() is executed
        // just before this test
@@ -391,6 +525,408 @@ public:
        }       
    }
    
+   void testBandpassWindow() {
+       testCreate();
+       const boost::shared_ptr<TableCalSolutionConstSource> css(new TableCalSolutionConstSource("calibdata.tab"));
+       const boost::shared_ptr<ICalSolutionConstAccessor> accFull = css->roSolution(2);
+       CPPUNIT_ASSERT(accFull);
+       // beams 1 and 2, channels 1 to 4
+       css->setBandpassWindow(1u, 0u, 1u, 4u);
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(2);
+       CPPUNIT_ASSERT(acc);
+       CPPUNIT_ASSERT(acc != accFull);
+       doGainAndLeakageTest(acc);
+       for (casacore::uInt ant = 0; ant<6; ++ant) {
+            for (casacore::uInt beam = 1; beam<3; ++beam) {
+                 const JonesIndex index(ant,beam);
+                 for (casacore::uInt chan = 1; chan < 5; ++chan) {
+                      const JonesJTerm bp = acc->bandpass(index,chan);
+                      const JonesJTerm bpFull = accFull->bandpass(index,chan);
+                      testComplex(bpFull.g1(), bp.g1());
+                      testComplex(bpFull.g2(), bp.g2());
+                      CPPUNIT_ASSERT_EQUAL(bpFull.g1IsValid(), bp.g1IsValid());
+                      CPPUNIT_ASSERT_EQUAL(bpFull.g2IsValid(), bp.g2IsValid());
+                 }
+            }
+       }
+       // bulk access to the window
+       casacore::Cube<casacore::Complex> jones;
+       casacore::Matrix<casacore::Bool> validity;
+       acc->jonesBlock(1u, 6u, 1u, 4u, jones, validity);
+       CPPUNIT_ASSERT(validity(0, 1));
+       CPPUNIT_ASSERT(!validity(1, 1));
+       const casacore::SquareMatrix<casacore::Complex, 2> expected = accFull->jones(1u, 1u, 1u);
+       testComplex(expected(0, 0), jones(0, 0, 1));
+       testComplex(expected(1, 1), jones(3, 0, 1));
+   }
+
+   void testBandpassTiling() {
+       const std::string fname("calibdata.tab");
+       TableCalSolutionSource::removeOldTable(fname);
+       {
+          boost::shared_ptr<TableCalSolutionSource> css(new TableCalSolutionSource(fname,6,3,8));
+          CPPUNIT_ASSERT(css);
+          // tiles of 2 channels x all antennas x 1 beam
+          css->setBandpassTiling(2u, 0u, 1u);
+          const long newID = css->newSolutionID(0.);
+          boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(newID);
+          acc->setBandpass(JonesIndex(1u,1u),JonesJTerm(casacore::Complex(1.0,-0.2),true,casacore::Complex(0.9,-0.1),true),1u);
+       }
+       const casacore::Table tab(fname);
+       const casacore::ROTiledStManAccessor bpAccessor(tab, "TiledBuffer_BANDPASS");
+       CPPUNIT_ASSERT(bpAccessor.tileShape(0) == casacore::IPosition(4, 4, 6, 1, 1));
+       const casacore::ROTiledStManAccessor validAccessor(tab, "TiledBuffer_BANDPASS_VALID");
+       CPPUNIT_ASSERT(validAccessor.tileShape(0) == casacore::IPosition(4, 4, 6, 1, 1));
+       // the solution can be read back
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = roSource()->roSolution(0);
+       CPPUNIT_ASSERT(acc);
+       const JonesJTerm bp = acc->bandpass(JonesIndex(1u,1u), 1u);
+       testComplex(casacore::Complex(1.0,-0.2), bp.g1());
+       testComplex(casacore::Complex(0.9,-0.1), bp.g2());
+   }
+
+   void testWriteBehind() {
+       const std::string fname("calibdata.tab");
+       TableCalSolutionSource::removeOldTable(fname);
+       {
+          boost::shared_ptr<TableCalSolutionSource> css(new TableCalSolutionSource(fname,6,3,8));
+          CPPUNIT_ASSERT(css);
+          css->setWriteBehind(true);
+          // same solutions as in testCreate
+          CPPUNIT_ASSERT_EQUAL(0l, css->newSolutionID(0.));
+          boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(0);
+          acc->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.0,-1.0),true,casacore::Complex(-1.0,1.0),true));
+          acc.reset();
+          CPPUNIT_ASSERT_EQUAL(1l, css->newSolutionID(60.));
+          acc = css->rwSolution(1);
+          acc->setLeakage(JonesIndex(2u,1u),JonesDTerm(casacore::Complex(0.1,-0.1),true,casacore::Complex(-0.1,0.4),false));
+          acc.reset();
+          CPPUNIT_ASSERT_EQUAL(2l, css->newSolutionID(120.));
+          // the bandpass is updated twice, only the last value should be stored
+          acc = css->rwSolution(2);
+          acc->setBandpass(JonesIndex(1u,1u),JonesJTerm(casacore::Complex(0.5,0.5),true,casacore::Complex(0.5,0.5),true),1u);
+          acc.reset();
+          acc = css->rwSolution(2);
+          // the update which may not have been written yet is seen by the new accessor
+          const JonesJTerm bp = acc->bandpass(JonesIndex(1u,1u),1u);
+          testComplex(casacore::Complex(0.5,0.5), bp.g1());
+          acc->setBandpass(JonesIndex(1u,1u),JonesJTerm(casacore::Complex(1.0,-0.2),true,casacore::Complex(0.9,-0.1),true),1u);
+          acc.reset();
+          // read-only access waits for all writes
+          doBandpassTest(css->roSolution(2));
+          // the destructor writes everything queued
+       }
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = accessorForExistingTable();
+       doGainAndLeakageTest(acc);
+       doBandpassTest(acc);
+   }
+
+   static bool cellDefined(const std::string &name, const casacore::uInt row) {
+       const casacore::Table tab("calibdata.tab");
+       if (!tab.actualTableDesc().isColumn(name)) {
+           return false;
+       }
+       return casacore::ROArrayColumn<casacore::Complex>(tab, name).isDefined(row);
+   }
+
+   void testDifferential() {
+       const std::string fname("calibdata.tab");
+       TableCalSolutionSource::removeOldTable(fname);
+       {
+          boost::shared_ptr<TableCalSolutionSource> css(new TableCalSolutionSource(fname,6,3,8));
+          CPPUNIT_ASSERT(css);
+          css->setDifferential(3);
+          // the first solution defines all gains
+          CPPUNIT_ASSERT_EQUAL(0l, css->newSolutionID(0.));
+          boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(0);
+          for (casacore::uInt ant = 0; ant < 6; ++ant) {
+               for (casacore::uInt beam = 0; beam < 3; ++beam) {
+                    acc->setGain(JonesIndex(ant, beam), JonesJTerm(casacore::Complex(ant, beam), true, 
+                                 casacore::Complex(beam, ant), true));
+               }
+          }
+          acc->setBandpass(JonesIndex(1u,1u),JonesJTerm(casacore::Complex(1.0,-0.2),true,casacore::Complex(0.9,-0.1),true),1u);
+          acc.reset();
+          // subsequent solutions change a single antenna
+          for (long id = 1; id < 4; ++id) {
+               CPPUNIT_ASSERT_EQUAL(id, css->newSolutionID(60. * id));
+               acc = css->rwSolution(id);
+               // new solution starts from the previous one
+               testComplex(casacore::Complex(id - 1, 2.), acc->gain(JonesIndex(0u, 2u)).g1());
+               acc->setGain(JonesIndex(0u, 2u), JonesJTerm(casacore::Complex(id, 2.), true, casacore::Complex(2., 0.), false));
+               acc.reset();
+          }
+          // a solution which only has leakages
+          CPPUNIT_ASSERT_EQUAL(4l, css->newSolutionID(240.));
+          acc = css->rwSolution(4);
+          acc->setLeakage(JonesIndex(2u,1u),JonesDTerm(casacore::Complex(0.1,-0.1),true,casacore::Complex(-0.1,0.4),false));
+          acc.reset();
+       }
+       // rows 1 and 2 are differential, the keyframe interval forces the full cube at row 3
+       CPPUNIT_ASSERT(cellDefined("GAIN", 0));
+       CPPUNIT_ASSERT(!cellDefined("GAIN", 1));
+       CPPUNIT_ASSERT(cellDefined("GAIN_DELTA", 1));
+       CPPUNIT_ASSERT(cellDefined("GAIN_DELTA", 2));
+       CPPUNIT_ASSERT(cellDefined("GAIN", 3));
+       CPPUNIT_ASSERT(!cellDefined("GAIN_DELTA", 3));
+       CPPUNIT_ASSERT(!cellDefined("GAIN", 4));
+       CPPUNIT_ASSERT(!cellDefined("GAIN_DELTA", 4));
+       CPPUNIT_ASSERT(!cellDefined("BANDPASS_DELTA", 1));
+       {
+          const casacore::Table tab(fname);
+          const casacore::ROArrayColumn<casacore::Complex> deltaCol(tab, "GAIN_DELTA");
+          CPPUNIT_ASSERT(deltaCol.shape(1) == casacore::IPosition(3, 2, 1, 1));
+       }
+       const boost::shared_ptr<ICalSolutionConstSource> css = roSource();
+       CPPUNIT_ASSERT_EQUAL(4l, css->mostRecentSolution());
+       for (long id = 0; id < 5; ++id) {
+            const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(id);
+            CPPUNIT_ASSERT(acc);
+            const JonesJTerm changed = acc->gain(JonesIndex(0u, 2u));
+            testComplex(casacore::Complex(id < 4 ? id : 3, 2.), changed.g1());
+            CPPUNIT_ASSERT(changed.g1IsValid());
+            CPPUNIT_ASSERT_EQUAL(id == 0, changed.g2IsValid());
+            // other elements are reconstructed from the keyframe
+            const JonesJTerm gain = acc->gain(JonesIndex(4u, 1u));
+            testComplex(casacore::Complex(4., 1.), gain.g1());
+            testComplex(casacore::Complex(1., 4.), gain.g2());
+            CPPUNIT_ASSERT(gain.g1IsValid() && gain.g2IsValid());
+            const JonesJTerm bp = acc->bandpass(JonesIndex(1u, 1u), 1u);
+            testComplex(casacore::Complex(1.0,-0.2), bp.g1());
+            CPPUNIT_ASSERT(bp.g1IsValid());
+       }
+       CPPUNIT_ASSERT(css->roSolution(4)->leakage(JonesIndex(2u,1u)).d12IsValid());
+   }
+
+   void testBandpassModel() {
+       const std::string fname("calibdata.tab");
+       TableCalSolutionSource::removeOldTable(fname);
+       {
+          boost::shared_ptr<TableCalSolutionSource> css(new TableCalSolutionSource(fname,6,3,8));
+          CPPUNIT_ASSERT(css);
+          ParametricBandpass model(8, 4, 1, 6, 3);
+          casacore::Vector<casacore::Complex> coeffs(2);
+          coeffs[0] = casacore::Complex(0.5, 0.);
+          coeffs[1] = casacore::Complex(0.1, 0.);
+          model.setPolynomial(1, 1, 0, 1, coeffs);
+          CPPUNIT_ASSERT_EQUAL(0l, css->newSolutionID(0.));
+          boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(0);
+          acc->setBandpassModel(model);
+          acc.reset();
+          // the full resolution bandpass replaces the model
+          CPPUNIT_ASSERT_EQUAL(1l, css->newSolutionID(60.));
+          acc = css->rwSolution(1);
+          acc->setBandpass(JonesIndex(1u,1u),JonesJTerm(casacore::Complex(1.0,-0.2),true,casacore::Complex(0.9,-0.1),true),1u);
+          acc.reset();
+          CPPUNIT_ASSERT_EQUAL(2l, css->newSolutionID(120.));
+          acc = css->rwSolution(2);
+          acc->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.0,-1.0),true,casacore::Complex(-1.0,1.0),true));
+          acc.reset();
+          // and the model replaces the full resolution bandpass again
+          CPPUNIT_ASSERT_EQUAL(3l, css->newSolutionID(180.));
+          acc = css->rwSolution(3);
+          acc->setBandpassModel(model);
+          acc.reset();
+       }
+       CPPUNIT_ASSERT(cellDefined("BANDPASS_MODEL", 0));
+       CPPUNIT_ASSERT(!cellDefined("BANDPASS", 0));
+       CPPUNIT_ASSERT(cellDefined("BANDPASS", 1));
+       CPPUNIT_ASSERT(!cellDefined("BANDPASS_MODEL", 2));
+       CPPUNIT_ASSERT(cellDefined("BANDPASS_MODEL", 3));
+       const boost::shared_ptr<ICalSolutionConstSource> css = roSource();
+       for (long id = 0; id < 4; ++id) {
+            const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(id);
+            CPPUNIT_ASSERT(acc);
+            const bool fromModel = (id == 0) || (id == 3);
+            const JonesJTerm bp1 = acc->bandpass(JonesIndex(1u, 1u), 1u);
+            const JonesJTerm bp5 = acc->bandpass(JonesIndex(1u, 1u), 5u);
+            CPPUNIT_ASSERT_EQUAL(!fromModel, bp1.g1IsValid());
+            CPPUNIT_ASSERT_EQUAL(fromModel, bp5.g1IsValid());
+            CPPUNIT_ASSERT(!bp5.g2IsValid());
+            if (fromModel) {
+                // channel 5 is the second channel of the block, the normalised offset is -1/3
+                testComplex(casacore::Complex(0.5 - 0.1 / 3., 0.), bp5.g1());
+            } else {
+                testComplex(casacore::Complex(1.0,-0.2), bp1.g1());
+            }
+       }
+   }
+
+   void testCompact() {
+       const std::string fname("calibdata.tab");
+       TableCalSolutionSource::removeOldTable(fname);
+       {
+          boost::shared_ptr<TableCalSolutionSource> css(new TableCalSolutionSource(fname,6,3,8));
+          CPPUNIT_ASSERT(css);
+          css->setDifferential(4);
+          // nothing is defined at the first row
+          CPPUNIT_ASSERT_EQUAL(0l, css->newSolutionID(0.));
+          CPPUNIT_ASSERT_EQUAL(1l, css->newSolutionID(60.));
+          boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(1);
+          acc->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.0,-1.0),true,casacore::Complex(-1.0,1.0),true));
+          acc.reset();
+          CPPUNIT_ASSERT_EQUAL(2l, css->newSolutionID(120.));
+          acc = css->rwSolution(2);
+          acc->setBandpass(JonesIndex(1u,1u),JonesJTerm(casacore::Complex(1.0,-0.2),true,casacore::Complex(0.9,-0.1),true),1u);
+          acc.reset();
+          CPPUNIT_ASSERT_EQUAL(3l, css->newSolutionID(180.));
+          acc = css->rwSolution(3);
+          acc->setLeakage(JonesIndex(2u,1u),JonesDTerm(casacore::Complex(0.1,-0.1),true,casacore::Complex(-0.1,0.4),false));
+          acc.reset();
+          // differential update of the gains
+          CPPUNIT_ASSERT_EQUAL(4l, css->newSolutionID(240.));
+          acc = css->rwSolution(4);
+          acc->setGain(JonesIndex(3u,2u),JonesJTerm(casacore::Complex(0.5,0.),true,casacore::Complex(0.,0.5),true));
+          acc.reset();
+       }
+       CPPUNIT_ASSERT(cellDefined("GAIN_DELTA", 4));
+       const std::string compacted("calibdata_compact.tab");
+       CPPUNIT_ASSERT_EQUAL(5l, TableCalSolutionSource::compact(fname, compacted, 0, 4, 0, 1));
+       {
+          const casacore::Table tab(compacted);
+          CPPUNIT_ASSERT_EQUAL(casacore::uInt(5), casacore::uInt(tab.nrow()));
+          // full cubes in every row, starting from the row where the product is first defined
+          CPPUNIT_ASSERT(!tab.actualTableDesc().isColumn("GAIN_DELTA"));
+          const casacore::ROArrayColumn<casacore::Complex> gainCol(tab, "GAIN");
+          const casacore::ROArrayColumn<casacore::Complex> leakageCol(tab, "LEAKAGE");
+          const casacore::ROArrayColumn<casacore::Complex> bpCol(tab, "BANDPASS");
+          for (casacore::uInt row = 0; row < 5; ++row) {
+               CPPUNIT_ASSERT_EQUAL(row >= 1, gainCol.isDefined(row));
+               CPPUNIT_ASSERT_EQUAL(row >= 2, bpCol.isDefined(row));
+               CPPUNIT_ASSERT_EQUAL(row >= 3, leakageCol.isDefined(row));
+          }
+       }
+       {
+          const boost::shared_ptr<TableCalSolutionConstSource> origSrc(new TableCalSolutionConstSource(fname));
+          const boost::shared_ptr<TableCalSolutionConstSource> compactSrc(new TableCalSolutionConstSource(compacted));
+          for (long id = 1; id < 5; ++id) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(origSrc->solutionTime(id), compactSrc->solutionTime(id), 1e-6);
+               const boost::shared_ptr<ICalSolutionConstAccessor> orig = origSrc->roSolution(id);
+               const boost::shared_ptr<ICalSolutionConstAccessor> acc = compactSrc->roSolution(id);
+               CPPUNIT_ASSERT(orig && acc);
+               for (casacore::uInt ant = 0; ant < 6; ++ant) {
+                    for (casacore::uInt beam = 0; beam < 3; ++beam) {
+                         const JonesIndex index(ant, beam);
+                         const JonesJTerm origGain = orig->gain(index);
+                         const JonesJTerm gain = acc->gain(index);
+                         CPPUNIT_ASSERT_EQUAL(origGain.g1IsValid(), gain.g1IsValid());
+                         CPPUNIT_ASSERT_EQUAL(origGain.g2IsValid(), gain.g2IsValid());
+                         testComplex(origGain.g1(), gain.g1());
+                         testComplex(origGain.g2(), gain.g2());
+                         if (id >= 2) {
+                             const JonesJTerm origBP = orig->bandpass(index, 1u);
+                             const JonesJTerm bp = acc->bandpass(index, 1u);
+                             CPPUNIT_ASSERT_EQUAL(origBP.g1IsValid(), bp.g1IsValid());
+                             testComplex(origBP.g1(), bp.g1());
+                         }
+                         if (id >= 3) {
+                             const JonesDTerm origLeakage = orig->leakage(index);
+                             const JonesDTerm leakage = acc->leakage(index);
+                             CPPUNIT_ASSERT_EQUAL(origLeakage.d12IsValid(), leakage.d12IsValid());
+                             CPPUNIT_ASSERT_EQUAL(origLeakage.d21IsValid(), leakage.d21IsValid());
+                             testComplex(origLeakage.d12(), leakage.d12());
+                         }
+                    }
+               }
+          }
+          testComplex(casacore::Complex(0.5,0.), compactSrc->roSolution(4)->gain(JonesIndex(3u,2u)).g1());
+       }
+       // the compacted table is closed now
+       TableCalSolutionSource::removeOldTable(compacted);
+   }
+
+   void testStatistics() {
+       testCreate();
+       CalibrationStatistics &stats = CalibrationStatistics::instance();
+       const bool wasEnabled = stats.isEnabled();
+       stats.reset();
+       stats.enable();
+       const boost::shared_ptr<TableCalSolutionConstSource> css(new TableCalSolutionConstSource("calibdata.tab"));
+       CPPUNIT_ASSERT_EQUAL(1l, css->solutionID(61.));
+       CPPUNIT_ASSERT_EQUAL(2l, css->solutionID(1000.));
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nCalls(CalibrationStatistics::SOLUTION_ID));
+       // time stamps are read once, the second search is done in the cache
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(3), stats.nScannedRows());
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(2);
+       CPPUNIT_ASSERT(acc == css->roSolution(2));
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nCalls(CalibrationStatistics::RO_SOLUTION));
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nAccessorsCreated());
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nAccessorsReused());
+       // products are read on demand by the first call and served from the cache afterwards
+       acc->jones(0, 0, 1);
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nCalls(CalibrationStatistics::FILL_GAINS));
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nCalls(CalibrationStatistics::FILL_LEAKAGES));
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nCalls(CalibrationStatistics::FILL_BANDPASSES));
+       // 2 x 6 x 3 gains and flags
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(36 * (sizeof(casacore::Complex) + sizeof(casacore::Bool))),
+                            stats.bytes(CalibrationStatistics::FILL_GAINS));
+       const casacore::uInt64 nFills = stats.nCacheFills();
+       CPPUNIT_ASSERT(nFills >= 3);
+       const casacore::uInt64 nHits = stats.nCacheHits();
+       acc->jonesValid(1, 1, 1);
+       CPPUNIT_ASSERT_EQUAL(nFills, stats.nCacheFills());
+       CPPUNIT_ASSERT(stats.nCacheHits() > nHits);
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nCalls(CalibrationStatistics::FILL_GAINS));
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nJonesCalls());
+       casacore::Cube<casacore::Complex> jones;
+       casacore::Matrix<casacore::Bool> validity;
+       acc->jonesBlock(1, 6, 0, 8, jones, validity);
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nJonesBlockCalls());
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(48), stats.nJonesBlockMatrices());
+       CPPUNIT_ASSERT(stats.time(CalibrationStatistics::FILL_GAINS) >= 0.);
+       stats.log();
+       // nothing is counted when the collection is switched off
+       stats.enable(false);
+       acc->jones(0, 0, 1);
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nJonesCalls());
+       stats.reset();
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.nCalls(CalibrationStatistics::SOLUTION_ID));
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.nCacheFills());
+       stats.enable(wasEnabled);
+   }
+
+   void testClientCache() {
+       testCreate();
+       const boost::shared_ptr<TableCalSolutionConstSource> src(new TableCalSolutionConstSource("calibdata.tab"));
+       // no more than two cached solutions
+       const CachingCalSolutionConstSource css(src, 3600., 2);
+       CPPUNIT_ASSERT_EQUAL(2l, css.mostRecentSolution());
+       CPPUNIT_ASSERT_EQUAL(1l, css.solutionID(60.5));
+       CPPUNIT_ASSERT_EQUAL(1l, css.solutionID(60.5));
+       CPPUNIT_ASSERT_EQUAL(2l, css.solutionID(130.));
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc1 = css.roSolution(1);
+       CPPUNIT_ASSERT(acc1);
+       // the next solution has been obtained in the background
+       CPPUNIT_ASSERT_EQUAL(size_t(2), css.nCached());
+       CPPUNIT_ASSERT(acc1 == css.roSolution(1));
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc2 = css.roSolution(2);
+       CPPUNIT_ASSERT(acc2);
+       CPPUNIT_ASSERT(acc2 == css.roSolution(2));
+       doGainAndLeakageTest(acc2);
+       doBandpassTest(acc2);
+       // the least recently used solution is dropped
+       std::vector<long> ids(3);
+       for (size_t i = 0; i < ids.size(); ++i) {
+            ids[i] = long(i);
+       }
+       css.fetch(ids);
+       CPPUNIT_ASSERT_EQUAL(size_t(2), css.nCached());
+       const JonesJTerm gain = css.roSolution(0)->gain(JonesIndex(0u,0u));
+       CPPUNIT_ASSERT(gain.g1IsValid() && gain.g2IsValid());
+       testComplex(casacore::Complex(1.0,-1.0), gain.g1());
+       testComplex(casacore::Complex(-1.0,1.0), gain.g2());
+   }
+
+   void testOutsideBandpassWindow() {
+       testCreate();
+       const boost::shared_ptr<TableCalSolutionConstSource> css(new TableCalSolutionConstSource("calibdata.tab"));
+       css->setBandpassWindow(1u, 1u, 1u, 4u);
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(2);
+       CPPUNIT_ASSERT(acc);
+       // channel 5 has not been read
+       acc->bandpass(JonesIndex(1u, 1u), 5u);
+   }
+
    void testUndefinedGains() {
        const boost::shared_ptr<ICalSolutionConstAccessor> acc = accessorForExistingTable();
        CPPUNIT_ASSERT(acc);
@@ -29,7 +29,11 @@
 #include <ParsetCalSolutionTest.h>
 #include <CalParamNameHelperTest.h>
 #include <MemCalSolutionAccessorTest.h>
+#include <ParametricBandpassTest.h>
+#include <PackedValidityTest.h>
 #include <TableCalSolutionTest.h>
+#include <BinaryCalSolutionTest.h>
+#include <CalibratingAccessorTest.h>
 
 int main(int argc, char *argv[])
 {
@@ -38,7 +42,11 @@ int main(int argc, char *argv[])
     runner.addTest( askap::accessors::CachedCalSolutionTest::suite());
     runner.addTest( askap::accessors::ParsetCalSolutionTest::suite());
     runner.addTest( askap::accessors::MemCalSolutionAccessorTest::suite());
+    runner.addTest( askap::accessors::ParametricBandpassTest::suite());
+    runner.addTest( askap::accessors::PackedValidityTest::suite());
     runner.addTest( askap::accessors::TableCalSolutionTest::suite());
+    runner.addTest( askap::accessors::BinaryCalSolutionTest::suite());
+    runner.addTest( askap::accessors::CalibratingAccessorTest::suite());
     bool wasSucessful = runner.run();
 
     return wasSucessful ? 0 : 1;
@@ -0,0 +1,101 @@
+/// @file
+/// @brief Tests of the timeline of data access operations
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ACCESS_TRACER_TEST_H
+#define ACCESS_TRACER_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/dataaccess/AccessTracer.h>
+
+// std includes
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+class AccessTracerTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(AccessTracerTest);
+  CPPUNIT_TEST(disabledTest);
+  CPPUNIT_TEST(traceFileTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void disabledTest() {
+     AccessTracer &tracer = AccessTracer::instance();
+     tracer.disable();
+     CPPUNIT_ASSERT(!tracer.isEnabled());
+     const size_t nEvents = tracer.nEvents();
+     {
+       const AccessTracer::Scope trace("disabled", "test");
+     }
+     CPPUNIT_ASSERT_EQUAL(nEvents, tracer.nEvents());
+  }
+
+  void traceFileTest() {
+     AccessTracer &tracer = AccessTracer::instance();
+     tracer.setRank(3);
+     tracer.enable("tAccessTracer_%w.json");
+     CPPUNIT_ASSERT(tracer.isEnabled());
+     {
+       const AccessTracer::Scope outer("outer", "test");
+       const AccessTracer::Scope inner("fillCube", std::string("DATA"), "test");
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(2), tracer.nEvents());
+     tracer.disable();
+     CPPUNIT_ASSERT_EQUAL(3, tracer.rank());
+     std::ifstream is("tAccessTracer_3.json");
+     CPPUNIT_ASSERT(is);
+     std::ostringstream os;
+     os<<is.rdbuf();
+     const std::string content = os.str();
+     CPPUNIT_ASSERT_EQUAL('[', content[0]);
+     CPPUNIT_ASSERT(content.find(']') != std::string::npos);
+     // the inner scope finishes first
+     const size_t innerPos = content.find("\"name\":\"fillCube DATA\"");
+     const size_t outerPos = content.find("\"name\":\"outer\"");
+     CPPUNIT_ASSERT(innerPos != std::string::npos);
+     CPPUNIT_ASSERT(outerPos != std::string::npos);
+     CPPUNIT_ASSERT(innerPos < outerPos);
+     CPPUNIT_ASSERT(content.find("\"ph\":\"X\"") != std::string::npos);
+     CPPUNIT_ASSERT(content.find("\"pid\":3") != std::string::npos);
+     is.close();
+     std::remove("tAccessTracer_3.json");
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ACCESS_TRACER_TEST_H
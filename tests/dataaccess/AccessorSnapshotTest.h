@@ -0,0 +1,106 @@
+/// @file
+/// @brief Tests of the plain accessor snapshot
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ACCESSOR_SNAPSHOT_TEST_H
+#define ACCESSOR_SNAPSHOT_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/dataaccess/AccessorSnapshot.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayMath.h>
+
+namespace askap {
+
+namespace accessors {
+
+class AccessorSnapshotTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(AccessorSnapshotTest);
+  CPPUNIT_TEST(fieldsTest);
+  CPPUNIT_TEST(noCopyTest);
+  CPPUNIT_TEST(emptyTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void fieldsTest() {
+     DataAccessorStub acc(true);
+     acc.itsNoise.set(casacore::Complex(2., 2.));
+     const AccessorSnapshot snap = snapshot(acc, true);
+     CPPUNIT_ASSERT_EQUAL(acc.nRow(), snap.nRow());
+     CPPUNIT_ASSERT_EQUAL(acc.nChannel(), snap.nChannel());
+     CPPUNIT_ASSERT_EQUAL(acc.nPol(), snap.nPol());
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(acc.time(), snap.time(), 1e-6);
+     CPPUNIT_ASSERT_EQUAL(size_t(acc.nChannel()), snap.frequency().size());
+     CPPUNIT_ASSERT_EQUAL(size_t(acc.nRow()), snap.antenna1().size());
+     CPPUNIT_ASSERT_EQUAL(size_t(acc.nRow()), snap.uvw().size());
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          CPPUNIT_ASSERT_EQUAL(acc.antenna1()[row], snap.antenna1()[row]);
+          CPPUNIT_ASSERT_EQUAL(acc.antenna2()[row], snap.antenna2()[row]);
+          CPPUNIT_ASSERT_EQUAL(acc.feed1()[row], snap.feed1()[row]);
+          CPPUNIT_ASSERT_EQUAL(acc.feed2()[row], snap.feed2()[row]);
+          for (casacore::uInt dim = 0; dim < 3; ++dim) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(acc.uvw()[row](dim), snap.uvw()[row](dim), 1e-9);
+          }
+          for (casacore::uInt chan = 0; chan < acc.nChannel(); chan += 7) {
+               for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+                    const size_t index = snap.index(row, chan, pol);
+                    CPPUNIT_ASSERT(acc.visibility()(row, chan, pol) == snap.visibility()[index]);
+                    CPPUNIT_ASSERT_EQUAL(acc.flag()(row, chan, pol), snap.flag()[index]);
+                    CPPUNIT_ASSERT(acc.noise()(row, chan, pol) == snap.noise()[index]);
+               }
+          }
+     }
+  }
+
+  void noCopyTest() {
+     DataAccessorStub acc(true);
+     const AccessorSnapshot snap(acc);
+     // contiguous arrays are referenced
+     CPPUNIT_ASSERT(snap.visibility().data() == acc.visibility().data());
+     CPPUNIT_ASSERT(snap.uvw().data() == acc.uvw().data());
+     CPPUNIT_ASSERT(snap.antenna1().data() == acc.antenna1().data());
+     // noise is not taken unless requested
+     CPPUNIT_ASSERT_EQUAL(size_t(0), snap.noise().size());
+  }
+
+  void emptyTest() {
+     const AccessorSnapshot snap;
+     CPPUNIT_ASSERT_EQUAL(0u, snap.nRow());
+     CPPUNIT_ASSERT_EQUAL(size_t(0), snap.visibility().size());
+     CPPUNIT_ASSERT(snap.visibility().begin() == snap.visibility().end());
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ACCESSOR_SNAPSHOT_TEST_H
@@ -0,0 +1,182 @@
+/// @file
+/// @brief Tests of the asynchronous iterator interface
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef ASYNC_DATA_ITERATOR_TEST_H
+#define ASYNC_DATA_ITERATOR_TEST_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/future.hpp>
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/DataIteratorAdapter.h>
+#include <askap/dataaccess/TimeChunkIteratorAdapter.h>
+#include <askap/dataaccess/AsyncDataIterator.h>
+#include <askap/dataaccess/IteratorTaskPool.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// std includes
+#include <string>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief helper counting chunks delivered via callbacks
+/// @details Each callback requests the next chunk until the end of the data
+struct ChunkCountingCallback {
+  ChunkCountingCallback() : itsIterator(NULL), itsCount(0), itsDone(false) {}
+
+  void operator()(AsyncDataIterator::AccessorPtr acc, const std::string &error) {
+     if (acc != NULL) {
+         ++itsCount;
+         itsIterator->next(boost::ref(*this));
+         return;
+     }
+     boost::mutex::scoped_lock lock(itsMutex);
+     itsError = error;
+     itsDone = true;
+     itsChanged.notify_all();
+  }
+
+  void wait() {
+     boost::mutex::scoped_lock lock(itsMutex);
+     while (!itsDone) {
+            itsChanged.wait(lock);
+     }
+  }
+
+  AsyncDataIterator *itsIterator;
+  size_t itsCount;
+  bool itsDone;
+  std::string itsError;
+  boost::mutex itsMutex;
+  boost::condition_variable itsChanged;
+};
+
+class AsyncDataIteratorTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(AsyncDataIteratorTest);
+  CPPUNIT_TEST(testFutures);
+  CPPUNIT_TEST(testCallbacks);
+  CPPUNIT_TEST(testOverlappingRequests);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testFutures() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv = ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     // three iterators, plain and wrapped in adapters, sharing two threads
+     const boost::shared_ptr<IteratorTaskPool> pool(new IteratorTaskPool(2));
+     std::vector<boost::shared_ptr<AsyncDataIterator> > iters;
+     iters.push_back(boost::shared_ptr<AsyncDataIterator>(new AsyncDataIterator(
+                     ds.createConstIterator(conv), pool)));
+     iters.push_back(boost::shared_ptr<AsyncDataIterator>(new AsyncDataIterator(
+                     boost::shared_ptr<IConstDataIterator>(new DataIteratorAdapter(ds.createConstIterator(conv))), pool)));
+     iters.push_back(boost::shared_ptr<AsyncDataIterator>(new AsyncDataIterator(
+                     boost::shared_ptr<IConstDataIterator>(new TimeChunkIteratorAdapter(ds.createConstIterator(conv))), pool)));
+     size_t counter = 0;
+     for (;; ++counter) {
+          std::vector<AsyncDataIterator::Future> futures;
+          for (size_t index = 0; index < iters.size(); ++index) {
+               futures.push_back(iters[index]->next());
+          }
+          const AsyncDataIterator::AccessorPtr first = futures[0].get();
+          for (size_t index = 1; index < futures.size(); ++index) {
+               const AsyncDataIterator::AccessorPtr acc = futures[index].get();
+               CPPUNIT_ASSERT_EQUAL(first == NULL, acc == NULL);
+               if (first != NULL) {
+                   CPPUNIT_ASSERT_DOUBLES_EQUAL(first->time(), acc->time(), 1e-6);
+                   CPPUNIT_ASSERT_EQUAL(first->nRow(), acc->nRow());
+               }
+          }
+          if (first == NULL) {
+              break;
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(420), counter);
+     // rewind
+     iters[0]->init();
+     const AsyncDataIterator::AccessorPtr acc = iters[0]->next().get();
+     CPPUNIT_ASSERT(acc != NULL);
+  }
+
+  void testCallbacks() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     const boost::shared_ptr<IteratorTaskPool> pool(new IteratorTaskPool(1));
+     AsyncDataIterator it(ds.createConstIterator(), pool);
+     ChunkCountingCallback callback;
+     callback.itsIterator = &it;
+     it.next(boost::ref(callback));
+     callback.wait();
+     CPPUNIT_ASSERT_EQUAL(std::string(), callback.itsError);
+     CPPUNIT_ASSERT_EQUAL(size_t(420), callback.itsCount);
+  }
+
+  void testOverlappingRequests() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     const boost::shared_ptr<IteratorTaskPool> pool(new IteratorTaskPool(1));
+     // occupy the only thread, so the request stays in the queue
+     boost::promise<void> release;
+     boost::shared_future<void> released(release.get_future());
+     pool->submit(boost::bind(&AsyncDataIteratorTest::waitFor, released));
+     AsyncDataIterator it(ds.createConstIterator(), pool);
+     AsyncDataIterator::Future future = it.next();
+     CPPUNIT_ASSERT(it.isPending());
+     bool caught = false;
+     try {
+        it.next();
+     }
+     catch (const DataAccessLogicError &) {
+        caught = true;
+     }
+     release.set_value();
+     CPPUNIT_ASSERT(caught);
+     CPPUNIT_ASSERT(future.get() != NULL);
+     CPPUNIT_ASSERT(!it.isPending());
+  }
+
+protected:
+  /// @brief task blocking the pool thread until the future is ready
+  static void waitFor(boost::shared_future<void> future) {
+     future.wait();
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASYNC_DATA_ITERATOR_TEST_H
@@ -0,0 +1,184 @@
+/// @file
+/// @brief Tests of the averaging iterator adapter
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef AVERAGING_ITERATOR_ADAPTER_TEST_H
+#define AVERAGING_ITERATOR_ADAPTER_TEST_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/AveragingIteratorAdapter.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// std includes
+#include <cmath>
+#include <complex>
+
+namespace askap {
+
+namespace accessors {
+
+class AveragingIteratorAdapterTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(AveragingIteratorAdapterTest);
+  CPPUNIT_TEST(testFrequencyAveraging);
+  CPPUNIT_TEST(testTimeAveraging);
+  CPPUNIT_TEST_EXCEPTION(testNoBuffers,AskapError);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  /// @brief helper class to accumulate the expected noise-weighted average
+  struct WeightedSum {
+     WeightedSum() : itsSum(0.,0.), itsSumOfWeights(0.) {}
+
+     /// @brief add one sample element
+     void add(const IConstDataAccessor &acc, casacore::uInt row, casacore::uInt chan, casacore::uInt pol) {
+        if (!acc.flag()(row,chan,pol) && (casacore::real(acc.noise()(row,chan,pol)) > 0.)) {
+            const double weight = 1. / casacore::square(casacore::real(acc.noise()(row,chan,pol)));
+            itsSum += std::complex<double>(acc.visibility()(row,chan,pol)) * weight;
+            itsSumOfWeights += weight;
+        }
+     }
+
+     /// @brief compare the average with the given accessor
+     void check(const IConstDataAccessor &acc, casacore::uInt row, casacore::uInt chan, casacore::uInt pol) const {
+        if (itsSumOfWeights > 0.) {
+            CPPUNIT_ASSERT(!acc.flag()(row,chan,pol));
+            const std::complex<double> expected = itsSum / itsSumOfWeights;
+            CPPUNIT_ASSERT(std::abs(expected - std::complex<double>(acc.visibility()(row,chan,pol))) < 
+                           1e-5 * std::max(1., std::abs(expected)));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(1. / std::sqrt(itsSumOfWeights), 
+                           casacore::real(acc.noise()(row,chan,pol)), 1e-5);
+        } else {
+            CPPUNIT_ASSERT(acc.flag()(row,chan,pol));
+        }
+     }
+
+     std::complex<double> itsSum;
+     double itsSumOfWeights;
+  };
+
+public:
+  void testFrequencyAveraging() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     const casacore::uInt nChanAvg = 4;
+     IConstDataSharedIter rawIt = ds.createConstIterator(conv);
+     boost::shared_ptr<AveragingIteratorAdapter> it(new AveragingIteratorAdapter(ds.createConstIterator(conv), nChanAvg));
+     size_t counter = 0;
+     for (; it->hasMore(); it->next(), rawIt.next(), ++counter) {
+          CPPUNIT_ASSERT(rawIt.hasMore());
+          CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), it->nChunksAveraged());
+          const IConstDataAccessor &acc = *(*it);
+          const IConstDataAccessor &rawAcc = *rawIt;
+          CPPUNIT_ASSERT_EQUAL(rawAcc.nRow(), acc.nRow());
+          CPPUNIT_ASSERT_EQUAL(rawAcc.nPol(), acc.nPol());
+          CPPUNIT_ASSERT_EQUAL((rawAcc.nChannel() + nChanAvg - 1) / nChanAvg, acc.nChannel());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(rawAcc.time(), acc.time(), 1e-6);
+          CPPUNIT_ASSERT_EQUAL(acc.nChannel(), casacore::uInt(acc.frequency().nelements()));
+          for (casacore::uInt outChan = 0; outChan < acc.nChannel(); ++outChan) {
+               double freq = 0.;
+               casacore::uInt nAveraged = 0;
+               for (casacore::uInt chan = outChan * nChanAvg; (chan < rawAcc.nChannel()) && 
+                    (chan < (outChan + 1) * nChanAvg); ++chan, ++nAveraged) {
+                    freq += rawAcc.frequency()[chan];
+               }
+               CPPUNIT_ASSERT(nAveraged > 0);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(freq / nAveraged, acc.frequency()[outChan], 1e-3);
+          }
+          for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+               for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(rawAcc.uvw()[row](dim), acc.uvw()[row](dim), 1e-6);
+               }
+               for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+                    WeightedSum sum;
+                    for (casacore::uInt chan = 0; chan < nChanAvg; ++chan) {
+                         sum.add(rawAcc, row, chan, pol);
+                    }
+                    sum.check(acc, row, 0, pol);
+               }
+          }
+     }
+     CPPUNIT_ASSERT(!rawIt.hasMore());
+     CPPUNIT_ASSERT_EQUAL(size_t(420), counter);
+  }
+
+  void testTimeAveraging() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     const double interval = 5990.;
+     IConstDataSharedIter rawIt = ds.createConstIterator(conv);
+     boost::shared_ptr<AveragingIteratorAdapter> it(new AveragingIteratorAdapter(ds.createConstIterator(conv), 1, interval));
+     size_t counter = 0;
+     size_t totalChunks = 0;
+     for (; it->hasMore(); it->next(), ++counter) {
+          const IConstDataAccessor &acc = *(*it);
+          const casacore::uInt nChunks = it->nChunksAveraged();
+          CPPUNIT_ASSERT(nChunks > 0);
+          totalChunks += nChunks;
+          // compare the first element against the chunks of the raw iterator
+          WeightedSum sum;
+          double startTime = 0.;
+          double meanTime = 0.;
+          for (casacore::uInt chunk = 0; chunk < nChunks; ++chunk, rawIt.next()) {
+               CPPUNIT_ASSERT(rawIt.hasMore());
+               if (chunk == 0) {
+                   startTime = rawIt->time();
+               }
+               CPPUNIT_ASSERT(rawIt->time() - startTime < interval);
+               CPPUNIT_ASSERT_EQUAL(rawIt->nRow(), acc.nRow());
+               meanTime += rawIt->time();
+               sum.add(*rawIt, 0, 0, 0);
+          }
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(meanTime / nChunks, acc.time(), 1e-3);
+          sum.check(acc, 0, 0, 0);
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(420), totalChunks);
+     CPPUNIT_ASSERT(counter >= 42);
+     CPPUNIT_ASSERT(counter < 420);
+  }
+
+  void testNoBuffers() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     boost::shared_ptr<AveragingIteratorAdapter> it(new AveragingIteratorAdapter(ds.createConstIterator(), 2));
+     // this should generate an exception
+     it->buffer("TEST");
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef AVERAGING_ITERATOR_ADAPTER_TEST_H
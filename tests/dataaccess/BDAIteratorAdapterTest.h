@@ -0,0 +1,164 @@
+/// @file
+/// @brief Tests of the baseline-dependent averaging iterator adapter
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef BDA_ITERATOR_ADAPTER_TEST_H
+#define BDA_ITERATOR_ADAPTER_TEST_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/BDAIteratorAdapter.h>
+#include <askap/dataaccess/AveragingIteratorAdapter.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+class BDAIteratorAdapterTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(BDAIteratorAdapterTest);
+  CPPUNIT_TEST(testAveragingFor);
+  CPPUNIT_TEST(testUniformAveraging);
+  CPPUNIT_TEST(testVolumeConservation);
+  CPPUNIT_TEST_EXCEPTION(testNoBuffers,AskapError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testAveragingFor() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     // 1 degree field, 1% loss, up to 64 s and 16 channels
+     BDAIteratorAdapter it(ds.createConstIterator(), casacore::C::pi / 180., 0.01, 64., 16);
+     // zero length baselines (autocorrelations) are averaged as much as possible
+     std::pair<casacore::uInt, casacore::uInt> res = it.averagingFor(0., 1.4e9, 1e6);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), res.first);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(16), res.second);
+     // no frequency averaging if the channel width is not known
+     res = it.averagingFor(0., 1.4e9, 0.);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), res.second);
+     // longer baselines get shorter intervals and fewer channels
+     std::pair<casacore::uInt, casacore::uInt> prev = it.averagingFor(10., 1.4e9, 1e6);
+     for (double length = 20.; length < 1e5; length *= 2) {
+          res = it.averagingFor(length, 1.4e9, 1e6);
+          CPPUNIT_ASSERT(res.first >= prev.first);
+          CPPUNIT_ASSERT(res.second <= prev.second);
+          prev = res;
+     }
+     CPPUNIT_ASSERT(prev.first > 0);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), prev.second);
+     // 6 km baseline at 1.4 GHz: fringe rate at 1 deg ~ 0.224 rad/s, 
+     // maximum phase change sqrt(0.24) ~ 0.49 rad, integration should be <= 2.19 s
+     res = it.averagingFor(6000., 1.4e9, 1e6);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(5), res.first);
+     // 20 kHz channels at 6 km: phase change per channel ~ 0.044 rad
+     res = it.averagingFor(6000., 1.4e9, 2e4);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(8), res.second);
+  }
+
+  void testUniformAveraging() {
+     // zero field radius means there is no smearing, the result should be the same
+     // as for the uniform averaging
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     const double interval = 5990.;
+     AveragingIteratorAdapter refIt(ds.createConstIterator(conv), 4, interval);
+     BDAIteratorAdapter it(ds.createConstIterator(conv), 0., 0.01, interval, 5);
+     size_t counter = 0;
+     for (; it.hasMore(); it.next(), refIt.next(), ++counter) {
+          CPPUNIT_ASSERT(refIt.hasMore());
+          CPPUNIT_ASSERT_EQUAL(refIt.nChunksAveraged(), it.nChunksAveraged());
+          CPPUNIT_ASSERT_EQUAL(casacore::uInt(4), it.nChannelsAveraged());
+          const IConstDataAccessor &acc = *it;
+          const IConstDataAccessor &refAcc = *refIt;
+          CPPUNIT_ASSERT_EQUAL(refAcc.nRow(), acc.nRow());
+          CPPUNIT_ASSERT_EQUAL(refAcc.nChannel(), acc.nChannel());
+          CPPUNIT_ASSERT_EQUAL(refAcc.nPol(), acc.nPol());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(refAcc.time(), acc.time(), 1e-6);
+          for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+               CPPUNIT_ASSERT_EQUAL(refAcc.antenna1()[row], acc.antenna1()[row]);
+               CPPUNIT_ASSERT_EQUAL(refAcc.antenna2()[row], acc.antenna2()[row]);
+               for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+                    for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+                         CPPUNIT_ASSERT_EQUAL(refAcc.flag()(row,chan,pol), acc.flag()(row,chan,pol));
+                         CPPUNIT_ASSERT(std::abs(refAcc.visibility()(row,chan,pol) - 
+                                        acc.visibility()(row,chan,pol)) < 1e-5);
+                    }
+               }
+          }
+     }
+     CPPUNIT_ASSERT(!refIt.hasMore());
+     CPPUNIT_ASSERT(counter >= 42);
+  }
+
+  void testVolumeConservation() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     size_t totalRows = 0;
+     for (IConstDataSharedIter rawIt = ds.createConstIterator(conv); rawIt != rawIt.end(); ++rawIt) {
+          totalRows += rawIt->nRow();
+     }
+     // 5 degree field and 1% loss
+     BDAIteratorAdapter it(ds.createConstIterator(conv), 5. * casacore::C::pi / 180., 0.01, 5990.);
+     size_t rowsSeen = 0;
+     size_t counter = 0;
+     for (; it.hasMore(); it.next(), ++counter) {
+          const casacore::uInt nChunks = it.nChunksAveraged();
+          CPPUNIT_ASSERT(nChunks > 0);
+          CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), it.nChannelsAveraged());
+          CPPUNIT_ASSERT(it->nRow() > 0);
+          rowsSeen += it->nRow() * nChunks;
+     }
+     // every input row contributes exactly once
+     CPPUNIT_ASSERT_EQUAL(totalRows, rowsSeen);
+     CPPUNIT_ASSERT(counter >= 42);
+  }
+
+  void testNoBuffers() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     BDAIteratorAdapter it(ds.createConstIterator(), 0.01, 0.01, 100.);
+     // this should generate an exception
+     it.buffer("TEST");
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef BDA_ITERATOR_ADAPTER_TEST_H
@@ -0,0 +1,160 @@
+/// @file
+/// @brief Tests of the baseline-major iterator adapter
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef BASELINE_MAJOR_ITERATOR_ADAPTER_TEST_H
+#define BASELINE_MAJOR_ITERATOR_ADAPTER_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/BaselineMajorIteratorAdapter.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// std includes
+#include <map>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+class BaselineMajorIteratorAdapterTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(BaselineMajorIteratorAdapterTest);
+  CPPUNIT_TEST(testByBaseline);
+  CPPUNIT_TEST(testByAntenna);
+  CPPUNIT_TEST(testInit);
+  CPPUNIT_TEST_EXCEPTION(testNoBuffers,AskapError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testByBaseline() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     // visibilities of each baseline and time in the original order
+     typedef std::pair<std::pair<casacore::uInt, casacore::uInt>, double> Key;
+     std::map<Key, casacore::Complex> refVis;
+     size_t totalRows = 0;
+     for (IConstDataSharedIter rawIt = ds.createConstIterator(conv); rawIt != rawIt.end(); ++rawIt) {
+          for (casacore::uInt row = 0; row < rawIt->nRow(); ++row) {
+               refVis[Key(std::make_pair(rawIt->antenna1()[row], rawIt->antenna2()[row]), rawIt->time())] = 
+                      rawIt->visibility()(row, 0, 0);
+          }
+          totalRows += rawIt->nRow();
+     }
+     BaselineMajorIteratorAdapter it(ds.createConstIterator(conv), 5990.);
+     size_t rowsSeen = 0;
+     for (; it.hasMore(); it.next()) {
+          const IConstDataAccessor &acc = *it;
+          CPPUNIT_ASSERT(acc.nRow() > 0);
+          CPPUNIT_ASSERT(it.nChunksGathered() > 0);
+          const casacore::Vector<casacore::Double> &rowTime = it.rowTime();
+          CPPUNIT_ASSERT_EQUAL(acc.nRow(), casacore::uInt(rowTime.nelements()));
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(rowTime[0], acc.time(), 1e-6);
+          for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+               // single baseline per accessor, rows in time order
+               CPPUNIT_ASSERT_EQUAL(acc.antenna1()[0], acc.antenna1()[row]);
+               CPPUNIT_ASSERT_EQUAL(acc.antenna2()[0], acc.antenna2()[row]);
+               CPPUNIT_ASSERT_EQUAL(acc.feed1()[0], acc.feed1()[row]);
+               CPPUNIT_ASSERT_EQUAL(acc.feed2()[0], acc.feed2()[row]);
+               if (row > 0) {
+                   CPPUNIT_ASSERT(rowTime[row] >= rowTime[row - 1]);
+               }
+               const std::map<Key, casacore::Complex>::const_iterator ci = 
+                     refVis.find(Key(std::make_pair(acc.antenna1()[row], acc.antenna2()[row]), rowTime[row]));
+               CPPUNIT_ASSERT(ci != refVis.end());
+               CPPUNIT_ASSERT(std::abs(ci->second - acc.visibility()(row, 0, 0)) < 1e-7);
+          }
+          rowsSeen += acc.nRow();
+     }
+     // every input row is delivered exactly once
+     CPPUNIT_ASSERT_EQUAL(totalRows, rowsSeen);
+  }
+
+  void testByAntenna() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     size_t totalRows = 0;
+     size_t autoRows = 0;
+     for (IConstDataSharedIter rawIt = ds.createConstIterator(); rawIt != rawIt.end(); ++rawIt) {
+          for (casacore::uInt row = 0; row < rawIt->nRow(); ++row) {
+               if (rawIt->antenna1()[row] == rawIt->antenna2()[row]) {
+                   ++autoRows;
+               }
+          }
+          totalRows += rawIt->nRow();
+     }
+     // the whole dataset in one window
+     BaselineMajorIteratorAdapter it(ds.createConstIterator(), -1., BaselineMajorIteratorAdapter::BY_ANTENNA);
+     size_t rowsSeen = 0;
+     for (; it.hasMore(); it.next()) {
+          const IConstDataAccessor &acc = *it;
+          CPPUNIT_ASSERT(acc.nRow() > 0);
+          // all rows should share the same antenna, either the first or the second antenna of row 0
+          bool hasFirst = true;
+          bool hasSecond = true;
+          for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+               hasFirst &= (acc.antenna1()[row] == acc.antenna1()[0]) || (acc.antenna2()[row] == acc.antenna1()[0]);
+               hasSecond &= (acc.antenna1()[row] == acc.antenna2()[0]) || (acc.antenna2()[row] == acc.antenna2()[0]);
+          }
+          CPPUNIT_ASSERT(hasFirst || hasSecond);
+          rowsSeen += acc.nRow();
+     }
+     // cross-correlations are delivered twice, once for each antenna
+     CPPUNIT_ASSERT_EQUAL(2 * totalRows - autoRows, rowsSeen);
+  }
+
+  void testInit() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     BaselineMajorIteratorAdapter it(ds.createConstIterator(), 5990.);
+     size_t counter = 0;
+     for (; it.hasMore(); it.next()) {
+          ++counter;
+     }
+     CPPUNIT_ASSERT(counter > 0);
+     it.init();
+     size_t counter2 = 0;
+     for (; it.hasMore(); it.next()) {
+          ++counter2;
+     }
+     CPPUNIT_ASSERT_EQUAL(counter, counter2);
+  }
+
+  void testNoBuffers() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     BaselineMajorIteratorAdapter it(ds.createConstIterator(), 100.);
+     // this should generate an exception
+     it.buffer("TEST");
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef BASELINE_MAJOR_ITERATOR_ADAPTER_TEST_H
@@ -0,0 +1,161 @@
+/// @file
+/// @brief Tests of the compact representations of the buffer cubes
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+/// 
+
+#ifndef BUFFER_CODEC_TEST_H
+#define BUFFER_CODEC_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+
+// own includes
+#include <askap/dataaccess/BufferCodec.h>
+#include <askap/dataaccess/CompressingBufferManager.h>
+#include <askap/dataaccess/FileBufferManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+namespace askap {
+
+namespace accessors {
+
+class BufferCodecTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(BufferCodecTest);
+  CPPUNIT_TEST(halfTest);
+  CPPUNIT_TEST(float16Test);
+  CPPUNIT_TEST(quant8Test);
+  CPPUNIT_TEST_EXCEPTION(codecMismatchTest, DataAccessError);
+  CPPUNIT_TEST(adapterTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  
+  void halfTest() {
+     // all finite half precision values should survive the round trip
+     for (casacore::uInt half = 0; half < 65536u; ++half) {
+          const float value = BufferCodec::halfToFloat(casacore::uShort(half));
+          if ((half & 0x7c00u) != 0x7c00u) {
+              CPPUNIT_ASSERT_EQUAL(casacore::uShort(half), BufferCodec::floatToHalf(value));
+          }
+     }
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(1., BufferCodec::halfToFloat(BufferCodec::floatToHalf(1.)), 0.);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.5, BufferCodec::halfToFloat(BufferCodec::floatToHalf(-2.5)), 0.);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(65504., BufferCodec::halfToFloat(BufferCodec::floatToHalf(65504.)), 0.);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, BufferCodec::halfToFloat(BufferCodec::floatToHalf(0.1)), 1e-4);
+  }
+
+  void float16Test() {
+     casacore::Cube<casacore::Complex> cube(7,5,4);
+     fillCube(cube);
+     casacore::Cube<casacore::Complex> encoded;
+     BufferCodec::encode(cube, BufferCodec::FLOAT16, encoded);
+     // half of the size plus the header
+     CPPUNIT_ASSERT_EQUAL(size_t(2 + 7 * 5 * 2), encoded.nelements());
+     casacore::Cube<casacore::Complex> decoded;
+     BufferCodec::decode(encoded, BufferCodec::FLOAT16, decoded);
+     CPPUNIT_ASSERT(decoded.shape() == cube.shape());
+     CPPUNIT_ASSERT(allLE(abs(decoded - cube), abs(cube) * casacore::Float(1e-3)));
+  }
+
+  void quant8Test() {
+     // an incomplete block at the end
+     casacore::Cube<casacore::Complex> cube(30,11,4);
+     fillCube(cube);
+     casacore::Cube<casacore::Complex> encoded;
+     BufferCodec::encode(cube, BufferCodec::QUANT8, encoded);
+     CPPUNIT_ASSERT(encoded.nelements() * 3 < cube.nelements());
+     casacore::Cube<casacore::Complex> decoded;
+     BufferCodec::decode(encoded, BufferCodec::QUANT8, decoded);
+     CPPUNIT_ASSERT(decoded.shape() == cube.shape());
+     // the values don't exceed 1000 in magnitude
+     const float maxError = 1000. * sqrt(2.) / 254. * 1.001;
+     CPPUNIT_ASSERT(allLE(abs(decoded - cube), maxError));
+     // zero block 
+     cube.set(casacore::Complex(0.,0.));
+     BufferCodec::encode(cube, BufferCodec::QUANT8, encoded);
+     BufferCodec::decode(encoded, BufferCodec::QUANT8, decoded);
+     CPPUNIT_ASSERT(allEQ(decoded, casacore::Complex(0.,0.)));
+  }
+
+  void codecMismatchTest() {
+     casacore::Cube<casacore::Complex> cube(3,2,1);
+     fillCube(cube);
+     casacore::Cube<casacore::Complex> encoded;
+     BufferCodec::encode(cube, BufferCodec::FLOAT16, encoded);
+     casacore::Cube<casacore::Complex> decoded;
+     // should throw DataAccessError
+     BufferCodec::decode(encoded, BufferCodec::QUANT8, decoded);
+  }
+
+  void adapterTest() {
+     boost::shared_ptr<IBufferManager const> store(new FileBufferManager("tBufferCodec"));
+     CompressingBufferManager bufferMgr(store);
+     bufferMgr.setCodec("MODEL", BufferCodec::FLOAT16);
+     CPPUNIT_ASSERT(bufferMgr.codec("MODEL") == BufferCodec::FLOAT16);
+     CPPUNIT_ASSERT(bufferMgr.codec("TEST") == BufferCodec::NONE);
+     casacore::Cube<casacore::Complex> cube(7,5,4);
+     fillCube(cube);
+     bufferMgr.writeBuffer(cube, "MODEL", 1);
+     bufferMgr.writeBuffer(cube, "TEST", 1);
+     CPPUNIT_ASSERT(bufferMgr.bufferExists("MODEL", 1));
+     CPPUNIT_ASSERT(!bufferMgr.bufferExists("MODEL", 0));
+     casacore::Cube<casacore::Complex> result;
+     // only the compressed buffer is stored in a different form
+     store->readBuffer(result, "MODEL", 1);
+     CPPUNIT_ASSERT(result.nelements() < cube.nelements());
+     store->readBuffer(result, "TEST", 1);
+     CPPUNIT_ASSERT(allEQ(result, cube));
+     bufferMgr.readBuffer(result, "MODEL", 1);
+     CPPUNIT_ASSERT(result.shape() == cube.shape());
+     CPPUNIT_ASSERT(allLE(abs(result - cube), abs(cube) * casacore::Float(1e-3)));
+  }
+
+protected:
+  /// @brief fill the cube with values of various magnitudes
+  /// @param[in] cube cube to fill
+  static void fillCube(casacore::Cube<casacore::Complex> &cube) {
+     for (casacore::uInt row = 0; row < cube.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < cube.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < cube.nplane(); ++pol) {
+                    cube(row, chan, pol) = casacore::Complex(float(row) * 33.3 - 500., 
+                                  (float(chan) + 0.5) * (pol % 2 ? -1. : 1.) * 7.1);
+               }
+          }
+     }
+  }
+}; // class BufferCodecTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef BUFFER_CODEC_TEST_H
@@ -46,13 +46,27 @@ class CachedAccessorFieldTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(CachedAccessorFieldTest);
   CPPUNIT_TEST(readOnDemandTest);
   CPPUNIT_TEST(writeTest);
+  CPPUNIT_TEST(concurrentReadTest);
   CPPUNIT_TEST_EXCEPTION(readRequiredTest, AskapError);
   CPPUNIT_TEST_EXCEPTION(readRequiredBeforeWriteTest, AskapError);
   CPPUNIT_TEST_EXCEPTION(readUnsyncedTest, AskapError);
   CPPUNIT_TEST_SUITE_END();
 private:
   CachedAccessorField<std::string> itsCAF;
+  /// @brief number of calls to countingFiller
+  mutable int itsNFills;
 public:
+  void setUp() {
+       itsNFills = 0;
+  }
+
+  void countingFiller(std::string &str) const {
+       #ifdef _OPENMP
+       #pragma omp atomic
+       #endif
+       ++itsNFills;
+       str="filled by countingFiller";
+  }
   void stringFiller(std::string &str) const {
         str="filled by stringFiller";
   }
@@ -127,6 +141,27 @@ public:
      CPPUNIT_ASSERT_EQUAL(std::string("overwritten"), result);               
   }
   
+  void concurrentReadTest() {
+     int nWrong = 0;
+     // many threads ask for the field at once, only one of them should read it
+     #ifdef _OPENMP
+     #pragma omp parallel for reduction(+:nWrong)
+     #endif
+     for (int i = 0; i < 10000; ++i) {
+          if (itsCAF.value(*this, &CachedAccessorFieldTest::countingFiller) != "filled by countingFiller") {
+              ++nWrong;
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(0, nWrong);
+     CPPUNIT_ASSERT_EQUAL(1, itsNFills);
+     CPPUNIT_ASSERT(itsCAF.isValid());
+     itsCAF.invalidate();
+     CPPUNIT_ASSERT(!itsCAF.isValid());
+     CPPUNIT_ASSERT_EQUAL(std::string("filled by countingFiller"),
+                itsCAF.value(*this, &CachedAccessorFieldTest::countingFiller));
+     CPPUNIT_ASSERT_EQUAL(2, itsNFills);
+  }
+
   void readRequiredTest() {
      CPPUNIT_ASSERT(!itsCAF.isValid());
      CPPUNIT_ASSERT(!itsCAF.flushNeeded());
@@ -0,0 +1,146 @@
+/// @file
+/// @brief Tests of the pool of recycled chunk buffers
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+/// 
+
+#ifndef CHUNK_POOL_TEST_H
+#define CHUNK_POOL_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+// own includes
+#include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/ChunkPool.h>
+#include <askap/dataaccess/BoundedChunkQueue.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+class ChunkPoolTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ChunkPoolTest);
+  CPPUNIT_TEST(testRecycling);
+  CPPUNIT_TEST(testPipeline);
+  CPPUNIT_TEST_EXCEPTION(testNoBuffers,AskapError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testRecycling() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IConstDataSharedIter it = ds.createConstIterator();
+     ChunkPool pool(2);
+     CPPUNIT_ASSERT_EQUAL(size_t(2), pool.size());
+     CPPUNIT_ASSERT_EQUAL(size_t(2), pool.nFree());
+     const casacore::Complex firstVis = it->visibility()(0, 0, 0);
+     ChunkPool::ChunkPtr first = pool.acquire(*it);
+     it.next();
+     ChunkPool::ChunkPtr second = pool.acquire(*it);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), pool.nFree());
+     CPPUNIT_ASSERT(!pool.tryAcquire(*it));
+     // the chunk is not affected by the iterator moving on
+     it.next();
+     CPPUNIT_ASSERT(first->nRow() > 0);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0., casacore::abs(first->visibility()(0, 0, 0) - firstVis), 1e-6);
+     // the buffer returns to the pool when the last holder releases it
+     const GatheredDataAccessor *firstBuffer = first.get();
+     ChunkPool::ChunkPtr copy = first;
+     first.reset();
+     CPPUNIT_ASSERT_EQUAL(size_t(0), pool.nFree());
+     copy.reset();
+     CPPUNIT_ASSERT_EQUAL(size_t(1), pool.nFree());
+     ChunkPool::ChunkPtr third = pool.tryAcquire(*it);
+     CPPUNIT_ASSERT(third);
+     CPPUNIT_ASSERT(third.get() == firstBuffer);
+     CPPUNIT_ASSERT_EQUAL(it->nRow(), third->nRow());
+     // chunks may outlive the pool
+     second.reset();
+  }
+
+  void testPipeline() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     // reference values of the original iterator
+     std::vector<casacore::Complex> refVis;
+     std::vector<double> refTime;
+     for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+          refVis.push_back(it->visibility()(it->nRow() - 1, 0, 0));
+          refTime.push_back(it->time());
+     }
+     ChunkPool pool(3);
+     BoundedChunkQueue queue(2);
+     boost::thread producer(boost::bind(&ChunkPoolTest::produce, 
+                            ds.createConstIterator(), boost::ref(pool), boost::ref(queue)));
+     // values are checked after the producer has finished, so it never waits forever
+     std::vector<casacore::Complex> vis;
+     std::vector<double> time;
+     bool bounded = true;
+     for (BoundedChunkQueue::ChunkPtr chunk = queue.pop(); chunk; chunk = queue.pop()) {
+          vis.push_back(chunk->visibility()(chunk->nRow() - 1, 0, 0));
+          time.push_back(chunk->time());
+          // no more chunks than buffers in flight
+          bounded = bounded && (pool.nFree() < pool.size());
+     }
+     producer.join();
+     CPPUNIT_ASSERT(bounded);
+     CPPUNIT_ASSERT_EQUAL(pool.size(), pool.nFree());
+     CPPUNIT_ASSERT_EQUAL(refVis.size(), vis.size());
+     for (size_t chunk = 0; chunk < vis.size(); ++chunk) {
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(refTime[chunk], time[chunk], 1e-6);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(0., casacore::abs(vis[chunk] - refVis[chunk]), 1e-6);
+     }
+  }
+
+  void testNoBuffers() {
+     ChunkPool pool(0);
+  }
+
+protected:
+  /// @brief producer thread of the pipeline test
+  /// @param[in] it iterator to read
+  /// @param[in] pool pool of buffers
+  /// @param[in] queue queue to fill
+  static void produce(IConstDataSharedIter it, ChunkPool &pool, BoundedChunkQueue &queue) {
+     for (; it != it.end(); ++it) {
+          if (!queue.push(pool.acquire(*it))) {
+              break;
+          }
+     }
+     queue.finish();
+  }
+}; // class ChunkPoolTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef CHUNK_POOL_TEST_H
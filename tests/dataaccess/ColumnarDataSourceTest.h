@@ -0,0 +1,200 @@
+/// @file
+/// @brief Tests of the columnar visibility format
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef COLUMNAR_DATA_SOURCE_TEST_H
+#define COLUMNAR_DATA_SOURCE_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/ColumnarDataSource.h>
+#include <askap/dataaccess/ColumnarDataWriter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// casa includes
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/tables/Tables/Table.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+class ColumnarDataSourceTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ColumnarDataSourceTest);
+  CPPUNIT_TEST(testRoundTrip);
+  CPPUNIT_TEST(testSelection);
+  CPPUNIT_TEST(testCycleSelection);
+  CPPUNIT_TEST(testMetadata);
+  CPPUNIT_TEST_EXCEPTION(testUnsupportedSelection, DataAccessLogicError);
+  CPPUNIT_TEST_EXCEPTION(testChannelAveraging, DataAccessLogicError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {
+     itsDirName = "./.test.columnar";
+     ColumnarDataWriter writer(itsDirName);
+     writer.copyMetadata(casacore::Table(TableTestRunner::msName()));
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv = ds.createConverter();
+     ColumnarDataWriter::configureConverter(*conv);
+     for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end(); ++it) {
+          writer.write(*it);
+     }
+     writer.close();
+  }
+
+  void tearDown() {
+     casacore::Directory dir(itsDirName);
+     if (dir.exists()) {
+         dir.removeRecursive();
+     }
+  }
+
+  void testRoundTrip() {
+     ColumnarDataSource cds(itsDirName);
+     TableConstDataSource ds(TableTestRunner::msName());
+     CPPUNIT_ASSERT_EQUAL(size_t(420), cds.nChunk());
+     compare(ds, ds.createSelector(), cds, cds.createSelector(), 420);
+  }
+
+  void testSelection() {
+     ColumnarDataSource cds(itsDirName);
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataSelectorPtr sel = ds.createSelector();
+     IDataSelectorPtr csel = cds.createSelector();
+     sel->chooseCrossCorrelations();
+     csel->chooseCrossCorrelations();
+     sel->chooseBaseline(0, 1);
+     csel->chooseBaseline(0, 1);
+     sel->chooseChannels(4, 3);
+     csel->chooseChannels(4, 3);
+     compare(ds, sel, cds, csel, 420);
+  }
+
+  void testCycleSelection() {
+     ColumnarDataSource cds(itsDirName);
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataSelectorPtr sel = ds.createSelector();
+     IDataSelectorPtr csel = cds.createSelector();
+     sel->chooseCycles(10, 20);
+     csel->chooseCycles(10, 20);
+     compare(ds, sel, cds, csel, 11);
+  }
+
+  void testMetadata() {
+     ColumnarDataSource cds(itsDirName);
+     CPPUNIT_ASSERT(cds.hasMetadata());
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv = ds.createConverter();
+     ColumnarDataWriter::configureConverter(*conv);
+     const IConstDataSharedIter it = ds.createConstIterator(conv);
+     CPPUNIT_ASSERT_EQUAL(it->nChannel(), cds.nChannel());
+     CPPUNIT_ASSERT_EQUAL(it->nPol(), casacore::uInt(cds.stokes().nelements()));
+     for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+          CPPUNIT_ASSERT_EQUAL(it->stokes()[pol], cds.stokes()[pol]);
+     }
+     const casacore::MPosition pos = cds.metadata().getAntenna().getPosition(0);
+     const casacore::Table antTable(TableTestRunner::msName() + "/ANTENNA");
+     CPPUNIT_ASSERT_EQUAL(antTable.nrow(), cds.metadata().getAntenna().getNumberOfAntennae());
+     CPPUNIT_ASSERT(pos.getValue().getLength().getValue() > 0.);
+  }
+
+  void testUnsupportedSelection() {
+     ColumnarDataSource cds(itsDirName);
+     IDataSelectorPtr sel = cds.createSelector();
+     // this should generate an exception
+     sel->chooseSpectralWindow(0);
+  }
+
+  void testChannelAveraging() {
+     ColumnarDataSource cds(itsDirName);
+     IDataSelectorPtr sel = cds.createSelector();
+     // this should generate an exception
+     sel->chooseChannels(4, 0, 2);
+  }
+
+protected:
+  /// @brief compare chunks given by the table and columnar data sources
+  /// @param[in] ds table data source
+  /// @param[in] sel selector for the table data source
+  /// @param[in] cds columnar data source
+  /// @param[in] csel selector for the columnar data source
+  /// @param[in] expected expected number of chunks
+  static void compare(const IConstDataSource &ds, const IDataSelectorPtr &sel,
+                      const IConstDataSource &cds, const IDataSelectorPtr &csel, size_t expected) {
+     IDataConverterPtr conv = ds.createConverter();
+     ColumnarDataWriter::configureConverter(*conv);
+     IDataConverterPtr cconv = cds.createConverter();
+     ColumnarDataWriter::configureConverter(*cconv);
+     IConstDataSharedIter refIt = ds.createConstIterator(sel, conv);
+     size_t counter = 0;
+     for (IConstDataSharedIter it = cds.createConstIterator(csel, cconv); it != it.end(); ++it, ++refIt, ++counter) {
+          CPPUNIT_ASSERT(refIt != refIt.end());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->time(), it->time(), 1e-6);
+          CPPUNIT_ASSERT_EQUAL(refIt->nRow(), it->nRow());
+          CPPUNIT_ASSERT_EQUAL(refIt->nChannel(), it->nChannel());
+          CPPUNIT_ASSERT_EQUAL(refIt->nPol(), it->nPol());
+          for (casacore::uInt chan = 0; chan < refIt->nChannel(); ++chan) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->frequency()[chan], it->frequency()[chan], 1e-3);
+          }
+          for (casacore::uInt row = 0; row < refIt->nRow(); ++row) {
+               CPPUNIT_ASSERT_EQUAL(refIt->antenna1()[row], it->antenna1()[row]);
+               CPPUNIT_ASSERT_EQUAL(refIt->antenna2()[row], it->antenna2()[row]);
+               CPPUNIT_ASSERT_EQUAL(refIt->feed1()[row], it->feed1()[row]);
+               CPPUNIT_ASSERT_EQUAL(refIt->feed2()[row], it->feed2()[row]);
+               for (casacore::uInt coord = 0; coord < 3; ++coord) {
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->uvw()[row](coord), it->uvw()[row](coord), 1e-6);
+               }
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., refIt->pointingDir1()[row].separation(it->pointingDir1()[row]), 1e-9);
+               for (casacore::uInt chan = 0; chan < refIt->nChannel(); ++chan) {
+                    for (casacore::uInt pol = 0; pol < refIt->nPol(); ++pol) {
+                         CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(refIt->visibility()(row, chan, pol) -
+                                             it->visibility()(row, chan, pol)), 1e-6);
+                         CPPUNIT_ASSERT_EQUAL(refIt->flag()(row, chan, pol), it->flag()(row, chan, pol));
+                    }
+               }
+          }
+     }
+     CPPUNIT_ASSERT(refIt == refIt.end());
+     CPPUNIT_ASSERT_EQUAL(expected, counter);
+  }
+
+private:
+  /// @brief directory with the converted test measurement set
+  std::string itsDirName;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef COLUMNAR_DATA_SOURCE_TEST_H
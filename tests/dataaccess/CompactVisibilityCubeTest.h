@@ -0,0 +1,211 @@
+/// @file
+/// @brief Tests of the reduced precision visibility cube
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+/// 
+
+#ifndef COMPACT_VISIBILITY_CUBE_TEST_H
+#define COMPACT_VISIBILITY_CUBE_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/dataaccess/CompactVisibilityCube.h>
+
+// std includes
+#include <cmath>
+#include <limits>
+
+namespace askap {
+
+namespace accessors {
+
+class CompactVisibilityCubeTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(CompactVisibilityCubeTest);
+  CPPUNIT_TEST(int16Test);
+  CPPUNIT_TEST(float16Test);
+  CPPUNIT_TEST(packNativeTest);
+  CPPUNIT_TEST(halfConversionTest);
+  CPPUNIT_TEST(nonFiniteTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  
+  void int16Test() {
+     casacore::Cube<casacore::Complex> vis(5, 33, 2);
+     fillPattern(vis);
+     CompactVisibilityCube packed;
+     CPPUNIT_ASSERT(packed.format() == CompactVisibilityCube::COMPLEX_INT16);
+     packed.pack(vis);
+     CPPUNIT_ASSERT_EQUAL(5u, packed.nRow());
+     CPPUNIT_ASSERT_EQUAL(33u, packed.nChannel());
+     CPPUNIT_ASSERT_EQUAL(2u, packed.nPol());
+     CPPUNIT_ASSERT_EQUAL(size_t(132), packed.wordsPerRow());
+     CPPUNIT_ASSERT_EQUAL(size_t(5 * 132 * 2 + 5 * 4), packed.nBytes());
+     for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+          // the error is within half of the quantisation step of the row
+          const float tolerance = 0.5001f * packed.scale(row);
+          for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                    const casacore::Complex value = packed(row, chan, pol);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(real(vis(row, chan, pol)), real(value), tolerance);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(imag(vis(row, chan, pol)), imag(value), tolerance);
+               }
+          }
+     }
+     // the largest component of the row maps to the largest integer
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(real(vis(4, 32, 1)), real(packed(4, 32, 1)), 1e-6 * real(vis(4, 32, 1)));
+     casacore::Cube<casacore::Complex> unpacked;
+     packed.unpack(unpacked);
+     CPPUNIT_ASSERT(unpacked.shape() == vis.shape());
+     for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                    CPPUNIT_ASSERT(unpacked(row, chan, pol) == packed(row, chan, pol));
+               }
+          }
+     }
+  }
+
+  void float16Test() {
+     casacore::Cube<casacore::Complex> vis(3, 17, 4);
+     fillPattern(vis);
+     CompactVisibilityCube packed(CompactVisibilityCube::COMPLEX_FLOAT16);
+     packed.pack(vis);
+     CPPUNIT_ASSERT(packed.scales() == 0);
+     CPPUNIT_ASSERT_EQUAL(size_t(3 * 17 * 4 * 2 * 2), packed.nBytes());
+     for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                    // 11 significant bits
+                    const casacore::Complex value = packed(row, chan, pol);
+                    const casacore::Complex expected = vis(row, chan, pol);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(real(expected), real(value), std::abs(real(expected)) / 2048.);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(imag(expected), imag(value), std::abs(imag(expected)) / 2048.);
+               }
+          }
+     }
+     // changing the format clears the cube but keeps the shape
+     packed.setFormat(CompactVisibilityCube::COMPLEX_INT16);
+     CPPUNIT_ASSERT_EQUAL(3u, packed.nRow());
+     CPPUNIT_ASSERT(packed.scales() != 0);
+     CPPUNIT_ASSERT(packed(1, 2, 3) == casacore::Complex(0., 0.));
+  }
+
+  void packNativeTest() {
+     casacore::Cube<casacore::Complex> vis(7, 40, 4);
+     fillPattern(vis);
+     casacore::Cube<casacore::Complex> native(4, 40, 7);
+     for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                    native(pol, chan, row) = vis(row, chan, pol);
+               }
+          }
+     }
+     CompactVisibilityCube::Format formats[] = {CompactVisibilityCube::COMPLEX_INT16, 
+                                                CompactVisibilityCube::COMPLEX_FLOAT16};
+     for (size_t i = 0; i < 2; ++i) {
+          CompactVisibilityCube packed(formats[i]);
+          packed.packNative(native);
+          CompactVisibilityCube reference(formats[i]);
+          reference.pack(vis);
+          CPPUNIT_ASSERT_EQUAL(reference.nRow(), packed.nRow());
+          for (size_t word = 0; word < packed.nRow() * packed.wordsPerRow(); ++word) {
+               CPPUNIT_ASSERT_EQUAL(reference.data()[word], packed.data()[word]);
+          }
+          casacore::Cube<casacore::Complex> unpacked;
+          packed.unpackNative(unpacked);
+          CPPUNIT_ASSERT(unpacked.shape() == native.shape());
+          for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+               for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+                    for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                         CPPUNIT_ASSERT(unpacked(pol, chan, row) == packed(row, chan, pol));
+                    }
+               }
+          }
+     }
+  }
+
+  void halfConversionTest() {
+     CPPUNIT_ASSERT_EQUAL(CompactVisibilityCube::Word(0x3c00), CompactVisibilityCube::floatToHalf(1.f));
+     CPPUNIT_ASSERT_EQUAL(CompactVisibilityCube::Word(0xc000), CompactVisibilityCube::floatToHalf(-2.f));
+     CPPUNIT_ASSERT_EQUAL(CompactVisibilityCube::Word(0x7bff), CompactVisibilityCube::floatToHalf(65504.f));
+     CPPUNIT_ASSERT_EQUAL(CompactVisibilityCube::Word(0x7c00), CompactVisibilityCube::floatToHalf(65520.f));
+     // smallest subnormal and the tie between zero and it (rounds to even)
+     CPPUNIT_ASSERT_EQUAL(CompactVisibilityCube::Word(0x0001), CompactVisibilityCube::floatToHalf(std::ldexp(1.f, -24)));
+     CPPUNIT_ASSERT_EQUAL(CompactVisibilityCube::Word(0x0000), CompactVisibilityCube::floatToHalf(std::ldexp(1.f, -25)));
+     // 1 + 2^-11 is halfway between 1 and the next half, rounds to even
+     CPPUNIT_ASSERT_EQUAL(CompactVisibilityCube::Word(0x3c00), CompactVisibilityCube::floatToHalf(1.f + std::ldexp(1.f, -11)));
+     // every half precision number survives the round trip
+     for (casacore::uInt word = 0; word < 0x10000; ++word) {
+          const CompactVisibilityCube::Word half = static_cast<CompactVisibilityCube::Word>(word);
+          const float value = CompactVisibilityCube::halfToFloat(half);
+          if ((half & 0x7c00) == 0x7c00 && (half & 0x3ff)) {
+              CPPUNIT_ASSERT(std::isnan(value));
+          } else {
+              CPPUNIT_ASSERT_EQUAL(half, CompactVisibilityCube::floatToHalf(value));
+          }
+     }
+  }
+
+  void nonFiniteTest() {
+     casacore::Cube<casacore::Complex> vis(2, 3, 1, casacore::Complex(1., -0.5));
+     vis(0, 1, 0) = casacore::Complex(std::numeric_limits<float>::quiet_NaN(), 
+                                      std::numeric_limits<float>::infinity());
+     CompactVisibilityCube packed;
+     packed.pack(vis);
+     // non-finite values don't affect the scale and are stored as zero
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(1. / 32767., packed.scale(0), 1e-9);
+     CPPUNIT_ASSERT(packed(0, 1, 0) == casacore::Complex(0., 0.));
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(1., real(packed(0, 2, 0)), 1e-6);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.5, imag(packed(0, 2, 0)), 1e-4);
+     packed.setFormat(CompactVisibilityCube::COMPLEX_FLOAT16);
+     packed.pack(vis);
+     CPPUNIT_ASSERT(std::isnan(real(packed(0, 1, 0))));
+     CPPUNIT_ASSERT(std::isinf(imag(packed(0, 1, 0))));
+     CPPUNIT_ASSERT(packed(1, 2, 0) == casacore::Complex(1., -0.5));
+  }
+
+protected:
+  /// @brief fill the cube with some irregular pattern of visibilities
+  /// @param[in] vis cube to fill
+  static void fillPattern(casacore::Cube<casacore::Complex> &vis) {
+     for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                    vis(row, chan, pol) = casacore::Complex(0.1 + row + chan * 0.37 + pol, 
+                                                            std::sin(0.3 * chan + row) * (pol + 1));
+               }
+          }
+     }
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef COMPACT_VISIBILITY_CUBE_TEST_H
@@ -0,0 +1,188 @@
+/// @file
+/// @brief Tests of the CubeTransposer kernel
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+/// 
+
+#ifndef CUBE_TRANSPOSER_TEST_H
+#define CUBE_TRANSPOSER_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayMath.h>
+
+// own includes
+#include <askap/dataaccess/CubeTransposer.h>
+
+namespace askap {
+
+namespace accessors {
+
+class CubeTransposerTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(CubeTransposerTest);
+  CPPUNIT_TEST(complexTransposeTest);
+  CPPUNIT_TEST(noiseTransposeTest);
+  CPPUNIT_TEST(flagTransposeTest);
+  CPPUNIT_TEST(broadcastTest);
+  CPPUNIT_TEST(rowTransposeTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  
+  void complexTransposeTest() {
+     // cover all specialisations for the number of polarisations and
+     // shapes which are not multiples of the tile size
+     const casacore::uInt pols[] = {1, 2, 3, 4};
+     for (size_t i = 0; i < 4; ++i) {
+          casacore::Cube<casacore::Complex> in(pols[i], 37, 71);
+          for (casacore::uInt pol = 0; pol < in.nrow(); ++pol) {
+               for (casacore::uInt chan = 0; chan < in.ncolumn(); ++chan) {
+                    for (casacore::uInt row = 0; row < in.nplane(); ++row) {
+                         in(pol,chan,row) = casacore::Complex(pol + 10. * chan, row);
+                    }
+               }
+          }
+          casacore::Cube<casacore::Complex> out;
+          CubeTransposer::transpose(in, out);
+          CPPUNIT_ASSERT_EQUAL(in.nplane(), out.nrow());
+          CPPUNIT_ASSERT_EQUAL(in.ncolumn(), out.ncolumn());
+          CPPUNIT_ASSERT_EQUAL(in.nrow(), out.nplane());
+          checkTranspose(in, out);
+          // transpose back should give the original cube
+          casacore::Cube<casacore::Complex> back;
+          CubeTransposer::transpose(out, back);
+          CPPUNIT_ASSERT(back.shape() == in.shape());
+          checkTranspose(out, back);
+     }
+  }
+
+  void noiseTransposeTest() {
+     casacore::Cube<casacore::Float> in(4, 5, 40);
+     indgen(in);
+     casacore::Cube<casacore::Complex> out;
+     CubeTransposer::transpose(in, out);
+     for (casacore::uInt row = 0; row < out.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < out.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < out.nplane(); ++pol) {
+                    const casacore::Float val = in(pol,chan,row);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(double(val), double(out(row,chan,pol).real()), 1e-6);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(double(val), double(out(row,chan,pol).imag()), 1e-6);
+               }
+          }
+     }
+  }
+
+  void flagTransposeTest() {
+     casacore::Cube<casacore::Bool> in(2, 65, 33);
+     for (casacore::uInt pol = 0; pol < in.nrow(); ++pol) {
+          for (casacore::uInt chan = 0; chan < in.ncolumn(); ++chan) {
+               for (casacore::uInt row = 0; row < in.nplane(); ++row) {
+                    in(pol,chan,row) = ((pol + chan + row) % 3 == 0);
+               }
+          }
+     }
+     casacore::Cube<casacore::Bool> out;
+     CubeTransposer::transpose(in, out);
+     checkTranspose(in, out);
+     // non-contiguous input should work too
+     casacore::Cube<casacore::Bool> out2;
+     const casacore::Cube<casacore::Bool> section = in(casacore::IPosition(3,0,1,2), casacore::IPosition(3,1,10,20));
+     CubeTransposer::transpose(section, out2);
+     checkTranspose(section, out2);
+  }
+
+  void broadcastTest() {
+     casacore::Matrix<casacore::Float> in(4, 10);
+     indgen(in);
+     casacore::Cube<casacore::Complex> out(10, 7, 4);
+     CubeTransposer::broadcast(in, out);
+     for (casacore::uInt row = 0; row < out.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < out.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < out.nplane(); ++pol) {
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(double(in(pol,row)), double(out(row,chan,pol).real()), 1e-6);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(double(in(pol,row)), double(out(row,chan,pol).imag()), 1e-6);
+               }
+          }
+     }
+     // no channels, nothing should be done
+     casacore::Cube<casacore::Complex> empty(10, 0, 4);
+     CubeTransposer::broadcast(in, empty);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), empty.nelements());
+  }
+
+  void rowTransposeTest() {
+     // cover all specialisations for the number of polarisations
+     const casacore::uInt pols[] = {1, 2, 3, 4};
+     for (size_t i = 0; i < 4; ++i) {
+          casacore::Cube<casacore::Complex> in(pols[i], 13, 5);
+          for (casacore::uInt pol = 0; pol < in.nrow(); ++pol) {
+               for (casacore::uInt chan = 0; chan < in.ncolumn(); ++chan) {
+                    for (casacore::uInt row = 0; row < in.nplane(); ++row) {
+                         in(pol,chan,row) = casacore::Complex(pol + 10. * chan, row);
+                    }
+               }
+          }
+          casacore::Cube<casacore::Complex> out(in.nplane(), in.ncolumn(), in.nrow());
+          for (casacore::uInt row = 0; row < in.nplane(); ++row) {
+               const casacore::Matrix<casacore::Complex> rowIn = in.xyPlane(row).copy();
+               CubeTransposer::transposeRow(rowIn, out, row);
+          }
+          checkTranspose(in, out);
+     }
+     // float to complex conversion and non-contiguous output
+     casacore::Matrix<casacore::Float> sigma(2, 6);
+     indgen(sigma);
+     casacore::Cube<casacore::Complex> big(4, 8, 2, casacore::Complex(-1.,-1.));
+     casacore::Cube<casacore::Complex> section = big(casacore::IPosition(3,1,1,0), casacore::IPosition(3,2,6,1));
+     CubeTransposer::transposeRow(sigma, section, 1);
+     for (casacore::uInt chan = 0; chan < sigma.ncolumn(); ++chan) {
+          for (casacore::uInt pol = 0; pol < sigma.nrow(); ++pol) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(double(sigma(pol,chan)), double(big(2,chan + 1,pol).real()), 1e-6);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(double(sigma(pol,chan)), double(big(2,chan + 1,pol).imag()), 1e-6);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(-1., double(big(1,chan + 1,pol).real()), 1e-6);
+          }
+     }
+  }
+
+protected:
+  /// @brief check that the second cube is the first one with the first and last axes swapped
+  template<typename T>
+  static void checkTranspose(const casacore::Cube<T> &in, const casacore::Cube<T> &out) {
+     for (casacore::uInt x = 0; x < in.nrow(); ++x) {
+          for (casacore::uInt y = 0; y < in.ncolumn(); ++y) {
+               for (casacore::uInt z = 0; z < in.nplane(); ++z) {
+                    CPPUNIT_ASSERT(in(x,y,z) == out(z,y,x));
+               }
+          }
+     }
+  }
+}; // class CubeTransposerTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef CUBE_TRANSPOSER_TEST_H
@@ -0,0 +1,99 @@
+/// @file
+/// @brief Tests of the factory building data sources from a parset
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef DATA_ACCESS_FACTORY_TEST_H
+#define DATA_ACCESS_FACTORY_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/DataAccessFactory.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+class DataAccessFactoryTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(DataAccessFactoryTest);
+  CPPUNIT_TEST(testReadOnly);
+  CPPUNIT_TEST(testConfigure);
+  CPPUNIT_TEST_EXCEPTION(testUnknownBuffers,AskapError);
+  CPPUNIT_TEST_EXCEPTION(testUnknownCompactFormat,AskapError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testReadOnly() {
+     LOFAR::ParameterSet parset;
+     parset.add("dataset", TableTestRunner::msName());
+     parset.add("dataaccess.locking", "none");
+     const boost::shared_ptr<TableConstDataSource> ds = DataAccessFactory::roDataSource(parset);
+     CPPUNIT_ASSERT(ds);
+     size_t nRows = 0;
+     for (IConstDataSharedIter it = ds->createConstIterator(); it != it.end(); ++it) {
+          nRows += it->nRow();
+     }
+     CPPUNIT_ASSERT(nRows > 0);
+  }
+
+  void testConfigure() {
+     LOFAR::ParameterSet parset;
+     parset.add("dataaccess.maxchunkrows", "10");
+     parset.add("dataaccess.statistics", "true");
+     TableConstDataSource ds(TableTestRunner::msName());
+     DataAccessFactory::configure(ds, parset);
+     CPPUNIT_ASSERT(ds.statistics());
+     for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+          CPPUNIT_ASSERT(it->nRow() <= 10);
+     }
+  }
+
+  void testUnknownBuffers() {
+     LOFAR::ParameterSet parset;
+     parset.add("dataset", TableTestRunner::msName());
+     parset.add("dataaccess.buffers", "somewhere");
+     // this should generate an exception
+     DataAccessFactory::rwDataSource(parset);
+  }
+
+  void testUnknownCompactFormat() {
+     LOFAR::ParameterSet parset;
+     parset.add("dataaccess.compactvisibility", "int4");
+     TableConstDataSource ds(TableTestRunner::msName());
+     // this should generate an exception
+     DataAccessFactory::configure(ds, parset);
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef DATA_ACCESS_FACTORY_TEST_H
@@ -30,6 +30,9 @@
 
 // cppunit includes
 #include <cppunit/extensions/HelperMacros.h>
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicSL/Constants.h>
 // own includes
 #include <askap/dataaccess/OnDemandBufferDataAccessor.h>
 #include <askap/dataaccess/OnDemandNoiseAndFlagDA.h>
@@ -37,6 +40,9 @@
 #include <askap/dataaccess/DataAccessorAdapter.h>
 #include <askap/dataaccess/TableDataSource.h>
 #include <askap/dataaccess/BestWPlaneDataAccessor.h>
+#include <askap/dataaccess/PolConvertingAccessor.h>
+#include <askap/dataaccess/PhaseRotatingAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
 #include "TableTestRunner.h"
 
 namespace askap {
@@ -56,6 +62,17 @@ class DataAccessorAdapterTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_EXCEPTION(nonCoplanarTest, AskapError);
   CPPUNIT_TEST(noiseAdapterTest);
   CPPUNIT_TEST(flagAdapterTest);
+  CPPUNIT_TEST(weightAdapterTest);
+  CPPUNIT_TEST(uninitialisedBufferTest);
+  CPPUNIT_TEST(polConversionTest);
+  CPPUNIT_TEST(polConversionPartialTest);
+  CPPUNIT_TEST(polConversionMatrixTest);
+  CPPUNIT_TEST_EXCEPTION(polConversionMissingTest, DataAccessError);
+  CPPUNIT_TEST(polParseTest);
+  CPPUNIT_TEST_EXCEPTION(polParseInvalidTest, DataAccessError);
+  CPPUNIT_TEST(phaseRotationTest);
+  CPPUNIT_TEST(phaseRotationKernelTest);
+  CPPUNIT_TEST_EXCEPTION(phaseRotationReadOnlyTest, DataAccessLogicError);
   CPPUNIT_TEST_SUITE_END();
 public:
   void onDemandBufferDATest() {
@@ -104,6 +121,250 @@ public:
       checkAllCube(acc2.noise(),2.);                  
   }
   
+  void weightAdapterTest() {
+      DataAccessorStub acc(true);
+      OnDemandNoiseAndFlagDA acc2(acc);
+      const casacore::Cube<casacore::Float> &weight = acc2.weight();
+      CPPUNIT_ASSERT(weight.shape() == acc.noise().shape());
+      CPPUNIT_ASSERT(casacore::allNear(weight, casacore::Float(1.), 1e-7));
+      // weights follow the substituted noise and flags
+      acc2.rwNoise().set(2.);
+      CPPUNIT_ASSERT(casacore::allNear(acc2.weight(), casacore::Float(0.25), 1e-7));
+      acc2.rwFlag()(1, 2, 0) = casacore::True;
+      acc2.rwNoise()(0, 1, 0) = 0.;
+      const casacore::Cube<casacore::Float> &weight2 = acc2.weight();
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., weight2(1, 2, 0), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., weight2(0, 1, 0), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, weight2(0, 2, 0), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, weight2(1, 1, 0), 1e-7);
+  }
+
+  void uninitialisedBufferTest() {
+      DataAccessorStub acc(true);
+      OnDemandBufferDataAccessor acc2(acc);
+      CPPUNIT_ASSERT(!acc2.isDecoupled());
+      acc2.useVisibilityBuffer();
+      CPPUNIT_ASSERT(acc2.isDecoupled());
+      CPPUNIT_ASSERT(acc2.visibility().shape() == acc.visibility().shape());
+      acc2.rwVisibility().set(3.);
+      checkAllCube(acc2.visibility(),3.);
+      checkAllCube(acc.visibility(),0.);
+      
+      OnDemandNoiseAndFlagDA acc3(acc);
+      acc3.useNoiseBuffer();
+      acc3.useFlagBuffer();
+      CPPUNIT_ASSERT(acc3.noise().shape() == acc.noise().shape());
+      CPPUNIT_ASSERT(acc3.flag().shape() == acc.flag().shape());
+      acc3.rwNoise().set(2.);
+      acc3.rwFlag().set(casacore::True);
+      checkAllCube(acc3.noise(),2.);
+      checkAllBoolCube(acc3.flag(), true);
+      checkAllCube(acc.noise(),1.);
+      checkAllBoolCube(acc.flag(), false);
+  }
+  
+  void polConversionTest() {
+      DataAccessorStub acc(true);
+      setLinearPols(acc);
+      // flag one input sample of XY
+      acc.itsFlag(1, 2, 1) = true;
+      PolConvertingAccessor acc2("I,Q,U,V");
+      acc2.associate(acc);
+      CPPUNIT_ASSERT_EQUAL(4u, acc2.nPol());
+      CPPUNIT_ASSERT_EQUAL(acc.nRow(), acc2.nRow());
+      CPPUNIT_ASSERT_EQUAL(acc.nChannel(), acc2.nChannel());
+      CPPUNIT_ASSERT(acc2.stokes()[3] == casacore::Stokes::V);
+      const casacore::Cube<casacore::Complex> &vis = acc2.visibility();
+      const casacore::Cube<casacore::Complex> &noise = acc2.noise();
+      const casacore::Cube<casacore::Bool> &flag = acc2.flag();
+      const float expected[4] = {2., 1., 0.5, 0.25};
+      for (casacore::uInt row = 0; row < acc2.nRow(); ++row) {
+           for (casacore::uInt chan = 0; chan < acc2.nChannel(); ++chan) {
+                for (casacore::uInt pol = 0; pol < 4; ++pol) {
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(vis(row, chan, pol) - expected[pol]), 1e-6);
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(sqrt(0.5), real(noise(row, chan, pol)), 1e-6);
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(sqrt(0.5), imag(noise(row, chan, pol)), 1e-6);
+                     // only U and V depend on XY
+                     const bool flagExpected = (row == 1) && (chan == 2) && (pol >= 2);
+                     CPPUNIT_ASSERT_EQUAL(flagExpected, bool(flag(row, chan, pol)));
+                }
+           }
+      }
+      // the products are cached until the adapter is associated again
+      acc.itsVisibility.set(0.);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2., real(acc2.visibility()(0, 0, 0)), 1e-6);
+      acc2.associate(acc);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(acc2.visibility()(0, 0, 0)), 1e-6);
+  }
+
+  void polConversionPartialTest() {
+      DataAccessorStub acc(true);
+      setLinearPols(acc);
+      acc.itsStokes[1] = casacore::Stokes::YY;
+      acc.itsStokes.resize(2, true);
+      acc.itsVisibility.resize(acc.nRow(), acc.nChannel(), 2);
+      acc.itsVisibility.xyPlane(0).set(casacore::Complex(3., 0.));
+      acc.itsVisibility.xyPlane(1).set(casacore::Complex(1., 0.));
+      PolConvertingAccessor acc2("I");
+      acc2.associate(acc);
+      CPPUNIT_ASSERT_EQUAL(1u, acc2.nPol());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(acc2.visibility()(0, 0, 0) - casacore::Complex(2., 0.)), 1e-6);
+  }
+
+  void polConversionMatrixTest() {
+      // circular products to stokes and back should give the identity
+      const casacore::Vector<casacore::Stokes::StokesTypes> circ = PolConvertingAccessor::parse("RR, RL, LR, LL");
+      const casacore::Vector<casacore::Stokes::StokesTypes> stokes = PolConvertingAccessor::parse("I,Q,U,V");
+      const casacore::Matrix<casacore::Complex> toStokes = PolConvertingAccessor::conversionMatrix(circ, stokes);
+      const casacore::Matrix<casacore::Complex> toCirc = PolConvertingAccessor::conversionMatrix(stokes, circ);
+      for (casacore::uInt i = 0; i < 4; ++i) {
+           for (casacore::uInt j = 0; j < 4; ++j) {
+                casacore::Complex sum(0.);
+                for (casacore::uInt k = 0; k < 4; ++k) {
+                     sum += toCirc(i, k) * toStokes(k, j);
+                }
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(i == j ? 1. : 0., real(sum), 1e-6);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(0., imag(sum), 1e-6);
+           }
+      }
+  }
+
+  void polConversionMissingTest() {
+      const casacore::Vector<casacore::Stokes::StokesTypes> in = PolConvertingAccessor::parse("XX,YY");
+      // U can't be obtained from XX and YY, this should generate an exception
+      PolConvertingAccessor::conversionMatrix(in, PolConvertingAccessor::parse("U"));
+  }
+
+  void polParseTest() {
+      // the compact form should give the same products as the comma-separated list
+      const char* lists[] = {"I,Q,U,V", "XX,YY", "RR,LL", "XX,XY,YX,YY"};
+      const char* compact[] = {"IQUV", "XXYY", "RRLL", "XXXYYXYY"};
+      for (size_t test = 0; test < 4; ++test) {
+           const casacore::Vector<casacore::Stokes::StokesTypes> expected = PolConvertingAccessor::parse(lists[test]);
+           const casacore::Vector<casacore::Stokes::StokesTypes> result = PolConvertingAccessor::parse(compact[test]);
+           CPPUNIT_ASSERT_EQUAL(expected.nelements(), result.nelements());
+           for (casacore::uInt pol = 0; pol < result.nelements(); ++pol) {
+                CPPUNIT_ASSERT(expected[pol] == result[pol]);
+           }
+      }
+      const casacore::Vector<casacore::Stokes::StokesTypes> stokes = PolConvertingAccessor::parse("IQUV");
+      CPPUNIT_ASSERT_EQUAL(size_t(4), stokes.nelements());
+      CPPUNIT_ASSERT(stokes[0] == casacore::Stokes::I);
+      CPPUNIT_ASSERT(stokes[3] == casacore::Stokes::V);
+      // single products are not split
+      const casacore::Vector<casacore::Stokes::StokesTypes> single = PolConvertingAccessor::parse("XX");
+      CPPUNIT_ASSERT_EQUAL(size_t(1), single.nelements());
+      CPPUNIT_ASSERT(single[0] == casacore::Stokes::XX);
+  }
+
+  void polParseInvalidTest() {
+      // Z is not a polarisation product, this should generate an exception
+      PolConvertingAccessor::parse("IQZ");
+  }
+
+  void phaseRotationTest() {
+      DataAccessorStub acc(true);
+      for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+           acc.itsUVWRotationDelay[row] = 0.37 + 11.3 * row;
+           for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+                acc.itsVisibility(row, chan, 0) = casacore::Complex(1. + 0.1 * chan, -0.5 + 0.2 * row);
+           }
+      }
+      const casacore::MDirection tangent(acc.dishPointing1()[0], casacore::MDirection::J2000);
+      PhaseRotatingAccessor acc2(tangent);
+      acc2.associate(acc);
+      CPPUNIT_ASSERT_EQUAL(1u, acc2.numberOfThreads());
+      const casacore::Cube<casacore::Complex> &vis = acc2.visibility();
+      CPPUNIT_ASSERT(vis.shape() == acc.visibility().shape());
+      checkRotation(acc.visibility(), acc.itsUVWRotationDelay, acc.frequency(), vis);
+      CPPUNIT_ASSERT(acc2.uvw().nelements() == acc.nRow());
+      // results should follow the change of the underlying accessor
+      acc.itsUVWRotationDelay = 0.;
+      acc.itsVisibility.set(casacore::Complex(0.5, 0.25));
+      acc2.associate(acc);
+      CPPUNIT_ASSERT(casacore::allNear(acc2.visibility(), casacore::Complex(0.5, 0.25), 1e-7));
+  }
+
+  void phaseRotationKernelTest() {
+      const casacore::uInt nRow = 300;
+      const casacore::uInt nChan = 100;
+      casacore::Cube<casacore::Complex> in(nRow, nChan, 2);
+      casacore::Vector<casacore::Double> delays(nRow);
+      casacore::Vector<casacore::Double> freq(nChan);
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           delays[row] = -700. + 4.9 * row;
+           for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                in(row, chan, 0) = casacore::Complex(0.01 * row, 1. - 0.01 * chan);
+                in(row, chan, 1) = casacore::Complex(-0.5, 0.02 * chan);
+           }
+      }
+      // equally spaced channels, the phasor is advanced from channel to channel
+      for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+           freq[chan] = 1.1e9 + 1e6 * chan;
+      }
+      casacore::Cube<casacore::Complex> out;
+      PhaseRotatingAccessor::rotate(in, delays, freq, out);
+      checkRotation(in, delays, freq, out);
+      casacore::Cube<casacore::Complex> outParallel;
+      PhaseRotatingAccessor::rotate(in, delays, freq, outParallel, 4);
+      CPPUNIT_ASSERT(casacore::allEQ(out, outParallel));
+      // irregular spacing, the phasor is evaluated for every channel
+      freq[nChan / 2] += 3e5;
+      PhaseRotatingAccessor::rotate(in, delays, freq, out, 3);
+      checkRotation(in, delays, freq, out);
+  }
+
+  void phaseRotationReadOnlyTest() {
+      DataAccessorStub acc(true);
+      PhaseRotatingAccessor acc2(casacore::MDirection(acc.dishPointing1()[0], casacore::MDirection::J2000));
+      acc2.associate(acc);
+      // this should throw DataAccessLogicError
+      acc2.rwVisibility();
+  }
+
+  /// @brief check the result of phase rotation against direct calculation
+  /// @param[in] in input visibilities
+  /// @param[in] delays delays in metres
+  /// @param[in] freq frequencies in Hz
+  /// @param[in] out rotated visibilities
+  static void checkRotation(const casacore::Cube<casacore::Complex> &in, 
+                            const casacore::Vector<casacore::Double> &delays,
+                            const casacore::Vector<casacore::Double> &freq,
+                            const casacore::Cube<casacore::Complex> &out) {
+      CPPUNIT_ASSERT(in.shape() == out.shape());
+      for (casacore::uInt row = 0; row < in.nrow(); ++row) {
+           for (casacore::uInt chan = 0; chan < in.ncolumn(); ++chan) {
+                const casacore::Double phase = 2. * casacore::C::pi * delays[row] * freq[chan] / casacore::C::c;
+                const casacore::Complex phasor(cos(phase), sin(phase));
+                for (casacore::uInt pol = 0; pol < in.nplane(); ++pol) {
+                     const casacore::Complex expected = in(row, chan, pol) * phasor;
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(casacore::real(expected), casacore::real(out(row, chan, pol)), 1e-5);
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(casacore::imag(expected), casacore::imag(out(row, chan, pol)), 1e-5);
+                }
+           }
+      }
+  }
+
+  /// @brief set up the stub with linear products
+  /// @details XX=3, XY=0.5+0.25i, YX=0.5-0.25i, YY=1, i.e. I=2, Q=1, U=0.5, V=0.25
+  /// @param[in] acc stub to set up
+  static void setLinearPols(DataAccessorStub &acc) {
+      acc.itsStokes.resize(4);
+      acc.itsStokes[0] = casacore::Stokes::XX;
+      acc.itsStokes[1] = casacore::Stokes::XY;
+      acc.itsStokes[2] = casacore::Stokes::YX;
+      acc.itsStokes[3] = casacore::Stokes::YY;
+      acc.itsVisibility.resize(acc.nRow(), acc.nChannel(), 4);
+      acc.itsVisibility.xyPlane(0).set(casacore::Complex(3., 0.));
+      acc.itsVisibility.xyPlane(1).set(casacore::Complex(0.5, 0.25));
+      acc.itsVisibility.xyPlane(2).set(casacore::Complex(0.5, -0.25));
+      acc.itsVisibility.xyPlane(3).set(casacore::Complex(1., 0.));
+      acc.itsNoise.resize(acc.nRow(), acc.nChannel(), 4);
+      acc.itsNoise.set(casacore::Complex(1., 1.));
+      acc.itsFlag.resize(acc.nRow(), acc.nChannel(), 4);
+      acc.itsFlag.set(false);
+  }
+
   void daAdapterTest() {
       DataAccessorStub acc(true);
       checkAllCube(acc.visibility(),0.);      
@@ -63,12 +63,14 @@ class DataConverterTest : public CppUnit::TestFixture {
    CPPUNIT_TEST(testDirectionConversion);
    CPPUNIT_TEST_EXCEPTION(testMissingFrame,std::exception);
    CPPUNIT_TEST(testFrequencyConversion);
+   CPPUNIT_TEST(testFrequencyAxisConversion);
    CPPUNIT_TEST(testVelocityConversion);
    CPPUNIT_TEST_EXCEPTION(testMissingRestFrequency1,std::exception);
    CPPUNIT_TEST_EXCEPTION(testMissingRestFrequency2,std::exception);
    CPPUNIT_TEST(testVelToFreq);
    CPPUNIT_TEST(testFreqToVel);
    CPPUNIT_TEST(testEpochToMeasures);
+   CPPUNIT_TEST(testBatchConversion);
    CPPUNIT_TEST_SUITE_END();
 public:
    void setUp()
@@ -168,6 +170,28 @@ public:
      CPPUNIT_ASSERT(fabs(itsConverter->frequency(topoFreq)-1.42)<1e-5);
    }
 
+   /// test conversion of the whole spectral axis at once
+   void testFrequencyAxisConversion()
+   {
+     itsConverter->setFrequencyFrame(casacore::MFrequency::Ref(
+                      casacore::MFrequency::LSRK),"GHz");
+     const casacore::MeasFrame someFrame=getSomeFrame();
+     itsConverter->setMeasFrame(someFrame);
+     const casacore::MFrequency::Ref topoRef(casacore::MFrequency::TOPO, someFrame);
+     casacore::Vector<casacore::Double> freqs(1000);
+     for (casacore::uInt ch = 0; ch < freqs.nelements(); ++ch) {
+          freqs[ch] = 700. + 0.0185 * ch;
+     }
+     casacore::Vector<casacore::Double> converted;
+     itsConverter->frequencies(topoRef, "MHz", freqs, converted);
+     CPPUNIT_ASSERT_EQUAL(freqs.nelements(), converted.nelements());
+     for (casacore::uInt ch = 0; ch < freqs.nelements(); ch += 111) {
+          const casacore::MFrequency topoFreq(casacore::MVFrequency(casacore::Quantity(freqs[ch],"MHz")), 
+                                          topoRef);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(itsConverter->frequency(topoFreq), converted[ch], 1e-10);
+     }
+   }
+
    /// test Velocity conversion
    void testVelocityConversion()
    {
@@ -262,6 +286,55 @@ public:
      CPPUNIT_ASSERT(fabs(itsConverter->epoch(
               itsConverter->epochMeasure(asMVEpoch))-1.)<1e-7);     
    }
+
+   /// test that batch conversions give the same result as the individual ones
+   void testBatchConversion() {
+     casacore::MEpoch refEpoch=casacore::MEpoch(casacore::MVEpoch(casacore::Quantity(50257.29,"d")),
+                            casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+     itsConverter->setEpochFrame(refEpoch,"s");
+     casacore::Vector<casacore::Double> times(3);
+     times[0] = 50257.29;
+     times[1] = 50258.29;
+     times[2] = 50258.79;
+     casacore::Vector<casacore::Double> result;
+     // same frame, no conversion is required
+     itsConverter->epochs(casacore::MEpoch::Ref(casacore::MEpoch::UTC), "d", times, result);
+     CPPUNIT_ASSERT_EQUAL(times.nelements(), result.nelements());
+     for (casacore::uInt i = 0; i < times.nelements(); ++i) {
+          const casacore::MEpoch epoch(casacore::MVEpoch(casacore::Quantity(times[i],"d")),
+                            casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(itsConverter->epoch(epoch), result[i], 1e-7);
+     }
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(86400., result[1], 1e-7);
+     // different frame
+     itsConverter->epochs(casacore::MEpoch::Ref(casacore::MEpoch::TAI), "d", times, result);
+     CPPUNIT_ASSERT_EQUAL(times.nelements(), result.nelements());
+     for (casacore::uInt i = 0; i < times.nelements(); ++i) {
+          const casacore::MEpoch epoch(casacore::MVEpoch(casacore::Quantity(times[i],"d")),
+                            casacore::MEpoch::Ref(casacore::MEpoch::TAI));
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(itsConverter->epoch(epoch), result[i], 1e-7);
+     }
+
+     casacore::Vector<casacore::MVDirection> dirs(3);
+     dirs[0] = casacore::MVDirection(casacore::Quantity(30.,"deg"), casacore::Quantity(-50.,"deg"));
+     dirs[1] = casacore::MVDirection(casacore::Quantity(31.,"deg"), casacore::Quantity(-49.,"deg"));
+     dirs[2] = casacore::MVDirection(casacore::Quantity(29.,"deg"), casacore::Quantity(-51.,"deg"));
+     itsConverter->setDirectionFrame(casacore::MDirection::Ref(casacore::MDirection::J2000));
+     casacore::Vector<casacore::MVDirection> convertedDirs;
+     itsConverter->directions(casacore::MDirection::Ref(casacore::MDirection::J2000), dirs, convertedDirs);
+     CPPUNIT_ASSERT_EQUAL(dirs.nelements(), convertedDirs.nelements());
+     for (casacore::uInt i = 0; i < dirs.nelements(); ++i) {
+          CPPUNIT_ASSERT(convertedDirs[i].separation(dirs[i])<1e-9);
+     }
+     itsConverter->directions(casacore::MDirection::Ref(casacore::MDirection::GALACTIC), dirs, convertedDirs);
+     CPPUNIT_ASSERT_EQUAL(dirs.nelements(), convertedDirs.nelements());
+     for (casacore::uInt i = 0; i < dirs.nelements(); ++i) {
+          casacore::MVDirection single;
+          itsConverter->direction(casacore::MDirection(dirs[i], casacore::MDirection::GALACTIC), single);
+          CPPUNIT_ASSERT(convertedDirs[i].separation(single)<1e-9);
+          CPPUNIT_ASSERT(convertedDirs[i].separation(dirs[i])>1e-3);
+     }
+   }
    
    
 protected:
@@ -0,0 +1,126 @@
+/// @file
+/// @brief Tests of the hardware performance counters
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef HARDWARE_COUNTERS_TEST_H
+#define HARDWARE_COUNTERS_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/dataaccess/HardwareCounters.h>
+#include <askap/dataaccess/AccessTracer.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+class HardwareCountersTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(HardwareCountersTest);
+  CPPUNIT_TEST(disabledTest);
+  CPPUNIT_TEST(accumulationTest);
+  CPPUNIT_TEST(scopeTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void disabledTest() {
+     HardwareCounters &counters = HardwareCounters::instance();
+     counters.enable(false);
+     counters.reset();
+     CPPUNIT_ASSERT(!counters.isEnabled());
+     {
+       const AccessTracer::Scope trace("disabled", "test");
+     }
+     const casacore::uInt64 start[HardwareCounters::N_COUNTERS] = {0, 0, 0};
+     const casacore::uInt64 end[HardwareCounters::N_COUNTERS] = {10, 20, 30};
+     counters.add("disabled", start, end);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), counters.nCalls("disabled"));
+  }
+
+  void accumulationTest() {
+     HardwareCounters &counters = HardwareCounters::instance();
+     counters.enable();
+     counters.reset();
+     const casacore::uInt64 start[HardwareCounters::N_COUNTERS] = {100, 200, 300};
+     const casacore::uInt64 end[HardwareCounters::N_COUNTERS] = {110, 220, 330};
+     counters.add("section", start, end);
+     // the same section in another thread is accounted separately
+     boost::thread thread(boost::bind(&HardwareCounters::add, &counters, std::string("section"), 
+                                      start, end));
+     thread.join();
+     counters.enable(false);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), counters.nCalls("section"));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(20), counters.count("section", HardwareCounters::CYCLES));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(40), counters.count("section", HardwareCounters::INSTRUCTIONS));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(60), counters.count("section", HardwareCounters::LLC_MISSES));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), counters.nCalls("other"));
+     CPPUNIT_ASSERT_EQUAL(2u, counters.nThreads());
+     CPPUNIT_ASSERT_EQUAL(std::string("instructions"), 
+                          HardwareCounters::counterName(HardwareCounters::INSTRUCTIONS));
+     counters.log();
+     counters.reset();
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), counters.nCalls("section"));
+  }
+
+  void scopeTest() {
+     HardwareCounters &counters = HardwareCounters::instance();
+     counters.enable();
+     counters.reset();
+     casacore::uInt64 values[HardwareCounters::N_COUNTERS];
+     // perf_event may be unavailable or forbidden on the test machine
+     const bool available = counters.read(values);
+     double sum = 0.;
+     {
+       const AccessTracer::Scope trace("fillCube", std::string("DATA"), "test");
+       for (int i = 0; i < 100000; ++i) {
+            sum += 1. / (1. + i);
+       }
+     }
+     counters.enable(false);
+     CPPUNIT_ASSERT(sum > 0.);
+     if (available) {
+         CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), counters.nCalls("fillCube DATA"));
+         CPPUNIT_ASSERT(counters.count("fillCube DATA", HardwareCounters::INSTRUCTIONS) > 0);
+     } else {
+         CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), counters.nCalls("fillCube DATA"));
+     }
+     counters.reset();
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef HARDWARE_COUNTERS_TEST_H
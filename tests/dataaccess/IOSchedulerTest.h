@@ -0,0 +1,191 @@
+/// @file
+/// @brief Tests of the pool of I/O threads shared by background reads and writes
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef IO_SCHEDULER_TEST_H
+#define IO_SCHEDULER_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/dataaccess/IOScheduler.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <algorithm>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief jobs used in the tests
+struct TestIOJobs {
+  TestIOJobs() : itsNRunning(0), itsMaxRunning(0) {}
+
+  /// @brief record the job in the order of execution
+  void record(int id) {
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     itsOrder.push_back(id);
+  }
+
+  /// @brief keep the thread busy until the gate opens
+  void hold(boost::shared_future<void> gate) { gate.wait(); }
+
+  /// @brief record the job and count how many such jobs run at the same time
+  void serial(int id) {
+     {
+       boost::lock_guard<boost::mutex> lock(itsMutex);
+       itsMaxRunning = std::max(itsMaxRunning, ++itsNRunning);
+     }
+     boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+     record(id);
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     --itsNRunning;
+  }
+
+  /// @brief job which fails
+  void fail() { ASKAPTHROW(AskapError, "test failure"); }
+
+  boost::mutex itsMutex;
+  std::vector<int> itsOrder;
+  int itsNRunning;
+  int itsMaxRunning;
+};
+
+class IOSchedulerTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(IOSchedulerTest);
+  CPPUNIT_TEST(priorityTest);
+  CPPUNIT_TEST(channelTest);
+  CPPUNIT_TEST(errorTest);
+  CPPUNIT_TEST(statisticsTest);
+  CPPUNIT_TEST(bandwidthTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void priorityTest() {
+     TestIOJobs jobs;
+     IOScheduler scheduler(1);
+     boost::promise<void> gate;
+     scheduler.submit(IOScheduler::CRITICAL, boost::bind(&TestIOJobs::hold, &jobs,
+                      boost::shared_future<void>(gate.get_future())));
+     scheduler.submit(IOScheduler::BULK, boost::bind(&TestIOJobs::record, &jobs, 1));
+     scheduler.submit(IOScheduler::NORMAL, boost::bind(&TestIOJobs::record, &jobs, 2));
+     scheduler.submit(IOScheduler::CRITICAL, boost::bind(&TestIOJobs::record, &jobs, 3));
+     gate.set_value();
+     scheduler.wait();
+     // the only thread takes the jobs in the order of priority
+     CPPUNIT_ASSERT_EQUAL(size_t(3), jobs.itsOrder.size());
+     CPPUNIT_ASSERT_EQUAL(3, jobs.itsOrder[0]);
+     CPPUNIT_ASSERT_EQUAL(2, jobs.itsOrder[1]);
+     CPPUNIT_ASSERT_EQUAL(1, jobs.itsOrder[2]);
+  }
+
+  void channelTest() {
+     TestIOJobs jobs;
+     IOScheduler scheduler(4);
+     const IOScheduler::Channel chan = scheduler.channel(IOScheduler::NORMAL);
+     IOScheduler::Future last;
+     for (int id = 0; id < 20; ++id) {
+          last = scheduler.submit(chan, boost::bind(&TestIOJobs::serial, &jobs, id));
+     }
+     last.wait();
+     // jobs of the channel are done one at a time in order
+     CPPUNIT_ASSERT_EQUAL(size_t(20), jobs.itsOrder.size());
+     for (int id = 0; id < 20; ++id) {
+          CPPUNIT_ASSERT_EQUAL(id, jobs.itsOrder[id]);
+     }
+     CPPUNIT_ASSERT_EQUAL(1, jobs.itsMaxRunning);
+  }
+
+  void errorTest() {
+     TestIOJobs jobs;
+     IOScheduler scheduler(2);
+     IOScheduler::Future failed = scheduler.submit(IOScheduler::BULK, boost::bind(&TestIOJobs::fail, &jobs));
+     failed.wait();
+     CPPUNIT_ASSERT(failed.has_exception());
+     CPPUNIT_ASSERT_THROW(failed.get(), AskapError);
+     // the threads carry on after a failure
+     IOScheduler::Future next = scheduler.submit(IOScheduler::BULK, boost::bind(&TestIOJobs::record, &jobs, 1));
+     next.wait();
+     CPPUNIT_ASSERT(!next.has_exception());
+     CPPUNIT_ASSERT_EQUAL(size_t(1), jobs.itsOrder.size());
+  }
+
+  void statisticsTest() {
+     TestIOJobs jobs;
+     IOScheduler scheduler(1);
+     boost::promise<void> gate;
+     scheduler.submit(IOScheduler::CRITICAL, boost::bind(&TestIOJobs::hold, &jobs,
+                      boost::shared_future<void>(gate.get_future())));
+     for (int id = 0; id < 5; ++id) {
+          scheduler.submit(IOScheduler::BULK, boost::bind(&TestIOJobs::record, &jobs, id), 1000);
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(5), scheduler.statistics(IOScheduler::BULK).itsQueued);
+     gate.set_value();
+     scheduler.wait();
+     const IOScheduler::Statistics stats = scheduler.statistics(IOScheduler::BULK);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), stats.itsQueued);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), stats.itsRunning);
+     CPPUNIT_ASSERT_EQUAL(size_t(5), stats.itsMaxQueued);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(5), stats.itsNDone);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(5000), stats.itsBytes);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), scheduler.statistics(IOScheduler::CRITICAL).itsNDone);
+     scheduler.logStatistics();
+     scheduler.resetStatistics();
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), scheduler.statistics(IOScheduler::BULK).itsNDone);
+  }
+
+  void bandwidthTest() {
+     TestIOJobs jobs;
+     IOScheduler scheduler(2);
+     // 100 kB/s, each job delays the next one of the same class by 20 ms
+     scheduler.setBandwidth(IOScheduler::NORMAL, 1e5);
+     CPPUNIT_ASSERT_EQUAL(1e5, scheduler.bandwidth(IOScheduler::NORMAL));
+     const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+     for (int id = 0; id < 4; ++id) {
+          scheduler.submit(IOScheduler::NORMAL, boost::bind(&TestIOJobs::record, &jobs, id), 2000);
+     }
+     scheduler.wait();
+     const boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::universal_time() - start;
+     CPPUNIT_ASSERT_EQUAL(size_t(4), jobs.itsOrder.size());
+     CPPUNIT_ASSERT(elapsed.total_milliseconds() >= 55);
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef IO_SCHEDULER_TEST_H
@@ -0,0 +1,140 @@
+/// @file
+/// @brief Tests of the I/O and cache statistics of iterators
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef ITERATOR_STATISTICS_TEST_H
+#define ITERATOR_STATISTICS_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/dataaccess/IteratorStatistics.h>
+#include <askap/dataaccess/CachedAccessorField.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+class IteratorStatisticsTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(IteratorStatisticsTest);
+  CPPUNIT_TEST(countersTest);
+  CPPUNIT_TEST(timerTest);
+  CPPUNIT_TEST(cachedFieldTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void stringFiller(std::string &str) const {
+       str = "filled";
+  }
+
+  void countersTest() {
+     IteratorStatistics stats;
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.totalBytesRead());
+     stats.addRead("DATA", 100);
+     stats.addRead("DATA", 50);
+     stats.addRead("UVW", 24);
+     stats.addWrite("FLAG", 10);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(150), stats.bytesRead("DATA"));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(24), stats.bytesRead("UVW"));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.bytesRead("FLAG"));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(174), stats.totalBytesRead());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(10), stats.bytesWritten("FLAG"));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(10), stats.totalBytesWritten());
+     stats.addChunk(5);
+     stats.addChunk(7);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nChunks());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(12), stats.nRows());
+     stats.machineHit();
+     stats.machineMiss();
+     stats.machineMiss();
+     stats.machineEviction();
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nMachineHits());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nMachineMisses());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nMachineEvictions());
+     stats.addTime(IteratorStatistics::FILL_UVW, 0.5);
+     stats.addTime(IteratorStatistics::FILL_UVW, 0.25);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0.75, stats.time(IteratorStatistics::FILL_UVW), 1e-9);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nCalls(IteratorStatistics::FILL_UVW));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.nCalls(IteratorStatistics::FILL_CUBE));
+     // the summary should not throw
+     stats.log();
+     stats.reset();
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.totalBytesRead());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.nChunks());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.nMachineMisses());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.nCalls(IteratorStatistics::FILL_UVW));
+  }
+
+  void timerTest() {
+     IteratorStatistics stats;
+     {
+       IteratorStatistics::ScopedTimer timer(&stats, IteratorStatistics::SET_UP_ITERATION);
+     }
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nCalls(IteratorStatistics::SET_UP_ITERATION));
+     CPPUNIT_ASSERT(stats.time(IteratorStatistics::SET_UP_ITERATION) >= 0.);
+     {
+       // disabled timer does nothing
+       IteratorStatistics::ScopedTimer timer(0, IteratorStatistics::SET_UP_ITERATION);
+     }
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nCalls(IteratorStatistics::SET_UP_ITERATION));
+     for (int stage = 0; stage < IteratorStatistics::N_STAGES; ++stage) {
+          CPPUNIT_ASSERT(IteratorStatistics::stageName(IteratorStatistics::Stage(stage)) != "");
+     }
+  }
+
+  void cachedFieldTest() {
+     IteratorStatistics stats;
+     CachedAccessorField<std::string> field;
+     // nothing is counted before the statistics are attached
+     field.value(*this, &IteratorStatisticsTest::stringFiller);
+     field.invalidate();
+     field.setStatistics(&stats);
+     CPPUNIT_ASSERT_EQUAL(std::string("filled"),
+                field.value(*this, &IteratorStatisticsTest::stringFiller));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nCacheFills());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), stats.nCacheHits());
+     field.value(*this, &IteratorStatisticsTest::stringFiller);
+     field.value(*this, &IteratorStatisticsTest::stringFiller);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), stats.nCacheFills());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nCacheHits());
+     field.invalidate();
+     field.value(*this, &IteratorStatisticsTest::stringFiller);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nCacheFills());
+     field.setStatistics(0);
+     field.value(*this, &IteratorStatisticsTest::stringFiller);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2), stats.nCacheHits());
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ITERATOR_STATISTICS_TEST_H
@@ -0,0 +1,191 @@
+/// @file
+/// @brief Tests of the global memory budget of the caches
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef MEMORY_GOVERNOR_TEST_H
+#define MEMORY_GOVERNOR_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <askap/dataaccess/CachedAccessorField.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+
+// std includes
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief cache used in the tests
+struct TestMemoryConsumer : virtual public IMemoryConsumer {
+  /// @param[in] bytes memory held initially
+  /// @param[in] releasable true, if the memory can be released
+  TestMemoryConsumer(size_t bytes, bool releasable) : itsBytes(bytes), itsReleasable(releasable),
+          itsNCalls(0) {}
+
+  virtual size_t memoryUsage() const { return itsBytes; }
+
+  virtual size_t releaseMemory(size_t nBytes) {
+     ++itsNCalls;
+     if (!itsReleasable) {
+         return 0;
+     }
+     const size_t released = std::min(nBytes, itsBytes);
+     itsBytes -= released;
+     return released;
+  }
+
+  size_t itsBytes;
+  bool itsReleasable;
+  size_t itsNCalls;
+};
+
+/// @brief filler of the cached field used in the tests
+struct TestCubeFiller {
+  void operator()(casacore::Cube<casacore::Complex> &cube) const { cube.resize(10, 4, 2); }
+};
+
+class MemoryGovernorTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(MemoryGovernorTest);
+  CPPUNIT_TEST(reportTest);
+  CPPUNIT_TEST(enforceTest);
+  CPPUNIT_TEST(counterTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void reportTest() {
+     MemoryGovernor &governor = MemoryGovernor::instance();
+     const size_t nConsumers = governor.nConsumers();
+     const size_t usage = governor.totalUsage();
+     TestMemoryConsumer first(1000, true);
+     TestMemoryConsumer second(500, false);
+     governor.add(&first, "first", MemoryGovernor::LOW_PRIORITY);
+     governor.add(&second, "second", MemoryGovernor::HIGH_PRIORITY);
+     CPPUNIT_ASSERT_EQUAL(nConsumers + 2, governor.nConsumers());
+     CPPUNIT_ASSERT_EQUAL(usage + 1500, governor.totalUsage());
+     const std::vector<MemoryGovernor::Usage> report = governor.report();
+     CPPUNIT_ASSERT_EQUAL(nConsumers + 2, report.size());
+     // caches are reported in the order of increasing priority
+     for (size_t index = 1; index < report.size(); ++index) {
+          CPPUNIT_ASSERT(report[index - 1].itsPriority <= report[index].itsPriority);
+     }
+     size_t nFound = 0;
+     for (std::vector<MemoryGovernor::Usage>::const_iterator ci = report.begin(); ci != report.end(); ++ci) {
+          if (ci->itsName == "first") {
+              CPPUNIT_ASSERT_EQUAL(size_t(1000), ci->itsBytes);
+              ++nFound;
+          } else if (ci->itsName == "second") {
+              CPPUNIT_ASSERT_EQUAL(size_t(500), ci->itsBytes);
+              ++nFound;
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(2), nFound);
+     governor.logReport();
+     governor.remove(&first);
+     governor.remove(&second);
+     // removing twice is harmless
+     governor.remove(&second);
+     CPPUNIT_ASSERT_EQUAL(nConsumers, governor.nConsumers());
+     CPPUNIT_ASSERT_EQUAL(usage, governor.totalUsage());
+  }
+
+  void enforceTest() {
+     MemoryGovernor &governor = MemoryGovernor::instance();
+     const size_t budget = governor.budget();
+     const size_t usage = governor.totalUsage();
+     TestMemoryConsumer spill(1000, true);
+     TestMemoryConsumer cache(2000, true);
+     TestMemoryConsumer pinned(3000, false);
+     governor.add(&pinned, "pinned", MemoryGovernor::HIGH_PRIORITY);
+     governor.add(&cache, "cache", MemoryGovernor::NORMAL_PRIORITY);
+     governor.add(&spill, "spill", MemoryGovernor::LOW_PRIORITY);
+     // no budget, nothing is released
+     governor.setBudget(0);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), governor.enforce());
+     CPPUNIT_ASSERT_EQUAL(size_t(0), spill.itsNCalls);
+     // the low priority cache is enough
+     governor.setBudget(usage + 5500);
+     CPPUNIT_ASSERT_EQUAL(size_t(500), spill.itsBytes);
+     CPPUNIT_ASSERT_EQUAL(size_t(2000), cache.itsBytes);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), pinned.itsNCalls);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), governor.enforce());
+     // both releasable caches have to give memory
+     governor.setBudget(usage + 4000);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), spill.itsBytes);
+     CPPUNIT_ASSERT_EQUAL(size_t(1000), cache.itsBytes);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), pinned.itsNCalls);
+     // the budget can't be met, the pinned cache is asked last
+     governor.setBudget(usage + 1000);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), cache.itsBytes);
+     CPPUNIT_ASSERT_EQUAL(size_t(1), pinned.itsNCalls);
+     CPPUNIT_ASSERT_EQUAL(size_t(3000), pinned.itsBytes);
+     governor.remove(&spill);
+     governor.remove(&cache);
+     governor.remove(&pinned);
+     governor.setBudget(budget);
+  }
+
+  void counterTest() {
+     MemoryGovernor &governor = MemoryGovernor::instance();
+     const size_t nConsumers = governor.nConsumers();
+     {
+       MemoryGovernor::Counter counter("counter");
+       CPPUNIT_ASSERT_EQUAL(nConsumers + 1, governor.nConsumers());
+       counter.add(300);
+       counter.add(200);
+       counter.subtract(100);
+       CPPUNIT_ASSERT_EQUAL(size_t(400), counter.memoryUsage());
+     }
+     CPPUNIT_ASSERT_EQUAL(nConsumers, governor.nConsumers());
+     // cached fields of the accessors add their buffers to the shared counter
+     const MemoryGovernor::Counter &fields = cachedAccessorFieldMemory();
+     const size_t usage = fields.memoryUsage();
+     {
+       CachedAccessorField<casacore::Cube<casacore::Complex> > field;
+       field.value(TestCubeFiller());
+       CPPUNIT_ASSERT_EQUAL(usage + 80 * sizeof(casacore::Complex), fields.memoryUsage());
+       // the buffer is reused, the size doesn't change
+       field.invalidate();
+       field.value(TestCubeFiller());
+       CPPUNIT_ASSERT_EQUAL(usage + 80 * sizeof(casacore::Complex), fields.memoryUsage());
+     }
+     CPPUNIT_ASSERT_EQUAL(usage, fields.memoryUsage());
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef MEMORY_GOVERNOR_TEST_H
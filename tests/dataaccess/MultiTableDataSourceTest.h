@@ -0,0 +1,145 @@
+/// @file
+/// @brief Tests of the data source presenting a number of measurement sets as one
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef MULTI_TABLE_DATA_SOURCE_TEST_H
+#define MULTI_TABLE_DATA_SOURCE_TEST_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/MultiTableDataSource.h>
+#include <askap/dataaccess/MergedDataIterator.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// std includes
+#include <string>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+class MultiTableDataSourceTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(MultiTableDataSourceTest);
+  CPPUNIT_TEST(testMergedIteration);
+  CPPUNIT_TEST(testSelection);
+  CPPUNIT_TEST(testSequentialOpen);
+  CPPUNIT_TEST_EXCEPTION(testMissingMS, DataAccessError);
+  CPPUNIT_TEST_EXCEPTION(testForeignSelector, DataAccessLogicError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testMergedIteration() {
+     // the same measurement set twice, chunks should come in pairs 
+     const std::vector<std::string> names(2, TableTestRunner::msName());
+     MultiTableDataSource mds(names);
+     CPPUNIT_ASSERT_EQUAL(size_t(2), mds.nSources());
+     IDataConverterPtr conv = mds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     TableConstDataSource ds(TableTestRunner::msName());
+     IConstDataSharedIter refIt = ds.createConstIterator(conv);
+     boost::shared_ptr<IConstDataIterator> it = mds.createConstIterator(conv);
+     const boost::shared_ptr<MergedDataIterator> mergedIt = boost::dynamic_pointer_cast<MergedDataIterator>(it);
+     CPPUNIT_ASSERT(mergedIt);
+     size_t counter = 0;
+     for (; it->hasMore(); refIt.next()) {
+          CPPUNIT_ASSERT(refIt.hasMore());
+          for (size_t index = 0; index < names.size(); ++index, it->next(), ++counter) {
+               CPPUNIT_ASSERT(it->hasMore());
+               CPPUNIT_ASSERT_EQUAL(index, mergedIt->currentIndex());
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->time(), (*it)->time(), 1e-6);
+               CPPUNIT_ASSERT_EQUAL(refIt->nRow(), (*it)->nRow());
+               CPPUNIT_ASSERT_EQUAL(refIt->nChannel(), (*it)->nChannel());
+          }
+     }
+     CPPUNIT_ASSERT(!refIt.hasMore());
+     CPPUNIT_ASSERT_EQUAL(size_t(840), counter);
+     // rewind
+     it->init();
+     CPPUNIT_ASSERT(it->hasMore());
+     CPPUNIT_ASSERT_EQUAL(size_t(0), mergedIt->currentIndex());
+  }
+
+  void testSelection() {
+     const std::vector<std::string> names(3, TableTestRunner::msName());
+     MultiTableDataSource mds(names);
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataSelectorPtr sel = mds.createSelector();
+     sel->chooseCrossCorrelations();
+     IDataSelectorPtr refSel = ds.createSelector();
+     refSel->chooseCrossCorrelations();
+     size_t refRows = 0;
+     for (IConstDataSharedIter refIt = ds.createConstIterator(refSel); refIt != refIt.end(); ++refIt) {
+          refRows += refIt->nRow();
+     }
+     size_t rows = 0;
+     for (boost::shared_ptr<IConstDataIterator> it = mds.createConstIterator(sel); it->hasMore(); it->next()) {
+          for (casacore::uInt row = 0; row < (*it)->nRow(); ++row) {
+               CPPUNIT_ASSERT((*it)->antenna1()[row] != (*it)->antenna2()[row]);
+          }
+          rows += (*it)->nRow();
+     }
+     CPPUNIT_ASSERT_EQUAL(3 * refRows, rows);
+  }
+
+  void testSequentialOpen() {
+     const std::vector<std::string> names(3, TableTestRunner::msName());
+     MultiTableDataSource mds(names, "DATA", 1);
+     CPPUNIT_ASSERT_EQUAL(size_t(3), mds.nSources());
+     size_t counter = 0;
+     for (boost::shared_ptr<IConstDataIterator> it = mds.createConstIterator(); it->hasMore(); it->next()) {
+          ++counter;
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(3 * 420), counter);
+  }
+
+  void testMissingMS() {
+     std::vector<std::string> names(2, TableTestRunner::msName());
+     names.push_back("nonexistent.ms");
+     // this should generate an exception
+     MultiTableDataSource mds(names);
+  }
+
+  void testForeignSelector() {
+     const std::vector<std::string> names(2, TableTestRunner::msName());
+     MultiTableDataSource mds(names);
+     TableConstDataSource ds(TableTestRunner::msName());
+     // this should generate an exception
+     mds.createConstIterator(ds.createSelector());
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef MULTI_TABLE_DATA_SOURCE_TEST_H
@@ -0,0 +1,170 @@
+/// @file
+/// @brief Tests of the bit-packed flag cube
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+/// 
+
+#ifndef PACKED_FLAG_CUBE_TEST_H
+#define PACKED_FLAG_CUBE_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
+
+// own includes
+#include <askap/dataaccess/PackedFlagCube.h>
+
+namespace askap {
+
+namespace accessors {
+
+class PackedFlagCubeTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(PackedFlagCubeTest);
+  CPPUNIT_TEST(packUnpackTest);
+  CPPUNIT_TEST(packNativeTest);
+  CPPUNIT_TEST(rowFlagTest);
+  CPPUNIT_TEST(combineTest);
+  CPPUNIT_TEST(popCountTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  
+  void packUnpackTest() {
+     // 33 channels x 2 polarisations don't fit into a whole number of words
+     casacore::Cube<casacore::Bool> flags(5, 33, 2);
+     fillPattern(flags);
+     PackedFlagCube packed;
+     packed.pack(flags);
+     CPPUNIT_ASSERT_EQUAL(5u, packed.nRow());
+     CPPUNIT_ASSERT_EQUAL(33u, packed.nChannel());
+     CPPUNIT_ASSERT_EQUAL(2u, packed.nPol());
+     CPPUNIT_ASSERT_EQUAL(2u, packed.wordsPerRow());
+     size_t expectedCount = 0;
+     for (casacore::uInt row = 0; row < flags.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < flags.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < flags.nplane(); ++pol) {
+                    CPPUNIT_ASSERT_EQUAL(bool(flags(row,chan,pol)), packed(row,chan,pol));
+                    if (flags(row,chan,pol)) {
+                        ++expectedCount;
+                    }
+               }
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(expectedCount, packed.nFlagged());
+     casacore::Cube<casacore::Bool> unpacked;
+     packed.unpack(unpacked);
+     CPPUNIT_ASSERT(unpacked.shape() == flags.shape());
+     CPPUNIT_ASSERT(allEQ(unpacked, flags));
+  }
+
+  void packNativeTest() {
+     casacore::Cube<casacore::Bool> flags(7, 40, 4);
+     fillPattern(flags);
+     casacore::Cube<casacore::Bool> native(4, 40, 7);
+     for (casacore::uInt row = 0; row < flags.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < flags.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < flags.nplane(); ++pol) {
+                    native(pol,chan,row) = flags(row,chan,pol);
+               }
+          }
+     }
+     PackedFlagCube packed;
+     packed.packNative(native);
+     PackedFlagCube reference;
+     reference.pack(flags);
+     CPPUNIT_ASSERT_EQUAL(reference.nFlagged(), packed.nFlagged());
+     for (casacore::uInt row = 0; row < flags.nrow(); ++row) {
+          CPPUNIT_ASSERT_EQUAL(reference.nFlagged(row), packed.nFlagged(row));
+          for (casacore::uInt chan = 0; chan < flags.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < flags.nplane(); ++pol) {
+                    CPPUNIT_ASSERT_EQUAL(bool(flags(row,chan,pol)), packed(row,chan,pol));
+               }
+          }
+     }
+  }
+
+  void rowFlagTest() {
+     PackedFlagCube packed(3, 33, 2);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), packed.nFlagged());
+     CPPUNIT_ASSERT(!packed.anyFlagged(1));
+     packed.flagRow(1);
+     CPPUNIT_ASSERT(packed.rowFlagged(1));
+     CPPUNIT_ASSERT(!packed.rowFlagged(0));
+     CPPUNIT_ASSERT(!packed.rowFlagged(2));
+     // unused bits of the last word should stay clear
+     CPPUNIT_ASSERT_EQUAL(66u, packed.nFlagged(1));
+     CPPUNIT_ASSERT_EQUAL(size_t(66), packed.nFlagged());
+     packed.set(1, 32, 1, false);
+     CPPUNIT_ASSERT(!packed.rowFlagged(1));
+     CPPUNIT_ASSERT(packed.anyFlagged(1));
+     packed.set(0, 0, 0, true);
+     CPPUNIT_ASSERT(packed.anyFlagged(0));
+     CPPUNIT_ASSERT_EQUAL(1u, packed.nFlagged(0));
+     packed.clear();
+     CPPUNIT_ASSERT_EQUAL(size_t(0), packed.nFlagged());
+  }
+
+  void combineTest() {
+     PackedFlagCube first(2, 10, 2);
+     PackedFlagCube second(2, 10, 2);
+     first.set(0, 1, 0, true);
+     first.set(1, 5, 1, true);
+     second.set(1, 5, 1, true);
+     second.set(1, 9, 0, true);
+     PackedFlagCube orResult(first);
+     orResult.orWith(second);
+     CPPUNIT_ASSERT_EQUAL(size_t(3), orResult.nFlagged());
+     CPPUNIT_ASSERT(orResult(0,1,0) && orResult(1,5,1) && orResult(1,9,0));
+     first.andWith(second);
+     CPPUNIT_ASSERT_EQUAL(size_t(1), first.nFlagged());
+     CPPUNIT_ASSERT(first(1,5,1));
+  }
+
+  void popCountTest() {
+     CPPUNIT_ASSERT_EQUAL(0u, PackedFlagCube::popCount(0));
+     CPPUNIT_ASSERT_EQUAL(64u, PackedFlagCube::popCount(~PackedFlagCube::Word(0)));
+     CPPUNIT_ASSERT_EQUAL(3u, PackedFlagCube::popCount(PackedFlagCube::Word(0x8000000000000101ULL)));
+  }
+
+protected:
+  /// @brief fill the cube with some irregular pattern of flags
+  /// @param[in] flags cube to fill
+  static void fillPattern(casacore::Cube<casacore::Bool> &flags) {
+     for (casacore::uInt row = 0; row < flags.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < flags.ncolumn(); ++chan) {
+               for (casacore::uInt pol = 0; pol < flags.nplane(); ++pol) {
+                    flags(row,chan,pol) = ((row * 7 + chan * 3 + pol) % 5) == 0;
+               }
+          }
+     }
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef PACKED_FLAG_CUBE_TEST_H
@@ -0,0 +1,192 @@
+/// @file
+/// @brief Tests of the storage reused by the accessor fields
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+/// 
+
+#ifndef REUSABLE_BUFFER_TEST_H
+#define REUSABLE_BUFFER_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayMath.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <cstdlib>
+#include <map>
+
+// own includes
+#include <askap/dataaccess/ReusableBuffer.h>
+#include <askap/dataaccess/IBufferAllocator.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief allocator keeping track of the blocks handed out
+struct CountingAllocator : public IBufferAllocator {
+  virtual void* allocate(size_t nBytes) {
+     void *ptr = std::malloc(nBytes);
+     itsBlocks[ptr] = nBytes;
+     return ptr;
+  }
+  virtual void deallocate(void *ptr, size_t nBytes) {
+     CPPUNIT_ASSERT(itsBlocks.find(ptr) != itsBlocks.end());
+     CPPUNIT_ASSERT_EQUAL(itsBlocks[ptr], nBytes);
+     itsBlocks.erase(ptr);
+     std::free(ptr);
+  }
+  /// @brief check whether the memory belongs to one of the blocks
+  bool owns(const void *ptr) const {
+     for (std::map<void*, size_t>::const_iterator ci = itsBlocks.begin(); ci != itsBlocks.end(); ++ci) {
+          const char *start = static_cast<const char*>(ci->first);
+          if ((ptr >= start) && (ptr < start + ci->second)) {
+              return true;
+          }
+     }
+     return false;
+  }
+  std::map<void*, size_t> itsBlocks;
+};
+
+class ReusableBufferTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ReusableBufferTest);
+  CPPUNIT_TEST(reuseTest);
+  CPPUNIT_TEST(growTest);
+  CPPUNIT_TEST(releaseTest);
+  CPPUNIT_TEST(allocatorTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  
+  void reuseTest() {
+     ReusableBuffer<casacore::Complex> buffer;
+     casacore::Cube<casacore::Complex> cube;
+     buffer.reshape(cube, 10, 5, 4);
+     CPPUNIT_ASSERT(cube.shape() == casacore::IPosition(3, 10, 5, 4));
+     CPPUNIT_ASSERT(cube.contiguousStorage());
+     CPPUNIT_ASSERT_EQUAL(size_t(200), buffer.capacity());
+     const casacore::Complex *storage = cube.data();
+     // fewer rows shouldn't cause reallocation
+     buffer.reshape(cube, 7, 5, 4);
+     CPPUNIT_ASSERT(cube.shape() == casacore::IPosition(3, 7, 5, 4));
+     CPPUNIT_ASSERT(cube.data() == storage);
+     CPPUNIT_ASSERT_EQUAL(size_t(200), buffer.capacity());
+     // the view should be fully usable
+     indgen(cube);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(139., double(cube(6,4,3).real()), 1e-6);
+     // other array types share the same block
+     casacore::Vector<casacore::Complex> vec;
+     buffer.reshape(vec, 200);
+     CPPUNIT_ASSERT(vec.data() == storage);
+     casacore::Matrix<casacore::Complex> matrix;
+     buffer.reshape(matrix, 20, 10);
+     CPPUNIT_ASSERT(matrix.data() == storage);
+     // empty shape
+     buffer.reshape(cube, 0, 5, 4);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), cube.nelements());
+     CPPUNIT_ASSERT_EQUAL(size_t(200), buffer.capacity());
+  }
+  
+  void growTest() {
+     ReusableBuffer<casacore::Bool> buffer;
+     casacore::Cube<casacore::Bool> cube;
+     buffer.reshape(cube, 4, 5, 10);
+     cube.set(true);
+     casacore::Cube<casacore::Bool> old;
+     old.reference(cube);
+     buffer.reshape(cube, 4, 5, 20);
+     CPPUNIT_ASSERT_EQUAL(size_t(400), buffer.capacity());
+     CPPUNIT_ASSERT(cube.data() != old.data());
+     cube.set(false);
+     // the old block is still referenced and is not affected
+     CPPUNIT_ASSERT(allEQ(old, true));
+  }
+  
+  void releaseTest() {
+     ReusableBuffer<casacore::Float> buffer;
+     casacore::Cube<casacore::Float> cube;
+     buffer.reshape(cube, 3, 3, 3);
+     cube.set(1.);
+     buffer.release();
+     CPPUNIT_ASSERT_EQUAL(size_t(0), buffer.capacity());
+     // the cube keeps its values
+     CPPUNIT_ASSERT(allEQ(cube, casacore::Float(1.)));
+     casacore::Cube<casacore::Float> cube2;
+     buffer.reshape(cube2, 2, 2, 2);
+     CPPUNIT_ASSERT_EQUAL(size_t(8), buffer.capacity());
+     CPPUNIT_ASSERT(cube2.data() != cube.data());
+  }
+
+  void allocatorTest() {
+     boost::shared_ptr<CountingAllocator> allocator(new CountingAllocator);
+     {
+       ReusableBuffer<casacore::Complex> buffer;
+       buffer.setAllocator(allocator);
+       CPPUNIT_ASSERT(buffer.allocator() == allocator);
+       casacore::Cube<casacore::Complex> cube;
+       buffer.reshape(cube, 10, 5, 4);
+       CPPUNIT_ASSERT_EQUAL(size_t(1), allocator->itsBlocks.size());
+       CPPUNIT_ASSERT(allocator->owns(cube.data()));
+       CPPUNIT_ASSERT_EQUAL(size_t(200), buffer.capacity());
+       cube.set(casacore::Complex(1., -1.));
+       // fewer rows reuse the block
+       buffer.reshape(cube, 5, 5, 4);
+       CPPUNIT_ASSERT_EQUAL(size_t(1), allocator->itsBlocks.size());
+       // the old block is kept while the buffer grows
+       casacore::Cube<casacore::Complex> old;
+       old.reference(cube);
+       buffer.reshape(cube, 20, 5, 4);
+       CPPUNIT_ASSERT_EQUAL(size_t(2), allocator->itsBlocks.size());
+       CPPUNIT_ASSERT(allocator->owns(cube.data()));
+       CPPUNIT_ASSERT(cube.data() != old.data());
+       CPPUNIT_ASSERT(allEQ(old, casacore::Complex(1., -1.)));
+       // release returns all blocks
+       buffer.release();
+       CPPUNIT_ASSERT_EQUAL(size_t(0), allocator->itsBlocks.size());
+       buffer.reshape(cube, 2, 2, 2);
+       CPPUNIT_ASSERT_EQUAL(size_t(1), allocator->itsBlocks.size());
+       // switching back to the default allocation returns the block as well
+       buffer.setAllocator(boost::shared_ptr<IBufferAllocator>());
+       CPPUNIT_ASSERT_EQUAL(size_t(0), allocator->itsBlocks.size());
+       buffer.reshape(cube, 2, 2, 2);
+       CPPUNIT_ASSERT(!allocator->owns(cube.data()));
+       buffer.setAllocator(allocator);
+       buffer.reshape(cube, 3, 2, 2);
+     }
+     // the destructor of the buffer returns the block
+     CPPUNIT_ASSERT_EQUAL(size_t(0), allocator->itsBlocks.size());
+  }
+}; // class ReusableBufferTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef REUSABLE_BUFFER_TEST_H
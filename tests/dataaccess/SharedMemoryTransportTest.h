@@ -0,0 +1,185 @@
+/// @file
+/// @brief Tests of the shared memory transport of chunks
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef SHARED_MEMORY_TRANSPORT_TEST_H
+#define SHARED_MEMORY_TRANSPORT_TEST_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobOStream.h>
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/StreamDataSource.h>
+#include <askap/dataaccess/SharedMemoryChunkPublisher.h>
+#include <askap/dataaccess/SharedMemoryChunkReceiver.h>
+#include <askap/dataaccess/CachedDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// system includes
+#include <unistd.h>
+
+// std includes
+#include <algorithm>
+#include <string>
+#include <sstream>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief helper publishing the test measurement set in a separate thread
+struct TestMSPublisher {
+  /// @param[in] publisher publisher to use
+  /// @param[in] nConsumers number of consumers to wait for
+  /// @param[in] error string to store the error message, if any
+  TestMSPublisher(SharedMemoryChunkPublisher &publisher, size_t nConsumers, std::string &error) : 
+         itsPublisher(publisher), itsNConsumers(nConsumers), itsError(error) {}
+
+  void operator()() const {
+     try {
+        itsPublisher.waitForConsumers(itsNConsumers);
+        TableConstDataSource ds(TableTestRunner::msName());
+        IDataConverterPtr conv = ds.createConverter();
+        conv->setEpochFrame(); // ensures seconds since 0 MJD
+        for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end(); ++it) {
+             itsPublisher.publish(*it);
+        }
+     }
+     catch (const std::exception &ex) {
+        itsError = ex.what();
+     }
+     itsPublisher.finish();
+  }
+
+  SharedMemoryChunkPublisher &itsPublisher;
+  size_t itsNConsumers;
+  std::string &itsError;
+};
+
+class SharedMemoryTransportTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(SharedMemoryTransportTest);
+  CPPUNIT_TEST(testTwoConsumers);
+  CPPUNIT_TEST_EXCEPTION(testOversizedChunk, DataAccessError);
+  CPPUNIT_TEST_EXCEPTION(testMissingSegment, DataAccessError);
+  CPPUNIT_TEST_EXCEPTION(testTooManyConsumers, DataAccessError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {
+     std::ostringstream os;
+     os<<"/askap_dataaccess_test_"<<getpid();
+     itsName = os.str();
+  }
+
+  void testTwoConsumers() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv = ds.createConverter();
+     conv->setEpochFrame();
+     const size_t slotSize = maxChunkSize(ds, conv);
+     // small number of slots to exercise waiting for the slowest consumer
+     SharedMemoryChunkPublisher publisher(itsName, slotSize, 3);
+     StreamDataSource sds1(boost::shared_ptr<IChunkReceiver>(new SharedMemoryChunkReceiver(itsName)), 2);
+     StreamDataSource sds2(boost::shared_ptr<IChunkReceiver>(new SharedMemoryChunkReceiver(itsName)), 2);
+     std::string error;
+     boost::thread publisherThread(TestMSPublisher(publisher, 2, error));
+     boost::shared_ptr<IConstDataIterator> it1 = sds1.createConstIterator();
+     boost::shared_ptr<IConstDataIterator> it2 = sds2.createConstIterator();
+     size_t counter = 0;
+     for (IConstDataSharedIter refIt = ds.createConstIterator(conv); refIt != refIt.end(); ++refIt, ++counter) {
+          CPPUNIT_ASSERT(it1->hasMore());
+          CPPUNIT_ASSERT(it2->hasMore());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->time(), (*it1)->time(), 1e-6);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->time(), (*it2)->time(), 1e-6);
+          CPPUNIT_ASSERT_EQUAL(refIt->nRow(), (*it1)->nRow());
+          CPPUNIT_ASSERT_EQUAL(refIt->nRow(), (*it2)->nRow());
+          for (casacore::uInt row = 0; row < refIt->nRow(); ++row) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(refIt->visibility()(row, 0, 0) - (*it1)->visibility()(row, 0, 0)), 1e-6);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(refIt->visibility()(row, 0, 0) - (*it2)->visibility()(row, 0, 0)), 1e-6);
+          }
+          it1->next();
+          it2->next();
+     }
+     CPPUNIT_ASSERT(!it1->hasMore());
+     CPPUNIT_ASSERT(!it2->hasMore());
+     CPPUNIT_ASSERT_EQUAL(size_t(420), counter);
+     publisherThread.join();
+     CPPUNIT_ASSERT_EQUAL(std::string(), error);
+  }
+
+  void testOversizedChunk() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     SharedMemoryChunkPublisher publisher(itsName, 16);
+     // this should generate an exception
+     publisher.publish(*ds.createConstIterator());
+  }
+
+  void testMissingSegment() {
+     // this should generate an exception
+     SharedMemoryChunkReceiver receiver(itsName);
+  }
+
+  void testTooManyConsumers() {
+     SharedMemoryChunkPublisher publisher(itsName, 16, 2, 1);
+     SharedMemoryChunkReceiver receiver1(itsName);
+     CPPUNIT_ASSERT_EQUAL(size_t(1), publisher.nConsumers());
+     // this should generate an exception
+     SharedMemoryChunkReceiver receiver2(itsName);
+  }
+
+protected:
+  /// @brief largest serialised chunk of the test measurement set
+  static size_t maxChunkSize(const TableConstDataSource &ds, const IDataConverterPtr &conv) {
+     size_t result = 0;
+     LOFAR::BlobString bs;
+     for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end(); ++it) {
+          bs.resize(0);
+          LOFAR::BlobOBufString bob(bs);
+          LOFAR::BlobOStream out(bob);
+          CachedDataAccessor::serialise(*it, out);
+          result = std::max(result, size_t(bs.size()));
+     }
+     return result;
+  }
+
+private:
+  /// @brief name of the shared memory segment
+  std::string itsName;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef SHARED_MEMORY_TRANSPORT_TEST_H
@@ -0,0 +1,194 @@
+/// @file
+/// @brief Tests of the decorrelation factors computed by SmearingAccessorAdapter
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef SMEARING_ACCESSOR_ADAPTER_TEST_H
+#define SMEARING_ACCESSOR_ADAPTER_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/SmearingAccessorAdapter.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/casa/Quanta/Quantum.h>
+
+// std includes
+#include <cmath>
+
+namespace askap {
+
+namespace accessors {
+
+class SmearingAccessorAdapterTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(SmearingAccessorAdapterTest);
+  CPPUNIT_TEST(testPhaseCentre);
+  CPPUNIT_TEST(testBandwidthSmearing);
+  CPPUNIT_TEST(testTimeSmearing);
+  CPPUNIT_TEST(testRateFromPreviousChunk);
+  CPPUNIT_TEST(testCache);
+  CPPUNIT_TEST(testFrequencyChange);
+  CPPUNIT_TEST(testSingleChannel);
+  CPPUNIT_TEST_EXCEPTION(testSingleChannelNoWidth, AskapError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testPhaseCentre() {
+     DataAccessorStub acc(true);
+     const SmearingAccessorAdapter adapter(acc);
+     const casacore::Matrix<casacore::Float> &factors = adapter.decorrelation(acc.itsPointingDir1[0], 10.);
+     CPPUNIT_ASSERT_EQUAL(acc.nRow(), casacore::uInt(factors.nrow()));
+     CPPUNIT_ASSERT_EQUAL(acc.nChannel(), casacore::uInt(factors.ncolumn()));
+     for (casacore::uInt row = 0; row < factors.nrow(); ++row) {
+          for (casacore::uInt chan = 0; chan < factors.ncolumn(); ++chan) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(1., factors(row, chan), 1e-6);
+          }
+     }
+  }
+
+  void testBandwidthSmearing() {
+     DataAccessorStub acc(true);
+     const SmearingAccessorAdapter adapter(acc);
+     // 1 deg offset along the equator from the phase centre at (0,0)
+     const double offset = casacore::C::pi / 180.;
+     const casacore::MVDirection dir(offset, 0.);
+     const casacore::Matrix<casacore::Float> &factors = adapter.decorrelation(dir, 0.);
+     // channels are spaced by 20 MHz in the stub
+     const double l = std::sin(offset);
+     const double nMinusOne = std::cos(offset) - 1.;
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          const double x = casacore::C::pi * (acc.uvw()[row](0) * l + acc.uvw()[row](2) * nMinusOne) *
+                           20e6 / casacore::C::c;
+          const double expected = x == 0. ? 1. : std::sin(x) / x;
+          for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, factors(row, chan), 1e-5);
+          }
+     }
+     // explicit channel width
+     const casacore::Matrix<casacore::Float> &narrow = adapter.decorrelation(dir, 0., 1e3);
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          CPPUNIT_ASSERT(narrow(row, 0) >= factors(row, 0));
+     }
+  }
+
+  void testTimeSmearing() {
+     DataAccessorStub acc(true);
+     const SmearingAccessorAdapter adapter(acc);
+     const casacore::MVDirection dir(casacore::C::pi / 90., casacore::C::pi / 180.);
+     const casacore::Matrix<casacore::Float> bandwidthOnly = adapter.decorrelation(dir, 0.).copy();
+     const casacore::Matrix<casacore::Float> &both = adapter.decorrelation(dir, 60.);
+     bool smeared = false;
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+               CPPUNIT_ASSERT(std::abs(both(row, chan)) <= std::abs(bandwidthOnly(row, chan)) + 1e-6);
+               smeared = smeared || (both(row, chan) < bandwidthOnly(row, chan) - 1e-6);
+          }
+     }
+     CPPUNIT_ASSERT(smeared);
+  }
+
+  void testRateFromPreviousChunk() {
+     DataAccessorStub acc(true);
+     const SmearingAccessorAdapter adapter(acc);
+     // the first chunk, the rate is due to the Earth rotation (phase centre on the equator)
+     CPPUNIT_ASSERT_EQUAL(acc.nRow(), casacore::uInt(adapter.uvwRate().nelements()));
+     const double omega = 7.2921150e-5;
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(omega * acc.itsUVW[row](2), adapter.uvwRate()[row](0), 1e-9);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(0., adapter.uvwRate()[row](1), 1e-9);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(-omega * acc.itsUVW[row](0), adapter.uvwRate()[row](2), 1e-9);
+     }
+     // the next time step with the same rows
+     acc.itsTime += 10.;
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          acc.itsUVW[row](0) += 10.;
+          acc.itsUVW[row](1) += 20.;
+          acc.itsUVW[row](2) += 30.;
+     }
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(1., adapter.uvwRate()[row](0), 1e-9);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(2., adapter.uvwRate()[row](1), 1e-9);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(3., adapter.uvwRate()[row](2), 1e-9);
+     }
+  }
+
+  void testCache() {
+     DataAccessorStub acc(true);
+     const SmearingAccessorAdapter adapter(acc);
+     const casacore::MVDirection dir1(0.01, 0.02);
+     const casacore::MVDirection dir2(0.02, 0.01);
+     const casacore::Matrix<casacore::Float> &factors1 = adapter.decorrelation(dir1, 10.);
+     const casacore::Matrix<casacore::Float> &factors2 = adapter.decorrelation(dir2, 10.);
+     CPPUNIT_ASSERT(&factors1 != &factors2);
+     // both directions are cached for this chunk
+     CPPUNIT_ASSERT(&factors1 == &adapter.decorrelation(dir1, 10.));
+     CPPUNIT_ASSERT(&factors2 == &adapter.decorrelation(dir2, 10.));
+     // different integration time
+     CPPUNIT_ASSERT(&factors1 != &adapter.decorrelation(dir1, 5.));
+  }
+
+  void testFrequencyChange() {
+     DataAccessorStub acc(true);
+     SmearingAccessorAdapter adapter(acc);
+     const casacore::MVDirection dir(casacore::C::pi / 180., 0.);
+     const casacore::Matrix<casacore::Float> before = adapter.decorrelation(dir, 0.).copy();
+     // doubling the frequencies doubles the channel spacing, so the factors should be recomputed
+     casacore::Vector<casacore::Double> &freq = adapter.rwFrequency();
+     for (casacore::uInt chan = 0; chan < freq.nelements(); ++chan) {
+          freq[chan] *= 2.;
+     }
+     const casacore::Matrix<casacore::Float> &after = adapter.decorrelation(dir, 0.);
+     bool changed = false;
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          changed = changed || (std::abs(after(row, 0) - before(row, 0)) > 1e-6);
+     }
+     CPPUNIT_ASSERT(changed);
+  }
+
+  void testSingleChannel() {
+     DataAccessorStub acc(true);
+     acc.itsFrequency.resize(1, true);
+     const SmearingAccessorAdapter adapter(acc);
+     const casacore::Matrix<casacore::Float> &factors = adapter.decorrelation(casacore::MVDirection(0.01, 0.), 0., 1e6);
+     CPPUNIT_ASSERT_EQUAL(1u, casacore::uInt(factors.ncolumn()));
+  }
+
+  void testSingleChannelNoWidth() {
+     DataAccessorStub acc(true);
+     acc.itsFrequency.resize(1, true);
+     const SmearingAccessorAdapter adapter(acc);
+     // the width can't be derived from the spacing, this should generate an exception
+     adapter.decorrelation(casacore::MVDirection(0.01, 0.), 0.);
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef SMEARING_ACCESSOR_ADAPTER_TEST_H
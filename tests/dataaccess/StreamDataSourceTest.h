@@ -0,0 +1,189 @@
+/// @file
+/// @brief Tests of the streaming data source
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef STREAM_DATA_SOURCE_TEST_H
+#define STREAM_DATA_SOURCE_TEST_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/StreamDataSource.h>
+#include <askap/dataaccess/SocketChunkReceiver.h>
+#include <askap/dataaccess/SocketChunkSender.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// system includes
+#include <sys/socket.h>
+#include <unistd.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief helper sending the test measurement set over a socket in a separate thread
+struct TestMSSender {
+  /// @param[in] fd file descriptor to write to (ownership is taken)
+  /// @param[in] error string to store the error message, if any
+  TestMSSender(int fd, std::string &error) : itsFD(fd), itsError(error) {}
+
+  void operator()() const {
+     SocketChunkSender sender(itsFD);
+     try {
+        TableConstDataSource ds(TableTestRunner::msName());
+        IDataConverterPtr conv = ds.createConverter();
+        conv->setEpochFrame(); // ensures seconds since 0 MJD
+        for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end(); ++it) {
+             sender.send(*it);
+        }
+     }
+     catch (const std::exception &ex) {
+        itsError = ex.what();
+     }
+  }
+
+  int itsFD;
+  std::string &itsError;
+};
+
+class StreamDataSourceTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(StreamDataSourceTest);
+  CPPUNIT_TEST(testStreaming);
+  CPPUNIT_TEST(testEmptyStream);
+  CPPUNIT_TEST_EXCEPTION(testTruncatedStream, DataAccessError);
+  CPPUNIT_TEST_EXCEPTION(testSelection, DataAccessLogicError);
+  CPPUNIT_TEST_EXCEPTION(testSecondIterator, DataAccessLogicError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {
+     int fds[2];
+     CPPUNIT_ASSERT_EQUAL(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+     itsReceiver.reset(new SocketChunkReceiver(fds[0]));
+     itsWriteFD = fds[1];
+  }
+
+  void tearDown() {
+     if (itsWriteFD >= 0) {
+         close(itsWriteFD);
+     }
+     itsReceiver.reset();
+  }
+
+  void testStreaming() {
+     std::string error;
+     boost::thread senderThread(TestMSSender(itsWriteFD, error));
+     itsWriteFD = -1;
+     const size_t capacity = 4;
+     StreamDataSource sds(itsReceiver, capacity);
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv = ds.createConverter();
+     conv->setEpochFrame();
+     IConstDataSharedIter refIt = ds.createConstIterator(conv);
+     size_t counter = 0;
+     for (boost::shared_ptr<IConstDataIterator> it = sds.createConstIterator(); it->hasMore(); it->next(), refIt.next(), ++counter) {
+          CPPUNIT_ASSERT(sds.queue().size() <= capacity);
+          CPPUNIT_ASSERT(refIt.hasMore());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->time(), (*it)->time(), 1e-6);
+          CPPUNIT_ASSERT_EQUAL(refIt->nRow(), (*it)->nRow());
+          CPPUNIT_ASSERT_EQUAL(refIt->nChannel(), (*it)->nChannel());
+          CPPUNIT_ASSERT_EQUAL(refIt->nPol(), (*it)->nPol());
+          for (casacore::uInt row = 0; row < refIt->nRow(); ++row) {
+               CPPUNIT_ASSERT_EQUAL(refIt->antenna1()[row], (*it)->antenna1()[row]);
+               CPPUNIT_ASSERT_EQUAL(refIt->antenna2()[row], (*it)->antenna2()[row]);
+               for (casacore::uInt chan = 0; chan < refIt->nChannel(); ++chan) {
+                    for (casacore::uInt pol = 0; pol < refIt->nPol(); ++pol) {
+                         CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(refIt->visibility()(row, chan, pol) - 
+                                             (*it)->visibility()(row, chan, pol)), 1e-6);
+                    }
+               }
+          }
+     }
+     CPPUNIT_ASSERT(!refIt.hasMore());
+     CPPUNIT_ASSERT_EQUAL(size_t(420), counter);
+     senderThread.join();
+     CPPUNIT_ASSERT_EQUAL(std::string(), error);
+  }
+
+  void testEmptyStream() {
+     close(itsWriteFD);
+     itsWriteFD = -1;
+     StreamDataSource sds(itsReceiver);
+     boost::shared_ptr<IConstDataIterator> it = sds.createConstIterator();
+     CPPUNIT_ASSERT(!it->hasMore());
+  }
+
+  void testTruncatedStream() {
+     // header announcing 100 bytes followed by just 10 
+     const LOFAR::uint64 size = 100;
+     const char data[10] = {0};
+     CPPUNIT_ASSERT_EQUAL(ssize_t(sizeof(size)), write(itsWriteFD, &size, sizeof(size)));
+     CPPUNIT_ASSERT_EQUAL(ssize_t(sizeof(data)), write(itsWriteFD, data, sizeof(data)));
+     close(itsWriteFD);
+     itsWriteFD = -1;
+     StreamDataSource sds(itsReceiver);
+     // this should generate an exception
+     sds.createConstIterator();
+  }
+
+  void testSelection() {
+     StreamDataSource sds(itsReceiver);
+     IDataSelectorPtr sel = sds.createSelector();
+     // this should generate an exception
+     sel->chooseCrossCorrelations();
+  }
+
+  void testSecondIterator() {
+     close(itsWriteFD);
+     itsWriteFD = -1;
+     StreamDataSource sds(itsReceiver);
+     sds.createConstIterator();
+     // this should generate an exception
+     sds.createConstIterator();
+  }
+
+private:
+  /// @brief receiving side of the socket pair
+  boost::shared_ptr<SocketChunkReceiver> itsReceiver;
+
+  /// @brief sending side of the socket pair, negative if closed
+  int itsWriteFD;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef STREAM_DATA_SOURCE_TEST_H
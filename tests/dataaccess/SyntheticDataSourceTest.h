@@ -0,0 +1,208 @@
+/// @file
+/// @brief Tests of the synthetic data source
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef SYNTHETIC_DATA_SOURCE_TEST_H
+#define SYNTHETIC_DATA_SOURCE_TEST_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/measures/Measures/MDirection.h>
+
+// own includes
+#include <askap/dataaccess/SyntheticDataSource.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <cmath>
+#include <complex>
+#include <utility>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+class SyntheticDataSourceTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(SyntheticDataSourceTest);
+  CPPUNIT_TEST(testDefaultObservation);
+  CPPUNIT_TEST(testPointSource);
+  CPPUNIT_TEST(testThreads);
+  CPPUNIT_TEST(testEmptyObservation);
+  CPPUNIT_TEST_EXCEPTION(testSelection, DataAccessLogicError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testDefaultObservation() {
+     SyntheticDataSource sds;
+     const SyntheticObservation &obs = sds.observation();
+     CPPUNIT_ASSERT_EQUAL(36u, obs.nAntennas());
+     CPPUNIT_ASSERT_EQUAL(630u, obs.nRow());
+     size_t counter = 0;
+     for (boost::shared_ptr<IConstDataIterator> it = sds.createConstIterator(); it->hasMore(); it->next(), ++counter) {
+          const IConstDataAccessor &acc = **it;
+          CPPUNIT_ASSERT_EQUAL(630u, acc.nRow());
+          CPPUNIT_ASSERT_EQUAL(16u, acc.nChannel());
+          CPPUNIT_ASSERT_EQUAL(4u, acc.nPol());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(60000. * 86400. + 5. + 10. * counter, acc.time(), 1e-6);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(1.4e9 + 15e6, acc.frequency()[15], 1e-3);
+          CPPUNIT_ASSERT_EQUAL(casacore::Stokes::XX, acc.stokes()[0]);
+          CPPUNIT_ASSERT_EQUAL(casacore::Stokes::YY, acc.stokes()[3]);
+          for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+               CPPUNIT_ASSERT(acc.antenna1()[row] < acc.antenna2()[row]);
+               CPPUNIT_ASSERT_EQUAL(0u, acc.feed1()[row]);
+               // the source is at the phase centre
+               for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., std::abs(acc.visibility()(row, chan, 0) - casacore::Complex(1., 0.)), 1e-5);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., std::abs(acc.visibility()(row, chan, 1)), 1e-6);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., std::abs(acc.visibility()(row, chan, 2)), 1e-6);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., std::abs(acc.visibility()(row, chan, 3) - casacore::Complex(1., 0.)), 1e-5);
+                    CPPUNIT_ASSERT(!acc.flag()(row, chan, 0));
+               }
+          }
+          // uvw is a rotation of the baseline, so the length is preserved (the array is flat)
+          const double length = baselineLength(obs, acc.antenna1()[17], acc.antenna2()[17]);
+          const casacore::RigidVector<casacore::Double, 3> &uvw = acc.uvw()[17];
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(length, std::sqrt(uvw * uvw), 1e-6);
+          // rotation to the phase centre itself doesn't change anything
+          const casacore::MDirection phaseCentre(obs.phaseCentre(), casacore::MDirection::J2000);
+          const casacore::RigidVector<casacore::Double, 3> &rotated = acc.rotatedUVW(phaseCentre)[17];
+          for (casacore::uInt dim = 0; dim < 3; ++dim) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(uvw(dim), rotated(dim), 1e-6);
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(10), counter);
+  }
+
+  void testPointSource() {
+     SyntheticObservation obs;
+     obs.setSpiralArray(6, 1000.);
+     obs.setSpectralAxis(1e9, 2e6, 5);
+     std::vector<std::pair<casacore::Double, casacore::Double> > beams;
+     beams.push_back(std::make_pair(0., 0.));
+     beams.push_back(std::make_pair(0.01, -0.005));
+     obs.setBeamOffsets(beams);
+     obs.setTimeAxis(1e9, 5., 4);
+     obs.clearSky();
+     obs.addPointSource(0.003, -0.002, 2., -0.7);
+     const double l = 0.003;
+     const double m = -0.002;
+     const double nMinusOne = std::sqrt(1. - l * l - m * m) - 1.;
+     SyntheticDataSource sds(obs, 2);
+     size_t counter = 0;
+     for (boost::shared_ptr<IConstDataIterator> it = sds.createConstIterator(); it->hasMore(); it->next(), ++counter) {
+          const IConstDataAccessor &acc = **it;
+          CPPUNIT_ASSERT_EQUAL(30u, acc.nRow());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(1e9 + 2.5 + 5. * counter, acc.time(), 1e-6);
+          for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+               CPPUNIT_ASSERT_EQUAL(row < 15 ? 0u : 1u, acc.feed1()[row]);
+               const double offset = row < 15 ? 0. : std::sqrt(0.01 * 0.01 + 0.005 * 0.005);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(offset, acc.pointingDir1()[row].separation(obs.phaseCentre()), 1e-5);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., acc.dishPointing1()[row].separation(obs.phaseCentre()), 1e-9);
+               const casacore::RigidVector<casacore::Double, 3> &uvw = acc.uvw()[row];
+               for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+                    const double freq = acc.frequency()[chan];
+                    const double phase = -2. * casacore::C::pi * (uvw(0) * l + uvw(1) * m + uvw(2) * nMinusOne) *
+                                         freq / casacore::C::c;
+                    const std::complex<double> expected = std::polar(2. * std::pow(freq / 1.004e9, -0.7), phase);
+                    const casacore::Complex vis = acc.visibility()(row, chan, 0);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.real(), real(vis), 1e-4);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.imag(), imag(vis), 1e-4);
+               }
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(4), counter);
+  }
+
+  void testThreads() {
+     SyntheticObservation obs;
+     obs.setSpiralArray(8, 2000.);
+     obs.setTimeAxis(1e9, 1., 23);
+     obs.addPointSource(0.01, 0.02, 0.5);
+     SyntheticDataSource reference(obs);
+     // small queue, so the generating threads have to wait for each other
+     SyntheticDataSource parallel(obs, 4, 2);
+     boost::shared_ptr<IConstDataIterator> refIt = reference.createConstIterator();
+     size_t counter = 0;
+     for (boost::shared_ptr<IConstDataIterator> it = parallel.createConstIterator(); it->hasMore();
+          it->next(), refIt->next(), ++counter) {
+          CPPUNIT_ASSERT(refIt->hasMore());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL((*refIt)->time(), (*it)->time(), 1e-9);
+          CPPUNIT_ASSERT(allEQ((*refIt)->visibility(), (*it)->visibility()));
+     }
+     CPPUNIT_ASSERT(!refIt->hasMore());
+     CPPUNIT_ASSERT_EQUAL(size_t(23), counter);
+     // the iterator can be destroyed before the end of the observation
+     boost::shared_ptr<IConstDataIterator> it = parallel.createConstIterator();
+     CPPUNIT_ASSERT(it->hasMore());
+     it->next();
+     it.reset();
+  }
+
+  void testEmptyObservation() {
+     SyntheticObservation obs;
+     obs.setTimeAxis(1e9, 10., 0);
+     SyntheticDataSource sds(obs, 3);
+     boost::shared_ptr<IConstDataIterator> it = sds.createConstIterator();
+     CPPUNIT_ASSERT(!it->hasMore());
+  }
+
+  void testSelection() {
+     SyntheticDataSource sds;
+     IDataSelectorPtr sel = sds.createSelector();
+     // this should generate an exception
+     sel->chooseCrossCorrelations();
+  }
+
+protected:
+  /// @brief length of a baseline
+  /// @details The default spiral layout of 3 km radius is assumed
+  /// @param[in] obs observation
+  /// @param[in] ant1 first antenna
+  /// @param[in] ant2 second antenna
+  /// @return baseline length in metres
+  static double baselineLength(const SyntheticObservation &obs, casacore::uInt ant1, casacore::uInt ant2) {
+     const double goldenAngle = casacore::C::pi * (3. - std::sqrt(5.));
+     const double r1 = 3000. * std::sqrt((ant1 + 0.5) / obs.nAntennas());
+     const double r2 = 3000. * std::sqrt((ant2 + 0.5) / obs.nAntennas());
+     const double dx = r2 * std::cos(ant2 * goldenAngle) - r1 * std::cos(ant1 * goldenAngle);
+     const double dy = r2 * std::sin(ant2 * goldenAngle) - r1 * std::sin(ant1 * goldenAngle);
+     return std::sqrt(dx * dx + dy * dy);
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef SYNTHETIC_DATA_SOURCE_TEST_H
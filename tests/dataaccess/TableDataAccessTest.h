@@ -30,25 +30,73 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 
 // casa includes
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/TableIter.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/casa/OS/EnvVar.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MCDirection.h>
+#include <casacore/measures/Measures/MeasConvert.h>
 
 // std includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 // cppunit includes
 #include <cppunit/extensions/HelperMacros.h>
 
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
 // own includes
 #include <askap/dataaccess/DataAccessError.h>
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/TableDataSource.h>
 #include <askap/dataaccess/IConstDataSource.h>
 #include <askap/dataaccess/TableConstDataIterator.h>
+#include <askap/dataaccess/TableDataIterator.h>
+#include <askap/dataaccess/IDirtyRegionDataAccessor.h>
+#include <askap/dataaccess/INativeLayoutDataAccessor.h>
+#include <askap/dataaccess/ICompactNoiseDataAccessor.h>
+#include <askap/dataaccess/IFlaggedRowDataAccessor.h>
+#include <askap/dataaccess/IMultiColumnDataAccessor.h>
+#include <askap/dataaccess/ISinglePrecisionDataAccessor.h>
+#include <askap/dataaccess/IWeightDataAccessor.h>
+#include <askap/dataaccess/IFacetUVWDataAccessor.h>
+#include <askap/dataaccess/IBufferAllocator.h>
+#include <askap/dataaccess/ThreadAffinity.h>
+#include <askap/dataaccess/CachingDataSource.h>
+#include <askap/dataaccess/CachingDataIterator.h>
+#include <askap/dataaccess/CachedDataAccessor.h>
+#include <askap/dataaccess/HybridBufferManager.h>
+#include <askap/dataaccess/CompressingBufferManager.h>
+#include <askap/dataaccess/ParallacticAngleEngine.h>
+#include <askap/dataaccess/MainTableRowIndex.h>
+#include <askap/dataaccess/IteratorStatistics.h>
+#include <askap/dataaccess/QCStatistics.h>
+#include <askap/dataaccess/TimeStepIterator.h>
+#include <askap/dataaccess/ParallelChunkDriver.h>
 #include "TableTestRunner.h"
 
 namespace askap {
@@ -75,6 +123,41 @@ class TableDataAccessTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(readOnlyTest);
   CPPUNIT_TEST(channelSelectionTest);
   CPPUNIT_TEST(chunkSizeTest);
+  CPPUNIT_TEST(nativeLayoutTest);
+  CPPUNIT_TEST(prefetchTest);
+  CPPUNIT_TEST(compactNoiseTest);
+  CPPUNIT_TEST(skipFlaggedRowsTest);
+  CPPUNIT_TEST(partitionTest);
+  CPPUNIT_TEST(parallelDriverTest);
+  CPPUNIT_TEST(channelTilingTest);
+  CPPUNIT_TEST(memoryMappedTest);
+  CPPUNIT_TEST(cachingTest);
+  CPPUNIT_TEST(requiredFieldsTest);
+  CPPUNIT_TEST(writeBehindTest);
+  CPPUNIT_TEST(dirtyRegionTest);
+  CPPUNIT_TEST(hybridBufferTest);
+  CPPUNIT_TEST(rotatedUVWStoreTest);
+  CPPUNIT_TEST(facetRotatedUVWTest);
+  CPPUNIT_TEST(parallacticAngleTest);
+  CPPUNIT_TEST(rowIndexTest);
+  CPPUNIT_TEST(timeRangeSelectionTest);
+  CPPUNIT_TEST(serialisationTest);
+  CPPUNIT_TEST(statisticsTest);
+  CPPUNIT_TEST(qcStatisticsTest);
+  CPPUNIT_TEST(qcStatisticsOnceTest);
+  CPPUNIT_TEST(seekTest);
+  CPPUNIT_TEST(subtableSnapshotTest);
+  CPPUNIT_TEST(multiColumnTest);
+  CPPUNIT_TEST(polSelectionTest);
+  CPPUNIT_TEST(channelAveragingTest);
+  CPPUNIT_TEST(singlePrecisionTest);
+  CPPUNIT_TEST(bufferAllocatorTest);
+  CPPUNIT_TEST(affinityTest);
+  CPPUNIT_TEST(weightTest);
+  CPPUNIT_TEST(concurrentWriteTest);
+  CPPUNIT_TEST(timeStepTest);
+  CPPUNIT_TEST(rowGroupingTest);
+  CPPUNIT_TEST(chunkMemoryBudgetTest);
   CPPUNIT_TEST_SUITE_END();
 public:
   
@@ -116,8 +199,91 @@ public:
   void channelSelectionTest();
   /// test restriction of the chunk size
   void chunkSizeTest();
+  /// test access to the cubes in the storage order
+  void nativeLayoutTest();
+  /// test of the background read-ahead
+  void prefetchTest();
+  /// test of the compact noise representation
+  void compactNoiseTest();
+  /// test of skipping rows flagged as a whole
+  void skipFlaggedRowsTest();
+  /// test of the partitioned iteration
+  void partitionTest();
+  /// @brief test of the parallel processing of partitions with work stealing
+  void parallelDriverTest();
+  /// test of the split of the spectral axis
+  void channelTilingTest();
+  /// test of the memory-mapped access
+  void memoryMappedTest();
+  /// test of the in-memory cache for multiple passes
+  void cachingTest();
+  /// test of the declaration of required fields
+  void requiredFieldsTest();
+  /// test of the deferred write of modified chunks
+  void writeBehindTest();
+  /// test of the partial write-back of modified regions
+  void dirtyRegionTest();
+  /// @brief test of the memory-bounded buffers spilled to disk
+  void hybridBufferTest();
+  /// @brief test of rotated uvws reused between iterations
+  void rotatedUVWStoreTest();
+  /// @brief test of uvws rotated to many tangent points at once
+  void facetRotatedUVWTest();
+  /// @brief test of parallactic angles computed for all antennas at once
+  void parallacticAngleTest();
+  /// @brief test of the selection via the index of the main table rows
+  void rowIndexTest();
+  /// @brief test of the time range and cycle selection via the TIME column index
+  void timeRangeSelectionTest();
+  /// @brief test of the round trip of chunks through a blob stream
+  void serialisationTest();
+  /// @brief test of the I/O and cache statistics
+  void statisticsTest();
+  /// @brief test of the quality control statistics accumulated during read
+  void qcStatisticsTest();
+  /// @brief test that every chunk contributes to the quality control statistics once
+  void qcStatisticsOnceTest();
+  /// @brief test of the random access via the index of chunks
+  void seekTest();
+  /// @brief test of the sidecar snapshot of the subtables
+  void subtableSnapshotTest();
+  /// @brief test of reading several data columns together
+  void multiColumnTest();
+  /// @brief test of the polarisation selection
+  void polSelectionTest();
+  /// @brief test of the channel averaging at read time
+  void channelAveragingTest();
+  /// @brief test of the single precision uvw and spectral axis
+  void singlePrecisionTest();
+  /// @brief test of the custom allocator of the data buffers
+  void bufferAllocatorTest();
+  /// @brief test of the iteration bound to NUMA nodes
+  void affinityTest();
+  /// @brief test of the weight cube derived from flags and noise
+  void weightTest();
+  /// @brief test of the concurrent writes from partitioned iterators
+  void concurrentWriteTest();
+  /// @brief test of the iteration over time steps as row ranges
+  void timeStepTest();
+  /// @brief test of the grouping of rows by DATA_DESC_ID and FIELD_ID
+  void rowGroupingTest();
+  /// @brief test of the chunk size derived from the memory budget
+  void chunkMemoryBudgetTest();
 protected:
   void doBufferTest() const;
+  /// @brief modify all visibilities of one partition
+  /// @details This is the body of the threads used in concurrentWriteTest
+  /// @param[in] it iterator over the partition
+  /// @param[in] value value to assign to all visibilities
+  /// @param[in] original vector to store the original visibilities of each chunk
+  static void modifyPartition(const boost::shared_ptr<IDataIterator> &it, casacore::Complex value,
+                              std::vector<casacore::Cube<casacore::Complex> > &original);
+  /// @brief set up one of the selections used in rowIndexTest
+  /// @param[in] sel selector to set up
+  /// @param[in] selection selection number
+  /// @param[in] startTime time of the first iteration
+  static void setUpRowIndexSelection(const IDataSelectorPtr &sel, int selection, 
+                                     casacore::Double startTime);
 private:
   boost::shared_ptr<ITableInfoAccessor> itsTableInfoAccessor;  
 }; // class TableDataAccessTest
@@ -233,6 +399,1488 @@ void TableDataAccessTest::chunkSizeTest()
 }
   
 
+/// test access to the cubes in the storage order
+void TableDataAccessTest::nativeLayoutTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   for (int pass = 0; pass < 2; ++pass) {
+        // the first pass is with the default layout, the second with the native one
+        ds.configureNativeLayout(pass == 1);
+        for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end();++it) {  
+             const INativeLayoutDataAccessor *acc = dynamic_cast<const INativeLayoutDataAccessor*>(&(*it));
+             CPPUNIT_ASSERT(acc != NULL);
+             const casacore::Cube<casacore::Complex> &nativeVis = acc->nativeVisibility();
+             const casacore::Cube<casacore::Bool> &nativeFlag = acc->nativeFlag();
+             const casacore::Cube<casacore::Complex> &nativeNoise = acc->nativeNoise();
+             CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(it->nPol()), nativeVis.nrow());
+             CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(it->nChannel()), nativeVis.ncolumn());
+             CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(it->nRow()), nativeVis.nplane());
+             CPPUNIT_ASSERT(nativeFlag.shape() == nativeVis.shape());
+             CPPUNIT_ASSERT(nativeNoise.shape() == nativeVis.shape());
+             for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                  for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                       for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+                            CPPUNIT_ASSERT(it->visibility()(row,chan,pol) == nativeVis(pol,chan,row));
+                            CPPUNIT_ASSERT(it->flag()(row,chan,pol) == nativeFlag(pol,chan,row));
+                            CPPUNIT_ASSERT(it->noise()(row,chan,pol) == nativeNoise(pol,chan,row));
+                       }
+                  }
+             }
+        }
+   }
+}
+
+/// test of the background read-ahead
+void TableDataAccessTest::prefetchTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   TableConstDataSource prefetchDS(TableTestRunner::msName());
+   prefetchDS.configurePrefetch();
+   for (int pass = 0; pass < 2; ++pass) {
+        // the second pass uses small chunks, so some of them are prefetched
+        // within the same iteration of the table iterator
+        const casacore::uInt maxChunkSize = pass == 0 ? INT_MAX : 50;
+        ds.configureMaxChunkSize(maxChunkSize);
+        prefetchDS.configureMaxChunkSize(maxChunkSize);
+        IConstDataSharedIter it = ds.createConstIterator();
+        IConstDataSharedIter prefetchIt = prefetchDS.createConstIterator();
+        for (; it != it.end(); ++it, ++prefetchIt) {
+             CPPUNIT_ASSERT(prefetchIt != prefetchIt.end());
+             CPPUNIT_ASSERT_EQUAL(it->nRow(), prefetchIt->nRow());
+             CPPUNIT_ASSERT(it->visibility().shape() == prefetchIt->visibility().shape());
+             CPPUNIT_ASSERT(casacore::allEQ(it->visibility(), prefetchIt->visibility()));
+             CPPUNIT_ASSERT(casacore::allEQ(it->flag(), prefetchIt->flag()));
+             CPPUNIT_ASSERT(casacore::allEQ(it->noise(), prefetchIt->noise()));
+             CPPUNIT_ASSERT(casacore::allEQ(it->antenna1(), prefetchIt->antenna1()));
+             for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                  for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                       CPPUNIT_ASSERT_DOUBLES_EQUAL(it->uvw()(row)(dim), prefetchIt->uvw()(row)(dim), 1e-9);
+                  }
+             }
+        }
+        CPPUNIT_ASSERT(prefetchIt == prefetchIt.end());
+   }
+}
+
+/// test of the compact noise representation
+void TableDataAccessTest::compactNoiseTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end();++it) {  
+        const ICompactNoiseDataAccessor *acc = dynamic_cast<const ICompactNoiseDataAccessor*>(&(*it));
+        CPPUNIT_ASSERT(acc != NULL);
+        if (acc->noiseRepresentation() == ICompactNoiseDataAccessor::SPECTRAL_NOISE) {
+            continue;
+        }
+        const casacore::Matrix<casacore::Complex> &rowPolNoise = acc->rowPolNoise();
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(it->nRow()), rowPolNoise.nrow());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(it->nPol()), rowPolNoise.ncolumn());
+        const casacore::Cube<casacore::Complex> &noise = it->noise();
+        for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+             for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                  for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+                       CPPUNIT_ASSERT(noise(row,chan,pol) == rowPolNoise(row,pol));
+                       if (acc->noiseRepresentation() == ICompactNoiseDataAccessor::CONSTANT_NOISE) {
+                           CPPUNIT_ASSERT(noise(row,chan,pol) == acc->constantNoise());
+                       }
+                  }
+             }
+        }
+   }
+}
+
+/// test of skipping rows flagged as a whole
+void TableDataAccessTest::skipFlaggedRowsTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   TableConstDataSource skipDS(TableTestRunner::msName());
+   skipDS.configureSkipFlaggedRows();
+   for (int pass = 0; pass < 2; ++pass) {
+        skipDS.configureNativeLayout(pass == 1);
+        IConstDataSharedIter it = ds.createConstIterator();
+        IConstDataSharedIter skipIt = skipDS.createConstIterator();
+        for (; it != it.end(); ++it, ++skipIt) {
+             CPPUNIT_ASSERT(skipIt != skipIt.end());
+             const IFlaggedRowDataAccessor *acc = dynamic_cast<const IFlaggedRowDataAccessor*>(&(*skipIt));
+             CPPUNIT_ASSERT(acc != NULL);
+             const casacore::Vector<casacore::uInt> &rows = acc->unflaggedRows();
+             CPPUNIT_ASSERT(rows.nelements() <= skipIt->nRow());
+             CPPUNIT_ASSERT(it->visibility().shape() == skipIt->visibility().shape());
+             casacore::uInt index = 0;
+             for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                  const bool hasData = (index < rows.nelements()) && (rows[index] == row);
+                  if (hasData) {
+                      ++index;
+                      CPPUNIT_ASSERT(casacore::allEQ(it->visibility().yzPlane(row), skipIt->visibility().yzPlane(row)));
+                      CPPUNIT_ASSERT(casacore::allEQ(it->flag().yzPlane(row), skipIt->flag().yzPlane(row)));
+                  } else {
+                      CPPUNIT_ASSERT(casacore::allEQ(skipIt->visibility().yzPlane(row), casacore::Complex(0.)));
+                      CPPUNIT_ASSERT(casacore::allEQ(skipIt->flag().yzPlane(row), casacore::True));
+                      // the normal reader flags these rows too
+                      CPPUNIT_ASSERT(casacore::allEQ(it->flag().yzPlane(row), casacore::True));
+                  }
+             }
+             CPPUNIT_ASSERT_EQUAL(static_cast<casacore::uInt>(rows.nelements()), index);
+        }
+        CPPUNIT_ASSERT(skipIt == skipIt.end());
+   }
+}
+
+/// test of the partitioned iteration
+void TableDataAccessTest::partitionTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   size_t totalRows = 0;
+   for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end();++it) {
+        totalRows += it->nRow();
+   }
+   const casacore::uInt nPartitions = 3;
+   const TableConstDataSource::PartitionType types[] = {TableConstDataSource::FEED_PARTITION,
+         TableConstDataSource::BASELINE_PARTITION, TableConstDataSource::SPECTRAL_WINDOW_PARTITION};
+   for (size_t i = 0; i < 3; ++i) {
+        std::vector<boost::shared_ptr<IConstDataIterator> > iters =
+              ds.createPartitionedIterators(ds.createSelector(), ds.createConverter(), types[i], nPartitions);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(nPartitions), iters.size());
+        size_t partitionedRows = 0;
+        for (casacore::uInt part = 0; part < nPartitions; ++part) {
+             CPPUNIT_ASSERT(iters[part]);
+             for (IConstDataSharedIter it(iters[part]); it != it.end(); ++it) {
+                  partitionedRows += it->nRow();
+                  if (types[i] == TableConstDataSource::FEED_PARTITION) {
+                      for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                           CPPUNIT_ASSERT_EQUAL(part, it->feed1()[row] % nPartitions);
+                      }
+                  }
+             }
+        }
+        // partitions are disjoint and cover the whole dataset
+        CPPUNIT_ASSERT_EQUAL(totalRows, partitionedRows);
+   }
+}
+
+/// @brief test of the parallel processing of partitions with work stealing
+void TableDataAccessTest::parallelDriverTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   size_t totalRows = 0;
+   size_t totalChunks = 0;
+   for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end();++it) {
+        totalRows += it->nRow();
+        ++totalChunks;
+   }
+   // counts rows of the chunks given to each thread
+   struct RowCounter {
+      explicit RowCounter(size_t nThreads) : itsRows(nThreads, 0) {}
+      void operator()(const IConstDataAccessor &acc, size_t thread) {
+         CPPUNIT_ASSERT(thread < itsRows.size());
+         itsRows[thread] += acc.nRow();
+      }
+      size_t total() const {
+         size_t result = 0;
+         for (size_t thread = 0; thread < itsRows.size(); ++thread) {
+              result += itsRows[thread];
+         }
+         return result;
+      }
+      std::vector<size_t> itsRows;
+   };
+   const size_t nThreads = 3;
+   for (int ordered = 0; ordered < 2; ++ordered) {
+        ParallelChunkDriver driver(nThreads, TableConstDataSource::BASELINE_PARTITION, 2);
+        driver.setOrdered(ordered != 0);
+        CPPUNIT_ASSERT_EQUAL(size_t(6), driver.nPartitions());
+        RowCounter counter(nThreads);
+        const size_t nChunks = driver.run(ds, ds.createSelector(), ds.createConverter(), boost::ref(counter));
+        // partitions are disjoint and cover the whole dataset
+        CPPUNIT_ASSERT_EQUAL(totalRows, counter.total());
+        CPPUNIT_ASSERT(nChunks >= totalChunks);
+        if (ordered != 0) {
+            CPPUNIT_ASSERT_EQUAL(size_t(0), driver.nSteals());
+        }
+   }
+   RowCounter counter(1);
+   parallelForEachChunk(ds, ds.createSelector(), ds.createConverter(), boost::ref(counter), 1);
+   CPPUNIT_ASSERT_EQUAL(totalRows, counter.total());
+   // an exception thrown by the functor is passed to the caller
+   struct FailingFunctor {
+      void operator()(const IConstDataAccessor &, size_t) const {
+         ASKAPTHROW(AskapError, "Test exception");
+      }
+   };
+   ParallelChunkDriver driver(nThreads);
+   CPPUNIT_ASSERT_THROW(driver.run(ds, ds.createSelector(), ds.createConverter(), FailingFunctor()),
+                        DataAccessError);
+}
+
+/// test of the split of the spectral axis
+void TableDataAccessTest::channelTilingTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   TableConstDataSource tiledDS(TableTestRunner::msName());
+   const casacore::uInt maxChannels = 5;
+   tiledDS.configureMaxChannels(maxChannels);
+   IConstDataSharedIter tiledIt = tiledDS.createConstIterator();
+   for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+        // all tiles of this chunk should follow in order
+        for (casacore::uInt startChan = 0; startChan < it->nChannel(); ++tiledIt) {
+             CPPUNIT_ASSERT(tiledIt != tiledIt.end());
+             CPPUNIT_ASSERT_EQUAL(it->nRow(), tiledIt->nRow());
+             CPPUNIT_ASSERT_EQUAL(it->nPol(), tiledIt->nPol());
+             const casacore::uInt nChan = tiledIt->nChannel();
+             CPPUNIT_ASSERT(nChan > 0);
+             CPPUNIT_ASSERT(nChan <= maxChannels);
+             CPPUNIT_ASSERT(startChan + nChan <= it->nChannel());
+             CPPUNIT_ASSERT(casacore::allEQ(it->antenna1(), tiledIt->antenna1()));
+             CPPUNIT_ASSERT(casacore::allEQ(it->antenna2(), tiledIt->antenna2()));
+             CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(nChan), tiledIt->frequency().nelements());
+             for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL(it->frequency()[startChan + chan], 
+                                               tiledIt->frequency()[chan], 1e-6);
+                  for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                       for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+                            CPPUNIT_ASSERT(it->visibility()(row, startChan + chan, pol) ==
+                                           tiledIt->visibility()(row, chan, pol));
+                            CPPUNIT_ASSERT(it->flag()(row, startChan + chan, pol) ==
+                                           tiledIt->flag()(row, chan, pol));
+                            CPPUNIT_ASSERT(it->noise()(row, startChan + chan, pol) ==
+                                           tiledIt->noise()(row, chan, pol));
+                       }
+                  }
+             }
+             startChan += nChan;
+        }
+   }
+   CPPUNIT_ASSERT(tiledIt == tiledIt.end());
+}
+
+/// test of the memory-mapped access
+void TableDataAccessTest::memoryMappedTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   TableConstDataSource mmapDS(TableTestRunner::msName(), "DATA", true);
+   mmapDS.configureNativeLayout();
+   IConstDataSharedIter mmapIt = mmapDS.createConstIterator();
+   for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++mmapIt) {
+        CPPUNIT_ASSERT(mmapIt != mmapIt.end());
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), mmapIt->nRow());
+        CPPUNIT_ASSERT(it->visibility().shape() == mmapIt->visibility().shape());
+        CPPUNIT_ASSERT(casacore::allEQ(it->visibility(), mmapIt->visibility()));
+        CPPUNIT_ASSERT(casacore::allEQ(it->flag(), mmapIt->flag()));
+   }
+   CPPUNIT_ASSERT(mmapIt == mmapIt.end());
+}
+
+/// test of the in-memory cache for multiple passes
+void TableDataAccessTest::cachingTest()
+{
+   boost::shared_ptr<TableConstDataSource> ds(new TableConstDataSource(TableTestRunner::msName()));
+   ds->configureMaxChunkSize(50);
+   size_t nChunks = 0;
+   for (IConstDataSharedIter it = ds->createConstIterator(); it != it.end(); ++it) {
+        ++nChunks;
+   }
+   // the first limit is too small to cache anything, the last one is big enough for everything
+   const size_t limits[] = {0, 100000, 1000000000};
+   for (size_t i = 0; i < 3; ++i) {
+        CachingDataSource cds(ds, limits[i]);
+        boost::shared_ptr<CachingDataIterator> cachingIt = 
+              boost::dynamic_pointer_cast<CachingDataIterator>(cds.createConstIterator());
+        CPPUNIT_ASSERT(cachingIt);
+        for (int pass = 0; pass < 3; ++pass) {
+             cachingIt->init();
+             IConstDataSharedIter it = ds->createConstIterator();
+             size_t counter = 0;
+             for (; it != it.end(); ++it, cachingIt->next(), ++counter) {
+                  CPPUNIT_ASSERT(cachingIt->hasMore());
+                  const IConstDataAccessor &acc = **cachingIt;
+                  CPPUNIT_ASSERT_EQUAL(it->nRow(), acc.nRow());
+                  CPPUNIT_ASSERT(casacore::allEQ(it->visibility(), acc.visibility()));
+                  CPPUNIT_ASSERT(casacore::allEQ(it->flag(), acc.flag()));
+                  CPPUNIT_ASSERT(casacore::allEQ(it->noise(), acc.noise()));
+                  CPPUNIT_ASSERT(casacore::allEQ(it->antenna1(), acc.antenna1()));
+                  CPPUNIT_ASSERT(casacore::allEQ(it->frequency(), acc.frequency()));
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL(it->time(), acc.time(), 1e-6);
+                  for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                            CPPUNIT_ASSERT_DOUBLES_EQUAL(it->uvw()(row)(dim), acc.uvw()(row)(dim), 1e-9);
+                       }
+                       CPPUNIT_ASSERT(it->pointingDir1()(row).separation(acc.pointingDir1()(row)) < 1e-9);
+                  }
+             }
+             CPPUNIT_ASSERT_EQUAL(nChunks, counter);
+             CPPUNIT_ASSERT(!cachingIt->hasMore());
+        }
+        if (i == 0) {
+            CPPUNIT_ASSERT_EQUAL(size_t(0), cachingIt->nCachedChunks());
+        }
+        if (i == 2) {
+            CPPUNIT_ASSERT_EQUAL(nChunks, cachingIt->nCachedChunks());
+        }
+   }
+}
+
+/// test of the declaration of required fields
+void TableDataAccessTest::requiredFieldsTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   TableConstDataSource prefetchDS(TableTestRunner::msName());
+   prefetchDS.configurePrefetch();
+   prefetchDS.configureMaxChunkSize(50);
+   ds.configureMaxChunkSize(50);
+   IDataSelectorPtr sel = prefetchDS.createSelector();
+   boost::shared_ptr<ITableDataSelectorImpl> implSel = boost::dynamic_pointer_cast<ITableDataSelectorImpl>(sel);
+   CPPUNIT_ASSERT(implSel);
+   CPPUNIT_ASSERT_EQUAL(int(ITableDataSelectorImpl::ALL_FIELDS), implSel->requiredFields());
+   implSel->chooseRequiredFields(ITableDataSelectorImpl::FLAG_FIELD | ITableDataSelectorImpl::UVW_FIELD);
+   CPPUNIT_ASSERT_EQUAL(int(ITableDataSelectorImpl::FLAG_FIELD | ITableDataSelectorImpl::UVW_FIELD), 
+                        implSel->requiredFields());
+   IConstDataSharedIter prefetchIt = prefetchDS.createConstIterator(sel);
+   for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++prefetchIt) {
+        CPPUNIT_ASSERT(prefetchIt != prefetchIt.end());
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), prefetchIt->nRow());
+        CPPUNIT_ASSERT(casacore::allEQ(it->flag(), prefetchIt->flag()));
+        for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+             for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL(it->uvw()(row)(dim), prefetchIt->uvw()(row)(dim), 1e-9);
+             }
+        }
+        // undeclared fields are still available
+        CPPUNIT_ASSERT(casacore::allEQ(it->visibility(), prefetchIt->visibility()));
+        for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+             CPPUNIT_ASSERT(it->pointingDir1()(row).separation(prefetchIt->pointingDir1()(row)) < 1e-9);
+        }
+   }
+   CPPUNIT_ASSERT(prefetchIt == prefetchIt.end());
+}
+
+/// test of the deferred write of modified chunks
+void TableDataAccessTest::writeBehindTest()
+{
+   TableDataSource ds(TableTestRunner::msName(), TableDataSource::WRITE_PERMITTED);
+   ds.configureMaxChunkSize(50);
+   ds.configureWriteBehind(3);
+   boost::shared_ptr<TableDataIterator> it = boost::dynamic_pointer_cast<TableDataIterator>(
+               ds.createIterator(ds.createSelector(), ds.createConverter()));
+   CPPUNIT_ASSERT(it);
+   std::vector<casacore::Cube<casacore::Complex> > original;
+   for (it->init(); it->hasMore(); it->next()) {
+        original.push_back((**it).visibility().copy());
+        (**it).rwVisibility().set(casacore::Complex(float(original.size()), -1.));
+   }
+   // the barrier, all chunks should be in the table afterwards
+   it->sync();
+   size_t counter = 0;
+   for (IConstDataSharedIter cit = ds.createConstIterator(); cit != cit.end(); ++cit) {
+        CPPUNIT_ASSERT(counter < original.size());
+        ++counter;
+        CPPUNIT_ASSERT(casacore::allNear(cit->visibility(), casacore::Complex(float(counter), -1.), 1e-7));
+   }
+   CPPUNIT_ASSERT_EQUAL(original.size(), counter);
+   // restore the original visibilities, the iterator writes the rest when destroyed
+   counter = 0;
+   for (it->init(); it->hasMore(); it->next(), ++counter) {
+        (**it).rwVisibility() = original[counter];
+   }
+   it.reset();
+   counter = 0;
+   for (IConstDataSharedIter cit = ds.createConstIterator(); cit != cit.end(); ++cit, ++counter) {
+        CPPUNIT_ASSERT(casacore::allNear(cit->visibility(), original[counter], 1e-7));
+   }
+}
+
+/// test of the partial write-back of modified regions
+void TableDataAccessTest::dirtyRegionTest()
+{
+   TableDataSource tds(TableTestRunner::msName(), TableDataSource::WRITE_PERMITTED);
+   IDataSource &ds=tds; // to have all interface methods available without
+                        // ambiguity (otherwise methods overridden in 
+                        // TableDataSource would get a priority)
+   std::vector<casacore::Cube<casacore::Complex> > original;
+   for (IDataSharedIter it=ds.createIterator(); it!=it.end(); ++it) {
+        original.push_back(it->visibility().copy());
+        // the whole cube is changed in memory, but only a part is declared as modified
+        it->rwVisibility().set(casacore::Complex(-1.,2.));
+        IDirtyRegionDataAccessor &acc = dynamic_cast<IDirtyRegionDataAccessor&>(*it);
+        acc.markVisibilityDirty(1, 1, 2, 3);
+        acc.markVisibilityDirty(0, 1, 3, 1);
+        const DirtyRegion &region = acc.visibilityDirtyRegion();
+        CPPUNIT_ASSERT(!region.empty());
+        CPPUNIT_ASSERT_EQUAL(0u, region.startRow());
+        CPPUNIT_ASSERT_EQUAL(2u, region.nRow());
+        CPPUNIT_ASSERT_EQUAL(2u, region.startChannel());
+        CPPUNIT_ASSERT_EQUAL(3u, region.nChannel());
+        CPPUNIT_ASSERT_THROW(acc.markVisibilityDirty(it->nRow(), 1, 0, 1), AskapError);
+   }
+   size_t counter = 0;
+   for (IConstDataSharedIter cit = ds.createConstIterator(); cit != cit.end(); ++cit, ++counter) {
+        CPPUNIT_ASSERT(counter < original.size());
+        const casacore::Cube<casacore::Complex> &vis = cit->visibility();
+        for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+             for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+                  const bool modified = (row < 2) && (chan >= 2) && (chan < 5);
+                  for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                       const casacore::Complex expected = modified ? casacore::Complex(-1.,2.) :
+                                                          original[counter](row,chan,pol);
+                       CPPUNIT_ASSERT(abs(vis(row,chan,pol) - expected) < 1e-7);
+                  }
+             }
+        }
+   }
+   CPPUNIT_ASSERT_EQUAL(original.size(), counter);
+   // set visibilities back to the original values
+   counter = 0;
+   for (IDataSharedIter it=ds.createIterator(); it!=it.end(); ++it, ++counter) {
+        it->rwVisibility() = original[counter];
+   }
+}
+
+void TableDataAccessTest::hybridBufferTest()
+{
+  // the limit is enough for the cubes written by doBufferTest, but not for more
+  itsTableInfoAccessor.reset(new TableInfoAccessor(
+            casacore::Table(TableTestRunner::msName()), SubtableInfoHolder::HYBRID_BUFFERS,
+            "DATA", 1000));
+  doBufferTest();
+  // buffer managers are wrapped into the compression adapter
+  const CompressingBufferManager *adapter = dynamic_cast<const CompressingBufferManager*>(
+            &(itsTableInfoAccessor->subtableInfo().getBufferManager()));
+  CPPUNIT_ASSERT(adapter != 0);
+  const HybridBufferManager *bufferMgr = dynamic_cast<const HybridBufferManager*>(
+            &(adapter->store()));
+  CPPUNIT_ASSERT(bufferMgr != 0);
+  CPPUNIT_ASSERT_EQUAL(size_t(2), bufferMgr->nHits());
+  CPPUNIT_ASSERT_EQUAL(size_t(0), bufferMgr->nMisses());
+  for (casacore::uInt index = 0; index < 2; ++index) {
+       casacore::Cube<casacore::Complex> vis(5,10,2,casacore::Complex(float(index),1.));
+       bufferMgr->writeBuffer(vis,"TEST2",index);
+  }
+  bufferMgr->flush();
+  CPPUNIT_ASSERT(bufferMgr->memoryUsed() <= 1000u);
+  // the most recent cube is still in memory
+  casacore::Cube<casacore::Complex> vis;
+  bufferMgr->readBuffer(vis,"TEST2",1);
+  CPPUNIT_ASSERT(casacore::allEQ(vis, casacore::Complex(1.,1.)));
+  CPPUNIT_ASSERT_EQUAL(size_t(3), bufferMgr->nHits());
+  CPPUNIT_ASSERT_EQUAL(size_t(0), bufferMgr->nMisses());
+  // cubes of the first buffer have been spilled
+  CPPUNIT_ASSERT(bufferMgr->bufferExists("TEST",5));
+  bufferMgr->readBuffer(vis,"TEST",5);
+  CPPUNIT_ASSERT(vis.shape() == casacore::IPosition(3,5,10,2));
+  CPPUNIT_ASSERT(casacore::allEQ(vis, casacore::Complex(1.,-0.5)));
+  CPPUNIT_ASSERT_EQUAL(size_t(3), bufferMgr->nHits());
+  CPPUNIT_ASSERT_EQUAL(size_t(1), bufferMgr->nMisses());
+}
+
+void TableDataAccessTest::rotatedUVWStoreTest()
+{
+  const casacore::MDirection testDir(casacore::MVDirection(0.12345,-0.12345), casacore::MDirection::J2000);
+  const casacore::MDirection testDir2(casacore::MVDirection(-0.12345,0.12345), casacore::MDirection::J2000);
+  const size_t maxIter = 4;
+  // reference results from the iterator without the store
+  std::vector<casacore::Vector<casacore::RigidVector<casacore::Double, 3> > > refUVW;
+  std::vector<casacore::Vector<casacore::Double> > refDelays;
+  TableConstDataSource ds(TableTestRunner::msName());
+  for (IConstDataSharedIter it=ds.createConstIterator(); (it!=it.end()) && (refUVW.size()<maxIter); ++it) {
+       refUVW.push_back(it->rotatedUVW(testDir).copy());
+       refDelays.push_back(it->uvwRotationDelay(testDir,testDir2).copy());
+  }
+  CPPUNIT_ASSERT_EQUAL(maxIter, refUVW.size());
+  ds.configureRotatedUVWStore();
+  for (size_t pass = 0; pass < 3; ++pass) {
+       IConstDataSharedIter it=ds.createConstIterator();
+       for (size_t iter = 0; iter < maxIter; ++iter, ++it) {
+            CPPUNIT_ASSERT(it != it.end());
+            const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = 
+                     it->rotatedUVW(testDir);
+            const casacore::Vector<casacore::Double> &delays = it->uvwRotationDelay(testDir,testDir2);
+            CPPUNIT_ASSERT_EQUAL(refUVW[iter].nelements(), uvw.nelements());
+            CPPUNIT_ASSERT_EQUAL(refDelays[iter].nelements(), delays.nelements());
+            for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+                 for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                      CPPUNIT_ASSERT_DOUBLES_EQUAL(refUVW[iter][row](dim), uvw[row](dim), 1e-6);
+                 }
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(refDelays[iter][row], delays[row], 1e-6);
+            }
+       }
+       boost::shared_ptr<TableConstDataIterator> actualIt = it.dynamicCast<TableConstDataIterator>();
+       CPPUNIT_ASSERT(actualIt);
+       const RotatedUVWStore *store = actualIt->rotatedUVWStore();
+       CPPUNIT_ASSERT(store != NULL);
+       // the first pass fills the store, the following ones are served from it
+       CPPUNIT_ASSERT_EQUAL(maxIter, store->nMisses());
+       CPPUNIT_ASSERT_EQUAL(maxIter * pass, store->nHits());
+  }
+}
+
+void TableDataAccessTest::facetRotatedUVWTest()
+{
+  std::vector<casacore::MDirection> tangents;
+  tangents.push_back(casacore::MDirection(casacore::MVDirection(0.12345,-0.12345), casacore::MDirection::J2000));
+  tangents.push_back(casacore::MDirection(casacore::MVDirection(-0.12345,0.12345), casacore::MDirection::J2000));
+  tangents.push_back(casacore::MDirection(casacore::MVDirection(0.2,-0.1), casacore::MDirection::J2000));
+  TableConstDataSource ds(TableTestRunner::msName());
+  size_t counter = 0;
+  for (IConstDataSharedIter it=ds.createConstIterator(); (it!=it.end()) && (counter < 4); ++it, ++counter) {
+       const IFacetUVWDataAccessor *acc = dynamic_cast<const IFacetUVWDataAccessor*>(&(*it));
+       CPPUNIT_ASSERT(acc != NULL);
+       const FacetRotatedUVW &result = acc->facetRotatedUVW(tangents);
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(tangents.size()), result.nFacets());
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), result.nRow());
+       // the batched result survives single tangent point calls
+       for (casacore::uInt facet = 0; facet < result.nFacets(); ++facet) {
+            const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = it->rotatedUVW(tangents[facet]);
+            const casacore::Vector<casacore::Double> &delays = it->uvwRotationDelay(tangents[facet], tangents[facet]);
+            for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                 for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                      CPPUNIT_ASSERT_DOUBLES_EQUAL(uvw[row](dim), result.uvw(facet, row)(dim), 1e-6);
+                      CPPUNIT_ASSERT_DOUBLES_EQUAL(uvw[row](dim), result.uvw(facet)[row](dim), 1e-6);
+                 }
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(delays[row], result.delay(facet, row), 1e-6);
+            }
+       }
+       // the same tangent points are served from the cache
+       CPPUNIT_ASSERT(&result == &acc->facetRotatedUVW(tangents));
+       // the generic implementation gives the same result
+       FacetRotatedUVW generic;
+       generic.fill(*it, tangents);
+       CPPUNIT_ASSERT_EQUAL(result.nRow(), generic.nRow());
+       for (casacore::uInt facet = 0; facet < result.nFacets(); ++facet) {
+            for (casacore::uInt row = 0; row < result.nRow(); ++row) {
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(generic.uvw(facet, row)(2), result.uvw(facet, row)(2), 1e-6);
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(generic.delay(facet, row), result.delay(facet, row), 1e-6);
+            }
+       }
+       CPPUNIT_ASSERT(&facetRotatedUVW(*it, tangents, generic) == &result);
+  }
+  CPPUNIT_ASSERT_EQUAL(size_t(4), counter);
+}
+
+void TableDataAccessTest::parallacticAngleTest()
+{
+  itsTableInfoAccessor.reset(new TableInfoAccessor(
+              casacore::Table(TableTestRunner::msName()),false));
+  const IAntennaSubtableHandler &antennaSubtable=itsTableInfoAccessor->
+                      subtableInfo().getAntenna();
+  const casacore::MDirection dir(casacore::MVDirection(1.2345,-0.765), casacore::MDirection::J2000);
+  ParallacticAngleEngine exactEngine(antennaSubtable);
+  ParallacticAngleEngine interpolatingEngine(antennaSubtable, 60.);
+  casacore::Vector<casacore::Double> angles, interpolatedAngles;
+  for (casacore::uInt step = 0; step < 5; ++step) {
+       const casacore::MEpoch epoch(casacore::MVEpoch(55000.25 + step * 10. / 86400.), 
+                                casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+       exactEngine.compute(epoch, dir, angles);
+       interpolatingEngine.compute(epoch, dir, interpolatedAngles);
+       CPPUNIT_ASSERT_EQUAL(antennaSubtable.getNumberOfAntennae(), casacore::uInt(angles.nelements()));
+       CPPUNIT_ASSERT_EQUAL(angles.nelements(), interpolatedAngles.nelements());
+       for (casacore::uInt ant = 0; ant < angles.nelements(); ++ant) {
+            // the straightforward calculation via the AZEL frame
+            const casacore::MeasFrame frame(antennaSubtable.getPosition(ant), epoch);
+            const casacore::MDirection::Ref azel(casacore::MDirection::AZEL, frame);
+            const casacore::MDirection celestialPole(casacore::MVDirection(0., casacore::C::pi_2),
+                     casacore::MDirection::HADEC);
+            const casacore::Double refAngle = casacore::MDirection::Convert(dir, azel)().getValue().
+                     positionAngle(casacore::MDirection::Convert(celestialPole, azel)().getValue());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(refAngle, angles[ant], 1e-6);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(refAngle, interpolatedAngles[ant], 1e-5);
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(size_t(5), exactEngine.nConversions());
+  CPPUNIT_ASSERT_EQUAL(size_t(1), interpolatingEngine.nConversions());
+}
+
+void TableDataAccessTest::setUpRowIndexSelection(const IDataSelectorPtr &sel, int selection, 
+                                                 casacore::Double startTime)
+{
+  switch (selection) {
+     case 0: 
+          sel->chooseFeed(0);
+          sel->chooseTimeRange(startTime - 1., startTime + 100.);
+          break;
+     case 1:
+          sel->chooseBaseline(0, 1);
+          break;
+     case 2:
+          sel->chooseSpectralWindow(0);
+          sel->chooseCrossCorrelations();
+          break;
+     case 3:
+          sel->chooseAntenna(2);
+          sel->chooseAutoCorrelations();
+          break;
+     case 4:
+          // uv-distances are held by the index, all rows are filtered at once
+          sel->chooseMinUVDistance(1000.);
+          sel->chooseMaxUVDistance(3000.);
+          break;
+     case 5:
+          {
+            boost::shared_ptr<ITableDataSelectorImpl> implSel = 
+                   boost::dynamic_pointer_cast<ITableDataSelectorImpl>(sel);
+            CPPUNIT_ASSERT(implSel);
+            std::vector<std::pair<casacore::uInt, casacore::uInt> > baselines;
+            baselines.push_back(std::make_pair(0u, 1u));
+            baselines.push_back(std::make_pair(1u, 2u));
+            implSel->chooseBaselines(baselines);
+            implSel->chooseAntennas(std::vector<casacore::uInt>(1, 1u));
+          }
+          break;
+     default:
+          // not resolvable via the index, the expression should be used
+          sel->chooseFeed(0);
+          sel->chooseUserDefinedIndex("SCAN_NUMBER", 0);
+  };
+}
+
+void TableDataAccessTest::rowIndexTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  IConstDataSharedIter firstIt = ds.createConstIterator();
+  CPPUNIT_ASSERT(firstIt != firstIt.end());
+  const casacore::Double startTime = firstIt->time();
+  TableConstDataSource indexedDS(TableTestRunner::msName());
+  indexedDS.configureRowIndex();
+  for (int selection = 0; selection < 7; ++selection) {
+       IDataSelectorPtr sel = ds.createSelector();
+       setUpRowIndexSelection(sel, selection, startTime);
+       IDataSelectorPtr indexedSel = indexedDS.createSelector();
+       setUpRowIndexSelection(indexedSel, selection, startTime);
+       IConstDataSharedIter it = ds.createConstIterator(sel);
+       size_t nRows = 0;
+       for (IConstDataSharedIter indexedIt = indexedDS.createConstIterator(indexedSel); 
+            indexedIt != indexedIt.end(); ++indexedIt, ++it) {
+            CPPUNIT_ASSERT(it != it.end());
+            CPPUNIT_ASSERT_EQUAL(it->nRow(), indexedIt->nRow());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(it->time(), indexedIt->time(), 1e-6);
+            for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                 CPPUNIT_ASSERT_EQUAL(it->antenna1()[row], indexedIt->antenna1()[row]);
+                 CPPUNIT_ASSERT_EQUAL(it->antenna2()[row], indexedIt->antenna2()[row]);
+                 CPPUNIT_ASSERT_EQUAL(it->feed1()[row], indexedIt->feed1()[row]);
+                 CPPUNIT_ASSERT_EQUAL(it->feed2()[row], indexedIt->feed2()[row]);
+            }
+            nRows += it->nRow();
+       }
+       CPPUNIT_ASSERT(it == it.end());
+       if ((selection < 3) || (selection == 5)) {
+           // the test dataset has data for all these selections
+           CPPUNIT_ASSERT(nRows > 0);
+       }
+  }
+  // the set of baselines selects the same rows as individual baselines together
+  for (int pass = 0; pass < 2; ++pass) {
+       TableConstDataSource &src = pass ? indexedDS : ds;
+       IDataSelectorPtr setSel = src.createSelector();
+       std::vector<std::pair<casacore::uInt, casacore::uInt> > baselines;
+       baselines.push_back(std::make_pair(0u, 1u));
+       baselines.push_back(std::make_pair(1u, 2u));
+       // antenna 100 doesn't exist
+       baselines.push_back(std::make_pair(0u, 100u));
+       boost::dynamic_pointer_cast<ITableDataSelectorImpl>(setSel)->chooseBaselines(baselines);
+       size_t nSetRows = 0;
+       for (IConstDataSharedIter it = src.createConstIterator(setSel); it != it.end(); ++it) {
+            for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                 const std::pair<casacore::uInt, casacore::uInt> baseline(it->antenna1()[row], 
+                                                                          it->antenna2()[row]);
+                 CPPUNIT_ASSERT(std::find(baselines.begin(), baselines.end(), baseline) != baselines.end());
+            }
+            nSetRows += it->nRow();
+       }
+       size_t nSeparateRows = 0;
+       for (size_t index = 0; index < 2; ++index) {
+            IDataSelectorPtr sel = src.createSelector();
+            sel->chooseBaseline(baselines[index].first, baselines[index].second);
+            for (IConstDataSharedIter it = src.createConstIterator(sel); it != it.end(); ++it) {
+                 nSeparateRows += it->nRow();
+            }
+       }
+       CPPUNIT_ASSERT(nSetRows > 0);
+       CPPUNIT_ASSERT_EQUAL(nSeparateRows, nSetRows);
+       // an empty set selects nothing
+       IDataSelectorPtr emptySel = src.createSelector();
+       boost::dynamic_pointer_cast<ITableDataSelectorImpl>(emptySel)->chooseAntennas(
+                 std::vector<casacore::uInt>());
+       IConstDataSharedIter emptyIt = src.createConstIterator(emptySel);
+       CPPUNIT_ASSERT(emptyIt == emptyIt.end());
+  }
+  // the index is built for the whole dataset
+  itsTableInfoAccessor.reset(new TableInfoAccessor(
+              casacore::Table(TableTestRunner::msName()),false));
+  MainTableRowIndex::Criteria criteria;
+  criteria.chooseBaseline(0, 1);
+  const MainTableRowIndex &index = itsTableInfoAccessor->subtableInfo().getRowIndex();
+  CPPUNIT_ASSERT_EQUAL(itsTableInfoAccessor->table().nrow(), index.nrow());
+  casacore::Vector<casacore::uInt> rows;
+  index.select(criteria, rows);
+  CPPUNIT_ASSERT(rows.nelements() > 0);
+  criteria.disable();
+  CPPUNIT_ASSERT(!criteria.usable());
+}
+
+void TableDataAccessTest::timeRangeSelectionTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  std::vector<casacore::Double> times;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+       if (times.empty() || (times.back() != it->time())) {
+           times.push_back(it->time());
+       }
+  }
+  CPPUNIT_ASSERT(times.size() > 3);
+  // time range selection alone is resolved via the binary search, the uv-distance
+  // selection which doesn't reject anything forces the table expression
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseTimeRange(times[1] - 0.1, times[2] + 0.1);
+  IDataSelectorPtr exprSel = ds.createSelector();
+  exprSel->chooseTimeRange(times[1] - 0.1, times[2] + 0.1);
+  exprSel->chooseMinUVDistance(0.);
+  IConstDataSharedIter exprIt = ds.createConstIterator(exprSel);
+  size_t nRows = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it, ++exprIt) {
+       CPPUNIT_ASSERT(exprIt != exprIt.end());
+       CPPUNIT_ASSERT_EQUAL(exprIt->nRow(), it->nRow());
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(exprIt->time(), it->time(), 1e-6);
+       CPPUNIT_ASSERT(it->time() > times[1] - 0.1);
+       CPPUNIT_ASSERT(it->time() < times[2] + 0.1);
+       nRows += it->nRow();
+  }
+  CPPUNIT_ASSERT(exprIt == exprIt.end());
+  CPPUNIT_ASSERT(nRows > 0);
+  // cycles are counted from zero and both ends are included
+  sel = ds.createSelector();
+  sel->chooseCycles(1, 2);
+  std::vector<casacore::Double> selectedTimes;
+  for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it) {
+       if (selectedTimes.empty() || (selectedTimes.back() != it->time())) {
+           selectedTimes.push_back(it->time());
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(size_t(2), selectedTimes.size());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(times[1], selectedTimes[0], 1e-6);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(times[2], selectedTimes[1], 1e-6);
+}
+
+/// @brief test of the round trip of chunks through a blob stream
+void TableDataAccessTest::serialisationTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataConverterPtr conv = ds.createConverter();
+  conv->setEpochFrame(); // ensures seconds since 0 MJD
+  size_t counter = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end(); ++it, ++counter) {
+       LOFAR::BlobString bs;
+       bs.resize(0);
+       LOFAR::BlobOBufString bob(bs);
+       LOFAR::BlobOStream out(bob);
+       CachedDataAccessor::serialise(*it, out);
+       LOFAR::BlobIBufString bib(bs);
+       LOFAR::BlobIStream in(bib);
+       const CachedDataAccessor acc(in);
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), acc.nRow());
+       CPPUNIT_ASSERT_EQUAL(it->nChannel(), acc.nChannel());
+       CPPUNIT_ASSERT_EQUAL(it->nPol(), acc.nPol());
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(it->time(), acc.time(), 1e-9);
+       CPPUNIT_ASSERT(casacore::allEQ(it->antenna1(), acc.antenna1()));
+       CPPUNIT_ASSERT(casacore::allEQ(it->antenna2(), acc.antenna2()));
+       CPPUNIT_ASSERT(casacore::allEQ(it->feed1(), acc.feed1()));
+       CPPUNIT_ASSERT(casacore::allEQ(it->feed2(), acc.feed2()));
+       CPPUNIT_ASSERT(casacore::allEQ(it->feed1PA(), acc.feed1PA()));
+       CPPUNIT_ASSERT(casacore::allEQ(it->frequency(), acc.frequency()));
+       CPPUNIT_ASSERT(casacore::allEQ(it->visibility(), acc.visibility()));
+       CPPUNIT_ASSERT(casacore::allEQ(it->flag(), acc.flag()));
+       CPPUNIT_ASSERT(casacore::allEQ(it->noise(), acc.noise()));
+       CPPUNIT_ASSERT_EQUAL(it->stokes().nelements(), acc.stokes().nelements());
+       for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+            CPPUNIT_ASSERT_EQUAL(it->stokes()[pol], acc.stokes()[pol]);
+       }
+       for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+            CPPUNIT_ASSERT(it->pointingDir1()[row].separation(acc.pointingDir1()[row]) < 1e-12);
+            CPPUNIT_ASSERT(it->dishPointing2()[row].separation(acc.dishPointing2()[row]) < 1e-12);
+            for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(it->uvw()[row](dim), acc.uvw()[row](dim), 1e-12);
+            }
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(size_t(420), counter);
+}
+
+/// @brief test of the I/O and cache statistics
+void TableDataAccessTest::statisticsTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT(!ds.statistics());
+  ds.configureStatistics();
+  const boost::shared_ptr<IteratorStatistics> stats = ds.statistics();
+  CPPUNIT_ASSERT(stats);
+  casacore::uInt64 nRows = 0;
+  casacore::uInt64 visBytes = 0;
+  size_t counter = 0;
+  IConstDataSharedIter it = ds.createConstIterator();
+  const boost::shared_ptr<TableConstDataIterator> tableIt = it.dynamicCast<TableConstDataIterator>();
+  CPPUNIT_ASSERT(tableIt);
+  CPPUNIT_ASSERT(tableIt->statistics() == stats);
+  for (; it != it.end(); ++it, ++counter) {
+       nRows += it->nRow();
+       visBytes += it->visibility().nelements() * sizeof(casacore::Complex);
+       // the second access should be served from the cache
+       it->visibility();
+       it->uvw();
+       it->pointingDir1();
+  }
+  CPPUNIT_ASSERT_EQUAL(size_t(420), counter);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt64(counter), stats->nChunks());
+  CPPUNIT_ASSERT_EQUAL(nRows, stats->nRows());
+  CPPUNIT_ASSERT_EQUAL(visBytes, stats->bytesRead("DATA"));
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt64(3 * sizeof(casacore::Double) * nRows), stats->bytesRead("UVW"));
+  CPPUNIT_ASSERT(stats->nCacheHits() >= casacore::uInt64(counter));
+  CPPUNIT_ASSERT(stats->nCacheFills() >= 3 * casacore::uInt64(counter));
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt64(counter), stats->nCalls(IteratorStatistics::FILL_UVW));
+  CPPUNIT_ASSERT(stats->nCalls(IteratorStatistics::FILL_DIRECTION) > 0);
+  stats->log();
+  // reconfiguration starts from scratch, iterators created before keep the old object
+  ds.configureStatistics();
+  CPPUNIT_ASSERT(ds.statistics());
+  CPPUNIT_ASSERT(ds.statistics() != stats);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), ds.statistics()->nChunks());
+  ds.configureStatistics(false);
+  CPPUNIT_ASSERT(!ds.statistics());
+}
+
+/// @brief test of the quality control statistics accumulated during read
+void TableDataAccessTest::qcStatisticsTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT(!ds.qcStatistics());
+  ds.configureQCStatistics();
+  const boost::shared_ptr<QCStatistics> stats = ds.qcStatistics();
+  CPPUNIT_ASSERT(stats);
+  casacore::uInt64 nSamples = 0;
+  casacore::uInt64 nFlagged = 0;
+  casacore::uInt nChan = 0;
+  size_t counter = 0;
+  IConstDataSharedIter it = ds.createConstIterator();
+  const boost::shared_ptr<TableConstDataIterator> tableIt = it.dynamicCast<TableConstDataIterator>();
+  CPPUNIT_ASSERT(tableIt);
+  CPPUNIT_ASSERT(tableIt->qcStatistics() == stats);
+  for (; it != it.end(); ++it, ++counter) {
+       nSamples += it->visibility().nelements();
+       nFlagged += casacore::ntrue(it->flag());
+       nChan = it->nChannel();
+       // the second access is served from the cache and shouldn't be counted again
+       it->visibility();
+  }
+  CPPUNIT_ASSERT_EQUAL(size_t(420), counter);
+  const QCStatistics::Accumulator total = stats->total();
+  CPPUNIT_ASSERT_EQUAL(nSamples, casacore::uInt64(total.itsNSamples));
+  CPPUNIT_ASSERT_EQUAL(nFlagged, casacore::uInt64(total.itsNFlagged));
+  CPPUNIT_ASSERT_EQUAL(size_t(nChan), stats->channels().size());
+  CPPUNIT_ASSERT(stats->baselines().size() > 0);
+  CPPUNIT_ASSERT(total.flagFraction() >= 0. && total.flagFraction() <= 1.);
+  CPPUNIT_ASSERT(total.rms() >= 0.);
+  // per-channel statistics add up to the total
+  casacore::uInt64 nChanSamples = 0;
+  const std::vector<casacore::uInt> channels = stats->channels();
+  for (size_t i = 0; i < channels.size(); ++i) {
+       nChanSamples += stats->channel(channels[i]).itsNSamples;
+  }
+  CPPUNIT_ASSERT_EQUAL(nSamples, nChanSamples);
+  stats->log();
+  // round trip through a blob, merging doubles the counts
+  LOFAR::BlobString bs;
+  bs.resize(0);
+  LOFAR::BlobOBufString bob(bs);
+  LOFAR::BlobOStream out(bob);
+  stats->serialise(out);
+  LOFAR::BlobIBufString bib(bs);
+  LOFAR::BlobIStream in(bib);
+  QCStatistics merged;
+  merged.merge(*stats);
+  merged.merge(in);
+  CPPUNIT_ASSERT_EQUAL(2 * nSamples, casacore::uInt64(merged.total().itsNSamples));
+  CPPUNIT_ASSERT_EQUAL(2 * nFlagged, casacore::uInt64(merged.total().itsNFlagged));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(total.mean(), merged.total().mean(), 1e-6);
+  ds.configureQCStatistics(false);
+  CPPUNIT_ASSERT(!ds.qcStatistics());
+}
+
+/// @brief test that every chunk contributes to the quality control statistics once
+void TableDataAccessTest::qcStatisticsOnceTest()
+{
+  struct MallocAllocator : public IBufferAllocator {
+     virtual void* allocate(size_t nBytes) { return std::malloc(nBytes); }
+     virtual void deallocate(void *ptr, size_t) { std::free(ptr); }
+  };
+  // reference counts, visibilities of every chunk are read once
+  TableConstDataSource refDS(TableTestRunner::msName());
+  refDS.configureMaxChunkSize(50);
+  refDS.configureQCStatistics();
+  casacore::uInt64 nSamples = 0;
+  for (IConstDataSharedIter it = refDS.createConstIterator(); it != it.end(); ++it) {
+       nSamples += it->visibility().nelements();
+  }
+  CPPUNIT_ASSERT(nSamples > 0);
+  const QCStatistics::Accumulator refTotal = refDS.qcStatistics()->total();
+  CPPUNIT_ASSERT_EQUAL(nSamples, casacore::uInt64(refTotal.itsNSamples));
+
+  // buffers released between the reads of the same chunk
+  TableConstDataSource ds(TableTestRunner::msName());
+  ds.configureMaxChunkSize(50);
+  ds.configureQCStatistics();
+  ds.configureBufferAllocator(boost::shared_ptr<IBufferAllocator>(new MallocAllocator));
+  IConstDataSharedIter it = ds.createConstIterator();
+  const boost::shared_ptr<TableConstDataIterator> tabIt = it.dynamicCast<TableConstDataIterator>();
+  CPPUNIT_ASSERT(tabIt);
+  for (; it != it.end(); ++it) {
+       it->visibility();
+       tabIt->releaseBuffers();
+       // the chunk is read again, but it has already been counted
+       it->visibility();
+  }
+  CPPUNIT_ASSERT_EQUAL(nSamples, casacore::uInt64(ds.qcStatistics()->total().itsNSamples));
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt64(refTotal.itsNFlagged),
+                       casacore::uInt64(ds.qcStatistics()->total().itsNFlagged));
+
+  // only flags are read, visibilities are obtained when the iterator moves on
+  TableConstDataSource flagDS(TableTestRunner::msName());
+  flagDS.configureMaxChunkSize(50);
+  flagDS.configureQCStatistics();
+  for (IConstDataSharedIter it = flagDS.createConstIterator(); it != it.end(); ++it) {
+       it->flag();
+  }
+  CPPUNIT_ASSERT_EQUAL(nSamples, casacore::uInt64(flagDS.qcStatistics()->total().itsNSamples));
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt64(refTotal.itsNFlagged),
+                       casacore::uInt64(flagDS.qcStatistics()->total().itsNFlagged));
+}
+
+/// @brief test of the random access via the index of chunks
+void TableDataAccessTest::seekTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataConverterPtr conv=ds.createConverter();
+  conv->setEpochFrame(); // ensures seconds since 0 MJD
+  IConstDataSharedIter it = ds.createConstIterator(conv);
+  const boost::shared_ptr<TableConstDataIterator> tableIt = it.dynamicCast<TableConstDataIterator>();
+  CPPUNIT_ASSERT(tableIt);
+  std::vector<casacore::Double> times;
+  std::vector<casacore::uInt> nRows;
+  std::vector<casacore::Complex> firstVis;
+  for (; it != it.end(); ++it) {
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(times.size()), tableIt->currentChunk());
+       times.push_back(it->time());
+       nRows.push_back(it->nRow());
+       firstVis.push_back(it->visibility()(0,0,0));
+  }
+  const casacore::uInt nChunks = tableIt->nChunks();
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(times.size()), nChunks);
+  CPPUNIT_ASSERT_EQUAL(nChunks, tableIt->currentChunk());
+  CPPUNIT_ASSERT(nChunks > 10);
+  // jumps backwards, forwards and within the same time step
+  const casacore::uInt targets[] = {nChunks / 2, 3, 0, nChunks - 1, nChunks / 2 + 1, nChunks / 2 + 1};
+  for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); ++i) {
+       tableIt->seek(targets[i]);
+       CPPUNIT_ASSERT(it.hasMore());
+       CPPUNIT_ASSERT_EQUAL(targets[i], tableIt->currentChunk());
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(times[targets[i]], it->time(), 1e-6);
+       CPPUNIT_ASSERT_EQUAL(nRows[targets[i]], it->nRow());
+       CPPUNIT_ASSERT(std::abs(firstVis[targets[i]] - it->visibility()(0,0,0)) < 1e-7);
+  }
+  // resume from the middle
+  tableIt->seek(nChunks / 2);
+  casacore::uInt counter = 0;
+  for (; it != it.end(); ++it, ++counter) {
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(times[nChunks / 2 + counter], it->time(), 1e-6);
+  }
+  CPPUNIT_ASSERT_EQUAL(nChunks - nChunks / 2, counter);
+  // jumps to the given time
+  CPPUNIT_ASSERT(tableIt->seekTime(times[5]));
+  const casacore::uInt chunk = tableIt->currentChunk();
+  CPPUNIT_ASSERT(chunk <= 5);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(times[5], it->time(), 1e-6);
+  CPPUNIT_ASSERT(tableIt->seekTime(times[0] - 1.));
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), tableIt->currentChunk());
+  CPPUNIT_ASSERT(!tableIt->seekTime(times.back() + 1.));
+  CPPUNIT_ASSERT(!it.hasMore());
+}
+
+/// @brief test of the sidecar snapshot of the subtables
+void TableDataAccessTest::subtableSnapshotTest()
+{
+  const std::string snapshotName = "tsubtables.snapshot";
+  std::remove(snapshotName.c_str());
+  {
+    // no snapshot yet, subtables are read and the snapshot is written
+    TableConstDataSource ds(TableTestRunner::msName());
+    CPPUNIT_ASSERT(!ds.loadSubtableSnapshot(snapshotName));
+    CPPUNIT_ASSERT(std::ifstream(snapshotName.c_str()).good());
+  }
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT(ds.loadSubtableSnapshot(snapshotName));
+  // iteration works as usual
+  casacore::uInt counter = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++counter) {
+       CPPUNIT_ASSERT(it->nRow() > 0);
+  }
+  CPPUNIT_ASSERT(counter > 0);
+  // compare the restored handlers with those read from the subtables
+  TableInfoAccessor reference(casacore::Table(TableTestRunner::msName()), false);
+  TableInfoAccessor restored(casacore::Table(TableTestRunner::msName()), false);
+  CPPUNIT_ASSERT(restored.subtableInfo().loadSnapshot(snapshotName));
+  const ISubtableInfoHolder &refInfo = reference.subtableInfo();
+  const ISubtableInfoHolder &info = restored.subtableInfo();
+  // antennas
+  CPPUNIT_ASSERT_EQUAL(refInfo.getAntenna().getNumberOfAntennae(), info.getAntenna().getNumberOfAntennae());
+  CPPUNIT_ASSERT_EQUAL(refInfo.getAntenna().allEquatorial(), info.getAntenna().allEquatorial());
+  for (casacore::uInt ant = 0; ant < info.getAntenna().getNumberOfAntennae(); ++ant) {
+       CPPUNIT_ASSERT(refInfo.getAntenna().getMount(ant) == info.getAntenna().getMount(ant));
+       CPPUNIT_ASSERT(refInfo.getAntenna().getPosition(ant).getRef().getType() ==
+                      info.getAntenna().getPosition(ant).getRef().getType());
+       const casacore::Vector<casacore::Double> refPos = refInfo.getAntenna().getPosition(ant).getValue().getValue();
+       const casacore::Vector<casacore::Double> pos = info.getAntenna().getPosition(ant).getValue().getValue();
+       CPPUNIT_ASSERT(casacore::allNear(refPos, pos, 1e-12));
+  }
+  // data description, spectral windows and polarisations
+  CPPUNIT_ASSERT_EQUAL(refInfo.getDataDescription().getSpectralWindowID(0),
+                       info.getDataDescription().getSpectralWindowID(0));
+  CPPUNIT_ASSERT_EQUAL(refInfo.getDataDescription().getPolarizationID(0),
+                       info.getDataDescription().getPolarizationID(0));
+  const casacore::uInt spWindow = info.getDataDescription().getSpectralWindowID(0);
+  CPPUNIT_ASSERT(refInfo.getSpWindow().getFrequencyUnit().getName() == info.getSpWindow().getFrequencyUnit().getName());
+  CPPUNIT_ASSERT(refInfo.getSpWindow().getReferenceFrame(spWindow).getType() == 
+                 info.getSpWindow().getReferenceFrame(spWindow).getType());
+  CPPUNIT_ASSERT(casacore::allEQ(refInfo.getSpWindow().getFrequencies(spWindow), info.getSpWindow().getFrequencies(spWindow)));
+  const casacore::uInt polID = info.getDataDescription().getPolarizationID(0);
+  CPPUNIT_ASSERT(casacore::allEQ(refInfo.getPolarisation().getTypes(polID), info.getPolarisation().getTypes(polID)));
+  // field
+  casacore::MEpoch time(casacore::MVEpoch(casacore::Quantity(50257.29,"d")),
+                    casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+  CPPUNIT_ASSERT(info.getField().getReferenceDir(time).getRef().getType() == casacore::MDirection::J2000);
+  CPPUNIT_ASSERT(info.getField().getReferenceDir(time).getValue().
+                 separation(refInfo.getField().getReferenceDir(time).getValue()) < 1e-12);
+  CPPUNIT_ASSERT(info.getField().getReferenceDir(0).getValue().
+                 separation(refInfo.getField().getReferenceDir(0).getValue()) < 1e-12);
+  // corrupted and missing snapshots are rejected
+  {
+    std::ofstream os(snapshotName.c_str(), std::ios::out | std::ios::trunc);
+    os<<"not a snapshot";
+  }
+  TableInfoAccessor another(casacore::Table(TableTestRunner::msName()), false);
+  CPPUNIT_ASSERT(!another.subtableInfo().loadSnapshot(snapshotName));
+  std::remove(snapshotName.c_str());
+  CPPUNIT_ASSERT(!another.subtableInfo().loadSnapshot(snapshotName));
+}
+
+/// @brief test of reading several data columns together
+void TableDataAccessTest::multiColumnTest()
+{
+  const std::string columnName = "MULTICOLUMN_TEST";
+  {
+    // add a column with doubled visibilities
+    casacore::Table ms(TableTestRunner::msName(), casacore::Table::Update);
+    ms.addColumn(casacore::ArrayColumnDesc<casacore::Complex>(columnName));
+    casacore::ROArrayColumn<casacore::Complex> dataCol(ms, "DATA");
+    casacore::ArrayColumn<casacore::Complex> testCol(ms, columnName);
+    for (casacore::uInt row = 0; row < ms.nrow(); ++row) {
+         const casacore::Array<casacore::Complex> buf = dataCol(row);
+         testCol.put(row, buf * casacore::Complex(2.,0.));
+    }
+  }
+  {
+    TableConstDataSource ds(TableTestRunner::msName());
+    ds.configureMaxChunkSize(50);
+    IDataSelectorPtr sel = ds.createSelector();
+    boost::shared_ptr<ITableDataSelectorImpl> implSel = boost::dynamic_pointer_cast<ITableDataSelectorImpl>(sel);
+    CPPUNIT_ASSERT(implSel);
+    CPPUNIT_ASSERT(implSel->getExtraDataColumnNames().empty());
+    implSel->chooseExtraDataColumns(std::vector<std::string>(1, columnName));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), implSel->getExtraDataColumnNames().size());
+    sel->chooseChannels(4, 2);
+    casacore::uInt counter = 0;
+    for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it, ++counter) {
+         const IMultiColumnDataAccessor *acc = dynamic_cast<const IMultiColumnDataAccessor*>(&(*it));
+         CPPUNIT_ASSERT(acc != NULL);
+         const casacore::Cube<casacore::Complex> &vis = acc->columnVisibility(columnName);
+         CPPUNIT_ASSERT(vis.shape() == it->visibility().shape());
+         CPPUNIT_ASSERT_EQUAL(casacore::uInt(4), vis.ncolumn());
+         CPPUNIT_ASSERT(casacore::allNear(vis, it->visibility() * casacore::Complex(2.,0.), 1e-6));
+         // the main data column is available under its name too
+         CPPUNIT_ASSERT(casacore::allEQ(acc->columnVisibility("DATA"), it->visibility()));
+    }
+    CPPUNIT_ASSERT(counter > 1);
+    // columns which are not chosen or don't exist are rejected
+    IConstDataSharedIter it = ds.createConstIterator();
+    const IMultiColumnDataAccessor *acc = dynamic_cast<const IMultiColumnDataAccessor*>(&(*it));
+    CPPUNIT_ASSERT(acc != NULL);
+    CPPUNIT_ASSERT_THROW(acc->columnVisibility(columnName), DataAccessError);
+    CPPUNIT_ASSERT_THROW(implSel->chooseExtraDataColumns(std::vector<std::string>(1, "NO_SUCH_COLUMN")), 
+                         AskapError);
+  }
+  casacore::Table ms(TableTestRunner::msName(), casacore::Table::Update);
+  ms.removeColumn(columnName);
+}
+
+/// test of polarisation selection
+void TableDataAccessTest::polSelectionTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  ds.configureMaxChunkSize(50);
+  // subset read via the slicer and a product which has to be converted
+  IDataSelectorPtr subsetSel = ds.createSelector();
+  subsetSel->choosePolarizations("YY");
+  IDataSelectorPtr convSel = ds.createSelector();
+  convSel->choosePolarizations("I");
+  IConstDataSharedIter subsetIt = ds.createConstIterator(subsetSel);
+  IConstDataSharedIter convIt = ds.createConstIterator(convSel);
+  casacore::uInt counter = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); 
+       ++it, ++subsetIt, ++convIt, ++counter) {
+       CPPUNIT_ASSERT(subsetIt != subsetIt.end());
+       CPPUNIT_ASSERT(convIt != convIt.end());
+       // the test dataset has XX and YY
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), it->nPol());
+       const casacore::Cube<casacore::Complex> &vis = it->visibility();
+       const casacore::Cube<casacore::Bool> &flag = it->flag();
+       const casacore::Cube<casacore::Complex> &noise = it->noise();
+
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), subsetIt->nPol());
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), subsetIt->nRow());
+       CPPUNIT_ASSERT_EQUAL(casacore::Stokes::YY, subsetIt->stokes()[0]);
+       CPPUNIT_ASSERT(subsetIt->visibility().shape() == casacore::IPosition(3, it->nRow(), it->nChannel(), 1));
+       CPPUNIT_ASSERT(casacore::allEQ(subsetIt->visibility().xyPlane(0), vis.xyPlane(1)));
+       CPPUNIT_ASSERT(casacore::allEQ(subsetIt->flag().xyPlane(0), flag.xyPlane(1)));
+       CPPUNIT_ASSERT(casacore::allEQ(subsetIt->noise().xyPlane(0), noise.xyPlane(1)));
+
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), convIt->nPol());
+       CPPUNIT_ASSERT_EQUAL(casacore::Stokes::I, convIt->stokes()[0]);
+       const casacore::Matrix<casacore::Complex> stokesI = convIt->visibility().xyPlane(0);
+       const casacore::Matrix<casacore::Complex> expected = 
+             (vis.xyPlane(0) + vis.xyPlane(1)) * casacore::Complex(0.5, 0.);
+       CPPUNIT_ASSERT(casacore::allNear(stokesI, expected, 1e-5));
+       const casacore::Matrix<casacore::Bool> expectedFlag = flag.xyPlane(0) || flag.xyPlane(1);
+       CPPUNIT_ASSERT(casacore::allEQ(convIt->flag().xyPlane(0), expectedFlag));
+       CPPUNIT_ASSERT(convIt->noise().shape() == convIt->visibility().shape());
+       // converted products are only available in the accessor order
+       const INativeLayoutDataAccessor *nativeAcc = 
+             dynamic_cast<const INativeLayoutDataAccessor*>(&(*convIt));
+       CPPUNIT_ASSERT(nativeAcc != NULL);
+       CPPUNIT_ASSERT_THROW(nativeAcc->nativeVisibility(), DataAccessLogicError);
+  }
+  CPPUNIT_ASSERT(counter > 1);
+  CPPUNIT_ASSERT(subsetIt == subsetIt.end());
+  CPPUNIT_ASSERT_THROW(subsetSel->choosePolarizations("XX,ZZ"), DataAccessError);
+}
+
+/// test of the channel averaging at read time
+void TableDataAccessTest::channelAveragingTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  ds.configureMaxChunkSize(50);
+  // channels 1 to 12 of 13 averaged in groups of 3
+  const casacore::uInt nAvg = 3;
+  const casacore::uInt start = 1;
+  IDataSelectorPtr avgSel = ds.createSelector();
+  avgSel->chooseChannels(4, start, nAvg);
+  IConstDataSharedIter avgIt = ds.createConstIterator(avgSel);
+  casacore::uInt counter = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++avgIt, ++counter) {
+       CPPUNIT_ASSERT(avgIt != avgIt.end());
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), avgIt->nRow());
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(4), avgIt->nChannel());
+       CPPUNIT_ASSERT_EQUAL(it->nPol(), avgIt->nPol());
+       const casacore::Vector<casacore::Double> &freq = it->frequency();
+       const casacore::Vector<casacore::Double> &avgFreq = avgIt->frequency();
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(4), casacore::uInt(avgFreq.nelements()));
+       for (casacore::uInt chan = 0; chan < 4; ++chan) {
+            // equally spaced channels, the mean is the middle one
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(freq[start + chan * nAvg + 1], avgFreq[chan], 1e-3);
+       }
+       const casacore::Cube<casacore::Complex> &vis = it->visibility();
+       const casacore::Cube<casacore::Bool> &flag = it->flag();
+       const casacore::Cube<casacore::Complex> &noise = it->noise();
+       const casacore::Cube<casacore::Complex> &avgVis = avgIt->visibility();
+       const casacore::Cube<casacore::Bool> &avgFlag = avgIt->flag();
+       const casacore::Cube<casacore::Complex> &avgNoise = avgIt->noise();
+       CPPUNIT_ASSERT(avgVis.shape() == casacore::IPosition(3, it->nRow(), 4, it->nPol()));
+       CPPUNIT_ASSERT(avgFlag.shape() == avgVis.shape());
+       CPPUNIT_ASSERT(avgNoise.shape() == avgVis.shape());
+       for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+            for (casacore::uInt chan = 0; chan < 4; ++chan) {
+                 for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+                      casacore::Complex sum(0., 0.);
+                      casacore::Float sumWeights = 0.;
+                      for (casacore::uInt i = 0; i < nAvg; ++i) {
+                           const casacore::uInt inChan = start + chan * nAvg + i;
+                           const casacore::Float sigma = casacore::real(noise(row, inChan, pol));
+                           if (!flag(row, inChan, pol) && (sigma > 0.)) {
+                               const casacore::Float weight = 1. / (sigma * sigma);
+                               sum += vis(row, inChan, pol) * weight;
+                               sumWeights += weight;
+                           }
+                      }
+                      CPPUNIT_ASSERT_EQUAL(sumWeights <= 0., bool(avgFlag(row, chan, pol)));
+                      if (sumWeights > 0.) {
+                          CPPUNIT_ASSERT(abs(avgVis(row, chan, pol) - sum / sumWeights) < 1e-5);
+                          CPPUNIT_ASSERT_DOUBLES_EQUAL(1. / sqrt(sumWeights), 
+                                     casacore::real(avgNoise(row, chan, pol)), 1e-5);
+                      }
+                 }
+            }
+       }
+       // cubes in the native order are not available for averaged channels
+       const INativeLayoutDataAccessor *nativeAcc = 
+             dynamic_cast<const INativeLayoutDataAccessor*>(&(*avgIt));
+       CPPUNIT_ASSERT(nativeAcc != NULL);
+       CPPUNIT_ASSERT_THROW(nativeAcc->nativeVisibility(), DataAccessLogicError);
+  }
+  CPPUNIT_ASSERT(counter > 1);
+  CPPUNIT_ASSERT(avgIt == avgIt.end());
+  CPPUNIT_ASSERT_THROW(avgSel->chooseChannels(4, start, 0), AskapError);
+  // the selection beyond the last channel is caught when the data are read
+  IDataSelectorPtr wideSel = ds.createSelector();
+  wideSel->chooseChannels(5, start, nAvg);
+  CPPUNIT_ASSERT_THROW(ds.createConstIterator(wideSel), AskapError);
+}
+
+/// @brief test of the single precision uvw and spectral axis
+void TableDataAccessTest::singlePrecisionTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  // frequencies in MHz, the inverse wavelength shouldn't depend on units
+  IDataConverterPtr conv = ds.createConverter();
+  conv->setFrequencyFrame(casacore::MFrequency::Ref(casacore::MFrequency::TOPO), "MHz");
+  size_t counter = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end() && counter < 3; ++it, ++counter) {
+       const ISinglePrecisionDataAccessor *acc = dynamic_cast<const ISinglePrecisionDataAccessor*>(&(*it));
+       CPPUNIT_ASSERT(acc != NULL);
+       const casacore::Vector<casacore::RigidVector<casacore::Float, 3> > &floatUVW = acc->floatUVW();
+       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = it->uvw();
+       CPPUNIT_ASSERT_EQUAL(uvw.nelements(), floatUVW.nelements());
+       for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+            for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(uvw[row](dim), floatUVW[row](dim), 1e-3);
+            }
+       }
+       // the second call should return the cached buffer
+       CPPUNIT_ASSERT(&floatUVW == &(acc->floatUVW()));
+       const casacore::Vector<casacore::Double> &freq = it->frequency();
+       const casacore::Vector<casacore::Float> &floatFreq = acc->floatFrequency();
+       const casacore::Vector<casacore::Float> &invLambda = acc->inverseWavelength();
+       CPPUNIT_ASSERT_EQUAL(freq.nelements(), floatFreq.nelements());
+       CPPUNIT_ASSERT_EQUAL(freq.nelements(), invLambda.nelements());
+       for (casacore::uInt chan = 0; chan < freq.nelements(); ++chan) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(freq[chan], floatFreq[chan], 1e-3);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(freq[chan] * 1e6 / casacore::C::c, invLambda[chan], 1e-5);
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(size_t(3), counter);
+}
+
+/// @brief test of the weight cube derived from flags and noise
+void TableDataAccessTest::weightTest()
+{
+  const bool hasWeightSpectrum = casacore::Table(TableTestRunner::msName()).tableDesc().isColumn("WEIGHT_SPECTRUM");
+  TableConstDataSource ds(TableTestRunner::msName());
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+       const IWeightDataAccessor *acc = dynamic_cast<const IWeightDataAccessor*>(&(*it));
+       CPPUNIT_ASSERT(acc != NULL);
+       const casacore::Cube<casacore::Float> &weight = acc->weight();
+       // the second call should return the cached buffer
+       CPPUNIT_ASSERT(&weight == &(acc->weight()));
+       const casacore::Cube<casacore::Bool> &flag = it->flag();
+       const casacore::Cube<casacore::Complex> &noise = it->noise();
+       CPPUNIT_ASSERT(weight.shape() == flag.shape());
+       for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+            for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+                      const casacore::Float sigma = casacore::real(noise(row, chan, pol));
+                      if (flag(row, chan, pol) || (!hasWeightSpectrum && (sigma <= 0.))) {
+                          CPPUNIT_ASSERT_EQUAL(casacore::Float(0.), weight(row, chan, pol));
+                      } else if (!hasWeightSpectrum) {
+                          CPPUNIT_ASSERT_DOUBLES_EQUAL(1., weight(row, chan, pol) * sigma * sigma, 1e-5);
+                      }
+                 }
+            }
+       }
+  }
+  // the general case with polarisation conversion is derived from the converted cubes
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->choosePolarizations("I");
+  for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it) {
+       const IWeightDataAccessor *acc = dynamic_cast<const IWeightDataAccessor*>(&(*it));
+       CPPUNIT_ASSERT(acc != NULL);
+       const casacore::Cube<casacore::Float> &weight = acc->weight();
+       CPPUNIT_ASSERT_EQUAL(1u, weight.nplane());
+       for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+            for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                 const casacore::Float sigma = casacore::real(it->noise()(row, chan, 0));
+                 if (it->flag()(row, chan, 0) || (sigma <= 0.)) {
+                     CPPUNIT_ASSERT_EQUAL(casacore::Float(0.), weight(row, chan, 0));
+                 } else {
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(1., weight(row, chan, 0) * sigma * sigma, 1e-5);
+                 }
+            }
+       }
+  }
+}
+
+/// @brief test of the custom allocator of the data buffers
+void TableDataAccessTest::bufferAllocatorTest()
+{
+  struct TestAllocator : public IBufferAllocator {
+     TestAllocator() : itsNBlocks(0), itsNBytes(0) {}
+     virtual void* allocate(size_t nBytes) {
+        ++itsNBlocks;
+        itsNBytes += nBytes;
+        return std::malloc(nBytes);
+     }
+     virtual void deallocate(void *ptr, size_t nBytes) {
+        --itsNBlocks;
+        itsNBytes -= nBytes;
+        std::free(ptr);
+     }
+     int itsNBlocks;
+     size_t itsNBytes;
+  };
+  boost::shared_ptr<TestAllocator> allocator(new TestAllocator);
+  TableConstDataSource ds(TableTestRunner::msName());
+  ds.configureMaxChunkSize(50);
+  IConstDataSharedIter refIt = ds.createConstIterator();
+  ds.configureBufferAllocator(allocator);
+  {
+    IConstDataSharedIter it = ds.createConstIterator();
+    // nothing is allocated until the data are read
+    CPPUNIT_ASSERT_EQUAL(0, allocator->itsNBlocks);
+    for (size_t counter = 0; (it != it.end()) && (counter < 3); ++it, ++refIt, ++counter) {
+         CPPUNIT_ASSERT(refIt != refIt.end());
+         const casacore::Cube<casacore::Complex> &vis = it->visibility();
+         const casacore::Cube<casacore::Bool> &flag = it->flag();
+         CPPUNIT_ASSERT(allocator->itsNBlocks >= 2);
+         CPPUNIT_ASSERT(allocator->itsNBytes >= vis.nelements() * sizeof(casacore::Complex) + 
+                        flag.nelements() * sizeof(casacore::Bool));
+         CPPUNIT_ASSERT(allEQ(vis, refIt->visibility()));
+         CPPUNIT_ASSERT(allEQ(flag, refIt->flag()));
+    }
+    CPPUNIT_ASSERT(it != it.end());
+    // released buffers are read again on demand
+    const boost::shared_ptr<TableConstDataIterator> tabIt = it.dynamicCast<TableConstDataIterator>();
+    CPPUNIT_ASSERT(tabIt);
+    tabIt->releaseBuffers();
+    CPPUNIT_ASSERT_EQUAL(0, allocator->itsNBlocks);
+    CPPUNIT_ASSERT(allEQ(it->visibility(), refIt->visibility()));
+    CPPUNIT_ASSERT_EQUAL(1, allocator->itsNBlocks);
+  }
+  // all blocks are returned when the iterator is destroyed
+  CPPUNIT_ASSERT_EQUAL(0, allocator->itsNBlocks);
+  CPPUNIT_ASSERT_EQUAL(size_t(0), allocator->itsNBytes);
+}
+
+/// test of the iteration bound to NUMA nodes
+void TableDataAccessTest::affinityTest()
+{
+  // sysfs format of the CPU lists
+  const ThreadAffinity parsed = ThreadAffinity::parse("0-3,8,10-11,2");
+  CPPUNIT_ASSERT_EQUAL(size_t(7), parsed.cpus().size());
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), parsed.cpus()[0]);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(3), parsed.cpus()[3]);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(8), parsed.cpus()[4]);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(11), parsed.cpus()[6]);
+  CPPUNIT_ASSERT(ThreadAffinity::parse("").empty());
+  CPPUNIT_ASSERT(ThreadAffinity::numberOfNumaNodes() >= 1);
+
+  // the current set of CPUs is always available, the data should not change
+  TableConstDataSource ds(TableTestRunner::msName());
+  IConstDataSharedIter refIt = ds.createConstIterator();
+  IConstDataSharedIter it = ds.createConstIterator();
+  const boost::shared_ptr<TableConstDataIterator> tabIt = it.dynamicCast<TableConstDataIterator>();
+  CPPUNIT_ASSERT(tabIt);
+  const ThreadAffinity current = ThreadAffinity::ofCurrentThread();
+  tabIt->setAffinity(current);
+  CPPUNIT_ASSERT(tabIt->affinity().cpus() == current.cpus());
+  for (; refIt != refIt.end(); ++refIt, ++it) {
+       CPPUNIT_ASSERT(it != it.end());
+       CPPUNIT_ASSERT(allEQ(it->visibility(), refIt->visibility()));
+       CPPUNIT_ASSERT(allEQ(it->flag(), refIt->flag()));
+  }
+  CPPUNIT_ASSERT(it == it.end());
+
+  // partitions bound to nodes cover the whole dataset
+  size_t totalRows = 0;
+  for (IConstDataSharedIter allIt = ds.createConstIterator(); allIt != allIt.end(); ++allIt) {
+       totalRows += allIt->nRow();
+  }
+  const casacore::uInt nPartitions = 2;
+  std::vector<boost::shared_ptr<IConstDataIterator> > iters = ds.createPartitionedIterators(ds.createSelector(), 
+               ds.createConverter(), TableConstDataSource::BASELINE_PARTITION, nPartitions, true);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(nPartitions), iters.size());
+  size_t partitionedRows = 0;
+  for (casacore::uInt part = 0; part < nPartitions; ++part) {
+       for (IConstDataSharedIter partIt(iters[part]); partIt != partIt.end(); ++partIt) {
+            partitionedRows += partIt->nRow();
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(totalRows, partitionedRows);
+}
+
+/// @brief modify all visibilities of one partition
+/// @details This is the body of the threads used in concurrentWriteTest
+/// @param[in] it iterator over the partition
+/// @param[in] value value to assign to all visibilities
+/// @param[in] original vector to store the original visibilities of each chunk
+void TableDataAccessTest::modifyPartition(const boost::shared_ptr<IDataIterator> &it,
+              casacore::Complex value, std::vector<casacore::Cube<casacore::Complex> > &original)
+{
+  for (it->init(); it->hasMore(); it->next()) {
+       original.push_back((**it).visibility().copy());
+       (**it).rwVisibility().set(value);
+  }
+}
+
+/// test of the concurrent writes from partitioned iterators
+void TableDataAccessTest::concurrentWriteTest()
+{
+  TableDataSource ds(TableTestRunner::msName(), TableDataSource::WRITE_PERMITTED);
+  ds.configureMaxChunkSize(50);
+  ds.configureWriteBehind(2);
+  const casacore::uInt nPartitions = 3;
+  std::vector<boost::shared_ptr<IDataIterator> > iters = ds.createPartitionedRWIterators(
+          ds.createSelector(), ds.createConverter(), TableConstDataSource::BASELINE_PARTITION, nPartitions);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(nPartitions), iters.size());
+  std::vector<std::vector<casacore::Cube<casacore::Complex> > > original(nPartitions);
+  boost::thread_group threads;
+  for (casacore::uInt part = 0; part < nPartitions; ++part) {
+       threads.create_thread(boost::bind(&TableDataAccessTest::modifyPartition, iters[part],
+                 casacore::Complex(float(part + 1), -1.), boost::ref(original[part])));
+  }
+  threads.join_all();
+  // the barrier, changes made by all partitions should be in the table afterwards
+  boost::shared_ptr<TableDataIterator> tabIt = boost::dynamic_pointer_cast<TableDataIterator>(iters[0]);
+  CPPUNIT_ASSERT(tabIt);
+  tabIt->sync();
+  std::vector<boost::shared_ptr<IConstDataIterator> > constIters = ds.createPartitionedIterators(
+          ds.createSelector(), ds.createConverter(), TableConstDataSource::BASELINE_PARTITION, nPartitions);
+  for (casacore::uInt part = 0; part < nPartitions; ++part) {
+       size_t counter = 0;
+       for (IConstDataSharedIter it(constIters[part]); it != it.end(); ++it, ++counter) {
+            CPPUNIT_ASSERT(casacore::allNear(it->visibility(), casacore::Complex(float(part + 1), -1.), 1e-7));
+       }
+       CPPUNIT_ASSERT_EQUAL(original[part].size(), counter);
+  }
+  // restore the original visibilities, the shared writer is flushed when the last iterator is gone
+  for (casacore::uInt part = 0; part < nPartitions; ++part) {
+       size_t counter = 0;
+       for (iters[part]->init(); iters[part]->hasMore(); iters[part]->next(), ++counter) {
+            (**iters[part]).rwVisibility() = original[part][counter];
+       }
+  }
+  tabIt.reset();
+  iters.clear();
+  constIters = ds.createPartitionedIterators(ds.createSelector(), ds.createConverter(), 
+          TableConstDataSource::BASELINE_PARTITION, nPartitions);
+  for (casacore::uInt part = 0; part < nPartitions; ++part) {
+       size_t counter = 0;
+       for (IConstDataSharedIter it(constIters[part]); it != it.end(); ++it, ++counter) {
+            CPPUNIT_ASSERT(casacore::allNear(it->visibility(), original[part][counter], 1e-7));
+       }
+  }
+}
+
 /// test of correlation type selection
 void TableDataAccessTest::corrTypeSelectionTest() 
 {
@@ -339,6 +1987,21 @@ void TableDataAccessTest::bufferManagerTest()
   itsTableInfoAccessor.reset(new TableInfoAccessor(
             casacore::Table(TableTestRunner::msName(),casacore::Table::Update), false));
   doBufferTest();
+  // buffers in flat binary files, the table itself can be read only
+  itsTableInfoAccessor.reset(new TableInfoAccessor(
+            casacore::Table(TableTestRunner::msName()), SubtableInfoHolder::FILE_BUFFERS));
+  doBufferTest();
+  // rewrite in place and grow the cell
+  const IBufferManager &bufferMgr = itsTableInfoAccessor->subtableInfo().getBufferManager();
+  casacore::Cube<casacore::Complex> vis(5,20,2,casacore::Complex(2.,1.));
+  bufferMgr.writeBuffer(vis,"TEST",4);
+  casacore::Cube<casacore::Complex> vis2;
+  bufferMgr.readBuffer(vis2,"TEST",4);
+  CPPUNIT_ASSERT(vis2.shape() == vis.shape());
+  CPPUNIT_ASSERT(casacore::allEQ(vis2, casacore::Complex(2.,1.)));
+  bufferMgr.readBuffer(vis2,"TEST",5);
+  CPPUNIT_ASSERT(vis2.shape() == casacore::IPosition(3,5,10,2));
+  CPPUNIT_ASSERT(casacore::allEQ(vis2, casacore::Complex(1.,-0.5)));
 }
 
 /// test access to data description subtable
@@ -700,6 +2363,157 @@ void TableDataAccessTest::originalVisRewriteTest()
   }
 }
 
+void TableDataAccessTest::timeStepTest()
+{
+  const casacore::Table ms(TableTestRunner::msName());
+  // a selection to have a reference table with non-contiguous rows
+  const casacore::Table selected = ms(ms.col("ANTENNA1") != ms.col("ANTENNA2"));
+  CPPUNIT_ASSERT(selected.nrow() > 0);
+  CPPUNIT_ASSERT(selected.nrow() < ms.nrow());
+  TimeStepIterator steps(selected);
+  const casacore::Vector<casacore::uInt> msRows = selected.rowNumbers();
+  casacore::uInt nSteps = 0;
+  // the steps should be the same as for the table iterator
+  for (casacore::TableIterator tabIt(selected, "TIME", casacore::TableIterator::Ascending,
+       casacore::TableIterator::NoSort); !tabIt.pastEnd(); tabIt.next(), steps.next(), ++nSteps) {
+       CPPUNIT_ASSERT(!steps.pastEnd());
+       const casacore::Vector<casacore::uInt> stepRows = tabIt.table().rowNumbers();
+       CPPUNIT_ASSERT_EQUAL(static_cast<casacore::uInt>(stepRows.nelements()), steps.nrow());
+       for (casacore::uInt row = 0; row < steps.nrow(); ++row) {
+            CPPUNIT_ASSERT_EQUAL(stepRows[row], msRows[steps.startRow() + row]);
+       }
+  }
+  CPPUNIT_ASSERT(steps.pastEnd());
+  CPPUNIT_ASSERT_EQUAL(nSteps, steps.nSteps());
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), steps.nrow());
+  steps.reset();
+  CPPUNIT_ASSERT(!steps.pastEnd());
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), steps.startRow());
+  // an empty table has no steps
+  const TimeStepIterator empty(selected(selected.col("ANTENNA1") < 0));
+  CPPUNIT_ASSERT(empty.pastEnd());
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), empty.nSteps());
+
+  // chunks of the data iterator follow the row ranges of the steps
+  TableDataSource ds(TableTestRunner::msName(), TableDataSource::DEFAULT, "DATA");
+  ds.configureMaxChunkSize(50);
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseCrossCorrelations();
+  casacore::uInt nRows = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it) {
+       CPPUNIT_ASSERT(it->nRow() <= 50);
+       nRows += it->nRow();
+  }
+  CPPUNIT_ASSERT_EQUAL(static_cast<casacore::uInt>(selected.nrow()), nRows);
+}
+
+void TableDataAccessTest::rowGroupingTest()
+{
+  // memory table with interleaved spectral windows and fields
+  casacore::TableDesc td;
+  td.addColumn(casacore::ScalarColumnDesc<casacore::Double>("TIME"));
+  td.addColumn(casacore::ScalarColumnDesc<casacore::Int>("DATA_DESC_ID"));
+  td.addColumn(casacore::ScalarColumnDesc<casacore::Int>("FIELD_ID"));
+  casacore::SetupNewTable setup("rowGroupingTest_tmp", td, casacore::Table::New);
+  const casacore::uInt nRow = 12;
+  casacore::Table tab(setup, casacore::Table::Memory, nRow);
+  casacore::ScalarColumn<casacore::Double> timeCol(tab, "TIME");
+  casacore::ScalarColumn<casacore::Int> dataDescCol(tab, "DATA_DESC_ID");
+  casacore::ScalarColumn<casacore::Int> fieldCol(tab, "FIELD_ID");
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       // two time steps, DATA_DESC_ID interleaved in the first, FIELD_ID in the second
+       timeCol.put(row, row < nRow / 2 ? 1. : 2.);
+       dataDescCol.put(row, row < nRow / 2 ? casacore::Int((row + 1) % 2) : 0);
+       fieldCol.put(row, row < nRow / 2 ? 0 : casacore::Int(row % 2));
+  }
+  // no grouping, the original table is used
+  const TimeStepIterator plain(tab);
+  CPPUNIT_ASSERT(!plain.grouped());
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), plain.nSteps());
+
+  TimeStepIterator steps(tab, true);
+  CPPUNIT_ASSERT(steps.grouped());
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), steps.nSteps());
+  const casacore::Table &grouped = steps.table();
+  CPPUNIT_ASSERT_EQUAL(nRow, casacore::uInt(grouped.nrow()));
+  const casacore::Vector<casacore::uInt> rows = grouped.rowNumbers(tab);
+  const casacore::Vector<casacore::Int> dataDescIDs = casacore::ROScalarColumn<casacore::Int>(grouped, 
+                                 "DATA_DESC_ID").getColumn();
+  const casacore::Vector<casacore::Int> fieldIDs = casacore::ROScalarColumn<casacore::Int>(grouped, 
+                                 "FIELD_ID").getColumn();
+  for (; !steps.pastEnd(); steps.next()) {
+       CPPUNIT_ASSERT_EQUAL(nRow / 2, steps.nrow());
+       for (casacore::uInt row = steps.startRow() + 1; row < steps.startRow() + steps.nrow(); ++row) {
+            // rows are grouped, original order is preserved within each group
+            CPPUNIT_ASSERT(dataDescIDs[row - 1] <= dataDescIDs[row]);
+            if (dataDescIDs[row - 1] == dataDescIDs[row]) {
+                CPPUNIT_ASSERT(fieldIDs[row - 1] <= fieldIDs[row]);
+                if (fieldIDs[row - 1] == fieldIDs[row]) {
+                    CPPUNIT_ASSERT(rows[row - 1] < rows[row]);
+                }
+            }
+            // rows don't move between time steps
+            CPPUNIT_ASSERT_EQUAL(steps.startRow() == 0, rows[row] < nRow / 2);
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), rows[0]);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), rows[nRow / 2 - 1] % 2);
+
+  // already grouped rows are not permuted
+  const TimeStepIterator again(grouped, true);
+  CPPUNIT_ASSERT(!again.grouped());
+}
+
+void TableDataAccessTest::chunkMemoryBudgetTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT_EQUAL(size_t(0), ds.chunkMemoryBudget());
+  IDataSelectorPtr sel = ds.createSelector();
+  boost::shared_ptr<ITableDataSelectorImpl> implSel = boost::dynamic_pointer_cast<ITableDataSelectorImpl>(sel);
+  CPPUNIT_ASSERT(implSel);
+  implSel->chooseRequiredFields(ITableDataSelectorImpl::VISIBILITY_FIELD | ITableDataSelectorImpl::FLAG_FIELD);
+  casacore::uInt nRowTotal = 0;
+  size_t rowBytes = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it) {
+       nRowTotal += it->nRow();
+       // the test dataset has the same spectral setup for all rows
+       rowBytes = it->nChannel() * it->nPol() * (sizeof(casacore::Complex) + sizeof(casacore::Bool)) + 
+                  4 * sizeof(casacore::uInt);
+  }
+  CPPUNIT_ASSERT(rowBytes > 0);
+  // the budget for 3 and a half rows gives chunks of up to 3 rows
+  ds.configureChunkMemoryBudget(3 * rowBytes + rowBytes / 2);
+  CPPUNIT_ASSERT_EQUAL(3 * rowBytes + rowBytes / 2, ds.chunkMemoryBudget());
+  IConstDataSharedIter it = ds.createConstIterator(sel);
+  const boost::shared_ptr<TableConstDataIterator> tableIt = it.dynamicCast<TableConstDataIterator>();
+  CPPUNIT_ASSERT(tableIt);
+  casacore::uInt nRowBudget = 0;
+  casacore::uInt nChunks = 0;
+  casacore::uInt nFullChunks = 0;
+  for (; it != it.end(); ++it, ++nChunks) {
+       CPPUNIT_ASSERT(it->nRow() <= 3);
+       CPPUNIT_ASSERT_EQUAL(nChunks, tableIt->currentChunk());
+       nRowBudget += it->nRow();
+       if (it->nRow() == 3) {
+           ++nFullChunks;
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(nRowTotal, nRowBudget);
+  CPPUNIT_ASSERT(nFullChunks > 0);
+  // the index of chunks follows the same limit
+  CPPUNIT_ASSERT_EQUAL(nChunks, tableIt->nChunks());
+  // the explicit restriction still applies
+  ds.configureMaxChunkSize(2);
+  for (IConstDataSharedIter it2 = ds.createConstIterator(sel); it2 != it2.end(); ++it2) {
+       CPPUNIT_ASSERT(it2->nRow() <= 2);
+  }
+  // a budget smaller than one row still gives one row per chunk
+  ds.configureChunkMemoryBudget(1);
+  for (IConstDataSharedIter it2 = ds.createConstIterator(sel); it2 != it2.end(); ++it2) {
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), it2->nRow());
+  }
+}
+
 } // namespace accessors
 
 } // namespace askap
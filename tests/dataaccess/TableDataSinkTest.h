@@ -0,0 +1,153 @@
+/// @file
+/// @brief Tests of the data sink creating a measurement set
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef TABLE_DATA_SINK_TEST_H
+#define TABLE_DATA_SINK_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/TableDataSink.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// casa includes
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/tables/Tables/Table.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+class TableDataSinkTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TableDataSinkTest);
+  CPPUNIT_TEST(testTileShape);
+  CPPUNIT_TEST(testRoundTrip);
+  CPPUNIT_TEST_EXCEPTION(testShapeChange, DataAccessError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {
+     itsName = "./.test.sink.ms";
+  }
+
+  void tearDown() {
+     casacore::Directory dir(itsName);
+     if (dir.exists()) {
+         dir.removeRecursive();
+     }
+  }
+
+  void testTileShape() {
+     // all rows of a small chunk fit into a tile
+     CPPUNIT_ASSERT(TableDataSink::tileShape(4, 16, 100) == casacore::IPosition(3, 4, 16, 100));
+     // rows are limited by the tile size
+     const casacore::IPosition tile = TableDataSink::tileShape(4, 16416, 1000);
+     CPPUNIT_ASSERT_EQUAL(16416, int(tile[1]));
+     CPPUNIT_ASSERT(tile[2] >= 1);
+     CPPUNIT_ASSERT(size_t(tile.product()) * sizeof(casacore::Complex) <= TableDataSink::theirMaxTileBytes);
+     // channels are split if a single row doesn't fit
+     const casacore::IPosition tile2 = TableDataSink::tileShape(4, 1000000, 10);
+     CPPUNIT_ASSERT_EQUAL(1, int(tile2[2]));
+     CPPUNIT_ASSERT(tile2[1] < 1000000);
+  }
+
+  void testRoundTrip() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv = ds.createConverter();
+     TableDataSink::configureConverter(*conv);
+     size_t nRows = 0;
+     {
+       // small blocks and a short queue, so rows are added and the producer waits
+       TableDataSink sink(itsName, casacore::Table(TableTestRunner::msName()), 2, 1000);
+       for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end(); ++it) {
+            sink.write(*it);
+            nRows += it->nRow();
+       }
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(nRows), sink.nRow());
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(420), sink.nChunk());
+       sink.close();
+     }
+     // surplus rows are removed
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(nRows), casacore::uInt64(casacore::Table(itsName).nrow()));
+     TableConstDataSource sinkDS(itsName);
+     IDataConverterPtr sinkConv = sinkDS.createConverter();
+     TableDataSink::configureConverter(*sinkConv);
+     IConstDataSharedIter it = ds.createConstIterator(conv);
+     IConstDataSharedIter sinkIt = sinkDS.createConstIterator(sinkConv);
+     for (; it != it.end(); ++it, ++sinkIt) {
+          CPPUNIT_ASSERT(sinkIt != sinkIt.end());
+          CPPUNIT_ASSERT_EQUAL(it->nRow(), sinkIt->nRow());
+          CPPUNIT_ASSERT_EQUAL(it->nChannel(), sinkIt->nChannel());
+          CPPUNIT_ASSERT_EQUAL(it->nPol(), sinkIt->nPol());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(it->time(), sinkIt->time(), 1e-6);
+          for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+               CPPUNIT_ASSERT_EQUAL(it->antenna1()[row], sinkIt->antenna1()[row]);
+               CPPUNIT_ASSERT_EQUAL(it->antenna2()[row], sinkIt->antenna2()[row]);
+               CPPUNIT_ASSERT_EQUAL(it->feed1()[row], sinkIt->feed1()[row]);
+               for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(it->uvw()[row](dim), sinkIt->uvw()[row](dim), 1e-6);
+               }
+               for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                    for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+                         CPPUNIT_ASSERT(it->visibility()(row, chan, pol) == sinkIt->visibility()(row, chan, pol));
+                         CPPUNIT_ASSERT(it->flag()(row, chan, pol) == sinkIt->flag()(row, chan, pol));
+                         CPPUNIT_ASSERT_DOUBLES_EQUAL(casacore::real(it->noise()(row, chan, pol)),
+                                    casacore::real(sinkIt->noise()(row, chan, pol)), 1e-5);
+                    }
+               }
+          }
+     }
+     CPPUNIT_ASSERT(sinkIt == sinkIt.end());
+  }
+
+  void testShapeChange() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataSelectorPtr sel = ds.createSelector();
+     sel->chooseChannels(4, 3);
+     IConstDataSharedIter it = ds.createConstIterator();
+     IConstDataSharedIter selIt = ds.createConstIterator(sel);
+     TableDataSink sink(itsName);
+     sink.write(*it);
+     // this should generate an exception
+     sink.write(*selIt);
+  }
+
+private:
+  /// @brief name of the measurement set to create
+  std::string itsName;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef TABLE_DATA_SINK_TEST_H
@@ -0,0 +1,102 @@
+/// @file
+/// @brief Tests of the table locking policies
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef TABLE_LOCKING_TEST_H
+#define TABLE_LOCKING_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/TableLocking.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// casa includes
+#include <casacore/casa/IO/FileLocker.h>
+
+namespace askap {
+
+namespace accessors {
+
+class TableLockingTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TableLockingTest);
+  CPPUNIT_TEST(testLockOptions);
+  CPPUNIT_TEST(testUserLocking);
+  CPPUNIT_TEST(testNoLocking);
+  CPPUNIT_TEST_EXCEPTION(testUnknownPolicy,AskapError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testLockOptions() {
+     CPPUNIT_ASSERT(TableLocking::lockOptions("default").option() == casacore::TableLock::DefaultLocking);
+     CPPUNIT_ASSERT(TableLocking::lockOptions("auto").option() == casacore::TableLock::AutoLocking);
+     CPPUNIT_ASSERT(TableLocking::lockOptions("AutoNoRead").option() == casacore::TableLock::AutoNoReadLocking);
+     CPPUNIT_ASSERT(TableLocking::lockOptions("user").option() == casacore::TableLock::UserLocking);
+     CPPUNIT_ASSERT(TableLocking::lockOptions("usernoread").option() == casacore::TableLock::UserNoReadLocking);
+     CPPUNIT_ASSERT(TableLocking::lockOptions("permanent").option() == casacore::TableLock::PermanentLocking);
+     CPPUNIT_ASSERT(TableLocking::lockOptions("NONE").option() == casacore::TableLock::NoLocking);
+  }
+
+  void testUserLocking() {
+     // the read lock is taken when the table is opened and kept
+     const casacore::Table tab = TableLocking::open(TableTestRunner::msName(),
+                                 TableLocking::lockOptions("user"));
+     CPPUNIT_ASSERT(tab.hasLock(casacore::FileLocker::Read));
+     CPPUNIT_ASSERT(tab.nrow() > 0);
+     // no lock at all for usernoread
+     const casacore::Table tab2 = TableLocking::open(TableTestRunner::msName(),
+                                  TableLocking::lockOptions("usernoread"));
+     CPPUNIT_ASSERT(tab2.nrow() > 0);
+  }
+
+  void testNoLocking() {
+     TableConstDataSource ds(TableTestRunner::msName(), "DATA", false,
+                             casacore::TableLock(casacore::TableLock::NoLocking));
+     size_t nRows = 0;
+     for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+          nRows += it->nRow();
+     }
+     TableConstDataSource ds2(TableTestRunner::msName());
+     size_t nRows2 = 0;
+     for (IConstDataSharedIter it = ds2.createConstIterator(); it != it.end(); ++it) {
+          nRows2 += it->nRow();
+     }
+     CPPUNIT_ASSERT(nRows > 0);
+     CPPUNIT_ASSERT_EQUAL(nRows2, nRows);
+  }
+
+  void testUnknownPolicy() {
+     // this should generate an exception
+     TableLocking::lockOptions("sometimes");
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef TABLE_LOCKING_TEST_H
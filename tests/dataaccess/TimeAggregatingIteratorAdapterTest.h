@@ -0,0 +1,149 @@
+/// @file
+/// @brief Tests of the time-aggregating iterator adapter
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifndef TIME_AGGREGATING_ITERATOR_ADAPTER_TEST_H
+#define TIME_AGGREGATING_ITERATOR_ADAPTER_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+// own includes
+#include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/TimeAggregatingIteratorAdapter.h>
+#include <askap/askap/AskapError.h>
+#include "TableTestRunner.h"
+
+// std includes
+#include <algorithm>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+class TimeAggregatingIteratorAdapterTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TimeAggregatingIteratorAdapterTest);
+  CPPUNIT_TEST(testSteps);
+  CPPUNIT_TEST(testRowLimit);
+  CPPUNIT_TEST(testInit);
+  CPPUNIT_TEST_EXCEPTION(testNoBuffers,AskapError);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void testSteps() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     // rows of the original iterator
+     std::vector<double> refTime;
+     std::vector<casacore::Complex> refVis;
+     std::vector<casacore::uInt> refAnt1;
+     for (IConstDataSharedIter rawIt = ds.createConstIterator(conv); rawIt != rawIt.end(); ++rawIt) {
+          for (casacore::uInt row = 0; row < rawIt->nRow(); ++row) {
+               refTime.push_back(rawIt->time());
+               refVis.push_back(rawIt->visibility()(row, 0, 0));
+               refAnt1.push_back(rawIt->antenna1()[row]);
+          }
+     }
+     TimeAggregatingIteratorAdapter it(ds.createConstIterator(conv), 3);
+     size_t rowsSeen = 0;
+     for (; it.hasMore(); it.next()) {
+          const IConstDataAccessor &acc = *it;
+          CPPUNIT_ASSERT(acc.nRow() > 0);
+          CPPUNIT_ASSERT(it.nStepsGathered() > 0);
+          CPPUNIT_ASSERT(it.nStepsGathered() <= 3);
+          const casacore::Vector<casacore::Double> &rowTime = it.rowTime();
+          CPPUNIT_ASSERT_EQUAL(acc.nRow(), casacore::uInt(rowTime.nelements()));
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(rowTime[0], acc.time(), 1e-6);
+          CPPUNIT_ASSERT_EQUAL(acc.nRow(), casacore::uInt(acc.pointingDir1().nelements()));
+          // rows come in the original order
+          for (casacore::uInt row = 0; row < acc.nRow(); ++row, ++rowsSeen) {
+               CPPUNIT_ASSERT(rowsSeen < refTime.size());
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(refTime[rowsSeen], rowTime[row], 1e-6);
+               CPPUNIT_ASSERT_EQUAL(refAnt1[rowsSeen], acc.antenna1()[row]);
+               CPPUNIT_ASSERT(std::abs(refVis[rowsSeen] - acc.visibility()(row, 0, 0)) < 1e-7);
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(refTime.size(), rowsSeen);
+  }
+
+  void testRowLimit() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     casacore::uInt maxStepRows = 0;
+     size_t totalRows = 0;
+     for (IConstDataSharedIter rawIt = ds.createConstIterator(); rawIt != rawIt.end(); ++rawIt) {
+          maxStepRows = std::max(maxStepRows, rawIt->nRow());
+          totalRows += rawIt->nRow();
+     }
+     // at most two steps fit, the step limit is not reached
+     TimeAggregatingIteratorAdapter it(ds.createConstIterator(), 100, 2 * maxStepRows);
+     size_t rowsSeen = 0;
+     for (; it.hasMore(); it.next()) {
+          CPPUNIT_ASSERT(it.nStepsGathered() <= 2);
+          CPPUNIT_ASSERT((*it).nRow() <= 2 * maxStepRows);
+          rowsSeen += (*it).nRow();
+     }
+     CPPUNIT_ASSERT_EQUAL(totalRows, rowsSeen);
+
+     // a byte limit below one step still delivers one step at a time
+     TimeAggregatingIteratorAdapter it2(ds.createConstIterator(), 100, 0, 1);
+     rowsSeen = 0;
+     for (; it2.hasMore(); it2.next()) {
+          CPPUNIT_ASSERT_EQUAL(1u, it2.nStepsGathered());
+          rowsSeen += (*it2).nRow();
+     }
+     CPPUNIT_ASSERT_EQUAL(totalRows, rowsSeen);
+  }
+
+  void testInit() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     TimeAggregatingIteratorAdapter it(ds.createConstIterator(), 4);
+     size_t counter = 0;
+     for (; it.hasMore(); it.next()) {
+          ++counter;
+     }
+     CPPUNIT_ASSERT(counter > 0);
+     it.init();
+     size_t counter2 = 0;
+     for (; it.hasMore(); it.next()) {
+          ++counter2;
+     }
+     CPPUNIT_ASSERT_EQUAL(counter, counter2);
+  }
+
+  void testNoBuffers() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     TimeAggregatingIteratorAdapter it(ds.createConstIterator(), 2);
+     // this should generate an exception
+     it.buffer("TEST");
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef TIME_AGGREGATING_ITERATOR_ADAPTER_TEST_H
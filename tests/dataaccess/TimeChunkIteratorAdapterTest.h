@@ -42,6 +42,12 @@
 #include "TableTestRunner.h"
 #include <askap/askap/AskapUtil.h>
 
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
+
+// std includes
+#include <algorithm>
+
 
 namespace askap {
 
@@ -50,6 +56,7 @@ namespace accessors {
 class TimeChunkIteratorAdapterTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(TimeChunkIteratorAdapterTest);
   CPPUNIT_TEST(testTimeChunks);  
+  CPPUNIT_TEST(testBalancedChunks);  
   CPPUNIT_TEST_EXCEPTION(testReadOnlyBuffer,AskapError);  
   CPPUNIT_TEST_EXCEPTION(testReadOnlyAccessor,AskapError); 
   CPPUNIT_TEST_EXCEPTION(testNoResume,AskapError); 
@@ -89,6 +96,61 @@ public:
      
   }
   
+  void testBalancedChunks() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     // find the total and the largest number of rows per step
+     size_t totalRows = 0;
+     size_t maxRows = 0;
+     for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end(); ++it) {
+          totalRows += it->nRow();
+          maxRows = std::max(maxRows, size_t(it->nRow()));
+     }
+     CPPUNIT_ASSERT(maxRows > 0);
+     const size_t target = 7 * maxRows;
+     boost::shared_ptr<TimeChunkIteratorAdapter> it(new TimeChunkIteratorAdapter(ds.createConstIterator(conv)));
+     it->setTargetVolume(target);
+     size_t rowsSeen = 0;
+     size_t nChunks = 0;
+     for (; it->moreDataAvailable(); ++nChunks) {
+          size_t chunkRows = 0;
+          for (; it->hasMore(); it->next()) {
+               chunkRows += (*it)->nRow();
+          }
+          CPPUNIT_ASSERT_EQUAL(chunkRows, it->chunkVolume());
+          rowsSeen += chunkRows;
+          if (it->moreDataAvailable()) {
+              // all chunks but the last one should be close to the target
+              CPPUNIT_ASSERT(chunkRows + maxRows > target);
+              CPPUNIT_ASSERT(chunkRows < target + maxRows);
+              it->resume();
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(totalRows, rowsSeen);
+     CPPUNIT_ASSERT(nChunks > 1);
+
+     // the time interval acts as the upper limit
+     it.reset(new TimeChunkIteratorAdapter(ds.createConstIterator(conv), 599));
+     it->setTargetVolume(target);
+     for (nChunks = 0; it->moreDataAvailable(); ++nChunks) {
+          CPPUNIT_ASSERT_EQUAL(size_t(1),countSteps(it));
+          if (it->moreDataAvailable()) {
+              it->resume();
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(420), nChunks);     
+
+     // unflagged samples
+     it.reset(new TimeChunkIteratorAdapter(ds.createConstIterator(conv)));
+     it->setTargetVolume(target, TimeChunkIteratorAdapter::UNFLAGGED_SAMPLES);
+     CPPUNIT_ASSERT(it->hasMore());
+     const IConstDataAccessor &acc = *(*it);
+     const size_t unflagged = casacore::nfalse(acc.flag());
+     it->next();
+     CPPUNIT_ASSERT_EQUAL(unflagged, it->chunkVolume());
+  }
+  
   void testReadOnlyBuffer() {
      TableConstDataSource ds(TableTestRunner::msName());
      boost::shared_ptr<TimeChunkIteratorAdapter> it(new TimeChunkIteratorAdapter(ds.createConstIterator()));
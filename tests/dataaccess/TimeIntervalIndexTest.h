@@ -0,0 +1,124 @@
+/// @file
+/// @brief Tests of the time-sorted index of validity intervals
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+/// 
+
+#ifndef TIME_INTERVAL_INDEX_TEST_H
+#define TIME_INTERVAL_INDEX_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// std includes
+#include <vector>
+
+// own includes
+#include <askap/dataaccess/TimeIntervalIndex.h>
+
+namespace askap {
+
+namespace accessors {
+
+class TimeIntervalIndexTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TimeIntervalIndexTest);
+  CPPUNIT_TEST(monotonicTest);
+  CPPUNIT_TEST(randomAccessTest);
+  CPPUNIT_TEST(permanentRowsTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  
+  void monotonicTest() {
+     TimeIntervalIndex index;
+     // non-overlapping intervals 10 seconds long
+     for (casacore::uInt row = 0; row < 100; ++row) {
+          index.add(10. * row, 10. * row + 9.5, row);
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(100), index.size());
+     std::vector<casacore::uInt> rows;
+     for (double time = 0.; time < 1000.; time += 2.5) {
+          index.find(time, rows);
+          const casacore::uInt expected = casacore::uInt(time / 10.);
+          if (time - 10. * expected > 9.5) {
+              CPPUNIT_ASSERT_EQUAL(size_t(0), rows.size());
+          } else {
+              CPPUNIT_ASSERT_EQUAL(size_t(1), rows.size());
+              CPPUNIT_ASSERT_EQUAL(expected, rows[0]);
+          }
+     }
+     // outside the range
+     index.find(-1., rows);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), rows.size());
+     index.find(1e4, rows);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), rows.size());
+  }
+  
+  void randomAccessTest() {
+     TimeIntervalIndex index;
+     // rows are added out of order, a long interval overlaps short ones
+     index.add(20., 30., 2);
+     index.add(0., 100., 0);
+     index.add(10., 20., 1);
+     index.add(30., 40., 3);
+     std::vector<casacore::uInt> rows;
+     index.find(35., rows);
+     CPPUNIT_ASSERT_EQUAL(size_t(2), rows.size());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), rows[0]);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(3), rows[1]);
+     // going back in time, both ends of the interval are inclusive
+     index.find(20., rows);
+     CPPUNIT_ASSERT_EQUAL(size_t(3), rows.size());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), rows[0]);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), rows[1]);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), rows[2]);
+     index.find(50., rows);
+     CPPUNIT_ASSERT_EQUAL(size_t(1), rows.size());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), rows[0]);
+     index.find(5., rows);
+     CPPUNIT_ASSERT_EQUAL(size_t(1), rows.size());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), rows[0]);
+  }
+  
+  void permanentRowsTest() {
+     TimeIntervalIndex index;
+     index.addPermanent(5);
+     index.add(10., 20., 3);
+     std::vector<casacore::uInt> rows;
+     index.find(0., rows);
+     CPPUNIT_ASSERT_EQUAL(size_t(1), rows.size());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(5), rows[0]);
+     index.find(15., rows);
+     CPPUNIT_ASSERT_EQUAL(size_t(2), rows.size());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(3), rows[0]);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(5), rows[1]);
+     CPPUNIT_ASSERT_EQUAL(size_t(2), index.size());
+  }
+}; // class TimeIntervalIndexTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef TIME_INTERVAL_INDEX_TEST_H
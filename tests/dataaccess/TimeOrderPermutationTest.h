@@ -0,0 +1,119 @@
+/// @file
+/// @brief Tests of the permutation putting rows in the time order
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+/// 
+
+#ifndef TIME_ORDER_PERMUTATION_TEST_H
+#define TIME_ORDER_PERMUTATION_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+
+// own includes
+#include <askap/dataaccess/TimeOrderPermutation.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+class TimeOrderPermutationTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TimeOrderPermutationTest);
+  CPPUNIT_TEST(smallSortTest);
+  CPPUNIT_TEST(parallelSortTest);
+  CPPUNIT_TEST(orderTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  
+  void smallSortTest() {
+     // two interleaved time steps as after merging two datasets
+     casacore::Vector<casacore::Double> time(6);
+     time[0] = 20.; time[1] = 10.; time[2] = 20.; time[3] = 10.; time[4] = 30.; time[5] = 10.;
+     TimeOrderPermutation permutation(time);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(6), permutation.nrow());
+     // the sort is stable
+     const casacore::uInt expected[] = {1, 3, 5, 0, 2, 4};
+     for (casacore::uInt index = 0; index < 6; ++index) {
+          CPPUNIT_ASSERT_EQUAL(expected[index], permutation.rows()[index]);
+     }
+     // an empty table
+     casacore::Vector<casacore::uInt> rows;
+     TimeOrderPermutation::sort(casacore::Vector<casacore::Double>(), rows);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), rows.nelements());
+  }
+
+  void parallelSortTest() {
+     // large enough to be split between threads, a few rows per time stamp
+     const casacore::uInt nRow = 1000003;
+     casacore::Vector<casacore::Double> time(nRow);
+     for (casacore::uInt row = 0; row < nRow; ++row) {
+          time[row] = double((size_t(row) * 7919) % 65537 / 3);
+     }
+     casacore::Vector<casacore::uInt> serial;
+     TimeOrderPermutation::sort(time, serial, 1);
+     casacore::Vector<casacore::uInt> parallel;
+     TimeOrderPermutation::sort(time, parallel, 5);
+     CPPUNIT_ASSERT_EQUAL(nRow, serial.nelements());
+     CPPUNIT_ASSERT_EQUAL(nRow, parallel.nelements());
+     for (casacore::uInt index = 0; index < nRow; ++index) {
+          CPPUNIT_ASSERT_EQUAL(serial[index], parallel[index]);
+          if (index > 0) {
+              const casacore::Double prev = time[parallel[index - 1]];
+              const casacore::Double cur = time[parallel[index]];
+              CPPUNIT_ASSERT(prev <= cur);
+              if (prev == cur) {
+                  CPPUNIT_ASSERT(parallel[index - 1] < parallel[index]);
+              }
+          }
+     }
+  }
+
+  void orderTest() {
+     casacore::Vector<casacore::Double> time(5);
+     time[0] = 4.; time[1] = 3.; time[2] = 2.; time[3] = 1.; time[4] = 0.;
+     TimeOrderPermutation permutation(time);
+     casacore::Vector<casacore::uInt> selected(3);
+     selected[0] = 0; selected[1] = 4; selected[2] = 2;
+     casacore::Vector<casacore::uInt> sorted;
+     permutation.order(selected, sorted);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(3), sorted.nelements());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(4), sorted[0]);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), sorted[1]);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), sorted[2]);
+     // rows outside the table
+     selected[1] = 5;
+     CPPUNIT_ASSERT_THROW(permutation.order(selected, sorted), AskapError);
+  }
+}; // class TimeOrderPermutationTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef TIME_ORDER_PERMUTATION_TEST_H
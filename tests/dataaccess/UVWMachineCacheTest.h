@@ -31,6 +31,7 @@
 #define UVW_MACHINE_CACHE_TEST_H
 
 #include <askap/dataaccess/UVWMachineCache.h>
+#include <askap/dataaccess/UVWRotationKernel.h>
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <casacore/casa/Quanta/MVDirection.h>
@@ -45,6 +46,8 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <vector>
+
 namespace askap {
 
 namespace accessors {
@@ -53,8 +56,12 @@ class UVWMachineCacheTest : public CppUnit::TestFixture {
    CPPUNIT_TEST_SUITE(UVWMachineCacheTest);
    CPPUNIT_TEST(uvwMachineTest);
    CPPUNIT_TEST_EXCEPTION(exceptionTest,AskapError);
+   CPPUNIT_TEST_EXCEPTION(zeroToleranceTest,AskapError);
    CPPUNIT_TEST(oneElementCacheTest);
    CPPUNIT_TEST(twoElementsCacheTest);
+   CPPUNIT_TEST(hashedLookupTest);
+   CPPUNIT_TEST(parallelLookupTest);
+   CPPUNIT_TEST(rotationKernelTest);
    CPPUNIT_TEST(uvwMachineFrameConvTest);
    CPPUNIT_TEST_SUITE_END();
 public:
@@ -66,6 +73,11 @@ public:
       itsMachineCache.reset(new UVWMachineCache(0,1e-6));
       testCaching();
    };
+
+   void zeroToleranceTest() {
+      // the tolerance defines the cell size of the hash keys, zero is not allowed
+      itsMachineCache.reset(new UVWMachineCache(1,0.));
+   }
    
    /// @brief calculate uvw from first principles
    /// @details
@@ -235,6 +247,92 @@ public:
       itsMachineCache.reset(new UVWMachineCache(2,1e-6));
       testCaching();
    }
+
+   void hashedLookupTest() {
+      itsMachineCache.reset(new UVWMachineCache(4,1e-6));
+      testCaching();
+      const casacore::MDirection tangent(casacore::MVDirection(0.3, -0.5), casacore::MDirection::J2000);
+      const UVWMachineCache::machineType *machine = 0;
+      // directions within the tolerance should give the same machine regardless of the
+      // quantisation cell they fall into
+      for (int step = 0; step < 10; ++step) {
+           const casacore::MDirection phaseCentre(casacore::MVDirection(0.3 + 1e-7 * step, -0.5), 
+                                                  casacore::MDirection::J2000);
+           const UVWMachineCache::machineType &current = itsMachineCache->machine(phaseCentre, tangent);
+           if (machine == 0) {
+               machine = &current;
+           }
+           CPPUNIT_ASSERT(machine == &current);
+      }
+      // frames are compared too
+      const casacore::MDirection phaseCentre(casacore::MVDirection(0.3, -0.5), casacore::MDirection::B1950);
+      CPPUNIT_ASSERT(machine != &itsMachineCache->machine(phaseCentre, tangent));
+   }
+
+   void rotationKernelTest() {
+      const casacore::MDirection tangent(casacore::MVDirection(0.3, -0.5), casacore::MDirection::J2000);
+      const casacore::MDirection phaseCentre(casacore::MVDirection(0.32, -0.45), casacore::MDirection::J2000);
+      const UVWMachineCache::machineType machine(tangent, phaseCentre, false, false);
+      const UVWRotationKernel kernel(machine);
+      const casacore::uInt nRow = 10;
+      casacore::Vector<casacore::RigidVector<double, 3> > uvw(nRow), rotated(nRow);
+      casacore::Vector<double> delays(nRow, 0.);
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           uvw[row](0) = 1000. - 230. * row;
+           uvw[row](1) = -3250. + 71. * row;
+           uvw[row](2) = 12.5 * row;
+      }
+      // only part of the rows
+      kernel.apply(uvw, 2, nRow, rotated, delays);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., delays[1], 1e-12);
+      for (casacore::uInt row = 2; row < nRow; ++row) {
+           // the same convention as used in UVWRotationHandler
+           casacore::Vector<double> buf(3);
+           for (int i = 0; i < 3; ++i) {
+                buf[i] = (i < 2 ? -1. : 1.) * uvw[row](i);
+           }
+           double delay = 0.;
+           machine.convertUVW(delay, buf);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(delay, delays[row], 1e-6);
+           for (int i = 0; i < 3; ++i) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL((i < 2 ? -1. : 1.) * buf[i], rotated[row](i), 1e-6);
+           }
+      }
+   }
+
+   void parallelLookupTest() {
+      itsMachineCache.reset(new UVWMachineCache(8,1e-6));
+      const casacore::MDirection tangent(casacore::MVDirection(0.3, -0.5), casacore::MDirection::J2000);
+      const int nBeams = 6;
+      // reference machines are set up in advance, measures are not thread-safe
+      std::vector<casacore::MDirection> phaseCentres;
+      std::vector<boost::shared_ptr<UVWMachineCache::machineType> > machines;
+      for (int beam = 0; beam < nBeams; ++beam) {
+           phaseCentres.push_back(casacore::MDirection(casacore::MVDirection(0.3 + 0.01 * beam, -0.5),
+                                  casacore::MDirection::J2000));
+           machines.push_back(boost::shared_ptr<UVWMachineCache::machineType>(
+                    new UVWMachineCache::machineType(tangent, phaseCentres.back(), false, false)));
+      }
+      int nErrors = 0;
+      #pragma omp parallel for reduction(+:nErrors)
+      for (int iter = 0; iter < 60; ++iter) {
+           const casacore::MDirection &phaseCentre = phaseCentres[iter % nBeams];
+           const UVWMachineCache::machineType &cachedMachine = itsMachineCache->machine(phaseCentre, tangent);
+           const UVWMachineCache::machineType &machine = *machines[iter % nBeams];
+           casacore::Vector<double> uvw(3), uvwCopy(3);
+           uvw[0] = uvwCopy[0] = 1000.0; 
+           uvw[1] = uvwCopy[1] = -3250.0; 
+           uvw[2] = uvwCopy[2] = 12.5;
+           double delay = 0, delayCopy = 0;
+           cachedMachine.convertUVW(delay, uvw);
+           machine.convertUVW(delayCopy, uvwCopy);
+           if ((fabs(delay - delayCopy) > 1e-6) || (fabs(uvw[0] - uvwCopy[0]) > 1e-6) ||
+               (fabs(uvw[1] - uvwCopy[1]) > 1e-6) || (fabs(uvw[2] - uvwCopy[2]) > 1e-6)) {
+               ++nErrors;
+           }
+      }
+      CPPUNIT_ASSERT_EQUAL(0, nErrors);
+   }
    
 protected:
    void testCaching() const {
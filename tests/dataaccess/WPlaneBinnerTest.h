@@ -0,0 +1,172 @@
+/// @file
+/// @brief Tests of the ordering of the chunk rows by w-plane
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+///
+
+#ifndef W_PLANE_BINNER_TEST_H
+#define W_PLANE_BINNER_TEST_H
+
+// cppunit includes
+#include <cppunit/extensions/HelperMacros.h>
+
+// own includes
+#include <askap/dataaccess/WPlaneBinner.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+class WPlaneBinnerTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(WPlaneBinnerTest);
+  CPPUNIT_TEST(uniformPlanesTest);
+  CPPUNIT_TEST(explicitBoundariesTest);
+  CPPUNIT_TEST(copyDataTest);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void uniformPlanesTest() {
+     DataAccessorStub acc(true);
+     double wMax = 0.;
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          wMax = std::max(wMax, std::abs(acc.uvw()[row](2)));
+     }
+     CPPUNIT_ASSERT(wMax > 0.);
+     WPlaneBinner binner(8, wMax);
+     CPPUNIT_ASSERT_EQUAL(8u, binner.nPlanes());
+     CPPUNIT_ASSERT_EQUAL(0u, binner.plane(-wMax));
+     CPPUNIT_ASSERT_EQUAL(4u, binner.plane(0.));
+     CPPUNIT_ASSERT_EQUAL(7u, binner.plane(wMax));
+     CPPUNIT_ASSERT_EQUAL(0u, binner.plane(-2. * wMax));
+     CPPUNIT_ASSERT_EQUAL(7u, binner.plane(2. * wMax));
+     binner.bin(acc);
+     checkBinning(binner, acc.uvw());
+     CPPUNIT_ASSERT_EQUAL(0u, binner.nOutside());
+     // the buffers are reused for the next chunk
+     binner.bin(acc);
+     checkBinning(binner, acc.uvw());
+  }
+
+  void explicitBoundariesTest() {
+     DataAccessorStub acc(true);
+     std::vector<double> boundaries;
+     boundaries.push_back(-100.);
+     boundaries.push_back(0.);
+     boundaries.push_back(10.);
+     boundaries.push_back(100.);
+     WPlaneBinner binner(boundaries);
+     CPPUNIT_ASSERT_EQUAL(3u, binner.nPlanes());
+     CPPUNIT_ASSERT_EQUAL(0u, binner.plane(-1000.));
+     CPPUNIT_ASSERT_EQUAL(0u, binner.plane(-100.));
+     CPPUNIT_ASSERT_EQUAL(1u, binner.plane(0.));
+     CPPUNIT_ASSERT_EQUAL(1u, binner.plane(5.));
+     CPPUNIT_ASSERT_EQUAL(2u, binner.plane(10.));
+     CPPUNIT_ASSERT_EQUAL(2u, binner.plane(1000.));
+     binner.bin(acc);
+     checkBinning(binner, acc.uvw());
+     casacore::uInt nOutside = 0;
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          if (std::abs(acc.uvw()[row](2)) > 100.) {
+              ++nOutside;
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(nOutside, binner.nOutside());
+  }
+
+  void copyDataTest() {
+     DataAccessorStub acc(true);
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          acc.itsVisibility.yzPlane(row).set(casacore::Complex(float(row), -1.));
+          acc.itsFlag.yzPlane(row).set(row % 3 == 0);
+     }
+     WPlaneBinner binner(5, 1000.);
+     const casacore::MDirection tangent(acc.pointingDir1()[0], casacore::MDirection::J2000);
+     binner.bin(acc, tangent, true);
+     checkBinning(binner, acc.rotatedUVW(tangent));
+     CPPUNIT_ASSERT(binner.visibility().shape() == acc.visibility().shape());
+     CPPUNIT_ASSERT(binner.flag().shape() == acc.flag().shape());
+     CPPUNIT_ASSERT_EQUAL(acc.nRow(), casacore::uInt(binner.uvw().nelements()));
+     for (casacore::uInt row = 0; row < binner.nRow(); ++row) {
+          const casacore::uInt origRow = binner.permutation()[row];
+          for (casacore::uInt dim = 0; dim < 3; ++dim) {
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(acc.rotatedUVW(tangent)[origRow](dim), binner.uvw()[row](dim), 1e-9);
+          }
+          for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+               for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+                    CPPUNIT_ASSERT(acc.visibility()(origRow, chan, pol) == binner.visibility()(row, chan, pol));
+                    CPPUNIT_ASSERT_EQUAL(acc.flag()(origRow, chan, pol), binner.flag()(row, chan, pol));
+               }
+          }
+     }
+     // scatter is the inverse of gather
+     casacore::Cube<casacore::Complex> restored;
+     binner.scatter(binner.visibility(), restored);
+     CPPUNIT_ASSERT(restored.shape() == acc.visibility().shape());
+     for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+          CPPUNIT_ASSERT(restored(row, 0, 0) == acc.visibility()(row, 0, 0));
+     }
+     // the copies are released if the data are not requested
+     binner.bin(acc);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), binner.visibility().nelements());
+     CPPUNIT_ASSERT_EQUAL(size_t(0), binner.uvw().nelements());
+  }
+
+protected:
+  /// @brief check that the rows are ordered by plane and the order is kept within each plane
+  /// @param[in] binner binner after the call to bin
+  /// @param[in] uvw uvw used for binning
+  static void checkBinning(const WPlaneBinner &binner,
+                           const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw) {
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(uvw.nelements()), binner.nRow());
+     std::vector<bool> seen(binner.nRow(), false);
+     casacore::uInt total = 0;
+     for (casacore::uInt plane = 0; plane < binner.nPlanes(); ++plane) {
+          CPPUNIT_ASSERT_EQUAL(total, binner.planeStart(plane));
+          for (casacore::uInt pos = binner.planeStart(plane); pos < binner.planeStart(plane) + binner.planeSize(plane); ++pos) {
+               const casacore::uInt row = binner.permutation()[pos];
+               CPPUNIT_ASSERT(row < binner.nRow());
+               CPPUNIT_ASSERT(!seen[row]);
+               seen[row] = true;
+               CPPUNIT_ASSERT_EQUAL(plane, binner.plane(uvw[row](2)));
+               if (pos > binner.planeStart(plane)) {
+                   CPPUNIT_ASSERT(binner.permutation()[pos - 1] < row);
+               }
+          }
+          total += binner.planeSize(plane);
+     }
+     CPPUNIT_ASSERT_EQUAL(binner.nRow(), total);
+  }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef W_PLANE_BINNER_TEST_H
@@ -37,6 +37,35 @@
 #include "DataAccessorAdapterTest.h"
 #include "CachedAccessorFieldTest.h"
 #include "TimeChunkIteratorAdapterTest.h"
+#include "CubeTransposerTest.h"
+#include "PackedFlagCubeTest.h"
+#include "ReusableBufferTest.h"
+#include "BufferCodecTest.h"
+#include "TimeIntervalIndexTest.h"
+#include "TimeOrderPermutationTest.h"
+#include "AveragingIteratorAdapterTest.h"
+#include "BDAIteratorAdapterTest.h"
+#include "MultiTableDataSourceTest.h"
+#include "StreamDataSourceTest.h"
+#include "SharedMemoryTransportTest.h"
+#include "AsyncDataIteratorTest.h"
+#include "IteratorStatisticsTest.h"
+#include "AccessTracerTest.h"
+#include "AccessorSnapshotTest.h"
+#include "BaselineMajorIteratorAdapterTest.h"
+#include "ColumnarDataSourceTest.h"
+#include "MemoryGovernorTest.h"
+#include "WPlaneBinnerTest.h"
+#include "CompactVisibilityCubeTest.h"
+#include "SyntheticDataSourceTest.h"
+#include "TimeAggregatingIteratorAdapterTest.h"
+#include "ChunkPoolTest.h"
+#include "TableLockingTest.h"
+#include "HardwareCountersTest.h"
+#include "DataAccessFactoryTest.h"
+#include "TableDataSinkTest.h"
+#include "SmearingAccessorAdapterTest.h"
+#include "IOSchedulerTest.h"
 
 #include "TableTestRunner.h"
 
@@ -52,6 +81,35 @@ int main(int argc, char *argv[])
    runner.addTest(askap::accessors::DataAccessorAdapterTest::suite());
    runner.addTest(askap::accessors::CachedAccessorFieldTest::suite());
    runner.addTest(askap::accessors::TimeChunkIteratorAdapterTest::suite());
+   runner.addTest(askap::accessors::CubeTransposerTest::suite());
+   runner.addTest(askap::accessors::PackedFlagCubeTest::suite());
+   runner.addTest(askap::accessors::ReusableBufferTest::suite());
+   runner.addTest(askap::accessors::BufferCodecTest::suite());
+   runner.addTest(askap::accessors::TimeIntervalIndexTest::suite());
+   runner.addTest(askap::accessors::TimeOrderPermutationTest::suite());
+   runner.addTest(askap::accessors::AveragingIteratorAdapterTest::suite());
+   runner.addTest(askap::accessors::BDAIteratorAdapterTest::suite());
+   runner.addTest(askap::accessors::MultiTableDataSourceTest::suite());
+   runner.addTest(askap::accessors::StreamDataSourceTest::suite());
+   runner.addTest(askap::accessors::SharedMemoryTransportTest::suite());
+   runner.addTest(askap::accessors::AsyncDataIteratorTest::suite());
+   runner.addTest(askap::accessors::IteratorStatisticsTest::suite());
+   runner.addTest(askap::accessors::AccessTracerTest::suite());
+   runner.addTest(askap::accessors::AccessorSnapshotTest::suite());
+   runner.addTest(askap::accessors::BaselineMajorIteratorAdapterTest::suite());
+   runner.addTest(askap::accessors::ColumnarDataSourceTest::suite());
+   runner.addTest(askap::accessors::MemoryGovernorTest::suite());
+   runner.addTest(askap::accessors::WPlaneBinnerTest::suite());
+   runner.addTest(askap::accessors::CompactVisibilityCubeTest::suite());
+   runner.addTest(askap::accessors::SyntheticDataSourceTest::suite());
+   runner.addTest(askap::accessors::TimeAggregatingIteratorAdapterTest::suite());
+   runner.addTest(askap::accessors::ChunkPoolTest::suite());
+   runner.addTest(askap::accessors::TableLockingTest::suite());
+   runner.addTest(askap::accessors::HardwareCountersTest::suite());
+   runner.addTest(askap::accessors::DataAccessFactoryTest::suite());
+   runner.addTest(askap::accessors::TableDataSinkTest::suite());
+   runner.addTest(askap::accessors::SmearingAccessorAdapterTest::suite());
+   runner.addTest(askap::accessors::IOSchedulerTest::suite());
    runner.run();
    return 0;
  }
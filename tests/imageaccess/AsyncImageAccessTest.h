@@ -0,0 +1,125 @@
+/// @file
+///
+/// Unit test for the asynchronous image access wrapper
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/imageaccess/AsyncImageAccess.h>
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap/askap/AskapError.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+#include <casacore/coordinates/Coordinates/LinearCoordinate.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+class AsyncImageAccessTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(AsyncImageAccessTest);
+   CPPUNIT_TEST(testWriteOrder);
+   CPPUNIT_TEST(testMetadata);
+   CPPUNIT_TEST(testError);
+   CPPUNIT_TEST_SUITE_END();
+public:
+
+   void setUp() {
+      itsMemory.reset(new MemoryImageAccess);
+   }
+
+   void testWriteOrder() {
+      const std::string name = "tmp.asyncimage";
+      const casacore::IPosition shape(3,10,8,20);
+      AsyncImageAccess acc(itsMemory, 4);
+      acc.create(name, shape, makeCoords(3));
+      // the buffer is reused straight away, queued writes keep their own copies
+      casacore::Array<float> plane(casacore::IPosition(2,10,8));
+      for (casacore::Int z = 0; z < shape(2); ++z) {
+           plane.set(float(z));
+           acc.write(name, plane, casacore::IPosition(3,0,0,z));
+           CPPUNIT_ASSERT(acc.nQueued() <= 4);
+      }
+      AsyncImageAccess::Future last = acc.lastRequest();
+      last.wait();
+      CPPUNIT_ASSERT(last.is_ready());
+      CPPUNIT_ASSERT(!last.has_exception());
+      // reads wait for the queue
+      const casacore::Array<float> result = acc.read(name);
+      CPPUNIT_ASSERT_EQUAL(size_t(0), acc.nQueued());
+      for (casacore::Int z = 0; z < shape(2); ++z) {
+           CPPUNIT_ASSERT(fabs(result(casacore::IPosition(3,3,2,z)) - float(z)) < 1e-7);
+      }
+   }
+
+   void testMetadata() {
+      const std::string name = "tmp.asyncimagemetadata";
+      AsyncImageAccess acc(itsMemory);
+      acc.create(name, casacore::IPosition(2,5,5), makeCoords(2));
+      acc.setUnits(name, "Jy");
+      acc.setUnits(name, "Jy/beam");
+      acc.setMetadataKeyword(name, "OBJECT", "first");
+      acc.setMetadataKeyword(name, "OBJECT", "second");
+      acc.addHistory(name, "one");
+      acc.addHistory(name, "two");
+      // metadata are held back until the next pixel operation or wait
+      acc.wait();
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), itsMemory->getUnits(name));
+      CPPUNIT_ASSERT_EQUAL(std::string("second"), itsMemory->getMetadataKeyword(name, "OBJECT"));
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), acc.getUnits(name));
+   }
+
+   void testError() {
+      AsyncImageAccess acc(itsMemory);
+      // the image doesn't exist, the error is reported by the future and by wait
+      acc.write("tmp.nonexistent", casacore::Array<float>(casacore::IPosition(2,2,2), 0.f));
+      AsyncImageAccess::Future failed = acc.lastRequest();
+      failed.wait();
+      CPPUNIT_ASSERT(failed.has_exception());
+      CPPUNIT_ASSERT_THROW(acc.wait(), AskapError);
+      // the error is reported once
+      acc.wait();
+   }
+
+protected:
+
+   static casacore::CoordinateSystem makeCoords(const casacore::uInt nAxes) {
+      casacore::CoordinateSystem coordsys;
+      coordsys.addCoordinate(casacore::LinearCoordinate(nAxes));
+      return coordsys;
+   }
+
+private:
+   boost::shared_ptr<MemoryImageAccess> itsMemory;
+};
+
+} // namespace accessors
+
+} // namespace askap
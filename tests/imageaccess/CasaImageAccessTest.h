@@ -28,16 +28,20 @@
 /// @author Max Voronkov <maxim.voronkov@csiro.au>
 
 #include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/CasaImageAccess.h>
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/coordinates/Coordinates/LinearCoordinate.h>
 #include <casacore/images/Regions/ImageRegion.h>
 #include <casacore/images/Regions/RegionHandler.h>
 
 
 #include <boost/shared_ptr.hpp>
+#include <boost/ref.hpp>
 
 #include <Common/ParameterSet.h>
 
@@ -50,6 +54,10 @@ class CasaImageAccessTest : public CppUnit::TestFixture
 {
    CPPUNIT_TEST_SUITE(CasaImageAccessTest);
    CPPUNIT_TEST(testReadWrite);
+   CPPUNIT_TEST(testRecreate);
+   CPPUNIT_TEST(testTiling);
+   CPPUNIT_TEST(testMaskedRead);
+   CPPUNIT_TEST(testSlabs);
    CPPUNIT_TEST_SUITE_END();
 public:
    void setUp() {
@@ -119,8 +127,175 @@ public:
 
    }
 
+   void testRecreate() {
+      const std::string name = "tmp.testimage2";
+      CPPUNIT_ASSERT(itsImageAccessor);
+      casacore::CoordinateSystem coordsys(makeCoords());
+      itsImageAccessor->create(name, casacore::IPosition(2,10,5), coordsys);
+      // write row by row, the image is kept open between calls
+      casacore::Vector<float> vec(10);
+      for (int y=0; y<5; ++y) {
+           vec.set(float(y));
+           itsImageAccessor->write(name,vec,casacore::IPosition(2,0,y));
+      }
+      itsImageAccessor->flush();
+      casacore::Array<float> readBack = itsImageAccessor->read(name);
+      CPPUNIT_ASSERT(readBack.shape() == casacore::IPosition(2,10,5));
+      CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(2,3,4)) - 4.)<1e-7);
+      // the cached image must not be used after the image is recreated
+      const casacore::IPosition newShape(2,4,3);
+      itsImageAccessor->create(name, newShape, coordsys);
+      CPPUNIT_ASSERT(itsImageAccessor->shape(name) == newShape);
+      casacore::Array<float> arr(newShape, 3.);
+      itsImageAccessor->write(name,arr);
+      itsImageAccessor->close(name);
+      // the image is reopened
+      readBack = itsImageAccessor->read(name);
+      CPPUNIT_ASSERT(readBack.shape() == newShape);
+      CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(2,3,2)) - 3.)<1e-7);
+   }
+
+   void testTiling() {
+      const std::string name = "tmp.testimage3";
+      const casacore::IPosition shape(3,10,6,100);
+      casacore::Vector<casacore::String> names(3,"x");
+      casacore::Matrix<double> xform(3,3,0.);
+      xform.diagonal() = 1.;
+      casacore::LinearCoordinate linear(names, casacore::Vector<casacore::String>(3,"pixel"),
+             casacore::Vector<double>(3,0.),casacore::Vector<double>(3,1.), xform, casacore::Vector<double>(3,0.));
+      casacore::CoordinateSystem coordsys;
+      coordsys.addCoordinate(linear);
+      // without spectral and direction coordinates, the last axis is assumed to be spectral
+      CPPUNIT_ASSERT(CasaImageAccess::makeTileShape(shape, coordsys, CasaImageAccess::SPECTRAL) == 
+                     casacore::IPosition(3,4,4,100));
+      CPPUNIT_ASSERT(CasaImageAccess::makeTileShape(shape, coordsys, CasaImageAccess::SPATIAL) == 
+                     casacore::IPosition(3,10,6,1));
+
+      CasaImageAccess acc;
+      acc.setTiling(CasaImageAccess::SPECTRAL);
+      acc.create(name, shape, coordsys);
+      casacore::Array<float> arr(shape, 1.);
+      acc.write(name, arr);
+      CPPUNIT_ASSERT(acc.tileShape(name) == casacore::IPosition(3,4,4,100));
+      // explicit tile shape takes precedence
+      acc.setTileShape(casacore::IPosition(3,5,3,10));
+      acc.create(name, shape, coordsys);
+      acc.write(name, arr);
+      CPPUNIT_ASSERT(acc.tileShape(name) == casacore::IPosition(3,5,3,10));
+      TileCounter counter;
+      acc.readTiles(name, boost::ref(counter));
+      CPPUNIT_ASSERT_EQUAL(size_t(40), counter.itsNTiles);
+      CPPUNIT_ASSERT(fabs(counter.itsSum - double(shape.product())) < 1e-6);
+   }
+
+   void testMaskedRead() {
+      const std::string name = "tmp.testimage4";
+      const casacore::IPosition shape(2,10,5);
+      CasaImageAccess acc;
+      // small tiles, so the mask is applied in a number of chunks
+      acc.setTileShape(casacore::IPosition(2,10,2));
+      acc.create(name, shape, makeCoords());
+      casacore::Array<float> arr(shape);
+      for (int x = 0; x < 10; ++x) {
+           for (int y = 0; y < 5; ++y) {
+                arr(casacore::IPosition(2,x,y)) = float(1 + x + 10 * y);
+           }
+      }
+      acc.write(name, arr);
+      // no mask, all pixels are returned as they are
+      casacore::Array<float> pixels;
+      casacore::Array<bool> mask;
+      acc.readWithMask(name, pixels, mask);
+      CPPUNIT_ASSERT(pixels.shape() == shape);
+      CPPUNIT_ASSERT(mask.shape() == shape);
+      CPPUNIT_ASSERT(casacore::allEQ(mask, true));
+      acc.makeDefaultMask(name);
+      casacore::Array<bool> newMask(shape, true);
+      newMask(casacore::IPosition(2,3,0)) = false;
+      newMask(casacore::IPosition(2,7,4)) = false;
+      acc.writeMask(name, newMask);
+      const casacore::Array<float> readBack = acc.read(name);
+      CPPUNIT_ASSERT(readBack.shape() == shape);
+      for (int x = 0; x < 10; ++x) {
+           for (int y = 0; y < 5; ++y) {
+                const casacore::IPosition index(2,x,y);
+                const float expected = newMask(index) ? arr(index) : 0.;
+                CPPUNIT_ASSERT(fabs(readBack(index) - expected) < 1e-7);
+           }
+      }
+      // slice with the mask
+      acc.readWithMask(name, casacore::IPosition(2,2,3), casacore::IPosition(2,8,4), pixels, mask);
+      CPPUNIT_ASSERT(pixels.shape() == casacore::IPosition(2,7,2));
+      CPPUNIT_ASSERT(mask.shape() == casacore::IPosition(2,7,2));
+      CPPUNIT_ASSERT(!mask(casacore::IPosition(2,5,1)));
+      CPPUNIT_ASSERT(fabs(pixels(casacore::IPosition(2,5,1))) < 1e-7);
+      CPPUNIT_ASSERT(mask(casacore::IPosition(2,6,1)));
+      CPPUNIT_ASSERT(fabs(pixels(casacore::IPosition(2,6,1)) - 49.) < 1e-7);
+   }
+
+   void testSlabs() {
+      const std::string name = "tmp.testimage5";
+      const casacore::IPosition shape(3,10,6,7);
+      casacore::Vector<casacore::String> names(3,"x");
+      casacore::Matrix<double> xform(3,3,0.);
+      xform.diagonal() = 1.;
+      casacore::LinearCoordinate linear(names, casacore::Vector<casacore::String>(3,"pixel"),
+             casacore::Vector<double>(3,0.),casacore::Vector<double>(3,1.), xform, casacore::Vector<double>(3,0.));
+      casacore::CoordinateSystem coordsys;
+      coordsys.addCoordinate(linear);
+      // planes are distributed as 3 + 2 + 2
+      const casacore::uInt nSlabs = 3;
+      casacore::IPosition blc;
+      casacore::IPosition slabShape;
+      CasaImageAccess::slabExtent(shape, coordsys, 1, nSlabs, blc, slabShape);
+      CPPUNIT_ASSERT(blc == casacore::IPosition(3,0,0,3));
+      CPPUNIT_ASSERT(slabShape == casacore::IPosition(3,10,6,2));
+      // each slab is written by its own accessor, as it would be done by different ranks
+      for (casacore::uInt slab = 0; slab < nSlabs; ++slab) {
+           CasaImageAccess acc;
+           const std::string slabImage = acc.createSlab(name, shape, coordsys, slab, nSlabs);
+           CPPUNIT_ASSERT_EQUAL(CasaImageAccess::slabName(name, slab), slabImage);
+           CasaImageAccess::slabExtent(shape, coordsys, slab, nSlabs, blc, slabShape);
+           casacore::Array<float> arr(slabShape);
+           for (ssize_t plane = 0; plane < slabShape(2); ++plane) {
+                arr(casacore::IPosition(3,0,0,plane), casacore::IPosition(3,9,5,plane)) = float(blc(2) + plane);
+           }
+           acc.write(slabImage, arr);
+           CPPUNIT_ASSERT(acc.coordSys(slabImage).referencePixel()(2) == -double(blc(2)));
+      }
+      CasaImageAccess acc;
+      acc.concatenateSlabs(name, nSlabs);
+      CPPUNIT_ASSERT(acc.shape(name) == shape);
+      const casacore::Array<float> readBack = acc.read(name);
+      CPPUNIT_ASSERT(readBack.shape() == shape);
+      for (ssize_t plane = 0; plane < shape(2); ++plane) {
+           CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,4,3,plane)) - float(plane)) < 1e-7);
+      }
+      // writes through the virtual image go into the slabs
+      acc.write(name, casacore::Array<float>(casacore::IPosition(3,1,1,2), -1.), casacore::IPosition(3,2,2,2));
+      acc.close(name);
+      CPPUNIT_ASSERT(fabs(acc.read(CasaImageAccess::slabName(name, 0))(casacore::IPosition(3,2,2,2)) + 1.) < 1e-7);
+      CPPUNIT_ASSERT(fabs(acc.read(CasaImageAccess::slabName(name, 1))(casacore::IPosition(3,2,2,0)) + 1.) < 1e-7);
+      // monolithic copy
+      CasaImageAccess::merge(name, name + ".merged");
+      const casacore::Array<float> merged = acc.read(name + ".merged");
+      CPPUNIT_ASSERT(merged.shape() == shape);
+      CPPUNIT_ASSERT(casacore::allEQ(merged, acc.read(name)));
+   }
+
 protected:
 
+   /// @brief helper functor to count tiles and sum their pixels
+   struct TileCounter {
+      TileCounter() : itsNTiles(0), itsSum(0.) {}
+      void operator()(const casacore::Array<float> &tile, const casacore::IPosition &) {
+         ++itsNTiles;
+         itsSum += casacore::sum(tile);
+      }
+      size_t itsNTiles;
+      double itsSum;
+   };
+
    casacore::CoordinateSystem makeCoords() {
       casacore::Vector<casacore::String> names(2);
       names[0]="x"; names[1]="y";
@@ -28,12 +28,19 @@
 /// @author Steve Ord <stephen.ord@csiro.au>
 
 #include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/ImagePlaneIterator.h>
+#include <askap/imageaccess/ImagePlaneWriter.h>
+#include <askap/imageaccess/FitsImageAccess.h>
+#include <askap/imageaccess/FITSSliceReader.h>
+#include <askap/imageaccess/FITSHeaderReader.h>
+#include <askap/imageaccess/CutoutGrouper.h>
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
+#include <casacore/casa/BasicMath/Math.h>
 
 #include <casacore/coordinates/Coordinates/LinearCoordinate.h>
 #include <casacore/coordinates/Coordinates/DirectionCoordinate.h>
@@ -47,9 +54,13 @@
 #include <boost/shared_ptr.hpp>
 
 #include <Common/ParameterSet.h>
+#include <askap/askap/AskapUtil.h>
+
+#include <fstream>
 
 #include "askap_accessors.h"
 #include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
 
 
 
@@ -62,6 +73,16 @@ class FitsImageAccessTest : public CppUnit::TestFixture
    CPPUNIT_TEST_SUITE(FitsImageAccessTest);
    CPPUNIT_TEST(testReadWrite);
    CPPUNIT_TEST(testCreate);
+   CPPUNIT_TEST(testWriteChannels);
+   CPPUNIT_TEST(testParallelWrite);
+   CPPUNIT_TEST(testMask);
+   CPPUNIT_TEST(testPlaneWriter);
+   CPPUNIT_TEST(testPlaneIterator);
+   CPPUNIT_TEST(testCutouts);
+   CPPUNIT_TEST(testCompressedWrite);
+   CPPUNIT_TEST(testBeamList);
+   CPPUNIT_TEST(testHeaderReader);
+   CPPUNIT_TEST(testHeaderBatch);
    CPPUNIT_TEST_SUITE_END();
 public:
     void setUp() {
@@ -208,8 +229,411 @@ public:
 
    }
 
+    void testWriteChannels() {
+        const std::string name = "tmpfitschannels";
+        CPPUNIT_ASSERT(itsImageAccessor);
+        const size_t ra=20, dec=20, spec=5;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        itsImageAccessor->create(name, shape, makeCubeCoords(ra, dec));
+        // write channel by channel, the file is kept open between calls
+        casacore::Array<float> chanArr(casacore::IPosition(2,ra,dec));
+        for (size_t z = 0; z < spec; ++z) {
+             chanArr.set(float(z));
+             itsImageAccessor->write(name,chanArr,casacore::IPosition(3,0,0,z));
+        }
+        itsImageAccessor->setUnits(name,"Jy/beam");
+        // buffered changes are flushed before reading
+        CPPUNIT_ASSERT(itsImageAccessor->shape(name) == shape);
+        casacore::Array<float> readBack = itsImageAccessor->read(name);
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        for (size_t z = 0; z < spec; ++z) {
+             CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,1,2,z)) - float(z))<1e-7);
+        }
+        // the cached reader must not be used after more data are written
+        chanArr.set(10.);
+        itsImageAccessor->write(name,chanArr,casacore::IPosition(3,0,0,1));
+        readBack = itsImageAccessor->read(name,casacore::IPosition(3,0,0,1),casacore::IPosition(3,ra-1,dec-1,1));
+        CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,3,4,0)) - 10.)<1e-7);
+        // nor after the image is recreated
+        const casacore::IPosition newShape(3,ra,dec,2);
+        itsImageAccessor->create(name, newShape, makeCubeCoords(ra, dec));
+        itsImageAccessor->write(name,casacore::Array<float>(newShape, 1.));
+        CPPUNIT_ASSERT(itsImageAccessor->shape(name) == newShape);
+        itsImageAccessor->close(name);
+        CPPUNIT_ASSERT(itsImageAccessor->shape(name) == newShape);
+    }
+
+    void testBeamList() {
+        const std::string name = "tmpfitsbeams";
+        const size_t ra=10, dec=10, spec=4;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        itsImageAccessor->create(name, shape, makeCubeCoords(ra, dec));
+        itsImageAccessor->write(name,casacore::Array<float>(shape, 1.));
+        CPPUNIT_ASSERT(itsImageAccessor->beamList(name).size() == 0);
+        IImageAccess::BeamList beams(spec);
+        for (size_t chan = 0; chan < spec; ++chan) {
+             beams[chan].resize(3);
+             beams[chan][0] = casacore::Quantum<double>(20. + chan, "arcsec");
+             beams[chan][1] = casacore::Quantum<double>(10. + chan, "arcsec");
+             beams[chan][2] = casacore::Quantum<double>(5. * chan, "deg");
+        }
+        // wrong number of beams
+        CPPUNIT_ASSERT_THROW(itsImageAccessor->setBeamList(name, IImageAccess::BeamList(1)), AskapError);
+        itsImageAccessor->setBeamList(name, beams);
+        // replacing the table must not leave the old one behind
+        itsImageAccessor->setBeamList(name, beams);
+        const IImageAccess::BeamList readBack = itsImageAccessor->beamList(name);
+        CPPUNIT_ASSERT_EQUAL(spec, readBack.size());
+        for (size_t chan = 0; chan < spec; ++chan) {
+             CPPUNIT_ASSERT_EQUAL(size_t(3), size_t(readBack[chan].nelements()));
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(20. + chan, readBack[chan][0].getValue("arcsec"), 1e-4);
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(10. + chan, readBack[chan][1].getValue("arcsec"), 1e-4);
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(5. * chan, readBack[chan][2].getValue("deg"), 1e-4);
+        }
+        // pixels are not affected
+        CPPUNIT_ASSERT(fabs(itsImageAccessor->read(name)(casacore::IPosition(3,1,1,3)) - 1.) < 1e-7);
+    }
+
+    void testHeaderReader() {
+        const std::string name = "tmpfitsheader";
+        const size_t ra=10, dec=12, spec=3;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        itsImageAccessor->create(name, shape, makeCubeCoords(ra, dec));
+        itsImageAccessor->write(name,casacore::Array<float>(shape, 1.));
+        itsImageAccessor->setUnits(name,"Jy/beam");
+        itsImageAccessor->setMetadataKeyword(name,"OBJECT","it's a test");
+        itsImageAccessor->setBeamInfo(name,casacore::C::pi/1800.,casacore::C::pi/3600.,0.);
+        // served from the cached header
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), itsImageAccessor->getUnits(name));
+        CPPUNIT_ASSERT_EQUAL(std::string("it's a test"), itsImageAccessor->getMetadataKeyword(name,"OBJECT"));
+        CPPUNIT_ASSERT_EQUAL(std::string(""), itsImageAccessor->getMetadataKeyword(name,"TELESCOP"));
+        CPPUNIT_ASSERT(itsImageAccessor->shape(name) == shape);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, itsImageAccessor->beamInfo(name)[0].getValue("deg"), 1e-6);
+        // the cached header is dropped when the image changes
+        itsImageAccessor->setMetadataKeyword(name,"OBJECT","changed");
+        CPPUNIT_ASSERT_EQUAL(std::string("changed"), itsImageAccessor->getMetadataKeyword(name,"OBJECT"));
+        itsImageAccessor->close(name);
+
+        FITSHeaderReader hdr(name + ".fits");
+        CPPUNIT_ASSERT(hdr.shape() == shape);
+        CPPUNIT_ASSERT(hdr.hasKeyword("bunit"));
+        CPPUNIT_ASSERT_EQUAL(std::string("3"), hdr.keyword("NAXIS"));
+        const casacore::CoordinateSystem csys = hdr.coordSys();
+        CPPUNIT_ASSERT_EQUAL(2u, csys.nCoordinates());
+        CPPUNIT_ASSERT(csys.findCoordinate(casacore::Coordinate::SPECTRAL) >= 0);
+        const casacore::CoordinateSystem slice = itsImageAccessor->coordSysSlice(name,
+                 casacore::IPosition(3,2,3,1), casacore::IPosition(3,5,6,1));
+        CPPUNIT_ASSERT_EQUAL(2u, slice.nCoordinates());
+    }
+
+    void testHeaderBatch() {
+        const std::string name = "tmpfitsheaderbatch";
+        const size_t ra=10, dec=12, spec=3;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        boost::shared_ptr<FitsImageAccess> accessor(new FitsImageAccess);
+        accessor->setHeaderReserve(20);
+        accessor->create(name, shape, makeCubeCoords(ra, dec));
+        accessor->write(name,casacore::Array<float>(shape, 2.));
+        accessor->flush();
+        const std::streamoff fileSize = std::ifstream((name + ".fits").c_str(),
+                                        std::ios::binary | std::ios::ate).tellg();
+        // all keywords go into the reserved space in a single header rewrite
+        accessor->beginHeaderUpdate(name);
+        accessor->setUnits(name,"Jy/beam");
+        accessor->setBeamInfo(name,casacore::C::pi/1800.,casacore::C::pi/3600.,0.);
+        for (size_t key = 0; key < 10; ++key) {
+             accessor->setMetadataKeyword(name,"KEY" + utility::toString(key), utility::toString(key), "test");
+        }
+        accessor->addHistory(name,"batched update");
+        accessor->commitHeaderUpdate(name);
+        accessor->close(name);
+        // the header has not grown, so the data unit has not moved
+        CPPUNIT_ASSERT_EQUAL(fileSize, std::streamoff(std::ifstream((name + ".fits").c_str(),
+                                        std::ios::binary | std::ios::ate).tellg()));
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), accessor->getUnits(name));
+        CPPUNIT_ASSERT_EQUAL(std::string("7"), accessor->getMetadataKeyword(name,"KEY7"));
+        const casacore::Array<float> pixels = accessor->read(name);
+        CPPUNIT_ASSERT(pixels.shape() == shape);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2., casacore::min(pixels), 1e-6);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2., casacore::max(pixels), 1e-6);
+        CPPUNIT_ASSERT_THROWS(accessor->setHeaderReserve(-1), askap::AskapError);
+    }
+
+    void testParallelWrite() {
+        const std::string name = "tmpfitsparallel";
+        const size_t ra=20, dec=10, spec=6;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        // two writers emulate different ranks, the first one creates the image
+        LOFAR::ParameterSet parset;
+        parset.add("imagetype","fits");
+        parset.add("parallelwrite","true");
+        boost::shared_ptr<IImageAccess> writer1 = imageAccessFactory(parset);
+        boost::shared_ptr<IImageAccess> writer2 = imageAccessFactory(parset);
+        writer1->create(name, shape, makeCubeCoords(ra, dec));
+        writer1->setUnits(name,"Jy/beam");
+        // each writer does a slab of channels, the last slab is written plane by plane
+        casacore::Array<float> slab(casacore::IPosition(3,ra,dec,3));
+        for (size_t z = 0; z < 3; ++z) {
+             slab[z].set(float(z));
+        }
+        writer1->write(name, slab, casacore::IPosition(3,0,0,0));
+        casacore::Array<float> plane(casacore::IPosition(2,ra,dec));
+        for (size_t z = 3; z < spec; ++z) {
+             plane.set(float(z));
+             writer2->write(name, plane, casacore::IPosition(3,0,0,z));
+        }
+        // a partial row
+        casacore::Array<float> row(casacore::IPosition(1,5), -1.);
+        writer2->write(name, row, casacore::IPosition(3,2,3,4));
+        writer1->close(name);
+        writer2->close(name);
+
+        CPPUNIT_ASSERT(itsImageAccessor->shape(name) == shape);
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), itsImageAccessor->getUnits(name));
+        const casacore::Array<float> readBack = itsImageAccessor->read(name, casacore::IPosition(3,0,0,0), 
+                                                casacore::IPosition(3,ra-1,dec-1,spec-1));
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        for (size_t z = 0; z < spec; ++z) {
+             for (size_t y = 0; y < dec; ++y) {
+                  for (size_t x = 0; x < ra; ++x) {
+                       const bool inRow = (z == 4) && (y == 3) && (x >= 2) && (x < 7);
+                       const float expected = inRow ? -1. : float(z);
+                       CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,x,y,z)) - expected)<1e-7);
+                  }
+             }
+        }
+    }
+
+    void testMask() {
+        const std::string name = "tmpfitsmask";
+        const size_t ra=10, dec=8, spec=3;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        itsImageAccessor->create(name, shape, makeCubeCoords(ra, dec));
+        // the first plane is written with its mask, the diagonal is masked
+        casacore::Matrix<float> plane(ra,dec);
+        casacore::Matrix<bool> mask(ra,dec);
+        for (size_t y = 0; y < dec; ++y) {
+             for (size_t x = 0; x < ra; ++x) {
+                  plane(x,y) = float(x + y);
+                  mask(x,y) = (x != y);
+             }
+        }
+        itsImageAccessor->writeMasked(name, plane, mask, casacore::IPosition(3,0,0,0));
+        // the other planes are written first and masked afterwards, the last one has a good mask
+        plane.set(5.);
+        itsImageAccessor->write(name, plane, casacore::IPosition(3,0,0,1));
+        itsImageAccessor->write(name, plane, casacore::IPosition(3,0,0,2));
+        itsImageAccessor->writeMask(name, mask, casacore::IPosition(3,0,0,1));
+        mask.set(true);
+        itsImageAccessor->writeMask(name, mask, casacore::IPosition(3,0,0,2));
+        itsImageAccessor->makeDefaultMask(name);
+        // mismatched shapes
+        CPPUNIT_ASSERT_THROW(itsImageAccessor->writeMasked(name, plane, casacore::Matrix<bool>(ra,dec-1,true),
+                             casacore::IPosition(3,0,0,0)), AskapError);
+
+        const casacore::Array<float> readBack = itsImageAccessor->read(name);
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        for (size_t z = 0; z < spec; ++z) {
+             for (size_t y = 0; y < dec; ++y) {
+                  for (size_t x = 0; x < ra; ++x) {
+                       const float value = readBack(casacore::IPosition(3,x,y,z));
+                       if ((z < 2) && (x == y)) {
+                           CPPUNIT_ASSERT(casacore::isNaN(value));
+                       } else {
+                           const float expected = z == 0 ? float(x + y) : 5.;
+                           CPPUNIT_ASSERT(fabs(value - expected)<1e-7);
+                       }
+                  }
+             }
+        }
+    }
+
+    void testCompressedWrite() {
+        const std::string name = "tmpfitscompressed";
+        const size_t ra=20, dec=10, spec=4;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        LOFAR::ParameterSet parset;
+        parset.add("imagetype","fits");
+        parset.add("compression","gzip");
+        parset.add("quantizelevel","0");
+        boost::shared_ptr<IImageAccess> writer = imageAccessFactory(parset);
+        writer->create(name, shape, makeCubeCoords(ra, dec));
+        writer->setUnits(name,"Jy/beam");
+        casacore::Array<float> plane(casacore::IPosition(2,ra,dec));
+        for (size_t z = 0; z < spec; ++z) {
+             for (size_t y = 0; y < dec; ++y) {
+                  for (size_t x = 0; x < ra; ++x) {
+                       plane(casacore::IPosition(2,x,y)) = float(x) + 0.1 * y + 100. * z;
+                  }
+             }
+             writer->write(name, plane, casacore::IPosition(3,0,0,z));
+        }
+        writer->close(name);
+
+        // the image is in the first extension, cfitsio reads it transparently
+        FITSSliceReader reader(name + ".fits");
+        CPPUNIT_ASSERT(reader.shape() == shape);
+        casacore::Array<float> readBack;
+        reader.read(casacore::IPosition(3,0,0,0), casacore::IPosition(3,ra-1,dec-1,spec-1), readBack);
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        for (size_t z = 0; z < spec; ++z) {
+             for (size_t y = 0; y < dec; ++y) {
+                  for (size_t x = 0; x < ra; ++x) {
+                       const float expected = float(x) + 0.1 * y + 100. * z;
+                       CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,x,y,z)) - expected)<1e-7);
+                  }
+             }
+        }
+    }
+
+    void testPlaneWriter() {
+        const std::string name = "tmpfitsplanes";
+        const size_t ra=20, dec=10, spec=5;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        itsImageAccessor->create(name, shape, makeCubeCoords(ra, dec));
+        boost::shared_ptr<ImagePlaneWriter> writer = itsImageAccessor->planeWriter(name);
+        CPPUNIT_ASSERT(writer);
+        CPPUNIT_ASSERT_EQUAL(casacore::uInt(spec), writer->nPlanes());
+        CPPUNIT_ASSERT(writer->planeShape() == casacore::IPosition(2,ra,dec));
+        // planes filled in place, the last one is passed explicitly
+        for (size_t z = 0; z + 1 < spec; ++z) {
+             casacore::Array<float> &plane = writer->plane();
+             plane.set(float(z));
+             plane(casacore::IPosition(2,1,2)) = -float(z);
+             writer->appendPlane();
+        }
+        writer->appendPlane(casacore::Array<float>(writer->planeShape(), 10.));
+        CPPUNIT_ASSERT_EQUAL(casacore::uInt(spec), writer->nAppended());
+        // the image is complete, no more planes can be added
+        CPPUNIT_ASSERT_THROW(writer->appendPlane(), AskapError);
+        writer->close();
+        itsImageAccessor->close(name);
+
+        const casacore::Array<float> readBack = itsImageAccessor->read(name, casacore::IPosition(3,0,0,0), 
+                                                casacore::IPosition(3,ra-1,dec-1,spec-1));
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        for (size_t z = 0; z + 1 < spec; ++z) {
+             CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,5,5,z)) - float(z))<1e-7);
+             CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,1,2,z)) + float(z))<1e-7);
+        }
+        CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,1,2,spec-1)) - 10.)<1e-7);
+    }
+
+    void testPlaneIterator() {
+        const std::string name = "tmpfitsplaneiterator";
+        const size_t ra=20, dec=10, spec=6;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        casacore::Array<float> arr(shape);
+        for (size_t z = 0; z < spec; ++z) {
+             arr(casacore::IPosition(3,0,0,z), casacore::IPosition(3,ra-1,dec-1,z)) = float(z);
+             arr(casacore::IPosition(3,3,4,z)) = -float(z);
+        }
+        itsImageAccessor->create(name, shape, makeCubeCoords(ra, dec));
+        itsImageAccessor->write(name, arr);
+        itsImageAccessor->close(name);
+        // with and without read-ahead
+        for (int async = 0; async < 2; ++async) {
+             boost::shared_ptr<ImagePlaneIterator> it = itsImageAccessor->planeIterator(name, async == 1);
+             CPPUNIT_ASSERT(it);
+             CPPUNIT_ASSERT_EQUAL(casacore::uInt(spec), it->nPlanes());
+             CPPUNIT_ASSERT(it->planeShape() == casacore::IPosition(2,ra,dec));
+             size_t z = 0;
+             for (; !it->atEnd(); it->next(), ++z) {
+                  CPPUNIT_ASSERT_EQUAL(casacore::uInt(z), it->planeNumber());
+                  CPPUNIT_ASSERT(it->position() == casacore::IPosition(3,0,0,z));
+                  const casacore::Array<float> &plane = it->plane();
+                  CPPUNIT_ASSERT(plane.shape() == it->planeShape());
+                  CPPUNIT_ASSERT(fabs(plane(casacore::IPosition(2,5,5)) - float(z))<1e-7);
+                  CPPUNIT_ASSERT(fabs(plane(casacore::IPosition(2,3,4)) + float(z))<1e-7);
+             }
+             CPPUNIT_ASSERT_EQUAL(spec, z);
+             CPPUNIT_ASSERT_THROW(it->next(), AskapError);
+        }
+    }
+
+    void testCutouts() {
+        const std::string name = "tmpfitscutouts";
+        const size_t ra=30, dec=20, spec=4;
+        const casacore::IPosition shape(3,ra,dec,spec);
+        casacore::Array<float> arr(shape);
+        for (size_t z = 0; z < spec; ++z) {
+             for (size_t y = 0; y < dec; ++y) {
+                  for (size_t x = 0; x < ra; ++x) {
+                       arr(casacore::IPosition(3,x,y,z)) = float(x + 100 * y + 10000 * z);
+                  }
+             }
+        }
+        itsImageAccessor->create(name, shape, makeCubeCoords(ra, dec));
+        itsImageAccessor->write(name, arr);
+        // the full read should work for a 3-dimensional image
+        const casacore::Array<float> readBack = itsImageAccessor->read(name);
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,29,19,3)) - 31929.)<1e-7);
+
+        std::vector<casacore::IPosition> blc, trc;
+        blc.push_back(casacore::IPosition(3,0,0,0));
+        trc.push_back(casacore::IPosition(3,4,4,0));
+        blc.push_back(casacore::IPosition(3,25,10,1));
+        trc.push_back(casacore::IPosition(3,29,12,3));
+        blc.push_back(casacore::IPosition(3,7,3,2));
+        trc.push_back(casacore::IPosition(3,7,3,2));
+        // these two are read together with the previous one (overlapping and adjacent)
+        blc.push_back(casacore::IPosition(3,5,2,2));
+        trc.push_back(casacore::IPosition(3,9,4,2));
+        blc.push_back(casacore::IPosition(3,10,2,2));
+        trc.push_back(casacore::IPosition(3,12,4,2));
+        const CutoutGrouper grouper(blc, trc);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), grouper.groups().size());
+        CPPUNIT_ASSERT_EQUAL(size_t(3), grouper.groups()[2].members.size());
+        CPPUNIT_ASSERT(grouper.groups()[2].blc == casacore::IPosition(3,5,2,2));
+        CPPUNIT_ASSERT(grouper.groups()[2].trc == casacore::IPosition(3,12,4,2));
+        std::vector<casacore::Array<float> > cutouts;
+        itsImageAccessor->readCutouts(name, blc, trc, cutouts);
+        CPPUNIT_ASSERT_EQUAL(blc.size(), cutouts.size());
+        for (size_t i = 0; i < cutouts.size(); ++i) {
+             CPPUNIT_ASSERT(cutouts[i].shape() == trc[i] - blc[i] + 1);
+             const casacore::IPosition last = trc[i] - blc[i];
+             CPPUNIT_ASSERT(fabs(cutouts[i](last) - arr(trc[i]))<1e-7);
+             CPPUNIT_ASSERT(fabs(cutouts[i](casacore::IPosition(3,0)) - arr(blc[i]))<1e-7);
+        }
+        // the buffer is reused if the shape matches
+        const float *storage = cutouts[1].data();
+        itsImageAccessor->read(name, casacore::IPosition(3,0,1,1), casacore::IPosition(3,4,3,3), cutouts[1]);
+        CPPUNIT_ASSERT(storage == cutouts[1].data());
+        CPPUNIT_ASSERT(fabs(cutouts[1](casacore::IPosition(3,1,1,1)) - 20201.)<1e-7);
+        // preallocated memory
+        std::vector<float> plane(size_t(ra) * dec, -1.);
+        itsImageAccessor->read(name, casacore::IPosition(3,0,0,2), casacore::IPosition(3,ra-1,dec-1,2), &plane[0]);
+        CPPUNIT_ASSERT(fabs(plane[1 + ra] - arr(casacore::IPosition(3,1,1,2)))<1e-7);
+        CPPUNIT_ASSERT(fabs(plane.back() - arr(casacore::IPosition(3,ra-1,dec-1,2)))<1e-7);
+        // selection outside the image
+        CPPUNIT_ASSERT_THROW(itsImageAccessor->read(name, casacore::IPosition(3,0,0,0), 
+                             casacore::IPosition(3,ra,0,0)), AskapError);
+    }
+
 protected:
 
+   casacore::CoordinateSystem makeCubeCoords(const size_t ra, const size_t dec) {
+      casacore::Matrix<double> xform(2,2);
+      xform = 0.0; xform.diagonal() = 1.0;
+      casacore::DirectionCoordinate radec(casacore::MDirection::J2000,
+            casacore::Projection(casacore::Projection::SIN),
+            135*casacore::C::pi/180.0, 60*casacore::C::pi/180.0,
+            -1*casacore::C::pi/180.0, 1*casacore::C::pi/180,
+            xform, ra/2., dec/2.);
+      casacore::Vector<casacore::String> units(2); units = "deg";
+      radec.setWorldAxisUnits(units);
+      casacore::SpectralCoordinate spectral(casacore::MFrequency::TOPO, 1400 * 1.0E+6, 20 * 1.0E+3, 0,
+                                            1420.40575 * 1.0E+6);
+      units.resize(1);
+      units = "MHz";
+      spectral.setWorldAxisUnits(units);
+      casacore::CoordinateSystem coordsys;
+      coordsys.addCoordinate(radec);
+      coordsys.addCoordinate(spectral);
+      return coordsys;
+   }
+
    casacore::CoordinateSystem makeCoords() {
       casacore::Vector<casacore::String> names(2);
       names[0]="x"; names[1]="y";
@@ -0,0 +1,167 @@
+/// @file
+///
+/// Unit test for the HDF5 image access code
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#ifdef HAVE_HDF5
+
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/HDF5ImageAccess.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/coordinates/Coordinates/DirectionCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+#include <casacore/coordinates/Coordinates/Projection.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+class HDF5ImageAccessTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(HDF5ImageAccessTest);
+   CPPUNIT_TEST(testReadWrite);
+   CPPUNIT_TEST(testParallelWrite);
+   CPPUNIT_TEST_SUITE_END();
+public:
+
+   void testReadWrite() {
+      const std::string name = "tmp.hdf5image";
+      const size_t ra=20, dec=10, spec=6;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      HDF5ImageAccess acc;
+      acc.setTiling(CasaImageAccess::SPECTRAL);
+      acc.setCompression(5);
+      acc.create(name, shape, makeCubeCoords(ra, dec));
+      CPPUNIT_ASSERT(acc.shape(name) == shape);
+      CPPUNIT_ASSERT(acc.chunkShape(name).nelements() == 3);
+      acc.setUnits(name, "Jy/beam");
+      acc.setBeamInfo(name, 0.02, 0.01, 1.0);
+      acc.setMetadataKeyword(name, "TELESCOP", "ASKAP");
+      acc.addHistory(name, "first");
+      acc.addHistory(name, "second");
+      casacore::Array<float> plane(casacore::IPosition(2,ra,dec));
+      for (size_t z = 0; z < spec; ++z) {
+           for (size_t y = 0; y < dec; ++y) {
+                for (size_t x = 0; x < ra; ++x) {
+                     plane(casacore::IPosition(2,x,y)) = float(x + 100 * y + 10000 * z);
+                }
+           }
+           acc.write(name, plane, casacore::IPosition(3,0,0,z));
+      }
+      acc.close(name);
+
+      boost::shared_ptr<IImageAccess> reader = imageAccessFactory(hdf5Parset());
+      CPPUNIT_ASSERT(reader->shape(name) == shape);
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), reader->getUnits(name));
+      CPPUNIT_ASSERT_EQUAL(std::string("ASKAP"), reader->getMetadataKeyword(name, "TELESCOP"));
+      const casacore::Vector<casacore::Quantum<double> > beam = reader->beamInfo(name);
+      CPPUNIT_ASSERT_EQUAL(3u, beam.nelements());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.02, beam[0].getValue("rad"), 1e-10);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.01, beam[1].getValue("rad"), 1e-10);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, beam[2].getValue("rad"), 1e-10);
+      const casacore::CoordinateSystem csys = reader->coordSys(name);
+      CPPUNIT_ASSERT(csys.near(makeCubeCoords(ra, dec)));
+      const casacore::Array<float> slice = reader->read(name, casacore::IPosition(3,2,3,1),
+                                                         casacore::IPosition(3,5,4,3));
+      CPPUNIT_ASSERT(slice.shape() == casacore::IPosition(3,4,2,3));
+      for (size_t z = 0; z < 3; ++z) {
+           for (size_t y = 0; y < 2; ++y) {
+                for (size_t x = 0; x < 4; ++x) {
+                     const float expected = float(x + 2 + 100 * (y + 3) + 10000 * (z + 1));
+                     CPPUNIT_ASSERT(fabs(slice(casacore::IPosition(3,x,y,z)) - expected) < 1e-7);
+                }
+           }
+      }
+   }
+
+   void testParallelWrite() {
+      const std::string name = "tmp.hdf5parallel";
+      const size_t ra=20, dec=10, spec=6;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      // two writers emulate different ranks, the first one creates the image
+      LOFAR::ParameterSet parset = hdf5Parset();
+      parset.add("parallelwrite","true");
+      boost::shared_ptr<IImageAccess> writer1 = imageAccessFactory(parset);
+      boost::shared_ptr<IImageAccess> writer2 = imageAccessFactory(parset);
+      writer1->create(name, shape, makeCubeCoords(ra, dec));
+      writer1->setUnits(name, "Jy/beam");
+      casacore::Array<float> slab(casacore::IPosition(3,ra,dec,3), 1.);
+      writer1->write(name, slab, casacore::IPosition(3,0,0,0));
+      slab.set(2.);
+      writer2->write(name, slab, casacore::IPosition(3,0,0,3));
+      writer1->close(name);
+      writer2->close(name);
+
+      HDF5ImageAccess reader;
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), reader.getUnits(name));
+      const casacore::Array<float> readBack = reader.read(name);
+      CPPUNIT_ASSERT(readBack.shape() == shape);
+      for (size_t z = 0; z < spec; ++z) {
+           const float expected = z < 3 ? 1. : 2.;
+           CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,ra-1,dec-1,z)) - expected) < 1e-7);
+           CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,0,0,z)) - expected) < 1e-7);
+      }
+   }
+
+protected:
+
+   static LOFAR::ParameterSet hdf5Parset() {
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","hdf5");
+      return parset;
+   }
+
+   static casacore::CoordinateSystem makeCubeCoords(const size_t ra, const size_t dec) {
+      casacore::Matrix<double> xform(2,2);
+      xform = 0.0; xform.diagonal() = 1.0;
+      casacore::DirectionCoordinate radec(casacore::MDirection::J2000,
+            casacore::Projection(casacore::Projection::SIN),
+            135*casacore::C::pi/180.0, 60*casacore::C::pi/180.0,
+            -1*casacore::C::pi/180.0, 1*casacore::C::pi/180,
+            xform, ra/2., dec/2.);
+      casacore::SpectralCoordinate spectral(casacore::MFrequency::TOPO, 1400 * 1.0E+6, 20 * 1.0E+3, 0,
+                                            1420.40575 * 1.0E+6);
+      casacore::CoordinateSystem coordsys;
+      coordsys.addCoordinate(radec);
+      coordsys.addCoordinate(spectral);
+      return coordsys;
+   }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // HAVE_HDF5
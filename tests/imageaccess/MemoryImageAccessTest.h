@@ -0,0 +1,430 @@
+/// @file
+///
+/// Unit test for the in-memory image access code
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap/imageaccess/ImageView.h>
+#include <askap/imageaccess/ImageRegionLock.h>
+#include <askap/imageaccess/SpectrumExtractor.h>
+#include <askap/askap/AskapError.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/coordinates/Coordinates/DirectionCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+#include <casacore/coordinates/Coordinates/Projection.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+class MemoryImageAccessTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(MemoryImageAccessTest);
+   CPPUNIT_TEST(testReadWrite);
+   CPPUNIT_TEST(testPersist);
+   CPPUNIT_TEST(testView);
+   CPPUNIT_TEST(testReducePlanes);
+   CPPUNIT_TEST(testReadBuffer);
+   CPPUNIT_TEST(testReadSpectra);
+   CPPUNIT_TEST(testSpectrumExtractor);
+   CPPUNIT_TEST(testAccumulate);
+   CPPUNIT_TEST(testRegionOverlap);
+   CPPUNIT_TEST_EXCEPTION(testAccumulateWeightsShape, AskapError);
+   CPPUNIT_TEST_EXCEPTION(testMissingImage, AskapError);
+   CPPUNIT_TEST_SUITE_END();
+public:
+
+   void testReadWrite() {
+      const std::string name = "tmp.memoryimage";
+      const size_t ra=20, dec=10, spec=4;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      MemoryImageAccess acc;
+      CPPUNIT_ASSERT(!acc.exists(name));
+      acc.create(name, shape, makeCubeCoords(ra, dec));
+      CPPUNIT_ASSERT(acc.exists(name));
+      CPPUNIT_ASSERT(acc.shape(name) == shape);
+      casacore::Array<float> plane(casacore::IPosition(2,ra,dec));
+      for (size_t z = 0; z < spec; ++z) {
+           plane.set(float(z));
+           acc.write(name, plane, casacore::IPosition(3,0,0,z));
+      }
+      // slices reference the stored pixels
+      const casacore::Array<float> slice = acc.read(name, casacore::IPosition(3,2,3,1), casacore::IPosition(3,5,4,2));
+      CPPUNIT_ASSERT(slice.shape() == casacore::IPosition(3,4,2,2));
+      CPPUNIT_ASSERT(fabs(slice(casacore::IPosition(3,0,0,1)) - 2.) < 1e-7);
+      plane.set(10.);
+      acc.write(name, plane, casacore::IPosition(3,0,0,2));
+      CPPUNIT_ASSERT(fabs(slice(casacore::IPosition(3,0,0,1)) - 10.) < 1e-7);
+      CPPUNIT_ASSERT(acc.read(name).data() == acc.read(name).data());
+      // the written array is copied
+      CPPUNIT_ASSERT(fabs(acc.read(name)(casacore::IPosition(3,1,1,2)) - 10.) < 1e-7);
+      plane.set(20.);
+      CPPUNIT_ASSERT(fabs(acc.read(name)(casacore::IPosition(3,1,1,2)) - 10.) < 1e-7);
+
+      acc.setUnits(name, "Jy/beam");
+      acc.setBeamInfo(name, 0.02, 0.01, 1.0);
+      acc.setMetadataKeyword(name, "TELESCOP", "ASKAP");
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), acc.getUnits(name));
+      CPPUNIT_ASSERT_EQUAL(std::string("ASKAP"), acc.getMetadataKeyword(name, "TELESCOP"));
+      CPPUNIT_ASSERT_EQUAL(std::string(""), acc.getMetadataKeyword(name, "OBJECT"));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.01, acc.beamInfo(name)[1].getValue("rad"), 1e-10);
+      CPPUNIT_ASSERT(acc.coordSys(name).near(makeCubeCoords(ra, dec)));
+
+      CPPUNIT_ASSERT_EQUAL(0u, acc.mask(name).nelements());
+      acc.writeMask(name, casacore::Array<bool>(casacore::IPosition(2,ra,dec), false), casacore::IPosition(3,0,0,1));
+      const casacore::Array<bool> mask = acc.mask(name);
+      CPPUNIT_ASSERT(mask.shape() == shape);
+      CPPUNIT_ASSERT(mask(casacore::IPosition(3,0,0,0)));
+      CPPUNIT_ASSERT(!mask(casacore::IPosition(3,0,0,1)));
+
+      // without the persistence target close keeps the image
+      acc.close(name);
+      CPPUNIT_ASSERT(acc.exists(name));
+      acc.remove(name);
+      CPPUNIT_ASSERT(!acc.exists(name));
+   }
+
+   void testPersist() {
+      const std::string name = "tmp.memoryimagepersist";
+      const size_t ra=10, dec=10, spec=3;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","memory");
+      parset.add("persist","fits");
+      boost::shared_ptr<IImageAccess> acc = imageAccessFactory(parset);
+      CPPUNIT_ASSERT(acc);
+      acc->create(name, shape, makeCubeCoords(ra, dec));
+      acc->write(name, casacore::Array<float>(shape, 3.));
+      acc->setUnits(name, "Jy/beam");
+      acc->close(name);
+
+      LOFAR::ParameterSet fitsParset;
+      fitsParset.add("imagetype","fits");
+      boost::shared_ptr<IImageAccess> reader = imageAccessFactory(fitsParset);
+      CPPUNIT_ASSERT(reader->shape(name) == shape);
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), reader->getUnits(name));
+      CPPUNIT_ASSERT(fabs(reader->read(name)(casacore::IPosition(3,1,2,2)) - 3.) < 1e-7);
+   }
+
+   void testView() {
+      const std::string name = "tmp.memoryimageview";
+      const size_t ra=20, dec=10, spec=4;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      MemoryImageAccess acc;
+      acc.create(name, shape, makeCubeCoords(ra, dec));
+      casacore::Array<float> pixels(shape);
+      for (size_t z = 0; z < spec; ++z) {
+           for (size_t y = 0; y < dec; ++y) {
+                for (size_t x = 0; x < ra; ++x) {
+                     pixels(casacore::IPosition(3,x,y,z)) = float(x + 100 * y + 1000 * z);
+                }
+           }
+      }
+      acc.write(name, pixels);
+      const casacore::IPosition blc(3,4,2,1), trc(3,15,8,3);
+      boost::shared_ptr<ImageView> view = acc.view(name, blc, trc);
+      CPPUNIT_ASSERT(view->shape() == casacore::IPosition(3,12,7,3));
+      CPPUNIT_ASSERT(view->coordSys().near(acc.coordSysSlice(name, blc, trc)));
+      CPPUNIT_ASSERT(fabs(view->read()(casacore::IPosition(3,0,0,0)) - 1204.) < 1e-7);
+      // sub-view coordinates are relative to the parent view
+      boost::shared_ptr<ImageView> patch = view->subView(casacore::IPosition(3,1,1,0), casacore::IPosition(3,3,2,1));
+      CPPUNIT_ASSERT(patch->blc() == casacore::IPosition(3,5,3,1));
+      CPPUNIT_ASSERT(patch->trc() == casacore::IPosition(3,7,4,2));
+      CPPUNIT_ASSERT(fabs(patch->read()(casacore::IPosition(3,2,1,1)) - 2407.) < 1e-7);
+      CPPUNIT_ASSERT(patch->coordSys().near(acc.coordSysSlice(name, patch->blc(), patch->trc())));
+      // the world position of a pixel doesn't depend on the view it is taken from
+      casacore::Vector<double> pixel(3), world1, world2;
+      for (size_t dim = 0; dim < 3; ++dim) {
+           pixel[dim] = patch->blc()[dim];
+      }
+      CPPUNIT_ASSERT(acc.coordSys(name).toWorld(world1, pixel));
+      CPPUNIT_ASSERT(patch->coordSys().toWorld(world2, casacore::Vector<double>(3, 0.)));
+      CPPUNIT_ASSERT(allNear(world1, world2, 1e-10));
+      CPPUNIT_ASSERT_THROW(view->subView(casacore::IPosition(3,0,0,0), casacore::IPosition(3,12,0,0)), AskapError);
+   }
+
+   void testReducePlanes() {
+      const std::string name = "tmp.memoryimagereduce";
+      const size_t ra=9, dec=5, spec=7;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      MemoryImageAccess acc;
+      acc.create(name, shape, makeCubeCoords(ra, dec));
+      casacore::Array<float> pixels(shape);
+      for (size_t z = 0; z < spec; ++z) {
+           for (size_t y = 0; y < dec; ++y) {
+                for (size_t x = 0; x < ra; ++x) {
+                     pixels(casacore::IPosition(3,x,y,z)) = float(z) * (x % 2 ? 1. : -1.) + float(y);
+                }
+           }
+      }
+      acc.write(name, pixels);
+      for (casacore::uInt nThreads = 1; nThreads < 4; ++nThreads) {
+           const casacore::Vector<double> maxima = acc.reducePlanes(name, ImagePlaneReducer::maximum, 2, nThreads);
+           const casacore::Vector<double> medians = acc.reducePlanes(name, ImagePlaneReducer::median, 2, nThreads);
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(spec), maxima.nelements());
+           for (size_t z = 0; z < spec; ++z) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(double(z + dec - 1), maxima[z], 1e-6);
+                const casacore::Array<float> plane = pixels(casacore::IPosition(3,0,0,z),
+                                                           casacore::IPosition(3,ra-1,dec-1,z));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(double(casacore::median(plane)), medians[z], 1e-6);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(double(casacore::rms(plane)), ImagePlaneReducer::rms(plane), 1e-5);
+           }
+      }
+      // one value per row if the second axis is kept
+      const casacore::Vector<double> means = acc.reducePlanes(name, ImagePlaneReducer::mean, 1, 2);
+      CPPUNIT_ASSERT_EQUAL(casacore::uInt(dec), means.nelements());
+      CPPUNIT_ASSERT(means[3] > means[2]);
+      CPPUNIT_ASSERT_THROW(acc.reducePlanes(name, ImagePlaneReducer::mean, 3), AskapError);
+   }
+
+   void testReadBuffer() {
+      const std::string name = "tmp.memoryimagebuffer";
+      const size_t ra=10, dec=8, spec=3;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      MemoryImageAccess acc;
+      acc.create(name, shape, makeCubeCoords(ra, dec));
+      casacore::Array<float> arr(shape);
+      for (size_t z = 0; z < spec; ++z) {
+           arr(casacore::IPosition(3,0,0,z), casacore::IPosition(3,ra-1,dec-1,z)) = float(z + 1);
+      }
+      acc.write(name, arr);
+      // the same buffer is used for all planes
+      casacore::Array<float> buffer;
+      const float *storage = NULL;
+      for (size_t z = 0; z < spec; ++z) {
+           acc.read(name, casacore::IPosition(3,0,0,z), casacore::IPosition(3,ra-1,dec-1,z), buffer);
+           CPPUNIT_ASSERT(buffer.shape() == casacore::IPosition(3,ra,dec,1));
+           if (storage == NULL) {
+               storage = buffer.data();
+           }
+           CPPUNIT_ASSERT(storage == buffer.data());
+           CPPUNIT_ASSERT(casacore::allEQ(buffer, float(z + 1)));
+      }
+      // the buffer holds a copy, the image is not affected by changes
+      buffer.set(-1.);
+      CPPUNIT_ASSERT(casacore::allEQ(acc.read(name), arr));
+      // preallocated memory
+      std::vector<float> plane(ra * dec, 0.);
+      acc.read(name, casacore::IPosition(3,0,0,1), casacore::IPosition(3,ra-1,dec-1,1), &plane[0]);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2., plane[0], 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2., plane.back(), 1e-6);
+   }
+
+   void testReadSpectra() {
+      const std::string name = "tmp.memoryimagespectra";
+      const size_t ra=12, dec=10, spec=16;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      MemoryImageAccess acc;
+      acc.create(name, shape, makeCubeCoords(ra, dec));
+      acc.write(name, makeRamp(shape));
+      std::vector<casacore::IPosition> positions;
+      positions.push_back(casacore::IPosition(3,0,0,0));
+      positions.push_back(casacore::IPosition(3,11,9,0));
+      // the element for the spectral axis is ignored
+      positions.push_back(casacore::IPosition(3,5,3,7));
+      positions.push_back(casacore::IPosition(3,5,3,0));
+      for (casacore::uInt nThreads = 1; nThreads < 4; nThreads += 2) {
+           casacore::Matrix<float> spectra;
+           acc.readSpectra(name, positions, 4, 10, spectra, nThreads);
+           CPPUNIT_ASSERT_EQUAL(positions.size(), size_t(spectra.nrow()));
+           CPPUNIT_ASSERT_EQUAL(size_t(10), size_t(spectra.ncolumn()));
+           for (size_t pos = 0; pos < positions.size(); ++pos) {
+                for (size_t chan = 0; chan < 10; ++chan) {
+                     const float expected = float(positions[pos](0) + 100 * positions[pos](1) + 10000 * (chan + 4));
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, spectra(pos, chan), 1e-3);
+                }
+           }
+      }
+      // channels outside the image
+      casacore::Matrix<float> spectra;
+      CPPUNIT_ASSERT_THROW(acc.readSpectra(name, positions, 10, 7, spectra), AskapError);
+   }
+
+   void testSpectrumExtractor() {
+      const std::string name = "tmp.memoryimageextractor";
+      const casacore::IPosition shape(3,10,8,12);
+      MemoryImageAccess acc;
+      acc.create(name, shape, makeCubeCoords(10, 8));
+      acc.write(name, makeRamp(shape));
+      std::vector<casacore::IPosition> positions;
+      // two positions in the same chunk, one in another chunk
+      positions.push_back(casacore::IPosition(3,1,1,0));
+      positions.push_back(casacore::IPosition(3,3,2,0));
+      positions.push_back(casacore::IPosition(3,9,7,0));
+      SpectrumExtractor extractor(acc, name, 2, casacore::IPosition(3,4,4,5));
+      casacore::Matrix<float> spectra;
+      // channels 3 to 11 are split into the blocks 3-4, 5-9 and 10-11
+      extractor.extract(positions, 3, 9, spectra, 2);
+      CPPUNIT_ASSERT_EQUAL(size_t(6), extractor.nReads());
+      for (size_t pos = 0; pos < positions.size(); ++pos) {
+           for (size_t chan = 0; chan < 9; ++chan) {
+                const float expected = float(positions[pos](0) + 100 * positions[pos](1) + 10000 * (chan + 3));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, spectra(pos, chan), 1e-3);
+           }
+      }
+      // position outside the image
+      positions.push_back(casacore::IPosition(3,10,0,0));
+      CPPUNIT_ASSERT_THROW(extractor.extract(positions, 0, 1, spectra), AskapError);
+   }
+
+   void testAccumulate() {
+      const std::string name = "tmp.memoryimageaccumulate";
+      const size_t ra=20, dec=10, spec=4;
+      const casacore::IPosition shape(3,ra,dec,spec);
+      MemoryImageAccess acc;
+      acc.create(name, shape, makeCubeCoords(ra, dec));
+      acc.write(name, casacore::Array<float>(shape, 0.));
+      // overlapping patches are added by a number of threads
+      const casacore::uInt nThreads = 4;
+      const casacore::uInt nRepeats = 10;
+      boost::thread_group threads;
+      for (casacore::uInt thread = 0; thread < nThreads; ++thread) {
+           threads.create_thread(boost::bind(&MemoryImageAccessTest::accumulatePatch, &acc, name,
+                                 casacore::IPosition(3, 2 + thread, 3, 1), nRepeats));
+      }
+      threads.join_all();
+      CPPUNIT_ASSERT_EQUAL(size_t(0), ImageRegionLock::nLocked());
+      const casacore::Array<float> pixels = acc.read(name);
+      for (size_t z = 0; z < spec; ++z) {
+           for (size_t y = 0; y < dec; ++y) {
+                for (size_t x = 0; x < ra; ++x) {
+                     // each patch is 6 x 4 x 2 pixels of value 2 with the weight of 0.5
+                     float expected = 0.;
+                     if ((y >= 3) && (y < 7) && (z >= 1) && (z < 3)) {
+                         for (size_t thread = 0; thread < nThreads; ++thread) {
+                              if ((x >= 2 + thread) && (x < 8 + thread)) {
+                                  expected += float(nRepeats);
+                              }
+                         }
+                     }
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, pixels(casacore::IPosition(3,x,y,z)), 1e-5);
+                }
+           }
+      }
+      // an array with fewer dimensions and unit weights
+      acc.accumulate(name, casacore::Array<float>(casacore::IPosition(1,3), -1.), casacore::IPosition(3,0,0,3),
+                     casacore::Array<float>());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-1., acc.read(name)(casacore::IPosition(3,2,0,3)), 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., acc.read(name)(casacore::IPosition(3,3,0,3)), 1e-6);
+   }
+
+   void testRegionOverlap() {
+      const casacore::IPosition blc(2, 0, 0);
+      const casacore::IPosition trc(2, 4, 4);
+      CPPUNIT_ASSERT(ImageRegionLock::overlap(blc, trc, casacore::IPosition(2, 4, 4), casacore::IPosition(2, 6, 6)));
+      CPPUNIT_ASSERT(!ImageRegionLock::overlap(blc, trc, casacore::IPosition(2, 5, 0), casacore::IPosition(2, 6, 6)));
+      CPPUNIT_ASSERT(!ImageRegionLock::overlap(blc, trc, casacore::IPosition(2, 0, 5), casacore::IPosition(2, 4, 6)));
+      {
+        const ImageRegionLock lock1("tmp.lock", blc, trc);
+        // disjoint regions and regions of other images don't wait
+        const ImageRegionLock lock2("tmp.lock", casacore::IPosition(2, 5, 5), casacore::IPosition(2, 6, 6));
+        const ImageRegionLock lock3("tmp.otherlock", blc, trc);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), ImageRegionLock::nLocked());
+      }
+      CPPUNIT_ASSERT_EQUAL(size_t(0), ImageRegionLock::nLocked());
+   }
+
+   void testAccumulateWeightsShape() {
+      const std::string name = "tmp.memoryimageweights";
+      MemoryImageAccess acc;
+      acc.create(name, casacore::IPosition(2,10,10), makeCubeCoords(10, 10));
+      // weights should match the array
+      acc.accumulate(name, casacore::Array<float>(casacore::IPosition(2,2,2), 1.), casacore::IPosition(2,0,0),
+                     casacore::Array<float>(casacore::IPosition(2,2,3), 1.));
+   }
+
+   void testMissingImage() {
+      MemoryImageAccess acc;
+      acc.shape("tmp.nonexistent");
+   }
+
+protected:
+
+   /// @brief make a cube with pixel values encoding their position
+   /// @param[in] shape shape of the cube
+   /// @return array with x + 100 * y + 10000 * z in each pixel
+   static casacore::Array<float> makeRamp(const casacore::IPosition &shape) {
+      casacore::Array<float> arr(shape);
+      for (ssize_t z = 0; z < shape(2); ++z) {
+           for (ssize_t y = 0; y < shape(1); ++y) {
+                for (ssize_t x = 0; x < shape(0); ++x) {
+                     arr(casacore::IPosition(3,x,y,z)) = float(x + 100 * y + 10000 * z);
+                }
+           }
+      }
+      return arr;
+   }
+
+   /// @brief add a patch of pixels a number of times
+   /// @details This method is executed in parallel threads by testAccumulate
+   /// @param[in] acc accessor to work with
+   /// @param[in] name image name
+   /// @param[in] where bottom left corner of the patch
+   /// @param[in] nRepeats number of times to add the patch
+   static void accumulatePatch(MemoryImageAccess *acc, const std::string &name, const casacore::IPosition &where,
+                               casacore::uInt nRepeats) {
+      const casacore::IPosition patchShape(3, 6, 4, 2);
+      const casacore::Array<float> patch(patchShape, 2.);
+      const casacore::Array<float> weights(patchShape, 0.5);
+      for (casacore::uInt repeat = 0; repeat < nRepeats; ++repeat) {
+           acc->accumulate(name, patch, where, weights);
+      }
+   }
+
+   static casacore::CoordinateSystem makeCubeCoords(const size_t ra, const size_t dec) {
+      casacore::Matrix<double> xform(2,2);
+      xform = 0.0; xform.diagonal() = 1.0;
+      casacore::DirectionCoordinate radec(casacore::MDirection::J2000,
+            casacore::Projection(casacore::Projection::SIN),
+            135*casacore::C::pi/180.0, 60*casacore::C::pi/180.0,
+            -1*casacore::C::pi/180.0, 1*casacore::C::pi/180,
+            xform, ra/2., dec/2.);
+      casacore::SpectralCoordinate spectral(casacore::MFrequency::TOPO, 1400 * 1.0E+6, 20 * 1.0E+3, 0,
+                                            1420.40575 * 1.0E+6);
+      casacore::CoordinateSystem coordsys;
+      coordsys.addCoordinate(radec);
+      coordsys.addCoordinate(spectral);
+      return coordsys;
+   }
+};
+
+} // namespace accessors
+
+} // namespace askap
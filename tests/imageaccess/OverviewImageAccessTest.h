@@ -0,0 +1,144 @@
+/// @file
+///
+/// Unit test for the image access wrapper maintaining downsampled overviews
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author agent <agent@local>
+
+
+#include <askap/imageaccess/OverviewImageAccess.h>
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap/askap/AskapError.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+#include <casacore/coordinates/Coordinates/LinearCoordinate.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+class OverviewImageAccessTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(OverviewImageAccessTest);
+   CPPUNIT_TEST(testFullWrite);
+   CPPUNIT_TEST(testUnalignedWrite);
+   CPPUNIT_TEST(testMaskedWrite);
+   CPPUNIT_TEST_EXCEPTION(testBadFactor, AskapError);
+   CPPUNIT_TEST_SUITE_END();
+public:
+
+   void setUp() {
+      itsMemory.reset(new MemoryImageAccess);
+      std::vector<casacore::uInt> factors(2, 2);
+      factors[1] = 4;
+      itsAccessor.reset(new OverviewImageAccess(itsMemory, factors));
+   }
+
+   void testFullWrite() {
+      const std::string name = "tmp.overviewimage";
+      const casacore::IPosition shape(3,10,7,2);
+      itsAccessor->create(name, shape, makeCoords(3));
+      CPPUNIT_ASSERT(itsMemory->shape(OverviewImageAccess::overviewName(name, 2)) == casacore::IPosition(3,5,4,2));
+      CPPUNIT_ASSERT(itsMemory->shape(OverviewImageAccess::overviewName(name, 4)) == casacore::IPosition(3,3,2,2));
+      casacore::Array<float> arr(shape);
+      for (casacore::Int z = 0; z < shape(2); ++z) {
+           for (casacore::Int y = 0; y < shape(1); ++y) {
+                for (casacore::Int x = 0; x < shape(0); ++x) {
+                     arr(casacore::IPosition(3,x,y,z)) = float(x + 10 * z);
+                }
+           }
+      }
+      itsAccessor->write(name, arr);
+      const casacore::Array<float> ov2 = itsMemory->read(OverviewImageAccess::overviewName(name, 2));
+      CPPUNIT_ASSERT(fabs(ov2(casacore::IPosition(3,1,0,0)) - 2.5) < 1e-6);
+      CPPUNIT_ASSERT(fabs(ov2(casacore::IPosition(3,4,3,1)) - 18.5) < 1e-6);
+      // the last bin is partial and only covers pixels 8 and 9
+      const casacore::Array<float> ov4 = itsMemory->read(OverviewImageAccess::overviewName(name, 4));
+      CPPUNIT_ASSERT(fabs(ov4(casacore::IPosition(3,0,1,0)) - 1.5) < 1e-6);
+      CPPUNIT_ASSERT(fabs(ov4(casacore::IPosition(3,2,1,1)) - 18.5) < 1e-6);
+   }
+
+   void testUnalignedWrite() {
+      const std::string name = "tmp.overviewunaligned";
+      itsAccessor->create(name, casacore::IPosition(2,8,8), makeCoords(2));
+      itsAccessor->write(name, casacore::Array<float>(casacore::IPosition(2,8,8), 1.f));
+      // a single pixel changes the mean of the bins containing it
+      itsAccessor->write(name, casacore::Array<float>(casacore::IPosition(2,1,1), 5.f), casacore::IPosition(2,3,2));
+      const casacore::Array<float> ov2 = itsMemory->read(OverviewImageAccess::overviewName(name, 2));
+      CPPUNIT_ASSERT(fabs(ov2(casacore::IPosition(2,1,1)) - 2.) < 1e-6);
+      CPPUNIT_ASSERT(fabs(ov2(casacore::IPosition(2,0,0)) - 1.) < 1e-6);
+      const casacore::Array<float> ov4 = itsMemory->read(OverviewImageAccess::overviewName(name, 4));
+      CPPUNIT_ASSERT(fabs(ov4(casacore::IPosition(2,0,0)) - 1.25) < 1e-6);
+      CPPUNIT_ASSERT(fabs(ov4(casacore::IPosition(2,1,1)) - 1.) < 1e-6);
+   }
+
+   void testMaskedWrite() {
+      const std::string name = "tmp.overviewmasked";
+      itsAccessor->create(name, casacore::IPosition(2,4,4), makeCoords(2));
+      casacore::Array<float> arr(casacore::IPosition(2,4,4), 3.f);
+      casacore::Array<bool> mask(arr.shape(), true);
+      arr(casacore::IPosition(2,0,0)) = 100.f;
+      mask(casacore::IPosition(2,0,0)) = false;
+      // a bin with all pixels masked is blank
+      for (casacore::Int y = 2; y < 4; ++y) {
+           for (casacore::Int x = 2; x < 4; ++x) {
+                mask(casacore::IPosition(2,x,y)) = false;
+           }
+      }
+      itsAccessor->writeMasked(name, arr, mask, casacore::IPosition(2,0,0));
+      const casacore::Array<float> ov2 = itsMemory->read(OverviewImageAccess::overviewName(name, 2));
+      CPPUNIT_ASSERT(fabs(ov2(casacore::IPosition(2,0,0)) - 3.) < 1e-6);
+      CPPUNIT_ASSERT(std::isnan(ov2(casacore::IPosition(2,1,1))));
+      const casacore::Array<float> ov4 = itsMemory->read(OverviewImageAccess::overviewName(name, 4));
+      CPPUNIT_ASSERT(fabs(ov4(casacore::IPosition(2,0,0)) - 3.) < 1e-6);
+   }
+
+   void testBadFactor() {
+      OverviewImageAccess acc(itsMemory, std::vector<casacore::uInt>(1, 1));
+   }
+
+protected:
+
+   static casacore::CoordinateSystem makeCoords(const casacore::uInt nAxes) {
+      casacore::CoordinateSystem coordsys;
+      coordsys.addCoordinate(casacore::LinearCoordinate(nAxes));
+      return coordsys;
+   }
+
+private:
+   boost::shared_ptr<MemoryImageAccess> itsMemory;
+   boost::shared_ptr<OverviewImageAccess> itsAccessor;
+};
+
+} // namespace accessors
+
+} // namespace askap
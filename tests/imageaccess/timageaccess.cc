@@ -28,6 +28,10 @@
 // Test includes
 #include "CasaImageAccessTest.h"
 #include "FitsImageAccessTest.h"
+#include "HDF5ImageAccessTest.h"
+#include "MemoryImageAccessTest.h"
+#include "AsyncImageAccessTest.h"
+#include "OverviewImageAccessTest.h"
 
 
 
@@ -49,6 +53,12 @@ int main(int argc, char *argv[])
     askapdev::testutils::AskapTestRunner runner(argv[0]);
     //runner.addTest( askap::accessors::CasaImageAccessTest::suite());
     runner.addTest( askap::accessors::FitsImageAccessTest::suite());
+    runner.addTest( askap::accessors::MemoryImageAccessTest::suite());
+    runner.addTest( askap::accessors::AsyncImageAccessTest::suite());
+    runner.addTest( askap::accessors::OverviewImageAccessTest::suite());
+#ifdef HAVE_HDF5
+    runner.addTest( askap::accessors::HDF5ImageAccessTest::suite());
+#endif
     bool wasSucessful = runner.run();
 
     return wasSucessful ? 0 : 1;
@@ -33,19 +33,60 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <cstdio>
+#include <iterator>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+#include "boost/bind.hpp"
+#include "boost/ref.hpp"
+#include "boost/thread/thread.hpp"
+#include "askap/AskapError.h"
 
 // Classes to test
 #include "askap/votable/VOTable.h"
+#include "askap/votable/VOTableBinding.h"
+#include "askap/votable/VOTableCompression.h"
+#include "askap/votable/VOTableColumns.h"
+#include "askap/votable/VOTableParallelReader.h"
+#include "askap/votable/VOTableReader.h"
+#include "askap/votable/VOTableSkyIndex.h"
+#include "askap/votable/VOTableWriter.h"
+#include "askap/votable/XercescPlatform.h"
 
 using namespace std;
 
 namespace askap {
 namespace accessors {
 
+/// Row type bound to a table in VOTableTest::testBinding
+struct BoundSource {
+    std::string name;
+    double ra;
+    float flux;
+    int32_t channel;
+    int64_t id;
+    bool flagged;
+};
+
 class VOTableTest : public CppUnit::TestFixture {
         CPPUNIT_TEST_SUITE(VOTableTest);
         CPPUNIT_TEST(testDescription);
         CPPUNIT_TEST(testXML);
+        CPPUNIT_TEST(testReader);
+        CPPUNIT_TEST(testReaderCallback);
+        CPPUNIT_TEST(testWriter);
+        CPPUNIT_TEST(testBinary2);
+        CPPUNIT_TEST(testColumns);
+        CPPUNIT_TEST(testReferences);
+        CPPUNIT_TEST(testParallelReader);
+        CPPUNIT_TEST(testMappedFile);
+        CPPUNIT_TEST(testCompression);
+        CPPUNIT_TEST(testFilter);
+        CPPUNIT_TEST(testSkyIndex);
+        CPPUNIT_TEST(testPlatform);
+        CPPUNIT_TEST(testBinding);
+        CPPUNIT_TEST(testFragments);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -132,7 +173,738 @@ class VOTableTest : public CppUnit::TestFixture {
             CPPUNIT_ASSERT(rows[1].getCells()[1] == "4.0");
         }
 
+        void testReader() {
+            std::stringstream ss;
+            makeTable().toXML(ss);
+            ss.seekg(0, ios::beg);
+
+            VOTableReader reader(ss);
+            const std::vector<VOTableField> fields = reader.getFields();
+            CPPUNIT_ASSERT_EQUAL(2ul, fields.size());
+            CPPUNIT_ASSERT(fields[0].getName() == "RA");
+            CPPUNIT_ASSERT(fields[1].getUnit() == "deg");
+            CPPUNIT_ASSERT(fields[1].getUCD() == "pos.eq.dec;meta.main");
+
+            std::vector<std::string> cells;
+            CPPUNIT_ASSERT(reader.next(cells));
+            CPPUNIT_ASSERT_EQUAL(2ul, cells.size());
+            CPPUNIT_ASSERT(cells[0] == "1.0");
+            CPPUNIT_ASSERT(cells[1] == "2.0");
+            CPPUNIT_ASSERT_EQUAL(0ul, reader.tableIndex());
+            CPPUNIT_ASSERT_EQUAL(0ul, reader.rowIndex());
+
+            // the selection applies to the following rows
+            reader.selectColumns(std::vector<std::string>(1, "Dec"));
+            CPPUNIT_ASSERT(reader.next(cells));
+            CPPUNIT_ASSERT_EQUAL(1ul, cells.size());
+            CPPUNIT_ASSERT(cells[0] == "4.0");
+            CPPUNIT_ASSERT_EQUAL(1ul, reader.rowIndex());
+            CPPUNIT_ASSERT(!reader.next(cells));
+            CPPUNIT_ASSERT(!reader.next(cells));
+        }
+
+        void testReaderCallback() {
+            const std::string filename = "unittest_votable_reader.xml";
+            makeTable().toXML(filename);
+
+            // columns in the requested order, stop after the first row
+            std::vector<std::string> names;
+            names.push_back("Dec");
+            names.push_back("RA");
+            itsRows.clear();
+            CPPUNIT_ASSERT_EQUAL(1ul, VOTableReader::forEachRow(filename,
+                                 boost::bind(&VOTableTest::storeRow, this, _1, 1ul), names));
+            CPPUNIT_ASSERT_EQUAL(1ul, itsRows.size());
+            CPPUNIT_ASSERT(itsRows[0][0] == "2.0");
+            CPPUNIT_ASSERT(itsRows[0][1] == "1.0");
+
+            itsRows.clear();
+            CPPUNIT_ASSERT_EQUAL(2ul, VOTableReader::forEachRow(filename,
+                                 boost::bind(&VOTableTest::storeRow, this, _1, 10ul)));
+            CPPUNIT_ASSERT(itsRows[1][1] == "4.0");
+
+            // unknown column
+            VOTableReader reader(filename);
+            reader.selectColumns(std::vector<std::string>(1, "Flux"));
+            std::vector<std::string> cells;
+            CPPUNIT_ASSERT_THROW(reader.next(cells), askap::AskapError);
+        }
+
+        void testWriter() {
+            const VOTable vot1 = makeTable();
+            const VOTableTable vottab1 = vot1.getResource()[0].getTables()[0];
+
+            // the rows of the header are written first
+            std::stringstream ss;
+            {
+                VOTableWriter writer(ss);
+                writer.setDescription(vot1.getDescription());
+                writer.beginTable(vottab1);
+                CPPUNIT_ASSERT_EQUAL(2ul, writer.rowCount());
+                std::vector<std::string> cells(2);
+                cells[0] = "a<b & \"c\"";
+                cells[1] = "5.0";
+                writer.addRow(cells);
+                CPPUNIT_ASSERT_EQUAL(3ul, writer.rowCount());
+                CPPUNIT_ASSERT_THROW(writer.addRow(std::vector<std::string>(1, "6.0")),
+                                     askap::AskapError);
+                CPPUNIT_ASSERT_THROW(writer.addInfo(VOTableInfo()), askap::AskapError);
+                writer.close();
+                CPPUNIT_ASSERT_THROW(writer.addRow(cells), askap::AskapError);
+            }
+
+            // the DOM reader sees the same table as the one written by toXML
+            ss.seekg(0, ios::beg);
+            const VOTable vot2 = VOTable::fromXML(ss);
+            CPPUNIT_ASSERT(vot2.getDescription() == vot1.getDescription());
+            CPPUNIT_ASSERT_EQUAL(1ul, vot2.getResource().size());
+            CPPUNIT_ASSERT_EQUAL(1ul, vot2.getResource()[0].getTables().size());
+            const VOTableTable vottab2 = vot2.getResource()[0].getTables()[0];
+            CPPUNIT_ASSERT(vottab2.getName() == vottab1.getName());
+            CPPUNIT_ASSERT(vottab2.getDescription() == vottab1.getDescription());
+            CPPUNIT_ASSERT_EQUAL(1ul, vottab2.getGroups().size());
+            CPPUNIT_ASSERT(vottab2.getGroups()[0].getParams()[0].getValue() == "UTC-ICRS-TOPO");
+            CPPUNIT_ASSERT_EQUAL(2ul, vottab2.getGroups()[0].getFieldRefs().size());
+            CPPUNIT_ASSERT_EQUAL(2ul, vottab2.getFields().size());
+            CPPUNIT_ASSERT(vottab2.getFields()[1].getUCD() == "pos.eq.dec;meta.main");
+            CPPUNIT_ASSERT_EQUAL(3ul, vottab2.getRows().size());
+            CPPUNIT_ASSERT(vottab2.getRows()[1].getCells()[1] == "4.0");
+            CPPUNIT_ASSERT(vottab2.getRows()[2].getCells()[0] == "a<b & \"c\"");
+
+            // and so does the streaming reader
+            ss.clear();
+            ss.seekg(0, ios::beg);
+            VOTableReader reader(ss);
+            std::vector<std::string> cells;
+            size_t nRows = 0;
+            while (reader.next(cells)) {
+                ++nRows;
+            }
+            CPPUNIT_ASSERT_EQUAL(3ul, nRows);
+            CPPUNIT_ASSERT(cells[0] == "a<b & \"c\"");
+        }
+
+        void testBinary2() {
+            VOTableTable vottab1 = makeTable().getResource()[0].getTables()[0];
+            vottab1.setSerialisation(VOTableTable::BINARY2);
+
+            // DOM round trip, numbers come back in their shortest form
+            {
+                VOTableResource res;
+                res.addTable(vottab1);
+                VOTable vot1;
+                vot1.addResource(res);
+                std::stringstream ss;
+                vot1.toXML(ss);
+                CPPUNIT_ASSERT(ss.str().find("<TD>") == std::string::npos);
+
+                ss.seekg(0, ios::beg);
+                const VOTable vot2 = VOTable::fromXML(ss);
+                const VOTableTable vottab2 = vot2.getResource()[0].getTables()[0];
+                CPPUNIT_ASSERT(vottab2.getSerialisation() == VOTableTable::BINARY2);
+                CPPUNIT_ASSERT_EQUAL(2ul, vottab2.getRows().size());
+                CPPUNIT_ASSERT(vottab2.getRows()[0].getCells()[0] == "1");
+                CPPUNIT_ASSERT(vottab2.getRows()[1].getCells()[1] == "4");
+            }
+
+            // streaming writer and reader, including a null value
+            std::stringstream ss;
+            {
+                VOTableWriter writer(ss);
+                writer.beginTable(vottab1);
+                std::vector<std::string> cells(2);
+                cells[1] = "0.1";
+                writer.addRow(cells);
+                writer.close();
+            }
+            ss.seekg(0, ios::beg);
+            VOTableReader reader(ss);
+            reader.selectColumns(std::vector<std::string>(1, "Dec"));
+            std::vector<std::string> cells;
+            CPPUNIT_ASSERT(reader.next(cells));
+            CPPUNIT_ASSERT_EQUAL(1ul, cells.size());
+            CPPUNIT_ASSERT(cells[0] == "2");
+            reader.selectColumns(std::vector<std::string>());
+            CPPUNIT_ASSERT(reader.next(cells));
+            CPPUNIT_ASSERT(cells[0] == "3");
+            CPPUNIT_ASSERT(reader.next(cells));
+            CPPUNIT_ASSERT_EQUAL(2ul, reader.rowIndex());
+            CPPUNIT_ASSERT(cells[0] == "");
+            CPPUNIT_ASSERT(cells[1] == "0.1");
+            CPPUNIT_ASSERT(!reader.next(cells));
+        }
+
+        void testColumns() {
+            VOTableTable vottab = makeTable().getResource()[0].getTables()[0];
+            {
+                VOTableField f;
+                f.setName("Flag");
+                f.setDatatype("boolean");
+                vottab.addField(f);
+            }
+            {
+                VOTableField f;
+                f.setName("Comment");
+                f.setDatatype("char");
+                f.setArraysize("*");
+                vottab.addField(f);
+            }
+            VOTableTable vottab1;
+            const std::vector<VOTableField> fields = vottab.getFields();
+            for (size_t i = 0; i < fields.size(); ++i) {
+                vottab1.addField(fields[i]);
+            }
+
+            VOTableColumns cols(vottab1);
+            CPPUNIT_ASSERT_EQUAL(4ul, cols.nColumns());
+            CPPUNIT_ASSERT_EQUAL(0ul, cols.nRows());
+            std::vector<std::string> cells(4);
+            cells[0] = "1.5";
+            cells[1] = "-2.25";
+            cells[2] = "T";
+            cells[3] = "first";
+            cols.addRow(cells);
+            cells[0] = "";
+            cells[1] = "0.1";
+            cells[2] = "false";
+            cells[3] = "";
+            cols.addRow(cells);
+            CPPUNIT_ASSERT_EQUAL(2ul, cols.nRows());
+
+            // typed access by reference
+            const VOTableColumn& ra = cols.getColumn("RA");
+            CPPUNIT_ASSERT(ra.getType() == VOTableColumn::FLOAT);
+            CPPUNIT_ASSERT_EQUAL(2ul, ra.getFloatValues().size());
+            CPPUNIT_ASSERT_EQUAL(1.5f, ra.getFloatValues()[0]);
+            CPPUNIT_ASSERT(ra.isNull(1));
+            CPPUNIT_ASSERT_THROW(ra.getDoubleValues(), askap::AskapError);
+            CPPUNIT_ASSERT_EQUAL(-2.25f, cols.getColumn(1).getFloatValues()[0]);
+            CPPUNIT_ASSERT(cols.getColumn(2).getBoolValues()[0]);
+            CPPUNIT_ASSERT(!cols.getColumn(2).getBoolValues()[1]);
+            CPPUNIT_ASSERT(cols.getColumn("Comment").getStringValues()[0] == "first");
+            CPPUNIT_ASSERT_THROW(cols.getColumn("Flux"), askap::AskapError);
+            cells[1] = "x";
+            CPPUNIT_ASSERT_THROW(cols.addRow(cells), askap::AskapError);
+            CPPUNIT_ASSERT_EQUAL(2ul, cols.getColumn(0).size());
+
+            // string view of the rows
+            cols.getRow(1, cells);
+            CPPUNIT_ASSERT(cells[0] == "");
+            CPPUNIT_ASSERT(cells[1] == "0.1");
+            CPPUNIT_ASSERT(cells[2] == "F");
+            cols.addRowsTo(vottab1);
+            CPPUNIT_ASSERT_EQUAL(2ul, vottab1.getRows().size());
+            CPPUNIT_ASSERT(vottab1.getRows()[0].getCells()[3] == "first");
+
+            // conversion of the rows of a table
+            const VOTableColumns cols2(makeTable().getResource()[0].getTables()[0]);
+            CPPUNIT_ASSERT_EQUAL(2ul, cols2.nRows());
+            CPPUNIT_ASSERT_EQUAL(4.0f, cols2.getColumn("Dec").getFloatValues()[1]);
+        }
+
+        void testReferences() {
+            const VOTable vot = makeTable();
+
+            // the getters give access to the stored objects without copies
+            CPPUNIT_ASSERT(&vot.getResource() == &vot.getResource());
+            const VOTableTable& vottab = vot.getResource()[0].getTables()[0];
+            CPPUNIT_ASSERT(&vottab.getRows()[1].getCells() == &vottab.getRows()[1].getCells());
+            CPPUNIT_ASSERT(vottab.getRows()[1].getCells()[0] == "3.0");
+
+            VOTableTable vottab2;
+            vottab2.reserveRows(2);
+            VOTableRow row;
+            std::string cell = "5.0";
+            row.addCell(cell);
+            row.addCell(std::string("6.0"));
+            vottab2.addRow(row);
+            vottab2.addRow(VOTableRow(row));
+            CPPUNIT_ASSERT_EQUAL(2ul, vottab2.getRows().size());
+            CPPUNIT_ASSERT(vottab2.getRows()[1].getCells()[1] == "6.0");
+            CPPUNIT_ASSERT(cell == "5.0");
+        }
+
+        void testParallelReader() {
+            // two tables, the second one with an extra integer column
+            VOTableTable vottab1 = makeTable().getResource()[0].getTables()[0];
+            VOTableTable vottab2 = vottab1;
+            VOTableField f;
+            f.setName("Index");
+            f.setDatatype("int");
+            vottab2.addField(f);
+            std::stringstream ss;
+            {
+                VOTableWriter writer(ss);
+                writer.beginTable(vottab1);
+                std::vector<std::string> cells(2);
+                for (size_t i = 0; i < 1000; ++i) {
+                    std::ostringstream os;
+                    os << i;
+                    cells[0] = os.str();
+                    cells[1] = "-1.5";
+                    writer.addRow(cells);
+                }
+                cells.push_back("0");
+                writer.beginTable(vottab2);
+                for (size_t i = 0; i < 500; ++i) {
+                    std::ostringstream os;
+                    os << i;
+                    cells[2] = os.str();
+                    writer.addRow(cells);
+                }
+                writer.close();
+            }
+
+            for (size_t nThreads = 1; nThreads <= 4; nThreads += 3) {
+                ss.clear();
+                ss.seekg(0, ios::beg);
+                VOTableParallelReader reader(ss, nThreads, 7);
+                const std::vector<boost::shared_ptr<VOTableColumns> > tables = reader.read();
+                CPPUNIT_ASSERT_EQUAL(2ul, tables.size());
+                // the two rows of makeTable come first
+                CPPUNIT_ASSERT_EQUAL(1002ul, tables[0]->nRows());
+                const std::vector<float>& ra = tables[0]->getColumn("RA").getFloatValues();
+                for (size_t i = 2; i < ra.size(); ++i) {
+                    CPPUNIT_ASSERT_EQUAL(float(i - 2), ra[i]);
+                }
+                CPPUNIT_ASSERT_EQUAL(3ul, tables[1]->nColumns());
+                CPPUNIT_ASSERT_EQUAL(502ul, tables[1]->nRows());
+                const std::vector<int32_t>& index = tables[1]->getColumn("Index").getIntValues();
+                CPPUNIT_ASSERT_EQUAL(499, index.back());
+                CPPUNIT_ASSERT(tables[1]->getColumn(2).isNull(0));
+            }
+
+            // column selection and conversion errors
+            ss.clear();
+            ss.seekg(0, ios::beg);
+            VOTableParallelReader reader(ss, 4, 100);
+            reader.selectColumns(std::vector<std::string>(1, "Dec"));
+            const std::vector<boost::shared_ptr<VOTableColumns> > tables = reader.read();
+            CPPUNIT_ASSERT_EQUAL(1ul, tables[1]->nColumns());
+            CPPUNIT_ASSERT_EQUAL(-1.5f, tables[1]->getColumn(0).getFloatValues()[10]);
+
+            std::stringstream bad;
+            {
+                VOTableWriter writer(bad);
+                writer.beginTable(vottab1);
+                writer.addRow(std::vector<std::string>(2, "x"));
+            }
+            VOTableParallelReader badReader(bad, 2, 1);
+            CPPUNIT_ASSERT_THROW(badReader.read(), askap::AskapError);
+        }
+
+        void testMappedFile() {
+            // cells with escaped characters, read through the memory mapped input
+            VOTable vot = makeTable();
+            VOTableRow row;
+            row.addCell("a < b & c");
+            row.addCell(" 5.0 ");
+            VOTableResource res = vot.getResource()[0];
+            VOTableTable vottab = res.getTables()[0];
+            vottab.addRow(row);
+            VOTableResource res2;
+            res2.addTable(vottab);
+            VOTable vot2;
+            vot2.addResource(res2);
+
+            const std::string filename = "unittest_votable_mapped.xml";
+            vot2.toXML(filename);
+
+            const VOTable vot3 = VOTable::fromXML(filename);
+            const std::vector<VOTableRow>& rows = vot3.getResource()[0].getTables()[0].getRows();
+            CPPUNIT_ASSERT_EQUAL(3ul, rows.size());
+            CPPUNIT_ASSERT(rows[2].getCells()[0] == "a < b & c");
+            CPPUNIT_ASSERT(vot3.getResource()[0].getTables()[0].getFields()[1].getName() == "Dec");
+
+            VOTableReader reader(filename);
+            std::vector<std::string> cells;
+            CPPUNIT_ASSERT(reader.next(cells));
+            CPPUNIT_ASSERT(reader.next(cells));
+            CPPUNIT_ASSERT(reader.next(cells));
+            CPPUNIT_ASSERT(cells[0] == "a < b & c");
+            CPPUNIT_ASSERT(cells[1] == "5.0");
+            CPPUNIT_ASSERT(!reader.next(cells));
+
+            // an empty file is not a VOTable
+            const std::string empty = "unittest_votable_empty.xml";
+            std::ofstream(empty.c_str()).close();
+            CPPUNIT_ASSERT_THROW(VOTable::fromXML(empty), askap::AskapError);
+            std::remove(empty.c_str());
+            std::remove(filename.c_str());
+        }
+
+        void testCompression() {
+            CPPUNIT_ASSERT(VOTableCompression::fromFilename("cat.xml.gz") == VOTableCompression::GZIP);
+            CPPUNIT_ASSERT(VOTableCompression::fromFilename("cat.xml.zst") == VOTableCompression::ZSTD);
+            CPPUNIT_ASSERT(VOTableCompression::fromFilename("cat.xml") == VOTableCompression::NONE);
+
+            const std::string extensions[] = {".gz", ".zst"};
+            for (size_t i = 0; i < 2; ++i) {
+                const std::string filename = "unittest_votable_compressed.xml" + extensions[i];
+                const VOTableCompression::Type type = VOTableCompression::fromFilename(filename);
+                if (!VOTableCompression::isAvailable(type)) {
+                    CPPUNIT_ASSERT_THROW(VOTableWriter writer(filename), askap::AskapError);
+                    continue;
+                }
+
+                // more than a block of text, so several threads compress it
+                {
+                    VOTableWriter writer(filename, 3);
+                    writer.beginTable(makeTable().getResource()[0].getTables()[0]);
+                    std::vector<std::string> cells(2);
+                    for (size_t row = 0; row < 200000; ++row) {
+                        std::ostringstream os;
+                        os << row;
+                        cells[0] = os.str();
+                        cells[1] = "-1.5";
+                        writer.addRow(cells);
+                    }
+                    writer.close();
+                }
+                CPPUNIT_ASSERT(VOTableCompression::detect(filename) == type);
+                VOTableReader reader(filename);
+                std::vector<std::string> cells;
+                size_t nRows = 0;
+                while (reader.next(cells)) {
+                    ++nRows;
+                }
+                CPPUNIT_ASSERT_EQUAL(200002ul, nRows);
+                CPPUNIT_ASSERT(cells[0] == "199999");
+
+                // the whole document, the magic bytes are found whatever the name is
+                makeTable().toXML(filename);
+                const std::string renamed = "unittest_votable_compressed.xml";
+                CPPUNIT_ASSERT_EQUAL(0, std::rename(filename.c_str(), renamed.c_str()));
+                const VOTable vot = VOTable::fromXML(renamed);
+                CPPUNIT_ASSERT(vot.getDescription() == makeTable().getDescription());
+                CPPUNIT_ASSERT_EQUAL(2ul, vot.getResource()[0].getTables()[0].getRows().size());
+
+                // a truncated file
+                {
+                    std::ifstream in(renamed.c_str(), std::ios::binary);
+                    const std::string data((std::istreambuf_iterator<char>(in)),
+                                           std::istreambuf_iterator<char>());
+                    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+                    out.write(data.data(), data.size() / 2);
+                }
+                CPPUNIT_ASSERT_THROW(VOTable::fromXML(filename), askap::AskapError);
+                std::remove(renamed.c_str());
+                std::remove(filename.c_str());
+            }
+        }
+
+        void testFilter() {
+            // RA, Dec and Flux, the flux of row i is i
+            VOTableTable vottab;
+            vottab.setName("Catalogue");
+            for (size_t i = 0; i < 2; ++i) {
+                vottab.addField(makeTable().getResource()[0].getTables()[0].getFields()[i]);
+            }
+            VOTableField flux;
+            flux.setName("Flux");
+            flux.setDatatype("double");
+            vottab.addField(flux);
+            for (size_t i = 0; i < 10; ++i) {
+                std::ostringstream os;
+                os << i;
+                VOTableRow row;
+                row.addCell("1.5");
+                row.addCell("-0.5");
+                row.addCell(os.str());
+                vottab.addRow(row);
+            }
+
+            std::vector<std::string> columns;
+            columns.push_back("Flux");
+            columns.push_back("RA");
+            const VOTableFilter filter(columns, &VOTableTest::bright);
+
+            for (int binary = 0; binary < 2; ++binary) {
+                vottab.setSerialisation(binary ? VOTableTable::BINARY2 : VOTableTable::TABLEDATA);
+                VOTableResource res;
+                res.addTable(vottab);
+                VOTable vot;
+                vot.addResource(res);
+                std::stringstream ss;
+                vot.toXML(ss);
+
+                ss.seekg(0, ios::beg);
+                const VOTable vot2 = VOTable::fromXML(ss, filter);
+                const VOTableTable& vottab2 = vot2.getResource()[0].getTables()[0];
+                CPPUNIT_ASSERT(vottab2.getName() == "Catalogue");
+                CPPUNIT_ASSERT_EQUAL(2ul, vottab2.getFields().size());
+                CPPUNIT_ASSERT(vottab2.getFields()[0].getName() == "Flux");
+                CPPUNIT_ASSERT(vottab2.getFields()[1].getName() == "RA");
+                CPPUNIT_ASSERT(vottab2.getFields()[1].getUnit() == "deg");
+                const std::vector<VOTableRow>& rows = vottab2.getRows();
+                CPPUNIT_ASSERT_EQUAL(3ul, rows.size());
+                CPPUNIT_ASSERT_EQUAL(2ul, rows[0].getCells().size());
+                CPPUNIT_ASSERT(rows[0].getCells()[0] == "7");
+                CPPUNIT_ASSERT(rows[0].getCells()[1] == "1.5");
+                CPPUNIT_ASSERT(rows[2].getCells()[0] == "9");
+
+                // the predicate alone keeps all columns
+                ss.seekg(0, ios::beg);
+                const VOTable vot3 = VOTable::fromXML(ss,
+                        VOTableFilter(std::vector<std::string>(), &VOTableTest::bright));
+                const VOTableTable& vottab3 = vot3.getResource()[0].getTables()[0];
+                CPPUNIT_ASSERT_EQUAL(3ul, vottab3.getFields().size());
+                CPPUNIT_ASSERT_EQUAL(3ul, vottab3.getRows().size());
+                CPPUNIT_ASSERT(vottab3.getRows()[1].getCells()[2] == "8");
+            }
+
+            // unknown column
+            std::stringstream ss;
+            makeTable().toXML(ss);
+            ss.seekg(0, ios::beg);
+            CPPUNIT_ASSERT_THROW(VOTable::fromXML(ss, VOTableFilter(columns)), askap::AskapError);
+        }
+
+        void testSkyIndex() {
+            // a grid of 1 deg around the pole and RA 0, the rows of makeTable first
+            VOTableTable vottab = makeTable().getResource()[0].getTables()[0];
+            for (int ra = -5; ra <= 5; ++ra) {
+                for (int dec = 80; dec <= 90; ++dec) {
+                    std::ostringstream os1;
+                    os1 << (ra + 360) % 360;
+                    std::ostringstream os2;
+                    os2 << dec;
+                    VOTableRow row;
+                    row.addCell(os1.str());
+                    row.addCell(os2.str());
+                    vottab.addRow(row);
+                }
+            }
+
+            for (size_t nThreads = 1; nThreads <= 4; nThreads += 3) {
+                const VOTableSkyIndex index(vottab, nThreads);
+                CPPUNIT_ASSERT_EQUAL(2ul + 121ul, index.size());
+                CPPUNIT_ASSERT_EQUAL(0ul, index.raColumn());
+                CPPUNIT_ASSERT_EQUAL(1ul, index.decColumn());
+
+                const std::vector<size_t> near = index.cone(1.1, 2.1, 0.5);
+                CPPUNIT_ASSERT_EQUAL(1ul, near.size());
+                CPPUNIT_ASSERT_EQUAL(0ul, near[0]);
+
+                // all 11 rows at the pole and the 11 at dec 89 within 1.1 deg
+                CPPUNIT_ASSERT_EQUAL(22ul, index.cone(0.0, 90.0, 1.1).size());
+                // across RA 0: ra 359, 0 and 1 at dec 80
+                CPPUNIT_ASSERT_EQUAL(3ul, index.cone(0.0, 80.0, 0.2).size());
+
+                const std::vector<size_t> nearest = index.nearest(3.2, 3.9, 2);
+                CPPUNIT_ASSERT_EQUAL(2ul, nearest.size());
+                CPPUNIT_ASSERT_EQUAL(1ul, nearest[0]);
+                CPPUNIT_ASSERT_EQUAL(0ul, nearest[1]);
+                CPPUNIT_ASSERT(index.nearest(0.0, 0.0, 1000).size() == index.size());
+            }
+
+            const VOTableSkyIndex columnIndex(VOTableColumns(vottab));
+            CPPUNIT_ASSERT_EQUAL(0ul, columnIndex.nearest(1.0, 2.0)[0]);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(90.0, VOTableSkyIndex::separation(10.0, 0.0, 100.0, 0.0), 1e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, VOTableSkyIndex::separation(0.0, 89.5, 180.0, 89.5), 1e-9);
+
+            // no position columns
+            VOTableTable plain;
+            CPPUNIT_ASSERT_THROW(VOTableSkyIndex bad(plain), askap::AskapError);
+        }
+
+        void testPlatform() {
+            {
+                const XercescPlatform platform;
+                CPPUNIT_ASSERT(XercescPlatform::isInitialised());
+                CPPUNIT_ASSERT(XercescPlatform::nGuards() > 0);
+            }
+            // Xerces stays initialised between conversions
+            CPPUNIT_ASSERT(XercescPlatform::isInitialised());
+
+            // many small tables converted by several threads at once
+            std::vector<size_t> nDone(4, 0);
+            boost::thread_group threads;
+            for (size_t i = 0; i < nDone.size(); ++i) {
+                threads.create_thread(boost::bind(&VOTableTest::roundTrip, 50ul, boost::ref(nDone[i])));
+            }
+            threads.join_all();
+            for (size_t i = 0; i < nDone.size(); ++i) {
+                CPPUNIT_ASSERT_EQUAL(50ul, nDone[i]);
+            }
+            CPPUNIT_ASSERT_EQUAL(0ul, XercescPlatform::nGuards());
+            CPPUNIT_ASSERT(XercescPlatform::isInitialised());
+        }
+
+
+        void testBinding() {
+            VOTableBinding<BoundSource> binding;
+            binding.bind("Name", &BoundSource::name)
+                   .bind("RA", &BoundSource::ra, "deg", "pos.eq.ra;meta.main")
+                   .bind("Flux", &BoundSource::flux, "mJy")
+                   .bind("Channel", &BoundSource::channel)
+                   .bind("Id", &BoundSource::id)
+                   .bind("Flagged", &BoundSource::flagged);
+            CPPUNIT_ASSERT_EQUAL(6ul, binding.size());
+            CPPUNIT_ASSERT_EQUAL(std::string("double"), binding.fields()[1].getDatatype());
+            CPPUNIT_ASSERT_EQUAL(std::string("deg"), binding.fields()[1].getUnit());
+            CPPUNIT_ASSERT_THROW(binding.bind("RA", &BoundSource::ra), askap::AskapError);
+
+            std::vector<BoundSource> sources(2);
+            sources[0].name = "src1";
+            sources[0].ra = 0.1;
+            sources[0].flux = 12.5f;
+            sources[0].channel = -3;
+            sources[0].id = 1234567890123ll;
+            sources[0].flagged = true;
+            sources[1].name = "";
+            sources[1].ra = std::numeric_limits<double>::quiet_NaN();
+            sources[1].flux = 1.0f / 3.0f;
+            sources[1].channel = 0;
+            sources[1].id = -1;
+            sources[1].flagged = false;
+
+            std::stringstream ss;
+            {
+                VOTableWriter writer(ss);
+                writer.beginTable(binding.table("sources"));
+                binding.write(writer, sources);
+                writer.close();
+            }
+
+            ss.seekg(0, ios::beg);
+            std::vector<BoundSource> copy;
+            {
+                VOTableReader reader(ss);
+                CPPUNIT_ASSERT_EQUAL(2ul, binding.read(reader, copy));
+            }
+            CPPUNIT_ASSERT_EQUAL(2ul, copy.size());
+            CPPUNIT_ASSERT_EQUAL(std::string("src1"), copy[0].name);
+            CPPUNIT_ASSERT_EQUAL(0.1, copy[0].ra);
+            CPPUNIT_ASSERT_EQUAL(12.5f, copy[0].flux);
+            CPPUNIT_ASSERT_EQUAL(-3, copy[0].channel);
+            CPPUNIT_ASSERT(copy[0].id == 1234567890123ll);
+            CPPUNIT_ASSERT(copy[0].flagged);
+            CPPUNIT_ASSERT(std::isnan(copy[1].ra));
+            CPPUNIT_ASSERT_EQUAL(1.0f / 3.0f, copy[1].flux);
+            CPPUNIT_ASSERT(copy[1].id == -1);
+            CPPUNIT_ASSERT(!copy[1].flagged);
+
+            // empty cells are nulls, bad text is an error
+            std::vector<std::string> cells(6);
+            BoundSource value;
+            binding.fromCells(cells, value);
+            CPPUNIT_ASSERT(std::isnan(value.ra));
+            CPPUNIT_ASSERT_EQUAL(0, value.channel);
+            cells[3] = "0x10";
+            binding.fromCells(cells, value);
+            CPPUNIT_ASSERT_EQUAL(16, value.channel);
+            cells[3] = "3000000000";
+            CPPUNIT_ASSERT_THROW(binding.fromCells(cells, value), askap::AskapError);
+            cells[3] = "";
+            cells[1] = "12.0deg";
+            CPPUNIT_ASSERT_THROW(binding.fromCells(cells, value), askap::AskapError);
+        }
+
+
+        void testFragments() {
+            const VOTableTable vottab = makeTable().getResource()[0].getTables()[0];
+            for (int binary = 0; binary < 2; ++binary) {
+                const VOTableTable::Serialisation serialisation =
+                    binary ? VOTableTable::BINARY2 : VOTableTable::TABLEDATA;
+
+                // the first fragment holds the rows of the table, the second more rows
+                VOTableTable withRows = vottab;
+                withRows.setSerialisation(serialisation);
+                VOTableTable header;
+                header.setName(vottab.getName());
+                header.setSerialisation(serialisation);
+                for (size_t i = 0; i < vottab.getFields().size(); ++i) {
+                    header.addField(vottab.getFields()[i]);
+                }
+                const std::string part0 = "unittest_votable.part0";
+                const std::string part1 = "unittest_votable.part1";
+                {
+                    VOTableWriter writer(part0);
+                    writer.beginFragment(withRows);
+                    CPPUNIT_ASSERT_THROW(writer.beginTable(header), askap::AskapError);
+                    writer.close();
+                }
+                {
+                    VOTableWriter writer(part1);
+                    writer.beginFragment(header);
+                    std::vector<std::string> cells(2);
+                    for (int i = 0; i < 5; ++i) {
+                        std::ostringstream os;
+                        os << 10 + i;
+                        cells[0] = os.str();
+                        cells[1] = "-" + os.str();
+                        writer.addRow(cells);
+                    }
+                    writer.close();
+                }
+
+                std::stringstream ss;
+                {
+                    VOTableWriter writer(ss);
+                    CPPUNIT_ASSERT_THROW(writer.appendFragment(part0), askap::AskapError);
+                    writer.beginTable(header);
+                    writer.appendFragment(part0);
+                    writer.appendFragment(part1);
+                    CPPUNIT_ASSERT_THROW(writer.appendFragment("unittest_votable.none"),
+                                         askap::AskapError);
+                    writer.close();
+                }
+                std::remove(part0.c_str());
+                std::remove(part1.c_str());
+
+                ss.seekg(0, ios::beg);
+                VOTableReader reader(ss);
+                std::vector<std::string> cells;
+                CPPUNIT_ASSERT(reader.next(cells));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, std::atof(cells[0].c_str()), 1e-6);
+                CPPUNIT_ASSERT(reader.next(cells));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, std::atof(cells[1].c_str()), 1e-6);
+                for (int i = 0; i < 5; ++i) {
+                    CPPUNIT_ASSERT(reader.next(cells));
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(-10.0 - i, std::atof(cells[1].c_str()), 1e-6);
+                }
+                CPPUNIT_ASSERT(!reader.next(cells));
+            }
+        }
+
     private:
+        /// Convert a small table to XML and back a number of times, counting
+        /// the successful conversions (used by testPlatform from several threads)
+        static void roundTrip(size_t nTimes, size_t& nDone) {
+            try {
+                const VOTable vot = makeTable();
+                for (size_t i = 0; i < nTimes; ++i) {
+                    std::stringstream ss;
+                    vot.toXML(ss);
+                    ss.seekg(0, ios::beg);
+                    const VOTable copy = VOTable::fromXML(ss);
+                    if (copy.getDescription() == vot.getDescription() &&
+                            copy.getResource()[0].getTables()[0].getRows().size() == 2) {
+                        ++nDone;
+                    }
+                }
+            } catch (...) {
+                // the count shows the failure
+            }
+        }
+
+        /// Row predicate for testFilter, the flux is the first selected column
+        /// unless all columns are selected
+        static bool bright(const std::vector<std::string>& cells) {
+            const std::string& flux = cells.size() == 3 ? cells[2] : cells[0];
+            return std::atof(flux.c_str()) > 6.0;
+        }
+
+        /// Store a row, returns false when maxRows rows are stored
+        bool storeRow(const std::vector<std::string>& cells, size_t maxRows) {
+            itsRows.push_back(cells);
+            return itsRows.size() < maxRows;
+        }
+
+        /// Rows collected by storeRow
+        std::vector<std::vector<std::string> > itsRows;
+
         static void writeStringstream(const std::stringstream& ss) {
             std::ofstream fs("unittest_votable.xml", fstream::out | fstream::trunc);
             CPPUNIT_ASSERT(fs);
@@ -29,7 +29,8 @@
 
 // Support classes
 #include <string>
-#include "xercesc/util/PlatformUtils.hpp"
+#include "boost/scoped_ptr.hpp"
+#include "askap/votable/XercescPlatform.h"
 
 // Classes to test
 #include "askap/votable/XercescString.h"
@@ -46,11 +47,11 @@ class XercescStringTest : public CppUnit::TestFixture {
 
     public:
         void setUp() {
-            xercesc::XMLPlatformUtils::Initialize();
+            itsPlatform.reset(new XercescPlatform);
         };
 
         void tearDown() {
-            xercesc::XMLPlatformUtils::Terminate();
+            itsPlatform.reset();
         }
 
         void testAll() {
@@ -64,6 +65,10 @@ class XercescStringTest : public CppUnit::TestFixture {
             XercescString xs2(testStr);
             CPPUNIT_ASSERT(testStr.compare(xs2) == 0);
         }
+
+    private:
+        /// Keeps Xerces initialised during the test
+        boost::scoped_ptr<XercescPlatform> itsPlatform;
 };
 
 }
@@ -0,0 +1,415 @@
+/// @file tvotablebenchmark.cc
+///
+/// @brief Throughput and memory benchmark of the VOTable readers and writers
+/// @details Synthetic catalogues of the configured sizes are written and read back
+/// with each serialisation (TABLEDATA and BINARY2). The streaming writer and reader,
+/// the parallel reader with several thread counts and the DOM based VOTable::fromXML
+/// and toXML (full and filtered) are timed. The peak resident memory of each
+/// operation is measured as well. Results are printed to stdout as CSV (one line per
+/// catalogue and operation) or JSON, so they can be compared between builds.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+
+// ASKAPsoft includes
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, "");
+
+#include <askap/askap/AskapError.h>
+#include <Common/ParameterSet.h>
+#include <askap/votable/VOTable.h>
+#include <askap/votable/VOTableColumn.h>
+#include <askap/votable/VOTableColumns.h>
+#include <askap/votable/VOTableParallelReader.h>
+#include <askap/votable/VOTableReader.h>
+#include <askap/votable/VOTableWriter.h>
+
+// casa
+#include <casacore/casa/OS/Timer.h>
+
+// boost
+#include <boost/shared_ptr.hpp>
+
+// std
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using namespace askap;
+using namespace accessors;
+
+/// @brief result of one benchmark
+struct BenchmarkResult {
+   /// @brief catalogue (serialisation and number of rows)
+   std::string catalogue;
+   /// @brief operation
+   std::string operation;
+   /// @brief elapsed (real) time in seconds
+   double seconds;
+   /// @brief number of rows processed
+   size_t rows;
+   /// @brief size of the document in bytes
+   double bytes;
+   /// @brief peak resident memory during the operation in bytes (zero if unknown)
+   double peak;
+};
+
+/// @brief collection of results
+std::vector<BenchmarkResult> theResults;
+
+/// @brief reset the peak resident memory of the process
+/// @details Only possible on Linux, the peak is not reset elsewhere and the values
+/// reported are then the peak of the whole run so far.
+void resetPeakMemory()
+{
+   std::ofstream os("/proc/self/clear_refs");
+   if (os) {
+       os<<"5";
+   }
+}
+
+/// @brief obtain the peak resident memory of the process
+/// @return peak in bytes, zero if it is not available
+double peakMemory()
+{
+   std::ifstream is("/proc/self/status");
+   std::string line;
+   while (std::getline(is, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::atof(line.c_str() + 6) * 1024.;
+        }
+   }
+   return 0.;
+}
+
+/// @brief obtain the size of a file
+/// @param[in] filename name of the file
+/// @return size in bytes
+double fileSize(const std::string &filename)
+{
+   std::ifstream is(filename.c_str(), std::ios::binary | std::ios::ate);
+   return is ? double(is.tellg()) : 0.;
+}
+
+/// @brief store the result of one benchmark
+/// @param[in] catalogue catalogue name
+/// @param[in] operation name of the operation
+/// @param[in] seconds elapsed (real) time
+/// @param[in] rows number of rows processed
+/// @param[in] bytes size of the document
+void reportTiming(const std::string &catalogue, const std::string &operation, const double seconds,
+                  const size_t rows, const double bytes)
+{
+   BenchmarkResult result;
+   result.catalogue = catalogue;
+   result.operation = operation;
+   result.seconds = seconds;
+   result.rows = rows;
+   result.bytes = bytes;
+   result.peak = peakMemory();
+   theResults.push_back(result);
+   ASKAPLOG_INFO_STR(logger, catalogue<<" "<<operation<<": "<<seconds<<" s for "<<rows<<" row(s), peak memory "<<
+                     result.peak / 1048576.<<" MB");
+}
+
+/// @brief print all results
+/// @param[in] format either "csv" or "json"
+void printResults(const std::string &format)
+{
+   if (format == "json") {
+       cout<<"["<<endl;
+       for (size_t i = 0; i < theResults.size(); ++i) {
+            const BenchmarkResult &res = theResults[i];
+            cout<<"  {\"catalogue\": \""<<res.catalogue<<"\", \"operation\": \""<<res.operation<<
+                  "\", \"seconds\": "<<res.seconds<<", \"rows\": "<<res.rows<<
+                  ", \"rows_per_second\": "<<(res.seconds > 0. ? double(res.rows) / res.seconds : 0.)<<
+                  ", \"mbytes_per_second\": "<<(res.seconds > 0. ? res.bytes / res.seconds / 1048576. : 0.)<<
+                  ", \"peak_mbytes\": "<<res.peak / 1048576.<<
+                  "}"<<(i + 1 < theResults.size() ? "," : "")<<endl;
+       }
+       cout<<"]"<<endl;
+   } else {
+       ASKAPCHECK(format == "csv", "Unsupported output format "<<format<<", use csv or json");
+       cout<<"catalogue,operation,seconds,rows,rows_per_second,mbytes_per_second,peak_mbytes"<<endl;
+       for (size_t i = 0; i < theResults.size(); ++i) {
+            const BenchmarkResult &res = theResults[i];
+            cout<<res.catalogue<<","<<res.operation<<","<<res.seconds<<","<<res.rows<<","<<
+                  (res.seconds > 0. ? double(res.rows) / res.seconds : 0.)<<","<<
+                  (res.seconds > 0. ? res.bytes / res.seconds / 1048576. : 0.)<<","<<
+                  res.peak / 1048576.<<endl;
+       }
+   }
+}
+
+/// @brief make the header of the synthetic catalogue
+/// @details The first three columns are ra, dec and flux, the others cycle through
+/// the double, float, int and char datatypes.
+/// @param[in] nColumns number of columns (at least 3)
+/// @param[in] serialisation serialisation of the data
+/// @return table without rows
+VOTableTable makeHeader(const size_t nColumns, const VOTableTable::Serialisation serialisation)
+{
+   ASKAPCHECK(nColumns >= 3, "At least 3 columns are required, not "<<nColumns);
+   VOTableTable table;
+   table.setName("Benchmark");
+   table.setSerialisation(serialisation);
+   const char *types[] = {"double", "float", "int", "char"};
+   for (size_t col = 0; col < nColumns; ++col) {
+        VOTableField field;
+        if (col == 0) {
+            field.setName("ra");
+            field.setDatatype("double");
+            field.setUCD("pos.eq.ra;meta.main");
+            field.setUnit("deg");
+        } else if (col == 1) {
+            field.setName("dec");
+            field.setDatatype("double");
+            field.setUCD("pos.eq.dec;meta.main");
+            field.setUnit("deg");
+        } else if (col == 2) {
+            field.setName("flux");
+            field.setDatatype("float");
+            field.setUnit("Jy");
+        } else {
+            std::ostringstream os;
+            os<<"col"<<col;
+            field.setName(os.str());
+            field.setDatatype(types[col % 4]);
+            if (field.getDatatype() == "char") {
+                field.setArraysize("*");
+            }
+        }
+        table.addField(field);
+   }
+   return table;
+}
+
+/// @brief fill the cells of a row of the synthetic catalogue
+/// @param[in] table header of the catalogue
+/// @param[in] row row number
+/// @param[out] cells cells of the row (resized as necessary)
+void makeRow(const VOTableTable &table, const size_t row, std::vector<std::string> &cells)
+{
+   const std::vector<VOTableField> &fields = table.getFields();
+   cells.resize(fields.size());
+   const double value = double(std::rand()) / RAND_MAX;
+   cells[0] = VOTableColumn::formatReal(360. * value);
+   cells[1] = VOTableColumn::formatReal(180. * double(std::rand()) / RAND_MAX - 90.);
+   cells[2] = VOTableColumn::formatReal(float(value * value));
+   for (size_t col = 3; col < fields.size(); ++col) {
+        const std::string &type = fields[col].getDatatype();
+        if (type == "float") {
+            cells[col] = VOTableColumn::formatReal(float(value + col));
+        } else if (type == "double") {
+            cells[col] = VOTableColumn::formatReal(value * col);
+        } else {
+            std::ostringstream os;
+            if (type == "int") {
+                os<<row + col;
+            } else {
+                os<<"source_"<<row;
+            }
+            cells[col] = os.str();
+        }
+   }
+}
+
+/// @brief row predicate of the filtered read
+/// @param[in] cells ra, dec and flux
+/// @return true for sources brighter than 0.5 Jy
+bool bright(const std::vector<std::string> &cells)
+{
+   return VOTableColumn::parseReal(cells[2]) > 0.5;
+}
+
+/// @brief run the benchmark for one catalogue
+/// @param[in] serialisation serialisation of the data
+/// @param[in] nRows number of rows
+/// @param[in] parset parameters of the benchmark
+void doBenchmark(const VOTableTable::Serialisation serialisation, const size_t nRows,
+                 const LOFAR::ParameterSet &parset)
+{
+   std::ostringstream os;
+   os<<(serialisation == VOTableTable::BINARY2 ? "binary2" : "tabledata")<<"_"<<nRows;
+   const std::string catalogue = os.str();
+   const std::string filename = parset.getString("name", "benchmark") + "_" + catalogue + ".xml";
+   const size_t nColumns = parset.getUint32("ncolumns", 50);
+   const size_t maxInMemory = parset.getUint32("maxinmemoryrows", 1000000);
+   const size_t blockSize = parset.getUint32("blocksize", 10000);
+   const std::vector<casacore::uInt> nThreads = parset.getUint32Vector("nthreads", std::vector<casacore::uInt>(1, 1));
+   const VOTableTable header = makeHeader(nColumns, serialisation);
+   // the same rows for all catalogues of a given size
+   std::srand(parset.getUint32("seed", 1));
+
+   casacore::Timer timer;
+   std::vector<std::string> cells;
+
+   // the rows are generated as they are written, the time includes the formatting
+   resetPeakMemory();
+   timer.mark();
+   {
+      VOTableWriter writer(filename);
+      writer.beginTable(header);
+      for (size_t row = 0; row < nRows; ++row) {
+           makeRow(header, row, cells);
+           writer.addRow(cells);
+      }
+      writer.close();
+   }
+   const double bytes = fileSize(filename);
+   reportTiming(catalogue, "write_stream", timer.real(), nRows, bytes);
+
+   {
+      resetPeakMemory();
+      timer.mark();
+      VOTableReader reader(filename);
+      size_t count = 0;
+      while (reader.next(cells)) {
+           ++count;
+      }
+      reportTiming(catalogue, "read_stream", timer.real(), count, bytes);
+      ASKAPCHECK(count == nRows, "Read "<<count<<" rows from "<<filename<<", expected "<<nRows);
+   }
+
+   {
+      resetPeakMemory();
+      timer.mark();
+      VOTableReader reader(filename);
+      std::vector<std::string> names(1, "ra");
+      names.push_back("dec");
+      names.push_back("flux");
+      reader.selectColumns(names);
+      size_t count = 0;
+      while (reader.next(cells)) {
+           ++count;
+      }
+      reportTiming(catalogue, "read_stream_3_columns", timer.real(), count, bytes);
+   }
+
+   // the readers below keep the whole catalogue in memory
+   if (nRows > maxInMemory) {
+       ASKAPLOG_INFO_STR(logger, "Skipping in-memory operations for "<<catalogue<<", more than "<<
+                         maxInMemory<<" rows");
+       std::remove(filename.c_str());
+       return;
+   }
+
+   for (std::vector<casacore::uInt>::const_iterator it = nThreads.begin(); it != nThreads.end(); ++it) {
+        std::ostringstream op;
+        op<<"read_parallel_"<<*it<<"_threads";
+        resetPeakMemory();
+        timer.mark();
+        VOTableParallelReader reader(filename, *it, blockSize);
+        const std::vector<boost::shared_ptr<VOTableColumns> > tables = reader.read();
+        ASKAPCHECK(tables.size() == 1, "Read "<<tables.size()<<" tables from "<<filename);
+        reportTiming(catalogue, op.str(), timer.real(), tables[0]->nRows(), bytes);
+   }
+
+   {
+      resetPeakMemory();
+      timer.mark();
+      const VOTable vot = VOTable::fromXML(filename);
+      const size_t count = vot.getResource()[0].getTables()[0].getRows().size();
+      reportTiming(catalogue, "read_dom", timer.real(), count, bytes);
+
+      const std::string copy = filename + ".dom";
+      resetPeakMemory();
+      timer.mark();
+      vot.toXML(copy);
+      reportTiming(catalogue, "write_dom", timer.real(), count, fileSize(copy));
+      std::remove(copy.c_str());
+   }
+
+   {
+      std::vector<std::string> names(1, "ra");
+      names.push_back("dec");
+      names.push_back("flux");
+      resetPeakMemory();
+      timer.mark();
+      const VOTable vot = VOTable::fromXML(filename, VOTableFilter(names, bright));
+      const size_t count = vot.getResource()[0].getTables()[0].getRows().size();
+      reportTiming(catalogue, "read_dom_filtered", timer.real(), count, bytes);
+   }
+
+   std::remove(filename.c_str());
+}
+
+int main(int argc, char **argv) {
+  try {
+     if (argc!=2) {
+         cerr<<"Usage "<<argv[0]<<" benchmark.parset"<<endl;
+         cerr<<"The parset may contain (Benchmark. prefix):"<<endl;
+         cerr<<"   nrows           = [10000, 100000, 1000000, 10000000]  catalogue sizes"<<endl;
+         cerr<<"   ncolumns        = 50                   number of columns (ra, dec, flux, ...)"<<endl;
+         cerr<<"   serialisations  = [tabledata, binary2] data serialisations"<<endl;
+         cerr<<"   nthreads        = [1]                  thread counts for the parallel reader"<<endl;
+         cerr<<"   blocksize       = 10000                rows per block of the parallel reader"<<endl;
+         cerr<<"   maxinmemoryrows = 1000000              larger catalogues are only streamed"<<endl;
+         cerr<<"   name            = benchmark            file name prefix (files are removed)"<<endl;
+         cerr<<"   seed            = 1                    seed of the synthetic data"<<endl;
+         cerr<<"   format          = csv                  output format (csv or json)"<<endl;
+	 return -2;
+     }
+     const LOFAR::ParameterSet parset = LOFAR::ParameterSet(argv[1]).makeSubset("Benchmark.");
+     std::vector<casacore::uInt> defaultRows(1, 10000);
+     defaultRows.push_back(100000);
+     defaultRows.push_back(1000000);
+     defaultRows.push_back(10000000);
+     const std::vector<casacore::uInt> nRows = parset.getUint32Vector("nrows", defaultRows);
+     std::vector<std::string> defaultSerialisations(1, "tabledata");
+     defaultSerialisations.push_back("binary2");
+     const std::vector<std::string> serialisations = parset.getStringVector("serialisations",
+                                                                             defaultSerialisations);
+     for (std::vector<std::string>::const_iterator it = serialisations.begin(); it != serialisations.end(); ++it) {
+          ASKAPCHECK(*it == "tabledata" || *it == "binary2", "Unsupported serialisation "<<*it<<
+                     ", use tabledata or binary2");
+          for (std::vector<casacore::uInt>::const_iterator rows = nRows.begin(); rows != nRows.end(); ++rows) {
+               doBenchmark(*it == "binary2" ? VOTableTable::BINARY2 : VOTableTable::TABLEDATA, *rows, parset);
+          }
+     }
+     printResults(parset.getString("format", "csv"));
+  }
+  catch(const AskapError &ce) {
+     cerr<<"AskapError has been caught. "<<ce.what()<<endl;
+     return -1;
+  }
+  catch(const std::exception &ex) {
+     cerr<<"std::exception has been caught. "<<ex.what()<<endl;
+     return -1;
+  }
+  catch(...) {
+     cerr<<"An unexpected exception has been caught"<<endl;
+     return -1;
+  }
+  return 0;
+}